@@ -42,6 +42,21 @@
 #include "ogr_api.h"
 #include "ogr_srs_api.h"
 #include "ogr_geometry.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 static CPLErr OGRPolygonContourWriter(double dfLevelMin, double dfLevelMax,
                                       const OGRMultiPolygon &multipoly,
@@ -208,6 +223,436 @@ struct GDALRingAppender
     void *data_;
 };
 
+/************************************************************************/
+/* ==================================================================== */
+/*                 Multi-threaded contour line generation               */
+/* ==================================================================== */
+/************************************************************************/
+
+namespace
+{
+
+typedef std::vector<std::pair<double, marching_squares::LineString>>
+    ContourLines;
+
+// A horizontal stripe of the raster, processed by a worker thread.
+template <class LevelGenerator> struct ContourStripe
+{
+    int nXSize = 0;
+    int nYSize = 0;  // of the raster
+    bool bUseNoData = false;
+    double dfNoDataValue = 0;
+    LevelGenerator *poLevels = nullptr;
+
+    int nYOff = 0;
+    int nLines = 0;
+    // nLines lines of data, preceded by the previous line if nYOff > 0
+    std::vector<double> adfData{};
+
+    // Lines that do not touch the seams with the neighbouring stripes
+    ContourLines aoCompleteLines{};
+    // Lines with at least one end on a seam, to be merged with the pieces
+    // of the neighbouring stripes
+    ContourLines aoPieces{};
+
+    std::string osError{};
+    bool bDone = false;
+    std::mutex *poMutex = nullptr;
+    std::condition_variable *poCV = nullptr;
+};
+
+// Line writer of the SegmentMerger of a stripe, that sorts its lines
+// between complete lines and seam pieces.
+struct ContourStripeLines
+{
+    ContourStripeLines(ContourLines &aoCompleteLines, ContourLines &aoPieces,
+                       double dfTopSeam, double dfBottomSeam)
+        : aoCompleteLines_(aoCompleteLines), aoPieces_(aoPieces),
+          dfTopSeam_(dfTopSeam), dfBottomSeam_(dfBottomSeam)
+    {
+    }
+
+    void addLine(double level, marching_squares::LineString &ls,
+                 bool /*closed*/)
+    {
+        const bool bOnSeam = IsOnSeam(ls.front()) || IsOnSeam(ls.back());
+        (bOnSeam ? aoPieces_ : aoCompleteLines_)
+            .emplace_back(level, std::move(ls));
+    }
+
+  private:
+    ContourLines &aoCompleteLines_;
+    ContourLines &aoPieces_;
+    // NaN when there is no such seam
+    const double dfTopSeam_;
+    const double dfBottomSeam_;
+
+    bool IsOnSeam(const marching_squares::Point &p) const
+    {
+        return p.y == dfTopSeam_ || p.y == dfBottomSeam_;
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(ContourStripeLines)
+};
+
+// Coordinate of the seam above a stripe starting at line nYOff, that is the
+// centre of its previous line. The squares of the stripe start there.
+inline double ContourSeamY(int nYOff)
+{
+    return nYOff > 0 ? nYOff - 0.5 : std::numeric_limits<double>::quiet_NaN();
+}
+
+template <class LevelGenerator> void ContourProcessStripeJob(void *pData)
+{
+    using namespace marching_squares;
+
+    auto psStripe = static_cast<ContourStripe<LevelGenerator> *>(pData);
+    try
+    {
+        const int nYEnd = psStripe->nYOff + psStripe->nLines;
+        ContourStripeLines oLines(
+            psStripe->aoCompleteLines, psStripe->aoPieces,
+            ContourSeamY(psStripe->nYOff),
+            nYEnd < psStripe->nYSize
+                ? ContourSeamY(nYEnd)
+                : std::numeric_limits<double>::quiet_NaN());
+        {
+            SegmentMerger<ContourStripeLines, LevelGenerator> oMerger(
+                oLines, *(psStripe->poLevels), /* polygonize */ false);
+            ContourGenerator<decltype(oMerger), LevelGenerator> oCG(
+                psStripe->nXSize, psStripe->nYSize, psStripe->bUseNoData,
+                psStripe->dfNoDataValue, oMerger, *(psStripe->poLevels));
+            const double *padfLine = psStripe->adfData.data();
+            if (psStripe->nYOff > 0)
+            {
+                oCG.setStartLine(psStripe->nYOff, padfLine);
+                padfLine += psStripe->nXSize;
+            }
+            for (int iLine = 0; iLine < psStripe->nLines; iLine++)
+            {
+                oCG.feedLine(padfLine);
+                padfLine += psStripe->nXSize;
+            }
+        }
+        std::vector<double>().swap(psStripe->adfData);
+    }
+    catch (const std::exception &e)
+    {
+        psStripe->osError = e.what();
+        if (psStripe->osError.empty())
+            psStripe->osError = "Cannot process contour stripe";
+    }
+
+    std::lock_guard<std::mutex> oLock(*(psStripe->poMutex));
+    psStripe->bDone = true;
+    psStripe->poCV->notify_all();
+}
+
+// Join line b to line a, given they share the end point p. The direction
+// of a is preserved.
+void ContourJoinLines(marching_squares::LineString &a,
+                      marching_squares::LineString &b,
+                      const marching_squares::Point &p)
+{
+    if (a.back() == p)
+    {
+        if (!(b.front() == p))
+            b.reverse();
+        b.pop_front();
+        a.splice(a.end(), b);
+    }
+    else
+    {
+        if (!(b.back() == p))
+            b.reverse();
+        b.pop_back();
+        a.splice(a.begin(), b);
+    }
+}
+
+// Assembles the seam pieces of consecutive stripes into contour lines, and
+// writes them once complete.
+class ContourSeamMerger
+{
+  public:
+    explicit ContourSeamMerger(GDALRingAppender &oAppender)
+        : oAppender_(oAppender)
+    {
+    }
+
+    // Pieces must be added in stripe order. dfTopSeam and dfBottomSeam are
+    // NaN for the first and last stripes.
+    void AddPieces(ContourLines &aoPieces, double dfTopSeam,
+                   double dfBottomSeam)
+    {
+        for (auto &oPiece : aoPieces)
+        {
+            Ends &oEnds = aoEnds_[oPiece.first];
+            aoChains_.push_back(Chain{oPiece.first, std::move(oPiece.second)});
+            auto oCur = std::prev(aoChains_.end());
+            marching_squares::LineString &ls = oCur->ls;
+
+            // Connect to the chains of the previous stripe ending on the
+            // top seam. Several may be needed, when the previous ones
+            // were joined through our stripe.
+            bool bClosed = false;
+            while (!bClosed)
+            {
+                auto oIter = oEnds.end();
+                if (ls.front().y == dfTopSeam)
+                    oIter = oEnds.find(ls.front());
+                if (oIter == oEnds.end() && ls.back().y == dfTopSeam)
+                    oIter = oEnds.find(ls.back());
+                if (oIter == oEnds.end())
+                    break;
+                const marching_squares::Point oJoin = oIter->first;
+                auto oOther = oIter->second;
+                RemoveEnds(oEnds, oOther);
+                ContourJoinLines(ls, oOther->ls, oJoin);
+                aoChains_.erase(oOther);
+                bClosed = ls.front() == ls.back();
+            }
+
+            if (bClosed)
+            {
+                oAppender_.addLine(oCur->dfLevel, ls, /* closed */ true);
+                aoChains_.erase(oCur);
+                continue;
+            }
+            for (const auto &p : {ls.front(), ls.back()})
+            {
+                if (p.y == dfTopSeam || p.y == dfBottomSeam)
+                {
+                    oEnds.emplace(p, oCur);
+                    oCur->nOpenEnds++;
+                }
+            }
+        }
+        aoPieces.clear();
+
+        // Ends left on the top seam have no continuation in our stripe.
+        for (auto &oLevelEnds : aoEnds_)
+        {
+            Ends &oEnds = oLevelEnds.second;
+            for (auto oIter = oEnds.begin(); oIter != oEnds.end();)
+            {
+                if (oIter->first.y == dfTopSeam)
+                {
+                    oIter->second->nOpenEnds--;
+                    oIter = oEnds.erase(oIter);
+                }
+                else
+                {
+                    ++oIter;
+                }
+            }
+        }
+
+        for (auto oIter = aoChains_.begin(); oIter != aoChains_.end();)
+        {
+            if (oIter->nOpenEnds == 0)
+            {
+                oAppender_.addLine(oIter->dfLevel, oIter->ls,
+                                   /* closed */ false);
+                oIter = aoChains_.erase(oIter);
+            }
+            else
+            {
+                ++oIter;
+            }
+        }
+    }
+
+  private:
+    struct Chain
+    {
+        double dfLevel;
+        marching_squares::LineString ls;
+        int nOpenEnds = 0;
+    };
+
+    typedef std::list<Chain> Chains;
+    typedef std::unordered_multimap<marching_squares::Point, Chains::iterator,
+                                    marching_squares::PointHash>
+        Ends;
+
+    GDALRingAppender &oAppender_;
+    Chains aoChains_{};
+    // Ends of the chains that lie on a seam, per level
+    std::map<double, Ends> aoEnds_{};
+
+    static void RemoveEnds(Ends &oEnds, Chains::iterator oChain)
+    {
+        for (const auto &p : {oChain->ls.front(), oChain->ls.back()})
+        {
+            auto oRange = oEnds.equal_range(p);
+            for (auto oIter = oRange.first; oIter != oRange.second;)
+            {
+                if (oIter->second == oChain)
+                    oIter = oEnds.erase(oIter);
+                else
+                    ++oIter;
+            }
+        }
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(ContourSeamMerger)
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                     ContourGenerateMultiThreaded()                   */
+/************************************************************************/
+
+// Generate contour lines by horizontal stripes processed by worker threads.
+// Pieces of lines that cross the seams between stripes are joined back in
+// the main thread, which also does all the writing.
+template <class LevelGenerator>
+static bool ContourGenerateMultiThreaded(
+    GDALRasterBandH hBand, bool bUseNoData, double dfNoDataValue,
+    LevelGenerator &oLevels, GDALRingAppender &oAppender, int nLinesPerStripe,
+    CPLJobQueue *poJobQueue, int nThreads, GDALProgressFunc pfnProgress,
+    void *pProgressArg)
+{
+    const int nXSize = GDALGetRasterBandXSize(hBand);
+    const int nYSize = GDALGetRasterBandYSize(hBand);
+    ContourSeamMerger oMerger(oAppender);
+
+    std::mutex oMutex;
+    std::condition_variable oCV;
+    std::deque<std::unique_ptr<ContourStripe<LevelGenerator>>>
+        apoPendingStripes;
+    const size_t nMaxPendingStripes = static_cast<size_t>(nThreads) + 1;
+    bool bOK = true;
+
+    // Wait for the oldest pending stripe to be processed, and write its
+    // lines.
+    const auto ConsumeOldestStripe = [&]()
+    {
+        auto &poStripe = apoPendingStripes.front();
+        {
+            std::unique_lock<std::mutex> oLock(oMutex);
+            oCV.wait(oLock, [&poStripe] { return poStripe->bDone; });
+        }
+        if (bOK && !poStripe->osError.empty())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "%s",
+                     poStripe->osError.c_str());
+            bOK = false;
+        }
+        if (bOK)
+        {
+            for (auto &oLine : poStripe->aoCompleteLines)
+                oAppender.addLine(oLine.first, oLine.second,
+                                  /* closed */ false);
+            const int nYEnd = poStripe->nYOff + poStripe->nLines;
+            oMerger.AddPieces(poStripe->aoPieces,
+                              ContourSeamY(poStripe->nYOff),
+                              nYEnd < nYSize
+                                  ? ContourSeamY(nYEnd)
+                                  : std::numeric_limits<double>::quiet_NaN());
+            if (!pfnProgress(double(nYEnd) / nYSize, "Processing line",
+                             pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                bOK = false;
+            }
+        }
+        apoPendingStripes.pop_front();
+    };
+
+    for (int nYOff = 0; nYOff < nYSize; nYOff += nLinesPerStripe)
+    {
+        while (bOK && apoPendingStripes.size() >= nMaxPendingStripes)
+        {
+            ConsumeOldestStripe();
+        }
+        if (!bOK)
+            break;
+
+        auto poStripe = std::make_unique<ContourStripe<LevelGenerator>>();
+        poStripe->nXSize = nXSize;
+        poStripe->nYSize = nYSize;
+        poStripe->bUseNoData = bUseNoData;
+        poStripe->dfNoDataValue = dfNoDataValue;
+        poStripe->poLevels = &oLevels;
+        poStripe->nYOff = nYOff;
+        poStripe->nLines = std::min(nLinesPerStripe, nYSize - nYOff);
+        poStripe->poMutex = &oMutex;
+        poStripe->poCV = &oCV;
+
+        // Also read the last line of the previous stripe
+        const int nFirstLine = nYOff > 0 ? nYOff - 1 : 0;
+        const int nReadLines = nYOff + poStripe->nLines - nFirstLine;
+        try
+        {
+            poStripe->adfData.resize(static_cast<size_t>(nReadLines) *
+                                     nXSize);
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate stripe buffer");
+            bOK = false;
+            break;
+        }
+        if (GDALRasterIO(hBand, GF_Read, 0, nFirstLine, nXSize, nReadLines,
+                         poStripe->adfData.data(), nXSize, nReadLines,
+                         GDT_Float64, 0, 0) != CE_None)
+        {
+            CPLDebug("CONTOUR", "failed fetch %d %d", nFirstLine, nReadLines);
+            bOK = false;
+            break;
+        }
+
+        if (!poJobQueue->SubmitJob(ContourProcessStripeJob<LevelGenerator>,
+                                   poStripe.get()))
+        {
+            ContourProcessStripeJob<LevelGenerator>(poStripe.get());
+        }
+        apoPendingStripes.push_back(std::move(poStripe));
+    }
+
+    // Also done on error, so that no job is still using the stripes when
+    // they are freed.
+    while (!apoPendingStripes.empty())
+        ConsumeOldestStripe();
+    poJobQueue->WaitCompletion();
+
+    if (bOK)
+        pfnProgress(1.0, "", pProgressArg);
+    return bOK;
+}
+
+/************************************************************************/
+/*                         ContourGenerateLines()                       */
+/************************************************************************/
+
+template <class LevelGenerator>
+static bool ContourGenerateLines(GDALRasterBandH hBand, bool bUseNoData,
+                                 double dfNoDataValue, LevelGenerator &oLevels,
+                                 GDALRingAppender &oAppender,
+                                 int nLinesPerStripe, CPLJobQueue *poJobQueue,
+                                 int nThreads, GDALProgressFunc pfnProgress,
+                                 void *pProgressArg)
+{
+    using namespace marching_squares;
+
+    if (poJobQueue)
+    {
+        return ContourGenerateMultiThreaded(
+            hBand, bUseNoData, dfNoDataValue, oLevels, oAppender,
+            nLinesPerStripe, poJobQueue, nThreads, pfnProgress, pProgressArg);
+    }
+
+    SegmentMerger<GDALRingAppender, LevelGenerator> writer(
+        oAppender, oLevels, /* polygonize */ false);
+    ContourGeneratorFromRaster<decltype(writer), LevelGenerator> cg(
+        hBand, bUseNoData, dfNoDataValue, writer, oLevels);
+    return cg.process(pfnProgress, pProgressArg);
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                   Additional C Callable Functions                    */
@@ -543,6 +988,15 @@ mode.
  *
  * If YES, contour polygons will be created, rather than polygon lines.
  *
+ *   NUM_THREADS=N|ALL_CPUS
+ *
+ * (GDAL >= 3.9) Number of worker threads used to process horizontal stripes
+ * of the raster in parallel, in line contouring mode. Defaults to the value
+ * of the GDAL_NUM_THREADS configuration option, or 1. Lines that span
+ * several stripes are joined back, but the order in which features are
+ * written, and the start point of closed lines, differ from the
+ * single-threaded mode.
+ *
  *
  * @return CE_None on success or CE_Failure if an error occurs.
  */
@@ -699,37 +1153,59 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
         }
         else
         {
+            // Process the raster by stripes in worker threads if asked to.
+            const char *pszNumThreads =
+                CSLFetchNameValue(options, "NUM_THREADS");
+            if (pszNumThreads == nullptr)
+                pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+            int nThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                               ? CPLGetNumCPUs()
+                               : atoi(pszNumThreads);
+            nThreads = std::max(1, std::min(128, nThreads));
+            const int nXSize = GDALGetRasterBandXSize(hBand);
+            const int nYSize = GDALGetRasterBandYSize(hBand);
+            // Stripes of about 1 M pixels. The config option is only for
+            // testing.
+            const int nDefaultLinesPerStripe =
+                std::max(16, 1024 * 1024 / std::max(1, nXSize));
+            const int nLinesPerStripe = std::max(
+                1, atoi(CPLGetConfigOption(
+                       "GDAL_CONTOUR_STRIPE_HEIGHT",
+                       CPLSPrintf("%d", nDefaultLinesPerStripe))));
+            std::unique_ptr<CPLJobQueue> poJobQueue;
+            if (nThreads > 1 && nYSize > nLinesPerStripe)
+            {
+                CPLWorkerThreadPool *poThreadPool =
+                    GDALGetGlobalThreadPool(nThreads);
+                if (poThreadPool)
+                    poJobQueue = poThreadPool->CreateJobQueue();
+            }
+
             GDALRingAppender appender(OGRContourWriter, &oCWI);
             if (!fixedLevels.empty())
             {
                 FixedLevelRangeIterator levels(&fixedLevels[0],
                                                fixedLevels.size());
-                SegmentMerger<GDALRingAppender, FixedLevelRangeIterator> writer(
-                    appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           FixedLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                ok = ContourGenerateLines(hBand, useNoData, noDataValue,
+                                          levels, appender, nLinesPerStripe,
+                                          poJobQueue.get(), nThreads,
+                                          pfnProgress, pProgressArg);
             }
             else if (expBase > 0.0)
             {
                 ExponentialLevelRangeIterator levels(expBase);
-                SegmentMerger<GDALRingAppender, ExponentialLevelRangeIterator>
-                    writer(appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           ExponentialLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                ok = ContourGenerateLines(hBand, useNoData, noDataValue,
+                                          levels, appender, nLinesPerStripe,
+                                          poJobQueue.get(), nThreads,
+                                          pfnProgress, pProgressArg);
             }
             else
             {
                 IntervalLevelRangeIterator levels(contourBase, contourInterval);
-                SegmentMerger<GDALRingAppender, IntervalLevelRangeIterator>
-                    writer(appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           IntervalLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                ok = ContourGenerateLines(hBand, useNoData, noDataValue,
+                                          levels, appender, nLinesPerStripe,
+                                          poJobQueue.get(), nThreads,
+                                          pfnProgress, pProgressArg);
             }
         }
     }
@@ -325,6 +325,15 @@ CPLErr CPL_DLL GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
                                      GDALProgressFunc pfnProgress,
                                      void *pProgressArg);
 
+/* -------------------------------------------------------------------- */
+/*      Zonal statistics                                                */
+/* -------------------------------------------------------------------- */
+
+CPLErr CPL_DLL GDALZonalStats(GDALRasterBandH hSrcBand, OGRLayerH hZoneLayer,
+                              OGRLayerH hDstLayer, CSLConstList papszOptions,
+                              GDALProgressFunc pfnProgress,
+                              void *pProgressArg);
+
 /* -------------------------------------------------------------------- */
 /*      Viewshed Generation                                             */
 /* -------------------------------------------------------------------- */
@@ -356,6 +365,15 @@ GDALDatasetH CPL_DLL GDALViewshedGenerate(
     void *pProgressArg, GDALViewshedOutputType heightMode,
     CSLConstList papszExtraOptions);
 
+GDALDatasetH CPL_DLL GDALViewshedGenerateCumulative(
+    GDALRasterBandH hBand, const char *pszDriverName,
+    const char *pszTargetRasterName, CSLConstList papszCreationOptions,
+    int nObserverCount, const double *padfObserverX,
+    const double *padfObserverY, const double *padfObserverHeight,
+    double dfTargetHeight, double dfCurvCoeff, GDALViewshedMode eMode,
+    double dfMaxDistance, GDALProgressFunc pfnProgress, void *pProgressArg,
+    CSLConstList papszExtraOptions);
+
 /************************************************************************/
 /*      Rasterizer API - geometries burned into GDAL raster.            */
 /************************************************************************/
@@ -92,6 +92,7 @@ typedef enum
 
 typedef void (*llScanlineFunc)(void *, int, int, int, double);
 typedef void (*llPointFunc)(void *, int, int, double);
+typedef void (*llScanlineCoverageFunc)(void *, int, int, int, const double *);
 
 void GDALdllImagePoint(int nRasterXSize, int nRasterYSize, int nPartCount,
                        const int *panPartSize, const double *padfX,
@@ -118,6 +119,12 @@ void GDALdllImageFilledPolygon(int nRasterXSize, int nRasterYSize,
                                llScanlineFunc pfnScanlineFunc, void *pCBData,
                                bool bAvoidBurningSamePoints);
 
+void GDALdllImageFilledPolygonCoverage(int nRasterXSize, int nRasterYSize,
+                                       int nPartCount, const int *panPartSize,
+                                       const double *padfX, const double *padfY,
+                                       llScanlineCoverageFunc pfnScanlineFunc,
+                                       void *pCBData);
+
 CPL_C_END
 
 /************************************************************************/
@@ -197,7 +204,7 @@ bool GDALTransformIsTranslationOnPixelBoundaries(
 bool GDALTransformIsAffineNoRotation(GDALTransformerFunc pfnTransformer,
                                      void *pTransformerArg);
 
-typedef struct _CPLQuadTree CPLQuadTree;
+class CPLPackedRTree;
 
 typedef struct
 {
@@ -245,10 +252,13 @@ typedef struct
 
     bool bOriginIsTopLeftCorner;
     bool bGeographicSRSWithMinus180Plus180LongRange;
-    CPLQuadTree *hQuadTree;
+    CPLPackedRTree *poRTree;
 
     char **papszGeolocationInfo;
 
+    // Directory where generated backmaps are cached, or nullptr.
+    char *pszBackMapCacheDir;
+
 } GDALGeoLocTransformInfo;
 
 /************************************************************************/
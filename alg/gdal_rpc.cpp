@@ -38,6 +38,7 @@
 #include <algorithm>
 #include <limits>
 #include <string>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -264,9 +265,20 @@ typedef struct
     int bApplyDEMVDatumShift;
 
     GDALDataset *poDS;
+    int bDEMHasNoData;
+    double dfDEMNoDataValue;
     // the key is (nYBlock << 32) | nXBlock)
     lru11::Cache<uint64_t, std::shared_ptr<std::vector<double>>> *poCacheDEM;
 
+    // Window of the DEM covering the validity domain of the RPC, read
+    // entirely on the first DEM request if small enough.
+    bool bDEMPinnedWindowTried;
+    double *padfDEMPinnedWindow;
+    int nDEMPinnedXOff;
+    int nDEMPinnedYOff;
+    int nDEMPinnedXSize;
+    int nDEMPinnedYSize;
+
     OGRCoordinateTransformation *poCT;
 
     int nMaxIterations;
@@ -551,11 +563,14 @@ static int GDALRPCGetDEMHeight(GDALRPCTransformInfo *psTransform,
                                const double dfXIn, const double dfYIn,
                                double *pdfDEMH);
 
+// padfDEMSRSXYZ, if not null, is (dfXIn, dfYIn, 0) already transformed with
+// poCT.
 static bool GDALRPCGetHeightAtLongLat(GDALRPCTransformInfo *psTransform,
                                       const double dfXIn, const double dfYIn,
                                       double *pdfHeight,
                                       double *pdfDEMPixel = nullptr,
-                                      double *pdfDEMLine = nullptr)
+                                      double *pdfDEMLine = nullptr,
+                                      const double *padfDEMSRSXYZ = nullptr)
 {
     double dfVDatumShift = 0.0;
     double dfDEMH = 0.0;
@@ -569,7 +584,14 @@ static bool GDALRPCGetHeightAtLongLat(GDALRPCTransformInfo *psTransform,
         if (psTransform->poCT)
         {
             double dfZ = 0.0;
-            if (!psTransform->poCT->Transform(1, &dfXTemp, &dfYTemp, &dfZ))
+            if (padfDEMSRSXYZ)
+            {
+                dfXTemp = padfDEMSRSXYZ[0];
+                dfYTemp = padfDEMSRSXYZ[1];
+                dfZ = padfDEMSRSXYZ[2];
+            }
+            else if (!psTransform->poCT->Transform(1, &dfXTemp, &dfYTemp,
+                                                   &dfZ))
             {
                 return false;
             }
@@ -750,7 +772,11 @@ void *GDALCreateRPCTransformerV1(GDALRPCInfoV1 *psRPCInfo, int bReversed,
  * extract elevation offsets from. In this situation the Z passed into the
  * transformation function is assumed to be height above ground. This option
  * should be used in replacement of RPC_HEIGHT to provide a way of defining
- * a non uniform ground for the target scene</li>
+ * a non uniform ground for the target scene. Starting with GDAL 3.9, the
+ * window of the DEM covering the validity domain of the RPC is read in
+ * memory on first use, if it is not larger than the value of the
+ * GDAL_RPC_DEM_PINNED_CACHE_MB configuration option (32 by default, 0 to
+ * disable).</li>
  *
  * <li> RPC_DEMINTERPOLATION: the DEM interpolation ("near", "bilinear" or
  "cubic").
@@ -1107,6 +1133,7 @@ void GDALDestroyRPCTransformer(void *pTransformAlg)
     if (psTransform->poDS)
         GDALClose(psTransform->poDS);
     delete psTransform->poCacheDEM;
+    VSIFree(psTransform->padfDEMPinnedWindow);
     if (psTransform->poCT)
         OCTDestroyCoordinateTransformation(
             reinterpret_cast<OGRCoordinateTransformationH>(psTransform->poCT));
@@ -1384,6 +1411,110 @@ static double BiCubicKernel(double dfVal)
     return 0.16666666666666666667 * (a - (4.0 * b) + (6.0 * c) - (4.0 * d));
 }
 
+/************************************************************************/
+/*                         GDALRPCPinDEMWindow()                        */
+/************************************************************************/
+
+// Read in memory the window of the DEM that covers the validity domain of
+// the RPC (normalized longitude and latitude within [-1,1], with some
+// margin), if it is not larger than GDAL_RPC_DEM_PINNED_CACHE_MB. DEM
+// requests within it then no longer go through the block cache.
+static void GDALRPCPinDEMWindow(GDALRPCTransformInfo *psTransform)
+{
+    psTransform->bDEMPinnedWindowTried = true;
+
+    const double dfMaxMB =
+        CPLAtof(CPLGetConfigOption("GDAL_RPC_DEM_PINNED_CACHE_MB", "32"));
+    if (!(dfMaxMB > 0))
+        return;
+
+    // Sample the border of the validity domain.
+    constexpr int NSTEPS = 20;
+    constexpr double MARGIN = 1.1;
+    const GDALRPCInfoV2 &sRPC = psTransform->sRPC;
+    std::vector<double> adfX, adfY, adfZ;
+    for (int i = 0; i <= NSTEPS; i++)
+    {
+        const double dfT = MARGIN * (2.0 * i / NSTEPS - 1);
+        const double adfEdgeX[] = {dfT, dfT, -MARGIN, MARGIN};
+        const double adfEdgeY[] = {-MARGIN, MARGIN, dfT, dfT};
+        for (int k = 0; k < 4; k++)
+        {
+            adfX.push_back(sRPC.dfLONG_OFF + adfEdgeX[k] * sRPC.dfLONG_SCALE);
+            adfY.push_back(sRPC.dfLAT_OFF + adfEdgeY[k] * sRPC.dfLAT_SCALE);
+        }
+    }
+    adfZ.resize(adfX.size());
+    std::vector<int> abSuccess(adfX.size(), TRUE);
+    if (psTransform->poCT)
+    {
+        CPLErrorStateBackuper oErrorStateBackuper;
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        psTransform->poCT->Transform(static_cast<int>(adfX.size()),
+                                     adfX.data(), adfY.data(), adfZ.data(),
+                                     abSuccess.data());
+    }
+
+    double dfMinX = std::numeric_limits<double>::infinity();
+    double dfMinY = std::numeric_limits<double>::infinity();
+    double dfMaxX = -std::numeric_limits<double>::infinity();
+    double dfMaxY = -std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < adfX.size(); i++)
+    {
+        // A failed point means the domain is not well-behaved in the DEM
+        // SRS: give up.
+        if (!abSuccess[i])
+            return;
+        double dfX = 0;
+        double dfY = 0;
+        GDALApplyGeoTransform(psTransform->adfDEMReverseGeoTransform, adfX[i],
+                              adfY[i], &dfX, &dfY);
+        dfMinX = std::min(dfMinX, dfX);
+        dfMinY = std::min(dfMinY, dfY);
+        dfMaxX = std::max(dfMaxX, dfX);
+        dfMaxY = std::max(dfMaxY, dfY);
+    }
+
+    // Margin of 2 pixels for the cubic kernel.
+    const double dfXOff = std::max(0.0, std::floor(dfMinX) - 2);
+    const double dfYOff = std::max(0.0, std::floor(dfMinY) - 2);
+    const double dfXEnd = std::min(
+        static_cast<double>(psTransform->poDS->GetRasterXSize()),
+        std::ceil(dfMaxX) + 2);
+    const double dfYEnd = std::min(
+        static_cast<double>(psTransform->poDS->GetRasterYSize()),
+        std::ceil(dfMaxY) + 2);
+    if (!(dfXEnd > dfXOff && dfYEnd > dfYOff) ||
+        (dfXEnd - dfXOff) * (dfYEnd - dfYOff) * sizeof(double) >
+            dfMaxMB * 1024 * 1024)
+    {
+        return;
+    }
+
+    const int nXOff = static_cast<int>(dfXOff);
+    const int nYOff = static_cast<int>(dfYOff);
+    const int nXSize = static_cast<int>(dfXEnd) - nXOff;
+    const int nYSize = static_cast<int>(dfYEnd) - nYOff;
+    double *padfWindow = static_cast<double *>(
+        VSI_MALLOC3_VERBOSE(sizeof(double), nXSize, nYSize));
+    if (padfWindow == nullptr)
+        return;
+    if (psTransform->poDS->GetRasterBand(1)->RasterIO(
+            GF_Read, nXOff, nYOff, nXSize, nYSize, padfWindow, nXSize, nYSize,
+            GDT_Float64, 0, 0, nullptr) != CE_None)
+    {
+        VSIFree(padfWindow);
+        return;
+    }
+    CPLDebug("RPC", "Pinning DEM window (%d,%d,%d,%d) in memory", nXOff,
+             nYOff, nXSize, nYSize);
+    psTransform->padfDEMPinnedWindow = padfWindow;
+    psTransform->nDEMPinnedXOff = nXOff;
+    psTransform->nDEMPinnedYOff = nYOff;
+    psTransform->nDEMPinnedXSize = nXSize;
+    psTransform->nDEMPinnedYSize = nYSize;
+}
+
 /************************************************************************/
 /*                        GDALRPCExtractDEMWindow()                     */
 /************************************************************************/
@@ -1392,6 +1523,29 @@ static bool GDALRPCExtractDEMWindow(GDALRPCTransformInfo *psTransform, int nX,
                                     int nY, int nWidth, int nHeight,
                                     double *padfOut)
 {
+    if (!psTransform->bDEMPinnedWindowTried)
+        GDALRPCPinDEMWindow(psTransform);
+    if (psTransform->padfDEMPinnedWindow &&
+        nX >= psTransform->nDEMPinnedXOff &&
+        nY >= psTransform->nDEMPinnedYOff &&
+        nX + nWidth <=
+            psTransform->nDEMPinnedXOff + psTransform->nDEMPinnedXSize &&
+        nY + nHeight <=
+            psTransform->nDEMPinnedYOff + psTransform->nDEMPinnedYSize)
+    {
+        const double *padfSrc =
+            psTransform->padfDEMPinnedWindow +
+            static_cast<size_t>(nY - psTransform->nDEMPinnedYOff) *
+                psTransform->nDEMPinnedXSize +
+            (nX - psTransform->nDEMPinnedXOff);
+        for (int j = 0; j < nHeight; j++)
+        {
+            memcpy(padfOut + j * nWidth, padfSrc, nWidth * sizeof(double));
+            padfSrc += psTransform->nDEMPinnedXSize;
+        }
+        return true;
+    }
+
     constexpr int BLOCK_SIZE = 64;
 
     // Request the DEM by blocks of BLOCK_SIZE * BLOCK_SIZE and put them
@@ -1501,9 +1655,8 @@ static int GDALRPCGetDEMHeight(GDALRPCTransformInfo *psTransform,
 {
     const int nRasterXSize = psTransform->poDS->GetRasterXSize();
     const int nRasterYSize = psTransform->poDS->GetRasterYSize();
-    int bGotNoDataValue = FALSE;
-    const double dfNoDataValue =
-        psTransform->poDS->GetRasterBand(1)->GetNoDataValue(&bGotNoDataValue);
+    const int bGotNoDataValue = psTransform->bDEMHasNoData;
+    const double dfNoDataValue = psTransform->dfDEMNoDataValue;
 
     if (psTransform->eResampleAlg == DRA_Cubic)
     {
@@ -1684,9 +1837,8 @@ GDALRPCTransformWholeLineWithDEM(const GDALRPCTransformInfo *psTransform,
         return FALSE;
     }
 
-    int bGotNoDataValue = FALSE;
-    const double dfNoDataValue =
-        psTransform->poDS->GetRasterBand(1)->GetNoDataValue(&bGotNoDataValue);
+    const int bGotNoDataValue = psTransform->bDEMHasNoData;
+    const double dfNoDataValue = psTransform->dfDEMNoDataValue;
 
     // dfY in pixel center convention.
     const double dfY = psTransform->adfDEMReverseGeoTransform[3] +
@@ -2012,6 +2164,10 @@ static bool GDALRPCOpenDEM(GDALRPCTransformInfo *psTransform)
             delete poDSSpaRef;
         }
 
+        psTransform->dfDEMNoDataValue =
+            psTransform->poDS->GetRasterBand(1)->GetNoDataValue(
+                &psTransform->bDEMHasNoData);
+
         if (psTransform->poDS->GetGeoTransform(
                 psTransform->adfDEMGeoTransform) == CE_None &&
             GDALInvGeoTransform(psTransform->adfDEMGeoTransform,
@@ -2146,6 +2302,33 @@ int GDALRPCTransform(void *pTransformArg, int bDstToSrc, int nPointCount,
             }
         }
 
+        // Transform all points to the DEM SRS at once, rather than one at
+        // a time when looking for their height.
+        std::vector<double> adfDEMSRSXYZ;
+        std::vector<int> abDEMSRSSuccess;
+        if (psTransform->poDS != nullptr && psTransform->poCT != nullptr &&
+            nPointCount > 1)
+        {
+            std::vector<double> adfX(padfX, padfX + nPointCount);
+            std::vector<double> adfY(padfY, padfY + nPointCount);
+            std::vector<double> adfZ(nPointCount);
+            abDEMSRSSuccess.resize(nPointCount);
+            if (!psTransform->poCT->Transform(nPointCount, adfX.data(),
+                                              adfY.data(), adfZ.data(),
+                                              abDEMSRSSuccess.data()))
+            {
+                std::fill(abDEMSRSSuccess.begin(), abDEMSRSSuccess.end(),
+                          FALSE);
+            }
+            adfDEMSRSXYZ.resize(3 * static_cast<size_t>(nPointCount));
+            for (int i = 0; i < nPointCount; i++)
+            {
+                adfDEMSRSXYZ[3 * i] = adfX[i];
+                adfDEMSRSXYZ[3 * i + 1] = adfY[i];
+                adfDEMSRSXYZ[3 * i + 2] = adfZ[i];
+            }
+        }
+
         for (int i = 0; i < nPointCount; i++)
         {
             if (!RPCIsValidLongLat(psTransform, padfX[i], padfY[i]))
@@ -2156,8 +2339,11 @@ int GDALRPCTransform(void *pTransformArg, int bDstToSrc, int nPointCount,
                 continue;
             }
             double dfHeight = 0.0;
-            if (!GDALRPCGetHeightAtLongLat(psTransform, padfX[i], padfY[i],
-                                           &dfHeight))
+            if ((!abDEMSRSSuccess.empty() && !abDEMSRSSuccess[i]) ||
+                !GDALRPCGetHeightAtLongLat(
+                    psTransform, padfX[i], padfY[i], &dfHeight, nullptr,
+                    nullptr,
+                    adfDEMSRSXYZ.empty() ? nullptr : &adfDEMSRSXYZ[3 * i]))
             {
                 panSuccess[i] = FALSE;
                 padfX[i] = HUGE_VAL;
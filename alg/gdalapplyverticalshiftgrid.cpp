@@ -38,6 +38,7 @@
 
 #include "proj.h"
 
+#include <algorithm>
 #include <limits>
 
 /************************************************************************/
@@ -246,37 +247,49 @@ CPLErr GDALApplyVSGRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff,
         const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
         int bHasNoData = FALSE;
         float fNoDataValue = static_cast<float>(GetNoDataValue(&bHasNoData));
+        const double dfSrcUnitToMeter = poGDS->m_dfSrcUnitToMeter;
+        const double dfDstUnitToMeter = poGDS->m_dfDstUnitToMeter;
+        const double dfGridSign = poGDS->m_bInverse ? -1.0 : 1.0;
         for (int iY = 0; iY < nReqYSize; iY++)
         {
+            float *pafSrcLine =
+                m_pafSrcData + static_cast<size_t>(iY) * nBlockXSize;
+            const float *pafGridLine =
+                m_pafGridData + static_cast<size_t>(iY) * nBlockXSize;
+
+            // Branch-free loop, so that the compiler can vectorize it.
+            // Missing grid values are checked after it.
+            bool bMissingGridValue = false;
             for (int iX = 0; iX < nReqXSize; iX++)
             {
-                const float fSrcVal = m_pafSrcData[iY * nBlockXSize + iX];
-                const float fGridVal = m_pafGridData[iY * nBlockXSize + iX];
-                if (bHasNoData && fSrcVal == fNoDataValue)
-                {
-                }
-                else if (CPLIsInf(fGridVal))
-                {
-                    CPLError(CE_Failure, CPLE_AppDefined,
-                             "Missing vertical grid value at source (%d,%d)",
-                             nXOff + iX, nYOff + iY);
-                    return CE_Failure;
-                }
-                else if (poGDS->m_bInverse)
-                {
-                    m_pafSrcData[iY * nBlockXSize + iX] = static_cast<float>(
-                        (fSrcVal * poGDS->m_dfSrcUnitToMeter - fGridVal) /
-                        poGDS->m_dfDstUnitToMeter);
-                }
-                else
+                const float fSrcVal = pafSrcLine[iX];
+                const float fGridVal = pafGridLine[iX];
+                const bool bIsNoData = bHasNoData && fSrcVal == fNoDataValue;
+                bMissingGridValue |= !bIsNoData && CPLIsInf(fGridVal);
+                const float fShiftedVal = static_cast<float>(
+                    (fSrcVal * dfSrcUnitToMeter + dfGridSign * fGridVal) /
+                    dfDstUnitToMeter);
+                pafSrcLine[iX] = bIsNoData ? fSrcVal : fShiftedVal;
+            }
+            if (bMissingGridValue)
+            {
+                for (int iX = 0; iX < nReqXSize; iX++)
                 {
-                    m_pafSrcData[iY * nBlockXSize + iX] = static_cast<float>(
-                        (fSrcVal * poGDS->m_dfSrcUnitToMeter + fGridVal) /
-                        poGDS->m_dfDstUnitToMeter);
+                    if (CPLIsInf(pafGridLine[iX]) &&
+                        !(bHasNoData && pafSrcLine[iX] == fNoDataValue))
+                    {
+                        CPLError(CE_Failure, CPLE_AppDefined,
+                                 "Missing vertical grid value at source "
+                                 "(%d,%d)",
+                                 nXOff + iX, nYOff + iY);
+                        break;
+                    }
                 }
+                return CE_Failure;
             }
+
             GDALCopyWords(
-                m_pafSrcData + iY * nBlockXSize, GDT_Float32, sizeof(float),
+                pafSrcLine, GDT_Float32, sizeof(float),
                 static_cast<GByte *>(pData) + iY * nBlockXSize * nDTSize,
                 eDataType, nDTSize, nReqXSize);
         }
@@ -344,6 +357,9 @@ CPLErr GDALApplyVSGRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff,
  * hGridDataset should cause I/O requests to fail. Default is NO (in which case
  * 0 will be used)
  * <li>SRC_SRS=srs_def. Override projection on hSrcDataset;
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS. Number of threads used to
+ * reproject hGridDataset. Defaults to the value of the GDAL_NUM_THREADS
+ * configuration option. (GDAL &gt;= 3.9)</li>
  * </ul>
  *
  * @return a new dataset corresponding to hSrcDataset adjusted with
@@ -491,6 +507,10 @@ GDALDatasetH GDALApplyVerticalShiftGrid(GDALDatasetH hSrcDataset,
         (bErrorOnMissingShift) ? -std::numeric_limits<float>::infinity() : 0.0;
     psWO->papszWarpOptions =
         CSLSetNameValue(psWO->papszWarpOptions, "INIT_DEST", "NO_DATA");
+    const char *pszNumThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszNumThreads)
+        psWO->papszWarpOptions = CSLSetNameValue(psWO->papszWarpOptions,
+                                                 "NUM_THREADS", pszNumThreads);
 
     psWO->pfnTransformer = GDALGenImgProjTransform;
     psWO->pTransformerArg = hTransform;
@@ -509,8 +529,15 @@ GDALDatasetH GDALApplyVerticalShiftGrid(GDALDatasetH hSrcDataset,
     psWO->panDstBands = static_cast<int *>(CPLMalloc(sizeof(int)));
     psWO->panDstBands[0] = 1;
 
-    VRTWarpedDataset *poReprojectedGrid =
-        new VRTWarpedDataset(nSrcXSize, nSrcYSize);
+    // Undocumented option. For testing only
+    const int nBlockSize =
+        atoi(CSLFetchNameValueDef(papszOptions, "BLOCKSIZE", "256"));
+
+    // Align the blocks of the reprojected grid with the ones of the output
+    // dataset, so that each output block triggers a single warp operation.
+    VRTWarpedDataset *poReprojectedGrid = new VRTWarpedDataset(
+        nSrcXSize, nSrcYSize, std::max(1, std::min(nSrcXSize, nBlockSize)),
+        std::max(1, std::min(nSrcYSize, nBlockSize)));
     // This takes a reference on hGridDataset
     CPLErr eErr = poReprojectedGrid->Initialize(psWO);
     CPLAssert(eErr == CE_None);
@@ -521,9 +548,7 @@ GDALDatasetH GDALApplyVerticalShiftGrid(GDALDatasetH hSrcDataset,
 
     GDALApplyVSGDataset *poOutDS = new GDALApplyVSGDataset(
         GDALDataset::FromHandle(hSrcDataset), poReprojectedGrid, eDT,
-        CPL_TO_BOOL(bInverse), dfSrcUnitToMeter, dfDstUnitToMeter,
-        // Undocumented option. For testing only
-        atoi(CSLFetchNameValueDef(papszOptions, "BLOCKSIZE", "256")));
+        CPL_TO_BOOL(bInverse), dfSrcUnitToMeter, dfDstUnitToMeter, nBlockSize);
 
     poReprojectedGrid->ReleaseRef();
 
@@ -43,11 +43,14 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
+#include <string>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_md5.h"
 #include "cpl_minixml.h"
-#include "cpl_quad_tree.h"
+#include "cpl_packed_rtree.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "gdal.h"
@@ -659,7 +662,7 @@ int GDALGeoLoc<Accessors>::Transform(void *pTransformArg, int bDstToSrc,
     /* -------------------------------------------------------------------- */
     else
     {
-        if (psTransform->hQuadTree)
+        if (psTransform->poRTree)
         {
             GDALGeoLocInverseTransformQuadtree(psTransform, nPointCount, padfX,
                                                padfY, panSuccess);
@@ -1005,6 +1008,193 @@ void GDALInverseBilinearInterpolation(const double x, const double y,
     j += s;
 }
 
+/************************************************************************/
+/*                    GDALGeoLocGetBackMapCacheKey()                    */
+/************************************************************************/
+
+// Compute the key identifying the backmap of a transformer in the cache
+// directory, and the corresponding filename. Returns false if caching is
+// disabled, or if the files holding the geolocation arrays cannot be
+// identified. The key includes the size and modification time of those
+// files, and all parameters that affect the backmap.
+static bool
+GDALGeoLocGetBackMapCacheKey(const GDALGeoLocTransformInfo *psTransform,
+                             std::string &osFilename, std::string &osKey)
+{
+    if (psTransform->pszBackMapCacheDir == nullptr)
+        return false;
+
+    osKey = "GDAL_GEOLOC_BACKMAP_V1";
+    for (CSLConstList papszIter = psTransform->papszGeolocationInfo;
+         papszIter && *papszIter; ++papszIter)
+    {
+        osKey += '\n';
+        osKey += *papszIter;
+    }
+
+    for (GDALDatasetH hDS : {psTransform->hDS_X, psTransform->hDS_Y})
+    {
+        std::string osDSFilename = GDALGetDescription(hDS);
+        VSIStatBufL sStat;
+        if (VSIStatL(osDSFilename.c_str(), &sStat) != 0)
+        {
+            GDALSubdatasetInfoH hInfo =
+                GDALGetSubdatasetInfo(osDSFilename.c_str());
+            if (hInfo)
+            {
+                char *pszPath = GDALSubdatasetInfoGetPathComponent(hInfo);
+                osDSFilename = pszPath ? pszPath : "";
+                CPLFree(pszPath);
+                GDALDestroySubdatasetInfo(hInfo);
+            }
+            if (osDSFilename.empty() ||
+                VSIStatL(osDSFilename.c_str(), &sStat) != 0)
+            {
+                CPLDebug("GEOLOC",
+                         "Cannot identify the file of %s. "
+                         "Backmap will not be cached",
+                         GDALGetDescription(hDS));
+                return false;
+            }
+        }
+        osKey += CPLSPrintf("\n%s " CPL_FRMT_GUIB " " CPL_FRMT_GIB,
+                            GDALGetDescription(hDS),
+                            static_cast<GUIntBig>(sStat.st_size),
+                            static_cast<GIntBig>(sStat.st_mtime));
+    }
+
+    osKey += CPLSPrintf(
+        "\n%d %d %d %d %d %d %.17g %.17g %.17g %.17g %.17g %.17g %.17g %.17g "
+        "%.17g %.17g %.17g",
+        psTransform->nGeoLocXSize, psTransform->nGeoLocYSize,
+        psTransform->bSwapXY, psTransform->bHasNoData,
+        static_cast<int>(psTransform->bOriginIsTopLeftCorner),
+        static_cast<int>(
+            psTransform->bGeographicSRSWithMinus180Plus180LongRange),
+        psTransform->dfNoDataX, psTransform->dfOversampleFactor,
+        psTransform->dfMinX, psTransform->dfMinY, psTransform->dfMaxX,
+        psTransform->dfMaxY, psTransform->dfPIXEL_OFFSET,
+        psTransform->dfPIXEL_STEP, psTransform->dfLINE_OFFSET,
+        psTransform->dfLINE_STEP, static_cast<double>(INVALID_BMXY));
+
+    osFilename = CPLFormFilename(
+        psTransform->pszBackMapCacheDir,
+        CPLSPrintf("geoloc_backmap_%s", CPLMD5String(osKey.c_str())), "tif");
+    return true;
+}
+
+/************************************************************************/
+/*                        LoadBackMapFromCache()                        */
+/************************************************************************/
+
+// Sets bLoaded to true if the backmap could be loaded from a cached file.
+// Returns false only in case of error after the backmap was allocated.
+template <class Accessors>
+bool GDALGeoLoc<Accessors>::LoadBackMapFromCache(
+    GDALGeoLocTransformInfo *psTransform, const std::string &osFilename,
+    const std::string &osKey, bool &bLoaded)
+{
+    bLoaded = false;
+
+    VSIStatBufL sStat;
+    if (VSIStatL(osFilename.c_str(), &sStat) != 0)
+        return true;
+
+    const char *const apszAllowedDrivers[] = {"GTiff", nullptr};
+    auto poCacheDS = std::unique_ptr<GDALDataset>(GDALDataset::Open(
+        osFilename.c_str(), GDAL_OF_RASTER, apszAllowedDrivers));
+    double adfGeoTransform[6];
+    const char *pszKey =
+        poCacheDS ? poCacheDS->GetMetadataItem("GEOLOC_BACKMAP_KEY") : nullptr;
+    if (pszKey == nullptr || osKey != pszKey ||
+        poCacheDS->GetRasterCount() != 2 ||
+        poCacheDS->GetRasterBand(1)->GetRasterDataType() != GDT_Float32 ||
+        poCacheDS->GetRasterBand(2)->GetRasterDataType() != GDT_Float32 ||
+        poCacheDS->GetGeoTransform(adfGeoTransform) != CE_None)
+    {
+        CPLDebug("GEOLOC", "Ignoring invalid cached backmap %s",
+                 osFilename.c_str());
+        return true;
+    }
+
+    CPLDebug("GEOLOC", "Loading backmap from %s", osFilename.c_str());
+    psTransform->nBackMapWidth = poCacheDS->GetRasterXSize();
+    psTransform->nBackMapHeight = poCacheDS->GetRasterYSize();
+    memcpy(psTransform->adfBackMapGeoTransform, adfGeoTransform,
+           sizeof(adfGeoTransform));
+
+    auto pAccessors = static_cast<Accessors *>(psTransform->pAccessors);
+    if (!pAccessors->AllocateBackMap())
+        return false;
+    pAccessors->FreeWghtsBackMap();
+
+    auto poBackmapDS = pAccessors->GetBackmapDataset();
+    const CPLErr eErr = GDALDatasetCopyWholeRaster(
+        GDALDataset::ToHandle(poCacheDS.get()),
+        GDALDataset::ToHandle(poBackmapDS), nullptr, nullptr, nullptr);
+    pAccessors->ReleaseBackmapDataset(poBackmapDS);
+    if (eErr != CE_None)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot read cached backmap %s", osFilename.c_str());
+        return false;
+    }
+
+    bLoaded = true;
+    return true;
+}
+
+/************************************************************************/
+/*                         SaveBackMapToCache()                         */
+/************************************************************************/
+
+template <class Accessors>
+void GDALGeoLoc<Accessors>::SaveBackMapToCache(
+    GDALGeoLocTransformInfo *psTransform, GDALDataset *poBackmapDS,
+    const std::string &osFilename, const std::string &osKey)
+{
+    auto poDriver = GDALDriver::FromHandle(GDALGetDriverByName("GTiff"));
+    if (poDriver == nullptr)
+        return;
+
+    VSIMkdirRecursive(psTransform->pszBackMapCacheDir, 0755);
+
+    // Write to a temporary file that is then renamed, so that concurrent
+    // processes never see a partial file.
+    const std::string osTmpFilename =
+        CPLSPrintf("%s." CPL_FRMT_GIB ".tmp.tif", osFilename.c_str(),
+                   CPLGetPID());
+    CPLStringList aosOptions;
+    aosOptions.SetNameValue("TILED", "YES");
+    aosOptions.SetNameValue("COMPRESS", "DEFLATE");
+    aosOptions.SetNameValue("PREDICTOR", "3");
+    aosOptions.SetNameValue("BIGTIFF", "IF_SAFER");
+    bool bOK;
+    {
+        CPLErrorStateBackuper oErrorStateBackuper;
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        auto poCacheDS = std::unique_ptr<GDALDataset>(
+            poDriver->CreateCopy(osTmpFilename.c_str(), poBackmapDS, false,
+                                 aosOptions.List(), nullptr, nullptr));
+        bOK = poCacheDS != nullptr;
+        if (poCacheDS)
+        {
+            poCacheDS->SetGeoTransform(psTransform->adfBackMapGeoTransform);
+            poCacheDS->SetMetadataItem("GEOLOC_BACKMAP_KEY", osKey.c_str());
+            bOK = poCacheDS->Close() == CE_None;
+        }
+    }
+    if (bOK && VSIRename(osTmpFilename.c_str(), osFilename.c_str()) == 0)
+    {
+        CPLDebug("GEOLOC", "Backmap saved in %s", osFilename.c_str());
+    }
+    else
+    {
+        CPLDebug("GEOLOC", "Cannot save backmap in %s", osFilename.c_str());
+        VSIUnlink(osTmpFilename.c_str());
+    }
+}
+
 /************************************************************************/
 /*                       GeoLocGenerateBackMap()                        */
 /************************************************************************/
@@ -1016,6 +1206,20 @@ bool GDALGeoLoc<Accessors>::GenerateBackMap(
     GDALGeoLocTransformInfo *psTransform)
 
 {
+    std::string osCacheFilename;
+    std::string osCacheKey;
+    const bool bUseCache = GDALGeoLocGetBackMapCacheKey(
+        psTransform, osCacheFilename, osCacheKey);
+    if (bUseCache)
+    {
+        bool bLoaded = false;
+        if (!LoadBackMapFromCache(psTransform, osCacheFilename, osCacheKey,
+                                  bLoaded))
+            return false;
+        if (bLoaded)
+            return true;
+    }
+
     CPLDebug("GEOLOC", "Starting backmap generation");
     const int nXSize = psTransform->nGeoLocXSize;
     const int nYSize = psTransform->nGeoLocYSize;
@@ -1572,6 +1776,13 @@ bool GDALGeoLoc<Accessors>::GenerateBackMap(
     }
 #endif
 
+    if (bUseCache)
+    {
+        pAccessors->FlushBackmapCaches();
+        SaveBackMapToCache(psTransform, poBackmapDS, osCacheFilename,
+                           osCacheKey);
+    }
+
     pAccessors->ReleaseBackmapDataset(poBackmapDS);
     CPLDebug("GEOLOC", "Ending backmap generation");
 
@@ -1802,6 +2013,12 @@ void *GDALCreateGeoLocTransformerEx(GDALDatasetH hBaseDS,
 
     psTransform->papszGeolocationInfo = CSLDuplicate(papszGeolocationInfo);
 
+    const char *pszBackMapCacheDir = CSLFetchNameValueDef(
+        papszTransformOptions, "GEOLOC_BACKMAP_CACHE_DIR",
+        CPLGetConfigOption("GDAL_GEOLOC_BACKMAP_CACHE_DIR", nullptr));
+    if (pszBackMapCacheDir && pszBackMapCacheDir[0])
+        psTransform->pszBackMapCacheDir = CPLStrdup(pszBackMapCacheDir);
+
     /* -------------------------------------------------------------------- */
     /*      Pull geolocation info from the options/metadata.                */
     /* -------------------------------------------------------------------- */
@@ -2063,6 +2280,7 @@ void GDALDestroyGeoLocTransformer(void *pTransformAlg)
         static_cast<GDALGeoLocTransformInfo *>(pTransformAlg);
 
     CSLDestroy(psTransform->papszGeolocationInfo);
+    CPLFree(psTransform->pszBackMapCacheDir);
 
     if (psTransform->bUseArray)
         delete static_cast<GDALGeoLocCArrayAccessors *>(
@@ -2079,8 +2297,7 @@ void GDALDestroyGeoLocTransformer(void *pTransformAlg)
         GDALDereferenceDataset(psTransform->hDS_Y) == 0)
         GDALClose(psTransform->hDS_Y);
 
-    if (psTransform->hQuadTree != nullptr)
-        CPLQuadTreeDestroy(psTransform->hQuadTree);
+    delete psTransform->poRTree;
 
     CPLFree(pTransformAlg);
 }
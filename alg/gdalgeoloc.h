@@ -31,6 +31,10 @@
 
 #include "gdal_alg_priv.h"
 
+#include <string>
+
+class GDALDataset;
+
 /************************************************************************/
 /*                           GDALGeoLoc                                 */
 /************************************************************************/
@@ -43,6 +47,16 @@ template <class Accessors> struct GDALGeoLoc
 
     static bool GenerateBackMap(GDALGeoLocTransformInfo *psTransform);
 
+    static bool LoadBackMapFromCache(GDALGeoLocTransformInfo *psTransform,
+                                     const std::string &osFilename,
+                                     const std::string &osKey,
+                                     bool &bLoaded);
+
+    static void SaveBackMapToCache(GDALGeoLocTransformInfo *psTransform,
+                                   GDALDataset *poBackmapDS,
+                                   const std::string &osFilename,
+                                   const std::string &osKey);
+
     static bool PixelLineToXY(const GDALGeoLocTransformInfo *psTransform,
                               const int nGeoLocPixel, const int nGeoLocLine,
                               double &dfX, double &dfY);
@@ -40,6 +40,7 @@
 #include <limits>
 #include <map>
 #include <utility>
+#include <vector>
 #include <algorithm>
 
 #include "cpl_conv.h"
@@ -56,20 +57,95 @@
 constexpr double TO_RADIANS = M_PI / 180.0;
 
 /************************************************************************/
-/*                        GDALGridGetPointBounds()                      */
+/*                          GDALGridPointIndex                          */
 /************************************************************************/
 
-static void GDALGridGetPointBounds(const void *hFeature, CPLRectObj *pBounds)
+// Points are sorted into the cells of a regular grid covering their extent
+// (counting sort), so that a rectangular search only visits one contiguous
+// run of point indices per row of cells it intersects.
+struct GDALGridPointIndex
 {
-    const GDALGridPoint *psPoint = static_cast<const GDALGridPoint *>(hFeature);
-    GDALGridXYArrays *psXYArrays = psPoint->psXYArrays;
-    const int i = psPoint->i;
-    const double dfX = psXYArrays->padfX[i];
-    const double dfY = psXYArrays->padfY[i];
-    pBounds->minx = dfX;
-    pBounds->miny = dfY;
-    pBounds->maxx = dfX;
-    pBounds->maxy = dfY;
+    const double *padfX = nullptr;
+    const double *padfY = nullptr;
+    double dfMinX = 0;
+    double dfMinY = 0;
+    double dfInvCellSize = 0;
+    int nCellsX = 1;
+    int nCellsY = 1;
+    // Index in anPointIdx of the first point of each cell. nCellsX * nCellsY
+    // + 1 elements.
+    std::vector<GUInt32> anCellStart{};
+    // Point indices, sorted by cell (row-major), then by increasing index.
+    std::vector<int> anPointIdx{};
+};
+
+/************************************************************************/
+/*                        GDALGridSearchPoints()                        */
+/************************************************************************/
+
+// Returns the indices of the points within the rectangle, in a buffer owned
+// by psExtraParams and valid until the next call.
+static const int *GDALGridSearchPoints(GDALGridExtraParameters *psExtraParams,
+                                       const CPLRectObj &sAoi, int *pnCount)
+{
+    const GDALGridPointIndex *psIndex = psExtraParams->psPointIndex;
+    *pnCount = 0;
+
+    const double dfX0 = (sAoi.minx - psIndex->dfMinX) * psIndex->dfInvCellSize;
+    const double dfX1 = (sAoi.maxx - psIndex->dfMinX) * psIndex->dfInvCellSize;
+    const double dfY0 = (sAoi.miny - psIndex->dfMinY) * psIndex->dfInvCellSize;
+    const double dfY1 = (sAoi.maxy - psIndex->dfMinY) * psIndex->dfInvCellSize;
+    if (!(dfX1 >= 0 && dfY1 >= 0 && dfX0 < psIndex->nCellsX &&
+          dfY0 < psIndex->nCellsY))
+    {
+        return psExtraParams->panSearchResults;
+    }
+    const int nCX0 = dfX0 > 0 ? static_cast<int>(dfX0) : 0;
+    const int nCY0 = dfY0 > 0 ? static_cast<int>(dfY0) : 0;
+    const int nCX1 =
+        dfX1 < psIndex->nCellsX ? static_cast<int>(dfX1) : psIndex->nCellsX - 1;
+    const int nCY1 =
+        dfY1 < psIndex->nCellsY ? static_cast<int>(dfY1) : psIndex->nCellsY - 1;
+
+    const double *padfX = psIndex->padfX;
+    const double *padfY = psIndex->padfY;
+    size_t nCount = 0;
+    for (int nCY = nCY0; nCY <= nCY1; ++nCY)
+    {
+        const size_t nRowOffset = static_cast<size_t>(nCY) * psIndex->nCellsX;
+        const GUInt32 nStart = psIndex->anCellStart[nRowOffset + nCX0];
+        const GUInt32 nEnd = psIndex->anCellStart[nRowOffset + nCX1 + 1];
+        if (nCount + (nEnd - nStart) > psExtraParams->nSearchResultsCapacity)
+        {
+            const size_t nNewCapacity =
+                std::max(2 * psExtraParams->nSearchResultsCapacity,
+                         nCount + (nEnd - nStart));
+            int *panNew = static_cast<int *>(VSI_REALLOC_VERBOSE(
+                psExtraParams->panSearchResults, nNewCapacity * sizeof(int)));
+            if (panNew == nullptr)
+            {
+                // Report what could be gathered so far.
+                break;
+            }
+            psExtraParams->panSearchResults = panNew;
+            psExtraParams->nSearchResultsCapacity = nNewCapacity;
+        }
+        int *panResults = psExtraParams->panSearchResults;
+        const int *panPointIdx = psIndex->anPointIdx.data();
+        for (GUInt32 j = nStart; j < nEnd; ++j)
+        {
+            const int i = panPointIdx[j];
+            const double dfX = padfX[i];
+            const double dfY = padfY[i];
+            if (dfX >= sAoi.minx && dfX <= sAoi.maxx && dfY >= sAoi.miny &&
+                dfY <= sAoi.maxy)
+            {
+                panResults[nCount++] = i;
+            }
+        }
+    }
+    *pnCount = static_cast<int>(nCount);
+    return psExtraParams->panSearchResults;
 }
 
 /************************************************************************/
@@ -273,8 +349,7 @@ CPLErr GDALGridInverseDistanceToAPowerNearestNeighbor(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->psPointIndex);
 
     const double dfRPower2 = psExtraParams->dfRadiusPower2PreComp;
     const double dfPowerDiv2 = psExtraParams->dfPowerDiv2PreComp;
@@ -288,13 +363,13 @@ CPLErr GDALGridInverseDistanceToAPowerNearestNeighbor(
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
     int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+    const int *panPoints =
+        GDALGridSearchPoints(psExtraParams, sAoi, &nFeatureCount);
     if (nFeatureCount != 0)
     {
         for (int k = 0; k < nFeatureCount; k++)
         {
-            const int i = papsPoints[k]->i;
+            const int i = panPoints[k];
             const double dfRX = padfX[i] - dfXPoint;
             const double dfRY = padfY[i] - dfYPoint;
 
@@ -304,7 +379,6 @@ CPLErr GDALGridInverseDistanceToAPowerNearestNeighbor(
             if (dfRsmoothed2 < 0.0000000000001)
             {
                 *pdfValue = padfZ[i];
-                CPLFree(papsPoints);
                 return CE_None;
             }
             // is point within real distance?
@@ -315,7 +389,6 @@ CPLErr GDALGridInverseDistanceToAPowerNearestNeighbor(
             }
         }
     }
-    CPLFree(papsPoints);
 
     double dfNominator = 0.0;
     double dfDenominator = 0.0;
@@ -382,8 +455,7 @@ static CPLErr GDALGridInverseDistanceToAPowerNearestNeighborPerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->psPointIndex);
 
     const double dfRPower2 = psExtraParams->dfRadiusPower2PreComp;
     const double dfPowerDiv2 = psExtraParams->dfPowerDiv2PreComp;
@@ -396,13 +468,13 @@ static CPLErr GDALGridInverseDistanceToAPowerNearestNeighborPerQuadrant(
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
     int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+    const int *panPoints =
+        GDALGridSearchPoints(psExtraParams, sAoi, &nFeatureCount);
     if (nFeatureCount != 0)
     {
         for (int k = 0; k < nFeatureCount; k++)
         {
-            const int i = papsPoints[k]->i;
+            const int i = panPoints[k];
             const double dfRX = padfX[i] - dfXPoint;
             const double dfRY = padfY[i] - dfYPoint;
 
@@ -412,7 +484,6 @@ static CPLErr GDALGridInverseDistanceToAPowerNearestNeighborPerQuadrant(
             if (dfRsmoothed2 < 0.0000000000001)
             {
                 *pdfValue = padfZ[i];
-                CPLFree(papsPoints);
                 return CE_None;
             }
             // is point within real distance?
@@ -425,7 +496,6 @@ static CPLErr GDALGridInverseDistanceToAPowerNearestNeighborPerQuadrant(
             }
         }
     }
-    CPLFree(papsPoints);
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -662,7 +732,7 @@ CPLErr GDALGridMovingAverage(const void *poOptionsIn, GUInt32 nPoints,
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
+    const GDALGridPointIndex *psPointIndex = psExtraParams->psPointIndex;
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -674,7 +744,7 @@ CPLErr GDALGridMovingAverage(const void *poOptionsIn, GUInt32 nPoints,
     double dfAccumulator = 0.0;
 
     GUInt32 n = 0;  // Used after for.
-    if (phQuadTree != nullptr)
+    if (psPointIndex != nullptr)
     {
         CPLRectObj sAoi;
         sAoi.minx = dfXPoint - dfSearchRadius;
@@ -682,13 +752,13 @@ CPLErr GDALGridMovingAverage(const void *poOptionsIn, GUInt32 nPoints,
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
         int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        const int *panPoints =
+            GDALGridSearchPoints(psExtraParams, sAoi, &nFeatureCount);
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
             {
-                const int i = papsPoints[k]->i;
+                const int i = panPoints[k];
                 const double dfRX = padfX[i] - dfXPoint;
                 const double dfRY = padfY[i] - dfYPoint;
 
@@ -701,7 +771,6 @@ CPLErr GDALGridMovingAverage(const void *poOptionsIn, GUInt32 nPoints,
                 }
             }
         }
-        CPLFree(papsPoints);
     }
     else
     {
@@ -765,8 +834,7 @@ static CPLErr GDALGridMovingAveragePerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->psPointIndex);
 
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
@@ -778,13 +846,13 @@ static CPLErr GDALGridMovingAveragePerQuadrant(
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
     int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+    const int *panPoints =
+        GDALGridSearchPoints(psExtraParams, sAoi, &nFeatureCount);
     if (nFeatureCount != 0)
     {
         for (int k = 0; k < nFeatureCount; k++)
         {
-            const int i = papsPoints[k]->i;
+            const int i = panPoints[k];
             const double dfRX = padfX[i] - dfXPoint;
             const double dfRY = padfY[i] - dfYPoint;
             const double dfRXSquare = dfRX * dfRX;
@@ -800,7 +868,6 @@ static CPLErr GDALGridMovingAveragePerQuadrant(
             }
         }
     }
-    CPLFree(papsPoints);
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -909,7 +976,7 @@ CPLErr GDALGridNearestNeighbor(const void *poOptionsIn, GUInt32 nPoints,
     const double dfR12Square = dfRadius1Square * dfRadius2Square;
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    CPLQuadTree *hQuadTree = psExtraParams->hQuadTree;
+    const GDALGridPointIndex *psPointIndex = psExtraParams->psPointIndex;
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -922,7 +989,7 @@ CPLErr GDALGridNearestNeighbor(const void *poOptionsIn, GUInt32 nPoints,
     GUInt32 i = 0;
 
     double dfSearchRadius = psExtraParams->dfInitialSearchRadius;
-    if (hQuadTree != nullptr)
+    if (psPointIndex != nullptr)
     {
         if (poOptions->dfRadius1 > 0 || poOptions->dfRadius2 > 0)
             dfSearchRadius =
@@ -935,32 +1002,46 @@ CPLErr GDALGridNearestNeighbor(const void *poOptionsIn, GUInt32 nPoints,
             sAoi.maxx = dfXPoint + dfSearchRadius;
             sAoi.maxy = dfYPoint + dfSearchRadius;
             int nFeatureCount = 0;
-            GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-                CPLQuadTreeSearch(hQuadTree, &sAoi, &nFeatureCount));
+            const int *panPoints =
+                GDALGridSearchPoints(psExtraParams, sAoi, &nFeatureCount);
             if (nFeatureCount != 0)
             {
                 // Nearest distance will be initialized with the distance to the
                 // first point in array.
                 double dfNearestRSquare = std::numeric_limits<double>::max();
+                int nNearestIdx = -1;
                 for (int k = 0; k < nFeatureCount; k++)
                 {
-                    const int idx = papsPoints[k]->i;
+                    const int idx = panPoints[k];
                     const double dfRX = padfX[idx] - dfXPoint;
                     const double dfRY = padfY[idx] - dfYPoint;
 
+                    // On ties, retain the point of highest index, as the
+                    // exhaustive search does.
                     const double dfR2 = dfRX * dfRX + dfRY * dfRY;
-                    if (dfR2 <= dfNearestRSquare)
+                    if (dfR2 < dfNearestRSquare ||
+                        (dfR2 == dfNearestRSquare && idx > nNearestIdx))
                     {
                         dfNearestRSquare = dfR2;
+                        nNearestIdx = idx;
                         dfNearestValue = padfZ[idx];
                     }
                 }
 
-                CPLFree(papsPoints);
-                break;
+                // When growing the search window, the nearest point of the
+                // square window might be beyond its inscribed circle, in which
+                // case a closer point may lie just outside of the window:
+                // search again with a window circumscribing that distance.
+                const double dfNearestR = sqrt(dfNearestRSquare);
+                if (poOptions->dfRadius1 > 0 || poOptions->dfRadius2 > 0 ||
+                    dfNearestR <= dfSearchRadius)
+                {
+                    break;
+                }
+                dfSearchRadius = dfNearestR;
+                continue;
             }
 
-            CPLFree(papsPoints);
             if (poOptions->dfRadius1 > 0 || poOptions->dfRadius2 > 0)
                 break;
             dfSearchRadius *= 2;
@@ -1067,7 +1148,7 @@ CPLErr GDALGridDataMetricMinimum(const void *poOptionsIn, GUInt32 nPoints,
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
+    const GDALGridPointIndex *psPointIndex = psExtraParams->psPointIndex;
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -1077,7 +1158,7 @@ CPLErr GDALGridDataMetricMinimum(const void *poOptionsIn, GUInt32 nPoints,
 
     double dfMinimumValue = std::numeric_limits<double>::max();
     GUInt32 n = 0;
-    if (phQuadTree != nullptr)
+    if (psPointIndex != nullptr)
     {
         CPLRectObj sAoi;
         sAoi.minx = dfXPoint - dfSearchRadius;
@@ -1085,13 +1166,13 @@ CPLErr GDALGridDataMetricMinimum(const void *poOptionsIn, GUInt32 nPoints,
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
         int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        const int *panPoints =
+            GDALGridSearchPoints(psExtraParams, sAoi, &nFeatureCount);
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
             {
-                const int i = papsPoints[k]->i;
+                const int i = panPoints[k];
                 const double dfRX = padfX[i] - dfXPoint;
                 const double dfRY = padfY[i] - dfYPoint;
 
@@ -1105,7 +1186,6 @@ CPLErr GDALGridDataMetricMinimum(const void *poOptionsIn, GUInt32 nPoints,
                 }
             }
         }
-        CPLFree(papsPoints);
     }
     else
     {
@@ -1179,8 +1259,7 @@ static CPLErr GDALGridDataMetricMinimumOrMaximumPerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->psPointIndex);
 
     CPLRectObj sAoi;
     sAoi.minx = dfXPoint - dfSearchRadius;
@@ -1188,15 +1267,15 @@ static CPLErr GDALGridDataMetricMinimumOrMaximumPerQuadrant(
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
     int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+    const int *panPoints =
+        GDALGridSearchPoints(psExtraParams, sAoi, &nFeatureCount);
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
     if (nFeatureCount != 0)
     {
         for (int k = 0; k < nFeatureCount; k++)
         {
-            const int i = papsPoints[k]->i;
+            const int i = panPoints[k];
             const double dfRX = padfX[i] - dfXPoint;
             const double dfRY = padfY[i] - dfYPoint;
             const double dfRXSquare = dfRX * dfRX;
@@ -1212,7 +1291,6 @@ static CPLErr GDALGridDataMetricMinimumOrMaximumPerQuadrant(
             }
         }
     }
-    CPLFree(papsPoints);
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -1361,7 +1439,7 @@ CPLErr GDALGridDataMetricMaximum(const void *poOptionsIn, GUInt32 nPoints,
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
+    const GDALGridPointIndex *psPointIndex = psExtraParams->psPointIndex;
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -1371,7 +1449,7 @@ CPLErr GDALGridDataMetricMaximum(const void *poOptionsIn, GUInt32 nPoints,
 
     double dfMaximumValue = -std::numeric_limits<double>::max();
     GUInt32 n = 0;
-    if (phQuadTree != nullptr)
+    if (psPointIndex != nullptr)
     {
         CPLRectObj sAoi;
         sAoi.minx = dfXPoint - dfSearchRadius;
@@ -1379,13 +1457,13 @@ CPLErr GDALGridDataMetricMaximum(const void *poOptionsIn, GUInt32 nPoints,
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
         int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        const int *panPoints =
+            GDALGridSearchPoints(psExtraParams, sAoi, &nFeatureCount);
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
             {
-                const int i = papsPoints[k]->i;
+                const int i = panPoints[k];
                 const double dfRX = padfX[i] - dfXPoint;
                 const double dfRY = padfY[i] - dfYPoint;
 
@@ -1399,7 +1477,6 @@ CPLErr GDALGridDataMetricMaximum(const void *poOptionsIn, GUInt32 nPoints,
                 }
             }
         }
-        CPLFree(papsPoints);
     }
     else
     {
@@ -1517,7 +1594,7 @@ CPLErr GDALGridDataMetricRange(const void *poOptionsIn, GUInt32 nPoints,
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
+    const GDALGridPointIndex *psPointIndex = psExtraParams->psPointIndex;
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -1528,7 +1605,7 @@ CPLErr GDALGridDataMetricRange(const void *poOptionsIn, GUInt32 nPoints,
     double dfMaximumValue = -std::numeric_limits<double>::max();
     double dfMinimumValue = std::numeric_limits<double>::max();
     GUInt32 n = 0;
-    if (phQuadTree != nullptr)
+    if (psPointIndex != nullptr)
     {
         CPLRectObj sAoi;
         sAoi.minx = dfXPoint - dfSearchRadius;
@@ -1536,13 +1613,13 @@ CPLErr GDALGridDataMetricRange(const void *poOptionsIn, GUInt32 nPoints,
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
         int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        const int *panPoints =
+            GDALGridSearchPoints(psExtraParams, sAoi, &nFeatureCount);
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
             {
-                const int i = papsPoints[k]->i;
+                const int i = panPoints[k];
                 const double dfRX = padfX[i] - dfXPoint;
                 const double dfRY = padfY[i] - dfYPoint;
 
@@ -1558,7 +1635,6 @@ CPLErr GDALGridDataMetricRange(const void *poOptionsIn, GUInt32 nPoints,
                 }
             }
         }
-        CPLFree(papsPoints);
     }
     else
     {
@@ -1632,8 +1708,7 @@ static CPLErr GDALGridDataMetricRangePerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->psPointIndex);
 
     CPLRectObj sAoi;
     sAoi.minx = dfXPoint - dfSearchRadius;
@@ -1641,15 +1716,15 @@ static CPLErr GDALGridDataMetricRangePerQuadrant(
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
     int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+    const int *panPoints =
+        GDALGridSearchPoints(psExtraParams, sAoi, &nFeatureCount);
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
     if (nFeatureCount != 0)
     {
         for (int k = 0; k < nFeatureCount; k++)
         {
-            const int i = papsPoints[k]->i;
+            const int i = panPoints[k];
             const double dfRX = padfX[i] - dfXPoint;
             const double dfRY = padfY[i] - dfYPoint;
             const double dfRXSquare = dfRX * dfRX;
@@ -1665,7 +1740,6 @@ static CPLErr GDALGridDataMetricRangePerQuadrant(
             }
         }
     }
-    CPLFree(papsPoints);
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -1789,7 +1863,7 @@ CPLErr GDALGridDataMetricCount(const void *poOptionsIn, GUInt32 nPoints,
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
+    const GDALGridPointIndex *psPointIndex = psExtraParams->psPointIndex;
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -1798,7 +1872,7 @@ CPLErr GDALGridDataMetricCount(const void *poOptionsIn, GUInt32 nPoints,
     const double dfCoeff2 = bRotated ? sin(dfAngle) : 0.0;
 
     GUInt32 n = 0;
-    if (phQuadTree != nullptr)
+    if (psPointIndex != nullptr)
     {
         CPLRectObj sAoi;
         sAoi.minx = dfXPoint - dfSearchRadius;
@@ -1806,13 +1880,13 @@ CPLErr GDALGridDataMetricCount(const void *poOptionsIn, GUInt32 nPoints,
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
         int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        const int *panPoints =
+            GDALGridSearchPoints(psExtraParams, sAoi, &nFeatureCount);
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
             {
-                const int i = papsPoints[k]->i;
+                const int i = panPoints[k];
                 const double dfRX = padfX[i] - dfXPoint;
                 const double dfRY = padfY[i] - dfYPoint;
 
@@ -1824,7 +1898,6 @@ CPLErr GDALGridDataMetricCount(const void *poOptionsIn, GUInt32 nPoints,
                 }
             }
         }
-        CPLFree(papsPoints);
     }
     else
     {
@@ -1894,8 +1967,7 @@ static CPLErr GDALGridDataMetricCountPerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->psPointIndex);
 
     CPLRectObj sAoi;
     sAoi.minx = dfXPoint - dfSearchRadius;
@@ -1903,15 +1975,15 @@ static CPLErr GDALGridDataMetricCountPerQuadrant(
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
     int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+    const int *panPoints =
+        GDALGridSearchPoints(psExtraParams, sAoi, &nFeatureCount);
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
     if (nFeatureCount != 0)
     {
         for (int k = 0; k < nFeatureCount; k++)
         {
-            const int i = papsPoints[k]->i;
+            const int i = panPoints[k];
             const double dfRX = padfX[i] - dfXPoint;
             const double dfRY = padfY[i] - dfYPoint;
             const double dfRXSquare = dfRX * dfRX;
@@ -1927,7 +1999,6 @@ static CPLErr GDALGridDataMetricCountPerQuadrant(
             }
         }
     }
-    CPLFree(papsPoints);
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -2049,7 +2120,7 @@ CPLErr GDALGridDataMetricAverageDistance(const void *poOptionsIn,
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
+    const GDALGridPointIndex *psPointIndex = psExtraParams->psPointIndex;
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -2059,7 +2130,7 @@ CPLErr GDALGridDataMetricAverageDistance(const void *poOptionsIn,
 
     double dfAccumulator = 0.0;
     GUInt32 n = 0;
-    if (phQuadTree != nullptr)
+    if (psPointIndex != nullptr)
     {
         CPLRectObj sAoi;
         sAoi.minx = dfXPoint - dfSearchRadius;
@@ -2067,13 +2138,13 @@ CPLErr GDALGridDataMetricAverageDistance(const void *poOptionsIn,
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
         int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        const int *panPoints =
+            GDALGridSearchPoints(psExtraParams, sAoi, &nFeatureCount);
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
             {
-                const int i = papsPoints[k]->i;
+                const int i = panPoints[k];
                 const double dfRX = padfX[i] - dfXPoint;
                 const double dfRY = padfY[i] - dfYPoint;
 
@@ -2086,7 +2157,6 @@ CPLErr GDALGridDataMetricAverageDistance(const void *poOptionsIn,
                 }
             }
         }
-        CPLFree(papsPoints);
     }
     else
     {
@@ -2158,8 +2228,7 @@ static CPLErr GDALGridDataMetricAverageDistancePerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->psPointIndex);
 
     CPLRectObj sAoi;
     sAoi.minx = dfXPoint - dfSearchRadius;
@@ -2167,15 +2236,15 @@ static CPLErr GDALGridDataMetricAverageDistancePerQuadrant(
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
     int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+    const int *panPoints =
+        GDALGridSearchPoints(psExtraParams, sAoi, &nFeatureCount);
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
     if (nFeatureCount != 0)
     {
         for (int k = 0; k < nFeatureCount; k++)
         {
-            const int i = papsPoints[k]->i;
+            const int i = panPoints[k];
             const double dfRX = padfX[i] - dfXPoint;
             const double dfRY = padfY[i] - dfYPoint;
             const double dfRXSquare = dfRX * dfRX;
@@ -2191,7 +2260,6 @@ static CPLErr GDALGridDataMetricAverageDistancePerQuadrant(
             }
         }
     }
-    CPLFree(papsPoints);
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -2315,7 +2383,7 @@ CPLErr GDALGridDataMetricAverageDistancePts(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
+    const GDALGridPointIndex *psPointIndex = psExtraParams->psPointIndex;
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -2325,7 +2393,7 @@ CPLErr GDALGridDataMetricAverageDistancePts(
 
     double dfAccumulator = 0.0;
     GUInt32 n = 0;
-    if (phQuadTree != nullptr)
+    if (psPointIndex != nullptr)
     {
         CPLRectObj sAoi;
         sAoi.minx = dfXPoint - dfSearchRadius;
@@ -2333,13 +2401,13 @@ CPLErr GDALGridDataMetricAverageDistancePts(
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
         int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        const int *panPoints =
+            GDALGridSearchPoints(psExtraParams, sAoi, &nFeatureCount);
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount - 1; k++)
             {
-                const int i = papsPoints[k]->i;
+                const int i = panPoints[k];
                 const double dfRX1 = padfX[i] - dfXPoint;
                 const double dfRY1 = padfY[i] - dfYPoint;
 
@@ -2347,11 +2415,11 @@ CPLErr GDALGridDataMetricAverageDistancePts(
                         dfRadius1Square * dfRY1 * dfRY1 <=
                     dfR12Square)
                 {
-                    for (int j = k; j < nFeatureCount; j++)
+                    for (int j = k + 1; j < nFeatureCount; j++)
                     // Search all the remaining points within the ellipse and
                     // compute distances between them and the first point.
                     {
-                        const int ji = papsPoints[j]->i;
+                        const int ji = panPoints[j];
                         double dfRX2 = padfX[ji] - dfXPoint;
                         double dfRY2 = padfY[ji] - dfYPoint;
 
@@ -2369,7 +2437,6 @@ CPLErr GDALGridDataMetricAverageDistancePts(
                 }
             }
         }
-        CPLFree(papsPoints);
     }
     else
     {
@@ -2653,8 +2720,10 @@ static void GDALGridJobProcess(void *user_data)
     const void *poOptions = psJob->poOptions;
     GDALGridFunction pfnGDALGridMethod = psJob->pfnGDALGridMethod;
     // Have a local copy of sExtraParameters since we want to modify
-    // nInitialFacetIdx.
+    // nInitialFacetIdx, and have a search buffer of our own.
     GDALGridExtraParameters sExtraParameters = *psJob->psExtraParameters;
+    sExtraParameters.panSearchResults = nullptr;
+    sExtraParameters.nSearchResultsCapacity = 0;
     const GDALDataType eType = psJob->eType;
 
     const int nDataTypeSize = GDALGetDataTypeSizeBytes(eType);
@@ -2691,6 +2760,7 @@ static void GDALGridJobProcess(void *user_data)
             break;
     }
 
+    CPLFree(sExtraParameters.panSearchResults);
     CPLFree(padfValues);
 }
 
@@ -2705,8 +2775,6 @@ struct GDALGridContext
     GDALGridFunction pfnGDALGridMethod;
 
     GUInt32 nPoints;
-    GDALGridPoint *pasGridPoints;
-    GDALGridXYArrays sXYArrays;
 
     GDALGridExtraParameters sExtraParameters;
     double *padfX;
@@ -2717,7 +2785,7 @@ struct GDALGridContext
     CPLWorkerThreadPool *poWorkerThreadPool;
 };
 
-static void GDALGridContextCreateQuadTree(GDALGridContext *psContext);
+static void GDALGridContextCreatePointIndex(GDALGridContext *psContext);
 
 /**
  * Creates a context to do regular gridding from the scattered data.
@@ -2770,7 +2838,7 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
     CPLAssert(padfX);
     CPLAssert(padfY);
     CPLAssert(padfZ);
-    bool bCreateQuadTree = false;
+    bool bCreatePointIndex = false;
 
     const unsigned int nPointCountThreshold =
         atoi(CPLGetConfigOption("GDAL_GRID_POINT_COUNT_THRESHOLD", "100"));
@@ -2931,7 +2999,7 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
                 pfnGDALGridMethod =
                     GDALGridInverseDistanceToAPowerNearestNeighbor;
             }
-            bCreateQuadTree = true;
+            bCreatePointIndex = true;
             break;
         }
         case GGA_MovingAverage:
@@ -2952,12 +3020,12 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
                 poOptionsOld->nMaxPointsPerQuadrant != 0)
             {
                 pfnGDALGridMethod = GDALGridMovingAveragePerQuadrant;
-                bCreateQuadTree = true;
+                bCreatePointIndex = true;
             }
             else
             {
                 pfnGDALGridMethod = GDALGridMovingAverage;
-                bCreateQuadTree = (nPoints > nPointCountThreshold &&
+                bCreatePointIndex = (nPoints > nPointCountThreshold &&
                                    poOptionsOld->dfAngle == 0.0 &&
                                    (poOptionsOld->dfRadius1 > 0.0 ||
                                     poOptionsOld->dfRadius2 > 0.0));
@@ -2979,7 +3047,7 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
                    sizeof(GDALGridNearestNeighborOptions));
 
             pfnGDALGridMethod = GDALGridNearestNeighbor;
-            bCreateQuadTree = (nPoints > nPointCountThreshold &&
+            bCreatePointIndex = (nPoints > nPointCountThreshold &&
                                poOptionsOld->dfAngle == 0.0 &&
                                (poOptionsOld->dfRadius1 > 0.0 ||
                                 poOptionsOld->dfRadius2 > 0.0));
@@ -3002,12 +3070,12 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
                 poOptionsOld->nMaxPointsPerQuadrant != 0)
             {
                 pfnGDALGridMethod = GDALGridDataMetricMinimumPerQuadrant;
-                bCreateQuadTree = true;
+                bCreatePointIndex = true;
             }
             else
             {
                 pfnGDALGridMethod = GDALGridDataMetricMinimum;
-                bCreateQuadTree = (nPoints > nPointCountThreshold &&
+                bCreatePointIndex = (nPoints > nPointCountThreshold &&
                                    poOptionsOld->dfAngle == 0.0 &&
                                    (poOptionsOld->dfRadius1 > 0.0 ||
                                     poOptionsOld->dfRadius2 > 0.0));
@@ -3031,12 +3099,12 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
                 poOptionsOld->nMaxPointsPerQuadrant != 0)
             {
                 pfnGDALGridMethod = GDALGridDataMetricMaximumPerQuadrant;
-                bCreateQuadTree = true;
+                bCreatePointIndex = true;
             }
             else
             {
                 pfnGDALGridMethod = GDALGridDataMetricMaximum;
-                bCreateQuadTree = (nPoints > nPointCountThreshold &&
+                bCreatePointIndex = (nPoints > nPointCountThreshold &&
                                    poOptionsOld->dfAngle == 0.0 &&
                                    (poOptionsOld->dfRadius1 > 0.0 ||
                                     poOptionsOld->dfRadius2 > 0.0));
@@ -3061,12 +3129,12 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
                 poOptionsOld->nMaxPointsPerQuadrant != 0)
             {
                 pfnGDALGridMethod = GDALGridDataMetricRangePerQuadrant;
-                bCreateQuadTree = true;
+                bCreatePointIndex = true;
             }
             else
             {
                 pfnGDALGridMethod = GDALGridDataMetricRange;
-                bCreateQuadTree = (nPoints > nPointCountThreshold &&
+                bCreatePointIndex = (nPoints > nPointCountThreshold &&
                                    poOptionsOld->dfAngle == 0.0 &&
                                    (poOptionsOld->dfRadius1 > 0.0 ||
                                     poOptionsOld->dfRadius2 > 0.0));
@@ -3091,12 +3159,12 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
                 poOptionsOld->nMaxPointsPerQuadrant != 0)
             {
                 pfnGDALGridMethod = GDALGridDataMetricCountPerQuadrant;
-                bCreateQuadTree = true;
+                bCreatePointIndex = true;
             }
             else
             {
                 pfnGDALGridMethod = GDALGridDataMetricCount;
-                bCreateQuadTree = (nPoints > nPointCountThreshold &&
+                bCreatePointIndex = (nPoints > nPointCountThreshold &&
                                    poOptionsOld->dfAngle == 0.0 &&
                                    (poOptionsOld->dfRadius1 > 0.0 ||
                                     poOptionsOld->dfRadius2 > 0.0));
@@ -3122,12 +3190,12 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
             {
                 pfnGDALGridMethod =
                     GDALGridDataMetricAverageDistancePerQuadrant;
-                bCreateQuadTree = true;
+                bCreatePointIndex = true;
             }
             else
             {
                 pfnGDALGridMethod = GDALGridDataMetricAverageDistance;
-                bCreateQuadTree = (nPoints > nPointCountThreshold &&
+                bCreatePointIndex = (nPoints > nPointCountThreshold &&
                                    poOptionsOld->dfAngle == 0.0 &&
                                    (poOptionsOld->dfRadius1 > 0.0 ||
                                     poOptionsOld->dfRadius2 > 0.0));
@@ -3149,7 +3217,7 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
             memcpy(poOptionsNew, poOptions, sizeof(GDALGridDataMetricsOptions));
 
             pfnGDALGridMethod = GDALGridDataMetricAverageDistancePts;
-            bCreateQuadTree = (nPoints > nPointCountThreshold &&
+            bCreatePointIndex = (nPoints > nPointCountThreshold &&
                                poOptionsOld->dfAngle == 0.0 &&
                                (poOptionsOld->dfRadius1 > 0.0 ||
                                 poOptionsOld->dfRadius2 > 0.0));
@@ -3207,10 +3275,9 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
     psContext->poOptions = poOptionsNew;
     psContext->pfnGDALGridMethod = pfnGDALGridMethod;
     psContext->nPoints = nPoints;
-    psContext->pasGridPoints = nullptr;
-    psContext->sXYArrays.padfX = padfX;
-    psContext->sXYArrays.padfY = padfY;
-    psContext->sExtraParameters.hQuadTree = nullptr;
+    psContext->sExtraParameters.psPointIndex = nullptr;
+    psContext->sExtraParameters.panSearchResults = nullptr;
+    psContext->sExtraParameters.nSearchResultsCapacity = 0;
     psContext->sExtraParameters.dfInitialSearchRadius = 0.0;
     psContext->sExtraParameters.pafX = pafXAligned;
     psContext->sExtraParameters.pafY = pafYAligned;
@@ -3224,12 +3291,12 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
         pafXAligned ? false : !bCallerWillKeepPointArraysAlive;
 
     /* -------------------------------------------------------------------- */
-    /*  Create quadtree if requested and possible.                          */
+    /*  Create point index if requested and possible.                       */
     /* -------------------------------------------------------------------- */
-    if (bCreateQuadTree)
+    if (bCreatePointIndex)
     {
-        GDALGridContextCreateQuadTree(psContext);
-        if (psContext->sExtraParameters.hQuadTree == nullptr &&
+        GDALGridContextCreatePointIndex(psContext);
+        if (psContext->sExtraParameters.psPointIndex == nullptr &&
             (eAlgorithm == GGA_InverseDistanceToAPowerNearestNeighbor ||
              pfnGDALGridMethod == GDALGridMovingAveragePerQuadrant))
         {
@@ -3303,53 +3370,102 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
 }
 
 /************************************************************************/
-/*                      GDALGridContextCreateQuadTree()                 */
+/*                      GDALGridContextCreatePointIndex()                 */
 /************************************************************************/
 
-void GDALGridContextCreateQuadTree(GDALGridContext *psContext)
+void GDALGridContextCreatePointIndex(GDALGridContext *psContext)
 {
     const GUInt32 nPoints = psContext->nPoints;
-    psContext->pasGridPoints = static_cast<GDALGridPoint *>(
-        VSI_MALLOC2_VERBOSE(nPoints, sizeof(GDALGridPoint)));
-    if (psContext->pasGridPoints != nullptr)
+    const double *const padfX = psContext->padfX;
+    const double *const padfY = psContext->padfY;
+
+    // Determine point extents.
+    double dfMinX = padfX[0];
+    double dfMinY = padfY[0];
+    double dfMaxX = padfX[0];
+    double dfMaxY = padfY[0];
+    for (GUInt32 i = 1; i < nPoints; i++)
     {
-        const double *const padfX = psContext->padfX;
-        const double *const padfY = psContext->padfY;
-
-        // Determine point extents.
-        CPLRectObj sRect;
-        sRect.minx = padfX[0];
-        sRect.miny = padfY[0];
-        sRect.maxx = padfX[0];
-        sRect.maxy = padfY[0];
-        for (GUInt32 i = 1; i < nPoints; i++)
-        {
-            if (padfX[i] < sRect.minx)
-                sRect.minx = padfX[i];
-            if (padfY[i] < sRect.miny)
-                sRect.miny = padfY[i];
-            if (padfX[i] > sRect.maxx)
-                sRect.maxx = padfX[i];
-            if (padfY[i] > sRect.maxy)
-                sRect.maxy = padfY[i];
-        }
-
-        // Initial value for search radius is the typical dimension of a
-        // "pixel" of the point array (assuming rather uniform distribution).
-        psContext->sExtraParameters.dfInitialSearchRadius = sqrt(
-            (sRect.maxx - sRect.minx) * (sRect.maxy - sRect.miny) / nPoints);
+        dfMinX = std::min(dfMinX, padfX[i]);
+        dfMinY = std::min(dfMinY, padfY[i]);
+        dfMaxX = std::max(dfMaxX, padfX[i]);
+        dfMaxY = std::max(dfMaxY, padfY[i]);
+    }
 
-        psContext->sExtraParameters.hQuadTree =
-            CPLQuadTreeCreate(&sRect, GDALGridGetPointBounds);
+    // Initial value for search radius is the typical dimension of a
+    // "pixel" of the point array (assuming rather uniform distribution).
+    psContext->sExtraParameters.dfInitialSearchRadius =
+        sqrt((dfMaxX - dfMinX) * (dfMaxY - dfMinY) / nPoints);
+
+    // Aim at a couple points per cell, without more cells than points,
+    // including for degenerate (aligned or coincident) point sets.
+    const double dfWidth = dfMaxX - dfMinX;
+    const double dfHeight = dfMaxY - dfMinY;
+    double dfCellSize =
+        std::sqrt(2.0) * psContext->sExtraParameters.dfInitialSearchRadius;
+    if (!(dfCellSize > 0))
+        dfCellSize = std::max(dfWidth, dfHeight) / std::max(1U, nPoints / 2);
+    if (!(dfCellSize > 0))
+        dfCellSize = 1;
+    double dfCellsX = std::floor(dfWidth / dfCellSize) + 1;
+    double dfCellsY = std::floor(dfHeight / dfCellSize) + 1;
+    while (dfCellsX * dfCellsY > std::max(1U, nPoints))
+    {
+        dfCellSize *= 2;
+        dfCellsX = std::floor(dfWidth / dfCellSize) + 1;
+        dfCellsY = std::floor(dfHeight / dfCellSize) + 1;
+    }
 
+    GDALGridPointIndex *psIndex = nullptr;
+    try
+    {
+        psIndex = new GDALGridPointIndex();
+        psIndex->padfX = padfX;
+        psIndex->padfY = padfY;
+        psIndex->dfMinX = dfMinX;
+        psIndex->dfMinY = dfMinY;
+        psIndex->dfInvCellSize = 1.0 / dfCellSize;
+        psIndex->nCellsX = static_cast<int>(dfCellsX);
+        psIndex->nCellsY = static_cast<int>(dfCellsY);
+        const size_t nCells =
+            static_cast<size_t>(psIndex->nCellsX) * psIndex->nCellsY;
+        psIndex->anCellStart.resize(nCells + 1);
+        psIndex->anPointIdx.resize(nPoints);
+
+        const auto GetCell = [psIndex, padfX, padfY](GUInt32 i)
+        {
+            const int nCX = std::min(
+                static_cast<int>((padfX[i] - psIndex->dfMinX) *
+                                 psIndex->dfInvCellSize),
+                psIndex->nCellsX - 1);
+            const int nCY = std::min(
+                static_cast<int>((padfY[i] - psIndex->dfMinY) *
+                                 psIndex->dfInvCellSize),
+                psIndex->nCellsY - 1);
+            return static_cast<size_t>(nCY) * psIndex->nCellsX + nCX;
+        };
+
+        // Counting sort of the points by cell.
+        GUInt32 *panCellStart = psIndex->anCellStart.data();
+        for (GUInt32 i = 0; i < nPoints; i++)
+            ++panCellStart[GetCell(i) + 1];
+        for (size_t iCell = 0; iCell < nCells; iCell++)
+            panCellStart[iCell + 1] += panCellStart[iCell];
+        std::vector<GUInt32> anCellFill(panCellStart, panCellStart + nCells);
         for (GUInt32 i = 0; i < nPoints; i++)
         {
-            psContext->pasGridPoints[i].psXYArrays = &(psContext->sXYArrays);
-            psContext->pasGridPoints[i].i = i;
-            CPLQuadTreeInsert(psContext->sExtraParameters.hQuadTree,
-                              psContext->pasGridPoints + i);
+            psIndex->anPointIdx[anCellFill[GetCell(i)]++] =
+                static_cast<int>(i);
         }
     }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate point index: %s", e.what());
+        delete psIndex;
+        return;
+    }
+    psContext->sExtraParameters.psPointIndex = psIndex;
 }
 
 /************************************************************************/
@@ -3368,9 +3484,8 @@ void GDALGridContextFree(GDALGridContext *psContext)
     if (psContext)
     {
         CPLFree(psContext->poOptions);
-        CPLFree(psContext->pasGridPoints);
-        if (psContext->sExtraParameters.hQuadTree != nullptr)
-            CPLQuadTreeDestroy(psContext->sExtraParameters.hQuadTree);
+        delete psContext->sExtraParameters.psPointIndex;
+        CPLFree(psContext->sExtraParameters.panSearchResults);
         if (psContext->bFreePadfXYZArrays)
         {
             CPLFree(psContext->padfX);
@@ -3440,7 +3555,7 @@ CPLErr GDALGridContextProcess(GDALGridContext *psContext, double dfXMin,
     // by sampling along the edges.  If all points on edges are within
     // triangles, then interior points will also be.
     if (psContext->eAlgorithm == GGA_Linear &&
-        psContext->sExtraParameters.hQuadTree == nullptr)
+        psContext->sExtraParameters.psPointIndex == nullptr)
     {
         bool bNeedNearest = false;
         int nStartLeft = 0;
@@ -3489,7 +3604,7 @@ CPLErr GDALGridContextProcess(GDALGridContext *psContext, double dfXMin,
         if (bNeedNearest)
         {
             CPLDebug("GDAL_GRID", "Will need nearest neighbour");
-            GDALGridContextCreateQuadTree(psContext);
+            GDALGridContextCreatePointIndex(psContext);
         }
     }
 
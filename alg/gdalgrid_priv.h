@@ -31,27 +31,21 @@
 #define GDALGRID_PRIV_H
 
 #include "cpl_error.h"
-#include "cpl_quad_tree.h"
 
 #include "gdal_alg.h"
 
 //! @cond Doxygen_Suppress
 
-typedef struct
-{
-    const double *padfX;
-    const double *padfY;
-} GDALGridXYArrays;
-
-typedef struct
-{
-    GDALGridXYArrays *psXYArrays;
-    int i;
-} GDALGridPoint;
+/*! Spatial index of the points, bucketing them into a regular grid of cells.
+ */
+struct GDALGridPointIndex;
 
 typedef struct
 {
-    CPLQuadTree *hQuadTree;
+    GDALGridPointIndex *psPointIndex;
+    /*! Per-job buffer receiving the indices of points returned by a search. */
+    int *panSearchResults;
+    size_t nSearchResultsCapacity;
     double dfInitialSearchRadius;
     float *pafX;  // Aligned to be usable with AVX
     float *pafY;
@@ -39,6 +39,7 @@
 #include <cstring>
 #include <limits>
 #include <new>
+#include <type_traits>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -670,13 +671,14 @@ void GDALPansharpenOperation::WeightedBrovey3(
 
 #include "gdalsse_priv.h"
 
-template <class T, int NINPUT, int NOUTPUT>
+template <class T, int NINPUT, int NOUTPUT, bool bHasNoData>
 size_t GDALPansharpenOperation::WeightedBroveyPositiveWeightsInternal(
     const T *pPanBuffer, const T *pUpsampledSpectralBuffer, T *pDataBuf,
     size_t nValues, size_t nBandValues, T nMaxValue) const
 {
     static_assert(NINPUT == 3 || NINPUT == 4);
     static_assert(NOUTPUT == 3 || NOUTPUT == 4);
+    static_assert(!bHasNoData || std::numeric_limits<T>::is_integer);
     const XMMReg4Double w0 =
         XMMReg4Double::Load1ValHighAndLow(psOptions->padfWeights + 0);
     const XMMReg4Double w1 =
@@ -693,6 +695,33 @@ size_t GDALPansharpenOperation::WeightedBroveyPositiveWeightsInternal(
     const XMMReg4Double maxValue =
         XMMReg4Double::Load1ValHighAndLow(&dfMaxValue);
 
+    // Same logic as WeightedBroveyWithNoData(): pixels where the pan or
+    // input spectral values are nodata, or whose pseudo panchromatic value
+    // is zero, are set to nodata, and valid values that would be rounded to
+    // nodata are set to validValue.
+    [[maybe_unused]] XMMReg4Double noData;
+    [[maybe_unused]] XMMReg4Double noDataPlusOne;
+    [[maybe_unused]] XMMReg4Double validValue;
+    [[maybe_unused]] XMMReg4Double half;
+    if constexpr (bHasNoData)
+    {
+        T tNoData;
+        GDALCopyWord(psOptions->dfNoData, tNoData);
+        const T tValidValue = tNoData == std::numeric_limits<T>::min()
+                                  ? std::numeric_limits<T>::min() + 1
+                                  : static_cast<T>(tNoData - 1);
+        double dfNoData = tNoData;
+        double dfNoDataPlusOne = dfNoData + 1;
+        double dfValidValue = tValidValue;
+        double dfHalf = 0.5;
+        noData = XMMReg4Double::Load1ValHighAndLow(&dfNoData);
+        noDataPlusOne = XMMReg4Double::Load1ValHighAndLow(&dfNoDataPlusOne);
+        validValue = XMMReg4Double::Load1ValHighAndLow(&dfValidValue);
+        half = XMMReg4Double::Load1ValHighAndLow(&dfHalf);
+    }
+    const auto Or = [](const XMMReg4Double &a, const XMMReg4Double &b)
+    { return XMMReg4Double::Ternary(a, a, b); };
+
     size_t j = 0;  // Used after for.
     for (; j + 3 < nValues; j += 4)
     {
@@ -717,18 +746,56 @@ size_t GDALPansharpenOperation::WeightedBroveyPositiveWeightsInternal(
         if constexpr (NINPUT == 4)
             pseudoPanchro += w3 * val3;
 
+        const XMMReg4Double pan = XMMReg4Double::Load4Val(pPanBuffer + j);
+
+        [[maybe_unused]] XMMReg4Double isNoData;
+        if constexpr (bHasNoData)
+        {
+            isNoData = Or(XMMReg4Double::Equals(pan, noData),
+                          XMMReg4Double::Equals(pseudoPanchro, zero));
+            isNoData = Or(isNoData, XMMReg4Double::Equals(val0, noData));
+            isNoData = Or(isNoData, XMMReg4Double::Equals(val1, noData));
+            isNoData = Or(isNoData, XMMReg4Double::Equals(val2, noData));
+            if constexpr (NINPUT == 4)
+                isNoData = Or(isNoData, XMMReg4Double::Equals(val3, noData));
+        }
+
         /* Little trick to avoid use of ternary operator due to one of the
          * branch being zero */
         XMMReg4Double factor = XMMReg4Double::And(
-            XMMReg4Double::NotEquals(pseudoPanchro, zero),
-            XMMReg4Double::Load4Val(pPanBuffer + j) / pseudoPanchro);
+            XMMReg4Double::NotEquals(pseudoPanchro, zero), pan / pseudoPanchro);
 
-        val0 = XMMReg4Double::Min(val0 * factor, maxValue);
-        val1 = XMMReg4Double::Min(val1 * factor, maxValue);
-        val2 = XMMReg4Double::Min(val2 * factor, maxValue);
+        const auto Pansharpen = [&](const XMMReg4Double &val)
+        {
+            if constexpr (!std::numeric_limits<T>::is_integer)
+            {
+                return val * factor;
+            }
+            else if constexpr (!bHasNoData)
+            {
+                return XMMReg4Double::Min(val * factor, maxValue);
+            }
+            else
+            {
+                const XMMReg4Double res =
+                    XMMReg4Double::Min(val * factor, maxValue);
+                // Store4Val() rounds to the integer part of res + 0.5
+                const XMMReg4Double rounded = res + half;
+                const XMMReg4Double isRoundedToNoData = XMMReg4Double::Ternary(
+                    XMMReg4Double::Greater(noData, rounded), zero,
+                    XMMReg4Double::Greater(noDataPlusOne, rounded));
+                return XMMReg4Double::Ternary(
+                    isNoData, noData,
+                    XMMReg4Double::Ternary(isRoundedToNoData, validValue, res));
+            }
+        };
+
+        val0 = Pansharpen(val0);
+        val1 = Pansharpen(val1);
+        val2 = Pansharpen(val2);
         if constexpr (NOUTPUT == 4)
         {
-            val3 = XMMReg4Double::Min(val3 * factor, maxValue);
+            val3 = Pansharpen(val3);
         }
         val0.Store4Val(pDataBuf + 0 * nBandValues + j);
         val1.Store4Val(pDataBuf + 1 * nBandValues + j);
@@ -743,12 +810,15 @@ size_t GDALPansharpenOperation::WeightedBroveyPositiveWeightsInternal(
 
 #else
 
-template <class T, int NINPUT, int NOUTPUT>
+template <class T, int NINPUT, int NOUTPUT, bool bHasNoData>
 size_t GDALPansharpenOperation::WeightedBroveyPositiveWeightsInternal(
     const T *pPanBuffer, const T *pUpsampledSpectralBuffer, T *pDataBuf,
     size_t nValues, size_t nBandValues, T nMaxValue) const
 {
     static_assert(NINPUT == 3 || NINPUT == 4);
+    // Let the generic code handle those cases.
+    if constexpr (bHasNoData || !std::numeric_limits<T>::is_integer)
+        return 0;
     const double dfw0 = psOptions->padfWeights[0];
     const double dfw1 = psOptions->padfWeights[1];
     const double dfw2 = psOptions->padfWeights[2];
@@ -801,29 +871,18 @@ size_t GDALPansharpenOperation::WeightedBroveyPositiveWeightsInternal(
 }
 #endif
 
-template <class T>
-void GDALPansharpenOperation::WeightedBroveyPositiveWeights(
+template <class T, bool bHasNoData>
+size_t GDALPansharpenOperation::WeightedBroveyPositiveWeightsSIMD(
     const T *pPanBuffer, const T *pUpsampledSpectralBuffer, T *pDataBuf,
     size_t nValues, size_t nBandValues, T nMaxValue) const
 {
-    if (psOptions->bHasNoData)
-    {
-        WeightedBroveyWithNoData<T, T>(pPanBuffer, pUpsampledSpectralBuffer,
-                                       pDataBuf, nValues, nBandValues,
-                                       nMaxValue);
-        return;
-    }
-
-    if (nMaxValue == 0)
-        nMaxValue = std::numeric_limits<T>::max();
-    size_t j;
     if (psOptions->nInputSpectralBands == 3 &&
         psOptions->nOutPansharpenedBands == 3 &&
         psOptions->panOutPansharpenedBands[0] == 0 &&
         psOptions->panOutPansharpenedBands[1] == 1 &&
         psOptions->panOutPansharpenedBands[2] == 2)
     {
-        j = WeightedBroveyPositiveWeightsInternal<T, 3, 3>(
+        return WeightedBroveyPositiveWeightsInternal<T, 3, 3, bHasNoData>(
             pPanBuffer, pUpsampledSpectralBuffer, pDataBuf, nValues,
             nBandValues, nMaxValue);
     }
@@ -834,7 +893,7 @@ void GDALPansharpenOperation::WeightedBroveyPositiveWeights(
              psOptions->panOutPansharpenedBands[2] == 2 &&
              psOptions->panOutPansharpenedBands[3] == 3)
     {
-        j = WeightedBroveyPositiveWeightsInternal<T, 4, 4>(
+        return WeightedBroveyPositiveWeightsInternal<T, 4, 4, bHasNoData>(
             pPanBuffer, pUpsampledSpectralBuffer, pDataBuf, nValues,
             nBandValues, nMaxValue);
     }
@@ -844,45 +903,66 @@ void GDALPansharpenOperation::WeightedBroveyPositiveWeights(
              psOptions->panOutPansharpenedBands[1] == 1 &&
              psOptions->panOutPansharpenedBands[2] == 2)
     {
-        j = WeightedBroveyPositiveWeightsInternal<T, 4, 3>(
+        return WeightedBroveyPositiveWeightsInternal<T, 4, 3, bHasNoData>(
             pPanBuffer, pUpsampledSpectralBuffer, pDataBuf, nValues,
             nBandValues, nMaxValue);
     }
-    else
+    return 0;
+}
+
+template <class T>
+void GDALPansharpenOperation::WeightedBroveyPositiveWeights(
+    const T *pPanBuffer, const T *pUpsampledSpectralBuffer, T *pDataBuf,
+    size_t nValues, size_t nBandValues, T nMaxValue) const
+{
+    if (nMaxValue == 0)
+        nMaxValue = std::numeric_limits<T>::max();
+
+    if (psOptions->bHasNoData)
+    {
+        const size_t j = WeightedBroveyPositiveWeightsSIMD<T, true>(
+            pPanBuffer, pUpsampledSpectralBuffer, pDataBuf, nValues,
+            nBandValues, nMaxValue);
+        WeightedBroveyWithNoData<T, T>(pPanBuffer + j,
+                                       pUpsampledSpectralBuffer + j,
+                                       pDataBuf + j, nValues - j, nBandValues,
+                                       nMaxValue);
+        return;
+    }
+
+    size_t j = WeightedBroveyPositiveWeightsSIMD<T, false>(
+        pPanBuffer, pUpsampledSpectralBuffer, pDataBuf, nValues, nBandValues,
+        nMaxValue);
+    for (; j + 1 < nValues; j += 2)
     {
-        for (j = 0; j + 1 < nValues; j += 2)
+        double dfFactor = 0.0;
+        double dfFactor2 = 0.0;
+        double dfPseudoPanchro = 0.0;
+        double dfPseudoPanchro2 = 0.0;
+        for (int i = 0; i < psOptions->nInputSpectralBands; i++)
         {
-            double dfFactor = 0.0;
-            double dfFactor2 = 0.0;
-            double dfPseudoPanchro = 0.0;
-            double dfPseudoPanchro2 = 0.0;
-            for (int i = 0; i < psOptions->nInputSpectralBands; i++)
-            {
-                dfPseudoPanchro +=
-                    psOptions->padfWeights[i] *
-                    pUpsampledSpectralBuffer[i * nBandValues + j];
-                dfPseudoPanchro2 +=
-                    psOptions->padfWeights[i] *
-                    pUpsampledSpectralBuffer[i * nBandValues + j + 1];
-            }
+            dfPseudoPanchro += psOptions->padfWeights[i] *
+                               pUpsampledSpectralBuffer[i * nBandValues + j];
+            dfPseudoPanchro2 +=
+                psOptions->padfWeights[i] *
+                pUpsampledSpectralBuffer[i * nBandValues + j + 1];
+        }
 
-            dfFactor = ComputeFactor(pPanBuffer[j], dfPseudoPanchro);
-            dfFactor2 = ComputeFactor(pPanBuffer[j + 1], dfPseudoPanchro2);
+        dfFactor = ComputeFactor(pPanBuffer[j], dfPseudoPanchro);
+        dfFactor2 = ComputeFactor(pPanBuffer[j + 1], dfPseudoPanchro2);
 
-            for (int i = 0; i < psOptions->nOutPansharpenedBands; i++)
-            {
-                const T nRawValue = pUpsampledSpectralBuffer
-                    [psOptions->panOutPansharpenedBands[i] * nBandValues + j];
-                const double dfTmp = nRawValue * dfFactor;
-                pDataBuf[i * nBandValues + j] = ClampAndRound(dfTmp, nMaxValue);
-
-                const T nRawValue2 = pUpsampledSpectralBuffer
-                    [psOptions->panOutPansharpenedBands[i] * nBandValues + j +
-                     1];
-                const double dfTmp2 = nRawValue2 * dfFactor2;
-                pDataBuf[i * nBandValues + j + 1] =
-                    ClampAndRound(dfTmp2, nMaxValue);
-            }
+        for (int i = 0; i < psOptions->nOutPansharpenedBands; i++)
+        {
+            const T nRawValue = pUpsampledSpectralBuffer
+                [psOptions->panOutPansharpenedBands[i] * nBandValues + j];
+            const double dfTmp = nRawValue * dfFactor;
+            pDataBuf[i * nBandValues + j] = ClampAndRound(dfTmp, nMaxValue);
+
+            const T nRawValue2 = pUpsampledSpectralBuffer
+                [psOptions->panOutPansharpenedBands[i] * nBandValues + j + 1];
+            const double dfTmp2 = nRawValue2 * dfFactor2;
+            pDataBuf[i * nBandValues + j + 1] =
+                ClampAndRound(dfTmp2, nMaxValue);
         }
     }
     for (; j < nValues; j++)
@@ -1106,10 +1186,24 @@ CPLErr GDALPansharpenOperation::WeightedBrovey(
             break;
 
         case GDT_Float32:
+        {
+            size_t j = 0;
+            if constexpr (std::is_same<WorkDataType, float>::value)
+            {
+                if (bPositiveWeights && !psOptions->bHasNoData)
+                {
+                    j = WeightedBroveyPositiveWeightsSIMD<float, false>(
+                        pPanBuffer, pUpsampledSpectralBuffer,
+                        static_cast<float *>(pDataBuf), nValues, nBandValues,
+                        0);
+                }
+            }
             WeightedBrovey3<WorkDataType, float, FALSE>(
-                pPanBuffer, pUpsampledSpectralBuffer,
-                static_cast<float *>(pDataBuf), nValues, nBandValues, 0);
+                pPanBuffer + j, pUpsampledSpectralBuffer + j,
+                static_cast<float *>(pDataBuf) + j, nValues - j, nBandValues,
+                0);
             break;
+        }
 #endif
 
         case GDT_Float64:
@@ -239,7 +239,14 @@ class GDALPansharpenOperation
                                        T *pDataBuf, size_t nValues,
                                        size_t nBandValues, T nMaxValue) const;
 
-    template <class T, int NINPUT, int NOUTPUT>
+    template <class T, bool bHasNoData>
+    size_t WeightedBroveyPositiveWeightsSIMD(const T *pPanBuffer,
+                                             const T *pUpsampledSpectralBuffer,
+                                             T *pDataBuf, size_t nValues,
+                                             size_t nBandValues,
+                                             T nMaxValue) const;
+
+    template <class T, int NINPUT, int NOUTPUT, bool bHasNoData>
     size_t WeightedBroveyPositiveWeightsInternal(
         const T *pPanBuffer, const T *pUpsampledSpectralBuffer, T *pDataBuf,
         size_t nValues, size_t nBandValues, T nMaxValue) const;
@@ -34,13 +34,16 @@
 #include <cstdlib>
 
 #include <algorithm>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
+#include "gdal_thread_pool.h"
 
 static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
                                    int *panNearY, int bForward, int iLine,
@@ -49,6 +52,14 @@ static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
                                    double *pdfSrcNoDataValue, int nTargetValues,
                                    int *panTargetValues);
 
+static CPLErr ComputeProximityExact(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hWorkProximityBand,
+    GDALRasterBandH hProximityBand, int nXSize, int nYSize, double dfMaxDist,
+    double dfDistMult, float fNoDataValue, const double *pdfSrcNoDataValue,
+    bool bFixedBufVal, double dfFixedBufVal, int nTargetValues,
+    const int *panTargetValues, int nThreads, GDALProgressFunc pfnProgress,
+    void *pProgressArg);
+
 /************************************************************************/
 /*                        GDALComputeProximity()                        */
 /************************************************************************/
@@ -105,6 +116,19 @@ the proximity output.
 
 If this option is set, all pixels within the MAXDIST threadhold are
 set to this fixed value instead of to a proximity distance.
+
+  ALGORITHM=[LEGACY]/EXACT
+
+(GDAL >= 3.9) The default LEGACY algorithm propagates the nearest target
+found along lines and can slightly overestimate some distances.  EXACT
+computes the exact Euclidean distance transform with a separable
+(Meijster-like) algorithm, first along columns and then along lines, by
+blocks of lines so that memory usage does not depend on the raster height.
+
+  NUM_THREADS=n|ALL_CPUS
+
+(GDAL >= 3.9) Number of worker threads used by ALGORITHM=EXACT.  Defaults
+to the value of the GDAL_NUM_THREADS configuration option, or 1.
 */
 
 CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
@@ -241,6 +265,33 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
         CSLDestroy(papszValuesTokens);
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Which algorithm should be used?                                 */
+    /* -------------------------------------------------------------------- */
+    bool bExact = false;
+    pszOpt = CSLFetchNameValue(papszOptions, "ALGORITHM");
+    if (pszOpt)
+    {
+        if (EQUAL(pszOpt, "EXACT"))
+            bExact = true;
+        else if (!EQUAL(pszOpt, "LEGACY"))
+        {
+            CPLError(
+                CE_Failure, CPLE_AppDefined,
+                "Unrecognized ALGORITHM value '%s', should be LEGACY or EXACT.",
+                pszOpt);
+            CPLFree(panTargetValues);
+            return CE_Failure;
+        }
+    }
+
+    const char *pszNumThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszNumThreads == nullptr)
+        pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    int nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+    nThreads = std::max(1, std::min(128, nThreads));
+
     /* -------------------------------------------------------------------- */
     /*      Initialize progress counter.                                    */
     /* -------------------------------------------------------------------- */
@@ -254,7 +305,9 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
     /* -------------------------------------------------------------------- */
     /*      We need a signed type for the working proximity values kept     */
     /*      on disk.  If our proximity band is not signed, then create a    */
-    /*      temporary file for this purpose.                                */
+    /*      temporary file for this purpose.  The exact algorithm stores    */
+    /*      vertical distances in lines, so it also needs a type able to    */
+    /*      hold the raster height.                                         */
     /* -------------------------------------------------------------------- */
     GDALRasterBandH hWorkProximityBand = hProximityBand;
     GDALDatasetH hWorkProximityDS = nullptr;
@@ -269,7 +322,9 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
     bool bTempFileAlreadyDeleted = false;
 
     if (eProxType == GDT_Byte || eProxType == GDT_UInt16 ||
-        eProxType == GDT_UInt32)
+        eProxType == GDT_UInt32 ||
+        (bExact && eProxType != GDT_Int32 && eProxType != GDT_Float32 &&
+         eProxType != GDT_Float64))
     {
         GDALDriverH hDriver = GDALGetDriverByName("GTiff");
         if (hDriver == nullptr)
@@ -294,6 +349,16 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
         hWorkProximityBand = GDALGetRasterBand(hWorkProximityDS, 1);
     }
 
+    if (bExact)
+    {
+        eErr = ComputeProximityExact(
+            hSrcBand, hWorkProximityBand, hProximityBand, nXSize, nYSize,
+            dfMaxDist, dfDistMult, fNoDataValue, pdfSrcNoData, bFixedBufVal,
+            dfFixedBufVal, nTargetValues, panTargetValues, nThreads,
+            pfnProgress, pProgressArg);
+        goto end;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Allocate buffer for two scanlines of distances as floats        */
     /*      (the current and last line).                                    */
@@ -589,3 +654,339 @@ static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
 
     return CE_None;
 }
+
+/************************************************************************/
+/*                         IsProximityTarget()                          */
+/************************************************************************/
+
+static bool IsProximityTarget(GInt32 nValue, int nTargetValues,
+                              const int *panTargetValues)
+{
+    if (nTargetValues == 0)
+        return nValue != 0;
+    for (int i = 0; i < nTargetValues; i++)
+    {
+        if (nValue == panTargetValues[i])
+            return true;
+    }
+    return false;
+}
+
+namespace
+{
+struct ProximityExactJob
+{
+    const GInt32 *panSrc = nullptr;
+    float *pafWork = nullptr;
+    int *panColDist = nullptr;
+    int nXSize = 0;
+    int nLines = 0;
+    int iStart = 0;
+    int iEnd = 0;
+    bool bDownward = true;
+    int nTargetValues = 0;
+    const int *panTargetValues = nullptr;
+    double dfMaxDist = 0;
+    double dfDistMult = 1;
+    float fNoDataValue = 0;
+    const double *pdfSrcNoDataValue = nullptr;
+    bool bFixedBufVal = false;
+    double dfFixedBufVal = 0;
+};
+}  // namespace
+
+/************************************************************************/
+/*                     ProximityExactColumnsJob()                       */
+/*                                                                      */
+/*      First pass of the exact algorithm, on columns [iStart, iEnd[:   */
+/*      distance in lines to the nearest target above (downward) or     */
+/*      below (upward), or -1 if there is none.  panColDist carries     */
+/*      the distance from one block of lines to the next.               */
+/************************************************************************/
+
+static void ProximityExactColumnsJob(void *pData)
+{
+    const ProximityExactJob *psJob = static_cast<ProximityExactJob *>(pData);
+    const int nXSize = psJob->nXSize;
+
+    for (int k = 0; k < psJob->nLines; k++)
+    {
+        const int iLine = psJob->bDownward ? k : psJob->nLines - 1 - k;
+        const GInt32 *panSrc =
+            psJob->panSrc + static_cast<size_t>(iLine) * nXSize;
+        float *pafWork = psJob->pafWork + static_cast<size_t>(iLine) * nXSize;
+
+        for (int iPixel = psJob->iStart; iPixel < psJob->iEnd; iPixel++)
+        {
+            int &nDist = psJob->panColDist[iPixel];
+            if (IsProximityTarget(panSrc[iPixel], psJob->nTargetValues,
+                                  psJob->panTargetValues))
+                nDist = 0;
+            else if (nDist >= 0)
+                nDist++;
+
+            if (psJob->bDownward)
+            {
+                pafWork[iPixel] = static_cast<float>(nDist);
+            }
+            else if (nDist >= 0 &&
+                     (pafWork[iPixel] < 0 || nDist < pafWork[iPixel]))
+            {
+                pafWork[iPixel] = static_cast<float>(nDist);
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                      ProximityExactLinesJob()                        */
+/*                                                                      */
+/*      Second pass of the exact algorithm, on lines [iStart, iEnd[:    */
+/*      lower envelope of the parabolas (x - q)^2 + g(q)^2 where g is   */
+/*      the vertical distance computed by the first pass, then final    */
+/*      post processing of the distances.                               */
+/************************************************************************/
+
+static void ProximityExactLinesJob(void *pData)
+{
+    const ProximityExactJob *psJob = static_cast<ProximityExactJob *>(pData);
+    const int nXSize = psJob->nXSize;
+    const double dfMaxDistSq = psJob->dfMaxDist * psJob->dfMaxDist;
+
+    std::vector<int> anSite(nXSize);
+    std::vector<double> adfSiteDistSq(nXSize);
+    std::vector<double> adfStart(nXSize);
+
+    for (int iLine = psJob->iStart; iLine < psJob->iEnd; iLine++)
+    {
+        const GInt32 *panSrc =
+            psJob->panSrc + static_cast<size_t>(iLine) * nXSize;
+        float *pafWork = psJob->pafWork + static_cast<size_t>(iLine) * nXSize;
+
+        // Build the lower envelope. adfStart[k] is the abscissa from which
+        // the parabola of anSite[k] is the lowest one.
+        int k = -1;
+        for (int q = 0; q < nXSize; q++)
+        {
+            if (pafWork[q] < 0)
+                continue;
+            const double dfDistSq =
+                static_cast<double>(pafWork[q]) * pafWork[q];
+            double dfStart = -HUGE_VAL;
+            while (k >= 0)
+            {
+                const int v = anSite[k];
+                dfStart = ((dfDistSq + static_cast<double>(q) * q) -
+                           (adfSiteDistSq[k] + static_cast<double>(v) * v)) /
+                          (2.0 * (q - v));
+                if (dfStart > adfStart[k])
+                    break;
+                k--;
+                dfStart = -HUGE_VAL;
+            }
+            k++;
+            anSite[k] = q;
+            adfSiteDistSq[k] = dfDistSq;
+            adfStart[k] = dfStart;
+        }
+
+        int j = 0;
+        for (int iPixel = 0; iPixel < nXSize; iPixel++)
+        {
+            if (k < 0)
+            {
+                pafWork[iPixel] = psJob->fNoDataValue;
+                continue;
+            }
+            while (j < k && adfStart[j + 1] < iPixel)
+                j++;
+            const double dfDX = static_cast<double>(iPixel - anSite[j]);
+            const double dfDistSq = dfDX * dfDX + adfSiteDistSq[j];
+
+            if (dfDistSq > dfMaxDistSq ||
+                (dfDistSq > 0 && psJob->pdfSrcNoDataValue != nullptr &&
+                 panSrc[iPixel] == *(psJob->pdfSrcNoDataValue)))
+                pafWork[iPixel] = psJob->fNoDataValue;
+            else if (dfDistSq == 0)
+                pafWork[iPixel] = 0.0f;
+            else if (psJob->bFixedBufVal)
+                pafWork[iPixel] = static_cast<float>(psJob->dfFixedBufVal);
+            else
+                pafWork[iPixel] =
+                    static_cast<float>(sqrt(dfDistSq) * psJob->dfDistMult);
+        }
+    }
+}
+
+/************************************************************************/
+/*                       RunProximityExactJobs()                        */
+/************************************************************************/
+
+static void RunProximityExactJobs(CPLJobQueue *poJobQueue,
+                                  std::vector<ProximityExactJob> &asJobs,
+                                  CPLThreadFunc pfnFunc)
+{
+    if (poJobQueue == nullptr || asJobs.size() == 1)
+    {
+        for (auto &sJob : asJobs)
+            pfnFunc(&sJob);
+        return;
+    }
+    for (size_t i = 1; i < asJobs.size(); i++)
+        poJobQueue->SubmitJob(pfnFunc, &asJobs[i]);
+    pfnFunc(&asJobs[0]);
+    poJobQueue->WaitCompletion();
+}
+
+/************************************************************************/
+/*                       ComputeProximityExact()                        */
+/*                                                                      */
+/*      Exact Euclidean distance transform.  The first pass, from top   */
+/*      to bottom, stores in hWorkProximityBand the vertical distance   */
+/*      to the nearest target above.  The second pass, from bottom to   */
+/*      top, completes the vertical distances with the nearest target   */
+/*      below, and then solves each line independently.  Lines are      */
+/*      processed by blocks, columns and lines being split among        */
+/*      threads.                                                        */
+/************************************************************************/
+
+static CPLErr ComputeProximityExact(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hWorkProximityBand,
+    GDALRasterBandH hProximityBand, int nXSize, int nYSize, double dfMaxDist,
+    double dfDistMult, float fNoDataValue, const double *pdfSrcNoDataValue,
+    bool bFixedBufVal, double dfFixedBufVal, int nTargetValues,
+    const int *panTargetValues, int nThreads, GDALProgressFunc pfnProgress,
+    void *pProgressArg)
+{
+    // Blocks of about 4 M pixels. The config option is only for testing.
+    const int nBlockLines = std::min(
+        nYSize, std::max(1, atoi(CPLGetConfigOption(
+                                "GDAL_PROXIMITY_BLOCK_HEIGHT",
+                                CPLSPrintf("%d", 4 * 1024 * 1024 / nXSize)))));
+
+    GInt32 *panSrc = static_cast<GInt32 *>(
+        VSI_MALLOC3_VERBOSE(sizeof(GInt32), nXSize, nBlockLines));
+    float *pafWork = static_cast<float *>(
+        VSI_MALLOC3_VERBOSE(sizeof(float), nXSize, nBlockLines));
+    if (panSrc == nullptr || pafWork == nullptr)
+    {
+        CPLFree(panSrc);
+        CPLFree(pafWork);
+        return CE_Failure;
+    }
+    std::vector<int> anColDist(nXSize, -1);
+
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+
+    ProximityExactJob sTemplate;
+    sTemplate.panSrc = panSrc;
+    sTemplate.pafWork = pafWork;
+    sTemplate.panColDist = anColDist.data();
+    sTemplate.nXSize = nXSize;
+    sTemplate.nTargetValues = nTargetValues;
+    sTemplate.panTargetValues = panTargetValues;
+    sTemplate.dfMaxDist = dfMaxDist;
+    sTemplate.dfDistMult = dfDistMult;
+    sTemplate.fNoDataValue = fNoDataValue;
+    sTemplate.pdfSrcNoDataValue = pdfSrcNoDataValue;
+    sTemplate.bFixedBufVal = bFixedBufVal;
+    sTemplate.dfFixedBufVal = dfFixedBufVal;
+
+    // Split [0, nCount[ in at most nThreads ranges.
+    const auto SplitJobs = [&sTemplate, nThreads](int nCount, int nLines,
+                                                  bool bDownward)
+    {
+        const int nJobs = std::max(1, std::min(nThreads, nCount));
+        std::vector<ProximityExactJob> asJobs(nJobs, sTemplate);
+        for (int i = 0; i < nJobs; i++)
+        {
+            asJobs[i].nLines = nLines;
+            asJobs[i].bDownward = bDownward;
+            asJobs[i].iStart =
+                static_cast<int>(static_cast<GIntBig>(nCount) * i / nJobs);
+            asJobs[i].iEnd = static_cast<int>(static_cast<GIntBig>(nCount) *
+                                              (i + 1) / nJobs);
+        }
+        return asJobs;
+    };
+
+    CPLErr eErr = CE_None;
+
+    /* -------------------------------------------------------------------- */
+    /*      Top to bottom pass.                                             */
+    /* -------------------------------------------------------------------- */
+    for (int iLine = 0; eErr == CE_None && iLine < nYSize;
+         iLine += nBlockLines)
+    {
+        const int nLines = std::min(nBlockLines, nYSize - iLine);
+        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iLine, nXSize, nLines,
+                            panSrc, nXSize, nLines, GDT_Int32, 0, 0);
+        if (eErr != CE_None)
+            break;
+
+        auto asJobs = SplitJobs(nXSize, nLines, true);
+        RunProximityExactJobs(poJobQueue.get(), asJobs,
+                              ProximityExactColumnsJob);
+
+        eErr = GDALRasterIO(hWorkProximityBand, GF_Write, 0, iLine, nXSize,
+                            nLines, pafWork, nXSize, nLines, GDT_Float32, 0,
+                            0);
+        if (eErr != CE_None)
+            break;
+
+        if (!pfnProgress(0.5 * (iLine + nLines) / static_cast<double>(nYSize),
+                         "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Bottom to top pass.                                             */
+    /* -------------------------------------------------------------------- */
+    std::fill(anColDist.begin(), anColDist.end(), -1);
+
+    for (int iLineEnd = nYSize; eErr == CE_None && iLineEnd > 0;
+         iLineEnd -= nBlockLines)
+    {
+        const int iLine = std::max(0, iLineEnd - nBlockLines);
+        const int nLines = iLineEnd - iLine;
+        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iLine, nXSize, nLines,
+                            panSrc, nXSize, nLines, GDT_Int32, 0, 0);
+        if (eErr == CE_None)
+            eErr = GDALRasterIO(hWorkProximityBand, GF_Read, 0, iLine, nXSize,
+                                nLines, pafWork, nXSize, nLines, GDT_Float32,
+                                0, 0);
+        if (eErr != CE_None)
+            break;
+
+        auto asJobs = SplitJobs(nXSize, nLines, false);
+        RunProximityExactJobs(poJobQueue.get(), asJobs,
+                              ProximityExactColumnsJob);
+
+        asJobs = SplitJobs(nLines, nLines, false);
+        RunProximityExactJobs(poJobQueue.get(), asJobs,
+                              ProximityExactLinesJob);
+
+        eErr = GDALRasterIO(hProximityBand, GF_Write, 0, iLine, nXSize, nLines,
+                            pafWork, nXSize, nLines, GDT_Float32, 0, 0);
+        if (eErr != CE_None)
+            break;
+
+        if (!pfnProgress(0.5 + 0.5 * (nYSize - iLine) /
+                                   static_cast<double>(nYSize),
+                         "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    CPLFree(panSrc);
+    CPLFree(pafWork);
+
+    return eErr;
+}
@@ -36,7 +36,10 @@
 #include <cstdlib>
 #include <cstring>
 #include <cfloat>
+#include <cmath>
 #include <limits>
+#include <memory>
+#include <utility>
 #include <vector>
 #include <algorithm>
 
@@ -45,8 +48,10 @@
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include "gdal_priv_templates.hpp"
 #include "ogr_api.h"
 #include "ogr_core.h"
@@ -277,6 +282,104 @@ static void gvBurnScanline(void *pCBData, int nY, int nXStart, int nXEnd,
     }
 }
 
+/************************************************************************/
+/*                     gvBurnScanlineCoverageBasic()                    */
+/************************************************************************/
+template <typename T>
+static inline void gvBurnScanlineCoverageBasic(GDALRasterizeInfo *psInfo,
+                                               int nY, int nXStart, int nXEnd,
+                                               const double *padfCoverage)
+
+{
+    for (int iBand = 0; iBand < psInfo->nBands; iBand++)
+    {
+        const double burnValue = psInfo->burnValues.double_values[iBand];
+
+        unsigned char *pabyInsert =
+            psInfo->pabyChunkBuf + iBand * psInfo->nBandSpace +
+            nY * psInfo->nLineSpace + nXStart * psInfo->nPixelSpace;
+        for (int nX = nXStart; nX <= nXEnd; ++nX)
+        {
+            const double dfCoverage = padfCoverage[nX - nXStart];
+            if (dfCoverage > 0)
+            {
+                double dfVal = burnValue * dfCoverage;
+                if (psInfo->eMergeAlg == GRMA_Add)
+                    dfVal += static_cast<double>(
+                        *reinterpret_cast<T *>(pabyInsert));
+                GDALCopyWord(dfVal, *reinterpret_cast<T *>(pabyInsert));
+            }
+            pabyInsert += psInfo->nPixelSpace;
+        }
+    }
+}
+
+/************************************************************************/
+/*                       gvBurnScanlineCoverage()                       */
+/************************************************************************/
+static void gvBurnScanlineCoverage(void *pCBData, int nY, int nXStart,
+                                   int nXEnd, const double *padfCoverage)
+
+{
+    GDALRasterizeInfo *psInfo = static_cast<GDALRasterizeInfo *>(pCBData);
+
+    CPLAssert(nY >= 0 && nY < psInfo->nYSize);
+    CPLAssert(nXStart >= 0 && nXEnd < psInfo->nXSize);
+    CPLAssert(psInfo->eBurnValueType == GDT_Float64);
+
+    switch (psInfo->eType)
+    {
+        case GDT_Byte:
+            gvBurnScanlineCoverageBasic<GByte>(psInfo, nY, nXStart, nXEnd,
+                                               padfCoverage);
+            break;
+        case GDT_Int8:
+            gvBurnScanlineCoverageBasic<GInt8>(psInfo, nY, nXStart, nXEnd,
+                                               padfCoverage);
+            break;
+        case GDT_Int16:
+            gvBurnScanlineCoverageBasic<GInt16>(psInfo, nY, nXStart, nXEnd,
+                                                padfCoverage);
+            break;
+        case GDT_UInt16:
+            gvBurnScanlineCoverageBasic<GUInt16>(psInfo, nY, nXStart, nXEnd,
+                                                 padfCoverage);
+            break;
+        case GDT_Int32:
+            gvBurnScanlineCoverageBasic<GInt32>(psInfo, nY, nXStart, nXEnd,
+                                                padfCoverage);
+            break;
+        case GDT_UInt32:
+            gvBurnScanlineCoverageBasic<GUInt32>(psInfo, nY, nXStart, nXEnd,
+                                                 padfCoverage);
+            break;
+        case GDT_Int64:
+            gvBurnScanlineCoverageBasic<std::int64_t>(psInfo, nY, nXStart,
+                                                      nXEnd, padfCoverage);
+            break;
+        case GDT_UInt64:
+            gvBurnScanlineCoverageBasic<std::uint64_t>(psInfo, nY, nXStart,
+                                                       nXEnd, padfCoverage);
+            break;
+        case GDT_Float32:
+            gvBurnScanlineCoverageBasic<float>(psInfo, nY, nXStart, nXEnd,
+                                               padfCoverage);
+            break;
+        case GDT_Float64:
+            gvBurnScanlineCoverageBasic<double>(psInfo, nY, nXStart, nXEnd,
+                                                padfCoverage);
+            break;
+        case GDT_CInt16:
+        case GDT_CInt32:
+        case GDT_CFloat32:
+        case GDT_CFloat64:
+        case GDT_Unknown:
+        case GDT_TypeCount:
+            CPLAssert(false);
+            break;
+    }
+}
+
 /************************************************************************/
 /*                        gvBurnPointBasic()                            */
 /************************************************************************/
@@ -546,14 +649,57 @@ static void GDALCollectRingsFromGeometry(const OGRGeometry *poShape,
     }
 }
 
+/************************************************************************/
+/*                      GDALCollectPolygonRings()                       */
+/*                                                                      */
+/*      Same as GDALCollectRingsFromGeometry() for polygonal            */
+/*      geometries, but also records whether each ring is an exterior   */
+/*      ring, for the coverage fraction computation.                    */
+/************************************************************************/
+
+static void GDALCollectPolygonRings(const OGRGeometry *poShape,
+                                    std::vector<double> &aPointX,
+                                    std::vector<double> &aPointY,
+                                    std::vector<int> &aPartSize,
+                                    std::vector<bool> &abIsExteriorRing)
+
+{
+    if (poShape == nullptr || poShape->IsEmpty())
+        return;
+
+    const OGRwkbGeometryType eFlatType = wkbFlatten(poShape->getGeometryType());
+    if (eFlatType == wkbPolygon)
+    {
+        const auto poPolygon = poShape->toPolygon();
+        std::vector<double> aPointVariant;
+        for (int i = 0; i <= poPolygon->getNumInteriorRings(); i++)
+        {
+            const size_t nPartCountBefore = aPartSize.size();
+            GDALCollectRingsFromGeometry(
+                i == 0 ? poPolygon->getExteriorRing()
+                       : poPolygon->getInteriorRing(i - 1),
+                aPointX, aPointY, aPointVariant, aPartSize, GBV_UserBurnValue);
+            if (aPartSize.size() > nPartCountBefore)
+                abIsExteriorRing.push_back(i == 0);
+        }
+    }
+    else if (eFlatType == wkbMultiPolygon)
+    {
+        for (const auto poPart : *(poShape->toMultiPolygon()))
+            GDALCollectPolygonRings(poPart, aPointX, aPointY, aPartSize,
+                                    abIsExteriorRing);
+    }
+}
+
 /************************************************************************/
 /*                       gv_rasterize_one_shape()                       */
 /************************************************************************/
 static void gv_rasterize_one_shape(
     unsigned char *pabyChunkBuf, int nXOff, int nYOff, int nXSize, int nYSize,
     int nBands, GDALDataType eType, int nPixelSpace, GSpacing nLineSpace,
-    GSpacing nBandSpace, int bAllTouched, const OGRGeometry *poShape,
-    GDALDataType eBurnValueType, const double *padfBurnValues,
+    GSpacing nBandSpace, int bAllTouched, bool bCoverageFraction,
+    const OGRGeometry *poShape, GDALDataType eBurnValueType,
+    const double *padfBurnValues,
     const int64_t *panBurnValues, GDALBurnValueSrc eBurnValueSrc,
     GDALRasterMergeAlg eMergeAlg, GDALTransformerFunc pfnTransformer,
     void *pTransformArg)
@@ -565,18 +711,22 @@ static void gv_rasterize_one_shape(
 
     if ((eGeomType == wkbMultiLineString || eGeomType == wkbMultiPolygon ||
          eGeomType == wkbGeometryCollection) &&
-        eMergeAlg == GRMA_Replace)
+        (eMergeAlg == GRMA_Replace ||
+         (bCoverageFraction && eGeomType == wkbGeometryCollection)))
     {
         // Speed optimization: in replace mode, we can rasterize each part of
         // a geometry collection separately.
+        // In coverage fraction mode, this also lets polygonal parts of
+        // collections be handled as such.
         const auto poGC = poShape->toGeometryCollection();
         for (const auto poPart : *poGC)
         {
             gv_rasterize_one_shape(
                 pabyChunkBuf, nXOff, nYOff, nXSize, nYSize, nBands, eType,
-                nPixelSpace, nLineSpace, nBandSpace, bAllTouched, poPart,
-                eBurnValueType, padfBurnValues, panBurnValues, eBurnValueSrc,
-                eMergeAlg, pfnTransformer, pTransformArg);
+                nPixelSpace, nLineSpace, nBandSpace, bAllTouched,
+                bCoverageFraction, poPart, eBurnValueType, padfBurnValues,
+                panBurnValues, eBurnValueSrc, eMergeAlg, pfnTransformer,
+                pTransformArg);
         }
         return;
     }
@@ -625,9 +775,17 @@ static void gv_rasterize_one_shape(
     std::vector<double> aPointY;
     std::vector<double> aPointVariant;
     std::vector<int> aPartSize;
-
-    GDALCollectRingsFromGeometry(poShape, aPointX, aPointY, aPointVariant,
-                                 aPartSize, eBurnValueSrc);
+    std::vector<bool> abIsExteriorRing;
+
+    const bool bPolygonCoverage =
+        bCoverageFraction &&
+        (eGeomType == wkbPolygon || eGeomType == wkbMultiPolygon);
+    if (bPolygonCoverage)
+        GDALCollectPolygonRings(poShape, aPointX, aPointY, aPartSize,
+                                abIsExteriorRing);
+    else
+        GDALCollectRingsFromGeometry(poShape, aPointX, aPointY, aPointVariant,
+                                     aPartSize, eBurnValueSrc);
 
     /* -------------------------------------------------------------------- */
     /*      Transform points if needed.                                     */
@@ -651,6 +809,40 @@ static void gv_rasterize_one_shape(
     for (unsigned int i = 0; i < aPointY.size(); i++)
         aPointY[i] -= nYOff;
 
+    /* -------------------------------------------------------------------- */
+    /*      In coverage fraction mode, compute the exact fraction of each   */
+    /*      pixel covered by the polygon. This requires exterior and        */
+    /*      interior rings to have opposite orientations in pixel space.    */
+    /* -------------------------------------------------------------------- */
+    if (bPolygonCoverage)
+    {
+        for (size_t iPart = 0, nOffset = 0; iPart < aPartSize.size();
+             nOffset += aPartSize[iPart], iPart++)
+        {
+            const size_t nCount = aPartSize[iPart];
+            double dfArea = 0;
+            for (size_t i = 0; i < nCount; i++)
+            {
+                const size_t j = (i + 1) % nCount;
+                dfArea += aPointX[nOffset + i] * aPointY[nOffset + j] -
+                          aPointX[nOffset + j] * aPointY[nOffset + i];
+            }
+            if ((dfArea > 0) != abIsExteriorRing[iPart])
+            {
+                std::reverse(aPointX.begin() + nOffset,
+                             aPointX.begin() + nOffset + nCount);
+                std::reverse(aPointY.begin() + nOffset,
+                             aPointY.begin() + nOffset + nCount);
+            }
+        }
+
+        GDALdllImageFilledPolygonCoverage(
+            sInfo.nXSize, nYSize, static_cast<int>(aPartSize.size()),
+            aPartSize.data(), aPointX.data(), aPointY.data(),
+            gvBurnScanlineCoverage, &sInfo);
+        return;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Perform the rasterization.                                      */
     /*      According to the C++ Standard/23.2.4, elements of a vector are  */
@@ -744,6 +936,122 @@ static void gv_rasterize_one_shape(
     delete sInfo.poSetVisitedPoints;
 }
 
+/************************************************************************/
+/*                       GDALGetShapeLineRange()                        */
+/*                                                                      */
+/*      Compute the range of lines that may be burnt by a shape, with   */
+/*      one line of margin on each side.                                */
+/************************************************************************/
+
+static std::pair<int, int>
+GDALGetShapeLineRange(const OGRGeometry *poShape,
+                      GDALTransformerFunc pfnTransformer, void *pTransformArg)
+{
+    std::vector<double> aPointX;
+    std::vector<double> aPointY;
+    std::vector<double> aPointVariant;
+    std::vector<int> aPartSize;
+    GDALCollectRingsFromGeometry(poShape, aPointX, aPointY, aPointVariant,
+                                 aPartSize, GBV_UserBurnValue);
+    if (aPointY.empty())
+        return std::pair<int, int>(0, -1);
+
+    if (pfnTransformer != nullptr)
+    {
+        std::vector<int> anSuccess(aPointX.size());
+        pfnTransformer(pTransformArg, FALSE, static_cast<int>(aPointX.size()),
+                       aPointX.data(), aPointY.data(), nullptr,
+                       anSuccess.data());
+    }
+
+    const auto oMinMax = std::minmax_element(aPointY.begin(), aPointY.end());
+    const double dfMinY = *(oMinMax.first);
+    const double dfMaxY = *(oMinMax.second);
+    constexpr double INT_MIN_AS_DOUBLE = std::numeric_limits<int>::min() + 1;
+    constexpr double INT_MAX_AS_DOUBLE = std::numeric_limits<int>::max() - 1;
+    if (!(dfMinY >= INT_MIN_AS_DOUBLE && dfMaxY <= INT_MAX_AS_DOUBLE))
+    {
+        // Infinite or NaN values: no assumption can be made.
+        return std::pair<int, int>(std::numeric_limits<int>::min(),
+                                   std::numeric_limits<int>::max());
+    }
+    return std::pair<int, int>(static_cast<int>(std::floor(dfMinY)) - 1,
+                               static_cast<int>(std::floor(dfMaxY)) + 1);
+}
+
+/************************************************************************/
+/*                        GDALRasterizeStripe()                         */
+/************************************************************************/
+
+namespace
+{
+// Rasterization of a set of shapes into a stripe of lines of a chunk.
+struct GDALRasterizeStripeJob
+{
+    unsigned char *pabyStripeBuf = nullptr;
+    int nXSize = 0;
+    int nYOff = 0;
+    int nYSize = 0;
+    int nBandCount = 0;
+    GDALDataType eType = GDT_Unknown;
+    int nPixelSpace = 0;
+    GSpacing nLineSpace = 0;
+    GSpacing nBandSpace = 0;
+    int bAllTouched = FALSE;
+    bool bCoverageFraction = false;
+    const OGRGeometryH *pahGeometries = nullptr;
+    // Shapes to burn, or nullptr for all of the nGeomCount ones.
+    const std::vector<int> *panShapes = nullptr;
+    int nGeomCount = 0;
+    // Line range of each shape, or nullptr if unknown.
+    const std::vector<std::pair<int, int>> *panShapeLineRanges = nullptr;
+    GDALDataType eBurnValueType = GDT_Float64;
+    const double *padfGeomBurnValues = nullptr;
+    const int64_t *panGeomBurnValues = nullptr;
+    GDALBurnValueSrc eBurnValueSource = GBV_UserBurnValue;
+    GDALRasterMergeAlg eMergeAlg = GRMA_Replace;
+    GDALTransformerFunc pfnTransformer = nullptr;
+    void *pTransformArg = nullptr;
+};
+}  // namespace
+
+static void GDALRasterizeStripe(void *pData)
+{
+    const auto psJob = static_cast<const GDALRasterizeStripeJob *>(pData);
+    const int nShapes = psJob->panShapes
+                            ? static_cast<int>(psJob->panShapes->size())
+                            : psJob->nGeomCount;
+    for (int i = 0; i < nShapes; i++)
+    {
+        const int iShape = psJob->panShapes ? (*psJob->panShapes)[i] : i;
+        if (psJob->panShapeLineRanges)
+        {
+            const auto &oRange = (*psJob->panShapeLineRanges)[iShape];
+            if (oRange.second < psJob->nYOff ||
+                oRange.first >= psJob->nYOff + psJob->nYSize)
+            {
+                continue;
+            }
+        }
+        const int nBandCount = psJob->nBandCount;
+        gv_rasterize_one_shape(
+            psJob->pabyStripeBuf, 0, psJob->nYOff, psJob->nXSize,
+            psJob->nYSize, nBandCount, psJob->eType, psJob->nPixelSpace,
+            psJob->nLineSpace, psJob->nBandSpace, psJob->bAllTouched,
+            psJob->bCoverageFraction,
+            OGRGeometry::FromHandle(psJob->pahGeometries[iShape]),
+            psJob->eBurnValueType,
+            psJob->padfGeomBurnValues
+                ? psJob->padfGeomBurnValues + iShape * nBandCount
+                : nullptr,
+            psJob->panGeomBurnValues
+                ? psJob->panGeomBurnValues + iShape * nBandCount
+                : nullptr,
+            psJob->eBurnValueSource, psJob->eMergeAlg, psJob->pfnTransformer,
+            psJob->pTransformArg);
+    }
+}
+
 /************************************************************************/
 /*                        GDALRasterizeOptions()                        */
 /*                                                                      */
@@ -754,7 +1062,8 @@ static void gv_rasterize_one_shape(
 static CPLErr GDALRasterizeOptions(CSLConstList papszOptions, int *pbAllTouched,
                                    GDALBurnValueSrc *peBurnValueSource,
                                    GDALRasterMergeAlg *peMergeAlg,
-                                   GDALRasterizeOptim *peOptim)
+                                   GDALRasterizeOptim *peOptim,
+                                   bool *pbCoverageFraction)
 {
     *pbAllTouched = CPLFetchBool(papszOptions, "ALL_TOUCHED", false);
 
@@ -826,6 +1135,20 @@ static CPLErr GDALRasterizeOptions(CSLConstList papszOptions, int *pbAllTouched,
         }
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      COVERAGE_FRACTION=YES/[NO]                                      */
+    /* -------------------------------------------------------------------- */
+    *pbCoverageFraction =
+        CPLFetchBool(papszOptions, "COVERAGE_FRACTION", false);
+    if (*pbCoverageFraction &&
+        (*pbAllTouched || *peBurnValueSource != GBV_UserBurnValue))
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "COVERAGE_FRACTION=YES is not compatible with ALL_TOUCHED or "
+                 "BURN_VALUE_FROM.");
+        return CE_Failure;
+    }
+
     return CE_None;
 }
 
@@ -889,6 +1212,15 @@ static CPLErr GDALRasterizeGeometriesInternal(
  * used. Default size will be estimated based on the GDAL cache buffer size
  * using formula: cache_size_bytes/scanline_size_bytes, so the chunk will
  * not exceed the cache. Not used in OPTIM=RASTER mode.</li>
+ * <li>"COVERAGE_FRACTION": (GDAL >= 3.9) May be set to YES to burn, for
+ * polygons, the burn value multiplied by the exact fraction of the area of
+ * each pixel covered by the polygon (with MERGE_ALG=REPLACE, pixels not
+ * covered are left unchanged). Not compatible with ALL_TOUCHED and
+ * BURN_VALUE_FROM. Defaults to NO.</li>
+ * <li>"NUM_THREADS": (GDAL >= 3.9) Number of worker threads (or ALL_CPUS)
+ * used to rasterize stripes of lines of each chunk in parallel, in
+ * OPTIM=RASTER mode. Defaults to the value of the GDAL_NUM_THREADS
+ * configuration option, or 1. Only used if the transformer can be cloned.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -1029,9 +1361,18 @@ static CPLErr GDALRasterizeGeometriesInternal(
     GDALBurnValueSrc eBurnValueSource = GBV_UserBurnValue;
     GDALRasterMergeAlg eMergeAlg = GRMA_Replace;
     GDALRasterizeOptim eOptim = GRO_Auto;
+    bool bCoverageFraction = false;
     if (GDALRasterizeOptions(papszOptions, &bAllTouched, &eBurnValueSource,
-                             &eMergeAlg, &eOptim) == CE_Failure)
+                             &eMergeAlg, &eOptim,
+                             &bCoverageFraction) == CE_Failure)
+    {
+        return CE_Failure;
+    }
+    if (bCoverageFraction && eBurnValueType == GDT_Int64)
     {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "COVERAGE_FRACTION=YES is not supported by "
+                 "GDALRasterizeGeometriesInt64()");
         return CE_Failure;
     }
 
@@ -1146,6 +1487,87 @@ static CPLErr GDALRasterizeGeometriesInternal(
             return CE_Failure;
         }
 
+        const int nYChunks =
+            (poDS->GetRasterYSize() + nYChunkSize - 1) / nYChunkSize;
+
+        /* --------------------------------------------------------------------
+         */
+        /*      Each chunk may be split into stripes of lines that are */
+        /*      rasterized in parallel. Each thread needs its own */
+        /*      transformer. */
+        /* --------------------------------------------------------------------
+         */
+        const char *pszNumThreads =
+            CSLFetchNameValue(papszOptions, "NUM_THREADS");
+        if (pszNumThreads == nullptr)
+            pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+        int nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                        : atoi(pszNumThreads);
+        nThreads = std::max(1, std::min(std::min(128, nYChunkSize), nThreads));
+
+        std::vector<void *> apTransformArgs{pTransformArg};
+        std::unique_ptr<CPLJobQueue> poJobQueue;
+        if (nThreads > 1)
+        {
+            for (int i = 1; i < nThreads; i++)
+            {
+                void *pClonedTransformArg = GDALCloneTransformer(pTransformArg);
+                if (pClonedTransformArg == nullptr)
+                    break;
+                apTransformArgs.push_back(pClonedTransformArg);
+            }
+            CPLWorkerThreadPool *poThreadPool =
+                static_cast<int>(apTransformArgs.size()) == nThreads
+                    ? GDALGetGlobalThreadPool(nThreads)
+                    : nullptr;
+            if (poThreadPool)
+                poJobQueue = poThreadPool->CreateJobQueue();
+            if (!poJobQueue)
+            {
+                CPLDebug("GDAL", "Cannot rasterize in multiple threads");
+                nThreads = 1;
+                for (size_t i = 1; i < apTransformArgs.size(); i++)
+                    GDALDestroyTransformer(apTransformArgs[i]);
+                apTransformArgs.resize(1);
+            }
+        }
+
+        /* --------------------------------------------------------------------
+         */
+        /*      Spatial index of the shapes by chunk, so that each chunk */
+        /*      (and stripe) only processes the shapes that overlap it. */
+        /* --------------------------------------------------------------------
+         */
+        std::vector<std::pair<int, int>> anShapeLineRanges;
+        std::vector<std::vector<int>> aanChunkShapes;
+        if (nYChunks > 1 || nThreads > 1)
+        {
+            anShapeLineRanges.resize(nGeomCount);
+            aanChunkShapes.resize(nYChunks);
+            for (int iShape = 0; iShape < nGeomCount; iShape++)
+            {
+                const OGRGeometry *poShape =
+                    OGRGeometry::FromHandle(pahGeometries[iShape]);
+                if (poShape == nullptr || poShape->IsEmpty())
+                {
+                    anShapeLineRanges[iShape] = std::pair<int, int>(0, -1);
+                    continue;
+                }
+                const auto oRange = GDALGetShapeLineRange(
+                    poShape, pfnTransformer, pTransformArg);
+                anShapeLineRanges[iShape] = oRange;
+                if (oRange.second < 0 ||
+                    oRange.first >= poDS->GetRasterYSize())
+                    continue;
+                const int iFirstChunk = std::max(0, oRange.first) / nYChunkSize;
+                const int iLastChunk =
+                    std::min(poDS->GetRasterYSize() - 1, oRange.second) /
+                    nYChunkSize;
+                for (int iChunk = iFirstChunk; iChunk <= iLastChunk; iChunk++)
+                    aanChunkShapes[iChunk].push_back(iShape);
+            }
+        }
+
         /* ====================================================================
          */
         /*      Loop over image in designated chunks. */
@@ -1153,6 +1575,10 @@ static CPLErr GDALRasterizeGeometriesInternal(
          */
         pfnProgress(0.0, nullptr, pProgressArg);
 
+        const int nPixelSpace = GDALGetDataTypeSizeBytes(eType);
+        const GSpacing nLineSpace =
+            static_cast<GSpacing>(poDS->GetRasterXSize()) * nPixelSpace;
+        std::vector<GDALRasterizeStripeJob> asJobs(nThreads);
         for (int iY = 0; iY < poDS->GetRasterYSize() && eErr == CE_None;
              iY += nYChunkSize)
         {
@@ -1167,20 +1593,49 @@ static CPLErr GDALRasterizeGeometriesInternal(
             if (eErr != CE_None)
                 break;
 
-            for (int iShape = 0; iShape < nGeomCount; iShape++)
+            const int nStripes = std::min(nThreads, nThisYChunkSize);
+            const int nLinesPerStripe =
+                (nThisYChunkSize + nStripes - 1) / nStripes;
+            for (int iStripe = 0; iStripe < nStripes; iStripe++)
             {
-                gv_rasterize_one_shape(
-                    pabyChunkBuf, 0, iY, poDS->GetRasterXSize(),
-                    nThisYChunkSize, nBandCount, eType, 0, 0, 0, bAllTouched,
-                    OGRGeometry::FromHandle(pahGeometries[iShape]),
-                    eBurnValueType,
-                    padfGeomBurnValues
-                        ? padfGeomBurnValues + iShape * nBandCount
-                        : nullptr,
-                    panGeomBurnValues ? panGeomBurnValues + iShape * nBandCount
-                                      : nullptr,
-                    eBurnValueSource, eMergeAlg, pfnTransformer, pTransformArg);
+                const int nStripeYOff = iStripe * nLinesPerStripe;
+                GDALRasterizeStripeJob &sJob = asJobs[iStripe];
+                sJob.pabyStripeBuf = pabyChunkBuf + nStripeYOff * nLineSpace;
+                sJob.nXSize = poDS->GetRasterXSize();
+                sJob.nYOff = iY + nStripeYOff;
+                sJob.nYSize = std::min(nLinesPerStripe,
+                                       nThisYChunkSize - nStripeYOff);
+                sJob.nBandCount = nBandCount;
+                sJob.eType = eType;
+                sJob.nPixelSpace = nPixelSpace;
+                sJob.nLineSpace = nLineSpace;
+                sJob.nBandSpace = nThisYChunkSize * nLineSpace;
+                sJob.bAllTouched = bAllTouched;
+                sJob.bCoverageFraction = bCoverageFraction;
+                sJob.pahGeometries = pahGeometries;
+                sJob.panShapes = aanChunkShapes.empty()
+                                     ? nullptr
+                                     : &aanChunkShapes[iY / nYChunkSize];
+                sJob.nGeomCount = nGeomCount;
+                sJob.panShapeLineRanges =
+                    anShapeLineRanges.empty() ? nullptr : &anShapeLineRanges;
+                sJob.eBurnValueType = eBurnValueType;
+                sJob.padfGeomBurnValues = padfGeomBurnValues;
+                sJob.panGeomBurnValues = panGeomBurnValues;
+                sJob.eBurnValueSource = eBurnValueSource;
+                sJob.eMergeAlg = eMergeAlg;
+                sJob.pfnTransformer = pfnTransformer;
+                sJob.pTransformArg = apTransformArgs[iStripe];
+                if (iStripe > 0 &&
+                    !poJobQueue->SubmitJob(GDALRasterizeStripe, &sJob))
+                {
+                    GDALRasterizeStripe(&sJob);
+                }
             }
+            // The first stripe is processed by this thread.
+            GDALRasterizeStripe(&asJobs[0]);
+            if (poJobQueue)
+                poJobQueue->WaitCompletion();
 
             eErr = poDS->RasterIO(
                 GF_Write, 0, iY, poDS->GetRasterXSize(), nThisYChunkSize,
@@ -1195,6 +1650,9 @@ static CPLErr GDALRasterizeGeometriesInternal(
                 eErr = CE_Failure;
             }
         }
+
+        for (size_t i = 1; i < apTransformArgs.size(); i++)
+            GDALDestroyTransformer(apTransformArgs[i]);
     }
     /* -------------------------------------------------------------------- */
     /*      The new algorithm                                               */
@@ -1338,7 +1796,7 @@ static CPLErr GDALRasterizeGeometriesInternal(
                     gv_rasterize_one_shape(
                         pabyChunkBuf, xB * nXBlockSize, yB * nYBlockSize,
                         nThisXChunkSize, nThisYChunkSize, nBandCount, eType, 0,
-                        0, 0, bAllTouched,
+                        0, 0, bAllTouched, bCoverageFraction,
                         OGRGeometry::FromHandle(pahGeometries[iShape]),
                         eBurnValueType,
                         padfGeomBurnValues
@@ -1442,6 +1900,11 @@ static CPLErr GDALRasterizeGeometriesInternal(
  * <li>"MERGE_ALG": May be REPLACE (the default) or ADD.  REPLACE results in
  * overwriting of value, while ADD adds the new value to the existing raster,
  * suitable for heatmaps for instance.</li>
+ * <li>"COVERAGE_FRACTION": (GDAL >= 3.9) May be set to YES to burn, for
+ * polygons, the burn value multiplied by the exact fraction of the area of
+ * each pixel covered by the polygon (with MERGE_ALG=REPLACE, pixels not
+ * covered are left unchanged). Not compatible with ALL_TOUCHED and
+ * BURN_VALUE_FROM. Defaults to NO.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -1482,8 +1945,10 @@ CPLErr GDALRasterizeLayers(GDALDatasetH hDS, int nBandCount, int *panBandList,
     GDALBurnValueSrc eBurnValueSource = GBV_UserBurnValue;
     GDALRasterMergeAlg eMergeAlg = GRMA_Replace;
     GDALRasterizeOptim eOptim = GRO_Auto;
+    bool bCoverageFraction = false;
     if (GDALRasterizeOptions(papszOptions, &bAllTouched, &eBurnValueSource,
-                             &eMergeAlg, &eOptim) == CE_Failure)
+                             &eMergeAlg, &eOptim,
+                             &bCoverageFraction) == CE_Failure)
     {
         return CE_Failure;
     }
@@ -1693,8 +2158,9 @@ CPLErr GDALRasterizeLayers(GDALDatasetH hDS, int nBandCount, int *panBandList,
                 gv_rasterize_one_shape(
                     pabyChunkBuf, 0, iY, poDS->GetRasterXSize(),
                     nThisYChunkSize, nBandCount, eType, 0, 0, 0, bAllTouched,
-                    poGeom, GDT_Float64, padfBurnValues, nullptr,
-                    eBurnValueSource, eMergeAlg, pfnTransformer, pTransformArg);
+                    bCoverageFraction, poGeom, GDT_Float64, padfBurnValues,
+                    nullptr, eBurnValueSource, eMergeAlg, pfnTransformer,
+                    pTransformArg);
             }
 
             // Only write image if not a single chunk is being rendered.
@@ -1816,6 +2282,11 @@ CPLErr GDALRasterizeLayers(GDALDatasetH hDS, int nBandCount, int *panBandList,
  * <li>"MERGE_ALG": May be REPLACE (the default) or ADD.  REPLACE
  * results in overwriting of value, while ADD adds the new value to the
  * existing raster, suitable for heatmaps for instance.</li>
+ * <li>"COVERAGE_FRACTION": (GDAL >= 3.9) May be set to YES to burn, for
+ * polygons, the burn value multiplied by the exact fraction of the area of
+ * each pixel covered by the polygon (with MERGE_ALG=REPLACE, pixels not
+ * covered are left unchanged). Not compatible with ALL_TOUCHED and
+ * BURN_VALUE_FROM. Defaults to NO.</li>
  * </ul>
  *
  * @param pfnProgress the progress function to report completion.
@@ -1888,8 +2359,10 @@ CPLErr GDALRasterizeLayersBuf(
     GDALBurnValueSrc eBurnValueSource = GBV_UserBurnValue;
     GDALRasterMergeAlg eMergeAlg = GRMA_Replace;
     GDALRasterizeOptim eOptim = GRO_Auto;
+    bool bCoverageFraction = false;
     if (GDALRasterizeOptions(papszOptions, &bAllTouched, &eBurnValueSource,
-                             &eMergeAlg, &eOptim) == CE_Failure)
+                             &eMergeAlg, &eOptim,
+                             &bCoverageFraction) == CE_Failure)
     {
         return CE_Failure;
     }
@@ -1982,9 +2455,9 @@ CPLErr GDALRasterizeLayersBuf(
 
             gv_rasterize_one_shape(
                 static_cast<unsigned char *>(pData), 0, 0, nBufXSize, nBufYSize,
-                1, eBufType, nPixelSpace, nLineSpace, 0, bAllTouched, poGeom,
-                GDT_Float64, &dfBurnValue, nullptr, eBurnValueSource, eMergeAlg,
-                pfnTransformer, pTransformArg);
+                1, eBufType, nPixelSpace, nLineSpace, 0, bAllTouched,
+                bCoverageFraction, poGeom, GDT_Float64, &dfBurnValue, nullptr,
+                eBurnValueSource, eMergeAlg, pfnTransformer, pTransformArg);
         }
 
         poLayer->ResetReading();
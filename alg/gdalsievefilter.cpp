@@ -26,79 +26,349 @@
  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
  * DEALINGS IN THE SOFTWARE.
  ****************************************************************************/
-
 #include "cpl_port.h"
 #include "gdal_alg.h"
 
 #include <cstring>
 
 #include <algorithm>
-#include <cassert>
+#include <exception>
+#include <limits>
+#include <memory>
 #include <set>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
+#include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_alg_priv.h"
+#include "gdal_thread_pool.h"
 
 #define MY_MAX_INT 2147483647
 
 /*
  * General Plan
  *
- * 1) make a pass with the polygon enumerator to build up the
- *    polygon map array.  Also accumulate polygon size information.
+ * The raster is processed by stripes of lines, each stripe being split in
+ * tiles (column ranges) that can be processed by different threads.  Each
+ * tile is labelled independently with a union-find, and labels are
+ * remapped to the polygons they belong to.  Only the labels of the current
+ * stripe and of the last line of the previous one are kept in memory.
  *
- * 2) Identify the polygons that need to be merged.
+ * 1) make a pass to label the tiles, and merge the labels of connected
+ *    pixels across tile and stripe seams to build the map from labels
+ *    to polygons.  Also accumulate polygon size information.
  *
- * 3) Make a pass with the polygon enumerator.  For each "to be merged"
- *    polygon keep track of its largest neighbour.
+ * 2) Make a second pass.  For each polygon keep track of its largest
+ *    neighbour.  Ties are resolved in favour of the neighbour met first
+ *    in raster scan order, whatever the tiling.
  *
- * 4) Fix up remappings that would go to polygons smaller than the seive
- *    size.  Ensure these in term map to the largest neighbour of the
- *    "to be sieved" polygons.
+ * 3) Identify the polygons that need to be merged, and fix up remappings
+ *    that would go to polygons smaller than the sieve size.  Ensure these
+ *    in turn map to the largest neighbour of the "to be sieved" polygons.
  *
- * 5) Make another pass with the polygon enumerator. This time we remap
- *    the actual pixel values of all polygons to be merged.
+ * 4) Make a third pass, remapping the actual pixel values of all polygons
+ *    to be merged.
  */
 
+namespace
+{
+
+/************************************************************************/
+/*                          GDALSieveNeighbour                          */
+/************************************************************************/
+
+struct GDALSieveNeighbour
+{
+    int nPoly = -1;
+    // Rank of the pixel comparison where nPoly was met, in raster scan
+    // order. Used to break ties between neighbours of the same size.
+    GIntBig nRank = 0;
+};
+
+/************************************************************************/
+/*                           GDALSieveContext                           */
+/************************************************************************/
+
+struct GDALSieveContext
+{
+    int nXSize = 0;
+    int nConnectedness = 4;
+    int nTiles = 1;
+    int nLinesPerStripe = 1;
+
+    // Current stripe.
+    int nYOff = 0;
+    int nLines = 0;
+
+    // Pixel values and labels of the current stripe, preceded by the
+    // last line of the previous stripe.  Masked pixels are set to
+    // GP_NODATA_MARKER and get a -1 label.
+    std::vector<std::int64_t> anVal{};
+    std::vector<GInt32> anId{};
+
+    // Output values of the current stripe, in the third pass.
+    std::vector<std::int64_t> anOutVal{};
+
+    // Map from labels to polygons. During the first pass, this is the
+    // union-find parent array of the labels.
+    std::vector<GInt32> anLabelPoly{};
+    std::vector<std::int64_t> anPolyValue{};
+    std::vector<int> anPolySize{};
+    std::vector<GDALSieveNeighbour> asBigNeighbour{};
+};
+
+enum class GDALSieveStep
+{
+    LABEL_AND_COUNT,
+    LABEL,
+    FIND_NEIGHBOURS,
+    LABEL_AND_APPLY
+};
+
+/************************************************************************/
+/*                           GDALSieveTileJob                           */
+/************************************************************************/
+
+struct GDALSieveTileJob
+{
+    GDALSieveContext *psCtx = nullptr;
+    GDALSieveStep eStep = GDALSieveStep::LABEL;
+    int nXOff = 0;
+    int nXEnd = 0;
+    // Label offset of the tile in the current stripe.
+    GInt32 nLabelOffset = 0;
+    bool bSuccess = true;
+
+    // Local union-find of the tile.
+    std::vector<GInt32> anParent{};
+    int nLabels = 0;
+
+    // Value and size of the local labels, for LABEL_AND_COUNT.
+    std::vector<std::int64_t> anLabelValue{};
+    std::vector<int> anLabelSize{};
+
+    // Largest neighbours found in the tile, for FIND_NEIGHBOURS when
+    // there are several tiles.
+    std::unordered_map<int, GDALSieveNeighbour> oMapBigNeighbour{};
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                          GDALSieveFindRoot()                         */
+/************************************************************************/
+
+static inline GInt32 GDALSieveFindRoot(GInt32 *panParent, GInt32 nId)
+{
+    while (panParent[nId] != nId)
+    {
+        panParent[nId] = panParent[panParent[nId]];
+        nId = panParent[nId];
+    }
+    return nId;
+}
+
 /************************************************************************/
-/*                          GPMaskImageData()                           */
+/*                            GDALSieveUnion()                          */
 /*                                                                      */
-/*      Mask out image pixels to a special nodata value if the mask     */
-/*      band is zero.                                                   */
+/*      Merge the sets of two labels.  The root is always the lowest    */
+/*      label of the set, so parents are always lower than children.    */
+/*      Returns the root of the merged set, and the other former root   */
+/*      in *pnOtherRoot, or -1 if both labels were in the same set.      */
 /************************************************************************/
 
-static CPLErr GPMaskImageData(GDALRasterBandH hMaskBand, GByte *pabyMaskLine,
-                              int iY, int nXSize, std::int64_t *panImageLine)
+static inline GInt32 GDALSieveUnion(GInt32 *panParent, GInt32 nId1,
+                                    GInt32 nId2, GInt32 *pnOtherRoot)
+{
+    nId1 = GDALSieveFindRoot(panParent, nId1);
+    nId2 = GDALSieveFindRoot(panParent, nId2);
+    if (nId1 == nId2)
+    {
+        *pnOtherRoot = -1;
+        return nId1;
+    }
+    if (nId2 < nId1)
+        std::swap(nId1, nId2);
+    panParent[nId2] = nId1;
+    *pnOtherRoot = nId2;
+    return nId1;
+}
+
+/************************************************************************/
+/*                        GDALSieveCompactLabels()                      */
+/*                                                                      */
+/*      Replace each label of a union-find by the index of its set,     */
+/*      sets being numbered by increasing root.  Returns the number of  */
+/*      sets.                                                           */
+/************************************************************************/
 
+static int GDALSieveCompactLabels(GInt32 *panParent, size_t nCount)
 {
-    const CPLErr eErr = GDALRasterIO(hMaskBand, GF_Read, 0, iY, nXSize, 1,
-                                     pabyMaskLine, nXSize, 1, GDT_Byte, 0, 0);
-    if (eErr == CE_None)
+    int nSets = 0;
+    for (size_t i = 0; i < nCount; i++)
     {
-        for (int i = 0; i < nXSize; i++)
+        // Parents are lower than children, so they are already compacted.
+        if (panParent[i] == static_cast<GInt32>(i))
+            panParent[i] = nSets++;
+        else
+            panParent[i] = panParent[panParent[i]];
+    }
+    return nSets;
+}
+
+/************************************************************************/
+/*                          GDALSieveLabelTile()                        */
+/*                                                                      */
+/*      Label the connected pixels of a tile of the current stripe.     */
+/*      Labels are local to the tile for LABEL_AND_COUNT, and are       */
+/*      otherwise remapped to polygon ids.                              */
+/************************************************************************/
+
+static void GDALSieveLabelTile(GDALSieveTileJob *psJob)
+{
+    GDALSieveContext *psCtx = psJob->psCtx;
+    const int nXSize = psCtx->nXSize;
+    const int nXOff = psJob->nXOff;
+    const int nXEnd = psJob->nXEnd;
+    const bool b8Connected = psCtx->nConnectedness == 8;
+    std::vector<GInt32> &anParent = psJob->anParent;
+    anParent.clear();
+
+    for (int iLine = 1; iLine <= psCtx->nLines; iLine++)
+    {
+        const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+        const std::int64_t *panVal = psCtx->anVal.data() + nOffset;
+        const std::int64_t *panLastVal = panVal - nXSize;
+        GInt32 *panId = psCtx->anId.data() + nOffset;
+        const GInt32 *panLastId = panId - nXSize;
+        // The previous stripe is not part of the tile.
+        const bool bHasLastLine = iLine > 1;
+
+        for (int iX = nXOff; iX < nXEnd; iX++)
         {
-            if (pabyMaskLine[i] == 0)
-                panImageLine[i] = GP_NODATA_MARKER;
+            const std::int64_t nVal = panVal[iX];
+            if (nVal == GP_NODATA_MARKER)
+            {
+                panId[iX] = -1;
+                continue;
+            }
+
+            GInt32 nId = -1;
+            const auto Link = [&anParent, &nId](GInt32 nOtherId)
+            {
+                if (nId < 0)
+                {
+                    nId = nOtherId;
+                }
+                else
+                {
+                    GInt32 nUnused;
+                    nId = GDALSieveUnion(anParent.data(), nId, nOtherId,
+                                         &nUnused);
+                }
+            };
+
+            if (iX > nXOff && panVal[iX - 1] == nVal)
+                Link(panId[iX - 1]);
+            if (bHasLastLine)
+            {
+                if (panLastVal[iX] == nVal)
+                    Link(panLastId[iX]);
+                if (b8Connected && iX > nXOff && panLastVal[iX - 1] == nVal)
+                    Link(panLastId[iX - 1]);
+                if (b8Connected && iX + 1 < nXEnd &&
+                    panLastVal[iX + 1] == nVal)
+                    Link(panLastId[iX + 1]);
+            }
+            if (nId < 0)
+            {
+                nId = static_cast<GInt32>(anParent.size());
+                anParent.push_back(nId);
+            }
+            panId[iX] = nId;
         }
     }
 
-    return eErr;
+    psJob->nLabels = GDALSieveCompactLabels(anParent.data(), anParent.size());
+
+    const bool bCount = psJob->eStep == GDALSieveStep::LABEL_AND_COUNT;
+    const bool bApply = psJob->eStep == GDALSieveStep::LABEL_AND_APPLY;
+    if (bCount)
+    {
+        psJob->anLabelValue.resize(psJob->nLabels);
+        psJob->anLabelSize.assign(psJob->nLabels, 0);
+    }
+    const GInt32 *panLabelPoly =
+        psCtx->anLabelPoly.data() + psJob->nLabelOffset;
+
+    for (int iLine = 1; iLine <= psCtx->nLines; iLine++)
+    {
+        const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+        const std::int64_t *panVal = psCtx->anVal.data() + nOffset;
+        GInt32 *panId = psCtx->anId.data() + nOffset;
+        std::int64_t *panOutVal =
+            bApply ? psCtx->anOutVal.data() + nOffset - nXSize : nullptr;
+
+        for (int iX = nXOff; iX < nXEnd; iX++)
+        {
+            if (panId[iX] < 0)
+                continue;
+            const GInt32 nLabel = anParent[panId[iX]];
+            if (bCount)
+            {
+                panId[iX] = nLabel;
+                psJob->anLabelValue[nLabel] = panVal[iX];
+                if (psJob->anLabelSize[nLabel] < MY_MAX_INT)
+                    psJob->anLabelSize[nLabel]++;
+                continue;
+            }
+
+            const GInt32 nPoly = panLabelPoly[nLabel];
+            panId[iX] = nPoly;
+            if (bApply)
+            {
+                const int nBigNeighbour =
+                    psCtx->asBigNeighbour[nPoly].nPoly;
+                if (nBigNeighbour >= 0)
+                    panOutVal[iX] = psCtx->anPolyValue[nBigNeighbour];
+            }
+        }
+    }
 }
 
-// TODO: What is "eaches" supposed to be?
+/************************************************************************/
+/*                       GDALSieveUpdateNeighbour()                     */
+/*                                                                      */
+/*      Keep the largest neighbour, or the first one met among the      */
+/*      largest ones.                                                   */
+/************************************************************************/
+
+static inline void GDALSieveUpdateNeighbour(GDALSieveNeighbour &sNeighbour,
+                                            int nPoly, GIntBig nRank,
+                                            const int *panPolySize)
+{
+    if (sNeighbour.nPoly < 0 ||
+        panPolySize[sNeighbour.nPoly] < panPolySize[nPoly] ||
+        (panPolySize[sNeighbour.nPoly] == panPolySize[nPoly] &&
+         nRank < sNeighbour.nRank))
+    {
+        sNeighbour.nPoly = nPoly;
+        sNeighbour.nRank = nRank;
+    }
+}
 
 /************************************************************************/
-/*                          CompareNeighbour()                          */
+/*                       GDALSieveFindNeighbours()                      */
 /*                                                                      */
-/*      Compare two neighbouring polygons, and update eaches            */
-/*      "biggest neighbour" if the other is larger than its current     */
-/*      largest neighbour.                                              */
+/*      Compare neighbouring polygons of a tile, and update each        */
+/*      polygon's "biggest neighbour".                                  */
 /*                                                                      */
 /*      Note that this should end up with each polygon knowing the      */
 /*      id of its largest neighbour.  No attempt is made to             */
@@ -107,39 +377,236 @@ static CPLErr GPMaskImageData(GDALRasterBandH hMaskBand, GByte *pabyMaskLine,
 /*      smaller than our sieve threshold.                               */
 /************************************************************************/
 
-static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
-                                    int *panPolyIdMap,
-                                    std::int64_t * /* panPolyValue */,
-                                    const std::vector<int> &anPolySizes,
-                                    std::vector<int> &anBigNeighbour)
+static void GDALSieveFindNeighbours(GDALSieveTileJob *psJob)
+{
+    GDALSieveContext *psCtx = psJob->psCtx;
+    const int nXSize = psCtx->nXSize;
+    const bool b8Connected = psCtx->nConnectedness == 8;
+    const int *panPolySize = psCtx->anPolySize.data();
+    // With a single tile, polygons are met in raster scan order and can
+    // be updated directly.
+    const bool bDirect = psCtx->nTiles == 1;
+
+    const auto Update = [psJob, psCtx, bDirect, panPolySize](
+                            int nPoly, int nOtherPoly, GIntBig nRank)
+    {
+        GDALSieveUpdateNeighbour(bDirect ? psCtx->asBigNeighbour[nPoly]
+                                         : psJob->oMapBigNeighbour[nPoly],
+                                 nOtherPoly, nRank, panPolySize);
+    };
+
+    const auto Compare = [&Update](int nPoly, int nOtherPoly, GIntBig nRank)
+    {
+        // Nodata pixels do not belong to polygons, and cannot be
+        // neighbours to valid polygons.
+        if (nOtherPoly < 0 || nOtherPoly == nPoly)
+            return;
+        Update(nPoly, nOtherPoly, nRank);
+        Update(nOtherPoly, nPoly, nRank);
+    };
+
+    for (int iLine = 1; iLine <= psCtx->nLines; iLine++)
+    {
+        const int iY = psCtx->nYOff + iLine - 1;
+        const GInt32 *panId =
+            psCtx->anId.data() + static_cast<size_t>(iLine) * nXSize;
+        const GInt32 *panLastId = panId - nXSize;
+
+        for (int iX = psJob->nXOff; iX < psJob->nXEnd; iX++)
+        {
+            const int nPoly = panId[iX];
+            if (nPoly < 0)
+                continue;
+            const GIntBig nRank = (static_cast<GIntBig>(iY) * nXSize + iX) * 4;
+
+            if (iY > 0)
+            {
+                Compare(nPoly, panLastId[iX], nRank);
+                if (b8Connected && iX > 0)
+                    Compare(nPoly, panLastId[iX - 1], nRank + 1);
+                if (b8Connected && iX < nXSize - 1)
+                    Compare(nPoly, panLastId[iX + 1], nRank + 2);
+            }
+            if (iX > 0)
+                Compare(nPoly, panId[iX - 1], nRank + 3);
+
+            // We don't need to compare to next pixel or next line
+            // since they will be compared to us.
+        }
+    }
+}
+
+/************************************************************************/
+/*                         GDALSieveTileJobFunc()                       */
+/************************************************************************/
+
+static void GDALSieveTileJobFunc(void *pData)
+{
+    GDALSieveTileJob *psJob = static_cast<GDALSieveTileJob *>(pData);
+    try
+    {
+        if (psJob->eStep == GDALSieveStep::FIND_NEIGHBOURS)
+            GDALSieveFindNeighbours(psJob);
+        else
+            GDALSieveLabelTile(psJob);
+    }
+    catch (const std::exception &)
+    {
+        psJob->bSuccess = false;
+    }
+}
+
+/************************************************************************/
+/*                         GDALSieveReadStripe()                        */
+/*                                                                      */
+/*      Read the current stripe, masking out pixels to a special        */
+/*      nodata value if the mask band is zero.  The previous stripe     */
+/*      last line is kept.                                              */
+/************************************************************************/
+
+static CPLErr GDALSieveReadStripe(GDALRasterBandH hSrcBand,
+                                  GDALRasterBandH hMaskBand,
+                                  GDALSieveContext &sCtx,
+                                  std::vector<GByte> &abyMask)
+{
+    const int nXSize = sCtx.nXSize;
+    const size_t nPixels = static_cast<size_t>(sCtx.nLines) * nXSize;
+    if (sCtx.nYOff > 0)
+    {
+        // Keep the last line of the previous stripe, which is a full one.
+        const size_t nLastOffset =
+            static_cast<size_t>(sCtx.nLinesPerStripe) * nXSize;
+        memmove(sCtx.anVal.data(), sCtx.anVal.data() + nLastOffset,
+                sizeof(std::int64_t) * nXSize);
+        memmove(sCtx.anId.data(), sCtx.anId.data() + nLastOffset,
+                sizeof(GInt32) * nXSize);
+    }
+
+    std::int64_t *panVal = sCtx.anVal.data() + nXSize;
+    CPLErr eErr = GDALRasterIO(hSrcBand, GF_Read, 0, sCtx.nYOff, nXSize,
+                               sCtx.nLines, panVal, nXSize, sCtx.nLines,
+                               GDT_Int64, 0, 0);
+    if (eErr == CE_None && !sCtx.anOutVal.empty())
+        memcpy(sCtx.anOutVal.data(), panVal, sizeof(std::int64_t) * nPixels);
+
+    if (eErr == CE_None && hMaskBand != nullptr)
+    {
+        eErr = GDALRasterIO(hMaskBand, GF_Read, 0, sCtx.nYOff, nXSize,
+                            sCtx.nLines, abyMask.data(), nXSize, sCtx.nLines,
+                            GDT_Byte, 0, 0);
+        if (eErr == CE_None)
+        {
+            for (size_t i = 0; i < nPixels; i++)
+            {
+                if (abyMask[i] == 0)
+                    panVal[i] = GP_NODATA_MARKER;
+            }
+        }
+    }
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                       GDALSieveMergeLabels()                         */
+/*                                                                      */
+/*      Add the labels of the tiles of the current stripe to the        */
+/*      union-find, and merge labels of connected pixels across tile    */
+/*      and stripe seams.                                               */
+/************************************************************************/
 
+static bool GDALSieveMergeLabels(GDALSieveContext &sCtx,
+                                 std::vector<GDALSieveTileJob> &asJobs,
+                                 std::vector<GInt32> &anTileLabelOffset)
 {
-    // Nodata polygon do not need neighbours, and cannot be neighbours
-    // to valid polygons.
-    if (nPolyId1 < 0 || nPolyId2 < 0)
-        return;
-
-    // Make sure we are working with the final merged polygon ids.
-    nPolyId1 = panPolyIdMap[nPolyId1];
-    nPolyId2 = panPolyIdMap[nPolyId2];
-
-    if (nPolyId1 == nPolyId2)
-        return;
-
-    // Nodata polygon do not need neighbours, and cannot be neighbours
-    // to valid polygons.
-    // Should no longer happen with r28826 optimization.
-    // if( panPolyValue[nPolyId1] == GP_NODATA_MARKER
-    //    || panPolyValue[nPolyId2] == GP_NODATA_MARKER )
-    //    return;
-
-    if (anBigNeighbour[nPolyId1] == -1 ||
-        anPolySizes[anBigNeighbour[nPolyId1]] < anPolySizes[nPolyId2])
-        anBigNeighbour[nPolyId1] = nPolyId2;
-
-    if (anBigNeighbour[nPolyId2] == -1 ||
-        anPolySizes[anBigNeighbour[nPolyId2]] < anPolySizes[nPolyId1])
-        anBigNeighbour[nPolyId2] = nPolyId1;
+    const int nXSize = sCtx.nXSize;
+    std::vector<GInt32> &anParent = sCtx.anLabelPoly;
+    for (auto &sJob : asJobs)
+    {
+        if (sJob.nLabels >
+            std::numeric_limits<int>::max() - static_cast<int>(anParent.size()))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "GDALSieveFilter(): maximum number of polygons reached");
+            return false;
+        }
+        const GInt32 nLabelOffset = static_cast<GInt32>(anParent.size());
+        anTileLabelOffset.push_back(nLabelOffset);
+        for (int i = 0; i < sJob.nLabels; i++)
+            anParent.push_back(nLabelOffset + i);
+        sCtx.anPolyValue.insert(sCtx.anPolyValue.end(),
+                                sJob.anLabelValue.begin(),
+                                sJob.anLabelValue.end());
+        sCtx.anPolySize.insert(sCtx.anPolySize.end(), sJob.anLabelSize.begin(),
+                               sJob.anLabelSize.end());
+
+        for (int iLine = 1; iLine <= sCtx.nLines; iLine++)
+        {
+            GInt32 *panId =
+                sCtx.anId.data() + static_cast<size_t>(iLine) * nXSize;
+            for (int iX = sJob.nXOff; iX < sJob.nXEnd; iX++)
+            {
+                if (panId[iX] >= 0)
+                    panId[iX] += nLabelOffset;
+            }
+        }
+    }
+
+    const auto Merge = [&sCtx, &anParent](GInt32 nId1, GInt32 nId2)
+    {
+        GInt32 nOtherRoot;
+        const GInt32 nRoot =
+            GDALSieveUnion(anParent.data(), nId1, nId2, &nOtherRoot);
+        if (nOtherRoot >= 0)
+        {
+            sCtx.anPolySize[nRoot] = static_cast<int>(
+                std::min<GIntBig>(MY_MAX_INT,
+                                  static_cast<GIntBig>(sCtx.anPolySize[nRoot]) +
+                                      sCtx.anPolySize[nOtherRoot]));
+        }
+    };
+
+    const auto MergeIfConnected =
+        [&sCtx, &Merge](size_t nOffset1, size_t nOffset2)
+    {
+        if (sCtx.anId[nOffset1] >= 0 &&
+            sCtx.anVal[nOffset1] == sCtx.anVal[nOffset2] &&
+            sCtx.anId[nOffset2] >= 0)
+        {
+            Merge(sCtx.anId[nOffset1], sCtx.anId[nOffset2]);
+        }
+    };
+
+    const bool b8Connected = sCtx.nConnectedness == 8;
+    for (int iLine = 1; iLine <= sCtx.nLines; iLine++)
+    {
+        const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+        // Seam with the previous stripe, or between tiles.
+        if (iLine == 1 && sCtx.nYOff > 0)
+        {
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                MergeIfConnected(nOffset + iX, nOffset + iX - nXSize);
+                if (b8Connected && iX > 0)
+                    MergeIfConnected(nOffset + iX, nOffset + iX - 1 - nXSize);
+                if (b8Connected && iX < nXSize - 1)
+                    MergeIfConnected(nOffset + iX, nOffset + iX + 1 - nXSize);
+            }
+        }
+        for (size_t iTile = 1; iTile < asJobs.size(); iTile++)
+        {
+            const size_t nRight = nOffset + asJobs[iTile].nXOff;
+            const size_t nLeft = nRight - 1;
+            MergeIfConnected(nRight, nLeft);
+            if (b8Connected && iLine > 1)
+            {
+                MergeIfConnected(nRight, nLeft - nXSize);
+                MergeIfConnected(nLeft, nRight - nXSize);
+            }
+        }
+    }
+
+    return true;
 }
 
 /************************************************************************/
@@ -166,12 +633,14 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
  * will therefore not be altered.
  *
  * The algorithm makes three passes over the input file to enumerate the
- * polygons and collect limited information about them.  Memory use is
- * proportional to the number of polygons (roughly 24 bytes per polygon), but
- * is not directly related to the size of the raster.  So very large raster
- * files can be processed effectively if there aren't too many polygons.  But
- * extremely noisy rasters with many one pixel polygons will end up being
- * expensive (in memory) to process.
+ * polygons and collect limited information about them.  The raster is
+ * processed by stripes of lines, whose tiles are labelled independently and
+ * can be processed by several threads.  Memory use is proportional to the
+ * number of polygons (roughly 40 bytes per polygon, and 4 bytes per polygon
+ * fragment in a tile), but is not directly related to the size of the
+ * raster.  So very large raster files can be processed effectively if there
+ * aren't too many polygons.  But extremely noisy rasters with many one pixel
+ * polygons will end up being expensive (in memory) to process.
  *
  * @param hSrcBand the source raster band to be processed.
  * @param hMaskBand an optional mask band.  All pixels in the mask band with a
@@ -183,8 +652,14 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
  * @param nConnectedness either 4 indicating that diagonal pixels are not
  * considered directly adjacent for polygon membership purposes or 8
  * indicating they are.
- * @param papszOptions algorithm options in name=value list form.  None
- * currently supported.
+ * @param papszOptions algorithm options in name=value list form.
+ * The following options are supported:
+ * <ul>
+ * <li>NUM_THREADS=N|ALL_CPUS: (GDAL >= 3.9) Number of worker threads used
+ * to process the tiles of each stripe. Defaults to the value of the
+ * GDAL_NUM_THREADS configuration option, or 1. The result does not depend
+ * on the number of threads.</li>
+ * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
  * @param pProgressArg callback argument passed to pfnProgress.
@@ -195,8 +670,7 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
 CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
                                    GDALRasterBandH hMaskBand,
                                    GDALRasterBandH hDstBand, int nSizeThreshold,
-                                   int nConnectedness,
-                                   CPL_UNUSED char **papszOptions,
+                                   int nConnectedness, char **papszOptions,
                                    GDALProgressFunc pfnProgress,
                                    void *pProgressArg)
 {
@@ -206,436 +680,309 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
     if (pfnProgress == nullptr)
         pfnProgress = GDALDummyProgress;
 
-    /* -------------------------------------------------------------------- */
-    /*      Allocate working buffers.                                       */
-    /* -------------------------------------------------------------------- */
-    int nXSize = GDALGetRasterBandXSize(hSrcBand);
-    int nYSize = GDALGetRasterBandYSize(hSrcBand);
-    auto *panLastLineVal = static_cast<std::int64_t *>(
-        VSI_MALLOC2_VERBOSE(sizeof(std::int64_t), nXSize));
-    auto *panThisLineVal = static_cast<std::int64_t *>(
-        VSI_MALLOC2_VERBOSE(sizeof(std::int64_t), nXSize));
-    auto *panLastLineId =
-        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
-    auto *panThisLineId =
-        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
-    auto *panThisLineWriteVal = static_cast<std::int64_t *>(
-        VSI_MALLOC2_VERBOSE(sizeof(std::int64_t), nXSize));
-    GByte *pabyMaskLine = hMaskBand != nullptr
-                              ? static_cast<GByte *>(VSI_MALLOC_VERBOSE(nXSize))
-                              : nullptr;
-    if (panLastLineVal == nullptr || panThisLineVal == nullptr ||
-        panLastLineId == nullptr || panThisLineId == nullptr ||
-        panThisLineWriteVal == nullptr ||
-        (hMaskBand != nullptr && pabyMaskLine == nullptr))
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+
+    const char *pszNumThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszNumThreads == nullptr)
+        pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    int nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+    nThreads = std::max(1, std::min(128, nThreads));
+
+    // Stripes of about 4 M pixels. The config option is only for testing.
+    int nLinesPerStripe = std::max(
+        1, atoi(CPLGetConfigOption(
+               "GDAL_SIEVE_STRIPE_HEIGHT",
+               CPLSPrintf("%d", 4 * 1024 * 1024 / std::max(1, nXSize)))));
+    nLinesPerStripe =
+        std::max(1, std::min(nLinesPerStripe,
+                             std::numeric_limits<int>::max() / 2 /
+                                 std::max(1, nXSize)));
+    nLinesPerStripe = std::min(nLinesPerStripe, std::max(1, nYSize));
+
+    // Tiles of at least 64 columns.
+    const int nTileWidth = std::max(
+        64, static_cast<int>((static_cast<GIntBig>(nXSize) + nThreads - 1) /
+                             nThreads));
+    const int nTiles = std::max(
+        1, static_cast<int>((static_cast<GIntBig>(nXSize) + nTileWidth - 1) /
+                            nTileWidth));
+
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if (nThreads > 1 && nTiles > 1)
     {
-        CPLFree(panThisLineId);
-        CPLFree(panLastLineId);
-        CPLFree(panThisLineVal);
-        CPLFree(panLastLineVal);
-        CPLFree(panThisLineWriteVal);
-        CPLFree(pabyMaskLine);
-        return CE_Failure;
+        CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+        if (poThreadPool)
+            poJobQueue = poThreadPool->CreateJobQueue();
     }
 
-    /* -------------------------------------------------------------------- */
-    /*      The first pass over the raster is only used to build up the     */
-    /*      polygon id map so we will know in advance what polygons are     */
-    /*      what on the second pass.                                        */
-    /* -------------------------------------------------------------------- */
-    GDALRasterPolygonEnumerator oFirstEnum(nConnectedness);
-    std::vector<int> anPolySizes;
-
     CPLErr eErr = CE_None;
-    for (int iY = 0; eErr == CE_None && iY < nYSize; iY++)
+    try
     {
-        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iY, nXSize, 1, panThisLineVal,
-                            nXSize, 1, GDT_Int64, 0, 0);
-
-        if (eErr == CE_None && hMaskBand != nullptr)
-            eErr = GPMaskImageData(hMaskBand, pabyMaskLine, iY, nXSize,
-                                   panThisLineVal);
-        if (eErr != CE_None)
-            break;
-
-        if (iY == 0)
-            eErr = oFirstEnum.ProcessLine(nullptr, panThisLineVal, nullptr,
-                                          panThisLineId, nXSize)
-                       ? CE_None
-                       : CE_Failure;
-        else
-            eErr = oFirstEnum.ProcessLine(panLastLineVal, panThisLineVal,
-                                          panLastLineId, panThisLineId, nXSize)
-                       ? CE_None
-                       : CE_Failure;
-        if (eErr != CE_None)
-            break;
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Accumulate polygon sizes. */
-        /* --------------------------------------------------------------------
-         */
-        if (oFirstEnum.nNextPolygonId > static_cast<int>(anPolySizes.size()))
-            anPolySizes.resize(oFirstEnum.nNextPolygonId);
-
-        for (int iX = 0; iX < nXSize; iX++)
+        GDALSieveContext sCtx;
+        sCtx.nXSize = nXSize;
+        sCtx.nConnectedness = nConnectedness;
+        sCtx.nTiles = nTiles;
+        sCtx.nLinesPerStripe = nLinesPerStripe;
+        const size_t nStripePixels =
+            static_cast<size_t>(nLinesPerStripe) * nXSize;
+        sCtx.anVal.resize(nStripePixels + nXSize);
+        sCtx.anId.resize(nStripePixels + nXSize);
+        std::vector<GByte> abyMask;
+        if (hMaskBand != nullptr)
+            abyMask.resize(nStripePixels);
+
+        std::vector<GDALSieveTileJob> asJobs(nTiles);
+        for (int iTile = 0; iTile < nTiles; iTile++)
         {
-            const int iPoly = panThisLineId[iX];
-
-            if (iPoly >= 0 && anPolySizes[iPoly] < MY_MAX_INT)
-                anPolySizes[iPoly] += 1;
+            asJobs[iTile].psCtx = &sCtx;
+            asJobs[iTile].nXOff = iTile * nTileWidth;
+            asJobs[iTile].nXEnd = std::min(nXSize, (iTile + 1) * nTileWidth);
         }
+        // Label offsets of the stripe tiles, computed in the first pass.
+        std::vector<GInt32> anTileLabelOffset;
 
-        /* --------------------------------------------------------------------
-         */
-        /*      swap this/last lines. */
-        /* --------------------------------------------------------------------
-         */
-        std::swap(panLastLineVal, panThisLineVal);
-        std::swap(panLastLineId, panThisLineId);
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Report progress, and support interrupts. */
-        /* --------------------------------------------------------------------
-         */
-        if (!pfnProgress(0.25 * ((iY + 1) / static_cast<double>(nYSize)), "",
-                         pProgressArg))
+        const auto RunJobs = [&asJobs, &poJobQueue](GDALSieveStep eStep,
+                                                    const GInt32 *panOffsets)
         {
-            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-            eErr = CE_Failure;
-        }
-    }
+            for (size_t i = 0; i < asJobs.size(); i++)
+            {
+                asJobs[i].eStep = eStep;
+                if (panOffsets)
+                    asJobs[i].nLabelOffset = panOffsets[i];
+            }
+            for (size_t i = 1; i < asJobs.size(); i++)
+            {
+                if (!poJobQueue ||
+                    !poJobQueue->SubmitJob(GDALSieveTileJobFunc, &asJobs[i]))
+                {
+                    GDALSieveTileJobFunc(&asJobs[i]);
+                }
+            }
+            GDALSieveTileJobFunc(&asJobs[0]);
+            if (poJobQueue)
+                poJobQueue->WaitCompletion();
+            bool bSuccess = true;
+            for (auto &sJob : asJobs)
+            {
+                bSuccess &= sJob.bSuccess;
+                sJob.bSuccess = true;
+            }
+            if (!bSuccess)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "GDALSieveFilter(): out of memory");
+            }
+            return bSuccess;
+        };
 
-    /* -------------------------------------------------------------------- */
-    /*      Make a pass through the maps, ensuring every polygon id         */
-    /*      points to the final id it should use, not an intermediate       */
-    /*      value.                                                          */
-    /* -------------------------------------------------------------------- */
-    if (eErr == CE_None)
-        oFirstEnum.CompleteMerges();
-
-    /* -------------------------------------------------------------------- */
-    /*      Push the sizes of merged polygon fragments into the             */
-    /*      merged polygon id's count.                                      */
-    /* -------------------------------------------------------------------- */
-    assert(oFirstEnum.panPolyIdMap != nullptr);  // for Coverity
-    assert(oFirstEnum.panPolyValue != nullptr);  // for Coverity
-    for (int iPoly = 0; iPoly < oFirstEnum.nNextPolygonId; iPoly++)
-    {
-        if (oFirstEnum.panPolyIdMap[iPoly] != iPoly)
+        const auto ReportProgress =
+            [pfnProgress, pProgressArg, nYSize, &sCtx](double dfStart,
+                                                       double dfScale)
         {
-            GIntBig nSize = anPolySizes[oFirstEnum.panPolyIdMap[iPoly]];
-
-            nSize += anPolySizes[iPoly];
-
-            if (nSize > MY_MAX_INT)
-                nSize = MY_MAX_INT;
-
-            anPolySizes[oFirstEnum.panPolyIdMap[iPoly]] =
-                static_cast<int>(nSize);
-            anPolySizes[iPoly] = 0;
-        }
-    }
-
-    /* -------------------------------------------------------------------- */
-    /*      We will use a new enumerator for the second pass primarily      */
-    /*      so we can preserve the first pass map.                          */
-    /* -------------------------------------------------------------------- */
-    GDALRasterPolygonEnumerator oSecondEnum(nConnectedness);
-
-    std::vector<int> anBigNeighbour;
-    anBigNeighbour.resize(anPolySizes.size());
-
-    for (int iPoly = 0; iPoly < static_cast<int>(anPolySizes.size()); iPoly++)
-        anBigNeighbour[iPoly] = -1;
-
-    /* ==================================================================== */
-    /*      Second pass ... identify the largest neighbour for each         */
-    /*      polygon.                                                        */
-    /* ==================================================================== */
-    for (int iY = 0; eErr == CE_None && iY < nYSize; iY++)
-    {
-        /* --------------------------------------------------------------------
-         */
-        /*      Read the image data. */
-        /* --------------------------------------------------------------------
-         */
-        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iY, nXSize, 1, panThisLineVal,
-                            nXSize, 1, GDT_Int64, 0, 0);
-
-        if (eErr == CE_None && hMaskBand != nullptr)
-            eErr = GPMaskImageData(hMaskBand, pabyMaskLine, iY, nXSize,
-                                   panThisLineVal);
-
-        if (eErr != CE_None)
-            continue;
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Determine what polygon the various pixels belong to (redoing */
-        /*      the same thing done in the first pass above). */
-        /* --------------------------------------------------------------------
-         */
-        if (iY == 0)
-            eErr = oSecondEnum.ProcessLine(nullptr, panThisLineVal, nullptr,
-                                           panThisLineId, nXSize)
-                       ? CE_None
-                       : CE_Failure;
-        else
-            eErr = oSecondEnum.ProcessLine(panLastLineVal, panThisLineVal,
-                                           panLastLineId, panThisLineId, nXSize)
-                       ? CE_None
-                       : CE_Failure;
-
-        if (eErr != CE_None)
-            continue;
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Check our neighbours, and update our biggest neighbour map */
-        /*      as appropriate. */
-        /* --------------------------------------------------------------------
-         */
-        for (int iX = 0; iX < nXSize; iX++)
+            if (!pfnProgress(dfStart + dfScale * (sCtx.nYOff + sCtx.nLines) /
+                                           static_cast<double>(nYSize),
+                             "", pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                return false;
+            }
+            return true;
+        };
+
+        /* ================================================================ */
+        /*      First pass: label the tiles, merge labels across seams      */
+        /*      and accumulate polygon sizes.                               */
+        /* ================================================================ */
+        for (sCtx.nYOff = 0; eErr == CE_None && sCtx.nYOff < nYSize;
+             sCtx.nYOff += nLinesPerStripe)
         {
-            if (iY > 0)
+            sCtx.nLines = std::min(nLinesPerStripe, nYSize - sCtx.nYOff);
+            eErr = GDALSieveReadStripe(hSrcBand, hMaskBand, sCtx, abyMask);
+            if (eErr == CE_None &&
+                (!RunJobs(GDALSieveStep::LABEL_AND_COUNT, nullptr) ||
+                 !GDALSieveMergeLabels(sCtx, asJobs, anTileLabelOffset) ||
+                 !ReportProgress(0, 0.25)))
             {
-                CompareNeighbour(panThisLineId[iX], panLastLineId[iX],
-                                 oFirstEnum.panPolyIdMap,
-                                 oFirstEnum.panPolyValue, anPolySizes,
-                                 anBigNeighbour);
-
-                if (iX > 0 && nConnectedness == 8)
-                    CompareNeighbour(panThisLineId[iX], panLastLineId[iX - 1],
-                                     oFirstEnum.panPolyIdMap,
-                                     oFirstEnum.panPolyValue, anPolySizes,
-                                     anBigNeighbour);
-
-                if (iX < nXSize - 1 && nConnectedness == 8)
-                    CompareNeighbour(panThisLineId[iX], panLastLineId[iX + 1],
-                                     oFirstEnum.panPolyIdMap,
-                                     oFirstEnum.panPolyValue, anPolySizes,
-                                     anBigNeighbour);
+                eErr = CE_Failure;
             }
-
-            if (iX > 0)
-                CompareNeighbour(panThisLineId[iX], panThisLineId[iX - 1],
-                                 oFirstEnum.panPolyIdMap,
-                                 oFirstEnum.panPolyValue, anPolySizes,
-                                 anBigNeighbour);
-
-            // We don't need to compare to next pixel or next line
-            // since they will be compared to us.
         }
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Swap pixel value, and polygon id lines to be ready for the */
-        /*      next line. */
-        /* --------------------------------------------------------------------
-         */
-        std::swap(panLastLineVal, panThisLineVal);
-        std::swap(panLastLineId, panThisLineId);
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Report progress, and support interrupts. */
-        /* --------------------------------------------------------------------
-         */
-        if (!pfnProgress(0.25 + 0.25 * ((iY + 1) / static_cast<double>(nYSize)),
-                         "", pProgressArg))
+        /* ---------------------------------------------------------------- */
+        /*      Map each label to its final polygon id, and compact the     */
+        /*      polygon values and sizes.                                   */
+        /* ---------------------------------------------------------------- */
+        const int nPolys = GDALSieveCompactLabels(sCtx.anLabelPoly.data(),
+                                                  sCtx.anLabelPoly.size());
         {
-            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-            eErr = CE_Failure;
+            int iPoly = 0;
+            for (size_t i = 0; i < sCtx.anLabelPoly.size(); i++)
+            {
+                if (sCtx.anLabelPoly[i] == iPoly)
+                {
+                    sCtx.anPolyValue[iPoly] = sCtx.anPolyValue[i];
+                    sCtx.anPolySize[iPoly] = sCtx.anPolySize[i];
+                    iPoly++;
+                }
+            }
         }
-    }
-
-    /* -------------------------------------------------------------------- */
-    /*      If our biggest neighbour is still smaller than the              */
-    /*      threshold, then try tracking to that polygons biggest           */
-    /*      neighbour, and so forth.                                        */
-    /* -------------------------------------------------------------------- */
-    int nFailedMerges = 0;
-    int nIsolatedSmall = 0;
-    int nSieveTargets = 0;
-
-    for (int iPoly = 0; iPoly < static_cast<int>(anPolySizes.size()); iPoly++)
-    {
-        if (oFirstEnum.panPolyIdMap[iPoly] != iPoly)
-            continue;
-
-        // Ignore nodata polygons.
-        if (oFirstEnum.panPolyValue[iPoly] == GP_NODATA_MARKER)
-            continue;
-
-        // Don't try to merge polygons larger than the threshold.
-        if (anPolySizes[iPoly] >= nSizeThreshold)
+        sCtx.anPolyValue.resize(nPolys);
+        sCtx.anPolyValue.shrink_to_fit();
+        sCtx.anPolySize.resize(nPolys);
+        sCtx.anPolySize.shrink_to_fit();
+        sCtx.asBigNeighbour.resize(nPolys);
+
+        CPLDebug("GDALSieveFilter",
+                 "Counted " CPL_FRMT_GUIB " polygon fragments forming %d "
+                 "final polygons.",
+                 static_cast<GUIntBig>(sCtx.anLabelPoly.size()), nPolys);
+
+        /* ================================================================ */
+        /*      Second pass ... identify the largest neighbour for each     */
+        /*      polygon.                                                    */
+        /* ================================================================ */
+        for (sCtx.nYOff = 0; eErr == CE_None && sCtx.nYOff < nYSize;
+             sCtx.nYOff += nLinesPerStripe)
         {
-            anBigNeighbour[iPoly] = -1;
-            continue;
-        }
+            sCtx.nLines = std::min(nLinesPerStripe, nYSize - sCtx.nYOff);
+            const GInt32 *panOffsets =
+                anTileLabelOffset.data() +
+                static_cast<size_t>(sCtx.nYOff / nLinesPerStripe) * nTiles;
+            eErr = GDALSieveReadStripe(hSrcBand, hMaskBand, sCtx, abyMask);
+            if (eErr == CE_None &&
+                (!RunJobs(GDALSieveStep::LABEL, panOffsets) ||
+                 !RunJobs(GDALSieveStep::FIND_NEIGHBOURS, nullptr)))
+            {
+                eErr = CE_Failure;
+            }
 
-        nSieveTargets++;
+            // Merge the neighbours found in each tile.
+            for (auto &sJob : asJobs)
+            {
+                for (const auto &oIter : sJob.oMapBigNeighbour)
+                {
+                    GDALSieveUpdateNeighbour(
+                        sCtx.asBigNeighbour[oIter.first], oIter.second.nPoly,
+                        oIter.second.nRank, sCtx.anPolySize.data());
+                }
+                sJob.oMapBigNeighbour.clear();
+            }
 
-        // if we have no neighbours but we are small, what shall we do?
-        if (anBigNeighbour[iPoly] == -1)
-        {
-            nIsolatedSmall++;
-            continue;
+            if (eErr == CE_None && !ReportProgress(0.25, 0.25))
+                eErr = CE_Failure;
         }
 
-        std::set<int> oSetVisitedPoly;
-        oSetVisitedPoly.insert(iPoly);
+        /* ---------------------------------------------------------------- */
+        /*      If our biggest neighbour is still smaller than the          */
+        /*      threshold, then try tracking to that polygons biggest       */
+        /*      neighbour, and so forth.                                    */
+        /* ---------------------------------------------------------------- */
+        int nFailedMerges = 0;
+        int nIsolatedSmall = 0;
+        int nSieveTargets = 0;
 
-        // Walk through our neighbours until we find a polygon large enough.
-        int iFinalId = iPoly;
-        bool bFoundBigEnoughPoly = false;
-        while (true)
+        for (int iPoly = 0; eErr == CE_None && iPoly < nPolys; iPoly++)
         {
-            iFinalId = anBigNeighbour[iFinalId];
-            if (iFinalId < 0)
-            {
-                break;
-            }
-            // If the biggest neighbour is larger than the threshold
-            // then we are golden.
-            if (anPolySizes[iFinalId] >= nSizeThreshold)
+            // Don't try to merge polygons larger than the threshold.
+            if (sCtx.anPolySize[iPoly] >= nSizeThreshold)
             {
-                bFoundBigEnoughPoly = true;
-                break;
+                sCtx.asBigNeighbour[iPoly].nPoly = -1;
+                continue;
             }
-            // Check that we don't cycle on an already visited polygon.
-            if (oSetVisitedPoly.find(iFinalId) != oSetVisitedPoly.end())
-                break;
-            oSetVisitedPoly.insert(iFinalId);
-        }
 
-        if (!bFoundBigEnoughPoly)
-        {
-            nFailedMerges++;
-            anBigNeighbour[iPoly] = -1;
-            continue;
-        }
-
-        // Map the whole intermediate chain to it.
-        int iPolyCur = iPoly;
-        while (anBigNeighbour[iPolyCur] != iFinalId)
-        {
-            int iNextPoly = anBigNeighbour[iPolyCur];
-            anBigNeighbour[iPolyCur] = iFinalId;
-            iPolyCur = iNextPoly;
-        }
-    }
+            nSieveTargets++;
 
-    CPLDebug("GDALSieveFilter",
-             "Small Polygons: %d, Isolated: %d, Unmergable: %d", nSieveTargets,
-             nIsolatedSmall, nFailedMerges);
+            // if we have no neighbours but we are small, what shall we do?
+            if (sCtx.asBigNeighbour[iPoly].nPoly == -1)
+            {
+                nIsolatedSmall++;
+                continue;
+            }
 
-    /* ==================================================================== */
-    /*      Make a third pass over the image, actually applying the         */
-    /*      merges.  We reuse the second enumerator but preserve the        */
-    /*      "final maps" from the first.                                    */
-    /* ==================================================================== */
-    oSecondEnum.Clear();
+            std::set<int> oSetVisitedPoly;
+            oSetVisitedPoly.insert(iPoly);
 
-    for (int iY = 0; oFirstEnum.panPolyIdMap != nullptr &&  // for Coverity
-                     eErr == CE_None && iY < nYSize;
-         iY++)
-    {
-        /* --------------------------------------------------------------------
-         */
-        /*      Read the image data. */
-        /* --------------------------------------------------------------------
-         */
-        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iY, nXSize, 1, panThisLineVal,
-                            nXSize, 1, GDT_Int64, 0, 0);
-
-        memcpy(panThisLineWriteVal, panThisLineVal,
-               sizeof(panThisLineVal[0]) * nXSize);
-
-        if (eErr == CE_None && hMaskBand != nullptr)
-            eErr = GPMaskImageData(hMaskBand, pabyMaskLine, iY, nXSize,
-                                   panThisLineVal);
-
-        if (eErr != CE_None)
-            continue;
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Determine what polygon the various pixels belong to (redoing */
-        /*      the same thing done in the first pass above). */
-        /* --------------------------------------------------------------------
-         */
-        if (iY == 0)
-            oSecondEnum.ProcessLine(nullptr, panThisLineVal, nullptr,
-                                    panThisLineId, nXSize);
-        else
-            oSecondEnum.ProcessLine(panLastLineVal, panThisLineVal,
-                                    panLastLineId, panThisLineId, nXSize);
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Reprocess the actual pixel values according to the polygon */
-        /*      merging, and write out this line of image data. */
-        /* --------------------------------------------------------------------
-         */
-        for (int iX = 0; iX < nXSize; iX++)
-        {
-            int iThisPoly = panThisLineId[iX];
-            if (iThisPoly >= 0)
+            // Walk through our neighbours until we find a polygon large
+            // enough.
+            int iFinalId = iPoly;
+            bool bFoundBigEnoughPoly = false;
+            while (true)
             {
-                iThisPoly = oFirstEnum.panPolyIdMap[iThisPoly];
-
-                if (anBigNeighbour[iThisPoly] != -1)
+                iFinalId = sCtx.asBigNeighbour[iFinalId].nPoly;
+                if (iFinalId < 0)
                 {
-                    panThisLineWriteVal[iX] =
-                        oFirstEnum.panPolyValue[anBigNeighbour[iThisPoly]];
+                    break;
                 }
+                // If the biggest neighbour is larger than the threshold
+                // then we are golden.
+                if (sCtx.anPolySize[iFinalId] >= nSizeThreshold)
+                {
+                    bFoundBigEnoughPoly = true;
+                    break;
+                }
+                // Check that we don't cycle on an already visited polygon.
+                if (oSetVisitedPoly.find(iFinalId) != oSetVisitedPoly.end())
+                    break;
+                oSetVisitedPoly.insert(iFinalId);
+            }
+
+            if (!bFoundBigEnoughPoly)
+            {
+                nFailedMerges++;
+                sCtx.asBigNeighbour[iPoly].nPoly = -1;
+                continue;
+            }
+
+            // Map the whole intermediate chain to it.
+            int iPolyCur = iPoly;
+            while (sCtx.asBigNeighbour[iPolyCur].nPoly != iFinalId)
+            {
+                int iNextPoly = sCtx.asBigNeighbour[iPolyCur].nPoly;
+                sCtx.asBigNeighbour[iPolyCur].nPoly = iFinalId;
+                iPolyCur = iNextPoly;
             }
         }
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Write the update data out. */
-        /* --------------------------------------------------------------------
-         */
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, iY, nXSize, 1,
-                            panThisLineWriteVal, nXSize, 1, GDT_Int64, 0, 0);
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Swap pixel value, and polygon id lines to be ready for the */
-        /*      next line. */
-        /* --------------------------------------------------------------------
-         */
-        std::swap(panLastLineVal, panThisLineVal);
-        std::swap(panLastLineId, panThisLineId);
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Report progress, and support interrupts. */
-        /* --------------------------------------------------------------------
-         */
-        if (eErr == CE_None &&
-            !pfnProgress(0.5 + 0.5 * ((iY + 1) / static_cast<double>(nYSize)),
-                         "", pProgressArg))
+        CPLDebug("GDALSieveFilter",
+                 "Small Polygons: %d, Isolated: %d, Unmergable: %d",
+                 nSieveTargets, nIsolatedSmall, nFailedMerges);
+
+        /* ================================================================ */
+        /*      Make a third pass over the image, actually applying the     */
+        /*      merges.                                                     */
+        /* ================================================================ */
+        if (eErr == CE_None)
+            sCtx.anOutVal.resize(nStripePixels);
+        for (sCtx.nYOff = 0; eErr == CE_None && sCtx.nYOff < nYSize;
+             sCtx.nYOff += nLinesPerStripe)
         {
-            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-            eErr = CE_Failure;
+            sCtx.nLines = std::min(nLinesPerStripe, nYSize - sCtx.nYOff);
+            const GInt32 *panOffsets =
+                anTileLabelOffset.data() +
+                static_cast<size_t>(sCtx.nYOff / nLinesPerStripe) * nTiles;
+            eErr = GDALSieveReadStripe(hSrcBand, hMaskBand, sCtx, abyMask);
+            if (eErr == CE_None &&
+                !RunJobs(GDALSieveStep::LABEL_AND_APPLY, panOffsets))
+            {
+                eErr = CE_Failure;
+            }
+
+            if (eErr == CE_None)
+                eErr = GDALRasterIO(hDstBand, GF_Write, 0, sCtx.nYOff, nXSize,
+                                    sCtx.nLines, sCtx.anOutVal.data(), nXSize,
+                                    sCtx.nLines, GDT_Int64, 0, 0);
+
+            if (eErr == CE_None && !ReportProgress(0.5, 0.5))
+                eErr = CE_Failure;
         }
     }
-
-    /* -------------------------------------------------------------------- */
-    /*      Cleanup                                                         */
-    /* -------------------------------------------------------------------- */
-    CPLFree(panThisLineId);
-    CPLFree(panLastLineId);
-    CPLFree(panThisLineVal);
-    CPLFree(panLastLineVal);
-    CPLFree(panThisLineWriteVal);
-    CPLFree(pabyMaskLine);
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "GDALSieveFilter(): out of memory");
+        eErr = CE_Failure;
+    }
 
     return eErr;
 }
@@ -41,8 +41,12 @@
 #include <cstring>
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -1922,6 +1926,13 @@ static void GDALGCPAntimeridianUnwrap(int nGCPCount, GDAL_GCP *pasGCPList,
  * the backmap. The default is NO, that is to use in-memory arrays, unless the
  * number of pixels of the geolocation array is greater than 16 megapixels.
  * </li>
+ * <li> GEOLOC_BACKMAP_CACHE_DIR=directory. (GDAL &gt;= 3.9) Directory where
+ * the "backmap" of geolocation array transformers is saved as a GeoTIFF file
+ * once computed, and from which it is loaded by later transformers using the
+ * same geolocation arrays (identified by their filename, size and modification
+ * time) and parameters. Can also be set with the
+ * GDAL_GEOLOC_BACKMAP_CACHE_DIR configuration option. Not set by default.
+ * </li>
  * <li>
  * GEOLOC_ARRAY/SRC_GEOLOC_ARRAY=filename. (GDAL &gt;= 3.5.2) Name of a GDAL
  * dataset containing a geolocation array and associated metadata. This is an
@@ -3758,6 +3769,11 @@ static void *GDALDeserializeReprojectionTransformer(CPLXMLNode *psTree)
 /* ==================================================================== */
 /************************************************************************/
 
+namespace
+{
+class GDALApproxTransformerGrid;
+}
+
 typedef struct
 {
     GDALTransformerInfo sTI;
@@ -3768,8 +3784,182 @@ typedef struct
     double dfMaxErrorReverse;
 
     int bOwnSubtransformer;
+
+    // Shared with the clones of the transformer. nullptr if not enabled.
+    GDALApproxTransformerGrid *poGrid;
 } ApproxTransformInfo;
 
+namespace
+{
+
+/************************************************************************/
+/*                      GDALApproxTransformerGrid                       */
+/************************************************************************/
+
+// Cache of the exact destination to source transformations at the corners
+// of the cells of a grid in destination pixel/line space. Cells are evaluated
+// lazily, and subdivided until the bilinear interpolation of their corners is
+// within the maximum reverse error, or until they reach MIN_STEP pixels. The
+// grid is shared by an approximate transformer and its clones, so that the
+// warper threads processing neighbouring chunks do not repeat the same
+// transformations along the chunk borders.
+class GDALApproxTransformerGrid
+{
+  public:
+    enum class CellState
+    {
+        INTERPOLATE,
+        SUBDIVIDE,
+        EXACT
+    };
+
+    struct Cell
+    {
+        CellState eState = CellState::EXACT;
+        // Corners in the (x0,y0), (x1,y0), (x0,y1), (x1,y1) order.
+        double adfX[4] = {0, 0, 0, 0};
+        double adfY[4] = {0, 0, 0, 0};
+        double adfZ[4] = {0, 0, 0, 0};
+    };
+
+    static constexpr double MIN_STEP = 4.0;
+
+    explicit GDALApproxTransformerGrid(double dfStep) : m_dfStep(dfStep)
+    {
+    }
+
+    void Reference()
+    {
+        ++m_nRefCount;
+    }
+
+    void Release()
+    {
+        if (--m_nRefCount == 0)
+            delete this;
+    }
+
+    double GetStep() const
+    {
+        return m_dfStep;
+    }
+
+    const Cell *GetCell(const ApproxTransformInfo *psATInfo, int nLevel,
+                        double dfCellSize, GInt64 nCellX, GInt64 nCellY);
+
+  private:
+    struct Key
+    {
+        int nLevel;
+        GInt64 nCellX;
+        GInt64 nCellY;
+
+        bool operator==(const Key &other) const
+        {
+            return nLevel == other.nLevel && nCellX == other.nCellX &&
+                   nCellY == other.nCellY;
+        }
+    };
+
+    struct KeyHasher
+    {
+        size_t operator()(const Key &k) const
+        {
+            return std::hash<GInt64>()(k.nCellX) ^
+                   (std::hash<GInt64>()(k.nCellY) << 1) ^
+                   (static_cast<size_t>(k.nLevel) << 7);
+        }
+    };
+
+    const double m_dfStep;
+    std::atomic<int> m_nRefCount{1};
+    std::mutex m_oMutex{};
+    // Elements are never erased, and references to elements of an
+    // unordered_map remain valid after rehashing.
+    std::unordered_map<Key, Cell, KeyHasher> m_oMapCells{};
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALApproxTransformerGrid)
+};
+
+/************************************************************************/
+/*                 GDALApproxTransformerGrid::GetCell()                 */
+/************************************************************************/
+
+const GDALApproxTransformerGrid::Cell *
+GDALApproxTransformerGrid::GetCell(const ApproxTransformInfo *psATInfo,
+                                   int nLevel, double dfCellSize,
+                                   GInt64 nCellX, GInt64 nCellY)
+{
+    const Key key{nLevel, nCellX, nCellY};
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        const auto oIter = m_oMapCells.find(key);
+        if (oIter != m_oMapCells.end())
+            return &(oIter->second);
+    }
+
+    // Evaluate the cell without holding the lock, since the base transformer
+    // may be slow. Another thread might do the same concurrently, but it
+    // will get the same result.
+    const double dfX0 = static_cast<double>(nCellX) * dfCellSize;
+    const double dfY0 = static_cast<double>(nCellY) * dfCellSize;
+    const double dfX1 = dfX0 + dfCellSize;
+    const double dfY1 = dfY0 + dfCellSize;
+    const double dfXM = dfX0 + dfCellSize / 2;
+    const double dfYM = dfY0 + dfCellSize / 2;
+    // 4 corners, then center and middle of the edges.
+    double adfX[9] = {dfX0, dfX1, dfX0, dfX1, dfXM, dfXM, dfX0, dfX1, dfXM};
+    double adfY[9] = {dfY0, dfY0, dfY1, dfY1, dfYM, dfY0, dfYM, dfYM, dfY1};
+    double adfZ[9] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+    int abSuccess[9] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+    const bool bCanSubdivide = dfCellSize / 2 >= MIN_STEP;
+
+    Cell oCell;
+    if (!psATInfo->pfnBaseTransformer(psATInfo->pBaseCBData, TRUE, 9, adfX,
+                                      adfY, adfZ, abSuccess) ||
+        !std::all_of(abSuccess, abSuccess + 9, [](int b) { return b != 0; }))
+    {
+        oCell.eState =
+            bCanSubdivide ? CellState::SUBDIVIDE : CellState::EXACT;
+    }
+    else
+    {
+        memcpy(oCell.adfX, adfX, sizeof(oCell.adfX));
+        memcpy(oCell.adfY, adfY, sizeof(oCell.adfY));
+        memcpy(oCell.adfZ, adfZ, sizeof(oCell.adfZ));
+
+        // Relative positions of the check points.
+        constexpr double adfU[5] = {0.5, 0.5, 0.0, 1.0, 0.5};
+        constexpr double adfV[5] = {0.5, 0.0, 0.5, 0.5, 1.0};
+        oCell.eState = CellState::INTERPOLATE;
+        for (int i = 0; i < 5; ++i)
+        {
+            const double dfU = adfU[i];
+            const double dfV = adfV[i];
+            const double dfXInterp =
+                (1 - dfV) * ((1 - dfU) * adfX[0] + dfU * adfX[1]) +
+                dfV * ((1 - dfU) * adfX[2] + dfU * adfX[3]);
+            const double dfYInterp =
+                (1 - dfV) * ((1 - dfU) * adfY[0] + dfU * adfY[1]) +
+                dfV * ((1 - dfU) * adfY[2] + dfU * adfY[3]);
+            const double dfError = fabs(dfXInterp - adfX[4 + i]) +
+                                   fabs(dfYInterp - adfY[4 + i]);
+            // Negated test to catch NaN.
+            if (!(dfError <= psATInfo->dfMaxErrorReverse))
+            {
+                oCell.eState =
+                    bCanSubdivide ? CellState::SUBDIVIDE : CellState::EXACT;
+                break;
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    return &(m_oMapCells.emplace(key, oCell).first->second);
+}
+
+}  // namespace
+
 /************************************************************************/
 /*                  GDALCreateSimilarApproxTransformer()                */
 /************************************************************************/
@@ -3800,6 +3990,16 @@ static void *GDALCreateSimilarApproxTransformer(void *hTransformArg,
     }
     psClonedInfo->bOwnSubtransformer = TRUE;
 
+    // A clone shares the grid. Otherwise the source coordinates change.
+    if (psInfo->poGrid)
+    {
+        if (dfSrcRatioX == 1.0 && dfSrcRatioY == 1.0)
+            psInfo->poGrid->Reference();
+        else
+            psClonedInfo->poGrid =
+                new GDALApproxTransformerGrid(psInfo->poGrid->GetStep());
+    }
+
     return psClonedInfo;
 }
 
@@ -3835,6 +4035,13 @@ static CPLXMLNode *GDALSerializeApproxTransformer(void *pTransformArg)
             CPLString().Printf("%g", psInfo->dfMaxErrorReverse));
     }
 
+    if (psInfo->poGrid)
+    {
+        CPLCreateXMLElementAndValue(
+            psTree, "GridStep",
+            CPLString().Printf("%g", psInfo->poGrid->GetStep()));
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Capture underlying transformer.                                 */
     /* -------------------------------------------------------------------- */
@@ -3879,6 +4086,13 @@ static CPLXMLNode *GDALSerializeApproxTransformer(void *pTransformArg)
  * circumstances as little internal validation is done in order to keep things
  * fast.
  *
+ * Starting with GDAL 3.9, if the GDAL_APPROX_TRANSFORMER_GRID_STEP
+ * configuration option is set to a positive number of pixels, reverse
+ * (destination to source) transformations are instead computed by bilinear
+ * interpolation in a grid of exactly transformed points, adaptively refined
+ * where needed to honour the maximum error. That grid is shared by the
+ * clones of the transformer, such as the ones used by the warper threads.
+ *
  * @param pfnBaseTransformer the high precision transformer which should be
  * approximated.
  * @param pBaseTransformArg the callback argument for the high precision
@@ -3911,6 +4125,12 @@ GDALCreateApproxTransformer2(GDALTransformerFunc pfnBaseTransformer,
     psATInfo->dfMaxErrorForward = dfMaxErrorForward;
     psATInfo->dfMaxErrorReverse = dfMaxErrorReverse;
     psATInfo->bOwnSubtransformer = FALSE;
+    psATInfo->poGrid = nullptr;
+    const double dfGridStep =
+        CPLAtof(CPLGetConfigOption("GDAL_APPROX_TRANSFORMER_GRID_STEP", "0"));
+    if (dfGridStep > 0 && dfMaxErrorReverse > 0)
+        psATInfo->poGrid = new GDALApproxTransformerGrid(
+            std::max(dfGridStep, GDALApproxTransformerGrid::MIN_STEP));
 
     memcpy(psATInfo->sTI.abySignature, GDAL_GTI2_SIGNATURE,
            strlen(GDAL_GTI2_SIGNATURE));
@@ -3960,9 +4180,28 @@ void GDALDestroyApproxTransformer(void *pCBData)
     if (psATInfo->bOwnSubtransformer)
         GDALDestroyTransformer(psATInfo->pBaseCBData);
 
+    if (psATInfo->poGrid)
+        psATInfo->poGrid->Release();
+
     CPLFree(pCBData);
 }
 
+/************************************************************************/
+/*                   GDALApproxTransformerResetGrid()                   */
+/************************************************************************/
+
+// Must be called when the base transformer is modified, since the cached
+// transformations are no longer valid.
+static void GDALApproxTransformerResetGrid(ApproxTransformInfo *psInfo)
+{
+    if (psInfo->poGrid)
+    {
+        const double dfGridStep = psInfo->poGrid->GetStep();
+        psInfo->poGrid->Release();
+        psInfo->poGrid = new GDALApproxTransformerGrid(dfGridStep);
+    }
+}
+
 /************************************************************************/
 /*                  GDALRefreshApproxTransformer()                      */
 /************************************************************************/
@@ -3976,6 +4215,8 @@ void GDALRefreshApproxTransformer(void *hTransformArg)
     {
         GDALRefreshGenImgProjTransformer(psInfo->pBaseCBData);
     }
+
+    GDALApproxTransformerResetGrid(psInfo);
 }
 
 /************************************************************************/
@@ -4229,6 +4470,105 @@ static int GDALApproxTransformInternal(void *pCBData, int bDstToSrc,
     return TRUE;
 }
 
+/************************************************************************/
+/*                     GDALApproxTransformWithGrid()                    */
+/************************************************************************/
+
+// Reverse transformation using the grid of psATInfo.
+static int GDALApproxTransformWithGrid(ApproxTransformInfo *psATInfo,
+                                       int nPoints, double *x, double *y,
+                                       double *z, int *panSuccess)
+{
+    using Grid = GDALApproxTransformerGrid;
+    Grid *poGrid = psATInfo->poGrid;
+    const double dfStep = poGrid->GetStep();
+
+    // Points that must go through the base transformer.
+    std::vector<int> anExact;
+
+    const Grid::Cell *psCell = nullptr;
+    double dfCellX0 = 0;
+    double dfCellY0 = 0;
+    double dfCellSize = 0;
+    for (int i = 0; i < nPoints; ++i)
+    {
+        const double dfX = x[i];
+        const double dfY = y[i];
+        // Reuse the cell of the previous point if possible.
+        if (!(psCell && dfX >= dfCellX0 && dfX < dfCellX0 + dfCellSize &&
+              dfY >= dfCellY0 && dfY < dfCellY0 + dfCellSize))
+        {
+            psCell = nullptr;
+            if (!(fabs(dfX) < 1e15 && fabs(dfY) < 1e15))
+            {
+                anExact.push_back(i);
+                continue;
+            }
+            dfCellSize = dfStep;
+            for (int nLevel = 0;; ++nLevel)
+            {
+                const GInt64 nCellX =
+                    static_cast<GInt64>(std::floor(dfX / dfCellSize));
+                const GInt64 nCellY =
+                    static_cast<GInt64>(std::floor(dfY / dfCellSize));
+                psCell = poGrid->GetCell(psATInfo, nLevel, dfCellSize, nCellX,
+                                         nCellY);
+                dfCellX0 = static_cast<double>(nCellX) * dfCellSize;
+                dfCellY0 = static_cast<double>(nCellY) * dfCellSize;
+                if (psCell->eState != Grid::CellState::SUBDIVIDE)
+                    break;
+                dfCellSize /= 2;
+            }
+        }
+
+        if (psCell->eState == Grid::CellState::EXACT)
+        {
+            anExact.push_back(i);
+            continue;
+        }
+
+        const double dfU = (dfX - dfCellX0) / dfCellSize;
+        const double dfV = (dfY - dfCellY0) / dfCellSize;
+        const double dfW00 = (1 - dfU) * (1 - dfV);
+        const double dfW10 = dfU * (1 - dfV);
+        const double dfW01 = (1 - dfU) * dfV;
+        const double dfW11 = dfU * dfV;
+        x[i] = dfW00 * psCell->adfX[0] + dfW10 * psCell->adfX[1] +
+               dfW01 * psCell->adfX[2] + dfW11 * psCell->adfX[3];
+        y[i] = dfW00 * psCell->adfY[0] + dfW10 * psCell->adfY[1] +
+               dfW01 * psCell->adfY[2] + dfW11 * psCell->adfY[3];
+        z[i] = dfW00 * psCell->adfZ[0] + dfW10 * psCell->adfZ[1] +
+               dfW01 * psCell->adfZ[2] + dfW11 * psCell->adfZ[3];
+        panSuccess[i] = TRUE;
+    }
+
+    if (anExact.empty())
+        return TRUE;
+
+    const size_t nExact = anExact.size();
+    std::vector<double> adfX(nExact);
+    std::vector<double> adfY(nExact);
+    std::vector<double> adfZ(nExact);
+    std::vector<int> abSuccess(nExact);
+    for (size_t i = 0; i < nExact; ++i)
+    {
+        adfX[i] = x[anExact[i]];
+        adfY[i] = y[anExact[i]];
+        adfZ[i] = z[anExact[i]];
+    }
+    const int bRet = psATInfo->pfnBaseTransformer(
+        psATInfo->pBaseCBData, TRUE, static_cast<int>(nExact), adfX.data(),
+        adfY.data(), adfZ.data(), abSuccess.data());
+    for (size_t i = 0; i < nExact; ++i)
+    {
+        x[anExact[i]] = adfX[i];
+        y[anExact[i]] = adfY[i];
+        z[anExact[i]] = adfZ[i];
+        panSuccess[anExact[i]] = abSuccess[i];
+    }
+    return bRet;
+}
+
 /************************************************************************/
 /*                        GDALApproxTransform()                         */
 /************************************************************************/
@@ -4255,6 +4595,14 @@ int GDALApproxTransform(void *pCBData, int bDstToSrc, int nPoints, double *x,
 
     const int nMiddle = (nPoints - 1) / 2;
 
+    // The grid caches transformations of points with a zero Z.
+    if (bDstToSrc && psATInfo->poGrid &&
+        std::all_of(z, z + nPoints, [](double dfZ) { return dfZ == 0; }))
+    {
+        return GDALApproxTransformWithGrid(psATInfo, nPoints, x, y, z,
+                                           panSuccess);
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Bail if our preconditions are not met, or if error is not       */
     /*      acceptable.                                                     */
@@ -4356,6 +4704,20 @@ static void *GDALDeserializeApproxTransformer(CPLXMLNode *psTree)
         pfnBaseTransform, pBaseCBData, dfMaxErrorForward, dfMaxErrorReverse);
     GDALApproxTransformerOwnsSubtransformer(pApproxCBData, TRUE);
 
+    const char *pszGridStep = CPLGetXMLValue(psTree, "GridStep", nullptr);
+    if (pszGridStep != nullptr)
+    {
+        ApproxTransformInfo *psATInfo =
+            static_cast<ApproxTransformInfo *>(pApproxCBData);
+        if (psATInfo->poGrid)
+            psATInfo->poGrid->Release();
+        psATInfo->poGrid = nullptr;
+        const double dfGridStep = CPLAtof(pszGridStep);
+        if (dfGridStep > 0 && dfMaxErrorReverse > 0)
+            psATInfo->poGrid = new GDALApproxTransformerGrid(
+                std::max(dfGridStep, GDALApproxTransformerGrid::MIN_STEP));
+    }
+
     return pApproxCBData;
 }
 
@@ -4866,6 +5228,9 @@ void GDALSetTransformerDstGeoTransform(void *pTransformArg,
     if (psInfo)
     {
         GDALSetGenImgProjTransformerDstGeoTransform(psInfo, padfGeoTransform);
+        if (pTransformArg != psInfo)
+            GDALApproxTransformerResetGrid(
+                static_cast<ApproxTransformInfo *>(pTransformArg));
     }
 }
 
@@ -1102,6 +1102,16 @@ CPLErr GDALWarpDstAlphaMasker(void *pMaskFuncArg, int nBandCount,
  * situations. Starting with GDAL 2.4, gdalwarp will automatically enable this
  * option when it is assumed to be safe to do so.</li>
  *
+ * <li>USE_SRC_DATA_COVERAGE=YES/NO: (GDAL >= 3.9) Whether to use
+ * GDALGetDataCoverageStatus() on the source dataset to detect chunks whose
+ * source window has no valid data, for example in sparse GeoTIFF files or in
+ * VRT mosaics of scattered sources. Such chunks are considered as having no
+ * source data, and are thus skipped if SKIP_NOSOURCE=YES, or processed
+ * without reading the source otherwise. This is only done when empty
+ * areas are considered invalid, that is when the source has an alpha band
+ * or a per-dataset mask band, or when the source nodata value matches the
+ * value empty areas read as. Defaults to YES.</li>
+ *
  * <li>UNIFIED_SRC_NODATA=YES/NO/PARTIAL: This setting determines
  * how to take into account nodata values when there are several input bands.
  * <ul>
@@ -1177,6 +1187,16 @@ CPLErr GDALWarpDstAlphaMasker(void *pMaskFuncArg, int nBandCount,
  * set the number of threads to use to parallelize the computation part of the
  * warping. If not set, computation will be done in a single thread.</li>
  *
+ * <li>NUM_CHUNK_WORKERS: (GDAL >= 3.9) Can be set to a numeric value or
+ * ALL_CPUS to set the number of workers used by
+ * GDALWarpOperation::ChunkAndWarpMulti() to process chunks concurrently.
+ * Input and output operations remain serialized, but the warping of different
+ * chunks is done in parallel, and chunks are dynamically assigned to the
+ * workers that are available. Each worker uses a share of the warp memory
+ * limit. The output is written in the same order as with a single worker.
+ * If not set, two threads are used to overlap input/output of one chunk with
+ * the computation of another one.</li>
+ *
  * <li>STREAMABLE_OUTPUT: (GDAL >= 2.0) This defaults to FALSE, but may
  * be set to TRUE typically when writing to a streamed file. The
  * gdalwarp utility automatically sets this option when writing to
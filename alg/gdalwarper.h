@@ -488,6 +488,7 @@ void GWKThreadsEnd(void *psThreadDataIn);
 
 /*! @cond Doxygen_Suppress */
 typedef struct _GDALWarpChunk GDALWarpChunk;
+struct GDALWarpChunkWorker;
 /*! @endcond */
 
 class CPL_DLL GDALWarpOperation
@@ -549,6 +550,21 @@ class CPL_DLL GDALWarpOperation
                           int nDstYSize);
     void ReportTiming(const char *);
 
+    CPLErr ChunkAndWarpWithWorkers(int nDstXOff, int nDstYOff, int nDstXSize,
+                                   int nDstYSize, int nWorkers);
+    static void ChunkWorkerThreadMain(void *pThreadData);
+    void RunChunkWorker(GDALWarpChunkWorker *psWorker);
+    CPLErr ReadDestinationBuffer(int nDstXOff, int nDstYOff, int nDstXSize,
+                                 int nDstYSize, void *pDstBuffer);
+    CPLErr WriteDestinationBuffer(int nDstXOff, int nDstYOff, int nDstXSize,
+                                  int nDstYSize, void *pDstBuffer);
+    CPLErr WarpRegionToBufferInternal(
+        int nDstXOff, int nDstYOff, int nDstXSize, int nDstYSize,
+        void *pDataBuf, GDALDataType eBufDataType, int nSrcXOff, int nSrcYOff,
+        int nSrcXSize, int nSrcYSize, double dfSrcXExtraSize,
+        double dfSrcYExtraSize, double dfProgressBase, double dfProgressScale,
+        GDALWarpChunkWorker *psWorker);
+
   public:
     GDALWarpOperation();
     virtual ~GDALWarpOperation();
@@ -42,6 +42,7 @@
 #include <limits>
 #include <mutex>
 #include <new>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -179,6 +180,8 @@ static CPLErr GWKOpenCLCase(GDALWarpKernel *);
 
 static CPLErr GWKGeneralCase(GDALWarpKernel *);
 static CPLErr GWKRealCase(GDALWarpKernel *poWK);
+static bool GWKUseSeparableResampling(const GDALWarpKernel *poWK);
+static CPLErr GWKSeparableNoMasksOrDstDensityOnly(GDALWarpKernel *poWK);
 static CPLErr GWKNearestNoMasksOrDstDensityOnlyByte(GDALWarpKernel *poWK);
 static CPLErr GWKBilinearNoMasksOrDstDensityOnlyByte(GDALWarpKernel *poWK);
 static CPLErr GWKCubicNoMasksOrDstDensityOnlyByte(GDALWarpKernel *poWK);
@@ -1267,6 +1270,9 @@ CPLErr GDALWarpKernel::PerformWarp()
         papanBandSrcValid == nullptr && panUnifiedSrcValid == nullptr &&
         pafUnifiedSrcDensity == nullptr && panDstValid == nullptr;
 
+    if (bNoMasksOrDstDensityOnly && GWKUseSeparableResampling(this))
+        return GWKSeparableNoMasksOrDstDensityOnly(this);
+
     if (eWorkingDataType == GDT_Byte && eResample == GRA_NearestNeighbour &&
         bNoMasksOrDstDensityOnly)
         return GWKNearestNoMasksOrDstDensityOnlyByte(this);
@@ -2014,6 +2020,51 @@ static bool GWKSetPixelValueReal(const GDALWarpKernel *poWK, int iBand,
     return true;
 }
 
+/************************************************************************/
+/*                   GWKSetPixelValueRealFromDoubleT()                  */
+/************************************************************************/
+
+// Same as GWKSetPixelValueReal(), but for a working data type known at
+// compile time.
+template <class T>
+static bool GWKSetPixelValueRealFromDoubleT(const GDALWarpKernel *poWK,
+                                            int iBand, GPtrDiff_t iDstOffset,
+                                            double dfDensity, double dfReal)
+{
+    GByte *pabyDst = poWK->papabyDstImage[iBand];
+
+    if (dfDensity < 0.9999)
+    {
+        if (dfDensity < 0.0001)
+            return true;
+
+        double dfDstDensity = 1.0;
+
+        if (poWK->pafDstDensity != nullptr)
+            dfDstDensity = poWK->pafDstDensity[iDstOffset];
+        else if (poWK->panDstValid != nullptr &&
+                 !CPLMaskGet(poWK->panDstValid, iDstOffset))
+            dfDstDensity = 0.0;
+
+        const double dfDstReal =
+            static_cast<double>(reinterpret_cast<T *>(pabyDst)[iDstOffset]);
+
+        // The destination density is really only relative to the portion
+        // not occluded by the overlay.
+        const double dfDstInfluence = (1.0 - dfDensity) * dfDstDensity;
+
+        dfReal = (dfReal * dfDensity + dfDstReal * dfDstInfluence) /
+                 (dfDensity + dfDstInfluence);
+    }
+
+    if constexpr (std::numeric_limits<T>::is_integer)
+        CLAMP(T);
+    else
+        reinterpret_cast<T *>(pabyDst)[iDstOffset] = static_cast<T>(dfReal);
+
+    return true;
+}
+
 /************************************************************************/
 /*                          GWKGetPixelValue()                          */
 /************************************************************************/
@@ -2210,79 +2261,46 @@ static bool GWKGetPixelValueReal(const GDALWarpKernel *poWK, int iBand,
 }
 
 /************************************************************************/
-/*                          GWKGetPixelRow()                            */
+/*                       GWKGetPixelValueRealT()                        */
 /************************************************************************/
 
-/* It is assumed that adfImag[] is set to 0 by caller code for non-complex */
-/* data-types. */
+template <class T>
+static CPL_INLINE bool GWKGetPixelValueRealT(const GDALWarpKernel *poWK,
+                                             int iBand, GPtrDiff_t iSrcOffset,
+                                             double *pdfDensity,
+                                             double *pdfReal)
 
-static bool GWKGetPixelRow(const GDALWarpKernel *poWK, int iBand,
-                           GPtrDiff_t iSrcOffset, int nHalfSrcLen,
-                           double *padfDensity, double adfReal[],
-                           double *padfImag)
 {
-    // We know that nSrcLen is even, so we can *always* unroll loops 2x.
-    const int nSrcLen = nHalfSrcLen * 2;
-    bool bHasValid = false;
-
-    if (padfDensity != nullptr)
+    if (poWK->papanBandSrcValid != nullptr &&
+        poWK->papanBandSrcValid[iBand] != nullptr &&
+        !CPLMaskGet(poWK->papanBandSrcValid[iBand], iSrcOffset))
     {
-        // Init the density.
-        for (int i = 0; i < nSrcLen; i += 2)
-        {
-            padfDensity[i] = 1.0;
-            padfDensity[i + 1] = 1.0;
-        }
-
-        if (poWK->panUnifiedSrcValid != nullptr)
-        {
-            for (int i = 0; i < nSrcLen; i += 2)
-            {
-                if (CPLMaskGet(poWK->panUnifiedSrcValid, iSrcOffset + i))
-                    bHasValid = true;
-                else
-                    padfDensity[i] = 0.0;
-
-                if (CPLMaskGet(poWK->panUnifiedSrcValid, iSrcOffset + i + 1))
-                    bHasValid = true;
-                else
-                    padfDensity[i + 1] = 0.0;
-            }
+        *pdfDensity = 0.0;
+        return false;
+    }
 
-            // Reset or fail as needed.
-            if (bHasValid)
-                bHasValid = false;
-            else
-                return false;
-        }
+    *pdfReal = static_cast<double>(
+        reinterpret_cast<const T *>(poWK->papabySrcImage[iBand])[iSrcOffset]);
 
-        if (poWK->papanBandSrcValid != nullptr &&
-            poWK->papanBandSrcValid[iBand] != nullptr)
-        {
-            for (int i = 0; i < nSrcLen; i += 2)
-            {
-                if (CPLMaskGet(poWK->papanBandSrcValid[iBand], iSrcOffset + i))
-                    bHasValid = true;
-                else
-                    padfDensity[i] = 0.0;
+    if (poWK->pafUnifiedSrcDensity != nullptr)
+        *pdfDensity = poWK->pafUnifiedSrcDensity[iSrcOffset];
+    else
+        *pdfDensity = 1.0;
 
-                if (CPLMaskGet(poWK->papanBandSrcValid[iBand],
-                               iSrcOffset + i + 1))
-                    bHasValid = true;
-                else
-                    padfDensity[i + 1] = 0.0;
-            }
+    return *pdfDensity != 0.0;
+}
 
-            // Reset or fail as needed.
-            if (bHasValid)
-                bHasValid = false;
-            else
-                return false;
-        }
-    }
+/************************************************************************/
+/*                       GWKGetPixelRowValues()                         */
+/************************************************************************/
 
+// Fetch nSrcLen values of any working data type.
+static bool GWKGetPixelRowValues(const GDALWarpKernel *poWK, int iBand,
+                                 GPtrDiff_t iSrcOffset, int nSrcLen,
+                                 double *padfDensity, double adfReal[],
+                                 double *padfImag)
+{
     // TODO(schwehr): Fix casting.
-    // Fetch data.
     switch (poWK->eWorkingDataType)
     {
         case GDT_Byte:
@@ -2486,6 +2504,117 @@ static bool GWKGetPixelRow(const GDALWarpKernel *poWK, int iBand,
                 memset(padfDensity, 0, nSrcLen * sizeof(double));
             return false;
     }
+    return true;
+}
+
+// Fetch nSrcLen values of a real working data type known at compile time.
+// T = void means that the data type is only known at runtime.
+template <class T>
+static CPL_INLINE bool
+GWKGetPixelRowValuesT(const GDALWarpKernel *poWK, int iBand,
+                      GPtrDiff_t iSrcOffset, int nSrcLen,
+                      double * /* padfDensity */, double adfReal[],
+                      double * /* padfImag */)
+{
+    const T *pSrc =
+        reinterpret_cast<const T *>(poWK->papabySrcImage[iBand]) + iSrcOffset;
+    for (int i = 0; i < nSrcLen; i += 2)
+    {
+        adfReal[i] = static_cast<double>(pSrc[i]);
+        adfReal[i + 1] = static_cast<double>(pSrc[i + 1]);
+    }
+    return true;
+}
+
+template <>
+CPL_INLINE bool GWKGetPixelRowValuesT<void>(const GDALWarpKernel *poWK,
+                                            int iBand, GPtrDiff_t iSrcOffset,
+                                            int nSrcLen, double *padfDensity,
+                                            double adfReal[], double *padfImag)
+{
+    return GWKGetPixelRowValues(poWK, iBand, iSrcOffset, nSrcLen, padfDensity,
+                                adfReal, padfImag);
+}
+
+/************************************************************************/
+/*                          GWKGetPixelRow()                            */
+/************************************************************************/
+
+/* It is assumed that adfImag[] is set to 0 by caller code for non-complex */
+/* data-types. */
+
+template <class T>
+static bool GWKGetPixelRow(const GDALWarpKernel *poWK, int iBand,
+                           GPtrDiff_t iSrcOffset, int nHalfSrcLen,
+                           double *padfDensity, double adfReal[],
+                           double *padfImag)
+{
+    // We know that nSrcLen is even, so we can *always* unroll loops 2x.
+    const int nSrcLen = nHalfSrcLen * 2;
+    bool bHasValid = false;
+
+    if (padfDensity != nullptr)
+    {
+        // Init the density.
+        for (int i = 0; i < nSrcLen; i += 2)
+        {
+            padfDensity[i] = 1.0;
+            padfDensity[i + 1] = 1.0;
+        }
+
+        if (poWK->panUnifiedSrcValid != nullptr)
+        {
+            for (int i = 0; i < nSrcLen; i += 2)
+            {
+                if (CPLMaskGet(poWK->panUnifiedSrcValid, iSrcOffset + i))
+                    bHasValid = true;
+                else
+                    padfDensity[i] = 0.0;
+
+                if (CPLMaskGet(poWK->panUnifiedSrcValid, iSrcOffset + i + 1))
+                    bHasValid = true;
+                else
+                    padfDensity[i + 1] = 0.0;
+            }
+
+            // Reset or fail as needed.
+            if (bHasValid)
+                bHasValid = false;
+            else
+                return false;
+        }
+
+        if (poWK->papanBandSrcValid != nullptr &&
+            poWK->papanBandSrcValid[iBand] != nullptr)
+        {
+            for (int i = 0; i < nSrcLen; i += 2)
+            {
+                if (CPLMaskGet(poWK->papanBandSrcValid[iBand], iSrcOffset + i))
+                    bHasValid = true;
+                else
+                    padfDensity[i] = 0.0;
+
+                if (CPLMaskGet(poWK->papanBandSrcValid[iBand],
+                               iSrcOffset + i + 1))
+                    bHasValid = true;
+                else
+                    padfDensity[i + 1] = 0.0;
+            }
+
+            // Reset or fail as needed.
+            if (bHasValid)
+                bHasValid = false;
+            else
+                return false;
+        }
+    }
+
+    // Fetch data.
+    if (!GWKGetPixelRowValuesT<T>(poWK, iBand, iSrcOffset, nSrcLen, padfDensity,
+                                  adfReal, padfImag))
+    {
+        return false;
+    }
 
     if (padfDensity == nullptr)
         return true;
@@ -2564,6 +2693,8 @@ static bool GWKGetPixelT(const GDALWarpKernel *poWK, int iBand,
 /*     Set of bilinear interpolators                                    */
 /************************************************************************/
 
+// T is the working data type, or void if only known at runtime.
+template <class T>
 static bool GWKBilinearResample4Sample(const GDALWarpKernel *poWK, int iBand,
                                        double dfSrcX, double dfSrcY,
                                        double *pdfDensity, double *pdfReal,
@@ -2614,8 +2745,8 @@ static bool GWKBilinearResample4Sample(const GDALWarpKernel *poWK, int iBand,
     // Get pixel row.
     if (iSrcY >= 0 && iSrcY < nSrcYSize && iSrcOffset >= 0 &&
         iSrcOffset < nSrcPixels &&
-        GWKGetPixelRow(poWK, iBand, iSrcOffset, 1, adfDensity, adfReal,
-                       adfImag))
+        GWKGetPixelRow<T>(poWK, iBand, iSrcOffset, 1, adfDensity, adfReal,
+                          adfImag))
     {
         double dfMult1 = dfRatioX * dfRatioY;
         double dfMult2 = (1.0 - dfRatioX) * dfRatioY;
@@ -2654,8 +2785,8 @@ static bool GWKBilinearResample4Sample(const GDALWarpKernel *poWK, int iBand,
     // Get pixel row.
     if (iSrcY + 1 >= 0 && iSrcY + 1 < nSrcYSize &&
         iSrcOffset + nSrcXSize >= 0 && iSrcOffset + nSrcXSize < nSrcPixels &&
-        GWKGetPixelRow(poWK, iBand, iSrcOffset + nSrcXSize, 1, adfDensity,
-                       adfReal, adfImag))
+        GWKGetPixelRow<T>(poWK, iBand, iSrcOffset + nSrcXSize, 1, adfDensity,
+                          adfReal, adfImag))
     {
         double dfMult1 = dfRatioX * (1.0 - dfRatioY);
         double dfMult2 = (1.0 - dfRatioX) * (1.0 - dfRatioY);
@@ -2885,6 +3016,8 @@ static bool GWKBilinearResampleNoMasks4SampleT(const GDALWarpKernel *poWK,
                            (adfCoeffs)[2] * (v)[2] + (adfCoeffs)[3] * (v)[3]))
 #endif
 
+// T is the working data type, or void if only known at runtime.
+template <class T>
 static bool GWKCubicResample4Sample(const GDALWarpKernel *poWK, int iBand,
                                     double dfSrcX, double dfSrcY,
                                     double *pdfDensity, double *pdfReal,
@@ -2904,7 +3037,7 @@ static bool GWKCubicResample4Sample(const GDALWarpKernel *poWK, int iBand,
     // Get the bilinear interpolation at the image borders.
     if (iSrcX - 1 < 0 || iSrcX + 2 >= poWK->nSrcXSize || iSrcY - 1 < 0 ||
         iSrcY + 2 >= poWK->nSrcYSize)
-        return GWKBilinearResample4Sample(poWK, iBand, dfSrcX, dfSrcY,
+        return GWKBilinearResample4Sample<T>(poWK, iBand, dfSrcX, dfSrcY,
                                           pdfDensity, pdfReal, pdfImag);
 
     double adfValueDens[4] = {};
@@ -2916,14 +3049,15 @@ static bool GWKCubicResample4Sample(const GDALWarpKernel *poWK, int iBand,
 
     for (GPtrDiff_t i = -1; i < 3; i++)
     {
-        if (!GWKGetPixelRow(poWK, iBand, iSrcOffset + i * poWK->nSrcXSize - 1,
-                            2, adfDensity, adfReal, adfImag) ||
+        if (!GWKGetPixelRow<T>(poWK, iBand,
+                               iSrcOffset + i * poWK->nSrcXSize - 1, 2,
+                               adfDensity, adfReal, adfImag) ||
             adfDensity[0] < SRC_DENSITY_THRESHOLD ||
             adfDensity[1] < SRC_DENSITY_THRESHOLD ||
             adfDensity[2] < SRC_DENSITY_THRESHOLD ||
             adfDensity[3] < SRC_DENSITY_THRESHOLD)
         {
-            return GWKBilinearResample4Sample(poWK, iBand, dfSrcX, dfSrcY,
+            return GWKBilinearResample4Sample<T>(poWK, iBand, dfSrcX, dfSrcY,
                                               pdfDensity, pdfReal, pdfImag);
         }
 
@@ -3042,7 +3176,7 @@ static CPL_INLINE bool GWKCubicResampleSrcMaskIsDensity4SampleRealT(
         iSrcY + 2 >= poWK->nSrcYSize)
     {
         double adfImagIgnored[4] = {};
-        return GWKBilinearResample4Sample(poWK, iBand, dfSrcX, dfSrcY,
+        return GWKBilinearResample4Sample<T>(poWK, iBand, dfSrcX, dfSrcY,
                                           pdfDensity, pdfReal, adfImagIgnored);
     }
 
@@ -3086,7 +3220,7 @@ static CPL_INLINE bool GWKCubicResampleSrcMaskIsDensity4SampleRealT(
     if (_mm_movemask_ps(xmmMaskLowDensity))
     {
         double adfImagIgnored[4] = {};
-        return GWKBilinearResample4Sample(poWK, iBand, dfSrcX, dfSrcY,
+        return GWKBilinearResample4Sample<T>(poWK, iBand, dfSrcX, dfSrcY,
                                           pdfDensity, pdfReal, adfImagIgnored);
     }
 
@@ -3140,7 +3274,7 @@ static CPL_INLINE bool GWKCubicResampleSrcMaskIsDensity4SampleRealT(
             poWK->pafUnifiedSrcDensity[iOffset + 3] < SRC_DENSITY_THRESHOLD)
         {
             double adfImagIgnored[4] = {};
-            return GWKBilinearResample4Sample(poWK, iBand, dfSrcX, dfSrcY,
+            return GWKBilinearResample4Sample<T>(poWK, iBand, dfSrcX, dfSrcY,
                                               pdfDensity, pdfReal,
                                               adfImagIgnored);
         }
@@ -3182,7 +3316,7 @@ static bool GWKCubicResampleSrcMaskIsDensity4SampleReal(
         iSrcY + 2 >= poWK->nSrcYSize)
     {
         double adfImagIgnored[4] = {};
-        return GWKBilinearResample4Sample(poWK, iBand, dfSrcX, dfSrcY,
+        return GWKBilinearResample4Sample<void>(poWK, iBand, dfSrcX, dfSrcY,
                                           pdfDensity, pdfReal, adfImagIgnored);
     }
 
@@ -3200,14 +3334,15 @@ static bool GWKCubicResampleSrcMaskIsDensity4SampleReal(
 
     for (GPtrDiff_t i = -1; i < 3; i++)
     {
-        if (!GWKGetPixelRow(poWK, iBand, iSrcOffset + i * poWK->nSrcXSize - 1,
-                            2, adfDensity, adfReal, adfImagIgnored) ||
+        if (!GWKGetPixelRow<void>(poWK, iBand,
+                                  iSrcOffset + i * poWK->nSrcXSize - 1, 2,
+                                  adfDensity, adfReal, adfImagIgnored) ||
             adfDensity[0] < SRC_DENSITY_THRESHOLD ||
             adfDensity[1] < SRC_DENSITY_THRESHOLD ||
             adfDensity[2] < SRC_DENSITY_THRESHOLD ||
             adfDensity[3] < SRC_DENSITY_THRESHOLD)
         {
-            return GWKBilinearResample4Sample(poWK, iBand, dfSrcX, dfSrcY,
+            return GWKBilinearResample4Sample<void>(poWK, iBand, dfSrcX, dfSrcY,
                                               pdfDensity, pdfReal,
                                               adfImagIgnored);
         }
@@ -3515,16 +3650,20 @@ struct _GWKResampleWrkStruct
 /*                    GWKResampleCreateWrkStruct()                      */
 /************************************************************************/
 
+template <class T>
 static bool GWKResample(const GDALWarpKernel *poWK, int iBand, double dfSrcX,
                         double dfSrcY, double *pdfDensity, double *pdfReal,
                         double *pdfImag, GWKResampleWrkStruct *psWrkStruct);
 
+template <class T>
 static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
                                         double dfSrcX, double dfSrcY,
                                         double *pdfDensity, double *pdfReal,
                                         double *pdfImag,
                                         GWKResampleWrkStruct *psWrkStruct);
 
+// T is the working data type, or void if only known at runtime.
+template <class T>
 static GWKResampleWrkStruct *GWKResampleCreateWrkStruct(GDALWarpKernel *poWK)
 {
     const int nXDist = (poWK->nXRadius + 1) * 2;
@@ -3565,7 +3704,7 @@ static GWKResampleWrkStruct *GWKResampleCreateWrkStruct(GDALWarpKernel *poWK)
 
     if (poWK->eResample == GRA_Lanczos)
     {
-        psWrkStruct->pfnGWKResample = GWKResampleOptimizedLanczos;
+        psWrkStruct->pfnGWKResample = GWKResampleOptimizedLanczos<T>;
 
         const double dfXScale = poWK->dfXScale;
         if (dfXScale < 1.0)
@@ -3602,7 +3741,7 @@ static GWKResampleWrkStruct *GWKResampleCreateWrkStruct(GDALWarpKernel *poWK)
         }
     }
     else
-        psWrkStruct->pfnGWKResample = GWKResample;
+        psWrkStruct->pfnGWKResample = GWKResample<T>;
 
     return psWrkStruct;
 }
@@ -3626,6 +3765,7 @@ static void GWKResampleDeleteWrkStruct(GWKResampleWrkStruct *psWrkStruct)
 /*                           GWKResample()                              */
 /************************************************************************/
 
+template <class T>
 static bool GWKResample(const GDALWarpKernel *poWK, int iBand, double dfSrcX,
                         double dfSrcY, double *pdfDensity, double *pdfReal,
                         double *pdfImag, GWKResampleWrkStruct *psWrkStruct)
@@ -3698,8 +3838,8 @@ static bool GWKResample(const GDALWarpKernel *poWK, int iBand, double dfSrcX,
         // source arrays, but the contract of papabySrcImage[iBand],
         // papanBandSrcValid[iBand], panUnifiedSrcValid and pafUnifiedSrcDensity
         // is to have WARP_EXTRA_ELTS reserved at their end.
-        if (!GWKGetPixelRow(poWK, iBand, iRowOffset, (iMax - iMin + 2) / 2,
-                            padfRowDensity, padfRowReal, padfRowImag))
+        if (!GWKGetPixelRow<T>(poWK, iBand, iRowOffset, (iMax - iMin + 2) / 2,
+                               padfRowDensity, padfRowReal, padfRowImag))
             continue;
 
         // Calculate the Y weight.
@@ -3787,6 +3927,7 @@ static bool GWKResample(const GDALWarpKernel *poWK, int iBand, double dfSrcX,
 /*                      GWKResampleOptimizedLanczos()                   */
 /************************************************************************/
 
+template <class T>
 static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
                                         double dfSrcX, double dfSrcY,
                                         double *pdfDensity, double *pdfReal,
@@ -4005,8 +4146,8 @@ static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
         // source arrays, but the contract of papabySrcImage[iBand],
         // papanBandSrcValid[iBand], panUnifiedSrcValid and pafUnifiedSrcDensity
         // is to have WARP_EXTRA_ELTS reserved at their end.
-        if (!GWKGetPixelRow(poWK, iBand, iRowOffset, (iMax - iMin + 2) / 2,
-                            padfRowDensity, padfRowReal, padfRowImag))
+        if (!GWKGetPixelRow<T>(poWK, iBand, iRowOffset, (iMax - iMin + 2) / 2,
+                               padfRowDensity, padfRowReal, padfRowImag))
             continue;
 
         const double dfWeight1 = padfWeightsY[j - poWK->nFiltInitY];
@@ -5291,7 +5432,7 @@ static void GWKGeneralCaseThread(void *pData)
     GWKResampleWrkStruct *psWrkStruct = nullptr;
     if (poWK->eResample != GRA_NearestNeighbour)
     {
-        psWrkStruct = GWKResampleCreateWrkStruct(poWK);
+        psWrkStruct = GWKResampleCreateWrkStruct<void>(poWK);
     }
     const double dfSrcCoordPrecision = CPLAtof(CSLFetchNameValueDef(
         poWK->papszWarpOptions, "SRC_COORD_PRECISION", "0"));
@@ -5426,14 +5567,14 @@ static void GWKGeneralCaseThread(void *pData)
                 }
                 else if (poWK->eResample == GRA_Bilinear && bUse4SamplesFormula)
                 {
-                    GWKBilinearResample4Sample(
+                    GWKBilinearResample4Sample<void>(
                         poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
                         padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
                         &dfValueReal, &dfValueImag);
                 }
                 else if (poWK->eResample == GRA_Cubic && bUse4SamplesFormula)
                 {
-                    GWKCubicResample4Sample(
+                    GWKCubicResample4Sample<void>(
                         poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
                         padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
                         &dfValueReal, &dfValueImag);
@@ -5523,9 +5664,11 @@ static CPLErr GWKGeneralCase(GDALWarpKernel *poWK)
 /*                            GWKRealCase()                             */
 /*                                                                      */
 /*      General case for non-complex data types.                        */
+/*      Instantiated for each working data type so that pixel values    */
+/*      are fetched and stored without a runtime switch on the type.    */
 /************************************************************************/
 
-static void GWKRealCaseThread(void *pData)
+template <class T> static void GWKRealCaseThread(void *pData)
 
 {
     GWKJobStruct *psJob = static_cast<GWKJobStruct *>(pData);
@@ -5563,7 +5706,7 @@ static void GWKRealCaseThread(void *pData)
     GWKResampleWrkStruct *psWrkStruct = nullptr;
     if (poWK->eResample != GRA_NearestNeighbour)
     {
-        psWrkStruct = GWKResampleCreateWrkStruct(poWK);
+        psWrkStruct = GWKResampleCreateWrkStruct<T>(poWK);
     }
     const double dfSrcCoordPrecision = CPLAtof(CSLFetchNameValueDef(
         poWK->papszWarpOptions, "SRC_COORD_PRECISION", "0"));
@@ -5695,13 +5838,13 @@ static void GWKRealCaseThread(void *pData)
                 {
                     // FALSE is returned if dfBandDensity == 0, which is
                     // checked below.
-                    CPL_IGNORE_RET_VAL(GWKGetPixelValueReal(
+                    CPL_IGNORE_RET_VAL(GWKGetPixelValueRealT<T>(
                         poWK, iBand, iSrcOffset, &dfBandDensity, &dfValueReal));
                 }
                 else if (poWK->eResample == GRA_Bilinear && bUse4SamplesFormula)
                 {
                     double dfValueImagIgnored = 0.0;
-                    GWKBilinearResample4Sample(
+                    GWKBilinearResample4Sample<T>(
                         poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
                         padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
                         &dfValueReal, &dfValueImagIgnored);
@@ -5710,21 +5853,22 @@ static void GWKRealCaseThread(void *pData)
                 {
                     if (bSrcMaskIsDensity)
                     {
-                        if (poWK->eWorkingDataType == GDT_Byte)
+#if defined(USE_SSE_CUBIC_IMPL) && (defined(__x86_64) || defined(_M_X64))
+                        // The SSE implementation is only valid for those
+                        // types.
+                        constexpr bool bUseTemplate =
+                            std::is_same<T, GByte>::value ||
+                            std::is_same<T, GUInt16>::value;
+#else
+                        constexpr bool bUseTemplate = true;
+#endif
+                        if constexpr (bUseTemplate)
                         {
-                            GWKCubicResampleSrcMaskIsDensity4SampleRealT<GByte>(
+                            GWKCubicResampleSrcMaskIsDensity4SampleRealT<T>(
                                 poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
                                 padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
                                 &dfValueReal);
                         }
-                        else if (poWK->eWorkingDataType == GDT_UInt16)
-                        {
-                            GWKCubicResampleSrcMaskIsDensity4SampleRealT<
-                                GUInt16>(poWK, iBand,
-                                         padfX[iDstX] - poWK->nSrcXOff,
-                                         padfY[iDstX] - poWK->nSrcYOff,
-                                         &dfBandDensity, &dfValueReal);
-                        }
                         else
                         {
                             GWKCubicResampleSrcMaskIsDensity4SampleReal(
@@ -5736,7 +5880,7 @@ static void GWKRealCaseThread(void *pData)
                     else
                     {
                         double dfValueImagIgnored = 0.0;
-                        GWKCubicResample4Sample(
+                        GWKCubicResample4Sample<T>(
                             poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
                             padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
                             &dfValueReal, &dfValueImagIgnored);
@@ -5779,8 +5923,8 @@ static void GWKRealCaseThread(void *pData)
                 /*      the destination pixel. */
                 /* --------------------------------------------------------------------
                  */
-                GWKSetPixelValueReal(poWK, iBand, iDstOffset, dfBandDensity,
-                                     dfValueReal);
+                GWKSetPixelValueRealFromDoubleT<T>(poWK, iBand, iDstOffset,
+                                                   dfBandDensity, dfValueReal);
             }
 
             if (!bHasFoundDensity)
@@ -5821,7 +5965,40 @@ static void GWKRealCaseThread(void *pData)
 
 static CPLErr GWKRealCase(GDALWarpKernel *poWK)
 {
-    return GWKRun(poWK, "GWKRealCase", GWKRealCaseThread);
+    switch (poWK->eWorkingDataType)
+    {
+        case GDT_Byte:
+            return GWKRun(poWK, "GWKRealCase", GWKRealCaseThread<GByte>);
+        case GDT_Int8:
+            return GWKRun(poWK, "GWKRealCase", GWKRealCaseThread<GInt8>);
+        case GDT_Int16:
+            return GWKRun(poWK, "GWKRealCase", GWKRealCaseThread<GInt16>);
+        case GDT_UInt16:
+            return GWKRun(poWK, "GWKRealCase", GWKRealCaseThread<GUInt16>);
+        case GDT_Int32:
+            return GWKRun(poWK, "GWKRealCase", GWKRealCaseThread<GInt32>);
+        case GDT_UInt32:
+            return GWKRun(poWK, "GWKRealCase", GWKRealCaseThread<GUInt32>);
+        case GDT_Int64:
+            return GWKRun(poWK, "GWKRealCase",
+                          GWKRealCaseThread<std::int64_t>);
+        case GDT_UInt64:
+            return GWKRun(poWK, "GWKRealCase",
+                          GWKRealCaseThread<std::uint64_t>);
+        case GDT_Float32:
+            return GWKRun(poWK, "GWKRealCase", GWKRealCaseThread<float>);
+        case GDT_Float64:
+            return GWKRun(poWK, "GWKRealCase", GWKRealCaseThread<double>);
+        case GDT_CInt16:
+        case GDT_CInt32:
+        case GDT_CFloat32:
+        case GDT_CFloat64:
+        case GDT_Unknown:
+        case GDT_TypeCount:
+            break;
+    }
+    CPLAssert(false);
+    return GWKGeneralCase(poWK);
 }
 
 /************************************************************************/
@@ -6014,25 +6191,588 @@ static void GWKResampleNoMasksOrDstDensityOnlyHas4SampleThread(void *pData)
             pData);
 }
 
-static CPLErr GWKNearestNoMasksOrDstDensityOnlyByte(GDALWarpKernel *poWK)
-{
-    return GWKRun(
-        poWK, "GWKNearestNoMasksOrDstDensityOnlyByte",
-        GWKResampleNoMasksOrDstDensityOnlyThread<GByte, GRA_NearestNeighbour>);
-}
+/************************************************************************/
+/*                    GWKSeparableComputeWeights()                      */
+/************************************************************************/
 
-static CPLErr GWKBilinearNoMasksOrDstDensityOnlyByte(GDALWarpKernel *poWK)
+// Compute the footprint [iMin, iMax] (relative to iSrc) and the weights of
+// the resampling filter along one axis, consistently with what
+// GWKResampleNoMasksT() (bNoMasksT = true), or GWKResample() and
+// GWKResampleOptimizedLanczos() do. Returns the sum of the weights.
+template <GDALResampleAlg eResample, bool bNoMasksT>
+static double GWKSeparableComputeWeights(int iSrc, double dfDelta,
+                                         int nSrcSize, int nRadius,
+                                         int nFiltInit, double dfScale,
+                                         int &iMin, int &iMax,
+                                         double *padfWeights)
 {
-    return GWKRun(
-        poWK, "GWKBilinearNoMasksOrDstDensityOnlyByte",
-        GWKResampleNoMasksOrDstDensityOnlyHas4SampleThread<GByte,
-                                                           GRA_Bilinear>);
-}
+    double dfWeightSum = 0.0;
+    if constexpr (eResample == GRA_Lanczos)
+    {
+        iMin = nFiltInit;
+        iMax = nRadius;
+        if (iSrc + iMin < 0)
+            iMin = -iSrc;
+        if (iSrc + iMax >= nSrcSize)
+            iMax = nSrcSize - iSrc - 1;
 
-static CPLErr GWKCubicNoMasksOrDstDensityOnlyByte(GDALWarpKernel *poWK)
-{
-    return GWKRun(
-        poWK, "GWKCubicNoMasksOrDstDensityOnlyByte",
+        if (dfScale < 1.0)
+        {
+            while (iMin * dfScale < -3.0)
+                iMin++;
+            while (iMax * dfScale > 3.0)
+                iMax--;
+            for (int i = iMin; i <= iMax; ++i)
+            {
+                padfWeights[i - iMin] = GWKLanczosSinc(i * dfScale);
+                dfWeightSum += padfWeights[i - iMin];
+            }
+        }
+        else
+        {
+            while (iMin - dfDelta < -3.0)
+                iMin++;
+            while (iMax - dfDelta > 3.0)
+                iMax--;
+            for (int i = iMin; i <= iMax; ++i)
+            {
+                padfWeights[i - iMin] = GWKLanczosSinc(i - dfDelta);
+                dfWeightSum += padfWeights[i - iMin];
+            }
+        }
+    }
+    else
+    {
+        const FilterFuncType pfnGetWeight = apfGWKFilter[eResample];
+        iMin = bNoMasksT ? 1 - nRadius : nFiltInit;
+        if (iSrc + iMin < 0)
+            iMin = -iSrc;
+        iMax = nRadius;
+        if (iSrc + iMax >= nSrcSize - 1)
+            iMax = nSrcSize - 1 - iSrc;
+        for (int i = iMin; i <= iMax; ++i)
+        {
+            padfWeights[i - iMin] = pfnGetWeight((i - dfDelta) * dfScale);
+            dfWeightSum += padfWeights[i - iMin];
+        }
+    }
+    return dfWeightSum;
+}
+
+/************************************************************************/
+/*                        GWKHasNoMasksImpl()                           */
+/************************************************************************/
+
+// Whether GDALWarpKernel::PerformWarp() uses GWKResampleNoMasksT() for that
+// working data type and resampling method, when there is no source mask.
+template <class T, GDALResampleAlg eResample>
+static constexpr bool GWKHasNoMasksImpl()
+{
+    constexpr bool bIsShortOrByte = std::is_same<T, GByte>::value ||
+                                    std::is_same<T, GInt16>::value ||
+                                    std::is_same<T, GUInt16>::value;
+    if constexpr (eResample == GRA_Bilinear || eResample == GRA_Cubic)
+    {
+        return bIsShortOrByte || std::is_same<T, float>::value
+#ifdef INSTANTIATE_FLOAT64_SSE2_IMPL
+               || std::is_same<T, double>::value
+#endif
+            ;
+    }
+    else if constexpr (eResample == GRA_CubicSpline)
+    {
+        return bIsShortOrByte;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*           GWKResampleSeparableNoMasksOrDstDensityOnlyThread()        */
+/************************************************************************/
+
+// Two-pass (vertical, then horizontal) evaluation of the bilinear, cubic,
+// cubicspline and lanczos kernels, when there is no source mask. This is
+// designed for affine transforms without rotation, where all pixels of
+// a destination line share the same source line and the source column of a
+// destination column does not depend on the line. The vertically filtered
+// source line is computed once per destination line and band, and then
+// reused by all destination pixels of that line, so the cost per pixel is
+// proportional to the filter width, instead of its area.
+// Pixels that do not follow that pattern (which may happen when the
+// transformer is not affine, or for pixels transformed again on the edges)
+// are computed directly with the full 2D kernel.
+// Edge handling, normalization and conversion to the output data type are
+// the ones of GWKResampleNoMasksOrDstDensityOnlyThreadInternal() if it would
+// have been used, or of GWKRealCaseThread() otherwise.
+template <class T, GDALResampleAlg eResample>
+static void GWKResampleSeparableNoMasksOrDstDensityOnlyThread(void *pData)
+
+{
+    constexpr bool bNoMasksT = GWKHasNoMasksImpl<T, eResample>();
+    GWKJobStruct *psJob = static_cast<GWKJobStruct *>(pData);
+    GDALWarpKernel *poWK = psJob->poWK;
+    const int iYMin = psJob->iYMin;
+    const int iYMax = psJob->iYMax;
+    const double dfMultFactorVerticalShiftPipeline =
+        poWK->bApplyVerticalShift
+            ? CPLAtof(CSLFetchNameValueDef(
+                  poWK->papszWarpOptions, "MULT_FACTOR_VERTICAL_SHIFT_PIPELINE",
+                  "1.0"))
+            : 0.0;
+
+    const int nDstXSize = poWK->nDstXSize;
+    const int nSrcXSize = poWK->nSrcXSize;
+    const int nSrcYSize = poWK->nSrcYSize;
+    const int nBands = poWK->nBands;
+    const int nXRadius = poWK->nXRadius;
+    const int nYRadius = poWK->nYRadius;
+    const int nXDist = 2 * nXRadius + 1;
+    const int nYDist = 2 * nYRadius + 1;
+    const double dfXScale = eResample == GRA_Lanczos
+                                ? poWK->dfXScale
+                                : std::min(poWK->dfXScale, 1.0);
+    const double dfYScale = eResample == GRA_Lanczos
+                                ? poWK->dfYScale
+                                : std::min(poWK->dfYScale, 1.0);
+
+    /* -------------------------------------------------------------------- */
+    /*      Allocate x,y,z coordinate arrays for transformation ... one     */
+    /*      scanlines worth of positions.                                   */
+    /* -------------------------------------------------------------------- */
+
+    // For x, 2 *, because we cache the precomputed values at the end.
+    double *padfX =
+        static_cast<double *>(CPLMalloc(2 * sizeof(double) * nDstXSize));
+    double *padfY =
+        static_cast<double *>(CPLMalloc(sizeof(double) * nDstXSize));
+    double *padfZ =
+        static_cast<double *>(CPLMalloc(sizeof(double) * nDstXSize));
+    int *pabSuccess = static_cast<int *>(CPLMalloc(sizeof(int) * nDstXSize));
+
+    // Horizontal filter of each destination column, recomputed only when
+    // the source X coordinate of the column changes.
+    std::vector<double> adfColSrcX(nDstXSize,
+                                   std::numeric_limits<double>::quiet_NaN());
+    std::vector<int> anColSrcX(nDstXSize);
+    std::vector<int> anColMin(nDstXSize);
+    std::vector<int> anColMax(nDstXSize);
+    std::vector<double> adfColWeightSum(nDstXSize);
+    std::vector<double> adfColWeights(static_cast<size_t>(nDstXSize) * nXDist);
+
+    // 0: skipped, 1: uses the vertically filtered line, 2: full 2D kernel.
+    std::vector<GByte> abyColStatus(nDstXSize);
+    std::vector<double> adfWeightsY(nYDist);
+    std::vector<double> adfPixelWeightsY(nYDist);
+    std::vector<double> adfVertAcc(static_cast<size_t>(nBands) * nSrcXSize);
+
+    // Precompute values.
+    for (int iDstX = 0; iDstX < nDstXSize; iDstX++)
+        padfX[nDstXSize + iDstX] = iDstX + 0.5 + poWK->nDstXOff;
+
+    const double dfSrcCoordPrecision = CPLAtof(CSLFetchNameValueDef(
+        poWK->papszWarpOptions, "SRC_COORD_PRECISION", "0"));
+    const double dfErrorThreshold = CPLAtof(
+        CSLFetchNameValueDef(poWK->papszWarpOptions, "ERROR_THRESHOLD", "0"));
+
+    /* ==================================================================== */
+    /*      Loop over output lines.                                         */
+    /* ==================================================================== */
+    for (int iDstY = iYMin; iDstY < iYMax; iDstY++)
+    {
+        /* --------------------------------------------------------------------
+         */
+        /*      Setup points to transform to source image space. */
+        /* --------------------------------------------------------------------
+         */
+        memcpy(padfX, padfX + nDstXSize, sizeof(double) * nDstXSize);
+        const double dfY = iDstY + 0.5 + poWK->nDstYOff;
+        for (int iDstX = 0; iDstX < nDstXSize; iDstX++)
+            padfY[iDstX] = dfY;
+        memset(padfZ, 0, sizeof(double) * nDstXSize);
+
+        /* --------------------------------------------------------------------
+         */
+        /*      Transform the points from destination pixel/line coordinates */
+        /*      to source pixel/line coordinates. */
+        /* --------------------------------------------------------------------
+         */
+        poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstXSize, padfX,
+                             padfY, padfZ, pabSuccess);
+        if (dfSrcCoordPrecision > 0.0)
+        {
+            GWKRoundSourceCoordinates(
+                nDstXSize, padfX, padfY, padfZ, pabSuccess, dfSrcCoordPrecision,
+                dfErrorThreshold, poWK->pfnTransformer, psJob->pTransformerArg,
+                0.5 + poWK->nDstXOff, iDstY + 0.5 + poWK->nDstYOff);
+        }
+
+        /* --------------------------------------------------------------------
+         */
+        /*      Compute the horizontal filters, and check which pixels */
+        /*      share the source line of the first valid one. */
+        /* --------------------------------------------------------------------
+         */
+        bool bHasRowSrcY = false;
+        double dfRowSrcY = 0.0;
+        int nSrcXMin = nSrcXSize;
+        int nSrcXMax = -1;
+        for (int iDstX = 0; iDstX < nDstXSize; iDstX++)
+        {
+            abyColStatus[iDstX] = 0;
+            GPtrDiff_t iSrcOffset = 0;
+            if (!GWKCheckAndComputeSrcOffsets(psJob, pabSuccess, iDstX, iDstY,
+                                              padfX, padfY, nSrcXSize,
+                                              nSrcYSize, iSrcOffset))
+                continue;
+
+            const double dfSrcX = padfX[iDstX] - poWK->nSrcXOff;
+            const double dfSrcY = padfY[iDstX] - poWK->nSrcYOff;
+            if (dfSrcX != adfColSrcX[iDstX])
+            {
+                const int iSrcX = static_cast<int>(floor(dfSrcX - 0.5));
+                adfColWeightSum[iDstX] =
+                    GWKSeparableComputeWeights<eResample, bNoMasksT>(
+                        iSrcX, dfSrcX - 0.5 - iSrcX, nSrcXSize, nXRadius,
+                        poWK->nFiltInitX, dfXScale, anColMin[iDstX],
+                        anColMax[iDstX],
+                        adfColWeights.data() +
+                            static_cast<size_t>(iDstX) * nXDist);
+                anColSrcX[iDstX] = iSrcX;
+                adfColSrcX[iDstX] = dfSrcX;
+            }
+
+            if (!bHasRowSrcY)
+            {
+                bHasRowSrcY = true;
+                dfRowSrcY = dfSrcY;
+            }
+            if (dfSrcY == dfRowSrcY)
+            {
+                abyColStatus[iDstX] = 1;
+                nSrcXMin =
+                    std::min(nSrcXMin, anColSrcX[iDstX] + anColMin[iDstX]);
+                nSrcXMax =
+                    std::max(nSrcXMax, anColSrcX[iDstX] + anColMax[iDstX]);
+            }
+            else
+            {
+                abyColStatus[iDstX] = 2;
+            }
+        }
+
+        /* --------------------------------------------------------------------
+         */
+        /*      Vertical pass: filter the needed source columns. */
+        /* --------------------------------------------------------------------
+         */
+        double dfRowWeightSum = 0.0;
+        if (nSrcXMin <= nSrcXMax)
+        {
+            const int iSrcY = static_cast<int>(floor(dfRowSrcY - 0.5));
+            int jMin = 0;
+            int jMax = 0;
+            dfRowWeightSum = GWKSeparableComputeWeights<eResample, bNoMasksT>(
+                iSrcY, dfRowSrcY - 0.5 - iSrcY, nSrcYSize, nYRadius,
+                poWK->nFiltInitY, dfYScale, jMin, jMax, adfWeightsY.data());
+
+            for (int iBand = 0; iBand < nBands; iBand++)
+            {
+                const T *pSrcBand =
+                    reinterpret_cast<const T *>(poWK->papabySrcImage[iBand]);
+                double *padfAcc =
+                    adfVertAcc.data() + static_cast<size_t>(iBand) * nSrcXSize;
+                std::fill(padfAcc + nSrcXMin, padfAcc + nSrcXMax + 1, 0.0);
+                for (int j = jMin; j <= jMax; ++j)
+                {
+                    const double dfWeight = adfWeightsY[j - jMin];
+                    const T *pSrc =
+                        pSrcBand +
+                        static_cast<GPtrDiff_t>(iSrcY + j) * nSrcXSize;
+                    for (int i = nSrcXMin; i <= nSrcXMax; ++i)
+                        padfAcc[i] += dfWeight * pSrc[i];
+                }
+            }
+        }
+
+        /* ====================================================================
+         */
+        /*      Loop over pixels in output scanline: horizontal pass. */
+        /* ====================================================================
+         */
+        for (int iDstX = 0; iDstX < nDstXSize; iDstX++)
+        {
+            if (abyColStatus[iDstX] == 0)
+                continue;
+
+            const int iSrcX = anColSrcX[iDstX];
+            const int iMin = anColMin[iDstX];
+            const int iMax = anColMax[iDstX];
+            const double *padfWeightsX =
+                adfColWeights.data() + static_cast<size_t>(iDstX) * nXDist;
+
+            int iSrcY = 0;
+            int jMin = 0;
+            int jMax = 0;
+            double dfWeight = adfColWeightSum[iDstX];
+            if (abyColStatus[iDstX] == 1)
+            {
+                dfWeight *= dfRowWeightSum;
+            }
+            else
+            {
+                const double dfSrcY = padfY[iDstX] - poWK->nSrcYOff;
+                iSrcY = static_cast<int>(floor(dfSrcY - 0.5));
+                dfWeight *= GWKSeparableComputeWeights<eResample, bNoMasksT>(
+                    iSrcY, dfSrcY - 0.5 - iSrcY, nSrcYSize, nYRadius,
+                    poWK->nFiltInitY, dfYScale, jMin, jMax,
+                    adfPixelWeightsY.data());
+            }
+
+            if constexpr (!bNoMasksT)
+            {
+                if (dfWeight < 0.000001)
+                    continue;
+            }
+
+            const GPtrDiff_t iDstOffset =
+                iDstX + static_cast<GPtrDiff_t>(iDstY) * nDstXSize;
+
+            bool bHasFoundDensity = false;
+            for (int iBand = 0; iBand < nBands; iBand++)
+            {
+                double dfAccumulator = 0.0;
+                if (abyColStatus[iDstX] == 1)
+                {
+                    const double *padfAcc =
+                        adfVertAcc.data() +
+                        static_cast<size_t>(iBand) * nSrcXSize + iSrcX;
+                    for (int i = iMin; i <= iMax; ++i)
+                        dfAccumulator += padfWeightsX[i - iMin] * padfAcc[i];
+                }
+                else
+                {
+                    const T *pSrcBand = reinterpret_cast<const T *>(
+                        poWK->papabySrcImage[iBand]);
+                    for (int j = jMin; j <= jMax; ++j)
+                    {
+                        const T *pSrc =
+                            pSrcBand +
+                            static_cast<GPtrDiff_t>(iSrcY + j) * nSrcXSize +
+                            iSrcX;
+                        double dfAccumulatorLocal = 0.0;
+                        for (int i = iMin; i <= iMax; ++i)
+                            dfAccumulatorLocal +=
+                                padfWeightsX[i - iMin] * pSrc[i];
+                        dfAccumulator +=
+                            adfPixelWeightsY[j - jMin] * dfAccumulatorLocal;
+                    }
+                }
+
+                if constexpr (!bNoMasksT)
+                {
+                    double dfValueReal = dfAccumulator;
+                    if (dfWeight < 0.99999 || dfWeight > 1.00001)
+                    {
+                        if constexpr (eResample == GRA_Lanczos)
+                            dfValueReal *= 1.0 / dfWeight;
+                        else
+                            dfValueReal /= dfWeight;
+                    }
+
+                    if (poWK->bApplyVerticalShift)
+                    {
+                        if (!std::isfinite(padfZ[iDstX]))
+                            continue;
+                        // Subtract padfZ[] since the coordinate
+                        // transformation is from target to source
+                        dfValueReal =
+                            dfValueReal * poWK->dfMultFactorVerticalShift -
+                            padfZ[iDstX] * dfMultFactorVerticalShiftPipeline;
+                    }
+
+                    bHasFoundDensity = true;
+                    GWKSetPixelValueRealFromDoubleT<T>(poWK, iBand, iDstOffset,
+                                                       1.0, dfValueReal);
+                }
+                else
+                {
+                    T value = GWKClampValueT<T>(dfAccumulator / dfWeight);
+
+                    if (poWK->bApplyVerticalShift)
+                    {
+                        if (!std::isfinite(padfZ[iDstX]))
+                            continue;
+                        // Subtract padfZ[] since the coordinate
+                        // transformation is from target to source
+                        value = GWKClampValueT<T>(
+                            value * poWK->dfMultFactorVerticalShift -
+                            padfZ[iDstX] * dfMultFactorVerticalShiftPipeline);
+                    }
+
+                    if (poWK->pafDstDensity)
+                        poWK->pafDstDensity[iDstOffset] = 1.0f;
+
+                    reinterpret_cast<T *>(
+                        poWK->papabyDstImage[iBand])[iDstOffset] = value;
+                }
+            }
+
+            if (bHasFoundDensity)
+                GWKOverlayDensity(poWK, iDstOffset, 1.0);
+        }
+
+        /* --------------------------------------------------------------------
+         */
+        /*      Report progress to the user, and optionally cancel out. */
+        /* --------------------------------------------------------------------
+         */
+        if (psJob->pfnProgress && psJob->pfnProgress(psJob))
+            break;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Cleanup and return.                                             */
+    /* -------------------------------------------------------------------- */
+    CPLFree(padfX);
+    CPLFree(padfY);
+    CPLFree(padfZ);
+    CPLFree(pabSuccess);
+}
+
+/************************************************************************/
+/*                    GWKUseSeparableResampling()                       */
+/************************************************************************/
+
+// Whether GWKSeparableNoMasksOrDstDensityOnly() can be used.
+static bool GWKUseSeparableResampling(const GDALWarpKernel *poWK)
+{
+    switch (poWK->eResample)
+    {
+        case GRA_Bilinear:
+        case GRA_Cubic:
+            // The 4 samples formulas are used in that case.
+            if (poWK->dfXScale >= 0.95 && poWK->dfYScale >= 0.95)
+                return false;
+            break;
+
+        case GRA_CubicSpline:
+        case GRA_Lanczos:
+            break;
+
+        default:
+            return false;
+    }
+
+    // GWKRealCaseThread() uses nearest neighbour, and GWKResampleNoMasksT()
+    // falls back to bilinear in those situations.
+    if (GDALDataTypeIsComplex(poWK->eWorkingDataType) ||
+        poWK->nSrcXSize == 1 || poWK->nSrcYSize == 1 ||
+        poWK->nXRadius > poWK->nSrcXSize || poWK->nYRadius > poWK->nSrcYSize)
+        return false;
+
+    // for debug/testing purposes
+    static CPLConfigOptionCache oUseAffineOptimization(
+        "GDAL_WARP_USE_AFFINE_OPTIMIZATION", "YES");
+    return CPLTestBool(oUseAffineOptimization.Get()) &&
+           GDALTransformIsAffineNoRotation(poWK->pfnTransformer,
+                                           poWK->pTransformerArg);
+}
+
+/************************************************************************/
+/*                 GWKSeparableNoMasksOrDstDensityOnly()                */
+/************************************************************************/
+
+template <GDALResampleAlg eResample>
+static CPLErr GWKSeparableNoMasksOrDstDensityOnly(GDALWarpKernel *poWK)
+{
+    const char *pszFuncName = "GWKSeparableNoMasksOrDstDensityOnly";
+    switch (poWK->eWorkingDataType)
+    {
+        case GDT_Byte:
+            return GWKRun(poWK, pszFuncName,
+                          GWKResampleSeparableNoMasksOrDstDensityOnlyThread<
+                              GByte, eResample>);
+        case GDT_Int8:
+            return GWKRun(poWK, pszFuncName,
+                          GWKResampleSeparableNoMasksOrDstDensityOnlyThread<
+                              GInt8, eResample>);
+        case GDT_Int16:
+            return GWKRun(poWK, pszFuncName,
+                          GWKResampleSeparableNoMasksOrDstDensityOnlyThread<
+                              GInt16, eResample>);
+        case GDT_UInt16:
+            return GWKRun(poWK, pszFuncName,
+                          GWKResampleSeparableNoMasksOrDstDensityOnlyThread<
+                              GUInt16, eResample>);
+        case GDT_Int32:
+            return GWKRun(poWK, pszFuncName,
+                          GWKResampleSeparableNoMasksOrDstDensityOnlyThread<
+                              GInt32, eResample>);
+        case GDT_UInt32:
+            return GWKRun(poWK, pszFuncName,
+                          GWKResampleSeparableNoMasksOrDstDensityOnlyThread<
+                              GUInt32, eResample>);
+        case GDT_Int64:
+            return GWKRun(poWK, pszFuncName,
+                          GWKResampleSeparableNoMasksOrDstDensityOnlyThread<
+                              std::int64_t, eResample>);
+        case GDT_UInt64:
+            return GWKRun(poWK, pszFuncName,
+                          GWKResampleSeparableNoMasksOrDstDensityOnlyThread<
+                              std::uint64_t, eResample>);
+        case GDT_Float32:
+            return GWKRun(poWK, pszFuncName,
+                          GWKResampleSeparableNoMasksOrDstDensityOnlyThread<
+                              float, eResample>);
+        case GDT_Float64:
+            return GWKRun(poWK, pszFuncName,
+                          GWKResampleSeparableNoMasksOrDstDensityOnlyThread<
+                              double, eResample>);
+        default:
+            break;
+    }
+    CPLAssert(false);
+    return CE_Failure;
+}
+
+static CPLErr GWKSeparableNoMasksOrDstDensityOnly(GDALWarpKernel *poWK)
+{
+    switch (poWK->eResample)
+    {
+        case GRA_Bilinear:
+            return GWKSeparableNoMasksOrDstDensityOnly<GRA_Bilinear>(poWK);
+        case GRA_Cubic:
+            return GWKSeparableNoMasksOrDstDensityOnly<GRA_Cubic>(poWK);
+        case GRA_CubicSpline:
+            return GWKSeparableNoMasksOrDstDensityOnly<GRA_CubicSpline>(poWK);
+        case GRA_Lanczos:
+            return GWKSeparableNoMasksOrDstDensityOnly<GRA_Lanczos>(poWK);
+        default:
+            break;
+    }
+    CPLAssert(false);
+    return CE_Failure;
+}
+
+static CPLErr GWKNearestNoMasksOrDstDensityOnlyByte(GDALWarpKernel *poWK)
+{
+    return GWKRun(
+        poWK, "GWKNearestNoMasksOrDstDensityOnlyByte",
+        GWKResampleNoMasksOrDstDensityOnlyThread<GByte, GRA_NearestNeighbour>);
+}
+
+static CPLErr GWKBilinearNoMasksOrDstDensityOnlyByte(GDALWarpKernel *poWK)
+{
+    return GWKRun(
+        poWK, "GWKBilinearNoMasksOrDstDensityOnlyByte",
+        GWKResampleNoMasksOrDstDensityOnlyHas4SampleThread<GByte,
+                                                           GRA_Bilinear>);
+}
+
+static CPLErr GWKCubicNoMasksOrDstDensityOnlyByte(GDALWarpKernel *poWK)
+{
+    return GWKRun(
+        poWK, "GWKCubicNoMasksOrDstDensityOnlyByte",
         GWKResampleNoMasksOrDstDensityOnlyHas4SampleThread<GByte, GRA_Cubic>);
 }
 
@@ -7630,12 +8370,13 @@ static void GWKSumPreservingThread(void *pData)
     GDALWarpKernel *poWK = psJob->poWK;
     const int iYMin = psJob->iYMin;
     const int iYMax = psJob->iYMax;
+    // for debug/testing purposes
+    static CPLConfigOptionCache oUseAffineOptimization(
+        "GDAL_WARP_USE_AFFINE_OPTIMIZATION", "YES");
     const bool bIsAffineNoRotation =
         GDALTransformIsAffineNoRotation(poWK->pfnTransformer,
                                         poWK->pTransformerArg) &&
-        // for debug/testing purposes
-        CPLTestBool(
-            CPLGetConfigOption("GDAL_WARP_USE_AFFINE_OPTIMIZATION", "YES"));
+        CPLTestBool(oUseAffineOptimization.Get());
 
     const int nDstXSize = poWK->nDstXSize;
     const int nSrcXSize = poWK->nSrcXSize;
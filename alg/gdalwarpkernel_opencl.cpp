@@ -41,6 +41,9 @@
 #include <limits.h>
 #include <float.h>
 #include <limits>
+#include <map>
+#include <mutex>
+#include <string>
 #include <vector>
 #include "cpl_string.h"
 #include "gdalwarpkernel_opencl.h"
@@ -441,6 +444,83 @@ static cl_device_id get_device(OCLVendor *peVendor)
     return device.id;
 }
 
+/*
+ Device, context and compiled programs shared by all the warper environments,
+ so that they are not recreated for each chunk. Creating a context and
+ building a program are typically much more expensive than warping a chunk.
+ The OpenCL API is thread-safe for those objects, except for building a
+ program, which is done while holding the mutex.
+ */
+namespace
+{
+struct OCLSharedEnv
+{
+    std::mutex oMutex{};
+    bool bInitialized = false;
+    cl_device_id dev = nullptr;
+    OCLVendor eCLVendor = VENDOR_OTHER;
+    cl_context context = nullptr;
+    // Programs, indexed by their source selector and build options.
+    std::map<std::string, cl_program> oMapPrograms{};
+};
+}  // namespace
+
+// Maximum number of programs kept in OCLSharedEnv::oMapPrograms.
+constexpr size_t MAX_CACHED_PROGRAMS = 64;
+
+static OCLSharedEnv &get_shared_env()
+{
+    // Intentionally never destroyed, since the OpenCL implementation might
+    // already be unloaded at process exit.
+    static OCLSharedEnv *psEnv = new OCLSharedEnv();
+    return *psEnv;
+}
+
+/*
+ Return the shared context (with an extra reference for the caller) and the
+ device it was created on, or nullptr if no suitable device is available.
+ */
+static cl_context get_shared_context(cl_device_id *pDev, OCLVendor *peVendor)
+{
+    OCLSharedEnv &sEnv = get_shared_env();
+    std::lock_guard<std::mutex> oLock(sEnv.oMutex);
+    if (!sEnv.bInitialized)
+    {
+        sEnv.bInitialized = true;
+        sEnv.dev = get_device(&sEnv.eCLVendor);
+        if (sEnv.dev != nullptr)
+        {
+            cl_bool bool_flag = CL_FALSE;
+            size_t sz = 0;
+            cl_int err =
+                clGetDeviceInfo(sEnv.dev, CL_DEVICE_IMAGE_SUPPORT,
+                                sizeof(cl_bool), &bool_flag, &sz);
+            if (err != CL_SUCCESS || !bool_flag)
+            {
+                CPLDebug("OpenCL", "No image support on selected device.");
+            }
+            else
+            {
+                sEnv.context = clCreateContext(nullptr, 1, &(sEnv.dev),
+                                               nullptr, nullptr, &err);
+                if (err != CL_SUCCESS)
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "Error at file %s line %d: %s", __FILE__,
+                             __LINE__, getCLErrorString(err));
+                    sEnv.context = nullptr;
+                }
+            }
+        }
+    }
+    if (sEnv.context == nullptr)
+        return nullptr;
+    clRetainContext(sEnv.context);
+    *pDev = sEnv.dev;
+    *peVendor = sEnv.eCLVendor;
+    return sEnv.context;
+}
+
 /*
  Given that not all OpenCL devices support the same image formats, we need to
  make do with what we have. This leads to wasted space, but as OpenCL matures
@@ -1415,12 +1495,6 @@ __kernel void resamp(__read_only image2d_t srcCoords,
         snprintf(&progBuf[0], PROGBUF_SIZE, "%s\n%s", kernGenFuncs,
                  kernResampler);
 
-    // Actually make the program from assembled source
-    const char *pszProgBuf = progBuf.c_str();
-    program = clCreateProgramWithSource(warper->context, 1, &pszProgBuf,
-                                        nullptr, &err);
-    handleErrGoto(err, error_final);
-
     // Assemble the compiler arg string for speed. All invariants should be
     // defined here.
     snprintf(
@@ -1447,6 +1521,26 @@ __kernel void resamp(__read_only image2d_t srcCoords,
         warper->resampAlg == OCL_CubicSpline,
         warper->nBandSrcValidCL != nullptr, warper->coordMult);
 
+    // Reuse the program if it has already been built with the same options,
+    // which is typically the case for chunks of the same size.
+    OCLSharedEnv &sEnv = get_shared_env();
+    std::lock_guard<std::mutex> oLock(sEnv.oMutex);
+    const std::string osKey(std::to_string(warper->resampAlg) + ' ' +
+                            buffer.c_str());
+    const auto oIter = sEnv.oMapPrograms.find(osKey);
+    if (oIter != sEnv.oMapPrograms.end())
+    {
+        kernel = clCreateKernel(oIter->second, "resamp", &err);
+        handleErrGoto(err, error_final);
+        return kernel;
+    }
+
+    // Actually make the program from assembled source
+    const char *pszProgBuf = progBuf.c_str();
+    program = clCreateProgramWithSource(warper->context, 1, &pszProgBuf,
+                                        nullptr, &err);
+    handleErrGoto(err, error_final);
+
     (*clErr) = err = clBuildProgram(program, 1, &(warper->dev), buffer.data(),
                                     nullptr, nullptr);
 
@@ -1484,8 +1578,14 @@ __kernel void resamp(__read_only image2d_t srcCoords,
     kernel = clCreateKernel(program, "resamp", &err);
     handleErrGoto(err, error_free_program);
 
-    err = clReleaseProgram(program);
-    handleErrGoto(err, error_final);
+    // The cache owns the reference to the program. Kernels keep their own.
+    if (sEnv.oMapPrograms.size() == MAX_CACHED_PROGRAMS)
+    {
+        for (auto &oPair : sEnv.oMapPrograms)
+            clReleaseProgram(oPair.second);
+        sEnv.oMapPrograms.clear();
+    }
+    sEnv.oMapPrograms[osKey] = program;
 
     return kernel;
 
@@ -2266,23 +2366,14 @@ struct oclWarper *GDALWarpKernelOpenCL_createEnv(
     size_t maxWidth = 0, maxHeight = 0;
     cl_int err = CL_SUCCESS;
     size_t fmtSize, sz;
-    cl_device_id device;
-    cl_bool bool_flag;
+    cl_device_id device = nullptr;
     OCLVendor eCLVendor = VENDOR_OTHER;
 
     // Do we have a suitable OpenCL device?
-    device = get_device(&eCLVendor);
-    if (device == nullptr)
+    cl_context context = get_shared_context(&device, &eCLVendor);
+    if (context == nullptr)
         return nullptr;
 
-    err = clGetDeviceInfo(device, CL_DEVICE_IMAGE_SUPPORT, sizeof(cl_bool),
-                          &bool_flag, &sz);
-    if (err != CL_SUCCESS || !bool_flag)
-    {
-        CPLDebug("OpenCL", "No image support on selected device.");
-        return nullptr;
-    }
-
     // Set up warper environment.
     warper =
         static_cast<struct oclWarper *>(CPLCalloc(1, sizeof(struct oclWarper)));
@@ -2317,10 +2408,7 @@ struct oclWarper *GDALWarpKernelOpenCL_createEnv(
     warper->kern4 = nullptr;
 
     warper->dev = device;
-
-    warper->context =
-        clCreateContext(nullptr, 1, &(warper->dev), nullptr, nullptr, &err);
-    handleErrGoto(err, error_label);
+    warper->context = context;
 #if __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6) || defined(__clang__)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
@@ -38,9 +38,11 @@
 
 #include <algorithm>
 #include <limits>
+#include <condition_variable>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "cpl_config.h"
 #include "cpl_conv.h"
@@ -48,6 +50,7 @@
 #include "cpl_mask.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
+#include "cpl_trace.h"
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_priv.h"
@@ -1081,6 +1084,13 @@ static void ChunkThreadMain(void *pThreadData)
  * internally this method uses multiple threads to interleave input/output
  * for one region while the processing is being done for another.
  *
+ * Starting with GDAL 3.9, if the NUM_CHUNK_WORKERS warping option is set to
+ * a value greater than 1 (or ALL_CPUS), that number of workers process
+ * chunks concurrently instead: each one pulls the next pending chunk, reads
+ * its input and output data while holding an I/O lock, then warps it
+ * concurrently with the other workers. The destination data is written in
+ * the order of the chunk list.
+ *
  * @param nDstXOff X offset to window of destination data to be produced.
  * @param nDstYOff Y offset to window of destination data to be produced.
  * @param nDstXSize Width of output window on destination file to be produced.
@@ -1093,6 +1103,25 @@ CPLErr GDALWarpOperation::ChunkAndWarpMulti(int nDstXOff, int nDstYOff,
                                             int nDstXSize, int nDstYSize)
 
 {
+    /* -------------------------------------------------------------------- */
+    /*      Use a pool of chunk workers if asked to, provided that there    */
+    /*      is no application callback that might not be thread-safe.       */
+    /* -------------------------------------------------------------------- */
+    const char *pszChunkWorkers =
+        CSLFetchNameValue(psOptions->papszWarpOptions, "NUM_CHUNK_WORKERS");
+    if (pszChunkWorkers && psOptions->pfnPreWarpChunkProcessor == nullptr &&
+        psOptions->pfnPostWarpChunkProcessor == nullptr)
+    {
+        const int nWorkers = std::min(
+            128, EQUAL(pszChunkWorkers, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszChunkWorkers));
+        if (nWorkers > 1)
+        {
+            return ChunkAndWarpWithWorkers(nDstXOff, nDstYOff, nDstXSize,
+                                           nDstYSize, nWorkers);
+        }
+    }
+
     hIOMutex = CPLCreateMutex();
     hWarpMutex = CPLCreateMutex();
 
@@ -1245,6 +1274,378 @@ CPLErr GDALChunkAndWarpMulti(GDALWarpOperationH hOperation, int nDstXOff,
         ->ChunkAndWarpMulti(nDstXOff, nDstYOff, nDstXSize, nDstYSize);
 }
 
+/************************************************************************/
+/*                        GDALWarpChunkScheduler                        */
+/************************************************************************/
+
+struct GDALWarpChunkWorker;
+
+namespace
+{
+struct GDALWarpPendingWrite
+{
+    int nDstXOff;
+    int nDstYOff;
+    int nDstXSize;
+    int nDstYSize;
+    void *pDstBuffer;
+};
+
+// State shared by the chunk workers of ChunkAndWarpWithWorkers().
+struct GDALWarpChunkScheduler
+{
+    std::mutex oMutex{};
+    std::condition_variable oCV{};
+
+    int nChunkCount = 0;
+    int nWorkerCount = 0;
+    std::vector<double> adfChunkProgressBase{};
+
+    // Index of the next chunk to hand out to a worker.
+    int nNextChunk = 0;
+    // Warped chunks waiting for their predecessors to be written.
+    std::map<int, GDALWarpPendingWrite> oMapPendingWrites{};
+    int nNextChunkToWrite = 0;
+
+    bool bStop = false;
+    CPLErr eErr = CE_None;
+
+    const std::vector<GDALWarpChunkWorker> *pasWorkers = nullptr;
+    GDALProgressFunc pfnProgress = nullptr;
+    void *pProgressArg = nullptr;
+    double dfProgressDone = 0.0;
+    double dfLastProgress = 0.0;
+
+    bool ReportProgress();
+};
+}  // namespace
+
+struct GDALWarpChunkWorker
+{
+    GDALWarpOperation *poOperation = nullptr;
+    GDALWarpChunkScheduler *psScheduler = nullptr;
+    CPLJoinableThread *hThreadHandle = nullptr;
+
+    void *pTransformerArg = nullptr;
+    bool bOwnTransformerArg = false;
+    void *psThreadData = nullptr;
+
+    // Progress of the current chunk, in the [0,1] range of the whole
+    // operation.
+    double dfProgressBase = 0.0;
+    double dfProgressCur = 0.0;
+};
+
+/************************************************************************/
+/*                 GDALWarpChunkScheduler::ReportProgress()             */
+/************************************************************************/
+
+// Report the combined progress of all workers. Must be called with oMutex
+// held. Returns false if the user asked to stop.
+bool GDALWarpChunkScheduler::ReportProgress()
+{
+    double dfProgress = dfProgressDone;
+    for (const auto &sWorker : *pasWorkers)
+        dfProgress += sWorker.dfProgressCur;
+    if (dfProgress > dfLastProgress)
+    {
+        dfLastProgress = dfProgress;
+        if (!pfnProgress(std::min(1.0, dfProgress), "", pProgressArg))
+        {
+            bStop = true;
+            oCV.notify_all();
+            return false;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                    GDALWarpChunkWorkerProgress()                     */
+/************************************************************************/
+
+// Progress callback of the warp kernel of a chunk worker.
+static int CPL_STDCALL GDALWarpChunkWorkerProgress(double dfComplete,
+                                                   const char *,
+                                                   void *pProgressArg)
+{
+    auto psWorker = static_cast<GDALWarpChunkWorker *>(pProgressArg);
+    GDALWarpChunkScheduler *psScheduler = psWorker->psScheduler;
+    std::lock_guard<std::mutex> oLock(psScheduler->oMutex);
+    if (psScheduler->bStop)
+        return FALSE;
+    psWorker->dfProgressCur =
+        std::max(0.0, dfComplete - psWorker->dfProgressBase);
+    return psScheduler->ReportProgress();
+}
+
+/************************************************************************/
+/*                      ChunkAndWarpWithWorkers()                       */
+/************************************************************************/
+
+// Implementation of ChunkAndWarpMulti() with nWorkers chunk workers.
+CPLErr GDALWarpOperation::ChunkAndWarpWithWorkers(int nDstXOff, int nDstYOff,
+                                                  int nDstXSize,
+                                                  int nDstYSize,
+                                                  int nWorkers)
+{
+    hIOMutex = CPLCreateMutex();
+    hWarpMutex = CPLCreateMutex();
+
+    CPLReleaseMutex(hIOMutex);
+    CPLReleaseMutex(hWarpMutex);
+
+    /* -------------------------------------------------------------------- */
+    /*      Collect the list of chunks, each worker getting a share of the  */
+    /*      memory limit.                                                   */
+    /* -------------------------------------------------------------------- */
+    const double dfWarpMemoryLimit = psOptions->dfWarpMemoryLimit;
+    psOptions->dfWarpMemoryLimit = dfWarpMemoryLimit / nWorkers;
+    CollectChunkList(nDstXOff, nDstYOff, nDstXSize, nDstYSize);
+    psOptions->dfWarpMemoryLimit = dfWarpMemoryLimit;
+
+    GDALWarpChunkScheduler oScheduler;
+    oScheduler.nChunkCount = nChunkListCount;
+    oScheduler.pfnProgress = psOptions->pfnProgress;
+    oScheduler.pProgressArg = psOptions->pProgressArg;
+    const double dfTotalPixels = static_cast<double>(nDstXSize) * nDstYSize;
+    double dfPixelsProcessed = 0.0;
+    for (int iChunk = 0; iChunk < nChunkListCount; iChunk++)
+    {
+        oScheduler.adfChunkProgressBase.push_back(dfPixelsProcessed /
+                                                  dfTotalPixels);
+        dfPixelsProcessed += pasChunkList[iChunk].dsx *
+                             static_cast<double>(pasChunkList[iChunk].dsy);
+    }
+    oScheduler.adfChunkProgressBase.push_back(1.0);
+
+    /* -------------------------------------------------------------------- */
+    /*      Each worker gets its own transformer and kernel thread data,    */
+    /*      since the original transformer is used to compute source        */
+    /*      windows.                                                        */
+    /* -------------------------------------------------------------------- */
+    nWorkers = std::max(1, std::min(nWorkers, nChunkListCount));
+    std::vector<GDALWarpChunkWorker> asWorkers(nWorkers);
+    int nCreatedWorkers = 0;
+    for (; nCreatedWorkers < nWorkers; ++nCreatedWorkers)
+    {
+        auto &sWorker = asWorkers[nCreatedWorkers];
+        sWorker.poOperation = this;
+        sWorker.psScheduler = &oScheduler;
+        sWorker.pTransformerArg =
+            psOptions->pTransformerArg
+                ? GDALCloneTransformer(psOptions->pTransformerArg)
+                : nullptr;
+        if (sWorker.pTransformerArg == nullptr)
+            break;
+        sWorker.bOwnTransformerArg = true;
+        sWorker.psThreadData = GWKThreadsCreate(psOptions->papszWarpOptions,
+                                                psOptions->pfnTransformer,
+                                                sWorker.pTransformerArg);
+    }
+    if (nCreatedWorkers == 0)
+    {
+        // The transformer cannot be cloned: use a single worker sharing the
+        // transformer with ComputeSourceWindow(), which is then called from
+        // the same thread.
+        CPLDebug("WARP", "Cannot clone transformer. Using a single worker");
+        asWorkers[0].pTransformerArg = psOptions->pTransformerArg;
+        asWorkers[0].bOwnTransformerArg = false;
+        asWorkers[0].psThreadData = psThreadData;
+        nCreatedWorkers = 1;
+    }
+    asWorkers.resize(nCreatedWorkers);
+    oScheduler.nWorkerCount = nCreatedWorkers;
+    oScheduler.pasWorkers = &asWorkers;
+    CPLDebug("WARP", "Using %d chunk workers for %d chunks", nCreatedWorkers,
+             nChunkListCount);
+
+    /* -------------------------------------------------------------------- */
+    /*      Launch the workers and wait for them to complete.               */
+    /* -------------------------------------------------------------------- */
+    const int bReportTimingsBackup = bReportTimings;
+    bReportTimings = FALSE;
+    for (auto &sWorker : asWorkers)
+    {
+        sWorker.hThreadHandle =
+            CPLCreateJoinableThread(ChunkWorkerThreadMain, &sWorker);
+        if (sWorker.hThreadHandle == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "CPLCreateJoinableThread() failed in ChunkAndWarpMulti()");
+            std::lock_guard<std::mutex> oLock(oScheduler.oMutex);
+            oScheduler.bStop = true;
+            oScheduler.eErr = CE_Failure;
+            oScheduler.oCV.notify_all();
+            break;
+        }
+    }
+
+    for (auto &sWorker : asWorkers)
+    {
+        if (sWorker.hThreadHandle)
+            CPLJoinThread(sWorker.hThreadHandle);
+        if (sWorker.bOwnTransformerArg)
+        {
+            GWKThreadsEnd(sWorker.psThreadData);
+            GDALDestroyTransformer(sWorker.pTransformerArg);
+        }
+    }
+    bReportTimings = bReportTimingsBackup;
+
+    // Remaining pending writes, if we stopped on an error.
+    for (auto &oIter : oScheduler.oMapPendingWrites)
+        DestroyDestinationBuffer(oIter.second.pDstBuffer);
+
+    WipeChunkList();
+
+    if (oScheduler.eErr == CE_None)
+        psOptions->pfnProgress(1.0, "", psOptions->pProgressArg);
+
+    return oScheduler.eErr;
+}
+
+/************************************************************************/
+/*                       ChunkWorkerThreadMain()                        */
+/************************************************************************/
+
+void GDALWarpOperation::ChunkWorkerThreadMain(void *pThreadData)
+{
+    auto psWorker = static_cast<GDALWarpChunkWorker *>(pThreadData);
+    psWorker->poOperation->RunChunkWorker(psWorker);
+}
+
+/************************************************************************/
+/*                          RunChunkWorker()                            */
+/************************************************************************/
+
+void GDALWarpOperation::RunChunkWorker(GDALWarpChunkWorker *psWorker)
+{
+    GDALWarpChunkScheduler *psScheduler = psWorker->psScheduler;
+
+    while (true)
+    {
+        /* ---------------------------------------------------------------- */
+        /*      Pick the next chunk, unless too many warped chunks are      */
+        /*      already waiting to be written.                              */
+        /* ---------------------------------------------------------------- */
+        int iChunk;
+        {
+            std::unique_lock<std::mutex> oLock(psScheduler->oMutex);
+            psScheduler->oCV.wait(
+                oLock,
+                [psScheduler]
+                {
+                    return psScheduler->bStop ||
+                           static_cast<int>(
+                               psScheduler->oMapPendingWrites.size()) <
+                               psScheduler->nWorkerCount;
+                });
+            if (psScheduler->bStop ||
+                psScheduler->nNextChunk == psScheduler->nChunkCount)
+                break;
+            iChunk = psScheduler->nNextChunk++;
+            psWorker->dfProgressBase =
+                psScheduler->adfChunkProgressBase[iChunk];
+            psWorker->dfProgressCur = 0.0;
+        }
+
+        const GDALWarpChunk *pasThisChunk = pasChunkList + iChunk;
+        const double dfProgressScale =
+            psScheduler->adfChunkProgressBase[iChunk + 1] -
+            psScheduler->adfChunkProgressBase[iChunk];
+
+        int bDstBufferInitialized = FALSE;
+        void *pDstBuffer = CreateDestinationBuffer(
+            pasThisChunk->dsx, pasThisChunk->dsy, &bDstBufferInitialized);
+        CPLErr eErr = pDstBuffer ? CE_None : CE_Failure;
+
+        /* ---------------------------------------------------------------- */
+        /*      Read and warp the chunk. WarpRegionToBufferInternal()       */
+        /*      releases the IO mutex while the kernel runs.                */
+        /* ---------------------------------------------------------------- */
+        if (eErr == CE_None && !CPLAcquireMutex(hIOMutex, 600.0))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Failed to acquire IOMutex in WarpRegion().");
+            DestroyDestinationBuffer(pDstBuffer);
+            eErr = CE_Failure;
+        }
+        else if (eErr == CE_None)
+        {
+            if (!bDstBufferInitialized)
+                eErr = ReadDestinationBuffer(
+                    pasThisChunk->dx, pasThisChunk->dy, pasThisChunk->dsx,
+                    pasThisChunk->dsy, pDstBuffer);
+            if (eErr == CE_None)
+                eErr = WarpRegionToBufferInternal(
+                    pasThisChunk->dx, pasThisChunk->dy, pasThisChunk->dsx,
+                    pasThisChunk->dsy, pDstBuffer, psOptions->eWorkingDataType,
+                    pasThisChunk->sx, pasThisChunk->sy, pasThisChunk->ssx,
+                    pasThisChunk->ssy, pasThisChunk->sExtraSx,
+                    pasThisChunk->sExtraSy, psWorker->dfProgressBase,
+                    dfProgressScale, psWorker);
+
+            /* ------------------------------------------------------------ */
+            /*      Write this chunk, and the following ones that were      */
+            /*      waiting for it, in the order of the chunk list.         */
+            /* ------------------------------------------------------------ */
+            if (eErr == CE_None)
+            {
+                std::unique_lock<std::mutex> oLock(psScheduler->oMutex);
+                psScheduler->oMapPendingWrites[iChunk] = {
+                    pasThisChunk->dx, pasThisChunk->dy, pasThisChunk->dsx,
+                    pasThisChunk->dsy, pDstBuffer};
+                while (eErr == CE_None && !psScheduler->bStop)
+                {
+                    auto oIter = psScheduler->oMapPendingWrites.find(
+                        psScheduler->nNextChunkToWrite);
+                    if (oIter == psScheduler->oMapPendingWrites.end())
+                        break;
+                    const GDALWarpPendingWrite sWrite = oIter->second;
+                    psScheduler->oMapPendingWrites.erase(oIter);
+                    oLock.unlock();
+                    eErr = WriteDestinationBuffer(
+                        sWrite.nDstXOff, sWrite.nDstYOff, sWrite.nDstXSize,
+                        sWrite.nDstYSize, sWrite.pDstBuffer);
+                    DestroyDestinationBuffer(sWrite.pDstBuffer);
+                    oLock.lock();
+                    psScheduler->nNextChunkToWrite++;
+                    psScheduler->oCV.notify_all();
+                }
+            }
+            else
+            {
+                DestroyDestinationBuffer(pDstBuffer);
+            }
+            CPLReleaseMutex(hIOMutex);
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Report progress, or stop all workers on error.              */
+        /* ---------------------------------------------------------------- */
+        std::lock_guard<std::mutex> oLock(psScheduler->oMutex);
+        if (eErr != CE_None)
+        {
+            if (psScheduler->eErr == CE_None)
+                psScheduler->eErr = eErr;
+            psScheduler->bStop = true;
+            psScheduler->oCV.notify_all();
+            break;
+        }
+        psScheduler->dfProgressDone += dfProgressScale;
+        psWorker->dfProgressBase = 0.0;
+        psWorker->dfProgressCur = 0.0;
+        if (!psScheduler->ReportProgress())
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            if (psScheduler->eErr == CE_None)
+                psScheduler->eErr = CE_Failure;
+            break;
+        }
+    }
+}
+
 /************************************************************************/
 /*                           WipeChunkList()                            */
 /************************************************************************/
@@ -1571,6 +1972,15 @@ CPLErr GDALWarpOperation::WarpRegion(
     double dfSrcYExtraSize, double dfProgressBase, double dfProgressScale)
 
 {
+    CPLTraceSpan oSpan("warp", "GDALWarpOperation::WarpRegion");
+    if (oSpan.IsEnabled())
+    {
+        oSpan.AddArg("dst_window", CPLSPrintf("%d,%d,%d,%d", nDstXOff, nDstYOff,
+                                              nDstXSize, nDstYSize));
+        oSpan.AddArg("src_window", CPLSPrintf("%d,%d,%d,%d", nSrcXOff, nSrcYOff,
+                                              nSrcXSize, nSrcYSize));
+    }
+
     ReportTiming(nullptr);
 
     /* -------------------------------------------------------------------- */
@@ -1588,28 +1998,11 @@ CPLErr GDALWarpOperation::WarpRegion(
     /*      If we aren't doing fixed initialization of the output buffer    */
     /*      then read it from disk so we can overlay on existing imagery.   */
     /* -------------------------------------------------------------------- */
-    GDALDataset *poDstDS = GDALDataset::FromHandle(psOptions->hDstDS);
     if (!bDstBufferInitialized)
     {
-        CPLErr eErr = CE_None;
-        if (psOptions->nBandCount == 1)
-        {
-            // Particular case to simplify the stack a bit.
-            // TODO(rouault): Need an explanation of what and why r34502 helps.
-            eErr = poDstDS->GetRasterBand(psOptions->panDstBands[0])
-                       ->RasterIO(GF_Read, nDstXOff, nDstYOff, nDstXSize,
-                                  nDstYSize, pDstBuffer, nDstXSize, nDstYSize,
-                                  psOptions->eWorkingDataType, 0, 0, nullptr);
-        }
-        else
-        {
-            eErr = poDstDS->RasterIO(GF_Read, nDstXOff, nDstYOff, nDstXSize,
-                                     nDstYSize, pDstBuffer, nDstXSize,
-                                     nDstYSize, psOptions->eWorkingDataType,
-                                     psOptions->nBandCount,
-                                     psOptions->panDstBands, 0, 0, 0, nullptr);
-        }
-
+        CPLTraceSpan oReadSpan("warp", "Output buffer read");
+        const CPLErr eErr = ReadDestinationBuffer(
+            nDstXOff, nDstYOff, nDstXSize, nDstYSize, pDstBuffer);
         if (eErr != CE_None)
         {
             DestroyDestinationBuffer(pDstBuffer);
@@ -1632,34 +2025,9 @@ CPLErr GDALWarpOperation::WarpRegion(
     /* -------------------------------------------------------------------- */
     if (eErr == CE_None)
     {
-        if (psOptions->nBandCount == 1)
-        {
-            // Particular case to simplify the stack a bit.
-            eErr = poDstDS->GetRasterBand(psOptions->panDstBands[0])
-                       ->RasterIO(GF_Write, nDstXOff, nDstYOff, nDstXSize,
-                                  nDstYSize, pDstBuffer, nDstXSize, nDstYSize,
-                                  psOptions->eWorkingDataType, 0, 0, nullptr);
-        }
-        else
-        {
-            eErr = poDstDS->RasterIO(GF_Write, nDstXOff, nDstYOff, nDstXSize,
-                                     nDstYSize, pDstBuffer, nDstXSize,
-                                     nDstYSize, psOptions->eWorkingDataType,
-                                     psOptions->nBandCount,
-                                     psOptions->panDstBands, 0, 0, 0, nullptr);
-        }
-
-        if (eErr == CE_None &&
-            CPLFetchBool(psOptions->papszWarpOptions, "WRITE_FLUSH", false))
-        {
-            const CPLErr eOldErr = CPLGetLastErrorType();
-            const CPLString osLastErrMsg = CPLGetLastErrorMsg();
-            GDALFlushCache(psOptions->hDstDS);
-            const CPLErr eNewErr = CPLGetLastErrorType();
-            if (eNewErr != eOldErr ||
-                osLastErrMsg.compare(CPLGetLastErrorMsg()) != 0)
-                eErr = CE_Failure;
-        }
+        CPLTraceSpan oWriteSpan("warp", "Output buffer write");
+        eErr = WriteDestinationBuffer(nDstXOff, nDstYOff, nDstXSize, nDstYSize,
+                                      pDstBuffer);
         ReportTiming("Output buffer write");
     }
 
@@ -1671,6 +2039,74 @@ CPLErr GDALWarpOperation::WarpRegion(
     return eErr;
 }
 
+/************************************************************************/
+/*                       ReadDestinationBuffer()                        */
+/************************************************************************/
+
+// Read the existing content of a window of the destination dataset, so that
+// we can overlay on it.
+CPLErr GDALWarpOperation::ReadDestinationBuffer(int nDstXOff, int nDstYOff,
+                                                int nDstXSize, int nDstYSize,
+                                                void *pDstBuffer)
+{
+    GDALDataset *poDstDS = GDALDataset::FromHandle(psOptions->hDstDS);
+    if (psOptions->nBandCount == 1)
+    {
+        // Particular case to simplify the stack a bit.
+        // TODO(rouault): Need an explanation of what and why r34502 helps.
+        return poDstDS->GetRasterBand(psOptions->panDstBands[0])
+            ->RasterIO(GF_Read, nDstXOff, nDstYOff, nDstXSize, nDstYSize,
+                       pDstBuffer, nDstXSize, nDstYSize,
+                       psOptions->eWorkingDataType, 0, 0, nullptr);
+    }
+    return poDstDS->RasterIO(GF_Read, nDstXOff, nDstYOff, nDstXSize,
+                             nDstYSize, pDstBuffer, nDstXSize, nDstYSize,
+                             psOptions->eWorkingDataType, psOptions->nBandCount,
+                             psOptions->panDstBands, 0, 0, 0, nullptr);
+}
+
+/************************************************************************/
+/*                       WriteDestinationBuffer()                       */
+/************************************************************************/
+
+// Write a warped buffer to a window of the destination dataset.
+CPLErr GDALWarpOperation::WriteDestinationBuffer(int nDstXOff, int nDstYOff,
+                                                 int nDstXSize, int nDstYSize,
+                                                 void *pDstBuffer)
+{
+    GDALDataset *poDstDS = GDALDataset::FromHandle(psOptions->hDstDS);
+    CPLErr eErr;
+    if (psOptions->nBandCount == 1)
+    {
+        // Particular case to simplify the stack a bit.
+        eErr = poDstDS->GetRasterBand(psOptions->panDstBands[0])
+                   ->RasterIO(GF_Write, nDstXOff, nDstYOff, nDstXSize,
+                              nDstYSize, pDstBuffer, nDstXSize, nDstYSize,
+                              psOptions->eWorkingDataType, 0, 0, nullptr);
+    }
+    else
+    {
+        eErr = poDstDS->RasterIO(GF_Write, nDstXOff, nDstYOff, nDstXSize,
+                                 nDstYSize, pDstBuffer, nDstXSize, nDstYSize,
+                                 psOptions->eWorkingDataType,
+                                 psOptions->nBandCount, psOptions->panDstBands,
+                                 0, 0, 0, nullptr);
+    }
+
+    if (eErr == CE_None &&
+        CPLFetchBool(psOptions->papszWarpOptions, "WRITE_FLUSH", false))
+    {
+        const CPLErr eOldErr = CPLGetLastErrorType();
+        const CPLString osLastErrMsg = CPLGetLastErrorMsg();
+        GDALFlushCache(psOptions->hDstDS);
+        const CPLErr eNewErr = CPLGetLastErrorType();
+        if (eNewErr != eOldErr ||
+            osLastErrMsg.compare(CPLGetLastErrorMsg()) != 0)
+            eErr = CE_Failure;
+    }
+    return eErr;
+}
+
 /************************************************************************/
 /*                             GDALWarpRegion()                         */
 /************************************************************************/
@@ -1767,11 +2203,32 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
  */
 
 CPLErr GDALWarpOperation::WarpRegionToBuffer(
+    int nDstXOff, int nDstYOff, int nDstXSize, int nDstYSize, void *pDataBuf,
+    GDALDataType eBufDataType, int nSrcXOff, int nSrcYOff, int nSrcXSize,
+    int nSrcYSize, double dfSrcXExtraSize, double dfSrcYExtraSize,
+    double dfProgressBase, double dfProgressScale)
+
+{
+    return WarpRegionToBufferInternal(
+        nDstXOff, nDstYOff, nDstXSize, nDstYSize, pDataBuf, eBufDataType,
+        nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize, dfSrcXExtraSize,
+        dfSrcYExtraSize, dfProgressBase, dfProgressScale, nullptr);
+}
+
+/************************************************************************/
+/*                     WarpRegionToBufferInternal()                     */
+/************************************************************************/
+
+// Same as WarpRegionToBuffer(). When psWorker is not null, this is called
+// by a chunk worker of ChunkAndWarpWithWorkers() that holds the IO mutex,
+// and the warp kernel runs concurrently with the ones of the other workers.
+CPLErr GDALWarpOperation::WarpRegionToBufferInternal(
     int nDstXOff, int nDstYOff, int nDstXSize, int nDstYSize, void *pDataBuf,
     // Only in a CPLAssert.
     CPL_UNUSED GDALDataType eBufDataType, int nSrcXOff, int nSrcYOff,
     int nSrcXSize, int nSrcYSize, double dfSrcXExtraSize,
-    double dfSrcYExtraSize, double dfProgressBase, double dfProgressScale)
+    double dfSrcYExtraSize, double dfProgressBase, double dfProgressScale,
+    GDALWarpChunkWorker *psWorker)
 
 {
     const int nWordSize = GDALGetDataTypeSizeBytes(psOptions->eWorkingDataType);
@@ -1830,6 +2287,14 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     oWK.papszWarpOptions = psOptions->papszWarpOptions;
     oWK.psThreadData = psThreadData;
 
+    if (psWorker)
+    {
+        oWK.pTransformerArg = psWorker->pTransformerArg;
+        oWK.pfnProgress = GDALWarpChunkWorkerProgress;
+        oWK.pProgress = psWorker;
+        oWK.psThreadData = psWorker->psThreadData;
+    }
+
     oWK.padfDstNoDataReal = psOptions->padfDstNoDataReal;
 
     /* -------------------------------------------------------------------- */
@@ -1879,6 +2344,7 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
 
     if (eErr == CE_None && nSrcXSize > 0 && nSrcYSize > 0)
     {
+        CPLTraceSpan oReadSpan("warp", "Input buffer read");
         GDALDataset *poSrcDS = GDALDataset::FromHandle(psOptions->hSrcDS);
         if (psOptions->nBandCount == 1)
         {
@@ -2220,7 +2686,13 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     /* -------------------------------------------------------------------- */
     /*      Release IO Mutex, and acquire warper mutex.                     */
     /* -------------------------------------------------------------------- */
-    if (hIOMutex != nullptr)
+    if (psWorker)
+    {
+        // The kernel of a chunk worker uses its own transformer and thread
+        // data, so it can run concurrently with the ones of other workers.
+        CPLReleaseMutex(hIOMutex);
+    }
+    else if (hIOMutex != nullptr)
     {
         CPLReleaseMutex(hIOMutex);
         if (!CPLAcquireMutex(hWarpMutex, 600.0))
@@ -2243,6 +2715,7 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     /* -------------------------------------------------------------------- */
     if (eErr == CE_None)
     {
+        CPLTraceSpan oWarpSpan("warp", "In memory warp operation");
         eErr = oWK.PerformWarp();
         ReportTiming("In memory warp operation");
     }
@@ -2259,7 +2732,8 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     /* -------------------------------------------------------------------- */
     if (hIOMutex != nullptr)
     {
-        CPLReleaseMutex(hWarpMutex);
+        if (!psWorker)
+            CPLReleaseMutex(hWarpMutex);
         if (!CPLAcquireMutex(hIOMutex, 600.0))
         {
             CPLError(CE_Failure, CPLE_AppDefined,
@@ -2834,6 +3308,72 @@ bool GDALWarpOperation::ComputeSourceWindowTransformPoints(
     return true;
 }
 
+/************************************************************************/
+/*                  GDALWarpSrcWindowHasNoValidData()                   */
+/************************************************************************/
+
+// Return true if the data coverage status of the source dataset indicates
+// that the source window is empty, and that empty areas are considered as
+// invalid by the warper: either because they read as the source nodata
+// value, or because the source alpha band or mask band is empty.
+static bool GDALWarpSrcWindowHasNoValidData(const GDALWarpOptions *psOptions,
+                                            int nSrcXOff, int nSrcYOff,
+                                            int nSrcXSize, int nSrcYSize)
+{
+    const auto IsEmpty = [=](GDALRasterBandH hBand)
+    {
+        return GDALGetDataCoverageStatus(hBand, nSrcXOff, nSrcYOff, nSrcXSize,
+                                         nSrcYSize, 0, nullptr) ==
+               GDAL_DATA_COVERAGE_STATUS_EMPTY;
+    };
+
+    if (psOptions->nSrcAlphaBand > 0)
+    {
+        GDALRasterBandH hAlphaBand =
+            GDALGetRasterBand(psOptions->hSrcDS, psOptions->nSrcAlphaBand);
+        return hAlphaBand && IsEmpty(hAlphaBand);
+    }
+
+    if (psOptions->nBandCount <= 0)
+        return false;
+
+    if (psOptions->padfSrcNoDataReal != nullptr)
+    {
+        // Empty areas read as the band nodata value, or 0 if there is none.
+        for (int i = 0; i < psOptions->nBandCount; ++i)
+        {
+            GDALRasterBandH hBand =
+                GDALGetRasterBand(psOptions->hSrcDS, psOptions->panSrcBands[i]);
+            if (hBand == nullptr)
+                return false;
+            int bHasNoData = FALSE;
+            double dfEmptyValue = GDALGetRasterNoDataValue(hBand, &bHasNoData);
+            if (!bHasNoData)
+                dfEmptyValue = 0;
+            const double dfSrcNoData = psOptions->padfSrcNoDataReal[i];
+            if (!(dfEmptyValue == dfSrcNoData ||
+                  (std::isnan(dfEmptyValue) && std::isnan(dfSrcNoData))) ||
+                (psOptions->padfSrcNoDataImag != nullptr &&
+                 psOptions->padfSrcNoDataImag[i] != 0) ||
+                !IsEmpty(hBand))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    GDALRasterBandH hSrcBand =
+        GDALGetRasterBand(psOptions->hSrcDS, psOptions->panSrcBands[0]);
+    if (hSrcBand && (GDALGetMaskFlags(hSrcBand) & GMF_PER_DATASET) &&
+        !(GDALGetMaskFlags(hSrcBand) & GMF_ALPHA))
+    {
+        return IsEmpty(GDALGetMaskBand(hSrcBand));
+    }
+
+    return false;
+}
+
 /************************************************************************/
 /*                        ComputeSourceWindow()                         */
 /************************************************************************/
@@ -3190,6 +3730,32 @@ CPLErr GDALWarpOperation::ComputeSourceWindow(
             std::max(1.0, (dfMaxXOut - dfMinXOut + 2 * nXRadius) *
                               (dfMaxYOut - dfMinYOut + 2 * nYRadius));
 
+    /* -------------------------------------------------------------------- */
+    /*      If the source window has no valid data at all, according to     */
+    /*      the data coverage status of the source, return an empty window  */
+    /*      so that the chunk is skipped or processed without reading it.   */
+    /* -------------------------------------------------------------------- */
+    if (*pnSrcXSize > 0 && *pnSrcYSize > 0 &&
+        CPLFetchBool(psOptions->papszWarpOptions, "USE_SRC_DATA_COVERAGE",
+                     true) &&
+        GDALWarpSrcWindowHasNoValidData(psOptions, *pnSrcXOff, *pnSrcYOff,
+                                        *pnSrcXSize, *pnSrcYSize))
+    {
+        CPLDebug("WARP",
+                 "Source window %d,%d,%d,%d for destination window "
+                 "%d,%d,%d,%d has no valid data",
+                 *pnSrcXOff, *pnSrcYOff, *pnSrcXSize, *pnSrcYSize, nDstXOff,
+                 nDstYOff, nDstXSize, nDstYSize);
+        *pnSrcXSize = 0;
+        *pnSrcYSize = 0;
+        if (pdfSrcXExtraSize)
+            *pdfSrcXExtraSize = 0;
+        if (pdfSrcYExtraSize)
+            *pdfSrcYExtraSize = 0;
+        if (pdfSrcFillRatio)
+            *pdfSrcFillRatio = 0;
+    }
+
     return CE_None;
 }
 
@@ -0,0 +1,845 @@
+/******************************************************************************
+ *
+ * Project:  GDAL
+ * Purpose:  Statistics of a raster band over polygonal zones.
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "gdal_alg.h"
+#include "gdal_alg_priv.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cpl_conv.h"
+#include "cpl_error.h"
+#include "cpl_error_internal.h"
+#include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_priv.h"
+#include "gdal_thread_pool.h"
+#include "ogr_feature.h"
+#include "ogr_geometry.h"
+#include "ogr_spatialref.h"
+#include "ogrsf_frmts.h"
+
+namespace
+{
+
+/************************************************************************/
+/*                         GDALZonalStatsAcc                            */
+/************************************************************************/
+
+// Statistics of a zone, or of the part of a zone that is within a chunk.
+// Each pixel is weighted by the fraction of its area covered by the zone.
+struct GDALZonalStatsAcc
+{
+    double dfCount = 0;
+    double dfSum = 0;
+    double dfMin = std::numeric_limits<double>::infinity();
+    double dfMax = -std::numeric_limits<double>::infinity();
+    std::vector<double> adfHistogram{};
+
+    void Merge(const GDALZonalStatsAcc &oOther)
+    {
+        dfCount += oOther.dfCount;
+        dfSum += oOther.dfSum;
+        dfMin = std::min(dfMin, oOther.dfMin);
+        dfMax = std::max(dfMax, oOther.dfMax);
+        if (!oOther.adfHistogram.empty())
+        {
+            adfHistogram.resize(oOther.adfHistogram.size());
+            for (size_t i = 0; i < adfHistogram.size(); ++i)
+                adfHistogram[i] += oOther.adfHistogram[i];
+        }
+    }
+};
+
+/************************************************************************/
+/*                         GDALZonalStatsZone                           */
+/************************************************************************/
+
+// Rings of a zone, in pixel/line coordinates of the raster, oriented so
+// that the interior of the zone has a positive signed area.
+struct GDALZonalStatsZone
+{
+    std::vector<double> adfX{};
+    std::vector<double> adfY{};
+    std::vector<int> anPartSize{};
+};
+
+/************************************************************************/
+/*                         GDALZonalStatsChunk                          */
+/************************************************************************/
+
+// Window of the raster, made of whole blocks, and zones intersecting it.
+struct GDALZonalStatsChunk
+{
+    int nXOff = 0;
+    int nYOff = 0;
+    int nXSize = 0;
+    int nYSize = 0;
+    std::vector<size_t> anZones{};
+};
+
+/************************************************************************/
+/*                        GDALZonalStatsContext                         */
+/************************************************************************/
+
+struct GDALZonalStatsContext
+{
+    std::vector<GDALZonalStatsZone> aoZones{};
+    bool bCenter = false;
+    int nHistBins = 0;
+    double dfHistMin = 0;
+    double dfHistScale = 0;
+};
+
+/************************************************************************/
+/*                          GDALZonalStatsJob                           */
+/************************************************************************/
+
+struct GDALZonalStatsJob
+{
+    const GDALZonalStatsContext *psCtxt = nullptr;
+    const GDALZonalStatsChunk *psChunk = nullptr;
+    std::vector<double> adfValues{};
+    std::vector<GByte> abyMask{};
+
+    std::vector<std::pair<size_t, GDALZonalStatsAcc>> aoResults{};
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+    std::atomic<bool> bFinished{false};
+};
+
+struct GDALZonalStatsScanlineData
+{
+    const GDALZonalStatsJob *psJob;
+    GDALZonalStatsAcc *psAcc;
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                       GDALZonalStatsAddPixels()                      */
+/************************************************************************/
+
+// Accumulate the pixels from nXStart to nXEnd (inclusive) of line nY of
+// the chunk, weighted by padfCoverage (or by 1 if it is null).
+static void GDALZonalStatsAddPixels(const GDALZonalStatsScanlineData *psData,
+                                    int nY, int nXStart, int nXEnd,
+                                    const double *padfCoverage)
+{
+    const GDALZonalStatsJob *psJob = psData->psJob;
+    const GDALZonalStatsContext *psCtxt = psJob->psCtxt;
+    GDALZonalStatsAcc &sAcc = *psData->psAcc;
+    const size_t nLineOffset =
+        static_cast<size_t>(nY) * psJob->psChunk->nXSize;
+    const double *padfLine = psJob->adfValues.data() + nLineOffset;
+    const GByte *pabyMaskLine =
+        psJob->abyMask.empty() ? nullptr : psJob->abyMask.data() + nLineOffset;
+
+    for (int nX = nXStart; nX <= nXEnd; ++nX)
+    {
+        const double dfWeight =
+            padfCoverage ? padfCoverage[nX - nXStart] : 1.0;
+        if (!(dfWeight > 0) ||
+            (pabyMaskLine != nullptr && pabyMaskLine[nX] == 0))
+            continue;
+        const double dfValue = padfLine[nX];
+        if (std::isnan(dfValue))
+            continue;
+
+        sAcc.dfCount += dfWeight;
+        sAcc.dfSum += dfWeight * dfValue;
+        sAcc.dfMin = std::min(sAcc.dfMin, dfValue);
+        sAcc.dfMax = std::max(sAcc.dfMax, dfValue);
+        if (psCtxt->nHistBins > 0)
+        {
+            const double dfBin =
+                std::floor((dfValue - psCtxt->dfHistMin) * psCtxt->dfHistScale);
+            if (dfBin >= 0 && dfBin < psCtxt->nHistBins)
+                sAcc.adfHistogram[static_cast<int>(dfBin)] += dfWeight;
+        }
+    }
+}
+
+/************************************************************************/
+/*                       GDALZonalStatsScanline()                       */
+/************************************************************************/
+
+static void GDALZonalStatsScanline(void *pCBData, int nY, int nXStart,
+                                   int nXEnd, double /* dfVariant */)
+{
+    const auto psData = static_cast<GDALZonalStatsScanlineData *>(pCBData);
+    nXStart = std::max(nXStart, 0);
+    nXEnd = std::min(nXEnd, psData->psJob->psChunk->nXSize - 1);
+    if (nXStart > nXEnd)
+        return;
+    GDALZonalStatsAddPixels(psData, nY, nXStart, nXEnd, nullptr);
+}
+
+/************************************************************************/
+/*                   GDALZonalStatsScanlineCoverage()                   */
+/************************************************************************/
+
+static void GDALZonalStatsScanlineCoverage(void *pCBData, int nY, int nXStart,
+                                           int nXEnd,
+                                           const double *padfCoverage)
+{
+    GDALZonalStatsAddPixels(
+        static_cast<GDALZonalStatsScanlineData *>(pCBData), nY, nXStart,
+        nXEnd, padfCoverage);
+}
+
+/************************************************************************/
+/*                      GDALZonalStatsProcessChunk()                    */
+/************************************************************************/
+
+static void GDALZonalStatsProcessChunk(GDALZonalStatsJob &sJob)
+{
+    const GDALZonalStatsContext *psCtxt = sJob.psCtxt;
+    const GDALZonalStatsChunk *psChunk = sJob.psChunk;
+    std::vector<double> adfX;
+    std::vector<double> adfY;
+    for (const size_t iZone : psChunk->anZones)
+    {
+        const GDALZonalStatsZone &sZone = psCtxt->aoZones[iZone];
+
+        // Shift the rings to the origin of the chunk.
+        adfX.resize(sZone.adfX.size());
+        adfY.resize(sZone.adfY.size());
+        for (size_t i = 0; i < adfX.size(); ++i)
+        {
+            adfX[i] = sZone.adfX[i] - psChunk->nXOff;
+            adfY[i] = sZone.adfY[i] - psChunk->nYOff;
+        }
+
+        GDALZonalStatsAcc sAcc;
+        sAcc.adfHistogram.resize(psCtxt->nHistBins);
+        GDALZonalStatsScanlineData sData{&sJob, &sAcc};
+        if (psCtxt->bCenter)
+        {
+            GDALdllImageFilledPolygon(
+                psChunk->nXSize, psChunk->nYSize,
+                static_cast<int>(sZone.anPartSize.size()),
+                sZone.anPartSize.data(), adfX.data(), adfY.data(), nullptr,
+                GDALZonalStatsScanline, &sData, false);
+        }
+        else
+        {
+            GDALdllImageFilledPolygonCoverage(
+                psChunk->nXSize, psChunk->nYSize,
+                static_cast<int>(sZone.anPartSize.size()),
+                sZone.anPartSize.data(), adfX.data(), adfY.data(),
+                GDALZonalStatsScanlineCoverage, &sData);
+        }
+        if (sAcc.dfCount > 0)
+            sJob.aoResults.emplace_back(iZone, std::move(sAcc));
+    }
+}
+
+/************************************************************************/
+/*                       GDALZonalStatsAddRings()                       */
+/************************************************************************/
+
+// Append the rings of a polygonal geometry to a zone, in pixel/line
+// coordinates, with exterior and interior rings having respectively a
+// positive and negative signed area.
+static void GDALZonalStatsAddRings(const OGRGeometry *poGeom,
+                                   const double *padfInvGeoTransform,
+                                   GDALZonalStatsZone &sZone)
+{
+    const OGRwkbGeometryType eFlatType = wkbFlatten(poGeom->getGeometryType());
+    if (eFlatType == wkbMultiPolygon)
+    {
+        for (const auto poPart : *(poGeom->toMultiPolygon()))
+            GDALZonalStatsAddRings(poPart, padfInvGeoTransform, sZone);
+        return;
+    }
+    if (eFlatType != wkbPolygon)
+        return;
+
+    const OGRPolygon *poPolygon = poGeom->toPolygon();
+    for (int iRing = 0; iRing <= poPolygon->getNumInteriorRings(); ++iRing)
+    {
+        const OGRLinearRing *poRing =
+            iRing == 0 ? poPolygon->getExteriorRing()
+                       : poPolygon->getInteriorRing(iRing - 1);
+        const int nPoints = poRing ? poRing->getNumPoints() : 0;
+        if (nPoints < 3)
+            continue;
+
+        const size_t nOffset = sZone.adfX.size();
+        for (int i = 0; i < nPoints; ++i)
+        {
+            const double dfX = poRing->getX(i);
+            const double dfY = poRing->getY(i);
+            sZone.adfX.push_back(padfInvGeoTransform[0] +
+                                 dfX * padfInvGeoTransform[1] +
+                                 dfY * padfInvGeoTransform[2]);
+            sZone.adfY.push_back(padfInvGeoTransform[3] +
+                                 dfX * padfInvGeoTransform[4] +
+                                 dfY * padfInvGeoTransform[5]);
+        }
+
+        const double *padfX = sZone.adfX.data() + nOffset;
+        const double *padfY = sZone.adfY.data() + nOffset;
+        double dfArea = 0;
+        for (int i = 0; i < nPoints; ++i)
+        {
+            const int j = (i + 1) % nPoints;
+            dfArea += padfX[i] * padfY[j] - padfX[j] * padfY[i];
+        }
+        if ((dfArea > 0) != (iRing == 0))
+        {
+            std::reverse(sZone.adfX.begin() + nOffset, sZone.adfX.end());
+            std::reverse(sZone.adfY.begin() + nOffset, sZone.adfY.end());
+        }
+        sZone.anPartSize.push_back(nPoints);
+    }
+}
+
+/************************************************************************/
+/*                           GDALZonalStats()                           */
+/************************************************************************/
+
+/**
+ * Compute statistics of a raster band over polygonal zones.
+ *
+ * For each feature of the zone layer, a feature is created in the output
+ * layer, with the fields of the zone feature that have the same name as a
+ * field of the output layer (and its geometry, if the output layer has a
+ * geometry field), and the requested statistics of the pixels of the band
+ * within the zone geometry. The statistics fields are created in the output
+ * layer if they do not already exist.
+ *
+ * By default, each pixel is weighted by the exact fraction of its area that
+ * is covered by the zone: "count" is then the sum of those fractions, and
+ * "sum" the sum of the pixel values multiplied by them. Pixels that are
+ * masked by the mask band of the raster band (typically nodata pixels) and
+ * NaN pixels are ignored. Zones may overlap. Geometries that are not
+ * polygonal are ignored, and their zone gets a count of 0.
+ *
+ * The raster is read once, by chunks made of whole blocks, and only the
+ * chunks that intersect a zone are read. The zones intersecting each chunk
+ * are rasterized on the fly, so that no zone raster is needed. Chunks may
+ * be processed by several worker threads, while the results are still
+ * independent from the number of threads.
+ *
+ * If the zone layer and the raster have different coordinate reference
+ * systems, zone geometries are reprojected to the one of the raster.
+ *
+ * Options:
+ * <ul>
+ * <li>STATS=stat[,stat]...: list of statistics to compute, among count,
+ * sum, mean, min and max. They are written in fields of the same name.
+ * Defaults to all of them.</li>
+ * <li>COVERAGE=FRACTION/CENTER: whether pixels are weighted by the fraction
+ * of their area covered by the zone (default), or whether only pixels whose
+ * center is within the zone are taken into account, with a weight of 1.</li>
+ * <li>HISTOGRAM_BINS=n: number of bins of a histogram of the (weighted)
+ * pixel values, written as a comma separated list in a "histogram" field.
+ * HISTOGRAM_MIN and HISTOGRAM_MAX must then also be specified.</li>
+ * <li>HISTOGRAM_MIN=val: lower bound of the first bin.</li>
+ * <li>HISTOGRAM_MAX=val: upper bound (excluded) of the last bin.</li>
+ * <li>NUM_THREADS=n/ALL_CPUS: number of threads used to process chunks.
+ * Defaults to the value of the GDAL_NUM_THREADS configuration option, or
+ * 1.</li>
+ * </ul>
+ *
+ * @param hSrcBand the raster band.
+ * @param hZoneLayer the layer with the zone geometries.
+ * @param hDstLayer the layer to which output features are written.
+ * @param papszOptions NULL terminated list of options, or NULL.
+ * @param pfnProgress progress function, or NULL.
+ * @param pProgressArg argument of the progress function.
+ *
+ * @return CE_None on success, or CE_Failure on an error.
+ *
+ * @since GDAL 3.9
+ */
+
+CPLErr GDALZonalStats(GDALRasterBandH hSrcBand, OGRLayerH hZoneLayer,
+                      OGRLayerH hDstLayer, CSLConstList papszOptions,
+                      GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    VALIDATE_POINTER1(hSrcBand, "GDALZonalStats", CE_Failure);
+    VALIDATE_POINTER1(hZoneLayer, "GDALZonalStats", CE_Failure);
+    VALIDATE_POINTER1(hDstLayer, "GDALZonalStats", CE_Failure);
+
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+
+    GDALRasterBand *poBand = GDALRasterBand::FromHandle(hSrcBand);
+    OGRLayer *poZoneLayer = OGRLayer::FromHandle(hZoneLayer);
+    OGRLayer *poDstLayer = OGRLayer::FromHandle(hDstLayer);
+
+    if (GDALDataTypeIsComplex(poBand->GetRasterDataType()))
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "GDALZonalStats(): complex data types are not supported");
+        return CE_Failure;
+    }
+
+    GDALDataset *poDS = poBand->GetDataset();
+    double adfGeoTransform[6] = {0, 1, 0, 0, 0, 1};
+    double adfInvGeoTransform[6] = {0, 1, 0, 0, 0, 1};
+    if (poDS == nullptr || poDS->GetGeoTransform(adfGeoTransform) != CE_None ||
+        !GDALInvGeoTransform(adfGeoTransform, adfInvGeoTransform))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "GDALZonalStats(): the raster has no valid geotransform");
+        return CE_Failure;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Parse options.                                                  */
+    /* -------------------------------------------------------------------- */
+    GDALZonalStatsContext sCtxt;
+
+    const char *const apszAllStats[] = {"count", "sum", "mean", "min", "max"};
+    const CPLStringList aosStats(CSLTokenizeString2(
+        CSLFetchNameValueDef(papszOptions, "STATS", "count,sum,mean,min,max"),
+        ",", 0));
+    for (const char *pszStat : aosStats)
+    {
+        if (std::find_if(std::begin(apszAllStats), std::end(apszAllStats),
+                         [pszStat](const char *pszName)
+                         { return EQUAL(pszStat, pszName); }) ==
+            std::end(apszAllStats))
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg,
+                     "GDALZonalStats(): unsupported statistic: %s", pszStat);
+            return CE_Failure;
+        }
+    }
+
+    const char *pszCoverage =
+        CSLFetchNameValueDef(papszOptions, "COVERAGE", "FRACTION");
+    if (EQUAL(pszCoverage, "CENTER"))
+        sCtxt.bCenter = true;
+    else if (!EQUAL(pszCoverage, "FRACTION"))
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "GDALZonalStats(): invalid value for COVERAGE: %s",
+                 pszCoverage);
+        return CE_Failure;
+    }
+
+    sCtxt.nHistBins =
+        atoi(CSLFetchNameValueDef(papszOptions, "HISTOGRAM_BINS", "0"));
+    if (sCtxt.nHistBins < 0 || sCtxt.nHistBins > 1000 * 1000)
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "GDALZonalStats(): invalid value for HISTOGRAM_BINS");
+        return CE_Failure;
+    }
+    if (sCtxt.nHistBins > 0)
+    {
+        const char *pszHistMin =
+            CSLFetchNameValue(papszOptions, "HISTOGRAM_MIN");
+        const char *pszHistMax =
+            CSLFetchNameValue(papszOptions, "HISTOGRAM_MAX");
+        const double dfHistMin = pszHistMin ? CPLAtof(pszHistMin) : 0;
+        const double dfHistMax = pszHistMax ? CPLAtof(pszHistMax) : 0;
+        if (pszHistMin == nullptr || pszHistMax == nullptr ||
+            !(dfHistMax > dfHistMin))
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg,
+                     "GDALZonalStats(): HISTOGRAM_MIN and HISTOGRAM_MAX must "
+                     "be specified, with HISTOGRAM_MIN < HISTOGRAM_MAX");
+            return CE_Failure;
+        }
+        sCtxt.dfHistMin = dfHistMin;
+        sCtxt.dfHistScale = sCtxt.nHistBins / (dfHistMax - dfHistMin);
+    }
+
+    const char *pszNumThreads = CSLFetchNameValueDef(
+        papszOptions, "NUM_THREADS",
+        CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    const int nThreads = std::max(
+        1, std::min(128, EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : atoi(pszNumThreads)));
+
+    /* -------------------------------------------------------------------- */
+    /*      Create the output fields.                                       */
+    /* -------------------------------------------------------------------- */
+    std::vector<std::pair<std::string, int>> aoStatFields;
+    for (const char *pszStat : aosStats)
+        aoStatFields.emplace_back(CPLString(pszStat).tolower(), -1);
+    if (sCtxt.nHistBins > 0)
+        aoStatFields.emplace_back("histogram", -1);
+    for (auto &oStatField : aoStatFields)
+    {
+        const char *pszName = oStatField.first.c_str();
+        if (poDstLayer->GetLayerDefn()->GetFieldIndex(pszName) < 0)
+        {
+            OGRFieldDefn oFieldDefn(
+                pszName, strcmp(pszName, "histogram") == 0 ? OFTString
+                                                           : OFTReal);
+            if (poDstLayer->CreateField(&oFieldDefn) != OGRERR_NONE)
+                return CE_Failure;
+        }
+    }
+    for (auto &oStatField : aoStatFields)
+    {
+        oStatField.second = poDstLayer->GetLayerDefn()->GetFieldIndex(
+            oStatField.first.c_str());
+        if (oStatField.second < 0)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "GDALZonalStats(): cannot find field %s in output layer",
+                     oStatField.first.c_str());
+            return CE_Failure;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Read the zones, in pixel/line coordinates.                      */
+    /* -------------------------------------------------------------------- */
+    std::unique_ptr<OGRCoordinateTransformation> poCT;
+    const OGRSpatialReference *poZoneSRS = poZoneLayer->GetSpatialRef();
+    const OGRSpatialReference *poRasterSRS = poDS->GetSpatialRef();
+    if (poZoneSRS != nullptr && poRasterSRS != nullptr &&
+        !poZoneSRS->IsSame(poRasterSRS))
+    {
+        poCT.reset(OGRCreateCoordinateTransformation(poZoneSRS, poRasterSRS));
+        if (poCT == nullptr)
+            return CE_Failure;
+    }
+
+    const int nRasterXSize = poBand->GetXSize();
+    const int nRasterYSize = poBand->GetYSize();
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+
+    // Chunks are made of whole blocks, and of about one million pixels.
+    constexpr int CHUNK_SIZE = 1024;
+    const int nChunkXSize = std::min(
+        nRasterXSize,
+        std::max(nBlockXSize, CHUNK_SIZE / nBlockXSize * nBlockXSize));
+    const int nChunkYSize = std::min(
+        nRasterYSize,
+        std::max(nBlockYSize, CHUNK_SIZE * CHUNK_SIZE / nChunkXSize /
+                                  nBlockYSize * nBlockYSize));
+    const int nChunksPerRow = DIV_ROUND_UP(nRasterXSize, nChunkXSize);
+    const int nChunksPerCol = DIV_ROUND_UP(nRasterYSize, nChunkYSize);
+    std::vector<GDALZonalStatsChunk> aoChunks(
+        static_cast<size_t>(nChunksPerRow) * nChunksPerCol);
+
+    bool bNonPolygonalWarningEmitted = false;
+    for (auto &&poZoneFeature : poZoneLayer)
+    {
+        const size_t iZone = sCtxt.aoZones.size();
+        sCtxt.aoZones.emplace_back();
+        GDALZonalStatsZone &sZone = sCtxt.aoZones.back();
+
+        const OGRGeometry *poGeom = poZoneFeature->GetGeometryRef();
+        if (poGeom == nullptr || poGeom->IsEmpty())
+            continue;
+        const OGRwkbGeometryType eFlatType =
+            wkbFlatten(poGeom->getGeometryType());
+        if (!OGR_GT_IsSubClassOf(eFlatType, wkbCurvePolygon) &&
+            !OGR_GT_IsSubClassOf(eFlatType, wkbMultiSurface))
+        {
+            if (!bNonPolygonalWarningEmitted)
+            {
+                bNonPolygonalWarningEmitted = true;
+                CPLError(CE_Warning, CPLE_AppDefined,
+                         "GDALZonalStats(): non-polygonal zone geometries "
+                         "are ignored");
+            }
+            continue;
+        }
+
+        std::unique_ptr<OGRGeometry> poLinearGeom(
+            poGeom->hasCurveGeometry() ? poGeom->getLinearGeometry()
+                                       : poGeom->clone());
+        if (poCT && poLinearGeom->transform(poCT.get()) != OGRERR_NONE)
+        {
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "GDALZonalStats(): cannot reproject geometry of zone "
+                     "feature " CPL_FRMT_GIB ". Ignoring it",
+                     static_cast<GIntBig>(poZoneFeature->GetFID()));
+            continue;
+        }
+        GDALZonalStatsAddRings(poLinearGeom.get(), adfInvGeoTransform, sZone);
+        if (sZone.adfX.empty())
+            continue;
+
+        // Register the zone in the chunks intersecting its extent.
+        const auto oMinMaxX =
+            std::minmax_element(sZone.adfX.begin(), sZone.adfX.end());
+        const auto oMinMaxY =
+            std::minmax_element(sZone.adfY.begin(), sZone.adfY.end());
+        const double dfXMin = std::max(0.0, std::floor(*oMinMaxX.first));
+        const double dfYMin = std::max(0.0, std::floor(*oMinMaxY.first));
+        const double dfXMax =
+            std::min(nRasterXSize - 1.0, std::floor(*oMinMaxX.second));
+        const double dfYMax =
+            std::min(nRasterYSize - 1.0, std::floor(*oMinMaxY.second));
+        if (!(dfXMin <= dfXMax && dfYMin <= dfYMax))
+            continue;
+        const int nChunkXMin = static_cast<int>(dfXMin) / nChunkXSize;
+        const int nChunkXMax = static_cast<int>(dfXMax) / nChunkXSize;
+        const int nChunkYMin = static_cast<int>(dfYMin) / nChunkYSize;
+        const int nChunkYMax = static_cast<int>(dfYMax) / nChunkYSize;
+        for (int nChunkY = nChunkYMin; nChunkY <= nChunkYMax; ++nChunkY)
+        {
+            for (int nChunkX = nChunkXMin; nChunkX <= nChunkXMax; ++nChunkX)
+            {
+                aoChunks[static_cast<size_t>(nChunkY) * nChunksPerRow +
+                         nChunkX]
+                    .anZones.push_back(iZone);
+            }
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Process the chunks that intersect at least one zone.            */
+    /* -------------------------------------------------------------------- */
+    size_t nChunksToProcess = 0;
+    for (int nChunkY = 0; nChunkY < nChunksPerCol; ++nChunkY)
+    {
+        for (int nChunkX = 0; nChunkX < nChunksPerRow; ++nChunkX)
+        {
+            auto &sChunk =
+                aoChunks[static_cast<size_t>(nChunkY) * nChunksPerRow +
+                         nChunkX];
+            sChunk.nXOff = nChunkX * nChunkXSize;
+            sChunk.nYOff = nChunkY * nChunkYSize;
+            sChunk.nXSize =
+                std::min(nChunkXSize, nRasterXSize - sChunk.nXOff);
+            sChunk.nYSize =
+                std::min(nChunkYSize, nRasterYSize - sChunk.nYOff);
+            if (!sChunk.anZones.empty())
+                ++nChunksToProcess;
+        }
+    }
+
+    GDALRasterBand *poMaskBand = nullptr;
+    if ((poBand->GetMaskFlags() & GMF_ALL_VALID) == 0)
+        poMaskBand = poBand->GetMaskBand();
+
+    std::vector<GDALZonalStatsAcc> aoStats(sCtxt.aoZones.size());
+    CPLErr eErr = CE_None;
+    size_t nChunksDone = 0;
+
+    // Merge the results of a job, in the order of submission, so that
+    // results do not depend on the number of threads.
+    const auto FinalizeJob = [&](GDALZonalStatsJob &sJob)
+    {
+        for (const auto &oError : sJob.aoErrors)
+        {
+            CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+        }
+        for (const auto &oResult : sJob.aoResults)
+            aoStats[oResult.first].Merge(oResult.second);
+
+        ++nChunksDone;
+        if (eErr == CE_None &&
+            !pfnProgress(0.9 * nChunksDone / nChunksToProcess, "",
+                         pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    };
+
+    const auto JobFunc = [](void *pJobData)
+    {
+        GDALZonalStatsJob *psJob = static_cast<GDALZonalStatsJob *>(pJobData);
+        CPLInstallErrorHandlerAccumulator(psJob->aoErrors);
+        GDALZonalStatsProcessChunk(*psJob);
+        CPLUninstallErrorHandlerAccumulator();
+        psJob->bFinished = true;
+    };
+
+    // Jobs submitted to the worker threads, and not finalized yet.
+    // Must be declared before the job queue, so that they are destroyed
+    // after its jobs are completed.
+    std::list<std::unique_ptr<GDALZonalStatsJob>> apoJobs;
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
+
+    // Finalize the jobs at the front of the list, waiting for them to be
+    // completed until at most nMaxRemainingJobs jobs are left.
+    const auto FinalizeJobs = [&](size_t nMaxRemainingJobs)
+    {
+        while (!apoJobs.empty())
+        {
+            if (!apoJobs.front()->bFinished)
+            {
+                if (apoJobs.size() <= nMaxRemainingJobs)
+                    break;
+                const int nRunningJobs = static_cast<int>(std::count_if(
+                    apoJobs.begin(), apoJobs.end(),
+                    [](const std::unique_ptr<GDALZonalStatsJob> &poJob)
+                    { return !poJob->bFinished; }));
+                poJobQueue->WaitCompletion(nRunningJobs - 1);
+                continue;
+            }
+            FinalizeJob(*apoJobs.front());
+            apoJobs.pop_front();
+        }
+    };
+
+    for (const auto &sChunk : aoChunks)
+    {
+        if (sChunk.anZones.empty())
+            continue;
+        if (eErr != CE_None)
+            break;
+
+        auto poJob = std::make_unique<GDALZonalStatsJob>();
+        poJob->psCtxt = &sCtxt;
+        poJob->psChunk = &sChunk;
+        const size_t nPixels =
+            static_cast<size_t>(sChunk.nXSize) * sChunk.nYSize;
+        try
+        {
+            poJob->adfValues.resize(nPixels);
+            if (poMaskBand)
+                poJob->abyMask.resize(nPixels);
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "GDALZonalStats(): out of memory");
+            eErr = CE_Failure;
+            break;
+        }
+
+        eErr = poBand->RasterIO(GF_Read, sChunk.nXOff, sChunk.nYOff,
+                                sChunk.nXSize, sChunk.nYSize,
+                                poJob->adfValues.data(), sChunk.nXSize,
+                                sChunk.nYSize, GDT_Float64, 0, 0, nullptr);
+        if (eErr == CE_None && poMaskBand)
+        {
+            eErr = poMaskBand->RasterIO(
+                GF_Read, sChunk.nXOff, sChunk.nYOff, sChunk.nXSize,
+                sChunk.nYSize, poJob->abyMask.data(), sChunk.nXSize,
+                sChunk.nYSize, GDT_Byte, 0, 0, nullptr);
+        }
+        if (eErr != CE_None)
+            break;
+
+        if (poJobQueue)
+        {
+            if (!poJobQueue->SubmitJob(JobFunc, poJob.get()))
+            {
+                eErr = CE_Failure;
+                break;
+            }
+            apoJobs.push_back(std::move(poJob));
+            FinalizeJobs(2 * static_cast<size_t>(nThreads));
+        }
+        else
+        {
+            GDALZonalStatsProcessChunk(*poJob);
+            FinalizeJob(*poJob);
+        }
+    }
+
+    if (poJobQueue)
+    {
+        if (eErr == CE_None)
+            FinalizeJobs(0);
+        poJobQueue->WaitCompletion();
+    }
+    if (eErr != CE_None)
+        return eErr;
+
+    /* -------------------------------------------------------------------- */
+    /*      Write the output features.                                      */
+    /* -------------------------------------------------------------------- */
+    const size_t nZones = sCtxt.aoZones.size();
+    size_t iZone = 0;
+    for (auto &&poZoneFeature : poZoneLayer)
+    {
+        if (iZone == nZones)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "GDALZonalStats(): zone layer modified during "
+                     "processing");
+            return CE_Failure;
+        }
+        const GDALZonalStatsAcc &sAcc = aoStats[iZone];
+        ++iZone;
+
+        OGRFeature oDstFeature(poDstLayer->GetLayerDefn());
+        oDstFeature.SetFrom(poZoneFeature.get(), TRUE);
+        oDstFeature.SetFID(OGRNullFID);
+        for (const auto &oStatField : aoStatFields)
+        {
+            const std::string &osStat = oStatField.first;
+            const int iField = oStatField.second;
+            if (osStat == "count")
+                oDstFeature.SetField(iField, sAcc.dfCount);
+            else if (osStat == "sum")
+                oDstFeature.SetField(iField, sAcc.dfSum);
+            else if (sAcc.dfCount == 0)
+                oDstFeature.SetFieldNull(iField);
+            else if (osStat == "mean")
+                oDstFeature.SetField(iField, sAcc.dfSum / sAcc.dfCount);
+            else if (osStat == "min")
+                oDstFeature.SetField(iField, sAcc.dfMin);
+            else if (osStat == "max")
+                oDstFeature.SetField(iField, sAcc.dfMax);
+            else if (osStat == "histogram")
+            {
+                std::string osHistogram;
+                for (int i = 0; i < sCtxt.nHistBins; ++i)
+                {
+                    if (i > 0)
+                        osHistogram += ',';
+                    osHistogram += CPLSPrintf("%.15g", sAcc.adfHistogram[i]);
+                }
+                oDstFeature.SetField(iField, osHistogram.c_str());
+            }
+        }
+        if (poDstLayer->CreateFeature(&oDstFeature) != OGRERR_NONE)
+            return CE_Failure;
+
+        if (!pfnProgress(0.9 + 0.1 * iZone / nZones, "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+    }
+
+    return CE_None;
+}
@@ -241,6 +241,248 @@ void GDALdllImageFilledPolygon(int nRasterXSize, int nRasterYSize,
     }
 }
 
+/************************************************************************/
+/*                   GDALdllImageFilledPolygonCoverage()                */
+/*                                                                      */
+/*      Compute the exact fraction of the area of each pixel that is    */
+/*      covered by the passed multi-ring polygon, in a single pass.     */
+/*                                                                      */
+/*      Each edge accumulates, for the cells of each line it crosses,   */
+/*      the signed area between the edge and the right side of the      */
+/*      cell, and a "cover" value that applies to all the cells on its  */
+/*      right. A running sum of the covers along the line then gives    */
+/*      the coverage of each cell. Rings must be oriented so that the   */
+/*      interior of the polygon is counted positively: exterior rings   */
+/*      with a positive signed area (in pixel/line space) and interior  */
+/*      rings with a negative one.  Coverage values are clamped to      */
+/*      [0,1]. The scanline function is called once per line, with the  */
+/*      coverage of the pixels from nXStart to nXEnd (inclusive), all   */
+/*      within the raster.                                              */
+/************************************************************************/
+
+namespace
+{
+struct CoverageEdge
+{
+    double dfX0;
+    double dfY0;
+    double dfX1;
+    double dfY1;
+};
+}  // namespace
+
+// Accumulate the contribution of a segment contained in a line, from
+// (dfXA, dfYA) to (dfXB, dfYB), with 0 <= dfXA, dfXB <= nRasterXSize.
+static void llAccumulateCoverage(double dfXA, double dfYA, double dfXB,
+                                 double dfYB, int nRasterXSize,
+                                 double *padfArea, double *padfCover,
+                                 int &nMinX, int &nMaxX)
+{
+    if (dfYA == dfYB)
+        return;
+
+    const bool bRight = dfXB > dfXA;
+    double dfX = dfXA;
+    double dfY = dfYA;
+    while (true)
+    {
+        int nCell;
+        if (dfXB == dfXA)
+            nCell = static_cast<int>(floor(dfX));
+        else if (bRight)
+            nCell = static_cast<int>(floor(dfX));
+        else
+            nCell = static_cast<int>(ceil(dfX)) - 1;
+        nCell = std::max(0, std::min(nRasterXSize, nCell));
+
+        double dfXNext = dfXB;
+        double dfYNext = dfYB;
+        bool bLast = true;
+        if (dfXB != dfXA)
+        {
+            const double dfBoundary = bRight ? nCell + 1 : nCell;
+            if (bRight ? dfXB > dfBoundary : dfXB < dfBoundary)
+            {
+                dfXNext = dfBoundary;
+                dfYNext = dfYA + (dfBoundary - dfXA) * (dfYB - dfYA) /
+                                     (dfXB - dfXA);
+                bLast = false;
+            }
+        }
+
+        const double dfDY = dfYNext - dfY;
+        padfArea[nCell] += dfDY * (nCell + 1 - (dfX + dfXNext) / 2);
+        padfCover[nCell + 1] += dfDY;
+        nMinX = std::min(nMinX, nCell);
+        nMaxX = std::max(nMaxX, nCell);
+
+        if (bLast)
+            break;
+        dfX = dfXNext;
+        dfY = dfYNext;
+    }
+}
+
+void GDALdllImageFilledPolygonCoverage(int nRasterXSize, int nRasterYSize,
+                                       int nPartCount, const int *panPartSize,
+                                       const double *padfX, const double *padfY,
+                                       llScanlineCoverageFunc pfnScanlineFunc,
+                                       void *pCBData)
+{
+    if (!nPartCount || nRasterXSize <= 0 || nRasterYSize <= 0)
+        return;
+
+    /* -------------------------------------------------------------------- */
+    /*      Collect the non horizontal edges, sorted by their top line.     */
+    /* -------------------------------------------------------------------- */
+    std::vector<CoverageEdge> asEdges;
+    for (int part = 0, partoffset = 0; part < nPartCount;
+         partoffset += panPartSize[part], part++)
+    {
+        const int n = panPartSize[part];
+        for (int i = 0; i < n; i++)
+        {
+            const int ind1 = partoffset + (i == 0 ? n - 1 : i - 1);
+            const int ind2 = partoffset + i;
+            if (padfY[ind1] != padfY[ind2] &&
+                std::isfinite(padfX[ind1]) && std::isfinite(padfY[ind1]) &&
+                std::isfinite(padfX[ind2]) && std::isfinite(padfY[ind2]))
+            {
+                asEdges.push_back(CoverageEdge{padfX[ind1], padfY[ind1],
+                                               padfX[ind2], padfY[ind2]});
+            }
+        }
+    }
+    if (asEdges.empty())
+        return;
+
+    std::sort(asEdges.begin(), asEdges.end(),
+              [](const CoverageEdge &a, const CoverageEdge &b)
+              { return std::min(a.dfY0, a.dfY1) < std::min(b.dfY0, b.dfY1); });
+
+    std::vector<double> adfArea(nRasterXSize + 2);
+    std::vector<double> adfCover(nRasterXSize + 2);
+    std::vector<double> adfCoverage(nRasterXSize);
+    std::vector<size_t> anActiveEdges;
+    size_t iNextEdge = 0;
+
+    const int nFirstLine = std::max(
+        0, static_cast<int>(std::floor(std::min(asEdges[0].dfY0,
+                                                asEdges[0].dfY1))));
+    const double dfXMax = nRasterXSize;
+    for (int y = nFirstLine; y < nRasterYSize; y++)
+    {
+        while (iNextEdge < asEdges.size() &&
+               std::min(asEdges[iNextEdge].dfY0, asEdges[iNextEdge].dfY1) <
+                   y + 1)
+        {
+            anActiveEdges.push_back(iNextEdge);
+            iNextEdge++;
+        }
+        if (anActiveEdges.empty())
+        {
+            if (iNextEdge == asEdges.size())
+                break;
+            continue;
+        }
+
+        int nMinX = nRasterXSize + 1;
+        int nMaxX = -1;
+        for (size_t iEdge : anActiveEdges)
+        {
+            const CoverageEdge &sEdge = asEdges[iEdge];
+            // Clip the edge to the line, preserving its direction.
+            double dfYA, dfYB;
+            if (sEdge.dfY1 > sEdge.dfY0)
+            {
+                dfYA = std::max(sEdge.dfY0, static_cast<double>(y));
+                dfYB = std::min(sEdge.dfY1, static_cast<double>(y + 1));
+            }
+            else
+            {
+                dfYA = std::min(sEdge.dfY0, static_cast<double>(y + 1));
+                dfYB = std::max(sEdge.dfY1, static_cast<double>(y));
+            }
+            if (!((sEdge.dfY1 > sEdge.dfY0) ? dfYA < dfYB : dfYA > dfYB))
+                continue;
+            const double dfSlope =
+                (sEdge.dfX1 - sEdge.dfX0) / (sEdge.dfY1 - sEdge.dfY0);
+            const double dfXA = sEdge.dfX0 + (dfYA - sEdge.dfY0) * dfSlope;
+            const double dfXB = sEdge.dfX0 + (dfYB - sEdge.dfY0) * dfSlope;
+
+            // Split the segment where it crosses the left and right sides
+            // of the raster, and project the parts outside of it on those
+            // sides: on the left side, this preserves their contribution to
+            // the cover of the whole line, and on the right side, they do not
+            // contribute to any pixel.
+            double adfSplitX[4] = {dfXA, 0, 0, dfXB};
+            double adfSplitY[4] = {dfYA, 0, 0, dfYB};
+            int nPoints = 1;
+            for (const double dfSide : {0.0, dfXMax})
+            {
+                if ((dfXA < dfSide && dfXB > dfSide) ||
+                    (dfXA > dfSide && dfXB < dfSide))
+                {
+                    adfSplitX[nPoints] = dfSide;
+                    adfSplitY[nPoints] =
+                        dfYA + (dfSide - dfXA) * (dfYB - dfYA) / (dfXB - dfXA);
+                    nPoints++;
+                }
+            }
+            adfSplitX[nPoints] = dfXB;
+            adfSplitY[nPoints] = dfYB;
+            nPoints++;
+            if (nPoints == 4 && dfXA > dfXB)
+            {
+                // Going left: the right side is crossed first.
+                std::swap(adfSplitX[1], adfSplitX[2]);
+                std::swap(adfSplitY[1], adfSplitY[2]);
+            }
+            for (int i = 0; i + 1 < nPoints; i++)
+            {
+                llAccumulateCoverage(
+                    std::max(0.0, std::min(dfXMax, adfSplitX[i])),
+                    adfSplitY[i],
+                    std::max(0.0, std::min(dfXMax, adfSplitX[i + 1])),
+                    adfSplitY[i + 1], nRasterXSize, adfArea.data(),
+                    adfCover.data(), nMinX, nMaxX);
+            }
+        }
+
+        // Cells on the left of nMinX are not covered, and neither are the
+        // ones on the right of nMaxX since the covers of a line sum to zero
+        // for closed rings.
+        const int nLastX = std::min(nMaxX, nRasterXSize - 1);
+        if (nMinX <= nLastX)
+        {
+            double dfCover = 0;
+            for (int x = nMinX; x <= nLastX; x++)
+            {
+                dfCover += adfCover[x];
+                adfCoverage[x - nMinX] =
+                    std::max(0.0, std::min(1.0, -(dfCover + adfArea[x])));
+            }
+            pfnScanlineFunc(pCBData, y, nMinX, nLastX, adfCoverage.data());
+        }
+        if (nMinX <= nMaxX)
+        {
+            std::fill(adfArea.begin() + nMinX, adfArea.begin() + nMaxX + 1,
+                      0.0);
+            std::fill(adfCover.begin() + nMinX, adfCover.begin() + nMaxX + 2,
+                      0.0);
+        }
+
+        anActiveEdges.erase(
+            std::remove_if(anActiveEdges.begin(), anActiveEdges.end(),
+                           [&asEdges, y](size_t iEdge)
+                           {
+                               return std::max(asEdges[iEdge].dfY0,
+                                               asEdges[iEdge].dfY1) <= y + 1;
+                           }),
+            anActiveEdges.end());
+    }
+}
+
 /************************************************************************/
 /*                         GDALdllImagePoint()                          */
 /************************************************************************/
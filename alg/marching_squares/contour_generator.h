@@ -69,6 +69,18 @@ class ContourGenerator
         return CE_None;
     }
 
+    // Start at line lineIdx, the previous line being previousLine (or no
+    // data if nullptr). Used to process a raster by stripes of lines.
+    void setStartLine(size_t lineIdx, const double *previousLine)
+    {
+        lineIdx_ = lineIdx;
+        if (previousLine)
+            std::copy(previousLine, previousLine + width_,
+                      previousLine_.begin());
+        else
+            std::fill(previousLine_.begin(), previousLine_.end(), NaN);
+    }
+
   private:
     size_t width_;
     size_t height_;
@@ -33,6 +33,7 @@
 #include <ostream>
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <list>
 
 namespace marching_squares
@@ -56,6 +57,16 @@ inline bool operator==(const Point &lhs, const Point &rhs)
     return (lhs.x == rhs.x) && (lhs.y == rhs.y);
 }
 
+struct PointHash
+{
+    size_t operator()(const Point &p) const
+    {
+        const size_t h = std::hash<double>()(p.x);
+        return h ^
+               (std::hash<double>()(p.y) + 0x9e3779b9 + (h << 6) + (h >> 2));
+    }
+};
+
 inline std::ostream &operator<<(std::ostream &o, const Point &p)
 {
     o << p.x << " " << p.y;
@@ -30,8 +30,10 @@
 
 #include "point.h"
 
+#include <iterator>
 #include <list>
 #include <map>
+#include <unordered_map>
 
 #include <iostream>
 
@@ -46,10 +48,16 @@ template <typename LineWriter, typename LevelGenerator> struct SegmentMerger
     {
         LineString ls = LineString();
         bool isMerged = false;
+        // creation order, which is also the order in the list of lines
+        size_t order = 0;
     };
     // a collection of unmerged linestrings
     typedef std::list<LineStringEx> Lines;
 
+    // end points of the unmerged linestrings
+    typedef std::unordered_multimap<Point, typename Lines::iterator, PointHash>
+        LineEnds;
+
     SegmentMerger(LineWriter &lineWriter, const LevelGenerator &levelGenerator,
                   bool polygonize_)
         : polygonize(polygonize_), lineWriter_(lineWriter), lines_(),
@@ -63,7 +71,7 @@ template <typename LineWriter, typename LevelGenerator> struct SegmentMerger
         {
             for (auto it = lines_.begin(); it != lines_.end(); ++it)
             {
-                if (!it->second.empty())
+                if (!it->second.lines.empty())
                     debug("remaining unclosed contour");
             }
         }
@@ -71,11 +79,12 @@ template <typename LineWriter, typename LevelGenerator> struct SegmentMerger
         for (auto it = lines_.begin(); it != lines_.end(); ++it)
         {
             const int levelIdx = it->first;
-            while (it->second.begin() != it->second.end())
+            Lines &lines = it->second.lines;
+            while (lines.begin() != lines.end())
             {
                 lineWriter_.addLine(levelGenerator_.level(levelIdx),
-                                    it->second.begin()->ls, /* closed */ false);
-                it->second.pop_front();
+                                    lines.begin()->ls, /* closed */ false);
+                lines.pop_front();
             }
         }
     }
@@ -98,7 +107,7 @@ template <typename LineWriter, typename LevelGenerator> struct SegmentMerger
         // mark lines as non merged
         for (auto &l : lines_)
         {
-            for (auto &ls : l.second)
+            for (auto &ls : l.second.lines)
             {
                 ls.isMerged = false;
             }
@@ -118,8 +127,8 @@ template <typename LineWriter, typename LevelGenerator> struct SegmentMerger
         for (auto &l : lines_)
         {
             const int levelIdx = l.first;
-            auto it = l.second.begin();
-            while (it != l.second.end())
+            auto it = l.second.lines.begin();
+            while (it != l.second.lines.end())
             {
                 if (!it->isMerged)
                 {
@@ -143,48 +152,130 @@ template <typename LineWriter, typename LevelGenerator> struct SegmentMerger
     const bool polygonize;
 
   private:
+    struct LevelLines
+    {
+        Lines lines{};
+        // index of the line ends, only maintained when there are many lines
+        LineEnds ends{};
+        bool indexed = false;
+        size_t nextOrder = 0;
+    };
+
     LineWriter &lineWriter_;
     // lines of each level
-    std::map<int, Lines> lines_;
+    std::map<int, LevelLines> lines_;
     const LevelGenerator &levelGenerator_;
 
+    // Build the index of line ends when linear searches become too costly,
+    // and drop it when there are few lines left
+    static void updateIndex_(LevelLines &level)
+    {
+        if (!level.indexed && level.lines.size() >= 64)
+        {
+            level.indexed = true;
+            for (auto it = level.lines.begin(); it != level.lines.end(); ++it)
+                addEnds_(level, it);
+        }
+        else if (level.indexed && level.lines.size() < 16)
+        {
+            level.indexed = false;
+            level.ends.clear();
+        }
+    }
+
+    static void addEnds_(LevelLines &level, typename Lines::iterator it)
+    {
+        if (!level.indexed)
+            return;
+        level.ends.emplace(it->ls.front(), it);
+        level.ends.emplace(it->ls.back(), it);
+    }
+
+    static void removeEnd_(LevelLines &level, const Point &p,
+                           typename Lines::iterator it)
+    {
+        auto range = level.ends.equal_range(p);
+        for (auto endIt = range.first; endIt != range.second; ++endIt)
+        {
+            if (endIt->second == it)
+            {
+                level.ends.erase(endIt);
+                return;
+            }
+        }
+    }
+
+    static void removeEnds_(LevelLines &level, typename Lines::iterator it)
+    {
+        if (!level.indexed)
+            return;
+        removeEnd_(level, it->ls.front(), it);
+        removeEnd_(level, it->ls.back(), it);
+    }
+
+    // Returns the first line, in list order, after the line of order
+    // minOrder, that has p1 or p2 as an end point
+    static typename Lines::iterator findLine_(LevelLines &level,
+                                              const Point &p1, const Point &p2,
+                                              size_t minOrder)
+    {
+        if (!level.indexed)
+        {
+            for (auto it = level.lines.begin(); it != level.lines.end(); ++it)
+            {
+                if (it->order >= minOrder &&
+                    (it->ls.back() == p1 || it->ls.front() == p1 ||
+                     it->ls.back() == p2 || it->ls.front() == p2))
+                {
+                    return it;
+                }
+            }
+            return level.lines.end();
+        }
+
+        auto found = level.lines.end();
+        for (const Point *p : {&p1, &p2})
+        {
+            auto range = level.ends.equal_range(*p);
+            for (auto endIt = range.first; endIt != range.second; ++endIt)
+            {
+                const auto &candidate = endIt->second;
+                if (candidate->order >= minOrder &&
+                    (found == level.lines.end() ||
+                     candidate->order < found->order))
+                {
+                    found = candidate;
+                }
+            }
+        }
+        return found;
+    }
+
     void addSegment_(int levelIdx, const Point &start, const Point &end)
     {
-        Lines &lines = lines_[levelIdx];
+        LevelLines &level = lines_[levelIdx];
+        Lines &lines = level.lines;
 
         if (start == end)
         {
             debug("degenerate segment (%f %f)", start.x, start.y);
             return;
         }
+        updateIndex_(level);
         // attempt to merge segment with existing line
-        auto it = lines.begin();
-        for (; it != lines.end(); ++it)
+        auto it = findLine_(level, start, end, 0);
+        if (it != lines.end())
         {
+            removeEnds_(level, it);
             if (it->ls.back() == end)
-            {
                 it->ls.push_back(start);
-                it->isMerged = true;
-                break;
-            }
-            if (it->ls.front() == end)
-            {
+            else if (it->ls.front() == end)
                 it->ls.push_front(start);
-                it->isMerged = true;
-                break;
-            }
-            if (it->ls.back() == start)
-            {
+            else if (it->ls.back() == start)
                 it->ls.push_back(end);
-                it->isMerged = true;
-                break;
-            }
-            if (it->ls.front() == start)
-            {
+            else
                 it->ls.push_front(end);
-                it->isMerged = true;
-                break;
-            }
+            it->isMerged = true;
         }
 
         if (it == lines.end())
@@ -194,6 +285,8 @@ template <typename LineWriter, typename LevelGenerator> struct SegmentMerger
             lines.back().ls.push_back(start);
             lines.back().ls.push_back(end);
             lines.back().isMerged = true;
+            lines.back().order = level.nextOrder++;
+            addEnds_(level, std::prev(lines.end()));
         }
         else if (polygonize && (it->ls.front() == it->ls.back()))
         {
@@ -208,63 +301,70 @@ template <typename LineWriter, typename LevelGenerator> struct SegmentMerger
             // there is no need to test previous elements
             // also: a segment merges at most two lines, no need to stall here
             // ;)
-            auto other = it;
-            ++other;
-            for (; other != lines.end(); ++other)
+            auto other = findLine_(level, it->ls.front(), it->ls.back(),
+                                   it->order + 1);
+            if (other == lines.end())
             {
-                if (it->ls.back() == other->ls.front())
-                {
-                    it->ls.pop_back();
-                    it->ls.splice(it->ls.end(), other->ls);
-                    it->isMerged = true;
-                    lines.erase(other);
-                    // if that makes a closed ring, returns it
-                    if (it->ls.front() == it->ls.back())
-                        emitLine_(levelIdx, it, /* closed */ true);
-                    break;
-                }
-                else if (other->ls.back() == it->ls.front())
-                {
-                    it->ls.pop_front();
-                    other->ls.splice(other->ls.end(), it->ls);
-                    other->isMerged = true;
-                    lines.erase(it);
-                    // if that makes a closed ring, returns it
-                    if (other->ls.front() == other->ls.back())
-                        emitLine_(levelIdx, other, /* closed */ true);
-                    break;
-                }
-                // two lists must be merged but one is in the opposite direction
-                else if (it->ls.back() == other->ls.back())
+                addEnds_(level, it);
+                return;
+            }
+            removeEnds_(level, other);
+            if (it->ls.back() == other->ls.front())
+            {
+                it->ls.pop_back();
+                it->ls.splice(it->ls.end(), other->ls);
+                it->isMerged = true;
+                lines.erase(other);
+                // if that makes a closed ring, returns it
+                if (it->ls.front() == it->ls.back())
+                    emitLine_(levelIdx, it, /* closed */ true);
+                else
+                    addEnds_(level, it);
+            }
+            else if (other->ls.back() == it->ls.front())
+            {
+                it->ls.pop_front();
+                other->ls.splice(other->ls.end(), it->ls);
+                other->isMerged = true;
+                lines.erase(it);
+                // if that makes a closed ring, returns it
+                if (other->ls.front() == other->ls.back())
+                    emitLine_(levelIdx, other, /* closed */ true);
+                else
+                    addEnds_(level, other);
+            }
+            // two lists must be merged but one is in the opposite direction
+            else if (it->ls.back() == other->ls.back())
+            {
+                it->ls.pop_back();
+                for (auto rit = other->ls.rbegin(); rit != other->ls.rend();
+                     ++rit)
                 {
-                    it->ls.pop_back();
-                    for (auto rit = other->ls.rbegin(); rit != other->ls.rend();
-                         ++rit)
-                    {
-                        it->ls.push_back(*rit);
-                    }
-                    it->isMerged = true;
-                    lines.erase(other);
-                    // if that makes a closed ring, returns it
-                    if (it->ls.front() == it->ls.back())
-                        emitLine_(levelIdx, it, /* closed */ true);
-                    break;
+                    it->ls.push_back(*rit);
                 }
-                else if (it->ls.front() == other->ls.front())
+                it->isMerged = true;
+                lines.erase(other);
+                // if that makes a closed ring, returns it
+                if (it->ls.front() == it->ls.back())
+                    emitLine_(levelIdx, it, /* closed */ true);
+                else
+                    addEnds_(level, it);
+            }
+            else
+            {
+                it->ls.pop_front();
+                for (auto rit = other->ls.begin(); rit != other->ls.end();
+                     ++rit)
                 {
-                    it->ls.pop_front();
-                    for (auto rit = other->ls.begin(); rit != other->ls.end();
-                         ++rit)
-                    {
-                        it->ls.push_front(*rit);
-                    }
-                    it->isMerged = true;
-                    lines.erase(other);
-                    // if that makes a closed ring, returns it
-                    if (it->ls.front() == it->ls.back())
-                        emitLine_(levelIdx, it, /* closed */ true);
-                    break;
+                    it->ls.push_front(*rit);
                 }
+                it->isMerged = true;
+                lines.erase(other);
+                // if that makes a closed ring, returns it
+                if (it->ls.front() == it->ls.back())
+                    emitLine_(levelIdx, it, /* closed */ true);
+                else
+                    addEnds_(level, it);
             }
         }
     }
@@ -272,11 +372,13 @@ template <typename LineWriter, typename LevelGenerator> struct SegmentMerger
     typename Lines::iterator emitLine_(int levelIdx,
                                        typename Lines::iterator it, bool closed)
     {
-        Lines &lines = lines_[levelIdx];
+        LevelLines &level = lines_[levelIdx];
+        Lines &lines = level.lines;
         if (lines.empty())
             lines_.erase(levelIdx);
 
         // consume "it" and remove it from the list
+        removeEnds_(level, it);
         lineWriter_.addLine(levelGenerator_.level(levelIdx), it->ls, closed);
         return lines.erase(it);
     }
@@ -35,9 +35,15 @@
 #include <string.h>
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -50,6 +56,9 @@
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
+#include "ogr_recordbatch.h"
 
 #include "polygonize_polygonizer.h"
 
@@ -81,6 +90,1081 @@ static CPLErr GPMaskImageData(GDALRasterBandH hMaskBand, GByte *pabyMaskLine,
     return CE_None;
 }
 
+/************************************************************************/
+/*                   Multi-threaded polygonization                      */
+/*                                                                      */
+/*      The raster is split into horizontal stripes that are            */
+/*      polygonized independently by worker threads. Polygons that do   */
+/*      not touch the first or last line of their stripe are complete   */
+/*      and written as soon as their stripe has been processed. The     */
+/*      other ones ("seam pieces") are merged with the pieces of the    */
+/*      neighbouring stripes they are connected to, by cancelling their */
+/*      common edges along the seams and re-assembling the remaining    */
+/*      edges into rings.                                               */
+/************************************************************************/
+
+namespace
+{
+
+struct GPContext
+{
+    int nXSize = 0;
+    int nYSize = 0;
+    int nConnectedness = 4;
+    const double *padfGeoTransform = nullptr;
+};
+
+template <class DataType> struct GPSeamPiece
+{
+    DataType nValue{};
+    // Rows of the seams with the previous and next stripes, or -1.
+    GIntBig nTopSeamRow = -1;
+    GIntBig nBottomSeamRow = -1;
+    std::vector<Arc> aoRings{};
+};
+
+template <class DataType> struct GPStripe
+{
+    const GPContext *psCtx = nullptr;
+    int nYOff = 0;
+    int nYSize = 0;
+    std::vector<DataType> anVal{};
+
+    // Outputs of GPProcessStripe()
+    CPLErr eErr = CE_None;
+    std::vector<std::pair<OGRGeometryH, DataType>> aoCompletedPolygons{};
+    std::vector<GPSeamPiece<DataType>> aoSeamPieces{};
+    // Index in aoSeamPieces of the seam piece to which each pixel of the
+    // first (resp. last) line belongs, or -1. Empty for the first (resp. last)
+    // stripe of the raster.
+    std::vector<int> anTopPiece{};
+    std::vector<int> anBottomPiece{};
+    std::vector<DataType> anTopVal{};
+    std::vector<DataType> anBottomVal{};
+
+    // Set (under *poMutex) once the stripe has been processed.
+    bool bDone = false;
+    std::mutex *poMutex = nullptr;
+    std::condition_variable *poCV = nullptr;
+
+    GPStripe() = default;
+    GPStripe(const GPStripe &) = delete;
+    GPStripe &operator=(const GPStripe &) = delete;
+
+    ~GPStripe()
+    {
+        for (const auto &oPair : aoCompletedPolygons)
+            OGR_G_DestroyGeometry(oPair.first);
+    }
+};
+
+/************************************************************************/
+/*                           GPGetRings()                               */
+/************************************************************************/
+
+// Return the rings of a raster polygon, in the order in which
+// CreateOGRPolygon() would emit them.
+static std::vector<Arc> GPGetRings(const RPolygon &oPolygon)
+{
+    std::vector<Arc> aoRings;
+    std::vector<bool> oAccessedArc(oPolygon.oArcConnections.size(), false);
+    for (std::size_t iFirstArc = 0; iFirstArc < oAccessedArc.size();
+         ++iFirstArc)
+    {
+        if (oAccessedArc[iFirstArc])
+            continue;
+        Arc oRing;
+        std::size_t iArc = iFirstArc;
+        do
+        {
+            oAccessedArc[iArc] = true;
+            const Arc &oArc = *(oPolygon.oArcs[iArc]);
+            if (oPolygon.oArcRighthandFollow[iArc])
+                oRing.insert(oRing.end(), oArc.begin(), oArc.end());
+            else
+                oRing.insert(oRing.end(), oArc.rbegin(), oArc.rend());
+            iArc = oPolygon.oArcConnections[iArc];
+        } while (iArc != iFirstArc);
+        aoRings.emplace_back(std::move(oRing));
+    }
+    return aoRings;
+}
+
+/************************************************************************/
+/*                         GPStripeReceiver                             */
+/************************************************************************/
+
+template <class DataType>
+class GPStripeReceiver final : public PolygonReceiver<DataType>
+{
+    GPStripe<DataType> &m_oStripe;
+    const std::vector<bool> &m_abIsSeamPolygon;
+    std::vector<int> &m_anSeamPieceIdx;
+
+  public:
+    // Final polygon ids of the line before the one being processed.
+    const GInt32 *panLastLineFinalId = nullptr;
+
+    GPStripeReceiver(GPStripe<DataType> &oStripe,
+                     const std::vector<bool> &abIsSeamPolygon,
+                     std::vector<int> &anSeamPieceIdx)
+        : m_oStripe(oStripe), m_abIsSeamPolygon(abIsSeamPolygon),
+          m_anSeamPieceIdx(anSeamPieceIdx)
+    {
+    }
+
+    void receive(RPolygon *poPolygon, DataType nPolygonCellValue) override
+    {
+        const GInt32 nId = panLastLineFinalId[poPolygon->iBottomRightCol];
+        if (m_abIsSeamPolygon[nId])
+        {
+            GPSeamPiece<DataType> oPiece;
+            oPiece.nValue = nPolygonCellValue;
+            if (m_oStripe.nYOff > 0)
+                oPiece.nTopSeamRow = m_oStripe.nYOff;
+            if (m_oStripe.nYOff + m_oStripe.nYSize < m_oStripe.psCtx->nYSize)
+                oPiece.nBottomSeamRow = m_oStripe.nYOff + m_oStripe.nYSize;
+            oPiece.aoRings = GPGetRings(*poPolygon);
+            m_anSeamPieceIdx[nId] =
+                static_cast<int>(m_oStripe.aoSeamPieces.size());
+            m_oStripe.aoSeamPieces.emplace_back(std::move(oPiece));
+        }
+        else
+        {
+            m_oStripe.aoCompletedPolygons.emplace_back(
+                CreateOGRPolygon(poPolygon, m_oStripe.psCtx->padfGeoTransform),
+                nPolygonCellValue);
+        }
+    }
+};
+
+/************************************************************************/
+/*                          GPProcessStripe()                           */
+/************************************************************************/
+
+// Same two passes as the single-threaded code path of GDALPolygonizeT(),
+// restricted to the lines of the stripe.
+template <class DataType, class EqualityTest>
+static CPLErr GPProcessStripe(GPStripe<DataType> &oStripe)
+{
+    const GPContext &sCtx = *(oStripe.psCtx);
+    const int nXSize = sCtx.nXSize;
+    const int nYSize = oStripe.nYSize;
+    const bool bHasTopSeam = oStripe.nYOff > 0;
+    const bool bHasBottomSeam = oStripe.nYOff + nYSize < sCtx.nYSize;
+    DataType *panVal = oStripe.anVal.data();
+
+    std::vector<GInt32> anLastLineId(nXSize);
+    std::vector<GInt32> anThisLineId(nXSize);
+    std::vector<GInt32> anTopId;
+    std::vector<GInt32> anBottomId;
+
+    GDALRasterPolygonEnumeratorT<DataType, EqualityTest> oFirstEnum(
+        sCtx.nConnectedness);
+    for (int iY = 0; iY < nYSize; iY++)
+    {
+        DataType *panThisLineVal = panVal + static_cast<size_t>(iY) * nXSize;
+        if (!oFirstEnum.ProcessLine(
+                iY == 0 ? nullptr : panThisLineVal - nXSize, panThisLineVal,
+                iY == 0 ? nullptr : anLastLineId.data(), anThisLineId.data(),
+                nXSize))
+        {
+            return CE_Failure;
+        }
+        if (iY == 0 && bHasTopSeam)
+            anTopId = anThisLineId;
+        if (iY == nYSize - 1 && bHasBottomSeam)
+            anBottomId = anThisLineId;
+        std::swap(anLastLineId, anThisLineId);
+    }
+    oFirstEnum.CompleteMerges();
+
+    // Identify the polygons that touch a seam.
+    std::vector<bool> abIsSeamPolygon(oFirstEnum.nNextPolygonId, false);
+    for (auto *panIds : {&anTopId, &anBottomId})
+    {
+        for (auto &nId : *panIds)
+        {
+            if (nId >= 0)
+            {
+                nId = oFirstEnum.panPolyIdMap[nId];
+                abIsSeamPolygon[nId] = true;
+            }
+        }
+    }
+
+    GDALRasterPolygonEnumeratorT<DataType, EqualityTest> oSecondEnum(
+        sCtx.nConnectedness);
+    std::vector<int> anSeamPieceIdx(oFirstEnum.nNextPolygonId, -1);
+    GPStripeReceiver<DataType> oReceiver(oStripe, abIsSeamPolygon,
+                                         anSeamPieceIdx);
+    Polygonizer<GInt32, DataType> oPolygonizer{-1, &oReceiver};
+    std::vector<TwoArm> aoLastLineArm(nXSize + 2);
+    std::vector<TwoArm> aoThisLineArm(nXSize + 2);
+    for (auto &oArm : aoLastLineArm)
+        oArm.poPolyInside = oPolygonizer.getTheOuterPolygon();
+    std::vector<GInt32> anLastLineFinalId(nXSize);
+    std::vector<GInt32> anThisLineFinalId(nXSize);
+
+    for (int iY = 0; iY < nYSize + 1; iY++)
+    {
+        const IndexType nRow = static_cast<IndexType>(oStripe.nYOff + iY);
+        const DataType *panLastLineVal =
+            panVal + static_cast<size_t>(std::max(0, iY - 1)) * nXSize;
+        oReceiver.panLastLineFinalId = anLastLineFinalId.data();
+        if (iY == nYSize)
+        {
+            std::fill(anThisLineFinalId.begin(), anThisLineFinalId.end(),
+                      decltype(oPolygonizer)::THE_OUTER_POLYGON_ID);
+        }
+        else
+        {
+            DataType *panThisLineVal =
+                panVal + static_cast<size_t>(iY) * nXSize;
+            if (!oSecondEnum.ProcessLine(
+                    iY == 0 ? nullptr : panThisLineVal - nXSize,
+                    panThisLineVal, iY == 0 ? nullptr : anLastLineId.data(),
+                    anThisLineId.data(), nXSize))
+            {
+                return CE_Failure;
+            }
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                anThisLineFinalId[iX] =
+                    anThisLineId[iX] == -1
+                        ? -1
+                        : oFirstEnum.panPolyIdMap[anThisLineId[iX]];
+            }
+            std::swap(anLastLineId, anThisLineId);
+        }
+
+        oPolygonizer.processLine(anThisLineFinalId.data(), panLastLineVal,
+                                 aoThisLineArm.data(), aoLastLineArm.data(),
+                                 nRow, nXSize);
+
+        std::swap(anLastLineFinalId, anThisLineFinalId);
+        std::swap(aoThisLineArm, aoLastLineArm);
+    }
+
+    // Record which seam piece each pixel of the first and last lines belongs
+    // to, and their values, so that pieces can be merged with the ones of
+    // the neighbouring stripes.
+    const auto RecordSeam = [&](const std::vector<GInt32> &anIds,
+                                const DataType *panLineVal,
+                                std::vector<int> &anPiece,
+                                std::vector<DataType> &anLineVal)
+    {
+        anPiece.resize(nXSize);
+        for (int iX = 0; iX < nXSize; iX++)
+            anPiece[iX] = anIds[iX] < 0 ? -1 : anSeamPieceIdx[anIds[iX]];
+        anLineVal.assign(panLineVal, panLineVal + nXSize);
+    };
+    if (bHasTopSeam)
+        RecordSeam(anTopId, panVal, oStripe.anTopPiece, oStripe.anTopVal);
+    if (bHasBottomSeam)
+        RecordSeam(anBottomId,
+                   panVal + static_cast<size_t>(nYSize - 1) * nXSize,
+                   oStripe.anBottomPiece, oStripe.anBottomVal);
+
+    // Release the pixel values as soon as possible.
+    std::vector<DataType>().swap(oStripe.anVal);
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                        GPProcessStripeJob()                          */
+/************************************************************************/
+
+template <class DataType, class EqualityTest>
+static void GPProcessStripeJob(void *pData)
+{
+    auto psStripe = static_cast<GPStripe<DataType> *>(pData);
+    try
+    {
+        psStripe->eErr = GPProcessStripe<DataType, EqualityTest>(*psStripe);
+    }
+    catch (const std::exception &)
+    {
+        psStripe->eErr = CE_Failure;
+    }
+
+    std::lock_guard<std::mutex> oLock(*(psStripe->poMutex));
+    psStripe->bDone = true;
+    psStripe->poCV->notify_all();
+}
+
+/************************************************************************/
+/*                       GPMergeSeamPieces()                            */
+/************************************************************************/
+
+// Merge the rings of seam pieces that belong to the same polygon.
+//
+// Each piece ring is a sequence of pixel corners (row, col) with the
+// polygon interior on the same side, so that edges of two connected pieces
+// along their common seam have opposite directions. Those edges are
+// cancelled and the remaining ones are chained into rings. At vertices where
+// two rings touch, we always take the same turn, so that they are kept as
+// separate rings, as the single-threaded code path does.
+template <class DataType>
+static std::vector<Arc>
+GPMergeSeamPieces(const std::vector<const GPSeamPiece<DataType> *> &apoPieces)
+{
+    struct Edge
+    {
+        Point oFrom;
+        Point oTo;
+    };
+
+    std::vector<Edge> aoEdges;
+    // Per seam row, horizontal edges along it as (start col, end col) where
+    // start col < end col, for both directions.
+    std::map<IndexType, std::pair<std::vector<std::pair<IndexType, IndexType>>,
+                                  std::vector<std::pair<IndexType, IndexType>>>>
+        oMapSeamEdges;
+
+    for (const auto *poPiece : apoPieces)
+    {
+        for (const auto &oRing : poPiece->aoRings)
+        {
+            for (size_t i = 0; i < oRing.size(); ++i)
+            {
+                const Point &oFrom = oRing[i];
+                const Point &oTo = oRing[(i + 1) % oRing.size()];
+                if (oFrom == oTo)
+                    continue;
+                if (oFrom[0] == oTo[0] &&
+                    (oFrom[0] == poPiece->nTopSeamRow ||
+                     oFrom[0] == poPiece->nBottomSeamRow))
+                {
+                    auto &oEdges = oMapSeamEdges[oFrom[0]];
+                    if (oFrom[1] < oTo[1])
+                        oEdges.first.emplace_back(oFrom[1], oTo[1]);
+                    else
+                        oEdges.second.emplace_back(oTo[1], oFrom[1]);
+                }
+                else
+                {
+                    aoEdges.push_back(Edge{oFrom, oTo});
+                }
+            }
+        }
+    }
+
+    for (const auto &oIter : oMapSeamEdges)
+    {
+        const IndexType nRow = oIter.first;
+        const auto &aoForward = oIter.second.first;
+        const auto &aoBackward = oIter.second.second;
+
+        std::vector<IndexType> anBreaks;
+        for (const auto *paoSegs : {&aoForward, &aoBackward})
+        {
+            for (const auto &oSeg : *paoSegs)
+            {
+                anBreaks.push_back(oSeg.first);
+                anBreaks.push_back(oSeg.second);
+            }
+        }
+        std::sort(anBreaks.begin(), anBreaks.end());
+        anBreaks.erase(std::unique(anBreaks.begin(), anBreaks.end()),
+                       anBreaks.end());
+
+        // Directions covering each elementary interval between breaks
+        std::vector<GByte> abyCoverage(anBreaks.size(), 0);
+        const auto Cover = [&anBreaks, &abyCoverage](
+                               const std::vector<std::pair<IndexType,
+                                                           IndexType>> &aoSegs,
+                               GByte byFlag)
+        {
+            for (const auto &oSeg : aoSegs)
+            {
+                for (size_t i = std::lower_bound(anBreaks.begin(),
+                                                 anBreaks.end(), oSeg.first) -
+                                anBreaks.begin();
+                     anBreaks[i] < oSeg.second; ++i)
+                {
+                    abyCoverage[i] |= byFlag;
+                }
+            }
+        };
+        Cover(aoForward, 1);
+        Cover(aoBackward, 2);
+
+        for (size_t i = 0; i + 1 < anBreaks.size(); ++i)
+        {
+            const Point oLeft{nRow, anBreaks[i]};
+            const Point oRight{nRow, anBreaks[i + 1]};
+            if (abyCoverage[i] == 1)
+                aoEdges.push_back(Edge{oLeft, oRight});
+            else if (abyCoverage[i] == 2)
+                aoEdges.push_back(Edge{oRight, oLeft});
+        }
+    }
+
+    const auto Key = [](const Point &oPoint)
+    { return (static_cast<GUInt64>(oPoint[0]) << 32) | oPoint[1]; };
+    std::unordered_map<GUInt64, std::vector<size_t>> oMapOutgoingEdges;
+    for (size_t i = 0; i < aoEdges.size(); ++i)
+        oMapOutgoingEdges[Key(aoEdges[i].oFrom)].push_back(i);
+
+    const auto Sign = [](IndexType nFrom, IndexType nTo)
+    { return nTo > nFrom ? 1 : nTo < nFrom ? -1 : 0; };
+
+    // Edge following iEdge in its ring.
+    const auto GetNextEdge = [&](size_t iEdge)
+    {
+        const Edge &oEdge = aoEdges[iEdge];
+        const auto &anCandidates = oMapOutgoingEdges[Key(oEdge.oTo)];
+        CPLAssert(!anCandidates.empty());
+        if (anCandidates.size() == 1)
+            return anCandidates[0];
+        const int nInRow = Sign(oEdge.oFrom[0], oEdge.oTo[0]);
+        const int nInCol = Sign(oEdge.oFrom[1], oEdge.oTo[1]);
+        for (size_t iCandidate : anCandidates)
+        {
+            const Edge &oOut = aoEdges[iCandidate];
+            const int nOutRow = Sign(oOut.oFrom[0], oOut.oTo[0]);
+            const int nOutCol = Sign(oOut.oFrom[1], oOut.oTo[1]);
+            const int nTurn = nInRow * nOutCol - nInCol * nOutRow;
+            if (nTurn < 0)
+                return iCandidate;
+        }
+        return anCandidates[0];
+    };
+
+    std::vector<Arc> aoRings;
+    std::vector<bool> abUsedEdge(aoEdges.size(), false);
+    for (size_t iFirstEdge = 0; iFirstEdge < aoEdges.size(); ++iFirstEdge)
+    {
+        if (abUsedEdge[iFirstEdge])
+            continue;
+        Arc oRing;
+        size_t iEdge = iFirstEdge;
+        do
+        {
+            abUsedEdge[iEdge] = true;
+            oRing.push_back(aoEdges[iEdge].oFrom);
+            iEdge = GetNextEdge(iEdge);
+        } while (iEdge != iFirstEdge && !abUsedEdge[iEdge]);
+
+        // Remove intermediate vertices of straight lines.
+        Arc oSimplifiedRing;
+        for (size_t i = 0; i < oRing.size(); ++i)
+        {
+            const Point &oPrev = oRing[(i + oRing.size() - 1) % oRing.size()];
+            const Point &oCur = oRing[i];
+            const Point &oNext = oRing[(i + 1) % oRing.size()];
+            if (!((oPrev[0] == oCur[0] && oCur[0] == oNext[0]) ||
+                  (oPrev[1] == oCur[1] && oCur[1] == oNext[1])))
+            {
+                oSimplifiedRing.push_back(oCur);
+            }
+        }
+
+        // Start from the top-left most vertex.
+        std::rotate(oSimplifiedRing.begin(),
+                    std::min_element(oSimplifiedRing.begin(),
+                                     oSimplifiedRing.end()),
+                    oSimplifiedRing.end());
+        aoRings.emplace_back(std::move(oSimplifiedRing));
+    }
+
+    // Put the exterior ring first. It is the one that has the same
+    // orientation as the first ring (which is an exterior ring) of a piece.
+    const auto GetSignedArea = [](const Arc &oRing)
+    {
+        double dfArea = 0;
+        for (size_t i = 0; i < oRing.size(); ++i)
+        {
+            const Point &oCur = oRing[i];
+            const Point &oNext = oRing[(i + 1) % oRing.size()];
+            dfArea += static_cast<double>(oCur[1]) * oNext[0] -
+                      static_cast<double>(oNext[1]) * oCur[0];
+        }
+        return dfArea;
+    };
+    const bool bExteriorIsPositive =
+        GetSignedArea(apoPieces[0]->aoRings[0]) > 0;
+    std::stable_partition(
+        aoRings.begin(), aoRings.end(),
+        [&GetSignedArea, bExteriorIsPositive](const Arc &oRing)
+        { return (GetSignedArea(oRing) > 0) == bExteriorIsPositive; });
+
+    return aoRings;
+}
+
+/************************************************************************/
+/*                         GPFeatureWriter                              */
+/************************************************************************/
+
+// Write polygons to the output layer, in batches with WriteArrowBatch()
+// when the layer supports it efficiently, or feature by feature otherwise.
+template <class DataType> class GPFeatureWriter
+{
+    static constexpr size_t BATCH_MAX_FEATURES = 65536;
+    static constexpr size_t BATCH_MAX_WKB_BYTES = 64 * 1024 * 1024;
+
+    OGRLayerH m_hLayer;
+    int m_iPixValField;
+
+    bool m_bUseArrow = false;
+    std::string m_osGeomFieldName{};
+    std::string m_osPixValFieldName{};
+    OGRFieldType m_ePixValFieldType = OFTReal;
+    std::vector<GByte> m_abyWKB{};
+    std::vector<GInt32> m_anWKBOffsets{0};
+    std::vector<DataType> m_anValues{};
+
+    CPL_DISALLOW_COPY_ASSIGN(GPFeatureWriter)
+
+    CPLErr WriteFeature(OGRGeometryH hPolygon, DataType nValue);
+
+  public:
+    GPFeatureWriter(OGRLayerH hLayer, int iPixValField);
+
+    // Takes ownership of hPolygon.
+    CPLErr Write(OGRGeometryH hPolygon, DataType nValue);
+    CPLErr Flush();
+};
+
+template <class DataType>
+GPFeatureWriter<DataType>::GPFeatureWriter(OGRLayerH hLayer, int iPixValField)
+    : m_hLayer(hLayer), m_iPixValField(iPixValField)
+{
+    // The Arrow based writers require all the fields of the layer to be
+    // present in the batches.
+    OGRFeatureDefnH hDefn = OGR_L_GetLayerDefn(hLayer);
+    if (!OGR_L_TestCapability(hLayer, OLCFastWriteArrowBatch) ||
+        OGR_FD_GetGeomFieldCount(hDefn) != 1 ||
+        OGR_FD_GetFieldCount(hDefn) != (iPixValField >= 0 ? 1 : 0))
+    {
+        return;
+    }
+    m_osGeomFieldName = OGR_L_GetGeometryColumn(hLayer);
+    if (m_osGeomFieldName.empty())
+        m_osGeomFieldName = "wkb_geometry";
+    if (iPixValField >= 0)
+    {
+        OGRFieldDefnH hFieldDefn = OGR_FD_GetFieldDefn(hDefn, iPixValField);
+        m_osPixValFieldName = OGR_Fld_GetNameRef(hFieldDefn);
+        m_ePixValFieldType = OGR_Fld_GetType(hFieldDefn);
+        if (m_ePixValFieldType != OFTInteger &&
+            m_ePixValFieldType != OFTInteger64 && m_ePixValFieldType != OFTReal)
+        {
+            return;
+        }
+    }
+    m_bUseArrow = true;
+}
+
+template <class DataType>
+CPLErr GPFeatureWriter<DataType>::WriteFeature(OGRGeometryH hPolygon,
+                                               DataType nValue)
+{
+    OGRFeatureH hFeat = OGR_F_Create(OGR_L_GetLayerDefn(m_hLayer));
+    OGR_F_SetGeometryDirectly(hFeat, hPolygon);
+    if (m_iPixValField >= 0)
+        OGR_F_SetFieldDouble(hFeat, m_iPixValField,
+                             static_cast<double>(nValue));
+    const CPLErr eErr =
+        OGR_L_CreateFeature(m_hLayer, hFeat) == OGRERR_NONE ? CE_None
+                                                            : CE_Failure;
+    OGR_F_Destroy(hFeat);
+    return eErr;
+}
+
+template <class DataType>
+CPLErr GPFeatureWriter<DataType>::Write(OGRGeometryH hPolygon, DataType nValue)
+{
+    if (!m_bUseArrow)
+        return WriteFeature(hPolygon, nValue);
+
+    const size_t nWKBSize = static_cast<size_t>(OGR_G_WkbSize(hPolygon));
+    if (!m_anValues.empty() &&
+        (m_anValues.size() == BATCH_MAX_FEATURES ||
+         m_abyWKB.size() + nWKBSize > BATCH_MAX_WKB_BYTES))
+    {
+        const CPLErr eErr = Flush();
+        if (eErr != CE_None)
+        {
+            OGR_G_DestroyGeometry(hPolygon);
+            return eErr;
+        }
+    }
+    if (nWKBSize > BATCH_MAX_WKB_BYTES)
+    {
+        // Would not fit in the int32 offsets of a single batch.
+        return WriteFeature(hPolygon, nValue);
+    }
+
+    const size_t nOldSize = m_abyWKB.size();
+    m_abyWKB.resize(nOldSize + nWKBSize);
+    OGR_G_ExportToWkb(hPolygon, wkbNDR, m_abyWKB.data() + nOldSize);
+    OGR_G_DestroyGeometry(hPolygon);
+    m_anWKBOffsets.push_back(static_cast<GInt32>(m_abyWKB.size()));
+    m_anValues.push_back(nValue);
+    return CE_None;
+}
+
+// Arrow array whose buffers are owned by its private data.
+struct GPArrowArrayPrivateData
+{
+    std::vector<GByte> abyData{};
+    std::vector<GInt32> anOffsets{};
+    std::vector<const void *> apBuffers{};
+    std::vector<struct ArrowArray *> apsChildren{};
+};
+
+static void GPReleaseArrowArray(struct ArrowArray *psArray)
+{
+    for (int64_t i = 0; i < psArray->n_children; ++i)
+    {
+        if (psArray->children[i]->release)
+            psArray->children[i]->release(psArray->children[i]);
+        delete psArray->children[i];
+    }
+    delete static_cast<GPArrowArrayPrivateData *>(psArray->private_data);
+    psArray->release = nullptr;
+}
+
+static void GPReleaseArrowSchema(struct ArrowSchema *psSchema)
+{
+    psSchema->release = nullptr;
+}
+
+template <class DataType> CPLErr GPFeatureWriter<DataType>::Flush()
+{
+    if (m_anValues.empty())
+        return CE_None;
+
+    const int64_t nLength = static_cast<int64_t>(m_anValues.size());
+
+    const auto InitArray =
+        [nLength](struct ArrowArray *psArray, GPArrowArrayPrivateData *psPriv)
+    {
+        memset(psArray, 0, sizeof(*psArray));
+        psArray->length = nLength;
+        psArray->n_buffers = static_cast<int64_t>(psPriv->apBuffers.size());
+        psArray->buffers = psPriv->apBuffers.data();
+        psArray->private_data = psPriv;
+        psArray->release = GPReleaseArrowArray;
+    };
+
+    auto psGeomPriv = new GPArrowArrayPrivateData();
+    psGeomPriv->abyData.swap(m_abyWKB);
+    psGeomPriv->anOffsets.swap(m_anWKBOffsets);
+    psGeomPriv->apBuffers = {nullptr, psGeomPriv->anOffsets.data(),
+                             psGeomPriv->abyData.data()};
+    auto psGeomArray = new struct ArrowArray;
+    InitArray(psGeomArray, psGeomPriv);
+
+    struct ArrowArray *psValArray = nullptr;
+    if (m_iPixValField >= 0)
+    {
+        auto psValPriv = new GPArrowArrayPrivateData();
+        if (m_ePixValFieldType == OFTInteger)
+        {
+            psValPriv->abyData.resize(m_anValues.size() * sizeof(GInt32));
+            GInt32 *panOut =
+                reinterpret_cast<GInt32 *>(psValPriv->abyData.data());
+            for (size_t i = 0; i < m_anValues.size(); ++i)
+            {
+                const double dfVal = static_cast<double>(m_anValues[i]);
+                panOut[i] = static_cast<GInt32>(std::max(
+                    static_cast<double>(std::numeric_limits<GInt32>::min()),
+                    std::min(static_cast<double>(
+                                 std::numeric_limits<GInt32>::max()),
+                             dfVal)));
+            }
+        }
+        else if (m_ePixValFieldType == OFTInteger64)
+        {
+            psValPriv->abyData.resize(m_anValues.size() * sizeof(GInt64));
+            GInt64 *panOut =
+                reinterpret_cast<GInt64 *>(psValPriv->abyData.data());
+            for (size_t i = 0; i < m_anValues.size(); ++i)
+                panOut[i] = static_cast<GInt64>(m_anValues[i]);
+        }
+        else
+        {
+            psValPriv->abyData.resize(m_anValues.size() * sizeof(double));
+            double *padfOut =
+                reinterpret_cast<double *>(psValPriv->abyData.data());
+            for (size_t i = 0; i < m_anValues.size(); ++i)
+                padfOut[i] = static_cast<double>(m_anValues[i]);
+        }
+        psValPriv->apBuffers = {nullptr, psValPriv->abyData.data()};
+        psValArray = new struct ArrowArray;
+        InitArray(psValArray, psValPriv);
+    }
+
+    auto psPriv = new GPArrowArrayPrivateData();
+    psPriv->apBuffers = {nullptr};
+    psPriv->apsChildren.push_back(psGeomArray);
+    if (psValArray)
+        psPriv->apsChildren.push_back(psValArray);
+    struct ArrowArray sArray;
+    InitArray(&sArray, psPriv);
+    sArray.n_children = static_cast<int64_t>(psPriv->apsChildren.size());
+    sArray.children = psPriv->apsChildren.data();
+
+    // ARROW:extension:name=ogc.wkb, in the binary encoding of Arrow metadata
+    std::string osGeomMetadata;
+    const auto AppendInt32 = [&osGeomMetadata](GInt32 nVal)
+    {
+        CPL_LSBPTR32(&nVal);
+        osGeomMetadata.append(reinterpret_cast<const char *>(&nVal),
+                              sizeof(nVal));
+    };
+    const auto AppendString = [&osGeomMetadata, &AppendInt32](const char *psz)
+    {
+        AppendInt32(static_cast<GInt32>(strlen(psz)));
+        osGeomMetadata.append(psz);
+    };
+    AppendInt32(1);
+    AppendString("ARROW:extension:name");
+    AppendString("ogc.wkb");
+
+    struct ArrowSchema asChildSchemas[2];
+    struct ArrowSchema *apsChildSchemas[2] = {&asChildSchemas[0],
+                                              &asChildSchemas[1]};
+    memset(asChildSchemas, 0, sizeof(asChildSchemas));
+    asChildSchemas[0].format = "z";
+    asChildSchemas[0].name = m_osGeomFieldName.c_str();
+    asChildSchemas[0].metadata = osGeomMetadata.c_str();
+    asChildSchemas[0].flags = ARROW_FLAG_NULLABLE;
+    asChildSchemas[0].release = GPReleaseArrowSchema;
+    asChildSchemas[1].format = m_ePixValFieldType == OFTInteger     ? "i"
+                               : m_ePixValFieldType == OFTInteger64 ? "l"
+                                                                    : "g";
+    asChildSchemas[1].name = m_osPixValFieldName.c_str();
+    asChildSchemas[1].flags = ARROW_FLAG_NULLABLE;
+    asChildSchemas[1].release = GPReleaseArrowSchema;
+
+    struct ArrowSchema sSchema;
+    memset(&sSchema, 0, sizeof(sSchema));
+    sSchema.format = "+s";
+    sSchema.name = "";
+    sSchema.n_children = sArray.n_children;
+    sSchema.children = apsChildSchemas;
+    sSchema.release = GPReleaseArrowSchema;
+
+    CPLStringList aosOptions;
+    aosOptions.SetNameValue("GEOMETRY_NAME", m_osGeomFieldName.c_str());
+    const bool bOK =
+        OGR_L_WriteArrowBatch(m_hLayer, &sSchema, &sArray, aosOptions.List());
+    if (sArray.release)
+        sArray.release(&sArray);
+
+    m_abyWKB.clear();
+    m_anWKBOffsets.assign(1, 0);
+    m_anValues.clear();
+
+    return bOK ? CE_None : CE_Failure;
+}
+
+/************************************************************************/
+/*                           GPSeamMerger                               */
+/************************************************************************/
+
+// Keep track of the seam pieces of the stripes processed so far, and write
+// the polygons they form once all their pieces are known.
+template <class DataType, class EqualityTest> class GPSeamMerger
+{
+    const GPContext &m_sCtx;
+    GPFeatureWriter<DataType> &m_oWriter;
+    EqualityTest m_oEqualityTest{};
+
+    // Pieces indexed by their global index (nullptr once written)
+    std::vector<std::unique_ptr<GPSeamPiece<DataType>>> m_apoPieces{};
+    // Union-find structure of the global piece indices
+    std::vector<size_t> m_anParent{};
+    // Not yet written pieces
+    std::vector<size_t> m_anPendingPieces{};
+    // Global index of the piece of each pixel of the last line of the
+    // previous stripe, or -1.
+    std::vector<GIntBig> m_anLastBottomPiece{};
+    std::vector<DataType> m_anLastBottomVal{};
+
+    CPL_DISALLOW_COPY_ASSIGN(GPSeamMerger)
+
+    size_t Find(size_t i)
+    {
+        while (m_anParent[i] != i)
+        {
+            m_anParent[i] = m_anParent[m_anParent[i]];
+            i = m_anParent[i];
+        }
+        return i;
+    }
+
+    void Union(size_t i, size_t j)
+    {
+        i = Find(i);
+        j = Find(j);
+        if (i != j)
+            m_anParent[std::max(i, j)] = std::min(i, j);
+    }
+
+    CPLErr WritePolygon(const std::vector<size_t> &anPieces);
+
+  public:
+    GPSeamMerger(const GPContext &sCtx, GPFeatureWriter<DataType> &oWriter)
+        : m_sCtx(sCtx), m_oWriter(oWriter)
+    {
+    }
+
+    // Must be called in stripe order.
+    CPLErr AddStripe(GPStripe<DataType> &oStripe);
+};
+
+template <class DataType, class EqualityTest>
+CPLErr GPSeamMerger<DataType, EqualityTest>::WritePolygon(
+    const std::vector<size_t> &anPieces)
+{
+    std::vector<const GPSeamPiece<DataType> *> apoPieces;
+    for (size_t iPiece : anPieces)
+        apoPieces.push_back(m_apoPieces[iPiece].get());
+
+    RPolygon oPolygon;
+    const auto aoRings =
+        apoPieces.size() == 1
+            ? apoPieces[0]->aoRings
+            : GPMergeSeamPieces(apoPieces);
+    for (const auto &oRing : aoRings)
+        *(oPolygon.newArc(true).poArc) = oRing;
+    const DataType nValue = apoPieces.back()->nValue;
+
+    for (size_t iPiece : anPieces)
+        m_apoPieces[iPiece].reset();
+
+    return m_oWriter.Write(
+        CreateOGRPolygon(&oPolygon, m_sCtx.padfGeoTransform), nValue);
+}
+
+template <class DataType, class EqualityTest>
+CPLErr
+GPSeamMerger<DataType, EqualityTest>::AddStripe(GPStripe<DataType> &oStripe)
+{
+    const int nXSize = m_sCtx.nXSize;
+    const size_t nBase = m_apoPieces.size();
+    for (auto &oPiece : oStripe.aoSeamPieces)
+    {
+        m_anParent.push_back(m_apoPieces.size());
+        m_anPendingPieces.push_back(m_apoPieces.size());
+        m_apoPieces.emplace_back(
+            std::make_unique<GPSeamPiece<DataType>>(std::move(oPiece)));
+    }
+    oStripe.aoSeamPieces.clear();
+
+    // Connect the pieces of the first line of this stripe with the ones of
+    // the last line of the previous stripe.
+    if (!m_anLastBottomPiece.empty() && !oStripe.anTopPiece.empty())
+    {
+        const int nDelta = m_sCtx.nConnectedness == 8 ? 1 : 0;
+        for (int iX = 0; iX < nXSize; iX++)
+        {
+            if (oStripe.anTopPiece[iX] < 0)
+                continue;
+            const size_t iPiece = nBase + oStripe.anTopPiece[iX];
+            for (int iXAbove = std::max(0, iX - nDelta);
+                 iXAbove <= std::min(nXSize - 1, iX + nDelta); iXAbove++)
+            {
+                if (m_anLastBottomPiece[iXAbove] >= 0 &&
+                    m_oEqualityTest(m_anLastBottomVal[iXAbove],
+                                    oStripe.anTopVal[iX]))
+                {
+                    Union(static_cast<size_t>(m_anLastBottomPiece[iXAbove]),
+                          iPiece);
+                }
+            }
+        }
+    }
+
+    m_anLastBottomPiece.clear();
+    m_anLastBottomVal.clear();
+    if (!oStripe.anBottomPiece.empty())
+    {
+        m_anLastBottomPiece.resize(nXSize);
+        for (int iX = 0; iX < nXSize; iX++)
+        {
+            m_anLastBottomPiece[iX] =
+                oStripe.anBottomPiece[iX] < 0
+                    ? -1
+                    : static_cast<GIntBig>(nBase + oStripe.anBottomPiece[iX]);
+        }
+        m_anLastBottomVal = std::move(oStripe.anBottomVal);
+    }
+
+    // Polygons that have a piece on the last line of this stripe may still
+    // grow in the next stripes. The other ones are complete.
+    std::set<size_t> oSetOpenRoots;
+    for (GIntBig iPiece : m_anLastBottomPiece)
+    {
+        if (iPiece >= 0)
+            oSetOpenRoots.insert(Find(static_cast<size_t>(iPiece)));
+    }
+
+    std::vector<size_t> anStillPending;
+    std::map<size_t, size_t> oMapRootToGroup;
+    std::vector<std::vector<size_t>> aanGroups;
+    for (size_t iPiece : m_anPendingPieces)
+    {
+        const size_t iRoot = Find(iPiece);
+        if (oSetOpenRoots.find(iRoot) != oSetOpenRoots.end())
+        {
+            anStillPending.push_back(iPiece);
+            continue;
+        }
+        auto oIter = oMapRootToGroup.find(iRoot);
+        if (oIter == oMapRootToGroup.end())
+        {
+            oMapRootToGroup[iRoot] = aanGroups.size();
+            aanGroups.push_back({iPiece});
+        }
+        else
+        {
+            aanGroups[oIter->second].push_back(iPiece);
+        }
+    }
+    m_anPendingPieces = std::move(anStillPending);
+
+    for (const auto &anGroup : aanGroups)
+    {
+        const CPLErr eErr = WritePolygon(anGroup);
+        if (eErr != CE_None)
+            return eErr;
+    }
+    return CE_None;
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                    GDALPolygonizeMultiThreadedT()                    */
+/************************************************************************/
+
+template <class DataType, class EqualityTest>
+static CPLErr GDALPolygonizeMultiThreadedT(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand, OGRLayerH hOutLayer,
+    int iPixValField, const GPContext &sCtx, int nLinesPerStripe,
+    CPLJobQueue *poJobQueue, int nThreads, GDALProgressFunc pfnProgress,
+    void *pProgressArg, GDALDataType eDT)
+{
+    const int nXSize = sCtx.nXSize;
+    const int nYSize = sCtx.nYSize;
+    GPFeatureWriter<DataType> oWriter(hOutLayer, iPixValField);
+    GPSeamMerger<DataType, EqualityTest> oMerger(sCtx, oWriter);
+    std::vector<GByte> abyMaskLine(hMaskBand ? nXSize : 0);
+
+    std::mutex oMutex;
+    std::condition_variable oCV;
+    std::deque<std::unique_ptr<GPStripe<DataType>>> apoPendingStripes;
+    const size_t nMaxPendingStripes = static_cast<size_t>(nThreads) + 1;
+    CPLErr eErr = CE_None;
+
+    // Wait for the oldest pending stripe to be processed and write its
+    // polygons.
+    const auto ConsumeOldestStripe = [&]()
+    {
+        auto &poStripe = apoPendingStripes.front();
+        {
+            std::unique_lock<std::mutex> oLock(oMutex);
+            oCV.wait(oLock, [&poStripe] { return poStripe->bDone; });
+        }
+        if (eErr == CE_None && poStripe->eErr != CE_None)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot polygonize lines %d to %d", poStripe->nYOff,
+                     poStripe->nYOff + poStripe->nYSize - 1);
+            eErr = CE_Failure;
+        }
+        for (auto &oPair : poStripe->aoCompletedPolygons)
+        {
+            if (eErr == CE_None)
+                eErr = oWriter.Write(oPair.first, oPair.second);
+            else
+                OGR_G_DestroyGeometry(oPair.first);
+        }
+        poStripe->aoCompletedPolygons.clear();
+        if (eErr == CE_None)
+            eErr = oMerger.AddStripe(*poStripe);
+        if (eErr == CE_None &&
+            !pfnProgress(0.05 + 0.95 * (poStripe->nYOff + poStripe->nYSize) /
+                                    nYSize,
+                         "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+        apoPendingStripes.pop_front();
+    };
+
+    for (int nYOff = 0; nYOff < nYSize; nYOff += nLinesPerStripe)
+    {
+        while (eErr == CE_None &&
+               apoPendingStripes.size() >= nMaxPendingStripes)
+        {
+            ConsumeOldestStripe();
+        }
+        if (eErr != CE_None)
+            break;
+
+        auto poStripe = std::make_unique<GPStripe<DataType>>();
+        poStripe->psCtx = &sCtx;
+        poStripe->nYOff = nYOff;
+        poStripe->nYSize = std::min(nLinesPerStripe, nYSize - nYOff);
+        poStripe->poMutex = &oMutex;
+        poStripe->poCV = &oCV;
+        try
+        {
+            poStripe->anVal.resize(static_cast<size_t>(poStripe->nYSize) *
+                                   nXSize);
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate stripe buffer");
+            eErr = CE_Failure;
+            break;
+        }
+
+        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, nYOff, nXSize,
+                            poStripe->nYSize, poStripe->anVal.data(), nXSize,
+                            poStripe->nYSize, eDT, 0, 0);
+        for (int iY = 0;
+             eErr == CE_None && hMaskBand != nullptr && iY < poStripe->nYSize;
+             iY++)
+        {
+            eErr = GPMaskImageData(hMaskBand, abyMaskLine.data(), nYOff + iY,
+                                   nXSize,
+                                   poStripe->anVal.data() +
+                                       static_cast<size_t>(iY) * nXSize);
+        }
+        if (eErr != CE_None)
+            break;
+
+        if (!poJobQueue->SubmitJob(GPProcessStripeJob<DataType, EqualityTest>,
+                                   poStripe.get()))
+        {
+            GPProcessStripeJob<DataType, EqualityTest>(poStripe.get());
+        }
+        apoPendingStripes.push_back(std::move(poStripe));
+    }
+
+    // Also done on error, so that no job is still using the stripes when
+    // they are freed.
+    while (!apoPendingStripes.empty())
+        ConsumeOldestStripe();
+    poJobQueue->WaitCompletion();
+
+    if (eErr == CE_None)
+        eErr = oWriter.Flush();
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                           GDALPolygonizeT()                          */
 /************************************************************************/
@@ -113,9 +1197,6 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
-    /* -------------------------------------------------------------------- */
-    /*      Allocate working buffers.                                       */
-    /* -------------------------------------------------------------------- */
     const int nXSize = GDALGetRasterBandXSize(hSrcBand);
     const int nYSize = GDALGetRasterBandYSize(hSrcBand);
     if (nXSize > std::numeric_limits<int>::max() - 2)
@@ -124,29 +1205,6 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
-    DataType *panLastLineVal =
-        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
-    DataType *panThisLineVal =
-        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
-    GInt32 *panLastLineId =
-        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
-    GInt32 *panThisLineId =
-        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
-
-    GByte *pabyMaskLine = static_cast<GByte *>(VSI_MALLOC_VERBOSE(nXSize));
-
-    if (panLastLineVal == nullptr || panThisLineVal == nullptr ||
-        panLastLineId == nullptr || panThisLineId == nullptr ||
-        pabyMaskLine == nullptr)
-    {
-        CPLFree(panThisLineId);
-        CPLFree(panLastLineId);
-        CPLFree(panThisLineVal);
-        CPLFree(panLastLineVal);
-        CPLFree(pabyMaskLine);
-        return CE_Failure;
-    }
-
     /* -------------------------------------------------------------------- */
     /*      Get the geotransform, if there is one, so we can convert the    */
     /*      vectors into georeferenced coordinates.                         */
@@ -182,6 +1240,66 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         adfGeoTransform[5] = 1;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Process the raster by stripes in worker threads if asked to.    */
+    /* -------------------------------------------------------------------- */
+    const char *pszNumThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszNumThreads == nullptr)
+        pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    int nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+    nThreads = std::max(1, std::min(128, nThreads));
+    // Stripes of about 4 M pixels. The config option is only for testing.
+    const int nLinesPerStripe = std::max(
+        1, atoi(CPLGetConfigOption(
+               "GDAL_POLYGONIZE_STRIPE_HEIGHT",
+               CPLSPrintf("%d", std::max(32, 4 * 1024 * 1024 /
+                                                 std::max(1, nXSize))))));
+    if (nThreads > 1 && nYSize > nLinesPerStripe)
+    {
+        CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+        auto poJobQueue =
+            poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+        if (poJobQueue)
+        {
+            GPContext sCtx;
+            sCtx.nXSize = nXSize;
+            sCtx.nYSize = nYSize;
+            sCtx.nConnectedness = nConnectedness;
+            sCtx.padfGeoTransform = adfGeoTransform;
+            return GDALPolygonizeMultiThreadedT<DataType, EqualityTest>(
+                hSrcBand, hMaskBand, hOutLayer, iPixValField, sCtx,
+                nLinesPerStripe, poJobQueue.get(), nThreads, pfnProgress,
+                pProgressArg, eDT);
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Allocate working buffers.                                       */
+    /* -------------------------------------------------------------------- */
+    DataType *panLastLineVal =
+        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
+    DataType *panThisLineVal =
+        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
+    GInt32 *panLastLineId =
+        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
+    GInt32 *panThisLineId =
+        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
+
+    GByte *pabyMaskLine = static_cast<GByte *>(VSI_MALLOC_VERBOSE(nXSize));
+
+    if (panLastLineVal == nullptr || panThisLineVal == nullptr ||
+        panLastLineId == nullptr || panThisLineId == nullptr ||
+        pabyMaskLine == nullptr)
+    {
+        CPLFree(panThisLineId);
+        CPLFree(panLastLineId);
+        CPLFree(panThisLineVal);
+        CPLFree(panLastLineVal);
+        CPLFree(pabyMaskLine);
+        return CE_Failure;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      The first pass over the raster is only used to build up the     */
     /*      polygon id map so we will know in advance what polygons are     */
@@ -491,6 +1609,11 @@ GBool GDALFloatEquals(float A, float B)
  * <li>DATASET_FOR_GEOREF=dataset_name: Name of a dataset from which to read
  * the geotransform. This useful if hSrcBand has no related dataset, which is
  * typical for mask bands.</li>
+ * <li>NUM_THREADS=N|ALL_CPUS: (GDAL >= 3.9) Number of worker threads used
+ * to process horizontal stripes of the raster in parallel. Defaults to the
+ * value of the GDAL_NUM_THREADS configuration option, or 1. Polygons that
+ * span several stripes are re-assembled, but the order in which features
+ * are written differs from the single-threaded mode.</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
@@ -565,6 +1688,11 @@ CPLErr CPL_STDCALL GDALPolygonize(GDALRasterBandH hSrcBand,
  * <li>DATASET_FOR_GEOREF=dataset_name: Name of a dataset from which to read
  * the geotransform. This useful if hSrcBand has no related dataset, which is
  * typical for mask bands.</li>
+ * <li>NUM_THREADS=N|ALL_CPUS: (GDAL >= 3.9) Number of worker threads used
+ * to process horizontal stripes of the raster in parallel. Defaults to the
+ * value of the GDAL_NUM_THREADS configuration option, or 1. Polygons that
+ * span several stripes are re-assembled, but the order in which features
+ * are written differs from the single-threaded mode.</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
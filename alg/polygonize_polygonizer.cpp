@@ -464,12 +464,10 @@ OGRPolygonWriter<DataType>::OGRPolygonWriter(OGRLayerH hOutLayer,
 {
 }
 
-template <typename DataType>
-void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
-                                         DataType nPolygonCellValue)
+OGRGeometryH CreateOGRPolygon(const RPolygon *poPolygon,
+                              const double *padfGeoTransform)
 {
     std::vector<bool> oAccessedArc(poPolygon->oArcConnections.size(), false);
-    double *padfGeoTransform = padfGeoTransform_;
 
     OGRGeometryH hPolygon = OGR_G_CreateGeometry(wkbPolygon);
 
@@ -527,6 +525,15 @@ void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
         AddRingToPolygon(ite - oAccessedArc.begin());
     }
 
+    return hPolygon;
+}
+
+template <typename DataType>
+void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
+                                         DataType nPolygonCellValue)
+{
+    OGRGeometryH hPolygon = CreateOGRPolygon(poPolygon, padfGeoTransform_);
+
     // Create the feature object
     OGRFeatureH hFeat = OGR_F_Create(OGR_L_GetLayerDefn(hOutLayer_));
 
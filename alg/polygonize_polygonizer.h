@@ -180,6 +180,13 @@ template <typename PolyIdType, typename DataType> class Polygonizer
                      IndexType nCols);
 };
 
+/**
+ * Create the OGR polygon of a raster polygon, with georeferenced
+ * coordinates computed from the geotransform.
+ */
+OGRGeometryH CreateOGRPolygon(const RPolygon *poPolygon,
+                              const double *padfGeoTransform);
+
 /**
  * Write raster polygon object to OGR layer.
  */
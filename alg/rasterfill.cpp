@@ -33,18 +33,22 @@
 
 #include <cmath>
 #include <cstring>
+#include <limits>
 
 #include <algorithm>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 /************************************************************************/
 /*                           GDALFilterLine()                           */
@@ -59,10 +63,11 @@ static void GDALFilterLine(const float *pafLastLine, const float *pafThisLine,
                            const GByte *pabyLastTMask,
                            const GByte *pabyThisTMask,
                            const GByte *pabyNextTMask,
-                           const GByte *pabyThisFMask, int nXSize)
+                           const GByte *pabyThisFMask, int nXSize,
+                           int nXStart, int nXEnd)
 
 {
-    for (int iX = 0; iX < nXSize; iX++)
+    for (int iX = nXStart; iX < nXEnd; iX++)
     {
         if (!pabyThisFMask[iX])
         {
@@ -136,6 +141,42 @@ static void GDALFilterLine(const float *pafLastLine, const float *pafThisLine,
     }
 }
 
+/************************************************************************/
+/*                         GDALFilterLineJob()                          */
+/*                                                                      */
+/*      Arguments of GDALFilterLine() for a range of columns, so that   */
+/*      a scanline can be split among worker threads.                   */
+/************************************************************************/
+
+namespace
+{
+struct GDALFilterLineJob
+{
+    const float *pafLastLine = nullptr;
+    const float *pafThisLine = nullptr;
+    const float *pafNextLine = nullptr;
+    float *pafOutLine = nullptr;
+    const GByte *pabyLastTMask = nullptr;
+    const GByte *pabyThisTMask = nullptr;
+    const GByte *pabyNextTMask = nullptr;
+    const GByte *pabyThisFMask = nullptr;
+    int nXSize = 0;
+    int nXStart = 0;
+    int nXEnd = 0;
+};
+}  // namespace
+
+static void GDALFilterLineJobFunc(void *pData)
+{
+    const GDALFilterLineJob *psJob =
+        static_cast<const GDALFilterLineJob *>(pData);
+    GDALFilterLine(psJob->pafLastLine, psJob->pafThisLine, psJob->pafNextLine,
+                   psJob->pafOutLine, psJob->pabyLastTMask,
+                   psJob->pabyThisTMask, psJob->pabyNextTMask,
+                   psJob->pabyThisFMask, psJob->nXSize, psJob->nXStart,
+                   psJob->nXEnd);
+}
+
 /************************************************************************/
 /*                          GDALMultiFilter()                           */
 /*                                                                      */
@@ -150,12 +191,16 @@ static void GDALFilterLine(const float *pafLastLine, const float *pafThisLine,
 /*      of nIterations+2 scanlines.  While possibly clever this        */
 /*      makes the algorithm implementation largely                      */
 /*      incomprehensible.                                               */
+/*                                                                      */
+/*      With several threads, each scanline is split in ranges of       */
+/*      columns filtered concurrently.                                  */
 /************************************************************************/
 
 static CPLErr GDALMultiFilter(GDALRasterBandH hTargetBand,
                               GDALRasterBandH hTargetMaskBand,
                               GDALRasterBandH hFiltMaskBand, int nIterations,
-                              GDALProgressFunc pfnProgress, void *pProgressArg)
+                              int nThreads, GDALProgressFunc pfnProgress,
+                              void *pProgressArg)
 
 {
     const int nXSize = GDALGetRasterBandXSize(hTargetBand);
@@ -192,6 +237,23 @@ static CPLErr GDALMultiFilter(GDALRasterBandH hTargetBand,
         return CE_Failure;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Split scanlines in ranges of at least 1024 columns.             */
+    /* -------------------------------------------------------------------- */
+    const int nJobs = std::max(1, std::min(nThreads, nXSize / 1024));
+    CPLWorkerThreadPool *poThreadPool =
+        nJobs > 1 ? GDALGetGlobalThreadPool(nJobs) : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    std::vector<GDALFilterLineJob> asJobs(poJobQueue ? nJobs : 1);
+    for (int i = 0; i < static_cast<int>(asJobs.size()); i++)
+    {
+        asJobs[i].nXSize = nXSize;
+        asJobs[i].nXStart = static_cast<int>(static_cast<GIntBig>(nXSize) * i /
+                                             asJobs.size());
+        asJobs[i].nXEnd = static_cast<int>(static_cast<GIntBig>(nXSize) *
+                                           (i + 1) / asJobs.size());
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Process rotating buffers.                                       */
     /* -------------------------------------------------------------------- */
@@ -280,14 +342,24 @@ static CPLErr GDALMultiFilter(GDALRasterBandH hTargetBand,
                 continue;
             }
 
-            GDALFilterLine(pafSLastPass + iLastOffset * nXSize,
-                           pafLastPass + iThisOffset * nXSize,
-                           pafThisPass + iNextOffset * nXSize,
-                           pafThisPass + iThisOffset * nXSize,
-                           pabyTMaskBuf + iLastOffset * nXSize,
-                           pabyTMaskBuf + iThisOffset * nXSize,
-                           pabyTMaskBuf + iNextOffset * nXSize,
-                           pabyFMaskBuf + iThisOffset * nXSize, nXSize);
+            for (auto &sJob : asJobs)
+            {
+                sJob.pafLastLine = pafSLastPass + iLastOffset * nXSize;
+                sJob.pafThisLine = pafLastPass + iThisOffset * nXSize;
+                sJob.pafNextLine = pafThisPass + iNextOffset * nXSize;
+                sJob.pafOutLine = pafThisPass + iThisOffset * nXSize;
+                sJob.pabyLastTMask = pabyTMaskBuf + iLastOffset * nXSize;
+                sJob.pabyThisTMask = pabyTMaskBuf + iThisOffset * nXSize;
+                sJob.pabyNextTMask = pabyTMaskBuf + iNextOffset * nXSize;
+                sJob.pabyThisFMask = pabyFMaskBuf + iThisOffset * nXSize;
+            }
+            // Each line depends on the filtered next line, so wait for all
+            // its column ranges before moving to the previous one.
+            for (size_t i = 1; i < asJobs.size(); i++)
+                poJobQueue->SubmitJob(GDALFilterLineJobFunc, &asJobs[i]);
+            GDALFilterLineJobFunc(&asJobs[0]);
+            if (poJobQueue)
+                poJobQueue->WaitCompletion();
         }
 
         /* --------------------------------------------------------------------
@@ -360,6 +432,542 @@ inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
     }
 }
 
+/************************************************************************/
+/*                     GDALFillNodataPushPullJob                        */
+/************************************************************************/
+
+namespace
+{
+struct GDALFillNodataPushPullJob
+{
+    // Values and mask of the lines [nSrcYOff, nSrcYOff + nSrcYSize[ of the
+    // band, that is a stripe and its margins.
+    const float *pafSrcVal = nullptr;
+    const GByte *pabySrcMask = nullptr;
+    int nSrcYOff = 0;
+    int nSrcYSize = 0;
+
+    // Values, mask and filter mask of the lines [nDstYOff, nDstYOff +
+    // nDstYSize[, initialized from the source, and updated for filled pixels.
+    float *pafDstVal = nullptr;
+    GByte *pabyDstMask = nullptr;
+    GByte *pabyDstFiltMask = nullptr;
+    int nDstYOff = 0;
+    int nDstYSize = 0;
+
+    int nXSize = 0;
+    int nMargin = 0;
+    int nLevels = 0;
+    double dfMaxSearchDist = 0;
+    bool bCheckDist = false;
+    bool bHasNoData = false;
+    float fNoData = 0;
+
+    // Columns [nTileXOff, nTileXOff + nTileXSize[ are processed by this job.
+    int nTileXOff = 0;
+    int nTileXSize = 0;
+
+    bool bSuccess = true;
+};
+}  // namespace
+
+/************************************************************************/
+/*                   GDALFillNodataPushPullJobFunc()                    */
+/************************************************************************/
+
+static void GDALFillNodataPushPullJobFunc(void *pData)
+{
+    GDALFillNodataPushPullJob *psJob =
+        static_cast<GDALFillNodataPushPullJob *>(pData);
+    const int nXSize = psJob->nXSize;
+    const int nWinXOff = std::max(0, psJob->nTileXOff - psJob->nMargin);
+    const int nWinXSize =
+        std::min(nXSize,
+                 psJob->nTileXOff + psJob->nTileXSize + psJob->nMargin) -
+        nWinXOff;
+    const int nWinYSize = psJob->nSrcYSize;
+    const size_t nWinPixels = static_cast<size_t>(nWinXSize) * nWinYSize;
+
+    try
+    {
+        std::vector<int> anLevelXSize{nWinXSize};
+        std::vector<int> anLevelYSize{nWinYSize};
+        std::vector<std::vector<float>> aafVal(1);
+        std::vector<std::vector<float>> aafWeight(1);
+
+        /* ---------------------------------------------------------------- */
+        /*      Full resolution level: weight 1 for valid pixels.           */
+        /* ---------------------------------------------------------------- */
+        aafVal[0].resize(nWinPixels);
+        aafWeight[0].resize(nWinPixels);
+        for (int iY = 0; iY < nWinYSize; iY++)
+        {
+            const size_t nSrcOffset =
+                static_cast<size_t>(iY) * nXSize + nWinXOff;
+            const size_t nWinOffset = static_cast<size_t>(iY) * nWinXSize;
+            for (int iX = 0; iX < nWinXSize; iX++)
+            {
+                const float fVal = psJob->pafSrcVal[nSrcOffset + iX];
+                if (psJob->pabySrcMask[nSrcOffset + iX] &&
+                    !(psJob->bHasNoData && fVal == psJob->fNoData))
+                {
+                    aafVal[0][nWinOffset + iX] = fVal;
+                    aafWeight[0][nWinOffset + iX] = 1.0f;
+                }
+            }
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Push: weighted average of 2x2 cells, weight clamped to 1.   */
+        /* ---------------------------------------------------------------- */
+        for (int iLevel = 1;
+             iLevel <= psJob->nLevels &&
+             (anLevelXSize.back() > 1 || anLevelYSize.back() > 1);
+             iLevel++)
+        {
+            const int nPXSize = anLevelXSize.back();
+            const int nPYSize = anLevelYSize.back();
+            const int nLXSize = (nPXSize + 1) / 2;
+            const int nLYSize = (nPYSize + 1) / 2;
+            std::vector<float> afVal(static_cast<size_t>(nLXSize) * nLYSize);
+            std::vector<float> afWeight(afVal.size());
+            const float *pafPVal = aafVal.back().data();
+            const float *pafPWeight = aafWeight.back().data();
+            for (int iY = 0; iY < nLYSize; iY++)
+            {
+                const int iPYEnd = std::min(2 * iY + 2, nPYSize);
+                for (int iX = 0; iX < nLXSize; iX++)
+                {
+                    const int iPXEnd = std::min(2 * iX + 2, nPXSize);
+                    double dfWeightSum = 0;
+                    double dfValSum = 0;
+                    for (int iPY = 2 * iY; iPY < iPYEnd; iPY++)
+                    {
+                        for (int iPX = 2 * iX; iPX < iPXEnd; iPX++)
+                        {
+                            const size_t n =
+                                static_cast<size_t>(iPY) * nPXSize + iPX;
+                            dfWeightSum += pafPWeight[n];
+                            dfValSum += static_cast<double>(pafPWeight[n]) *
+                                        pafPVal[n];
+                        }
+                    }
+                    if (dfWeightSum > 0)
+                    {
+                        const size_t n = static_cast<size_t>(iY) * nLXSize + iX;
+                        afVal[n] = static_cast<float>(dfValSum / dfWeightSum);
+                        afWeight[n] =
+                            static_cast<float>(std::min(1.0, dfWeightSum));
+                    }
+                }
+            }
+            anLevelXSize.push_back(nLXSize);
+            anLevelYSize.push_back(nLYSize);
+            aafVal.push_back(std::move(afVal));
+            aafWeight.push_back(std::move(afWeight));
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Pull: complete each level with the bilinear interpolation   */
+        /*      of the coarser one, from the top to the full resolution.    */
+        /* ---------------------------------------------------------------- */
+        for (int iLevel = static_cast<int>(aafVal.size()) - 2; iLevel >= 0;
+             iLevel--)
+        {
+            const int nLXSize = anLevelXSize[iLevel];
+            const int nLYSize = anLevelYSize[iLevel];
+            const int nPXSize = anLevelXSize[iLevel + 1];
+            const int nPYSize = anLevelYSize[iLevel + 1];
+            float *pafLVal = aafVal[iLevel].data();
+            float *pafLWeight = aafWeight[iLevel].data();
+            const float *pafPVal = aafVal[iLevel + 1].data();
+            const float *pafPWeight = aafWeight[iLevel + 1].data();
+            for (int iY = 0; iY < nLYSize; iY++)
+            {
+                // Center of the cell in the coarser level: the nearest two
+                // coarse cells get weights 3/4 and 1/4.
+                const int iPY0 = (iY - 1) >> 1;
+                const double dfFY = (iY & 1) ? 0.25 : 0.75;
+                const size_t anPYOffset[2] = {
+                    static_cast<size_t>(std::max(0, iPY0)) * nPXSize,
+                    static_cast<size_t>(std::min(nPYSize - 1, iPY0 + 1)) *
+                        nPXSize};
+                for (int iX = 0; iX < nLXSize; iX++)
+                {
+                    const size_t n = static_cast<size_t>(iY) * nLXSize + iX;
+                    const double dfWeight = pafLWeight[n];
+                    if (dfWeight >= 1)
+                        continue;
+
+                    const int iPX0 = (iX - 1) >> 1;
+                    const double dfFX = (iX & 1) ? 0.25 : 0.75;
+                    const int anPX[2] = {std::max(0, iPX0),
+                                         std::min(nPXSize - 1, iPX0 + 1)};
+                    const double adfBX[2] = {1 - dfFX, dfFX};
+                    const double adfBY[2] = {1 - dfFY, dfFY};
+                    double dfPWeight = 0;
+                    double dfPValSum = 0;
+                    for (int j = 0; j < 2; j++)
+                    {
+                        for (int i = 0; i < 2; i++)
+                        {
+                            const size_t nP = anPYOffset[j] + anPX[i];
+                            const double dfW =
+                                adfBX[i] * adfBY[j] * pafPWeight[nP];
+                            dfPWeight += dfW;
+                            dfPValSum += dfW * pafPVal[nP];
+                        }
+                    }
+                    if (dfPWeight > 0)
+                    {
+                        const double dfNewWeight =
+                            dfWeight + (1 - dfWeight) * dfPWeight;
+                        pafLVal[n] = static_cast<float>(
+                            (dfWeight * pafLVal[n] +
+                             (1 - dfWeight) * dfPValSum) /
+                            dfNewWeight);
+                        pafLWeight[n] = static_cast<float>(dfNewWeight);
+                    }
+                }
+            }
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Chamfer distance to the nearest valid pixel, to honour      */
+        /*      the maximum search distance.                                */
+        /* ---------------------------------------------------------------- */
+        std::vector<float> afDist;
+        if (psJob->bCheckDist)
+        {
+            afDist.resize(nWinPixels, std::numeric_limits<float>::max());
+            const float fDiag = static_cast<float>(M_SQRT2);
+            for (int iY = 0; iY < nWinYSize; iY++)
+            {
+                const size_t nSrcOffset =
+                    static_cast<size_t>(iY) * nXSize + nWinXOff;
+                float *pafThis = afDist.data() +
+                                 static_cast<size_t>(iY) * nWinXSize;
+                const float *pafPrev = iY > 0 ? pafThis - nWinXSize : nullptr;
+                for (int iX = 0; iX < nWinXSize; iX++)
+                {
+                    const float fVal = psJob->pafSrcVal[nSrcOffset + iX];
+                    float fDist = pafThis[iX];
+                    if (psJob->pabySrcMask[nSrcOffset + iX] &&
+                        !(psJob->bHasNoData && fVal == psJob->fNoData))
+                        fDist = 0;
+                    if (iX > 0)
+                        fDist = std::min(fDist, pafThis[iX - 1] + 1);
+                    if (pafPrev)
+                    {
+                        fDist = std::min(fDist, pafPrev[iX] + 1);
+                        if (iX > 0)
+                            fDist = std::min(fDist, pafPrev[iX - 1] + fDiag);
+                        if (iX + 1 < nWinXSize)
+                            fDist = std::min(fDist, pafPrev[iX + 1] + fDiag);
+                    }
+                    pafThis[iX] = fDist;
+                }
+            }
+            for (int iY = nWinYSize - 1; iY >= 0; iY--)
+            {
+                float *pafThis = afDist.data() +
+                                 static_cast<size_t>(iY) * nWinXSize;
+                const float *pafNext =
+                    iY + 1 < nWinYSize ? pafThis + nWinXSize : nullptr;
+                for (int iX = nWinXSize - 1; iX >= 0; iX--)
+                {
+                    float fDist = pafThis[iX];
+                    if (iX + 1 < nWinXSize)
+                        fDist = std::min(fDist, pafThis[iX + 1] + 1);
+                    if (pafNext)
+                    {
+                        fDist = std::min(fDist, pafNext[iX] + 1);
+                        if (iX > 0)
+                            fDist = std::min(fDist, pafNext[iX - 1] + fDiag);
+                        if (iX + 1 < nWinXSize)
+                            fDist = std::min(fDist, pafNext[iX + 1] + fDiag);
+                    }
+                    pafThis[iX] = fDist;
+                }
+            }
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Fill the invalid pixels of the tile.                        */
+        /* ---------------------------------------------------------------- */
+        for (int iY = 0; iY < psJob->nDstYSize; iY++)
+        {
+            const int iWinY = psJob->nDstYOff + iY - psJob->nSrcYOff;
+            const size_t nSrcOffset = static_cast<size_t>(iWinY) * nXSize;
+            const size_t nDstOffset = static_cast<size_t>(iY) * nXSize;
+            const size_t nWinOffset =
+                static_cast<size_t>(iWinY) * nWinXSize - nWinXOff;
+            for (int iX = psJob->nTileXOff;
+                 iX < psJob->nTileXOff + psJob->nTileXSize; iX++)
+            {
+                if (psJob->pabySrcMask[nSrcOffset + iX] ||
+                    !(aafWeight[0][nWinOffset + iX] > 0) ||
+                    (psJob->bCheckDist &&
+                     afDist[nWinOffset + iX] > psJob->dfMaxSearchDist))
+                {
+                    continue;
+                }
+                psJob->pafDstVal[nDstOffset + iX] = aafVal[0][nWinOffset + iX];
+                psJob->pabyDstMask[nDstOffset + iX] = 255;
+                psJob->pabyDstFiltMask[nDstOffset + iX] = 255;
+            }
+        }
+    }
+    catch (const std::exception &)
+    {
+        psJob->bSuccess = false;
+    }
+}
+
+/************************************************************************/
+/*                       GDALFillNodataPushPull()                       */
+/*                                                                      */
+/*      Push-pull interpolation: a pyramid of weighted averages is      */
+/*      built from the valid pixels, and each level then fills the      */
+/*      gaps of the finer one by bilinear interpolation, which costs    */
+/*      linear time whatever the size of the holes.  The raster is      */
+/*      processed by tiles with margins large enough for the result     */
+/*      to be independent of the tiling, the number of pyramid levels   */
+/*      being bounded by the maximum search distance.  Tiles of a       */
+/*      stripe of lines are processed by worker threads.                */
+/************************************************************************/
+
+static CPLErr GDALFillNodataPushPull(GDALRasterBandH hTargetBand,
+                                     GDALRasterBandH hMaskBand,
+                                     bool bUpdateMask,
+                                     GDALRasterBandH hFiltMaskBand,
+                                     double dfMaxSearchDist, bool bHasNoData,
+                                     float fNoData, int nThreads,
+                                     GDALProgressFunc pfnProgress,
+                                     void *pProgressArg)
+{
+    const int nXSize = GDALGetRasterBandXSize(hTargetBand);
+    const int nYSize = GDALGetRasterBandYSize(hTargetBand);
+    const int nMaxSize = std::max(nXSize, nYSize);
+
+    // Cells of the top level, of 2^nLevels pixels, are at least twice as
+    // large as the search distance, so that pixels within that distance of
+    // a valid pixel get a contribution from it.  Levels beyond the one of
+    // a single cell are useless.
+    int nLevels = 0;
+    while (nLevels < 30 &&
+           (static_cast<GIntBig>(1) << nLevels) < 2 * dfMaxSearchDist &&
+           (static_cast<GIntBig>(1) << nLevels) < nMaxSize)
+    {
+        nLevels++;
+    }
+    const GIntBig nCellSize = static_cast<GIntBig>(1) << nLevels;
+
+    // A pixel depends on the cells of its neighbourhood at each level,
+    // which spans less than 3 top level cells. Margins and tiles are
+    // aligned on top level cells, so that they coincide between tiles.
+    const int nMargin =
+        static_cast<int>(std::min<GIntBig>(nMaxSize, 3 * nCellSize));
+    GIntBig nTileSize = std::max(
+        1, atoi(CPLGetConfigOption("GDAL_FILLNODATA_TILE_SIZE", "2048")));
+    nTileSize = (nTileSize + nCellSize - 1) / nCellSize * nCellSize;
+    const int nTileLines =
+        static_cast<int>(std::min<GIntBig>(nTileSize, nYSize));
+    const int nTileCols =
+        static_cast<int>(std::min<GIntBig>(nTileSize, nXSize));
+    const int nSrcMaxLines = static_cast<int>(std::min<GIntBig>(
+        nYSize, nTileLines + 2 * static_cast<GIntBig>(nMargin)));
+
+    // The chamfer distance cannot exceed nXSize + nYSize.
+    const bool bCheckDist = dfMaxSearchDist < nXSize + nYSize;
+
+    float *pafSrcVal = static_cast<float *>(
+        VSI_MALLOC3_VERBOSE(sizeof(float), nXSize, nSrcMaxLines));
+    GByte *pabySrcMask =
+        static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nXSize, nSrcMaxLines));
+    float *pafDstVal = static_cast<float *>(
+        VSI_MALLOC3_VERBOSE(sizeof(float), nXSize, nTileLines));
+    GByte *pabyDstMask =
+        static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nXSize, nTileLines));
+    GByte *pabyDstFiltMask =
+        static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nXSize, nTileLines));
+
+    CPLErr eErr = CE_None;
+    if (pafSrcVal == nullptr || pabySrcMask == nullptr ||
+        pafDstVal == nullptr || pabyDstMask == nullptr ||
+        pabyDstFiltMask == nullptr)
+    {
+        eErr = CE_Failure;
+    }
+
+    const int nTilesX = (nXSize + nTileCols - 1) / nTileCols;
+    CPLWorkerThreadPool *poThreadPool =
+        std::min(nThreads, nTilesX) > 1 ? GDALGetGlobalThreadPool(nThreads)
+                                         : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+
+    GDALFillNodataPushPullJob sTemplate;
+    sTemplate.pafSrcVal = pafSrcVal;
+    sTemplate.pabySrcMask = pabySrcMask;
+    sTemplate.pafDstVal = pafDstVal;
+    sTemplate.pabyDstMask = pabyDstMask;
+    sTemplate.pabyDstFiltMask = pabyDstFiltMask;
+    sTemplate.nXSize = nXSize;
+    sTemplate.nMargin = nMargin;
+    sTemplate.nLevels = nLevels;
+    sTemplate.dfMaxSearchDist = dfMaxSearchDist;
+    sTemplate.bCheckDist = bCheckDist;
+    sTemplate.bHasNoData = bHasNoData;
+    sTemplate.fNoData = fNoData;
+
+    // Write the lines of the previous stripe. This must be done after
+    // reading the next stripe, whose top margin covers them.
+    int nPendingYOff = 0;
+    int nPendingYSize = 0;
+    const auto WritePending = [&]()
+    {
+        if (nPendingYSize == 0)
+            return CE_None;
+        CPLErr eWriteErr = GDALRasterIO(
+            hTargetBand, GF_Write, 0, nPendingYOff, nXSize, nPendingYSize,
+            pafDstVal, nXSize, nPendingYSize, GDT_Float32, 0, 0);
+        if (eWriteErr == CE_None && bUpdateMask)
+        {
+            eWriteErr = GDALRasterIO(hMaskBand, GF_Write, 0, nPendingYOff,
+                                     nXSize, nPendingYSize, pabyDstMask,
+                                     nXSize, nPendingYSize, GDT_Byte, 0, 0);
+        }
+        if (eWriteErr == CE_None)
+        {
+            eWriteErr = GDALRasterIO(hFiltMaskBand, GF_Write, 0, nPendingYOff,
+                                     nXSize, nPendingYSize, pabyDstFiltMask,
+                                     nXSize, nPendingYSize, GDT_Byte, 0, 0);
+        }
+        nPendingYSize = 0;
+        return eWriteErr;
+    };
+
+    for (int nDstYOff = 0; eErr == CE_None && nDstYOff < nYSize;
+         nDstYOff += nTileLines)
+    {
+        const int nDstYSize = std::min(nTileLines, nYSize - nDstYOff);
+        const int nSrcYOff = std::max(0, nDstYOff - nMargin);
+        const int nSrcYSize =
+            static_cast<int>(std::min<GIntBig>(
+                nYSize, static_cast<GIntBig>(nDstYOff) + nDstYSize + nMargin)) -
+            nSrcYOff;
+
+        eErr = GDALRasterIO(hTargetBand, GF_Read, 0, nSrcYOff, nXSize,
+                            nSrcYSize, pafSrcVal, nXSize, nSrcYSize,
+                            GDT_Float32, 0, 0);
+        if (eErr == CE_None)
+            eErr = GDALRasterIO(hMaskBand, GF_Read, 0, nSrcYOff, nXSize,
+                                nSrcYSize, pabySrcMask, nXSize, nSrcYSize,
+                                GDT_Byte, 0, 0);
+        if (eErr == CE_None)
+            eErr = WritePending();
+        if (eErr != CE_None)
+            break;
+
+        const size_t nDstOffsetInSrc =
+            static_cast<size_t>(nDstYOff - nSrcYOff) * nXSize;
+        const size_t nDstPixels = static_cast<size_t>(nDstYSize) * nXSize;
+        memcpy(pafDstVal, pafSrcVal + nDstOffsetInSrc,
+               nDstPixels * sizeof(float));
+        memcpy(pabyDstMask, pabySrcMask + nDstOffsetInSrc, nDstPixels);
+        memset(pabyDstFiltMask, 0, nDstPixels);
+
+        std::vector<GDALFillNodataPushPullJob> asJobs(nTilesX, sTemplate);
+        for (int i = 0; i < nTilesX; i++)
+        {
+            asJobs[i].nSrcYOff = nSrcYOff;
+            asJobs[i].nSrcYSize = nSrcYSize;
+            asJobs[i].nDstYOff = nDstYOff;
+            asJobs[i].nDstYSize = nDstYSize;
+            asJobs[i].nTileXOff = i * nTileCols;
+            asJobs[i].nTileXSize = std::min(nTileCols, nXSize - i * nTileCols);
+            if (poJobQueue && i > 0)
+                poJobQueue->SubmitJob(GDALFillNodataPushPullJobFunc,
+                                      &asJobs[i]);
+        }
+        GDALFillNodataPushPullJobFunc(&asJobs[0]);
+        if (poJobQueue)
+        {
+            poJobQueue->WaitCompletion();
+        }
+        else
+        {
+            for (int i = 1; i < nTilesX; i++)
+                GDALFillNodataPushPullJobFunc(&asJobs[i]);
+        }
+        for (const auto &sJob : asJobs)
+        {
+            if (!sJob.bSuccess)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Cannot allocate push-pull pyramid");
+                eErr = CE_Failure;
+                break;
+            }
+        }
+        if (eErr != CE_None)
+            break;
+
+        nPendingYOff = nDstYOff;
+        nPendingYSize = nDstYSize;
+
+        if (!pfnProgress((nDstYOff + nDstYSize) / static_cast<double>(nYSize),
+                         "Filling...", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+    if (eErr == CE_None)
+        eErr = WritePending();
+
+    CPLFree(pafSrcVal);
+    CPLFree(pabySrcMask);
+    CPLFree(pafDstVal);
+    CPLFree(pabyDstMask);
+    CPLFree(pabyDstFiltMask);
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                        GDALFillNodataSmooth()                        */
+/************************************************************************/
+
+static CPLErr GDALFillNodataSmooth(GDALRasterBandH hTargetBand,
+                                   GDALRasterBandH hMaskBand,
+                                   bool bFlushMask,
+                                   GDALRasterBandH hFiltMaskBand,
+                                   int nSmoothingIterations, int nThreads,
+                                   double dfProgressStart,
+                                   GDALProgressFunc pfnProgress,
+                                   void *pProgressArg)
+{
+    if (bFlushMask)
+    {
+        // Force masks to be to flushed and recomputed when the user
+        // didn't pass a user-provided hMaskBand, and we assigned it
+        // to be the mask band of hTargetBand.
+        GDALFlushRasterCache(hMaskBand);
+    }
+
+    void *pScaledProgress = GDALCreateScaledProgress(
+        dfProgressStart, 1.0, pfnProgress, pProgressArg);
+
+    const CPLErr eErr = GDALMultiFilter(
+        hTargetBand, hMaskBand, hFiltMaskBand, nSmoothingIterations, nThreads,
+        GDALScaledProgress, pScaledProgress);
+
+    GDALDestroyScaledProgress(pScaledProgress);
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                           GDALFillNodata()                           */
 /************************************************************************/
@@ -397,6 +1005,17 @@ inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
  * <li>NODATA=value (starting with GDAL 2.4).
  * Source pixels at that value will be ignored by the interpolator. Warning:
  * currently this will not be honored by smoothing passes.</li>
+ * <li>INTERPOLATION=INV_DIST/PUSH_PULL (starting with GDAL 3.9).
+ * INV_DIST, the default, is the four direction search described above.
+ * PUSH_PULL builds a pyramid of averages of the valid pixels, and fills
+ * each level from the coarser one. Its cost is linear in the number of
+ * pixels, whatever the size of the holes, with smoother results but less
+ * faithful to the nearest values. The maximum search distance is evaluated
+ * with a chamfer approximation of the Euclidean distance.</li>
+ * <li>NUM_THREADS=number_of_threads or ALL_CPUS (starting with GDAL 3.9).
+ * Number of worker threads for the PUSH_PULL interpolation and the
+ * smoothing passes. Defaults to the value of the GDAL_NUM_THREADS
+ * configuration option, or 1.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -423,6 +1042,23 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
 
     const int nMaxSearchDist = static_cast<int>(floor(dfMaxSearchDist));
 
+    const char *pszInterpolation =
+        CSLFetchNameValueDef(papszOptions, "INTERPOLATION", "INV_DIST");
+    const bool bPushPull = EQUAL(pszInterpolation, "PUSH_PULL");
+    if (!bPushPull && !EQUAL(pszInterpolation, "INV_DIST"))
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Unsupported value for INTERPOLATION: %s", pszInterpolation);
+        return CE_Failure;
+    }
+
+    const char *pszNumThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszNumThreads == nullptr)
+        pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    int nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+    nThreads = std::max(1, std::min(128, nThreads));
+
     // Special "x" pixel values identifying pixels as special.
     GDALDataType eType = GDT_UInt16;
     GUInt32 nNoDataVal = 65535;
@@ -523,6 +1159,47 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         return CE_Failure;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Create a mask file to make it clear what pixels can be filtered */
+    /*      on the filtering pass.                                          */
+    /* -------------------------------------------------------------------- */
+    const CPLString osFiltMaskTmpFile = osTmpFile + "fill_filtmask_work.tif";
+
+    auto poFiltMaskDS = std::unique_ptr<GDALDataset>(GDALDataset::FromHandle(
+        GDALCreate(hDriver, osFiltMaskTmpFile, nXSize, nYSize, 1, GDT_Byte,
+                   aosWorkFileOptions.List())));
+
+    if (poFiltMaskDS == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Could not create mask work file. Check driver capabilities.");
+        return CE_Failure;
+    }
+    poFiltMaskDS->MarkSuppressOnClose();
+
+    GDALRasterBandH hFiltMaskBand =
+        GDALRasterBand::FromHandle(poFiltMaskDS->GetRasterBand(1));
+
+    if (bPushPull)
+    {
+        void *pScaledProgress = GDALCreateScaledProgress(
+            0.0, dfProgressRatio, pfnProgress, pProgressArg);
+        CPLErr eErr = GDALFillNodataPushPull(
+            hTargetBand, hMaskBand, poTmpMaskDS != nullptr, hFiltMaskBand,
+            dfMaxSearchDist, bHasNoData, fNoData, nThreads, GDALScaledProgress,
+            pScaledProgress);
+        GDALDestroyScaledProgress(pScaledProgress);
+
+        if (eErr == CE_None && nSmoothingIterations > 0)
+        {
+            eErr = GDALFillNodataSmooth(
+                hTargetBand, hMaskBand, poTmpMaskDS == nullptr, hFiltMaskBand,
+                nSmoothingIterations, nThreads, dfProgressRatio, pfnProgress,
+                pProgressArg);
+        }
+        return eErr;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Create a work file to hold the Y "last value" indices.          */
     /* -------------------------------------------------------------------- */
@@ -567,27 +1244,6 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
     GDALRasterBandH hValBand =
         GDALRasterBand::FromHandle(poValDS->GetRasterBand(1));
 
-    /* -------------------------------------------------------------------- */
-    /*      Create a mask file to make it clear what pixels can be filtered */
-    /*      on the filtering pass.                                          */
-    /* -------------------------------------------------------------------- */
-    const CPLString osFiltMaskTmpFile = osTmpFile + "fill_filtmask_work.tif";
-
-    auto poFiltMaskDS = std::unique_ptr<GDALDataset>(GDALDataset::FromHandle(
-        GDALCreate(hDriver, osFiltMaskTmpFile, nXSize, nYSize, 1, GDT_Byte,
-                   aosWorkFileOptions.List())));
-
-    if (poFiltMaskDS == nullptr)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "Could not create mask work file. Check driver capabilities.");
-        return CE_Failure;
-    }
-    poFiltMaskDS->MarkSuppressOnClose();
-
-    GDALRasterBandH hFiltMaskBand =
-        GDALRasterBand::FromHandle(poFiltMaskDS->GetRasterBand(1));
-
     /* -------------------------------------------------------------------- */
     /*      Allocate buffers for last scanline and this scanline.           */
     /* -------------------------------------------------------------------- */
@@ -929,22 +1585,10 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
     /* ==================================================================== */
     if (eErr == CE_None && nSmoothingIterations > 0)
     {
-        if (poTmpMaskDS == nullptr)
-        {
-            // Force masks to be to flushed and recomputed when the user
-            // didn't pass a user-provided hMaskBand, and we assigned it
-            // to be the mask band of hTargetBand.
-            GDALFlushRasterCache(hMaskBand);
-        }
-
-        void *pScaledProgress = GDALCreateScaledProgress(
-            dfProgressRatio, 1.0, pfnProgress, pProgressArg);
-
-        eErr = GDALMultiFilter(hTargetBand, hMaskBand, hFiltMaskBand,
-                               nSmoothingIterations, GDALScaledProgress,
-                               pScaledProgress);
-
-        GDALDestroyScaledProgress(pScaledProgress);
+        eErr = GDALFillNodataSmooth(hTargetBand, hMaskBand,
+                                    poTmpMaskDS == nullptr, hFiltMaskBand,
+                                    nSmoothingIterations, nThreads,
+                                    dfProgressRatio, pfnProgress, pProgressArg);
     }
 
 /* -------------------------------------------------------------------- */
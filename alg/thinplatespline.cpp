@@ -42,9 +42,12 @@
 
 #include <algorithm>
 #include <limits>
+#include <numeric>
 #include <utility>
 
+#include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_string.h"
 #include "cpl_vsi.h"
 
 //////////////////////////////////////////////////////////////////////////////
@@ -187,6 +190,13 @@ template <typename T> static inline T SQ(const T &x)
     return x * x;
 }
 
+// Parameters of the fast evaluation of splines with many points.
+constexpr int FAST_EVAL_MIN_POINTS = 1000;
+constexpr int FAST_EVAL_LEAF_SIZE = 32;
+constexpr int FAST_EVAL_ORDER = 20;
+constexpr int FAST_EVAL_STRIDE = 4 + 4 * FAST_EVAL_ORDER;
+constexpr double FAST_EVAL_THETA = 0.3;
+
 static inline double VizGeorefSpline2DBase_func(const double x1,
                                                 const double y1,
                                                 const double x2,
@@ -620,9 +630,263 @@ int VizGeorefSpline2D::solve()
         for (int iRow = 0; iRow < _nof_eqs; iRow++)
             coef[iRHS][iRow] = Coef(iRow, iRHS);
 
+    fast_nodes.clear();
+    if (_nof_points >=
+        atoi(CPLGetConfigOption("GDAL_TPS_FAST_EVAL_MIN_POINTS",
+                                CPLSPrintf("%d", FAST_EVAL_MIN_POINTS))))
+    {
+        build_fast_eval();
+    }
+
     return 4;
 }
 
+/************************************************************************/
+/*                          build_fast_eval()                           */
+/************************************************************************/
+
+// The sum of the radial basis terms of a cluster of points t_i, with
+// coefficients c_i, evaluated at a point z far enough from the cluster
+// (in complex notation, relative to the cluster center) is
+//      S(z) = sum c_i |z - t_i|^2 log(|z - t_i|^2)
+//           = 2 Re( conj(z) G(c_i) - G(c_i * conj(t_i)) )
+// where, from the expansion of (z - t) log(z - t) in powers of t / z,
+//      G(w_i) = sum w_i (z - t_i) log(z - t_i)
+//             = W0 z log(z) - W1 log(z) - W1 + sum_k>=1 W(k+1) / (k (k+1) z^k)
+// with Wj = sum w_i t_i^j. The log(z) terms combine into a real multiple of
+// log(|z|), and the series is truncated at FAST_EVAL_ORDER, which, with
+// |t_i| <= FAST_EVAL_THETA |z|, gives a relative error below 1e-13.
+// This is the multipole expansion of Beatson and Newsam, "Fast evaluation
+// of radial basis functions: I", 1992.
+
+void VizGeorefSpline2D::build_fast_eval()
+{
+    try
+    {
+        std::vector<int> anOrder(_nof_points);
+        std::iota(anOrder.begin(), anOrder.end(), 0);
+        fast_nodes.reserve(2 * (_nof_points / FAST_EVAL_LEAF_SIZE + 1));
+        fast_expansions.clear();
+        build_fast_eval_node(anOrder, 0, _nof_points);
+
+        fast_x.resize(_nof_points);
+        fast_y.resize(_nof_points);
+        fast_coef.resize(static_cast<size_t>(_nof_points) * _nof_vars);
+        for (int i = 0; i < _nof_points; i++)
+        {
+            fast_x[i] = x[anOrder[i]];
+            fast_y[i] = y[anOrder[i]];
+            for (int v = 0; v < _nof_vars; v++)
+                fast_coef[static_cast<size_t>(v) * _nof_points + i] =
+                    coef[v][anOrder[i] + 3];
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        // Fallback to the direct summation.
+        fast_nodes.clear();
+    }
+}
+
+// Recursively split the points of anOrder[nFirst:nLast] along the largest
+// dimension of their extent, and compute the expansions of each cluster.
+// Returns the index of the node.
+int VizGeorefSpline2D::build_fast_eval_node(std::vector<int> &anOrder,
+                                            int nFirst, int nLast)
+{
+    double xmin = std::numeric_limits<double>::max();
+    double ymin = std::numeric_limits<double>::max();
+    double xmax = -std::numeric_limits<double>::max();
+    double ymax = -std::numeric_limits<double>::max();
+    for (int i = nFirst; i < nLast; i++)
+    {
+        xmin = std::min(xmin, x[anOrder[i]]);
+        xmax = std::max(xmax, x[anOrder[i]]);
+        ymin = std::min(ymin, y[anOrder[i]]);
+        ymax = std::max(ymax, y[anOrder[i]]);
+    }
+
+    FastEvalNode node;
+    node.cx = (xmin + xmax) / 2;
+    node.cy = (ymin + ymax) / 2;
+    node.radius = 0;
+    for (int i = nFirst; i < nLast; i++)
+    {
+        node.radius = std::max(node.radius, SQ(x[anOrder[i]] - node.cx) +
+                                                SQ(y[anOrder[i]] - node.cy));
+    }
+    node.radius = sqrt(node.radius);
+    node.first = nFirst;
+    node.last = nLast;
+    node.child1 = -1;
+    node.child2 = -1;
+
+    const int nIdx = static_cast<int>(fast_nodes.size());
+    fast_nodes.push_back(node);
+
+    // Expansion coefficients, pre-multiplied by 2 * scale^2, for each
+    // variable: a0, a1 (complex), b1, then the alpha_k and beta_k (complex)
+    // coefficients of the series for k = 1 ... FAST_EVAL_ORDER.
+    const size_t nOffset = fast_expansions.size();
+    fast_expansions.resize(nOffset + FAST_EVAL_STRIDE * _nof_vars);
+    const double scale = node.radius > 0 ? node.radius : 1.0;
+    for (int v = 0; v < _nof_vars; v++)
+    {
+        double *e = &fast_expansions[nOffset + FAST_EVAL_STRIDE * v];
+        double *alpha = e + 4;
+        double *beta = e + 4 + 2 * FAST_EVAL_ORDER;
+        for (int i = nFirst; i < nLast; i++)
+        {
+            const double c = coef[v][anOrder[i] + 3];
+            const double tr = (x[anOrder[i]] - node.cx) / scale;
+            const double ti = (y[anOrder[i]] - node.cy) / scale;
+            const double t2 = tr * tr + ti * ti;
+            e[0] += c;
+            e[1] += c * tr;
+            e[2] += c * ti;
+            e[3] += c * t2;
+            // alpha[k-1] accumulates c * t^(k+1), beta[k-1] c * |t|^2 * t^k
+            double pr = tr;
+            double pi = ti;
+            for (int k = 1; k <= FAST_EVAL_ORDER; k++)
+            {
+                beta[2 * (k - 1)] += c * t2 * pr;
+                beta[2 * (k - 1) + 1] += c * t2 * pi;
+                const double npr = pr * tr - pi * ti;
+                pi = pr * ti + pi * tr;
+                pr = npr;
+                alpha[2 * (k - 1)] += c * pr;
+                alpha[2 * (k - 1) + 1] += c * pi;
+            }
+        }
+        const double fact = 2 * scale * scale;
+        for (int j = 0; j < 4; j++)
+            e[j] *= fact;
+        for (int k = 1; k <= FAST_EVAL_ORDER; k++)
+        {
+            const double kfact = fact / (k * (k + 1.0));
+            alpha[2 * (k - 1)] *= kfact;
+            alpha[2 * (k - 1) + 1] *= kfact;
+            beta[2 * (k - 1)] *= kfact;
+            beta[2 * (k - 1) + 1] *= kfact;
+        }
+    }
+
+    if (nLast - nFirst > FAST_EVAL_LEAF_SIZE)
+    {
+        const int nMiddle = nFirst + (nLast - nFirst) / 2;
+        const double *coords = (xmax - xmin >= ymax - ymin) ? x : y;
+        std::nth_element(anOrder.begin() + nFirst, anOrder.begin() + nMiddle,
+                         anOrder.begin() + nLast, [coords](int a, int b)
+                         { return coords[a] < coords[b]; });
+        const int nChild1 = build_fast_eval_node(anOrder, nFirst, nMiddle);
+        const int nChild2 = build_fast_eval_node(anOrder, nMiddle, nLast);
+        fast_nodes[nIdx].child1 = nChild1;
+        fast_nodes[nIdx].child2 = nChild2;
+    }
+
+    return nIdx;
+}
+
+/************************************************************************/
+/*                       add_radial_terms_fast()                        */
+/************************************************************************/
+
+void VizGeorefSpline2D::add_radial_terms_fast(const double *Pxy,
+                                              double *vars) const
+{
+    // The depth of the tree is at most log2(INT_MAX), and each visited node
+    // adds at most 2 entries while removing one.
+    int anStack[64];
+    int nStackSize = 0;
+    anStack[nStackSize++] = 0;
+    while (nStackSize > 0)
+    {
+        const int nIdx = anStack[--nStackSize];
+        const FastEvalNode &node = fast_nodes[nIdx];
+        const double dx = Pxy[0] - node.cx;
+        const double dy = Pxy[1] - node.cy;
+        const double dist2 = dx * dx + dy * dy;
+        if (dist2 * SQ(FAST_EVAL_THETA) > SQ(node.radius))
+        {
+            // Far field: use the expansion.
+            const double inv_scale =
+                node.radius > 0 ? 1.0 / node.radius : 1.0;
+            const double zr = dx * inv_scale;
+            const double zi = dy * inv_scale;
+            const double z2 = zr * zr + zi * zi;
+            const double ur = zr / z2;
+            const double ui = -zi / z2;
+            const double log_abs_z = 0.5 * log(dist2);
+            for (int v = 0; v < _nof_vars; v++)
+            {
+                const double *e =
+                    &fast_expansions[(static_cast<size_t>(nIdx) * _nof_vars +
+                                      v) *
+                                     FAST_EVAL_STRIDE];
+                const double *alpha = e + 4;
+                const double *beta = e + 4 + 2 * FAST_EVAL_ORDER;
+                double s0r = alpha[2 * (FAST_EVAL_ORDER - 1)];
+                double s0i = alpha[2 * (FAST_EVAL_ORDER - 1) + 1];
+                double s1r = beta[2 * (FAST_EVAL_ORDER - 1)];
+                double s1i = beta[2 * (FAST_EVAL_ORDER - 1) + 1];
+                for (int k = FAST_EVAL_ORDER - 1; k >= 0; k--)
+                {
+                    const double n0r = s0r * ur - s0i * ui;
+                    s0i = s0r * ui + s0i * ur;
+                    s0r = n0r;
+                    const double n1r = s1r * ur - s1i * ui;
+                    s1i = s1r * ui + s1i * ur;
+                    s1r = n1r;
+                    if (k > 0)
+                    {
+                        s0r += alpha[2 * (k - 1)];
+                        s0i += alpha[2 * (k - 1) + 1];
+                        s1r += beta[2 * (k - 1)];
+                        s1i += beta[2 * (k - 1) + 1];
+                    }
+                }
+                const double re_zbar_a1 = zr * e[1] + zi * e[2];
+                const double sum_sq = e[0] * z2 - 2 * re_zbar_a1 + e[3];
+                vars[v] += sum_sq * log_abs_z - re_zbar_a1 + e[3] +
+                           (zr * s0r + zi * s0i) - s1r;
+            }
+        }
+        else if (node.child1 < 0)
+        {
+            // Near field: direct summation.
+            int r = node.first;
+            for (; r + 4 <= node.last; r += 4)
+            {
+                double dfTmp[4] = {};
+                VizGeorefSpline2DBase_func4(dfTmp, Pxy, &fast_x[r],
+                                            &fast_y[r]);
+                for (int v = 0; v < _nof_vars; v++)
+                {
+                    const double *c =
+                        &fast_coef[static_cast<size_t>(v) * _nof_points + r];
+                    vars[v] += c[0] * dfTmp[0] + c[1] * dfTmp[1] +
+                               c[2] * dfTmp[2] + c[3] * dfTmp[3];
+                }
+            }
+            for (; r < node.last; r++)
+            {
+                const double tmp = VizGeorefSpline2DBase_func(
+                    Pxy[0], Pxy[1], fast_x[r], fast_y[r]);
+                for (int v = 0; v < _nof_vars; v++)
+                    vars[v] +=
+                        fast_coef[static_cast<size_t>(v) * _nof_points + r] *
+                        tmp;
+            }
+        }
+        else
+        {
+            anStack[nStackSize++] = node.child2;
+            anStack[nStackSize++] = node.child1;
+        }
+    }
+}
+
 int VizGeorefSpline2D::get_point(const double Px, const double Py, double *vars)
 {
     switch (type)
@@ -685,6 +949,12 @@ int VizGeorefSpline2D::get_point(const double Px, const double Py, double *vars)
                 vars[v] =
                     coef[v][0] + coef[v][1] * Pxy[0] + coef[v][2] * Pxy[1];
 
+            if (!fast_nodes.empty())
+            {
+                add_radial_terms_fast(Pxy, vars);
+                break;
+            }
+
             int r = 0;  // Used after for.
             for (; r < (_nof_points & (~3)); r += 4)
             {
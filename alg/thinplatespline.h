@@ -38,6 +38,8 @@
 #include "gdal_alg.h"
 #include "cpl_conv.h"
 
+#include <vector>
+
 typedef enum
 {
     VIZ_GEOREF_SPLINE_ZERO_POINTS,
@@ -56,6 +58,9 @@ typedef enum
 class VizGeorefSpline2D
 {
     bool grow_points();
+    void build_fast_eval();
+    int build_fast_eval_node(std::vector<int> &anOrder, int nFirst, int nLast);
+    void add_radial_terms_fast(const double *Pxy, double *vars) const;
 
   public:
     explicit VizGeorefSpline2D(int nof_vars = 1)
@@ -181,6 +186,26 @@ class VizGeorefSpline2D
     double x_mean;
     double y_mean;
 
+    // Hierarchical clustering of the points, with far-field expansions of
+    // the radial basis terms of each cluster, used by get_point() instead
+    // of the direct summation when there are many points.
+    struct FastEvalNode
+    {
+        double cx;
+        double cy;
+        double radius;
+        int first;  // Range of points, in fast_x/fast_y order.
+        int last;
+        int child1;  // -1 for leaves.
+        int child2;
+    };
+
+    std::vector<FastEvalNode> fast_nodes{};
+    std::vector<double> fast_expansions{};
+    std::vector<double> fast_x{};
+    std::vector<double> fast_y{};
+    std::vector<double> fast_coef{};
+
   private:
     CPL_DISALLOW_COPY_ASSIGN(VizGeorefSpline2D)
 };
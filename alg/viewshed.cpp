@@ -31,29 +31,34 @@
 #include <cmath>
 #include <cstring>
 #include <array>
+#include <atomic>
 #include <limits>
 #include <algorithm>
+#include <memory>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_spatialref.h"
 #include "ogr_core.h"
 #include "commonutils.h"
 
 inline static void SetVisibility(int iPixel, double dfZ, double dfZTarget,
-                                 double *padfZVal, std::vector<GByte> &vResult,
+                                 double *padfZVal, GByte *pabyResult,
                                  GByte byVisibleVal, GByte byInvisibleVal)
 {
     if (padfZVal[iPixel] + dfZTarget < dfZ)
-        vResult[iPixel] = byInvisibleVal;
+        pabyResult[iPixel] = byInvisibleVal;
     else
-        vResult[iPixel] = byVisibleVal;
+        pabyResult[iPixel] = byVisibleVal;
 
     if (padfZVal[iPixel] < dfZ)
         padfZVal[iPixel] = dfZ;
@@ -117,6 +122,457 @@ inline static double CalcHeight(double dfZ, double dfZ2, GDALViewshedMode eMode)
         return dfZ;
 }
 
+namespace
+{
+
+/** Settings shared by all the lines of the viewshed of one observer. */
+struct ViewshedParams
+{
+    const double *padfGeoTransform = nullptr;
+    int nX = 0;  // Observer column, relative to the computed window.
+    double dfZObserver = 0.0;
+    double dfTargetHeight = 0.0;
+    double dfDistance2 = 0.0;
+    double dfCurvCoeff = 0.0;
+    double dfSphereDiameter = std::numeric_limits<double>::infinity();
+    GDALViewshedMode eMode = GVM_Edge;
+    GDALViewshedOutputType heightMode = GVOT_NORMAL;
+    GByte byVisibleVal = 255;
+    GByte byInvisibleVal = 0;
+    GByte byOutOfRangeVal = 0;
+    double dfOutOfRangeVal = 0.0;
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                      ProcessViewshedFirstLine()                      */
+/*                                                                      */
+/*      Process columns [iFirst, iLast] of the observer line.           */
+/************************************************************************/
+
+static void ProcessViewshedFirstLine(const ViewshedParams &sParams, int iFirst,
+                                     int iLast, double *padfLineVal,
+                                     GByte *pabyResult, double *dfHeightResult)
+{
+    const int nX = sParams.nX;
+    const double *padfGeoTransform = sParams.padfGeoTransform;
+    const GDALViewshedOutputType heightMode = sParams.heightMode;
+
+    /* mark the observer point as visible */
+    double dfGroundLevel =
+        heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM ? padfLineVal[nX] : 0.0;
+    pabyResult[nX] = sParams.byVisibleVal;
+    if (heightMode != GVOT_NORMAL)
+        dfHeightResult[nX] = dfGroundLevel;
+
+    if (nX > iFirst)
+    {
+        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
+                            ? padfLineVal[nX - 1]
+                            : 0.0;
+        CPL_IGNORE_RET_VAL(AdjustHeightInRange(
+            padfGeoTransform, 1, 0, padfLineVal[nX - 1], sParams.dfDistance2,
+            sParams.dfCurvCoeff, sParams.dfSphereDiameter));
+        pabyResult[nX - 1] = sParams.byVisibleVal;
+        if (heightMode != GVOT_NORMAL)
+            dfHeightResult[nX - 1] = dfGroundLevel;
+    }
+    if (nX < iLast)
+    {
+        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
+                            ? padfLineVal[nX + 1]
+                            : 0.0;
+        CPL_IGNORE_RET_VAL(AdjustHeightInRange(
+            padfGeoTransform, 1, 0, padfLineVal[nX + 1], sParams.dfDistance2,
+            sParams.dfCurvCoeff, sParams.dfSphereDiameter));
+        pabyResult[nX + 1] = sParams.byVisibleVal;
+        if (heightMode != GVOT_NORMAL)
+            dfHeightResult[nX + 1] = dfGroundLevel;
+    }
+
+    /* process left direction */
+    for (int iPixel = nX - 2; iPixel >= iFirst; iPixel--)
+    {
+        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
+                            ? padfLineVal[iPixel]
+                            : 0.0;
+        bool adjusted = AdjustHeightInRange(
+            padfGeoTransform, nX - iPixel, 0, padfLineVal[iPixel],
+            sParams.dfDistance2, sParams.dfCurvCoeff, sParams.dfSphereDiameter);
+        if (adjusted)
+        {
+            const double dfZ = CalcHeightLine(
+                nX - iPixel, padfLineVal[iPixel + 1], sParams.dfZObserver);
+
+            if (heightMode != GVOT_NORMAL)
+                dfHeightResult[iPixel] = std::max(
+                    0.0, (dfZ - padfLineVal[iPixel] + dfGroundLevel));
+
+            SetVisibility(iPixel, dfZ, sParams.dfTargetHeight, padfLineVal,
+                          pabyResult, sParams.byVisibleVal,
+                          sParams.byInvisibleVal);
+        }
+        else
+        {
+            for (; iPixel >= iFirst; iPixel--)
+            {
+                pabyResult[iPixel] = sParams.byOutOfRangeVal;
+                if (heightMode != GVOT_NORMAL)
+                    dfHeightResult[iPixel] = sParams.dfOutOfRangeVal;
+            }
+        }
+    }
+    /* process right direction */
+    for (int iPixel = nX + 2; iPixel <= iLast; iPixel++)
+    {
+        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
+                            ? padfLineVal[iPixel]
+                            : 0.0;
+        bool adjusted = AdjustHeightInRange(
+            padfGeoTransform, iPixel - nX, 0, padfLineVal[iPixel],
+            sParams.dfDistance2, sParams.dfCurvCoeff, sParams.dfSphereDiameter);
+        if (adjusted)
+        {
+            const double dfZ = CalcHeightLine(
+                iPixel - nX, padfLineVal[iPixel - 1], sParams.dfZObserver);
+
+            if (heightMode != GVOT_NORMAL)
+                dfHeightResult[iPixel] = std::max(
+                    0.0, (dfZ - padfLineVal[iPixel] + dfGroundLevel));
+
+            SetVisibility(iPixel, dfZ, sParams.dfTargetHeight, padfLineVal,
+                          pabyResult, sParams.byVisibleVal,
+                          sParams.byInvisibleVal);
+        }
+        else
+        {
+            for (; iPixel <= iLast; iPixel++)
+            {
+                pabyResult[iPixel] = sParams.byOutOfRangeVal;
+                if (heightMode != GVOT_NORMAL)
+                    dfHeightResult[iPixel] = sParams.dfOutOfRangeVal;
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                        ProcessViewshedLine()                         */
+/*                                                                      */
+/*      Process columns [iFirst, iLast] of a line at nDY lines from     */
+/*      the observer (above or below), padfLastLineVal being the        */
+/*      processed line that is one line closer to the observer.  The    */
+/*      left and right sides of the observer column only depend on      */
+/*      that column, so they may be processed independently.            */
+/************************************************************************/
+
+static void ProcessViewshedLine(const ViewshedParams &sParams, int nDY,
+                                int iFirst, int iLast, double *padfThisLineVal,
+                                const double *padfLastLineVal,
+                                GByte *pabyResult, double *dfHeightResult)
+{
+    const int nX = sParams.nX;
+    const double *padfGeoTransform = sParams.padfGeoTransform;
+    const GDALViewshedOutputType heightMode = sParams.heightMode;
+    const GDALViewshedMode eMode = sParams.eMode;
+    const double dfZObserver = sParams.dfZObserver;
+    double dfZ = 0.0;
+
+    /* set up initial point on the scanline */
+    double dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
+                               ? padfThisLineVal[nX]
+                               : 0.0;
+    bool adjusted = AdjustHeightInRange(
+        padfGeoTransform, 0, nDY, padfThisLineVal[nX], sParams.dfDistance2,
+        sParams.dfCurvCoeff, sParams.dfSphereDiameter);
+    if (adjusted)
+    {
+        dfZ = CalcHeightLine(nDY, padfLastLineVal[nX], dfZObserver);
+
+        if (heightMode != GVOT_NORMAL)
+            dfHeightResult[nX] =
+                std::max(0.0, (dfZ - padfThisLineVal[nX] + dfGroundLevel));
+
+        SetVisibility(nX, dfZ, sParams.dfTargetHeight, padfThisLineVal,
+                      pabyResult, sParams.byVisibleVal, sParams.byInvisibleVal);
+    }
+    else
+    {
+        pabyResult[nX] = sParams.byOutOfRangeVal;
+        if (heightMode != GVOT_NORMAL)
+            dfHeightResult[nX] = sParams.dfOutOfRangeVal;
+    }
+
+    /* process left direction */
+    for (int iPixel = nX - 1; iPixel >= iFirst; iPixel--)
+    {
+        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
+                            ? padfThisLineVal[iPixel]
+                            : 0.0;
+        bool left_adjusted = AdjustHeightInRange(
+            padfGeoTransform, nX - iPixel, nDY, padfThisLineVal[iPixel],
+            sParams.dfDistance2, sParams.dfCurvCoeff, sParams.dfSphereDiameter);
+        if (left_adjusted)
+        {
+            if (eMode != GVM_Edge)
+                dfZ = CalcHeightDiagonal(nX - iPixel, nDY,
+                                         padfThisLineVal[iPixel + 1],
+                                         padfLastLineVal[iPixel], dfZObserver);
+
+            if (eMode != GVM_Diagonal)
+            {
+                double dfZ2 =
+                    nX - iPixel >= nDY
+                        ? CalcHeightEdge(nDY, nX - iPixel,
+                                         padfLastLineVal[iPixel + 1],
+                                         padfThisLineVal[iPixel + 1],
+                                         dfZObserver)
+                        : CalcHeightEdge(nX - iPixel, nDY,
+                                         padfLastLineVal[iPixel + 1],
+                                         padfLastLineVal[iPixel], dfZObserver);
+                dfZ = CalcHeight(dfZ, dfZ2, eMode);
+            }
+
+            if (heightMode != GVOT_NORMAL)
+                dfHeightResult[iPixel] = std::max(
+                    0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
+
+            SetVisibility(iPixel, dfZ, sParams.dfTargetHeight, padfThisLineVal,
+                          pabyResult, sParams.byVisibleVal,
+                          sParams.byInvisibleVal);
+        }
+        else
+        {
+            for (; iPixel >= iFirst; iPixel--)
+            {
+                pabyResult[iPixel] = sParams.byOutOfRangeVal;
+                if (heightMode != GVOT_NORMAL)
+                    dfHeightResult[iPixel] = sParams.dfOutOfRangeVal;
+            }
+        }
+    }
+    /* process right direction */
+    for (int iPixel = nX + 1; iPixel <= iLast; iPixel++)
+    {
+        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
+                            ? padfThisLineVal[iPixel]
+                            : 0.0;
+        bool right_adjusted = AdjustHeightInRange(
+            padfGeoTransform, iPixel - nX, nDY, padfThisLineVal[iPixel],
+            sParams.dfDistance2, sParams.dfCurvCoeff, sParams.dfSphereDiameter);
+        if (right_adjusted)
+        {
+            if (eMode != GVM_Edge)
+                dfZ = CalcHeightDiagonal(iPixel - nX, nDY,
+                                         padfThisLineVal[iPixel - 1],
+                                         padfLastLineVal[iPixel], dfZObserver);
+
+            if (eMode != GVM_Diagonal)
+            {
+                double dfZ2 =
+                    iPixel - nX >= nDY
+                        ? CalcHeightEdge(nDY, iPixel - nX,
+                                         padfLastLineVal[iPixel - 1],
+                                         padfThisLineVal[iPixel - 1],
+                                         dfZObserver)
+                        : CalcHeightEdge(iPixel - nX, nDY,
+                                         padfLastLineVal[iPixel - 1],
+                                         padfLastLineVal[iPixel], dfZObserver);
+                dfZ = CalcHeight(dfZ, dfZ2, eMode);
+            }
+
+            if (heightMode != GVOT_NORMAL)
+                dfHeightResult[iPixel] = std::max(
+                    0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
+
+            SetVisibility(iPixel, dfZ, sParams.dfTargetHeight, padfThisLineVal,
+                          pabyResult, sParams.byVisibleVal,
+                          sParams.byInvisibleVal);
+        }
+        else
+        {
+            for (; iPixel <= iLast; iPixel++)
+            {
+                pabyResult[iPixel] = sParams.byOutOfRangeVal;
+                if (heightMode != GVOT_NORMAL)
+                    dfHeightResult[iPixel] = sParams.dfOutOfRangeVal;
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                         GetViewshedWindow()                          */
+/*                                                                      */
+/*      Compute the observer position and the window of the DEM that    */
+/*      is within dfMaxDistance of it.  Returns false if the observer   */
+/*      is outside of the DEM.                                          */
+/************************************************************************/
+
+static bool GetViewshedWindow(const double *adfInvGeoTransform, int nXSize,
+                              int nYSize, double dfObserverX,
+                              double dfObserverY, double dfMaxDistance,
+                              int &nX, int &nY, int &nXStart, int &nXStop,
+                              int &nYStart, int &nYStop)
+{
+    /* calculate observer position */
+    double dfX, dfY;
+    GDALApplyGeoTransform(adfInvGeoTransform, dfObserverX, dfObserverY, &dfX,
+                          &dfY);
+    nX = static_cast<int>(dfX);
+    nY = static_cast<int>(dfY);
+
+    if (nX < 0 || nX >= nXSize || nY < 0 || nY >= nYSize)
+        return false;
+
+    /* calculate the area of interest */
+    nXStart = dfMaxDistance > 0
+                  ? (std::max)(0, static_cast<int>(std::floor(
+                                      nX - adfInvGeoTransform[1] *
+                                               dfMaxDistance)))
+                  : 0;
+    nXStop = dfMaxDistance > 0
+                 ? (std::min)(nXSize,
+                              static_cast<int>(
+                                  std::ceil(nX + adfInvGeoTransform[1] *
+                                                     dfMaxDistance) +
+                                  1))
+                 : nXSize;
+    nYStart = dfMaxDistance > 0
+                  ? (std::max)(0, static_cast<int>(std::floor(
+                                      nY + adfInvGeoTransform[5] *
+                                               dfMaxDistance)))
+                  : 0;
+    nYStop = dfMaxDistance > 0
+                 ? (std::min)(nYSize,
+                              static_cast<int>(
+                                  std::ceil(nY - adfInvGeoTransform[5] *
+                                                     dfMaxDistance) +
+                                  1))
+                 : nYSize;
+    return true;
+}
+
+/************************************************************************/
+/*                       GetViewshedNumThreads()                        */
+/************************************************************************/
+
+static int GetViewshedNumThreads(CSLConstList papszExtraOptions)
+{
+    const char *pszNumThreads =
+        CSLFetchNameValue(papszExtraOptions, "NUM_THREADS");
+    if (pszNumThreads == nullptr)
+        pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : atoi(pszNumThreads);
+    return std::max(1, std::min(128, nThreads));
+}
+
+/************************************************************************/
+/*                       GetViewshedSphereDiameter()                    */
+/************************************************************************/
+
+static double GetViewshedSphereDiameter(const OGRSpatialReference *poDstSRS)
+{
+    /* If we can't get a SemiMajor axis from the SRS, it will be
+     * SRS_WGS84_SEMIMAJOR
+     */
+    double dfSphereDiameter(std::numeric_limits<double>::infinity());
+    if (poDstSRS)
+    {
+        OGRErr eSRSerr;
+        double dfSemiMajor = poDstSRS->GetSemiMajor(&eSRSerr);
+
+        /* If we fetched the axis from the SRS, use it */
+        if (eSRSerr != OGRERR_FAILURE)
+            dfSphereDiameter = dfSemiMajor * 2.0;
+        else
+            CPLDebug("GDALViewshedGenerate",
+                     "Unable to fetch SemiMajor axis from spatial reference");
+    }
+    return dfSphereDiameter;
+}
+
+namespace
+{
+
+/** One quadrant (left or right of the observer column, above or below the
+ * observer line) of the viewshed of a single observer. Each quadrant keeps
+ * its own copy of the observer column, so quadrants can be processed by
+ * different threads. */
+struct ViewshedQuadrant
+{
+    const ViewshedParams *psParams = nullptr;
+    int iFirst = 0;
+    int iLast = 0;
+    int iFirstOut = 0;  // First column copied to the output block.
+    bool bUpward = true;
+    std::vector<double> adfLastLineVal{};
+    std::vector<double> adfThisLineVal{};
+    std::vector<GByte> abyResult{};
+    std::vector<double> adfHeightResult{};
+
+    int nXSize = 0;
+    int nY = 0;              // Observer line, relative to the window.
+    int iBlockLine = 0;      // Window line of the first line of the block.
+    int nBlockLines = 0;
+    const double *padfDEMBlock = nullptr;
+    GByte *pabyResultBlock = nullptr;
+    double *padfHeightResultBlock = nullptr;
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                      ProcessViewshedQuadrant()                       */
+/*                                                                      */
+/*      Process the lines of the current block of a quadrant, from the  */
+/*      closest to the farthest from the observer.                      */
+/************************************************************************/
+
+static void ProcessViewshedQuadrant(void *pData)
+{
+    ViewshedQuadrant *psQuadrant = static_cast<ViewshedQuadrant *>(pData);
+    const int nXSize = psQuadrant->nXSize;
+    const int iFirst = psQuadrant->iFirst;
+    const int nCount = psQuadrant->iLast - iFirst + 1;
+    const int iFirstOut = psQuadrant->iFirstOut;
+    const int nCountOut = psQuadrant->iLast - iFirstOut + 1;
+    const bool bHeight = psQuadrant->psParams->heightMode != GVOT_NORMAL;
+
+    for (int k = 0; k < psQuadrant->nBlockLines; k++)
+    {
+        const int iBlockOffset =
+            psQuadrant->bUpward ? psQuadrant->nBlockLines - 1 - k : k;
+        const int iLine = psQuadrant->iBlockLine + iBlockOffset;
+        const size_t nOffset = static_cast<size_t>(iBlockOffset) * nXSize;
+
+        double *padfThisLineVal = psQuadrant->adfThisLineVal.data();
+        memcpy(padfThisLineVal + iFirst,
+               psQuadrant->padfDEMBlock + nOffset + iFirst,
+               nCount * sizeof(double));
+
+        ProcessViewshedLine(*(psQuadrant->psParams),
+                            std::abs(iLine - psQuadrant->nY), iFirst,
+                            psQuadrant->iLast, padfThisLineVal,
+                            psQuadrant->adfLastLineVal.data(),
+                            psQuadrant->abyResult.data(),
+                            psQuadrant->adfHeightResult.data());
+
+        if (bHeight)
+            memcpy(psQuadrant->padfHeightResultBlock + nOffset + iFirstOut,
+                   psQuadrant->adfHeightResult.data() + iFirstOut,
+                   nCountOut * sizeof(double));
+        else
+            memcpy(psQuadrant->pabyResultBlock + nOffset + iFirstOut,
+                   psQuadrant->abyResult.data() + iFirstOut, nCountOut);
+
+        std::swap(psQuadrant->adfLastLineVal, psQuadrant->adfThisLineVal);
+    }
+}
+
 /************************************************************************/
 /*                        GDALViewshedGenerate()                         */
 /************************************************************************/
@@ -201,7 +657,12 @@ inline static double CalcHeight(double dfZ, double dfZ2, GDALViewshedMode eMode)
  * and dfInvisibleVal will be ignored.
  *
  *
- * @param papszExtraOptions Future extra options. Must be set to NULL currently.
+ * @param papszExtraOptions Extra options. Supported options are:
+ * <ul>
+ * <li>NUM_THREADS=N|ALL_CPUS: (GDAL >= 3.9) Number of worker threads used to
+ * process the four quadrants around the observer.  Defaults to the value of
+ * the GDAL_NUM_THREADS configuration option, or 1.</li>
+ * </ul>
  *
  * @return not NULL output dataset on success (to be closed with GDALClose()) or
  * NULL if an error occurs.
@@ -223,8 +684,6 @@ GDALDatasetH GDALViewshedGenerate(
     VALIDATE_POINTER1(hBand, "GDALViewshedGenerate", nullptr);
     VALIDATE_POINTER1(pszTargetRasterName, "GDALViewshedGenerate", nullptr);
 
-    CPL_IGNORE_RET_VAL(papszExtraOptions);
-
     if (pfnProgress == nullptr)
         pfnProgress = GDALDummyProgress;
 
@@ -264,54 +723,23 @@ GDALDatasetH GDALViewshedGenerate(
         return nullptr;
     }
 
-    /* calculate observer position */
-    double dfX, dfY;
-    GDALApplyGeoTransform(adfInvGeoTransform, dfObserverX, dfObserverY, &dfX,
-                          &dfY);
-    int nX = static_cast<int>(dfX);
-    int nY = static_cast<int>(dfY);
-
-    int nXSize = GDALGetRasterBandXSize(hBand);
-    int nYSize = GDALGetRasterBandYSize(hBand);
-
-    if (nX < 0 || nX > nXSize || nY < 0 || nY > nYSize)
+    /* calculate observer position and the area of interest */
+    int nX, nY, nXStart, nXStop, nYStart, nYStop;
+    if (!GetViewshedWindow(adfInvGeoTransform, GDALGetRasterBandXSize(hBand),
+                           GDALGetRasterBandYSize(hBand), dfObserverX,
+                           dfObserverY, dfMaxDistance, nX, nY, nXStart, nXStop,
+                           nYStart, nYStop))
     {
         CPLError(CE_Failure, CPLE_AppDefined,
                  "The observer location falls outside of the DEM area");
         return nullptr;
     }
 
-    /* calculate the area of interest */
-    int nXStart =
-        dfMaxDistance > 0
-            ? (std::max)(0, static_cast<int>(std::floor(
-                                nX - adfInvGeoTransform[1] * dfMaxDistance)))
-            : 0;
-    int nXStop =
-        dfMaxDistance > 0
-            ? (std::min)(nXSize,
-                         static_cast<int>(std::ceil(nX + adfInvGeoTransform[1] *
-                                                             dfMaxDistance) +
-                                          1))
-            : nXSize;
-    int nYStart =
-        dfMaxDistance > 0
-            ? (std::max)(0, static_cast<int>(std::floor(
-                                nY + adfInvGeoTransform[5] * dfMaxDistance)))
-            : 0;
-    int nYStop =
-        dfMaxDistance > 0
-            ? (std::min)(nYSize,
-                         static_cast<int>(std::ceil(nY - adfInvGeoTransform[5] *
-                                                             dfMaxDistance) +
-                                          1))
-            : nYSize;
-
     /* normalize horizontal index (0 - nXSize) */
-    nXSize = nXStop - nXStart;
+    const int nXSize = nXStop - nXStart;
     nX -= nXStart;
 
-    nYSize = nYStop - nYStart;
+    const int nYSize = nYStop - nYStart;
 
     if (nXSize == 0 || nYSize == 0)
     {
@@ -319,21 +747,48 @@ GDALDatasetH GDALViewshedGenerate(
         return nullptr;
     }
 
+    /* lines are processed by blocks, above and below the observer */
+    const int nBlockLines = std::max(1, (1024 * 1024) / nXSize);
+
     std::vector<double> vFirstLineVal;
-    std::vector<double> vLastLineVal;
-    std::vector<double> vThisLineVal;
     std::vector<GByte> vResult;
     std::vector<double> vHeightResult;
+    std::vector<double> vUpDEMBlock;
+    std::vector<double> vDownDEMBlock;
+    std::vector<GByte> vUpResultBlock;
+    std::vector<GByte> vDownResultBlock;
+    std::vector<double> vUpHeightResultBlock;
+    std::vector<double> vDownHeightResultBlock;
+    std::array<ViewshedQuadrant, 4> asQuadrants;
 
     try
     {
+        const size_t nBlockSize = static_cast<size_t>(nXSize) * nBlockLines;
         vFirstLineVal.resize(nXSize);
-        vLastLineVal.resize(nXSize);
-        vThisLineVal.resize(nXSize);
         vResult.resize(nXSize);
+        vUpDEMBlock.resize(nBlockSize);
+        vDownDEMBlock.resize(nBlockSize);
 
         if (heightMode != GVOT_NORMAL)
+        {
             vHeightResult.resize(nXSize);
+            vUpHeightResultBlock.resize(nBlockSize);
+            vDownHeightResultBlock.resize(nBlockSize);
+        }
+        else
+        {
+            vUpResultBlock.resize(nBlockSize);
+            vDownResultBlock.resize(nBlockSize);
+        }
+
+        for (auto &sQuadrant : asQuadrants)
+        {
+            sQuadrant.adfLastLineVal.resize(nXSize);
+            sQuadrant.adfThisLineVal.resize(nXSize);
+            sQuadrant.abyResult.resize(nXSize);
+            if (heightMode != GVOT_NORMAL)
+                sQuadrant.adfHeightResult.resize(nXSize);
+        }
     }
     catch (...)
     {
@@ -343,8 +798,6 @@ GDALDatasetH GDALViewshedGenerate(
     }
 
     double *padfFirstLineVal = vFirstLineVal.data();
-    double *padfLastLineVal = vLastLineVal.data();
-    double *padfThisLineVal = vThisLineVal.data();
     GByte *pabyResult = vResult.data();
     double *dfHeightResult = vHeightResult.data();
 
@@ -407,470 +860,615 @@ GDALDatasetH GDALViewshedGenerate(
         return nullptr;
     }
 
-    const double dfZObserver = dfObserverHeight + padfFirstLineVal[nX];
-    double dfZ = 0.0;
-    const double dfDistance2 = dfMaxDistance * dfMaxDistance;
+    ViewshedParams sParams;
+    sParams.padfGeoTransform = adfGeoTransform.data();
+    sParams.nX = nX;
+    sParams.dfZObserver = dfObserverHeight + padfFirstLineVal[nX];
+    sParams.dfTargetHeight = dfTargetHeight;
+    sParams.dfDistance2 = dfMaxDistance * dfMaxDistance;
+    sParams.dfCurvCoeff = dfCurvCoeff;
+    sParams.dfSphereDiameter =
+        GetViewshedSphereDiameter(poDstDS->GetSpatialRef());
+    sParams.eMode = eMode;
+    sParams.heightMode = heightMode;
+    sParams.byVisibleVal = byVisibleVal;
+    sParams.byInvisibleVal = byInvisibleVal;
+    sParams.byOutOfRangeVal = byOutOfRangeVal;
+    sParams.dfOutOfRangeVal = dfOutOfRangeVal;
+
+    ProcessViewshedFirstLine(sParams, 0, nXSize - 1, padfFirstLineVal,
+                             pabyResult, dfHeightResult);
 
-    /* If we can't get a SemiMajor axis from the SRS, it will be
-     * SRS_WGS84_SEMIMAJOR
-     */
-    double dfSphereDiameter(std::numeric_limits<double>::infinity());
-    const OGRSpatialReference *poDstSRS = poDstDS->GetSpatialRef();
-    if (poDstSRS)
+    /* write result line */
+    if (GDALRasterIO(hTargetBand, GF_Write, 0, nY - nYStart, nXSize, 1,
+                     heightMode != GVOT_NORMAL
+                         ? static_cast<void *>(dfHeightResult)
+                         : static_cast<void *>(pabyResult),
+                     nXSize, 1,
+                     heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte, 0, 0))
     {
-        OGRErr eSRSerr;
-        double dfSemiMajor = poDstSRS->GetSemiMajor(&eSRSerr);
-
-        /* If we fetched the axis from the SRS, use it */
-        if (eSRSerr != OGRERR_FAILURE)
-            dfSphereDiameter = dfSemiMajor * 2.0;
-        else
-            CPLDebug("GDALViewshedGenerate",
-                     "Unable to fetch SemiMajor axis from spatial reference");
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "RasterIO error when writing target raster at position "
+                 "(%d,%d), size (%d,%d)",
+                 0, nY - nYStart, nXSize, 1);
+        return nullptr;
     }
 
-    /* mark the observer point as visible */
-    double dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                               ? padfFirstLineVal[nX]
-                               : 0.0;
-    pabyResult[nX] = byVisibleVal;
-    if (heightMode != GVOT_NORMAL)
-        dfHeightResult[nX] = dfGroundLevel;
-
-    if (nX > 0)
-    {
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                            ? padfFirstLineVal[nX - 1]
-                            : 0.0;
-        CPL_IGNORE_RET_VAL(AdjustHeightInRange(
-            adfGeoTransform.data(), 1, 0, padfFirstLineVal[nX - 1], dfDistance2,
-            dfCurvCoeff, dfSphereDiameter));
-        pabyResult[nX - 1] = byVisibleVal;
-        if (heightMode != GVOT_NORMAL)
-            dfHeightResult[nX - 1] = dfGroundLevel;
-    }
-    if (nX < nXSize - 1)
+    /* set up the quadrants: upper left, upper right, lower left, lower right
+     */
+    for (int i = 0; i < 4; i++)
     {
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                            ? padfFirstLineVal[nX + 1]
-                            : 0.0;
-        CPL_IGNORE_RET_VAL(AdjustHeightInRange(
-            adfGeoTransform.data(), 1, 0, padfFirstLineVal[nX + 1], dfDistance2,
-            dfCurvCoeff, dfSphereDiameter));
-        pabyResult[nX + 1] = byVisibleVal;
-        if (heightMode != GVOT_NORMAL)
-            dfHeightResult[nX + 1] = dfGroundLevel;
+        auto &sQuadrant = asQuadrants[i];
+        const bool bLeft = (i % 2) == 0;
+        sQuadrant.psParams = &sParams;
+        sQuadrant.iFirst = bLeft ? 0 : nX;
+        sQuadrant.iLast = bLeft ? nX : nXSize - 1;
+        sQuadrant.iFirstOut = bLeft ? 0 : nX + 1;
+        sQuadrant.bUpward = i < 2;
+        sQuadrant.nXSize = nXSize;
+        sQuadrant.nY = nY;
+        sQuadrant.padfDEMBlock =
+            sQuadrant.bUpward ? vUpDEMBlock.data() : vDownDEMBlock.data();
+        sQuadrant.pabyResultBlock =
+            sQuadrant.bUpward ? vUpResultBlock.data() : vDownResultBlock.data();
+        sQuadrant.padfHeightResultBlock = sQuadrant.bUpward
+                                              ? vUpHeightResultBlock.data()
+                                              : vDownHeightResultBlock.data();
+        std::copy(vFirstLineVal.begin(), vFirstLineVal.end(),
+                  sQuadrant.adfLastLineVal.begin());
     }
+    // No right quadrants if the observer is on the last column.
+    const int nQuadrantsPerSide = nX < nXSize - 1 ? 2 : 1;
 
-    /* process left direction */
-    for (int iPixel = nX - 2; iPixel >= 0; iPixel--)
+    const int nThreads = GetViewshedNumThreads(papszExtraOptions);
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+
+    const auto ReadBlock = [hBand, nXStart, nXSize](int iLine, int nLines,
+                                                    double *padfBlock)
     {
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                            ? padfFirstLineVal[iPixel]
-                            : 0.0;
-        bool adjusted = AdjustHeightInRange(
-            adfGeoTransform.data(), nX - iPixel, 0, padfFirstLineVal[iPixel],
-            dfDistance2, dfCurvCoeff, dfSphereDiameter);
-        if (adjusted)
+        if (GDALRasterIO(hBand, GF_Read, nXStart, iLine, nXSize, nLines,
+                         padfBlock, nXSize, nLines, GDT_Float64, 0, 0))
         {
-            dfZ = CalcHeightLine(nX - iPixel, padfFirstLineVal[iPixel + 1],
-                                 dfZObserver);
-
-            if (heightMode != GVOT_NORMAL)
-                dfHeightResult[iPixel] = std::max(
-                    0.0, (dfZ - padfFirstLineVal[iPixel] + dfGroundLevel));
-
-            SetVisibility(iPixel, dfZ, dfTargetHeight, padfFirstLineVal,
-                          vResult, byVisibleVal, byInvisibleVal);
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "RasterIO error when reading DEM at position (%d,%d), "
+                     "size (%d,%d)",
+                     nXStart, iLine, nXSize, nLines);
+            return false;
         }
-        else
+        return true;
+    };
+
+    const auto WriteBlock =
+        [hTargetBand, heightMode, nXSize, nYStart](int iLine, int nLines,
+                                                   void *pBlock)
+    {
+        if (GDALRasterIO(hTargetBand, GF_Write, 0, iLine - nYStart, nXSize,
+                         nLines, pBlock, nXSize, nLines,
+                         heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte, 0,
+                         0))
         {
-            for (; iPixel >= 0; iPixel--)
-            {
-                pabyResult[iPixel] = byOutOfRangeVal;
-                if (heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = dfOutOfRangeVal;
-            }
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "RasterIO error when writing target raster at position "
+                     "(%d,%d), size (%d,%d)",
+                     0, iLine - nYStart, nXSize, nLines);
+            return false;
         }
-    }
-    /* process right direction */
-    for (int iPixel = nX + 2; iPixel < nXSize; iPixel++)
+        return true;
+    };
+
+    /* scan upwards and downwards */
+    int nLinesDone = 1;
+    int iUpLineEnd = nY;  // Exclusive end of the remaining lines above.
+    int iDownLine = nY + 1;
+    while (iUpLineEnd > nYStart || iDownLine < nYStop)
     {
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                            ? padfFirstLineVal[iPixel]
-                            : 0.0;
-        bool adjusted = AdjustHeightInRange(
-            adfGeoTransform.data(), iPixel - nX, 0, padfFirstLineVal[iPixel],
-            dfDistance2, dfCurvCoeff, dfSphereDiameter);
-        if (adjusted)
+        const int nUpLines = std::min(nBlockLines, iUpLineEnd - nYStart);
+        const int nDownLines = std::min(nBlockLines, nYStop - iDownLine);
+        const int iUpLine = iUpLineEnd - nUpLines;
+
+        if ((nUpLines > 0 &&
+             !ReadBlock(iUpLine, nUpLines, vUpDEMBlock.data())) ||
+            (nDownLines > 0 &&
+             !ReadBlock(iDownLine, nDownLines, vDownDEMBlock.data())))
         {
-            dfZ = CalcHeightLine(iPixel - nX, padfFirstLineVal[iPixel - 1],
-                                 dfZObserver);
+            return nullptr;
+        }
 
-            if (heightMode != GVOT_NORMAL)
-                dfHeightResult[iPixel] = std::max(
-                    0.0, (dfZ - padfFirstLineVal[iPixel] + dfGroundLevel));
+        std::vector<ViewshedQuadrant *> apsJobs;
+        for (int i = 0; i < 4; i++)
+        {
+            auto &sQuadrant = asQuadrants[i];
+            sQuadrant.iBlockLine = sQuadrant.bUpward ? iUpLine : iDownLine;
+            sQuadrant.nBlockLines = sQuadrant.bUpward ? nUpLines : nDownLines;
+            if (sQuadrant.nBlockLines > 0 && (i % 2) < nQuadrantsPerSide)
+                apsJobs.push_back(&sQuadrant);
+        }
 
-            SetVisibility(iPixel, dfZ, dfTargetHeight, padfFirstLineVal,
-                          vResult, byVisibleVal, byInvisibleVal);
+        if (poJobQueue && apsJobs.size() > 1)
+        {
+            for (size_t i = 1; i < apsJobs.size(); i++)
+                poJobQueue->SubmitJob(ProcessViewshedQuadrant, apsJobs[i]);
+            ProcessViewshedQuadrant(apsJobs[0]);
+            poJobQueue->WaitCompletion();
         }
         else
         {
-            for (; iPixel < nXSize; iPixel++)
-            {
-                pabyResult[iPixel] = byOutOfRangeVal;
-                if (heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = dfOutOfRangeVal;
-            }
+            for (auto *psQuadrant : apsJobs)
+                ProcessViewshedQuadrant(psQuadrant);
+        }
+
+        /* write result lines */
+        if (nUpLines > 0 &&
+            !WriteBlock(iUpLine, nUpLines,
+                        heightMode != GVOT_NORMAL
+                            ? static_cast<void *>(vUpHeightResultBlock.data())
+                            : static_cast<void *>(vUpResultBlock.data())))
+        {
+            return nullptr;
+        }
+        if (nDownLines > 0 &&
+            !WriteBlock(
+                iDownLine, nDownLines,
+                heightMode != GVOT_NORMAL
+                    ? static_cast<void *>(vDownHeightResultBlock.data())
+                    : static_cast<void *>(vDownResultBlock.data())))
+        {
+            return nullptr;
+        }
+
+        iUpLineEnd = iUpLine;
+        iDownLine += nDownLines;
+        nLinesDone += nUpLines + nDownLines;
+
+        if (!pfnProgress(nLinesDone / static_cast<double>(nYSize), "",
+                         pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return nullptr;
         }
     }
-    /* write result line */
 
-    if (GDALRasterIO(hTargetBand, GF_Write, 0, nY - nYStart, nXSize, 1,
-                     heightMode != GVOT_NORMAL
-                         ? static_cast<void *>(dfHeightResult)
-                         : static_cast<void *>(pabyResult),
-                     nXSize, 1,
-                     heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte, 0, 0))
+    if (!pfnProgress(1.0, "", pProgressArg))
     {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "RasterIO error when writing target raster at position "
-                 "(%d,%d), size (%d,%d)",
-                 0, nY - nYStart, nXSize, 1);
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
         return nullptr;
     }
 
-    /* scan upwards */
-    std::copy(vFirstLineVal.begin(), vFirstLineVal.end(), vLastLineVal.begin());
-    for (int iLine = nY - 1; iLine >= nYStart; iLine--)
+    return GDALDataset::FromHandle(poDstDS.release());
+}
+
+namespace
+{
+
+/** Observer of a cumulative viewshed, with its window in the DEM. */
+struct ViewshedObserver
+{
+    int nX = 0;
+    int nY = 0;
+    int nXStart = 0;
+    int nXStop = 0;
+    int nYStart = 0;
+    int nYStop = 0;
+    double dfHeight = 0.0;
+};
+
+/** State shared by all observers of a cumulative viewshed. */
+struct ViewshedCumulativeContext
+{
+    ViewshedParams sParams{};
+    const double *padfDEM = nullptr;  // DEM of the union of the windows.
+    int nXOff = 0;                    // Offset of the union in the DEM.
+    int nYOff = 0;
+    int nXSize = 0;  // Size of the union.
+    std::atomic<GUInt32> *panCount = nullptr;
+    std::atomic<bool> bStop{false};
+};
+
+struct ViewshedCumulativeJob
+{
+    ViewshedCumulativeContext *psContext = nullptr;
+    const ViewshedObserver *psObserver = nullptr;
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                    ProcessViewshedCumulativeJob()                    */
+/*                                                                      */
+/*      Compute the viewshed of one observer from the in-memory DEM     */
+/*      and increment the count of the pixels it can see.               */
+/************************************************************************/
+
+static void ProcessViewshedCumulativeJob(void *pData)
+{
+    const ViewshedCumulativeJob *psJob =
+        static_cast<ViewshedCumulativeJob *>(pData);
+    ViewshedCumulativeContext *psContext = psJob->psContext;
+    const ViewshedObserver &sObserver = *(psJob->psObserver);
+    if (psContext->bStop)
+        return;
+
+    const int nXSize = sObserver.nXStop - sObserver.nXStart;
+    const int nY = sObserver.nY;
+    const auto GetOffset = [psContext, &sObserver](int iLine)
+    {
+        return static_cast<size_t>(iLine - psContext->nYOff) *
+                   psContext->nXSize +
+               (sObserver.nXStart - psContext->nXOff);
+    };
+
+    std::vector<double> adfFirstLineVal;
+    std::vector<double> adfLastLineVal;
+    std::vector<double> adfThisLineVal;
+    std::vector<GByte> abyResult;
+    try
+    {
+        adfFirstLineVal.resize(nXSize);
+        adfLastLineVal.resize(nXSize);
+        adfThisLineVal.resize(nXSize);
+        abyResult.resize(nXSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate vectors for viewshed");
+        psContext->bStop = true;
+        return;
+    }
+
+    const auto Accumulate =
+        [psContext, GetOffset, nXSize, &abyResult](int iLine)
     {
-        if (GDALRasterIO(hBand, GF_Read, nXStart, iLine, nXSize, 1,
-                         padfThisLineVal, nXSize, 1, GDT_Float64, 0, 0))
+        std::atomic<GUInt32> *panCount =
+            psContext->panCount + GetOffset(iLine);
+        for (int i = 0; i < nXSize; i++)
         {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "RasterIO error when reading DEM at position (%d,%d), "
-                     "size (%d,%d)",
-                     nXStart, iLine, nXSize, 1);
-            return nullptr;
+            if (abyResult[i])
+                panCount[i].fetch_add(1, std::memory_order_relaxed);
         }
+    };
 
-        /* set up initial point on the scanline */
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                            ? padfThisLineVal[nX]
-                            : 0.0;
-        bool adjusted = AdjustHeightInRange(
-            adfGeoTransform.data(), 0, nY - iLine, padfThisLineVal[nX],
-            dfDistance2, dfCurvCoeff, dfSphereDiameter);
-        if (adjusted)
-        {
-            dfZ = CalcHeightLine(nY - iLine, padfLastLineVal[nX], dfZObserver);
+    ViewshedParams sParams(psContext->sParams);
+    sParams.nX = sObserver.nX - sObserver.nXStart;
+    memcpy(adfFirstLineVal.data(), psContext->padfDEM + GetOffset(nY),
+           nXSize * sizeof(double));
+    sParams.dfZObserver = sObserver.dfHeight + adfFirstLineVal[sParams.nX];
 
-            if (heightMode != GVOT_NORMAL)
-                dfHeightResult[nX] =
-                    std::max(0.0, (dfZ - padfThisLineVal[nX] + dfGroundLevel));
+    ProcessViewshedFirstLine(sParams, 0, nXSize - 1, adfFirstLineVal.data(),
+                             abyResult.data(), nullptr);
+    Accumulate(nY);
 
-            SetVisibility(nX, dfZ, dfTargetHeight, padfThisLineVal, vResult,
-                          byVisibleVal, byInvisibleVal);
-        }
-        else
+    for (int iDir = -1; iDir <= 1; iDir += 2)
+    {
+        adfLastLineVal = adfFirstLineVal;
+        for (int iLine = nY + iDir;
+             iLine >= sObserver.nYStart && iLine < sObserver.nYStop;
+             iLine += iDir)
         {
-            pabyResult[nX] = byOutOfRangeVal;
-            if (heightMode != GVOT_NORMAL)
-                dfHeightResult[nX] = dfOutOfRangeVal;
+            memcpy(adfThisLineVal.data(), psContext->padfDEM + GetOffset(iLine),
+                   nXSize * sizeof(double));
+            ProcessViewshedLine(sParams, std::abs(iLine - nY), 0, nXSize - 1,
+                                adfThisLineVal.data(), adfLastLineVal.data(),
+                                abyResult.data(), nullptr);
+            Accumulate(iLine);
+            std::swap(adfLastLineVal, adfThisLineVal);
         }
+    }
+}
 
-        /* process left direction */
-        for (int iPixel = nX - 1; iPixel >= 0; iPixel--)
-        {
-            dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                                ? padfThisLineVal[iPixel]
-                                : 0.0;
-            bool left_adjusted =
-                AdjustHeightInRange(adfGeoTransform.data(), nX - iPixel,
-                                    nY - iLine, padfThisLineVal[iPixel],
-                                    dfDistance2, dfCurvCoeff, dfSphereDiameter);
-            if (left_adjusted)
-            {
-                if (eMode != GVM_Edge)
-                    dfZ = CalcHeightDiagonal(
-                        nX - iPixel, nY - iLine, padfThisLineVal[iPixel + 1],
-                        padfLastLineVal[iPixel], dfZObserver);
-
-                if (eMode != GVM_Diagonal)
-                {
-                    double dfZ2 =
-                        nX - iPixel >= nY - iLine
-                            ? CalcHeightEdge(nY - iLine, nX - iPixel,
-                                             padfLastLineVal[iPixel + 1],
-                                             padfThisLineVal[iPixel + 1],
-                                             dfZObserver)
-                            : CalcHeightEdge(nX - iPixel, nY - iLine,
-                                             padfLastLineVal[iPixel + 1],
-                                             padfLastLineVal[iPixel],
-                                             dfZObserver);
-                    dfZ = CalcHeight(dfZ, dfZ2, eMode);
-                }
+/************************************************************************/
+/*                   GDALViewshedGenerateCumulative()                   */
+/************************************************************************/
 
-                if (heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = std::max(
-                        0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
+/**
+ * Create a cumulative viewshed from raster DEM for a set of observers.
+ *
+ * Each pixel of the output raster, of type UInt32, contains the number of
+ * observers from which it is visible, each viewshed being computed as with
+ * GDALViewshedGenerate() in GVOT_NORMAL mode.  The DEM covering the union of
+ * the areas of interest of the observers is read once in memory and shared by
+ * all observers, and no intermediate viewshed dataset is created.
+ *
+ * @param hBand The band to read the DEM data from.
+ *
+ * @param pszDriverName Driver name (GTiff if set to NULL)
+ *
+ * @param pszTargetRasterName The name of the target raster to be generated.
+ * Must not be NULL
+ *
+ * @param papszCreationOptions creation options.
+ *
+ * @param nObserverCount Number of observers.
+ *
+ * @param padfObserverX Array of nObserverCount observer X values (in SRS
+ * units)
+ *
+ * @param padfObserverY Array of nObserverCount observer Y values (in SRS
+ * units)
+ *
+ * @param padfObserverHeight Array of nObserverCount observer heights above the
+ * DEM surface.
+ *
+ * @param dfTargetHeight The height of the target above the DEM surface.
+ *
+ * @param dfCurvCoeff Coefficient to consider the effect of the curvature and
+ * refraction. See GDALViewshedGenerate().
+ *
+ * @param eMode The mode of the viewshed calculation. See
+ * GDALViewshedGenerate().
+ *
+ * @param dfMaxDistance maximum distance range to compute the viewshed of each
+ * observer. It is also used to clamp the extent of the output raster to the
+ * union of the areas of interest. If set to 0, then unlimited range is
+ * assumed.
+ *
+ * @param pfnProgress A GDALProgressFunc that may be used to report progress
+ * to the user, or to interrupt the algorithm.  May be NULL if not required.
+ *
+ * @param pProgressArg The callback data for the pfnProgress function.
+ *
+ * @param papszExtraOptions Extra options. Supported options are:
+ * <ul>
+ * <li>NUM_THREADS=N|ALL_CPUS: Number of worker threads, each one processing
+ * one observer at a time.  Defaults to the value of the GDAL_NUM_THREADS
+ * configuration option, or 1.</li>
+ * </ul>
+ *
+ * Observers outside of the DEM are ignored with a warning.
+ *
+ * @return not NULL output dataset on success (to be closed with GDALClose()) or
+ * NULL if an error occurs.
+ *
+ * @since GDAL 3.9
+ */
 
-                SetVisibility(iPixel, dfZ, dfTargetHeight, padfThisLineVal,
-                              vResult, byVisibleVal, byInvisibleVal);
-            }
-            else
-            {
-                for (; iPixel >= 0; iPixel--)
-                {
-                    pabyResult[iPixel] = byOutOfRangeVal;
-                    if (heightMode != GVOT_NORMAL)
-                        dfHeightResult[iPixel] = dfOutOfRangeVal;
-                }
-            }
-        }
-        /* process right direction */
-        for (int iPixel = nX + 1; iPixel < nXSize; iPixel++)
-        {
-            dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                                ? padfThisLineVal[iPixel]
-                                : 0.0;
-            bool right_adjusted =
-                AdjustHeightInRange(adfGeoTransform.data(), iPixel - nX,
-                                    nY - iLine, padfThisLineVal[iPixel],
-                                    dfDistance2, dfCurvCoeff, dfSphereDiameter);
-            if (right_adjusted)
-            {
-                if (eMode != GVM_Edge)
-                    dfZ = CalcHeightDiagonal(
-                        iPixel - nX, nY - iLine, padfThisLineVal[iPixel - 1],
-                        padfLastLineVal[iPixel], dfZObserver);
-
-                if (eMode != GVM_Diagonal)
-                {
-                    double dfZ2 =
-                        iPixel - nX >= nY - iLine
-                            ? CalcHeightEdge(nY - iLine, iPixel - nX,
-                                             padfLastLineVal[iPixel - 1],
-                                             padfThisLineVal[iPixel - 1],
-                                             dfZObserver)
-                            : CalcHeightEdge(iPixel - nX, nY - iLine,
-                                             padfLastLineVal[iPixel - 1],
-                                             padfLastLineVal[iPixel],
-                                             dfZObserver);
-                    dfZ = CalcHeight(dfZ, dfZ2, eMode);
-                }
+GDALDatasetH GDALViewshedGenerateCumulative(
+    GDALRasterBandH hBand, const char *pszDriverName,
+    const char *pszTargetRasterName, CSLConstList papszCreationOptions,
+    int nObserverCount, const double *padfObserverX,
+    const double *padfObserverY, const double *padfObserverHeight,
+    double dfTargetHeight, double dfCurvCoeff, GDALViewshedMode eMode,
+    double dfMaxDistance, GDALProgressFunc pfnProgress, void *pProgressArg,
+    CSLConstList papszExtraOptions)
 
-                if (heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = std::max(
-                        0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
+{
+    VALIDATE_POINTER1(hBand, "GDALViewshedGenerateCumulative", nullptr);
+    VALIDATE_POINTER1(pszTargetRasterName, "GDALViewshedGenerateCumulative",
+                      nullptr);
+    if (nObserverCount > 0)
+    {
+        VALIDATE_POINTER1(padfObserverX, "GDALViewshedGenerateCumulative",
+                          nullptr);
+        VALIDATE_POINTER1(padfObserverY, "GDALViewshedGenerateCumulative",
+                          nullptr);
+        VALIDATE_POINTER1(padfObserverHeight, "GDALViewshedGenerateCumulative",
+                          nullptr);
+    }
 
-                SetVisibility(iPixel, dfZ, dfTargetHeight, padfThisLineVal,
-                              vResult, byVisibleVal, byInvisibleVal);
-            }
-            else
-            {
-                for (; iPixel < nXSize; iPixel++)
-                {
-                    pabyResult[iPixel] = byOutOfRangeVal;
-                    if (heightMode != GVOT_NORMAL)
-                        dfHeightResult[iPixel] = dfOutOfRangeVal;
-                }
-            }
-        }
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
 
-        /* write result line */
-        if (GDALRasterIO(
-                hTargetBand, GF_Write, 0, iLine - nYStart, nXSize, 1,
-                heightMode != GVOT_NORMAL ? static_cast<void *>(dfHeightResult)
-                                          : static_cast<void *>(pabyResult),
-                nXSize, 1, heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte,
-                0, 0))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "RasterIO error when writing target raster at position "
-                     "(%d,%d), size (%d,%d)",
-                     0, iLine - nYStart, nXSize, 1);
-            return nullptr;
-        }
+    if (!pfnProgress(0.0, "", pProgressArg))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return nullptr;
+    }
 
-        std::swap(padfLastLineVal, padfThisLineVal);
+    /* set up geotransformation */
+    std::array<double, 6> adfGeoTransform{{0.0, 1.0, 0.0, 0.0, 0.0, 1.0}};
+    GDALDatasetH hSrcDS = GDALGetBandDataset(hBand);
+    if (hSrcDS != nullptr)
+        GDALGetGeoTransform(hSrcDS, adfGeoTransform.data());
 
-        if (!pfnProgress((nY - iLine) / static_cast<double>(nYSize), "",
-                         pProgressArg))
-        {
-            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-            return nullptr;
-        }
+    double adfInvGeoTransform[6];
+    if (!GDALInvGeoTransform(adfGeoTransform.data(), adfInvGeoTransform))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot invert geotransform");
+        return nullptr;
     }
-    /* scan downwards */
-    memcpy(padfLastLineVal, padfFirstLineVal, nXSize * sizeof(double));
-    for (int iLine = nY + 1; iLine < nYStop; iLine++)
+
+    /* compute the window of each observer, and their union */
+    std::vector<ViewshedObserver> asObservers;
+    int nXOff = std::numeric_limits<int>::max();
+    int nYOff = std::numeric_limits<int>::max();
+    int nXEnd = 0;
+    int nYEnd = 0;
+    for (int i = 0; i < nObserverCount; i++)
     {
-        if (GDALRasterIO(hBand, GF_Read, nXStart, iLine, nXStop - nXStart, 1,
-                         padfThisLineVal, nXStop - nXStart, 1, GDT_Float64, 0,
-                         0))
+        ViewshedObserver sObserver;
+        if (!GetViewshedWindow(adfInvGeoTransform,
+                               GDALGetRasterBandXSize(hBand),
+                               GDALGetRasterBandYSize(hBand), padfObserverX[i],
+                               padfObserverY[i], dfMaxDistance, sObserver.nX,
+                               sObserver.nY, sObserver.nXStart,
+                               sObserver.nXStop, sObserver.nYStart,
+                               sObserver.nYStop))
         {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "RasterIO error when reading DEM at position (%d,%d), "
-                     "size (%d,%d)",
-                     nXStart, iLine, nXStop - nXStart, 1);
-            return nullptr;
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "Observer %d (%f,%f) falls outside of the DEM area. "
+                     "Ignoring it",
+                     i, padfObserverX[i], padfObserverY[i]);
+            continue;
         }
+        sObserver.dfHeight = padfObserverHeight[i];
+        nXOff = std::min(nXOff, sObserver.nXStart);
+        nYOff = std::min(nYOff, sObserver.nYStart);
+        nXEnd = std::max(nXEnd, sObserver.nXStop);
+        nYEnd = std::max(nYEnd, sObserver.nYStop);
+        asObservers.push_back(sObserver);
+    }
+    if (asObservers.empty())
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "No observer location falls inside of the DEM area");
+        return nullptr;
+    }
 
-        /* set up initial point on the scanline */
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                            ? padfThisLineVal[nX]
-                            : 0.0;
-        bool adjusted = AdjustHeightInRange(
-            adfGeoTransform.data(), 0, iLine - nY, padfThisLineVal[nX],
-            dfDistance2, dfCurvCoeff, dfSphereDiameter);
-        if (adjusted)
-        {
-            dfZ = CalcHeightLine(iLine - nY, padfLastLineVal[nX], dfZObserver);
+    const int nXSize = nXEnd - nXOff;
+    const int nYSize = nYEnd - nYOff;
+    const size_t nPixels = static_cast<size_t>(nXSize) * nYSize;
 
-            if (heightMode != GVOT_NORMAL)
-                dfHeightResult[nX] =
-                    std::max(0.0, (dfZ - padfThisLineVal[nX] + dfGroundLevel));
+    /* read the DEM once, shared by all observers */
+    std::vector<double> adfDEM;
+    std::unique_ptr<std::atomic<GUInt32>[]> panCount;
+    try
+    {
+        adfDEM.resize(nPixels);
+        panCount.reset(new std::atomic<GUInt32>[nPixels]());
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate %d x %d buffers for cumulative viewshed",
+                 nXSize, nYSize);
+        return nullptr;
+    }
 
-            SetVisibility(nX, dfZ, dfTargetHeight, padfThisLineVal, vResult,
-                          byVisibleVal, byInvisibleVal);
-        }
-        else
-        {
-            pabyResult[nX] = byOutOfRangeVal;
-            if (heightMode != GVOT_NORMAL)
-                dfHeightResult[nX] = dfOutOfRangeVal;
-        }
+    if (GDALRasterIO(hBand, GF_Read, nXOff, nYOff, nXSize, nYSize,
+                     adfDEM.data(), nXSize, nYSize, GDT_Float64, 0, 0))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "RasterIO error when reading DEM at position (%d,%d), "
+                 "size (%d,%d)",
+                 nXOff, nYOff, nXSize, nYSize);
+        return nullptr;
+    }
 
-        /* process left direction */
-        for (int iPixel = nX - 1; iPixel >= 0; iPixel--)
-        {
-            dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                                ? padfThisLineVal[iPixel]
-                                : 0.0;
-            bool left_adjusted =
-                AdjustHeightInRange(adfGeoTransform.data(), nX - iPixel,
-                                    iLine - nY, padfThisLineVal[iPixel],
-                                    dfDistance2, dfCurvCoeff, dfSphereDiameter);
-            if (left_adjusted)
-            {
-                if (eMode != GVM_Edge)
-                    dfZ = CalcHeightDiagonal(
-                        nX - iPixel, iLine - nY, padfThisLineVal[iPixel + 1],
-                        padfLastLineVal[iPixel], dfZObserver);
-
-                if (eMode != GVM_Diagonal)
-                {
-                    double dfZ2 =
-                        nX - iPixel >= iLine - nY
-                            ? CalcHeightEdge(iLine - nY, nX - iPixel,
-                                             padfLastLineVal[iPixel + 1],
-                                             padfThisLineVal[iPixel + 1],
-                                             dfZObserver)
-                            : CalcHeightEdge(nX - iPixel, iLine - nY,
-                                             padfLastLineVal[iPixel + 1],
-                                             padfLastLineVal[iPixel],
-                                             dfZObserver);
-                    dfZ = CalcHeight(dfZ, dfZ2, eMode);
-                }
+    GDALDriverManager *hMgr = GetGDALDriverManager();
+    GDALDriver *hDriver =
+        hMgr->GetDriverByName(pszDriverName ? pszDriverName : "GTiff");
+    if (!hDriver)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot get driver");
+        return nullptr;
+    }
 
-                if (heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = std::max(
-                        0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
+    /* create output raster */
+    auto poDstDS = std::unique_ptr<GDALDataset>(
+        hDriver->Create(pszTargetRasterName, nXSize, nYSize, 1, GDT_UInt32,
+                        const_cast<char **>(papszCreationOptions)));
+    if (!poDstDS)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot create dataset for %s",
+                 pszTargetRasterName);
+        return nullptr;
+    }
+    /* copy srs */
+    if (hSrcDS)
+        poDstDS->SetSpatialRef(
+            GDALDataset::FromHandle(hSrcDS)->GetSpatialRef());
 
-                SetVisibility(iPixel, dfZ, dfTargetHeight, padfThisLineVal,
-                              vResult, byVisibleVal, byInvisibleVal);
-            }
-            else
-            {
-                for (; iPixel >= 0; iPixel--)
-                {
-                    pabyResult[iPixel] = byOutOfRangeVal;
-                    if (heightMode != GVOT_NORMAL)
-                        dfHeightResult[iPixel] = dfOutOfRangeVal;
-                }
-            }
-        }
-        /* process right direction */
-        for (int iPixel = nX + 1; iPixel < nXSize; iPixel++)
-        {
-            dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                                ? padfThisLineVal[iPixel]
-                                : 0.0;
-            bool right_adjusted =
-                AdjustHeightInRange(adfGeoTransform.data(), iPixel - nX,
-                                    iLine - nY, padfThisLineVal[iPixel],
-                                    dfDistance2, dfCurvCoeff, dfSphereDiameter);
-            if (right_adjusted)
-            {
-                if (eMode != GVM_Edge)
-                    dfZ = CalcHeightDiagonal(
-                        iPixel - nX, iLine - nY, padfThisLineVal[iPixel - 1],
-                        padfLastLineVal[iPixel], dfZObserver);
-
-                if (eMode != GVM_Diagonal)
-                {
-                    double dfZ2 =
-                        iPixel - nX >= iLine - nY
-                            ? CalcHeightEdge(iLine - nY, iPixel - nX,
-                                             padfLastLineVal[iPixel - 1],
-                                             padfThisLineVal[iPixel - 1],
-                                             dfZObserver)
-                            : CalcHeightEdge(iPixel - nX, iLine - nY,
-                                             padfLastLineVal[iPixel - 1],
-                                             padfLastLineVal[iPixel],
-                                             dfZObserver);
-                    dfZ = CalcHeight(dfZ, dfZ2, eMode);
-                }
+    std::array<double, 6> adfDstGeoTransform;
+    adfDstGeoTransform[0] = adfGeoTransform[0] + adfGeoTransform[1] * nXOff +
+                            adfGeoTransform[2] * nYOff;
+    adfDstGeoTransform[1] = adfGeoTransform[1];
+    adfDstGeoTransform[2] = adfGeoTransform[2];
+    adfDstGeoTransform[3] = adfGeoTransform[3] + adfGeoTransform[4] * nXOff +
+                            adfGeoTransform[5] * nYOff;
+    adfDstGeoTransform[4] = adfGeoTransform[4];
+    adfDstGeoTransform[5] = adfGeoTransform[5];
+    poDstDS->SetGeoTransform(adfDstGeoTransform.data());
 
-                if (heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = std::max(
-                        0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
+    auto hTargetBand = poDstDS->GetRasterBand(1);
+    if (hTargetBand == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot get band for %s",
+                 pszTargetRasterName);
+        return nullptr;
+    }
 
-                SetVisibility(iPixel, dfZ, dfTargetHeight, padfThisLineVal,
-                              vResult, byVisibleVal, byInvisibleVal);
-            }
-            else
+    ViewshedCumulativeContext sContext;
+    sContext.sParams.padfGeoTransform = adfGeoTransform.data();
+    sContext.sParams.dfTargetHeight = dfTargetHeight;
+    sContext.sParams.dfDistance2 = dfMaxDistance * dfMaxDistance;
+    sContext.sParams.dfCurvCoeff = dfCurvCoeff;
+    sContext.sParams.dfSphereDiameter =
+        GetViewshedSphereDiameter(poDstDS->GetSpatialRef());
+    sContext.sParams.eMode = eMode;
+    sContext.sParams.byVisibleVal = 1;
+    sContext.sParams.byInvisibleVal = 0;
+    sContext.sParams.byOutOfRangeVal = 0;
+    sContext.padfDEM = adfDEM.data();
+    sContext.nXOff = nXOff;
+    sContext.nYOff = nYOff;
+    sContext.nXSize = nXSize;
+    sContext.panCount = panCount.get();
+
+    std::vector<ViewshedCumulativeJob> asJobs(asObservers.size());
+    for (size_t i = 0; i < asObservers.size(); i++)
+    {
+        asJobs[i].psContext = &sContext;
+        asJobs[i].psObserver = &asObservers[i];
+    }
+    const int nJobs = static_cast<int>(asJobs.size());
+
+    const int nThreads = GetViewshedNumThreads(papszExtraOptions);
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 && nJobs > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+
+    bool bInterrupted = false;
+    if (poJobQueue)
+    {
+        for (auto &sJob : asJobs)
+            poJobQueue->SubmitJob(ProcessViewshedCumulativeJob, &sJob);
+
+        const int nStep = std::max(1, nJobs / 100);
+        for (int nRemaining = nJobs - nStep; !bInterrupted;
+             nRemaining -= nStep)
+        {
+            poJobQueue->WaitCompletion(std::max(0, nRemaining));
+            if (!pfnProgress(static_cast<double>(nJobs - std::max(
+                                                             0, nRemaining)) /
+                                 nJobs,
+                             "", pProgressArg))
             {
-                for (; iPixel < nXSize; iPixel++)
-                {
-                    pabyResult[iPixel] = byOutOfRangeVal;
-                    if (heightMode != GVOT_NORMAL)
-                        dfHeightResult[iPixel] = dfOutOfRangeVal;
-                }
+                bInterrupted = true;
+                sContext.bStop = true;
+                poJobQueue->WaitCompletion();
             }
+            if (nRemaining <= 0)
+                break;
         }
+    }
+    else
+    {
+        for (int i = 0; i < nJobs && !bInterrupted && !sContext.bStop; i++)
+        {
+            ProcessViewshedCumulativeJob(&asJobs[i]);
+            if (!pfnProgress(static_cast<double>(i + 1) / nJobs, "",
+                             pProgressArg))
+                bInterrupted = true;
+        }
+    }
+    if (bInterrupted)
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return nullptr;
+    }
+    if (sContext.bStop)
+        return nullptr;
 
-        /* write result line */
-        if (GDALRasterIO(
-                hTargetBand, GF_Write, 0, iLine - nYStart, nXSize, 1,
-                heightMode != GVOT_NORMAL ? static_cast<void *>(dfHeightResult)
-                                          : static_cast<void *>(pabyResult),
-                nXSize, 1, heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte,
-                0, 0))
+    /* write the counts */
+    std::vector<GUInt32> anLine(nXSize);
+    for (int iLine = 0; iLine < nYSize; iLine++)
+    {
+        const std::atomic<GUInt32> *panCountLine =
+            panCount.get() + static_cast<size_t>(iLine) * nXSize;
+        for (int i = 0; i < nXSize; i++)
+            anLine[i] = panCountLine[i].load(std::memory_order_relaxed);
+        if (GDALRasterIO(hTargetBand, GF_Write, 0, iLine, nXSize, 1,
+                         anLine.data(), nXSize, 1, GDT_UInt32, 0, 0))
         {
             CPLError(CE_Failure, CPLE_AppDefined,
                      "RasterIO error when writing target raster at position "
                      "(%d,%d), size (%d,%d)",
-                     0, iLine - nYStart, nXSize, 1);
-            return nullptr;
-        }
-
-        std::swap(padfLastLineVal, padfThisLineVal);
-
-        if (!pfnProgress((iLine - nYStart) / static_cast<double>(nYSize), "",
-                         pProgressArg))
-        {
-            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                     0, iLine, nXSize, 1);
             return nullptr;
         }
     }
 
-    if (!pfnProgress(1.0, "", pProgressArg))
-    {
-        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-        return nullptr;
-    }
-
     return GDALDataset::FromHandle(poDstDS.release());
 }
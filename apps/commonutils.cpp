@@ -28,14 +28,20 @@
 
 #include "commonutils.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 
 #include <string>
+#include <vector>
 
 #include "cpl_conv.h"
+#include "cpl_error_internal.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
+#include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 /* -------------------------------------------------------------------- */
 /*                         GetOutputDriversFor()                        */
@@ -171,3 +177,130 @@ int ArgIsNumeric(const char *pszArg)
 {
     return CPLGetValueType(pszArg) != CPL_VALUE_STRING;
 }
+
+/************************************************************************/
+/*                    GDALConcurrentDatasetOpener                       */
+/************************************************************************/
+
+struct GDALConcurrentDatasetOpener::Job
+{
+    GDALConcurrentDatasetOpener *poOpener = nullptr;
+    std::string osFilename{};
+    GDALDataset *poDS = nullptr;
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+    bool bDone = false;
+
+    Job() = default;
+    Job(const Job &) = delete;
+    Job &operator=(const Job &) = delete;
+
+    ~Job()
+    {
+        // Only set if not consumed by Next()
+        if (poDS)
+            GDALClose(GDALDataset::ToHandle(poDS));
+    }
+};
+
+GDALConcurrentDatasetOpener::GDALConcurrentDatasetOpener(
+    unsigned nOpenFlags, CSLConstList papszOpenOptions)
+    : m_nOpenFlags(nOpenFlags), m_aosOpenOptions(papszOpenOptions)
+{
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                                       ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+    if (nThreads > 1)
+    {
+        auto poThreadPool = GDALGetGlobalThreadPool(nThreads);
+        if (poThreadPool)
+        {
+            m_poJobQueue = poThreadPool->CreateJobQueue();
+            // Keep workers busy while the caller processes the datasets,
+            // without holding too many of them opened.
+            m_nMaxJobs = 2 * static_cast<size_t>(nThreads);
+        }
+    }
+}
+
+GDALConcurrentDatasetOpener::~GDALConcurrentDatasetOpener()
+{
+    if (m_poJobQueue)
+        m_poJobQueue->WaitCompletion();
+}
+
+/** Queue a dataset to be opened. */
+void GDALConcurrentDatasetOpener::Add(const std::string &osFilename)
+{
+    m_aosPendingFilenames.push_back(osFilename);
+    if (m_poJobQueue)
+        SubmitPendingJobs();
+}
+
+void GDALConcurrentDatasetOpener::OpenJob(void *pData)
+{
+    Job *psJob = static_cast<Job *>(pData);
+    auto poOpener = psJob->poOpener;
+    CPLInstallErrorHandlerAccumulator(psJob->aoErrors);
+    GDALDataset *poDS =
+        GDALDataset::Open(psJob->osFilename.c_str(), poOpener->m_nOpenFlags,
+                          nullptr, poOpener->m_aosOpenOptions.List(), nullptr);
+    CPLUninstallErrorHandlerAccumulator();
+
+    std::lock_guard<std::mutex> oLock(poOpener->m_oMutex);
+    psJob->poDS = poDS;
+    psJob->bDone = true;
+    poOpener->m_oCV.notify_one();
+}
+
+void GDALConcurrentDatasetOpener::SubmitPendingJobs()
+{
+    while (m_apoJobs.size() < m_nMaxJobs && !m_aosPendingFilenames.empty())
+    {
+        auto poJob = std::make_unique<Job>();
+        poJob->poOpener = this;
+        poJob->osFilename = std::move(m_aosPendingFilenames.front());
+        m_aosPendingFilenames.pop_front();
+        m_apoJobs.push_back(std::move(poJob));
+        if (!m_poJobQueue->SubmitJob(OpenJob, m_apoJobs.back().get()))
+            OpenJob(m_apoJobs.back().get());
+    }
+}
+
+/** Return the next dataset, in the order in which they have been added,
+ * or nullptr if it could not be opened.
+ *
+ * Errors emitted when opening it are emitted by this method. The returned
+ * dataset must be closed with GDALClose() (or deleted).
+ * Must not be called when IsEmpty() returns true.
+ */
+GDALDataset *GDALConcurrentDatasetOpener::Next()
+{
+    CPLAssert(!IsEmpty());
+    if (!m_poJobQueue)
+    {
+        const std::string osFilename = std::move(m_aosPendingFilenames.front());
+        m_aosPendingFilenames.pop_front();
+        return GDALDataset::Open(osFilename.c_str(), m_nOpenFlags, nullptr,
+                                 m_aosOpenOptions.List(), nullptr);
+    }
+
+    SubmitPendingJobs();
+    auto poJob = std::move(m_apoJobs.front());
+    m_apoJobs.pop_front();
+    GDALDataset *poDS;
+    {
+        std::unique_lock<std::mutex> oLock(m_oMutex);
+        while (!poJob->bDone)
+            m_oCV.wait(oLock);
+        poDS = poJob->poDS;
+        poJob->poDS = nullptr;
+    }
+    SubmitPendingJobs();
+
+    for (const auto &oError : poJob->aoErrors)
+    {
+        CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+    }
+    return poDS;
+}
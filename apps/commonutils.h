@@ -107,6 +107,63 @@ int ArgIsNumeric(const char *pszArg);
 constexpr int OVR_LEVEL_AUTO = -2;
 constexpr int OVR_LEVEL_NONE = -1;
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+class CPLJobQueue;
+class GDALDataset;
+
+/** Opens datasets in worker threads, ahead of their consumption by Next(),
+ * which returns them in the order in which they have been added.
+ *
+ * The number of worker threads is set by the GDAL_NUM_THREADS configuration
+ * option (default 1, in which case datasets are opened by Next() itself).
+ */
+class GDALConcurrentDatasetOpener
+{
+    struct Job;
+
+    const unsigned m_nOpenFlags;
+    const CPLStringList m_aosOpenOptions;
+    size_t m_nMaxJobs = 0;
+    std::deque<std::string> m_aosPendingFilenames{};
+    std::mutex m_oMutex{};
+    std::condition_variable m_oCV{};
+    // Must be declared before the job queue, so that running jobs are
+    // completed before they are destroyed.
+    std::deque<std::unique_ptr<Job>> m_apoJobs{};
+    std::unique_ptr<CPLJobQueue> m_poJobQueue{};
+
+    static void OpenJob(void *pData);
+    void SubmitPendingJobs();
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALConcurrentDatasetOpener)
+
+  public:
+    GDALConcurrentDatasetOpener(unsigned nOpenFlags,
+                                CSLConstList papszOpenOptions);
+    ~GDALConcurrentDatasetOpener();
+
+    void Add(const std::string &osFilename);
+
+    /** Return whether all added datasets have been returned by Next() */
+    bool IsEmpty() const
+    {
+        return m_aosPendingFilenames.empty() && m_apoJobs.empty();
+    }
+
+    /** Return whether datasets are opened by worker threads */
+    bool IsConcurrent() const
+    {
+        return m_poJobQueue != nullptr;
+    }
+
+    GDALDataset *Next();
+};
+
 #endif /* __cplusplus */
 
 #endif /* COMMONUTILS_H_INCLUDED */
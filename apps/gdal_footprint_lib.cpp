@@ -42,12 +42,15 @@
 #include "commonutils.h"
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_mem.h"
@@ -647,6 +650,187 @@ static double GetMinDistanceBetweenTwoPoints(const OGRGeometry *poGeom)
     return 0;
 }
 
+/************************************************************************/
+/*                    GDALFootprintProcessGeometry()                    */
+/************************************************************************/
+
+//! Applies the transformations and simplifications to a polygonized geometry.
+//! poGeom is reset if the geometry must be skipped.
+//! Returns false in case of error.
+static bool GDALFootprintProcessGeometry(std::unique_ptr<OGRGeometry> &poGeom,
+                                         OGRCoordinateTransformation *poCT_GT,
+                                         OGRCoordinateTransformation *poCT_SRS,
+                                         const GDALFootprintOptions *psOptions)
+{
+    if (poCT_GT)
+    {
+        if (poGeom->transform(poCT_GT) != OGRERR_NONE)
+            return false;
+    }
+
+    if (psOptions->dfDensifyDistance > 0)
+    {
+        OGREnvelope sEnvelope;
+        poGeom->getEnvelope(&sEnvelope);
+        // Some sanity check to avoid insane memory allocations
+        if (sEnvelope.MaxX - sEnvelope.MinX >
+                1e6 * psOptions->dfDensifyDistance ||
+            sEnvelope.MaxY - sEnvelope.MinY >
+                1e6 * psOptions->dfDensifyDistance)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Densification distance too small compared to "
+                     "geometry extent");
+            return false;
+        }
+        poGeom->segmentize(psOptions->dfDensifyDistance);
+    }
+
+    if (poCT_SRS)
+    {
+        if (poGeom->transform(poCT_SRS) != OGRERR_NONE)
+            return false;
+    }
+
+    if (psOptions->dfMinRingArea != 0)
+    {
+        if (poGeom->getGeometryType() == wkbMultiPolygon)
+        {
+            auto poMP = std::make_unique<OGRMultiPolygon>();
+            for (auto *poPoly : poGeom->toMultiPolygon())
+            {
+                auto poNewPoly = std::make_unique<OGRPolygon>();
+                for (auto *poRing : poPoly)
+                {
+                    if (poRing->get_Area() >= psOptions->dfMinRingArea)
+                    {
+                        poNewPoly->addRing(poRing);
+                    }
+                }
+                if (!poNewPoly->IsEmpty())
+                    poMP->addGeometryDirectly(poNewPoly.release());
+            }
+            poGeom = std::move(poMP);
+        }
+        else if (poGeom->getGeometryType() == wkbPolygon)
+        {
+            auto poNewPoly = std::make_unique<OGRPolygon>();
+            for (auto *poRing : poGeom->toPolygon())
+            {
+                if (poRing->get_Area() >= psOptions->dfMinRingArea)
+                {
+                    poNewPoly->addRing(poRing);
+                }
+            }
+            poGeom = std::move(poNewPoly);
+        }
+        if (poGeom->IsEmpty())
+        {
+            poGeom.reset();
+            return true;
+        }
+    }
+
+    if (psOptions->bConvexHull)
+    {
+        poGeom.reset(poGeom->ConvexHull());
+        if (!poGeom || poGeom->IsEmpty())
+        {
+            poGeom.reset();
+            return true;
+        }
+    }
+
+    if (psOptions->dfSimplifyTolerance != 0)
+    {
+        poGeom.reset(poGeom->Simplify(psOptions->dfSimplifyTolerance));
+        if (!poGeom || poGeom->IsEmpty())
+        {
+            poGeom.reset();
+            return true;
+        }
+    }
+
+    if (psOptions->nMaxPoints > 0 &&
+        CountPoints(poGeom.get()) >
+            static_cast<size_t>(psOptions->nMaxPoints))
+    {
+        OGREnvelope sEnvelope;
+        poGeom->getEnvelope(&sEnvelope);
+        double tolMin = GetMinDistanceBetweenTwoPoints(poGeom.get());
+        double tolMax = std::max(sEnvelope.MaxY - sEnvelope.MinY,
+                                 sEnvelope.MaxX - sEnvelope.MinX);
+        for (int i = 0; i < 20; ++i)
+        {
+            const double tol = (tolMin + tolMax) / 2;
+            std::unique_ptr<OGRGeometry> poSimplifiedGeom(
+                poGeom->Simplify(tol));
+            if (!poSimplifiedGeom || poSimplifiedGeom->IsEmpty())
+            {
+                tolMax = tol;
+                continue;
+            }
+            const auto nPoints = CountPoints(poSimplifiedGeom.get());
+            if (nPoints == static_cast<size_t>(psOptions->nMaxPoints))
+            {
+                tolMax = tol;
+                break;
+            }
+            else if (nPoints < static_cast<size_t>(psOptions->nMaxPoints))
+            {
+                tolMax = tol;
+            }
+            else
+            {
+                tolMin = tol;
+            }
+        }
+        poGeom.reset(poGeom->Simplify(tolMax));
+        if (!poGeom || poGeom->IsEmpty())
+        {
+            poGeom.reset();
+            return true;
+        }
+    }
+
+    if (!psOptions->bSplitPolys && poGeom->getGeometryType() == wkbPolygon)
+        poGeom.reset(OGRGeometryFactory::forceToMultiPolygon(poGeom.release()));
+
+    return true;
+}
+
+/************************************************************************/
+/*                       GDALFootprintProcessJob()                      */
+/************************************************************************/
+
+namespace
+{
+struct GDALFootprintJob
+{
+    std::vector<std::unique_ptr<OGRGeometry>> *papoGeoms = nullptr;
+    size_t iStart = 0;
+    size_t iEnd = 0;
+    std::unique_ptr<OGRCoordinateTransformation> poCT_GT{};
+    std::unique_ptr<OGRCoordinateTransformation> poCT_SRS{};
+    const GDALFootprintOptions *psOptions = nullptr;
+    bool bOK = true;
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+};
+}  // namespace
+
+static void GDALFootprintProcessJob(void *pData)
+{
+    GDALFootprintJob *psJob = static_cast<GDALFootprintJob *>(pData);
+    CPLInstallErrorHandlerAccumulator(psJob->aoErrors);
+    for (size_t i = psJob->iStart; psJob->bOK && i < psJob->iEnd; ++i)
+    {
+        psJob->bOK = GDALFootprintProcessGeometry(
+            (*psJob->papoGeoms)[i], psJob->poCT_GT.get(),
+            psJob->poCT_SRS.get(), psJob->psOptions);
+    }
+    CPLUninstallErrorHandlerAccumulator();
+}
+
 /************************************************************************/
 /*                       GDALFootprintProcess()                         */
 /************************************************************************/
@@ -888,140 +1072,79 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
         CPL_IGNORE_RET_VAL(poMemLayer->CreateFeature(poFeature.get()));
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Transform and simplify the geometries. This is done in          */
+    /*      parallel when several threads are used, in particular with      */
+    /*      -split_polys. Coordinate transformations are not thread-safe,   */
+    /*      so each job has its own copies.                                 */
+    /* -------------------------------------------------------------------- */
+    std::vector<std::unique_ptr<OGRGeometry>> apoGeoms;
     for (auto &&poFeature : poMemLayer.get())
     {
         auto poGeom = std::unique_ptr<OGRGeometry>(poFeature->StealGeometry());
         CPLAssert(poGeom);
-        if (poGeom->IsEmpty())
-            continue;
-
-        auto poDstFeature =
-            std::make_unique<OGRFeature>(poDstLayer->GetLayerDefn());
-        poDstFeature->SetFrom(poFeature.get());
-
+        if (!poGeom->IsEmpty())
+            apoGeoms.push_back(std::move(poGeom));
+    }
+    poMemLayer.reset();
+
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = std::max(
+        1, std::min(128, EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : atoi(pszNumThreads)));
+    const size_t nJobs = std::min(static_cast<size_t>(nThreads),
+                                  std::max<size_t>(1, apoGeoms.size()));
+    std::vector<GDALFootprintJob> asJobs(nJobs);
+    for (size_t i = 0; i < nJobs; ++i)
+    {
+        auto &sJob = asJobs[i];
+        sJob.papoGeoms = &apoGeoms;
+        sJob.iStart = apoGeoms.size() * i / nJobs;
+        sJob.iEnd = apoGeoms.size() * (i + 1) / nJobs;
+        sJob.psOptions = psOptions;
         if (poCT_GT)
-        {
-            if (poGeom->transform(poCT_GT.get()) != OGRERR_NONE)
-                return false;
-        }
-
-        if (psOptions->dfDensifyDistance > 0)
-        {
-            OGREnvelope sEnvelope;
-            poGeom->getEnvelope(&sEnvelope);
-            // Some sanity check to avoid insane memory allocations
-            if (sEnvelope.MaxX - sEnvelope.MinX >
-                    1e6 * psOptions->dfDensifyDistance ||
-                sEnvelope.MaxY - sEnvelope.MinY >
-                    1e6 * psOptions->dfDensifyDistance)
-            {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "Densification distance too small compared to "
-                         "geometry extent");
-                return false;
-            }
-            poGeom->segmentize(psOptions->dfDensifyDistance);
-        }
-
+            sJob.poCT_GT.reset(poCT_GT->Clone());
         if (poCT_SRS)
         {
-            if (poGeom->transform(poCT_SRS.get()) != OGRERR_NONE)
+            sJob.poCT_SRS.reset(poCT_SRS->Clone());
+            if (!sJob.poCT_SRS)
                 return false;
         }
-
-        if (psOptions->dfMinRingArea != 0)
-        {
-            if (poGeom->getGeometryType() == wkbMultiPolygon)
-            {
-                auto poMP = std::make_unique<OGRMultiPolygon>();
-                for (auto *poPoly : poGeom->toMultiPolygon())
-                {
-                    auto poNewPoly = std::make_unique<OGRPolygon>();
-                    for (auto *poRing : poPoly)
-                    {
-                        if (poRing->get_Area() >= psOptions->dfMinRingArea)
-                        {
-                            poNewPoly->addRing(poRing);
-                        }
-                    }
-                    if (!poNewPoly->IsEmpty())
-                        poMP->addGeometryDirectly(poNewPoly.release());
-                }
-                poGeom = std::move(poMP);
-            }
-            else if (poGeom->getGeometryType() == wkbPolygon)
-            {
-                auto poNewPoly = std::make_unique<OGRPolygon>();
-                for (auto *poRing : poGeom->toPolygon())
-                {
-                    if (poRing->get_Area() >= psOptions->dfMinRingArea)
-                    {
-                        poNewPoly->addRing(poRing);
-                    }
-                }
-                poGeom = std::move(poNewPoly);
-            }
-            if (poGeom->IsEmpty())
-                continue;
-        }
-
-        if (psOptions->bConvexHull)
-        {
-            poGeom.reset(poGeom->ConvexHull());
-            if (!poGeom || poGeom->IsEmpty())
-                continue;
-        }
-
-        if (psOptions->dfSimplifyTolerance != 0)
+    }
+    if (nJobs > 1)
+    {
+        auto poJobQueue = GDALGetGlobalThreadPool(nThreads)->CreateJobQueue();
+        for (auto &sJob : asJobs)
         {
-            poGeom.reset(poGeom->Simplify(psOptions->dfSimplifyTolerance));
-            if (!poGeom || poGeom->IsEmpty())
-                continue;
+            if (!poJobQueue->SubmitJob(GDALFootprintProcessJob, &sJob))
+                GDALFootprintProcessJob(&sJob);
         }
-
-        if (psOptions->nMaxPoints > 0 &&
-            CountPoints(poGeom.get()) >
-                static_cast<size_t>(psOptions->nMaxPoints))
+        poJobQueue->WaitCompletion();
+    }
+    else
+    {
+        GDALFootprintProcessJob(&asJobs[0]);
+    }
+    bool bOK = true;
+    for (const auto &sJob : asJobs)
+    {
+        for (const auto &oError : sJob.aoErrors)
         {
-            OGREnvelope sEnvelope;
-            poGeom->getEnvelope(&sEnvelope);
-            double tolMin = GetMinDistanceBetweenTwoPoints(poGeom.get());
-            double tolMax = std::max(sEnvelope.MaxY - sEnvelope.MinY,
-                                     sEnvelope.MaxX - sEnvelope.MinX);
-            for (int i = 0; i < 20; ++i)
-            {
-                const double tol = (tolMin + tolMax) / 2;
-                std::unique_ptr<OGRGeometry> poSimplifiedGeom(
-                    poGeom->Simplify(tol));
-                if (!poSimplifiedGeom || poSimplifiedGeom->IsEmpty())
-                {
-                    tolMax = tol;
-                    continue;
-                }
-                const auto nPoints = CountPoints(poSimplifiedGeom.get());
-                if (nPoints == static_cast<size_t>(psOptions->nMaxPoints))
-                {
-                    tolMax = tol;
-                    break;
-                }
-                else if (nPoints < static_cast<size_t>(psOptions->nMaxPoints))
-                {
-                    tolMax = tol;
-                }
-                else
-                {
-                    tolMin = tol;
-                }
-            }
-            poGeom.reset(poGeom->Simplify(tolMax));
-            if (!poGeom || poGeom->IsEmpty())
-                continue;
+            CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
         }
+        bOK = bOK && sJob.bOK;
+    }
+    if (!bOK)
+        return false;
 
-        if (!psOptions->bSplitPolys && poGeom->getGeometryType() == wkbPolygon)
-            poGeom.reset(
-                OGRGeometryFactory::forceToMultiPolygon(poGeom.release()));
+    for (auto &poGeom : apoGeoms)
+    {
+        if (!poGeom)
+            continue;
 
+        auto poDstFeature =
+            std::make_unique<OGRFeature>(poDstLayer->GetLayerDefn());
         poDstFeature->SetGeometryDirectly(poGeom.release());
 
         if (!psOptions->osLocationFieldName.empty())
@@ -0,0 +1,142 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Utilities
+ * Purpose:  Generate a pyramid of tiles following a tile matrix set.
+ * Authors:  GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_string.h"
+#include "gdal_version.h"
+#include "commonutils.h"
+#include "gdal_utils_priv.h"
+#include "gdal_priv.h"
+
+/************************************************************************/
+/*                               Usage()                                */
+/************************************************************************/
+
+static void Usage(bool bIsError, const char *pszErrorMsg = nullptr)
+
+{
+    fprintf(bIsError ? stderr : stdout,
+            "Usage: gdal_tiles [--help] [--help-general]\n"
+            "       [-z <minzoom>[-<maxzoom>]] [-tiling_scheme <name>]\n"
+            "       [-r near|bilinear|cubic|cubicspline|lanczos|average|rms|"
+            "mode]\n"
+            "       [-tf <format>] [-co <NAME>=<VALUE>]...\n"
+            "       [-convention xyz|tms] [-metatile <size>]\n"
+            "       [-num_threads <value>|ALL_CPUS] [-skip_existing]\n"
+            "       [-oo <NAME>=<VALUE>]... [-q]\n"
+            "       <src_filename> <dst_directory>\n");
+
+    if (pszErrorMsg != nullptr)
+        fprintf(stderr, "\nFAILURE: %s\n", pszErrorMsg);
+    exit(bIsError ? 1 : 0);
+}
+
+/************************************************************************/
+/*                                main()                                */
+/************************************************************************/
+
+MAIN_START(argc, argv)
+{
+    /* Check strict compilation and runtime library version as we use C++ API */
+    if (!GDAL_CHECK_VERSION(argv[0]))
+        exit(1);
+
+    EarlySetConfigOptions(argc, argv);
+
+    /* -------------------------------------------------------------------- */
+    /*      Generic arg processing.                                         */
+    /* -------------------------------------------------------------------- */
+    GDALAllRegister();
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        exit(-argc);
+
+    for (int i = 0; i < argc; i++)
+    {
+        if (EQUAL(argv[i], "--utility_version"))
+        {
+            printf("%s was compiled against GDAL %s and "
+                   "is running against GDAL %s\n",
+                   argv[0], GDAL_RELEASE_NAME, GDALVersionInfo("RELEASE_NAME"));
+            CSLDestroy(argv);
+            return 0;
+        }
+        else if (EQUAL(argv[i], "--help"))
+        {
+            Usage(false);
+        }
+    }
+
+    GDALTilesOptionsForBinary sOptionsForBinary;
+    // coverity[tainted_data]
+    GDALTilesOptions *psOptions =
+        GDALTilesOptionsNew(argv + 1, &sOptionsForBinary);
+    CSLDestroy(argv);
+
+    if (psOptions == nullptr)
+    {
+        Usage(true);
+    }
+
+    if (!(sOptionsForBinary.bQuiet))
+    {
+        GDALTilesOptionsSetProgress(psOptions, GDALTermProgress, nullptr);
+    }
+
+    if (sOptionsForBinary.osSource.empty())
+        Usage(true, "No input file specified.");
+
+    if (!sOptionsForBinary.bDestSpecified)
+        Usage(true, "No output directory specified.");
+
+    /* -------------------------------------------------------------------- */
+    /*      Open input file.                                                */
+    /* -------------------------------------------------------------------- */
+    GDALDatasetH hInDS = GDALOpenEx(sOptionsForBinary.osSource.c_str(),
+                                    GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR,
+                                    /*papszAllowedDrivers=*/nullptr,
+                                    sOptionsForBinary.aosOpenOptions.List(),
+                                    /*papszSiblingFiles=*/nullptr);
+
+    if (hInDS == nullptr)
+        exit(1);
+
+    int bUsageError = FALSE;
+    const CPLErr eErr = GDALTiles(sOptionsForBinary.osDest.c_str(), hInDS,
+                                  psOptions, &bUsageError);
+    if (bUsageError == TRUE)
+        Usage(true);
+    const int nRetCode = eErr == CE_None ? 0 : 1;
+
+    GDALClose(hInDS);
+    GDALTilesOptionsFree(psOptions);
+
+    GDALDestroyDriverManager();
+
+    return nRetCode;
+}
+MAIN_END
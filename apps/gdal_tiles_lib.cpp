@@ -0,0 +1,1320 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Utilities
+ * Purpose:  Generate a pyramid of tiles following a tile matrix set.
+ * Authors:  GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "gdal_utils.h"
+#include "gdal_utils_priv.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "cpl_conv.h"
+#include "cpl_error.h"
+#include "cpl_error_internal.h"
+#include "cpl_progress.h"
+#include "cpl_string.h"
+#include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal.h"
+#include "gdal_alg.h"
+#include "gdal_priv.h"
+#include "gdal_thread_pool.h"
+#include "ogr_spatialref.h"
+#include "tilematrixset.hpp"
+
+/************************************************************************/
+/*                            GDALTilesOptions                          */
+/************************************************************************/
+
+struct GDALTilesOptions
+{
+    /*! name or definition of the tile matrix set */
+    std::string osTilingScheme = "WebMercatorQuad";
+
+    /*! minimum and maximum zoom levels. -1 = automatic */
+    int nMinZoom = -1;
+    int nMaxZoom = -1;
+
+    /*! resampling method, for warping and for building the lower zoom
+     * levels */
+    std::string osResampling = "average";
+
+    /*! tile format. Use the short format name. */
+    std::string osFormat = "PNG";
+
+    /*! tile creation options */
+    CPLStringList aosCreationOptions{};
+
+    /*! whether to number tile rows from the bottom (TMS convention) */
+    bool bTMSConvention = false;
+
+    /*! width and height of a metatile, in tiles. Power of two. */
+    int nMetaTileSize = 8;
+
+    /*! number of threads. Empty = GDAL_NUM_THREADS configuration option */
+    std::string osNumThreads{};
+
+    /*! whether to skip tiles that already exist */
+    bool bSkipExisting = false;
+
+    /*! the progress function to use */
+    GDALProgressFunc pfnProgress = GDALDummyProgress;
+
+    /*! pointer to the progress data variable */
+    void *pProgressData = nullptr;
+};
+
+namespace
+{
+
+struct GDALTilesGenerator;
+
+/************************************************************************/
+/*                            GDALTilesJob                              */
+/************************************************************************/
+
+struct GDALTilesJob
+{
+    const GDALTilesGenerator *poGenerator = nullptr;
+    std::string osFilename{};
+    std::vector<GByte> abyTile{};
+    bool bOK = false;
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+    std::atomic<bool> bFinished{false};
+};
+
+/************************************************************************/
+/*                          GDALTilesGenerator                          */
+/************************************************************************/
+
+struct GDALTilesGenerator
+{
+    const GDALTilesOptions *psOptions = nullptr;
+
+    //! Source warped to the tile matrix set CRS, at the maximum zoom level.
+    //! Its last band is an alpha band.
+    GDALDataset *poWarpedDS = nullptr;
+
+    //! Number of bands of poWarpedDS (and of the in-memory tiles)
+    int nBands = 0;
+
+    const std::vector<gdal::TileMatrixSet::TileMatrix> *ptmList = nullptr;
+    int nTileWidth = 0;
+    int nTileHeight = 0;
+    int nMinZoom = 0;
+    int nMaxZoom = 0;
+
+    //! Zoom level whose tiles correspond to a whole metatile
+    int nMetaTileZoom = 0;
+
+    //! Range of the tiles at nMaxZoom covered by the raster (end excluded)
+    int nMinTileX = 0;
+    int nMinTileY = 0;
+    int nMaxTileX = 0;
+    int nMaxTileY = 0;
+
+    GDALDriver *poTileDriver = nullptr;
+    std::string osExtension{};
+    std::string osDest{};
+
+    //! Indices, in the in-memory tiles, of the bands of the written tiles
+    std::vector<int> anOutBands{};
+    bool bOutAlpha = false;
+
+    std::set<std::string> oSetCreatedDirs{};
+
+    int nThreads = 1;
+    std::unique_ptr<CPLJobQueue> poJobQueue{};
+    std::list<std::unique_ptr<GDALTilesJob>> apoJobs{};
+    bool bError = false;
+
+    double dfTilesDone = 0;
+    double dfTilesTotal = 1;
+
+    ~GDALTilesGenerator();
+
+    void GetTileRange(int nZ, int &nMinX, int &nMinY, int &nMaxX,
+                      int &nMaxY) const;
+    bool ProcessTile(int nZ, int nX, int nY, std::vector<GByte> &abyTile,
+                     bool &bEmpty);
+    bool ProcessMetaTile(int nX, int nY, std::vector<GByte> &abyTile,
+                         bool &bEmpty);
+    bool Downsample(const std::vector<GByte> &abySrc, int nSrcWidth,
+                    int nSrcHeight, std::vector<GByte> &abyDst) const;
+    bool EmitTile(int nZ, int nX, int nY, const GByte *pabySrc,
+                  int nSrcLineWidth);
+    bool WriteTile(const GDALTilesJob &sJob) const;
+    void FinalizeJobs(size_t nMaxRemainingJobs);
+};
+
+/************************************************************************/
+/*                        ~GDALTilesGenerator()                         */
+/************************************************************************/
+
+GDALTilesGenerator::~GDALTilesGenerator()
+{
+    if (poJobQueue)
+        poJobQueue->WaitCompletion();
+}
+
+/************************************************************************/
+/*                            GetTileRange()                            */
+/************************************************************************/
+
+//! Range of the tiles at zoom level nZ covered by the raster (end excluded)
+void GDALTilesGenerator::GetTileRange(int nZ, int &nMinX, int &nMinY,
+                                      int &nMaxX, int &nMaxY) const
+{
+    const int nShift = nMaxZoom - nZ;
+    nMinX = nMinTileX >> nShift;
+    nMinY = nMinTileY >> nShift;
+    nMaxX = ((nMaxTileX - 1) >> nShift) + 1;
+    nMaxY = ((nMaxTileY - 1) >> nShift) + 1;
+}
+
+/************************************************************************/
+/*                           IsTransparent()                            */
+/************************************************************************/
+
+static bool IsTransparent(const GByte *pabySrc, int nBands, int nWidth,
+                          int nHeight, int nSrcLineWidth)
+{
+    for (int iY = 0; iY < nHeight; ++iY)
+    {
+        const GByte *pabyLine = pabySrc +
+                                static_cast<size_t>(iY) * nSrcLineWidth *
+                                    nBands +
+                                nBands - 1;
+        for (int iX = 0; iX < nWidth; ++iX)
+        {
+            if (pabyLine[static_cast<size_t>(iX) * nBands] != 0)
+                return false;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                             ProcessTile()                            */
+/************************************************************************/
+
+//! Builds the tile (nZ, nX, nY), pixel-interleaved with nBands bands, and
+//! emits it and all the tiles of higher zoom levels it covers.
+bool GDALTilesGenerator::ProcessTile(int nZ, int nX, int nY,
+                                     std::vector<GByte> &abyTile,
+                                     bool &bEmpty)
+{
+    if (nZ == nMetaTileZoom)
+        return ProcessMetaTile(nX, nY, abyTile, bEmpty);
+
+    int nChildMinX, nChildMinY, nChildMaxX, nChildMaxY;
+    GetTileRange(nZ + 1, nChildMinX, nChildMinY, nChildMaxX, nChildMaxY);
+
+    // Assemble the (up to) four children in a canvas of twice the tile size
+    const int nCanvasWidth = 2 * nTileWidth;
+    const int nCanvasHeight = 2 * nTileHeight;
+    std::vector<GByte> abyCanvas;
+    std::vector<GByte> abyChild;
+    bEmpty = true;
+    for (int iY = 0; iY < 2; ++iY)
+    {
+        for (int iX = 0; iX < 2; ++iX)
+        {
+            const int nChildX = 2 * nX + iX;
+            const int nChildY = 2 * nY + iY;
+            if (nChildX < nChildMinX || nChildX >= nChildMaxX ||
+                nChildY < nChildMinY || nChildY >= nChildMaxY)
+            {
+                continue;
+            }
+            bool bChildEmpty = true;
+            if (!ProcessTile(nZ + 1, nChildX, nChildY, abyChild, bChildEmpty))
+                return false;
+            if (bChildEmpty)
+                continue;
+            if (bEmpty)
+            {
+                bEmpty = false;
+                abyCanvas.resize(static_cast<size_t>(nCanvasWidth) *
+                                 nCanvasHeight * nBands);
+            }
+            const size_t nChildLineSize =
+                static_cast<size_t>(nTileWidth) * nBands;
+            for (int iLine = 0; iLine < nTileHeight; ++iLine)
+            {
+                memcpy(abyCanvas.data() +
+                           (static_cast<size_t>(iY) * nTileHeight + iLine) *
+                               nCanvasWidth * nBands +
+                           iX * nChildLineSize,
+                       abyChild.data() + iLine * nChildLineSize,
+                       nChildLineSize);
+            }
+        }
+    }
+    if (bEmpty)
+        return true;
+
+    if (!Downsample(abyCanvas, nCanvasWidth, nCanvasHeight, abyTile))
+        return false;
+    if (nZ >= nMinZoom)
+        return EmitTile(nZ, nX, nY, abyTile.data(), nTileWidth);
+    return true;
+}
+
+/************************************************************************/
+/*                           ProcessMetaTile()                          */
+/************************************************************************/
+
+//! Reads the metatile corresponding to the tile (nMetaTileZoom, nX, nY),
+//! emits all its tiles from nMaxZoom to nMetaTileZoom, and returns the
+//! tile at nMetaTileZoom.
+bool GDALTilesGenerator::ProcessMetaTile(int nX, int nY,
+                                         std::vector<GByte> &abyTile,
+                                         bool &bEmpty)
+{
+    const int nLevels = nMaxZoom - nMetaTileZoom;
+    int nCanvasWidth = nTileWidth << nLevels;
+    int nCanvasHeight = nTileHeight << nLevels;
+
+    // Tiles at nMaxZoom covered by the metatile and the raster
+    const int nFirstTileX = std::max(nX << nLevels, nMinTileX);
+    const int nFirstTileY = std::max(nY << nLevels, nMinTileY);
+    const int nLastTileX = std::min((nX + 1) << nLevels, nMaxTileX);
+    const int nLastTileY = std::min((nY + 1) << nLevels, nMaxTileY);
+
+    std::vector<GByte> abyCanvas;
+    try
+    {
+        abyCanvas.resize(static_cast<size_t>(nCanvasWidth) * nCanvasHeight *
+                         nBands);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "GDALTiles(): out of memory");
+        return false;
+    }
+
+    // Warp and read the whole metatile at once
+    const size_t nCanvasOffset =
+        (static_cast<size_t>(nFirstTileY - (nY << nLevels)) * nTileHeight *
+             nCanvasWidth +
+         static_cast<size_t>(nFirstTileX - (nX << nLevels)) * nTileWidth) *
+        nBands;
+    if (poWarpedDS->RasterIO(
+            GF_Read, (nFirstTileX - nMinTileX) * nTileWidth,
+            (nFirstTileY - nMinTileY) * nTileHeight,
+            (nLastTileX - nFirstTileX) * nTileWidth,
+            (nLastTileY - nFirstTileY) * nTileHeight,
+            abyCanvas.data() + nCanvasOffset,
+            (nLastTileX - nFirstTileX) * nTileWidth,
+            (nLastTileY - nFirstTileY) * nTileHeight, GDT_Byte, nBands,
+            nullptr, nBands, static_cast<GSpacing>(nCanvasWidth) * nBands, 1,
+            nullptr) != CE_None)
+    {
+        return false;
+    }
+
+    for (int nZ = nMaxZoom;; --nZ)
+    {
+        const int nShift = nMaxZoom - nZ;
+        const int nZFirstTileX = nFirstTileX >> nShift;
+        const int nZFirstTileY = nFirstTileY >> nShift;
+        const int nZLastTileX = ((nLastTileX - 1) >> nShift) + 1;
+        const int nZLastTileY = ((nLastTileY - 1) >> nShift) + 1;
+        const int nZOriX = nX << (nZ - nMetaTileZoom);
+        const int nZOriY = nY << (nZ - nMetaTileZoom);
+        if (nZ >= nMinZoom)
+        {
+            for (int nTileY = nZFirstTileY; nTileY < nZLastTileY; ++nTileY)
+            {
+                for (int nTileX = nZFirstTileX; nTileX < nZLastTileX;
+                     ++nTileX)
+                {
+                    const GByte *pabySrc =
+                        abyCanvas.data() +
+                        (static_cast<size_t>(nTileY - nZOriY) * nTileHeight *
+                             nCanvasWidth +
+                         static_cast<size_t>(nTileX - nZOriX) * nTileWidth) *
+                            nBands;
+                    if (!EmitTile(nZ, nTileX, nTileY, pabySrc, nCanvasWidth))
+                        return false;
+                }
+            }
+        }
+        if (nZ == nMetaTileZoom)
+            break;
+
+        std::vector<GByte> abyDownsampled;
+        if (!Downsample(abyCanvas, nCanvasWidth, nCanvasHeight,
+                        abyDownsampled))
+        {
+            return false;
+        }
+        abyCanvas = std::move(abyDownsampled);
+        nCanvasWidth /= 2;
+        nCanvasHeight /= 2;
+    }
+
+    bEmpty = IsTransparent(abyCanvas.data(), nBands, nTileWidth, nTileHeight,
+                           nTileWidth);
+    abyTile = std::move(abyCanvas);
+
+    dfTilesDone += static_cast<double>(nLastTileX - nFirstTileX) *
+                   (nLastTileY - nFirstTileY);
+    if (!psOptions->pfnProgress(dfTilesDone / dfTilesTotal, "",
+                                psOptions->pProgressData))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                             Downsample()                             */
+/************************************************************************/
+
+//! Downsamples by a factor of 2 a pixel-interleaved buffer, taking into
+//! account its alpha band.
+bool GDALTilesGenerator::Downsample(const std::vector<GByte> &abySrc,
+                                    int nSrcWidth, int nSrcHeight,
+                                    std::vector<GByte> &abyDst) const
+{
+    auto poMEMDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (!poMEMDriver)
+        return false;
+    std::unique_ptr<GDALDataset> poMEMDS(poMEMDriver->Create(
+        "", nSrcWidth, nSrcHeight, nBands, GDT_Byte, nullptr));
+    if (!poMEMDS)
+        return false;
+    poMEMDS->GetRasterBand(nBands)->SetColorInterpretation(GCI_AlphaBand);
+    const int nDstWidth = nSrcWidth / 2;
+    const int nDstHeight = nSrcHeight / 2;
+    abyDst.resize(static_cast<size_t>(nDstWidth) * nDstHeight * nBands);
+
+    GDALRasterIOExtraArg sExtraArg;
+    INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+    sExtraArg.eResampleAlg =
+        GDALRasterIOGetResampleAlg(psOptions->osResampling.c_str());
+    // The const_cast is safe: the buffer is only read in GF_Write mode
+    return poMEMDS->RasterIO(GF_Write, 0, 0, nSrcWidth, nSrcHeight,
+                             const_cast<GByte *>(abySrc.data()), nSrcWidth,
+                             nSrcHeight, GDT_Byte, nBands, nullptr, nBands,
+                             static_cast<GSpacing>(nSrcWidth) * nBands, 1,
+                             nullptr) == CE_None &&
+           poMEMDS->RasterIO(GF_Read, 0, 0, nSrcWidth, nSrcHeight,
+                             abyDst.data(), nDstWidth, nDstHeight, GDT_Byte,
+                             nBands, nullptr, nBands,
+                             static_cast<GSpacing>(nDstWidth) * nBands, 1,
+                             &sExtraArg) == CE_None;
+}
+
+/************************************************************************/
+/*                              EmitTile()                              */
+/************************************************************************/
+
+//! Queues the writing of a tile, unless it is fully transparent.
+bool GDALTilesGenerator::EmitTile(int nZ, int nX, int nY,
+                                  const GByte *pabySrc, int nSrcLineWidth)
+{
+    if (IsTransparent(pabySrc, nBands, nTileWidth, nTileHeight,
+                      nSrcLineWidth))
+    {
+        return true;
+    }
+
+    const int nRow =
+        psOptions->bTMSConvention ? (*ptmList)[nZ].mMatrixHeight - 1 - nY : nY;
+    const std::string osZDir =
+        CPLFormFilename(osDest.c_str(), CPLSPrintf("%d", nZ), nullptr);
+    const std::string osXDir =
+        CPLFormFilename(osZDir.c_str(), CPLSPrintf("%d", nX), nullptr);
+    auto poJob = std::make_unique<GDALTilesJob>();
+    poJob->poGenerator = this;
+    poJob->osFilename = CPLFormFilename(
+        osXDir.c_str(), CPLSPrintf("%d", nRow), osExtension.c_str());
+
+    VSIStatBufL sStat;
+    if (psOptions->bSkipExisting &&
+        VSIStatL(poJob->osFilename.c_str(), &sStat) == 0)
+    {
+        return true;
+    }
+
+    if (oSetCreatedDirs.find(osXDir) == oSetCreatedDirs.end())
+    {
+        if (VSIStatL(osXDir.c_str(), &sStat) != 0 &&
+            VSIMkdirRecursive(osXDir.c_str(), 0755) != 0)
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot create directory %s",
+                     osXDir.c_str());
+            return false;
+        }
+        oSetCreatedDirs.insert(osXDir);
+    }
+
+    const size_t nLineSize = static_cast<size_t>(nTileWidth) * nBands;
+    poJob->abyTile.resize(nLineSize * nTileHeight);
+    for (int iLine = 0; iLine < nTileHeight; ++iLine)
+    {
+        memcpy(poJob->abyTile.data() + iLine * nLineSize,
+               pabySrc + static_cast<size_t>(iLine) * nSrcLineWidth * nBands,
+               nLineSize);
+    }
+
+    if (!poJobQueue)
+    {
+        return WriteTile(*poJob);
+    }
+
+    const auto JobFunc = [](void *pJobData)
+    {
+        GDALTilesJob *psJob = static_cast<GDALTilesJob *>(pJobData);
+        CPLInstallErrorHandlerAccumulator(psJob->aoErrors);
+        psJob->bOK = psJob->poGenerator->WriteTile(*psJob);
+        CPLUninstallErrorHandlerAccumulator();
+        psJob->bFinished = true;
+    };
+    if (!poJobQueue->SubmitJob(JobFunc, poJob.get()))
+        return false;
+    apoJobs.push_back(std::move(poJob));
+    FinalizeJobs(4 * static_cast<size_t>(nThreads));
+    return !bError;
+}
+
+/************************************************************************/
+/*                             WriteTile()                              */
+/************************************************************************/
+
+//! Encodes and writes a tile. Called from worker threads.
+bool GDALTilesGenerator::WriteTile(const GDALTilesJob &sJob) const
+{
+    auto poMEMDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (!poMEMDriver)
+        return false;
+    const int nOutBands = static_cast<int>(anOutBands.size());
+    std::unique_ptr<GDALDataset> poMEMDS(poMEMDriver->Create(
+        "", nTileWidth, nTileHeight, nOutBands, GDT_Byte, nullptr));
+    if (!poMEMDS)
+        return false;
+    for (int i = 0; i < nOutBands; ++i)
+    {
+        auto poBand = poMEMDS->GetRasterBand(i + 1);
+        // The const_cast is safe: the buffer is only read in GF_Write mode
+        if (poBand->RasterIO(
+                GF_Write, 0, 0, nTileWidth, nTileHeight,
+                const_cast<GByte *>(sJob.abyTile.data()) + anOutBands[i],
+                nTileWidth, nTileHeight, GDT_Byte, nBands,
+                static_cast<GSpacing>(nTileWidth) * nBands,
+                nullptr) != CE_None)
+        {
+            return false;
+        }
+    }
+    if (bOutAlpha)
+        poMEMDS->GetRasterBand(nOutBands)->SetColorInterpretation(
+            GCI_AlphaBand);
+
+    std::unique_ptr<GDALDataset> poTileDS(poTileDriver->CreateCopy(
+        sJob.osFilename.c_str(), poMEMDS.get(), FALSE,
+        psOptions->aosCreationOptions.List(), nullptr, nullptr));
+    if (!poTileDS)
+        return false;
+    return poTileDS->Close() == CE_None;
+}
+
+/************************************************************************/
+/*                            FinalizeJobs()                            */
+/************************************************************************/
+
+//! Waits for the oldest jobs to be completed until at most
+//! nMaxRemainingJobs jobs are left, and re-emits their errors.
+void GDALTilesGenerator::FinalizeJobs(size_t nMaxRemainingJobs)
+{
+    while (!apoJobs.empty())
+    {
+        if (!apoJobs.front()->bFinished)
+        {
+            if (apoJobs.size() <= nMaxRemainingJobs)
+                break;
+            const int nRunningJobs = static_cast<int>(std::count_if(
+                apoJobs.begin(), apoJobs.end(),
+                [](const std::unique_ptr<GDALTilesJob> &poJob)
+                { return !poJob->bFinished; }));
+            poJobQueue->WaitCompletion(nRunningJobs - 1);
+            continue;
+        }
+        const auto &poJob = apoJobs.front();
+        for (const auto &oError : poJob->aoErrors)
+        {
+            CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+        }
+        if (!poJob->bOK)
+            bError = true;
+        apoJobs.pop_front();
+    }
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                        GDALTilesGetWarpedDS()                        */
+/************************************************************************/
+
+//! Selects the zoom levels, computes the tile range at the maximum zoom
+//! level, and returns the source warped to it, with an alpha band.
+//! poClippedDS receives an intermediate dataset that must be kept open as
+//! long as the warped dataset.
+static std::unique_ptr<GDALDataset>
+GDALTilesGetWarpedDS(GDALDataset *poSrcDS, const gdal::TileMatrixSet &oTMS,
+                     const GDALTilesOptions *psOptions, int nThreads,
+                     GDALTilesGenerator &oGenerator,
+                     std::unique_ptr<GDALDataset> &poClippedDS)
+{
+    const auto &tmList = oTMS.tileMatrixList();
+
+    OGRSpatialReference oTargetSRS;
+    if (oTargetSRS.SetFromUserInput(
+            oTMS.crs().c_str(),
+            OGRSpatialReference::SET_FROM_USER_INPUT_LIMITATIONS_get()) !=
+        OGRERR_NONE)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot parse CRS of tile matrix set: %s", oTMS.crs().c_str());
+        return nullptr;
+    }
+    const char *pszAuthCode = oTargetSRS.GetAuthorityCode(nullptr);
+    const int nEPSGCode = pszAuthCode ? atoi(pszAuthCode) : 0;
+    const bool bInvertAxis = oTargetSRS.EPSGTreatsAsLatLong() != FALSE ||
+                             oTargetSRS.EPSGTreatsAsNorthingEasting() != FALSE;
+
+    // Clip geographic rasters to the latitudes that can be represented
+    // in EPSG:3857, as GDALSuggestedWarpOutput2() fails otherwise.
+    double adfSrcGeoTransform[6];
+    const auto poSrcSRS = poSrcDS->GetSpatialRef();
+    if (nEPSGCode == 3857 && poSrcSRS && poSrcSRS->IsGeographic() &&
+        !poSrcSRS->IsDerivedGeographic() &&
+        poSrcDS->GetGeoTransform(adfSrcGeoTransform) == CE_None &&
+        adfSrcGeoTransform[2] == 0 && adfSrcGeoTransform[4] == 0 &&
+        adfSrcGeoTransform[5] < 0)
+    {
+        constexpr double MAX_LAT = 85.0511287798066;
+        const double dfMaxLat = adfSrcGeoTransform[3];
+        const double dfMinLat =
+            adfSrcGeoTransform[3] +
+            poSrcDS->GetRasterYSize() * adfSrcGeoTransform[5];
+        if (dfMaxLat > MAX_LAT || dfMinLat < -MAX_LAT)
+        {
+            CPLStringList aosOptions;
+            aosOptions.AddString("-of");
+            aosOptions.AddString("VRT");
+            aosOptions.AddString("-projwin");
+            aosOptions.AddString(CPLSPrintf("%.17g", adfSrcGeoTransform[0]));
+            aosOptions.AddString(
+                CPLSPrintf("%.17g", std::min(dfMaxLat, MAX_LAT)));
+            aosOptions.AddString(CPLSPrintf(
+                "%.17g", adfSrcGeoTransform[0] + poSrcDS->GetRasterXSize() *
+                                                     adfSrcGeoTransform[1]));
+            aosOptions.AddString(
+                CPLSPrintf("%.17g", std::max(dfMinLat, -MAX_LAT)));
+            auto psOptionsTranslate =
+                GDALTranslateOptionsNew(aosOptions.List(), nullptr);
+            poClippedDS.reset(GDALDataset::FromHandle(
+                GDALTranslate("", GDALDataset::ToHandle(poSrcDS),
+                              psOptionsTranslate, nullptr)));
+            GDALTranslateOptionsFree(psOptionsTranslate);
+            if (!poClippedDS)
+                return nullptr;
+            poSrcDS = poClippedDS.get();
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Compute the extent and resolution of the source in the CRS of   */
+    /*      the tile matrix set.                                            */
+    /* -------------------------------------------------------------------- */
+    CPLStringList aosTO;
+    aosTO.SetNameValue("DST_SRS", oTMS.crs().c_str());
+    void *hTransformArg =
+        GDALCreateGenImgProjTransformer2(poSrcDS, nullptr, aosTO.List());
+    if (hTransformArg == nullptr)
+        return nullptr;
+    double adfGeoTransform[6];
+    double adfExtent[4];
+    int nXSize = 0;
+    int nYSize = 0;
+    const CPLErr eErr = GDALSuggestedWarpOutput2(
+        poSrcDS, GDALGenImgProjTransform, hTransformArg, adfGeoTransform,
+        &nXSize, &nYSize, adfExtent, 0);
+    GDALDestroyGenImgProjTransformer(hTransformArg);
+    if (eErr != CE_None)
+        return nullptr;
+    const double dfMinX = adfExtent[0];
+    const double dfMinY = adfExtent[1];
+    const double dfMaxX = adfExtent[2];
+    const double dfMaxY = adfExtent[3];
+
+    /* -------------------------------------------------------------------- */
+    /*      Select the zoom levels.                                         */
+    /* -------------------------------------------------------------------- */
+    const int nLevels = static_cast<int>(tmList.size());
+    int nMaxZoom = psOptions->nMaxZoom;
+    if (nMaxZoom < 0)
+    {
+        // Zoom level whose resolution is the closest to the one of the source
+        const double dfComputedRes = adfGeoTransform[1];
+        nMaxZoom = 0;
+        while (nMaxZoom + 1 < nLevels &&
+               tmList[nMaxZoom + 1].mResX >= dfComputedRes)
+        {
+            ++nMaxZoom;
+        }
+        if (nMaxZoom + 1 < nLevels && tmList[nMaxZoom].mResX > dfComputedRes &&
+            tmList[nMaxZoom].mResX / dfComputedRes >
+                dfComputedRes / tmList[nMaxZoom + 1].mResX)
+        {
+            ++nMaxZoom;
+        }
+    }
+    else if (nMaxZoom >= nLevels)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Invalid zoom level: should be in [0,%d]", nLevels - 1);
+        return nullptr;
+    }
+
+    int nMinZoom = psOptions->nMinZoom;
+    if (nMinZoom < 0)
+    {
+        // Highest zoom level at which the raster fits in a single tile
+        const double dfMaxExtent = std::max(dfMaxX - dfMinX, dfMaxY - dfMinY);
+        nMinZoom = 0;
+        while (nMinZoom < nMaxZoom && tmList[nMinZoom + 1].mResX *
+                                              tmList[0].mTileWidth >=
+                                          dfMaxExtent)
+        {
+            ++nMinZoom;
+        }
+    }
+    else if (nMinZoom > nMaxZoom)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Minimum zoom level (%d) greater than maximum zoom level (%d)",
+                 nMinZoom, nMaxZoom);
+        return nullptr;
+    }
+    CPLDebug("GDALTiles", "Using zoom levels %d to %d", nMinZoom, nMaxZoom);
+
+    /* -------------------------------------------------------------------- */
+    /*      Compute the range of tiles at the maximum zoom level.           */
+    /* -------------------------------------------------------------------- */
+    const auto &tm = tmList[nMaxZoom];
+    const double dfOriX = bInvertAxis ? tm.mTopLeftY : tm.mTopLeftX;
+    const double dfOriY = bInvertAxis ? tm.mTopLeftX : tm.mTopLeftY;
+    const double dfTileExtentX = tm.mResX * tm.mTileWidth;
+    const double dfTileExtentY = tm.mResY * tm.mTileHeight;
+    constexpr double TOLERANCE_IN_PIXEL = 0.499;
+    const double dfEpsX = TOLERANCE_IN_PIXEL * tm.mResX;
+    const double dfEpsY = TOLERANCE_IN_PIXEL * tm.mResY;
+    const double dfMinTileX =
+        std::max(0.0, std::floor((dfMinX - dfOriX + dfEpsX) / dfTileExtentX));
+    const double dfMinTileY =
+        std::max(0.0, std::floor((dfOriY - dfMaxY + dfEpsY) / dfTileExtentY));
+    const double dfMaxTileX =
+        std::min(static_cast<double>(tm.mMatrixWidth),
+                 std::ceil((dfMaxX - dfOriX - dfEpsX) / dfTileExtentX));
+    const double dfMaxTileY =
+        std::min(static_cast<double>(tm.mMatrixHeight),
+                 std::ceil((dfOriY - dfMinY - dfEpsY) / dfTileExtentY));
+    if (!(dfMinTileX < dfMaxTileX && dfMinTileY < dfMaxTileY))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Raster extent completely outside of tile matrix set");
+        return nullptr;
+    }
+    if ((dfMaxTileX - dfMinTileX) * tm.mTileWidth > INT_MAX ||
+        (dfMaxTileY - dfMinTileY) * tm.mTileHeight > INT_MAX)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Too many tiles at zoom level %d", nMaxZoom);
+        return nullptr;
+    }
+
+    oGenerator.nMinZoom = nMinZoom;
+    oGenerator.nMaxZoom = nMaxZoom;
+    oGenerator.nTileWidth = tm.mTileWidth;
+    oGenerator.nTileHeight = tm.mTileHeight;
+    oGenerator.nMinTileX = static_cast<int>(dfMinTileX);
+    oGenerator.nMinTileY = static_cast<int>(dfMinTileY);
+    oGenerator.nMaxTileX = static_cast<int>(dfMaxTileX);
+    oGenerator.nMaxTileY = static_cast<int>(dfMaxTileY);
+
+    /* -------------------------------------------------------------------- */
+    /*      Create the warped dataset.                                      */
+    /* -------------------------------------------------------------------- */
+    CPLStringList aosOptions;
+    aosOptions.AddString("-q");
+    aosOptions.AddString("-of");
+    aosOptions.AddString("VRT");
+    aosOptions.AddString("-t_srs");
+    aosOptions.AddString(oTMS.crs().c_str());
+    aosOptions.AddString("-te");
+    aosOptions.AddString(
+        CPLSPrintf("%.17g", dfOriX + dfMinTileX * dfTileExtentX));
+    aosOptions.AddString(
+        CPLSPrintf("%.17g", dfOriY - dfMaxTileY * dfTileExtentY));
+    aosOptions.AddString(
+        CPLSPrintf("%.17g", dfOriX + dfMaxTileX * dfTileExtentX));
+    aosOptions.AddString(
+        CPLSPrintf("%.17g", dfOriY - dfMinTileY * dfTileExtentY));
+    aosOptions.AddString("-ts");
+    aosOptions.AddString(CPLSPrintf(
+        "%d", static_cast<int>(dfMaxTileX - dfMinTileX) * tm.mTileWidth));
+    aosOptions.AddString(CPLSPrintf(
+        "%d", static_cast<int>(dfMaxTileY - dfMinTileY) * tm.mTileHeight));
+    aosOptions.AddString("-r");
+    aosOptions.AddString(psOptions->osResampling.c_str());
+    const int nSrcBands = poSrcDS->GetRasterCount();
+    if (poSrcDS->GetRasterBand(nSrcBands)->GetColorInterpretation() !=
+        GCI_AlphaBand)
+    {
+        aosOptions.AddString("-dstalpha");
+    }
+    aosOptions.AddString("-wo");
+    aosOptions.AddString(CPLSPrintf("NUM_THREADS=%d", nThreads));
+
+    auto psWarpOptions = GDALWarpAppOptionsNew(aosOptions.List(), nullptr);
+    if (!psWarpOptions)
+        return nullptr;
+    GDALDatasetH hSrcDS = GDALDataset::ToHandle(poSrcDS);
+    std::unique_ptr<GDALDataset> poWarpedDS(GDALDataset::FromHandle(
+        GDALWarp("", nullptr, 1, &hSrcDS, psWarpOptions, nullptr)));
+    GDALWarpAppOptionsFree(psWarpOptions);
+    return poWarpedDS;
+}
+
+/************************************************************************/
+/*                              GDALTiles()                             */
+/************************************************************************/
+
+/* clang-format off */
+/**
+ * Generates a pyramid of tiles from a raster.
+ *
+ * This is the equivalent of the
+ * <a href="/programs/gdal_tiles.html">gdal_tiles</a> utility.
+ *
+ * The source is warped to the CRS and resolution of the maximum zoom level
+ * of the tile matrix set, one metatile at a time, and the tiles of the lower
+ * zoom levels are built in memory from the ones of the higher zoom levels.
+ * Tiles are written as {pszDest}/{z}/{x}/{y}.{ext} files, and encoded by the
+ * number of threads specified with -num_threads or the GDAL_NUM_THREADS
+ * configuration option. Fully transparent tiles are not written.
+ *
+ * GDALTilesOptions* must be allocated and freed with GDALTilesOptionsNew()
+ * and GDALTilesOptionsFree() respectively.
+ *
+ * @param pszDest the destination directory.
+ * @param hSrcDataset the source dataset handle. Its bands must be of type
+ * Byte.
+ * @param psOptionsIn the options struct returned by GDALTilesOptionsNew()
+ * or NULL.
+ * @param pbUsageError pointer to a integer output variable to store if any
+ * usage error has occurred or NULL.
+ * @return CE_None in case of success.
+ *
+ * @since GDAL 3.9
+ */
+/* clang-format on */
+
+CPLErr GDALTiles(const char *pszDest, GDALDatasetH hSrcDataset,
+                 const GDALTilesOptions *psOptionsIn, int *pbUsageError)
+{
+    if (pszDest == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "pszDest == NULL");
+        if (pbUsageError)
+            *pbUsageError = TRUE;
+        return CE_Failure;
+    }
+    if (hSrcDataset == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "hSrcDataset== NULL");
+        if (pbUsageError)
+            *pbUsageError = TRUE;
+        return CE_Failure;
+    }
+
+    std::unique_ptr<GDALTilesOptions> poOptionsToFree;
+    const GDALTilesOptions *psOptions = psOptionsIn;
+    if (psOptions == nullptr)
+    {
+        poOptionsToFree.reset(GDALTilesOptionsNew(nullptr, nullptr));
+        psOptions = poOptionsToFree.get();
+    }
+
+    auto poSrcDS = GDALDataset::FromHandle(hSrcDataset);
+    const int nSrcBands = poSrcDS->GetRasterCount();
+    if (nSrcBands == 0)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Input dataset has no raster band.");
+        return CE_Failure;
+    }
+    for (int i = 1; i <= nSrcBands; ++i)
+    {
+        if (poSrcDS->GetRasterBand(i)->GetRasterDataType() != GDT_Byte)
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "Only Byte bands are supported. You may use "
+                     "gdal_translate -ot Byte -scale to convert the source.");
+            return CE_Failure;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Check the tile matrix set.                                      */
+    /* -------------------------------------------------------------------- */
+    auto poTMS =
+        gdal::TileMatrixSet::parse(psOptions->osTilingScheme.c_str());
+    if (!poTMS)
+        return CE_Failure;
+    if (poTMS->tileMatrixList().empty() || !poTMS->haveAllLevelsSameTopLeft() ||
+        !poTMS->haveAllLevelsSameTileSize() ||
+        !poTMS->hasOnlyPowerOfTwoVaryingScales() ||
+        poTMS->hasVariableMatrixWidth())
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Only tile matrix sets with all levels sharing the same "
+                 "top-left corner and tile size, and with resolutions "
+                 "halved at each level, are supported");
+        return CE_Failure;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Check the tile driver.                                          */
+    /* -------------------------------------------------------------------- */
+    GDALTilesGenerator oGenerator;
+    oGenerator.psOptions = psOptions;
+    oGenerator.ptmList = &(poTMS->tileMatrixList());
+    oGenerator.osDest = pszDest;
+    oGenerator.poTileDriver = GetGDALDriverManager()->GetDriverByName(
+        psOptions->osFormat.c_str());
+    if (!oGenerator.poTileDriver ||
+        !oGenerator.poTileDriver->GetMetadataItem(GDAL_DCAP_CREATECOPY))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Output driver %s not found or does not support CreateCopy()",
+                 psOptions->osFormat.c_str());
+        return CE_Failure;
+    }
+    const char *pszExtension =
+        oGenerator.poTileDriver->GetMetadataItem(GDAL_DMD_EXTENSION);
+    oGenerator.osExtension = pszExtension ? pszExtension : "";
+
+    const char *pszNumThreads =
+        psOptions->osNumThreads.empty()
+            ? CPLGetConfigOption("GDAL_NUM_THREADS", "1")
+            : psOptions->osNumThreads.c_str();
+    const int nThreads = std::max(
+        1, std::min(128, EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : atoi(pszNumThreads)));
+
+    /* -------------------------------------------------------------------- */
+    /*      Expand color tables to RGBA.                                    */
+    /* -------------------------------------------------------------------- */
+    std::unique_ptr<GDALDataset> poExpandedDS;
+    if (nSrcBands == 1 && poSrcDS->GetRasterBand(1)->GetColorTable())
+    {
+        CPLStringList aosOptions;
+        aosOptions.AddString("-of");
+        aosOptions.AddString("VRT");
+        aosOptions.AddString("-expand");
+        aosOptions.AddString("rgba");
+        auto psOptionsTranslate =
+            GDALTranslateOptionsNew(aosOptions.List(), nullptr);
+        poExpandedDS.reset(GDALDataset::FromHandle(GDALTranslate(
+            "", hSrcDataset, psOptionsTranslate, nullptr)));
+        GDALTranslateOptionsFree(psOptionsTranslate);
+        if (!poExpandedDS)
+            return CE_Failure;
+        poSrcDS = poExpandedDS.get();
+    }
+
+    std::unique_ptr<GDALDataset> poClippedDS;
+    auto poWarpedDS = GDALTilesGetWarpedDS(poSrcDS, *poTMS, psOptions,
+                                           nThreads, oGenerator, poClippedDS);
+    if (!poWarpedDS)
+        return CE_Failure;
+    oGenerator.poWarpedDS = poWarpedDS.get();
+    oGenerator.nBands = poWarpedDS->GetRasterCount();
+    const int nDataBands = oGenerator.nBands - 1;
+    if ((nDataBands != 1 && nDataBands != 3) ||
+        poWarpedDS->GetRasterBand(oGenerator.nBands)
+                ->GetColorInterpretation() != GCI_AlphaBand)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Only sources with 1 or 3 bands, optionally with an alpha "
+                 "band, or with a color table, are supported");
+        return CE_Failure;
+    }
+
+    // Bands of the written tiles. JPEG does not support alpha, and WEBP
+    // only supports RGB(A).
+    const bool bJPEG = EQUAL(psOptions->osFormat.c_str(), "JPEG");
+    const bool bWEBP = EQUAL(psOptions->osFormat.c_str(), "WEBP");
+    for (int i = 0; i < (bWEBP ? 3 : nDataBands); ++i)
+        oGenerator.anOutBands.push_back(nDataBands == 1 ? 0 : i);
+    if (!bJPEG)
+    {
+        oGenerator.anOutBands.push_back(nDataBands);
+        oGenerator.bOutAlpha = true;
+    }
+
+    const int nMetaTileLevels = static_cast<int>(
+        std::round(std::log2(std::max(1, psOptions->nMetaTileSize))));
+    oGenerator.nMetaTileZoom =
+        std::max(0, oGenerator.nMaxZoom - nMetaTileLevels);
+    oGenerator.dfTilesTotal =
+        static_cast<double>(oGenerator.nMaxTileX - oGenerator.nMinTileX) *
+        (oGenerator.nMaxTileY - oGenerator.nMinTileY);
+
+    if (VSIMkdirRecursive(pszDest, 0755) != 0)
+    {
+        VSIStatBufL sStat;
+        if (VSIStatL(pszDest, &sStat) != 0 || !VSI_ISDIR(sStat.st_mode))
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot create directory %s",
+                     pszDest);
+            return CE_Failure;
+        }
+    }
+
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    if (poThreadPool)
+    {
+        oGenerator.nThreads = nThreads;
+        oGenerator.poJobQueue = poThreadPool->CreateJobQueue();
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Process the tile quadtree depth-first, from the tiles of the    */
+    /*      lowest zoom level that has to be built.                         */
+    /* -------------------------------------------------------------------- */
+    const int nStartZoom =
+        std::min(oGenerator.nMinZoom, oGenerator.nMetaTileZoom);
+    int nMinX, nMinY, nMaxX, nMaxY;
+    oGenerator.GetTileRange(nStartZoom, nMinX, nMinY, nMaxX, nMaxY);
+    bool bOK = true;
+    std::vector<GByte> abyTile;
+    for (int nY = nMinY; bOK && nY < nMaxY; ++nY)
+    {
+        for (int nX = nMinX; bOK && nX < nMaxX; ++nX)
+        {
+            bool bEmpty = true;
+            bOK = oGenerator.ProcessTile(nStartZoom, nX, nY, abyTile, bEmpty);
+        }
+    }
+
+    if (oGenerator.poJobQueue)
+    {
+        if (bOK)
+            oGenerator.FinalizeJobs(0);
+        oGenerator.poJobQueue->WaitCompletion();
+    }
+    if (!bOK || oGenerator.bError)
+        return CE_Failure;
+
+    psOptions->pfnProgress(1.0, "", psOptions->pProgressData);
+    return CE_None;
+}
+
+/************************************************************************/
+/*                          GDALTilesOptionsNew()                       */
+/************************************************************************/
+
+/**
+ * Allocates a GDALTilesOptions struct.
+ *
+ * @param papszArgv NULL terminated list of options (potentially including
+ * filename and open options too), or NULL. The accepted options are the ones of
+ * the <a href="/programs/gdal_tiles.html">gdal_tiles</a> utility.
+ * @param psOptionsForBinary (output) may be NULL (and should generally be
+ * NULL), otherwise (gdal_tiles_bin.cpp use case) must be allocated with
+ * GDALTilesOptionsForBinaryNew() prior to this function. Will be filled
+ * with potentially present filename, open options,...
+ * @return pointer to the allocated GDALTilesOptions struct. Must be freed
+ * with GDALTilesOptionsFree().
+ *
+ * @since GDAL 3.9
+ */
+
+GDALTilesOptions *
+GDALTilesOptionsNew(char **papszArgv,
+                    GDALTilesOptionsForBinary *psOptionsForBinary)
+{
+    auto psOptions = std::make_unique<GDALTilesOptions>();
+
+    bool bGotSourceFilename = false;
+    bool bGotDestFilename = false;
+    /* -------------------------------------------------------------------- */
+    /*      Handle command line arguments.                                  */
+    /* -------------------------------------------------------------------- */
+    const int argc = CSLCount(papszArgv);
+    for (int i = 0; papszArgv != nullptr && i < argc; i++)
+    {
+        if (i < argc - 1 &&
+            (EQUAL(papszArgv[i], "-tf") || EQUAL(papszArgv[i], "-of")))
+        {
+            ++i;
+            psOptions->osFormat = papszArgv[i];
+        }
+
+        else if (EQUAL(papszArgv[i], "-q") || EQUAL(papszArgv[i], "-quiet"))
+        {
+            if (psOptionsForBinary)
+            {
+                psOptionsForBinary->bQuiet = true;
+            }
+            else
+            {
+                CPLError(CE_Failure, CPLE_NotSupported,
+                         "%s switch only supported from gdal_tiles binary.",
+                         papszArgv[i]);
+                return nullptr;
+            }
+        }
+
+        else if (i < argc - 1 && EQUAL(papszArgv[i], "-oo"))
+        {
+            i++;
+            if (psOptionsForBinary)
+            {
+                psOptionsForBinary->aosOpenOptions.AddString(papszArgv[i]);
+            }
+            else
+            {
+                CPLError(CE_Failure, CPLE_NotSupported,
+                         "-oo switch only supported from gdal_tiles binary.");
+                return nullptr;
+            }
+        }
+
+        else if (i < argc - 1 && EQUAL(papszArgv[i], "-z"))
+        {
+            i++;
+            const CPLStringList aosTokens(
+                CSLTokenizeString2(papszArgv[i], "-", 0));
+            if (aosTokens.size() == 1)
+            {
+                psOptions->nMinZoom = atoi(aosTokens[0]);
+                psOptions->nMaxZoom = psOptions->nMinZoom;
+            }
+            else if (aosTokens.size() == 2)
+            {
+                psOptions->nMinZoom = atoi(aosTokens[0]);
+                psOptions->nMaxZoom = atoi(aosTokens[1]);
+            }
+            if (aosTokens.size() == 0 || aosTokens.size() > 2 ||
+                psOptions->nMinZoom < 0 ||
+                psOptions->nMinZoom > psOptions->nMaxZoom)
+            {
+                CPLError(CE_Failure, CPLE_IllegalArg,
+                         "Invalid value for -z: %s", papszArgv[i]);
+                return nullptr;
+            }
+        }
+
+        else if (i < argc - 1 && EQUAL(papszArgv[i], "-tiling_scheme"))
+        {
+            i++;
+            psOptions->osTilingScheme = papszArgv[i];
+        }
+
+        else if (i < argc - 1 && EQUAL(papszArgv[i], "-r"))
+        {
+            i++;
+            psOptions->osResampling = papszArgv[i];
+            if (!STARTS_WITH_CI(papszArgv[i], "NEAR") &&
+                !EQUAL(papszArgv[i], "BILINEAR") &&
+                !EQUAL(papszArgv[i], "CUBIC") &&
+                !EQUAL(papszArgv[i], "CUBICSPLINE") &&
+                !EQUAL(papszArgv[i], "LANCZOS") &&
+                !EQUAL(papszArgv[i], "AVERAGE") &&
+                !EQUAL(papszArgv[i], "RMS") && !EQUAL(papszArgv[i], "MODE"))
+            {
+                CPLError(CE_Failure, CPLE_IllegalArg,
+                         "Invalid value for -r: %s", papszArgv[i]);
+                return nullptr;
+            }
+        }
+
+        else if (i < argc - 1 && EQUAL(papszArgv[i], "-co"))
+        {
+            i++;
+            psOptions->aosCreationOptions.AddString(papszArgv[i]);
+        }
+
+        else if (i < argc - 1 && EQUAL(papszArgv[i], "-convention"))
+        {
+            i++;
+            if (EQUAL(papszArgv[i], "xyz"))
+                psOptions->bTMSConvention = false;
+            else if (EQUAL(papszArgv[i], "tms"))
+                psOptions->bTMSConvention = true;
+            else
+            {
+                CPLError(CE_Failure, CPLE_IllegalArg,
+                         "Invalid value for -convention: %s", papszArgv[i]);
+                return nullptr;
+            }
+        }
+
+        else if (i < argc - 1 && EQUAL(papszArgv[i], "-metatile"))
+        {
+            i++;
+            const int nVal = atoi(papszArgv[i]);
+            if (nVal < 1 || nVal > 64 || (nVal & (nVal - 1)) != 0)
+            {
+                CPLError(CE_Failure, CPLE_IllegalArg,
+                         "Invalid value for -metatile: %s. Should be a "
+                         "power of two between 1 and 64",
+                         papszArgv[i]);
+                return nullptr;
+            }
+            psOptions->nMetaTileSize = nVal;
+        }
+
+        else if (i < argc - 1 && EQUAL(papszArgv[i], "-num_threads"))
+        {
+            i++;
+            psOptions->osNumThreads = papszArgv[i];
+        }
+
+        else if (EQUAL(papszArgv[i], "-skip_existing"))
+        {
+            psOptions->bSkipExisting = true;
+        }
+
+        else if (papszArgv[i][0] == '-')
+        {
+            CPLError(CE_Failure, CPLE_NotSupported, "Unknown option name '%s'",
+                     papszArgv[i]);
+            return nullptr;
+        }
+        else if (!bGotSourceFilename)
+        {
+            bGotSourceFilename = true;
+            if (psOptionsForBinary)
+            {
+                psOptionsForBinary->osSource = papszArgv[i];
+            }
+            else
+            {
+                CPLError(CE_Failure, CPLE_NotSupported,
+                         "{source_filename} only supported from gdal_tiles "
+                         "binary.");
+                return nullptr;
+            }
+        }
+        else if (!bGotDestFilename)
+        {
+            bGotDestFilename = true;
+            if (psOptionsForBinary)
+            {
+                psOptionsForBinary->bDestSpecified = true;
+                psOptionsForBinary->osDest = papszArgv[i];
+            }
+            else
+            {
+                CPLError(CE_Failure, CPLE_NotSupported,
+                         "{dest_directory} only supported from gdal_tiles "
+                         "binary.");
+                return nullptr;
+            }
+        }
+        else
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "Too many command options '%s'", papszArgv[i]);
+            return nullptr;
+        }
+    }
+
+    return psOptions.release();
+}
+
+/************************************************************************/
+/*                         GDALTilesOptionsFree()                       */
+/************************************************************************/
+
+/**
+ * Frees the GDALTilesOptions struct.
+ *
+ * @param psOptions the options struct for GDALTiles().
+ *
+ * @since GDAL 3.9
+ */
+
+void GDALTilesOptionsFree(GDALTilesOptions *psOptions)
+{
+    delete psOptions;
+}
+
+/************************************************************************/
+/*                      GDALTilesOptionsSetProgress()                   */
+/************************************************************************/
+
+/**
+ * Set a progress function.
+ *
+ * @param psOptions the options struct for GDALTiles().
+ * @param pfnProgress the progress callback.
+ * @param pProgressData the user data for the progress callback.
+ *
+ * @since GDAL 3.9
+ */
+
+void GDALTilesOptionsSetProgress(GDALTilesOptions *psOptions,
+                                 GDALProgressFunc pfnProgress,
+                                 void *pProgressData)
+{
+    psOptions->pfnProgress = pfnProgress ? pfnProgress : GDALDummyProgress;
+    psOptions->pProgressData = pProgressData;
+}
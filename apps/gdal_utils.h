@@ -324,6 +324,26 @@ GDALDatasetH CPL_DLL GDALTileIndex(const char *pszDest, int nSrcCount,
                                    const GDALTileIndexOptions *psOptions,
                                    int *pbUsageError);
 
+/*! Options for GDALTiles(). Opaque type */
+typedef struct GDALTilesOptions GDALTilesOptions;
+
+/** Opaque type */
+typedef struct GDALTilesOptionsForBinary GDALTilesOptionsForBinary;
+
+GDALTilesOptions CPL_DLL *
+GDALTilesOptionsNew(char **papszArgv,
+                    GDALTilesOptionsForBinary *psOptionsForBinary);
+
+void CPL_DLL GDALTilesOptionsFree(GDALTilesOptions *psOptions);
+
+void CPL_DLL GDALTilesOptionsSetProgress(GDALTilesOptions *psOptions,
+                                         GDALProgressFunc pfnProgress,
+                                         void *pProgressData);
+
+CPLErr CPL_DLL GDALTiles(const char *pszDest, GDALDatasetH hSrcDS,
+                         const GDALTilesOptions *psOptions,
+                         int *pbUsageError);
+
 CPL_C_END
 
 #endif /* GDAL_UTILS_H_INCLUDED */
@@ -230,6 +230,15 @@ struct GDALTileIndexOptionsForBinary
     bool bQuiet = false;
 };
 
+struct GDALTilesOptionsForBinary
+{
+    std::string osSource{};
+    bool bDestSpecified = false;
+    std::string osDest{};
+    bool bQuiet = false;
+    CPLStringList aosOpenOptions{};
+};
+
 #endif /* #ifndef DOXYGEN_SKIP */
 
 #endif /* GDAL_UTILS_PRIV_H_INCLUDED */
@@ -0,0 +1,346 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Utilities
+ * Purpose:  Command line utility computing zonal statistics of a raster.
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_conv.h"
+#include "cpl_string.h"
+#include "gdal_version.h"
+#include "gdal.h"
+#include "gdal_alg.h"
+#include "ogr_api.h"
+#include "ogr_srs_api.h"
+#include "commonutils.h"
+
+/************************************************************************/
+/*                               Usage()                                */
+/************************************************************************/
+
+static void Usage(bool bIsError, const char *pszErrorMsg = nullptr)
+
+{
+    fprintf(bIsError ? stderr : stdout,
+            "Usage: gdal_zonal_stats [--help] [--help-general]\n"
+            "                        [-b <band>] [-stats <stat>[,<stat>]...]\n"
+            "                        [-hist <bins> <min> <max>] [-center]\n"
+            "                        [-zl <zone_layer>] [-nogeom]\n"
+            "                        [-f <formatname>] "
+            "[-dsco <NAME>=<VALUE>]... [-lco <NAME>=<VALUE>]...\n"
+            "                        [-nln <outlayername>] [-q]\n"
+            "                        <src_filename> <zone_filename> "
+            "<dst_filename>\n");
+
+    if (pszErrorMsg != nullptr)
+        fprintf(stderr, "\nFAILURE: %s\n", pszErrorMsg);
+
+    exit(bIsError ? 1 : 0);
+}
+
+/************************************************************************/
+/*                                main()                                */
+/************************************************************************/
+
+#define CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(nExtraArg)                            \
+    do                                                                         \
+    {                                                                          \
+        if (i + nExtraArg >= argc)                                             \
+            Usage(true, CPLSPrintf("%s option requires %d argument(s)",        \
+                                   argv[i], nExtraArg));                       \
+    } while (false)
+
+MAIN_START(argc, argv)
+
+{
+    int nBandIn = 1;
+    const char *pszSrcFilename = nullptr;
+    const char *pszZoneFilename = nullptr;
+    const char *pszDstFilename = nullptr;
+    const char *pszZoneLayerName = nullptr;
+    const char *pszFormat = nullptr;
+    const char *pszNewLayerName = "zonal_stats";
+    const char *pszStats = nullptr;
+    const char *pszHistBins = nullptr;
+    const char *pszHistMin = nullptr;
+    const char *pszHistMax = nullptr;
+    char **papszDSCO = nullptr;
+    char **papszLCO = nullptr;
+    bool bCenter = false;
+    bool bNoGeom = false;
+    bool bQuiet = false;
+
+    EarlySetConfigOptions(argc, argv);
+
+    GDALAllRegister();
+
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        exit(-argc);
+
+    /* -------------------------------------------------------------------- */
+    /*      Parse arguments.                                                */
+    /* -------------------------------------------------------------------- */
+    for (int i = 1; i < argc; i++)
+    {
+        if (EQUAL(argv[i], "--utility_version"))
+        {
+            printf("%s was compiled against GDAL %s and "
+                   "is running against GDAL %s\n",
+                   argv[0], GDAL_RELEASE_NAME, GDALVersionInfo("RELEASE_NAME"));
+            CSLDestroy(argv);
+            return 0;
+        }
+        else if (EQUAL(argv[i], "--help"))
+            Usage(false);
+        else if (EQUAL(argv[i], "-b"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            // coverity[tainted_data]
+            nBandIn = atoi(argv[++i]);
+        }
+        else if (EQUAL(argv[i], "-stats"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            // coverity[tainted_data]
+            pszStats = argv[++i];
+        }
+        else if (EQUAL(argv[i], "-hist"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(3);
+            // coverity[tainted_data]
+            pszHistBins = argv[++i];
+            // coverity[tainted_data]
+            pszHistMin = argv[++i];
+            // coverity[tainted_data]
+            pszHistMax = argv[++i];
+        }
+        else if (EQUAL(argv[i], "-center"))
+        {
+            bCenter = true;
+        }
+        else if (EQUAL(argv[i], "-zl"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            // coverity[tainted_data]
+            pszZoneLayerName = argv[++i];
+        }
+        else if (EQUAL(argv[i], "-nogeom"))
+        {
+            bNoGeom = true;
+        }
+        else if (EQUAL(argv[i], "-f") || EQUAL(argv[i], "-of"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            // coverity[tainted_data]
+            pszFormat = argv[++i];
+        }
+        else if (EQUAL(argv[i], "-dsco"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            // coverity[tainted_data]
+            papszDSCO = CSLAddString(papszDSCO, argv[++i]);
+        }
+        else if (EQUAL(argv[i], "-lco"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            // coverity[tainted_data]
+            papszLCO = CSLAddString(papszLCO, argv[++i]);
+        }
+        else if (EQUAL(argv[i], "-nln"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            // coverity[tainted_data]
+            pszNewLayerName = argv[++i];
+        }
+        else if (EQUAL(argv[i], "-q") || EQUAL(argv[i], "-quiet"))
+        {
+            bQuiet = true;
+        }
+        else if (argv[i][0] == '-' && argv[i][1] != '\0')
+        {
+            Usage(true, CPLSPrintf("Unknown option name '%s'", argv[i]));
+        }
+        else if (pszSrcFilename == nullptr)
+        {
+            pszSrcFilename = argv[i];
+        }
+        else if (pszZoneFilename == nullptr)
+        {
+            pszZoneFilename = argv[i];
+        }
+        else if (pszDstFilename == nullptr)
+        {
+            pszDstFilename = argv[i];
+        }
+        else
+            Usage(true, "Too many command options.");
+    }
+
+    if (pszSrcFilename == nullptr)
+        Usage(true, "Missing source filename.");
+    if (pszZoneFilename == nullptr)
+        Usage(true, "Missing zone filename.");
+    if (pszDstFilename == nullptr)
+        Usage(true, "Missing destination filename.");
+
+    if (strcmp(pszDstFilename, "/vsistdout/") == 0 ||
+        strcmp(pszDstFilename, "/dev/stdout") == 0)
+    {
+        bQuiet = true;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Open the source raster and the zones.                           */
+    /* -------------------------------------------------------------------- */
+    GDALDatasetH hSrcDS = GDALOpenEx(pszSrcFilename,
+                                     GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR,
+                                     nullptr, nullptr, nullptr);
+    if (hSrcDS == nullptr)
+        exit(2);
+
+    GDALRasterBandH hBand = GDALGetRasterBand(hSrcDS, nBandIn);
+    if (hBand == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Band %d does not exist on dataset.", nBandIn);
+        exit(2);
+    }
+
+    GDALDatasetH hZoneDS = GDALOpenEx(pszZoneFilename,
+                                      GDAL_OF_VECTOR | GDAL_OF_VERBOSE_ERROR,
+                                      nullptr, nullptr, nullptr);
+    if (hZoneDS == nullptr)
+        exit(2);
+
+    OGRLayerH hZoneLayer = pszZoneLayerName
+                               ? GDALDatasetGetLayerByName(hZoneDS,
+                                                           pszZoneLayerName)
+                               : GDALDatasetGetLayer(hZoneDS, 0);
+    if (hZoneLayer == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot find zone layer %s.",
+                 pszZoneLayerName ? pszZoneLayerName : "");
+        exit(2);
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Create the output file.                                         */
+    /* -------------------------------------------------------------------- */
+    CPLString osFormat;
+    if (pszFormat == nullptr)
+    {
+        std::vector<CPLString> aoDrivers =
+            GetOutputDriversFor(pszDstFilename, GDAL_OF_VECTOR);
+        if (aoDrivers.empty())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "Cannot guess driver for %s",
+                     pszDstFilename);
+            exit(10);
+        }
+        else
+        {
+            if (aoDrivers.size() > 1)
+            {
+                CPLError(CE_Warning, CPLE_AppDefined,
+                         "Several drivers matching %s extension. Using %s",
+                         CPLGetExtension(pszDstFilename), aoDrivers[0].c_str());
+            }
+            osFormat = aoDrivers[0];
+        }
+    }
+    else
+    {
+        osFormat = pszFormat;
+    }
+
+    GDALDriverH hDriver = GDALGetDriverByName(osFormat.c_str());
+    if (hDriver == nullptr)
+    {
+        fprintf(stderr, "Unable to find format driver named %s.\n",
+                osFormat.c_str());
+        exit(10);
+    }
+
+    GDALDatasetH hDstDS =
+        GDALCreate(hDriver, pszDstFilename, 0, 0, 0, GDT_Unknown, papszDSCO);
+    if (hDstDS == nullptr)
+        exit(1);
+
+    OGRFeatureDefnH hZoneDefn = OGR_L_GetLayerDefn(hZoneLayer);
+    OGRLayerH hDstLayer = GDALDatasetCreateLayer(
+        hDstDS, pszNewLayerName,
+        bNoGeom ? nullptr : OGR_L_GetSpatialRef(hZoneLayer),
+        bNoGeom ? wkbNone : OGR_FD_GetGeomType(hZoneDefn), papszLCO);
+    if (hDstLayer == nullptr)
+        exit(1);
+
+    for (int iField = 0; iField < OGR_FD_GetFieldCount(hZoneDefn); ++iField)
+    {
+        if (OGR_L_CreateField(hDstLayer,
+                              OGR_FD_GetFieldDefn(hZoneDefn, iField),
+                              TRUE) != OGRERR_NONE)
+            exit(1);
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Invoke.                                                         */
+    /* -------------------------------------------------------------------- */
+    CPLStringList aosOptions;
+    if (pszStats)
+        aosOptions.SetNameValue("STATS", pszStats);
+    if (pszHistBins)
+    {
+        aosOptions.SetNameValue("HISTOGRAM_BINS", pszHistBins);
+        aosOptions.SetNameValue("HISTOGRAM_MIN", pszHistMin);
+        aosOptions.SetNameValue("HISTOGRAM_MAX", pszHistMax);
+    }
+    if (bCenter)
+        aosOptions.SetNameValue("COVERAGE", "CENTER");
+
+    const bool bTransaction =
+        GDALDatasetStartTransaction(hDstDS, FALSE) == OGRERR_NONE;
+
+    CPLErr eErr =
+        GDALZonalStats(hBand, hZoneLayer, hDstLayer, aosOptions.List(),
+                       bQuiet ? GDALDummyProgress : GDALTermProgress, nullptr);
+
+    if (bTransaction && eErr == CE_None &&
+        GDALDatasetCommitTransaction(hDstDS) != OGRERR_NONE)
+        eErr = CE_Failure;
+    if (GDALClose(hDstDS) != CE_None)
+        eErr = CE_Failure;
+    GDALClose(hZoneDS);
+    GDALClose(hSrcDS);
+
+    CSLDestroy(argv);
+    CSLDestroy(papszDSCO);
+    CSLDestroy(papszLCO);
+    GDALDestroyDriverManager();
+    OGRCleanupAll();
+
+    return (eErr == CE_None) ? 0 : 1;
+}
+
+MAIN_END
@@ -1538,6 +1538,11 @@ GDALDataset *VRTBuilder::Build(GDALProgressFunc pfnProgress,
         }
     }
 
+    // Input files are opened ahead by worker threads if GDAL_NUM_THREADS is
+    // set, but they are still analysed in order.
+    GDALConcurrentDatasetOpener oOpener(GDAL_OF_RASTER, papszOpenOptions);
+    int nInputFilesAddedToOpener = 0;
+
     bool bFoundValid = false;
     for (int i = 0; ppszInputFilenames != nullptr && i < nInputFiles; i++)
     {
@@ -1548,10 +1553,21 @@ GDALDataset *VRTBuilder::Build(GDALProgressFunc pfnProgress,
             return nullptr;
         }
 
-        GDALDatasetH hDS = (pahSrcDS)
-                               ? pahSrcDS[i]
-                               : GDALOpenEx(dsFileName, GDAL_OF_RASTER, nullptr,
-                                            papszOpenOptions, nullptr);
+        GDALDatasetH hDS = nullptr;
+        if (pahSrcDS)
+        {
+            hDS = pahSrcDS[i];
+        }
+        else
+        {
+            // AnalyseRaster() may append subdatasets to the input files.
+            for (; nInputFilesAddedToOpener < nInputFiles;
+                 ++nInputFilesAddedToOpener)
+            {
+                oOpener.Add(ppszInputFilenames[nInputFilesAddedToOpener]);
+            }
+            hDS = GDALDataset::ToHandle(oOpener.Next());
+        }
         asDatasetProperties[i].isFileOK = FALSE;
 
         if (hDS)
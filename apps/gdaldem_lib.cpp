@@ -109,20 +109,30 @@
 #endif
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 #if defined(__SSE2__) || defined(_M_X64)
 #define HAVE_16_SSE_REG
 #define HAVE_SSE2
 #include "emmintrin.h"
 #endif
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 static const double kdfDegreesToRadians = M_PI / 180.0;
 static const double kdfRadiansToDegrees = 180.0 / M_PI;
@@ -292,10 +302,315 @@ GInt32 INTERPOL(GInt32 a, GInt32 b, int bSrcHasNoData, GInt32 fSrcNoDataValue)
     return nVal;
 }
 
+/************************************************************************/
+/*                  GDALGeneric3x3ProcessingContext                     */
+/************************************************************************/
+
+template <class T> struct GDALGeneric3x3ProcessingContext
+{
+    typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg = nullptr;
+    typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
+        pfnAlg_multisample = nullptr;
+    void *pData = nullptr;
+    bool bComputeAtEdges = false;
+    int nXSize = 0;
+    int nYSize = 0;
+    bool bSrcHasNoData = false;
+    T fSrcNoDataValue = 0;
+    bool bIsSrcNoDataNan = false;
+    float fDstNoDataValue = 0;
+};
+
+/************************************************************************/
+/*                  GDALGeneric3x3ProcessingStripe                      */
+/************************************************************************/
+
+// Horizontal stripe of output lines, along with the source lines needed to
+// compute them (one line of overlap above and below, when available).
+template <class T> struct GDALGeneric3x3ProcessingStripe
+{
+    const GDALGeneric3x3ProcessingContext<T> *psCtx = nullptr;
+    int nYOff = 0;
+    int nYSize = 0;
+    int nSrcYOff = 0;
+    int nSrcYSize = 0;
+    std::vector<T> aSrc{};
+    std::vector<bool> abSrcLineHasNoData{};
+    std::vector<float> aOutput{};
+
+    // Set (under *poMutex) once aOutput has been computed.
+    bool bDone = false;
+    std::mutex *poMutex = nullptr;
+    std::condition_variable *poCV = nullptr;
+};
+
+/************************************************************************/
+/*                  GDALGeneric3x3ProcessFirstLine()                    */
+/************************************************************************/
+
+template <class T>
+static void
+GDALGeneric3x3ProcessFirstLine(const GDALGeneric3x3ProcessingContext<T> &sCtx,
+                               const T *pafLine1, const T *pafLine2,
+                               float *pafOutputBuf)
+{
+    const int nXSize = sCtx.nXSize;
+    for (int j = 0; j < nXSize; j++)
+    {
+        int jmin = (j == 0) ? j : j - 1;
+        int jmax = (j == nXSize - 1) ? j : j + 1;
+
+        T afWin[9] = {INTERPOL(pafLine1[jmin], pafLine2[jmin],
+                               sCtx.bSrcHasNoData, sCtx.fSrcNoDataValue),
+                      INTERPOL(pafLine1[j], pafLine2[j], sCtx.bSrcHasNoData,
+                               sCtx.fSrcNoDataValue),
+                      INTERPOL(pafLine1[jmax], pafLine2[jmax],
+                               sCtx.bSrcHasNoData, sCtx.fSrcNoDataValue),
+                      pafLine1[jmin],
+                      pafLine1[j],
+                      pafLine1[jmax],
+                      pafLine2[jmin],
+                      pafLine2[j],
+                      pafLine2[jmax]};
+        pafOutputBuf[j] =
+            ComputeVal(sCtx.bSrcHasNoData, sCtx.fSrcNoDataValue,
+                       sCtx.bIsSrcNoDataNan, afWin, sCtx.fDstNoDataValue,
+                       sCtx.pfnAlg, sCtx.pData, sCtx.bComputeAtEdges);
+    }
+}
+
+/************************************************************************/
+/*                  GDALGeneric3x3ProcessLastLine()                     */
+/************************************************************************/
+
+template <class T>
+static void
+GDALGeneric3x3ProcessLastLine(const GDALGeneric3x3ProcessingContext<T> &sCtx,
+                              const T *pafLine1, const T *pafLine2,
+                              float *pafOutputBuf)
+{
+    const int nXSize = sCtx.nXSize;
+    for (int j = 0; j < nXSize; j++)
+    {
+        int jmin = (j == 0) ? j : j - 1;
+        int jmax = (j == nXSize - 1) ? j : j + 1;
+
+        T afWin[9] = {
+            pafLine1[jmin],
+            pafLine1[j],
+            pafLine1[jmax],
+            pafLine2[jmin],
+            pafLine2[j],
+            pafLine2[jmax],
+            INTERPOL(pafLine2[jmin], pafLine1[jmin], sCtx.bSrcHasNoData,
+                     sCtx.fSrcNoDataValue),
+            INTERPOL(pafLine2[j], pafLine1[j], sCtx.bSrcHasNoData,
+                     sCtx.fSrcNoDataValue),
+            INTERPOL(pafLine2[jmax], pafLine1[jmax], sCtx.bSrcHasNoData,
+                     sCtx.fSrcNoDataValue),
+        };
+
+        pafOutputBuf[j] =
+            ComputeVal(sCtx.bSrcHasNoData, sCtx.fSrcNoDataValue,
+                       sCtx.bIsSrcNoDataNan, afWin, sCtx.fDstNoDataValue,
+                       sCtx.pfnAlg, sCtx.pData, sCtx.bComputeAtEdges);
+    }
+}
+
+/************************************************************************/
+/*                    GDALGeneric3x3ProcessLine()                       */
+/************************************************************************/
+
+// Compute a line that has a source line above and below it.
+template <class T>
+static void
+GDALGeneric3x3ProcessLine(const GDALGeneric3x3ProcessingContext<T> &sCtx,
+                          const T *pafThreeLineWin, int nLine1Off,
+                          int nLine2Off, int nLine3Off,
+                          bool bOneOfThreeLinesHasNoData, float *pafOutputBuf)
+{
+    const int nXSize = sCtx.nXSize;
+    const bool bSrcHasNoData = sCtx.bSrcHasNoData;
+    const T fSrcNoDataValue = sCtx.fSrcNoDataValue;
+
+    if (sCtx.bComputeAtEdges && nXSize >= 2)
+    {
+        int j = 0;
+        T afWin[9] = {INTERPOL(pafThreeLineWin[nLine1Off + j],
+                               pafThreeLineWin[nLine1Off + j + 1],
+                               bSrcHasNoData, fSrcNoDataValue),
+                      pafThreeLineWin[nLine1Off + j],
+                      pafThreeLineWin[nLine1Off + j + 1],
+                      INTERPOL(pafThreeLineWin[nLine2Off + j],
+                               pafThreeLineWin[nLine2Off + j + 1],
+                               bSrcHasNoData, fSrcNoDataValue),
+                      pafThreeLineWin[nLine2Off + j],
+                      pafThreeLineWin[nLine2Off + j + 1],
+                      INTERPOL(pafThreeLineWin[nLine3Off + j],
+                               pafThreeLineWin[nLine3Off + j + 1],
+                               bSrcHasNoData, fSrcNoDataValue),
+                      pafThreeLineWin[nLine3Off + j],
+                      pafThreeLineWin[nLine3Off + j + 1]};
+
+        pafOutputBuf[j] = ComputeVal(
+            bOneOfThreeLinesHasNoData, fSrcNoDataValue, sCtx.bIsSrcNoDataNan,
+            afWin, sCtx.fDstNoDataValue, sCtx.pfnAlg, sCtx.pData,
+            sCtx.bComputeAtEdges);
+    }
+    else
+    {
+        // Exclude the edges
+        pafOutputBuf[0] = sCtx.fDstNoDataValue;
+    }
+
+    int j = 1;
+    if (sCtx.pfnAlg_multisample && !bOneOfThreeLinesHasNoData)
+    {
+        j = sCtx.pfnAlg_multisample(pafThreeLineWin, nLine1Off, nLine2Off,
+                                    nLine3Off, nXSize, sCtx.pData,
+                                    pafOutputBuf);
+    }
+
+    for (; j < nXSize - 1; j++)
+    {
+        T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
+                      pafThreeLineWin[nLine1Off + j],
+                      pafThreeLineWin[nLine1Off + j + 1],
+                      pafThreeLineWin[nLine2Off + j - 1],
+                      pafThreeLineWin[nLine2Off + j],
+                      pafThreeLineWin[nLine2Off + j + 1],
+                      pafThreeLineWin[nLine3Off + j - 1],
+                      pafThreeLineWin[nLine3Off + j],
+                      pafThreeLineWin[nLine3Off + j + 1]};
+
+        pafOutputBuf[j] = ComputeVal(
+            bOneOfThreeLinesHasNoData, fSrcNoDataValue, sCtx.bIsSrcNoDataNan,
+            afWin, sCtx.fDstNoDataValue, sCtx.pfnAlg, sCtx.pData,
+            sCtx.bComputeAtEdges);
+    }
+
+    if (sCtx.bComputeAtEdges && nXSize >= 2)
+    {
+        j = nXSize - 1;
+
+        T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
+                      pafThreeLineWin[nLine1Off + j],
+                      INTERPOL(pafThreeLineWin[nLine1Off + j],
+                               pafThreeLineWin[nLine1Off + j - 1],
+                               bSrcHasNoData, fSrcNoDataValue),
+                      pafThreeLineWin[nLine2Off + j - 1],
+                      pafThreeLineWin[nLine2Off + j],
+                      INTERPOL(pafThreeLineWin[nLine2Off + j],
+                               pafThreeLineWin[nLine2Off + j - 1],
+                               bSrcHasNoData, fSrcNoDataValue),
+                      pafThreeLineWin[nLine3Off + j - 1],
+                      pafThreeLineWin[nLine3Off + j],
+                      INTERPOL(pafThreeLineWin[nLine3Off + j],
+                               pafThreeLineWin[nLine3Off + j - 1],
+                               bSrcHasNoData, fSrcNoDataValue)};
+
+        pafOutputBuf[j] = ComputeVal(
+            bOneOfThreeLinesHasNoData, fSrcNoDataValue, sCtx.bIsSrcNoDataNan,
+            afWin, sCtx.fDstNoDataValue, sCtx.pfnAlg, sCtx.pData,
+            sCtx.bComputeAtEdges);
+    }
+    else
+    {
+        // Exclude the edges
+        if (nXSize > 1)
+            pafOutputBuf[nXSize - 1] = sCtx.fDstNoDataValue;
+    }
+}
+
+/************************************************************************/
+/*                   GDALGeneric3x3ProcessStripe()                      */
+/************************************************************************/
+
+template <class T>
+static void
+GDALGeneric3x3ProcessStripe(GDALGeneric3x3ProcessingStripe<T> &sStripe)
+{
+    const auto &sCtx = *(sStripe.psCtx);
+    const int nXSize = sCtx.nXSize;
+    const int nYSize = sCtx.nYSize;
+    const bool bComputeEdgeLines =
+        sCtx.bComputeAtEdges && nXSize >= 2 && nYSize >= 2;
+
+    // Move a 3x3 pafWindow over each cell
+    // (where the cell in question is #4)
+    //
+    //      0 1 2
+    //      3 4 5
+    //      6 7 8
+
+    for (int i = sStripe.nYOff; i < sStripe.nYOff + sStripe.nYSize; i++)
+    {
+        float *pafOutputBuf =
+            sStripe.aOutput.data() +
+            static_cast<size_t>(i - sStripe.nYOff) * nXSize;
+        const int iSrcLine = i - sStripe.nSrcYOff;
+
+        if (i == 0 || i == nYSize - 1)
+        {
+            if (!bComputeEdgeLines)
+            {
+                // Exclude the edges
+                std::fill(pafOutputBuf, pafOutputBuf + nXSize,
+                          sCtx.fDstNoDataValue);
+            }
+            else if (i == 0)
+            {
+                const T *pafLine1 = sStripe.aSrc.data();
+                GDALGeneric3x3ProcessFirstLine(sCtx, pafLine1,
+                                               pafLine1 + nXSize, pafOutputBuf);
+            }
+            else
+            {
+                const T *pafLine1 = sStripe.aSrc.data() +
+                                    static_cast<size_t>(iSrcLine - 1) * nXSize;
+                GDALGeneric3x3ProcessLastLine(sCtx, pafLine1,
+                                              pafLine1 + nXSize, pafOutputBuf);
+            }
+            continue;
+        }
+
+        // In case none of the 3 lines have nodata values, then no need to
+        // check it in ComputeVal()
+        const bool bOneOfThreeLinesHasNoData =
+            sStripe.abSrcLineHasNoData[iSrcLine - 1] ||
+            sStripe.abSrcLineHasNoData[iSrcLine] ||
+            sStripe.abSrcLineHasNoData[iSrcLine + 1];
+
+        GDALGeneric3x3ProcessLine(
+            sCtx,
+            sStripe.aSrc.data() + static_cast<size_t>(iSrcLine - 1) * nXSize,
+            0, nXSize, 2 * nXSize, bOneOfThreeLinesHasNoData, pafOutputBuf);
+    }
+}
+
+/************************************************************************/
+/*                   GDALGeneric3x3ProcessingJob()                      */
+/************************************************************************/
+
+template <class T> static void GDALGeneric3x3ProcessingJob(void *pData)
+{
+    auto psStripe = static_cast<GDALGeneric3x3ProcessingStripe<T> *>(pData);
+    GDALGeneric3x3ProcessStripe(*psStripe);
+
+    std::lock_guard<std::mutex> oLock(*(psStripe->poMutex));
+    psStripe->bDone = true;
+    psStripe->poCV->notify_all();
+}
+
 /************************************************************************/
 /*                  GDALGeneric3x3Processing()                          */
 /************************************************************************/
 
+// The output is computed by horizontal stripes. Reading and writing is
+// done sequentially by the calling thread (datasets are not thread-safe),
+// whereas stripes are computed by the global thread pool when the
+// GDAL_NUM_THREADS configuration option is set. Stripes are written in
+// order.
 template <class T>
 static CPLErr GDALGeneric3x3Processing(
     GDALRasterBandH hSrcBand, GDALRasterBandH hDstBand,
@@ -320,19 +635,6 @@ static CPLErr GDALGeneric3x3Processing(
     const int nXSize = GDALGetRasterBandXSize(hSrcBand);
     const int nYSize = GDALGetRasterBandYSize(hSrcBand);
 
-    // 1 line destination buffer.
-    float *pafOutputBuf =
-        static_cast<float *>(VSI_MALLOC2_VERBOSE(sizeof(float), nXSize));
-    // 3 line rotating source buffer.
-    T *pafThreeLineWin =
-        static_cast<T *>(VSI_MALLOC2_VERBOSE(3 * sizeof(T), nXSize + 1));
-    if (pafOutputBuf == nullptr || pafThreeLineWin == nullptr)
-    {
-        VSIFree(pafOutputBuf);
-        VSIFree(pafThreeLineWin);
-        return CE_Failure;
-    }
-
     GDALDataType eReadDT;
     int bSrcHasNoData = FALSE;
     const double dfNoDataValue =
@@ -379,317 +681,138 @@ static CPLErr GDALGeneric3x3Processing(
     if (!bDstHasNoData)
         fDstNoDataValue = 0.0;
 
-    int nLine1Off = 0;
-    int nLine2Off = nXSize;
-    int nLine3Off = 2 * nXSize;
-
-    // Move a 3x3 pafWindow over each cell
-    // (where the cell in question is #4)
-    //
-    //      0 1 2
-    //      3 4 5
-    //      6 7 8
-
-    /* Preload the first 2 lines */
-
-    bool abLineHasNoDataValue[3] = {CPL_TO_BOOL(bSrcHasNoData),
-                                    CPL_TO_BOOL(bSrcHasNoData),
-                                    CPL_TO_BOOL(bSrcHasNoData)};
-
-    // Create an extra scope for VC12 to ignore i.
-    {
-        for (int i = 0; i < 2 && i < nYSize; i++)
-        {
-            if (GDALRasterIO(hSrcBand, GF_Read, 0, i, nXSize, 1,
-                             pafThreeLineWin + i * nXSize, nXSize, 1, eReadDT,
-                             0, 0) != CE_None)
-            {
-                CPLFree(pafOutputBuf);
-                CPLFree(pafThreeLineWin);
-
-                return CE_Failure;
-            }
-            if (std::numeric_limits<T>::is_integer && bSrcHasNoData)
-            {
-                abLineHasNoDataValue[i] = false;
-                for (int iX = 0; iX < nXSize; iX++)
-                {
-                    if (pafThreeLineWin[i * nXSize + iX] == fSrcNoDataValue)
-                    {
-                        abLineHasNoDataValue[i] = true;
-                        break;
-                    }
-                }
-            }
-        }
-    }  // End extra scope for VC12
-
+    GDALGeneric3x3ProcessingContext<T> sCtx;
+    sCtx.pfnAlg = pfnAlg;
+    sCtx.pfnAlg_multisample = pfnAlg_multisample;
+    sCtx.pData = pData;
+    sCtx.bComputeAtEdges = bComputeAtEdges;
+    sCtx.nXSize = nXSize;
+    sCtx.nYSize = nYSize;
+    sCtx.bSrcHasNoData = CPL_TO_BOOL(bSrcHasNoData);
+    sCtx.fSrcNoDataValue = fSrcNoDataValue;
+    sCtx.bIsSrcNoDataNan = CPL_TO_BOOL(bIsSrcNoDataNan);
+    sCtx.fDstNoDataValue = fDstNoDataValue;
+
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads =
+        std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                      ? CPLGetNumCPUs()
+                                      : atoi(pszThreads)));
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+
+    // Aim at about one million pixels per stripe, so that the overhead of the
+    // overlapping lines stays small, and bound the number of stripes
+    // simultaneously in memory.
+    const int nLinesPerStripe =
+        std::min(nYSize, std::max(8, (1024 * 1024) / nXSize));
+    const size_t nMaxPendingStripes =
+        poJobQueue ? static_cast<size_t>(2 * nThreads) : 1;
+
+    std::mutex oMutex;
+    std::condition_variable oCV;
+    std::deque<std::unique_ptr<GDALGeneric3x3ProcessingStripe<T>>>
+        apoPendingStripes;
     CPLErr eErr = CE_None;
-    if (bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
-    {
-        for (int j = 0; j < nXSize; j++)
-        {
-            int jmin = (j == 0) ? j : j - 1;
-            int jmax = (j == nXSize - 1) ? j : j + 1;
-
-            T afWin[9] = {
-                INTERPOL(pafThreeLineWin[jmin], pafThreeLineWin[nXSize + jmin],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[j], pafThreeLineWin[nXSize + j],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[jmax], pafThreeLineWin[nXSize + jmax],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[jmin],
-                pafThreeLineWin[j],
-                pafThreeLineWin[jmax],
-                pafThreeLineWin[nXSize + jmin],
-                pafThreeLineWin[nXSize + j],
-                pafThreeLineWin[nXSize + jmax]};
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bSrcHasNoData), fSrcNoDataValue,
-                           CPL_TO_BOOL(bIsSrcNoDataNan), afWin, fDstNoDataValue,
-                           pfnAlg, pData, bComputeAtEdges);
-        }
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, 0, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
-    }
-    else
-    {
-        // Exclude the edges
-        for (int j = 0; j < nXSize; j++)
-        {
-            pafOutputBuf[j] = fDstNoDataValue;
-        }
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, 0, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
 
-        if (eErr == CE_None && nYSize > 1)
-        {
-            eErr = GDALRasterIO(hDstBand, GF_Write, 0, nYSize - 1, nXSize, 1,
-                                pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
-        }
-    }
-    if (eErr != CE_None)
+    // Wait for the oldest pending stripe to be computed and write it.
+    const auto FlushOldestStripe = [&]()
     {
-        CPLFree(pafOutputBuf);
-        CPLFree(pafThreeLineWin);
-
-        return eErr;
-    }
-
-    int i = 1;  // Used after for.
-    for (; i < nYSize - 1; i++)
-    {
-        /* Read third line of the line buffer */
-        eErr =
-            GDALRasterIO(hSrcBand, GF_Read, 0, i + 1, nXSize, 1,
-                         pafThreeLineWin + nLine3Off, nXSize, 1, eReadDT, 0, 0);
-        if (eErr != CE_None)
-        {
-            CPLFree(pafOutputBuf);
-            CPLFree(pafThreeLineWin);
-
-            return eErr;
-        }
-
-        // In case none of the 3 lines have nodata values, then no need to
-        // check it in ComputeVal()
-        bool bOneOfThreeLinesHasNoData = CPL_TO_BOOL(bSrcHasNoData);
-        if (std::numeric_limits<T>::is_integer && bSrcHasNoData)
+        auto &poStripe = apoPendingStripes.front();
         {
-            bool bLastLineHasNoDataValue = false;
-            int iX = 0;
-            for (; iX + 3 < nXSize; iX += 4)
-            {
-                if (pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 1] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 2] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 3] == fSrcNoDataValue)
-                {
-                    bLastLineHasNoDataValue = true;
-                    break;
-                }
-            }
-            if (!bLastLineHasNoDataValue)
-            {
-                for (; iX < nXSize; iX++)
-                {
-                    if (pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue)
-                    {
-                        bLastLineHasNoDataValue = true;
-                    }
-                }
-            }
-            abLineHasNoDataValue[nLine3Off / nXSize] = bLastLineHasNoDataValue;
-
-            bOneOfThreeLinesHasNoData = abLineHasNoDataValue[0] ||
-                                        abLineHasNoDataValue[1] ||
-                                        abLineHasNoDataValue[2];
-        }
-
-        if (bComputeAtEdges && nXSize >= 2)
-        {
-            int j = 0;
-            T afWin[9] = {INTERPOL(pafThreeLineWin[nLine1Off + j],
-                                   pafThreeLineWin[nLine1Off + j + 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine1Off + j],
-                          pafThreeLineWin[nLine1Off + j + 1],
-                          INTERPOL(pafThreeLineWin[nLine2Off + j],
-                                   pafThreeLineWin[nLine2Off + j + 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine2Off + j],
-                          pafThreeLineWin[nLine2Off + j + 1],
-                          INTERPOL(pafThreeLineWin[nLine3Off + j],
-                                   pafThreeLineWin[nLine3Off + j + 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine3Off + j],
-                          pafThreeLineWin[nLine3Off + j + 1]};
-
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                           fSrcNoDataValue, CPL_TO_BOOL(bIsSrcNoDataNan), afWin,
-                           fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
+            std::unique_lock<std::mutex> oLock(oMutex);
+            oCV.wait(oLock, [&poStripe] { return poStripe->bDone; });
         }
-        else
+        if (eErr == CE_None)
         {
-            // Exclude the edges
-            pafOutputBuf[0] = fDstNoDataValue;
+            eErr = GDALRasterIO(hDstBand, GF_Write, 0, poStripe->nYOff, nXSize,
+                                poStripe->nYSize, poStripe->aOutput.data(),
+                                nXSize, poStripe->nYSize, GDT_Float32, 0, 0);
         }
-
-        int j = 1;
-        if (pfnAlg_multisample && !bOneOfThreeLinesHasNoData)
+        if (eErr == CE_None &&
+            !pfnProgress(1.0 * (poStripe->nYOff + poStripe->nYSize) / nYSize,
+                         nullptr, pProgressData))
         {
-            j = pfnAlg_multisample(pafThreeLineWin, nLine1Off, nLine2Off,
-                                   nLine3Off, nXSize, pData, pafOutputBuf);
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
         }
+        apoPendingStripes.pop_front();
+    };
 
-        for (; j < nXSize - 1; j++)
+    for (int nYOff = 0; nYOff < nYSize; nYOff += nLinesPerStripe)
+    {
+        while (eErr == CE_None &&
+               apoPendingStripes.size() >= nMaxPendingStripes)
         {
-            T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
-                          pafThreeLineWin[nLine1Off + j],
-                          pafThreeLineWin[nLine1Off + j + 1],
-                          pafThreeLineWin[nLine2Off + j - 1],
-                          pafThreeLineWin[nLine2Off + j],
-                          pafThreeLineWin[nLine2Off + j + 1],
-                          pafThreeLineWin[nLine3Off + j - 1],
-                          pafThreeLineWin[nLine3Off + j],
-                          pafThreeLineWin[nLine3Off + j + 1]};
-
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                           fSrcNoDataValue, CPL_TO_BOOL(bIsSrcNoDataNan), afWin,
-                           fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
+            FlushOldestStripe();
         }
+        if (eErr != CE_None)
+            break;
 
-        if (bComputeAtEdges && nXSize >= 2)
+        auto poStripe = std::make_unique<GDALGeneric3x3ProcessingStripe<T>>();
+        poStripe->psCtx = &sCtx;
+        poStripe->nYOff = nYOff;
+        poStripe->nYSize = std::min(nLinesPerStripe, nYSize - nYOff);
+        poStripe->nSrcYOff = std::max(0, nYOff - 1);
+        poStripe->nSrcYSize =
+            std::min(nYSize, nYOff + poStripe->nYSize + 1) - poStripe->nSrcYOff;
+        poStripe->poMutex = &oMutex;
+        poStripe->poCV = &oCV;
+        try
         {
-            j = nXSize - 1;
-
-            T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
-                          pafThreeLineWin[nLine1Off + j],
-                          INTERPOL(pafThreeLineWin[nLine1Off + j],
-                                   pafThreeLineWin[nLine1Off + j - 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine2Off + j - 1],
-                          pafThreeLineWin[nLine2Off + j],
-                          INTERPOL(pafThreeLineWin[nLine2Off + j],
-                                   pafThreeLineWin[nLine2Off + j - 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine3Off + j - 1],
-                          pafThreeLineWin[nLine3Off + j],
-                          INTERPOL(pafThreeLineWin[nLine3Off + j],
-                                   pafThreeLineWin[nLine3Off + j - 1],
-                                   bSrcHasNoData, fSrcNoDataValue)};
-
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                           fSrcNoDataValue, CPL_TO_BOOL(bIsSrcNoDataNan), afWin,
-                           fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
+            poStripe->aSrc.resize(
+                static_cast<size_t>(poStripe->nSrcYSize) * nXSize + 1);
+            poStripe->aOutput.resize(static_cast<size_t>(poStripe->nYSize) *
+                                     nXSize);
+            poStripe->abSrcLineHasNoData.resize(poStripe->nSrcYSize,
+                                                sCtx.bSrcHasNoData);
         }
-        else
+        catch (const std::bad_alloc &)
         {
-            // Exclude the edges
-            if (nXSize > 1)
-                pafOutputBuf[nXSize - 1] = fDstNoDataValue;
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate stripe buffers");
+            eErr = CE_Failure;
+            break;
         }
 
-        /* -----------------------------------------
-         * Write Line to Raster
-         */
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, i, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
+        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, poStripe->nSrcYOff, nXSize,
+                            poStripe->nSrcYSize, poStripe->aSrc.data(), nXSize,
+                            poStripe->nSrcYSize, eReadDT, 0, 0);
         if (eErr != CE_None)
-        {
-            CPLFree(pafOutputBuf);
-            CPLFree(pafThreeLineWin);
-
-            return eErr;
-        }
+            break;
 
-        if (!pfnProgress(1.0 * (i + 1) / nYSize, nullptr, pProgressData))
+        if (std::numeric_limits<T>::is_integer && bSrcHasNoData)
         {
-            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-            eErr = CE_Failure;
-
-            CPLFree(pafOutputBuf);
-            CPLFree(pafThreeLineWin);
-
-            return eErr;
+            for (int iLine = 0; iLine < poStripe->nSrcYSize; iLine++)
+            {
+                const T *pafLine = poStripe->aSrc.data() +
+                                   static_cast<size_t>(iLine) * nXSize;
+                poStripe->abSrcLineHasNoData[iLine] =
+                    std::find(pafLine, pafLine + nXSize, fSrcNoDataValue) !=
+                    pafLine + nXSize;
+            }
         }
 
-        const int nTemp = nLine1Off;
-        nLine1Off = nLine2Off;
-        nLine2Off = nLine3Off;
-        nLine3Off = nTemp;
-    }
-
-    if (bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
-    {
-        for (int j = 0; j < nXSize; j++)
-        {
-            int jmin = (j == 0) ? j : j - 1;
-            int jmax = (j == nXSize - 1) ? j : j + 1;
-
-            T afWin[9] = {
-                pafThreeLineWin[nLine1Off + jmin],
-                pafThreeLineWin[nLine1Off + j],
-                pafThreeLineWin[nLine1Off + jmax],
-                pafThreeLineWin[nLine2Off + jmin],
-                pafThreeLineWin[nLine2Off + j],
-                pafThreeLineWin[nLine2Off + jmax],
-                INTERPOL(pafThreeLineWin[nLine2Off + jmin],
-                         pafThreeLineWin[nLine1Off + jmin], bSrcHasNoData,
-                         fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[nLine2Off + j],
-                         pafThreeLineWin[nLine1Off + j], bSrcHasNoData,
-                         fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[nLine2Off + jmax],
-                         pafThreeLineWin[nLine1Off + jmax], bSrcHasNoData,
-                         fSrcNoDataValue),
-            };
-
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bSrcHasNoData), fSrcNoDataValue,
-                           CPL_TO_BOOL(bIsSrcNoDataNan), afWin, fDstNoDataValue,
-                           pfnAlg, pData, bComputeAtEdges);
-        }
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, i, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
-        if (eErr != CE_None)
+        if (!poJobQueue ||
+            !poJobQueue->SubmitJob(GDALGeneric3x3ProcessingJob<T>,
+                                   poStripe.get()))
         {
-            CPLFree(pafOutputBuf);
-            CPLFree(pafThreeLineWin);
-
-            return eErr;
+            GDALGeneric3x3ProcessStripe(*poStripe);
+            poStripe->bDone = true;
         }
+        apoPendingStripes.push_back(std::move(poStripe));
     }
 
-    pfnProgress(1.0, nullptr, pProgressData);
-    eErr = CE_None;
+    // Also done on error, so that no job is still using the stripes when
+    // they are freed.
+    while (!apoPendingStripes.empty())
+        FlushOldestStripe();
+    if (poJobQueue)
+        poJobQueue->WaitCompletion();
 
-    CPLFree(pafOutputBuf);
-    CPLFree(pafThreeLineWin);
+    if (eErr == CE_None)
+        pfnProgress(1.0, nullptr, pProgressData);
 
     return eErr;
 }
@@ -996,6 +1119,90 @@ GDALHillshadeAlg_same_res_multisample(const T *pafThreeLineWin, int nLine1Off,
     const __m128 reg_one_float = _mm_set1_ps(1);
 
     int j = 1;  // Used after for.
+#ifdef __AVX2__
+    const __m256d reg_fact_x_8 = _mm256_set1_pd(
+        psData->sin_az_mul_cos_alt_mul_z_mul_254_mul_inv_res);
+    const __m256d reg_fact_y_8 = _mm256_set1_pd(
+        psData->cos_az_mul_cos_alt_mul_z_mul_254_mul_inv_res);
+    const __m256d reg_constant_num_8 =
+        _mm256_set1_pd(psData->sin_altRadians_mul_254);
+    const __m256d reg_constant_denom_8 =
+        _mm256_set1_pd(psData->square_z_mul_square_inv_res);
+    const __m256d reg_half_8 = _mm256_set1_pd(0.5);
+    const __m256d reg_one_8 = _mm256_set1_pd(1.0);
+    const __m256d reg_one_and_a_half_8 = _mm256_set1_pd(1.5);
+    const __m256 reg_one_float_8 = _mm256_set1_ps(1);
+    for (; j < nXSize - 8; j += 8)
+    {
+        const T *firstLine = pafThreeLineWin + nLine1Off + j - 1;
+        const T *secondLine = pafThreeLineWin + nLine2Off + j - 1;
+        const T *thirdLine = pafThreeLineWin + nLine3Off + j - 1;
+
+        const __m256i firstLine0 =
+            _mm256_loadu_si256(reinterpret_cast<__m256i const *>(firstLine));
+        const __m256i firstLine1 = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const *>(firstLine + 1));
+        const __m256i firstLine2 = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const *>(firstLine + 2));
+        const __m256i thirdLine0 =
+            _mm256_loadu_si256(reinterpret_cast<__m256i const *>(thirdLine));
+        const __m256i thirdLine1 = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const *>(thirdLine + 1));
+        const __m256i thirdLine2 = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const *>(thirdLine + 2));
+        __m256i accX = _mm256_sub_epi32(firstLine0, thirdLine2);
+        const __m256i six_minus_two = _mm256_sub_epi32(thirdLine0, firstLine2);
+        __m256i accY = accX;
+        const __m256i three_minus_five = _mm256_sub_epi32(
+            _mm256_loadu_si256(reinterpret_cast<__m256i const *>(secondLine)),
+            _mm256_loadu_si256(
+                reinterpret_cast<__m256i const *>(secondLine + 2)));
+        const __m256i one_minus_seven =
+            _mm256_sub_epi32(firstLine1, thirdLine1);
+        accX = _mm256_add_epi32(accX, three_minus_five);
+        accY = _mm256_add_epi32(accY, one_minus_seven);
+        accX = _mm256_add_epi32(accX, three_minus_five);
+        accY = _mm256_add_epi32(accY, one_minus_seven);
+        accX = _mm256_add_epi32(accX, six_minus_two);
+        accY = _mm256_sub_epi32(accY, six_minus_two);
+
+        __m128 res[2];
+        for (int k = 0; k < 2; k++)
+        {
+            const __m256d reg_x = _mm256_cvtepi32_pd(
+                k == 0 ? _mm256_castsi256_si128(accX)
+                       : _mm256_extracti128_si256(accX, 1));
+            const __m256d reg_y = _mm256_cvtepi32_pd(
+                k == 0 ? _mm256_castsi256_si128(accY)
+                       : _mm256_extracti128_si256(accY, 1));
+            const __m256d reg_xx_plus_yy = _mm256_add_pd(
+                _mm256_mul_pd(reg_x, reg_x), _mm256_mul_pd(reg_y, reg_y));
+            __m256d reg_numerator = _mm256_add_pd(
+                reg_constant_num_8,
+                _mm256_add_pd(_mm256_mul_pd(reg_fact_x_8, reg_x),
+                              _mm256_mul_pd(reg_fact_y_8, reg_y)));
+            __m256d regB = _mm256_add_pd(
+                reg_one_8, _mm256_mul_pd(reg_constant_denom_8, reg_xx_plus_yy));
+            const __m256d regB_half = _mm256_mul_pd(regB, reg_half_8);
+            // Same approximation of 1 / sqrt(b) as the SSE2 code path below,
+            // so that results do not depend on the code path.
+            regB = _mm256_cvtps_pd(_mm_rsqrt_ps(_mm256_cvtpd_ps(regB)));
+            regB = _mm256_mul_pd(
+                regB, _mm256_sub_pd(reg_one_and_a_half_8,
+                                    _mm256_mul_pd(regB_half,
+                                                  _mm256_mul_pd(regB, regB))));
+            reg_numerator = _mm256_mul_pd(reg_numerator, regB);
+            res[k] = _mm256_cvtpd_ps(reg_numerator);
+        }
+
+        __m256 res8 = _mm256_insertf128_ps(_mm256_castps128_ps256(res[0]),
+                                           res[1], 1);
+        res8 = _mm256_add_ps(res8, reg_one_float_8);
+        res8 = _mm256_max_ps(res8, reg_one_float_8);
+
+        _mm256_storeu_ps(pafOutputBuf + j, res8);
+    }
+#endif
     for (; j < nXSize - 4; j += 4)
     {
         const T *firstLine = pafThreeLineWin + nLine1Off + j - 1;
@@ -1290,6 +1497,171 @@ static float GDALSlopeHornAlg(const T *afWin, float /*fDstNoDataValue*/,
     return static_cast<float>(100 * (sqrt(key) / (8 * psData->scale)));
 }
 
+#ifdef HAVE_16_SSE_REG
+template <class T>
+static int GDALSlopeHornAlg_multisample(const T *pafThreeLineWin,
+                                        int nLine1Off, int nLine2Off,
+                                        int nLine3Off, int nXSize, void *pData,
+                                        float *pafOutputBuf)
+{
+    // Only valid for T == int
+
+    const GDALSlopeAlgData *psData =
+        static_cast<const GDALSlopeAlgData *>(pData);
+    const double dfDenom = 8 * psData->scale;
+    const bool bDegrees = psData->slopeFormat == 1;
+    double adfSlope[8];
+
+    int j = 1;  // Used after for.
+#ifdef __AVX2__
+    const __m256d reg_ewres_8 = _mm256_set1_pd(psData->ewres);
+    const __m256d reg_nsres_8 = _mm256_set1_pd(psData->nsres);
+    const __m256d reg_denom_8 = _mm256_set1_pd(dfDenom);
+    const __m256d reg_hundred_8 = _mm256_set1_pd(100.0);
+    for (; j < nXSize - 8; j += 8)
+    {
+        const T *firstLine = pafThreeLineWin + nLine1Off + j - 1;
+        const T *secondLine = pafThreeLineWin + nLine2Off + j - 1;
+        const T *thirdLine = pafThreeLineWin + nLine3Off + j - 1;
+
+        const __m256i firstLine0 =
+            _mm256_loadu_si256(reinterpret_cast<__m256i const *>(firstLine));
+        const __m256i firstLine1 = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const *>(firstLine + 1));
+        const __m256i firstLine2 = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const *>(firstLine + 2));
+        const __m256i thirdLine0 =
+            _mm256_loadu_si256(reinterpret_cast<__m256i const *>(thirdLine));
+        const __m256i thirdLine1 = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const *>(thirdLine + 1));
+        const __m256i thirdLine2 = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const *>(thirdLine + 2));
+        // (0 + 3 + 3 + 6) - (2 + 5 + 5 + 8)
+        const __m256i three_minus_five = _mm256_sub_epi32(
+            _mm256_loadu_si256(reinterpret_cast<__m256i const *>(secondLine)),
+            _mm256_loadu_si256(
+                reinterpret_cast<__m256i const *>(secondLine + 2)));
+        __m256i accX = _mm256_sub_epi32(firstLine0, firstLine2);
+        accX = _mm256_add_epi32(accX, three_minus_five);
+        accX = _mm256_add_epi32(accX, three_minus_five);
+        accX = _mm256_add_epi32(accX, _mm256_sub_epi32(thirdLine0, thirdLine2));
+        // (6 + 7 + 7 + 8) - (0 + 1 + 1 + 2)
+        const __m256i seven_minus_one =
+            _mm256_sub_epi32(thirdLine1, firstLine1);
+        __m256i accY = _mm256_sub_epi32(thirdLine0, firstLine0);
+        accY = _mm256_add_epi32(accY, seven_minus_one);
+        accY = _mm256_add_epi32(accY, seven_minus_one);
+        accY = _mm256_add_epi32(accY, _mm256_sub_epi32(thirdLine2, firstLine2));
+
+        __m128 res[2];
+        for (int k = 0; k < 2; k++)
+        {
+            const __m128i accX_half = k == 0
+                                          ? _mm256_castsi256_si128(accX)
+                                          : _mm256_extracti128_si256(accX, 1);
+            const __m128i accY_half = k == 0
+                                          ? _mm256_castsi256_si128(accY)
+                                          : _mm256_extracti128_si256(accY, 1);
+            const __m256d reg_dx =
+                _mm256_div_pd(_mm256_cvtepi32_pd(accX_half), reg_ewres_8);
+            const __m256d reg_dy =
+                _mm256_div_pd(_mm256_cvtepi32_pd(accY_half), reg_nsres_8);
+            const __m256d reg_key = _mm256_add_pd(
+                _mm256_mul_pd(reg_dx, reg_dx), _mm256_mul_pd(reg_dy, reg_dy));
+            const __m256d reg_slope =
+                _mm256_div_pd(_mm256_sqrt_pd(reg_key), reg_denom_8);
+            if (bDegrees)
+                _mm256_storeu_pd(adfSlope + 4 * k, reg_slope);
+            else
+                res[k] =
+                    _mm256_cvtpd_ps(_mm256_mul_pd(reg_hundred_8, reg_slope));
+        }
+
+        if (bDegrees)
+        {
+            for (int k = 0; k < 8; k++)
+                pafOutputBuf[j + k] = static_cast<float>(atan(adfSlope[k]) *
+                                                         kdfRadiansToDegrees);
+        }
+        else
+        {
+            _mm_storeu_ps(pafOutputBuf + j, res[0]);
+            _mm_storeu_ps(pafOutputBuf + j + 4, res[1]);
+        }
+    }
+#endif
+
+    const __m128d reg_ewres = _mm_set1_pd(psData->ewres);
+    const __m128d reg_nsres = _mm_set1_pd(psData->nsres);
+    const __m128d reg_denom = _mm_set1_pd(dfDenom);
+    const __m128d reg_hundred = _mm_set1_pd(100.0);
+    for (; j < nXSize - 4; j += 4)
+    {
+        const T *firstLine = pafThreeLineWin + nLine1Off + j - 1;
+        const T *secondLine = pafThreeLineWin + nLine2Off + j - 1;
+        const T *thirdLine = pafThreeLineWin + nLine3Off + j - 1;
+
+        const __m128i firstLine0 =
+            _mm_loadu_si128(reinterpret_cast<__m128i const *>(firstLine));
+        const __m128i firstLine1 =
+            _mm_loadu_si128(reinterpret_cast<__m128i const *>(firstLine + 1));
+        const __m128i firstLine2 =
+            _mm_loadu_si128(reinterpret_cast<__m128i const *>(firstLine + 2));
+        const __m128i thirdLine0 =
+            _mm_loadu_si128(reinterpret_cast<__m128i const *>(thirdLine));
+        const __m128i thirdLine1 =
+            _mm_loadu_si128(reinterpret_cast<__m128i const *>(thirdLine + 1));
+        const __m128i thirdLine2 =
+            _mm_loadu_si128(reinterpret_cast<__m128i const *>(thirdLine + 2));
+        // (0 + 3 + 3 + 6) - (2 + 5 + 5 + 8)
+        const __m128i three_minus_five = _mm_sub_epi32(
+            _mm_loadu_si128(reinterpret_cast<__m128i const *>(secondLine)),
+            _mm_loadu_si128(reinterpret_cast<__m128i const *>(secondLine + 2)));
+        __m128i accX = _mm_sub_epi32(firstLine0, firstLine2);
+        accX = _mm_add_epi32(accX, three_minus_five);
+        accX = _mm_add_epi32(accX, three_minus_five);
+        accX = _mm_add_epi32(accX, _mm_sub_epi32(thirdLine0, thirdLine2));
+        // (6 + 7 + 7 + 8) - (0 + 1 + 1 + 2)
+        const __m128i seven_minus_one = _mm_sub_epi32(thirdLine1, firstLine1);
+        __m128i accY = _mm_sub_epi32(thirdLine0, firstLine0);
+        accY = _mm_add_epi32(accY, seven_minus_one);
+        accY = _mm_add_epi32(accY, seven_minus_one);
+        accY = _mm_add_epi32(accY, _mm_sub_epi32(thirdLine2, firstLine2));
+
+        __m128 res[2];
+        for (int k = 0; k < 2; k++)
+        {
+            const __m128i accX_half = k == 0 ? accX : _mm_srli_si128(accX, 8);
+            const __m128i accY_half = k == 0 ? accY : _mm_srli_si128(accY, 8);
+            const __m128d reg_dx =
+                _mm_div_pd(_mm_cvtepi32_pd(accX_half), reg_ewres);
+            const __m128d reg_dy =
+                _mm_div_pd(_mm_cvtepi32_pd(accY_half), reg_nsres);
+            const __m128d reg_key = _mm_add_pd(_mm_mul_pd(reg_dx, reg_dx),
+                                               _mm_mul_pd(reg_dy, reg_dy));
+            const __m128d reg_slope =
+                _mm_div_pd(_mm_sqrt_pd(reg_key), reg_denom);
+            if (bDegrees)
+                _mm_storeu_pd(adfSlope + 2 * k, reg_slope);
+            else
+                res[k] = _mm_cvtpd_ps(_mm_mul_pd(reg_hundred, reg_slope));
+        }
+
+        if (bDegrees)
+        {
+            for (int k = 0; k < 4; k++)
+                pafOutputBuf[j + k] = static_cast<float>(atan(adfSlope[k]) *
+                                                         kdfRadiansToDegrees);
+        }
+        else
+        {
+            _mm_storeu_ps(pafOutputBuf + j, _mm_movelh_ps(res[0], res[1]));
+        }
+    }
+    return j;
+}
+#endif
+
 template <class T>
 static float GDALSlopeZevenbergenThorneAlg(const T *afWin,
                                            float /*fDstNoDataValue*/,
@@ -3490,6 +3862,9 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
         {
             pfnAlgFloat = GDALSlopeHornAlg<float>;
             pfnAlgInt32 = GDALSlopeHornAlg<GInt32>;
+#ifdef HAVE_16_SSE_REG
+            pfnAlgInt32_multisample = GDALSlopeHornAlg_multisample<GInt32>;
+#endif
         }
     }
 
@@ -33,6 +33,9 @@
 #include "gdal.h"
 #include "commonutils.h"
 #include "ogr_spatialref.h"
+
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 #ifdef _WIN32
@@ -52,6 +55,7 @@ static void Usage(bool bIsError)
         bIsError ? stderr : stdout,
         "Usage: gdallocationinfo [--help] [--help-general]\n"
         "                        [-xml] [-lifonly] [-valonly]\n"
+        "                        [-r {nearest|bilinear|cubic}] [-batch]\n"
         "                        [-b <band>]... [-overview <overview_level>]\n"
         "                        [-l_srs <srs_def>] [-geoloc] [-wgs84]\n"
         "                        [-oo <NAME>=<VALUE>]... <srcfile> [<x> <y>]\n"
@@ -59,6 +63,17 @@ static void Usage(bool bIsError)
     exit(1);
 }
 
+/************************************************************************/
+/*                        GetLocationInOverview()                       */
+/************************************************************************/
+
+static int GetLocationInOverview(int iLoc, int nSize, int nOvrSize)
+{
+    const int iLocInOvr =
+        static_cast<int>(0.5 + 1.0 * iLoc / nSize * nOvrSize);
+    return std::min(iLocInOvr, nOvrSize - 1);
+}
+
 /************************************************************************/
 /*                             SanitizeSRS                              */
 /************************************************************************/
@@ -100,6 +115,8 @@ MAIN_START(argc, argv)
     bool bQuiet = false, bValOnly = false;
     int nOverview = -1;
     char **papszOpenOptions = nullptr;
+    GDALRIOResampleAlg eResampleAlg = GRIORA_NearestNeighbour;
+    bool bBatch = false;
 
     GDALAllRegister();
     argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
@@ -166,6 +183,26 @@ MAIN_START(argc, argv)
         {
             papszOpenOptions = CSLAddString(papszOpenOptions, argv[++i]);
         }
+        else if (i < argc - 1 && EQUAL(argv[i], "-r"))
+        {
+            const char *pszResampling = argv[++i];
+            if (EQUAL(pszResampling, "nearest"))
+                eResampleAlg = GRIORA_NearestNeighbour;
+            else if (EQUAL(pszResampling, "bilinear"))
+                eResampleAlg = GRIORA_Bilinear;
+            else if (EQUAL(pszResampling, "cubic"))
+                eResampleAlg = GRIORA_Cubic;
+            else
+            {
+                fprintf(stderr, "Unsupported resampling method: %s\n",
+                        pszResampling);
+                Usage(true);
+            }
+        }
+        else if (EQUAL(argv[i], "-batch"))
+        {
+            bBatch = true;
+        }
         else if (argv[i][0] == '-' &&
                  !isdigit(static_cast<unsigned char>(argv[i][1])))
             Usage(true);
@@ -224,12 +261,16 @@ MAIN_START(argc, argv)
     }
 
     /* -------------------------------------------------------------------- */
-    /*      Turn the location into a pixel and line location.               */
+    /*      Read the locations, by batches in batch mode.                   */
     /* -------------------------------------------------------------------- */
-    int inputAvailable = 1;
-    double dfGeoX;
-    double dfGeoY;
     CPLString osXML;
+    std::vector<double> adfGeoX;
+    std::vector<double> adfGeoY;
+    std::vector<double> adfPixel;
+    std::vector<double> adfLine;
+    std::vector<double> adfRealValues;
+    std::vector<double> adfImagValues;
+    std::vector<bool> abValuesOK;
 
     if (pszLocX == nullptr && pszLocY == nullptr)
     {
@@ -248,29 +289,53 @@ MAIN_START(argc, argv)
                                 "and press Return.\n");
             }
         }
-
-        if (fscanf(stdin, "%lf %lf", &dfGeoX, &dfGeoY) != 2)
-        {
-            inputAvailable = 0;
-        }
-    }
-    else
-    {
-        dfGeoX = CPLAtof(pszLocX);
-        dfGeoY = CPLAtof(pszLocY);
     }
 
     int nRetCode = 0;
-    while (inputAvailable)
+    bool bInputAvailable = true;
+    while (bInputAvailable)
     {
-        int iPixel, iLine;
+        adfGeoX.clear();
+        adfGeoY.clear();
+        if (pszLocX != nullptr)
+        {
+            adfGeoX.push_back(CPLAtof(pszLocX));
+            adfGeoY.push_back(CPLAtof(pszLocY));
+            bInputAvailable = false;
+        }
+        else
+        {
+            constexpr size_t MAX_BATCH_SIZE = 1000 * 1000;
+            while (adfGeoX.empty() ||
+                   (bBatch && adfGeoX.size() < MAX_BATCH_SIZE))
+            {
+                double dfGeoX = 0;
+                double dfGeoY = 0;
+                if (fscanf(stdin, "%lf %lf", &dfGeoX, &dfGeoY) != 2)
+                {
+                    bInputAvailable = false;
+                    break;
+                }
+                adfGeoX.push_back(dfGeoX);
+                adfGeoY.push_back(dfGeoY);
+            }
+        }
+        const size_t nPoints = adfGeoX.size();
+        if (nPoints == 0)
+            break;
 
+        /* ---------------------------------------------------------------- */
+        /*      Turn the locations into pixel and line locations.           */
+        /* ---------------------------------------------------------------- */
         if (hCT)
         {
-            if (!OCTTransform(hCT, 1, &dfGeoX, &dfGeoY, nullptr))
+            if (!OCTTransform(hCT, static_cast<int>(nPoints), adfGeoX.data(),
+                              adfGeoY.data(), nullptr))
                 exit(1);
         }
 
+        adfPixel = adfGeoX;
+        adfLine = adfGeoY;
         if (pszSourceSRS != nullptr)
         {
             double adfGeoTransform[6] = {};
@@ -289,243 +354,271 @@ MAIN_START(argc, argv)
                 exit(1);
             }
 
-            iPixel = static_cast<int>(floor(adfInvGeoTransform[0] +
-                                            adfInvGeoTransform[1] * dfGeoX +
-                                            adfInvGeoTransform[2] * dfGeoY));
-            iLine = static_cast<int>(floor(adfInvGeoTransform[3] +
-                                           adfInvGeoTransform[4] * dfGeoX +
-                                           adfInvGeoTransform[5] * dfGeoY));
-        }
-        else
-        {
-            iPixel = static_cast<int>(floor(dfGeoX));
-            iLine = static_cast<int>(floor(dfGeoY));
-        }
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Prepare report. */
-        /* --------------------------------------------------------------------
-         */
-        CPLString osLine;
-
-        if (bAsXML)
-        {
-            osLine.Printf("<Report pixel=\"%d\" line=\"%d\">", iPixel, iLine);
-            osXML += osLine;
-        }
-        else if (!bQuiet)
-        {
-            printf("Report:\n");
-            printf("  Location: (%dP,%dL)\n", iPixel, iLine);
-        }
-
-        bool bPixelReport = true;
-
-        if (iPixel < 0 || iLine < 0 || iPixel >= GDALGetRasterXSize(hSrcDS) ||
-            iLine >= GDALGetRasterYSize(hSrcDS))
-        {
-            if (bAsXML)
-                osXML += "<Alert>Location is off this file! No further details "
-                         "to report.</Alert>";
-            else if (bValOnly)
-                printf("\n");
-            else if (!bQuiet)
-                printf("\nLocation is off this file! No further details to "
-                       "report.\n");
-            bPixelReport = false;
-            nRetCode = 1;
+            for (size_t iPoint = 0; iPoint < nPoints; ++iPoint)
+            {
+                adfPixel[iPoint] = adfInvGeoTransform[0] +
+                                   adfInvGeoTransform[1] * adfGeoX[iPoint] +
+                                   adfInvGeoTransform[2] * adfGeoY[iPoint];
+                adfLine[iPoint] = adfInvGeoTransform[3] +
+                                  adfInvGeoTransform[4] * adfGeoX[iPoint] +
+                                  adfInvGeoTransform[5] * adfGeoY[iPoint];
+            }
         }
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Process each band. */
-        /* --------------------------------------------------------------------
-         */
-        for (int i = 0; bPixelReport && i < static_cast<int>(anBandList.size());
-             i++)
+        /* ---------------------------------------------------------------- */
+        /*      Fetch the values of all locations for each band.            */
+        /* ---------------------------------------------------------------- */
+        const size_t nBands = anBandList.size();
+        std::vector<GDALRasterBandH> ahBands(nBands);
+        adfRealValues.resize(nBands * nPoints);
+        adfImagValues.resize(nBands * nPoints);
+        abValuesOK.resize(nBands);
+        for (size_t iBand = 0; iBand < nBands; ++iBand)
         {
-            GDALRasterBandH hBand = GDALGetRasterBand(hSrcDS, anBandList[i]);
+            GDALRasterBandH hBand =
+                GDALGetRasterBand(hSrcDS, anBandList[iBand]);
+            abValuesOK[iBand] = false;
 
-            int iPixelToQuery = iPixel;
-            int iLineToQuery = iLine;
+            std::vector<double> adfPixelToQuery(adfPixel);
+            std::vector<double> adfLineToQuery(adfLine);
 
             if (nOverview >= 0 && hBand != nullptr)
             {
                 GDALRasterBandH hOvrBand = GDALGetOverview(hBand, nOverview);
                 if (hOvrBand != nullptr)
                 {
-                    int nOvrXSize = GDALGetRasterBandXSize(hOvrBand);
-                    int nOvrYSize = GDALGetRasterBandYSize(hOvrBand);
-                    iPixelToQuery = static_cast<int>(
-                        0.5 +
-                        1.0 * iPixel / GDALGetRasterXSize(hSrcDS) * nOvrXSize);
-                    iLineToQuery = static_cast<int>(
-                        0.5 +
-                        1.0 * iLine / GDALGetRasterYSize(hSrcDS) * nOvrYSize);
-                    if (iPixelToQuery >= nOvrXSize)
-                        iPixelToQuery = nOvrXSize - 1;
-                    if (iLineToQuery >= nOvrYSize)
-                        iLineToQuery = nOvrYSize - 1;
+                    const int nOvrXSize = GDALGetRasterBandXSize(hOvrBand);
+                    const int nOvrYSize = GDALGetRasterBandYSize(hOvrBand);
+                    for (size_t iPoint = 0; iPoint < nPoints; ++iPoint)
+                    {
+                        if (eResampleAlg == GRIORA_NearestNeighbour)
+                        {
+                            adfPixelToQuery[iPoint] =
+                                GetLocationInOverview(
+                                    static_cast<int>(floor(adfPixel[iPoint])),
+                                    GDALGetRasterXSize(hSrcDS), nOvrXSize) +
+                                0.5;
+                            adfLineToQuery[iPoint] =
+                                GetLocationInOverview(
+                                    static_cast<int>(floor(adfLine[iPoint])),
+                                    GDALGetRasterYSize(hSrcDS), nOvrYSize) +
+                                0.5;
+                        }
+                        else
+                        {
+                            adfPixelToQuery[iPoint] =
+                                adfPixel[iPoint] * nOvrXSize /
+                                GDALGetRasterXSize(hSrcDS);
+                            adfLineToQuery[iPoint] =
+                                adfLine[iPoint] * nOvrYSize /
+                                GDALGetRasterYSize(hSrcDS);
+                        }
+                    }
                 }
                 else
                 {
                     CPLError(CE_Failure, CPLE_AppDefined,
                              "Cannot get overview %d of band %d", nOverview + 1,
-                             anBandList[i]);
+                             anBandList[iBand]);
                 }
                 hBand = hOvrBand;
             }
+            ahBands[iBand] = hBand;
+
+            if (hBand != nullptr)
+            {
+                abValuesOK[iBand] =
+                    GDALRasterSamplePoints(
+                        hBand, nPoints, adfPixelToQuery.data(),
+                        adfLineToQuery.data(), eResampleAlg,
+                        adfRealValues.data() + iBand * nPoints,
+                        adfImagValues.data() + iBand * nPoints) == CE_None;
+            }
+        }
 
-            if (hBand == nullptr)
-                continue;
+        for (size_t iPoint = 0; iPoint < nPoints; ++iPoint)
+        {
+            const int iPixel = static_cast<int>(floor(adfPixel[iPoint]));
+            const int iLine = static_cast<int>(floor(adfLine[iPoint]));
+
+            /* ------------------------------------------------------------ */
+            /*      Prepare report.                                         */
+            /* ------------------------------------------------------------ */
+            CPLString osLine;
 
             if (bAsXML)
             {
-                osLine.Printf("<BandReport band=\"%d\">", anBandList[i]);
+                osLine.Printf("<Report pixel=\"%d\" line=\"%d\">", iPixel,
+                              iLine);
                 osXML += osLine;
             }
             else if (!bQuiet)
             {
-                printf("  Band %d:\n", anBandList[i]);
+                printf("Report:\n");
+                printf("  Location: (%dP,%dL)\n", iPixel, iLine);
             }
 
-            /* --------------------------------------------------------------------
-             */
-            /*      Request location info for this location.  It is possible */
-            /*      only the VRT driver actually supports this. */
-            /* --------------------------------------------------------------------
-             */
-            CPLString osItem;
-
-            osItem.Printf("Pixel_%d_%d", iPixelToQuery, iLineToQuery);
-
-            const char *pszLI =
-                GDALGetMetadataItem(hBand, osItem, "LocationInfo");
+            bool bPixelReport = true;
 
-            if (pszLI != nullptr)
+            if (iPixel < 0 || iLine < 0 ||
+                iPixel >= GDALGetRasterXSize(hSrcDS) ||
+                iLine >= GDALGetRasterYSize(hSrcDS))
             {
                 if (bAsXML)
-                    osXML += pszLI;
+                    osXML += "<Alert>Location is off this file! No further "
+                             "details to report.</Alert>";
+                else if (bValOnly)
+                    printf("\n");
                 else if (!bQuiet)
-                    printf("    %s\n", pszLI);
-                else if (bLIFOnly)
-                {
-                    /* Extract all files, if any. */
-
-                    CPLXMLNode *psRoot = CPLParseXMLString(pszLI);
-
-                    if (psRoot != nullptr && psRoot->psChild != nullptr &&
-                        psRoot->eType == CXT_Element &&
-                        EQUAL(psRoot->pszValue, "LocationInfo"))
-                    {
-                        for (CPLXMLNode *psNode = psRoot->psChild;
-                             psNode != nullptr; psNode = psNode->psNext)
-                        {
-                            if (psNode->eType == CXT_Element &&
-                                EQUAL(psNode->pszValue, "File") &&
-                                psNode->psChild != nullptr)
-                            {
-                                char *pszUnescaped =
-                                    CPLUnescapeString(psNode->psChild->pszValue,
-                                                      nullptr, CPLES_XML);
-                                printf("%s\n", pszUnescaped);
-                                CPLFree(pszUnescaped);
-                            }
-                        }
-                    }
-                    CPLDestroyXMLNode(psRoot);
-                }
+                    printf("\nLocation is off this file! No further details "
+                           "to report.\n");
+                bPixelReport = false;
+                nRetCode = 1;
             }
 
-            /* --------------------------------------------------------------------
-             */
-            /*      Report the pixel value of this band. */
-            /* --------------------------------------------------------------------
-             */
-            double adfPixel[2] = {0, 0};
-            const bool bIsComplex = CPL_TO_BOOL(
-                GDALDataTypeIsComplex(GDALGetRasterDataType(hBand)));
-
-            if (GDALRasterIO(hBand, GF_Read, iPixelToQuery, iLineToQuery, 1, 1,
-                             adfPixel, 1, 1,
-                             bIsComplex ? GDT_CFloat64 : GDT_Float64, 0,
-                             0) == CE_None)
+            /* ------------------------------------------------------------ */
+            /*      Process each band.                                      */
+            /* ------------------------------------------------------------ */
+            for (size_t iBand = 0; bPixelReport && iBand < nBands; iBand++)
             {
-                CPLString osValue;
+                GDALRasterBandH hBand = ahBands[iBand];
+                if (hBand == nullptr)
+                    continue;
 
-                if (bIsComplex)
-                    osValue.Printf("%.15g+%.15gi", adfPixel[0], adfPixel[1]);
-                else
-                    osValue.Printf("%.15g", adfPixel[0]);
+                int iPixelToQuery = iPixel;
+                int iLineToQuery = iLine;
+                if (nOverview >= 0)
+                {
+                    iPixelToQuery = GetLocationInOverview(
+                        iPixel, GDALGetRasterXSize(hSrcDS),
+                        GDALGetRasterBandXSize(hBand));
+                    iLineToQuery = GetLocationInOverview(
+                        iLine, GDALGetRasterYSize(hSrcDS),
+                        GDALGetRasterBandYSize(hBand));
+                }
 
                 if (bAsXML)
                 {
-                    osXML += "<Value>";
-                    osXML += osValue;
-                    osXML += "</Value>";
+                    osLine.Printf("<BandReport band=\"%d\">",
+                                  anBandList[iBand]);
+                    osXML += osLine;
                 }
                 else if (!bQuiet)
-                    printf("    Value: %s\n", osValue.c_str());
-                else if (bValOnly)
-                    printf("%s\n", osValue.c_str());
-
-                // Report unscaled if we have scale/offset values.
-                int bSuccess;
-
-                double dfOffset = GDALGetRasterOffset(hBand, &bSuccess);
-                // TODO: Should we turn on checking of bSuccess?
-                // Alternatively, delete these checks and put a comment as to
-                // why checking bSuccess does not matter.
-#if 0
-                if (bSuccess == FALSE)
                 {
-                    CPLError( CE_Debug, CPLE_AppDefined,
-                              "Unable to get raster offset." );
+                    printf("  Band %d:\n", anBandList[iBand]);
                 }
-#endif
-                double dfScale = GDALGetRasterScale(hBand, &bSuccess);
-#if 0
-                if (bSuccess == FALSE)
+
+                /* -------------------------------------------------------- */
+                /*      Request location info for this location.  It is    */
+                /*      possible only the VRT driver actually supports      */
+                /*      this.                                               */
+                /* -------------------------------------------------------- */
+                CPLString osItem;
+
+                osItem.Printf("Pixel_%d_%d", iPixelToQuery, iLineToQuery);
+
+                const char *pszLI =
+                    GDALGetMetadataItem(hBand, osItem, "LocationInfo");
+
+                if (pszLI != nullptr)
                 {
-                    CPLError( CE_Debug, CPLE_AppDefined,
-                              "Unable to get raster scale." );
+                    if (bAsXML)
+                        osXML += pszLI;
+                    else if (!bQuiet)
+                        printf("    %s\n", pszLI);
+                    else if (bLIFOnly)
+                    {
+                        /* Extract all files, if any. */
+
+                        CPLXMLNode *psRoot = CPLParseXMLString(pszLI);
+
+                        if (psRoot != nullptr && psRoot->psChild != nullptr &&
+                            psRoot->eType == CXT_Element &&
+                            EQUAL(psRoot->pszValue, "LocationInfo"))
+                        {
+                            for (CPLXMLNode *psNode = psRoot->psChild;
+                                 psNode != nullptr; psNode = psNode->psNext)
+                            {
+                                if (psNode->eType == CXT_Element &&
+                                    EQUAL(psNode->pszValue, "File") &&
+                                    psNode->psChild != nullptr)
+                                {
+                                    char *pszUnescaped = CPLUnescapeString(
+                                        psNode->psChild->pszValue, nullptr,
+                                        CPLES_XML);
+                                    printf("%s\n", pszUnescaped);
+                                    CPLFree(pszUnescaped);
+                                }
+                            }
+                        }
+                        CPLDestroyXMLNode(psRoot);
+                    }
                 }
-#endif
-                if (dfOffset != 0.0 || dfScale != 1.0)
+
+                /* -------------------------------------------------------- */
+                /*      Report the pixel value of this band.                */
+                /* -------------------------------------------------------- */
+                if (abValuesOK[iBand])
                 {
-                    adfPixel[0] = adfPixel[0] * dfScale + dfOffset;
+                    double adfValue[2] = {
+                        adfRealValues[iBand * nPoints + iPoint],
+                        adfImagValues[iBand * nPoints + iPoint]};
+                    const bool bIsComplex = CPL_TO_BOOL(
+                        GDALDataTypeIsComplex(GDALGetRasterDataType(hBand)));
+
+                    CPLString osValue;
 
                     if (bIsComplex)
-                    {
-                        adfPixel[1] = adfPixel[1] * dfScale + dfOffset;
-                        osValue.Printf("%.15g+%.15gi", adfPixel[0],
-                                       adfPixel[1]);
-                    }
+                        osValue.Printf("%.15g+%.15gi", adfValue[0],
+                                       adfValue[1]);
                     else
-                        osValue.Printf("%.15g", adfPixel[0]);
+                        osValue.Printf("%.15g", adfValue[0]);
 
                     if (bAsXML)
                     {
-                        osXML += "<DescaledValue>";
+                        osXML += "<Value>";
                         osXML += osValue;
-                        osXML += "</DescaledValue>";
+                        osXML += "</Value>";
                     }
                     else if (!bQuiet)
-                        printf("    Descaled Value: %s\n", osValue.c_str());
-                }
-            }
+                        printf("    Value: %s\n", osValue.c_str());
+                    else if (bValOnly)
+                        printf("%s\n", osValue.c_str());
+
+                    // Report unscaled if we have scale/offset values.
+                    const double dfOffset =
+                        GDALGetRasterOffset(hBand, nullptr);
+                    const double dfScale = GDALGetRasterScale(hBand, nullptr);
+                    if (dfOffset != 0.0 || dfScale != 1.0)
+                    {
+                        adfValue[0] = adfValue[0] * dfScale + dfOffset;
 
-            if (bAsXML)
-                osXML += "</BandReport>";
-        }
+                        if (bIsComplex)
+                        {
+                            adfValue[1] = adfValue[1] * dfScale + dfOffset;
+                            osValue.Printf("%.15g+%.15gi", adfValue[0],
+                                           adfValue[1]);
+                        }
+                        else
+                            osValue.Printf("%.15g", adfValue[0]);
+
+                        if (bAsXML)
+                        {
+                            osXML += "<DescaledValue>";
+                            osXML += osValue;
+                            osXML += "</DescaledValue>";
+                        }
+                        else if (!bQuiet)
+                            printf("    Descaled Value: %s\n",
+                                   osValue.c_str());
+                    }
+                }
 
-        osXML += "</Report>";
+                if (bAsXML)
+                    osXML += "</BandReport>";
+            }
 
-        if ((pszLocX != nullptr && pszLocY != nullptr) ||
-            (fscanf(stdin, "%lf %lf", &dfGeoX, &dfGeoY) != 2))
-        {
-            inputAvailable = 0;
+            osXML += "</Report>";
         }
     }
 
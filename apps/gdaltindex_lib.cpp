@@ -43,6 +43,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <deque>
 #include <limits>
 #include <set>
 
@@ -789,41 +790,70 @@ GDALDatasetH GDALTileIndex(const char *pszDest, int nSrcCount,
     /* -------------------------------------------------------------------- */
     /*      loop over GDAL files, processing.                               */
     /* -------------------------------------------------------------------- */
+    // Source files are opened ahead by worker threads if GDAL_NUM_THREADS is
+    // set, but they are still processed in order.
+    GDALConcurrentDatasetOpener oOpener(GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR,
+                                        nullptr);
+    // Source filenames and filenames to write, of the datasets added to
+    // oOpener.
+    std::deque<std::pair<std::string, std::string>> aoPendingFiles;
+    bool bIteratorFinished = false;
+
     while (true)
     {
-        const std::string osSrcFilename = oGDALTileIndexTileIterator.next();
-        if (osSrcFilename.empty())
-            break;
+        // Make sure that the next file to process, and when opening in
+        // worker threads, a few following ones, have been added to oOpener.
+        while (!bIteratorFinished &&
+               (aoPendingFiles.empty() || (oOpener.IsConcurrent() &&
+                                           aoPendingFiles.size() < 1024)))
+        {
+            std::string osSrcFilename = oGDALTileIndexTileIterator.next();
+            if (osSrcFilename.empty())
+            {
+                bIteratorFinished = true;
+                break;
+            }
 
-        std::string osFileNameToWrite;
-        VSIStatBuf sStatBuf;
+            std::string osFileNameToWrite;
+            VSIStatBuf sStatBuf;
 
-        // Make sure it is a file before building absolute path name.
-        if (!osCurrentPath.empty() &&
-            CPLIsFilenameRelative(osSrcFilename.c_str()) &&
-            VSIStat(osSrcFilename.c_str(), &sStatBuf) == 0)
-        {
-            osFileNameToWrite = CPLProjectRelativeFilename(
-                osCurrentPath.c_str(), osSrcFilename.c_str());
-        }
-        else
-        {
-            osFileNameToWrite = osSrcFilename.c_str();
-        }
+            // Make sure it is a file before building absolute path name.
+            if (!osCurrentPath.empty() &&
+                CPLIsFilenameRelative(osSrcFilename.c_str()) &&
+                VSIStat(osSrcFilename.c_str(), &sStatBuf) == 0)
+            {
+                osFileNameToWrite = CPLProjectRelativeFilename(
+                    osCurrentPath.c_str(), osSrcFilename.c_str());
+            }
+            else
+            {
+                osFileNameToWrite = osSrcFilename.c_str();
+            }
 
-        // Checks that file is not already in tileindex.
-        if (oSetExistingFiles.find(osFileNameToWrite) !=
-            oSetExistingFiles.end())
-        {
-            CPLError(CE_Warning, CPLE_AppDefined,
-                     "File %s is already in tileindex. Skipping it.",
-                     osFileNameToWrite.c_str());
-            continue;
+            // Checks that file is not already in tileindex.
+            if (oSetExistingFiles.find(osFileNameToWrite) !=
+                oSetExistingFiles.end())
+            {
+                CPLError(CE_Warning, CPLE_AppDefined,
+                         "File %s is already in tileindex. Skipping it.",
+                         osFileNameToWrite.c_str());
+                continue;
+            }
+
+            oOpener.Add(osSrcFilename);
+            aoPendingFiles.emplace_back(std::move(osSrcFilename),
+                                        std::move(osFileNameToWrite));
         }
+        if (aoPendingFiles.empty())
+            break;
+
+        const std::string osSrcFilename =
+            std::move(aoPendingFiles.front().first);
+        const std::string osFileNameToWrite =
+            std::move(aoPendingFiles.front().second);
+        aoPendingFiles.pop_front();
 
-        auto poSrcDS = std::unique_ptr<GDALDataset>(GDALDataset::Open(
-            osSrcFilename.c_str(), GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR,
-            nullptr, nullptr, nullptr));
+        auto poSrcDS = std::unique_ptr<GDALDataset>(oOpener.Next());
         if (poSrcDS == nullptr)
         {
             CPLError(CE_Warning, CPLE_AppDefined,
@@ -44,17 +44,25 @@
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 #include "nearblack_lib.h"
 
-static void ProcessLine(GByte *pabyLine, GByte *pabyMask, int iStart, int iEnd,
-                        int nSrcBands, int nDstBands, int nNearDist,
-                        int nMaxNonBlack, bool bNearWhite,
-                        const Colors &oColors, int *panLastLineCounts,
-                        bool bDoHorizontalCheck, bool bDoVerticalCheck,
-                        bool bBottomUp, int iLineFromTopOrBottom);
+static void ProcessLineVertical(GByte *pabyLine, GByte *pabyMask, int iStart,
+                                int iEnd, int nSrcBands, int nDstBands,
+                                int nNearDist, int nMaxNonBlack,
+                                bool bNearWhite, const Colors &oColors,
+                                int *panLastLineCounts,
+                                int iLineFromTopOrBottom);
+
+static void ProcessLineHorizontal(GByte *pabyLine, GByte *pabyMask, int iStart,
+                                  int iEnd, int nSrcBands, int nDstBands,
+                                  int nNearDist, int nMaxNonBlack,
+                                  bool bNearWhite, const Colors &oColors,
+                                  const int *panLastLineCounts, bool bBottomUp);
 
 /************************************************************************/
 /*                            GDALNearblack()                           */
@@ -339,6 +347,93 @@ GDALDatasetH CPL_DLL GDALNearblack(const char *pszDest, GDALDatasetH hDstDS,
 /* Do a top-to-bottom pass, followed by a bottom-to-top one.            */
 /************************************************************************/
 
+namespace
+{
+struct NearblackChunk
+{
+    GByte *pabyLines = nullptr;
+    GByte *pabyMask = nullptr;
+    int *panLineCounts = nullptr;
+    int *panLastLineCounts = nullptr;
+    int nXSize = 0;
+    int nLines = 0;
+    // Line number, counted from the top in the top-down pass, and from the
+    // bottom in the bottom-up pass, of the first line of the chunk to process
+    int iFirstLineFromTopOrBottom = 0;
+    bool bBottomUp = false;
+    int nSrcBands = 0;
+    int nDstBands = 0;
+    const GDALNearblackOptions *psOptions = nullptr;
+    const Colors *poColors = nullptr;
+};
+
+struct NearblackJob
+{
+    const NearblackChunk *psChunk = nullptr;
+    int iStart = 0;
+    int iEnd = 0;
+};
+}  // namespace
+
+// Index, in the buffers of the chunk, of its i-th line in processing order
+static int GetChunkLineIdx(const NearblackChunk &sChunk, int i)
+{
+    return sChunk.bBottomUp ? sChunk.nLines - 1 - i : i;
+}
+
+// Vertical check of the columns [iStart, iEnd[ of all the lines of a chunk.
+// The state of each column after each line is saved in panLineCounts.
+static void ProcessChunkVertical(void *pData)
+{
+    const NearblackJob *psJob = static_cast<const NearblackJob *>(pData);
+    const NearblackChunk &sChunk = *(psJob->psChunk);
+    const GDALNearblackOptions *psOptions = sChunk.psOptions;
+    for (int i = 0; i < sChunk.nLines; ++i)
+    {
+        const int iLineIdx = GetChunkLineIdx(sChunk, i);
+        const size_t nLineOffset =
+            static_cast<size_t>(iLineIdx) * sChunk.nXSize;
+        ProcessLineVertical(
+            sChunk.pabyLines + nLineOffset * sChunk.nDstBands,
+            sChunk.pabyMask ? sChunk.pabyMask + nLineOffset : nullptr,
+            psJob->iStart, psJob->iEnd, sChunk.nSrcBands, sChunk.nDstBands,
+            psOptions->nNearDist, psOptions->nMaxNonBlack,
+            psOptions->bNearWhite, *(sChunk.poColors),
+            sChunk.panLastLineCounts, sChunk.iFirstLineFromTopOrBottom + i);
+        memcpy(sChunk.panLineCounts + nLineOffset + psJob->iStart,
+               sChunk.panLastLineCounts + psJob->iStart,
+               sizeof(int) * (psJob->iEnd - psJob->iStart));
+    }
+}
+
+// Horizontal checks of the lines [iStart, iEnd[ of a chunk, that only
+// depend on the state of the columns after the vertical check of each line.
+static void ProcessChunkHorizontal(void *pData)
+{
+    const NearblackJob *psJob = static_cast<const NearblackJob *>(pData);
+    const NearblackChunk &sChunk = *(psJob->psChunk);
+    const GDALNearblackOptions *psOptions = sChunk.psOptions;
+    const int nXSize = sChunk.nXSize;
+    for (int iLineIdx = psJob->iStart; iLineIdx < psJob->iEnd; ++iLineIdx)
+    {
+        const size_t nLineOffset = static_cast<size_t>(iLineIdx) * nXSize;
+        GByte *pabyLine = sChunk.pabyLines + nLineOffset * sChunk.nDstBands;
+        GByte *pabyMask =
+            sChunk.pabyMask ? sChunk.pabyMask + nLineOffset : nullptr;
+        const int *panLineCounts = sChunk.panLineCounts + nLineOffset;
+        ProcessLineHorizontal(pabyLine, pabyMask, 0, nXSize - 1,
+                              sChunk.nSrcBands, sChunk.nDstBands,
+                              psOptions->nNearDist, psOptions->nMaxNonBlack,
+                              psOptions->bNearWhite, *(sChunk.poColors),
+                              panLineCounts, sChunk.bBottomUp);
+        ProcessLineHorizontal(pabyLine, pabyMask, nXSize - 1, 0,
+                              sChunk.nSrcBands, sChunk.nDstBands,
+                              psOptions->nNearDist, psOptions->nMaxNonBlack,
+                              psOptions->bNearWhite, *(sChunk.poColors),
+                              panLineCounts, sChunk.bBottomUp);
+    }
+}
+
 bool GDALNearblackTwoPassesAlgorithm(const GDALNearblackOptions *psOptions,
                                      GDALDatasetH hSrcDataset,
                                      GDALDatasetH hDstDS,
@@ -349,208 +444,314 @@ bool GDALNearblackTwoPassesAlgorithm(const GDALNearblackOptions *psOptions,
     const int nXSize = GDALGetRasterXSize(hSrcDataset);
     const int nYSize = GDALGetRasterYSize(hSrcDataset);
 
-    const int nMaxNonBlack = psOptions->nMaxNonBlack;
-    const int nNearDist = psOptions->nNearDist;
-    const bool bNearWhite = psOptions->bNearWhite;
     const bool bSetAlpha = psOptions->bSetAlpha;
 
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = std::max(
+        1, std::min(128, EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : atoi(pszNumThreads)));
+
     /* -------------------------------------------------------------------- */
-    /*      Allocate a line buffer.                                         */
+    /*      Lines are processed by chunks. In each chunk, the vertical      */
+    /*      check, whose state is independent from one column to another,   */
+    /*      is done by column strips, saving the state of each line. The    */
+    /*      horizontal checks, which only depend on that saved state, are   */
+    /*      then done line by line. Both are done in parallel when several  */
+    /*      threads are used, with the same result as when processing       */
+    /*      lines one at a time.                                            */
     /* -------------------------------------------------------------------- */
-
-    std::vector<GByte> abyLine(static_cast<size_t>(nXSize) * nDstBands);
-    GByte *pabyLine = abyLine.data();
-
-    std::vector<GByte> abyMask;
-    GByte *pabyMask = nullptr;
-    if (bSetMask)
+    int nChunkLines = 1;
+    if (nThreads > 1)
     {
-        abyMask.resize(nXSize);
-        pabyMask = abyMask.data();
+        constexpr size_t CHUNK_SIZE = 32 * 1024 * 1024;
+        const size_t nBytesPerLine =
+            static_cast<size_t>(nXSize) * (nDstBands + 1 + sizeof(int));
+        nChunkLines = static_cast<int>(std::min<size_t>(
+            nYSize, std::max<size_t>(1, CHUNK_SIZE / nBytesPerLine)));
     }
 
-    std::vector<int> anLastLineCounts(nXSize);
-    int *panLastLineCounts = anLastLineCounts.data();
-
     /* -------------------------------------------------------------------- */
-    /*      Processing data one line at a time.                             */
+    /*      Allocate the chunk buffers.                                     */
     /* -------------------------------------------------------------------- */
-    int iLine;
+    std::vector<GByte> abyLines;
+    std::vector<GByte> abyMask;
+    std::vector<int> anLineCounts;
+    std::vector<int> anLastLineCounts;
+    try
+    {
+        abyLines.resize(static_cast<size_t>(nXSize) * nChunkLines * nDstBands);
+        if (bSetMask)
+            abyMask.resize(static_cast<size_t>(nXSize) * nChunkLines);
+        anLineCounts.resize(static_cast<size_t>(nXSize) * nChunkLines);
+        anLastLineCounts.resize(nXSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "Out of memory");
+        return false;
+    }
 
-    for (iLine = 0; iLine < nYSize; iLine++)
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
+
+    NearblackChunk sChunk;
+    sChunk.pabyLines = abyLines.data();
+    sChunk.pabyMask = bSetMask ? abyMask.data() : nullptr;
+    sChunk.panLineCounts = anLineCounts.data();
+    sChunk.panLastLineCounts = anLastLineCounts.data();
+    sChunk.nXSize = nXSize;
+    sChunk.nSrcBands = nBands;
+    sChunk.nDstBands = nDstBands;
+    sChunk.psOptions = psOptions;
+    sChunk.poColors = &oColors;
+
+    // Splits [0, nSize[ in at most nThreads ranges, and processes them
+    const auto RunJobs = [&](CPLThreadFunc pfnFunc, int nSize)
     {
-        CPLErr eErr = GDALDatasetRasterIO(
-            hSrcDataset, GF_Read, 0, iLine, nXSize, 1, pabyLine, nXSize, 1,
-            GDT_Byte, nBands, nullptr, nDstBands, nXSize * nDstBands, 1);
-        if (eErr != CE_None)
+        const int nJobs = std::min(nThreads, nSize);
+        std::vector<NearblackJob> asJobs(nJobs);
+        for (int i = 0; i < nJobs; ++i)
         {
-            return false;
+            asJobs[i].psChunk = &sChunk;
+            asJobs[i].iStart = static_cast<int>(
+                static_cast<GIntBig>(nSize) * i / nJobs);
+            asJobs[i].iEnd = static_cast<int>(
+                static_cast<GIntBig>(nSize) * (i + 1) / nJobs);
+            if (!poJobQueue || !poJobQueue->SubmitJob(pfnFunc, &asJobs[i]))
+                pfnFunc(&asJobs[i]);
         }
+        if (poJobQueue)
+            poJobQueue->WaitCompletion();
+    };
 
-        if (bSetAlpha)
-        {
-            for (int iCol = 0; iCol < nXSize; iCol++)
-            {
-                pabyLine[iCol * nDstBands + nDstBands - 1] = 255;
-            }
-        }
+    for (int iPass = 0; iPass < 2 && hDstDS != nullptr; ++iPass)
+    {
+        const bool bBottomUp = iPass == 1;
+        sChunk.bBottomUp = bBottomUp;
+        std::fill(anLastLineCounts.begin(), anLastLineCounts.end(), 0);
 
-        if (bSetMask)
+        for (int iFirstLine = 0; iFirstLine < nYSize;
+             iFirstLine += nChunkLines)
         {
-            for (int iCol = 0; iCol < nXSize; iCol++)
+            // Lines of the chunk, counted from the top or bottom
+            const int nLines = std::min(nChunkLines, nYSize - iFirstLine);
+            const int iYOff =
+                bBottomUp ? nYSize - iFirstLine - nLines : iFirstLine;
+            sChunk.nLines = nLines;
+            sChunk.iFirstLineFromTopOrBottom = iFirstLine;
+
+            if (!bBottomUp)
             {
-                pabyMask[iCol] = 255;
-            }
-        }
+                CPLErr eErr = GDALDatasetRasterIO(
+                    hSrcDataset, GF_Read, 0, iYOff, nXSize, nLines,
+                    abyLines.data(), nXSize, nLines, GDT_Byte, nBands, nullptr,
+                    nDstBands, static_cast<GSpacing>(nXSize) * nDstBands, 1);
+                if (eErr != CE_None)
+                {
+                    return false;
+                }
+
+                const size_t nPixels = static_cast<size_t>(nXSize) * nLines;
+                if (bSetAlpha)
+                {
+                    for (size_t iPixel = 0; iPixel < nPixels; iPixel++)
+                    {
+                        abyLines[iPixel * nDstBands + nDstBands - 1] = 255;
+                    }
+                }
 
-        ProcessLine(pabyLine, pabyMask, 0, nXSize - 1, nBands, nDstBands,
-                    nNearDist, nMaxNonBlack, bNearWhite, oColors,
-                    panLastLineCounts,
-                    true,   // bDoHorizontalCheck
-                    true,   // bDoVerticalCheck
-                    false,  // bBottomUp
-                    iLine);
-        ProcessLine(pabyLine, pabyMask, nXSize - 1, 0, nBands, nDstBands,
-                    nNearDist, nMaxNonBlack, bNearWhite, oColors,
-                    panLastLineCounts,
-                    true,   // bDoHorizontalCheck
-                    false,  // bDoVerticalCheck
-                    false,  // bBottomUp
-                    iLine);
+                if (bSetMask)
+                {
+                    memset(abyMask.data(), 255, nPixels);
+                }
+            }
+            else
+            {
+                CPLErr eErr = GDALDatasetRasterIO(
+                    hDstDS, GF_Read, 0, iYOff, nXSize, nLines,
+                    abyLines.data(), nXSize, nLines, GDT_Byte, nDstBands,
+                    nullptr, nDstBands,
+                    static_cast<GSpacing>(nXSize) * nDstBands, 1);
+                if (eErr != CE_None)
+                {
+                    return false;
+                }
 
-        eErr = GDALDatasetRasterIO(hDstDS, GF_Write, 0, iLine, nXSize, 1,
-                                   pabyLine, nXSize, 1, GDT_Byte, nDstBands,
-                                   nullptr, nDstBands, nXSize * nDstBands, 1);
+                /***** read the mask band lines back in *****/
 
-        if (eErr != CE_None)
-        {
-            return false;
-        }
+                if (bSetMask)
+                {
+                    eErr = GDALRasterIO(hMaskBand, GF_Read, 0, iYOff, nXSize,
+                                        nLines, abyMask.data(), nXSize,
+                                        nLines, GDT_Byte, 0, 0);
+                    if (eErr != CE_None)
+                    {
+                        return false;
+                    }
+                }
+            }
 
-        /***** write out the mask band line *****/
+            RunJobs(ProcessChunkVertical, nXSize);
+            RunJobs(ProcessChunkHorizontal, nLines);
 
-        if (bSetMask)
-        {
-            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iLine, nXSize, 1,
-                                pabyMask, nXSize, 1, GDT_Byte, 0, 0);
+            CPLErr eErr = GDALDatasetRasterIO(
+                hDstDS, GF_Write, 0, iYOff, nXSize, nLines, abyLines.data(),
+                nXSize, nLines, GDT_Byte, nDstBands, nullptr, nDstBands,
+                static_cast<GSpacing>(nXSize) * nDstBands, 1);
             if (eErr != CE_None)
             {
-                CPLError(CE_Warning, CPLE_AppDefined,
-                         "ERROR writing out line to mask band.");
                 return false;
             }
-        }
 
-        if (!(psOptions->pfnProgress(
-                0.5 * ((iLine + 1) / static_cast<double>(nYSize)), nullptr,
-                psOptions->pProgressData)))
-        {
-            return false;
+            /***** write out the mask band lines *****/
+
+            if (bSetMask)
+            {
+                eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iYOff, nXSize,
+                                    nLines, abyMask.data(), nXSize, nLines,
+                                    GDT_Byte, 0, 0);
+                if (eErr != CE_None)
+                {
+                    if (!bBottomUp)
+                        CPLError(CE_Warning, CPLE_AppDefined,
+                                 "ERROR writing out line to mask band.");
+                    return false;
+                }
+            }
+
+            if (!(psOptions->pfnProgress(
+                    0.5 * iPass +
+                        0.5 * ((iFirstLine + nLines) /
+                               static_cast<double>(nYSize)),
+                    nullptr, psOptions->pProgressData)))
+            {
+                return false;
+            }
         }
     }
 
-    /* -------------------------------------------------------------------- */
-    /*      Now process from the bottom back up                            .*/
-    /* -------------------------------------------------------------------- */
-    memset(panLastLineCounts, 0, sizeof(int) * nXSize);
+    return true;
+}
+
+/************************************************************************/
+/*                        ProcessLineVertical()                         */
+/*                                                                      */
+/*      Vertical check of the columns [iStart, iEnd[ of a scanline.     */
+/************************************************************************/
+
+static void ProcessLineVertical(GByte *pabyLine, GByte *pabyMask, int iStart,
+                                int iEnd, int nSrcBands, int nDstBands,
+                                int nNearDist, int nMaxNonBlack,
+                                bool bNearWhite, const Colors &oColors,
+                                int *panLastLineCounts,
+                                int iLineFromTopOrBottom)
+{
+    const GByte nReplacevalue = bNearWhite ? 255 : 0;
 
-    for (iLine = nYSize - 1; hDstDS != nullptr && iLine >= 0; iLine--)
+    for (int i = iStart; i < iEnd; i++)
     {
-        CPLErr eErr = GDALDatasetRasterIO(
-            hDstDS, GF_Read, 0, iLine, nXSize, 1, pabyLine, nXSize, 1, GDT_Byte,
-            nDstBands, nullptr, nDstBands, nXSize * nDstBands, 1);
-        if (eErr != CE_None)
-        {
-            return false;
-        }
+        // are we already terminated for this column?
+        if (panLastLineCounts[i] > nMaxNonBlack)
+            continue;
 
-        /***** read the mask band line back in *****/
+        /***** is the pixel valid data? ****/
 
-        if (bSetMask)
+        bool bIsNonBlack = false;
+
+        /***** loop over the colors *****/
+
+        for (int iColor = 0; iColor < static_cast<int>(oColors.size());
+             iColor++)
         {
-            eErr = GDALRasterIO(hMaskBand, GF_Read, 0, iLine, nXSize, 1,
-                                pabyMask, nXSize, 1, GDT_Byte, 0, 0);
-            if (eErr != CE_None)
+
+            const Color &oColor = oColors[iColor];
+
+            bIsNonBlack = false;
+
+            /***** loop over the bands *****/
+
+            for (int iBand = 0; iBand < nSrcBands; iBand++)
             {
-                return false;
+                const int nPix = pabyLine[i * nDstBands + iBand];
+
+                if (oColor[iBand] - nPix > nNearDist ||
+                    nPix > nNearDist + oColor[iBand])
+                {
+                    bIsNonBlack = true;
+                    break;
+                }
             }
+
+            if (!bIsNonBlack)
+                break;
         }
 
-        ProcessLine(pabyLine, pabyMask, 0, nXSize - 1, nBands, nDstBands,
-                    nNearDist, nMaxNonBlack, bNearWhite, oColors,
-                    panLastLineCounts,
-                    true,  // bDoHorizontalCheck
-                    true,  // bDoVerticalCheck
-                    true,  // bBottomUp
-                    nYSize - 1 - iLine);
-        ProcessLine(pabyLine, pabyMask, nXSize - 1, 0, nBands, nDstBands,
-                    nNearDist, nMaxNonBlack, bNearWhite, oColors,
-                    panLastLineCounts,
-                    true,   // bDoHorizontalCheck
-                    false,  // bDoVerticalCheck
-                    true,   // bBottomUp
-                    nYSize - 1 - iLine);
-
-        eErr = GDALDatasetRasterIO(hDstDS, GF_Write, 0, iLine, nXSize, 1,
-                                   pabyLine, nXSize, 1, GDT_Byte, nDstBands,
-                                   nullptr, nDstBands, nXSize * nDstBands, 1);
-        if (eErr != CE_None)
+        if (bIsNonBlack)
         {
-            return false;
-        }
+            panLastLineCounts[i]++;
 
-        /***** write out the mask band line *****/
+            if (panLastLineCounts[i] > nMaxNonBlack)
+                continue;
 
-        if (bSetMask)
-        {
-            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iLine, nXSize, 1,
-                                pabyMask, nXSize, 1, GDT_Byte, 0, 0);
-            if (eErr != CE_None)
+            if (iLineFromTopOrBottom == 0 && nMaxNonBlack > 0)
             {
-                return false;
+                // if there's a valid value just at the top or bottom
+                // of the raster, then ignore the nMaxNonBlack setting
+                panLastLineCounts[i] = nMaxNonBlack + 1;
+                continue;
             }
         }
+        // else
+        //   panLastLineCounts[i] = 0; // not sure this even makes sense
 
-        if (!(psOptions->pfnProgress(0.5 + 0.5 * (nYSize - iLine) /
-                                               static_cast<double>(nYSize),
-                                     nullptr, psOptions->pProgressData)))
-        {
-            return false;
-        }
-    }
+        /***** replace the pixel values *****/
+        for (int iBand = 0; iBand < nSrcBands; iBand++)
+            pabyLine[i * nDstBands + iBand] = nReplacevalue;
 
-    return true;
+        /***** alpha *****/
+        if (nDstBands > nSrcBands)
+            pabyLine[i * nDstBands + nDstBands - 1] = 0;
+
+        /***** mask *****/
+        if (pabyMask != nullptr)
+            pabyMask[i] = 0;
+    }
 }
 
 /************************************************************************/
-/*                            ProcessLine()                             */
+/*                       ProcessLineHorizontal()                        */
 /*                                                                      */
-/*      Process a single scanline of image data.                        */
+/*      Horizontal check of a scanline, from iStart to iEnd (excluded). */
 /************************************************************************/
 
-static void ProcessLine(GByte *pabyLine, GByte *pabyMask, int iStart, int iEnd,
-                        int nSrcBands, int nDstBands, int nNearDist,
-                        int nMaxNonBlack, bool bNearWhite,
-                        const Colors &oColors, int *panLastLineCounts,
-                        bool bDoHorizontalCheck, bool bDoVerticalCheck,
-                        bool bBottomUp, int iLineFromTopOrBottom)
+static void ProcessLineHorizontal(GByte *pabyLine, GByte *pabyMask, int iStart,
+                                  int iEnd, int nSrcBands, int nDstBands,
+                                  int nNearDist, int nMaxNonBlack,
+                                  bool bNearWhite, const Colors &oColors,
+                                  const int *panLastLineCounts, bool bBottomUp)
 {
     const GByte nReplacevalue = bNearWhite ? 255 : 0;
 
-    /* -------------------------------------------------------------------- */
-    /*      Vertical checking.                                              */
-    /* -------------------------------------------------------------------- */
+    int nNonBlackPixels = 0;
 
-    if (bDoVerticalCheck)
+    /***** on a bottom up pass assume nMaxNonBlack is 0 *****/
+
+    if (bBottomUp)
+        nMaxNonBlack = 0;
+
+    const int iDir = iStart < iEnd ? 1 : -1;
+
+    bool bDoTest = TRUE;
+
+    for (int i = iStart; i != iEnd; i += iDir)
     {
-        const int nXSize = std::max(iStart + 1, iEnd + 1);
+        /***** not seen any valid data? *****/
 
-        for (int i = 0; i < nXSize; i++)
+        if (bDoTest)
         {
-            // are we already terminated for this column?
-            if (panLastLineCounts[i] > nMaxNonBlack)
-                continue;
-
             /***** is the pixel valid data? ****/
 
             bool bIsNonBlack = false;
@@ -579,146 +780,58 @@ static void ProcessLine(GByte *pabyLine, GByte *pabyMask, int iStart, int iEnd,
                     }
                 }
 
-                if (!bIsNonBlack)
+                if (bIsNonBlack == false)
                     break;
             }
 
             if (bIsNonBlack)
             {
-                panLastLineCounts[i]++;
+                /***** use nNonBlackPixels in grey areas  *****/
+                /***** from the vertical pass's grey areas ****/
 
-                if (panLastLineCounts[i] > nMaxNonBlack)
-                    continue;
+                if (panLastLineCounts[i] <= nMaxNonBlack)
+                    nNonBlackPixels = panLastLineCounts[i];
+                else
+                    nNonBlackPixels++;
+            }
 
-                if (iLineFromTopOrBottom == 0 && nMaxNonBlack > 0)
-                {
-                    // if there's a valid value just at the top or bottom
-                    // of the raster, then ignore the nMaxNonBlack setting
-                    panLastLineCounts[i] = nMaxNonBlack + 1;
-                    continue;
-                }
+            if (nNonBlackPixels > nMaxNonBlack)
+            {
+                bDoTest = false;
+                continue;
+            }
+
+            if (bIsNonBlack && nMaxNonBlack > 0 && i == iStart)
+            {
+                // if there's a valid value just at the left or right
+                // of the raster, then ignore the nMaxNonBlack setting
+                bDoTest = false;
+                continue;
             }
-            // else
-            //   panLastLineCounts[i] = 0; // not sure this even makes sense
 
             /***** replace the pixel values *****/
+
             for (int iBand = 0; iBand < nSrcBands; iBand++)
                 pabyLine[i * nDstBands + iBand] = nReplacevalue;
 
             /***** alpha *****/
+
             if (nDstBands > nSrcBands)
                 pabyLine[i * nDstBands + nDstBands - 1] = 0;
 
             /***** mask *****/
+
             if (pabyMask != nullptr)
                 pabyMask[i] = 0;
         }
-    }
-
-    /* -------------------------------------------------------------------- */
-    /*      Horizontal Checking.                                            */
-    /* -------------------------------------------------------------------- */
 
-    if (bDoHorizontalCheck)
-    {
-        int nNonBlackPixels = 0;
-
-        /***** on a bottom up pass assume nMaxNonBlack is 0 *****/
-
-        if (bBottomUp)
-            nMaxNonBlack = 0;
+        /***** seen valid data but test if the *****/
+        /***** vertical pass saw any non valid data *****/
 
-        const int iDir = iStart < iEnd ? 1 : -1;
-
-        bool bDoTest = TRUE;
-
-        for (int i = iStart; i != iEnd; i += iDir)
+        else if (panLastLineCounts[i] == 0)
         {
-            /***** not seen any valid data? *****/
-
-            if (bDoTest)
-            {
-                /***** is the pixel valid data? ****/
-
-                bool bIsNonBlack = false;
-
-                /***** loop over the colors *****/
-
-                for (int iColor = 0; iColor < static_cast<int>(oColors.size());
-                     iColor++)
-                {
-
-                    const Color &oColor = oColors[iColor];
-
-                    bIsNonBlack = false;
-
-                    /***** loop over the bands *****/
-
-                    for (int iBand = 0; iBand < nSrcBands; iBand++)
-                    {
-                        const int nPix = pabyLine[i * nDstBands + iBand];
-
-                        if (oColor[iBand] - nPix > nNearDist ||
-                            nPix > nNearDist + oColor[iBand])
-                        {
-                            bIsNonBlack = true;
-                            break;
-                        }
-                    }
-
-                    if (bIsNonBlack == false)
-                        break;
-                }
-
-                if (bIsNonBlack)
-                {
-                    /***** use nNonBlackPixels in grey areas  *****/
-                    /***** from the vertical pass's grey areas ****/
-
-                    if (panLastLineCounts[i] <= nMaxNonBlack)
-                        nNonBlackPixels = panLastLineCounts[i];
-                    else
-                        nNonBlackPixels++;
-                }
-
-                if (nNonBlackPixels > nMaxNonBlack)
-                {
-                    bDoTest = false;
-                    continue;
-                }
-
-                if (bIsNonBlack && nMaxNonBlack > 0 && i == iStart)
-                {
-                    // if there's a valid value just at the left or right
-                    // of the raster, then ignore the nMaxNonBlack setting
-                    bDoTest = false;
-                    continue;
-                }
-
-                /***** replace the pixel values *****/
-
-                for (int iBand = 0; iBand < nSrcBands; iBand++)
-                    pabyLine[i * nDstBands + iBand] = nReplacevalue;
-
-                /***** alpha *****/
-
-                if (nDstBands > nSrcBands)
-                    pabyLine[i * nDstBands + nDstBands - 1] = 0;
-
-                /***** mask *****/
-
-                if (pabyMask != nullptr)
-                    pabyMask[i] = 0;
-            }
-
-            /***** seen valid data but test if the *****/
-            /***** vertical pass saw any non valid data *****/
-
-            else if (panLastLineCounts[i] == 0)
-            {
-                bDoTest = true;
-                nNonBlackPixels = 0;
-            }
+            bDoTest = true;
+            nNonBlackPixels = 0;
         }
     }
 }
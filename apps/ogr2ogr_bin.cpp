@@ -93,6 +93,7 @@ static void Usage(bool bIsError, const char *pszAdditionalMsg = nullptr,
         "\n"
         "Advanced options :\n"
         "               [-gt n] [-ds_transaction]\n"
+        "               [-parallel_layers <n>|ALL_CPUS]\n"
         "               [-oo <NAME>=<VALUE>]... [-doo <NAME>=<VALUE>]...\n"
         "               [-clipsrc {[<xmin> <ymin> <xmax> <ymax>]|<WKT>|"
         "<datasource>|spat_extent}]\n"
@@ -174,6 +175,7 @@ static void Usage(bool bIsError, const char *pszAdditionalMsg = nullptr,
         " -skipfailures: skip features or layers that fail to convert\n"
         " -gt n: group n features per transaction (default 20000). n can be "
         "set to unlimited\n"
+        " -parallel_layers n: translate up to n layers concurrently\n"
         " -spat xmin ymin xmax ymax: spatial query extents\n"
         " -simplify tolerance: distance tolerance for simplification.\n"
         " -segmentize max_dist: maximum distance between 2 nodes.\n"
@@ -34,14 +34,17 @@
 
 #include <cassert>
 #include <climits>
+#include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 
 #include <algorithm>
+#include <array>
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <unordered_set>
 #include <string>
@@ -51,14 +54,17 @@
 #include "commonutils.h"
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_time.h"
+#include "cpl_worker_thread_pool.h"
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "gdal_alg_priv.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -67,6 +73,7 @@
 #include "ogr_p.h"
 #include "ogr_recordbatch.h"
 #include "ogr_spatialref.h"
+#include "ogr_wkb.h"
 #include "ogrlayerdecorator.h"
 #include "ogrsf_frmts.h"
 
@@ -443,6 +450,11 @@ struct GDALVectorTranslateOptions
 
     /*! Wished offset w.r.t UTC of dateTime */
     int nTZOffsetInSec = TZ_OFFSET_INVALID;
+
+    /*! Maximum number of layers translated concurrently, each in a worker
+       thread with its own source and target dataset handles. Only honoured
+       when the output driver stores layers independently from each other. */
+    int nParallelLayers = 1;
 };
 
 struct TargetLayerInfo
@@ -494,7 +506,17 @@ class SetupTargetLayer
     bool CanUseWriteArrowBatch(OGRLayer *poSrcLayer, OGRLayer *poDstLayer,
                                bool bJustCreatedLayer,
                                const GDALVectorTranslateOptions *psOptions,
-                               bool &bError);
+                               std::vector<int> &anMap, bool &bError);
+
+    bool CanReprojectArrowBatch(OGRLayer *poSrcLayer, OGRLayer *poDstLayer,
+                                const GDALVectorTranslateOptions *psOptions);
+
+    bool CanSelectFieldsInArrowBatch(OGRLayer *poSrcLayer,
+                                     bool bJustCreatedLayer);
+
+    bool CanPromoteToMultiInArrowBatch(OGRLayer *poSrcLayer);
+
+    void SetIgnoredFieldsFromSelection(OGRLayer *poSrcLayer);
 
   public:
     GDALDataset *m_poSrcDS;
@@ -535,13 +557,48 @@ class SetupTargetLayer
           GDALVectorTranslateOptions *psOptions, GIntBig &nTotalEventsDone);
 };
 
+/************************************************************************/
+/*                         PreparedClipGeometry                         */
+/************************************************************************/
+
+// Clip geometry of -clipsrc/-clipdst, with the structures used to speed up
+// its intersection with features.
+class PreparedClipGeometry
+{
+    const OGRGeometry *m_poClipGeom = nullptr;
+    OGREnvelope m_sClipEnv{};
+    OGRPreparedGeometryUniquePtr m_poPrepared{};
+
+    // Lazily computed intersections of the clip geometry with the tiles of
+    // a regular grid covering its extent.
+    int m_nTilesPerDim = 0;
+    double m_dfTileWidth = 0;
+    double m_dfTileHeight = 0;
+    std::vector<std::unique_ptr<OGRGeometry>> m_apoTiles{};
+    std::vector<bool> m_abTileComputed{};
+
+    CPL_DISALLOW_COPY_ASSIGN(PreparedClipGeometry)
+
+    const OGRGeometry *GetClipGeomPart(const OGREnvelope &sEnv);
+
+  public:
+    explicit PreparedClipGeometry(const OGRGeometry *poClipGeom);
+
+    const OGRGeometry *GetClipGeom() const
+    {
+        return m_poClipGeom;
+    }
+
+    bool Intersects(const OGRGeometry *poGeom) const;
+    std::unique_ptr<OGRGeometry> Clip(const OGRGeometry *poGeom);
+};
+
 class LayerTranslator
 {
-    static bool TranslateArrow(const TargetLayerInfo *psInfo,
-                               GIntBig nCountLayerFeatures,
-                               GIntBig *pnReadFeatureCount,
-                               GDALProgressFunc pfnProgress, void *pProgressArg,
-                               const GDALVectorTranslateOptions *psOptions);
+    bool TranslateArrow(TargetLayerInfo *psInfo, GIntBig nCountLayerFeatures,
+                        GIntBig *pnReadFeatureCount,
+                        GDALProgressFunc pfnProgress, void *pProgressArg,
+                        const GDALVectorTranslateOptions *psOptions);
 
   public:
     GDALDataset *m_poSrcDS = nullptr;
@@ -567,6 +624,8 @@ class LayerTranslator
     bool m_bWarnedClipDstSRS = false;
     std::unique_ptr<OGRGeometry> m_poClipDstReprojectedToDstSRS;
     const OGRSpatialReference *m_poClipDstReprojectedToDstSRS_SRS = nullptr;
+    std::unique_ptr<PreparedClipGeometry> m_poClipSrcPrepared{};
+    std::unique_ptr<PreparedClipGeometry> m_poClipDstPrepared{};
     bool m_bExplodeCollections = false;
     bool m_bNativeData = false;
     GIntBig m_nLimit = -1;
@@ -581,6 +640,9 @@ class LayerTranslator
   private:
     const OGRGeometry *GetDstClipGeom(const OGRSpatialReference *poGeomSRS);
     const OGRGeometry *GetSrcClipGeom(const OGRSpatialReference *poGeomSRS);
+    static PreparedClipGeometry *
+    GetPreparedClipGeom(const OGRGeometry *poClipGeom,
+                        std::unique_ptr<PreparedClipGeometry> &poPrepared);
 };
 
 static OGRLayer *GetLayerAndOverwriteIfNecessary(GDALDataset *poDstDS,
@@ -590,6 +652,116 @@ static OGRLayer *GetLayerAndOverwriteIfNecessary(GDALDataset *poDstDS,
                                                  bool *pbOverwriteActuallyDone,
                                                  bool *pbAddOverwriteLCO);
 
+/************************************************************************/
+/*                        UnaryUnionPartitioned()                       */
+/*                                                                      */
+/*      Union of the members of a collection. When there are many       */
+/*      of them, they are partitioned into spatially coherent groups    */
+/*      (sort-tile-recursive order of their envelope centers), each     */
+/*      group is unioned in a worker thread, and the partial results    */
+/*      are finally unioned together. As neighbouring geometries end    */
+/*      up in the same group, the partial unions are much simpler than  */
+/*      their inputs and the final step is cheap.                       */
+/************************************************************************/
+
+namespace
+{
+struct UnionPartitionJob
+{
+    OGRGeometryCollection oPart{};
+    std::unique_ptr<OGRGeometry> poUnion{};
+};
+}  // namespace
+
+static void UnionPartitionJobFunc(void *pData)
+{
+    auto psJob = static_cast<UnionPartitionJob *>(pData);
+    psJob->poUnion.reset(psJob->oPart.UnaryUnion());
+}
+
+static std::unique_ptr<OGRGeometry>
+UnaryUnionPartitioned(OGRGeometryCollection &oGC)
+{
+    const int nGeoms = oGC.getNumGeometries();
+
+    constexpr int MIN_GEOMS_PER_PARTITION = 500;
+    int nThreads = 1;
+    if (nGeoms >= 2 * MIN_GEOMS_PER_PARTITION)
+    {
+        const char *pszNumThreads =
+            CPLGetConfigOption("GDAL_NUM_THREADS", "ALL_CPUS");
+        int nThreadsMax;
+        if (EQUAL(pszNumThreads, "ALL_CPUS"))
+            nThreadsMax = CPLGetNumCPUs();
+        else
+            nThreadsMax = std::max(1, atoi(pszNumThreads));
+        nThreads = std::min(std::min(nThreadsMax, 128),
+                            nGeoms / MIN_GEOMS_PER_PARTITION);
+    }
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    if (poPool == nullptr)
+        return std::unique_ptr<OGRGeometry>(oGC.UnaryUnion());
+
+    struct Center
+    {
+        double dfX;
+        double dfY;
+        int iGeom;
+    };
+
+    std::vector<Center> asCenters;
+    asCenters.reserve(nGeoms);
+    for (int i = 0; i < nGeoms; ++i)
+    {
+        OGREnvelope sEnvelope;
+        oGC.getGeometryRef(i)->getEnvelope(&sEnvelope);
+        asCenters.push_back({(sEnvelope.MinX + sEnvelope.MaxX) / 2,
+                             (sEnvelope.MinY + sEnvelope.MaxY) / 2, i});
+    }
+
+    // Sort-tile-recursive ordering: vertical slices ordered by X, and
+    // members of each slice ordered by Y.
+    std::sort(asCenters.begin(), asCenters.end(),
+              [](const Center &a, const Center &b) { return a.dfX < b.dfX; });
+    const int nSlices =
+        static_cast<int>(std::ceil(std::sqrt(static_cast<double>(nThreads))));
+    const int nPerSlice = (nGeoms + nSlices - 1) / nSlices;
+    for (int iStart = 0; iStart < nGeoms; iStart += nPerSlice)
+    {
+        const int iEnd = std::min(nGeoms, iStart + nPerSlice);
+        std::sort(asCenters.begin() + iStart, asCenters.begin() + iEnd,
+                  [](const Center &a, const Center &b)
+                  { return a.dfY < b.dfY; });
+    }
+
+    // Move the members of the collection into the partitions.
+    std::vector<UnionPartitionJob> asJobs(nThreads);
+    for (int i = 0; i < nGeoms; ++i)
+    {
+        const int iJob = static_cast<int>(static_cast<GIntBig>(i) * nThreads /
+                                          nGeoms);
+        asJobs[iJob].oPart.addGeometryDirectly(
+            oGC.getGeometryRef(asCenters[i].iGeom));
+    }
+    oGC.removeGeometry(-1, FALSE);
+
+    auto poQueue = poPool->CreateJobQueue();
+    for (auto &sJob : asJobs)
+        poQueue->SubmitJob(UnionPartitionJobFunc, &sJob);
+    poQueue->WaitCompletion();
+
+    OGRGeometryCollection oPartialUnions;
+    oPartialUnions.assignSpatialReference(oGC.getSpatialReference());
+    for (auto &sJob : asJobs)
+    {
+        if (!sJob.poUnion)
+            return nullptr;
+        oPartialUnions.addGeometryDirectly(sJob.poUnion.release());
+    }
+    return std::unique_ptr<OGRGeometry>(oPartialUnions.UnaryUnion());
+}
+
 /************************************************************************/
 /*                           LoadGeometry()                             */
 /************************************************************************/
@@ -632,42 +804,61 @@ static std::unique_ptr<OGRGeometry> LoadGeometry(const std::string &osDS,
         poSRSClone->Release();
     }
 
+    std::vector<std::unique_ptr<OGRGeometry>> apoGeoms;
+    std::vector<GIntBig> anFIDs;
     for (auto &poFeat : poLyr)
     {
         auto poSrcGeom = std::unique_ptr<OGRGeometry>(poFeat->StealGeometry());
-        if (poSrcGeom)
+        // Only take into account areal geometries.
+        if (poSrcGeom && poSrcGeom->getDimension() == 2)
         {
-            // Only take into account areal geometries.
-            if (poSrcGeom->getDimension() == 2)
-            {
-                if (!poSrcGeom->IsValid())
-                {
-                    CPLError(CE_Warning, CPLE_AppDefined,
-                             "Geometry of feature " CPL_FRMT_GIB " of %s "
-                             "is invalid. Trying to make it valid",
-                             poFeat->GetFID(), osDS.c_str());
-                    auto poValid =
-                        std::unique_ptr<OGRGeometry>(poSrcGeom->MakeValid());
-                    if (poValid)
-                    {
-                        oGC.addGeometryDirectly(poValid.release());
-                    }
-                }
-                else
-                {
-                    oGC.addGeometryDirectly(poSrcGeom.release());
-                }
-            }
+            apoGeoms.push_back(std::move(poSrcGeom));
+            anFIDs.push_back(poFeat->GetFID());
         }
     }
 
     if (!osSQL.empty())
         poDS->ReleaseResultSet(poLyr);
 
+    // Check the validity of all geometries at once, so that it can be done
+    // in parallel, and make the invalid ones valid.
+    std::vector<const OGRGeometry *> apoGeomsRaw;
+    for (const auto &poGeom : apoGeoms)
+        apoGeomsRaw.push_back(poGeom.get());
+    std::vector<GByte> abyValid(apoGeoms.size());
+    std::vector<std::string> aosReasons;
+    OGRGeometryFactory::validateGeometries(apoGeomsRaw.data(),
+                                           apoGeomsRaw.size(), abyValid.data(),
+                                           &aosReasons);
+    std::vector<const OGRGeometry *> apoInvalidGeoms;
+    std::vector<size_t> anInvalidIdx;
+    for (size_t i = 0; i < apoGeoms.size(); ++i)
+    {
+        if (!abyValid[i])
+        {
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "Geometry of feature " CPL_FRMT_GIB " of %s "
+                     "is invalid (%s). Trying to make it valid",
+                     anFIDs[i], osDS.c_str(), aosReasons[i].c_str());
+            apoInvalidGeoms.push_back(apoGeoms[i].get());
+            anInvalidIdx.push_back(i);
+        }
+    }
+    auto apoValidGeoms = OGRGeometryFactory::makeValidGeometries(
+        apoInvalidGeoms.data(), apoInvalidGeoms.size());
+    for (size_t i = 0; i < anInvalidIdx.size(); ++i)
+        apoGeoms[anInvalidIdx[i]] = std::move(apoValidGeoms[i]);
+
+    for (auto &poGeom : apoGeoms)
+    {
+        if (poGeom)
+            oGC.addGeometryDirectly(poGeom.release());
+    }
+
     if (oGC.IsEmpty())
         return nullptr;
 
-    return std::unique_ptr<OGRGeometry>(oGC.UnaryUnion());
+    return UnaryUnionPartitioned(oGC);
 }
 
 /************************************************************************/
@@ -2111,6 +2302,362 @@ GDALVectorTranslateCreateCopy(GDALDriver *poDriver, const char *pszDest,
     return poOut;
 }
 
+/************************************************************************/
+/*                    CanTranslateLayersInParallel()                    */
+/************************************************************************/
+
+// Layers can only be translated concurrently when each worker can open its
+// own handles on the source and target datasets, and when the target driver
+// stores each layer independently from the others, so that writers of
+// distinct layers do not conflict, and the order of the output layers does
+// not depend on the order in which they are created.
+static bool CanTranslateLayersInParallel(
+    GDALDataset *poDS, GDALDataset *poODS, GDALDatasetH hDstDS,
+    const std::string &osDestFilename, bool bHasGCPCoordTrans,
+    const GDALVectorTranslateOptions *psOptions, std::string &osReason)
+{
+    if (hDstDS != nullptr)
+    {
+        osReason = "the output dataset is provided by the caller";
+        return false;
+    }
+    if (poDS == poODS ||
+        strcmp(poDS->GetDescription(), osDestFilename.c_str()) == 0)
+    {
+        osReason = "the source and output datasets are the same";
+        return false;
+    }
+    GDALDriver *poSrcDriver = poDS->GetDriver();
+    if (poSrcDriver == nullptr || poDS->GetDescription()[0] == '\0' ||
+        EQUAL(poSrcDriver->GetDescription(), "Memory") ||
+        EQUAL(poSrcDriver->GetDescription(), "MEM"))
+    {
+        osReason = "the source dataset cannot be reopened";
+        return false;
+    }
+    if (!psOptions->osNewLayerName.empty())
+    {
+        osReason = "-nln is specified";
+        return false;
+    }
+    if (psOptions->nGroupTransactions && !psOptions->nLayerTransaction)
+    {
+        osReason = "a dataset level transaction is used";
+        return false;
+    }
+    if (bHasGCPCoordTrans)
+    {
+        osReason = "-gcp is specified";
+        return false;
+    }
+
+    GDALDriver *poDriver = poODS->GetDriver();
+    const char *pszDriverName = poDriver ? poDriver->GetDescription() : "";
+    if (EQUAL(pszDriverName, "PostgreSQL"))
+        return true;
+    VSIStatBufL sStat;
+    if ((EQUAL(pszDriverName, "ESRI Shapefile") ||
+         EQUAL(pszDriverName, "MapInfo File") ||
+         EQUAL(pszDriverName, "CSV") || EQUAL(pszDriverName, "FlatGeobuf")) &&
+        VSIStatL(osDestFilename.c_str(), &sStat) == 0 &&
+        VSI_ISDIR(sStat.st_mode))
+    {
+        return true;
+    }
+    osReason = CPLSPrintf("the %s driver does not store layers independently",
+                          pszDriverName);
+    return false;
+}
+
+/************************************************************************/
+/*                      TranslateLayersInParallel()                     */
+/************************************************************************/
+
+namespace
+{
+struct ParallelLayersContext
+{
+    std::string osSrcName{};
+    CPLStringList aosSrcDrivers{};
+    CPLStringList aosSrcOpenOptions{};
+    std::string osDstName{};
+    CPLStringList aosDstDrivers{};
+    GDALVectorTranslateOptions *psOptions = nullptr;
+    const SetupTargetLayer *poSetup = nullptr;
+    const LayerTranslator *poTranslator = nullptr;
+    const OGRSpatialReference *poSpatSRS = nullptr;
+    const OGRSpatialReference *poSourceSRS = nullptr;
+
+    // Overall progress, as the sum of the progress of each layer weighted by
+    // its feature count.
+    GIntBig nCountLayersFeatures = 0;
+    std::mutex oProgressMutex{};
+    std::vector<double> adfLayerComplete{};
+    bool bStop = false;
+};
+
+struct ParallelLayerJob
+{
+    ParallelLayersContext *psCtxt = nullptr;
+    int iLayer = 0;
+    int iSrcLayer = -1;
+    std::string osSrcLayerName{};
+    GIntBig nCountFeatures = 0;
+    bool bOK = false;
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+};
+}  // namespace
+
+static int CPL_STDCALL ParallelLayerProgress(double dfComplete,
+                                             const char * /* pszMessage */,
+                                             void *pData)
+{
+    auto psJob = static_cast<ParallelLayerJob *>(pData);
+    auto psCtxt = psJob->psCtxt;
+    std::lock_guard<std::mutex> oLock(psCtxt->oProgressMutex);
+    if (psCtxt->bStop)
+        return FALSE;
+    psCtxt->adfLayerComplete[psJob->iLayer] =
+        dfComplete * static_cast<double>(psJob->nCountFeatures) /
+        static_cast<double>(psCtxt->nCountLayersFeatures);
+    double dfTotal = 0;
+    for (double dfLayerComplete : psCtxt->adfLayerComplete)
+        dfTotal += dfLayerComplete;
+    if (!psCtxt->psOptions->pfnProgress(std::min(1.0, dfTotal), "",
+                                        psCtxt->psOptions->pProgressData))
+    {
+        psCtxt->bStop = true;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static OGRSpatialReference *CloneSRS(const OGRSpatialReference *poSRS)
+{
+    return poSRS ? poSRS->Clone() : nullptr;
+}
+
+// Clone a clip geometry, with its own SRS object, so that workers do not
+// share any state.
+static std::unique_ptr<OGRGeometry> CloneClipGeom(const OGRGeometry *poGeom)
+{
+    if (poGeom == nullptr)
+        return nullptr;
+    std::unique_ptr<OGRGeometry> poClone(poGeom->clone());
+    if (auto poSRS = CloneSRS(poGeom->getSpatialReference()))
+    {
+        poClone->assignSpatialReference(poSRS);
+        poSRS->Release();
+    }
+    return poClone;
+}
+
+static bool TranslateLayerInWorker(ParallelLayerJob *psJob)
+{
+    ParallelLayersContext *psCtxt = psJob->psCtxt;
+    GDALVectorTranslateOptions *psOptions = psCtxt->psOptions;
+
+    std::unique_ptr<GDALDataset> poSrcDS(GDALDataset::Open(
+        psCtxt->osSrcName.c_str(), GDAL_OF_VECTOR | GDAL_OF_VERBOSE_ERROR,
+        psCtxt->aosSrcDrivers.List(), psCtxt->aosSrcOpenOptions.List(),
+        nullptr));
+    if (!poSrcDS)
+        return false;
+    OGRLayer *poLayer =
+        psJob->iSrcLayer >= 0
+            ? poSrcDS->GetLayer(psJob->iSrcLayer)
+            : poSrcDS->GetLayerByName(psJob->osSrcLayerName.c_str());
+    if (poLayer == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Couldn't fetch layer '%s' from a new handle on %s",
+                 psJob->osSrcLayerName.c_str(), psCtxt->osSrcName.c_str());
+        return false;
+    }
+
+    std::unique_ptr<GDALDataset> poDstDS(GDALDataset::Open(
+        psCtxt->osDstName.c_str(),
+        GDAL_OF_VECTOR | GDAL_OF_UPDATE | GDAL_OF_VERBOSE_ERROR,
+        psCtxt->aosDstDrivers.List(), psOptions->aosDestOpenOptions.List(),
+        nullptr));
+    if (!poDstDS)
+        return false;
+
+    const LayerTranslator *poTemplate = psCtxt->poTranslator;
+    std::unique_ptr<OGRSpatialReference, OGRSpatialReferenceReleaser>
+        poOutputSRS(CloneSRS(poTemplate->m_poOutputSRS));
+    std::unique_ptr<OGRSpatialReference, OGRSpatialReferenceReleaser>
+        poSourceSRS(CloneSRS(psCtxt->poSourceSRS));
+    std::unique_ptr<OGRSpatialReference, OGRSpatialReferenceReleaser>
+        poSpatSRS(CloneSRS(psCtxt->poSpatSRS));
+    auto poClipSrc = CloneClipGeom(poTemplate->m_poClipSrcOri);
+    auto poClipDst = CloneClipGeom(poTemplate->m_poClipDstOri);
+
+    if (!psOptions->osWHERE.empty() &&
+        poLayer->SetAttributeFilter(psOptions->osWHERE.c_str()) != OGRERR_NONE)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "SetAttributeFilter(%s) on layer '%s' failed.",
+                 psOptions->osWHERE.c_str(), poLayer->GetName());
+        return false;
+    }
+    ApplySpatialFilter(
+        poLayer, psOptions->poSpatialFilter.get(), poSpatSRS.get(),
+        psOptions->bGeomFieldSet ? psOptions->osGeomField.c_str() : nullptr,
+        poSourceSRS.get());
+
+    std::unique_ptr<OGRSplitListFieldLayer> poSLFLayer;
+    OGRLayer *poPassedLayer = poLayer;
+    if (psOptions->bSplitListFields)
+    {
+        poSLFLayer = std::make_unique<OGRSplitListFieldLayer>(
+            poLayer, psOptions->nMaxSplitListSubFields);
+        if (poSLFLayer->BuildLayerDefn(nullptr, nullptr))
+            poPassedLayer = poSLFLayer.get();
+    }
+
+    SetupTargetLayer oSetup(*psCtxt->poSetup);
+    oSetup.m_poSrcDS = poSrcDS.get();
+    oSetup.m_poDstDS = poDstDS.get();
+    oSetup.m_poOutputSRS = poOutputSRS.get();
+
+    LayerTranslator oTranslator;
+    oTranslator.m_poSrcDS = poSrcDS.get();
+    oTranslator.m_poODS = poDstDS.get();
+    oTranslator.m_bTransform = poTemplate->m_bTransform;
+    oTranslator.m_bWrapDateline = poTemplate->m_bWrapDateline;
+    oTranslator.m_osDateLineOffset = poTemplate->m_osDateLineOffset;
+    oTranslator.m_poOutputSRS = poOutputSRS.get();
+    oTranslator.m_bNullifyOutputSRS = poTemplate->m_bNullifyOutputSRS;
+    oTranslator.m_poUserSourceSRS = poSourceSRS.get();
+    oTranslator.m_eGType = poTemplate->m_eGType;
+    oTranslator.m_eGeomTypeConversion = poTemplate->m_eGeomTypeConversion;
+    oTranslator.m_bMakeValid = poTemplate->m_bMakeValid;
+    oTranslator.m_nCoordDim = poTemplate->m_nCoordDim;
+    oTranslator.m_eGeomOp = poTemplate->m_eGeomOp;
+    oTranslator.m_dfGeomOpParam = poTemplate->m_dfGeomOpParam;
+    oTranslator.m_bWarnedClipSrcSRS = poTemplate->m_bWarnedClipSrcSRS;
+    oTranslator.m_poClipSrcOri = poClipSrc.get();
+    oTranslator.m_bWarnedClipDstSRS = poTemplate->m_bWarnedClipDstSRS;
+    oTranslator.m_poClipDstOri = poClipDst.get();
+    oTranslator.m_bExplodeCollections = poTemplate->m_bExplodeCollections;
+    oTranslator.m_bNativeData = poTemplate->m_bNativeData;
+    oTranslator.m_nLimit = poTemplate->m_nLimit;
+
+    GDALProgressFunc pfnProgress = nullptr;
+    if (psOptions->bDisplayProgress && psCtxt->nCountLayersFeatures != 0)
+        pfnProgress = ParallelLayerProgress;
+
+    GIntBig nTotalEventsDone = 0;
+    auto psInfo =
+        oSetup.Setup(poPassedLayer, nullptr, psOptions, nTotalEventsDone);
+    poPassedLayer->ResetReading();
+    bool bRet = psInfo != nullptr &&
+                oTranslator.Translate(nullptr, psInfo.get(),
+                                      psJob->nCountFeatures, nullptr,
+                                      nTotalEventsDone, pfnProgress, psJob,
+                                      psOptions);
+    psInfo.reset();
+    poSLFLayer.reset();
+    if (poDstDS->Close() != CE_None)
+        bRet = false;
+    return bRet;
+}
+
+static void TranslateLayerJobFunc(void *pData)
+{
+    auto psJob = static_cast<ParallelLayerJob *>(pData);
+    CPLInstallErrorHandlerAccumulator(psJob->aoErrors);
+    psJob->bOK = TranslateLayerInWorker(psJob);
+    CPLUninstallErrorHandlerAccumulator();
+}
+
+// Translate each source layer in a worker thread, with its own handles on
+// the source and target datasets. Errors are re-emitted, and failures
+// reported, in the order of the layers. Returns false if the translation of
+// a layer failed and -skipfailures is not specified.
+static bool TranslateLayersInParallel(
+    GDALDataset *poDS, const std::vector<OGRLayer *> &apoLayers,
+    const std::vector<GIntBig> &anLayerCountFeatures,
+    GIntBig nCountLayersFeatures, const std::string &osDestFilename,
+    GDALDriver *poDstDriver, const SetupTargetLayer &oSetup,
+    const LayerTranslator &oTranslator, const OGRSpatialReference *poSpatSRS,
+    const OGRSpatialReference *poSourceSRS,
+    GDALVectorTranslateOptions *psOptions)
+{
+    ParallelLayersContext sCtxt;
+    sCtxt.osSrcName = poDS->GetDescription();
+    sCtxt.aosSrcDrivers.AddString(poDS->GetDriver()->GetDescription());
+    sCtxt.aosSrcOpenOptions = CSLDuplicate(poDS->GetOpenOptions());
+    sCtxt.osDstName = osDestFilename;
+    sCtxt.aosDstDrivers.AddString(poDstDriver->GetDescription());
+    sCtxt.psOptions = psOptions;
+    sCtxt.poSetup = &oSetup;
+    sCtxt.poTranslator = &oTranslator;
+    sCtxt.poSpatSRS = poSpatSRS;
+    sCtxt.poSourceSRS = poSourceSRS;
+    sCtxt.nCountLayersFeatures = nCountLayersFeatures;
+    sCtxt.adfLayerComplete.resize(apoLayers.size());
+
+    std::vector<ParallelLayerJob> asJobs;
+    for (int iLayer = 0; iLayer < static_cast<int>(apoLayers.size());
+         ++iLayer)
+    {
+        OGRLayer *poLayer = apoLayers[iLayer];
+        if (poLayer == nullptr)
+            continue;
+        ParallelLayerJob sJob;
+        sJob.psCtxt = &sCtxt;
+        sJob.iLayer = iLayer;
+        sJob.osSrcLayerName = poLayer->GetName();
+        sJob.nCountFeatures = anLayerCountFeatures[iLayer];
+        for (int i = 0; i < poDS->GetLayerCount(); ++i)
+        {
+            if (poDS->GetLayer(i) == poLayer)
+            {
+                sJob.iSrcLayer = i;
+                break;
+            }
+        }
+        asJobs.push_back(std::move(sJob));
+    }
+
+    const int nThreads = std::min(psOptions->nParallelLayers,
+                                  static_cast<int>(asJobs.size()));
+    CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(nThreads);
+    if (poPool == nullptr)
+    {
+        for (auto &sJob : asJobs)
+            TranslateLayerJobFunc(&sJob);
+    }
+    else
+    {
+        auto poQueue = poPool->CreateJobQueue();
+        for (auto &sJob : asJobs)
+            poQueue->SubmitJob(TranslateLayerJobFunc, &sJob);
+        poQueue->WaitCompletion();
+    }
+
+    bool bRet = true;
+    for (const auto &sJob : asJobs)
+    {
+        for (const auto &oError : sJob.aoErrors)
+        {
+            CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+        }
+        if (!sJob.bOK && !psOptions->bSkipFailures && bRet)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Terminating translation prematurely after failed\n"
+                     "translation of layer %s (use -skipfailures to skip "
+                     "errors)",
+                     sJob.osSrcLayerName.c_str());
+            bRet = false;
+        }
+    }
+    return bRet;
+}
+
 /************************************************************************/
 /*                           GDALVectorTranslate()                      */
 /************************************************************************/
@@ -3379,8 +3926,54 @@ GDALDatasetH GDALVectorTranslate(const char *pszDest, GDALDatasetH hDstDS,
             }
         }
 
+        bool bParallelLayers = false;
+        if (psOptions->nParallelLayers > 1 && nLayerCount > 1)
+        {
+            std::string osReason;
+            bParallelLayers = CanTranslateLayersInParallel(
+                poDS, poODS, hDstDS, osDestFilename,
+                poGCPCoordTrans != nullptr, psOptions.get(), osReason);
+            if (!bParallelLayers)
+            {
+                CPLError(CE_Warning, CPLE_NotSupported,
+                         "-parallel_layers ignored: %s.", osReason.c_str());
+            }
+        }
+
         /* Second pass to do the real job */
-        for (int iLayer = 0; iLayer < nLayerCount && nRetCode == 0; iLayer++)
+        if (bParallelLayers)
+        {
+            // Workers open their own handles on the output dataset, so close
+            // ours while they run, and reopen it afterwards so that it
+            // reflects the layers they created.
+            GDALDriver *poODriver = poODS->GetDriver();
+            if (GDALClose(poODS) != CE_None)
+                nRetCode = 1;
+            poODS = nullptr;
+            if (nRetCode == 0 &&
+                !TranslateLayersInParallel(
+                    poDS, apoLayers, anLayerCountFeatures,
+                    nCountLayersFeatures, osDestFilename, poODriver, oSetup,
+                    oTranslator, poSpatSRS.get(), poSourceSRS,
+                    psOptions.get()))
+            {
+                nRetCode = 1;
+            }
+            const char *const apszDrivers[] = {poODriver->GetDescription(),
+                                               nullptr};
+            poODS = GDALDataset::Open(
+                osDestFilename,
+                GDAL_OF_VECTOR | GDAL_OF_UPDATE | GDAL_OF_VERBOSE_ERROR,
+                apszDrivers, psOptions->aosDestOpenOptions.List(), nullptr);
+            if (poODS == nullptr)
+            {
+                delete poGCPCoordTrans;
+                return nullptr;
+            }
+        }
+        for (int iLayer = 0;
+             !bParallelLayers && iLayer < nLayerCount && nRetCode == 0;
+             iLayer++)
         {
             OGRLayer *poLayer = apoLayers[iLayer];
             if (poLayer == nullptr)
@@ -3839,52 +4432,216 @@ static void DoFieldTypeConversion(GDALDataset *poDstDS,
 }
 
 /************************************************************************/
-/*                 SetupTargetLayer::CanUseWriteArrowBatch()            */
+/*            SetupTargetLayer::SetIgnoredFieldsFromSelection()         */
 /************************************************************************/
 
-bool SetupTargetLayer::CanUseWriteArrowBatch(
-    OGRLayer *poSrcLayer, OGRLayer *poDstLayer, bool bJustCreatedLayer,
-    const GDALVectorTranslateOptions *psOptions, bool &bError)
+/* Use SetIgnoredFields() on source layer if available, to skip fields that
+ * are neither selected with -select nor used by -where or -zfield. */
+void SetupTargetLayer::SetIgnoredFieldsFromSelection(OGRLayer *poSrcLayer)
 {
-    bError = false;
+    if (!poSrcLayer->TestCapability(OLCIgnoreFields))
+        return;
 
-    // Check if we can use the Arrow interface to get and write features
-    // as it will be faster if the input driver has a fast
-    // implementation of GetArrowStream().
-    // We also can only do that only if using ogr2ogr without options that
-    // alter features.
-    // OGR2OGR_USE_ARROW_API config option is mostly for testing purposes
-    // or as a safety belt if things turned bad...
-    bool bUseWriteArrowBatch = false;
-    if (((poSrcLayer->TestCapability(OLCFastGetArrowStream) &&
-          // As we don't control the input array size when the input or output
-          // drivers are Arrow/Parquet (as they don't use the generic
-          // implementation), we can't guarantee that ROW_GROUP_SIZE/BATCH_SIZE
-          // layer creation options will be honored.
-          !psOptions->aosLCO.FetchNameValue("ROW_GROUP_SIZE") &&
-          !psOptions->aosLCO.FetchNameValue("BATCH_SIZE") &&
-          CPLTestBool(CPLGetConfigOption("OGR2OGR_USE_ARROW_API", "YES"))) ||
-         CPLTestBool(CPLGetConfigOption("OGR2OGR_USE_ARROW_API", "NO"))) &&
-        !psOptions->bSkipFailures && !psOptions->bTransform &&
-        !psOptions->poClipSrc && !psOptions->poClipDst &&
-        psOptions->oGCPs.nGCPCount == 0 && !psOptions->bWrapDateline &&
-        !m_papszSelFields && !m_bAddMissingFields &&
-        m_eGType == GEOMTYPE_UNCHANGED && psOptions->eGeomOp == GEOMOP_NONE &&
-        m_eGeomTypeConversion == GTC_DEFAULT && m_nCoordDim < 0 &&
-        !m_papszFieldTypesToString && !m_papszMapFieldType &&
-        !m_bUnsetFieldWidth && !m_bExplodeCollections && !m_pszZField &&
-        m_bExactFieldNameMatch && !m_bForceNullable && !m_bResolveDomains &&
-        !m_bUnsetDefault && psOptions->nFIDToFetch == OGRNullFID &&
-        !psOptions->bMakeValid)
+    OGRFeatureDefn *poSrcFDefn = poSrcLayer->GetLayerDefn();
+    char **papszWHEREUsedFields = nullptr;
+
+    if (m_pszWHERE)
     {
-        struct ArrowArrayStream streamSrc;
-        if (poSrcLayer->GetArrowStream(&streamSrc, nullptr))
+        /* We must not ignore fields used in the -where expression
+         * (#4015) */
+        OGRFeatureQuery oFeatureQuery;
+        if (oFeatureQuery.Compile(poSrcFDefn, m_pszWHERE, FALSE, nullptr) !=
+            OGRERR_NONE)
         {
-            struct ArrowSchema schemaSrc;
-            if (streamSrc.get_schema(&streamSrc, &schemaSrc) == 0)
+            return;
+        }
+        papszWHEREUsedFields = oFeatureQuery.GetUsedFields();
+    }
+
+    char **papszIgnoredFields = nullptr;
+
+    for (int iSrcField = 0; iSrcField < poSrcFDefn->GetFieldCount();
+         iSrcField++)
+    {
+        const char *pszFieldName =
+            poSrcFDefn->GetFieldDefn(iSrcField)->GetNameRef();
+        bool bFieldRequested = false;
+        for (int iField = 0; m_papszSelFields && m_papszSelFields[iField];
+             iField++)
+        {
+            if (EQUAL(pszFieldName, m_papszSelFields[iField]))
             {
-                std::string osErrorMsg;
-                if (poDstLayer->IsArrowSchemaSupported(&schemaSrc, nullptr,
+                bFieldRequested = true;
+                break;
+            }
+        }
+        bFieldRequested |=
+            CSLFindString(papszWHEREUsedFields, pszFieldName) >= 0;
+        bFieldRequested |=
+            (m_pszZField != nullptr && EQUAL(pszFieldName, m_pszZField));
+
+        /* If source field not requested, add it to ignored files list */
+        if (!bFieldRequested)
+            papszIgnoredFields = CSLAddString(papszIgnoredFields, pszFieldName);
+    }
+    poSrcLayer->SetIgnoredFields(const_cast<const char **>(papszIgnoredFields));
+    CSLDestroy(papszIgnoredFields);
+    CSLDestroy(papszWHEREUsedFields);
+}
+
+/************************************************************************/
+/*               SetupTargetLayer::CanReprojectArrowBatch()             */
+/************************************************************************/
+
+/* Whether reprojection can be done by TranslateArrow() by transforming the
+ * coordinates of the WKB geometry columns, with the same result as
+ * OGRGeometryFactory::transformWithOptions() on each feature. */
+bool SetupTargetLayer::CanReprojectArrowBatch(
+    OGRLayer *poSrcLayer, OGRLayer *poDstLayer,
+    const GDALVectorTranslateOptions *psOptions)
+{
+    if (!m_poOutputSRS)
+        return false;
+
+    // Geometries reprojected to a geographic CRS may need to be split at
+    // the antimeridian.
+    const bool bOutputIsGeographic = m_poOutputSRS->IsGeographic();
+    if (bOutputIsGeographic && !psOptions->osSourceSRSDef.empty())
+        return false;
+
+    const bool bDstSupportsCurves =
+        CPL_TO_BOOL(poDstLayer->TestCapability(OLCCurveGeometries));
+    const OGRFeatureDefn *poSrcFDefn = poSrcLayer->GetLayerDefn();
+    for (int i = 0; i < poSrcFDefn->GetGeomFieldCount(); ++i)
+    {
+        const auto poGeomFieldDefn = poSrcFDefn->GetGeomFieldDefn(i);
+        const auto poSRS = poGeomFieldDefn->GetSpatialRef();
+        if (!poSRS && psOptions->osSourceSRSDef.empty() &&
+            psOptions->osCTPipeline.empty())
+        {
+            // The source SRS would have to be determined per feature
+            return false;
+        }
+        if (bOutputIsGeographic && (!poSRS || !poSRS->IsGeographic()))
+            return false;
+
+        // Curve geometries are linearized before reprojection if the output
+        // layer does not support them.
+        const auto eGType = wkbFlatten(poGeomFieldDefn->GetType());
+        if (!bDstSupportsCurves &&
+            (eGType == wkbUnknown || eGType == wkbGeometryCollection ||
+             OGR_GT_IsNonLinear(eGType)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*             SetupTargetLayer::CanSelectFieldsInArrowBatch()          */
+/************************************************************************/
+
+/* Whether -select only refers to attribute fields, in which case the
+ * non-selected columns can be dropped from the Arrow batches. */
+bool SetupTargetLayer::CanSelectFieldsInArrowBatch(OGRLayer *poSrcLayer,
+                                                   bool bJustCreatedLayer)
+{
+    if (!bJustCreatedLayer)
+        return false;
+    const OGRFeatureDefn *poSrcFDefn = poSrcLayer->GetLayerDefn();
+    for (int iField = 0; m_papszSelFields && m_papszSelFields[iField];
+         iField++)
+    {
+        if (poSrcFDefn->GetFieldIndex(m_papszSelFields[iField]) < 0)
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*            SetupTargetLayer::CanPromoteToMultiInArrowBatch()         */
+/************************************************************************/
+
+/* Whether -nlt PROMOTE_TO_MULTI can be done by TranslateArrow() by wrapping
+ * each single WKB geometry into a multi geometry of one part. */
+bool SetupTargetLayer::CanPromoteToMultiInArrowBatch(OGRLayer *poSrcLayer)
+{
+    const OGRFeatureDefn *poSrcFDefn = poSrcLayer->GetLayerDefn();
+    for (int i = 0; i < poSrcFDefn->GetGeomFieldCount(); ++i)
+    {
+        const auto eGType =
+            wkbFlatten(poSrcFDefn->GetGeomFieldDefn(i)->GetType());
+        if (eGType != wkbPoint && eGType != wkbLineString &&
+            eGType != wkbPolygon && eGType != wkbMultiPoint &&
+            eGType != wkbMultiLineString && eGType != wkbMultiPolygon)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                 SetupTargetLayer::CanUseWriteArrowBatch()            */
+/************************************************************************/
+
+bool SetupTargetLayer::CanUseWriteArrowBatch(
+    OGRLayer *poSrcLayer, OGRLayer *poDstLayer, bool bJustCreatedLayer,
+    const GDALVectorTranslateOptions *psOptions, std::vector<int> &anMap,
+    bool &bError)
+{
+    bError = false;
+
+    // Check if we can use the Arrow interface to get and write features
+    // as it will be faster if the input driver has a fast
+    // implementation of GetArrowStream().
+    // We also can only do that only if using ogr2ogr without options that
+    // alter features.
+    // OGR2OGR_USE_ARROW_API config option is mostly for testing purposes
+    // or as a safety belt if things turned bad...
+    bool bUseWriteArrowBatch = false;
+    if (((poSrcLayer->TestCapability(OLCFastGetArrowStream) &&
+          // As we don't control the input array size when the input or output
+          // drivers are Arrow/Parquet (as they don't use the generic
+          // implementation), we can't guarantee that ROW_GROUP_SIZE/BATCH_SIZE
+          // layer creation options will be honored.
+          !psOptions->aosLCO.FetchNameValue("ROW_GROUP_SIZE") &&
+          !psOptions->aosLCO.FetchNameValue("BATCH_SIZE") &&
+          CPLTestBool(CPLGetConfigOption("OGR2OGR_USE_ARROW_API", "YES"))) ||
+         CPLTestBool(CPLGetConfigOption("OGR2OGR_USE_ARROW_API", "NO"))) &&
+        !psOptions->bSkipFailures &&
+        (!psOptions->bTransform ||
+         CanReprojectArrowBatch(poSrcLayer, poDstLayer, psOptions)) &&
+        !psOptions->poClipSrc && !psOptions->poClipDst &&
+        psOptions->oGCPs.nGCPCount == 0 && !psOptions->bWrapDateline &&
+        (!m_bSelFieldsSet ||
+         CanSelectFieldsInArrowBatch(poSrcLayer, bJustCreatedLayer)) &&
+        !m_bAddMissingFields && m_eGType == GEOMTYPE_UNCHANGED &&
+        psOptions->eGeomOp == GEOMOP_NONE &&
+        (m_eGeomTypeConversion == GTC_DEFAULT ||
+         (m_eGeomTypeConversion == GTC_PROMOTE_TO_MULTI &&
+          CanPromoteToMultiInArrowBatch(poSrcLayer))) &&
+        m_nCoordDim < 0 &&
+        !m_papszFieldTypesToString && !m_papszMapFieldType &&
+        !m_bUnsetFieldWidth && !m_bExplodeCollections && !m_pszZField &&
+        m_bExactFieldNameMatch && !m_bForceNullable && !m_bResolveDomains &&
+        !m_bUnsetDefault && psOptions->nFIDToFetch == OGRNullFID &&
+        !psOptions->bMakeValid)
+    {
+        // Restrict the columns returned by the source layer to the selected
+        // ones. Columns used only by -where are dropped by TranslateArrow().
+        if (m_bSelFieldsSet)
+            SetIgnoredFieldsFromSelection(poSrcLayer);
+
+        struct ArrowArrayStream streamSrc;
+        if (poSrcLayer->GetArrowStream(&streamSrc, nullptr))
+        {
+            struct ArrowSchema schemaSrc;
+            if (streamSrc.get_schema(&streamSrc, &schemaSrc) == 0)
+            {
+                std::string osErrorMsg;
+                if (poDstLayer->IsArrowSchemaSupported(&schemaSrc, nullptr,
                                                        osErrorMsg))
                 {
                     const OGRFeatureDefn *poSrcFDefn =
@@ -3897,7 +4654,32 @@ bool SetupTargetLayer::CanUseWriteArrowBatch(
                             poSrcFDefn->GetGeomFieldCount())
                     {
                         // Create output fields using CreateFieldFromArrowSchema()
-                        for (int i = 0; i < schemaSrc.n_children; ++i)
+                        // in the order of -select if specified.
+                        std::vector<int> anChildren;
+                        if (m_bSelFieldsSet)
+                        {
+                            for (int iField = 0; m_papszSelFields &&
+                                                 m_papszSelFields[iField];
+                                 ++iField)
+                            {
+                                for (int i = 0; i < schemaSrc.n_children; ++i)
+                                {
+                                    if (EQUAL(schemaSrc.children[i]->name,
+                                              m_papszSelFields[iField]))
+                                    {
+                                        anChildren.push_back(i);
+                                        break;
+                                    }
+                                }
+                            }
+                        }
+                        else
+                        {
+                            for (int i = 0; i < schemaSrc.n_children; ++i)
+                                anChildren.push_back(i);
+                        }
+
+                        for (const int i : anChildren)
                         {
                             const char *pszFieldName =
                                 schemaSrc.children[i]->name;
@@ -3953,16 +4735,21 @@ bool SetupTargetLayer::CanUseWriteArrowBatch(
                                 !EQUAL(pszFieldName,
                                        poSrcLayer->GetFIDColumn()) &&
                                 poSrcFDefn->GetGeomFieldIndex(pszFieldName) <
-                                    0 &&
-                                !poDstLayer->CreateFieldFromArrowSchema(
-                                    schemaSrc.children[i], nullptr))
+                                    0)
                             {
-                                CPLError(CE_Failure, CPLE_AppDefined,
-                                         "Cannot create field %s",
-                                         pszFieldName);
-                                schemaSrc.release(&schemaSrc);
-                                streamSrc.release(&streamSrc);
-                                return false;
+                                if (!poDstLayer->CreateFieldFromArrowSchema(
+                                        schemaSrc.children[i], nullptr))
+                                {
+                                    CPLError(CE_Failure, CPLE_AppDefined,
+                                             "Cannot create field %s",
+                                             pszFieldName);
+                                    schemaSrc.release(&schemaSrc);
+                                    streamSrc.release(&streamSrc);
+                                    return false;
+                                }
+                                if (iSrcField >= 0)
+                                    anMap[iSrcField] =
+                                        poDstFDefn->GetFieldCount() - 1;
                             }
                         }
                         bUseWriteArrowBatch = true;
@@ -3982,6 +4769,13 @@ bool SetupTargetLayer::CanUseWriteArrowBatch(
                                 if (schemaDst.n_children ==
                                     schemaSrc.n_children)
                                 {
+                                    for (int i = 0;
+                                         i < poSrcFDefn->GetFieldCount(); ++i)
+                                    {
+                                        anMap[i] = poDstFDefn->GetFieldIndex(
+                                            poSrcFDefn->GetFieldDefn(i)
+                                                ->GetNameRef());
+                                    }
                                     bUseWriteArrowBatch = true;
                                 }
                                 schemaDst.release(&schemaDst);
@@ -4617,8 +5411,9 @@ SetupTargetLayer::Setup(OGRLayer *poSrcLayer, const char *pszNewLayerName,
     }
 
     bool bError = false;
-    const bool bUseWriteArrowBatch = CanUseWriteArrowBatch(
-        poSrcLayer, poDstLayer, bJustCreatedLayer, psOptions, bError);
+    const bool bUseWriteArrowBatch =
+        CanUseWriteArrowBatch(poSrcLayer, poDstLayer, bJustCreatedLayer,
+                              psOptions, anMap, bError);
     if (bError)
         return nullptr;
 
@@ -4628,7 +5423,7 @@ SetupTargetLayer::Setup(OGRLayer *poSrcLayer, const char *pszNewLayerName,
 
     if (bUseWriteArrowBatch)
     {
-        // Fields created above
+        // Fields created and mapped above
     }
     else if (m_papszFieldMap && bAppend)
     {
@@ -4715,68 +5510,7 @@ SetupTargetLayer::Setup(OGRLayer *poSrcLayer, const char *pszNewLayerName,
             }
         }
 
-        /* --------------------------------------------------------------------
-         */
-        /* Use SetIgnoredFields() on source layer if available */
-        /* --------------------------------------------------------------------
-         */
-        if (poSrcLayer->TestCapability(OLCIgnoreFields))
-        {
-            bool bUseIgnoredFields = true;
-            char **papszWHEREUsedFields = nullptr;
-
-            if (m_pszWHERE)
-            {
-                /* We must not ignore fields used in the -where expression
-                 * (#4015) */
-                OGRFeatureQuery oFeatureQuery;
-                if (oFeatureQuery.Compile(poSrcLayer->GetLayerDefn(),
-                                          m_pszWHERE, FALSE,
-                                          nullptr) == OGRERR_NONE)
-                {
-                    papszWHEREUsedFields = oFeatureQuery.GetUsedFields();
-                }
-                else
-                {
-                    bUseIgnoredFields = false;
-                }
-            }
-
-            char **papszIgnoredFields = nullptr;
-
-            for (int iSrcField = 0;
-                 bUseIgnoredFields && iSrcField < poSrcFDefn->GetFieldCount();
-                 iSrcField++)
-            {
-                const char *pszFieldName =
-                    poSrcFDefn->GetFieldDefn(iSrcField)->GetNameRef();
-                bool bFieldRequested = false;
-                for (int iField = 0;
-                     m_papszSelFields && m_papszSelFields[iField]; iField++)
-                {
-                    if (EQUAL(pszFieldName, m_papszSelFields[iField]))
-                    {
-                        bFieldRequested = true;
-                        break;
-                    }
-                }
-                bFieldRequested |=
-                    CSLFindString(papszWHEREUsedFields, pszFieldName) >= 0;
-                bFieldRequested |= (m_pszZField != nullptr &&
-                                    EQUAL(pszFieldName, m_pszZField));
-
-                /* If source field not requested, add it to ignored files list
-                 */
-                if (!bFieldRequested)
-                    papszIgnoredFields =
-                        CSLAddString(papszIgnoredFields, pszFieldName);
-            }
-            if (bUseIgnoredFields)
-                poSrcLayer->SetIgnoredFields(
-                    const_cast<const char **>(papszIgnoredFields));
-            CSLDestroy(papszIgnoredFields);
-            CSLDestroy(papszWHEREUsedFields);
-        }
+        SetIgnoredFieldsFromSelection(poSrcLayer);
     }
     else if (!bAppend || m_bAddMissingFields)
     {
@@ -5462,15 +6196,388 @@ SetupCT(TargetLayerInfo *psInfo, OGRLayer *poSrcLayer, bool bTransform,
     return true;
 }
 
+/************************************************************************/
+/*                           ArrowBatchView                             */
+/************************************************************************/
+
+namespace
+{
+/** Columnar processing of the batches of the source Arrow stream before they
+ * are passed to WriteArrowBatch(): columns that are not selected are dropped,
+ * and WKB geometry columns are reprojected and/or promoted to multi
+ * geometries. Other columns are passed by reference to the source batch.
+ */
+class ArrowBatchView
+{
+  public:
+    struct Column
+    {
+        int iSrcChild = -1;
+        bool bPromoteToMulti = false;
+        std::unique_ptr<OGRWKBBatchTransformer> poTransformer{};
+    };
+
+    ArrowBatchView(const struct ArrowSchema *psSrcSchema,
+                   std::vector<Column> &&aoColumns);
+
+    /** Whether batches can be passed unmodified to WriteArrowBatch() */
+    bool IsIdentity() const
+    {
+        return m_bIdentity;
+    }
+
+    /** Schema of the output batches. Must not be released. */
+    const struct ArrowSchema *GetSchema() const
+    {
+        return &m_sSchema;
+    }
+
+    bool Process(struct ArrowArray *psSrcArray, struct ArrowArray *psOutArray);
+
+  private:
+    std::vector<Column> m_aoColumns;
+    std::vector<struct ArrowSchema *> m_apsSchemaChildren{};
+    struct ArrowSchema m_sSchema
+    {
+    };
+    bool m_bIdentity = true;
+
+    /** Private data of output batches, which own the source batch */
+    struct BatchPrivateData
+    {
+        struct ArrowArray sSrcArray
+        {
+        };
+        std::vector<struct ArrowArray> asChildren{};
+        std::vector<struct ArrowArray *> apsChildren{};
+        std::vector<std::array<const void *, 3>> aapBuffers{};
+        std::vector<std::vector<GByte>> aabyBuffers{};
+    };
+
+    template <class OffsetType>
+    static bool ProcessGeomColumn(Column &oColumn,
+                                  const struct ArrowArray *psSrcChild,
+                                  int64_t nBase, BatchPrivateData &sPrivate,
+                                  struct ArrowArray &sOutChild);
+
+    static void ReleaseArray(struct ArrowArray *psArray);
+
+    static void ReleaseChild(struct ArrowArray *psArray)
+    {
+        // Buffers are owned by the parent
+        psArray->release = nullptr;
+    }
+
+    static void ReleaseSchema(struct ArrowSchema *psSchema)
+    {
+        // Owned by the ArrowBatchView object
+        psSchema->release = nullptr;
+    }
+
+    ArrowBatchView(const ArrowBatchView &) = delete;
+    ArrowBatchView &operator=(const ArrowBatchView &) = delete;
+};
+
+/************************************************************************/
+/*                   ArrowBatchView::ArrowBatchView()                   */
+/************************************************************************/
+
+ArrowBatchView::ArrowBatchView(const struct ArrowSchema *psSrcSchema,
+                               std::vector<Column> &&aoColumns)
+    : m_aoColumns(std::move(aoColumns))
+{
+    m_bIdentity = static_cast<int64_t>(m_aoColumns.size()) ==
+                  psSrcSchema->n_children;
+    for (size_t i = 0; i < m_aoColumns.size(); ++i)
+    {
+        const auto &oColumn = m_aoColumns[i];
+        m_apsSchemaChildren.push_back(
+            psSrcSchema->children[oColumn.iSrcChild]);
+        if (oColumn.iSrcChild != static_cast<int>(i) ||
+            oColumn.bPromoteToMulti || oColumn.poTransformer)
+        {
+            m_bIdentity = false;
+        }
+    }
+
+    // Shallow copy of the source schema, with a subset of its children
+    m_sSchema = *psSrcSchema;
+    m_sSchema.n_children = static_cast<int64_t>(m_apsSchemaChildren.size());
+    m_sSchema.children = m_apsSchemaChildren.data();
+    m_sSchema.release = ReleaseSchema;
+}
+
+/************************************************************************/
+/*                   ArrowBatchView::ReleaseArray()                     */
+/************************************************************************/
+
+void ArrowBatchView::ReleaseArray(struct ArrowArray *psArray)
+{
+    auto psPrivate = static_cast<BatchPrivateData *>(psArray->private_data);
+    if (psPrivate->sSrcArray.release)
+        psPrivate->sSrcArray.release(&psPrivate->sSrcArray);
+    delete psPrivate;
+    psArray->private_data = nullptr;
+    psArray->release = nullptr;
+}
+
+/************************************************************************/
+/*                 ArrowBatchView::ProcessGeomColumn()                  */
+/************************************************************************/
+
+template <class OffsetType>
+bool ArrowBatchView::ProcessGeomColumn(Column &oColumn,
+                                       const struct ArrowArray *psSrcChild,
+                                       int64_t nBase,
+                                       BatchPrivateData &sPrivate,
+                                       struct ArrowArray &sOutChild)
+{
+    const int64_t nLength = psSrcChild->length;
+    const uint8_t *pabyValidity =
+        psSrcChild->null_count != 0
+            ? static_cast<const uint8_t *>(psSrcChild->buffers[0])
+            : nullptr;
+    const OffsetType *panSrcOffsets =
+        static_cast<const OffsetType *>(psSrcChild->buffers[1]);
+    const GByte *pabySrcData =
+        static_cast<const GByte *>(psSrcChild->buffers[2]);
+    const auto IsNull = [pabyValidity](int64_t i)
+    { return pabyValidity && (pabyValidity[i / 8] & (1 << (i % 8))) == 0; };
+
+    const OffsetType *panOffsets = panSrcOffsets;
+    sPrivate.aabyBuffers.emplace_back();
+    auto &abyData = sPrivate.aabyBuffers.back();
+
+    if (oColumn.bPromoteToMulti)
+    {
+        sPrivate.aabyBuffers.emplace_back(
+            static_cast<size_t>(nBase + nLength + 1) * sizeof(OffsetType));
+        OffsetType *panNewOffsets =
+            reinterpret_cast<OffsetType *>(sPrivate.aabyBuffers.back().data());
+        panOffsets = panNewOffsets;
+
+        constexpr size_t HEADER_SIZE = 1 + 2 * sizeof(uint32_t);
+        abyData.reserve(
+            static_cast<size_t>(panSrcOffsets[nBase + nLength] -
+                                panSrcOffsets[nBase]) +
+            static_cast<size_t>(nLength) * HEADER_SIZE);
+        for (int64_t i = nBase; i < nBase + nLength; ++i)
+        {
+            panNewOffsets[i] = static_cast<OffsetType>(abyData.size());
+            const size_t nWKBSize =
+                static_cast<size_t>(panSrcOffsets[i + 1] - panSrcOffsets[i]);
+            if (IsNull(i) || nWKBSize == 0)
+                continue;
+            const GByte *pabyWKB = pabySrcData + panSrcOffsets[i];
+            OGRwkbGeometryType eGType = wkbUnknown;
+            if (nWKBSize < 1 + sizeof(uint32_t) ||
+                OGRReadWKBGeometryType(pabyWKB, wkbVariantIso, &eGType) !=
+                    OGRERR_NONE)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined, "Invalid WKB geometry");
+                return false;
+            }
+            const auto eFlatType = wkbFlatten(eGType);
+            if (!OGR_GT_IsSubClassOf(eFlatType, wkbGeometryCollection))
+            {
+                if (eFlatType == wkbTriangle || eFlatType == wkbTIN ||
+                    eFlatType == wkbPolyhedralSurface ||
+                    eFlatType == wkbUnknown)
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "Cannot promote %s geometry to a multi geometry",
+                             OGRGeometryTypeToName(eGType));
+                    return false;
+                }
+
+                // Wrap the geometry into a multi geometry of one part,
+                // using the byte order of the part. Empty geometries are
+                // turned into empty multi geometries.
+                const bool bNeedSwap = OGR_SWAP(static_cast<OGRwkbByteOrder>(
+                    DB2_V72_FIX_BYTE_ORDER(pabyWKB[0])));
+                bool bEmpty = false;
+                if (eFlatType == wkbPoint)
+                {
+                    double dfX = 0;
+                    if (nWKBSize >= 1 + sizeof(uint32_t) + sizeof(double))
+                        memcpy(&dfX, pabyWKB + 1 + sizeof(uint32_t),
+                               sizeof(double));
+                    bEmpty = std::isnan(dfX);
+                }
+                else if (nWKBSize >= 1 + 2 * sizeof(uint32_t))
+                {
+                    uint32_t nCount = 0;
+                    memcpy(&nCount, pabyWKB + 1 + sizeof(uint32_t),
+                           sizeof(uint32_t));
+                    bEmpty = nCount == 0;
+                }
+
+                const auto eMultiType = OGR_GT_GetCollection(eGType);
+                uint32_t nMultiType = wkbFlatten(eMultiType);
+                if (OGR_GT_HasZ(eMultiType))
+                    nMultiType += 1000;
+                if (OGR_GT_HasM(eMultiType))
+                    nMultiType += 2000;
+                uint32_t nParts = bEmpty ? 0 : 1;
+                if (bNeedSwap)
+                {
+                    CPL_SWAP32PTR(&nMultiType);
+                    CPL_SWAP32PTR(&nParts);
+                }
+                GByte abyHeader[HEADER_SIZE];
+                abyHeader[0] = pabyWKB[0];
+                memcpy(abyHeader + 1, &nMultiType, sizeof(uint32_t));
+                memcpy(abyHeader + 1 + sizeof(uint32_t), &nParts,
+                       sizeof(uint32_t));
+                abyData.insert(abyData.end(), abyHeader,
+                               abyHeader + HEADER_SIZE);
+                if (bEmpty)
+                    continue;
+            }
+            abyData.insert(abyData.end(), pabyWKB, pabyWKB + nWKBSize);
+        }
+        if (abyData.size() >
+            static_cast<size_t>(std::numeric_limits<OffsetType>::max()))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Too large geometry column after promotion to multi "
+                     "geometries");
+            return false;
+        }
+        panNewOffsets[nBase + nLength] =
+            static_cast<OffsetType>(abyData.size());
+    }
+    else if (pabySrcData)
+    {
+        // Source buffers may be read-only: work on a copy.
+        abyData.assign(pabySrcData,
+                       pabySrcData + panSrcOffsets[nBase + nLength]);
+    }
+
+    if (oColumn.poTransformer)
+    {
+        // Register all geometries of the batch, and transform their
+        // coordinates at once.
+        auto &oTransformer = *(oColumn.poTransformer);
+        oTransformer.Reset();
+        for (int64_t i = nBase; i < nBase + nLength; ++i)
+        {
+            const size_t nWKBSize =
+                static_cast<size_t>(panOffsets[i + 1] - panOffsets[i]);
+            if (IsNull(i) || nWKBSize == 0)
+                continue;
+            if (!oTransformer.AddGeometry(abyData.data() + panOffsets[i],
+                                          nWKBSize))
+            {
+                CPLError(CE_Failure, CPLE_AppDefined, "Invalid WKB geometry");
+                return false;
+            }
+        }
+        if (!oTransformer.Transform())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Failed to reproject features (geometries probably out "
+                     "of source or destination SRS).");
+            return false;
+        }
+    }
+
+    sPrivate.aapBuffers.push_back(
+        {psSrcChild->buffers[0], panOffsets,
+         abyData.empty() ? pabySrcData : abyData.data()});
+    sOutChild.n_buffers = 3;
+    sOutChild.buffers = sPrivate.aapBuffers.back().data();
+    return true;
+}
+
+/************************************************************************/
+/*                      ArrowBatchView::Process()                       */
+/************************************************************************/
+
+/** Build in psOutArray the view of psSrcArray. Ownership of psSrcArray is
+ * transferred to psOutArray, or to this method in case of failure.
+ */
+bool ArrowBatchView::Process(struct ArrowArray *psSrcArray,
+                             struct ArrowArray *psOutArray)
+{
+    auto poPrivate = std::make_unique<BatchPrivateData>();
+    poPrivate->sSrcArray = *psSrcArray;
+    psSrcArray->release = nullptr;
+    const auto &sSrcArray = poPrivate->sSrcArray;
+
+    try
+    {
+        const size_t nColumns = m_aoColumns.size();
+        poPrivate->asChildren.resize(nColumns);
+        poPrivate->apsChildren.resize(nColumns);
+        // Pointers to elements are kept, so avoid any reallocation
+        poPrivate->aapBuffers.reserve(nColumns);
+        poPrivate->aabyBuffers.reserve(2 * nColumns);
+
+        for (size_t i = 0; i < nColumns; ++i)
+        {
+            auto &oColumn = m_aoColumns[i];
+            const auto psSrcChild = sSrcArray.children[oColumn.iSrcChild];
+            auto &sChild = poPrivate->asChildren[i];
+            sChild = *psSrcChild;
+            sChild.release = ReleaseChild;
+            sChild.private_data = nullptr;
+            poPrivate->apsChildren[i] = &sChild;
+
+            if (oColumn.bPromoteToMulti || oColumn.poTransformer)
+            {
+                const int64_t nBase = sSrcArray.offset + psSrcChild->offset;
+                const bool bOK =
+                    m_apsSchemaChildren[i]->format[0] == 'z'
+                        ? ProcessGeomColumn<int32_t>(oColumn, psSrcChild,
+                                                     nBase, *poPrivate, sChild)
+                        : ProcessGeomColumn<int64_t>(oColumn, psSrcChild,
+                                                     nBase, *poPrivate, sChild);
+                if (!bOK)
+                {
+                    poPrivate->sSrcArray.release(&poPrivate->sSrcArray);
+                    return false;
+                }
+            }
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory when processing Arrow batch");
+        poPrivate->sSrcArray.release(&poPrivate->sSrcArray);
+        return false;
+    }
+
+    *psOutArray = sSrcArray;
+    psOutArray->n_children = static_cast<int64_t>(m_aoColumns.size());
+    psOutArray->children = poPrivate->apsChildren.data();
+    psOutArray->release = ReleaseArray;
+    psOutArray->private_data = poPrivate.release();
+    return true;
+}
+
+}  // namespace
+
 /************************************************************************/
 /*                 LayerTranslator::TranslateArrow()                    */
 /************************************************************************/
 
 bool LayerTranslator::TranslateArrow(
-    const TargetLayerInfo *psInfo, GIntBig nCountLayerFeatures,
+    TargetLayerInfo *psInfo, GIntBig nCountLayerFeatures,
     GIntBig *pnReadFeatureCount, GDALProgressFunc pfnProgress,
     void *pProgressArg, const GDALVectorTranslateOptions *psOptions)
 {
+    // Must be done before GetArrowStream(), as SetupCT() may change the
+    // active SRS of the source layer.
+    if (m_bTransform &&
+        !SetupCT(psInfo, psInfo->m_poSrcLayer, m_bTransform, m_bWrapDateline,
+                 m_osDateLineOffset, m_poUserSourceSRS, nullptr, m_poOutputSRS,
+                 m_poGCPCoordTrans, true))
+    {
+        return false;
+    }
+
     struct ArrowArrayStream stream;
     struct ArrowSchema schema;
     CPLStringList aosOptionsGetArrowStream;
@@ -5517,6 +6624,67 @@ bool LayerTranslator::TranslateArrow(
         return false;
     }
 
+    // Determine the columns to write, and the processing of geometry columns
+    const OGRFeatureDefn *poSrcFDefn = psInfo->m_poSrcLayer->GetLayerDefn();
+    std::vector<ArrowBatchView::Column> aoColumns;
+    for (int i = 0; i < static_cast<int>(schema.n_children); ++i)
+    {
+        const auto psChildSchema = schema.children[i];
+        const char *pszName = psChildSchema->name;
+        ArrowBatchView::Column oColumn;
+        oColumn.iSrcChild = i;
+
+        int iSrcGeomField = poSrcFDefn->GetGeomFieldIndex(pszName);
+        if (iSrcGeomField < 0 && poSrcFDefn->GetGeomFieldCount() > 0 &&
+            poSrcFDefn->GetGeomFieldDefn(0)->GetNameRef()[0] == '\0' &&
+            strcmp(pszName, OGRLayer::DEFAULT_ARROW_GEOMETRY_NAME) == 0)
+        {
+            iSrcGeomField = 0;
+        }
+
+        if (iSrcGeomField >= 0)
+        {
+            // Geometry fields of source and target layers are in the same
+            // order when using WriteArrowBatch()
+            OGRCoordinateTransformation *poCT =
+                iSrcGeomField <
+                        static_cast<int>(psInfo->m_aoReprojectionInfo.size())
+                    ? psInfo->m_aoReprojectionInfo[iSrcGeomField].m_poCT.get()
+                    : nullptr;
+            oColumn.bPromoteToMulti =
+                m_eGeomTypeConversion == GTC_PROMOTE_TO_MULTI;
+            if (poCT || oColumn.bPromoteToMulti)
+            {
+                if (strcmp(psChildSchema->format, "z") != 0 &&
+                    strcmp(psChildSchema->format, "Z") != 0)
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "Unexpected Arrow format '%s' for geometry "
+                             "column '%s'",
+                             psChildSchema->format, pszName);
+                    schema.release(&schema);
+                    stream.release(&stream);
+                    return false;
+                }
+                if (poCT)
+                {
+                    oColumn.poTransformer =
+                        std::make_unique<OGRWKBBatchTransformer>(poCT);
+                }
+            }
+        }
+        else if (psOptions->bSelFieldsSet)
+        {
+            // Drop columns that are not selected, but still returned by the
+            // source layer, typically because they are used by -where
+            const int iSrcField = poSrcFDefn->GetFieldIndex(pszName);
+            if (iSrcField >= 0 && psInfo->m_anMap[iSrcField] < 0)
+                continue;
+        }
+        aoColumns.push_back(std::move(oColumn));
+    }
+    ArrowBatchView oView(&schema, std::move(aoColumns));
+
     bool bRet = true;
 
     GIntBig nCount = 0;
@@ -5556,19 +6724,33 @@ bool LayerTranslator::TranslateArrow(
             nCount += array.length;
         }
 
+        // Drop, reproject or promote columns if needed
+        struct ArrowArray arrayView;
+        struct ArrowArray *psArrayToWrite = &array;
+        if (!oView.IsIdentity())
+        {
+            if (!oView.Process(&array, &arrayView))
+            {
+                bRet = false;
+                break;
+            }
+            psArrayToWrite = &arrayView;
+        }
+
         // Write batch to target layer
         if (!psInfo->m_poDstLayer->WriteArrowBatch(
-                &schema, &array, aosOptionsWriteArrowBatch.List()))
+                oView.GetSchema(), psArrayToWrite,
+                aosOptionsWriteArrowBatch.List()))
         {
             CPLError(CE_Failure, CPLE_AppDefined, "WriteArrowBatch() failed");
-            if (array.release)
-                array.release(&array);
+            if (psArrayToWrite->release)
+                psArrayToWrite->release(psArrayToWrite);
             bRet = false;
             break;
         }
 
-        if (array.release)
-            array.release(&array);
+        if (psArrayToWrite->release)
+            psArrayToWrite->release(psArrayToWrite);
 
         /* Report progress */
         if (pfnProgress)
@@ -5592,6 +6774,160 @@ bool LayerTranslator::TranslateArrow(
     return bRet;
 }
 
+/************************************************************************/
+/*                      CountClipGeometryPoints()                       */
+/************************************************************************/
+
+static size_t CountClipGeometryPoints(const OGRGeometry *poGeom)
+{
+    const auto eType = wkbFlatten(poGeom->getGeometryType());
+    if (OGR_GT_IsCurve(eType))
+        return static_cast<size_t>(poGeom->toCurve()->getNumPoints());
+    size_t nPoints = 0;
+    if (OGR_GT_IsSubClassOf(eType, wkbCurvePolygon))
+    {
+        for (const auto *poRing : *(poGeom->toCurvePolygon()))
+            nPoints += static_cast<size_t>(poRing->getNumPoints());
+    }
+    else if (OGR_GT_IsSubClassOf(eType, wkbGeometryCollection))
+    {
+        for (const auto *poSubGeom : *(poGeom->toGeometryCollection()))
+            nPoints += CountClipGeometryPoints(poSubGeom);
+    }
+    return nPoints;
+}
+
+/************************************************************************/
+/*               PreparedClipGeometry::PreparedClipGeometry()           */
+/************************************************************************/
+
+// Clip geometries with less points than that are used directly.
+constexpr size_t CLIP_TILING_MIN_POINTS = 1000;
+constexpr int CLIP_TILES_PER_DIM = 16;
+
+PreparedClipGeometry::PreparedClipGeometry(const OGRGeometry *poClipGeom)
+    : m_poClipGeom(poClipGeom)
+{
+    poClipGeom->getEnvelope(&m_sClipEnv);
+
+    // Prepared predicates and intersections with parts of invalid
+    // geometries may not be consistent with Intersection() on the whole
+    // geometry.
+    if (!OGRHasPreparedGeometrySupport() || !poClipGeom->IsValid())
+        return;
+
+    m_poPrepared.reset(OGRCreatePreparedGeometry(
+        OGRGeometry::ToHandle(const_cast<OGRGeometry *>(poClipGeom))));
+
+    if (poClipGeom->getDimension() == 2 &&
+        m_sClipEnv.MaxX > m_sClipEnv.MinX &&
+        m_sClipEnv.MaxY > m_sClipEnv.MinY &&
+        CountClipGeometryPoints(poClipGeom) >= CLIP_TILING_MIN_POINTS)
+    {
+        m_nTilesPerDim = CLIP_TILES_PER_DIM;
+        m_dfTileWidth = (m_sClipEnv.MaxX - m_sClipEnv.MinX) / m_nTilesPerDim;
+        m_dfTileHeight = (m_sClipEnv.MaxY - m_sClipEnv.MinY) / m_nTilesPerDim;
+        m_apoTiles.resize(m_nTilesPerDim * m_nTilesPerDim);
+        m_abTileComputed.resize(m_nTilesPerDim * m_nTilesPerDim);
+    }
+}
+
+/************************************************************************/
+/*                 PreparedClipGeometry::GetClipGeomPart()              */
+/************************************************************************/
+
+// Returns the part of the clip geometry to intersect with a feature of
+// envelope sEnv: the intersection of the clip geometry with a tile of the
+// grid if the feature is inside a single tile, or the whole clip geometry
+// otherwise.
+const OGRGeometry *
+PreparedClipGeometry::GetClipGeomPart(const OGREnvelope &sEnv)
+{
+    if (m_nTilesPerDim == 0)
+        return m_poClipGeom;
+
+    const double dfX = (sEnv.MinX - m_sClipEnv.MinX) / m_dfTileWidth;
+    const double dfY = (sEnv.MinY - m_sClipEnv.MinY) / m_dfTileHeight;
+    if (!(dfX >= 0 && dfX < m_nTilesPerDim && dfY >= 0 &&
+          dfY < m_nTilesPerDim))
+    {
+        return m_poClipGeom;
+    }
+    const int iX = static_cast<int>(dfX);
+    const int iY = static_cast<int>(dfY);
+
+    OGREnvelope sTileEnv;
+    sTileEnv.MinX = m_sClipEnv.MinX + iX * m_dfTileWidth;
+    sTileEnv.MinY = m_sClipEnv.MinY + iY * m_dfTileHeight;
+    sTileEnv.MaxX = iX + 1 == m_nTilesPerDim ? m_sClipEnv.MaxX
+                                             : sTileEnv.MinX + m_dfTileWidth;
+    sTileEnv.MaxY = iY + 1 == m_nTilesPerDim ? m_sClipEnv.MaxY
+                                             : sTileEnv.MinY + m_dfTileHeight;
+    if (!sTileEnv.Contains(sEnv))
+        return m_poClipGeom;
+
+    const int iTile = iY * m_nTilesPerDim + iX;
+    if (!m_abTileComputed[iTile])
+    {
+        m_abTileComputed[iTile] = true;
+        OGRLinearRing *poRing = new OGRLinearRing();
+        poRing->addPoint(sTileEnv.MinX, sTileEnv.MinY);
+        poRing->addPoint(sTileEnv.MinX, sTileEnv.MaxY);
+        poRing->addPoint(sTileEnv.MaxX, sTileEnv.MaxY);
+        poRing->addPoint(sTileEnv.MaxX, sTileEnv.MinY);
+        poRing->addPoint(sTileEnv.MinX, sTileEnv.MinY);
+        OGRPolygon oTile;
+        oTile.addRingDirectly(poRing);
+        m_apoTiles[iTile].reset(m_poClipGeom->Intersection(&oTile));
+    }
+    return m_apoTiles[iTile] ? m_apoTiles[iTile].get() : m_poClipGeom;
+}
+
+/************************************************************************/
+/*                   PreparedClipGeometry::Intersects()                 */
+/************************************************************************/
+
+bool PreparedClipGeometry::Intersects(const OGRGeometry *poGeom) const
+{
+    if (m_poPrepared)
+    {
+        return OGRPreparedGeometryIntersects(
+            m_poPrepared.get(),
+            OGRGeometry::ToHandle(const_cast<OGRGeometry *>(poGeom)));
+    }
+    return m_poClipGeom->Intersects(poGeom);
+}
+
+/************************************************************************/
+/*                      PreparedClipGeometry::Clip()                    */
+/************************************************************************/
+
+// Returns the intersection of poGeom with the clip geometry, or nullptr if
+// they do not intersect. Geometries fully inside the clip geometry are
+// returned as they are, without computing their intersection.
+std::unique_ptr<OGRGeometry>
+PreparedClipGeometry::Clip(const OGRGeometry *poGeom)
+{
+    OGREnvelope oDstEnv;
+    poGeom->getEnvelope(&oDstEnv);
+
+    if (!m_sClipEnv.Intersects(oDstEnv))
+        return nullptr;
+
+    if (m_poPrepared)
+    {
+        const auto hGeom =
+            OGRGeometry::ToHandle(const_cast<OGRGeometry *>(poGeom));
+        if (!OGRPreparedGeometryIntersects(m_poPrepared.get(), hGeom))
+            return nullptr;
+        if (OGRPreparedGeometryContains(m_poPrepared.get(), hGeom))
+            return std::unique_ptr<OGRGeometry>(poGeom->clone());
+    }
+
+    return std::unique_ptr<OGRGeometry>(
+        GetClipGeomPart(oDstEnv)->Intersection(poGeom));
+}
+
 /************************************************************************/
 /*                     LayerTranslator::Translate()                     */
 /************************************************************************/
@@ -5805,7 +7141,8 @@ bool LayerTranslator::Translate(
                         GetSrcClipGeom(poStolenGeometry->getSpatialReference());
 
                     if (poClipGeom != nullptr &&
-                        !poClipGeom->Intersects(poStolenGeometry.get()))
+                        !GetPreparedClipGeom(poClipGeom, m_poClipSrcPrepared)
+                             ->Intersects(poStolenGeometry.get()))
                     {
                         goto end_loop;
                     }
@@ -6017,17 +7354,9 @@ bool LayerTranslator::Translate(
                     std::unique_ptr<OGRGeometry> poClipped;
                     if (poClipGeom != nullptr)
                     {
-                        OGREnvelope oClipEnv;
-                        OGREnvelope oDstEnv;
-
-                        poClipGeom->getEnvelope(&oClipEnv);
-                        poDstGeometry->getEnvelope(&oDstEnv);
-
-                        if (oClipEnv.Intersects(oDstEnv))
-                        {
-                            poClipped.reset(
-                                poClipGeom->Intersection(poDstGeometry));
-                        }
+                        poClipped =
+                            GetPreparedClipGeom(poClipGeom, m_poClipSrcPrepared)
+                                ->Clip(poDstGeometry);
                     }
 
                     if (poClipped == nullptr || poClipped->IsEmpty())
@@ -6204,19 +7533,9 @@ bool LayerTranslator::Translate(
                             goto end_loop;
                         }
 
-                        std::unique_ptr<OGRGeometry> poClipped;
-
-                        OGREnvelope oClipEnv;
-                        OGREnvelope oDstEnv;
-
-                        poClipGeom->getEnvelope(&oClipEnv);
-                        poDstGeometry->getEnvelope(&oDstEnv);
-
-                        if (oClipEnv.Intersects(oDstEnv))
-                        {
-                            poClipped.reset(
-                                poClipGeom->Intersection(poDstGeometry));
-                        }
+                        std::unique_ptr<OGRGeometry> poClipped =
+                            GetPreparedClipGeom(poClipGeom, m_poClipDstPrepared)
+                                ->Clip(poDstGeometry);
 
                         if (poClipped == nullptr || poClipped->IsEmpty())
                         {
@@ -6398,6 +7717,7 @@ LayerTranslator::GetDstClipGeom(const OGRSpatialReference *poGeomSRS)
         {
             // Transform clip geom to geometry SRS
             m_poClipDstReprojectedToDstSRS.reset(m_poClipDstOri->clone());
+            m_poClipDstPrepared.reset();
             if (m_poClipDstReprojectedToDstSRS->transformTo(poGeomSRS) !=
                 OGRERR_NONE)
             {
@@ -6438,6 +7758,7 @@ LayerTranslator::GetSrcClipGeom(const OGRSpatialReference *poGeomSRS)
         {
             // Transform clip geom to geometry SRS
             m_poClipSrcReprojectedToSrcSRS.reset(m_poClipSrcOri->clone());
+            m_poClipSrcPrepared.reset();
             if (m_poClipSrcReprojectedToSrcSRS->transformTo(poGeomSRS) !=
                 OGRERR_NONE)
             {
@@ -6463,6 +7784,19 @@ LayerTranslator::GetSrcClipGeom(const OGRSpatialReference *poGeomSRS)
                                           : m_poClipSrcOri;
 }
 
+/************************************************************************/
+/*                LayerTranslator::GetPreparedClipGeom()                */
+/************************************************************************/
+
+PreparedClipGeometry *LayerTranslator::GetPreparedClipGeom(
+    const OGRGeometry *poClipGeom,
+    std::unique_ptr<PreparedClipGeometry> &poPrepared)
+{
+    if (!poPrepared || poPrepared->GetClipGeom() != poClipGeom)
+        poPrepared = std::make_unique<PreparedClipGeometry>(poClipGeom);
+    return poPrepared.get();
+}
+
 /************************************************************************/
 /*                   CHECK_HAS_ENOUGH_ADDITIONAL_ARGS()                 */
 /************************************************************************/
@@ -6782,6 +8116,24 @@ GDALVectorTranslateOptions *GDALVectorTranslateOptionsNew(
                     psOptions->nGroupTransactions = atoi(papszArgv[i]);
             }
         }
+        else if (EQUAL(papszArgv[i], "-parallel_layers"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            ++i;
+            if (EQUAL(papszArgv[i], "ALL_CPUS"))
+                psOptions->nParallelLayers = CPLGetNumCPUs();
+            else
+                psOptions->nParallelLayers = atoi(papszArgv[i]);
+            if (psOptions->nParallelLayers <= 0)
+            {
+                CPLError(CE_Failure, CPLE_IllegalArg,
+                         "Invalid value for -parallel_layers: %s",
+                         papszArgv[i]);
+                return nullptr;
+            }
+            psOptions->nParallelLayers =
+                std::min(psOptions->nParallelLayers, 128);
+        }
         else if (EQUAL(papszArgv[i], "-ds_transaction"))
         {
             psOptions->nLayerTransaction = FALSE;
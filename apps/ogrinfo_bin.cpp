@@ -52,7 +52,7 @@ static void Usage(bool bIsError, const char *pszErrorMsg = nullptr)
             "               [-sql <statement>|@<filename>] [-dialect "
             "<sql_dialect>] "
             "[-al] [-rl]\n"
-            "               [-so|-features] [-fields={YES|NO}]]\n"
+            "               [-so|-features] [-fields={YES|NO}]] [-explain]\n"
             "               [-geom={YES|NO|SUMMARY|WKT|ISO_WKT}] "
             "[-oo <NAME>=<VALUE>]...\n"
             "               [-nomd] [-listmdd] [-mdd {<domain>|all}]...\n"
@@ -39,6 +39,7 @@
 #include "ogr_geometry.h"
 #include "commonutils.h"
 
+#include <chrono>
 #include <set>
 
 /*! output format */
@@ -70,6 +71,7 @@ struct GDALVectorInfoOptions
     bool bVerbose = true;
     bool bSuperQuiet = false;
     bool bSummaryOnly = false;
+    bool bExplain = false;
     GIntBig nFetchFID = OGRNullFID;
     std::string osWKTFormat = "WKT2";
     std::string osFieldDomain{};
@@ -1390,6 +1392,72 @@ static void ReportOnLayer(CPLString &osRet, CPLJSONObject &oLayer,
         }
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Report the query plan, and time a read of the features.         */
+    /* -------------------------------------------------------------------- */
+    if (psOptions->bExplain)
+    {
+        const CPLStringList aosPlan(poLayer->ExplainQuery());
+
+        using namespace std::chrono;
+        const auto tStart = steady_clock::now();
+        poLayer->ResetReading();
+        GIntBig nFeatures = 0;
+        double dfFirstFeatureTime = 0;
+        while (auto poFeature =
+                   std::unique_ptr<OGRFeature>(poLayer->GetNextFeature()))
+        {
+            if (nFeatures == 0)
+            {
+                dfFirstFeatureTime =
+                    duration<double>(steady_clock::now() - tStart).count();
+            }
+            ++nFeatures;
+        }
+        const double dfTotalTime =
+            duration<double>(steady_clock::now() - tStart).count();
+        poLayer->ResetReading();
+
+        if (bJson)
+        {
+            CPLJSONObject oPlan;
+            for (const char *pszItem : aosPlan)
+            {
+                char *pszKey = nullptr;
+                const char *pszValue = CPLParseNameValue(pszItem, &pszKey);
+                if (pszKey && pszValue)
+                    oPlan.Add(pszKey, pszValue);
+                CPLFree(pszKey);
+            }
+            oLayer.Add("queryPlan", oPlan);
+
+            CPLJSONObject oExecution;
+            oExecution.Add("featureCount", nFeatures);
+            oExecution.Add("firstFeatureTime", dfFirstFeatureTime);
+            oExecution.Add("totalTime", dfTotalTime);
+            oLayer.Add("queryExecution", oExecution);
+        }
+        else
+        {
+            Concat(osRet, psOptions->bStdoutOutput, "Query plan:\n");
+            for (const char *pszItem : aosPlan)
+            {
+                char *pszKey = nullptr;
+                const char *pszValue = CPLParseNameValue(pszItem, &pszKey);
+                if (pszKey && pszValue)
+                {
+                    Concat(osRet, psOptions->bStdoutOutput, "  %s: %s\n",
+                           pszKey, pszValue);
+                }
+                CPLFree(pszKey);
+            }
+            Concat(osRet, psOptions->bStdoutOutput,
+                   "Query execution: " CPL_FRMT_GIB " features read in "
+                   "%.3f s (first feature after %.3f s)\n",
+                   nFeatures, dfTotalTime, dfFirstFeatureTime);
+        }
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Read, and dump features.                                        */
     /* -------------------------------------------------------------------- */
@@ -2301,6 +2369,10 @@ GDALVectorInfoOptionsNew(char **papszArgv,
         {
             psOptions->bDatasetGetNextFeature = true;
         }
+        else if (EQUAL(papszArgv[iArg], "-explain"))
+        {
+            psOptions->bExplain = true;
+        }
         else if (EQUAL(papszArgv[iArg], "-wkt_format") &&
                  papszArgv[iArg + 1] != nullptr)
         {
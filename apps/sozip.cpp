@@ -618,9 +618,6 @@ MAIN_START(nArgc, papszArgv)
         }
     }
 
-    uint64_t nTotalSize = 0;
-    std::vector<uint64_t> anFileSizes;
-
     std::string osRemovePrefix;
     if (pszOptimizeFrom)
     {
@@ -678,53 +675,14 @@ MAIN_START(nArgc, papszArgv)
         aosFiles = std::move(aosNewFiles);
     }
 
-    if (!bVerbose && !bQuiet)
-    {
-        anFileSizes.resize(aosFiles.size());
-        for (int i = 0; i < aosFiles.size(); ++i)
-        {
-            if (VSIStatL(aosFiles[i], &sBuf) == 0)
-            {
-                anFileSizes[i] = sBuf.st_size;
-                nTotalSize += sBuf.st_size;
-            }
-            else
-            {
-                CPLError(CE_Failure, CPLE_AppDefined, "Cannot find %s\n",
-                         aosFiles[i]);
-                return 1;
-            }
-        }
-    }
-
-    void *hZIP = CPLCreateZip(pszZipFilename, aosOptionsCreateZip.List());
-
-    if (!hZIP)
-        return 1;
-
-    uint64_t nCurSize = 0;
+    // Check the input files and compute their names in the archive
+    CPLStringList aosArchiveFilenames;
     for (int i = 0; i < aosFiles.size(); ++i)
     {
-        if (bVerbose)
-            printf("Adding %s... (%d/%d)\n", aosFiles[i], i + 1,
-                   aosFiles.size());
-        void *pScaledProgress = nullptr;
-        if (!bVerbose && !bQuiet && nTotalSize != 0)
-        {
-            pScaledProgress = GDALCreateScaledProgress(
-                double(nCurSize) / nTotalSize,
-                double(nCurSize + anFileSizes[i]) / nTotalSize,
-                GDALTermProgress, nullptr);
-        }
-        else if (!bQuiet)
-        {
-            GDALTermProgress(0, nullptr, nullptr);
-        }
         if (VSIStatL(aosFiles[i], &sBuf) != 0 || VSI_ISDIR(sBuf.st_mode))
         {
             CPLError(CE_Failure, CPLE_AppDefined, "%s is not a regular file",
                      aosFiles[i]);
-            CPLCloseZip(hZIP);
             return 1;
         }
 
@@ -747,27 +705,49 @@ MAIN_START(nArgc, papszArgv)
         {
             osArchiveFilename = osArchiveFilename.substr(3);
         }
+        aosArchiveFilenames.AddString(osArchiveFilename.c_str());
+    }
 
-        CPLErr eErr =
-            CPLAddFileInZip(hZIP, osArchiveFilename.c_str(), aosFiles[i],
-                            nullptr, aosOptions.List(),
-                            pScaledProgress ? GDALScaledProgress
-                            : bQuiet        ? nullptr
-                                            : GDALTermProgress,
-                            pScaledProgress ? pScaledProgress : nullptr);
-        if (pScaledProgress)
-        {
-            GDALDestroyScaledProgress(pScaledProgress);
-            nCurSize += anFileSizes[i];
-        }
-        if (eErr != CE_None)
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszNumThreads)
+        aosOptions.SetNameValue("NUM_THREADS", pszNumThreads);
+
+    void *hZIP = CPLCreateZip(pszZipFilename, aosOptionsCreateZip.List());
+
+    if (!hZIP)
+        return 1;
+
+    if (bVerbose)
+    {
+        for (int i = 0; i < aosFiles.size(); ++i)
         {
-            CPLError(CE_Failure, CPLE_AppDefined, "Failed adding %s",
-                     aosFiles[i]);
-            CPLCloseZip(hZIP);
-            return 1;
+            printf("Adding %s... (%d/%d)\n", aosFiles[i], i + 1,
+                   aosFiles.size());
+            if (!bQuiet)
+                GDALTermProgress(0, nullptr, nullptr);
+            if (CPLAddFileInZip(hZIP, aosArchiveFilenames[i], aosFiles[i],
+                                nullptr, aosOptions.List(),
+                                bQuiet ? nullptr : GDALTermProgress,
+                                nullptr) != CE_None)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined, "Failed adding %s",
+                         aosFiles[i]);
+                CPLCloseZip(hZIP);
+                return 1;
+            }
         }
     }
+    // Small files are read and compressed concurrently
+    else if (CPLAddFilesInZip(hZIP, aosFiles.size(), aosArchiveFilenames.List(),
+                              aosFiles.List(), aosOptions.List(),
+                              bQuiet ? nullptr : GDALTermProgress,
+                              nullptr) != CE_None)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Failed adding files to %s",
+                 pszZipFilename);
+        CPLCloseZip(hZIP);
+        return 1;
+    }
     CPLCloseZip(hZIP);
     return 0;
 }
@@ -69,6 +69,13 @@ def test_applyverticalshiftgrid_1():
     cs = out_ds.GetRasterBand(1).Checksum()
     assert cs == 10038
 
+    # Multi-threaded reprojection of the grid
+    out_ds = gdal.ApplyVerticalShiftGrid(
+        src_ds, src_ds, options=["BLOCKSIZE=15", "NUM_THREADS=2"]
+    )
+    cs = out_ds.GetRasterBand(1).Checksum()
+    assert cs == 10038
+
     # Inverse transformer
     out_ds = gdal.ApplyVerticalShiftGrid(
         src_ds, src_ds, True, options=["DATATYPE=Float32"]
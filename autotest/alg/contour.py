@@ -28,6 +28,7 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import math
 import struct
 
 import gdaltest
@@ -400,3 +401,73 @@ def test_contour_raster_acquisition_error():
         gdal.ContourGenerateEx(
             ds.GetRasterBand(1), ogr_lyr, options=["LEVEL_INTERVAL=1", "ID_FIELD=0"]
         )
+
+
+###############################################################################
+# Check that processing by stripes in worker threads gives the same lines
+
+
+def _contour_lines(ds, options):
+
+    ogr_ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    ogr_lyr = ogr_ds.CreateLayer("contour", geom_type=ogr.wkbLineString)
+    ogr_lyr.CreateField(ogr.FieldDefn("ID", ogr.OFTInteger))
+    ogr_lyr.CreateField(ogr.FieldDefn("ELEV", ogr.OFTReal))
+    gdal.ContourGenerateEx(
+        ds.GetRasterBand(1), ogr_lyr, options=options + ["ID_FIELD=0", "ELEV_FIELD=1"]
+    )
+    # Start point and direction of lines may differ
+    return sorted(
+        (
+            f["ELEV"],
+            f.GetGeometryRef().GetPointCount(),
+            round(f.GetGeometryRef().Length(), 6),
+        )
+        for f in ogr_lyr
+    )
+
+
+@pytest.mark.parametrize("nodata", [False, True])
+@pytest.mark.parametrize("stripe_height", [1, 7])
+def test_contour_multithreaded(nodata, stripe_height):
+
+    xsize = 101
+    ysize = 90
+    values = []
+    for y in range(ysize):
+        for x in range(xsize):
+            v = 10 * math.sin(x * 0.13 + 1) * math.cos(y * 0.11)
+            if nodata and (x * 7 + y * 13) % 17 == 0:
+                v = -9999
+            values.append(v)
+    ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize, 1, gdal.GDT_Float64)
+    ds.GetRasterBand(1).WriteRaster(
+        0, 0, xsize, ysize, struct.pack("d" * len(values), *values)
+    )
+    options = ["LEVEL_INTERVAL=1.5"]
+    if nodata:
+        options.append("NODATA=-9999")
+
+    expected = _contour_lines(ds, options)
+    assert expected
+
+    with gdaltest.config_option("GDAL_CONTOUR_STRIPE_HEIGHT", str(stripe_height)):
+        got = _contour_lines(ds, options + ["NUM_THREADS=4"])
+    assert got == expected
+
+
+def test_contour_multithreaded_raster_acquisition_error():
+
+    ogr_ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    ogr_lyr = ogr_ds.CreateLayer("contour", geom_type=ogr.wkbLineString)
+    field_defn = ogr.FieldDefn("ID", ogr.OFTInteger)
+    ogr_lyr.CreateField(field_defn)
+    ds = gdal.Open("../gcore/data/byte_truncated.tif")
+
+    with gdaltest.config_option("GDAL_CONTOUR_STRIPE_HEIGHT", "2"):
+        with pytest.raises(Exception):
+            gdal.ContourGenerateEx(
+                ds.GetRasterBand(1),
+                ogr_lyr,
+                options=["LEVEL_INTERVAL=1", "ID_FIELD=0", "NUM_THREADS=2"],
+            )
@@ -30,6 +30,7 @@
 
 import struct
 
+import gdaltest
 import pytest
 
 from osgeo import gdal
@@ -256,3 +257,84 @@ def test_fillnodata_user_provided_mask_with_smoothing():
     )
     got = [x for x in struct.unpack("f" * (5 * 5), targetBand.ReadRaster())]
     assert got == pytest.approx(expected, 1e-5)
+
+
+def _fill_push_pull(width, height, input_ar, max_dist, options=[]):
+
+    ds = gdal.GetDriverByName("MEM").Create("", width, height, 1, gdal.GDT_Float32)
+    targetBand = ds.GetRasterBand(1)
+    targetBand.SetNoDataValue(0)
+    targetBand.WriteRaster(
+        0, 0, width, height, struct.pack("f" * (width * height), *input_ar)
+    )
+    assert (
+        gdal.FillNodata(
+            targetBand=targetBand,
+            maskBand=None,
+            maxSearchDist=max_dist,
+            smoothingIterations=0,
+            options=["INTERPOLATION=PUSH_PULL"] + options,
+        )
+        == 0
+    )
+    return struct.unpack("f" * (width * height), targetBand.ReadRaster())
+
+
+@pytest.mark.parametrize(
+    "tile_size,num_threads", [(None, "1"), ("16", "1"), ("16", "4"), ("1", "2")]
+)
+def test_fillnodata_push_pull(tile_size, num_threads):
+
+    width = 70
+    height = 50
+    input_ar = []
+    for j in range(height):
+        for i in range(width):
+            hole = (10 <= i < 40 and 5 <= j < 30) or (i + j) % 7 == 0
+            input_ar.append(0 if hole else 1 + i + 2 * j)
+
+    with gdaltest.config_option("GDAL_FILLNODATA_TILE_SIZE", tile_size):
+        got = _fill_push_pull(
+            width, height, input_ar, 20, ["NUM_THREADS=" + num_threads]
+        )
+
+    for j in range(height):
+        for i in range(width):
+            if input_ar[j * width + i]:
+                assert got[j * width + i] == input_ar[j * width + i]
+            else:
+                # Filled with a value in the range of its neighbourhood.
+                assert 1 <= got[j * width + i] <= 1 + width + 2 * height
+
+    # Results do not depend on the tiling and number of threads
+    if tile_size is not None:
+        assert got == _fill_push_pull(width, height, input_ar, 20)
+
+
+def test_fillnodata_push_pull_max_search_dist():
+
+    width = 21
+    height = 21
+    input_ar = [0] * (width * height)
+    input_ar[10 * width + 10] = 5
+    got = _fill_push_pull(width, height, input_ar, 6)
+    for j in range(height):
+        for i in range(width):
+            dist = ((i - 10) ** 2 + (j - 10) ** 2) ** 0.5
+            if dist > 6:
+                assert got[j * width + i] == 0
+            elif dist <= 5.5:
+                assert got[j * width + i] == pytest.approx(5)
+
+
+def test_fillnodata_invalid_interpolation():
+
+    ds = gdal.GetDriverByName("MEM").Create("", 1, 1)
+    with pytest.raises(Exception, match="Unsupported value for INTERPOLATION"):
+        gdal.FillNodata(
+            targetBand=ds.GetRasterBand(1),
+            maskBand=None,
+            maxSearchDist=1,
+            smoothingIterations=0,
+            options=["INTERPOLATION=INVALID"],
+        )
@@ -33,6 +33,7 @@
 import struct
 from collections import defaultdict
 
+import gdaltest
 import ogrtest
 import pytest
 
@@ -448,3 +449,56 @@ def test_polygonize_8():
         wkt
         == "POLYGON ((1 4,1 3,0 3,0 1,1 1,1 0,3 0,3 1,4 1,4 3,3 3,3 4,1 4),(1 3,3 3,3 1,1 1,1 3))"
     )
+
+
+###############################################################################
+# Test that multi-threaded polygonization, which processes the raster by
+# stripes, gives the same polygons as the single-threaded code path.
+
+
+@pytest.mark.parametrize("options", [[], ["8CONNECTED=8"]])
+@pytest.mark.parametrize("is_int_polygonize", [True, False])
+def test_polygonize_num_threads(options, is_int_polygonize):
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 40, 100)
+    src_ds.SetGeoTransform([10, 1, 0, 20, 0, -1])
+    data = bytearray(40 * 100)
+    for j in range(100):
+        for i in range(40):
+            data[j * 40 + i] = ((i // 3) * (j // 4) + (i * 7 + j * 13) % 5) % 3
+    src_ds.GetRasterBand(1).WriteRaster(0, 0, 40, 100, bytes(data))
+    src_band = src_ds.GetRasterBand(1)
+
+    polygonize = gdal.Polygonize if is_int_polygonize else gdal.FPolygonize
+
+    def get_polygons(num_threads):
+        mem_ds = ogr.GetDriverByName("Memory").CreateDataSource("out")
+        mem_layer = mem_ds.CreateLayer("poly", None, ogr.wkbPolygon)
+        mem_layer.CreateField(ogr.FieldDefn("DN", ogr.OFTInteger))
+        with gdaltest.config_option("GDAL_POLYGONIZE_STRIPE_HEIGHT", "7"):
+            assert (
+                polygonize(
+                    src_band,
+                    None,
+                    mem_layer,
+                    0,
+                    options + ["NUM_THREADS=" + num_threads],
+                )
+                == 0
+            )
+        ret = []
+        for f in mem_layer:
+            geom = f.GetGeometryRef()
+            ret.append(
+                (
+                    f["DN"],
+                    geom.GetEnvelope(),
+                    geom.GetArea(),
+                    geom.GetGeometryCount(),
+                )
+            )
+        return sorted(ret)
+
+    ref = get_polygons("1")
+    assert len(ref) > 100
+    assert get_polygons("4") == ref
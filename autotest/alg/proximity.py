@@ -29,6 +29,9 @@
 ###############################################################################
 
 
+import struct
+
+import gdaltest
 import pytest
 
 from osgeo import gdal
@@ -126,3 +129,65 @@ def test_proximity_3():
     if cs != cs_expected:
         print("Got: ", cs)
         pytest.fail("got wrong checksum")
+
+
+###############################################################################
+# Test ALGORITHM=EXACT against a brute force computation
+
+
+@pytest.mark.parametrize("num_threads", [1, 3])
+@pytest.mark.parametrize("block_height", [None, "4"])
+def test_proximity_exact(num_threads, block_height):
+
+    xsize = 23
+    ysize = 17
+    targets = [(3, 2), (19, 4), (10, 9), (0, 16), (22, 15), (12, 13)]
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize)
+    src_band = src_ds.GetRasterBand(1)
+    for x, y in targets:
+        src_band.WriteRaster(x, y, 1, 1, b"\x01")
+
+    dst_ds = gdal.GetDriverByName("MEM").Create(
+        "", xsize, ysize, 1, gdal.GDT_Float32
+    )
+    dst_band = dst_ds.GetRasterBand(1)
+
+    with gdaltest.config_option("GDAL_PROXIMITY_BLOCK_HEIGHT", block_height):
+        assert (
+            gdal.ComputeProximity(
+                src_band,
+                dst_band,
+                options=[
+                    "ALGORITHM=EXACT",
+                    "NUM_THREADS=%d" % num_threads,
+                    "MAXDIST=6",
+                    "NODATA=-1",
+                ],
+            )
+            == 0
+        )
+
+    got = struct.unpack("f" * (xsize * ysize), dst_band.ReadRaster())
+    for y in range(ysize):
+        for x in range(xsize):
+            dist = min(((x - tx) ** 2 + (y - ty) ** 2) ** 0.5 for tx, ty in targets)
+            expected = dist if dist <= 6 else -1
+            assert got[y * xsize + x] == pytest.approx(expected, abs=1e-5), (x, y)
+
+
+###############################################################################
+# Test an invalid ALGORITHM value
+
+
+def test_proximity_invalid_algorithm():
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 2, 2)
+    dst_ds = gdal.GetDriverByName("MEM").Create("", 2, 2, 1, gdal.GDT_Float32)
+
+    with pytest.raises(Exception, match="Unrecognized ALGORITHM value"):
+        gdal.ComputeProximity(
+            src_ds.GetRasterBand(1),
+            dst_ds.GetRasterBand(1),
+            options=["ALGORITHM=FOO"],
+        )
@@ -30,6 +30,7 @@
 
 import struct
 
+import gdaltest
 import ogrtest
 import pytest
 
@@ -1011,3 +1012,104 @@ def test_rasterize_bugfix_gh8918(wkt):
     )
 
     assert target_ds.GetRasterBand(1).Checksum() == 36
+
+
+###############################################################################
+# Test that rasterizing by stripes in several threads, with a spatial index
+# of the geometries by chunk, gives the same result as a single thread.
+
+
+@pytest.mark.parametrize("options", [[], ["-at"], ["-add"]])
+def test_rasterize_num_threads(options):
+
+    vect_ds = gdal.GetDriverByName("Memory").Create("", 0, 0, 0, gdal.GDT_Unknown)
+    lyr = vect_ds.CreateLayer("test")
+    lyr.CreateField(ogr.FieldDefn("val", ogr.OFTReal))
+    for i in range(50):
+        x = (i * 37) % 90
+        y = (i * 53) % 190
+        for wkt in [
+            f"POLYGON(({x} {y},{x + 10.5} {y + 3},{x + 7} {y + 12.3},{x} {y}))",
+            f"LINESTRING({x} {y + 5},{x + 9.2} {y - 4})",
+            f"POINT({x + 0.5} {y + 0.5})",
+        ]:
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f["val"] = i
+            f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+            lyr.CreateFeature(f)
+
+    def rasterize(num_threads):
+        target_ds = gdal.GetDriverByName("MEM").Create("", 100, 200)
+        target_ds.SetGeoTransform([0, 1, 0, 0, 0, 1])
+        with gdaltest.config_option("GDAL_NUM_THREADS", num_threads):
+            assert gdal.Rasterize(
+                target_ds,
+                vect_ds,
+                options=options
+                + ["-a", "val", "-optim", "raster", "-chunkysize", "30"],
+            )
+        return target_ds.GetRasterBand(1).ReadRaster()
+
+    assert rasterize("4") == rasterize("1")
+
+
+###############################################################################
+# Test COVERAGE_FRACTION=YES
+
+
+@pytest.mark.parametrize("merge_alg", ["REPLACE", "ADD"])
+def test_rasterize_coverage_fraction(merge_alg):
+
+    target_ds = gdal.GetDriverByName("MEM").Create("", 5, 5, 1, gdal.GDT_Float64)
+    target_ds.SetGeoTransform([0, 1, 0, 5, 0, -1])
+    target_ds.GetRasterBand(1).Fill(1)
+
+    vect_ds = gdal.GetDriverByName("Memory").Create("", 0, 0, 0, gdal.GDT_Unknown)
+    lyr = vect_ds.CreateLayer("test")
+    f = ogr.Feature(lyr.GetLayerDefn())
+    # Square from (0.5, 0.5) to (4.5, 4.5) with a hole from (2,2) to (3,3),
+    # and a triangle covering the upper-left half of the top-left pixel.
+    f.SetGeometry(
+        ogr.CreateGeometryFromWkt(
+            "MULTIPOLYGON(((0.5 0.5,4.5 0.5,4.5 4.5,0.5 4.5,0.5 0.5),"
+            "(2 2,2 3,3 3,3 2,2 2)),((0 5,1 5,0 4,0 5)))"
+        )
+    )
+    lyr.CreateFeature(f)
+
+    assert (
+        gdal.RasterizeLayer(
+            target_ds,
+            [1],
+            lyr,
+            burn_values=[10],
+            options=["COVERAGE_FRACTION=YES", "MERGE_ALG=" + merge_alg],
+        )
+        == gdal.CE_None
+    )
+
+    got = struct.unpack("d" * 25, target_ds.GetRasterBand(1).ReadRaster())
+    coverage = [
+        [0.75, 0.5, 0.5, 0.5, 0.25],
+        [0.5, 1, 1, 1, 0.5],
+        [0.5, 1, 0, 1, 0.5],
+        [0.5, 1, 1, 1, 0.5],
+        [0.25, 0.5, 0.5, 0.5, 0.25],
+    ]
+    expected = []
+    for row in coverage:
+        for c in row:
+            if merge_alg == "ADD":
+                expected.append(1 + 10 * c)
+            else:
+                expected.append(10 * c if c > 0 else 1)
+    assert got == pytest.approx(expected, abs=1e-12)
+
+    with pytest.raises(Exception, match="not compatible"):
+        gdal.RasterizeLayer(
+            target_ds,
+            [1],
+            lyr,
+            burn_values=[10],
+            options=["COVERAGE_FRACTION=YES", "ALL_TOUCHED=YES"],
+        )
@@ -30,6 +30,7 @@
 ###############################################################################
 
 
+import gdaltest
 import pytest
 
 from osgeo import gdal
@@ -328,3 +329,51 @@ cellsize     60.000000000000
     if cs != cs_expected:
         print("Got: ", cs)
         pytest.fail("got wrong checksum")
+
+
+###############################################################################
+# Test that results do not depend on the stripe height and number of threads
+
+
+@pytest.mark.parametrize("connectedness", [4, 8])
+@pytest.mark.parametrize(
+    "stripe_height,num_threads", [("1", "1"), ("7", "4"), (None, "ALL_CPUS")]
+)
+def test_sieve_tiled(connectedness, stripe_height, num_threads):
+
+    width = 300
+    height = 200
+    src_ds = gdal.GetDriverByName("MEM").Create("", width, height)
+    src_band = src_ds.GetRasterBand(1)
+    src_band.SetNoDataValue(0)
+    # Pseudo-random blobs of 4 values, with some nodata
+    values = bytearray(width * height)
+    seed = 1
+    for i in range(width * height):
+        seed = (seed * 1103515245 + 12345) % (1 << 31)
+        r = seed >> 16
+        if i % width != 0 and r % 3 != 0:
+            values[i] = values[i - 1]
+        elif i >= width and r % 2 == 0:
+            values[i] = values[i - width]
+        else:
+            values[i] = r % 5
+    src_band.WriteRaster(0, 0, width, height, bytes(values))
+
+    def sieve(options):
+        dst_ds = gdal.GetDriverByName("MEM").Create("", width, height)
+        gdal.SieveFilter(
+            src_band,
+            src_band.GetMaskBand(),
+            dst_ds.GetRasterBand(1),
+            10,
+            connectedness,
+            options=options,
+        )
+        return dst_ds.GetRasterBand(1).ReadRaster()
+
+    expected = sieve([])
+    assert expected != bytes(values)
+
+    with gdaltest.config_option("GDAL_SIEVE_STRIPE_HEIGHT", stripe_height):
+        assert sieve(["NUM_THREADS=" + num_threads]) == expected
@@ -1564,6 +1564,63 @@ def test_warp_nearest_real_nodata_multiple_band():
     )
 
 
+###############################################################################
+# Test the per-working-data-type instantiations of the warp kernel path used
+# with a source nodata value, against a Float64 working data type
+
+
+@pytest.mark.parametrize(
+    "dt",
+    [
+        gdal.GDT_Byte,
+        gdal.GDT_Int8,
+        gdal.GDT_UInt16,
+        gdal.GDT_Int16,
+        gdal.GDT_UInt32,
+        gdal.GDT_Int32,
+        gdal.GDT_UInt64,
+        gdal.GDT_Int64,
+        gdal.GDT_Float32,
+        gdal.GDT_Float64,
+    ],
+)
+@pytest.mark.parametrize("resample_alg", ["near", "bilinear", "cubic", "lanczos"])
+def test_warp_real_case_working_data_types(dt, resample_alg):
+
+    numpy = pytest.importorskip("numpy")
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 20, 20, 1, dt)
+    src_ds.SetGeoTransform([0, 1, 0, 0, 0, -1])
+    ar = (numpy.arange(400).reshape(20, 20) * 7) % 50 + 20
+    ar[5, 5] = 0
+    ar[12, 3:6] = 0
+    src_ds.GetRasterBand(1).WriteArray(ar)
+    src_ds.GetRasterBand(1).SetNoDataValue(0)
+
+    def warp(output_type, working_type):
+        return gdal.Warp(
+            "",
+            src_ds,
+            format="MEM",
+            width=30,
+            height=30,
+            resampleAlg=resample_alg,
+            dstNodata=0,
+            outputType=output_type,
+            workingType=working_type,
+        )
+
+    out = warp(dt, dt).GetRasterBand(1).ReadAsArray().astype(numpy.float64)
+    ref = warp(gdal.GDT_Float64, gdal.GDT_Float64).GetRasterBand(1).ReadAsArray()
+    assert numpy.array_equal(out == 0, ref == 0)
+    if dt == gdal.GDT_Float64:
+        assert numpy.array_equal(out, ref)
+    elif dt == gdal.GDT_Float32:
+        assert numpy.array_equal(out, ref.astype(numpy.float32))
+    else:
+        assert numpy.max(numpy.abs(out - ref)) <= 0.5
+
+
 ###############################################################################
 # Test bugfix for #2365
 
@@ -1740,3 +1797,207 @@ def test_non_square():
         assert res.ymax == pytest.approx(30.25)
         assert res.xmin == pytest.approx(9.9)
         assert res.xmax == pytest.approx(10.5)
+
+
+###############################################################################
+# Test that the separable (two-pass) resampling used for affine transforms
+# without rotation gives the same results as the general 2D kernel
+
+
+@pytest.mark.parametrize(
+    "dt", [gdal.GDT_Byte, gdal.GDT_Int16, gdal.GDT_Int32, gdal.GDT_Float64]
+)
+@pytest.mark.parametrize("alg", ["bilinear", "cubic", "cubicspline", "lanczos"])
+@pytest.mark.parametrize("outsize", [(37, 23), (80, 80), (130, 110)])
+def test_warp_separable_resampling(dt, alg, outsize):
+
+    numpy = pytest.importorskip("numpy")
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 100, 100, 2, dt)
+    src_ds.SetGeoTransform([0, 1, 0, 0, 0, -1])
+    ar = (numpy.arange(100 * 100).reshape(100, 100) * 37) % 251
+    if dt != gdal.GDT_Byte:
+        ar = ar - 50
+    src_ds.GetRasterBand(1).WriteArray(ar)
+    src_ds.GetRasterBand(2).WriteArray(ar.transpose())
+
+    def warp():
+        return gdal.Warp(
+            "",
+            src_ds,
+            format="MEM",
+            width=outsize[0],
+            height=outsize[1],
+            resampleAlg=alg,
+        )
+
+    with gdaltest.config_option("GDAL_WARP_USE_AFFINE_OPTIMIZATION", "NO"):
+        ref_ds = warp()
+    out_ds = warp()
+
+    for i in range(2):
+        expected = ref_ds.GetRasterBand(i + 1).ReadAsArray().astype(numpy.float64)
+        got = out_ds.GetRasterBand(i + 1).ReadAsArray().astype(numpy.float64)
+        if dt == gdal.GDT_Float64:
+            assert got == pytest.approx(expected, rel=1e-10, abs=1e-10)
+        else:
+            # Differences in rounding might in theory change the result by 1
+            assert numpy.max(numpy.abs(got - expected)) <= 1
+
+
+###############################################################################
+# Test GDAL_APPROX_TRANSFORMER_GRID_STEP
+
+
+@pytest.mark.parametrize("grid_step", ["4", "64", "1000"])
+def test_warp_approx_transformer_grid(grid_step):
+
+    numpy = pytest.importorskip("numpy")
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 200, 200)
+    src_ds.SetGeoTransform([2, 0.01, 0, 49, 0, -0.01])
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(4326)
+    src_ds.SetSpatialRef(srs)
+    ar = (numpy.arange(200 * 200).reshape(200, 200) * 37) % 251
+    src_ds.GetRasterBand(1).WriteArray(ar)
+
+    def warp():
+        return gdal.Warp(
+            "",
+            src_ds,
+            format="MEM",
+            dstSRS="EPSG:32631",
+            resampleAlg="near",
+            errorThreshold=0.125,
+            warpOptions=["NUM_THREADS=4"],
+            warpMemoryLimit=10000,
+        )
+
+    ref_ds = warp()
+    with gdaltest.config_option("GDAL_APPROX_TRANSFORMER_GRID_STEP", grid_step):
+        out_ds = warp()
+
+    assert out_ds.RasterXSize == ref_ds.RasterXSize
+    assert out_ds.RasterYSize == ref_ds.RasterYSize
+    expected = ref_ds.GetRasterBand(1).ReadAsArray()
+    got = out_ds.GetRasterBand(1).ReadAsArray()
+    # Both approximations are within 0.125 pixel of the exact transformation,
+    # so only a small fraction of nearest neighbour pixels may differ.
+    assert numpy.count_nonzero(got != expected) < expected.size / 50
+
+
+###############################################################################
+# Test the NUM_CHUNK_WORKERS warping option
+
+
+@pytest.mark.parametrize("num_threads", [None, "2"])
+@pytest.mark.parametrize("init_dest", [True, False])
+def test_warp_num_chunk_workers(num_threads, init_dest):
+
+    numpy = pytest.importorskip("numpy")
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 500, 500, 2)
+    src_ds.SetGeoTransform([2, 0.01, 0, 49, 0, -0.01])
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(4326)
+    src_ds.SetSpatialRef(srs)
+    ar = (numpy.arange(500 * 500).reshape(500, 500) * 37) % 251
+    src_ds.GetRasterBand(1).WriteArray(ar)
+    src_ds.GetRasterBand(2).WriteArray(ar.transpose())
+
+    def warp(num_chunk_workers):
+        options = []
+        if num_threads:
+            options.append("NUM_THREADS=" + num_threads)
+        if num_chunk_workers:
+            options.append("NUM_CHUNK_WORKERS=" + num_chunk_workers)
+        if init_dest:
+            options.append("INIT_DEST=0")
+        tab = [0]
+
+        def callback(pct, msg, user_data):
+            assert pct >= tab[0]
+            tab[0] = pct
+            return 1
+
+        out_ds = gdal.Warp(
+            "",
+            src_ds,
+            format="MEM",
+            dstSRS="EPSG:32631",
+            resampleAlg="bilinear",
+            # Exact transformer, since chunks depend on the number of workers
+            errorThreshold=0,
+            multithread=True,
+            warpOptions=options,
+            warpMemoryLimit=1000000,
+            callback=callback,
+        )
+        assert tab[0] == 1.0
+        return out_ds
+
+    ref_ds = warp(None)
+    out_ds = warp("4")
+    for i in range(2):
+        assert (
+            out_ds.GetRasterBand(i + 1).Checksum()
+            == ref_ds.GetRasterBand(i + 1).Checksum()
+        )
+
+
+###############################################################################
+# Test that source windows without data, according to the data coverage
+# status, are not read
+
+
+@pytest.mark.parametrize("skip_nosource", [True, False])
+@pytest.mark.parametrize("use_alpha", [True, False])
+def test_warp_src_data_coverage(tmp_vsimem, skip_nosource, use_alpha):
+
+    src_filename = str(tmp_vsimem / "src.tif")
+    src_ds = gdal.GetDriverByName("GTiff").Create(
+        src_filename,
+        1024,
+        1024,
+        2 if use_alpha else 1,
+        options=["TILED=YES", "SPARSE_OK=YES"],
+    )
+    src_ds.SetGeoTransform([0, 1, 0, 0, 0, -1])
+    if use_alpha:
+        src_ds.GetRasterBand(2).SetColorInterpretation(gdal.GCI_AlphaBand)
+        src_ds.GetRasterBand(2).WriteRaster(
+            512, 512, 256, 256, b"\xff" * (256 * 256)
+        )
+    else:
+        src_ds.GetRasterBand(1).SetNoDataValue(0)
+    src_ds.GetRasterBand(1).WriteRaster(512, 512, 256, 256, b"\x01" * (256 * 256))
+    src_ds = None
+
+    src_ds = gdal.Open(src_filename)
+
+    def warp(use_src_data_coverage):
+        options = ["USE_SRC_DATA_COVERAGE=" + use_src_data_coverage]
+        if skip_nosource:
+            options.append("SKIP_NOSOURCE=YES")
+        else:
+            options.append("INIT_DEST=0")
+        return gdal.Warp(
+            "",
+            src_ds,
+            format="MEM",
+            outputBounds=[0, -1024, 1024, 0],
+            width=512,
+            height=512,
+            warpOptions=options,
+            warpMemoryLimit=100000,
+        )
+
+    ref_ds = warp("NO")
+    out_ds = warp("YES")
+    for i in range(src_ds.RasterCount):
+        assert (
+            out_ds.GetRasterBand(i + 1).Checksum()
+            == ref_ds.GetRasterBand(i + 1).Checksum()
+        )
+    assert out_ds.GetRasterBand(1).Checksum() != 0
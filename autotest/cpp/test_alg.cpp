@@ -37,6 +37,9 @@
 
 #include "gtest_include.h"
 
+#include <cmath>
+#include <vector>
+
 namespace
 {
 // Common fixture with test data
@@ -273,4 +276,70 @@ TEST_F(test_alg, GDALAutoCreateWarpedVRT_alpha_band)
     GDALClose(hWarpedVRT);
 }
 
+// Test GDALViewshedGenerateCumulative() against GDALViewshedGenerate()
+TEST_F(test_alg, GDALViewshedGenerateCumulative)
+{
+    constexpr int nSize = 40;
+    GDALDatasetUniquePtr poDS(GDALDriver::FromHandle(GDALGetDriverByName("MEM"))
+                                  ->Create("", nSize, nSize, 1, GDT_Float32,
+                                           nullptr));
+    double adfGeoTransform[6] = {0, 10, 0, 400, 0, -10};
+    poDS->SetGeoTransform(adfGeoTransform);
+    std::vector<float> afDEM(nSize * nSize);
+    for (int iY = 0; iY < nSize; iY++)
+    {
+        for (int iX = 0; iX < nSize; iX++)
+            afDEM[iY * nSize + iX] = static_cast<float>(
+                100 + 20 * std::sin(iX / 3.0) * std::cos(iY / 5.0));
+    }
+    ASSERT_EQ(poDS->GetRasterBand(1)->RasterIO(
+                  GF_Write, 0, 0, nSize, nSize, afDEM.data(), nSize, nSize,
+                  GDT_Float32, 0, 0, nullptr),
+              CE_None);
+    GDALRasterBandH hBand = GDALRasterBand::ToHandle(poDS->GetRasterBand(1));
+
+    const double adfX[] = {55, 205, 355, 125};
+    const double adfY[] = {345, 195, 45, 75};
+    const double adfZ[] = {10, 5, 20, 2};
+    constexpr int nObservers = 4;
+
+    for (const char *pszNumThreads : {"1", "3"})
+    {
+        const char *const apszOptions[] = {
+            CPLSPrintf("NUM_THREADS=%s", pszNumThreads), nullptr};
+
+        std::vector<GUInt32> anExpected(nSize * nSize);
+        for (int i = 0; i < nObservers; i++)
+        {
+            GDALDatasetH hViewshed = GDALViewshedGenerate(
+                hBand, "MEM", "", nullptr, adfX[i], adfY[i], adfZ[i], 0, 1, 0,
+                0, -1, 0, GVM_Edge, 0, nullptr, nullptr, GVOT_NORMAL,
+                apszOptions);
+            ASSERT_TRUE(hViewshed != nullptr);
+            std::vector<GUInt32> anViewshed(nSize * nSize);
+            ASSERT_EQ(GDALRasterIO(GDALGetRasterBand(hViewshed, 1), GF_Read, 0,
+                                   0, nSize, nSize, anViewshed.data(), nSize,
+                                   nSize, GDT_UInt32, 0, 0),
+                      CE_None);
+            GDALClose(hViewshed);
+            for (int j = 0; j < nSize * nSize; j++)
+                anExpected[j] += anViewshed[j];
+        }
+
+        GDALDatasetH hCumulative = GDALViewshedGenerateCumulative(
+            hBand, "MEM", "", nullptr, nObservers, adfX, adfY, adfZ, 0, 0,
+            GVM_Edge, 0, nullptr, nullptr, apszOptions);
+        ASSERT_TRUE(hCumulative != nullptr);
+        EXPECT_EQ(GDALGetRasterDataType(GDALGetRasterBand(hCumulative, 1)),
+                  GDT_UInt32);
+        std::vector<GUInt32> anGot(nSize * nSize);
+        ASSERT_EQ(GDALRasterIO(GDALGetRasterBand(hCumulative, 1), GF_Read, 0,
+                               0, nSize, nSize, anGot.data(), nSize, nSize,
+                               GDT_UInt32, 0, 0),
+                  CE_None);
+        GDALClose(hCumulative);
+        EXPECT_EQ(anGot, anExpected);
+    }
+}
+
 }  // namespace
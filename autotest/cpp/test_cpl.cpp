@@ -36,6 +36,7 @@
 #include "gdal_unit_test.h"
 
 #include "cpl_compressor.h"
+#include "cpl_csv.h"
 #include "cpl_error.h"
 #include "cpl_hash_set.h"
 #include "cpl_list.h"
@@ -51,16 +52,20 @@
 #include "cpl_http.h"
 #include "cpl_auto_close.h"
 #include "cpl_minixml.h"
+#include "cpl_packed_rtree.h"
 #include "cpl_quad_tree.h"
 #include "cpl_worker_thread_pool.h"
 #include "cpl_vsi_virtual.h"
 #include "cpl_threadsafe_queue.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <cmath>
 #include <limits>
 #include <fstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "gtest_include.h"
 
@@ -1167,6 +1172,71 @@ TEST_F(test_cpl, VSIMallocAligned)
     }
 }
 
+/************************************************************************/
+/*                VSIMallocLarge() / VSICallocLarge()                   */
+/************************************************************************/
+TEST_F(test_cpl, VSIMallocLarge)
+{
+    VSIFreeLarge(nullptr);
+
+    // Small path
+    for (size_t nSize : {static_cast<size_t>(1), static_cast<size_t>(1000),
+                         static_cast<size_t>(1024 * 1024)})
+    {
+        GByte *ptr = static_cast<GByte *>(VSIMallocLarge(nSize));
+        ASSERT_TRUE(ptr != nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % 64, 0U);
+        memset(ptr, 0xFF, nSize);
+        VSIFreeLarge(ptr);
+
+        ptr = static_cast<GByte *>(VSICallocLarge(nSize, 1));
+        ASSERT_TRUE(ptr != nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % 64, 0U);
+        EXPECT_EQ(std::count(ptr, ptr + nSize, 0),
+                  static_cast<ptrdiff_t>(nSize));
+        VSIFreeLarge(ptr);
+    }
+
+    // Mapped path (on Linux), and regular allocator with CPL_HUGE_PAGES=NO
+    constexpr size_t LARGE_SIZE = 5 * 1024 * 1024 + 1;
+    for (const char *pszHugePages : {"MADVISE", "HUGETLB", "NO"})
+    {
+        CPLConfigOptionSetter oSetter("CPL_HUGE_PAGES", pszHugePages, false);
+
+        GByte *ptr = static_cast<GByte *>(VSIMallocLarge(LARGE_SIZE));
+        ASSERT_TRUE(ptr != nullptr) << pszHugePages;
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % 64, 0U) << pszHugePages;
+#ifdef __linux
+        // With HUGETLB, falls back to transparent huge pages when no huge
+        // page has been reserved.
+        if (!EQUAL(pszHugePages, "NO"))
+        {
+            constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % HUGE_PAGE_SIZE, 0U)
+                << pszHugePages;
+        }
+#endif
+        memset(ptr, 0xFF, LARGE_SIZE);
+        VSIFreeLarge(ptr);
+
+        // Reuse of the freed area must not leak previous content
+        ptr = static_cast<GByte *>(VSICallocLarge(LARGE_SIZE / 8 + 1, 8));
+        ASSERT_TRUE(ptr != nullptr) << pszHugePages;
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % 64, 0U) << pszHugePages;
+        EXPECT_EQ(std::count(ptr, ptr + LARGE_SIZE, 0),
+                  static_cast<ptrdiff_t>(LARGE_SIZE))
+            << pszHugePages;
+        ptr[0] = 1;
+        ptr[LARGE_SIZE - 1] = 1;
+        VSIFreeLarge(ptr);
+    }
+
+    // Overflow
+    EXPECT_TRUE(VSICallocLarge(std::numeric_limits<size_t>::max() / 2, 3) ==
+                nullptr);
+    EXPECT_TRUE(VSIMallocLarge(std::numeric_limits<size_t>::max()) == nullptr);
+}
+
 /************************************************************************/
 /*             CPLGetConfigOptions() / CPLSetConfigOptions()            */
 /************************************************************************/
@@ -1199,6 +1269,53 @@ TEST_F(test_cpl, CPLGetThreadLocalConfigOptions)
     CSLDestroy(options);
 }
 
+/************************************************************************/
+/*                        CPLConfigOptionCache                          */
+/************************************************************************/
+TEST_F(test_cpl, CPLConfigOptionCache)
+{
+    CPLConfigOptionCache oCache("CPL_TEST_CONFIG_OPTION_CACHE", "default");
+    EXPECT_STREQ(oCache.Get(), "default");
+    CPLSetConfigOption("CPL_TEST_CONFIG_OPTION_CACHE", "foo");
+    EXPECT_STREQ(oCache.Get(), "foo");
+    CPLSetThreadLocalConfigOption("CPL_TEST_CONFIG_OPTION_CACHE", "bar");
+    EXPECT_STREQ(oCache.Get(), "bar");
+    CPLSetThreadLocalConfigOption("CPL_TEST_CONFIG_OPTION_CACHE", nullptr);
+    EXPECT_STREQ(oCache.Get(), "foo");
+    CPLSetConfigOption("CPL_TEST_CONFIG_OPTION_CACHE", nullptr);
+    EXPECT_STREQ(oCache.Get(), "default");
+
+    // Concurrent readers while a writer updates an unrelated key
+    CPLSetConfigOption("CPL_TEST_CONFIG_OPTION_CACHE", "foo");
+    std::atomic<bool> bStop{false};
+    std::atomic<int> nErrors{0};
+    std::vector<std::thread> aoThreads;
+    for (int i = 0; i < 4; ++i)
+    {
+        aoThreads.emplace_back(
+            [&]()
+            {
+                while (!bStop)
+                {
+                    const char *pszVal = CPLGetConfigOption(
+                        "CPL_TEST_CONFIG_OPTION_CACHE", nullptr);
+                    if (pszVal == nullptr || strcmp(pszVal, "foo") != 0)
+                        ++nErrors;
+                    if (strcmp(oCache.Get(), "foo") != 0)
+                        ++nErrors;
+                }
+            });
+    }
+    for (int i = 0; i < 1000; ++i)
+        CPLSetConfigOption("CPL_TEST_CONFIG_OPTION_OTHER",
+                           (i % 2) == 0 ? "x" : nullptr);
+    bStop = true;
+    for (auto &oThread : aoThreads)
+        oThread.join();
+    EXPECT_EQ(nErrors, 0);
+    CPLSetConfigOption("CPL_TEST_CONFIG_OPTION_CACHE", nullptr);
+}
+
 TEST_F(test_cpl, CPLExpandTilde)
 {
     EXPECT_STREQ(CPLExpandTilde("/foo/bar"), "/foo/bar");
@@ -2344,6 +2461,83 @@ TEST_F(test_cpl, CPLJSonStreamingParser)
     }
 }
 
+// Test that CPLJSonStreamingParser gives the same result whatever the size
+// of the chunks it is fed with, in particular for long strings and numbers
+// that are consumed by runs of characters.
+TEST_F(test_cpl, CPLJSonStreamingParser_chunk_sizes)
+{
+    const auto ParseByChunks =
+        [](CPLJSonStreamingParserDump &oParser, const std::string &osText,
+           size_t nChunkSize)
+    {
+        oParser.Reset();
+        bool bRet = true;
+        for (size_t i = 0; bRet && i < osText.size(); i += nChunkSize)
+        {
+            const size_t nSize = std::min(nChunkSize, osText.size() - i);
+            bRet = oParser.Parse(osText.data() + i, nSize,
+                                 i + nSize == osText.size());
+        }
+        return bRet;
+    };
+
+    {
+        std::string osLongString;
+        for (int i = 0; i < 1000; ++i)
+            osLongString += "abcdefghij";
+        std::string osText("{\"a\": \"");
+        osText += osLongString;
+        osText += "\\\"\\u00e9\\uD834\\uDD1E\\n";
+        osText += osLongString;
+        osText += "\", \"b\": [-123.456e+78, 0.5, 1234567890123456789],\n";
+        osText += "\"c\": \"x\"}";
+
+        CPLJSonStreamingParserDump oParser;
+        ASSERT_TRUE(oParser.Parse(osText.data(), osText.size(), true));
+        const std::string osExpected = oParser.GetSerialized();
+        EXPECT_EQ(osExpected.find("\"b\": [-123.456e+78, 0.5, "
+                                  "1234567890123456789], \"c\": \"x\"}"),
+                  osExpected.size() - 56);
+        for (const size_t nChunkSize : {1, 2, 3, 7, 64, 4096})
+        {
+            EXPECT_TRUE(ParseByChunks(oParser, osText, nChunkSize));
+            EXPECT_EQ(oParser.GetSerialized(), osExpected) << nChunkSize;
+        }
+    }
+
+    // Error positions must not depend on the chunk size either
+    {
+        std::string osText("[\n1,\n");
+        osText += std::string(1025, '1');
+        osText += "]";
+
+        CPLJSonStreamingParserDump oParser;
+        EXPECT_TRUE(!oParser.Parse(osText.data(), osText.size(), true));
+        const std::string osExpected = oParser.GetException();
+        EXPECT_EQ(osExpected,
+                  "At line 3, character 1025: Too many characters in number");
+        for (const size_t nChunkSize : {1, 2, 3, 7, 64, 4096})
+        {
+            EXPECT_TRUE(!ParseByChunks(oParser, osText, nChunkSize));
+            EXPECT_EQ(oParser.GetException(), osExpected) << nChunkSize;
+        }
+    }
+    {
+        const std::string osText("[\"abc\", \"0123456789\"]");
+
+        CPLJSonStreamingParserDump oParser;
+        oParser.SetMaxStringSize(5);
+        EXPECT_TRUE(!oParser.Parse(osText.data(), osText.size(), true));
+        const std::string osExpected = oParser.GetException();
+        EXPECT_TRUE(!osExpected.empty());
+        for (const size_t nChunkSize : {1, 2, 3, 7})
+        {
+            EXPECT_TRUE(!ParseByChunks(oParser, osText, nChunkSize));
+            EXPECT_EQ(oParser.GetException(), osExpected) << nChunkSize;
+        }
+    }
+}
+
 // Test cpl_mem_cache
 TEST_F(test_cpl, cpl_mem_cache)
 {
@@ -3990,6 +4184,96 @@ TEST_F(test_cpl, CPLQuadTree)
     CPLQuadTreeDestroy(hTree);
 }
 
+// Test CPLPackedRTree against a brute force search
+TEST_F(test_cpl, CPLPackedRTree)
+{
+    unsigned next = 0;
+    constexpr int MAX_RAND_VAL = 32767;
+    const auto DummyRand = [&]()
+    {
+        next = next * 1103515245 + 12345;
+        return ((unsigned)(next / 65536) % (MAX_RAND_VAL + 1));
+    };
+
+    const auto GenerateRandomRect = [&](CPLRectObj &rect)
+    {
+        rect.minx = double(DummyRand()) / MAX_RAND_VAL;
+        rect.miny = double(DummyRand()) / MAX_RAND_VAL;
+        rect.maxx = rect.minx + double(DummyRand()) / MAX_RAND_VAL * 0.05;
+        rect.maxy = rect.miny + double(DummyRand()) / MAX_RAND_VAL * 0.05;
+    };
+
+    const auto Overlaps = [](const CPLRectObj &a, const CPLRectObj &b)
+    {
+        return !(a.minx > b.maxx || a.maxx < b.minx || a.miny > b.maxy ||
+                 a.maxy < b.miny);
+    };
+
+    {
+        CPLPackedRTree oEmpty;
+        oEmpty.Build();
+        EXPECT_TRUE(oEmpty.IsBuilt());
+        std::vector<void *> ahFeatures;
+        CPLRectObj rect{0, 0, 1, 1};
+        oEmpty.Search(rect, ahFeatures);
+        EXPECT_TRUE(ahFeatures.empty());
+    }
+
+    for (int nCount : {1, 15, 16, 17, 257, 5000})
+    {
+        for (int nNodeSize : {2, 16})
+        {
+            CPLPackedRTree oTree(nNodeSize);
+            std::vector<CPLRectObj> asRects(nCount);
+            for (int i = 0; i < nCount; i++)
+            {
+                GenerateRandomRect(asRects[i]);
+                void *hFeature =
+                    reinterpret_cast<void *>(static_cast<uintptr_t>(i));
+                oTree.Insert(hFeature, asRects[i]);
+            }
+            oTree.Build();
+            ASSERT_EQ(oTree.GetFeatureCount(), static_cast<size_t>(nCount));
+
+            std::vector<CPLRectObj> asAoi(50);
+            for (auto &sAoi : asAoi)
+                GenerateRandomRect(sAoi);
+            asAoi[0] = CPLRectObj{0, 0, 1.1, 1.1};
+
+            std::vector<size_t> anOffsets;
+            std::vector<void *> ahBatch;
+            oTree.SearchBatch(asAoi.size(), asAoi.data(), anOffsets, ahBatch);
+            ASSERT_EQ(anOffsets.size(), asAoi.size() + 1);
+
+            for (size_t iAoi = 0; iAoi < asAoi.size(); ++iAoi)
+            {
+                std::vector<int> anExpected;
+                for (int i = 0; i < nCount; i++)
+                {
+                    if (Overlaps(asRects[i], asAoi[iAoi]))
+                        anExpected.push_back(i);
+                }
+
+                std::vector<void *> ahFeatures;
+                oTree.Search(asAoi[iAoi], ahFeatures);
+                std::vector<int> anGot;
+                for (void *hFeature : ahFeatures)
+                    anGot.push_back(static_cast<int>(
+                        reinterpret_cast<uintptr_t>(hFeature)));
+                std::sort(anGot.begin(), anGot.end());
+                EXPECT_EQ(anGot, anExpected);
+
+                std::vector<int> anGotBatch;
+                for (size_t i = anOffsets[iAoi]; i < anOffsets[iAoi + 1]; ++i)
+                    anGotBatch.push_back(static_cast<int>(
+                        reinterpret_cast<uintptr_t>(ahBatch[i])));
+                std::sort(anGotBatch.begin(), anGotBatch.end());
+                EXPECT_EQ(anGotBatch, anExpected);
+            }
+        }
+    }
+}
+
 // Test bUnlinkAndSize on VSIGetMemFileBuffer
 TEST_F(test_cpl, VSIGetMemFileBuffer_unlink_and_size)
 {
@@ -4517,6 +4801,39 @@ TEST_F(test_cpl, CPLWorkerThreadPool_recursion)
     ASSERT_EQ(ctxt.nCounter, 3 * 3);
 }
 
+// Test CPLWorkerThreadPool with more jobs waiting for nested jobs than
+// worker threads
+TEST_F(test_cpl, CPLWorkerThreadPool_nested_wait)
+{
+    struct Context
+    {
+        CPLWorkerThreadPool oThreadPool{};
+        std::atomic<int> nCounter{0};
+    };
+    Context ctxt;
+    ctxt.oThreadPool.Setup(2, nullptr, nullptr, /* waitAllStarted = */ true);
+
+    const auto outerJob = [](void *pData)
+    {
+        const auto innerJob = [](void *pData2)
+        { static_cast<Context *>(pData2)->nCounter++; };
+        auto psCtxt = static_cast<Context *>(pData);
+        auto poQueue = psCtxt->oThreadPool.CreateJobQueue();
+        for (int i = 0; i < 20; ++i)
+            poQueue->SubmitJob(innerJob, psCtxt);
+        poQueue->WaitCompletion();
+    };
+
+    constexpr int N_OUTER_JOBS = 50;
+    {
+        auto poQueue = ctxt.oThreadPool.CreateJobQueue();
+        for (int i = 0; i < N_OUTER_JOBS; ++i)
+            poQueue->SubmitJob(outerJob, &ctxt);
+        poQueue->WaitCompletion();
+    }
+    ASSERT_EQ(ctxt.nCounter, N_OUTER_JOBS * 20);
+}
+
 // Test /vsimem/ PRead() implementation
 TEST_F(test_cpl, vsimem_pread)
 {
@@ -5024,4 +5341,44 @@ TEST_F(test_cpl, CPLStrtod)
     }
 }
 
+// Test CSVReadParseLine3L()
+TEST_F(test_cpl, CSVReadParseLine3L)
+{
+    char szContent[] = "a,\"b,c\",\"d\"\"e\",f\"g\",\n"
+                       "\"multi\nline\";x;;y\n"
+                       "1::2:3::\n";
+    VSILFILE *fp = VSIFileFromMemBuffer(
+        "", reinterpret_cast<GByte *>(szContent), strlen(szContent), FALSE);
+    ASSERT_NE(fp, nullptr);
+    {
+        const CPLStringList aosTokens(
+            CSVReadParseLine3L(fp, 0, ",", true, false, false, true));
+        ASSERT_EQ(aosTokens.size(), 5);
+        EXPECT_STREQ(aosTokens[0], "a");
+        EXPECT_STREQ(aosTokens[1], "b,c");
+        EXPECT_STREQ(aosTokens[2], "d\"e");
+        EXPECT_STREQ(aosTokens[3], "f\"g\"");
+        EXPECT_STREQ(aosTokens[4], "");
+    }
+    {
+        const CPLStringList aosTokens(
+            CSVReadParseLine3L(fp, 0, ";", true, true, true, true));
+        ASSERT_EQ(aosTokens.size(), 3);
+        EXPECT_STREQ(aosTokens[0], "\"multi\nline\"");
+        EXPECT_STREQ(aosTokens[1], "x");
+        EXPECT_STREQ(aosTokens[2], "y");
+    }
+    {
+        const CPLStringList aosTokens(
+            CSVReadParseLine3L(fp, 0, "::", true, false, false, true));
+        ASSERT_EQ(aosTokens.size(), 3);
+        EXPECT_STREQ(aosTokens[0], "1");
+        EXPECT_STREQ(aosTokens[1], "2:3");
+        EXPECT_STREQ(aosTokens[2], "");
+    }
+    EXPECT_EQ(CSVReadParseLine3L(fp, 0, ",", true, false, false, true),
+              nullptr);
+    VSIFCloseL(fp);
+}
+
 }  // namespace
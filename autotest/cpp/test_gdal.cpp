@@ -28,16 +28,22 @@
 
 #include "gdal_unit_test.h"
 
+#include "cpl_json.h"
 #include "gdal_alg.h"
 #include "gdal_priv.h"
+#include "cpl_vsi_virtual.h"
 #include "gdal_utils.h"
 #include "gdal_priv_templates.hpp"
 #include "gdal.h"
 #include "tilematrixset.hpp"
 #include "gdalcachedpixelaccessor.h"
+#include "gdal_thread_pool.h"
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
 #include <string>
+#include <thread>
 
 #include "test_data.h"
 
@@ -1498,6 +1504,93 @@ TEST_F(test_gdal, GDALExtendedDataType)
 #endif
 }
 
+// Test the N-dimensional version of GDALExtendedDataType::CopyValues()
+TEST_F(test_gdal, GDALExtendedDataType_CopyValues_ND)
+{
+    // Source array of shape (5, 6, 40) in row-major order
+    std::vector<uint16_t> anSrc(5 * 6 * 40);
+    for (size_t i = 0; i < anSrc.size(); ++i)
+        anSrc[i] = static_cast<uint16_t>(i);
+    const GPtrDiff_t anSrcStrides[] = {6 * 40, 40, 1};
+
+    const auto CheckCopy = [&](const size_t *count, const size_t *startIdx,
+                               const GPtrDiff_t *dstStrides, GDALDataType eDT)
+    {
+        const auto oSrcType = GDALExtendedDataType::Create(GDT_UInt16);
+        const auto oDstType = GDALExtendedDataType::Create(eDT);
+        const size_t nElts = count[0] * count[1] * count[2];
+        std::vector<double> adfDst(nElts);
+        std::vector<double> adfExpected(nElts);
+        std::vector<GByte> abyDst(nElts * oDstType.GetSize());
+        GPtrDiff_t nMinDstOffset = 0;
+        for (int i = 0; i < 3; ++i)
+        {
+            if (dstStrides[i] < 0)
+                nMinDstOffset +=
+                    dstStrides[i] * static_cast<GPtrDiff_t>(count[i] - 1);
+        }
+        const uint16_t *pSrc = anSrc.data() + startIdx[0] * anSrcStrides[0] +
+                               startIdx[1] * anSrcStrides[1] + startIdx[2];
+        EXPECT_TRUE(GDALExtendedDataType::CopyValues(
+            3, count, pSrc, oSrcType, anSrcStrides,
+            abyDst.data() - nMinDstOffset * oDstType.GetSize(), oDstType,
+            dstStrides));
+        for (size_t i = 0; i < count[0]; ++i)
+        {
+            for (size_t j = 0; j < count[1]; ++j)
+            {
+                for (size_t k = 0; k < count[2]; ++k)
+                {
+                    const GPtrDiff_t nDstIdx =
+                        static_cast<GPtrDiff_t>(i) * dstStrides[0] +
+                        static_cast<GPtrDiff_t>(j) * dstStrides[1] +
+                        static_cast<GPtrDiff_t>(k) * dstStrides[2] -
+                        nMinDstOffset;
+                    GDALCopyWords(abyDst.data() +
+                                      nDstIdx * oDstType.GetSize(),
+                                  eDT, 0, &adfDst[nDstIdx], GDT_Float64, 0,
+                                  1);
+                    adfExpected[nDstIdx] =
+                        pSrc[i * anSrcStrides[0] + j * anSrcStrides[1] + k];
+                }
+            }
+        }
+        EXPECT_EQ(adfDst, adfExpected);
+    };
+
+    for (const GDALDataType eDT : {GDT_UInt16, GDT_Float32})
+    {
+        // Contiguous
+        {
+            const size_t count[] = {5, 6, 40};
+            const size_t startIdx[] = {0, 0, 0};
+            const GPtrDiff_t dstStrides[] = {6 * 40, 40, 1};
+            CheckCopy(count, startIdx, dstStrides, eDT);
+        }
+        // Time series extraction
+        {
+            const size_t count[] = {5, 1, 1};
+            const size_t startIdx[] = {0, 2, 3};
+            const GPtrDiff_t dstStrides[] = {1, 1, 1};
+            CheckCopy(count, startIdx, dstStrides, eDT);
+        }
+        // Transposed destination
+        {
+            const size_t count[] = {5, 4, 35};
+            const size_t startIdx[] = {0, 1, 2};
+            const GPtrDiff_t dstStrides[] = {1, 5 * 35, 5};
+            CheckCopy(count, startIdx, dstStrides, eDT);
+        }
+        // Negative destination strides
+        {
+            const size_t count[] = {3, 6, 33};
+            const size_t startIdx[] = {1, 0, 7};
+            const GPtrDiff_t dstStrides[] = {-6 * 33, 33, -1};
+            CheckCopy(count, startIdx, dstStrides, eDT);
+        }
+    }
+}
+
 // Test GDALDataset::GetRawBinaryLayout() implementations
 TEST_F(test_gdal, GetRawBinaryLayout_ENVI)
 {
@@ -3597,4 +3690,847 @@ TEST_F(test_gdal, drop_cache)
     }
 }
 
+// Test GDALDataset::SetCacheBudget()
+TEST_F(test_gdal, SetCacheBudget)
+{
+    auto poDS = std::unique_ptr<GDALDataset>(
+        GDALDriver::FromHandle(GDALGetDriverByName("MEM"))
+            ->Create("", 1000, 1000, 1, GDT_Byte, nullptr));
+    ASSERT_TRUE(poDS != nullptr);
+    EXPECT_EQ(poDS->SetCacheBudget(-1), CE_Failure);
+
+    constexpr GIntBig BUDGET = 100 * 1000;
+    EXPECT_EQ(poDS->SetCacheBudget(BUDGET, 3), CE_None);
+    int nPriority = 0;
+    EXPECT_EQ(poDS->GetCacheBudget(&nPriority), BUDGET);
+    EXPECT_EQ(nPriority, 3);
+
+    auto poBand = poDS->GetRasterBand(1);
+    for (int iY = 0; iY < poDS->GetRasterYSize(); ++iY)
+    {
+        auto poBlock = poBand->GetLockedBlockRef(0, iY);
+        ASSERT_TRUE(poBlock != nullptr);
+        poBlock->DropLock();
+
+        GIntBig nUsed = 0;
+        poDS->GetCacheStatistics(&nUsed, nullptr, nullptr, nullptr);
+        EXPECT_LE(nUsed, BUDGET);
+    }
+    auto poBlock = poBand->GetLockedBlockRef(0, poDS->GetRasterYSize() - 1);
+    ASSERT_TRUE(poBlock != nullptr);
+    poBlock->DropLock();
+
+    GIntBig nUsed = 0;
+    GIntBig nHits = 0;
+    GIntBig nMisses = 0;
+    GIntBig nEvictions = 0;
+    GDALDatasetGetCacheStatistics(GDALDataset::ToHandle(poDS.get()), &nUsed,
+                                  &nHits, &nMisses, &nEvictions, nullptr);
+    EXPECT_GT(nUsed, 0);
+    EXPECT_EQ(nHits, 1);
+    EXPECT_EQ(nMisses, poDS->GetRasterYSize());
+    EXPECT_GT(nEvictions, 0);
+
+    poBand->FlushCache(false);
+    poDS->GetCacheStatistics(&nUsed, nullptr, nullptr, nullptr);
+    EXPECT_EQ(nUsed, 0);
+}
+
+// Test GDALRasterBand::GetCacheStatistics() and
+// GDALGetCacheContentsAsSerializedJSON()
+TEST_F(test_gdal, BlockCacheStatistics)
+{
+    auto poDS = std::unique_ptr<GDALDataset>(
+        GDALDriver::FromHandle(GDALGetDriverByName("MEM"))
+            ->Create("", 100, 100, 2, GDT_Byte, nullptr));
+    ASSERT_TRUE(poDS != nullptr);
+    poDS->SetDescription("BlockCacheStatistics");
+    // Less than the effective size of a single block
+    ASSERT_EQ(poDS->SetCacheBudget(150), CE_None);
+
+    GIntBig nGlobalHitsBefore = 0;
+    GDALGetCacheStatistics(&nGlobalHitsBefore, nullptr, nullptr, nullptr);
+
+    auto poBand = poDS->GetRasterBand(1);
+    auto poBlock = poBand->GetLockedBlockRef(0, 0);
+    ASSERT_TRUE(poBlock != nullptr);
+    poBlock->MarkDirty();
+    poBlock->DropLock();
+    poBlock = poBand->GetLockedBlockRef(0, 0);
+    ASSERT_TRUE(poBlock != nullptr);
+    poBlock->DropLock();
+
+    GIntBig nUsed = 0;
+    GIntBig nHits = 0;
+    GIntBig nMisses = 0;
+    GIntBig nEvictions = 0;
+    GIntBig nDirtyFlushes = 0;
+    poBand->GetCacheStatistics(&nUsed, &nHits, &nMisses, &nEvictions,
+                               &nDirtyFlushes);
+    EXPECT_GE(nUsed, 100);
+    EXPECT_EQ(nHits, 1);
+    EXPECT_EQ(nMisses, 1);
+    EXPECT_EQ(nEvictions, 0);
+    EXPECT_EQ(nDirtyFlushes, 0);
+
+    GIntBig nGlobalHits = 0;
+    GDALGetCacheStatistics(&nGlobalHits, nullptr, nullptr, nullptr);
+    EXPECT_GE(nGlobalHits, nGlobalHitsBefore + 1);
+
+    {
+        char *pszJSON = GDALGetCacheContentsAsSerializedJSON(nullptr);
+        CPLJSONDocument oDoc;
+        ASSERT_TRUE(oDoc.LoadMemory(pszJSON));
+        CPLFree(pszJSON);
+        bool bFound = false;
+        for (const auto &oDS : oDoc.GetRoot().GetArray("datasets"))
+        {
+            if (oDS.GetString("description") != "BlockCacheStatistics")
+                continue;
+            bFound = true;
+            EXPECT_EQ(oDS.GetInteger("block_count"), 1);
+            EXPECT_EQ(oDS.GetInteger("dirty_block_count"), 1);
+            EXPECT_EQ(oDS.GetLong("budget"), 150);
+            const auto oBands = oDS.GetArray("bands");
+            ASSERT_EQ(oBands.Size(), 1);
+            EXPECT_EQ(oBands[0].GetInteger("band"), 1);
+            EXPECT_EQ(oBands[0].GetLong("hits"), 1);
+        }
+        EXPECT_TRUE(bFound);
+    }
+
+    // Evicts the dirty block of the first band
+    poBlock = poDS->GetRasterBand(2)->GetLockedBlockRef(0, 0);
+    ASSERT_TRUE(poBlock != nullptr);
+    poBlock->DropLock();
+
+    poBand->GetCacheStatistics(&nUsed, nullptr, nullptr, &nEvictions,
+                               &nDirtyFlushes);
+    EXPECT_EQ(nUsed, 0);
+    EXPECT_EQ(nEvictions, 1);
+    EXPECT_EQ(nDirtyFlushes, 1);
+    poDS->GetCacheStatistics(nullptr, nullptr, nullptr, &nEvictions,
+                             &nDirtyFlushes);
+    EXPECT_EQ(nEvictions, 1);
+    EXPECT_EQ(nDirtyFlushes, 1);
+}
+
+// Test GDALDataset::AccountMemory(), SetMemoryBudget() and TrimMemory()
+TEST_F(test_gdal, MemoryAccounting)
+{
+    class MyDataset final : public GDALDataset
+    {
+      public:
+        GIntBig m_nTrimRequested = 0;
+
+        GIntBig TrimMemory(GIntBig nBytesToRelease) override
+        {
+            m_nTrimRequested = nBytesToRelease;
+            // Release everything
+            const GIntBig nUsage = GetMemoryUsage("test.buffer");
+            AccountMemory("test.buffer", -nUsage);
+            return nUsage;
+        }
+    };
+
+    const GIntBig nGlobalBefore = CPLGetAccountedMemory(nullptr);
+    {
+        MyDataset oDS;
+        oDS.AccountMemory("test.buffer", 1000);
+        oDS.AccountMemory("test.other", 10);
+        EXPECT_EQ(oDS.GetMemoryUsage(), 1010);
+        EXPECT_EQ(oDS.GetMemoryUsage("test.buffer"), 1000);
+        EXPECT_EQ(CPLGetAccountedMemory("test.buffer"), 1000);
+        EXPECT_EQ(CPLGetAccountedMemory(nullptr), nGlobalBefore + 1010);
+        EXPECT_EQ(GDALGetResidentMemoryUsage(),
+                  GDALGetCacheUsed64() + CPLGetAccountedMemory(nullptr));
+        {
+            const CPLStringList aosCategories(
+                CPLGetAccountedMemoryCategories());
+            EXPECT_STREQ(aosCategories.FetchNameValue("test.buffer"), "1000");
+        }
+        EXPECT_EQ(oDS.m_nTrimRequested, 0);
+
+        EXPECT_EQ(oDS.SetMemoryBudget(-1), CE_Failure);
+        EXPECT_EQ(oDS.SetMemoryBudget(1500), CE_None);
+        EXPECT_EQ(oDS.GetMemoryBudget(), 1500);
+        oDS.AccountMemory("test.buffer", 400);
+        EXPECT_EQ(oDS.m_nTrimRequested, 0);
+        oDS.AccountMemory("test.buffer", 200);
+        EXPECT_EQ(oDS.m_nTrimRequested, 110);
+        EXPECT_EQ(oDS.GetMemoryUsage(), 10);
+        EXPECT_EQ(CPLGetAccountedMemory("test.buffer"), 0);
+    }
+    // Memory not released by the dataset is released when it is destroyed
+    EXPECT_EQ(CPLGetAccountedMemory("test.other"), 0);
+    EXPECT_EQ(CPLGetAccountedMemory(nullptr), nGlobalBefore);
+
+    // Global limit
+    {
+        MyDataset oDS;
+        CPLConfigOptionSetter oSetter(
+            "GDAL_MEMORY_LIMIT",
+            CPLSPrintf(CPL_FRMT_GIB, GDALGetResidentMemoryUsage() + 100000),
+            false);
+        EXPECT_EQ(GDALGetMemoryLimit(), GDALGetResidentMemoryUsage() + 100000);
+        oDS.AccountMemory("test.buffer", 100001);
+        EXPECT_EQ(oDS.m_nTrimRequested, 1);
+        EXPECT_EQ(oDS.GetMemoryUsage(), 0);
+    }
+    {
+        CPLConfigOptionSetter oSetter("GDAL_MEMORY_LIMIT", "10", false);
+        EXPECT_EQ(GDALGetMemoryLimit(), 10 * 1024 * 1024);
+    }
+}
+
+// Test CACHE_BUDGET and CACHE_PRIORITY generic open options
+TEST_F(test_gdal, CACHE_BUDGET_open_option)
+{
+    CPLErrorReset();
+    const char *const apszOpenOptions[] = {"CACHE_BUDGET=2",
+                                           "CACHE_PRIORITY=5", nullptr};
+    auto poDS = std::unique_ptr<GDALDataset>(
+        GDALDataset::Open(GCORE_DATA_DIR "byte.tif", GDAL_OF_RASTER, nullptr,
+                          apszOpenOptions));
+    ASSERT_TRUE(poDS != nullptr);
+    EXPECT_EQ(CPLGetLastErrorType(), CE_None);
+    int nPriority = 0;
+    EXPECT_EQ(poDS->GetCacheBudget(&nPriority), 2 * 1024 * 1024);
+    EXPECT_EQ(nPriority, 5);
+}
+
+// Test GDALDataset::RasterIOAsync()
+TEST_F(test_gdal, RasterIOAsync)
+{
+    constexpr int WIDTH = 300;
+    constexpr int HEIGHT = 5000;
+    constexpr int BANDS = 3;
+    auto poDS = std::unique_ptr<GDALDataset>(
+        GDALDriver::FromHandle(GDALGetDriverByName("MEM"))
+            ->Create("", WIDTH, HEIGHT, BANDS, GDT_Byte, nullptr));
+    ASSERT_TRUE(poDS != nullptr);
+
+    std::vector<GByte> abyRef(static_cast<size_t>(WIDTH) * HEIGHT * BANDS);
+    for (size_t i = 0; i < abyRef.size(); ++i)
+        abyRef[i] = static_cast<GByte>(i * 7);
+    {
+        auto poRequest = poDS->RasterIOAsync(
+            GF_Write, 0, 0, WIDTH, HEIGHT, abyRef.data(), WIDTH, HEIGHT,
+            GDT_Byte, BANDS, nullptr, BANDS, BANDS * WIDTH, 1, nullptr);
+        ASSERT_TRUE(poRequest != nullptr);
+        EXPECT_EQ(poRequest->Wait(), GARIO_COMPLETE);
+        EXPECT_EQ(poRequest->GetProgress(), 1.0);
+    }
+
+    // Full resolution read, split into several jobs
+    {
+        std::vector<GByte> abyBuf(abyRef.size());
+        const int anBandMap[] = {1, 2, 3};
+        auto poRequest = poDS->RasterIOAsync(
+            GF_Read, 0, 0, WIDTH, HEIGHT, abyBuf.data(), WIDTH, HEIGHT,
+            GDT_Byte, BANDS, anBandMap, BANDS, BANDS * WIDTH, 1, nullptr);
+        ASSERT_TRUE(poRequest != nullptr);
+        EXPECT_EQ(poRequest->Wait(), GARIO_COMPLETE);
+        EXPECT_EQ(abyBuf, abyRef);
+    }
+
+    // Resampled read, compared against RasterIO()
+    {
+        std::vector<GByte> abyBuf(10 * 10);
+        std::vector<GByte> abyExpected(10 * 10);
+        const int anBandMap[] = {2};
+        auto poRequest = poDS->RasterIOAsync(
+            GF_Read, 1, 2, WIDTH - 1, HEIGHT - 2, abyBuf.data(), 10, 10,
+            GDT_Byte, 1, anBandMap, 0, 0, 0, nullptr);
+        ASSERT_TRUE(poRequest != nullptr);
+        EXPECT_EQ(poRequest->Wait(), GARIO_COMPLETE);
+        EXPECT_EQ(poDS->RasterIO(GF_Read, 1, 2, WIDTH - 1, HEIGHT - 2,
+                                 abyExpected.data(), 10, 10, GDT_Byte, 1,
+                                 nullptr, 0, 0, 0, nullptr),
+                  CE_None);
+        EXPECT_EQ(abyBuf, abyExpected);
+    }
+
+    // Invalid window
+    {
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        GByte byVal = 0;
+        EXPECT_TRUE(poDS->RasterIOAsync(GF_Read, 0, 0, WIDTH + 1, 1, &byVal,
+                                        1, 1, GDT_Byte, 1, nullptr, 0, 0, 0,
+                                        nullptr) == nullptr);
+    }
+}
+
+// Test concurrent GDALDataset::RasterIOAsync() requests on multi-threaded
+// GTiff datasets, with more requests than threads in the global thread pool
+TEST_F(test_gdal, RasterIOAsync_concurrent_GTiff)
+{
+    auto poDriver = GDALDriver::FromHandle(GDALGetDriverByName("GTiff"));
+    if (poDriver == nullptr)
+    {
+        GTEST_SKIP() << "GTiff driver missing";
+    }
+
+    constexpr int WIDTH = 256;
+    constexpr int HEIGHT = 256;
+    const char *pszFilename = "/vsimem/RasterIOAsync_concurrent_GTiff.tif";
+    std::vector<GByte> abyRef(static_cast<size_t>(WIDTH) * HEIGHT);
+    for (size_t i = 0; i < abyRef.size(); ++i)
+        abyRef[i] = static_cast<GByte>((i * 13) / 7);
+    {
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("TILED", "YES");
+        aosOptions.SetNameValue("BLOCKXSIZE", "32");
+        aosOptions.SetNameValue("BLOCKYSIZE", "32");
+        aosOptions.SetNameValue("COMPRESS", "DEFLATE");
+        auto poDS = std::unique_ptr<GDALDataset>(
+            poDriver->Create(pszFilename, WIDTH, HEIGHT, 1, GDT_Byte,
+                             aosOptions.List()));
+        ASSERT_TRUE(poDS != nullptr);
+        ASSERT_EQ(poDS->RasterIO(GF_Write, 0, 0, WIDTH, HEIGHT, abyRef.data(),
+                                 WIDTH, HEIGHT, GDT_Byte, 1, nullptr, 0, 0, 0,
+                                 nullptr),
+                  CE_None);
+    }
+
+    CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(2);
+    ASSERT_TRUE(poPool != nullptr);
+    const int nRequests = poPool->GetThreadCount() + 2;
+
+    const char *const apszOpenOptions[] = {"NUM_THREADS=2", nullptr};
+    std::vector<std::unique_ptr<GDALDataset>> apoDS;
+    std::vector<std::vector<GByte>> aabyBuf;
+    std::vector<std::unique_ptr<GDALRasterIOAsyncRequest>> apoRequests;
+    for (int i = 0; i < nRequests; ++i)
+    {
+        apoDS.emplace_back(GDALDataset::Open(pszFilename, GDAL_OF_RASTER,
+                                             nullptr, apszOpenOptions));
+        ASSERT_TRUE(apoDS.back() != nullptr);
+        aabyBuf.emplace_back(abyRef.size());
+    }
+    for (int i = 0; i < nRequests; ++i)
+    {
+        apoRequests.emplace_back(apoDS[i]->RasterIOAsync(
+            GF_Read, 0, 0, WIDTH, HEIGHT, aabyBuf[i].data(), WIDTH, HEIGHT,
+            GDT_Byte, 1, nullptr, 0, 0, 0, nullptr));
+        ASSERT_TRUE(apoRequests.back() != nullptr);
+    }
+    for (int i = 0; i < nRequests; ++i)
+    {
+        EXPECT_EQ(apoRequests[i]->Wait(), GARIO_COMPLETE);
+        EXPECT_EQ(aabyBuf[i], abyRef);
+    }
+    apoRequests.clear();
+    apoDS.clear();
+    VSIUnlink(pszFilename);
+}
+
+// Test GDALRasterBand::PinBlock()
+TEST_F(test_gdal, PinBlock)
+{
+    auto poDS = std::unique_ptr<GDALDataset>(
+        GDALDataset::Open(GCORE_DATA_DIR "byte.tif", GDAL_OF_RASTER));
+    ASSERT_TRUE(poDS != nullptr);
+    auto poBand = poDS->GetRasterBand(1);
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    std::vector<GByte> abyRef(static_cast<size_t>(nBlockXSize) * nBlockYSize);
+    ASSERT_EQ(poBand->ReadBlock(0, 0, abyRef.data()), CE_None);
+
+    {
+        GDALPinnedBlock oBlock = poBand->PinBlock(0, 0);
+        ASSERT_TRUE(oBlock);
+        EXPECT_EQ(oBlock.GetDataType(), GDT_Byte);
+        EXPECT_EQ(oBlock.GetXSize(), nBlockXSize);
+        EXPECT_EQ(oBlock.GetYSize(), nBlockYSize);
+        EXPECT_EQ(oBlock.GetXOff(), 0);
+        EXPECT_EQ(oBlock.GetYOff(), 0);
+        EXPECT_EQ(memcmp(oBlock.GetData(), abyRef.data(), abyRef.size()), 0);
+
+        // The block cannot be evicted while pinned
+        const void *pData = oBlock.GetData();
+        GDALRasterBlock::FlushCacheBlock();
+        auto poBlock = poBand->TryGetLockedBlockRef(0, 0);
+        ASSERT_TRUE(poBlock != nullptr);
+        EXPECT_EQ(poBlock->GetDataRef(), pData);
+        poBlock->DropLock();
+
+        GDALPinnedBlock oBlock2(std::move(oBlock));
+        EXPECT_FALSE(oBlock);
+        EXPECT_EQ(oBlock.GetData(), nullptr);
+        EXPECT_EQ(oBlock2.GetData(), pData);
+        oBlock2.Release();
+        EXPECT_FALSE(oBlock2);
+    }
+
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    EXPECT_FALSE(poBand->PinBlock(-1, 0));
+    CPLPopErrorHandler();
+
+    GDALPinnedBlockH hBlock =
+        GDALRasterBandPinBlock(GDALRasterBand::ToHandle(poBand), 0, 0);
+    ASSERT_TRUE(hBlock != nullptr);
+    EXPECT_EQ(memcmp(GDALPinnedBlockGetData(hBlock), abyRef.data(),
+                     abyRef.size()),
+              0);
+    GDALPinnedBlockRelease(hBlock);
+}
+
+// Test GDAL_OF_THREAD_SAFE
+TEST_F(test_gdal, ThreadSafeDataset)
+{
+    GDALDriver *poGTiffDrv = GetGDALDriverManager()->GetDriverByName("GTiff");
+    if (!poGTiffDrv)
+    {
+        GTEST_SKIP() << "GTiff driver missing";
+    }
+
+    constexpr int N = 200;
+    const char *pszFilename = "/vsimem/test_thread_safe_dataset.tif";
+    {
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("TILED", "YES");
+        aosOptions.SetNameValue("BLOCKXSIZE", "16");
+        aosOptions.SetNameValue("BLOCKYSIZE", "16");
+        aosOptions.SetNameValue("COMPRESS", "LZW");
+        auto poDS = std::unique_ptr<GDALDataset>(poGTiffDrv->Create(
+            pszFilename, N, N, 2, GDT_UInt16, aosOptions.List()));
+        ASSERT_TRUE(poDS != nullptr);
+        std::vector<GUInt16> anValues(N * N);
+        for (int i = 0; i < N * N; ++i)
+            anValues[i] = static_cast<GUInt16>(i);
+        ASSERT_EQ(poDS->GetRasterBand(1)->RasterIO(GF_Write, 0, 0, N, N,
+                                                   anValues.data(), N, N,
+                                                   GDT_UInt16, 0, 0, nullptr),
+                  CE_None);
+        ASSERT_EQ(poDS->GetRasterBand(2)->Fill(4), CE_None);
+        poDS->GetRasterBand(2)->SetNoDataValue(4);
+        const int nOvrFactor = 2;
+        ASSERT_EQ(poDS->BuildOverviews("AVERAGE", 1, &nOvrFactor, 0, nullptr,
+                                       nullptr, nullptr, nullptr),
+                  CE_None);
+    }
+
+    auto poRefDS = std::unique_ptr<GDALDataset>(
+        GDALDataset::Open(pszFilename, GDAL_OF_RASTER));
+    ASSERT_TRUE(poRefDS != nullptr);
+    std::vector<GUInt16> anRef(N * N);
+    ASSERT_EQ(poRefDS->GetRasterBand(1)->RasterIO(GF_Read, 0, 0, N, N,
+                                                  anRef.data(), N, N,
+                                                  GDT_UInt16, 0, 0, nullptr),
+              CE_None);
+    std::vector<GUInt16> anRefOvr(N * N / 4);
+    ASSERT_EQ(poRefDS->GetRasterBand(1)->GetOverview(0)->RasterIO(
+                  GF_Read, 0, 0, N / 2, N / 2, anRefOvr.data(), N / 2, N / 2,
+                  GDT_UInt16, 0, 0, nullptr),
+              CE_None);
+    std::vector<GUInt16> anRefSubsampled(N * N / 16);
+    ASSERT_EQ(poRefDS->GetRasterBand(1)->RasterIO(
+                  GF_Read, 0, 0, N, N, anRefSubsampled.data(), N / 4, N / 4,
+                  GDT_UInt16, 0, 0, nullptr),
+              CE_None);
+
+    auto poDS = std::unique_ptr<GDALDataset>(GDALDataset::Open(
+        pszFilename, GDAL_OF_RASTER | GDAL_OF_THREAD_SAFE));
+    ASSERT_TRUE(poDS != nullptr);
+    EXPECT_EQ(poDS->GetRasterXSize(), N);
+    EXPECT_EQ(poDS->GetRasterCount(), 2);
+    EXPECT_STREQ(poDS->GetDriverName(), "GTiff");
+    auto poBand = poDS->GetRasterBand(1);
+    EXPECT_EQ(poBand->GetRasterDataType(), GDT_UInt16);
+    EXPECT_EQ(poBand->GetOverviewCount(), 1);
+    EXPECT_EQ(poDS->GetRasterBand(2)->GetMaskFlags(), GMF_NODATA);
+
+    std::atomic<int> nErrors{0};
+    const auto ThreadFunc = [poBand, &anRef, &anRefOvr, &anRefSubsampled,
+                             &nErrors](int iThread)
+    {
+        std::vector<GUInt16> anBuf(N * N);
+        for (int iIter = 0; iIter < 20; ++iIter)
+        {
+            const int nXOff = (iThread * 7 + iIter * 13) % (N / 2);
+            const int nYOff = (iThread * 11 + iIter * 3) % (N / 2);
+            const int nXSize = N / 2;
+            const int nYSize = N / 2;
+            if (poBand->RasterIO(GF_Read, nXOff, nYOff, nXSize, nYSize,
+                                 anBuf.data(), nXSize, nYSize, GDT_UInt16, 0,
+                                 0, nullptr) != CE_None)
+            {
+                ++nErrors;
+                continue;
+            }
+            for (int iY = 0; iY < nYSize; ++iY)
+            {
+                if (memcmp(anBuf.data() + iY * nXSize,
+                           anRef.data() + (nYOff + iY) * N + nXOff,
+                           nXSize * sizeof(GUInt16)) != 0)
+                {
+                    ++nErrors;
+                    break;
+                }
+            }
+
+            if (poBand->GetOverview(0)->RasterIO(
+                    GF_Read, 0, 0, N / 2, N / 2, anBuf.data(), N / 2, N / 2,
+                    GDT_UInt16, 0, 0, nullptr) != CE_None ||
+                memcmp(anBuf.data(), anRefOvr.data(),
+                       anRefOvr.size() * sizeof(GUInt16)) != 0)
+            {
+                ++nErrors;
+            }
+
+            if (poBand->RasterIO(GF_Read, 0, 0, N, N, anBuf.data(), N / 4,
+                                 N / 4, GDT_UInt16, 0, 0, nullptr) != CE_None ||
+                memcmp(anBuf.data(), anRefSubsampled.data(),
+                       anRefSubsampled.size() * sizeof(GUInt16)) != 0)
+            {
+                ++nErrors;
+            }
+
+            GDALRasterBlock::FlushCacheBlock();
+        }
+    };
+    std::vector<std::thread> aoThreads;
+    for (int i = 0; i < 8; ++i)
+        aoThreads.emplace_back(ThreadFunc, i);
+    for (auto &oThread : aoThreads)
+        oThread.join();
+    EXPECT_EQ(nErrors.load(), 0);
+
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    EXPECT_NE(poBand->Fill(0), CE_None);
+    EXPECT_TRUE(GDALDataset::Open(pszFilename, GDAL_OF_RASTER |
+                                                   GDAL_OF_UPDATE |
+                                                   GDAL_OF_THREAD_SAFE) ==
+                nullptr);
+    EXPECT_TRUE(GDALDataset::Open(pszFilename, GDAL_OF_VECTOR |
+                                                   GDAL_OF_THREAD_SAFE) ==
+                nullptr);
+    CPLPopErrorHandler();
+
+    poDS.reset();
+    poRefDS.reset();
+    VSIUnlink(pszFilename);
+}
+
+// Test GDALOpenInfo::HasSiblingFile() and the directory listing cache
+TEST_F(test_gdal, GDALOpenInfo_sibling_files_cache)
+{
+    const std::string osDir("/vsimem/test_sibling_files_cache");
+    const auto CreateEmptyFile = [&osDir](const char *pszName)
+    {
+        VSILFILE *fp = VSIFOpenL((osDir + '/' + pszName).c_str(), "wb");
+        ASSERT_TRUE(fp != nullptr);
+        VSIFCloseL(fp);
+    };
+    VSIMkdir(osDir.c_str(), 0755);
+    CreateEmptyFile("a.bin");
+    CreateEmptyFile("b.bin");
+
+    CPLConfigOptionSetter oSetter("GDAL_READDIR_CACHE_TTL_ON_OPEN", "60",
+                                  false);
+    const std::string osFilename(osDir + "/a.bin");
+    {
+        GDALOpenInfo oOpenInfo(osFilename.c_str(), GA_ReadOnly);
+        EXPECT_TRUE(oOpenInfo.HasSiblingFile("a.bin"));
+        EXPECT_TRUE(oOpenInfo.HasSiblingFile("B.BIN"));
+        EXPECT_FALSE(oOpenInfo.HasSiblingFile("c.bin"));
+        EXPECT_EQ(CSLCount(oOpenInfo.GetSiblingFiles()), 2);
+    }
+
+    // The listing is cached
+    auto poListing = VSIReadDirCached(osDir.c_str(), 1000, 60);
+    EXPECT_EQ(VSIReadDirCached(osDir.c_str(), 1000, 60), poListing);
+    EXPECT_NE(VSIReadDirCached(osDir.c_str(), 1000, 0), poListing);
+
+    // and invalidated when creating a file in the directory
+    CreateEmptyFile("c.bin");
+    EXPECT_NE(VSIReadDirCached(osDir.c_str(), 1000, 60), poListing);
+    {
+        GDALOpenInfo oOpenInfo(osFilename.c_str(), GA_ReadOnly);
+        EXPECT_TRUE(oOpenInfo.HasSiblingFile("c.bin"));
+    }
+
+    // or removing one
+    VSIUnlink((osDir + "/b.bin").c_str());
+    {
+        GDALOpenInfo oOpenInfo(osFilename.c_str(), GA_ReadOnly);
+        EXPECT_FALSE(oOpenInfo.HasSiblingFile("b.bin"));
+        EXPECT_TRUE(oOpenInfo.HasSiblingFile("c.bin"));
+    }
+
+    // Sibling files provided by the caller
+    {
+        const char *const apszSiblings[] = {"a.bin", "x.bin", nullptr};
+        GDALOpenInfo oOpenInfo(osFilename.c_str(), GA_ReadOnly, apszSiblings);
+        EXPECT_TRUE(oOpenInfo.HasSiblingFile("X.bin"));
+        EXPECT_FALSE(oOpenInfo.HasSiblingFile("c.bin"));
+    }
+
+    VSIRmdirRecursive(osDir.c_str());
+}
+
+// Test that GDALOpenEx() skips drivers whose declared signatures don't match
+TEST_F(test_gdal, GDALOpenEx_driver_signatures)
+{
+    static int nIdentifyCallsSig = 0;
+    static int nIdentifyCallsNoSig = 0;
+    const auto Open = [](GDALOpenInfo *) -> GDALDataset *
+    {
+        return GetGDALDriverManager()->GetDriverByName("MEM")->Create(
+            "", 1, 1, 1, GDT_Byte, nullptr);
+    };
+
+    auto poDriverSig = new GDALDriver();
+    poDriverSig->SetDescription("TEST_SIG");
+    poDriverSig->SetMetadataItem(GDAL_DCAP_RASTER, "YES");
+    poDriverSig->SetMetadataItem(GDAL_DMD_IDENTIFY_SIGNATURES,
+                                 "ext:testsig magic:0:54455354");
+    poDriverSig->pfnIdentify = [](GDALOpenInfo *poOpenInfo)
+    {
+        nIdentifyCallsSig++;
+        return static_cast<int>(
+            EQUAL(CPLGetExtension(poOpenInfo->pszFilename), "testsig") ||
+            (poOpenInfo->nHeaderBytes >= 4 &&
+             memcmp(poOpenInfo->pabyHeader, "TEST", 4) == 0));
+    };
+    poDriverSig->pfnOpen = Open;
+    GetGDALDriverManager()->RegisterDriver(poDriverSig);
+
+    auto poDriverNoSig = new GDALDriver();
+    poDriverNoSig->SetDescription("TEST_NO_SIG");
+    poDriverNoSig->SetMetadataItem(GDAL_DCAP_RASTER, "YES");
+    poDriverNoSig->pfnIdentify = [](GDALOpenInfo *)
+    {
+        nIdentifyCallsNoSig++;
+        return TRUE;
+    };
+    poDriverNoSig->pfnOpen = Open;
+    GetGDALDriverManager()->RegisterDriver(poDriverNoSig);
+
+    const char *const apszAllowedDrivers[] = {"TEST_SIG", "TEST_NO_SIG",
+                                              nullptr};
+    const auto OpenWith = [&apszAllowedDrivers](const char *pszFilename)
+    {
+        return std::unique_ptr<GDALDataset>(GDALDataset::Open(
+            pszFilename, GDAL_OF_RASTER, apszAllowedDrivers));
+    };
+
+    // Matching extension
+    EXPECT_TRUE(OpenWith("/vsimem/i_do_not_exist.testsig") != nullptr);
+    EXPECT_EQ(nIdentifyCallsSig, 1);
+    EXPECT_EQ(nIdentifyCallsNoSig, 0);
+
+    // Matching magic bytes
+    VSILFILE *fp = VSIFOpenL("/vsimem/test_sig.bin", "wb");
+    ASSERT_TRUE(fp != nullptr);
+    VSIFWriteL("TEST", 1, 4, fp);
+    VSIFCloseL(fp);
+    EXPECT_TRUE(OpenWith("/vsimem/test_sig.bin") != nullptr);
+    EXPECT_EQ(nIdentifyCallsSig, 2);
+    EXPECT_EQ(nIdentifyCallsNoSig, 0);
+    VSIUnlink("/vsimem/test_sig.bin");
+
+    // No match: TEST_SIG is skipped
+    EXPECT_TRUE(OpenWith("/vsimem/i_do_not_exist.other") != nullptr);
+    EXPECT_EQ(nIdentifyCallsSig, 2);
+    EXPECT_EQ(nIdentifyCallsNoSig, 1);
+
+    // unless disabled
+    {
+        CPLConfigOptionSetter oSetter("GDAL_OPEN_USE_DRIVER_SIGNATURES", "NO",
+                                      false);
+        EXPECT_TRUE(OpenWith("/vsimem/i_do_not_exist.other") != nullptr);
+        EXPECT_EQ(nIdentifyCallsSig, 3);
+        EXPECT_EQ(nIdentifyCallsNoSig, 2);
+    }
+
+    // Skipped drivers are still probed as a fallback
+    {
+        const char *const apszOnlySig[] = {"TEST_SIG", nullptr};
+        EXPECT_TRUE(std::unique_ptr<GDALDataset>(GDALDataset::Open(
+                        "/vsimem/i_do_not_exist.other", GDAL_OF_RASTER,
+                        apszOnlySig)) == nullptr);
+        EXPECT_EQ(nIdentifyCallsSig, 4);
+    }
+
+    GetGDALDriverManager()->DeregisterDriver(poDriverSig);
+    delete poDriverSig;
+    GetGDALDriverManager()->DeregisterDriver(poDriverNoSig);
+    delete poDriverNoSig;
+}
+
+// Test GDALMDArray::GetElementWise(), GetWhere(), GetCast() and GetReduced()
+TEST_F(test_gdal, GDALMDArray_expression)
+{
+    auto poDrv = GetGDALDriverManager()->GetDriverByName("MEM");
+    ASSERT_TRUE(poDrv != nullptr);
+    auto poDS = std::unique_ptr<GDALDataset>(
+        poDrv->CreateMultiDimensional("", nullptr, nullptr));
+    ASSERT_TRUE(poDS != nullptr);
+    auto poRG = poDS->GetRootGroup();
+    auto poDimY = poRG->CreateDimension("y", std::string(), std::string(), 2);
+    auto poDimX = poRG->CreateDimension("x", std::string(), std::string(), 3);
+    const auto dtFloat64 = GDALExtendedDataType::Create(GDT_Float64);
+    auto poA = poRG->CreateMDArray("a", {poDimY, poDimX},
+                                   GDALExtendedDataType::Create(GDT_Int16));
+    auto poB = poRG->CreateMDArray("b", {poDimY, poDimX}, dtFloat64);
+    ASSERT_TRUE(poA != nullptr);
+    ASSERT_TRUE(poB != nullptr);
+    const GUInt64 anStart[] = {0, 0};
+    const size_t anCount[] = {2, 3};
+    const double adfA[] = {1, 2, 3, 4, -9999, 6};
+    const double adfB[] = {10, 20, 30, 40, 50, 60};
+    ASSERT_TRUE(
+        poA->Write(anStart, anCount, nullptr, nullptr, dtFloat64, adfA));
+    ASSERT_TRUE(
+        poB->Write(anStart, anCount, nullptr, nullptr, dtFloat64, adfB));
+    ASSERT_TRUE(poA->SetNoDataValue(-9999.0));
+
+    const auto Read = [&dtFloat64](const std::shared_ptr<GDALMDArray> &poAr)
+    {
+        std::vector<double> adfRes(
+            static_cast<size_t>(poAr->GetTotalElementsCount()));
+        std::vector<GUInt64> anArStart(poAr->GetDimensionCount());
+        std::vector<size_t> anArCount;
+        for (const auto &poDim : poAr->GetDimensions())
+            anArCount.push_back(static_cast<size_t>(poDim->GetSize()));
+        EXPECT_TRUE(poAr->Read(anArStart.data(), anArCount.data(), nullptr,
+                               nullptr, dtFloat64, adfRes.data()));
+        return adfRes;
+    };
+
+    // (a + b) * 2 - 1, fused in a single expression
+    auto poExpr = poA->GetElementWise(GDALMDArrayOperator::ADD, poB)
+                      ->GetElementWise(GDALMDArrayOperator::MULTIPLY, 2.0)
+                      ->GetElementWise(GDALMDArrayOperator::SUBTRACT, 1.0);
+    ASSERT_TRUE(poExpr != nullptr);
+    EXPECT_EQ(poExpr->GetDataType().GetNumericDataType(), GDT_Float64);
+    auto adfRes = Read(poExpr);
+    EXPECT_EQ(adfRes[0], 21);
+    EXPECT_EQ(adfRes[3], 87);
+    EXPECT_TRUE(std::isnan(adfRes[4]));
+    EXPECT_EQ(adfRes[5], 131);
+
+    // Read through a view, with a step
+    auto poView = poExpr->GetView("[1,::-2]");
+    ASSERT_TRUE(poView != nullptr);
+    adfRes = Read(poView);
+    ASSERT_EQ(adfRes.size(), 2U);
+    EXPECT_EQ(adfRes[0], 131);
+    EXPECT_EQ(adfRes[1], 87);
+
+    // Constant as first operand and unary operator
+    adfRes = Read(poA->GetElementWise(GDALMDArrayOperator::DIVIDE, 12.0, true)
+                      ->GetElementWise(GDALMDArrayOperator::NEGATE));
+    EXPECT_EQ(adfRes[0], -12);
+    EXPECT_EQ(adfRes[2], -4);
+
+    // Where
+    auto poCond = poB->GetElementWise(GDALMDArrayOperator::GREATER, 25.0);
+    adfRes = Read(poA->GetWhere(poCond, poB));
+    EXPECT_EQ(adfRes[0], 10);
+    EXPECT_EQ(adfRes[1], 20);
+    EXPECT_EQ(adfRes[2], 3);
+    EXPECT_TRUE(std::isnan(adfRes[4]));
+    adfRes = Read(poB->GetWhere(poCond));
+    EXPECT_TRUE(std::isnan(adfRes[0]));
+    EXPECT_EQ(adfRes[5], 60);
+
+    // Cast
+    auto poCast = poB->GetElementWise(GDALMDArrayOperator::MULTIPLY, 10.0)
+                      ->GetCast(GDT_Byte);
+    ASSERT_TRUE(poCast != nullptr);
+    EXPECT_EQ(poCast->GetDataType().GetNumericDataType(), GDT_Byte);
+    adfRes = Read(poCast);
+    EXPECT_EQ(adfRes[0], 100);
+    EXPECT_EQ(adfRes[5], 255);
+
+    // Reductions
+    adfRes = Read(poA->GetReduced(GDALMDArrayReduction::SUM, 0));
+    ASSERT_EQ(adfRes.size(), 3U);
+    EXPECT_EQ(adfRes[0], 5);
+    EXPECT_EQ(adfRes[1], 2);
+    EXPECT_EQ(adfRes[2], 9);
+    adfRes = Read(poA->GetReduced(GDALMDArrayReduction::MEAN, 1));
+    ASSERT_EQ(adfRes.size(), 2U);
+    EXPECT_EQ(adfRes[0], 2);
+    EXPECT_EQ(adfRes[1], 5);
+    adfRes = Read(poA->GetReduced(GDALMDArrayReduction::COUNT, 1));
+    EXPECT_EQ(adfRes[1], 2);
+    adfRes = Read(poB->GetReduced(GDALMDArrayReduction::MAX, 1)
+                      ->GetReduced(GDALMDArrayReduction::MIN, 0));
+    ASSERT_EQ(adfRes.size(), 1U);
+    EXPECT_EQ(adfRes[0], 30);
+
+    // Errors
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    auto poMean = poB->GetReduced(GDALMDArrayReduction::MEAN, 0);
+    EXPECT_TRUE(poB->GetElementWise(GDALMDArrayOperator::SUBTRACT, poMean) ==
+                nullptr);
+    EXPECT_TRUE(poB->GetElementWise(GDALMDArrayOperator::ADD) == nullptr);
+    EXPECT_TRUE(poB->GetElementWise(GDALMDArrayOperator::ABS, poB) == nullptr);
+    EXPECT_TRUE(poB->GetReduced(GDALMDArrayReduction::SUM, 2) == nullptr);
+    CPLPopErrorHandler();
+
+    // Multi-threaded evaluation
+    {
+        CPLConfigOptionSetter oSetter("GDAL_NUM_THREADS", "4", false);
+        auto poDimBig =
+            poRG->CreateDimension("big", std::string(), std::string(), 300000);
+        auto poBig = poRG->CreateMDArray("big", {poDimBig}, dtFloat64);
+        ASSERT_TRUE(poBig != nullptr);
+        std::vector<double> adfBig(300000);
+        for (size_t i = 0; i < adfBig.size(); ++i)
+            adfBig[i] = static_cast<double>(i);
+        const GUInt64 nBigStart = 0;
+        const size_t nBigCount = adfBig.size();
+        ASSERT_TRUE(poBig->Write(&nBigStart, &nBigCount, nullptr, nullptr,
+                                 dtFloat64, adfBig.data()));
+        adfRes =
+            Read(poBig->GetElementWise(GDALMDArrayOperator::MULTIPLY, poBig));
+        ASSERT_EQ(adfRes.size(), adfBig.size());
+        bool bOK = true;
+        for (size_t i = 0; i < adfBig.size(); ++i)
+            bOK &= adfRes[i] == adfBig[i] * adfBig[i];
+        EXPECT_TRUE(bOK);
+        adfRes = Read(poBig->GetReduced(GDALMDArrayReduction::SUM, 0));
+        EXPECT_EQ(adfRes[0], 299999.0 * 300000 / 2);
+    }
+}
+
+// Test MEM dataset creation with MEM_FIRST_TOUCH=PARALLEL
+TEST_F(test_gdal, MEM_FIRST_TOUCH_PARALLEL)
+{
+    CPLConfigOptionSetter oSetterFirstTouch("MEM_FIRST_TOUCH", "PARALLEL",
+                                            false);
+    CPLConfigOptionSetter oSetterNumThreads("GDAL_NUM_THREADS", "4", false);
+    constexpr int SIZE = 3000;
+    GDALDatasetUniquePtr poDS(
+        GDALDriver::FromHandle(GDALGetDriverByName("MEM"))
+            ->Create("", SIZE, SIZE, 2, GDT_Byte, nullptr));
+    ASSERT_TRUE(poDS != nullptr);
+
+    std::vector<GByte> abyBuffer(static_cast<size_t>(SIZE) * SIZE * 2, 0xFF);
+    ASSERT_EQ(poDS->RasterIO(GF_Read, 0, 0, SIZE, SIZE, abyBuffer.data(), SIZE,
+                             SIZE, GDT_Byte, 2, nullptr, 0, 0, 0, nullptr),
+              CE_None);
+    EXPECT_EQ(std::count(abyBuffer.begin(), abyBuffer.end(), 0),
+              static_cast<ptrdiff_t>(abyBuffer.size()));
+
+    for (size_t i = 0; i < abyBuffer.size(); ++i)
+        abyBuffer[i] = static_cast<GByte>(i % 251);
+    ASSERT_EQ(poDS->RasterIO(GF_Write, 0, 0, SIZE, SIZE, abyBuffer.data(),
+                             SIZE, SIZE, GDT_Byte, 2, nullptr, 0, 0, 0,
+                             nullptr),
+              CE_None);
+    std::vector<GByte> abyBuffer2(abyBuffer.size());
+    ASSERT_EQ(poDS->RasterIO(GF_Read, 0, 0, SIZE, SIZE, abyBuffer2.data(),
+                             SIZE, SIZE, GDT_Byte, 2, nullptr, 0, 0, 0,
+                             nullptr),
+              CE_None);
+    EXPECT_TRUE(abyBuffer == abyBuffer2);
+}
+
 }  // namespace
@@ -28,6 +28,7 @@
 
 #include "gdal_unit_test.h"
 
+#include "ogr_geometry.h"
 #include "ogr_p.h"
 #include "ogrsf_frmts.h"
 #include "../../ogr/ogrsf_frmts/osm/gpb.h"
@@ -35,7 +36,13 @@
 
 #include <string>
 #include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <fstream>
+#include <iomanip>
+#include <limits>
+#include <locale>
+#include <sstream>
 
 #ifdef HAVE_SQLITE3
 #include <sqlite3.h>
@@ -3362,4 +3369,256 @@ TEST_F(test_ogr, OGRFeatureDefn_sealing)
     }
 }
 
+// Test OGRLayer::GetNextFeatureBatch()
+TEST_F(test_ogr, GetNextFeatureBatch)
+{
+    auto poDS = std::unique_ptr<GDALDataset>(
+        GetGDALDriverManager()->GetDriverByName("Memory")->Create(
+            "", 0, 0, 0, GDT_Unknown, nullptr));
+    auto poLayer = poDS->CreateLayer("test", nullptr, wkbPoint, nullptr);
+    OGRFieldDefn oFieldDefn("str", OFTString);
+    poLayer->CreateField(&oFieldDefn);
+    const char *const apszValues[] = {"long_value", "short", nullptr, "x",
+                                      "even_longer_value"};
+    for (int i = 0; i < 5; ++i)
+    {
+        OGRFeature oFeature(poLayer->GetLayerDefn());
+        if (apszValues[i])
+            oFeature.SetField(0, apszValues[i]);
+        OGRPoint oPoint(i, -i);
+        if (i != 3)
+            oFeature.SetGeometry(&oPoint);
+        poLayer->CreateFeature(&oFeature);
+    }
+
+    OGRFeatureBatch oBatch;
+    int iFeature = 0;
+    int nBatches = 0;
+    while (const int nCount = poLayer->GetNextFeatureBatch(oBatch, 2))
+    {
+        ++nBatches;
+        ASSERT_EQ(nCount, oBatch.GetFeatureCount());
+        for (int i = 0; i < nCount; ++i, ++iFeature)
+        {
+            const OGRFeature *poFeature = oBatch.GetFeature(i);
+            EXPECT_EQ(poFeature->GetFID(), iFeature);
+            if (apszValues[iFeature])
+                EXPECT_STREQ(poFeature->GetFieldAsString(0),
+                             apszValues[iFeature]);
+            else
+                EXPECT_FALSE(poFeature->IsFieldSetAndNotNull(0));
+            const OGRGeometry *poGeom = poFeature->GetGeometryRef();
+            if (iFeature == 3)
+            {
+                EXPECT_EQ(poGeom, nullptr);
+            }
+            else
+            {
+                ASSERT_NE(poGeom, nullptr);
+                EXPECT_EQ(poGeom->toPoint()->getX(), iFeature);
+                EXPECT_EQ(poGeom->toPoint()->getY(), -iFeature);
+            }
+        }
+    }
+    EXPECT_EQ(nBatches, 3);
+    EXPECT_EQ(iFeature, 5);
+
+    // Features stolen from the batch survive its recycling
+    poLayer->ResetReading();
+    ASSERT_EQ(poLayer->GetNextFeatureBatch(oBatch, 1), 1);
+    auto poStolen = oBatch.StealFeature(0);
+    ASSERT_EQ(poLayer->GetNextFeatureBatch(oBatch, 1), 1);
+    EXPECT_STREQ(poStolen->GetFieldAsString(0), "long_value");
+    EXPECT_STREQ(oBatch.GetFeature(0)->GetFieldAsString(0), "short");
+}
+
+// Test OGRGeometryFactory::validateGeometries() and makeValidGeometries()
+TEST_F(test_ogr, validateGeometries)
+{
+    if (!OGRGeometryFactory::haveGEOS())
+    {
+        GTEST_SKIP() << "GEOS missing";
+    }
+
+    // Enough geometries to trigger multithreading
+    std::vector<std::unique_ptr<OGRGeometry>> apoGeoms;
+    for (int i = 0; i < 1000; ++i)
+    {
+        OGRGeometry *poGeom = nullptr;
+        const std::string osWKT =
+            (i % 3) == 0 ? std::string("POLYGON ((0 0,1 1,0 1,1 0,0 0))")
+            : (i % 3) == 1
+                ? std::string("POLYGON ((0 0,0 1,1 1,1 0,0 0))")
+                : std::string();
+        if (!osWKT.empty())
+            OGRGeometryFactory::createFromWkt(osWKT.c_str(), nullptr, &poGeom);
+        apoGeoms.emplace_back(poGeom);
+    }
+    std::vector<const OGRGeometry *> apoGeomsRaw;
+    for (const auto &poGeom : apoGeoms)
+        apoGeomsRaw.push_back(poGeom.get());
+
+    std::vector<GByte> abyValid(apoGeoms.size());
+    std::vector<std::string> aosReasons;
+    const char *const apszOptions[] = {"NUM_THREADS=4", nullptr};
+    ASSERT_TRUE(OGRGeometryFactory::validateGeometries(
+        apoGeomsRaw.data(), apoGeomsRaw.size(), abyValid.data(), &aosReasons,
+        apszOptions));
+    ASSERT_EQ(aosReasons.size(), apoGeoms.size());
+    for (size_t i = 0; i < apoGeoms.size(); ++i)
+    {
+        EXPECT_EQ(abyValid[i], (i % 3) == 0 ? 0 : 1);
+        EXPECT_EQ(aosReasons[i].empty(), (i % 3) != 0);
+    }
+
+    auto apoValid = OGRGeometryFactory::makeValidGeometries(
+        apoGeomsRaw.data(), apoGeomsRaw.size(), apszOptions);
+    ASSERT_EQ(apoValid.size(), apoGeoms.size());
+    for (size_t i = 0; i < apoGeoms.size(); ++i)
+    {
+        if ((i % 3) == 2)
+        {
+            EXPECT_EQ(apoValid[i], nullptr);
+        }
+        else
+        {
+            ASSERT_NE(apoValid[i], nullptr);
+            EXPECT_TRUE(apoValid[i]->IsValid());
+            EXPECT_NEAR(OGR_G_Area(OGRGeometry::ToHandle(apoValid[i].get())),
+                        (i % 3) == 0 ? 0.5 : 1.0, 1e-10);
+        }
+    }
+}
+
+// Test OGRFeatureDefn::GetFieldIndex() on a sealed object with many fields
+TEST_F(test_ogr, OGRFeatureDefn_GetFieldIndex_many_fields)
+{
+    OGRFeatureDefn *poFDefn = new OGRFeatureDefn();
+    poFDefn->Reference();
+    for (int i = 0; i < 100; ++i)
+    {
+        OGRFieldDefn oFieldDefn(CPLSPrintf("Field%d", i), OFTString);
+        poFDefn->AddFieldDefn(&oFieldDefn);
+    }
+    {
+        OGRFieldDefn oFieldDefn("field50", OFTString);
+        poFDefn->AddFieldDefn(&oFieldDefn);
+    }
+    poFDefn->Seal(true);
+
+    for (int iPass = 0; iPass < 2; ++iPass)
+    {
+        EXPECT_EQ(poFDefn->GetFieldIndex("Field0"), 0);
+        EXPECT_EQ(poFDefn->GetFieldIndex("FIELD99"), 99);
+        EXPECT_EQ(poFDefn->GetFieldIndex("field50"), 50);
+        EXPECT_EQ(poFDefn->GetFieldIndex("Field100"), -1);
+        EXPECT_EQ(poFDefn->GetFieldIndexCaseSensitive("field50"), 100);
+    }
+
+    {
+        auto oTemporaryUnsealer(poFDefn->GetTemporaryUnsealer());
+        poFDefn->DeleteFieldDefn(0);
+        poFDefn->GetFieldDefn(0)->SetName("renamed");
+        EXPECT_EQ(poFDefn->GetFieldIndex("renamed"), 0);
+    }
+
+    EXPECT_EQ(poFDefn->GetFieldIndex("Field0"), -1);
+    EXPECT_EQ(poFDefn->GetFieldIndex("Field1"), -1);
+    EXPECT_EQ(poFDefn->GetFieldIndex("renamed"), 0);
+    EXPECT_EQ(poFDefn->GetFieldIndex("Field99"), 98);
+
+    poFDefn->Release();
+}
+
+// Reference implementation of OGRFormatDouble() (without rounding) as it was
+// before it switched to std::to_chars() / CPLsnprintf()
+static std::string OGRFormatDoubleLegacy(double val, const OGRWktOptions &opts)
+{
+    std::ostringstream oss;
+    oss.imbue(std::locale::classic());
+    if (opts.format == OGRWktFormat::F ||
+        (opts.format == OGRWktFormat::Default && fabs(val) < 1))
+        oss << std::fixed;
+    else
+        oss << std::uppercase;
+    oss << std::setprecision(opts.precision);
+    oss << val;
+    std::string s = oss.str();
+
+    // Same trailing zero removal as OGRFormatDouble()
+    if (s.find('.') == std::string::npos)
+        return s;
+    s = s.substr(0, s.find_last_not_of('0') + 1);
+    if (s.back() == '.')
+        s += '0';
+    return s;
+}
+
+// Test that OGRFormatDouble() output is unchanged by its fast path
+TEST_F(test_ogr, OGRFormatDouble_same_as_legacy)
+{
+    const double adfValues[] = {
+        0.0,
+        -0.0,
+        1.0,
+        -1.0,
+        0.5,
+        0.05,
+        0.95,
+        9.5,
+        9.96,
+        99.95,
+        0.99999999999999994,
+        999999.5,
+        1e15,
+        123456789.123456789,
+        M_PI,
+        1.0 / 3,
+        -2.0 / 3,
+        // Subnormals and smallest normal
+        std::numeric_limits<double>::denorm_min(),
+        2.2250738585072009e-308,
+        -1e-310,
+        DBL_MIN,
+        // Large exponents (too long for the fast path in F mode)
+        1e22,
+        9.9999999999999999e22,
+        1e300,
+        -1.5e-300,
+        DBL_MAX,
+        -DBL_MAX,
+    };
+    for (const double dfVal : adfValues)
+    {
+        for (const int nPrecision : {0, 1, 15, 17})
+        {
+            for (const auto eFormat : {OGRWktFormat::F, OGRWktFormat::G,
+                                       OGRWktFormat::Default})
+            {
+                OGRWktOptions opts;
+                opts.precision = nPrecision;
+                opts.round = false;
+                opts.format = eFormat;
+                EXPECT_EQ(OGRFormatDouble(dfVal, opts),
+                          OGRFormatDoubleLegacy(dfVal, opts))
+                    << "value=" << dfVal << ", precision=" << nPrecision
+                    << ", format=" << static_cast<int>(eFormat);
+            }
+        }
+    }
+
+    OGRWktOptions opts;
+    opts.round = false;
+    opts.format = OGRWktFormat::F;
+    opts.precision = 15;
+    EXPECT_EQ(OGRFormatDouble(-0.0, opts), "-0.0");
+    opts.precision = 1;
+    EXPECT_EQ(OGRFormatDouble(9.96, opts), "10.0");
+    opts.format = OGRWktFormat::G;
+    EXPECT_EQ(OGRFormatDouble(9.6, opts), "1E+01");
+    opts.precision = 15;
+    EXPECT_EQ(OGRFormatDouble(-0.0, opts), "-0");
+    EXPECT_EQ(OGRFormatDouble(1e300, opts), "1E+300");
+}
+
 }  // namespace
@@ -268,3 +268,50 @@ TEST_P(OrganizePolygonsTest, CrossingCCWPolygons)
                 "((5 5, 15 5, 15 15, 5 15, 5 5)))"));
     ASSERT_TRUE(result->Equals(expected.get()));
 }
+
+TEST_P(OrganizePolygonsTest, ManyIslandsWithLakes)
+{
+    // Enough rings to trigger the use of a spatial index
+    constexpr int N = 12;
+    std::vector<OGRGeometry *> polygons;
+    polygons.push_back(readWKT(
+        "POLYGON ((0 0, 0 1000, 1000 1000, 1000 0, 0 0))"));  // CW
+    for (int i = 0; i < N; ++i)
+    {
+        for (int j = 0; j < N; ++j)
+        {
+            const double x = 10 + i * 50;
+            const double y = 10 + j * 50;
+            // CCW lake
+            polygons.push_back(readWKT(CPLSPrintf(
+                "POLYGON ((%g %g, %g %g, %g %g, %g %g, %g %g))", x, y, x + 40,
+                y, x + 40, y + 40, x, y + 40, x, y)));
+            // CW island in the lake
+            polygons.push_back(readWKT(CPLSPrintf(
+                "POLYGON ((%g %g, %g %g, %g %g, %g %g, %g %g))", x + 10,
+                y + 10, x + 10, y + 30, x + 30, y + 30, x + 30, y + 10, x + 10,
+                y + 10)));
+        }
+    }
+
+    const auto &method = GetParam();
+    CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+    auto result = organizePolygons(polygons, method);
+
+    ASSERT_NE(result, nullptr);
+    ASSERT_EQ(result->getGeometryType(), wkbMultiPolygon);
+    auto poMP = result->toMultiPolygon();
+    if (method != "SKIP")
+    {
+        ASSERT_EQ(poMP->getNumGeometries(), 1 + N * N);
+        EXPECT_EQ(poMP->getGeometryRef(0)->getNumInteriorRings(), N * N);
+        for (int i = 1; i <= N * N; ++i)
+        {
+            EXPECT_EQ(poMP->getGeometryRef(i)->getNumInteriorRings(), 0);
+        }
+    }
+    else
+    {
+        EXPECT_EQ(poMP->getNumGeometries(), 1 + 2 * N * N);
+    }
+}
@@ -524,4 +524,245 @@ INSTANTIATE_TEST_SUITE_P(
         OGRWKBIntersectsPessimisticFixture::ParamType> &l_info)
     { return std::get<6>(l_info.param); });
 
+class OGRWKBGetAreaAndLengthFixture
+    : public test_ogr_wkb,
+      public ::testing::WithParamInterface<
+          std::tuple<const char *, bool, const char *>>
+{
+  public:
+    static std::vector<std::tuple<const char *, bool, const char *>>
+    GetTupleValues()
+    {
+        return {
+            std::make_tuple("POINT(1 2)", true, "POINT"),
+            std::make_tuple("POINT EMPTY", true, "POINT_EMPTY"),
+            std::make_tuple("LINESTRING(1 2,4 6,4 7)", true, "LINESTRING"),
+            std::make_tuple("LINESTRING ZM (1 2 3 4,4 6 7 8)", true,
+                            "LINESTRINGZM"),
+            std::make_tuple("LINESTRING EMPTY", true, "LINESTRING_EMPTY"),
+            std::make_tuple("POLYGON((0 0,0 10,10 10,10 0,0 0),"
+                            "(1 1,1 2,2 2,2 1,1 1))",
+                            true, "POLYGON"),
+            std::make_tuple("POLYGON Z ((1e6 1e6 1,1e6 1.00001e6 2,"
+                            "1.00001e6 1.00001e6 3,1e6 1e6 1))",
+                            true, "POLYGONZ"),
+            std::make_tuple("POLYGON EMPTY", true, "POLYGON_EMPTY"),
+            std::make_tuple("TRIANGLE((0 0,0 1,1 0,0 0))", true, "TRIANGLE"),
+            std::make_tuple("MULTIPOINT((1 2),(3 4))", true, "MULTIPOINT"),
+            std::make_tuple("MULTILINESTRING((0 0,1 1),(2 2,2 5))", true,
+                            "MULTILINESTRING"),
+            std::make_tuple("MULTIPOLYGON(((0 0,0 1,1 1,0 0)),"
+                            "((10 10,10 12,12 12,12 10,10 10)))",
+                            true, "MULTIPOLYGON"),
+            std::make_tuple("MULTIPOLYGON M (((0 0 1,0 1 2,1 1 3,0 0 1)))",
+                            true, "MULTIPOLYGONM"),
+            std::make_tuple("GEOMETRYCOLLECTION(POINT(1 2),"
+                            "LINESTRING(0 0,3 4),"
+                            "POLYGON((0 0,0 1,1 1,0 0)),"
+                            "GEOMETRYCOLLECTION(LINESTRING(0 0,0 1)))",
+                            true, "GEOMETRYCOLLECTION"),
+            std::make_tuple("POLYHEDRALSURFACE Z (((0 0 0,0 1 0,1 1 0,0 0 0)),"
+                            "((0 0 1,0 1 1,1 1 1,0 0 1)))",
+                            true, "POLYHEDRALSURFACE"),
+            std::make_tuple("CIRCULARSTRING(0 10,1 11,2 10)", false,
+                            "CIRCULARSTRING"),
+            std::make_tuple("CURVEPOLYGON((0 0,0 1,1 1,0 0))", false,
+                            "CURVEPOLYGON"),
+            std::make_tuple("GEOMETRYCOLLECTION(COMPOUNDCURVE((0 0,1 1)))",
+                            false, "GEOMETRYCOLLECTION_COMPOUNDCURVE"),
+        };
+    }
+};
+
+TEST_P(OGRWKBGetAreaAndLengthFixture, test)
+{
+    const char *pszInput = std::get<0>(GetParam());
+    const bool bExpectedSuccess = std::get<1>(GetParam());
+
+    OGRGeometry *poGeom = nullptr;
+    ASSERT_EQ(OGRGeometryFactory::createFromWkt(pszInput, nullptr, &poGeom),
+              OGRERR_NONE);
+    ASSERT_TRUE(poGeom != nullptr);
+    std::vector<GByte> abyWkb(poGeom->WkbSize());
+    poGeom->exportToWkb(wkbNDR, abyWkb.data(), wkbVariantIso);
+
+    const auto eFlatType = wkbFlatten(poGeom->getGeometryType());
+    double dfExpectedArea = 0;
+    if (OGR_GT_IsSurface(eFlatType))
+        dfExpectedArea = poGeom->toSurface()->get_Area();
+    else if (OGR_GT_IsSubClassOf(eFlatType, wkbGeometryCollection))
+        dfExpectedArea = poGeom->toGeometryCollection()->get_Area();
+    double dfExpectedLength = 0;
+    if (OGR_GT_IsCurve(eFlatType))
+        dfExpectedLength = poGeom->toCurve()->get_Length();
+    else if (OGR_GT_IsSubClassOf(eFlatType, wkbGeometryCollection))
+        dfExpectedLength = poGeom->toGeometryCollection()->get_Length();
+    delete poGeom;
+
+    double dfArea = -1;
+    EXPECT_EQ(OGRWKBGetArea(abyWkb.data(), abyWkb.size(), dfArea),
+              bExpectedSuccess);
+    double dfLength = -1;
+    EXPECT_EQ(OGRWKBGetLength(abyWkb.data(), abyWkb.size(), dfLength),
+              bExpectedSuccess);
+    if (bExpectedSuccess)
+    {
+        EXPECT_NEAR(dfArea, dfExpectedArea, 1e-8 * (1 + dfExpectedArea));
+        EXPECT_NEAR(dfLength, dfExpectedLength,
+                    1e-8 * (1 + dfExpectedLength));
+
+        // Truncated WKB
+        EXPECT_EQ(OGRWKBGetArea(abyWkb.data(), abyWkb.size() - 1, dfArea),
+                  false);
+        EXPECT_EQ(OGRWKBGetLength(abyWkb.data(), abyWkb.size() - 1, dfLength),
+                  false);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    test_ogr_wkb, OGRWKBGetAreaAndLengthFixture,
+    ::testing::ValuesIn(OGRWKBGetAreaAndLengthFixture::GetTupleValues()),
+    [](const ::testing::TestParamInfo<OGRWKBGetAreaAndLengthFixture::ParamType>
+           &l_info) { return std::get<2>(l_info.param); });
+
+static std::vector<GByte> WKTToWKB(const char *pszWKT,
+                                   OGRwkbByteOrder eByteOrder = wkbNDR)
+{
+    OGRGeometry *poGeom = nullptr;
+    OGRGeometryFactory::createFromWkt(pszWKT, nullptr, &poGeom);
+    std::vector<GByte> abyWkb;
+    if (poGeom)
+    {
+        abyWkb.resize(poGeom->WkbSize());
+        poGeom->exportToWkb(eByteOrder, abyWkb.data(), wkbVariantIso);
+        delete poGeom;
+    }
+    return abyWkb;
+}
+
+TEST_F(test_ogr_wkb, OGRWKBGetCentroid)
+{
+    const struct
+    {
+        const char *pszWKT;
+        double dfX;
+        double dfY;
+    } asTests[] = {
+        {"POINT(1 2)", 1, 2},
+        {"MULTIPOINT((0 0),(2 4))", 1, 2},
+        {"LINESTRING(0 0,3 4)", 1.5, 2},
+        {"POLYGON((0 0,0 1,1 1,1 0,0 0),"
+         "(0.2 0.2,0.4 0.2,0.4 0.6,0.2 0.6,0.2 0.2))",
+         0.476 / 0.92, 0.468 / 0.92},
+        // Only components of the highest dimension are considered
+        {"GEOMETRYCOLLECTION(POINT(10 10),LINESTRING(10 10,20 20),"
+         "POLYGON((0 0,0 2,2 2,2 0,0 0)))",
+         1, 1},
+    };
+    for (const auto &sTest : asTests)
+    {
+        for (const auto eByteOrder : {wkbNDR, wkbXDR})
+        {
+            const auto abyWkb = WKTToWKB(sTest.pszWKT, eByteOrder);
+            double dfX = 0, dfY = 0;
+            bool bEmpty = true;
+            EXPECT_TRUE(OGRWKBGetCentroid(abyWkb.data(), abyWkb.size(), dfX,
+                                          dfY, bEmpty))
+                << sTest.pszWKT;
+            EXPECT_FALSE(bEmpty);
+            EXPECT_NEAR(dfX, sTest.dfX, 1e-10) << sTest.pszWKT;
+            EXPECT_NEAR(dfY, sTest.dfY, 1e-10) << sTest.pszWKT;
+        }
+    }
+
+    {
+        const auto abyWkb = WKTToWKB("POINT EMPTY", wkbXDR);
+        double dfX = 0, dfY = 0;
+        bool bEmpty = false;
+        EXPECT_TRUE(
+            OGRWKBGetCentroid(abyWkb.data(), abyWkb.size(), dfX, dfY, bEmpty));
+        EXPECT_TRUE(bEmpty);
+    }
+
+    {
+        const auto abyWkb = WKTToWKB("CIRCULARSTRING(0 0,1 1,2 0)");
+        double dfX = 0, dfY = 0;
+        bool bEmpty = false;
+        EXPECT_FALSE(
+            OGRWKBGetCentroid(abyWkb.data(), abyWkb.size(), dfX, dfY, bEmpty));
+    }
+}
+
+TEST_F(test_ogr_wkb, OGRWKBPointInPolygon)
+{
+    const auto abyWkb = WKTToWKB("MULTIPOLYGON(((0 0,0 1,1 1,1 0,0 0),"
+                                 "(0.2 0.2,0.4 0.2,0.4 0.6,0.2 0.6,0.2 0.2)),"
+                                 "((2 0,2 1,3 1,2 0)))");
+    bool bInside = false;
+    EXPECT_TRUE(
+        OGRWKBPointInPolygon(abyWkb.data(), abyWkb.size(), 0.5, 0.5, bInside));
+    EXPECT_TRUE(bInside);
+    EXPECT_TRUE(
+        OGRWKBPointInPolygon(abyWkb.data(), abyWkb.size(), 0.3, 0.3, bInside));
+    EXPECT_FALSE(bInside);
+    EXPECT_TRUE(
+        OGRWKBPointInPolygon(abyWkb.data(), abyWkb.size(), 2.1, 0.5, bInside));
+    EXPECT_TRUE(bInside);
+    EXPECT_TRUE(
+        OGRWKBPointInPolygon(abyWkb.data(), abyWkb.size(), 2.9, 0.5, bInside));
+    EXPECT_FALSE(bInside);
+    EXPECT_TRUE(
+        OGRWKBPointInPolygon(abyWkb.data(), abyWkb.size(), -1, 0.5, bInside));
+    EXPECT_FALSE(bInside);
+
+    const auto abyWkbLine = WKTToWKB("LINESTRING(0 0,1 1)");
+    EXPECT_FALSE(OGRWKBPointInPolygon(abyWkbLine.data(), abyWkbLine.size(),
+                                      0.5, 0.5, bInside));
+}
+
+TEST_F(test_ogr_wkb, OGRWKBSwapXY)
+{
+    for (const auto eByteOrder : {wkbNDR, wkbXDR})
+    {
+        auto abyWkb = WKTToWKB("GEOMETRYCOLLECTION Z (POINT Z (1 2 3),"
+                               "MULTILINESTRING Z ((4 5 6,7 8 9)))",
+                               eByteOrder);
+        EXPECT_TRUE(OGRWKBSwapXY(abyWkb.data(), abyWkb.size()));
+        EXPECT_EQ(abyWkb, WKTToWKB("GEOMETRYCOLLECTION Z (POINT Z (2 1 3),"
+                                   "MULTILINESTRING Z ((5 4 6,8 7 9)))",
+                                   eByteOrder));
+    }
+}
+
+TEST_F(test_ogr_wkb, OGRWKBForce2D)
+{
+    const struct
+    {
+        const char *pszInput;
+        const char *pszExpected;
+    } asTests[] = {
+        {"POINT ZM (1 2 3 4)", "POINT (1 2)"},
+        {"POINT Z EMPTY", "POINT EMPTY"},
+        {"POLYGON M ((0 0 1,0 1 2,1 1 3,0 0 1))",
+         "POLYGON ((0 0,0 1,1 1,0 0))"},
+        {"MULTICURVE Z (CIRCULARSTRING Z (0 0 1,1 1 2,2 0 3),(0 0 1,1 1 2))",
+         "MULTICURVE (CIRCULARSTRING (0 0,1 1,2 0),(0 0,1 1))"},
+    };
+    for (const auto &sTest : asTests)
+    {
+        for (const auto eByteOrder : {wkbNDR, wkbXDR})
+        {
+            const auto abyWkb = WKTToWKB(sTest.pszInput, eByteOrder);
+            std::vector<GByte> abyOut;
+            EXPECT_TRUE(OGRWKBForce2D(abyWkb.data(), abyWkb.size(), abyOut))
+                << sTest.pszInput;
+            EXPECT_EQ(abyOut, WKTToWKB(sTest.pszExpected, eByteOrder))
+                << sTest.pszInput;
+
+            EXPECT_FALSE(
+                OGRWKBForce2D(abyWkb.data(), abyWkb.size() - 1, abyOut));
+        }
+    }
+}
+
 }  // namespace
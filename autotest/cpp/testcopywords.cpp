@@ -30,8 +30,11 @@
 #include "cpl_conv.h"
 #include "gdal.h"
 
+#include <cmath>
 #include <cstdint>
 #include <iostream>
+#include <limits>
+#include <vector>
 
 #include "gtest_include.h"
 
@@ -1004,4 +1007,63 @@ TEST_F(TestCopyWords, Int16ToInt16)
     }
 }
 
+// Check that packed conversions of floating-point values to integer types
+// give the same result as word-by-word conversions, in particular for
+// rounding, clamping and NaN, whatever the SIMD code path used.
+template <class Tin, class Tout>
+void CheckPackedFloatEdgeCases(GDALDataType eIn, GDALDataType eOut)
+{
+    const Tin aValues[] = {static_cast<Tin>(0.0),
+                           static_cast<Tin>(-0.0),
+                           static_cast<Tin>(0.49),
+                           static_cast<Tin>(0.5),
+                           static_cast<Tin>(-0.5),
+                           static_cast<Tin>(-0.51),
+                           static_cast<Tin>(254.5),
+                           static_cast<Tin>(255.49),
+                           static_cast<Tin>(32766.5),
+                           static_cast<Tin>(-32768.5),
+                           static_cast<Tin>(65534.5),
+                           static_cast<Tin>(1e10),
+                           static_cast<Tin>(-1e10),
+                           std::numeric_limits<Tin>::infinity(),
+                           -std::numeric_limits<Tin>::infinity(),
+                           std::numeric_limits<Tin>::quiet_NaN(),
+                           std::numeric_limits<Tin>::max(),
+                           std::numeric_limits<Tin>::lowest()};
+    const int nValues = static_cast<int>(CPL_ARRAYSIZE(aValues));
+    const int N = 64 + 7;
+    std::vector<Tin> arrayIn(N);
+    for (int i = 0; i < N; i++)
+        arrayIn[i] = aValues[i % nValues];
+    std::vector<Tout> arrayOut(N);
+    GDALCopyWords(arrayIn.data(), eIn, sizeof(Tin), arrayOut.data(), eOut,
+                  sizeof(Tout), N);
+    for (int i = 0; i < N; i++)
+    {
+        Tout expected = 0;
+        GDALCopyWords(&arrayIn[i], eIn, 0, &expected, eOut, 0, 1);
+        if (std::isnan(static_cast<double>(expected)))
+            EXPECT_TRUE(std::isnan(static_cast<double>(arrayOut[i])))
+                << "i=" << i;
+        else
+            EXPECT_EQ(arrayOut[i], expected)
+                << GDALGetDataTypeName(eIn) << " -> "
+                << GDALGetDataTypeName(eOut) << ": i=" << i
+                << ", in=" << static_cast<double>(arrayIn[i]);
+    }
+}
+
+TEST_F(TestCopyWords, PackedFloatEdgeCases)
+{
+    CheckPackedFloatEdgeCases<float, GByte>(GDT_Float32, GDT_Byte);
+    CheckPackedFloatEdgeCases<float, GUInt16>(GDT_Float32, GDT_UInt16);
+    CheckPackedFloatEdgeCases<float, GInt16>(GDT_Float32, GDT_Int16);
+    CheckPackedFloatEdgeCases<float, double>(GDT_Float32, GDT_Float64);
+    CheckPackedFloatEdgeCases<double, GByte>(GDT_Float64, GDT_Byte);
+    CheckPackedFloatEdgeCases<double, GUInt16>(GDT_Float64, GDT_UInt16);
+    CheckPackedFloatEdgeCases<double, GInt16>(GDT_Float64, GDT_Int16);
+    CheckPackedFloatEdgeCases<double, float>(GDT_Float64, GDT_Float32);
+}
+
 }  // namespace
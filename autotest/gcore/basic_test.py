@@ -919,3 +919,40 @@ def test_tmp_vsimem(tmp_vsimem):
     assert isinstance(tmp_vsimem, os.PathLike)
 
     assert gdal.VSIStatL(tmp_vsimem) is not None
+
+
+###############################################################################
+# Test that built-in drivers registered lazily are fully registered on demand
+
+
+@pytest.mark.parametrize("lazy", ["YES", "NO"])
+def test_basic_test_lazy_driver_registration(lazy):
+
+    drv = gdal.GetDriverByName("PNG")
+    if drv is None:
+        pytest.skip("PNG driver missing")
+    if drv.GetMetadataItem("IS_NON_LOADED_PLUGIN") or gdal.GetConfigOption(
+        "GDAL_DRIVER_PATH"
+    ):
+        pytest.skip("PNG driver might be a plugin")
+
+    env = os.environ.copy()
+    env["CPL_DEBUG"] = "ON"
+    env["GDAL_LAZY_DRIVER_REGISTRATION"] = lazy
+    p = subprocess.run(
+        [
+            sys.executable,
+            "-c",
+            "from osgeo import gdal; "
+            "ds = gdal.Open('data/stefan_full_rgba.png'); "
+            "print(ds.GetDriver().ShortName, ds.RasterCount)",
+        ],
+        env=env,
+        capture_output=True,
+        encoding="UTF-8",
+    )
+    assert p.stdout.strip() == "PNG 4"
+    if lazy == "YES":
+        assert "On-demand registering built-in driver PNG" in p.stderr
+    else:
+        assert "On-demand registering built-in driver" not in p.stderr
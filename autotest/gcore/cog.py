@@ -29,6 +29,8 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import os
+import re
 import struct
 import sys
 
@@ -1924,3 +1926,58 @@ def test_cog_stats(tmp_vsimem, nbands, co, src_has_stats, expected_val):
     if expected_val and ds.RasterCount == 2:
         assert ds.GetRasterBand(2).GetMetadataItem("STATISTICS_MINIMUM") == "255"
     ds = None
+
+
+###############################################################################
+# Test that temporary files are held in memory when small enough, and that
+# each step of the generation reports its duration
+
+
+@pytest.mark.parametrize("max_in_memory_size", [None, "0"])
+def test_cog_tmp_files_in_memory(tmp_path, max_in_memory_size):
+
+    src_ds = gdal.Translate("", "data/byte.tif", options="-of MEM -outsize 512 512")
+    filename = str(tmp_path / "out.tif")
+
+    debug_msgs = []
+
+    def handler(eErrClass, err_no, msg):
+        if eErrClass == gdal.CE_Debug:
+            debug_msgs.append(msg)
+
+    tmp_files = set()
+
+    def progress(pct, msg, user_data):
+        tmp_files.update(x for x in os.listdir(tmp_path) if x != "out.tif")
+        return 1
+
+    with gdaltest.error_handler(handler):
+        gdal.SetCurrentErrorHandlerCatchDebug(True)
+        with gdaltest.config_options(
+            {
+                "CPL_DEBUG": "COG",
+                "COG_TMP_MAX_IN_MEMORY_SIZE": max_in_memory_size,
+                "CPL_TMPDIR": None,
+            }
+        ):
+            ds = gdal.GetDriverByName("COG").CreateCopy(
+                filename, src_ds, options=["BLOCKSIZE=128"], callback=progress
+            )
+    assert ds
+    assert ds.GetRasterBand(1).GetOverviewCount() == 2
+    ds = None
+
+    for step in ("Generating overviews of the imagery", "Generating final product"):
+        assert [x for x in debug_msgs if re.match(f"COG: {step}: end \\(.* s\\)", x)]
+
+    if max_in_memory_size is None:
+        assert not tmp_files
+    else:
+        assert "out.tif.ovr.tmp" in tmp_files
+    # check that the temp file has gone away
+    assert os.listdir(tmp_path) == ["out.tif"]
+
+    ds = gdal.Open(filename)
+    assert ds.GetRasterBand(1).Checksum() == src_ds.GetRasterBand(1).Checksum()
+    ds = None
+    _check_cog(filename)
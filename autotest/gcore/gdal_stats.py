@@ -905,3 +905,61 @@ def test_stats_mask_band():
     assert src_ds.GetRasterBand(1).ComputeRasterMinMax(False) == (2, 3)
     assert src_ds.GetRasterBand(1).ComputeStatistics(False) == [2, 3, 2.5, 0.5]
     assert src_ds.GetRasterBand(1).GetHistogram(False) == [0, 0, 1, 1] + ([0] * 252)
+
+
+###############################################################################
+# Test that multi-threaded statistics, min/max and histogram computations give
+# the same results as single-threaded ones
+
+
+@pytest.mark.parametrize(
+    "datatype,with_mask",
+    [
+        (gdal.GDT_Byte, False),
+        (gdal.GDT_UInt16, False),
+        (gdal.GDT_Int16, False),
+        (gdal.GDT_Float32, False),
+        (gdal.GDT_Float64, True),
+    ],
+)
+def test_stats_multithreaded(datatype, with_mask):
+
+    ds = gdal.GetDriverByName("MEM").Create("", 100, 1000, 1, datatype)
+    ds.GetRasterBand(1).WriteRaster(
+        0,
+        0,
+        100,
+        1000,
+        struct.pack(
+            "d" * 100 * 1000, *[(i * 37) % 251 for i in range(100 * 1000)]
+        ),
+        buf_type=gdal.GDT_Float64,
+    )
+    if with_mask:
+        ds.CreateMaskBand(gdal.GMF_PER_DATASET)
+        ds.GetRasterBand(1).GetMaskBand().WriteRaster(
+            0,
+            0,
+            100,
+            1000,
+            struct.pack(
+                "B" * 100 * 1000, *[(i % 3) * 127 for i in range(100 * 1000)]
+            ),
+        )
+    band = ds.GetRasterBand(1)
+
+    def compute():
+        return (
+            band.ComputeRasterMinMax(False),
+            band.ComputeStatistics(False),
+            band.GetHistogram(-0.5, 255.5, 256, False, False),
+        )
+
+    minmax, stats, hist = compute()
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        minmax_mt, stats_mt, hist_mt = compute()
+    assert minmax_mt == minmax
+    assert hist_mt == hist
+    assert stats_mt[0:2] == stats[0:2]
+    assert stats_mt[2] == pytest.approx(stats[2], rel=1e-12)
+    assert stats_mt[3] == pytest.approx(stats[3], rel=1e-12)
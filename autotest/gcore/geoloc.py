@@ -137,6 +137,61 @@ def test_geoloc_fill_line(use_temp_datasets):
         )  # 22336 with Intel(R) oneAPI DPC++/C++ Compiler 2022.1.0
 
 
+###############################################################################
+# Test GEOLOC_BACKMAP_CACHE_DIR
+
+
+@pytest.mark.parametrize("use_temp_datasets", ["YES", "NO"])
+def test_geoloc_backmap_cache_dir(tmp_path, use_temp_datasets):
+
+    ds = gdal.GetDriverByName("MEM").Create("", 200, 372)
+    md = {
+        "LINE_OFFSET": "0",
+        "LINE_STEP": "1",
+        "PIXEL_OFFSET": "0",
+        "PIXEL_STEP": "1",
+        "X_DATASET": "../alg/data/geoloc/longitude_including_pole.tif",
+        "X_BAND": "1",
+        "Y_DATASET": "../alg/data/geoloc/latitude_including_pole.tif",
+        "Y_BAND": "1",
+        "SRS": "EPSG:4326",
+    }
+    ds.SetMetadata(md, "GEOLOCATION")
+    ds.GetRasterBand(1).Fill(1)
+
+    cache_dir = tmp_path / "cache"
+    with gdaltest.config_option("GDAL_GEOLOC_USE_TEMP_DATASETS", use_temp_datasets):
+        ref_ds = gdal.Warp("", ds, format="MEM")
+        ref_cs = ref_ds.GetRasterBand(1).Checksum()
+
+        with gdaltest.config_option("GDAL_GEOLOC_BACKMAP_CACHE_DIR", str(cache_dir)):
+            warped_ds = gdal.Warp("", ds, format="MEM")
+            assert warped_ds.GetRasterBand(1).Checksum() == ref_cs
+            cached_files = list(cache_dir.iterdir())
+            assert len(cached_files) == 1
+            assert cached_files[0].name.startswith("geoloc_backmap_")
+
+            # Second run uses the cached backmap
+            warped_ds = gdal.Warp("", ds, format="MEM")
+            assert warped_ds.GetRasterBand(1).Checksum() == ref_cs
+            assert list(cache_dir.iterdir()) == cached_files
+
+            # Different parameters give a different cache entry
+            warped_ds = gdal.Warp(
+                "",
+                ds,
+                format="MEM",
+                transformerOptions=["GEOLOC_BACKMAP_OVERSAMPLE_FACTOR=0.5"],
+            )
+            assert len(list(cache_dir.iterdir())) == 2
+
+        # A corrupted cache file is ignored
+        open(cached_files[0], "wb").write(b"garbage")
+        with gdaltest.config_option("GDAL_GEOLOC_BACKMAP_CACHE_DIR", str(cache_dir)):
+            warped_ds = gdal.Warp("", ds, format="MEM")
+            assert warped_ds.GetRasterBand(1).Checksum() == ref_cs
+
+
 ###############################################################################
 # Test warping from rectified to referenced-by-geoloc
 
@@ -1021,3 +1021,46 @@ def test_mask_setting_nodata(dt):
     assert ds.GetRasterBand(1).GetMaskBand().ReadRaster() == struct.pack("B", 0)
     ds.GetRasterBand(1).DeleteNoDataValue()
     assert ds.GetRasterBand(1).GetMaskBand().ReadRaster() == struct.pack("B", 255)
+
+
+###############################################################################
+# Test nodata mask computation on lines that are not a multiple of the
+# vectorization width, and with a non-Byte output buffer
+
+
+@pytest.mark.parametrize(
+    "dt,fmt,nodata",
+    [
+        (gdal.GDT_Byte, "B", 1),
+        (gdal.GDT_UInt16, "H", 65535),
+        (gdal.GDT_Int32, "i", -1),
+        (gdal.GDT_UInt32, "I", 4294967295),
+        (gdal.GDT_Int64, "q", -(1 << 40)),
+        (gdal.GDT_UInt64, "Q", (1 << 40) + 1),
+        (gdal.GDT_Float32, "f", 1.5),
+        (gdal.GDT_Float32, "f", float("nan")),
+        (gdal.GDT_Float64, "d", -1.5),
+        (gdal.GDT_Float64, "d", float("nan")),
+    ],
+)
+def test_mask_nodata_vectorized(dt, fmt, nodata):
+
+    width = 37
+    ds = gdal.GetDriverByName("MEM").Create("", width, 2, 1, dt)
+    if dt == gdal.GDT_Int64:
+        ds.GetRasterBand(1).SetNoDataValueAsInt64(nodata)
+    elif dt == gdal.GDT_UInt64:
+        ds.GetRasterBand(1).SetNoDataValueAsUInt64(nodata)
+    else:
+        ds.GetRasterBand(1).SetNoDataValue(nodata)
+    values = [nodata if (i % 3) == 0 else 0 for i in range(2 * width)]
+    ds.GetRasterBand(1).WriteRaster(
+        0, 0, width, 2, struct.pack("%d%s" % (2 * width, fmt), *values)
+    )
+    expected = [0 if (i % 3) == 0 else 255 for i in range(2 * width)]
+
+    msk = ds.GetRasterBand(1).GetMaskBand()
+    assert struct.unpack("B" * 2 * width, msk.ReadRaster()) == tuple(expected)
+    assert struct.unpack(
+        "H" * 2 * width, msk.ReadRaster(buf_type=gdal.GDT_UInt16)
+    ) == tuple(expected)
@@ -1465,3 +1465,153 @@ def test_pixfun_max_no_nodata():
 
 
 ###############################################################################
+# Verify the per-source-type code paths of the arithmetic pixel functions,
+# on a width that is not a multiple of the vector size
+
+
+@pytest.mark.parametrize(
+    "src_type",
+    [
+        gdal.GDT_Byte,
+        gdal.GDT_Int8,
+        gdal.GDT_UInt16,
+        gdal.GDT_Int16,
+        gdal.GDT_UInt32,
+        gdal.GDT_Int32,
+        gdal.GDT_Float32,
+        gdal.GDT_Float64,
+    ],
+)
+@pytest.mark.parametrize("pixfn", ["sum", "diff", "mul", "min", "max"])
+def test_pixfun_real_src_types(tmp_vsimem, src_type, pixfn):
+
+    xsize = 67
+    ysize = 3
+    ar1 = numpy.arange(xsize * ysize).reshape(ysize, xsize) % 100
+    ar2 = (numpy.arange(xsize * ysize).reshape(ysize, xsize) * 7) % 60 + 1
+    filenames = []
+    for i, ar in enumerate((ar1, ar2)):
+        filename = str(tmp_vsimem / f"src{i}.tif")
+        ds = gdal.GetDriverByName("GTiff").Create(filename, xsize, ysize, 1, src_type)
+        ds.GetRasterBand(1).WriteArray(ar)
+        ds = None
+        filenames.append(filename)
+
+    sources = "".join(
+        f"""<SimpleSource>
+      <SourceFilename relativeToVRT="0">{filename}</SourceFilename>
+      <SourceBand>1</SourceBand>
+    </SimpleSource>"""
+        for filename in filenames
+    )
+    vrt_ds = gdal.Open(
+        f"""<VRTDataset rasterXSize="{xsize}" rasterYSize="{ysize}">
+  <VRTRasterBand dataType="Float64" band="1" subClass="VRTDerivedRasterBand">
+    <PixelFunctionType>{pixfn}</PixelFunctionType>
+    <SourceTransferType>{gdal.GetDataTypeName(src_type)}</SourceTransferType>
+    {sources}
+  </VRTRasterBand>
+</VRTDataset>"""
+    )
+
+    ar1 = ar1.astype(numpy.float64)
+    ar2 = ar2.astype(numpy.float64)
+    if pixfn == "sum":
+        expected = ar1 + ar2
+    elif pixfn == "diff":
+        expected = ar1 - ar2
+    elif pixfn == "mul":
+        expected = ar1 * ar2
+    elif pixfn == "min":
+        expected = numpy.minimum(ar1, ar2)
+    else:
+        expected = numpy.maximum(ar1, ar2)
+
+    band = vrt_ds.GetRasterBand(1)
+    assert numpy.array_equal(band.ReadAsArray(), expected)
+    assert numpy.array_equal(
+        band.ReadAsArray(buf_type=gdal.GDT_Float32), expected.astype(numpy.float32)
+    )
+    assert numpy.array_equal(
+        band.ReadAsArray(buf_type=gdal.GDT_Int16), expected.astype(numpy.int16)
+    )
+
+
+###############################################################################
+# Verify the expression pixel function
+
+
+def test_pixfun_expression():
+
+    vrt_ds = gdal.Open(
+        """<VRTDataset rasterXSize="5" rasterYSize="6">
+  <VRTRasterBand dataType="Float32" band="1" subClass="VRTDerivedRasterBand">
+    <PixelFunctionType>expression</PixelFunctionType>
+    <PixelFunctionArguments expression="B2 == 0 ? -1 : (B1 - B2) / (B1 + B2) + 2 * max(B1, B2, 3) ^ 2" />
+    <SimpleSource>
+      <SourceFilename relativeToVRT="0">data/int32.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <SrcRect xOff="0" yOff="0" xSize="5" ySize="6"/>
+      <DstRect xOff="0" yOff="0" xSize="5" ySize="6"/>
+    </SimpleSource>
+    <SimpleSource>
+      <SourceFilename relativeToVRT="0">data/float32.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <SrcRect xOff="10" yOff="10" xSize="5" ySize="6"/>
+      <DstRect xOff="0" yOff="0" xSize="5" ySize="6"/>
+    </SimpleSource>
+  </VRTRasterBand>
+</VRTDataset>"""
+    )
+    data = vrt_ds.GetRasterBand(1).ReadAsArray()
+
+    refdata1 = (
+        gdal.Open("data/int32.tif")
+        .GetRasterBand(1)
+        .ReadAsArray(0, 0, 5, 6)
+        .astype(numpy.float64)
+    )
+    refdata2 = (
+        gdal.Open("data/float32.tif")
+        .GetRasterBand(1)
+        .ReadAsArray(10, 10, 5, 6)
+        .astype(numpy.float64)
+    )
+    expected = numpy.where(
+        refdata2 == 0,
+        -1,
+        (refdata1 - refdata2) / (refdata1 + refdata2)
+        + 2 * numpy.maximum(numpy.maximum(refdata1, refdata2), 3) ** 2,
+    )
+    assert numpy.allclose(data, expected)
+
+    # Multi-threaded evaluation must give the same result
+    with gdaltest.config_option("GDAL_NUM_THREADS", "2"):
+        data = vrt_ds.GetRasterBand(1).ReadAsArray(buf_xsize=500, buf_ysize=600)
+    assert numpy.allclose(data[::100, ::100], expected)
+
+
+@pytest.mark.parametrize(
+    "expression",
+    ["B1 +", "B3", "foo(B1)", "(B1", "max()", "if(B1, 2)", "B1 $ 2"],
+)
+def test_pixfun_expression_invalid(expression):
+
+    vrt_ds = gdal.Open(
+        f"""<VRTDataset rasterXSize="20" rasterYSize="20">
+  <VRTRasterBand dataType="Float32" band="1" subClass="VRTDerivedRasterBand">
+    <PixelFunctionType>expression</PixelFunctionType>
+    <PixelFunctionArguments expression="{expression}" />
+    <SimpleSource>
+      <SourceFilename relativeToVRT="0">data/byte.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+    </SimpleSource>
+    <SimpleSource>
+      <SourceFilename relativeToVRT="0">data/byte.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+    </SimpleSource>
+  </VRTRasterBand>
+</VRTDataset>"""
+    )
+    with pytest.raises(Exception, match="Invalid expression"):
+        vrt_ds.GetRasterBand(1).ReadAsArray()
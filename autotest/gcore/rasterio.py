@@ -3294,3 +3294,93 @@ def test_rasterio_overview_selection():
         assert ds.GetRasterBand(1).ReadRaster(0, 0, 100, 100, 29, 29)[0] == 2
         assert ds.GetRasterBand(1).ReadRaster(0, 0, 100, 100, 25, 25)[0] == 3
         assert ds.GetRasterBand(1).ReadRaster(0, 0, 100, 100, 24, 24)[0] == 3
+
+
+###############################################################################
+# Test GDAL_COPY_WHOLE_RASTER_PIPELINE=YES in GDALDatasetCopyWholeRaster()
+
+
+@pytest.mark.require_driver("ENVI")
+@pytest.mark.parametrize("interleave", ["BSQ", "BIP"])
+def test_rasterio_copy_whole_raster_pipeline(tmp_vsimem, interleave):
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 2000, 600, 3)
+    for i in range(3):
+        src_ds.GetRasterBand(i + 1).WriteRaster(
+            0, 0, 2000, 600, bytes((x * (i + 1)) % 251 for x in range(2000 * 600))
+        )
+
+    filename = str(tmp_vsimem / "out.img")
+    with gdaltest.config_options(
+        {"GDAL_COPY_WHOLE_RASTER_PIPELINE": "YES", "GDAL_SWATH_SIZE": "1000000"}
+    ):
+        tab_pct = [0]
+
+        def progress(pct, msg, user_data):
+            assert pct >= tab_pct[0]
+            tab_pct[0] = pct
+            return True
+
+        gdal.GetDriverByName("ENVI").CreateCopy(
+            filename, src_ds, options=["INTERLEAVE=" + interleave], callback=progress
+        )
+        assert tab_pct[0] == 1.0
+
+    ds = gdal.Open(filename)
+    assert [ds.GetRasterBand(i + 1).Checksum() for i in range(3)] == [
+        src_ds.GetRasterBand(i + 1).Checksum() for i in range(3)
+    ]
+    ds = None
+
+    # Test interruption
+    with gdaltest.config_option("GDAL_COPY_WHOLE_RASTER_PIPELINE", "YES"):
+        with pytest.raises(Exception):
+            gdal.GetDriverByName("ENVI").CreateCopy(
+                filename,
+                src_ds,
+                options=["INTERLEAVE=" + interleave],
+                callback=lambda pct, msg, user_data: pct < 0.5,
+            )
+
+
+###############################################################################
+# Test that resampled RasterIO() gives the same result when the resampling
+# is done by several threads
+
+
+@pytest.mark.parametrize(
+    "resample_alg", [gdal.GRIORA_Average, gdal.GRIORA_Cubic, gdal.GRIORA_Mode]
+)
+def test_rasterio_resampled_multithreaded(resample_alg):
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 2000, 1500)
+    band = src_ds.GetRasterBand(1)
+    band.WriteRaster(0, 0, 2000, 1500, bytes(x % 251 for x in range(2000 * 1500)))
+    # Fully transparent area, to test the skipping of resampling
+    band.WriteRaster(0, 0, 2000, 500, b"\xff" * (2000 * 500))
+    band.SetNoDataValue(255)
+
+    def read():
+        tab_pct = [0]
+
+        def progress(pct, msg, user_data):
+            assert pct >= tab_pct[0]
+            tab_pct[0] = pct
+            return True
+
+        data = band.ReadRaster(
+            0,
+            0,
+            2000,
+            1500,
+            200,
+            150,
+            resample_alg=resample_alg,
+            callback=progress,
+        )
+        assert tab_pct[0] == 1.0
+        return data
+
+    expected = read()
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        assert read() == expected
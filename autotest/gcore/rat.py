@@ -178,3 +178,47 @@ def test_rat_4():
 
 
 ##############################################################################
+
+
+###############################################################################
+# Test GetRowOfValue() on RATs large enough to use the index of the Min/Max
+# columns
+
+
+def test_rat_get_row_of_value_index():
+
+    # Disjoint [Min, Max] intervals, in shuffled order
+    rat = gdal.RasterAttributeTable()
+    rat.CreateColumn("MIN", gdal.GFT_Real, gdal.GFU_Min)
+    rat.CreateColumn("MAX", gdal.GFT_Real, gdal.GFU_Max)
+    N = 1000
+    for i in range(N):
+        j = (i * 7) % N
+        rat.SetValueAsDouble(i, 0, j * 10)
+        rat.SetValueAsDouble(i, 1, j * 10 + 5)
+    assert rat.GetRowOfValue(-1) == -1
+    assert rat.GetRowOfValue(0) == 0
+    assert rat.GetRowOfValue(7) == -1
+    assert rat.GetRowOfValue(10) == 143
+    assert rat.GetRowOfValue(75) == 1
+    assert rat.GetRowOfValue(9995) == 857
+    assert rat.GetRowOfValue(9996) == -1
+
+    # Modifying a Max value must be taken into account
+    rat.SetValueAsDouble(0, 1, 8)
+    assert rat.GetRowOfValue(7) == 0
+
+    # Overlapping intervals: the first matching row is returned
+    rat.SetValueAsDouble(1, 0, 0)
+    assert rat.GetRowOfValue(3) == 0
+    assert rat.GetRowOfValue(9) == 1
+
+    # Min column only: first row whose Min is lower or equal to the value
+    rat = gdal.RasterAttributeTable()
+    rat.CreateColumn("MIN", gdal.GFT_Integer, gdal.GFU_Min)
+    for i in range(N):
+        rat.SetValueAsInt(i, 0, N - i)
+    assert rat.GetRowOfValue(0) == -1
+    assert rat.GetRowOfValue(1) == N - 1
+    assert rat.GetRowOfValue(N) == 0
+    assert rat.GetRowOfValue(N - 0.5) == 1
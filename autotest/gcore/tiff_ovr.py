@@ -2887,3 +2887,39 @@ def test_tiff_ovr_JXL_ALPHA_DISTANCE_OVERVIEW(tmp_vsimem):
     assert ds.GetRasterBand(4).Checksum() != cs4
     del ds
     gdal.Unlink(tmpfilename + ".ovr")
+
+
+###############################################################################
+# Test that the streaming cascading generation of overviews gives the same
+# results as the generation reading back each overview level.
+
+
+@pytest.mark.parametrize("resampling", ["AVERAGE", "RMS", "MODE", "GAUSS"])
+@pytest.mark.parametrize("datatype", [gdal.GDT_Byte, gdal.GDT_Float32])
+@pytest.mark.parametrize("nodata", [None, 0])
+def test_tiff_ovr_streaming_cascade(tmp_vsimem, resampling, datatype, nodata):
+
+    def build(filename, options):
+        gdal.Translate(
+            filename,
+            "data/stefan_full_rgba.tif",
+            bandList=[1],
+            outputType=datatype,
+            noData=nodata,
+        )
+        ds = gdal.Open(filename, gdal.GA_Update)
+        with gdaltest.config_options(options):
+            ds.BuildOverviews(resampling, [2, 4, 8, 16])
+        ret = [ds.GetRasterBand(1).GetOverview(i).ReadRaster() for i in range(4)]
+        ds = None
+        return ret
+
+    ref = build(str(tmp_vsimem / "ref.tif"), {"GDAL_OVR_STREAMING_CASCADE": "NO"})
+    assert build(str(tmp_vsimem / "test.tif"), {}) == ref
+    assert (
+        build(
+            str(tmp_vsimem / "test_chunk.tif"),
+            {"GDAL_OVR_CHUNKYSIZE": "3", "GDAL_NUM_THREADS": "4"},
+        )
+        == ref
+    )
@@ -30,6 +30,7 @@
 import array
 import os
 import platform
+import re
 import shutil
 import struct
 import sys
@@ -4143,6 +4144,160 @@ def test_tiff_read_deflate_4GB():
     assert data == ref_ds.ReadRaster()
 
 
+###############################################################################
+# Test the coalescing of ranges done when reading a window on a file system
+# with multi-range support
+
+
+def _get_multirange_plans(ds):
+
+    debug_msgs = []
+
+    def handler(eErrClass, err_no, msg):
+        if eErrClass == gdal.CE_Debug:
+            debug_msgs.append(msg)
+
+    with gdaltest.error_handler(handler):
+        gdal.SetCurrentErrorHandlerCatchDebug(True)
+        with gdaltest.config_option("CPL_DEBUG", "ON"):
+            data = ds.ReadRaster(1024, 0, 256, 256)
+
+    plans = {}
+    for msg in debug_msgs:
+        m = re.search(
+            r"Multi-range plan for (.*): (\d+) ranges of \d+ bytes read "
+            r"with (\d+) request\(s\) in (\d+) batch\(es\)",
+            msg,
+        )
+        if m:
+            plans[m.group(1)] = [int(m.group(i)) for i in range(2, 5)]
+    return data, plans
+
+
+def test_tiff_read_multirange_planner(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test.tif")
+    ds = gdal.GetDriverByName("GTiff").Create(
+        filename,
+        32768,
+        256,
+        options=["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16", "COMPRESS=DEFLATE"],
+    )
+    ds.WriteRaster(
+        0, 0, 32768, 256, bytes([(i * 7) % 251 for i in range(32768)]) * 256
+    )
+    ds = None
+
+    ds = gdal.Open(filename)
+    ref_data = ds.ReadRaster(1024, 0, 256, 256)
+    ds = None
+
+    with gdal.config_option("GTIFF_HAS_OPTIMIZED_READ_MULTI_RANGE", "YES"):
+        ds = gdal.Open(filename)
+        data, plans = _get_multirange_plans(ds)
+        assert data == ref_data
+        assert "blocks" in plans
+        assert plans["blocks"][0] == 256
+        assert "strile arrays" in plans
+        ds = None
+
+        # One request for everything
+        with gdal.config_option("GTIFF_MULTIRANGE_GAP_THRESHOLD", "1000000000"):
+            ds = gdal.Open(filename)
+            data, plans = _get_multirange_plans(ds)
+            assert data == ref_data
+            assert plans["blocks"][1:] == [1, 1]
+            ds = None
+
+        # No gap bridged, and one request at a time
+        with gdaltest.config_options(
+            {
+                "GTIFF_MULTIRANGE_GAP_THRESHOLD": "0",
+                "GTIFF_MULTIRANGE_MAX_REQUEST_SIZE": "0",
+                "GTIFF_MULTIRANGE_MAX_PARALLEL_REQUESTS": "1",
+            }
+        ):
+            ds = gdal.Open(filename)
+            data, plans = _get_multirange_plans(ds)
+            assert data == ref_data
+            assert plans["blocks"][1] > 1
+            assert plans["blocks"][1] == plans["blocks"][2]
+            ds = None
+
+        # Block data already in the block cache is not requested again
+        ds = gdal.Open(filename)
+        ds.ReadRaster(1024, 0, 256, 256)
+        data, plans = _get_multirange_plans(ds)
+        assert data == ref_data
+        assert "blocks" not in plans
+        assert "strile arrays" not in plans
+        ds = None
+
+
+###############################################################################
+# Test reading strile arrays through GDAL's own paged cache
+
+
+@pytest.mark.parametrize(
+    "xsize,ysize,options",
+    [
+        (2048, 2048, ["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16"]),
+        (2048, 2048, ["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16", "BIGTIFF=YES"]),
+        (
+            2048,
+            2048,
+            ["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16", "ENDIANNESS=BIG"],
+        ),
+        (16, 8192, ["BLOCKYSIZE=1"]),
+    ],
+)
+@pytest.mark.parametrize("multirange", [False, True])
+def test_tiff_read_paged_strile_array_cache(
+    tmp_vsimem, xsize, ysize, options, multirange
+):
+
+    filename = str(tmp_vsimem / "test.tif")
+    ds = gdal.GetDriverByName("GTiff").Create(
+        filename, xsize, ysize, options=options + ["COMPRESS=DEFLATE"]
+    )
+    ds.WriteRaster(
+        0, 0, xsize, ysize, bytes([(i * 7) % 251 for i in range(xsize)]) * ysize
+    )
+    ds = None
+
+    ds = gdal.Open(filename)
+    ref_cs = ds.GetRasterBand(1).Checksum()
+    ref_data = ds.ReadRaster(0, ysize - 32, 16, 32)
+    ds = None
+
+    debug_msgs = []
+
+    def handler(eErrClass, err_no, msg):
+        if eErrClass == gdal.CE_Debug:
+            debug_msgs.append(msg)
+
+    with gdaltest.config_options(
+        {
+            "GTIFF_PAGED_STRILE_ARRAY_CACHE": "YES",
+            "GTIFF_STRILE_ARRAY_CACHE_PAGES": "2",
+            "GTIFF_HAS_OPTIMIZED_READ_MULTI_RANGE": "YES" if multirange else "NO",
+        }
+    ):
+        with gdaltest.error_handler(handler):
+            gdal.SetCurrentErrorHandlerCatchDebug(True)
+            with gdaltest.config_option("CPL_DEBUG", "ON"):
+                ds = gdal.Open(filename)
+                assert ds.ReadRaster(0, ysize - 32, 16, 32) == ref_data
+        assert ds.GetRasterBand(1).Checksum() == ref_cs
+        assert (
+            ds.GetRasterBand(1).GetMetadataItem("BLOCK_OFFSET_0_0", "TIFF")
+            is not None
+        )
+        ds = None
+
+    assert any("Using paged cache of strile arrays" in msg for msg in debug_msgs)
+
+
 ###############################################################################
 # Check that our use of TileByteCounts is minimal for COG (only for last tile)
 # and for interleaved mask that we also hardly use TileOffsets.
@@ -4448,6 +4603,36 @@ def test_tiff_read_cog_with_mask_vsicurl():
         gdal.GetDriverByName("GTIFF").Delete(cog_filename)
 
 
+###############################################################################
+# Check multi-threaded reading of a COG with an internal mask, where the mask
+# striles are fetched together with the imagery ones
+
+
+def test_tiff_read_cog_with_mask_multithreaded(tmp_vsimem):
+
+    src_ds = gdal.Translate("", "data/byte.tif", options="-of MEM -outsize 200 100")
+    src_ds.CreateMaskBand(gdal.GMF_PER_DATASET)
+    src_ds.GetRasterBand(1).GetMaskBand().WriteRaster(
+        0, 0, 100, 100, b"\xFF", buf_xsize=1, buf_ysize=1
+    )
+    cog_filename = str(tmp_vsimem / "cog.tif")
+    gdal.GetDriverByName("COG").CreateCopy(
+        cog_filename, src_ds, options=["BLOCKSIZE=16", "COMPRESS=LZW"]
+    )
+
+    ds = gdal.Open(cog_filename)
+    with gdal.config_option("GDAL_NUM_THREADS", "1"):
+        ref_data = ds.ReadRaster()
+        ref_mask = ds.GetRasterBand(1).GetMaskBand().ReadRaster()
+    ds = None
+
+    with gdal.config_option("GDAL_NUM_THREADS", "2"):
+        ds = gdal.Open(cog_filename)
+        assert ds.GetRasterBand(1).GetMaskFlags() == gdal.GMF_PER_DATASET
+        assert ds.ReadRaster() == ref_data
+        assert ds.GetRasterBand(1).GetMaskBand().ReadRaster() == ref_mask
+
+
 ###############################################################################
 # Check that GetMetadataDomainList() works properly
 
@@ -4875,6 +5060,77 @@ def test_tiff_read_multi_threaded(
     gdal.Unlink(tmpfile)
 
 
+###############################################################################
+# Test read-ahead of blocks with the thread pool when reading block by block
+
+
+@pytest.mark.parametrize(
+    "creation_options",
+    [
+        ["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16"],
+        ["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16", "INTERLEAVE=BAND"],
+        ["BLOCKYSIZE=8"],
+        ["BLOCKYSIZE=8", "SPARSE_OK=YES"],
+    ],
+)
+def test_tiff_read_multi_threaded_read_ahead(tmp_vsimem, creation_options):
+
+    ref_ds = gdal.GetDriverByName("MEM").Create("", 100, 100, 3)
+    for band in range(ref_ds.RasterCount):
+        buf = b""
+        for j in range(ref_ds.RasterYSize):
+            buf += array.array(
+                "B", [(band * 10 + j * 3 + i) % 256 for i in range(ref_ds.RasterXSize)]
+            )
+        ref_ds.GetRasterBand(band + 1).WriteRaster(0, 0, 100, 100, buf)
+
+    tmpfile = str(tmp_vsimem / "test_tiff_read_multi_threaded_read_ahead.tif")
+    ds = gdal.GetDriverByName("GTiff").Create(
+        tmpfile, 100, 100, 3, options=creation_options + ["COMPRESS=DEFLATE"]
+    )
+    if "SPARSE_OK=YES" in creation_options:
+        ds.WriteRaster(0, 0, 100, 50, ref_ds.ReadRaster(0, 0, 100, 50))
+        ref_ds.WriteRaster(0, 50, 100, 50, b"\0" * (100 * 50 * 3))
+    else:
+        ds.WriteRaster(0, 0, 100, 100, ref_ds.ReadRaster())
+    ds = None
+
+    for read_ahead in [None, "0"]:
+        with gdal.config_option("GTIFF_READ_AHEAD", read_ahead):
+            _check_read_block_by_block(tmpfile, ref_ds)
+
+
+def _check_read_block_by_block(tmpfile, ref_ds):
+
+    ds = gdal.OpenEx(tmpfile, open_options=["NUM_THREADS=4"])
+    blockxsize, blockysize = ds.GetRasterBand(1).GetBlockSize()
+    nblocksx = (ds.RasterXSize + blockxsize - 1) // blockxsize
+    nblocksy = (ds.RasterYSize + blockysize - 1) // blockysize
+
+    def block_window(x, y):
+        xoff = x * blockxsize
+        yoff = y * blockysize
+        xsize = min(blockxsize, ds.RasterXSize - xoff)
+        ysize = min(blockysize, ds.RasterYSize - yoff)
+        return xoff, yoff, xsize, ysize
+
+    # Sequential access
+    for i in range(1, 1 + ds.RasterCount):
+        band = ds.GetRasterBand(i)
+        ref_band = ref_ds.GetRasterBand(i)
+        for y in range(nblocksy):
+            for x in range(nblocksx):
+                window = block_window(x, y)
+                assert band.ReadRaster(*window) == ref_band.ReadRaster(*window)
+
+    # Local random access
+    ds.FlushCache()
+    for x, y in [(2, 2), (3, 2), (2, 3), (3, 4), (0, 0), (5, 5), (4, 5)]:
+        if x < nblocksx and y < nblocksy:
+            window = block_window(x, y)
+            assert ds.ReadRaster(*window) == ref_ds.ReadRaster(*window), (x, y)
+
+
 ###############################################################################
 # Test multi-threaded decoding with /vsicurl
 
@@ -6018,11 +6018,13 @@ def test_tiff_write_133():
         ds = None
         gdaltest.tiff_drv.Delete("/vsimem/tiff_write_133_dst.tif")
 
-    # Compression not supported
+    # Compression not supported by Create()
     with gdal.quiet_errors():
-        out_ds = gdaltest.tiff_drv.CreateCopy(
+        out_ds = gdaltest.tiff_drv.Create(
             "/vsimem/tiff_write_133_dst.tif",
-            src_ds,
+            1024,
+            1000,
+            3,
             options=["STREAMABLE_OUTPUT=YES", "COMPRESS=DEFLATE"],
         )
     assert out_ds is None
@@ -6111,6 +6113,51 @@ def test_tiff_write_133():
     gdaltest.tiff_drv.Delete("/vsimem/tiff_write_133.tif")
 
 
+###############################################################################
+# Test compressed streaming output of CreateCopy()
+
+
+@pytest.mark.parametrize(
+    "options",
+    [
+        ["COMPRESS=DEFLATE"],
+        ["COMPRESS=DEFLATE", "PREDICTOR=2", "BLOCKYSIZE=7"],
+        ["COMPRESS=LZW", "TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16"],
+        ["COMPRESS=LZW", "INTERLEAVE=BAND", "BLOCKYSIZE=16"],
+        [
+            "COMPRESS=PACKBITS",
+            "INTERLEAVE=BAND",
+            "TILED=YES",
+            "BLOCKXSIZE=16",
+            "BLOCKYSIZE=16",
+        ],
+        ["COMPRESS=DEFLATE", "BIGTIFF=YES"],
+    ],
+)
+def test_tiff_write_streaming_compressed(tmp_vsimem, options):
+
+    src_ds = gdal.Open("data/rgbsmall.tif")
+    filename = str(tmp_vsimem / "out.tif")
+    out_ds = gdaltest.tiff_drv.CreateCopy(
+        filename, src_ds, options=["STREAMABLE_OUTPUT=YES"] + options
+    )
+    assert out_ds is not None
+    out_ds = None
+
+    # The IFD must be at the beginning of the file and blocks in order
+    with gdal.config_option("TIFF_READ_STREAMING", "YES"):
+        ds = gdal.Open(filename)
+    assert ds is not None
+    assert ds.GetMetadataItem("UNORDERED_BLOCKS", "TIFF") is None
+    ds = None
+
+    ds = gdal.Open(filename)
+    assert ds.GetMetadataItem("COMPRESSION", "IMAGE_STRUCTURE") is not None
+    assert [ds.GetRasterBand(i + 1).Checksum() for i in range(3)] == [
+        src_ds.GetRasterBand(i + 1).Checksum() for i in range(3)
+    ]
+
+
 ###############################################################################
 # Test DISCARD_LSB
 
@@ -10114,6 +10161,73 @@ def test_tiff_write_predictor_2_float64():
     gdal.Unlink(filename)
 
 
+###############################################################################
+# Test lossless round-trip of predictors, with widths that are not a
+# multiple of the SIMD vector size
+
+
+@pytest.mark.parametrize(
+    "dt,predictor",
+    [
+        (gdal.GDT_Byte, 2),
+        (gdal.GDT_UInt16, 2),
+        (gdal.GDT_Int32, 2),
+        (gdal.GDT_UInt64, 2),
+        (gdal.GDT_Float32, 3),
+        (gdal.GDT_Float64, 3),
+    ],
+)
+@pytest.mark.parametrize("nbands", [1, 3, 4])
+@pytest.mark.parametrize("width", [1, 15, 37, 128])
+def test_tiff_write_predictor_roundtrip(tmp_vsimem, dt, predictor, nbands, width):
+
+    if (
+        dt == gdal.GDT_UInt64
+        and gdal.GetDriverByName("GTiff").GetMetadataItem("LIBTIFF") != "INTERNAL"
+    ):
+        pytest.skip("libtiff > 4.3.0 or internal libtiff needed")
+
+    filename = str(tmp_vsimem / "out.tif")
+    height = 3
+    dtsize = gdal.GetDataTypeSizeBytes(dt)
+    n = width * height * nbands
+    if dt in (gdal.GDT_Float32, gdal.GDT_Float64):
+        fmt = "f" if dt == gdal.GDT_Float32 else "d"
+        data = struct.pack(fmt * n, *[(i % 97) * 1.5 - 20 for i in range(n)])
+    else:
+        # Pseudo-random content, to exercise wrap-around of differences
+        data = bytes((i * 7919 + (i >> 3) * 104729) % 251 for i in range(n * dtsize))
+    ds = gdal.GetDriverByName("GTiff").Create(
+        filename,
+        width,
+        height,
+        nbands,
+        dt,
+        ["COMPRESS=DEFLATE", "PREDICTOR=%d" % predictor, "INTERLEAVE=PIXEL"],
+    )
+    ds.WriteRaster(
+        0,
+        0,
+        width,
+        height,
+        data,
+        buf_pixel_space=nbands * dtsize,
+        buf_line_space=width * nbands * dtsize,
+        buf_band_space=dtsize,
+    )
+    ds = None
+    ds = gdal.Open(filename)
+    assert ds.GetMetadataItem("PREDICTOR", "IMAGE_STRUCTURE") == str(predictor)
+    assert (
+        ds.ReadRaster(
+            buf_pixel_space=nbands * dtsize,
+            buf_line_space=width * nbands * dtsize,
+            buf_band_space=dtsize,
+        )
+        == data
+    )
+
+
 ###############################################################################
 
 
@@ -11423,3 +11537,200 @@ def test_tiff_write_copy_mdd():
     ds = None
 
     gdal.Unlink(filename)
+
+
+###############################################################################
+# Test copying compressed striles as they are between compatible files
+
+
+@pytest.mark.parametrize(
+    "options,direct_copy,expected",
+    [
+        (["TILED=YES", "COMPRESS=DEFLATE"], "YES", True),
+        (["TILED=YES", "COMPRESS=DEFLATE", "ZLEVEL=1"], "YES", True),
+        (["TILED=YES", "COMPRESS=DEFLATE"], "NO", False),
+        (["TILED=YES", "COMPRESS=LZW"], "YES", False),
+        (["TILED=YES", "COMPRESS=DEFLATE", "PREDICTOR=2"], "YES", False),
+        (["TILED=YES", "BLOCKXSIZE=32", "COMPRESS=DEFLATE"], "YES", False),
+        (["COMPRESS=DEFLATE"], "YES", False),
+    ],
+)
+def test_tiff_write_direct_copy_striles(tmp_vsimem, options, direct_copy, expected):
+
+    src_filename = str(tmp_vsimem / "src.tif")
+    gdal.Translate(
+        src_filename,
+        "data/rgbsmall.tif",
+        creationOptions=[
+            "TILED=YES",
+            "BLOCKXSIZE=16",
+            "BLOCKYSIZE=16",
+            "COMPRESS=DEFLATE",
+        ],
+    )
+    if "BLOCKXSIZE=32" not in options:
+        options = options + ["BLOCKXSIZE=16", "BLOCKYSIZE=16"]
+
+    src_ds = gdal.Open(src_filename)
+    filename = str(tmp_vsimem / "out.tif")
+    debug_msgs = []
+
+    def handler(eErrClass, err_no, msg):
+        if eErrClass == gdal.CE_Debug:
+            debug_msgs.append(msg)
+
+    with gdaltest.error_handler(handler):
+        gdal.SetCurrentErrorHandlerCatchDebug(True)
+        with gdaltest.config_options(
+            {"CPL_DEBUG": "GTiff", "GTIFF_DIRECT_COPY": direct_copy}
+        ):
+            gdal.GetDriverByName("GTiff").CreateCopy(filename, src_ds, options=options)
+    has_direct_copy = any("Copying compressed striles of" in msg for msg in debug_msgs)
+    assert has_direct_copy == expected
+
+    ds = gdal.Open(filename)
+    assert [ds.GetRasterBand(i + 1).Checksum() for i in range(3)] == [
+        src_ds.GetRasterBand(i + 1).Checksum() for i in range(3)
+    ]
+    if expected:
+        assert ds.GetRasterBand(1).GetMetadataItem(
+            "BLOCK_SIZE_0_0", "TIFF"
+        ) == src_ds.GetRasterBand(1).GetMetadataItem("BLOCK_SIZE_0_0", "TIFF")
+
+
+###############################################################################
+# Test back-pressure on the compression jobs pending for all datasets
+
+
+@pytest.mark.parametrize("max_bytes", ["1", None])
+def test_tiff_write_compression_queue_max_bytes(tmp_vsimem, max_bytes):
+
+    src_ds = gdal.Open("data/rgbsmall.tif")
+    filenames = [str(tmp_vsimem / ("out%d.tif" % i)) for i in range(2)]
+    debug_msgs = []
+
+    def handler(eErrClass, err_no, msg):
+        if eErrClass == gdal.CE_Debug:
+            debug_msgs.append(msg)
+
+    options = [
+        "TILED=YES",
+        "BLOCKXSIZE=16",
+        "BLOCKYSIZE=16",
+        "COMPRESS=DEFLATE",
+        "NUM_THREADS=4",
+    ]
+    with gdaltest.error_handler(handler):
+        gdal.SetCurrentErrorHandlerCatchDebug(True)
+        with gdaltest.config_options(
+            {"CPL_DEBUG": "GTiff", "GTIFF_COMPRESSION_QUEUE_MAX_BYTES": max_bytes}
+        ):
+            # Interleave writing of two datasets
+            datasets = [
+                gdal.GetDriverByName("GTiff").Create(
+                    filename, 50, 50, 3, options=options
+                )
+                for filename in filenames
+            ]
+            for y in range(0, 50, 16):
+                ysize = min(16, 50 - y)
+                for ds in datasets:
+                    ds.WriteRaster(0, y, 50, ysize, src_ds.ReadRaster(0, y, 50, ysize))
+                    ds.FlushCache()
+            datasets = None
+
+    has_waited = any("GTIFF_COMPRESSION_QUEUE_MAX_BYTES" in msg for msg in debug_msgs)
+    assert has_waited == (max_bytes is not None)
+
+    for filename in filenames:
+        ds = gdal.Open(filename)
+        assert [ds.GetRasterBand(i + 1).Checksum() for i in range(3)] == [
+            src_ds.GetRasterBand(i + 1).Checksum() for i in range(3)
+        ]
+
+
+###############################################################################
+# Test BLOCK_STATISTICS=YES
+
+
+@pytest.mark.parametrize(
+    "options",
+    [
+        ["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16"],
+        ["BLOCKYSIZE=7", "COMPRESS=LZW"],
+        ["TILED=YES", "BLOCKXSIZE=32", "BLOCKYSIZE=32", "INTERLEAVE=BAND"],
+    ],
+)
+@pytest.mark.parametrize("nodata", [None, 0])
+def test_tiff_write_block_statistics(tmp_vsimem, options, nodata):
+
+    src_ds = gdal.Translate(
+        "", "data/rgbsmall.tif", options="-of MEM -ot Float32 -scale 0 255 -10 10"
+    )
+    if nodata is not None:
+        for i in range(src_ds.RasterCount):
+            src_ds.GetRasterBand(i + 1).SetNoDataValue(nodata)
+    expected = [
+        src_ds.GetRasterBand(i + 1).ComputeStatistics(False)
+        for i in range(src_ds.RasterCount)
+    ]
+
+    filename = str(tmp_vsimem / "test.tif")
+    gdal.GetDriverByName("GTiff").CreateCopy(
+        filename, src_ds, options=options + ["BLOCK_STATISTICS=YES"]
+    )
+
+    ds = gdal.Open(filename)
+    for i in range(ds.RasterCount):
+        got = ds.GetRasterBand(i + 1).ComputeStatistics(False)
+        assert got == pytest.approx(expected[i], rel=1e-10)
+        if nodata is not None:
+            assert (
+                ds.GetRasterBand(i + 1).GetMetadataItem("STATISTICS_VALID_PERCENT")
+                != "100"
+            )
+        assert ds.GetRasterBand(i + 1).ComputeRasterMinMax(False) == pytest.approx(
+            (expected[i][0], expected[i][1])
+        )
+    ds = None
+    gdal.Unlink(filename + ".aux.xml")
+
+    # Update a block and check that statistics are updated
+    ds = gdal.Open(filename, gdal.GA_Update)
+    ds.GetRasterBand(1).WriteRaster(0, 0, 4, 4, struct.pack("f" * 16, *([100.0] * 16)))
+    ds = None
+    src_ds.GetRasterBand(1).WriteRaster(
+        0, 0, 4, 4, struct.pack("f" * 16, *([100.0] * 16))
+    )
+    expected = src_ds.GetRasterBand(1).ComputeStatistics(False)
+
+    ds = gdal.Open(filename)
+    assert ds.GetRasterBand(1).ComputeStatistics(False) == pytest.approx(
+        expected, rel=1e-10
+    )
+    assert ds.GetRasterBand(1).Checksum() == src_ds.GetRasterBand(1).Checksum()
+
+
+def test_tiff_write_block_statistics_not_used(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test.tif")
+    src_ds = gdal.Open("data/byte.tif")
+    gdal.GetDriverByName("GTiff").CreateCopy(
+        filename, src_ds, options=["BLOCK_STATISTICS=YES"]
+    )
+    expected = src_ds.GetRasterBand(1).ComputeStatistics(False)
+
+    # Nodata value set after the statistics have been computed
+    ds = gdal.Open(filename, gdal.GA_Update)
+    ds.GetRasterBand(1).SetNoDataValue(107)
+    ds = None
+    ds = gdal.Open(filename)
+    assert ds.GetRasterBand(1).ComputeStatistics(False) != pytest.approx(expected)
+    assert ds.GetRasterBand(1).GetMetadataItem("STATISTICS_VALID_PERCENT") != "100"
+    ds = None
+
+    with gdal.quiet_errors():
+        gdal.GetDriverByName("GTiff").CreateCopy(
+            filename, src_ds, options=["BLOCK_STATISTICS=YES", "COMPRESS=JPEG"]
+        )
+    assert "BLOCK_STATISTICS" in gdal.GetLastErrorMsg()
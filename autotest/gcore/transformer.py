@@ -32,6 +32,7 @@
 
 
 import math
+import random
 
 import gdaltest
 import pytest
@@ -730,6 +731,48 @@ def test_transformer_12():
         assert gdal.GetLastErrorMsg() != ""
 
 
+###############################################################################
+# Test the fast evaluation of TPS transformers with many GCPs
+
+
+def test_transformer_tps_many_gcps():
+
+    random.seed(1)
+    gcps = []
+    for i in range(1200):
+        pixel = random.uniform(0, 1000)
+        line = random.uniform(0, 1000)
+        x = 500000 + 9 * pixel + 30 * math.sin(line / 70)
+        y = 4000000 - 11 * line + 20 * math.cos(pixel / 50)
+        gcps.append(gdal.GCP(x, y, 0, pixel, line))
+    ds = gdal.GetDriverByName("MEM").Create("", 1000, 1000)
+    ds.SetGCPs(gcps, "")
+
+    points = [(gcp.GCPPixel, gcp.GCPLine) for gcp in gcps[0:10]]
+    points += [
+        (random.uniform(-200, 1200), random.uniform(-200, 1200)) for i in range(100)
+    ]
+
+    with gdaltest.config_option("GDAL_TPS_FAST_EVAL_MIN_POINTS", "1000000"):
+        tr_direct = gdal.Transformer(ds, None, ["METHOD=GCP_TPS"])
+    tr = gdal.Transformer(ds, None, ["METHOD=GCP_TPS"])
+
+    for i, (pixel, line) in enumerate(points):
+        _, expected = tr_direct.TransformPoint(0, pixel, line)
+        success, pnt = tr.TransformPoint(0, pixel, line)
+        assert success
+        assert pnt[0] == pytest.approx(expected[0], abs=1e-4)
+        assert pnt[1] == pytest.approx(expected[1], abs=1e-4)
+        if i < 10:
+            assert pnt[0] == pytest.approx(gcps[i].GCPX, abs=1e-4)
+            assert pnt[1] == pytest.approx(gcps[i].GCPY, abs=1e-4)
+
+        success, pnt = tr.TransformPoint(1, expected[0], expected[1])
+        assert success
+        assert pnt[0] == pytest.approx(pixel, abs=1e-5)
+        assert pnt[1] == pytest.approx(line, abs=1e-5)
+
+
 ###############################################################################
 # Test inverse RPC transform at DEM edge (#6377)
 
@@ -1132,6 +1175,48 @@ def test_transformer_dem_overrride_srs():
     gdal.Unlink("/vsimem/dem.tif")
 
 
+###############################################################################
+# Test that reading the DEM footprint in memory does not change results
+
+
+@pytest.mark.parametrize("interpolation", ["near", "bilinear", "cubic"])
+def test_transformer_rpc_dem_pinned_window(interpolation):
+
+    ds = gdal.Open("data/rpc.vrt")
+    ds_dem = gdal.GetDriverByName("GTiff").Create("/vsimem/dem.tif", 400, 400, 1)
+    sr = osr.SpatialReference()
+    sr.ImportFromEPSG(32652)
+    ds_dem.SetProjection(sr.ExportToWkt())
+    ds_dem.SetGeoTransform([173300, 200, 0, 4458700, 0, -200])
+    ds_dem.GetRasterBand(1).WriteRaster(
+        0,
+        0,
+        400,
+        400,
+        bytes((2 * x + 3 * y) % 250 for y in range(400) for x in range(400)),
+    )
+    ds_dem = None
+
+    points = [(x * 200.5, y * 250.5, 0) for y in range(12) for x in range(12)]
+    options = [
+        "METHOD=RPC",
+        "RPC_DEM=/vsimem/dem.tif",
+        "RPC_DEMINTERPOLATION=" + interpolation,
+    ]
+    res = {}
+    for pinned_cache_mb in ("0", None):
+        with gdaltest.config_option("GDAL_RPC_DEM_PINNED_CACHE_MB", pinned_cache_mb):
+            tr = gdal.Transformer(ds, None, options)
+            forward = tr.TransformPoints(0, points)
+            reverse = tr.TransformPoints(1, forward[0])
+            res[pinned_cache_mb] = (forward, reverse)
+            tr = None
+    assert res[None] == res["0"]
+    assert sum(res[None][0][1]) > len(points) // 2
+
+    gdal.Unlink("/vsimem/dem.tif")
+
+
 ###############################################################################
 # Test gdal.SuggestedWarpOutput
 
@@ -336,3 +336,37 @@ def test_virtualmem_4():
         ds = None
 
         gdal.GetDriverByName("GTiff").Delete(tmpfile)
+
+
+###############################################################################
+# Test read-only virtual mem serviced by userfaultfd, with concurrent page
+# filling (falls back to the SIGSEGV based mechanism if not available)
+@pytest.mark.skipif(sys.platform != "linux", reason="Incorrect platform")
+@pytest.mark.parametrize("band_sequential", [True, False])
+def test_virtualmem_userfaultfd(band_sequential):
+
+    ds = gdal.Open("../gdrivers/data/small_world.tif")
+    ref = ds.ReadAsArray()
+    if not band_sequential:
+        ref = numpy.transpose(ref, (1, 2, 0))
+
+    with gdal.quiet_errors():
+        ar = ds.GetVirtualMemArray(
+            gdal.GF_Read,
+            band_sequential=band_sequential,
+            page_size_hint=4096,
+            options=["USERFAULTFD=YES", "NUM_THREADS=4"],
+        )
+    assert numpy.array_equal(ar, ref)
+    ar = None
+
+    with gdal.quiet_errors():
+        ar = ds.GetRasterBand(2).GetVirtualMemArray(
+            gdal.GF_Read, options=["USERFAULTFD=YES", "NUM_THREADS=2"]
+        )
+    assert numpy.array_equal(ar, ds.GetRasterBand(2).ReadAsArray())
+    ar = None
+
+    with pytest.raises(Exception, match="only compatible with GF_Read"):
+        ds.GetVirtualMemArray(gdal.GF_Write, options=["USERFAULTFD=YES"])
+    ds = None
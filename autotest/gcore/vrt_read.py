@@ -2626,3 +2626,190 @@ def test_vrt_read_virtual_overviews_match_src_overviews(tmp_vsimem):
     assert vrt_band.GetOverview(1).YSize == 1024
     assert vrt_band.GetOverview(2).XSize == 1024
     assert vrt_band.GetOverview(2).YSize == 512
+
+
+###############################################################################
+# Test multi-threaded RasterIO() on a mosaic of non-overlapping sources
+
+
+@pytest.mark.parametrize("dataset_level", [True, False])
+def test_vrt_read_multithreaded_mosaic(tmp_vsimem, dataset_level):
+
+    src_ds = gdal.Translate("", "data/rgbsmall.tif", format="MEM")
+    filenames = []
+    for i, (xoff, yoff) in enumerate([(0, 0), (25, 0), (0, 25), (25, 25)]):
+        filename = str(tmp_vsimem / f"tile{i}.tif")
+        gdal.Translate(filename, src_ds, srcWin=[xoff, yoff, 25, 25])
+        filenames.append(filename)
+    vrt_filename = str(tmp_vsimem / "mosaic.vrt")
+    gdal.BuildVRT(vrt_filename, filenames).Close()
+
+    def read(ds):
+        if dataset_level:
+            return ds.ReadRaster(1, 2, 45, 47)
+        return ds.GetRasterBand(2).ReadRaster(1, 2, 45, 47)
+
+    expected = read(src_ds)
+
+    ds = gdal.OpenEx(vrt_filename, open_options=["NUM_THREADS=2"])
+    assert read(ds) == expected
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", "ALL_CPUS"):
+        ds = gdal.Open(vrt_filename)
+        assert read(ds) == expected
+
+        def callback(pct, message, user_data):
+            user_data[0] = pct
+            return 1  # 1 to continue, 0 to stop
+
+        user_data = [0]
+        assert (
+            ds.ReadRaster(callback=callback, callback_data=user_data)
+            == src_ds.ReadRaster()
+        )
+        assert user_data[0] == 1.0
+
+
+###############################################################################
+# Test multi-threaded RasterIO() on a mosaic of more tiled and multi-threaded
+# GTiff sources than threads
+
+
+def test_vrt_read_multithreaded_mosaic_of_multithreaded_gtiff(tmp_vsimem):
+
+    nb_sources = 2 * gdal.GetNumCPUs() + 2
+    src_ds = gdal.GetDriverByName("MEM").Create("", 64 * nb_sources, 64)
+    src_ds.GetRasterBand(1).Fill(1)
+    src_ds.GetRasterBand(1).WriteRaster(0, 0, 3, 1, b"\x01\x02\x03")
+    filenames = []
+    for i in range(nb_sources):
+        filename = str(tmp_vsimem / f"tile{i}.tif")
+        gdal.Translate(
+            filename,
+            src_ds,
+            srcWin=[64 * i, 0, 64, 64],
+            creationOptions=[
+                "TILED=YES",
+                "BLOCKXSIZE=16",
+                "BLOCKYSIZE=16",
+                "COMPRESS=DEFLATE",
+            ],
+        )
+        filenames.append(filename)
+    vrt_filename = str(tmp_vsimem / "mosaic.vrt")
+    gdal.BuildVRT(vrt_filename, filenames).Close()
+
+    expected = src_ds.ReadRaster()
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", "ALL_CPUS"):
+        ds = gdal.Open(vrt_filename)
+        assert ds.ReadRaster() == expected
+        assert ds.GetRasterBand(1).ReadRaster() == expected
+
+
+###############################################################################
+# Test RasterIO() on a mosaic with enough sources to use the quadtree of
+# source windows
+
+
+def test_vrt_read_many_sources():
+
+    src_ds = gdal.Translate("", "data/byte.tif", format="MEM")
+    tiles = [
+        gdal.Translate("", src_ds, options=f"-of MEM -srcwin {x} {y} 2 1")
+        for y in range(20)
+        for x in range(0, 20, 2)
+    ]
+    vrt_ds = gdal.BuildVRT("", tiles)
+    assert vrt_ds.GetRasterBand(1).Checksum() == 4672
+    for xoff, yoff, xsize, ysize in [(0, 0, 20, 20), (3, 5, 7, 1), (19, 19, 1, 1)]:
+        assert vrt_ds.ReadRaster(xoff, yoff, xsize, ysize) == src_ds.ReadRaster(
+            xoff, yoff, xsize, ysize
+        )
+        assert vrt_ds.GetRasterBand(1).ReadRaster(
+            xoff, yoff, xsize, ysize
+        ) == src_ds.GetRasterBand(1).ReadRaster(xoff, yoff, xsize, ysize)
+
+    # Sources added after the index has been built must be taken into account
+    vrt_ds.GetRasterBand(1).SetMetadataItem(
+        "source_0",
+        """<SimpleSource>
+             <SourceFilename>data/byte.tif</SourceFilename>
+             <SourceBand>1</SourceBand>
+             <SrcRect xOff="0" yOff="0" xSize="7" ySize="1"/>
+             <DstRect xOff="3" yOff="5" xSize="7" ySize="1"/>
+           </SimpleSource>""",
+        "new_vrt_sources",
+    )
+    assert vrt_ds.GetRasterBand(1).ReadRaster(3, 5, 7, 1) == src_ds.GetRasterBand(
+        1
+    ).ReadRaster(0, 0, 7, 1)
+
+
+###############################################################################
+# Test that re-opening a large VRT file whose parsed XML is cached takes into
+# account modifications of the file
+
+
+@pytest.mark.parametrize("xml_cache", ["YES", "NO"])
+def test_vrt_read_xml_cache(tmp_path, xml_cache):
+
+    vrt_filename = str(tmp_path / "test.vrt")
+    src_filename = os.path.join(os.getcwd(), "data", "byte.tif")
+
+    def write_vrt(nodata):
+        # Pad with a comment so that the file is large enough to be cached
+        with open(vrt_filename, "wt") as f:
+            f.write(
+                f"""<VRTDataset rasterXSize="20" rasterYSize="20">
+  <!-- {"x" * (1024 * 1024)} -->
+  <VRTRasterBand dataType="Byte" band="1">
+    <NoDataValue>{nodata}</NoDataValue>
+    <SimpleSource>
+      <SourceFilename relativeToVRT="0">{src_filename}</SourceFilename>
+      <SourceBand>1</SourceBand>
+    </SimpleSource>
+  </VRTRasterBand>
+</VRTDataset>"""
+            )
+
+    with gdaltest.config_option("VRT_XML_CACHE", xml_cache):
+        write_vrt(1)
+        for _ in range(2):
+            with gdal.Open(vrt_filename) as ds:
+                assert ds.GetRasterBand(1).GetNoDataValue() == 1
+                assert ds.GetRasterBand(1).Checksum() == 4672
+
+        # Same file size, different content
+        write_vrt(2)
+        with gdal.Open(vrt_filename) as ds:
+            assert ds.GetRasterBand(1).GetNoDataValue() == 2
+            assert ds.GetRasterBand(1).Checksum() == 4672
+
+
+###############################################################################
+# Test multi-threaded RasterIO() on a VRT whose bands come from different files
+
+
+def test_vrt_read_multithreaded_separate_bands(tmp_vsimem):
+
+    src_ds = gdal.Translate("", "data/rgbsmall.tif", format="MEM")
+    filenames = []
+    for i in range(3):
+        filename = str(tmp_vsimem / f"band{i + 1}.tif")
+        gdal.Translate(filename, src_ds, bandList=[i + 1])
+        filenames.append(filename)
+    vrt_filename = str(tmp_vsimem / "separate.vrt")
+    gdal.BuildVRT(vrt_filename, filenames, separate=True).Close()
+
+    expected = src_ds.ReadRaster(1, 2, 45, 47)
+
+    ds = gdal.OpenEx(vrt_filename, open_options=["NUM_THREADS=2"])
+    assert ds.ReadRaster(1, 2, 45, 47) == expected
+    assert ds.ReadRaster(1, 2, 45, 47, band_list=[3, 1]) == src_ds.ReadRaster(
+        1, 2, 45, 47, band_list=[3, 1]
+    )
+    # Same band requested twice: sources are shared, so not multi-threaded
+    assert ds.ReadRaster(1, 2, 45, 47, band_list=[2, 2]) == src_ds.ReadRaster(
+        1, 2, 45, 47, band_list=[2, 2]
+    )
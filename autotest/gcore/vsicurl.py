@@ -28,6 +28,7 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import json
 import sys
 import time
 
@@ -1142,3 +1143,219 @@ def test_vsicurl_404_repeated_same_resource(server):
 
     with pytest.raises(Exception, match="404"):
         gdal.Open("/vsicurl/http://localhost:%d/does/not/exist.bin" % server.port)
+
+
+###############################################################################
+# Test GDAL_HTTP_CONNECTION_POOL and GDAL_HTTP_MAX_HOST_CONNECTIONS
+
+
+@pytest.mark.parametrize("pool", ["YES", "NO"])
+def test_vsicurl_connection_pool(server, pool):
+
+    gdal.VSICurlClearCache()
+
+    handler = webserver.SequentialHandler()
+    for i in range(3):
+        handler.add(
+            "HEAD", "/test_connection_pool/%d.bin" % i, 200, {"Content-Length": "3"}
+        )
+        handler.add(
+            "GET",
+            "/test_connection_pool/%d.bin" % i,
+            206,
+            {"Content-Length": "3", "Content-Range": "bytes 0-2/3"},
+            "ab%d" % i,
+            expected_headers={"Range": "bytes=0-16383"},
+        )
+
+    with webserver.install_http_handler(handler), gdaltest.config_options(
+        {"GDAL_HTTP_CONNECTION_POOL": pool, "GDAL_HTTP_MAX_HOST_CONNECTIONS": "1"}
+    ):
+        for i in range(3):
+            f = gdal.VSIFOpenL(
+                "/vsicurl/http://localhost:%d/test_connection_pool/%d.bin"
+                % (server.port, i),
+                "rb",
+            )
+            assert f is not None
+            assert gdal.VSIFReadL(1, 3, f) == ("ab%d" % i).encode("ascii")
+            gdal.VSIFCloseL(f)
+
+
+###############################################################################
+# Test CPL_VSIL_CURL_CACHE_DIR
+
+
+def test_vsicurl_cache_dir(server, tmp_path):
+
+    gdal.VSICurlClearCache()
+
+    url = "/vsicurl/http://localhost:%d/test_cache_dir/test.bin" % server.port
+    cache_dir = str(tmp_path / "cache")
+
+    def read_file(etag, expect_get, content=b"abc"):
+        gdal.VSICurlClearCache()
+        handler = webserver.SequentialHandler()
+        handler.add(
+            "HEAD",
+            "/test_cache_dir/test.bin",
+            200,
+            {"Content-Length": "3", "ETag": etag},
+        )
+        if expect_get:
+            handler.add(
+                "GET",
+                "/test_cache_dir/test.bin",
+                206,
+                {"Content-Length": "3", "Content-Range": "bytes 0-2/3"},
+                content,
+                expected_headers={"Range": "bytes=0-16383"},
+            )
+        with webserver.install_http_handler(handler), gdaltest.config_option(
+            "CPL_VSIL_CURL_CACHE_DIR", cache_dir
+        ):
+            f = gdal.VSIFOpenL(url, "rb")
+            assert f is not None
+            data = gdal.VSIFReadL(1, 3, f)
+            gdal.VSIFCloseL(f)
+        return data
+
+    assert read_file('"1"', expect_get=True) == b"abc"
+    assert len(gdal.ReadDir(cache_dir)) == 1
+
+    # Served from the disk cache
+    assert read_file('"1"', expect_get=False) == b"abc"
+
+    # ETag changed: the cached chunk must not be used
+    assert read_file('"2"', expect_get=True, content=b"def") == b"def"
+    assert read_file('"2"', expect_get=False) == b"def"
+
+    # Check trimming of the cache
+    with gdaltest.config_option("CPL_VSIL_CURL_CACHE_DIR_MAX_SIZE", "1"):
+        assert read_file('"3"', expect_get=True, content=b"ghi") == b"ghi"
+    assert len(gdal.ReadDir(cache_dir) or []) <= 1
+
+    gdal.VSICurlClearCache()
+
+
+###############################################################################
+# Test that sequential reads report cache and host transfer statistics
+
+
+def test_vsicurl_read_ahead_stats(server):
+
+    gdal.VSICurlClearCache()
+
+    content = bytes(i % 256 for i in range(200000))
+
+    # The number of GET requests depends on the timings, so we cannot use
+    # a SequentialHandler
+    class RangeHandler:
+        def final_check(self):
+            pass
+
+        def do_HEAD(self, request):
+            request.send_response(200)
+            request.send_header("Content-Length", len(content))
+            request.end_headers()
+
+        def do_GET(self, request):
+            rng = request.headers["Range"][len("bytes=") :].split("-")
+            start = int(rng[0])
+            end = min(int(rng[1]), len(content) - 1)
+            request.send_response(206)
+            request.send_header(
+                "Content-Range", "bytes %d-%d/%d" % (start, end, len(content))
+            )
+            request.send_header("Content-Length", end - start + 1)
+            request.end_headers()
+            request.wfile.write(content[start : end + 1])
+
+    gdal.NetworkStatsReset()
+    try:
+        with webserver.install_http_handler(RangeHandler()), gdaltest.config_option(
+            "CPL_VSIL_NETWORK_STATS_ENABLED", "YES", thread_local=False
+        ):
+            f = gdal.VSIFOpenL(
+                "/vsicurl/http://localhost:%d/test_read_ahead/test.bin" % server.port,
+                "rb",
+            )
+            assert f is not None
+            data = b""
+            while True:
+                chunk = gdal.VSIFReadL(1, 1000, f)
+                if not chunk:
+                    break
+                data += chunk
+            gdal.VSIFCloseL(f)
+        assert data == content
+
+        j = json.loads(gdal.NetworkStatsGetAsSerializedJSON())
+        assert j["cache"]["miss_count"] >= 1
+        assert j["cache"]["hit_count"] > j["cache"]["miss_count"]
+        host = "http://localhost:%d" % server.port
+        assert host in j["hosts"]
+        assert j["hosts"][host]["throughput_bytes_per_sec"] > 0
+    finally:
+        gdal.NetworkStatsReset()
+
+
+###############################################################################
+# Test parallel download of parts for large sequential reads
+
+
+@pytest.mark.parametrize("parts", ["1", "4"])
+def test_vsicurl_parallel_sequential_read(server, parts):
+
+    gdal.VSICurlClearCache()
+
+    content = bytes(i % 251 for i in range(6 * 1024 * 1024))
+    requested_ranges = []
+
+    class RangeHandler:
+        def final_check(self):
+            pass
+
+        def do_HEAD(self, request):
+            request.send_response(200)
+            request.send_header("Content-Length", len(content))
+            request.end_headers()
+
+        def do_GET(self, request):
+            rng = request.headers["Range"][len("bytes=") :].split("-")
+            start = int(rng[0])
+            end = min(int(rng[1]), len(content) - 1)
+            requested_ranges.append((start, end))
+            request.send_response(206)
+            request.send_header(
+                "Content-Range", "bytes %d-%d/%d" % (start, end, len(content))
+            )
+            request.send_header("Content-Length", end - start + 1)
+            request.end_headers()
+            request.wfile.write(content[start : end + 1])
+
+    with webserver.install_http_handler(RangeHandler()), gdaltest.config_option(
+        "CPL_VSIL_CURL_PARALLEL_READ_PARTS", parts
+    ):
+        f = gdal.VSIFOpenL(
+            "/vsicurl/http://localhost:%d/test_parallel_read/test.bin" % server.port,
+            "rb",
+        )
+        assert f is not None
+        data = b""
+        while True:
+            chunk = gdal.VSIFReadL(1, 1024 * 1024, f)
+            if not chunk:
+                break
+            data += chunk
+        gdal.VSIFCloseL(f)
+    assert data == content
+
+    # Whole file downloaded exactly once
+    requested_ranges.sort()
+    assert requested_ranges[0][0] == 0
+    assert requested_ranges[-1][1] == len(content) - 1
+    for i in range(1, len(requested_ranges)):
+        assert requested_ranges[i][0] == requested_ranges[i - 1][1] + 1
+
+    gdal.VSICurlClearCache()
@@ -29,6 +29,7 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import json
 import os
 import sys
 import time
@@ -837,6 +838,174 @@ def test_vsigzip_multi_thread():
         pytest.fail()
 
 
+###############################################################################
+# Test multithreaded decompression of a file made of independent chunks
+
+
+def test_vsigzip_multi_thread_read(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "vsigzip_multi_thread_read.gz")
+    data = "".join("%d," % ((i * 7919) % 1000003) for i in range(800000))
+    data = data.encode("ascii")
+
+    with gdaltest.config_options(
+        {"GDAL_NUM_THREADS": "4", "CPL_VSIL_DEFLATE_CHUNK_SIZE": "32K"}
+    ):
+        f = gdal.VSIFOpenL("/vsigzip/" + filename, "wb")
+        gdal.VSIFWriteL(data, 1, len(data), f)
+        gdal.VSIFCloseL(f)
+    assert gdal.VSIStatL(filename).size > 1024 * 1024
+
+    for i in range(2):
+        with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+            f = gdal.VSIFOpenL("/vsigzip/" + filename, "rb")
+        assert gdal.VSIFReadL(1, len(data) + 1, f) == data
+        assert gdal.VSIFEofL(f)
+        for offset, size in [(1000000, 100000), (10, 20), (len(data) - 5, 10)]:
+            gdal.VSIFSeekL(f, offset, 0)
+            assert gdal.VSIFReadL(1, size, f) == data[offset : offset + size]
+        gdal.VSIFSeekL(f, 0, 2)
+        assert gdal.VSIFTellL(f) == len(data)
+        gdal.VSIFCloseL(f)
+        # The chunk index is written at the end of the first pass, and
+        # used by the second one
+        assert gdal.VSIStatL(filename + ".idx") is not None
+
+
+###############################################################################
+# Test /vsizstd/ and /vsilz4/
+
+
+@pytest.mark.parametrize(
+    "prefix,options",
+    [
+        ("/vsizstd/", {}),
+        ("/vsizstd/", {"GDAL_NUM_THREADS": "2"}),
+        ("/vsizstd/", {"CPL_VSIL_ZSTD_SEEKABLE": "YES"}),
+        (
+            "/vsizstd/",
+            {
+                "CPL_VSIL_ZSTD_SEEKABLE": "YES",
+                "CPL_VSIL_ZSTD_FRAME_SIZE": "16K",
+                "GDAL_NUM_THREADS": "4",
+            },
+        ),
+        ("/vsilz4/", {}),
+        ("/vsilz4/", {"CPL_VSIL_LZ4_LEVEL": "9"}),
+    ],
+)
+def test_vsifile_zstd_lz4(tmp_vsimem, prefix, options):
+
+    if prefix not in gdal.GetFileSystemsPrefixes():
+        pytest.skip(prefix + " not available")
+
+    filename = prefix + str(tmp_vsimem / "test.bin")
+    data = "".join("%d," % ((i * 7919) % 1000003) for i in range(100000))
+    data = data.encode("ascii")
+
+    with gdaltest.config_options(options):
+        f = gdal.VSIFOpenL(filename, "wb")
+        assert f
+        for i in range(0, len(data), 10000):
+            assert gdal.VSIFWriteL(data[i : i + 10000], 1, 10000, f) > 0
+        assert gdal.VSIFCloseL(f) == 0
+
+    assert gdal.VSIStatL(filename).size == len(data)
+
+    f = gdal.VSIFOpenL(filename, "rb")
+    assert f
+    try:
+        assert gdal.VSIFReadL(1, len(data) + 1, f) == data
+        assert gdal.VSIFEofL(f)
+        for offset, size in [(300000, 1000), (10, 20), (len(data) - 5, 10)]:
+            gdal.VSIFSeekL(f, offset, 0)
+            assert gdal.VSIFReadL(1, size, f) == data[offset : offset + size]
+        gdal.VSIFSeekL(f, 0, 2)
+        assert gdal.VSIFTellL(f) == len(data)
+    finally:
+        gdal.VSIFCloseL(f)
+
+
+@pytest.mark.parametrize("prefix", ["/vsizstd/", "/vsilz4/"])
+def test_vsifile_zstd_lz4_stat_cache(tmp_vsimem, prefix):
+
+    if prefix not in gdal.GetFileSystemsPrefixes():
+        pytest.skip(prefix + " not available")
+
+    filename = prefix + str(tmp_vsimem / "test.bin")
+
+    def write(data):
+        f = gdal.VSIFOpenL(filename, "wb")
+        assert f
+        assert gdal.VSIFWriteL(data, 1, len(data), f) == len(data)
+        assert gdal.VSIFCloseL(f) == 0
+
+    write(b"x" * 100000)
+    assert gdal.VSIStatL(filename).size == 100000
+    # Served from the cache of uncompressed sizes
+    assert gdal.VSIStatL(filename).size == 100000
+
+    # Rewriting the file invalidates the cached size, even if the compressed
+    # size is unchanged
+    write(b"y" * 200000)
+    assert gdal.VSIStatL(filename).size == 200000
+
+
+def test_vsifile_zstd_truncated(tmp_vsimem):
+
+    if "/vsizstd/" not in gdal.GetFileSystemsPrefixes():
+        pytest.skip("/vsizstd/ not available")
+
+    filename = str(tmp_vsimem / "test.zst")
+    f = gdal.VSIFOpenL("/vsizstd/" + filename, "wb")
+    gdal.VSIFWriteL(b"x" * 100000 + b"y" * 100000, 1, 200000, f)
+    gdal.VSIFCloseL(f)
+    f = gdal.VSIFOpenL(filename, "rb")
+    data = gdal.VSIFReadL(1, 1000, f)
+    gdal.VSIFCloseL(f)
+    gdal.FileFromMemBuffer(filename, data[0 : len(data) - 10])
+
+    f = gdal.VSIFOpenL("/vsizstd/" + filename, "rb")
+    with gdal.ExceptionMgr(useExceptions=True):
+        with pytest.raises(Exception, match="Truncated"):
+            gdal.VSIFReadL(1, 200000, f)
+    gdal.VSIFCloseL(f)
+
+
+###############################################################################
+# Test /vsimem/ files stored in a memory mapping
+
+
+@pytest.mark.parametrize("use_memfd", ["NO", "YES"])
+def test_vsimem_mmap_storage(tmp_vsimem, use_memfd):
+
+    filename = str(tmp_vsimem / "test.bin")
+    with gdaltest.config_options(
+        {"CPL_VSIMEM_MMAP_THRESHOLD": "100000", "CPL_VSIMEM_USE_MEMFD": use_memfd}
+    ):
+        f = gdal.VSIFOpenL(filename, "wb+")
+        chunk = bytes(range(256)) * 100
+        for _ in range(100):
+            assert gdal.VSIFWriteL(chunk, 1, len(chunk), f) == len(chunk)
+        assert gdal.VSIFFlushL(f) == 0
+        gdal.VSIFTruncateL(f, 12345)
+        gdal.VSIFTruncateL(f, 3000000)
+        gdal.VSIFCloseL(f)
+
+    assert gdal.VSIStatL(filename).size == 3000000
+    data = gdal.VSIGetMemFileBuffer_unsafe(filename)
+    assert bytes(data[0:12345]) == (chunk * 2)[0:12345]
+    assert bytes(data[12345:]) == b"\0" * (3000000 - 12345)
+
+    f = gdal.VSIFOpenL(filename, "ab")
+    gdal.VSIFWriteL(b"x", 1, 1, f)
+    gdal.VSIFCloseL(f)
+    f = gdal.VSIFOpenL(filename, "rb")
+    gdal.VSIFSeekL(f, 3000000, 0)
+    assert gdal.VSIFReadL(1, 10, f) == b"x"
+    gdal.VSIFCloseL(f)
+
+
 ###############################################################################
 # Test vsisync()
 
@@ -1177,6 +1346,44 @@ def test_vsifile_vsimem_truncate_zeroize():
     gdal.VSIFCloseL(f)
 
 
+###############################################################################
+# Test batched ReadMultiRange() with io_uring on local files
+
+
+@pytest.mark.skipif(not sys.platform.startswith("linux"), reason="Linux only")
+@pytest.mark.parametrize("direct", ["NO", "YES"])
+def test_vsifile_io_uring_read_multi_range(tmp_path, direct):
+
+    filename = str(tmp_path / "test.tif")
+    gdal.Translate(
+        filename,
+        "data/byte.tif",
+        width=1000,
+        height=1000,
+        creationOptions=["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16"],
+    )
+    ds = gdal.Open(filename)
+    expected = ds.ReadRaster()
+    expected_window = ds.ReadRaster(5, 7, 500, 300)
+    ds = None
+
+    with gdaltest.config_options(
+        {
+            "CPL_VSIL_USE_IO_URING": "YES",
+            "CPL_VSIL_IO_URING_DIRECT": direct,
+            "CPL_VSIL_IO_URING_QUEUE_DEPTH": "8",
+        }
+    ):
+        ds = gdal.Open(filename)
+        assert ds.ReadRaster() == expected
+        ds = None
+
+        # Window not aligned on tile boundaries
+        ds = gdal.Open(filename)
+        assert ds.ReadRaster(5, 7, 500, 300) == expected_window
+        ds = None
+
+
 ###############################################################################
 # Test VSICopyFile()
 
@@ -1296,3 +1503,44 @@ def test_vsifile_win32_network_path():
     drive_letter = os.getcwd()[0]
     dirname = f"\\\\localhost\\{drive_letter}$"
     assert gdal.VSIStatL(dirname) is not None
+
+
+###############################################################################
+# Test VSIGetStatisticsAsSerializedJSON() and VSIResetStatistics()
+
+
+def test_vsifile_statistics():
+
+    gdal.VSIResetStatistics("/vsimem/")
+    assert json.loads(gdal.VSIGetStatisticsAsSerializedJSON("/vsimem/")) == {}
+
+    filename = "/vsimem/test_vsifile_statistics.bin"
+    f = gdal.VSIFOpenL(filename, "wb")
+    assert gdal.VSIFWriteL(b"0123456789", 1, 10, f) == 10
+    gdal.VSIFCloseL(f)
+    try:
+        assert gdal.VSIStatL(filename).size == 10
+        f = gdal.VSIFOpenL(filename, "rb")
+        assert gdal.VSIFReadL(1, 4, f) == b"0123"
+        assert gdal.VSIFReadL(1, 10, f) == b"456789"
+        gdal.VSIFCloseL(f)
+
+        j = json.loads(gdal.VSIGetStatisticsAsSerializedJSON(filename))
+        assert list(j.keys()) == ["/vsimem/"]
+        stats = j["/vsimem/"]
+        assert stats["open_count"] == 2
+        assert stats["stat_count"] >= 1
+        assert stats["write"] == {"count": 1, "bytes": 10}
+        assert stats["read"]["count"] == 2
+        assert stats["read"]["bytes"] == 10
+        assert sum(stats["read"]["latency_histogram"].values()) == 2
+        assert "requests" not in stats
+
+        # All file systems
+        j = json.loads(gdal.VSIGetStatisticsAsSerializedJSON())
+        assert j["/vsimem/"]["read"]["count"] == 2
+
+        gdal.VSIResetStatistics("/vsimem/")
+        assert json.loads(gdal.VSIGetStatisticsAsSerializedJSON("/vsimem/")) == {}
+    finally:
+        gdal.Unlink(filename)
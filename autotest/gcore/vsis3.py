@@ -2983,6 +2983,60 @@ def test_vsis3_write_multipart_retry(aws_test_config, webserver_port):
                 gdal.VSIFCloseL(f)
 
 
+###############################################################################
+# Test multipart upload with several parts in flight
+
+
+def test_vsis3_write_multipart_parts_in_flight(aws_test_config, webserver_port):
+
+    with gdaltest.config_options(
+        {"VSIS3_CHUNK_SIZE_BYTES": "100", "VSIS3_UPLOAD_PARTS_IN_FLIGHT": "2"},
+        thread_local=False,
+    ):
+        with webserver.install_http_handler(webserver.SequentialHandler()):
+            f = gdal.VSIFOpenL("/vsis3/s3_fake_bucket4/large_file.bin", "wb")
+    assert f is not None
+
+    handler = webserver.SequentialHandler()
+    handler.add(
+        "POST",
+        "/s3_fake_bucket4/large_file.bin?uploads",
+        200,
+        {},
+        """<?xml version="1.0" encoding="UTF-8"?>
+        <InitiateMultipartUploadResult>
+        <UploadId>my_id</UploadId>
+        </InitiateMultipartUploadResult>""",
+    )
+    expected_body = "<CompleteMultipartUpload>\n"
+    for part in range(1, 5):
+        handler.add_unordered(
+            "PUT",
+            "/s3_fake_bucket4/large_file.bin?partNumber=%d&uploadId=my_id" % part,
+            200,
+            {"ETag": '"etag%d"' % part},
+            expected_headers={"Content-Length": "100" if part < 4 else "50"},
+        )
+        expected_body += (
+            '<Part>\n<PartNumber>%d</PartNumber><ETag>"etag%d"</ETag></Part>\n'
+            % (part, part)
+        )
+    expected_body += "</CompleteMultipartUpload>\n"
+    handler.add_unordered(
+        "POST",
+        "/s3_fake_bucket4/large_file.bin?uploadId=my_id",
+        200,
+        expected_body=expected_body.encode("ascii"),
+    )
+
+    gdal.ErrorReset()
+    with webserver.install_http_handler(handler):
+        for i in range(7):
+            assert gdal.VSIFWriteL("x" * 50, 1, 50, f) == 50
+        assert gdal.VSIFCloseL(f) == 0
+    assert gdal.GetLastErrorMsg() == ""
+
+
 ###############################################################################
 # Test abort pending multipart uploads
 
@@ -938,6 +938,17 @@ def test_envi_read_direct_access(byte_order):
         buf_band_space=2,
     )
 
+    # De-interleaving into a band-sequential buffer
+    assert ds.ReadRaster(buf_type=gdal.GDT_UInt16) == src_ds.ReadRaster(
+        buf_type=gdal.GDT_UInt16
+    )
+    assert ds.ReadRaster(1, 2, 3, 4, buf_type=gdal.GDT_UInt16) == src_ds.ReadRaster(
+        1, 2, 3, 4, buf_type=gdal.GDT_UInt16
+    )
+    assert ds.ReadRaster(1, 2, 3, 4, buf_type=gdal.GDT_Float32) == src_ds.ReadRaster(
+        1, 2, 3, 4, buf_type=gdal.GDT_Float32
+    )
+
     # Non-optimized (at time of writing...)
 
     # buffer type != native data type
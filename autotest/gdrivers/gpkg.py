@@ -4299,3 +4299,49 @@ def test_gpkg_gti_gpkg_ext(tmp_vsimem):
     ds = gdal.Open(filename)
     assert ds.GetDriver().ShortName == "GPKG"
     assert ds.GetRasterBand(1).Checksum() == 4672
+
+
+###############################################################################
+# Test reading several tiles at once, with parallel decoding
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+@pytest.mark.parametrize("tile_format", ["PNG", "JPEG"])
+def test_gpkg_read_multiple_tiles(tmp_vsimem, tile_format, num_threads):
+
+    if gdal.GetDriverByName(tile_format) is None:
+        pytest.skip(f"{tile_format} driver missing")
+
+    filename = str(tmp_vsimem / "test_gpkg_read_multiple_tiles.gpkg")
+    gdal.Translate(
+        filename,
+        "data/small_world.tif",
+        format="GPKG",
+        creationOptions=["TILE_FORMAT=" + tile_format, "BLOCKSIZE=64"],
+    )
+
+    # Reference: block per block reading
+    ds = gdal.Open(filename)
+    width, height = ds.RasterXSize, ds.RasterYSize
+    expected = []
+    for i in range(ds.RasterCount):
+        band = ds.GetRasterBand(i + 1)
+        lines = [bytearray() for _ in range(height)]
+        for x in range(0, width, 64):
+            for y in range(0, height, 64):
+                w = min(64, width - x)
+                h = min(64, height - y)
+                data = band.ReadRaster(x, y, w, h)
+                for j in range(h):
+                    lines[y + j] += data[j * w : (j + 1) * w]
+        expected.append(b"".join(bytes(line) for line in lines))
+    ds = None
+
+    with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+        ds = gdal.Open(filename)
+        assert ds.ReadRaster() == b"".join(expected)
+        assert ds.GetRasterBand(2).ReadRaster(10, 20, 150, 100) == b"".join(
+            expected[1][(20 + j) * width + 10 : (20 + j) * width + 160]
+            for j in range(100)
+        )
+        ds = None
@@ -2252,6 +2252,58 @@ def test_grib_grib2_sidecar():
             ) == ds_idx.GetRasterBand(i).GetMetadataItem(key)
 
 
+###############################################################################
+# Test writing a sidecar file with the WRITE_IDX open option
+
+
+def test_grib_grib2_write_sidecar(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test.grib2")
+    gdal.FileFromMemBuffer(
+        filename,
+        open("data/grib/gfs.t06z.pgrb2.10p0.f010.grib2", "rb").read(),
+    )
+
+    ds = gdal.OpenEx(filename, open_options=["WRITE_IDX=YES"])
+    assert ds.RasterCount == 6
+    expected_cs = [ds.GetRasterBand(i + 1).Checksum() for i in range(6)]
+    ds = None
+
+    f = gdal.VSIFOpenL(filename + ".idx", "rb")
+    assert f
+    lines = gdal.VSIFReadL(1, 10000, f).decode("ascii").split("\n")
+    gdal.VSIFCloseL(f)
+    assert lines[0] == "1:0:d=2021091806:REFD:1-HYBL:10 hour fcst:"
+    assert lines[1].startswith("2:")
+    assert ":d=2021091806:REFD:2-HYBL:10 hour fcst:" in lines[1]
+    assert len(lines) == 7 and lines[6] == ""
+
+    ds = gdal.Open(filename)
+    assert ds.RasterCount == 6
+    assert ds.GetRasterBand(1).GetDescription() == "REFD:1-HYBL:10 hour fcst"
+    assert [ds.GetRasterBand(i + 1).Checksum() for i in range(6)] == expected_cs
+
+
+###############################################################################
+# Test multi-band reads, where messages are decoded in parallel
+
+
+def test_grib_grib2_read_multiband_parallel():
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", "1"):
+        ds = gdal.Open("data/grib/gfs.t06z.pgrb2.10p0.f010.grib2")
+        expected_data = [ds.GetRasterBand(i + 1).ReadRaster() for i in range(6)]
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        ds = gdal.Open("data/grib/gfs.t06z.pgrb2.10p0.f010.grib2")
+        assert ds.ReadRaster(band_list=[6, 1, 6]) == b"".join(
+            [expected_data[5], expected_data[0], expected_data[5]]
+        )
+        assert ds.ReadRaster() == b"".join(expected_data)
+        assert ds.GetRasterBand(1).Checksum() == 59985
+        assert ds.GetRasterBand(6).Checksum() == 206
+
+
 # Test reading a (broken) mix of GRIBv2/GRIBv1 bands
 
 
@@ -1054,6 +1054,36 @@ def test_gti_rgb_left_right(tmp_vsimem):
     )
 
 
+@pytest.mark.parametrize("num_threads", ["2", "ALL_CPUS"])
+def test_gti_rgb_left_right_multithreaded(tmp_vsimem, num_threads):
+
+    index_filename = str(tmp_vsimem / "index.gti.gpkg")
+
+    src_ds = gdal.Open("data/small_world.tif")
+
+    tiles = []
+    for i in range(4):
+        tile_filename = str(tmp_vsimem / f"tile{i}.tif")
+        gdal.Translate(tile_filename, src_ds, srcWin=[i * 100, 0, 100, 200])
+        tiles.append(gdal.Open(tile_filename))
+
+    index_ds, _ = create_basic_tileindex(index_filename, tiles)
+    del index_ds
+
+    vrt_ds = gdal.OpenEx(index_filename, open_options=["NUM_THREADS=" + num_threads])
+    assert vrt_ds.ReadRaster() == src_ds.ReadRaster()
+    assert vrt_ds.GetMetadataItem("NUMBER_OF_CONTRIBUTING_SOURCES", "__DEBUG__") == "4"
+
+    assert vrt_ds.ReadRaster(50, 10, 300, 100) == src_ds.ReadRaster(50, 10, 300, 100)
+    assert vrt_ds.GetMetadataItem("NUMBER_OF_CONTRIBUTING_SOURCES", "__DEBUG__") == "4"
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", num_threads):
+        vrt_ds = gdal.Open(index_filename)
+        assert vrt_ds.ReadRaster(0, 0, 400, 200, 200, 100) == src_ds.ReadRaster(
+            0, 0, 400, 200, 200, 100
+        )
+
+
 def test_gti_overlapping_sources(tmp_vsimem):
 
     filename1 = str(tmp_vsimem / "one.tif")
@@ -827,3 +827,73 @@ def test_hdf5_multidim_eos_swath_no_explicit_dimension_map():
         coordinates[1].GetFullName()
         == "/HDFEOS/SWATHS/MySwath/Geolocation Fields/Latitude"
     )
+
+
+###############################################################################
+# Test reading a deflate+shuffle compressed dataset through the direct chunk
+# reading code path, with parallel decompression
+
+
+@pytest.mark.parametrize("direct_chunk_read", ["YES", "NO"])
+def test_hdf5_multidim_read_deflate_shuffle_chunked(direct_chunk_read):
+    def create():
+
+        import h5py
+        import numpy as np
+
+        f = h5py.File("data/hdf5/deflate_shuffle_chunked.h5", "w")
+        dset = f.create_dataset(
+            "test",
+            (37, 53),
+            dtype="h",
+            chunks=(10, 16),
+            shuffle=True,
+            compression="gzip",
+            compression_opts=4,
+            fillvalue=-7,
+        )
+        dset[0:20, :] = np.arange(20 * 53).reshape(20, 53)
+        f.close()
+
+    # create()
+
+    def expected_value(y, x):
+        return y * 53 + x if y < 20 else -7
+
+    with gdaltest.config_options(
+        {"GDAL_HDF5_DIRECT_CHUNK_READ": direct_chunk_read, "GDAL_NUM_THREADS": "4"}
+    ):
+        ds = gdal.OpenEx(
+            "data/hdf5/deflate_shuffle_chunked.h5", gdal.OF_MULTIDIM_RASTER
+        )
+        ar = ds.GetRootGroup().OpenMDArray("test")
+
+        got_data = struct.unpack("h" * (37 * 53), ar.Read())
+        assert got_data == tuple(
+            expected_value(y, x) for y in range(37) for x in range(53)
+        )
+
+        got_data = struct.unpack(
+            "d" * (25 * 30),
+            ar.Read(
+                array_start_idx=[5, 7],
+                count=[25, 30],
+                buffer_datatype=gdal.ExtendedDataType.Create(gdal.GDT_Float64),
+            ),
+        )
+        assert got_data == tuple(
+            float(expected_value(y, x)) for y in range(5, 30) for x in range(7, 37)
+        )
+
+        got_data = struct.unpack("h" * (37 * 53), ar.Transpose([1, 0]).Read())
+        assert got_data == tuple(
+            expected_value(y, x) for x in range(53) for y in range(37)
+        )
+
+        ds = gdal.Open('HDF5:"data/hdf5/deflate_shuffle_chunked.h5"://test')
+        got_data = struct.unpack(
+            "h" * (30 * 40), ds.GetRasterBand(1).ReadRaster(3, 4, 40, 30)
+        )
+        assert got_data == tuple(
+            expected_value(y, x) for y in range(4, 34) for x in range(3, 43)
+        )
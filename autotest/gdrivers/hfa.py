@@ -1288,3 +1288,54 @@ def test_hfa_read_elevation_units():
 
 ###############################################################################
 #
+
+
+###############################################################################
+# Test reading several compressed blocks at once, and building overviews on
+# several bands at once, with multi-threading
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_hfa_multi_block_read_and_multiband_overviews(num_threads, tmp_vsimem):
+
+    src_ds = gdal.Open("data/byte.tif")
+    tile = src_ds.ReadRaster(0, 0, 20, 20)
+    filename = str(tmp_vsimem / "multi_block.img")
+    ds = gdal.GetDriverByName("HFA").Create(
+        filename, 200, 100, 3, options=["COMPRESSED=YES", "BLOCKSIZE=32"]
+    )
+    for i in range(3):
+        for y in range(0, 100, 20):
+            for x in range(0, 200, 20):
+                ds.GetRasterBand(i + 1).WriteRaster(x, y, 20, 20, tile)
+    ds = None
+
+    expected = b"".join(
+        tile[(y % 20) * 20 : (y % 20 + 1) * 20] * 10 for y in range(100)
+    )
+
+    with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+        ds = gdal.Open(filename)
+        for i in range(3):
+            assert ds.GetRasterBand(i + 1).ReadRaster() == expected
+        ds = None
+
+    # Multi-band overview building must give the same result as the
+    # band per band one.
+    ds = gdal.Open(filename, gdal.GA_Update)
+    ds.GetRasterBand(1).BuildOverviews("AVERAGE", [2, 4])
+    expected_cs = [ds.GetRasterBand(1).GetOverview(i).Checksum() for i in range(2)]
+    ds = None
+
+    with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+        ds = gdal.Open(filename, gdal.GA_Update)
+        ds.BuildOverviews("AVERAGE", [2, 4])
+        ds = None
+
+    ds = gdal.Open(filename)
+    for i in range(3):
+        assert ds.GetRasterBand(i + 1).GetOverviewCount() == 2
+        assert [
+            ds.GetRasterBand(i + 1).GetOverview(j).Checksum() for j in range(2)
+        ] == expected_cs
+    ds = None
@@ -3694,6 +3694,48 @@ def test_jp2openjpeg_tilesize_16():
     assert ds.GetRasterBand(1).GetOverview(0).Checksum() == 61711
 
 
+###############################################################################
+# Test reading tiles through the tile-part index, with several tiles decoded
+# in parallel
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+@pytest.mark.parametrize("tileparts", ["DISABLED", "RESOLUTIONS"])
+def test_jp2openjpeg_tile_part_index(tmp_vsimem, num_threads, tileparts):
+
+    filename = str(tmp_vsimem / "test.jp2")
+    src_ds = gdal.Open("data/jpeg2000/tile_size_16.jp2")
+    gdaltest.jp2openjpeg_drv.CreateCopy(
+        filename,
+        src_ds,
+        options=[
+            "BLOCKXSIZE=64",
+            "BLOCKYSIZE=64",
+            "REVERSIBLE=YES",
+            "QUALITY=100",
+            "PROGRESSION=RPCL",
+            "TILEPARTS=" + tileparts,
+        ],
+    )
+
+    with gdaltest.config_options(
+        {"GDAL_NUM_THREADS": num_threads, "JP2OPENJPEG_USE_TILE_PART_INDEX": "NO"}
+    ):
+        ds = gdal.Open(filename)
+        expected_data = ds.ReadRaster()
+        expected_ovr_cs = ds.GetRasterBand(1).GetOverview(0).Checksum()
+        ds = None
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", num_threads):
+        ds = gdal.Open(filename)
+        assert ds.GetRasterBand(1).ReadRaster(64, 64, 64, 64) == src_ds.ReadRaster(
+            64, 64, 64, 64
+        )
+        assert ds.ReadRaster() == expected_data
+        assert ds.ReadRaster() == src_ds.ReadRaster()
+        assert ds.GetRasterBand(1).GetOverview(0).Checksum() == expected_ovr_cs
+
+
 ###############################################################################
 # Test generation of PLT marker segments
 
@@ -1587,6 +1587,42 @@ def test_jpeg_copy_mdd():
     gdal.Unlink(filename)
 
 
+###############################################################################
+# Test reading windows, which may use jpeg_crop_scanline() and
+# jpeg_skip_scanlines(), against full scanline decoding
+
+
+@pytest.mark.parametrize(
+    "filename", ["data/jpeg/albania.jpg", "data/jpeg/rgb_ntf_cmyk.jpg"]
+)
+def test_jpeg_read_cropped_window(filename):
+
+    ds = gdal.Open(filename)
+    xsize = ds.RasterXSize
+    ysize = ds.RasterYSize
+    nbands = ds.RasterCount
+    windows = [
+        (xsize // 2, ysize // 2, xsize // 4, ysize // 4),
+        (1, ysize - 10, xsize // 3, 10),
+        (0, 0, xsize // 2, 3),
+        # Backward, then in the same crop
+        (xsize // 4, 1, 5, 5),
+        (xsize // 4 + 1, 7, 3, 2),
+    ]
+    with gdal.config_option("GDAL_JPEG_CROP_SCANLINES", "NO"):
+        refs = [ds.ReadRaster(*w) for w in windows]
+    ref_cs = [ds.GetRasterBand(i + 1).Checksum() for i in range(nbands)]
+    ds = None
+
+    ds = gdal.Open(filename)
+    for w, ref in zip(windows, refs):
+        assert ds.ReadRaster(*w) == ref, w
+        last_band = ref[(nbands - 1) * w[2] * w[3] :]
+        assert ds.ReadRaster(*w, band_list=[nbands]) == last_band, w
+    # Full scanlines after a cropped decoding
+    assert [ds.GetRasterBand(i + 1).Checksum() for i in range(nbands)] == ref_cs
+
+
 ###############################################################################
 # Cleanup
 
@@ -660,3 +660,49 @@ def test_kea_create_vsimem(tmp_vsimem):
 
     with pytest.raises(Exception):
         gdaltest.kea_driver.Create(tmp_vsimem / "vsitest.kea", 1, 1)
+
+
+###############################################################################
+# Test multi-block reads and building overviews on several bands at once
+
+
+def test_kea_multi_block_read_and_multiband_overviews(tmp_path):
+
+    src_ds = gdal.Open("data/byte.tif")
+    tile = src_ds.ReadRaster(0, 0, 20, 20)
+    filename = tmp_path / "multi_block.kea"
+    ds = gdaltest.kea_driver.Create(filename, 200, 100, 3, options=["IMAGEBLOCKSIZE=32"])
+    for i in range(3):
+        for y in range(0, 100, 20):
+            for x in range(0, 200, 20):
+                ds.GetRasterBand(i + 1).WriteRaster(x, y, 20, 20, tile)
+    ds = None
+
+    expected = b"".join(
+        tile[(y % 20) * 20 : (y % 20 + 1) * 20] * 10 for y in range(100)
+    )
+    ds = gdal.Open(filename)
+    for i in range(3):
+        assert ds.GetRasterBand(i + 1).ReadRaster() == expected
+        assert ds.GetRasterBand(i + 1).ReadRaster(10, 10, 100, 50) == b"".join(
+            expected[y * 200 + 10 : y * 200 + 110] for y in range(10, 60)
+        )
+    ds = None
+
+    ds = gdal.Open(filename, gdal.GA_Update)
+    ds.GetRasterBand(1).BuildOverviews("AVERAGE", [2, 4])
+    expected_cs = [ds.GetRasterBand(1).GetOverview(i).Checksum() for i in range(2)]
+    ds = None
+
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        ds = gdal.Open(filename, gdal.GA_Update)
+        ds.BuildOverviews("AVERAGE", [2, 4])
+        ds = None
+
+    ds = gdal.Open(filename)
+    for i in range(3):
+        assert ds.GetRasterBand(i + 1).GetOverviewCount() == 2
+        assert [
+            ds.GetRasterBand(i + 1).GetOverview(j).Checksum() for j in range(2)
+        ] == expected_cs
+    ds = None
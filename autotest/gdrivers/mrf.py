@@ -645,6 +645,39 @@ def test_mrf_setspatialref():
     gdal.GetDriverByName("MRF").Delete(filename)
 
 
+@pytest.mark.parametrize("interleave", ["BAND", "PIXEL"])
+def test_mrf_multi_tile_read(tmp_vsimem, interleave):
+
+    filename = str(tmp_vsimem / "out.mrf")
+    src_ds = gdal.Open("data/rgbsmall.tif")
+    gdal.Translate(
+        filename,
+        src_ds,
+        format="MRF",
+        creationOptions=[
+            "COMPRESS=DEFLATE",
+            "BLOCKSIZE=16",
+            "INTERLEAVE=" + interleave,
+        ],
+    )
+    expected = src_ds.ReadRaster()
+
+    for options in (
+        ["IDX_CACHE=NO"],
+        ["IDX_CACHE=YES"],
+        ["IDX_PRELOAD=YES"],
+    ):
+        ds = gdal.OpenEx(filename, open_options=options)
+        # Single band window, then dataset window, over several tiles
+        window = (5, 7, 30, 20)
+        assert ds.GetRasterBand(2).ReadRaster(*window) == src_ds.GetRasterBand(
+            2
+        ).ReadRaster(*window)
+        assert ds.ReadRaster() == expected
+        assert ds.GetRasterBand(1).Checksum() == src_ds.GetRasterBand(1).Checksum()
+        ds = None
+
+
 def test_mrf_cleanup():
 
     files = (
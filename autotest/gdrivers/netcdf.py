@@ -5595,6 +5595,14 @@ def test_netcdf_chunked_not_multiple():
     assert ds.GetRasterBand(1).Checksum() == 4672
 
 
+@pytest.mark.parametrize("cache_size", [None, "0", "1000000"])
+def test_netcdf_chunked_chunk_cache_size(cache_size):
+
+    with gdaltest.config_option("GDAL_NETCDF_CHUNK_CACHE_SIZE", cache_size):
+        ds = gdal.Open("data/netcdf/byte_chunked_not_multiple.nc")
+        assert ds.GetRasterBand(1).Checksum() == 4672
+
+
 def test_netcdf_create():
 
     ds = gdaltest.netcdf_drv.Create("tmp/test_create.nc", 2, 2)
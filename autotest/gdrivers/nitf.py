@@ -5723,6 +5723,75 @@ def test_nitf_metadata_validation_des():
     gdal.Unlink(filename)
 
 
+###############################################################################
+# Test that multi-threaded decoding of JPEG compressed multi-block images
+# gives the same result as single-threaded decoding, through dataset
+# RasterIO() and sequential block reading
+
+
+@pytest.mark.parametrize("ic", ["C3", "M3"])
+def test_nitf_jpeg_multithreaded_decoding(tmp_vsimem, ic):
+
+    filename = str(tmp_vsimem / "test_nitf_jpeg_multithreaded_decoding.ntf")
+    src_ds = gdal.Open("data/rgbsmall.tif")
+    gdal.GetDriverByName("NITF").CreateCopy(
+        filename, src_ds, options=["IC=" + ic, "BLOCKSIZE=16"]
+    )
+
+    def read_dataset():
+        ds = gdal.Open(filename)
+        assert ds.GetRasterBand(1).GetBlockSize() == [16, 16]
+        data = ds.ReadRaster()
+        checksums = [ds.GetRasterBand(i + 1).Checksum() for i in range(3)]
+        return data, checksums
+
+    def read_blocks():
+        ds = gdal.Open(filename)
+        nblocks_x = (ds.RasterXSize + 15) // 16
+        nblocks_y = (ds.RasterYSize + 15) // 16
+        blocks = []
+        for y in range(nblocks_y):
+            for x in range(nblocks_x):
+                for i in range(3):
+                    blocks.append(ds.GetRasterBand(i + 1).ReadBlock(x, y))
+        return blocks
+
+    ref_data, ref_checksums = read_dataset()
+    ref_blocks = read_blocks()
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        data, checksums = read_dataset()
+        blocks = read_blocks()
+    assert checksums == ref_checksums
+    assert data == ref_data
+    assert blocks == ref_blocks
+
+
+###############################################################################
+# Test that the cache of segment attachments is invalidated when the file is
+# rewritten, even with the same size
+
+
+def test_nitf_segment_attachments_cache_rewritten_file(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "two_images_jpeg.ntf")
+    content = open("data/nitf/two_images_jpeg.ntf", "rb").read()
+    gdal.FileFromMemBuffer(filename, content)
+
+    ds = gdal.Open("NITF_IM:1:" + filename)
+    assert ds.GetMetadataItem("NITF_CCS_ROW") == "0"
+    ds = None
+
+    # Patch ILOC of the second image segment, without changing the file size
+    assert content[1678:1688] == b"0000000000"
+    content = content[0:1678] + b"0000500000" + content[1688:]
+    gdal.FileFromMemBuffer(filename, content)
+
+    ds = gdal.Open("NITF_IM:1:" + filename)
+    assert ds.GetMetadataItem("NITF_ILOC_ROW") == "5"
+    assert ds.GetMetadataItem("NITF_CCS_ROW") == "5"
+    ds = None
+
+
 ###############################################################################
 # Test NITF21_CGM_ANNO_Uncompressed_unmasked.ntf for bug #1313 and #1714
 
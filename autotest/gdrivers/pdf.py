@@ -3331,3 +3331,36 @@ def test_pdf_iso32000_esri_as_epsg():
     assert sr.GetAuthorityName(None) == "ESRI"
     assert sr.GetAuthorityCode(None) == "102422"
     assert gdal.GetLastErrorMsg() == ""
+
+
+###############################################################################
+# Test BLOCKXSIZE/BLOCKYSIZE open options and multi-threaded rendering
+
+
+@pytest.mark.parametrize("blocksize", [None, 128])
+def test_pdf_multithreaded_rendering(poppler_or_pdfium_or_podofo, blocksize):
+
+    if not pdf_checksum_available():
+        pytest.skip()
+
+    open_options = ["DPI=150"]
+    if blocksize:
+        open_options.append("BLOCKXSIZE=%d" % blocksize)
+
+    def get_checksums():
+        ds = gdal.OpenEx(
+            "data/pdf/adobe_style_geospatial.pdf", open_options=open_options
+        )
+        if blocksize:
+            assert ds.GetRasterBand(1).GetBlockSize() == [blocksize, blocksize]
+        data = ds.ReadRaster()
+        cs = [ds.GetRasterBand(i + 1).Checksum() for i in range(ds.RasterCount)]
+        return data, cs
+
+    ref_data, ref_cs = get_checksums()
+    assert max(ref_cs) != 0
+
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        data, cs = get_checksums()
+    assert cs == ref_cs
+    assert data == ref_data
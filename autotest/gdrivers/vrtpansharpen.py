@@ -2043,6 +2043,100 @@ def test_vrtpansharpen_10():
     assert data == ref_data
 
 
+###############################################################################
+# Test SIMD optimizations with nodata and Float32 against the generic code
+
+
+@pytest.mark.parametrize(
+    "dt,nodata",
+    [
+        (gdal.GDT_Byte, 7),
+        (gdal.GDT_UInt16, 7),
+        (gdal.GDT_UInt16, None),
+        (gdal.GDT_Float32, None),
+    ],
+)
+@pytest.mark.parametrize("nbands_in,nbands_out", [(3, 3), (4, 4), (4, 3)])
+def test_vrtpansharpen_simd(tmp_vsimem, dt, nodata, nbands_in, nbands_out):
+
+    pan_filename = str(tmp_vsimem / "pan.tif")
+    ms_filename = str(tmp_vsimem / "ms.tif")
+    maxval = 250 if dt == gdal.GDT_Byte else 3000
+
+    ds = gdal.GetDriverByName("GTiff").Create(pan_filename, 301, 301, 1, dt)
+    ds.SetGeoTransform([0, 1.0 / 301, 0, 0, 0, 1.0 / 301])
+    ds.WriteRaster(
+        0,
+        0,
+        301,
+        301,
+        struct.pack("f" * 301 * 301, *[(i * 37) % maxval for i in range(301 * 301)]),
+        buf_type=gdal.GDT_Float32,
+    )
+    ds = None
+    ds = gdal.GetDriverByName("GTiff").Create(ms_filename, 75, 75, 4, dt)
+    ds.SetGeoTransform([0, 1.0 / 75, 0, 0, 0, 1.0 / 75])
+    for i in range(4):
+        ds.GetRasterBand(i + 1).WriteRaster(
+            0,
+            0,
+            75,
+            75,
+            struct.pack(
+                "f" * 75 * 75, *[(j * (11 + i)) % maxval for j in range(75 * 75)]
+            ),
+            buf_type=gdal.GDT_Float32,
+        )
+    ds = None
+
+    spectral_bands = ""
+    for i in range(nbands_in):
+        dst_band = ' dstBand="%d"' % (i + 1) if i < nbands_out else ""
+        spectral_bands += """<SpectralBand%s>
+                <SourceFilename>%s</SourceFilename>
+                <SourceBand>%d</SourceBand>
+            </SpectralBand>""" % (
+            dst_band,
+            ms_filename,
+            i + 1,
+        )
+    vrt_ds = gdal.Open(
+        """<VRTDataset subClass="VRTPansharpenedDataset">
+        <PansharpeningOptions>
+            <Resampling>Nearest</Resampling>
+            %s
+            <PanchroBand>
+                <SourceFilename>%s</SourceFilename>
+                <SourceBand>1</SourceBand>
+            </PanchroBand>
+            %s
+        </PansharpeningOptions>
+    </VRTDataset>"""
+        % (
+            "" if nodata is None else "<NoData>%d</NoData>" % nodata,
+            pan_filename,
+            spectral_bands,
+        )
+    )
+
+    # Optimized implementation
+    data = vrt_ds.ReadRaster()
+
+    # Generic implementation
+    ref_buf_type = gdal.GDT_Float64 if dt == gdal.GDT_Float32 else gdal.GDT_Int32
+    tmp_ds = gdal.GetDriverByName("MEM").Create(
+        "", vrt_ds.RasterXSize, vrt_ds.RasterYSize, vrt_ds.RasterCount, ref_buf_type
+    )
+    tmp_ds.WriteRaster(
+        0,
+        0,
+        vrt_ds.RasterXSize,
+        vrt_ds.RasterYSize,
+        vrt_ds.ReadRaster(buf_type=ref_buf_type),
+    )
+    assert data == tmp_ds.ReadRaster(buf_type=dt)
+
+
 ###############################################################################
 # Test gdal.CreatePansharpenedVRT()
 
@@ -1158,3 +1158,53 @@ def test_wms_cache_path():
 
     with pytest.raises(Exception):
         gdal.Open("<GDAL_WMS><Service/><Cache/></GDAL_WMS>")
+
+
+###############################################################################
+# Test fetching of neighbouring tiles with PrefetchMargin, from local tiles
+
+
+@pytest.mark.parametrize("prefetch_margin,expected_tile_count", [(0, 1), (1, 9)])
+def test_wms_tms_prefetch_margin(tmp_path, prefetch_margin, expected_tile_count):
+
+    tile_dir = tmp_path / "tiles"
+    for x in range(4):
+        for y in range(4):
+            os.makedirs(tile_dir / "2" / str(x), exist_ok=True)
+            src_ds = gdal.GetDriverByName("MEM").Create("", 256, 256, 3)
+            src_ds.GetRasterBand(1).Fill(x * 4 + y)
+            gdal.GetDriverByName("PNG").CreateCopy(
+                str(tile_dir / "2" / str(x) / ("%d.png" % y)), src_ds
+            )
+
+    cache_dir = tmp_path / "cache"
+    tms = f"""<GDAL_WMS>
+    <Service name="TMS">
+        <ServerUrl>{tile_dir.as_uri()}/${{z}}/${{x}}/${{y}}.png</ServerUrl>
+    </Service>
+    <DataWindow>
+        <UpperLeftX>-20037508.34</UpperLeftX>
+        <UpperLeftY>20037508.34</UpperLeftY>
+        <LowerRightX>20037508.34</LowerRightX>
+        <LowerRightY>-20037508.34</LowerRightY>
+        <TileLevel>2</TileLevel>
+        <TileCountX>1</TileCountX>
+        <TileCountY>1</TileCountY>
+        <YOrigin>top</YOrigin>
+    </DataWindow>
+    <Projection>EPSG:3857</Projection>
+    <BlockSizeX>256</BlockSizeX>
+    <BlockSizeY>256</BlockSizeY>
+    <BandsCount>3</BandsCount>
+    <PrefetchMargin>{prefetch_margin}</PrefetchMargin>
+    <Cache><Path>{cache_dir}</Path><Unique>false</Unique></Cache>
+</GDAL_WMS>"""
+
+    ds = gdal.Open(tms)
+    assert ds.GetRasterBand(1).ReadRaster(256, 256, 256, 256) == b"\x05" * (
+        256 * 256
+    )
+    ds = None
+
+    tile_count = sum(len(files) for _, _, files in os.walk(cache_dir))
+    assert tile_count == expected_tile_count
@@ -3851,6 +3851,228 @@ def test_zarr_advise_read(compression, format):
         gdal.RmdirRecursive(filename)
 
 
+@pytest.mark.parametrize("format", ["ZARR_V2", "ZARR_V3"])
+@pytest.mark.parametrize("cache_size", [None, "64"])
+def test_zarr_read_multithreaded(tmp_vsimem, format, cache_size):
+
+    filename = str(tmp_vsimem / "test.zarr")
+    # Tile count along dim1 is larger than dim0 size
+    dim0_size = 4
+    dim1_size = 60
+    data = array.array("B", [(i % 253) + 1 for i in range(dim0_size * dim1_size)])
+
+    ds = gdal.GetDriverByName("ZARR").CreateMultiDimensional(
+        filename, options=["FORMAT=" + format]
+    )
+    rg = ds.GetRootGroup()
+    dim0 = rg.CreateDimension("dim0", None, None, dim0_size)
+    dim1 = rg.CreateDimension("dim1", None, None, dim1_size)
+    ar = rg.CreateMDArray(
+        "test",
+        [dim0, dim1],
+        gdal.ExtendedDataType.Create(gdal.GDT_Byte),
+        ["COMPRESS=ZLIB", "BLOCKSIZE=1,2"],
+    )
+    assert ar.Write(data) == gdal.CE_None
+    del ds
+
+    with gdaltest.config_options(
+        {"GDAL_NUM_THREADS": "2", "ZARR_CHUNK_CACHE_SIZE": cache_size}
+    ):
+        ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER)
+        ar = ds.GetRootGroup().OpenMDArray("test")
+        assert ar.Read() == data
+        assert ar.Read(array_start_idx=[1, 3], count=[3, 50]) == array.array(
+            "B",
+            [data[y * dim1_size + x] for y in range(1, 4) for x in range(3, 53)],
+        )
+        assert ar.Read(
+            array_start_idx=[0, 1], count=[2, 15], array_step=[3, 4]
+        ) == array.array(
+            "B",
+            [
+                data[y * dim1_size + x]
+                for y in range(0, 4, 3)
+                for x in range(1, 1 + 15 * 4, 4)
+            ],
+        )
+        assert ar.Read(array_start_idx=[2, 0], count=[2, 20]) == array.array(
+            "B",
+            [data[y * dim1_size + x] for y in range(2, 4) for x in range(20)],
+        )
+        assert ar.Read() == data
+
+
+@pytest.mark.parametrize("format", ["ZARR_V2", "ZARR_V3"])
+def test_zarr_write_multithreaded(tmp_vsimem, format):
+
+    filename = str(tmp_vsimem / "test.zarr")
+    dim0_size = 20
+    dim1_size = 30
+    data = array.array("B", [(i % 253) + 1 for i in range(dim0_size * dim1_size)])
+    # Empty tile
+    for y in range(5):
+        for x in range(5):
+            data[y * dim1_size + x] = 0
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", "2"):
+        ds = gdal.GetDriverByName("ZARR").CreateMultiDimensional(
+            filename, options=["FORMAT=" + format]
+        )
+        rg = ds.GetRootGroup()
+        dim0 = rg.CreateDimension("dim0", None, None, dim0_size)
+        dim1 = rg.CreateDimension("dim1", None, None, dim1_size)
+        ar = rg.CreateMDArray(
+            "test",
+            [dim0, dim1],
+            gdal.ExtendedDataType.Create(gdal.GDT_Byte),
+            ["COMPRESS=ZLIB", "BLOCKSIZE=5,5"],
+        )
+        ar.SetNoDataValueDouble(0)
+        assert ar.Write(array.array("B", [255] * (dim0_size * dim1_size))) == (
+            gdal.CE_None
+        )
+        # Rewrite each line, so that tiles are written several times
+        for y in range(dim0_size):
+            assert (
+                ar.Write(
+                    data[y * dim1_size : (y + 1) * dim1_size],
+                    array_start_idx=[y, 0],
+                    count=[1, dim1_size],
+                )
+                == gdal.CE_None
+            )
+        assert ar.Read() == data
+        del ds
+
+    ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER)
+    ar = ds.GetRootGroup().OpenMDArray("test")
+    assert ar.Read() == data
+
+
+def _crc32c(data):
+    crc = 0xFFFFFFFF
+    for b in data:
+        crc ^= b
+        for _ in range(8):
+            crc = (crc >> 1) ^ (0x82F63B78 if crc & 1 else 0)
+    return crc ^ 0xFFFFFFFF
+
+
+@pytest.mark.parametrize("index_location", ["start", "end"])
+@pytest.mark.parametrize("with_crc32c", [True, False])
+@pytest.mark.parametrize("num_threads", ["1", "2"])
+def test_zarr_read_v3_sharding(tmp_vsimem, index_location, with_crc32c, num_threads):
+
+    filename = str(tmp_vsimem / "test.zarr")
+
+    # Shards of shape [2, 6] made of inner chunks of shape [1, 2]
+    index_codecs = [{"name": "bytes", "configuration": {"endian": "little"}}]
+    if with_crc32c:
+        index_codecs.append({"name": "crc32c"})
+    j = {
+        "zarr_format": 3,
+        "node_type": "array",
+        "shape": [4, 6],
+        "data_type": "uint8",
+        "chunk_grid": {
+            "name": "regular",
+            "configuration": {"chunk_shape": [2, 6]},
+        },
+        "chunk_key_encoding": {"name": "default"},
+        "fill_value": 255,
+        "codecs": [
+            {
+                "name": "sharding_indexed",
+                "configuration": {
+                    "chunk_shape": [1, 2],
+                    "codecs": [],
+                    "index_codecs": index_codecs,
+                    "index_location": index_location,
+                },
+            }
+        ],
+    }
+    gdal.FileFromMemBuffer(filename + "/test/zarr.json", json.dumps(j))
+
+    # Inner chunks 1 and 2 are stored contiguously, followed by chunks 0, 3
+    # and 5. Chunk 4 is missing.
+    chunks = {i: bytes([10 * i + 1, 10 * i + 2]) for i in (0, 1, 2, 3, 5)}
+    order = [1, 2, 0, 3, 5]
+    index_size = 6 * 16 + (4 if with_crc32c else 0)
+    offset = index_size if index_location == "start" else 0
+    entries = [(0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF)] * 6
+    data = b""
+    for i in order:
+        entries[i] = (offset + len(data), len(chunks[i]))
+        data += chunks[i]
+    index = b"".join(struct.pack("<QQ", off, size) for off, size in entries)
+    if with_crc32c:
+        index += struct.pack("<I", _crc32c(index))
+    shard = index + data if index_location == "start" else data + index
+    # Only shard c/0/0 exists
+    gdal.FileFromMemBuffer(filename + "/test/c/0/0", shard)
+
+    expected = array.array(
+        "B",
+        [1, 2, 11, 12, 21, 22, 31, 32, 255, 255, 51, 52] + [255] * 12,
+    )
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", num_threads):
+        ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER)
+        ar = ds.GetRootGroup().OpenMDArray("test")
+        assert ar.GetBlockSize() == [1, 2]
+        assert ar.Read() == expected
+        assert ar.Read(array_start_idx=[1, 1], count=[2, 4]) == array.array(
+            "B", [32, 255, 255, 51, 255, 255, 255, 255]
+        )
+
+    ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER | gdal.OF_UPDATE)
+    ar = ds.GetRootGroup().OpenMDArray("test")
+    with pytest.raises(Exception, match="sharding_indexed"):
+        ar.Write(expected)
+
+
+def test_zarr_read_v3_sharding_invalid_crc32c(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test.zarr")
+    j = {
+        "zarr_format": 3,
+        "node_type": "array",
+        "shape": [2],
+        "data_type": "uint8",
+        "chunk_grid": {
+            "name": "regular",
+            "configuration": {"chunk_shape": [2]},
+        },
+        "chunk_key_encoding": {"name": "default"},
+        "fill_value": 0,
+        "codecs": [
+            {
+                "name": "sharding_indexed",
+                "configuration": {
+                    "chunk_shape": [1],
+                    "codecs": [],
+                    "index_codecs": [
+                        {"name": "bytes", "configuration": {"endian": "little"}},
+                        {"name": "crc32c"},
+                    ],
+                },
+            }
+        ],
+    }
+    gdal.FileFromMemBuffer(filename + "/test/zarr.json", json.dumps(j))
+    index = struct.pack("<QQQQ", 0, 1, 1, 1)
+    gdal.FileFromMemBuffer(
+        filename + "/test/c/0", b"\x01\x02" + index + struct.pack("<I", 0)
+    )
+
+    ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER)
+    ar = ds.GetRootGroup().OpenMDArray("test")
+    with pytest.raises(Exception, match="Invalid CRC32C checksum"):
+        ar.Read()
+
+
 def test_zarr_read_invalid_nczarr_dim():
 
     try:
@@ -205,6 +205,58 @@ def test_gnm_graph_connectedcomponents():
     dn = None
 
 
+###############################################################################
+# A* shortest path
+
+
+def test_gnm_graph_astar():
+
+    ds = gdal.OpenEx("tmp/test_gnm")
+    dn = gnm.CastToNetwork(ds)
+    assert dn is not None, "cast to GNMNetwork failed"
+
+    lyr = dn.GetPath(61, 50, gnm.GATDijkstraShortestPath)
+    expected_count = lyr.GetFeatureCount()
+    dn.ReleaseResultSet(lyr)
+
+    lyr = dn.GetPath(61, 50, gnm.GATAStarShortestPath)
+    assert lyr is not None, "failed to get path"
+    assert lyr.GetFeatureCount() == expected_count
+
+    dn.ReleaseResultSet(lyr)
+    dn = None
+
+
+###############################################################################
+# Contraction hierarchy shortest paths
+
+
+def test_gnm_graph_contraction_hierarchy():
+
+    ds = gdal.OpenEx("tmp/test_gnm")
+    dn = gnm.CastToNetwork(ds)
+    assert dn is not None, "cast to GNMNetwork failed"
+
+    lyr = dn.GetPath(61, 50, gnm.GATDijkstraShortestPath)
+    expected_count = lyr.GetFeatureCount()
+    dn.ReleaseResultSet(lyr)
+
+    lyr = dn.GetPath(61, 50, gnm.GATContractionHierarchyShortestPath)
+    assert lyr is not None, "failed to get path"
+    assert lyr.GetFeatureCount() == expected_count
+    dn.ReleaseResultSet(lyr)
+
+    # One-to-many
+    lyr = dn.GetPath(
+        61, 50, gnm.GATContractionHierarchyShortestPath, options=["target=61"]
+    )
+    assert lyr is not None, "failed to get path"
+    assert set(f["path_num"] for f in lyr) == {1, 2}
+    dn.ReleaseResultSet(lyr)
+
+    dn = None
+
+
 ###############################################################################
 # Network deleting
 
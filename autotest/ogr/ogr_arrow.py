@@ -382,6 +382,45 @@ def test_ogr_arrow_write_compression(compression):
     gdal.Unlink(outfilename)
 
 
+###############################################################################
+# Test reading local compressed files, with and without memory mapping
+
+
+@pytest.mark.parametrize("compression", ["uncompressed", "lz4", "zstd"])
+@pytest.mark.parametrize("mem_map", ["YES", "NO"])
+@pytest.mark.parametrize("fmt", ["FILE", "STREAM"])
+def test_ogr_arrow_read_local_file_mem_map(tmp_path, compression, mem_map, fmt):
+
+    lco = gdal.GetDriverByName("Arrow").GetMetadataItem("DS_LAYER_CREATIONOPTIONLIST")
+    if compression.upper() not in lco:
+        pytest.skip()
+
+    outfilename = str(tmp_path / "out.feather")
+    ds = gdal.GetDriverByName("Arrow").Create(outfilename, 0, 0, 0, gdal.GDT_Unknown)
+    options = ["COMPRESSION=" + compression, "BATCH_SIZE=10", "FORMAT=" + fmt]
+    lyr = ds.CreateLayer("out", geom_type=ogr.wkbPoint, options=options)
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    for i in range(100):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["str"] = "foo%d" % i
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT(%d %d)" % (i, -i)))
+        lyr.CreateFeature(f)
+    ds = None
+
+    with gdaltest.config_options(
+        {"OGR_ARROW_MEM_MAP": mem_map, "GDAL_NUM_THREADS": "ALL_CPUS"}
+    ):
+        ds = ogr.Open(outfilename)
+        lyr = ds.GetLayer(0)
+        assert lyr.GetFeatureCount() == 100
+        for i, f in enumerate(lyr):
+            assert f["str"] == "foo%d" % i
+            assert f.GetGeometryRef().ExportToWkt() == "POINT (%d %d)" % (i, -i)
+        lyr.ResetReading()
+        assert lyr.GetNextFeature()["str"] == "foo0"
+        ds = None
+
+
 ###############################################################################
 # Read invalid file .arrow
 
@@ -1152,3 +1152,57 @@ def test_geom_use_after_transfer_to_feature(tmp_vsimem, arg_type):
 
     with pytest.raises(Exception):
         point.ExportToWkt()
+
+
+###############################################################################
+# Test spatial filtering with a large polygonal filter, for which a grid of
+# cells classified as inside/outside/boundary is used
+
+
+@pytest.mark.require_geos
+@pytest.mark.parametrize("use_arrow", [False, True])
+def test_ogr_basic_spatial_filter_large_polygon(use_arrow):
+    outer = ogr.CreateGeometryFromWkt("POINT (0 0)").Buffer(10, 500)
+    inner = ogr.CreateGeometryFromWkt("POINT (0 0)").Buffer(5, 500)
+    filter_geom = outer.Difference(inner)
+    assert filter_geom.GetGeometryRef(0).GetPointCount() > 1000
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = ds.CreateLayer("test")
+    geoms = []
+    for i in range(-50, 51):
+        for j in range(-50, 51):
+            x = i * 0.25
+            y = j * 0.25
+            if (i + j) % 2 == 0:
+                wkt = "POINT (%f %f)" % (x, y)
+            else:
+                wkt = "LINESTRING (%f %f,%f %f)" % (x, y, x + 0.1, y + 0.1)
+            geoms.append(ogr.CreateGeometryFromWkt(wkt))
+    for geom in geoms:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetGeometry(geom)
+        lyr.CreateFeature(f)
+
+    expected_fids = [
+        fid for fid, geom in enumerate(geoms) if geom.Intersects(filter_geom)
+    ]
+    assert len(expected_fids) > 0
+
+    def get_fids():
+        lyr.SetSpatialFilter(filter_geom)
+        if use_arrow:
+            pytest.importorskip("osgeo.gdal_array")
+            pytest.importorskip("numpy")
+            stream = lyr.GetArrowStreamAsNumPy(options=["USE_MASKED_ARRAYS=NO"])
+            fids = []
+            for batch in stream:
+                fids += list(batch["OGC_FID"])
+        else:
+            fids = [f.GetFID() for f in lyr]
+        lyr.SetSpatialFilter(None)
+        return fids
+
+    assert get_fids() == expected_fids
+    with gdal.config_option("OGR_SPATIAL_FILTER_GRID", "NO"):
+        assert get_fids() == expected_fids
@@ -4015,3 +4015,59 @@ def test_ogr_dxf_read_broken_file_2():
         lyr = ds.GetLayer(0)
         for f in lyr:
             pass
+
+
+###############################################################################
+# Test repeated insertions of the same blocks with merged block geometries,
+# which are only translated once and then transformed for each insertion
+
+
+def test_ogr_dxf_insert_merged_block_repeated():
+
+    def line(x1, y1, x2, y2):
+        return ["0", "LINE", "8", "0", "10", x1, "20", y1, "11", x2, "21", y2]
+
+    def insert(name, x, y, extra=()):
+        return ["0", "INSERT", "8", "0", "2", name, "10", x, "20", y] + list(extra)
+
+    content = (
+        ["0", "SECTION", "2", "BLOCKS"]
+        + ["0", "BLOCK", "2", "STAR", "10", "0", "20", "0", "30", "0"]
+        + line("0", "0", "1", "0")
+        + line("0", "0", "0", "1")
+        + ["0", "ENDBLK"]
+        + ["0", "BLOCK", "2", "OUTER", "10", "0", "20", "0", "30", "0"]
+        + insert("STAR", "100", "0")
+        + ["0", "ENDBLK"]
+        + ["0", "ENDSEC"]
+        + ["0", "SECTION", "2", "ENTITIES"]
+        + insert("STAR", "0", "0")
+        + insert("STAR", "10", "20", ["41", "2", "42", "2", "50", "90"])
+        + insert("STAR", "0", "0")
+        + insert("STAR", "5", "0", ["210", "0", "220", "0", "230", "-1"])
+        + insert("OUTER", "0", "100")
+        + insert("OUTER", "0", "200")
+        + ["0", "ENDSEC", "0", "EOF"]
+    )
+    filename = "/vsimem/test_ogr_dxf_insert_merged_block_repeated.dxf"
+    gdal.FileFromMemBuffer(filename, "\n".join(content) + "\n")
+
+    try:
+        with gdaltest.config_option("DXF_MERGE_BLOCK_GEOMETRIES", "TRUE"):
+            ds = ogr.Open(filename)
+        lyr = ds.GetLayer(0)
+
+        expected = [
+            "MULTILINESTRING ((0 0,1 0),(0 0,0 1))",
+            "MULTILINESTRING ((10 20,10 22),(10 20,8 20))",
+            "MULTILINESTRING ((0 0,1 0),(0 0,0 1))",
+            "MULTILINESTRING ((-5 0,-6 0),(-5 0,-5 1))",
+            "MULTILINESTRING ((100 100,101 100),(100 100,100 101))",
+            "MULTILINESTRING ((100 200,101 200),(100 200,100 201))",
+        ]
+        assert lyr.GetFeatureCount() == len(expected)
+        for wkt in expected:
+            f = lyr.GetNextFeature()
+            ogrtest.check_feature_geometry(f, wkt)
+    finally:
+        gdal.Unlink(filename)
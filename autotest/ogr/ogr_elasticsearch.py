@@ -3484,3 +3484,164 @@ def test_ogr_elasticsearch_upsert_feature(es_url, handle_get, handle_post):
     assert gdal.GetLastErrorMsg() == ""
 
     ds = None
+
+
+###############################################################################
+# Test bulk requests throttled by the server, with several requests in flight
+
+
+def test_ogr_elasticsearch_bulk_throttling(
+    es_url, handle_get, handle_post, handle_put
+):
+
+    handle_get("/fakeelasticsearch", """{"version":{"number":"7.0.0"}}""")
+
+    ds = ogrtest.elasticsearch_drv.CreateDataSource(f"{es_url}/fakeelasticsearch")
+    assert ds is not None
+
+    handle_put("/fakeelasticsearch/test_throttling", "{}")
+    lyr = ds.CreateLayer(
+        "test_throttling",
+        srs=ogrtest.srs_wgs84,
+        options=["GEO_SHAPE_ENCODING=WKT", "BULK_MAX_IN_FLIGHT=2"],
+    )
+    handle_post(
+        """/fakeelasticsearch/test_throttling/_mapping""",
+        post_body="""{ "properties": { "geometry": { "type": "geo_shape" } }, "_meta": { "fid": "ogc_fid" } }""",
+        contents="{}",
+    )
+
+    for wkt in ("POINT (2 49)", "POINT (3 50)"):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+        assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+
+    # Second item rejected with a 429 status, and accepted on retry
+    handle_post(
+        """/fakeelasticsearch/_bulk""",
+        post_body="""{"index" :{"_index":"test_throttling"}}
+{ "ogc_fid": 1, "geometry": "POINT (2 49)" }
+
+{"index" :{"_index":"test_throttling"}}
+{ "ogc_fid": 2, "geometry": "POINT (3 50)" }
+
+""",
+        contents=json.dumps(
+            {
+                "took": 1,
+                "errors": True,
+                "items": [{"index": {"status": 201}}, {"index": {"status": 429}}],
+            },
+            separators=(",", ":"),
+        ),
+    )
+    handle_post(
+        """/fakeelasticsearch/_bulk""",
+        post_body="""{"index" :{"_index":"test_throttling"}}
+{ "ogc_fid": 2, "geometry": "POINT (3 50)" }
+
+""",
+        contents="{}",
+    )
+    gdal.ErrorReset()
+    with gdal.config_option("GDAL_HTTP_RETRY_DELAY", "0.01"):
+        assert lyr.SyncToDisk() == ogr.OGRERR_NONE
+    assert gdal.GetLastErrorMsg() == ""
+
+    # Item rejected with another error
+    f = ogr.Feature(lyr.GetLayerDefn())
+    f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (4 51)"))
+    assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+    handle_post(
+        """/fakeelasticsearch/_bulk""",
+        post_body="""{"index" :{"_index":"test_throttling"}}
+{ "ogc_fid": 3, "geometry": "POINT (4 51)" }
+
+""",
+        contents="""{"took":1,"errors":true,"items":[{"index":{"status":400}}]}""",
+    )
+    with gdal.quiet_errors():
+        assert lyr.SyncToDisk() != ogr.OGRERR_NONE
+    assert '"status":400' in gdal.GetLastErrorMsg()
+
+    ds = None
+
+
+###############################################################################
+# Test reading a layer with a sliced scroll
+
+
+def test_ogr_elasticsearch_sliced_scroll(
+    es_url, handle_get, handle_post, handle_delete
+):
+
+    handle_get("/fakeelasticsearch", """{"version":{"number":"7.0.0"}}""")
+    handle_get("""/fakeelasticsearch/_cat/indices?h=i""", "some_layer\n")
+    handle_get(
+        """/fakeelasticsearch/some_layer/_mapping?pretty""",
+        """
+    {
+        "some_layer":
+        {
+            "mappings":
+            {
+                "properties":
+                {
+                    "some_field": { "type": "integer" },
+                    "geometry": { "type": "geo_point" }
+                }
+            }
+        }
+    }
+    """,
+    )
+
+    def hits(scroll_id, values):
+        return json.dumps(
+            {
+                "_scroll_id": scroll_id,
+                "hits": {
+                    "hits": [
+                        {"_id": str(v), "_source": {"some_field": v}}
+                        for v in values
+                    ]
+                },
+            }
+        )
+
+    for i, values in enumerate(([1], [2])):
+        handle_post(
+            """/fakeelasticsearch/some_layer/_search?scroll=1m&size=100""",
+            post_body='{ "slice": { "id": %d, "max": 2 } }' % i,
+            contents=hits("scroll%d" % i, values),
+        )
+    handle_get(
+        """/fakeelasticsearch/_search/scroll?scroll=1m&scroll_id=scroll0""",
+        hits("scroll0", []),
+    )
+    handle_get(
+        """/fakeelasticsearch/_search/scroll?scroll=1m&scroll_id=scroll1""",
+        hits("scroll1_page2", [3]),
+    )
+    handle_get(
+        """/fakeelasticsearch/_search/scroll?scroll=1m&scroll_id=scroll1_page2""",
+        hits("scroll1_page2", []),
+    )
+
+    ds = gdal.OpenEx(
+        f"ES:{es_url}/fakeelasticsearch",
+        open_options=["SCROLL_SLICES=2", "FEATURE_COUNT_TO_ESTABLISH_FEATURE_DEFN=0"],
+    )
+    assert ds is not None
+    lyr = ds.GetLayer(0)
+    values = [f["some_field"] for f in lyr]
+    assert values == [1, 2, 3]
+
+    # Interrupted iteration: scroll contexts of both slices are cleared
+    lyr.ResetReading()
+    assert lyr.GetNextFeature()["some_field"] == 1
+    handle_delete("/fakeelasticsearch/_search/scroll?scroll_id=scroll0", "{}")
+    handle_delete("/fakeelasticsearch/_search/scroll?scroll_id=scroll1", "{}")
+    gdal.ErrorReset()
+    lyr.ResetReading()
+    assert gdal.GetLastErrorMsg() == ""
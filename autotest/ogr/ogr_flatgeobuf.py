@@ -1257,3 +1257,115 @@ def test_ogr_flatgeobuf_title_description_metadata(tmp_vsimem):
         "foo": "bar",
         "bar": "baz",
     }
+
+
+###############################################################################
+# Test spatially filtered reads through /vsicurl/, where the byte ranges of
+# the found features are coalesced
+
+
+@pytest.mark.require_curl()
+def test_ogr_flatgeobuf_spatial_filter_vsicurl(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test.fgb")
+    ds = ogr.GetDriverByName("FlatGeobuf").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    for i in range(5000):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["str"] = "x" * (i % 100)
+        f.SetGeometry(ogr.CreateGeometryFromWkt(f"POINT({i % 100} {i // 100})"))
+        lyr.CreateFeature(f)
+    ds = None
+
+    envelopes = [(10.5, 10.5, 20.5, 15.5), (-1, -1, 3.5, 49.5), (99, 49, 99, 49)]
+
+    def collect(filename):
+        ds = ogr.Open(filename)
+        lyr = ds.GetLayer(0)
+        ret = []
+        for minx, miny, maxx, maxy in envelopes:
+            lyr.SetSpatialFilterRect(minx, miny, maxx, maxy)
+            ret.append(
+                [(f.GetFID(), f["str"], f.GetGeometryRef().ExportToWkt()) for f in lyr]
+            )
+        return ret
+
+    ref = collect(filename)
+    assert len(ref[0]) == 50
+    assert len(ref[-1]) == 1
+
+    (webserver_process, webserver_port) = webserver.launch(
+        handler=webserver.DispatcherHttpHandler
+    )
+    if webserver_port == 0:
+        pytest.skip("cannot start HTTP server")
+
+    gdal.VSICurlClearCache()
+
+    try:
+        f = gdal.VSIFOpenL(filename, "rb")
+        data = gdal.VSIFReadL(1, gdal.VSIStatL(filename).size, f)
+        gdal.VSIFCloseL(f)
+        handler = webserver.FileHandler({"/test.fgb": data})
+        with webserver.install_http_handler(handler):
+            assert (
+                collect("/vsicurl/http://localhost:%d/test.fgb" % webserver_port)
+                == ref
+            )
+
+    finally:
+        webserver.server_stop(webserver_process, webserver_port)
+
+        gdal.VSICurlClearCache()
+
+
+###############################################################################
+# Test that computing Hilbert codes in parallel gives the same file as the
+# single-threaded path
+
+
+def test_ogr_flatgeobuf_spatial_index_multithreaded(tmp_vsimem):
+
+    def create(filename):
+        ds = ogr.GetDriverByName("FlatGeobuf").CreateDataSource(filename)
+        lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+        lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+        for i in range(2000):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f["id"] = i
+            x = (i * 7919) % 1000
+            y = (i * 104729) % 997
+            f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (%d %d)" % (x, y)))
+            lyr.CreateFeature(f)
+        ds = None
+
+        f = gdal.VSIFOpenL(filename, "rb")
+        assert f
+        try:
+            return gdal.VSIFReadL(1, 10 * 1000 * 1000, f)
+        finally:
+            gdal.VSIFCloseL(f)
+
+    with gdal.config_option("OGR_FLATGEOBUF_NUM_THREADS", "1"):
+        ref_data = create(str(tmp_vsimem / "serial.fgb"))
+
+    with gdal.config_options(
+        {
+            "OGR_FLATGEOBUF_MIN_ITEMS_PER_THREAD": "100",
+            "OGR_FLATGEOBUF_NUM_THREADS": "4",
+        }
+    ):
+        data = create(str(tmp_vsimem / "parallel.fgb"))
+
+    assert data == ref_data
+
+    ds = ogr.Open(str(tmp_vsimem / "parallel.fgb"))
+    lyr = ds.GetLayer(0)
+    assert lyr.GetFeatureCount() == 2000
+    lyr.SetSpatialFilterRect(100, 100, 200, 200)
+    assert lyr.GetFeatureCount() == sum(
+        1
+        for i in range(2000)
+        if 100 <= (i * 7919) % 1000 <= 200 and 100 <= (i * 104729) % 997 <= 200
+    )
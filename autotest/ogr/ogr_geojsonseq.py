@@ -396,3 +396,31 @@ def test_ogr_geojsonseq_vsigzip():
     ds = None
 
     gdal.Unlink(filename)
+
+
+###############################################################################
+# Test SetIgnoredFields()
+
+
+def test_ogr_geojsonseq_ignored_fields():
+
+    features = [
+        '{"type":"Feature","properties":{"a":1,"b":"foo"},'
+        '"geometry":{"type":"Point","coordinates":[2,49]}}',
+        '{"type":"Feature","properties":{"a":2,"b":"bar"},'
+        '"geometry":{"type":"Point","coordinates":[3,50]}}',
+    ]
+    ds = ogr.Open("\n".join(features))
+    lyr = ds.GetLayer(0)
+    assert lyr.TestCapability(ogr.OLCIgnoreFields)
+    assert lyr.SetIgnoredFields(["b", "OGR_GEOMETRY"]) == ogr.OGRERR_NONE
+    f = lyr.GetNextFeature()
+    assert f["a"] == 1
+    assert not f.IsFieldSet("b")
+    assert f.GetGeometryRef() is None
+
+    assert lyr.SetIgnoredFields([]) == ogr.OGRERR_NONE
+    lyr.ResetReading()
+    f = lyr.GetNextFeature()
+    assert f["b"] == "foo"
+    assert f.GetGeometryRef().ExportToWkt() == "POINT (2 49)"
@@ -4242,3 +4242,84 @@ def test_ogr_gml_ignore_old_gfs(tmp_path):
         width = defn.GetFieldDefn(1).GetWidth()
 
         assert width == 10
+
+
+###############################################################################
+# Test SetIgnoredFields()
+
+
+def test_ogr_gml_read_ignored_fields():
+
+    ds = ogr.Open("data/gml/archsites.gml")
+    lyr = ds.GetLayer(0)
+    assert lyr.TestCapability(ogr.OLCIgnoreFields)
+    assert lyr.SetIgnoredFields(["str1", "OGR_GEOMETRY"]) == ogr.OGRERR_NONE
+    f = lyr.GetNextFeature()
+    assert f["cat"] == 1
+    assert not f.IsFieldSet("str1")
+    assert f.GetGeometryRef() is None
+
+    # The geometry is still parsed when needed by the spatial filter
+    lyr.SetSpatialFilterRect(593000, 4914000, 594000, 4915000)
+    lyr.ResetReading()
+    f = lyr.GetNextFeature()
+    assert f["cat"] == 1
+    lyr.SetSpatialFilter(None)
+
+    assert lyr.SetIgnoredFields([]) == ogr.OGRERR_NONE
+    lyr.ResetReading()
+    f = lyr.GetNextFeature()
+    assert f["str1"] == "Signature Rock"
+    assert f.GetGeometryRef() is not None
+
+
+###############################################################################
+# Test that building geometries in several threads gives the same result
+# as a single-threaded read
+
+
+@pytest.mark.parametrize("read_mode", ("STANDARD", "SEQUENTIAL_LAYERS"))
+def test_ogr_gml_read_multithreaded_geometries(tmp_vsimem, read_mode):
+
+    filename = str(tmp_vsimem / "test.gml")
+    with ogr.GetDriverByName("GML").CreateDataSource(
+        filename, options=["FORMAT=GML3"]
+    ) as ds:
+        for lyr_name in ("lyr1", "lyr2"):
+            lyr = ds.CreateLayer(lyr_name, geom_type=ogr.wkbPolygon)
+            lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+            for i in range(1000):
+                f = ogr.Feature(lyr.GetLayerDefn())
+                f["id"] = i
+                if i % 100 == 1:
+                    f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (1 2)"))
+                elif i % 100 != 2:
+                    f.SetGeometry(
+                        ogr.CreateGeometryFromWkt(
+                            f"POLYGON (({i} 0,{i} 1,{i+1} 1,{i} 0))"
+                        )
+                    )
+                lyr.CreateFeature(f)
+
+    def read(num_threads):
+        ret = []
+        with gdal.config_options(
+            {"GDAL_NUM_THREADS": num_threads, "GML_READ_MODE": read_mode}
+        ):
+            with ogr.Open(filename) as ds:
+                for lyr in ds:
+                    for f in lyr:
+                        g = f.GetGeometryRef()
+                        ret.append(
+                            (
+                                lyr.GetName(),
+                                f.GetFID(),
+                                f["id"],
+                                g.ExportToIsoWkt() if g else None,
+                            )
+                        )
+        return ret
+
+    res = read("4")
+    assert len(res) == 2000
+    assert res == read("1")
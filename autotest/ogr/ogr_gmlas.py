@@ -1018,6 +1018,14 @@ class GMLASHTTPHandler(BaseHTTPRequestHandler):
 # Test schema caching
 
 
+def _get_cached_xsd_files():
+    return [
+        x
+        for x in gdal.ReadDir("/vsimem/my/gmlas_cache")
+        if x != "analyzed_schemas"
+    ]
+
+
 @pytest.mark.skipif(
     "SKIP_OGR_GMLAS_HTTP_RELATED" in os.environ,
     reason="test skipped on CI due to timeout on Windows Conda builds with parallel ctest",
@@ -1100,7 +1108,7 @@ def test_ogr_gmlas_cache():
         webserver.server_stop(webserver_process, webserver_port)
         pytest.fail(ds.GetLayerCount())
 
-    gdal.Unlink("/vsimem/my/gmlas_cache/" + gdal.ReadDir("/vsimem/my/gmlas_cache")[0])
+    gdal.Unlink("/vsimem/my/gmlas_cache/" + _get_cached_xsd_files()[0])
 
     # Will reuse the directory and download and cache
     ds = gdal.OpenEx(
@@ -1157,7 +1165,7 @@ def test_ogr_gmlas_cache():
         pytest.fail(gdal.GetLastErrorMsg())
 
     # Re try with non existing cached schema
-    gdal.Unlink("/vsimem/my/gmlas_cache/" + gdal.ReadDir("/vsimem/my/gmlas_cache")[0])
+    gdal.Unlink("/vsimem/my/gmlas_cache/" + _get_cached_xsd_files()[0])
 
     with gdal.quiet_errors():
         ds = gdal.OpenEx(
@@ -1173,11 +1181,93 @@ def test_ogr_gmlas_cache():
     gdal.Unlink("/vsimem/ogr_gmlas_cache.xsd")
     gdal.Unlink("/vsimem/ogr_gmlas_cache_2.xsd")
 
-    files = gdal.ReadDir("/vsimem/my/gmlas_cache")
-    for my_file in files:
-        gdal.Unlink("/vsimem/my/gmlas_cache/" + my_file)
-    gdal.Rmdir("/vsimem/my/gmlas_cache")
-    gdal.Rmdir("/vsimem/my")
+    gdal.RmdirRecursive("/vsimem/my")
+
+
+###############################################################################
+# Test caching of the result of the schema analysis
+
+
+def test_ogr_gmlas_schema_analysis_cache(tmp_vsimem):
+
+    xsd_template = """<xs:schema xmlns:xs="http://www.w3.org/2001/XMLSchema"
+           elementFormDefault="qualified" attributeFormDefault="unqualified">
+<xs:element name="main_elt">
+  <xs:complexType>
+    <xs:sequence>
+        <xs:element name="foo" type="xs:string"/>
+        %s
+    </xs:sequence>
+  </xs:complexType>
+</xs:element>
+</xs:schema>"""
+
+    xsd_filename = str(tmp_vsimem / "test.xsd")
+    gdal.FileFromMemBuffer(xsd_filename, xsd_template % "")
+    gdal.FileFromMemBuffer(
+        tmp_vsimem / "test.xml",
+        """<main_elt xmlns:xsi="http://www.w3.org/2001/XMLSchema-instance"
+                  xsi:noNamespaceSchemaLocation="test.xsd">
+    <foo>bar</foo>
+</main_elt>
+""",
+    )
+
+    cache_dir = str(tmp_vsimem / "cache")
+    conf = (
+        "CONFIG_FILE=<Configuration><SchemaCache><Directory>%s</Directory>"
+        "</SchemaCache></Configuration>" % cache_dir
+    )
+
+    def get_structure():
+        ds = gdal.OpenEx(
+            "GMLAS:" + str(tmp_vsimem / "test.xml"),
+            open_options=[conf, "EXPOSE_METADATA_LAYERS=YES"],
+        )
+        assert ds is not None
+        ret = []
+        for lyr in ds:
+            lyr_defn = lyr.GetLayerDefn()
+            ret.append(
+                (
+                    lyr.GetName(),
+                    [
+                        lyr_defn.GetFieldDefn(i).GetName()
+                        for i in range(lyr_defn.GetFieldCount())
+                    ],
+                )
+            )
+        lyr = ds.GetLayerByName("main_elt")
+        f = lyr.GetNextFeature()
+        assert f["foo"] == "bar"
+        return ret
+
+    structure = get_structure()
+    cached_files = gdal.ReadDir(cache_dir + "/analyzed_schemas")
+    assert cached_files is not None and len(cached_files) == 1
+
+    # Re-open using the cached analysis
+    assert get_structure() == structure
+    assert gdal.ReadDir(cache_dir + "/analyzed_schemas") == cached_files
+
+    # Modification of the schema invalidates the cached analysis
+    gdal.FileFromMemBuffer(
+        xsd_filename,
+        xsd_template % """<xs:element name="bar" type="xs:string" minOccurs="0"/>""",
+    )
+    new_structure = get_structure()
+    assert new_structure != structure
+    assert "bar" in [x for x in new_structure if x[0] == "main_elt"][0][1]
+
+    # Cache disabled
+    conf = (
+        "CONFIG_FILE=<Configuration><SchemaCache><Directory>%s</Directory>"
+        "<CacheSchemaAnalysis>false</CacheSchemaAnalysis>"
+        "</SchemaCache></Configuration>" % cache_dir
+    )
+    gdal.RmdirRecursive(cache_dir)
+    assert get_structure() == new_structure
+    assert gdal.ReadDir(cache_dir + "/analyzed_schemas") is None
 
 
 ###############################################################################
@@ -8284,6 +8284,56 @@ def test_ogr_gpkg_arrow_stream_numpy_multi_threading(
     assert i == num_features
 
 
+###############################################################################
+# Test multi-threaded Arrow interface on a table with holes in FID numbering
+
+
+def test_ogr_gpkg_arrow_stream_numpy_multi_threading_fid_holes(tmp_vsimem):
+    pytest.importorskip("osgeo.gdal_array")
+    pytest.importorskip("numpy")
+
+    filename = tmp_vsimem / "test.gpkg"
+
+    ds = gdal.GetDriverByName("GPKG").Create(filename, 0, 0, 0, gdal.GDT_Unknown)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+    for i in range(1, 1001):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetFID(i if i <= 500 else i + 300)
+        f.SetGeometryDirectly(ogr.CreateGeometryFromWkt(f"POINT({i} {i})"))
+        lyr.CreateFeature(f)
+    lyr.DeleteFeature(3)
+    ds = None
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    with gdaltest.config_option("OGR_GPKG_NUM_THREADS", "4"):
+        stream = lyr.GetArrowStreamAsNumPy(
+            options=["USE_MASKED_ARRAYS=NO", "MAX_FEATURES_IN_BATCH=100"]
+        )
+
+    got_msg = []
+
+    def my_handler(errorClass, errno, msg):
+        got_msg.append(msg)
+        return
+
+    with gdaltest.config_option("CPL_DEBUG", "ON"), gdaltest.error_handler(
+        my_handler
+    ):
+        batches = [batch for batch in stream]
+
+    assert "Using 4 threads" in got_msg
+
+    fids = []
+    for batch in batches:
+        assert len(batch["fid"]) > 0
+        for fid, wkb in zip(batch["fid"], batch["geom"]):
+            i = fid if fid <= 500 else fid - 300
+            assert ogr.CreateGeometryFromWkb(wkb).ExportToIsoWkt() == f"POINT ({i} {i})"
+            fids.append(fid)
+    assert fids == [i for i in range(1, 1301) if i != 3 and not (500 < i <= 800)]
+
+
 ###############################################################################
 # Test Arrow interface with bool fields
 
@@ -10140,3 +10190,132 @@ def test_ogr_gpkg_creation_with_foreign_key_constraint_enabled(tmp_vsimem):
     with gdaltest.config_option("OGR_SQLITE_PRAGMA", "FOREIGN_KEYS=1"):
         out_filename = str(tmp_vsimem / "out.gpkg")
         gdal.VectorTranslate(out_filename, "data/poly.shp")
+
+
+###############################################################################
+# Test OGRLayer::ExplainQuery()
+
+
+@gdaltest.enable_exceptions()
+def test_ogr_gpkg_explain_query(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test_ogr_gpkg_explain_query.gpkg")
+    ds = ogr.GetDriverByName("GPKG").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+    lyr.CreateField(ogr.FieldDefn("foo", ogr.OFTString))
+    f = ogr.Feature(lyr.GetLayerDefn())
+    f["foo"] = "bar"
+    f.SetGeometry(ogr.CreateGeometryFromWkt("POINT(1 2)"))
+    lyr.CreateFeature(f)
+    ds.ExecuteSQL("CREATE INDEX idx_foo ON test(foo)")
+    ds = None
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+
+    plan = lyr.ExplainQuery()
+    assert plan["SPATIAL_FILTER"] == "NONE"
+    assert plan["ATTRIBUTE_FILTER"] == "NONE"
+    assert "BACKEND_PLAN" in plan
+
+    lyr.SetSpatialFilterRect(0, 0, 10, 10)
+    lyr.SetAttributeFilter("foo = 'bar'")
+    lyr.SetIgnoredFields(["OGR_GEOMETRY"])
+    plan = lyr.ExplainQuery()
+    assert plan["SPATIAL_FILTER"] == "INDEX"
+    assert plan["ATTRIBUTE_FILTER"] == "PUSHED_DOWN"
+    assert plan["ATTRIBUTE_INDEX"] == "YES"
+    assert plan["IGNORED_FIELDS"] == "OGR_GEOMETRY"
+    assert "idx_foo" in plan["BACKEND_PLAN"]
+
+
+###############################################################################
+# Test WriteArrowBatch() with geometries encoded by worker threads
+
+
+@gdaltest.enable_exceptions()
+def test_ogr_gpkg_write_arrow_parallel_geometry_encoding(tmp_vsimem):
+
+    src_ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    src_lyr = src_ds.CreateLayer("test")
+    src_lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    for i in range(5000):
+        f = ogr.Feature(src_lyr.GetLayerDefn())
+        f["id"] = i
+        if i == 1234:
+            pass
+        elif i == 2345:
+            f.SetGeometry(
+                ogr.CreateGeometryFromWkt(f"CIRCULARSTRING ({i} 0,{i+1} 1,{i+2} 0)")
+            )
+        else:
+            f.SetGeometry(ogr.CreateGeometryFromWkt(f"POINT ({i} {-i})"))
+        src_lyr.CreateFeature(f)
+
+    filename = tmp_vsimem / "test_ogr_gpkg_write_arrow_parallel.gpkg"
+    ds = gdal.GetDriverByName("GPKG").Create(filename, 0, 0, 0, gdal.GDT_Unknown)
+    lyr = ds.CreateLayer("test")
+    lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+
+    stream = src_lyr.GetArrowStream(
+        ["INCLUDE_FID=NO", "MAX_FEATURES_IN_BATCH=5000"]
+    )
+    schema = stream.GetSchema()
+    with gdaltest.config_option("OGR_GPKG_NUM_THREADS", "4"):
+        while True:
+            array = stream.GetNextRecordBatch()
+            if array is None:
+                break
+            assert lyr.WriteArrowBatch(schema, array)
+    ds = None
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    assert lyr.GetFeatureCount() == 5000
+    assert lyr.GetExtent() == (0, 4999, -4999, 1)
+    f = lyr.GetFeature(1234 + 1)
+    assert f["id"] == 1234
+    assert f.GetGeometryRef() is None
+    f = lyr.GetFeature(4999 + 1)
+    assert f.GetGeometryRef().ExportToIsoWkt() == "POINT (4999 -4999)"
+    f = lyr.GetFeature(2345 + 1)
+    assert f.GetGeometryRef().GetGeometryType() == ogr.wkbCircularString
+    with ds.ExecuteSQL(
+        "SELECT * FROM gpkg_extensions WHERE "
+        "extension_name = 'gpkg_geom_CIRCULARSTRING'"
+    ) as sql_lyr:
+        assert sql_lyr.GetFeatureCount() == 1
+    lyr.SetSpatialFilterRect(10, -20, 20, -10)
+    assert lyr.GetFeatureCount() == 11
+
+
+###############################################################################
+# Test memory-mapped reads through the OGR SQLite VFS
+
+
+@pytest.mark.parametrize("mmap_size", ["0", "268435456"])
+def test_ogr_gpkg_read_mmap(tmp_vsimem, mmap_size):
+
+    filename = tmp_vsimem / "test_ogr_gpkg_read_mmap.gpkg"
+    ds = gdal.GetDriverByName("GPKG").Create(filename, 0, 0, 0, gdal.GDT_Unknown)
+    lyr = ds.CreateLayer("test")
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    lyr.StartTransaction()
+    for i in range(1000):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["str"] = "x" * (i % 100)
+        f.SetGeometry(ogr.CreateGeometryFromWkt(f"POINT ({i} {-i})"))
+        lyr.CreateFeature(f)
+    lyr.CommitTransaction()
+    ds = None
+
+    with gdaltest.config_option("OGR_SQLITE_PRAGMA", f"mmap_size={mmap_size}"):
+        ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    assert lyr.GetFeatureCount() == 1000
+    for i, f in enumerate(lyr):
+        assert f["str"] == "x" * (i % 100)
+        assert f.GetGeometryRef().ExportToIsoWkt() == f"POINT ({i} {-i})"
+    lyr.SetSpatialFilterRect(10, -20, 20, -10)
+    assert lyr.GetFeatureCount() == 11
+    ds = None
@@ -806,3 +806,77 @@ def test_ogr_kml_read_non_conformant_multi_geometries():
     feat = lyr.GetNextFeature()
     wkt = "MULTIPOINT ((0 0))"
     ogrtest.check_feature_geometry(feat, wkt)
+
+
+###############################################################################
+# Test that reading in streaming mode gives the same result as the default
+# mode
+
+
+def _dump_kml_dataset(filename):
+    ret = []
+    ds = ogr.Open(filename)
+    for lyr in ds:
+        features = []
+        for f in lyr:
+            geom = f.GetGeometryRef()
+            features.append(
+                (
+                    f.GetFID(),
+                    f["Name"],
+                    f["Description"],
+                    geom.ExportToIsoWkt() if geom else None,
+                )
+            )
+        ret.append(
+            (lyr.GetName(), lyr.GetGeomType(), lyr.GetFeatureCount(), features)
+        )
+    return ret
+
+
+@pytest.mark.parametrize(
+    "filename",
+    [
+        "data/kml/samples.kml",
+        "data/kml/description_with_xml.kml",
+        "data/kml/emptylayers.kml",
+        "data/kml/folder_with_subfolder_placemark.kml",
+        "data/kml/placemark_in_root_and_subfolder.kml",
+        "data/kml/placemark_with_kml_prefix.kml",
+        "data/kml/non_conformant_multi.kml",
+    ],
+)
+def test_ogr_kml_read_streaming(filename):
+
+    if not ogrtest.have_read_kml:
+        pytest.skip()
+
+    with gdal.config_option("OGR_KML_STREAMING", "NO"):
+        expected = _dump_kml_dataset(filename)
+    with gdal.config_option("OGR_KML_STREAMING", "YES"):
+        got = _dump_kml_dataset(filename)
+    assert got == expected
+
+
+###############################################################################
+# Test reading a KMZ file
+
+
+def test_ogr_kml_read_kmz(tmp_vsimem):
+
+    if not ogrtest.have_read_kml:
+        pytest.skip()
+
+    kmz_filename = str(tmp_vsimem / "test.kmz")
+    f = gdal.VSIFOpenL("/vsizip/" + kmz_filename + "/doc.kml", "wb")
+    assert f
+    data = open("data/kml/samples.kml", "rb").read()
+    gdal.VSIFWriteL(data, 1, len(data), f)
+    gdal.VSIFCloseL(f)
+
+    expected = _dump_kml_dataset("data/kml/samples.kml")
+    ds = ogr.Open(kmz_filename)
+    assert ds.GetDriver().GetDescription() == "KML"
+    ds = None
+    with gdal.config_option("OGR_KML_STREAMING", "YES"):
+        assert _dump_kml_dataset(kmz_filename) == expected
@@ -2751,3 +2751,61 @@ def test_ogr_mem_write_pyarrow_invalid_dict_index(dict_values):
         match="Feature 4, field dict_invalid_index: invalid dictionary index: 3",
     ):
         assert lyr.WritePyArrow(table)
+
+
+###############################################################################
+# Test that spatial filtering through the spatial index returns the same
+# features as without it, and that edits are taken into account
+
+
+@pytest.mark.parametrize("spatial_index", ["YES", "NO"])
+def test_ogr_mem_spatial_index(spatial_index):
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = ds.CreateLayer("test")
+    lyr.CreateField(ogr.FieldDefn("val", ogr.OFTInteger))
+    for i in range(1000):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["val"] = i
+        if i % 100 != 99:
+            f.SetGeometry(
+                ogr.CreateGeometryFromWkt("POINT (%d %d)" % (i % 40, i // 40))
+            )
+        lyr.CreateFeature(f)
+
+    def get_vals():
+        return [f["val"] for f in lyr]
+
+    with gdal.config_option("OGR_MEM_SPATIAL_INDEX", spatial_index):
+        lyr.SetSpatialFilterRect(9.5, 1.5, 12.5, 3.5)
+        assert get_vals() == [90, 91, 92, 130, 131, 132]
+        assert lyr.GetFeatureCount() == 6
+
+        lyr.SetAttributeFilter("val >= 100")
+        assert get_vals() == [130, 131, 132]
+        lyr.SetAttributeFilter(None)
+
+        # Non-rectangular filter
+        poly = ogr.CreateGeometryFromWkt(
+            "POLYGON ((9.5 1.5,9.5 3.5,12.5 3.5,9.5 1.5))"
+        )
+        lyr.SetSpatialFilter(poly)
+        assert get_vals() == [90, 130, 131]
+
+        lyr.SetSpatialFilterRect(9.5, 1.5, 12.5, 3.5)
+        assert lyr.DeleteFeature(91) == ogr.OGRERR_NONE
+        f = lyr.GetFeature(0)
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (11 3)"))
+        assert lyr.SetFeature(f) == ogr.OGRERR_NONE
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["val"] = 1000
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (10 2)"))
+        lyr.CreateFeature(f)
+        lyr.ResetReading()
+        assert get_vals() == [0, 90, 92, 130, 131, 132, 1000]
+
+        lyr.SetSpatialFilterRect(100, 100, 200, 200)
+        assert get_vals() == []
+
+        lyr.SetSpatialFilter(None)
+        assert len(get_vals()) == 1000
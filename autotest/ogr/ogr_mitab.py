@@ -2811,3 +2811,31 @@ def test_ogr_mitab_label_without_text(tmp_vsimem):
 def test_ogr_mitab_write_LCC_2SP_non_metre_unit(tmp_vsimem, ext):
 
     _test_srs(tmp_vsimem, "EPSG:2277", ext=ext)  # "NAD83 / Texas Central (ftUS)"
+
+
+###############################################################################
+# Test that reading through the chunk cache gives the same result as without
+
+
+@pytest.mark.parametrize("with_spatial_filter", [False, True])
+def test_ogr_mitab_read_chunk_size(with_spatial_filter):
+
+    def get_features():
+        ds = ogr.Open("data/mitab/all_geoms.tab")
+        lyr = ds.GetLayer(0)
+        if with_spatial_filter:
+            lyr.SetSpatialFilterRect(-1000, -1000, 1000, 1000)
+        ret = []
+        for f in lyr:
+            g = f.GetGeometryRef()
+            wkt = g.ExportToIsoWkt() if g else None
+            ret.append((f.GetFID(), wkt, f.GetStyleString()))
+        ret.append(lyr.GetFeatureCount())
+        return ret
+
+    with gdaltest.config_option("MITAB_READ_CHUNK_SIZE", "0"):
+        ref = get_features()
+    assert len(ref) > 1
+    with gdaltest.config_option("MITAB_READ_CHUNK_SIZE", "512"):
+        assert get_features() == ref
+    assert get_features() == ref
@@ -1740,5 +1740,57 @@ def test_ogr_mvt_write_reuse_temp_db():
     gdal.Unlink("/vsimem/out.temp.db")
 
 
+###############################################################################
+# Test that tiles encoded by several threads, and written by batches, are the
+# same as with a single thread
+
+
+@pytest.mark.require_driver("SQLite")
+@pytest.mark.require_geos
+def test_ogr_mvt_write_multithreaded_same_as_single_threaded(tmp_vsimem):
+
+    src_ds = gdal.GetDriverByName("Memory").Create("", 0, 0, 0, gdal.GDT_Unknown)
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(3857)
+    lyr = src_ds.CreateLayer("mylayer", srs=srs)
+    lyr.CreateField(ogr.FieldDefn("intfield", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("strfield", ogr.OFTString))
+
+    # 64x64 points, to get more than 1000 tiles up to zoom level 5
+    extent = 20037508.342789244
+    for j in range(64):
+        for i in range(64):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f["intfield"] = i * 64 + j
+            f["strfield"] = "val%d" % (i % 5)
+            x = -extent + (i + 0.5) * 2 * extent / 64
+            y = -extent + (j + 0.5) * 2 * extent / 64
+            f.SetGeometry(ogr.CreateGeometryFromWkt(f"POINT({x} {y})"))
+            lyr.CreateFeature(f)
+
+    def get_content(num_threads):
+        out_filename = str(tmp_vsimem / num_threads / "out")
+        gdal.Mkdir(str(tmp_vsimem / num_threads), 0o755)
+        with gdaltest.config_option("GDAL_NUM_THREADS", num_threads):
+            gdal.VectorTranslate(
+                out_filename,
+                src_ds,
+                format="MVT",
+                datasetCreationOptions=["MAXZOOM=5", "COMPRESS=NO"],
+            )
+        content = {}
+        for name in gdal.ReadDirRecursive(out_filename):
+            full_name = out_filename + "/" + name
+            if not gdal.VSIStatL(full_name).IsDirectory():
+                f = gdal.VSIFOpenL(full_name, "rb")
+                content[name] = gdal.VSIFReadL(1, 1000000, f)
+                gdal.VSIFCloseL(f)
+        return content
+
+    single_threaded = get_content("1")
+    assert len(single_threaded) > 1000
+    assert get_content("4") == single_threaded
+
+
 ###############################################################################
 #
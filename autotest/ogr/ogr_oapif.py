@@ -313,6 +313,117 @@ def test_ogr_oapif_fc_links_next_geojson():
         pytest.fail()
 
 
+###############################################################################
+# Test PREFETCH_NEXT_PAGE=YES
+
+
+def test_ogr_oapif_prefetch_next_page():
+
+    handler = webserver.SequentialHandler()
+    handler.add(
+        "GET",
+        "/oapif/collections",
+        200,
+        {"Content-Type": "application/json"},
+        '{ "collections" : [ { "name": "foo" }] }',
+    )
+    with webserver.install_http_handler(handler):
+        ds = gdal.OpenEx(
+            "OAPIF:http://localhost:%d/oapif" % gdaltest.webserver_port,
+            gdal.OF_VECTOR,
+            open_options=["PREFETCH_NEXT_PAGE=YES"],
+        )
+    lyr = ds.GetLayer(0)
+
+    handler = webserver.SequentialHandler()
+    handler.add(
+        "GET",
+        "/oapif/collections/foo/items?limit=20",
+        200,
+        {"Content-Type": "application/geo+json"},
+        """{ "type": "FeatureCollection", "features": [
+                    {
+                        "type": "Feature",
+                        "properties": {
+                            "foo": "bar"
+                        }
+                    }
+                ] }""",
+    )
+    with webserver.install_http_handler(handler):
+        assert lyr.GetLayerDefn().GetFieldCount() == 1
+
+    def get_page(idx, next_idx):
+        links = ""
+        if next_idx:
+            links = """"links" : [
+                { "rel": "next", "type": "application/geo+json",
+                  "href": "http://localhost:%d/oapif/foo_page%d" }
+            ],""" % (
+                gdaltest.webserver_port,
+                next_idx,
+            )
+        return """{ "type": "FeatureCollection", %s
+                    "features": [
+                    {
+                        "type": "Feature",
+                        "properties": {
+                            "foo": "page%d"
+                        }
+                    }
+                ] }""" % (
+            links,
+            idx,
+        )
+
+    handler = webserver.SequentialHandler()
+    handler.add(
+        "GET",
+        "/oapif/collections/foo/items?limit=1000",
+        200,
+        {"Content-Type": "application/geo+json"},
+        get_page(1, 2),
+    )
+    handler.add(
+        "GET",
+        "/oapif/foo_page2",
+        200,
+        {"Content-Type": "application/geo+json"},
+        get_page(2, 3),
+    )
+    handler.add(
+        "GET",
+        "/oapif/foo_page3",
+        200,
+        {"Content-Type": "application/geo+json"},
+        get_page(3, None),
+    )
+    with webserver.install_http_handler(handler):
+        assert [f["foo"] for f in lyr] == ["page1", "page2", "page3"]
+
+    # Prefetch of the second page is cancelled by ResetReading()
+    handler = webserver.SequentialHandler()
+    handler.add(
+        "GET",
+        "/oapif/collections/foo/items?limit=1000",
+        200,
+        {"Content-Type": "application/geo+json"},
+        get_page(1, 2),
+    )
+    handler.add(
+        "GET",
+        "/oapif/foo_page2",
+        200,
+        {"Content-Type": "application/geo+json"},
+        get_page(2, None),
+    )
+    with webserver.install_http_handler(handler):
+        lyr.ResetReading()
+        f = lyr.GetNextFeature()
+        assert f["foo"] == "page1"
+        lyr.ResetReading()
+
+
 ###############################################################################
 
 
@@ -797,6 +797,57 @@ def test_ogr_openfilegdb_write_create_feature_with_id_set(has_bitmap, ids, sync)
         gdal.RmdirRecursive(dirname)
 
 
+###############################################################################
+# Test that bulk load mode produces the same files as feature-per-feature
+# writing, including when reading features in the middle of the insertion
+
+
+def test_ogr_openfilegdb_write_bulk_load():
+
+    content = {}
+    for bulk_load in ("YES", "NO"):
+        dirname = "/vsimem/out_bulk_load_%s.gdb" % bulk_load
+        try:
+            with gdal.config_option("OPENFILEGDB_BULK_LOAD", bulk_load):
+                ds = ogr.GetDriverByName("OpenFileGDB").CreateDataSource(dirname)
+                lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+                lyr.CreateField(ogr.FieldDefn("int", ogr.OFTInteger))
+                for i in range(2500):
+                    f = ogr.Feature(lyr.GetLayerDefn())
+                    f["int"] = i
+                    f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (%d %d)" % (i, i)))
+                    assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+                    if i == 1500:
+                        f = lyr.GetFeature(1000)
+                        assert f["int"] == 999
+                assert lyr.DeleteFeature(1999) == ogr.OGRERR_NONE
+                ds = None
+
+            content[bulk_load] = []
+            for ext in ("gdbtable", "gdbtablx"):
+                filename = dirname + "/a00000009." + ext
+                f = gdal.VSIFOpenL(filename, "rb")
+                assert f
+                content[bulk_load].append(
+                    gdal.VSIFReadL(1, gdal.VSIStatL(filename).size, f)
+                )
+                gdal.VSIFCloseL(f)
+
+            ds = ogr.Open(dirname)
+            lyr = ds.GetLayer(0)
+            assert lyr.GetFeatureCount() == 2499
+            for f in lyr:
+                assert f["int"] == f.GetFID() - 1
+                assert f.GetGeometryRef().GetX() == f["int"]
+            lyr.SetSpatialFilterRect(1996.5, 1996.5, 1999.5, 1999.5)
+            assert [f.GetFID() for f in lyr] == [1998, 2000]
+            ds = None
+        finally:
+            gdal.RmdirRecursive(dirname)
+
+    assert content["YES"] == content["NO"]
+
+
 ###############################################################################
 
 
@@ -4493,3 +4544,45 @@ def test_ogr_openfilegdb_write_new_datetime_types(tmp_vsimem):
         f = sql_lyr.GetNextFeature()
         assert f["MIN_timestamp_offset"] == "1900/12/31 14:01:01"
         assert f["MAX_timestamp_offset"] == "2023/12/30 14:01:01"
+
+
+###############################################################################
+# Test reading attribute and spatial indices with many leaf pages, that are
+# read by runs of contiguous pages
+
+
+def test_ogr_openfilegdb_write_read_index_many_leaf_pages(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "out.gdb")
+    ds = ogr.GetDriverByName("OpenFileGDB").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+    lyr.CreateField(ogr.FieldDefn("int32", ogr.OFTInteger))
+    N = 20000
+    for i in range(N):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["int32"] = (i * 7919) % N
+        f.SetGeometry(ogr.CreateGeometryFromWkt(f"POINT({i % 200} {i // 200})"))
+        lyr.CreateFeature(f)
+    ds.ExecuteSQL("CREATE INDEX idx_int32 ON test(int32)")
+    ds = None
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+
+    lyr.SetAttributeFilter("int32 >= 100 AND int32 < 15000")
+    assert sorted(f["int32"] for f in lyr) == list(range(100, 15000))
+    lyr.SetAttributeFilter(None)
+
+    for order in ("ASC", "DESC"):
+        with ds.ExecuteSQL(f"SELECT int32 FROM test ORDER BY int32 {order}") as sql_lyr:
+            values = [f["int32"] for f in sql_lyr]
+        expected = list(range(N))
+        if order == "DESC":
+            expected.reverse()
+        assert values == expected
+
+    lyr.SetSpatialFilterRect(10.5, 20.5, 150.5, 80.5)
+    fids = sorted(f.GetFID() for f in lyr)
+    assert fids == sorted(
+        y * 200 + x + 1 for y in range(21, 81) for x in range(11, 151)
+    )
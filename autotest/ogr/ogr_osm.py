@@ -911,3 +911,94 @@ def test_ogr_osm_tags_json():
     assert lyr_defn.GetFieldDefn(other_tags_idx).GetSubType() == ogr.OFSTJSON
     f = lyr.GetNextFeature()
     assert f["other_tags"] == '{"foo":"bar"}'
+
+
+###############################################################################
+# Test that way geometries built by several threads are the same as with a
+# single thread (a batch needs at least 10000 ways to be split among threads)
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_ogr_osm_ways_multithreaded(tmp_vsimem, num_threads):
+
+    if not ogrtest.osm_drv_parse_osm:
+        pytest.skip("Expat support missing")
+
+    nways = 12000
+    content = ["<osm>"]
+    for i in range(nways + 2):
+        lat = 49 + i * 1e-4
+        lon = 2 + (i % 7) * 1e-3
+        content.append(f'<node id="{i + 1}" lat="{lat:.4f}" lon="{lon:.3f}"/>')
+    for i in range(nways):
+        content.append(
+            f'<way id="{i + 1}"><nd ref="{i + 1}"/><nd ref="{i + 2}"/>'
+            f'<nd ref="{i + 3}"/><tag k="highway" v="road{i % 3}"/></way>'
+        )
+    content.append("</osm>")
+    filename = str(tmp_vsimem / "ways.osm")
+    gdal.FileFromMemBuffer(filename, "\n".join(content))
+
+    with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+        ds = ogr.Open(filename)
+    lyr = ds.GetLayerByName("lines")
+    count = 0
+    for f in lyr:
+        i = int(f["osm_id"]) - 1
+        assert i == count
+        assert f["highway"] == f"road{i % 3}"
+        g = f.GetGeometryRef()
+        assert g.GetPointCount() == 3
+        for j in range(3):
+            assert g.GetY(j) == pytest.approx(49 + (i + j) * 1e-4, abs=1e-7)
+            assert g.GetX(j) == pytest.approx(2 + ((i + j) % 7) * 1e-3, abs=1e-7)
+        count += 1
+    assert count == nways
+
+
+###############################################################################
+# Test node lookups with custom indexing, when the temporary nodes file is in
+# memory and when it has been transferred to disk (MAX_TMPFILE_SIZE=0, with
+# more than 1 MB of sectors)
+
+
+@pytest.mark.parametrize("compress_nodes", ["NO", "YES"])
+@pytest.mark.parametrize("max_tmpfile_size", ["0", "100"])
+def test_ogr_osm_custom_indexing_node_lookups(
+    tmp_vsimem, compress_nodes, max_tmpfile_size
+):
+
+    if not ogrtest.osm_drv_parse_osm:
+        pytest.skip("Expat support missing")
+
+    # One node per sector of 64 nodes
+    nnodes = 2500
+    content = ["<osm>"]
+    for i in range(nnodes):
+        lat = 49 + i * 1e-4
+        lon = 2 + (i % 7) * 1e-3
+        content.append(f'<node id="{(i + 1) * 64}" lat="{lat:.4f}" lon="{lon:.3f}"/>')
+    for i in range(nnodes - 1):
+        content.append(
+            f'<way id="{i + 1}"><nd ref="{(i + 1) * 64}"/>'
+            f'<nd ref="{(i + 2) * 64}"/><tag k="highway" v="road"/></way>'
+        )
+    content.append("</osm>")
+    filename = str(tmp_vsimem / "nodes.osm")
+    gdal.FileFromMemBuffer(filename, "\n".join(content))
+
+    with gdal.config_option("OSM_COMPRESS_NODES", compress_nodes):
+        ds = gdal.OpenEx(
+            filename, open_options=["MAX_TMPFILE_SIZE=" + max_tmpfile_size]
+        )
+    lyr = ds.GetLayerByName("lines")
+    count = 0
+    for f in lyr:
+        i = int(f["osm_id"]) - 1
+        g = f.GetGeometryRef()
+        assert g.GetPointCount() == 2
+        for j in range(2):
+            assert g.GetY(j) == pytest.approx(49 + (i + j) * 1e-4, abs=1e-7)
+            assert g.GetX(j) == pytest.approx(2 + ((i + j) % 7) * 1e-3, abs=1e-7)
+        count += 1
+    assert count == nnodes - 1
@@ -3332,3 +3332,292 @@ def test_ogr_parquet_get_extent_3d(tmp_vsimem):
         lyr = ds.GetLayer(0)
         assert lyr.TestCapability(ogr.OLCFastGetExtent3D) == 0
         assert lyr.GetExtent3D() == (1.0, 4.0, 2.0, 5.0, 3.0, 6.0)
+
+
+###############################################################################
+# Test that a GeoParquet 1.1 bbox column is used to pre-filter rows through
+# the ArrowStream API
+
+
+def test_ogr_parquet_arrow_stream_spatial_filter_bbox_column(tmp_path):
+    pa = pytest.importorskip("pyarrow")
+    pq = pytest.importorskip("pyarrow.parquet")
+
+    wkts = [
+        "POINT (1 2)",
+        "LINESTRING (3 4,5 6)",
+        "POINT (10 20)",
+        "POLYGON ((0 0,0 10,10 10,0 0))",
+    ]
+    geoms = [ogr.CreateGeometryFromWkt(wkt).ExportToIsoWkb() for wkt in wkts]
+    # The bbox of the second row is deliberately inconsistent with its
+    # geometry, to check that the bbox column is taken into account.
+    bbox = [
+        {"xmin": 1.0, "ymin": 2.0, "xmax": 1.0, "ymax": 2.0},
+        {"xmin": 100.0, "ymin": 100.0, "xmax": 101.0, "ymax": 101.0},
+        None,
+        {"xmin": 0.0, "ymin": 0.0, "xmax": 10.0, "ymax": 10.0},
+    ]
+    bbox_type = pa.struct(
+        [
+            ("xmin", pa.float64()),
+            ("ymin", pa.float64()),
+            ("xmax", pa.float64()),
+            ("ymax", pa.float64()),
+        ]
+    )
+    table = pa.table(
+        {
+            "id": pa.array(range(len(wkts)), pa.int32()),
+            "geometry": pa.array(geoms, pa.binary()),
+            "bbox": pa.array(bbox, bbox_type),
+        }
+    )
+    geo = {
+        "version": "1.1.0",
+        "primary_column": "geometry",
+        "columns": {
+            "geometry": {
+                "encoding": "WKB",
+                "geometry_types": [],
+                "covering": {
+                    "bbox": {
+                        "xmin": ["bbox", "xmin"],
+                        "ymin": ["bbox", "ymin"],
+                        "xmax": ["bbox", "xmax"],
+                        "ymax": ["bbox", "ymax"],
+                    }
+                },
+            }
+        },
+    }
+    table = table.replace_schema_metadata({"geo": json.dumps(geo)})
+    filename = str(tmp_path / "test.parquet")
+    pq.write_table(table, filename)
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+
+    def get_ids():
+        stream = lyr.GetArrowStreamAsPyArrow()
+        ids = []
+        for batch in stream:
+            ids += batch.field("id").to_pylist()
+        return ids
+
+    with ogrtest.spatial_filter(lyr, 0.5, 1.5, 5.5, 6.5):
+        assert get_ids() == [0, 3]
+
+    # Null bbox: evaluated from the geometry
+    with ogrtest.spatial_filter(lyr, 9.5, 19.5, 10.5, 20.5):
+        assert get_ids() == [2]
+
+
+###############################################################################
+# Test skipping row groups from their statistics with OR, IN and LIKE
+
+
+@pytest.mark.parametrize(
+    "filter,expected_ids,expected_groups",
+    [
+        ("id = 5 OR id = 95", [5, 95], 2),
+        ("id IN (12, 13, 47)", [12, 13, 47], 2),
+        ("str LIKE 'name_03%'", list(range(30, 40)), 1),
+        ("str LIKE 'name_03%' OR id < 3", [0, 1, 2] + list(range(30, 40)), 2),
+        ("(id > 95 OR str = 'name_010') AND id IS NOT NULL", [10, 96, 97, 98, 99], 2),
+        ("id IN (1000, -1)", [], 0),
+        ("NOT (id = 5)", [i for i in range(100) if i != 5], 10),
+    ],
+)
+def test_ogr_parquet_attribute_filter_row_group_skipping(
+    tmp_vsimem, filter, expected_ids, expected_groups
+):
+
+    outfilename = str(tmp_vsimem / "out.parquet")
+    ds = ogr.GetDriverByName("Parquet").CreateDataSource(outfilename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbNone, options=["ROW_GROUP_SIZE=10"])
+    lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    for i in range(100):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["id"] = i
+        f["str"] = "name_%03d" % i
+        lyr.CreateFeature(f)
+    ds = None
+
+    ds = ogr.Open(outfilename)
+    lyr = ds.GetLayer(0)
+
+    debug_msgs = []
+
+    def handler(eErrClass, err_no, msg):
+        if eErrClass == gdal.CE_Debug:
+            debug_msgs.append(msg)
+
+    gdal.PushErrorHandler(handler)
+    try:
+        with gdaltest.config_option("CPL_DEBUG", "ON"):
+            lyr.SetAttributeFilter(filter)
+            ids = [f["id"] for f in lyr]
+    finally:
+        gdal.PopErrorHandler()
+    assert ids == expected_ids
+    if expected_groups < 10:
+        assert "%d/10 row groups selected" % expected_groups in debug_msgs
+
+    with gdaltest.config_option("OGR_PARQUET_OPTIMIZED_ATTRIBUTE_FILTER", "NO"):
+        lyr.SetAttributeFilter(filter)
+        assert [f["id"] for f in lyr] == expected_ids
+
+
+###############################################################################
+# Test SORT_BY_BBOX=YES
+
+
+@pytest.mark.parametrize("fid", [None, "fid"])
+def test_ogr_parquet_write_sort_by_bbox(tmp_vsimem, fid):
+
+    outfilename = str(tmp_vsimem / "out.parquet")
+    ds = ogr.GetDriverByName("Parquet").CreateDataSource(outfilename)
+    options = ["SORT_BY_BBOX=YES", "ROW_GROUP_SIZE=25"]
+    if fid:
+        options.append("FID=" + fid)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint, options=options)
+    assert lyr.TestCapability(ogr.OLCFastWriteArrowBatch) == 0
+    lyr.CreateField(ogr.FieldDefn("quadrant", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("int_list", ogr.OFTIntegerList))
+    # Interleave features from the four quadrants of [0,100]x[0,100]
+    for i in range(100):
+        quadrant = i % 4
+        x = (quadrant % 2) * 50 + (i // 4) % 5 * 10
+        y = (quadrant // 2) * 50 + (i // 20) * 10
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["quadrant"] = quadrant
+        f["int_list"] = [i, i + 1]
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (%d %d)" % (x, y)))
+        if fid:
+            f.SetFID(1000 + i)
+        assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+    f = ogr.Feature(lyr.GetLayerDefn())
+    f["quadrant"] = -1
+    assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+    assert lyr.GetFeatureCount() == 101
+    ds = None
+
+    assert gdal.VSIStatL(outfilename + ".tmp.gpkg") is None
+
+    ds = ogr.Open(outfilename)
+    lyr = ds.GetLayer(0)
+    assert lyr.GetFeatureCount() == 101
+    assert lyr.GetMetadataItem("NUM_ROW_GROUPS", "_PARQUET_") == "5"
+    assert lyr.GetExtent() == (0, 90, 0, 90)
+    features = [f for f in lyr]
+    # Each group of 25 rows is in a single quadrant
+    for i in range(4):
+        assert len(set(f["quadrant"] for f in features[i * 25 : (i + 1) * 25])) == 1
+    # Features without geometry are written last
+    assert features[-1]["quadrant"] == -1
+    assert features[-1].GetGeometryRef() is None
+    for f in features[0:-1]:
+        i = f["int_list"][0]
+        assert f["int_list"] == [i, i + 1]
+        assert f["quadrant"] == i % 4
+        if fid:
+            assert f.GetFID() == 1000 + i
+    ds = None
+
+
+###############################################################################
+# Test SORT_BY_BBOX=YES on a layer without geometry field
+
+
+def test_ogr_parquet_write_sort_by_bbox_no_geometry(tmp_vsimem):
+
+    outfilename = str(tmp_vsimem / "out.parquet")
+    ds = ogr.GetDriverByName("Parquet").CreateDataSource(outfilename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbNone, options=["SORT_BY_BBOX=YES"])
+    f = ogr.Feature(lyr.GetLayerDefn())
+    with pytest.raises(Exception, match="single geometry field"):
+        lyr.CreateFeature(f)
+    ds = None
+
+
+###############################################################################
+# Test writing a Hive-style partitioned dataset
+
+
+@pytest.mark.parametrize("max_open_files", [1, 64])
+def test_ogr_parquet_write_partitioned(tmp_vsimem, max_open_files):
+
+    outdirname = str(tmp_vsimem / "out")
+    ds = gdal.GetDriverByName("Parquet").Create(
+        outdirname,
+        0,
+        0,
+        0,
+        gdal.GDT_Unknown,
+        options=["PARTITION_BY=country", "MAX_OPEN_FILES=%d" % max_open_files],
+    )
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint, options=["FID=fid"])
+    lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("country", ogr.OFTString))
+    countries = ["France", "Côte d'Ivoire", None]
+    for i in range(30):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["id"] = i
+        f["country"] = countries[i % 3]
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (%d %d)" % (i, i)))
+        assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+    assert lyr.TestCapability(ogr.OLCCreateField) == 0
+    assert lyr.GetFeatureCount() == 30
+    ds = None
+
+    files = sorted(gdal.ReadDirRecursive(outdirname))
+    if max_open_files == 1:
+        # Each feature goes to a different partition than the previous one,
+        # which causes a new file to be created
+        assert len([x for x in files if x.endswith(".parquet")]) == 30
+    else:
+        assert files == [
+            "country=C%C3%B4te%20d%27Ivoire/",
+            "country=C%C3%B4te%20d%27Ivoire/part-00000.parquet",
+            "country=France/",
+            "country=France/part-00000.parquet",
+            "country=__HIVE_DEFAULT_PARTITION__/",
+            "country=__HIVE_DEFAULT_PARTITION__/part-00000.parquet",
+        ]
+
+    # The partition field is not stored in the files
+    ds = ogr.Open(outdirname + "/country=France/part-00000.parquet")
+    lyr = ds.GetLayer(0)
+    assert lyr.GetLayerDefn().GetFieldIndex("country") < 0
+    f = lyr.GetNextFeature()
+    assert f.GetFID() == 0
+    assert f["id"] == 0
+    assert f.GetGeometryRef().ExportToWkt() == "POINT (0 0)"
+    ds = None
+
+    if _has_arrow_dataset():
+        ds = ogr.Open(outdirname)
+        lyr = ds.GetLayer(0)
+        assert lyr.GetFeatureCount() == 30
+        lyr.SetAttributeFilter("country = 'France'")
+        assert sorted(f["id"] for f in lyr) == list(range(0, 30, 3))
+        ds = None
+
+
+###############################################################################
+# Test writing a partitioned dataset with a non-existing partition field
+
+
+def test_ogr_parquet_write_partitioned_wrong_field(tmp_vsimem):
+
+    outdirname = str(tmp_vsimem / "out")
+    ds = gdal.GetDriverByName("Parquet").Create(
+        outdirname, 0, 0, 0, gdal.GDT_Unknown, options=["PARTITION_BY=unknown"]
+    )
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbNone)
+    f = ogr.Feature(lyr.GetLayerDefn())
+    with pytest.raises(Exception, match="PARTITION_BY field 'unknown' does not exist"):
+        lyr.CreateFeature(f)
+    ds = None
@@ -28,6 +28,7 @@
 ###############################################################################
 
 import functools
+import math
 import os
 import re
 import sys
@@ -5912,3 +5913,164 @@ def test_ogr_pg_schema_case_createlayer(pg_ds, tmp_schema):
             assert lyr is None
     finally:
         pg_ds.ExecuteSQL(f'DROP SCHEMA "{tmp_schema_uppercase}" CASCADE')
+
+
+###############################################################################
+# Test that binary COPY gives the same results as text COPY
+
+
+@pytest.mark.parametrize("binary_copy", ("YES", "NO"))
+def test_ogr_pg_binary_copy(pg_ds, binary_copy):
+
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(4326)
+
+    with gdal.config_options(
+        {"PG_USE_COPY": "YES", "PG_USE_BINARY_COPY": binary_copy}
+    ):
+        lyr = pg_ds.CreateLayer(
+            "test_ogr_pg_binary_copy",
+            geom_type=ogr.wkbPoint,
+            srs=srs,
+            options=["OVERWRITE=YES"],
+        )
+        fld_defn = ogr.FieldDefn("bool", ogr.OFTInteger)
+        fld_defn.SetSubType(ogr.OFSTBoolean)
+        lyr.CreateField(fld_defn)
+        fld_defn = ogr.FieldDefn("int16", ogr.OFTInteger)
+        fld_defn.SetSubType(ogr.OFSTInt16)
+        lyr.CreateField(fld_defn)
+        lyr.CreateField(ogr.FieldDefn("int", ogr.OFTInteger))
+        lyr.CreateField(ogr.FieldDefn("int64", ogr.OFTInteger64))
+        fld_defn = ogr.FieldDefn("float32", ogr.OFTReal)
+        fld_defn.SetSubType(ogr.OFSTFloat32)
+        lyr.CreateField(fld_defn)
+        lyr.CreateField(ogr.FieldDefn("real", ogr.OFTReal))
+        fld_defn = ogr.FieldDefn("str", ogr.OFTString)
+        fld_defn.SetWidth(3)
+        lyr.CreateField(fld_defn)
+        fld_defn = ogr.FieldDefn("json", ogr.OFTString)
+        fld_defn.SetSubType(ogr.OFSTJSON)
+        lyr.CreateField(fld_defn)
+        lyr.CreateField(ogr.FieldDefn("binary", ogr.OFTBinary))
+        lyr.CreateField(ogr.FieldDefn("date", ogr.OFTDate))
+        lyr.CreateField(ogr.FieldDefn("datetime", ogr.OFTDateTime))
+
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["bool"] = 1
+        f["int16"] = -32768
+        f["int"] = -123456789
+        f["int64"] = 1234567890123
+        f["float32"] = 1.5
+        f["real"] = float("nan")
+        f["str"] = "étés\t\\"
+        f["json"] = '{"a": [1, 2]}'
+        f.SetFieldBinaryFromHexString("binary", "00FF5C")
+        f["date"] = "1999/12/31"
+        f["datetime"] = "1890/01/02 03:04:05.678+0530"
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (1 2)"))
+        assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["real"] = -1.25e300
+        f["date"] = "2030/06/15"
+        f["datetime"] = "2030/06/15 12:00:00Z"
+        assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+
+        # Date-time without time zone: switch to text COPY
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["int"] = 3
+        f["datetime"] = "2030/06/15 12:00:00"
+        assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["int"] = 4
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (3 4)"))
+        assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+
+    ds = reconnect(pg_ds, update=1)
+    ds.ExecuteSQL('set timezone to "UTC"')
+    lyr = ds.GetLayerByName("test_ogr_pg_binary_copy")
+    assert lyr.GetFeatureCount() == 4
+
+    f = lyr.GetNextFeature()
+    assert f.GetFID() == 1
+    assert f["bool"] == 1
+    assert f["int16"] == -32768
+    assert f["int"] == -123456789
+    assert f["int64"] == 1234567890123
+    assert f["float32"] == 1.5
+    assert math.isnan(f["real"])
+    assert f["str"] == "été"
+    assert f["json"] == '{"a": [1, 2]}'
+    assert f.GetFieldAsBinary("binary") == b"\x00\xff\x5c"
+    assert f["date"] == "1999/12/31"
+    assert f["datetime"] == "1890/01/01 21:34:05.678+00"
+    assert f.GetGeometryRef().ExportToWkt() == "POINT (1 2)"
+
+    f = lyr.GetNextFeature()
+    assert f["real"] == -1.25e300
+    assert f["date"] == "2030/06/15"
+    assert f["datetime"] == "2030/06/15 12:00:00+00"
+    assert f.IsFieldNull("int")
+    assert f.GetGeometryRef() is None
+
+    f = lyr.GetNextFeature()
+    assert f["int"] == 3
+    assert f["datetime"] is not None
+
+    f = lyr.GetNextFeature()
+    assert f["int"] == 4
+    assert f.GetGeometryRef().ExportToWkt() == "POINT (3 4)"
+
+
+###############################################################################
+# Test reading a layer through several connections
+
+
+@pytest.mark.parametrize("ordered", ("YES", "NO"))
+def test_ogr_pg_parallel_read(pg_ds, ordered):
+
+    lyr = pg_ds.CreateLayer(
+        "test_ogr_pg_parallel_read",
+        geom_type=ogr.wkbPoint,
+        options=["OVERWRITE=YES"],
+    )
+    lyr.CreateField(ogr.FieldDefn("val", ogr.OFTInteger))
+    with gdaltest.config_option("PG_USE_COPY", "YES"):
+        for i in range(1000):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f["val"] = i
+            f.SetGeometry(ogr.CreateGeometryFromWkt(f"POINT ({i} {i})"))
+            lyr.CreateFeature(f)
+
+    ds = reconnect(pg_ds)
+    lyr = ds.GetLayerByName("test_ogr_pg_parallel_read")
+    lyr.SetAttributeFilter("val >= 10")
+    lyr.SetSpatialFilterRect(0, 0, 900, 900)
+
+    with gdal.config_options(
+        {
+            "OGR_PG_NUM_THREADS": "4",
+            "OGR_PG_PARALLEL_READ_ORDERED": ordered,
+            "OGR_PG_CURSOR_PAGE": "17",
+        }
+    ):
+        fids = [f.GetFID() for f in lyr]
+        for f in lyr:
+            assert f["val"] == f.GetFID() - 1
+            assert f.GetGeometryRef().GetX() == f["val"]
+            break
+
+        assert lyr.SetNextByIndex(5) == ogr.OGRERR_NONE
+        f = lyr.GetNextFeature()
+        fid_at_index_5 = f.GetFID()
+
+    if ordered == "YES":
+        assert fids == list(range(11, 902))
+    else:
+        assert sorted(fids) == list(range(11, 902))
+
+    lyr.ResetReading()
+    assert [f.GetFID() for f in lyr] == list(range(11, 902))
+    assert fid_at_index_5 == 16
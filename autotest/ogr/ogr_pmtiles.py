@@ -585,6 +585,61 @@ def test_ogr_pmtiles_write():
             gdal.Unlink(filename)
 
 
+###############################################################################
+# Test deduplication of tiles when writing directly to PMTiles
+
+
+@pytest.mark.require_driver("MBTiles")
+# MBTiles vector writing mode requires SQLite and GEOS
+@pytest.mark.require_driver("SQLite")
+@pytest.mark.require_geos
+def test_ogr_pmtiles_write_deduplication():
+
+    filename = "/vsimem/test_ogr_pmtiles_write_deduplication.pmtiles"
+    try:
+        ds = ogr.GetDriverByName("PMTiles").CreateDataSource(
+            filename, options=["MINZOOM=2", "MAXZOOM=2"]
+        )
+        lyr = ds.CreateLayer("test")
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetGeometry(
+            ogr.CreateGeometryFromWkt(
+                "POLYGON((-20000000 -20000000,-20000000 20000000,20000000 20000000,20000000 -20000000,-20000000 -20000000))"
+            )
+        )
+        lyr.CreateFeature(f)
+        ds = None
+
+        f = gdal.VSIFOpenL(f"/vsipmtiles/{filename}/pmtiles_header.json", "rb")
+        assert f
+        try:
+            data = gdal.VSIFReadL(1, 10000, f)
+        finally:
+            gdal.VSIFCloseL(f)
+        got = json.loads(data)
+
+        expected = {
+            "addressed_tiles_count": 16,
+            "tile_contents_count": 9,
+            "tile_entries_count": 13,
+            "clustered": True,
+        }
+
+        for key in expected:
+            assert got[key] == expected[key], (key, got)
+
+        # No leftover temporary files
+        assert gdal.ReadDir("/vsimem/") is None or not [
+            x
+            for x in gdal.ReadDir("/vsimem/")
+            if x.startswith("test_ogr_pmtiles_write_deduplication")
+            and not x.endswith(".pmtiles")
+        ]
+    finally:
+        if gdal.VSIStatL(filename):
+            gdal.Unlink(filename)
+
+
 ###############################################################################
 
 
@@ -6066,3 +6066,173 @@ def test_ogr_shape_arrow_stream_fid_optim(tmp_vsimem):
         == "YES"
     )
     assert len(batches) == 0
+
+
+###############################################################################
+# Test GetArrowStream() with NUM_THREADS
+
+
+@pytest.mark.parametrize("attr_filter", [None, "id % 3 = 0"])
+def test_ogr_shape_arrow_stream_num_threads(tmp_vsimem, attr_filter):
+    pytest.importorskip("osgeo.gdal_array")
+    numpy = pytest.importorskip("numpy")
+
+    filename = str(tmp_vsimem / "test_ogr_shape_arrow_stream_num_threads.shp")
+    ds = ogr.GetDriverByName("ESRI Shapefile").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test_ogr_shape_arrow_stream_num_threads")
+    lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    for i in range(20000):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["id"] = i
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (%d %d)" % (i, -i)))
+        lyr.CreateFeature(f)
+    ds = None
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    lyr.SetAttributeFilter(attr_filter)
+
+    def collect(options):
+        stream = lyr.GetArrowStreamAsNumPy(
+            options=["USE_MASKED_ARRAYS=NO", "MAX_FEATURES_IN_BATCH=1000"]
+            + options
+        )
+        fids = []
+        ids = []
+        geoms = []
+        for batch in stream:
+            fids += list(batch["OGC_FID"])
+            ids += list(batch["id"])
+            geoms += [bytes(x) for x in batch["wkb_geometry"]]
+        return fids, ids, geoms
+
+    ref_fids, ref_ids, ref_geoms = collect([])
+    if attr_filter:
+        assert len(ref_fids) == 6667
+    else:
+        assert len(ref_fids) == 20000
+
+    assert collect(["NUM_THREADS=4"]) == (ref_fids, ref_ids, ref_geoms)
+
+    fids, ids, geoms = collect(["NUM_THREADS=4", "PRESERVE_ORDER=NO"])
+    order = numpy.argsort(fids)
+    assert [fids[i] for i in order] == ref_fids
+    assert [ids[i] for i in order] == ref_ids
+    assert [geoms[i] for i in order] == ref_geoms
+
+
+###############################################################################
+# Test reading through memory mapping
+
+
+def test_ogr_shape_use_mmap(tmp_path):
+
+    for ext in ("shp", "shx", "dbf"):
+        shutil.copy(f"data/poly.{ext}", tmp_path / f"poly.{ext}")
+
+    def collect():
+        ds = ogr.Open(tmp_path / "poly.shp")
+        lyr = ds.GetLayer(0)
+        ret = [(f.GetFID(), f["EAS_ID"], f.GetGeometryRef().ExportToWkb()) for f in lyr]
+        ret.append(lyr.GetFeature(5)["PRFEDEA"])
+        return ret
+
+    ref = collect()
+    assert len(ref) == 11
+    with gdal.config_option("SHAPE_USE_MMAP", "YES"):
+        assert collect() == ref
+
+    # Update mode does not use memory mapping
+    with gdal.config_option("SHAPE_USE_MMAP", "YES"):
+        ds = ogr.Open(tmp_path / "poly.shp", update=1)
+        lyr = ds.GetLayer(0)
+        f = lyr.GetFeature(0)
+        f["EAS_ID"] = 1234
+        lyr.SetFeature(f)
+        ds = None
+    ds = ogr.Open(tmp_path / "poly.shp")
+    assert ds.GetLayer(0).GetFeature(0)["EAS_ID"] == 1234
+
+
+###############################################################################
+# Test the packed Hilbert R-tree spatial index
+
+
+def test_ogr_shape_packed_rtree_index(tmp_path):
+
+    filename = str(tmp_path / "test.shp")
+    ds = ogr.GetDriverByName("ESRI Shapefile").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+    for i in range(1000):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if i != 10:
+            f.SetGeometry(ogr.CreateGeometryFromWkt(f"POINT({i % 40} {i // 40})"))
+        lyr.CreateFeature(f)
+    ds = None
+
+    def collect(envelopes):
+        ds = ogr.Open(filename)
+        lyr = ds.GetLayer(0)
+        ret = []
+        for minx, miny, maxx, maxy in envelopes:
+            lyr.SetSpatialFilterRect(minx, miny, maxx, maxy)
+            ret.append([f.GetFID() for f in lyr])
+        return ret
+
+    envelopes = [
+        (-1, -1, 0.5, 0.5),
+        (5.5, 3.5, 12.5, 7.5),
+        (10, -10, 10, 100),
+        (100, 100, 200, 200),
+        (-1, -1, 39.5, 24.5),
+    ]
+    ref = collect(envelopes)
+    assert ref[0] == [0]
+    assert 10 not in ref[-1]
+
+    ds = ogr.Open(filename, update=1)
+    ds.ExecuteSQL("CREATE SPATIAL INDEX ON test TYPE PACKED_RTREE")
+    ds = None
+    assert os.path.exists(tmp_path / "test.hrt")
+
+    with gdaltest.error_handler():
+        ds = ogr.Open(filename, update=1)
+        ds.ExecuteSQL("CREATE SPATIAL INDEX ON test TYPE FOO")
+        ds = None
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    assert lyr.TestCapability(ogr.OLCFastSpatialFilter)
+    assert str(tmp_path / "test.hrt") in [
+        x.replace("\\", "/") for x in ds.GetFileList()
+    ]
+    ds = None
+
+    assert collect(envelopes) == ref
+
+    # Adding a feature invalidates the index
+    ds = ogr.Open(filename, update=1)
+    lyr = ds.GetLayer(0)
+    f = ogr.Feature(lyr.GetLayerDefn())
+    f.SetGeometry(ogr.CreateGeometryFromWkt("POINT(0 0)"))
+    lyr.CreateFeature(f)
+    ds = None
+    assert not os.path.exists(tmp_path / "test.hrt")
+    assert collect(envelopes[0:1]) == [[0, 1000]]
+
+    # Creating a .qix index replaces the .hrt one
+    ds = ogr.Open(filename, update=1)
+    ds.ExecuteSQL("CREATE SPATIAL INDEX ON test TYPE PACKED_RTREE")
+    ds = None
+    ds = ogr.Open(filename, update=1)
+    ds.ExecuteSQL("CREATE SPATIAL INDEX ON test")
+    ds = None
+    assert not os.path.exists(tmp_path / "test.hrt")
+    assert os.path.exists(tmp_path / "test.qix")
+
+    ds = ogr.Open(filename, update=1)
+    ds.ExecuteSQL("CREATE SPATIAL INDEX ON test TYPE PACKED_RTREE")
+    ds.ExecuteSQL("DROP SPATIAL INDEX ON test")
+    ds = None
+    assert not os.path.exists(tmp_path / "test.hrt")
+    assert not os.path.exists(tmp_path / "test.qix")
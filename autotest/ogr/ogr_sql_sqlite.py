@@ -1979,6 +1979,99 @@ def test_ogr_sql_sqlite_26():
         assert geom_sql is None, "fail with %s" % op_str
 
 
+###############################################################################
+# Test spatial predicates with a constant argument over many rows (envelope
+# short-circuit and prepared geometry caching)
+
+
+@pytest.mark.require_geos
+@pytest.mark.parametrize(
+    "op_str", ["Intersects", "Disjoint", "Within", "Contains", "Touches"]
+)
+def test_ogr_sql_sqlite_spatial_predicates_constant_arg(op_str):
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("my_ds")
+    lyr = ds.CreateLayer("test")
+    for i in range(100):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        x = (i % 10) * 0.25
+        y = (i // 10) * 0.25
+        f.SetGeometry(
+            ogr.CreateGeometryFromWkt(
+                f"POLYGON(({x} {y},{x} {y+0.2},{x+0.2} {y+0.2},{x+0.2} {y},{x} {y}))"
+            )
+        )
+        lyr.CreateFeature(f)
+
+    poly_wkt = "POLYGON((0.5 0.5,0.5 1.6,1.6 1.6,1.6 0.5,0.5 0.5))"
+    poly = ogr.CreateGeometryFromWkt(poly_wkt)
+
+    for sql in [
+        f"SELECT ST_{op_str}(geometry, ST_GeomFromText('{poly_wkt}')) FROM test",
+        f"SELECT ST_{op_str}(ST_GeomFromText('{poly_wkt}'), geometry) FROM test",
+    ]:
+        with ds.ExecuteSQL(sql, dialect="SQLite") as sql_lyr:
+            res = [f.GetField(0) == 1 for f in sql_lyr]
+
+        expected = []
+        for f in lyr:
+            geom = f.GetGeometryRef()
+            if sql.startswith(f"SELECT ST_{op_str}(geometry"):
+                expected.append(getattr(geom, op_str)(poly))
+            else:
+                expected.append(getattr(poly, op_str)(geom))
+        assert res == expected, sql
+
+
+###############################################################################
+# Test that the virtual table only fetches the used columns, and handles
+# IN constraints
+
+
+def test_ogr_sql_sqlite_virtual_table_col_used_and_in(tmp_vsimem):
+
+    filename = tmp_vsimem / "test.shp"
+    ds = ogr.GetDriverByName("ESRI Shapefile").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test")
+    lyr.CreateField(ogr.FieldDefn("a", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("b", ogr.OFTString))
+    for i in range(10):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["a"] = i
+        f["b"] = "val%d" % i
+        f.SetGeometry(ogr.CreateGeometryFromWkt(f"POINT ({i} {i})"))
+        lyr.CreateFeature(f)
+
+    with ds.ExecuteSQL(
+        "SELECT b FROM test WHERE a IN (2, 5, 7) ORDER BY b", dialect="SQLite"
+    ) as sql_lyr:
+        assert [f["b"] for f in sql_lyr] == ["val2", "val5", "val7"]
+
+    with ds.ExecuteSQL(
+        "SELECT a, b FROM test WHERE b IN ('val1', 'val3') AND a < 3",
+        dialect="SQLite",
+    ) as sql_lyr:
+        assert [(f["a"], f["b"]) for f in sql_lyr] == [(1, "val1")]
+
+    with ds.ExecuteSQL(
+        "SELECT COUNT(*) FROM test WHERE a IN (NULL)", dialect="SQLite"
+    ) as sql_lyr:
+        assert sql_lyr.GetNextFeature().GetField(0) == 0
+
+    with ds.ExecuteSQL(
+        "SELECT geometry FROM test WHERE a = 4", dialect="SQLite"
+    ) as sql_lyr:
+        f = sql_lyr.GetNextFeature()
+        assert f.GetGeometryRef().ExportToIsoWkt() == "POINT (4 4)"
+
+    # Ignored fields must have been reset
+    lyr.ResetReading()
+    f = lyr.GetNextFeature()
+    assert f["a"] == 0
+    assert f["b"] == "val0"
+    assert f.GetGeometryRef() is not None
+
+
 ###############################################################################
 # Test MIN(), MAX() on a date
 
@@ -1864,3 +1864,399 @@ def test_ogr_sql_ilike_utf8():
 
     lyr.SetAttributeFilter("'éven' ILIKE '%xen'")
     assert lyr.GetFeatureCount() == 0
+
+
+###############################################################################
+# Test that the compiled form of attribute filters gives the same results as
+# the evaluation of the expression tree
+
+
+def _create_layer_for_compiled_filter(ds):
+
+    lyr = ds.CreateLayer("test")
+    lyr.CreateField(ogr.FieldDefn("int", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("int64", ogr.OFTInteger64))
+    lyr.CreateField(ogr.FieldDefn("real", ogr.OFTReal))
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    fld_defn = ogr.FieldDefn("bool", ogr.OFTInteger)
+    fld_defn.SetSubType(ogr.OFSTBoolean)
+    lyr.CreateField(fld_defn)
+    values = [
+        (1, 1234567890123, 1.5, "foo", 1),
+        (2, -5, -2.25, "FOO", 0),
+        (None, 0, None, "barfoo", None),
+        (3, None, 3.0, None, 1),
+        (-4, 10, 0.0, "", 0),
+        (5, 20, 5.5, "2024-01-01T00:00:00+00", 1),
+        (6, 30, 6.0, "fo_o%", 0),
+    ]
+    for i, (v_int, v_int64, v_real, v_str, v_bool) in enumerate(values):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetFID(i + 1)
+        for name, val in (
+            ("int", v_int),
+            ("int64", v_int64),
+            ("real", v_real),
+            ("str", v_str),
+            ("bool", v_bool),
+        ):
+            if val is None:
+                f.SetFieldNull(name)
+            else:
+                f.SetField(name, val)
+        lyr.CreateFeature(f)
+    return lyr
+
+
+compiled_filter_expressions = [
+    "int = 2",
+    "int <> 2",
+    "int > 2",
+    "2 > int",
+    "int >= 2 AND int <= 5",
+    "int BETWEEN 2 AND 5",
+    "int IN (1, 3, 6)",
+    "int IN (1.5, 3)",
+    "int = 2.0",
+    "int64 = 1234567890123",
+    "int64 < 0 OR int64 > 15",
+    "int64 IN (0, 10, 30)",
+    "real = 1.5",
+    "real > 1",
+    "real < 3",
+    "real IN (1.5, 6.0)",
+    "real BETWEEN 0 AND 5.5",
+    "str = 'foo'",
+    "'foo' = str",
+    "str <> 'foo'",
+    "str > 'bar'",
+    "str <= 'FOO'",
+    "str IN ('foo', 'BARFOO', '')",
+    "str BETWEEN 'a' AND 'g'",
+    "str = '2024-01-01T00:00:00'",
+    "str LIKE 'foo'",
+    "str LIKE 'FOO'",
+    "str ILIKE 'FOO'",
+    "str LIKE 'f%'",
+    "str LIKE '%foo'",
+    "str LIKE '%oo%'",
+    "str LIKE '%'",
+    "str LIKE '%%'",
+    "str LIKE 'f_o'",
+    "str LIKE 'fo\\_o\\%' ESCAPE '\\'",
+    "str IS NULL",
+    "str IS NOT NULL",
+    "int IS NULL OR real IS NULL",
+    "NOT (int = 2)",
+    "NOT (int = 2 OR str = 'foo')",
+    "bool = 1",
+    "bool = 0 AND NOT (int64 IS NULL)",
+    "FID = 3",
+    "FID IN (1, 7)",
+    "FID > 4 AND str IS NOT NULL",
+    "int + 1 = 3",
+    "bool",
+]
+
+
+@pytest.mark.parametrize("where", compiled_filter_expressions)
+def test_ogr_sql_compiled_attribute_filter(where):
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = _create_layer_for_compiled_filter(ds)
+
+    def get_fids():
+        assert lyr.SetAttributeFilter(where) == ogr.OGRERR_NONE
+        return [f.GetFID() for f in lyr]
+
+    with gdaltest.config_option("OGR_SQL_COMPILED_FILTER", "NO"):
+        expected_fids = get_fids()
+    assert get_fids() == expected_fids
+
+    with gdaltest.config_option("OGR_SQL_LIKE_AS_ILIKE", "YES"):
+        with gdaltest.config_option("OGR_SQL_COMPILED_FILTER", "NO"):
+            expected_fids = get_fids()
+        assert get_fids() == expected_fids
+
+
+@pytest.mark.require_driver("Arrow")
+@pytest.mark.parametrize("where", compiled_filter_expressions)
+def test_ogr_sql_compiled_attribute_filter_arrow(tmp_vsimem, where):
+    pytest.importorskip("osgeo.gdal_array")
+    pytest.importorskip("numpy")
+
+    src_ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    _create_layer_for_compiled_filter(src_ds)
+    filename = str(tmp_vsimem / "test.feather")
+    gdal.VectorTranslate(filename, src_ds, layerCreationOptions=["FID=fid"])
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+
+    def get_fids():
+        assert lyr.SetAttributeFilter(where) == ogr.OGRERR_NONE
+        fids = []
+        stream = lyr.GetArrowStreamAsNumPy(options=["USE_MASKED_ARRAYS=NO"])
+        for batch in stream:
+            fids += list(batch["fid"])
+        return fids
+
+    with gdaltest.config_option("OGR_SQL_COMPILED_FILTER", "NO"):
+        expected_fids = get_fids()
+    assert get_fids() == expected_fids
+
+
+###############################################################################
+# Test GROUP BY
+
+
+def _create_layer_for_group_by(ds):
+
+    lyr = ds.CreateLayer("t", geom_type=ogr.wkbPoint)
+    lyr.CreateField(ogr.FieldDefn("cls", ogr.OFTString))
+    lyr.CreateField(ogr.FieldDefn("sub", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("val", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("r", ogr.OFTReal))
+    values = [
+        ("b", 1, 10, 1.5),
+        ("a", 1, 20, 2.5),
+        ("b", 2, None, 0.25),
+        ("A", 1, 5, None),
+        (None, 1, 7, 3.0),
+        ("b", 1, 30, -1.0),
+    ]
+    for cls, sub, val, r in values:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if cls is not None:
+            f["cls"] = cls
+        f["sub"] = sub
+        if val is not None:
+            f["val"] = val
+        if r is not None:
+            f["r"] = r
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (1 2)"))
+        lyr.CreateFeature(f)
+    return lyr
+
+
+def test_ogr_sql_group_by():
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    _create_layer_for_group_by(ds)
+
+    with ds.ExecuteSQL(
+        "SELECT cls, COUNT(*), COUNT(val), SUM(val), AVG(val), MIN(r), MAX(r) "
+        "FROM t GROUP BY cls"
+    ) as sql_lyr:
+        lyr_defn = sql_lyr.GetLayerDefn()
+        assert lyr_defn.GetGeomFieldCount() == 0
+        assert lyr_defn.GetFieldDefn(1).GetType() == ogr.OFTInteger
+        assert sql_lyr.GetFeatureCount() == 4
+        res = [
+            (
+                f["cls"],
+                f["COUNT_*"],
+                f["COUNT_val"],
+                f["SUM_val"],
+                f["AVG_val"],
+                f["MIN_r"],
+                f["MAX_r"],
+            )
+            for f in sql_lyr
+        ]
+        # Groups are returned in the order they are met
+        assert res == [
+            ("b", 3, 2, 40, 20.0, -1.0, 1.5),
+            ("a", 1, 1, 20, 20.0, 2.5, 2.5),
+            ("A", 1, 1, 5, 5.0, None, None),
+            (None, 1, 1, 7, 7.0, 3.0, 3.0),
+        ]
+
+    with ds.ExecuteSQL(
+        "SELECT cls, sub, COUNT(*) AS cnt FROM t WHERE val > 5 "
+        "GROUP BY cls, sub ORDER BY cls DESC, sub"
+    ) as sql_lyr:
+        res = [(f["cls"], f["sub"], f["cnt"]) for f in sql_lyr]
+        assert res == [("b", 1, 2), ("a", 1, 1), (None, 1, 1)]
+
+    with ds.ExecuteSQL(
+        "SELECT SUM(val) FROM t GROUP BY sub ORDER BY sub DESC LIMIT 1 OFFSET 1"
+    ) as sql_lyr:
+        assert sql_lyr.GetFeatureCount() == 1
+        res = [f["SUM_val"] for f in sql_lyr]
+        assert res == [72]
+
+    for sql in [
+        "SELECT cls, val FROM t GROUP BY cls",
+        "SELECT DISTINCT cls FROM t GROUP BY cls",
+        "SELECT cls, COUNT(DISTINCT val) FROM t GROUP BY cls",
+        "SELECT COUNT(*) FROM t GROUP BY cls ORDER BY val",
+        "SELECT COUNT(*) FROM t GROUP BY foo",
+        "SELECT COUNT(*) FROM t GROUP BY cls ORDER BY",
+    ]:
+        with gdaltest.error_handler():
+            sql_lyr = ds.ExecuteSQL(sql)
+        assert sql_lyr is None, sql
+
+
+def test_ogr_sql_group_field_name():
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = ds.CreateLayer("t")
+    lyr.CreateField(ogr.FieldDefn("group", ogr.OFTString))
+    lyr.CreateField(ogr.FieldDefn("val", ogr.OFTInteger))
+    for group, val in [("A", 1), ("B", 2), ("A", 3)]:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["group"] = group
+        f["val"] = val
+        lyr.CreateFeature(f)
+
+    # GROUP is only a keyword when followed by BY in a SELECT statement
+    for where in ["group = 'A'", "\"group\" = 'A'", "GROUP IN ('A')"]:
+        assert lyr.SetAttributeFilter(where) == ogr.OGRERR_NONE, where
+        assert lyr.GetFeatureCount() == 2, where
+    lyr.SetAttributeFilter(None)
+
+    for sql in [
+        "SELECT group, val FROM t WHERE group = 'A' ORDER BY val",
+        'SELECT "group", val FROM t WHERE "group" = \'A\' ORDER BY val',
+    ]:
+        with ds.ExecuteSQL(sql) as sql_lyr:
+            res = [(f["group"], f["val"]) for f in sql_lyr]
+            assert res == [("A", 1), ("A", 3)], sql
+
+    for sql in [
+        "SELECT group, SUM(val) FROM t GROUP BY group ORDER BY group",
+        'SELECT "group", SUM(val) FROM t GROUP BY "group" ORDER BY "group"',
+    ]:
+        with ds.ExecuteSQL(sql) as sql_lyr:
+            res = [(f["group"], f["SUM_val"]) for f in sql_lyr]
+            assert res == [("A", 4), ("B", 2)], sql
+
+
+def test_ogr_sql_group_by_max_memory():
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    _create_layer_for_group_by(ds)
+
+    with gdaltest.config_option(
+        "OGR_SQL_HASH_MAX_MEMORY", "0.0001"
+    ), gdaltest.error_handler():
+        with ds.ExecuteSQL("SELECT cls, COUNT(*) FROM t GROUP BY cls") as sql_lyr:
+            assert sql_lyr.GetNextFeature() is None
+            assert "OGR_SQL_HASH_MAX_MEMORY" in gdal.GetLastErrorMsg()
+
+
+###############################################################################
+# Test that JOINs give the same result with the hash join and with
+# per-feature lookups
+
+
+@pytest.mark.parametrize(
+    "on",
+    [
+        "t.sub = s.id",
+        "s.id = t.sub",
+        "t.cls = s.name",
+        "t.r = s.id",
+        "t.sub = s.id AND t.cls = s.name",
+    ],
+)
+@pytest.mark.parametrize("max_memory", [None, "0.0001"])
+def test_ogr_sql_hash_join(on, max_memory):
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    _create_layer_for_group_by(ds)
+    lyr = ds.CreateLayer("s", geom_type=ogr.wkbNone)
+    lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("name", ogr.OFTString))
+    for id, name in [(2, "B"), (1, "a"), (1, "b"), (3, None), (None, "A")]:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if id is not None:
+            f["id"] = id
+        if name is not None:
+            f["name"] = name
+        lyr.CreateFeature(f)
+
+    sql = f"SELECT t.cls, t.sub, s.id, s.name FROM t LEFT JOIN s ON {on}"
+
+    def get_rows():
+        with ds.ExecuteSQL(sql) as sql_lyr:
+            return [tuple(f.GetField(i) for i in range(4)) for f in sql_lyr]
+
+    with gdaltest.config_option("OGR_SQL_HASH_JOIN", "NO"):
+        expected_rows = get_rows()
+    assert any(row[2] is not None for row in expected_rows)
+
+    with gdaltest.config_option("OGR_SQL_HASH_MAX_MEMORY", max_memory):
+        assert get_rows() == expected_rows
+
+
+###############################################################################
+# Test ORDER BY with sorted runs spilled to temporary files, and the
+# ORDER BY ... LIMIT fast path
+
+
+@pytest.mark.parametrize("max_memory", [None, "0.001", "0.0001"])
+@pytest.mark.parametrize(
+    "order_by,limit,offset",
+    [
+        ("i", None, None),
+        ("i DESC, s", None, None),
+        ("s, r DESC", None, None),
+        ("r", 7, 3),
+        ("s DESC, i", 1, None),
+        ("i", 1000, 10),
+    ],
+)
+def test_ogr_sql_order_by_external_sort(max_memory, order_by, limit, offset):
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = ds.CreateLayer("t", geom_type=ogr.wkbNone)
+    lyr.CreateField(ogr.FieldDefn("i", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("s", ogr.OFTString))
+    lyr.CreateField(ogr.FieldDefn("r", ogr.OFTReal))
+    rows = []
+    for n in range(500):
+        i = (n * 7919) % 37
+        s = None if n % 11 == 0 else "val%d" % ((n * 31) % 53)
+        r = None if n % 13 == 0 else ((n * 17) % 101) / 4.0
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["i"] = i
+        if s is not None:
+            f["s"] = s
+        if r is not None:
+            f["r"] = r
+        lyr.CreateFeature(f)
+        rows.append({"fid": f.GetFID(), "i": i, "s": s, "r": r})
+
+    # Nulls sort first in ascending order. Sorting is stable.
+    expected = rows[:]
+    for key in reversed(order_by.split(", ")):
+        name, _, direction = key.partition(" ")
+        expected.sort(
+            key=lambda row: (0,) if row[name] is None else (1, row[name]),
+            reverse=direction == "DESC",
+        )
+    expected = [row["fid"] for row in expected]
+    if offset:
+        expected = expected[offset:]
+    if limit is not None:
+        expected = expected[:limit]
+
+    sql = "SELECT * FROM t ORDER BY " + order_by
+    if limit is not None:
+        sql += " LIMIT %d" % limit
+    if offset:
+        sql += " OFFSET %d" % offset
+
+    with gdaltest.config_option("OGR_SQL_SORT_MAX_MEMORY", max_memory):
+        with ds.ExecuteSQL(sql) as sql_lyr:
+            assert [f.GetFID() for f in sql_lyr] == expected
+
+            # Random access in the index
+            if len(expected) > 5:
+                assert sql_lyr.SetNextByIndex(5) == ogr.OGRERR_NONE
+                assert sql_lyr.GetNextFeature().GetFID() == expected[5]
+                assert sql_lyr.SetNextByIndex(2) == ogr.OGRERR_NONE
+                assert sql_lyr.GetNextFeature().GetFID() == expected[2]
@@ -3330,3 +3330,53 @@ def test_ogr_vrt_field_names_same_case():
     f = lyr.GetNextFeature()
     assert f["id"] == "foo"
     assert f["id_from_uc"] == "bar"
+
+
+###############################################################################
+# Test reading ahead source layers of a union layer in worker threads
+
+
+@pytest.mark.parametrize("max_opened", ["2", "100"])
+def test_ogr_vrt_union_layer_prefetch(tmp_path, max_opened):
+
+    feature_counts = [3, 0, 1500, 7, 1, 2500, 0, 10, 4, 1]
+    vrt = "<OGRVRTDataSource><OGRVRTUnionLayer name='union_layer'>"
+    for idx, count in enumerate(feature_counts):
+        filename = str(tmp_path / f"src{idx}.csv")
+        with open(filename, "wt") as f:
+            f.write("id,src,WKT\n")
+            for i in range(count):
+                f.write(f'{i},{idx},"POINT ({i} {idx})"\n')
+        vrt += f"<OGRVRTLayer name='src{idx}'>"
+        vrt += f"<SrcDataSource>{filename}</SrcDataSource></OGRVRTLayer>"
+    vrt += "<SourceLayerFieldName>source_layer</SourceLayerFieldName>"
+    vrt += "</OGRVRTUnionLayer></OGRVRTDataSource>"
+
+    def read_all(attr_filter=None, spatial_filter=None):
+        ds = ogr.Open(vrt)
+        lyr = ds.GetLayer(0)
+        lyr.SetAttributeFilter(attr_filter)
+        if spatial_filter:
+            lyr.SetSpatialFilterRect(*spatial_filter)
+
+        def to_tuple(f):
+            geom = f.GetGeometryRef().ExportToWkt()
+            return (f.GetFID(), f["source_layer"], f["id"], geom)
+
+        ret = [to_tuple(f) for f in lyr]
+        # Read twice to test ResetReading()
+        assert [to_tuple(f) for f in lyr] == ret
+        return ret
+
+    for attr_filter, spatial_filter in [
+        (None, None),
+        ("src <> '5'", None),
+        (None, (-0.5, 1.5, 2000, 5.5)),
+    ]:
+        with gdal.config_option("OGR_VRT_MAX_OPENED", max_opened):
+            expected = read_all(attr_filter, spatial_filter)
+            with gdal.config_option("GDAL_NUM_THREADS", "4"):
+                got = read_all(attr_filter, spatial_filter)
+        assert got == expected
+
+    assert len(expected) != 0
@@ -310,6 +310,59 @@ def test_osr_ct_8():
                 pytest.fail("Failed to transform from Pseudo Mercator to LL")
 
 
+###############################################################################
+# Test WGS84 -> WebMercator optimized transform, against PROJ
+
+
+@pytest.mark.parametrize("axis_order", ["traditional", "authority"])
+def test_osr_ct_wgs84_to_webmercator(axis_order):
+
+    src_srs = osr.SpatialReference()
+    src_srs.ImportFromEPSG(4326)
+    if axis_order == "traditional":
+        src_srs.SetAxisMappingStrategy(osr.OAMS_TRADITIONAL_GIS_ORDER)
+
+    dst_srs = osr.SpatialReference()
+    dst_srs.ImportFromEPSG(3857)
+
+    ct = osr.CoordinateTransformation(src_srs, dst_srs)
+
+    options = osr.CoordinateTransformationOptions()
+    options.SetOperation(
+        "+proj=pipeline "
+        + ("" if axis_order == "traditional" else "+step +proj=axisswap +order=2,1 ")
+        + "+step +proj=unitconvert +xy_in=deg +xy_out=rad "
+        + "+step +proj=webmerc +ellps=WGS84"
+    )
+    ct_proj = osr.CoordinateTransformation(src_srs, dst_srs, options)
+
+    pnts = []
+    for lon in (-180, -179.5, -1e-7, 0, 2.5, 123.456, 180, 190, -540):
+        for lat in (-85, -45.5, -1e-9, 0, 49, 84.9):
+            if axis_order == "traditional":
+                pnts.append((lon, lat))
+            else:
+                pnts.append((lat, lon))
+    result = ct.TransformPoints(pnts)
+    expected = ct_proj.TransformPoints(pnts)
+    for got, exp in zip(result, expected):
+        assert got[0] == pytest.approx(exp[0], abs=1e-4)
+        assert got[1] == pytest.approx(exp[1], abs=1e-4)
+
+    # Same latitude for all points
+    pnts = [(x, 49) if axis_order == "traditional" else (49, x) for x in range(9)]
+    result = ct.TransformPoints(pnts)
+    expected = ct_proj.TransformPoints(pnts)
+    for got, exp in zip(result, expected):
+        assert got[0] == pytest.approx(exp[0], abs=1e-4)
+        assert got[1] == pytest.approx(exp[1], abs=1e-4)
+
+    # Outside of the projection domain
+    pnt = (0, 90) if axis_order == "traditional" else (90, 0)
+    with pytest.raises(Exception):
+        ct.TransformPoint(pnt[0], pnt[1])
+
+
 ###############################################################################
 # Test coordinate transformation where only one CRS has a towgs84 clause (#1156)
 
@@ -898,3 +951,51 @@ def test_osr_ct_source_and_target_mapping_minus_two_one():
     x, y, _ = ct.TransformPoint(10, 20, 0)
     assert x == pytest.approx(10)
     assert y == pytest.approx(20)
+
+
+###############################################################################
+# Test that cached transformations can be reused from several threads, and
+# that the per-thread caches do not return transformations for other CRS pairs
+
+
+def test_osr_ct_cache_multithreaded():
+
+    import threading
+
+    errors = []
+
+    def worker(epsg_code):
+        try:
+            s = osr.SpatialReference()
+            s.ImportFromEPSG(4326)
+            s.SetAxisMappingStrategy(osr.OAMS_TRADITIONAL_GIS_ORDER)
+            t = osr.SpatialReference()
+            t.ImportFromEPSG(epsg_code)
+            t.SetAxisMappingStrategy(osr.OAMS_TRADITIONAL_GIS_ORDER)
+            ref = osr.CoordinateTransformation(s, t).TransformPoint(2, 49)
+            for _ in range(20):
+                for code in (epsg_code, 4326):
+                    t2 = osr.SpatialReference()
+                    t2.ImportFromEPSG(code)
+                    t2.SetAxisMappingStrategy(osr.OAMS_TRADITIONAL_GIS_ORDER)
+                    ct = osr.CoordinateTransformation(s, t2)
+                    x, y, _ = ct.TransformPoint(2, 49)
+                    if code == 4326:
+                        expected = (2, 49)
+                    else:
+                        expected = ref[0:2]
+                    if (x, y) != pytest.approx(expected):
+                        errors.append((epsg_code, code, x, y))
+        except Exception as e:
+            errors.append(e)
+
+    threads = [
+        threading.Thread(target=worker, args=(code,))
+        for code in (3857, 32631, 2154, 3395)
+    ]
+    for th in threads:
+        th.start()
+    for th in threads:
+        th.join()
+
+    assert errors == []
@@ -280,5 +280,21 @@ def get_gdal_viewshed_path():
 #
 
 
+def get_gdal_zonal_stats_path():
+    return get_cli_utility_path("gdal_zonal_stats")
+
+
+###############################################################################
+#
+
+
 def get_gdal_footprint_path():
     return get_cli_utility_path("gdal_footprint")
+
+
+###############################################################################
+#
+
+
+def get_gdal_tiles_path():
+    return get_cli_utility_path("gdal_tiles")
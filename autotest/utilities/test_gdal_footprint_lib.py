@@ -217,6 +217,38 @@ def test_gdal_footprint_lib_splitPolys():
         ogrtest.check_feature_geometry(f1, "POLYGON ((2 0,2 1,3 1,3 0,2 0))")
 
 
+###############################################################################
+# Test that geometries are post-processed in the same way, and written in the
+# same order, with several threads
+
+
+def test_gdal_footprint_lib_splitPolys_num_threads():
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 20, 1, 1)
+    src_ds.SetGeoTransform([2, 0.1, 0, 49, 0, -0.1])
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(4326)
+    src_ds.SetSpatialRef(srs)
+    src_ds.GetRasterBand(1).SetNoDataValue(0)
+    src_ds.GetRasterBand(1).WriteRaster(0, 0, 20, 1, b"\xFF\x00" * 10)
+
+    def run():
+        out_ds = gdal.Footprint(
+            "",
+            src_ds,
+            format="Memory",
+            dstSRS="EPSG:32631",
+            splitPolys=True,
+            densify=0.01,
+        )
+        return [f.GetGeometryRef().ExportToWkt() for f in out_ds.GetLayer(0)]
+
+    ref = run()
+    assert len(ref) == 10
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        assert run() == ref
+
+
 ###############################################################################
 #
 
@@ -1050,3 +1050,45 @@ def test_gdal_grid_lib_dict_arguments():
     ind = opt.index("-co")
 
     assert opt[ind : ind + 4] == ["-co", "COMPRESS=DEFLATE", "-co", "LEVEL=4"]
+
+
+###############################################################################
+# Test that the spatial index of points gives the same results as the
+# exhaustive search, including when several points are at the same distance
+
+
+@pytest.mark.parametrize(
+    "alg",
+    [
+        "nearest",
+        "average:radius1=3:radius2=3",
+        "average_distance_pts:radius1=3:radius2=3",
+    ],
+)
+def test_gdal_grid_lib_point_index_same_as_exhaustive(alg):
+
+    points = []
+    for i in range(400):
+        x = (i * 7) % 20
+        y = (i * 13) % 17
+        points.append("%d %d %d" % (x, y, (i * 37) % 101))
+    wkt = "MULTIPOINT (" + ",".join(points) + ")"
+    geom = ogr.CreateGeometryFromWkt(wkt)
+
+    res = []
+    for threshold in ("0", "1000000000"):
+        with gdaltest.config_option("GDAL_GRID_POINT_COUNT_THRESHOLD", threshold):
+            ds = gdal.Grid(
+                "",
+                geom.ExportToJson(),
+                width=45,
+                height=40,
+                outputBounds=[-2, -2, 22, 19],
+                outputType=gdal.GDT_Float64,
+                format="MEM",
+                algorithm=alg,
+            )
+        data = ds.ReadRaster()
+        res.append(struct.unpack("d" * (len(data) // 8), data))
+
+    assert res[0] == pytest.approx(res[1], rel=1e-12)
@@ -0,0 +1,172 @@
+#!/usr/bin/env pytest
+# -*- coding: utf-8 -*-
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  gdal_tiles testing
+# Author:   GDAL contributors
+#
+###############################################################################
+# Copyright (c) 2026, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import os
+
+import gdaltest
+import pytest
+import test_cli_utilities
+
+from osgeo import gdal, osr
+
+pytestmark = [
+    pytest.mark.skipif(
+        test_cli_utilities.get_gdal_tiles_path() is None,
+        reason="gdal_tiles not available",
+    ),
+    pytest.mark.require_driver("PNG"),
+]
+
+
+@pytest.fixture()
+def gdal_tiles_path():
+    return test_cli_utilities.get_gdal_tiles_path()
+
+
+###############################################################################
+# Create a 100x100 RGB raster covering longitudes and latitudes [0, 10]
+
+
+def create_raster(filename):
+
+    ds = gdal.GetDriverByName("GTiff").Create(filename, 100, 100, 3)
+    ds.SetGeoTransform([0, 0.1, 0, 10, 0, -0.1])
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(4326)
+    ds.SetSpatialRef(srs)
+    for i in range(3):
+        ds.GetRasterBand(i + 1).Fill(50 * (i + 1))
+    ds = None
+
+
+def list_tiles(dirname):
+
+    return sorted(
+        os.path.relpath(os.path.join(root, f), dirname).replace(os.sep, "/")
+        for root, _, files in os.walk(dirname)
+        for f in files
+    )
+
+
+###############################################################################
+# Test generation of a few zoom levels
+
+
+def test_gdal_tiles_basic(gdal_tiles_path, tmp_path):
+
+    src_filename = str(tmp_path / "src.tif")
+    dst_dirname = str(tmp_path / "tiles")
+    create_raster(src_filename)
+
+    _, err = gdaltest.runexternal_out_and_err(
+        f"{gdal_tiles_path} -q -z 0-2 {src_filename} {dst_dirname}"
+    )
+    assert err == ""
+
+    assert list_tiles(dst_dirname) == ["0/0/0.png", "1/1/0.png", "2/2/1.png"]
+
+    ds = gdal.Open(os.path.join(dst_dirname, "2", "2", "1.png"))
+    assert ds.RasterCount == 4
+    assert ds.RasterXSize == 256
+    assert ds.RasterYSize == 256
+    assert [
+        ds.GetRasterBand(i + 1).ReadRaster(5, 250, 1, 1)[0] for i in range(4)
+    ] == [50, 100, 150, 255]
+    assert ds.GetRasterBand(4).ReadRaster(200, 50, 1, 1)[0] == 0
+
+
+###############################################################################
+# Test the TMS row numbering and the default zoom levels
+
+
+def test_gdal_tiles_tms_convention(gdal_tiles_path, tmp_path):
+
+    src_filename = str(tmp_path / "src.tif")
+    dst_dirname = str(tmp_path / "tiles")
+    create_raster(src_filename)
+
+    gdaltest.runexternal(
+        f"{gdal_tiles_path} -q -z 1-2 -convention tms {src_filename} "
+        + dst_dirname
+    )
+    assert list_tiles(dst_dirname) == ["1/1/1.png", "2/2/2.png"]
+
+    dst_dirname = str(tmp_path / "tiles_default")
+    gdaltest.runexternal(f"{gdal_tiles_path} -q {src_filename} {dst_dirname}")
+    assert os.listdir(dst_dirname) == ["4"]
+
+
+###############################################################################
+# Test JPEG tiles
+
+
+@pytest.mark.require_driver("JPEG")
+def test_gdal_tiles_jpeg(gdal_tiles_path, tmp_path):
+
+    src_filename = str(tmp_path / "src.tif")
+    dst_dirname = str(tmp_path / "tiles")
+    create_raster(src_filename)
+
+    gdaltest.runexternal(
+        f"{gdal_tiles_path} -q -z 2 -tf JPEG -co QUALITY=95 {src_filename} "
+        + dst_dirname
+    )
+    assert list_tiles(dst_dirname) == ["2/2/1.jpg"]
+    ds = gdal.Open(os.path.join(dst_dirname, "2", "2", "1.jpg"))
+    assert ds.RasterCount == 3
+
+
+###############################################################################
+# Test that the output does not depend on the number of threads and on the
+# metatile size
+
+
+def test_gdal_tiles_num_threads(gdal_tiles_path, tmp_path):
+
+    src_filename = str(tmp_path / "src.tif")
+    create_raster(src_filename)
+
+    results = []
+    for options in ("-num_threads 1", "-num_threads 4 -metatile 2"):
+        dst_dirname = str(tmp_path / f"tiles_{len(results)}")
+        gdaltest.runexternal(
+            f"{gdal_tiles_path} -q -z 3-7 -r near {options} {src_filename} "
+            + dst_dirname
+        )
+        tiles = list_tiles(dst_dirname)
+        results.append(
+            {
+                tile: open(os.path.join(dst_dirname, tile), "rb").read()
+                for tile in tiles
+            }
+        )
+    assert len(results[0]) > 10
+    assert results[0] == results[1]
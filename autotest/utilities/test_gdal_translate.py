@@ -29,6 +29,7 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import json
 import os
 import shutil
 import sys
@@ -1114,3 +1115,33 @@ def test_gdal_translate_scale_and_unscale_incompatible(gdal_translate_path, tmp_
         + f" -a_scale 0.0001 -a_offset 0.1 -unscale ../gcore/data/byte.tif {tmp_vsimem}/out.tif"
     )
     assert "-a_scale/-a_offset are not applied by -unscale" in err
+
+
+###############################################################################
+# Test writing a trace with CPL_TRACE_FILE
+
+
+def test_gdal_translate_trace_file(gdal_translate_path, tmp_path):
+
+    trace_filename = str(tmp_path / "trace.json")
+    gdaltest.runexternal(
+        f"{gdal_translate_path} --config CPL_TRACE_FILE {trace_filename} "
+        + "-co TILED=YES -co COMPRESS=DEFLATE ../gcore/data/byte.tif "
+        + str(tmp_path / "out.tif")
+    )
+
+    with open(trace_filename, "rb") as f:
+        events = json.loads(f.read())
+    assert events
+    for event in events:
+        assert event["ph"] == "X"
+        assert event["dur"] >= 0
+        assert "tid" in event
+    names = set(event["name"] for event in events)
+    assert (
+        "GDALDataset::RasterIO(read)" in names
+        or "GDALRasterBand::RasterIO(read)" in names
+    )
+    assert "IReadBlock" in names
+    assert "VSIFReadL" in names
+    assert "GTiffDataset::WriteEncodedTile" in names
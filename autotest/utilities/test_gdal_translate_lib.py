@@ -167,6 +167,50 @@ def test_gdal_translate_lib_5(tmp_path):
     ds = None
 
 
+
+###############################################################################
+# Test rgbExpand option on Byte and UInt16 sources, with values without
+# color table entry
+
+
+@pytest.mark.parametrize("dt", [gdal.GDT_Byte, gdal.GDT_UInt16])
+def test_gdal_translate_lib_rgb_expand_missing_entries(dt):
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 5, 1, 1, dt)
+    src_ds.GetRasterBand(1).WriteRaster(
+        0, 0, 5, 1, struct.pack("H" * 5, 0, 1, 2, 200, 1), buf_type=gdal.GDT_UInt16
+    )
+    ct = gdal.ColorTable()
+    ct.SetColorEntry(0, (10, 20, 30, 255))
+    ct.SetColorEntry(1, (40, 50, 60, 255))
+    ct.SetColorEntry(2, (70, 80, 90, 0))
+    src_ds.GetRasterBand(1).SetRasterColorTable(ct)
+
+    with gdal.quiet_errors():
+        ds = gdal.Translate("", src_ds, format="MEM", rgbExpand="rgba")
+    assert struct.unpack("B" * 5, ds.GetRasterBand(1).ReadRaster()) == (
+        10,
+        40,
+        70,
+        0,
+        40,
+    )
+    assert struct.unpack("B" * 5, ds.GetRasterBand(3).ReadRaster()) == (
+        30,
+        60,
+        90,
+        0,
+        60,
+    )
+    assert struct.unpack("B" * 5, ds.GetRasterBand(4).ReadRaster()) == (
+        255,
+        255,
+        0,
+        0,
+        255,
+    )
+
+
 ###############################################################################
 # Test oXSizePixel and oYSizePixel option
 
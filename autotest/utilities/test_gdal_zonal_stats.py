@@ -0,0 +1,260 @@
+#!/usr/bin/env pytest
+# -*- coding: utf-8 -*-
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  gdal_zonal_stats testing
+# Author:   GDAL contributors
+#
+###############################################################################
+# Copyright (c) 2026, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import struct
+
+import gdaltest
+import pytest
+import test_cli_utilities
+
+from osgeo import gdal, ogr
+
+pytestmark = pytest.mark.skipif(
+    test_cli_utilities.get_gdal_zonal_stats_path() is None,
+    reason="gdal_zonal_stats not available",
+)
+
+
+@pytest.fixture()
+def gdal_zonal_stats_path():
+    return test_cli_utilities.get_gdal_zonal_stats_path()
+
+
+###############################################################################
+# Create a 10x10 raster whose pixel (x, y) has value x + 10 * y, with a
+# geotransform such that pixel (x, y) covers [x, x+1] x [10-y-1, 10-y]
+
+
+def create_raster(filename):
+
+    ds = gdal.GetDriverByName("GTiff").Create(filename, 10, 10)
+    ds.SetGeoTransform([0, 1, 0, 10, 0, -1])
+    ds.WriteRaster(0, 0, 10, 10, bytes(range(100)))
+    ds = None
+
+
+def create_zones(filename, polygons):
+
+    ds = ogr.GetDriverByName("GeoJSON").CreateDataSource(filename)
+    lyr = ds.CreateLayer("zones")
+    lyr.CreateField(ogr.FieldDefn("name", ogr.OFTString))
+    for name, wkt in polygons:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["name"] = name
+        f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+    ds = None
+
+
+def read_output(filename):
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    return {f["name"]: f for f in lyr}
+
+
+###############################################################################
+# Test default statistics, with coverage fractions
+
+
+def test_gdal_zonal_stats_basic(gdal_zonal_stats_path, tmp_path):
+
+    src_filename = str(tmp_path / "src.tif")
+    zones_filename = str(tmp_path / "zones.geojson")
+    dst_filename = str(tmp_path / "out.gpkg")
+    create_raster(src_filename)
+    create_zones(
+        zones_filename,
+        [
+            ("square", "POLYGON ((0 10,2 10,2 8,0 8,0 10))"),
+            ("partial", "POLYGON ((2 10,3.25 10,3.25 9,2 9,2 10))"),
+            ("outside", "POLYGON ((20 10,21 10,21 9,20 9,20 10))"),
+            (
+                "hole",
+                "POLYGON ((0 10,3 10,3 7,0 7,0 10),(1 9,1 8,2 8,2 9,1 9))",
+            ),
+        ],
+    )
+
+    _, err = gdaltest.runexternal_out_and_err(
+        f"{gdal_zonal_stats_path} -q {src_filename} {zones_filename} "
+        + dst_filename
+    )
+    assert err == ""
+
+    res = read_output(dst_filename)
+    assert len(res) == 4
+
+    f = res["square"]
+    assert f["count"] == 4
+    assert f["sum"] == 22
+    assert f["mean"] == 5.5
+    assert f["min"] == 0
+    assert f["max"] == 11
+    assert f.GetGeometryRef() is not None
+
+    f = res["partial"]
+    assert f["count"] == pytest.approx(1.25, abs=1e-10)
+    assert f["sum"] == pytest.approx(2 + 0.25 * 3, abs=1e-10)
+    assert f["min"] == 2
+    assert f["max"] == 3
+
+    f = res["outside"]
+    assert f["count"] == 0
+    assert f["sum"] == 0
+    assert f.IsFieldNull("mean")
+    assert f.IsFieldNull("min")
+    assert f.IsFieldNull("max")
+
+    f = res["hole"]
+    assert f["count"] == pytest.approx(8, abs=1e-10)
+    assert f["sum"] == pytest.approx(sum(range(3)) + 10 + 12 + sum(range(20, 23)))
+
+
+###############################################################################
+# Test -center, -stats, -hist and -nogeom
+
+
+def test_gdal_zonal_stats_options(gdal_zonal_stats_path, tmp_path):
+
+    src_filename = str(tmp_path / "src.tif")
+    zones_filename = str(tmp_path / "zones.geojson")
+    dst_filename = str(tmp_path / "out.gpkg")
+    create_raster(src_filename)
+    create_zones(
+        zones_filename,
+        [
+            ("square", "POLYGON ((0 10,2 10,2 8,0 8,0 10))"),
+            ("partial", "POLYGON ((2 10,3.25 10,3.25 9,2 9,2 10))"),
+        ],
+    )
+
+    gdaltest.runexternal(
+        f"{gdal_zonal_stats_path} -q -center -stats count,sum -hist 2 0 20 "
+        f"-nogeom {src_filename} {zones_filename} {dst_filename}"
+    )
+
+    res = read_output(dst_filename)
+    f = res["square"]
+    assert f.GetGeometryRef() is None
+    assert f.GetFieldIndex("mean") < 0
+    assert f["count"] == 4
+    assert f["sum"] == 22
+    assert f["histogram"] == "2,2"
+
+    f = res["partial"]
+    assert f["count"] == 1
+    assert f["sum"] == 2
+    assert f["histogram"] == "1,0"
+
+
+###############################################################################
+# Test that nodata pixels are ignored
+
+
+def test_gdal_zonal_stats_nodata(gdal_zonal_stats_path, tmp_path):
+
+    src_filename = str(tmp_path / "src.tif")
+    zones_filename = str(tmp_path / "zones.geojson")
+    dst_filename = str(tmp_path / "out.gpkg")
+    create_raster(src_filename)
+    ds = gdal.Open(src_filename, gdal.GA_Update)
+    ds.GetRasterBand(1).SetNoDataValue(11)
+    ds = None
+    create_zones(
+        zones_filename, [("square", "POLYGON ((0 10,2 10,2 8,0 8,0 10))")]
+    )
+
+    gdaltest.runexternal(
+        f"{gdal_zonal_stats_path} -q {src_filename} {zones_filename} "
+        + dst_filename
+    )
+
+    f = read_output(dst_filename)["square"]
+    assert f["count"] == 3
+    assert f["sum"] == 11
+    assert f["max"] == 10
+
+
+###############################################################################
+# Test that results do not depend on the number of threads
+
+
+def test_gdal_zonal_stats_num_threads(gdal_zonal_stats_path, tmp_path):
+
+    src_filename = str(tmp_path / "src.tif")
+    zones_filename = str(tmp_path / "zones.geojson")
+    size = 3000
+    ds = gdal.GetDriverByName("GTiff").Create(
+        src_filename,
+        size,
+        size,
+        1,
+        gdal.GDT_Float32,
+        options=["TILED=YES", "BLOCKXSIZE=256", "BLOCKYSIZE=256"],
+    )
+    ds.SetGeoTransform([0, 1, 0, size, 0, -1])
+    for y in range(size):
+        values = [((x * 7 + y * 13) % 101) / 3.0 for x in range(size)]
+        ds.WriteRaster(0, y, size, 1, struct.pack("f" * size, *values))
+    ds = None
+
+    polygons = []
+    for i in range(50):
+        x = (i * 97) % (size - 500)
+        y = (i * 61) % (size - 500)
+        w = 10 + (i * 37) % 490
+        polygons.append(
+            (
+                str(i),
+                f"POLYGON (({x + 0.3} {y + 0.7},{x + w} {y + 0.2},"
+                f"{x + w / 2} {y + w + 0.1},{x + 0.3} {y + 0.7}))",
+            )
+        )
+    create_zones(zones_filename, polygons)
+
+    results = []
+    for num_threads in (1, 4):
+        dst_filename = str(tmp_path / f"out_{num_threads}.gpkg")
+        gdaltest.runexternal(
+            f"{gdal_zonal_stats_path} -q --config GDAL_NUM_THREADS "
+            f"{num_threads} {src_filename} {zones_filename} {dst_filename}"
+        )
+        res = read_output(dst_filename)
+        assert len(res) == 50
+        results.append(
+            {
+                k: (f["count"], f["sum"], f["min"], f["max"])
+                for k, f in res.items()
+            }
+        )
+    assert results[0] == results[1]
+    assert results[0]["49"][0] > 0
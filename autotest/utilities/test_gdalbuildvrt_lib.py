@@ -903,3 +903,30 @@ def test_gdalbuildvrt_lib_nodataMaxMaskThreshold_rgb_mask(tmp_vsimem):
     assert struct.unpack(
         "f" * 3, vrt_ds.GetRasterBand(1).ReadRaster(buf_type=gdal.GDT_Float32)
     ) == pytest.approx((1.0, 1.001, 2.0))
+
+
+###############################################################################
+# Test that opening sources in worker threads does not change the result
+
+
+def test_gdalbuildvrt_lib_num_threads(tmp_vsimem):
+
+    src_filenames = []
+    for i in range(20):
+        src_filename = str(tmp_vsimem / f"src{i}.tif")
+        ds = gdal.GetDriverByName("GTiff").Create(src_filename, 10, 10)
+        ds.SetGeoTransform([i * 10, 1, 0, (i % 3) * 10, 0, -1])
+        ds.GetRasterBand(1).Fill(i)
+        ds.Close()
+        src_filenames.append(src_filename)
+    src_filenames.insert(10, str(tmp_vsimem / "non_existing.tif"))
+
+    with gdal.quiet_errors():
+        expected = gdal.BuildVRT("", src_filenames).ReadRaster()
+        with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+            vrt_ds = gdal.BuildVRT("", src_filenames)
+    assert vrt_ds.ReadRaster() == expected
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        with pytest.raises(Exception, match="non_existing.tif"):
+            gdal.BuildVRT("", src_filenames, strict=True)
@@ -699,6 +699,41 @@ def test_gdaldem_lib_nodata():
         pytest.fail("Bad checksum")
 
 
+###############################################################################
+# Test that multi-threaded processing gives the same result as single-threaded
+
+
+@pytest.mark.parametrize(
+    "processing", ["hillshade", "slope", "aspect", "TRI", "TPI", "Roughness"]
+)
+@pytest.mark.parametrize("outputType", [gdal.GDT_Int16, gdal.GDT_Float32])
+@pytest.mark.parametrize("computeEdges", [False, True])
+def test_gdaldem_lib_num_threads(processing, outputType, computeEdges):
+
+    # Large enough to be processed as several stripes
+    src_ds = gdal.Translate(
+        "",
+        "../gdrivers/data/n43.tif",
+        format="MEM",
+        width=5000,
+        height=1000,
+        outputType=outputType,
+        resampleAlg="bilinear",
+    )
+    src_ds.GetRasterBand(1).SetNoDataValue(400)
+
+    ds = gdal.DEMProcessing(
+        "", src_ds, processing, format="MEM", computeEdges=computeEdges
+    )
+    ref_cs = ds.GetRasterBand(1).Checksum()
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        ds = gdal.DEMProcessing(
+            "", src_ds, processing, format="MEM", computeEdges=computeEdges
+        )
+    assert ds.GetRasterBand(1).Checksum() == ref_cs
+
+
 ###############################################################################
 # Test option argument handling
 
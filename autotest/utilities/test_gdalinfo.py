@@ -1018,3 +1018,22 @@ def test_gdalinfo_stac_eo_bands(gdalinfo_path, tmp_path):
     data = json.loads(ret)
 
     assert data["stac"]["eo:cloud_cover"] == 2
+
+
+###############################################################################
+# Test --vsi-stats
+
+
+def test_gdalinfo_vsi_stats(gdalinfo_path):
+
+    _, err = gdaltest.runexternal_out_and_err(
+        gdalinfo_path + " --vsi-stats ../gcore/data/byte.tif",
+        encoding="UTF-8",
+    )
+    data = json.loads(err)
+    assert data["/"]["open_count"] >= 1
+    assert data["/"]["read"]["count"] > 0
+    assert data["/"]["read"]["bytes"] > 0
+    assert sum(data["/"]["read"]["latency_histogram"].values()) == (
+        data["/"]["read"]["count"] + data["/"]["read_multi_range"]["count"]
+    )
@@ -161,3 +161,33 @@ def test_gdallocationinfo_wgs84(gdallocationinfo_path):
 
     expected_ret = """115"""
     assert expected_ret in ret
+
+
+###############################################################################
+# Test -r bilinear
+
+
+def test_gdallocationinfo_bilinear(gdallocationinfo_path):
+
+    ret = gdaltest.runexternal(
+        gdallocationinfo_path + " -valonly -r bilinear ../gcore/data/byte.tif 1 0.5"
+    )
+    assert ret.strip() == "115"
+
+    ret = gdaltest.runexternal(
+        gdallocationinfo_path + " -valonly -r bilinear ../gcore/data/byte.tif 0.5 0.5"
+    )
+    assert ret.strip() == "107"
+
+
+###############################################################################
+# Test -batch
+
+
+def test_gdallocationinfo_batch(gdallocationinfo_path):
+
+    ret = gdaltest.runexternal(
+        gdallocationinfo_path + " -valonly -batch ../gcore/data/byte.tif",
+        strin="0 0\n1 0\n100 100\n",
+    )
+    assert ret.replace("\r\n", "\n").split("\n")[0:3] == ["107", "123", ""]
@@ -943,3 +943,32 @@ def test_gdalmdimtranslate_dict_arguments():
     co_idx = opt.index("-co")
 
     assert opt[co_idx : co_idx + 4] == ["-co", "COMPRESS=DEFLATE", "-co", "LEVEL=4"]
+
+
+###############################################################################
+# Test that reading the next swath in a worker thread gives the same result
+
+
+def test_gdalmdimtranslate_copy_pipeline():
+
+    src_ds = gdal.GetDriverByName("MEM").CreateMultiDimensional("")
+    rg = src_ds.GetRootGroup()
+    dim0 = rg.CreateDimension("dim0", None, None, 10)
+    dim1 = rg.CreateDimension("dim1", None, None, 20)
+    dim2 = rg.CreateDimension("dim2", None, None, 30)
+    ar = rg.CreateMDArray(
+        "ar",
+        [dim0, dim1, dim2],
+        gdal.ExtendedDataType.Create(gdal.GDT_Float64),
+    )
+    ar.Write(struct.pack("d" * (10 * 20 * 30), *range(10 * 20 * 30)))
+    str_ar = rg.CreateMDArray("str_ar", [dim2], gdal.ExtendedDataType.CreateString())
+    str_ar.Write([str(i) for i in range(30)])
+
+    with gdal.config_options(
+        {"GDAL_MDARRAY_COPY_PIPELINE": "YES", "GDAL_SWATH_SIZE": "100"}
+    ):
+        out_ds = gdal.MultiDimTranslate("", src_ds, format="MEM")
+    out_rg = out_ds.GetRootGroup()
+    assert out_rg.OpenMDArray("ar").Read() == ar.Read()
+    assert out_rg.OpenMDArray("str_ar").Read() == [str(i) for i in range(30)]
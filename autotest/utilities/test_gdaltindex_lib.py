@@ -458,3 +458,29 @@ def test_gdaltindex_lib_fetch_md(tmp_path, four_tiles):
     lyr = ds.GetLayer(0)
     f = lyr.GetNextFeature()
     assert f["foo_field"] == "bar"
+
+
+###############################################################################
+# Test that opening sources in worker threads does not change the result
+
+
+def test_gdaltindex_lib_num_threads(tmp_path, four_tiles):
+
+    index_filename = str(tmp_path / "test_gdaltindex_lib_num_threads.shp")
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        gdal.TileIndex(index_filename, four_tiles[0:2])
+
+        # Already indexed files are skipped
+        with gdal.quiet_errors():
+            gdal.TileIndex(index_filename, four_tiles)
+
+    ds = ogr.Open(index_filename)
+    lyr = ds.GetLayer(0)
+    assert [f["location"] for f in lyr] == four_tiles
+    assert [f.GetGeometryRef().GetEnvelope() for f in lyr] == [
+        (49, 50, 1, 2),
+        (49, 50, 2, 3),
+        (48, 49, 1, 2),
+        (48, 49, 2, 3),
+    ]
@@ -560,6 +560,31 @@ def test_nearblack_lib_floodfill_concave_from_bottom_non_black():
     )
 
 
+###############################################################################
+# Test that the two passes algorithm gives the same result with several
+# threads
+
+
+@pytest.mark.parametrize("num_threads", ["2", "ALL_CPUS"])
+def test_nearblack_lib_twopasses_num_threads(num_threads):
+
+    src_ds = gdal.Translate(
+        "", "../gdrivers/data/rgbsmall.tif", format="MEM", width=500, height=400
+    )
+
+    def run():
+        ds = gdal.Nearblack(
+            "", src_ds, format="MEM", maxNonBlack=2, setAlpha=True, setMask=True
+        )
+        return [ds.GetRasterBand(i + 1).Checksum() for i in range(4)] + [
+            ds.GetRasterBand(1).GetMaskBand().Checksum()
+        ]
+
+    ref = run()
+    with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+        assert run() == ref
+
+
 def test_nearblack_lib_dict_arguments():
 
     opt = gdal.NearblackOptions(
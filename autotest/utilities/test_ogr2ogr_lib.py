@@ -1174,6 +1174,78 @@ def test_ogr2ogr_lib_clipsrc_discard_lower_dimensionality():
     ds = None
 
 
+###############################################################################
+# Test -clipsrc/-clipdst with features inside, across and outside the clip
+# geometry. Features fully inside are kept unmodified.
+
+
+@pytest.mark.require_geos
+@pytest.mark.parametrize("clip_option", ["clipSrc", "clipDst"])
+def test_ogr2ogr_lib_clip_inside_across_outside(clip_option):
+
+    srcDS = gdal.GetDriverByName("Memory").Create("", 0, 0, 0, gdal.GDT_Unknown)
+    srcLayer = srcDS.CreateLayer("test", geom_type=ogr.wkbPolygon)
+    for wkt in [
+        "POLYGON ((2 2,3 2,3 3,2 3,2 2))",
+        "POLYGON ((8 8,12 8,12 12,8 12,8 8))",
+        "POLYGON ((20 20,21 20,21 21,20 20))",
+    ]:
+        f = ogr.Feature(srcLayer.GetLayerDefn())
+        f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+        srcLayer.CreateFeature(f)
+
+    ds = gdal.VectorTranslate(
+        "", srcDS, format="Memory", **{clip_option: [0, 0, 10, 10]}
+    )
+    lyr = ds.GetLayer(0)
+    assert lyr.GetFeatureCount() == 2
+    f = lyr.GetNextFeature()
+    assert f.GetGeometryRef().ExportToWkt() == "POLYGON ((2 2,3 2,3 3,2 3,2 2))"
+    f = lyr.GetNextFeature()
+    assert f.GetGeometryRef().Equals(
+        ogr.CreateGeometryFromWkt("POLYGON ((8 8,10 8,10 10,8 10,8 8))")
+    )
+
+
+###############################################################################
+# Test -clipsrc with a clip geometry with many vertices, where features are
+# intersected with the part of the clip geometry covering them
+
+
+@pytest.mark.require_geos
+def test_ogr2ogr_lib_clipsrc_detailed_clip_geometry():
+
+    clip_geom = ogr.CreateGeometryFromWkt("POINT (50 50)").Buffer(45, 500)
+    assert clip_geom.GetGeometryRef(0).GetPointCount() > 1000
+
+    srcDS = gdal.GetDriverByName("Memory").Create("", 0, 0, 0, gdal.GDT_Unknown)
+    srcLayer = srcDS.CreateLayer("test", geom_type=ogr.wkbPolygon)
+    for i in range(20):
+        for j in range(20):
+            x = i * 5 + 1
+            y = j * 5 + 1
+            f = ogr.Feature(srcLayer.GetLayerDefn())
+            f.SetGeometry(
+                ogr.CreateGeometryFromWkt(
+                    f"POLYGON (({x} {y},{x} {y+3},{x+3} {y+3},{x+3} {y},{x} {y}))"
+                )
+            )
+            srcLayer.CreateFeature(f)
+
+    ds = gdal.VectorTranslate(
+        "", srcDS, format="Memory", clipSrc=clip_geom.ExportToWkt()
+    )
+    lyr = ds.GetLayer(0)
+
+    expected_areas = []
+    for f in srcLayer:
+        inter = f.GetGeometryRef().Intersection(clip_geom)
+        if not inter.IsEmpty() and inter.GetDimension() == 2:
+            expected_areas.append(inter.GetArea())
+    got_areas = [f.GetGeometryRef().GetArea() for f in lyr]
+    assert got_areas == pytest.approx(expected_areas, rel=1e-10)
+
+
 ###############################################################################
 # Test -clipsrc with a clip layer with an invalid polygon
 
@@ -1256,6 +1328,49 @@ def test_ogr2ogr_lib_clipsrc_3d_polygon(tmp_vsimem):
     ds = None
 
 
+###############################################################################
+# Test -clipsrc with a clip datasource made of many features, whose union is
+# computed in parallel
+
+
+@pytest.mark.require_driver("GPKG")
+@pytest.mark.require_geos
+def test_ogr2ogr_lib_clipsrc_datasource_many_features(tmp_vsimem):
+
+    srcDS = gdal.GetDriverByName("Memory").Create("", 0, 0, 0, gdal.GDT_Unknown)
+    srcLayer = srcDS.CreateLayer("test", geom_type=ogr.wkbPolygon)
+    f = ogr.Feature(srcLayer.GetLayerDefn())
+    f.SetGeometry(ogr.CreateGeometryFromWkt("POLYGON((-5 -5,-5 20,20 20,20 -5,-5 -5))"))
+    srcLayer.CreateFeature(f)
+    f = ogr.Feature(srcLayer.GetLayerDefn())
+    f.SetGeometry(ogr.CreateGeometryFromWkt("POLYGON((45 0,45 1,46 1,46 0,45 0))"))
+    srcLayer.CreateFeature(f)
+
+    # 40 x 40 adjacent squares covering (0,0)-(40,40)
+    clip_path = tmp_vsimem / "clip_test.gpkg"
+    clip_ds = gdal.GetDriverByName("GPKG").Create(clip_path, 0, 0, 0, gdal.GDT_Unknown)
+    clip_layer = clip_ds.CreateLayer("cliptest", geom_type=ogr.wkbPolygon)
+    clip_layer.StartTransaction()
+    for j in range(40):
+        for i in range(40):
+            f = ogr.Feature(clip_layer.GetLayerDefn())
+            f.SetGeometry(
+                ogr.CreateGeometryFromWkt(
+                    f"POLYGON(({i} {j},{i} {j+1},{i+1} {j+1},{i+1} {j},{i} {j}))"
+                )
+            )
+            clip_layer.CreateFeature(f)
+    clip_layer.CommitTransaction()
+    clip_ds = None
+
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        ds = gdal.VectorTranslate("", srcDS, format="Memory", clipSrc=clip_path)
+    lyr = ds.GetLayer(0)
+    assert lyr.GetFeatureCount() == 1
+    f = lyr.GetNextFeature()
+    assert f.GetGeometryRef().GetArea() == pytest.approx(400)
+
+
 ###############################################################################
 # Test -clipdst with a clip datasource
 
@@ -2250,6 +2365,93 @@ def test_ogr2ogr_lib_OGR2OGR_USE_ARROW_API_YES(limit):
     )
 
 
+###############################################################################
+# Test that reprojection, -select, -where and -nlt PROMOTE_TO_MULTI are
+# done on the Arrow batches, with the same result as the per-feature path
+
+
+@pytest.mark.parametrize(
+    "options",
+    [
+        {"dstSRS": "EPSG:32631"},
+        {"dstSRS": "EPSG:4258"},
+        {"selectFields": ["c", "a"]},
+        {"selectFields": ["c"], "where": "b = 1"},
+        {"selectFields": []},
+        {"geometryType": "PROMOTE_TO_MULTI"},
+        {
+            "dstSRS": "EPSG:32631",
+            "selectFields": ["b"],
+            "geometryType": "PROMOTE_TO_MULTI",
+        },
+    ],
+)
+def test_ogr2ogr_lib_arrow_api_columnar_processing(options):
+
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(4326)
+    srs.SetAxisMappingStrategy(osr.OAMS_TRADITIONAL_GIS_ORDER)
+
+    src_ds = gdal.GetDriverByName("Memory").Create("", 0, 0, 0, gdal.GDT_Unknown)
+    src_lyr = src_ds.CreateLayer("test", srs=srs, geom_type=ogr.wkbPolygon)
+    src_lyr.CreateField(ogr.FieldDefn("a"))
+    src_lyr.CreateField(ogr.FieldDefn("b", ogr.OFTInteger))
+    src_lyr.CreateField(ogr.FieldDefn("c", ogr.OFTReal))
+    for i, wkt in enumerate(
+        [
+            "POLYGON ((2 49,3 49,3 50,2 49))",
+            None,
+            "MULTIPOLYGON (((2 49,3 49,3 50,2 49)),((4 49,5 49,5 50,4 49)))",
+            "POLYGON EMPTY",
+            "POLYGON ((2 49 10,3 49 20,3 50 30,2 49 10))",
+        ]
+    ):
+        f = ogr.Feature(src_lyr.GetLayerDefn())
+        f["a"] = "foo%d" % i
+        f["b"] = i % 2
+        f["c"] = i * 1.5
+        if wkt:
+            f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+        src_lyr.CreateFeature(f)
+
+    got_msg = []
+
+    def my_handler(errorClass, errno, msg):
+        got_msg.append(msg)
+        return
+
+    with gdaltest.error_handler(my_handler), gdaltest.config_options(
+        {"CPL_DEBUG": "ON", "OGR2OGR_USE_ARROW_API": "YES"}
+    ):
+        out_ds = gdal.VectorTranslate("", src_ds, format="Memory", **options)
+
+    assert "OGR2OGR: Using WriteArrowBatch()" in got_msg
+
+    with gdaltest.config_option("OGR2OGR_USE_ARROW_API", "NO"):
+        ref_ds = gdal.VectorTranslate("", src_ds, format="Memory", **options)
+
+    out_lyr = out_ds.GetLayer(0)
+    ref_lyr = ref_ds.GetLayer(0)
+    out_defn = out_lyr.GetLayerDefn()
+    ref_defn = ref_lyr.GetLayerDefn()
+    assert [
+        out_defn.GetFieldDefn(i).GetName() for i in range(out_defn.GetFieldCount())
+    ] == [ref_defn.GetFieldDefn(i).GetName() for i in range(ref_defn.GetFieldCount())]
+    assert out_lyr.GetGeomType() == ref_lyr.GetGeomType()
+    assert out_lyr.GetSpatialRef().IsSame(ref_lyr.GetSpatialRef())
+    assert out_lyr.GetFeatureCount() == ref_lyr.GetFeatureCount()
+
+    for ref_f in ref_lyr:
+        out_f = out_lyr.GetNextFeature()
+        for i in range(ref_defn.GetFieldCount()):
+            assert out_f.GetField(i) == ref_f.GetField(i)
+        ref_geom = ref_f.GetGeometryRef()
+        if ref_geom is None:
+            assert out_f.GetGeometryRef() is None
+        else:
+            ogrtest.check_feature_geometry(out_f, ref_geom)
+
+
 ###############################################################################
 # Test JSON types roundtrip
 
@@ -2464,3 +2666,85 @@ def test_ogr2ogr_lib_gpkg_to_shp_truncated_field_names(tmp_vsimem):
     f = out_lyr.GetNextFeature()
     assert f["shortname"] == "foo"
     assert f["too_long_f"] == "bar"
+
+
+###############################################################################
+# Test -parallel_layers
+
+
+def create_multi_layer_gpkg(filename, layer_count):
+
+    src_ds = gdal.GetDriverByName("GPKG").Create(filename, 0, 0, 0, gdal.GDT_Unknown)
+    for i in range(layer_count):
+        src_lyr = src_ds.CreateLayer(f"layer{i}", geom_type=ogr.wkbPoint)
+        src_lyr.CreateField(ogr.FieldDefn("val", ogr.OFTInteger))
+        src_lyr.CreateField(ogr.FieldDefn("too_long_for_shapefile"))
+        for j in range(10 * (i + 1)):
+            f = ogr.Feature(src_lyr.GetLayerDefn())
+            f["val"] = j
+            f.SetGeometry(ogr.CreateGeometryFromWkt(f"POINT ({i} {j})"))
+            src_lyr.CreateFeature(f)
+    src_ds.Close()
+
+
+@pytest.mark.require_driver("GPKG")
+def test_ogr2ogr_lib_parallel_layers(tmp_vsimem):
+
+    src_filename = str(tmp_vsimem / "src.gpkg")
+    create_multi_layer_gpkg(src_filename, 5)
+
+    got_msg = []
+
+    def my_handler(errorClass, errno, msg):
+        if errorClass != gdal.CE_Debug:
+            got_msg.append(msg)
+        return
+
+    tab = [0]
+
+    def my_progress(pct, msg, user_data):
+        assert pct >= user_data[0]
+        user_data[0] = pct
+        return 1
+
+    with gdaltest.error_handler(my_handler):
+        out_ds = gdal.VectorTranslate(
+            str(tmp_vsimem / "out"),
+            src_filename,
+            format="ESRI Shapefile",
+            parallelLayers=3,
+            callback=my_progress,
+            callback_data=tab,
+        )
+    assert out_ds is not None
+    assert tab[0] == pytest.approx(1.0)
+    assert got_msg == [
+        "Normalized/laundered field name: 'too_long_for_shapefile' to 'too_long_f'"
+    ] * 5
+
+    assert out_ds.GetLayerCount() == 5
+    for i in range(5):
+        out_lyr = out_ds.GetLayerByName(f"layer{i}")
+        assert out_lyr.GetFeatureCount() == 10 * (i + 1)
+        out_lyr.SetAttributeFilter("val = 5")
+        f = out_lyr.GetNextFeature()
+        assert f.GetGeometryRef().ExportToWkt() == f"POINT ({i} 5)"
+
+
+###############################################################################
+# Test -parallel_layers with an output driver that does not support it
+
+
+@pytest.mark.require_driver("GPKG")
+def test_ogr2ogr_lib_parallel_layers_not_supported(tmp_vsimem):
+
+    src_filename = str(tmp_vsimem / "src.gpkg")
+    create_multi_layer_gpkg(src_filename, 2)
+
+    with gdal.quiet_errors():
+        out_ds = gdal.VectorTranslate(
+            "", src_filename, format="Memory", parallelLayers=2
+        )
+        assert "-parallel_layers ignored" in gdal.GetLastErrorMsg()
+    assert out_ds.GetLayerCount() == 2
+    assert out_ds.GetLayer(1).GetFeatureCount() == 20
@@ -942,3 +942,27 @@ def test_ogrinfo_lib_extent3D():
         1.0,
         1.0,
     ]
+
+
+###############################################################################
+# Test -explain
+
+
+def test_ogrinfo_lib_explain():
+
+    ret = gdal.VectorInfo(
+        "../ogr/data/gpkg/3d_envelope.gpkg", options="-explain -so -where fid=1"
+    )
+    assert "Query plan:" in ret
+    assert "ATTRIBUTE_FILTER: PUSHED_DOWN" in ret
+    assert "Query execution: 1 features read" in ret
+
+    ret = gdal.VectorInfo(
+        "../ogr/data/gpkg/3d_envelope.gpkg",
+        options="-explain -so -where fid=1",
+        format="json",
+    )
+    assert ret["layers"][0]["queryPlan"]["ATTRIBUTE_FILTER"] == "PUSHED_DOWN"
+    assert ret["layers"][0]["queryExecution"]["featureCount"] == 1
+
+    gdaltest.validate_json(ret, "ogrinfo_output.schema.json")
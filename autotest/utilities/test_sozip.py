@@ -29,6 +29,8 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import os
+
 import gdaltest
 import pytest
 import test_cli_utilities
@@ -149,3 +151,46 @@ def test_sozip_optimize_from(sozip_path, tmp_path):
         in out
     )
     assert "sozip.zip is a valid .zip file, and contains 2 SOZip-enabled file(s)" in out
+
+
+###############################################################################
+# Test that files compressed concurrently are written in the specified order
+
+
+def test_sozip_create_many_files_num_threads(sozip_path, tmp_path):
+
+    filenames = []
+    for i in range(20):
+        filename = str(tmp_path / f"file_{19 - i}.txt")
+        with open(filename, "wb") as f:
+            f.write((f"content of file {i}\n" * (i * 100 + 1)).encode("ascii"))
+        filenames.append(filename)
+    large_filename = str(tmp_path / "large.bin")
+    with open(large_filename, "wb") as f:
+        f.write(b"\x01" * (2 * 1024 * 1024))
+    filenames.insert(10, large_filename)
+
+    output_zip = str(tmp_path / "sozip.zip")
+    (out, err) = gdaltest.runexternal_out_and_err(
+        f"{sozip_path} -j --config GDAL_NUM_THREADS 4 {output_zip} "
+        + " ".join(filenames)
+    )
+    assert err is None or err == "", "got error/warning"
+
+    assert gdal.ReadDir(f"/vsizip/{output_zip}") == [
+        os.path.basename(filename) for filename in filenames
+    ]
+    for filename in filenames:
+        with open(filename, "rb") as f:
+            expected = f.read()
+        f = gdal.VSIFOpenL(f"/vsizip/{output_zip}/{os.path.basename(filename)}", "rb")
+        assert f
+        got = gdal.VSIFReadL(1, len(expected) + 1, f)
+        gdal.VSIFCloseL(f)
+        assert got == expected
+
+    (out, err) = gdaltest.runexternal_out_and_err(
+        f"{sozip_path} --validate {output_zip}"
+    )
+    assert err is None or err == "", "got error/warning"
+    assert "contains 1 SOZip-enabled file(s)" in out
@@ -450,6 +450,22 @@ if (GDAL_USE_JPEG AND TARGET JPEG::JPEG)
       }
       "
       HAVE_JPEGTURBO_DUAL_MODE_8_12)
+
+  # Check for jpeg_skip_scanlines() and jpeg_crop_scanline() which have been
+  # added in libjpeg-turbo 1.5, to decode partial windows.
+  check_c_source_compiles(
+      "
+      #include <stddef.h>
+      #include <stdio.h>
+      #include \"jpeglib.h\"
+      int main()
+      {
+          jpeg_skip_scanlines(0,0);
+          jpeg_crop_scanline(0,0,0);
+          return 0;
+      }
+      "
+      HAVE_JPEGTURBO_SKIP_AND_CROP_SCANLINES)
   cmake_pop_check_state()
 
 endif()
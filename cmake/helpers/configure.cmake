@@ -125,6 +125,14 @@ else ()
         "
     HAVE_5ARGS_MREMAP)
 
+  check_c_source_compiles(
+    "
+        #define _GNU_SOURCE
+        #include <sys/mman.h>
+        int main() { return memfd_create(\"\", MFD_CLOEXEC); }
+        "
+    HAVE_MEMFD_CREATE)
+
   check_c_source_compiles(
     "
         #include <pthread.h>
@@ -190,6 +190,20 @@ man_pages = [
         [author_tamass],
         1,
     ),
+    (
+        "programs/gdal_tiles",
+        "gdal_tiles",
+        "Generates a pyramid of tiles following a tile matrix set.",
+        [author_evenr],
+        1,
+    ),
+    (
+        "programs/gdal_zonal_stats",
+        "gdal_zonal_stats",
+        "Computes statistics of a raster over polygonal zones.",
+        [author_evenr],
+        1,
+    ),
     (
         "programs/gdal_create",
         "gdal_create",
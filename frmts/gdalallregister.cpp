@@ -122,6 +122,11 @@ void CPL_DLL GDALRegisterPlugins(void)
  *
  * This function should generally be called once at the beginning of the
  * application.
+ *
+ * Unless the GDAL_LAZY_DRIVER_REGISTRATION configuration option is set to NO,
+ * some built-in drivers, whose registration is costly, are only registered as
+ * lightweight proxies. The real driver is registered the first time it is
+ * needed to open or create a dataset.
  */
 
 void CPL_STDCALL GDALAllRegister()
@@ -129,6 +134,9 @@ void CPL_STDCALL GDALAllRegister()
 {
     auto poDriverManager = GetGDALDriverManager();
 
+    [[maybe_unused]] const bool bLazyRegistration =
+        CPLTestBool(CPLGetConfigOption("GDAL_LAZY_DRIVER_REGISTRATION", "YES"));
+
 #if defined(HAVE_EXTERNAL_DEFERRED_PLUGINS)
     DeclareExternalDeferredPlugins();
 #endif
@@ -386,7 +394,14 @@ void CPL_STDCALL GDALAllRegister()
 #endif
 
 #ifdef FRMT_png
-    GDALRegister_PNG();
+    if (bLazyRegistration)
+    {
+        DeclareDeferredPNGBuiltin();
+    }
+    else
+    {
+        GDALRegister_PNG();
+    }
 #endif
 
 #ifdef FRMT_dds
@@ -398,7 +413,14 @@ void CPL_STDCALL GDALAllRegister()
 #endif
 
 #ifdef FRMT_jpeg
-    GDALRegister_JPEG();
+    if (bLazyRegistration)
+    {
+        DeclareDeferredJPEGBuiltin();
+    }
+    else
+    {
+        GDALRegister_JPEG();
+    }
 #endif
 
 #ifdef FRMT_mem
@@ -410,8 +432,15 @@ void CPL_STDCALL GDALAllRegister()
 #endif
 
 #ifdef FRMT_gif
-    GDALRegister_GIF();
-    GDALRegister_BIGGIF();
+    if (bLazyRegistration)
+    {
+        DeclareDeferredGIFBuiltin();
+    }
+    else
+    {
+        GDALRegister_GIF();
+        GDALRegister_BIGGIF();
+    }
 #endif
 
 #ifdef FRMT_envisat
@@ -537,7 +566,14 @@ void CPL_STDCALL GDALAllRegister()
 #endif
 
 #ifdef FRMT_grib
-    GDALRegister_GRIB();
+    if (bLazyRegistration)
+    {
+        DeclareDeferredGRIBBuiltin();
+    }
+    else
+    {
+        GDALRegister_GRIB();
+    }
 #endif
 
 #ifdef FRMT_mrsid
@@ -599,11 +635,25 @@ void CPL_STDCALL GDALAllRegister()
 #endif
 
 #ifdef FRMT_webp
-    GDALRegister_WEBP();
+    if (bLazyRegistration)
+    {
+        DeclareDeferredWEBPBuiltin();
+    }
+    else
+    {
+        GDALRegister_WEBP();
+    }
 #endif
 
 #ifdef FRMT_pdf
-    GDALRegister_PDF();
+    if (bLazyRegistration)
+    {
+        DeclareDeferredPDFBuiltin();
+    }
+    else
+    {
+        GDALRegister_PDF();
+    }
 #endif
 
 #ifdef FRMT_rasterlite
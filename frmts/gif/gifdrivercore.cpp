@@ -29,6 +29,10 @@
 
 #include "gifdrivercore.h"
 
+#ifndef PLUGIN_FILENAME
+#include "gdal_frmts.h"
+#endif
+
 /************************************************************************/
 /*                     GIFDriverIdentify()                              */
 /************************************************************************/
@@ -59,6 +63,8 @@ void BIGGIFDriverSetCommonMetadata(GDALDriver *poDriver)
     poDriver->SetMetadataItem(GDAL_DCAP_VIRTUALIO, "YES");
 
     poDriver->pfnIdentify = GIFDriverIdentify;
+    poDriver->SetMetadataItem(GDAL_DMD_IDENTIFY_SIGNATURES,
+                              "magic:0:474946383761 magic:0:474946383961");
     poDriver->SetMetadataItem(GDAL_DCAP_OPEN, "YES");
 }
 
@@ -86,6 +92,8 @@ void GIFDriverSetCommonMetadata(GDALDriver *poDriver)
     poDriver->SetMetadataItem(GDAL_DCAP_VIRTUALIO, "YES");
 
     poDriver->pfnIdentify = GIFDriverIdentify;
+    poDriver->SetMetadataItem(GDAL_DMD_IDENTIFY_SIGNATURES,
+                              "magic:0:474946383761 magic:0:474946383961");
     poDriver->SetMetadataItem(GDAL_DCAP_OPEN, "YES");
     poDriver->SetMetadataItem(GDAL_DCAP_CREATECOPY, "YES");
 }
@@ -121,3 +129,25 @@ void DeclareDeferredGIFPlugin()
     }
 }
 #endif
+
+/************************************************************************/
+/*                     DeclareDeferredGIFBuiltin()                      */
+/************************************************************************/
+
+#ifndef PLUGIN_FILENAME
+void DeclareDeferredGIFBuiltin()
+{
+    if (GDALGetDriverByName(GIF_DRIVER_NAME) == nullptr)
+    {
+        auto poDriver = new GDALPluginDriverProxy(GDALRegister_GIF);
+        GIFDriverSetCommonMetadata(poDriver);
+        GetGDALDriverManager()->DeclareDeferredPluginDriver(poDriver);
+    }
+    if (GDALGetDriverByName(BIGGIF_DRIVER_NAME) == nullptr)
+    {
+        auto poDriver = new GDALPluginDriverProxy(GDALRegister_BIGGIF);
+        BIGGIFDriverSetCommonMetadata(poDriver);
+        GetGDALDriverManager()->DeclareDeferredPluginDriver(poDriver);
+    }
+}
+#endif
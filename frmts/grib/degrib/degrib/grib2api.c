@@ -28,6 +28,15 @@
 
 #include "cpl_port.h"
 
+/* GDAL: the state kept by unpk_g2ncep() between the calls for the subgrids
+ * of a message is made thread-local, so that several messages can be
+ * decoded concurrently. */
+#if defined(_MSC_VER)
+#define GRIB2API_THREAD_LOCAL __declspec(thread)
+#else
+#define GRIB2API_THREAD_LOCAL __thread
+#endif
+
 /* Commented out by GDAL: we can actually include gribtemplates.h */
 #if 0
 
@@ -806,13 +815,13 @@ void unpk_g2ncep(CPL_UNUSED sInt4 *kfildo, float *ain, sInt4 *iain, sInt4 *nd2x3
                  sInt4 *iendpk, sInt4 *jer, sInt4 *ndjer, sInt4 *kjer)
 {
    int i;               /* A counter used for a number of purposes. */
-   static unsigned int subgNum = 0; /* The sub grid we read most recently.
+   static GRIB2API_THREAD_LOCAL unsigned int subgNum = 0; /* The sub grid we read most recently.
                                      * This is primarily to help with the
                                      * inew option. */
    int ierr;            /* Holds the error code from a called routine. */
    sInt4 listsec0[3];
    sInt4 listsec1[13];
-   static sInt4 numfields = 1; /* Number of sub Grids in this message */
+   static GRIB2API_THREAD_LOCAL sInt4 numfields = 1; /* Number of sub Grids in this message */
    sInt4 numlocal;      /* Number of local sections in this message. */
    int unpack;          /* Tell g2_getfld to unpack the message. */
    int expand;          /* Tell g2_getflt to attempt to expand the bitmap. */
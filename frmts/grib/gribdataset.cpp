@@ -54,6 +54,7 @@
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "cpl_time.h"
+#include "cpl_worker_thread_pool.h"
 #include "degrib/degrib/degrib2.h"
 #include "degrib/degrib/inventory.h"
 #include "degrib/degrib/meta.h"
@@ -68,6 +69,7 @@ CPL_C_END
 #include "gdal_frmts.h"
 #include "gdal_pam.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include "ogr_spatialref.h"
 #include "memdataset.h"
 
@@ -857,46 +859,70 @@ CPLErr GRIBRasterBand::LoadData()
             delete m_Grib_MetaData;
             m_Grib_MetaData = nullptr;
         }
-        ReadGribData(poGDS->fp, start, subgNum, &m_Grib_Data, &m_Grib_MetaData);
-        if (!m_Grib_Data)
-        {
-            CPLError(CE_Failure, CPLE_AppDefined, "Out of memory.");
-            if (m_Grib_MetaData != nullptr)
-            {
-                MetaFree(m_Grib_MetaData);
-                delete m_Grib_MetaData;
-                m_Grib_MetaData = nullptr;
-            }
-            return CE_Failure;
-        }
+        double *padfData = nullptr;
+        grib_MetaData *psMetaData = nullptr;
+        ReadGribData(poGDS->fp, start, subgNum, &padfData, &psMetaData);
+        return SetLoadedData(padfData, psMetaData);
+    }
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                           SetLoadedData()                            */
+/************************************************************************/
 
-        // Check the band matches the dataset as a whole, size wise. (#3246)
-        nGribDataXSize = m_Grib_MetaData->gds.Nx;
-        nGribDataYSize = m_Grib_MetaData->gds.Ny;
-        if (nGribDataXSize <= 0 || nGribDataYSize <= 0)
+/** Takes ownership of the values and metadata of the message decoded by
+ * ReadGribData(), validates them and updates the cache accounting of the
+ * dataset.
+ */
+CPLErr GRIBRasterBand::SetLoadedData(double *padfData,
+                                     grib_MetaData *psMetaData)
+{
+    GRIBDataset *poGDS = static_cast<GRIBDataset *>(poDS);
+
+    m_Grib_Data = padfData;
+    m_Grib_MetaData = psMetaData;
+    if (!m_Grib_Data)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Out of memory.");
+        if (m_Grib_MetaData != nullptr)
         {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Band %d of GRIB dataset is %dx%d.", nBand, nGribDataXSize,
-                     nGribDataYSize);
             MetaFree(m_Grib_MetaData);
             delete m_Grib_MetaData;
             m_Grib_MetaData = nullptr;
-            return CE_Failure;
         }
+        return CE_Failure;
+    }
 
-        poGDS->nCachedBytes += static_cast<GIntBig>(nGribDataXSize) *
-                               nGribDataYSize * sizeof(double);
-        poGDS->poLastUsedBand = this;
+    // Check the band matches the dataset as a whole, size wise. (#3246)
+    nGribDataXSize = m_Grib_MetaData->gds.Nx;
+    nGribDataYSize = m_Grib_MetaData->gds.Ny;
+    if (nGribDataXSize <= 0 || nGribDataYSize <= 0)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Band %d of GRIB dataset is %dx%d.", nBand, nGribDataXSize,
+                 nGribDataYSize);
+        MetaFree(m_Grib_MetaData);
+        delete m_Grib_MetaData;
+        m_Grib_MetaData = nullptr;
+        free(m_Grib_Data);
+        m_Grib_Data = nullptr;
+        return CE_Failure;
+    }
 
-        if (nGribDataXSize != nRasterXSize || nGribDataYSize != nRasterYSize)
-        {
-            CPLError(CE_Warning, CPLE_AppDefined,
-                     "Band %d of GRIB dataset is %dx%d, while the first band "
-                     "and dataset is %dx%d.  Georeferencing of band %d may "
-                     "be incorrect, and data access may be incomplete.",
-                     nBand, nGribDataXSize, nGribDataYSize, nRasterXSize,
-                     nRasterYSize, nBand);
-        }
+    poGDS->nCachedBytes += static_cast<GIntBig>(nGribDataXSize) *
+                           nGribDataYSize * sizeof(double);
+    poGDS->poLastUsedBand = this;
+
+    if (nGribDataXSize != nRasterXSize || nGribDataYSize != nRasterYSize)
+    {
+        CPLError(CE_Warning, CPLE_AppDefined,
+                 "Band %d of GRIB dataset is %dx%d, while the first band "
+                 "and dataset is %dx%d.  Georeferencing of band %d may "
+                 "be incorrect, and data access may be incomplete.",
+                 nBand, nGribDataXSize, nGribDataYSize, nRasterXSize,
+                 nRasterYSize, nBand);
     }
 
     return CE_None;
@@ -1299,6 +1325,198 @@ CPLErr GRIBDataset::GetGeoTransform(double *padfTransform)
     return CE_None;
 }
 
+/************************************************************************/
+/*                             IRasterIO()                              */
+/************************************************************************/
+
+CPLErr GRIBDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
+                              int nXSize, int nYSize, void *pData,
+                              int nBufXSize, int nBufYSize,
+                              GDALDataType eBufType, int nBandCount,
+                              int *panBandMap, GSpacing nPixelSpace,
+                              GSpacing nLineSpace, GSpacing nBandSpace,
+                              GDALRasterIOExtraArg *psExtraArg)
+{
+    if (eRWFlag == GF_Read && nBandCount > 1)
+        LoadBandsInParallel(nBandCount, panBandMap);
+
+    return GDALPamDataset::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
+                                     pData, nBufXSize, nBufYSize, eBufType,
+                                     nBandCount, panBandMap, nPixelSpace,
+                                     nLineSpace, nBandSpace, psExtraArg);
+}
+
+/************************************************************************/
+/*                        LoadBandsInParallel()                         */
+/************************************************************************/
+
+/** Decodes the messages of the requested bands that are not cached yet in
+ * worker threads, each one reading the file through its own handle.
+ * This is only an optimization: bands that cannot be loaded here will be
+ * loaded by GRIBRasterBand::LoadData() afterwards.
+ */
+void GRIBDataset::LoadBandsInParallel(int nBandCount, const int *panBandMap)
+{
+    if (bCacheOnlyOneBand)
+        return;
+
+    const char *pszNumThreads =
+        CPLGetConfigOption("GDAL_NUM_THREADS", "ALL_CPUS");
+    int nThreadsMax;
+    if (EQUAL(pszNumThreads, "ALL_CPUS"))
+        nThreadsMax = CPLGetNumCPUs();
+    else
+        nThreadsMax = std::max(1, atoi(pszNumThreads));
+    if (nThreadsMax > 1024)
+        nThreadsMax = 1024;
+    if (nThreadsMax <= 1)
+        return;
+
+    struct JobStruct
+    {
+        GRIBRasterBand *poBand = nullptr;
+        const char *pszFilename = nullptr;
+        double *padfData = nullptr;
+        grib_MetaData *psMetaData = nullptr;
+    };
+
+    std::vector<JobStruct> asJobs;
+    std::set<int> oSetBands;
+    GIntBig nNewCachedBytes = nCachedBytes;
+    for (int i = 0; i < nBandCount; ++i)
+    {
+        auto poBand =
+            cpl::down_cast<GRIBRasterBand *>(GetRasterBand(panBandMap[i]));
+        if (poBand->m_Grib_Data || !oSetBands.insert(panBandMap[i]).second)
+            continue;
+        // Do not go beyond the point where LoadData() would switch to the
+        // "one-band-at-a-time" strategy.
+        nNewCachedBytes +=
+            static_cast<GIntBig>(nRasterXSize) * nRasterYSize * sizeof(double);
+        if (nNewCachedBytes > nCachedBytesThreshold)
+            return;
+        JobStruct sJob;
+        sJob.poBand = poBand;
+        sJob.pszFilename = GetDescription();
+        asJobs.push_back(sJob);
+    }
+    if (asJobs.size() < 2)
+        return;
+
+    CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(
+        std::min(nThreadsMax, static_cast<int>(asJobs.size())));
+    if (!poPool)
+        return;
+    auto poQueue = poPool->CreateJobQueue();
+
+    const auto JobFunc = [](void *pData)
+    {
+        auto psJob = static_cast<JobStruct *>(pData);
+        VSILFILE *fpJob = VSIFOpenL(psJob->pszFilename, "rb");
+        if (fpJob == nullptr)
+            return;
+        GRIBRasterBand::ReadGribData(fpJob, psJob->poBand->start,
+                                     psJob->poBand->subgNum, &psJob->padfData,
+                                     &psJob->psMetaData);
+        VSIFCloseL(fpJob);
+    };
+
+    CPLDebug("GRIB", "Loading %d bands with %d threads",
+             static_cast<int>(asJobs.size()),
+             std::min(nThreadsMax, static_cast<int>(asJobs.size())));
+    for (auto &sJob : asJobs)
+        poQueue->SubmitJob(JobFunc, &sJob);
+    poQueue->WaitCompletion();
+
+    for (auto &sJob : asJobs)
+    {
+        if (sJob.psMetaData == nullptr)
+            continue;
+        // The band might have been loaded in the meantime by another thread
+        // using that dataset, which is not supported, but be robust.
+        if (sJob.poBand->m_Grib_Data)
+        {
+            free(sJob.padfData);
+            MetaFree(sJob.psMetaData);
+            delete sJob.psMetaData;
+            continue;
+        }
+        sJob.poBand->UncacheData();
+        CPL_IGNORE_RET_VAL(
+            sJob.poBand->SetLoadedData(sJob.padfData, sJob.psMetaData));
+    }
+}
+
+/************************************************************************/
+/*                            WriteSidecar()                            */
+/************************************************************************/
+
+/** Writes a message index in the format of wgrib2 .idx files, that can be
+ * used by later openings to avoid scanning the whole GRIB file.
+ */
+void GRIBDataset::WriteSidecar(const char *pszFilename,
+                               const gdal::grib::InventoryWrapper &oInventory)
+{
+    const std::string osSideCarFilename = std::string(pszFilename) + ".idx";
+    VSILFILE *fpSideCar = VSIFOpenL(osSideCarFilename.c_str(), "wb");
+    if (fpSideCar == nullptr)
+    {
+        CPLError(CE_Warning, CPLE_FileIO, "Cannot create %s",
+                 osSideCarFilename.c_str());
+        return;
+    }
+
+    const auto SanitizeField = [](const char *pszVal)
+    {
+        std::string osVal(pszVal ? pszVal : "");
+        std::replace(osVal.begin(), osVal.end(), ':', ' ');
+        std::replace(osVal.begin(), osVal.end(), '\n', ' ');
+        return osVal;
+    };
+
+    bool bOK = true;
+    int nMsgNum = 0;
+    for (uInt4 i = 0; bOK && i < oInventory.length(); ++i)
+    {
+        const inventoryType *psInv = oInventory.get(i);
+        if (psInv->subgNum == 0)
+            ++nMsgNum;
+
+        struct tm brokenDown;
+        CPLUnixTimeToYMDHMS(static_cast<GIntBig>(psInv->refTime), &brokenDown);
+
+        std::string osForecast;
+        if (psInv->foreSec == 0)
+            osForecast = "anl";
+        else if (std::fmod(psInv->foreSec, 3600) == 0)
+            osForecast = CPLSPrintf("%.0f hour fcst", psInv->foreSec / 3600);
+        else
+            osForecast = CPLSPrintf("%.0f sec fcst", psInv->foreSec);
+
+        std::string osLine(CPLSPrintf("%d", nMsgNum));
+        // .idx files use a 1-based indexing for subgrids
+        if (psInv->subgNum > 0)
+            osLine += CPLSPrintf(".%d", psInv->subgNum + 1);
+        osLine += CPLSPrintf(
+            ":" CPL_FRMT_GUIB ":d=%04d%02d%02d%02d:%s:%s:%s:\n",
+            static_cast<GUIntBig>(psInv->start), brokenDown.tm_year + 1900,
+            brokenDown.tm_mon + 1, brokenDown.tm_mday, brokenDown.tm_hour,
+            SanitizeField(psInv->element).c_str(),
+            SanitizeField(psInv->shortFstLevel).c_str(), osForecast.c_str());
+        bOK = VSIFWriteL(osLine.data(), osLine.size(), 1, fpSideCar) == 1;
+    }
+    if (VSIFCloseL(fpSideCar) != 0 || !bOK)
+    {
+        CPLError(CE_Warning, CPLE_FileIO, "Error while writing %s",
+                 osSideCarFilename.c_str());
+        VSIUnlink(osSideCarFilename.c_str());
+    }
+    else
+    {
+        CPLDebug("GRIB", "Wrote %s", osSideCarFilename.c_str());
+    }
+}
+
 /************************************************************************/
 /*                                Inventory()                           */
 /************************************************************************/
@@ -1332,6 +1550,12 @@ GRIBDataset::Inventory(VSILFILE *fp, GDALOpenInfo *poOpenInfo)
                  poOpenInfo->pszFilename);
         // Contains an GRIB2 message inventory of the file.
         pInventories = std::make_unique<InventoryWrapperGrib>(fp);
+        if (pInventories->result() > 0 && pInventories->length() > 0 &&
+            CPLTestBool(CSLFetchNameValueDef(poOpenInfo->papszOpenOptions,
+                                             "WRITE_IDX", "NO")))
+        {
+            WriteSidecar(poOpenInfo->pszFilename, *pInventories);
+        }
     }
 
     return pInventories;
@@ -100,6 +100,14 @@ class GRIBDataset final : public GDALPamDataset
                                    void *pProgressData);
 
     CPLErr GetGeoTransform(double *padfTransform) override;
+
+    CPLErr IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize,
+                     int nYSize, void *pData, int nBufXSize, int nBufYSize,
+                     GDALDataType eBufType, int nBandCount, int *panBandMap,
+                     GSpacing nPixelSpace, GSpacing nLineSpace,
+                     GSpacing nBandSpace,
+                     GDALRasterIOExtraArg *psExtraArg) override;
+
     const OGRSpatialReference *GetSpatialRef() const override
     {
         return m_poSRS.get();
@@ -115,6 +123,9 @@ class GRIBDataset final : public GDALPamDataset
     static GDALDataset *OpenMultiDim(GDALOpenInfo *);
     static std::unique_ptr<gdal::grib::InventoryWrapper>
     Inventory(VSILFILE *, GDALOpenInfo *);
+    static void WriteSidecar(const char *pszFilename,
+                             const gdal::grib::InventoryWrapper &oInventory);
+    void LoadBandsInParallel(int nBandCount, const int *panBandMap);
 
     VSILFILE *fp;
     // Calculate and store once as GetGeoTransform may be called multiple times.
@@ -167,6 +178,7 @@ class GRIBRasterBand final : public GDALPamRasterBand
 
   private:
     CPLErr LoadData();
+    CPLErr SetLoadedData(double *padfData, grib_MetaData *psMetaData);
     void FindNoDataGrib2(bool bSeekToStart = true);
     void FindMetaData();
     // Heuristic search for the start of the message
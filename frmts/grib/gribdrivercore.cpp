@@ -29,6 +29,10 @@
 
 #include "gribdrivercore.h"
 
+#ifndef PLUGIN_FILENAME
+#include "gdal_frmts.h"
+#endif
+
 /************************************************************************/
 /*                     GRIBDriverIdentify()                             */
 /************************************************************************/
@@ -70,6 +74,9 @@ void GRIBDriverSetCommonMetadata(GDALDriver *poDriver)
                               "    <Option name='USE_IDX' type='boolean' "
                               "description='Load metadata from "
                               "wgrib2 index file if available' default='YES'/>"
+                              "    <Option name='WRITE_IDX' type='boolean' "
+                              "description='Write a wgrib2-like index file "
+                              "when no index file was used' default='NO'/>"
                               "</OpenOptionList>");
     poDriver->SetMetadataItem(GDAL_DMD_HELPTOPIC, "drivers/raster/grib.html");
     poDriver->SetMetadataItem(GDAL_DMD_EXTENSIONS, "grb grb2 grib2");
@@ -104,3 +111,20 @@ void DeclareDeferredGRIBPlugin()
     GetGDALDriverManager()->DeclareDeferredPluginDriver(poDriver);
 }
 #endif
+
+/************************************************************************/
+/*                     DeclareDeferredGRIBBuiltin()                     */
+/************************************************************************/
+
+#ifndef PLUGIN_FILENAME
+void DeclareDeferredGRIBBuiltin()
+{
+    if (GDALGetDriverByName(DRIVER_NAME) != nullptr)
+    {
+        return;
+    }
+    auto poDriver = new GDALPluginDriverProxy(GDALRegister_GRIB);
+    GRIBDriverSetCommonMetadata(poDriver);
+    GetGDALDriverManager()->DeclareDeferredPluginDriver(poDriver);
+}
+#endif
@@ -39,6 +39,7 @@
 #include "tilematrixset.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <vector>
 
@@ -70,13 +71,27 @@ static bool HasZSTDCompression()
 /*                           GetTmpFilename()                           */
 /************************************************************************/
 
-static CPLString GetTmpFilename(const char *pszFilename, const char *pszExt)
+// dfEstimatedSize is the uncompressed size of the temporary file. If it is
+// below COG_TMP_MAX_IN_MEMORY_SIZE, the file is created in /vsimem/,
+// which saves writing and reading it back from disk.
+static CPLString GetTmpFilename(const char *pszFilename, const char *pszExt,
+                                double dfEstimatedSize)
 {
-    const bool bSupportsRandomWrite =
-        VSISupportsRandomWrite(pszFilename, false);
+    const char *pszMaxInMemorySize =
+        CPLGetConfigOption("COG_TMP_MAX_IN_MEMORY_SIZE", nullptr);
+    const double dfMaxInMemorySize =
+        pszMaxInMemorySize ? CPLAtof(pszMaxInMemorySize)
+                           : static_cast<double>(GDALGetCacheMax64());
     CPLString osTmpFilename;
-    if (!bSupportsRandomWrite ||
-        CPLGetConfigOption("CPL_TMPDIR", nullptr) != nullptr)
+    if (dfEstimatedSize <= dfMaxInMemorySize)
+    {
+        const CPLString osTmpBasename(
+            CPLGenerateTempFilename(CPLGetBasename(pszFilename)));
+        osTmpFilename =
+            CPLFormFilename("/vsimem", CPLGetFilename(osTmpBasename), nullptr);
+    }
+    else if (!VSISupportsRandomWrite(pszFilename, false) ||
+             CPLGetConfigOption("CPL_TMPDIR", nullptr) != nullptr)
     {
         osTmpFilename = CPLGenerateTempFilename(CPLGetBasename(pszFilename));
     }
@@ -88,6 +103,62 @@ static CPLString GetTmpFilename(const char *pszFilename, const char *pszExt)
     return osTmpFilename;
 }
 
+/************************************************************************/
+/*                               COGStep                                */
+/************************************************************************/
+
+// Gives a step of the COG generation its own range of the overall progress,
+// labelled with the name of the step, and reports its duration.
+class COGStep
+{
+    const char *m_pszName;
+    void *m_pScaledProgress;
+    const std::chrono::steady_clock::time_point m_oStart =
+        std::chrono::steady_clock::now();
+
+    static int CPL_STDCALL Progress(double dfComplete, const char *pszMessage,
+                                    void *pProgressArg)
+    {
+        const auto poStep = static_cast<const COGStep *>(pProgressArg);
+        return GDALScaledProgress(dfComplete,
+                                  pszMessage && pszMessage[0]
+                                      ? pszMessage
+                                      : poStep->m_pszName,
+                                  poStep->m_pScaledProgress);
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(COGStep)
+
+  public:
+    COGStep(const char *pszName, double dfMin, double dfMax,
+            GDALProgressFunc pfnProgress, void *pProgressData)
+        : m_pszName(pszName),
+          m_pScaledProgress(GDALCreateScaledProgress(dfMin, dfMax, pfnProgress,
+                                                     pProgressData))
+    {
+        CPLDebug("COG", "%s: start", m_pszName);
+    }
+
+    ~COGStep()
+    {
+        GDALDestroyScaledProgress(m_pScaledProgress);
+        CPLDebug("COG", "%s: end (%.3f s)", m_pszName,
+                 std::chrono::duration<double>(
+                     std::chrono::steady_clock::now() - m_oStart)
+                     .count());
+    }
+
+    GDALProgressFunc GetProgressFunc() const
+    {
+        return Progress;
+    }
+
+    void *GetProgressData()
+    {
+        return this;
+    }
+};
+
 /************************************************************************/
 /*                             GetResampling()                          */
 /************************************************************************/
@@ -643,8 +714,10 @@ static std::unique_ptr<GDALDataset> CreateReprojectedDS(
 
     int bHasNoData = FALSE;
     poSrcDS->GetRasterBand(1)->GetNoDataValue(&bHasNoData);
-    if (!bHasNoData &&
-        CPLTestBool(CSLFetchNameValueDef(papszOptions, "ADD_ALPHA", "YES")))
+    const bool bAddAlpha =
+        !bHasNoData &&
+        CPLTestBool(CSLFetchNameValueDef(papszOptions, "ADD_ALPHA", "YES"));
+    if (bAddAlpha)
     {
         papszArg = CSLAddString(papszArg, "-dstalpha");
     }
@@ -681,15 +754,19 @@ static std::unique_ptr<GDALDataset> CreateReprojectedDS(
 
     const double dfNextPixels =
         double(nXSize) * nYSize * (nBands + (bHasMask ? 1 : 0));
-    void *pScaledProgress = GDALCreateScaledProgress(
-        dfCurPixels / dfTotalPixelsToProcess,
-        dfNextPixels / dfTotalPixelsToProcess, pfnProgress, pProgressData);
+    COGStep oStep("Reprojecting source dataset",
+                  dfCurPixels / dfTotalPixelsToProcess,
+                  dfNextPixels / dfTotalPixelsToProcess, pfnProgress,
+                  pProgressData);
     dfCurPixels = dfNextPixels;
 
-    CPLDebug("COG", "Reprojecting source dataset: start");
-    GDALWarpAppOptionsSetProgress(psOptions, GDALScaledProgress,
-                                  pScaledProgress);
-    CPLString osTmpFile(GetTmpFilename(pszDstFilename, "warped.tif.tmp"));
+    GDALWarpAppOptionsSetProgress(psOptions, oStep.GetProgressFunc(),
+                                  oStep.GetProgressData());
+    const int nDstBands = nBands + (bAddAlpha ? 1 : 0);
+    CPLString osTmpFile(GetTmpFilename(
+        pszDstFilename, "warped.tif.tmp",
+        double(nXSize) * nYSize * nDstBands *
+            GDALGetDataTypeSizeBytes(poFirstBand->GetRasterDataType())));
     auto hSrcDS = GDALDataset::ToHandle(poSrcDS);
 
     std::unique_ptr<CPLConfigOptionSetter> poWarpThreadSetter;
@@ -701,9 +778,6 @@ static std::unique_ptr<GDALDataset> CreateReprojectedDS(
 
     auto hRet = GDALWarp(osTmpFile, nullptr, 1, &hSrcDS, psOptions, nullptr);
     GDALWarpAppOptionsFree(psOptions);
-    CPLDebug("COG", "Reprojecting source dataset: end");
-
-    GDALDestroyScaledProgress(pScaledProgress);
 
     return std::unique_ptr<GDALDataset>(GDALDataset::FromHandle(hRet));
 }
@@ -1118,10 +1192,15 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
     aosOverviewOptions.SetNameValue("BIGTIFF", "YES");
     aosOverviewOptions.SetNameValue("SPARSE_OK", "YES");
 
+    // Uncompressed size of a single band overview dataset
+    double dfOverviewPixels = 0;
+    for (const auto &oDims : asOverviewDims)
+        dfOverviewPixels += double(oDims.first) * oDims.second;
+
     if (bGenerateMskOvr)
     {
-        CPLDebug("COG", "Generating overviews of the mask: start");
-        m_osTmpMskOverviewFilename = GetTmpFilename(pszFilename, "msk.ovr.tmp");
+        m_osTmpMskOverviewFilename =
+            GetTmpFilename(pszFilename, "msk.ovr.tmp", dfOverviewPixels);
         GDALRasterBand *poSrcMask = poFirstBand->GetMaskBand();
         const char *pszResampling = CSLFetchNameValueDef(
             papszOptions, "OVERVIEW_RESAMPLING",
@@ -1129,19 +1208,17 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
                                  GetResampling(poSrcDS)));
 
         double dfNextPixels = dfCurPixels + double(nXSize) * nYSize / 3;
-        void *pScaledProgress = GDALCreateScaledProgress(
-            dfCurPixels / dfTotalPixelsToProcess,
-            dfNextPixels / dfTotalPixelsToProcess, pfnProgress, pProgressData);
+        COGStep oStep("Generating overviews of the mask",
+                      dfCurPixels / dfTotalPixelsToProcess,
+                      dfNextPixels / dfTotalPixelsToProcess, pfnProgress,
+                      pProgressData);
         dfCurPixels = dfNextPixels;
 
         CPLErr eErr = GTIFFBuildOverviewsEx(
             m_osTmpMskOverviewFilename, 1, &poSrcMask,
             static_cast<int>(asOverviewDims.size()), nullptr,
             asOverviewDims.data(), pszResampling, aosOverviewOptions.List(),
-            GDALScaledProgress, pScaledProgress);
-        CPLDebug("COG", "Generating overviews of the mask: end");
-
-        GDALDestroyScaledProgress(pScaledProgress);
+            oStep.GetProgressFunc(), oStep.GetProgressData());
         if (eErr != CE_None)
         {
             return nullptr;
@@ -1150,8 +1227,10 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
 
     if (bGenerateOvr)
     {
-        CPLDebug("COG", "Generating overviews of the imagery: start");
-        m_osTmpOverviewFilename = GetTmpFilename(pszFilename, "ovr.tmp");
+        m_osTmpOverviewFilename = GetTmpFilename(
+            pszFilename, "ovr.tmp",
+            dfOverviewPixels * nBands *
+                GDALGetDataTypeSizeBytes(poFirstBand->GetRasterDataType()));
         std::vector<GDALRasterBand *> apoSrcBands;
         for (int i = 0; i < nBands; i++)
             apoSrcBands.push_back(poCurDS->GetRasterBand(i + 1));
@@ -1162,9 +1241,10 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
 
         double dfNextPixels =
             dfCurPixels + double(nXSize) * nYSize * nBands / 3;
-        void *pScaledProgress = GDALCreateScaledProgress(
-            dfCurPixels / dfTotalPixelsToProcess,
-            dfNextPixels / dfTotalPixelsToProcess, pfnProgress, pProgressData);
+        COGStep oStep("Generating overviews of the imagery",
+                      dfCurPixels / dfTotalPixelsToProcess,
+                      dfNextPixels / dfTotalPixelsToProcess, pfnProgress,
+                      pProgressData);
         dfCurPixels = dfNextPixels;
 
         if (nBands > 1)
@@ -1180,10 +1260,7 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
             m_osTmpOverviewFilename, nBands, &apoSrcBands[0],
             static_cast<int>(asOverviewDims.size()), nullptr,
             asOverviewDims.data(), pszResampling, aosOverviewOptions.List(),
-            GDALScaledProgress, pScaledProgress);
-        CPLDebug("COG", "Generating overviews of the imagery: end");
-
-        GDALDestroyScaledProgress(pScaledProgress);
+            oStep.GetProgressFunc(), oStep.GetProgressData());
         if (eErr != CE_None)
         {
             return nullptr;
@@ -1342,9 +1419,6 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
         GDALDriver::FromHandle(GDALGetDriverByName("GTiff"));
     if (!poGTiffDrv)
         return nullptr;
-    void *pScaledProgress = GDALCreateScaledProgress(
-        dfCurPixels / dfTotalPixelsToProcess, 1.0, pfnProgress, pProgressData);
-
     CPLConfigOptionSetter oSetterInternalMask("GDAL_TIFF_INTERNAL_MASK", "YES",
                                               false);
 
@@ -1357,17 +1431,16 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
         aosOptions.AddNameValue("SRC_MDD", *papszSrcMDDIter);
     CSLDestroy(papszSrcMDD);
 
-    CPLDebug("COG", "Generating final product: start");
-    auto poRet =
-        poGTiffDrv->CreateCopy(pszFilename, poCurDS, false, aosOptions.List(),
-                               GDALScaledProgress, pScaledProgress);
-
-    GDALDestroyScaledProgress(pScaledProgress);
+    COGStep oStep("Generating final product",
+                  dfCurPixels / dfTotalPixelsToProcess, 1.0, pfnProgress,
+                  pProgressData);
+    auto poRet = poGTiffDrv->CreateCopy(
+        pszFilename, poCurDS, false, aosOptions.List(), oStep.GetProgressFunc(),
+        oStep.GetProgressData());
 
     if (poRet)
         poRet->FlushCache(false);
 
-    CPLDebug("COG", "Generating final product: end");
     return poRet;
 }
 
@@ -970,7 +970,10 @@ static void GTiffTagExtender(TIFF *tif)
         {TIFFTAG_TIFF_RSID, -1, -1, TIFF_ASCII, FIELD_CUSTOM, TRUE, FALSE,
          const_cast<char *>("TIFF_RSID")},
         {TIFFTAG_GEO_METADATA, TIFF_VARIABLE2, TIFF_VARIABLE2, TIFF_BYTE,
-         FIELD_CUSTOM, TRUE, TRUE, const_cast<char *>("GEO_METADATA")}};
+         FIELD_CUSTOM, TRUE, TRUE, const_cast<char *>("GEO_METADATA")},
+        {TIFFTAG_GDAL_BLOCK_STATISTICS, TIFF_VARIABLE2, TIFF_VARIABLE2,
+         TIFF_DOUBLE, FIELD_CUSTOM, TRUE, TRUE,
+         const_cast<char *>("GDALBlockStatistics")}};
 
     if (_ParentExtender)
         (*_ParentExtender)(tif);
@@ -1465,6 +1468,9 @@ void GDALRegister_GTiff()
         "   </Option>"
         "   <Option name='SPARSE_OK' type='boolean' description='Should empty "
         "blocks be omitted on disk?' default='FALSE'/>"
+        "   <Option name='BLOCK_STATISTICS' type='boolean' "
+        "description='Whether to store statistics of each block, to compute "
+        "exact band statistics without reading pixels' default='NO'/>"
         "   <Option name='ALPHA' type='string-select' description='Mark first "
         "extrasample as being alpha'>"
         "       <Value>NON-PREMULTIPLIED</Value>"
@@ -1593,6 +1599,10 @@ void GDALRegister_GTiff()
     poDriver->pfnCreateCopy = GTiffDataset::CreateCopy;
     poDriver->pfnUnloadDriver = GDALDeregister_GTiff;
     poDriver->pfnIdentify = GTiffDataset::Identify;
+    poDriver->SetMetadataItem(GDAL_DMD_IDENTIFY_SIGNATURES,
+                              "magic:0:49492A00 magic:0:4D4D002A "
+                              "magic:0:49492B00 magic:0:4D4D002B "
+                              "prefix:GTIFF_DIR: prefix:GTIFF_RAW:");
     poDriver->pfnGetSubdatasetInfoFunc = GTiffDriverGetSubdatasetInfo;
 
     GetGDALDriverManager()->RegisterDriver(poDriver);
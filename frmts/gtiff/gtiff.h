@@ -108,6 +108,10 @@ int &GTIFFGetThreadLocalLibtiffError();
 
 #endif
 
+// Private GDAL tag, in the reusable range of the TIFF specification, holding
+// per-strile statistics written with the BLOCK_STATISTICS creation option.
+#define TIFFTAG_GDAL_BLOCK_STATISTICS 65400
+
 #if !defined(PREDICTOR_NONE)
 #define PREDICTOR_NONE 1
 #endif
@@ -241,6 +241,13 @@ std::tuple<CPLErr, bool> GTiffDataset::Finalize()
 
         for (int i = 0; i < static_cast<int>(m_asCompressionJobs.size()); ++i)
         {
+            // Job whose result has not been written (error case)
+            if (m_asCompressionJobs[i].nStripOrTile >= 0)
+            {
+                gnPendingCompressionBytes -= m_asCompressionJobs[i].nBufferSize;
+                AccountMemory("GTiff.compression_queue",
+                              -m_asCompressionJobs[i].nBufferSize);
+            }
             CPLFree(m_asCompressionJobs[i].pabyBuffer);
             if (m_asCompressionJobs[i].pszTmpFilename)
             {
@@ -776,6 +783,17 @@ bool GTiffDataset::IsBlockAvailable(int nBlockId, vsi_l_offset *pnOffset,
     // Strip/TileOffsets arrays.
     if (eAccess == GA_ReadOnly && !m_bStreamingIn)
     {
+        vsi_l_offset nOffset = 0;
+        vsi_l_offset nByteCount = 0;
+        if (GetStrileOffsetAndByteCount(nBlockId, nOffset, nByteCount))
+        {
+            if (pnOffset)
+                *pnOffset = nOffset;
+            if (pnSize)
+                *pnSize = nByteCount;
+            return nByteCount != 0;
+        }
+
         int nErrOccurred = 0;
         auto bytecount =
             TIFFGetStrileByteCountWithErr(m_hTIFF, nBlockId, &nErrOccurred);
@@ -32,7 +32,9 @@
 
 #include "gdal_pam.h"
 
+#include <atomic>
 #include <queue>
+#include <set>
 
 #include "cpl_mem_cache.h"
 #include "cpl_worker_thread_pool.h"  // CPLJobQueue, CPLWorkerThreadPool
@@ -110,6 +112,15 @@ class GTiffDataset final : public GDALPamDataset
         uint64_t nRoundUpBitTest;
     };
 
+    // Layout of TIFFTAG_GDAL_BLOCK_STATISTICS: a version number, then for
+    // each band whether a nodata value was taken into account and that nodata
+    // value, then for each band and each block of the band, the count of
+    // valid pixels (negative if unknown), the minimum, the maximum, the mean
+    // and the sum of squared differences to the mean.
+    static constexpr int BLOCK_STATS_VERSION = 1;
+    static constexpr int BLOCK_STATS_VALUES_PER_BAND = 2;
+    static constexpr int BLOCK_STATS_VALUES_PER_BLOCK = 5;
+
   private:
     CPL_DISALLOW_COPY_ASSIGN(GTiffDataset)
 
@@ -169,6 +180,35 @@ class GTiffDataset final : public GDALPamDataset
     lru11::Cache<int, std::pair<vsi_l_offset, vsi_l_offset>>
         m_oCacheStrileToOffsetByteCount{1024};
 
+    // Location in the file of the values of the [Tile|Strip]Offsets and
+    // [Tile|Strip]ByteCounts arrays, as declared in the IFD. nValueSize is
+    // 0 when unknown, or when the values are inlined in the IFD entry.
+    struct StrileArrayLocation
+    {
+        vsi_l_offset nOffset = 0;
+        uint64_t nCount = 0;
+        int nValueSize = 0;
+    };
+    bool m_bStrileArrayLocationsRead = false;
+    StrileArrayLocation m_sStrileOffsetsLocation{};
+    StrileArrayLocation m_sStrileByteCountsLocation{};
+    // Start offsets of the pages of the strile arrays already fetched by
+    // GTiffRasterBand::CacheStrileArrays()
+    std::set<vsi_l_offset> m_oSetCachedStrileArrayPages{};
+
+    // Pages of STRILE_ARRAY_PAGE_SIZE consecutive values of the strile
+    // arrays, when they are read by GDAL rather than by libtiff (see
+    // UsePagedStrileArrayCache())
+    struct StrileArrayPage
+    {
+        std::vector<uint64_t> anOffsets{};
+        std::vector<uint64_t> anByteCounts{};
+    };
+    static constexpr int STRILE_ARRAY_PAGE_SIZE = 4096;
+    bool m_bPagedStrileArrayCacheChecked = false;
+    std::unique_ptr<lru11::Cache<uint64_t, std::shared_ptr<StrileArrayPage>>>
+        m_poStrileArrayPageCache{};
+
     MaskOffset *m_panMaskOffsetLsb = nullptr;
     char *m_pszVertUnit = nullptr;
     char *m_pszFilename = nullptr;
@@ -192,6 +232,14 @@ class GTiffDataset final : public GDALPamDataset
 
     toff_t m_nDirOffset = 0;
 
+    // Maximum value of gnPendingCompressionBytes before SubmitCompressionJob()
+    // waits for the completion of the jobs of this dataset.
+    GIntBig m_nCompressionQueueMaxBytes = 0;
+
+    // Sum of the buffer sizes of the compression jobs submitted by all
+    // datasets whose result has not been written yet.
+    static std::atomic<GIntBig> gnPendingCompressionBytes;
+
     int m_nBlocksPerRow = 0;
     int m_nBlocksPerColumn = 0;
     int m_nBlocksPerBand = 0;
@@ -201,9 +249,20 @@ class GTiffDataset final : public GDALPamDataset
     uint32_t m_nRowsPerStrip = 0;
     int m_nLastBandRead = -1;        // Used for the all-in-on-strip case.
     int m_nLastWrittenBlockId = -1;  // used for m_bStreamingOut
+
+    // Compressed size of each strile, collected during the measuring pass
+    // of a compressed streamed CreateCopy().
+    std::vector<toff_t> m_anStreamingByteCounts{};
+
+    // Statistics of each strile, maintained when the dataset has been created
+    // with BLOCK_STATISTICS=YES. See the BLOCK_STATS_xxx constants for the
+    // layout.
+    std::vector<double> m_adfBlockStatistics{};
     int m_nRefBaseMapping = 0;
     int m_nGCPCount = 0;
     int m_nDisableMultiThreadedRead = 0;
+    int m_nReadAheadBlocks = -1;  // -1 = not yet initialized
+    int m_nReadAheadLastBlockId = -1;
 
     GTIFFKeysFlavorEnum m_eGeoTIFFKeysFlavor = GEOTIFF_KEYS_STANDARD;
     GeoTIFFVersionEnum m_eGeoTIFFVersion = GEOTIFF_VERSION_AUTO;
@@ -262,6 +321,8 @@ class GTiffDataset final : public GDALPamDataset
     bool m_bStreamingOut : 1;
     bool m_bScanDeferred : 1;
     bool m_bSingleIFDOpened = false;
+    bool m_bStreamingMeasurePass = false;
+    bool m_bBlockStatisticsDirty = false;
     bool m_bLoadedBlockDirty : 1;
     bool m_bWriteError : 1;
     bool m_bLookedForProjection : 1;
@@ -378,8 +439,20 @@ class GTiffDataset final : public GDALPamDataset
     void WaitCompletionForBlock(int nBlockId);
     void WriteRawStripOrTile(int nStripOrTile, GByte *pabyCompressedBuffer,
                              GPtrDiff_t nCompressedBufferSize);
+    void SetupCompressionJob(GTiffCompressionJob &sJob, int nStripOrTile,
+                             GByte *pabyData, GPtrDiff_t cc, int nHeight);
     bool SubmitCompressionJob(int nStripOrTile, GByte *pabyData, GPtrDiff_t cc,
                               int nHeight);
+    bool WriteStreamingStripOrTile(uint32_t nStripOrTile, GByte *pabyData,
+                                   GPtrDiff_t cc, int nHeight);
+    bool WriteStreamingHeader();
+
+    void InitBlockStatistics(CSLConstList papszOptions);
+    void LoadBlockStatistics();
+    void SetBlockStatisticsTag();
+    size_t GetBlockStatisticsIndex(int iBand, int nBlockInBand) const;
+    void UpdateBlockStatistics(int nStripOrTile, const GByte *pabyData);
+    bool WriteBlockStatistics();
 
     int GuessJPEGQuality(bool &bOutHasQuantizationTable,
                          bool &bOutHasHuffmanTable);
@@ -424,16 +497,41 @@ class GTiffDataset final : public GDALPamDataset
 
     CPLErr FlushCacheInternal(bool bAtClosing, bool bFlushDirectory);
     bool HasOptimizedReadMultiRange();
+    void ReadStrileArrayLocations();
+    bool UsePagedStrileArrayCache();
+    bool LoadStrileArrayPages(const std::set<uint64_t> &oSetPages);
+    bool GetStrileOffsetAndByteCount(int nBlockId, vsi_l_offset &nOffset,
+                                     vsi_l_offset &nByteCount);
+    vsi_l_offset GetStrileOffset(int nBlockId);
+    vsi_l_offset GetStrileByteCount(int nBlockId);
+
+    struct MultiRangePlan
+    {
+        std::vector<vsi_l_offset> anOffsets{};
+        std::vector<size_t> anSizes{};
+        size_t nTotalSize = 0;  // Sum of anSizes[], including the gaps read
+        int nMaxParallelRequests = 0;
+    };
+    static MultiRangePlan
+    PlanMultiRange(std::vector<std::pair<vsi_l_offset, size_t>> &aOffsetSize,
+                   size_t nMaxTotalSize, const char *pszWhat);
+    static void *ReadMultiRangePlan(VSILFILE *fp, const MultiRangePlan &sPlan,
+                                    std::vector<void *> &apData);
 
     bool AssociateExternalMask();
 
     static bool MustCreateInternalMask();
 
+    static bool CanCopyRawStriles(const GTiffDataset *poDstDS,
+                                  const GTiffDataset *poSrcDS,
+                                  bool bLossyOptionsSet);
+
     static CPLErr CopyImageryAndMask(GTiffDataset *poDstDS,
                                      GDALDataset *poSrcDS,
                                      GDALRasterBand *poSrcMaskBand,
                                      GDALProgressFunc pfnProgress,
-                                     void *pProgressData);
+                                     void *pProgressData,
+                                     GTiffDataset *poSrcRawDS = nullptr);
 
     bool GetOverviewParameters(int &nCompression, uint16_t &nPlanarConfig,
                                uint16_t &nPredictor, uint16_t &nPhotometric,
@@ -474,6 +572,7 @@ class GTiffDataset final : public GDALPamDataset
                              void *pData, GDALDataType eBufType, int nBandCount,
                              const int *panBandMap, GSpacing nPixelSpace,
                              GSpacing nLineSpace, GSpacing nBandSpace);
+    void ReadAhead(GTiffRasterBand *poBand, int nBlockXOff, int nBlockYOff);
 
     virtual CPLErr IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                              int nXSize, int nYSize, void *pData, int nBufXSize,
@@ -516,6 +615,7 @@ class GTiffDataset final : public GDALPamDataset
                                    GDALProgressFunc pfnProgress,
                                    void *pProgressData);
     virtual CPLErr FlushCache(bool bAtClosing) override;
+    GIntBig TrimMemory(GIntBig nBytesToRelease) override;
 
     virtual char **GetMetadataDomainList() override;
     virtual CPLErr SetMetadata(char **, const char * = "") override;
@@ -546,7 +646,7 @@ class GTiffDataset final : public GDALPamDataset
                           int nBands, GDALDataType eType,
                           double dfExtraSpaceForOverviews,
                           char **papszParamList, VSILFILE **pfpL,
-                          CPLString &osTmpFilename);
+                          CPLString &osTmpFilename, bool bCreateCopy = false);
 
     CPLErr WriteEncodedTileOrStrip(uint32_t tile_or_strip, void *data,
                                    int bPreserveDataBuffer);
@@ -48,6 +48,7 @@
 
 #include "cpl_error.h"
 #include "cpl_error_internal.h"  // CPLErrorHandlerAccumulatorStruct
+#include "cpl_trace.h"
 #include "cpl_vsi.h"
 #include "cpl_vsi_virtual.h"
 #include "cpl_worker_thread_pool.h"
@@ -430,6 +431,11 @@ static void CPL_STDCALL ThreadDecompressionFuncErrorHandler(
     auto psContext = psJob->psContext;
     auto poDS = psContext->poDS;
 
+    CPLTraceSpan oSpan("gtiff", "GTiffDataset::ThreadDecompressionFunc");
+    if (oSpan.IsEnabled())
+        oSpan.AddArg("block",
+                     CPLSPrintf("%d,%d", psJob->nXBlock, psJob->nYBlock));
+
     CPLErrorHandlerPusher oErrorHandler(ThreadDecompressionFuncErrorHandler,
                                         psContext);
 
@@ -494,6 +500,9 @@ static void CPL_STDCALL ThreadDecompressionFuncErrorHandler(
 
     if (psJob->nSize == 0)
     {
+        // Nothing to prefetch for sparse blocks
+        if (psContext->pabyData == nullptr)
+            return;
         {
             std::lock_guard<std::mutex> oLock(psContext->oMutex);
             if (!psContext->bSuccess)
@@ -690,9 +699,11 @@ static void CPL_STDCALL ThreadDecompressionFuncErrorHandler(
     }
 
     const int nDTSize = GDALGetDataTypeSizeBytes(psContext->eDT);
-    GByte *pDstPtr = psContext->pabyData +
-                     nYOffsetInData * psContext->nLineSpace +
-                     nXOffsetInData * psContext->nPixelSpace;
+    GByte *pDstPtr = psContext->pabyData
+                         ? psContext->pabyData +
+                               nYOffsetInData * psContext->nLineSpace +
+                               nXOffsetInData * psContext->nPixelSpace
+                         : nullptr;
 
     if (nAlreadyLoadedBlocks != nBandsToCache)
     {
@@ -929,6 +940,10 @@ static void CPL_STDCALL ThreadDecompressionFuncErrorHandler(
 
     CPLAssert(!psContext->bSkipBlockCache);
 
+    // Read-ahead only fills the block cache
+    if (psContext->pabyData == nullptr)
+        return;
+
     // Compose cached blocks into final buffer
     for (int i = 0; i < nBandsToWrite; ++i)
     {
@@ -1106,6 +1121,14 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
         }
     }
 
+    // pData == nullptr is used by ReadAhead() to only fill the block cache
+    if (pData == nullptr)
+    {
+        sContext.bSkipBlockCache = false;
+        sContext.bUseBIPOptim = false;
+        sContext.bUseDeinterleaveOptimNoBlockCache = false;
+    }
+
     // In contig mode, if only one band is requested, check if we have
     // enough cache to cache all bands.
     if (!sContext.bSkipBlockCache && nBands != 1 &&
@@ -1262,11 +1285,29 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
                      &sContext.pExtraSamples);
     }
 
+    // When the internal mask is interleaved with the imagery (COG layout),
+    // fetch its striles in the same AdviseRead() batch as the imagery ones,
+    // and decode them in the mask band block cache afterwards.
+    const bool bFuseMask =
+        eAccess == GA_ReadOnly && sContext.bHasPRead && m_poMaskDS &&
+        m_bMaskInterleavedWithImagery && m_poMaskDS->m_poImageryDS == this &&
+        m_poMaskDS->GetRasterCount() == 1 && nStrilePerBlock == 1 &&
+        m_poMaskDS->m_nBlockXSize == m_nBlockXSize &&
+        m_poMaskDS->m_nBlockYSize == m_nBlockYSize;
+    struct MaskStrile
+    {
+        int nXBlock;
+        int nYBlock;
+        vsi_l_offset nOffset;
+        size_t nSize;
+    };
+    std::vector<MaskStrile> asMaskStriles;
+
     // Create one job per tile/strip
     vsi_l_offset nFileSize = 0;
     std::vector<GTiffDecompressJob> asJobs(nBlocks);
-    std::vector<vsi_l_offset> anOffsets(nBlocks);
-    std::vector<size_t> anSizes(nBlocks);
+    std::vector<vsi_l_offset> anOffsets(bFuseMask ? 2 * nBlocks : nBlocks);
+    std::vector<size_t> anSizes(anOffsets.size());
     int iJob = 0;
     int nAdviseReadRanges = 0;
     for (int y = 0; y < nYBlocks; ++y)
@@ -1378,6 +1419,32 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
                     ++nAdviseReadRanges;
                 }
 
+                if (bFuseMask)
+                {
+                    auto poMaskBlock =
+                        m_poMaskDS->GetRasterBand(1)->TryGetLockedBlockRef(
+                            asJobs[iJob].nXBlock, asJobs[iJob].nYBlock);
+                    vsi_l_offset nMaskOffset = 0;
+                    vsi_l_offset nMaskSize = 0;
+                    if (poMaskBlock)
+                    {
+                        poMaskBlock->DropLock();
+                    }
+                    else if (m_poMaskDS->IsBlockAvailable(
+                                 nBlockId, &nMaskOffset, &nMaskSize) &&
+                             nMaskSize > 0 &&
+                             nMaskSize <= 100U * 1024 * 1024)
+                    {
+                        anOffsets[nAdviseReadRanges] = nMaskOffset;
+                        anSizes[nAdviseReadRanges] =
+                            static_cast<size_t>(nMaskSize);
+                        ++nAdviseReadRanges;
+                        asMaskStriles.push_back(
+                            {asJobs[iJob].nXBlock, asJobs[iJob].nYBlock,
+                             nMaskOffset, static_cast<size_t>(nMaskSize)});
+                    }
+                }
+
                 ++iJob;
             }
         }
@@ -1412,11 +1479,246 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
         {
             CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
         }
+
+        if (sContext.bSuccess && !asMaskStriles.empty())
+        {
+            // The mask striles have been fetched together with the imagery
+            // ones, so those PRead() calls are served by the AdviseRead()
+            // ranges.
+            std::vector<std::vector<GByte>> aabyMaskData;
+            std::vector<void *> apMaskData;
+            std::vector<vsi_l_offset> anMaskOffsets;
+            std::vector<size_t> anMaskSizes;
+            try
+            {
+                aabyMaskData.resize(asMaskStriles.size());
+                for (size_t i = 0; i < asMaskStriles.size(); ++i)
+                {
+                    const auto &sStrile = asMaskStriles[i];
+                    aabyMaskData[i].resize(sStrile.nSize);
+                    if (sContext.poHandle->PRead(aabyMaskData[i].data(),
+                                                 sStrile.nSize,
+                                                 sStrile.nOffset) !=
+                        sStrile.nSize)
+                    {
+                        break;
+                    }
+                    apMaskData.push_back(aabyMaskData[i].data());
+                    anMaskOffsets.push_back(sStrile.nOffset);
+                    anMaskSizes.push_back(sStrile.nSize);
+                }
+            }
+            catch (const std::exception &)
+            {
+                apMaskData.clear();
+                anMaskOffsets.clear();
+                anMaskSizes.clear();
+            }
+
+            if (!apMaskData.empty())
+            {
+                CPLDebug("GTiff",
+                         "Decoding %d mask striles fetched with imagery",
+                         static_cast<int>(apMaskData.size()));
+                auto thMask = TIFFClientdata(m_poMaskDS->m_hTIFF);
+                VSI_TIFFSetCachedRanges(thMask,
+                                        static_cast<int>(apMaskData.size()),
+                                        apMaskData.data(), anMaskOffsets.data(),
+                                        anMaskSizes.data());
+                auto poMaskBand = m_poMaskDS->GetRasterBand(1);
+                for (size_t i = 0; i < apMaskData.size(); ++i)
+                {
+                    auto poBlock = poMaskBand->GetLockedBlockRef(
+                        asMaskStriles[i].nXBlock, asMaskStriles[i].nYBlock);
+                    if (poBlock)
+                        poBlock->DropLock();
+                }
+                VSI_TIFFSetCachedRanges(thMask, 0, nullptr, nullptr, nullptr);
+            }
+        }
     }
 
     return sContext.bSuccess ? CE_None : CE_Failure;
 }
 
+/************************************************************************/
+/*                        LoadBlockStatistics()                         */
+/************************************************************************/
+
+void GTiffDataset::LoadBlockStatistics()
+{
+    uint32_t nCount = 0;
+    double *padfValues = nullptr;
+    if (!TIFFGetField(m_hTIFF, TIFFTAG_GDAL_BLOCK_STATISTICS, &nCount,
+                      &padfValues) ||
+        padfValues == nullptr)
+    {
+        return;
+    }
+    if (nCount != GetBlockStatisticsIndex(nBands, 0) ||
+        padfValues[0] != BLOCK_STATS_VERSION)
+    {
+        CPLDebug("GTiff", "Ignoring TIFFTAG_GDAL_BLOCK_STATISTICS of "
+                          "unexpected size or version");
+        return;
+    }
+    try
+    {
+        m_adfBlockStatistics.assign(padfValues, padfValues + nCount);
+    }
+    catch (const std::exception &)
+    {
+        ReportError(CE_Warning, CPLE_OutOfMemory,
+                    "Cannot load TIFFTAG_GDAL_BLOCK_STATISTICS");
+    }
+}
+
+/************************************************************************/
+/*                             ReadAhead()                              */
+/************************************************************************/
+
+// Called by GTiffRasterBand::IReadBlock() after a block has been read, to
+// decode, with the thread pool, blocks that are likely to be requested next:
+// the following blocks when the access pattern is sequential, or the
+// neighbouring tiles when it is local.
+void GTiffDataset::ReadAhead(GTiffRasterBand *poBand, int nBlockXOff,
+                             int nBlockYOff)
+{
+    if (m_nDisableMultiThreadedRead != 0 || m_poThreadPool == nullptr ||
+        eAccess != GA_ReadOnly || m_bDirectIO || m_bLoadingOtherBands ||
+        !IsMultiThreadedReadCompatible())
+    {
+        return;
+    }
+
+    const GDALDataType eDT = poBand->GetRasterDataType();
+    if (m_nReadAheadBlocks < 0)
+    {
+        const char *pszReadAhead = CPLGetConfigOption("GTIFF_READ_AHEAD", "");
+        m_nReadAheadBlocks = pszReadAhead[0]
+                                 ? std::max(0, atoi(pszReadAhead))
+                                 : 2 * m_poThreadPool->GetThreadCount();
+        // Do not evict from the block cache more than a fraction of it
+        const GIntBig nBytesPerBlock =
+            static_cast<GIntBig>(m_nBlockXSize) * m_nBlockYSize *
+            GDALGetDataTypeSizeBytes(eDT) *
+            (m_nPlanarConfig == PLANARCONFIG_CONTIG ? nBands : 1);
+        m_nReadAheadBlocks = static_cast<int>(std::min<GIntBig>(
+            m_nReadAheadBlocks, GDALGetCacheMax64() / 4 / nBytesPerBlock));
+        if (m_nReadAheadBlocks > 0)
+        {
+            CPLDebug("GTiff", "Read-ahead of up to %d blocks enabled",
+                     m_nReadAheadBlocks);
+        }
+    }
+    if (m_nReadAheadBlocks == 0)
+        return;
+
+    const int nBlockId = poBand->ComputeBlockId(nBlockXOff, nBlockYOff);
+    const int nLastBlockId = m_nReadAheadLastBlockId;
+    m_nReadAheadLastBlockId = nBlockId;
+
+    int nBlockXStart = 0;
+    int nBlockYStart = 0;
+    int nBlockXEnd = 0;
+    int nBlockYEnd = 0;
+    const bool bSequential = nLastBlockId >= 0 && nBlockId == nLastBlockId + 1;
+    if (bSequential)
+    {
+        // Sequential access: read the next blocks of the row of tiles, or
+        // the next strips.
+        if (m_nBlocksPerRow == 1)
+        {
+            nBlockYStart = nBlockYOff + 1;
+            nBlockYEnd = std::min(m_nBlocksPerColumn - 1,
+                                  nBlockYOff + m_nReadAheadBlocks);
+        }
+        else
+        {
+            nBlockYStart = nBlockYOff;
+            nBlockXStart = nBlockXOff + 1;
+            if (nBlockXStart == m_nBlocksPerRow)
+            {
+                nBlockXStart = 0;
+                ++nBlockYStart;
+            }
+            nBlockYEnd = nBlockYStart;
+            nBlockXEnd = std::min(m_nBlocksPerRow - 1,
+                                  nBlockXStart + m_nReadAheadBlocks - 1);
+        }
+        if (nBlockYStart >= m_nBlocksPerColumn || nBlockYEnd < nBlockYStart)
+            return;
+    }
+    else if (nLastBlockId >= 0 && m_nBlocksPerRow > 1 &&
+             nLastBlockId / m_nBlocksPerBand == nBlockId / m_nBlocksPerBand &&
+             std::abs(nLastBlockId % m_nBlocksPerRow - nBlockXOff) <= 1 &&
+             std::abs((nLastBlockId % m_nBlocksPerBand) / m_nBlocksPerRow -
+                      nBlockYOff) <= 1)
+    {
+        // Local random access: read the neighbouring tiles.
+        nBlockXStart = std::max(0, nBlockXOff - 1);
+        nBlockYStart = std::max(0, nBlockYOff - 1);
+        nBlockXEnd = std::min(m_nBlocksPerRow - 1, nBlockXOff + 1);
+        nBlockYEnd = std::min(m_nBlocksPerColumn - 1, nBlockYOff + 1);
+        if ((nBlockXEnd - nBlockXStart + 1) * (nBlockYEnd - nBlockYStart + 1) >
+            m_nReadAheadBlocks + 1)
+            return;
+    }
+    else
+    {
+        return;
+    }
+
+    const int nXOff = nBlockXStart * m_nBlockXSize;
+    const int nYOff = nBlockYStart * m_nBlockYSize;
+    const int nXSize =
+        std::min(nRasterXSize, (nBlockXEnd + 1) * m_nBlockXSize) - nXOff;
+    const int nYSize =
+        std::min(nRasterYSize, (nBlockYEnd + 1) * m_nBlockYSize) - nYOff;
+
+    std::vector<int> anBandMap;
+    if (m_nPlanarConfig == PLANARCONFIG_CONTIG)
+    {
+        for (int i = 1; i <= nBands; ++i)
+            anBandMap.push_back(i);
+    }
+    else
+    {
+        anBandMap.push_back(poBand->GetBand());
+    }
+
+    CPLErr eErr;
+    {
+        // Errors will be reported if the blocks are actually requested
+        CPLErrorStateBackuper oErrorStateBackuper;
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        eErr = MultiThreadedRead(nXOff, nYOff, nXSize, nYSize, nullptr, eDT,
+                                 static_cast<int>(anBandMap.size()),
+                                 anBandMap.data(), 0, 0, 0);
+    }
+    if (eErr != CE_None)
+    {
+        // Do not leave partially decoded blocks in the cache
+        for (int iBand : anBandMap)
+        {
+            for (int y = nBlockYStart; y <= nBlockYEnd; ++y)
+            {
+                for (int x = nBlockXStart; x <= nBlockXEnd; ++x)
+                {
+                    if (x != nBlockXOff || y != nBlockYOff)
+                        GetRasterBand(iBand)->FlushBlock(x, y, FALSE);
+                }
+            }
+        }
+    }
+    else if (bSequential)
+    {
+        // Next sequential access will be after the read-ahead blocks
+        m_nReadAheadLastBlockId =
+            poBand->ComputeBlockId(nBlockXEnd, nBlockYEnd);
+    }
+}
+
 /************************************************************************/
 /*                        FetchBufferVirtualMemIO                       */
 /************************************************************************/
@@ -3168,6 +3470,47 @@ bool GTiffDataset::ReadStrile(int nBlockId, void *pOutputBuffer,
             return true;
         }
     }
+    // When the strile arrays are read by GDAL, read the strile ourselves so
+    // that libtiff does not need to load its own copy of the arrays.
+    else if (
+#if TIFFLIB_VERSION <= 20220520 && !defined(INTERNAL_LIBTIFF)
+        m_nCompression != COMPRESSION_JPEG &&
+#endif
+        GetStrileOffsetAndByteCount(nBlockId, oPair.first, oPair.second) &&
+        oPair.second > 0 &&
+        // Sanity check before allocating a buffer for a corrupted size.
+        // libtiff copes with that by reading the strile progressively.
+        oPair.second <= static_cast<vsi_l_offset>(nBlockReqSize) * 4 +
+                            1024 * 1024)
+    {
+        auto th = TIFFClientdata(m_hTIFF);
+        const size_t nSize = static_cast<size_t>(oPair.second);
+        void *pInputBuffer = VSI_TIFFGetCachedRange(th, oPair.first, nSize);
+        std::vector<GByte> abyInput;
+        if (!pInputBuffer)
+        {
+            try
+            {
+                abyInput.resize(nSize);
+            }
+            catch (const std::exception &)
+            {
+            }
+            VSILFILE *fp = VSI_TIFFGetVSILFile(th);
+            if (abyInput.size() == nSize &&
+                VSIFSeekL(fp, oPair.first, SEEK_SET) == 0 &&
+                VSIFReadL(abyInput.data(), 1, nSize, fp) == nSize)
+            {
+                pInputBuffer = abyInput.data();
+            }
+        }
+        if (pInputBuffer &&
+            TIFFReadFromUserBuffer(m_hTIFF, nBlockId, pInputBuffer, nSize,
+                                   pOutputBuffer, nBlockReqSize))
+        {
+            return true;
+        }
+    }
 
     // For debugging
     if (m_poBaseDS)
@@ -5254,6 +5597,8 @@ CPLErr GTiffDataset::OpenOffset(TIFF *hTIFFIn, toff_t nDirOffsetIn,
 
     m_bReadGeoTransform = bReadGeoTransform;
 
+    LoadBlockStatistics();
+
     /* -------------------------------------------------------------------- */
     /*      Capture some other potentially interesting information.         */
     /* -------------------------------------------------------------------- */
@@ -6598,3 +6943,502 @@ bool GTiffDataset::HasOptimizedReadMultiRange()
                "GTIFF_HAS_OPTIMIZED_READ_MULTI_RANGE", "NO")));
     return m_nHasOptimizedReadMultiRange != 0;
 }
+
+/************************************************************************/
+/*                          PlanMultiRange()                            */
+/************************************************************************/
+
+// Turns a set of byte ranges into the list of requests to issue with
+// VSIFReadMultiRangeL(). Each request costs a round-trip, so gaps are read
+// rather than issuing a new request when they are smaller than
+// GTIFF_MULTIRANGE_GAP_THRESHOLD, smallest gaps first. Larger gaps are also
+// bridged while there remain more than GTIFF_MULTIRANGE_MAX_PARALLEL_REQUESTS
+// requests, as long as nMaxTotalSize is not exceeded. Bridging a gap never
+// creates a request larger than GTIFF_MULTIRANGE_MAX_REQUEST_SIZE.
+// Contiguous or overlapping ranges are always merged.
+GTiffDataset::MultiRangePlan GTiffDataset::PlanMultiRange(
+    std::vector<std::pair<vsi_l_offset, size_t>> &aOffsetSize,
+    size_t nMaxTotalSize, const char *pszWhat)
+{
+    MultiRangePlan sPlan;
+    sPlan.nMaxParallelRequests = std::max(
+        1, atoi(CPLGetConfigOption("GTIFF_MULTIRANGE_MAX_PARALLEL_REQUESTS",
+                                   "16")));
+    const vsi_l_offset nGapThreshold =
+        static_cast<vsi_l_offset>(std::max<GIntBig>(
+            0, CPLAtoGIntBig(CPLGetConfigOption(
+                   "GTIFF_MULTIRANGE_GAP_THRESHOLD", "65536"))));
+    const vsi_l_offset nMaxRequestSize =
+        static_cast<vsi_l_offset>(std::max<GIntBig>(
+            0, CPLAtoGIntBig(CPLGetConfigOption(
+                   "GTIFF_MULTIRANGE_MAX_REQUEST_SIZE", "8388608"))));
+
+    std::sort(aOffsetSize.begin(), aOffsetSize.end());
+
+    // Merge contiguous or overlapping ranges into [start, end[ segments
+    std::vector<std::pair<vsi_l_offset, vsi_l_offset>> aSegments;
+    size_t nRangesSize = 0;
+    for (const auto &oRange : aOffsetSize)
+    {
+        if (oRange.second == 0)
+            continue;
+        nRangesSize += oRange.second;
+        const vsi_l_offset nEnd = oRange.first + oRange.second;
+        if (!aSegments.empty() && oRange.first <= aSegments.back().second)
+        {
+            aSegments.back().second = std::max(aSegments.back().second, nEnd);
+        }
+        else
+        {
+            aSegments.emplace_back(oRange.first, nEnd);
+        }
+    }
+    if (aSegments.empty())
+        return sPlan;
+
+    size_t nTotalSize = 0;
+    for (const auto &oSegment : aSegments)
+        nTotalSize += static_cast<size_t>(oSegment.second - oSegment.first);
+
+    // Consider gaps by increasing size. anRunStart[i] (resp. anRunEnd[i]) is
+    // the index of the first (resp. last) segment of the run of bridged
+    // segments that ends (resp. starts) at segment i.
+    const size_t nSegments = aSegments.size();
+    std::vector<size_t> anGapIdx;
+    for (size_t i = 0; i + 1 < nSegments; ++i)
+        anGapIdx.push_back(i);
+    const auto GetGap = [&aSegments](size_t i)
+    { return aSegments[i + 1].first - aSegments[i].second; };
+    std::stable_sort(anGapIdx.begin(), anGapIdx.end(),
+                     [&GetGap](size_t a, size_t b)
+                     { return GetGap(a) < GetGap(b); });
+    std::vector<size_t> anRunStart(nSegments);
+    std::vector<size_t> anRunEnd(nSegments);
+    for (size_t i = 0; i < nSegments; ++i)
+    {
+        anRunStart[i] = i;
+        anRunEnd[i] = i;
+    }
+    std::vector<bool> abBridged(nSegments, false);
+    size_t nRequests = nSegments;
+    size_t nGapBytes = 0;
+    for (const size_t i : anGapIdx)
+    {
+        const vsi_l_offset nGap = GetGap(i);
+        const bool bTooManyRequests =
+            nRequests > static_cast<size_t>(sPlan.nMaxParallelRequests);
+        if (nGap > nGapThreshold && !bTooManyRequests)
+            break;
+        const size_t iStart = anRunStart[i];
+        const size_t iEnd = anRunEnd[i + 1];
+        if (aSegments[iEnd].second - aSegments[iStart].first >
+                nMaxRequestSize ||
+            nTotalSize + nGap > nMaxTotalSize)
+        {
+            continue;
+        }
+        nTotalSize += static_cast<size_t>(nGap);
+        nGapBytes += static_cast<size_t>(nGap);
+        abBridged[i] = true;
+        anRunEnd[iStart] = iEnd;
+        anRunStart[iEnd] = iStart;
+        --nRequests;
+    }
+
+    for (size_t i = 0; i < nSegments; ++i)
+    {
+        const size_t iEnd = anRunEnd[i];
+        sPlan.anOffsets.push_back(aSegments[i].first);
+        sPlan.anSizes.push_back(
+            static_cast<size_t>(aSegments[iEnd].second - aSegments[i].first));
+#ifdef DEBUG_VERBOSE
+        CPLDebug("GTiff", "Requesting range [" CPL_FRMT_GUIB "-" CPL_FRMT_GUIB
+                 "]",
+                 sPlan.anOffsets.back(),
+                 sPlan.anOffsets.back() + sPlan.anSizes.back() - 1);
+#endif
+        i = iEnd;
+    }
+    sPlan.nTotalSize = nTotalSize;
+
+    const int nBatches = static_cast<int>(
+        DIV_ROUND_UP(sPlan.anOffsets.size(),
+                     static_cast<size_t>(sPlan.nMaxParallelRequests)));
+    CPLDebug("GTiff",
+             "Multi-range plan for %s: %d ranges of " CPL_FRMT_GUIB
+             " bytes read with %d request(s) in %d batch(es), " CPL_FRMT_GUIB
+             " bytes of gaps read",
+             pszWhat, static_cast<int>(aOffsetSize.size()),
+             static_cast<GUIntBig>(nRangesSize),
+             static_cast<int>(sPlan.anOffsets.size()), nBatches,
+             static_cast<GUIntBig>(nGapBytes));
+    return sPlan;
+}
+
+/************************************************************************/
+/*                        ReadMultiRangePlan()                          */
+/************************************************************************/
+
+// Allocates a buffer of sPlan.nTotalSize bytes, and fills it with the
+// requests of the plan, issuing at most sPlan.nMaxParallelRequests of them at
+// a time. apData[] receives the start of each request in the buffer.
+void *GTiffDataset::ReadMultiRangePlan(VSILFILE *fp,
+                                       const MultiRangePlan &sPlan,
+                                       std::vector<void *> &apData)
+{
+    apData.clear();
+    if (sPlan.nTotalSize == 0)
+        return nullptr;
+    GByte *pabyData =
+        static_cast<GByte *>(VSI_MALLOC_VERBOSE(sPlan.nTotalSize));
+    if (!pabyData)
+        return nullptr;
+    size_t nAccOffset = 0;
+    for (size_t nSize : sPlan.anSizes)
+    {
+        apData.push_back(pabyData + nAccOffset);
+        nAccOffset += nSize;
+    }
+    const size_t nRequests = sPlan.anOffsets.size();
+    for (size_t i = 0; i < nRequests;
+         i += static_cast<size_t>(sPlan.nMaxParallelRequests))
+    {
+        const int nBatchSize = static_cast<int>(
+            std::min(nRequests - i,
+                     static_cast<size_t>(sPlan.nMaxParallelRequests)));
+        if (VSIFReadMultiRangeL(nBatchSize, &apData[i], &sPlan.anOffsets[i],
+                                &sPlan.anSizes[i], fp) != 0)
+        {
+            VSIFree(pabyData);
+            apData.clear();
+            return nullptr;
+        }
+    }
+    return pabyData;
+}
+
+/************************************************************************/
+/*                      ReadStrileArrayLocations()                      */
+/************************************************************************/
+
+// libtiff does not expose where the values of the strile arrays are, so
+// parse the IFD entries ourselves. This is only used to prefetch the parts of
+// the arrays that libtiff will lazily read.
+void GTiffDataset::ReadStrileArrayLocations()
+{
+    if (m_bStrileArrayLocationsRead)
+        return;
+    m_bStrileArrayLocationsRead = true;
+
+    const bool bBigTIFF = CPL_TO_BOOL(TIFFIsBigTIFF(m_hTIFF));
+    const bool bSwab = CPL_TO_BOOL(TIFFIsByteSwapped(m_hTIFF));
+    const bool bIsTiled = CPL_TO_BOOL(TIFFIsTiled(m_hTIFF));
+    const uint16_t nTagOffsets =
+        bIsTiled ? TIFFTAG_TILEOFFSETS : TIFFTAG_STRIPOFFSETS;
+    const uint16_t nTagByteCounts =
+        bIsTiled ? TIFFTAG_TILEBYTECOUNTS : TIFFTAG_STRIPBYTECOUNTS;
+
+    VSILFILE *fp = VSI_TIFFGetVSILFile(TIFFClientdata(m_hTIFF));
+    uint64_t nEntries = 0;
+    if (VSIFSeekL(fp, m_nDirOffset, SEEK_SET) != 0)
+        return;
+    if (bBigTIFF)
+    {
+        if (VSIFReadL(&nEntries, sizeof(uint64_t), 1, fp) != 1)
+            return;
+        if (bSwab)
+            CPL_SWAP64PTR(&nEntries);
+    }
+    else
+    {
+        uint16_t nEntries16 = 0;
+        if (VSIFReadL(&nEntries16, sizeof(uint16_t), 1, fp) != 1)
+            return;
+        if (bSwab)
+            CPL_SWAP16PTR(&nEntries16);
+        nEntries = nEntries16;
+    }
+    // Sanity check: the number of tags defined by TIFF and its extensions
+    // is far below that.
+    if (nEntries > 4096)
+        return;
+
+    const size_t nEntrySize = bBigTIFF ? 20 : 12;
+    std::vector<GByte> abyEntries(static_cast<size_t>(nEntries) * nEntrySize);
+    if (VSIFReadL(abyEntries.data(), 1, abyEntries.size(), fp) !=
+        abyEntries.size())
+        return;
+
+    for (size_t i = 0; i < static_cast<size_t>(nEntries); ++i)
+    {
+        const GByte *pabyEntry = abyEntries.data() + i * nEntrySize;
+        uint16_t nTag;
+        uint16_t nType;
+        memcpy(&nTag, pabyEntry, sizeof(nTag));
+        memcpy(&nType, pabyEntry + 2, sizeof(nType));
+        if (bSwab)
+        {
+            CPL_SWAP16PTR(&nTag);
+            CPL_SWAP16PTR(&nType);
+        }
+        StrileArrayLocation *psLocation =
+            nTag == nTagOffsets      ? &m_sStrileOffsetsLocation
+            : nTag == nTagByteCounts ? &m_sStrileByteCountsLocation
+                                     : nullptr;
+        if (!psLocation)
+            continue;
+
+        const int nValueSize = nType == TIFF_SHORT ? 2
+                               : nType == TIFF_LONG ? 4
+                               : (nType == TIFF_LONG8 || nType == TIFF_SLONG8)
+                                   ? 8
+                                   : 0;
+        uint64_t nCount;
+        uint64_t nOffset;
+        if (bBigTIFF)
+        {
+            memcpy(&nCount, pabyEntry + 4, sizeof(nCount));
+            memcpy(&nOffset, pabyEntry + 12, sizeof(nOffset));
+            if (bSwab)
+            {
+                CPL_SWAP64PTR(&nCount);
+                CPL_SWAP64PTR(&nOffset);
+            }
+        }
+        else
+        {
+            uint32_t nCount32;
+            uint32_t nOffset32;
+            memcpy(&nCount32, pabyEntry + 4, sizeof(nCount32));
+            memcpy(&nOffset32, pabyEntry + 8, sizeof(nOffset32));
+            if (bSwab)
+            {
+                CPL_SWAP32PTR(&nCount32);
+                CPL_SWAP32PTR(&nOffset32);
+            }
+            nCount = nCount32;
+            nOffset = nOffset32;
+        }
+        // Values inlined in the IFD entry are already known by libtiff.
+        if (nValueSize == 0 ||
+            nCount * nValueSize <= static_cast<uint64_t>(bBigTIFF ? 8 : 4))
+            continue;
+        psLocation->nOffset = nOffset;
+        psLocation->nCount = nCount;
+        psLocation->nValueSize = nValueSize;
+    }
+}
+
+/************************************************************************/
+/*                      UsePagedStrileArrayCache()                      */
+/************************************************************************/
+
+// Whether the strile offsets and byte counts are read by GDAL, by pages of
+// STRILE_ARRAY_PAGE_SIZE values kept in a LRU cache, rather than by libtiff.
+// libtiff lazily reads the values it needs too, but it keeps them all in
+// memory, in arrays whose size grows with the number of striles. This is
+// the default for remote files with a large number of striles.
+bool GTiffDataset::UsePagedStrileArrayCache()
+{
+    if (m_bPagedStrileArrayCacheChecked)
+        return m_poStrileArrayPageCache != nullptr;
+    m_bPagedStrileArrayCacheChecked = true;
+
+    if (eAccess != GA_ReadOnly || m_bStreamingIn)
+        return false;
+    const char *pszVal =
+        CPLGetConfigOption("GTIFF_PAGED_STRILE_ARRAY_CACHE", "AUTO");
+    const bool bAuto = EQUAL(pszVal, "AUTO");
+    if (!bAuto && !CPLTestBool(pszVal))
+        return false;
+    if (bAuto && !HasOptimizedReadMultiRange())
+        return false;
+
+    ReadStrileArrayLocations();
+    const uint64_t nStriles = static_cast<uint64_t>(
+        TIFFIsTiled(m_hTIFF) ? TIFFNumberOfTiles(m_hTIFF)
+                             : TIFFNumberOfStrips(m_hTIFF));
+    if (m_sStrileOffsetsLocation.nValueSize == 0 ||
+        m_sStrileByteCountsLocation.nValueSize == 0 ||
+        m_sStrileOffsetsLocation.nCount != nStriles ||
+        m_sStrileByteCountsLocation.nCount != nStriles)
+    {
+        return false;
+    }
+    // Below that, the strile arrays are no more than a few MB
+    constexpr uint64_t MIN_STRILE_COUNT_FOR_AUTO = 256 * 1024;
+    if (bAuto && nStriles < MIN_STRILE_COUNT_FOR_AUTO)
+        return false;
+
+    const int nPages = std::max(
+        1, atoi(CPLGetConfigOption("GTIFF_STRILE_ARRAY_CACHE_PAGES", "128")));
+    m_poStrileArrayPageCache = std::make_unique<
+        lru11::Cache<uint64_t, std::shared_ptr<StrileArrayPage>>>(nPages, 0);
+    CPLDebug("GTiff", "Using paged cache of strile arrays for %s",
+             m_pszFilename);
+    return true;
+}
+
+/************************************************************************/
+/*                        LoadStrileArrayPages()                        */
+/************************************************************************/
+
+// Reads the pages of the strile arrays that are not yet in the cache, with
+// a single planned multi-range read.
+bool GTiffDataset::LoadStrileArrayPages(const std::set<uint64_t> &oSetPages)
+{
+    if (!UsePagedStrileArrayCache())
+        return false;
+
+    const uint64_t nStriles = m_sStrileOffsetsLocation.nCount;
+    std::vector<uint64_t> anPagesToLoad;
+    std::vector<std::pair<vsi_l_offset, size_t>> aOffsetSize;
+    for (const uint64_t nPage : oSetPages)
+    {
+        if (anPagesToLoad.size() >= m_poStrileArrayPageCache->getMaxSize())
+            break;
+        if (nPage * STRILE_ARRAY_PAGE_SIZE >= nStriles ||
+            m_poStrileArrayPageCache->contains(nPage))
+            continue;
+        anPagesToLoad.push_back(nPage);
+        const uint64_t nValues = std::min<uint64_t>(
+            STRILE_ARRAY_PAGE_SIZE, nStriles - nPage * STRILE_ARRAY_PAGE_SIZE);
+        for (const auto *psLocation :
+             {&m_sStrileOffsetsLocation, &m_sStrileByteCountsLocation})
+        {
+            aOffsetSize.emplace_back(
+                psLocation->nOffset +
+                    nPage * STRILE_ARRAY_PAGE_SIZE * psLocation->nValueSize,
+                static_cast<size_t>(nValues * psLocation->nValueSize));
+        }
+    }
+    if (anPagesToLoad.empty())
+        return true;
+
+    const auto aOffsetSizeUnsorted = aOffsetSize;
+    const unsigned int nMaxRawBlockCacheSize = atoi(
+        CPLGetConfigOption("GDAL_MAX_RAW_BLOCK_CACHE_SIZE", "10485760"));
+    const MultiRangePlan sPlan = PlanMultiRange(
+        aOffsetSize, nMaxRawBlockCacheSize, "strile array pages");
+    std::vector<void *> apData;
+    void *pBufferedData = ReadMultiRangePlan(
+        VSI_TIFFGetVSILFile(TIFFClientdata(m_hTIFF)), sPlan, apData);
+    if (!pBufferedData)
+        return false;
+
+    const bool bSwab = CPL_TO_BOOL(TIFFIsByteSwapped(m_hTIFF));
+    const auto DecodeValues = [&sPlan, &apData, bSwab](
+                                  const std::pair<vsi_l_offset, size_t> &oRange,
+                                  int nValueSize, std::vector<uint64_t> &anVals)
+    {
+        // Find the request that contains the range
+        const auto oIter =
+            std::upper_bound(sPlan.anOffsets.begin(), sPlan.anOffsets.end(),
+                             oRange.first);
+        CPLAssert(oIter != sPlan.anOffsets.begin());
+        const size_t iReq = (oIter - sPlan.anOffsets.begin()) - 1;
+        const GByte *pabySrc = static_cast<const GByte *>(apData[iReq]) +
+                               (oRange.first - sPlan.anOffsets[iReq]);
+        const size_t nValues = oRange.second / nValueSize;
+        anVals.resize(nValues);
+        for (size_t i = 0; i < nValues; ++i)
+        {
+            const GByte *pabyVal = pabySrc + i * nValueSize;
+            if (nValueSize == 2)
+            {
+                uint16_t nVal;
+                memcpy(&nVal, pabyVal, sizeof(nVal));
+                if (bSwab)
+                    CPL_SWAP16PTR(&nVal);
+                anVals[i] = nVal;
+            }
+            else if (nValueSize == 4)
+            {
+                uint32_t nVal;
+                memcpy(&nVal, pabyVal, sizeof(nVal));
+                if (bSwab)
+                    CPL_SWAP32PTR(&nVal);
+                anVals[i] = nVal;
+            }
+            else
+            {
+                uint64_t nVal;
+                memcpy(&nVal, pabyVal, sizeof(nVal));
+                if (bSwab)
+                    CPL_SWAP64PTR(&nVal);
+                anVals[i] = nVal;
+            }
+        }
+    };
+
+    for (size_t i = 0; i < anPagesToLoad.size(); ++i)
+    {
+        auto poPage = std::make_shared<StrileArrayPage>();
+        DecodeValues(aOffsetSizeUnsorted[2 * i],
+                     m_sStrileOffsetsLocation.nValueSize, poPage->anOffsets);
+        DecodeValues(aOffsetSizeUnsorted[2 * i + 1],
+                     m_sStrileByteCountsLocation.nValueSize,
+                     poPage->anByteCounts);
+        m_poStrileArrayPageCache->insert(anPagesToLoad[i], poPage);
+    }
+    VSIFree(pBufferedData);
+    return true;
+}
+
+/************************************************************************/
+/*                    GetStrileOffsetAndByteCount()                     */
+/************************************************************************/
+
+// Returns false if the paged cache of strile arrays is not used, in which
+// case the values must be asked to libtiff.
+bool GTiffDataset::GetStrileOffsetAndByteCount(int nBlockId,
+                                               vsi_l_offset &nOffset,
+                                               vsi_l_offset &nByteCount)
+{
+    if (!UsePagedStrileArrayCache() || nBlockId < 0 ||
+        static_cast<uint64_t>(nBlockId) >= m_sStrileOffsetsLocation.nCount)
+    {
+        return false;
+    }
+    const uint64_t nPage =
+        static_cast<uint64_t>(nBlockId) / STRILE_ARRAY_PAGE_SIZE;
+    std::shared_ptr<StrileArrayPage> poPage;
+    if (!m_poStrileArrayPageCache->tryGet(nPage, poPage))
+    {
+        if (!LoadStrileArrayPages({nPage}) ||
+            !m_poStrileArrayPageCache->tryGet(nPage, poPage))
+        {
+            return false;
+        }
+    }
+    const size_t iVal = static_cast<size_t>(nBlockId % STRILE_ARRAY_PAGE_SIZE);
+    nOffset = poPage->anOffsets[iVal];
+    nByteCount = poPage->anByteCounts[iVal];
+    return true;
+}
+
+/************************************************************************/
+/*                          GetStrileOffset()                           */
+/************************************************************************/
+
+vsi_l_offset GTiffDataset::GetStrileOffset(int nBlockId)
+{
+    vsi_l_offset nOffset = 0;
+    vsi_l_offset nByteCount = 0;
+    if (GetStrileOffsetAndByteCount(nBlockId, nOffset, nByteCount))
+        return nOffset;
+    return TIFFGetStrileOffset(m_hTIFF, nBlockId);
+}
+
+/************************************************************************/
+/*                         GetStrileByteCount()                         */
+/************************************************************************/
+
+vsi_l_offset GTiffDataset::GetStrileByteCount(int nBlockId)
+{
+    vsi_l_offset nOffset = 0;
+    vsi_l_offset nByteCount = 0;
+    if (GetStrileOffsetAndByteCount(nBlockId, nOffset, nByteCount))
+        return nByteCount;
+    return TIFFGetStrileByteCount(m_hTIFF, nBlockId);
+}
@@ -46,6 +46,7 @@
 #include "cpl_error.h"
 #include "cpl_error_internal.h"  // CPLErrorHandlerAccumulatorStruct
 #include "cpl_md5.h"
+#include "cpl_trace.h"
 #include "cpl_vsi.h"
 #include "cpl_vsi_virtual.h"
 #include "cpl_worker_thread_pool.h"
@@ -298,6 +299,17 @@ CPLErr GTiffDataset::FillEmptyTiles()
         }
     }
 
+    // Whichever way the blank blocks are written below, their statistics
+    // are the ones of the blank buffer.
+    if (!m_adfBlockStatistics.empty())
+    {
+        for (int iBlock = 0; iBlock < nBlockCount; ++iBlock)
+        {
+            if (panByteCounts[iBlock] == 0)
+                UpdateBlockStatistics(iBlock, pabyData);
+        }
+    }
+
     /* -------------------------------------------------------------------- */
     /*      When we must fill with zeroes, try to create non-sparse file    */
     /*      w.r.t TIFF spec ... as a sparse file w.r.t filesystem, ie by    */
@@ -539,6 +551,9 @@ inline bool GTiffDataset::IsFirstPixelEqualToNoData(const void *pBuffer)
 bool GTiffDataset::WriteEncodedTile(uint32_t tile, GByte *pabyData,
                                     int bPreserveDataBuffer)
 {
+    CPLTraceSpan oSpan("gtiff", "GTiffDataset::WriteEncodedTile");
+    oSpan.AddArg("tile", static_cast<GIntBig>(tile));
+
     int iRow = 0;
     int iColumn = 0;
 
@@ -567,6 +582,7 @@ bool GTiffDataset::WriteEncodedTile(uint32_t tile, GByte *pabyData,
             if (HasOnlyNoData(pabyData, nActualBlockWidth, nActualBlockHeight,
                               m_nBlockXSize, nComponents))
             {
+                UpdateBlockStatistics(tile, pabyData);
                 return true;
             }
         }
@@ -664,26 +680,10 @@ bool GTiffDataset::WriteEncodedTile(uint32_t tile, GByte *pabyData,
         DiscardLsb(pabyData, cc, iBand);
     }
 
+    UpdateBlockStatistics(tile, pabyData);
+
     if (m_bStreamingOut)
-    {
-        if (tile != static_cast<uint32_t>(m_nLastWrittenBlockId + 1))
-        {
-            ReportError(CE_Failure, CPLE_NotSupported,
-                        "Attempt to write block %d whereas %d was expected",
-                        tile, m_nLastWrittenBlockId + 1);
-            return false;
-        }
-        if (static_cast<GPtrDiff_t>(VSIFWriteL(pabyData, 1, cc, m_fpToWrite)) !=
-            cc)
-        {
-            ReportError(CE_Failure, CPLE_FileIO,
-                        "Could not write " CPL_FRMT_GUIB " bytes",
-                        static_cast<GUIntBig>(cc));
-            return false;
-        }
-        m_nLastWrittenBlockId = tile;
-        return true;
-    }
+        return WriteStreamingStripOrTile(tile, pabyData, cc, m_nBlockYSize);
 
     /* -------------------------------------------------------------------- */
     /*      Should we do compression in a worker thread ?                   */
@@ -701,6 +701,9 @@ bool GTiffDataset::WriteEncodedTile(uint32_t tile, GByte *pabyData,
 bool GTiffDataset::WriteEncodedStrip(uint32_t strip, GByte *pabyData,
                                      int bPreserveDataBuffer)
 {
+    CPLTraceSpan oSpan("gtiff", "GTiffDataset::WriteEncodedStrip");
+    oSpan.AddArg("strip", static_cast<GIntBig>(strip));
+
     GPtrDiff_t cc = static_cast<GPtrDiff_t>(TIFFStripSize(m_hTIFF));
     const auto ccFull = cc;
 
@@ -736,6 +739,7 @@ bool GTiffDataset::WriteEncodedStrip(uint32_t strip, GByte *pabyData,
             if (HasOnlyNoData(pabyData, m_nBlockXSize, nStripHeight,
                               m_nBlockXSize, nComponents))
             {
+                UpdateBlockStatistics(strip, pabyData);
                 return true;
             }
         }
@@ -765,34 +769,521 @@ bool GTiffDataset::WriteEncodedStrip(uint32_t strip, GByte *pabyData,
         DiscardLsb(pabyData, cc, iBand);
     }
 
+    UpdateBlockStatistics(strip, pabyData);
+
     if (m_bStreamingOut)
+        return WriteStreamingStripOrTile(strip, pabyData, cc, nStripHeight);
+
+    /* -------------------------------------------------------------------- */
+    /*      Should we do compression in a worker thread ?                   */
+    /* -------------------------------------------------------------------- */
+    if (SubmitCompressionJob(strip, pabyData, cc, nStripHeight))
+        return true;
+
+    return TIFFWriteEncodedStrip(m_hTIFF, strip, pabyData, cc) == cc;
+}
+
+/************************************************************************/
+/*                        InitBlockStatistics()                         */
+/************************************************************************/
+
+void GTiffDataset::InitBlockStatistics(CSLConstList papszOptions)
+{
+    if (!CPLFetchBool(papszOptions, "BLOCK_STATISTICS", false))
+        return;
+
+    const GDALDataType eDT = GetRasterBand(1)->GetRasterDataType();
+    const char *pszUnsupported = nullptr;
+    if (GDALDataTypeIsComplex(eDT) ||
+        static_cast<int>(m_nBitsPerSample) != GDALGetDataTypeSizeBits(eDT))
     {
-        if (strip != static_cast<uint32_t>(m_nLastWrittenBlockId + 1))
+        pszUnsupported = "this data type";
+    }
+    else if (m_bStreamingOut)
+    {
+        pszUnsupported = "streaming";
+    }
+    else if (m_nCompression == COMPRESSION_JPEG ||
+             (m_nCompression == COMPRESSION_WEBP && !m_bWebPLossless) ||
+             (m_nCompression == COMPRESSION_LERC && m_dfMaxZError > 0)
+#if HAVE_JXL
+             || (m_nCompression == COMPRESSION_JXL && !m_bJXLLossless)
+#endif
+    )
+    {
+        // Statistics would be the ones of the data before compression.
+        pszUnsupported = "lossy compression";
+    }
+    else if (static_cast<uint64_t>(nBands) * m_nBlocksPerBand >
+             std::numeric_limits<uint32_t>::max() /
+                 BLOCK_STATS_VALUES_PER_BLOCK / 2)
+    {
+        pszUnsupported = "that many blocks";
+    }
+    if (pszUnsupported)
+    {
+        ReportError(CE_Warning, CPLE_NotSupported,
+                    "BLOCK_STATISTICS=YES not supported with %s. Ignored",
+                    pszUnsupported);
+        return;
+    }
+
+    try
+    {
+        m_adfBlockStatistics.assign(
+            GetBlockStatisticsIndex(nBands, 0), 0.0);
+    }
+    catch (const std::exception &)
+    {
+        ReportError(CE_Failure, CPLE_OutOfMemory,
+                    "Cannot allocate block statistics");
+        return;
+    }
+    m_adfBlockStatistics[0] = BLOCK_STATS_VERSION;
+    for (int iBand = 0; iBand < nBands; ++iBand)
+    {
+        for (int iBlock = 0; iBlock < m_nBlocksPerBand; ++iBlock)
+            m_adfBlockStatistics[GetBlockStatisticsIndex(iBand, iBlock)] = -1;
+    }
+    m_bBlockStatisticsDirty = true;
+}
+
+/************************************************************************/
+/*                      GetBlockStatisticsIndex()                       */
+/************************************************************************/
+
+size_t GTiffDataset::GetBlockStatisticsIndex(int iBand, int nBlockInBand) const
+{
+    return 1 + static_cast<size_t>(nBands) * BLOCK_STATS_VALUES_PER_BAND +
+           (static_cast<size_t>(iBand) * m_nBlocksPerBand + nBlockInBand) *
+               BLOCK_STATS_VALUES_PER_BLOCK;
+}
+
+/************************************************************************/
+/*                       ComputeBlockStatistics()                       */
+/************************************************************************/
+
+// Compute the statistics of one band of a block, excluding nodata and NaN
+// values the same way as GDALRasterBand::ComputeStatistics() does. The
+// mean and the sum of squared differences to the mean are computed with
+// Welford algorithm.
+template <class T>
+static void ComputeBlockStatistics(const T *panData, int nWidth, int nHeight,
+                                   size_t nLineStride, int nPixelStride,
+                                   bool bHasNoData, double dfNoData,
+                                   double *padfStats)
+{
+    bool bHasFloatNoData = false;
+    float fNoData = 0;
+    if (std::is_same<T, float>::value && bHasNoData)
+    {
+        dfNoData = GDALAdjustNoDataCloseToFloatMax(dfNoData);
+        if (GDALIsValueInRange<float>(dfNoData))
         {
-            ReportError(CE_Failure, CPLE_NotSupported,
-                        "Attempt to write block %d whereas %d was expected",
-                        strip, m_nLastWrittenBlockId + 1);
-            return false;
+            fNoData = static_cast<float>(dfNoData);
+            bHasFloatNoData = true;
+            bHasNoData = false;
         }
-        if (static_cast<GPtrDiff_t>(VSIFWriteL(pabyData, 1, cc, m_fpToWrite)) !=
-            cc)
+    }
+
+    double dfCount = 0;
+    double dfMin = std::numeric_limits<double>::infinity();
+    double dfMax = -std::numeric_limits<double>::infinity();
+    double dfMean = 0;
+    double dfM2 = 0;
+    for (int iY = 0; iY < nHeight; ++iY)
+    {
+        const T *panLine = panData + iY * nLineStride;
+        for (int iX = 0; iX < nWidth; ++iX)
+        {
+            const T nValue = panLine[static_cast<size_t>(iX) * nPixelStride];
+            if (std::numeric_limits<T>::has_quiet_NaN)
+            {
+                if (CPLIsNan(static_cast<double>(nValue)) ||
+                    (bHasFloatNoData &&
+                     ARE_REAL_EQUAL(static_cast<float>(nValue), fNoData)))
+                {
+                    continue;
+                }
+            }
+            const double dfValue = static_cast<double>(nValue);
+            if (bHasNoData && ARE_REAL_EQUAL(dfValue, dfNoData))
+                continue;
+            dfCount += 1;
+            const double dfDelta = dfValue - dfMean;
+            dfMean += dfDelta / dfCount;
+            dfM2 += dfDelta * (dfValue - dfMean);
+            dfMin = std::min(dfMin, dfValue);
+            dfMax = std::max(dfMax, dfValue);
+        }
+    }
+
+    padfStats[0] = dfCount;
+    padfStats[1] = dfCount > 0 ? dfMin : 0;
+    padfStats[2] = dfCount > 0 ? dfMax : 0;
+    padfStats[3] = dfMean;
+    padfStats[4] = dfM2;
+}
+
+/************************************************************************/
+/*                       UpdateBlockStatistics()                        */
+/************************************************************************/
+
+// Must be called with the content of a strile before it is encoded.
+void GTiffDataset::UpdateBlockStatistics(int nStripOrTile,
+                                         const GByte *pabyData)
+{
+    if (m_adfBlockStatistics.empty())
+        return;
+
+    const int nBlockInBand = nStripOrTile % m_nBlocksPerBand;
+    const int nXBlock = nBlockInBand % m_nBlocksPerRow;
+    const int nYBlock = nBlockInBand / m_nBlocksPerRow;
+    const int nWidth =
+        std::min(m_nBlockXSize, nRasterXSize - nXBlock * m_nBlockXSize);
+    const int nHeight =
+        std::min(m_nBlockYSize, nRasterYSize - nYBlock * m_nBlockYSize);
+    const bool bSeparate = m_nPlanarConfig == PLANARCONFIG_SEPARATE;
+    const int nComponents = bSeparate ? 1 : nBands;
+    const size_t nLineStride = static_cast<size_t>(m_nBlockXSize) * nComponents;
+    const int iFirstBand = bSeparate ? nStripOrTile / m_nBlocksPerBand : 0;
+    const int iLastBand = bSeparate ? iFirstBand : nBands - 1;
+    const GDALDataType eDT = GetRasterBand(1)->GetRasterDataType();
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+
+    for (int iBand = iFirstBand; iBand <= iLastBand; ++iBand)
+    {
+        int bHasNoData = FALSE;
+        const double dfNoData =
+            GetRasterBand(iBand + 1)->GetNoDataValue(&bHasNoData);
+        const bool bUseNoData = bHasNoData && !CPLIsNan(dfNoData);
+
+        // If the nodata value has changed, the statistics of the blocks
+        // written before are no longer valid.
+        double *padfBandHeader =
+            m_adfBlockStatistics.data() + 1 +
+            static_cast<size_t>(iBand) * BLOCK_STATS_VALUES_PER_BAND;
+        if ((padfBandHeader[0] != 0) != bUseNoData ||
+            (bUseNoData && padfBandHeader[1] != dfNoData))
+        {
+            padfBandHeader[0] = bUseNoData ? 1 : 0;
+            padfBandHeader[1] = bUseNoData ? dfNoData : 0;
+            for (int iBlock = 0; iBlock < m_nBlocksPerBand; ++iBlock)
+            {
+                m_adfBlockStatistics[GetBlockStatisticsIndex(iBand, iBlock)] =
+                    -1;
+            }
+        }
+
+        const GByte *pabyBandData =
+            pabyData + (bSeparate ? 0 : static_cast<size_t>(iBand) * nDTSize);
+        double *padfStats = m_adfBlockStatistics.data() +
+                            GetBlockStatisticsIndex(iBand, nBlockInBand);
+        switch (eDT)
+        {
+#define COMPUTE_BLOCK_STATS(eType, CType)                                      \
+    case eType:                                                                \
+        ComputeBlockStatistics(reinterpret_cast<const CType *>(pabyBandData),  \
+                               nWidth, nHeight, nLineStride, nComponents,      \
+                               bUseNoData, dfNoData, padfStats);               \
+        break
+            COMPUTE_BLOCK_STATS(GDT_Byte, GByte);
+            COMPUTE_BLOCK_STATS(GDT_Int8, GInt8);
+            COMPUTE_BLOCK_STATS(GDT_UInt16, GUInt16);
+            COMPUTE_BLOCK_STATS(GDT_Int16, GInt16);
+            COMPUTE_BLOCK_STATS(GDT_UInt32, GUInt32);
+            COMPUTE_BLOCK_STATS(GDT_Int32, GInt32);
+            COMPUTE_BLOCK_STATS(GDT_UInt64, uint64_t);
+            COMPUTE_BLOCK_STATS(GDT_Int64, int64_t);
+            COMPUTE_BLOCK_STATS(GDT_Float32, float);
+            COMPUTE_BLOCK_STATS(GDT_Float64, double);
+#undef COMPUTE_BLOCK_STATS
+            default:
+                padfStats[0] = -1;
+                break;
+        }
+    }
+    m_bBlockStatisticsDirty = true;
+}
+
+/************************************************************************/
+/*                       SetBlockStatisticsTag()                        */
+/************************************************************************/
+
+// Only to be called before the directory is (re)written, as setting the tag
+// marks the directory as dirty.
+void GTiffDataset::SetBlockStatisticsTag()
+{
+    if (m_adfBlockStatistics.empty())
+        return;
+    TIFFSetField(m_hTIFF, TIFFTAG_GDAL_BLOCK_STATISTICS,
+                 static_cast<uint32_t>(m_adfBlockStatistics.size()),
+                 m_adfBlockStatistics.data());
+}
+
+/************************************************************************/
+/*                       WriteBlockStatistics()                         */
+/************************************************************************/
+
+// Overwrite the value of TIFFTAG_GDAL_BLOCK_STATISTICS in place, so that
+// updating statistics does not move the IFD at the end of the file.
+bool GTiffDataset::WriteBlockStatistics()
+{
+    m_bBlockStatisticsDirty = false;
+
+    thandle_t th = TIFFClientdata(m_hTIFF);
+    VSI_TIFFFlushBufferedWrite(th);
+    VSILFILE *fp = VSI_TIFFGetVSILFile(th);
+    const bool bBigTIFF = CPL_TO_BOOL(TIFFIsBigTIFF(m_hTIFF));
+    const bool bSwap = CPL_TO_BOOL(TIFFIsByteSwapped(m_hTIFF));
+    const vsi_l_offset nCurOffset = VSIFTellL(fp);
+
+    const auto ReadUInt = [bSwap](const GByte *pabyVal, int nSize)
+    {
+        uint64_t nVal = 0;
+        if (nSize == 2)
+        {
+            uint16_t nVal16;
+            memcpy(&nVal16, pabyVal, sizeof(nVal16));
+            if (bSwap)
+                CPL_SWAP16PTR(&nVal16);
+            nVal = nVal16;
+        }
+        else if (nSize == 4)
+        {
+            uint32_t nVal32;
+            memcpy(&nVal32, pabyVal, sizeof(nVal32));
+            if (bSwap)
+                CPL_SWAP32PTR(&nVal32);
+            nVal = nVal32;
+        }
+        else
+        {
+            memcpy(&nVal, pabyVal, sizeof(nVal));
+            if (bSwap)
+                CPL_SWAP64PTR(&nVal);
+        }
+        return nVal;
+    };
+
+    // Locate the tag in the IFD
+    const int nCountSize = bBigTIFF ? 8 : 2;
+    const int nValueSize = bBigTIFF ? 8 : 4;
+    const int nEntrySize = 4 + 2 * nValueSize;
+    GByte abyCount[8] = {0};
+    vsi_l_offset nValueOffset = 0;
+    if (VSIFSeekL(fp, m_nDirOffset, SEEK_SET) == 0 &&
+        VSIFReadL(abyCount, nCountSize, 1, fp) == 1)
+    {
+        const uint64_t nEntries = ReadUInt(abyCount, nCountSize);
+        std::vector<GByte> abyEntries;
+        if (nEntries <= 65535)
+        {
+            abyEntries.resize(static_cast<size_t>(nEntries) * nEntrySize);
+            if (VSIFReadL(abyEntries.data(), abyEntries.size(), 1, fp) != 1)
+                abyEntries.clear();
+        }
+        for (size_t i = 0; i < abyEntries.size(); i += nEntrySize)
+        {
+            const GByte *pabyEntry = abyEntries.data() + i;
+            if (ReadUInt(pabyEntry, 2) == TIFFTAG_GDAL_BLOCK_STATISTICS &&
+                ReadUInt(pabyEntry + 2, 2) == TIFF_DOUBLE &&
+                ReadUInt(pabyEntry + 4, nValueSize) ==
+                    m_adfBlockStatistics.size())
+            {
+                nValueOffset = ReadUInt(pabyEntry + 4 + nValueSize, nValueSize);
+                break;
+            }
+        }
+    }
+
+    bool bRet = false;
+    if (nValueOffset != 0)
+    {
+        std::vector<double> adfValues(m_adfBlockStatistics);
+        if (bSwap)
+        {
+            for (double &dfVal : adfValues)
+                CPL_SWAP64PTR(&dfVal);
+        }
+        bRet = VSIFSeekL(fp, nValueOffset, SEEK_SET) == 0 &&
+               VSIFWriteL(adfValues.data(), adfValues.size() * sizeof(double),
+                          1, fp) == 1;
+    }
+    VSIFSeekL(fp, nCurOffset, SEEK_SET);
+
+    if (!bRet)
+    {
+        ReportError(CE_Failure, CPLE_FileIO,
+                    "Cannot update TIFFTAG_GDAL_BLOCK_STATISTICS");
+    }
+    return bRet;
+}
+
+/************************************************************************/
+/*                     WriteStreamingStripOrTile()                      */
+/************************************************************************/
+
+bool GTiffDataset::WriteStreamingStripOrTile(uint32_t nStripOrTile,
+                                             GByte *pabyData, GPtrDiff_t cc,
+                                             int nHeight)
+{
+    if (nStripOrTile != static_cast<uint32_t>(m_nLastWrittenBlockId + 1))
+    {
+        ReportError(CE_Failure, CPLE_NotSupported,
+                    "Attempt to write block %d whereas %d was expected",
+                    nStripOrTile, m_nLastWrittenBlockId + 1);
+        return false;
+    }
+
+    if (m_nCompression == COMPRESSION_NONE)
+    {
+        if (static_cast<GPtrDiff_t>(VSIFWriteL(pabyData, 1, cc,
+                                               m_fpToWrite)) != cc)
         {
             ReportError(CE_Failure, CPLE_FileIO,
                         "Could not write " CPL_FRMT_GUIB " bytes",
                         static_cast<GUIntBig>(cc));
             return false;
         }
-        m_nLastWrittenBlockId = strip;
+        m_nLastWrittenBlockId = nStripOrTile;
         return true;
     }
 
-    /* -------------------------------------------------------------------- */
-    /*      Should we do compression in a worker thread ?                   */
-    /* -------------------------------------------------------------------- */
-    if (SubmitCompressionJob(strip, pabyData, cc, nStripHeight))
-        return true;
+    // Compressed streaming is done in two passes by CreateCopy(). The
+    // measuring pass only records the compressed size of each strile. The
+    // second one compresses the same data again and sends it to the output.
+    GTiffCompressionJob sJob;
+    memset(&sJob, 0, sizeof(sJob));
+    SetupCompressionJob(sJob, nStripOrTile, pabyData, cc, nHeight);
+    sJob.pszTmpFilename = CPLStrdup(CPLSPrintf("/vsimem/gtiff/%p", this));
 
-    return TIFFWriteEncodedStrip(m_hTIFF, strip, pabyData, cc) == cc;
+    ThreadCompressionFunc(&sJob);
+
+    const toff_t nSize = static_cast<toff_t>(sJob.nCompressedBufferSize);
+    bool bOK = nSize > 0;
+    if (bOK && m_bStreamingMeasurePass)
+    {
+        m_anStreamingByteCounts.push_back(nSize);
+    }
+    else if (bOK && m_anStreamingByteCounts[nStripOrTile] != nSize)
+    {
+        ReportError(CE_Failure, CPLE_AppDefined,
+                    "Block %d compressed to " CPL_FRMT_GUIB
+                    " bytes, whereas it was " CPL_FRMT_GUIB
+                    " bytes during the measuring pass. "
+                    "The source dataset must return the same "
+                    "values when read twice.",
+                    nStripOrTile, static_cast<GUIntBig>(nSize),
+                    static_cast<GUIntBig>(
+                        m_anStreamingByteCounts[nStripOrTile]));
+        bOK = false;
+    }
+    else if (bOK && VSIFWriteL(sJob.pabyCompressedBuffer, 1,
+                               static_cast<size_t>(nSize),
+                               m_fpToWrite) != nSize)
+    {
+        ReportError(CE_Failure, CPLE_FileIO,
+                    "Could not write " CPL_FRMT_GUIB " bytes",
+                    static_cast<GUIntBig>(nSize));
+        bOK = false;
+    }
+
+    CPLFree(sJob.pabyBuffer);
+    VSIUnlink(sJob.pszTmpFilename);
+    CPLFree(sJob.pszTmpFilename);
+
+    if (bOK)
+        m_nLastWrittenBlockId = nStripOrTile;
+    return bOK;
+}
+
+/************************************************************************/
+/*                        WriteStreamingHeader()                        */
+/************************************************************************/
+
+// Called between the two passes of a compressed streamed CreateCopy(). Set
+// the final offsets and byte counts of striles in the directory, and send
+// the header and the directory to the output.
+bool GTiffDataset::WriteStreamingHeader()
+{
+    const bool bIsTiled = CPL_TO_BOOL(TIFFIsTiled(m_hTIFF));
+    const int nBlockCount =
+        bIsTiled ? TIFFNumberOfTiles(m_hTIFF) : TIFFNumberOfStrips(m_hTIFF);
+    if (static_cast<int>(m_anStreamingByteCounts.size()) != nBlockCount)
+    {
+        ReportError(CE_Failure, CPLE_AppDefined,
+                    "Only %d blocks out of %d were written during the "
+                    "measuring pass",
+                    static_cast<int>(m_anStreamingByteCounts.size()),
+                    nBlockCount);
+        return false;
+    }
+
+    toff_t *panOffset = nullptr;
+    toff_t *panSize = nullptr;
+    if (!TIFFGetField(m_hTIFF,
+                      bIsTiled ? TIFFTAG_TILEOFFSETS : TIFFTAG_STRIPOFFSETS,
+                      &panOffset) ||
+        !TIFFGetField(m_hTIFF,
+                      bIsTiled ? TIFFTAG_TILEBYTECOUNTS
+                               : TIFFTAG_STRIPBYTECOUNTS,
+                      &panSize))
+    {
+        return false;
+    }
+
+    // GTiffFillStreamableOffsetAndCount() has set the first strile right
+    // after the directory.
+    const toff_t nHeaderSize = panOffset[0];
+    toff_t nOffset = nHeaderSize;
+    for (int i = 0; i < nBlockCount; ++i)
+    {
+        panOffset[i] = nOffset;
+        panSize[i] = m_anStreamingByteCounts[i];
+        nOffset += m_anStreamingByteCounts[i];
+    }
+    if (!TIFFIsBigTIFF(m_hTIFF) && nOffset > 0xFFFFFFFFU)
+    {
+        ReportError(CE_Failure, CPLE_AppDefined,
+                    "Compressed imagery is larger than 4 GB. "
+                    "Use BIGTIFF=YES creation option");
+        return false;
+    }
+
+    // The directory is rewritten in place, since the size of the values of
+    // the offset and byte count tags does not depend on their value.
+    TIFFWriteDirectory(m_hTIFF);
+    VSI_TIFFFlushBufferedWrite(TIFFClientdata(m_hTIFF));
+    if (VSIFSeekL(m_fpL, 0, SEEK_END) != 0 || VSIFTellL(m_fpL) != nHeaderSize)
+    {
+        ReportError(CE_Failure, CPLE_AppDefined,
+                    "Directory of the streamed file could not be rewritten "
+                    "in place");
+        return false;
+    }
+
+    std::vector<GByte> abyHeader(static_cast<size_t>(nHeaderSize));
+    if (VSIFSeekL(m_fpL, 0, SEEK_SET) != 0 ||
+        VSIFReadL(abyHeader.data(), 1, abyHeader.size(), m_fpL) !=
+            abyHeader.size() ||
+        VSIFWriteL(abyHeader.data(), 1, abyHeader.size(), m_fpToWrite) !=
+            abyHeader.size())
+    {
+        ReportError(CE_Failure, CPLE_FileIO, "Could not write %d bytes",
+                    static_cast<int>(abyHeader.size()));
+        return false;
+    }
+
+    // In case of single strip file, there's a libtiff check that would
+    // issue a warning since the file hasn't the required size.
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    TIFFSetDirectory(m_hTIFF, 0);
+    CPLPopErrorHandler();
+    RestoreVolatileParameters(m_hTIFF);
+
+    m_nLastWrittenBlockId = -1;
+    return true;
 }
 
 /************************************************************************/
@@ -848,6 +1339,15 @@ void GTiffDataset::InitCompressionThreads(bool bUpdateMode,
                     m_hCompressThreadPoolMutex = CPLCreateMutex();
                     CPLReleaseMutex(m_hCompressThreadPoolMutex);
 
+                    // Shared by all datasets, so that many datasets written
+                    // concurrently do not accumulate pending jobs without
+                    // bound.
+                    const char *pszMaxBytes = CPLGetConfigOption(
+                        "GTIFF_COMPRESSION_QUEUE_MAX_BYTES", nullptr);
+                    m_nCompressionQueueMaxBytes =
+                        pszMaxBytes ? CPLAtoGIntBig(pszMaxBytes)
+                                    : GDALGetCacheMax64();
+
                     // This is kind of a hack, but basically using
                     // TIFFWriteRawStrip/Tile and then TIFFReadEncodedStrip/Tile
                     // does not work on a newly created file, because
@@ -870,6 +1370,8 @@ void GTiffDataset::InitCompressionThreads(bool bUpdateMode,
     }
 }
 
+std::atomic<GIntBig> GTiffDataset::gnPendingCompressionBytes{0};
+
 /************************************************************************/
 /*                      ThreadCompressionFunc()                         */
 /************************************************************************/
@@ -879,6 +1381,9 @@ void GTiffDataset::ThreadCompressionFunc(void *pData)
     GTiffCompressionJob *psJob = static_cast<GTiffCompressionJob *>(pData);
     GTiffDataset *poDS = psJob->poDS;
 
+    CPLTraceSpan oSpan("gtiff", "GTiffDataset::ThreadCompressionFunc");
+    oSpan.AddArg("strile", static_cast<GIntBig>(psJob->nStripOrTile));
+
     VSILFILE *fpTmp = VSIFOpenL(psJob->pszTmpFilename, "wb+");
     TIFF *hTIFFTmp = VSI_TIFFOpen(
         psJob->pszTmpFilename, psJob->bTIFFIsBigEndian ? "wb+" : "wl+", fpTmp);
@@ -1166,6 +1671,9 @@ void GTiffDataset::WaitCompletionForJobIdx(int i)
                                             asJobs[i].pabyCompressedBuffer,
                                             asJobs[i].nCompressedBufferSize);
     }
+    gnPendingCompressionBytes -= asJobs[i].nBufferSize;
+    (m_poBaseDS ? m_poBaseDS : this)
+        ->AccountMemory("GTiff.compression_queue", -asJobs[i].nBufferSize);
     asJobs[i].pabyCompressedBuffer = nullptr;
     asJobs[i].nBufferSize = 0;
     asJobs[i].bReady = false;
@@ -1208,6 +1716,33 @@ void GTiffDataset::WaitCompletionForBlock(int nBlockId)
     }
 }
 
+/************************************************************************/
+/*                       SetupCompressionJob()                          */
+/************************************************************************/
+
+void GTiffDataset::SetupCompressionJob(GTiffCompressionJob &sJob,
+                                       int nStripOrTile, GByte *pabyData,
+                                       GPtrDiff_t cc, int nHeight)
+{
+    sJob.poDS = this;
+    sJob.bTIFFIsBigEndian = CPL_TO_BOOL(TIFFIsBigEndian(m_hTIFF));
+    sJob.pabyBuffer = static_cast<GByte *>(CPLRealloc(sJob.pabyBuffer, cc));
+    memcpy(sJob.pabyBuffer, pabyData, cc);
+    sJob.nBufferSize = cc;
+    sJob.nHeight = nHeight;
+    sJob.nStripOrTile = nStripOrTile;
+    sJob.nPredictor = PREDICTOR_NONE;
+    if (GTIFFSupportsPredictor(m_nCompression))
+    {
+        TIFFGetField(m_hTIFF, TIFFTAG_PREDICTOR, &sJob.nPredictor);
+    }
+
+    sJob.pExtraSamples = nullptr;
+    sJob.nExtraSampleCount = 0;
+    TIFFGetField(m_hTIFF, TIFFTAG_EXTRASAMPLES, &sJob.nExtraSampleCount,
+                 &sJob.pExtraSamples);
+}
+
 /************************************************************************/
 /*                      SubmitCompressionJob()                          */
 /************************************************************************/
@@ -1238,28 +1773,6 @@ bool GTiffDataset::SubmitCompressionJob(int nStripOrTile, GByte *pabyData,
         }
     }
 
-    const auto SetupJob =
-        [this, pabyData, cc, nHeight, nStripOrTile](GTiffCompressionJob &sJob)
-    {
-        sJob.poDS = this;
-        sJob.bTIFFIsBigEndian = CPL_TO_BOOL(TIFFIsBigEndian(m_hTIFF));
-        sJob.pabyBuffer = static_cast<GByte *>(CPLRealloc(sJob.pabyBuffer, cc));
-        memcpy(sJob.pabyBuffer, pabyData, cc);
-        sJob.nBufferSize = cc;
-        sJob.nHeight = nHeight;
-        sJob.nStripOrTile = nStripOrTile;
-        sJob.nPredictor = PREDICTOR_NONE;
-        if (GTIFFSupportsPredictor(m_nCompression))
-        {
-            TIFFGetField(m_hTIFF, TIFFTAG_PREDICTOR, &sJob.nPredictor);
-        }
-
-        sJob.pExtraSamples = nullptr;
-        sJob.nExtraSampleCount = 0;
-        TIFFGetField(m_hTIFF, TIFFTAG_EXTRASAMPLES, &sJob.nExtraSampleCount,
-                     &sJob.pExtraSamples);
-    };
-
     if (poQueue == nullptr || !(m_nCompression == COMPRESSION_ADOBE_DEFLATE ||
                                 m_nCompression == COMPRESSION_LZW ||
                                 m_nCompression == COMPRESSION_PACKBITS ||
@@ -1275,7 +1788,7 @@ bool GTiffDataset::SubmitCompressionJob(int nStripOrTile, GByte *pabyData,
         {
             GTiffCompressionJob sJob;
             memset(&sJob, 0, sizeof(sJob));
-            SetupJob(sJob);
+            SetupCompressionJob(sJob, nStripOrTile, pabyData, cc, nHeight);
             sJob.pszTmpFilename =
                 CPLStrdup(CPLSPrintf("/vsimem/gtiff/%p", this));
 
@@ -1301,6 +1814,27 @@ bool GTiffDataset::SubmitCompressionJob(int nStripOrTile, GByte *pabyData,
     auto &asJobs =
         m_poBaseDS ? m_poBaseDS->m_asCompressionJobs : m_asCompressionJobs;
 
+    // Back-pressure: if the jobs pending for all datasets exceed the budget,
+    // write the results of our own oldest jobs first. We never wait for
+    // other datasets, so a dataset without pending jobs always progresses.
+    const GIntBig nMaxPendingBytes =
+        (m_poBaseDS ? m_poBaseDS : this)->m_nCompressionQueueMaxBytes;
+    bool bHasWaited = false;
+    while (!oQueue.empty() &&
+           gnPendingCompressionBytes + cc > nMaxPendingBytes)
+    {
+        if (!bHasWaited)
+        {
+            CPLDebug("GTiff",
+                     "Pending compression jobs exceed "
+                     "GTIFF_COMPRESSION_QUEUE_MAX_BYTES=" CPL_FRMT_GIB
+                     ". Waiting for completion of the oldest ones",
+                     nMaxPendingBytes);
+            bHasWaited = true;
+        }
+        WaitCompletionForJobIdx(oQueue.front());
+    }
+
     int nNextCompressionJobAvail = -1;
 
     if (oQueue.size() == asJobs.size())
@@ -1324,9 +1858,14 @@ bool GTiffDataset::SubmitCompressionJob(int nStripOrTile, GByte *pabyData,
     CPLAssert(nNextCompressionJobAvail >= 0);
 
     GTiffCompressionJob *psJob = &asJobs[nNextCompressionJobAvail];
-    SetupJob(*psJob);
+    SetupCompressionJob(*psJob, nStripOrTile, pabyData, cc, nHeight);
+    const GPtrDiff_t nJobBytes = psJob->nBufferSize;
+    gnPendingCompressionBytes += nJobBytes;
     poQueue->SubmitJob(ThreadCompressionFunc, psJob);
     oQueue.push(nNextCompressionJobAvail);
+    // May call TrimMemory(), hence done once the job is queued
+    (m_poBaseDS ? m_poBaseDS : this)
+        ->AccountMemory("GTiff.compression_queue", nJobBytes);
 
     return true;
 }
@@ -1993,6 +2532,7 @@ void GTiffDataset::Crystalize()
         WriteNoDataValue(m_hTIFF, m_nNoDataValueInt64);
     else if (m_bNoDataSetAsUInt64)
         WriteNoDataValue(m_hTIFF, m_nNoDataValueUInt64);
+    SetBlockStatisticsTag();
 
     m_bMetadataChanged = false;
     m_bGeoTIFFInfoChanged = false;
@@ -2062,6 +2602,27 @@ CPLErr GTiffDataset::FlushCache(bool bAtClosing)
     return FlushCacheInternal(bAtClosing, true);
 }
 
+/************************************************************************/
+/*                             TrimMemory()                             */
+/************************************************************************/
+
+// Writes the results of the pending compression jobs, oldest first, to
+// release their buffers.
+GIntBig GTiffDataset::TrimMemory(GIntBig nBytesToRelease)
+{
+    if (m_poBaseDS)
+        return m_poBaseDS->TrimMemory(nBytesToRelease);
+
+    const GIntBig nUsageBefore = GetMemoryUsage("GTiff.compression_queue");
+    while (!m_asQueueJobIdx.empty() &&
+           nUsageBefore - GetMemoryUsage("GTiff.compression_queue") <
+               nBytesToRelease)
+    {
+        WaitCompletionForJobIdx(m_asQueueJobIdx.front());
+    }
+    return nUsageBefore - GetMemoryUsage("GTiff.compression_queue");
+}
+
 CPLErr GTiffDataset::FlushCacheInternal(bool bAtClosing, bool bFlushDirectory)
 {
     if (m_bIsFinalized)
@@ -2218,6 +2779,7 @@ CPLErr GTiffDataset::FlushDirectory()
                 if ((m_nDirOffset % 2) == 1)
                     ++m_nDirOffset;
 
+                SetBlockStatisticsTag();
                 if (TIFFRewriteDirectory(m_hTIFF) == 0)
                     eErr = CE_Failure;
 
@@ -2265,6 +2827,12 @@ CPLErr GTiffDataset::FlushDirectory()
             CPLDebug("GTiff",
                      "directory moved during flush in FlushDirectory()");
         }
+
+        if (m_bBlockStatisticsDirty && m_bCrystalized &&
+            !WriteBlockStatistics())
+        {
+            eErr = CE_Failure;
+        }
     }
 
     SetDirectory();
@@ -4898,7 +5466,7 @@ TIFF *GTiffDataset::CreateLL(const char *pszFilename, int nXSize, int nYSize,
                              int l_nBands, GDALDataType eType,
                              double dfExtraSpaceForOverviews,
                              char **papszParamList, VSILFILE **pfpL,
-                             CPLString &l_osTmpFilename)
+                             CPLString &l_osTmpFilename, bool bCreateCopy)
 
 {
     GTiffOneTimeInit();
@@ -5201,11 +5769,27 @@ TIFF *GTiffDataset::CreateLL(const char *pszFilename, int nXSize, int nYSize,
         }
     }
 #endif
-    if (bStreaming && !EQUAL("NONE", CSLFetchNameValueDef(papszParamList,
-                                                          "COMPRESS", "NONE")))
+    const bool bCopySrcOverviews =
+        CPLFetchBool(papszParamList, "COPY_SRC_OVERVIEWS", false);
+    // File systems such as /vsis3/ can only be written sequentially, unless
+    // a local temporary file is used: stream to them when possible.
+    if (!bStreaming && bCreateCopy && !bCopySrcOverviews &&
+        CSLFetchNameValue(papszParamList, "STREAMABLE_OUTPUT") == nullptr &&
+        !CPLFetchBool(papszParamList, "SPARSE_OK", false) &&
+        !VSISupportsRandomWrite(pszFilename, true) &&
+        VSISupportsSequentialWrite(pszFilename, false))
+    {
+        CPLDebug("GTiff", "%s does not support random writes: streaming it",
+                 pszFilename);
+        bStreaming = true;
+    }
+    if (bStreaming && !bCreateCopy &&
+        !EQUAL("NONE",
+               CSLFetchNameValueDef(papszParamList, "COMPRESS", "NONE")))
     {
         ReportError(pszFilename, CE_Failure, CPLE_NotSupported,
-                    "Streaming only supported to uncompressed TIFF");
+                    "Streaming with Create() only supported to uncompressed "
+                    "TIFF. Use CreateCopy() for compressed streaming");
         return nullptr;
     }
     if (bStreaming && CPLFetchBool(papszParamList, "SPARSE_OK", false))
@@ -5214,8 +5798,6 @@ TIFF *GTiffDataset::CreateLL(const char *pszFilename, int nXSize, int nYSize,
                     "Streaming not supported with SPARSE_OK");
         return nullptr;
     }
-    const bool bCopySrcOverviews =
-        CPLFetchBool(papszParamList, "COPY_SRC_OVERVIEWS", false);
     if (bStreaming && bCopySrcOverviews)
     {
         ReportError(pszFilename, CE_Failure, CPLE_NotSupported,
@@ -6320,6 +6902,7 @@ GDALDataset *GTiffDataset::Create(const char *pszFilename, int nXSize,
     }
 
     poDS->GetDiscardLsbOption(papszParamList);
+    poDS->InitBlockStatistics(papszParamList);
 
     if (poDS->m_nPlanarConfig == PLANARCONFIG_CONTIG && l_nBands != 1)
         poDS->SetMetadataItem("INTERLEAVE", "PIXEL", "IMAGE_STRUCTURE");
@@ -6331,15 +6914,98 @@ GDALDataset *GTiffDataset::Create(const char *pszFilename, int nXSize,
     return poDS;
 }
 
+/************************************************************************/
+/*                          CanCopyRawStriles()                         */
+/************************************************************************/
+
+// Returns whether the compressed striles of poSrcDS can be written as they
+// are in poDstDS, without being decompressed and recompressed.
+// bLossyOptionsSet must be set if options controlling the quality of lossy
+// codecs have been explicitly specified, in which case we must re-encode.
+bool GTiffDataset::CanCopyRawStriles(const GTiffDataset *poDstDS,
+                                     const GTiffDataset *poSrcDS,
+                                     bool bLossyOptionsSet)
+{
+    if (!CPLTestBool(CPLGetConfigOption("GTIFF_DIRECT_COPY", "YES")))
+        return false;
+
+    switch (poDstDS->m_nCompression)
+    {
+        case COMPRESSION_ADOBE_DEFLATE:
+        case COMPRESSION_LZW:
+        case COMPRESSION_ZSTD:
+        case COMPRESSION_LZMA:
+            break;
+        case COMPRESSION_LERC:
+        case COMPRESSION_WEBP:
+        case COMPRESSION_JXL:
+            if (bLossyOptionsSet)
+                return false;
+            break;
+        default:
+            // In particular JPEG, whose tables are stored in the IFD.
+            return false;
+    }
+
+    // Block statistics must be computed from the decoded striles
+    if (!poDstDS->m_adfBlockStatistics.empty())
+        return false;
+
+    if (poSrcDS->eAccess != GA_ReadOnly || poSrcDS->m_bStreamingIn ||
+        poSrcDS->m_nCompression != poDstDS->m_nCompression ||
+        poSrcDS->nRasterXSize != poDstDS->nRasterXSize ||
+        poSrcDS->nRasterYSize != poDstDS->nRasterYSize ||
+        poSrcDS->nBands != poDstDS->nBands ||
+        poSrcDS->m_nBlockXSize != poDstDS->m_nBlockXSize ||
+        poSrcDS->m_nBlockYSize != poDstDS->m_nBlockYSize ||
+        poSrcDS->m_nBlocksPerBand != poDstDS->m_nBlocksPerBand ||
+        poSrcDS->m_nPlanarConfig != poDstDS->m_nPlanarConfig ||
+        poSrcDS->m_nSamplesPerPixel != poDstDS->m_nSamplesPerPixel ||
+        poSrcDS->m_nBitsPerSample != poDstDS->m_nBitsPerSample ||
+        poSrcDS->m_nSampleFormat != poDstDS->m_nSampleFormat ||
+        poSrcDS->m_nPhotometric != poDstDS->m_nPhotometric ||
+        TIFFIsTiled(poSrcDS->m_hTIFF) != TIFFIsTiled(poDstDS->m_hTIFF) ||
+        // Decompressed data is in the byte order of the file
+        TIFFIsBigEndian(poSrcDS->m_hTIFF) != TIFFIsBigEndian(poDstDS->m_hTIFF))
+    {
+        return false;
+    }
+
+    if (GTIFFSupportsPredictor(poDstDS->m_nCompression))
+    {
+        uint16_t nSrcPredictor = PREDICTOR_NONE;
+        uint16_t nDstPredictor = PREDICTOR_NONE;
+        TIFFGetField(poSrcDS->m_hTIFF, TIFFTAG_PREDICTOR, &nSrcPredictor);
+        TIFFGetField(poDstDS->m_hTIFF, TIFFTAG_PREDICTOR, &nDstPredictor);
+        if (nSrcPredictor != nDstPredictor)
+            return false;
+    }
+
+    // Additional compression of the LERC blob
+    if (poDstDS->m_nCompression == COMPRESSION_LERC &&
+        poSrcDS->m_anLercAddCompressionAndVersion[1] !=
+            poDstDS->m_anLercAddCompressionAndVersion[1])
+    {
+        return false;
+    }
+
+    CPLDebug("GTiff", "Copying compressed striles of %s as they are",
+             poSrcDS->GetDescription());
+    return true;
+}
+
 /************************************************************************/
 /*                           CopyImageryAndMask()                       */
 /************************************************************************/
 
+// If poSrcRawDS is set, it must be compatible with poDstDS according to
+// CanCopyRawStriles(), and have the same content as poSrcDS.
 CPLErr GTiffDataset::CopyImageryAndMask(GTiffDataset *poDstDS,
                                         GDALDataset *poSrcDS,
                                         GDALRasterBand *poSrcMaskBand,
                                         GDALProgressFunc pfnProgress,
-                                        void *pProgressData)
+                                        void *pProgressData,
+                                        GTiffDataset *poSrcRawDS)
 {
     CPLErr eErr = CE_None;
 
@@ -6353,6 +7019,10 @@ CPLErr GTiffDataset::CopyImageryAndMask(GTiffDataset *poDstDS,
     {
         eErr = CE_Failure;
     }
+    const vsi_l_offset nBlockBufferSize =
+        static_cast<vsi_l_offset>(poDstDS->m_nBlockXSize) *
+        poDstDS->m_nBlockYSize * l_nBands * nDataTypeSize;
+    std::vector<GByte> abyRawBuffer;
     const int nYSize = poDstDS->nRasterYSize;
     const int nXSize = poDstDS->nRasterXSize;
     const int nBlocks = poDstDS->m_nBlocksPerBand;
@@ -6391,7 +7061,45 @@ CPLErr GTiffDataset::CopyImageryAndMask(GTiffDataset *poDstDS,
                            poDstDS->m_nBlockYSize * l_nBands * nDataTypeSize);
             }
 
-            if (!bIsOddBand)
+            vsi_l_offset nRawSize = 0;
+            if (poSrcRawDS &&
+                poSrcRawDS->IsBlockAvailable(iBlock, nullptr, &nRawSize) &&
+                nRawSize > 0 &&
+                // Sanity check, in case of corrupted byte count
+                nRawSize <= 4 * nBlockBufferSize + 1024 * 1024)
+            {
+                if (abyRawBuffer.size() < nRawSize)
+                    abyRawBuffer.resize(static_cast<size_t>(nRawSize));
+                const auto nRead =
+                    TIFFIsTiled(poSrcRawDS->m_hTIFF)
+                        ? TIFFReadRawTile(poSrcRawDS->m_hTIFF, iBlock,
+                                          abyRawBuffer.data(),
+                                          static_cast<tmsize_t>(nRawSize))
+                        : TIFFReadRawStrip(poSrcRawDS->m_hTIFF, iBlock,
+                                           abyRawBuffer.data(),
+                                           static_cast<tmsize_t>(nRawSize));
+                if (nRead != static_cast<tmsize_t>(nRawSize))
+                {
+                    eErr = CE_Failure;
+                }
+                else
+                {
+                    // Flush pending compression jobs (of the mask of the
+                    // previous block, or of blocks missing in the source),
+                    // so that striles are written in order.
+                    auto &oQueue = poDstDS->m_poBaseDS
+                                       ? poDstDS->m_poBaseDS->m_asQueueJobIdx
+                                       : poDstDS->m_asQueueJobIdx;
+                    while (!oQueue.empty())
+                    {
+                        poDstDS->WaitCompletionForJobIdx(oQueue.front());
+                    }
+                    poDstDS->WriteRawStripOrTile(
+                        iBlock, abyRawBuffer.data(),
+                        static_cast<GPtrDiff_t>(nRawSize));
+                }
+            }
+            else if (!bIsOddBand)
             {
                 eErr = poSrcDS->RasterIO(
                     GF_Read, iX, iY, nReqXSize, nReqYSize, pBlockBuffer,
@@ -6812,7 +7520,7 @@ GDALDataset *GTiffDataset::CreateCopy(const char *pszFilename,
     const int nYSize = poSrcDS->GetRasterYSize();
     TIFF *l_hTIFF = CreateLL(pszFilename, nXSize, nYSize, l_nBands, eType,
                              dfExtraSpaceForOverviews, papszCreateOptions,
-                             &l_fpL, l_osTmpFilename);
+                             &l_fpL, l_osTmpFilename, /* bCreateCopy = */ true);
     const bool bStreaming = !l_osTmpFilename.empty();
 
     CSLDestroy(papszCreateOptions);
@@ -7336,9 +8044,12 @@ GDALDataset *GTiffDataset::CreateCopy(const char *pszFilename,
             CPL_IGNORE_RET_VAL(VSIFCloseL(l_fpL));
             return nullptr;
         }
-        if (static_cast<vsi_l_offset>(VSIFWriteL(pabyBuffer, 1,
-                                                 static_cast<int>(nDataLength),
-                                                 fpStreaming)) != nDataLength)
+        // When compressed, the header is only written once the size of
+        // striles is known. See WriteStreamingHeader().
+        if (l_nCompression == COMPRESSION_NONE &&
+            static_cast<vsi_l_offset>(
+                VSIFWriteL(pabyBuffer, 1, static_cast<int>(nDataLength),
+                           fpStreaming)) != nDataLength)
         {
             ReportError(pszFilename, CE_Failure, CPLE_FileIO,
                         "Could not write %d bytes",
@@ -7594,6 +8305,7 @@ GDALDataset *GTiffDataset::CreateCopy(const char *pszFilename,
     poDS->m_fJXLAlphaDistance = GTiffGetJXLAlphaDistance(papszOptions);
 #endif
     poDS->InitCreationOrOpenOptions(true, papszOptions);
+    poDS->InitBlockStatistics(papszOptions);
 
     if (l_nCompression == COMPRESSION_ADOBE_DEFLATE ||
         l_nCompression == COMPRESSION_LERC)
@@ -7702,6 +8414,22 @@ GDALDataset *GTiffDataset::CreateCopy(const char *pszFilename,
     /*  compressed stream.                                                  */
     /* -------------------------------------------------------------------- */
 
+    // If the quality of lossy codecs is explicitly specified, compressed
+    // striles of a compatible source must not be copied as they are.
+    bool bLossyOptionsSet = false;
+    for (const char *pszKey : {"MAX_Z_ERROR", "WEBP_LEVEL", "WEBP_LOSSLESS",
+                               "JXL_LOSSLESS", "JXL_DISTANCE",
+                               "JXL_ALPHA_DISTANCE"})
+    {
+        const std::string osOverviewKey = std::string(pszKey) + "_OVERVIEW";
+        if (CSLFetchNameValue(papszOptions, pszKey) ||
+            CSLFetchNameValue(papszOptions, osOverviewKey.c_str()) ||
+            CPLGetConfigOption(osOverviewKey.c_str(), nullptr))
+        {
+            bLossyOptionsSet = true;
+        }
+    }
+
     // For scaled progress due to overview copying.
     const int nBandsWidthMask = l_nBands + (bCreateMask ? 1 : 0);
     double dfTotalPixels =
@@ -7879,9 +8607,39 @@ GDALDataset *GTiffDataset::CreateCopy(const char *pszFilename,
                         dfNextCurPixels / dfTotalPixels, pfnProgress,
                         pProgressData);
 
-                    eErr =
-                        CopyImageryAndMask(poDstDS, poSrcOvrDS, poSrcMaskBand,
-                                           GDALScaledProgress, pScaledData);
+                    // If the source overview level is a GTiff dataset whose
+                    // bands are exactly the ones of poSrcOvrDS, its striles
+                    // may be copied without recompression.
+                    GTiffDataset *poSrcOvrRawDS = nullptr;
+                    auto poSrcOvrGTiffDS = dynamic_cast<GTiffDataset *>(
+                        poSrcOvrBand->GetDataset());
+                    bool bSameBands =
+                        poSrcOvrGTiffDS &&
+                        poSrcOvrGTiffDS->GetRasterCount() == l_nBands;
+                    for (int i = 1; bSameBands && i <= l_nBands; ++i)
+                    {
+                        GDALRasterBand *poBand =
+                            poOvrDS ? (iOvrLevel == 0
+                                           ? poOvrDS->GetRasterBand(i)
+                                           : poOvrDS->GetRasterBand(i)
+                                                 ->GetOverview(iOvrLevel - 1))
+                                    : poSrcDS->GetRasterBand(i)->GetOverview(
+                                          iOvrLevel);
+                        bSameBands =
+                            poBand == poSrcOvrGTiffDS->GetRasterBand(i);
+                    }
+                    // The overview dataset provided by the COG driver has
+                    // been compressed with the target settings.
+                    if (bSameBands &&
+                        CanCopyRawStriles(poDstDS, poSrcOvrGTiffDS,
+                                          bLossyOptionsSet && !poOvrDS))
+                    {
+                        poSrcOvrRawDS = poSrcOvrGTiffDS;
+                    }
+
+                    eErr = CopyImageryAndMask(
+                        poDstDS, poSrcOvrDS, poSrcMaskBand, GDALScaledProgress,
+                        pScaledData, poSrcOvrRawDS);
 
                     dfCurPixels = dfNextCurPixels;
                     GDALDestroyScaledProgress(pScaledData);
@@ -7949,7 +8707,9 @@ GDALDataset *GTiffDataset::CreateCopy(const char *pszFilename,
 #endif
 
 #ifdef HAVE_LIBJPEG
-    if (bCopyFromJPEG)
+    // Streaming requires the imagery to be written through
+    // WriteEncodedTileOrStrip().
+    if (bCopyFromJPEG && !bStreaming)
     {
         eErr = GTIFF_CopyFromJPEG(poDS, poSrcDS, pfnProgress, pProgressData,
                                   bTryCopy);
@@ -8073,32 +8833,50 @@ GDALDataset *GTiffDataset::CreateCopy(const char *pszFilename,
 #endif
         eErr == CE_None)
     {
-        const char *papszCopyWholeRasterOptions[3] = {nullptr, nullptr,
-                                                      nullptr};
+        const char *papszCopyWholeRasterOptions[4] = {nullptr, nullptr,
+                                                      nullptr, nullptr};
         int iNextOption = 0;
-        papszCopyWholeRasterOptions[iNextOption++] = "SKIP_HOLES=YES";
+        // Streaming requires all blocks to be written.
+        if (!bStreaming)
+            papszCopyWholeRasterOptions[iNextOption++] = "SKIP_HOLES=YES";
         if (l_nCompression != COMPRESSION_NONE)
         {
             papszCopyWholeRasterOptions[iNextOption++] = "COMPRESSED=YES";
         }
         // For streaming with separate, we really want that bands are written
         // after each other, even if the source is pixel interleaved.
-        else if (bStreaming && poDS->m_nPlanarConfig == PLANARCONFIG_SEPARATE)
+        if (bStreaming && poDS->m_nPlanarConfig == PLANARCONFIG_SEPARATE)
         {
             papszCopyWholeRasterOptions[iNextOption++] = "INTERLEAVE=BAND";
         }
 
-        if (bCopySrcOverviews &&
+        GTiffDataset *poSrcRawDS = nullptr;
+        if (!bStreaming &&
             (l_nBands == 1 || poDS->m_nPlanarConfig == PLANARCONFIG_CONTIG))
         {
-            poDS->m_bBlockOrderRowMajor = true;
-            poDS->m_bLeaderSizeAsUInt4 = true;
-            poDS->m_bTrailerRepeatedLast4BytesRepeated = true;
-            if (poDS->m_poMaskDS)
+            auto poSrcGTiffDS = dynamic_cast<GTiffDataset *>(poSrcDS);
+            if (poSrcGTiffDS &&
+                CanCopyRawStriles(poDS, poSrcGTiffDS, bLossyOptionsSet))
+            {
+                poSrcRawDS = poSrcGTiffDS;
+            }
+        }
+
+        if ((bCopySrcOverviews || poSrcRawDS) &&
+            (l_nBands == 1 || poDS->m_nPlanarConfig == PLANARCONFIG_CONTIG))
+        {
+            if (bCopySrcOverviews)
             {
-                poDS->m_poMaskDS->m_bBlockOrderRowMajor = true;
-                poDS->m_poMaskDS->m_bLeaderSizeAsUInt4 = true;
-                poDS->m_poMaskDS->m_bTrailerRepeatedLast4BytesRepeated = true;
+                poDS->m_bBlockOrderRowMajor = true;
+                poDS->m_bLeaderSizeAsUInt4 = true;
+                poDS->m_bTrailerRepeatedLast4BytesRepeated = true;
+                if (poDS->m_poMaskDS)
+                {
+                    poDS->m_poMaskDS->m_bBlockOrderRowMajor = true;
+                    poDS->m_poMaskDS->m_bLeaderSizeAsUInt4 = true;
+                    poDS->m_poMaskDS->m_bTrailerRepeatedLast4BytesRepeated =
+                        true;
+                }
             }
 
             if (poDS->m_poMaskDS)
@@ -8111,12 +8889,45 @@ GDALDataset *GTiffDataset::CreateCopy(const char *pszFilename,
 
             eErr = CopyImageryAndMask(poDS, poSrcDS,
                                       poSrcDS->GetRasterBand(1)->GetMaskBand(),
-                                      GDALScaledProgress, pScaledData);
+                                      GDALScaledProgress, pScaledData,
+                                      poSrcRawDS);
             if (poDS->m_poMaskDS)
             {
                 bWriteMask = false;
             }
         }
+        else if (bStreaming && l_nCompression != COMPRESSION_NONE)
+        {
+            // The directory, which precedes the imagery, needs the size of
+            // each compressed strile. So the imagery is compressed a first
+            // time only to measure it, and then a second time to be streamed.
+            CPLDebug("GTiff", "Compressed streaming: measuring pass");
+            poDS->m_bStreamingMeasurePass = true;
+            void *pScaledPassData = GDALCreateScaledProgress(
+                0.0, 0.5, GDALScaledProgress, pScaledData);
+            eErr = GDALDatasetCopyWholeRaster(
+                /* (GDALDatasetH) */ poSrcDS,
+                /* (GDALDatasetH) */ poDS, papszCopyWholeRasterOptions,
+                GDALScaledProgress, pScaledPassData);
+            GDALDestroyScaledProgress(pScaledPassData);
+            if (eErr == CE_None)
+                eErr = poDS->FlushCache(false);
+            poDS->m_bStreamingMeasurePass = false;
+            if (eErr == CE_None && !poDS->WriteStreamingHeader())
+                eErr = CE_Failure;
+
+            if (eErr == CE_None)
+            {
+                CPLDebug("GTiff", "Compressed streaming: writing pass");
+                pScaledPassData = GDALCreateScaledProgress(
+                    0.5, 1.0, GDALScaledProgress, pScaledData);
+                eErr = GDALDatasetCopyWholeRaster(
+                    /* (GDALDatasetH) */ poSrcDS,
+                    /* (GDALDatasetH) */ poDS, papszCopyWholeRasterOptions,
+                    GDALScaledProgress, pScaledPassData);
+                GDALDestroyScaledProgress(pScaledPassData);
+            }
+        }
         else
         {
             eErr = GDALDatasetCopyWholeRaster(
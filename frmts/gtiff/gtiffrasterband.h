@@ -72,6 +72,8 @@ class GTiffRasterBand CPL_NON_FINAL : public GDALPamRasterBand
     void *CacheMultiRange(int nXOff, int nYOff, int nXSize, int nYSize,
                           int nBufXSize, int nBufYSize,
                           GDALRasterIOExtraArg *psExtraArg);
+    void *CacheStrileArrays(int nBlockX1, int nBlockY1, int nBlockX2,
+                            int nBlockY2, bool bWithByteCounts);
 
   protected:
     GTiffDataset *m_poGDS = nullptr;
@@ -93,6 +95,10 @@ class GTiffRasterBand CPL_NON_FINAL : public GDALPamRasterBand
 
     int ComputeBlockId(int nBlockXOff, int nBlockYOff) const;
 
+    bool ComputeStatisticsFromBlockStatistics(double &dfMin, double &dfMax,
+                                              double &dfMean, double &dfStdDev,
+                                              GUIntBig &nValidCount);
+
   public:
     GTiffRasterBand(GTiffDataset *, int);
     virtual ~GTiffRasterBand();
@@ -177,6 +183,13 @@ class GTiffRasterBand CPL_NON_FINAL : public GDALPamRasterBand
                                        int *pnBuckets, GUIntBig **ppanHistogram,
                                        int bForce, GDALProgressFunc,
                                        void *pProgressData) override final;
+
+    virtual CPLErr ComputeStatistics(int bApproxOK, double *pdfMin,
+                                     double *pdfMax, double *pdfMean,
+                                     double *pdfStdDev, GDALProgressFunc,
+                                     void *pProgressData) override final;
+    virtual CPLErr ComputeRasterMinMax(int bApproxOK,
+                                       double *adfMinMax) override final;
 };
 
 #endif  //  GTIFFRASTERBAND_H_INCLUDED
@@ -83,6 +83,211 @@ CPLErr GTiffRasterBand::GetDefaultHistogram(
                                                   pfnProgress, pProgressData);
 }
 
+/************************************************************************/
+/*               ComputeStatisticsFromBlockStatistics()                 */
+/************************************************************************/
+
+// Combine the statistics of each block stored with BLOCK_STATISTICS=YES.
+// Returns false if they are not available, or if they might differ from
+// what GDALRasterBand::ComputeStatistics() would compute.
+bool GTiffRasterBand::ComputeStatisticsFromBlockStatistics(
+    double &dfMin, double &dfMax, double &dfMean, double &dfStdDev,
+    GUIntBig &nValidCount)
+{
+    const auto &adfBlockStats = m_poGDS->m_adfBlockStatistics;
+    if (adfBlockStats.empty() || !IsBaseGTiffClass() ||
+        (eDataType == GDT_Byte &&
+         m_poGDS->m_nSampleFormat == SAMPLEFORMAT_INT))
+    {
+        return false;
+    }
+
+    // Make sure that the statistics of pending blocks have been computed
+    if (m_poGDS->eAccess == GA_Update)
+        m_poGDS->FlushCache(false);
+
+    int bHasNoData = FALSE;
+    const double dfNoData = GetNoDataValue(&bHasNoData);
+    const bool bUseNoData = bHasNoData && !CPLIsNan(dfNoData);
+    const double *padfBandHeader =
+        adfBlockStats.data() + 1 +
+        static_cast<size_t>(nBand - 1) *
+            GTiffDataset::BLOCK_STATS_VALUES_PER_BAND;
+    if ((padfBandHeader[0] != 0) != bUseNoData ||
+        (bUseNoData && padfBandHeader[1] != dfNoData))
+    {
+        return false;
+    }
+    if (!bUseNoData)
+    {
+        const int nBandMaskFlags = GetMaskFlags();
+        if (nBandMaskFlags != GMF_ALL_VALID && nBandMaskFlags != GMF_NODATA &&
+            GetColorInterpretation() != GCI_AlphaBand)
+        {
+            return false;
+        }
+    }
+
+    // Blocks that have never been written read as the nodata value, or zero.
+    bool bEmptyBlocksAreNoData = false;
+    if (bUseNoData)
+    {
+        double dfFillValue = 0;
+        GByte abyFill[sizeof(double)] = {0};
+        GDALCopyWords(&dfNoData, GDT_Float64, 0, abyFill, eDataType, 0, 1);
+        GDALCopyWords(abyFill, eDataType, 0, &dfFillValue, GDT_Float64, 0, 1);
+        bEmptyBlocksAreNoData = dfFillValue == dfNoData;
+    }
+
+    double dfCount = 0;
+    dfMin = std::numeric_limits<double>::infinity();
+    dfMax = -std::numeric_limits<double>::infinity();
+    dfMean = 0;
+    double dfM2 = 0;
+    for (int iBlock = 0; iBlock < m_poGDS->m_nBlocksPerBand; ++iBlock)
+    {
+        const double *padfStats =
+            adfBlockStats.data() +
+            m_poGDS->GetBlockStatisticsIndex(nBand - 1, iBlock);
+        double dfBlockCount = padfStats[0];
+        double dfBlockMin = padfStats[1];
+        double dfBlockMax = padfStats[2];
+        double dfBlockMean = padfStats[3];
+        double dfBlockM2 = padfStats[4];
+        if (dfBlockCount < 0)
+        {
+            const int nXBlock = iBlock % nBlocksPerRow;
+            const int nYBlock = iBlock / nBlocksPerRow;
+            if (m_poGDS->IsBlockAvailable(ComputeBlockId(nXBlock, nYBlock)) ||
+                (bUseNoData && !bEmptyBlocksAreNoData))
+            {
+                return false;
+            }
+            dfBlockCount =
+                bUseNoData
+                    ? 0
+                    : static_cast<double>(std::min(
+                          nBlockXSize, nRasterXSize - nXBlock * nBlockXSize)) *
+                          std::min(nBlockYSize,
+                                   nRasterYSize - nYBlock * nBlockYSize);
+            dfBlockMin = 0;
+            dfBlockMax = 0;
+            dfBlockMean = 0;
+            dfBlockM2 = 0;
+        }
+        if (dfBlockCount == 0)
+            continue;
+
+        // Chan et al. formula to combine sets
+        const double dfNewCount = dfCount + dfBlockCount;
+        const double dfDelta = dfBlockMean - dfMean;
+        dfMean += dfDelta * dfBlockCount / dfNewCount;
+        dfM2 += dfBlockM2 + dfDelta * dfDelta * dfCount * dfBlockCount /
+                                dfNewCount;
+        dfCount = dfNewCount;
+        dfMin = std::min(dfMin, dfBlockMin);
+        dfMax = std::max(dfMax, dfBlockMax);
+    }
+
+    nValidCount = static_cast<GUIntBig>(dfCount);
+    if (nValidCount == 0)
+    {
+        dfMin = 0;
+        dfMax = 0;
+    }
+    dfStdDev = nValidCount > 0 ? sqrt(dfM2 / dfCount) : 0.0;
+    return true;
+}
+
+/************************************************************************/
+/*                         ComputeStatistics()                          */
+/************************************************************************/
+
+CPLErr GTiffRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
+                                          double *pdfMax, double *pdfMean,
+                                          double *pdfStdDev,
+                                          GDALProgressFunc pfnProgress,
+                                          void *pProgressData)
+{
+    m_poGDS->LoadGeoreferencingAndPamIfNeeded();
+
+    double dfMin = 0;
+    double dfMax = 0;
+    double dfMean = 0;
+    double dfStdDev = 0;
+    GUIntBig nValidCount = 0;
+    if (!ComputeStatisticsFromBlockStatistics(dfMin, dfMax, dfMean, dfStdDev,
+                                              nValidCount))
+    {
+        return GDALPamRasterBand::ComputeStatistics(
+            bApproxOK, pdfMin, pdfMax, pdfMean, pdfStdDev, pfnProgress,
+            pProgressData);
+    }
+
+    if (pfnProgress && !pfnProgress(1.0, "Compute Statistics", pProgressData))
+    {
+        ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+
+    // Statistics computed from block statistics are exact
+    if (nValidCount > 0)
+    {
+        if (GetMetadataItem("STATISTICS_APPROXIMATE"))
+            SetMetadataItem("STATISTICS_APPROXIMATE", nullptr);
+        SetStatistics(dfMin, dfMax, dfMean, dfStdDev);
+    }
+    SetValidPercent(static_cast<GUIntBig>(nRasterXSize) * nRasterYSize,
+                    nValidCount);
+
+    if (pdfMin)
+        *pdfMin = dfMin;
+    if (pdfMax)
+        *pdfMax = dfMax;
+    if (pdfMean)
+        *pdfMean = dfMean;
+    if (pdfStdDev)
+        *pdfStdDev = dfStdDev;
+
+    if (nValidCount > 0)
+        return CE_None;
+
+    ReportError(
+        CE_Failure, CPLE_AppDefined,
+        "Failed to compute statistics, no valid pixels found in sampling.");
+    return CE_Failure;
+}
+
+/************************************************************************/
+/*                        ComputeRasterMinMax()                         */
+/************************************************************************/
+
+CPLErr GTiffRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
+{
+    m_poGDS->LoadGeoreferencingAndPamIfNeeded();
+
+    double dfMin = 0;
+    double dfMax = 0;
+    double dfMean = 0;
+    double dfStdDev = 0;
+    GUIntBig nValidCount = 0;
+    if (!ComputeStatisticsFromBlockStatistics(dfMin, dfMax, dfMean, dfStdDev,
+                                              nValidCount))
+    {
+        return GDALPamRasterBand::ComputeRasterMinMax(bApproxOK, adfMinMax);
+    }
+
+    adfMinMax[0] = dfMin;
+    adfMinMax[1] = dfMax;
+    if (nValidCount > 0)
+        return CE_None;
+
+    ReportError(
+        CE_Failure, CPLE_AppDefined,
+        "Failed to compute min/max, no valid pixels found in sampling.");
+    return CE_Failure;
+}
+
 /************************************************************************/
 /*                           DirectIO()                                 */
 /************************************************************************/
@@ -611,6 +816,128 @@ CPLVirtualMem *GTiffRasterBand::GetVirtualMemAutoInternal(GDALRWFlag eRWFlag,
     return pVMem;
 }
 
+/************************************************************************/
+/*                        CacheStrileArrays()                           */
+/************************************************************************/
+
+// Fetches, with a single planned multi-range read, the pages of the
+// [Tile|Strip]Offsets (and optionally [Tile|Strip]ByteCounts) arrays that
+// libtiff will need to read for the blocks of the window, instead of letting
+// it issue one read per block row. The pages are installed as cached ranges
+// of the TIFF handle, and the returned buffer must be freed by the caller
+// once the cached ranges have been reset.
+void *GTiffRasterBand::CacheStrileArrays(int nBlockX1, int nBlockY1,
+                                         int nBlockX2, int nBlockY2,
+                                         bool bWithByteCounts)
+{
+    if (m_poGDS->m_bStreamingIn || m_poGDS->eAccess != GA_ReadOnly)
+        return nullptr;
+
+    if (m_poGDS->UsePagedStrileArrayCache())
+    {
+        // Load in a single go the pages of GDAL's own cache that the
+        // window needs.
+        std::set<uint64_t> oSetPages;
+        for (int iY = nBlockY1; iY <= nBlockY2; ++iY)
+        {
+            int nFirst = nBlockX1 + iY * nBlocksPerRow;
+            if (m_poGDS->m_nPlanarConfig == PLANARCONFIG_SEPARATE)
+                nFirst += (nBand - 1) * m_poGDS->m_nBlocksPerBand;
+            const int nLast = nFirst + (nBlockX2 - nBlockX1) + 1;
+            for (int nPage = nFirst / GTiffDataset::STRILE_ARRAY_PAGE_SIZE;
+                 nPage <= nLast / GTiffDataset::STRILE_ARRAY_PAGE_SIZE;
+                 ++nPage)
+            {
+                oSetPages.insert(nPage);
+            }
+        }
+        m_poGDS->LoadStrileArrayPages(oSetPages);
+        return nullptr;
+    }
+
+    m_poGDS->ReadStrileArrayLocations();
+
+    // Same constant as IO_CACHE_PAGE_SIZE in libtiff tif_dirread.c
+    constexpr vsi_l_offset PAGE_SIZE = 4096;
+    std::vector<std::pair<vsi_l_offset, size_t>> aOffsetSize;
+    std::vector<vsi_l_offset> anPages;
+    const auto AddArray =
+        [this, nBlockX1, nBlockY1, nBlockX2, nBlockY2, &aOffsetSize,
+         &anPages](const GTiffDataset::StrileArrayLocation &sLocation)
+    {
+        if (sLocation.nValueSize == 0)
+            return;
+        const vsi_l_offset nArrayEnd =
+            sLocation.nOffset + sLocation.nCount * sLocation.nValueSize;
+        for (int iY = nBlockY1; iY <= nBlockY2; ++iY)
+        {
+            int nFirst = nBlockX1 + iY * nBlocksPerRow;
+            if (m_poGDS->m_nPlanarConfig == PLANARCONFIG_SEPARATE)
+                nFirst += (nBand - 1) * m_poGDS->m_nBlocksPerBand;
+            // The offset of the block after the last one is also used by
+            // the optimized retrieval of the block size in COG files.
+            const uint64_t nLast = std::min<uint64_t>(
+                static_cast<uint64_t>(nFirst) + (nBlockX2 - nBlockX1) + 1,
+                sLocation.nCount - 1);
+            if (static_cast<uint64_t>(nFirst) > nLast)
+                break;
+            // Replicate the window that _TIFFPartialReadStripArray() reads
+            const vsi_l_offset nStart =
+                (sLocation.nOffset +
+                 static_cast<vsi_l_offset>(nFirst) * sLocation.nValueSize) /
+                PAGE_SIZE * PAGE_SIZE;
+            const vsi_l_offset nEnd = std::min(
+                nArrayEnd,
+                (sLocation.nOffset + nLast * sLocation.nValueSize) /
+                        PAGE_SIZE * PAGE_SIZE +
+                    2 * PAGE_SIZE);
+            bool bAllCached = true;
+            for (vsi_l_offset nPage = nStart; nPage < nEnd; nPage += PAGE_SIZE)
+            {
+                if (m_poGDS->m_oSetCachedStrileArrayPages.find(nPage) ==
+                    m_poGDS->m_oSetCachedStrileArrayPages.end())
+                {
+                    bAllCached = false;
+                    anPages.push_back(nPage);
+                }
+            }
+            if (!bAllCached)
+            {
+                aOffsetSize.emplace_back(nStart,
+                                         static_cast<size_t>(nEnd - nStart));
+            }
+        }
+    };
+    AddArray(m_poGDS->m_sStrileOffsetsLocation);
+    if (bWithByteCounts)
+        AddArray(m_poGDS->m_sStrileByteCountsLocation);
+    if (aOffsetSize.size() <= 1)
+        return nullptr;
+
+    static CPLConfigOptionCache oMaxRawBlockCacheSize(
+        "GDAL_MAX_RAW_BLOCK_CACHE_SIZE", "10485760");
+    const unsigned int nMaxRawBlockCacheSize =
+        atoi(oMaxRawBlockCacheSize.Get());
+    const GTiffDataset::MultiRangePlan sPlan = GTiffDataset::PlanMultiRange(
+        aOffsetSize, nMaxRawBlockCacheSize, "strile arrays");
+    if (sPlan.nTotalSize > nMaxRawBlockCacheSize)
+        return nullptr;
+
+    thandle_t th = TIFFClientdata(m_poGDS->m_hTIFF);
+    std::vector<void *> apData;
+    void *pBufferedData = GTiffDataset::ReadMultiRangePlan(
+        VSI_TIFFGetVSILFile(th), sPlan, apData);
+    if (pBufferedData)
+    {
+        m_poGDS->m_oSetCachedStrileArrayPages.insert(anPages.begin(),
+                                                     anPages.end());
+        VSI_TIFFSetCachedRanges(th, static_cast<int>(sPlan.anSizes.size()),
+                                apData.data(), sPlan.anOffsets.data(),
+                                sPlan.anSizes.data());
+    }
+    return pBufferedData;
+}
+
 /************************************************************************/
 /*                         CacheMultiRange()                            */
 /************************************************************************/
@@ -689,7 +1016,7 @@ void *GTiffRasterBand::CacheMultiRange(int nXOff, int nYOff, int nXSize,
             size_t nTotalSize, size_t nMaxRawBlockCacheSize)
     {
         bool bTryMask = m_poGDS->m_bMaskInterleavedWithImagery;
-        nOffset = TIFFGetStrileOffset(m_poGDS->m_hTIFF, nBlockId);
+        nOffset = m_poGDS->GetStrileOffset(nBlockId);
         if (nOffset >= 4)
         {
             if (nBlockId == nBlockCount - 1)
@@ -700,13 +1027,13 @@ void *GTiffRasterBand::CacheMultiRange(int nXOff, int nYOff, int nXSize,
                 if (bTryMask && m_poGDS->GetRasterBand(1)->GetMaskBand() &&
                     m_poGDS->m_poMaskDS)
                 {
-                    auto nMaskOffset = TIFFGetStrileOffset(
-                        m_poGDS->m_poMaskDS->m_hTIFF, nBlockId);
+                    auto nMaskOffset =
+                        m_poGDS->m_poMaskDS->GetStrileOffset(nBlockId);
                     if (nMaskOffset)
                     {
                         nSize = nMaskOffset +
-                                TIFFGetStrileByteCount(
-                                    m_poGDS->m_poMaskDS->m_hTIFF, nBlockId) -
+                                m_poGDS->m_poMaskDS->GetStrileByteCount(
+                                    nBlockId) -
                                 nOffset;
                     }
                     else
@@ -716,7 +1043,7 @@ void *GTiffRasterBand::CacheMultiRange(int nXOff, int nYOff, int nXSize,
                 }
                 if (nSize == 0)
                 {
-                    nSize = TIFFGetStrileByteCount(m_poGDS->m_hTIFF, nBlockId);
+                    nSize = m_poGDS->GetStrileByteCount(nBlockId);
                 }
                 if (nSize && m_poGDS->m_bTrailerRepeatedLast4BytesRepeated)
                 {
@@ -726,7 +1053,7 @@ void *GTiffRasterBand::CacheMultiRange(int nXOff, int nYOff, int nXSize,
             else
             {
                 auto nOffsetNext =
-                    TIFFGetStrileOffset(m_poGDS->m_hTIFF, nBlockId + 1);
+                    m_poGDS->GetStrileOffset(nBlockId + 1);
                 if (nOffsetNext > nOffset)
                 {
                     nSize = nOffsetNext - nOffset;
@@ -740,7 +1067,7 @@ void *GTiffRasterBand::CacheMultiRange(int nXOff, int nYOff, int nXSize,
                                  nBlockId + 1, nBlockId);
                     }
                     bTryMask = false;
-                    nSize = TIFFGetStrileByteCount(m_poGDS->m_hTIFF, nBlockId);
+                    nSize = m_poGDS->GetStrileByteCount(nBlockId);
                     if (m_poGDS->m_bTrailerRepeatedLast4BytesRepeated)
                         nSize += 4;
                 }
@@ -931,8 +1258,19 @@ void *GTiffRasterBand::CacheMultiRange(int nXOff, int nYOff, int nXSize,
     {
         std::vector<std::pair<vsi_l_offset, size_t>> aOffsetSize;
         size_t nTotalSize = 0;
-        const unsigned int nMaxRawBlockCacheSize = atoi(
-            CPLGetConfigOption("GDAL_MAX_RAW_BLOCK_CACHE_SIZE", "10485760"));
+        static CPLConfigOptionCache oMaxRawBlockCacheSize(
+            "GDAL_MAX_RAW_BLOCK_CACHE_SIZE", "10485760");
+        const unsigned int nMaxRawBlockCacheSize =
+            atoi(oMaxRawBlockCacheSize.Get());
+        const bool bUseOptimizedRetrieval =
+            (m_poGDS->m_nPlanarConfig == PLANARCONFIG_CONTIG ||
+             m_poGDS->nBands == 1) &&
+            !m_poGDS->m_bStreamingIn && m_poGDS->m_bBlockOrderRowMajor &&
+            m_poGDS->m_bLeaderSizeAsUInt4;
+        // The optimized retrieval only needs the offsets array
+        void *pStrileArrayData =
+            CacheStrileArrays(nBlockX1, nBlockY1, nBlockX2, nBlockY2,
+                              !bUseOptimizedRetrieval);
         bool bGoOn = true;
         for (int iY = nBlockY1; bGoOn && iY <= nBlockY2; iY++)
         {
@@ -950,11 +1288,7 @@ void *GTiffRasterBand::CacheMultiRange(int nXOff, int nYOff, int nXSize,
                 vsi_l_offset nOffset = 0;
                 vsi_l_offset nSize = 0;
 
-                if ((m_poGDS->m_nPlanarConfig == PLANARCONFIG_CONTIG ||
-                     m_poGDS->nBands == 1) &&
-                    !m_poGDS->m_bStreamingIn &&
-                    m_poGDS->m_bBlockOrderRowMajor &&
-                    m_poGDS->m_bLeaderSizeAsUInt4)
+                if (bUseOptimizedRetrieval)
                 {
                     OptimizedRetrievalOfOffsetSize(nBlockId, nOffset, nSize,
                                                    nTotalSize,
@@ -988,90 +1322,39 @@ void *GTiffRasterBand::CacheMultiRange(int nXOff, int nYOff, int nXSize,
             }
         }
 
-        std::sort(aOffsetSize.begin(), aOffsetSize.end());
+        if (pStrileArrayData)
+        {
+            VSI_TIFFSetCachedRanges(th, 0, nullptr, nullptr, nullptr);
+            VSIFree(pStrileArrayData);
+        }
 
         if (nTotalSize > 0)
         {
-            pBufferedData = VSI_MALLOC_VERBOSE(nTotalSize);
+            const GTiffDataset::MultiRangePlan sPlan =
+                GTiffDataset::PlanMultiRange(aOffsetSize,
+                                             nMaxRawBlockCacheSize, "blocks");
+            std::vector<void *> apData;
+            pBufferedData = GTiffDataset::ReadMultiRangePlan(
+                VSI_TIFFGetVSILFile(th), sPlan, apData);
             if (pBufferedData)
             {
-                std::vector<vsi_l_offset> anOffsets;
-                std::vector<size_t> anSizes;
-                std::vector<void *> apData;
-                anOffsets.push_back(aOffsetSize[0].first);
-                apData.push_back(static_cast<GByte *>(pBufferedData));
-                size_t nChunkSize = aOffsetSize[0].second;
-                size_t nAccOffset = 0;
-                // Try to merge contiguous or slightly overlapping ranges
-                for (size_t i = 0; i < aOffsetSize.size() - 1; i++)
+                if (!oMapStrileToOffsetByteCount.empty() &&
+                    !FillCacheStrileToOffsetByteCount(sPlan.anOffsets,
+                                                      sPlan.anSizes, apData))
                 {
-                    if (aOffsetSize[i].first < aOffsetSize[i + 1].first &&
-                        aOffsetSize[i].first + aOffsetSize[i].second >=
-                            aOffsetSize[i + 1].first)
-                    {
-                        const auto overlap = aOffsetSize[i].first +
-                                             aOffsetSize[i].second -
-                                             aOffsetSize[i + 1].first;
-                        // That should always be the case for well behaved
-                        // TIFF files.
-                        if (aOffsetSize[i + 1].second > overlap)
-                        {
-                            nChunkSize += static_cast<size_t>(
-                                aOffsetSize[i + 1].second - overlap);
-                        }
-                    }
-                    else
-                    {
-                        // terminate current block
-                        anSizes.push_back(nChunkSize);
-#ifdef DEBUG_VERBOSE
-                        CPLDebug("GTiff",
-                                 "Requesting range [" CPL_FRMT_GUIB
-                                 "-" CPL_FRMT_GUIB "]",
-                                 anOffsets.back(),
-                                 anOffsets.back() + anSizes.back() - 1);
-#endif
-                        nAccOffset += nChunkSize;
-                        // start a new range
-                        anOffsets.push_back(aOffsetSize[i + 1].first);
-                        apData.push_back(static_cast<GByte *>(pBufferedData) +
-                                         nAccOffset);
-                        nChunkSize = aOffsetSize[i + 1].second;
-                    }
+                    // Retry without optimization
+                    CPLFree(pBufferedData);
+                    m_poGDS->m_bLeaderSizeAsUInt4 = false;
+                    void *pRet =
+                        CacheMultiRange(nXOff, nYOff, nXSize, nYSize,
+                                        nBufXSize, nBufYSize, psExtraArg);
+                    m_poGDS->m_bLeaderSizeAsUInt4 = true;
+                    return pRet;
                 }
-                // terminate last block
-                anSizes.push_back(nChunkSize);
-#ifdef DEBUG_VERBOSE
-                CPLDebug(
-                    "GTiff",
-                    "Requesting range [" CPL_FRMT_GUIB "-" CPL_FRMT_GUIB "]",
-                    anOffsets.back(), anOffsets.back() + anSizes.back() - 1);
-#endif
-
-                VSILFILE *fp = VSI_TIFFGetVSILFile(th);
 
-                if (VSIFReadMultiRangeL(static_cast<int>(anSizes.size()),
-                                        &apData[0], &anOffsets[0], &anSizes[0],
-                                        fp) == 0)
-                {
-                    if (!oMapStrileToOffsetByteCount.empty() &&
-                        !FillCacheStrileToOffsetByteCount(anOffsets, anSizes,
-                                                          apData))
-                    {
-                        // Retry without optimization
-                        CPLFree(pBufferedData);
-                        m_poGDS->m_bLeaderSizeAsUInt4 = false;
-                        void *pRet =
-                            CacheMultiRange(nXOff, nYOff, nXSize, nYSize,
-                                            nBufXSize, nBufYSize, psExtraArg);
-                        m_poGDS->m_bLeaderSizeAsUInt4 = true;
-                        return pRet;
-                    }
-
-                    VSI_TIFFSetCachedRanges(
-                        th, static_cast<int>(anSizes.size()), &apData[0],
-                        &anOffsets[0], &anSizes[0]);
-                }
+                VSI_TIFFSetCachedRanges(
+                    th, static_cast<int>(sPlan.anSizes.size()), &apData[0],
+                    &sPlan.anOffsets[0], &sPlan.anSizes[0]);
             }
         }
     }
@@ -1341,6 +1624,9 @@ CPLErr GTiffRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff, void *pImage)
 
     CacheMaskForBlock(nBlockXOff, nBlockYOff);
 
+    if (eErr == CE_None)
+        m_poGDS->ReadAhead(this, nBlockXOff, nBlockYOff);
+
     return eErr;
 }
 
@@ -30,6 +30,11 @@
 #include "tif_predict.h"
 #include "tiffiop.h"
 
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#define PREDICTOR_USE_SSE2
+#endif
+
 #define PredictorState(tif) ((TIFFPredictorState *)(tif)->tif_data)
 
 static int horAcc8(TIFF *tif, uint8_t *cp0, tmsize_t cc);
@@ -332,6 +337,129 @@ static int PredictorSetupEncode(TIFF *tif)
         case 0:;                                                               \
     }
 
+#ifdef PREDICTOR_USE_SSE2
+/*
+ * SSE2 versions of the accumulation of bytes and words, for the most common
+ * strides. The prefix sum of a vector is computed with log2(lanes) shifted
+ * additions, and the last accumulated pixel is carried to the next vector.
+ * Return 0 if the stride is not handled.
+ */
+static int horAcc8SSE2(uint8_t *cp, tmsize_t cc, tmsize_t stride)
+{
+    __m128i carry = _mm_setzero_si128();
+    tmsize_t i = 0;
+    if (stride == 1)
+    {
+        for (; i + 15 < cc; i += 16)
+        {
+            __m128i x = _mm_loadu_si128((const __m128i *)(cp + i));
+            x = _mm_add_epi8(x, _mm_slli_si128(x, 1));
+            x = _mm_add_epi8(x, _mm_slli_si128(x, 2));
+            x = _mm_add_epi8(x, _mm_slli_si128(x, 4));
+            x = _mm_add_epi8(x, _mm_slli_si128(x, 8));
+            x = _mm_add_epi8(x, carry);
+            _mm_storeu_si128((__m128i *)(cp + i), x);
+            /* Broadcast byte 15 */
+            carry = _mm_unpackhi_epi8(x, x);
+            carry = _mm_unpackhi_epi16(carry, carry);
+            carry = _mm_shuffle_epi32(carry, 0xFF);
+        }
+    }
+    else if (stride == 4)
+    {
+        for (; i + 15 < cc; i += 16)
+        {
+            __m128i x = _mm_loadu_si128((const __m128i *)(cp + i));
+            x = _mm_add_epi8(x, _mm_slli_si128(x, 4));
+            x = _mm_add_epi8(x, _mm_slli_si128(x, 8));
+            x = _mm_add_epi8(x, carry);
+            _mm_storeu_si128((__m128i *)(cp + i), x);
+            /* Broadcast bytes 12 to 15 */
+            carry = _mm_shuffle_epi32(x, 0xFF);
+        }
+    }
+    else
+    {
+        return 0;
+    }
+    if (i < stride)
+        i = stride;
+    for (; i < cc; i++)
+        cp[i] = (unsigned char)((cp[i] + cp[i - stride]) & 0xff);
+    return 1;
+}
+
+static void horAcc16Stride1SSE2(uint16_t *wp, tmsize_t wc)
+{
+    __m128i carry = _mm_setzero_si128();
+    tmsize_t i = 0;
+    for (; i + 7 < wc; i += 8)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i *)(wp + i));
+        x = _mm_add_epi16(x, _mm_slli_si128(x, 2));
+        x = _mm_add_epi16(x, _mm_slli_si128(x, 4));
+        x = _mm_add_epi16(x, _mm_slli_si128(x, 8));
+        x = _mm_add_epi16(x, carry);
+        _mm_storeu_si128((__m128i *)(wp + i), x);
+        /* Broadcast word 7 */
+        carry = _mm_shufflehi_epi16(x, 0xFF);
+        carry = _mm_unpackhi_epi64(carry, carry);
+    }
+    if (i == 0)
+        i = 1;
+    for (; i < wc; i++)
+        wp[i] = (uint16_t)(((unsigned int)wp[i] + wp[i - 1]) & 0xffff);
+}
+
+TIFF_NOSANITIZE_UNSIGNED_INT_OVERFLOW
+static void horAcc32Stride1SSE2(uint32_t *wp, tmsize_t wc)
+{
+    __m128i carry = _mm_setzero_si128();
+    tmsize_t i = 0;
+    for (; i + 3 < wc; i += 4)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i *)(wp + i));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+        x = _mm_add_epi32(x, carry);
+        _mm_storeu_si128((__m128i *)(wp + i), x);
+        carry = _mm_shuffle_epi32(x, 0xFF);
+    }
+    if (i == 0)
+        i = 1;
+    for (; i < wc; i++)
+        wp[i] += wp[i - 1];
+}
+
+/*
+ * SSE2 versions of horizontal differencing, for any stride (in samples).
+ * Vectors are processed from the end of the row, so that the samples they
+ * subtract have not been modified yet.
+ */
+#define DEFINE_HOR_DIFF_SSE2(name, type, sub_epi)                              \
+    TIFF_NOSANITIZE_UNSIGNED_INT_OVERFLOW                                      \
+    static void name(type *wp, tmsize_t wc, tmsize_t stride)                   \
+    {                                                                          \
+        const tmsize_t lanes = (tmsize_t)(16 / sizeof(type));                  \
+        tmsize_t i = wc - lanes;                                               \
+        for (; i >= stride; i -= lanes)                                        \
+        {                                                                      \
+            const __m128i x = _mm_loadu_si128((const __m128i *)(wp + i));      \
+            const __m128i y =                                                  \
+                _mm_loadu_si128((const __m128i *)(wp + i - stride));           \
+            _mm_storeu_si128((__m128i *)(wp + i), sub_epi(x, y));              \
+        }                                                                      \
+        for (i += lanes - 1; i >= stride; i--)                                 \
+            wp[i] = (type)(wp[i] - wp[i - stride]);                            \
+    }
+
+DEFINE_HOR_DIFF_SSE2(horDiff8SSE2, uint8_t, _mm_sub_epi8)
+DEFINE_HOR_DIFF_SSE2(horDiff16SSE2, uint16_t, _mm_sub_epi16)
+DEFINE_HOR_DIFF_SSE2(horDiff32SSE2, uint32_t, _mm_sub_epi32)
+DEFINE_HOR_DIFF_SSE2(horDiff64SSE2, uint64_t, _mm_sub_epi64)
+
+#endif /* PREDICTOR_USE_SSE2 */
+
 /* Remarks related to C standard compliance in all below functions : */
 /* - to avoid any undefined behavior, we only operate on unsigned types */
 /*   since the behavior of "overflows" is defined (wrap over) */
@@ -352,6 +480,10 @@ static int horAcc8(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 
     if (cc > stride)
     {
+#ifdef PREDICTOR_USE_SSE2
+        if (horAcc8SSE2(cp, cc, stride))
+            return 1;
+#endif
         /*
          * Pipeline the most common cases.
          */
@@ -420,6 +552,14 @@ static int horAcc16(TIFF *tif, uint8_t *cp0, tmsize_t cc)
         return 0;
     }
 
+#ifdef PREDICTOR_USE_SSE2
+    if (stride == 1)
+    {
+        horAcc16Stride1SSE2(wp, wc);
+        return 1;
+    }
+#endif
+
     if (wc > stride)
     {
         wc -= stride;
@@ -457,6 +597,14 @@ static int horAcc32(TIFF *tif, uint8_t *cp0, tmsize_t cc)
         return 0;
     }
 
+#ifdef PREDICTOR_USE_SSE2
+    if (stride == 1)
+    {
+        horAcc32Stride1SSE2(wp, wc);
+        return 1;
+    }
+#endif
+
     if (wc > stride)
     {
         wc -= stride;
@@ -525,17 +673,52 @@ static int fpAcc(TIFF *tif, uint8_t *cp0, tmsize_t cc)
     if (!tmp)
         return 0;
 
-    while (count > stride)
+#ifdef PREDICTOR_USE_SSE2
+    if (!horAcc8SSE2(cp, cc, stride))
+#endif
     {
-        REPEAT4(stride,
-                cp[stride] = (unsigned char)((cp[stride] + cp[0]) & 0xff);
-                cp++)
-        count -= stride;
+        while (count > stride)
+        {
+            REPEAT4(stride,
+                    cp[stride] = (unsigned char)((cp[stride] + cp[0]) & 0xff);
+                    cp++)
+            count -= stride;
+        }
     }
 
     _TIFFmemcpy(tmp, cp0, cc);
     cp = (uint8_t *)cp0;
-    for (count = 0; count < wc; count++)
+    count = 0;
+#ifdef PREDICTOR_USE_SSE2
+    if (bps == 4)
+    {
+        /* Interleave the planes of most significant to least significant
+         * bytes, 16 values at a time */
+        for (; count + 15 < wc; count += 16)
+        {
+            const __m128i b3 = _mm_loadu_si128((const __m128i *)(tmp + count));
+            const __m128i b2 =
+                _mm_loadu_si128((const __m128i *)(tmp + wc + count));
+            const __m128i b1 =
+                _mm_loadu_si128((const __m128i *)(tmp + 2 * wc + count));
+            const __m128i b0 =
+                _mm_loadu_si128((const __m128i *)(tmp + 3 * wc + count));
+            const __m128i b01lo = _mm_unpacklo_epi8(b0, b1);
+            const __m128i b01hi = _mm_unpackhi_epi8(b0, b1);
+            const __m128i b23lo = _mm_unpacklo_epi8(b2, b3);
+            const __m128i b23hi = _mm_unpackhi_epi8(b2, b3);
+            uint8_t *out = cp + 4 * count;
+            _mm_storeu_si128((__m128i *)out, _mm_unpacklo_epi16(b01lo, b23lo));
+            _mm_storeu_si128((__m128i *)(out + 16),
+                             _mm_unpackhi_epi16(b01lo, b23lo));
+            _mm_storeu_si128((__m128i *)(out + 32),
+                             _mm_unpacklo_epi16(b01hi, b23hi));
+            _mm_storeu_si128((__m128i *)(out + 48),
+                             _mm_unpackhi_epi16(b01hi, b23hi));
+        }
+    }
+#endif
+    for (; count < wc; count++)
     {
         uint32_t byte;
         for (byte = 0; byte < bps; byte++)
@@ -623,6 +806,14 @@ static int horDiff8(TIFF *tif, uint8_t *cp0, tmsize_t cc)
         return 0;
     }
 
+#ifdef PREDICTOR_USE_SSE2
+    if (cc > stride)
+    {
+        horDiff8SSE2(cp, cc, stride);
+        return 1;
+    }
+#endif
+
     if (cc > stride)
     {
         cc -= stride;
@@ -702,6 +893,14 @@ static int horDiff16(TIFF *tif, uint8_t *cp0, tmsize_t cc)
         return 0;
     }
 
+#ifdef PREDICTOR_USE_SSE2
+    if (wc > stride)
+    {
+        horDiff16SSE2(wp, wc, stride);
+        return 1;
+    }
+#endif
+
     if (wc > stride)
     {
         wc -= stride;
@@ -744,6 +943,14 @@ static int horDiff32(TIFF *tif, uint8_t *cp0, tmsize_t cc)
         return 0;
     }
 
+#ifdef PREDICTOR_USE_SSE2
+    if (wc > stride)
+    {
+        horDiff32SSE2(wp, wc, stride);
+        return 1;
+    }
+#endif
+
     if (wc > stride)
     {
         wc -= stride;
@@ -783,6 +990,14 @@ static int horDiff64(TIFF *tif, uint8_t *cp0, tmsize_t cc)
         return 0;
     }
 
+#ifdef PREDICTOR_USE_SSE2
+    if (wc > stride)
+    {
+        horDiff64SSE2(wp, wc, stride);
+        return 1;
+    }
+#endif
+
     if (wc > stride)
     {
         wc -= stride;
@@ -832,7 +1047,41 @@ static int fpDiff(TIFF *tif, uint8_t *cp0, tmsize_t cc)
         return 0;
 
     _TIFFmemcpy(tmp, cp0, cc);
-    for (count = 0; count < wc; count++)
+    count = 0;
+#ifdef PREDICTOR_USE_SSE2
+    if (bps == 4)
+    {
+        /* Split 16 values at a time into planes of most significant to
+         * least significant bytes */
+        const __m128i mask = _mm_set1_epi32(0xFF);
+        for (; count + 15 < wc; count += 16)
+        {
+            const uint8_t *in = tmp + 4 * count;
+            const __m128i v0 = _mm_loadu_si128((const __m128i *)in);
+            const __m128i v1 = _mm_loadu_si128((const __m128i *)(in + 16));
+            const __m128i v2 = _mm_loadu_si128((const __m128i *)(in + 32));
+            const __m128i v3 = _mm_loadu_si128((const __m128i *)(in + 48));
+#define FPDIFF_EXTRACT_BYTE(shift, plane)                                      \
+    do                                                                         \
+    {                                                                          \
+        const __m128i w01 = _mm_packs_epi32(                                   \
+            _mm_and_si128(_mm_srli_epi32(v0, shift), mask),                    \
+            _mm_and_si128(_mm_srli_epi32(v1, shift), mask));                   \
+        const __m128i w23 = _mm_packs_epi32(                                   \
+            _mm_and_si128(_mm_srli_epi32(v2, shift), mask),                    \
+            _mm_and_si128(_mm_srli_epi32(v3, shift), mask));                   \
+        _mm_storeu_si128((__m128i *)(cp + (plane)*wc + count),                 \
+                         _mm_packus_epi16(w01, w23));                          \
+    } while (0)
+            FPDIFF_EXTRACT_BYTE(0, 3);
+            FPDIFF_EXTRACT_BYTE(8, 2);
+            FPDIFF_EXTRACT_BYTE(16, 1);
+            FPDIFF_EXTRACT_BYTE(24, 0);
+#undef FPDIFF_EXTRACT_BYTE
+        }
+    }
+#endif
+    for (; count < wc; count++)
     {
         uint32_t byte;
         for (byte = 0; byte < bps; byte++)
@@ -847,6 +1096,13 @@ static int fpDiff(TIFF *tif, uint8_t *cp0, tmsize_t cc)
     _TIFFfreeExt(tif, tmp);
 
     cp = (uint8_t *)cp0;
+#ifdef PREDICTOR_USE_SSE2
+    if (cc > stride)
+    {
+        horDiff8SSE2(cp, cc, stride);
+        return 1;
+    }
+#endif
     cp += cc - stride - 1;
     for (count = cc; count > stride; count -= stride)
         REPEAT4(stride,
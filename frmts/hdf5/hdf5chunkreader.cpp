@@ -0,0 +1,522 @@
+/******************************************************************************
+ *
+ * Project:  Hierarchical Data Format Release 5 (HDF5)
+ * Purpose:  Direct (raw) chunk reading with parallel decompression.
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "hdf5chunkreader.h"
+
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+// Identifiers of the filters registered at
+// https://portal.hdfgroup.org/documentation/hdf5-docs/registered_filter_plugins.html
+constexpr H5Z_filter_t HDF5_FILTER_BLOSC = 32001;
+constexpr H5Z_filter_t HDF5_FILTER_ZSTD = 32015;
+
+// Maximum size in bytes of a decoded chunk
+constexpr size_t MAX_CHUNK_BYTES = 256 * 1024 * 1024;
+
+/************************************************************************/
+/*                       HDF5DirectChunkReader()                        */
+/************************************************************************/
+
+HDF5DirectChunkReader::HDF5DirectChunkReader(hid_t hDataset, GDALDataType eDT)
+    : m_hDataset(hDataset), m_oDT(GDALExtendedDataType::Create(eDT)),
+      m_nDTSize(GDALGetDataTypeSizeBytes(eDT))
+{
+}
+
+/************************************************************************/
+/*                               Create()                               */
+/************************************************************************/
+
+std::unique_ptr<HDF5DirectChunkReader>
+HDF5DirectChunkReader::Create(hid_t hDataset, hid_t hNativeDT,
+                              GDALDataType eDT)
+{
+#if defined(H5_VERSION_GE) && H5_VERSION_GE(1, 10, 5)
+    if (eDT == GDT_Unknown || GDALDataTypeIsComplex(eDT))
+        return nullptr;
+
+    // Only numeric types whose on-disk representation is the in-memory one
+    const H5T_class_t eClass = H5Tget_class(hNativeDT);
+    if ((eClass != H5T_INTEGER && eClass != H5T_FLOAT) ||
+        H5Tget_size(hNativeDT) !=
+            static_cast<size_t>(GDALGetDataTypeSizeBytes(eDT)))
+    {
+        return nullptr;
+    }
+    const hid_t hFileDT = H5Dget_type(hDataset);
+    const bool bSameType = H5Tequal(hFileDT, hNativeDT) > 0;
+    H5Tclose(hFileDT);
+    if (!bSameType)
+        return nullptr;
+
+    const hid_t hDataSpace = H5Dget_space(hDataset);
+    const int nDims = H5Sget_simple_extent_ndims(hDataSpace);
+    std::vector<hsize_t> anDims(std::max(nDims, 0));
+    if (nDims > 0)
+        H5Sget_simple_extent_dims(hDataSpace, anDims.data(), nullptr);
+    H5Sclose(hDataSpace);
+    if (nDims <= 0)
+        return nullptr;
+
+    const hid_t hPlist = H5Dget_create_plist(hDataset);
+    if (hPlist < 0)
+        return nullptr;
+
+    std::unique_ptr<HDF5DirectChunkReader> poReader;
+    if (H5Pget_layout(hPlist) == H5D_CHUNKED)
+    {
+        poReader.reset(new HDF5DirectChunkReader(hDataset, eDT));
+        poReader->m_anDims = std::move(anDims);
+        poReader->m_anChunkSize.resize(nDims);
+        if (H5Pget_chunk(hPlist, nDims, poReader->m_anChunkSize.data()) !=
+            nDims)
+        {
+            poReader.reset();
+        }
+    }
+
+    if (poReader)
+    {
+        size_t nChunkElts = 1;
+        poReader->m_anChunkStrides.resize(nDims);
+        for (int i = nDims - 1; i >= 0; --i)
+        {
+            const auto nChunkSize = poReader->m_anChunkSize[i];
+            if (nChunkSize == 0 || nChunkSize > MAX_CHUNK_BYTES / nChunkElts)
+            {
+                nChunkElts = 0;
+                break;
+            }
+            poReader->m_anChunkStrides[i] =
+                static_cast<GPtrDiff_t>(nChunkElts);
+            nChunkElts *= static_cast<size_t>(nChunkSize);
+        }
+        if (nChunkElts == 0 ||
+            nChunkElts > MAX_CHUNK_BYTES / poReader->m_nDTSize)
+            poReader.reset();
+        else
+            poReader->m_nChunkBytes = nChunkElts * poReader->m_nDTSize;
+    }
+
+    if (poReader)
+    {
+        const int nFilters = H5Pget_nfilters(hPlist);
+        for (int i = 0; poReader && i < nFilters; ++i)
+        {
+            char szName[120] = {};
+            size_t nCDElts = 20;
+            unsigned int anCDValues[20] = {};
+            unsigned int nFlags = 0;
+            Filter oFilter;
+            oFilter.nId = H5Pget_filter(hPlist, i, &nFlags, &nCDElts,
+                                        anCDValues, sizeof(szName), szName);
+            const char *pszDecompressor = nullptr;
+            if (oFilter.nId == H5Z_FILTER_DEFLATE)
+                pszDecompressor = "zlib";
+            else if (oFilter.nId == HDF5_FILTER_ZSTD)
+                pszDecompressor = "zstd";
+            else if (oFilter.nId == HDF5_FILTER_BLOSC)
+                pszDecompressor = "blosc";
+            else if (oFilter.nId != H5Z_FILTER_SHUFFLE)
+            {
+                CPLDebugOnly("HDF5",
+                             "Direct chunk reading not possible due to "
+                             "filter %d",
+                             static_cast<int>(oFilter.nId));
+                poReader.reset();
+                break;
+            }
+            if (pszDecompressor)
+            {
+                oFilter.psDecompressor = CPLGetDecompressor(pszDecompressor);
+                if (!oFilter.psDecompressor)
+                {
+                    CPLDebugOnly("HDF5", "Decompressor %s not available",
+                                 pszDecompressor);
+                    poReader.reset();
+                    break;
+                }
+            }
+            poReader->m_aoFilters.push_back(oFilter);
+        }
+        // Unfiltered datasets are better read through the libhdf5 pipeline
+        if (poReader && poReader->m_aoFilters.empty())
+            poReader.reset();
+    }
+
+    if (poReader)
+    {
+        poReader->m_abyFillValue.resize(poReader->m_nDTSize);
+        H5D_fill_value_t eStatus = H5D_FILL_VALUE_UNDEFINED;
+        if (H5Pfill_value_defined(hPlist, &eStatus) >= 0 &&
+            eStatus != H5D_FILL_VALUE_UNDEFINED &&
+            H5Pget_fill_value(hPlist, hNativeDT,
+                              poReader->m_abyFillValue.data()) < 0)
+        {
+            std::fill(poReader->m_abyFillValue.begin(),
+                      poReader->m_abyFillValue.end(), GByte(0));
+        }
+    }
+
+    H5Pclose(hPlist);
+    return poReader;
+#else
+    CPL_IGNORE_RET_VAL(hDataset);
+    CPL_IGNORE_RET_VAL(hNativeDT);
+    CPL_IGNORE_RET_VAL(eDT);
+    return nullptr;
+#endif
+}
+
+/************************************************************************/
+/*                           GetThreadCount()                           */
+/************************************************************************/
+
+int HDF5DirectChunkReader::GetThreadCount(const GUInt64 *arrayStartIdx,
+                                          const size_t *count) const
+{
+    if (!CPLTestBool(
+            CPLGetConfigOption("GDAL_HDF5_DIRECT_CHUNK_READ", "YES")))
+    {
+        return 0;
+    }
+
+    const char *pszNumThreads =
+        CPLGetConfigOption("GDAL_NUM_THREADS", "ALL_CPUS");
+    int nThreadsMax;
+    if (EQUAL(pszNumThreads, "ALL_CPUS"))
+        nThreadsMax = CPLGetNumCPUs();
+    else
+        nThreadsMax = std::max(1, atoi(pszNumThreads));
+    if (nThreadsMax > 1024)
+        nThreadsMax = 1024;
+    if (nThreadsMax <= 1)
+        return 0;
+
+    size_t nChunks = 1;
+    for (size_t i = 0; i < m_anDims.size(); ++i)
+    {
+        if (count[i] == 0)
+            return 0;
+        const GUInt64 nFirst = arrayStartIdx[i] / m_anChunkSize[i];
+        const GUInt64 nLast =
+            (arrayStartIdx[i] + count[i] - 1) / m_anChunkSize[i];
+        const auto nChunksThisDim = static_cast<size_t>(nLast - nFirst + 1);
+        if (nChunksThisDim > std::numeric_limits<size_t>::max() / nChunks)
+            return 0;
+        nChunks *= nChunksThisDim;
+    }
+    if (nChunks < 2)
+        return 0;
+    return static_cast<int>(
+        std::min(static_cast<size_t>(nThreadsMax), nChunks));
+}
+
+/************************************************************************/
+/*                            DecodeChunk()                             */
+/************************************************************************/
+
+/** Applies the filter pipeline in reverse order on abyRaw, which at the end
+ * contains the decoded chunk.
+ */
+bool HDF5DirectChunkReader::DecodeChunk(std::vector<GByte> &abyRaw,
+                                        unsigned nFilterMask,
+                                        std::vector<GByte> &abyTmp) const
+{
+    for (int i = static_cast<int>(m_aoFilters.size()) - 1; i >= 0; --i)
+    {
+        // Filters whose bit is set in the mask have been skipped for this
+        // chunk at writing time.
+        if (i < 32 && (nFilterMask & (1U << i)) != 0)
+            continue;
+
+        const auto &oFilter = m_aoFilters[i];
+        if (oFilter.nId == H5Z_FILTER_SHUFFLE)
+        {
+            const size_t nEltSize = m_nDTSize;
+            const size_t nElts = abyRaw.size() / nEltSize;
+            abyTmp.resize(abyRaw.size());
+            if (nEltSize == 1 || nElts <= 1)
+            {
+                memcpy(abyTmp.data(), abyRaw.data(), abyRaw.size());
+            }
+            else
+            {
+                for (size_t j = 0; j < nEltSize; ++j)
+                {
+                    const GByte *pabySrc = abyRaw.data() + j * nElts;
+                    GByte *pabyDst = abyTmp.data() + j;
+                    for (size_t k = 0; k < nElts; ++k)
+                    {
+                        *pabyDst = pabySrc[k];
+                        pabyDst += nEltSize;
+                    }
+                }
+                // Trailing bytes are left untouched by the shuffle filter
+                const size_t nShuffled = nElts * nEltSize;
+                memcpy(abyTmp.data() + nShuffled, abyRaw.data() + nShuffled,
+                       abyRaw.size() - nShuffled);
+            }
+        }
+        else
+        {
+            abyTmp.resize(m_nChunkBytes);
+            void *pOutBuffer = abyTmp.data();
+            size_t nOutSize = abyTmp.size();
+            if (!oFilter.psDecompressor->pfnFunc(
+                    abyRaw.data(), abyRaw.size(), &pOutBuffer, &nOutSize,
+                    nullptr, oFilter.psDecompressor->user_data))
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Decompression of HDF5 chunk with %s failed",
+                         oFilter.psDecompressor->pszId);
+                return false;
+            }
+            abyTmp.resize(nOutSize);
+        }
+        std::swap(abyRaw, abyTmp);
+    }
+
+    if (abyRaw.size() != m_nChunkBytes)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Decoded HDF5 chunk has %" PRIu64 " bytes, whereas %" PRIu64
+                 " were expected",
+                 static_cast<uint64_t>(abyRaw.size()),
+                 static_cast<uint64_t>(m_nChunkBytes));
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                               Read()                                 */
+/************************************************************************/
+
+namespace
+{
+struct ReadContext
+{
+    const GUInt64 *arrayStartIdx = nullptr;
+    const size_t *count = nullptr;
+    const GPtrDiff_t *bufferStride = nullptr;
+    const GDALExtendedDataType *pBufferDataType = nullptr;
+    GByte *pabyDstBuffer = nullptr;
+    std::atomic<bool> bSuccess{true};
+};
+
+struct ChunkJob
+{
+    const HDF5DirectChunkReader *poReader = nullptr;
+    ReadContext *psContext = nullptr;
+    std::vector<hsize_t> anChunkOffset{};
+    std::vector<GByte> abyRaw{};
+    unsigned nFilterMask = 0;
+    bool bMissing = false;
+};
+}  // namespace
+
+/* static */ void HDF5DirectChunkReader::DecodeJob(void *pData)
+{
+    auto psJob = static_cast<ChunkJob *>(pData);
+    const auto poReader = psJob->poReader;
+    auto psContext = psJob->psContext;
+
+    std::vector<GByte> abyRaw;
+    std::swap(abyRaw, psJob->abyRaw);
+    if (!psContext->bSuccess)
+        return;
+
+    std::vector<GByte> abyTmp;
+    if (!psJob->bMissing &&
+        !poReader->DecodeChunk(abyRaw, psJob->nFilterMask, abyTmp))
+    {
+        psContext->bSuccess = false;
+        return;
+    }
+
+    // Copy the intersection of the chunk with the request
+    const size_t nDims = poReader->m_anDims.size();
+    std::vector<size_t> anCount(nDims);
+    std::vector<GPtrDiff_t> anSrcStrides(nDims);
+    const GByte *pabySrc =
+        psJob->bMissing ? poReader->m_abyFillValue.data() : abyRaw.data();
+    GByte *pabyDst = psContext->pabyDstBuffer;
+    const size_t nBufferDTSize = psContext->pBufferDataType->GetSize();
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        const GUInt64 nChunkStart = psJob->anChunkOffset[i];
+        const GUInt64 nReqStart = psContext->arrayStartIdx[i];
+        const GUInt64 nStart = std::max(nChunkStart, nReqStart);
+        const GUInt64 nEnd = std::min(
+            nChunkStart + static_cast<GUInt64>(poReader->m_anChunkSize[i]),
+            nReqStart + static_cast<GUInt64>(psContext->count[i]));
+        anCount[i] = static_cast<size_t>(nEnd - nStart);
+        if (!psJob->bMissing)
+        {
+            anSrcStrides[i] = poReader->m_anChunkStrides[i];
+            pabySrc += static_cast<size_t>(nStart - nChunkStart) *
+                       poReader->m_anChunkStrides[i] * poReader->m_nDTSize;
+        }
+        pabyDst += static_cast<GPtrDiff_t>(nStart - nReqStart) *
+                   psContext->bufferStride[i] *
+                   static_cast<GPtrDiff_t>(nBufferDTSize);
+    }
+    if (!GDALExtendedDataType::CopyValues(
+            nDims, anCount.data(), pabySrc, poReader->m_oDT,
+            anSrcStrides.data(), pabyDst, *(psContext->pBufferDataType),
+            psContext->bufferStride))
+    {
+        psContext->bSuccess = false;
+    }
+}
+
+bool HDF5DirectChunkReader::Read(const GUInt64 *arrayStartIdx,
+                                 const size_t *count,
+                                 const GPtrDiff_t *bufferStride,
+                                 const GDALExtendedDataType &bufferDataType,
+                                 void *pDstBuffer) const
+{
+#if defined(H5_VERSION_GE) && H5_VERSION_GE(1, 10, 5)
+    const int nThreads = GetThreadCount(arrayStartIdx, count);
+    if (nThreads == 0)
+        return false;
+    CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(nThreads);
+    if (!poPool)
+        return false;
+    auto poQueue = poPool->CreateJobQueue();
+
+    const size_t nDims = m_anDims.size();
+    std::vector<GUInt64> anFirstChunk(nDims);
+    std::vector<GUInt64> anLastChunk(nDims);
+    size_t nChunks = 1;
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        anFirstChunk[i] = arrayStartIdx[i] / m_anChunkSize[i];
+        anLastChunk[i] = (arrayStartIdx[i] + count[i] - 1) / m_anChunkSize[i];
+        nChunks *= static_cast<size_t>(anLastChunk[i] - anFirstChunk[i] + 1);
+    }
+
+    ReadContext sContext;
+    sContext.arrayStartIdx = arrayStartIdx;
+    sContext.count = count;
+    sContext.bufferStride = bufferStride;
+    sContext.pBufferDataType = &bufferDataType;
+    sContext.pabyDstBuffer = static_cast<GByte *>(pDstBuffer);
+
+    // Raw chunks are read sequentially in this thread, since libhdf5 calls
+    // are serialized anyway, while previously read chunks are decoded in
+    // worker threads. Bound the number of chunks in flight to limit memory
+    // usage.
+    const int nMaxJobsInFlight = 2 * nThreads;
+    std::vector<ChunkJob> asJobs(nChunks);
+    std::vector<GUInt64> anChunkIdx(anFirstChunk);
+    for (size_t iChunk = 0; iChunk < nChunks && sContext.bSuccess; ++iChunk)
+    {
+        auto &sJob = asJobs[iChunk];
+        sJob.poReader = this;
+        sJob.psContext = &sContext;
+        sJob.anChunkOffset.resize(nDims);
+        for (size_t i = 0; i < nDims; ++i)
+            sJob.anChunkOffset[i] =
+                static_cast<hsize_t>(anChunkIdx[i] * m_anChunkSize[i]);
+
+        haddr_t nAddr = HADDR_UNDEF;
+        hsize_t nSize = 0;
+        if (H5Dget_chunk_info_by_coord(m_hDataset, sJob.anChunkOffset.data(),
+                                       &sJob.nFilterMask, &nAddr, &nSize) < 0)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "H5Dget_chunk_info_by_coord() failed");
+            sContext.bSuccess = false;
+            break;
+        }
+        if (nAddr == HADDR_UNDEF)
+        {
+            sJob.bMissing = true;
+        }
+        else
+        {
+            if (nSize > std::numeric_limits<size_t>::max())
+            {
+                sContext.bSuccess = false;
+                break;
+            }
+            try
+            {
+                sJob.abyRaw.resize(static_cast<size_t>(nSize));
+            }
+            catch (const std::exception &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Out of memory allocating HDF5 chunk buffer");
+                sContext.bSuccess = false;
+                break;
+            }
+            uint32_t nFilterMask = 0;
+            if (H5Dread_chunk(m_hDataset, H5P_DEFAULT,
+                              sJob.anChunkOffset.data(), &nFilterMask,
+                              sJob.abyRaw.data()) < 0)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "H5Dread_chunk() failed");
+                sContext.bSuccess = false;
+                break;
+            }
+            sJob.nFilterMask = nFilterMask;
+        }
+
+        poQueue->SubmitJob(DecodeJob, &sJob);
+        poQueue->WaitCompletion(nMaxJobsInFlight);
+
+        // Advance to the next chunk, last dimension varying fastest
+        for (size_t i = nDims; i > 0;)
+        {
+            --i;
+            if (++anChunkIdx[i] <= anLastChunk[i])
+                break;
+            anChunkIdx[i] = anFirstChunk[i];
+        }
+    }
+    poQueue->WaitCompletion();
+
+    return sContext.bSuccess;
+#else
+    CPL_IGNORE_RET_VAL(arrayStartIdx);
+    CPL_IGNORE_RET_VAL(count);
+    CPL_IGNORE_RET_VAL(bufferStride);
+    CPL_IGNORE_RET_VAL(bufferDataType);
+    CPL_IGNORE_RET_VAL(pDstBuffer);
+    return false;
+#endif
+}
@@ -0,0 +1,110 @@
+/******************************************************************************
+ *
+ * Project:  Hierarchical Data Format Release 5 (HDF5)
+ * Purpose:  Direct (raw) chunk reading with parallel decompression.
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef HDF5CHUNKREADER_H
+#define HDF5CHUNKREADER_H
+
+#include "hdf5_api.h"
+
+#include "cpl_compressor.h"
+#include "gdal_priv.h"
+
+#include <memory>
+#include <vector>
+
+/************************************************************************/
+/*                        HDF5DirectChunkReader                         */
+/************************************************************************/
+
+/** Reads chunks of a chunked dataset with H5Dread_chunk(), that is bypassing
+ * the libhdf5 filter pipeline, and decompresses them in parallel in worker
+ * threads of the GDAL global thread pool.
+ *
+ * Only datasets of a numeric type in native byte order whose filter pipeline
+ * is made of shuffle, deflate, zstd or blosc are handled.
+ */
+class HDF5DirectChunkReader
+{
+    struct Filter
+    {
+        H5Z_filter_t nId = 0;
+        const CPLCompressor *psDecompressor = nullptr;
+    };
+
+    hid_t m_hDataset;
+    GDALExtendedDataType m_oDT;
+    size_t m_nDTSize;
+    std::vector<hsize_t> m_anDims{};
+    std::vector<hsize_t> m_anChunkSize{};
+    std::vector<GPtrDiff_t> m_anChunkStrides{};
+    size_t m_nChunkBytes = 0;
+    std::vector<Filter> m_aoFilters{};
+    std::vector<GByte> m_abyFillValue{};
+
+    HDF5DirectChunkReader(hid_t hDataset, GDALDataType eDT);
+
+    HDF5DirectChunkReader(const HDF5DirectChunkReader &) = delete;
+    HDF5DirectChunkReader &operator=(const HDF5DirectChunkReader &) = delete;
+
+    static void DecodeJob(void *pData);
+    bool DecodeChunk(std::vector<GByte> &abyRaw, unsigned nFilterMask,
+                     std::vector<GByte> &abyTmp) const;
+
+  public:
+    /** Returns a reader if hDataset is eligible, or nullptr otherwise.
+     * hDataset must remain valid for the lifetime of the returned object.
+     * Must be called with the HDF5 global lock held.
+     */
+    static std::unique_ptr<HDF5DirectChunkReader>
+    Create(hid_t hDataset, hid_t hNativeDT, GDALDataType eDT);
+
+    /** Data type of the dataset */
+    const GDALExtendedDataType &GetDataType() const
+    {
+        return m_oDT;
+    }
+
+    /** Returns the number of threads that would be used to read the
+     * hyperslab [arrayStartIdx, arrayStartIdx + count[, or 0 if the direct
+     * chunk read path is not worth using (less than 2 chunks intersected,
+     * GDAL_NUM_THREADS <= 1 or GDAL_HDF5_DIRECT_CHUNK_READ=NO).
+     */
+    int GetThreadCount(const GUInt64 *arrayStartIdx, const size_t *count) const;
+
+    /** Reads the hyperslab [arrayStartIdx, arrayStartIdx + count[ (with a
+     * step of 1) into pDstBuffer, whose strides are expressed in number of
+     * elements, converting values to bufferDataType.
+     * Must be called with the HDF5 global lock held.
+     */
+    bool Read(const GUInt64 *arrayStartIdx, const size_t *count,
+              const GPtrDiff_t *bufferStride,
+              const GDALExtendedDataType &bufferDataType,
+              void *pDstBuffer) const;
+};
+
+#endif  // HDF5CHUNKREADER_H
@@ -34,6 +34,7 @@
 #include "gdal_pam.h"
 #include "gdal_priv.h"
 #include "gh5_convenience.h"
+#include "hdf5chunkreader.h"
 #include "hdf5dataset.h"
 #include "hdf5drivercore.h"
 #include "ogr_spatialref.h"
@@ -83,9 +84,15 @@ class HDF5ImageDataset final : public HDF5Dataset
     int m_nXIndex = -1;
     int m_nYIndex = -1;
     int m_nOtherDimIndex = -1;
+    std::unique_ptr<HDF5DirectChunkReader> m_poDirectChunkReader{};
 
     CPLErr CreateODIMH5Projection();
 
+    bool CanUseDirectChunkRead(const H5OFFSET_TYPE *offset,
+                               const hsize_t *count) const;
+    CPLErr DirectChunkRead(const H5OFFSET_TYPE *offset, const hsize_t *count,
+                           void *pData) const;
+
   public:
     HDF5ImageDataset();
     virtual ~HDF5ImageDataset();
@@ -438,6 +445,9 @@ CPLErr HDF5ImageRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
             offset[0] = offset[1];
             offset[1] = offset[2];
         }
+        if (poGDS->CanUseDirectChunkRead(offset, count))
+            return poGDS->DirectChunkRead(offset, count, pData);
+
         herr_t status = H5Sselect_hyperslab(poGDS->dataspace_id, H5S_SELECT_SET,
                                             offset, nullptr, count, nullptr);
         if (status < 0)
@@ -545,6 +555,9 @@ CPLErr HDF5ImageDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
             static_cast<H5OFFSET_TYPE>(panBandMap[0] - 1),
             static_cast<H5OFFSET_TYPE>(nYOff),
             static_cast<H5OFFSET_TYPE>(nXOff)};
+        if (CanUseDirectChunkRead(offset, count))
+            return DirectChunkRead(offset, count, pData);
+
         herr_t status = H5Sselect_hyperslab(dataspace_id, H5S_SELECT_SET,
                                             offset, nullptr, count, nullptr);
         if (status < 0)
@@ -594,6 +607,9 @@ CPLErr HDF5ImageDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
             static_cast<H5OFFSET_TYPE>(nYOff),
             static_cast<H5OFFSET_TYPE>(nXOff),
             static_cast<H5OFFSET_TYPE>(panBandMap[0] - 1)};
+        if (CanUseDirectChunkRead(offset, count))
+            return DirectChunkRead(offset, count, pData);
+
         herr_t status = H5Sselect_hyperslab(dataspace_id, H5S_SELECT_SET,
                                             offset, nullptr, count, nullptr);
         if (status < 0)
@@ -673,6 +689,55 @@ CPLErr HDF5ImageDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                                   nBandSpace, psExtraArg);
 }
 
+/************************************************************************/
+/*                       CanUseDirectChunkRead()                        */
+/************************************************************************/
+
+bool HDF5ImageDataset::CanUseDirectChunkRead(const H5OFFSET_TYPE *offset,
+                                             const hsize_t *count) const
+{
+    if (!m_poDirectChunkReader)
+        return false;
+    GUInt64 anStartIdx[3] = {0, 0, 0};
+    size_t anCount[3] = {0, 0, 0};
+    for (int i = 0; i < ndims; ++i)
+    {
+        anStartIdx[i] = static_cast<GUInt64>(offset[i]);
+        anCount[i] = static_cast<size_t>(count[i]);
+    }
+    return m_poDirectChunkReader->GetThreadCount(anStartIdx, anCount) > 0;
+}
+
+/************************************************************************/
+/*                          DirectChunkRead()                           */
+/************************************************************************/
+
+/** Reads the hyperslab (offset, count) into pData, in the natural
+ * interleaving of the HDF5 dataset and with its data type, with parallel
+ * decompression of chunks.
+ */
+CPLErr HDF5ImageDataset::DirectChunkRead(const H5OFFSET_TYPE *offset,
+                                         const hsize_t *count,
+                                         void *pData) const
+{
+    GUInt64 anStartIdx[3] = {0, 0, 0};
+    size_t anCount[3] = {0, 0, 0};
+    GPtrDiff_t anStrides[3] = {0, 0, 0};
+    GPtrDiff_t nStride = 1;
+    for (int i = ndims - 1; i >= 0; --i)
+    {
+        anStartIdx[i] = static_cast<GUInt64>(offset[i]);
+        anCount[i] = static_cast<size_t>(count[i]);
+        anStrides[i] = nStride;
+        nStride *= static_cast<GPtrDiff_t>(count[i]);
+    }
+    return m_poDirectChunkReader->Read(anStartIdx, anCount, anStrides,
+                                       m_poDirectChunkReader->GetDataType(),
+                                       pData)
+               ? CE_None
+               : CE_Failure;
+}
+
 /************************************************************************/
 /*                                Open()                                */
 /************************************************************************/
@@ -778,6 +843,8 @@ GDALDataset *HDF5ImageDataset::Open(GDALOpenInfo *poOpenInfo)
     poDS->datatype = H5Dget_type(poDS->dataset_id);
     poDS->size = H5Tget_size(poDS->datatype);
     poDS->native = H5Tget_native_type(poDS->datatype, H5T_DIR_ASCEND);
+    poDS->m_poDirectChunkReader = HDF5DirectChunkReader::Create(
+        poDS->dataset_id, poDS->native, poDS->GetDataType(poDS->native));
 
     // CSK code in IdentifyProductType() and CreateProjections()
     // uses dataset metadata.
@@ -25,6 +25,7 @@
  * DEALINGS IN THE SOFTWARE.
  ****************************************************************************/
 
+#include "hdf5chunkreader.h"
 #include "hdf5dataset.h"
 #include "hdf5eosparser.h"
 #include "s100.h"
@@ -292,6 +293,7 @@ class HDF5Array final : public GDALMDArray
     mutable bool m_bHasDimensionLabels = false;
     std::shared_ptr<OGRSpatialReference> m_poSRS{};
     haddr_t m_nOffset;
+    std::unique_ptr<HDF5DirectChunkReader> m_poDirectChunkReader{};
 
     HDF5Array(const std::string &osParentName, const std::string &osName,
               const std::shared_ptr<HDF5SharedResources> &poShared,
@@ -984,6 +986,12 @@ HDF5Array::HDF5Array(const std::string &osParentName, const std::string &osName,
         return;
     }
 
+    if (m_dt.GetClass() == GEDTC_NUMERIC)
+    {
+        m_poDirectChunkReader = HDF5DirectChunkReader::Create(
+            m_hArray, m_hNativeDT, m_dt.GetNumericDataType());
+    }
+
     HDF5Array::GetAttributes();
 
     // Special case for S102 nodata value that is typically at 1e6
@@ -2403,6 +2411,17 @@ bool HDF5Array::IRead(const GUInt64 *arrayStartIdx, const size_t *count,
         nEltCount *= count[i];
     }
 
+    // Requests spanning several chunks of a compressed dataset are read by
+    // decompressing the raw chunks in parallel
+    if (m_poDirectChunkReader && bufferDataType.GetClass() == GEDTC_NUMERIC &&
+        std::all_of(anStep.begin(), anStep.end(),
+                    [](hsize_t nStep) { return nStep == 1; }) &&
+        m_poDirectChunkReader->GetThreadCount(arrayStartIdx, count) > 0)
+    {
+        return m_poDirectChunkReader->Read(arrayStartIdx, count, bufferStride,
+                                           bufferDataType, pDstBuffer);
+    }
+
     if (IsTransposedRequest(count, bufferStride))
     {
         return ReadForTransposedRequest(arrayStartIdx, count, arrayStep,
@@ -206,6 +206,9 @@ class HFABand
     HFABand **papoOverviews;
 
     CPLErr GetRasterBlock(int nXBlock, int nYBlock, void *pData, int nDataSize);
+    CPLErr GetRasterBlocks(int nBlockCount, const int *panXBlock,
+                           const int *panYBlock, void **papData,
+                           int nDataSize);
     CPLErr SetRasterBlock(int nXBlock, int nYBlock, void *pData);
 
     const char *GetBandName();
@@ -39,6 +39,7 @@
 #include <fcntl.h>
 #endif
 #include <algorithm>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -46,6 +47,7 @@
 #include "cpl_vsi.h"
 #include "hfa.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 /************************************************************************/
 /*                              HFABand()                               */
@@ -1176,6 +1178,45 @@ void HFABand::NullBlock(void *pData)
     }
 }
 
+/************************************************************************/
+/*                           ByteSwapBlock()                            */
+/************************************************************************/
+
+static void ByteSwapBlock(void *pData, EPTType eDataType, int nPixels)
+{
+#ifdef CPL_MSB
+    if (HFAGetDataTypeBits(eDataType) == 16)
+    {
+        for (int ii = 0; ii < nPixels; ii++)
+            CPL_SWAP16PTR(((unsigned char *)pData) + ii * 2);
+    }
+    else if (HFAGetDataTypeBits(eDataType) == 32)
+    {
+        for (int ii = 0; ii < nPixels; ii++)
+            CPL_SWAP32PTR(((unsigned char *)pData) + ii * 4);
+    }
+    else if (eDataType == EPT_f64)
+    {
+        for (int ii = 0; ii < nPixels; ii++)
+            CPL_SWAP64PTR(((unsigned char *)pData) + ii * 8);
+    }
+    else if (eDataType == EPT_c64)
+    {
+        for (int ii = 0; ii < nPixels * 2; ii++)
+            CPL_SWAP32PTR(((unsigned char *)pData) + ii * 4);
+    }
+    else if (eDataType == EPT_c128)
+    {
+        for (int ii = 0; ii < nPixels * 2; ii++)
+            CPL_SWAP64PTR(((unsigned char *)pData) + ii * 8);
+    }
+#else
+    CPL_IGNORE_RET_VAL(pData);
+    CPL_IGNORE_RET_VAL(eDataType);
+    CPL_IGNORE_RET_VAL(nPixels);
+#endif  // def CPL_MSB
+}
+
 /************************************************************************/
 /*                           GetRasterBlock()                           */
 /************************************************************************/
@@ -1308,34 +1349,219 @@ CPLErr HFABand::GetRasterBlock(int nXBlock, int nYBlock, void *pData,
     // Byte swap to local byte order if required.  It appears that
     // raster data is always stored in Intel byte order in Imagine
     // files.
+    ByteSwapBlock(pData, eDataType, nBlockXSize * nBlockYSize);
 
-#ifdef CPL_MSB
-    if (HFAGetDataTypeBits(eDataType) == 16)
+    return CE_None;
+}
+
+/************************************************************************/
+/*                          DecodeBlockJob()                            */
+/************************************************************************/
+
+namespace
+{
+struct HFADecodeBlockJob
+{
+    const GByte *pabySrc = nullptr;
+    int nSrcBytes = 0;
+    bool bCompressed = false;
+    void *pDest = nullptr;
+    int nPixels = 0;
+    EPTType eDataType = EPT_u8;
+    CPLErr eErr = CE_None;
+};
+}  // namespace
+
+static void DecodeBlockJob(void *pData)
+{
+    auto psJob = static_cast<HFADecodeBlockJob *>(pData);
+    if (psJob->bCompressed)
     {
-        for (int ii = 0; ii < nBlockXSize * nBlockYSize; ii++)
-            CPL_SWAP16PTR(((unsigned char *)pData) + ii * 2);
+        psJob->eErr = UncompressBlock(
+            const_cast<GByte *>(psJob->pabySrc), psJob->nSrcBytes,
+            static_cast<GByte *>(psJob->pDest), psJob->nPixels,
+            psJob->eDataType);
     }
-    else if (HFAGetDataTypeBits(eDataType) == 32)
+    else
     {
-        for (int ii = 0; ii < nBlockXSize * nBlockYSize; ii++)
-            CPL_SWAP32PTR(((unsigned char *)pData) + ii * 4);
+        memcpy(psJob->pDest, psJob->pabySrc, psJob->nSrcBytes);
+        ByteSwapBlock(psJob->pDest, psJob->eDataType, psJob->nPixels);
     }
-    else if (eDataType == EPT_f64)
+}
+
+/************************************************************************/
+/*                          GetRasterBlocks()                           */
+/*                                                                      */
+/*      Read several blocks at once. Blocks stored contiguously in      */
+/*      the file are fetched with a single read, and the decoding of    */
+/*      compressed blocks is spread over GDAL_NUM_THREADS threads.      */
+/*      Blocks for which that fast path is not possible are read        */
+/*      with GetRasterBlock().                                          */
+/************************************************************************/
+
+CPLErr HFABand::GetRasterBlocks(int nBlockCount, const int *panXBlock,
+                                const int *panYBlock, void **papData,
+                                int nDataSize)
+
+{
+    if (LoadBlockInfo() != CE_None)
+        return CE_Failure;
+
+    if (fpExternal)
     {
-        for (int ii = 0; ii < nBlockXSize * nBlockYSize; ii++)
-            CPL_SWAP64PTR(((unsigned char *)pData) + ii * 8);
+        for (int i = 0; i < nBlockCount; i++)
+        {
+            if (GetRasterBlock(panXBlock[i], panYBlock[i], papData[i],
+                               nDataSize) != CE_None)
+                return CE_Failure;
+        }
+        return CE_None;
     }
-    else if (eDataType == EPT_c64)
+
+    // Sort valid blocks by increasing file offset.
+    std::vector<int> anOrder;
+    for (int i = 0; i < nBlockCount; i++)
     {
-        for (int ii = 0; ii < nBlockXSize * nBlockYSize * 2; ii++)
-            CPL_SWAP32PTR(((unsigned char *)pData) + ii * 4);
+        const int iBlock = panXBlock[i] + panYBlock[i] * nBlocksPerRow;
+        if ((panBlockFlag[iBlock] & BFLG_VALID) == 0)
+            NullBlock(papData[i]);
+        else
+            anOrder.push_back(i);
+    }
+    const auto GetBlockIdx = [this, panXBlock, panYBlock](int i)
+    { return panXBlock[i] + panYBlock[i] * nBlocksPerRow; };
+    std::sort(anOrder.begin(), anOrder.end(),
+              [this, &GetBlockIdx](int a, int b) {
+                  return panBlockStart[GetBlockIdx(a)] <
+                         panBlockStart[GetBlockIdx(b)];
+              });
+
+    // Group blocks that are stored next to each other into runs that
+    // are read at once.
+    constexpr vsi_l_offset MAX_RUN_SIZE = 16 * 1024 * 1024;
+    std::vector<std::vector<GByte>> aabyRuns;
+    std::vector<HFADecodeBlockJob> asJobs;
+    asJobs.reserve(anOrder.size());
+    std::vector<size_t> anJobRun;
+    std::vector<size_t> anJobOffsetInRun;
+    size_t i = 0;
+    while (i < anOrder.size())
+    {
+        const vsi_l_offset nRunStart = panBlockStart[GetBlockIdx(anOrder[i])];
+        vsi_l_offset nRunEnd = nRunStart;
+        size_t j = i;
+        for (; j < anOrder.size(); j++)
+        {
+            const int iBlock = GetBlockIdx(anOrder[j]);
+            const bool bCompressed =
+                (panBlockFlag[iBlock] & BFLG_COMPRESSED) != 0;
+            if (panBlockStart[iBlock] != nRunEnd ||
+                panBlockSize[iBlock] <= 0 ||
+                (!bCompressed && (nDataSize == -1 ||
+                                  panBlockSize[iBlock] > nDataSize)) ||
+                (j > i && nRunEnd - nRunStart + panBlockSize[iBlock] >
+                              MAX_RUN_SIZE))
+            {
+                break;
+            }
+            nRunEnd += panBlockSize[iBlock];
+        }
+
+        if (j == i)
+        {
+            // Block not eligible to the fast path: let GetRasterBlock()
+            // do its job, including error reporting.
+            const int k = anOrder[i];
+            if (GetRasterBlock(panXBlock[k], panYBlock[k], papData[k],
+                               nDataSize) != CE_None)
+                return CE_Failure;
+            i++;
+            continue;
+        }
+
+        std::vector<GByte> abyRun;
+        try
+        {
+            abyRun.resize(static_cast<size_t>(nRunEnd - nRunStart));
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate " CPL_FRMT_GUIB " bytes",
+                     static_cast<GUIntBig>(nRunEnd - nRunStart));
+            return CE_Failure;
+        }
+        if (VSIFSeekL(psInfo->fp, nRunStart, SEEK_SET) != 0 ||
+            VSIFReadL(abyRun.data(), abyRun.size(), 1, psInfo->fp) != 1)
+        {
+            // Fallback to block per block reading to get the same
+            // behavior as GetRasterBlock() on truncated files.
+            for (; i < j; i++)
+            {
+                const int k = anOrder[i];
+                if (GetRasterBlock(panXBlock[k], panYBlock[k], papData[k],
+                                   nDataSize) != CE_None)
+                    return CE_Failure;
+            }
+            continue;
+        }
+
+        for (; i < j; i++)
+        {
+            const int k = anOrder[i];
+            const int iBlock = GetBlockIdx(k);
+            HFADecodeBlockJob sJob;
+            sJob.nSrcBytes = panBlockSize[iBlock];
+            sJob.bCompressed = (panBlockFlag[iBlock] & BFLG_COMPRESSED) != 0;
+            sJob.pDest = papData[k];
+            sJob.nPixels = nBlockXSize * nBlockYSize;
+            sJob.eDataType = eDataType;
+            asJobs.push_back(sJob);
+            anJobRun.push_back(aabyRuns.size());
+            anJobOffsetInRun.push_back(
+                static_cast<size_t>(panBlockStart[iBlock] - nRunStart));
+        }
+        aabyRuns.push_back(std::move(abyRun));
     }
-    else if (eDataType == EPT_c128)
+
+    // Source pointers can only be set once all runs have been read,
+    // since aabyRuns may have been reallocated in the meantime.
+    for (size_t iJob = 0; iJob < asJobs.size(); iJob++)
     {
-        for (int ii = 0; ii < nBlockXSize * nBlockYSize * 2; ii++)
-            CPL_SWAP64PTR(((unsigned char *)pData) + ii * 8);
+        asJobs[iJob].pabySrc =
+            aabyRuns[anJobRun[iJob]].data() + anJobOffsetInRun[iJob];
+    }
+
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    int nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+    nThreads = std::max(1, std::min(nThreads, 128));
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 && asJobs.size() > 1 ? GDALGetGlobalThreadPool(nThreads)
+                                          : nullptr;
+    if (poPool)
+    {
+        auto poQueue = poPool->CreateJobQueue();
+        for (auto &sJob : asJobs)
+        {
+            if (!poQueue->SubmitJob(DecodeBlockJob, &sJob))
+            {
+                DecodeBlockJob(&sJob);
+            }
+        }
+        poQueue->WaitCompletion();
+    }
+    else
+    {
+        for (auto &sJob : asJobs)
+            DecodeBlockJob(&sJob);
+    }
+
+    for (const auto &sJob : asJobs)
+    {
+        if (sJob.eErr != CE_None)
+            return CE_Failure;
     }
-#endif  // def CPL_MSB
 
     return CE_None;
 }
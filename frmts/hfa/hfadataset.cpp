@@ -2308,24 +2308,15 @@ GDALRasterBand *HFARasterBand::GetOverview(int i)
 }
 
 /************************************************************************/
-/*                             IReadBlock()                             */
+/*                         UnpackSubByteData()                          */
+/*                                                                      */
+/*      Expand in place 1, 2 and 4 bit data to one byte per pixel.      */
 /************************************************************************/
 
-CPLErr HFARasterBand::IReadBlock(int nBlockXOff, int nBlockYOff, void *pImage)
+void HFARasterBand::UnpackSubByteData(void *pImage)
 
 {
-    CPLErr eErr = CE_None;
-
-    if (nThisOverview == -1)
-        eErr = HFAGetRasterBlockEx(hHFA, nBand, nBlockXOff, nBlockYOff, pImage,
-                                   nBlockXSize * nBlockYSize *
-                                       GDALGetDataTypeSizeBytes(eDataType));
-    else
-        eErr = HFAGetOverviewRasterBlockEx(
-            hHFA, nBand, nThisOverview, nBlockXOff, nBlockYOff, pImage,
-            nBlockXSize * nBlockYSize * GDALGetDataTypeSizeBytes(eDataType));
-
-    if (eErr == CE_None && eHFADataType == EPT_u4)
+    if (eHFADataType == EPT_u4)
     {
         GByte *pabyData = static_cast<GByte *>(pImage);
 
@@ -2336,7 +2327,7 @@ CPLErr HFARasterBand::IReadBlock(int nBlockXOff, int nBlockYOff, void *pImage)
             pabyData[ii] = (pabyData[k]) & 0xf;
         }
     }
-    if (eErr == CE_None && eHFADataType == EPT_u2)
+    else if (eHFADataType == EPT_u2)
     {
         GByte *pabyData = static_cast<GByte *>(pImage);
 
@@ -2349,7 +2340,7 @@ CPLErr HFARasterBand::IReadBlock(int nBlockXOff, int nBlockYOff, void *pImage)
             pabyData[ii] = (pabyData[k]) & 0x3;
         }
     }
-    if (eErr == CE_None && eHFADataType == EPT_u1)
+    else if (eHFADataType == EPT_u1)
     {
         GByte *pabyData = static_cast<GByte *>(pImage);
 
@@ -2361,10 +2352,159 @@ CPLErr HFARasterBand::IReadBlock(int nBlockXOff, int nBlockYOff, void *pImage)
                 pabyData[ii] = 0;
         }
     }
+}
+
+/************************************************************************/
+/*                             IReadBlock()                             */
+/************************************************************************/
+
+CPLErr HFARasterBand::IReadBlock(int nBlockXOff, int nBlockYOff, void *pImage)
+
+{
+    CPLErr eErr = CE_None;
+
+    if (nThisOverview == -1)
+        eErr = HFAGetRasterBlockEx(hHFA, nBand, nBlockXOff, nBlockYOff, pImage,
+                                   nBlockXSize * nBlockYSize *
+                                       GDALGetDataTypeSizeBytes(eDataType));
+    else
+        eErr = HFAGetOverviewRasterBlockEx(
+            hHFA, nBand, nThisOverview, nBlockXOff, nBlockYOff, pImage,
+            nBlockXSize * nBlockYSize * GDALGetDataTypeSizeBytes(eDataType));
+
+    if (eErr == CE_None)
+        UnpackSubByteData(pImage);
 
     return eErr;
 }
 
+/************************************************************************/
+/*                           PreloadBlocks()                            */
+/*                                                                      */
+/*      Load in the block cache the blocks intersecting a window,       */
+/*      so that blocks stored contiguously in the file are read at      */
+/*      once and compressed blocks are decoded in parallel.             */
+/************************************************************************/
+
+void HFARasterBand::PreloadBlocks(int nXOff, int nYOff, int nXSize,
+                                  int nYSize)
+
+{
+    if (hHFA->eAccess != HFA_ReadOnly)
+        return;
+
+    HFABand *poBand = hHFA->papoBand[nBand - 1];
+    if (nThisOverview >= 0)
+    {
+        if (nThisOverview >= poBand->nOverviews)
+            return;
+        poBand = poBand->papoOverviews[nThisOverview];
+    }
+    if (poBand->fpExternal != nullptr || poBand->nBlockXSize != nBlockXSize ||
+        poBand->nBlockYSize != nBlockYSize)
+        return;
+
+    const int nXBlock1 = nXOff / nBlockXSize;
+    const int nYBlock1 = nYOff / nBlockYSize;
+    const int nXBlock2 = (nXOff + nXSize - 1) / nBlockXSize;
+    const int nYBlock2 = (nYOff + nYSize - 1) / nBlockYSize;
+    if (nXBlock1 == nXBlock2 && nYBlock1 == nYBlock2)
+        return;
+
+    // Limit the number of simultaneously locked blocks, so as not to
+    // exhaust the block cache.
+    const int nBlockBytes =
+        nBlockXSize * nBlockYSize * GDALGetDataTypeSizeBytes(eDataType);
+    const GIntBig nMaxBatchBlocks =
+        std::max<GIntBig>(2, GDALGetCacheMax64() / 4 / nBlockBytes);
+
+    std::vector<int> anXBlock;
+    std::vector<int> anYBlock;
+    std::vector<GDALRasterBlock *> apoBlocks;
+    std::vector<void *> apData;
+
+    const auto LoadBatch = [&]()
+    {
+        if (apoBlocks.empty())
+            return;
+        CPLErr eErr = CE_None;
+        if (apoBlocks.size() == 1)
+        {
+            eErr = poBand->GetRasterBlock(anXBlock[0], anYBlock[0], apData[0],
+                                          nBlockBytes);
+        }
+        else
+        {
+            eErr = poBand->GetRasterBlocks(static_cast<int>(apoBlocks.size()),
+                                           anXBlock.data(), anYBlock.data(),
+                                           apData.data(), nBlockBytes);
+        }
+        for (size_t i = 0; i < apoBlocks.size(); i++)
+        {
+            if (eErr == CE_None)
+                UnpackSubByteData(apData[i]);
+            apoBlocks[i]->DropLock();
+            // On error, discard the blocks so that IReadBlock() gets a
+            // chance to read them again and report the error.
+            if (eErr != CE_None)
+                FlushBlock(anXBlock[i], anYBlock[i], FALSE);
+        }
+        anXBlock.clear();
+        anYBlock.clear();
+        apoBlocks.clear();
+        apData.clear();
+    };
+
+    for (int nYBlock = nYBlock1; nYBlock <= nYBlock2; nYBlock++)
+    {
+        for (int nXBlock = nXBlock1; nXBlock <= nXBlock2; nXBlock++)
+        {
+            GDALRasterBlock *poBlock = TryGetLockedBlockRef(nXBlock, nYBlock);
+            if (poBlock != nullptr)
+            {
+                poBlock->DropLock();
+                continue;
+            }
+            poBlock = GetLockedBlockRef(nXBlock, nYBlock, TRUE);
+            if (poBlock == nullptr)
+            {
+                CPLErrorReset();
+                LoadBatch();
+                return;
+            }
+            anXBlock.push_back(nXBlock);
+            anYBlock.push_back(nYBlock);
+            apoBlocks.push_back(poBlock);
+            apData.push_back(poBlock->GetDataRef());
+            if (static_cast<GIntBig>(apoBlocks.size()) >= nMaxBatchBlocks)
+                LoadBatch();
+        }
+    }
+    LoadBatch();
+}
+
+/************************************************************************/
+/*                             IRasterIO()                              */
+/************************************************************************/
+
+CPLErr HFARasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
+                                int nXSize, int nYSize, void *pData,
+                                int nBufXSize, int nBufYSize,
+                                GDALDataType eBufType, GSpacing nPixelSpace,
+                                GSpacing nLineSpace,
+                                GDALRasterIOExtraArg *psExtraArg)
+
+{
+    // Only preload at full resolution: for subsampled requests, the
+    // generic implementation may pick an overview instead.
+    if (eRWFlag == GF_Read && nXSize == nBufXSize && nYSize == nBufYSize)
+        PreloadBlocks(nXOff, nYOff, nXSize, nYSize);
+
+    return GDALPamRasterBand::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
+                                        pData, nBufXSize, nBufYSize, eBufType,
+                                        nPixelSpace, nLineSpace, psExtraArg);
+}
+
 /************************************************************************/
 /*                            IWriteBlock()                             */
 /************************************************************************/
@@ -2680,9 +2820,42 @@ CPLErr HFARasterBand::BuildOverviews(const char *pszResampling,
     GDALRasterBand **papoOvBands = static_cast<GDALRasterBand **>(
         CPLCalloc(sizeof(void *), nReqOverviews));
 
+    if (GetOrCreateOverviewBands(pszResampling, nReqOverviews, panOverviewList,
+                                 papoOvBands) != CE_None)
+    {
+        CPLFree(papoOvBands);
+        return CE_Failure;
+    }
+
     const bool bRegenerate =
         CPLTestBool(CSLFetchNameValueDef(papszOptions, "REGENERATE", "YES"));
 
+    CPLErr eErr = CE_None;
+
+    if (bRegenerate)
+        eErr = GDALRegenerateOverviewsEx((GDALRasterBandH)this, nReqOverviews,
+                                         (GDALRasterBandH *)papoOvBands,
+                                         pszResampling, pfnProgress,
+                                         pProgressData, papszOptions);
+
+    CPLFree(papoOvBands);
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                      GetOrCreateOverviewBands()                      */
+/*                                                                      */
+/*      Fill papoOvBands with the overview bands matching the           */
+/*      requested levels, creating the missing ones.                    */
+/************************************************************************/
+
+CPLErr HFARasterBand::GetOrCreateOverviewBands(const char *pszResampling,
+                                               int nReqOverviews,
+                                               const int *panOverviewList,
+                                               GDALRasterBand **papoOvBands)
+
+{
     // Loop over overview levels requested.
     for (int iOverview = 0; iOverview < nReqOverviews; iOverview++)
     {
@@ -2714,10 +2887,7 @@ CPLErr HFARasterBand::BuildOverviews(const char *pszResampling,
             const int iResult = HFACreateOverview(
                 hHFA, nBand, panOverviewList[iOverview], pszResampling);
             if (iResult < 0)
-            {
-                CPLFree(papoOvBands);
                 return CE_Failure;
-            }
 
             if (papoOverviewBands == nullptr && nOverviews == 0 && iResult > 0)
             {
@@ -2737,17 +2907,7 @@ CPLErr HFARasterBand::BuildOverviews(const char *pszResampling,
         }
     }
 
-    CPLErr eErr = CE_None;
-
-    if (bRegenerate)
-        eErr = GDALRegenerateOverviewsEx((GDALRasterBandH)this, nReqOverviews,
-                                         (GDALRasterBandH *)papoOvBands,
-                                         pszResampling, pfnProgress,
-                                         pProgressData, papszOptions);
-
-    CPLFree(papoOvBands);
-
-    return eErr;
+    return CE_None;
 }
 
 /************************************************************************/
@@ -4297,6 +4457,75 @@ CPLErr HFADataset::IBuildOverviews(const char *pszResampling, int nOverviews,
             pfnProgress, pProgressData, papszOptions);
     }
 
+    // When several bands are processed, create the overview levels of all
+    // bands first, and then compute them together, which reads each source
+    // block only once and can use GDAL_NUM_THREADS.
+    if (nListBands > 1 && nOverviews > 0 &&
+        CPLTestBool(
+            CSLFetchNameValueDef(papszOptions, "REGENERATE", "YES")) &&
+        (STARTS_WITH_CI(pszResampling, "NEAR") ||
+         EQUAL(pszResampling, "RMS") || EQUAL(pszResampling, "AVERAGE") ||
+         EQUAL(pszResampling, "GAUSS") || EQUAL(pszResampling, "CUBIC") ||
+         EQUAL(pszResampling, "CUBICSPLINE") ||
+         EQUAL(pszResampling, "LANCZOS") ||
+         EQUAL(pszResampling, "BILINEAR") || EQUAL(pszResampling, "MODE")))
+    {
+        std::vector<GDALRasterBand *> apoSrcBands;
+        for (int i = 0; i < nListBands; i++)
+        {
+            HFARasterBand *poBand =
+                cpl::down_cast<HFARasterBand *>(GetRasterBand(panBandList[i]));
+            if (poBand == nullptr)
+            {
+                CPLError(CE_Failure, CPLE_ObjectNull, "GetRasterBand failed");
+                return CE_Failure;
+            }
+            poBand->EstablishOverviews();
+            if (poBand->GetRasterDataType() !=
+                    GetRasterBand(panBandList[0])->GetRasterDataType() ||
+                GDALDataTypeIsComplex(poBand->GetRasterDataType()) ||
+                poBand->GetColorTable() != nullptr)
+            {
+                apoSrcBands.clear();
+                break;
+            }
+            apoSrcBands.push_back(poBand);
+        }
+
+        if (!apoSrcBands.empty())
+        {
+            std::vector<std::vector<GDALRasterBand *>> aapoOvBands(
+                nListBands, std::vector<GDALRasterBand *>(nOverviews));
+            std::vector<GDALRasterBand **> apapoOvBands;
+            bool bSameTypes = true;
+            for (int i = 0; i < nListBands; i++)
+            {
+                auto poBand = cpl::down_cast<HFARasterBand *>(apoSrcBands[i]);
+                if (poBand->GetOrCreateOverviewBands(
+                        pszResampling, nOverviews, panOverviewList,
+                        aapoOvBands[i].data()) != CE_None)
+                {
+                    return CE_Failure;
+                }
+                for (auto *poOvBand : aapoOvBands[i])
+                {
+                    if (poOvBand->GetRasterDataType() !=
+                        poBand->GetRasterDataType())
+                        bSameTypes = false;
+                }
+                apapoOvBands.push_back(aapoOvBands[i].data());
+            }
+
+            if (bSameTypes)
+            {
+                return GDALRegenerateOverviewsMultiBand(
+                    nListBands, apoSrcBands.data(), nOverviews,
+                    apapoOvBands.data(), pszResampling, pfnProgress,
+                    pProgressData, papszOptions);
+            }
+        }
+    }
+
     for (int i = 0; i < nListBands; i++)
     {
         void *pScaledProgressData = GDALCreateScaledProgress(
@@ -155,6 +155,18 @@ class HFARasterBand final : public GDALPamRasterBand
     void EstablishOverviews();
     CPLErr WriteNamedRAT(const char *pszName,
                          const GDALRasterAttributeTable *poRAT);
+    void UnpackSubByteData(void *pImage);
+    void PreloadBlocks(int nXOff, int nYOff, int nXSize, int nYSize);
+    CPLErr GetOrCreateOverviewBands(const char *pszResampling,
+                                    int nReqOverviews,
+                                    const int *panOverviewList,
+                                    GDALRasterBand **papoOvBands);
+
+  protected:
+    virtual CPLErr IRasterIO(GDALRWFlag, int, int, int, int, void *, int, int,
+                             GDALDataType, GSpacing nPixelSpace,
+                             GSpacing nLineSpace,
+                             GDALRasterIOExtraArg *psExtraArg) override;
 
   public:
     HFARasterBand(HFADataset *, int, int);
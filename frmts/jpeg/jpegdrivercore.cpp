@@ -32,6 +32,10 @@
 
 #include "jpegdrivercore.h"
 
+#ifndef PLUGIN_FILENAME
+#include "gdal_frmts.h"
+#endif
+
 // So that D_LOSSLESS_SUPPORTED is visible if defined in jmorecfg of libjpeg-turbo >= 2.2
 #define JPEG_INTERNAL_OPTIONS
 #include "jpeglib.h"
@@ -165,6 +169,9 @@ void JPEGDriverSetCommonMetadata(GDALDriver *poDriver)
 #endif
 
     poDriver->pfnIdentify = JPEGDriverIdentify;
+    poDriver->SetMetadataItem(GDAL_DMD_IDENTIFY_SIGNATURES,
+                              "magic:0:FFD8FF prefix:JPEG_SUBFILE: "
+                              "prefix:JPEG:");
     poDriver->SetMetadataItem(GDAL_DCAP_OPEN, "YES");
     poDriver->SetMetadataItem(GDAL_DCAP_CREATECOPY, "YES");
 }
@@ -189,3 +196,20 @@ void DeclareDeferredJPEGPlugin()
     GetGDALDriverManager()->DeclareDeferredPluginDriver(poDriver);
 }
 #endif
+
+/************************************************************************/
+/*                     DeclareDeferredJPEGBuiltin()                     */
+/************************************************************************/
+
+#ifndef PLUGIN_FILENAME
+void DeclareDeferredJPEGBuiltin()
+{
+    if (GDALGetDriverByName(DRIVER_NAME) != nullptr)
+    {
+        return;
+    }
+    auto poDriver = new GDALPluginDriverProxy(GDALRegister_JPEG);
+    JPEGDriverSetCommonMetadata(poDriver);
+    GetGDALDriverManager()->DeclareDeferredPluginDriver(poDriver);
+}
+#endif
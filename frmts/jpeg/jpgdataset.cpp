@@ -131,6 +131,13 @@ constexpr int JPEG_EXIF_JPEGIFBYTECOUNT = 0x202;
 #define JPEG_LIB_MK1_OR_12BIT 1
 #endif
 
+/* jpeg_skip_scanlines() and jpeg_crop_scanline() are available since
+ * libjpeg-turbo 1.5. Only used in 8-bit mode.
+ */
+#if defined(HAVE_JPEGTURBO_SKIP_AND_CROP_SCANLINES) && !defined(JPGDataset)
+#define JPEG_USE_SKIP_AND_CROP_SCANLINES
+#endif
+
 /************************************************************************/
 /*                     SetMaxMemoryToUse()                              */
 /************************************************************************/
@@ -2042,6 +2049,8 @@ void JPGDataset::StopDecompress()
         bHasDoneJpegCreateDecompress = false;
     }
     nLoadedScanline = INT_MAX;
+    m_nCropXOff = 0;
+    m_nCropXSize = 0;
     if (ppoActiveDS)
         *ppoActiveDS = nullptr;
 }
@@ -2138,6 +2147,82 @@ CPLErr JPGDataset::StartDecompress()
     return CE_None;
 }
 
+/************************************************************************/
+/*                       AllocateScanlineBuffer()                       */
+/************************************************************************/
+
+void JPGDataset::AllocateScanlineBuffer()
+{
+    if (m_pabyScanline != nullptr)
+        return;
+
+    int nJPEGBands = 0;
+    switch (sDInfo.out_color_space)
+    {
+        case JCS_GRAYSCALE:
+            nJPEGBands = 1;
+            break;
+        case JCS_RGB:
+        case JCS_YCbCr:
+            nJPEGBands = 3;
+            break;
+        case JCS_CMYK:
+        case JCS_YCCK:
+            nJPEGBands = 4;
+            break;
+
+        default:
+            CPLAssert(false);
+    }
+
+    m_pabyScanline = static_cast<GByte *>(
+        CPLMalloc(cpl::fits_on<int>(nJPEGBands * GetRasterXSize() * 2)));
+}
+
+/************************************************************************/
+/*                           ReadScanlines()                            */
+/*                                                                      */
+/*      Decode lines up to iLine, which must be after nLoadedScanline.  */
+/*      Must be called with sUserData.setjmp_buffer set by the caller.  */
+/************************************************************************/
+
+CPLErr JPGDataset::ReadScanlines(int iLine, GByte *outBuffer)
+{
+#ifdef JPEG_USE_SKIP_AND_CROP_SCANLINES
+    // Skip the lines that are not requested: they are entropy decoded, but
+    // IDCT, upsampling and color conversion are not done for them.
+    if (iLine > nLoadedScanline + 1)
+    {
+        const JDIMENSION nToSkip =
+            static_cast<JDIMENSION>(iLine - nLoadedScanline - 1);
+        const JDIMENSION nSkipped = jpeg_skip_scanlines(&sDInfo, nToSkip);
+        if (ErrorOutOnNonFatalError() || nSkipped != nToSkip)
+        {
+            // Force a restart on next request
+            nLoadedScanline = INT_MAX;
+            return CE_Failure;
+        }
+        nLoadedScanline = iLine - 1;
+    }
+#endif
+
+    while (nLoadedScanline < iLine)
+    {
+        GDAL_JSAMPLE *ppSamples = reinterpret_cast<GDAL_JSAMPLE *>(
+            outBuffer ? outBuffer : m_pabyScanline);
+#if defined(HAVE_JPEGTURBO_DUAL_MODE_8_12) && BITS_IN_JSAMPLE == 12
+        jpeg12_read_scanlines(&sDInfo, &ppSamples, 1);
+#else
+        jpeg_read_scanlines(&sDInfo, &ppSamples, 1);
+#endif
+        if (ErrorOutOnNonFatalError())
+            return CE_Failure;
+        nLoadedScanline++;
+    }
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                            LoadScanline()                            */
 /************************************************************************/
@@ -2145,6 +2230,10 @@ CPLErr JPGDataset::StartDecompress()
 CPLErr JPGDataset::LoadScanline(int iLine, GByte *outBuffer)
 
 {
+    // A cropped decompression cannot serve full scanlines.
+    if (m_nCropXSize > 0 && Restart() != CE_None)
+        return CE_Failure;
+
     if (nLoadedScanline == iLine)
         return CE_None;
 
@@ -2160,30 +2249,8 @@ CPLErr JPGDataset::LoadScanline(int iLine, GByte *outBuffer)
     if (!bHasDoneJpegStartDecompress && StartDecompress() != CE_None)
         return CE_Failure;
 
-    if (outBuffer == nullptr && m_pabyScanline == nullptr)
-    {
-        int nJPEGBands = 0;
-        switch (sDInfo.out_color_space)
-        {
-            case JCS_GRAYSCALE:
-                nJPEGBands = 1;
-                break;
-            case JCS_RGB:
-            case JCS_YCbCr:
-                nJPEGBands = 3;
-                break;
-            case JCS_CMYK:
-            case JCS_YCCK:
-                nJPEGBands = 4;
-                break;
-
-            default:
-                CPLAssert(false);
-        }
-
-        m_pabyScanline = static_cast<GByte *>(
-            CPLMalloc(cpl::fits_on<int>(nJPEGBands * GetRasterXSize() * 2)));
-    }
+    if (outBuffer == nullptr)
+        AllocateScanlineBuffer();
 
     if (iLine < nLoadedScanline)
     {
@@ -2191,23 +2258,69 @@ CPLErr JPGDataset::LoadScanline(int iLine, GByte *outBuffer)
             return CE_Failure;
     }
 
-    while (nLoadedScanline < iLine)
+    return ReadScanlines(iLine, outBuffer);
+}
+
+/************************************************************************/
+/*                        LoadCroppedScanline()                         */
+/*                                                                      */
+/*      Load in m_pabyScanline line iLine, for at least the columns     */
+/*      [nXOff, nXOff + nXSize[. nCropXOff is set to the column of the  */
+/*      first pixel of m_pabyScanline.                                  */
+/************************************************************************/
+
+#ifdef JPEG_USE_SKIP_AND_CROP_SCANLINES
+
+CPLErr JPGDataset::LoadCroppedScanline(int iLine, int nXOff, int nXSize,
+                                       int &nCropXOff)
+{
+    const bool bCompatibleCrop =
+        bHasDoneJpegStartDecompress && m_nCropXSize > 0 &&
+        nXOff >= m_nCropXOff && nXOff + nXSize <= m_nCropXOff + m_nCropXSize;
+    nCropXOff = m_nCropXOff;
+    if (bCompatibleCrop && nLoadedScanline == iLine)
+        return CE_None;
+
+    // The cropped area can only be set before the first scanline is read.
+    if (!bCompatibleCrop || iLine < nLoadedScanline)
     {
-        GDAL_JSAMPLE *ppSamples = reinterpret_cast<GDAL_JSAMPLE *>(
-            outBuffer ? outBuffer : m_pabyScanline);
-#if defined(HAVE_JPEGTURBO_DUAL_MODE_8_12) && BITS_IN_JSAMPLE == 12
-        jpeg12_read_scanlines(&sDInfo, &ppSamples, 1);
-#else
-        jpeg_read_scanlines(&sDInfo, &ppSamples, 1);
-#endif
+        if (Restart() != CE_None || !bHasDoneJpegStartDecompress)
+            return CE_Failure;
+
+        // setup to trap a fatal error.
+        if (setjmp(sUserData.setjmp_buffer))
+            return CE_Failure;
+
+        JDIMENSION nCropXOffJPEG = static_cast<JDIMENSION>(nXOff);
+        JDIMENSION nCropXSizeJPEG = static_cast<JDIMENSION>(nXSize);
+        jpeg_crop_scanline(&sDInfo, &nCropXOffJPEG, &nCropXSizeJPEG);
         if (ErrorOutOnNonFatalError())
             return CE_Failure;
-        nLoadedScanline++;
+        m_nCropXOff = static_cast<int>(nCropXOffJPEG);
+        m_nCropXSize = static_cast<int>(nCropXSizeJPEG);
+        nCropXOff = m_nCropXOff;
     }
 
-    return CE_None;
+    // setup to trap a fatal error.
+    if (setjmp(sUserData.setjmp_buffer))
+        return CE_Failure;
+
+    AllocateScanlineBuffer();
+
+    return ReadScanlines(iLine, nullptr);
+}
+
+#else
+
+CPLErr JPGDataset::LoadCroppedScanline(int, int, int, int &)
+{
+    CPLError(CE_Failure, CPLE_NotSupported,
+             "jpeg_crop_scanline() not available");
+    return CE_Failure;
 }
 
+#endif
+
 /************************************************************************/
 /*                         LoadDefaultTables()                          */
 /************************************************************************/
@@ -2626,6 +2739,40 @@ CPLErr JPGDatasetCommon::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
     }
 #endif
 
+#ifdef JPEG_USE_SKIP_AND_CROP_SCANLINES
+    // Reading a window of at most half of the width: only decode the needed
+    // columns (and skip the lines before the window), bypassing the block
+    // cache which holds full scanlines.
+    const int nOutColorSpace = GetOutColorSpace();
+    if (eRWFlag == GF_Read && nXSize == nBufXSize && nYSize == nBufYSize &&
+        nXSize <= nRasterXSize / 2 && eBufType == GDT_Byte &&
+        GetDataPrecision() == 8 && m_fpImage != nullptr &&
+        (nOutColorSpace == JCS_GRAYSCALE || nOutColorSpace == JCS_RGB ||
+         nOutColorSpace == JCS_CMYK) &&
+        eGDALColorSpace == nOutColorSpace &&
+        CPLTestBool(CPLGetConfigOption("GDAL_JPEG_CROP_SCANLINES", "YES")))
+    {
+        for (int iY = 0; iY < nYSize; ++iY)
+        {
+            int nCropXOff = 0;
+            const CPLErr eErr =
+                LoadCroppedScanline(nYOff + iY, nXOff, nXSize, nCropXOff);
+            if (eErr != CE_None)
+                return eErr;
+            for (int iBand = 0; iBand < nBandCount; ++iBand)
+            {
+                GDALCopyWords(m_pabyScanline + (nXOff - nCropXOff) * nBands +
+                                  panBandMap[iBand] - 1,
+                              GDT_Byte, nBands,
+                              static_cast<GByte *>(pData) + iY * nLineSpace +
+                                  iBand * nBandSpace,
+                              GDT_Byte, static_cast<int>(nPixelSpace), nXSize);
+            }
+        }
+        return CE_None;
+    }
+#endif
+
     return GDALPamDataset::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
                                      pData, nBufXSize, nBufYSize, eBufType,
                                      nBandCount, panBandMap, nPixelSpace,
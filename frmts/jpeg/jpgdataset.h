@@ -206,6 +206,8 @@ class JPGDatasetCommon CPL_NON_FINAL : public GDALPamDataset
     std::vector<GByte> m_abyRawThermalImage{};
 
     virtual CPLErr LoadScanline(int, GByte *outBuffer = nullptr) = 0;
+    virtual CPLErr LoadCroppedScanline(int iLine, int nXOff, int nXSize,
+                                       int &nCropXOff) = 0;
     virtual void StopDecompress() = 0;
     virtual CPLErr Restart() = 0;
 
@@ -305,7 +307,15 @@ class JPGDataset final : public JPGDatasetCommon
     struct jpeg_error_mgr sJErr;
     struct jpeg_progress_mgr sJProgress;
 
+    // Columns decoded when jpeg_crop_scanline() is in use (nCropXSize > 0)
+    int m_nCropXOff = 0;
+    int m_nCropXSize = 0;
+
+    void AllocateScanlineBuffer();
+    CPLErr ReadScanlines(int iLine, GByte *outBuffer);
     virtual CPLErr LoadScanline(int, GByte *outBuffer) override;
+    virtual CPLErr LoadCroppedScanline(int iLine, int nXOff, int nXSize,
+                                       int &nCropXOff) override;
     CPLErr StartDecompress();
     virtual void StopDecompress() override;
     virtual CPLErr Restart() override;
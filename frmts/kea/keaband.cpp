@@ -359,6 +359,45 @@ CPLErr KEARasterBand::IReadBlock(int nBlockXOff, int nBlockYOff, void *pImage)
     }
 }
 
+// virtual method to read a window. Reads spanning several blocks at full
+// resolution are done with a single libkea call straight into the user
+// buffer, so that HDF5 processes all the chunks involved at once.
+CPLErr KEARasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
+                                int nXSize, int nYSize, void *pData,
+                                int nBufXSize, int nBufYSize,
+                                GDALDataType eBufType, GSpacing nPixelSpace,
+                                GSpacing nLineSpace,
+                                GDALRasterIOExtraArg *psExtraArg)
+{
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
+    if (eRWFlag == GF_Read && eAccess == GA_ReadOnly && nXSize == nBufXSize &&
+        nYSize == nBufYSize && eBufType == eDataType &&
+        nPixelSpace == nDTSize && nLineSpace % nDTSize == 0 &&
+        nLineSpace / nDTSize >= nXSize &&
+        (nXOff / nBlockXSize != (nXOff + nXSize - 1) / nBlockXSize ||
+         nYOff / nBlockYSize != (nYOff + nYSize - 1) / nBlockYSize))
+    {
+        try
+        {
+            this->m_pImageIO->readImageBlock2Band(
+                this->nBand, pData, nXOff, nYOff, nXSize, nYSize,
+                static_cast<uint64_t>(nLineSpace / nDTSize), nYSize,
+                this->m_eKEADataType);
+            return CE_None;
+        }
+        catch (const kealib::KEAIOException &e)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "Failed to read file: %s",
+                     e.what());
+            return CE_Failure;
+        }
+    }
+
+    return GDALPamRasterBand::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
+                                        pData, nBufXSize, nBufYSize, eBufType,
+                                        nPixelSpace, nLineSpace, psExtraArg);
+}
+
 // virtual method to write a block
 CPLErr KEARasterBand::IWriteBlock(int nBlockXOff, int nBlockYOff, void *pImage)
 {
@@ -129,6 +129,10 @@ class KEARasterBand CPL_NON_FINAL : public GDALPamRasterBand
     // methods for accessing data as blocks
     virtual CPLErr IReadBlock(int, int, void *) override;
     virtual CPLErr IWriteBlock(int, int, void *) override;
+    virtual CPLErr IRasterIO(GDALRWFlag, int, int, int, int, void *, int, int,
+                             GDALDataType, GSpacing nPixelSpace,
+                             GSpacing nLineSpace,
+                             GDALRasterIOExtraArg *psExtraArg) override;
 
     // updates m_papszMetadataList
     void UpdateMetadataList();
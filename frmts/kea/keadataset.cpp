@@ -29,11 +29,14 @@
 
 #include "keadataset.h"
 #include "keaband.h"
+#include "keaoverview.h"
 #include "keacopy.h"
 #include "keadrivercore.h"
 #include "../frmts/hdf5/hdf5vfl.h"
 #include "cpl_vsi_virtual.h"
 
+#include <vector>
+
 /************************************************************************/
 /*                     KEADatasetDriverUnload()                        */
 /************************************************************************/
@@ -665,6 +668,52 @@ CPLErr KEADataset::IBuildOverviews(const char *pszResampling, int nOverviews,
                                    void *pProgressData,
                                    CSLConstList papszOptions)
 {
+    // when several bands are processed with a resampling method supported
+    // by GDALRegenerateOverviewsMultiBand(), create all the overviews first
+    // and compute them together, so that each source block is read once
+    // and GDAL_NUM_THREADS is honoured.
+    if (nListBands > 1 && nOverviews > 0 &&
+        (STARTS_WITH_CI(pszResampling, "NEAR") ||
+         EQUAL(pszResampling, "RMS") || EQUAL(pszResampling, "AVERAGE") ||
+         EQUAL(pszResampling, "GAUSS") || EQUAL(pszResampling, "CUBIC") ||
+         EQUAL(pszResampling, "CUBICSPLINE") ||
+         EQUAL(pszResampling, "LANCZOS") ||
+         EQUAL(pszResampling, "BILINEAR") || EQUAL(pszResampling, "MODE")))
+    {
+        const GDALDataType eDT =
+            this->GetRasterBand(panBandList[0])->GetRasterDataType();
+        bool bCompatible = !GDALDataTypeIsComplex(eDT);
+        for (int i = 0; i < nListBands && bCompatible; i++)
+        {
+            GDALRasterBand *pBand = this->GetRasterBand(panBandList[i]);
+            if (pBand->GetRasterDataType() != eDT ||
+                pBand->GetColorTable() != nullptr)
+                bCompatible = false;
+        }
+        if (bCompatible)
+        {
+            std::vector<GDALRasterBand *> apoSrcBands;
+            std::vector<GDALRasterBand **> apapoOvBands;
+            std::vector<std::vector<GDALRasterBand *>> aapoOvBands;
+            for (int i = 0; i < nListBands; i++)
+            {
+                KEARasterBand *pBand =
+                    (KEARasterBand *)this->GetRasterBand(panBandList[i]);
+                pBand->CreateOverviews(nOverviews, panOverviewList);
+                KEAOverview **papoOverviews = pBand->GetOverviewList();
+                aapoOvBands.emplace_back(papoOverviews,
+                                         papoOverviews + nOverviews);
+                apoSrcBands.push_back(pBand);
+            }
+            for (auto &apoOvBands : aapoOvBands)
+                apapoOvBands.push_back(apoOvBands.data());
+            return GDALRegenerateOverviewsMultiBand(
+                nListBands, apoSrcBands.data(), nOverviews,
+                apapoOvBands.data(), pszResampling, pfnProgress,
+                pProgressData, papszOptions);
+        }
+    }
+
     // go through the list of bands that have been passed in
     int nCurrentBand, nOK = 1;
     for (int nBandCount = 0; (nBandCount < nListBands) && nOK; nBandCount++)
@@ -47,12 +47,39 @@
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_frmts.h"
+#include "gdal_thread_pool.h"
 
 struct MEMDataset::Private
 {
     std::shared_ptr<GDALGroup> m_poRootGroup{};
 };
 
+/************************************************************************/
+/*                        MEMAllocateBandData()                         */
+/************************************************************************/
+
+// Allocates a zero-initialized buffer, to be freed with VSIFreeLarge().
+// Large buffers are backed by huge pages where available. With
+// MEM_FIRST_TOUCH=PARALLEL, their pages are touched by GDAL_NUM_THREADS
+// threads, so that they are spread over NUMA nodes.
+static GByte *MEMAllocateBandData(size_t nCount, size_t nSize)
+{
+    GByte *pabyData =
+        static_cast<GByte *>(VSI_CALLOC_LARGE_VERBOSE(nCount, nSize));
+    if (pabyData &&
+        EQUAL(CPLGetConfigOption("MEM_FIRST_TOUCH", "LAZY"), "PARALLEL"))
+    {
+        const char *pszNumThreads =
+            CPLGetConfigOption("GDAL_NUM_THREADS", "ALL_CPUS");
+        const int nThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                                 ? CPLGetNumCPUs()
+                                 : std::max(1, atoi(pszNumThreads));
+        GDALFirstTouchParallel(pabyData, nCount * nSize,
+                               std::min(nThreads, 128));
+    }
+    return pabyData;
+}
+
 /************************************************************************/
 /*                        MEMCreateRasterBand()                         */
 /************************************************************************/
@@ -148,7 +175,10 @@ MEMRasterBand::~MEMRasterBand()
 {
     if (bOwnData)
     {
-        VSIFree(pabyData);
+        if (m_bOwnDataLargeAlloc)
+            VSIFreeLarge(pabyData);
+        else
+            VSIFree(pabyData);
     }
 }
 
@@ -750,17 +780,19 @@ CPLErr MEMDataset::AddBand(GDALDataType eType, char **papszOptions)
 #if SIZEOF_VOIDP == 4
             (nTmp > INT_MAX) ? nullptr :
 #endif
-                             static_cast<GByte *>(VSI_CALLOC_VERBOSE(
-                                 (size_t)nTmp, GetRasterYSize()));
+                             MEMAllocateBandData(static_cast<size_t>(nTmp),
+                                                 GetRasterYSize());
 
         if (pData == nullptr)
         {
             return CE_Failure;
         }
 
-        SetBand(nBandId,
-                new MEMRasterBand(this, nBandId, pData, eType, nPixelSize,
-                                  nPixelSize * GetRasterXSize(), TRUE));
+        auto poNewBand =
+            new MEMRasterBand(this, nBandId, pData, eType, nPixelSize,
+                              nPixelSize * GetRasterXSize(), TRUE);
+        poNewBand->m_bOwnDataLargeAlloc = true;
+        SetBand(nBandId, poNewBand);
 
         return CE_None;
     }
@@ -1280,8 +1312,7 @@ MEMDataset *MEMDataset::Create(const char * /* pszFilename */, int nXSize,
     std::vector<GByte *> apbyBandData;
     if (nBandsIn > 0)
     {
-        GByte *pabyData =
-            static_cast<GByte *>(VSI_CALLOC_VERBOSE(1, nGlobalSize));
+        GByte *pabyData = MEMAllocateBandData(1, nGlobalSize);
         if (!pabyData)
         {
             return nullptr;
@@ -1335,6 +1366,7 @@ MEMDataset *MEMDataset::Create(const char * /* pszFilename */, int nXSize,
         else
             poNewBand = new MEMRasterBand(poDS, iBand + 1, apbyBandData[iBand],
                                           eType, 0, 0, iBand == 0);
+        poNewBand->m_bOwnDataLargeAlloc = iBand == 0;
 
         poDS->SetBand(iBand + 1, poNewBand);
     }
@@ -1973,48 +2005,6 @@ bool MEMAbstractMDArray::Init(GByte *pData,
     return m_pabyArray != nullptr;
 }
 
-/************************************************************************/
-/*                             FastCopy()                               */
-/************************************************************************/
-
-template <int N>
-inline static void FastCopy(size_t nIters, GByte *dstPtr, const GByte *srcPtr,
-                            GPtrDiff_t dst_inc_offset,
-                            GPtrDiff_t src_inc_offset)
-{
-    if (nIters >= 8)
-    {
-#define COPY_ELT(i)                                                            \
-    memcpy(dstPtr + (i)*dst_inc_offset, srcPtr + (i)*src_inc_offset, N)
-        while (true)
-        {
-            COPY_ELT(0);
-            COPY_ELT(1);
-            COPY_ELT(2);
-            COPY_ELT(3);
-            COPY_ELT(4);
-            COPY_ELT(5);
-            COPY_ELT(6);
-            COPY_ELT(7);
-            nIters -= 8;
-            srcPtr += 8 * src_inc_offset;
-            dstPtr += 8 * dst_inc_offset;
-            if (nIters < 8)
-                break;
-        }
-        if (nIters == 0)
-            return;
-    }
-    while (true)
-    {
-        memcpy(dstPtr, srcPtr, N);
-        if ((--nIters) == 0)
-            break;
-        srcPtr += src_inc_offset;
-        dstPtr += dst_inc_offset;
-    }
-}
-
 /************************************************************************/
 /*                             ReadWrite()                              */
 /************************************************************************/
@@ -2026,98 +2016,42 @@ void MEMAbstractMDArray::ReadWrite(bool bIsWrite, const size_t *count,
 {
     const auto nDims = m_aoDims.size();
     const auto nDimsMinus1 = nDims - 1;
-    const bool bBothAreNumericDT = srcType.GetClass() == GEDTC_NUMERIC &&
-                                   dstType.GetClass() == GEDTC_NUMERIC;
-    const bool bSameNumericDT =
-        bBothAreNumericDT &&
-        srcType.GetNumericDataType() == dstType.GetNumericDataType();
-    const auto nSameDTSize = bSameNumericDT ? srcType.GetSize() : 0;
-    const bool bCanUseMemcpyLastDim =
-        bSameNumericDT &&
-        stack[nDimsMinus1].src_inc_offset ==
-            static_cast<GPtrDiff_t>(nSameDTSize) &&
-        stack[nDimsMinus1].dst_inc_offset ==
-            static_cast<GPtrDiff_t>(nSameDTSize);
-    const size_t nCopySizeLastDim =
-        bCanUseMemcpyLastDim ? nSameDTSize * count[nDimsMinus1] : 0;
     const bool bNeedsFreeDynamicMemory =
         bIsWrite && dstType.NeedsFreeDynamicMemory();
 
+    if (!bNeedsFreeDynamicMemory)
+    {
+        const auto nSrcDTSize = static_cast<GPtrDiff_t>(srcType.GetSize());
+        const auto nDstDTSize = static_cast<GPtrDiff_t>(dstType.GetSize());
+        std::vector<GPtrDiff_t> anSrcStrides(nDims);
+        std::vector<GPtrDiff_t> anDstStrides(nDims);
+        for (size_t i = 0; i < nDims; i++)
+        {
+            anSrcStrides[i] = stack[i].src_inc_offset / nSrcDTSize;
+            anDstStrides[i] = stack[i].dst_inc_offset / nDstDTSize;
+        }
+        GDALExtendedDataType::CopyValues(
+            nDims, count, stack[0].src_ptr, srcType, anSrcStrides.data(),
+            stack[0].dst_ptr, dstType, anDstStrides.data());
+        return;
+    }
+
+    // Slow path when existing destination values must be freed
     auto lambdaLastDim = [&](size_t idxPtr)
     {
         auto srcPtr = stack[idxPtr].src_ptr;
         auto dstPtr = stack[idxPtr].dst_ptr;
-        if (nCopySizeLastDim)
-        {
-            memcpy(dstPtr, srcPtr, nCopySizeLastDim);
-        }
-        else
+        size_t nIters = count[nDimsMinus1];
+        const auto dst_inc_offset = stack[nDimsMinus1].dst_inc_offset;
+        const auto src_inc_offset = stack[nDimsMinus1].src_inc_offset;
+        while (true)
         {
-            size_t nIters = count[nDimsMinus1];
-            const auto dst_inc_offset = stack[nDimsMinus1].dst_inc_offset;
-            const auto src_inc_offset = stack[nDimsMinus1].src_inc_offset;
-            if (bSameNumericDT)
-            {
-                if (nSameDTSize == 1)
-                {
-                    FastCopy<1>(nIters, dstPtr, srcPtr, dst_inc_offset,
-                                src_inc_offset);
-                    return;
-                }
-                if (nSameDTSize == 2)
-                {
-                    FastCopy<2>(nIters, dstPtr, srcPtr, dst_inc_offset,
-                                src_inc_offset);
-                    return;
-                }
-                if (nSameDTSize == 4)
-                {
-                    FastCopy<4>(nIters, dstPtr, srcPtr, dst_inc_offset,
-                                src_inc_offset);
-                    return;
-                }
-                if (nSameDTSize == 8)
-                {
-                    FastCopy<8>(nIters, dstPtr, srcPtr, dst_inc_offset,
-                                src_inc_offset);
-                    return;
-                }
-                if (nSameDTSize == 16)
-                {
-                    FastCopy<16>(nIters, dstPtr, srcPtr, dst_inc_offset,
-                                 src_inc_offset);
-                    return;
-                }
-                CPLAssert(false);
-            }
-            else if (bBothAreNumericDT
-#if SIZEOF_VOIDP >= 8
-                     && src_inc_offset <= std::numeric_limits<int>::max() &&
-                     dst_inc_offset <= std::numeric_limits<int>::max()
-#endif
-            )
-            {
-                GDALCopyWords64(srcPtr, srcType.GetNumericDataType(),
-                                static_cast<int>(src_inc_offset), dstPtr,
-                                dstType.GetNumericDataType(),
-                                static_cast<int>(dst_inc_offset),
-                                static_cast<GPtrDiff_t>(nIters));
-                return;
-            }
-
-            while (true)
-            {
-                if (bNeedsFreeDynamicMemory)
-                {
-                    dstType.FreeDynamicMemory(dstPtr);
-                }
-                GDALExtendedDataType::CopyValue(srcPtr, srcType, dstPtr,
-                                                dstType);
-                if ((--nIters) == 0)
-                    break;
-                srcPtr += src_inc_offset;
-                dstPtr += dst_inc_offset;
-            }
+            dstType.FreeDynamicMemory(dstPtr);
+            GDALExtendedDataType::CopyValue(srcPtr, srcType, dstPtr, dstType);
+            if ((--nIters) == 0)
+                break;
+            srcPtr += src_inc_offset;
+            dstPtr += dst_inc_offset;
         }
     };
 
@@ -154,6 +154,8 @@ class CPL_DLL MEMRasterBand CPL_NON_FINAL : public GDALPamRasterBand
     GSpacing nPixelOffset;
     GSpacing nLineOffset;
     int bOwnData;
+    // Whether pabyData must be freed with VSIFreeLarge()
+    bool m_bOwnDataLargeAlloc = false;
 
     bool m_bIsMask = false;
 
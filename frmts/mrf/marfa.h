@@ -63,6 +63,8 @@
 #include "ogr_spatialref.h"
 
 #include <limits>
+#include <map>
+#include <vector>
 // For printing values
 #include <ostream>
 #include <iostream>
@@ -510,6 +512,19 @@ class MRFDataset final : public GDALPamDataset
     CPLErr ReadTileIdx(ILIdx &tinfo, const ILSize &pos, const ILImage &img,
                        const GIntBig bias = 0);
 
+    // Read an index record from the in-memory index cache, loading it as
+    // needed
+    CPLErr ReadIdxCache(ILIdx &tinfo, GIntBig offset);
+
+    // Read in one multi-range request the tiles needed for a read window,
+    // that are not in the block cache yet.  Returns true if any were read
+    bool PrefetchTiles(MRFRasterBand *poBand, int nXOff, int nYOff,
+                       int nXSize, int nYSize, int nBandCount,
+                       const int *panBandMap);
+
+    // Get a tile read by PrefetchTiles, returns false if not available
+    bool GetPrefetchedTile(const ILIdx &tinfo, void *buffer);
+
     VSILFILE *IdxFP();
     VSILFILE *DataFP();
     GDALRWFlag IdxMode()
@@ -598,6 +613,15 @@ class MRFDataset final : public GDALPamDataset
     VF dfp;  // Data file handle
     VF ifp;  // Index file handle
 
+    // Index records kept in memory for read-only access, in pages of
+    // IDX_CACHE_PAGE records, keyed by page number
+    int idx_cache;    // Use the index cache
+    int idx_preload;  // Read the whole index at first access
+    std::map<GIntBig, std::vector<ILIdx>> idxCache;
+
+    // Compressed tiles read ahead by PrefetchTiles, keyed by data file offset
+    std::map<GIntBig, std::vector<char>> prefetched;
+
     // statistical values
     std::vector<double> vNoData, vMin, vMax;
     // Sticky context for zstd compress and decompress
@@ -629,6 +653,9 @@ class MRFRasterBand CPL_NON_FINAL : public GDALPamRasterBand
     virtual ~MRFRasterBand();
     virtual CPLErr IReadBlock(int xblk, int yblk, void *buffer) override;
     virtual CPLErr IWriteBlock(int xblk, int yblk, void *buffer) override;
+    virtual CPLErr IRasterIO(GDALRWFlag, int, int, int, int, void *, int, int,
+                             GDALDataType, GSpacing, GSpacing,
+                             GDALRasterIOExtraArg *) override;
 
     // Check that the respective block has data, without reading it
     virtual bool TestBlock(int xblk, int yblk);
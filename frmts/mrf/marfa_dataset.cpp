@@ -84,7 +84,7 @@ MRFDataset::MRFDataset()
       spacing(0), no_errors(0), missing(0), poSrcDS(nullptr), level(-1),
       cds(nullptr), scale(0.0), pbuffer(nullptr), pbsize(0), tile(ILSize()),
       bdirty(0), bGeoTransformValid(TRUE), poColorTable(nullptr), Quality(0),
-      pzscctx(nullptr), pzsdctx(nullptr), read_timer(), write_timer(0)
+      idx_cache(TRUE), idx_preload(FALSE), pzscctx(nullptr), pzsdctx(nullptr), read_timer(), write_timer(0)
 {
     m_oSRS.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
     //                X0   Xx   Xy  Y0    Yx   Yy
@@ -212,14 +212,139 @@ CPLErr MRFDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         return CE_Failure;
     }
 
+    // Read the tiles of a multi-tile window in one go
+    const bool prefetch =
+        eRWFlag == GF_Read && nBufXSize == nXSize && nBufYSize == nYSize &&
+        PrefetchTiles(static_cast<MRFRasterBand *>(GetRasterBand(panBandMap[0])),
+                      nXOff, nYOff, nXSize, nYSize, nBandCount, panBandMap);
+
     //
     // Call the parent implementation, which splits it into bands and calls
     // their IRasterIO
     //
-    return GDALPamDataset::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
-                                     pData, nBufXSize, nBufYSize, eBufType,
-                                     nBandCount, panBandMap, nPixelSpace,
-                                     nLineSpace, nBandSpace, psExtraArgs);
+    CPLErr ret = GDALPamDataset::IRasterIO(
+        eRWFlag, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize, nBufYSize,
+        eBufType, nBandCount, panBandMap, nPixelSpace, nLineSpace, nBandSpace,
+        psExtraArgs);
+
+    if (prefetch)
+        prefetched.clear();
+    return ret;
+}
+
+/**
+ *\brief Read ahead the tiles needed for a read window
+ *
+ * The compressed tiles intersecting the window which are not in the block
+ * cache are read with a single multi-range request, which is much faster than
+ * one request per tile on cloud storage.  They get used by IReadBlock
+ */
+
+bool MRFDataset::PrefetchTiles(MRFRasterBand *poBand, int nXOff, int nYOff,
+                               int nXSize, int nYSize, int nBandCount,
+                               const int *panBandMap)
+{
+    // Only for plain read-only MRFs
+    if (eAccess != GA_ReadOnly || !source.empty() || clonedSource || missing ||
+        !prefetched.empty() || nBandCount < 1 || nXSize < 1 || nYSize < 1)
+        return false;
+
+    const ILImage &img = poBand->img;
+    const int x0 = nXOff / img.pagesize.x;
+    const int x1 = (nXOff + nXSize - 1) / img.pagesize.x;
+    const int y0 = nYOff / img.pagesize.y;
+    const int y1 = (nYOff + nYSize - 1) / img.pagesize.y;
+    if (x0 == x1 && y0 == y1)
+        return false;  // Single tile, nothing to gain
+
+    VSILFILE *l_dfp = DataFP();
+    if (l_dfp == nullptr)
+        return false;
+
+    // Don't hold more than the block cache could, compressed
+    const GIntBig maxBytes = GDALGetCacheMax64() / 2;
+    GIntBig totalBytes = 0;
+    bool bCacheFull = false;
+    try
+    {
+        for (int y = y0; y <= y1 && !bCacheFull; y++)
+        {
+            for (int x = x0; x <= x1 && !bCacheFull; x++)
+            {
+                for (int i = 0; i < nBandCount && !bCacheFull; i++)
+                {
+                    const int b = panBandMap ? panBandMap[i] : i + 1;
+                    GDALRasterBand *band = GetRasterBand(b);
+                    if (poBand->m_l)
+                        band = band->GetOverview(poBand->m_l - 1);
+                    if (band == nullptr)
+                        continue;
+                    GDALRasterBlock *poBlock = band->TryGetLockedBlockRef(x, y);
+                    if (poBlock != nullptr)
+                    {  // Already in the cache
+                        poBlock->DropLock();
+                        continue;
+                    }
+
+                    ILIdx tinfo;
+                    ILSize req(x, y, 0, (b - 1) / img.pagesize.c, poBand->m_l);
+                    if (CE_None != ReadTileIdx(tinfo, req, img) ||
+                        tinfo.size <= 0 || tinfo.size > pbsize * 2 ||
+                        prefetched.count(tinfo.offset))
+                        continue;
+                    bCacheFull = totalBytes + tinfo.size > maxBytes;
+                    if (bCacheFull)
+                        break;
+                    totalBytes += tinfo.size;
+                    prefetched[tinfo.offset].resize(
+                        static_cast<size_t>(tinfo.size));
+                }
+            }
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        prefetched.clear();
+        return false;
+    }
+
+    if (prefetched.size() < 2)
+    {
+        prefetched.clear();
+        return false;
+    }
+
+    std::vector<void *> data;
+    std::vector<vsi_l_offset> offsets;
+    std::vector<size_t> sizes;
+    for (auto &it : prefetched)
+    {
+        data.push_back(it.second.data());
+        offsets.push_back(static_cast<vsi_l_offset>(it.first));
+        sizes.push_back(it.second.size());
+    }
+
+    CPLDebug("MRF_IO", "Prefetching %d tiles, " CPL_FRMT_GIB " bytes",
+             static_cast<int>(data.size()), totalBytes);
+    if (0 != VSIFReadMultiRangeL(static_cast<int>(data.size()), data.data(),
+                                 offsets.data(), sizes.data(), l_dfp))
+    {
+        // Let IReadBlock read them and report errors
+        prefetched.clear();
+        return false;
+    }
+    return true;
+}
+
+bool MRFDataset::GetPrefetchedTile(const ILIdx &tinfo, void *buffer)
+{
+    auto it = prefetched.find(tinfo.offset);
+    if (it == prefetched.end() ||
+        it->second.size() != static_cast<size_t>(tinfo.size))
+        return false;
+    memcpy(buffer, it->second.data(), it->second.size());
+    prefetched.erase(it);
+    return true;
 }
 
 /**
@@ -2084,6 +2209,8 @@ void MRFDataset::ProcessOpenOptions(char **papszOptions)
 {
     CPLStringList opt(papszOptions, FALSE);
     no_errors = opt.FetchBoolean("NOERRORS", FALSE);
+    idx_cache = opt.FetchBoolean("IDX_CACHE", TRUE);
+    idx_preload = opt.FetchBoolean("IDX_PRELOAD", FALSE);
     const char *val = opt.FetchNameValue("ZSLICE");
     if (val)
         zslice = atoi(val);
@@ -2564,6 +2691,11 @@ CPLErr MRFDataset::ReadTileIdx(ILIdx &tinfo, const ILSize &pos,
         return CE_Failure;
     }
 
+    // Index is not modified when reading, it can be kept in memory
+    if (0 == bias && idx_cache && GF_Read == IdxMode() &&
+        0 == offset % sizeof(ILIdx))
+        return ReadIdxCache(tinfo, offset);
+
     VSIFSeekL(l_ifp, offset, SEEK_SET);
     if (1 != VSIFReadL(&tinfo, sizeof(ILIdx), 1, l_ifp))
         return CE_Failure;
@@ -2636,4 +2768,65 @@ CPLErr MRFDataset::ReadTileIdx(ILIdx &tinfo, const ILSize &pos,
     return ReadTileIdx(tinfo, pos, img, bias);
 }
 
+// Number of index records read at once by the index cache, 64KB
+static const GIntBig IDX_CACHE_PAGE = 4096;
+
+CPLErr MRFDataset::ReadIdxCache(ILIdx &tinfo, GIntBig offset)
+{
+    VSILFILE *l_ifp = IdxFP();
+    const GIntBig record = offset / sizeof(ILIdx);
+    const GIntBig page = record / IDX_CACHE_PAGE;
+
+    if (idx_preload && idxCache.empty())
+    {
+        // Read the whole index in one go, then split it in pages
+        idx_preload = FALSE;
+        VSIFSeekL(l_ifp, 0, SEEK_END);
+        const GIntBig records =
+            static_cast<GIntBig>(VSIFTellL(l_ifp) / sizeof(ILIdx));
+        std::vector<ILIdx> buf;
+        try
+        {
+            buf.resize(static_cast<size_t>(records));
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Warning, CPLE_OutOfMemory,
+                     "MRF: Can't preload index of " CPL_FRMT_GIB " records",
+                     records);
+        }
+        VSIFSeekL(l_ifp, 0, SEEK_SET);
+        if (!buf.empty() &&
+            buf.size() == VSIFReadL(buf.data(), sizeof(ILIdx), buf.size(), l_ifp))
+        {
+            for (GIntBig p = 0; p * IDX_CACHE_PAGE < records; p++)
+            {
+                auto first = buf.begin() + static_cast<size_t>(p * IDX_CACHE_PAGE);
+                auto last = buf.begin() + static_cast<size_t>(std::min(
+                                              records, (p + 1) * IDX_CACHE_PAGE));
+                idxCache[p].assign(first, last);
+            }
+        }
+    }
+
+    auto it = idxCache.find(page);
+    if (it == idxCache.end())
+    {
+        std::vector<ILIdx> &buf = idxCache[page];
+        buf.resize(static_cast<size_t>(IDX_CACHE_PAGE));
+        VSIFSeekL(l_ifp, page * IDX_CACHE_PAGE * sizeof(ILIdx), SEEK_SET);
+        // A short read is fine, the index can be smaller than a page
+        buf.resize(VSIFReadL(buf.data(), sizeof(ILIdx), buf.size(), l_ifp));
+        it = idxCache.find(page);
+    }
+
+    const size_t i = static_cast<size_t>(record - page * IDX_CACHE_PAGE);
+    if (i >= it->second.size())
+        return CE_Failure;
+    // Convert them to native form
+    tinfo.offset = net64(it->second[i].offset);
+    tinfo.size = net64(it->second[i].size);
+    return CE_None;
+}
+
 NAMESPACE_MRF_END
@@ -1064,9 +1064,15 @@ CPLErr MRFRasterBand::IReadBlock(int xblk, int yblk, void *buffer)
         return CE_Failure;
     }
 
-    // This part is not thread safe, but it is what GDAL expects
-    VSIFSeekL(dfp, tinfo.offset, SEEK_SET);
-    if (1 != VSIFReadL(data, static_cast<size_t>(tinfo.size), 1, dfp))
+    // Maybe it was read ahead
+    bool bRead = poMRFDS->GetPrefetchedTile(tinfo, data);
+    if (!bRead)
+    {
+        // This part is not thread safe, but it is what GDAL expects
+        VSIFSeekL(dfp, tinfo.offset, SEEK_SET);
+        bRead = 1 == VSIFReadL(data, static_cast<size_t>(tinfo.size), 1, dfp);
+    }
+    if (!bRead)
     {
         CPLFree(data);
         if (poMRFDS->no_errors)
@@ -1219,6 +1225,33 @@ CPLErr MRFRasterBand::IReadBlock(int xblk, int yblk, void *buffer)
     return ReadInterleavedBlock(xblk, yblk, buffer);
 }
 
+/**
+ *\brief Read a window, reading ahead the tiles it needs
+ *
+ * Single band read, the dataset does it for multiple bands
+ *
+ */
+
+CPLErr MRFRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
+                                int nXSize, int nYSize, void *pData,
+                                int nBufXSize, int nBufYSize,
+                                GDALDataType eBufType, GSpacing nPixelSpace,
+                                GSpacing nLineSpace,
+                                GDALRasterIOExtraArg *psExtraArg)
+{
+    const bool prefetch =
+        eRWFlag == GF_Read && nBufXSize == nXSize && nBufYSize == nYSize &&
+        poMRFDS->PrefetchTiles(this, nXOff, nYOff, nXSize, nYSize, 1, &nBand);
+
+    CPLErr ret = GDALPamRasterBand::IRasterIO(
+        eRWFlag, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize, nBufYSize,
+        eBufType, nPixelSpace, nLineSpace, psExtraArg);
+
+    if (prefetch)
+        poMRFDS->prefetched.clear();
+    return ret;
+}
+
 /**
  *\brief Write a block from the provided buffer
  *
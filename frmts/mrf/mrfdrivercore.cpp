@@ -119,6 +119,10 @@ void MRFDriverSetCommonMetadata(GDALDriver *poDriver)
         "decompression errors' default='FALSE'/>"
         "    <Option name='ZSLICE' type='int' description='For a third "
         "dimension MRF, pick a slice' default='0'/>"
+        "    <Option name='IDX_CACHE' type='boolean' description='Keep the "
+        "index in memory when reading' default='TRUE'/>"
+        "    <Option name='IDX_PRELOAD' type='boolean' description='Read the "
+        "whole index at first access' default='FALSE'/>"
         "</OpenOptionList>");
 
     // These will need to be revisited, do we support complex data types too?
@@ -237,6 +237,7 @@ class netCDFRasterBand final : public GDALPamRasterBand
     void CheckDataCpx(void *pImage, void *pImageNC, size_t nTmpBlockXSize,
                       size_t nTmpBlockYSize, bool bCheckIsNan = false);
     void SetBlockSize();
+    void SetChunkCacheSize(const size_t *chunksize);
 
     bool FetchNetcdfChunk(size_t xstart, size_t ystart, void *pImage);
 
@@ -860,6 +861,8 @@ void netCDFRasterBand::SetBlockSize()
                 nBlockYSize = (int)chunksize[nZDim - 2];
             else
                 nBlockYSize = 1;
+
+            SetChunkCacheSize(chunksize);
         }
     }
 
@@ -893,6 +896,72 @@ void netCDFRasterBand::SetBlockSize()
     }
 }
 
+// Size the HDF5 chunk cache of the variable so that it can hold a whole row
+// of chunks along the raster width. Otherwise, when a chunk spans several
+// bands, or blocks are read row by row, chunks are decompressed repeatedly.
+void netCDFRasterBand::SetChunkCacheSize(const size_t *chunksize)
+{
+    size_t nTypeSize = 0;
+    if (nc_inq_type(cdfid, nc_datatype, nullptr, &nTypeSize) != NC_NOERR ||
+        nTypeSize == 0)
+    {
+        return;
+    }
+    size_t nChunkSize = nTypeSize;
+    for (int i = 0; i < nZDim; ++i)
+    {
+        if (chunksize[i] == 0 ||
+            nChunkSize > std::numeric_limits<size_t>::max() / chunksize[i])
+            return;
+        nChunkSize *= chunksize[i];
+    }
+
+    size_t nCacheSize = 0;
+    size_t nCacheNElems = 0;
+    float fPreemption = 0;
+    if (nc_get_var_chunk_cache(cdfid, nZId, &nCacheSize, &nCacheNElems,
+                               &fPreemption) != NC_NOERR)
+    {
+        return;
+    }
+
+    size_t nChunks =
+        static_cast<size_t>(DIV_ROUND_UP(nRasterXSize, nBlockXSize));
+    // A block may straddle two rows of chunks
+    if ((nRasterYSize % nBlockYSize) != 0)
+        nChunks *= 2;
+
+    size_t nNewCacheSize = nCacheSize;
+    const char *pszCacheSize =
+        CPLGetConfigOption("GDAL_NETCDF_CHUNK_CACHE_SIZE", nullptr);
+    if (pszCacheSize)
+    {
+        nNewCacheSize = static_cast<size_t>(
+            std::max<GIntBig>(0, CPLAtoGIntBig(pszCacheSize)));
+    }
+    else
+    {
+        constexpr size_t MAX_CACHE_SIZE = 100 * 1024 * 1024;
+        if (nChunks <= MAX_CACHE_SIZE / nChunkSize)
+            nNewCacheSize = std::max(nCacheSize, nChunks * nChunkSize);
+    }
+    // Number of slots of the hash table. Should be much larger than the
+    // number of chunks that fit in the cache.
+    const size_t nChunksInCache =
+        std::min<size_t>(nNewCacheSize / nChunkSize, 1000 * 1000);
+    const size_t nNewCacheNElems =
+        std::max(nCacheNElems, nChunksInCache * 10 + 1);
+    if (nNewCacheSize != nCacheSize || nNewCacheNElems != nCacheNElems)
+    {
+        CPLDebug("GDAL_netCDF",
+                 "Setting chunk cache of variable %d to " CPL_FRMT_GUIB
+                 " bytes",
+                 nZId, static_cast<GUIntBig>(nNewCacheSize));
+        nc_set_var_chunk_cache(cdfid, nZId, nNewCacheSize, nNewCacheNElems,
+                               fPreemption);
+    }
+}
+
 // Constructor in create mode.
 // If nZId and following variables are not passed, the band will have 2
 // dimensions.
@@ -44,13 +44,16 @@
 #include <fcntl.h>
 #endif
 #include <algorithm>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_csv.h"
 #include "cpl_error.h"
+#include "cpl_mem_cache.h"
 #include "cpl_minixml.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
@@ -58,6 +61,7 @@
 #include "gdal.h"
 #include "gdal_frmts.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_srs_api.h"
@@ -407,6 +411,153 @@ static void SetBandMetadata(NITFImage *psImage, GDALRasterBand *poBand,
     }
 }
 
+/************************************************************************/
+/*                     NITFCollectAttachmentsCached()                   */
+/*                                                                      */
+/*      NITFCollectAttachments() needs to parse the subheader of all    */
+/*      image segments, which is expensive for files with hundreds or   */
+/*      thousands of them, and is repeated each time one of their       */
+/*      subdatasets is opened. For files opened in read-only mode, we   */
+/*      keep the resulting display level / location information in a   */
+/*      process-wide cache keyed by filename. The segment subheaders    */
+/*      are still read at each opening, and their content compared      */
+/*      with the cached one, so a rewritten file is never served stale  */
+/*      values, whatever its size and modification time.               */
+/************************************************************************/
+
+namespace
+{
+struct NITFSegmentLocation
+{
+    int nDLVL = 0;
+    int nALVL = 0;
+    int nLOC_R = 0;
+    int nLOC_C = 0;
+    int nCCS_R = 0;
+    int nCCS_C = 0;
+};
+
+struct NITFSegmentLocations
+{
+    size_t nSubheadersSize = 0;
+    size_t nSubheadersHash = 0;
+    std::vector<NITFSegmentLocation> asLocations{};
+};
+}  // namespace
+
+static std::mutex gNITFSegmentCacheMutex;
+
+static lru11::Cache<std::string, std::shared_ptr<NITFSegmentLocations>> &
+GetNITFSegmentCache()
+{
+    static lru11::Cache<std::string, std::shared_ptr<NITFSegmentLocations>>
+        oCache(64);
+    return oCache;
+}
+
+/* Concatenate the layout and subheader content of all segments. */
+static bool NITFReadSegmentSubheaders(NITFFile *psFile, std::string &osContent)
+{
+    for (int i = 0; i < psFile->nSegmentCount; i++)
+    {
+        const NITFSegmentInfo *psSegInfo = psFile->pasSegmentInfo + i;
+        osContent += CPLSPrintf(
+            "%s|" CPL_FRMT_GUIB "|%u|" CPL_FRMT_GUIB "|" CPL_FRMT_GUIB "|",
+            psSegInfo->szSegmentType, psSegInfo->nSegmentHeaderStart,
+            psSegInfo->nSegmentHeaderSize, psSegInfo->nSegmentStart,
+            psSegInfo->nSegmentSize);
+        const size_t nOffset = osContent.size();
+        try
+        {
+            osContent.resize(nOffset + psSegInfo->nSegmentHeaderSize);
+        }
+        catch (const std::exception &)
+        {
+            return false;
+        }
+        if (psSegInfo->nSegmentHeaderSize > 0 &&
+            (VSIFSeekL(psFile->fp, psSegInfo->nSegmentHeaderStart, SEEK_SET) !=
+                 0 ||
+             VSIFReadL(&osContent[nOffset], 1, psSegInfo->nSegmentHeaderSize,
+                       psFile->fp) != psSegInfo->nSegmentHeaderSize))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void NITFCollectAttachmentsCached(NITFFile *psFile,
+                                         const char *pszFilename,
+                                         bool bReadOnly)
+{
+    std::string osKey;
+    size_t nSubheadersSize = 0;
+    size_t nSubheadersHash = 0;
+    if (bReadOnly && psFile->nSegmentCount > 1)
+    {
+        std::string osContent;
+        if (NITFReadSegmentSubheaders(psFile, osContent))
+        {
+            osKey = pszFilename;
+            nSubheadersSize = osContent.size();
+            nSubheadersHash = std::hash<std::string>{}(osContent);
+        }
+    }
+
+    if (!osKey.empty())
+    {
+        std::shared_ptr<NITFSegmentLocations> poLocations;
+        {
+            std::lock_guard<std::mutex> oLock(gNITFSegmentCacheMutex);
+            GetNITFSegmentCache().tryGet(osKey, poLocations);
+        }
+        if (poLocations && poLocations->nSubheadersSize == nSubheadersSize &&
+            poLocations->nSubheadersHash == nSubheadersHash &&
+            poLocations->asLocations.size() ==
+                static_cast<size_t>(psFile->nSegmentCount))
+        {
+            for (int i = 0; i < psFile->nSegmentCount; i++)
+            {
+                NITFSegmentInfo *psSegInfo = psFile->pasSegmentInfo + i;
+                const NITFSegmentLocation &sLoc = poLocations->asLocations[i];
+                psSegInfo->nDLVL = sLoc.nDLVL;
+                psSegInfo->nALVL = sLoc.nALVL;
+                psSegInfo->nLOC_R = sLoc.nLOC_R;
+                psSegInfo->nLOC_C = sLoc.nLOC_C;
+                psSegInfo->nCCS_R = sLoc.nCCS_R;
+                psSegInfo->nCCS_C = sLoc.nCCS_C;
+            }
+            return;
+        }
+    }
+
+    const bool bOK = CPL_TO_BOOL(NITFCollectAttachments(psFile));
+    NITFReconcileAttachments(psFile);
+
+    if (bOK && !osKey.empty())
+    {
+        auto poLocations = std::make_shared<NITFSegmentLocations>();
+        poLocations->nSubheadersSize = nSubheadersSize;
+        poLocations->nSubheadersHash = nSubheadersHash;
+        poLocations->asLocations.resize(
+            static_cast<size_t>(psFile->nSegmentCount));
+        for (int i = 0; i < psFile->nSegmentCount; i++)
+        {
+            const NITFSegmentInfo *psSegInfo = psFile->pasSegmentInfo + i;
+            NITFSegmentLocation &sLoc = poLocations->asLocations[i];
+            sLoc.nDLVL = psSegInfo->nDLVL;
+            sLoc.nALVL = psSegInfo->nALVL;
+            sLoc.nLOC_R = psSegInfo->nLOC_R;
+            sLoc.nLOC_C = psSegInfo->nLOC_C;
+            sLoc.nCCS_R = psSegInfo->nCCS_R;
+            sLoc.nCCS_C = psSegInfo->nCCS_C;
+        }
+        std::lock_guard<std::mutex> oLock(gNITFSegmentCacheMutex);
+        GetNITFSegmentCache().insert(osKey, std::move(poLocations));
+    }
+}
+
 /************************************************************************/
 /*                                Open()                                */
 /************************************************************************/
@@ -461,8 +612,8 @@ NITFDataset *NITFDataset::OpenInternal(GDALOpenInfo *poOpenInfo,
 
     if (!bOpenForCreate)
     {
-        NITFCollectAttachments(psFile);
-        NITFReconcileAttachments(psFile);
+        NITFCollectAttachmentsCached(psFile, pszFilename,
+                                     poOpenInfo->eAccess == GA_ReadOnly);
     }
 
     /* -------------------------------------------------------------------- */
@@ -2108,11 +2259,33 @@ CPLErr NITFDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                                        pData, nBufXSize, nBufYSize, eBufType,
                                        nBandCount, panBandMap, nPixelSpace,
                                        nLineSpace, nBandSpace, psExtraArg);
-    else
-        return GDALDataset::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
-                                      pData, nBufXSize, nBufYSize, eBufType,
-                                      nBandCount, panBandMap, nPixelSpace,
-                                      nLineSpace, nBandSpace, psExtraArg);
+
+    /* -------------------------------------------------------------------- */
+    /*      For JPEG compressed images made of several blocks, decode the   */
+    /*      blocks intersecting the request in parallel beforehand.         */
+    /* -------------------------------------------------------------------- */
+    if (eRWFlag == GF_Read && psImage != nullptr &&
+        (EQUAL(psImage->szIC, "C3") || EQUAL(psImage->szIC, "M3")) &&
+        psImage->nBlocksPerRow * psImage->nBlocksPerColumn > 1 &&
+        nXSize == nBufXSize && nYSize == nBufYSize)
+    {
+        const int nBlockXStart = nXOff / psImage->nBlockWidth;
+        const int nBlockXEnd = (nXOff + nXSize - 1) / psImage->nBlockWidth;
+        const int nBlockYStart = nYOff / psImage->nBlockHeight;
+        const int nBlockYEnd = (nYOff + nYSize - 1) / psImage->nBlockHeight;
+        std::vector<int> anBlocks;
+        for (int iY = nBlockYStart; iY <= nBlockYEnd; iY++)
+        {
+            for (int iX = nBlockXStart; iX <= nBlockXEnd; iX++)
+                anBlocks.push_back(iX + iY * psImage->nBlocksPerRow);
+        }
+        PrefetchJPEGBlocks(anBlocks, -1);
+    }
+
+    return GDALDataset::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize, pData,
+                                  nBufXSize, nBufYSize, eBufType, nBandCount,
+                                  panBandMap, nPixelSpace, nLineSpace,
+                                  nBandSpace, psExtraArg);
 }
 
 /************************************************************************/
@@ -3682,71 +3855,128 @@ CPLErr NITFDataset::ScanJPEGBlocks()
 }
 
 /************************************************************************/
-/*                           ReadJPEGBlock()                            */
+/*                        LoadJPEGBlockOffsets()                        */
 /************************************************************************/
 
-CPLErr NITFDataset::ReadJPEGBlock(int iBlockX, int iBlockY)
+CPLErr NITFDataset::LoadJPEGBlockOffsets()
 
 {
-    CPLErr eErr;
+    if (panJPEGBlockOffset != nullptr)
+        return CE_None;
 
-    /* -------------------------------------------------------------------- */
-    /*      If this is our first request, do a scan for block boundaries.   */
-    /* -------------------------------------------------------------------- */
-    if (panJPEGBlockOffset == nullptr)
+    if (EQUAL(psImage->szIC, "M3"))
     {
-        if (EQUAL(psImage->szIC, "M3"))
+        /* ---------------------------------------------------------------- */
+        /*      When a data mask subheader is present, we don't need to     */
+        /*      scan the whole file. We just use the                        */
+        /*      psImage->panBlockStart table                                */
+        /* ---------------------------------------------------------------- */
+        panJPEGBlockOffset = reinterpret_cast<GIntBig *>(VSI_CALLOC_VERBOSE(
+            sizeof(GIntBig), static_cast<size_t>(psImage->nBlocksPerRow) *
+                                 psImage->nBlocksPerColumn));
+        if (panJPEGBlockOffset == nullptr)
         {
-            /* --------------------------------------------------------------------
-             */
-            /*      When a data mask subheader is present, we don't need to scan
-             */
-            /*      the whole file. We just use the psImage->panBlockStart table
-             */
-            /* --------------------------------------------------------------------
-             */
-            panJPEGBlockOffset = reinterpret_cast<GIntBig *>(VSI_CALLOC_VERBOSE(
-                sizeof(GIntBig), static_cast<size_t>(psImage->nBlocksPerRow) *
-                                     psImage->nBlocksPerColumn));
-            if (panJPEGBlockOffset == nullptr)
-            {
-                return CE_Failure;
-            }
-            for (int i = 0;
-                 i < psImage->nBlocksPerRow * psImage->nBlocksPerColumn; i++)
+            return CE_Failure;
+        }
+        for (int i = 0; i < psImage->nBlocksPerRow * psImage->nBlocksPerColumn;
+             i++)
+        {
+            panJPEGBlockOffset[i] = psImage->panBlockStart[i];
+            if (panJPEGBlockOffset[i] != -1 &&
+                panJPEGBlockOffset[i] != UINT_MAX)
             {
-                panJPEGBlockOffset[i] = psImage->panBlockStart[i];
-                if (panJPEGBlockOffset[i] != -1 &&
-                    panJPEGBlockOffset[i] != UINT_MAX)
+                GUIntBig nOffset = panJPEGBlockOffset[i];
+                bool bError = false;
+                nQLevel = ScanJPEGQLevel(&nOffset, &bError);
+                /* The beginning of the JPEG stream should be the offset */
+                /* from the panBlockStart table */
+                if (bError || nOffset != (GUIntBig)panJPEGBlockOffset[i])
                 {
-                    GUIntBig nOffset = panJPEGBlockOffset[i];
-                    bool bError = false;
-                    nQLevel = ScanJPEGQLevel(&nOffset, &bError);
-                    /* The beginning of the JPEG stream should be the offset */
-                    /* from the panBlockStart table */
-                    if (bError || nOffset != (GUIntBig)panJPEGBlockOffset[i])
-                    {
-                        CPLError(CE_Failure, CPLE_AppDefined,
-                                 "JPEG block doesn't start at expected offset");
-                        return CE_Failure;
-                    }
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "JPEG block doesn't start at expected offset");
+                    return CE_Failure;
                 }
             }
         }
-        else /* 'C3' case */
-        {
-            /* --------------------------------------------------------------------
-             */
-            /*      Scan through the whole image data stream identifying all */
-            /*      block boundaries. */
-            /* --------------------------------------------------------------------
-             */
-            eErr = ScanJPEGBlocks();
-            if (eErr != CE_None)
-                return eErr;
-        }
+        return CE_None;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      'C3' case: scan through the whole image data stream             */
+    /*      identifying all block boundaries.                               */
+    /* -------------------------------------------------------------------- */
+    return ScanJPEGBlocks();
+}
+
+/************************************************************************/
+/*                          DecodeJPEGBlock()                           */
+/*                                                                      */
+/*      Decode the JPEG stream of a block into pabyBuffer (band         */
+/*      sequential). Does not use any state of the NITFDataset, so      */
+/*      that it can be called from worker threads.                      */
+/************************************************************************/
+
+static CPLErr DecodeJPEGBlock(const std::string &osNITFFilename, int nQLevel,
+                              GIntBig nOffset, int iBlock, int nBlockWidth,
+                              int nBlockHeight, int nBands, GDALDataType eDT,
+                              GByte *pabyBuffer)
+{
+    CPLString osFilename;
+    osFilename.Printf("JPEG_SUBFILE:Q%d," CPL_FRMT_GIB ",%d,%s", nQLevel,
+                      nOffset, 0, osNITFFilename.c_str());
+
+    auto poDS = std::unique_ptr<GDALDataset>(
+        GDALDataset::FromHandle(GDALOpen(osFilename, GA_ReadOnly)));
+    if (poDS == nullptr)
+        return CE_Failure;
+
+    if (poDS->GetRasterXSize() != nBlockWidth ||
+        poDS->GetRasterYSize() != nBlockHeight)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "JPEG block %d not same size as NITF blocksize.", iBlock);
+        return CE_Failure;
+    }
+
+    if (poDS->GetRasterCount() < nBands)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "JPEG block %d has not enough bands.", iBlock);
+        return CE_Failure;
+    }
+
+    if (poDS->GetRasterBand(1)->GetRasterDataType() != eDT)
+    {
+        CPLError(
+            CE_Failure, CPLE_AppDefined,
+            "JPEG block %d data type (%s) not consistent with band data type "
+            "(%s).",
+            iBlock,
+            GDALGetDataTypeName(poDS->GetRasterBand(1)->GetRasterDataType()),
+            GDALGetDataTypeName(eDT));
+        return CE_Failure;
+    }
+
+    int anBands[3] = {1, 2, 3};
+    return poDS->RasterIO(GF_Read, 0, 0, nBlockWidth, nBlockHeight,
+                          pabyBuffer, nBlockWidth, nBlockHeight, eDT, nBands,
+                          anBands, 0, 0, 0, nullptr);
+}
+
+/************************************************************************/
+/*                           ReadJPEGBlock()                            */
+/************************************************************************/
+
+CPLErr NITFDataset::ReadJPEGBlock(int iBlockX, int iBlockY)
+
+{
+    /* -------------------------------------------------------------------- */
+    /*      If this is our first request, do a scan for block boundaries.   */
+    /* -------------------------------------------------------------------- */
+    CPLErr eErr = LoadJPEGBlockOffsets();
+    if (eErr != CE_None)
+        return eErr;
+
     /* -------------------------------------------------------------------- */
     /*    Allocate image data block (where the uncompressed image will go)  */
     /* -------------------------------------------------------------------- */
@@ -3763,10 +3993,17 @@ CPLErr NITFDataset::ReadJPEGBlock(int iBlockX, int iBlockY)
     }
 
     /* -------------------------------------------------------------------- */
-    /*      Read JPEG Chunk.                                                */
+    /*      The block may already have been decoded when reading the        */
+    /*      other bands, or by PrefetchJPEGBlocks().                        */
     /* -------------------------------------------------------------------- */
     const int iBlock = iBlockX + iBlockY * psImage->nBlocksPerRow;
+    if (iBlock == m_nLoadedJPEGBlock)
+        return CE_None;
+    m_nLoadedJPEGBlock = -1;
 
+    /* -------------------------------------------------------------------- */
+    /*      Read JPEG Chunk.                                                */
+    /* -------------------------------------------------------------------- */
     if (panJPEGBlockOffset[iBlock] == -1 ||
         panJPEGBlockOffset[iBlock] == UINT_MAX)
     {
@@ -3776,56 +4013,233 @@ CPLErr NITFDataset::ReadJPEGBlock(int iBlockX, int iBlockY)
         return CE_None;
     }
 
-    CPLString osFilename;
-    osFilename.Printf("JPEG_SUBFILE:Q%d," CPL_FRMT_GIB ",%d,%s", nQLevel,
-                      panJPEGBlockOffset[iBlock], 0, osNITFFilename.c_str());
+    eErr = DecodeJPEGBlock(osNITFFilename, nQLevel, panJPEGBlockOffset[iBlock],
+                           iBlock, psImage->nBlockWidth, psImage->nBlockHeight,
+                           psImage->nBands,
+                           GetRasterBand(1)->GetRasterDataType(),
+                           pabyJPEGBlock);
+    if (eErr == CE_None)
+        m_nLoadedJPEGBlock = iBlock;
 
-    GDALDataset *poDS =
-        GDALDataset::FromHandle(GDALOpen(osFilename, GA_ReadOnly));
-    if (poDS == nullptr)
-        return CE_Failure;
+    return eErr;
+}
 
-    if (poDS->GetRasterXSize() != psImage->nBlockWidth ||
-        poDS->GetRasterYSize() != psImage->nBlockHeight)
+/************************************************************************/
+/*                      GetJPEGDecodeThreadCount()                      */
+/************************************************************************/
+
+static int GetJPEGDecodeThreadCount()
+{
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszNumThreads == nullptr)
+        return 1;
+    return std::min(128, EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : std::max(1, atoi(pszNumThreads)));
+}
+
+/************************************************************************/
+/*                         PrefetchJPEGBlocks()                         */
+/*                                                                      */
+/*      Decode in parallel, with GDAL_NUM_THREADS worker threads, the   */
+/*      blocks of anBlocks that are not yet in the block cache, and     */
+/*      store them in the block cache of all bands. If iCurrentBlock    */
+/*      is not -1, it is decoded as well, into pabyJPEGBlock, for the   */
+/*      benefit of the pending IReadBlock() call. Returns false if      */
+/*      nothing was done.                                               */
+/************************************************************************/
+
+bool NITFDataset::PrefetchJPEGBlocks(const std::vector<int> &anBlocks,
+                                     int iCurrentBlock)
+
+{
+    const int nThreads = GetJPEGDecodeThreadCount();
+    if (nThreads <= 1 || LoadJPEGBlockOffsets() != CE_None)
+        return false;
+
+    if (pabyJPEGBlock == nullptr)
     {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "JPEG block %d not same size as NITF blocksize.", iBlock);
-        delete poDS;
-        return CE_Failure;
+        pabyJPEGBlock = reinterpret_cast<GByte *>(VSI_CALLOC_VERBOSE(
+            psImage->nBands, static_cast<size_t>(psImage->nBlockWidth) *
+                                 psImage->nBlockHeight * 2));
+        if (pabyJPEGBlock == nullptr)
+            return false;
     }
 
-    if (poDS->GetRasterCount() < psImage->nBands)
+    const GDALDataType eDT = GetRasterBand(1)->GetRasterDataType();
+    const size_t nBandBlockSize = static_cast<size_t>(psImage->nBlockWidth) *
+                                  psImage->nBlockHeight *
+                                  GDALGetDataTypeSizeBytes(eDT);
+    const size_t nBlockSize = nBandBlockSize * psImage->nBands;
+
+    // Do not decode more blocks than what the block cache can reasonably hold
+    const size_t nMaxBlocks = static_cast<size_t>(std::max<GIntBig>(
+        1, GDALGetCacheMax64() / 4 / static_cast<GIntBig>(nBlockSize)));
+
+    struct JPEGDecodeJob
+    {
+        const std::string *posNITFFilename = nullptr;
+        int nQLevel = 0;
+        GIntBig nOffset = 0;
+        int iBlock = 0;
+        int nBlockWidth = 0;
+        int nBlockHeight = 0;
+        int nBands = 0;
+        GDALDataType eDT = GDT_Byte;
+        GByte *pabyBuffer = nullptr;
+        std::vector<GByte> abyBuffer{};
+        bool bOK = false;
+
+        static void Func(void *pData)
+        {
+            auto psJob = static_cast<JPEGDecodeJob *>(pData);
+            CPLPushErrorHandler(CPLQuietErrorHandler);
+            psJob->bOK =
+                DecodeJPEGBlock(*(psJob->posNITFFilename), psJob->nQLevel,
+                                psJob->nOffset, psJob->iBlock,
+                                psJob->nBlockWidth, psJob->nBlockHeight,
+                                psJob->nBands, psJob->eDT,
+                                psJob->pabyBuffer) == CE_None;
+            CPLPopErrorHandler();
+        }
+    };
+
+    const auto HasData = [this](int iBlock)
+    {
+        return panJPEGBlockOffset[iBlock] != -1 &&
+               panJPEGBlockOffset[iBlock] != UINT_MAX;
+    };
+
+    std::vector<JPEGDecodeJob> asJobs;
+    const auto AddJob = [&](int iBlock, GByte *pabyBuffer)
+    {
+        JPEGDecodeJob sJob;
+        sJob.posNITFFilename = &osNITFFilename;
+        sJob.nQLevel = nQLevel;
+        sJob.nOffset = panJPEGBlockOffset[iBlock];
+        sJob.iBlock = iBlock;
+        sJob.nBlockWidth = psImage->nBlockWidth;
+        sJob.nBlockHeight = psImage->nBlockHeight;
+        sJob.nBands = psImage->nBands;
+        sJob.eDT = eDT;
+        sJob.pabyBuffer = pabyBuffer;
+        asJobs.emplace_back(std::move(sJob));
+    };
+
+    if (iCurrentBlock >= 0 && iCurrentBlock != m_nLoadedJPEGBlock &&
+        HasData(iCurrentBlock))
+    {
+        m_nLoadedJPEGBlock = -1;
+        AddJob(iCurrentBlock, pabyJPEGBlock);
+    }
+
+    GDALRasterBand *poFirstBand = GetRasterBand(1);
+    for (int iBlock : anBlocks)
+    {
+        if (asJobs.size() >= nMaxBlocks)
+            break;
+        if (iBlock == iCurrentBlock || !HasData(iBlock))
+            continue;
+        GDALRasterBlock *poBlock = poFirstBand->TryGetLockedBlockRef(
+            iBlock % psImage->nBlocksPerRow, iBlock / psImage->nBlocksPerRow);
+        if (poBlock)
+        {
+            poBlock->DropLock();
+            continue;
+        }
+        AddJob(iBlock, nullptr);
+    }
+
+    if (asJobs.size() < 2)
+        return false;
+
+    for (auto &sJob : asJobs)
     {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "JPEG block %d has not enough bands.", iBlock);
-        delete poDS;
-        return CE_Failure;
+        if (sJob.pabyBuffer != nullptr)
+            continue;
+        try
+        {
+            sJob.abyBuffer.resize(nBlockSize);
+            sJob.pabyBuffer = sJob.abyBuffer.data();
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in PrefetchJPEGBlocks()");
+            return false;
+        }
     }
 
-    if (poDS->GetRasterBand(1)->GetRasterDataType() !=
-        GetRasterBand(1)->GetRasterDataType())
+    CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(nThreads);
+    if (poPool == nullptr)
+        return false;
+    auto poQueue = poPool->CreateJobQueue();
+    for (auto &sJob : asJobs)
+        poQueue->SubmitJob(JPEGDecodeJob::Func, &sJob);
+    poQueue->WaitCompletion();
+
+    for (const auto &sJob : asJobs)
     {
-        CPLError(
-            CE_Failure, CPLE_AppDefined,
-            "JPEG block %d data type (%s) not consistent with band data type "
-            "(%s).",
-            iBlock,
-            GDALGetDataTypeName(poDS->GetRasterBand(1)->GetRasterDataType()),
-            GDALGetDataTypeName(GetRasterBand(1)->GetRasterDataType()));
-        delete poDS;
-        return CE_Failure;
+        if (!sJob.bOK)
+            continue;
+        if (sJob.pabyBuffer == pabyJPEGBlock)
+        {
+            m_nLoadedJPEGBlock = sJob.iBlock;
+            continue;
+        }
+        const int nBlockX = sJob.iBlock % psImage->nBlocksPerRow;
+        const int nBlockY = sJob.iBlock / psImage->nBlocksPerRow;
+        for (int iBand = 0; iBand < psImage->nBands; iBand++)
+        {
+            GDALRasterBlock *poBlock =
+                GetRasterBand(iBand + 1)->GetLockedBlockRef(nBlockX, nBlockY,
+                                                            TRUE);
+            if (poBlock == nullptr)
+                continue;
+            memcpy(poBlock->GetDataRef(),
+                   sJob.pabyBuffer + iBand * nBandBlockSize, nBandBlockSize);
+            poBlock->DropLock();
+        }
     }
 
-    int anBands[3] = {1, 2, 3};
-    eErr = poDS->RasterIO(GF_Read, 0, 0, psImage->nBlockWidth,
-                          psImage->nBlockHeight, pabyJPEGBlock,
-                          psImage->nBlockWidth, psImage->nBlockHeight,
-                          GetRasterBand(1)->GetRasterDataType(),
-                          psImage->nBands, anBands, 0, 0, 0, nullptr);
+    return true;
+}
 
-    delete poDS;
+/************************************************************************/
+/*                    PrefetchSequentialJPEGBlocks()                    */
+/*                                                                      */
+/*      Called from IReadBlock() before ReadJPEGBlock(). When blocks    */
+/*      are read in raster order, decode the next ones in parallel      */
+/*      together with the requested one.                                */
+/************************************************************************/
 
-    return eErr;
+void NITFDataset::PrefetchSequentialJPEGBlocks(int iBlockX, int iBlockY)
+
+{
+    const int iBlock = iBlockX + iBlockY * psImage->nBlocksPerRow;
+
+    // Other bands of the block that has just been decoded.
+    if (iBlock == m_nLoadedJPEGBlock)
+        return;
+
+    const int nBlocks = psImage->nBlocksPerRow * psImage->nBlocksPerColumn;
+    const int nThreads = GetJPEGDecodeThreadCount();
+    if (iBlock != m_nLastReadJPEGBlock + 1 || iBlock + 1 >= nBlocks ||
+        nThreads <= 1)
+    {
+        m_nLastReadJPEGBlock = iBlock;
+        return;
+    }
+
+    const int iLastBlock = std::min(nBlocks - 1, iBlock + 2 * nThreads - 1);
+    std::vector<int> anBlocks;
+    for (int i = iBlock + 1; i <= iLastBlock; i++)
+        anBlocks.push_back(i);
+
+    // The prefetched blocks will be served from the block cache, so
+    // the next call is expected for the block following them.
+    m_nLastReadJPEGBlock =
+        PrefetchJPEGBlocks(anBlocks, iBlock) ? iLastBlock : iBlock;
 }
 
 /************************************************************************/
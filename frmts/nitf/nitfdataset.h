@@ -39,6 +39,7 @@
 #include "ogr_spatialref.h"
 #include "gdal_proxy.h"
 #include <map>
+#include <vector>
 
 CPLErr NITFSetColorInterpretation(NITFImage *psImage, int nBand,
                                   GDALColorInterp eInterp);
@@ -107,9 +108,16 @@ class NITFDataset final : public GDALPamDataset
     GByte *pabyJPEGBlock;
     int nQLevel;
 
+    int m_nLoadedJPEGBlock = -1;
+    int m_nLastReadJPEGBlock = -1;
+
     int ScanJPEGQLevel(GUIntBig *pnDataStart, bool *pbError);
     CPLErr ScanJPEGBlocks();
+    CPLErr LoadJPEGBlockOffsets();
     CPLErr ReadJPEGBlock(int, int);
+    bool PrefetchJPEGBlocks(const std::vector<int> &anBlocks,
+                            int iCurrentBlock);
+    void PrefetchSequentialJPEGBlocks(int iBlockX, int iBlockY);
     void CheckGeoSDEInfo();
     char **AddFile(char **papszFileList, const char *EXTENSION,
                    const char *extension);
@@ -510,6 +510,8 @@ CPLErr NITFRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff, void *pImage)
     /* -------------------------------------------------------------------- */
     if (EQUAL(psImage->szIC, "C3") || EQUAL(psImage->szIC, "M3"))
     {
+        poGDS->PrefetchSequentialJPEGBlocks(nBlockXOff, nBlockYOff);
+
         CPLErr eErr = poGDS->ReadJPEGBlock(nBlockXOff, nBlockYOff);
         const int nBlockBandSize = psImage->nBlockWidth *
                                    psImage->nBlockHeight *
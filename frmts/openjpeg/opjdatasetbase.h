@@ -187,6 +187,78 @@ static int64_t JP2Dataset_Skip(int64_t nBytes, void *pUserData)
     return nBytes;
 }
 
+/************************************************************************/
+/*                      JP2Dataset_ReadTile()                           */
+/************************************************************************/
+
+static size_t JP2Dataset_ReadTile(void *pBuffer, size_t nBytes,
+                                  void *pUserData)
+{
+    JP2TileFile *psTileFile = static_cast<JP2TileFile *>(pUserData);
+    GByte *pabyBuffer = static_cast<GByte *>(pBuffer);
+    size_t nRet = 0;
+    vsi_l_offset nSegmentStart = 0;
+    for (const auto &oSegment : psTileFile->aoSegments)
+    {
+        if (nRet == nBytes)
+            break;
+        const vsi_l_offset nSegmentEnd = nSegmentStart + oSegment.second;
+        if (psTileFile->nPos >= nSegmentStart &&
+            psTileFile->nPos < nSegmentEnd)
+        {
+            const vsi_l_offset nOffsetInSegment =
+                psTileFile->nPos - nSegmentStart;
+            const size_t nToRead = static_cast<size_t>(std::min<vsi_l_offset>(
+                nBytes - nRet, oSegment.second - nOffsetInSegment));
+            if (VSIFSeekL(psTileFile->fp_,
+                          psTileFile->nBaseOffset + oSegment.first +
+                              nOffsetInSegment,
+                          SEEK_SET) != 0)
+                break;
+            const size_t nRead = static_cast<size_t>(
+                VSIFReadL(pabyBuffer + nRet, 1, nToRead, psTileFile->fp_));
+            nRet += nRead;
+            psTileFile->nPos += nRead;
+            if (nRead != nToRead)
+                break;
+        }
+        nSegmentStart = nSegmentEnd;
+    }
+#ifdef DEBUG_IO
+    CPLDebug(OPJCodecWrapper::debugId(),
+             "JP2Dataset_ReadTile(" CPL_FRMT_GUIB ") = " CPL_FRMT_GUIB,
+             static_cast<GUIntBig>(nBytes), static_cast<GUIntBig>(nRet));
+#endif
+    if (nRet == 0)
+        nRet = static_cast<size_t>(-1);
+
+    return nRet;
+}
+
+/************************************************************************/
+/*                      JP2Dataset_SeekTile()                           */
+/************************************************************************/
+
+static OPJ_BOOL JP2Dataset_SeekTile(int64_t nBytes, void *pUserData)
+{
+    JP2TileFile *psTileFile = static_cast<JP2TileFile *>(pUserData);
+    if (nBytes < 0 || static_cast<vsi_l_offset>(nBytes) > psTileFile->nSize)
+        return FALSE;
+    psTileFile->nPos = static_cast<vsi_l_offset>(nBytes);
+    return TRUE;
+}
+
+/************************************************************************/
+/*                      JP2Dataset_SkipTile()                           */
+/************************************************************************/
+
+static int64_t JP2Dataset_SkipTile(int64_t nBytes, void *pUserData)
+{
+    JP2TileFile *psTileFile = static_cast<JP2TileFile *>(pUserData);
+    psTileFile->nPos += nBytes;
+    return nBytes;
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                           OPJCodecWrapper                            */
@@ -197,18 +269,20 @@ struct OPJCodecWrapper
 {
     OPJCodecWrapper(void)
         : pCodec(nullptr), pStream(nullptr), psImage(nullptr),
-          pasBandParams(nullptr), psJP2File(nullptr)
+          pasBandParams(nullptr), psJP2File(nullptr), psTileFile(nullptr)
     {
     }
     explicit OPJCodecWrapper(OPJCodecWrapper *rhs)
         : pCodec(rhs->pCodec), pStream(rhs->pStream), psImage(rhs->psImage),
-          pasBandParams(rhs->pasBandParams), psJP2File(rhs->psJP2File)
+          pasBandParams(rhs->pasBandParams), psJP2File(rhs->psJP2File),
+          psTileFile(rhs->psTileFile)
     {
         rhs->pCodec = nullptr;
         rhs->pStream = nullptr;
         rhs->psImage = nullptr;
         rhs->pasBandParams = nullptr;
         rhs->psJP2File = nullptr;
+        rhs->psTileFile = nullptr;
     }
     ~OPJCodecWrapper(void)
     {
@@ -228,6 +302,23 @@ struct OPJCodecWrapper
         psJP2File->nBaseOffset = VSIFTellL(fp);
     }
 
+    // Opens a virtual codestream restricted to the tile-parts of one tile
+    void openTile(VSILFILE *fp, vsi_l_offset offset,
+                  const JP2TilePartIndex &oIndex,
+                  const std::vector<JP2TilePartIndex::Segment> &aoTileParts)
+    {
+        psTileFile = new JP2TileFile();
+        psTileFile->fp_ = fp;
+        psTileFile->nBaseOffset = offset;
+        psTileFile->aoSegments.push_back(oIndex.GetMainHeader());
+        psTileFile->aoSegments.insert(psTileFile->aoSegments.end(),
+                                      aoTileParts.begin(), aoTileParts.end());
+        if (oIndex.GetEOC().second)
+            psTileFile->aoSegments.push_back(oIndex.GetEOC());
+        for (const auto &oSegment : psTileFile->aoSegments)
+            psTileFile->nSize += oSegment.second;
+    }
+
     void transfer(OPJCodecWrapper *rhs)
     {
         pCodec = rhs->pCodec;
@@ -311,6 +402,9 @@ struct OPJCodecWrapper
 
         CPLFree(psJP2File);
         psJP2File = nullptr;
+
+        delete psTileFile;
+        psTileFile = nullptr;
     }
 
     static bool preferPerBlockDeCompress(void)
@@ -748,11 +842,33 @@ struct OPJCodecWrapper
         return pStream;
     }
 
+    /************************************************************************/
+    /*                    CreateTileReadStream()                            */
+    /************************************************************************/
+    static jp2_stream *CreateTileReadStream(JP2TileFile *psTileFile)
+    {
+        if (!psTileFile)
+            return nullptr;
+        auto pStream = opj_stream_create(1024, TRUE);
+        if (pStream == nullptr)
+            return nullptr;
+
+        opj_stream_set_user_data_length(pStream, psTileFile->nSize);
+
+        opj_stream_set_read_function(pStream, JP2Dataset_ReadTile);
+        opj_stream_set_seek_function(pStream, JP2Dataset_SeekTile);
+        opj_stream_set_skip_function(pStream, JP2Dataset_SkipTile);
+        opj_stream_set_user_data(pStream, psTileFile, nullptr);
+
+        return pStream;
+    }
+
     jp2_codec *pCodec;
     jp2_stream *pStream;
     jp2_image *psImage;
     jp2_image_comp_param *pasBandParams;
     JP2File *psJP2File;
+    JP2TileFile *psTileFile;
 };
 
 /************************************************************************/
@@ -843,11 +959,27 @@ struct JP2OPJDatasetBase : public JP2DatasetBase
                 opj_decoder_set_strict_mode(codec->pCodec, false);
             }
 #endif
+            const std::vector<JP2TilePartIndex::Segment> *paoTileParts =
+                nullptr;
+            if (!bUseSetDecodeArea && m_poTilePartIndex &&
+                m_poTilePartIndex->Build(fpIn, nCodeStreamStart,
+                                         nCodeStreamLength))
+            {
+                paoTileParts = m_poTilePartIndex->GetTileParts(nTileNumber);
+            }
+
             if (m_codec && m_codec->psJP2File)
             {
                 codec->pStream = OPJCodecWrapper::CreateReadStream(
                     m_codec->psJP2File, nCodeStreamLength);
             }
+            else if (paoTileParts)
+            {
+                codec->openTile(fpIn, nCodeStreamStart, *m_poTilePartIndex,
+                                *paoTileParts);
+                codec->pStream =
+                    OPJCodecWrapper::CreateTileReadStream(codec->psTileFile);
+            }
             else
             {
                 codec->open(fpIn, nCodeStreamStart);
@@ -45,6 +45,116 @@
 
 #include "jp2opjlikedataset.h"
 
+/************************************************************************/
+/*                     JP2TilePartIndex::Build()                        */
+/************************************************************************/
+
+bool JP2TilePartIndex::Build(VSILFILE *fp, vsi_l_offset nCodeStreamStart,
+                             vsi_l_offset nCodeStreamLength)
+{
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    if (!m_bBuilt)
+    {
+        m_bBuilt = true;
+        m_bValid = BuildInternal(fp, nCodeStreamStart, nCodeStreamLength);
+        if (!m_bValid)
+            m_aaoTileParts.clear();
+        CPLDebug("JP2OPJLike", "Tile-part index %s",
+                 m_bValid ? "built" : "not usable");
+    }
+    return m_bValid;
+}
+
+/************************************************************************/
+/*                 JP2TilePartIndex::BuildInternal()                    */
+/************************************************************************/
+
+bool JP2TilePartIndex::BuildInternal(VSILFILE *fp,
+                                     vsi_l_offset nCodeStreamStart,
+                                     vsi_l_offset nCodeStreamLength)
+{
+    GByte abyBuffer[12];
+
+    // SOC marker
+    if (nCodeStreamLength < 2 ||
+        VSIFSeekL(fp, nCodeStreamStart, SEEK_SET) != 0 ||
+        VSIFReadL(abyBuffer, 2, 1, fp) != 1 || abyBuffer[0] != 0xFF ||
+        abyBuffer[1] != 0x4F)
+    {
+        return false;
+    }
+
+    // Walk through the markers of the main header until the first SOT
+    vsi_l_offset nPos = 2;
+    while (true)
+    {
+        if (nPos + 4 > nCodeStreamLength ||
+            VSIFSeekL(fp, nCodeStreamStart + nPos, SEEK_SET) != 0 ||
+            VSIFReadL(abyBuffer, 4, 1, fp) != 1 || abyBuffer[0] != 0xFF)
+        {
+            return false;
+        }
+        const GByte byMarker = abyBuffer[1];
+        if (byMarker == 0x90)  // SOT
+            break;
+        // TLM is used by the decoder itself to locate tile-parts, and
+        // PLM and PPM are related to the physical order of tile-parts, so
+        // the codestream cannot be presented with a different layout.
+        if (byMarker == 0x55 || byMarker == 0x57 || byMarker == 0x60)
+            return false;
+        const int nMarkerLength = (abyBuffer[2] << 8) | abyBuffer[3];
+        if (nMarkerLength < 2)
+            return false;
+        nPos += 2 + nMarkerLength;
+    }
+    m_nMainHeaderSize = nPos;
+
+    // Walk through the SOT markers of the tile-parts
+    size_t nTileParts = 0;
+    while (nPos < nCodeStreamLength)
+    {
+        const size_t nToRead = static_cast<size_t>(std::min<vsi_l_offset>(
+            sizeof(abyBuffer), nCodeStreamLength - nPos));
+        if (nToRead < 2 ||
+            VSIFSeekL(fp, nCodeStreamStart + nPos, SEEK_SET) != 0 ||
+            VSIFReadL(abyBuffer, nToRead, 1, fp) != 1 || abyBuffer[0] != 0xFF)
+        {
+            return false;
+        }
+        if (abyBuffer[1] == 0xD9)  // EOC
+        {
+            m_oEOC = Segment(nPos, 2);
+            break;
+        }
+        // SOT marker with Lsot = 10
+        if (nToRead < 12 || abyBuffer[1] != 0x90 || abyBuffer[2] != 0 ||
+            abyBuffer[3] != 10)
+        {
+            return false;
+        }
+        const int nTile = (abyBuffer[4] << 8) | abyBuffer[5];
+        vsi_l_offset nTilePartSize =
+            (static_cast<vsi_l_offset>(abyBuffer[6]) << 24) |
+            (abyBuffer[7] << 16) | (abyBuffer[8] << 8) | abyBuffer[9];
+        if (nTilePartSize == 0)
+        {
+            // Last tile-part, extending until the end of the codestream
+            nTilePartSize = nCodeStreamLength - nPos;
+        }
+        if (nTilePartSize < 14 || nTilePartSize > nCodeStreamLength - nPos ||
+            ++nTileParts > 65535 * 255)
+        {
+            return false;
+        }
+        if (static_cast<size_t>(nTile) >= m_aaoTileParts.size())
+            m_aaoTileParts.resize(nTile + 1);
+        m_aaoTileParts[nTile].emplace_back(nPos, nTilePartSize);
+        nPos += nTilePartSize;
+    }
+
+    return !m_aaoTileParts.empty();
+}
+
 /************************************************************************/
 /*                        JP2OPJLikeRasterBand()                        */
 /************************************************************************/
@@ -1466,6 +1576,16 @@ GDALDataset *JP2OPJLikeDataset<CODEC, BASE>::Open(GDALOpenInfo *poOpenInfo)
         }
     }
 
+    // For tiled codestreams decoded tile per tile, locate the tile-parts
+    // of each tile (at first block read), to spare the decoder a walk
+    // through the tile-parts of previous tiles.
+    if (!poDS->bUseSetDecodeArea && !poDS->bSingleTiled &&
+        CPLTestBool(
+            CPLGetConfigOption("JP2OPENJPEG_USE_TILE_PART_INDEX", "YES")))
+    {
+        poDS->m_poTilePartIndex = std::make_shared<JP2TilePartIndex>();
+    }
+
     GDALColorTable *poCT = nullptr;
 
     /* -------------------------------------------------------------------- */
@@ -1795,6 +1915,7 @@ GDALDataset *JP2OPJLikeDataset<CODEC, BASE>::Open(GDALOpenInfo *poOpenInfo)
             poODS->cache(poDS);
         }
         poODS->m_pnLastLevel = poDS->m_pnLastLevel;
+        poODS->m_poTilePartIndex = poDS->m_poTilePartIndex;
         poODS->m_bStrict = poDS->m_bStrict;
 
         poODS->m_nX0 = poDS->m_nX0;
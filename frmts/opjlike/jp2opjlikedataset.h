@@ -38,6 +38,11 @@
 #include "gdaljp2abstractdataset.h"
 #include "gdaljp2metadata.h"
 
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
 typedef int JP2_COLOR_SPACE;
 typedef int JP2_PROG_ORDER;
 
@@ -63,6 +68,76 @@ typedef struct
     vsi_l_offset nBaseOffset;
 } JP2File;
 
+/************************************************************************/
+/*                          JP2TilePartIndex                            */
+/************************************************************************/
+
+/** Location of the tile-parts of each tile of a codestream, collected by
+ * walking through its SOT markers once, so that decoding a tile does not
+ * require the decoder to skip over the tile-parts of all the previous tiles,
+ * which is costly on remote files.
+ *
+ * The index is built lazily, and shared between a dataset and its overviews.
+ */
+class JP2TilePartIndex
+{
+  public:
+    /** (offset relative to the start of the codestream, size) */
+    typedef std::pair<vsi_l_offset, vsi_l_offset> Segment;
+
+    /** Builds the index at first call, and returns whether it is usable. */
+    bool Build(VSILFILE *fp, vsi_l_offset nCodeStreamStart,
+               vsi_l_offset nCodeStreamLength);
+
+    /** Returns the main header (including the SOC marker) */
+    Segment GetMainHeader() const
+    {
+        return Segment(0, m_nMainHeaderSize);
+    }
+
+    /** Returns the tile-parts of a tile, in codestream order, or nullptr. */
+    const std::vector<Segment> *GetTileParts(int nTile) const
+    {
+        if (nTile < 0 || static_cast<size_t>(nTile) >= m_aaoTileParts.size() ||
+            m_aaoTileParts[nTile].empty())
+            return nullptr;
+        return &m_aaoTileParts[nTile];
+    }
+
+    /** Returns the location of the EOC marker, or a null size if missing */
+    Segment GetEOC() const
+    {
+        return m_oEOC;
+    }
+
+  private:
+    std::mutex m_oMutex{};
+    bool m_bBuilt = false;
+    bool m_bValid = false;
+    vsi_l_offset m_nMainHeaderSize = 0;
+    std::vector<std::vector<Segment>> m_aaoTileParts{};
+    Segment m_oEOC{0, 0};
+
+    bool BuildInternal(VSILFILE *fp, vsi_l_offset nCodeStreamStart,
+                       vsi_l_offset nCodeStreamLength);
+};
+
+/************************************************************************/
+/*                          JP2TileFile                                 */
+/************************************************************************/
+
+/** Virtual codestream made of the main header and of the tile-parts of a
+ * single tile (and of the EOC marker), as located by JP2TilePartIndex.
+ */
+struct JP2TileFile
+{
+    VSILFILE *fp_ = nullptr;
+    vsi_l_offset nBaseOffset = 0;
+    std::vector<JP2TilePartIndex::Segment> aoSegments{};
+    vsi_l_offset nSize = 0;
+    vsi_l_offset nPos = 0;
+};
+
 /************************************************************************/
 /* ==================================================================== */
 /*                           JP2DatasetBase                             */
@@ -117,6 +192,7 @@ struct JP2DatasetBase
     int m_nY0 = 0;
     uint32_t m_nTileWidth = 0;
     uint32_t m_nTileHeight = 0;
+    std::shared_ptr<JP2TilePartIndex> m_poTilePartIndex{};
 };
 
 /************************************************************************/
@@ -46,6 +46,8 @@
 
 #include <array>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <stack>
 #include <utility>
@@ -226,6 +228,20 @@ class PDFDataset final : public GDALPamDataset
 #endif
     std::vector<std::unique_ptr<PDFDataset>> m_apoOvrDS{};
     std::vector<std::unique_ptr<PDFDataset>> m_apoOvrDSBackup{};
+
+    // Datasets opened on the same page with the same options, used to render
+    // large requests tile by tile in worker threads, as a document handle
+    // cannot be used by several threads at once.
+    std::mutex m_oRenderingWorkersMutex{};
+    std::vector<std::unique_ptr<PDFDataset>> m_apoRenderingWorkers{};
+    bool m_bIsRenderingWorker = false;
+
+    std::unique_ptr<PDFDataset> AcquireRenderingWorker();
+    void ReleaseRenderingWorker(std::unique_ptr<PDFDataset> &&poWorker);
+    bool ReadPixelsMultiThreaded(int nReqXOff, int nReqYOff, int nReqXSize,
+                                 int nReqYSize, GSpacing nPixelSpace,
+                                 GSpacing nLineSpace, GSpacing nBandSpace,
+                                 GByte *pabyData, CPLErr &eErr);
     GDALPDFObject *m_poPageObj = nullptr;
 
     int m_iPage = -1;
@@ -37,6 +37,7 @@
 
 #include "cpl_vsi_virtual.h"
 #include "cpl_spawn.h"
+#include "cpl_worker_thread_pool.h"
 #include "cpl_string.h"
 #include "gdal_frmts.h"
 #include "ogr_spatialref.h"
@@ -52,6 +53,7 @@
 #include "pdfdrivercore.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <set>
 
@@ -928,9 +930,15 @@ CPLErr PDFRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff, void *pImage)
             static_cast<GSpacing>(nBlockXSize) *
             ((nBlockYSize == 1) ? nRasterYSize : nBlockYSize);
 
-        CPLErr eErr = poGDS->ReadPixels(nReqXOff, nReqYOff, nReqXSize,
-                                        nReqYSize, nPixelSpace, nLineSpace,
-                                        nBandSpace, poGDS->m_pabyCachedData);
+        CPLErr eErr = CE_None;
+        if (!poGDS->ReadPixelsMultiThreaded(
+                nReqXOff, nReqYOff, nReqXSize, nReqYSize, nPixelSpace,
+                nLineSpace, nBandSpace, poGDS->m_pabyCachedData, eErr))
+        {
+            eErr = poGDS->ReadPixels(nReqXOff, nReqYOff, nReqXSize, nReqYSize,
+                                     nPixelSpace, nLineSpace, nBandSpace,
+                                     poGDS->m_pabyCachedData);
+        }
 
         if (eErr == CE_None)
         {
@@ -2287,6 +2295,218 @@ CPLErr PDFDataset::ReadPixels(int nReqXOff, int nReqYOff, int nReqXSize,
     return eErr;
 }
 
+/************************************************************************/
+/*                       AcquireRenderingWorker()                       */
+/************************************************************************/
+
+// Returns a rendering worker from the pool, or a new one if the pool is
+// empty. Returns nullptr on failure.
+std::unique_ptr<PDFDataset> PDFDataset::AcquireRenderingWorker()
+{
+    {
+        std::lock_guard<std::mutex> oLock(m_oRenderingWorkersMutex);
+        if (!m_apoRenderingWorkers.empty())
+        {
+            auto poWorker = std::move(m_apoRenderingWorkers.back());
+            m_apoRenderingWorkers.pop_back();
+            return poWorker;
+        }
+    }
+
+    GDALOpenInfo oOpenInfo(GetDescription(), GA_ReadOnly);
+    CPLStringList aosOpenOptions(CSLDuplicate(papszOpenOptions));
+    aosOpenOptions.SetNameValue("DPI", CPLSPrintf("%.17g", m_dfDPI));
+    aosOpenOptions.SetNameValue("BANDS", CPLSPrintf("%d", nBands));
+    if (!m_osUserPwd.empty())
+        aosOpenOptions.SetNameValue("USER_PWD", m_osUserPwd.c_str());
+    aosOpenOptions.SetNameValue("@RENDERING_WORKER", "YES");
+    oOpenInfo.papszOpenOptions = aosOpenOptions.List();
+    auto poWorker = std::unique_ptr<PDFDataset>(Open(&oOpenInfo));
+    if (!poWorker || poWorker->nBands != nBands ||
+        poWorker->nRasterXSize != nRasterXSize ||
+        poWorker->nRasterYSize != nRasterYSize ||
+        poWorker->m_bUseLib != m_bUseLib)
+    {
+        CPLDebug("PDF", "Cannot create rendering worker");
+        return nullptr;
+    }
+    return poWorker;
+}
+
+/************************************************************************/
+/*                       ReleaseRenderingWorker()                       */
+/************************************************************************/
+
+void PDFDataset::ReleaseRenderingWorker(std::unique_ptr<PDFDataset> &&poWorker)
+{
+    std::lock_guard<std::mutex> oLock(m_oRenderingWorkersMutex);
+    m_apoRenderingWorkers.push_back(std::move(poWorker));
+}
+
+/************************************************************************/
+/*                     GetRenderingThreadCount()                        */
+/************************************************************************/
+
+static int GetRenderingThreadCount()
+{
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszNumThreads == nullptr)
+        return 1;
+    return std::min(128, EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : std::max(1, atoi(pszNumThreads)));
+}
+
+/************************************************************************/
+/*                      ReadPixelsMultiThreaded()                       */
+/*                                                                      */
+/*      Render the requested window with GDAL_NUM_THREADS threads,      */
+/*      each one rendering tiles aligned on the block grid (or          */
+/*      horizontal strips for one-line blocks) with its own rendering   */
+/*      worker. Returns false if the request is not eligible, or if     */
+/*      workers cannot be set up, in which case nothing was done.       */
+/************************************************************************/
+
+bool PDFDataset::ReadPixelsMultiThreaded(int nReqXOff, int nReqYOff,
+                                         int nReqXSize, int nReqYSize,
+                                         GSpacing nPixelSpace,
+                                         GSpacing nLineSpace,
+                                         GSpacing nBandSpace, GByte *pabyData,
+                                         CPLErr &eErr)
+{
+    // Pdfium is not thread-safe, even on distinct documents, so rendering
+    // is serialized anyway.
+    if (m_bIsRenderingWorker || m_bUseLib.test(PDFLIB_PDFIUM) ||
+        m_osUserPwd == "ASK_INTERACTIVE")
+    {
+        return false;
+    }
+
+    const int nThreads = GetRenderingThreadCount();
+    if (nThreads <= 1)
+        return false;
+
+    int nTileXSize = 0;
+    int nTileYSize = 0;
+    GetRasterBand(1)->GetBlockSize(&nTileXSize, &nTileYSize);
+    if (nTileYSize == 1)
+    {
+        // Rendering has a fixed cost per call, so do not use too small strips
+        constexpr int MIN_STRIP_HEIGHT = 64;
+        nTileXSize = nRasterXSize;
+        nTileYSize = std::max(MIN_STRIP_HEIGHT,
+                              DIV_ROUND_UP(nReqYSize, 4 * nThreads));
+    }
+
+    struct PDFRenderTile
+    {
+        int nXOff = 0;
+        int nYOff = 0;
+        int nXSize = 0;
+        int nYSize = 0;
+        GByte *pabyData = nullptr;
+    };
+
+    std::vector<PDFRenderTile> asTiles;
+    for (int nY = (nReqYOff / nTileYSize) * nTileYSize;
+         nY < nReqYOff + nReqYSize; nY += nTileYSize)
+    {
+        const int nYStart = std::max(nY, nReqYOff);
+        const int nYEnd = std::min(nY + nTileYSize, nReqYOff + nReqYSize);
+        for (int nX = (nReqXOff / nTileXSize) * nTileXSize;
+             nX < nReqXOff + nReqXSize; nX += nTileXSize)
+        {
+            const int nXStart = std::max(nX, nReqXOff);
+            const int nXEnd = std::min(nX + nTileXSize, nReqXOff + nReqXSize);
+            PDFRenderTile sTile;
+            sTile.nXOff = nXStart;
+            sTile.nYOff = nYStart;
+            sTile.nXSize = nXEnd - nXStart;
+            sTile.nYSize = nYEnd - nYStart;
+            sTile.pabyData = pabyData + (nYStart - nReqYOff) * nLineSpace +
+                             (nXStart - nReqXOff) * nPixelSpace;
+            asTiles.push_back(sTile);
+        }
+    }
+    if (asTiles.size() < 2)
+        return false;
+
+    // Each job owns a rendering worker, and renders tiles until there are
+    // no more.
+    struct PDFRenderJob
+    {
+        std::unique_ptr<PDFDataset> poWorker{};
+        const std::vector<PDFRenderTile> *pasTiles = nullptr;
+        std::atomic<size_t> *pnNextTile = nullptr;
+        GSpacing nPixelSpace = 0;
+        GSpacing nLineSpace = 0;
+        GSpacing nBandSpace = 0;
+        bool bOK = true;
+
+        static void Func(void *pData)
+        {
+            auto psJob = static_cast<PDFRenderJob *>(pData);
+            while (psJob->bOK)
+            {
+                const size_t iTile = (*psJob->pnNextTile)++;
+                if (iTile >= psJob->pasTiles->size())
+                    break;
+                const auto &sTile = (*psJob->pasTiles)[iTile];
+                psJob->bOK = psJob->poWorker->ReadPixels(
+                                 sTile.nXOff, sTile.nYOff, sTile.nXSize,
+                                 sTile.nYSize, psJob->nPixelSpace,
+                                 psJob->nLineSpace, psJob->nBandSpace,
+                                 sTile.pabyData) == CE_None;
+            }
+        }
+    };
+
+    // Open the missing rendering workers from this thread, as opening a
+    // document is not thread-safe.
+    const size_t nJobs = std::min<size_t>(nThreads, asTiles.size());
+    std::atomic<size_t> nNextTile{0};
+    std::vector<PDFRenderJob> asJobs(nJobs);
+    bool bOK = true;
+    for (auto &sJob : asJobs)
+    {
+        sJob.poWorker = AcquireRenderingWorker();
+        if (!sJob.poWorker)
+        {
+            bOK = false;
+            break;
+        }
+        sJob.pasTiles = &asTiles;
+        sJob.pnNextTile = &nNextTile;
+        sJob.nPixelSpace = nPixelSpace;
+        sJob.nLineSpace = nLineSpace;
+        sJob.nBandSpace = nBandSpace;
+    }
+
+    CPLWorkerThreadPool *poPool =
+        bOK ? GDALGetGlobalThreadPool(static_cast<int>(nJobs)) : nullptr;
+    if (poPool)
+    {
+        auto poQueue = poPool->CreateJobQueue();
+        for (auto &sJob : asJobs)
+            poQueue->SubmitJob(PDFRenderJob::Func, &sJob);
+        poQueue->WaitCompletion();
+
+        eErr = CE_None;
+        for (const auto &sJob : asJobs)
+        {
+            if (!sJob.bOK)
+                eErr = CE_Failure;
+        }
+    }
+
+    for (auto &sJob : asJobs)
+    {
+        if (sJob.poWorker)
+            ReleaseRenderingWorker(std::move(sJob.poWorker));
+    }
+    return poPool != nullptr;
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                        PDFImageRasterBand                            */
@@ -2698,8 +2918,17 @@ CPLErr PDFDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
     }
 
     if (bReadPixels)
+    {
+        CPLErr eErr = CE_None;
+        if (ReadPixelsMultiThreaded(nXOff, nYOff, nXSize, nYSize, nPixelSpace,
+                                    nLineSpace, nBandSpace,
+                                    static_cast<GByte *>(pData), eErr))
+        {
+            return eErr;
+        }
         return ReadPixels(nXOff, nYOff, nXSize, nYSize, nPixelSpace, nLineSpace,
                           nBandSpace, (GByte *)pData);
+    }
 
     if (nBufXSize != nXSize || nBufYSize != nYSize || eBufType != GDT_Byte)
     {
@@ -2769,7 +2998,8 @@ static void PDFDatasetErrorFunctionCommon(const CPLString &osError)
     CPLError(CE_Failure, CPLE_AppDefined, "%s", osError.c_str());
 }
 
-static int g_nPopplerErrors = 0;
+// Atomic as documents may be rendered concurrently by rendering workers
+static std::atomic<int> g_nPopplerErrors{0};
 constexpr int MAX_POPPLER_ERRORS = 1000;
 
 static void PDFDatasetErrorFunction(ErrorCategory /* eErrCategory */,
@@ -5160,6 +5390,36 @@ PDFDataset *PDFDataset::Open(GDALOpenInfo *poOpenInfo)
             poDS->SetMetadataItem("INTERLEAVE", "PIXEL", "IMAGE_STRUCTURE");
     }
 
+    // User specified block size, for example to match the tile size of the
+    // output when converting to COG, which also sets the size of the
+    // rendered tiles in multi-threaded mode.
+    if (poDS->m_aiTiles.empty() &&
+        !CSLFetchNameValue(poOpenInfo->papszOpenOptions, "@OPEN_FOR_OVERVIEW"))
+    {
+        const char *pszBlockXSize =
+            CSLFetchNameValue(poOpenInfo->papszOpenOptions, "BLOCKXSIZE");
+        const char *pszBlockYSize =
+            CSLFetchNameValue(poOpenInfo->papszOpenOptions, "BLOCKYSIZE");
+        if (pszBlockXSize || pszBlockYSize)
+        {
+            // If only one dimension is specified, use square blocks
+            const int nBlockXSize =
+                atoi(pszBlockXSize ? pszBlockXSize : pszBlockYSize);
+            const int nBlockYSize =
+                atoi(pszBlockYSize ? pszBlockYSize : pszBlockXSize);
+            if (nBlockXSize < 16 || nBlockYSize < 16 ||
+                nBlockXSize > 16384 || nBlockYSize > 16384)
+            {
+                CPLError(CE_Failure, CPLE_IllegalArg,
+                         "Invalid value for BLOCKXSIZE / BLOCKYSIZE");
+                delete poDS;
+                return nullptr;
+            }
+            poDS->m_nBlockXSize = std::min(nBlockXSize, poDS->nRasterXSize);
+            poDS->m_nBlockYSize = std::min(nBlockYSize, poDS->nRasterYSize);
+        }
+    }
+
     GDALPDFObject *poLGIDict = nullptr;
     GDALPDFObject *poVP = nullptr;
     int bIsOGCBP = FALSE;
@@ -5647,7 +5907,12 @@ PDFDataset *PDFDataset::Open(GDALOpenInfo *poOpenInfo)
     /* -------------------------------------------------------------------- */
     /*      Support overviews.                                              */
     /* -------------------------------------------------------------------- */
-    if (!CSLFetchNameValue(poOpenInfo->papszOpenOptions, "@OPEN_FOR_OVERVIEW"))
+    poDS->m_bIsRenderingWorker =
+        CSLFetchNameValue(poOpenInfo->papszOpenOptions, "@RENDERING_WORKER") !=
+        nullptr;
+    if (!CSLFetchNameValue(poOpenInfo->papszOpenOptions,
+                           "@OPEN_FOR_OVERVIEW") &&
+        !poDS->m_bIsRenderingWorker)
     {
         poDS->oOvManager.Initialize(poDS, poOpenInfo->pszFilename);
     }
@@ -28,6 +28,10 @@
 
 #include "pdfdrivercore.h"
 
+#ifndef PLUGIN_FILENAME
+#include "gdal_frmts.h"
+#endif
+
 static const char *const szOpenOptionList =
     "<OpenOptionList>"
 #if defined(HAVE_POPPLER) || defined(HAVE_PDFIUM)
@@ -82,6 +86,8 @@ static const char *const szOpenOptionList =
     "  </Option>"
     "  <Option name='NEATLINE' type='string' description='The name of the "
     "neatline to select' alt_config_option='GDAL_PDF_NEATLINE'/>"
+    "  <Option name='BLOCKXSIZE' type='int' description='Block width'/>"
+    "  <Option name='BLOCKYSIZE' type='int' description='Block height'/>"
     "</OpenOptionList>";
 
 const char *PDFGetOpenOptionList()
@@ -274,3 +280,20 @@ void DeclareDeferredPDFPlugin()
     GetGDALDriverManager()->DeclareDeferredPluginDriver(poDriver);
 }
 #endif
+
+/************************************************************************/
+/*                     DeclareDeferredPDFBuiltin()                      */
+/************************************************************************/
+
+#ifndef PLUGIN_FILENAME
+void DeclareDeferredPDFBuiltin()
+{
+    if (GDALGetDriverByName(DRIVER_NAME) != nullptr)
+    {
+        return;
+    }
+    auto poDriver = new GDALPluginDriverProxy(GDALRegister_PDF);
+    PDFDriverSetCommonMetadata(poDriver);
+    GetGDALDriverManager()->DeclareDeferredPluginDriver(poDriver);
+}
+#endif
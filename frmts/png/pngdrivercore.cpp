@@ -29,6 +29,10 @@
 
 #include "pngdrivercore.h"
 
+#ifndef PLUGIN_FILENAME
+#include "gdal_frmts.h"
+#endif
+
 /************************************************************************/
 /*                     PNGDriverIdentify()                              */
 /************************************************************************/
@@ -97,6 +101,8 @@ void PNGDriverSetCommonMetadata(GDALDriver *poDriver)
     poDriver->SetMetadataItem(GDAL_DCAP_VIRTUALIO, "YES");
 
     poDriver->pfnIdentify = PNGDriverIdentify;
+    poDriver->SetMetadataItem(GDAL_DMD_IDENTIFY_SIGNATURES,
+                              "magic:0:89504E470D0A1A0A");
     poDriver->SetMetadataItem(GDAL_DCAP_OPEN, "YES");
     poDriver->SetMetadataItem(GDAL_DCAP_CREATECOPY, "YES");
 }
@@ -121,3 +127,20 @@ void DeclareDeferredPNGPlugin()
     GetGDALDriverManager()->DeclareDeferredPluginDriver(poDriver);
 }
 #endif
+
+/************************************************************************/
+/*                     DeclareDeferredPNGBuiltin()                      */
+/************************************************************************/
+
+#ifndef PLUGIN_FILENAME
+void DeclareDeferredPNGBuiltin()
+{
+    if (GDALGetDriverByName(DRIVER_NAME) != nullptr)
+    {
+        return;
+    }
+    auto poDriver = new GDALPluginDriverProxy(GDALRegister_PNG);
+    PNGDriverSetCommonMetadata(poDriver);
+    GetGDALDriverManager()->DeclareDeferredPluginDriver(poDriver);
+}
+#endif
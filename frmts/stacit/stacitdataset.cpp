@@ -940,6 +940,9 @@ void GDALRegister_STACIT()
         "       <Value>HIGHEST</Value>"
         "       <Value>LOWEST</Value>"
         "   </Option>"
+        "   <Option name='NUM_THREADS' type='string' "
+        "description='Number of worker threads for reading. Can be set to "
+        "ALL_CPUS' default='GDAL_NUM_THREADS config option'/>"
         "</OpenOptionList>");
 
     poDriver->pfnOpen = STACITDataset::OpenStatic;
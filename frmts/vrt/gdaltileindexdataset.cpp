@@ -31,6 +31,7 @@
 #include <array>
 #include <algorithm>
 #include <limits>
+#include <numeric>
 #include <set>
 #include <tuple>
 #include <utility>
@@ -275,6 +276,10 @@ class GDALTileIndexDataset final : public GDALPamDataset
     //! Cache of buffers used by VRTComplexSource to avoid memory reallocation.
     VRTSource::WorkingState m_oWorkingState{};
 
+    //! Maximum number of threads used to open and read sources
+    //! (NUM_THREADS open option or GDAL_NUM_THREADS configuration option).
+    int m_nNumThreads = 1;
+
     //! Structure describing one of the source raster in the tile index.
     struct SourceDesc
     {
@@ -314,6 +319,39 @@ class GDALTileIndexDataset final : public GDALPamDataset
     //! From a source dataset name, return its SourceDesc description structure.
     bool GetSourceDesc(const std::string &osTileName, SourceDesc &oSourceDesc);
 
+    //! Return the number of threads that can be used to process nSources
+    //! sources in parallel, or 1.
+    int GetNumThreads(size_t nSources) const;
+
+    //! Open and close in parallel the non-local datasets of aosTileNames that
+    //! are not yet in m_oMapSharedSources, to warm up network caches.
+    void PrefetchTiles(const std::vector<std::string> &aosTileNames);
+
+    //! Return the source window and the window of the output buffer that a
+    //! source contributes to, for the specified request.
+    static bool GetSourceOutWindow(VRTSimpleSource *poSource,
+                                   GDALRasterBand *poTileBand, double dfXOff,
+                                   double dfYOff, double dfXSize,
+                                   double dfYSize, int nBufXSize,
+                                   int nBufYSize, int &nReqXOff, int &nReqYOff,
+                                   int &nReqXSize, int &nReqYSize,
+                                   int &nOutXOff, int &nOutYOff,
+                                   int &nOutXSize, int &nOutYSize);
+
+    //! Call AdviseRead() on the dataset of a source, with the window of the
+    //! source contributing to the specified request.
+    void PrefetchSource(SourceDesc &oSourceDesc, double dfXOff, double dfYOff,
+                        double dfXSize, double dfYSize, int nBufXSize,
+                        int nBufYSize, GDALDataType eBufType, int nBandCount,
+                        int *panBandMap);
+
+    //! Whether the sources of m_aoSourceDesc whose indices are in anSources
+    //! use distinct datasets and write to non-overlapping windows of the
+    //! output buffer.
+    bool AreSourcesDisjoint(const std::vector<int> &anSources, double dfXOff,
+                            double dfYOff, double dfXSize, double dfYSize,
+                            int nBufXSize, int nBufYSize);
+
     //! Collect sources corresponding to the georeferenced window of interest,
     //! and store them in m_aoSourceDesc[].
     bool CollectSources(double dfXOff, double dfYOff, double dfXSize,
@@ -901,6 +939,18 @@ bool GDALTileIndexDataset::Open(GDALOpenInfo *poOpenInfo)
         m_osResampling = pszResampling;
     }
 
+    const char *pszNumThreads =
+        CSLFetchNameValueDef(poOpenInfo->papszOpenOptions, "NUM_THREADS",
+                             CPLGetConfigOption("GDAL_NUM_THREADS", nullptr));
+    if (pszNumThreads)
+    {
+        if (EQUAL(pszNumThreads, "ALL_CPUS"))
+            m_nNumThreads = CPLGetNumCPUs();
+        else
+            m_nNumThreads = atoi(pszNumThreads);
+        m_nNumThreads = std::max(1, std::min(m_nNumThreads, 1024));
+    }
+
     const char *pszMinX = GetOption(MD_MINX);
     const char *pszMinY = GetOption(MD_MINY);
     const char *pszMaxX = GetOption(MD_MAXX);
@@ -2910,6 +2960,68 @@ bool GDALTileIndexDataset::GetSourceDesc(const std::string &osTileName,
     return true;
 }
 
+/************************************************************************/
+/*                           GetNumThreads()                            */
+/************************************************************************/
+
+int GDALTileIndexDataset::GetNumThreads(size_t nSources) const
+{
+    if (m_nNumThreads <= 1 || nSources <= 1)
+        return 1;
+
+    // Each thread may need a couple of datasets of the pool of opened
+    // datasets at the same time (e.g. for the mask band, or for sources
+    // that are themselves VRTs).
+    const int nMaxPoolSize =
+        atoi(CPLGetConfigOption("GDAL_MAX_DATASET_POOL_SIZE", "100"));
+    return static_cast<int>(std::min<size_t>(
+        nSources, std::min(m_nNumThreads, std::max(1, nMaxPoolSize / 4))));
+}
+
+/************************************************************************/
+/*                           PrefetchTiles()                            */
+/************************************************************************/
+
+// Opening of datasets through GDALProxyPoolDataset is serialized by the
+// dataset pool mutex. For network sources, opening them first in parallel
+// fills the process-wide caches of the network file systems (file size,
+// header bytes...), so that the subsequent opening in GetSourceDesc() does
+// not need to wait for the network.
+void GDALTileIndexDataset::PrefetchTiles(
+    const std::vector<std::string> &aosTileNames)
+{
+    std::vector<std::string> aosToOpen;
+    for (const auto &osTileName : aosTileNames)
+    {
+        if (!VSIIsLocal(osTileName.c_str()) &&
+            !m_oMapSharedSources.contains(osTileName) &&
+            std::find(aosToOpen.begin(), aosToOpen.end(), osTileName) ==
+                aosToOpen.end())
+        {
+            aosToOpen.push_back(osTileName);
+        }
+    }
+
+    const int nThreads = GetNumThreads(aosToOpen.size());
+    if (nThreads <= 1)
+        return;
+
+    std::vector<int> anIndices(aosToOpen.size());
+    std::iota(anIndices.begin(), anIndices.end(), 0);
+    VRTSourcedRasterBand::MultiThreadedSourcesRasterIO(
+        nThreads, anIndices,
+        [&aosToOpen](int i)
+        {
+            // Failures are not errors at that stage: they will be reported
+            // when the source is opened again by GetSourceDesc().
+            CPLErrorStateBackuper oErrorStateBackuper;
+            CPLErrorHandlerPusher oErrorHandlerPusher(CPLQuietErrorHandler);
+            std::unique_ptr<GDALDataset>(
+                GDALDataset::Open(aosToOpen[i].c_str(), GDAL_OF_RASTER));
+            return CE_None;
+        });
+}
+
 /************************************************************************/
 /*                        CollectSources()                              */
 /************************************************************************/
@@ -2971,15 +3083,36 @@ bool GDALTileIndexDataset::CollectSources(double dfXOff, double dfYOff,
 
     // Try to find the last (most prioritary) fully opaque source covering
     // the whole AOI. We only need to start rendering from it.
+    // When multi-threading is enabled, network sources are prefetched in
+    // parallel by batches of the number of threads, from the most prioritary
+    // one, so as not to open too many sources that will not be rendered.
+    const int nThreads = GetNumThreads(m_aoSourceDesc.size());
+    size_t iNextToPrefetch = m_aoSourceDesc.size();
+    const auto GetTileName = [this](size_t iSource)
+    {
+        const char *pszTileName =
+            m_aoSourceDesc[iSource].poFeature->GetFieldAsString(
+                m_nLocationFieldIndex);
+        return GetAbsoluteFileName(pszTileName, GetDescription());
+    };
+
     size_t i = m_aoSourceDesc.size();
     while (i > 0)
     {
         --i;
-        auto &poFeature = m_aoSourceDesc[i].poFeature;
-        const char *pszTileName =
-            poFeature->GetFieldAsString(m_nLocationFieldIndex);
-        const std::string osTileName(
-            GetAbsoluteFileName(pszTileName, GetDescription()));
+        const std::string osTileName(GetTileName(i));
+
+        if (nThreads > 1 && i < iNextToPrefetch)
+        {
+            std::vector<std::string> aosTileNames;
+            while (iNextToPrefetch > 0 &&
+                   aosTileNames.size() < static_cast<size_t>(nThreads))
+            {
+                --iNextToPrefetch;
+                aosTileNames.push_back(GetTileName(iNextToPrefetch));
+            }
+            PrefetchTiles(aosTileNames);
+        }
 
         SourceDesc oSourceDesc;
         if (!GetSourceDesc(osTileName, oSourceDesc))
@@ -3379,7 +3512,8 @@ CPLErr GDALTileIndexDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
 
     const bool bNeedInitBuffer = NeedInitBuffer(nBandCount, panBandMap);
 
-    const auto RenderSource = [=](SourceDesc &oSourceDesc)
+    const auto RenderSource = [=](SourceDesc &oSourceDesc,
+                                  VRTSource::WorkingState &oWorkingState)
     {
         auto &poTileDS = oSourceDesc.poDS;
         auto &poSource = oSourceDesc.poSource;
@@ -3468,7 +3602,7 @@ CPLErr GDALTileIndexDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                     eErr = poSource->RasterIO(
                         poTileBand->GetRasterDataType(), nXOff, nYOff, nXSize,
                         nYSize, pabyBandData, nBufXSize, nBufYSize, eBufType,
-                        nPixelSpace, nLineSpace, &sExtraArg, m_oWorkingState);
+                        nPixelSpace, nLineSpace, &sExtraArg, oWorkingState);
                 }
             }
             return eErr;
@@ -3707,7 +3841,7 @@ CPLErr GDALTileIndexDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                     papoBands[nBandNr - 1]->GetRasterDataType(), nXOff, nYOff,
                     nXSize, nYSize, pabyBandData, nBufXSize, nBufYSize,
                     eBufType, nPixelSpace, nLineSpace, &sExtraArg,
-                    m_oWorkingState);
+                    oWorkingState);
             }
         }
         return eErr;
@@ -3715,17 +3849,54 @@ CPLErr GDALTileIndexDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
 
     if (!bNeedInitBuffer)
     {
-        return RenderSource(m_aoSourceDesc.back());
+        return RenderSource(m_aoSourceDesc.back(), m_oWorkingState);
     }
     else
     {
         InitBuffer(pData, nBufXSize, nBufYSize, eBufType, nBandCount,
                    panBandMap, nPixelSpace, nLineSpace, nBandSpace);
 
+        std::vector<int> anSources;
+        for (int i = 0; i < static_cast<int>(m_aoSourceDesc.size()); ++i)
+        {
+            if (m_aoSourceDesc[i].poDS)
+                anSources.push_back(i);
+        }
+
+        // Let drivers that support it (e.g. for network datasets) prefetch
+        // the area of interest of all sources before they are rendered.
+        if (anSources.size() > 1 && nBandNrMax > 0)
+        {
+            for (int i : anSources)
+            {
+                PrefetchSource(m_aoSourceDesc[i], dfXOff, dfYOff, dfXSize,
+                               dfYSize, nBufXSize, nBufYSize, eBufType,
+                               nBandCount, panBandMap);
+            }
+        }
+
+        const int nThreads = GetNumThreads(anSources.size());
+        if (nThreads > 1 &&
+            AreSourcesDisjoint(anSources, dfXOff, dfYOff, dfXSize, dfYSize,
+                               nBufXSize, nBufYSize))
+        {
+            // Sources write to distinct parts of the output buffer, so their
+            // rendering order does not matter.
+            std::vector<VRTSource::WorkingState> aoWorkingStates(
+                m_aoSourceDesc.size());
+            return VRTSourcedRasterBand::MultiThreadedSourcesRasterIO(
+                nThreads, anSources,
+                [this, &aoWorkingStates, &RenderSource](int i)
+                {
+                    return RenderSource(m_aoSourceDesc[i],
+                                        aoWorkingStates[i]);
+                });
+        }
+
         // Now render from bottom of the stack to top.
-        for (auto &oSourceDesc : m_aoSourceDesc)
+        for (int i : anSources)
         {
-            if (oSourceDesc.poDS && RenderSource(oSourceDesc) != CE_None)
+            if (RenderSource(m_aoSourceDesc[i], m_oWorkingState) != CE_None)
                 return CE_Failure;
         }
 
@@ -3733,6 +3904,120 @@ CPLErr GDALTileIndexDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
     }
 }
 
+/************************************************************************/
+/*                          GetSourceOutWindow()                        */
+/************************************************************************/
+
+bool GDALTileIndexDataset::GetSourceOutWindow(
+    VRTSimpleSource *poSource, GDALRasterBand *poTileBand, double dfXOff,
+    double dfYOff, double dfXSize, double dfYSize, int nBufXSize,
+    int nBufYSize, int &nReqXOff, int &nReqYOff, int &nReqXSize,
+    int &nReqYSize, int &nOutXOff, int &nOutYOff, int &nOutXSize,
+    int &nOutYSize)
+{
+    double dfReqXOff = 0.0;
+    double dfReqYOff = 0.0;
+    double dfReqXSize = 0.0;
+    double dfReqYSize = 0.0;
+    bool bError = false;
+    poSource->SetRasterBand(poTileBand, false);
+    return poSource->GetSrcDstWindow(
+        dfXOff, dfYOff, dfXSize, dfYSize, nBufXSize, nBufYSize, &dfReqXOff,
+        &dfReqYOff, &dfReqXSize, &dfReqYSize, &nReqXOff, &nReqYOff, &nReqXSize,
+        &nReqYSize, &nOutXOff, &nOutYOff, &nOutXSize, &nOutYSize, bError);
+}
+
+/************************************************************************/
+/*                            PrefetchSource()                          */
+/************************************************************************/
+
+void GDALTileIndexDataset::PrefetchSource(SourceDesc &oSourceDesc,
+                                          double dfXOff, double dfYOff,
+                                          double dfXSize, double dfYSize,
+                                          int nBufXSize, int nBufYSize,
+                                          GDALDataType eBufType,
+                                          int nBandCount, int *panBandMap)
+{
+    auto &poTileDS = oSourceDesc.poDS;
+    for (int i = 0; i < nBandCount; ++i)
+    {
+        if (panBandMap[i] > poTileDS->GetRasterCount())
+            return;
+    }
+
+    int nReqXOff = 0;
+    int nReqYOff = 0;
+    int nReqXSize = 0;
+    int nReqYSize = 0;
+    int nOutXOff = 0;
+    int nOutYOff = 0;
+    int nOutXSize = 0;
+    int nOutYSize = 0;
+    if (GetSourceOutWindow(oSourceDesc.poSource.get(),
+                           poTileDS->GetRasterBand(1), dfXOff, dfYOff, dfXSize,
+                           dfYSize, nBufXSize, nBufYSize, nReqXOff, nReqYOff,
+                           nReqXSize, nReqYSize, nOutXOff, nOutYOff, nOutXSize,
+                           nOutYSize))
+    {
+        CPL_IGNORE_RET_VAL(poTileDS->AdviseRead(
+            nReqXOff, nReqYOff, nReqXSize, nReqYSize, nOutXSize, nOutYSize,
+            eBufType, nBandCount, panBandMap, nullptr));
+    }
+}
+
+/************************************************************************/
+/*                         AreSourcesDisjoint()                         */
+/************************************************************************/
+
+bool GDALTileIndexDataset::AreSourcesDisjoint(
+    const std::vector<int> &anSources, double dfXOff, double dfYOff,
+    double dfXSize, double dfYSize, int nBufXSize, int nBufYSize)
+{
+    struct Window
+    {
+        int nXOff, nYOff, nXSize, nYSize;
+    };
+
+    std::vector<Window> aoWindows;
+    std::set<std::string> oSetNames;
+    for (int i : anSources)
+    {
+        auto &oSourceDesc = m_aoSourceDesc[i];
+        // Sources sharing the same dataset handle cannot be processed in
+        // parallel.
+        if (!oSetNames.insert(oSourceDesc.osName).second)
+            return false;
+
+        int nReqXOff = 0;
+        int nReqYOff = 0;
+        int nReqXSize = 0;
+        int nReqYSize = 0;
+        Window oWindow;
+        if (!GetSourceOutWindow(oSourceDesc.poSource.get(),
+                                oSourceDesc.poDS->GetRasterBand(1), dfXOff,
+                                dfYOff, dfXSize, dfYSize, nBufXSize, nBufYSize,
+                                nReqXOff, nReqYOff, nReqXSize, nReqYSize,
+                                oWindow.nXOff, oWindow.nYOff, oWindow.nXSize,
+                                oWindow.nYSize))
+        {
+            continue;
+        }
+
+        for (const auto &oOther : aoWindows)
+        {
+            if (oWindow.nXOff < oOther.nXOff + oOther.nXSize &&
+                oOther.nXOff < oWindow.nXOff + oWindow.nXSize &&
+                oWindow.nYOff < oOther.nYOff + oOther.nYSize &&
+                oOther.nYOff < oWindow.nYOff + oWindow.nYSize)
+            {
+                return false;
+            }
+        }
+        aoWindows.push_back(oWindow);
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                         GDALRegister_GTI()                           */
 /************************************************************************/
@@ -3769,6 +4054,10 @@ void GDALRegister_GTI()
                               "  <Option name='MINY' type='float'/>"
                               "  <Option name='MAXX' type='float'/>"
                               "  <Option name='MAXY' type='float'/>"
+                              "  <Option name='NUM_THREADS' type='string' "
+                              "description='Number of worker threads for "
+                              "reading. Can be set to ALL_CPUS' "
+                              "default='GDAL_NUM_THREADS config option'/>"
                               "</OpenOptionList>");
 
     GetGDALDriverManager()->RegisterDriver(poDriver.release());
@@ -29,9 +29,14 @@
 
 #include <cmath>
 #include "gdal.h"
+#include "gdal_thread_pool.h"
 #include "vrtdataset.h"
+#include "vrtexpression.h"
 
+#include <algorithm>
 #include <limits>
+#include <type_traits>
+#include <vector>
 
 template <typename T>
 inline double GetSrcVal(const void *pSource, GDALDataType eSrcType, T ii)
@@ -109,6 +114,70 @@ static CPLErr FetchDoubleArg(CSLConstList papszArgs, const char *pszName,
     return CE_None;
 }
 
+/************************************************************************/
+/*                        DispatchRealSrcType()                         */
+/************************************************************************/
+
+// Calls fn() with a null pointer of the C type of the (non complex) source
+// data type, so that inner loops can be compiled for each source type,
+// instead of switching on it for each pixel as GetSrcVal() does.
+template <class Func>
+static void DispatchRealSrcType(GDALDataType eSrcType, Func &&fn)
+{
+    switch (eSrcType)
+    {
+        case GDT_Byte:
+            fn(static_cast<GByte *>(nullptr));
+            break;
+        case GDT_Int8:
+            fn(static_cast<GInt8 *>(nullptr));
+            break;
+        case GDT_UInt16:
+            fn(static_cast<GUInt16 *>(nullptr));
+            break;
+        case GDT_Int16:
+            fn(static_cast<GInt16 *>(nullptr));
+            break;
+        case GDT_UInt32:
+            fn(static_cast<GUInt32 *>(nullptr));
+            break;
+        case GDT_Int32:
+            fn(static_cast<GInt32 *>(nullptr));
+            break;
+        case GDT_UInt64:
+            fn(static_cast<uint64_t *>(nullptr));
+            break;
+        case GDT_Int64:
+            fn(static_cast<int64_t *>(nullptr));
+            break;
+        case GDT_Float32:
+            fn(static_cast<float *>(nullptr));
+            break;
+        case GDT_Float64:
+            fn(static_cast<double *>(nullptr));
+            break;
+        default:
+            CPLAssert(false);
+            break;
+    }
+}
+
+/************************************************************************/
+/*                          CopyLineToBuffer()                          */
+/************************************************************************/
+
+// Writes a line of nXSize computed values to the output buffer, with a
+// single GDALCopyWords() call.
+static void CopyLineToBuffer(const double *padfLine, void *pData, int iLine,
+                             int nXSize, GDALDataType eBufType,
+                             int nPixelSpace, int nLineSpace)
+{
+    GDALCopyWords(padfLine, GDT_Float64, static_cast<int>(sizeof(double)),
+                  static_cast<GByte *>(pData) +
+                      static_cast<GSpacing>(nLineSpace) * iLine,
+                  eBufType, nPixelSpace, nXSize);
+}
+
 static CPLErr RealPixelFunc(void **papoSources, int nSources, void *pData,
                             int nXSize, int nYSize, GDALDataType eSrcType,
                             GDALDataType eBufType, int nPixelSpace,
@@ -543,27 +612,28 @@ static CPLErr SumPixelFunc(void **papoSources, int nSources, void *pData,
     else
     {
         /* ---- Set pixels ---- */
-        size_t ii = 0;
-        for (int iLine = 0; iLine < nYSize; ++iLine)
-        {
-            for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
+        std::vector<double> adfLine(nXSize);
+        DispatchRealSrcType(
+            eSrcType,
+            [&](auto pTypeTag)
             {
-                double dfSum = dfK;  // Not complex.
-
-                for (int iSrc = 0; iSrc < nSources; ++iSrc)
+                using T = std::remove_pointer_t<decltype(pTypeTag)>;
+                double *const padfLine = adfLine.data();
+                size_t ii = 0;
+                for (int iLine = 0; iLine < nYSize; ++iLine, ii += nXSize)
                 {
-                    // Source raster pixels may be obtained with GetSrcVal
-                    // macro.
-                    dfSum += GetSrcVal(papoSources[iSrc], eSrcType, ii);
+                    std::fill(padfLine, padfLine + nXSize, dfK);
+                    for (int iSrc = 0; iSrc < nSources; ++iSrc)
+                    {
+                        const T *const pSrc =
+                            static_cast<const T *>(papoSources[iSrc]) + ii;
+                        for (int iCol = 0; iCol < nXSize; ++iCol)
+                            padfLine[iCol] += static_cast<double>(pSrc[iCol]);
+                    }
+                    CopyLineToBuffer(padfLine, pData, iLine, nXSize, eBufType,
+                                     nPixelSpace, nLineSpace);
                 }
-
-                GDALCopyWords(&dfSum, GDT_Float64, 0,
-                              static_cast<GByte *>(pData) +
-                                  static_cast<GSpacing>(nLineSpace) * iLine +
-                                  iCol * nPixelSpace,
-                              eBufType, nPixelSpace, 1);
-            }
-        }
+            });
     }
 
     /* ---- Return success ---- */
@@ -612,24 +682,29 @@ static CPLErr DiffPixelFunc(void **papoSources, int nSources, void *pData,
     else
     {
         /* ---- Set pixels ---- */
-        size_t ii = 0;
-        for (int iLine = 0; iLine < nYSize; ++iLine)
-        {
-            for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
+        std::vector<double> adfLine(nXSize);
+        DispatchRealSrcType(
+            eSrcType,
+            [&](auto pTypeTag)
             {
-                // Source raster pixels may be obtained with GetSrcVal macro.
-                // Not complex.
-                const double dfPixVal =
-                    GetSrcVal(papoSources[0], eSrcType, ii) -
-                    GetSrcVal(papoSources[1], eSrcType, ii);
-
-                GDALCopyWords(&dfPixVal, GDT_Float64, 0,
-                              static_cast<GByte *>(pData) +
-                                  static_cast<GSpacing>(nLineSpace) * iLine +
-                                  iCol * nPixelSpace,
-                              eBufType, nPixelSpace, 1);
-            }
-        }
+                using T = std::remove_pointer_t<decltype(pTypeTag)>;
+                double *const padfLine = adfLine.data();
+                size_t ii = 0;
+                for (int iLine = 0; iLine < nYSize; ++iLine, ii += nXSize)
+                {
+                    const T *const pSrc0 =
+                        static_cast<const T *>(papoSources[0]) + ii;
+                    const T *const pSrc1 =
+                        static_cast<const T *>(papoSources[1]) + ii;
+                    for (int iCol = 0; iCol < nXSize; ++iCol)
+                    {
+                        padfLine[iCol] = static_cast<double>(pSrc0[iCol]) -
+                                         static_cast<double>(pSrc1[iCol]);
+                    }
+                    CopyLineToBuffer(padfLine, pData, iLine, nXSize, eBufType,
+                                     nPixelSpace, nLineSpace);
+                }
+            });
     }
 
     /* ---- Return success ---- */
@@ -697,27 +772,28 @@ static CPLErr MulPixelFunc(void **papoSources, int nSources, void *pData,
     else
     {
         /* ---- Set pixels ---- */
-        size_t ii = 0;
-        for (int iLine = 0; iLine < nYSize; ++iLine)
-        {
-            for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
+        std::vector<double> adfLine(nXSize);
+        DispatchRealSrcType(
+            eSrcType,
+            [&](auto pTypeTag)
             {
-                double dfPixVal = dfK;  // Not complex.
-
-                for (int iSrc = 0; iSrc < nSources; ++iSrc)
+                using T = std::remove_pointer_t<decltype(pTypeTag)>;
+                double *const padfLine = adfLine.data();
+                size_t ii = 0;
+                for (int iLine = 0; iLine < nYSize; ++iLine, ii += nXSize)
                 {
-                    // Source raster pixels may be obtained with GetSrcVal
-                    // macro.
-                    dfPixVal *= GetSrcVal(papoSources[iSrc], eSrcType, ii);
+                    std::fill(padfLine, padfLine + nXSize, dfK);
+                    for (int iSrc = 0; iSrc < nSources; ++iSrc)
+                    {
+                        const T *const pSrc =
+                            static_cast<const T *>(papoSources[iSrc]) + ii;
+                        for (int iCol = 0; iCol < nXSize; ++iCol)
+                            padfLine[iCol] *= static_cast<double>(pSrc[iCol]);
+                    }
+                    CopyLineToBuffer(padfLine, pData, iLine, nXSize, eBufType,
+                                     nPixelSpace, nLineSpace);
                 }
-
-                GDALCopyWords(&dfPixVal, GDT_Float64, 0,
-                              static_cast<GByte *>(pData) +
-                                  static_cast<GSpacing>(nLineSpace) * iLine +
-                                  iCol * nPixelSpace,
-                              eBufType, nPixelSpace, 1);
-            }
-        }
+            });
     }
 
     /* ---- Return success ---- */
@@ -1402,22 +1478,30 @@ static CPLErr ReplaceNoDataPixelFunc(void **papoSources, int nSources,
     }
 
     /* ---- Set pixels ---- */
-    size_t ii = 0;
-    for (int iLine = 0; iLine < nYSize; ++iLine)
-    {
-        for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
+    std::vector<double> adfLine(nXSize);
+    DispatchRealSrcType(
+        eSrcType,
+        [&](auto pTypeTag)
         {
-            double dfPixVal = GetSrcVal(papoSources[0], eSrcType, ii);
-            if (dfPixVal == dfOldNoData || std::isnan(dfPixVal))
-                dfPixVal = dfNewNoData;
-
-            GDALCopyWords(&dfPixVal, GDT_Float64, 0,
-                          static_cast<GByte *>(pData) +
-                              static_cast<GSpacing>(nLineSpace) * iLine +
-                              iCol * nPixelSpace,
-                          eBufType, nPixelSpace, 1);
-        }
-    }
+            using T = std::remove_pointer_t<decltype(pTypeTag)>;
+            double *const padfLine = adfLine.data();
+            size_t ii = 0;
+            for (int iLine = 0; iLine < nYSize; ++iLine, ii += nXSize)
+            {
+                const T *const pSrc =
+                    static_cast<const T *>(papoSources[0]) + ii;
+                for (int iCol = 0; iCol < nXSize; ++iCol)
+                {
+                    const double dfPixVal = static_cast<double>(pSrc[iCol]);
+                    padfLine[iCol] =
+                        (dfPixVal == dfOldNoData || std::isnan(dfPixVal))
+                            ? dfNewNoData
+                            : dfPixVal;
+                }
+                CopyLineToBuffer(padfLine, pData, iLine, nXSize, eBufType,
+                                 nPixelSpace, nLineSpace);
+            }
+        });
 
     /* ---- Return success ---- */
     return CE_None;
@@ -1451,21 +1535,27 @@ static CPLErr ScalePixelFunc(void **papoSources, int nSources, void *pData,
         return CE_Failure;
 
     /* ---- Set pixels ---- */
-    size_t ii = 0;
-    for (int iLine = 0; iLine < nYSize; ++iLine)
-    {
-        for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
+    std::vector<double> adfLine(nXSize);
+    DispatchRealSrcType(
+        eSrcType,
+        [&](auto pTypeTag)
         {
-            const double dfPixVal =
-                GetSrcVal(papoSources[0], eSrcType, ii) * dfScale + dfOffset;
-
-            GDALCopyWords(&dfPixVal, GDT_Float64, 0,
-                          static_cast<GByte *>(pData) +
-                              static_cast<GSpacing>(nLineSpace) * iLine +
-                              iCol * nPixelSpace,
-                          eBufType, nPixelSpace, 1);
-        }
-    }
+            using T = std::remove_pointer_t<decltype(pTypeTag)>;
+            double *const padfLine = adfLine.data();
+            size_t ii = 0;
+            for (int iLine = 0; iLine < nYSize; ++iLine, ii += nXSize)
+            {
+                const T *const pSrc =
+                    static_cast<const T *>(papoSources[0]) + ii;
+                for (int iCol = 0; iCol < nXSize; ++iCol)
+                {
+                    padfLine[iCol] =
+                        static_cast<double>(pSrc[iCol]) * dfScale + dfOffset;
+                }
+                CopyLineToBuffer(padfLine, pData, iLine, nXSize, eBufType,
+                                 nPixelSpace, nLineSpace);
+            }
+        });
 
     /* ---- Return success ---- */
     return CE_None;
@@ -1488,27 +1578,35 @@ static CPLErr NormDiffPixelFunc(void **papoSources, int nSources, void *pData,
     }
 
     /* ---- Set pixels ---- */
-    size_t ii = 0;
-    for (int iLine = 0; iLine < nYSize; ++iLine)
-    {
-        for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
+    std::vector<double> adfLine(nXSize);
+    DispatchRealSrcType(
+        eSrcType,
+        [&](auto pTypeTag)
         {
-            const double dfLeftVal = GetSrcVal(papoSources[0], eSrcType, ii);
-            const double dfRightVal = GetSrcVal(papoSources[1], eSrcType, ii);
-
-            const double dfDenom = (dfLeftVal + dfRightVal);
+            using T = std::remove_pointer_t<decltype(pTypeTag)>;
+            double *const padfLine = adfLine.data();
+            size_t ii = 0;
+            for (int iLine = 0; iLine < nYSize; ++iLine, ii += nXSize)
+            {
+                const T *const pSrc0 =
+                    static_cast<const T *>(papoSources[0]) + ii;
+                const T *const pSrc1 =
+                    static_cast<const T *>(papoSources[1]) + ii;
+                for (int iCol = 0; iCol < nXSize; ++iCol)
+                {
+                    const double dfLeftVal = static_cast<double>(pSrc0[iCol]);
+                    const double dfRightVal = static_cast<double>(pSrc1[iCol]);
 
-            const double dfPixVal =
-                dfDenom == 0 ? std::numeric_limits<double>::infinity()
-                             : (dfLeftVal - dfRightVal) / dfDenom;
+                    const double dfDenom = (dfLeftVal + dfRightVal);
 
-            GDALCopyWords(&dfPixVal, GDT_Float64, 0,
-                          static_cast<GByte *>(pData) +
-                              static_cast<GSpacing>(nLineSpace) * iLine +
-                              iCol * nPixelSpace,
-                          eBufType, nPixelSpace, 1);
-        }
-    }
+                    padfLine[iCol] =
+                        dfDenom == 0 ? std::numeric_limits<double>::infinity()
+                                     : (dfLeftVal - dfRightVal) / dfDenom;
+                }
+                CopyLineToBuffer(padfLine, pData, iLine, nXSize, eBufType,
+                                 nPixelSpace, nLineSpace);
+            }
+        });
 
     /* ---- Return success ---- */
     return CE_None;
@@ -1550,43 +1648,50 @@ static CPLErr MinOrMaxPixelFunc(void **papoSources, int nSources, void *pData,
         CSLFetchNameValueDef(papszArgs, "propagateNoData", "false"));
 
     /* ---- Set pixels ---- */
-    size_t ii = 0;
-    for (int iLine = 0; iLine < nYSize; ++iLine)
-    {
-        for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
+    std::vector<double> adfLine(nXSize);
+    DispatchRealSrcType(
+        eSrcType,
+        [&](auto pTypeTag)
         {
-            double dfRes = std::numeric_limits<double>::quiet_NaN();
-
-            for (int iSrc = 0; iSrc < nSources; ++iSrc)
+            using T = std::remove_pointer_t<decltype(pTypeTag)>;
+            double *const padfLine = adfLine.data();
+            size_t ii = 0;
+            for (int iLine = 0; iLine < nYSize; ++iLine)
             {
-                const double dfVal = GetSrcVal(papoSources[iSrc], eSrcType, ii);
-
-                if (std::isnan(dfVal) || dfVal == dfNoData)
+                for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
                 {
-                    if (bPropagateNoData)
+                    double dfRes = std::numeric_limits<double>::quiet_NaN();
+
+                    for (int iSrc = 0; iSrc < nSources; ++iSrc)
+                    {
+                        const double dfVal = static_cast<double>(
+                            static_cast<const T *>(papoSources[iSrc])[ii]);
+
+                        if (std::isnan(dfVal) || dfVal == dfNoData)
+                        {
+                            if (bPropagateNoData)
+                            {
+                                dfRes = dfNoData;
+                                break;
+                            }
+                        }
+                        else if (Comparator::compare(dfVal, dfRes))
+                        {
+                            dfRes = dfVal;
+                        }
+                    }
+
+                    if (!bPropagateNoData && std::isnan(dfRes))
                     {
                         dfRes = dfNoData;
-                        break;
                     }
-                }
-                else if (Comparator::compare(dfVal, dfRes))
-                {
-                    dfRes = dfVal;
-                }
-            }
 
-            if (!bPropagateNoData && std::isnan(dfRes))
-            {
-                dfRes = dfNoData;
+                    padfLine[iCol] = dfRes;
+                }
+                CopyLineToBuffer(padfLine, pData, iLine, nXSize, eBufType,
+                                 nPixelSpace, nLineSpace);
             }
-
-            GDALCopyWords(&dfRes, GDT_Float64, 0,
-                          static_cast<GByte *>(pData) +
-                              static_cast<GSpacing>(nLineSpace) * iLine +
-                              iCol * nPixelSpace,
-                          eBufType, nPixelSpace, 1);
-        }
-    }
+        });
 
     /* ---- Return success ---- */
     return CE_None;
@@ -1628,6 +1733,177 @@ static CPLErr MaxPixelFunc(void **papoSources, int nSources, void *pData,
                                          nPixelSpace, nLineSpace, papszArgs);
 }
 
+/************************************************************************/
+/*                        ExpressionPixelFunc()                         */
+/************************************************************************/
+
+static const char pszExpressionPixelFuncMetadata[] =
+    "<PixelFunctionArgumentsList>"
+    "   <Argument name='expression' description='Arithmetic expression "
+    "referencing sources as B1, B2, ...' type='string' />"
+    "</PixelFunctionArgumentsList>";
+
+// Evaluates the expression on lines [nLineStart, nLineEnd[, by chunks of
+// VRTExpression::CHUNK_SIZE pixels converted to double.
+static void EvaluateExpressionOnLines(const VRTExpression &oExpr,
+                                      void **papoSources, int nSources,
+                                      void *pData, int nXSize, int nLineStart,
+                                      int nLineEnd, GDALDataType eSrcType,
+                                      GDALDataType eBufType, int nPixelSpace,
+                                      int nLineSpace)
+{
+    constexpr int CHUNK_SIZE = VRTExpression::CHUNK_SIZE;
+    const auto &anUsedSources = oExpr.GetUsedSources();
+    const int nSrcTypeSize = GDALGetDataTypeSizeBytes(eSrcType);
+
+    std::vector<double> adfSources(anUsedSources.size() * CHUNK_SIZE);
+    std::vector<const double *> apadfSources(nSources, nullptr);
+    for (size_t i = 0; i < anUsedSources.size(); ++i)
+        apadfSources[anUsedSources[i]] = adfSources.data() + i * CHUNK_SIZE;
+    std::vector<double> adfScratch(oExpr.GetScratchSize());
+    double adfOut[CHUNK_SIZE];
+
+    for (int iLine = nLineStart; iLine < nLineEnd; ++iLine)
+    {
+        for (int iCol = 0; iCol < nXSize; iCol += CHUNK_SIZE)
+        {
+            const int nCount = std::min(CHUNK_SIZE, nXSize - iCol);
+            const size_t ii = static_cast<size_t>(iLine) * nXSize + iCol;
+            for (size_t i = 0; i < anUsedSources.size(); ++i)
+            {
+                GDALCopyWords(static_cast<const GByte *>(
+                                  papoSources[anUsedSources[i]]) +
+                                  ii * nSrcTypeSize,
+                              eSrcType, nSrcTypeSize,
+                              adfSources.data() + i * CHUNK_SIZE, GDT_Float64,
+                              static_cast<int>(sizeof(double)), nCount);
+            }
+
+            oExpr.Evaluate(apadfSources.data(), nCount, adfScratch.data(),
+                           adfOut);
+
+            GDALCopyWords(adfOut, GDT_Float64, static_cast<int>(sizeof(double)),
+                          static_cast<GByte *>(pData) +
+                              static_cast<GSpacing>(nLineSpace) * iLine +
+                              static_cast<GSpacing>(iCol) * nPixelSpace,
+                          eBufType, nPixelSpace, nCount);
+        }
+    }
+}
+
+static CPLErr ExpressionPixelFunc(void **papoSources, int nSources, void *pData,
+                                  int nXSize, int nYSize, GDALDataType eSrcType,
+                                  GDALDataType eBufType, int nPixelSpace,
+                                  int nLineSpace, CSLConstList papszArgs)
+{
+    /* ---- Init ---- */
+    if (GDALDataTypeIsComplex(eSrcType))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "expression cannot by applied to complex data types");
+        return CE_Failure;
+    }
+
+    const char *pszExpression = CSLFetchNameValue(papszArgs, "expression");
+    if (pszExpression == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Missing pixel function argument: expression");
+        return CE_Failure;
+    }
+
+    const auto poExpr = VRTExpression::CompileCached(pszExpression, nSources);
+    if (!poExpr)
+        return CE_Failure;
+
+    /* ---- Set pixels ---- */
+
+    // Split big requests in bands of lines processed by the global thread
+    // pool, when GDAL_NUM_THREADS is set.
+    constexpr int MIN_PIXELS_PER_JOB = 65536;
+    int nThreads = 1;
+    const char *pszValue = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszValue)
+    {
+        nThreads =
+            EQUAL(pszValue, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszValue);
+        if (nThreads > 1024)
+            nThreads = 1024;  // to please Coverity
+    }
+    const int nLinesPerJob =
+        std::max(1, MIN_PIXELS_PER_JOB / std::max(1, nXSize));
+    const int nJobs =
+        std::min(nThreads, (nYSize + nLinesPerJob - 1) / nLinesPerJob);
+    CPLWorkerThreadPool *poThreadPool =
+        nJobs > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    if (!poQueue)
+    {
+        EvaluateExpressionOnLines(*poExpr, papoSources, nSources, pData,
+                                  nXSize, 0, nYSize, eSrcType, eBufType,
+                                  nPixelSpace, nLineSpace);
+        return CE_None;
+    }
+
+    struct Job
+    {
+        const VRTExpression *poExpr = nullptr;
+        void **papoSources = nullptr;
+        int nSources = 0;
+        void *pData = nullptr;
+        int nXSize = 0;
+        int nLineStart = 0;
+        int nLineEnd = 0;
+        GDALDataType eSrcType = GDT_Unknown;
+        GDALDataType eBufType = GDT_Unknown;
+        int nPixelSpace = 0;
+        int nLineSpace = 0;
+    };
+
+    const auto JobRunner = [](void *pJobData)
+    {
+        const auto psJob = static_cast<const Job *>(pJobData);
+        EvaluateExpressionOnLines(
+            *(psJob->poExpr), psJob->papoSources, psJob->nSources,
+            psJob->pData, psJob->nXSize, psJob->nLineStart, psJob->nLineEnd,
+            psJob->eSrcType, psJob->eBufType, psJob->nPixelSpace,
+            psJob->nLineSpace);
+    };
+
+    std::vector<Job> asJobs(nJobs);
+    for (int i = 0; i < nJobs; ++i)
+    {
+        auto &sJob = asJobs[i];
+        sJob.poExpr = poExpr.get();
+        sJob.papoSources = papoSources;
+        sJob.nSources = nSources;
+        sJob.pData = pData;
+        sJob.nXSize = nXSize;
+        sJob.nLineStart =
+            static_cast<int>(static_cast<int64_t>(nYSize) * i / nJobs);
+        sJob.nLineEnd =
+            static_cast<int>(static_cast<int64_t>(nYSize) * (i + 1) / nJobs);
+        sJob.eSrcType = eSrcType;
+        sJob.eBufType = eBufType;
+        sJob.nPixelSpace = nPixelSpace;
+        sJob.nLineSpace = nLineSpace;
+        if (!poQueue->SubmitJob(JobRunner, &sJob))
+        {
+            // Process remaining lines in this thread
+            poQueue->WaitCompletion();
+            EvaluateExpressionOnLines(*poExpr, papoSources, nSources, pData,
+                                      nXSize, sJob.nLineStart, nYSize,
+                                      eSrcType, eBufType, nPixelSpace,
+                                      nLineSpace);
+            return CE_None;
+        }
+    }
+    poQueue->WaitCompletion();
+
+    /* ---- Return success ---- */
+    return CE_None;
+} /* ExpressionPixelFunc */
+
 /************************************************************************/
 /*                     GDALRegisterDefaultPixelFunc()                   */
 /************************************************************************/
@@ -1696,6 +1972,8 @@ static CPLErr MaxPixelFunc(void **papoSources, int nSources, void *pData,
  *                      exponential interpolation
  * - "scale": Apply the RasterBand metadata values of "offset" and "scale"
  * - "nan": Convert incoming NoData values to IEEE 754 nan
+ * - "expression": evaluate an arithmetic expression referencing the sources
+ *                 as B1, B2, ..., such as ``(B1 - B2) / (B1 + B2)``
  *
  * @see GDALAddDerivedBandPixelFunc
  *
@@ -1749,5 +2027,7 @@ CPLErr GDALRegisterDefaultPixelFunc()
                                         pszMinMaxFuncMetadataNodata);
     GDALAddDerivedBandPixelFuncWithArgs("max", MaxPixelFunc,
                                         pszMinMaxFuncMetadataNodata);
+    GDALAddDerivedBandPixelFuncWithArgs("expression", ExpressionPixelFunc,
+                                        pszExpressionPixelFuncMetadata);
     return CE_None;
 }
@@ -29,6 +29,7 @@
 
 #include "vrtdataset.h"
 
+#include "cpl_mem_cache.h"
 #include "cpl_minixml.h"
 #include "cpl_string.h"
 #include "gdal_frmts.h"
@@ -37,7 +38,11 @@
 
 #include <algorithm>
 #include <cmath>
+#include <memory>
+#include <mutex>
+#include <numeric>
 #include <set>
+#include <string_view>
 #include <typeinfo>
 #include "gdal_proxy.h"
 
@@ -753,6 +758,54 @@ int VRTDataset::Identify(GDALOpenInfo *poOpenInfo)
     return FALSE;
 }
 
+/************************************************************************/
+/*                          GetParsedXMLTree()                          */
+/************************************************************************/
+
+// Minimum size of a VRT file for its parsed XML tree to be cached.
+constexpr size_t VRT_XML_CACHE_MIN_FILE_SIZE = 1024 * 1024;
+
+// Returns the parsed tree of the pszXML content of a VRT file, reusing the
+// tree of a previous opening of that file if its content has not changed.
+// This saves the cost of parsing when large VRT files, with many sources,
+// are opened repeatedly. The content is compared through its size and hash,
+// rather than through the file modification time, which has not a fine
+// enough resolution to detect quick successive rewrites of a file.
+static std::shared_ptr<const CPLXMLNode>
+GetParsedXMLTree(const char *pszFilename, const char *pszXML, size_t nXMLSize)
+{
+    struct CachedTree
+    {
+        size_t nXMLSize = 0;
+        size_t nXMLHash = 0;
+        std::shared_ptr<const CPLXMLNode> poTree{};
+    };
+
+    static lru11::Cache<std::string, CachedTree, std::mutex> oCache(4, 0);
+
+    const size_t nXMLHash =
+        std::hash<std::string_view>{}(std::string_view(pszXML, nXMLSize));
+
+    CachedTree sCachedTree;
+    if (oCache.tryGet(pszFilename, sCachedTree) &&
+        sCachedTree.nXMLSize == nXMLSize && sCachedTree.nXMLHash == nXMLHash)
+    {
+        return sCachedTree.poTree;
+    }
+
+    CPLXMLNode *psTree = CPLParseXMLString(pszXML);
+    if (psTree == nullptr)
+    {
+        oCache.remove(pszFilename);
+        return nullptr;
+    }
+    sCachedTree.nXMLSize = nXMLSize;
+    sCachedTree.nXMLHash = nXMLHash;
+    sCachedTree.poTree.reset(psTree, CPLDestroyXMLNode);
+    oCache.insert(pszFilename, sCachedTree);
+    return sCachedTree.poTree;
+}
+
 /************************************************************************/
 /*                                Open()                                */
 /************************************************************************/
@@ -774,6 +827,7 @@ GDALDataset *VRTDataset::Open(GDALOpenInfo *poOpenInfo)
     /*      Try to read the whole file into memory.                         */
     /* -------------------------------------------------------------------- */
     char *pszXML = nullptr;
+    vsi_l_offset nXMLSize = 0;
     VSILFILE *fp = poOpenInfo->fpL;
 
     char *pszVRTPath = nullptr;
@@ -782,7 +836,7 @@ GDALDataset *VRTDataset::Open(GDALOpenInfo *poOpenInfo)
         poOpenInfo->fpL = nullptr;
 
         GByte *pabyOut = nullptr;
-        if (!VSIIngestFile(fp, poOpenInfo->pszFilename, &pabyOut, nullptr,
+        if (!VSIIngestFile(fp, poOpenInfo->pszFilename, &pabyOut, &nXMLSize,
                            INT_MAX - 1))
         {
             CPL_IGNORE_RET_VAL(VSIFCloseL(fp));
@@ -874,8 +928,23 @@ GDALDataset *VRTDataset::Open(GDALOpenInfo *poOpenInfo)
     /* -------------------------------------------------------------------- */
     /*      Turn the XML representation into a VRTDataset.                  */
     /* -------------------------------------------------------------------- */
-    VRTDataset *poDS = static_cast<VRTDataset *>(
-        OpenXML(pszXML, pszVRTPath, poOpenInfo->eAccess));
+    VRTDataset *poDS = nullptr;
+    if (fp != nullptr && nXMLSize >= VRT_XML_CACHE_MIN_FILE_SIZE &&
+        CPLTestBool(CPLGetConfigOption("VRT_XML_CACHE", "YES")))
+    {
+        const auto poTree = GetParsedXMLTree(
+            poOpenInfo->pszFilename, pszXML, static_cast<size_t>(nXMLSize));
+        if (poTree)
+        {
+            poDS = static_cast<VRTDataset *>(
+                OpenXMLTree(poTree.get(), pszVRTPath, poOpenInfo->eAccess));
+        }
+    }
+    else
+    {
+        poDS = static_cast<VRTDataset *>(
+            OpenXML(pszXML, pszVRTPath, poOpenInfo->eAccess));
+    }
 
     if (poDS != nullptr)
         poDS->m_bNeedsFlush = false;
@@ -1599,7 +1668,22 @@ GDALDataset *VRTDataset::OpenXML(const char *pszXML, const char *pszVRTPath,
     if (psTree == nullptr)
         return nullptr;
 
-    CPLXMLNode *psRoot = CPLGetXMLNode(psTree.get(), "=VRTDataset");
+    return OpenXMLTree(psTree.get(), pszVRTPath, eAccessIn);
+}
+
+/************************************************************************/
+/*                            OpenXMLTree()                             */
+/*                                                                      */
+/*      Create an open VRTDataset from a parsed XML tree, which is not  */
+/*      modified.                                                       */
+/************************************************************************/
+
+GDALDataset *VRTDataset::OpenXMLTree(const CPLXMLNode *psTree,
+                                     const char *pszVRTPath,
+                                     GDALAccess eAccessIn)
+
+{
+    const CPLXMLNode *psRoot = CPLGetXMLNode(psTree, "=VRTDataset");
     if (psRoot == nullptr)
     {
         CPLError(CE_Failure, CPLE_AppDefined, "Missing VRTDataset element.");
@@ -2355,17 +2439,64 @@ CPLErr VRTDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         // they don't necessary instantiate all underlying rasterbands.
         VRTSourcedRasterBand *poBand =
             static_cast<VRTSourcedRasterBand *>(papoBands[nBands - 1]);
-        for (int iSource = 0; eErr == CE_None && iSource < poBand->nSources;
-             iSource++)
+
+        double dfXOff = nXOff;
+        double dfYOff = nYOff;
+        double dfXSize = nXSize;
+        double dfYSize = nYSize;
+        if (psExtraArg->bFloatingPointWindowValidity)
+        {
+            dfXOff = psExtraArg->dfXOff;
+            dfYOff = psExtraArg->dfYOff;
+            dfXSize = psExtraArg->dfXSize;
+            dfYSize = psExtraArg->dfYSize;
+        }
+        const std::vector<int> anSources = poBand->GetSourcesIntersectingWindow(
+            dfXOff, dfYOff, dfXSize, dfYSize);
+        int nThreads = 0;
+        if (poBand->CanMultiThreadRasterIO(anSources, dfXOff, dfYOff, dfXSize,
+                                           dfYSize, nBufXSize, nBufYSize,
+                                           nThreads))
+        {
+            CPLDebugOnly("VRT", "IRasterIO(): use multi-threaded code path");
+            GDALRasterIOExtraArg sExtraArg = *psExtraArg;
+            sExtraArg.pfnProgress = nullptr;
+            sExtraArg.pProgressData = nullptr;
+            eErr = VRTSourcedRasterBand::MultiThreadedSourcesRasterIO(
+                nThreads, anSources,
+                [poBand, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize,
+                 nBufYSize, eBufType, nBandCount, panBandMap, nPixelSpace,
+                 nLineSpace, nBandSpace, &sExtraArg](int iSource)
+                {
+                    GDALRasterIOExtraArg sExtraArgJob = sExtraArg;
+                    VRTSimpleSource *poSource =
+                        static_cast<VRTSimpleSource *>(
+                            poBand->papoSources[iSource]);
+                    return poSource->DatasetRasterIO(
+                        poBand->GetRasterDataType(), nXOff, nYOff, nXSize,
+                        nYSize, pData, nBufXSize, nBufYSize, eBufType,
+                        nBandCount, panBandMap, nPixelSpace, nLineSpace,
+                        nBandSpace, &sExtraArgJob);
+                });
+            if (eErr == CE_None && pfnProgressGlobal &&
+                !pfnProgressGlobal(1.0, "", pProgressDataGlobal))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                eErr = CE_Failure;
+            }
+            return eErr;
+        }
+
+        const int nCandidateSources = static_cast<int>(anSources.size());
+        for (int i = 0; eErr == CE_None && i < nCandidateSources; i++)
         {
             psExtraArg->pfnProgress = GDALScaledProgress;
             psExtraArg->pProgressData = GDALCreateScaledProgress(
-                1.0 * iSource / poBand->nSources,
-                1.0 * (iSource + 1) / poBand->nSources, pfnProgressGlobal,
-                pProgressDataGlobal);
+                1.0 * i / nCandidateSources, 1.0 * (i + 1) / nCandidateSources,
+                pfnProgressGlobal, pProgressDataGlobal);
 
-            VRTSimpleSource *poSource =
-                static_cast<VRTSimpleSource *>(poBand->papoSources[iSource]);
+            VRTSimpleSource *poSource = static_cast<VRTSimpleSource *>(
+                poBand->papoSources[anSources[i]]);
 
             eErr = poSource->DatasetRasterIO(
                 poBand->GetRasterDataType(), nXOff, nYOff, nXSize, nYSize,
@@ -2381,6 +2512,18 @@ CPLErr VRTDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         return eErr;
     }
 
+    if (eRWFlag == GF_Read && nBandCount > 1 && nBufXSize == nXSize &&
+        nBufYSize == nYSize)
+    {
+        bool bTried = false;
+        const CPLErr eErr = MultiThreadedBandsRasterIO(
+            nXOff, nYOff, nXSize, nYSize, pData, eBufType, nBandCount,
+            panBandMap, nPixelSpace, nLineSpace, nBandSpace, psExtraArg,
+            bTried);
+        if (bTried)
+            return eErr;
+    }
+
     CPLErr eErr;
     if (eRWFlag == GF_Read &&
         psExtraArg->eResampleAlg != GRIORA_NearestNeighbour &&
@@ -2404,6 +2547,139 @@ CPLErr VRTDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
     return eErr;
 }
 
+/************************************************************************/
+/*                     MultiThreadedBandsRasterIO()                     */
+/************************************************************************/
+
+/* Reads the contributing sources of all requested bands concurrently, when
+ * multi-threading is enabled and no source dataset is shared between two of
+ * them. This is typically the case of compositions where each band comes from
+ * a different file, such as Sentinel-2 granules, which cannot use the
+ * dataset-level code path. Sources are opened in the worker threads.
+ * Only for non-resampled reads. bTried is set to false if this code path
+ * cannot be used.
+ */
+CPLErr VRTDataset::MultiThreadedBandsRasterIO(
+    int nXOff, int nYOff, int nXSize, int nYSize, void *pData,
+    GDALDataType eBufType, int nBandCount, const int *panBandMap,
+    GSpacing nPixelSpace, GSpacing nLineSpace, GSpacing nBandSpace,
+    GDALRasterIOExtraArg *psExtraArg, bool &bTried)
+{
+    bTried = false;
+
+    const int nThreads =
+        VRTSourcedRasterBand::GetMultiThreadingThreadCount(this);
+    if (nThreads <= 1)
+        return CE_None;
+
+    double dfXOff = nXOff;
+    double dfYOff = nYOff;
+    double dfXSize = nXSize;
+    double dfYSize = nYSize;
+    if (psExtraArg->bFloatingPointWindowValidity)
+    {
+        dfXOff = psExtraArg->dfXOff;
+        dfYOff = psExtraArg->dfYOff;
+        dfXSize = psExtraArg->dfXSize;
+        dfYSize = psExtraArg->dfYSize;
+    }
+
+    struct Job
+    {
+        VRTSourcedRasterBand *poBand = nullptr;
+        VRTSimpleSource *poSource = nullptr;
+        GByte *pabyBandData = nullptr;
+    };
+
+    std::vector<Job> asJobs;
+    std::vector<VRTSimpleSource *> apoAllSources;
+    for (int iBandIndex = 0; iBandIndex < nBandCount; iBandIndex++)
+    {
+        auto poVRTBand =
+            static_cast<VRTRasterBand *>(GetRasterBand(panBandMap[iBandIndex]));
+        if (!poVRTBand->IsSourcedRasterBand())
+            return CE_None;
+        auto poBand = static_cast<VRTSourcedRasterBand *>(poVRTBand);
+        // Do not allow VRTDerivedRasterBand for example
+        if (typeid(*poBand) != typeid(VRTSourcedRasterBand))
+            return CE_None;
+
+        const std::vector<int> anSources = poBand->GetSourcesIntersectingWindow(
+            dfXOff, dfYOff, dfXSize, dfYSize);
+        std::vector<VRTSimpleSource *> apoBandSources;
+        if (!poBand->GetDisjointContributingSources(
+                anSources, dfXOff, dfYOff, dfXSize, dfYSize, nXSize, nYSize,
+                apoBandSources))
+        {
+            return CE_None;
+        }
+        for (auto *poSource : apoBandSources)
+        {
+            Job sJob;
+            sJob.poBand = poBand;
+            sJob.poSource = poSource;
+            sJob.pabyBandData =
+                static_cast<GByte *>(pData) + iBandIndex * nBandSpace;
+            asJobs.push_back(sJob);
+            apoAllSources.push_back(poSource);
+        }
+    }
+    if (asJobs.size() < 2 ||
+        !VRTSourcedRasterBand::AreSourcesFromDistinctDatasets(apoAllSources))
+    {
+        return CE_None;
+    }
+
+    bTried = true;
+    CPLDebugOnly("VRT", "IRasterIO(): use multi-threaded band code path");
+
+    for (int iBandIndex = 0; iBandIndex < nBandCount; iBandIndex++)
+    {
+        VRTSourcedRasterBand *poBand = static_cast<VRTSourcedRasterBand *>(
+            GetRasterBand(panBandMap[iBandIndex]));
+
+        /* Dirty little trick to initialize the buffer without doing */
+        /* any real I/O */
+        const int nSavedSources = poBand->nSources;
+        poBand->nSources = 0;
+
+        GByte *pabyBandData =
+            static_cast<GByte *>(pData) + iBandIndex * nBandSpace;
+
+        poBand->IRasterIO(GF_Read, nXOff, nYOff, nXSize, nYSize, pabyBandData,
+                          nXSize, nYSize, eBufType, nPixelSpace, nLineSpace,
+                          psExtraArg);
+
+        poBand->nSources = nSavedSources;
+    }
+
+    std::vector<int> anJobs(asJobs.size());
+    std::iota(anJobs.begin(), anJobs.end(), 0);
+    GDALRasterIOExtraArg sExtraArg = *psExtraArg;
+    sExtraArg.pfnProgress = nullptr;
+    sExtraArg.pProgressData = nullptr;
+    CPLErr eErr = VRTSourcedRasterBand::MultiThreadedSourcesRasterIO(
+        std::min(nThreads, static_cast<int>(asJobs.size())), anJobs,
+        [&asJobs, nXOff, nYOff, nXSize, nYSize, eBufType, nPixelSpace,
+         nLineSpace, &sExtraArg](int iJob)
+        {
+            const Job &sJob = asJobs[iJob];
+            GDALRasterIOExtraArg sExtraArgJob = sExtraArg;
+            VRTSource::WorkingState oWorkingState;
+            return sJob.poSource->RasterIO(
+                sJob.poBand->GetRasterDataType(), nXOff, nYOff, nXSize, nYSize,
+                sJob.pabyBandData, nXSize, nYSize, eBufType, nPixelSpace,
+                nLineSpace, &sExtraArgJob, oWorkingState);
+        });
+    if (eErr == CE_None && psExtraArg->pfnProgress &&
+        !psExtraArg->pfnProgress(1.0, "", psExtraArg->pProgressData))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        eErr = CE_Failure;
+    }
+    return eErr;
+}
+
 /************************************************************************/
 /*                  UnsetPreservedRelativeFilenames()                   */
 /************************************************************************/
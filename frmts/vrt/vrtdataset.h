@@ -35,6 +35,7 @@
 
 #include "cpl_hash_set.h"
 #include "cpl_minixml.h"
+#include "cpl_packed_rtree.h"
 #include "gdal_pam.h"
 #include "gdal_priv.h"
 #include "gdal_rat.h"
@@ -229,6 +230,15 @@ class CPL_DLL VRTDataset CPL_NON_FINAL : public GDALDataset
     int m_bCompatibleForDatasetIO = -1;
     int CheckCompatibleForDatasetIO();
 
+    CPLErr MultiThreadedBandsRasterIO(int nXOff, int nYOff, int nXSize,
+                                      int nYSize, void *pData,
+                                      GDALDataType eBufType, int nBandCount,
+                                      const int *panBandMap,
+                                      GSpacing nPixelSpace, GSpacing nLineSpace,
+                                      GSpacing nBandSpace,
+                                      GDALRasterIOExtraArg *psExtraArg,
+                                      bool &bTried);
+
     // Virtual (ie not materialized) overviews, created either implicitly
     // when it is cheap to do it, or explicitly.
     std::vector<GDALDataset *> m_apoOverviews{};
@@ -368,6 +378,9 @@ class CPL_DLL VRTDataset CPL_NON_FINAL : public GDALDataset
     static GDALDataset *Open(GDALOpenInfo *);
     static GDALDataset *OpenXML(const char *, const char * = nullptr,
                                 GDALAccess eAccess = GA_ReadOnly);
+    static GDALDataset *OpenXMLTree(const CPLXMLNode *psTree,
+                                    const char *pszVRTPath,
+                                    GDALAccess eAccess = GA_ReadOnly);
     static GDALDataset *Create(const char *pszName, int nXSize, int nYSize,
                                int nBands, GDALDataType eType,
                                char **papszOptions);
@@ -668,6 +681,13 @@ class CPL_DLL VRTSourcedRasterBand CPL_NON_FINAL : public VRTRasterBand
     char **m_papszSourceList = nullptr;
     int m_nSkipBufferInitialization = -1;
 
+    // Spatial index of the destination windows of the sources, lazily built
+    // for bands with many sources. Features are source indices.
+    std::unique_ptr<CPLPackedRTree> m_poSourcesRTree{};
+    int m_nSourcesInRTree = 0;
+
+    void InvalidateSourcesRTree();
+
     bool CanUseSourcesMinMaxImplementations();
 
     bool IsMosaicOfNonOverlappingSimpleSourcesOfFullRasterNoResAndTypeChange(
@@ -786,6 +806,30 @@ class CPL_DLL VRTSourcedRasterBand CPL_NON_FINAL : public VRTRasterBand
         GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
         int nBufXSize, int nBufYSize, GDALRasterIOExtraArg *psExtraArg) const;
 
+    std::vector<int> GetSourcesIntersectingWindow(double dfXOff, double dfYOff,
+                                                  double dfXSize,
+                                                  double dfYSize);
+
+    static int GetMultiThreadingThreadCount(GDALDataset *poVRTDS);
+
+    bool GetDisjointContributingSources(
+        const std::vector<int> &anSources, double dfXOff, double dfYOff,
+        double dfXSize, double dfYSize, int nBufXSize, int nBufYSize,
+        std::vector<VRTSimpleSource *> &apoContributingSourcesOut) const;
+
+    static bool
+    AreSourcesFromDistinctDatasets(const std::vector<VRTSimpleSource *> &);
+
+    bool CanMultiThreadRasterIO(const std::vector<int> &anSources,
+                                double dfXOff, double dfYOff, double dfXSize,
+                                double dfYSize, int nBufXSize, int nBufYSize,
+                                int &nThreadsOut) const;
+
+    static CPLErr
+    MultiThreadedSourcesRasterIO(int nThreads,
+                                 const std::vector<int> &anSources,
+                                 const std::function<CPLErr(int)> &fnFunc);
+
     virtual CPLErr IReadBlock(int, int, void *) override;
 
     virtual void GetFileList(char ***ppapszFileList, int *pnSize,
@@ -1311,6 +1355,16 @@ class CPL_DLL VRTComplexSource CPL_NON_FINAL : public VRTSimpleSource
                                  GDALRasterIOExtraArg *psExtraArg,
                                  WorkingState &oWorkingState);
 
+    template <class SourceDT, GDALDataType eSourceType>
+    CPLErr RasterIOProcessColorTable(GDALRasterBand *poSourceBand,
+                                     int nReqXOff, int nReqYOff,
+                                     int nReqXSize, int nReqYSize,
+                                     void *pData, int nOutXSize,
+                                     int nOutYSize, GSpacing nPixelSpace,
+                                     GSpacing nLineSpace,
+                                     GDALRasterIOExtraArg *psExtraArg,
+                                     WorkingState &oWorkingState);
+
   public:
     VRTComplexSource() = default;
     VRTComplexSource(const VRTComplexSource *poSrcSource, double dfXDstRatio,
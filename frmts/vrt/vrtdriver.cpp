@@ -547,6 +547,10 @@ void GDALRegister_VRT()
         "relative paths inside the VRT. Mainly useful for inlined VRT, or "
         "in-memory "
         "VRT, where their own directory does not make sense'/>"
+        "  <Option name='NUM_THREADS' type='string' description="
+        "'Number of worker threads for reading non-overlapping sources, or "
+        "ALL_CPUS. Defaults to the value of the GDAL_NUM_THREADS "
+        "configuration option'/>"
         "</OpenOptionList>");
 
     poDriver->SetMetadataItem(GDAL_DCAP_VIRTUALIO, "YES");
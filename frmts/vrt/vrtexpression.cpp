@@ -0,0 +1,855 @@
+/******************************************************************************
+ *
+ * Project:  Virtual GDAL Datasets
+ * Purpose:  Compiled arithmetic expressions for the "expression" pixel
+ *           function of derived bands.
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "vrtexpression.h"
+
+#include "cpl_conv.h"
+#include "cpl_error.h"
+#include "cpl_string.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <utility>
+
+/*! @cond Doxygen_Suppress */
+
+using Op = VRTExpression::Op;
+
+/************************************************************************/
+/*                           Scalar operators                           */
+/************************************************************************/
+
+// Truth values are represented as 1 and 0. Any non-zero value is true.
+
+static inline double EvalUnary(Op eOp, double a)
+{
+    switch (eOp)
+    {
+        case Op::NEG:
+            return -a;
+        case Op::NOT:
+            return a == 0 ? 1.0 : 0.0;
+        case Op::ABS:
+            return std::fabs(a);
+        case Op::SQRT:
+            return std::sqrt(a);
+        case Op::EXP:
+            return std::exp(a);
+        case Op::LOG:
+            return std::log(a);
+        case Op::LOG10:
+            return std::log10(a);
+        case Op::SIN:
+            return std::sin(a);
+        case Op::COS:
+            return std::cos(a);
+        case Op::TAN:
+            return std::tan(a);
+        case Op::ASIN:
+            return std::asin(a);
+        case Op::ACOS:
+            return std::acos(a);
+        case Op::ATAN:
+            return std::atan(a);
+        case Op::SINH:
+            return std::sinh(a);
+        case Op::COSH:
+            return std::cosh(a);
+        case Op::TANH:
+            return std::tanh(a);
+        case Op::FLOOR:
+            return std::floor(a);
+        case Op::CEIL:
+            return std::ceil(a);
+        case Op::ROUND:
+            return std::round(a);
+        case Op::ISNAN:
+            return std::isnan(a) ? 1.0 : 0.0;
+        case Op::ISINF:
+            return std::isinf(a) ? 1.0 : 0.0;
+        default:
+            break;
+    }
+    CPLAssert(false);
+    return 0;
+}
+
+static inline double EvalBinary(Op eOp, double a, double b)
+{
+    switch (eOp)
+    {
+        case Op::ADD:
+            return a + b;
+        case Op::SUB:
+            return a - b;
+        case Op::MUL:
+            return a * b;
+        case Op::DIV:
+            return a / b;
+        case Op::MOD:
+            return std::fmod(a, b);
+        case Op::POW:
+            return std::pow(a, b);
+        case Op::ATAN2:
+            return std::atan2(a, b);
+        case Op::HYPOT:
+            return std::hypot(a, b);
+        case Op::MIN:
+            return std::fmin(a, b);
+        case Op::MAX:
+            return std::fmax(a, b);
+        case Op::LT:
+            return a < b ? 1.0 : 0.0;
+        case Op::LE:
+            return a <= b ? 1.0 : 0.0;
+        case Op::GT:
+            return a > b ? 1.0 : 0.0;
+        case Op::GE:
+            return a >= b ? 1.0 : 0.0;
+        case Op::EQ:
+            return a == b ? 1.0 : 0.0;
+        case Op::NE:
+            return a != b ? 1.0 : 0.0;
+        case Op::AND:
+            return (a != 0 && b != 0) ? 1.0 : 0.0;
+        case Op::OR:
+            return (a != 0 || b != 0) ? 1.0 : 0.0;
+        default:
+            break;
+    }
+    CPLAssert(false);
+    return 0;
+}
+
+static inline double EvalSelect(double c, double a, double b)
+{
+    return c != 0 ? a : b;
+}
+
+/************************************************************************/
+/*                          Vector operators                            */
+/************************************************************************/
+
+// Each case is a separate loop with a compile-time known operation, so
+// that the compiler can vectorize the simple ones.
+
+#define UNARY_CASE(op)                                                         \
+    case Op::op:                                                               \
+        for (int i = 0; i < n; ++i)                                            \
+            out[i] = EvalUnary(Op::op, a[i]);                                  \
+        break
+
+static void ApplyUnary(Op eOp, const double *a, double *out, int n)
+{
+    switch (eOp)
+    {
+        UNARY_CASE(NEG);
+        UNARY_CASE(NOT);
+        UNARY_CASE(ABS);
+        UNARY_CASE(SQRT);
+        UNARY_CASE(EXP);
+        UNARY_CASE(LOG);
+        UNARY_CASE(LOG10);
+        UNARY_CASE(SIN);
+        UNARY_CASE(COS);
+        UNARY_CASE(TAN);
+        UNARY_CASE(ASIN);
+        UNARY_CASE(ACOS);
+        UNARY_CASE(ATAN);
+        UNARY_CASE(SINH);
+        UNARY_CASE(COSH);
+        UNARY_CASE(TANH);
+        UNARY_CASE(FLOOR);
+        UNARY_CASE(CEIL);
+        UNARY_CASE(ROUND);
+        UNARY_CASE(ISNAN);
+        UNARY_CASE(ISINF);
+        default:
+            CPLAssert(false);
+            break;
+    }
+}
+
+#undef UNARY_CASE
+
+#define BINARY_CASE(op)                                                        \
+    case Op::op:                                                               \
+        for (int i = 0; i < n; ++i)                                            \
+            out[i] = EvalBinary(Op::op, a[i], b[i]);                           \
+        break
+
+static void ApplyBinary(Op eOp, const double *a, const double *b, double *out,
+                        int n)
+{
+    switch (eOp)
+    {
+        BINARY_CASE(ADD);
+        BINARY_CASE(SUB);
+        BINARY_CASE(MUL);
+        BINARY_CASE(DIV);
+        BINARY_CASE(MOD);
+        BINARY_CASE(POW);
+        BINARY_CASE(ATAN2);
+        BINARY_CASE(HYPOT);
+        BINARY_CASE(MIN);
+        BINARY_CASE(MAX);
+        BINARY_CASE(LT);
+        BINARY_CASE(LE);
+        BINARY_CASE(GT);
+        BINARY_CASE(GE);
+        BINARY_CASE(EQ);
+        BINARY_CASE(NE);
+        BINARY_CASE(AND);
+        BINARY_CASE(OR);
+        default:
+            CPLAssert(false);
+            break;
+    }
+}
+
+#undef BINARY_CASE
+
+static int GetArity(Op eOp)
+{
+    if (eOp == Op::PUSH_SOURCE || eOp == Op::PUSH_CONST)
+        return 0;
+    if (eOp < Op::ADD)
+        return 1;
+    if (eOp < Op::SELECT)
+        return 2;
+    return 3;
+}
+
+/************************************************************************/
+/*                        VRTExpressionParser                           */
+/************************************************************************/
+
+// Recursive descent parser, directly emitting instructions in postfix
+// order. Precedence, from lowest to highest:
+//   ?: (right associative), ||, &&, == !=, < <= > >=, + -, * / %,
+//   unary - + !, ^ (right associative)
+
+class VRTExpressionParser
+{
+  public:
+    VRTExpressionParser(const std::string &osExpr, int nSources,
+                        VRTExpression &oExpr)
+        : m_osExpr(osExpr), m_nSources(nSources), m_oExpr(oExpr)
+    {
+    }
+
+    bool Parse();
+
+  private:
+    const std::string &m_osExpr;
+    const int m_nSources;
+    VRTExpression &m_oExpr;
+    size_t m_nPos = 0;
+    int m_nStackDepth = 0;
+    int m_nRecursionDepth = 0;
+    bool m_bError = false;
+
+    static constexpr int MAX_RECURSION_DEPTH = 256;
+
+    void SkipSpaces();
+    bool Match(const char *pszToken);
+    void Error(const char *pszMsg);
+    void Emit(Op eOp, int nSource = 0, double dfValue = 0);
+
+    void ParseTernary();
+    void ParseOr();
+    void ParseAnd();
+    void ParseEquality();
+    void ParseRelational();
+    void ParseAdditive();
+    void ParseMultiplicative();
+    void ParseUnary();
+    void ParsePower();
+    void ParsePrimary();
+    void ParseFunctionCall(const std::string &osName);
+};
+
+void VRTExpressionParser::SkipSpaces()
+{
+    while (m_nPos < m_osExpr.size() &&
+           isspace(static_cast<unsigned char>(m_osExpr[m_nPos])))
+    {
+        ++m_nPos;
+    }
+}
+
+bool VRTExpressionParser::Match(const char *pszToken)
+{
+    SkipSpaces();
+    const size_t nLen = strlen(pszToken);
+    if (m_osExpr.compare(m_nPos, nLen, pszToken) != 0)
+        return false;
+    // Do not match "<" in "<=", "!" in "!=" etc.
+    if (nLen == 1 && m_nPos + 1 < m_osExpr.size() &&
+        m_osExpr[m_nPos + 1] == '=' &&
+        (pszToken[0] == '<' || pszToken[0] == '>' || pszToken[0] == '!' ||
+         pszToken[0] == '='))
+    {
+        return false;
+    }
+    m_nPos += nLen;
+    return true;
+}
+
+void VRTExpressionParser::Error(const char *pszMsg)
+{
+    if (!m_bError)
+    {
+        m_bError = true;
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Invalid expression '%s': %s at position %d.",
+                 m_osExpr.c_str(), pszMsg, static_cast<int>(m_nPos));
+    }
+}
+
+void VRTExpressionParser::Emit(Op eOp, int nSource, double dfValue)
+{
+    if (m_bError)
+        return;
+
+    auto &aoInstrs = m_oExpr.m_aoInstrs;
+    const int nArity = GetArity(eOp);
+
+    // Constant folding: in postfix order, if the last nArity instructions
+    // push constants, they are the operands of this operator.
+    if (nArity > 0 && static_cast<int>(aoInstrs.size()) >= nArity &&
+        std::all_of(aoInstrs.end() - nArity, aoInstrs.end(),
+                    [](const VRTExpression::Instr &sInstr)
+                    { return sInstr.eOp == Op::PUSH_CONST; }))
+    {
+        double adfArgs[3] = {0, 0, 0};
+        for (int i = 0; i < nArity; ++i)
+            adfArgs[i] = aoInstrs[aoInstrs.size() - nArity + i].dfValue;
+        double dfRes;
+        if (nArity == 1)
+            dfRes = EvalUnary(eOp, adfArgs[0]);
+        else if (nArity == 2)
+            dfRes = EvalBinary(eOp, adfArgs[0], adfArgs[1]);
+        else
+            dfRes = EvalSelect(adfArgs[0], adfArgs[1], adfArgs[2]);
+        aoInstrs.resize(aoInstrs.size() - nArity);
+        m_nStackDepth -= nArity;
+        eOp = Op::PUSH_CONST;
+        dfValue = dfRes;
+    }
+
+    aoInstrs.push_back({eOp, nSource, dfValue});
+    m_nStackDepth += (nArity == 0) ? 1 : 1 - nArity;
+    m_oExpr.m_nMaxStackDepth =
+        std::max(m_oExpr.m_nMaxStackDepth, m_nStackDepth);
+}
+
+bool VRTExpressionParser::Parse()
+{
+    ParseTernary();
+    SkipSpaces();
+    if (!m_bError && m_nPos != m_osExpr.size())
+        Error("unexpected character");
+    if (m_bError)
+        return false;
+    CPLAssert(m_nStackDepth == 1);
+
+    auto &anUsedSources = m_oExpr.m_anUsedSources;
+    for (const auto &sInstr : m_oExpr.m_aoInstrs)
+    {
+        if (sInstr.eOp == Op::PUSH_SOURCE)
+            anUsedSources.push_back(sInstr.nSource);
+    }
+    std::sort(anUsedSources.begin(), anUsedSources.end());
+    anUsedSources.erase(std::unique(anUsedSources.begin(), anUsedSources.end()),
+                        anUsedSources.end());
+    return true;
+}
+
+void VRTExpressionParser::ParseTernary()
+{
+    if (++m_nRecursionDepth > MAX_RECURSION_DEPTH)
+    {
+        Error("expression too deeply nested");
+        --m_nRecursionDepth;
+        return;
+    }
+    ParseOr();
+    if (!m_bError && Match("?"))
+    {
+        ParseTernary();
+        if (!m_bError && !Match(":"))
+            Error("':' expected");
+        ParseTernary();
+        Emit(Op::SELECT);
+    }
+    --m_nRecursionDepth;
+}
+
+void VRTExpressionParser::ParseOr()
+{
+    ParseAnd();
+    while (!m_bError && Match("||"))
+    {
+        ParseAnd();
+        Emit(Op::OR);
+    }
+}
+
+void VRTExpressionParser::ParseAnd()
+{
+    ParseEquality();
+    while (!m_bError && Match("&&"))
+    {
+        ParseEquality();
+        Emit(Op::AND);
+    }
+}
+
+void VRTExpressionParser::ParseEquality()
+{
+    ParseRelational();
+    while (!m_bError)
+    {
+        Op eOp;
+        if (Match("=="))
+            eOp = Op::EQ;
+        else if (Match("!="))
+            eOp = Op::NE;
+        else
+            break;
+        ParseRelational();
+        Emit(eOp);
+    }
+}
+
+void VRTExpressionParser::ParseRelational()
+{
+    ParseAdditive();
+    while (!m_bError)
+    {
+        Op eOp;
+        if (Match("<="))
+            eOp = Op::LE;
+        else if (Match(">="))
+            eOp = Op::GE;
+        else if (Match("<"))
+            eOp = Op::LT;
+        else if (Match(">"))
+            eOp = Op::GT;
+        else
+            break;
+        ParseAdditive();
+        Emit(eOp);
+    }
+}
+
+void VRTExpressionParser::ParseAdditive()
+{
+    ParseMultiplicative();
+    while (!m_bError)
+    {
+        Op eOp;
+        if (Match("+"))
+            eOp = Op::ADD;
+        else if (Match("-"))
+            eOp = Op::SUB;
+        else
+            break;
+        ParseMultiplicative();
+        Emit(eOp);
+    }
+}
+
+void VRTExpressionParser::ParseMultiplicative()
+{
+    ParseUnary();
+    while (!m_bError)
+    {
+        Op eOp;
+        if (Match("*"))
+            eOp = Op::MUL;
+        else if (Match("/"))
+            eOp = Op::DIV;
+        else if (Match("%"))
+            eOp = Op::MOD;
+        else
+            break;
+        ParseUnary();
+        Emit(eOp);
+    }
+}
+
+void VRTExpressionParser::ParseUnary()
+{
+    if (++m_nRecursionDepth > MAX_RECURSION_DEPTH)
+    {
+        Error("expression too deeply nested");
+    }
+    else if (Match("-"))
+    {
+        ParseUnary();
+        Emit(Op::NEG);
+    }
+    else if (Match("+"))
+    {
+        ParseUnary();
+    }
+    else if (Match("!"))
+    {
+        ParseUnary();
+        Emit(Op::NOT);
+    }
+    else
+    {
+        ParsePower();
+    }
+    --m_nRecursionDepth;
+}
+
+void VRTExpressionParser::ParsePower()
+{
+    ParsePrimary();
+    if (!m_bError && Match("^"))
+    {
+        // Right associative, and binds tighter than unary minus on its left
+        // but not on its right: -2^2 = -4, 2^-1 = 0.5
+        ParseUnary();
+        Emit(Op::POW);
+    }
+}
+
+void VRTExpressionParser::ParsePrimary()
+{
+    if (m_bError)
+        return;
+    SkipSpaces();
+    if (m_nPos == m_osExpr.size())
+    {
+        Error("unexpected end of expression");
+        return;
+    }
+
+    const char *pszStart = m_osExpr.c_str() + m_nPos;
+    const char chFirst = *pszStart;
+    if (isdigit(static_cast<unsigned char>(chFirst)) || chFirst == '.')
+    {
+        char *pszEnd = nullptr;
+        const double dfVal = CPLStrtod(pszStart, &pszEnd);
+        if (pszEnd == pszStart)
+        {
+            Error("invalid number");
+            return;
+        }
+        m_nPos += pszEnd - pszStart;
+        Emit(Op::PUSH_CONST, 0, dfVal);
+        return;
+    }
+
+    if (isalpha(static_cast<unsigned char>(chFirst)) || chFirst == '_')
+    {
+        const size_t nStart = m_nPos;
+        while (m_nPos < m_osExpr.size() &&
+               (isalnum(static_cast<unsigned char>(m_osExpr[m_nPos])) ||
+                m_osExpr[m_nPos] == '_'))
+        {
+            ++m_nPos;
+        }
+        const std::string osName =
+            CPLString(m_osExpr.substr(nStart, m_nPos - nStart)).tolower();
+        if (Match("("))
+        {
+            ParseFunctionCall(osName);
+            return;
+        }
+
+        if (osName.size() >= 2 && osName[0] == 'b' &&
+            std::all_of(osName.begin() + 1, osName.end(),
+                        [](char ch)
+                        { return isdigit(static_cast<unsigned char>(ch)); }))
+        {
+            const int nBand = atoi(osName.c_str() + 1);
+            if (osName.size() > 10 || nBand < 1 || nBand > m_nSources)
+            {
+                m_nPos = nStart;
+                Error(CPLSPrintf("%s does not refer to one of the %d sources",
+                                 osName.c_str(), m_nSources));
+                return;
+            }
+            Emit(Op::PUSH_SOURCE, nBand - 1);
+        }
+        else if (osName == "pi")
+        {
+            Emit(Op::PUSH_CONST, 0, M_PI);
+        }
+        else if (osName == "nan")
+        {
+            Emit(Op::PUSH_CONST, 0, std::numeric_limits<double>::quiet_NaN());
+        }
+        else if (osName == "inf")
+        {
+            Emit(Op::PUSH_CONST, 0, std::numeric_limits<double>::infinity());
+        }
+        else
+        {
+            m_nPos = nStart;
+            Error(CPLSPrintf("unknown identifier '%s'", osName.c_str()));
+        }
+        return;
+    }
+
+    if (Match("("))
+    {
+        ParseTernary();
+        if (!m_bError && !Match(")"))
+            Error("')' expected");
+        return;
+    }
+
+    Error("unexpected character");
+}
+
+void VRTExpressionParser::ParseFunctionCall(const std::string &osName)
+{
+    struct FunctionDef
+    {
+        const char *pszName;
+        Op eOp;
+        int nArgs;  // -1: variadic with at least one argument
+    };
+
+    static const FunctionDef asFunctions[] = {
+        {"abs", Op::ABS, 1},     {"sqrt", Op::SQRT, 1},
+        {"exp", Op::EXP, 1},     {"log", Op::LOG, 1},
+        {"ln", Op::LOG, 1},      {"log10", Op::LOG10, 1},
+        {"sin", Op::SIN, 1},     {"cos", Op::COS, 1},
+        {"tan", Op::TAN, 1},     {"asin", Op::ASIN, 1},
+        {"acos", Op::ACOS, 1},   {"atan", Op::ATAN, 1},
+        {"sinh", Op::SINH, 1},   {"cosh", Op::COSH, 1},
+        {"tanh", Op::TANH, 1},   {"floor", Op::FLOOR, 1},
+        {"ceil", Op::CEIL, 1},   {"round", Op::ROUND, 1},
+        {"isnan", Op::ISNAN, 1}, {"isinf", Op::ISINF, 1},
+        {"pow", Op::POW, 2},     {"atan2", Op::ATAN2, 2},
+        {"hypot", Op::HYPOT, 2}, {"fmod", Op::MOD, 2},
+        {"min", Op::MIN, -1},    {"max", Op::MAX, -1},
+        {"sum", Op::ADD, -1},    {"if", Op::SELECT, 3},
+    };
+
+    const FunctionDef *psDef = nullptr;
+    for (const auto &sDef : asFunctions)
+    {
+        if (osName == sDef.pszName)
+        {
+            psDef = &sDef;
+            break;
+        }
+    }
+    if (psDef == nullptr)
+    {
+        Error(CPLSPrintf("unknown function '%s'", osName.c_str()));
+        return;
+    }
+
+    int nArgs = 0;
+    if (!Match(")"))
+    {
+        while (!m_bError)
+        {
+            ParseTernary();
+            ++nArgs;
+            // Variadic functions are chains of binary operators
+            if (psDef->nArgs < 0 && nArgs >= 2)
+                Emit(psDef->eOp);
+            if (Match(")"))
+                break;
+            if (!m_bError && !Match(","))
+                Error("',' or ')' expected");
+        }
+    }
+    if (m_bError)
+        return;
+    if ((psDef->nArgs < 0 && nArgs == 0) ||
+        (psDef->nArgs >= 0 && nArgs != psDef->nArgs))
+    {
+        Error(CPLSPrintf("wrong number of arguments for function '%s'",
+                         osName.c_str()));
+        return;
+    }
+    if (psDef->nArgs > 0)
+        Emit(psDef->eOp);
+}
+
+/************************************************************************/
+/*                        VRTExpression::Compile()                      */
+/************************************************************************/
+
+/** Compile an expression referencing sources as B1 ... B{nSources}.
+ *
+ * Emits a CPLError() and returns nullptr in case of syntax error.
+ */
+std::unique_ptr<VRTExpression>
+VRTExpression::Compile(const std::string &osExpr, int nSources)
+{
+    auto poExpr = std::make_unique<VRTExpression>();
+    VRTExpressionParser oParser(osExpr, nSources, *poExpr);
+    if (!oParser.Parse())
+        return nullptr;
+    return poExpr;
+}
+
+/************************************************************************/
+/*                    VRTExpression::CompileCached()                    */
+/************************************************************************/
+
+/** Same as Compile(), but reuses a previously compiled expression. */
+std::shared_ptr<const VRTExpression>
+VRTExpression::CompileCached(const std::string &osExpr, int nSources)
+{
+    static std::mutex oMutex;
+    static std::map<std::pair<std::string, int>,
+                    std::shared_ptr<const VRTExpression>>
+        oCache;
+    constexpr size_t MAX_CACHE_SIZE = 100;
+
+    const auto oKey = std::make_pair(osExpr, nSources);
+    {
+        std::lock_guard<std::mutex> oLock(oMutex);
+        const auto oIter = oCache.find(oKey);
+        if (oIter != oCache.end())
+            return oIter->second;
+    }
+
+    std::shared_ptr<const VRTExpression> poExpr(Compile(osExpr, nSources));
+    if (poExpr)
+    {
+        std::lock_guard<std::mutex> oLock(oMutex);
+        if (oCache.size() >= MAX_CACHE_SIZE)
+            oCache.clear();
+        oCache[oKey] = poExpr;
+    }
+    return poExpr;
+}
+
+/************************************************************************/
+/*                       VRTExpression::Evaluate()                      */
+/************************************************************************/
+
+/** Evaluate the expression on nCount (<= CHUNK_SIZE) values.
+ *
+ * @param papadfSources array of nSources pointers to nCount values. Only
+ *                      the ones of GetUsedSources() are accessed.
+ * @param nCount number of values.
+ * @param padfScratch buffer of GetScratchSize() values.
+ * @param padfOut output buffer of nCount values.
+ */
+void VRTExpression::Evaluate(const double *const *papadfSources, int nCount,
+                             double *padfScratch, double *padfOut) const
+{
+    CPLAssert(nCount <= CHUNK_SIZE);
+
+    // Stack of pointers to the operand arrays. Source operands point
+    // directly to the source values, other ones to the scratch slot of their
+    // stack level.
+    const double *apadfStackStatic[32];
+    std::vector<const double *> apadfStackDynamic;
+    const double **papadfStack = apadfStackStatic;
+    if (m_nMaxStackDepth > static_cast<int>(CPL_ARRAYSIZE(apadfStackStatic)))
+    {
+        apadfStackDynamic.resize(m_nMaxStackDepth);
+        papadfStack = apadfStackDynamic.data();
+    }
+
+    int nDepth = 0;
+    for (const auto &sInstr : m_aoInstrs)
+    {
+        switch (GetArity(sInstr.eOp))
+        {
+            case 0:
+            {
+                if (sInstr.eOp == Op::PUSH_SOURCE)
+                {
+                    papadfStack[nDepth] = papadfSources[sInstr.nSource];
+                }
+                else
+                {
+                    double *padfSlot =
+                        padfScratch + static_cast<size_t>(nDepth) * CHUNK_SIZE;
+                    std::fill(padfSlot, padfSlot + nCount, sInstr.dfValue);
+                    papadfStack[nDepth] = padfSlot;
+                }
+                ++nDepth;
+                break;
+            }
+
+            case 1:
+            {
+                double *padfSlot =
+                    padfScratch + static_cast<size_t>(nDepth - 1) * CHUNK_SIZE;
+                ApplyUnary(sInstr.eOp, papadfStack[nDepth - 1], padfSlot,
+                           nCount);
+                papadfStack[nDepth - 1] = padfSlot;
+                break;
+            }
+
+            case 2:
+            {
+                double *padfSlot =
+                    padfScratch + static_cast<size_t>(nDepth - 2) * CHUNK_SIZE;
+                ApplyBinary(sInstr.eOp, papadfStack[nDepth - 2],
+                            papadfStack[nDepth - 1], padfSlot, nCount);
+                papadfStack[nDepth - 2] = padfSlot;
+                --nDepth;
+                break;
+            }
+
+            default:
+            {
+                double *padfSlot =
+                    padfScratch + static_cast<size_t>(nDepth - 3) * CHUNK_SIZE;
+                const double *padfCond = papadfStack[nDepth - 3];
+                const double *padfA = papadfStack[nDepth - 2];
+                const double *padfB = papadfStack[nDepth - 1];
+                for (int i = 0; i < nCount; ++i)
+                    padfSlot[i] = EvalSelect(padfCond[i], padfA[i], padfB[i]);
+                papadfStack[nDepth - 3] = padfSlot;
+                nDepth -= 2;
+                break;
+            }
+        }
+    }
+
+    CPLAssert(nDepth == 1);
+    memcpy(padfOut, papadfStack[0], sizeof(double) * nCount);
+}
+
+/*! @endcond */
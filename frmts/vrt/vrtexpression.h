@@ -0,0 +1,143 @@
+/******************************************************************************
+ *
+ * Project:  Virtual GDAL Datasets
+ * Purpose:  Compiled arithmetic expressions for the "expression" pixel
+ *           function of derived bands.
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef VRTEXPRESSION_H_INCLUDED
+#define VRTEXPRESSION_H_INCLUDED
+
+#ifndef DOXYGEN_SKIP
+
+#include "cpl_port.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/************************************************************************/
+/*                            VRTExpression                             */
+/************************************************************************/
+
+/* Arithmetic expression over the sources of a derived band, such as
+ * "(B1 - B2) / (B1 + B2)", compiled to a stack-based bytecode. Each
+ * instruction processes up to CHUNK_SIZE values at once, so that evaluation
+ * runs as a sequence of tight loops over arrays that the compiler can
+ * vectorize, instead of interpreting the expression for each pixel.
+ */
+class VRTExpression
+{
+  public:
+    static constexpr int CHUNK_SIZE = 256;
+
+    enum class Op
+    {
+        PUSH_SOURCE,
+        PUSH_CONST,
+        // Unary operators and functions
+        NEG,
+        NOT,
+        ABS,
+        SQRT,
+        EXP,
+        LOG,
+        LOG10,
+        SIN,
+        COS,
+        TAN,
+        ASIN,
+        ACOS,
+        ATAN,
+        SINH,
+        COSH,
+        TANH,
+        FLOOR,
+        CEIL,
+        ROUND,
+        ISNAN,
+        ISINF,
+        // Binary operators and functions
+        ADD,
+        SUB,
+        MUL,
+        DIV,
+        MOD,
+        POW,
+        ATAN2,
+        HYPOT,
+        MIN,
+        MAX,
+        LT,
+        LE,
+        GT,
+        GE,
+        EQ,
+        NE,
+        AND,
+        OR,
+        // Ternary
+        SELECT,
+    };
+
+    struct Instr
+    {
+        Op eOp;
+        int nSource;  // for PUSH_SOURCE
+        double dfValue;  // for PUSH_CONST
+    };
+
+    static std::unique_ptr<VRTExpression> Compile(const std::string &osExpr,
+                                                  int nSources);
+
+    static std::shared_ptr<const VRTExpression>
+    CompileCached(const std::string &osExpr, int nSources);
+
+    /** Indices (0-based) of the sources referenced by the expression */
+    const std::vector<int> &GetUsedSources() const
+    {
+        return m_anUsedSources;
+    }
+
+    /** Number of doubles of the scratch buffer needed by Evaluate() */
+    size_t GetScratchSize() const
+    {
+        return static_cast<size_t>(m_nMaxStackDepth) * CHUNK_SIZE;
+    }
+
+    void Evaluate(const double *const *papadfSources, int nCount,
+                  double *padfScratch, double *padfOut) const;
+
+  private:
+    friend class VRTExpressionParser;
+
+    std::vector<Instr> m_aoInstrs{};
+    int m_nMaxStackDepth = 0;
+    std::vector<int> m_anUsedSources{};
+};
+
+#endif /* #ifndef DOXYGEN_SKIP */
+
+#endif /* #ifndef VRTEXPRESSION_H_INCLUDED */
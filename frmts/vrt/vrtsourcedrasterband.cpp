@@ -32,6 +32,7 @@
 #include "vrtdataset.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
@@ -40,6 +41,7 @@
 #include <cstring>
 #include <limits>
 #include <mutex>
+#include <numeric>
 #include <set>
 #include <string>
 
@@ -129,6 +131,7 @@ VRTSourcedRasterBand::~VRTSourcedRasterBand()
 
 {
     VRTSourcedRasterBand::CloseDependentDatasets();
+    InvalidateSourcesRTree();
     CSLDestroy(m_papszSourceList);
 }
 
@@ -239,6 +242,350 @@ bool VRTSourcedRasterBand::CanIRasterIOBeForwardedToEachSource(
     return true;
 }
 
+/************************************************************************/
+/*                      InvalidateSourcesRTree()                     */
+/************************************************************************/
+
+void VRTSourcedRasterBand::InvalidateSourcesRTree()
+{
+    m_poSourcesRTree.reset();
+    m_nSourcesInRTree = 0;
+}
+
+/************************************************************************/
+/*                    GetSourcesIntersectingWindow()                    */
+/************************************************************************/
+
+/* Returns the indices, in increasing order, of the sources that may
+ * contribute to the passed window, expressed in pixel coordinates of the
+ * band. When there are many sources, a packed R-tree of their destination
+ * windows, built on first use, is queried instead of returning all of them.
+ */
+std::vector<int> VRTSourcedRasterBand::GetSourcesIntersectingWindow(
+    double dfXOff, double dfYOff, double dfXSize, double dfYSize)
+{
+    // Below that number, scanning all sources is cheap enough.
+    constexpr int MIN_SOURCES_FOR_RTREE = 100;
+
+    std::vector<int> anSources;
+    if (nSources < MIN_SOURCES_FOR_RTREE)
+    {
+        anSources.resize(nSources);
+        std::iota(anSources.begin(), anSources.end(), 0);
+        return anSources;
+    }
+
+    if (m_poSourcesRTree == nullptr || m_nSourcesInRTree != nSources)
+    {
+        InvalidateSourcesRTree();
+
+        CPLRectObj sGlobalBounds;
+        sGlobalBounds.minx = 0;
+        sGlobalBounds.miny = 0;
+        sGlobalBounds.maxx = nRasterXSize;
+        sGlobalBounds.maxy = nRasterYSize;
+        m_poSourcesRTree = std::make_unique<CPLPackedRTree>();
+        m_poSourcesRTree->Reserve(nSources);
+        for (int i = 0; i < nSources; ++i)
+        {
+            // Sources without a destination window (or that are not simple
+            // sources) are considered to cover the whole band.
+            CPLRectObj sBounds = sGlobalBounds;
+            if (papoSources[i]->IsSimpleSource())
+            {
+                auto poSimpleSource =
+                    cpl::down_cast<VRTSimpleSource *>(papoSources[i]);
+                if (poSimpleSource->m_dfDstXOff != -1 ||
+                    poSimpleSource->m_dfDstXSize != -1 ||
+                    poSimpleSource->m_dfDstYOff != -1 ||
+                    poSimpleSource->m_dfDstYSize != -1)
+                {
+                    sBounds.minx = poSimpleSource->m_dfDstXOff;
+                    sBounds.miny = poSimpleSource->m_dfDstYOff;
+                    sBounds.maxx = poSimpleSource->m_dfDstXOff +
+                                   poSimpleSource->m_dfDstXSize;
+                    sBounds.maxy = poSimpleSource->m_dfDstYOff +
+                                   poSimpleSource->m_dfDstYSize;
+                }
+            }
+            m_poSourcesRTree->Insert(
+                reinterpret_cast<void *>(static_cast<uintptr_t>(i)), sBounds);
+        }
+        m_poSourcesRTree->Build();
+        m_nSourcesInRTree = nSources;
+    }
+
+    CPLRectObj sRect;
+    sRect.minx = dfXOff;
+    sRect.miny = dfYOff;
+    sRect.maxx = dfXOff + dfXSize;
+    sRect.maxy = dfYOff + dfYSize;
+    std::vector<void *> ahFeatures;
+    m_poSourcesRTree->Search(sRect, ahFeatures);
+    anSources.reserve(ahFeatures.size());
+    for (void *hFeature : ahFeatures)
+    {
+        anSources.push_back(
+            static_cast<int>(reinterpret_cast<uintptr_t>(hFeature)));
+    }
+    // Sources must be composited in their order of declaration
+    std::sort(anSources.begin(), anSources.end());
+    return anSources;
+}
+
+/************************************************************************/
+/*                   AreSourcesFromDistinctDatasets()                   */
+/************************************************************************/
+
+// Check that all sources refer to different datasets before allowing
+// multithreaded access.
+// Sources that are not opened yet are identified by their dataset name, so
+// that they get opened by the worker threads and not serially here.
+// If the datasets belong to the MEM driver, check GDALDataset* pointer
+// values. Otherwise use dataset name.
+bool VRTSourcedRasterBand::AreSourcesFromDistinctDatasets(
+    const std::vector<VRTSimpleSource *> &apoSources)
+{
+    std::set<std::string> oSetDatasetNames;
+    std::set<GDALDataset *> oSetDatasetPointers;
+    for (auto *poSimpleSource : apoSources)
+    {
+        if (poSimpleSource->m_poRasterBand == nullptr &&
+            !poSimpleSource->m_osSrcDSName.empty())
+        {
+            if (!oSetDatasetNames.insert(poSimpleSource->m_osSrcDSName).second)
+                return false;
+            continue;
+        }
+
+        auto poSimpleSourceBand = poSimpleSource->GetRasterBand();
+        if (poSimpleSourceBand == nullptr)
+            return false;
+        auto poSourceDataset = poSimpleSourceBand->GetDataset();
+        if (poSourceDataset == nullptr)
+            return false;
+        auto poDriver = poSourceDataset->GetDriver();
+        if (poDriver && EQUAL(poDriver->GetDescription(), "MEM"))
+        {
+            if (!oSetDatasetPointers.insert(poSourceDataset).second)
+                return false;
+        }
+        else
+        {
+            if (!oSetDatasetNames.insert(poSourceDataset->GetDescription())
+                     .second)
+                return false;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                     GetMultiThreadingThreadCount()                   */
+/************************************************************************/
+
+/* Returns the number of threads set with the NUM_THREADS open option of
+ * poVRTDS or the GDAL_NUM_THREADS configuration option, or 0 if not set.
+ */
+int VRTSourcedRasterBand::GetMultiThreadingThreadCount(GDALDataset *poVRTDS)
+{
+    const char *pszValue =
+        CSLFetchNameValueDef(poVRTDS->GetOpenOptions(), "NUM_THREADS",
+                             CPLGetConfigOption("GDAL_NUM_THREADS", nullptr));
+    if (pszValue == nullptr)
+        return 0;
+    int nThreads =
+        EQUAL(pszValue, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszValue);
+    if (nThreads > 1024)
+        nThreads = 1024;  // to please Coverity
+    return std::max(0, nThreads);
+}
+
+/************************************************************************/
+/*                    GetDisjointContributingSources()                  */
+/************************************************************************/
+
+/* Collects in apoContributingSourcesOut the sources of anSources that
+ * contribute to the passed request, and returns true if they are all simple
+ * or complex sources writing to disjoint windows of the output buffer (so
+ * that compositing does not depend on their order).
+ * Windows are computed from the destination windows of the sources, so that
+ * this does not require opening them.
+ */
+bool VRTSourcedRasterBand::GetDisjointContributingSources(
+    const std::vector<int> &anSources, double dfXOff, double dfYOff,
+    double dfXSize, double dfYSize, int nBufXSize, int nBufYSize,
+    std::vector<VRTSimpleSource *> &apoContributingSourcesOut) const
+{
+    struct Window
+    {
+        int nXOff;
+        int nYOff;
+        int nXSize;
+        int nYSize;
+    };
+    std::vector<Window> asWindows;
+    apoContributingSourcesOut.clear();
+    const double dfXRatio = nBufXSize / dfXSize;
+    const double dfYRatio = nBufYSize / dfYSize;
+    for (const int i : anSources)
+    {
+        if (!papoSources[i]->IsSimpleSource())
+            return false;
+        auto poSimpleSource = cpl::down_cast<VRTSimpleSource *>(papoSources[i]);
+        // Other source types may read outside of their destination window
+        // or depend on the values written by previous sources.
+        const char *pszType = poSimpleSource->GetType();
+        if (!EQUAL(pszType, "SimpleSource") && !EQUAL(pszType, "ComplexSource"))
+            return false;
+
+        double dfDstXMin = dfXOff;
+        double dfDstYMin = dfYOff;
+        double dfDstXMax = dfXOff + dfXSize;
+        double dfDstYMax = dfYOff + dfYSize;
+        if (poSimpleSource->m_dfDstXOff != -1 ||
+            poSimpleSource->m_dfDstXSize != -1 ||
+            poSimpleSource->m_dfDstYOff != -1 ||
+            poSimpleSource->m_dfDstYSize != -1)
+        {
+            dfDstXMin = std::max(dfDstXMin, poSimpleSource->m_dfDstXOff);
+            dfDstYMin = std::max(dfDstYMin, poSimpleSource->m_dfDstYOff);
+            dfDstXMax =
+                std::min(dfDstXMax, poSimpleSource->m_dfDstXOff +
+                                        poSimpleSource->m_dfDstXSize);
+            dfDstYMax =
+                std::min(dfDstYMax, poSimpleSource->m_dfDstYOff +
+                                        poSimpleSource->m_dfDstYSize);
+        }
+        if (!(dfDstXMin < dfDstXMax && dfDstYMin < dfDstYMax))
+            continue;
+
+        // Conservative rounding of the window in the output buffer
+        Window sWindow;
+        sWindow.nXOff =
+            static_cast<int>(std::floor((dfDstXMin - dfXOff) * dfXRatio));
+        sWindow.nYOff =
+            static_cast<int>(std::floor((dfDstYMin - dfYOff) * dfYRatio));
+        sWindow.nXSize =
+            static_cast<int>(std::ceil((dfDstXMax - dfXOff) * dfXRatio)) -
+            sWindow.nXOff;
+        sWindow.nYSize =
+            static_cast<int>(std::ceil((dfDstYMax - dfYOff) * dfYRatio)) -
+            sWindow.nYOff;
+
+        for (const auto &sOther : asWindows)
+        {
+            if (sWindow.nXOff < sOther.nXOff + sOther.nXSize &&
+                sOther.nXOff < sWindow.nXOff + sWindow.nXSize &&
+                sWindow.nYOff < sOther.nYOff + sOther.nYSize &&
+                sOther.nYOff < sWindow.nYOff + sWindow.nYSize)
+            {
+                return false;
+            }
+        }
+        asWindows.push_back(sWindow);
+        apoContributingSourcesOut.push_back(poSimpleSource);
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                       CanMultiThreadRasterIO()                       */
+/************************************************************************/
+
+/* Returns true if the sources of anSources contributing to the passed request
+ * can be read concurrently, that is: multi-threading is enabled through the
+ * NUM_THREADS open option or the GDAL_NUM_THREADS configuration option,
+ * at least 2 sources contribute to the request, they write to disjoint
+ * windows of the output buffer (so that compositing does not depend on
+ * their order) and they belong to different datasets.
+ */
+bool VRTSourcedRasterBand::CanMultiThreadRasterIO(
+    const std::vector<int> &anSources, double dfXOff, double dfYOff,
+    double dfXSize, double dfYSize, int nBufXSize, int nBufYSize,
+    int &nThreadsOut) const
+{
+    nThreadsOut = 0;
+    if (anSources.size() < 2 || poDS == nullptr)
+        return false;
+
+    const int nThreads = GetMultiThreadingThreadCount(poDS);
+    if (nThreads <= 1)
+        return false;
+
+    std::vector<VRTSimpleSource *> apoContributingSources;
+    if (!GetDisjointContributingSources(anSources, dfXOff, dfYOff, dfXSize,
+                                        dfYSize, nBufXSize, nBufYSize,
+                                        apoContributingSources) ||
+        apoContributingSources.size() < 2 ||
+        !AreSourcesFromDistinctDatasets(apoContributingSources))
+    {
+        return false;
+    }
+
+    nThreadsOut = std::min(nThreads,
+                           static_cast<int>(apoContributingSources.size()));
+    return true;
+}
+
+/************************************************************************/
+/*                    MultiThreadedSourcesRasterIO()                    */
+/************************************************************************/
+
+/* Runs fnFunc(iSource) for each source index of anSources on the global
+ * thread pool, and waits for completion. Once a call has failed, the jobs
+ * that have not started yet are skipped.
+ */
+CPLErr VRTSourcedRasterBand::MultiThreadedSourcesRasterIO(
+    int nThreads, const std::vector<int> &anSources,
+    const std::function<CPLErr(int)> &fnFunc)
+{
+    CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    auto poQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    if (!poQueue)
+    {
+        for (const int iSource : anSources)
+        {
+            if (fnFunc(iSource) != CE_None)
+                return CE_Failure;
+        }
+        return CE_None;
+    }
+
+    struct Job
+    {
+        const std::function<CPLErr(int)> *pfnFunc = nullptr;
+        std::atomic<bool> *pbSuccess = nullptr;
+        int iSource = 0;
+    };
+
+    const auto JobRunner = [](void *pData)
+    {
+        auto psJob = static_cast<Job *>(pData);
+        if (*(psJob->pbSuccess) && (*(psJob->pfnFunc))(psJob->iSource) !=
+                                       CE_None)
+        {
+            *(psJob->pbSuccess) = false;
+        }
+    };
+
+    std::atomic<bool> bSuccess{true};
+    std::vector<Job> asJobs(anSources.size());
+    for (size_t i = 0; i < anSources.size(); ++i)
+    {
+        asJobs[i].pfnFunc = &fnFunc;
+        asJobs[i].pbSuccess = &bSuccess;
+        asJobs[i].iSource = anSources[i];
+        if (!poQueue->SubmitJob(JobRunner, &asJobs[i]))
+        {
+            bSuccess = false;
+            break;
+        }
+    }
+    poQueue->WaitCompletion();
+    return bSuccess ? CE_None : CE_Failure;
+}
+
 /************************************************************************/
 /*                             IRasterIO()                              */
 /************************************************************************/
@@ -358,12 +705,58 @@ CPLErr VRTSourcedRasterBand::IRasterIO(
     /*      Overlay each source in turn over top this.                      */
     /* -------------------------------------------------------------------- */
     CPLErr eErr = CE_None;
+
+    double dfXOff = nXOff;
+    double dfYOff = nYOff;
+    double dfXSize = nXSize;
+    double dfYSize = nYSize;
+    if (psExtraArg->bFloatingPointWindowValidity)
+    {
+        dfXOff = psExtraArg->dfXOff;
+        dfYOff = psExtraArg->dfYOff;
+        dfXSize = psExtraArg->dfXSize;
+        dfYSize = psExtraArg->dfYSize;
+    }
+    const std::vector<int> anSources =
+        GetSourcesIntersectingWindow(dfXOff, dfYOff, dfXSize, dfYSize);
+    int nThreads = 0;
+    if (l_poDS && CanMultiThreadRasterIO(anSources, dfXOff, dfYOff, dfXSize,
+                                         dfYSize, nBufXSize, nBufYSize,
+                                         nThreads))
+    {
+        CPLDebugOnly("VRT", "IRasterIO(): use multi-threaded code path");
+        GDALRasterIOExtraArg sExtraArg = *psExtraArg;
+        sExtraArg.pfnProgress = nullptr;
+        sExtraArg.pProgressData = nullptr;
+        eErr = MultiThreadedSourcesRasterIO(
+            nThreads, anSources,
+            [this, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize, nBufYSize,
+             eBufType, nPixelSpace, nLineSpace, &sExtraArg](int iSource)
+            {
+                GDALRasterIOExtraArg sExtraArgJob = sExtraArg;
+                VRTSource::WorkingState oWorkingState;
+                return papoSources[iSource]->RasterIO(
+                    eDataType, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize,
+                    nBufYSize, eBufType, nPixelSpace, nLineSpace,
+                    &sExtraArgJob, oWorkingState);
+            });
+        if (eErr == CE_None && psExtraArg->pfnProgress &&
+            !psExtraArg->pfnProgress(1.0, "", psExtraArg->pProgressData))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+        return eErr;
+    }
+
     VRTSource::WorkingState oWorkingState;
-    for (int iSource = 0; eErr == CE_None && iSource < nSources; iSource++)
+    const int nCandidateSources = static_cast<int>(anSources.size());
+    for (int i = 0; eErr == CE_None && i < nCandidateSources; i++)
     {
+        const int iSource = anSources[i];
         psExtraArg->pfnProgress = GDALScaledProgress;
         psExtraArg->pProgressData = GDALCreateScaledProgress(
-            1.0 * iSource / nSources, 1.0 * (iSource + 1) / nSources,
+            1.0 * i / nCandidateSources, 1.0 * (i + 1) / nCandidateSources,
             pfnProgressGlobal, pProgressDataGlobal);
         if (psExtraArg->pProgressData == nullptr)
             psExtraArg->pfnProgress = nullptr;
@@ -1461,50 +1854,13 @@ CPLErr VRTSourcedRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                 nThreads = 1024;  // to please Coverity
             if (nThreads > 1)
             {
-                // Check that all sources refer to different datasets
-                // before allowing multithreaded access
-                // If the datasets belong to the MEM driver, check GDALDataset*
-                // pointer values. Otherwise use dataset name.
-                std::set<std::string> oSetDatasetNames;
-                std::set<GDALDataset *> oSetDatasetPointers;
+                std::vector<VRTSimpleSource *> apoSources;
                 for (int i = 0; i < nSources; ++i)
                 {
-                    auto poSimpleSource =
-                        cpl::down_cast<VRTSimpleSource *>(papoSources[i]);
-                    assert(poSimpleSource);
-                    auto poSimpleSourceBand = poSimpleSource->GetRasterBand();
-                    assert(poSimpleSourceBand);
-                    auto poSourceDataset = poSimpleSourceBand->GetDataset();
-                    if (poSourceDataset == nullptr)
-                    {
-                        nThreads = 0;
-                        break;
-                    }
-                    auto poDriver = poSourceDataset->GetDriver();
-                    if (poDriver && EQUAL(poDriver->GetDescription(), "MEM"))
-                    {
-                        if (oSetDatasetPointers.find(poSourceDataset) !=
-                            oSetDatasetPointers.end())
-                        {
-                            nThreads = 0;
-                            break;
-                        }
-                        oSetDatasetPointers.insert(poSourceDataset);
-                    }
-                    else
-                    {
-                        if (oSetDatasetNames.find(
-                                poSourceDataset->GetDescription()) !=
-                            oSetDatasetNames.end())
-                        {
-                            nThreads = 0;
-                            break;
-                        }
-                        oSetDatasetNames.insert(
-                            poSourceDataset->GetDescription());
-                    }
+                    apoSources.push_back(
+                        cpl::down_cast<VRTSimpleSource *>(papoSources[i]));
                 }
-                if (nThreads > 1)
+                if (AreSourcesFromDistinctDatasets(apoSources))
                 {
                     poThreadPool = GDALGetGlobalThreadPool(nThreads);
                 }
@@ -1769,6 +2125,8 @@ CPLErr VRTSourcedRasterBand::AddSource(VRTSource *poNewSource)
         CPLRealloc(papoSources, sizeof(void *) * nSources));
     papoSources[nSources - 1] = poNewSource;
 
+    InvalidateSourcesRTree();
+
     static_cast<VRTDataset *>(poDS)->SetNeedsFlush();
 
     if (poNewSource->IsSimpleSource())
@@ -2582,6 +2940,7 @@ CPLErr VRTSourcedRasterBand::SetMetadataItem(const char *pszName,
         {
             delete papoSources[iSource];
             papoSources[iSource] = poSource;
+            InvalidateSourcesRTree();
             static_cast<VRTDataset *>(poDS)->SetNeedsFlush();
             return CE_None;
         }
@@ -2673,6 +3032,8 @@ int VRTSourcedRasterBand::CloseDependentDatasets()
 {
     int ret = VRTRasterBand::CloseDependentDatasets();
 
+    InvalidateSourcesRTree();
+
     if (nSources == 0)
         return ret;
 
@@ -2876,6 +3237,7 @@ void VRTSourcedRasterBand::RemoveCoveredSources(CSLConstList papszOptions)
             papoSources[iDst++] = papoSources[iSrc];
     }
     nSources = iDst;
+    InvalidateSourcesRTree();
 
     CPLQuadTreeDestroy(hTree);
 #endif
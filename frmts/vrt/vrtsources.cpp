@@ -40,6 +40,7 @@
 #include <cstring>
 #include <algorithm>
 #include <limits>
+#include <mutex>
 #include <string>
 
 #include "cpl_conv.h"
@@ -552,7 +553,15 @@ VRTSimpleSource::XMLInit(const CPLXMLNode *psSrc, const char *pszVRTPath,
         m_nExplicitSharedStatus = CPLTestBool(pszShared);
     }
 
-    if (pszVRTPath != nullptr && m_bRelativeToVRTOri)
+    if (pszVRTPath != nullptr && m_bRelativeToVRTOri &&
+        strchr(pszFilename, ':') == nullptr)
+    {
+        // Fast path for the common case of a plain filename: subdataset and
+        // special syntaxes below all have a "PREFIX:" part. This avoids
+        // iterating over all drivers for each source of big VRTs.
+        m_osSrcDSName = CPLProjectRelativeFilename(pszVRTPath, pszFilename);
+    }
+    else if (pszVRTPath != nullptr && m_bRelativeToVRTOri)
     {
         // Try subdatasetinfo API first
         // Note: this will become the only branch when subdatasetinfo will become
@@ -769,6 +778,19 @@ void VRTSimpleSource::GetFileList(char ***ppapszFileList, int *pnSize,
     }
 }
 
+/************************************************************************/
+/*                      GetMapSharedSourcesMutex()                      */
+/************************************************************************/
+
+// Sources may be opened by worker threads when VRTSourcedRasterBand reads
+// them concurrently, so accesses to the map of shared sources of the VRT
+// dataset must be serialized.
+static std::mutex &GetMapSharedSourcesMutex()
+{
+    static std::mutex oMutex;
+    return oMutex;
+}
+
 /************************************************************************/
 /*                           OpenSource()                               */
 /************************************************************************/
@@ -791,9 +813,13 @@ void VRTSimpleSource::OpenSource() const
             osKeyMapSharedSources += m_aosOpenOptions[i];
         }
 
+        std::lock_guard<std::mutex> oLock(GetMapSharedSourcesMutex());
         auto oIter = m_poMapSharedSources->find(osKeyMapSharedSources);
         if (oIter != m_poMapSharedSources->end())
+        {
             proxyDS = cpl::down_cast<GDALProxyPoolDataset *>(oIter->second);
+            proxyDS->Reference();
+        }
     }
 
     if (proxyDS == nullptr)
@@ -809,10 +835,6 @@ void VRTSimpleSource::OpenSource() const
         if (proxyDS == nullptr)
             return;
     }
-    else
-    {
-        proxyDS->Reference();
-    }
 
     if (m_bGetMaskBand)
     {
@@ -846,6 +868,7 @@ void VRTSimpleSource::OpenSource() const
 
     if (m_poMapSharedSources)
     {
+        std::lock_guard<std::mutex> oLock(GetMapSharedSourcesMutex());
         (*m_poMapSharedSources)[osKeyMapSharedSources] = proxyDS;
     }
 }
@@ -2950,6 +2973,31 @@ CPLErr VRTComplexSource::RasterIO(GDALDataType eVRTBandDataType, int nXOff,
         }
     }
 
+    if (m_nProcessingFlags == PROCESSING_FLAG_COLOR_TABLE_EXPANSION &&
+        m_nColorTableComponent >= 1 && m_nColorTableComponent <= 4 &&
+        m_nMaxValue == 0 && eVRTBandDataType == GDT_Byte &&
+        eBufType == GDT_Byte &&
+        psExtraArg->eResampleAlg == GRIORA_NearestNeighbour)
+    {
+        // Optimization if only expanding a color table component to Byte,
+        // as done by gdal_translate -expand
+        const auto eSourceType = poSourceBand->GetRasterDataType();
+        if (eSourceType == GDT_Byte)
+        {
+            return RasterIOProcessColorTable<GByte, GDT_Byte>(
+                poSourceBand, nReqXOff, nReqYOff, nReqXSize, nReqYSize,
+                pabyOut, nOutXSize, nOutYSize, nPixelSpace, nLineSpace,
+                psExtraArg, oWorkingState);
+        }
+        else if (eSourceType == GDT_UInt16)
+        {
+            return RasterIOProcessColorTable<uint16_t, GDT_UInt16>(
+                poSourceBand, nReqXOff, nReqYOff, nReqXSize, nReqYSize,
+                pabyOut, nOutXSize, nOutYSize, nPixelSpace, nLineSpace,
+                psExtraArg, oWorkingState);
+        }
+    }
+
     const bool bIsComplex =
         CPL_TO_BOOL(GDALDataTypeIsComplex(eVRTBandDataType));
     CPLErr eErr;
@@ -3175,6 +3223,134 @@ CPLErr VRTComplexSource::RasterIOProcessNoData(
     return CE_None;
 }
 
+/************************************************************************/
+/*                     RasterIOProcessColorTable()                      */
+/************************************************************************/
+
+// This method is an optimization of the generic RasterIOInternal()
+// that deals with a VRTComplexSource with only a color table component
+// expansion, from a Byte or UInt16 source to a Byte output. Instead of
+// looking up the color table for each pixel, the component is first
+// expanded as a lookup table indexed by the source values.
+
+// nReqXOff, nReqYOff, nReqXSize, nReqYSize are expressed in source band
+// referential.
+template <class SourceDT, GDALDataType eSourceType>
+CPLErr VRTComplexSource::RasterIOProcessColorTable(
+    GDALRasterBand *poSourceBand, int nReqXOff, int nReqYOff, int nReqXSize,
+    int nReqYSize, void *pData, int nOutXSize, int nOutYSize,
+    GSpacing nPixelSpace, GSpacing nLineSpace,
+    GDALRasterIOExtraArg *psExtraArg, WorkingState &oWorkingState)
+{
+    CPLAssert(m_nProcessingFlags == PROCESSING_FLAG_COLOR_TABLE_EXPANSION);
+    CPLAssert(m_nColorTableComponent >= 1 && m_nColorTableComponent <= 4);
+
+    const GDALColorTable *poColorTable = poSourceBand->GetColorTable();
+    if (poColorTable == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Source band has no color table.");
+        return CE_Failure;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Build the lookup table, with values clamped to Byte.            */
+    /* -------------------------------------------------------------------- */
+    constexpr int MAX_ENTRY_COUNT =
+        static_cast<int>(std::numeric_limits<SourceDT>::max()) + 1;
+    const int nEntryCount =
+        std::min(poColorTable->GetColorEntryCount(), MAX_ENTRY_COUNT);
+    std::vector<GByte> abyLUT(nEntryCount);
+    for (int i = 0; i < nEntryCount; ++i)
+    {
+        const GDALColorEntry *poEntry = poColorTable->GetColorEntry(i);
+        const short nVal = m_nColorTableComponent == 1   ? poEntry->c1
+                           : m_nColorTableComponent == 2 ? poEntry->c2
+                           : m_nColorTableComponent == 3 ? poEntry->c3
+                                                         : poEntry->c4;
+        abyLUT[i] = static_cast<GByte>(std::clamp<short>(nVal, 0, 255));
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Read into a temporary buffer.                                   */
+    /* -------------------------------------------------------------------- */
+    try
+    {
+        // Cannot overflow since pData should at least have that number of
+        // elements
+        const size_t nPixelCount = static_cast<size_t>(nOutXSize) * nOutYSize;
+        if (nPixelCount >
+            static_cast<size_t>(std::numeric_limits<ptrdiff_t>::max()) /
+                sizeof(SourceDT))
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Too large temporary buffer");
+            return CE_Failure;
+        }
+        oWorkingState.m_abyWrkBuffer.resize(sizeof(SourceDT) * nPixelCount);
+    }
+    catch (const std::bad_alloc &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+        return CE_Failure;
+    }
+    const auto paSrcData =
+        reinterpret_cast<const SourceDT *>(oWorkingState.m_abyWrkBuffer.data());
+
+    const CPLErr eErr = poSourceBand->RasterIO(
+        GF_Read, nReqXOff, nReqYOff, nReqXSize, nReqYSize,
+        oWorkingState.m_abyWrkBuffer.data(), nOutXSize, nOutYSize, eSourceType,
+        sizeof(SourceDT), sizeof(SourceDT) * static_cast<GSpacing>(nOutXSize),
+        psExtraArg);
+    if (eErr != CE_None)
+    {
+        return eErr;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Expand through the lookup table.                                */
+    /* -------------------------------------------------------------------- */
+    size_t idxBuffer = 0;
+    for (int iY = 0; iY < nOutYSize; iY++)
+    {
+        GByte *pDstLocation = static_cast<GByte *>(pData) +
+                              static_cast<GPtrDiff_t>(nLineSpace) * iY;
+
+        if (nEntryCount == MAX_ENTRY_COUNT)
+        {
+            // All source values have an entry: branch-free gather
+            for (int iX = 0; iX < nOutXSize;
+                 iX++, pDstLocation += nPixelSpace, idxBuffer++)
+            {
+                *pDstLocation = abyLUT[paSrcData[idxBuffer]];
+            }
+            continue;
+        }
+
+        for (int iX = 0; iX < nOutXSize;
+             iX++, pDstLocation += nPixelSpace, idxBuffer++)
+        {
+            const int nVal = paSrcData[idxBuffer];
+            if (nVal < nEntryCount)
+            {
+                *pDstLocation = abyLUT[nVal];
+            }
+            else
+            {
+                static bool bHasWarned = false;
+                if (!bHasWarned)
+                {
+                    bHasWarned = true;
+                    CPLError(CE_Failure, CPLE_AppDefined, "No entry %d.",
+                             nVal);
+                }
+            }
+        }
+    }
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                          RasterIOInternal()                          */
 /************************************************************************/
@@ -29,6 +29,10 @@
 #include "webp_headers.h"
 #include "webpdrivercore.h"
 
+#ifndef PLUGIN_FILENAME
+#include "gdal_frmts.h"
+#endif
+
 /************************************************************************/
 /*                     WEBPDriverIdentify()                             */
 /************************************************************************/
@@ -125,6 +129,8 @@ void WEBPDriverSetCommonMetadata(GDALDriver *poDriver)
     poDriver->SetMetadataItem(GDAL_DCAP_VIRTUALIO, "YES");
 
     poDriver->pfnIdentify = WEBPDriverIdentify;
+    poDriver->SetMetadataItem(GDAL_DMD_IDENTIFY_SIGNATURES,
+                              "magic:0:52494646");
 
     poDriver->SetMetadataItem(GDAL_DCAP_OPEN, "YES");
     poDriver->SetMetadataItem(GDAL_DCAP_CREATECOPY, "YES");
@@ -150,3 +156,20 @@ void DeclareDeferredWEBPPlugin()
     GetGDALDriverManager()->DeclareDeferredPluginDriver(poDriver);
 }
 #endif
+
+/************************************************************************/
+/*                     DeclareDeferredWEBPBuiltin()                     */
+/************************************************************************/
+
+#ifndef PLUGIN_FILENAME
+void DeclareDeferredWEBPBuiltin()
+{
+    if (GDALGetDriverByName(DRIVER_NAME) != nullptr)
+    {
+        return;
+    }
+    auto poDriver = new GDALPluginDriverProxy(GDALRegister_WEBP);
+    WEBPDriverSetCommonMetadata(poDriver);
+    GetGDALDriverManager()->DeclareDeferredPluginDriver(poDriver);
+}
+#endif
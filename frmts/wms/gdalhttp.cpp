@@ -205,7 +205,10 @@ CPLErr WMSHTTPFetchMulti(WMSHTTPRequest *pasRequest, int nRequestCount)
         return CE_None;
     }
 
-    curl_multi = curl_multi_init();
+    // Configured for HTTP/2 multiplexing. Connections, DNS entries and TLS
+    // sessions are kept in the process-wide curl share object set by
+    // CPLHTTPSetOptions(), so they are reused across calls and datasets.
+    curl_multi = static_cast<CURLM *>(CPLHTTPCreateMultiHandle());
     if (curl_multi == nullptr)
     {
         CPLError(CE_Fatal, CPLE_AppDefined,
@@ -332,7 +335,7 @@ CPLErr WMSHTTPFetchMulti(WMSHTTPRequest *pasRequest, int nRequestCount)
                                             : "(null)",
             !psRequest->Error.empty() ? psRequest->Error.c_str() : "(null)");
 
-        curl_multi_remove_handle(curl_multi, pasRequest->m_curl_handle);
+        curl_multi_remove_handle(curl_multi, psRequest->m_curl_handle);
     }
 
     curl_multi_cleanup(curl_multi);
@@ -32,6 +32,10 @@
 #include "cpl_md5.h"
 #include "wmsdriver.h"
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+
 static void CleanCacheThread(void *pData)
 {
     GDALWMSCache *pCache = static_cast<GDALWMSCache *>(pData);
@@ -94,7 +98,23 @@ class GDALWMSFileCache : public GDALWMSCacheImpl
         CPLString soFilePath = GetFilePath(pszKey);
         MakeDirs(CPLGetDirname(soFilePath));
         if (CPLCopyFile(soFilePath, osFileName) == CE_None)
+        {
+            VSIStatBufL sStatBuf;
+            if (VSIStatL(soFilePath, &sStatBuf) == 0)
+            {
+                std::lock_guard<std::mutex> oLock(m_oIndexMutex);
+                if (m_bIndexBuilt)
+                {
+                    auto &oEntry = m_oIndex[soFilePath];
+                    m_nIndexSize -= oEntry.nSize;
+                    oEntry.nSize = static_cast<GIntBig>(sStatBuf.st_size);
+                    oEntry.nModTime = sStatBuf.st_mtime;
+                    oEntry.nAccessTime = time(nullptr);
+                    m_nIndexSize += oEntry.nSize;
+                }
+            }
             return CE_None;
+        }
         // Warn if it fails after folder creation
         CPLError(CE_Warning, CPLE_FileIO, "Error writing to WMS cache %s",
                  m_soPath.c_str());
@@ -116,61 +136,94 @@ class GDALWMSFileCache : public GDALWMSCacheImpl
     virtual GDALDataset *GetDataset(const char *pszKey,
                                     char **papszOpenOptions) const override
     {
+        const CPLString soFilePath = GetFilePath(pszKey);
+        {
+            // Record the access for the least-recently-used eviction
+            std::lock_guard<std::mutex> oLock(m_oIndexMutex);
+            auto oIter = m_oIndex.find(soFilePath);
+            if (oIter != m_oIndex.end())
+                oIter->second.nAccessTime = time(nullptr);
+        }
         return GDALDataset::FromHandle(GDALOpenEx(
-            GetFilePath(pszKey),
+            soFilePath,
             GDAL_OF_RASTER | GDAL_OF_READONLY | GDAL_OF_VERBOSE_ERROR, nullptr,
             papszOpenOptions, nullptr));
     }
 
+    // Once the cache size exceeds MaxSize, remove expired items and then
+    // least recently used ones, until the size is back under MaxSize.
+    // The cache directory is only scanned on the first call. Later calls
+    // rely on the in-memory index maintained by Insert() and GetDataset().
     virtual void Clean() override
     {
-        char **papszList = VSIReadDirRecursive(m_soPath);
-        if (papszList == nullptr)
+        std::lock_guard<std::mutex> oLock(m_oIndexMutex);
+        if (!m_bIndexBuilt)
         {
+            BuildIndex();
+            m_bIndexBuilt = true;
+        }
+
+        if (m_nIndexSize <= m_nMaxSize)
             return;
+
+        const time_t nTime = time(nullptr);
+        std::vector<std::pair<time_t, std::string>> aoCandidates;
+        aoCandidates.reserve(m_oIndex.size());
+        for (const auto &oIter : m_oIndex)
+        {
+            const bool bExpired =
+                static_cast<long>(nTime - oIter.second.nModTime) > m_nExpires;
+            // Expired items sort first
+            aoCandidates.emplace_back(bExpired ? 0 : oIter.second.nAccessTime,
+                                      oIter.first);
         }
+        std::sort(aoCandidates.begin(), aoCandidates.end());
 
-        int counter = 0;
-        std::vector<int> toDelete;
-        long nSize = 0;
-        time_t nTime = time(nullptr);
-        while (papszList[counter] != nullptr)
+        unsigned nDeleted = 0;
+        for (const auto &oCandidate : aoCandidates)
         {
-            const char *pszPath =
-                CPLFormFilename(m_soPath, papszList[counter], nullptr);
-            VSIStatBufL sStatBuf;
-            if (VSIStatL(pszPath, &sStatBuf) == 0)
-            {
-                if (!VSI_ISDIR(sStatBuf.st_mode))
-                {
-                    long seconds = static_cast<long>(nTime - sStatBuf.st_mtime);
-                    if (seconds > m_nExpires)
-                    {
-                        toDelete.push_back(counter);
-                    }
+            if (m_nIndexSize <= m_nMaxSize)
+                break;
+            auto oIter = m_oIndex.find(oCandidate.second);
+            VSIUnlink(oCandidate.second.c_str());
+            m_nIndexSize -= oIter->second.nSize;
+            m_oIndex.erase(oIter);
+            ++nDeleted;
+        }
+        CPLDebug("WMS", "Delete %u items from cache", nDeleted);
+    }
 
-                    nSize += static_cast<long>(sStatBuf.st_size);
-                }
-            }
-            counter++;
+  private:
+    void BuildIndex()
+    {
+        m_oIndex.clear();
+        m_nIndexSize = 0;
+
+        char **papszList = VSIReadDirRecursive(m_soPath);
+        if (papszList == nullptr)
+        {
+            return;
         }
 
-        if (nSize > m_nMaxSize)
+        for (int i = 0; papszList[i] != nullptr; ++i)
         {
-            CPLDebug("WMS", "Delete %u items from cache",
-                     static_cast<unsigned int>(toDelete.size()));
-            for (size_t i = 0; i < toDelete.size(); ++i)
+            const std::string osPath =
+                CPLFormFilename(m_soPath, papszList[i], nullptr);
+            VSIStatBufL sStatBuf;
+            if (VSIStatL(osPath.c_str(), &sStatBuf) == 0 &&
+                !VSI_ISDIR(sStatBuf.st_mode))
             {
-                const char *pszPath =
-                    CPLFormFilename(m_soPath, papszList[toDelete[i]], nullptr);
-                VSIUnlink(pszPath);
+                auto &oEntry = m_oIndex[osPath];
+                oEntry.nSize = static_cast<GIntBig>(sStatBuf.st_size);
+                oEntry.nModTime = sStatBuf.st_mtime;
+                oEntry.nAccessTime = sStatBuf.st_mtime;
+                m_nIndexSize += oEntry.nSize;
             }
         }
 
         CSLDestroy(papszList);
     }
 
-  private:
     CPLString GetFilePath(const char *pszKey) const
     {
         CPLString soHash(CPLMD5String(pszKey));
@@ -216,6 +269,20 @@ class GDALWMSFileCache : public GDALWMSCacheImpl
     int m_nExpires;
     long m_nMaxSize;
     int m_nCleanThreadRunTimeout;
+
+    struct IndexEntry
+    {
+        GIntBig nSize = 0;
+        time_t nModTime = 0;
+        time_t nAccessTime = 0;
+    };
+
+    // Index of the cached files, built by the first Clean() call. Clean()
+    // runs in a separate thread, hence the mutex.
+    mutable std::mutex m_oIndexMutex{};
+    mutable std::map<std::string, IndexEntry> m_oIndex{};
+    GIntBig m_nIndexSize = 0;
+    bool m_bIndexBuilt = false;
 };
 
 //------------------------------------------------------------------------------
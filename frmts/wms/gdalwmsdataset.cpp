@@ -177,6 +177,18 @@ CPLErr GDALWMSDataset::Initialize(CPLXMLNode *config, char **l_papszOpenOptions)
         }
     }
 
+    if (ret == CE_None)
+    {
+        const char *prefetch_margin =
+            CPLGetXMLValue(config, "PrefetchMargin", "");
+        if (prefetch_margin[0] == '\0')
+        {
+            prefetch_margin =
+                CPLGetConfigOption("GDAL_WMS_PREFETCH_MARGIN", "0");
+        }
+        m_prefetch_margin = std::max(0, std::min(atoi(prefetch_margin), 15));
+    }
+
     if (ret == CE_None)
     {
         const char *timeout = CPLGetXMLValue(config, "Timeout", "");
@@ -346,14 +346,22 @@ CPLErr GDALWMSRasterBand::IReadBlock(int x, int y, void *buffer)
                    nBlockYSize;
         if ((tbx0 <= x) && (tby0 <= y) && (tbx1 >= x) && (tby1 >= y))
         {
+            // Also fetch a margin of tiles around the request, so that
+            // panning to a neighbouring area finds them in the block cache.
+            const int nMargin = m_parent_dataset->m_prefetch_margin;
+            const int ptbx0 = std::max(0, tbx0 - nMargin);
+            const int ptby0 = std::max(0, tby0 - nMargin);
+            const int ptbx1 = std::min(nBlocksPerRow - 1, tbx1 + nMargin);
+            const int ptby1 = std::min(nBlocksPerColumn - 1, tby1 + nMargin);
+
             // Avoid downloading a insane number of tiles at once.
             // Limit to 30x30 tiles centered around block of interest.
-            bx0 = std::max(x - 15, tbx0);
-            by0 = std::max(y - 15, tby0);
-            bx1 = std::min(x + 15, tbx1);
-            by1 = std::min(y + 15, tby1);
+            bx0 = std::max(x - 15, ptbx0);
+            by0 = std::max(y - 15, ptby0);
+            bx1 = std::min(x + 15, ptbx1);
+            by1 = std::min(y + 15, ptby1);
             bCancelHint =
-                (bx0 == tbx0 && by0 == tby0 && bx1 == tbx1 && by1 == tby1);
+                (bx0 == ptbx0 && by0 == ptby0 && bx1 == ptbx1 && by1 == ptby1);
         }
     }
 
@@ -500,6 +500,7 @@ class GDALWMSDataset final : public GDALPamDataset
     int m_use_advise_read;
     int m_verify_advise_read;
     int m_offline_mode;
+    int m_prefetch_margin = 0;  // in tiles, around RasterIO() requests
     int m_http_max_conn;
     int m_http_timeout;
     char **m_http_options;
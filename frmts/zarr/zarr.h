@@ -31,11 +31,14 @@
 
 #include "cpl_compressor.h"
 #include "cpl_json.h"
+#include "cpl_mem_cache.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal_priv.h"
 #include "gdal_pam.h"
 #include "memmultidim.h"
 
 #include <array>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -794,8 +797,18 @@ class ZarrArray CPL_NON_FINAL : public GDALPamMDArray
     struct CachedTile
     {
         ZarrByteVectorQuickResize abyDecoded{};
+        uint64_t nLastAccess = 0;
     };
     mutable std::map<uint64_t, CachedTile> m_oMapTileIndexToCachedTile{};
+    // Sum of the sizes of the tiles of m_oMapTileIndexToCachedTile, in bytes
+    mutable size_t m_nCachedTilesSize = 0;
+    mutable uint64_t m_nCachedTilesAccessCounter = 0;
+
+    // Write-behind of dirty tiles. See SubmitTileWrite()
+    mutable std::unique_ptr<CPLJobQueue> m_poTileWriteQueue{};
+    mutable std::mutex m_oTileWriteMutex{};
+    mutable std::set<std::string> m_oSetPendingTileWrites{};
+    mutable bool m_bTileWriteError = false;
 
     static uint64_t
     ComputeTileCount(const std::string &osName,
@@ -812,6 +825,33 @@ class ZarrArray CPL_NON_FINAL : public GDALPamMDArray
     virtual bool LoadTileData(const uint64_t *tileIndices,
                               bool &bMissingTileOut) const = 0;
 
+    // Decode in parallel the nReqTiles tiles whose indices are in
+    // anReqTilesIndices, and insert them in m_oMapTileIndexToCachedTile.
+    virtual bool
+    LoadTilesInParallel(const std::vector<uint64_t> &anReqTilesIndices,
+                        size_t nReqTiles, int nThreadsMax) const = 0;
+
+    uint64_t GetTileLinearIndex(const uint64_t *tileIndices) const;
+
+    // Must be called with m_oMutex held when called from worker threads.
+    void CacheTile(uint64_t nTileIdx, CachedTile &&oCachedTile) const;
+
+    void ClearCachedTiles() const;
+
+    bool PreloadTilesForRead(const GUInt64 *arrayStartIdx, const size_t *count,
+                             const GInt64 *arrayStep) const;
+
+    static int GetTileWriteNumThreads();
+
+    // Run fnWrite, that writes (or deletes) tile osFilename, asynchronously
+    // if GDAL_NUM_THREADS > 1, or synchronously otherwise.
+    bool SubmitTileWrite(const std::string &osFilename,
+                         std::function<bool()> &&fnWrite) const;
+
+    // Wait for asynchronous tile writes to be done, and return false if one
+    // of them failed.
+    bool WaitPendingTileWrites() const;
+
     void BlockTranspose(const ZarrByteVectorQuickResize &abySrc,
                         ZarrByteVectorQuickResize &abyDst, bool bDecode) const;
 
@@ -1141,6 +1181,9 @@ class ZarrV2Array final : public ZarrArray
 
     bool IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
                      CSLConstList papszOptions) const override;
+
+    bool LoadTilesInParallel(const std::vector<uint64_t> &anReqTilesIndices,
+                             size_t nReqTiles, int nThreadsMax) const override;
 };
 
 /************************************************************************/
@@ -1449,6 +1492,29 @@ class ZarrV3Array final : public ZarrArray
     bool m_bV2ChunkKeyEncoding = false;
     std::unique_ptr<ZarrV3CodecSequence> m_poCodecs{};
 
+    // Sharding (sharding_indexed codec). When set, the tiles of the array
+    // are the inner chunks of the shards, and m_poCodecs are the codecs of
+    // the inner chunks.
+    std::vector<GUInt64> m_anShardSize{};  // empty if not sharded
+    std::vector<uint64_t> m_anInnerChunksPerShard{};
+    size_t m_nInnerChunksPerShard = 0;
+    CPLJSONArray m_oShardingCodecs{};  // "codecs" member of zarr.json
+    bool m_bShardIndexAtStart = false;
+    bool m_bShardIndexHasCRC32C = false;
+    // Decoded shard indices (pairs of offset, size of the inner chunks), keyed
+    // by shard filename. Empty vector for missing shards.
+    using ShardIndexCacheType =
+        lru11::Cache<std::string, std::shared_ptr<const std::vector<uint64_t>>,
+                     std::mutex>;
+    mutable std::unique_ptr<ShardIndexCacheType> m_poShardIndexCache{};
+
+    struct ShardChunkRequest
+    {
+        size_t nInnerIdx = 0;  // index of the inner chunk in the shard
+        ZarrByteVectorQuickResize *pabyData = nullptr;  // encoded chunk
+        bool bMissing = false;
+    };
+
     ZarrV3Array(const std::shared_ptr<ZarrSharedResource> &poSharedResource,
                 const std::string &osParentName, const std::string &osName,
                 const std::vector<std::shared_ptr<GDALDimension>> &aoDims,
@@ -1470,6 +1536,31 @@ class ZarrV3Array final : public ZarrArray
                       ZarrByteVectorQuickResize &abyDecodedTileData,
                       bool &bMissingTileOut) const;
 
+    std::string BuildFilename(const uint64_t *anIndices) const;
+
+    VSILFILE *OpenTileFile(const std::string &osFilename) const;
+
+    void DecodeRawTileData(const ZarrByteVectorQuickResize &abyRawTileData,
+                           ZarrByteVectorQuickResize &abyDecodedTileData) const;
+
+    size_t GetInnerChunkIndexInShard(const uint64_t *tileIndices) const;
+
+    std::shared_ptr<const std::vector<uint64_t>>
+    GetShardIndex(const std::string &osShardFilename) const;
+
+    bool ReadChunksFromShard(const std::string &osShardFilename,
+                             std::vector<ShardChunkRequest> &aoRequests) const;
+
+    bool DecodeInnerChunk(const std::string &osShardFilename,
+                          ZarrV3CodecSequence *poCodecs,
+                          ZarrByteVectorQuickResize &abyRawTileData,
+                          ZarrByteVectorQuickResize &abyDecodedTileData) const;
+
+    void LoadTilesFromShards(const uint64_t *panTilesIndices, size_t nFirstIdx,
+                             size_t nLastIdxNotIncluded,
+                             ZarrV3CodecSequence *poCodecs,
+                             bool &bGlobalStatus) const;
+
   public:
     ~ZarrV3Array() override;
 
@@ -1491,6 +1582,15 @@ class ZarrV3Array final : public ZarrArray
         m_poCodecs = std::move(poCodecs);
     }
 
+    void SetSharding(const std::vector<GUInt64> &anShardSize,
+                     const CPLJSONArray &oShardingCodecs,
+                     bool bIndexAtStart, bool bIndexHasCRC32C);
+
+    bool IsSharded() const
+    {
+        return !m_anShardSize.empty();
+    }
+
     void Flush() override;
 
   protected:
@@ -1501,6 +1601,11 @@ class ZarrV3Array final : public ZarrArray
 
     bool AllocateWorkingBuffers() const override;
 
+    bool IWrite(const GUInt64 *arrayStartIdx, const size_t *count,
+                const GInt64 *arrayStep, const GPtrDiff_t *bufferStride,
+                const GDALExtendedDataType &bufferDataType,
+                const void *pSrcBuffer) override;
+
     bool FlushDirtyTile() const override;
 
     std::string BuildTileFilename(const uint64_t *tileIndices) const override;
@@ -1510,6 +1615,9 @@ class ZarrV3Array final : public ZarrArray
 
     bool IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
                      CSLConstList papszOptions) const override;
+
+    bool LoadTilesInParallel(const std::vector<uint64_t> &anReqTilesIndices,
+                             size_t nReqTiles, int nThreadsMax) const override;
 };
 
 #endif  // ZARR_H
@@ -30,6 +30,7 @@
 #include "ucs4_utf8.hpp"
 
 #include "cpl_float.h"
+#include "gdal_thread_pool.h"
 
 #include "netcdf_cf_constants.h"  // for CF_UNITS, etc
 
@@ -205,6 +206,8 @@ ZarrArray::ZarrArray(
 
 ZarrArray::~ZarrArray()
 {
+    WaitPendingTileWrites();
+
     if (m_pabyNoData)
     {
         m_oType.FreeDynamicMemory(&m_pabyNoData[0]);
@@ -212,6 +215,7 @@ ZarrArray::~ZarrArray()
     }
 
     DeallocateDecodedTileData();
+    ClearCachedTiles();
 }
 
 /************************************************************************/
@@ -891,6 +895,9 @@ bool ZarrArray::IAdviseReadCommon(const GUInt64 *arrayStartIdx,
     if (!CheckValidAndErrorOutIfNot())
         return false;
 
+    if (!WaitPendingTileWrites())
+        return false;
+
     const size_t nDims = m_aoDims.size();
     anIndicesCur.resize(nDims);
     std::vector<uint64_t> anIndicesMin(nDims);
@@ -967,7 +974,7 @@ bool ZarrArray::IAdviseReadCommon(const GUInt64 *arrayStartIdx,
     CPLDebug(ZARR_DEBUG_KEY, "IAdviseRead(): Using up to %d threads",
              nThreadsMax);
 
-    m_oMapTileIndexToCachedTile.clear();
+    ClearCachedTiles();
 
     // Overflow checked above
     try
@@ -1027,6 +1034,323 @@ lbl_next_depth:
     return true;
 }
 
+/************************************************************************/
+/*                    ZarrArray::GetTileLinearIndex()                   */
+/************************************************************************/
+
+// Return a unique index for a tile from its indices in each dimension.
+uint64_t ZarrArray::GetTileLinearIndex(const uint64_t *tileIndices) const
+{
+    uint64_t nTileIdx = 0;
+    for (size_t j = 0; j < m_aoDims.size(); ++j)
+    {
+        nTileIdx *= DIV_ROUND_UP(m_aoDims[j]->GetSize(), m_anBlockSize[j]);
+        nTileIdx += tileIndices[j];
+    }
+    return nTileIdx;
+}
+
+/************************************************************************/
+/*                        ZarrArray::CacheTile()                        */
+/************************************************************************/
+
+void ZarrArray::CacheTile(uint64_t nTileIdx, CachedTile &&oCachedTile) const
+{
+    auto &oSlot = m_oMapTileIndexToCachedTile[nTileIdx];
+    const size_t nOldSize = oSlot.abyDecoded.size();
+    m_nCachedTilesSize -= nOldSize;
+    oSlot = std::move(oCachedTile);
+    oSlot.nLastAccess = m_nCachedTilesAccessCounter;
+    m_nCachedTilesSize += oSlot.abyDecoded.size();
+    CPLAccountMemory("Zarr.tile_cache",
+                     static_cast<GIntBig>(oSlot.abyDecoded.size()) -
+                         static_cast<GIntBig>(nOldSize));
+}
+
+/************************************************************************/
+/*                     ZarrArray::ClearCachedTiles()                    */
+/************************************************************************/
+
+void ZarrArray::ClearCachedTiles() const
+{
+    CPLAccountMemory("Zarr.tile_cache",
+                     -static_cast<GIntBig>(m_nCachedTilesSize));
+    m_oMapTileIndexToCachedTile.clear();
+    m_nCachedTilesSize = 0;
+}
+
+/************************************************************************/
+/*                    ZarrArray::PreloadTilesForRead()                  */
+/************************************************************************/
+
+// When a read request intersects several tiles, decode in parallel the ones
+// that are not yet in m_oMapTileIndexToCachedTile, so that IRead() finds
+// them there. The cache is kept within ZARR_CHUNK_CACHE_SIZE bytes by
+// evicting the least recently used tiles.
+// Returns false only in case of error. Not preloading is not an error.
+bool ZarrArray::PreloadTilesForRead(const GUInt64 *arrayStartIdx,
+                                    const size_t *count,
+                                    const GInt64 *arrayStep) const
+{
+    const size_t nDims = m_aoDims.size();
+    if (nDims == 0 || m_nTileSize == 0)
+        return true;
+
+    const char *pszNumThreads =
+        CPLGetConfigOption("GDAL_NUM_THREADS", "ALL_CPUS");
+    int nThreadsMax;
+    if (EQUAL(pszNumThreads, "ALL_CPUS"))
+        nThreadsMax = CPLGetNumCPUs();
+    else
+        nThreadsMax = std::max(1, atoi(pszNumThreads));
+    if (nThreadsMax > 1024)
+        nThreadsMax = 1024;
+    if (nThreadsMax <= 1)
+        return true;
+
+    const char *pszCacheSize = CPLGetConfigOption("ZARR_CHUNK_CACHE_SIZE", "");
+    uint64_t nCacheSize;
+    if (pszCacheSize[0])
+    {
+        nCacheSize = static_cast<uint64_t>(
+            std::max<GIntBig>(0, CPLAtoGIntBig(pszCacheSize)));
+    }
+    else
+    {
+        // Same default as IAdviseRead(): half of remaining cache size
+        nCacheSize = static_cast<uint64_t>(
+            std::max<GIntBig>(0, GDALGetCacheMax64() - GDALGetCacheUsed64()) /
+            2);
+    }
+    const uint64_t nMaxTiles = nCacheSize / m_nTileSize;
+    if (nMaxTiles <= 1)
+        return true;
+
+    // Collect, for each dimension, the indices of the tiles intersected by
+    // the request.
+    std::vector<std::vector<uint64_t>> aanTileIndices(nDims);
+    uint64_t nTiles = 1;
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        auto &anTileIndices = aanTileIndices[i];
+        const uint64_t nBlockSize = m_anBlockSize[i];
+        const uint64_t nStep =
+            count[i] == 1 ? 0 : static_cast<uint64_t>(arrayStep[i]);
+        if (nStep < nBlockSize)
+        {
+            // All tiles between the first and last ones are intersected
+            const uint64_t nFirst = arrayStartIdx[i] / nBlockSize;
+            const uint64_t nLast =
+                (arrayStartIdx[i] + (count[i] - 1) * nStep) / nBlockSize;
+            if (nLast - nFirst >= nMaxTiles)
+                return true;
+            for (uint64_t j = nFirst; j <= nLast; ++j)
+                anTileIndices.push_back(j);
+        }
+        else
+        {
+            if (count[i] > nMaxTiles)
+                return true;
+            for (size_t j = 0; j < count[i]; ++j)
+            {
+                const uint64_t nTileIdx =
+                    (arrayStartIdx[i] + j * nStep) / nBlockSize;
+                if (anTileIndices.empty() || anTileIndices.back() != nTileIdx)
+                    anTileIndices.push_back(nTileIdx);
+            }
+        }
+        if (anTileIndices.size() > nMaxTiles / nTiles)
+            return true;
+        nTiles *= anTileIndices.size();
+    }
+    if (nTiles <= 1)
+        return true;
+
+    // Make sure that tiles read from storage reflect pending modifications
+    if (!FlushDirtyTile())
+        return false;
+
+    ++m_nCachedTilesAccessCounter;
+
+    // Find the tiles that are not already cached
+    std::vector<uint64_t> anReqTilesIndices;
+    size_t nReqTiles = 0;
+    std::vector<size_t> anIter(nDims);
+    std::vector<uint64_t> tileIndices(nDims);
+    for (uint64_t n = 0; n < nTiles; ++n)
+    {
+        for (size_t i = 0; i < nDims; ++i)
+            tileIndices[i] = aanTileIndices[i][anIter[i]];
+        const auto oIter = m_oMapTileIndexToCachedTile.find(
+            GetTileLinearIndex(tileIndices.data()));
+        if (oIter != m_oMapTileIndexToCachedTile.end())
+        {
+            oIter->second.nLastAccess = m_nCachedTilesAccessCounter;
+        }
+        else
+        {
+            anReqTilesIndices.insert(anReqTilesIndices.end(),
+                                     tileIndices.begin(), tileIndices.end());
+            ++nReqTiles;
+        }
+
+        for (size_t i = nDims; i > 0;)
+        {
+            --i;
+            if (++anIter[i] < aanTileIndices[i].size())
+                break;
+            anIter[i] = 0;
+        }
+    }
+    // A single missing tile will be loaded by IRead() itself
+    if (nReqTiles <= 1)
+        return true;
+
+    // Evict the least recently used tiles not needed by this request
+    const uint64_t nNeededSize = static_cast<uint64_t>(nReqTiles) * m_nTileSize;
+    if (m_nCachedTilesSize + nNeededSize > nCacheSize)
+    {
+        std::vector<std::pair<uint64_t, uint64_t>> anLastAccessAndTileIdx;
+        for (const auto &oIter : m_oMapTileIndexToCachedTile)
+        {
+            if (oIter.second.nLastAccess != m_nCachedTilesAccessCounter)
+            {
+                anLastAccessAndTileIdx.emplace_back(oIter.second.nLastAccess,
+                                                    oIter.first);
+            }
+        }
+        std::sort(anLastAccessAndTileIdx.begin(), anLastAccessAndTileIdx.end());
+        for (const auto &oPair : anLastAccessAndTileIdx)
+        {
+            if (m_nCachedTilesSize + nNeededSize <= nCacheSize)
+                break;
+            const auto oIter = m_oMapTileIndexToCachedTile.find(oPair.second);
+            m_nCachedTilesSize -= oIter->second.abyDecoded.size();
+            CPLAccountMemory(
+                "Zarr.tile_cache",
+                -static_cast<GIntBig>(oIter->second.abyDecoded.size()));
+            m_oMapTileIndexToCachedTile.erase(oIter);
+        }
+    }
+
+    CPLDebugOnly(ZARR_DEBUG_KEY, "Preloading %u tiles using up to %d threads",
+                 static_cast<unsigned>(nReqTiles), nThreadsMax);
+    return LoadTilesInParallel(anReqTilesIndices, nReqTiles, nThreadsMax);
+}
+
+/************************************************************************/
+/*                  ZarrArray::GetTileWriteNumThreads()                 */
+/************************************************************************/
+
+int ZarrArray::GetTileWriteNumThreads()
+{
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    int nThreads;
+    if (EQUAL(pszNumThreads, "ALL_CPUS"))
+        nThreads = CPLGetNumCPUs();
+    else
+        nThreads = std::max(1, atoi(pszNumThreads));
+    return std::min(nThreads, 1024);
+}
+
+/************************************************************************/
+/*                     ZarrArray::SubmitTileWrite()                     */
+/************************************************************************/
+
+bool ZarrArray::SubmitTileWrite(const std::string &osFilename,
+                                std::function<bool()> &&fnWrite) const
+{
+    const int nThreads = GetTileWriteNumThreads();
+    if (nThreads > 1 && !m_poTileWriteQueue)
+    {
+        auto poThreadPool = GDALGetGlobalThreadPool(nThreads);
+        if (poThreadPool)
+            m_poTileWriteQueue = poThreadPool->CreateJobQueue();
+    }
+    if (nThreads <= 1 || !m_poTileWriteQueue)
+    {
+        return WaitPendingTileWrites() && fnWrite();
+    }
+
+    bool bSameTilePending;
+    {
+        std::lock_guard<std::mutex> oLock(m_oTileWriteMutex);
+        bSameTilePending = m_oSetPendingTileWrites.find(osFilename) !=
+                           m_oSetPendingTileWrites.end();
+    }
+    if (bSameTilePending)
+    {
+        // Writes of the same tile must be done in order
+        m_poTileWriteQueue->WaitCompletion();
+    }
+    else
+    {
+        // Bound the memory used by tiles waiting to be written
+        m_poTileWriteQueue->WaitCompletion(2 * nThreads - 1);
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(m_oTileWriteMutex);
+        if (m_bTileWriteError)
+        {
+            m_bTileWriteError = false;
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Writing of a previous tile failed");
+            return false;
+        }
+        m_oSetPendingTileWrites.insert(osFilename);
+    }
+
+    auto pfnJob = new std::function<void()>(
+        [this, osFilename, fnWrite = std::move(fnWrite)]()
+        {
+            const bool bOK = fnWrite();
+            std::lock_guard<std::mutex> oLock(m_oTileWriteMutex);
+            m_oSetPendingTileWrites.erase(osFilename);
+            if (!bOK)
+                m_bTileWriteError = true;
+        });
+    const auto JobFunc = [](void *pData)
+    {
+        auto pfn = static_cast<std::function<void()> *>(pData);
+        (*pfn)();
+        delete pfn;
+    };
+    if (!m_poTileWriteQueue->SubmitJob(JobFunc, pfnJob))
+    {
+        // Can only happen on memory allocation failure. Do the job
+        // synchronously then.
+        JobFunc(pfnJob);
+        std::lock_guard<std::mutex> oLock(m_oTileWriteMutex);
+        if (m_bTileWriteError)
+        {
+            m_bTileWriteError = false;
+            return false;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                  ZarrArray::WaitPendingTileWrites()                  */
+/************************************************************************/
+
+bool ZarrArray::WaitPendingTileWrites() const
+{
+    if (!m_poTileWriteQueue)
+        return true;
+    m_poTileWriteQueue->WaitCompletion();
+
+    std::lock_guard<std::mutex> oLock(m_oTileWriteMutex);
+    if (m_bTileWriteError)
+    {
+        m_bTileWriteError = false;
+        CPLError(CE_Failure, CPLE_AppDefined, "Writing of a tile failed");
+        return false;
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                           ZarrArray::IRead()                         */
 /************************************************************************/
@@ -1039,6 +1363,10 @@ bool ZarrArray::IRead(const GUInt64 *arrayStartIdx, const size_t *count,
     if (!CheckValidAndErrorOutIfNot())
         return false;
 
+    // Tiles must be read after pending writes are done
+    if (!WaitPendingTileWrites())
+        return false;
+
     if (!AllocateWorkingBuffers())
         return false;
 
@@ -1092,6 +1420,9 @@ bool ZarrArray::IRead(const GUInt64 *arrayStartIdx, const size_t *count,
         bufferStride = bufferStrideMod.data();
     }
 
+    if (!PreloadTilesForRead(arrayStartIdx, count, arrayStep))
+        return false;
+
     std::vector<uint64_t> indicesOuterLoop(nDims + 1);
     std::vector<GByte *> dstPtrStackOuterLoop(nDims + 1);
 
@@ -1114,6 +1445,7 @@ bool ZarrArray::IRead(const GUInt64 *arrayStartIdx, const size_t *count,
 
     std::vector<size_t> countInnerLoopInit(nDims + 1, 1);
     std::vector<size_t> countInnerLoop(nDims);
+    std::vector<GPtrDiff_t> anSrcTileStrides(nDims);
 
     const bool bBothAreNumericDT = m_oType.GetClass() == GEDTC_NUMERIC &&
                                    bufferDataType.GetClass() == GEDTC_NUMERIC;
@@ -1141,20 +1473,16 @@ lbl_next_depth:
                                        : m_abyDecodedTileData.data();
         bool bMatchFoundInMapTileIndexToCachedTile = false;
 
-        // Use cache built by IAdviseRead() if possible
+        // Use cache built by IAdviseRead() or PreloadTilesForRead() if
+        // possible
         if (!m_oMapTileIndexToCachedTile.empty())
         {
-            uint64_t nTileIdx = 0;
-            for (size_t j = 0; j < nDims; ++j)
-            {
-                if (j > 0)
-                    nTileIdx *= m_aoDims[j - 1]->GetSize();
-                nTileIdx += tileIndices[j];
-            }
+            const uint64_t nTileIdx = GetTileLinearIndex(tileIndices.data());
             const auto oIter = m_oMapTileIndexToCachedTile.find(nTileIdx);
             if (oIter != m_oMapTileIndexToCachedTile.end())
             {
                 bMatchFoundInMapTileIndexToCachedTile = true;
+                oIter->second.nLastAccess = m_nCachedTilesAccessCounter;
                 if (oIter->second.abyDecoded.empty())
                 {
                     bEmptyTile = true;
@@ -1240,6 +1568,30 @@ lbl_next_depth:
             }
         }
 
+        if (m_bUseOptimizedCodePaths && !bEmptyTile && bBothAreNumericDT &&
+            nDims > 0)
+        {
+            // Copy the intersection of the request with the tile at once
+            size_t nOffset = 0;
+            GPtrDiff_t nTileStride = 1;
+            for (size_t i = nDims; i > 0;)
+            {
+                --i;
+                nOffset += static_cast<size_t>(
+                    (indicesOuterLoop[i] - tileIndices[i] * m_anBlockSize[i]) *
+                    nTileStride);
+                anSrcTileStrides[i] =
+                    static_cast<GPtrDiff_t>(arrayStep[i]) * nTileStride;
+                nTileStride *= static_cast<GPtrDiff_t>(m_anBlockSize[i]);
+            }
+            GDALExtendedDataType::CopyValues(
+                nDims, countInnerLoopInit.data(),
+                pabySrcTile + nOffset * nSrcDTSize, m_oType,
+                anSrcTileStrides.data(), dstPtrStackInnerLoop[0],
+                bufferDataType, bufferStride);
+            goto end_inner_loop;
+        }
+
     lbl_next_depth_inner_loop:
         if (nDims == 0 || dimIdxSubLoop == nDims - 1)
         {
@@ -1532,7 +1884,7 @@ bool ZarrArray::IWrite(const GUInt64 *arrayStartIdx, const size_t *count,
     if (!AllocateWorkingBuffers())
         return false;
 
-    m_oMapTileIndexToCachedTile.clear();
+    ClearCachedTiles();
 
     // Need to be kept in top-level scope
     std::vector<GUInt64> arrayStartIdxMod;
@@ -1609,6 +1961,7 @@ bool ZarrArray::IWrite(const GUInt64 *arrayStartIdx, const size_t *count,
 
     std::vector<size_t> countInnerLoopInit(nDims + 1, 1);
     std::vector<size_t> countInnerLoop(nDims);
+    std::vector<GPtrDiff_t> anSrcTileStrides(nDims);
 
     const bool bBothAreNumericDT = m_oType.GetClass() == GEDTC_NUMERIC &&
                                    bufferDataType.GetClass() == GEDTC_NUMERIC;
@@ -1695,6 +2048,7 @@ lbl_next_depth:
                 // potentially existing one.
                 bool bEmptyTile = false;
                 m_bCachedTiledValid =
+                    WaitPendingTileWrites() &&
                     LoadTileData(tileIndices.data(), bEmptyTile);
                 if (!m_bCachedTiledValid)
                 {
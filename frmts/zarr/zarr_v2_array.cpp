@@ -98,6 +98,7 @@ void ZarrV2Array::Flush()
         return;
 
     ZarrV2Array::FlushDirtyTile();
+    WaitPendingTileWrites();
 
     if (m_bDefinitionModified)
     {
@@ -660,6 +661,17 @@ bool ZarrV2Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
         return true;
     }
 
+    return LoadTilesInParallel(anReqTilesIndices, nReqTiles, nThreadsMax);
+}
+
+/************************************************************************/
+/*                  ZarrV2Array::LoadTilesInParallel()                  */
+/************************************************************************/
+
+bool ZarrV2Array::LoadTilesInParallel(
+    const std::vector<uint64_t> &anReqTilesIndices, size_t nReqTiles,
+    int nThreadsMax) const
+{
     const int nThreads =
         static_cast<int>(std::min(static_cast<size_t>(nThreadsMax), nReqTiles));
 
@@ -712,7 +724,6 @@ bool ZarrV2Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
             static_cast<const JobStruct *>(pThreadData);
 
         const auto poArray = jobStruct->poArray;
-        const auto &aoDims = poArray->GetDimensions();
         const size_t l_nDims = poArray->GetDimensionCount();
         ZarrByteVectorQuickResize abyRawTileData;
         ZarrByteVectorQuickResize abyDecodedTileData;
@@ -733,13 +744,8 @@ bool ZarrV2Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
             const uint64_t *tileIndices =
                 jobStruct->panReqTilesIndices->data() + iReq * l_nDims;
 
-            uint64_t nTileIdx = 0;
-            for (size_t j = 0; j < l_nDims; ++j)
-            {
-                if (j > 0)
-                    nTileIdx *= aoDims[j - 1]->GetSize();
-                nTileIdx += tileIndices[j];
-            }
+            const uint64_t nTileIdx =
+                poArray->GetTileLinearIndex(tileIndices);
 
             if (!poArray->AllocateWorkingBuffers(
                     abyRawTileData, abyTmpRawTileData, abyDecodedTileData))
@@ -771,8 +777,7 @@ bool ZarrV2Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
                 else
                     std::swap(cachedTile.abyDecoded, abyRawTileData);
             }
-            poArray->m_oMapTileIndexToCachedTile[nTileIdx] =
-                std::move(cachedTile);
+            poArray->CacheTile(nTileIdx, std::move(cachedTile));
         }
 
         std::lock_guard<std::mutex> oLock(poArray->m_oMutex);
@@ -806,86 +811,48 @@ bool ZarrV2Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
 }
 
 /************************************************************************/
-/*                    ZarrV2Array::FlushDirtyTile()                     */
+/*                            WriteV2Tile()                             */
 /************************************************************************/
 
-bool ZarrV2Array::FlushDirtyTile() const
+namespace
 {
-    if (!m_bDirtyTile)
-        return true;
-    m_bDirtyTile = false;
-
-    std::string osFilename = BuildTileFilename(m_anCachedTiledIndices.data());
-
-    const size_t nSourceSize =
-        m_aoDtypeElts.back().nativeOffset + m_aoDtypeElts.back().nativeSize;
-    const auto &abyTile =
-        m_abyDecodedTileData.empty() ? m_abyRawTileData : m_abyDecodedTileData;
-
-    if (IsEmptyTile(abyTile))
-    {
-        m_bCachedTiledEmpty = true;
-
-        VSIStatBufL sStat;
-        if (VSIStatL(osFilename.c_str(), &sStat) == 0)
-        {
-            CPLDebugOnly(ZARR_DEBUG_KEY,
-                         "Deleting tile %s that has now empty content",
-                         osFilename.c_str());
-            return VSIUnlink(osFilename.c_str()) == 0;
-        }
-        return true;
-    }
-
-    if (!m_abyDecodedTileData.empty())
-    {
-        const size_t nDTSize = m_oType.GetSize();
-        const size_t nValues = m_abyDecodedTileData.size() / nDTSize;
-        GByte *pDst = &m_abyRawTileData[0];
-        const GByte *pSrc = m_abyDecodedTileData.data();
-        for (size_t i = 0; i < nValues;
-             i++, pDst += nSourceSize, pSrc += nDTSize)
-        {
-            EncodeElt(m_aoDtypeElts, pSrc, pDst);
-        }
-    }
-
-    if (m_bFortranOrder && !m_aoDims.empty())
-    {
-        BlockTranspose(m_abyRawTileData, m_abyTmpRawTileData, false);
-        std::swap(m_abyRawTileData, m_abyTmpRawTileData);
-    }
-
-    size_t nRawDataSize = m_abyRawTileData.size();
-    for (const auto &oFilter : m_oFiltersArray)
+struct ZarrV2Filter
+{
+    std::string osId{};
+    const CPLCompressor *psCompressor = nullptr;
+    CPLStringList aosOptions{};
+};
+}  // namespace
+
+// Apply filters and compressor to abyRawTileData (modified in place), and
+// write the result into osFilename.
+static bool WriteV2Tile(const std::string &osFilename,
+                        ZarrByteVectorQuickResize &abyRawTileData,
+                        ZarrByteVectorQuickResize &abyTmpRawTileData,
+                        const std::vector<ZarrV2Filter> &aoFilters,
+                        const CPLCompressor *psCompressor,
+                        CSLConstList papszCompressorOptions, bool bCreateDir)
+{
+    size_t nRawDataSize = abyRawTileData.size();
+    for (const auto &oFilter : aoFilters)
     {
-        const auto osFilterId = oFilter["id"].ToString();
-        const auto psFilterCompressor = CPLGetCompressor(osFilterId.c_str());
-        CPLAssert(psFilterCompressor);
-
-        CPLStringList aosOptions;
-        for (const auto &obj : oFilter.GetChildren())
-        {
-            aosOptions.SetNameValue(obj.GetName().c_str(),
-                                    obj.ToString().c_str());
-        }
-        void *out_buffer = &m_abyTmpRawTileData[0];
-        size_t nOutSize = m_abyTmpRawTileData.size();
-        if (!psFilterCompressor->pfnFunc(
-                m_abyRawTileData.data(), nRawDataSize, &out_buffer, &nOutSize,
-                aosOptions.List(), psFilterCompressor->user_data))
+        void *out_buffer = &abyTmpRawTileData[0];
+        size_t nOutSize = abyTmpRawTileData.size();
+        if (!oFilter.psCompressor->pfnFunc(
+                abyRawTileData.data(), nRawDataSize, &out_buffer, &nOutSize,
+                oFilter.aosOptions.List(), oFilter.psCompressor->user_data))
         {
             CPLError(CE_Failure, CPLE_AppDefined,
-                     "Filter %s for tile %s failed", osFilterId.c_str(),
+                     "Filter %s for tile %s failed", oFilter.osId.c_str(),
                      osFilename.c_str());
             return false;
         }
 
         nRawDataSize = nOutSize;
-        std::swap(m_abyRawTileData, m_abyTmpRawTileData);
+        std::swap(abyRawTileData, abyTmpRawTileData);
     }
 
-    if (m_osDimSeparator == "/")
+    if (bCreateDir)
     {
         std::string osDir = CPLGetDirname(osFilename.c_str());
         VSIStatBufL sStat;
@@ -909,9 +876,9 @@ bool ZarrV2Array::FlushDirtyTile() const
     }
 
     bool bRet = true;
-    if (m_psCompressor == nullptr)
+    if (psCompressor == nullptr)
     {
-        if (VSIFWriteL(m_abyRawTileData.data(), 1, nRawDataSize, fp) !=
+        if (VSIFWriteL(abyRawTileData.data(), 1, nRawDataSize, fp) !=
             nRawDataSize)
         {
             CPLError(CE_Failure, CPLE_AppDefined,
@@ -939,26 +906,9 @@ bool ZarrV2Array::FlushDirtyTile() const
         {
             void *out_buffer = &abyCompressedData[0];
             size_t out_size = abyCompressedData.size();
-            CPLStringList aosOptions;
-            const auto &compressorConfig = m_oCompressorJSon;
-            for (const auto &obj : compressorConfig.GetChildren())
-            {
-                aosOptions.SetNameValue(obj.GetName().c_str(),
-                                        obj.ToString().c_str());
-            }
-            if (EQUAL(m_psCompressor->pszId, "blosc") &&
-                m_oType.GetClass() == GEDTC_NUMERIC)
-            {
-                aosOptions.SetNameValue(
-                    "TYPESIZE",
-                    CPLSPrintf("%d", GDALGetDataTypeSizeBytes(
-                                         GDALGetNonComplexDataType(
-                                             m_oType.GetNumericDataType()))));
-            }
-
-            if (!m_psCompressor->pfnFunc(
-                    m_abyRawTileData.data(), nRawDataSize, &out_buffer,
-                    &out_size, aosOptions.List(), m_psCompressor->user_data))
+            if (!psCompressor->pfnFunc(
+                    abyRawTileData.data(), nRawDataSize, &out_buffer,
+                    &out_size, papszCompressorOptions, psCompressor->user_data))
             {
                 CPLError(CE_Failure, CPLE_AppDefined,
                          "Compression of tile %s failed", osFilename.c_str());
@@ -981,6 +931,146 @@ bool ZarrV2Array::FlushDirtyTile() const
     return bRet;
 }
 
+/************************************************************************/
+/*                    ZarrV2Array::FlushDirtyTile()                     */
+/************************************************************************/
+
+bool ZarrV2Array::FlushDirtyTile() const
+{
+    if (!m_bDirtyTile)
+        return true;
+    m_bDirtyTile = false;
+
+    std::string osFilename = BuildTileFilename(m_anCachedTiledIndices.data());
+
+    const size_t nSourceSize =
+        m_aoDtypeElts.back().nativeOffset + m_aoDtypeElts.back().nativeSize;
+    const auto &abyTile =
+        m_abyDecodedTileData.empty() ? m_abyRawTileData : m_abyDecodedTileData;
+
+    if (IsEmptyTile(abyTile))
+    {
+        m_bCachedTiledEmpty = true;
+
+        return SubmitTileWrite(
+            osFilename,
+            [osFilename]()
+            {
+                VSIStatBufL sStat;
+                if (VSIStatL(osFilename.c_str(), &sStat) == 0)
+                {
+                    CPLDebugOnly(ZARR_DEBUG_KEY,
+                                 "Deleting tile %s that has now empty content",
+                                 osFilename.c_str());
+                    return VSIUnlink(osFilename.c_str()) == 0;
+                }
+                return true;
+            });
+    }
+
+    if (!m_abyDecodedTileData.empty())
+    {
+        const size_t nDTSize = m_oType.GetSize();
+        const size_t nValues = m_abyDecodedTileData.size() / nDTSize;
+        GByte *pDst = &m_abyRawTileData[0];
+        const GByte *pSrc = m_abyDecodedTileData.data();
+        for (size_t i = 0; i < nValues;
+             i++, pDst += nSourceSize, pSrc += nDTSize)
+        {
+            EncodeElt(m_aoDtypeElts, pSrc, pDst);
+        }
+    }
+
+    if (m_bFortranOrder && !m_aoDims.empty())
+    {
+        BlockTranspose(m_abyRawTileData, m_abyTmpRawTileData, false);
+        std::swap(m_abyRawTileData, m_abyTmpRawTileData);
+    }
+
+    // Gather here everything that is needed to write the tile, so that this
+    // can be done from a worker thread, without accessing objects, such as
+    // CPLJSONObject ones, that are not thread-safe.
+    std::vector<ZarrV2Filter> aoFilters;
+    for (const auto &oFilter : m_oFiltersArray)
+    {
+        ZarrV2Filter oZarrV2Filter;
+        oZarrV2Filter.osId = oFilter["id"].ToString();
+        oZarrV2Filter.psCompressor =
+            CPLGetCompressor(oZarrV2Filter.osId.c_str());
+        CPLAssert(oZarrV2Filter.psCompressor);
+        for (const auto &obj : oFilter.GetChildren())
+        {
+            oZarrV2Filter.aosOptions.SetNameValue(obj.GetName().c_str(),
+                                                  obj.ToString().c_str());
+        }
+        aoFilters.emplace_back(std::move(oZarrV2Filter));
+    }
+
+    CPLStringList aosCompressorOptions;
+    if (m_psCompressor)
+    {
+        const auto &compressorConfig = m_oCompressorJSon;
+        for (const auto &obj : compressorConfig.GetChildren())
+        {
+            aosCompressorOptions.SetNameValue(obj.GetName().c_str(),
+                                              obj.ToString().c_str());
+        }
+        if (EQUAL(m_psCompressor->pszId, "blosc") &&
+            m_oType.GetClass() == GEDTC_NUMERIC)
+        {
+            aosCompressorOptions.SetNameValue(
+                "TYPESIZE",
+                CPLSPrintf("%d", GDALGetDataTypeSizeBytes(
+                                     GDALGetNonComplexDataType(
+                                         m_oType.GetNumericDataType()))));
+        }
+    }
+
+    const bool bCreateDir = m_osDimSeparator == "/";
+    const CPLCompressor *psCompressor = m_psCompressor;
+
+    if (GetTileWriteNumThreads() <= 1)
+    {
+        return SubmitTileWrite(
+            osFilename,
+            [this, &osFilename, &aoFilters, psCompressor,
+             &aosCompressorOptions, bCreateDir]()
+            {
+                return WriteV2Tile(osFilename, m_abyRawTileData,
+                                   m_abyTmpRawTileData, aoFilters,
+                                   psCompressor, aosCompressorOptions.List(),
+                                   bCreateDir);
+            });
+    }
+
+    // Asynchronous write: work on a copy of the tile
+    auto poTiles = std::make_shared<
+        std::pair<ZarrByteVectorQuickResize, ZarrByteVectorQuickResize>>();
+    try
+    {
+        poTiles->first.resize(m_abyRawTileData.size());
+        poTiles->second.resize(m_abyTmpRawTileData.size());
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate memory for tile %s", osFilename.c_str());
+        return false;
+    }
+    memcpy(poTiles->first.data(), m_abyRawTileData.data(),
+           m_abyRawTileData.size());
+
+    return SubmitTileWrite(
+        osFilename,
+        [osFilename, poTiles, aoFilters = std::move(aoFilters), psCompressor,
+         aosCompressorOptions, bCreateDir]()
+        {
+            return WriteV2Tile(osFilename, poTiles->first, poTiles->second,
+                               aoFilters, psCompressor,
+                               aosCompressorOptions.List(), bCreateDir);
+        });
+}
+
 /************************************************************************/
 /*                          BuildTileFilename()                         */
 /************************************************************************/
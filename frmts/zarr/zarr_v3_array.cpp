@@ -31,6 +31,7 @@
 #include "zarr.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstdlib>
 #include <limits>
@@ -94,6 +95,7 @@ void ZarrV3Array::Flush()
         return;
 
     ZarrV3Array::FlushDirtyTile();
+    WaitPendingTileWrites();
 
     if (!m_aoDims.empty())
     {
@@ -159,7 +161,10 @@ void ZarrV3Array::Serialize(const CPLJSONObject &oAttrs)
         CPLJSONObject oConfiguration;
         oChunkGrid.Add("configuration", oConfiguration);
         CPLJSONArray oChunks;
-        for (const auto nBlockSize : m_anBlockSize)
+        // For sharded arrays, the chunks of the grid are the shards
+        const auto &anChunkShape =
+            IsSharded() ? m_anShardSize : m_anBlockSize;
+        for (const auto nBlockSize : anChunkShape)
         {
             oChunks.Add(static_cast<GInt64>(nBlockSize));
         }
@@ -217,7 +222,11 @@ void ZarrV3Array::Serialize(const CPLJSONObject &oAttrs)
         }
     }
 
-    if (m_poCodecs)
+    if (IsSharded())
+    {
+        oRoot.Add("codecs", m_oShardingCodecs);
+    }
+    else if (m_poCodecs)
     {
         oRoot.Add("codecs", m_poCodecs->GetJSon());
     }
@@ -396,6 +405,19 @@ bool ZarrV3Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
 
     std::string osFilename = BuildTileFilename(tileIndices);
 
+    if (IsSharded())
+    {
+        std::vector<ShardChunkRequest> aoRequests(1);
+        aoRequests[0].nInnerIdx = GetInnerChunkIndexInShard(tileIndices);
+        aoRequests[0].pabyData = &abyRawTileData;
+        if (!ReadChunksFromShard(osFilename, aoRequests))
+            return false;
+        bMissingTileOut = aoRequests[0].bMissing;
+        return bMissingTileOut ||
+               DecodeInnerChunk(osFilename, poCodecs, abyRawTileData,
+                                abyDecodedTileData);
+    }
+
     // For network file systems, get the streaming version of the filename,
     // as we don't need arbitrary seeking in the file
     osFilename = VSIFileManager::GetHandler(osFilename.c_str())
@@ -433,25 +455,7 @@ bool ZarrV3Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
     if (bUseMutex)
         m_oMutex.unlock();
 
-    VSILFILE *fp = nullptr;
-    // This is the number of files returned in a S3 directory listing operation
-    constexpr uint64_t MAX_TILES_ALLOWED_FOR_DIRECTORY_LISTING = 1000;
-    const char *const apszOpenOptions[] = {"IGNORE_FILENAME_RESTRICTIONS=YES",
-                                           nullptr};
-    if ((m_osDimSeparator == "/" && !m_anBlockSize.empty() &&
-         m_anBlockSize.back() > MAX_TILES_ALLOWED_FOR_DIRECTORY_LISTING) ||
-        (m_osDimSeparator != "/" &&
-         m_nTotalTileCount > MAX_TILES_ALLOWED_FOR_DIRECTORY_LISTING))
-    {
-        // Avoid issuing ReadDir() when a lot of files are expected
-        CPLConfigOptionSetter optionSetter("GDAL_DISABLE_READDIR_ON_OPEN",
-                                           "YES", true);
-        fp = VSIFOpenEx2L(osFilename.c_str(), "rb", 0, apszOpenOptions);
-    }
-    else
-    {
-        fp = VSIFOpenEx2L(osFilename.c_str(), "rb", 0, apszOpenOptions);
-    }
+    VSILFILE *fp = OpenTileFile(osFilename);
     if (fp == nullptr)
     {
         // Missing files are OK and indicate nodata_value
@@ -534,6 +538,46 @@ bool ZarrV3Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
         return false;
     }
 
+    DecodeRawTileData(abyRawTileData, abyDecodedTileData);
+
+    return true;
+
+#undef m_abyRawTileData
+#undef m_abyDecodedTileData
+#undef m_poCodecs
+}
+
+/************************************************************************/
+/*                      ZarrV3Array::OpenTileFile()                     */
+/************************************************************************/
+
+VSILFILE *ZarrV3Array::OpenTileFile(const std::string &osFilename) const
+{
+    // This is the number of files returned in a S3 directory listing operation
+    constexpr uint64_t MAX_TILES_ALLOWED_FOR_DIRECTORY_LISTING = 1000;
+    const char *const apszOpenOptions[] = {"IGNORE_FILENAME_RESTRICTIONS=YES",
+                                           nullptr};
+    if ((m_osDimSeparator == "/" && !m_anBlockSize.empty() &&
+         m_anBlockSize.back() > MAX_TILES_ALLOWED_FOR_DIRECTORY_LISTING) ||
+        (m_osDimSeparator != "/" &&
+         m_nTotalTileCount > MAX_TILES_ALLOWED_FOR_DIRECTORY_LISTING))
+    {
+        // Avoid issuing ReadDir() when a lot of files are expected
+        CPLConfigOptionSetter optionSetter("GDAL_DISABLE_READDIR_ON_OPEN",
+                                           "YES", true);
+        return VSIFOpenEx2L(osFilename.c_str(), "rb", 0, apszOpenOptions);
+    }
+    return VSIFOpenEx2L(osFilename.c_str(), "rb", 0, apszOpenOptions);
+}
+
+/************************************************************************/
+/*                   ZarrV3Array::DecodeRawTileData()                   */
+/************************************************************************/
+
+void ZarrV3Array::DecodeRawTileData(
+    const ZarrByteVectorQuickResize &abyRawTileData,
+    ZarrByteVectorQuickResize &abyDecodedTileData) const
+{
     if (!abyDecodedTileData.empty())
     {
         const size_t nSourceSize =
@@ -549,12 +593,367 @@ bool ZarrV3Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
             DecodeSourceElt(m_aoDtypeElts, pSrc, pDst);
         }
     }
+}
+
+/************************************************************************/
+/*                      ZarrV3Array::SetSharding()                      */
+/************************************************************************/
+
+void ZarrV3Array::SetSharding(const std::vector<GUInt64> &anShardSize,
+                              const CPLJSONArray &oShardingCodecs,
+                              bool bIndexAtStart, bool bIndexHasCRC32C)
+{
+    m_anShardSize = anShardSize;
+    m_oShardingCodecs = oShardingCodecs;
+    m_bShardIndexAtStart = bIndexAtStart;
+    m_bShardIndexHasCRC32C = bIndexHasCRC32C;
+
+    // The caller has checked that the inner chunk shape divides the shard
+    // shape, and that the number of inner chunks per shard fits on a size_t.
+    m_anInnerChunksPerShard.clear();
+    m_nInnerChunksPerShard = 1;
+    for (size_t i = 0; i < m_anShardSize.size(); ++i)
+    {
+        m_anInnerChunksPerShard.push_back(m_anShardSize[i] / m_anBlockSize[i]);
+        m_nInnerChunksPerShard *=
+            static_cast<size_t>(m_anInnerChunksPerShard.back());
+    }
+
+    // Size the cache of shard indices from a budget in bytes
+    const size_t nIndexSize = m_nInnerChunksPerShard * 2 * sizeof(uint64_t);
+    const GIntBig nCacheSize = CPLAtoGIntBig(
+        CPLGetConfigOption("ZARR_SHARD_INDEX_CACHE_SIZE", "16777216"));
+    const size_t nMaxEntries = static_cast<size_t>(std::max<GIntBig>(
+        1, std::min<GIntBig>(nCacheSize / static_cast<GIntBig>(nIndexSize),
+                             std::numeric_limits<int>::max())));
+    m_poShardIndexCache =
+        std::make_unique<ShardIndexCacheType>(nMaxEntries, 0);
+}
+
+/************************************************************************/
+/*               ZarrV3Array::GetInnerChunkIndexInShard()               */
+/************************************************************************/
+
+// Return the index, in C order, of the inner chunk of indices tileIndices
+// within its shard.
+size_t ZarrV3Array::GetInnerChunkIndexInShard(const uint64_t *tileIndices) const
+{
+    size_t nIdx = 0;
+    for (size_t i = 0; i < m_anInnerChunksPerShard.size(); ++i)
+    {
+        nIdx = nIdx * static_cast<size_t>(m_anInnerChunksPerShard[i]) +
+               static_cast<size_t>(tileIndices[i] % m_anInnerChunksPerShard[i]);
+    }
+    return nIdx;
+}
+
+/************************************************************************/
+/*                            ComputeCRC32C()                           */
+/************************************************************************/
+
+// CRC-32C (Castagnoli), as used by the crc32c codec.
+static uint32_t ComputeCRC32C(const GByte *pabyData, size_t nSize)
+{
+    static const std::array<uint32_t, 256> anTable = []()
+    {
+        std::array<uint32_t, 256> anRet;
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t nCRC = i;
+            for (int j = 0; j < 8; ++j)
+                nCRC = (nCRC >> 1) ^ ((nCRC & 1) ? 0x82F63B78U : 0);
+            anRet[i] = nCRC;
+        }
+        return anRet;
+    }();
+
+    uint32_t nCRC = 0xFFFFFFFFU;
+    for (size_t i = 0; i < nSize; ++i)
+        nCRC = anTable[(nCRC ^ pabyData[i]) & 0xFF] ^ (nCRC >> 8);
+    return nCRC ^ 0xFFFFFFFFU;
+}
+
+/************************************************************************/
+/*                     ZarrV3Array::GetShardIndex()                     */
+/************************************************************************/
+
+// Return the decoded index of a shard, from the cache if possible, an empty
+// vector if the shard does not exist, or nullptr in case of error.
+// This method may be called concurrently from several threads.
+std::shared_ptr<const std::vector<uint64_t>>
+ZarrV3Array::GetShardIndex(const std::string &osShardFilename) const
+{
+    std::shared_ptr<const std::vector<uint64_t>> poIndex;
+    if (m_poShardIndexCache->tryGet(osShardFilename, poIndex))
+        return poIndex;
+
+    VSILFILE *fp = OpenTileFile(osShardFilename);
+    if (fp == nullptr)
+    {
+        // Missing shards are OK and indicate nodata_value
+        CPLDebugOnly(ZARR_DEBUG_KEY, "Shard %s missing (=nodata)",
+                     osShardFilename.c_str());
+        poIndex = std::make_shared<const std::vector<uint64_t>>();
+        m_poShardIndexCache->insert(osShardFilename, poIndex);
+        return poIndex;
+    }
+
+    const size_t nIndexDataSize =
+        m_nInnerChunksPerShard * 2 * sizeof(uint64_t);
+    const size_t nIndexSize =
+        nIndexDataSize + (m_bShardIndexHasCRC32C ? sizeof(uint32_t) : 0);
+    vsi_l_offset nIndexOffset = 0;
+    if (!m_bShardIndexAtStart)
+    {
+        VSIFSeekL(fp, 0, SEEK_END);
+        const auto nFileSize = VSIFTellL(fp);
+        if (nFileSize < nIndexSize)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "Shard %s is too small",
+                     osShardFilename.c_str());
+            VSIFCloseL(fp);
+            return nullptr;
+        }
+        nIndexOffset = nFileSize - nIndexSize;
+    }
+
+    std::vector<GByte> abyIndex;
+    try
+    {
+        abyIndex.resize(nIndexSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate memory for index of shard %s",
+                 osShardFilename.c_str());
+        VSIFCloseL(fp);
+        return nullptr;
+    }
+    const bool bOK =
+        VSIFSeekL(fp, nIndexOffset, SEEK_SET) == 0 &&
+        VSIFReadL(abyIndex.data(), 1, nIndexSize, fp) == nIndexSize;
+    VSIFCloseL(fp);
+    if (!bOK)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot read index of shard %s",
+                 osShardFilename.c_str());
+        return nullptr;
+    }
+
+    if (m_bShardIndexHasCRC32C)
+    {
+        uint32_t nExpectedCRC = 0;
+        memcpy(&nExpectedCRC, abyIndex.data() + nIndexDataSize,
+               sizeof(nExpectedCRC));
+        CPL_LSBPTR32(&nExpectedCRC);
+        if (ComputeCRC32C(abyIndex.data(), nIndexDataSize) != nExpectedCRC)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Invalid CRC32C checksum for index of shard %s",
+                     osShardFilename.c_str());
+            return nullptr;
+        }
+    }
+
+    auto poNewIndex =
+        std::make_shared<std::vector<uint64_t>>(2 * m_nInnerChunksPerShard);
+    memcpy(poNewIndex->data(), abyIndex.data(), nIndexDataSize);
+#if !CPL_IS_LSB
+    for (auto &nVal : *poNewIndex)
+        CPL_SWAP64PTR(&nVal);
+#endif
+    poIndex = std::move(poNewIndex);
+    m_poShardIndexCache->insert(osShardFilename, poIndex);
+    return poIndex;
+}
+
+/************************************************************************/
+/*                  ZarrV3Array::ReadChunksFromShard()                  */
+/************************************************************************/
+
+// Read the encoded content of the requested inner chunks of a shard.
+// Adjacent chunks are read with a single range request, and all ranges are
+// read with a single VSIFReadMultiRangeL() call.
+// This method may be called concurrently from several threads.
+bool ZarrV3Array::ReadChunksFromShard(
+    const std::string &osShardFilename,
+    std::vector<ShardChunkRequest> &aoRequests) const
+{
+    const auto poIndex = GetShardIndex(osShardFilename);
+    if (!poIndex)
+        return false;
+
+    constexpr uint64_t MISSING_CHUNK = std::numeric_limits<uint64_t>::max();
+    std::vector<std::pair<uint64_t, size_t>> anOffsetAndRequestIdx;
+    for (size_t i = 0; i < aoRequests.size(); ++i)
+    {
+        auto &oRequest = aoRequests[i];
+        oRequest.bMissing = true;
+        if (poIndex->empty())
+            continue;
+
+        CPLAssert(oRequest.nInnerIdx < m_nInnerChunksPerShard);
+        const uint64_t nOffset = (*poIndex)[2 * oRequest.nInnerIdx];
+        const uint64_t nSize = (*poIndex)[2 * oRequest.nInnerIdx + 1];
+        if (nOffset == MISSING_CHUNK && nSize == MISSING_CHUNK)
+            continue;
+        if (nSize > static_cast<uint64_t>(std::numeric_limits<int>::max()) ||
+            nOffset > MISSING_CHUNK - nSize)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Invalid index entry for inner chunk %u of shard %s",
+                     static_cast<unsigned>(oRequest.nInnerIdx),
+                     osShardFilename.c_str());
+            return false;
+        }
+        try
+        {
+            oRequest.pabyData->resize(static_cast<size_t>(nSize));
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate memory for inner chunk of shard %s",
+                     osShardFilename.c_str());
+            return false;
+        }
+        oRequest.bMissing = false;
+        if (nSize > 0)
+            anOffsetAndRequestIdx.emplace_back(nOffset, i);
+    }
+    if (anOffsetAndRequestIdx.empty())
+        return true;
+    std::sort(anOffsetAndRequestIdx.begin(), anOffsetAndRequestIdx.end());
+
+    // Coalesce adjacent chunks into ranges
+    struct CoalescedRange
+    {
+        vsi_l_offset nOffset = 0;
+        size_t nSize = 0;
+        size_t iFirst = 0;  // first and last index in anOffsetAndRequestIdx
+        size_t iLast = 0;
+        std::vector<GByte> abyMerged{};
+    };
+    std::vector<CoalescedRange> aoRanges;
+    for (size_t i = 0; i < anOffsetAndRequestIdx.size(); ++i)
+    {
+        const auto nOffset = anOffsetAndRequestIdx[i].first;
+        const size_t nSize =
+            aoRequests[anOffsetAndRequestIdx[i].second].pabyData->size();
+        if (!aoRanges.empty() &&
+            aoRanges.back().nOffset + aoRanges.back().nSize == nOffset &&
+            aoRanges.back().nSize <=
+                static_cast<size_t>(std::numeric_limits<int>::max()) - nSize)
+        {
+            aoRanges.back().nSize += nSize;
+            aoRanges.back().iLast = i;
+        }
+        else
+        {
+            CoalescedRange oRange;
+            oRange.nOffset = nOffset;
+            oRange.nSize = nSize;
+            oRange.iFirst = i;
+            oRange.iLast = i;
+            aoRanges.emplace_back(std::move(oRange));
+        }
+    }
+
+    std::vector<void *> apData;
+    std::vector<vsi_l_offset> anOffsets;
+    std::vector<size_t> anSizes;
+    for (auto &oRange : aoRanges)
+    {
+        if (oRange.iFirst == oRange.iLast)
+        {
+            apData.push_back(
+                aoRequests[anOffsetAndRequestIdx[oRange.iFirst].second]
+                    .pabyData->data());
+        }
+        else
+        {
+            try
+            {
+                oRange.abyMerged.resize(oRange.nSize);
+            }
+            catch (const std::exception &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Cannot allocate memory for inner chunks of shard %s",
+                         osShardFilename.c_str());
+                return false;
+            }
+            apData.push_back(oRange.abyMerged.data());
+        }
+        anOffsets.push_back(oRange.nOffset);
+        anSizes.push_back(oRange.nSize);
+    }
+
+    VSILFILE *fp = OpenTileFile(osShardFilename);
+    if (fp == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot open shard %s",
+                 osShardFilename.c_str());
+        return false;
+    }
+    const int nRet =
+        VSIFReadMultiRangeL(static_cast<int>(apData.size()), apData.data(),
+                            anOffsets.data(), anSizes.data(), fp);
+    VSIFCloseL(fp);
+    if (nRet != 0)
+    {
+        CPLError(CE_Failure, CPLE_FileIO,
+                 "Could not read inner chunks of shard %s correctly",
+                 osShardFilename.c_str());
+        return false;
+    }
+
+    // Dispatch merged ranges into their chunks
+    for (const auto &oRange : aoRanges)
+    {
+        if (oRange.iFirst == oRange.iLast)
+            continue;
+        const GByte *pabySrc = oRange.abyMerged.data();
+        for (size_t i = oRange.iFirst; i <= oRange.iLast; ++i)
+        {
+            auto pabyData = aoRequests[anOffsetAndRequestIdx[i].second].pabyData;
+            memcpy(pabyData->data(), pabySrc, pabyData->size());
+            pabySrc += pabyData->size();
+        }
+    }
 
     return true;
+}
 
-#undef m_abyRawTileData
-#undef m_abyDecodedTileData
-#undef m_poCodecs
+/************************************************************************/
+/*                    ZarrV3Array::DecodeInnerChunk()                   */
+/************************************************************************/
+
+bool ZarrV3Array::DecodeInnerChunk(
+    const std::string &osShardFilename, ZarrV3CodecSequence *poCodecs,
+    ZarrByteVectorQuickResize &abyRawTileData,
+    ZarrByteVectorQuickResize &abyDecodedTileData) const
+{
+    if (poCodecs && !poCodecs->Decode(abyRawTileData))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Decompression of inner chunk of shard %s failed",
+                 osShardFilename.c_str());
+        return false;
+    }
+    if (abyRawTileData.size() != m_nTileSize)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Decompressed inner chunk of shard %s has not expected size. "
+                 "Got %u instead of %u",
+                 osShardFilename.c_str(),
+                 static_cast<unsigned>(abyRawTileData.size()),
+                 static_cast<unsigned>(m_nTileSize));
+        return false;
+    }
+    DecodeRawTileData(abyRawTileData, abyDecodedTileData);
+    return true;
 }
 
 /************************************************************************/
@@ -578,8 +977,59 @@ bool ZarrV3Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
         return true;
     }
 
+    return LoadTilesInParallel(anReqTilesIndices, nReqTiles, nThreadsMax);
+}
+
+/************************************************************************/
+/*                  ZarrV3Array::LoadTilesInParallel()                  */
+/************************************************************************/
+
+bool ZarrV3Array::LoadTilesInParallel(
+    const std::vector<uint64_t> &anReqTilesIndices, size_t nReqTiles,
+    int nThreadsMax) const
+{
+    const size_t nDims = GetDimensionCount();
+
+    // For sharded arrays, order the requested inner chunks by shard, so that
+    // each job reads all the inner chunks it needs from a shard at once.
+    // anGroupStart contains the index of the first tile of each group of
+    // tiles that must be processed by the same job.
+    std::vector<uint64_t> anShardOrderedTilesIndices;
+    std::vector<size_t> anGroupStart;
+    const std::vector<uint64_t> *panReqTilesIndices = &anReqTilesIndices;
+    if (IsSharded())
+    {
+        std::vector<std::pair<std::string, size_t>> aoShardAndTileIdx;
+        for (size_t i = 0; i < nReqTiles; ++i)
+        {
+            aoShardAndTileIdx.emplace_back(
+                BuildTileFilename(anReqTilesIndices.data() + i * nDims), i);
+        }
+        std::sort(aoShardAndTileIdx.begin(), aoShardAndTileIdx.end());
+        for (size_t i = 0; i < nReqTiles; ++i)
+        {
+            if (i == 0 ||
+                aoShardAndTileIdx[i].first != aoShardAndTileIdx[i - 1].first)
+            {
+                anGroupStart.push_back(i);
+            }
+            const uint64_t *tileIndices =
+                anReqTilesIndices.data() + aoShardAndTileIdx[i].second * nDims;
+            anShardOrderedTilesIndices.insert(anShardOrderedTilesIndices.end(),
+                                              tileIndices, tileIndices + nDims);
+        }
+        panReqTilesIndices = &anShardOrderedTilesIndices;
+    }
+    else
+    {
+        for (size_t i = 0; i < nReqTiles; ++i)
+            anGroupStart.push_back(i);
+    }
+    const size_t nGroups = anGroupStart.size();
+    anGroupStart.push_back(nReqTiles);
+
     const int nThreads =
-        static_cast<int>(std::min(static_cast<size_t>(nThreadsMax), nReqTiles));
+        static_cast<int>(std::min(static_cast<size_t>(nThreadsMax), nGroups));
 
     CPLWorkerThreadPool *wtp = GDALGetGlobalThreadPool(nThreadsMax);
     if (wtp == nullptr)
@@ -608,7 +1058,7 @@ bool ZarrV3Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
     int nRemainingThreads = nThreads;
     // Check for very highly overflow in below loop
     assert(static_cast<size_t>(nThreads) <
-           std::numeric_limits<size_t>::max() / nReqTiles);
+           std::numeric_limits<size_t>::max() / nGroups);
 
     // Setup jobs
     for (int i = 0; i < nThreads; i++)
@@ -617,10 +1067,11 @@ bool ZarrV3Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
         jobStruct.poArray = this;
         jobStruct.pbGlobalStatus = &bGlobalStatus;
         jobStruct.pnRemainingThreads = &nRemainingThreads;
-        jobStruct.panReqTilesIndices = &anReqTilesIndices;
-        jobStruct.nFirstIdx = static_cast<size_t>(i * nReqTiles / nThreads);
-        jobStruct.nLastIdxNotIncluded = std::min(
-            static_cast<size_t>((i + 1) * nReqTiles / nThreads), nReqTiles);
+        jobStruct.panReqTilesIndices = panReqTilesIndices;
+        jobStruct.nFirstIdx =
+            anGroupStart[static_cast<size_t>(i * nGroups / nThreads)];
+        jobStruct.nLastIdxNotIncluded = anGroupStart[std::min(
+            static_cast<size_t>((i + 1) * nGroups / nThreads), nGroups)];
         asJobStructs.emplace_back(std::move(jobStruct));
     }
 
@@ -630,7 +1081,6 @@ bool ZarrV3Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
             static_cast<const JobStruct *>(pThreadData);
 
         const auto poArray = jobStruct->poArray;
-        const auto &aoDims = poArray->GetDimensions();
         const size_t l_nDims = poArray->GetDimensionCount();
         ZarrByteVectorQuickResize abyRawTileData;
         ZarrByteVectorQuickResize abyDecodedTileData;
@@ -641,6 +1091,18 @@ bool ZarrV3Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
             poCodecs = poArray->m_poCodecs->Clone();
         }
 
+        if (poArray->IsSharded())
+        {
+            poArray->LoadTilesFromShards(jobStruct->panReqTilesIndices->data(),
+                                         jobStruct->nFirstIdx,
+                                         jobStruct->nLastIdxNotIncluded,
+                                         poCodecs.get(),
+                                         *jobStruct->pbGlobalStatus);
+            std::lock_guard<std::mutex> oLock(poArray->m_oMutex);
+            (*jobStruct->pnRemainingThreads)--;
+            return;
+        }
+
         for (size_t iReq = jobStruct->nFirstIdx;
              iReq < jobStruct->nLastIdxNotIncluded; ++iReq)
         {
@@ -654,13 +1116,8 @@ bool ZarrV3Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
             const uint64_t *tileIndices =
                 jobStruct->panReqTilesIndices->data() + iReq * l_nDims;
 
-            uint64_t nTileIdx = 0;
-            for (size_t j = 0; j < l_nDims; ++j)
-            {
-                if (j > 0)
-                    nTileIdx *= aoDims[j - 1]->GetSize();
-                nTileIdx += tileIndices[j];
-            }
+            const uint64_t nTileIdx =
+                poArray->GetTileLinearIndex(tileIndices);
 
             if (!poArray->AllocateWorkingBuffers(abyRawTileData,
                                                  abyDecodedTileData))
@@ -691,8 +1148,7 @@ bool ZarrV3Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
                 else
                     std::swap(cachedTile.abyDecoded, abyRawTileData);
             }
-            poArray->m_oMapTileIndexToCachedTile[nTileIdx] =
-                std::move(cachedTile);
+            poArray->CacheTile(nTileIdx, std::move(cachedTile));
         }
 
         std::lock_guard<std::mutex> oLock(poArray->m_oMutex);
@@ -726,61 +1182,113 @@ bool ZarrV3Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
 }
 
 /************************************************************************/
-/*                    ZarrV3Array::FlushDirtyTile()                     */
+/*                  ZarrV3Array::LoadTilesFromShards()                  */
 /************************************************************************/
 
-bool ZarrV3Array::FlushDirtyTile() const
+// Decode the tiles of indices [nFirstIdx, nLastIdxNotIncluded[ in
+// panTilesIndices, that must be ordered by shard, and insert them in
+// m_oMapTileIndexToCachedTile. The inner chunks of a shard are fetched with
+// a single ReadChunksFromShard() call.
+// This method may be called concurrently from several threads.
+void ZarrV3Array::LoadTilesFromShards(const uint64_t *panTilesIndices,
+                                      size_t nFirstIdx,
+                                      size_t nLastIdxNotIncluded,
+                                      ZarrV3CodecSequence *poCodecs,
+                                      bool &bGlobalStatus) const
 {
-    if (!m_bDirtyTile)
-        return true;
-    m_bDirtyTile = false;
+    const size_t nDims = GetDimensionCount();
+    ZarrByteVectorQuickResize abyRawTileData;
+    ZarrByteVectorQuickResize abyDecodedTileData;
 
-    std::string osFilename = BuildTileFilename(m_anCachedTiledIndices.data());
-
-    const size_t nSourceSize =
-        m_aoDtypeElts.back().nativeOffset + m_aoDtypeElts.back().nativeSize;
-    const auto &abyTile =
-        m_abyDecodedTileData.empty() ? m_abyRawTileData : m_abyDecodedTileData;
-
-    if (IsEmptyTile(abyTile))
+    size_t iReq = nFirstIdx;
+    while (iReq < nLastIdxNotIncluded)
     {
-        m_bCachedTiledEmpty = true;
+        // Check if we must early exit
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            if (!bGlobalStatus)
+                return;
+        }
 
-        VSIStatBufL sStat;
-        if (VSIStatL(osFilename.c_str(), &sStat) == 0)
+        // Collect the inner chunks of the current shard
+        const std::string osShardFilename =
+            BuildTileFilename(panTilesIndices + iReq * nDims);
+        size_t iEnd = iReq + 1;
+        while (iEnd < nLastIdxNotIncluded &&
+               BuildTileFilename(panTilesIndices + iEnd * nDims) ==
+                   osShardFilename)
         {
-            CPLDebugOnly(ZARR_DEBUG_KEY,
-                         "Deleting tile %s that has now empty content",
-                         osFilename.c_str());
-            return VSIUnlink(osFilename.c_str()) == 0;
+            ++iEnd;
         }
-        return true;
-    }
 
-    if (!m_abyDecodedTileData.empty())
-    {
-        const size_t nDTSize = m_oType.GetSize();
-        const size_t nValues = m_abyDecodedTileData.size() / nDTSize;
-        GByte *pDst = &m_abyRawTileData[0];
-        const GByte *pSrc = m_abyDecodedTileData.data();
-        for (size_t i = 0; i < nValues;
-             i++, pDst += nSourceSize, pSrc += nDTSize)
+        std::vector<ZarrByteVectorQuickResize> aabyEncodedChunks(iEnd - iReq);
+        std::vector<ShardChunkRequest> aoRequests(iEnd - iReq);
+        for (size_t i = 0; i < aoRequests.size(); ++i)
         {
-            EncodeElt(m_aoDtypeElts, pSrc, pDst);
+            aoRequests[i].nInnerIdx = GetInnerChunkIndexInShard(
+                panTilesIndices + (iReq + i) * nDims);
+            aoRequests[i].pabyData = &aabyEncodedChunks[i];
         }
+        if (!ReadChunksFromShard(osShardFilename, aoRequests))
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            bGlobalStatus = false;
+            return;
+        }
+
+        for (size_t i = 0; i < aoRequests.size(); ++i)
+        {
+            CachedTile cachedTile;
+            if (!aoRequests[i].bMissing)
+            {
+                if (!AllocateWorkingBuffers(abyRawTileData,
+                                            abyDecodedTileData))
+                {
+                    std::lock_guard<std::mutex> oLock(m_oMutex);
+                    bGlobalStatus = false;
+                    return;
+                }
+                std::swap(abyRawTileData, aabyEncodedChunks[i]);
+                if (!DecodeInnerChunk(osShardFilename, poCodecs,
+                                      abyRawTileData, abyDecodedTileData))
+                {
+                    std::lock_guard<std::mutex> oLock(m_oMutex);
+                    bGlobalStatus = false;
+                    return;
+                }
+                if (!abyDecodedTileData.empty())
+                    std::swap(cachedTile.abyDecoded, abyDecodedTileData);
+                else
+                    std::swap(cachedTile.abyDecoded, abyRawTileData);
+            }
+
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            CacheTile(
+                GetTileLinearIndex(panTilesIndices + (iReq + i) * nDims),
+                std::move(cachedTile));
+        }
+
+        iReq = iEnd;
     }
+}
 
-    const size_t nSizeBefore = m_abyRawTileData.size();
-    if (m_poCodecs)
+/************************************************************************/
+/*                            WriteV3Tile()                             */
+/************************************************************************/
+
+// Apply codecs to abyRawTileData (modified in place), and write the result
+// into osFilename.
+static bool WriteV3Tile(const std::string &osFilename,
+                        ZarrByteVectorQuickResize &abyRawTileData,
+                        ZarrV3CodecSequence *poCodecs, bool bCreateDir)
+{
+    if (poCodecs)
     {
-        if (!m_poCodecs->Encode(m_abyRawTileData))
-        {
-            m_abyRawTileData.resize(nSizeBefore);
+        if (!poCodecs->Encode(abyRawTileData))
             return false;
-        }
     }
 
-    if (m_osDimSeparator == "/")
+    if (bCreateDir)
     {
         std::string osDir = CPLGetDirname(osFilename.c_str());
         VSIStatBufL sStat;
@@ -790,7 +1298,6 @@ bool ZarrV3Array::FlushDirtyTile() const
             {
                 CPLError(CE_Failure, CPLE_AppDefined,
                          "Cannot create directory %s", osDir.c_str());
-                m_abyRawTileData.resize(nSizeBefore);
                 return false;
             }
         }
@@ -801,13 +1308,12 @@ bool ZarrV3Array::FlushDirtyTile() const
     {
         CPLError(CE_Failure, CPLE_AppDefined, "Cannot create tile %s",
                  osFilename.c_str());
-        m_abyRawTileData.resize(nSizeBefore);
         return false;
     }
 
     bool bRet = true;
-    const size_t nRawDataSize = m_abyRawTileData.size();
-    if (VSIFWriteL(m_abyRawTileData.data(), 1, nRawDataSize, fp) !=
+    const size_t nRawDataSize = abyRawTileData.size();
+    if (VSIFWriteL(abyRawTileData.data(), 1, nRawDataSize, fp) !=
         nRawDataSize)
     {
         CPLError(CE_Failure, CPLE_AppDefined,
@@ -816,16 +1322,145 @@ bool ZarrV3Array::FlushDirtyTile() const
     }
     VSIFCloseL(fp);
 
-    m_abyRawTileData.resize(nSizeBefore);
-
     return bRet;
 }
 
+/************************************************************************/
+/*                    ZarrV3Array::FlushDirtyTile()                     */
+/************************************************************************/
+
+bool ZarrV3Array::FlushDirtyTile() const
+{
+    if (!m_bDirtyTile)
+        return true;
+    m_bDirtyTile = false;
+
+    std::string osFilename = BuildTileFilename(m_anCachedTiledIndices.data());
+
+    const size_t nSourceSize =
+        m_aoDtypeElts.back().nativeOffset + m_aoDtypeElts.back().nativeSize;
+    const auto &abyTile =
+        m_abyDecodedTileData.empty() ? m_abyRawTileData : m_abyDecodedTileData;
+
+    if (IsEmptyTile(abyTile))
+    {
+        m_bCachedTiledEmpty = true;
+
+        return SubmitTileWrite(
+            osFilename,
+            [osFilename]()
+            {
+                VSIStatBufL sStat;
+                if (VSIStatL(osFilename.c_str(), &sStat) == 0)
+                {
+                    CPLDebugOnly(ZARR_DEBUG_KEY,
+                                 "Deleting tile %s that has now empty content",
+                                 osFilename.c_str());
+                    return VSIUnlink(osFilename.c_str()) == 0;
+                }
+                return true;
+            });
+    }
+
+    if (!m_abyDecodedTileData.empty())
+    {
+        const size_t nDTSize = m_oType.GetSize();
+        const size_t nValues = m_abyDecodedTileData.size() / nDTSize;
+        GByte *pDst = &m_abyRawTileData[0];
+        const GByte *pSrc = m_abyDecodedTileData.data();
+        for (size_t i = 0; i < nValues;
+             i++, pDst += nSourceSize, pSrc += nDTSize)
+        {
+            EncodeElt(m_aoDtypeElts, pSrc, pDst);
+        }
+    }
+
+    const bool bCreateDir = m_osDimSeparator == "/";
+
+    if (GetTileWriteNumThreads() <= 1)
+    {
+        const size_t nSizeBefore = m_abyRawTileData.size();
+        const bool bRet = SubmitTileWrite(
+            osFilename,
+            [this, &osFilename, bCreateDir]()
+            {
+                return WriteV3Tile(osFilename, m_abyRawTileData,
+                                   m_poCodecs.get(), bCreateDir);
+            });
+        m_abyRawTileData.resize(nSizeBefore);
+        return bRet;
+    }
+
+    // Asynchronous write: work on a copy of the tile, with a copy of the
+    // codecs that may then be used from a worker thread.
+    auto poTile = std::make_shared<ZarrByteVectorQuickResize>();
+    try
+    {
+        poTile->resize(m_abyRawTileData.size());
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate memory for tile %s", osFilename.c_str());
+        return false;
+    }
+    memcpy(poTile->data(), m_abyRawTileData.data(), m_abyRawTileData.size());
+    std::shared_ptr<ZarrV3CodecSequence> poCodecs(
+        m_poCodecs ? m_poCodecs->Clone() : nullptr);
+
+    return SubmitTileWrite(osFilename,
+                           [osFilename, poTile, poCodecs, bCreateDir]()
+                           {
+                               return WriteV3Tile(osFilename, *poTile,
+                                                  poCodecs.get(), bCreateDir);
+                           });
+}
+
+/************************************************************************/
+/*                        ZarrV3Array::IWrite()                         */
+/************************************************************************/
+
+bool ZarrV3Array::IWrite(const GUInt64 *arrayStartIdx, const size_t *count,
+                         const GInt64 *arrayStep,
+                         const GPtrDiff_t *bufferStride,
+                         const GDALExtendedDataType &bufferDataType,
+                         const void *pSrcBuffer)
+{
+    if (IsSharded())
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Writing into an array using the sharding_indexed codec is "
+                 "not supported");
+        return false;
+    }
+    return ZarrArray::IWrite(arrayStartIdx, count, arrayStep, bufferStride,
+                             bufferDataType, pSrcBuffer);
+}
+
 /************************************************************************/
 /*                          BuildTileFilename()                         */
 /************************************************************************/
 
 std::string ZarrV3Array::BuildTileFilename(const uint64_t *tileIndices) const
+{
+    if (IsSharded())
+    {
+        // The file is the shard containing the inner chunk
+        std::vector<uint64_t> anShardIndices;
+        for (size_t i = 0; i < m_aoDims.size(); ++i)
+            anShardIndices.push_back(tileIndices[i] /
+                                     m_anInnerChunksPerShard[i]);
+        return BuildFilename(anShardIndices.data());
+    }
+    return BuildFilename(tileIndices);
+}
+
+/************************************************************************/
+/*                            BuildFilename()                           */
+/************************************************************************/
+
+// Build the filename of the chunk (or shard) of indices anIndices
+std::string ZarrV3Array::BuildFilename(const uint64_t *anIndices) const
 {
     if (m_aoDims.empty())
     {
@@ -844,7 +1479,7 @@ std::string ZarrV3Array::BuildTileFilename(const uint64_t *tileIndices) const
         {
             if (i > 0 || !m_bV2ChunkKeyEncoding)
                 osFilename += m_osDimSeparator;
-            osFilename += std::to_string(tileIndices[i]);
+            osFilename += std::to_string(anIndices[i]);
         }
         return osFilename;
     }
@@ -1553,8 +2188,95 @@ ZarrV3Group::LoadArray(const std::string &osArrayName,
     }
 
     const auto oCodecs = oRoot["codecs"].ToArray();
+
+    // With the sharding_indexed codec, the chunks of the chunk grid are
+    // shards, and the tiles of the array are their inner chunks.
+    std::vector<GUInt64> anShardSize;
+    bool bShardIndexAtStart = false;
+    bool bShardIndexHasCRC32C = false;
+    CPLJSONArray oInnerCodecs = oCodecs;
+    if (oCodecs.Size() > 0 &&
+        oCodecs[0]["name"].ToString() == "sharding_indexed")
+    {
+        if (oCodecs.Size() != 1)
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "Codecs after sharding_indexed are not supported");
+            return nullptr;
+        }
+        const auto oConfig = oCodecs[0]["configuration"];
+        std::swap(anShardSize, anBlockSize);
+        if (!ZarrArray::ParseChunkSize(oConfig["chunk_shape"].ToArray(),
+                                       oType, anBlockSize))
+            return nullptr;
+        if (anBlockSize.size() != anShardSize.size())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "sharding_indexed: chunk_shape has not the same number "
+                     "of dimensions as the shard shape");
+            return nullptr;
+        }
+        size_t nInnerChunksPerShard = 1;
+        for (size_t i = 0; i < anBlockSize.size(); ++i)
+        {
+            if ((anShardSize[i] % anBlockSize[i]) != 0)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "sharding_indexed: chunk_shape should divide the "
+                         "shard shape");
+                return nullptr;
+            }
+            const auto nCount = anShardSize[i] / anBlockSize[i];
+            if (nCount > std::numeric_limits<size_t>::max() /
+                             (2 * sizeof(uint64_t) * nInnerChunksPerShard))
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "sharding_indexed: too many inner chunks per shard");
+                return nullptr;
+            }
+            nInnerChunksPerShard *= static_cast<size_t>(nCount);
+        }
+
+        const auto osIndexLocation = oConfig.GetString("index_location", "end");
+        if (osIndexLocation == "start")
+            bShardIndexAtStart = true;
+        else if (osIndexLocation != "end")
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "sharding_indexed: unsupported index_location = %s",
+                     osIndexLocation.c_str());
+            return nullptr;
+        }
+
+        // Only little-endian uint64 indices, optionally followed by a
+        // CRC32C checksum, are supported
+        for (const auto &oIndexCodec : oConfig["index_codecs"].ToArray())
+        {
+            const auto osName = oIndexCodec["name"].ToString();
+            if (osName == "crc32c" && !bShardIndexHasCRC32C)
+            {
+                bShardIndexHasCRC32C = true;
+            }
+            else if ((osName == "bytes" || osName == "endian") &&
+                     !bShardIndexHasCRC32C &&
+                     oIndexCodec["configuration"].GetString(
+                         "endian", "little") == "little")
+            {
+                // nothing to do
+            }
+            else
+            {
+                CPLError(CE_Failure, CPLE_NotSupported,
+                         "sharding_indexed: unsupported index_codecs");
+                return nullptr;
+            }
+        }
+
+        oInnerCodecs = oConfig["codecs"].ToArray();
+    }
+
     std::unique_ptr<ZarrV3CodecSequence> poCodecs;
-    if (oCodecs.Size() > 0)
+    if (oInnerCodecs.Size() > 0)
     {
         // Byte swapping will be done by the codec chain
         aoDtypeElts.back().needByteSwapping = false;
@@ -1565,7 +2287,7 @@ ZarrV3Group::LoadArray(const std::string &osArrayName,
                 static_cast<size_t>(nSize));
         oInputArrayMetadata.oElt = aoDtypeElts.back();
         poCodecs = std::make_unique<ZarrV3CodecSequence>(oInputArrayMetadata);
-        if (!poCodecs->InitFromJson(oCodecs))
+        if (!poCodecs->InitFromJson(oInnerCodecs))
             return nullptr;
     }
 
@@ -1587,6 +2309,11 @@ ZarrV3Group::LoadArray(const std::string &osArrayName,
     poArray->SetDtype(oDtype);
     if (poCodecs)
         poArray->SetCodecs(std::move(poCodecs));
+    if (!anShardSize.empty())
+    {
+        poArray->SetSharding(anShardSize, oCodecs, bShardIndexAtStart,
+                             bShardIndexHasCRC32C);
+    }
     RegisterArray(poArray);
 
     // If this is an indexing variable, attach it to the dimension.
@@ -1599,7 +2326,10 @@ ZarrV3Group::LoadArray(const std::string &osArrayName,
         }
     }
 
-    if (CPLTestBool(m_poSharedResource->GetOpenOptions().FetchNameValueDef(
+    // Tile presence is not available from file listing for sharded arrays,
+    // as files are shards
+    if (!poArray->IsSharded() &&
+        CPLTestBool(m_poSharedResource->GetOpenOptions().FetchNameValueDef(
             "CACHE_TILE_PRESENCE", "NO")))
     {
         poArray->CacheTilePresence();
@@ -350,6 +350,9 @@ typedef struct GDALMDArrayHS *GDALMDArrayH;
 typedef struct GDALAttributeHS *GDALAttributeH;
 /** Opaque type for C++ GDALDimension */
 typedef struct GDALDimensionHS *GDALDimensionH;
+/** Opaque type for C++ GDALPinnedBlock
+ * @since GDAL 3.9 */
+typedef struct GDALPinnedBlockHS *GDALPinnedBlockH;
 
 /* ==================================================================== */
 /*      Registration/driver related.                                    */
@@ -378,6 +381,22 @@ typedef struct GDALDimensionHS *GDALDimensionH;
  */
 #define GDAL_DMD_EXTENSIONS "DMD_EXTENSIONS"
 
+/** List of (space separated) signatures, one of which a dataset must match
+ * for the Identify() method of the driver to return TRUE.
+ *
+ * Each signature is one of:
+ * <ul>
+ * <li>magic:OFFSET:HEXBYTES: header bytes at the given offset</li>
+ * <li>ext:EXTENSION: file extension (case insensitive)</li>
+ * <li>prefix:PREFIX: file name prefix (case insensitive)</li>
+ * </ul>
+ *
+ * When a driver declares this item, GDALOpenEx() skips it for datasets that
+ * match none of its signatures, without calling Identify().
+ * @since GDAL 3.9
+ */
+#define GDAL_DMD_IDENTIFY_SIGNATURES "DMD_IDENTIFY_SIGNATURES"
+
 /** XML snippet with creation options. */
 #define GDAL_DMD_CREATIONOPTIONLIST "DMD_CREATIONOPTIONLIST"
 
@@ -1019,6 +1038,14 @@ GDALDatasetH CPL_DLL CPL_STDCALL GDALOpenShared(const char *, GDALAccess)
 #define GDAL_OF_FROM_GDALOPEN 0x400
 #endif
 
+/** Open in thread-safe mode. Only compatible with read-only raster datasets.
+ * The returned dataset may be used concurrently by several threads.
+ * Not compatible with GDAL_OF_SHARED.
+ * Used by GDALOpenEx().
+ * @since GDAL 3.9
+ */
+#define GDAL_OF_THREAD_SAFE 0x800
+
 GDALDatasetH CPL_DLL CPL_STDCALL GDALOpenEx(
     const char *pszFilename, unsigned int nOpenFlags,
     const char *const *papszAllowedDrivers, const char *const *papszOpenOptions,
@@ -1170,6 +1197,17 @@ CPLErr CPL_DLL GDALDatasetReadCompressedData(
     int nYSize, int nBandCount, const int *panBandList, void **ppBuffer,
     size_t *pnBufferSize, char **ppszDetailedFormat);
 
+CPLErr CPL_DLL GDALDatasetSetCacheBudget(GDALDatasetH hDS, GIntBig nMaxBytes,
+                                         int nPriority);
+void CPL_DLL GDALDatasetGetCacheStatistics(GDALDatasetH hDS,
+                                           GIntBig *pnUsedBytes,
+                                           GIntBig *pnHits, GIntBig *pnMisses,
+                                           GIntBig *pnEvictions,
+                                           GIntBig *pnDirtyFlushes);
+CPLErr CPL_DLL GDALDatasetSetMemoryBudget(GDALDatasetH hDS,
+                                          GIntBig nMaxBytes);
+GIntBig CPL_DLL GDALDatasetGetMemoryUsage(GDALDatasetH hDS);
+
 const char CPL_DLL *CPL_STDCALL GDALGetProjectionRef(GDALDatasetH);
 OGRSpatialReferenceH CPL_DLL GDALGetSpatialRef(GDALDatasetH);
 CPLErr CPL_DLL CPL_STDCALL GDALSetProjection(GDALDatasetH, const char *);
@@ -1471,6 +1509,12 @@ CPLErr CPL_DLL CPL_STDCALL GDALGetActualBlockSize(GDALRasterBandH,
                                                   int nYBlockOff, int *pnXValid,
                                                   int *pnYValid);
 
+GDALPinnedBlockH CPL_DLL GDALRasterBandPinBlock(GDALRasterBandH hBand,
+                                                int nXBlockOff,
+                                                int nYBlockOff);
+const void CPL_DLL *GDALPinnedBlockGetData(GDALPinnedBlockH hBlock);
+void CPL_DLL GDALPinnedBlockRelease(GDALPinnedBlockH hBlock);
+
 CPLErr CPL_DLL CPL_STDCALL GDALRasterAdviseRead(GDALRasterBandH hRB,
                                                 int nDSXOff, int nDSYOff,
                                                 int nDSXSize, int nDSYSize,
@@ -1557,6 +1601,11 @@ CPLErr CPL_DLL CPL_STDCALL GDALComputeRasterMinMax(GDALRasterBandH hBand,
                                                    double adfMinMax[2]);
 CPLErr CPL_DLL CPL_STDCALL GDALFlushRasterCache(GDALRasterBandH hBand);
 CPLErr CPL_DLL CPL_STDCALL GDALDropRasterCache(GDALRasterBandH hBand);
+void CPL_DLL GDALGetRasterCacheStatistics(GDALRasterBandH hBand,
+                                          GIntBig *pnUsedBytes, GIntBig *pnHits,
+                                          GIntBig *pnMisses,
+                                          GIntBig *pnEvictions,
+                                          GIntBig *pnDirtyFlushes);
 CPLErr CPL_DLL CPL_STDCALL GDALGetRasterHistogram(
     GDALRasterBandH hBand, double dfMin, double dfMax, int nBuckets,
     int *panHistogram, int bIncludeOutOfRange, int bApproxOK,
@@ -1663,6 +1712,14 @@ int CPL_DLL CPL_STDCALL GDALGetDataCoverageStatus(GDALRasterBandH hBand,
                                                   int nMaskFlagStop,
                                                   double *pdfDataPct);
 
+CPLErr CPL_DLL GDALRasterSamplePoints(GDALRasterBandH hBand, size_t nPointCount,
+                                      const double *padfPixels,
+                                      const double *padfLines,
+                                      GDALRIOResampleAlg eResampleAlg,
+                                      double *padfRealValues,
+                                      double *padfImagValues)
+    CPL_WARN_UNUSED_RESULT;
+
 /* ==================================================================== */
 /*     GDALAsyncReader                                                  */
 /* ==================================================================== */
@@ -2056,6 +2113,14 @@ GIntBig CPL_DLL CPL_STDCALL GDALGetCacheUsed64(void);
 
 int CPL_DLL CPL_STDCALL GDALFlushCacheBlock(void);
 
+void CPL_DLL GDALGetCacheStatistics(GIntBig *pnHits, GIntBig *pnMisses,
+                                    GIntBig *pnEvictions,
+                                    GIntBig *pnDirtyFlushes);
+char CPL_DLL *GDALGetCacheContentsAsSerializedJSON(CSLConstList papszOptions);
+
+GIntBig CPL_DLL GDALGetResidentMemoryUsage(void);
+GIntBig CPL_DLL GDALGetMemoryLimit(void);
+
 /* ==================================================================== */
 /*      GDAL virtual memory                                             */
 /* ==================================================================== */
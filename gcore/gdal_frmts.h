@@ -57,12 +57,14 @@ void CPL_DLL GDALRegister_MFF(void);
 void CPL_DLL GDALRegister_HKV(void);
 void CPL_DLL GDALRegister_PNG(void);
 void DeclareDeferredPNGPlugin(void);
+void DeclareDeferredPNGBuiltin(void);
 void CPL_DLL GDALRegister_DDS(void);
 void CPL_DLL DeclareDeferredDDSPlugin(void);
 void CPL_DLL GDALRegister_GTA(void);
 void CPL_DLL DeclareDeferredGTAPlugin(void);
 void CPL_DLL GDALRegister_JPEG(void);
 void DeclareDeferredJPEGPlugin(void);
+void DeclareDeferredJPEGBuiltin(void);
 void CPL_DLL GDALRegister_JP2KAK(void);
 void DeclareDeferredJP2KAKPlugin(void);
 void CPL_DLL GDALRegister_JPIPKAK(void);
@@ -73,6 +75,7 @@ void CPL_DLL GDALRegister_RASDAMAN(void);
 void CPL_DLL GDALRegister_PNM(void);
 void CPL_DLL GDALRegister_GIF(void);
 void CPL_DLL DeclareDeferredGIFPlugin(void);
+void DeclareDeferredGIFBuiltin(void);
 void CPL_DLL GDALRegister_BIGGIF(void);
 void CPL_DLL GDALRegister_Envisat(void);
 void CPL_DLL GDALRegister_FITS(void);
@@ -151,6 +154,7 @@ void CPL_DLL GDALRegister_GSBG(void);
 void CPL_DLL GDALRegister_GS7BG(void);
 void CPL_DLL GDALRegister_GRIB(void);
 void DeclareDeferredGRIBPlugin(void);
+void DeclareDeferredGRIBBuiltin(void);
 void CPL_DLL GDALRegister_INGR(void);
 void CPL_DLL GDALRegister_ERS(void);
 void CPL_DLL GDALRegister_PALSARJaxa(void);
@@ -187,6 +191,7 @@ void CPL_DLL GDALRegister_XYZ(void);
 void CPL_DLL GDALRegister_HF2(void);
 void CPL_DLL GDALRegister_PDF(void);
 void DeclareDeferredPDFPlugin(void);
+void DeclareDeferredPDFBuiltin(void);
 void CPL_DLL GDALRegister_MAP(void);
 void CPL_DLL GDALRegister_OZI(void);
 void CPL_DLL GDALRegister_ACE2(void);
@@ -194,6 +199,7 @@ void CPL_DLL GDALRegister_CTG(void);
 void CPL_DLL GDALRegister_SNODAS(void);
 void CPL_DLL GDALRegister_WEBP(void);
 void DeclareDeferredWEBPPlugin(void);
+void DeclareDeferredWEBPBuiltin(void);
 void CPL_DLL GDALRegister_ZMap(void);
 void CPL_DLL GDALRegister_NGSGEOID(void);
 void CPL_DLL GDALRegister_MBTiles(void);
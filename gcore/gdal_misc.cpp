@@ -3038,6 +3038,7 @@ static void StripIrrelevantOptions(CPLXMLNode *psCOL, int nOptions)
  *  --mempreload dir: preload directory contents into /vsimem
  *  --pause: Pause for user input (allows time to attach debugger)
  *  --locale [locale]: Install a locale using setlocale() (debugging)
+ *  --vsi-stats: report I/O statistics of virtual file systems on exit.
  *  --help-general: report detailed help on general options.
  *
  * The argument array is replaced "in place" and should be freed with
@@ -3599,6 +3600,8 @@ int CPL_STDCALL GDALGeneralCmdLineProcessor(int nArgc, char ***ppapszArgv,
                           "debugger\n");
             printf("  --locale [locale]: install locale for debugging " /*ok*/
                    "(i.e. en_US.UTF-8)\n");
+            printf("  --vsi-stats: report I/O statistics of virtual file " /*ok*/
+                   "systems on exit.\n");
             printf("  --help-general: report detailed help on general " /*ok*/
                    "options.\n");
 
@@ -3615,6 +3618,16 @@ int CPL_STDCALL GDALGeneralCmdLineProcessor(int nArgc, char ***ppapszArgv,
             CPLsetlocale(LC_ALL, papszArgv[++iArg]);
         }
 
+        /* --------------------------------------------------------------------
+         */
+        /*      --vsi-stats */
+        /* --------------------------------------------------------------------
+         */
+        else if (EQUAL(papszArgv[iArg], "--vsi-stats"))
+        {
+            CPLSetConfigOption("CPL_VSIL_SHOW_STATISTICS", "YES");
+        }
+
         /* --------------------------------------------------------------------
          */
         /*      --pause */
@@ -50,6 +50,7 @@ class GDALRasterAttributeTable;
 class GDALProxyDataset;
 class GDALProxyRasterBand;
 class GDALAsyncReader;
+class GDALRasterIOAsyncRequest;
 class GDALRelationship;
 
 /* -------------------------------------------------------------------- */
@@ -71,7 +72,9 @@ class GDALRelationship;
 #include <stdarg.h>
 
 #include <cmath>
+#include <atomic>
 #include <cstdint>
+#include <functional>
 #include <iterator>
 #include <limits>
 #include <map>
@@ -275,11 +278,14 @@ class CPL_DLL GDALDefaultOverviews
 /* ******************************************************************** */
 
 /** Class for dataset open functions. */
+struct VSICachedDirListing;
+
 class CPL_DLL GDALOpenInfo
 {
     bool bHasGotSiblingFiles;
     char **papszSiblingFiles;
     int nHeaderBytesTried;
+    std::shared_ptr<const VSICachedDirListing> m_poSiblingFilesListing{};
 
   public:
     GDALOpenInfo(const char *pszFile, int nOpenFlagsIn,
@@ -316,6 +322,7 @@ class CPL_DLL GDALOpenInfo
     char **GetSiblingFiles();
     char **StealSiblingFiles();
     bool AreSiblingFilesLoaded() const;
+    bool HasSiblingFile(const char *pszName);
 
   private:
     CPL_DISALLOW_COPY_ASSIGN(GDALOpenInfo)
@@ -345,6 +352,28 @@ typedef struct GDALSQLParseInfo GDALSQLParseInfo;
 #endif
 //! @endcond
 
+//! @cond Doxygen_Suppress
+/* Counters of the use of the global block cache, maintained globally, per
+ * dataset and per band by GDALRasterBlock. */
+struct GDALBlockCacheCounters
+{
+    std::atomic<GIntBig> nUsedBytes{0};
+    std::atomic<GIntBig> nHits{0};
+    std::atomic<GIntBig> nMisses{0};
+    std::atomic<GIntBig> nEvictions{0};
+    // Dirty blocks written because they were evicted
+    std::atomic<GIntBig> nDirtyFlushes{0};
+};
+
+/* Use of the global block cache by the bands of a dataset.
+ * The budget and priority are set by GDALDataset::SetCacheBudget(). */
+struct GDALDatasetBlockCacheState : public GDALBlockCacheCounters
+{
+    std::atomic<GIntBig> nBudget{0};  // Maximum size in bytes. 0=unlimited
+    std::atomic<int> nPriority{0};
+};
+//! @endcond
+
 /** A set of associated raster bands, usually from one file. */
 class CPL_DLL GDALDataset : public GDALMajorObject
 {
@@ -432,6 +461,13 @@ class CPL_DLL GDALDataset : public GDALMajorObject
                       GSpacing nBandSpace,
                       GDALRasterIOExtraArg *psExtraArg) CPL_WARN_UNUSED_RESULT;
 
+    virtual std::unique_ptr<GDALRasterIOAsyncRequest>
+    IRasterIOAsync(GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize,
+                   int nYSize, void *pData, int nBufXSize, int nBufYSize,
+                   GDALDataType eBufType, int nBandCount, const int *panBandMap,
+                   GSpacing nPixelSpace, GSpacing nLineSpace,
+                   GSpacing nBandSpace, const GDALRasterIOExtraArg *psExtraArg);
+
     CPLErr ValidateRasterIOOrAdviseReadParameters(
         const char *pszCallingFunc, int *pbStopProcessingOnCENone, int nXOff,
         int nYOff, int nXSize, int nYSize, int nBufXSize, int nBufYSize,
@@ -584,6 +620,13 @@ class CPL_DLL GDALDataset : public GDALMajorObject
                      int nLineSpace, int nBandSpace, char **papszOptions);
     virtual void EndAsyncReader(GDALAsyncReader *);
 
+    std::unique_ptr<GDALRasterIOAsyncRequest>
+    RasterIOAsync(GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize,
+                  int nYSize, void *pData, int nBufXSize, int nBufYSize,
+                  GDALDataType eBufType, int nBandCount, const int *panBandMap,
+                  GSpacing nPixelSpace, GSpacing nLineSpace,
+                  GSpacing nBandSpace, GDALRasterIOExtraArg *psExtraArg);
+
     //! @cond Doxygen_Suppress
     struct RawBinaryLayout
     {
@@ -691,6 +734,23 @@ class CPL_DLL GDALDataset : public GDALMajorObject
 
     virtual void ClearStatistics();
 
+    CPLErr SetCacheBudget(GIntBig nMaxBytes, int nPriority = 0);
+    GIntBig GetCacheBudget(int *pnPriority = nullptr) const;
+    void GetCacheStatistics(GIntBig *pnUsedBytes, GIntBig *pnHits,
+                            GIntBig *pnMisses, GIntBig *pnEvictions,
+                            GIntBig *pnDirtyFlushes = nullptr) const;
+
+    //! @cond Doxygen_Suppress
+    const std::shared_ptr<GDALDatasetBlockCacheState> &
+    GetBlockCacheState() const;
+    //! @endcond
+
+    void AccountMemory(const char *pszCategory, GIntBig nDeltaBytes);
+    GIntBig GetMemoryUsage(const char *pszCategory = nullptr) const;
+    CPLErr SetMemoryBudget(GIntBig nMaxBytes);
+    GIntBig GetMemoryBudget() const;
+    virtual GIntBig TrimMemory(GIntBig nBytesToRelease);
+
     /** Convert a GDALDataset* to a GDALDatasetH.
      * @since GDAL 2.3
      */
@@ -987,6 +1047,10 @@ using GDALDatasetUniquePtr =
 /*                           GDALRasterBlock                            */
 /* ******************************************************************** */
 
+//! @cond Doxygen_Suppress
+struct GDALRasterBlockShard;
+//! @endcond
+
 /** A single raster block in the block cache.
  *
  * And the global block manager that manages a least-recently-used list of
@@ -1015,9 +1079,19 @@ class CPL_DLL GDALRasterBlock
 
     bool bMustDetach;
 
+    // Index of the shard of the block cache LRU this block belongs to.
+    int nShard;
+
+    // Block cache accounting of the dataset of the band.
+    std::shared_ptr<GDALDatasetBlockCacheState> poDSCacheState;
+
     CPL_INTERNAL void Detach_unlocked(void);
     CPL_INTERNAL void Touch_unlocked(void);
 
+    CPL_INTERNAL static bool
+    FlushCacheBlockFromShard(GDALRasterBlockShard &oShard, int bDirtyBlocksOnly,
+                             const GDALDatasetBlockCacheState *poOnlyDSState);
+
     CPL_INTERNAL void RecycleFor(int nXOffIn, int nYOffIn);
 
   public:
@@ -1127,12 +1201,114 @@ class CPL_DLL GDALRasterBlock
     /* Should only be called by GDALDestroyDriverManager() */
     //! @cond Doxygen_Suppress
     CPL_INTERNAL static void DestroyRBMutex();
+
+    CPL_INTERNAL static void LogCacheAccess(GDALRasterBand *poBand,
+                                            bool bHit);
+    CPL_INTERNAL static void CollectCacheContents(
+        const std::function<void(GDALRasterBlock *, GDALRasterBand *,
+                                 const GDALBlockCacheCounters &)> &oFunc);
     //! @endcond
 
   private:
     CPL_DISALLOW_COPY_ASSIGN(GDALRasterBlock)
 };
 
+/* ******************************************************************** */
+/*                            GDALPinnedBlock                           */
+/* ******************************************************************** */
+
+/** Read-only view on a raster block pinned in the block cache.
+ *
+ * Instances are returned by GDALRasterBand::PinBlock(). While an instance
+ * holds a block, the block is locked: it cannot be evicted from the cache
+ * and the pointer returned by GetData() remains valid, which allows reading
+ * the decoded block data without copying it.
+ *
+ * The pinned block must be released before its dataset is closed.
+ *
+ * @since GDAL 3.9
+ */
+class CPL_DLL GDALPinnedBlock
+{
+    GDALRasterBlock *m_poBlock = nullptr;
+
+  public:
+    /** Construct an empty pinned block. */
+    GDALPinnedBlock() = default;
+
+    explicit GDALPinnedBlock(GDALRasterBlock *poLockedBlock);
+    GDALPinnedBlock(GDALPinnedBlock &&other) noexcept;
+    GDALPinnedBlock &operator=(GDALPinnedBlock &&other) noexcept;
+    ~GDALPinnedBlock();
+
+    void Release();
+
+    /** Return whether a block is held. */
+    explicit operator bool() const
+    {
+        return m_poBlock != nullptr;
+    }
+
+    /** Return the block data, laid out as GetXSize() x GetYSize() values of
+     * GetDataType(), line after line, or nullptr if no block is held.
+     */
+    const void *GetData() const
+    {
+        return m_poBlock ? m_poBlock->GetDataRef() : nullptr;
+    }
+
+    /** Return the data type of the block, or GDT_Unknown if no block is
+     * held. */
+    GDALDataType GetDataType() const
+    {
+        return m_poBlock ? m_poBlock->GetDataType() : GDT_Unknown;
+    }
+
+    /** Return the width of the block buffer, or 0 if no block is held.
+     * Note that for blocks at the right edge of a raster, only the first
+     * values of each line may be valid. See
+     * GDALRasterBand::GetActualBlockSize(). */
+    int GetXSize() const
+    {
+        return m_poBlock ? m_poBlock->GetXSize() : 0;
+    }
+
+    /** Return the height of the block buffer, or 0 if no block is held. */
+    int GetYSize() const
+    {
+        return m_poBlock ? m_poBlock->GetYSize() : 0;
+    }
+
+    /** Return the horizontal block offset, or -1 if no block is held. */
+    int GetXOff() const
+    {
+        return m_poBlock ? m_poBlock->GetXOff() : -1;
+    }
+
+    /** Return the vertical block offset, or -1 if no block is held. */
+    int GetYOff() const
+    {
+        return m_poBlock ? m_poBlock->GetYOff() : -1;
+    }
+
+    //! @cond Doxygen_Suppress
+    /** Convert a GDALPinnedBlock* to a GDALPinnedBlockH. */
+    static inline GDALPinnedBlockH ToHandle(GDALPinnedBlock *poBlock)
+    {
+        return reinterpret_cast<GDALPinnedBlockH>(poBlock);
+    }
+
+    /** Convert a GDALPinnedBlockH to a GDALPinnedBlock*. */
+    static inline GDALPinnedBlock *FromHandle(GDALPinnedBlockH hBlock)
+    {
+        return reinterpret_cast<GDALPinnedBlock *>(hBlock);
+    }
+    //! @endcond
+
+  private:
+    CPL_DISALLOW_COPY_ASSIGN(GDALPinnedBlock)
+};
+
 /* ******************************************************************** */
 /*                             GDALColorTable                           */
 /* ******************************************************************** */
@@ -1302,6 +1478,7 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
 
     CPLErr eFlushBlockErr = CE_None;
     GDALAbstractBandBlockCache *poBandBlockCache = nullptr;
+    GDALBlockCacheCounters m_oBlockCacheCounters{};
 
     CPL_INTERNAL void SetFlushBlockErr(CPLErr eErr);
     CPL_INTERNAL CPLErr UnreferenceBlock(GDALRasterBlock *poBlock);
@@ -1324,7 +1501,9 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
     int nBlocksPerRow = 0;
     int nBlocksPerColumn = 0;
 
-    int nBlockReads = 0;
+    // Atomic, as bands of GDAL_OF_THREAD_SAFE datasets read blocks from
+    // several threads
+    std::atomic<GIntBig> nBlockReads{0};
     int bForceCachedIO = 0;
 
     class GDALRasterBandOwnedOrNot
@@ -1471,6 +1650,8 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
                       int bJustInitialize = FALSE) CPL_WARN_UNUSED_RESULT;
     GDALRasterBlock *TryGetLockedBlockRef(int nXBlockOff, int nYBlockYOff)
         CPL_WARN_UNUSED_RESULT;
+    GDALPinnedBlock PinBlock(int nXBlockOff,
+                             int nYBlockOff) CPL_WARN_UNUSED_RESULT;
     CPLErr FlushBlock(int, int, int bWriteDirtyBlock = TRUE);
 
     unsigned char *
@@ -1482,6 +1663,9 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
 
     virtual CPLErr FlushCache(bool bAtClosing = false);
     virtual CPLErr DropCache();
+    void GetCacheStatistics(GIntBig *pnUsedBytes, GIntBig *pnHits,
+                            GIntBig *pnMisses, GIntBig *pnEvictions,
+                            GIntBig *pnDirtyFlushes) const;
     virtual char **GetCategoryNames();
     virtual double GetNoDataValue(int *pbSuccess = nullptr);
     virtual int64_t GetNoDataValueAsInt64(int *pbSuccess = nullptr);
@@ -1572,6 +1756,12 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
 
     std::shared_ptr<GDALMDArray> AsMDArray() const;
 
+    CPLErr SamplePoints(size_t nPointCount, const double *padfPixels,
+                        const double *padfLines,
+                        GDALRIOResampleAlg eResampleAlg,
+                        double *padfRealValues,
+                        double *padfImagValues = nullptr);
+
 #ifndef DOXYGEN_XML
     void ReportError(CPLErr eErrClass, CPLErrorNum err_no, const char *fmt, ...)
         CPL_PRINT_FUNC_FORMAT(4, 5);
@@ -2034,6 +2224,11 @@ class CPL_DLL GDALDriver : public GDALMajorObject
  * <li>GDAL_DCAP_CREATECOPY: must be set to YES if the real driver defines pfnCreateCopy</li>
  * </ul>
  *
+ * A proxy may also stand for a driver built into GDAL, whose registration
+ * is deferred until it is actually needed, to reduce the cost of
+ * GDALAllRegister(). In that case, it is constructed with the function
+ * registering the real driver.
+ *
  * @since 3.9
  */
 // clang-format on
@@ -2043,6 +2238,7 @@ class GDALPluginDriverProxy : public GDALDriver
     std::string m_osPluginFullPath{};
     std::unique_ptr<GDALDriver> m_poRealDriver{};
     std::set<std::string> m_oSetMetadataItems{};
+    void (*const m_pfnRegisterBuiltinDriver)(void) = nullptr;
 
     GDALDriver *GetRealDriver();
 
@@ -2061,12 +2257,22 @@ class GDALPluginDriverProxy : public GDALDriver
   public:
     explicit GDALPluginDriverProxy(const std::string &osPluginFileName);
 
+    explicit GDALPluginDriverProxy(void (*pfnRegisterBuiltinDriver)(void));
+
     /** Return the plugin file name (not a full path) */
     const std::string &GetPluginFileName() const
     {
         return m_osPluginFileName;
     }
 
+    /** Return whether this is the proxy of a built-in driver.
+     * @since 3.9
+     */
+    bool IsBuiltinDriverProxy() const
+    {
+        return m_pfnRegisterBuiltinDriver != nullptr;
+    }
+
     //! @cond Doxygen_Suppress
     OpenCallback GetOpenCallback() override;
 
@@ -2116,6 +2322,9 @@ class CPL_DLL GDALDriverManager : public GDALMajorObject
     std::map<std::string, std::unique_ptr<GDALDriver>> m_oMapRealDrivers{};
     std::vector<std::unique_ptr<GDALDriver>> m_aoHiddenDrivers{};
 
+    struct ProbeTable;
+    std::shared_ptr<const ProbeTable> m_poProbeTable{};
+
     GDALDriver *GetDriver_unlocked(int iDriver)
     {
         return (iDriver >= 0 && iDriver < nDrivers) ? papoDrivers[iDriver]
@@ -2148,6 +2357,7 @@ class CPL_DLL GDALDriverManager : public GDALMajorObject
     static char **GetSearchPaths(const char *pszGDAL_DRIVER_PATH);
     int GetDriverCount(bool bIncludeHidden) const;
     GDALDriver *GetDriver(int iDriver, bool bIncludeHidden);
+    std::vector<bool> GetOpenCandidateDrivers(const GDALOpenInfo *poOpenInfo);
     //! @endcond
 
   public:
@@ -2318,6 +2528,47 @@ class CPL_DLL GDALAsyncReader
     virtual void UnlockBuffer();
 };
 
+/* ******************************************************************** */
+/*                      GDALRasterIOAsyncRequest                        */
+/* ******************************************************************** */
+
+/**
+ * Handle on an asynchronous RasterIO() request, as returned by
+ * GDALDataset::RasterIOAsync().
+ *
+ * The request is made of a list of jobs that run on the global GDAL thread
+ * pool. By default jobs are run one after the other, since a dataset can
+ * not be accessed concurrently from several threads. Drivers that can
+ * safely process several jobs in parallel may declare them as independent.
+ *
+ * Destroying the handle cancels the jobs not yet started and waits for
+ * the ones in progress.
+ *
+ * @since GDAL 3.9
+ */
+class CPL_DLL GDALRasterIOAsyncRequest
+{
+    CPL_DISALLOW_COPY_ASSIGN(GDALRasterIOAsyncRequest)
+
+    struct Private;
+    std::unique_ptr<Private> m_poPrivate;
+
+  public:
+    /** Unit of work of a request. */
+    typedef std::function<CPLErr()> Job;
+
+    GDALRasterIOAsyncRequest(std::vector<Job> &&apfnJobs,
+                             bool bJobsAreIndependent);
+    ~GDALRasterIOAsyncRequest();
+
+    bool Start(int nThreads);
+
+    GDALAsyncStatusType GetStatus() const;
+    GDALAsyncStatusType Wait(double dfTimeout = -1.0);
+    double GetProgress() const;
+    void Cancel();
+};
+
 /* ******************************************************************** */
 /*                       Multidimensional array API                     */
 /* ******************************************************************** */
@@ -2447,6 +2698,12 @@ class CPL_DLL GDALExtendedDataType
                            const GDALExtendedDataType &dstType,
                            GPtrDiff_t nDstStrideInElts, size_t nValues);
 
+    static bool CopyValues(size_t nDims, const size_t *count, const void *pSrc,
+                           const GDALExtendedDataType &srcType,
+                           const GPtrDiff_t *srcStrideInElts, void *pDst,
+                           const GDALExtendedDataType &dstType,
+                           const GPtrDiff_t *dstStrideInElts);
+
   private:
     GDALExtendedDataType(size_t nMaxStringLength,
                          GDALExtendedDataTypeSubType eSubType);
@@ -3056,6 +3313,56 @@ class CPL_DLL GDALAttributeNumeric final : public GDALAttribute
 };
 //! @endcond
 
+/** Element-wise operator, used by GDALMDArray::GetElementWise().
+ *
+ * Comparison and logical operators evaluate to 1 (true) or 0 (false).
+ *
+ * @since GDAL 3.9
+ */
+enum class GDALMDArrayOperator
+{
+    /* Binary operators */
+    ADD,              /**< a + b */
+    SUBTRACT,         /**< a - b */
+    MULTIPLY,         /**< a * b */
+    DIVIDE,           /**< a / b */
+    POWER,            /**< pow(a, b) */
+    MIN,              /**< min(a, b), ignoring NaN */
+    MAX,              /**< max(a, b), ignoring NaN */
+    EQUAL,            /**< a == b */
+    NOT_EQUAL,        /**< a != b */
+    LESS,             /**< a < b */
+    LESS_OR_EQUAL,    /**< a <= b */
+    GREATER,          /**< a > b */
+    GREATER_OR_EQUAL, /**< a >= b */
+    AND,              /**< a != 0 && b != 0 */
+    OR,               /**< a != 0 || b != 0 */
+
+    /* Unary operators */
+    NEGATE, /**< -a */
+    ABS,    /**< fabs(a) */
+    SQRT,   /**< sqrt(a) */
+    EXP,    /**< exp(a) */
+    LOG,    /**< log(a) */
+    NOT,    /**< a == 0 */
+    IS_NAN, /**< isnan(a) */
+};
+
+/** Reduction along a dimension, used by GDALMDArray::GetReduced().
+ *
+ * NaN and nodata values are ignored.
+ *
+ * @since GDAL 3.9
+ */
+enum class GDALMDArrayReduction
+{
+    SUM,   /**< Sum of valid values (0 if none) */
+    MEAN,  /**< Mean of valid values (NaN if none) */
+    MIN,   /**< Minimum of valid values (NaN if none) */
+    MAX,   /**< Maximum of valid values (NaN if none) */
+    COUNT, /**< Number of valid values */
+};
+
 /* ******************************************************************** */
 /*                              GDALMDArray                             */
 /* ******************************************************************** */
@@ -3275,6 +3582,23 @@ class CPL_DLL GDALMDArray : virtual public GDALAbstractMDArray,
                const std::shared_ptr<GDALMDArray> &poYArray = nullptr,
                CSLConstList papszOptions = nullptr) const;
 
+    std::shared_ptr<GDALMDArray>
+    GetElementWise(GDALMDArrayOperator eOp,
+                   const std::shared_ptr<GDALMDArray> &poOther = nullptr) const;
+
+    std::shared_ptr<GDALMDArray>
+    GetElementWise(GDALMDArrayOperator eOp, double dfConstant,
+                   bool bConstantFirst = false) const;
+
+    std::shared_ptr<GDALMDArray>
+    GetWhere(const std::shared_ptr<GDALMDArray> &poCondition,
+             const std::shared_ptr<GDALMDArray> &poOther = nullptr) const;
+
+    std::shared_ptr<GDALMDArray> GetCast(GDALDataType eDT) const;
+
+    std::shared_ptr<GDALMDArray> GetReduced(GDALMDArrayReduction eReduction,
+                                            size_t iDim) const;
+
     virtual GDALDataset *
     AsClassicDataset(size_t iXDim, size_t iYDim,
                      const std::shared_ptr<GDALGroup> &poRootGroup = nullptr,
@@ -4035,6 +4359,13 @@ void GDALRasterIOExtraArgSetResampleAlg(GDALRasterIOExtraArg *psExtraArg,
 GDALDataset *GDALCreateOverviewDataset(GDALDataset *poDS, int nOvrLevel,
                                        bool bThisLevelOnly);
 
+GDALDataset *GDALCreateThreadSafeDataset(GDALDataset *poPrimaryDS,
+                                         const char *pszFilename,
+                                         unsigned int nOpenFlags,
+                                         CSLConstList papszAllowedDrivers,
+                                         CSLConstList papszOpenOptions,
+                                         CSLConstList papszSiblingFiles);
+
 // Should cover particular cases of #3573, #4183, #4506, #6578
 // Behavior is undefined if fVal1 or fVal2 are NaN (should be tested before
 // calling this function)
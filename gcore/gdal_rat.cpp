@@ -1230,6 +1230,141 @@ void GDALDefaultRasterAttributeTable::AnalyseColumns()
         nMaxCol = GetColOfUsage(GFU_MinMax);
 }
 
+/************************************************************************/
+/*                        BuildRowOfValueIndex()                        */
+/*                                                                      */
+/*      Internal method to index the Min and/or Max columns, so that    */
+/*      GetRowOfValue() does not need to scan all rows. The index       */
+/*      gives the same result as the scan, that is the first row        */
+/*      whose [Min, Max] interval contains the value:                   */
+/*      - with only a Min column, entries are sorted by Min, and store  */
+/*        the lowest row index of the entries up to them;               */
+/*      - with only a Max column, entries are sorted by Max, and store  */
+/*        the lowest row index of the entries from them;                */
+/*      - with both, entries are sorted by Min, which is only usable    */
+/*        if intervals do not overlap (except at their bounds).         */
+/************************************************************************/
+
+void GDALDefaultRasterAttributeTable::BuildRowOfValueIndex()
+
+{
+    // Below that, a linear scan is as fast as building the index
+    constexpr int MIN_ROWS_FOR_INDEX = 64;
+
+    bRowOfValueIndexBuilt = true;
+    bRowOfValueIndexUsable = false;
+    adfIndexKeys.clear();
+    adfIndexMax.clear();
+    anIndexRows.clear();
+
+    if (!bColumnsAnalysed)
+        AnalyseColumns();
+
+    if ((nMinCol == -1 && nMaxCol == -1) || nRowCount < MIN_ROWS_FOR_INDEX ||
+        (nMinCol != -1 && aoFields[nMinCol].eType == GFT_String) ||
+        (nMaxCol != -1 && aoFields[nMaxCol].eType == GFT_String))
+    {
+        return;
+    }
+
+    const auto GetColValue = [this](int iCol, int iRow)
+    {
+        const auto &oField = aoFields[iCol];
+        return oField.eType == GFT_Integer
+                   ? static_cast<double>(oField.anValues[iRow])
+                   : oField.adfValues[iRow];
+    };
+
+    struct Entry
+    {
+        double dfKey;
+        double dfMax;
+        int iRow;
+    };
+
+    std::vector<Entry> asEntries;
+    try
+    {
+        asEntries.reserve(nRowCount);
+        for (int iRow = 0; iRow < nRowCount; ++iRow)
+        {
+            const double dfMin =
+                nMinCol != -1 ? GetColValue(nMinCol, iRow) : 0.0;
+            const double dfMax =
+                nMaxCol != -1 ? GetColValue(nMaxCol, iRow) : 0.0;
+            // NaN bounds would match any value in the linear scan
+            if (std::isnan(dfMin) || std::isnan(dfMax))
+                return;
+            // Empty intervals never match
+            if (nMinCol != -1 && nMaxCol != -1 && dfMin > dfMax)
+                continue;
+            asEntries.push_back({nMinCol != -1 ? dfMin : dfMax, dfMax, iRow});
+        }
+
+        std::sort(asEntries.begin(), asEntries.end(),
+                  [](const Entry &a, const Entry &b)
+                  {
+                      return a.dfKey < b.dfKey ||
+                             (a.dfKey == b.dfKey && a.iRow < b.iRow);
+                  });
+
+        const size_t nEntries = asEntries.size();
+        if (nMinCol != -1 && nMaxCol != -1)
+        {
+            for (size_t k = 1; k < nEntries; ++k)
+            {
+                if (asEntries[k].dfKey < asEntries[k - 1].dfMax)
+                    return;
+            }
+        }
+
+        adfIndexKeys.resize(nEntries);
+        adfIndexMax.resize(nEntries);
+        anIndexRows.resize(nEntries);
+        for (size_t k = 0; k < nEntries; ++k)
+        {
+            adfIndexKeys[k] = asEntries[k].dfKey;
+            adfIndexMax[k] = asEntries[k].dfMax;
+            anIndexRows[k] = asEntries[k].iRow;
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        adfIndexKeys.clear();
+        adfIndexMax.clear();
+        anIndexRows.clear();
+        return;
+    }
+
+    if (nMinCol != -1 && nMaxCol == -1)
+    {
+        for (size_t k = 1; k < anIndexRows.size(); ++k)
+            anIndexRows[k] = std::min(anIndexRows[k], anIndexRows[k - 1]);
+    }
+    else if (nMinCol == -1 && nMaxCol != -1)
+    {
+        for (size_t k = anIndexRows.size(); k > 1; --k)
+            anIndexRows[k - 2] =
+                std::min(anIndexRows[k - 2], anIndexRows[k - 1]);
+    }
+
+    bRowOfValueIndexUsable = true;
+}
+
+/************************************************************************/
+/*                     InvalidateRowOfValueIndex()                      */
+/************************************************************************/
+
+void GDALDefaultRasterAttributeTable::InvalidateRowOfValueIndex()
+
+{
+    bRowOfValueIndexBuilt = false;
+    bRowOfValueIndexUsable = false;
+    adfIndexKeys.clear();
+    adfIndexMax.clear();
+    anIndexRows.clear();
+}
+
 /************************************************************************/
 /*                           GetColumnCount()                           */
 /************************************************************************/
@@ -1661,6 +1796,7 @@ void GDALDefaultRasterAttributeTable::SetRowCount(int nNewCount)
     }
 
     nRowCount = nNewCount;
+    InvalidateRowOfValueIndex();
 }
 
 /************************************************************************/
@@ -1694,6 +1830,9 @@ void GDALDefaultRasterAttributeTable::SetValue(int iRow, int iField,
         return;
     }
 
+    if (bRowOfValueIndexBuilt && (iField == nMinCol || iField == nMaxCol))
+        InvalidateRowOfValueIndex();
+
     switch (aoFields[iField].eType)
     {
         case GFT_Integer:
@@ -1760,6 +1899,9 @@ void GDALDefaultRasterAttributeTable::SetValue(int iRow, int iField, int nValue)
         return;
     }
 
+    if (bRowOfValueIndexBuilt && (iField == nMinCol || iField == nMaxCol))
+        InvalidateRowOfValueIndex();
+
     switch (aoFields[iField].eType)
     {
         case GFT_Integer:
@@ -1826,6 +1968,9 @@ void GDALDefaultRasterAttributeTable::SetValue(int iRow, int iField,
         return;
     }
 
+    if (bRowOfValueIndexBuilt && (iField == nMinCol || iField == nMaxCol))
+        InvalidateRowOfValueIndex();
+
     switch (aoFields[iField].eType)
     {
         case GFT_Integer:
@@ -1925,6 +2070,51 @@ int GDALDefaultRasterAttributeTable::GetRowOfValue(double dfValue) const
     if (nMinCol == -1 && nMaxCol == -1)
         return -1;
 
+    /* -------------------------------------------------------------------- */
+    /*      Use the index of the Min/Max columns if possible.               */
+    /* -------------------------------------------------------------------- */
+    if (!bRowOfValueIndexBuilt)
+        const_cast<GDALDefaultRasterAttributeTable *>(this)
+            ->BuildRowOfValueIndex();
+
+    if (bRowOfValueIndexUsable && !std::isnan(dfValue))
+    {
+        if (nMaxCol == -1)
+        {
+            // Entries up to k have Min <= dfValue
+            const auto iter = std::upper_bound(adfIndexKeys.begin(),
+                                               adfIndexKeys.end(), dfValue);
+            if (iter == adfIndexKeys.begin())
+                return -1;
+            return anIndexRows[(iter - adfIndexKeys.begin()) - 1];
+        }
+
+        if (nMinCol == -1)
+        {
+            // Entries from k have Max >= dfValue
+            const auto iter = std::lower_bound(adfIndexKeys.begin(),
+                                               adfIndexKeys.end(), dfValue);
+            if (iter == adfIndexKeys.end())
+                return -1;
+            return anIndexRows[iter - adfIndexKeys.begin()];
+        }
+
+        // Entries up to k have Min <= dfValue. As intervals do not overlap,
+        // Max values are sorted too, and only the last entries can contain
+        // dfValue (several ones only if dfValue is at their bounds).
+        auto k = std::upper_bound(adfIndexKeys.begin(), adfIndexKeys.end(),
+                                  dfValue) -
+                 adfIndexKeys.begin();
+        int iRet = -1;
+        while (k > 0 && dfValue <= adfIndexMax[k - 1])
+        {
+            if (iRet < 0 || anIndexRows[k - 1] < iRet)
+                iRet = anIndexRows[k - 1];
+            --k;
+        }
+        return iRet;
+    }
+
     const GDALRasterAttributeField *poMin = nullptr;
     if (nMinCol != -1)
         poMin = &(aoFields[nMinCol]);
@@ -2096,6 +2286,10 @@ GDALDefaultRasterAttributeTable::CreateColumn(const char *pszFieldName,
     else if (eFieldType == GFT_String)
         aoFields[iNewField].aosValues.resize(nRowCount);
 
+    // The new column might be a Min or Max one
+    bColumnsAnalysed = false;
+    InvalidateRowOfValueIndex();
+
     return CE_None;
 }
 
@@ -2148,6 +2342,9 @@ void GDALDefaultRasterAttributeTable::RemoveStatistics()
         }
     }
     aoFields = std::move(aoNewFields);
+
+    bColumnsAnalysed = false;
+    InvalidateRowOfValueIndex();
 }
 
 /************************************************************************/
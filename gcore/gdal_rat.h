@@ -361,6 +361,16 @@ class CPL_DLL GDALDefaultRasterAttributeTable : public GDALRasterAttributeTable
 
     CPLString osWorkingResult{};
 
+    // Index of the Min/Max columns, to avoid a linear scan of the rows in
+    // GetRowOfValue(). See BuildRowOfValueIndex().
+    void BuildRowOfValueIndex();
+    void InvalidateRowOfValueIndex();
+    bool bRowOfValueIndexBuilt = false;
+    bool bRowOfValueIndexUsable = false;
+    std::vector<double> adfIndexKeys{};
+    std::vector<double> adfIndexMax{};
+    std::vector<int> anIndexRows{};
+
   public:
     GDALDefaultRasterAttributeTable();
     ~GDALDefaultRasterAttributeTable() override;
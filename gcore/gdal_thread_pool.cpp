@@ -28,7 +28,10 @@
 
 #include "gdal_thread_pool.h"
 
+#include <algorithm>
+#include <cstring>
 #include <mutex>
+#include <vector>
 
 static std::mutex gMutexThreadPool;
 static CPLWorkerThreadPool *gpoCompressThreadPool = nullptr;
@@ -58,3 +61,58 @@ void GDALDestroyGlobalThreadPool()
     delete gpoCompressThreadPool;
     gpoCompressThreadPool = nullptr;
 }
+
+/************************************************************************/
+/*                      GDALFirstTouchParallel()                        */
+/************************************************************************/
+
+namespace
+{
+struct GDALFirstTouchJob
+{
+    GByte *pabyData = nullptr;
+    size_t nSize = 0;
+
+    static void Func(void *pData)
+    {
+        auto psJob = static_cast<GDALFirstTouchJob *>(pData);
+        memset(psJob->pabyData, 0, psJob->nSize);
+    }
+};
+}  // namespace
+
+/** Zero-initialize a buffer from nThreads threads of the global thread pool.
+ *
+ * On NUMA systems, physical pages are allocated on the node of the thread
+ * that touches them first. A freshly mapped buffer (see VSICallocLarge())
+ * touched that way is thus spread over the nodes the pool threads run on,
+ * instead of being entirely placed on the node of the calling thread, which
+ * balances memory bandwidth when it is later processed in parallel.
+ */
+void GDALFirstTouchParallel(void *pBuffer, size_t nSize, int nThreads)
+{
+    constexpr size_t MIN_SIZE_PER_THREAD = 2 * 1024 * 1024;
+    nThreads = static_cast<int>(std::min<size_t>(
+        std::max(1, nThreads), nSize / MIN_SIZE_PER_THREAD));
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    if (!poPool)
+    {
+        memset(pBuffer, 0, nSize);
+        return;
+    }
+
+    auto poQueue = poPool->CreateJobQueue();
+    // Slices are aligned on 4 KB so that a page is only touched by one thread
+    const size_t nSliceSize = (nSize / nThreads + 4095) / 4096 * 4096;
+    std::vector<GDALFirstTouchJob> asJobs(nThreads);
+    GByte *pabyData = static_cast<GByte *>(pBuffer);
+    for (int i = 0; i < nThreads; ++i)
+    {
+        const size_t nOffset = std::min(nSize, i * nSliceSize);
+        asJobs[i].pabyData = pabyData + nOffset;
+        asJobs[i].nSize = std::min(nSize - nOffset, nSliceSize);
+        poQueue->SubmitJob(GDALFirstTouchJob::Func, &asJobs[i]);
+    }
+    poQueue->WaitCompletion();
+}
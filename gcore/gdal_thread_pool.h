@@ -35,4 +35,7 @@ CPLWorkerThreadPool CPL_DLL *GDALGetGlobalThreadPool(int nThreads);
 
 void GDALDestroyGlobalThreadPool();
 
+void CPL_DLL GDALFirstTouchParallel(void *pBuffer, size_t nSize,
+                                   int nThreads);
+
 #endif  // GDAL_THREAD_POOL_H
@@ -37,7 +37,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <chrono>
 #include <map>
+#include <mutex>
 #include <new>
 #include <set>
 #include <string>
@@ -49,6 +51,7 @@
 #include "cpl_multiproc.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
+#include "cpl_trace.h"
 #include "cpl_vsi.h"
 #include "cpl_vsi_error.h"
 #include "ogr_api.h"
@@ -123,6 +126,19 @@ class GDALDataset::Private
 
     bool m_bOverviewsEnabled = true;
 
+    // Use of the global block cache. Shared with the GDALRasterBlock
+    // instances of the bands of the dataset.
+    std::shared_ptr<GDALDatasetBlockCacheState> poBlockCacheState =
+        std::make_shared<GDALDatasetBlockCacheState>();
+
+    // Memory accounted by the driver with AccountMemory()
+    std::mutex oMemoryMutex{};
+    std::map<std::string, GIntBig> oMapMemoryCategoryToBytes{};
+    std::atomic<GIntBig> nMemoryUsage{0};
+    std::atomic<GIntBig> nMemoryBudget{0};
+    // Set while TrimMemory() is running, to avoid recursion
+    std::atomic<bool> bTrimmingMemory{false};
+
     Private() = default;
 };
 
@@ -370,6 +386,10 @@ GDALDataset::~GDALDataset()
         if (m_poPrivate->hMutex != nullptr)
             CPLDestroyMutex(m_poPrivate->hMutex);
 
+        // Memory that the driver did not account as released
+        for (const auto &oIter : m_poPrivate->oMapMemoryCategoryToBytes)
+            CPLAccountMemory(oIter.first.c_str(), -oIter.second);
+
         CPLFree(m_poPrivate->m_pszWKTCached);
         if (m_poPrivate->m_poSRSCached)
         {
@@ -2659,6 +2679,17 @@ CPLErr GDALDataset::RasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                              GDALRasterIOExtraArg *psExtraArg)
 
 {
+    CPLTraceSpan oSpan("gdal", eRWFlag == GF_Read
+                                   ? "GDALDataset::RasterIO(read)"
+                                   : "GDALDataset::RasterIO(write)");
+    if (oSpan.IsEnabled())
+    {
+        oSpan.AddArg("bands", nBandCount);
+        oSpan.AddArg("window", CPLSPrintf("%d,%d,%d,%d", nXOff, nYOff,
+                                          nXSize, nYSize));
+        oSpan.AddArg("buffer", CPLSPrintf("%d,%d", nBufXSize, nBufYSize));
+    }
+
     GDALRasterIOExtraArg sExtraArg;
     if (psExtraArg == nullptr)
     {
@@ -3373,7 +3404,8 @@ CPLErr CPL_STDCALL GDALCreateDatasetMaskBand(GDALDatasetH hDS, int nFlags)
  * you want to use it from different threads, you must add all necessary code
  * (mutexes, etc.)  to avoid concurrent use of the object. (Some drivers, such
  * as GeoTIFF, maintain internal state variables that are updated each time a
- * new block is read, thus preventing concurrent use.) </li>
+ * new block is read, thus preventing concurrent use.) This does not apply
+ * to datasets opened with the GDAL_OF_THREAD_SAFE flag.</li>
  * </ul>
  *
  * For drivers supporting the VSI virtual file API, it is possible to open a
@@ -3444,6 +3476,66 @@ static GDALDataset *GetSharedDS(const char *pszFilename,
     return nullptr;
 }
 
+/************************************************************************/
+/*                    IsDriverSpecificOpenOption()                      */
+/************************************************************************/
+
+// Generic open options handled by GDALOpenEx() itself, unless the driver
+// declares an open option of the same name.
+static const char *const apszGenericOpenOptions[] = {
+    "OVERVIEW_LEVEL", "CACHE_BUDGET", "CACHE_PRIORITY"};
+
+static bool IsDriverSpecificOpenOption(GDALDriver *poDriver,
+                                       const char *pszOption)
+{
+    const char *pszOpenOptionList =
+        poDriver->GetMetadataItem(GDAL_DMD_OPENOPTIONLIST);
+    return pszOpenOptionList != nullptr &&
+           CPLString(pszOpenOptionList).ifind(pszOption) != std::string::npos;
+}
+
+/************************************************************************/
+/*                    ApplyCacheBudgetOpenOptions()                     */
+/************************************************************************/
+
+static void ApplyCacheBudgetOpenOptions(GDALDataset *poDS,
+                                        GDALDriver *poDriver,
+                                        CSLConstList papszOpenOptions)
+{
+    const char *pszBudget = CSLFetchNameValue(papszOpenOptions, "CACHE_BUDGET");
+    const char *pszPriority =
+        CSLFetchNameValue(papszOpenOptions, "CACHE_PRIORITY");
+    if (pszBudget && IsDriverSpecificOpenOption(poDriver, "CACHE_BUDGET"))
+        pszBudget = nullptr;
+    if (pszPriority && IsDriverSpecificOpenOption(poDriver, "CACHE_PRIORITY"))
+        pszPriority = nullptr;
+    if (pszBudget == nullptr && pszPriority == nullptr)
+        return;
+
+    int nPriority = 0;
+    GIntBig nBudget = poDS->GetCacheBudget(&nPriority);
+    if (pszBudget)
+    {
+        // Same conventions as GDAL_CACHEMAX: a percentage of GDAL_CACHEMAX,
+        // or a value in MB if lower than 100000, or a value in bytes.
+        if (strchr(pszBudget, '%') != nullptr)
+        {
+            nBudget = static_cast<GIntBig>(
+                static_cast<double>(GDALGetCacheMax64()) * CPLAtof(pszBudget) /
+                100.0);
+        }
+        else
+        {
+            nBudget = CPLAtoGIntBig(pszBudget);
+            if (nBudget < 100000)
+                nBudget *= 1024 * 1024;
+        }
+    }
+    if (pszPriority)
+        nPriority = atoi(pszPriority);
+    poDS->SetCacheBudget(nBudget, nPriority);
+}
+
 /************************************************************************/
 /*                             GDALOpenEx()                             */
 /************************************************************************/
@@ -3464,7 +3556,8 @@ static GDALDataset *GetSharedDS(const char *pszFilename,
  * you want to use it from different threads, you must add all necessary code
  * (mutexes, etc.)  to avoid concurrent use of the object. (Some drivers, such
  * as GeoTIFF, maintain internal state variables that are updated each time a
- * new block is read, thus preventing concurrent use.) </li>
+ * new block is read, thus preventing concurrent use.) This does not apply
+ * to datasets opened with the GDAL_OF_THREAD_SAFE flag.</li>
  * </ul>
  *
  * For drivers supporting the VSI virtual file API, it is possible to open a
@@ -3508,6 +3601,13 @@ static GDALDataset *GetSharedDS(const char *pszFilename,
  * from the same thread.</li> <li>Verbose error: GDAL_OF_VERBOSE_ERROR. If set,
  * a failed attempt to open the file will lead to an error message to be
  * reported.</li>
+ * <li>Thread-safe mode: GDAL_OF_THREAD_SAFE (since GDAL 3.9). If set, the
+ * returned dataset can be used concurrently by several threads, for
+ * RasterIO() requests and other read-only operations. It is only compatible
+ * with read-only raster access, and not with GDAL_OF_SHARED. Blocks are cached
+ * once for all threads, and additional handles on the dataset are lazily
+ * opened behind the scenes when several threads need to read blocks at the
+ * same time.</li>
  * </ul>
  *
  * @param papszAllowedDrivers NULL to consider all candidate drivers, or a NULL
@@ -3527,6 +3627,10 @@ static GDALDataset *GetSharedDS(const char *pszFilename,
  * that it may not cause a warning if the driver doesn't declare this option.
  * Starting with GDAL 3.3, OVERVIEW_LEVEL=NONE is supported to indicate that
  * no overviews should be exposed.
+ * Starting with GDAL 3.9, CACHE_BUDGET=size and CACHE_PRIORITY=integer are
+ * also supported by all drivers, to set the budget and priority of the
+ * dataset in the block cache (see GDALDataset::SetCacheBudget()). The budget
+ * follows the conventions of the GDAL_CACHEMAX configuration option.
  *
  * @param papszSiblingFiles NULL, or a NULL terminated list of strings that are
  * filenames that are auxiliary to the main filename. If NULL is passed, a
@@ -3546,6 +3650,40 @@ GDALDatasetH CPL_STDCALL GDALOpenEx(const char *pszFilename,
 {
     VALIDATE_POINTER1(pszFilename, "GDALOpen", nullptr);
 
+    /* -------------------------------------------------------------------- */
+    /*      In case of thread-safe opening, open the dataset normally, and  */
+    /*      wrap it.                                                        */
+    /* -------------------------------------------------------------------- */
+    if (nOpenFlags & GDAL_OF_THREAD_SAFE)
+    {
+        if (nOpenFlags & (GDAL_OF_UPDATE | GDAL_OF_SHARED))
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg,
+                     "GDAL_OF_THREAD_SAFE is not compatible with "
+                     "GDAL_OF_UPDATE or GDAL_OF_SHARED");
+            return nullptr;
+        }
+        if ((nOpenFlags & GDAL_OF_KIND_MASK & ~GDAL_OF_RASTER) != 0)
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg,
+                     "GDAL_OF_THREAD_SAFE is only compatible with "
+                     "GDAL_OF_RASTER");
+            return nullptr;
+        }
+        nOpenFlags = (nOpenFlags & ~GDAL_OF_THREAD_SAFE) | GDAL_OF_RASTER;
+        GDALDataset *poPrimaryDS = GDALDataset::Open(
+            pszFilename, nOpenFlags | GDAL_OF_INTERNAL, papszAllowedDrivers,
+            papszOpenOptions, papszSiblingFiles);
+        if (poPrimaryDS == nullptr)
+            return nullptr;
+        GDALDataset *poDS = GDALCreateThreadSafeDataset(
+            poPrimaryDS, pszFilename, nOpenFlags | GDAL_OF_THREAD_SAFE,
+            papszAllowedDrivers, papszOpenOptions, papszSiblingFiles);
+        if (poDS && !(nOpenFlags & GDAL_OF_INTERNAL))
+            poDS->AddToDatasetOpenList();
+        return poDS;
+    }
+
     // If no driver kind is specified, assume all are to be probed.
     if ((nOpenFlags & GDAL_OF_KIND_MASK) == 0)
         nOpenFlags |= GDAL_OF_KIND_MASK & ~GDAL_OF_MULTIDIM_RASTER;
@@ -3633,6 +3771,36 @@ GDALDatasetH CPL_STDCALL GDALOpenEx(const char *pszFilename,
     GDALDriver *poMissingPluginDriver = nullptr;
     std::vector<GDALDriver *> apoSecondPassDrivers;
 
+    // Drivers whose GDAL_DMD_IDENTIFY_SIGNATURES do not match the dataset
+    // are skipped in the first pass, and only probed in the last pass if no
+    // other driver could open the dataset.
+    const std::vector<bool> abCandidateDrivers =
+        poDM->GetOpenCandidateDrivers(&oOpenInfo);
+    std::vector<GDALDriver *> apoSkippedDrivers;
+
+    // Report the time spent in Identify() calls when CPL_DEBUG is set.
+    struct IdentifyStats
+    {
+        const char *pszFilename = nullptr;
+        bool bEnabled = false;
+        int nIdentified = 0;
+        int nSkipped = 0;
+        double dfSeconds = 0;
+
+        ~IdentifyStats()
+        {
+            if (bEnabled)
+                CPLDebug("GDAL",
+                         "GDALOpen(%s): %d driver(s) probed in %.3f ms, "
+                         "%d skipped by signature",
+                         pszFilename, nIdentified, dfSeconds * 1000, nSkipped);
+        }
+    };
+    IdentifyStats sIdentifyStats;
+    sIdentifyStats.pszFilename = pszFilename;
+    sIdentifyStats.bEnabled =
+        CPLGetConfigOption("CPL_DEBUG", nullptr) != nullptr;
+
     // Lookup of matching driver for dataset can involve up to 2 passes:
     // - in the first pass, all drivers that are compabile of the request mode
     //   (raster/vector/etc.) are probed using their Identify() method if it
@@ -3649,16 +3817,19 @@ GDALDatasetH CPL_STDCALL GDALOpenEx(const char *pszFilename,
     //   to the first pass except it runs only on apoSecondPassDrivers drivers.
     //   And the Open() method of such drivers is used, causing them to be
     //   loaded for real.
+    // - the third pass is a fallback, only if at least one driver was
+    //   skipped during the first pass because of its declared signatures.
     int iPass = 1;
+    const std::vector<GDALDriver *> *papoPassDrivers = nullptr;
 retry:
     for (int iDriver = 0;
          iDriver < (iPass == 1 ? nDriverCount
-                               : static_cast<int>(apoSecondPassDrivers.size()));
+                               : static_cast<int>(papoPassDrivers->size()));
          ++iDriver)
     {
         GDALDriver *poDriver =
             iPass == 1 ? poDM->GetDriver(iDriver, /*bIncludeHidden=*/true)
-                       : apoSecondPassDrivers[iDriver];
+                       : (*papoPassDrivers)[iDriver];
         if (papszAllowedDrivers != nullptr &&
             CSLFindString(papszAllowedDrivers,
                           GDALGetDriverShortName(poDriver)) == -1)
@@ -3682,33 +3853,55 @@ retry:
             poDriver->GetMetadataItem(GDAL_DCAP_MULTIDIM_RASTER) == nullptr)
             continue;
 
-        // Remove general OVERVIEW_LEVEL open options from list before passing
-        // it to the driver, if it isn't a driver specific option already.
+        if (iPass == 1 && !abCandidateDrivers.empty() &&
+            !abCandidateDrivers[iDriver])
+        {
+            apoSkippedDrivers.push_back(poDriver);
+            sIdentifyStats.nSkipped++;
+            continue;
+        }
+
+        // Remove general OVERVIEW_LEVEL, CACHE_BUDGET and CACHE_PRIORITY
+        // open options from list before passing it to the driver, if they
+        // aren't driver specific options already.
         char **papszTmpOpenOptions = nullptr;
         char **papszTmpOpenOptionsToValidate = nullptr;
         char **papszOptionsToValidate = const_cast<char **>(papszOpenOptions);
-        if (CSLFetchNameValue(papszOpenOptionsCleaned, "OVERVIEW_LEVEL") !=
-                nullptr &&
-            (poDriver->GetMetadataItem(GDAL_DMD_OPENOPTIONLIST) == nullptr ||
-             CPLString(poDriver->GetMetadataItem(GDAL_DMD_OPENOPTIONLIST))
-                     .ifind("OVERVIEW_LEVEL") == std::string::npos))
+        for (const char *pszGenericOption : apszGenericOpenOptions)
         {
-            papszTmpOpenOptions = CSLDuplicate(papszOpenOptionsCleaned);
-            papszTmpOpenOptions =
-                CSLSetNameValue(papszTmpOpenOptions, "OVERVIEW_LEVEL", nullptr);
-            oOpenInfo.papszOpenOptions = papszTmpOpenOptions;
-
-            papszOptionsToValidate = CSLDuplicate(papszOptionsToValidate);
-            papszOptionsToValidate = CSLSetNameValue(papszOptionsToValidate,
-                                                     "OVERVIEW_LEVEL", nullptr);
-            papszTmpOpenOptionsToValidate = papszOptionsToValidate;
+            if (CSLFetchNameValue(papszOpenOptionsCleaned, pszGenericOption) !=
+                    nullptr &&
+                !IsDriverSpecificOpenOption(poDriver, pszGenericOption))
+            {
+                if (papszTmpOpenOptions == nullptr)
+                {
+                    papszTmpOpenOptions = CSLDuplicate(papszOpenOptionsCleaned);
+                    papszTmpOpenOptionsToValidate =
+                        CSLDuplicate(papszOptionsToValidate);
+                }
+                papszTmpOpenOptions = CSLSetNameValue(
+                    papszTmpOpenOptions, pszGenericOption, nullptr);
+                papszTmpOpenOptionsToValidate = CSLSetNameValue(
+                    papszTmpOpenOptionsToValidate, pszGenericOption, nullptr);
+                oOpenInfo.papszOpenOptions = papszTmpOpenOptions;
+                papszOptionsToValidate = papszTmpOpenOptionsToValidate;
+            }
         }
 
+        const auto tIdentifyStart = std::chrono::steady_clock::now();
         const int nIdentifyRes =
             poDriver->pfnIdentifyEx
                 ? poDriver->pfnIdentifyEx(poDriver, &oOpenInfo)
             : poDriver->pfnIdentify ? poDriver->pfnIdentify(&oOpenInfo)
                                     : GDAL_IDENTIFY_UNKNOWN;
+        if (sIdentifyStats.bEnabled)
+        {
+            sIdentifyStats.nIdentified++;
+            sIdentifyStats.dfSeconds +=
+                std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - tIdentifyStart)
+                    .count();
+        }
         if (nIdentifyRes == FALSE)
         {
             CSLDestroy(papszTmpOpenOptions);
@@ -3785,6 +3978,15 @@ retry:
 
         if (poDS != nullptr)
         {
+            if (iPass == 3)
+            {
+                CPLDebug("GDAL",
+                         "Driver %s opened %s although it does not match "
+                         "its %s",
+                         poDriver->GetDescription(), pszFilename,
+                         GDAL_DMD_IDENTIFY_SIGNATURES);
+            }
+
             if (poDS->papszOpenOptions == nullptr)
             {
                 poDS->papszOpenOptions = papszOpenOptionsCleaned;
@@ -3795,10 +3997,7 @@ retry:
             // driver specific.
             if (CSLFetchNameValue(papszOpenOptions, "OVERVIEW_LEVEL") !=
                     nullptr &&
-                (poDriver->GetMetadataItem(GDAL_DMD_OPENOPTIONLIST) ==
-                     nullptr ||
-                 CPLString(poDriver->GetMetadataItem(GDAL_DMD_OPENOPTIONLIST))
-                         .ifind("OVERVIEW_LEVEL") == std::string::npos))
+                !IsDriverSpecificOpenOption(poDriver, "OVERVIEW_LEVEL"))
             {
                 CPLString osVal(
                     CSLFetchNameValue(papszOpenOptions, "OVERVIEW_LEVEL"));
@@ -3868,6 +4067,11 @@ retry:
                 }
             }
 
+            // Deal with generic CACHE_BUDGET and CACHE_PRIORITY open options,
+            // unless they are driver specific.
+            if (poDS)
+                ApplyCacheBudgetOpenOptions(poDS, poDriver, papszOpenOptions);
+
             VSIErrorReset();
 
             CSLDestroy(papszOpenOptionsCleaned);
@@ -3914,6 +4118,15 @@ retry:
     {
         CPLDebugOnly("GDAL", "GDALOpen(): Second pass");
         iPass = 2;
+        papoPassDrivers = &apoSecondPassDrivers;
+        goto retry;
+    }
+
+    if (iPass < 3 && !apoSkippedDrivers.empty())
+    {
+        CPLDebugOnly("GDAL", "GDALOpen(): Third pass");
+        iPass = 3;
+        papoPassDrivers = &apoSkippedDrivers;
         goto retry;
     }
 
@@ -9922,3 +10135,449 @@ CPLErr GDALDatasetReadCompressedData(GDALDatasetH hDS, const char *pszFormat,
         pszFormat, nXOff, nYOff, nXSize, nYSize, nBandCount, panBandList,
         ppBuffer, pnBufferSize, ppszDetailedFormat);
 }
+
+/************************************************************************/
+/*                           SetCacheBudget()                           */
+/************************************************************************/
+
+/**
+ * \brief Set the budget and priority of the dataset in the block cache.
+ *
+ * By default, blocks of all datasets share the global block cache, whose
+ * size is set by GDAL_CACHEMAX / GDALSetCacheMax64(), on a least recently
+ * used basis.
+ *
+ * When nMaxBytes is not zero, the blocks of the bands of this dataset cannot
+ * use more than nMaxBytes of the block cache: when a new block would make the
+ * dataset exceed its budget, the least recently used blocks of this dataset
+ * are evicted first, and blocks of other datasets are left untouched.
+ *
+ * When blocks must be evicted to respect the global cache size, blocks of
+ * datasets with a priority strictly higher than the one of the dataset that
+ * requests a new block are only evicted if no other block can be. This can
+ * be used to keep the hot blocks of a dataset cached while other datasets
+ * are processed.
+ *
+ * The budget can also be set with the CACHE_BUDGET and CACHE_PRIORITY open
+ * options of GDALOpenEx().
+ *
+ * This is the same as the C function GDALDatasetSetCacheBudget().
+ *
+ * @param nMaxBytes Maximum number of bytes of the block cache that the
+ *                  dataset may use, or 0 for no specific limit.
+ * @param nPriority Eviction priority. Default is 0.
+ * @return CE_None in case of success.
+ * @since GDAL 3.9
+ */
+
+CPLErr GDALDataset::SetCacheBudget(GIntBig nMaxBytes, int nPriority)
+{
+    if (nMaxBytes < 0)
+    {
+        ReportError(CE_Failure, CPLE_IllegalArg,
+                    "SetCacheBudget(): nMaxBytes should be positive or zero");
+        return CE_Failure;
+    }
+    const auto &poState = GetBlockCacheState();
+    if (!poState)
+        return CE_Failure;
+    poState->nBudget = nMaxBytes;
+    poState->nPriority = nPriority;
+    return CE_None;
+}
+
+/************************************************************************/
+/*                      GDALDatasetSetCacheBudget()                     */
+/************************************************************************/
+
+/**
+ * \brief Set the budget and priority of the dataset in the block cache.
+ *
+ * This is the same as the C++ method GDALDataset::SetCacheBudget().
+ *
+ * @since GDAL 3.9
+ */
+
+CPLErr GDALDatasetSetCacheBudget(GDALDatasetH hDS, GIntBig nMaxBytes,
+                                 int nPriority)
+{
+    VALIDATE_POINTER1(hDS, __func__, CE_Failure);
+    return GDALDataset::FromHandle(hDS)->SetCacheBudget(nMaxBytes, nPriority);
+}
+
+/************************************************************************/
+/*                           GetCacheBudget()                           */
+/************************************************************************/
+
+/**
+ * \brief Return the budget and priority of the dataset in the block cache.
+ *
+ * @param[out] pnPriority Pointer to the priority, or nullptr.
+ * @return the budget set with SetCacheBudget() (0 if unlimited).
+ * @since GDAL 3.9
+ */
+
+GIntBig GDALDataset::GetCacheBudget(int *pnPriority) const
+{
+    const auto &poState = GetBlockCacheState();
+    if (pnPriority)
+        *pnPriority = poState ? poState->nPriority.load() : 0;
+    return poState ? poState->nBudget.load() : 0;
+}
+
+/************************************************************************/
+/*                         GetCacheStatistics()                         */
+/************************************************************************/
+
+/**
+ * \brief Return statistics on the use of the block cache by the dataset.
+ *
+ * The counters cover the blocks of all the bands whose GetDataset() is this
+ * dataset, including mask bands and overview bands of internal overviews
+ * for drivers where they are attached to this dataset.
+ *
+ * This is the same as the C function GDALDatasetGetCacheStatistics().
+ *
+ * @param[out] pnUsedBytes Pointer to the number of bytes currently used in the
+ *                         block cache, or nullptr.
+ * @param[out] pnHits Pointer to the number of block requests satisfied by
+ *                    the cache, or nullptr.
+ * @param[out] pnMisses Pointer to the number of block requests that required
+ *                      a new block to be allocated, or nullptr.
+ * @param[out] pnEvictions Pointer to the number of blocks of this dataset
+ *                         evicted by the block cache to make room for other
+ *                         blocks, or nullptr.
+ * @param[out] pnDirtyFlushes Pointer to the number of evicted blocks that had
+ *                            to be written because they were dirty, or
+ *                            nullptr.
+ * @since GDAL 3.9
+ * @see GDALRasterBand::GetCacheStatistics(), GDALGetCacheStatistics()
+ */
+
+void GDALDataset::GetCacheStatistics(GIntBig *pnUsedBytes, GIntBig *pnHits,
+                                     GIntBig *pnMisses, GIntBig *pnEvictions,
+                                     GIntBig *pnDirtyFlushes) const
+{
+    const auto &poState = GetBlockCacheState();
+    if (pnUsedBytes)
+        *pnUsedBytes = poState ? poState->nUsedBytes.load() : 0;
+    if (pnHits)
+        *pnHits = poState ? poState->nHits.load() : 0;
+    if (pnMisses)
+        *pnMisses = poState ? poState->nMisses.load() : 0;
+    if (pnEvictions)
+        *pnEvictions = poState ? poState->nEvictions.load() : 0;
+    if (pnDirtyFlushes)
+        *pnDirtyFlushes = poState ? poState->nDirtyFlushes.load() : 0;
+}
+
+/************************************************************************/
+/*                    GDALDatasetGetCacheStatistics()                   */
+/************************************************************************/
+
+/**
+ * \brief Return statistics on the use of the block cache by the dataset.
+ *
+ * This is the same as the C++ method GDALDataset::GetCacheStatistics().
+ *
+ * @since GDAL 3.9
+ */
+
+void GDALDatasetGetCacheStatistics(GDALDatasetH hDS, GIntBig *pnUsedBytes,
+                                   GIntBig *pnHits, GIntBig *pnMisses,
+                                   GIntBig *pnEvictions,
+                                   GIntBig *pnDirtyFlushes)
+{
+    VALIDATE_POINTER0(hDS, __func__);
+    GDALDataset::FromHandle(hDS)->GetCacheStatistics(
+        pnUsedBytes, pnHits, pnMisses, pnEvictions, pnDirtyFlushes);
+}
+
+/************************************************************************/
+/*                        GetBlockCacheState()                          */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+const std::shared_ptr<GDALDatasetBlockCacheState> &
+GDALDataset::GetBlockCacheState() const
+{
+    static const std::shared_ptr<GDALDatasetBlockCacheState> nullState;
+    return m_poPrivate ? m_poPrivate->poBlockCacheState : nullState;
+}
+//! @endcond
+
+/************************************************************************/
+/*                           AccountMemory()                            */
+/************************************************************************/
+
+/**
+ * \brief Account for memory allocated, or released, by the driver on behalf
+ * of the dataset.
+ *
+ * Drivers should call this method for the large buffers they keep outside of
+ * the block cache, such as compression queues or caches of decoded chunks, so
+ * that they are reported by GetMemoryUsage(), CPLGetAccountedMemory() and
+ * GDALGetResidentMemoryUsage(), and subject to the budget set with
+ * SetMemoryBudget() and to the GDAL_MEMORY_LIMIT configuration option.
+ *
+ * When an allocation makes the dataset exceed its budget, or GDAL exceed
+ * GDAL_MEMORY_LIMIT, TrimMemory() is called to give the driver a chance to
+ * release memory. Drivers must thus not call this method with a positive
+ * nDeltaBytes while being in a state where TrimMemory() cannot run.
+ *
+ * Memory still accounted when the dataset is destroyed is considered as
+ * released.
+ *
+ * @param pszCategory Name of the category of the allocation, of the form
+ *                    "{driver}.{buffer_kind}", such as
+ *                    "GTiff.compression_queue". Must not be NULL.
+ * @param nDeltaBytes Number of bytes allocated (positive value) or released
+ *                    (negative value).
+ * @since GDAL 3.9
+ * @see CPLAccountMemory()
+ */
+
+void GDALDataset::AccountMemory(const char *pszCategory, GIntBig nDeltaBytes)
+{
+    if (!m_poPrivate || nDeltaBytes == 0)
+        return;
+    {
+        std::lock_guard<std::mutex> oLock(m_poPrivate->oMemoryMutex);
+        auto &nBytes = m_poPrivate->oMapMemoryCategoryToBytes[pszCategory];
+        nBytes += nDeltaBytes;
+        CPLAssert(nBytes >= 0);
+        if (nBytes == 0)
+            m_poPrivate->oMapMemoryCategoryToBytes.erase(pszCategory);
+    }
+    m_poPrivate->nMemoryUsage += nDeltaBytes;
+    CPLAccountMemory(pszCategory, nDeltaBytes);
+    if (nDeltaBytes < 0)
+        return;
+
+    // Enforcement of the budget of the dataset and of the global limit
+    GIntBig nExcess = 0;
+    const GIntBig nBudget = m_poPrivate->nMemoryBudget;
+    if (nBudget > 0)
+        nExcess = m_poPrivate->nMemoryUsage - nBudget;
+    const GIntBig nLimit = GDALGetMemoryLimit();
+    if (nLimit > 0)
+        nExcess = std::max(nExcess, GDALGetResidentMemoryUsage() - nLimit);
+    if (nExcess > 0 && !m_poPrivate->bTrimmingMemory.exchange(true))
+    {
+        const GIntBig nReleased = TrimMemory(nExcess);
+        m_poPrivate->bTrimmingMemory = false;
+        if (nReleased < nExcess)
+        {
+            CPLDebug("GDAL",
+                     "%s: " CPL_FRMT_GIB " bytes over the memory budget or "
+                     "limit could not be released",
+                     GetDescription(), nExcess - nReleased);
+        }
+    }
+}
+
+/************************************************************************/
+/*                           GetMemoryUsage()                           */
+/************************************************************************/
+
+/**
+ * \brief Return the memory accounted by the driver with AccountMemory().
+ *
+ * This does not include the blocks of the dataset in the block cache, which
+ * are reported by GetCacheStatistics().
+ *
+ * This is the same as the C function GDALDatasetGetMemoryUsage(), when
+ * pszCategory is NULL.
+ *
+ * @param pszCategory Name of a category, or nullptr for all categories.
+ * @return a number of bytes.
+ * @since GDAL 3.9
+ */
+
+GIntBig GDALDataset::GetMemoryUsage(const char *pszCategory) const
+{
+    if (!m_poPrivate)
+        return 0;
+    if (pszCategory == nullptr)
+        return m_poPrivate->nMemoryUsage;
+    std::lock_guard<std::mutex> oLock(m_poPrivate->oMemoryMutex);
+    const auto oIter =
+        m_poPrivate->oMapMemoryCategoryToBytes.find(pszCategory);
+    return oIter == m_poPrivate->oMapMemoryCategoryToBytes.end()
+               ? 0
+               : oIter->second;
+}
+
+/************************************************************************/
+/*                      GDALDatasetGetMemoryUsage()                     */
+/************************************************************************/
+
+/**
+ * \brief Return the memory accounted by the driver for the dataset.
+ *
+ * This is the same as the C++ method GDALDataset::GetMemoryUsage().
+ *
+ * @since GDAL 3.9
+ */
+
+GIntBig GDALDatasetGetMemoryUsage(GDALDatasetH hDS)
+{
+    VALIDATE_POINTER1(hDS, __func__, 0);
+    return GDALDataset::FromHandle(hDS)->GetMemoryUsage();
+}
+
+/************************************************************************/
+/*                           SetMemoryBudget()                          */
+/************************************************************************/
+
+/**
+ * \brief Set the maximum memory the driver should use for the dataset,
+ * outside of the block cache.
+ *
+ * When memory accounted with AccountMemory() exceeds the budget,
+ * TrimMemory() is called. Whether the budget can actually be respected
+ * depends on the driver.
+ *
+ * The budget of the dataset in the block cache is set separately, with
+ * SetCacheBudget().
+ *
+ * This is the same as the C function GDALDatasetSetMemoryBudget().
+ *
+ * @param nMaxBytes Maximum number of bytes, or 0 for no specific limit.
+ * @return CE_None in case of success.
+ * @since GDAL 3.9
+ */
+
+CPLErr GDALDataset::SetMemoryBudget(GIntBig nMaxBytes)
+{
+    if (nMaxBytes < 0)
+    {
+        ReportError(CE_Failure, CPLE_IllegalArg,
+                    "SetMemoryBudget(): nMaxBytes should be positive or zero");
+        return CE_Failure;
+    }
+    if (!m_poPrivate)
+        return CE_Failure;
+    m_poPrivate->nMemoryBudget = nMaxBytes;
+    return CE_None;
+}
+
+/************************************************************************/
+/*                     GDALDatasetSetMemoryBudget()                     */
+/************************************************************************/
+
+/**
+ * \brief Set the maximum memory the driver should use for the dataset,
+ * outside of the block cache.
+ *
+ * This is the same as the C++ method GDALDataset::SetMemoryBudget().
+ *
+ * @since GDAL 3.9
+ */
+
+CPLErr GDALDatasetSetMemoryBudget(GDALDatasetH hDS, GIntBig nMaxBytes)
+{
+    VALIDATE_POINTER1(hDS, __func__, CE_Failure);
+    return GDALDataset::FromHandle(hDS)->SetMemoryBudget(nMaxBytes);
+}
+
+/************************************************************************/
+/*                           GetMemoryBudget()                          */
+/************************************************************************/
+
+/**
+ * \brief Return the budget set with SetMemoryBudget().
+ *
+ * @return a number of bytes, or 0 if unlimited.
+ * @since GDAL 3.9
+ */
+
+GIntBig GDALDataset::GetMemoryBudget() const
+{
+    return m_poPrivate ? m_poPrivate->nMemoryBudget.load() : 0;
+}
+
+/************************************************************************/
+/*                             TrimMemory()                             */
+/************************************************************************/
+
+/**
+ * \brief Release memory accounted with AccountMemory().
+ *
+ * This method is called by AccountMemory() when the dataset exceeds the
+ * budget set with SetMemoryBudget(), or GDAL exceeds the GDAL_MEMORY_LIMIT
+ * configuration option. Drivers may override it to drop caches or to wait
+ * for the completion of pending jobs. It is called from the thread that
+ * uses the dataset.
+ *
+ * The default implementation does nothing.
+ *
+ * @param nBytesToRelease Number of bytes that should be released.
+ * @return the number of bytes actually released.
+ * @since GDAL 3.9
+ */
+
+GIntBig GDALDataset::TrimMemory(CPL_UNUSED GIntBig nBytesToRelease)
+{
+    return 0;
+}
+
+/************************************************************************/
+/*                     GDALGetResidentMemoryUsage()                     */
+/************************************************************************/
+
+/**
+ * \brief Return the memory used by GDAL for caches and buffers.
+ *
+ * This is the sum of the memory used by the block cache
+ * (GDALGetCacheUsed64()) and of the memory accounted by drivers and virtual
+ * file systems with GDALDataset::AccountMemory() and CPLAccountMemory().
+ * The breakdown per category of the latter is returned by
+ * CPLGetAccountedMemoryCategories().
+ *
+ * @return a number of bytes.
+ * @since GDAL 3.9
+ */
+
+GIntBig GDALGetResidentMemoryUsage(void)
+{
+    return GDALGetCacheUsed64() + CPLGetAccountedMemory(nullptr);
+}
+
+/************************************************************************/
+/*                          GDALGetMemoryLimit()                        */
+/************************************************************************/
+
+/**
+ * \brief Return the value of the GDAL_MEMORY_LIMIT configuration option.
+ *
+ * GDAL_MEMORY_LIMIT is a limit on GDALGetResidentMemoryUsage() that is
+ * enforced when drivers account for new allocations with
+ * GDALDataset::AccountMemory(), by calling GDALDataset::TrimMemory(). It
+ * follows the conventions of GDAL_CACHEMAX: a value lower than 100000 is
+ * expressed in megabytes, a value with a % suffix is a percentage of the
+ * usable physical RAM, and other values are in bytes.
+ *
+ * @return a number of bytes, or 0 if there is no limit.
+ * @since GDAL 3.9
+ */
+
+GIntBig GDALGetMemoryLimit(void)
+{
+    static CPLConfigOptionCache oMemoryLimit("GDAL_MEMORY_LIMIT", nullptr);
+    const char *pszLimit = oMemoryLimit.Get();
+    if (pszLimit == nullptr || pszLimit[0] == '\0')
+        return 0;
+    if (strchr(pszLimit, '%') != nullptr)
+    {
+        const double dfLimit =
+            static_cast<double>(CPLGetUsablePhysicalRAM()) *
+            CPLAtof(pszLimit) / 100.0;
+        return dfLimit > 0 && dfLimit < 1e15 ? static_cast<GIntBig>(dfLimit)
+                                             : 0;
+    }
+    const GIntBig nLimit = CPLAtoGIntBig(pszLimit);
+    if (nLimit < 0)
+        return 0;
+    return nLimit < 100000 ? nLimit * 1024 * 1024 : nLimit;
+}
@@ -1,8 +1,8 @@
 /******************************************************************************
  *
  * Project:  GDAL Core
- * Purpose:  Implementation of GDALDefaultAsyncReader and the
- *           GDALAsyncReader base class.
+ * Purpose:  Implementation of GDALDefaultAsyncReader, the
+ *           GDALAsyncReader base class and GDALDataset::RasterIOAsync().
  * Author:   Frank Warmerdam, warmerdam@pobox.com
  *
  ******************************************************************************
@@ -30,12 +30,18 @@
 #include "cpl_port.h"
 #include "gdal_priv.h"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
+#include <mutex>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
+#include "gdal_thread_pool.h"
 
 CPL_C_START
 GDALAsyncReader *GDALGetDefaultAsyncReader(GDALDataset *poDS, int nXOff,
@@ -378,3 +384,499 @@ GDALDefaultAsyncReader::GetNextUpdatedRegion(double /*dfTimeout*/,
     else
         return GARIO_ERROR;
 }
+
+/************************************************************************/
+/* ==================================================================== */
+/*                      GDALRasterIOAsyncRequest                        */
+/* ==================================================================== */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+struct GDALRasterIOAsyncRequest::Private
+{
+    std::vector<Job> apfnJobs{};
+    bool bJobsAreIndependent = false;
+
+    std::mutex oMutex{};
+    std::condition_variable oCV{};
+    bool bStarted = false;
+    size_t nFinishedJobs = 0;
+    bool bError = false;
+    std::atomic<size_t> nNextJob{0};
+    std::atomic<bool> bCancelled{false};
+
+    bool IsFinished() const
+    {
+        return nFinishedJobs == apfnJobs.size();
+    }
+
+    void RunJob(size_t iJob);
+    static void SerialJobsFunc(void *pData);
+    static void IndependentJobFunc(void *pData);
+};
+
+/************************************************************************/
+/*                               RunJob()                               */
+/************************************************************************/
+
+void GDALRasterIOAsyncRequest::Private::RunJob(size_t iJob)
+{
+    const bool bOK = !bCancelled && apfnJobs[iJob]() == CE_None;
+
+    // Notify while holding the mutex, since the waiter may destroy this
+    // object as soon as the last job is declared finished.
+    std::lock_guard<std::mutex> oLock(oMutex);
+    if (!bOK)
+        bError = true;
+    ++nFinishedJobs;
+    oCV.notify_all();
+}
+
+/************************************************************************/
+/*                          SerialJobsFunc()                            */
+/************************************************************************/
+
+void GDALRasterIOAsyncRequest::Private::SerialJobsFunc(void *pData)
+{
+    auto psPrivate = static_cast<Private *>(pData);
+    const size_t nJobs = psPrivate->apfnJobs.size();
+    for (size_t i = 0; i < nJobs; ++i)
+        psPrivate->RunJob(i);
+}
+
+/************************************************************************/
+/*                        IndependentJobFunc()                          */
+/************************************************************************/
+
+void GDALRasterIOAsyncRequest::Private::IndependentJobFunc(void *pData)
+{
+    auto psPrivate = static_cast<Private *>(pData);
+    psPrivate->RunJob(psPrivate->nNextJob++);
+}
+
+//! @endcond
+
+/************************************************************************/
+/*                      GDALRasterIOAsyncRequest()                      */
+/************************************************************************/
+
+/**
+ * \brief Constructor.
+ *
+ * Mostly of interest for drivers overriding GDALDataset::IRasterIOAsync().
+ *
+ * @param apfnJobs Jobs making the request. Each job returns CE_None on
+ * success.
+ * @param bJobsAreIndependent Whether jobs may be run concurrently and in any
+ * order. Otherwise they are run sequentially in the order of the vector.
+ * Independent jobs should not wait for the completion of other jobs of the
+ * global thread pool.
+ *
+ * @since GDAL 3.9
+ */
+GDALRasterIOAsyncRequest::GDALRasterIOAsyncRequest(std::vector<Job> &&apfnJobs,
+                                                   bool bJobsAreIndependent)
+    : m_poPrivate(std::make_unique<Private>())
+{
+    m_poPrivate->apfnJobs = std::move(apfnJobs);
+    m_poPrivate->bJobsAreIndependent = bJobsAreIndependent;
+}
+
+/************************************************************************/
+/*                     ~GDALRasterIOAsyncRequest()                      */
+/************************************************************************/
+
+/** Destructor.
+ *
+ * Jobs not yet started are cancelled, and the method waits for the
+ * completion of the ones in progress.
+ */
+GDALRasterIOAsyncRequest::~GDALRasterIOAsyncRequest()
+{
+    Cancel();
+    Wait();
+}
+
+/************************************************************************/
+/*                               Start()                                */
+/************************************************************************/
+
+/**
+ * \brief Submit the jobs of the request to the global thread pool.
+ *
+ * This is done by GDALDataset::RasterIOAsync(), and should not be called
+ * again by users.
+ *
+ * If the thread pool cannot be created, jobs are run synchronously.
+ *
+ * @param nThreads Maximum number of threads used for independent jobs.
+ * @return true if the jobs have been submitted, or run successfully.
+ * @since GDAL 3.9
+ */
+bool GDALRasterIOAsyncRequest::Start(int nThreads)
+{
+    auto psPrivate = m_poPrivate.get();
+    {
+        std::lock_guard<std::mutex> oLock(psPrivate->oMutex);
+        if (psPrivate->bStarted)
+            return false;
+        psPrivate->bStarted = true;
+    }
+
+    const size_t nJobs = psPrivate->apfnJobs.size();
+    if (nJobs == 0)
+        return true;
+
+    const bool bIndependent = psPrivate->bJobsAreIndependent && nJobs > 1;
+    auto poThreadPool = GDALGetGlobalThreadPool(
+        bIndependent
+            ? std::max(1, std::min(nThreads, static_cast<int>(
+                                                 std::min<size_t>(nJobs, 128))))
+            : 1);
+    if (poThreadPool == nullptr)
+    {
+        Private::SerialJobsFunc(psPrivate);
+        return !psPrivate->bError;
+    }
+
+    if (bIndependent)
+    {
+        const std::vector<void *> apData(nJobs, psPrivate);
+        if (!poThreadPool->SubmitJobs(Private::IndependentJobFunc, apData))
+        {
+            // Should not happen, but do not leave the request pending
+            // forever.
+            psPrivate->nNextJob = nJobs;
+            std::lock_guard<std::mutex> oLock(psPrivate->oMutex);
+            psPrivate->nFinishedJobs = nJobs;
+            psPrivate->bError = true;
+            return false;
+        }
+    }
+    else if (!poThreadPool->SubmitJob(Private::SerialJobsFunc, psPrivate))
+    {
+        Private::SerialJobsFunc(psPrivate);
+        return !psPrivate->bError;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                             GetStatus()                              */
+/************************************************************************/
+
+/**
+ * \brief Return the status of the request, without waiting.
+ *
+ * @return GARIO_PENDING if no job has completed yet, GARIO_UPDATE if some
+ * jobs have completed, GARIO_COMPLETE if all jobs have completed successfully,
+ * or GARIO_ERROR if all jobs have completed (or have been cancelled) and at
+ * least one of them failed.
+ * @since GDAL 3.9
+ */
+GDALAsyncStatusType GDALRasterIOAsyncRequest::GetStatus() const
+{
+    std::lock_guard<std::mutex> oLock(m_poPrivate->oMutex);
+    if (m_poPrivate->IsFinished())
+        return m_poPrivate->bError ? GARIO_ERROR : GARIO_COMPLETE;
+    return m_poPrivate->nFinishedJobs > 0 ? GARIO_UPDATE : GARIO_PENDING;
+}
+
+/************************************************************************/
+/*                                Wait()                                */
+/************************************************************************/
+
+/**
+ * \brief Wait for the completion of the request.
+ *
+ * @param dfTimeout Maximum number of seconds to wait, or -1 to wait
+ * indefinitely.
+ * @return the status of the request, as returned by GetStatus().
+ * @since GDAL 3.9
+ */
+GDALAsyncStatusType GDALRasterIOAsyncRequest::Wait(double dfTimeout)
+{
+    auto psPrivate = m_poPrivate.get();
+    const auto IsFinished = [psPrivate] { return psPrivate->IsFinished(); };
+    {
+        std::unique_lock<std::mutex> oLock(psPrivate->oMutex);
+        if (!psPrivate->bStarted)
+        {
+            // Never started: nothing will ever complete
+            if (!psPrivate->IsFinished())
+            {
+                psPrivate->nFinishedJobs = psPrivate->apfnJobs.size();
+                psPrivate->bError = true;
+            }
+        }
+        else if (dfTimeout < 0)
+        {
+            psPrivate->oCV.wait(oLock, IsFinished);
+        }
+        else
+        {
+            psPrivate->oCV.wait_for(
+                oLock, std::chrono::duration<double>(dfTimeout), IsFinished);
+        }
+    }
+    return GetStatus();
+}
+
+/************************************************************************/
+/*                            GetProgress()                             */
+/************************************************************************/
+
+/**
+ * \brief Return the ratio, between 0 and 1, of completed jobs.
+ * @since GDAL 3.9
+ */
+double GDALRasterIOAsyncRequest::GetProgress() const
+{
+    std::lock_guard<std::mutex> oLock(m_poPrivate->oMutex);
+    const size_t nJobs = m_poPrivate->apfnJobs.size();
+    return nJobs == 0 ? 1.0
+                      : static_cast<double>(m_poPrivate->nFinishedJobs) /
+                            static_cast<double>(nJobs);
+}
+
+/************************************************************************/
+/*                               Cancel()                               */
+/************************************************************************/
+
+/**
+ * \brief Cancel the jobs of the request that have not started yet.
+ *
+ * Wait() should still be called to make sure that jobs in progress have
+ * completed before the buffer is released. The request will then be
+ * reported in the GARIO_ERROR state, unless all jobs had already completed.
+ * @since GDAL 3.9
+ */
+void GDALRasterIOAsyncRequest::Cancel()
+{
+    m_poPrivate->bCancelled = true;
+}
+
+/************************************************************************/
+/*                           RasterIOAsync()                            */
+/************************************************************************/
+
+/**
+ * \brief Start an asynchronous read/write of a region of image data from
+ * multiple bands.
+ *
+ * This method takes the same arguments as GDALDataset::RasterIO(), but
+ * returns immediately a request handle. The request is split into jobs that
+ * run on the global GDAL thread pool. GDALRasterIOAsyncRequest::Wait() or
+ * GDALRasterIOAsyncRequest::GetStatus() may be used to wait for, or poll,
+ * its completion.
+ *
+ * In the default implementation, a non-resampled request is split into
+ * chunks aligned on the block height of the first band, which are processed
+ * sequentially. For reads, AdviseRead() is called on the whole window at
+ * the beginning of the processing, so that drivers able to prefetch data get
+ * a chance to do it while chunks are decoded. Drivers may override
+ * IRasterIOAsync() to submit jobs that can run in parallel.
+ * The GDAL_NUM_THREADS configuration option (integer or ALL_CPUS) caps the
+ * number of threads used for such parallel jobs.
+ *
+ * Until the request has completed, the dataset must not be accessed or
+ * destroyed, and the buffer must be kept alive. The pfnProgress member of
+ * psExtraArg is ignored: GDALRasterIOAsyncRequest::GetProgress() should be
+ * used instead.
+ *
+ * @return a request handle (whose status may already be GARIO_COMPLETE for
+ * empty requests), or nullptr in case of invalid arguments.
+ * @since GDAL 3.9
+ */
+std::unique_ptr<GDALRasterIOAsyncRequest> GDALDataset::RasterIOAsync(
+    GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
+    void *pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+    int nBandCount, const int *panBandMap, GSpacing nPixelSpace,
+    GSpacing nLineSpace, GSpacing nBandSpace, GDALRasterIOExtraArg *psExtraArg)
+{
+    GDALRasterIOExtraArg sExtraArg;
+    if (psExtraArg == nullptr)
+    {
+        INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+    }
+    else if (psExtraArg->nVersion != RASTERIO_EXTRA_ARG_CURRENT_VERSION)
+    {
+        ReportError(CE_Failure, CPLE_AppDefined,
+                    "Unhandled version of GDALRasterIOExtraArg");
+        return nullptr;
+    }
+    else
+    {
+        sExtraArg = *psExtraArg;
+    }
+    sExtraArg.pfnProgress = nullptr;
+    sExtraArg.pProgressData = nullptr;
+
+    if (nullptr == pData)
+    {
+        ReportError(CE_Failure, CPLE_AppDefined,
+                    "The buffer into which the data should be read is null");
+        return nullptr;
+    }
+
+    if (eRWFlag != GF_Read && eRWFlag != GF_Write)
+    {
+        ReportError(
+            CE_Failure, CPLE_IllegalArg,
+            "eRWFlag = %d, only GF_Read (0) and GF_Write (1) are legal.",
+            eRWFlag);
+        return nullptr;
+    }
+
+    if (eRWFlag == GF_Write && eAccess != GA_Update)
+    {
+        ReportError(CE_Failure, CPLE_AppDefined,
+                    "Write operation not permitted on dataset opened "
+                    "in read-only mode");
+        return nullptr;
+    }
+
+    int bStopProcessing = FALSE;
+    if (ValidateRasterIOOrAdviseReadParameters(
+            "RasterIOAsync()", &bStopProcessing, nXOff, nYOff, nXSize, nYSize,
+            nBufXSize, nBufYSize, nBandCount,
+            const_cast<int *>(panBandMap)) != CE_None)
+    {
+        return nullptr;
+    }
+    if (bStopProcessing || nBandCount <= 0)
+    {
+        auto poRequest = std::make_unique<GDALRasterIOAsyncRequest>(
+            std::vector<GDALRasterIOAsyncRequest::Job>(), false);
+        poRequest->Start(1);
+        return poRequest;
+    }
+
+    if (nPixelSpace == 0)
+        nPixelSpace = GDALGetDataTypeSizeBytes(eBufType);
+    if (nLineSpace == 0)
+        nLineSpace = nPixelSpace * nBufXSize;
+    if (nBandSpace == 0 && nBandCount > 1)
+        nBandSpace = nLineSpace * nBufYSize;
+
+    std::vector<int> anBandMap;
+    if (panBandMap == nullptr)
+    {
+        for (int i = 0; i < nBandCount; ++i)
+            anBandMap.push_back(i + 1);
+        panBandMap = anBandMap.data();
+    }
+
+    auto poRequest = IRasterIOAsync(eRWFlag, nXOff, nYOff, nXSize, nYSize,
+                                    pData, nBufXSize, nBufYSize, eBufType,
+                                    nBandCount, panBandMap, nPixelSpace,
+                                    nLineSpace, nBandSpace, &sExtraArg);
+    if (poRequest)
+    {
+        const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+        const int nThreads =
+            std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                          ? CPLGetNumCPUs()
+                                          : atoi(pszThreads)));
+        poRequest->Start(nThreads);
+    }
+    return poRequest;
+}
+
+/************************************************************************/
+/*                           IRasterIOAsync()                           */
+/************************************************************************/
+
+/**
+ * \brief Build the jobs of an asynchronous RasterIO() request.
+ *
+ * Called by RasterIOAsync() once arguments have been validated, spacings
+ * have been resolved and panBandMap has been set. The returned request is
+ * started by RasterIOAsync().
+ *
+ * The default implementation builds sequential jobs calling RasterIO().
+ * Drivers that can decode several parts of a request concurrently (for
+ * example with one file handle per thread) may override it and return a
+ * request with independent jobs.
+ *
+ * @since GDAL 3.9
+ */
+std::unique_ptr<GDALRasterIOAsyncRequest> GDALDataset::IRasterIOAsync(
+    GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
+    void *pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+    int nBandCount, const int *panBandMap, GSpacing nPixelSpace,
+    GSpacing nLineSpace, GSpacing nBandSpace,
+    const GDALRasterIOExtraArg *psExtraArg)
+{
+    std::vector<GDALRasterIOAsyncRequest::Job> apfnJobs;
+    std::vector<int> anBandMap(panBandMap, panBandMap + nBandCount);
+
+    const auto RasterIOJob = [this, eRWFlag, nXOff, nXSize, nBufXSize, eBufType,
+                              nBandCount, anBandMap, nPixelSpace, nLineSpace,
+                              nBandSpace,
+                              sExtraArg = *psExtraArg](int nJobYOff,
+                                                       int nJobYSize,
+                                                       int nJobBufYSize,
+                                                       GByte *pabyJobData)
+    {
+        return [this, eRWFlag, nXOff, nXSize, nBufXSize, eBufType, nBandCount,
+                anBandMap, nPixelSpace, nLineSpace, nBandSpace, sExtraArg,
+                nJobYOff, nJobYSize, nJobBufYSize, pabyJobData]() mutable
+        {
+            return RasterIO(eRWFlag, nXOff, nJobYOff, nXSize, nJobYSize,
+                            pabyJobData, nBufXSize, nJobBufYSize, eBufType,
+                            nBandCount, anBandMap.data(), nPixelSpace,
+                            nLineSpace, nBandSpace, &sExtraArg);
+        };
+    };
+
+    GByte *pabyData = static_cast<GByte *>(pData);
+    if (nXSize != nBufXSize || nYSize != nBufYSize)
+    {
+        apfnJobs.emplace_back(RasterIOJob(nYOff, nYSize, nBufYSize, pabyData));
+        return std::make_unique<GDALRasterIOAsyncRequest>(std::move(apfnJobs),
+                                                          false);
+    }
+
+    // Chunks are made of whole block rows, and of at least about 1 MB, to
+    // keep the overhead of each RasterIO() call low.
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    GetRasterBand(panBandMap[0])->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    nBlockYSize = std::max(1, nBlockYSize);
+    const GIntBig nBytesPerBlockRow =
+        std::max<GIntBig>(1, static_cast<GIntBig>(nXSize) * nBlockYSize *
+                                 nBandCount *
+                                 GDALGetDataTypeSizeBytes(eBufType));
+    constexpr GIntBig MIN_CHUNK_BYTES = 1024 * 1024;
+    const int nChunkYSize = static_cast<int>(std::min<GIntBig>(
+        nRasterYSize,
+        static_cast<GIntBig>(nBlockYSize) *
+            std::max<GIntBig>(1, MIN_CHUNK_BYTES / nBytesPerBlockRow)));
+
+    if (eRWFlag == GF_Read && nYSize > nChunkYSize)
+    {
+        apfnJobs.emplace_back(
+            [this, nXOff, nYOff, nXSize, nYSize, eBufType, anBandMap]() mutable
+            {
+                AdviseRead(nXOff, nYOff, nXSize, nYSize, nXSize, nYSize,
+                           eBufType, static_cast<int>(anBandMap.size()),
+                           anBandMap.data(), nullptr);
+                return CE_None;
+            });
+    }
+
+    for (int iY = nYOff; iY < nYOff + nYSize;)
+    {
+        const int nChunkEnd = static_cast<int>(std::min<GIntBig>(
+            nYOff + nYSize,
+            (static_cast<GIntBig>(iY / nChunkYSize) + 1) * nChunkYSize));
+        apfnJobs.emplace_back(
+            RasterIOJob(iY, nChunkEnd - iY, nChunkEnd - iY,
+                        pabyData + (iY - nYOff) * nLineSpace));
+        iY = nChunkEnd;
+    }
+
+    return std::make_unique<GDALRasterIOAsyncRequest>(std::move(apfnJobs),
+                                                      false);
+}
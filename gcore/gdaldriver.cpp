@@ -2754,9 +2754,11 @@ GDALDriverH CPL_STDCALL GDALIdentifyDriverEx(
         }
 
         GDALDataset *poDS;
-        if (poDriver->pfnOpen != nullptr)
+        // GetOpenCallback() triggers the loading of deferred drivers
+        const auto pfnOpen = poDriver->GetOpenCallback();
+        if (pfnOpen != nullptr)
         {
-            poDS = poDriver->pfnOpen(&oOpenInfo);
+            poDS = pfnOpen(&oOpenInfo);
             if (poDS != nullptr)
             {
                 delete poDS;
@@ -31,6 +31,7 @@
 #include "gdal_priv.h"
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 #include <map>
 #include <set>
@@ -253,6 +254,18 @@ GDALDriverManager::~GDALDriverManager()
     /* -------------------------------------------------------------------- */
     OSRCleanup();
 
+    /* -------------------------------------------------------------------- */
+    /*      Report the I/O statistics of the virtual file systems, as       */
+    /*      requested by the --vsi-stats switch, now that all datasets      */
+    /*      are closed.                                                     */
+    /* -------------------------------------------------------------------- */
+    if (CPLTestBool(CPLGetConfigOption("CPL_VSIL_SHOW_STATISTICS", "NO")))
+    {
+        char *pszStats = VSIGetStatisticsAsSerializedJSON(nullptr, nullptr);
+        fprintf(stderr, "%s\n", pszStats); /*ok*/
+        VSIFree(pszStats);
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Blow away all the finder hints paths.  We really should not     */
     /*      be doing all of them, but it is currently hard to keep track    */
@@ -541,6 +554,8 @@ int GDALDriverManager::RegisterDriver(GDALDriver *poDriver, bool bHidden)
         return -1;
     }
 
+    m_poProbeTable.reset();
+
     /* -------------------------------------------------------------------- */
     /*      Otherwise grow the list to hold the new entry.                  */
     /* -------------------------------------------------------------------- */
@@ -616,6 +631,7 @@ void GDALDriverManager::DeregisterDriver(GDALDriver *poDriver)
     if (i == nDrivers)
         return;
 
+    m_poProbeTable.reset();
     oMapNameToDrivers.erase(CPLString(poDriver->GetDescription()).toupper());
     --nDrivers;
     // Move all following drivers down by one to pack the list.
@@ -1216,9 +1232,207 @@ void GDALDriverManager::ReorderDrivers()
         CPLAssert(oIter != oMapNameToDrivers.end());
         papoDrivers[i] = oIter->second;
     }
+    m_poProbeTable.reset();
 #endif
 }
 
+/************************************************************************/
+/*                     GDALDriverManager::ProbeTable                    */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+
+// Index of the GDAL_DMD_IDENTIFY_SIGNATURES items declared by drivers,
+// indexed as GetDriver(iDriver, /*bIncludeHidden=*/true).
+struct GDALDriverManager::ProbeTable
+{
+    struct Magic
+    {
+        int nOffset = 0;
+        std::string osBytes{};
+        int iDriver = 0;
+    };
+
+    int nDriversWithSignatures = 0;
+    std::vector<bool> abAlwaysProbe{};
+    // Magic bytes at offset 0, indexed by their first byte.
+    std::array<std::vector<Magic>, 256> aaoMagicsAtStart{};
+    std::vector<Magic> aoOtherMagics{};
+    // Lower case extension to driver indices.
+    std::map<std::string, std::vector<int>> oMapExtensions{};
+    std::vector<std::pair<std::string, int>> aoPrefixes{};
+
+    bool AddSignatures(int iDriver, const char *pszSignatures);
+};
+
+/************************************************************************/
+/*                           AddSignatures()                            */
+/************************************************************************/
+
+bool GDALDriverManager::ProbeTable::AddSignatures(int iDriver,
+                                                   const char *pszSignatures)
+{
+    const CPLStringList aosTokens(CSLTokenizeString(pszSignatures));
+    std::vector<Magic> aoMagics;
+    std::vector<std::string> aosExtensions;
+    std::vector<std::string> aosPrefixes;
+    for (const char *pszToken : aosTokens)
+    {
+        if (STARTS_WITH_CI(pszToken, "magic:"))
+        {
+            const char *pszOffset = pszToken + strlen("magic:");
+            const char *pszHex = strchr(pszOffset, ':');
+            if (pszHex == nullptr)
+                return false;
+            ++pszHex;
+            int nBytes = 0;
+            GByte *pabyBytes = CPLHexToBinary(pszHex, &nBytes);
+            Magic oMagic;
+            oMagic.nOffset = atoi(pszOffset);
+            oMagic.osBytes.assign(reinterpret_cast<const char *>(pabyBytes),
+                                  nBytes);
+            oMagic.iDriver = iDriver;
+            CPLFree(pabyBytes);
+            if (oMagic.nOffset < 0 || nBytes == 0 ||
+                strlen(pszHex) != 2 * static_cast<size_t>(nBytes))
+                return false;
+            aoMagics.push_back(std::move(oMagic));
+        }
+        else if (STARTS_WITH_CI(pszToken, "ext:") && pszToken[4])
+        {
+            aosExtensions.push_back(CPLString(pszToken + 4).tolower());
+        }
+        else if (STARTS_WITH_CI(pszToken, "prefix:") && pszToken[7])
+        {
+            aosPrefixes.push_back(pszToken + 7);
+        }
+        else
+        {
+            return false;
+        }
+    }
+    if (aosTokens.empty())
+        return false;
+
+    for (auto &oMagic : aoMagics)
+    {
+        if (oMagic.nOffset == 0)
+            aaoMagicsAtStart[static_cast<GByte>(oMagic.osBytes[0])].push_back(
+                std::move(oMagic));
+        else
+            aoOtherMagics.push_back(std::move(oMagic));
+    }
+    for (const auto &osExt : aosExtensions)
+        oMapExtensions[osExt].push_back(iDriver);
+    for (auto &osPrefix : aosPrefixes)
+        aoPrefixes.emplace_back(std::move(osPrefix), iDriver);
+    ++nDriversWithSignatures;
+    return true;
+}
+
+/************************************************************************/
+/*                      GetOpenCandidateDrivers()                       */
+/************************************************************************/
+
+/** Return, for each driver indexed as GetDriver(i, true), whether it must be
+ * probed by GDALOpenEx() for the passed dataset, according to the
+ * GDAL_DMD_IDENTIFY_SIGNATURES it declares.
+ *
+ * An empty vector means that all drivers must be probed.
+ */
+std::vector<bool>
+GDALDriverManager::GetOpenCandidateDrivers(const GDALOpenInfo *poOpenInfo)
+{
+    if (!CPLTestBool(
+            CPLGetConfigOption("GDAL_OPEN_USE_DRIVER_SIGNATURES", "YES")))
+        return {};
+
+    std::shared_ptr<const ProbeTable> poTable;
+    {
+        CPLMutexHolderD(&hDMMutex);
+        if (!m_poProbeTable)
+        {
+            auto poNewTable = std::make_shared<ProbeTable>();
+            const int nTotal = GetDriverCount(/*bIncludeHidden=*/true);
+            poNewTable->abAlwaysProbe.resize(nTotal, true);
+            for (int i = 0; i < nTotal; ++i)
+            {
+                GDALDriver *poDriver =
+                    i < nDrivers ? papoDrivers[i]
+                                 : m_aoHiddenDrivers[i - nDrivers].get();
+                const char *pszSignatures =
+                    poDriver->GetMetadataItem(GDAL_DMD_IDENTIFY_SIGNATURES);
+                if (!pszSignatures)
+                    continue;
+                if (poNewTable->AddSignatures(i, pszSignatures))
+                {
+                    poNewTable->abAlwaysProbe[i] = false;
+                }
+                else
+                {
+                    CPLDebug("GDAL", "Invalid %s for driver %s: %s",
+                             GDAL_DMD_IDENTIFY_SIGNATURES,
+                             poDriver->GetDescription(), pszSignatures);
+                }
+            }
+            m_poProbeTable = std::move(poNewTable);
+        }
+        poTable = m_poProbeTable;
+    }
+    if (poTable->nDriversWithSignatures == 0)
+        return {};
+
+    std::vector<bool> abCandidates(poTable->abAlwaysProbe);
+
+    if (poOpenInfo->fpL && poOpenInfo->nHeaderBytes > 0)
+    {
+        const GByte *pabyHeader = poOpenInfo->pabyHeader;
+        const size_t nHeaderBytes =
+            static_cast<size_t>(poOpenInfo->nHeaderBytes);
+        for (const auto &oMagic : poTable->aaoMagicsAtStart[pabyHeader[0]])
+        {
+            if (oMagic.osBytes.size() <= nHeaderBytes &&
+                memcmp(pabyHeader, oMagic.osBytes.data(),
+                       oMagic.osBytes.size()) == 0)
+            {
+                abCandidates[oMagic.iDriver] = true;
+            }
+        }
+        for (const auto &oMagic : poTable->aoOtherMagics)
+        {
+            // The driver might ingest more bytes than the default header
+            // size, so be conservative if the signature is beyond it.
+            if (oMagic.nOffset + oMagic.osBytes.size() > nHeaderBytes ||
+                memcmp(pabyHeader + oMagic.nOffset, oMagic.osBytes.data(),
+                       oMagic.osBytes.size()) == 0)
+            {
+                abCandidates[oMagic.iDriver] = true;
+            }
+        }
+    }
+
+    if (!poTable->oMapExtensions.empty())
+    {
+        const auto oIter = poTable->oMapExtensions.find(
+            CPLString(CPLGetExtension(poOpenInfo->pszFilename)).tolower());
+        if (oIter != poTable->oMapExtensions.end())
+        {
+            for (int iDriver : oIter->second)
+                abCandidates[iDriver] = true;
+        }
+    }
+
+    for (const auto &oPrefix : poTable->aoPrefixes)
+    {
+        if (STARTS_WITH_CI(poOpenInfo->pszFilename, oPrefix.first.c_str()))
+            abCandidates[oPrefix.second] = true;
+    }
+
+    return abCandidates;
+}
+
+//! @endcond
+
 /************************************************************************/
 /*                       GDALPluginDriverProxy                          */
 /************************************************************************/
@@ -1233,6 +1447,18 @@ GDALPluginDriverProxy::GDALPluginDriverProxy(
 {
 }
 
+/** Constructor for the proxy of a built-in driver, whose registration is
+ * deferred until it is actually needed.
+ *
+ * @param pfnRegisterBuiltinDriver Function registering the real driver,
+ * e.g. GDALRegister_GIF
+ */
+GDALPluginDriverProxy::GDALPluginDriverProxy(
+    void (*pfnRegisterBuiltinDriver)(void))
+    : m_pfnRegisterBuiltinDriver(pfnRegisterBuiltinDriver)
+{
+}
+
 //! @cond Doxygen_Suppress
 #define DEFINE_DRIVER_METHOD_GET_CALLBACK(method_name, output_type)            \
     GDALDriver::output_type GDALPluginDriverProxy::method_name()               \
@@ -1294,6 +1520,7 @@ static const char *const apszProxyMetadataItems[] = {
     GDAL_DMD_CONNECTION_PREFIX,
     GDAL_DCAP_VECTOR_TRANSLATE_FROM,
     GDAL_DMD_PLUGIN_INSTALLATION_MESSAGE,
+    GDAL_DMD_IDENTIFY_SIGNATURES,
 };
 
 const char *GDALPluginDriverProxy::GetMetadataItem(const char *pszName,
@@ -1313,12 +1540,16 @@ const char *GDALPluginDriverProxy::GetMetadataItem(const char *pszName,
     {
         if (EQUAL(pszName, "IS_NON_LOADED_PLUGIN"))
         {
-            return !m_poRealDriver ? "YES" : nullptr;
+            // Built-in drivers are not plugins, and must keep their
+            // position in the probing order of GDALOpen()
+            return !m_poRealDriver && !m_pfnRegisterBuiltinDriver ? "YES"
+                                                                  : nullptr;
         }
         else if (EQUAL(pszName, "MISSING_PLUGIN_FILENAME"))
         {
-            return m_osPluginFullPath.empty() ? m_osPluginFileName.c_str()
-                                              : nullptr;
+            return m_osPluginFullPath.empty() && !m_pfnRegisterBuiltinDriver
+                       ? m_osPluginFileName.c_str()
+                       : nullptr;
         }
         else if (IsListedProxyMetadataItem(pszName))
         {
@@ -1358,7 +1589,7 @@ GDALDriver *GDALPluginDriverProxy::GetRealDriver()
 {
     // No need to take the mutex has this member variable is not modified
     // under the mutex.
-    if (m_osPluginFullPath.empty())
+    if (m_osPluginFullPath.empty() && !m_pfnRegisterBuiltinDriver)
         return nullptr;
 
     CPLMutexHolderD(&hDMMutex);
@@ -1373,6 +1604,37 @@ GDALDriver *GDALPluginDriverProxy::GetRealDriver()
         m_poRealDriver = std::move(oIter->second);
         poDriverManager->m_oMapRealDrivers.erase(oIter);
     }
+    else if (m_pfnRegisterBuiltinDriver)
+    {
+        CPLDebug("GDAL", "On-demand registering built-in driver %s.",
+                 GetDescription());
+
+        poDriverManager->m_bInDeferredDriverLoading = true;
+        try
+        {
+            m_pfnRegisterBuiltinDriver();
+        }
+        catch (...)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Registration of driver %s threw an exception",
+                     GetDescription());
+        }
+        poDriverManager->m_bInDeferredDriverLoading = false;
+
+        oIter = poDriverManager->m_oMapRealDrivers.find(GetDescription());
+        if (oIter == poDriverManager->m_oMapRealDrivers.end())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Built-in driver %s could not be registered",
+                     GetDescription());
+        }
+        else
+        {
+            m_poRealDriver = std::move(oIter->second);
+            poDriverManager->m_oMapRealDrivers.erase(oIter);
+        }
+    }
     else
     {
         CPLString osFuncName;
@@ -1628,6 +1890,10 @@ std::string GDALDriverManager::GetPluginFullPath(const char *pszFilename) const
 /************************************************************************/
 
 /** Declare a driver that will be loaded as a plugin, when actually needed.
+ *
+ * This is also used for built-in drivers whose registration is deferred, in
+ * which case poProxyDriver has been constructed with the function that
+ * registers the real driver.
  *
  * @param poProxyDriver Plugin driver proxy
  *
@@ -1638,6 +1904,18 @@ void GDALDriverManager::DeclareDeferredPluginDriver(
 {
     CPLMutexHolderD(&hDMMutex);
 
+    if (poProxyDriver->IsBuiltinDriverProxy())
+    {
+        // The real driver may have already been registered explicitly
+        if (GDALGetDriverByName(poProxyDriver->GetDescription()))
+        {
+            delete poProxyDriver;
+            return;
+        }
+        RegisterDriver(poProxyDriver);
+        return;
+    }
+
     const auto &osPluginFileName = poProxyDriver->GetPluginFileName();
     const char *pszPluginFileName = osPluginFileName.c_str();
     if ((!STARTS_WITH(pszPluginFileName, "gdal_") &&
@@ -33,6 +33,7 @@
 #include <limits>
 #include <queue>
 #include <set>
+#include <string>
 #include <utility>
 #include <time.h>
 
@@ -41,6 +42,7 @@
 #include "cpl_error_internal.h"
 #include "gdal_priv.h"
 #include "gdal_pam.h"
+#include "gdal_thread_pool.h"
 #include "gdal_utils.h"
 #include "cpl_safemaths.hpp"
 #include "memmultidim.h"
@@ -1830,6 +1832,363 @@ bool GDALExtendedDataType::CopyValues(const void *pSrc,
     return true;
 }
 
+/************************************************************************/
+/*                        CopyValuesLineSameSize()                      */
+/************************************************************************/
+
+template <size_t N>
+static void CopyValuesLineSameSize(const GByte *pabySrc, GPtrDiff_t nSrcStride,
+                                   GByte *pabyDst, GPtrDiff_t nDstStride,
+                                   size_t nValues)
+{
+    size_t i = 0;
+    for (; i + 4 <= nValues; i += 4)
+    {
+        memcpy(pabyDst, pabySrc, N);
+        memcpy(pabyDst + nDstStride, pabySrc + nSrcStride, N);
+        memcpy(pabyDst + 2 * nDstStride, pabySrc + 2 * nSrcStride, N);
+        memcpy(pabyDst + 3 * nDstStride, pabySrc + 3 * nSrcStride, N);
+        pabySrc += 4 * nSrcStride;
+        pabyDst += 4 * nDstStride;
+    }
+    for (; i < nValues; ++i)
+    {
+        memcpy(pabyDst, pabySrc, N);
+        pabySrc += nSrcStride;
+        pabyDst += nDstStride;
+    }
+}
+
+/************************************************************************/
+/*                            CopyValuesLine()                          */
+/************************************************************************/
+
+namespace
+{
+struct CopyValuesContext
+{
+    const GDALExtendedDataType &srcType;
+    const GDALExtendedDataType &dstType;
+    const size_t nSrcSize;
+    const size_t nDstSize;
+    const bool bBothAreNumericDT;
+    // Same numeric data type, or same compound type without strings
+    const bool bMemcpyCompatible;
+    // Gathered source values, for type conversion on contiguous values
+    std::vector<GByte> abyTmp{};
+
+    CopyValuesContext(const GDALExtendedDataType &srcTypeIn,
+                      const GDALExtendedDataType &dstTypeIn)
+        : srcType(srcTypeIn), dstType(dstTypeIn),
+          nSrcSize(srcTypeIn.GetSize()), nDstSize(dstTypeIn.GetSize()),
+          bBothAreNumericDT(srcTypeIn.GetClass() == GEDTC_NUMERIC &&
+                            dstTypeIn.GetClass() == GEDTC_NUMERIC),
+          bMemcpyCompatible(srcTypeIn.GetClass() != GEDTC_STRING &&
+                            srcTypeIn == dstTypeIn &&
+                            !srcTypeIn.NeedsFreeDynamicMemory())
+    {
+    }
+};
+}  // namespace
+
+// Copy nValues values along a line, strides being expressed in bytes.
+static bool CopyValuesLine(CopyValuesContext &ctxt, const GByte *pabySrc,
+                           GPtrDiff_t nSrcStride, GByte *pabyDst,
+                           GPtrDiff_t nDstStride, size_t nValues)
+{
+    const size_t nSrcSize = ctxt.nSrcSize;
+    if (ctxt.bMemcpyCompatible)
+    {
+        if (nSrcStride == static_cast<GPtrDiff_t>(nSrcSize) &&
+            nDstStride == static_cast<GPtrDiff_t>(nSrcSize))
+        {
+            memcpy(pabyDst, pabySrc, nValues * nSrcSize);
+            return true;
+        }
+        switch (nSrcSize)
+        {
+            case 1:
+                CopyValuesLineSameSize<1>(pabySrc, nSrcStride, pabyDst,
+                                          nDstStride, nValues);
+                return true;
+            case 2:
+                CopyValuesLineSameSize<2>(pabySrc, nSrcStride, pabyDst,
+                                          nDstStride, nValues);
+                return true;
+            case 4:
+                CopyValuesLineSameSize<4>(pabySrc, nSrcStride, pabyDst,
+                                          nDstStride, nValues);
+                return true;
+            case 8:
+                CopyValuesLineSameSize<8>(pabySrc, nSrcStride, pabyDst,
+                                          nDstStride, nValues);
+                return true;
+            case 16:
+                CopyValuesLineSameSize<16>(pabySrc, nSrcStride, pabyDst,
+                                           nDstStride, nValues);
+                return true;
+            default:
+                for (size_t i = 0; i < nValues; ++i)
+                {
+                    memcpy(pabyDst, pabySrc, nSrcSize);
+                    pabySrc += nSrcStride;
+                    pabyDst += nDstStride;
+                }
+                return true;
+        }
+    }
+
+    if (ctxt.bBothAreNumericDT &&
+        nSrcStride >= std::numeric_limits<int>::min() &&
+        nSrcStride <= std::numeric_limits<int>::max() &&
+        nDstStride >= std::numeric_limits<int>::min() &&
+        nDstStride <= std::numeric_limits<int>::max())
+    {
+        const auto eSrcDT = ctxt.srcType.GetNumericDataType();
+        const auto eDstDT = ctxt.dstType.GetNumericDataType();
+        if (nSrcStride != static_cast<GPtrDiff_t>(nSrcSize) &&
+            nDstStride == static_cast<GPtrDiff_t>(ctxt.nDstSize))
+        {
+            // Gather source values by chunks, so that GDALCopyWords64()
+            // can use its vectorized code paths for contiguous values.
+            constexpr size_t CHUNK_SIZE = 256;
+            if (ctxt.abyTmp.empty())
+                ctxt.abyTmp.resize(CHUNK_SIZE * nSrcSize);
+            GByte *pabyTmp = ctxt.abyTmp.data();
+            while (nValues > 0)
+            {
+                const size_t nChunk = std::min(nValues, CHUNK_SIZE);
+                GByte *pabyTmpIter = pabyTmp;
+                for (size_t i = 0; i < nChunk; ++i)
+                {
+                    memcpy(pabyTmpIter, pabySrc, nSrcSize);
+                    pabyTmpIter += nSrcSize;
+                    pabySrc += nSrcStride;
+                }
+                GDALCopyWords64(pabyTmp, eSrcDT, static_cast<int>(nSrcSize),
+                                pabyDst, eDstDT,
+                                static_cast<int>(ctxt.nDstSize),
+                                static_cast<GPtrDiff_t>(nChunk));
+                pabyDst += nChunk * ctxt.nDstSize;
+                nValues -= nChunk;
+            }
+        }
+        else
+        {
+            GDALCopyWords64(pabySrc, eSrcDT, static_cast<int>(nSrcStride),
+                            pabyDst, eDstDT, static_cast<int>(nDstStride),
+                            static_cast<GPtrDiff_t>(nValues));
+        }
+        return true;
+    }
+
+    for (size_t i = 0; i < nValues; ++i)
+    {
+        if (!GDALExtendedDataType::CopyValue(pabySrc, ctxt.srcType, pabyDst,
+                                             ctxt.dstType))
+            return false;
+        pabySrc += nSrcStride;
+        pabyDst += nDstStride;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                             CopyValues()                             */
+/************************************************************************/
+
+/** Convert a N-dimensional array of values from a source type and layout to
+ * a destination type and layout.
+ *
+ * Dimensions of size 1 are skipped, and dimensions that are contiguous in
+ * both the source and destination are merged, so that the innermost loop
+ * runs over as many values as possible. When the dimension along which
+ * the source is the most compact is not the one along which the destination
+ * is, values are copied by small 2D blocks, to stay within CPU caches.
+ *
+ * If dstType is GEDTC_STRING, the written values will be pointers to a char*,
+ * that must be freed with CPLFree().
+ *
+ * @param nDims Number of dimensions.
+ * @param count Array of nDims elements, with the number of values to copy
+ *              along each dimension.
+ * @param pSrc Source buffer.
+ * @param srcType Data type of the source values.
+ * @param srcStrideInElts Array of nDims elements, with the spacing between
+ *                        two consecutive source values along each dimension,
+ *                        in number of elements. May be negative.
+ * @param pDst Destination buffer.
+ * @param dstType Data type of the destination values.
+ * @param dstStrideInElts Array of nDims elements, with the spacing between
+ *                        two consecutive destination values along each
+ *                        dimension, in number of elements. May be negative.
+ * @return true in case of success.
+ * @since GDAL 3.9
+ */
+bool GDALExtendedDataType::CopyValues(size_t nDims, const size_t *count,
+                                      const void *pSrc,
+                                      const GDALExtendedDataType &srcType,
+                                      const GPtrDiff_t *srcStrideInElts,
+                                      void *pDst,
+                                      const GDALExtendedDataType &dstType,
+                                      const GPtrDiff_t *dstStrideInElts)
+{
+    CopyValuesContext ctxt(srcType, dstType);
+
+    struct Dim
+    {
+        size_t nCount;
+        GPtrDiff_t nSrcStride;  // in bytes
+        GPtrDiff_t nDstStride;  // in bytes
+    };
+
+    std::vector<Dim> aoDims;
+    bool bHasZeroDstStride = false;
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        if (count[i] == 0)
+            return true;
+        if (count[i] == 1)
+            continue;
+        aoDims.push_back(Dim{
+            count[i],
+            srcStrideInElts[i] * static_cast<GPtrDiff_t>(ctxt.nSrcSize),
+            dstStrideInElts[i] * static_cast<GPtrDiff_t>(ctxt.nDstSize)});
+        if (dstStrideInElts[i] == 0)
+            bHasZeroDstStride = true;
+    }
+    if (aoDims.empty())
+        return CopyValue(pSrc, srcType, pDst, dstType);
+
+    // The order of iteration does not matter, unless several source values
+    // are written at the same place. Make the innermost dimension the one
+    // with the smallest destination stride.
+    if (!bHasZeroDstStride)
+    {
+        std::stable_sort(aoDims.begin(), aoDims.end(),
+                         [](const Dim &a, const Dim &b)
+                         {
+                             return std::abs(a.nDstStride) >
+                                    std::abs(b.nDstStride);
+                         });
+    }
+
+    // Merge dimensions that can be iterated over as a single one
+    std::vector<Dim> aoMergedDims;
+    for (const auto &oDim : aoDims)
+    {
+        if (!aoMergedDims.empty())
+        {
+            auto &oPrev = aoMergedDims.back();
+            const auto nCount = static_cast<GPtrDiff_t>(oDim.nCount);
+            if (oPrev.nSrcStride == oDim.nSrcStride * nCount &&
+                oPrev.nDstStride == oDim.nDstStride * nCount)
+            {
+                oPrev.nCount *= oDim.nCount;
+                oPrev.nSrcStride = oDim.nSrcStride;
+                oPrev.nDstStride = oDim.nDstStride;
+                continue;
+            }
+        }
+        aoMergedDims.push_back(oDim);
+    }
+
+    const size_t nMergedDims = aoMergedDims.size();
+    const Dim &oInnerDim = aoMergedDims.back();
+
+    // Find if the source is more compact along another dimension than
+    // the innermost one, in which case we do a blocked transposition
+    // between those two dimensions.
+    size_t iTransposedDim = nMergedDims;
+    if (!bHasZeroDstStride)
+    {
+        GPtrDiff_t nMinSrcStride = std::abs(oInnerDim.nSrcStride);
+        for (size_t i = 0; i + 1 < nMergedDims; ++i)
+        {
+            if (std::abs(aoMergedDims[i].nSrcStride) < nMinSrcStride)
+            {
+                nMinSrcStride = std::abs(aoMergedDims[i].nSrcStride);
+                iTransposedDim = i;
+            }
+        }
+    }
+
+    const auto CopyInner = [&ctxt, &aoMergedDims, &oInnerDim, iTransposedDim,
+                            nMergedDims](const GByte *pabySrc, GByte *pabyDst)
+    {
+        if (iTransposedDim == nMergedDims)
+        {
+            return CopyValuesLine(ctxt, pabySrc, oInnerDim.nSrcStride, pabyDst,
+                                  oInnerDim.nDstStride, oInnerDim.nCount);
+        }
+
+        constexpr size_t BLOCK_SIZE = 32;
+        const Dim &oTransposedDim = aoMergedDims[iTransposedDim];
+        for (size_t j0 = 0; j0 < oTransposedDim.nCount; j0 += BLOCK_SIZE)
+        {
+            const size_t nJ = std::min(BLOCK_SIZE, oTransposedDim.nCount - j0);
+            for (size_t i0 = 0; i0 < oInnerDim.nCount; i0 += BLOCK_SIZE)
+            {
+                const size_t nI = std::min(BLOCK_SIZE, oInnerDim.nCount - i0);
+                const GByte *pabySrcBlock =
+                    pabySrc +
+                    static_cast<GPtrDiff_t>(j0) * oTransposedDim.nSrcStride +
+                    static_cast<GPtrDiff_t>(i0) * oInnerDim.nSrcStride;
+                GByte *pabyDstBlock =
+                    pabyDst +
+                    static_cast<GPtrDiff_t>(j0) * oTransposedDim.nDstStride +
+                    static_cast<GPtrDiff_t>(i0) * oInnerDim.nDstStride;
+                for (size_t j = 0; j < nJ; ++j)
+                {
+                    if (!CopyValuesLine(ctxt, pabySrcBlock,
+                                        oInnerDim.nSrcStride, pabyDstBlock,
+                                        oInnerDim.nDstStride, nI))
+                        return false;
+                    pabySrcBlock += oTransposedDim.nSrcStride;
+                    pabyDstBlock += oTransposedDim.nDstStride;
+                }
+            }
+        }
+        return true;
+    };
+
+    // Iterate over the other dimensions
+    std::vector<size_t> anOuterDims;
+    for (size_t i = 0; i + 1 < nMergedDims; ++i)
+    {
+        if (i != iTransposedDim)
+            anOuterDims.push_back(i);
+    }
+    std::vector<size_t> anIdx(anOuterDims.size());
+    const GByte *pabySrc = static_cast<const GByte *>(pSrc);
+    GByte *pabyDst = static_cast<GByte *>(pDst);
+    while (true)
+    {
+        if (!CopyInner(pabySrc, pabyDst))
+            return false;
+
+        size_t j = anOuterDims.size();
+        while (true)
+        {
+            if (j == 0)
+                return true;
+            --j;
+            const Dim &oDim = aoMergedDims[anOuterDims[j]];
+            if (++anIdx[j] < oDim.nCount)
+            {
+                pabySrc += oDim.nSrcStride;
+                pabyDst += oDim.nDstStride;
+                break;
+            }
+            anIdx[j] = 0;
+            pabySrc -=
+                oDim.nSrcStride * static_cast<GPtrDiff_t>(oDim.nCount - 1);
+            pabyDst -=
+                oDim.nDstStride * static_cast<GPtrDiff_t>(oDim.nCount - 1);
+        }
+    }
+}
+
 /************************************************************************/
 /*                       CheckReadWriteParams()                         */
 /************************************************************************/
@@ -3819,34 +4178,47 @@ bool GDALMDArray::CopyFrom(CPL_UNUSED GDALDataset *poSrcDS,
             GUInt64 nCurCost = 0;
             GUInt64 nTotalCost = 0;
             GUInt64 nTotalBytesThisArray = 0;
+            std::string osProgressMsg{};
             bool bStop = false;
 
-            static bool f(GDALAbstractMDArray *l_poSrcArray,
-                          const GUInt64 *chunkArrayStartIdx,
-                          const size_t *chunkCount, GUInt64 iCurChunk,
-                          GUInt64 nChunkCount, void *pUserData)
-            {
-                const auto &dt(l_poSrcArray->GetDataType());
-                auto data = static_cast<CopyFunc *>(pUserData);
-                auto poDstArray = data->poDstArray;
-                if (!l_poSrcArray->Read(chunkArrayStartIdx, chunkCount, nullptr,
-                                        nullptr, dt, &data->abyTmp[0]))
+            // When pipelining, the next swath is read from the source array
+            // by a worker thread, into abyRead, while the current one is
+            // written to the destination array by the calling thread.
+            std::unique_ptr<CPLJobQueue> poReadQueue{};
+            GDALAbstractMDArray *poSrcArray = nullptr;
+            std::vector<GByte> abyRead{};
+            std::vector<GUInt64> anReadStartIdx{};
+            std::vector<size_t> anReadCount{};
+            GUInt64 iReadChunk = 0;
+            GUInt64 nReadChunkCount = 0;
+            bool bReadPending = false;
+            bool bReadOK = false;
+            std::vector<CPLErrorHandlerAccumulatorStruct> aoReadErrors{};
+
+            static size_t GetEltCount(size_t nDims, const size_t *chunkCount)
+            {
+                size_t nEltCount = 1;
+                for (size_t i = 0; i < nDims; ++i)
                 {
-                    return false;
+                    nEltCount *= chunkCount[i];
                 }
-                bool bRet =
-                    poDstArray->Write(chunkArrayStartIdx, chunkCount, nullptr,
-                                      nullptr, dt, &data->abyTmp[0]);
+                return nEltCount;
+            }
+
+            bool WriteAndProgress(const GDALAbstractMDArray *l_poSrcArray,
+                                  const GUInt64 *chunkArrayStartIdx,
+                                  const size_t *chunkCount, GUInt64 iCurChunk,
+                                  GUInt64 nChunkCount)
+            {
+                const auto &dt(l_poSrcArray->GetDataType());
+                bool bRet = poDstArray->Write(chunkArrayStartIdx, chunkCount,
+                                              nullptr, nullptr, dt, &abyTmp[0]);
                 if (dt.NeedsFreeDynamicMemory())
                 {
                     const auto l_nDTSize = dt.GetSize();
-                    GByte *ptr = &data->abyTmp[0];
-                    const size_t l_nDims(l_poSrcArray->GetDimensionCount());
-                    size_t nEltCount = 1;
-                    for (size_t i = 0; i < l_nDims; ++i)
-                    {
-                        nEltCount *= chunkCount[i];
-                    }
+                    GByte *ptr = &abyTmp[0];
+                    const size_t nEltCount = GetEltCount(
+                        l_poSrcArray->GetDimensionCount(), chunkCount);
                     for (size_t i = 0; i < nEltCount; i++)
                     {
                         dt.FreeDynamicMemory(ptr);
@@ -3859,17 +4231,108 @@ bool GDALMDArray::CopyFrom(CPL_UNUSED GDALDataset *poSrcDS,
                 }
 
                 double dfCurCost =
-                    double(data->nCurCost) + double(iCurChunk) / nChunkCount *
-                                                 data->nTotalBytesThisArray;
-                if (!data->pfnProgress(dfCurCost / data->nTotalCost, "",
-                                       data->pProgressData))
+                    double(nCurCost) +
+                    double(iCurChunk) / nChunkCount * nTotalBytesThisArray;
+                if (!pfnProgress(dfCurCost / nTotalCost, osProgressMsg.c_str(),
+                                 pProgressData))
                 {
-                    data->bStop = true;
+                    bStop = true;
                     return false;
                 }
 
                 return true;
             }
+
+            static void ReadJob(void *pData)
+            {
+                auto data = static_cast<CopyFunc *>(pData);
+                CPLInstallErrorHandlerAccumulator(data->aoReadErrors);
+                data->bReadOK = data->poSrcArray->Read(
+                    data->anReadStartIdx.data(), data->anReadCount.data(),
+                    nullptr, nullptr, data->poSrcArray->GetDataType(),
+                    &data->abyRead[0]);
+                CPLUninstallErrorHandlerAccumulator();
+            }
+
+            // Waits for the pending read, and makes its swath the one to be
+            // written.
+            bool WaitPendingRead()
+            {
+                poReadQueue->WaitCompletion();
+                bReadPending = false;
+                for (const auto &oError : aoReadErrors)
+                {
+                    CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+                }
+                aoReadErrors.clear();
+                if (!bReadOK)
+                    return false;
+                std::swap(abyTmp, abyRead);
+                return true;
+            }
+
+            // Writes the last swath, read by the worker thread.
+            bool FinishPipeline()
+            {
+                if (!bReadPending)
+                    return true;
+                if (!WaitPendingRead())
+                    return false;
+                return WriteAndProgress(poSrcArray, anReadStartIdx.data(),
+                                        anReadCount.data(), iReadChunk,
+                                        nReadChunkCount);
+            }
+
+            static bool f(GDALAbstractMDArray *l_poSrcArray,
+                          const GUInt64 *chunkArrayStartIdx,
+                          const size_t *chunkCount, GUInt64 iCurChunk,
+                          GUInt64 nChunkCount, void *pUserData)
+            {
+                const auto &dt(l_poSrcArray->GetDataType());
+                auto data = static_cast<CopyFunc *>(pUserData);
+                if (data->poReadQueue)
+                {
+                    const size_t nDims = l_poSrcArray->GetDimensionCount();
+                    bool bHasPrevious = false;
+                    std::vector<GUInt64> anPrevStartIdx;
+                    std::vector<size_t> anPrevCount;
+                    GUInt64 iPrevChunk = 0;
+                    GUInt64 nPrevChunkCount = 0;
+                    if (data->bReadPending)
+                    {
+                        if (!data->WaitPendingRead())
+                            return false;
+                        bHasPrevious = true;
+                        anPrevStartIdx = data->anReadStartIdx;
+                        anPrevCount = data->anReadCount;
+                        iPrevChunk = data->iReadChunk;
+                        nPrevChunkCount = data->nReadChunkCount;
+                    }
+
+                    data->anReadStartIdx.assign(chunkArrayStartIdx,
+                                                chunkArrayStartIdx + nDims);
+                    data->anReadCount.assign(chunkCount, chunkCount + nDims);
+                    data->iReadChunk = iCurChunk;
+                    data->nReadChunkCount = nChunkCount;
+                    data->bReadPending = true;
+                    data->poReadQueue->SubmitJob(ReadJob, data);
+
+                    return !bHasPrevious ||
+                           data->WriteAndProgress(
+                               l_poSrcArray, anPrevStartIdx.data(),
+                               anPrevCount.data(), iPrevChunk,
+                               nPrevChunkCount);
+                }
+
+                if (!l_poSrcArray->Read(chunkArrayStartIdx, chunkCount, nullptr,
+                                        nullptr, dt, &data->abyTmp[0]))
+                {
+                    return false;
+                }
+                return data->WriteAndProgress(l_poSrcArray, chunkArrayStartIdx,
+                                              chunkCount, iCurChunk,
+                                              nChunkCount);
+            }
         };
 
         CopyFunc copyFunc;
@@ -3879,9 +4342,10 @@ bool GDALMDArray::CopyFrom(CPL_UNUSED GDALDataset *poSrcDS,
         copyFunc.nTotalBytesThisArray = GetTotalElementsCount() * nDTSize;
         copyFunc.pfnProgress = pfnProgress;
         copyFunc.pProgressData = pProgressData;
+        copyFunc.osProgressMsg = GetFullName();
         const char *pszSwathSize =
             CPLGetConfigOption("GDAL_SWATH_SIZE", nullptr);
-        const size_t nMaxChunkSize =
+        size_t nMaxChunkSize =
             pszSwathSize
                 ? static_cast<size_t>(
                       std::min(GIntBig(std::numeric_limits<size_t>::max() / 2),
@@ -3889,7 +4353,32 @@ bool GDALMDArray::CopyFrom(CPL_UNUSED GDALDataset *poSrcDS,
                 : static_cast<size_t>(
                       std::min(GIntBig(std::numeric_limits<size_t>::max() / 2),
                                GDALGetCacheMax64() / 4));
-        const auto anChunkSizes(GetProcessingChunkSize(nMaxChunkSize));
+        auto anChunkSizes(GetProcessingChunkSize(nMaxChunkSize));
+
+        // If asked for, and several swaths are needed, read the next swath
+        // in a worker thread while the current one is written. Two buffers
+        // of half the swath size are then used, so as to keep within the
+        // same memory budget.
+        bool bSeveralSwaths = false;
+        for (size_t i = 0; i < dims.size(); ++i)
+        {
+            if (anChunkSizes[i] < count[i])
+                bSeveralSwaths = true;
+        }
+        if (bSeveralSwaths &&
+            CPLTestBool(
+                CPLGetConfigOption("GDAL_MDARRAY_COPY_PIPELINE", "NO")))
+        {
+            CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(1);
+            if (poPool)
+            {
+                copyFunc.poReadQueue = poPool->CreateJobQueue();
+                copyFunc.poSrcArray = const_cast<GDALMDArray *>(poSrcArray);
+                nMaxChunkSize /= 2;
+                anChunkSizes = GetProcessingChunkSize(nMaxChunkSize);
+            }
+        }
+
         size_t nRealChunkSize = nDTSize;
         for (const auto &nChunkSize : anChunkSizes)
         {
@@ -3898,6 +4387,8 @@ bool GDALMDArray::CopyFrom(CPL_UNUSED GDALDataset *poSrcDS,
         try
         {
             copyFunc.abyTmp.resize(nRealChunkSize);
+            if (copyFunc.poReadQueue)
+                copyFunc.abyRead.resize(nRealChunkSize);
         }
         catch (const std::exception &)
         {
@@ -3906,12 +4397,35 @@ bool GDALMDArray::CopyFrom(CPL_UNUSED GDALDataset *poSrcDS,
             nCurCost += copyFunc.nTotalBytesThisArray;
             return false;
         }
-        if (copyFunc.nTotalBytesThisArray != 0 &&
-            !const_cast<GDALMDArray *>(poSrcArray)
-                 ->ProcessPerChunk(arrayStartIdx.data(), count.data(),
-                                   anChunkSizes.data(), CopyFunc::f,
-                                   &copyFunc) &&
-            (bStrict || copyFunc.bStop))
+        bool bRet = copyFunc.nTotalBytesThisArray == 0 ||
+                    const_cast<GDALMDArray *>(poSrcArray)
+                        ->ProcessPerChunk(arrayStartIdx.data(), count.data(),
+                                          anChunkSizes.data(), CopyFunc::f,
+                                          &copyFunc);
+        if (copyFunc.poReadQueue)
+        {
+            if (bRet)
+            {
+                bRet = copyFunc.FinishPipeline();
+            }
+            else if (copyFunc.bReadPending &&
+                     copyFunc.WaitPendingRead() &&
+                     poSrcArray->GetDataType().NeedsFreeDynamicMemory())
+            {
+                // Release the dynamic memory of the swath that was read but
+                // will not be written
+                const auto &dt(poSrcArray->GetDataType());
+                GByte *ptr = &copyFunc.abyTmp[0];
+                const size_t nEltCount = CopyFunc::GetEltCount(
+                    dims.size(), copyFunc.anReadCount.data());
+                for (size_t i = 0; i < nEltCount; i++)
+                {
+                    dt.FreeDynamicMemory(ptr);
+                    ptr += nDTSize;
+                }
+            }
+        }
+        if (!bRet && (bStrict || copyFunc.bStop))
         {
             nCurCost += copyFunc.nTotalBytesThisArray;
             return false;
@@ -4384,62 +4898,6 @@ bool GDALMDArray::IsTransposedRequest(
     return nLastIdx == nElts - 1;
 }
 
-/************************************************************************/
-/*                   CopyToFinalBufferSameDataType()                    */
-/************************************************************************/
-
-template <size_t N>
-void CopyToFinalBufferSameDataType(const void *pSrcBuffer, void *pDstBuffer,
-                                   size_t nDims, const size_t *count,
-                                   const GPtrDiff_t *bufferStride)
-{
-    std::vector<size_t> anStackCount(nDims);
-    std::vector<GByte *> pabyDstBufferStack(nDims + 1);
-    const GByte *pabySrcBuffer = static_cast<const GByte *>(pSrcBuffer);
-#if defined(__GNUC__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wnull-dereference"
-#endif
-    pabyDstBufferStack[0] = static_cast<GByte *>(pDstBuffer);
-#if defined(__GNUC__)
-#pragma GCC diagnostic pop
-#endif
-    size_t iDim = 0;
-
-lbl_next_depth:
-    if (iDim == nDims - 1)
-    {
-        size_t n = count[iDim];
-        GByte *pabyDstBuffer = pabyDstBufferStack[iDim];
-        const auto bufferStrideLastDim = bufferStride[iDim] * N;
-        while (n > 0)
-        {
-            --n;
-            memcpy(pabyDstBuffer, pabySrcBuffer, N);
-            pabyDstBuffer += bufferStrideLastDim;
-            pabySrcBuffer += N;
-        }
-    }
-    else
-    {
-        anStackCount[iDim] = count[iDim];
-        while (true)
-        {
-            ++iDim;
-            pabyDstBufferStack[iDim] = pabyDstBufferStack[iDim - 1];
-            goto lbl_next_depth;
-        lbl_return_to_caller_in_loop:
-            --iDim;
-            --anStackCount[iDim];
-            if (anStackCount[iDim] == 0)
-                break;
-            pabyDstBufferStack[iDim] += bufferStride[iDim] * N;
-        }
-    }
-    if (iDim > 0)
-        goto lbl_return_to_caller_in_loop;
-}
-
 /************************************************************************/
 /*                        CopyToFinalBuffer()                           */
 /************************************************************************/
@@ -4451,70 +4909,18 @@ static void CopyToFinalBuffer(const void *pSrcBuffer,
                               size_t nDims, const size_t *count,
                               const GPtrDiff_t *bufferStride)
 {
-    const size_t nSrcDataTypeSize(eSrcDataType.GetSize());
-    // Use specialized implementation for well-known data types when no
-    // type conversion is needed
-    if (eSrcDataType == eDstDataType)
-    {
-        if (nSrcDataTypeSize == 1)
-        {
-            CopyToFinalBufferSameDataType<1>(pSrcBuffer, pDstBuffer, nDims,
-                                             count, bufferStride);
-            return;
-        }
-        else if (nSrcDataTypeSize == 2)
-        {
-            CopyToFinalBufferSameDataType<2>(pSrcBuffer, pDstBuffer, nDims,
-                                             count, bufferStride);
-            return;
-        }
-        else if (nSrcDataTypeSize == 4)
-        {
-            CopyToFinalBufferSameDataType<4>(pSrcBuffer, pDstBuffer, nDims,
-                                             count, bufferStride);
-            return;
-        }
-        else if (nSrcDataTypeSize == 8)
-        {
-            CopyToFinalBufferSameDataType<8>(pSrcBuffer, pDstBuffer, nDims,
-                                             count, bufferStride);
-            return;
-        }
-    }
-
-    const size_t nDstDataTypeSize(eDstDataType.GetSize());
-    std::vector<size_t> anStackCount(nDims);
-    std::vector<GByte *> pabyDstBufferStack(nDims + 1);
-    const GByte *pabySrcBuffer = static_cast<const GByte *>(pSrcBuffer);
-    pabyDstBufferStack[0] = static_cast<GByte *>(pDstBuffer);
-    size_t iDim = 0;
-
-lbl_next_depth:
-    if (iDim == nDims - 1)
-    {
-        GDALExtendedDataType::CopyValues(pabySrcBuffer, eSrcDataType, 1,
-                                         pabyDstBufferStack[iDim], eDstDataType,
-                                         bufferStride[iDim], count[iDim]);
-        pabySrcBuffer += count[iDim] * nSrcDataTypeSize;
-    }
-    else
+    // The source buffer is in row-major order
+    std::vector<GPtrDiff_t> anSrcStrides(nDims);
+    GPtrDiff_t nStride = 1;
+    for (size_t i = nDims; i > 0;)
     {
-        anStackCount[iDim] = count[iDim];
-        while (true)
-        {
-            ++iDim;
-            pabyDstBufferStack[iDim] = pabyDstBufferStack[iDim - 1];
-            goto lbl_next_depth;
-        lbl_return_to_caller_in_loop:
-            --iDim;
-            --anStackCount[iDim];
-            if (anStackCount[iDim] == 0)
-                break;
-            pabyDstBufferStack[iDim] += bufferStride[iDim] * nDstDataTypeSize;
-        }
+        --i;
+        anSrcStrides[i] = nStride;
+        nStride *= static_cast<GPtrDiff_t>(count[i]);
     }
-    if (iDim > 0)
-        goto lbl_return_to_caller_in_loop;
+    GDALExtendedDataType::CopyValues(nDims, count, pSrcBuffer, eSrcDataType,
+                                     anSrcStrides.data(), pDstBuffer,
+                                     eDstDataType, bufferStride);
 }
 
 /************************************************************************/
@@ -0,0 +1,1228 @@
+/******************************************************************************
+ *
+ * Name:     gdalmultidim_expression.cpp
+ * Project:  GDAL Core
+ * Purpose:  GDALMDArray::GetElementWise(), GetWhere(), GetCast() and
+ *           GetReduced() implementation
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "gdal_priv.h"
+#include "gdal_pam.h"
+#include "gdal_thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <new>
+
+// Maximum number of elements of the temporary buffers used by a read pass
+constexpr size_t MAX_ELTS_PER_PASS = 8 * 1024 * 1024;
+
+// Number of elements processed at once by the expression evaluator
+constexpr size_t EVAL_BLOCK_SIZE = 256;
+
+/************************************************************************/
+/*                         GetNumThreads()                              */
+/************************************************************************/
+
+static int GetNumThreads()
+{
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    return EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                            : std::max(1, atoi(pszNumThreads));
+}
+
+/************************************************************************/
+/*                         ReadAsDouble()                               */
+/************************************************************************/
+
+// Read a window of an array as a contiguous array of doubles, with nodata
+// values replaced by NaN.
+static bool ReadAsDouble(const GDALMDArray *poArray,
+                         const GUInt64 *arrayStartIdx, const size_t *count,
+                         const GInt64 *arrayStep, size_t nElts,
+                         double *padfBuffer)
+{
+    if (!poArray->Read(arrayStartIdx, count, arrayStep, nullptr,
+                       GDALExtendedDataType::Create(GDT_Float64), padfBuffer))
+    {
+        return false;
+    }
+    bool bHasNoData = false;
+    const double dfNoData = poArray->GetNoDataValueAsDouble(&bHasNoData);
+    if (bHasNoData && !std::isnan(dfNoData))
+    {
+        constexpr double dfNaN = std::numeric_limits<double>::quiet_NaN();
+        for (size_t i = 0; i < nElts; ++i)
+        {
+            if (padfBuffer[i] == dfNoData)
+                padfBuffer[i] = dfNaN;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                         CopyToBuffer()                               */
+/************************************************************************/
+
+// Copy a contiguous array of doubles into the (strided) user buffer of an
+// IRead() request.
+static void CopyToBuffer(const double *padfSrc, size_t nDims,
+                         const size_t *count, const GPtrDiff_t *bufferStride,
+                         const GDALExtendedDataType &bufferDataType,
+                         void *pDstBuffer)
+{
+    const auto dtDouble = GDALExtendedDataType::Create(GDT_Float64);
+    if (nDims == 0)
+    {
+        GDALExtendedDataType::CopyValue(padfSrc, dtDouble, pDstBuffer,
+                                        bufferDataType);
+        return;
+    }
+
+    const size_t nBufferDTSize = bufferDataType.GetSize();
+    const size_t nInnerCount = count[nDims - 1];
+    const GPtrDiff_t nInnerStride =
+        bufferStride[nDims - 1] * static_cast<GPtrDiff_t>(nBufferDTSize);
+    const bool bCanUseCopyWords =
+        bufferDataType.GetClass() == GEDTC_NUMERIC &&
+        nInnerStride >= std::numeric_limits<int>::min() &&
+        nInnerStride <= std::numeric_limits<int>::max();
+    std::vector<size_t> anIdx(nDims, 0);
+    while (true)
+    {
+        GPtrDiff_t nOffset = 0;
+        for (size_t i = 0; i + 1 < nDims; ++i)
+            nOffset += static_cast<GPtrDiff_t>(anIdx[i]) * bufferStride[i];
+        GByte *pabyDst = static_cast<GByte *>(pDstBuffer) +
+                         nOffset * static_cast<GPtrDiff_t>(nBufferDTSize);
+        if (bCanUseCopyWords)
+        {
+            GDALCopyWords64(padfSrc, GDT_Float64, sizeof(double), pabyDst,
+                            bufferDataType.GetNumericDataType(),
+                            static_cast<int>(nInnerStride), nInnerCount);
+        }
+        else
+        {
+            for (size_t i = 0; i < nInnerCount; ++i)
+            {
+                GDALExtendedDataType::CopyValue(
+                    padfSrc + i, dtDouble, pabyDst + i * nInnerStride,
+                    bufferDataType);
+            }
+        }
+        padfSrc += nInnerCount;
+
+        // Move to the next line
+        size_t iDim = nDims - 1;
+        while (true)
+        {
+            if (iDim == 0)
+                return;
+            --iDim;
+            if (++anIdx[iDim] < count[iDim])
+                break;
+            anIdx[iDim] = 0;
+        }
+    }
+}
+
+/************************************************************************/
+/*                      HaveSameDimensionSizes()                        */
+/************************************************************************/
+
+static bool HaveSameDimensionSizes(const GDALMDArray *poA,
+                                   const GDALMDArray *poB)
+{
+    const auto &apoDimsA = poA->GetDimensions();
+    const auto &apoDimsB = poB->GetDimensions();
+    if (apoDimsA.size() != apoDimsB.size())
+        return false;
+    for (size_t i = 0; i < apoDimsA.size(); ++i)
+    {
+        if (apoDimsA[i]->GetSize() != apoDimsB[i]->GetSize())
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                         GDALMDArrayExprNode                          */
+/************************************************************************/
+
+namespace
+{
+// Node of the expression tree of a GDALMDArrayElementWise array.
+struct GDALMDArrayExprNode
+{
+    enum class Type
+    {
+        ARRAY,
+        CONSTANT,
+        OPERATOR,
+        WHERE,
+        CAST,
+    };
+
+    Type eType = Type::CONSTANT;
+    GDALMDArrayOperator eOp = GDALMDArrayOperator::ADD;
+    double dfConstant = 0;
+    GDALDataType eDT = GDT_Float64;
+    std::shared_ptr<GDALMDArray> poArray{};
+    std::vector<std::shared_ptr<const GDALMDArrayExprNode>> apoChildren{};
+};
+
+// Instruction of the stack machine the expression tree is compiled to.
+struct GDALMDArrayExprInstr
+{
+    GDALMDArrayExprNode::Type eType = GDALMDArrayExprNode::Type::CONSTANT;
+    GDALMDArrayOperator eOp = GDALMDArrayOperator::ADD;
+    double dfConstant = 0;
+    GDALDataType eDT = GDT_Float64;
+    size_t iArray = 0;
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                       GDALMDArrayElementWise                         */
+/************************************************************************/
+
+// Lazy evaluation of an expression whose leaves are arrays of the same
+// dimensions. Nested element-wise operations are fused in a single
+// expression tree, so that reading a window of the result reads each source
+// array only once, and evaluates the whole expression in a single pass.
+class GDALMDArrayElementWise final : public GDALPamMDArray
+{
+  private:
+    std::shared_ptr<GDALMDArray> m_poRefArray{};
+    std::shared_ptr<const GDALMDArrayExprNode> m_poExpr{};
+    const GDALExtendedDataType m_dt;
+    std::vector<std::shared_ptr<GDALMDArray>> m_apoArrays{};
+    std::vector<GDALMDArrayExprInstr> m_aoProgram{};
+    size_t m_nMaxStackDepth = 0;
+
+    void Compile(const GDALMDArrayExprNode *poNode, size_t nDepth);
+
+    void Evaluate(const std::vector<const double *> &apadfArrays,
+                  size_t nStart, size_t nCount, double *padfOut) const;
+
+    void EvaluateBlock(const std::vector<const double *> &apadfArrays,
+                       size_t nStart, size_t nCount,
+                       std::vector<double> &adfStack) const;
+
+    struct EvaluateJob
+    {
+        const GDALMDArrayElementWise *poArray = nullptr;
+        const std::vector<const double *> *papadfArrays = nullptr;
+        size_t nStart = 0;
+        size_t nCount = 0;
+        double *padfOut = nullptr;
+    };
+
+    static void EvaluateJobFunc(void *pData)
+    {
+        const auto psJob = static_cast<const EvaluateJob *>(pData);
+        psJob->poArray->Evaluate(*(psJob->papadfArrays), psJob->nStart,
+                                 psJob->nCount, psJob->padfOut);
+    }
+
+  protected:
+    GDALMDArrayElementWise(
+        const std::shared_ptr<GDALMDArray> &poRefArray,
+        const std::shared_ptr<const GDALMDArrayExprNode> &poExpr,
+        GDALDataType eDT)
+        : GDALAbstractMDArray(std::string(), "Expression on " +
+                                                 poRefArray->GetFullName()),
+          GDALPamMDArray(std::string(),
+                         "Expression on " + poRefArray->GetFullName(),
+                         GDALPamMultiDim::GetPAM(poRefArray),
+                         poRefArray->GetContext()),
+          m_poRefArray(poRefArray), m_poExpr(poExpr),
+          m_dt(GDALExtendedDataType::Create(eDT))
+    {
+        Compile(m_poExpr.get(), 0);
+    }
+
+    bool IRead(const GUInt64 *arrayStartIdx, const size_t *count,
+               const GInt64 *arrayStep, const GPtrDiff_t *bufferStride,
+               const GDALExtendedDataType &bufferDataType,
+               void *pDstBuffer) const override;
+
+    bool IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
+                     CSLConstList papszOptions) const override
+    {
+        for (const auto &poArray : m_apoArrays)
+        {
+            if (!poArray->AdviseRead(arrayStartIdx, count, papszOptions))
+                return false;
+        }
+        return true;
+    }
+
+  public:
+    static std::shared_ptr<GDALMDArrayElementWise>
+    Create(const std::shared_ptr<GDALMDArray> &poRefArray,
+           const std::shared_ptr<const GDALMDArrayExprNode> &poExpr,
+           GDALDataType eDT)
+    {
+        auto newAr(std::shared_ptr<GDALMDArrayElementWise>(
+            new GDALMDArrayElementWise(poRefArray, poExpr, eDT)));
+        newAr->SetSelf(newAr);
+        return newAr;
+    }
+
+    const std::shared_ptr<const GDALMDArrayExprNode> &GetExpression() const
+    {
+        return m_poExpr;
+    }
+
+    bool IsWritable() const override
+    {
+        return false;
+    }
+
+    const std::string &GetFilename() const override
+    {
+        return m_poRefArray->GetFilename();
+    }
+
+    const std::vector<std::shared_ptr<GDALDimension>> &
+    GetDimensions() const override
+    {
+        return m_poRefArray->GetDimensions();
+    }
+
+    const GDALExtendedDataType &GetDataType() const override
+    {
+        return m_dt;
+    }
+
+    std::shared_ptr<OGRSpatialReference> GetSpatialRef() const override
+    {
+        return m_poRefArray->GetSpatialRef();
+    }
+
+    std::vector<GUInt64> GetBlockSize() const override
+    {
+        return m_poRefArray->GetBlockSize();
+    }
+};
+
+/************************************************************************/
+/*                 GDALMDArrayElementWise::Compile()                    */
+/************************************************************************/
+
+// Compile the expression tree into a program for a stack machine, in
+// post-order.
+void GDALMDArrayElementWise::Compile(const GDALMDArrayExprNode *poNode,
+                                     size_t nDepth)
+{
+    for (size_t i = 0; i < poNode->apoChildren.size(); ++i)
+        Compile(poNode->apoChildren[i].get(), nDepth + i);
+
+    GDALMDArrayExprInstr oInstr;
+    oInstr.eType = poNode->eType;
+    oInstr.eOp = poNode->eOp;
+    oInstr.dfConstant = poNode->dfConstant;
+    oInstr.eDT = poNode->eDT;
+    if (poNode->eType == GDALMDArrayExprNode::Type::ARRAY)
+    {
+        // An array used several times in the expression is read once
+        const auto oIter = std::find(m_apoArrays.begin(), m_apoArrays.end(),
+                                     poNode->poArray);
+        oInstr.iArray = static_cast<size_t>(oIter - m_apoArrays.begin());
+        if (oIter == m_apoArrays.end())
+            m_apoArrays.push_back(poNode->poArray);
+    }
+    m_aoProgram.push_back(oInstr);
+    m_nMaxStackDepth = std::max(m_nMaxStackDepth, nDepth + 1);
+}
+
+/************************************************************************/
+/*                           ApplyUnary()                               */
+/************************************************************************/
+
+template <class Func>
+static void ApplyUnary(double *padfA, size_t nCount, Func func)
+{
+    for (size_t i = 0; i < nCount; ++i)
+        padfA[i] = func(padfA[i]);
+}
+
+/************************************************************************/
+/*                           ApplyBinary()                              */
+/************************************************************************/
+
+template <class Func>
+static void ApplyBinary(double *padfA, const double *padfB, size_t nCount,
+                        Func func)
+{
+    for (size_t i = 0; i < nCount; ++i)
+        padfA[i] = func(padfA[i], padfB[i]);
+}
+
+/************************************************************************/
+/*              GDALMDArrayElementWise::EvaluateBlock()                 */
+/************************************************************************/
+
+void GDALMDArrayElementWise::EvaluateBlock(
+    const std::vector<const double *> &apadfArrays, size_t nStart,
+    size_t nCount, std::vector<double> &adfStack) const
+{
+    size_t nTop = 0;
+    const auto Slot = [&adfStack](size_t iSlot)
+    { return adfStack.data() + iSlot * EVAL_BLOCK_SIZE; };
+
+    for (const auto &oInstr : m_aoProgram)
+    {
+        switch (oInstr.eType)
+        {
+            case GDALMDArrayExprNode::Type::ARRAY:
+            {
+                memcpy(Slot(nTop), apadfArrays[oInstr.iArray] + nStart,
+                       nCount * sizeof(double));
+                ++nTop;
+                break;
+            }
+
+            case GDALMDArrayExprNode::Type::CONSTANT:
+            {
+                std::fill_n(Slot(nTop), nCount, oInstr.dfConstant);
+                ++nTop;
+                break;
+            }
+
+            case GDALMDArrayExprNode::Type::CAST:
+            {
+                // Round-trip through the target data type to apply its
+                // rounding and clamping rules
+                double *padfA = Slot(nTop - 1);
+                GByte abyTmp[EVAL_BLOCK_SIZE * sizeof(double)];
+                const int nDTSize = GDALGetDataTypeSizeBytes(oInstr.eDT);
+                GDALCopyWords64(padfA, GDT_Float64, sizeof(double), abyTmp,
+                                oInstr.eDT, nDTSize, nCount);
+                GDALCopyWords64(abyTmp, oInstr.eDT, nDTSize, padfA,
+                                GDT_Float64, sizeof(double), nCount);
+                break;
+            }
+
+            case GDALMDArrayExprNode::Type::WHERE:
+            {
+                const double *padfCond = Slot(nTop - 3);
+                const double *padfA = Slot(nTop - 2);
+                const double *padfB = Slot(nTop - 1);
+                double *padfOut = Slot(nTop - 3);
+                for (size_t i = 0; i < nCount; ++i)
+                {
+                    padfOut[i] = (padfCond[i] != 0 && !std::isnan(padfCond[i]))
+                                     ? padfA[i]
+                                     : padfB[i];
+                }
+                nTop -= 2;
+                break;
+            }
+
+            case GDALMDArrayExprNode::Type::OPERATOR:
+            {
+                double *padfA = Slot(nTop - 1);
+                switch (oInstr.eOp)
+                {
+                    case GDALMDArrayOperator::NEGATE:
+                        ApplyUnary(padfA, nCount, [](double a) { return -a; });
+                        continue;
+                    case GDALMDArrayOperator::ABS:
+                        ApplyUnary(padfA, nCount,
+                                   [](double a) { return std::fabs(a); });
+                        continue;
+                    case GDALMDArrayOperator::SQRT:
+                        ApplyUnary(padfA, nCount,
+                                   [](double a) { return std::sqrt(a); });
+                        continue;
+                    case GDALMDArrayOperator::EXP:
+                        ApplyUnary(padfA, nCount,
+                                   [](double a) { return std::exp(a); });
+                        continue;
+                    case GDALMDArrayOperator::LOG:
+                        ApplyUnary(padfA, nCount,
+                                   [](double a) { return std::log(a); });
+                        continue;
+                    case GDALMDArrayOperator::NOT:
+                        ApplyUnary(padfA, nCount,
+                                   [](double a) { return a == 0 ? 1.0 : 0.0; });
+                        continue;
+                    case GDALMDArrayOperator::IS_NAN:
+                        ApplyUnary(padfA, nCount, [](double a)
+                                   { return std::isnan(a) ? 1.0 : 0.0; });
+                        continue;
+                    default:
+                        break;
+                }
+
+                // Binary operators
+                padfA = Slot(nTop - 2);
+                const double *padfB = Slot(nTop - 1);
+                --nTop;
+                switch (oInstr.eOp)
+                {
+                    case GDALMDArrayOperator::ADD:
+                        ApplyBinary(padfA, padfB, nCount,
+                                    [](double a, double b) { return a + b; });
+                        break;
+                    case GDALMDArrayOperator::SUBTRACT:
+                        ApplyBinary(padfA, padfB, nCount,
+                                    [](double a, double b) { return a - b; });
+                        break;
+                    case GDALMDArrayOperator::MULTIPLY:
+                        ApplyBinary(padfA, padfB, nCount,
+                                    [](double a, double b) { return a * b; });
+                        break;
+                    case GDALMDArrayOperator::DIVIDE:
+                        ApplyBinary(padfA, padfB, nCount,
+                                    [](double a, double b) { return a / b; });
+                        break;
+                    case GDALMDArrayOperator::POWER:
+                        ApplyBinary(padfA, padfB, nCount, [](double a, double b)
+                                    { return std::pow(a, b); });
+                        break;
+                    case GDALMDArrayOperator::MIN:
+                        ApplyBinary(padfA, padfB, nCount, [](double a, double b)
+                                    { return std::fmin(a, b); });
+                        break;
+                    case GDALMDArrayOperator::MAX:
+                        ApplyBinary(padfA, padfB, nCount, [](double a, double b)
+                                    { return std::fmax(a, b); });
+                        break;
+                    case GDALMDArrayOperator::EQUAL:
+                        ApplyBinary(padfA, padfB, nCount, [](double a, double b)
+                                    { return a == b ? 1.0 : 0.0; });
+                        break;
+                    case GDALMDArrayOperator::NOT_EQUAL:
+                        ApplyBinary(padfA, padfB, nCount, [](double a, double b)
+                                    { return a != b ? 1.0 : 0.0; });
+                        break;
+                    case GDALMDArrayOperator::LESS:
+                        ApplyBinary(padfA, padfB, nCount, [](double a, double b)
+                                    { return a < b ? 1.0 : 0.0; });
+                        break;
+                    case GDALMDArrayOperator::LESS_OR_EQUAL:
+                        ApplyBinary(padfA, padfB, nCount, [](double a, double b)
+                                    { return a <= b ? 1.0 : 0.0; });
+                        break;
+                    case GDALMDArrayOperator::GREATER:
+                        ApplyBinary(padfA, padfB, nCount, [](double a, double b)
+                                    { return a > b ? 1.0 : 0.0; });
+                        break;
+                    case GDALMDArrayOperator::GREATER_OR_EQUAL:
+                        ApplyBinary(padfA, padfB, nCount, [](double a, double b)
+                                    { return a >= b ? 1.0 : 0.0; });
+                        break;
+                    case GDALMDArrayOperator::AND:
+                        ApplyBinary(padfA, padfB, nCount, [](double a, double b)
+                                    { return a != 0 && b != 0 ? 1.0 : 0.0; });
+                        break;
+                    case GDALMDArrayOperator::OR:
+                        ApplyBinary(padfA, padfB, nCount, [](double a, double b)
+                                    { return a != 0 || b != 0 ? 1.0 : 0.0; });
+                        break;
+                    default:
+                        CPLAssert(false);
+                        break;
+                }
+                break;
+            }
+        }
+    }
+    CPLAssert(nTop == 1);
+}
+
+/************************************************************************/
+/*                GDALMDArrayElementWise::Evaluate()                    */
+/************************************************************************/
+
+// Evaluate the expression for elements [nStart, nStart + nCount[ of the
+// source arrays, which are processed in blocks of EVAL_BLOCK_SIZE elements
+// to stay in the CPU cache.
+void GDALMDArrayElementWise::Evaluate(
+    const std::vector<const double *> &apadfArrays, size_t nStart,
+    size_t nCount, double *padfOut) const
+{
+    std::vector<double> adfStack(m_nMaxStackDepth * EVAL_BLOCK_SIZE);
+    for (size_t i = 0; i < nCount; i += EVAL_BLOCK_SIZE)
+    {
+        const size_t nBlockCount = std::min(EVAL_BLOCK_SIZE, nCount - i);
+        EvaluateBlock(apadfArrays, nStart + i, nBlockCount, adfStack);
+        memcpy(padfOut + nStart + i, adfStack.data(),
+               nBlockCount * sizeof(double));
+    }
+}
+
+/************************************************************************/
+/*                 GDALMDArrayElementWise::IRead()                      */
+/************************************************************************/
+
+bool GDALMDArrayElementWise::IRead(const GUInt64 *arrayStartIdx,
+                                   const size_t *count,
+                                   const GInt64 *arrayStep,
+                                   const GPtrDiff_t *bufferStride,
+                                   const GDALExtendedDataType &bufferDataType,
+                                   void *pDstBuffer) const
+{
+    const size_t nDims = GetDimensionCount();
+
+    // Split the request in passes along the first dimension, to limit the
+    // size of the temporary buffers.
+    size_t nEltsPerSlice = 1;
+    for (size_t i = 1; i < nDims; ++i)
+        nEltsPerSlice *= count[i];
+    const size_t nMaxEltsPerPass =
+        std::max<size_t>(1, MAX_ELTS_PER_PASS / (m_apoArrays.size() + 1));
+    const size_t nTotalSlices = nDims == 0 ? 1 : count[0];
+    const size_t nSlicesPerPass = std::max<size_t>(
+        1, std::min(nTotalSlices, nMaxEltsPerPass / nEltsPerSlice));
+
+    std::vector<std::vector<double>> aadfArrays(m_apoArrays.size());
+    std::vector<const double *> apadfArrays(m_apoArrays.size());
+    std::vector<double> adfOut;
+    try
+    {
+        const size_t nEltsPerPass = nSlicesPerPass * nEltsPerSlice;
+        for (auto &adfArray : aadfArrays)
+            adfArray.resize(nEltsPerPass);
+        adfOut.resize(nEltsPerPass);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate temporary buffers");
+        return false;
+    }
+
+    const int nThreads = GetNumThreads();
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+
+    std::vector<GUInt64> anStartIdx(arrayStartIdx, arrayStartIdx + nDims);
+    std::vector<size_t> anCount(count, count + nDims);
+    for (size_t iSlice = 0; iSlice < nTotalSlices; iSlice += nSlicesPerPass)
+    {
+        const size_t nSlices = std::min(nSlicesPerPass, nTotalSlices - iSlice);
+        if (nDims > 0)
+        {
+            anStartIdx[0] = static_cast<GUInt64>(
+                static_cast<GInt64>(arrayStartIdx[0]) +
+                static_cast<GInt64>(iSlice) * arrayStep[0]);
+            anCount[0] = nSlices;
+        }
+        const size_t nElts = nSlices * nEltsPerSlice;
+
+        // Reading is done sequentially, as drivers are generally not
+        // thread-safe, but only the requested window, and with the
+        // requested step, is read from them.
+        for (size_t i = 0; i < m_apoArrays.size(); ++i)
+        {
+            if (!ReadAsDouble(m_apoArrays[i].get(), anStartIdx.data(),
+                              anCount.data(), arrayStep, nElts,
+                              aadfArrays[i].data()))
+            {
+                return false;
+            }
+            apadfArrays[i] = aadfArrays[i].data();
+        }
+
+        constexpr size_t MIN_ELTS_PER_JOB = 64 * 1024;
+        const size_t nJobs =
+            poPool ? std::min<size_t>(nThreads, nElts / MIN_ELTS_PER_JOB) : 1;
+        if (nJobs > 1)
+        {
+            auto poQueue = poPool->CreateJobQueue();
+            const size_t nEltsPerJob = DIV_ROUND_UP(nElts, nJobs);
+            std::vector<EvaluateJob> asJobs(nJobs);
+            for (size_t iJob = 0; iJob < nJobs; ++iJob)
+            {
+                auto &sJob = asJobs[iJob];
+                sJob.poArray = this;
+                sJob.papadfArrays = &apadfArrays;
+                sJob.nStart = std::min(iJob * nEltsPerJob, nElts);
+                sJob.nCount = std::min(nEltsPerJob, nElts - sJob.nStart);
+                sJob.padfOut = adfOut.data();
+                poQueue->SubmitJob(EvaluateJobFunc, &sJob);
+            }
+            poQueue->WaitCompletion();
+        }
+        else
+        {
+            Evaluate(apadfArrays, 0, nElts, adfOut.data());
+        }
+
+        GByte *pabyDst = static_cast<GByte *>(pDstBuffer);
+        if (nDims > 0)
+        {
+            pabyDst += static_cast<GPtrDiff_t>(iSlice) * bufferStride[0] *
+                       static_cast<GPtrDiff_t>(bufferDataType.GetSize());
+        }
+        CopyToBuffer(adfOut.data(), nDims, anCount.data(), bufferStride,
+                     bufferDataType, pabyDst);
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                           GetExprNode()                              */
+/************************************************************************/
+
+// Return the expression node corresponding to an array: the expression of
+// an element-wise array, so that it gets fused with the new operation, or
+// a leaf node otherwise.
+static std::shared_ptr<const GDALMDArrayExprNode>
+GetExprNode(const std::shared_ptr<GDALMDArray> &poArray)
+{
+    auto poElementWise =
+        std::dynamic_pointer_cast<GDALMDArrayElementWise>(poArray);
+    if (poElementWise &&
+        poElementWise->GetDataType().GetNumericDataType() == GDT_Float64)
+    {
+        return poElementWise->GetExpression();
+    }
+    auto poNode = std::make_shared<GDALMDArrayExprNode>();
+    poNode->eType = GDALMDArrayExprNode::Type::ARRAY;
+    poNode->poArray = poArray;
+    return poNode;
+}
+
+/************************************************************************/
+/*                      CheckExpressionOperand()                        */
+/************************************************************************/
+
+static bool CheckExpressionOperand(const GDALMDArray *poArray,
+                                   const GDALMDArray *poOther,
+                                   const char *pszFunc)
+{
+    const auto &dt = poOther->GetDataType();
+    if (dt.GetClass() != GEDTC_NUMERIC ||
+        GDALDataTypeIsComplex(dt.GetNumericDataType()))
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "%s() only supports non-complex numeric data types",
+                 pszFunc);
+        return false;
+    }
+    if (!HaveSameDimensionSizes(poArray, poOther))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "%s(): %s has not the same dimensions as %s", pszFunc,
+                 poOther->GetFullName().c_str(),
+                 poArray->GetFullName().c_str());
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                          GetElementWise()                            */
+/************************************************************************/
+
+/** Return an array whose values are the result of an element-wise operator
+ * applied to the values of the current array, and optionally of another one.
+ *
+ * The returned array is lazily evaluated: no computation is done until
+ * its values are read. Nested element-wise arrays (including the ones
+ * returned by GetWhere() and GetCast()) are fused together, so that reading
+ * a window of the final array reads the corresponding window of each source
+ * array once, and evaluates the whole expression in a single pass. Only the
+ * requested window, and with the requested step, is read from the source
+ * arrays, including when it is accessed through GetView().
+ *
+ * Values are computed as double-precision floating-point values, and
+ * nodata values of the source arrays are handled as NaN. The data type of
+ * the returned array is Float64.
+ *
+ * If the GDAL_NUM_THREADS configuration option is set, the evaluation of
+ * large windows is spread over several threads.
+ *
+ * @param eOp Operator.
+ * @param poOther Second operand of binary operators, that must have the same
+ * dimension sizes as the current array. Must be nullptr for unary
+ * operators.
+ * @return a new array, or nullptr in case of error.
+ * @since GDAL 3.9
+ */
+std::shared_ptr<GDALMDArray>
+GDALMDArray::GetElementWise(GDALMDArrayOperator eOp,
+                            const std::shared_ptr<GDALMDArray> &poOther) const
+{
+    auto self = std::dynamic_pointer_cast<GDALMDArray>(m_pSelf.lock());
+    if (!self)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Driver implementation issue: m_pSelf not set !");
+        return nullptr;
+    }
+    if (!CheckExpressionOperand(this, this, "GetElementWise"))
+        return nullptr;
+
+    const bool bUnary = eOp >= GDALMDArrayOperator::NEGATE;
+    if (bUnary != (poOther == nullptr))
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 bUnary ? "GetElementWise(): unary operator used with two "
+                          "operands"
+                        : "GetElementWise(): binary operator used with a "
+                          "single operand");
+        return nullptr;
+    }
+    if (poOther && !CheckExpressionOperand(this, poOther.get(),
+                                           "GetElementWise"))
+    {
+        return nullptr;
+    }
+
+    auto poNode = std::make_shared<GDALMDArrayExprNode>();
+    poNode->eType = GDALMDArrayExprNode::Type::OPERATOR;
+    poNode->eOp = eOp;
+    poNode->apoChildren.push_back(GetExprNode(self));
+    if (poOther)
+        poNode->apoChildren.push_back(GetExprNode(poOther));
+    return GDALMDArrayElementWise::Create(self, poNode, GDT_Float64);
+}
+
+/** Return an array whose values are the result of a binary element-wise
+ * operator applied to the values of the current array and a constant.
+ *
+ * See GetElementWise(GDALMDArrayOperator, const std::shared_ptr<GDALMDArray>&)
+ * for the evaluation rules.
+ *
+ * @param eOp Binary operator.
+ * @param dfConstant Constant.
+ * @param bConstantFirst Whether the constant is the first operand (e.g.
+ * dfConstant - array), instead of the second one (e.g. array - dfConstant).
+ * @return a new array, or nullptr in case of error.
+ * @since GDAL 3.9
+ */
+std::shared_ptr<GDALMDArray>
+GDALMDArray::GetElementWise(GDALMDArrayOperator eOp, double dfConstant,
+                            bool bConstantFirst) const
+{
+    auto self = std::dynamic_pointer_cast<GDALMDArray>(m_pSelf.lock());
+    if (!self)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Driver implementation issue: m_pSelf not set !");
+        return nullptr;
+    }
+    if (!CheckExpressionOperand(this, this, "GetElementWise"))
+        return nullptr;
+    if (eOp >= GDALMDArrayOperator::NEGATE)
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "GetElementWise(): unary operator used with two operands");
+        return nullptr;
+    }
+
+    auto poConstant = std::make_shared<GDALMDArrayExprNode>();
+    poConstant->eType = GDALMDArrayExprNode::Type::CONSTANT;
+    poConstant->dfConstant = dfConstant;
+
+    auto poNode = std::make_shared<GDALMDArrayExprNode>();
+    poNode->eType = GDALMDArrayExprNode::Type::OPERATOR;
+    poNode->eOp = eOp;
+    if (bConstantFirst)
+    {
+        poNode->apoChildren.push_back(poConstant);
+        poNode->apoChildren.push_back(GetExprNode(self));
+    }
+    else
+    {
+        poNode->apoChildren.push_back(GetExprNode(self));
+        poNode->apoChildren.push_back(poConstant);
+    }
+    return GDALMDArrayElementWise::Create(self, poNode, GDT_Float64);
+}
+
+/************************************************************************/
+/*                             GetWhere()                               */
+/************************************************************************/
+
+/** Return an array whose values are the ones of the current array where a
+ * condition is true, and the ones of another array (or NaN) elsewhere.
+ *
+ * This is the equivalent of numpy.where(condition, array, other).
+ *
+ * The condition is true for values that are non-zero and not NaN. For
+ * example, the array returned by GetMask() can be used as a condition.
+ *
+ * See GetElementWise(GDALMDArrayOperator, const std::shared_ptr<GDALMDArray>&)
+ * for the evaluation rules.
+ *
+ * @param poCondition Condition array, that must have the same dimension sizes
+ * as the current array.
+ * @param poOther Array providing the values where the condition is false, or
+ * nullptr to use NaN.
+ * @return a new array, or nullptr in case of error.
+ * @since GDAL 3.9
+ */
+std::shared_ptr<GDALMDArray>
+GDALMDArray::GetWhere(const std::shared_ptr<GDALMDArray> &poCondition,
+                      const std::shared_ptr<GDALMDArray> &poOther) const
+{
+    auto self = std::dynamic_pointer_cast<GDALMDArray>(m_pSelf.lock());
+    if (!self)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Driver implementation issue: m_pSelf not set !");
+        return nullptr;
+    }
+    if (!poCondition)
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "GetWhere(): poCondition should not be null");
+        return nullptr;
+    }
+    if (!CheckExpressionOperand(this, this, "GetWhere") ||
+        !CheckExpressionOperand(this, poCondition.get(), "GetWhere") ||
+        (poOther && !CheckExpressionOperand(this, poOther.get(), "GetWhere")))
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<const GDALMDArrayExprNode> poOtherNode;
+    if (poOther)
+    {
+        poOtherNode = GetExprNode(poOther);
+    }
+    else
+    {
+        auto poConstant = std::make_shared<GDALMDArrayExprNode>();
+        poConstant->eType = GDALMDArrayExprNode::Type::CONSTANT;
+        poConstant->dfConstant = std::numeric_limits<double>::quiet_NaN();
+        poOtherNode = std::move(poConstant);
+    }
+
+    auto poNode = std::make_shared<GDALMDArrayExprNode>();
+    poNode->eType = GDALMDArrayExprNode::Type::WHERE;
+    poNode->apoChildren.push_back(GetExprNode(poCondition));
+    poNode->apoChildren.push_back(GetExprNode(self));
+    poNode->apoChildren.push_back(std::move(poOtherNode));
+    return GDALMDArrayElementWise::Create(self, poNode, GDT_Float64);
+}
+
+/************************************************************************/
+/*                              GetCast()                               */
+/************************************************************************/
+
+/** Return an array whose values are the ones of the current array converted
+ * to another data type.
+ *
+ * Values are rounded to the nearest integer and clamped to the range of the
+ * target data type, as done by GDALCopyWords(). NaN values are converted to 0
+ * for integer data types.
+ *
+ * If the current array is the result of GetElementWise() or GetWhere(), the
+ * cast is fused with its expression.
+ *
+ * @param eDT Target data type. Must be a non-complex numeric data type.
+ * @return a new array, or nullptr in case of error.
+ * @since GDAL 3.9
+ */
+std::shared_ptr<GDALMDArray> GDALMDArray::GetCast(GDALDataType eDT) const
+{
+    auto self = std::dynamic_pointer_cast<GDALMDArray>(m_pSelf.lock());
+    if (!self)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Driver implementation issue: m_pSelf not set !");
+        return nullptr;
+    }
+    if (!CheckExpressionOperand(this, this, "GetCast"))
+        return nullptr;
+    if (eDT == GDT_Unknown || eDT >= GDT_TypeCount ||
+        GDALDataTypeIsComplex(eDT))
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "GetCast() only supports non-complex numeric data types");
+        return nullptr;
+    }
+
+    auto poNode = std::make_shared<GDALMDArrayExprNode>();
+    poNode->eType = GDALMDArrayExprNode::Type::CAST;
+    poNode->eDT = eDT;
+    poNode->apoChildren.push_back(GetExprNode(self));
+    return GDALMDArrayElementWise::Create(self, poNode, eDT);
+}
+
+/************************************************************************/
+/*                          GDALMDArrayReduced                          */
+/************************************************************************/
+
+// Lazy reduction of an array along one of its dimensions.
+class GDALMDArrayReduced final : public GDALPamMDArray
+{
+  private:
+    std::shared_ptr<GDALMDArray> m_poParent{};
+    const GDALMDArrayReduction m_eReduction;
+    const size_t m_iDim;
+    std::vector<std::shared_ptr<GDALDimension>> m_apoDims{};
+    const GDALExtendedDataType m_dt{GDALExtendedDataType::Create(GDT_Float64)};
+
+  protected:
+    GDALMDArrayReduced(const std::shared_ptr<GDALMDArray> &poParent,
+                       GDALMDArrayReduction eReduction, size_t iDim)
+        : GDALAbstractMDArray(std::string(),
+                              "Reduction of " + poParent->GetFullName()),
+          GDALPamMDArray(std::string(),
+                         "Reduction of " + poParent->GetFullName(),
+                         GDALPamMultiDim::GetPAM(poParent),
+                         poParent->GetContext()),
+          m_poParent(poParent), m_eReduction(eReduction), m_iDim(iDim)
+    {
+        const auto &apoParentDims = m_poParent->GetDimensions();
+        for (size_t i = 0; i < apoParentDims.size(); ++i)
+        {
+            if (i != m_iDim)
+                m_apoDims.push_back(apoParentDims[i]);
+        }
+    }
+
+    bool IRead(const GUInt64 *arrayStartIdx, const size_t *count,
+               const GInt64 *arrayStep, const GPtrDiff_t *bufferStride,
+               const GDALExtendedDataType &bufferDataType,
+               void *pDstBuffer) const override;
+
+  public:
+    static std::shared_ptr<GDALMDArrayReduced>
+    Create(const std::shared_ptr<GDALMDArray> &poParent,
+           GDALMDArrayReduction eReduction, size_t iDim)
+    {
+        auto newAr(std::shared_ptr<GDALMDArrayReduced>(
+            new GDALMDArrayReduced(poParent, eReduction, iDim)));
+        newAr->SetSelf(newAr);
+        return newAr;
+    }
+
+    bool IsWritable() const override
+    {
+        return false;
+    }
+
+    const std::string &GetFilename() const override
+    {
+        return m_poParent->GetFilename();
+    }
+
+    const std::vector<std::shared_ptr<GDALDimension>> &
+    GetDimensions() const override
+    {
+        return m_apoDims;
+    }
+
+    const GDALExtendedDataType &GetDataType() const override
+    {
+        return m_dt;
+    }
+
+    std::vector<GUInt64> GetBlockSize() const override
+    {
+        auto anBlockSize = m_poParent->GetBlockSize();
+        if (m_iDim < anBlockSize.size())
+            anBlockSize.erase(anBlockSize.begin() + m_iDim);
+        return anBlockSize;
+    }
+};
+
+/************************************************************************/
+/*                   GDALMDArrayReduced::IRead()                        */
+/************************************************************************/
+
+bool GDALMDArrayReduced::IRead(const GUInt64 *arrayStartIdx,
+                               const size_t *count, const GInt64 *arrayStep,
+                               const GPtrDiff_t *bufferStride,
+                               const GDALExtendedDataType &bufferDataType,
+                               void *pDstBuffer) const
+{
+    const size_t nDims = m_apoDims.size();
+    const size_t nParentDims = nDims + 1;
+    const size_t nReducedSize =
+        static_cast<size_t>(m_poParent->GetDimensions()[m_iDim]->GetSize());
+
+    size_t nOutElts = 1;
+    for (size_t i = 0; i < nDims; ++i)
+        nOutElts *= count[i];
+    // Number of output elements before and after the reduced dimension
+    size_t nInner = 1;
+    for (size_t i = m_iDim; i < nDims; ++i)
+        nInner *= count[i];
+    const size_t nOuter = nOutElts / nInner;
+
+    // Read the reduced dimension by chunks, to limit memory usage
+    const size_t nChunkSize = std::max<size_t>(
+        1, std::min(nReducedSize, MAX_ELTS_PER_PASS / nOutElts));
+
+    std::vector<double> adfSrc;
+    std::vector<double> adfAcc;
+    std::vector<GUInt64> anValidCount;
+    try
+    {
+        adfSrc.resize(nChunkSize * nOutElts);
+        const double dfInit =
+            m_eReduction == GDALMDArrayReduction::MIN
+                ? std::numeric_limits<double>::infinity()
+            : m_eReduction == GDALMDArrayReduction::MAX
+                ? -std::numeric_limits<double>::infinity()
+                : 0.0;
+        adfAcc.resize(nOutElts, dfInit);
+        anValidCount.resize(nOutElts);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate temporary buffers");
+        return false;
+    }
+
+    std::vector<GUInt64> anParentStartIdx(nParentDims);
+    std::vector<size_t> anParentCount(nParentDims);
+    std::vector<GInt64> anParentStep(nParentDims);
+    for (size_t i = 0, j = 0; i < nParentDims; ++i)
+    {
+        if (i == m_iDim)
+        {
+            anParentStep[i] = 1;
+        }
+        else
+        {
+            anParentStartIdx[i] = arrayStartIdx[j];
+            anParentCount[i] = count[j];
+            anParentStep[i] = arrayStep[j];
+            ++j;
+        }
+    }
+
+    for (size_t iStart = 0; iStart < nReducedSize; iStart += nChunkSize)
+    {
+        const size_t nChunk = std::min(nChunkSize, nReducedSize - iStart);
+        anParentStartIdx[m_iDim] = iStart;
+        anParentCount[m_iDim] = nChunk;
+        if (!ReadAsDouble(m_poParent.get(), anParentStartIdx.data(),
+                          anParentCount.data(), anParentStep.data(),
+                          nChunk * nOutElts, adfSrc.data()))
+        {
+            return false;
+        }
+
+        const double *padfSrc = adfSrc.data();
+        for (size_t iOuter = 0; iOuter < nOuter; ++iOuter)
+        {
+            for (size_t k = 0; k < nChunk; ++k)
+            {
+                double *padfAcc = adfAcc.data() + iOuter * nInner;
+                GUInt64 *panValidCount = anValidCount.data() + iOuter * nInner;
+                for (size_t i = 0; i < nInner; ++i)
+                {
+                    const double dfVal = padfSrc[i];
+                    if (std::isnan(dfVal))
+                        continue;
+                    ++panValidCount[i];
+                    if (m_eReduction == GDALMDArrayReduction::MIN)
+                        padfAcc[i] = std::min(padfAcc[i], dfVal);
+                    else if (m_eReduction == GDALMDArrayReduction::MAX)
+                        padfAcc[i] = std::max(padfAcc[i], dfVal);
+                    else
+                        padfAcc[i] += dfVal;
+                }
+                padfSrc += nInner;
+            }
+        }
+    }
+
+    constexpr double dfNaN = std::numeric_limits<double>::quiet_NaN();
+    for (size_t i = 0; i < nOutElts; ++i)
+    {
+        switch (m_eReduction)
+        {
+            case GDALMDArrayReduction::SUM:
+                break;
+            case GDALMDArrayReduction::MEAN:
+                adfAcc[i] = anValidCount[i] ? adfAcc[i] / anValidCount[i]
+                                            : dfNaN;
+                break;
+            case GDALMDArrayReduction::MIN:
+            case GDALMDArrayReduction::MAX:
+                if (anValidCount[i] == 0)
+                    adfAcc[i] = dfNaN;
+                break;
+            case GDALMDArrayReduction::COUNT:
+                adfAcc[i] = static_cast<double>(anValidCount[i]);
+                break;
+        }
+    }
+
+    CopyToBuffer(adfAcc.data(), nDims, count, bufferStride, bufferDataType,
+                 pDstBuffer);
+    return true;
+}
+
+/************************************************************************/
+/*                             GetReduced()                             */
+/************************************************************************/
+
+/** Return an array that is the reduction of the current array along one of
+ * its dimensions.
+ *
+ * The returned array has the dimensions of the current array, except the
+ * reduced one. It is lazily evaluated: reading a window of it reads the
+ * corresponding window of the current array, over the whole extent of the
+ * reduced dimension, by chunks to limit memory usage. NaN and nodata values
+ * are ignored. The data type of the returned array is Float64.
+ *
+ * The returned array can itself be used as an operand of GetElementWise()
+ * or GetWhere(), for example to compute anomalies relative to a mean.
+ *
+ * @param eReduction Reduction.
+ * @param iDim Index of the dimension to reduce.
+ * @return a new array, or nullptr in case of error.
+ * @since GDAL 3.9
+ */
+std::shared_ptr<GDALMDArray>
+GDALMDArray::GetReduced(GDALMDArrayReduction eReduction, size_t iDim) const
+{
+    auto self = std::dynamic_pointer_cast<GDALMDArray>(m_pSelf.lock());
+    if (!self)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Driver implementation issue: m_pSelf not set !");
+        return nullptr;
+    }
+    if (!CheckExpressionOperand(this, this, "GetReduced"))
+        return nullptr;
+    if (iDim >= GetDimensionCount())
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "GetReduced(): invalid dimension index");
+        return nullptr;
+    }
+    return GDALMDArrayReduced::Create(self, eReduction, iDim);
+}
@@ -0,0 +1,383 @@
+/******************************************************************************
+ * Project:  GDAL Core
+ * Purpose:  Kernels computing nodata masks, shared by GDALNoDataMaskBand and
+ *           GDALNoDataValuesMaskBand
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef GDALNODATAMASK_PRIV_H_INCLUDED
+#define GDALNODATAMASK_PRIV_H_INCLUDED
+
+#ifndef DOXYGEN_SKIP
+
+#include "cpl_port.h"
+#include "gdal_priv.h"
+
+#include <cstdint>
+#include <limits>
+
+#if defined(__x86_64) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+/************************************************************************/
+/*                        GDALNoDataMaskLine()                          */
+/************************************************************************/
+
+// Sets pabyDst[i] to 0 where panSrc[i] == tNoData, and to 255 elsewhere.
+// The comparison is exact, so NaN values are never considered as nodata.
+// panSrc and pabyDst may point to the same buffer when T is GByte.
+template <class T>
+inline void GDALNoDataMaskLine(const T *panSrc, GByte *pabyDst, size_t nCount,
+                               T tNoData)
+{
+    for (size_t i = 0; i < nCount; ++i)
+    {
+        pabyDst[i] = panSrc[i] == tNoData ? 0 : 255;
+    }
+}
+
+/************************************************************************/
+/*                      GDALNoDataMaskLineReal()                        */
+/************************************************************************/
+
+// Same as GDALNoDataMaskLine(), but with the semantics of
+// GDALNoDataMaskBand for floating-point types: values equal to tNoData
+// within the ARE_REAL_EQUAL() tolerance are nodata, and if tNoData is NaN,
+// NaN values are nodata.
+template <class T>
+inline void GDALNoDataMaskLineReal(const T *pafSrc, GByte *pabyDst,
+                                   size_t nCount, T tNoData)
+{
+    const bool bIsNoDataNan = CPLIsNan(tNoData) != 0;
+    for (size_t i = 0; i < nCount; ++i)
+    {
+        const T fVal = pafSrc[i];
+        if (bIsNoDataNan)
+            pabyDst[i] = CPLIsNan(fVal) ? 0 : 255;
+        else
+            pabyDst[i] = ARE_REAL_EQUAL(fVal, tNoData) ? 0 : 255;
+    }
+}
+
+#if defined(__x86_64) || defined(_M_X64)
+
+// SSE2 specializations. Equality masks are computed on full registers, and
+// then narrowed to one byte per pixel with saturating packs, which preserve
+// the all-ones/all-zeroes lanes produced by the comparison instructions.
+
+/************************************************************************/
+/*                      GDALNoDataMaskPack32()                          */
+/************************************************************************/
+
+// Narrows 4 registers of 32-bit lane masks into 16 bytes, and inverts them
+// so that matching lanes are 0 and others 255.
+static inline __m128i GDALNoDataMaskPack32(__m128i a, __m128i b, __m128i c,
+                                           __m128i d)
+{
+    const __m128i eq =
+        _mm_packs_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+    return _mm_andnot_si128(eq, _mm_set1_epi8(-1));
+}
+
+/************************************************************************/
+/*                      GDALNoDataMaskPack64()                          */
+/************************************************************************/
+
+// Keeps the low 32-bit half of each 64-bit lane mask of a and b.
+static inline __m128i GDALNoDataMaskPack64(__m128i a, __m128i b)
+{
+    return _mm_unpacklo_epi64(_mm_shuffle_epi32(a, _MM_SHUFFLE(2, 0, 2, 0)),
+                              _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+/************************************************************************/
+/*                       GDALNoDataMaskCmpEq64()                        */
+/************************************************************************/
+
+// 64-bit integer equality, as _mm_cmpeq_epi64 is SSE4.1 only.
+static inline __m128i GDALNoDataMaskCmpEq64(__m128i a, __m128i b)
+{
+    const __m128i eq32 = _mm_cmpeq_epi32(a, b);
+    return _mm_and_si128(eq32,
+                         _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+template <>
+inline void GDALNoDataMaskLine<GByte>(const GByte *pabySrc, GByte *pabyDst,
+                                      size_t nCount, GByte byNoData)
+{
+    const __m128i xmmNoData = _mm_set1_epi8(static_cast<char>(byNoData));
+    const __m128i xmm255 = _mm_set1_epi8(-1);
+    size_t i = 0;
+    for (; i + 16 <= nCount; i += 16)
+    {
+        const __m128i v =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pabySrc + i));
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i *>(pabyDst + i),
+            _mm_andnot_si128(_mm_cmpeq_epi8(v, xmmNoData), xmm255));
+    }
+    for (; i < nCount; ++i)
+    {
+        pabyDst[i] = pabySrc[i] == byNoData ? 0 : 255;
+    }
+}
+
+static inline void GDALNoDataMaskLine32Bit(const void *pSrc, GByte *pabyDst,
+                                           size_t nCount, int32_t nNoData)
+{
+    const int32_t *panSrc = static_cast<const int32_t *>(pSrc);
+    const __m128i xmmNoData = _mm_set1_epi32(nNoData);
+    size_t i = 0;
+    for (; i + 16 <= nCount; i += 16)
+    {
+        const __m128i *p = reinterpret_cast<const __m128i *>(panSrc + i);
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i *>(pabyDst + i),
+            GDALNoDataMaskPack32(
+                _mm_cmpeq_epi32(_mm_loadu_si128(p + 0), xmmNoData),
+                _mm_cmpeq_epi32(_mm_loadu_si128(p + 1), xmmNoData),
+                _mm_cmpeq_epi32(_mm_loadu_si128(p + 2), xmmNoData),
+                _mm_cmpeq_epi32(_mm_loadu_si128(p + 3), xmmNoData)));
+    }
+    for (; i < nCount; ++i)
+    {
+        pabyDst[i] = panSrc[i] == nNoData ? 0 : 255;
+    }
+}
+
+template <>
+inline void GDALNoDataMaskLine<GInt32>(const GInt32 *panSrc, GByte *pabyDst,
+                                       size_t nCount, GInt32 nNoData)
+{
+    GDALNoDataMaskLine32Bit(panSrc, pabyDst, nCount, nNoData);
+}
+
+template <>
+inline void GDALNoDataMaskLine<GUInt32>(const GUInt32 *panSrc,
+                                        GByte *pabyDst, size_t nCount,
+                                        GUInt32 nNoData)
+{
+    GDALNoDataMaskLine32Bit(panSrc, pabyDst, nCount,
+                            static_cast<int32_t>(nNoData));
+}
+
+static inline void GDALNoDataMaskLine64Bit(const void *pSrc, GByte *pabyDst,
+                                           size_t nCount, int64_t nNoData)
+{
+    const int64_t *panSrc = static_cast<const int64_t *>(pSrc);
+    const __m128i xmmNoData = _mm_set1_epi64x(nNoData);
+    size_t i = 0;
+    for (; i + 16 <= nCount; i += 16)
+    {
+        const __m128i *p = reinterpret_cast<const __m128i *>(panSrc + i);
+        __m128i aEq[8];
+        for (int j = 0; j < 8; ++j)
+            aEq[j] = GDALNoDataMaskCmpEq64(_mm_loadu_si128(p + j), xmmNoData);
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i *>(pabyDst + i),
+            GDALNoDataMaskPack32(GDALNoDataMaskPack64(aEq[0], aEq[1]),
+                                 GDALNoDataMaskPack64(aEq[2], aEq[3]),
+                                 GDALNoDataMaskPack64(aEq[4], aEq[5]),
+                                 GDALNoDataMaskPack64(aEq[6], aEq[7])));
+    }
+    for (; i < nCount; ++i)
+    {
+        pabyDst[i] = panSrc[i] == nNoData ? 0 : 255;
+    }
+}
+
+template <>
+inline void GDALNoDataMaskLine<int64_t>(const int64_t *panSrc,
+                                        GByte *pabyDst, size_t nCount,
+                                        int64_t nNoData)
+{
+    GDALNoDataMaskLine64Bit(panSrc, pabyDst, nCount, nNoData);
+}
+
+template <>
+inline void GDALNoDataMaskLine<uint64_t>(const uint64_t *panSrc,
+                                         GByte *pabyDst, size_t nCount,
+                                         uint64_t nNoData)
+{
+    GDALNoDataMaskLine64Bit(panSrc, pabyDst, nCount,
+                            static_cast<int64_t>(nNoData));
+}
+
+template <>
+inline void GDALNoDataMaskLine<float>(const float *pafSrc, GByte *pabyDst,
+                                      size_t nCount, float fNoData)
+{
+    const __m128 xmmNoData = _mm_set1_ps(fNoData);
+    size_t i = 0;
+    for (; i + 16 <= nCount; i += 16)
+    {
+        const float *p = pafSrc + i;
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i *>(pabyDst + i),
+            GDALNoDataMaskPack32(
+                _mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(p), xmmNoData)),
+                _mm_castps_si128(
+                    _mm_cmpeq_ps(_mm_loadu_ps(p + 4), xmmNoData)),
+                _mm_castps_si128(
+                    _mm_cmpeq_ps(_mm_loadu_ps(p + 8), xmmNoData)),
+                _mm_castps_si128(
+                    _mm_cmpeq_ps(_mm_loadu_ps(p + 12), xmmNoData))));
+    }
+    for (; i < nCount; ++i)
+    {
+        pabyDst[i] = pafSrc[i] == fNoData ? 0 : 255;
+    }
+}
+
+template <>
+inline void GDALNoDataMaskLine<double>(const double *padfSrc, GByte *pabyDst,
+                                       size_t nCount, double dfNoData)
+{
+    const __m128d xmmNoData = _mm_set1_pd(dfNoData);
+    size_t i = 0;
+    for (; i + 16 <= nCount; i += 16)
+    {
+        __m128i aEq[8];
+        for (int j = 0; j < 8; ++j)
+            aEq[j] = _mm_castpd_si128(
+                _mm_cmpeq_pd(_mm_loadu_pd(padfSrc + i + 2 * j), xmmNoData));
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i *>(pabyDst + i),
+            GDALNoDataMaskPack32(GDALNoDataMaskPack64(aEq[0], aEq[1]),
+                                 GDALNoDataMaskPack64(aEq[2], aEq[3]),
+                                 GDALNoDataMaskPack64(aEq[4], aEq[5]),
+                                 GDALNoDataMaskPack64(aEq[6], aEq[7])));
+    }
+    for (; i < nCount; ++i)
+    {
+        pabyDst[i] = padfSrc[i] == dfNoData ? 0 : 255;
+    }
+}
+
+// The ARE_REAL_EQUAL() tolerance test is evaluated with the same sequence
+// of operations as the scalar code, so that results are bit-identical.
+
+static inline __m128 GDALNoDataMaskRealEqual(__m128 v, __m128 xmmNoData)
+{
+    const __m128 xmmAbsMask =
+        _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 xmmEpsilon =
+        _mm_set1_ps(std::numeric_limits<float>::epsilon());
+    const __m128 xmmTwo = _mm_set1_ps(2.0f);
+    const __m128 absDiff = _mm_and_ps(_mm_sub_ps(v, xmmNoData), xmmAbsMask);
+    const __m128 absSum = _mm_and_ps(_mm_add_ps(v, xmmNoData), xmmAbsMask);
+    return _mm_or_ps(
+        _mm_cmpeq_ps(v, xmmNoData),
+        _mm_cmplt_ps(absDiff,
+                     _mm_mul_ps(_mm_mul_ps(xmmEpsilon, absSum), xmmTwo)));
+}
+
+static inline __m128d GDALNoDataMaskRealEqual(__m128d v, __m128d xmmNoData)
+{
+    const __m128d xmmAbsMask =
+        _mm_castsi128_pd(_mm_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+    const __m128d xmmEpsilon =
+        _mm_set1_pd(std::numeric_limits<float>::epsilon());
+    const __m128d xmmTwo = _mm_set1_pd(2.0);
+    const __m128d absDiff = _mm_and_pd(_mm_sub_pd(v, xmmNoData), xmmAbsMask);
+    const __m128d absSum = _mm_and_pd(_mm_add_pd(v, xmmNoData), xmmAbsMask);
+    return _mm_or_pd(
+        _mm_cmpeq_pd(v, xmmNoData),
+        _mm_cmplt_pd(absDiff,
+                     _mm_mul_pd(_mm_mul_pd(xmmEpsilon, absSum), xmmTwo)));
+}
+
+template <>
+inline void GDALNoDataMaskLineReal<float>(const float *pafSrc,
+                                          GByte *pabyDst, size_t nCount,
+                                          float fNoData)
+{
+    const bool bIsNoDataNan = CPLIsNan(fNoData) != 0;
+    const __m128 xmmNoData = _mm_set1_ps(fNoData);
+    size_t i = 0;
+    for (; i + 16 <= nCount; i += 16)
+    {
+        __m128i aEq[4];
+        for (int j = 0; j < 4; ++j)
+        {
+            const __m128 v = _mm_loadu_ps(pafSrc + i + 4 * j);
+            aEq[j] = _mm_castps_si128(
+                bIsNoDataNan ? _mm_cmpunord_ps(v, v)
+                             : GDALNoDataMaskRealEqual(v, xmmNoData));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pabyDst + i),
+                         GDALNoDataMaskPack32(aEq[0], aEq[1], aEq[2], aEq[3]));
+    }
+    for (; i < nCount; ++i)
+    {
+        const float fVal = pafSrc[i];
+        if (bIsNoDataNan)
+            pabyDst[i] = CPLIsNan(fVal) ? 0 : 255;
+        else
+            pabyDst[i] = ARE_REAL_EQUAL(fVal, fNoData) ? 0 : 255;
+    }
+}
+
+template <>
+inline void GDALNoDataMaskLineReal<double>(const double *padfSrc,
+                                           GByte *pabyDst, size_t nCount,
+                                           double dfNoData)
+{
+    const bool bIsNoDataNan = CPLIsNan(dfNoData) != 0;
+    const __m128d xmmNoData = _mm_set1_pd(dfNoData);
+    size_t i = 0;
+    for (; i + 16 <= nCount; i += 16)
+    {
+        __m128i aEq[8];
+        for (int j = 0; j < 8; ++j)
+        {
+            const __m128d v = _mm_loadu_pd(padfSrc + i + 2 * j);
+            aEq[j] = _mm_castpd_si128(
+                bIsNoDataNan ? _mm_cmpunord_pd(v, v)
+                             : GDALNoDataMaskRealEqual(v, xmmNoData));
+        }
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i *>(pabyDst + i),
+            GDALNoDataMaskPack32(GDALNoDataMaskPack64(aEq[0], aEq[1]),
+                                 GDALNoDataMaskPack64(aEq[2], aEq[3]),
+                                 GDALNoDataMaskPack64(aEq[4], aEq[5]),
+                                 GDALNoDataMaskPack64(aEq[6], aEq[7])));
+    }
+    for (; i < nCount; ++i)
+    {
+        const double dfVal = padfSrc[i];
+        if (bIsNoDataNan)
+            pabyDst[i] = CPLIsNan(dfVal) ? 0 : 255;
+        else
+            pabyDst[i] = ARE_REAL_EQUAL(dfVal, dfNoData) ? 0 : 255;
+    }
+}
+
+#endif  // defined(__x86_64) || defined(_M_X64)
+
+#endif  // DOXYGEN_SKIP
+
+#endif  // GDALNODATAMASK_PRIV_H_INCLUDED
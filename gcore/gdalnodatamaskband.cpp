@@ -39,6 +39,7 @@
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_priv_templates.hpp"
+#include "gdalnodatamask_priv.h"
 
 //! @cond Doxygen_Suppress
 /************************************************************************/
@@ -147,6 +148,42 @@ static GDALDataType GetWorkDataType(GDALDataType eDataType)
     return eWrkDT;
 }
 
+/************************************************************************/
+/*                            ComputeMask()                             */
+/************************************************************************/
+
+// Computes the mask of a contiguous nBufXSize x nBufYSize buffer of
+// values, line by line, with the kernel computing the mask of nCount
+// contiguous values.
+template <class T, class Kernel>
+static void ComputeMask(const T *panSrc, int nBufXSize, int nBufYSize,
+                        GByte *pabyDest, GSpacing nPixelSpace,
+                        GSpacing nLineSpace, Kernel kernel)
+{
+    constexpr int CHUNK_SIZE = 256;
+    GByte abyChunk[CHUNK_SIZE];
+    for (int iY = 0; iY < nBufYSize; iY++)
+    {
+        const T *panLine = panSrc + static_cast<size_t>(iY) * nBufXSize;
+        GByte *pabyLineDest = pabyDest + iY * nLineSpace;
+        if (nPixelSpace == 1)
+        {
+            kernel(panLine, pabyLineDest, static_cast<size_t>(nBufXSize));
+            continue;
+        }
+        for (int iX = 0; iX < nBufXSize; iX += CHUNK_SIZE)
+        {
+            const int nCount = std::min(CHUNK_SIZE, nBufXSize - iX);
+            kernel(panLine + iX, abyChunk, static_cast<size_t>(nCount));
+            for (int i = 0; i < nCount; ++i)
+            {
+                *pabyLineDest = abyChunk[i];
+                pabyLineDest += nPixelSpace;
+            }
+        }
+    }
+}
+
 /************************************************************************/
 /*                          IsNoDataInRange()                           */
 /************************************************************************/
@@ -259,9 +296,14 @@ CPLErr GDALNoDataMaskBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         if (nPixelSpace == 1 && nLineSpace == nBufXSize)
         {
             const size_t nBufSize = static_cast<size_t>(nBufXSize) * nBufYSize;
-            for (size_t i = 0; i < nBufSize; ++i)
+            GDALNoDataMaskLine(pabyData, pabyData, nBufSize, byNoData);
+        }
+        else if (nPixelSpace == 1)
+        {
+            for (int iY = 0; iY < nBufYSize; iY++)
             {
-                pabyData[i] = pabyData[i] == byNoData ? 0 : 255;
+                GByte *pabyLine = pabyData + iY * nLineSpace;
+                GDALNoDataMaskLine(pabyLine, pabyLine, nBufXSize, byNoData);
             }
         }
         else
@@ -301,144 +343,85 @@ CPLErr GDALNoDataMaskBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
             return eErr;
         }
 
-        const bool bIsNoDataNan = CPLIsNan(m_dfNoDataValue) != 0;
         GByte *pabyDest = static_cast<GByte *>(pData);
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Process different cases. */
-        /* --------------------------------------------------------------------
-         */
         switch (eWrkDT)
         {
             case GDT_UInt32:
             {
                 const GUInt32 nNoData = static_cast<GUInt32>(m_dfNoDataValue);
-                const GUInt32 *panSrc = static_cast<const GUInt32 *>(pTemp);
-
-                size_t i = 0;
-                for (int iY = 0; iY < nBufYSize; iY++)
-                {
-                    GByte *pabyLineDest = pabyDest + iY * nLineSpace;
-                    for (int iX = 0; iX < nBufXSize; iX++)
-                    {
-                        *pabyLineDest = panSrc[i] == nNoData ? 0 : 255;
-                        ++i;
-                        pabyLineDest += nPixelSpace;
-                    }
-                }
+                ComputeMask(static_cast<const GUInt32 *>(pTemp), nBufXSize,
+                            nBufYSize, pabyDest, nPixelSpace, nLineSpace,
+                            [nNoData](const GUInt32 *panSrc, GByte *pabyDst,
+                                      size_t nCount) {
+                                GDALNoDataMaskLine(panSrc, pabyDst, nCount,
+                                                   nNoData);
+                            });
             }
             break;
 
             case GDT_Int32:
             {
                 const GInt32 nNoData = static_cast<GInt32>(m_dfNoDataValue);
-                const GInt32 *panSrc = static_cast<const GInt32 *>(pTemp);
-
-                size_t i = 0;
-                for (int iY = 0; iY < nBufYSize; iY++)
-                {
-                    GByte *pabyLineDest = pabyDest + iY * nLineSpace;
-                    for (int iX = 0; iX < nBufXSize; iX++)
-                    {
-                        *pabyLineDest = panSrc[i] == nNoData ? 0 : 255;
-                        ++i;
-                        pabyLineDest += nPixelSpace;
-                    }
-                }
+                ComputeMask(static_cast<const GInt32 *>(pTemp), nBufXSize,
+                            nBufYSize, pabyDest, nPixelSpace, nLineSpace,
+                            [nNoData](const GInt32 *panSrc, GByte *pabyDst,
+                                      size_t nCount) {
+                                GDALNoDataMaskLine(panSrc, pabyDst, nCount,
+                                                   nNoData);
+                            });
             }
             break;
 
             case GDT_Float32:
             {
                 const float fNoData = static_cast<float>(m_dfNoDataValue);
-                const float *pafSrc = static_cast<const float *>(pTemp);
-
-                size_t i = 0;
-                for (int iY = 0; iY < nBufYSize; iY++)
-                {
-                    GByte *pabyLineDest = pabyDest + iY * nLineSpace;
-                    for (int iX = 0; iX < nBufXSize; iX++)
-                    {
-                        const float fVal = pafSrc[i];
-                        if (bIsNoDataNan && CPLIsNan(fVal))
-                            *pabyLineDest = 0;
-                        else if (ARE_REAL_EQUAL(fVal, fNoData))
-                            *pabyLineDest = 0;
-                        else
-                            *pabyLineDest = 255;
-                        ++i;
-                        pabyLineDest += nPixelSpace;
-                    }
-                }
+                ComputeMask(static_cast<const float *>(pTemp), nBufXSize,
+                            nBufYSize, pabyDest, nPixelSpace, nLineSpace,
+                            [fNoData](const float *pafSrc, GByte *pabyDst,
+                                      size_t nCount) {
+                                GDALNoDataMaskLineReal(pafSrc, pabyDst,
+                                                       nCount, fNoData);
+                            });
             }
             break;
 
             case GDT_Float64:
             {
-                const double *padfSrc = static_cast<const double *>(pTemp);
-
-                size_t i = 0;
-                for (int iY = 0; iY < nBufYSize; iY++)
-                {
-                    GByte *pabyLineDest = pabyDest + iY * nLineSpace;
-                    for (int iX = 0; iX < nBufXSize; iX++)
-                    {
-                        const double dfVal = padfSrc[i];
-                        if (bIsNoDataNan && CPLIsNan(dfVal))
-                            *pabyLineDest = 0;
-                        else if (ARE_REAL_EQUAL(dfVal, m_dfNoDataValue))
-                            *pabyLineDest = 0;
-                        else
-                            *pabyLineDest = 255;
-                        ++i;
-                        pabyLineDest += nPixelSpace;
-                    }
-                }
+                const double dfNoData = m_dfNoDataValue;
+                ComputeMask(static_cast<const double *>(pTemp), nBufXSize,
+                            nBufYSize, pabyDest, nPixelSpace, nLineSpace,
+                            [dfNoData](const double *padfSrc, GByte *pabyDst,
+                                       size_t nCount) {
+                                GDALNoDataMaskLineReal(padfSrc, pabyDst,
+                                                       nCount, dfNoData);
+                            });
             }
             break;
 
             case GDT_Int64:
             {
-                const auto *panSrc = static_cast<const int64_t *>(pTemp);
-
-                size_t i = 0;
-                for (int iY = 0; iY < nBufYSize; iY++)
-                {
-                    GByte *pabyLineDest = pabyDest + iY * nLineSpace;
-                    for (int iX = 0; iX < nBufXSize; iX++)
-                    {
-                        const auto nVal = panSrc[i];
-                        if (nVal == m_nNoDataValueInt64)
-                            *pabyLineDest = 0;
-                        else
-                            *pabyLineDest = 255;
-                        ++i;
-                        pabyLineDest += nPixelSpace;
-                    }
-                }
+                const int64_t nNoData = m_nNoDataValueInt64;
+                ComputeMask(static_cast<const int64_t *>(pTemp), nBufXSize,
+                            nBufYSize, pabyDest, nPixelSpace, nLineSpace,
+                            [nNoData](const int64_t *panSrc, GByte *pabyDst,
+                                      size_t nCount) {
+                                GDALNoDataMaskLine(panSrc, pabyDst, nCount,
+                                                   nNoData);
+                            });
             }
             break;
 
             case GDT_UInt64:
             {
-                const auto *panSrc = static_cast<const uint64_t *>(pTemp);
-
-                size_t i = 0;
-                for (int iY = 0; iY < nBufYSize; iY++)
-                {
-                    GByte *pabyLineDest = pabyDest + iY * nLineSpace;
-                    for (int iX = 0; iX < nBufXSize; iX++)
-                    {
-                        const auto nVal = panSrc[i];
-                        if (nVal == m_nNoDataValueUInt64)
-                            *pabyLineDest = 0;
-                        else
-                            *pabyLineDest = 255;
-                        ++i;
-                        pabyLineDest += nPixelSpace;
-                    }
-                }
+                const uint64_t nNoData = m_nNoDataValueUInt64;
+                ComputeMask(static_cast<const uint64_t *>(pTemp), nBufXSize,
+                            nBufYSize, pabyDest, nPixelSpace, nLineSpace,
+                            [nNoData](const uint64_t *panSrc, GByte *pabyDst,
+                                      size_t nCount) {
+                                GDALNoDataMaskLine(panSrc, pabyDst, nCount,
+                                                   nNoData);
+                            });
             }
             break;
 
@@ -32,6 +32,7 @@
 #include "cpl_port.h"
 #include "gdal_priv.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "cpl_conv.h"
@@ -39,6 +40,7 @@
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "gdal.h"
+#include "gdalnodatamask_priv.h"
 
 //! @cond Doxygen_Suppress
 /************************************************************************/
@@ -90,25 +92,28 @@ static void FillOutBuffer(GPtrDiff_t nBlockOffsetPixels, int nBands,
                           const void *pabySrc, const double *padfNodataValues,
                           void *pImage)
 {
-    T *paNoData = static_cast<T *>(CPLMalloc(nBands * sizeof(T)));
-    for (int iBand = 0; iBand < nBands; ++iBand)
+    // A pixel is valid as soon as one of its bands is not at its nodata
+    // value, so the per-band masks (0 for nodata, 255 otherwise) are OR'ed.
+    const T *paSrc = static_cast<const T *>(pabySrc);
+    GByte *pabyDst = static_cast<GByte *>(pImage);
+    const size_t nPixels = static_cast<size_t>(nBlockOffsetPixels);
+    GDALNoDataMaskLine(paSrc, pabyDst, nPixels,
+                       static_cast<T>(padfNodataValues[0]));
+
+    constexpr size_t CHUNK_SIZE = 256;
+    GByte abyChunk[CHUNK_SIZE];
+    for (int iBand = 1; iBand < nBands; ++iBand)
     {
-        paNoData[iBand] = static_cast<T>(padfNodataValues[iBand]);
-    }
-
-    for (GPtrDiff_t i = 0; i < nBlockOffsetPixels; i++)
-    {
-        int nCountNoData = 0;
-        for (int iBand = 0; iBand < nBands; ++iBand)
+        const T *paBandSrc = paSrc + iBand * nPixels;
+        const T tNoData = static_cast<T>(padfNodataValues[iBand]);
+        for (size_t i = 0; i < nPixels; i += CHUNK_SIZE)
         {
-            if (static_cast<const T *>(
-                    pabySrc)[i + iBand * nBlockOffsetPixels] == paNoData[iBand])
-                ++nCountNoData;
+            const size_t nCount = std::min(CHUNK_SIZE, nPixels - i);
+            GDALNoDataMaskLine(paBandSrc + i, abyChunk, nCount, tNoData);
+            for (size_t j = 0; j < nCount; ++j)
+                pabyDst[i + j] |= abyChunk[j];
         }
-        static_cast<GByte *>(pImage)[i] = nCountNoData == nBands ? 0 : 255;
     }
-
-    CPLFree(paNoData);
 }
 
 /************************************************************************/
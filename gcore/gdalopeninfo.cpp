@@ -46,6 +46,7 @@
 #include "cpl_error.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_vsi_virtual.h"
 #include "gdal.h"
 
 // Keep in sync prototype of those 2 functions between gdalopeninfo.cpp,
@@ -421,13 +422,19 @@ char **GDALOpenInfo::GetSiblingFiles()
     CPLString osDir = CPLGetDirname(pszFilename);
     const int nMaxFiles = atoi(VSIGetPathSpecificOption(
         pszFilename, "GDAL_READDIR_LIMIT_ON_OPEN", "1000"));
-    papszSiblingFiles = VSIReadDirEx(osDir, nMaxFiles);
-    if (nMaxFiles > 0 && CSLCount(papszSiblingFiles) > nMaxFiles)
+    const double dfTTL = CPLAtof(VSIGetPathSpecificOption(
+        pszFilename, "GDAL_READDIR_CACHE_TTL_ON_OPEN", "0"));
+    m_poSiblingFilesListing = VSIReadDirCached(osDir, nMaxFiles, dfTTL);
+    if (m_poSiblingFilesListing->bTruncated)
     {
         CPLDebug("GDAL", "GDAL_READDIR_LIMIT_ON_OPEN reached on %s",
                  osDir.c_str());
-        CSLDestroy(papszSiblingFiles);
-        papszSiblingFiles = nullptr;
+        m_poSiblingFilesListing.reset();
+    }
+    else
+    {
+        papszSiblingFiles =
+            CSLDuplicate(m_poSiblingFilesListing->aosFiles.List());
     }
 
     return papszSiblingFiles;
@@ -464,6 +471,30 @@ bool GDALOpenInfo::AreSiblingFilesLoaded() const
     return bHasGotSiblingFiles;
 }
 
+/************************************************************************/
+/*                           HasSiblingFile()                           */
+/************************************************************************/
+
+/** Return whether a file of the given name, compared case-insensitively, is
+ * part of the sibling files.
+ *
+ * When the sibling files have been obtained by listing the directory, this
+ * is a constant time lookup, contrary to scanning the list returned by
+ * GetSiblingFiles().
+ *
+ * @param pszName file name, without directory.
+ * @return false if there is no such sibling file, or if the list of sibling
+ * files is not known (GetSiblingFiles() returning NULL).
+ * @since GDAL 3.9
+ */
+bool GDALOpenInfo::HasSiblingFile(const char *pszName)
+{
+    char **papszFiles = GetSiblingFiles();
+    if (m_poSiblingFilesListing)
+        return m_poSiblingFilesListing->HasFile(pszName);
+    return CSLFindString(papszFiles, pszName) >= 0;
+}
+
 /************************************************************************/
 /*                           TryToIngest()                              */
 /************************************************************************/
@@ -39,20 +39,29 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <deque>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
+#include "cpl_trace.h"
 #include "cpl_virtualmem.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_rat.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 
 /************************************************************************/
 /*                           GDALRasterBand()                           */
@@ -94,12 +103,13 @@ GDALRasterBand::~GDALRasterBand()
 
     delete poBandBlockCache;
 
-    if (static_cast<GIntBig>(nBlockReads) >
+    const GIntBig nTotalBlockReads = nBlockReads.load();
+    if (nTotalBlockReads >
             static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn &&
         nBand == 1 && poDS != nullptr)
     {
-        CPLDebug("GDAL", "%d block reads on %d block band 1 of %s.",
-                 nBlockReads, nBlocksPerRow * nBlocksPerColumn,
+        CPLDebug("GDAL", CPL_FRMT_GIB " block reads on %d block band 1 of %s.",
+                 nTotalBlockReads, nBlocksPerRow * nBlocksPerColumn,
                  poDS->GetDescription());
     }
 
@@ -314,6 +324,17 @@ CPLErr GDALRasterBand::RasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                                 GDALRasterIOExtraArg *psExtraArg)
 
 {
+    CPLTraceSpan oSpan("gdal", eRWFlag == GF_Read
+                                   ? "GDALRasterBand::RasterIO(read)"
+                                   : "GDALRasterBand::RasterIO(write)");
+    if (oSpan.IsEnabled())
+    {
+        oSpan.AddArg("band", nBand);
+        oSpan.AddArg("window", CPLSPrintf("%d,%d,%d,%d", nXOff, nYOff,
+                                          nXSize, nYSize));
+        oSpan.AddArg("buffer", CPLSPrintf("%d,%d", nBufXSize, nBufYSize));
+    }
+
     GDALRasterIOExtraArg sExtraArg;
     if (psExtraArg == nullptr)
     {
@@ -597,6 +618,12 @@ CPLErr GDALRasterBand::ReadBlock(int nXBlockOff, int nYBlockOff, void *pImage)
     /*      Invoke underlying implementation method.                        */
     /* -------------------------------------------------------------------- */
 
+    CPLTraceSpan oSpan("gdal", "IReadBlock");
+    if (oSpan.IsEnabled())
+    {
+        oSpan.AddArg("band", nBand);
+        oSpan.AddArg("block", CPLSPrintf("%d,%d", nXBlockOff, nYBlockOff));
+    }
     int bCallLeaveReadWrite = EnterReadWrite(GF_Read);
     CPLErr eErr = IReadBlock(nXBlockOff, nYBlockOff, pImage);
     if (bCallLeaveReadWrite)
@@ -1220,6 +1247,68 @@ CPLErr CPL_STDCALL GDALDropRasterCache(GDALRasterBandH hBand)
     return GDALRasterBand::FromHandle(hBand)->DropCache();
 }
 
+/************************************************************************/
+/*                         GetCacheStatistics()                         */
+/************************************************************************/
+
+/**
+ * \brief Return statistics on the use of the block cache by the band.
+ *
+ * This is the same as the C function GDALGetRasterCacheStatistics().
+ *
+ * @param[out] pnUsedBytes Pointer to the number of bytes currently used in the
+ *                         block cache, or nullptr.
+ * @param[out] pnHits Pointer to the number of block requests satisfied by
+ *                    the cache, or nullptr.
+ * @param[out] pnMisses Pointer to the number of block requests that required
+ *                      a new block to be allocated, or nullptr.
+ * @param[out] pnEvictions Pointer to the number of blocks of this band
+ *                         evicted by the block cache to make room for other
+ *                         blocks, or nullptr.
+ * @param[out] pnDirtyFlushes Pointer to the number of evicted blocks that had
+ *                            to be written because they were dirty, or
+ *                            nullptr.
+ * @since GDAL 3.9
+ * @see GDALDataset::GetCacheStatistics(), GDALGetCacheStatistics()
+ */
+
+void GDALRasterBand::GetCacheStatistics(GIntBig *pnUsedBytes, GIntBig *pnHits,
+                                        GIntBig *pnMisses, GIntBig *pnEvictions,
+                                        GIntBig *pnDirtyFlushes) const
+{
+    if (pnUsedBytes)
+        *pnUsedBytes = m_oBlockCacheCounters.nUsedBytes.load();
+    if (pnHits)
+        *pnHits = m_oBlockCacheCounters.nHits.load();
+    if (pnMisses)
+        *pnMisses = m_oBlockCacheCounters.nMisses.load();
+    if (pnEvictions)
+        *pnEvictions = m_oBlockCacheCounters.nEvictions.load();
+    if (pnDirtyFlushes)
+        *pnDirtyFlushes = m_oBlockCacheCounters.nDirtyFlushes.load();
+}
+
+/************************************************************************/
+/*                    GDALGetRasterCacheStatistics()                    */
+/************************************************************************/
+
+/**
+ * \brief Return statistics on the use of the block cache by the band.
+ *
+ * This is the same as the C++ method GDALRasterBand::GetCacheStatistics().
+ *
+ * @since GDAL 3.9
+ */
+
+void GDALGetRasterCacheStatistics(GDALRasterBandH hBand, GIntBig *pnUsedBytes,
+                                  GIntBig *pnHits, GIntBig *pnMisses,
+                                  GIntBig *pnEvictions, GIntBig *pnDirtyFlushes)
+{
+    VALIDATE_POINTER0(hBand, __func__);
+    GDALRasterBand::FromHandle(hBand)->GetCacheStatistics(
+        pnUsedBytes, pnHits, pnMisses, pnEvictions, pnDirtyFlushes);
+}
+
 /************************************************************************/
 /*                        UnreferenceBlock()                            */
 /*                                                                      */
@@ -1416,6 +1505,7 @@ GDALRasterBlock *GDALRasterBand::GetLockedBlockRef(int nXBlockOff,
     /*      Try and fetch from cache.                                       */
     /* -------------------------------------------------------------------- */
     GDALRasterBlock *poBlock = TryGetLockedBlockRef(nXBlockOff, nYBlockOff);
+    GDALRasterBlock::LogCacheAccess(this, poBlock != nullptr);
 
     /* -------------------------------------------------------------------- */
     /*      If we didn't find it in our memory cache, instantiate a         */
@@ -1493,6 +1583,13 @@ GDALRasterBlock *GDALRasterBand::GetLockedBlockRef(int nXBlockOff,
         if (!bJustInitialize)
         {
             const GUInt32 nErrorCounter = CPLGetErrorCounter();
+            CPLTraceSpan oSpan("gdal", "IReadBlock");
+            if (oSpan.IsEnabled())
+            {
+                oSpan.AddArg("band", nBand);
+                oSpan.AddArg("block",
+                             CPLSPrintf("%d,%d", nXBlockOff, nYBlockOff));
+            }
             int bCallLeaveReadWrite = EnterReadWrite(GF_Read);
             eErr = IReadBlock(nXBlockOff, nYBlockOff, poBlock->GetDataRef());
             if (bCallLeaveReadWrite)
@@ -1510,8 +1607,8 @@ GDALRasterBlock *GDALRasterBand::GetLockedBlockRef(int nXBlockOff,
                 return nullptr;
             }
 
-            nBlockReads++;
-            if (static_cast<GIntBig>(nBlockReads) ==
+            const GIntBig nNewBlockReads = ++nBlockReads;
+            if (nNewBlockReads ==
                     static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn +
                         1 &&
                 nBand == 1 && poDS != nullptr)
@@ -1525,6 +1622,107 @@ GDALRasterBlock *GDALRasterBand::GetLockedBlockRef(int nXBlockOff,
     return poBlock;
 }
 
+/************************************************************************/
+/*                              PinBlock()                              */
+/************************************************************************/
+
+/**
+ * \brief Pin a raster block in the block cache, for zero-copy reading.
+ *
+ * The block is fetched as with GetLockedBlockRef() (that is read from the
+ * driver if not already cached), and the returned object holds the lock on
+ * it, so that the block data can be directly read with
+ * GDALPinnedBlock::GetData(), avoiding the copy done by RasterIO() or
+ * ReadBlock(). The lock is released when the returned object is destroyed
+ * or GDALPinnedBlock::Release() is called.
+ *
+ * The block data must not be modified. Writing to the band while the block
+ * is pinned is allowed, but may modify the pinned block data.
+ *
+ * This method is the same as the C function GDALRasterBandPinBlock().
+ *
+ * @param nXBlockOff the horizontal block offset, with zero indicating
+ * the left most block, 1 the next block and so forth.
+ *
+ * @param nYBlockOff the vertical block offset, with zero indicating
+ * the top most block, 1 the next block and so forth.
+ *
+ * @return a pinned block, which evaluates to false in case of error.
+ *
+ * @since GDAL 3.9
+ */
+
+GDALPinnedBlock GDALRasterBand::PinBlock(int nXBlockOff, int nYBlockOff)
+{
+    return GDALPinnedBlock(GetLockedBlockRef(nXBlockOff, nYBlockOff));
+}
+
+/************************************************************************/
+/*                       GDALRasterBandPinBlock()                       */
+/************************************************************************/
+
+/**
+ * \brief Pin a raster block in the block cache, for zero-copy reading.
+ *
+ * The returned handle must be released with GDALPinnedBlockRelease().
+ *
+ * @see GDALRasterBand::PinBlock()
+ *
+ * @return a handle, or NULL in case of error.
+ *
+ * @since GDAL 3.9
+ */
+
+GDALPinnedBlockH GDALRasterBandPinBlock(GDALRasterBandH hBand, int nXBlockOff,
+                                        int nYBlockOff)
+{
+    VALIDATE_POINTER1(hBand, "GDALRasterBandPinBlock", nullptr);
+
+    GDALRasterBand *poBand = GDALRasterBand::FromHandle(hBand);
+    auto oBlock = poBand->PinBlock(nXBlockOff, nYBlockOff);
+    if (!oBlock)
+        return nullptr;
+    return GDALPinnedBlock::ToHandle(new GDALPinnedBlock(std::move(oBlock)));
+}
+
+/************************************************************************/
+/*                       GDALPinnedBlockGetData()                       */
+/************************************************************************/
+
+/**
+ * \brief Return the data of a pinned block.
+ *
+ * The block buffer contains GDALGetBlockSize() values of the band data type,
+ * line after line. The pointer remains valid until the block is released with
+ * GDALPinnedBlockRelease().
+ *
+ * @see GDALPinnedBlock::GetData()
+ *
+ * @since GDAL 3.9
+ */
+
+const void *GDALPinnedBlockGetData(GDALPinnedBlockH hBlock)
+{
+    VALIDATE_POINTER1(hBlock, "GDALPinnedBlockGetData", nullptr);
+
+    return GDALPinnedBlock::FromHandle(hBlock)->GetData();
+}
+
+/************************************************************************/
+/*                       GDALPinnedBlockRelease()                       */
+/************************************************************************/
+
+/**
+ * \brief Release a block pinned with GDALRasterBandPinBlock().
+ *
+ * @since GDAL 3.9
+ */
+
+void GDALPinnedBlockRelease(GDALPinnedBlockH hBlock)
+{
+    delete GDALPinnedBlock::FromHandle(hBlock);
+}
+
 /************************************************************************/
 /*                               Fill()                                 */
 /************************************************************************/
@@ -3354,6 +3552,228 @@ GDALDatasetH CPL_STDCALL GDALGetBandDataset(GDALRasterBandH hBand)
     return GDALDataset::ToHandle(poBand->GetDataset());
 }
 
+/************************************************************************/
+/*                        ProcessSampledBlocks()                        */
+/************************************************************************/
+
+// Iterate over one block out of nSampleRate of poBand. For each of them,
+// pfnProcessBlock(oAcc, pData, pabyMask, nXCheck, nYCheck) accumulates the
+// block into oAcc, pabyMask being the content of poMaskBand (or nullptr),
+// with a line stride equal to the block width. Once the contribution of a
+// block is in oResult, pfnAfterBlock(oResult, iSampleBlock) is called, and
+// may return false to stop the iteration.
+//
+// Blocks and masks are always fetched from the calling thread, since drivers
+// are not thread-safe. When GDAL_NUM_THREADS is greater than 1, the
+// pfnProcessBlock() calls are dispatched to the global thread pool, each one
+// on a copy of oInit, and those partial results are merged into oResult with
+// Accumulator::Merge() in block order, so that results do not depend on thread
+// scheduling. Otherwise, blocks are directly accumulated into oResult.
+//
+// Returns false in case of error.
+
+template <class Accumulator, class ProcessBlockFunc, class AfterBlockFunc>
+static bool ProcessSampledBlocks(GDALRasterBand *poBand,
+                                 GDALRasterBand *poMaskBand, int nSampleRate,
+                                 const Accumulator &oInit, Accumulator &oResult,
+                                 const ProcessBlockFunc &pfnProcessBlock,
+                                 const AfterBlockFunc &pfnAfterBlock)
+{
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    const int nBlocksPerRow = DIV_ROUND_UP(poBand->GetXSize(), nBlockXSize);
+    const int nBlocksPerColumn = DIV_ROUND_UP(poBand->GetYSize(), nBlockYSize);
+    const int nTotalBlocks = nBlocksPerRow * nBlocksPerColumn;
+    const size_t nBlockPixels = static_cast<size_t>(nBlockXSize) * nBlockYSize;
+
+    const auto ReadMask = [poMaskBand, nBlockXSize, nBlockYSize](
+                              int iXBlock, int iYBlock, int nXCheck,
+                              int nYCheck, GByte *pabyMask)
+    {
+        return poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
+                                    iYBlock * nBlockYSize, nXCheck, nYCheck,
+                                    pabyMask, nXCheck, nYCheck, GDT_Byte, 0,
+                                    nBlockXSize, nullptr) == CE_None;
+    };
+
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                                       ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+    const int nSampledBlocks = DIV_ROUND_UP(nTotalBlocks, nSampleRate);
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 && nSampledBlocks > 1 ? GDALGetGlobalThreadPool(nThreads)
+                                           : nullptr;
+
+    if (poThreadPool == nullptr)
+    {
+        GByte *pabyMaskData = nullptr;
+        if (poMaskBand)
+        {
+            pabyMaskData = static_cast<GByte *>(
+                VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
+            if (!pabyMaskData)
+                return false;
+        }
+
+        for (int iSampleBlock = 0; iSampleBlock < nTotalBlocks;
+             iSampleBlock += nSampleRate)
+        {
+            const int iYBlock = iSampleBlock / nBlocksPerRow;
+            const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
+
+            GDALRasterBlock *const poBlock =
+                poBand->GetLockedBlockRef(iXBlock, iYBlock);
+            if (poBlock == nullptr)
+            {
+                CPLFree(pabyMaskData);
+                return false;
+            }
+
+            int nXCheck = 0, nYCheck = 0;
+            poBand->GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+
+            if (poMaskBand &&
+                !ReadMask(iXBlock, iYBlock, nXCheck, nYCheck, pabyMaskData))
+            {
+                CPLFree(pabyMaskData);
+                poBlock->DropLock();
+                return false;
+            }
+
+            pfnProcessBlock(oResult, poBlock->GetDataRef(), pabyMaskData,
+                            nXCheck, nYCheck);
+
+            poBlock->DropLock();
+
+            if (!pfnAfterBlock(oResult, iSampleBlock))
+                break;
+        }
+
+        CPLFree(pabyMaskData);
+        return true;
+    }
+
+    struct Context
+    {
+        std::mutex oMutex{};
+        std::condition_variable oCV{};
+        const ProcessBlockFunc *ppfnProcessBlock = nullptr;
+    };
+
+    struct Job
+    {
+        Context *psContext;
+        Accumulator oAcc;
+        int iSampleBlock = 0;
+        GDALRasterBlock *poBlock = nullptr;
+        std::vector<GByte> abyMask{};
+        int nXCheck = 0;
+        int nYCheck = 0;
+        bool bDone = false;
+
+        Job(Context *psContextIn, const Accumulator &oInitIn)
+            : psContext(psContextIn), oAcc(oInitIn)
+        {
+        }
+
+        static void Run(void *pData)
+        {
+            Job *psJob = static_cast<Job *>(pData);
+            (*psJob->psContext->ppfnProcessBlock)(
+                psJob->oAcc, psJob->poBlock->GetDataRef(),
+                psJob->abyMask.empty() ? nullptr : psJob->abyMask.data(),
+                psJob->nXCheck, psJob->nYCheck);
+            psJob->poBlock->DropLock();
+
+            // Notify while holding the mutex, since the job may be destroyed
+            // as soon as it is marked as done.
+            std::lock_guard<std::mutex> oLock(psJob->psContext->oMutex);
+            psJob->bDone = true;
+            psJob->psContext->oCV.notify_all();
+        }
+    };
+
+    Context sContext;
+    sContext.ppfnProcessBlock = &pfnProcessBlock;
+
+    // Bound the number of blocks locked at once
+    const size_t nMaxJobsInFlight = 2 * static_cast<size_t>(nThreads);
+    std::deque<std::unique_ptr<Job>> apoJobs;
+    bool bOK = true;
+    bool bStop = false;
+
+    const auto MergeOldestJob = [&apoJobs, &sContext, &oResult, &pfnAfterBlock,
+                                 &bOK, &bStop]()
+    {
+        Job *psJob = apoJobs.front().get();
+        {
+            std::unique_lock<std::mutex> oLock(sContext.oMutex);
+            sContext.oCV.wait(oLock, [psJob] { return psJob->bDone; });
+        }
+        if (bOK && !bStop)
+        {
+            oResult.Merge(psJob->oAcc);
+            if (!pfnAfterBlock(oResult, psJob->iSampleBlock))
+                bStop = true;
+        }
+        apoJobs.pop_front();
+    };
+
+    for (int iSampleBlock = 0; bOK && !bStop && iSampleBlock < nTotalBlocks;
+         iSampleBlock += nSampleRate)
+    {
+        const int iYBlock = iSampleBlock / nBlocksPerRow;
+        const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
+
+        auto poJob = std::make_unique<Job>(&sContext, oInit);
+        poJob->iSampleBlock = iSampleBlock;
+        poBand->GetActualBlockSize(iXBlock, iYBlock, &poJob->nXCheck,
+                                   &poJob->nYCheck);
+        if (poMaskBand)
+        {
+            try
+            {
+                poJob->abyMask.resize(nBlockPixels);
+            }
+            catch (const std::bad_alloc &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Cannot allocate mask buffer");
+                bOK = false;
+                break;
+            }
+            if (!ReadMask(iXBlock, iYBlock, poJob->nXCheck, poJob->nYCheck,
+                          poJob->abyMask.data()))
+            {
+                bOK = false;
+                break;
+            }
+        }
+
+        poJob->poBlock = poBand->GetLockedBlockRef(iXBlock, iYBlock);
+        if (poJob->poBlock == nullptr)
+        {
+            bOK = false;
+            break;
+        }
+
+        Job *psJob = poJob.get();
+        apoJobs.push_back(std::move(poJob));
+        if (!poThreadPool->SubmitJob(Job::Run, psJob))
+            Job::Run(psJob);
+
+        while (apoJobs.size() >= nMaxJobsInFlight)
+            MergeOldestJob();
+    }
+
+    while (!apoJobs.empty())
+        MergeOldestJob();
+
+    return bOK;
+}
+
 /************************************************************************/
 /*                        ComputeFloatNoDataValue()                     */
 /************************************************************************/
@@ -3402,6 +3822,10 @@ static inline void ComputeFloatNoDataValue(GDALDataType eDataType,
  * in generating histogram based luts for instance.  Generally bApproxOK is
  * much faster than an exactly computed histogram.
  *
+ * Starting with GDAL 3.9, the GDAL_NUM_THREADS configuration option can be
+ * set to "ALL_CPUS" or a integer value to process blocks with several
+ * threads.
+ *
  * This method is the same as the C functions GDALGetRasterHistogram() and
  * GDALGetRasterHistogramEx().
  *
@@ -3732,60 +4156,39 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                 nSampleRate += 1;
         }
 
-        GByte *pabyMaskData = nullptr;
-        if (poMaskBand)
+        // Partial histogram
+        struct HistogramAccumulator
         {
-            pabyMaskData = static_cast<GByte *>(
-                VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-            if (!pabyMaskData)
-            {
-                return CE_Failure;
-            }
-        }
+            std::vector<GUIntBig> anHistogram{};
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Read the blocks, and add to histogram. */
-        /* --------------------------------------------------------------------
-         */
-        for (int iSampleBlock = 0;
-             iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
-             iSampleBlock += nSampleRate)
-        {
-            if (!pfnProgress(
-                    iSampleBlock /
-                        (static_cast<double>(nBlocksPerRow) * nBlocksPerColumn),
-                    "Compute Histogram", pProgressData))
+            void Merge(const HistogramAccumulator &oOther)
             {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
+                for (size_t i = 0; i < anHistogram.size(); ++i)
+                    anHistogram[i] += oOther.anHistogram[i];
             }
+        };
 
-            const int iYBlock = iSampleBlock / nBlocksPerRow;
-            const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
-
-            GDALRasterBlock *poBlock = GetLockedBlockRef(iXBlock, iYBlock);
-            if (poBlock == nullptr)
-            {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
-
-            void *pData = poBlock->GetDataRef();
-
-            int nXCheck = 0, nYCheck = 0;
-            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-            if (poMaskBand &&
-                poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                     iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                     pabyMaskData, nXCheck, nYCheck, GDT_Byte,
-                                     0, nBlockXSize, nullptr) != CE_None)
-            {
-                CPLFree(pabyMaskData);
-                poBlock->DropLock();
-                return CE_Failure;
-            }
+        HistogramAccumulator oInit;
+        try
+        {
+            oInit.anHistogram.resize(nBuckets);
+        }
+        catch (const std::bad_alloc &)
+        {
+            ReportError(CE_Failure, CPLE_OutOfMemory,
+                        "Cannot allocate histogram");
+            return CE_Failure;
+        }
+        HistogramAccumulator oResult(oInit);
+
+        const auto ProcessBlock =
+            [this, bSignedByte, dfScale, dfMin, nBuckets, bGotNoDataValue,
+             dfNoDataValue, bGotFloatNoDataValue, fNoDataValue,
+             bIncludeOutOfRange](HistogramAccumulator &oAcc, const void *pData,
+                                 const GByte *pabyMaskData, int nXCheck,
+                                 int nYCheck)
+        {
+            GUIntBig *panHist = oAcc.anHistogram.data();
 
             // this is a special case for a common situation.
             if (eDataType == GDT_Byte && !bSignedByte && dfScale == 1.0 &&
@@ -3794,7 +4197,7 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
             {
                 const GPtrDiff_t nPixels =
                     static_cast<GPtrDiff_t>(nXCheck) * nYCheck;
-                GByte *pabyData = static_cast<GByte *>(pData);
+                const GByte *pabyData = static_cast<const GByte *>(pData);
 
                 for (GPtrDiff_t i = 0; i < nPixels; i++)
                 {
@@ -3803,12 +4206,11 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                     if (!(bGotNoDataValue &&
                           (pabyData[i] == static_cast<GByte>(dfNoDataValue))))
                     {
-                        panHistogram[pabyData[i]]++;
+                        panHist[pabyData[i]]++;
                     }
                 }
 
-                poBlock->DropLock();
-                continue;  // To next sample block.
+                return;
             }
 
             // This isn't the fastest way to do this, but is easier for now.
@@ -3829,39 +4231,45 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                         case GDT_Byte:
                         {
                             if (bSignedByte)
-                                dfValue =
-                                    static_cast<signed char *>(pData)[iOffset];
+                                dfValue = static_cast<const signed char *>(
+                                    pData)[iOffset];
                             else
-                                dfValue = static_cast<GByte *>(pData)[iOffset];
+                                dfValue =
+                                    static_cast<const GByte *>(pData)[iOffset];
                             break;
                         }
                         case GDT_Int8:
-                            dfValue = static_cast<GInt8 *>(pData)[iOffset];
+                            dfValue =
+                                static_cast<const GInt8 *>(pData)[iOffset];
                             break;
                         case GDT_UInt16:
-                            dfValue = static_cast<GUInt16 *>(pData)[iOffset];
+                            dfValue =
+                                static_cast<const GUInt16 *>(pData)[iOffset];
                             break;
                         case GDT_Int16:
-                            dfValue = static_cast<GInt16 *>(pData)[iOffset];
+                            dfValue =
+                                static_cast<const GInt16 *>(pData)[iOffset];
                             break;
                         case GDT_UInt32:
-                            dfValue = static_cast<GUInt32 *>(pData)[iOffset];
+                            dfValue =
+                                static_cast<const GUInt32 *>(pData)[iOffset];
                             break;
                         case GDT_Int32:
-                            dfValue = static_cast<GInt32 *>(pData)[iOffset];
+                            dfValue =
+                                static_cast<const GInt32 *>(pData)[iOffset];
                             break;
                         case GDT_UInt64:
                             dfValue = static_cast<double>(
-                                static_cast<GUInt64 *>(pData)[iOffset]);
+                                static_cast<const GUInt64 *>(pData)[iOffset]);
                             break;
                         case GDT_Int64:
                             dfValue = static_cast<double>(
-                                static_cast<GInt64 *>(pData)[iOffset]);
+                                static_cast<const GInt64 *>(pData)[iOffset]);
                             break;
                         case GDT_Float32:
                         {
                             const float fValue =
-                                static_cast<float *>(pData)[iOffset];
+                                static_cast<const float *>(pData)[iOffset];
                             if (CPLIsNan(fValue) ||
                                 (bGotFloatNoDataValue &&
                                  ARE_REAL_EQUAL(fValue, fNoDataValue)))
@@ -3870,34 +4278,35 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                             break;
                         }
                         case GDT_Float64:
-                            dfValue = static_cast<double *>(pData)[iOffset];
+                            dfValue =
+                                static_cast<const double *>(pData)[iOffset];
                             if (CPLIsNan(dfValue))
                                 continue;
                             break;
                         case GDT_CInt16:
                         {
                             double dfReal =
-                                static_cast<GInt16 *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<GInt16 *>(pData)[iOffset * 2 + 1];
+                                static_cast<const GInt16 *>(pData)[iOffset * 2];
+                            double dfImag = static_cast<const GInt16 *>(
+                                pData)[iOffset * 2 + 1];
                             dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
                         }
                         break;
                         case GDT_CInt32:
                         {
                             double dfReal =
-                                static_cast<GInt32 *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<GInt32 *>(pData)[iOffset * 2 + 1];
+                                static_cast<const GInt32 *>(pData)[iOffset * 2];
+                            double dfImag = static_cast<const GInt32 *>(
+                                pData)[iOffset * 2 + 1];
                             dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
                         }
                         break;
                         case GDT_CFloat32:
                         {
                             double dfReal =
-                                static_cast<float *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<float *>(pData)[iOffset * 2 + 1];
+                                static_cast<const float *>(pData)[iOffset * 2];
+                            double dfImag = static_cast<const float *>(
+                                pData)[iOffset * 2 + 1];
                             if (CPLIsNan(dfReal) || CPLIsNan(dfImag))
                                 continue;
                             dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
@@ -3906,9 +4315,9 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                         case GDT_CFloat64:
                         {
                             double dfReal =
-                                static_cast<double *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<double *>(pData)[iOffset * 2 + 1];
+                                static_cast<const double *>(pData)[iOffset * 2];
+                            double dfImag = static_cast<const double *>(
+                                pData)[iOffset * 2 + 1];
                             if (CPLIsNan(dfReal) || CPLIsNan(dfImag))
                                 continue;
                             dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
@@ -3917,8 +4326,7 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                         case GDT_Unknown:
                         case GDT_TypeCount:
                             CPLAssert(false);
-                            CPLFree(pabyMaskData);
-                            return CE_Failure;
+                            return;
                     }
 
                     if (eDataType != GDT_Float32 && bGotNoDataValue &&
@@ -3933,24 +4341,52 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                     if (dfIndex < 0)
                     {
                         if (bIncludeOutOfRange)
-                            panHistogram[0]++;
+                            panHist[0]++;
                     }
                     else if (dfIndex >= nBuckets)
                     {
                         if (bIncludeOutOfRange)
-                            ++panHistogram[nBuckets - 1];
+                            ++panHist[nBuckets - 1];
                     }
                     else
                     {
-                        ++panHistogram[static_cast<int>(dfIndex)];
+                        ++panHist[static_cast<int>(dfIndex)];
                     }
                 }
             }
 
-            poBlock->DropLock();
+        };
+
+        bool bInterrupted = false;
+        const auto AfterBlock = [this, pfnProgress, pProgressData,
+                                 &bInterrupted](const HistogramAccumulator &,
+                                                int iSampleBlock)
+        {
+            if (!pfnProgress(
+                    (iSampleBlock + 1) /
+                        (static_cast<double>(nBlocksPerRow) * nBlocksPerColumn),
+                    "Compute Histogram", pProgressData))
+            {
+                bInterrupted = true;
+                return false;
+            }
+            return true;
+        };
+
+        /* --------------------------------------------------------------------
+         */
+        /*      Read the blocks, and add to histogram. */
+        /* --------------------------------------------------------------------
+         */
+        if (!ProcessSampledBlocks(this, poMaskBand, nSampleRate, oInit,
+                                  oResult, ProcessBlock, AfterBlock) ||
+            bInterrupted)
+        {
+            return CE_Failure;
         }
 
-        CPLFree(pabyMaskData);
+        std::copy(oResult.anHistogram.begin(), oResult.anHistogram.end(),
+                  panHistogram);
     }
 
     pfnProgress(1.0, "Compute Histogram", pProgressData);
@@ -5672,6 +6108,13 @@ void GDALRasterBand::SetValidPercent(GUIntBig nSampleCount,
  *
  * Cached statistics can be cleared with GDALDataset::ClearStatistics().
  *
+ * Starting with GDAL 3.9, the GDAL_NUM_THREADS configuration option can be
+ * set to "ALL_CPUS" or a integer value to process blocks with several
+ * threads. Partial results are combined in block order, so the result does
+ * not depend on the number of threads. For floating-point and masked bands,
+ * the mean and standard deviation may however differ from the
+ * single-threaded computation by a relative amount of 1e-12 or less.
+ *
  * This method is the same as the C function GDALComputeRasterStatistics().
  *
  * @param bApproxOK If TRUE statistics may be computed based on overviews
@@ -5932,10 +6375,6 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                       static_cast<GUInt64>(nBlockYSize))))
         {
             const GUInt32 nMaxValueType = (eDataType == GDT_Byte) ? 255 : 65535;
-            GUInt32 nMin = nMaxValueType;
-            GUInt32 nMax = 0;
-            GUIntBig nSum = 0;
-            GUIntBig nSumSquare = 0;
             // If no valid nodata, map to invalid value (256 for Byte)
             const GUInt32 nNoDataValue =
                 (bGotNoDataValue && dfNoDataValue >= 0 &&
@@ -5945,31 +6384,46 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                     ? static_cast<GUInt32>(dfNoDataValue + 1e-10)
                     : nMaxValueType + 1;
 
-            for (int iSampleBlock = 0;
-                 iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
-                 iSampleBlock += nSampleRate)
+            // Partial statistics
+            struct IntegerStatsAccumulator
             {
-                const int iYBlock = iSampleBlock / nBlocksPerRow;
-                const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
-
-                GDALRasterBlock *const poBlock =
-                    GetLockedBlockRef(iXBlock, iYBlock);
-                if (poBlock == nullptr)
-                    return CE_Failure;
-
-                void *const pData = poBlock->GetDataRef();
+                GUInt32 nMin = 0;
+                GUInt32 nMax = 0;
+                GUIntBig nSum = 0;
+                GUIntBig nSumSquare = 0;
+                GUIntBig nSampleCount = 0;
+                GUIntBig nValidCount = 0;
+
+                void Merge(const IntegerStatsAccumulator &oOther)
+                {
+                    nMin = std::min(nMin, oOther.nMin);
+                    nMax = std::max(nMax, oOther.nMax);
+                    nSum += oOther.nSum;
+                    nSumSquare += oOther.nSumSquare;
+                    nSampleCount += oOther.nSampleCount;
+                    nValidCount += oOther.nValidCount;
+                }
+            };
 
-                int nXCheck = 0, nYCheck = 0;
-                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+            IntegerStatsAccumulator oInit;
+            oInit.nMin = nMaxValueType;
+            IntegerStatsAccumulator oResult(oInit);
 
+            const auto ProcessBlock =
+                [this, nNoDataValue,
+                 nMaxValueType](IntegerStatsAccumulator &oAcc,
+                                const void *pData, const GByte * /* pabyMask */,
+                                int nXCheck, int nYCheck)
+            {
                 if (eDataType == GDT_Byte)
                 {
                     ComputeStatisticsInternal<
                         GByte, /* COMPUTE_OTHER_STATS = */ true>::
                         f(nXCheck, nBlockXSize, nYCheck,
                           static_cast<const GByte *>(pData),
-                          nNoDataValue <= nMaxValueType, nNoDataValue, nMin,
-                          nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                          nNoDataValue <= nMaxValueType, nNoDataValue,
+                          oAcc.nMin, oAcc.nMax, oAcc.nSum, oAcc.nSumSquare,
+                          oAcc.nSampleCount, oAcc.nValidCount);
                 }
                 else
                 {
@@ -5977,23 +6431,47 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                         GUInt16, /* COMPUTE_OTHER_STATS = */ true>::
                         f(nXCheck, nBlockXSize, nYCheck,
                           static_cast<const GUInt16 *>(pData),
-                          nNoDataValue <= nMaxValueType, nNoDataValue, nMin,
-                          nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                          nNoDataValue <= nMaxValueType, nNoDataValue,
+                          oAcc.nMin, oAcc.nMax, oAcc.nSum, oAcc.nSumSquare,
+                          oAcc.nSampleCount, oAcc.nValidCount);
                 }
+            };
 
-                poBlock->DropLock();
-
+            bool bInterrupted = false;
+            const auto AfterBlock =
+                [this, pfnProgress, pProgressData,
+                 &bInterrupted](const IntegerStatsAccumulator &,
+                                int iSampleBlock)
+            {
                 if (!pfnProgress(iSampleBlock /
                                      static_cast<double>(nBlocksPerRow *
                                                          nBlocksPerColumn),
                                  "Compute Statistics", pProgressData))
                 {
-                    ReportError(CE_Failure, CPLE_UserInterrupt,
-                                "User terminated");
-                    return CE_Failure;
+                    bInterrupted = true;
+                    return false;
                 }
+                return true;
+            };
+
+            if (!ProcessSampledBlocks(this, nullptr, nSampleRate, oInit,
+                                      oResult, ProcessBlock, AfterBlock))
+            {
+                return CE_Failure;
+            }
+            if (bInterrupted)
+            {
+                ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                return CE_Failure;
             }
 
+            const GUInt32 nMin = oResult.nMin;
+            const GUInt32 nMax = oResult.nMax;
+            const GUIntBig nSum = oResult.nSum;
+            const GUIntBig nSumSquare = oResult.nSumSquare;
+            nSampleCount = oResult.nSampleCount;
+            nValidCount = oResult.nValidCount;
+
             if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
             {
                 ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
@@ -6060,48 +6538,47 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
         }
 #endif
 
-        GByte *pabyMaskData = nullptr;
-        if (poMaskBand)
-        {
-            pabyMaskData = static_cast<GByte *>(
-                VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-            if (!pabyMaskData)
-            {
-                return CE_Failure;
-            }
-        }
-
-        for (int iSampleBlock = 0;
-             iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
-             iSampleBlock += nSampleRate)
+        // Partial statistics, using Welford algorithm
+        struct StatsAccumulator
         {
-            const int iYBlock = iSampleBlock / nBlocksPerRow;
-            const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
-
-            GDALRasterBlock *const poBlock =
-                GetLockedBlockRef(iXBlock, iYBlock);
-            if (poBlock == nullptr)
+            double dfMin = std::numeric_limits<double>::max();
+            double dfMax = -std::numeric_limits<double>::max();
+            double dfMean = 0.0;
+            double dfM2 = 0.0;
+            GUIntBig nSampleCount = 0;
+            GUIntBig nValidCount = 0;
+
+            // Combine means and sums of squares of differences with the
+            // pairwise formula of Chan et al.
+            void Merge(const StatsAccumulator &oOther)
             {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
+                nSampleCount += oOther.nSampleCount;
+                if (oOther.nValidCount == 0)
+                    return;
+                dfMin = std::min(dfMin, oOther.dfMin);
+                dfMax = std::max(dfMax, oOther.dfMax);
+                const GUIntBig nNewValidCount =
+                    nValidCount + oOther.nValidCount;
+                const double dfDelta = oOther.dfMean - dfMean;
+                const double dfOtherRatio =
+                    static_cast<double>(oOther.nValidCount) / nNewValidCount;
+                dfMean += dfDelta * dfOtherRatio;
+                dfM2 += oOther.dfM2 + dfDelta * dfDelta *
+                                          static_cast<double>(nValidCount) *
+                                          dfOtherRatio;
+                nValidCount = nNewValidCount;
             }
+        };
 
-            void *const pData = poBlock->GetDataRef();
-
-            int nXCheck = 0, nYCheck = 0;
-            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-            if (poMaskBand &&
-                poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                     iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                     pabyMaskData, nXCheck, nYCheck, GDT_Byte,
-                                     0, nBlockXSize, nullptr) != CE_None)
-            {
-                CPLFree(pabyMaskData);
-                poBlock->DropLock();
-                return CE_Failure;
-            }
+        const StatsAccumulator oInit;
+        StatsAccumulator oResult;
 
+        const auto ProcessBlock =
+            [this, bSignedByte, bGotNoDataValue, dfNoDataValue,
+             bGotFloatNoDataValue,
+             fNoDataValue](StatsAccumulator &oAcc, const void *pData,
+                           const GByte *pabyMaskData, int nXCheck, int nYCheck)
+        {
             // This isn't the fastest way to do this, but is easier for now.
             for (int iY = 0; iY < nYCheck; iY++)
             {
@@ -6121,32 +6598,52 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                     if (!bValid)
                         continue;
 
-                    dfMin = std::min(dfMin, dfValue);
-                    dfMax = std::max(dfMax, dfValue);
+                    oAcc.dfMin = std::min(oAcc.dfMin, dfValue);
+                    oAcc.dfMax = std::max(oAcc.dfMax, dfValue);
 
-                    nValidCount++;
-                    const double dfDelta = dfValue - dfMean;
-                    dfMean += dfDelta / nValidCount;
-                    dfM2 += dfDelta * (dfValue - dfMean);
+                    oAcc.nValidCount++;
+                    const double dfDelta = dfValue - oAcc.dfMean;
+                    oAcc.dfMean += dfDelta / oAcc.nValidCount;
+                    oAcc.dfM2 += dfDelta * (dfValue - oAcc.dfMean);
                 }
             }
 
-            nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
-
-            poBlock->DropLock();
+            oAcc.nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
+        };
 
+        bool bInterrupted = false;
+        const auto AfterBlock = [this, pfnProgress, pProgressData,
+                                 &bInterrupted](const StatsAccumulator &,
+                                                int iSampleBlock)
+        {
             if (!pfnProgress(
                     iSampleBlock /
                         static_cast<double>(nBlocksPerRow * nBlocksPerColumn),
                     "Compute Statistics", pProgressData))
             {
-                ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-                CPLFree(pabyMaskData);
-                return CE_Failure;
+                bInterrupted = true;
+                return false;
             }
+            return true;
+        };
+
+        if (!ProcessSampledBlocks(this, poMaskBand, nSampleRate, oInit,
+                                  oResult, ProcessBlock, AfterBlock))
+        {
+            return CE_Failure;
+        }
+        if (bInterrupted)
+        {
+            ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
         }
 
-        CPLFree(pabyMaskData);
+        dfMin = oResult.dfMin;
+        dfMax = oResult.dfMax;
+        dfMean = oResult.dfMean;
+        dfM2 = oResult.dfM2;
+        nSampleCount = oResult.nSampleCount;
+        nValidCount = oResult.nValidCount;
     }
 
     if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
@@ -6474,63 +6971,53 @@ static void ComputeMinMaxGeneric(const void *pData, GDALDataType eDataType,
 
 static bool ComputeMinMaxGenericIterBlocks(
     GDALRasterBand *poBand, GDALDataType eDataType, bool bSignedByte,
-    int nTotalBlocks, int nSampleRate, int nBlocksPerRow, bool bGotNoDataValue,
-    double dfNoDataValue, bool bGotFloatNoDataValue, float fNoDataValue,
-    GDALRasterBand *poMaskBand, double &dfMin, double &dfMax)
+    int nSampleRate, bool bGotNoDataValue, double dfNoDataValue,
+    bool bGotFloatNoDataValue, float fNoDataValue, GDALRasterBand *poMaskBand,
+    double &dfMin, double &dfMax)
 
 {
-    GByte *pabyMaskData = nullptr;
     int nBlockXSize, nBlockYSize;
     poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
 
-    if (poMaskBand)
+    struct MinMaxAccumulator
     {
-        pabyMaskData =
-            static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-        if (!pabyMaskData)
-        {
-            return false;
-        }
-    }
+        double dfMin = 0;
+        double dfMax = 0;
 
-    for (int iSampleBlock = 0; iSampleBlock < nTotalBlocks;
-         iSampleBlock += nSampleRate)
-    {
-        const int iYBlock = iSampleBlock / nBlocksPerRow;
-        const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
-
-        GDALRasterBlock *poBlock = poBand->GetLockedBlockRef(iXBlock, iYBlock);
-        if (poBlock == nullptr)
+        void Merge(const MinMaxAccumulator &oOther)
         {
-            CPLFree(pabyMaskData);
-            return false;
+            dfMin = std::min(dfMin, oOther.dfMin);
+            dfMax = std::max(dfMax, oOther.dfMax);
         }
+    };
 
-        void *const pData = poBlock->GetDataRef();
-
-        int nXCheck = 0, nYCheck = 0;
-        poBand->GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-        if (poMaskBand &&
-            poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                 iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                 pabyMaskData, nXCheck, nYCheck, GDT_Byte, 0,
-                                 nBlockXSize, nullptr) != CE_None)
-        {
-            poBlock->DropLock();
-            CPLFree(pabyMaskData);
-            return false;
-        }
+    MinMaxAccumulator oInit;
+    oInit.dfMin = dfMin;
+    oInit.dfMax = dfMax;
+    MinMaxAccumulator oResult(oInit);
 
+    const auto ProcessBlock =
+        [eDataType, bSignedByte, nBlockXSize, bGotNoDataValue, dfNoDataValue,
+         bGotFloatNoDataValue,
+         fNoDataValue](MinMaxAccumulator &oAcc, const void *pData,
+                       const GByte *pabyMaskData, int nXCheck, int nYCheck)
+    {
         ComputeMinMaxGeneric(pData, eDataType, bSignedByte, nXCheck, nYCheck,
-                             nBlockXSize, CPL_TO_BOOL(bGotNoDataValue),
-                             dfNoDataValue, bGotFloatNoDataValue, fNoDataValue,
-                             pabyMaskData, dfMin, dfMax);
+                             nBlockXSize, bGotNoDataValue, dfNoDataValue,
+                             bGotFloatNoDataValue, fNoDataValue, pabyMaskData,
+                             oAcc.dfMin, oAcc.dfMax);
+    };
 
-        poBlock->DropLock();
+    const auto AfterBlock = [](const MinMaxAccumulator &, int) { return true; };
+
+    if (!ProcessSampledBlocks(poBand, poMaskBand, nSampleRate, oInit, oResult,
+                              ProcessBlock, AfterBlock))
+    {
+        return false;
     }
 
-    CPLFree(pabyMaskData);
+    dfMin = oResult.dfMin;
+    dfMax = oResult.dfMax;
     return true;
 }
 
@@ -6545,6 +7032,10 @@ static bool ComputeMinMaxGenericIterBlocks(
  * If bApprox is FALSE, then all pixels will be read and used to compute
  * an exact range.
  *
+ * Starting with GDAL 3.9, the GDAL_NUM_THREADS configuration option can be
+ * set to "ALL_CPUS" or a integer value to process blocks with several
+ * threads.
+ *
  * This method is the same as the C function GDALComputeRasterMinMax().
  *
  * @param bApproxOK TRUE if an approximate (faster) answer is OK, otherwise
@@ -6625,14 +7116,26 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
     GDALRasterIOExtraArg sExtraArg;
     INIT_RASTERIO_EXTRA_ARG(sExtraArg);
 
-    GUInt32 nMin = (eDataType == GDT_Byte)
-                       ? 255
-                       : 65535;  // used for GByte & GUInt16 cases
-    GUInt32 nMax = 0;            // used for GByte & GUInt16 cases
-    GInt16 nMinInt16 =
-        std::numeric_limits<GInt16>::max();  // used for GInt16 case
-    GInt16 nMaxInt16 =
-        std::numeric_limits<GInt16>::lowest();  // used for GInt16 case
+    // Min/max of optimized code path
+    struct MinMaxAccumulator
+    {
+        GUInt32 nMin = 0;  // used for GByte & GUInt16 cases
+        GUInt32 nMax = 0;  // used for GByte & GUInt16 cases
+        GInt16 nMinInt16 =
+            std::numeric_limits<GInt16>::max();  // used for GInt16 case
+        GInt16 nMaxInt16 =
+            std::numeric_limits<GInt16>::lowest();  // used for GInt16 case
+
+        void Merge(const MinMaxAccumulator &oOther)
+        {
+            nMin = std::min(nMin, oOther.nMin);
+            nMax = std::max(nMax, oOther.nMax);
+            nMinInt16 = std::min(nMinInt16, oOther.nMinInt16);
+            nMaxInt16 = std::max(nMaxInt16, oOther.nMaxInt16);
+        }
+    };
+    MinMaxAccumulator oMinMax;
+    oMinMax.nMin = (eDataType == GDT_Byte) ? 255 : 65535;
     double dfMin =
         std::numeric_limits<double>::max();  // used for generic code path
     double dfMax =
@@ -6642,9 +7145,9 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                         eDataType == GDT_Int16 || eDataType == GDT_UInt16);
 
     const auto ComputeMinMaxForBlock =
-        [this, bSignedByte, bGotNoDataValue, dfNoDataValue, &nMin, &nMax,
-         &nMinInt16, &nMaxInt16](const void *pData, int nXCheck,
-                                 int nBufferWidth, int nYCheck)
+        [this, bSignedByte, bGotNoDataValue,
+         dfNoDataValue](MinMaxAccumulator &oAcc, const void *pData,
+                        int nXCheck, int nBufferWidth, int nYCheck)
     {
         if (eDataType == GDT_Byte && !bSignedByte)
         {
@@ -6658,7 +7161,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                                       /* COMPUTE_OTHER_STATS = */ false>::
                 f(nXCheck, nBufferWidth, nYCheck,
                   static_cast<const GByte *>(pData), bHasNoData, nNoDataValue,
-                  nMin, nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                  oAcc.nMin, oAcc.nMax, nSum, nSumSquare, nSampleCount,
+                  nValidCount);
         }
         else if (eDataType == GDT_UInt16)
         {
@@ -6672,7 +7176,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                                       /* COMPUTE_OTHER_STATS = */ false>::
                 f(nXCheck, nBufferWidth, nYCheck,
                   static_cast<const GUInt16 *>(pData), bHasNoData, nNoDataValue,
-                  nMin, nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                  oAcc.nMin, oAcc.nMax, nSum, nSumSquare, nSampleCount,
+                  nValidCount);
         }
         else if (eDataType == GDT_Int16)
         {
@@ -6688,7 +7193,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                     ComputeMinMax<int16_t, true>(
                         static_cast<const int16_t *>(pData) +
                             static_cast<size_t>(iY) * nBufferWidth,
-                        nXCheck, nNoDataValue, &nMinInt16, &nMaxInt16);
+                        nXCheck, nNoDataValue, &oAcc.nMinInt16,
+                        &oAcc.nMaxInt16);
                 }
             }
             else
@@ -6698,7 +7204,7 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                     ComputeMinMax<int16_t, false>(
                         static_cast<const int16_t *>(pData) +
                             static_cast<size_t>(iY) * nBufferWidth,
-                        nXCheck, 0, &nMinInt16, &nMaxInt16);
+                        nXCheck, 0, &oAcc.nMinInt16, &oAcc.nMaxInt16);
                 }
             }
         }
@@ -6764,7 +7270,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
 
         if (bUseOptimizedPath)
         {
-            ComputeMinMaxForBlock(pData, nXReduced, nXReduced, nYReduced);
+            ComputeMinMaxForBlock(oMinMax, pData, nXReduced, nXReduced,
+                                  nYReduced);
         }
         else
         {
@@ -6805,37 +7312,36 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
 
         if (bUseOptimizedPath)
         {
-            for (int iSampleBlock = 0;
-                 iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
-                 iSampleBlock += nSampleRate)
+            const auto ProcessBlock = [this, &ComputeMinMaxForBlock](
+                                          MinMaxAccumulator &oAcc,
+                                          const void *pData,
+                                          const GByte * /* pabyMask */,
+                                          int nXCheck, int nYCheck)
             {
-                const int iYBlock = iSampleBlock / nBlocksPerRow;
-                const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
-
-                GDALRasterBlock *poBlock = GetLockedBlockRef(iXBlock, iYBlock);
-                if (poBlock == nullptr)
-                    return CE_Failure;
-
-                void *const pData = poBlock->GetDataRef();
+                ComputeMinMaxForBlock(oAcc, pData, nXCheck, nBlockXSize,
+                                      nYCheck);
+            };
 
-                int nXCheck = 0, nYCheck = 0;
-                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-                ComputeMinMaxForBlock(pData, nXCheck, nBlockXSize, nYCheck);
-
-                poBlock->DropLock();
+            const auto AfterBlock =
+                [this, bSignedByte](const MinMaxAccumulator &oAcc,
+                                    int /* iSampleBlock */)
+            {
+                return !(eDataType == GDT_Byte && !bSignedByte &&
+                         oAcc.nMin == 0 && oAcc.nMax == 255);
+            };
 
-                if (eDataType == GDT_Byte && !bSignedByte && nMin == 0 &&
-                    nMax == 255)
-                    break;
+            const MinMaxAccumulator oInit(oMinMax);
+            if (!ProcessSampledBlocks(this, nullptr, nSampleRate, oInit,
+                                      oMinMax, ProcessBlock, AfterBlock))
+            {
+                return CE_Failure;
             }
         }
         else
         {
-            const int nTotalBlocks = nBlocksPerRow * nBlocksPerColumn;
             if (!ComputeMinMaxGenericIterBlocks(
-                    this, eDataType, bSignedByte, nTotalBlocks, nSampleRate,
-                    nBlocksPerRow, CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
+                    this, eDataType, bSignedByte, nSampleRate,
+                    CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
                     bGotFloatNoDataValue, fNoDataValue, poMaskBand, dfMin,
                     dfMax))
             {
@@ -6848,13 +7354,13 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
     {
         if ((eDataType == GDT_Byte && !bSignedByte) || eDataType == GDT_UInt16)
         {
-            dfMin = nMin;
-            dfMax = nMax;
+            dfMin = oMinMax.nMin;
+            dfMax = oMinMax.nMax;
         }
         else if (eDataType == GDT_Int16)
         {
-            dfMin = nMinInt16;
-            dfMax = nMaxInt16;
+            dfMin = oMinMax.nMinInt16;
+            dfMax = oMinMax.nMaxInt16;
         }
     }
 
@@ -8826,3 +9332,281 @@ std::shared_ptr<GDALMDArray> GDALRasterBand::AsMDArray() const
     return GDALMDArrayFromRasterBand::Create(
         poDS, const_cast<GDALRasterBand *>(this));
 }
+
+/************************************************************************/
+/*                           SamplePoints()                             */
+/************************************************************************/
+
+/**
+ * \brief Fetch the values of the band at a set of points.
+ *
+ * Points are expressed in pixel/line coordinates of the band, where (0, 0)
+ * is the top-left corner of the top-left pixel, and (0.5, 0.5) its center.
+ *
+ * Points are processed grouped by the block they fall in, so that whatever
+ * their order, each block (and the few neighbouring pixels needed by the
+ * interpolation kernel) is read once. This is much more efficient than
+ * issuing one RasterIO() request per point when sampling many points.
+ *
+ * With GRIORA_Bilinear and GRIORA_Cubic, values are interpolated from
+ * respectively the 2x2 and 4x4 pixel centers closest to the point, using
+ * the value of edge pixels beyond the edges of the raster. If one of those
+ * pixels is equal to the nodata value or is NaN, the value of the pixel
+ * containing the point is returned instead.
+ *
+ * Values are not scaled by the offset and scale of the band.
+ *
+ * This is the same as the C function GDALRasterSamplePoints().
+ *
+ * @param nPointCount Number of points.
+ * @param padfPixels Array of nPointCount pixel (column) coordinates.
+ * @param padfLines Array of nPointCount line (row) coordinates.
+ * @param eResampleAlg GRIORA_NearestNeighbour, GRIORA_Bilinear or
+ * GRIORA_Cubic.
+ * @param padfRealValues Array of nPointCount values, set to the values (or
+ * their real part for complex data types) at each point, in the order of
+ * the input points. Points outside of the raster get a NaN value.
+ * @param padfImagValues Array of nPointCount values, set to the imaginary
+ * part of the values, or nullptr.
+ *
+ * @return CE_None on success, or CE_Failure on an error.
+ *
+ * @since GDAL 3.9
+ */
+CPLErr GDALRasterBand::SamplePoints(size_t nPointCount,
+                                    const double *padfPixels,
+                                    const double *padfLines,
+                                    GDALRIOResampleAlg eResampleAlg,
+                                    double *padfRealValues,
+                                    double *padfImagValues)
+{
+    // Number of pixels needed before and after the pixel whose center is
+    // at the left of (above) the point.
+    int nKernelBefore = 0;
+    int nKernelAfter = 0;
+    switch (eResampleAlg)
+    {
+        case GRIORA_NearestNeighbour:
+            break;
+        case GRIORA_Bilinear:
+            nKernelAfter = 1;
+            break;
+        case GRIORA_Cubic:
+            nKernelBefore = 1;
+            nKernelAfter = 2;
+            break;
+        default:
+            ReportError(CE_Failure, CPLE_NotSupported,
+                        "SamplePoints(): only nearest neighbour, bilinear "
+                        "and cubic resampling are supported");
+            return CE_Failure;
+    }
+
+    const bool bIsComplex = CPL_TO_BOOL(GDALDataTypeIsComplex(eDataType));
+    const GDALDataType eBufType = bIsComplex ? GDT_CFloat64 : GDT_Float64;
+    const int nValuesPerPixel = bIsComplex ? 2 : 1;
+
+    int bHasNoData = FALSE;
+    const double dfNoDataValue = GetNoDataValue(&bHasNoData);
+
+    // Sort points by the block of the pixel they fall in.
+    const int nXBlocks = DIV_ROUND_UP(nRasterXSize, nBlockXSize);
+    std::vector<std::pair<GUIntBig, size_t>> anBlockAndPointIdx;
+    try
+    {
+        anBlockAndPointIdx.reserve(nPointCount);
+    }
+    catch (const std::exception &)
+    {
+        ReportError(CE_Failure, CPLE_OutOfMemory,
+                    "SamplePoints(): out of memory");
+        return CE_Failure;
+    }
+    constexpr double dfNaN = std::numeric_limits<double>::quiet_NaN();
+    for (size_t i = 0; i < nPointCount; ++i)
+    {
+        padfRealValues[i] = dfNaN;
+        if (padfImagValues)
+            padfImagValues[i] = dfNaN;
+        // Also rejects NaN coordinates
+        if (!(padfPixels[i] >= 0 && padfPixels[i] < nRasterXSize &&
+              padfLines[i] >= 0 && padfLines[i] < nRasterYSize))
+            continue;
+        const int nBlockX = static_cast<int>(padfPixels[i]) / nBlockXSize;
+        const int nBlockY = static_cast<int>(padfLines[i]) / nBlockYSize;
+        anBlockAndPointIdx.emplace_back(
+            static_cast<GUIntBig>(nBlockY) * nXBlocks + nBlockX, i);
+    }
+    std::sort(anBlockAndPointIdx.begin(), anBlockAndPointIdx.end());
+
+    std::vector<double> adfWindow;
+    size_t iStart = 0;
+    while (iStart < anBlockAndPointIdx.size())
+    {
+        const GUIntBig nBlock = anBlockAndPointIdx[iStart].first;
+        size_t iEnd = iStart + 1;
+        while (iEnd < anBlockAndPointIdx.size() &&
+               anBlockAndPointIdx[iEnd].first == nBlock)
+            ++iEnd;
+
+        // Read the block, extended by the pixels needed by the kernel.
+        const int nBlockX = static_cast<int>(nBlock % nXBlocks);
+        const int nBlockY = static_cast<int>(nBlock / nXBlocks);
+        const int nMargin = nKernelAfter;
+        const int nWinXOff = std::max(0, nBlockX * nBlockXSize - nMargin);
+        const int nWinYOff = std::max(0, nBlockY * nBlockYSize - nMargin);
+        const int nWinXEnd = static_cast<int>(std::min<GIntBig>(
+            nRasterXSize,
+            static_cast<GIntBig>(nBlockX + 1) * nBlockXSize + nMargin));
+        const int nWinYEnd = static_cast<int>(std::min<GIntBig>(
+            nRasterYSize,
+            static_cast<GIntBig>(nBlockY + 1) * nBlockYSize + nMargin));
+        const int nWinXSize = nWinXEnd - nWinXOff;
+        const int nWinYSize = nWinYEnd - nWinYOff;
+        try
+        {
+            adfWindow.resize(static_cast<size_t>(nWinXSize) * nWinYSize *
+                             nValuesPerPixel);
+        }
+        catch (const std::exception &)
+        {
+            ReportError(CE_Failure, CPLE_OutOfMemory,
+                        "SamplePoints(): out of memory");
+            return CE_Failure;
+        }
+        if (RasterIO(GF_Read, nWinXOff, nWinYOff, nWinXSize, nWinYSize,
+                     adfWindow.data(), nWinXSize, nWinYSize, eBufType, 0, 0,
+                     nullptr) != CE_None)
+        {
+            return CE_Failure;
+        }
+
+        // Return the value at (nX, nY) in raster coordinates, clamped to
+        // the raster.
+        const auto GetValue = [&](int nX, int nY, int iComponent)
+        {
+            nX = std::max(0, std::min(nX, nRasterXSize - 1)) - nWinXOff;
+            nY = std::max(0, std::min(nY, nRasterYSize - 1)) - nWinYOff;
+            return adfWindow[(static_cast<size_t>(nY) * nWinXSize + nX) *
+                                 nValuesPerPixel +
+                             iComponent];
+        };
+
+        const auto IsNoData = [bHasNoData, dfNoDataValue](double dfVal)
+        { return std::isnan(dfVal) || (bHasNoData && dfVal == dfNoDataValue); };
+
+        for (size_t i = iStart; i < iEnd; ++i)
+        {
+            const size_t iPoint = anBlockAndPointIdx[i].second;
+            const double dfPixel = padfPixels[iPoint];
+            const double dfLine = padfLines[iPoint];
+            const int nPixel = static_cast<int>(dfPixel);
+            const int nLine = static_cast<int>(dfLine);
+
+            std::array<double, 2> adfValue = {GetValue(nPixel, nLine, 0),
+                                              bIsComplex
+                                                  ? GetValue(nPixel, nLine, 1)
+                                                  : 0.0};
+            if (eResampleAlg != GRIORA_NearestNeighbour)
+            {
+                const int nX0 = static_cast<int>(floor(dfPixel - 0.5));
+                const int nY0 = static_cast<int>(floor(dfLine - 0.5));
+                const double dfDX = dfPixel - 0.5 - nX0;
+                const double dfDY = dfLine - 0.5 - nY0;
+
+                // Weights of pixels from nX0 - nKernelBefore to
+                // nX0 + nKernelAfter.
+                std::array<double, 4> adfWeightsX{};
+                std::array<double, 4> adfWeightsY{};
+                if (eResampleAlg == GRIORA_Bilinear)
+                {
+                    adfWeightsX = {1 - dfDX, dfDX, 0, 0};
+                    adfWeightsY = {1 - dfDY, dfDY, 0, 0};
+                }
+                else
+                {
+                    // Keys cubic convolution kernel, with a = -0.5
+                    const auto CubicWeight = [](double dfX)
+                    {
+                        dfX = fabs(dfX);
+                        if (dfX <= 1)
+                            return (1.5 * dfX - 2.5) * dfX * dfX + 1;
+                        if (dfX < 2)
+                            return ((-0.5 * dfX + 2.5) * dfX - 4) * dfX + 2;
+                        return 0.0;
+                    };
+                    for (int k = 0; k < 4; ++k)
+                    {
+                        adfWeightsX[k] = CubicWeight(dfDX + 1 - k);
+                        adfWeightsY[k] = CubicWeight(dfDY + 1 - k);
+                    }
+                }
+
+                std::array<double, 2> adfInterpolated = {0.0, 0.0};
+                bool bHasInvalid = false;
+                for (int iY = -nKernelBefore;
+                     iY <= nKernelAfter && !bHasInvalid; ++iY)
+                {
+                    for (int iX = -nKernelBefore; iX <= nKernelAfter; ++iX)
+                    {
+                        const double dfWeight =
+                            adfWeightsX[iX + nKernelBefore] *
+                            adfWeightsY[iY + nKernelBefore];
+                        const double dfVal = GetValue(nX0 + iX, nY0 + iY, 0);
+                        if (IsNoData(dfVal))
+                        {
+                            bHasInvalid = true;
+                            break;
+                        }
+                        adfInterpolated[0] += dfWeight * dfVal;
+                        if (bIsComplex)
+                        {
+                            adfInterpolated[1] +=
+                                dfWeight * GetValue(nX0 + iX, nY0 + iY, 1);
+                        }
+                    }
+                }
+                if (!bHasInvalid)
+                    adfValue = adfInterpolated;
+            }
+
+            padfRealValues[iPoint] = adfValue[0];
+            if (padfImagValues)
+                padfImagValues[iPoint] = adfValue[1];
+        }
+
+        iStart = iEnd;
+    }
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                       GDALRasterSamplePoints()                       */
+/************************************************************************/
+
+/**
+ * \brief Fetch the values of the band at a set of points.
+ *
+ * @see GDALRasterBand::SamplePoints()
+ *
+ * @since GDAL 3.9
+ */
+CPLErr GDALRasterSamplePoints(GDALRasterBandH hBand, size_t nPointCount,
+                              const double *padfPixels,
+                              const double *padfLines,
+                              GDALRIOResampleAlg eResampleAlg,
+                              double *padfRealValues, double *padfImagValues)
+{
+    VALIDATE_POINTER1(hBand, "GDALRasterSamplePoints", CE_Failure);
+    if (nPointCount)
+    {
+        VALIDATE_POINTER1(padfPixels, "GDALRasterSamplePoints", CE_Failure);
+        VALIDATE_POINTER1(padfLines, "GDALRasterSamplePoints", CE_Failure);
+        VALIDATE_POINTER1(padfRealValues, "GDALRasterSamplePoints", CE_Failure);
+    }
+
+    GDALRasterBand *poBand = GDALRasterBand::FromHandle(hBand);
+    return poBand->SamplePoints(nPointCount, padfPixels, padfLines,
+                                eResampleAlg, padfRealValues, padfImagValues);
+}
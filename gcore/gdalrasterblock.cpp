@@ -33,34 +33,61 @@
 #include "gdal_priv.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <climits>
 #include <cstring>
+#include <map>
 #include <mutex>
+#include <vector>
 
 #include "cpl_atomic_ops.h"
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_json.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
+#include "cpl_trace.h"
 #include "cpl_vsi.h"
 
 // Will later be overridden by the default 5% if GDAL_CACHEMAX not defined.
 static GIntBig nCacheMax = 40 * 1024 * 1024;
-static GIntBig nCacheUsed = 0;
 
-static GDALRasterBlock *poOldest = nullptr;  // Tail.
-static GDALRasterBlock *poNewest = nullptr;  // Head.
+// Sum of the cache usage of all shards.
+static std::atomic<GIntBig> nCacheUsed{0};
 
 static int nDisableDirtyBlockFlushCounter = 0;
 
+/************************************************************************/
+/*                        GDALRasterBlockShard                          */
+/************************************************************************/
+
+// The LRU list of cached blocks can be split into several shards
+// (GDAL_RB_SHARD_COUNT configuration option), each one with its own lock,
+// LRU list and part of the GDAL_CACHEMAX budget. A block is assigned to a
+// shard by hashing its band and block coordinates. With the default of a
+// single shard, behavior is the historical one of a single global LRU.
+
+constexpr int MAX_RB_SHARD_COUNT = 64;
+
+struct GDALRasterBlockShard
+{
+    CPLLock *hRBLock = nullptr;
+    GDALRasterBlock *poOldest = nullptr;  // Tail.
+    GDALRasterBlock *poNewest = nullptr;  // Head.
+    // Modified under hRBLock, but may be read without it.
+    std::atomic<GIntBig> nCacheUsed{0};
+};
+
+static GDALRasterBlockShard asShards[MAX_RB_SHARD_COUNT];
+static int nShardCount = 1;
+
 #if 0
-static CPLMutex *hRBLock = nullptr;
-#define INITIALIZE_LOCK CPLMutexHolderD(&hRBLock)
-#define TAKE_LOCK CPLMutexHolderOptionalLockD(hRBLock)
-#define DESTROY_LOCK CPLDestroyMutex(hRBLock)
+#define INITIALIZE_LOCK(oShard) CPLMutexHolderD(&((oShard).hRBLock))
+#define TAKE_LOCK(oShard) CPLMutexHolderOptionalLockD((oShard).hRBLock)
+#define DESTROY_LOCK(oShard) CPLDestroyMutex((oShard).hRBLock)
 #else
 
-static CPLLock *hRBLock = nullptr;
 static bool bDebugContention = false;
 static bool bSleepsForBockCacheDebug = false;
 static CPLLockType GetLockType()
@@ -90,14 +117,108 @@ static CPLLockType GetLockType()
     return static_cast<CPLLockType>(nLockType);
 }
 
-#define INITIALIZE_LOCK                                                        \
-    CPLLockHolderD(&hRBLock, GetLockType());                                   \
-    CPLLockSetDebugPerf(hRBLock, bDebugContention)
-#define TAKE_LOCK CPLLockHolderOptionalLockD(hRBLock)
-#define DESTROY_LOCK CPLDestroyLock(hRBLock)
+#define INITIALIZE_LOCK(oShard)                                                \
+    CPLLockHolderD(&((oShard).hRBLock), GetLockType());                        \
+    CPLLockSetDebugPerf((oShard).hRBLock, bDebugContention)
+#define TAKE_LOCK(oShard) CPLLockHolderOptionalLockD((oShard).hRBLock)
+#define DESTROY_LOCK(oShard) CPLDestroyLock((oShard).hRBLock)
 
 #endif
 
+/************************************************************************/
+/*                          GetShardCount()                             */
+/************************************************************************/
+
+static int GetShardCount()
+{
+    const char *pszShardCount =
+        CPLGetConfigOption("GDAL_RB_SHARD_COUNT", nullptr);
+    if (pszShardCount == nullptr)
+        return 1;
+    int nCount = EQUAL(pszShardCount, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                  : atoi(pszShardCount);
+    if (nCount < 1 || nCount > MAX_RB_SHARD_COUNT)
+    {
+        const int nClamped = std::max(1, std::min(nCount, MAX_RB_SHARD_COUNT));
+        if (!EQUAL(pszShardCount, "ALL_CPUS"))
+        {
+            CPLError(CE_Warning, CPLE_IllegalArg,
+                     "GDAL_RB_SHARD_COUNT=%s out of range [1,%d]. Using %d",
+                     pszShardCount, MAX_RB_SHARD_COUNT, nClamped);
+        }
+        nCount = nClamped;
+    }
+    return nCount;
+}
+
+/************************************************************************/
+/*                          GetShardIndex()                             */
+/************************************************************************/
+
+static int GetShardIndex(const GDALRasterBand *poBand, int nXOff, int nYOff)
+{
+    if (nShardCount == 1)
+        return 0;
+    GUIntBig nKey =
+        (static_cast<GUIntBig>(static_cast<GUInt32>(nYOff)) << 32) |
+        static_cast<GUInt32>(nXOff);
+    nKey ^= static_cast<GUIntBig>(reinterpret_cast<uintptr_t>(poBand));
+    // Fibonacci hashing: the high bits are well mixed
+    nKey *= 0x9E3779B97F4A7C15ULL;
+    return static_cast<int>((nKey >> 32) % static_cast<GUIntBig>(nShardCount));
+}
+
+/************************************************************************/
+/*                       IncrementCacheCounter()                        */
+/************************************************************************/
+
+// Global counters of the block cache. Their nUsedBytes member is not used:
+// see nCacheUsed.
+static GDALBlockCacheCounters gsCacheCounters;
+
+// Increment a counter globally, for a band and for its dataset.
+static void IncrementCacheCounter(
+    GDALBlockCacheCounters &oBandCounters, GDALBlockCacheCounters *poDSCounters,
+    std::atomic<GIntBig> GDALBlockCacheCounters::*pnCounter, GIntBig nInc = 1)
+{
+    (gsCacheCounters.*pnCounter) += nInc;
+    (oBandCounters.*pnCounter) += nInc;
+    if (poDSCounters)
+        (poDSCounters->*pnCounter) += nInc;
+}
+
+/************************************************************************/
+/*                         TraceCacheCounters()                         */
+/************************************************************************/
+
+// Record the global counters of the block cache in the trace (CPL_TRACE_FILE)
+// at most every millisecond.
+static void TraceCacheCounters()
+{
+    if (!CPLTraceIsEnabled())
+        return;
+    static std::atomic<GIntBig> gnLastTraceMS{0};
+    const GIntBig nNowMS = static_cast<GIntBig>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+    GIntBig nLastTraceMS = gnLastTraceMS.load();
+    if (nNowMS == nLastTraceMS ||
+        !gnLastTraceMS.compare_exchange_strong(nLastTraceMS, nNowMS))
+    {
+        return;
+    }
+    const char *const apszKeys[] = {"used_bytes", "hits", "misses",
+                                    "evictions", "dirty_flushes"};
+    const GIntBig anValues[] = {
+        nCacheUsed.load(), gsCacheCounters.nHits.load(),
+        gsCacheCounters.nMisses.load(), gsCacheCounters.nEvictions.load(),
+        gsCacheCounters.nDirtyFlushes.load()};
+    CPLTraceCounter("gdal", "GDAL block cache",
+                    static_cast<int>(CPL_ARRAYSIZE(anValues)), apszKeys,
+                    anValues);
+}
+
 // #define ENABLE_DEBUG
 
 /************************************************************************/
@@ -240,9 +361,14 @@ GIntBig CPL_STDCALL GDALGetCacheMax64()
         flagSetupGDALGetCacheMax64,
         []()
         {
+            nShardCount = GetShardCount();
+            for (int i = 0; i < nShardCount; ++i)
             {
-                INITIALIZE_LOCK;
+                INITIALIZE_LOCK(asShards[i]);
             }
+            if (nShardCount > 1)
+                CPLDebug("GDAL", "Block cache split in %d shards",
+                         nShardCount);
             bSleepsForBockCacheDebug =
                 CPLTestBool(CPLGetConfigOption("GDAL_DEBUG_BLOCK_CACHE", "NO"));
 
@@ -432,17 +558,56 @@ int CPL_STDCALL GDALFlushCacheBlock()
 
 int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
 
+{
+    // To force one-time initialization of the shards if not already done
+    GDALGetCacheMax64();
+
+    // Start with the shard that uses the most memory, to keep the global
+    // eviction approximately fair between shards.
+    int iStartShard = 0;
+    for (int i = 1; i < nShardCount; ++i)
+    {
+        if (asShards[i].nCacheUsed > asShards[iStartShard].nCacheUsed)
+            iStartShard = i;
+    }
+
+    for (int iIter = 0; iIter < nShardCount; ++iIter)
+    {
+        GDALRasterBlockShard &oShard =
+            asShards[(iStartShard + iIter) % nShardCount];
+        if (FlushCacheBlockFromShard(oShard, bDirtyBlocksOnly, nullptr))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+/************************************************************************/
+/*                      FlushCacheBlockFromShard()                      */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+// If poOnlyDSState is not null, only blocks of the dataset that owns it are
+// considered.
+bool GDALRasterBlock::FlushCacheBlockFromShard(
+    GDALRasterBlockShard &oShard, int bDirtyBlocksOnly,
+    const GDALDatasetBlockCacheState *poOnlyDSState)
+
 {
     GDALRasterBlock *poTarget;
 
     {
-        INITIALIZE_LOCK;
-        poTarget = poOldest;
+        TAKE_LOCK(oShard);
+        poTarget = oShard.poOldest;
 
         while (poTarget != nullptr)
         {
-            if (!bDirtyBlocksOnly ||
-                (poTarget->GetDirty() && nDisableDirtyBlockFlushCounter == 0))
+            if (poOnlyDSState &&
+                poTarget->poDSCacheState.get() != poOnlyDSState)
+            {
+                // skip
+            }
+            else if (!bDirtyBlocksOnly || (poTarget->GetDirty() &&
+                                           nDisableDirtyBlockFlushCounter == 0))
             {
                 if (CPLAtomicCompareAndExchange(&(poTarget->nLockCount), 0, -1))
                     break;
@@ -451,7 +616,7 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
         }
 
         if (poTarget == nullptr)
-            return FALSE;
+            return false;
         if (bSleepsForBockCacheDebug)
         {
             // coverity[tainted_data]
@@ -463,6 +628,9 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
 
         poTarget->Detach_unlocked();
         poTarget->GetBand()->UnreferenceBlock(poTarget);
+        IncrementCacheCounter(poTarget->poBand->m_oBlockCacheCounters,
+                              poTarget->poDSCacheState.get(),
+                              &GDALBlockCacheCounters::nEvictions);
     }
 
     if (bSleepsForBockCacheDebug)
@@ -474,8 +642,15 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
             CPLSleep(dfDelay);
     }
 
+    CPLTraceSpan oSpan("gdal", "GDALRasterBlock::Evict");
+    if (oSpan.IsEnabled())
+        oSpan.AddArg("dirty", poTarget->GetDirty() ? 1 : 0);
+
     if (poTarget->GetDirty())
     {
+        IncrementCacheCounter(poTarget->poBand->m_oBlockCacheCounters,
+                              poTarget->poDSCacheState.get(),
+                              &GDALBlockCacheCounters::nDirtyFlushes);
         const CPLErr eErr = poTarget->Write();
         if (eErr != CE_None)
         {
@@ -484,13 +659,15 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
         }
     }
 
-    VSIFreeAligned(poTarget->pData);
+    VSIFreeLarge(poTarget->pData);
     poTarget->pData = nullptr;
     poTarget->GetBand()->AddBlockToFreeList(poTarget);
 
-    return TRUE;
+    return true;
 }
 
+//! @endcond
+
 /************************************************************************/
 /*                          FlushDirtyBlocks()                          */
 /************************************************************************/
@@ -584,7 +761,8 @@ GDALRasterBlock::GDALRasterBlock(GDALRasterBand *poBandIn, int nXOffIn,
                                  int nYOffIn)
     : eType(poBandIn->GetRasterDataType()), bDirty(false), nLockCount(0),
       nXOff(nXOffIn), nYOff(nYOffIn), nXSize(0), nYSize(0), pData(nullptr),
-      poBand(poBandIn), poNext(nullptr), poPrevious(nullptr), bMustDetach(true)
+      poBand(poBandIn), poNext(nullptr), poPrevious(nullptr), bMustDetach(true),
+      nShard(0)
 {
     CPLAssert(poBandIn != nullptr);
     poBand->GetBlockSize(&nXSize, &nYSize);
@@ -611,7 +789,7 @@ GDALRasterBlock::GDALRasterBlock(GDALRasterBand *poBandIn, int nXOffIn,
 GDALRasterBlock::GDALRasterBlock(int nXOffIn, int nYOffIn)
     : eType(GDT_Unknown), bDirty(false), nLockCount(0), nXOff(nXOffIn),
       nYOff(nYOffIn), nXSize(0), nYSize(0), pData(nullptr), poBand(nullptr),
-      poNext(nullptr), poPrevious(nullptr), bMustDetach(false)
+      poNext(nullptr), poPrevious(nullptr), bMustDetach(false), nShard(0)
 {
 }
 
@@ -657,7 +835,7 @@ GDALRasterBlock::~GDALRasterBlock()
 
     if (pData != nullptr)
     {
-        VSIFreeAligned(pData);
+        VSIFreeLarge(pData);
     }
 
     CPLAssert(nLockCount <= 0);
@@ -700,19 +878,20 @@ void GDALRasterBlock::Detach()
 {
     if (bMustDetach)
     {
-        TAKE_LOCK;
+        TAKE_LOCK(asShards[nShard]);
         Detach_unlocked();
     }
 }
 
 void GDALRasterBlock::Detach_unlocked()
 {
-    if (poOldest == this)
-        poOldest = poPrevious;
+    GDALRasterBlockShard &oShard = asShards[nShard];
+    if (oShard.poOldest == this)
+        oShard.poOldest = poPrevious;
 
-    if (poNewest == this)
+    if (oShard.poNewest == this)
     {
-        poNewest = poNext;
+        oShard.poNewest = poNext;
     }
 
     if (poPrevious != nullptr)
@@ -726,7 +905,15 @@ void GDALRasterBlock::Detach_unlocked()
     bMustDetach = false;
 
     if (pData)
-        nCacheUsed -= GetEffectiveBlockSize(GetBlockSize());
+    {
+        const auto nEffectiveBlockSize = GetEffectiveBlockSize(GetBlockSize());
+        oShard.nCacheUsed -= nEffectiveBlockSize;
+        nCacheUsed -= nEffectiveBlockSize;
+        IncrementCacheCounter(poBand->m_oBlockCacheCounters,
+                              poDSCacheState.get(),
+                              &GDALBlockCacheCounters::nUsedBytes,
+                              -static_cast<GIntBig>(nEffectiveBlockSize));
+    }
 
 #ifdef ENABLE_DEBUG
     Verify();
@@ -746,26 +933,31 @@ void GDALRasterBlock::Detach_unlocked()
 void GDALRasterBlock::Verify()
 
 {
-    TAKE_LOCK;
-
-    CPLAssert((poNewest == nullptr && poOldest == nullptr) ||
-              (poNewest != nullptr && poOldest != nullptr));
-
-    if (poNewest != nullptr)
+    for (int i = 0; i < nShardCount; ++i)
     {
-        CPLAssert(poNewest->poPrevious == nullptr);
-        CPLAssert(poOldest->poNext == nullptr);
+        GDALRasterBlockShard &oShard = asShards[i];
+        TAKE_LOCK(oShard);
 
-        GDALRasterBlock *poLast = nullptr;
-        for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
-             poBlock = poBlock->poNext)
+        CPLAssert((oShard.poNewest == nullptr && oShard.poOldest == nullptr) ||
+                  (oShard.poNewest != nullptr && oShard.poOldest != nullptr));
+
+        if (oShard.poNewest != nullptr)
         {
-            CPLAssert(poBlock->poPrevious == poLast);
+            CPLAssert(oShard.poNewest->poPrevious == nullptr);
+            CPLAssert(oShard.poOldest->poNext == nullptr);
 
-            poLast = poBlock;
-        }
+            GDALRasterBlock *poLast = nullptr;
+            for (GDALRasterBlock *poBlock = oShard.poNewest;
+                 poBlock != nullptr; poBlock = poBlock->poNext)
+            {
+                CPLAssert(poBlock->nShard == i);
+                CPLAssert(poBlock->poPrevious == poLast);
 
-        CPLAssert(poOldest == poLast);
+                poLast = poBlock;
+            }
+
+            CPLAssert(oShard.poOldest == poLast);
+        }
     }
 }
 
@@ -778,8 +970,8 @@ void GDALRasterBlock::Verify()
 #ifdef notdef
 void GDALRasterBlock::CheckNonOrphanedBlocks(GDALRasterBand *poBand)
 {
-    TAKE_LOCK;
-    for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
+    TAKE_LOCK(asShards[0]);
+    for (GDALRasterBlock *poBlock = asShards[0].poNewest; poBlock != nullptr;
          poBlock = poBlock->poNext)
     {
         if (poBlock->GetBand() == poBand)
@@ -852,32 +1044,36 @@ CPLErr GDALRasterBlock::Write()
 void GDALRasterBlock::Touch()
 
 {
+    GDALRasterBlockShard &oShard = asShards[nShard];
+
     // Can be safely tested outside the lock
-    if (poNewest == this)
+    if (oShard.poNewest == this)
         return;
 
-    TAKE_LOCK;
+    TAKE_LOCK(oShard);
     Touch_unlocked();
 }
 
 void GDALRasterBlock::Touch_unlocked()
 
 {
+    GDALRasterBlockShard &oShard = asShards[nShard];
+
     // Could happen even if tested in Touch() before taking the lock
     // Scenario would be :
     // 0. this is the second block (the one pointed by poNewest->poNext)
     // 1. Thread 1 calls Touch() and poNewest != this at that point
     // 2. Thread 2 detaches poNewest
     // 3. Thread 1 arrives here
-    if (poNewest == this)
+    if (oShard.poNewest == this)
         return;
 
     // We should not try to touch a block that has been detached.
     // If that happen, corruption has already occurred.
     CPLAssert(bMustDetach);
 
-    if (poOldest == this)
-        poOldest = this->poPrevious;
+    if (oShard.poOldest == this)
+        oShard.poOldest = this->poPrevious;
 
     if (poPrevious != nullptr)
         poPrevious->poNext = poNext;
@@ -886,19 +1082,19 @@ void GDALRasterBlock::Touch_unlocked()
         poNext->poPrevious = poPrevious;
 
     poPrevious = nullptr;
-    poNext = poNewest;
+    poNext = oShard.poNewest;
 
-    if (poNewest != nullptr)
+    if (oShard.poNewest != nullptr)
     {
-        CPLAssert(poNewest->poPrevious == nullptr);
-        poNewest->poPrevious = this;
+        CPLAssert(oShard.poNewest->poPrevious == nullptr);
+        oShard.poNewest->poPrevious = this;
     }
-    poNewest = this;
+    oShard.poNewest = this;
 
-    if (poOldest == nullptr)
+    if (oShard.poOldest == nullptr)
     {
         CPLAssert(poPrevious == nullptr && poNext == nullptr);
-        poOldest = this;
+        oShard.poOldest = this;
     }
 #ifdef ENABLE_DEBUG
     Verify();
@@ -927,32 +1123,100 @@ CPLErr GDALRasterBlock::Internalize()
 
     void *pNewData = nullptr;
 
-    // This call will initialize the hRBLock mutex. Other call places can
+    // This call will initialize the hRBLock mutexes. Other call places can
     // only be called if we have go through there.
     const GIntBig nCurCacheMax = GDALGetCacheMax64();
 
     // No risk of overflow as it is checked in GDALRasterBand::InitBlockInfo().
     const auto nSizeInBytes = GetBlockSize();
 
+    nShard = GetShardIndex(poBand, nXOff, nYOff);
+    GDALRasterBlockShard &oShard = asShards[nShard];
+
+    // A shard only evicts its own blocks when it is above its part of the
+    // budget and the global budget is exceeded. With a single shard, this
+    // is just nCacheUsed > nCurCacheMax.
+    const GIntBig nShardCacheMax = nCurCacheMax / nShardCount;
+    const auto IsShardOverBudget = [&oShard, nShardCacheMax, nCurCacheMax]()
+    {
+        return oShard.nCacheUsed > nShardCacheMax &&
+               nCacheUsed > nCurCacheMax;
+    };
+
+    // Per-dataset budget and priority (GDALDataset::SetCacheBudget())
+    GDALDataset *poThisDS = poBand->GetDataset();
+    poDSCacheState = poThisDS ? poThisDS->GetBlockCacheState() : nullptr;
+    GDALDatasetBlockCacheState *const poThisDSState = poDSCacheState.get();
+    const int nThisPriority =
+        poThisDSState ? poThisDSState->nPriority.load() : 0;
+    const auto IsDatasetOverBudget = [poThisDSState]()
+    {
+        if (!poThisDSState)
+            return false;
+        const GIntBig nBudget = poThisDSState->nBudget;
+        return nBudget > 0 && poThisDSState->nUsedBytes > nBudget;
+    };
+
     /* -------------------------------------------------------------------- */
     /*      Flush old blocks if we are nearing our memory limit.            */
     /* -------------------------------------------------------------------- */
     bool bFirstIter = true;
     bool bLoopAgain = false;
-    GDALDataset *poThisDS = poBand->GetDataset();
     do
     {
         bLoopAgain = false;
         GDALRasterBlock *apoBlocksToFree[64] = {nullptr};
         int nBlocksToFree = 0;
         {
-            TAKE_LOCK;
+            TAKE_LOCK(oShard);
 
             if (bFirstIter)
-                nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
-            GDALRasterBlock *poTarget = poOldest;
-            while (nCacheUsed > nCurCacheMax)
             {
+                const auto nEffectiveBlockSize =
+                    GetEffectiveBlockSize(nSizeInBytes);
+                oShard.nCacheUsed += nEffectiveBlockSize;
+                nCacheUsed += nEffectiveBlockSize;
+                IncrementCacheCounter(
+                    poBand->m_oBlockCacheCounters, poThisDSState,
+                    &GDALBlockCacheCounters::nUsedBytes,
+                    static_cast<GIntBig>(nEffectiveBlockSize));
+            }
+            GDALRasterBlock *poTarget = oShard.poOldest;
+            // When the dataset exceeds its own budget, only its blocks are
+            // evicted. Otherwise, blocks of datasets with a higher priority
+            // are only evicted if no other block can be.
+            bool bOnlyThisDataset = false;
+            bool bSkipHigherPriority = true;
+            bool bHasSkippedHigherPriority = false;
+            const auto IsEvictionCandidate =
+                [&bOnlyThisDataset, &bSkipHigherPriority,
+                 &bHasSkippedHigherPriority, poThisDSState,
+                 nThisPriority](const GDALRasterBlock *poBlock)
+            {
+                const auto poBlockDSState = poBlock->poDSCacheState.get();
+                if (bOnlyThisDataset)
+                    return poBlockDSState == poThisDSState;
+                if (bSkipHigherPriority && poBlockDSState &&
+                    poBlockDSState->nPriority > nThisPriority)
+                {
+                    bHasSkippedHigherPriority = true;
+                    return false;
+                }
+                return true;
+            };
+            while (true)
+            {
+                const bool bDatasetOverBudget = IsDatasetOverBudget();
+                if (!bDatasetOverBudget && !IsShardOverBudget())
+                    break;
+                if (bOnlyThisDataset != bDatasetOverBudget)
+                {
+                    // Restart from the oldest block when the set of
+                    // candidates changes.
+                    bOnlyThisDataset = bDatasetOverBudget;
+                    poTarget = oShard.poOldest;
+                }
+
                 GDALRasterBlock *poDirtyBlockOtherDataset = nullptr;
                 // In this first pass, only discard dirty blocks of this
                 // dataset. We do this to decrease significantly the likelihood
@@ -965,7 +1229,11 @@ CPLErr GDALRasterBlock::Internalize()
                 //    so gets the old value.
                 while (poTarget != nullptr)
                 {
-                    if (!poTarget->GetDirty())
+                    if (!IsEvictionCandidate(poTarget))
+                    {
+                        // skip
+                    }
+                    else if (!poTarget->GetDirty())
                     {
                         if (CPLAtomicCompareAndExchange(&(poTarget->nLockCount),
                                                         0, -1))
@@ -997,10 +1265,11 @@ CPLErr GDALRasterBlock::Internalize()
                     }
                     else
                     {
-                        poTarget = poOldest;
+                        poTarget = oShard.poOldest;
                         while (poTarget != nullptr)
                         {
-                            if (CPLAtomicCompareAndExchange(
+                            if (IsEvictionCandidate(poTarget) &&
+                                CPLAtomicCompareAndExchange(
                                     &(poTarget->nLockCount), 0, -1))
                             {
                                 CPLDebug(
@@ -1028,6 +1297,10 @@ CPLErr GDALRasterBlock::Internalize()
 
                     poTarget->Detach_unlocked();
                     poTarget->GetBand()->UnreferenceBlock(poTarget);
+                    IncrementCacheCounter(
+                        poTarget->poBand->m_oBlockCacheCounters,
+                        poTarget->poDSCacheState.get(),
+                        &GDALBlockCacheCounters::nEvictions);
 
                     apoBlocksToFree[nBlocksToFree++] = poTarget;
                     if (poTarget->GetDirty())
@@ -1035,17 +1308,27 @@ CPLErr GDALRasterBlock::Internalize()
                         // Only free one dirty block at a time so that
                         // other dirty blocks of other bands with the same
                         // coordinates can be found with TryGetLockedBlock()
-                        bLoopAgain = nCacheUsed > nCurCacheMax;
+                        bLoopAgain =
+                            IsShardOverBudget() || IsDatasetOverBudget();
                         break;
                     }
                     if (nBlocksToFree == 64)
                     {
-                        bLoopAgain = (nCacheUsed > nCurCacheMax);
+                        bLoopAgain =
+                            IsShardOverBudget() || IsDatasetOverBudget();
                         break;
                     }
 
                     poTarget = _poPrevious;
                 }
+                else if (!bOnlyThisDataset && bSkipHigherPriority &&
+                         bHasSkippedHigherPriority)
+                {
+                    // Second pass, considering blocks of datasets with a
+                    // higher priority.
+                    bSkipHigherPriority = false;
+                    poTarget = oShard.poOldest;
+                }
                 else
                 {
                     break;
@@ -1080,6 +1363,9 @@ CPLErr GDALRasterBlock::Internalize()
                         CPLSleep(dfDelay);
                 }
 
+                IncrementCacheCounter(poBlock->poBand->m_oBlockCacheCounters,
+                                      poBlock->poDSCacheState.get(),
+                                      &GDALBlockCacheCounters::nDirtyFlushes);
                 CPLErr eErr = poBlock->Write();
                 if (eErr != CE_None)
                 {
@@ -1097,7 +1383,7 @@ CPLErr GDALRasterBlock::Internalize()
             }
             else
             {
-                VSIFreeAligned(poBlock->pData);
+                VSIFreeLarge(poBlock->pData);
             }
             poBlock->pData = nullptr;
 
@@ -1105,9 +1391,33 @@ CPLErr GDALRasterBlock::Internalize()
         }
     } while (bLoopAgain);
 
+    if (nShardCount > 1)
+    {
+        // The blocks of the dataset are spread over all shards: evict
+        // them from the other shards if its budget is still exceeded.
+        for (int i = 1; i < nShardCount && IsDatasetOverBudget(); ++i)
+        {
+            auto &oOtherShard = asShards[(nShard + i) % nShardCount];
+            while (IsDatasetOverBudget() &&
+                   FlushCacheBlockFromShard(oOtherShard, FALSE, poThisDSState))
+            {
+                // go on
+            }
+        }
+
+        // The shard of this block is within its part of the budget, but the
+        // global budget is exceeded: evict blocks from the most loaded
+        // shards.
+        for (int i = 0; i < nShardCount && nCacheUsed > nCurCacheMax; ++i)
+        {
+            if (!FlushCacheBlock())
+                break;
+        }
+    }
+
     if (pNewData == nullptr)
     {
-        pNewData = VSI_MALLOC_ALIGNED_AUTO_VERBOSE(nSizeInBytes);
+        pNewData = VSI_MALLOC_LARGE_VERBOSE(nSizeInBytes);
         if (pNewData == nullptr)
         {
             return (CE_Failure);
@@ -1166,12 +1476,247 @@ void GDALRasterBlock::MarkClean()
 /*! @cond Doxygen_Suppress */
 void GDALRasterBlock::DestroyRBMutex()
 {
-    if (hRBLock != nullptr)
-        DESTROY_LOCK;
-    hRBLock = nullptr;
+    for (auto &oShard : asShards)
+    {
+        if (oShard.hRBLock != nullptr)
+            DESTROY_LOCK(oShard);
+        oShard.hRBLock = nullptr;
+    }
+}
+
+/************************************************************************/
+/*                           LogCacheAccess()                           */
+/************************************************************************/
+
+// Called by GDALRasterBand::GetLockedBlockRef() to count cache hits and
+// misses.
+void GDALRasterBlock::LogCacheAccess(GDALRasterBand *poBand, bool bHit)
+{
+    GDALDataset *poDS = poBand->GetDataset();
+    IncrementCacheCounter(poBand->m_oBlockCacheCounters,
+                          poDS ? poDS->GetBlockCacheState().get() : nullptr,
+                          bHit ? &GDALBlockCacheCounters::nHits
+                               : &GDALBlockCacheCounters::nMisses);
+    TraceCacheCounters();
+}
+
+/************************************************************************/
+/*                        CollectCacheContents()                        */
+/************************************************************************/
+
+// Call oFunc on each block of the cache, with the lock of its shard held.
+void GDALRasterBlock::CollectCacheContents(
+    const std::function<void(GDALRasterBlock *, GDALRasterBand *,
+                             const GDALBlockCacheCounters &)> &oFunc)
+{
+    for (int i = 0; i < nShardCount; ++i)
+    {
+        auto &oShard = asShards[i];
+        TAKE_LOCK(oShard);
+        for (GDALRasterBlock *poBlock = oShard.poNewest; poBlock;
+             poBlock = poBlock->poNext)
+        {
+            oFunc(poBlock, poBlock->poBand,
+                  poBlock->poBand->m_oBlockCacheCounters);
+        }
+    }
 }
 /*! @endcond */
 
+/************************************************************************/
+/*                       GDALGetCacheStatistics()                       */
+/************************************************************************/
+
+/**
+ * \brief Return global statistics on the use of the block cache.
+ *
+ * Those counters are accumulated since the start of the process. The number
+ * of bytes currently used is returned by GDALGetCacheUsed64().
+ *
+ * @param[out] pnHits Pointer to the number of block requests satisfied by
+ *                    the cache, or nullptr.
+ * @param[out] pnMisses Pointer to the number of block requests that required
+ *                      a new block to be allocated, or nullptr.
+ * @param[out] pnEvictions Pointer to the number of blocks evicted by the
+ *                         block cache to make room for other blocks, or
+ *                         nullptr.
+ * @param[out] pnDirtyFlushes Pointer to the number of evicted blocks that had
+ *                            to be written because they were dirty, or
+ *                            nullptr.
+ * @since GDAL 3.9
+ * @see GDALDataset::GetCacheStatistics(), GDALRasterBand::GetCacheStatistics()
+ */
+
+void GDALGetCacheStatistics(GIntBig *pnHits, GIntBig *pnMisses,
+                            GIntBig *pnEvictions, GIntBig *pnDirtyFlushes)
+{
+    if (pnHits)
+        *pnHits = gsCacheCounters.nHits.load();
+    if (pnMisses)
+        *pnMisses = gsCacheCounters.nMisses.load();
+    if (pnEvictions)
+        *pnEvictions = gsCacheCounters.nEvictions.load();
+    if (pnDirtyFlushes)
+        *pnDirtyFlushes = gsCacheCounters.nDirtyFlushes.load();
+}
+
+/************************************************************************/
+/*                GDALGetCacheContentsAsSerializedJSON()                */
+/************************************************************************/
+
+/**
+ * \brief Return a snapshot of the contents of the block cache, as a JSON
+ * serialized object.
+ *
+ * The object has the following members:
+ * <ul>
+ * <li>"cache_max" and "cache_used": the values of GDALGetCacheMax64() and
+ *     GDALGetCacheUsed64()</li>
+ * <li>"hits", "misses", "evictions" and "dirty_flushes": the global counters
+ *     of GDALGetCacheStatistics()</li>
+ * <li>"datasets": an array, sorted by decreasing cache usage, with an element
+ *     for each dataset that has blocks in the cache. Each element has a
+ *     "description" member, "block_count", "dirty_block_count" and
+ *     "used_bytes" members describing its blocks currently in the cache, the
+ *     counters of GDALDataset::GetCacheStatistics() (prefixed with "total_"
+ *     for the used bytes) and its "budget" and "priority", as well as a
+ *     "bands" array with the same information for each of its bands with
+ *     blocks in the cache, as returned by
+ *     GDALRasterBand::GetCacheStatistics().</li>
+ * </ul>
+ *
+ * @param papszOptions Unused. Should be NULL.
+ * @return a JSON serialized string to free with VSIFree().
+ * @since GDAL 3.9
+ */
+
+char *GDALGetCacheContentsAsSerializedJSON(CPL_UNUSED CSLConstList papszOptions)
+{
+    struct Counters
+    {
+        GIntBig nBlocks = 0;
+        GIntBig nDirtyBlocks = 0;
+        GIntBig nBytes = 0;
+        GIntBig nTotalBytes = 0;
+        GIntBig nHits = 0;
+        GIntBig nMisses = 0;
+        GIntBig nEvictions = 0;
+        GIntBig nDirtyFlushes = 0;
+
+        void Set(const GDALBlockCacheCounters &oCounters)
+        {
+            nTotalBytes = oCounters.nUsedBytes.load();
+            nHits = oCounters.nHits.load();
+            nMisses = oCounters.nMisses.load();
+            nEvictions = oCounters.nEvictions.load();
+            nDirtyFlushes = oCounters.nDirtyFlushes.load();
+        }
+
+        void AddTo(CPLJSONObject &oObj) const
+        {
+            oObj.Add("block_count", nBlocks);
+            oObj.Add("dirty_block_count", nDirtyBlocks);
+            oObj.Add("used_bytes", nBytes);
+            oObj.Add("total_used_bytes", nTotalBytes);
+            oObj.Add("hits", nHits);
+            oObj.Add("misses", nMisses);
+            oObj.Add("evictions", nEvictions);
+            oObj.Add("dirty_flushes", nDirtyFlushes);
+        }
+    };
+
+    struct DatasetContents
+    {
+        std::string osDescription{};
+        GIntBig nBudget = 0;
+        int nPriority = 0;
+        Counters oCounters{};
+        std::map<int, Counters> oMapBands{};
+    };
+
+    // The datasets and bands are only dereferenced while holding the lock
+    // of a shard in which they have blocks, which guarantees they are alive.
+    std::map<const GDALDataset *, DatasetContents> oMapDatasets;
+    GDALRasterBlock::CollectCacheContents(
+        [&oMapDatasets](GDALRasterBlock *poBlock, GDALRasterBand *poBand,
+                        const GDALBlockCacheCounters &oBandCounters)
+        {
+            const GDALDataset *poDS = poBand->GetDataset();
+            auto oIter = oMapDatasets.find(poDS);
+            if (oIter == oMapDatasets.end())
+            {
+                DatasetContents oContents;
+                if (poDS)
+                {
+                    oContents.osDescription = poDS->GetDescription();
+                    oContents.nBudget =
+                        poDS->GetCacheBudget(&oContents.nPriority);
+                    const auto &poState = poDS->GetBlockCacheState();
+                    if (poState)
+                        oContents.oCounters.Set(*poState);
+                }
+                oIter = oMapDatasets.emplace(poDS, std::move(oContents)).first;
+            }
+            auto &oDSContents = oIter->second;
+            auto oBandIter = oDSContents.oMapBands.find(poBand->GetBand());
+            if (oBandIter == oDSContents.oMapBands.end())
+            {
+                Counters oBandContents;
+                oBandContents.Set(oBandCounters);
+                oBandIter = oDSContents.oMapBands
+                                .emplace(poBand->GetBand(), oBandContents)
+                                .first;
+            }
+            const GIntBig nBytes =
+                static_cast<GIntBig>(GetEffectiveBlockSize(
+                    poBlock->GetBlockSize()));
+            for (Counters *poCounters :
+                 {&oDSContents.oCounters, &oBandIter->second})
+            {
+                poCounters->nBlocks++;
+                if (poBlock->GetDirty())
+                    poCounters->nDirtyBlocks++;
+                poCounters->nBytes += nBytes;
+            }
+        });
+
+    std::vector<const DatasetContents *> apoDatasets;
+    for (const auto &oIter : oMapDatasets)
+        apoDatasets.push_back(&oIter.second);
+    std::sort(apoDatasets.begin(), apoDatasets.end(),
+              [](const DatasetContents *a, const DatasetContents *b)
+              { return a->oCounters.nBytes > b->oCounters.nBytes; });
+
+    CPLJSONObject oRoot;
+    oRoot.Add("cache_max", GDALGetCacheMax64());
+    oRoot.Add("cache_used", GDALGetCacheUsed64());
+    oRoot.Add("hits", gsCacheCounters.nHits.load());
+    oRoot.Add("misses", gsCacheCounters.nMisses.load());
+    oRoot.Add("evictions", gsCacheCounters.nEvictions.load());
+    oRoot.Add("dirty_flushes", gsCacheCounters.nDirtyFlushes.load());
+    CPLJSONArray oDatasets;
+    for (const auto *poContents : apoDatasets)
+    {
+        CPLJSONObject oDS;
+        oDS.Add("description", poContents->osDescription);
+        poContents->oCounters.AddTo(oDS);
+        oDS.Add("budget", poContents->nBudget);
+        oDS.Add("priority", poContents->nPriority);
+        CPLJSONArray oBands;
+        for (const auto &oIter : poContents->oMapBands)
+        {
+            CPLJSONObject oBand;
+            oBand.Add("band", oIter.first);
+            oIter.second.AddTo(oBand);
+            oBands.Add(oBand);
+        }
+        oDS.Add("bands", oBands);
+        oDatasets.Add(oDS);
+    }
+    oRoot.Add("datasets", oDatasets);
+    return CPLStrdup(oRoot.Format(CPLJSONObject::PrettyFormat::Pretty).c_str());
+}
+
 /************************************************************************/
 /*                              TakeLock()                              */
 /************************************************************************/
@@ -1246,16 +1791,78 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 #endif
 
     // Wait for the block for having been unreferenced.
-    TAKE_LOCK;
+    TAKE_LOCK(asShards[nShard]);
 
     return FALSE;
 }
 
+/************************************************************************/
+/*                          GDALPinnedBlock()                           */
+/************************************************************************/
+
+/** Construct a pinned block from a block whose lock has already been acquired
+ * on behalf of the caller, typically by GDALRasterBand::GetLockedBlockRef().
+ * The lock will be released by this object.
+ *
+ * @param poLockedBlock locked block, or nullptr.
+ * @since GDAL 3.9
+ */
+GDALPinnedBlock::GDALPinnedBlock(GDALRasterBlock *poLockedBlock)
+    : m_poBlock(poLockedBlock)
+{
+}
+
+/** Move constructor. */
+GDALPinnedBlock::GDALPinnedBlock(GDALPinnedBlock &&other) noexcept
+    : m_poBlock(other.m_poBlock)
+{
+    other.m_poBlock = nullptr;
+}
+
+/** Move assignment. */
+GDALPinnedBlock &GDALPinnedBlock::operator=(GDALPinnedBlock &&other) noexcept
+{
+    if (this != &other)
+    {
+        Release();
+        m_poBlock = other.m_poBlock;
+        other.m_poBlock = nullptr;
+    }
+    return *this;
+}
+
+/************************************************************************/
+/*                          ~GDALPinnedBlock()                          */
+/************************************************************************/
+
+/** Destructor. Releases the block. */
+GDALPinnedBlock::~GDALPinnedBlock()
+{
+    Release();
+}
+
+/************************************************************************/
+/*                              Release()                               */
+/************************************************************************/
+
+/** Release the lock on the block, which may then be evicted from the block
+ * cache. The data pointer must no longer be used after that.
+ * @since GDAL 3.9
+ */
+void GDALPinnedBlock::Release()
+{
+    if (m_poBlock)
+    {
+        m_poBlock->DropLock();
+        m_poBlock = nullptr;
+    }
+}
+
 #if 0
 void GDALRasterBlock::DumpAll()
 {
     int iBlock = 0;
-    for( GDALRasterBlock *poBlock = poNewest;
+    for( GDALRasterBlock *poBlock = asShards[0].poNewest;
          poBlock != nullptr;
          poBlock = poBlock->poNext )
     {
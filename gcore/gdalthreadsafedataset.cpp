@@ -0,0 +1,855 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  Dataset handle that can be used concurrently by several threads
+ *           for read-only access (GDAL_OF_THREAD_SAFE open flag)
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "gdal_priv.h"
+#include "gdal_proxy.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "cpl_error.h"
+#include "cpl_multiproc.h"
+#include "cpl_string.h"
+
+/** A GDALThreadSafeDataset wraps a dataset opened in read-only mode, so that
+    RasterIO() requests can be issued on it, or on its bands, concurrently
+    from several threads.
+
+    All requests that are not reading pixels are forwarded to the wrapped
+    (primary) dataset, while holding a mutex.
+
+    Pixel reads go through the block cache of the bands of the
+    GDALThreadSafeDataset, which is shared by all threads. Cache hits are
+    served concurrently. On cache misses, the block is read from the primary
+    dataset if it is not in use by another thread, or otherwise from an
+    additional handle on the same dataset, that is opened lazily the first
+    time more than one thread needs to read blocks at the same time. The
+    number of those additional handles is bounded by the number of CPUs.
+*/
+
+class GDALThreadSafeRasterBand;
+
+/* ******************************************************************** */
+/*                        GDALThreadSafeDataset                         */
+/* ******************************************************************** */
+
+class GDALThreadSafeDataset final : public GDALProxyDataset
+{
+    friend class GDALThreadSafeRasterBand;
+
+    GDALDataset *m_poPrimaryDS = nullptr;
+    mutable std::recursive_mutex m_oPrimaryMutex{};
+
+    // Parameters needed to open additional handles.
+    const std::string m_osFilename;
+    const unsigned int m_nHandleOpenFlags;
+    const CPLStringList m_aosAllowedDrivers;
+    const CPLStringList m_aosOpenOptions;
+    const CPLStringList m_aosSiblingFiles;
+
+    std::mutex m_oHandlesMutex{};
+    std::vector<GDALDatasetUniquePtr> m_apoFreeHandles{};
+    int m_nExtraHandles = 0;
+    int m_nMaxExtraHandles = 0;
+
+    GDALDataset *AcquireHandle();
+    void ReleaseHandle(GDALDataset *poDS);
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALThreadSafeDataset)
+
+  protected:
+    GDALDataset *RefUnderlyingDataset() const override;
+    void
+    UnrefUnderlyingDataset(GDALDataset *poUnderlyingDataset) const override;
+
+    CPLErr IBuildOverviews(const char *, int, const int *, int, const int *,
+                           GDALProgressFunc, void *,
+                           CSLConstList papszOptions) override;
+    CPLErr IRasterIO(GDALRWFlag, int, int, int, int, void *, int, int,
+                     GDALDataType, int, int *, GSpacing, GSpacing, GSpacing,
+                     GDALRasterIOExtraArg *psExtraArg) override;
+
+  public:
+    GDALThreadSafeDataset(GDALDataset *poPrimaryDS, const char *pszFilename,
+                          unsigned int nOpenFlagsIn,
+                          CSLConstList papszAllowedDrivers,
+                          CSLConstList papszOpenOptionsIn,
+                          CSLConstList papszSiblingFiles);
+    ~GDALThreadSafeDataset() override;
+
+    CPLErr FlushCache(bool bAtClosing) override;
+};
+
+/* ******************************************************************** */
+/*                       GDALThreadSafeRasterBand                       */
+/* ******************************************************************** */
+
+class GDALThreadSafeRasterBand final : public GDALProxyRasterBand
+{
+    GDALThreadSafeDataset *m_poTSDS = nullptr;
+
+    // How to get the corresponding band from a handle: band number, followed
+    // by a sequence of overview indices, or -1 for the mask band.
+    const int m_nBaseBand;
+    const std::vector<int> m_anPath;
+
+    // Blocks being read by a thread
+    std::mutex m_oBlockMutex{};
+    std::condition_variable m_oBlockCV{};
+    std::set<std::pair<int, int>> m_oSetBlocksInProgress{};
+
+    std::mutex m_oChildrenMutex{};
+    std::vector<std::unique_ptr<GDALThreadSafeRasterBand>> m_apoOverviews{};
+    std::unique_ptr<GDALThreadSafeRasterBand> m_poMaskBand{};
+
+    GDALRasterBand *GetBandFromHandle(GDALDataset *poHandle) const;
+    GDALRasterBlock *GetLockedBlock(int nXBlockOff, int nYBlockOff);
+    bool LockBlocks(int nXOff, int nYOff, int nXSize, int nYSize,
+                    std::vector<GDALRasterBlock *> &apoBlocks);
+    static void UnlockBlocks(std::vector<GDALRasterBlock *> &apoBlocks);
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALThreadSafeRasterBand)
+
+  protected:
+    GDALRasterBand *
+    RefUnderlyingRasterBand(bool bForceOpen = true) const override;
+    void UnrefUnderlyingRasterBand(
+        GDALRasterBand *poUnderlyingRasterBand) const override;
+
+    CPLErr IReadBlock(int, int, void *) override;
+    CPLErr IWriteBlock(int, int, void *) override;
+    CPLErr IRasterIO(GDALRWFlag, int, int, int, int, void *, int, int,
+                     GDALDataType, GSpacing, GSpacing,
+                     GDALRasterIOExtraArg *psExtraArg) override;
+
+  public:
+    GDALThreadSafeRasterBand(GDALThreadSafeDataset *poTSDS,
+                             GDALRasterBand *poPrimaryBand, int nBaseBand,
+                             std::vector<int> &&anPath);
+
+    CPLErr FlushCache(bool bAtClosing) override;
+    CPLErr Fill(double dfRealValue, double dfImaginaryValue = 0) override;
+
+    GDALRasterBand *GetOverview(int) override;
+    GDALRasterBand *GetRasterSampleOverview(GUIntBig) override;
+    GDALRasterBand *GetMaskBand() override;
+    CPLErr BuildOverviews(const char *, int, const int *, GDALProgressFunc,
+                          void *, CSLConstList papszOptions) override;
+    CPLVirtualMem *GetVirtualMemAuto(GDALRWFlag eRWFlag, int *pnPixelSpace,
+                                     GIntBig *pnLineSpace,
+                                     char **papszOptions) override;
+};
+
+/************************************************************************/
+/*                       GDALThreadSafeDataset()                        */
+/************************************************************************/
+
+GDALThreadSafeDataset::GDALThreadSafeDataset(
+    GDALDataset *poPrimaryDS, const char *pszFilename,
+    unsigned int nOpenFlagsIn, CSLConstList papszAllowedDrivers,
+    CSLConstList papszOpenOptionsIn, CSLConstList papszSiblingFiles)
+    : m_poPrimaryDS(poPrimaryDS), m_osFilename(pszFilename),
+      m_nHandleOpenFlags((nOpenFlagsIn &
+                          ~(GDAL_OF_THREAD_SAFE | GDAL_OF_SHARED |
+                            GDAL_OF_VERBOSE_ERROR)) |
+                         GDAL_OF_INTERNAL),
+      m_aosAllowedDrivers(CSLDuplicate(papszAllowedDrivers)),
+      m_aosOpenOptions(CSLDuplicate(papszOpenOptionsIn)),
+      m_aosSiblingFiles(CSLDuplicate(papszSiblingFiles)),
+      m_nMaxExtraHandles(std::max(0, CPLGetNumCPUs() - 1))
+{
+    SetDescription(poPrimaryDS->GetDescription());
+    nRasterXSize = poPrimaryDS->GetRasterXSize();
+    nRasterYSize = poPrimaryDS->GetRasterYSize();
+    eAccess = GA_ReadOnly;
+    nOpenFlags = nOpenFlagsIn;
+
+    for (int i = 1; i <= poPrimaryDS->GetRasterCount(); ++i)
+    {
+        SetBand(i, new GDALThreadSafeRasterBand(
+                       this, poPrimaryDS->GetRasterBand(i), i, {}));
+    }
+}
+
+/************************************************************************/
+/*                       ~GDALThreadSafeDataset()                       */
+/************************************************************************/
+
+GDALThreadSafeDataset::~GDALThreadSafeDataset()
+{
+    GDALThreadSafeDataset::FlushCache(true);
+
+    // Bands must be destroyed before the handles they refer to.
+    for (int i = 0; i < nBands; ++i)
+        delete papoBands[i];
+    CPLFree(papoBands);
+    papoBands = nullptr;
+    nBands = 0;
+
+    m_apoFreeHandles.clear();
+    m_poPrimaryDS->ReleaseRef();
+}
+
+/************************************************************************/
+/*                        RefUnderlyingDataset()                        */
+/************************************************************************/
+
+GDALDataset *GDALThreadSafeDataset::RefUnderlyingDataset() const
+{
+    m_oPrimaryMutex.lock();
+    return m_poPrimaryDS;
+}
+
+/************************************************************************/
+/*                       UnrefUnderlyingDataset()                       */
+/************************************************************************/
+
+void GDALThreadSafeDataset::UnrefUnderlyingDataset(
+    GDALDataset * /* poUnderlyingDataset */) const
+{
+    m_oPrimaryMutex.unlock();
+}
+
+/************************************************************************/
+/*                           AcquireHandle()                            */
+/************************************************************************/
+
+// Returns a handle on the dataset that is not used by another thread, to
+// read blocks from it. Must be released with ReleaseHandle().
+GDALDataset *GDALThreadSafeDataset::AcquireHandle()
+{
+    if (m_oPrimaryMutex.try_lock())
+        return m_poPrimaryDS;
+
+    bool bOpenNewHandle = false;
+    {
+        std::lock_guard<std::mutex> oLock(m_oHandlesMutex);
+        if (!m_apoFreeHandles.empty())
+        {
+            GDALDataset *poDS = m_apoFreeHandles.back().release();
+            m_apoFreeHandles.pop_back();
+            return poDS;
+        }
+        if (m_nExtraHandles < m_nMaxExtraHandles)
+        {
+            ++m_nExtraHandles;
+            bOpenNewHandle = true;
+        }
+    }
+    if (!bOpenNewHandle)
+    {
+        // Wait for the primary dataset to be available
+        m_oPrimaryMutex.lock();
+        return m_poPrimaryDS;
+    }
+
+    auto poDS = GDALDataset::Open(
+        m_osFilename.c_str(), m_nHandleOpenFlags, m_aosAllowedDrivers.List(),
+        m_aosOpenOptions.List(), m_aosSiblingFiles.List());
+    if (poDS && (poDS->GetRasterXSize() != nRasterXSize ||
+                 poDS->GetRasterYSize() != nRasterYSize ||
+                 poDS->GetRasterCount() != nBands))
+    {
+        CPLDebug("GDAL",
+                 "Additional handle on %s does not have the same "
+                 "characteristics as the initial one",
+                 m_osFilename.c_str());
+        GDALClose(poDS);
+        poDS = nullptr;
+    }
+    if (poDS)
+        return poDS;
+
+    {
+        // Do not try again to open additional handles.
+        std::lock_guard<std::mutex> oLock(m_oHandlesMutex);
+        --m_nExtraHandles;
+        m_nMaxExtraHandles = m_nExtraHandles;
+    }
+    m_oPrimaryMutex.lock();
+    return m_poPrimaryDS;
+}
+
+/************************************************************************/
+/*                           ReleaseHandle()                            */
+/************************************************************************/
+
+void GDALThreadSafeDataset::ReleaseHandle(GDALDataset *poDS)
+{
+    if (poDS == m_poPrimaryDS)
+    {
+        m_oPrimaryMutex.unlock();
+    }
+    else
+    {
+        std::lock_guard<std::mutex> oLock(m_oHandlesMutex);
+        m_apoFreeHandles.emplace_back(poDS);
+    }
+}
+
+/************************************************************************/
+/*                             FlushCache()                             */
+/************************************************************************/
+
+CPLErr GDALThreadSafeDataset::FlushCache(bool bAtClosing)
+{
+    // Drop blocks cached in the bands of this dataset (there cannot be
+    // dirty blocks), and forward to the primary dataset.
+    CPLErr eErr = GDALDataset::FlushCache(bAtClosing);
+    std::lock_guard<std::recursive_mutex> oLock(m_oPrimaryMutex);
+    if (m_poPrimaryDS->FlushCache(bAtClosing) != CE_None)
+        eErr = CE_Failure;
+    return eErr;
+}
+
+/************************************************************************/
+/*                          IBuildOverviews()                           */
+/************************************************************************/
+
+CPLErr GDALThreadSafeDataset::IBuildOverviews(const char *, int, const int *,
+                                              int, const int *,
+                                              GDALProgressFunc, void *,
+                                              CSLConstList)
+{
+    ReportError(CE_Failure, CPLE_NotSupported,
+                "BuildOverviews() not supported on a dataset opened with "
+                "GDAL_OF_THREAD_SAFE");
+    return CE_Failure;
+}
+
+/************************************************************************/
+/*                             IRasterIO()                              */
+/************************************************************************/
+
+CPLErr GDALThreadSafeDataset::IRasterIO(
+    GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
+    void *pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+    int nBandCount, int *panBandMap, GSpacing nPixelSpace, GSpacing nLineSpace,
+    GSpacing nBandSpace, GDALRasterIOExtraArg *psExtraArg)
+{
+    if (eRWFlag != GF_Read)
+    {
+        ReportError(CE_Failure, CPLE_NotSupported,
+                    "Write operation not supported on a dataset opened with "
+                    "GDAL_OF_THREAD_SAFE");
+        return CE_Failure;
+    }
+
+    // Do not use GDALDataset::IRasterIO() that might use BlockBasedRasterIO()
+    // which is not safe for concurrent use.
+    return BandBasedRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize, pData,
+                             nBufXSize, nBufYSize, eBufType, nBandCount,
+                             panBandMap, nPixelSpace, nLineSpace, nBandSpace,
+                             psExtraArg);
+}
+
+/************************************************************************/
+/*                      GDALThreadSafeRasterBand()                      */
+/************************************************************************/
+
+GDALThreadSafeRasterBand::GDALThreadSafeRasterBand(
+    GDALThreadSafeDataset *poTSDS, GDALRasterBand *poPrimaryBand,
+    int nBaseBand, std::vector<int> &&anPath)
+    : m_poTSDS(poTSDS), m_nBaseBand(nBaseBand), m_anPath(std::move(anPath))
+{
+    // Overview bands are stand-alone bands, mask bands belong to the dataset
+    // of their parent band, like GDALNoDataMaskBand does.
+    const bool bIsOverview = !m_anPath.empty() && m_anPath.back() >= 0;
+    poDS = bIsOverview ? nullptr : poTSDS;
+    nBand = m_anPath.empty() ? nBaseBand : 0;
+    eAccess = GA_ReadOnly;
+    nRasterXSize = poPrimaryBand->GetXSize();
+    nRasterYSize = poPrimaryBand->GetYSize();
+    eDataType = poPrimaryBand->GetRasterDataType();
+    poPrimaryBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+
+    // Initialize the block cache now, so that it is not lazily done by
+    // concurrent threads.
+    InitBlockInfo();
+}
+
+/************************************************************************/
+/*                         GetBandFromHandle()                          */
+/************************************************************************/
+
+GDALRasterBand *
+GDALThreadSafeRasterBand::GetBandFromHandle(GDALDataset *poHandle) const
+{
+    GDALRasterBand *poBand = poHandle->GetRasterBand(m_nBaseBand);
+    for (int nStep : m_anPath)
+    {
+        if (poBand == nullptr)
+            break;
+        poBand = nStep < 0 ? poBand->GetMaskBand() : poBand->GetOverview(nStep);
+    }
+    if (poBand && (poBand->GetXSize() != nRasterXSize ||
+                   poBand->GetYSize() != nRasterYSize ||
+                   poBand->GetRasterDataType() != eDataType))
+    {
+        poBand = nullptr;
+    }
+    if (poBand == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot find band corresponding to thread-safe band");
+    }
+    return poBand;
+}
+
+/************************************************************************/
+/*                      RefUnderlyingRasterBand()                       */
+/************************************************************************/
+
+GDALRasterBand *
+GDALThreadSafeRasterBand::RefUnderlyingRasterBand(bool /* bForceOpen */) const
+{
+    GDALDataset *poPrimaryDS = m_poTSDS->RefUnderlyingDataset();
+    GDALRasterBand *poBand = GetBandFromHandle(poPrimaryDS);
+    if (poBand == nullptr)
+        m_poTSDS->UnrefUnderlyingDataset(poPrimaryDS);
+    return poBand;
+}
+
+/************************************************************************/
+/*                     UnrefUnderlyingRasterBand()                      */
+/************************************************************************/
+
+void GDALThreadSafeRasterBand::UnrefUnderlyingRasterBand(
+    GDALRasterBand *poUnderlyingRasterBand) const
+{
+    if (poUnderlyingRasterBand)
+        m_poTSDS->UnrefUnderlyingDataset(m_poTSDS->m_poPrimaryDS);
+}
+
+/************************************************************************/
+/*                             IReadBlock()                             */
+/************************************************************************/
+
+CPLErr GDALThreadSafeRasterBand::IReadBlock(int nXBlockOff, int nYBlockOff,
+                                            void *pImage)
+{
+    GDALDataset *poHandle = m_poTSDS->AcquireHandle();
+    GDALRasterBand *poBand = GetBandFromHandle(poHandle);
+    CPLErr eErr = CE_Failure;
+    if (poBand)
+    {
+        int nXValid = 0;
+        int nYValid = 0;
+        GetActualBlockSize(nXBlockOff, nYBlockOff, &nXValid, &nYValid);
+        const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
+        eErr = poBand->RasterIO(
+            GF_Read, nXBlockOff * nBlockXSize, nYBlockOff * nBlockYSize,
+            nXValid, nYValid, pImage, nXValid, nYValid, eDataType, nDTSize,
+            static_cast<GSpacing>(nDTSize) * nBlockXSize, nullptr);
+
+        // The block is now cached in this band: no need to keep it in the
+        // block cache of the band of the handle as well.
+        int nHandleBlockXSize = 0;
+        int nHandleBlockYSize = 0;
+        poBand->GetBlockSize(&nHandleBlockXSize, &nHandleBlockYSize);
+        if (nHandleBlockXSize == nBlockXSize &&
+            nHandleBlockYSize == nBlockYSize)
+        {
+            CPL_IGNORE_RET_VAL(poBand->FlushBlock(nXBlockOff, nYBlockOff));
+        }
+    }
+    m_poTSDS->ReleaseHandle(poHandle);
+    return eErr;
+}
+
+/************************************************************************/
+/*                            IWriteBlock()                             */
+/************************************************************************/
+
+CPLErr GDALThreadSafeRasterBand::IWriteBlock(int, int, void *)
+{
+    ReportError(CE_Failure, CPLE_NotSupported,
+                "Write operation not supported on a dataset opened with "
+                "GDAL_OF_THREAD_SAFE");
+    return CE_Failure;
+}
+
+/************************************************************************/
+/*                           GetLockedBlock()                           */
+/************************************************************************/
+
+// Thread-safe equivalent of GetLockedBlockRef()
+GDALRasterBlock *GDALThreadSafeRasterBand::GetLockedBlock(int nXBlockOff,
+                                                          int nYBlockOff)
+{
+    const auto oKey = std::make_pair(nXBlockOff, nYBlockOff);
+    while (true)
+    {
+        GDALRasterBlock *poBlock = TryGetLockedBlockRef(nXBlockOff, nYBlockOff);
+        if (poBlock)
+            return poBlock;
+
+        std::unique_lock<std::mutex> oLock(m_oBlockMutex);
+        if (m_oSetBlocksInProgress.find(oKey) != m_oSetBlocksInProgress.end())
+        {
+            // Another thread is reading it. Wait for it and retry.
+            m_oBlockCV.wait(oLock,
+                            [this, &oKey]() {
+                                return m_oSetBlocksInProgress.find(oKey) ==
+                                       m_oSetBlocksInProgress.end();
+                            });
+            continue;
+        }
+        poBlock = TryGetLockedBlockRef(nXBlockOff, nYBlockOff);
+        if (poBlock)
+            return poBlock;
+        m_oSetBlocksInProgress.insert(oKey);
+        oLock.unlock();
+
+        // Read the block outside of any lock, so that several blocks can be
+        // decoded at the same time.
+        const size_t nBlockSize =
+            static_cast<size_t>(nBlockXSize) * nBlockYSize *
+            GDALGetDataTypeSizeBytes(eDataType);
+        void *pabyData = VSI_CALLOC_VERBOSE(1, nBlockSize);
+        const CPLErr eErr = pabyData
+                                ? IReadBlock(nXBlockOff, nYBlockOff, pabyData)
+                                : CE_Failure;
+
+        oLock.lock();
+        if (eErr == CE_None)
+        {
+            // Creating and adopting blocks in the band block cache must be
+            // serialized.
+            poBlock = GetLockedBlockRef(nXBlockOff, nYBlockOff,
+                                        /* bJustInitialize = */ TRUE);
+            if (poBlock)
+                memcpy(poBlock->GetDataRef(), pabyData, nBlockSize);
+        }
+        m_oSetBlocksInProgress.erase(oKey);
+        oLock.unlock();
+        m_oBlockCV.notify_all();
+        VSIFree(pabyData);
+
+        if (eErr != CE_None)
+        {
+            ReportError(CE_Failure, CPLE_AppDefined,
+                        "IReadBlock failed at X offset %d, Y offset %d",
+                        nXBlockOff, nYBlockOff);
+        }
+        return poBlock;
+    }
+}
+
+/************************************************************************/
+/*                             LockBlocks()                             */
+/************************************************************************/
+
+// Loads in the block cache, and lock, all blocks intersecting a window.
+bool GDALThreadSafeRasterBand::LockBlocks(
+    int nXOff, int nYOff, int nXSize, int nYSize,
+    std::vector<GDALRasterBlock *> &apoBlocks)
+{
+    const int nXBlockStart = nXOff / nBlockXSize;
+    const int nXBlockEnd = (nXOff + nXSize - 1) / nBlockXSize;
+    const int nYBlockStart = nYOff / nBlockYSize;
+    const int nYBlockEnd = (nYOff + nYSize - 1) / nBlockYSize;
+    for (int iYBlock = nYBlockStart; iYBlock <= nYBlockEnd; ++iYBlock)
+    {
+        for (int iXBlock = nXBlockStart; iXBlock <= nXBlockEnd; ++iXBlock)
+        {
+            GDALRasterBlock *poBlock = GetLockedBlock(iXBlock, iYBlock);
+            if (poBlock == nullptr)
+            {
+                UnlockBlocks(apoBlocks);
+                return false;
+            }
+            apoBlocks.push_back(poBlock);
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                            UnlockBlocks()                            */
+/************************************************************************/
+
+void GDALThreadSafeRasterBand::UnlockBlocks(
+    std::vector<GDALRasterBlock *> &apoBlocks)
+{
+    for (GDALRasterBlock *poBlock : apoBlocks)
+        poBlock->DropLock();
+    apoBlocks.clear();
+}
+
+/************************************************************************/
+/*                             IRasterIO()                              */
+/************************************************************************/
+
+CPLErr GDALThreadSafeRasterBand::IRasterIO(
+    GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
+    void *pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+    GSpacing nPixelSpace, GSpacing nLineSpace,
+    GDALRasterIOExtraArg *psExtraArg)
+{
+    if (eRWFlag != GF_Read)
+    {
+        ReportError(CE_Failure, CPLE_NotSupported,
+                    "Write operation not supported on a dataset opened with "
+                    "GDAL_OF_THREAD_SAFE");
+        return CE_Failure;
+    }
+
+    // GDALRasterBand::IRasterIO() is safe for concurrent use as long as
+    // all the blocks it needs are already in the block cache: make sure of
+    // that beforehand.
+    std::vector<GDALRasterBlock *> apoBlocks;
+    if (nXSize == nBufXSize && nYSize == nBufYSize)
+    {
+        // Proceed by rows of blocks, to limit the number of locked blocks
+        GDALRasterIOExtraArg sExtraArg;
+        INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+        const int nYBlockStart = nYOff / nBlockYSize;
+        const int nYBlockEnd = (nYOff + nYSize - 1) / nBlockYSize;
+        for (int iYBlock = nYBlockStart; iYBlock <= nYBlockEnd; ++iYBlock)
+        {
+            const int nChunkYOff = std::max(nYOff, iYBlock * nBlockYSize);
+            const int nChunkYSize =
+                std::min(nYOff + nYSize, (iYBlock + 1) * nBlockYSize) -
+                nChunkYOff;
+            if (!LockBlocks(nXOff, nChunkYOff, nXSize, nChunkYSize, apoBlocks))
+                return CE_Failure;
+            const CPLErr eErr = GDALRasterBand::IRasterIO(
+                GF_Read, nXOff, nChunkYOff, nXSize, nChunkYSize,
+                static_cast<GByte *>(pData) + (nChunkYOff - nYOff) * nLineSpace,
+                nBufXSize, nChunkYSize, eBufType, nPixelSpace, nLineSpace,
+                &sExtraArg);
+            UnlockBlocks(apoBlocks);
+            if (eErr != CE_None)
+                return eErr;
+            if (psExtraArg->pfnProgress &&
+                !psExtraArg->pfnProgress(
+                    1.0 * (nChunkYOff + nChunkYSize - nYOff) / nYSize, "",
+                    psExtraArg->pProgressData))
+            {
+                ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                return CE_Failure;
+            }
+        }
+        return CE_None;
+    }
+
+    int bTried = FALSE;
+    const CPLErr eErr = TryOverviewRasterIO(
+        eRWFlag, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize, nBufYSize,
+        eBufType, nPixelSpace, nLineSpace, psExtraArg, &bTried);
+    if (bTried)
+        return eErr;
+
+    // Resampled request: lock all the blocks of the window, unless that would
+    // take a significant part of the block cache, in which case the request
+    // is serialized on the primary dataset.
+    const GIntBig nBlockCount =
+        static_cast<GIntBig>((nXOff + nXSize - 1) / nBlockXSize -
+                             nXOff / nBlockXSize + 1) *
+        ((nYOff + nYSize - 1) / nBlockYSize - nYOff / nBlockYSize + 1);
+    if (nBlockCount * nBlockXSize * nBlockYSize *
+            GDALGetDataTypeSizeBytes(eDataType) <=
+        GDALGetCacheMax64() / 4)
+    {
+        if (!LockBlocks(nXOff, nYOff, nXSize, nYSize, apoBlocks))
+            return CE_Failure;
+        const CPLErr eErr2 = GDALRasterBand::IRasterIO(
+            GF_Read, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize, nBufYSize,
+            eBufType, nPixelSpace, nLineSpace, psExtraArg);
+        UnlockBlocks(apoBlocks);
+        return eErr2;
+    }
+
+    return GDALProxyRasterBand::IRasterIO(
+        GF_Read, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize, nBufYSize,
+        eBufType, nPixelSpace, nLineSpace, psExtraArg);
+}
+
+/************************************************************************/
+/*                             FlushCache()                             */
+/************************************************************************/
+
+CPLErr GDALThreadSafeRasterBand::FlushCache(bool bAtClosing)
+{
+    CPLErr eErr = GDALRasterBand::FlushCache(bAtClosing);
+    std::lock_guard<std::mutex> oLock(m_oChildrenMutex);
+    for (auto &poOvrBand : m_apoOverviews)
+    {
+        if (poOvrBand && poOvrBand->FlushCache(bAtClosing) != CE_None)
+            eErr = CE_Failure;
+    }
+    if (m_poMaskBand && m_poMaskBand->FlushCache(bAtClosing) != CE_None)
+        eErr = CE_Failure;
+    return eErr;
+}
+
+/************************************************************************/
+/*                                Fill()                                */
+/************************************************************************/
+
+CPLErr GDALThreadSafeRasterBand::Fill(double, double)
+{
+    ReportError(CE_Failure, CPLE_NotSupported,
+                "Write operation not supported on a dataset opened with "
+                "GDAL_OF_THREAD_SAFE");
+    return CE_Failure;
+}
+
+/************************************************************************/
+/*                            GetOverview()                             */
+/************************************************************************/
+
+GDALRasterBand *GDALThreadSafeRasterBand::GetOverview(int nIdx)
+{
+    std::lock_guard<std::mutex> oLock(m_oChildrenMutex);
+    if (nIdx >= 0 && static_cast<size_t>(nIdx) < m_apoOverviews.size() &&
+        m_apoOverviews[nIdx])
+    {
+        return m_apoOverviews[nIdx].get();
+    }
+
+    GDALRasterBand *poPrimaryBand = RefUnderlyingRasterBand();
+    if (poPrimaryBand == nullptr)
+        return nullptr;
+    GDALRasterBand *poPrimaryOvrBand = poPrimaryBand->GetOverview(nIdx);
+    GDALRasterBand *poRet = nullptr;
+    if (poPrimaryOvrBand)
+    {
+        if (static_cast<size_t>(nIdx) >= m_apoOverviews.size())
+            m_apoOverviews.resize(nIdx + 1);
+        std::vector<int> anPath(m_anPath);
+        anPath.push_back(nIdx);
+        m_apoOverviews[nIdx] = std::make_unique<GDALThreadSafeRasterBand>(
+            m_poTSDS, poPrimaryOvrBand, m_nBaseBand, std::move(anPath));
+        poRet = m_apoOverviews[nIdx].get();
+    }
+    UnrefUnderlyingRasterBand(poPrimaryBand);
+    return poRet;
+}
+
+/************************************************************************/
+/*                      GetRasterSampleOverview()                       */
+/************************************************************************/
+
+GDALRasterBand *
+GDALThreadSafeRasterBand::GetRasterSampleOverview(GUIntBig nDesiredSamples)
+{
+    // Use the generic implementation, that goes through GetOverview()
+    return GDALRasterBand::GetRasterSampleOverview(nDesiredSamples);
+}
+
+/************************************************************************/
+/*                            GetMaskBand()                             */
+/************************************************************************/
+
+GDALRasterBand *GDALThreadSafeRasterBand::GetMaskBand()
+{
+    std::lock_guard<std::mutex> oLock(m_oChildrenMutex);
+    if (m_poMaskBand)
+        return m_poMaskBand.get();
+
+    GDALRasterBand *poPrimaryBand = RefUnderlyingRasterBand();
+    if (poPrimaryBand == nullptr)
+        return nullptr;
+    GDALRasterBand *poPrimaryMaskBand = poPrimaryBand->GetMaskBand();
+    if (poPrimaryMaskBand)
+    {
+        std::vector<int> anPath(m_anPath);
+        anPath.push_back(-1);
+        m_poMaskBand = std::make_unique<GDALThreadSafeRasterBand>(
+            m_poTSDS, poPrimaryMaskBand, m_nBaseBand, std::move(anPath));
+    }
+    UnrefUnderlyingRasterBand(poPrimaryBand);
+    return m_poMaskBand.get();
+}
+
+/************************************************************************/
+/*                           BuildOverviews()                           */
+/************************************************************************/
+
+CPLErr GDALThreadSafeRasterBand::BuildOverviews(const char *, int,
+                                                const int *, GDALProgressFunc,
+                                                void *, CSLConstList)
+{
+    ReportError(CE_Failure, CPLE_NotSupported,
+                "BuildOverviews() not supported on a dataset opened with "
+                "GDAL_OF_THREAD_SAFE");
+    return CE_Failure;
+}
+
+/************************************************************************/
+/*                         GetVirtualMemAuto()                          */
+/************************************************************************/
+
+CPLVirtualMem *GDALThreadSafeRasterBand::GetVirtualMemAuto(GDALRWFlag, int *,
+                                                           GIntBig *, char **)
+{
+    // The virtual memory mapping would outlive the lock on the primary
+    // dataset.
+    return nullptr;
+}
+
+/************************************************************************/
+/*                    GDALCreateThreadSafeDataset()                     */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+
+/** Wraps a dataset opened in read-only mode in a dataset that can be used
+ * concurrently by several threads. Used by GDALOpenEx() for the
+ * GDAL_OF_THREAD_SAFE flag. Takes ownership of poPrimaryDS (even on failure).
+ */
+GDALDataset *GDALCreateThreadSafeDataset(GDALDataset *poPrimaryDS,
+                                         const char *pszFilename,
+                                         unsigned int nOpenFlags,
+                                         CSLConstList papszAllowedDrivers,
+                                         CSLConstList papszOpenOptions,
+                                         CSLConstList papszSiblingFiles)
+{
+    if (poPrimaryDS->GetAccess() != GA_ReadOnly)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "GDAL_OF_THREAD_SAFE is only compatible with read-only "
+                 "datasets");
+        poPrimaryDS->ReleaseRef();
+        return nullptr;
+    }
+    return new GDALThreadSafeDataset(poPrimaryDS, pszFilename, nOpenFlags,
+                                     papszAllowedDrivers, papszOpenOptions,
+                                     papszSiblingFiles);
+}
+
+//! @endcond
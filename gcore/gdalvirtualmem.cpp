@@ -38,6 +38,7 @@
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_string.h"
 #include "cpl_virtualmem.h"
 
 // To be changed if we go to 64-bit RasterIO coordinates and spacing.
@@ -68,6 +69,10 @@ class GDALVirtualMem
     bool bIsCompact = false;
     bool bIsBandSequential = false;
 
+    // Owned handle used instead of hDS/hBand when pages are filled
+    // concurrently by several threads.
+    GDALDatasetH hThreadSafeDS = nullptr;
+
     bool IsCompact() const
     {
         return bIsCompact;
@@ -99,6 +104,8 @@ class GDALVirtualMem
                    GIntBig nBandSpace);
     ~GDALVirtualMem();
 
+    bool UseThreadSafeDataset();
+
     static void FillCacheBandSequential(CPLVirtualMem *ctxt, size_t nOffset,
                                         void *pPageToFill, size_t nToFill,
                                         void *pUserData);
@@ -178,6 +185,46 @@ GDALVirtualMem::GDALVirtualMem(
 GDALVirtualMem::~GDALVirtualMem()
 {
     CPLFree(panBandMap);
+    if (hThreadSafeDS)
+        GDALClose(hThreadSafeDS);
+}
+
+/************************************************************************/
+/*                        UseThreadSafeDataset()                        */
+/************************************************************************/
+
+/* Re-open the dataset with GDAL_OF_THREAD_SAFE, so that pages can be filled
+ * concurrently, and read blocks be shared through the block cache of that
+ * handle. */
+bool GDALVirtualMem::UseThreadSafeDataset()
+{
+    GDALDatasetH hSrcDS = hDS ? hDS : GDALGetBandDataset(hBand);
+    const int nBand = hDS ? 0 : GDALGetBandNumber(hBand);
+    if (hSrcDS == nullptr || (hBand != nullptr && nBand <= 0) ||
+        GDALGetAccess(hSrcDS) != GA_ReadOnly)
+        return false;
+
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    hThreadSafeDS = GDALOpenEx(GDALGetDescription(hSrcDS),
+                               GDAL_OF_RASTER | GDAL_OF_THREAD_SAFE, nullptr,
+                               nullptr, nullptr);
+    CPLPopErrorHandler();
+    if (hThreadSafeDS == nullptr)
+        return false;
+    if (GDALGetRasterXSize(hThreadSafeDS) != GDALGetRasterXSize(hSrcDS) ||
+        GDALGetRasterYSize(hThreadSafeDS) != GDALGetRasterYSize(hSrcDS) ||
+        GDALGetRasterCount(hThreadSafeDS) != GDALGetRasterCount(hSrcDS))
+    {
+        GDALClose(hThreadSafeDS);
+        hThreadSafeDS = nullptr;
+        return false;
+    }
+
+    if (hDS)
+        hDS = hThreadSafeDS;
+    else
+        hBand = GDALGetRasterBand(hThreadSafeDS, nBand);
+    return true;
 }
 
 /************************************************************************/
@@ -655,7 +702,7 @@ GDALGetVirtualMem(GDALDatasetH hDS, GDALRasterBandH hBand, GDALRWFlag eRWFlag,
                   GDALDataType eBufType, int nBandCount, int *panBandMap,
                   int nPixelSpace, GIntBig nLineSpace, GIntBig nBandSpace,
                   size_t nCacheSize, size_t nPageSizeHint,
-                  int bSingleThreadUsage, CSLConstList /*papszOptions*/)
+                  int bSingleThreadUsage, CSLConstList papszOptions)
 {
     CPLVirtualMem *view = nullptr;
     GDALVirtualMem *psParams = nullptr;
@@ -756,6 +803,46 @@ GDALGetVirtualMem(GDALDatasetH hDS, GDALRasterBandH hBand, GDALRWFlag eRWFlag,
         hDS, hBand, nXOff, nYOff, nXSize, nYSize, nBufXSize, nBufYSize,
         eBufType, nBandCount, panBandMap, nPixelSpace, nLineSpace, nBandSpace);
 
+    if (CPLTestBool(CSLFetchNameValueDef(papszOptions, "USERFAULTFD", "NO")))
+    {
+        if (eRWFlag != GF_Read)
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "USERFAULTFD=YES is only compatible with GF_Read");
+            delete psParams;
+            return nullptr;
+        }
+        if (CPLIsVirtualMemUserFaultAvailable())
+        {
+            const char *pszNumThreads = CSLFetchNameValueDef(
+                papszOptions, "NUM_THREADS",
+                CPLGetConfigOption("GDAL_NUM_THREADS", "ALL_CPUS"));
+            int nThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                               ? CPLGetNumCPUs()
+                               : std::max(1, atoi(pszNumThreads));
+            if (nThreads > 1 && !psParams->UseThreadSafeDataset())
+            {
+                CPLDebug("GDAL",
+                         "Cannot re-open dataset in thread-safe mode. "
+                         "Pages will be filled by a single thread");
+                nThreads = 1;
+            }
+
+            view = CPLVirtualMemUserFaultNew(
+                static_cast<size_t>(nReqMem), nPageSizeHint,
+                std::min(nThreads, 128),
+                bIsBandSequential ? GDALVirtualMem::FillCacheBandSequential
+                                  : GDALVirtualMem::FillCachePixelInterleaved,
+                GDALVirtualMem::Destroy, psParams);
+            if (view == nullptr)
+                delete psParams;
+            return view;
+        }
+        CPLError(CE_Warning, CPLE_NotSupported,
+                 "userfaultfd is not available. Using the SIGSEGV based "
+                 "mechanism");
+    }
+
     view = CPLVirtualMemNew(
         static_cast<size_t>(nReqMem), nCacheSize, nPageSizeHint,
         bSingleThreadUsage,
@@ -886,7 +973,23 @@ GDALGetVirtualMem(GDALDatasetH hDS, GDALRasterBandH hBand, GDALRWFlag eRWFlag,
  *                           can optimize performance a bit. If set to FALSE,
  *                           CPLVirtualMemDeclareThread() must be called.
  *
- * @param papszOptions NULL terminated list of options. Unused for now.
+ * @param papszOptions NULL terminated list of options, or NULL.
+ * Starting with GDAL 3.9, the following options are supported:
+ * <ul>
+ * <li>USERFAULTFD=YES/NO: (GF_Read only) whether to service page faults
+ * with userfaultfd (Linux only) rather than with a SIGSEGV handler. Pages are
+ * then filled by a pool of worker threads, concurrently for different pages,
+ * and remain allocated until CPLVirtualMemFree() is called (nCacheSize
+ * is ignored). CPLVirtualMemDeclareThread() is not needed. To fill pages
+ * concurrently, the dataset is re-opened with GDAL_OF_THREAD_SAFE, so that
+ * decoded blocks are shared through the block cache; if that is not
+ * possible, pages are filled by a single worker thread, and the dataset
+ * must not be used by other threads while the mapping is in use.
+ * Defaults to NO.</li>
+ * <li>NUM_THREADS=integer|ALL_CPUS: number of worker threads for
+ * USERFAULTFD=YES. Defaults to the value of the GDAL_NUM_THREADS
+ * configuration option, or ALL_CPUS.</li>
+ * </ul>
  *
  * @return a virtual memory object that must be freed by CPLVirtualMemFree(),
  *         or NULL in case of failure.
@@ -1004,7 +1107,9 @@ CPLVirtualMem *GDALDatasetGetVirtualMem(
  *                           can optimize performance a bit. If set to FALSE,
  *                           CPLVirtualMemDeclareThread() must be called.
  *
- * @param papszOptions NULL terminated list of options. Unused for now.
+ * @param papszOptions NULL terminated list of options, or NULL.
+ * Starting with GDAL 3.9, USERFAULTFD=YES/NO and NUM_THREADS are supported,
+ * with the same semantics as in GDALDatasetGetVirtualMem().
  *
  * @return a virtual memory object that must be freed by CPLVirtualMemFree(),
  *         or NULL in case of failure.
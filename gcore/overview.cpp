@@ -51,6 +51,7 @@
 #include "gdal.h"
 #include "gdal_thread_pool.h"
 #include "gdalwarper.h"
+#include "memdataset.h"
 
 // Restrict to 64bit processors because they are guaranteed to have SSE2,
 // or if __AVX2__ is defined.
@@ -4218,6 +4219,551 @@ struct PointerHolder
 };
 }  // namespace
 
+/************************************************************************/
+/*                    GDALOvrStreamingCascade                           */
+/************************************************************************/
+
+namespace
+{
+// Generates a list of overviews in cascading order (each overview being
+// computed from the next larger one), like GDALRegenerateCascadingOverviews()
+// does, but reading the source band only once, and feeding the lines produced
+// for one overview level directly to the computation of the next one, instead
+// of reading them back from the overview band. Only a few strips of lines are
+// kept in memory for each level.
+//
+// To give the same result as GDALRegenerateCascadingOverviews(), the lines
+// of an overview level are converted to the data type of the overview band
+// before being used as the input of the next level, and the nodata mask of
+// the next level is derived from them in the same way as a nodata mask band
+// would do. Each batch of destination lines is computed with enough source
+// lines around it, so that the result does not depend on the chunking.
+class GDALOvrStreamingCascade
+{
+  public:
+    GDALOvrStreamingCascade(GDALRasterBand *poSrcBand,
+                            GDALRasterBand *poSrcMaskBand, bool bUseNoDataMask,
+                            std::vector<GDALRasterBand *> &&apoOvrBands,
+                            const char *pszResampling,
+                            GDALResampleFunction pfnResampleFn);
+
+    static bool IsCompatible(GDALRasterBand *poSrcBand,
+                             const GDALColorTable *poColorTable,
+                             const std::vector<GDALRasterBand *> &apoOvrBands,
+                             const char *pszResampling);
+
+    CPLErr Run(GDALProgressFunc pfnProgress, void *pProgressData);
+
+  private:
+    struct Level
+    {
+        // Band whose content is the input of this level: the source band
+        // for the first level, and the previous overview otherwise.
+        GDALRasterBand *poInBand = nullptr;
+        GDALRasterBand *poOutBand = nullptr;
+        int nInWidth = 0;
+        int nInHeight = 0;
+        int nOutWidth = 0;
+        int nOutHeight = 0;
+        double dfXRatioDstToSrc = 0;
+        double dfYRatioDstToSrc = 0;
+        // Number of extra source lines kept around the ones strictly needed
+        int nMarginLines = 0;
+        GDALDataType eInDataType = GDT_Unknown;
+        GDALDataType eWrkDataType = GDT_Unknown;
+        GDALDataType eOutDataType = GDT_Unknown;
+        bool bHasNoData = false;
+        double dfNoDataValue = 0;
+        bool bUseNoDataMask = false;
+
+        // Input lines [nBufYOff, nBufYOff + nBufYSize), in eWrkDataType
+        std::vector<GByte> abyBuf{};
+        std::vector<GByte> abyMask{};
+        int nBufYOff = 0;
+        int nBufYSize = 0;
+
+        // First line of the overview not yet computed
+        int nNextDstLine = 0;
+    };
+
+    struct Job
+    {
+        const Level *psLevel = nullptr;
+        GDALResampleFunction pfnResampleFn = nullptr;
+        const char *pszResampling = nullptr;
+        bool bPropagateNoData = false;
+        int nDstYOff = 0;
+        int nDstYOff2 = 0;
+
+        CPLErr eErr = CE_Failure;
+        void *pDstBuffer = nullptr;
+        GDALDataType eDstBufferDataType = GDT_Unknown;
+    };
+
+    static void JobFunc(void *pData);
+
+    CPLErr ProcessLevel(size_t iLevel);
+    CPLErr ComputeNoDataMask(const Level &sLevel, const GByte *pabyValues,
+                             int nLines, GByte *pabyMask);
+
+    GDALRasterBand *m_poSrcBand = nullptr;
+    GDALRasterBand *m_poSrcMaskBand = nullptr;
+    const char *m_pszResampling = nullptr;
+    GDALResampleFunction m_pfnResampleFn = nullptr;
+    bool m_bPropagateNoData = false;
+    std::vector<Level> m_asLevels{};
+    std::unique_ptr<CPLJobQueue> m_poJobQueue{};
+    int m_nThreads = 1;
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALOvrStreamingCascade)
+};
+
+/************************************************************************/
+/*                            IsCompatible()                            */
+/************************************************************************/
+
+// Returns whether GDALOvrStreamingCascade can be used instead of
+// GDALRegenerateCascadingOverviews(). The overview bands must be sorted from
+// largest to smallest.
+bool GDALOvrStreamingCascade::IsCompatible(
+    GDALRasterBand *poSrcBand, const GDALColorTable *poColorTable,
+    const std::vector<GDALRasterBand *> &apoOvrBands,
+    const char *pszResampling)
+{
+    // Only configurable for debug / testing
+    if (!CPLTestBool(
+            CPLGetConfigOption("GDAL_OVR_STREAMING_CASCADE", "YES")))
+        return false;
+
+    if (!EQUAL(pszResampling, "AVERAGE") && !EQUAL(pszResampling, "RMS") &&
+        !EQUAL(pszResampling, "MODE") && !EQUAL(pszResampling, "GAUSS"))
+    {
+        return false;
+    }
+    if (poColorTable != nullptr || poSrcBand->IsMaskBand())
+        return false;
+
+    const auto IsCompatibleDataType = [](GDALDataType eDT)
+    {
+        return !GDALDataTypeIsComplex(eDT) && eDT != GDT_Int64 &&
+               eDT != GDT_UInt64;
+    };
+    if (!IsCompatibleDataType(poSrcBand->GetRasterDataType()))
+        return false;
+
+    GDALRasterBand *poPrevBand = poSrcBand;
+    for (size_t i = 0; i < apoOvrBands.size(); ++i)
+    {
+        GDALRasterBand *poOvrBand = apoOvrBands[i];
+        if (!IsCompatibleDataType(poOvrBand->GetRasterDataType()) ||
+            poOvrBand->IsMaskBand() || poOvrBand->GetXSize() <= 0 ||
+            poOvrBand->GetYSize() <= 0 ||
+            poOvrBand->GetXSize() > poPrevBand->GetXSize() ||
+            poOvrBand->GetYSize() > poPrevBand->GetYSize())
+        {
+            return false;
+        }
+        // Overviews other than the last one are the input of the next level.
+        // Their mask must be computable from their values.
+        if (i + 1 < apoOvrBands.size())
+        {
+            const int nMaskFlags = poOvrBand->GetMaskFlags();
+            if (nMaskFlags != GMF_NODATA && nMaskFlags != GMF_ALL_VALID)
+                return false;
+        }
+        poPrevBand = poOvrBand;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                       GDALOvrStreamingCascade()                      */
+/************************************************************************/
+
+GDALOvrStreamingCascade::GDALOvrStreamingCascade(
+    GDALRasterBand *poSrcBand, GDALRasterBand *poSrcMaskBand,
+    bool bUseNoDataMask, std::vector<GDALRasterBand *> &&apoOvrBands,
+    const char *pszResampling, GDALResampleFunction pfnResampleFn)
+    : m_poSrcBand(poSrcBand), m_poSrcMaskBand(poSrcMaskBand),
+      m_pszResampling(pszResampling), m_pfnResampleFn(pfnResampleFn),
+      m_bPropagateNoData(CPLTestBool(
+          CPLGetConfigOption("GDAL_OVR_PROPAGATE_NODATA", "NO")))
+{
+    m_asLevels.resize(apoOvrBands.size());
+    GDALRasterBand *poInBand = poSrcBand;
+    for (size_t i = 0; i < apoOvrBands.size(); ++i)
+    {
+        Level &sLevel = m_asLevels[i];
+        sLevel.poInBand = poInBand;
+        sLevel.poOutBand = apoOvrBands[i];
+        sLevel.nInWidth = poInBand->GetXSize();
+        sLevel.nInHeight = poInBand->GetYSize();
+        sLevel.nOutWidth = sLevel.poOutBand->GetXSize();
+        sLevel.nOutHeight = sLevel.poOutBand->GetYSize();
+        sLevel.dfXRatioDstToSrc =
+            static_cast<double>(sLevel.nInWidth) / sLevel.nOutWidth;
+        sLevel.dfYRatioDstToSrc =
+            static_cast<double>(sLevel.nInHeight) / sLevel.nOutHeight;
+        // Large enough to cover the 7x7 matrix of the GAUSS resampling
+        sLevel.nMarginLines =
+            static_cast<int>(std::ceil(sLevel.dfYRatioDstToSrc)) + 8;
+        sLevel.eInDataType = poInBand->GetRasterDataType();
+        sLevel.eWrkDataType =
+            GDALGetOvrWorkDataType(pszResampling, sLevel.eInDataType);
+        sLevel.eOutDataType = sLevel.poOutBand->GetRasterDataType();
+        int bHasNoData = FALSE;
+        sLevel.dfNoDataValue = poInBand->GetNoDataValue(&bHasNoData);
+        sLevel.bHasNoData = CPL_TO_BOOL(bHasNoData);
+        sLevel.bUseNoDataMask =
+            i == 0 ? bUseNoDataMask
+                   : (poInBand->GetMaskFlags() & GMF_ALL_VALID) == 0;
+        poInBand = sLevel.poOutBand;
+    }
+
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    m_nThreads = std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                               ? CPLGetNumCPUs()
+                                               : atoi(pszThreads)));
+    auto poThreadPool =
+        m_nThreads > 1 ? GDALGetGlobalThreadPool(m_nThreads) : nullptr;
+    if (poThreadPool)
+        m_poJobQueue = poThreadPool->CreateJobQueue();
+    else
+        m_nThreads = 1;
+}
+
+/************************************************************************/
+/*                              JobFunc()                               */
+/************************************************************************/
+
+void GDALOvrStreamingCascade::JobFunc(void *pData)
+{
+    Job *psJob = static_cast<Job *>(pData);
+    const Level &sLevel = *(psJob->psLevel);
+    psJob->eErr = psJob->pfnResampleFn(
+        sLevel.dfXRatioDstToSrc, sLevel.dfYRatioDstToSrc, 0.0, 0.0,
+        sLevel.eWrkDataType, sLevel.abyBuf.data(),
+        sLevel.bUseNoDataMask ? sLevel.abyMask.data() : nullptr, 0,
+        sLevel.nInWidth, sLevel.nBufYOff, sLevel.nBufYSize, 0,
+        sLevel.nOutWidth, psJob->nDstYOff, psJob->nDstYOff2, sLevel.poOutBand,
+        &(psJob->pDstBuffer), &(psJob->eDstBufferDataType),
+        psJob->pszResampling, sLevel.bHasNoData, sLevel.dfNoDataValue, nullptr,
+        sLevel.eInDataType, psJob->bPropagateNoData);
+}
+
+/************************************************************************/
+/*                         ComputeNoDataMask()                          */
+/************************************************************************/
+
+// Computes the mask of nLines lines of values of the input band of sLevel,
+// in the input band data type, as the nodata mask band of the input band
+// would return it.
+CPLErr GDALOvrStreamingCascade::ComputeNoDataMask(const Level &sLevel,
+                                                  const GByte *pabyValues,
+                                                  int nLines, GByte *pabyMask)
+{
+    auto poMEMDS = std::unique_ptr<MEMDataset>(MEMDataset::Create(
+        "", sLevel.nInWidth, nLines, 0, sLevel.eInDataType, nullptr));
+    if (!poMEMDS)
+        return CE_Failure;
+    GDALRasterBandH hMEMBand = MEMCreateRasterBandEx(
+        poMEMDS.get(), 1, const_cast<GByte *>(pabyValues), sLevel.eInDataType,
+        0, 0, false);
+    poMEMDS->AddMEMBand(hMEMBand);
+    GDALRasterBand *poMEMBand = poMEMDS->GetRasterBand(1);
+    if (sLevel.bHasNoData)
+        poMEMBand->SetNoDataValue(sLevel.dfNoDataValue);
+    return poMEMBand->GetMaskBand()->RasterIO(
+        GF_Read, 0, 0, sLevel.nInWidth, nLines, pabyMask, sLevel.nInWidth,
+        nLines, GDT_Byte, 0, 0, nullptr);
+}
+
+/************************************************************************/
+/*                           ProcessLevel()                             */
+/************************************************************************/
+
+// Computes all the lines of the overview of the level that can be computed
+// from the currently buffered input lines, writes them, and forwards them
+// to the next level.
+CPLErr GDALOvrStreamingCascade::ProcessLevel(size_t iLevel)
+{
+    Level &sLevel = m_asLevels[iLevel];
+    const int nBufEnd = sLevel.nBufYOff + sLevel.nBufYSize;
+    const double dfRatio = sLevel.dfYRatioDstToSrc;
+
+    // Find the last line that can be computed with the buffered lines
+    int nDstYOff2 = sLevel.nOutHeight;
+    if (nBufEnd < sLevel.nInHeight)
+    {
+        nDstYOff2 = std::min(
+            sLevel.nOutHeight,
+            std::max(sLevel.nNextDstLine,
+                     static_cast<int>((nBufEnd - sLevel.nMarginLines) /
+                                      dfRatio)));
+        while (nDstYOff2 > sLevel.nNextDstLine &&
+               static_cast<int>(std::ceil(nDstYOff2 * dfRatio)) +
+                       sLevel.nMarginLines >
+                   nBufEnd)
+        {
+            --nDstYOff2;
+        }
+    }
+    const int nDstYOff = sLevel.nNextDstLine;
+    if (nDstYOff2 <= nDstYOff)
+        return CE_None;
+    const int nDstLines = nDstYOff2 - nDstYOff;
+
+    // Compute the lines, split among threads
+    const int nJobs = std::max(1, std::min(m_nThreads, nDstLines / 4));
+    std::vector<Job> asJobs(nJobs);
+    for (int i = 0; i < nJobs; ++i)
+    {
+        Job &sJob = asJobs[i];
+        sJob.psLevel = &sLevel;
+        sJob.pfnResampleFn = m_pfnResampleFn;
+        sJob.pszResampling = m_pszResampling;
+        sJob.bPropagateNoData = m_bPropagateNoData;
+        sJob.nDstYOff =
+            nDstYOff + static_cast<int>(static_cast<GIntBig>(nDstLines) * i /
+                                        nJobs);
+        sJob.nDstYOff2 =
+            nDstYOff + static_cast<int>(static_cast<GIntBig>(nDstLines) *
+                                        (i + 1) / nJobs);
+    }
+    if (m_poJobQueue && nJobs > 1)
+    {
+        for (auto &sJob : asJobs)
+            m_poJobQueue->SubmitJob(JobFunc, &sJob);
+        m_poJobQueue->WaitCompletion();
+    }
+    else
+    {
+        for (auto &sJob : asJobs)
+            JobFunc(&sJob);
+    }
+
+    // Convert them to the data type of the overview band
+    const int nOutDTSize = GDALGetDataTypeSizeBytes(sLevel.eOutDataType);
+    const size_t nOutLineSize =
+        static_cast<size_t>(sLevel.nOutWidth) * nOutDTSize;
+    std::vector<GByte> abyOut;
+    CPLErr eErr = CE_None;
+    try
+    {
+        abyOut.resize(nOutLineSize * nDstLines);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALOvrStreamingCascade::ProcessLevel()");
+        eErr = CE_Failure;
+    }
+    for (auto &sJob : asJobs)
+    {
+        if (eErr == CE_None && sJob.eErr != CE_None)
+            eErr = sJob.eErr;
+        if (eErr == CE_None)
+        {
+            GDALCopyWords64(
+                sJob.pDstBuffer, sJob.eDstBufferDataType,
+                GDALGetDataTypeSizeBytes(sJob.eDstBufferDataType),
+                abyOut.data() + (sJob.nDstYOff - nDstYOff) * nOutLineSize,
+                sLevel.eOutDataType, nOutDTSize,
+                static_cast<GPtrDiff_t>(sLevel.nOutWidth) *
+                    (sJob.nDstYOff2 - sJob.nDstYOff));
+        }
+        VSIFree(sJob.pDstBuffer);
+    }
+    if (eErr != CE_None)
+        return eErr;
+
+    eErr = sLevel.poOutBand->RasterIO(
+        GF_Write, 0, nDstYOff, sLevel.nOutWidth, nDstLines, abyOut.data(),
+        sLevel.nOutWidth, nDstLines, sLevel.eOutDataType, 0, 0, nullptr);
+    if (eErr != CE_None)
+        return eErr;
+    sLevel.nNextDstLine = nDstYOff2;
+
+    // Discard the input lines that are no longer needed
+    if (sLevel.nNextDstLine == sLevel.nOutHeight)
+    {
+        sLevel.abyBuf = std::vector<GByte>();
+        sLevel.abyMask = std::vector<GByte>();
+        sLevel.nBufYOff = nBufEnd;
+        sLevel.nBufYSize = 0;
+    }
+    else
+    {
+        const int nKeepYOff = std::min(
+            nBufEnd,
+            std::max(sLevel.nBufYOff,
+                     static_cast<int>(sLevel.nNextDstLine * dfRatio) -
+                         sLevel.nMarginLines));
+        const size_t nDiscardedLines =
+            static_cast<size_t>(nKeepYOff - sLevel.nBufYOff);
+        const size_t nWrkLineSize =
+            static_cast<size_t>(sLevel.nInWidth) *
+            GDALGetDataTypeSizeBytes(sLevel.eWrkDataType);
+        sLevel.abyBuf.erase(sLevel.abyBuf.begin(),
+                            sLevel.abyBuf.begin() +
+                                nDiscardedLines * nWrkLineSize);
+        if (sLevel.bUseNoDataMask)
+        {
+            sLevel.abyMask.erase(sLevel.abyMask.begin(),
+                                 sLevel.abyMask.begin() +
+                                     nDiscardedLines * sLevel.nInWidth);
+        }
+        sLevel.nBufYOff = nKeepYOff;
+        sLevel.nBufYSize = nBufEnd - nKeepYOff;
+    }
+
+    if (iLevel + 1 == m_asLevels.size())
+        return CE_None;
+
+    // Forward the computed lines, with the values they have in the overview
+    // band, to the next level.
+    Level &sNextLevel = m_asLevels[iLevel + 1];
+    const size_t nNextWrkLineSize =
+        static_cast<size_t>(sNextLevel.nInWidth) *
+        GDALGetDataTypeSizeBytes(sNextLevel.eWrkDataType);
+    const size_t nOldSize = sNextLevel.abyBuf.size();
+    try
+    {
+        sNextLevel.abyBuf.resize(nOldSize + nNextWrkLineSize * nDstLines);
+        if (sNextLevel.bUseNoDataMask)
+        {
+            sNextLevel.abyMask.resize(sNextLevel.abyMask.size() +
+                                      static_cast<size_t>(nDstLines) *
+                                          sNextLevel.nInWidth);
+        }
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALOvrStreamingCascade::ProcessLevel()");
+        return CE_Failure;
+    }
+    GDALCopyWords64(abyOut.data(), sLevel.eOutDataType, nOutDTSize,
+                    sNextLevel.abyBuf.data() + nOldSize,
+                    sNextLevel.eWrkDataType,
+                    GDALGetDataTypeSizeBytes(sNextLevel.eWrkDataType),
+                    static_cast<GPtrDiff_t>(sLevel.nOutWidth) * nDstLines);
+    if (sNextLevel.bUseNoDataMask)
+    {
+        eErr = ComputeNoDataMask(
+            sNextLevel, abyOut.data(), nDstLines,
+            sNextLevel.abyMask.data() + sNextLevel.abyMask.size() -
+                static_cast<size_t>(nDstLines) * sNextLevel.nInWidth);
+        if (eErr != CE_None)
+            return eErr;
+    }
+    sNextLevel.nBufYSize += nDstLines;
+
+    return ProcessLevel(iLevel + 1);
+}
+
+/************************************************************************/
+/*                                Run()                                 */
+/************************************************************************/
+
+CPLErr GDALOvrStreamingCascade::Run(GDALProgressFunc pfnProgress,
+                                    void *pProgressData)
+{
+    Level &sFirstLevel = m_asLevels[0];
+    const int nWidth = sFirstLevel.nInWidth;
+    const int nHeight = sFirstLevel.nInHeight;
+    const int nWrkDTSize = GDALGetDataTypeSizeBytes(sFirstLevel.eWrkDataType);
+
+    // Read the source by chunks of whole blocks, of about
+    // GDAL_OVR_CHUNK_MAX_SIZE bytes.
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    m_poSrcBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    nBlockYSize = std::max(1, nBlockYSize);
+    int nChunkYSize = nBlockYSize;
+    // Only configurable for debug / testing
+    const char *pszChunkYSize =
+        CPLGetConfigOption("GDAL_OVR_CHUNKYSIZE", nullptr);
+    if (pszChunkYSize)
+    {
+        // coverity[tainted_data]
+        nChunkYSize = std::max(1, atoi(pszChunkYSize));
+    }
+    else
+    {
+        // Only configurable for debug / testing
+        const GIntBig nChunkMaxSize = std::max(
+            1, atoi(CPLGetConfigOption("GDAL_OVR_CHUNK_MAX_SIZE", "10485760")));
+        const GIntBig nLineSize = static_cast<GIntBig>(nWidth) * nWrkDTSize;
+        const GIntBig nBlocks = nChunkMaxSize / (nLineSize * nBlockYSize);
+        if (nBlocks > 1)
+        {
+            nChunkYSize = static_cast<int>(
+                std::min<GIntBig>(nHeight, nBlocks * nBlockYSize));
+        }
+    }
+
+    const size_t nWrkLineSize = static_cast<size_t>(nWidth) * nWrkDTSize;
+    CPLErr eErr = CE_None;
+    for (int nChunkYOff = 0; nChunkYOff < nHeight && eErr == CE_None;
+         nChunkYOff += nChunkYSize)
+    {
+        if (!pfnProgress(nChunkYOff / static_cast<double>(nHeight), nullptr,
+                         pProgressData))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+
+        const int nLines = std::min(nChunkYSize, nHeight - nChunkYOff);
+        const size_t nOldSize = sFirstLevel.abyBuf.size();
+        const size_t nOldMaskSize = sFirstLevel.abyMask.size();
+        try
+        {
+            sFirstLevel.abyBuf.resize(nOldSize + nWrkLineSize * nLines);
+            if (sFirstLevel.bUseNoDataMask)
+                sFirstLevel.abyMask.resize(
+                    nOldMaskSize + static_cast<size_t>(nWidth) * nLines);
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in GDALOvrStreamingCascade::Run()");
+            return CE_Failure;
+        }
+
+        eErr = m_poSrcBand->RasterIO(
+            GF_Read, 0, nChunkYOff, nWidth, nLines,
+            sFirstLevel.abyBuf.data() + nOldSize, nWidth, nLines,
+            sFirstLevel.eWrkDataType, 0, 0, nullptr);
+        if (eErr == CE_None && sFirstLevel.bUseNoDataMask)
+        {
+            eErr = m_poSrcMaskBand->RasterIO(
+                GF_Read, 0, nChunkYOff, nWidth, nLines,
+                sFirstLevel.abyMask.data() + nOldMaskSize, nWidth, nLines,
+                GDT_Byte, 0, 0, nullptr);
+        }
+        if (eErr == CE_None)
+        {
+            sFirstLevel.nBufYSize += nLines;
+            eErr = ProcessLevel(0);
+        }
+    }
+
+    // It can be important to flush out data to overviews.
+    for (size_t i = 0; eErr == CE_None && i < m_asLevels.size(); ++i)
+    {
+        eErr = m_asLevels[i].poOutBand->FlushCache(false);
+    }
+
+    if (eErr == CE_None)
+        pfnProgress(1.0, nullptr, pProgressData);
+
+    return eErr;
+}
+
+}  // namespace
+
 /************************************************************************/
 /*                      GDALRegenerateOverviews()                       */
 /************************************************************************/
@@ -4415,9 +4961,31 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
          EQUAL(pszResampling, "LANCZOS") || EQUAL(pszResampling, "BILINEAR") ||
          EQUAL(pszResampling, "MODE")) &&
         nOverviewCount > 1 && bCanUseCascaded)
+    {
+        // Sort overviews from largest to smallest
+        std::vector<GDALRasterBand *> apoSortedOvrBands(
+            papoOvrBands, papoOvrBands + nOverviewCount);
+        std::stable_sort(apoSortedOvrBands.begin(), apoSortedOvrBands.end(),
+                         [](GDALRasterBand *a, GDALRasterBand *b)
+                         {
+                             return a->GetXSize() *
+                                        static_cast<double>(a->GetYSize()) >
+                                    b->GetXSize() *
+                                        static_cast<double>(b->GetYSize());
+                         });
+        if (GDALOvrStreamingCascade::IsCompatible(
+                poSrcBand, poColorTable, apoSortedOvrBands, pszResampling))
+        {
+            GDALOvrStreamingCascade oCascade(
+                poSrcBand, poMaskBand, bUseNoDataMask,
+                std::move(apoSortedOvrBands), pszResampling, pfnResampleFn);
+            return oCascade.Run(pfnProgress, pProgressData);
+        }
+
         return GDALRegenerateCascadingOverviews(
             poSrcBand, nOverviewCount, papoOvrBands, pszResampling, pfnProgress,
             pProgressData, papszOptions);
+    }
 
     /* -------------------------------------------------------------------- */
     /*      Setup one horizontal swath to read from the raw buffer.         */
@@ -41,20 +41,30 @@
 #include <cstring>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
 #include <limits>
+#include <list>
+#include <memory>
 #include <stdexcept>
 #include <type_traits>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_cpu_features.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "gdal_vrt.h"
 #include "gdalwarper.h"
 #include "memdataset.h"
+#include "rasterio_avx2.h"
 #include "vrtdataset.h"
 
 static void GDALFastCopyByte(const GByte *CPL_RESTRICT pSrcData,
@@ -1270,34 +1280,199 @@ CPLErr GDALRasterBand::RasterIOResampled(
         if (nFullResYSizeQueried > nRasterYSize)
             nFullResYSizeQueried = nRasterYSize;
 
-        void *pChunk =
-            VSI_MALLOC3_VERBOSE(GDALGetDataTypeSizeBytes(eWrkDataType),
-                                nFullResXSizeQueried, nFullResYSizeQueried);
-        GByte *pabyChunkNoDataMask = nullptr;
-
         GDALRasterBand *poMaskBand = GetMaskBand();
         int l_nMaskFlags = GetMaskFlags();
-
         bool bUseNoDataMask = ((l_nMaskFlags & GMF_ALL_VALID) == 0);
-        if (bUseNoDataMask)
-        {
-            pabyChunkNoDataMask = static_cast<GByte *>(VSI_MALLOC2_VERBOSE(
-                nFullResXSizeQueried, nFullResYSizeQueried));
-        }
-        if (pChunk == nullptr ||
-            (bUseNoDataMask && pabyChunkNoDataMask == nullptr))
-        {
-            GDALClose(poMEMDS);
-            CPLFree(pChunk);
-            CPLFree(pabyChunkNoDataMask);
-            VSIFree(pTempBuffer);
-            return CE_Failure;
-        }
+
+        GDALRasterBand *poMEMBand = GDALRasterBand::FromHandle(hMEMBand);
+        GDALColorTable *poColorTable = GetColorTable();
 
         int nTotalBlocks = ((nBufXSize + nDstBlockXSize - 1) / nDstBlockXSize) *
                            ((nBufYSize + nDstBlockYSize - 1) / nDstBlockYSize);
         int nBlocksDone = 0;
 
+        // Resampling of output chunks can be done by worker threads. Reading
+        // the source chunks and writing the resampled data into the MEM band
+        // is always done by the calling thread, as bands are not thread-safe.
+        const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+        const int nThreads =
+            std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                          ? CPLGetNumCPUs()
+                                          : atoi(pszThreads)));
+        auto poThreadPool = nThreads > 1 && nTotalBlocks > 1
+                                ? GDALGetGlobalThreadPool(nThreads)
+                                : nullptr;
+
+        // Structure describing the resampling of an output chunk
+        struct ResampleJob
+        {
+            // Source buffers
+            void *pChunk = nullptr;
+            GByte *pabyChunkNoDataMask = nullptr;
+            bool bNoDataMaskFullyOpaque = false;
+            int nChunkXOffQueried = 0;
+            int nChunkXSizeQueried = 0;
+            int nChunkYOffQueried = 0;
+            int nChunkYSizeQueried = 0;
+
+            // Output window
+            int nDstXOff = 0;
+            int nDstXCount = 0;
+            int nDstYOff = 0;
+            int nDstYCount = 0;
+
+            // Output values of the resampling function
+            CPLErr eErr = CE_None;
+            void *pDstBuffer = nullptr;
+            GDALDataType eDstBufferDataType = GDT_Unknown;
+
+            // Set when run by a worker thread
+            const std::function<void(ResampleJob &)> *pfnResample = nullptr;
+            std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+            std::atomic<bool> bFinished{false};
+
+            ResampleJob() = default;
+            ResampleJob(const ResampleJob &) = delete;
+            ResampleJob &operator=(const ResampleJob &) = delete;
+
+            ~ResampleJob()
+            {
+                CPLFree(pChunk);
+                CPLFree(pabyChunkNoDataMask);
+                CPLFree(pDstBuffer);
+            }
+
+            bool AllocSrcBuffers(size_t nWrkDTSize, int nXSizeQueried,
+                                 int nYSizeQueried, bool bWithMask)
+            {
+                pChunk = VSI_MALLOC3_VERBOSE(nWrkDTSize, nXSizeQueried,
+                                             nYSizeQueried);
+                if (bWithMask)
+                {
+                    pabyChunkNoDataMask =
+                        static_cast<GByte *>(VSI_MALLOC2_VERBOSE(
+                            nXSizeQueried, nYSizeQueried));
+                }
+                return pChunk != nullptr &&
+                       (!bWithMask || pabyChunkNoDataMask != nullptr);
+            }
+        };
+
+        // Only accesses the job buffers and state that is not modified during
+        // the loop, so that it can be run by a worker thread.
+        const std::function<void(ResampleJob &)> Resample =
+            [&](ResampleJob &sJob)
+        {
+            const bool bPropagateNoData = false;
+            sJob.eErr = pfnResampleFunc(
+                dfXRatioDstToSrc, dfYRatioDstToSrc,
+                dfXOff - nXOff, /* == 0 if bHasXOffVirtual */
+                dfYOff - nYOff, /* == 0 if bHasYOffVirtual */
+                eWrkDataType, sJob.pChunk,
+                sJob.bNoDataMaskFullyOpaque ? nullptr
+                                            : sJob.pabyChunkNoDataMask,
+                sJob.nChunkXOffQueried - (bHasXOffVirtual ? 0 : nXOff),
+                sJob.nChunkXSizeQueried,
+                sJob.nChunkYOffQueried - (bHasYOffVirtual ? 0 : nYOff),
+                sJob.nChunkYSizeQueried, sJob.nDstXOff + nDestXOffVirtual,
+                sJob.nDstXOff + nDestXOffVirtual + sJob.nDstXCount,
+                sJob.nDstYOff + nDestYOffVirtual,
+                sJob.nDstYOff + nDestYOffVirtual + sJob.nDstYCount, poMEMBand,
+                &sJob.pDstBuffer, &sJob.eDstBufferDataType, pszResampling,
+                bHasNoData, dfNoDataValue, poColorTable, eDataType,
+                bPropagateNoData);
+        };
+
+        const auto ResampleJobFunc = [](void *pJobData)
+        {
+            ResampleJob *psJob = static_cast<ResampleJob *>(pJobData);
+            CPLInstallErrorHandlerAccumulator(psJob->aoErrors);
+            (*psJob->pfnResample)(*psJob);
+            CPLUninstallErrorHandlerAccumulator();
+            psJob->bFinished = true;
+        };
+
+        // Write the resampled data of a job into the MEM band, and report
+        // progress.
+        const auto FinalizeJob = [&](ResampleJob &sJob)
+        {
+            for (const auto &oError : sJob.aoErrors)
+            {
+                CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+            }
+            sJob.aoErrors.clear();
+
+            CPLErr eJobErr = sJob.eErr;
+            if (eJobErr == CE_None)
+            {
+                eJobErr = poMEMBand->RasterIO(
+                    GF_Write, sJob.nDstXOff + nDestXOffVirtual,
+                    sJob.nDstYOff + nDestYOffVirtual, sJob.nDstXCount,
+                    sJob.nDstYCount, sJob.pDstBuffer, sJob.nDstXCount,
+                    sJob.nDstYCount, sJob.eDstBufferDataType, 0, 0, nullptr);
+            }
+            CPLFree(sJob.pDstBuffer);
+            sJob.pDstBuffer = nullptr;
+
+            nBlocksDone++;
+            if (eJobErr == CE_None && psExtraArg->pfnProgress != nullptr &&
+                !psExtraArg->pfnProgress(1.0 * nBlocksDone / nTotalBlocks, "",
+                                         psExtraArg->pProgressData))
+            {
+                eJobErr = CE_Failure;
+            }
+            return eJobErr;
+        };
+
+        // Jobs submitted to the worker threads, and not finalized yet.
+        // Must be declared before the job queue, so that they are destroyed
+        // after its jobs are completed.
+        std::list<std::unique_ptr<ResampleJob>> apoJobs;
+        auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                       : std::unique_ptr<CPLJobQueue>(nullptr);
+
+        // Finalize the jobs that are completed, after having waited for the
+        // number of running jobs to go below nMaxRemainingJobs.
+        const auto FinalizeFinishedJobs = [&](int nMaxRemainingJobs)
+        {
+            if (static_cast<int>(apoJobs.size()) > nMaxRemainingJobs)
+                poJobQueue->WaitCompletion(nMaxRemainingJobs);
+            CPLErr eJobsErr = CE_None;
+            for (auto oIter = apoJobs.begin(); oIter != apoJobs.end();)
+            {
+                if ((*oIter)->bFinished)
+                {
+                    if (eJobsErr == CE_None)
+                        eJobsErr = FinalizeJob(**oIter);
+                    oIter = apoJobs.erase(oIter);
+                }
+                else
+                {
+                    ++oIter;
+                }
+            }
+            return eJobsErr;
+        };
+
+        const size_t nWrkDTSize = GDALGetDataTypeSizeBytes(eWrkDataType);
+
+        // When not using worker threads, the same job and buffers are reused
+        // for all chunks.
+        std::unique_ptr<ResampleJob> poSerialJob;
+        if (!poJobQueue)
+        {
+            poSerialJob = std::make_unique<ResampleJob>();
+            if (!poSerialJob->AllocSrcBuffers(nWrkDTSize, nFullResXSizeQueried,
+                                              nFullResYSizeQueried,
+                                              bUseNoDataMask))
+            {
+                poSerialJob.reset();
+                GDALClose(poMEMDS);
+                VSIFree(pTempBuffer);
+                return CE_Failure;
+            }
+        }
+
         int nDstYOff;
         for (nDstYOff = 0; nDstYOff < nBufYSize && eErr == CE_None;
              nDstYOff += nDstBlockYSize)
@@ -1363,16 +1538,45 @@ CPLErr GDALRasterBand::RasterIOResampled(
                     nChunkXSizeQueried = nRasterXSize - nChunkXOffQueried;
                 CPLAssert(nChunkXSizeQueried <= nFullResXSizeQueried);
 
+                // Avoid accumulating more jobs, and thus source buffers, than
+                // worker threads.
+                std::unique_ptr<ResampleJob> poNewJob;
+                if (poJobQueue)
+                {
+                    eErr = FinalizeFinishedJobs(nThreads - 1);
+                    if (eErr != CE_None)
+                        break;
+                    poNewJob = std::make_unique<ResampleJob>();
+                    if (!poNewJob->AllocSrcBuffers(
+                            nWrkDTSize, nChunkXSizeQueried, nChunkYSizeQueried,
+                            bUseNoDataMask))
+                    {
+                        eErr = CE_Failure;
+                        break;
+                    }
+                }
+                ResampleJob &sJob = poJobQueue ? *poNewJob : *poSerialJob;
+                sJob.nChunkXOffQueried = nChunkXOffQueried;
+                sJob.nChunkXSizeQueried = nChunkXSizeQueried;
+                sJob.nChunkYOffQueried = nChunkYOffQueried;
+                sJob.nChunkYSizeQueried = nChunkYSizeQueried;
+                sJob.nDstXOff = nDstXOff;
+                sJob.nDstXCount = nDstXCount;
+                sJob.nDstYOff = nDstYOff;
+                sJob.nDstYCount = nDstYCount;
+                sJob.bNoDataMaskFullyOpaque = false;
+
                 // Read the source buffers.
                 eErr = RasterIO(GF_Read, nChunkXOffQueried, nChunkYOffQueried,
-                                nChunkXSizeQueried, nChunkYSizeQueried, pChunk,
                                 nChunkXSizeQueried, nChunkYSizeQueried,
-                                eWrkDataType, 0, 0, nullptr);
+                                sJob.pChunk, nChunkXSizeQueried,
+                                nChunkYSizeQueried, eWrkDataType, 0, 0,
+                                nullptr);
 
                 bool bSkipResample = false;
-                bool bNoDataMaskFullyOpaque = false;
                 if (eErr == CE_None && bUseNoDataMask)
                 {
+                    GByte *pabyChunkNoDataMask = sJob.pabyChunkNoDataMask;
                     eErr = poMaskBand->RasterIO(
                         GF_Read, nChunkXOffQueried, nChunkYOffQueried,
                         nChunkXSizeQueried, nChunkYSizeQueried,
@@ -1405,57 +1609,53 @@ CPLErr GDALRasterBand::RasterIOResampled(
                         }
                         else
                         {
-                            bNoDataMaskFullyOpaque = true;
+                            sJob.bNoDataMaskFullyOpaque = true;
                         }
                     }
                 }
 
-                if (!bSkipResample && eErr == CE_None)
+                if (eErr != CE_None)
+                    break;
+
+                if (bSkipResample)
                 {
-                    const bool bPropagateNoData = false;
-                    void *pDstBuffer = nullptr;
-                    GDALDataType eDstBufferDataType = GDT_Unknown;
-                    GDALRasterBand *poMEMBand =
-                        GDALRasterBand::FromHandle(hMEMBand);
-                    eErr = pfnResampleFunc(
-                        dfXRatioDstToSrc, dfYRatioDstToSrc,
-                        dfXOff - nXOff, /* == 0 if bHasXOffVirtual */
-                        dfYOff - nYOff, /* == 0 if bHasYOffVirtual */
-                        eWrkDataType, pChunk,
-                        bNoDataMaskFullyOpaque ? nullptr : pabyChunkNoDataMask,
-                        nChunkXOffQueried - (bHasXOffVirtual ? 0 : nXOff),
-                        nChunkXSizeQueried,
-                        nChunkYOffQueried - (bHasYOffVirtual ? 0 : nYOff),
-                        nChunkYSizeQueried, nDstXOff + nDestXOffVirtual,
-                        nDstXOff + nDestXOffVirtual + nDstXCount,
-                        nDstYOff + nDestYOffVirtual,
-                        nDstYOff + nDestYOffVirtual + nDstYCount, poMEMBand,
-                        &pDstBuffer, &eDstBufferDataType, pszResampling,
-                        bHasNoData, dfNoDataValue, GetColorTable(), eDataType,
-                        bPropagateNoData);
-                    if (eErr == CE_None)
+                    nBlocksDone++;
+                    if (psExtraArg->pfnProgress != nullptr &&
+                        !psExtraArg->pfnProgress(1.0 * nBlocksDone /
+                                                     nTotalBlocks,
+                                                 "", psExtraArg->pProgressData))
                     {
-                        eErr = poMEMBand->RasterIO(
-                            GF_Write, nDstXOff + nDestXOffVirtual,
-                            nDstYOff + nDestYOffVirtual, nDstXCount, nDstYCount,
-                            pDstBuffer, nDstXCount, nDstYCount,
-                            eDstBufferDataType, 0, 0, nullptr);
+                        eErr = CE_Failure;
                     }
-                    CPLFree(pDstBuffer);
                 }
-
-                nBlocksDone++;
-                if (eErr == CE_None && psExtraArg->pfnProgress != nullptr &&
-                    !psExtraArg->pfnProgress(1.0 * nBlocksDone / nTotalBlocks,
-                                             "", psExtraArg->pProgressData))
+                else if (poJobQueue)
                 {
-                    eErr = CE_Failure;
+                    sJob.pfnResample = &Resample;
+                    if (poJobQueue->SubmitJob(ResampleJobFunc, &sJob))
+                    {
+                        apoJobs.emplace_back(std::move(poNewJob));
+                    }
+                    else
+                    {
+                        Resample(sJob);
+                        eErr = FinalizeJob(sJob);
+                    }
+                }
+                else
+                {
+                    Resample(sJob);
+                    eErr = FinalizeJob(sJob);
                 }
             }
         }
 
-        CPLFree(pChunk);
-        CPLFree(pabyChunkNoDataMask);
+        if (poJobQueue)
+        {
+            if (eErr == CE_None)
+                eErr = FinalizeFinishedJobs(0);
+            else
+                poJobQueue->WaitCompletion();
+        }
     }
 
     if (eBufType != eDataType)
@@ -1988,6 +2188,20 @@ void CPL_STDCALL GDALSwapWords(void *pData, int nWordSize, int nWordCount,
 
     GByte *pabyData = static_cast<GByte *>(pData);
 
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) &&                                      \
+    (defined(__x86_64) || defined(_M_X64))
+    // Packed buffers: use the AVX2 kernel when available, and let the
+    // generic code below process the remaining words.
+    if (nWordSize > 1 && nWordSkip == nWordSize && nWordCount >= 32 &&
+        CPLHaveRuntimeAVX2())
+    {
+        const size_t nDone = GDALSwapWordsPacked_AVX2(pabyData, nWordSize,
+                                                      nWordCount);
+        pabyData += nDone * nWordSize;
+        nWordCount -= static_cast<int>(nDone);
+    }
+#endif
+
     switch (nWordSize)
     {
         case 1:
@@ -3051,6 +3265,12 @@ static inline void GDALUnrolledCopy(T *CPL_RESTRICT pDest,
 
 #endif
 
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+
+#include "rasterio_avx2.h"
+
+#endif
+
 template <>
 void GDALUnrolledCopy<GByte, 2, 1>(GByte *CPL_RESTRICT pDest,
                                    const GByte *CPL_RESTRICT pSrc,
@@ -3417,6 +3637,26 @@ void CPL_STDCALL GDALCopyWords64(const void *CPL_RESTRICT pSrcData,
         }
     }
 
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) &&                                      \
+    (defined(__x86_64) || defined(_M_X64))
+    // Packed buffers: use the AVX2 kernels when available, and let the
+    // generic code below process the remaining words.
+    if (eSrcType != eDstType && nSrcPixelStride == nSrcDataTypeSize &&
+        nDstPixelStride == nDstDataTypeSize && nWordCount >= 16 &&
+        CPLHaveRuntimeAVX2())
+    {
+        const size_t nDone = GDALCopyWordsPacked_AVX2(
+            pSrcData, eSrcType, pDstData, eDstType,
+            static_cast<size_t>(nWordCount));
+        if (nDone == static_cast<size_t>(nWordCount))
+            return;
+        pSrcData = static_cast<const GByte *>(pSrcData) +
+                   nDone * nSrcDataTypeSize;
+        pDstData = static_cast<GByte *>(pDstData) + nDone * nDstDataTypeSize;
+        nWordCount -= static_cast<GPtrDiff_t>(nDone);
+    }
+#endif
+
     // Handle the more general case -- deals with conversion of data types
     // directly.
     switch (eSrcType)
@@ -4536,6 +4776,174 @@ static void GDALCopyWholeRasterGetSwathSize(GDALRasterBand *poSrcPrototypeBand,
     *pnSwathLines = nSwathLines;
 }
 
+/************************************************************************/
+/*                    GDALCopyWholeRasterPipeline                       */
+/************************************************************************/
+
+namespace
+{
+/** Double-buffered swath copy: the next swath is read from the source
+ * dataset in a worker thread, while the current one is written to the
+ * destination dataset by the calling thread.
+ */
+class GDALCopyWholeRasterPipeline
+{
+    struct Swath
+    {
+        GDALCopyWholeRasterPipeline *poPipeline = nullptr;
+        void *pBuffer = nullptr;
+        int nXOff = 0;
+        int nYOff = 0;
+        int nXSize = 0;
+        int nYSize = 0;
+        int nBand = 0;  // 0 means all bands (pixel interleaved case)
+        CPLErr eErr = CE_None;
+        std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+    };
+
+    GDALDataset *const m_poSrcDS;
+    GDALDataset *const m_poDstDS;
+    const GDALDataType m_eDT;
+    const int m_nBandCount;
+    std::array<void *, 2> m_apBuffers{{nullptr, nullptr}};
+    std::array<Swath, 2> m_asSwaths{};
+    int m_iPending = -1;  // index in m_asSwaths of the swath being read
+    // Must be declared after the buffers and swaths, so that the job is
+    // completed before they are destroyed.
+    std::unique_ptr<CPLJobQueue> m_poJobQueue{};
+
+    static void ReadJob(void *pData);
+    CPLErr WaitPendingRead();
+    CPLErr Write(const Swath &sSwath);
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALCopyWholeRasterPipeline)
+
+  public:
+    GDALCopyWholeRasterPipeline(GDALDataset *poSrcDS, GDALDataset *poDstDS,
+                                GDALDataType eDT, int nBandCount)
+        : m_poSrcDS(poSrcDS), m_poDstDS(poDstDS), m_eDT(eDT),
+          m_nBandCount(nBandCount)
+    {
+    }
+
+    ~GDALCopyWholeRasterPipeline();
+
+    bool Init(size_t nSwathBufSize);
+
+    CPLErr Submit(int nXOff, int nYOff, int nXSize, int nYSize, int nBand);
+    CPLErr Flush();
+
+    bool HasPending() const
+    {
+        return m_iPending >= 0;
+    }
+};
+
+GDALCopyWholeRasterPipeline::~GDALCopyWholeRasterPipeline()
+{
+    if (m_poJobQueue)
+        m_poJobQueue->WaitCompletion();
+    VSIFree(m_apBuffers[0]);
+    VSIFree(m_apBuffers[1]);
+}
+
+bool GDALCopyWholeRasterPipeline::Init(size_t nSwathBufSize)
+{
+    auto poPool = GDALGetGlobalThreadPool(1);
+    if (!poPool)
+        return false;
+    for (auto &pBuffer : m_apBuffers)
+    {
+        pBuffer = VSI_MALLOC_VERBOSE(nSwathBufSize);
+        if (!pBuffer)
+            return false;
+    }
+    m_poJobQueue = poPool->CreateJobQueue();
+    return true;
+}
+
+void GDALCopyWholeRasterPipeline::ReadJob(void *pData)
+{
+    Swath *psSwath = static_cast<Swath *>(pData);
+    const auto poPipeline = psSwath->poPipeline;
+    CPLInstallErrorHandlerAccumulator(psSwath->aoErrors);
+    psSwath->eErr = poPipeline->m_poSrcDS->RasterIO(
+        GF_Read, psSwath->nXOff, psSwath->nYOff, psSwath->nXSize,
+        psSwath->nYSize, psSwath->pBuffer, psSwath->nXSize, psSwath->nYSize,
+        poPipeline->m_eDT, psSwath->nBand ? 1 : poPipeline->m_nBandCount,
+        psSwath->nBand ? &psSwath->nBand : nullptr, 0, 0, 0, nullptr);
+    CPLUninstallErrorHandlerAccumulator();
+}
+
+CPLErr GDALCopyWholeRasterPipeline::WaitPendingRead()
+{
+    m_poJobQueue->WaitCompletion();
+    Swath &sSwath = m_asSwaths[m_iPending];
+    for (const auto &oError : sSwath.aoErrors)
+    {
+        CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+    }
+    sSwath.aoErrors.clear();
+    return sSwath.eErr;
+}
+
+CPLErr GDALCopyWholeRasterPipeline::Write(const Swath &sSwath)
+{
+    int nBand = sSwath.nBand;
+    return m_poDstDS->RasterIO(GF_Write, sSwath.nXOff, sSwath.nYOff,
+                               sSwath.nXSize, sSwath.nYSize, sSwath.pBuffer,
+                               sSwath.nXSize, sSwath.nYSize, m_eDT,
+                               nBand ? 1 : m_nBandCount,
+                               nBand ? &nBand : nullptr, 0, 0, 0, nullptr);
+}
+
+/** Start reading the specified swath, and write the previous one. */
+CPLErr GDALCopyWholeRasterPipeline::Submit(int nXOff, int nYOff, int nXSize,
+                                           int nYSize, int nBand)
+{
+    const int iPrevious = m_iPending;
+    if (iPrevious >= 0)
+    {
+        const CPLErr eErr = WaitPendingRead();
+        m_iPending = -1;
+        if (eErr != CE_None)
+            return eErr;
+    }
+
+    const int iCur = iPrevious >= 0 ? 1 - iPrevious : 0;
+    Swath &sSwath = m_asSwaths[iCur];
+    sSwath.poPipeline = this;
+    sSwath.pBuffer = m_apBuffers[iCur];
+    sSwath.nXOff = nXOff;
+    sSwath.nYOff = nYOff;
+    sSwath.nXSize = nXSize;
+    sSwath.nYSize = nYSize;
+    sSwath.nBand = nBand;
+    sSwath.eErr = CE_None;
+    if (!m_poJobQueue->SubmitJob(ReadJob, &sSwath))
+        ReadJob(&sSwath);
+    m_iPending = iCur;
+
+    if (iPrevious >= 0)
+        return Write(m_asSwaths[iPrevious]);
+    return CE_None;
+}
+
+/** Wait for the swath being read, and write it. */
+CPLErr GDALCopyWholeRasterPipeline::Flush()
+{
+    if (m_iPending < 0)
+        return CE_None;
+    const int iPending = m_iPending;
+    CPLErr eErr = WaitPendingRead();
+    m_iPending = -1;
+    if (eErr == CE_None)
+        eErr = Write(m_asSwaths[iPending]);
+    return eErr;
+}
+
+}  // namespace
+
 /************************************************************************/
 /*                     GDALDatasetCopyWholeRaster()                     */
 /************************************************************************/
@@ -4680,15 +5088,39 @@ CPLErr CPL_STDCALL GDALDatasetCopyWholeRaster(GDALDatasetH hSrcDS,
     if (bInterleave)
         nPixelSize *= nBandCount;
 
-    void *pSwathBuf = VSI_MALLOC3_VERBOSE(nSwathCols, nSwathLines, nPixelSize);
-    if (pSwathBuf == nullptr)
+    // If asked for, read the next swath while the current one is written,
+    // when there are several swaths.
+    std::unique_ptr<GDALCopyWholeRasterPipeline> poPipeline;
+    if (CPLTestBool(
+            CPLGetConfigOption("GDAL_COPY_WHOLE_RASTER_PIPELINE", "NO")) &&
+        poSrcDS != poDstDS &&
+        (nSwathLines < nYSize || nSwathCols < nXSize ||
+         (!bInterleave && nBandCount > 1)))
+    {
+        poPipeline = std::make_unique<GDALCopyWholeRasterPipeline>(
+            poSrcDS, poDstDS, eDT, nBandCount);
+        if (!poPipeline->Init(static_cast<size_t>(nSwathCols) * nSwathLines *
+                              nPixelSize))
+        {
+            poPipeline.reset();
+        }
+    }
+
+    void *pSwathBuf = nullptr;
+    if (!poPipeline)
     {
-        return CE_Failure;
+        pSwathBuf = VSI_MALLOC3_VERBOSE(nSwathCols, nSwathLines, nPixelSize);
+        if (pSwathBuf == nullptr)
+        {
+            return CE_Failure;
+        }
     }
 
     CPLDebug("GDAL",
-             "GDALDatasetCopyWholeRaster(): %d*%d swaths, bInterleave=%d",
-             nSwathCols, nSwathLines, static_cast<int>(bInterleave));
+             "GDALDatasetCopyWholeRaster(): %d*%d swaths, bInterleave=%d, "
+             "bPipelined=%d",
+             nSwathCols, nSwathLines, static_cast<int>(bInterleave),
+             static_cast<int>(poPipeline != nullptr));
 
     // Advise the source raster that we are going to read it completely
     // Note: this might already have been done by GDALCreateCopy() in the
@@ -4741,7 +5173,13 @@ CPLErr CPL_STDCALL GDALDatasetCopyWholeRaster(GDALDatasetH hSrcDS,
                                           iX, iY, nThisCols, nThisLines,
                                           GDAL_DATA_COVERAGE_STATUS_DATA);
                     }
-                    if (nStatus & GDAL_DATA_COVERAGE_STATUS_DATA)
+                    if (poPipeline &&
+                        (nStatus & GDAL_DATA_COVERAGE_STATUS_DATA))
+                    {
+                        eErr = poPipeline->Submit(iX, iY, nThisCols,
+                                                  nThisLines, nBand);
+                    }
+                    else if (nStatus & GDAL_DATA_COVERAGE_STATUS_DATA)
                     {
                         sExtraArg.pfnProgress = GDALScaledProgress;
                         sExtraArg.pProgressData = GDALCreateScaledProgress(
@@ -4767,8 +5205,12 @@ CPLErr CPL_STDCALL GDALDatasetCopyWholeRaster(GDALDatasetH hSrcDS,
                     }
 
                     nBlocksDone++;
+                    // The last submitted swath is not written yet
+                    const GIntBig nBlocksWritten =
+                        nBlocksDone -
+                        (poPipeline && poPipeline->HasPending() ? 1 : 0);
                     if (eErr == CE_None &&
-                        !pfnProgress(nBlocksDone /
+                        !pfnProgress(nBlocksWritten /
                                          static_cast<double>(nTotalBlocks),
                                      nullptr, pProgressData))
                     {
@@ -4822,7 +5264,12 @@ CPLErr CPL_STDCALL GDALDatasetCopyWholeRaster(GDALDatasetH hSrcDS,
                             break;
                     }
                 }
-                if (nStatus & GDAL_DATA_COVERAGE_STATUS_DATA)
+                if (poPipeline && (nStatus & GDAL_DATA_COVERAGE_STATUS_DATA))
+                {
+                    eErr = poPipeline->Submit(iX, iY, nThisCols, nThisLines,
+                                              /* nBand = */ 0);
+                }
+                else if (nStatus & GDAL_DATA_COVERAGE_STATUS_DATA)
                 {
                     sExtraArg.pfnProgress = GDALScaledProgress;
                     sExtraArg.pProgressData = GDALCreateScaledProgress(
@@ -4847,8 +5294,12 @@ CPLErr CPL_STDCALL GDALDatasetCopyWholeRaster(GDALDatasetH hSrcDS,
                 }
 
                 nBlocksDone++;
+                // The last submitted swath is not written yet
+                const GIntBig nBlocksWritten =
+                    nBlocksDone -
+                    (poPipeline && poPipeline->HasPending() ? 1 : 0);
                 if (eErr == CE_None &&
-                    !pfnProgress(nBlocksDone /
+                    !pfnProgress(nBlocksWritten /
                                      static_cast<double>(nTotalBlocks),
                                  nullptr, pProgressData))
                 {
@@ -4860,6 +5311,20 @@ CPLErr CPL_STDCALL GDALDatasetCopyWholeRaster(GDALDatasetH hSrcDS,
         }
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Write the last swath of the pipeline.                           */
+    /* -------------------------------------------------------------------- */
+    if (poPipeline && eErr == CE_None)
+    {
+        eErr = poPipeline->Flush();
+        if (eErr == CE_None && !pfnProgress(1.0, nullptr, pProgressData))
+        {
+            eErr = CE_Failure;
+            CPLError(CE_Failure, CPLE_UserInterrupt,
+                     "User terminated CreateCopy()");
+        }
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Cleanup                                                         */
     /* -------------------------------------------------------------------- */
@@ -0,0 +1,642 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX2 specializations of GDALCopyWords and GDALSwapWords
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) &&                                      \
+    (defined(__x86_64) || defined(_M_X64))
+
+#include "rasterio_avx2.h"
+
+#include <immintrin.h>
+
+#include <cfloat>
+#include <cmath>
+
+// This file is compiled with AVX2 enabled. To avoid the compiler emitting
+// AVX2 instructions in inline functions or template instantiations that
+// could be shared with other translation units, everything here is written
+// with explicit intrinsics and has internal linkage.
+
+namespace
+{
+
+/************************************************************************/
+/*                        Load / store helpers                          */
+/************************************************************************/
+
+inline __m256i Load256(const void *p)
+{
+    return _mm256_loadu_si256(static_cast<const __m256i *>(p));
+}
+
+inline __m128i Load128(const void *p)
+{
+    return _mm_loadu_si128(static_cast<const __m128i *>(p));
+}
+
+inline __m128i Load64(const void *p)
+{
+    return _mm_loadl_epi64(static_cast<const __m128i *>(p));
+}
+
+inline void Store256(void *p, __m256i v)
+{
+    _mm256_storeu_si256(static_cast<__m256i *>(p), v);
+}
+
+inline void Store128(void *p, __m128i v)
+{
+    _mm_storeu_si128(static_cast<__m128i *>(p), v);
+}
+
+/************************************************************************/
+/*                         Narrowing of Int32                           */
+/************************************************************************/
+
+// Packs 2 x 8 Int32 values into 16 values, saturated to the target range.
+
+inline __m256i PackInt32ToInt16(__m256i a, __m256i b)
+{
+    // _mm256_packs_epi32() works on each 128-bit lane, so fix the ordering
+    return _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b),
+                                    0 | (2 << 2) | (1 << 4) | (3 << 6));
+}
+
+inline __m256i PackInt32ToUInt16(__m256i a, __m256i b)
+{
+    return _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b),
+                                    0 | (2 << 2) | (1 << 4) | (3 << 6));
+}
+
+inline __m128i PackInt16ToByte(__m256i v)
+{
+    return _mm_packus_epi16(_mm256_castsi256_si128(v),
+                            _mm256_extracti128_si256(v, 1));
+}
+
+inline __m128i PackInt32ToByte(__m256i a, __m256i b)
+{
+    return PackInt16ToByte(PackInt32ToInt16(a, b));
+}
+
+/************************************************************************/
+/*                  Rounding of floating-point values                   */
+/************************************************************************/
+
+// The following functions implement the rounding and clamping of
+// GDALCopyWord() for floating-point to integer conversions, and return the
+// result as Int32 values.
+
+// Unsigned output types: NaN maps to 0, other values are rounded to the
+// nearest integer and clamped to [0, fMax].
+inline __m256i RoundUnsigned(__m256 v, float fMax)
+{
+    const __m256 p0d5 = _mm256_set1_ps(0.5f);
+    v = _mm256_add_ps(v, p0d5);
+    // _mm256_max_ps() returns its second operand when the first one is NaN
+    v = _mm256_min_ps(_mm256_max_ps(v, p0d5), _mm256_set1_ps(fMax));
+    return _mm256_cvttps_epi32(v);
+}
+
+inline __m128i RoundUnsigned(__m256d v, double dfMax)
+{
+    const __m256d p0d5 = _mm256_set1_pd(0.5);
+    v = _mm256_add_pd(v, p0d5);
+    v = _mm256_min_pd(_mm256_max_pd(v, p0d5), _mm256_set1_pd(dfMax));
+    return _mm256_cvttpd_epi32(v);
+}
+
+// Int16 output type: NaN maps to 0, other values are rounded half away from
+// zero and clamped to [-32768, 32767].
+inline __m256i RoundInt16(__m256 v)
+{
+    v = _mm256_and_ps(v, _mm256_cmp_ps(v, v, _CMP_ORD_Q));
+    const __m256 mask = _mm256_cmp_ps(v, _mm256_setzero_ps(), _CMP_GE_OQ);
+    v = _mm256_add_ps(v, _mm256_blendv_ps(_mm256_set1_ps(-0.5f),
+                                          _mm256_set1_ps(0.5f), mask));
+    v = _mm256_min_ps(_mm256_max_ps(v, _mm256_set1_ps(-32768.0f)),
+                      _mm256_set1_ps(32767.0f));
+    return _mm256_cvttps_epi32(v);
+}
+
+inline __m128i RoundInt16(__m256d v)
+{
+    v = _mm256_and_pd(v, _mm256_cmp_pd(v, v, _CMP_ORD_Q));
+    const __m256d mask = _mm256_cmp_pd(v, _mm256_setzero_pd(), _CMP_GT_OQ);
+    v = _mm256_add_pd(v, _mm256_blendv_pd(_mm256_set1_pd(-0.5),
+                                          _mm256_set1_pd(0.5), mask));
+    v = _mm256_min_pd(_mm256_max_pd(v, _mm256_set1_pd(-32768.0)),
+                      _mm256_set1_pd(32767.0));
+    return _mm256_cvttpd_epi32(v);
+}
+
+inline __m256i Concat(__m128i lo, __m128i hi)
+{
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+/************************************************************************/
+/*                              Kernels                                 */
+/************************************************************************/
+
+// Each kernel converts 16 consecutive values.
+
+// Float32 source
+
+void Float32ToByte(const void *pSrc, void *pDst)
+{
+    const float *p = static_cast<const float *>(pSrc);
+    const __m256i a = RoundUnsigned(_mm256_loadu_ps(p), 255.0f);
+    const __m256i b = RoundUnsigned(_mm256_loadu_ps(p + 8), 255.0f);
+    Store128(pDst, PackInt32ToByte(a, b));
+}
+
+void Float32ToUInt16(const void *pSrc, void *pDst)
+{
+    const float *p = static_cast<const float *>(pSrc);
+    const __m256i a = RoundUnsigned(_mm256_loadu_ps(p), 65535.0f);
+    const __m256i b = RoundUnsigned(_mm256_loadu_ps(p + 8), 65535.0f);
+    Store256(pDst, PackInt32ToUInt16(a, b));
+}
+
+void Float32ToInt16(const void *pSrc, void *pDst)
+{
+    const float *p = static_cast<const float *>(pSrc);
+    const __m256i a = RoundInt16(_mm256_loadu_ps(p));
+    const __m256i b = RoundInt16(_mm256_loadu_ps(p + 8));
+    Store256(pDst, PackInt32ToInt16(a, b));
+}
+
+void Float32ToFloat64(const void *pSrc, void *pDst)
+{
+    const float *p = static_cast<const float *>(pSrc);
+    double *q = static_cast<double *>(pDst);
+    for (int i = 0; i < 16; i += 4)
+        _mm256_storeu_pd(q + i, _mm256_cvtps_pd(_mm_loadu_ps(p + i)));
+}
+
+// Float64 source
+
+void Float64ToByte(const void *pSrc, void *pDst)
+{
+    const double *p = static_cast<const double *>(pSrc);
+    const __m256i a = Concat(RoundUnsigned(_mm256_loadu_pd(p), 255.0),
+                             RoundUnsigned(_mm256_loadu_pd(p + 4), 255.0));
+    const __m256i b = Concat(RoundUnsigned(_mm256_loadu_pd(p + 8), 255.0),
+                             RoundUnsigned(_mm256_loadu_pd(p + 12), 255.0));
+    Store128(pDst, PackInt32ToByte(a, b));
+}
+
+void Float64ToUInt16(const void *pSrc, void *pDst)
+{
+    const double *p = static_cast<const double *>(pSrc);
+    const __m256i a = Concat(RoundUnsigned(_mm256_loadu_pd(p), 65535.0),
+                             RoundUnsigned(_mm256_loadu_pd(p + 4), 65535.0));
+    const __m256i b =
+        Concat(RoundUnsigned(_mm256_loadu_pd(p + 8), 65535.0),
+               RoundUnsigned(_mm256_loadu_pd(p + 12), 65535.0));
+    Store256(pDst, PackInt32ToUInt16(a, b));
+}
+
+void Float64ToInt16(const void *pSrc, void *pDst)
+{
+    const double *p = static_cast<const double *>(pSrc);
+    const __m256i a = Concat(RoundInt16(_mm256_loadu_pd(p)),
+                             RoundInt16(_mm256_loadu_pd(p + 4)));
+    const __m256i b = Concat(RoundInt16(_mm256_loadu_pd(p + 8)),
+                             RoundInt16(_mm256_loadu_pd(p + 12)));
+    Store256(pDst, PackInt32ToInt16(a, b));
+}
+
+void Float64ToFloat32(const void *pSrc, void *pDst)
+{
+    const double *p = static_cast<const double *>(pSrc);
+    float *q = static_cast<float *>(pDst);
+    const __m256d fltMax = _mm256_set1_pd(FLT_MAX);
+    const __m256d fltMin = _mm256_set1_pd(-FLT_MAX);
+    const __m256d posInf = _mm256_set1_pd(HUGE_VAL);
+    const __m256d negInf = _mm256_set1_pd(-HUGE_VAL);
+    for (int i = 0; i < 16; i += 4)
+    {
+        // Values out of the Float32 range map to infinity
+        __m256d v = _mm256_loadu_pd(p + i);
+        v = _mm256_blendv_pd(v, posInf, _mm256_cmp_pd(v, fltMax, _CMP_GT_OQ));
+        v = _mm256_blendv_pd(v, negInf, _mm256_cmp_pd(v, fltMin, _CMP_LT_OQ));
+        _mm_storeu_ps(q + i, _mm256_cvtpd_ps(v));
+    }
+}
+
+// Integer source
+
+// Loads 8 integer values of nSrcSize bytes and widens them to Int32
+template <int nSrcSize, bool bSigned>
+inline __m256i LoadAsInt32(const GByte *p)
+{
+    if (nSrcSize == 1)
+        return _mm256_cvtepu8_epi32(Load64(p));
+    return bSigned ? _mm256_cvtepi16_epi32(Load128(p))
+                   : _mm256_cvtepu16_epi32(Load128(p));
+}
+
+template <int nSrcSize, bool bSigned>
+void IntegerToFloat32(const void *pSrc, void *pDst)
+{
+    const GByte *p = static_cast<const GByte *>(pSrc);
+    float *q = static_cast<float *>(pDst);
+    for (int i = 0; i < 16; i += 8)
+    {
+        const __m256i v = LoadAsInt32<nSrcSize, bSigned>(p + i * nSrcSize);
+        _mm256_storeu_ps(q + i, _mm256_cvtepi32_ps(v));
+    }
+}
+
+template <int nSrcSize, bool bSigned>
+void IntegerToFloat64(const void *pSrc, void *pDst)
+{
+    const GByte *p = static_cast<const GByte *>(pSrc);
+    double *q = static_cast<double *>(pDst);
+    for (int i = 0; i < 16; i += 8)
+    {
+        const __m256i v = LoadAsInt32<nSrcSize, bSigned>(p + i * nSrcSize);
+        _mm256_storeu_pd(q + i,
+                         _mm256_cvtepi32_pd(_mm256_castsi256_si128(v)));
+        _mm256_storeu_pd(q + i + 4,
+                         _mm256_cvtepi32_pd(_mm256_extracti128_si256(v, 1)));
+    }
+}
+
+void ByteToFloat32(const void *pSrc, void *pDst)
+{
+    IntegerToFloat32<1, false>(pSrc, pDst);
+}
+
+void UInt16ToFloat32(const void *pSrc, void *pDst)
+{
+    IntegerToFloat32<2, false>(pSrc, pDst);
+}
+
+void Int16ToFloat32(const void *pSrc, void *pDst)
+{
+    IntegerToFloat32<2, true>(pSrc, pDst);
+}
+
+void ByteToFloat64(const void *pSrc, void *pDst)
+{
+    IntegerToFloat64<1, false>(pSrc, pDst);
+}
+
+void UInt16ToFloat64(const void *pSrc, void *pDst)
+{
+    IntegerToFloat64<2, false>(pSrc, pDst);
+}
+
+void Int16ToFloat64(const void *pSrc, void *pDst)
+{
+    IntegerToFloat64<2, true>(pSrc, pDst);
+}
+
+void Int32ToFloat32(const void *pSrc, void *pDst)
+{
+    const GByte *p = static_cast<const GByte *>(pSrc);
+    float *q = static_cast<float *>(pDst);
+    _mm256_storeu_ps(q, _mm256_cvtepi32_ps(Load256(p)));
+    _mm256_storeu_ps(q + 8, _mm256_cvtepi32_ps(Load256(p + 32)));
+}
+
+void Int32ToFloat64(const void *pSrc, void *pDst)
+{
+    const GByte *p = static_cast<const GByte *>(pSrc);
+    double *q = static_cast<double *>(pDst);
+    for (int i = 0; i < 16; i += 4)
+        _mm256_storeu_pd(q + i, _mm256_cvtepi32_pd(Load128(p + i * 4)));
+}
+
+void ByteToUInt16(const void *pSrc, void *pDst)
+{
+    Store256(pDst, _mm256_cvtepu8_epi16(Load128(pSrc)));
+}
+
+void ByteToInt32(const void *pSrc, void *pDst)
+{
+    const GByte *p = static_cast<const GByte *>(pSrc);
+    GByte *q = static_cast<GByte *>(pDst);
+    Store256(q, _mm256_cvtepu8_epi32(Load64(p)));
+    Store256(q + 32, _mm256_cvtepu8_epi32(Load64(p + 8)));
+}
+
+void ByteToInt8(const void *pSrc, void *pDst)
+{
+    Store128(pDst, _mm_min_epu8(Load128(pSrc), _mm_set1_epi8(127)));
+}
+
+void Int8ToByte(const void *pSrc, void *pDst)
+{
+    Store128(pDst, _mm_max_epi8(Load128(pSrc), _mm_setzero_si128()));
+}
+
+void UInt16ToByte(const void *pSrc, void *pDst)
+{
+    const __m256i v = _mm256_min_epu16(Load256(pSrc), _mm256_set1_epi16(255));
+    Store128(pDst, PackInt16ToByte(v));
+}
+
+void UInt16ToInt16(const void *pSrc, void *pDst)
+{
+    Store256(pDst,
+             _mm256_min_epu16(Load256(pSrc), _mm256_set1_epi16(32767)));
+}
+
+void UInt16ToInt32(const void *pSrc, void *pDst)
+{
+    const GByte *p = static_cast<const GByte *>(pSrc);
+    GByte *q = static_cast<GByte *>(pDst);
+    Store256(q, _mm256_cvtepu16_epi32(Load128(p)));
+    Store256(q + 32, _mm256_cvtepu16_epi32(Load128(p + 16)));
+}
+
+void Int16ToByte(const void *pSrc, void *pDst)
+{
+    Store128(pDst, PackInt16ToByte(Load256(pSrc)));
+}
+
+void Int16ToUInt16(const void *pSrc, void *pDst)
+{
+    Store256(pDst, _mm256_max_epi16(Load256(pSrc), _mm256_setzero_si256()));
+}
+
+void Int16ToInt32(const void *pSrc, void *pDst)
+{
+    const GByte *p = static_cast<const GByte *>(pSrc);
+    GByte *q = static_cast<GByte *>(pDst);
+    Store256(q, _mm256_cvtepi16_epi32(Load128(p)));
+    Store256(q + 32, _mm256_cvtepi16_epi32(Load128(p + 16)));
+}
+
+void Int32ToByte(const void *pSrc, void *pDst)
+{
+    const GByte *p = static_cast<const GByte *>(pSrc);
+    Store128(pDst, PackInt32ToByte(Load256(p), Load256(p + 32)));
+}
+
+void Int32ToUInt16(const void *pSrc, void *pDst)
+{
+    const GByte *p = static_cast<const GByte *>(pSrc);
+    Store256(pDst, PackInt32ToUInt16(Load256(p), Load256(p + 32)));
+}
+
+void Int32ToInt16(const void *pSrc, void *pDst)
+{
+    const GByte *p = static_cast<const GByte *>(pSrc);
+    Store256(pDst, PackInt32ToInt16(Load256(p), Load256(p + 32)));
+}
+
+/************************************************************************/
+/*                            GetKernel()                               */
+/************************************************************************/
+
+typedef void (*KernelFunc)(const void *pSrc, void *pDst);
+
+KernelFunc GetKernel(GDALDataType eSrcType, GDALDataType eDstType)
+{
+    switch (eSrcType)
+    {
+        case GDT_Byte:
+            switch (eDstType)
+            {
+                case GDT_Int8:
+                    return ByteToInt8;
+                case GDT_UInt16:
+                case GDT_Int16:
+                    return ByteToUInt16;
+                case GDT_UInt32:
+                case GDT_Int32:
+                    return ByteToInt32;
+                case GDT_Float32:
+                    return ByteToFloat32;
+                case GDT_Float64:
+                    return ByteToFloat64;
+                default:
+                    break;
+            }
+            break;
+
+        case GDT_Int8:
+            if (eDstType == GDT_Byte)
+                return Int8ToByte;
+            break;
+
+        case GDT_UInt16:
+            switch (eDstType)
+            {
+                case GDT_Byte:
+                    return UInt16ToByte;
+                case GDT_Int16:
+                    return UInt16ToInt16;
+                case GDT_UInt32:
+                case GDT_Int32:
+                    return UInt16ToInt32;
+                case GDT_Float32:
+                    return UInt16ToFloat32;
+                case GDT_Float64:
+                    return UInt16ToFloat64;
+                default:
+                    break;
+            }
+            break;
+
+        case GDT_Int16:
+            switch (eDstType)
+            {
+                case GDT_Byte:
+                    return Int16ToByte;
+                case GDT_UInt16:
+                    return Int16ToUInt16;
+                case GDT_Int32:
+                    return Int16ToInt32;
+                case GDT_Float32:
+                    return Int16ToFloat32;
+                case GDT_Float64:
+                    return Int16ToFloat64;
+                default:
+                    break;
+            }
+            break;
+
+        case GDT_Int32:
+            switch (eDstType)
+            {
+                case GDT_Byte:
+                    return Int32ToByte;
+                case GDT_UInt16:
+                    return Int32ToUInt16;
+                case GDT_Int16:
+                    return Int32ToInt16;
+                case GDT_Float32:
+                    return Int32ToFloat32;
+                case GDT_Float64:
+                    return Int32ToFloat64;
+                default:
+                    break;
+            }
+            break;
+
+        case GDT_Float32:
+            switch (eDstType)
+            {
+                case GDT_Byte:
+                    return Float32ToByte;
+                case GDT_UInt16:
+                    return Float32ToUInt16;
+                case GDT_Int16:
+                    return Float32ToInt16;
+                case GDT_Float64:
+                    return Float32ToFloat64;
+                default:
+                    break;
+            }
+            break;
+
+        case GDT_Float64:
+            switch (eDstType)
+            {
+                case GDT_Byte:
+                    return Float64ToByte;
+                case GDT_UInt16:
+                    return Float64ToUInt16;
+                case GDT_Int16:
+                    return Float64ToInt16;
+                case GDT_Float32:
+                    return Float64ToFloat32;
+                default:
+                    break;
+            }
+            break;
+
+        default:
+            break;
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                      GDALCopyWordsPacked_AVX2()                      */
+/************************************************************************/
+
+size_t GDALCopyWordsPacked_AVX2(const void *CPL_RESTRICT pSrcData,
+                                GDALDataType eSrcType,
+                                void *CPL_RESTRICT pDstData,
+                                GDALDataType eDstType, size_t nWordCount)
+{
+    // Complex to complex conversions are done on the real and imaginary
+    // parts independently.
+    size_t nComponents = 1;
+    if (GDALDataTypeIsComplex(eSrcType) || GDALDataTypeIsComplex(eDstType))
+    {
+        if (!GDALDataTypeIsComplex(eSrcType) ||
+            !GDALDataTypeIsComplex(eDstType))
+            return 0;
+        eSrcType = GDALGetNonComplexDataType(eSrcType);
+        eDstType = GDALGetNonComplexDataType(eDstType);
+        nComponents = 2;
+    }
+
+    const KernelFunc pfnKernel = GetKernel(eSrcType, eDstType);
+    if (pfnKernel == nullptr)
+        return 0;
+
+    const GByte *pabySrc = static_cast<const GByte *>(pSrcData);
+    GByte *pabyDst = static_cast<GByte *>(pDstData);
+    const size_t nSrcStep = 16 * GDALGetDataTypeSizeBytes(eSrcType);
+    const size_t nDstStep = 16 * GDALGetDataTypeSizeBytes(eDstType);
+    const size_t nValues = nWordCount * nComponents;
+    size_t i = 0;
+    for (; i + 16 <= nValues; i += 16)
+    {
+        pfnKernel(pabySrc, pabyDst);
+        pabySrc += nSrcStep;
+        pabyDst += nDstStep;
+    }
+
+    // 16 is even, so this is a whole number of complex values
+    return i / nComponents;
+}
+
+/************************************************************************/
+/*                      GDALSwapWordsPacked_AVX2()                      */
+/************************************************************************/
+
+size_t GDALSwapWordsPacked_AVX2(void *pData, int nWordSize, size_t nWordCount)
+{
+    __m256i mask;
+    if (nWordSize == 2)
+    {
+        mask = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12,
+                                15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10,
+                                13, 12, 15, 14);
+    }
+    else if (nWordSize == 4)
+    {
+        mask = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14,
+                                13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8,
+                                15, 14, 13, 12);
+    }
+    else if (nWordSize == 8)
+    {
+        mask = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10,
+                                9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12,
+                                11, 10, 9, 8);
+    }
+    else
+    {
+        return 0;
+    }
+
+    // _mm256_shuffle_epi8() operates within each 128-bit lane, which is
+    // fine since words never straddle lanes.
+    GByte *pabyData = static_cast<GByte *>(pData);
+    const size_t nBytes = nWordCount * nWordSize;
+    size_t i = 0;
+    for (; i + 64 <= nBytes; i += 64)
+    {
+        const __m256i v0 = Load256(pabyData + i);
+        const __m256i v1 = Load256(pabyData + i + 32);
+        Store256(pabyData + i, _mm256_shuffle_epi8(v0, mask));
+        Store256(pabyData + i + 32, _mm256_shuffle_epi8(v1, mask));
+    }
+    for (; i + 32 <= nBytes; i += 32)
+    {
+        Store256(pabyData + i,
+                 _mm256_shuffle_epi8(Load256(pabyData + i), mask));
+    }
+    return i / nWordSize;
+}
+
+#endif
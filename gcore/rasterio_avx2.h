@@ -0,0 +1,57 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX2 specializations of GDALCopyWords and GDALSwapWords
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef RASTERIO_AVX2_H_INCLUDED
+#define RASTERIO_AVX2_H_INCLUDED
+
+#include "cpl_port.h"
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) &&                                      \
+    (defined(__x86_64) || defined(_M_X64))
+
+#include "gdal.h"
+
+// Converts the first words of a packed source buffer into a packed
+// destination buffer, with the same rounding and clamping rules as
+// GDALCopyWords(). eSrcType and eDstType must be different.
+// Returns the number of words converted, which may be lower than nWordCount
+// (possibly 0 if the type pair is not handled). The caller is responsible for
+// converting the remaining ones.
+size_t GDALCopyWordsPacked_AVX2(const void *CPL_RESTRICT pSrcData,
+                                GDALDataType eSrcType,
+                                void *CPL_RESTRICT pDstData,
+                                GDALDataType eDstType, size_t nWordCount);
+
+// Byte swaps in place the first words of a packed buffer of 2, 4 or 8 byte
+// words. Returns the number of words swapped, which may be lower than
+// nWordCount. The caller is responsible for swapping the remaining ones.
+size_t GDALSwapWordsPacked_AVX2(void *pData, int nWordSize, size_t nWordCount);
+
+#endif
+
+#endif /* RASTERIO_AVX2_H_INCLUDED */
@@ -464,9 +464,17 @@ void RawRasterBand::DoByteSwap(void *pBuffer, size_t nValues, int nByteSkip,
         if (GDALDataTypeIsComplex(eDataType))
         {
             const int nWordSize = GDALGetDataTypeSize(eDataType) / 16;
-            GDALSwapWordsEx(pBuffer, nWordSize, nValues, nByteSkip);
-            GDALSwapWordsEx(static_cast<GByte *>(pBuffer) + nWordSize,
-                            nWordSize, nValues, nByteSkip);
+            if (nByteSkip == 2 * nWordSize)
+            {
+                // Packed buffer: swap the real and imaginary parts at once.
+                GDALSwapWordsEx(pBuffer, nWordSize, 2 * nValues, nWordSize);
+            }
+            else
+            {
+                GDALSwapWordsEx(pBuffer, nWordSize, nValues, nByteSkip);
+                GDALSwapWordsEx(static_cast<GByte *>(pBuffer) + nWordSize,
+                                nWordSize, nValues, nByteSkip);
+            }
         }
         else
         {
@@ -1610,6 +1618,8 @@ CPLErr RawDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         EQUAL(pszInterleave, "PIXEL"))
     {
         RawRasterBand *poFirstBand = nullptr;
+        // Whether all the bands of a BIP dataset are read, and can be
+        // accessed directly from the file.
         bool bCanDirectAccessToBIPDataset =
             eRWFlag == GF_Read && nBandCount == nBands;
         bool bCanUseDirectIO = true;
@@ -1636,8 +1646,7 @@ CPLErr RawDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                 const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
                 if (poBand->bNeedFileFlush || poBand->bLoadedScanlineDirty ||
                     poBand->HasDirtyBlocks() ||
-                    panBandMap[iBandIndex] != iBandIndex + 1 ||
-                    nPixelSpace != poBand->nPixelOffset)
+                    panBandMap[iBandIndex] != iBandIndex + 1)
                 {
                     bCanDirectAccessToBIPDataset = false;
                 }
@@ -1647,9 +1656,8 @@ CPLErr RawDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                     {
                         poFirstBand = poBand;
                         bCanDirectAccessToBIPDataset =
-                            eDT == eBufType && nBandSpace == nDTSize &&
                             poFirstBand->nPixelOffset ==
-                                cpl::fits_on<int>(nBands * nDTSize);
+                            cpl::fits_on<int>(nBands * nDTSize);
                     }
                     else
                     {
@@ -1668,37 +1676,125 @@ CPLErr RawDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         }
         if (bCanDirectAccessToBIPDataset)
         {
-            CPLDebugOnly("GDALRaw", "Direct access to BIP dataset");
             const auto eDT = poFirstBand->GetRasterDataType();
             const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
-            const bool bNeedsByteOrderChange =
-                poFirstBand->NeedsByteOrderChange();
-            for (int iY = 0; iY < nYSize; ++iY)
+            // Either the buffer has the same layout as the file, or it is
+            // made of one packed line per band, in which case the lines
+            // read from the file are de-interleaved in it.
+            const bool bSameLayout = eDT == eBufType && nBandSpace == nDTSize &&
+                                     nPixelSpace == poFirstBand->nPixelOffset;
+            const bool bDeinterleave =
+                !bSameLayout &&
+                nPixelSpace == GDALGetDataTypeSizeBytes(eBufType);
+            if (bSameLayout || bDeinterleave)
             {
-                GByte *pabyOut = static_cast<GByte *>(pData) + iY * nLineSpace;
-                VSIFSeekL(poFirstBand->fpRawL,
-                          poFirstBand->nImgOffset +
-                              static_cast<vsi_l_offset>(nYOff + iY) *
-                                  poFirstBand->nLineOffset +
-                              static_cast<vsi_l_offset>(nXOff) *
-                                  poFirstBand->nPixelOffset,
-                          SEEK_SET);
-                if (VSIFReadL(pabyOut,
-                              static_cast<size_t>(nXSize * nPixelSpace), 1,
-                              poFirstBand->fpRawL) != 1)
+                CPLDebugOnly("GDALRaw", bSameLayout
+                                            ? "Direct access to BIP dataset"
+                                            : "De-interleaving of BIP dataset");
+                const bool bNeedsByteOrderChange =
+                    poFirstBand->NeedsByteOrderChange();
+                const size_t nLineBytes =
+                    static_cast<size_t>(nXSize) * poFirstBand->nPixelOffset;
+                const vsi_l_offset nStartOffset =
+                    poFirstBand->nImgOffset +
+                    static_cast<vsi_l_offset>(nYOff) *
+                        poFirstBand->nLineOffset +
+                    static_cast<vsi_l_offset>(nXOff) *
+                        poFirstBand->nPixelOffset;
+                // Lines are contiguous in the file when whole lines are
+                // requested and there is no padding between them.
+                const bool bContiguousLines =
+                    poFirstBand->nLineOffset >= 0 &&
+                    static_cast<size_t>(poFirstBand->nLineOffset) ==
+                        nLineBytes;
+
+                const auto ReadLines = [&](int iY, int nLines, GByte *pabyDst,
+                                           GSpacing nDstLineSpace)
+                {
+                    for (int iLine = 0; iLine < nLines;)
+                    {
+                        const int nLinesToRead =
+                            bContiguousLines &&
+                                    static_cast<size_t>(nDstLineSpace) ==
+                                        nLineBytes
+                                ? nLines
+                                : 1;
+                        GByte *pabyOut = pabyDst + iLine * nDstLineSpace;
+                        if (VSIFSeekL(poFirstBand->fpRawL,
+                                      nStartOffset +
+                                          static_cast<vsi_l_offset>(iY +
+                                                                    iLine) *
+                                              poFirstBand->nLineOffset,
+                                      SEEK_SET) != 0 ||
+                            VSIFReadL(pabyOut, nLineBytes * nLinesToRead, 1,
+                                      poFirstBand->fpRawL) != 1)
+                        {
+                            CPLError(CE_Failure, CPLE_FileIO,
+                                     "Failed to read scanlines %d to %d.",
+                                     nYOff + iY + iLine,
+                                     nYOff + iY + iLine + nLinesToRead - 1);
+                            return false;
+                        }
+                        if (bNeedsByteOrderChange)
+                        {
+                            poFirstBand->DoByteSwap(
+                                pabyOut,
+                                static_cast<size_t>(nXSize) * nBands *
+                                    nLinesToRead,
+                                nDTSize, true);
+                        }
+                        iLine += nLinesToRead;
+                    }
+                    return true;
+                };
+
+                if (bSameLayout)
                 {
+                    // Read straight into the user buffer.
+                    return ReadLines(0, nYSize, static_cast<GByte *>(pData),
+                                     nLineSpace)
+                               ? CE_None
+                               : CE_Failure;
+                }
+
+                // Process the lines by chunks of about 1 MB.
+                const int nChunkLines = static_cast<int>(std::max<size_t>(
+                    1, std::min<size_t>(nYSize, 1024 * 1024 / nLineBytes)));
+                std::vector<GByte> abyChunk;
+                try
+                {
+                    abyChunk.resize(nChunkLines * nLineBytes);
+                }
+                catch (const std::exception &)
+                {
+                    CPLError(CE_Failure, CPLE_OutOfMemory,
+                             "Out of memory in RawDataset::IRasterIO()");
                     return CE_Failure;
                 }
-                if (bNeedsByteOrderChange)
+                std::vector<void *> apDstLines(nBands);
+                for (int iY = 0; iY < nYSize; iY += nChunkLines)
                 {
-                    poFirstBand->DoByteSwap(
-                        pabyOut, static_cast<size_t>(nXSize) * nBands, nDTSize,
-                        true);
+                    const int nLines = std::min(nChunkLines, nYSize - iY);
+                    if (!ReadLines(iY, nLines, abyChunk.data(),
+                                   static_cast<GSpacing>(nLineBytes)))
+                        return CE_Failure;
+                    for (int iLine = 0; iLine < nLines; ++iLine)
+                    {
+                        for (int iBand = 0; iBand < nBands; ++iBand)
+                        {
+                            apDstLines[iBand] = static_cast<GByte *>(pData) +
+                                                iBand * nBandSpace +
+                                                (iY + iLine) * nLineSpace;
+                        }
+                        GDALDeinterleave(abyChunk.data() + iLine * nLineBytes,
+                                         eDT, nBands, apDstLines.data(),
+                                         eBufType, nXSize);
+                    }
                 }
+                return CE_None;
             }
-            return CE_None;
         }
-        else if (bCanUseDirectIO)
+        if (bCanUseDirectIO)
         {
             GDALProgressFunc pfnProgressGlobal = psExtraArg->pfnProgress;
             void *pProgressDataGlobal = psExtraArg->pProgressData;
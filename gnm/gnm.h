@@ -52,6 +52,7 @@ typedef int GNMDirection;  // We use int values in order to save them to the
 #define GNM_MD_FETCHVERTEX "fetch_vertex"
 #define GNM_MD_NUM_PATHS "num_paths"
 #define GNM_MD_EMITTER "emitter"
+#define GNM_MD_TARGET "target"
 
 // TODO: Constants for capabilities.
 // #define GNMCanChangeConnections "CanChangeConnections"
@@ -60,7 +61,11 @@ typedef enum
 {
     /** Dijkstra shortest path */ GATDijkstraShortestPath = 1,
     /** KShortest Paths        */ GATKShortestPath,
-    /** Recursive Breadth-first search */ GATConnectedComponents
+    /** Recursive Breadth-first search */ GATConnectedComponents,
+    /** A* shortest path, guided by vertex coordinates. @since GDAL 3.9 */
+    GATAStarShortestPath,
+    /** Shortest path(s) on a contraction hierarchy. @since GDAL 3.9 */
+    GATContractionHierarchyShortestPath
 } GNMGraphAlgorithmType;
 
 #if defined(__cplusplus) && !defined(CPL_SUPRESS_CPLUSPLUS)
@@ -432,6 +437,7 @@ class CPL_DLL GNMGenericNetwork : public GNMNetwork
     virtual CPLErr LoadMetadataLayer(GDALDataset *const pDS);
     virtual CPLErr LoadGraphLayer(GDALDataset *const pDS);
     virtual CPLErr LoadGraph();
+    virtual void LoadVertexCoordinates();
     virtual CPLErr LoadFeaturesLayer(GDALDataset *const pDS);
     virtual CPLErr DeleteMetadataLayer() = 0;
     virtual CPLErr DeleteGraphLayer() = 0;
@@ -477,6 +483,7 @@ class CPL_DLL GNMGenericNetwork : public GNMNetwork
 
     GNMGraph m_oGraph;
     bool m_bIsGraphLoaded;
+    bool m_bIsVertexCoordinatesLoaded;
     //! @endcond
 };
 
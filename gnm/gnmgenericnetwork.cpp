@@ -39,7 +39,8 @@ GNMGenericNetwork::GNMGenericNetwork()
     : GNMNetwork(), m_nVersion(0), m_nGID(0), m_nVirtualConnectionGID(-1),
       m_poMetadataLayer(nullptr), m_poGraphLayer(nullptr),
       m_poFeaturesLayer(nullptr), m_poLayerDriver(nullptr),
-      m_bIsRulesChanged(false), m_bIsGraphLoaded(false)
+      m_bIsRulesChanged(false), m_bIsGraphLoaded(false),
+      m_bIsVertexCoordinatesLoaded(false)
 {
 }
 
@@ -197,6 +198,16 @@ CPLString GNMGenericNetwork::GetAlgorithmName(GNMDirection eAlgorithm,
                 return CPLString("Connected");
             else
                 return CPLString("Connected components");
+        case GATAStarShortestPath:
+            if (bShortName)
+                return CPLString("AStar");
+            else
+                return CPLString("A* shortest path");
+        case GATContractionHierarchyShortestPath:
+            if (bShortName)
+                return CPLString("CH");
+            else
+                return CPLString("Contraction hierarchy shortest path");
     }
 
     return CPLString("Invalid");
@@ -289,6 +300,7 @@ CPLErr GNMGenericNetwork::ConnectFeatures(GNMGFID nSrcGFID, GNMGFID nTgtGFID,
 
     // update graph
 
+    m_bIsVertexCoordinatesLoaded = false;
     m_oGraph.AddEdge(nConGFID, nSrcGFID, nTgtGFID, eDir == GNM_EDGE_DIR_BOTH,
                      dfCost, dfInvCost);
 
@@ -416,6 +428,7 @@ CPLErr GNMGenericNetwork::DisconnectAll()
     }
 
     m_oGraph.Clear();
+    m_bIsVertexCoordinatesLoaded = false;
 
     return CE_None;
 }
@@ -866,6 +879,55 @@ OGRLayer *GNMGenericNetwork::GetPath(GNMGFID nStartFID, GNMGFID nEndFID,
             FillResultLayer(poResLayer, path, 1, bReturnVertices, bReturnEdges);
         }
         break;
+        case GATAStarShortestPath:
+        {
+            LoadVertexCoordinates();
+            GNMPATH path = m_oGraph.AStarShortestPath(nStartFID, nEndFID);
+
+            // fill features in result layer
+            FillResultLayer(poResLayer, path, 1, bReturnVertices, bReturnEdges);
+        }
+        break;
+        case GATContractionHierarchyShortestPath:
+        {
+            // Several end vertices may be given with the "target" option,
+            // in which case they are all routed from the start vertex at once
+            GNMVECTOR anTargets;
+            if (nEndFID != -1)
+            {
+                anTargets.push_back(nEndFID);
+            }
+            if (nullptr != papszOptions)
+            {
+                char **papszTarget =
+                    CSLFetchNameValueMultiple(papszOptions, GNM_MD_TARGET);
+                for (int i = 0; papszTarget[i] != nullptr; ++i)
+                {
+                    anTargets.push_back(CPLAtoGIntBig(papszTarget[i]));
+                }
+                CSLDestroy(papszTarget);
+            }
+
+            std::vector<GNMPATH> paths;
+            if (anTargets.size() == 1)
+            {
+                paths.push_back(m_oGraph.ContractionHierarchyShortestPath(
+                    nStartFID, anTargets[0]));
+            }
+            else
+            {
+                paths = m_oGraph.ContractionHierarchyShortestPaths(nStartFID,
+                                                                   anTargets);
+            }
+
+            // fill features in result layer
+            for (size_t i = 0; i < paths.size(); ++i)
+            {
+                FillResultLayer(poResLayer, paths[i], static_cast<int>(i + 1),
+                                bReturnVertices, bReturnEdges);
+            }
+        }
+        break;
     }
 
     return poResLayer;
@@ -1367,6 +1429,34 @@ CPLErr GNMGenericNetwork::LoadGraph()
     return CE_None;
 }
 
+void GNMGenericNetwork::LoadVertexCoordinates()
+{
+    if (m_bIsVertexCoordinatesLoaded)
+        return;
+
+    // Vertices are the point features of the network layers
+    for (OGRLayer *poLayer : m_apoLayers)
+    {
+        const OGRwkbGeometryType eType = wkbFlatten(poLayer->GetGeomType());
+        if (eType != wkbPoint && eType != wkbUnknown)
+            continue;
+        poLayer->ResetReading();
+        for (auto &&poFeature : poLayer)
+        {
+            const OGRGeometry *poGeom = poFeature->GetGeometryRef();
+            if (poGeom != nullptr &&
+                wkbFlatten(poGeom->getGeometryType()) == wkbPoint)
+            {
+                const OGRPoint *poPoint = poGeom->toPoint();
+                m_oGraph.SetVertexCoordinates(poFeature->GetFID(),
+                                              poPoint->getX(), poPoint->getY());
+            }
+        }
+    }
+
+    m_bIsVertexCoordinatesLoaded = true;
+}
+
 CPLErr GNMGenericNetwork::LoadFeaturesLayer(GDALDataset *const pDS)
 {
     m_poFeaturesLayer = pDS->GetLayerByName(GNM_SYSLAYER_FEATURES);
@@ -35,14 +35,6 @@
 #include <set>
 
 //! @cond Doxygen_Suppress
-GNMGraph::GNMGraph()
-{
-}
-
-GNMGraph::~GNMGraph()
-{
-}
-
 void GNMGraph::AddVertex(GNMGFID nFID)
 {
     if (m_mstVertices.find(nFID) != m_mstVertices.end())
@@ -50,11 +42,16 @@ void GNMGraph::AddVertex(GNMGFID nFID)
 
     GNMStdVertex stVertex;
     stVertex.bIsBlocked = false;
+    stVertex.bHasCoordinates = false;
+    stVertex.dfX = 0.0;
+    stVertex.dfY = 0.0;
     m_mstVertices[nFID] = std::move(stVertex);
+    InvalidateRoutingData();
 }
 
 void GNMGraph::DeleteVertex(GNMGFID nFID)
 {
+    InvalidateRoutingData();
     m_mstVertices.erase(nFID);
 
     // remove all edges with this vertex
@@ -103,6 +100,7 @@ void GNMGraph::AddEdge(GNMGFID nConFID, GNMGFID nSrcFID, GNMGFID nTgtFID,
     stEdge.bIsBlocked = false;
 
     m_mstEdges[nConFID] = stEdge;
+    InvalidateRoutingData();
 
     if (bIsBidir)
     {
@@ -117,6 +115,7 @@ void GNMGraph::AddEdge(GNMGFID nConFID, GNMGFID nSrcFID, GNMGFID nTgtFID,
 
 void GNMGraph::DeleteEdge(GNMGFID nConFID)
 {
+    InvalidateRoutingData();
     m_mstEdges.erase(nConFID);
 
     // remove edge from all vertices anOutEdgeFIDs
@@ -136,11 +135,14 @@ void GNMGraph::ChangeEdge(GNMGFID nFID, double dfCost, double dfInvCost)
     {
         it->second.dfDirCost = dfCost;
         it->second.dfInvCost = dfInvCost;
+        InvalidateRoutingData();
     }
 }
 
 void GNMGraph::ChangeBlockState(GNMGFID nFID, bool bBlock)
 {
+    InvalidateRoutingData();
+
     // check vertices
     std::map<GNMGFID, GNMStdVertex>::iterator itv = m_mstVertices.find(nFID);
     if (itv != m_mstVertices.end())
@@ -168,6 +170,8 @@ bool GNMGraph::CheckVertexBlocked(GNMGFID nFID) const
 
 void GNMGraph::ChangeAllBlockState(bool bBlock)
 {
+    InvalidateRoutingData();
+
     for (std::map<GNMGFID, GNMStdVertex>::iterator itv = m_mstVertices.begin();
          itv != m_mstVertices.end(); ++itv)
     {
@@ -450,6 +454,7 @@ GNMPATH GNMGraph::ConnectedComponents(const GNMVECTOR &anEmittersIDs)
 
 void GNMGraph::Clear()
 {
+    InvalidateRoutingData();
     m_mstVertices.clear();
     m_mstEdges.clear();
 }
@@ -35,6 +35,7 @@
 #include "cpl_port.h"
 #if defined(__cplusplus) && !defined(CPL_SUPRESS_CPLUSPLUS)
 #include <map>
+#include <memory>
 #include <queue>
 #include <set>
 #include <vector>
@@ -71,6 +72,9 @@ struct GNMStdVertex
 {
     GNMVECTOR anOutEdgeFIDs; /**< TODO */
     bool bIsBlocked;         /**< Whether the vertex is blocked */
+    bool bHasCoordinates;    /**< Whether dfX and dfY are set */
+    double dfX;              /**< X coordinate, for the A* heuristic */
+    double dfY;              /**< Y coordinate, for the A* heuristic */
 };
 
 /**
@@ -88,6 +92,8 @@ struct GNMStdVertex
 
 class CPL_DLL GNMGraph
 {
+    CPL_DISALLOW_COPY_ASSIGN(GNMGraph)
+
   public:
     GNMGraph();
     virtual ~GNMGraph();
@@ -211,6 +217,85 @@ class CPL_DLL GNMGraph
      */
     virtual GNMPATH ConnectedComponents(const GNMVECTOR &anEmittersIDs);
 
+    /**
+     * @brief Set the coordinates of a vertex.
+     *
+     * Coordinates are used by AStarShortestPath() to guide the search
+     * towards the end vertex. Nothing is done if there is no such vertex.
+     *
+     * @param nFID Vertex identificator
+     * @param dfX X coordinate
+     * @param dfY Y coordinate
+     * @since GDAL 3.9
+     */
+    virtual void SetVertexCoordinates(GNMGFID nFID, double dfX, double dfY);
+
+    /**
+     * @brief An implementation of the A* shortest path algorithm.
+     *
+     * Returns the same path as DijkstraShortestPath(), but searches it on a
+     * compact (CSR) copy of the graph, built on first use and kept until the
+     * graph is modified. If all vertices have coordinates (see
+     * SetVertexCoordinates()), the search is guided by the straight line
+     * distance to the end vertex, scaled by the lowest cost per distance unit
+     * of the edges, so that the heuristic never overestimates the remaining
+     * cost. Otherwise, this is a Dijkstra search.
+     *
+     * @param nStartFID Start identificator
+     * @param nEndFID End identificator
+     * @return an array of best path included identificator of vertices and
+     * edges
+     * @since GDAL 3.9
+     */
+    virtual GNMPATH AStarShortestPath(GNMGFID nStartFID, GNMGFID nEndFID);
+
+    /**
+     * @brief Preprocess the graph into a contraction hierarchy.
+     *
+     * Vertices are contracted one after the other, by order of importance,
+     * adding shortcut edges between their neighbours where needed to preserve
+     * shortest path costs. Queries on the resulting hierarchy only explore
+     * a few vertices, but preprocessing has to be done again after any
+     * modification of the graph. It is done on first use by
+     * ContractionHierarchyShortestPath() if this method has not been called.
+     *
+     * @since GDAL 3.9
+     */
+    virtual void BuildContractionHierarchy();
+
+    /**
+     * @brief Shortest path query on the contraction hierarchy.
+     *
+     * Returns a path of the same cost as DijkstraShortestPath(), using
+     * a bidirectional search on the hierarchy built by
+     * BuildContractionHierarchy(). Shortcuts are unpacked into the original
+     * edges.
+     *
+     * @param nStartFID Start identificator
+     * @param nEndFID End identificator
+     * @return an array of best path included identificator of vertices and
+     * edges
+     * @since GDAL 3.9
+     */
+    virtual GNMPATH ContractionHierarchyShortestPath(GNMGFID nStartFID,
+                                                     GNMGFID nEndFID);
+
+    /**
+     * @brief One-to-many shortest path query on the contraction hierarchy.
+     *
+     * The upward search from the start vertex is done once, and reused for
+     * each end vertex.
+     *
+     * @param nStartFID Start identificator
+     * @param anEndFIDs End identificators
+     * @return an array of best paths, in the order of anEndFIDs. Paths to
+     * unreachable end vertices are empty.
+     * @since GDAL 3.9
+     */
+    virtual std::vector<GNMPATH>
+    ContractionHierarchyShortestPaths(GNMGFID nStartFID,
+                                      const GNMVECTOR &anEndFIDs);
+
     /** Clear */
     virtual void Clear();
 
@@ -247,9 +332,15 @@ class CPL_DLL GNMGraph
                               std::set<GNMGFID> &markedVertIds,
                               GNMPATH &connectedIds);
 
+    struct RoutingData;
+    RoutingData *GetRoutingData();
+    void InvalidateRoutingData();
+
   protected:
     std::map<GNMGFID, GNMStdVertex> m_mstVertices;
     std::map<GNMGFID, GNMStdEdge> m_mstEdges;
+    // Compact copy of the graph and contraction hierarchy, built on demand
+    std::unique_ptr<RoutingData> m_poRoutingData;
     //! @endcond
 };
 
@@ -0,0 +1,882 @@
+/******************************************************************************
+ *
+ * Project:  GDAL/OGR Geography Network support (Geographic Network Model)
+ * Purpose:  GNM graph routing: A* and contraction hierarchies.
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "gnmgraph.h"
+#include "gnm_priv.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <utility>
+
+//! @cond Doxygen_Suppress
+
+namespace
+{
+
+constexpr double GNM_INFINITY = std::numeric_limits<double>::infinity();
+
+// Maximum number of vertices settled by a witness search during the
+// contraction. A witness that is not found is replaced by a shortcut, which
+// is always correct, but makes the hierarchy bigger.
+constexpr int GNM_CH_MAX_WITNESS_SETTLED = 500;
+
+// Arc of the compact graph or of the contraction hierarchy. Original arcs
+// have nMiddle == -1 and refer to an edge of the network. Shortcuts replace
+// the two arcs that go through the contracted vertex nMiddle.
+struct GNMArc
+{
+    int nTarget;
+    int nMiddle;
+    double dfCost;
+    GNMGFID nEdgeFID;
+};
+
+// Arcs of each vertex, in compressed sparse row form: the arcs of vertex i
+// are asArcs[anStart[i]] to asArcs[anStart[i+1]-1].
+struct GNMCSRGraph
+{
+    std::vector<size_t> anStart{};
+    std::vector<GNMArc> asArcs{};
+};
+
+// State of a Dijkstra-like search. Arrays are allocated once for all
+// vertices, but only the entries of the vertices that have been reached are
+// reset between searches.
+struct GNMSearchSpace
+{
+    std::vector<double> adfDist{};
+    std::vector<int> anParent{};
+    std::vector<size_t> anParentArc{};
+    std::vector<int> anReached{};
+
+    void Init(size_t nVertexCount)
+    {
+        if (adfDist.size() != nVertexCount)
+        {
+            adfDist.assign(nVertexCount, GNM_INFINITY);
+            anParent.assign(nVertexCount, -1);
+            anParentArc.assign(nVertexCount, 0);
+            anReached.clear();
+        }
+        else
+        {
+            Reset();
+        }
+    }
+
+    void Reset()
+    {
+        for (int iVertex : anReached)
+        {
+            adfDist[iVertex] = GNM_INFINITY;
+            anParent[iVertex] = -1;
+        }
+        anReached.clear();
+    }
+
+    void Set(int iVertex, double dfDist, int iParent, size_t iParentArc)
+    {
+        if (adfDist[iVertex] == GNM_INFINITY)
+            anReached.push_back(iVertex);
+        adfDist[iVertex] = dfDist;
+        anParent[iVertex] = iParent;
+        anParentArc[iVertex] = iParentArc;
+    }
+};
+
+typedef std::pair<double, int> GNMQueueItem;
+typedef std::priority_queue<GNMQueueItem, std::vector<GNMQueueItem>,
+                            std::greater<GNMQueueItem>>
+    GNMMinQueue;
+
+// Arc of a path before shortcuts are unpacked
+struct GNMPathArc
+{
+    int nSource;
+    int nTarget;
+    int nMiddle;
+    GNMGFID nEdgeFID;
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                        GNMGraph::RoutingData                         */
+/************************************************************************/
+
+struct GNMGraph::RoutingData
+{
+    // Vertices, by increasing FID. The index of a vertex in this array is
+    // used everywhere else.
+    std::vector<GNMGFID> anVertexFIDs{};
+
+    // Arcs that can be followed: blocked edges and edges that lead to
+    // a blocked vertex are left out. A bidirectional edge gives two arcs.
+    GNMCSRGraph oGraph{};
+
+    // A* heuristic: lower bound of the cost per distance unit of the arcs,
+    // or 0 if not all vertices have coordinates.
+    bool bHeuristicValid = false;
+    std::vector<double> adfX{};
+    std::vector<double> adfY{};
+    double dfCostPerDistance = 0;
+
+    // Contraction hierarchy
+    bool bHasHierarchy = false;
+    GNMCSRGraph oUpGraph{};    // arcs to higher ranked vertices
+    GNMCSRGraph oDownGraph{};  // arcs from higher ranked vertices, reversed
+
+    GNMSearchSpace oForward{};
+    GNMSearchSpace oBackward{};
+
+    int GetVertexIndex(GNMGFID nFID) const
+    {
+        const auto oIter =
+            std::lower_bound(anVertexFIDs.begin(), anVertexFIDs.end(), nFID);
+        if (oIter == anVertexFIDs.end() || *oIter != nFID)
+            return -1;
+        return static_cast<int>(oIter - anVertexFIDs.begin());
+    }
+
+    double GetHeuristic(int iVertex, int iEnd) const
+    {
+        if (dfCostPerDistance == 0)
+            return 0;
+        return dfCostPerDistance * std::hypot(adfX[iVertex] - adfX[iEnd],
+                                              adfY[iVertex] - adfY[iEnd]);
+    }
+
+    void ComputeHeuristic(const std::map<GNMGFID, GNMStdVertex> &mstVertices);
+    void BuildHierarchy();
+    void SearchUpward(GNMSearchSpace &oSearch, const GNMCSRGraph &oCSR,
+                      int iStart) const;
+    bool GetCHPath(int iStart, int iEnd, int iMeet, GNMPATH &aoPath) const;
+};
+
+/************************************************************************/
+/*                          ComputeHeuristic()                          */
+/************************************************************************/
+
+void GNMGraph::RoutingData::ComputeHeuristic(
+    const std::map<GNMGFID, GNMStdVertex> &mstVertices)
+{
+    bHeuristicValid = true;
+    dfCostPerDistance = 0;
+    adfX.clear();
+    adfY.clear();
+    for (const auto &oIter : mstVertices)
+    {
+        if (!oIter.second.bHasCoordinates)
+        {
+            adfX.clear();
+            adfY.clear();
+            return;
+        }
+        adfX.push_back(oIter.second.dfX);
+        adfY.push_back(oIter.second.dfY);
+    }
+
+    // As the cost of each arc is at least dfCostPerDistance times the
+    // distance between its ends, the cost of a path is at least
+    // dfCostPerDistance times the distance between its ends, by triangular
+    // inequality. This makes the heuristic consistent.
+    double dfMin = GNM_INFINITY;
+    const int nVertexCount = static_cast<int>(anVertexFIDs.size());
+    for (int i = 0; i < nVertexCount; ++i)
+    {
+        for (size_t j = oGraph.anStart[i]; j < oGraph.anStart[i + 1]; ++j)
+        {
+            const GNMArc &oArc = oGraph.asArcs[j];
+            const double dfDist = std::hypot(adfX[i] - adfX[oArc.nTarget],
+                                             adfY[i] - adfY[oArc.nTarget]);
+            if (dfDist > 0)
+                dfMin = std::min(dfMin, oArc.dfCost / dfDist);
+        }
+    }
+    // Leave some margin for rounding errors
+    if (dfMin > 0 && dfMin < GNM_INFINITY)
+        dfCostPerDistance = dfMin * (1 - 1e-9);
+}
+
+/************************************************************************/
+/*                           BuildHierarchy()                           */
+/************************************************************************/
+
+void GNMGraph::RoutingData::BuildHierarchy()
+{
+    const int nVertexCount = static_cast<int>(anVertexFIDs.size());
+
+    // Graph being contracted, with at most one arc between two vertices
+    struct DynArc
+    {
+        int nOther;
+        int nMiddle;
+        double dfCost;
+        GNMGFID nEdgeFID;
+    };
+
+    std::vector<std::vector<DynArc>> aoOut(nVertexCount);
+    std::vector<std::vector<DynArc>> aoIn(nVertexCount);
+    const auto AddArc = [&aoOut, &aoIn](int iFrom, int iTo, int nMiddle,
+                                        double dfCost, GNMGFID nEdgeFID)
+    {
+        for (auto &oOut : aoOut[iFrom])
+        {
+            if (oOut.nOther == iTo)
+            {
+                if (dfCost < oOut.dfCost)
+                {
+                    oOut.nMiddle = nMiddle;
+                    oOut.dfCost = dfCost;
+                    oOut.nEdgeFID = nEdgeFID;
+                    for (auto &oIn : aoIn[iTo])
+                    {
+                        if (oIn.nOther == iFrom)
+                        {
+                            oIn.nMiddle = nMiddle;
+                            oIn.dfCost = dfCost;
+                            oIn.nEdgeFID = nEdgeFID;
+                            break;
+                        }
+                    }
+                }
+                return;
+            }
+        }
+        aoOut[iFrom].push_back({iTo, nMiddle, dfCost, nEdgeFID});
+        aoIn[iTo].push_back({iFrom, nMiddle, dfCost, nEdgeFID});
+    };
+
+    for (int i = 0; i < nVertexCount; ++i)
+    {
+        for (size_t j = oGraph.anStart[i]; j < oGraph.anStart[i + 1]; ++j)
+        {
+            const GNMArc &oArc = oGraph.asArcs[j];
+            AddArc(i, oArc.nTarget, -1, oArc.dfCost, oArc.nEdgeFID);
+        }
+    }
+
+    std::vector<bool> abContracted(nVertexCount, false);
+    std::vector<int> anContractedNeighbours(nVertexCount, 0);
+    GNMSearchSpace &oWitness = oBackward;
+    oWitness.Init(nVertexCount);
+
+    // Limited search of a path from iSource to the other vertices, avoiding
+    // iExcluded, and not longer than dfMaxCost.
+    const auto WitnessSearch =
+        [&aoOut, &abContracted, &oWitness](int iSource, int iExcluded,
+                                           double dfMaxCost)
+    {
+        oWitness.Reset();
+        oWitness.Set(iSource, 0, -1, 0);
+        GNMMinQueue oQueue;
+        oQueue.emplace(0, iSource);
+        int nSettled = 0;
+        while (!oQueue.empty())
+        {
+            const GNMQueueItem oTop = oQueue.top();
+            oQueue.pop();
+            if (oTop.first > oWitness.adfDist[oTop.second])
+                continue;
+            if (oTop.first > dfMaxCost ||
+                ++nSettled > GNM_CH_MAX_WITNESS_SETTLED)
+                break;
+            for (const auto &oOut : aoOut[oTop.second])
+            {
+                if (abContracted[oOut.nOther] || oOut.nOther == iExcluded)
+                    continue;
+                const double dfNewDist = oTop.first + oOut.dfCost;
+                if (dfNewDist < oWitness.adfDist[oOut.nOther])
+                {
+                    oWitness.Set(oOut.nOther, dfNewDist, oTop.second, 0);
+                    oQueue.emplace(dfNewDist, oOut.nOther);
+                }
+            }
+        }
+    };
+
+    // Shortcuts needed to contract iVertex, and importance of iVertex,
+    // based on the number of arcs that its contraction would add or remove.
+    struct Shortcut
+    {
+        int nSource;
+        int nTarget;
+        double dfCost;
+    };
+
+    std::vector<Shortcut> asShortcuts;
+    const auto ComputeShortcuts =
+        [&aoOut, &aoIn, &abContracted, &anContractedNeighbours, &oWitness,
+         &asShortcuts, &WitnessSearch](int iVertex)
+    {
+        asShortcuts.clear();
+        int nArcCount = 0;
+        for (const auto &oIn : aoIn[iVertex])
+        {
+            const int iFrom = oIn.nOther;
+            if (abContracted[iFrom])
+                continue;
+            ++nArcCount;
+            double dfMaxOutCost = -1;
+            for (const auto &oOut : aoOut[iVertex])
+            {
+                if (!abContracted[oOut.nOther] && oOut.nOther != iFrom)
+                    dfMaxOutCost = std::max(dfMaxOutCost, oOut.dfCost);
+            }
+            if (dfMaxOutCost < 0)
+                continue;
+
+            WitnessSearch(iFrom, iVertex, oIn.dfCost + dfMaxOutCost);
+            for (const auto &oOut : aoOut[iVertex])
+            {
+                const int iTo = oOut.nOther;
+                if (abContracted[iTo] || iTo == iFrom)
+                    continue;
+                const double dfCost = oIn.dfCost + oOut.dfCost;
+                if (oWitness.adfDist[iTo] > dfCost)
+                    asShortcuts.push_back({iFrom, iTo, dfCost});
+            }
+        }
+        for (const auto &oOut : aoOut[iVertex])
+        {
+            if (!abContracted[oOut.nOther])
+                ++nArcCount;
+        }
+        return static_cast<double>(asShortcuts.size()) - nArcCount +
+               anContractedNeighbours[iVertex];
+    };
+
+    // Contract vertices by increasing importance, which is lazily updated:
+    // it is recomputed when a vertex is the least important one, which is
+    // put back in the queue if it is then no longer the least important.
+    GNMMinQueue oOrder;
+    for (int i = 0; i < nVertexCount; ++i)
+    {
+        oOrder.emplace(ComputeShortcuts(i), i);
+    }
+    std::vector<int> anRank(nVertexCount);
+    int nRank = 0;
+    while (!oOrder.empty())
+    {
+        const int iVertex = oOrder.top().second;
+        oOrder.pop();
+        const double dfImportance = ComputeShortcuts(iVertex);
+        if (!oOrder.empty() && dfImportance > oOrder.top().first)
+        {
+            oOrder.emplace(dfImportance, iVertex);
+            continue;
+        }
+
+        for (const auto &oShortcut : asShortcuts)
+        {
+            AddArc(oShortcut.nSource, oShortcut.nTarget, iVertex,
+                   oShortcut.dfCost, -1);
+        }
+        abContracted[iVertex] = true;
+        anRank[iVertex] = nRank++;
+        for (const auto &oIn : aoIn[iVertex])
+            anContractedNeighbours[oIn.nOther]++;
+        for (const auto &oOut : aoOut[iVertex])
+            anContractedNeighbours[oOut.nOther]++;
+    }
+
+    // Split arcs into the upward graph, searched from the start vertex, and
+    // the downward graph, searched backwards from the end vertex.
+    oUpGraph.anStart.assign(nVertexCount + 1, 0);
+    oDownGraph.anStart.assign(nVertexCount + 1, 0);
+    for (int i = 0; i < nVertexCount; ++i)
+    {
+        for (const auto &oOut : aoOut[i])
+        {
+            if (anRank[oOut.nOther] > anRank[i])
+                oUpGraph.anStart[i + 1]++;
+            else
+                oDownGraph.anStart[oOut.nOther + 1]++;
+        }
+    }
+    for (int i = 0; i < nVertexCount; ++i)
+    {
+        oUpGraph.anStart[i + 1] += oUpGraph.anStart[i];
+        oDownGraph.anStart[i + 1] += oDownGraph.anStart[i];
+    }
+    oUpGraph.asArcs.resize(oUpGraph.anStart[nVertexCount]);
+    oDownGraph.asArcs.resize(oDownGraph.anStart[nVertexCount]);
+    std::vector<size_t> anUpPos(oUpGraph.anStart.begin(),
+                                oUpGraph.anStart.end() - 1);
+    std::vector<size_t> anDownPos(oDownGraph.anStart.begin(),
+                                  oDownGraph.anStart.end() - 1);
+    for (int i = 0; i < nVertexCount; ++i)
+    {
+        for (const auto &oOut : aoOut[i])
+        {
+            if (anRank[oOut.nOther] > anRank[i])
+            {
+                oUpGraph.asArcs[anUpPos[i]++] = {oOut.nOther, oOut.nMiddle,
+                                                 oOut.dfCost, oOut.nEdgeFID};
+            }
+            else
+            {
+                oDownGraph.asArcs[anDownPos[oOut.nOther]++] = {
+                    i, oOut.nMiddle, oOut.dfCost, oOut.nEdgeFID};
+            }
+        }
+    }
+
+    CPLDebug("GNM",
+             "Contraction hierarchy of %d vertices: %d upward and %d "
+             "downward arcs",
+             nVertexCount, static_cast<int>(oUpGraph.asArcs.size()),
+             static_cast<int>(oDownGraph.asArcs.size()));
+    bHasHierarchy = true;
+}
+
+/************************************************************************/
+/*                            SearchUpward()                            */
+/************************************************************************/
+
+// Search all vertices reachable from iStart in the upward or downward graph
+void GNMGraph::RoutingData::SearchUpward(GNMSearchSpace &oSearch,
+                                         const GNMCSRGraph &oCSR,
+                                         int iStart) const
+{
+    oSearch.Init(anVertexFIDs.size());
+    oSearch.Set(iStart, 0, -1, 0);
+    GNMMinQueue oQueue;
+    oQueue.emplace(0, iStart);
+    while (!oQueue.empty())
+    {
+        const GNMQueueItem oTop = oQueue.top();
+        oQueue.pop();
+        if (oTop.first > oSearch.adfDist[oTop.second])
+            continue;
+        for (size_t j = oCSR.anStart[oTop.second];
+             j < oCSR.anStart[oTop.second + 1]; ++j)
+        {
+            const GNMArc &oArc = oCSR.asArcs[j];
+            const double dfNewDist = oTop.first + oArc.dfCost;
+            if (dfNewDist < oSearch.adfDist[oArc.nTarget])
+            {
+                oSearch.Set(oArc.nTarget, dfNewDist, oTop.second, j);
+                oQueue.emplace(dfNewDist, oArc.nTarget);
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                             GetCHPath()                              */
+/************************************************************************/
+
+// Build the path from the forward search tree of iStart and the backward
+// search tree of iEnd, which meet at iMeet, and unpack its shortcuts.
+bool GNMGraph::RoutingData::GetCHPath(int iStart, int iEnd, int iMeet,
+                                      GNMPATH &aoPath) const
+{
+    std::vector<GNMPathArc> asArcs;
+    for (int i = iMeet; i != iStart; i = oForward.anParent[i])
+    {
+        const GNMArc &oArc = oUpGraph.asArcs[oForward.anParentArc[i]];
+        asArcs.push_back(
+            {oForward.anParent[i], i, oArc.nMiddle, oArc.nEdgeFID});
+    }
+    std::reverse(asArcs.begin(), asArcs.end());
+    for (int i = iMeet; i != iEnd; i = oBackward.anParent[i])
+    {
+        const GNMArc &oArc = oDownGraph.asArcs[oBackward.anParentArc[i]];
+        asArcs.push_back(
+            {i, oBackward.anParent[i], oArc.nMiddle, oArc.nEdgeFID});
+    }
+
+    const auto FindArc = [](const GNMCSRGraph &oCSR, int iVertex, int iOther)
+    {
+        for (size_t j = oCSR.anStart[iVertex]; j < oCSR.anStart[iVertex + 1];
+             ++j)
+        {
+            if (oCSR.asArcs[j].nTarget == iOther)
+                return &oCSR.asArcs[j];
+        }
+        return static_cast<const GNMArc *>(nullptr);
+    };
+
+    aoPath.clear();
+    aoPath.push_back(std::make_pair(anVertexFIDs[iStart], GNMGFID(-1)));
+    std::reverse(asArcs.begin(), asArcs.end());
+    while (!asArcs.empty())
+    {
+        const GNMPathArc oArc = asArcs.back();
+        asArcs.pop_back();
+        if (oArc.nMiddle < 0)
+        {
+            aoPath.push_back(
+                std::make_pair(anVertexFIDs[oArc.nTarget], oArc.nEdgeFID));
+            continue;
+        }
+
+        // The middle vertex has been contracted before both ends of the
+        // shortcut, so the arc from the source to it is in its downward
+        // arcs, and the arc from it to the target in its upward arcs.
+        const GNMArc *poFirst = FindArc(oDownGraph, oArc.nMiddle, oArc.nSource);
+        const GNMArc *poSecond = FindArc(oUpGraph, oArc.nMiddle, oArc.nTarget);
+        if (!poFirst || !poSecond)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Cannot unpack shortcut of the contraction hierarchy");
+            aoPath.clear();
+            return false;
+        }
+        asArcs.push_back({oArc.nMiddle, oArc.nTarget, poSecond->nMiddle,
+                          poSecond->nEdgeFID});
+        asArcs.push_back({oArc.nSource, oArc.nMiddle, poFirst->nMiddle,
+                          poFirst->nEdgeFID});
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                             GNMGraph()                               */
+/************************************************************************/
+
+// Constructor and destructor are defined here, where RoutingData is complete
+GNMGraph::GNMGraph() = default;
+
+GNMGraph::~GNMGraph() = default;
+
+/************************************************************************/
+/*                          GetRoutingData()                            */
+/************************************************************************/
+
+GNMGraph::RoutingData *GNMGraph::GetRoutingData()
+{
+    if (m_poRoutingData)
+        return m_poRoutingData.get();
+
+    if (m_mstVertices.size() > static_cast<size_t>(INT_MAX))
+    {
+        CPLError(CE_Failure, CPLE_NotSupported, "Too many vertices");
+        return nullptr;
+    }
+
+    auto poData = std::make_unique<RoutingData>();
+    const int nVertexCount = static_cast<int>(m_mstVertices.size());
+    poData->anVertexFIDs.reserve(nVertexCount);
+    std::vector<bool> abBlocked;
+    abBlocked.reserve(nVertexCount);
+    for (const auto &oIter : m_mstVertices)
+    {
+        poData->anVertexFIDs.push_back(oIter.first);
+        abBlocked.push_back(oIter.second.bIsBlocked);
+    }
+
+    GNMCSRGraph &oGraph = poData->oGraph;
+    oGraph.anStart.reserve(nVertexCount + 1);
+    oGraph.anStart.push_back(0);
+    for (const auto &oIter : m_mstVertices)
+    {
+        for (const GNMGFID nEdgeFID : oIter.second.anOutEdgeFIDs)
+        {
+            const auto ite = m_mstEdges.find(nEdgeFID);
+            if (ite == m_mstEdges.end() || ite->second.bIsBlocked)
+                continue;
+
+            // As in DijkstraShortestPathTree(), the direct cost is used
+            // whatever the direction in which the edge is followed.
+            const GNMGFID nTargetFID =
+                ite->second.nSrcVertexFID == oIter.first
+                    ? ite->second.nTgtVertexFID
+                    : ite->second.nSrcVertexFID;
+            const int iTarget = poData->GetVertexIndex(nTargetFID);
+            if (nTargetFID == oIter.first || iTarget < 0 || abBlocked[iTarget])
+                continue;
+            oGraph.asArcs.push_back(
+                {iTarget, -1, ite->second.dfDirCost, nEdgeFID});
+        }
+        oGraph.anStart.push_back(oGraph.asArcs.size());
+    }
+
+    m_poRoutingData = std::move(poData);
+    return m_poRoutingData.get();
+}
+
+/************************************************************************/
+/*                       InvalidateRoutingData()                        */
+/************************************************************************/
+
+void GNMGraph::InvalidateRoutingData()
+{
+    m_poRoutingData.reset();
+}
+
+/************************************************************************/
+/*                        SetVertexCoordinates()                        */
+/************************************************************************/
+
+void GNMGraph::SetVertexCoordinates(GNMGFID nFID, double dfX, double dfY)
+{
+    auto it = m_mstVertices.find(nFID);
+    if (it == m_mstVertices.end())
+        return;
+    it->second.bHasCoordinates = true;
+    it->second.dfX = dfX;
+    it->second.dfY = dfY;
+    // The contraction hierarchy does not depend on coordinates
+    if (m_poRoutingData)
+        m_poRoutingData->bHeuristicValid = false;
+}
+
+/************************************************************************/
+/*                         AStarShortestPath()                          */
+/************************************************************************/
+
+GNMPATH GNMGraph::AStarShortestPath(GNMGFID nStartFID, GNMGFID nEndFID)
+{
+    GNMPATH aoPath;
+    RoutingData *poData = GetRoutingData();
+    if (poData == nullptr)
+        return aoPath;
+    const int iStart = poData->GetVertexIndex(nStartFID);
+    const int iEnd = poData->GetVertexIndex(nEndFID);
+    if (iStart < 0 || iEnd < 0)
+        return aoPath;
+    if (!poData->bHeuristicValid)
+        poData->ComputeHeuristic(m_mstVertices);
+
+    // Vertices are visited by increasing cost from the start, plus the lower
+    // bound of the cost to the end. As the heuristic is consistent, the
+    // path to a vertex is final when it is visited.
+    const GNMCSRGraph &oGraph = poData->oGraph;
+    GNMSearchSpace &oSearch = poData->oForward;
+    oSearch.Init(poData->anVertexFIDs.size());
+    oSearch.Set(iStart, 0, -1, 0);
+    GNMMinQueue oQueue;
+    oQueue.emplace(poData->GetHeuristic(iStart, iEnd), iStart);
+    bool bFound = false;
+    while (!oQueue.empty())
+    {
+        const GNMQueueItem oTop = oQueue.top();
+        oQueue.pop();
+        const int iVertex = oTop.second;
+        const double dfDist = oSearch.adfDist[iVertex];
+        if (oTop.first > dfDist + poData->GetHeuristic(iVertex, iEnd))
+            continue;
+        if (iVertex == iEnd)
+        {
+            bFound = true;
+            break;
+        }
+        for (size_t j = oGraph.anStart[iVertex];
+             j < oGraph.anStart[iVertex + 1]; ++j)
+        {
+            const GNMArc &oArc = oGraph.asArcs[j];
+            const double dfNewDist = dfDist + oArc.dfCost;
+            if (dfNewDist < oSearch.adfDist[oArc.nTarget])
+            {
+                oSearch.Set(oArc.nTarget, dfNewDist, iVertex, j);
+                oQueue.emplace(dfNewDist +
+                                   poData->GetHeuristic(oArc.nTarget, iEnd),
+                               oArc.nTarget);
+            }
+        }
+    }
+    if (!bFound)
+        return aoPath;
+
+    for (int i = iEnd; i != iStart; i = oSearch.anParent[i])
+    {
+        aoPath.push_back(
+            std::make_pair(poData->anVertexFIDs[i],
+                           oGraph.asArcs[oSearch.anParentArc[i]].nEdgeFID));
+    }
+    aoPath.push_back(std::make_pair(nStartFID, GNMGFID(-1)));
+    std::reverse(aoPath.begin(), aoPath.end());
+    return aoPath;
+}
+
+/************************************************************************/
+/*                     BuildContractionHierarchy()                      */
+/************************************************************************/
+
+void GNMGraph::BuildContractionHierarchy()
+{
+    RoutingData *poData = GetRoutingData();
+    if (poData != nullptr && !poData->bHasHierarchy)
+        poData->BuildHierarchy();
+}
+
+/************************************************************************/
+/*                 ContractionHierarchyShortestPath()                   */
+/************************************************************************/
+
+GNMPATH GNMGraph::ContractionHierarchyShortestPath(GNMGFID nStartFID,
+                                                   GNMGFID nEndFID)
+{
+    GNMPATH aoPath;
+    BuildContractionHierarchy();
+    RoutingData *poData = m_poRoutingData.get();
+    if (poData == nullptr || !poData->bHasHierarchy)
+        return aoPath;
+    const int iStart = poData->GetVertexIndex(nStartFID);
+    const int iEnd = poData->GetVertexIndex(nEndFID);
+    if (iStart < 0 || iEnd < 0)
+        return aoPath;
+
+    // Bidirectional search, alternating between the forward search from the
+    // start vertex in the upward graph, and the backward search from the end
+    // vertex in the downward graph. A direction is stopped when its nearest
+    // vertex is farther than the best path found so far.
+    const size_t nVertexCount = poData->anVertexFIDs.size();
+    GNMSearchSpace *apoSearch[2] = {&poData->oForward, &poData->oBackward};
+    const GNMCSRGraph *apoGraph[2] = {&poData->oUpGraph, &poData->oDownGraph};
+    GNMMinQueue aoQueue[2];
+    const int aiStart[2] = {iStart, iEnd};
+    for (int iDir = 0; iDir < 2; ++iDir)
+    {
+        apoSearch[iDir]->Init(nVertexCount);
+        apoSearch[iDir]->Set(aiStart[iDir], 0, -1, 0);
+        aoQueue[iDir].emplace(0, aiStart[iDir]);
+    }
+
+    double dfBest = GNM_INFINITY;
+    int iMeet = -1;
+    int iDir = 0;
+    while (true)
+    {
+        for (auto &oQueue : aoQueue)
+        {
+            if (!oQueue.empty() && oQueue.top().first >= dfBest)
+                oQueue = GNMMinQueue();
+        }
+        if (aoQueue[0].empty() && aoQueue[1].empty())
+            break;
+        iDir = aoQueue[1 - iDir].empty() ? iDir : 1 - iDir;
+        if (aoQueue[iDir].empty())
+            iDir = 1 - iDir;
+
+        GNMSearchSpace &oSearch = *apoSearch[iDir];
+        const GNMCSRGraph &oCSR = *apoGraph[iDir];
+        const GNMQueueItem oTop = aoQueue[iDir].top();
+        aoQueue[iDir].pop();
+        const int iVertex = oTop.second;
+        if (oTop.first > oSearch.adfDist[iVertex])
+            continue;
+
+        const double dfOtherDist = apoSearch[1 - iDir]->adfDist[iVertex];
+        if (oTop.first + dfOtherDist < dfBest)
+        {
+            dfBest = oTop.first + dfOtherDist;
+            iMeet = iVertex;
+        }
+
+        for (size_t j = oCSR.anStart[iVertex]; j < oCSR.anStart[iVertex + 1];
+             ++j)
+        {
+            const GNMArc &oArc = oCSR.asArcs[j];
+            const double dfNewDist = oTop.first + oArc.dfCost;
+            if (dfNewDist < oSearch.adfDist[oArc.nTarget])
+            {
+                oSearch.Set(oArc.nTarget, dfNewDist, iVertex, j);
+                aoQueue[iDir].emplace(dfNewDist, oArc.nTarget);
+            }
+        }
+    }
+
+    if (iMeet >= 0)
+        poData->GetCHPath(iStart, iEnd, iMeet, aoPath);
+    return aoPath;
+}
+
+/************************************************************************/
+/*                 ContractionHierarchyShortestPaths()                  */
+/************************************************************************/
+
+std::vector<GNMPATH>
+GNMGraph::ContractionHierarchyShortestPaths(GNMGFID nStartFID,
+                                            const GNMVECTOR &anEndFIDs)
+{
+    std::vector<GNMPATH> aoPaths(anEndFIDs.size());
+    BuildContractionHierarchy();
+    RoutingData *poData = m_poRoutingData.get();
+    if (poData == nullptr || !poData->bHasHierarchy)
+        return aoPaths;
+    const int iStart = poData->GetVertexIndex(nStartFID);
+    if (iStart < 0)
+        return aoPaths;
+
+    // The forward search is complete, so that it can be shared by all end
+    // vertices. The upward graph of a vertex is small, so this is cheap.
+    poData->SearchUpward(poData->oForward, poData->oUpGraph, iStart);
+    const GNMSearchSpace &oForward = poData->oForward;
+
+    GNMSearchSpace &oBackward = poData->oBackward;
+    const GNMCSRGraph &oDownGraph = poData->oDownGraph;
+    for (size_t i = 0; i < anEndFIDs.size(); ++i)
+    {
+        const int iEnd = poData->GetVertexIndex(anEndFIDs[i]);
+        if (iEnd < 0)
+            continue;
+
+        oBackward.Init(poData->anVertexFIDs.size());
+        oBackward.Set(iEnd, 0, -1, 0);
+        GNMMinQueue oQueue;
+        oQueue.emplace(0, iEnd);
+        double dfBest = GNM_INFINITY;
+        int iMeet = -1;
+        while (!oQueue.empty() && oQueue.top().first < dfBest)
+        {
+            const GNMQueueItem oTop = oQueue.top();
+            oQueue.pop();
+            const int iVertex = oTop.second;
+            if (oTop.first > oBackward.adfDist[iVertex])
+                continue;
+            if (oTop.first + oForward.adfDist[iVertex] < dfBest)
+            {
+                dfBest = oTop.first + oForward.adfDist[iVertex];
+                iMeet = iVertex;
+            }
+            for (size_t j = oDownGraph.anStart[iVertex];
+                 j < oDownGraph.anStart[iVertex + 1]; ++j)
+            {
+                const GNMArc &oArc = oDownGraph.asArcs[j];
+                const double dfNewDist = oTop.first + oArc.dfCost;
+                if (dfNewDist < oBackward.adfDist[oArc.nTarget])
+                {
+                    oBackward.Set(oArc.nTarget, dfNewDist, iVertex, j);
+                    oQueue.emplace(dfNewDist, oArc.nTarget);
+                }
+            }
+        }
+
+        if (iMeet >= 0)
+            poData->GetCHPath(iStart, iEnd, iMeet, aoPaths[i]);
+    }
+    return aoPaths;
+}
+
+//! @endcond
@@ -803,6 +803,7 @@ void CPL_DLL OGR_L_SetStyleTableDirectly(OGRLayerH, OGRStyleTableH);
 /** Set style table */
 void CPL_DLL OGR_L_SetStyleTable(OGRLayerH, OGRStyleTableH);
 OGRErr CPL_DLL OGR_L_SetIgnoredFields(OGRLayerH, const char **);
+char CPL_DLL **OGR_L_ExplainQuery(OGRLayerH);
 OGRErr CPL_DLL OGR_L_Intersection(OGRLayerH, OGRLayerH, OGRLayerH, char **,
                                   GDALProgressFunc, void *);
 OGRErr CPL_DLL OGR_L_Union(OGRLayerH, OGRLayerH, OGRLayerH, char **,
@@ -35,11 +35,14 @@
 #include "ogr_featurestyle.h"
 #include "ogr_geometry.h"
 
+#include <atomic>
 #include <cstddef>
 
 #include <exception>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 /**
@@ -501,6 +504,13 @@ class CPL_DLL OGRFeatureDefn
     friend class TemporaryUnsealer;
     bool m_bSealed = false;
     int m_nTemporaryUnsealCount = 0;
+
+    // Map from the upper-cased field names to their index, used by
+    // GetFieldIndex() when the object and its fields are sealed. Lazily built.
+    bool m_bFieldIndexMapAllowed = false;
+    mutable std::atomic<bool> m_bFieldIndexMapBuilt{false};
+    mutable std::mutex m_oFieldIndexMapMutex{};
+    mutable std::unordered_map<std::string, int> m_oMapFieldIndex{};
     //! @endcond
 
   public:
@@ -1490,6 +1500,64 @@ inline OGRFeature::ConstFieldIterator end(const OGRFeatureUniquePtr &poFeature)
 
 //! @endcond
 
+/************************************************************************/
+/*                           OGRFeatureBatch                            */
+/************************************************************************/
+
+/**
+ * A batch of features, filled by OGRLayer::GetNextFeatureBatch().
+ *
+ * The features of a batch are owned by it. When the batch is passed again to
+ * OGRLayer::GetNextFeatureBatch(), its features are recycled by the drivers
+ * that support it: the feature objects and their field arrays, string
+ * buffers that are large enough and point and line string geometries are
+ * reused instead of being reallocated for each feature.
+ *
+ * @since GDAL 3.9
+ */
+class CPL_DLL OGRFeatureBatch
+{
+    std::vector<OGRFeatureUniquePtr> m_apoFeatures{};
+    size_t m_nFeatureCount = 0;
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRFeatureBatch)
+
+  public:
+    OGRFeatureBatch() = default;
+
+    /** Returns the number of features of the batch. */
+    int GetFeatureCount() const
+    {
+        return static_cast<int>(m_nFeatureCount);
+    }
+
+    /** Returns the i-th feature of the batch, still owned by the batch. */
+    OGRFeature *GetFeature(int i)
+    {
+        return m_apoFeatures[i].get();
+    }
+
+    OGRFeatureUniquePtr StealFeature(int i);
+
+    /** Empties the batch, while keeping its features for recycling. */
+    void Clear()
+    {
+        m_nFeatureCount = 0;
+    }
+
+    void AppendFeature(OGRFeatureUniquePtr poFeature);
+
+    OGRFeature *AppendRecycledFeature(OGRFeatureDefn *poDefn);
+
+    /** Removes the last feature of the batch, typically a feature returned by
+     * AppendRecycledFeature() that could not be filled. */
+    void RemoveLastFeature()
+    {
+        if (m_nFeatureCount > 0)
+            --m_nFeatureCount;
+    }
+};
+
 /************************************************************************/
 /*                           OGRFieldDomain                             */
 /************************************************************************/
@@ -1843,6 +1911,7 @@ class OGRLayer;
 class swq_expr_node;
 class swq_custom_func_registrar;
 struct swq_evaluation_context;
+class swq_program;
 
 class CPL_DLL OGRFeatureQuery
 {
@@ -1850,6 +1919,8 @@ class CPL_DLL OGRFeatureQuery
     OGRFeatureDefn *poTargetDefn;
     void *pSWQExpr;
     swq_evaluation_context *m_psContext = nullptr;
+    swq_program *m_poProgram = nullptr;
+    bool m_bMustCompileProgram = false;
 
     char **FieldCollector(void *, char **);
 
@@ -1883,6 +1954,13 @@ class CPL_DLL OGRFeatureQuery
     {
         return pSWQExpr;
     }
+
+    swq_program *GetProgram();
+
+    const swq_evaluation_context &GetEvaluationContext() const
+    {
+        return *m_psContext;
+    }
 };
 //! @endcond
 
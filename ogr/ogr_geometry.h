@@ -39,6 +39,8 @@
 
 #include <cmath>
 #include <memory>
+#include <string>
+#include <vector>
 
 /**
  * \file ogr_geometry.h
@@ -4017,6 +4019,14 @@ class CPL_DLL OGRGeometryFactory
                                          const char **papszOptions = nullptr);
     static bool haveGEOS();
 
+    static bool validateGeometries(const OGRGeometry *const *papoGeoms,
+                                   size_t nCount, GByte *pabyValid,
+                                   std::vector<std::string> *paosReasons,
+                                   CSLConstList papszOptions = nullptr);
+    static std::vector<std::unique_ptr<OGRGeometry>>
+    makeValidGeometries(const OGRGeometry *const *papoGeoms, size_t nCount,
+                        CSLConstList papszOptions = nullptr);
+
     /** Opaque class used as argument to transformWithOptions() */
     class CPL_DLL TransformWithOptionsCache
     {
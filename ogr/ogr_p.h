@@ -223,6 +223,14 @@ OGRErr CPL_DLL OGRReadWKBGeometryType(const unsigned char *pabyData,
                                       OGRwkbVariant wkbVariant,
                                       OGRwkbGeometryType *eGeometryType);
 
+/************************************************************************/
+/*                          Prepared geometry                           */
+/************************************************************************/
+
+bool CPL_DLL OGRPreparedGeometryIntersectsWKB(
+    struct _OGRPreparedGeometry *hPreparedGeom, const GByte *pabyWKB,
+    size_t nWKBSize, bool &bIntersects);
+
 /************************************************************************/
 /*                        WKT Type Handling encoding                    */
 /************************************************************************/
@@ -27,8 +27,12 @@
 #include "cpl_string.h"
 #include "ogr_core.h"
 
+#include <limits>
 #include <list>
 #include <map>
+#include <memory>
+#include <string>
+#include <unordered_set>
 #include <vector>
 #include <set>
 
@@ -190,6 +194,150 @@ class CPL_UNSTABLE_API swq_expr_node
     static CPLString Quote(const CPLString &, char chQuote = '\'');
 };
 
+/************************************************************************/
+/*                             swq_program                              */
+/************************************************************************/
+
+/* Flat, typed form of a checked WHERE expression made of comparisons,
+ * IN, BETWEEN, LIKE, ILIKE and IS NULL tests between a column and constants,
+ * combined with AND, OR and NOT. It is evaluated over batches of records,
+ * one test at a time, producing byte masks, without the per record
+ * allocations of swq_expr_node::Evaluate(). Its results are identical to
+ * the ones of swq_expr_node::Evaluate().
+ */
+class CPL_UNSTABLE_API swq_program
+{
+  public:
+    /* Column used by the program */
+    struct Column
+    {
+        /* Index suitable for the OGRFeature field accessors, that is
+         * FieldCount + SPF_FID for the FID */
+        int field_index = 0;
+        /* Type of the column in the expression */
+        swq_field_type field_type = SWQ_INTEGER;
+        /* SWQ_INTEGER64, SWQ_FLOAT or SWQ_STRING, or SWQ_NULL if only the
+         * nullness of the column is tested */
+        swq_field_type value_type = SWQ_NULL;
+    };
+
+    /* Values of a column for a batch of records. Only the arrays
+     * corresponding to the value_type of the column must be filled. */
+    struct ColumnValues
+    {
+        std::vector<GIntBig> anValues{};
+        std::vector<double> adfValues{};
+        /* Strings must not contain nul characters within their length */
+        std::vector<const char *> apszValues{};
+        std::vector<size_t> anLengths{};
+        /* Whether apszValues[i][anLengths[i]] is a nul character */
+        bool bNulTerminated = false;
+        std::vector<GByte> abyIsNull{};
+    };
+
+    /* Working buffers, that may be reused over several evaluations */
+    struct Scratch
+    {
+        std::vector<ColumnValues> aoColumns{};
+        std::vector<std::vector<GByte>> aabyStack{};
+        std::string osTmp{};
+    };
+
+    ~swq_program();
+
+    static std::unique_ptr<swq_program> Compile(const swq_expr_node *poExpr,
+                                                int nFieldCount,
+                                                int nGeomFieldCount);
+
+    const std::vector<Column> &GetColumns() const
+    {
+        return m_aoColumns;
+    }
+
+    Scratch &GetScratch()
+    {
+        return m_oScratch;
+    }
+
+    void Evaluate(size_t nRows, const std::vector<ColumnValues> &aoValues,
+                  const swq_evaluation_context &sContext, Scratch &oScratch,
+                  GByte *pabyResult) const;
+
+  private:
+    enum class LeafType
+    {
+        ISNULL,
+        CMP_INT,
+        CMP_FLOAT,
+        CMP_STRING,
+        IN_INT,
+        IN_FLOAT,
+        IN_STRING,
+        LIKE,
+    };
+
+    enum class LikeType
+    {
+        EXACT,
+        PREFIX,
+        SUFFIX,
+        CONTAINS,
+        GENERIC,
+    };
+
+    struct Leaf
+    {
+        LeafType eType = LeafType::ISNULL;
+        swq_op eOp = SWQ_EQ;
+        int iColumn = 0;
+        bool bConstantFirst = false;
+        GIntBig anValues[2] = {0, 0};
+        double adfValues[2] = {0, 0};
+        std::string aosValues[2]{};
+        std::unordered_set<GIntBig> oSetIntValues{};
+        std::vector<double> adfSortedValues{};
+        std::unordered_set<std::string> oSetStringValues{};
+        char chEscape = '\0';
+        bool bInsensitive = false;
+        LikeType eLikeType = LikeType::GENERIC;
+        std::string osLikeLiteral{};
+    };
+
+    enum class Opcode
+    {
+        LEAF,
+        AND,
+        OR,
+        NOT,
+    };
+
+    struct Instr
+    {
+        Opcode eOpcode = Opcode::LEAF;
+        int iLeaf = 0;
+    };
+
+    std::vector<Column> m_aoColumns{};
+    std::vector<Leaf> m_aoLeaves{};
+    std::vector<Instr> m_aoInstrs{};
+    int m_nMaxStackDepth = 0;
+    int m_nFieldCount = 0;
+    int m_nGeomFieldCount = 0;
+    Scratch m_oScratch{};
+
+    swq_program() = default;
+    swq_program(const swq_program &) = delete;
+    swq_program &operator=(const swq_program &) = delete;
+
+    bool CompileNode(const swq_expr_node *poNode, int nDepth, int nStackDepth);
+    bool CompileLeaf(const swq_expr_node *poNode);
+    int GetColumn(const swq_expr_node *poNode, swq_field_type eValueType);
+    void EvaluateLeaf(const Leaf &oLeaf, size_t nRows,
+                      const ColumnValues &oValues,
+                      const swq_evaluation_context &sContext,
+                      Scratch &oScratch, GByte *pabyOut) const;
+};
+
 typedef struct
 {
     const char *pszName;
@@ -304,6 +452,7 @@ const char CPL_UNSTABLE_API *SWQFieldTypeToString(swq_field_type field_type);
 #define SWQM_SUMMARY_RECORD 1
 #define SWQM_RECORDSET 2
 #define SWQM_DISTINCT_LIST 3
+#define SWQM_GROUP_BY 4
 
 typedef enum
 {
@@ -355,10 +504,10 @@ class CPL_UNSTABLE_API swq_summary
     std::vector<CPLString> oVectorDistinctValues{};
     std::set<CPLString, Comparator> oSetDistinctValues{};
     double sum = 0.0;
-    double min = 0.0;
-    double max = 0.0;
-    CPLString osMin{};
-    CPLString osMax{};
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    CPLString osMin = "9999/99/99 99:99:99";
+    CPLString osMax = "0000/00/00 00:00:00";
 };
 
 typedef struct
@@ -376,6 +525,15 @@ typedef struct
     swq_expr_node *poExpr;
 } swq_join_def;
 
+struct swq_group_def
+{
+    CPLString osTableName{};
+    CPLString osFieldName{};
+    int table_index = -1;
+    int field_index = -1;
+    swq_field_type field_type = SWQ_OTHER;
+};
+
 class CPL_UNSTABLE_API swq_select_parse_options
 {
   public:
@@ -440,6 +598,9 @@ class CPL_UNSTABLE_API swq_select
     int order_specs = 0;
     swq_order_def *order_defs = nullptr;
 
+    void PushGroupBy(const char *pszTableName, const char *pszFieldName);
+    std::vector<swq_group_def> group_defs{};
+
     void SetLimit(GIntBig nLimit);
     GIntBig limit = -1;
 
@@ -462,6 +623,7 @@ class CPL_UNSTABLE_API swq_select
 
   private:
     bool IsFieldExcluded(int src_index, const char *table, const char *field);
+    CPLErr ParseGroupBy(swq_field_list *field_list);
 
     // map of EXCLUDE columns keyed according to the index of the
     // asterisk with which it should be associated. key of -1 is
@@ -474,6 +636,10 @@ const char CPL_UNSTABLE_API *swq_select_summarize(swq_select *select_info,
                                                   int dest_column,
                                                   const char *value);
 
+const char CPL_UNSTABLE_API *swq_summary_accumulate(const swq_col_def *def,
+                                                   swq_summary &summary,
+                                                   const char *value);
+
 int CPL_UNSTABLE_API swq_is_reserved_keyword(const char *pszStr);
 
 char CPL_UNSTABLE_API *OGRHStoreGetValue(const char *pszHStore,
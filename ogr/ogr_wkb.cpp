@@ -606,6 +606,663 @@ bool OGRWKBGetBoundingBox(const GByte *pabyWkb, size_t nWKBSize,
     return OGRWKBGetBoundingBox<true>(pabyWkb, nWKBSize, iOffset, sEnvelope, 0);
 }
 
+/************************************************************************/
+/*                 OGRWKBPointSequenceGetAreaOrLength()                 */
+/************************************************************************/
+
+namespace
+{
+enum class OGRWKBMeasure
+{
+    NONE,
+    AREA,
+    LENGTH
+};
+}  // namespace
+
+// Computes, depending on eMeasure, the area of the ring or the length of the
+// line string whose point count is at iOffset, and skips over its points.
+static bool OGRWKBPointSequenceGetAreaOrLength(const uint8_t *data,
+                                               size_t size,
+                                               OGRwkbByteOrder eByteOrder,
+                                               int nDim,
+                                               OGRWKBMeasure eMeasure,
+                                               size_t &iOffset, double &dfValue)
+{
+    const uint32_t nPoints =
+        OGRWKBReadUInt32AtOffset(data, eByteOrder, iOffset);
+    if (nPoints > (size - iOffset) / (nDim * sizeof(double)))
+        return false;
+    dfValue = 0;
+    if (eMeasure != OGRWKBMeasure::NONE && nPoints >= 2)
+    {
+        const bool bNeedSwap = OGR_SWAP(eByteOrder);
+        const auto GetXY = [data, iOffset, nDim, bNeedSwap](uint32_t i,
+                                                            double &dfX,
+                                                            double &dfY)
+        {
+            const GByte *pabyPoint = data + iOffset + i * nDim * sizeof(double);
+            dfX = OGRWKBReadFloat64(pabyPoint, bNeedSwap);
+            dfY = OGRWKBReadFloat64(pabyPoint + sizeof(double), bNeedSwap);
+        };
+
+        double dfX0 = 0;
+        double dfY0 = 0;
+        GetXY(0, dfX0, dfY0);
+        double dfXPrev = dfX0;
+        double dfYPrev = dfY0;
+        if (eMeasure == OGRWKBMeasure::AREA)
+        {
+            // Shoelace formula, with coordinates relative to the first point
+            // to limit the loss of precision
+            dfXPrev = 0;
+            dfYPrev = 0;
+            for (uint32_t i = 1; i < nPoints; ++i)
+            {
+                double dfX, dfY;
+                GetXY(i, dfX, dfY);
+                dfX -= dfX0;
+                dfY -= dfY0;
+                dfValue += dfXPrev * dfY - dfX * dfYPrev;
+                dfXPrev = dfX;
+                dfYPrev = dfY;
+            }
+            dfValue = 0.5 * std::fabs(dfValue);
+        }
+        else
+        {
+            for (uint32_t i = 1; i < nPoints; ++i)
+            {
+                double dfX, dfY;
+                GetXY(i, dfX, dfY);
+                const double dfDX = dfX - dfXPrev;
+                const double dfDY = dfY - dfYPrev;
+                dfValue += sqrt(dfDX * dfDX + dfDY * dfDY);
+                dfXPrev = dfX;
+                dfYPrev = dfY;
+            }
+        }
+    }
+    iOffset += static_cast<size_t>(nPoints) * nDim * sizeof(double);
+    return true;
+}
+
+/************************************************************************/
+/*                       OGRWKBGetAreaOrLength()                        */
+/************************************************************************/
+
+static bool OGRWKBGetAreaOrLength(const uint8_t *data, size_t size,
+                                  size_t &iOffset, OGRWKBMeasure eMeasure,
+                                  double &dfValue, int nRec)
+{
+    dfValue = 0;
+    if (size - iOffset < MIN_WKB_SIZE)
+        return false;
+    const int nByteOrder = DB2_V72_FIX_BYTE_ORDER(data[iOffset]);
+    if (!(nByteOrder == wkbXDR || nByteOrder == wkbNDR))
+        return false;
+    const OGRwkbByteOrder eByteOrder = static_cast<OGRwkbByteOrder>(nByteOrder);
+
+    OGRwkbGeometryType eGeometryType = wkbUnknown;
+    OGRReadWKBGeometryType(data + iOffset, wkbVariantIso, &eGeometryType);
+    iOffset += 5;
+    const auto eFlatType = wkbFlatten(eGeometryType);
+    const int nDim = 2 + (OGR_GT_HasZ(eGeometryType) ? 1 : 0) +
+                     (OGR_GT_HasM(eGeometryType) ? 1 : 0);
+
+    if (eFlatType == wkbPoint)
+    {
+        if (size - iOffset < nDim * sizeof(double))
+            return false;
+        iOffset += nDim * sizeof(double);
+        return true;
+    }
+
+    if (eFlatType == wkbLineString)
+    {
+        return OGRWKBPointSequenceGetAreaOrLength(
+            data, size, eByteOrder, nDim,
+            eMeasure == OGRWKBMeasure::LENGTH ? eMeasure : OGRWKBMeasure::NONE,
+            iOffset, dfValue);
+    }
+
+    if (eFlatType == wkbPolygon || eFlatType == wkbTriangle)
+    {
+        const uint32_t nRings =
+            OGRWKBReadUInt32AtOffset(data, eByteOrder, iOffset);
+        if (nRings > (size - iOffset) / sizeof(uint32_t))
+            return false;
+        const OGRWKBMeasure eRingMeasure =
+            eMeasure == OGRWKBMeasure::AREA ? eMeasure : OGRWKBMeasure::NONE;
+        for (uint32_t i = 0; i < nRings; i++)
+        {
+            if (iOffset + sizeof(uint32_t) > size)
+                return false;
+            double dfRingArea = 0;
+            if (!OGRWKBPointSequenceGetAreaOrLength(data, size, eByteOrder,
+                                                    nDim, eRingMeasure,
+                                                    iOffset, dfRingArea))
+                return false;
+            dfValue += (i == 0) ? dfRingArea : -dfRingArea;
+        }
+        return true;
+    }
+
+    if (eFlatType == wkbMultiPoint || eFlatType == wkbMultiLineString ||
+        eFlatType == wkbMultiPolygon || eFlatType == wkbGeometryCollection ||
+        eFlatType == wkbPolyhedralSurface || eFlatType == wkbTIN)
+    {
+        if (nRec == 128)
+            return false;
+        const uint32_t nParts =
+            OGRWKBReadUInt32AtOffset(data, eByteOrder, iOffset);
+        if (nParts > (size - iOffset) / MIN_WKB_SIZE)
+            return false;
+        for (uint32_t k = 0; k < nParts; k++)
+        {
+            double dfPartValue = 0;
+            if (!OGRWKBGetAreaOrLength(data, size, iOffset, eMeasure,
+                                       dfPartValue, nRec + 1))
+                return false;
+            dfValue += dfPartValue;
+        }
+        return true;
+    }
+
+    // Curve geometries are not handled
+    return false;
+}
+
+/************************************************************************/
+/*                           OGRWKBGetArea()                            */
+/************************************************************************/
+
+/** Computes the area of a WKB geometry, without instantiating it.
+ *
+ * The result is the same as OGRGeometry::get_Area() (or OGR_G_Area()): 0 for
+ * point and linear geometries, and the sum of the areas of the surfaces for
+ * collections.
+ *
+ * @return false if the WKB is invalid, or contains curve geometries, in which
+ * case the caller should fallback to OGRGeometry::get_Area().
+ */
+bool OGRWKBGetArea(const GByte *pabyWkb, size_t nWKBSize, double &dfArea)
+{
+    size_t iOffset = 0;
+    return OGRWKBGetAreaOrLength(pabyWkb, nWKBSize, iOffset,
+                                 OGRWKBMeasure::AREA, dfArea, 0);
+}
+
+/************************************************************************/
+/*                          OGRWKBGetLength()                           */
+/************************************************************************/
+
+/** Computes the length of a WKB geometry, without instantiating it.
+ *
+ * The result is the same as OGR_G_Length(): the 2D length of line strings,
+ * summed over the linear members of collections. Surfaces contribute 0.
+ *
+ * @return false if the WKB is invalid, or contains curve geometries, in which
+ * case the caller should fallback to OGRGeometry methods.
+ */
+bool OGRWKBGetLength(const GByte *pabyWkb, size_t nWKBSize, double &dfLength)
+{
+    size_t iOffset = 0;
+    return OGRWKBGetAreaOrLength(pabyWkb, nWKBSize, iOffset,
+                                 OGRWKBMeasure::LENGTH, dfLength, 0);
+}
+
+/************************************************************************/
+/*                     OGRWKBForEachPointSequence()                     */
+/************************************************************************/
+
+namespace
+{
+enum class OGRWKBSequenceKind
+{
+    POINT,
+    LINE,
+    RING
+};
+}  // namespace
+
+// Calls oFunc(iOffsetPoints, nPoints, nDim, eByteOrder, eKind, iRing) for
+// each sequence of points of a non-curve geometry, iRing being the index of
+// the ring in its polygon for eKind == RING.
+template <class Func>
+static bool OGRWKBForEachPointSequence(const uint8_t *data, size_t size,
+                                       size_t &iOffset, Func &oFunc, int nRec)
+{
+    if (size - iOffset < MIN_WKB_SIZE)
+        return false;
+    const int nByteOrder = DB2_V72_FIX_BYTE_ORDER(data[iOffset]);
+    if (!(nByteOrder == wkbXDR || nByteOrder == wkbNDR))
+        return false;
+    const OGRwkbByteOrder eByteOrder = static_cast<OGRwkbByteOrder>(nByteOrder);
+
+    OGRwkbGeometryType eGeometryType = wkbUnknown;
+    OGRReadWKBGeometryType(data + iOffset, wkbVariantIso, &eGeometryType);
+    iOffset += 5;
+    const auto eFlatType = wkbFlatten(eGeometryType);
+    const int nDim = 2 + (OGR_GT_HasZ(eGeometryType) ? 1 : 0) +
+                     (OGR_GT_HasM(eGeometryType) ? 1 : 0);
+
+    const auto ReadSequence =
+        [data, size, &iOffset, &oFunc, nDim,
+         eByteOrder](OGRWKBSequenceKind eKind, uint32_t iRing)
+    {
+        if (size - iOffset < sizeof(uint32_t))
+            return false;
+        const uint32_t nPoints =
+            OGRWKBReadUInt32AtOffset(data, eByteOrder, iOffset);
+        if (nPoints > (size - iOffset) / (nDim * sizeof(double)))
+            return false;
+        oFunc(iOffset, nPoints, nDim, eByteOrder, eKind, iRing);
+        iOffset += static_cast<size_t>(nPoints) * nDim * sizeof(double);
+        return true;
+    };
+
+    if (eFlatType == wkbPoint)
+    {
+        if (size - iOffset < nDim * sizeof(double))
+            return false;
+        // NaN coordinates are used for POINT EMPTY
+        if (!std::isnan(
+                OGRWKBReadFloat64(data + iOffset, OGR_SWAP(eByteOrder))))
+            oFunc(iOffset, 1, nDim, eByteOrder, OGRWKBSequenceKind::POINT, 0);
+        iOffset += nDim * sizeof(double);
+        return true;
+    }
+
+    if (eFlatType == wkbLineString)
+    {
+        return ReadSequence(OGRWKBSequenceKind::LINE, 0);
+    }
+
+    if (eFlatType == wkbPolygon || eFlatType == wkbTriangle)
+    {
+        const uint32_t nRings =
+            OGRWKBReadUInt32AtOffset(data, eByteOrder, iOffset);
+        if (nRings > (size - iOffset) / sizeof(uint32_t))
+            return false;
+        for (uint32_t i = 0; i < nRings; i++)
+        {
+            if (!ReadSequence(OGRWKBSequenceKind::RING, i))
+                return false;
+        }
+        return true;
+    }
+
+    if (eFlatType == wkbMultiPoint || eFlatType == wkbMultiLineString ||
+        eFlatType == wkbMultiPolygon || eFlatType == wkbGeometryCollection ||
+        eFlatType == wkbPolyhedralSurface || eFlatType == wkbTIN)
+    {
+        if (nRec == 128)
+            return false;
+        const uint32_t nParts =
+            OGRWKBReadUInt32AtOffset(data, eByteOrder, iOffset);
+        if (nParts > (size - iOffset) / MIN_WKB_SIZE)
+            return false;
+        for (uint32_t k = 0; k < nParts; k++)
+        {
+            if (!OGRWKBForEachPointSequence(data, size, iOffset, oFunc,
+                                            nRec + 1))
+                return false;
+        }
+        return true;
+    }
+
+    // Curve geometries are not handled
+    return false;
+}
+
+/************************************************************************/
+/*                            OGRWKBSwapXY()                            */
+/************************************************************************/
+
+/** Swaps in place the X and Y coordinates of a WKB geometry.
+ *
+ * @return false if the WKB is invalid, or contains curve geometries. The
+ * buffer may then have been partially modified.
+ */
+bool OGRWKBSwapXY(GByte *pabyWkb, size_t nWKBSize)
+{
+    const auto SwapXY = [pabyWkb](size_t iOffsetPoints, uint32_t nPoints,
+                                  int nDim, OGRwkbByteOrder,
+                                  OGRWKBSequenceKind, uint32_t)
+    {
+        // Swapping the 8 bytes of X and Y is independent of the byte order
+        GByte *pabyPoint = pabyWkb + iOffsetPoints;
+        for (uint32_t i = 0; i < nPoints; ++i)
+        {
+            GByte abyTmp[sizeof(double)];
+            memcpy(abyTmp, pabyPoint, sizeof(double));
+            memmove(pabyPoint, pabyPoint + sizeof(double), sizeof(double));
+            memcpy(pabyPoint + sizeof(double), abyTmp, sizeof(double));
+            pabyPoint += nDim * sizeof(double);
+        }
+    };
+    size_t iOffset = 0;
+    return OGRWKBForEachPointSequence(pabyWkb, nWKBSize, iOffset, SwapXY, 0);
+}
+
+/************************************************************************/
+/*                         OGRWKBPointInPolygon()                       */
+/************************************************************************/
+
+/** Tests whether a point is inside a polygonal WKB geometry.
+ *
+ * Uses the even-odd rule over all rings, so points located exactly on the
+ * boundary may be reported either inside or outside.
+ *
+ * @param pabyWkb WKB of a Polygon, Triangle or MultiPolygon.
+ * @param nWKBSize Size of pabyWkb in bytes.
+ * @param dfX X coordinate of the point.
+ * @param dfY Y coordinate of the point.
+ * @param[out] bInside Set to whether the point is inside.
+ * @return false if the WKB is invalid or is not a (multi)polygon.
+ */
+bool OGRWKBPointInPolygon(const GByte *pabyWkb, size_t nWKBSize, double dfX,
+                          double dfY, bool &bInside)
+{
+    bInside = false;
+    OGRwkbGeometryType eGeometryType = wkbUnknown;
+    if (nWKBSize < MIN_WKB_SIZE ||
+        OGRReadWKBGeometryType(pabyWkb, wkbVariantIso, &eGeometryType) !=
+            OGRERR_NONE)
+    {
+        return false;
+    }
+    const auto eFlatType = wkbFlatten(eGeometryType);
+    if (eFlatType != wkbPolygon && eFlatType != wkbTriangle &&
+        eFlatType != wkbMultiPolygon)
+    {
+        return false;
+    }
+
+    const auto Crossings =
+        [pabyWkb, dfX, dfY, &bInside](size_t iOffsetPoints, uint32_t nPoints,
+                                      int nDim, OGRwkbByteOrder eByteOrder,
+                                      OGRWKBSequenceKind, uint32_t)
+    {
+        if (nPoints < 2)
+            return;
+        const bool bSwap = OGR_SWAP(eByteOrder);
+        const GByte *pabyPoint = pabyWkb + iOffsetPoints;
+        const size_t nStride = nDim * sizeof(double);
+        double dfXPrev = OGRWKBReadFloat64(
+            pabyPoint + (nPoints - 1) * nStride, bSwap);
+        double dfYPrev = OGRWKBReadFloat64(
+            pabyPoint + (nPoints - 1) * nStride + sizeof(double), bSwap);
+        for (uint32_t i = 0; i < nPoints; ++i, pabyPoint += nStride)
+        {
+            const double dfXCur = OGRWKBReadFloat64(pabyPoint, bSwap);
+            const double dfYCur =
+                OGRWKBReadFloat64(pabyPoint + sizeof(double), bSwap);
+            if (((dfYCur > dfY) != (dfYPrev > dfY)) &&
+                (dfX < (dfXPrev - dfXCur) * (dfY - dfYCur) /
+                               (dfYPrev - dfYCur) +
+                           dfXCur))
+            {
+                bInside = !bInside;
+            }
+            dfXPrev = dfXCur;
+            dfYPrev = dfYCur;
+        }
+    };
+    size_t iOffset = 0;
+    return OGRWKBForEachPointSequence(pabyWkb, nWKBSize, iOffset, Crossings,
+                                      0);
+}
+
+/************************************************************************/
+/*                          OGRWKBGetCentroid()                         */
+/************************************************************************/
+
+/** Computes the centroid of a WKB geometry, without instantiating it.
+ *
+ * As with OGRGeometry::Centroid(), only the components of highest dimension
+ * are taken into account: area-weighted for surfaces, length-weighted for
+ * lines, and the mean of points otherwise.
+ *
+ * @param pabyWkb WKB geometry.
+ * @param nWKBSize Size of pabyWkb in bytes.
+ * @param[out] dfX X coordinate of the centroid.
+ * @param[out] dfY Y coordinate of the centroid.
+ * @param[out] bEmpty Set if the geometry is empty, in which case dfX and dfY
+ * are not set.
+ * @return false if the WKB is invalid, or contains curve geometries.
+ */
+bool OGRWKBGetCentroid(const GByte *pabyWkb, size_t nWKBSize, double &dfX,
+                       double &dfY, bool &bEmpty)
+{
+    // Accumulators, per dimension
+    double dfAreaSum = 0, dfAreaCX = 0, dfAreaCY = 0;
+    double dfLengthSum = 0, dfLengthCX = 0, dfLengthCY = 0;
+    double dfPointCount = 0, dfPointCX = 0, dfPointCY = 0;
+    bool bHasRing = false;
+    bool bHasLine = false;
+
+    const auto Accumulate =
+        [&](size_t iOffsetPoints, uint32_t nPoints, int nDim,
+            OGRwkbByteOrder eByteOrder, OGRWKBSequenceKind eKind,
+            uint32_t iRing)
+    {
+        const bool bSwap = OGR_SWAP(eByteOrder);
+        const GByte *pabyPoints = pabyWkb + iOffsetPoints;
+        const size_t nStride = nDim * sizeof(double);
+        const auto GetXY = [pabyPoints, nStride, bSwap](uint32_t i, double &x,
+                                                        double &y)
+        {
+            x = OGRWKBReadFloat64(pabyPoints + i * nStride, bSwap);
+            y = OGRWKBReadFloat64(pabyPoints + i * nStride + sizeof(double),
+                                  bSwap);
+        };
+
+        if (eKind == OGRWKBSequenceKind::POINT)
+        {
+            double x, y;
+            GetXY(0, x, y);
+            dfPointCount += 1;
+            dfPointCX += x;
+            dfPointCY += y;
+            return;
+        }
+        if (nPoints == 0)
+            return;
+
+        double x0, y0;
+        GetXY(0, x0, y0);
+        if (nPoints == 1)
+        {
+            dfPointCount += 1;
+            dfPointCX += x0;
+            dfPointCY += y0;
+            return;
+        }
+
+        if (eKind == OGRWKBSequenceKind::LINE)
+            bHasLine = true;
+        else
+            bHasRing = true;
+
+        // Coordinates are taken relative to the first point to limit the
+        // loss of precision.
+        double dfRingArea2 = 0, dfRingCX = 0, dfRingCY = 0;
+        double xPrev = 0, yPrev = 0;
+        for (uint32_t i = 1; i < nPoints; ++i)
+        {
+            double x, y;
+            GetXY(i, x, y);
+            x -= x0;
+            y -= y0;
+            const double dfSegLength = sqrt((x - xPrev) * (x - xPrev) +
+                                            (y - yPrev) * (y - yPrev));
+            dfLengthSum += dfSegLength;
+            dfLengthCX += dfSegLength * ((xPrev + x) / 2 + x0);
+            dfLengthCY += dfSegLength * ((yPrev + y) / 2 + y0);
+            if (eKind == OGRWKBSequenceKind::RING)
+            {
+                const double dfCross = xPrev * y - x * yPrev;
+                dfRingArea2 += dfCross;
+                dfRingCX += (xPrev + x) * dfCross;
+                dfRingCY += (yPrev + y) * dfCross;
+            }
+            xPrev = x;
+            yPrev = y;
+        }
+        if (eKind == OGRWKBSequenceKind::RING && dfRingArea2 != 0)
+        {
+            // Exterior rings add, interior rings subtract, whatever their
+            // orientation.
+            const double dfSign =
+                ((dfRingArea2 > 0) == (iRing == 0)) ? 1.0 : -1.0;
+            dfAreaSum += dfSign * dfRingArea2 / 2;
+            dfAreaCX += dfSign * (dfRingCX / 6 + x0 * dfRingArea2 / 2);
+            dfAreaCY += dfSign * (dfRingCY / 6 + y0 * dfRingArea2 / 2);
+        }
+    };
+
+    size_t iOffset = 0;
+    if (!OGRWKBForEachPointSequence(pabyWkb, nWKBSize, iOffset, Accumulate,
+                                    0))
+        return false;
+
+    bEmpty = false;
+    if (bHasRing && dfAreaSum != 0)
+    {
+        dfX = dfAreaCX / dfAreaSum;
+        dfY = dfAreaCY / dfAreaSum;
+    }
+    else if ((bHasRing || bHasLine) && dfLengthSum != 0)
+    {
+        dfX = dfLengthCX / dfLengthSum;
+        dfY = dfLengthCY / dfLengthSum;
+    }
+    else if (dfPointCount != 0)
+    {
+        dfX = dfPointCX / dfPointCount;
+        dfY = dfPointCY / dfPointCount;
+    }
+    else
+    {
+        bEmpty = true;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                            OGRWKBForce2D()                           */
+/************************************************************************/
+
+static bool OGRWKBForce2D(const uint8_t *data, size_t size, size_t &iOffset,
+                          std::vector<GByte> &abyOut, int nRec)
+{
+    if (size - iOffset < MIN_WKB_SIZE)
+        return false;
+    const int nByteOrder = DB2_V72_FIX_BYTE_ORDER(data[iOffset]);
+    if (!(nByteOrder == wkbXDR || nByteOrder == wkbNDR))
+        return false;
+    const OGRwkbByteOrder eByteOrder = static_cast<OGRwkbByteOrder>(nByteOrder);
+
+    OGRwkbGeometryType eGeometryType = wkbUnknown;
+    OGRReadWKBGeometryType(data + iOffset, wkbVariantIso, &eGeometryType);
+    const auto eFlatType = wkbFlatten(eGeometryType);
+    const int nDim = 2 + (OGR_GT_HasZ(eGeometryType) ? 1 : 0) +
+                     (OGR_GT_HasM(eGeometryType) ? 1 : 0);
+
+    abyOut.push_back(static_cast<GByte>(eByteOrder));
+    uint32_t nFlatType = static_cast<uint32_t>(eFlatType);
+    if (OGR_SWAP(eByteOrder))
+        CPL_SWAP32PTR(&nFlatType);
+    abyOut.insert(abyOut.end(), reinterpret_cast<const GByte *>(&nFlatType),
+                  reinterpret_cast<const GByte *>(&nFlatType) +
+                      sizeof(uint32_t));
+    iOffset += 5;
+
+    const auto CopyCount = [data, &iOffset, &abyOut, eByteOrder]()
+    {
+        abyOut.insert(abyOut.end(), data + iOffset,
+                      data + iOffset + sizeof(uint32_t));
+        return OGRWKBReadUInt32AtOffset(data, eByteOrder, iOffset);
+    };
+
+    const auto CopyPoints = [data, size, &iOffset, &abyOut,
+                             nDim](uint32_t nPoints)
+    {
+        if (nPoints > (size - iOffset) / (nDim * sizeof(double)))
+            return false;
+        for (uint32_t i = 0; i < nPoints; ++i)
+        {
+            abyOut.insert(abyOut.end(), data + iOffset,
+                          data + iOffset + 2 * sizeof(double));
+            iOffset += nDim * sizeof(double);
+        }
+        return true;
+    };
+
+    if (eFlatType == wkbPoint)
+    {
+        return CopyPoints(1);
+    }
+
+    if (eFlatType == wkbLineString || eFlatType == wkbCircularString)
+    {
+        return CopyPoints(CopyCount());
+    }
+
+    if (eFlatType == wkbPolygon || eFlatType == wkbTriangle)
+    {
+        const uint32_t nRings = CopyCount();
+        if (nRings > (size - iOffset) / sizeof(uint32_t))
+            return false;
+        for (uint32_t i = 0; i < nRings; i++)
+        {
+            if (size - iOffset < sizeof(uint32_t) || !CopyPoints(CopyCount()))
+                return false;
+        }
+        return true;
+    }
+
+    if (OGR_GT_IsSubClassOf(eFlatType, wkbGeometryCollection) ||
+        eFlatType == wkbCompoundCurve || eFlatType == wkbCurvePolygon ||
+        eFlatType == wkbPolyhedralSurface || eFlatType == wkbTIN)
+    {
+        if (nRec == 128)
+            return false;
+        const uint32_t nParts = CopyCount();
+        if (nParts > (size - iOffset) / MIN_WKB_SIZE)
+            return false;
+        for (uint32_t k = 0; k < nParts; k++)
+        {
+            if (!OGRWKBForce2D(data, size, iOffset, abyOut, nRec + 1))
+                return false;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+/** Converts a WKB geometry to its 2D form, by dropping Z and M values.
+ *
+ * The byte order of the input is preserved, and the output uses ISO WKB
+ * geometry type codes.
+ *
+ * @param pabyWkb Input WKB geometry.
+ * @param nWKBSize Size of pabyWkb in bytes.
+ * @param[out] abyOut Output WKB. Its previous content is discarded.
+ * @return false if the WKB is invalid.
+ */
+bool OGRWKBForce2D(const GByte *pabyWkb, size_t nWKBSize,
+                   std::vector<GByte> &abyOut)
+{
+    abyOut.clear();
+    abyOut.reserve(nWKBSize);
+    size_t iOffset = 0;
+    return OGRWKBForce2D(pabyWkb, nWKBSize, iOffset, abyOut, 0);
+}
+
 /************************************************************************/
 /*              OGRWKBIntersectsPointSequencePessimistic()              */
 /************************************************************************/
@@ -1072,6 +1729,223 @@ void OGRWKBFixupCounterClockWiseExternalRing(GByte *pabyWkb, size_t nWKBSize)
         pabyWkb, nWKBSize, iOffsetInOut, /* nRec = */ 0);
 }
 
+/************************************************************************/
+/*                      OGRWKBBatchTransformer()                        */
+/************************************************************************/
+
+OGRWKBBatchTransformer::OGRWKBBatchTransformer(
+    OGRCoordinateTransformation *poCT)
+    : m_poCT(poCT)
+{
+}
+
+/************************************************************************/
+/*                              Reset()                                 */
+/************************************************************************/
+
+void OGRWKBBatchTransformer::Reset()
+{
+    m_asSequences.clear();
+    m_nPoints = 0;
+}
+
+/************************************************************************/
+/*                           AddGeometry()                              */
+/************************************************************************/
+
+bool OGRWKBBatchTransformer::AddGeometry(GByte *pabyWkb, size_t nWKBSize)
+{
+    const auto nSequencesBefore = m_asSequences.size();
+    const auto nPointsBefore = m_nPoints;
+    size_t iOffset = 0;
+    if (!AddGeometry(pabyWkb, nWKBSize, iOffset, 0))
+    {
+        m_asSequences.resize(nSequencesBefore);
+        m_nPoints = nPointsBefore;
+        return false;
+    }
+    return true;
+}
+
+bool OGRWKBBatchTransformer::AddGeometry(GByte *data, size_t size,
+                                         size_t &iOffset, int nRec)
+{
+    if (size - iOffset < MIN_WKB_SIZE)
+        return false;
+    const int nByteOrder = DB2_V72_FIX_BYTE_ORDER(data[iOffset]);
+    if (!(nByteOrder == wkbXDR || nByteOrder == wkbNDR))
+        return false;
+    const OGRwkbByteOrder eByteOrder = static_cast<OGRwkbByteOrder>(nByteOrder);
+
+    OGRwkbGeometryType eGeometryType = wkbUnknown;
+    OGRReadWKBGeometryType(data + iOffset, wkbVariantIso, &eGeometryType);
+    iOffset += 5;
+    const auto eFlatType = wkbFlatten(eGeometryType);
+    const bool bHasZ = CPL_TO_BOOL(OGR_GT_HasZ(eGeometryType));
+    const int nDim = 2 + (bHasZ ? 1 : 0) + (OGR_GT_HasM(eGeometryType) ? 1 : 0);
+    const bool bNeedSwap = OGR_SWAP(eByteOrder);
+
+    const auto AddPointSequence = [this, data, size, &iOffset, eByteOrder,
+                                   nDim, bHasZ, bNeedSwap]()
+    {
+        if (size - iOffset < sizeof(uint32_t))
+            return false;
+        const uint32_t nPoints =
+            OGRWKBReadUInt32AtOffset(data, eByteOrder, iOffset);
+        if (nPoints > (size - iOffset) / (nDim * sizeof(double)))
+            return false;
+        if (nPoints > 0)
+        {
+            m_asSequences.push_back(PointSequence{data + iOffset, nPoints,
+                                                  nDim, bHasZ, bNeedSwap});
+            m_nPoints += nPoints;
+        }
+        iOffset += static_cast<size_t>(nPoints) * nDim * sizeof(double);
+        return true;
+    };
+
+    if (eFlatType == wkbPoint)
+    {
+        if (size - iOffset < nDim * sizeof(double))
+            return false;
+        double dfX = 0;
+        memcpy(&dfX, data + iOffset, sizeof(double));
+        // Point empty is encoded with NaN coordinates
+        if (!std::isnan(dfX))
+        {
+            m_asSequences.push_back(
+                PointSequence{data + iOffset, 1, nDim, bHasZ, bNeedSwap});
+            m_nPoints += 1;
+        }
+        iOffset += nDim * sizeof(double);
+        return true;
+    }
+
+    if (eFlatType == wkbLineString || eFlatType == wkbCircularString)
+    {
+        return AddPointSequence();
+    }
+
+    if (eFlatType == wkbPolygon || eFlatType == wkbTriangle)
+    {
+        const uint32_t nRings =
+            OGRWKBReadUInt32AtOffset(data, eByteOrder, iOffset);
+        if (nRings > (size - iOffset) / sizeof(uint32_t))
+            return false;
+        for (uint32_t i = 0; i < nRings; i++)
+        {
+            if (!AddPointSequence())
+                return false;
+        }
+        return true;
+    }
+
+    if (OGR_GT_IsSubClassOf(eFlatType, wkbGeometryCollection) ||
+        eFlatType == wkbCompoundCurve || eFlatType == wkbCurvePolygon ||
+        eFlatType == wkbPolyhedralSurface || eFlatType == wkbTIN)
+    {
+        if (nRec == 128)
+            return false;
+        const uint32_t nParts =
+            OGRWKBReadUInt32AtOffset(data, eByteOrder, iOffset);
+        if (nParts > (size - iOffset) / MIN_WKB_SIZE)
+            return false;
+        for (uint32_t k = 0; k < nParts; k++)
+        {
+            if (!AddGeometry(data, size, iOffset, nRec + 1))
+                return false;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+/************************************************************************/
+/*                             Transform()                              */
+/************************************************************************/
+
+bool OGRWKBBatchTransformer::Transform()
+{
+    if (m_nPoints == 0)
+        return true;
+
+    try
+    {
+        m_adfX.resize(m_nPoints);
+        m_adfY.resize(m_nPoints);
+        m_adfZ.resize(m_nPoints);
+        m_anSuccess.resize(m_nPoints);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate arrays for %" PRIu64 " points",
+                 static_cast<uint64_t>(m_nPoints));
+        return false;
+    }
+
+    // Gather the coordinates of all point sequences in flat arrays
+    size_t iPoint = 0;
+    for (const auto &sSeq : m_asSequences)
+    {
+        const GByte *pabyData = sSeq.pabyData;
+        for (uint32_t j = 0; j < sSeq.nPoints; ++j, ++iPoint)
+        {
+            memcpy(&m_adfX[iPoint], pabyData, sizeof(double));
+            memcpy(&m_adfY[iPoint], pabyData + sizeof(double),
+                   sizeof(double));
+            if (sSeq.bHasZ)
+                memcpy(&m_adfZ[iPoint], pabyData + 2 * sizeof(double),
+                       sizeof(double));
+            else
+                m_adfZ[iPoint] = 0;
+            if (sSeq.bNeedSwap)
+            {
+                CPL_SWAP64PTR(&m_adfX[iPoint]);
+                CPL_SWAP64PTR(&m_adfY[iPoint]);
+                if (sSeq.bHasZ)
+                    CPL_SWAP64PTR(&m_adfZ[iPoint]);
+            }
+            pabyData += sSeq.nDim * sizeof(double);
+        }
+    }
+
+    if (!m_poCT->Transform(m_nPoints, m_adfX.data(), m_adfY.data(),
+                           m_adfZ.data(), nullptr, m_anSuccess.data()) ||
+        std::find(m_anSuccess.begin(), m_anSuccess.end(), FALSE) !=
+            m_anSuccess.end())
+    {
+        return false;
+    }
+
+    // Write back the transformed coordinates
+    iPoint = 0;
+    for (const auto &sSeq : m_asSequences)
+    {
+        GByte *pabyData = sSeq.pabyData;
+        for (uint32_t j = 0; j < sSeq.nPoints; ++j, ++iPoint)
+        {
+            if (sSeq.bNeedSwap)
+            {
+                CPL_SWAP64PTR(&m_adfX[iPoint]);
+                CPL_SWAP64PTR(&m_adfY[iPoint]);
+                if (sSeq.bHasZ)
+                    CPL_SWAP64PTR(&m_adfZ[iPoint]);
+            }
+            memcpy(pabyData, &m_adfX[iPoint], sizeof(double));
+            memcpy(pabyData + sizeof(double), &m_adfY[iPoint],
+                   sizeof(double));
+            if (sSeq.bHasZ)
+                memcpy(pabyData + 2 * sizeof(double), &m_adfZ[iPoint],
+                       sizeof(double));
+            pabyData += sSeq.nDim * sizeof(double);
+        }
+    }
+
+    return true;
+}
+
 /************************************************************************/
 /*                         OGRAppendBuffer()                            */
 /************************************************************************/
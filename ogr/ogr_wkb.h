@@ -32,6 +32,10 @@
 #include "cpl_port.h"
 #include "ogr_core.h"
 
+#include <vector>
+
+class OGRCoordinateTransformation;
+
 bool CPL_DLL OGRWKBGetGeomType(const GByte *pabyWkb, size_t nWKBSize,
                                bool &bNeedSwap, uint32_t &nType);
 bool OGRWKBPolygonGetArea(const GByte *&pabyWkb, size_t &nWKBSize,
@@ -45,6 +49,23 @@ bool CPL_DLL OGRWKBGetBoundingBox(const GByte *pabyWkb, size_t nWKBSize,
 bool CPL_DLL OGRWKBGetBoundingBox(const GByte *pabyWkb, size_t nWKBSize,
                                   OGREnvelope &sEnvelope);
 
+bool CPL_DLL OGRWKBGetArea(const GByte *pabyWkb, size_t nWKBSize,
+                           double &dfArea);
+
+bool CPL_DLL OGRWKBGetLength(const GByte *pabyWkb, size_t nWKBSize,
+                             double &dfLength);
+
+bool CPL_DLL OGRWKBGetCentroid(const GByte *pabyWkb, size_t nWKBSize,
+                               double &dfX, double &dfY, bool &bEmpty);
+
+bool CPL_DLL OGRWKBPointInPolygon(const GByte *pabyWkb, size_t nWKBSize,
+                                  double dfX, double dfY, bool &bInside);
+
+bool CPL_DLL OGRWKBSwapXY(GByte *pabyWkb, size_t nWKBSize);
+
+bool CPL_DLL OGRWKBForce2D(const GByte *pabyWkb, size_t nWKBSize,
+                           std::vector<GByte> &abyOut);
+
 bool CPL_DLL OGRWKBIntersectsPessimistic(const GByte *pabyWkb, size_t nWKBSize,
                                          const OGREnvelope &sEnvelope);
 
@@ -62,6 +83,64 @@ void CPL_DLL OGRWKBFixupCounterClockWiseExternalRing(GByte *pabyWkb,
 const GByte CPL_DLL *WKBFromEWKB(GByte *pabyEWKB, size_t nEWKBSize,
                                  size_t &nWKBSizeOut, int *pnSRIDOut);
 
+/************************************************************************/
+/*                       OGRWKBBatchTransformer                         */
+/************************************************************************/
+
+/** Reproject in place the coordinates of a set of WKB geometries.
+ *
+ * Geometries are first registered with AddGeometry(), which only records
+ * the location of their coordinates. Transform() then issues a single
+ * OGRCoordinateTransformation::Transform() call on all of them, and writes
+ * back the result in the WKB buffers, which must thus still be valid at that
+ * point.
+ */
+class CPL_DLL OGRWKBBatchTransformer
+{
+    struct PointSequence
+    {
+        GByte *pabyData;
+        uint32_t nPoints;
+        int nDim;
+        bool bHasZ;
+        bool bNeedSwap;
+    };
+
+    OGRCoordinateTransformation *m_poCT = nullptr;
+    std::vector<PointSequence> m_asSequences{};
+    size_t m_nPoints = 0;
+    std::vector<double> m_adfX{};
+    std::vector<double> m_adfY{};
+    std::vector<double> m_adfZ{};
+    std::vector<int> m_anSuccess{};
+
+    bool AddGeometry(GByte *pabyWkb, size_t nWKBSize, size_t &iOffset,
+                     int nRec);
+
+    OGRWKBBatchTransformer(const OGRWKBBatchTransformer &) = delete;
+    OGRWKBBatchTransformer &operator=(const OGRWKBBatchTransformer &) = delete;
+
+  public:
+    /** Constructor */
+    explicit OGRWKBBatchTransformer(OGRCoordinateTransformation *poCT);
+
+    /** Forget about previously registered geometries. */
+    void Reset();
+
+    /** Register a geometry whose coordinates must be transformed.
+     *
+     * Returns false if the WKB geometry is invalid.
+     */
+    bool AddGeometry(GByte *pabyWkb, size_t nWKBSize);
+
+    /** Transform the coordinates of all registered geometries.
+     *
+     * Returns false if at least one point could not be transformed, in which
+     * case the WKB buffers are left unmodified.
+     */
+    bool Transform();
+};
+
 /************************************************************************/
 /*                       OGRAppendBuffer                                */
 /************************************************************************/
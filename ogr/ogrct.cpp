@@ -31,6 +31,7 @@
 #include "ogr_spatialref.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <cstring>
@@ -91,6 +92,8 @@ class OGRProjCT;
 typedef std::string CTCacheKey;
 typedef std::unique_ptr<OGRProjCT> CTCacheValue;
 static lru11::Cache<CTCacheKey, CTCacheValue> *g_poCTCache = nullptr;
+// Incremented by OSRCTCleanCache() to invalidate the per-thread caches
+static std::atomic<int> g_nCTCacheGeneration{0};
 
 /************************************************************************/
 /*             OGRCoordinateTransformationOptions::Private              */
@@ -739,6 +742,7 @@ class OGRProjCT : public OGRCoordinateTransformation
     std::string m_osTargetSRS{};  // WKT, PROJ4 or AUTH:CODE
 
     bool bWebMercatorToWGS84LongLat = false;
+    bool bWGS84LongLatToWebMercator = false;
 
     size_t nErrorCount = 0;
 
@@ -1251,6 +1255,7 @@ OGRProjCT::OGRProjCT(const OGRProjCT &other)
       dfTargetCoordinateEpoch(other.dfTargetCoordinateEpoch),
       m_osTargetSRS(other.m_osTargetSRS),
       bWebMercatorToWGS84LongLat(other.bWebMercatorToWGS84LongLat),
+      bWGS84LongLatToWebMercator(other.bWGS84LongLatToWebMercator),
       nErrorCount(other.nErrorCount), dfThreshold(other.dfThreshold),
       m_pj(other.m_pj), m_bReversePj(other.m_bReversePj),
       m_bEmitErrors(other.m_bEmitErrors), bNoTransform(other.bNoTransform),
@@ -1300,15 +1305,115 @@ void OGRProjCT::ComputeThreshold()
     }
 }
 
+/************************************************************************/
+/*                     IsWebMercatorAndWGS84LongLat()                   */
+/************************************************************************/
+
+// Returns whether poMercSRS is WebMercator and poGeogSRS is WGS84 long/lat
+static bool IsWebMercatorAndWGS84LongLat(const OGRSpatialReference *poMercSRS,
+                                         const OGRSpatialReference *poGeogSRS)
+{
+    // Examine SRS ID before going to Proj4 string for faster execution
+    // This assumes that the SRS definition is "not lying", that is, it
+    // is equivalent to the resolution of the official EPSG code.
+    const char *pszMercAuth = poMercSRS->GetAuthorityName(nullptr);
+    const char *pszMercCode = poMercSRS->GetAuthorityCode(nullptr);
+    const char *pszGeogAuth = poGeogSRS->GetAuthorityName(nullptr);
+    const char *pszGeogCode = poGeogSRS->GetAuthorityCode(nullptr);
+    if (pszMercAuth && pszMercCode && pszGeogAuth && pszGeogCode &&
+        EQUAL(pszMercAuth, "EPSG") && EQUAL(pszGeogAuth, "EPSG"))
+    {
+        return (EQUAL(pszMercCode, "3857") ||
+                EQUAL(pszMercCode, "3785") ||     // deprecated
+                EQUAL(pszMercCode, "900913")) &&  // deprecated
+               EQUAL(pszGeogCode, "4326");
+    }
+
+    bool bRet = false;
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    char *pszSrcProj4Defn = nullptr;
+    poMercSRS->exportToProj4(&pszSrcProj4Defn);
+
+    char *pszDstProj4Defn = nullptr;
+    poGeogSRS->exportToProj4(&pszDstProj4Defn);
+    CPLPopErrorHandler();
+
+    if (pszSrcProj4Defn && pszDstProj4Defn)
+    {
+        if (pszSrcProj4Defn[0] != '\0' &&
+            pszSrcProj4Defn[strlen(pszSrcProj4Defn) - 1] == ' ')
+            pszSrcProj4Defn[strlen(pszSrcProj4Defn) - 1] = 0;
+        if (pszDstProj4Defn[0] != '\0' &&
+            pszDstProj4Defn[strlen(pszDstProj4Defn) - 1] == ' ')
+            pszDstProj4Defn[strlen(pszDstProj4Defn) - 1] = 0;
+        char *pszNeedle = strstr(pszSrcProj4Defn, "  ");
+        if (pszNeedle)
+            memmove(pszNeedle, pszNeedle + 1, strlen(pszNeedle + 1) + 1);
+        pszNeedle = strstr(pszDstProj4Defn, "  ");
+        if (pszNeedle)
+            memmove(pszNeedle, pszNeedle + 1, strlen(pszNeedle + 1) + 1);
+
+        if ((strstr(pszDstProj4Defn, "+datum=WGS84") != nullptr ||
+             strstr(pszDstProj4Defn, "+ellps=WGS84 +towgs84=0,0,0,0,0,0,0 ") !=
+                 nullptr) &&
+            strstr(pszSrcProj4Defn, "+nadgrids=@null ") != nullptr &&
+            strstr(pszSrcProj4Defn, "+towgs84") == nullptr)
+        {
+            char *pszDst = strstr(pszDstProj4Defn, "+towgs84=0,0,0,0,0,0,0 ");
+            if (pszDst != nullptr)
+            {
+                char *pszSrc = pszDst + strlen("+towgs84=0,0,0,0,0,0,0 ");
+                memmove(pszDst, pszSrc, strlen(pszSrc) + 1);
+            }
+            else
+            {
+                memcpy(strstr(pszDstProj4Defn, "+datum=WGS84"), "+ellps", 6);
+            }
+
+            pszDst = strstr(pszSrcProj4Defn, "+nadgrids=@null ");
+            char *pszSrc = pszDst + strlen("+nadgrids=@null ");
+            memmove(pszDst, pszSrc, strlen(pszSrc) + 1);
+
+            pszDst = strstr(pszSrcProj4Defn, "+wktext ");
+            if (pszDst)
+            {
+                pszSrc = pszDst + strlen("+wktext ");
+                memmove(pszDst, pszSrc, strlen(pszSrc) + 1);
+            }
+            bRet = strcmp(pszDstProj4Defn,
+                          "+proj=longlat +ellps=WGS84 +no_defs") == 0 &&
+                   (strcmp(pszSrcProj4Defn,
+                           "+proj=merc +a=6378137 +b=6378137 +lat_ts=0.0 "
+                           "+lon_0=0.0 "
+                           "+x_0=0.0 +y_0=0 +k=1.0 +units=m +no_defs") == 0 ||
+                    strcmp(pszSrcProj4Defn,
+                           "+proj=merc +a=6378137 +b=6378137 +lat_ts=0 "
+                           "+lon_0=0 "
+                           "+x_0=0 +y_0=0 +k=1 +units=m +no_defs") == 0);
+        }
+    }
+
+    CPLFree(pszSrcProj4Defn);
+    CPLFree(pszDstProj4Defn);
+    return bRet;
+}
+
 /************************************************************************/
 /*                        DetectWebMercatorToWGS84()                    */
 /************************************************************************/
 
+// Detect WebMercator <--> WGS84 long/lat, in both directions, for which
+// an optimized implementation is used instead of PROJ.
 void OGRProjCT::DetectWebMercatorToWGS84()
 {
+    if (!m_options.d->osCoordOperation.empty() || !poSRSSource ||
+        !poSRSTarget)
+    {
+        return;
+    }
+
     // Detect webmercator to WGS84
-    if (m_options.d->osCoordOperation.empty() && poSRSSource && poSRSTarget &&
-        poSRSSource->IsProjected() && poSRSTarget->IsGeographic() &&
+    if (poSRSSource->IsProjected() && poSRSTarget->IsGeographic() &&
         ((m_eTargetFirstAxisOrient == OAO_North &&
           poSRSTarget->GetDataAxisToSRSAxisMapping() ==
               std::vector<int>{2, 1}) ||
@@ -1316,104 +1421,29 @@ void OGRProjCT::DetectWebMercatorToWGS84()
           poSRSTarget->GetDataAxisToSRSAxisMapping() ==
               std::vector<int>{1, 2})))
     {
-        // Examine SRS ID before going to Proj4 string for faster execution
-        // This assumes that the SRS definition is "not lying", that is, it
-        // is equivalent to the resolution of the official EPSG code.
-        const char *pszSourceAuth = poSRSSource->GetAuthorityName(nullptr);
-        const char *pszSourceCode = poSRSSource->GetAuthorityCode(nullptr);
-        const char *pszTargetAuth = poSRSTarget->GetAuthorityName(nullptr);
-        const char *pszTargetCode = poSRSTarget->GetAuthorityCode(nullptr);
-        if (pszSourceAuth && pszSourceCode && pszTargetAuth && pszTargetCode &&
-            EQUAL(pszSourceAuth, "EPSG") && EQUAL(pszTargetAuth, "EPSG"))
-        {
-            bWebMercatorToWGS84LongLat =
-                (EQUAL(pszSourceCode, "3857") ||
-                 EQUAL(pszSourceCode, "3785") ||     // deprecated
-                 EQUAL(pszSourceCode, "900913")) &&  // deprecated
-                EQUAL(pszTargetCode, "4326");
-        }
-        else
-        {
-            CPLPushErrorHandler(CPLQuietErrorHandler);
-            char *pszSrcProj4Defn = nullptr;
-            poSRSSource->exportToProj4(&pszSrcProj4Defn);
-
-            char *pszDstProj4Defn = nullptr;
-            poSRSTarget->exportToProj4(&pszDstProj4Defn);
-            CPLPopErrorHandler();
-
-            if (pszSrcProj4Defn && pszDstProj4Defn)
-            {
-                if (pszSrcProj4Defn[0] != '\0' &&
-                    pszSrcProj4Defn[strlen(pszSrcProj4Defn) - 1] == ' ')
-                    pszSrcProj4Defn[strlen(pszSrcProj4Defn) - 1] = 0;
-                if (pszDstProj4Defn[0] != '\0' &&
-                    pszDstProj4Defn[strlen(pszDstProj4Defn) - 1] == ' ')
-                    pszDstProj4Defn[strlen(pszDstProj4Defn) - 1] = 0;
-                char *pszNeedle = strstr(pszSrcProj4Defn, "  ");
-                if (pszNeedle)
-                    memmove(pszNeedle, pszNeedle + 1,
-                            strlen(pszNeedle + 1) + 1);
-                pszNeedle = strstr(pszDstProj4Defn, "  ");
-                if (pszNeedle)
-                    memmove(pszNeedle, pszNeedle + 1,
-                            strlen(pszNeedle + 1) + 1);
-
-                if ((strstr(pszDstProj4Defn, "+datum=WGS84") != nullptr ||
-                     strstr(pszDstProj4Defn,
-                            "+ellps=WGS84 +towgs84=0,0,0,0,0,0,0 ") !=
-                         nullptr) &&
-                    strstr(pszSrcProj4Defn, "+nadgrids=@null ") != nullptr &&
-                    strstr(pszSrcProj4Defn, "+towgs84") == nullptr)
-                {
-                    char *pszDst =
-                        strstr(pszDstProj4Defn, "+towgs84=0,0,0,0,0,0,0 ");
-                    if (pszDst != nullptr)
-                    {
-                        char *pszSrc =
-                            pszDst + strlen("+towgs84=0,0,0,0,0,0,0 ");
-                        memmove(pszDst, pszSrc, strlen(pszSrc) + 1);
-                    }
-                    else
-                    {
-                        memcpy(strstr(pszDstProj4Defn, "+datum=WGS84"),
-                               "+ellps", 6);
-                    }
-
-                    pszDst = strstr(pszSrcProj4Defn, "+nadgrids=@null ");
-                    char *pszSrc = pszDst + strlen("+nadgrids=@null ");
-                    memmove(pszDst, pszSrc, strlen(pszSrc) + 1);
-
-                    pszDst = strstr(pszSrcProj4Defn, "+wktext ");
-                    if (pszDst)
-                    {
-                        pszSrc = pszDst + strlen("+wktext ");
-                        memmove(pszDst, pszSrc, strlen(pszSrc) + 1);
-                    }
-                    bWebMercatorToWGS84LongLat =
-                        strcmp(pszDstProj4Defn,
-                               "+proj=longlat +ellps=WGS84 +no_defs") == 0 &&
-                        (strcmp(pszSrcProj4Defn,
-                                "+proj=merc +a=6378137 +b=6378137 +lat_ts=0.0 "
-                                "+lon_0=0.0 "
-                                "+x_0=0.0 +y_0=0 +k=1.0 +units=m +no_defs") ==
-                             0 ||
-                         strcmp(pszSrcProj4Defn,
-                                "+proj=merc +a=6378137 +b=6378137 +lat_ts=0 "
-                                "+lon_0=0 "
-                                "+x_0=0 +y_0=0 +k=1 +units=m +no_defs") == 0);
-                }
-            }
-
-            CPLFree(pszSrcProj4Defn);
-            CPLFree(pszDstProj4Defn);
-        }
-
+        bWebMercatorToWGS84LongLat =
+            IsWebMercatorAndWGS84LongLat(poSRSSource, poSRSTarget);
         if (bWebMercatorToWGS84LongLat)
         {
             CPLDebug("OGRCT", "Using WebMercator to WGS84 optimization");
         }
     }
+    // Detect WGS84 to webmercator
+    else if (poSRSSource->IsGeographic() && poSRSTarget->IsProjected() &&
+             ((m_eSourceFirstAxisOrient == OAO_North &&
+               poSRSSource->GetDataAxisToSRSAxisMapping() ==
+                   std::vector<int>{2, 1}) ||
+              (m_eSourceFirstAxisOrient == OAO_East &&
+               poSRSSource->GetDataAxisToSRSAxisMapping() ==
+                   std::vector<int>{1, 2})))
+    {
+        bWGS84LongLatToWebMercator =
+            IsWebMercatorAndWGS84LongLat(poSRSTarget, poSRSSource);
+        if (bWGS84LongLatToWebMercator)
+        {
+            CPLDebug("OGRCT", "Using WGS84 to WebMercator optimization");
+        }
+    }
 }
 
 /************************************************************************/
@@ -1617,7 +1647,8 @@ int OGRProjCT::Initialize(const OGRSpatialReference *poSourceIn,
                  m_bReversePj ? "(reversed) " : "");
 #endif
     }
-    else if (!bWebMercatorToWGS84LongLat && poSRSSource && poSRSTarget)
+    else if (!bWebMercatorToWGS84LongLat && !bWGS84LongLatToWebMercator &&
+             poSRSSource && poSRSTarget)
     {
 #ifdef DEBUG_PERF
         struct CPLTimeVal tvStart;
@@ -2479,6 +2510,76 @@ int OGRProjCT::TransformWithErrorCodes(size_t nCount, double *x, double *y,
         bTransformDone = true;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Optimized transform from WGS84 to WebMercator                   */
+    /* -------------------------------------------------------------------- */
+    if (bWGS84LongLatToWebMercator)
+    {
+        constexpr double SPHERE_RADIUS = 6378137.0;
+        constexpr double DEG_TO_RAD = M_PI / 180.;
+
+        if (m_eSourceFirstAxisOrient != OAO_East)
+        {
+            std::swap(x, y);
+        }
+
+        double y0 = y[0];
+        for (size_t i = 0; i < nCount; i++)
+        {
+            if (x[i] == HUGE_VAL || y[i] == HUGE_VAL)
+            {
+                y0 = HUGE_VAL;
+                continue;
+            }
+
+            // Same tolerance as PROJ merc forward
+            const double dfLatRad = y[i] * DEG_TO_RAD;
+            if (!(std::fabs(dfLatRad) < M_PI / 2 - 1e-10))
+            {
+                x[i] = HUGE_VAL;
+                y[i] = HUGE_VAL;
+                y0 = HUGE_VAL;
+                continue;
+            }
+
+            // Longitude wrapping into [-180, 180], as done by PROJ
+            double dfLongRad = x[i] * DEG_TO_RAD;
+            if (std::fabs(dfLongRad) > M_PI + 1e-12)
+            {
+                dfLongRad += M_PI;
+                dfLongRad -= 2 * M_PI * std::floor(dfLongRad / (2 * M_PI));
+                dfLongRad -= M_PI;
+            }
+            x[i] = dfLongRad * SPHERE_RADIUS;
+
+            // Optimization for the case where we are provided a whole line
+            // of same latitude.
+            if (i > 0 && y[i] == y0)
+                y[i] = y[0];
+            else
+                y[i] = SPHERE_RADIUS * std::asinh(std::tan(dfLatRad));
+        }
+
+        if (panErrorCodes)
+        {
+            for (size_t i = 0; i < nCount; i++)
+            {
+                if (x[i] != HUGE_VAL)
+                    panErrorCodes[i] = 0;
+                else
+                    panErrorCodes[i] =
+                        PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN;
+            }
+        }
+
+        if (m_eTargetFirstAxisOrient != OAO_East)
+        {
+            std::swap(x, y);
+        }
+
+        bTransformDone = true;
+    }
+
     // Determine the default coordinate epoch, if not provided in the point to
     // transform.
     // For time-dependent transformations, PROJ can currently only do
@@ -3526,7 +3627,8 @@ OGRCoordinateTransformation *OGRProjCT::GetInverse() const
 {
     PJ *new_pj = nullptr;
     // m_pj can be nullptr if using m_eStrategy != PROJ
-    if (m_pj && !bWebMercatorToWGS84LongLat && !bNoTransform)
+    if (m_pj && !bWebMercatorToWGS84LongLat && !bWGS84LongLatToWebMercator &&
+        !bNoTransform)
     {
         // See https://github.com/OSGeo/PROJ/pull/2582
         // This may fail before PROJ 8.0.1 if the m_pj object is a "meta"
@@ -3583,12 +3685,85 @@ OGRCoordinateTransformation *OGRProjCT::GetInverse() const
     return poNewCT;
 }
 
+/************************************************************************/
+/*                      Per-thread cache of OGRProjCT                   */
+/************************************************************************/
+
+// Small cache of ready-to-use OGRProjCT objects, private to each thread, and
+// looked up before the global cache. This makes the common pattern of a
+// thread repeatedly creating and destroying a transformation for the same
+// pair of CRS lock-free. Entries evicted from it, or still present when the
+// thread terminates, are handed over to the global cache.
+
+static void InsertIntoGlobalCTCache(const CTCacheKey &key,
+                                    CTCacheValue &&poCT)
+{
+    std::lock_guard<std::mutex> oGuard(g_oCTCacheMutex);
+    if (g_poCTCache == nullptr)
+    {
+        g_poCTCache = new lru11::Cache<CTCacheKey, CTCacheValue>();
+    }
+    if (!g_poCTCache->contains(key))
+    {
+        g_poCTCache->insert(key, std::move(poCT));
+    }
+}
+
+// Currently thread_local and C++ objects don't work well with DLL on Windows
+#ifndef _WIN32
+
+namespace
+{
+struct OGRProjCTThreadLocalCache
+{
+    static constexpr size_t MAX_SIZE = 8;
+
+    int m_nGeneration = g_nCTCacheGeneration.load();
+    // Most recently used entries first
+    std::list<std::pair<CTCacheKey, CTCacheValue>> m_oList{};
+
+    OGRProjCTThreadLocalCache() = default;
+    OGRProjCTThreadLocalCache(const OGRProjCTThreadLocalCache &) = delete;
+    OGRProjCTThreadLocalCache &
+    operator=(const OGRProjCTThreadLocalCache &) = delete;
+
+    ~OGRProjCTThreadLocalCache()
+    {
+        if (m_nGeneration == g_nCTCacheGeneration.load())
+        {
+            for (auto &oPair : m_oList)
+                InsertIntoGlobalCTCache(oPair.first, std::move(oPair.second));
+        }
+    }
+
+    void Clear()
+    {
+        m_oList.clear();
+        m_nGeneration = g_nCTCacheGeneration.load();
+    }
+
+    void CheckGeneration()
+    {
+        if (m_nGeneration != g_nCTCacheGeneration.load())
+            Clear();
+    }
+};
+}  // namespace
+
+static thread_local OGRProjCTThreadLocalCache g_tls_oCTCache;
+
+#endif  // _WIN32
+
 /************************************************************************/
 /*                            OSRCTCleanCache()                         */
 /************************************************************************/
 
 void OSRCTCleanCache()
 {
+    ++g_nCTCacheGeneration;
+#ifndef _WIN32
+    g_tls_oCTCache.Clear();
+#endif
     std::lock_guard<std::mutex> oGuard(g_oCTCacheMutex);
     delete g_poCTCache;
     g_poCTCache = nullptr;
@@ -3634,24 +3809,31 @@ CTCacheKey OGRProjCT::MakeCacheKey(
 
 void OGRProjCT::InsertIntoCache(OGRProjCT *poCT)
 {
-    {
-        std::lock_guard<std::mutex> oGuard(g_oCTCacheMutex);
-        if (g_poCTCache == nullptr)
-        {
-            g_poCTCache = new lru11::Cache<CTCacheKey, CTCacheValue>();
-        }
-    }
     const auto key = MakeCacheKey(poCT->poSRSSource, poCT->m_osSrcSRS.c_str(),
                                   poCT->poSRSTarget,
                                   poCT->m_osTargetSRS.c_str(), poCT->m_options);
 
-    std::lock_guard<std::mutex> oGuard(g_oCTCacheMutex);
-    if (g_poCTCache->contains(key))
+#ifndef _WIN32
+    auto &oTLSCache = g_tls_oCTCache;
+    oTLSCache.CheckGeneration();
+    for (const auto &oPair : oTLSCache.m_oList)
     {
-        delete poCT;
-        return;
+        if (oPair.first == key)
+        {
+            delete poCT;
+            return;
+        }
+    }
+    oTLSCache.m_oList.emplace_front(key, std::unique_ptr<OGRProjCT>(poCT));
+    if (oTLSCache.m_oList.size() > OGRProjCTThreadLocalCache::MAX_SIZE)
+    {
+        auto &oOldest = oTLSCache.m_oList.back();
+        InsertIntoGlobalCTCache(oOldest.first, std::move(oOldest.second));
+        oTLSCache.m_oList.pop_back();
     }
-    g_poCTCache->insert(key, std::unique_ptr<OGRProjCT>(poCT));
+#else
+    InsertIntoGlobalCTCache(key, std::unique_ptr<OGRProjCT>(poCT));
+#endif
 }
 
 /************************************************************************/
@@ -3663,6 +3845,14 @@ OGRProjCT *OGRProjCT::FindFromCache(
     const OGRSpatialReference *poTarget, const char *pszTargetSRS,
     const OGRCoordinateTransformationOptions &options)
 {
+#ifndef _WIN32
+    auto &oTLSCache = g_tls_oCTCache;
+    oTLSCache.CheckGeneration();
+    const bool bTLSCacheEmpty = oTLSCache.m_oList.empty();
+#else
+    constexpr bool bTLSCacheEmpty = true;
+#endif
+    if (bTLSCacheEmpty)
     {
         std::lock_guard<std::mutex> oGuard(g_oCTCacheMutex);
         if (g_poCTCache == nullptr || g_poCTCache->empty())
@@ -3671,8 +3861,25 @@ OGRProjCT *OGRProjCT::FindFromCache(
 
     const auto key =
         MakeCacheKey(poSource, pszSrcSRS, poTarget, pszTargetSRS, options);
-    // Get value from cache and remove it
+
+#ifndef _WIN32
+    // Get value from the thread-local cache and remove it
+    for (auto oIter = oTLSCache.m_oList.begin();
+         oIter != oTLSCache.m_oList.end(); ++oIter)
+    {
+        if (oIter->first == key)
+        {
+            auto poCT = oIter->second.release();
+            oTLSCache.m_oList.erase(oIter);
+            return poCT;
+        }
+    }
+#endif
+
+    // Get value from the global cache and remove it
     std::lock_guard<std::mutex> oGuard(g_oCTCacheMutex);
+    if (g_poCTCache == nullptr)
+        return nullptr;
     CTCacheValue *cachedValue = g_poCTCache->getPtr(key);
     if (cachedValue)
     {
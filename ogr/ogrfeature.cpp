@@ -43,6 +43,7 @@
 #include <limits>
 #include <map>
 #include <new>
+#include <typeinfo>
 #include <vector>
 
 #include "cpl_conv.h"
@@ -1016,6 +1017,26 @@ OGRErr OGRFeature::SetGeomField(int iField, const OGRGeometry *poGeomIn)
 
     if (papoGeometries[iField] != poGeomIn)
     {
+        // Reuse the existing point or line string, and its point array, when
+        // assigning a geometry of the same class, as done when recycling
+        // features with OGRFeatureBatch.
+        OGRGeometry *poExisting = papoGeometries[iField];
+        if (poExisting != nullptr && poGeomIn != nullptr &&
+            typeid(*poExisting) == typeid(*poGeomIn))
+        {
+            const auto eFlatType = wkbFlatten(poGeomIn->getGeometryType());
+            if (eFlatType == wkbPoint)
+            {
+                *(poExisting->toPoint()) = *(poGeomIn->toPoint());
+                return OGRERR_NONE;
+            }
+            if (eFlatType == wkbLineString)
+            {
+                *(poExisting->toLineString()) = *(poGeomIn->toLineString());
+                return OGRERR_NONE;
+            }
+        }
+
         delete papoGeometries[iField];
 
         if (poGeomIn != nullptr)
@@ -6381,13 +6402,22 @@ OGRErr OGRFeature::SetFieldsFrom(const OGRFeature *poSrcFeature,
             }
             if (eSrcType == OFTString)
             {
+                const char *pszSrc =
+                    poSrcFeature->GetFieldAsStringUnsafe(iField);
                 if (IsFieldSetAndNotNullUnsafe(iDstField))
-                    CPLFree(pauFields[iDstField].String);
+                {
+                    // Reuse the current buffer if the new value fits in it
+                    char *pszDst = pauFields[iDstField].String;
+                    const size_t nSrcLen = strlen(pszSrc);
+                    if (nSrcLen <= strlen(pszDst))
+                    {
+                        memcpy(pszDst, pszSrc, nSrcLen + 1);
+                        continue;
+                    }
+                    CPLFree(pszDst);
+                }
 
-                SetFieldSameTypeUnsafe(
-                    iDstField,
-                    VSI_STRDUP_VERBOSE(
-                        poSrcFeature->GetFieldAsStringUnsafe(iField)));
+                SetFieldSameTypeUnsafe(iDstField, VSI_STRDUP_VERBOSE(pszSrc));
                 continue;
             }
         }
@@ -7443,6 +7473,59 @@ void OGRFeatureUniquePtrDeleter::operator()(OGRFeature *poFeature) const
 }
 //! @endcond
 
+/************************************************************************/
+/*                    OGRFeatureBatch::StealFeature()                   */
+/************************************************************************/
+
+/** Transfers the ownership of the i-th feature of the batch to the caller.
+ *
+ * The batch keeps an empty slot, that will be filled with a new feature
+ * when it is next recycled.
+ */
+OGRFeatureUniquePtr OGRFeatureBatch::StealFeature(int i)
+{
+    return std::move(m_apoFeatures[i]);
+}
+
+/************************************************************************/
+/*                   OGRFeatureBatch::AppendFeature()                   */
+/************************************************************************/
+
+/** Appends a feature to the batch, which takes ownership of it. */
+void OGRFeatureBatch::AppendFeature(OGRFeatureUniquePtr poFeature)
+{
+    if (m_nFeatureCount < m_apoFeatures.size())
+        m_apoFeatures[m_nFeatureCount] = std::move(poFeature);
+    else
+        m_apoFeatures.push_back(std::move(poFeature));
+    ++m_nFeatureCount;
+}
+
+/************************************************************************/
+/*               OGRFeatureBatch::AppendRecycledFeature()               */
+/************************************************************************/
+
+/** Appends a feature of definition poDefn to the batch, and returns it.
+ *
+ * When possible, a feature of a previous use of the batch is returned. It
+ * still holds its previous content: the caller must overwrite all its fields,
+ * for example with OGRFeature::SetFrom(), or call OGRFeature::Reset().
+ */
+OGRFeature *OGRFeatureBatch::AppendRecycledFeature(OGRFeatureDefn *poDefn)
+{
+    if (m_nFeatureCount < m_apoFeatures.size())
+    {
+        auto &poFeature = m_apoFeatures[m_nFeatureCount];
+        if (!poFeature || poFeature->GetDefnRef() != poDefn)
+            poFeature.reset(new OGRFeature(poDefn));
+    }
+    else
+    {
+        m_apoFeatures.emplace_back(new OGRFeature(poDefn));
+    }
+    return m_apoFeatures[m_nFeatureCount++].get();
+}
+
 /************************************************************************/
 /*                    OGRFeature::ConstFieldIterator                    */
 /************************************************************************/
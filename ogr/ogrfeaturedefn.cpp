@@ -1229,6 +1229,32 @@ int OGRFeatureDefn::GetFieldIndex(const char *pszFieldName) const
 
 {
     const int nFieldCount = GetFieldCount();
+
+    // For layers with many fields, use a map from the upper-cased names to
+    // the indices, that is only valid while names can not change.
+    constexpr int MIN_FIELD_COUNT_FOR_MAP = 16;
+    if (m_bFieldIndexMapAllowed && nFieldCount >= MIN_FIELD_COUNT_FOR_MAP)
+    {
+        if (!m_bFieldIndexMapBuilt.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> oLock(m_oFieldIndexMapMutex);
+            if (!m_bFieldIndexMapBuilt.load(std::memory_order_relaxed))
+            {
+                m_oMapFieldIndex.clear();
+                for (int i = 0; i < nFieldCount; i++)
+                {
+                    // emplace() keeps the first field of a given name
+                    m_oMapFieldIndex.emplace(
+                        CPLString(GetFieldDefn(i)->GetNameRef()).toupper(), i);
+                }
+                m_bFieldIndexMapBuilt.store(true, std::memory_order_release);
+            }
+        }
+        const auto oIter =
+            m_oMapFieldIndex.find(CPLString(pszFieldName).toupper());
+        return oIter == m_oMapFieldIndex.end() ? -1 : oIter->second;
+    }
+
     for (int i = 0; i < nFieldCount; i++)
     {
         const OGRFieldDefn *poFDefn = GetFieldDefn(i);
@@ -1687,6 +1713,7 @@ void OGRFeatureDefn::Seal(bool bSealFields)
             GetGeomFieldDefn(i)->Seal();
     }
     m_bSealed = true;
+    m_bFieldIndexMapAllowed = bSealFields;
 }
 
 /************************************************************************/
@@ -1719,6 +1746,9 @@ void OGRFeatureDefn::Unseal(bool bUnsealFields)
         return;
     }
     m_bSealed = false;
+    m_bFieldIndexMapAllowed = false;
+    m_bFieldIndexMapBuilt = false;
+    m_oMapFieldIndex.clear();
     if (bUnsealFields)
     {
         const int nFieldCount = GetFieldCount();
@@ -35,6 +35,8 @@
 #include <cstddef>
 #include <cstdlib>
 #include <algorithm>
+#include <cstring>
+#include <memory>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -73,6 +75,7 @@ OGRFeatureQuery::OGRFeatureQuery()
 OGRFeatureQuery::~OGRFeatureQuery()
 
 {
+    delete m_poProgram;
     delete m_psContext;
     delete static_cast<swq_expr_node *>(pSWQExpr);
 }
@@ -122,6 +125,9 @@ OGRFeatureQuery::Compile(OGRLayer *poLayer, OGRFeatureDefn *poDefn,
         delete static_cast<swq_expr_node *>(pSWQExpr);
         pSWQExpr = nullptr;
     }
+    delete m_poProgram;
+    m_poProgram = nullptr;
+    m_bMustCompileProgram = false;
 
     const char *pszFIDColumn = nullptr;
     bool bMustAddFID = false;
@@ -243,6 +249,14 @@ OGRFeatureQuery::Compile(OGRLayer *poLayer, OGRFeatureDefn *poDefn,
         eErr = OGRERR_CORRUPT_DATA;
         pSWQExpr = nullptr;
     }
+    else
+    {
+        // The program is built at first use, as drivers may rewrite the
+        // expression tree returned by GetSWQExpr() in SetAttributeFilter().
+        m_bMustCompileProgram =
+            bCheck &&
+            CPLTestBool(CPLGetConfigOption("OGR_SQL_COMPILED_FILTER", "YES"));
+    }
 
     CPLFree(papszFieldNames);
     CPLFree(paeFieldTypes);
@@ -318,6 +332,83 @@ static swq_expr_node *OGRFeatureFetcher(swq_expr_node *op, void *pFeatureIn)
     return poRetNode;
 }
 
+/************************************************************************/
+/*                             GetProgram()                             */
+/************************************************************************/
+
+/** Returns the compiled form of the expression, or nullptr if it could not
+ * be compiled, in which case the swq_expr_node tree must be evaluated. */
+swq_program *OGRFeatureQuery::GetProgram()
+{
+    if (m_bMustCompileProgram)
+    {
+        m_bMustCompileProgram = false;
+        // Compile the expression tree into a flat program when possible,
+        // to avoid allocating swq_expr_node objects at each evaluation.
+        m_poProgram = swq_program::Compile(
+                          static_cast<swq_expr_node *>(pSWQExpr),
+                          poTargetDefn->GetFieldCount(),
+                          poTargetDefn->GetGeomFieldCount())
+                          .release();
+    }
+    return m_poProgram;
+}
+
+/************************************************************************/
+/*                  OGRFeatureQueryLoadProgramColumns()                 */
+/************************************************************************/
+
+static void OGRFeatureQueryLoadProgramColumns(const swq_program *poProgram,
+                                              OGRFeature *poFeature,
+                                              swq_program::Scratch &oScratch)
+{
+    const auto &aoColumns = poProgram->GetColumns();
+    auto &aoValues = oScratch.aoColumns;
+    aoValues.resize(aoColumns.size());
+    for (size_t i = 0; i < aoColumns.size(); ++i)
+    {
+        const auto &oColumn = aoColumns[i];
+        auto &oValues = aoValues[i];
+        const int idx = oColumn.field_index;
+        const bool bIsNull = !poFeature->IsFieldSetAndNotNull(idx);
+        oValues.abyIsNull.resize(1);
+        oValues.abyIsNull[0] = static_cast<GByte>(bIsNull);
+        switch (oColumn.value_type)
+        {
+            case SWQ_INTEGER64:
+                oValues.anValues.resize(1);
+                // Same accessors as OGRFeatureFetcher()
+                oValues.anValues[0] =
+                    bIsNull ? 0
+                    : oColumn.field_type == SWQ_INTEGER64
+                        ? poFeature->GetFieldAsInteger64(idx)
+                        : poFeature->GetFieldAsInteger(idx);
+                break;
+
+            case SWQ_FLOAT:
+                oValues.adfValues.resize(1);
+                oValues.adfValues[0] =
+                    bIsNull ? 0.0 : poFeature->GetFieldAsDouble(idx);
+                break;
+
+            case SWQ_STRING:
+            {
+                const char *pszStr =
+                    bIsNull ? "" : poFeature->GetFieldAsString(idx);
+                oValues.apszValues.resize(1);
+                oValues.anLengths.resize(1);
+                oValues.apszValues[0] = pszStr;
+                oValues.anLengths[0] = strlen(pszStr);
+                oValues.bNulTerminated = true;
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+}
+
 /************************************************************************/
 /*                              Evaluate()                              */
 /************************************************************************/
@@ -328,6 +419,16 @@ int OGRFeatureQuery::Evaluate(OGRFeature *poFeature)
     if (pSWQExpr == nullptr)
         return FALSE;
 
+    if (swq_program *poProgram = GetProgram())
+    {
+        auto &oScratch = poProgram->GetScratch();
+        OGRFeatureQueryLoadProgramColumns(poProgram, poFeature, oScratch);
+        GByte bResult = 0;
+        poProgram->Evaluate(1, oScratch.aoColumns, *m_psContext, oScratch,
+                            &bResult);
+        return bResult;
+    }
+
     swq_expr_node *poResult = static_cast<swq_expr_node *>(pSWQExpr)->Evaluate(
         OGRFeatureFetcher, poFeature, *m_psContext);
 
@@ -30,12 +30,14 @@
 #include "cpl_port.h"
 #include "ogr_geometry.h"
 
+#include <algorithm>
 #include <climits>
 #include <cstdarg>
 #include <cstddef>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <functional>
 #include <limits>
 #include <memory>
 
@@ -43,6 +45,8 @@
 #include "cpl_error.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_geos.h"
@@ -2275,6 +2279,227 @@ int OGR_G_IsValid(OGRGeometryH hGeom)
     return OGRGeometry::FromHandle(hGeom)->IsValid();
 }
 
+/************************************************************************/
+/*                    OGRGeometryBatchGetThreadPool()                   */
+/************************************************************************/
+
+// Returns the thread pool to use to process nCount geometries, or nullptr
+// if they must be processed in the calling thread.
+static CPLWorkerThreadPool *
+OGRGeometryBatchGetThreadPool(size_t nCount, CSLConstList papszOptions)
+{
+    constexpr size_t MIN_GEOMS_PER_THREAD = 64;
+    if (nCount < 2 * MIN_GEOMS_PER_THREAD)
+        return nullptr;
+    const char *pszNumThreads = CSLFetchNameValueDef(
+        papszOptions, "NUM_THREADS",
+        CPLGetConfigOption("GDAL_NUM_THREADS", "ALL_CPUS"));
+    int nThreadsMax;
+    if (EQUAL(pszNumThreads, "ALL_CPUS"))
+        nThreadsMax = CPLGetNumCPUs();
+    else
+        nThreadsMax = std::max(1, atoi(pszNumThreads));
+    const int nThreads = static_cast<int>(
+        std::min(static_cast<size_t>(std::min(nThreadsMax, 128)),
+                 nCount / MIN_GEOMS_PER_THREAD));
+    return nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+}
+
+/************************************************************************/
+/*                    OGRGeometryBatchRunJobs()                         */
+/************************************************************************/
+
+// Splits [0, nCount[ into chunks that are processed by pfnChunk, either in
+// the calling thread or in the thread pool. Chunks are smaller than
+// nCount / nThreads, so that a few complex geometries do not leave the
+// other threads idle.
+static void
+OGRGeometryBatchRunJobs(size_t nCount, CSLConstList papszOptions,
+                        const std::function<void(size_t, size_t)> &pfnChunk)
+{
+    CPLWorkerThreadPool *poPool =
+        OGRGeometryBatchGetThreadPool(nCount, papszOptions);
+    if (poPool == nullptr)
+    {
+        pfnChunk(0, nCount);
+        return;
+    }
+
+    struct JobData
+    {
+        const std::function<void(size_t, size_t)> *pfnChunk;
+        size_t nStart;
+        size_t nEnd;
+    };
+
+    const size_t nChunkSize = std::max<size_t>(
+        1, nCount / (8 * static_cast<size_t>(poPool->GetThreadCount())));
+    std::vector<JobData> asJobs;
+    for (size_t nStart = 0; nStart < nCount; nStart += nChunkSize)
+        asJobs.push_back(
+            {&pfnChunk, nStart, std::min(nCount, nStart + nChunkSize)});
+
+    auto poQueue = poPool->CreateJobQueue();
+    for (auto &sJob : asJobs)
+    {
+        poQueue->SubmitJob(
+            [](void *pData)
+            {
+                const auto psJob = static_cast<const JobData *>(pData);
+                (*psJob->pfnChunk)(psJob->nStart, psJob->nEnd);
+            },
+            &sJob);
+    }
+    poQueue->WaitCompletion();
+}
+
+/************************************************************************/
+/*                         validateGeometries()                         */
+/************************************************************************/
+
+/**
+ * \brief Test the validity of an array of geometries.
+ *
+ * This is the batch version of OGRGeometry::IsValid(). Geometries are
+ * dispatched to a thread pool, each job reusing a single GEOS context for
+ * all the geometries it processes.
+ *
+ * The validity is returned as one byte per geometry (1 for valid, 0 for
+ * invalid), so that it can be directly used as a column of results.
+ * Null entries of papoGeoms are reported as valid.
+ *
+ * Options:
+ * <ul>
+ * <li>NUM_THREADS=integer or ALL_CPUS. Number of worker threads. Defaults
+ * to the value of the GDAL_NUM_THREADS configuration option, or ALL_CPUS.
+ * </li>
+ * </ul>
+ *
+ * This method is built on the GEOS library. If OGR is built without the
+ * GEOS library, it will return false.
+ *
+ * @param papoGeoms Array of nCount geometries (entries may be null).
+ * @param nCount Number of geometries.
+ * @param pabyValid Array of nCount bytes, set to 1 for valid geometries and
+ *                  0 for invalid ones.
+ * @param paosReasons If not null, resized to nCount and set to the reason
+ *                    of invalidity of each invalid geometry, or to an empty
+ *                    string for valid ones.
+ * @param papszOptions Options, or nullptr.
+ * @return true in case of success.
+ * @since GDAL 3.9
+ */
+
+bool OGRGeometryFactory::validateGeometries(
+    UNUSED_IF_NO_GEOS const OGRGeometry *const *papoGeoms, size_t nCount,
+    GByte *pabyValid, std::vector<std::string> *paosReasons,
+    UNUSED_IF_NO_GEOS CSLConstList papszOptions)
+{
+    if (paosReasons)
+    {
+        paosReasons->clear();
+        paosReasons->resize(nCount);
+    }
+
+#ifndef HAVE_GEOS
+    CPLError(CE_Failure, CPLE_NotSupported, "GEOS support not enabled.");
+    memset(pabyValid, 0, nCount);
+    return false;
+#else
+    OGRGeometryBatchRunJobs(
+        nCount, papszOptions,
+        [papoGeoms, pabyValid, paosReasons](size_t nStart, size_t nEnd)
+        {
+            // See OGRGeometry::IsValid() for the choice of the handlers.
+            GEOSContextHandle_t hGEOSCtxt =
+                initGEOS_r(OGRGEOSWarningHandler, OGRGEOSWarningHandler);
+            for (size_t i = nStart; i < nEnd; ++i)
+            {
+                const OGRGeometry *poGeom = papoGeoms[i];
+                pabyValid[i] = 1;
+                if (poGeom == nullptr)
+                    continue;
+
+                if (poGeom->IsSFCGALCompatible())
+                {
+                    pabyValid[i] = static_cast<GByte>(poGeom->IsValid());
+                    if (!pabyValid[i] && paosReasons)
+                        (*paosReasons)[i] = "Invalid geometry";
+                    continue;
+                }
+
+                GEOSGeom hGeosGeom = poGeom->exportToGEOS(hGEOSCtxt);
+                if (hGeosGeom == nullptr)
+                {
+                    pabyValid[i] = 0;
+                    if (paosReasons)
+                        (*paosReasons)[i] = "Cannot be converted to GEOS";
+                    continue;
+                }
+                pabyValid[i] =
+                    GEOSisValid_r(hGEOSCtxt, hGeosGeom) == 1 ? 1 : 0;
+                if (!pabyValid[i] && paosReasons)
+                {
+                    char *pszReason =
+                        GEOSisValidReason_r(hGEOSCtxt, hGeosGeom);
+                    if (pszReason)
+                    {
+                        (*paosReasons)[i] = pszReason;
+                        GEOSFree_r(hGEOSCtxt, pszReason);
+                    }
+                }
+                GEOSGeom_destroy_r(hGEOSCtxt, hGeosGeom);
+            }
+            OGRGeometry::freeGEOSContext(hGEOSCtxt);
+        });
+    return true;
+#endif
+}
+
+/************************************************************************/
+/*                        makeValidGeometries()                         */
+/************************************************************************/
+
+/**
+ * \brief Make an array of geometries valid.
+ *
+ * This is the batch version of OGRGeometry::MakeValid(). Geometries are
+ * dispatched to a thread pool.
+ *
+ * Options are those of OGRGeometry::MakeValid(), plus:
+ * <ul>
+ * <li>NUM_THREADS=integer or ALL_CPUS. Number of worker threads. Defaults
+ * to the value of the GDAL_NUM_THREADS configuration option, or ALL_CPUS.
+ * </li>
+ * </ul>
+ *
+ * @param papoGeoms Array of nCount geometries (entries may be null).
+ * @param nCount Number of geometries.
+ * @param papszOptions Options, or nullptr.
+ * @return a vector of nCount geometries, with a null entry for null input
+ * geometries and geometries that could not be made valid.
+ * @since GDAL 3.9
+ */
+
+std::vector<std::unique_ptr<OGRGeometry>>
+OGRGeometryFactory::makeValidGeometries(const OGRGeometry *const *papoGeoms,
+                                        size_t nCount,
+                                        CSLConstList papszOptions)
+{
+    std::vector<std::unique_ptr<OGRGeometry>> apoRet(nCount);
+    OGRGeometryBatchRunJobs(
+        nCount, papszOptions,
+        [papoGeoms, papszOptions, &apoRet](size_t nStart, size_t nEnd)
+        {
+            for (size_t i = nStart; i < nEnd; ++i)
+            {
+                if (papoGeoms[i])
+                    apoRet[i].reset(papoGeoms[i]->MakeValid(papszOptions));
+            }
+        });
+    return apoRet;
+}
+
 /************************************************************************/
 /*                              IsSimple()                               */
 /************************************************************************/
@@ -6274,6 +6499,8 @@ struct _OGRPreparedGeometry
     GEOSContextHandle_t hGEOSCtxt;
     GEOSGeom hGEOSGeom;
     const GEOSPreparedGeometry *poPreparedGEOSGeom;
+    // Lazily instantiated by OGRPreparedGeometryIntersectsWKB()
+    GEOSWKBReader *hWKBReader;
 };
 #endif
 
@@ -6330,6 +6557,7 @@ OGRCreatePreparedGeometry(UNUSED_IF_NO_GEOS OGRGeometryH hGeom)
     poPreparedGeom->hGEOSCtxt = hGEOSCtxt;
     poPreparedGeom->hGEOSGeom = hGEOSGeom;
     poPreparedGeom->poPreparedGEOSGeom = poPreparedGEOSGeom;
+    poPreparedGeom->hWKBReader = nullptr;
 
     return poPreparedGeom;
 #else
@@ -6351,6 +6579,9 @@ void OGRDestroyPreparedGeometry(
 #if defined(HAVE_GEOS)
     if (hPreparedGeom != nullptr)
     {
+        if (hPreparedGeom->hWKBReader)
+            GEOSWKBReader_destroy_r(hPreparedGeom->hGEOSCtxt,
+                                    hPreparedGeom->hWKBReader);
         GEOSPreparedGeom_destroy_r(hPreparedGeom->hGEOSCtxt,
                                    hPreparedGeom->poPreparedGEOSGeom);
         GEOSGeom_destroy_r(hPreparedGeom->hGEOSCtxt, hPreparedGeom->hGEOSGeom);
@@ -6401,6 +6632,73 @@ int OGRPreparedGeometryIntersects(
 #endif
 }
 
+/************************************************************************/
+/*                  OGRPreparedGeometryIntersectsWKB()                  */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+/** Returns whether a prepared geometry intersects with a geometry encoded
+ * as WKB, without instantiating a OGRGeometry.
+ *
+ * Only 2D and 2.5D (0x80000000 flag) simple features, excluding geometry
+ * collections, are handled: that is the subset of WKB that all GEOS versions
+ * read consistently with OGR.
+ *
+ * @return false if the WKB geometry could not be processed, in which case
+ * bIntersects is undefined and the caller must fall back to a OGRGeometry
+ * based test.
+ */
+bool OGRPreparedGeometryIntersectsWKB(
+    UNUSED_IF_NO_GEOS OGRPreparedGeometry *hPreparedGeom,
+    UNUSED_IF_NO_GEOS const GByte *pabyWKB, UNUSED_IF_NO_GEOS size_t nWKBSize,
+    UNUSED_IF_NO_GEOS bool &bIntersects)
+{
+#if defined(HAVE_GEOS)
+    if (hPreparedGeom == nullptr || nWKBSize < 9 ||
+        (pabyWKB[0] != wkbNDR && pabyWKB[0] != wkbXDR))
+    {
+        return false;
+    }
+    uint32_t nType;
+    memcpy(&nType, pabyWKB + 1, sizeof(nType));
+    if (OGR_SWAP(static_cast<OGRwkbByteOrder>(pabyWKB[0])))
+        CPL_SWAP32PTR(&nType);
+    nType &= ~static_cast<uint32_t>(wkb25DBitInternalUse);
+    if (nType < wkbPoint || nType > wkbMultiPolygon)
+        return false;
+
+    if (hPreparedGeom->hWKBReader == nullptr)
+    {
+        hPreparedGeom->hWKBReader =
+            GEOSWKBReader_create_r(hPreparedGeom->hGEOSCtxt);
+        if (hPreparedGeom->hWKBReader == nullptr)
+            return false;
+    }
+
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    GEOSGeom hGEOSOtherGeom =
+        GEOSWKBReader_read_r(hPreparedGeom->hGEOSCtxt,
+                             hPreparedGeom->hWKBReader, pabyWKB, nWKBSize);
+    CPLPopErrorHandler();
+    if (hGEOSOtherGeom == nullptr)
+        return false;
+
+    // The check for emptiness is for buggy GEOS versions.
+    // See https://github.com/libgeos/geos/pull/423
+    bIntersects =
+        GEOSisEmpty_r(hPreparedGeom->hGEOSCtxt, hGEOSOtherGeom) == 0 &&
+        GEOSPreparedIntersects_r(hPreparedGeom->hGEOSCtxt,
+                                 hPreparedGeom->poPreparedGEOSGeom,
+                                 hGEOSOtherGeom) == 1;
+    GEOSGeom_destroy_r(hPreparedGeom->hGEOSCtxt, hGEOSOtherGeom);
+    return true;
+#else
+    return false;
+#endif
+}
+
+//! @endcond
+
 /** Returns whether a prepared geometry contains a geometry.
  * @param hPreparedGeom prepared geometry.
  * @param hOtherGeom other geometry.
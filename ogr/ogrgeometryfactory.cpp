@@ -32,6 +32,7 @@
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_quad_tree.h"
 #include "cpl_string.h"
 #include "ogr_geometry.h"
 #include "ogr_api.h"
@@ -54,6 +55,7 @@
 #include <cstddef>
 
 #include <algorithm>
+#include <functional>
 #include <limits>
 #include <new>
 #include <utility>
@@ -1879,7 +1881,10 @@ OGRGeometry *OGRGeometryFactory::organizePolygons(OGRGeometry **papoPolygons,
           outer ring
        5) Add the top-level polygons to the multipolygon
 
-       Complexity : O(nPolygonCount^2)
+       Complexity : O(nPolygonCount^2) in the worst case. When there are
+       many polygons, the candidate enclosing polygons of step 2 are
+       retrieved from a quad tree of their envelopes, which brings it down
+       to O(nPolygonCount * log(nPolygonCount)) for typical inputs.
     */
 
     /* Compute how each polygon relate to the other ones
@@ -1916,6 +1921,36 @@ OGRGeometry *OGRGeometryFactory::organizePolygons(OGRGeometry **papoPolygons,
 
     int nCountTopLevel = 1;
 
+    // Only polygons whose envelope intersects the one of polygon i need to
+    // be considered in step 2. When there are many of them, index their
+    // envelopes instead of iterating over all previous polygons.
+    CPLQuadTree *hQuadTree = nullptr;
+    if (!bMixedUpGeometries && asPolyEx.size() > N_CRITICAL_PART_NUMBER)
+    {
+        OGREnvelope sGlobalEnvelope;
+        for (const auto &sPolyEx : asPolyEx)
+            sGlobalEnvelope.Merge(sPolyEx.sEnvelope);
+        CPLRectObj sGlobalBounds;
+        sGlobalBounds.minx = sGlobalEnvelope.MinX;
+        sGlobalBounds.miny = sGlobalEnvelope.MinY;
+        sGlobalBounds.maxx = sGlobalEnvelope.MaxX;
+        sGlobalBounds.maxy = sGlobalEnvelope.MaxY;
+        hQuadTree = CPLQuadTreeCreate(&sGlobalBounds, nullptr);
+        CPLQuadTreeSetMaxDepth(hQuadTree,
+                               CPLQuadTreeGetAdvisedMaxDepth(
+                                   static_cast<int>(asPolyEx.size())));
+        for (auto &sPolyEx : asPolyEx)
+        {
+            CPLRectObj sBounds;
+            sBounds.minx = sPolyEx.sEnvelope.MinX;
+            sBounds.miny = sPolyEx.sEnvelope.MinY;
+            sBounds.maxx = sPolyEx.sEnvelope.MaxX;
+            sBounds.maxy = sPolyEx.sEnvelope.MaxY;
+            CPLQuadTreeInsertWithBounds(hQuadTree, &sPolyEx, &sBounds);
+        }
+    }
+    std::vector<int> anCandidates;
+
     // STEP 2.
     for (int i = 1; !bMixedUpGeometries && bValidTopology &&
                     i < static_cast<int>(asPolyEx.size());
@@ -1929,9 +1964,38 @@ OGRGeometry *OGRGeometryFactory::organizePolygons(OGRGeometry **papoPolygons,
             continue;
         }
 
-        int j = i - 1;  // Used after for.
-        for (; bValidTopology && j >= 0; j--)
+        // Candidates are polygons of rank [i-1 ... 0], in that order.
+        int nCandidates = i;
+        if (hQuadTree)
         {
+            CPLRectObj sAOI;
+            sAOI.minx = asPolyEx[i].sEnvelope.MinX;
+            sAOI.miny = asPolyEx[i].sEnvelope.MinY;
+            sAOI.maxx = asPolyEx[i].sEnvelope.MaxX;
+            sAOI.maxy = asPolyEx[i].sEnvelope.MaxY;
+            int nFeatureCount = 0;
+            void **pahFeatures =
+                CPLQuadTreeSearch(hQuadTree, &sAOI, &nFeatureCount);
+            anCandidates.clear();
+            for (int k = 0; k < nFeatureCount; ++k)
+            {
+                const int j = static_cast<int>(
+                    static_cast<const sPolyExtended *>(pahFeatures[k]) -
+                    asPolyEx.data());
+                if (j < i)
+                    anCandidates.push_back(j);
+            }
+            CPLFree(pahFeatures);
+            std::sort(anCandidates.begin(), anCandidates.end(),
+                      std::greater<int>());
+            nCandidates = static_cast<int>(anCandidates.size());
+        }
+
+        int iCandidate = 0;  // Used after for.
+        for (; bValidTopology && iCandidate < nCandidates; iCandidate++)
+        {
+            const int j =
+                hQuadTree ? anCandidates[iCandidate] : i - 1 - iCandidate;
             bool b_i_inside_j = false;
 
             if (method == METHOD_ONLY_CCW && asPolyEx[j].bIsCW == false)
@@ -2105,7 +2169,7 @@ OGRGeometry *OGRGeometryFactory::organizePolygons(OGRGeometry **papoPolygons,
             }
         }
 
-        if (j < 0)
+        if (iCandidate == nCandidates)
         {
             // We come here because we are not included in anything.
             // We are toplevel.
@@ -2115,6 +2179,9 @@ OGRGeometry *OGRGeometryFactory::organizePolygons(OGRGeometry **papoPolygons,
         }
     }
 
+    if (hQuadTree)
+        CPLQuadTreeDestroy(hQuadTree);
+
     if (pbIsValidGeometry)
         *pbIsValidGeometry = bValidTopology && !bMixedUpGeometries;
 
@@ -29,6 +29,7 @@
 #include "gdal_pam.h"
 #include "ogrsf_frmts.h"
 
+#include <algorithm>
 #include <map>
 
 #include "ogr_feather.h"
@@ -160,6 +161,21 @@ static GDALDataset *OGRFeatherDriverOpen(GDALOpenInfo *poOpenInfo)
         poOpenInfo->fpL = nullptr;
         infile = std::make_shared<OGRArrowRandomAccessFile>(std::move(fp));
     }
+    else if (CPLTestBool(CPLGetConfigOption("OGR_ARROW_MEM_MAP", "YES")))
+    {
+        // Uncompressed buffers of record batches then directly point to
+        // the mapped pages, instead of being copied.
+        auto result = arrow::io::MemoryMappedFile::Open(
+            poOpenInfo->pszFilename, arrow::io::FileMode::READ);
+        if (!result.ok())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "MemoryMappedFile::Open() failed with %s",
+                     result.status().message().c_str());
+            return nullptr;
+        }
+        infile = *result;
+    }
     else
     {
         auto result = arrow::io::ReadableFile::Open(poOpenInfo->pszFilename);
@@ -178,6 +194,19 @@ static GDALDataset *OGRFeatherDriverOpen(GDALOpenInfo *poOpenInfo)
     auto options = arrow::ipc::IpcReadOptions::Defaults();
     options.memory_pool = poMemoryPool.get();
 
+    // Compressed buffers of a record batch are decompressed in parallel by
+    // the Arrow CPU thread pool.
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    int nNumThreads = 0;
+    if (pszNumThreads == nullptr)
+        nNumThreads = std::min(4, CPLGetNumCPUs());
+    else
+        nNumThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                       : atoi(pszNumThreads);
+    options.use_threads = nNumThreads > 1;
+    if (nNumThreads > 1)
+        CPL_IGNORE_RET_VAL(arrow::SetCpuThreadPoolCapacity(nNumThreads));
+
     auto poDS = std::make_unique<OGRFeatherDataset>(poMemoryPool);
     if (bIsStreamingFormat)
     {
@@ -53,6 +53,7 @@
 #include "arrow/record_batch.h"
 #include "arrow/util/decimal.h"
 #include "arrow/util/key_value_metadata.h"
+#include "arrow/util/thread_pool.h"
 
 #ifdef _MSC_VER
 #pragma warning(pop)
@@ -59,6 +59,20 @@ class DXFBlockDefinition
     ~DXFBlockDefinition();
 
     std::vector<OGRDXFFeature *> apoFeatures;
+
+    // Geometries, in block coordinates, that get merged together when the
+    // block is inserted inline with DXF_MERGE_BLOCK_GEOMETRIES enabled.
+    // Computed on the first such insertion, and only used if the block
+    // does not produce any other feature (text, attributes, etc.)
+    enum class MergedGeometryCacheState
+    {
+        UNKNOWN,
+        VALID,
+        UNCACHEABLE
+    };
+    MergedGeometryCacheState eMergedGeometryCacheState =
+        MergedGeometryCacheState::UNKNOWN;
+    std::vector<std::unique_ptr<OGRGeometry>> apoMergedGeometries{};
 };
 
 /************************************************************************/
@@ -147,7 +161,7 @@ class OGRDXFInsertTransformer final : public OGRCoordinateTransformation
     double dfZScale = 1.0;
     double dfAngle = 0.0;
 
-    OGRDXFInsertTransformer GetOffsetTransformer()
+    OGRDXFInsertTransformer GetOffsetTransformer() const
     {
         OGRDXFInsertTransformer oResult;
         oResult.dfXOffset = this->dfXOffset;
@@ -155,7 +169,7 @@ class OGRDXFInsertTransformer final : public OGRCoordinateTransformation
         oResult.dfZOffset = this->dfZOffset;
         return oResult;
     }
-    OGRDXFInsertTransformer GetRotateScaleTransformer()
+    OGRDXFInsertTransformer GetRotateScaleTransformer() const
     {
         OGRDXFInsertTransformer oResult;
         oResult.dfXScale = this->dfXScale;
@@ -182,6 +196,8 @@ class OGRDXFInsertTransformer final : public OGRCoordinateTransformation
     int Transform(size_t nCount, double *x, double *y, double *z,
                   double * /* t */, int *pabSuccess) override
     {
+        const double dfCos = cos(dfAngle);
+        const double dfSin = sin(dfAngle);
         for (size_t i = 0; i < nCount; i++)
         {
             x[i] *= dfXScale;
@@ -189,8 +205,8 @@ class OGRDXFInsertTransformer final : public OGRCoordinateTransformation
             if (z)
                 z[i] *= dfZScale;
 
-            const double dfXNew = x[i] * cos(dfAngle) - y[i] * sin(dfAngle);
-            const double dfYNew = x[i] * sin(dfAngle) + y[i] * cos(dfAngle);
+            const double dfXNew = x[i] * dfCos - y[i] * dfSin;
+            const double dfYNew = x[i] * dfSin + y[i] * dfCos;
 
             x[i] = dfXNew;
             y[i] = dfYNew;
@@ -598,7 +614,11 @@ class OGRDXFReader
     unsigned int iSrcBufferOffset;
     unsigned int nSrcBufferBytes;
     unsigned int iSrcBufferFileOffset;
-    char achSrcBuffer[1025];
+
+    // Number of bytes read from disk at a time. The buffer holds at most
+    // two chunks, plus a nul terminator.
+    static constexpr unsigned int nChunkSize = 8192;
+    char achSrcBuffer[2 * nChunkSize + 1];
 
     unsigned int nLastValueSize;
     int nLineNumber;
@@ -2773,6 +2773,38 @@ OGRDXFLayer::InsertBlockReference(const CPLString &osBlockName,
     return poFeature;
 }
 
+/************************************************************************/
+/*                       TransformBlockGeometry()                       */
+/*                                                                      */
+/*      Applies the transformation of a block insertion to a            */
+/*      geometry of the block: rotation and scaling first, then the     */
+/*      OCS to WCS transformation of the inserting feature, and the     */
+/*      offset translation last.                                        */
+/************************************************************************/
+
+static void TransformBlockGeometry(OGRGeometry *poGeom,
+                                   const OGRDXFInsertTransformer &oTransformer,
+                                   const OGRDXFFeature *poFeature)
+{
+    // With the default OCS, the OCS to WCS transformation is the identity,
+    // so the whole insertion can be done in a single pass.
+    if (poFeature->GetOCS() == DXFTriple(0.0, 0.0, 1.0))
+    {
+        OGRDXFInsertTransformer oTrans(oTransformer);
+        poGeom->transform(&oTrans);
+        return;
+    }
+
+    OGRDXFInsertTransformer oInnerTrans =
+        oTransformer.GetRotateScaleTransformer();
+    poGeom->transform(&oInnerTrans);
+
+    poFeature->ApplyOCSTransformer(poGeom);
+
+    oInnerTrans = oTransformer.GetOffsetTransformer();
+    poGeom->transform(&oInnerTrans);
+}
+
 /************************************************************************/
 /*                         InsertBlockInline()                          */
 /*                                                                      */
@@ -2845,9 +2877,37 @@ OGRDXFFeature *OGRDXFLayer::InsertBlockInline(
     if (bMergeGeometry)
         poMergedGeometry = new OGRGeometryCollection();
 
+    /* -------------------------------------------------------------------- */
+    /*      When merging, the geometries of blocks that do not produce      */
+    /*      any other feature are cached, in block coordinates, on their    */
+    /*      first insertion. Later insertions only need to transform a      */
+    /*      copy of them.                                                   */
+    /* -------------------------------------------------------------------- */
+    using CacheState = DXFBlockDefinition::MergedGeometryCacheState;
+    const bool bUseMergedGeometryCache =
+        bMergeGeometry && bInlineRecursively &&
+        poBlock->eMergedGeometryCacheState == CacheState::VALID;
+    if (bUseMergedGeometryCache)
+    {
+        for (const auto &poCachedGeom : poBlock->apoMergedGeometries)
+        {
+            OGRGeometry *poGeom = poCachedGeom->clone();
+            TransformBlockGeometry(poGeom, oTransformer, poFeature);
+            poMergedGeometry->addGeometryDirectly(poGeom);
+        }
+    }
+
+    const bool bBuildMergedGeometryCache =
+        bMergeGeometry && bInlineRecursively &&
+        poBlock->eMergedGeometryCacheState == CacheState::UNKNOWN;
+    const GUInt32 nErrorCounterBeforeCache = CPLGetErrorCounter();
+    std::vector<std::unique_ptr<OGRGeometry>> apoMergedGeometriesToCache;
+    bool bCacheable = true;
+
     OGRDXFFeatureQueue apoInnerExtraFeatures;
 
-    for (unsigned int iSubFeat = 0; iSubFeat < poBlock->apoFeatures.size();
+    for (unsigned int iSubFeat = 0;
+         !bUseMergedGeometryCache && iSubFeat < poBlock->apoFeatures.size();
          iSubFeat++)
     {
         OGRDXFFeature *poSubFeature =
@@ -2934,20 +2994,26 @@ OGRDXFFeature *OGRDXFLayer::InsertBlockInline(
         // by the recursive insert, and apply transformations
         while (true)
         {
+            // If we are merging features, and this is not text or a block
+            // reference, it will be merged into the GeometryCollection
+            const bool bMergeSubFeature =
+                bMergeGeometry &&
+                (poSubFeature->GetStyleString() == nullptr ||
+                 strstr(poSubFeature->GetStyleString(), "LABEL") == nullptr) &&
+                !poSubFeature->IsBlockReference() &&
+                poSubFeature->GetGeometryRef();
+
             OGRGeometry *poSubFeatGeom = poSubFeature->GetGeometryRef();
             if (poSubFeatGeom != nullptr)
             {
-                // Rotation and scaling first
-                OGRDXFInsertTransformer oInnerTrans =
-                    oTransformer.GetRotateScaleTransformer();
-                poSubFeatGeom->transform(&oInnerTrans);
-
-                // Then the OCS to WCS transformation
-                poFeature->ApplyOCSTransformer(poSubFeatGeom);
+                if (bBuildMergedGeometryCache && bMergeSubFeature)
+                {
+                    apoMergedGeometriesToCache.emplace_back(
+                        poSubFeatGeom->clone());
+                }
 
-                // Offset translation last
-                oInnerTrans = oTransformer.GetOffsetTransformer();
-                poSubFeatGeom->transform(&oInnerTrans);
+                TransformBlockGeometry(poSubFeatGeom, oTransformer,
+                                       poFeature);
             }
             // Transform the specially-stored data for ASM entities
             else if (poSubFeature->poASMTransform)
@@ -2969,13 +3035,7 @@ OGRDXFFeature *OGRDXFLayer::InsertBlockInline(
                                                        "ASMTransform");
             }
 
-            // If we are merging features, and this is not text or a block
-            // reference, merge it into the GeometryCollection
-            if (bMergeGeometry &&
-                (poSubFeature->GetStyleString() == nullptr ||
-                 strstr(poSubFeature->GetStyleString(), "LABEL") == nullptr) &&
-                !poSubFeature->IsBlockReference() &&
-                poSubFeature->GetGeometryRef())
+            if (bMergeSubFeature)
             {
                 poMergedGeometry->addGeometryDirectly(
                     poSubFeature->StealGeometry());
@@ -2985,6 +3045,8 @@ OGRDXFFeature *OGRDXFLayer::InsertBlockInline(
             // recursively
             else if (!bInlineRecursively || poSubFeature->osAttributeTag == "")
             {
+                bCacheable = false;
+
                 // If the subfeature is on layer 0, this is a special case: the
                 // subfeature should take on the style properties of the layer
                 // the block is being inserted onto.
@@ -3038,6 +3100,23 @@ OGRDXFFeature *OGRDXFLayer::InsertBlockInline(
         delete poFeatureToDelete;
     }
 
+    // Only trust the merged geometries if nothing went wrong, as errors
+    // (such as refused recursive insertions) may depend on the blocks
+    // being inserted at this point, and not only on this block.
+    if (bBuildMergedGeometryCache)
+    {
+        if (!bCacheable)
+        {
+            poBlock->eMergedGeometryCacheState = CacheState::UNCACHEABLE;
+        }
+        else if (CPLGetErrorCounter() == nErrorCounterBeforeCache)
+        {
+            poBlock->apoMergedGeometries =
+                std::move(apoMergedGeometriesToCache);
+            poBlock->eMergedGeometryCacheState = CacheState::VALID;
+        }
+    }
+
     poDS->PopBlockInsertion();
 
     /* -------------------------------------------------------------------- */
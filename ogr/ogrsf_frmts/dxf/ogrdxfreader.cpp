@@ -81,19 +81,19 @@ void OGRDXFReader::ResetReadPointer(unsigned int iNewOffset,
 /************************************************************************/
 /*                           LoadDiskChunk()                            */
 /*                                                                      */
-/*      Load another block (512 bytes) of input from the source         */
-/*      file.                                                           */
+/*      Load another block (nChunkSize bytes) of input from the         */
+/*      source file.                                                    */
 /************************************************************************/
 
 void OGRDXFReader::LoadDiskChunk()
 
 {
-    if (nSrcBufferBytes - iSrcBufferOffset > 511)
+    if (nSrcBufferBytes - iSrcBufferOffset >= nChunkSize)
         return;
 
     if (iSrcBufferOffset > 0)
     {
-        CPLAssert(nSrcBufferBytes <= 1024);
+        CPLAssert(nSrcBufferBytes <= 2 * nChunkSize);
         CPLAssert(iSrcBufferOffset <= nSrcBufferBytes);
 
         memmove(achSrcBuffer, achSrcBuffer + iSrcBufferOffset,
@@ -103,11 +103,11 @@ void OGRDXFReader::LoadDiskChunk()
         iSrcBufferOffset = 0;
     }
 
-    nSrcBufferBytes +=
-        static_cast<int>(VSIFReadL(achSrcBuffer + nSrcBufferBytes, 1, 512, fp));
+    nSrcBufferBytes += static_cast<unsigned int>(
+        VSIFReadL(achSrcBuffer + nSrcBufferBytes, 1, nChunkSize, fp));
     achSrcBuffer[nSrcBufferBytes] = '\0';
 
-    CPLAssert(nSrcBufferBytes <= 1024);
+    CPLAssert(nSrcBufferBytes <= 2 * nChunkSize);
     CPLAssert(iSrcBufferOffset <= nSrcBufferBytes);
 }
 
@@ -135,10 +135,8 @@ int OGRDXFReader::ReadValueRaw(char *pszValueBuf, int nValueBufSize)
     nLineNumber++;
 
     // proceed to newline.
-    while (achSrcBuffer[iSrcBufferOffset] != '\n' &&
-           achSrcBuffer[iSrcBufferOffset] != '\r' &&
-           achSrcBuffer[iSrcBufferOffset] != '\0')
-        iSrcBufferOffset++;
+    iSrcBufferOffset += static_cast<unsigned int>(
+        strcspn(achSrcBuffer + iSrcBufferOffset, "\r\n"));
 
     if (achSrcBuffer[iSrcBufferOffset] == '\0')
         return -1;
@@ -164,9 +162,7 @@ int OGRDXFReader::ReadValueRaw(char *pszValueBuf, int nValueBufSize)
     nLineNumber++;
 
     // proceed to newline.
-    while (achSrcBuffer[iEOL] != '\n' && achSrcBuffer[iEOL] != '\r' &&
-           achSrcBuffer[iEOL] != '\0')
-        iEOL++;
+    iEOL += static_cast<unsigned int>(strcspn(achSrcBuffer + iEOL, "\r\n"));
 
     bool bLongLine = false;
     while (achSrcBuffer[iEOL] == '\0' ||
@@ -198,9 +194,8 @@ int OGRDXFReader::ReadValueRaw(char *pszValueBuf, int nValueBufSize)
             return -1;
 
         // Proceed to newline again
-        while (achSrcBuffer[iEOL] != '\n' && achSrcBuffer[iEOL] != '\r' &&
-               achSrcBuffer[iEOL] != '\0')
-            iEOL++;
+        iEOL +=
+            static_cast<unsigned int>(strcspn(achSrcBuffer + iEOL, "\r\n"));
     }
 
     size_t nValueBufLen = 0;
@@ -233,8 +228,8 @@ int OGRDXFReader::ReadValueRaw(char *pszValueBuf, int nValueBufSize)
     }
     else
     {
-        strncpy(pszValueBuf + nValueBufLen, achSrcBuffer + iSrcBufferOffset,
-                iEOL - iSrcBufferOffset);
+        memcpy(pszValueBuf + nValueBufLen, achSrcBuffer + iSrcBufferOffset,
+               iEOL - iSrcBufferOffset);
         pszValueBuf[nValueBufLen + iEOL - iSrcBufferOffset] = '\0';
     }
 
@@ -37,7 +37,11 @@
 #include "ogr_p.h"
 #include "cpl_http.h"
 #include "cpl_json.h"
+#include "cpl_error_internal.h"
 
+#include <atomic>
+
+#include <list>
 #include <map>
 #include <memory>
 #include <set>
@@ -51,6 +55,25 @@ typedef enum
 } ESGeometryTypeMapping;
 
 class OGRElasticDataSource;
+class CPLJobQueue;
+
+/************************************************************************/
+/*                           OGRESBulkRequest                           */
+/************************************************************************/
+
+struct OGRESBulkRequest
+{
+    OGRElasticDataSource *poDS = nullptr;
+    CPLString osURL{};
+    CPLString osContent{};
+
+    // Set by the worker sending the request
+    bool bSuccess = false;
+    bool bThrottled = false;
+    double dfElapsed = 0;
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+    std::atomic<bool> bDone{false};
+};
 
 class OGRESSortDesc
 {
@@ -93,6 +116,12 @@ class OGRElasticLayer final : public OGRLayer
 
     CPLString m_osBulkContent{};
     int m_nBulkUpload{};
+    //! Value of BULK_SIZE, around which m_nBulkUpload is adjusted
+    int m_nBulkUploadRef = 0;
+    int m_nBulkMaxInFlight = 1;
+    double m_dfBulkTargetLatency = 0;
+    std::list<std::unique_ptr<OGRESBulkRequest>> m_apoBulkRequests{};
+    std::unique_ptr<CPLJobQueue> m_poBulkJobQueue{};
 
     CPLString m_osFID{};
 
@@ -107,6 +136,8 @@ class OGRElasticLayer final : public OGRLayer
     CPLString m_osPrecision{};
 
     CPLString m_osScrollID{};
+    bool m_bSlicedScroll = false;
+    std::vector<CPLString> m_aosSliceScrollIDs{};
     GIntBig m_iCurID = 0;
     GIntBig m_nNextFID = -1;  // for creation
     int m_iCurFeatureInPage = 0;
@@ -140,10 +171,18 @@ class OGRElasticLayer final : public OGRLayer
     void CopyMembersTo(OGRElasticLayer *poNew);
 
     bool PushIndex();
+    bool SubmitBulkRequest();
+    bool ProcessBulkRequests(int nMaxRemaining);
+    void AdjustBulkSize(double dfElapsed, bool bThrottled);
     CPLString BuildMap();
 
     OGRErr WriteMapIfNecessary();
     OGRFeature *GetNextRawFeature();
+    size_t CacheFeaturesFromHits(json_object *poResponse);
+    bool CanUseSlicedScroll(const CPLString &osPostData) const;
+    bool FetchSlicedScrollPage(const CPLString &osFirstRequest,
+                               const CPLString &osFirstPostData);
+    void ClearScroll(const CPLString &osScrollID);
     void BuildFeature(OGRFeature *poFeature, json_object *poSource,
                       CPLString osPath);
     void CreateFieldFromSchema(const char *pszName, const char *pszPrefix,
@@ -349,6 +388,7 @@ class OGRElasticDataSource final : public GDALDataset
     char *m_pszWriteMap;
     char *m_pszMapping;
     int m_nBatchSize;
+    int m_nScrollSlices = 1;
     int m_nFeatureCountToEstablishFeatureDefn;
     bool m_bJSonField;
     bool m_bFlattenNestedAttributes;
@@ -840,6 +840,8 @@ bool OGRElasticDataSource::Open(GDALOpenInfo *poOpenInfo)
         CSLFetchNameValueDef(poOpenInfo->papszOpenOptions, "USERPWD", "");
     m_nBatchSize = atoi(CSLFetchNameValueDef(poOpenInfo->papszOpenOptions,
                                              "BATCH_SIZE", "100"));
+    m_nScrollSlices = atoi(CSLFetchNameValueDef(poOpenInfo->papszOpenOptions,
+                                                "SCROLL_SLICES", "1"));
     m_nFeatureCountToEstablishFeatureDefn = atoi(
         CSLFetchNameValueDef(poOpenInfo->papszOpenOptions,
                              "FEATURE_COUNT_TO_ESTABLISH_FEATURE_DEFN", "100"));
@@ -31,6 +31,8 @@
 #include "cpl_conv.h"
 #include "cpl_minixml.h"
 #include "cpl_http.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_p.h"
 #include "ogr_swq.h"
@@ -39,7 +41,9 @@
 #include "../geojson/ogrgeojsonutils.h"
 #include "ogr_geo_utils.h"
 
+#include <algorithm>
 #include <cstdlib>
+#include <limits>
 #include <set>
 
 /************************************************************************/
@@ -121,6 +125,11 @@ OGRElasticLayer::OGRElasticLayer(const char *pszLayerName,
         m_nBulkUpload =
             atoi(CSLFetchNameValueDef(papszOptions, "BULK_SIZE", "1000000"));
     }
+    m_nBulkUploadRef = m_nBulkUpload;
+    m_nBulkMaxInFlight = std::max(
+        1, atoi(CSLFetchNameValueDef(papszOptions, "BULK_MAX_IN_FLIGHT", "1")));
+    m_dfBulkTargetLatency =
+        CPLAtof(CSLFetchNameValueDef(papszOptions, "BULK_TARGET_LATENCY", "0"));
 
     const char *pszStoredFields =
         CSLFetchNameValue(papszOptions, "STORED_FIELDS");
@@ -253,6 +262,9 @@ void OGRElasticLayer::CopyMembersTo(OGRElasticLayer *poNew)
     poNew->m_bFeatureDefnFinalized = true;
     poNew->m_osBulkContent = m_osBulkContent;
     poNew->m_nBulkUpload = m_nBulkUpload;
+    poNew->m_nBulkUploadRef = m_nBulkUploadRef;
+    poNew->m_nBulkMaxInFlight = m_nBulkMaxInFlight;
+    poNew->m_dfBulkTargetLatency = m_dfBulkTargetLatency;
     poNew->m_osFID = m_osFID;
     poNew->m_aaosFieldPaths = m_aaosFieldPaths;
     poNew->m_aosMapToFieldIndex = m_aosMapToFieldIndex;
@@ -1069,6 +1081,22 @@ const char *OGRElasticLayer::GetFIDColumn()
     return m_osFID.c_str();
 }
 
+/************************************************************************/
+/*                             ClearScroll()                            */
+/************************************************************************/
+
+void OGRElasticLayer::ClearScroll(const CPLString &osScrollID)
+{
+    char **papszOptions = CSLAddNameValue(nullptr, "CUSTOMREQUEST", "DELETE");
+    CPLHTTPResult *psResult = m_poDS->HTTPFetch(
+        (m_poDS->GetURL() + CPLString("/_search/scroll?scroll_id=") +
+         osScrollID)
+            .c_str(),
+        papszOptions);
+    CSLDestroy(papszOptions);
+    CPLHTTPDestroyResult(psResult);
+}
+
 /************************************************************************/
 /*                            ResetReading()                            */
 /************************************************************************/
@@ -1077,18 +1105,16 @@ void OGRElasticLayer::ResetReading()
 {
     if (!m_osScrollID.empty())
     {
-        char **papszOptions =
-            CSLAddNameValue(nullptr, "CUSTOMREQUEST", "DELETE");
-        CPLHTTPResult *psResult = m_poDS->HTTPFetch(
-            (m_poDS->GetURL() + CPLString("/_search/scroll?scroll_id=") +
-             m_osScrollID)
-                .c_str(),
-            papszOptions);
-        CSLDestroy(papszOptions);
-        CPLHTTPDestroyResult(psResult);
-
+        ClearScroll(m_osScrollID);
         m_osScrollID = "";
     }
+    for (const auto &osScrollID : m_aosSliceScrollIDs)
+    {
+        if (!osScrollID.empty())
+            ClearScroll(osScrollID);
+    }
+    m_aosSliceScrollIDs.clear();
+    m_bSlicedScroll = false;
     for (int i = 0; i < (int)m_apoCachedFeatures.size(); i++)
         delete m_apoCachedFeatures[i];
     m_apoCachedFeatures.resize(0);
@@ -1201,8 +1227,6 @@ CPLString OGRElasticLayer::BuildQuery(bool bCountOnly)
 
 OGRFeature *OGRElasticLayer::GetNextRawFeature()
 {
-    json_object *poResponse = nullptr;
-
     if (m_dfEndTimeStamp > 0 && GetTimestamp() >= m_dfEndTimeStamp)
     {
         CPLDebug("ES", "Terminating request due to timeout");
@@ -1269,6 +1293,24 @@ OGRFeature *OGRElasticLayer::GetNextRawFeature()
                 CPLSPrintf("/_search?scroll=1m&size=%d", m_poDS->m_nBatchSize);
             osPostData = m_osJSONFilter;
         }
+
+        m_bSlicedScroll = CanUseSlicedScroll(osPostData);
+        if (m_bSlicedScroll)
+        {
+            if (!FetchSlicedScrollPage(osRequest, osPostData))
+            {
+                m_bEOF = true;
+                return nullptr;
+            }
+        }
+    }
+    else if (m_bSlicedScroll)
+    {
+        if (!FetchSlicedScrollPage(CPLString(), CPLString()))
+        {
+            m_bEOF = true;
+            return nullptr;
+        }
     }
     else
     {
@@ -1281,46 +1323,66 @@ OGRFeature *OGRElasticLayer::GetNextRawFeature()
                                m_poDS->GetURL(), m_osScrollID.c_str());
     }
 
-    if (m_bAddPretty)
-        osRequest += "&pretty";
-    poResponse = m_poDS->RunRequest(osRequest, osPostData);
-    if (poResponse == nullptr)
+    if (!m_bSlicedScroll)
     {
-        m_bEOF = true;
-        return nullptr;
+        if (m_bAddPretty)
+            osRequest += "&pretty";
+        json_object *poResponse = m_poDS->RunRequest(osRequest, osPostData);
+        if (poResponse == nullptr)
+        {
+            m_bEOF = true;
+            return nullptr;
+        }
+        m_osScrollID.clear();
+        json_object *poScrollID =
+            CPL_json_object_object_get(poResponse, "_scroll_id");
+        if (poScrollID)
+        {
+            const char *pszScrollID = json_object_get_string(poScrollID);
+            if (pszScrollID)
+                m_osScrollID = pszScrollID;
+        }
+
+        const size_t nHits = CacheFeaturesFromHits(poResponse);
+        json_object_put(poResponse);
+        if (nHits == 0)
+        {
+            m_osScrollID = "";
+            m_bEOF = true;
+            return nullptr;
+        }
     }
-    m_osScrollID.clear();
-    json_object *poScrollID =
-        CPL_json_object_object_get(poResponse, "_scroll_id");
-    if (poScrollID)
+
+    if (!m_apoCachedFeatures.empty())
     {
-        const char *pszScrollID = json_object_get_string(poScrollID);
-        if (pszScrollID)
-            m_osScrollID = pszScrollID;
+        OGRFeature *poRet = m_apoCachedFeatures[0];
+        m_apoCachedFeatures[0] = nullptr;
+        m_iCurFeatureInPage++;
+        m_nReadFeaturesSinceResetReading++;
+        return poRet;
     }
+    return nullptr;
+}
+
+/************************************************************************/
+/*                       CacheFeaturesFromHits()                        */
+/************************************************************************/
 
+// Appends the features of a search response to m_apoCachedFeatures, and
+// returns the number of hits of the response.
+size_t OGRElasticLayer::CacheFeaturesFromHits(json_object *poResponse)
+{
     json_object *poHits = CPL_json_object_object_get(poResponse, "hits");
     if (poHits == nullptr || json_object_get_type(poHits) != json_type_object)
     {
-        m_bEOF = true;
-        json_object_put(poResponse);
-        return nullptr;
+        return 0;
     }
     poHits = CPL_json_object_object_get(poHits, "hits");
     if (poHits == nullptr || json_object_get_type(poHits) != json_type_array)
     {
-        m_bEOF = true;
-        json_object_put(poResponse);
-        return nullptr;
+        return 0;
     }
     const auto nHits = json_object_array_length(poHits);
-    if (nHits == 0)
-    {
-        m_osScrollID = "";
-        m_bEOF = true;
-        json_object_put(poResponse);
-        return nullptr;
-    }
     for (auto i = decltype(nHits){0}; i < nHits; i++)
     {
         json_object *poHit = json_object_array_get_idx(poHits, i);
@@ -1374,16 +1436,151 @@ OGRFeature *OGRElasticLayer::GetNextRawFeature()
         m_apoCachedFeatures.push_back(poFeature);
     }
 
-    json_object_put(poResponse);
-    if (!m_apoCachedFeatures.empty())
+
+    return nHits;
+}
+
+/************************************************************************/
+/*                        CanUseSlicedScroll()                          */
+/************************************************************************/
+
+// Sliced scroll is only used for plain layer reads, since sorting or
+// custom ES searches need a single cursor.
+bool OGRElasticLayer::CanUseSlicedScroll(const CPLString &osPostData) const
+{
+    if (m_poDS->m_nScrollSlices <= 1 || m_poDS->m_nMajorVersion < 5 ||
+        !m_osESSearch.empty() || !m_aoSortColumns.empty())
     {
-        OGRFeature *poRet = m_apoCachedFeatures[0];
-        m_apoCachedFeatures[0] = nullptr;
-        m_iCurFeatureInPage++;
-        m_nReadFeaturesSinceResetReading++;
-        return poRet;
+        return false;
+    }
+    if (osPostData.empty())
+        return true;
+    json_object *poQuery = nullptr;
+    if (!OGRJSonParse(osPostData, &poQuery, false))
+        return false;
+    const bool bRet = json_object_get_type(poQuery) == json_type_object &&
+                      CPL_json_object_object_get(poQuery, "slice") == nullptr;
+    json_object_put(poQuery);
+    return bRet;
+}
+
+/************************************************************************/
+/*                        FetchSlicedScrollPage()                       */
+/************************************************************************/
+
+namespace
+{
+struct OGRESSliceRequest
+{
+    OGRElasticDataSource *poDS = nullptr;
+    CPLString osURL{};
+    CPLString osPostData{};
+    json_object *poResponse = nullptr;
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+};
+}  // namespace
+
+static void RunSliceRequest(void *pData)
+{
+    OGRESSliceRequest *psRequest = static_cast<OGRESSliceRequest *>(pData);
+    CPLInstallErrorHandlerAccumulator(psRequest->aoErrors);
+    psRequest->poResponse =
+        psRequest->poDS->RunRequest(psRequest->osURL, psRequest->osPostData);
+    CPLUninstallErrorHandlerAccumulator();
+}
+
+// Fetches one page of each slice that is not exhausted yet, in parallel.
+// osFirstRequest and osFirstPostData are set for the initial request, and
+// empty for the following ones that use the scroll id of each slice.
+// Returns false when all slices are exhausted.
+bool OGRElasticLayer::FetchSlicedScrollPage(const CPLString &osFirstRequest,
+                                            const CPLString &osFirstPostData)
+{
+    const int nSlices = m_poDS->m_nScrollSlices;
+    bool bFirst = !osFirstRequest.empty();
+    if (bFirst)
+        m_aosSliceScrollIDs.assign(nSlices, CPLString());
+
+    while (true)
+    {
+        std::vector<std::unique_ptr<OGRESSliceRequest>> apoRequests;
+        std::vector<int> anSliceIdx;
+        for (int i = 0; i < nSlices; ++i)
+        {
+            if (!bFirst && m_aosSliceScrollIDs[i].empty())
+                continue;
+            auto poRequest = std::make_unique<OGRESSliceRequest>();
+            poRequest->poDS = m_poDS;
+            if (bFirst)
+            {
+                json_object *poQuery = nullptr;
+                if (osFirstPostData.empty() ||
+                    !OGRJSonParse(osFirstPostData, &poQuery, false))
+                {
+                    poQuery = json_object_new_object();
+                }
+                json_object *poSlice = json_object_new_object();
+                json_object_object_add(poSlice, "id", json_object_new_int(i));
+                json_object_object_add(poSlice, "max",
+                                       json_object_new_int(nSlices));
+                json_object_object_add(poQuery, "slice", poSlice);
+                poRequest->osURL = osFirstRequest;
+                poRequest->osPostData = json_object_to_json_string(poQuery);
+                json_object_put(poQuery);
+            }
+            else
+            {
+                poRequest->osURL =
+                    CPLSPrintf("%s/_search/scroll?scroll=1m&scroll_id=%s",
+                               m_poDS->GetURL(),
+                               m_aosSliceScrollIDs[i].c_str());
+            }
+            if (m_bAddPretty)
+                poRequest->osURL += "&pretty";
+            apoRequests.push_back(std::move(poRequest));
+            anSliceIdx.push_back(i);
+        }
+        bFirst = false;
+        if (apoRequests.empty())
+            return false;
+
+        CPLWorkerThreadPool *poThreadPool =
+            apoRequests.size() > 1
+                ? GDALGetGlobalThreadPool(static_cast<int>(apoRequests.size()))
+                : nullptr;
+        auto poQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+        for (auto &poRequest : apoRequests)
+        {
+            if (!poQueue ||
+                !poQueue->SubmitJob(RunSliceRequest, poRequest.get()))
+            {
+                RunSliceRequest(poRequest.get());
+            }
+        }
+        if (poQueue)
+            poQueue->WaitCompletion();
+
+        for (size_t i = 0; i < apoRequests.size(); ++i)
+        {
+            auto &poRequest = apoRequests[i];
+            CPLString &osScrollID = m_aosSliceScrollIDs[anSliceIdx[i]];
+            osScrollID.clear();
+            for (const auto &oError : poRequest->aoErrors)
+                CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+            if (poRequest->poResponse == nullptr)
+                continue;
+            json_object *poScrollID =
+                CPL_json_object_object_get(poRequest->poResponse, "_scroll_id");
+            const char *pszScrollID =
+                poScrollID ? json_object_get_string(poScrollID) : nullptr;
+            if (CacheFeaturesFromHits(poRequest->poResponse) > 0 && pszScrollID)
+                osScrollID = pszScrollID;
+            json_object_put(poRequest->poResponse);
+        }
+
+        if (!m_apoCachedFeatures.empty())
+            return true;
     }
-    return nullptr;
 }
 
 /************************************************************************/
@@ -2706,7 +2903,7 @@ OGRErr OGRElasticLayer::ICreateFeature(OGRFeature *poFeature)
         // Only push the data if we are over our bulk upload limit
         if ((int)m_osBulkContent.length() > m_nBulkUpload)
         {
-            if (!PushIndex())
+            if (!SubmitBulkRequest())
             {
                 return OGRERR_FAILURE;
             }
@@ -2845,7 +3042,7 @@ OGRErr OGRElasticLayer::IUpsertFeature(OGRFeature *poFeature)
         // Only push the data if we are over our bulk upload limit
         if (m_osBulkContent.length() > static_cast<size_t>(m_nBulkUpload))
         {
-            if (!PushIndex())
+            if (!SubmitBulkRequest())
             {
                 return OGRERR_FAILURE;
             }
@@ -2881,19 +3078,269 @@ OGRErr OGRElasticLayer::IUpsertFeature(OGRFeature *poFeature)
 /************************************************************************/
 
 bool OGRElasticLayer::PushIndex()
+{
+    bool bRet = SubmitBulkRequest();
+    if (!ProcessBulkRequests(0))
+        bRet = false;
+    return bRet;
+}
+
+/************************************************************************/
+/*                          RunBulkRequest()                            */
+/************************************************************************/
+
+// Sends a _bulk request. Items rejected because of back-pressure from the
+// server (HTTP 429, globally or per item) are sent again after a delay.
+static bool RunBulkRequestInternal(OGRESBulkRequest *psRequest)
+{
+    const int nMaxRetry = atoi(CPLGetConfigOption("GDAL_HTTP_MAX_RETRY", "5"));
+    double dfRetryDelay =
+        CPLAtof(CPLGetConfigOption("GDAL_HTTP_RETRY_DELAY", "1"));
+
+    CPLString osContent(psRequest->osContent);
+    for (int nRetry = 0;; ++nRetry)
+    {
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("POSTFIELDS", osContent.c_str());
+        aosOptions.SetNameValue(
+            "HEADERS", "Content-Type: application/json; charset=UTF-8");
+
+        const double dfStart = GetTimestamp();
+        CPLHTTPResult *psResult =
+            psRequest->poDS->HTTPFetch(psRequest->osURL, aosOptions.List());
+        if (nRetry == 0)
+            psRequest->dfElapsed = GetTimestamp() - dfStart;
+        if (psResult == nullptr)
+            return false;
+
+        const char *pszData =
+            reinterpret_cast<const char *>(psResult->pabyData);
+        CPLString osRetryContent;
+        bool bError = false;
+        if (psResult->pszErrBuf != nullptr)
+        {
+            if (strstr(psResult->pszErrBuf, "429"))
+                osRetryContent = osContent;
+            else
+                bError = true;
+        }
+        else if (pszData && STARTS_WITH(pszData, "{\"error\":"))
+        {
+            bError = true;
+        }
+        else if (pszData && strstr(pszData, "\"errors\":true,") != nullptr)
+        {
+            // Collect the items rejected with a 429 status, and fail if
+            // there is any other error.
+            std::vector<CPLString> aosItems;
+            for (size_t nPos = 0; nPos < osContent.size();)
+            {
+                size_t nEnd = osContent.find("\n\n", nPos);
+                if (nEnd == std::string::npos)
+                    nEnd = osContent.size();
+                aosItems.push_back(osContent.substr(nPos, nEnd - nPos));
+                nPos = nEnd + 2;
+            }
+            json_object *poRes = nullptr;
+            json_object *poItems = nullptr;
+            if (OGRJSonParse(pszData, &poRes, false))
+                poItems = CPL_json_object_object_get(poRes, "items");
+            if (poItems == nullptr ||
+                json_object_get_type(poItems) != json_type_array ||
+                json_object_array_length(poItems) !=
+                    static_cast<size_t>(aosItems.size()))
+            {
+                bError = true;
+            }
+            else
+            {
+                const auto nItems = json_object_array_length(poItems);
+                for (auto i = decltype(nItems){0}; i < nItems && !bError; i++)
+                {
+                    json_object *poItem = json_object_array_get_idx(poItems, i);
+                    json_object *poStatus = nullptr;
+                    if (poItem &&
+                        json_object_get_type(poItem) == json_type_object)
+                    {
+                        json_object_iter it;
+                        it.key = nullptr;
+                        it.val = nullptr;
+                        it.entry = nullptr;
+                        json_object_object_foreachC(poItem, it)
+                        {
+                            if (it.val && json_object_get_type(it.val) ==
+                                              json_type_object)
+                            {
+                                poStatus = CPL_json_object_object_get(
+                                    it.val, "status");
+                            }
+                            break;
+                        }
+                    }
+                    const int nStatus =
+                        poStatus ? json_object_get_int(poStatus) : 0;
+                    if (nStatus == 429)
+                    {
+                        osRetryContent += aosItems[i];
+                        osRetryContent += "\n\n";
+                    }
+                    else if (nStatus < 200 || nStatus >= 300)
+                    {
+                        bError = true;
+                    }
+                }
+            }
+            json_object_put(poRes);
+        }
+
+        if (!bError && !osRetryContent.empty() && nRetry >= nMaxRetry)
+        {
+            bError = true;
+        }
+        if (bError)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "%s",
+                     pszData ? pszData : psResult->pszErrBuf);
+        }
+        CPLHTTPDestroyResult(psResult);
+        if (bError)
+            return false;
+        if (osRetryContent.empty())
+            return true;
+
+        psRequest->bThrottled = true;
+        CPLDebug("ES", "Bulk request throttled by server. Retrying in %.1f s",
+                 dfRetryDelay);
+        CPLSleep(dfRetryDelay);
+        dfRetryDelay *= 2;
+        osContent = std::move(osRetryContent);
+    }
+}
+
+static void RunBulkRequest(void *pData)
+{
+    OGRESBulkRequest *psRequest = static_cast<OGRESBulkRequest *>(pData);
+    CPLInstallErrorHandlerAccumulator(psRequest->aoErrors);
+    psRequest->bSuccess = RunBulkRequestInternal(psRequest);
+    CPLUninstallErrorHandlerAccumulator();
+    psRequest->bDone = true;
+}
+
+/************************************************************************/
+/*                         SubmitBulkRequest()                          */
+/************************************************************************/
+
+// Sends the pending bulk content. When several requests may be in flight,
+// this only waits for a slot to be available, and errors of the request
+// are reported by a later call to ProcessBulkRequests().
+bool OGRElasticLayer::SubmitBulkRequest()
 {
     if (m_osBulkContent.empty())
     {
         return true;
     }
 
-    const bool bRet = m_poDS->UploadFile(
-        CPLSPrintf("%s/_bulk", m_poDS->GetURL()), m_osBulkContent);
+    auto poRequest = std::make_unique<OGRESBulkRequest>();
+    poRequest->poDS = m_poDS;
+    poRequest->osURL = CPLSPrintf("%s/_bulk", m_poDS->GetURL());
+    std::swap(poRequest->osContent, m_osBulkContent);
     m_osBulkContent.clear();
+    OGRESBulkRequest *psRequest = poRequest.get();
+
+    if (m_nBulkMaxInFlight > 1 && !m_poBulkJobQueue)
+    {
+        CPLWorkerThreadPool *poThreadPool =
+            GDALGetGlobalThreadPool(m_nBulkMaxInFlight);
+        if (poThreadPool)
+            m_poBulkJobQueue = poThreadPool->CreateJobQueue();
+    }
+
+    bool bRet = true;
+    if (m_poBulkJobQueue)
+    {
+        bRet = ProcessBulkRequests(m_nBulkMaxInFlight - 1);
+        m_apoBulkRequests.push_back(std::move(poRequest));
+        if (m_poBulkJobQueue->SubmitJob(RunBulkRequest, psRequest))
+            return bRet;
+    }
+    else
+    {
+        m_apoBulkRequests.push_back(std::move(poRequest));
+    }
 
+    RunBulkRequest(psRequest);
+    if (!ProcessBulkRequests(m_nBulkMaxInFlight - 1))
+        bRet = false;
     return bRet;
 }
 
+/************************************************************************/
+/*                        ProcessBulkRequests()                         */
+/************************************************************************/
+
+// Waits until at most nMaxRemaining bulk requests are in flight, and
+// reports the outcome of the completed ones.
+bool OGRElasticLayer::ProcessBulkRequests(int nMaxRemaining)
+{
+    if (m_poBulkJobQueue)
+        m_poBulkJobQueue->WaitCompletion(nMaxRemaining);
+
+    bool bRet = true;
+    for (auto oIter = m_apoBulkRequests.begin();
+         oIter != m_apoBulkRequests.end();)
+    {
+        const auto &poRequest = *oIter;
+        if (!poRequest->bDone)
+        {
+            ++oIter;
+            continue;
+        }
+        for (const auto &oError : poRequest->aoErrors)
+            CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+        if (!poRequest->bSuccess)
+            bRet = false;
+        AdjustBulkSize(poRequest->dfElapsed, poRequest->bThrottled);
+        oIter = m_apoBulkRequests.erase(oIter);
+    }
+    return bRet;
+}
+
+/************************************************************************/
+/*                          AdjustBulkSize()                            */
+/************************************************************************/
+
+// Shrinks the size of bulk requests when the server throttles them or
+// when they take longer than BULK_TARGET_LATENCY, and grows it back
+// otherwise. Without a target latency, the size does not exceed BULK_SIZE.
+void OGRElasticLayer::AdjustBulkSize(double dfElapsed, bool bThrottled)
+{
+    if (m_nBulkUploadRef <= 0)
+        return;
+
+    const double dfMinSize = std::max(1, m_nBulkUploadRef / 16);
+    const double dfMaxSize =
+        m_dfBulkTargetLatency > 0
+            ? std::min(4.0 * m_nBulkUploadRef,
+                       static_cast<double>(std::numeric_limits<int>::max()))
+            : m_nBulkUploadRef;
+    double dfNewSize = m_nBulkUpload;
+    if (bThrottled)
+        dfNewSize /= 2;
+    else if (m_dfBulkTargetLatency > 0 && dfElapsed > m_dfBulkTargetLatency)
+        dfNewSize *= 0.75;
+    else if (m_dfBulkTargetLatency <= 0 ||
+             dfElapsed < m_dfBulkTargetLatency / 2)
+        dfNewSize = std::max(dfNewSize * 1.25, dfNewSize + 1);
+    const int nNewSize =
+        static_cast<int>(std::max(dfMinSize, std::min(dfMaxSize, dfNewSize)));
+    if (nNewSize != m_nBulkUpload)
+    {
+        CPLDebug("ES", "Bulk request size changed from %d to %d bytes",
+                 m_nBulkUpload, nNewSize);
+        m_nBulkUpload = nNewSize;
+    }
+}
+
 /************************************************************************/
 /*                            CreateField()                             */
 /************************************************************************/
@@ -39,6 +39,7 @@
 
 #include <deque>
 #include <limits>
+#include <map>
 
 class OGRFlatGeobufDataset;
 
@@ -55,6 +56,7 @@ static constexpr uint32_t feature_max_buffer_size =
 struct FeatureItem : FlatGeobuf::Item
 {
     uint32_t size;
+    uint32_t hilbertCode;  // computed just before sorting
     uint64_t offset;
 };
 
@@ -99,6 +101,11 @@ class OGRFlatGeobufLayer final : public OGRLayer,
     std::vector<FlatGeobuf::SearchResultItem>
         m_foundItems;  // found node items in spatial index search
     bool m_queriedSpatialIndex = false;
+    // merged byte ranges of the found features, advised to m_poFp by batches
+    std::vector<vsi_l_offset> m_anFeatureRangeOffsets{};
+    std::vector<size_t> m_anFeatureRangeSizes{};
+    size_t m_nNextFeatureRangeToAdvise = 0;
+    uint64_t m_nAdvisedFeatureRangesEnd = 0;
     bool m_ignoreSpatialFilter = false;
     bool m_ignoreAttributeFilter = false;
 
@@ -133,6 +140,9 @@ class OGRFlatGeobufLayer final : public OGRLayer,
     writeColumns(flatbuffers::FlatBufferBuilder &fbb);
     void readColumns();
     OGRErr readIndex();
+    void computeFeatureRanges(
+        const std::map<uint64_t, uint64_t> &oMapLeafIdxToOffset);
+    void adviseReadFeatureRanges();
     OGRErr readFeatureOffset(uint64_t index, uint64_t &featureOffset);
 
     // serialize
@@ -32,6 +32,8 @@
 #include "cpl_json.h"
 #include "cpl_http.h"
 #include "cpl_time.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "ogr_p.h"
 #include "ograrrowarrayhelper.h"
 #include "ogr_recordbatch.h"
@@ -547,6 +549,94 @@ static bool SupportsSeekWhileWriting(const std::string &osFilename)
            STARTS_WITH(osFilename.c_str(), "/vsimem/");
 }
 
+/************************************************************************/
+/*                      HilbertSortFeatureItems()                       */
+/************************************************************************/
+
+// Equivalent to hilbertSort(), except that the Hilbert code of each item is
+// computed once, by worker threads for large layers, instead of twice per
+// comparison.
+static void HilbertSortFeatureItems(std::deque<FeatureItem> &items,
+                                    const NodeItem &extent)
+{
+    const double minX = extent.minX;
+    const double minY = extent.minY;
+    const double width = extent.width();
+    const double height = extent.height();
+    const auto ComputeCodes = [&items, minX, minY, width,
+                               height](size_t nStart, size_t nEnd)
+    {
+        for (size_t i = nStart; i < nEnd; ++i)
+        {
+            auto &item = items[i];
+            item.hilbertCode = hilbert(item.nodeItem, HILBERT_MAX, minX, minY,
+                                       width, height);
+        }
+    };
+
+    const size_t nCount = items.size();
+    // Can be lowered for testing purposes
+    const size_t MIN_ITEMS_PER_THREAD = static_cast<size_t>(
+        std::max(1, atoi(CPLGetConfigOption(
+                        "OGR_FLATGEOBUF_MIN_ITEMS_PER_THREAD", "100000"))));
+    CPLWorkerThreadPool *poPool = nullptr;
+    if (nCount >= 2 * MIN_ITEMS_PER_THREAD)
+    {
+        const char *pszNumThreads =
+            CPLGetConfigOption("OGR_FLATGEOBUF_NUM_THREADS", nullptr);
+        int nThreadsMax;
+        if (pszNumThreads == nullptr)
+            nThreadsMax = std::min(4, CPLGetNumCPUs());
+        else if (EQUAL(pszNumThreads, "ALL_CPUS"))
+            nThreadsMax = CPLGetNumCPUs();
+        else
+            nThreadsMax = std::max(1, atoi(pszNumThreads));
+        const int nThreads = static_cast<int>(
+            std::min(static_cast<size_t>(std::min(nThreadsMax, 128)),
+                     nCount / MIN_ITEMS_PER_THREAD));
+        if (nThreads > 1)
+            poPool = GDALGetGlobalThreadPool(nThreads);
+    }
+
+    if (poPool == nullptr)
+    {
+        ComputeCodes(0, nCount);
+    }
+    else
+    {
+        struct JobData
+        {
+            const decltype(ComputeCodes) *pfnChunk;
+            size_t nStart;
+            size_t nEnd;
+        };
+
+        const size_t nChunkSize =
+            (nCount + poPool->GetThreadCount() - 1) / poPool->GetThreadCount();
+        std::vector<JobData> asJobs;
+        for (size_t nStart = 0; nStart < nCount; nStart += nChunkSize)
+            asJobs.push_back({&ComputeCodes, nStart,
+                              std::min(nCount, nStart + nChunkSize)});
+
+        auto poQueue = poPool->CreateJobQueue();
+        for (auto &sJob : asJobs)
+        {
+            poQueue->SubmitJob(
+                [](void *pData)
+                {
+                    const auto psJob = static_cast<const JobData *>(pData);
+                    (*psJob->pfnChunk)(psJob->nStart, psJob->nEnd);
+                },
+                &sJob);
+        }
+        poQueue->WaitCompletion();
+    }
+
+    std::sort(items.begin(), items.end(),
+              [](const FeatureItem &a, const FeatureItem &b)
+              { return a.hilbertCode > b.hilbertCode; });
+}
+
 bool OGRFlatGeobufLayer::CreateFinalFile()
 {
     // no spatial index requested, we are (almost) done
@@ -612,7 +702,7 @@ bool OGRFlatGeobufLayer::CreateFinalFile()
     writeHeader(m_poFp, m_featuresCount, &extentVector);
 
     CPLDebugOnly("FlatGeobuf", "Sorting items for Packed R-tree");
-    hilbertSort(m_featureItems);
+    HilbertSortFeatureItems(m_featureItems, extent);
     CPLDebugOnly("FlatGeobuf", "Calc new feature offsets");
     uint64_t featureOffset = 0;
     for (auto &item : m_featureItems)
@@ -941,13 +1031,34 @@ OGRErr OGRFlatGeobufLayer::readIndex()
                          env.MinX, env.MinY, env.MaxX, env.MaxY);
             const auto treeOffset =
                 sizeof(magicbytes) + sizeof(uoffset_t) + headerSize;
+            const uint64_t leafNodesOffset =
+                PackedRTree::generateLevelBounds(featuresCount, indexNodeSize)
+                    .front()
+                    .first *
+                sizeof(NodeItem);
+            // Offsets of the features of the leaf nodes read, to know where
+            // each found feature ends.
+            std::map<uint64_t, uint64_t> oMapLeafIdxToOffset;
             const auto readNode =
-                [this, treeOffset](uint8_t *buf, size_t i, size_t s)
+                [this, treeOffset, leafNodesOffset,
+                 &oMapLeafIdxToOffset](uint8_t *buf, size_t i, size_t s)
             {
                 if (VSIFSeekL(m_poFp, treeOffset + i, SEEK_SET) == -1)
                     throw std::runtime_error("I/O seek failure");
                 if (VSIFReadL(buf, 1, s, m_poFp) != s)
                     throw std::runtime_error("I/O read file");
+                if (i < leafNodesOffset)
+                    return;
+                for (size_t j = 0; j + sizeof(NodeItem) <= s;
+                     j += sizeof(NodeItem))
+                {
+                    uint64_t offset;
+                    memcpy(&offset, buf + j + offsetof(NodeItem, offset),
+                           sizeof(offset));
+                    CPL_LSBPTR64(&offset);
+                    oMapLeafIdxToOffset[(i + j - leafNodesOffset) /
+                                        sizeof(NodeItem)] = offset;
+                }
             };
             m_foundItems = PackedRTree::streamSearch(
                 featuresCount, indexNodeSize, n, readNode);
@@ -955,6 +1066,7 @@ OGRErr OGRFlatGeobufLayer::readIndex()
             CPLDebugOnly("FlatGeobuf",
                          "%lu features found in spatial index search",
                          static_cast<long unsigned int>(m_featuresCount));
+            computeFeatureRanges(oMapLeafIdxToOffset);
 
             m_queriedSpatialIndex = true;
         }
@@ -969,6 +1081,104 @@ OGRErr OGRFlatGeobufLayer::readIndex()
     return OGRERR_NONE;
 }
 
+/************************************************************************/
+/*                       computeFeatureRanges()                         */
+/************************************************************************/
+
+// Merge the byte ranges of the features found by the spatial index search
+// into a few large ranges, so that they can be fetched with a few requests
+// on network file systems, instead of one request per feature.
+void OGRFlatGeobufLayer::computeFeatureRanges(
+    const std::map<uint64_t, uint64_t> &oMapLeafIdxToOffset)
+{
+    m_anFeatureRangeOffsets.clear();
+    m_anFeatureRangeSizes.clear();
+    m_nNextFeatureRangeToAdvise = 0;
+    m_nAdvisedFeatureRangesEnd = 0;
+
+    // Reading a gap of that size is cheaper than issuing a new request
+    constexpr uint64_t MAX_GAP = 64 * 1024;
+    // Size assumed for a found feature whose next one is not in the index
+    // nodes read during the search
+    constexpr uint64_t DEFAULT_FEATURE_SIZE = 4096;
+    constexpr uint64_t MAX_RANGE_SIZE = 10 * 1024 * 1024;
+
+    for (const auto &item : m_foundItems)
+    {
+        const uint64_t nStart = m_offsetFeatures + item.offset;
+        const auto oIter = oMapLeafIdxToOffset.find(item.index + 1);
+        const uint64_t nEnd =
+            oIter != oMapLeafIdxToOffset.end() && oIter->second > item.offset
+                ? m_offsetFeatures + oIter->second
+                : nStart + DEFAULT_FEATURE_SIZE;
+        if (nEnd - nStart > MAX_RANGE_SIZE)
+            continue;
+        if (!m_anFeatureRangeOffsets.empty())
+        {
+            const uint64_t nRangeStart = m_anFeatureRangeOffsets.back();
+            const uint64_t nRangeEnd =
+                nRangeStart + m_anFeatureRangeSizes.back();
+            if (nStart >= nRangeStart && nStart <= nRangeEnd + MAX_GAP &&
+                nEnd - nRangeStart <= MAX_RANGE_SIZE)
+            {
+                if (nEnd > nRangeEnd)
+                    m_anFeatureRangeSizes.back() =
+                        static_cast<size_t>(nEnd - nRangeStart);
+                continue;
+            }
+        }
+        m_anFeatureRangeOffsets.push_back(nStart);
+        m_anFeatureRangeSizes.push_back(static_cast<size_t>(nEnd - nStart));
+    }
+
+    CPLDebugOnly("FlatGeobuf", "%u byte ranges for %u found features",
+                 static_cast<unsigned>(m_anFeatureRangeOffsets.size()),
+                 static_cast<unsigned>(m_foundItems.size()));
+}
+
+/************************************************************************/
+/*                      adviseReadFeatureRanges()                       */
+/************************************************************************/
+
+// Called before reading the found feature at m_offset. Advises the next
+// ranges to the file handle, by batches, as /vsicurl/ keeps the advised
+// ranges in memory.
+void OGRFlatGeobufLayer::adviseReadFeatureRanges()
+{
+    if (m_offset < m_nAdvisedFeatureRangesEnd)
+        return;
+
+    size_t iFirst = m_nNextFeatureRangeToAdvise;
+    while (iFirst < m_anFeatureRangeOffsets.size() &&
+           m_anFeatureRangeOffsets[iFirst] + m_anFeatureRangeSizes[iFirst] <=
+               m_offset)
+    {
+        ++iFirst;
+    }
+    if (iFirst == m_anFeatureRangeOffsets.size())
+    {
+        m_nNextFeatureRangeToAdvise = iFirst;
+        return;
+    }
+
+    constexpr size_t MAX_ADVISED_SIZE = 20 * 1024 * 1024;
+    size_t nAdvisedSize = m_anFeatureRangeSizes[iFirst];
+    size_t iLast = iFirst;
+    while (iLast + 1 < m_anFeatureRangeOffsets.size() &&
+           nAdvisedSize + m_anFeatureRangeSizes[iLast + 1] <= MAX_ADVISED_SIZE)
+    {
+        ++iLast;
+        nAdvisedSize += m_anFeatureRangeSizes[iLast];
+    }
+
+    m_poFp->AdviseRead(static_cast<int>(iLast - iFirst + 1),
+                       m_anFeatureRangeOffsets.data() + iFirst,
+                       m_anFeatureRangeSizes.data() + iFirst);
+    m_nNextFeatureRangeToAdvise = iLast + 1;
+    m_nAdvisedFeatureRangesEnd =
+        m_anFeatureRangeOffsets[iLast] + m_anFeatureRangeSizes[iLast];
+}
+
 GIntBig OGRFlatGeobufLayer::GetFeatureCount(int bForce)
 {
     if (m_poFilterGeom != nullptr || m_poAttrQuery != nullptr ||
@@ -1077,6 +1287,7 @@ OGRErr OGRFlatGeobufLayer::parseFeature(OGRFeature *poFeature)
         m_offset = m_offsetFeatures + item.offset;
         fid = item.index;
         seek = true;
+        adviseReadFeatureRanges();
     }
     else
     {
@@ -1516,6 +1727,7 @@ begin:
             m_offset = m_offsetFeatures + item.offset;
             fid = item.index;
             seek = true;
+            adviseReadFeatureRanges();
         }
         else
         {
@@ -2424,6 +2636,10 @@ void OGRFlatGeobufLayer::ResetReading()
     m_bEOF = false;
     m_featuresPos = 0;
     m_foundItems.clear();
+    m_anFeatureRangeOffsets.clear();
+    m_anFeatureRangeSizes.clear();
+    m_nNextFeatureRangeToAdvise = 0;
+    m_nAdvisedFeatureRangesEnd = 0;
     m_featuresCount = m_poHeader ? m_poHeader->features_count() : 0;
     m_queriedSpatialIndex = false;
     m_ignoreSpatialFilter = false;
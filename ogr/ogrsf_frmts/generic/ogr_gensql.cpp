@@ -33,8 +33,12 @@
 #include "cpl_string.h"
 #include "ogr_api.h"
 #include "cpl_time.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include <algorithm>
+#include <cctype>
 #include <limits>
+#include <unordered_map>
 #include <vector>
 
 //! @cond Doxygen_Suppress
@@ -82,6 +86,167 @@ static bool OGRGenSQLResultsLayerHasSpecialField(swq_expr_node *expr,
     return false;
 }
 
+/************************************************************************/
+/*                            GetMaxMemory()                            */
+/************************************************************************/
+
+// Maximum amount of memory, in bytes, set by a configuration option
+// expressed in MB: OGR_SQL_HASH_MAX_MEMORY for the hash tables of a JOIN or
+// a GROUP BY, OGR_SQL_SORT_MAX_MEMORY for the index of an ORDER BY.
+static size_t GetMaxMemory(const char *pszConfigOption)
+{
+    const double dfMaxMemoryMB =
+        CPLAtof(CPLGetConfigOption(pszConfigOption, "1024"));
+    const double dfMaxMemory = dfMaxMemoryMB * 1024 * 1024;
+    if (!(dfMaxMemory > 0))
+        return 0;
+    if (dfMaxMemory >= static_cast<double>(std::numeric_limits<size_t>::max()))
+        return std::numeric_limits<size_t>::max();
+    return static_cast<size_t>(dfMaxMemory);
+}
+
+/************************************************************************/
+/*                       EstimateFeatureMemory()                        */
+/************************************************************************/
+
+static size_t EstimateFeatureMemory(OGRFeature *poFeature)
+{
+    const OGRFeatureDefn *poFDefn = poFeature->GetDefnRef();
+    const int nFieldCount = poFDefn->GetFieldCount();
+    const int nGeomFieldCount = poFDefn->GetGeomFieldCount();
+    size_t nSize = sizeof(OGRFeature) + nFieldCount * sizeof(OGRField) +
+                   nGeomFieldCount * sizeof(OGRGeometry *);
+    for (int i = 0; i < nFieldCount; i++)
+    {
+        if (!poFeature->IsFieldSetAndNotNull(i))
+            continue;
+        const OGRField *psField = poFeature->GetRawFieldRef(i);
+        switch (poFDefn->GetFieldDefn(i)->GetType())
+        {
+            case OFTString:
+                nSize += strlen(psField->String) + 1;
+                break;
+            case OFTBinary:
+                nSize += psField->Binary.nCount;
+                break;
+            case OFTIntegerList:
+                nSize += psField->IntegerList.nCount * sizeof(int);
+                break;
+            case OFTInteger64List:
+                nSize += psField->Integer64List.nCount * sizeof(GIntBig);
+                break;
+            case OFTRealList:
+                nSize += psField->RealList.nCount * sizeof(double);
+                break;
+            case OFTStringList:
+                for (int j = 0; j < psField->StringList.nCount; j++)
+                    nSize += sizeof(char *) +
+                             strlen(psField->StringList.paList[j]) + 1;
+                break;
+            default:
+                break;
+        }
+    }
+    for (int i = 0; i < nGeomFieldCount; i++)
+    {
+        const OGRGeometry *poGeom = poFeature->GetGeomFieldRef(i);
+        if (poGeom)
+            nSize += poGeom->WkbSize();
+    }
+    return nSize;
+}
+
+/************************************************************************/
+/*                         GetValueForSummary()                         */
+/*                                                                      */
+/*      Fetch in pszVal the value of the column psColDef of             */
+/*      poSrcFeature that must be summarized. Returns false if nothing  */
+/*      must be summarized, that is for NULL values in COUNT().         */
+/************************************************************************/
+
+static bool GetValueForSummary(OGRFeature *poSrcFeature,
+                               const swq_col_def *psColDef,
+                               const char *&pszVal)
+{
+    pszVal = nullptr;
+    if (psColDef->col_func == SWQCF_COUNT)
+    {
+        /* psColDef->field_index can be -1 in the case of a COUNT(*) */
+        if (psColDef->field_index < 0)
+            pszVal = "";
+        else if (IS_GEOM_FIELD_INDEX(poSrcFeature->GetDefnRef(),
+                                     psColDef->field_index))
+        {
+            int iSrcGeomField = ALL_FIELD_INDEX_TO_GEOM_FIELD_INDEX(
+                poSrcFeature->GetDefnRef(), psColDef->field_index);
+            if (poSrcFeature->GetGeomFieldRef(iSrcGeomField) == nullptr)
+                return false;
+            pszVal = "";
+        }
+        else if (poSrcFeature->IsFieldSetAndNotNull(psColDef->field_index))
+            pszVal = poSrcFeature->GetFieldAsString(psColDef->field_index);
+        else
+            return false;
+    }
+    else if (poSrcFeature->IsFieldSetAndNotNull(psColDef->field_index))
+    {
+        pszVal = poSrcFeature->GetFieldAsString(psColDef->field_index);
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                        SetSummaryFieldValue()                        */
+/************************************************************************/
+
+static void SetSummaryFieldValue(OGRFeature *poFeature, int iField,
+                                 const swq_col_def *psColDef,
+                                 const swq_summary &oSummary)
+{
+    if (psColDef->col_func == SWQCF_AVG && oSummary.count > 0)
+    {
+        if (psColDef->field_type == SWQ_DATE ||
+            psColDef->field_type == SWQ_TIME ||
+            psColDef->field_type == SWQ_TIMESTAMP)
+        {
+            struct tm brokendowntime;
+            double dfAvg = oSummary.sum / oSummary.count;
+            CPLUnixTimeToYMDHMS(static_cast<GIntBig>(dfAvg), &brokendowntime);
+            poFeature->SetField(
+                iField, brokendowntime.tm_year + 1900,
+                brokendowntime.tm_mon + 1, brokendowntime.tm_mday,
+                brokendowntime.tm_hour, brokendowntime.tm_min,
+                static_cast<float>(brokendowntime.tm_sec + fmod(dfAvg, 1)), 0);
+        }
+        else
+            poFeature->SetField(iField, oSummary.sum / oSummary.count);
+    }
+    else if (psColDef->col_func == SWQCF_MIN && oSummary.count > 0)
+    {
+        if (psColDef->field_type == SWQ_DATE ||
+            psColDef->field_type == SWQ_TIME ||
+            psColDef->field_type == SWQ_TIMESTAMP ||
+            psColDef->field_type == SWQ_STRING)
+            poFeature->SetField(iField, oSummary.osMin.c_str());
+        else
+            poFeature->SetField(iField, oSummary.min);
+    }
+    else if (psColDef->col_func == SWQCF_MAX && oSummary.count > 0)
+    {
+        if (psColDef->field_type == SWQ_DATE ||
+            psColDef->field_type == SWQ_TIME ||
+            psColDef->field_type == SWQ_TIMESTAMP ||
+            psColDef->field_type == SWQ_STRING)
+            poFeature->SetField(iField, oSummary.osMax.c_str());
+        else
+            poFeature->SetField(iField, oSummary.max);
+    }
+    else if (psColDef->col_func == SWQCF_COUNT)
+        poFeature->SetField(iField, oSummary.count);
+    else if (psColDef->col_func == SWQCF_SUM && oSummary.count > 0)
+        poFeature->SetField(iField, oSummary.sum);
+}
+
 /************************************************************************/
 /*                       OGRGenSQLResultsLayer()                        */
 /************************************************************************/
@@ -670,7 +835,7 @@ OGRErr OGRGenSQLResultsLayer::SetNextByIndex(GIntBig nIndex)
     }
     if (psSelectInfo->query_mode == SWQM_SUMMARY_RECORD ||
         psSelectInfo->query_mode == SWQM_DISTINCT_LIST ||
-        panFIDIndex != nullptr)
+        psSelectInfo->query_mode == SWQM_GROUP_BY || HasOrderByIndex())
     {
         nNextIndexFID = nIndex + psSelectInfo->offset;
         return OGRERR_NONE;
@@ -741,6 +906,13 @@ GIntBig OGRGenSQLResultsLayer::GetFeatureCount(int bForce)
 
         nRet = psSelectInfo->column_summary[0].count;
     }
+    else if (psSelectInfo->query_mode == SWQM_GROUP_BY)
+    {
+        if (!PrepareGroupBy())
+            return 0;
+
+        nRet = static_cast<GIntBig>(m_apoGroupByFeatures.size());
+    }
     else if (psSelectInfo->query_mode != SWQM_RECORDSET)
         return 1;
     else if (m_poAttrQuery == nullptr && !MustEvaluateSpatialFilterOnGenSQL())
@@ -773,7 +945,7 @@ int OGRGenSQLResultsLayer::TestCapability(const char *pszCap)
     {
         if (psSelectInfo->query_mode == SWQM_SUMMARY_RECORD ||
             psSelectInfo->query_mode == SWQM_DISTINCT_LIST ||
-            panFIDIndex != nullptr)
+            psSelectInfo->query_mode == SWQM_GROUP_BY || HasOrderByIndex())
             return TRUE;
         else
             return poSrcLayer->TestCapability(pszCap);
@@ -826,6 +998,48 @@ int OGRGenSQLResultsLayer::ContainGeomSpecialField(swq_expr_node *expr)
     return FALSE;
 }
 
+/************************************************************************/
+/*                     IsGeometryNeededForSummary()                     */
+/************************************************************************/
+
+bool OGRGenSQLResultsLayer::IsGeometryNeededForSummary()
+{
+    swq_select *psSelectInfo = static_cast<swq_select *>(pSelectInfo);
+
+    if (m_poFilterGeom != nullptr ||
+        (psSelectInfo->where_expr != nullptr &&
+         ContainGeomSpecialField(psSelectInfo->where_expr)))
+        return true;
+
+    for (int iField = 0; iField < psSelectInfo->result_columns(); iField++)
+    {
+        swq_col_def *psColDef = &psSelectInfo->column_defs[iField];
+        if (psColDef->table_index == 0 && psColDef->field_index != -1)
+        {
+            OGRLayer *poLayer = papoTableLayers[psColDef->table_index];
+            int nSpecialFieldIdx = psColDef->field_index -
+                                   poLayer->GetLayerDefn()->GetFieldCount();
+            if (nSpecialFieldIdx == SPF_OGR_GEOMETRY ||
+                nSpecialFieldIdx == SPF_OGR_GEOM_WKT ||
+                nSpecialFieldIdx == SPF_OGR_GEOM_AREA)
+            {
+                return true;
+            }
+            if (psColDef->field_index ==
+                GEOM_FIELD_INDEX_TO_ALL_FIELD_INDEX(poLayer->GetLayerDefn(), 0))
+            {
+                return true;
+            }
+        }
+        if (psColDef->expr != nullptr &&
+            ContainGeomSpecialField(psColDef->expr))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 /************************************************************************/
 /*                           PrepareSummary()                           */
 /************************************************************************/
@@ -853,44 +1067,8 @@ int OGRGenSQLResultsLayer::PrepareSummary()
     /*      OGR_GEOM_WKT or OGR_GEOM_AREA special fields.                   */
     /* -------------------------------------------------------------------- */
     int bSaveIsGeomIgnored = poSrcLayer->GetLayerDefn()->IsGeometryIgnored();
-    if (m_poFilterGeom == nullptr &&
-        (psSelectInfo->where_expr == nullptr ||
-         !ContainGeomSpecialField(psSelectInfo->where_expr)))
-    {
-        int bFoundGeomExpr = FALSE;
-        for (int iField = 0; iField < psSelectInfo->result_columns(); iField++)
-        {
-            swq_col_def *psColDef = &psSelectInfo->column_defs[iField];
-            if (psColDef->table_index == 0 && psColDef->field_index != -1)
-            {
-                OGRLayer *poLayer = papoTableLayers[psColDef->table_index];
-                int nSpecialFieldIdx = psColDef->field_index -
-                                       poLayer->GetLayerDefn()->GetFieldCount();
-                if (nSpecialFieldIdx == SPF_OGR_GEOMETRY ||
-                    nSpecialFieldIdx == SPF_OGR_GEOM_WKT ||
-                    nSpecialFieldIdx == SPF_OGR_GEOM_AREA)
-                {
-                    bFoundGeomExpr = TRUE;
-                    break;
-                }
-                if (psColDef->field_index ==
-                    GEOM_FIELD_INDEX_TO_ALL_FIELD_INDEX(poLayer->GetLayerDefn(),
-                                                        0))
-                {
-                    bFoundGeomExpr = TRUE;
-                    break;
-                }
-            }
-            if (psColDef->expr != nullptr &&
-                ContainGeomSpecialField(psColDef->expr))
-            {
-                bFoundGeomExpr = TRUE;
-                break;
-            }
-        }
-        if (!bFoundGeomExpr)
-            poSrcLayer->GetLayerDefn()->SetGeometryIgnored(TRUE);
-    }
+    if (!IsGeometryNeededForSummary())
+        poSrcLayer->GetLayerDefn()->SetGeometryIgnored(TRUE);
 
     /* -------------------------------------------------------------------- */
     /*      We treat COUNT(*) as a special case, and fill with              */
@@ -930,40 +1108,11 @@ int OGRGenSQLResultsLayer::PrepareSummary()
         {
             swq_col_def *psColDef = &psSelectInfo->column_defs[iField];
 
-            if (psColDef->col_func == SWQCF_COUNT)
-            {
-                /* psColDef->field_index can be -1 in the case of a COUNT(*) */
-                if (psColDef->field_index < 0)
-                    pszError = swq_select_summarize(psSelectInfo, iField, "");
-                else if (IS_GEOM_FIELD_INDEX(poSrcLayer->GetLayerDefn(),
-                                             psColDef->field_index))
-                {
-                    int iSrcGeomField = ALL_FIELD_INDEX_TO_GEOM_FIELD_INDEX(
-                        poSrcLayer->GetLayerDefn(), psColDef->field_index);
-                    OGRGeometry *poGeom =
-                        poSrcFeature->GetGeomFieldRef(iSrcGeomField);
-                    if (poGeom != nullptr)
-                        pszError =
-                            swq_select_summarize(psSelectInfo, iField, "");
-                    else
-                        pszError = nullptr;
-                }
-                else if (poSrcFeature->IsFieldSetAndNotNull(
-                             psColDef->field_index))
-                    pszError = swq_select_summarize(
-                        psSelectInfo, iField,
-                        poSrcFeature->GetFieldAsString(psColDef->field_index));
-                else
-                    pszError = nullptr;
-            }
-            else
-            {
-                const char *pszVal = nullptr;
-                if (poSrcFeature->IsFieldSetAndNotNull(psColDef->field_index))
-                    pszVal =
-                        poSrcFeature->GetFieldAsString(psColDef->field_index);
+            const char *pszVal = nullptr;
+            if (GetValueForSummary(poSrcFeature, psColDef, pszVal))
                 pszError = swq_select_summarize(psSelectInfo, iField, pszVal);
-            }
+            else
+                pszError = nullptr;
 
             if (pszError != nullptr)
             {
@@ -1026,61 +1175,324 @@ int OGRGenSQLResultsLayer::PrepareSummary()
             swq_col_def *psColDef = &psSelectInfo->column_defs[iField];
             if (!psSelectInfo->column_summary.empty())
             {
-                const swq_summary &oSummary =
-                    psSelectInfo->column_summary[iField];
+                SetSummaryFieldValue(poSummaryFeature, iField, psColDef,
+                                     psSelectInfo->column_summary[iField]);
+            }
+            else if (psColDef->col_func == SWQCF_COUNT)
+                poSummaryFeature->SetField(iField, 0);
+        }
+    }
+
+    return TRUE;
+}
 
-                if (psColDef->col_func == SWQCF_AVG && oSummary.count > 0)
+/************************************************************************/
+/*                       CompareGroupByKeyValue()                       */
+/************************************************************************/
+
+// NULL values (nullptr) sort first.
+static int CompareGroupByKeyValue(swq_field_type eType, const char *pszA,
+                                  const char *pszB)
+{
+    if (pszA == nullptr)
+        return pszB == nullptr ? 0 : -1;
+    if (pszB == nullptr)
+        return 1;
+
+    switch (eType)
+    {
+        case SWQ_INTEGER:
+        case SWQ_INTEGER64:
+        case SWQ_BOOLEAN:
+        {
+            const GIntBig nA = CPLAtoGIntBig(pszA);
+            const GIntBig nB = CPLAtoGIntBig(pszB);
+            return nA < nB ? -1 : nA > nB ? 1 : 0;
+        }
+
+        case SWQ_FLOAT:
+        {
+            const double dfA = CPLAtof(pszA);
+            const double dfB = CPLAtof(pszB);
+            return dfA < dfB ? -1 : dfA > dfB ? 1 : 0;
+        }
+
+        default:
+            return strcmp(pszA, pszB);
+    }
+}
+
+namespace
+{
+struct GroupByGroup
+{
+    std::vector<std::string> aosKeyValues{};
+    std::vector<bool> abKeyNull{};
+    std::vector<swq_summary> aoSummaries{};
+};
+}  // namespace
+
+/************************************************************************/
+/*                           PrepareGroupBy()                           */
+/*                                                                      */
+/*      Run the source features through a hash table keyed by the       */
+/*      values of the GROUP BY fields, accumulating the aggregates of   */
+/*      each group, and build one result feature per group.            */
+/************************************************************************/
+
+int OGRGenSQLResultsLayer::PrepareGroupBy()
+
+{
+    if (m_bGroupByPrepared)
+        return TRUE;
+
+    // Set early, as ApplyFiltersToSource() calls GetLayerDefn() which
+    // calls us.
+    m_bGroupByPrepared = true;
+
+    swq_select *psSelectInfo = static_cast<swq_select *>(pSelectInfo);
+    const int nColumns = psSelectInfo->result_columns();
+    const int nKeys = static_cast<int>(psSelectInfo->group_defs.size());
+    OGRFeatureDefn *poSrcDefn = poSrcLayer->GetLayerDefn();
+
+    ApplyFiltersToSource();
+
+    int bSaveIsGeomIgnored = poSrcDefn->IsGeometryIgnored();
+    if (!IsGeometryNeededForSummary())
+        poSrcDefn->SetGeometryIgnored(TRUE);
+
+    const size_t nMaxMemory = GetMaxMemory("OGR_SQL_HASH_MAX_MEMORY");
+    size_t nMemoryUsed = 0;
+    std::vector<GroupByGroup> aoGroups;
+    std::unordered_map<std::string, size_t> oMapKeyToGroup;
+    std::vector<std::string> aosKeyValues(nKeys);
+    std::vector<bool> abKeyNull(nKeys);
+    std::string osKey;
+    const char *pszError = nullptr;
+
+    try
+    {
+        while (pszError == nullptr)
+        {
+            auto poSrcFeature =
+                std::unique_ptr<OGRFeature>(poSrcLayer->GetNextFeature());
+            if (poSrcFeature == nullptr)
+                break;
+
+            osKey.clear();
+            for (int iKey = 0; iKey < nKeys; iKey++)
+            {
+                const int iSrcField =
+                    psSelectInfo->group_defs[iKey].field_index;
+                abKeyNull[iKey] =
+                    !poSrcFeature->IsFieldSetAndNotNull(iSrcField);
+                if (abKeyNull[iKey])
                 {
-                    if (psColDef->field_type == SWQ_DATE ||
-                        psColDef->field_type == SWQ_TIME ||
-                        psColDef->field_type == SWQ_TIMESTAMP)
-                    {
-                        struct tm brokendowntime;
-                        double dfAvg = oSummary.sum / oSummary.count;
-                        CPLUnixTimeToYMDHMS(static_cast<GIntBig>(dfAvg),
-                                            &brokendowntime);
-                        poSummaryFeature->SetField(
-                            iField, brokendowntime.tm_year + 1900,
-                            brokendowntime.tm_mon + 1, brokendowntime.tm_mday,
-                            brokendowntime.tm_hour, brokendowntime.tm_min,
-                            static_cast<float>(brokendowntime.tm_sec +
-                                               fmod(dfAvg, 1)),
-                            0);
-                    }
-                    else
-                        poSummaryFeature->SetField(iField, oSummary.sum /
-                                                               oSummary.count);
+                    aosKeyValues[iKey].clear();
+                    osKey += 'N';
+                    continue;
                 }
-                else if (psColDef->col_func == SWQCF_MIN && oSummary.count > 0)
+
+                // Use a round-trippable representation of doubles
+                if (iSrcField < poSrcDefn->GetFieldCount() &&
+                    poSrcDefn->GetFieldDefn(iSrcField)->GetType() == OFTReal)
                 {
-                    if (psColDef->field_type == SWQ_DATE ||
-                        psColDef->field_type == SWQ_TIME ||
-                        psColDef->field_type == SWQ_TIMESTAMP ||
-                        psColDef->field_type == SWQ_STRING)
-                        poSummaryFeature->SetField(iField,
-                                                   oSummary.osMin.c_str());
-                    else
-                        poSummaryFeature->SetField(iField, oSummary.min);
+                    aosKeyValues[iKey] = CPLSPrintf(
+                        "%.17g", poSrcFeature->GetFieldAsDouble(iSrcField));
                 }
-                else if (psColDef->col_func == SWQCF_MAX && oSummary.count > 0)
+                else
                 {
-                    if (psColDef->field_type == SWQ_DATE ||
-                        psColDef->field_type == SWQ_TIME ||
-                        psColDef->field_type == SWQ_TIMESTAMP ||
-                        psColDef->field_type == SWQ_STRING)
-                        poSummaryFeature->SetField(iField,
-                                                   oSummary.osMax.c_str());
-                    else
-                        poSummaryFeature->SetField(iField, oSummary.max);
+                    aosKeyValues[iKey] =
+                        poSrcFeature->GetFieldAsString(iSrcField);
                 }
-                else if (psColDef->col_func == SWQCF_COUNT)
-                    poSummaryFeature->SetField(iField, oSummary.count);
-                else if (psColDef->col_func == SWQCF_SUM && oSummary.count > 0)
-                    poSummaryFeature->SetField(iField, oSummary.sum);
+                osKey += 'V';
+                osKey += std::to_string(aosKeyValues[iKey].size());
+                osKey += ':';
+                osKey += aosKeyValues[iKey];
+            }
+
+            size_t iGroup;
+            const auto oIter = oMapKeyToGroup.find(osKey);
+            if (oIter != oMapKeyToGroup.end())
+            {
+                iGroup = oIter->second;
+            }
+            else
+            {
+                nMemoryUsed += sizeof(GroupByGroup) + 2 * osKey.size() +
+                               nColumns * sizeof(swq_summary) +
+                               nKeys * sizeof(std::string) + 64;
+                if (nMemoryUsed > nMaxMemory)
+                {
+                    pszError = "Memory needed by GROUP BY exceeds the value "
+                               "of the OGR_SQL_HASH_MAX_MEMORY configuration "
+                               "option.";
+                    break;
+                }
+
+                iGroup = aoGroups.size();
+                aoGroups.emplace_back();
+                GroupByGroup &oGroup = aoGroups.back();
+                oGroup.aosKeyValues = aosKeyValues;
+                oGroup.abKeyNull = abKeyNull;
+                oGroup.aoSummaries.resize(nColumns);
+                oMapKeyToGroup.emplace(osKey, iGroup);
+            }
+
+            std::vector<swq_summary> &aoSummaries =
+                aoGroups[iGroup].aoSummaries;
+            for (int iField = 0; iField < nColumns && pszError == nullptr;
+                 iField++)
+            {
+                const swq_col_def *psColDef =
+                    &psSelectInfo->column_defs[iField];
+                const char *pszVal = nullptr;
+                if (psColDef->col_func != SWQCF_NONE &&
+                    GetValueForSummary(poSrcFeature.get(), psColDef, pszVal))
+                {
+                    pszError = swq_summary_accumulate(
+                        psColDef, aoSummaries[iField], pszVal);
+                }
+            }
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        pszError = "Out of memory";
+    }
+
+    poSrcDefn->SetGeometryIgnored(bSaveIsGeomIgnored);
+
+    /* -------------------------------------------------------------------- */
+    /*      Clear away the filters we have installed till a next run through*/
+    /*      the features.                                                   */
+    /* -------------------------------------------------------------------- */
+    ClearFilters();
+
+    if (pszError != nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "%s", pszError);
+        m_bGroupByPrepared = false;
+        return FALSE;
+    }
+
+    std::unordered_map<std::string, size_t>().swap(oMapKeyToGroup);
+
+    /* -------------------------------------------------------------------- */
+    /*      Sort the groups if there is an ORDER BY clause. Its fields      */
+    /*      have been checked to be GROUP BY fields.  Otherwise groups are  */
+    /*      returned in the order in which they have been met.             */
+    /* -------------------------------------------------------------------- */
+    std::vector<size_t> anGroupOrder(aoGroups.size());
+    for (size_t i = 0; i < anGroupOrder.size(); i++)
+        anGroupOrder[i] = i;
+
+    if (psSelectInfo->order_specs > 0)
+    {
+        std::vector<int> anOrderKeys;
+        for (int iOrder = 0; iOrder < psSelectInfo->order_specs; iOrder++)
+        {
+            for (int iKey = 0; iKey < nKeys; iKey++)
+            {
+                if (psSelectInfo->group_defs[iKey].field_index ==
+                    psSelectInfo->order_defs[iOrder].field_index)
+                {
+                    anOrderKeys.push_back(iKey);
+                    break;
+                }
+            }
+        }
+        CPLAssert(static_cast<int>(anOrderKeys.size()) ==
+                  psSelectInfo->order_specs);
+
+        std::stable_sort(
+            anGroupOrder.begin(), anGroupOrder.end(),
+            [psSelectInfo, &aoGroups, &anOrderKeys](size_t iA, size_t iB)
+            {
+                const GroupByGroup &oA = aoGroups[iA];
+                const GroupByGroup &oB = aoGroups[iB];
+                for (size_t i = 0; i < anOrderKeys.size(); i++)
+                {
+                    const int iKey = anOrderKeys[i];
+                    int nCmp = CompareGroupByKeyValue(
+                        psSelectInfo->group_defs[iKey].field_type,
+                        oA.abKeyNull[iKey] ? nullptr
+                                           : oA.aosKeyValues[iKey].c_str(),
+                        oB.abKeyNull[iKey] ? nullptr
+                                           : oB.aosKeyValues[iKey].c_str());
+                    if (!psSelectInfo->order_defs[i].ascending_flag)
+                        nCmp = -nCmp;
+                    if (nCmp != 0)
+                        return nCmp < 0;
+                }
+                return false;
+            });
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Downcast COUNT() columns to OFTInteger if possible, and find    */
+    /*      the GROUP BY field of non-aggregate columns.                    */
+    /* -------------------------------------------------------------------- */
+    std::vector<int> anColumnToKey(nColumns, -1);
+    for (int iField = 0; iField < nColumns; iField++)
+    {
+        const swq_col_def *psColDef = &psSelectInfo->column_defs[iField];
+        if (psColDef->col_func == SWQCF_COUNT)
+        {
+            GIntBig nMaxCount = 0;
+            for (const auto &oGroup : aoGroups)
+                nMaxCount =
+                    std::max(nMaxCount, oGroup.aoSummaries[iField].count);
+            if (CPL_INT64_FITS_ON_INT32(nMaxCount))
+                poDefn->GetFieldDefn(iField)->SetType(OFTInteger);
+        }
+        else if (psColDef->col_func == SWQCF_NONE)
+        {
+            for (int iKey = 0; iKey < nKeys; iKey++)
+            {
+                if (psSelectInfo->group_defs[iKey].table_index ==
+                        psColDef->table_index &&
+                    psSelectInfo->group_defs[iKey].field_index ==
+                        psColDef->field_index)
+                {
+                    anColumnToKey[iField] = iKey;
+                    break;
+                }
+            }
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Build the result features.                                      */
+    /* -------------------------------------------------------------------- */
+    m_apoGroupByFeatures.clear();
+    m_apoGroupByFeatures.reserve(aoGroups.size());
+    for (size_t i = 0; i < anGroupOrder.size(); i++)
+    {
+        GroupByGroup &oGroup = aoGroups[anGroupOrder[i]];
+        auto poFeature = std::make_unique<OGRFeature>(poDefn);
+        poFeature->SetFID(static_cast<GIntBig>(i));
+        for (int iField = 0; iField < nColumns; iField++)
+        {
+            const swq_col_def *psColDef = &psSelectInfo->column_defs[iField];
+            const int iKey = anColumnToKey[iField];
+            if (iKey >= 0)
+            {
+                if (oGroup.abKeyNull[iKey])
+                    poFeature->SetFieldNull(iField);
+                else
+                    poFeature->SetField(iField,
+                                        oGroup.aosKeyValues[iKey].c_str());
+            }
+            else
+            {
+                SetSummaryFieldValue(poFeature.get(), iField, psColDef,
+                                     oGroup.aoSummaries[iField]);
             }
-            else if (psColDef->col_func == SWQCF_COUNT)
-                poSummaryFeature->SetField(iField, 0);
         }
+        // Release the group as soon as possible
+        oGroup = GroupByGroup();
+        m_apoGroupByFeatures.push_back(std::move(poFeature));
     }
 
     return TRUE;
@@ -1302,7 +1714,212 @@ static CPLString GetFilterForJoin(swq_expr_node *poExpr, OGRFeature *poSrcFeat,
 }
 
 /************************************************************************/
-/*                          TranslateFeature()                          */
+/*                     JoinHashTable::BuildKey()                        */
+/*                                                                      */
+/*      Build in osKey the hash key of poFeature, from the fields of    */
+/*      the primary or secondary side of the join. Returns false if     */
+/*      one of them is NULL, in which case there cannot be a match.     */
+/************************************************************************/
+
+bool OGRGenSQLResultsLayer::JoinHashTable::BuildKey(OGRFeature *poFeature,
+                                                    bool bPrimary,
+                                                    std::string &osKey) const
+{
+    const std::vector<int> &anFields =
+        bPrimary ? anPrimaryFields : anSecondaryFields;
+    osKey.clear();
+    for (size_t i = 0; i < anFields.size(); i++)
+    {
+        const int iField = anFields[i];
+        if (!poFeature->IsFieldSetAndNotNull(iField))
+            return false;
+
+        switch (aeKeyTypes[i])
+        {
+            case KeyType::INTEGER:
+                osKey += CPLSPrintf(CPL_FRMT_GIB,
+                                    poFeature->GetFieldAsInteger64(iField));
+                break;
+
+            case KeyType::REAL:
+            {
+                double dfVal = poFeature->GetFieldAsDouble(iField);
+                if (dfVal == 0)
+                    dfVal = 0;  // normalize -0
+                osKey += CPLSPrintf("%.17g", dfVal);
+                break;
+            }
+
+            case KeyType::STRING:
+            {
+                // String equality is case insensitive in OGR SQL
+                const char *pszVal = poFeature->GetFieldAsString(iField);
+                osKey += std::to_string(strlen(pszVal));
+                osKey += ':';
+                for (; *pszVal; ++pszVal)
+                    osKey += static_cast<char>(
+                        toupper(static_cast<unsigned char>(*pszVal)));
+                break;
+            }
+        }
+        osKey += ',';
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                         BuildJoinHashTable()                         */
+/*                                                                      */
+/*      Read the secondary layer of the iJoin-th join into a hash       */
+/*      table, if its ON clause is made of equality tests between a     */
+/*      field of the primary layer and one of the secondary layer,      */
+/*      ANDed together. Returns nullptr if that is not the case, or if  */
+/*      the table would take more memory than allowed.                  */
+/************************************************************************/
+
+std::unique_ptr<OGRGenSQLResultsLayer::JoinHashTable>
+OGRGenSQLResultsLayer::BuildJoinHashTable(int iJoin, size_t &nMemoryUsed)
+{
+    swq_select *psSelectInfo = static_cast<swq_select *>(pSelectInfo);
+    swq_join_def *psJoinInfo = psSelectInfo->join_defs + iJoin;
+    OGRLayer *poJoinLayer = papoTableLayers[psJoinInfo->secondary_table];
+
+    // Reading the whole secondary layer would disturb the iteration on the
+    // primary one.
+    if (poJoinLayer == poSrcLayer)
+        return nullptr;
+
+    OGRFeatureDefn *poSrcDefn = poSrcLayer->GetLayerDefn();
+    OGRFeatureDefn *poJoinDefn = poJoinLayer->GetLayerDefn();
+
+    auto poHashTable = std::make_unique<JoinHashTable>();
+    std::vector<swq_expr_node *> apoExprs{psJoinInfo->poExpr};
+    while (!apoExprs.empty())
+    {
+        swq_expr_node *poExpr = apoExprs.back();
+        apoExprs.pop_back();
+        if (poExpr->eNodeType != SNT_OPERATION)
+            return nullptr;
+        if (poExpr->nOperation == SWQ_AND)
+        {
+            for (int i = 0; i < poExpr->nSubExprCount; i++)
+                apoExprs.push_back(poExpr->papoSubExpr[i]);
+            continue;
+        }
+        if (poExpr->nOperation != SWQ_EQ || poExpr->nSubExprCount != 2)
+            return nullptr;
+
+        const swq_expr_node *poPrimary = poExpr->papoSubExpr[0];
+        const swq_expr_node *poSecondary = poExpr->papoSubExpr[1];
+        if (poPrimary->eNodeType != SNT_COLUMN ||
+            poSecondary->eNodeType != SNT_COLUMN)
+            return nullptr;
+        if (poPrimary->table_index != 0)
+            std::swap(poPrimary, poSecondary);
+        if (poPrimary->table_index != 0 ||
+            poSecondary->table_index != psJoinInfo->secondary_table ||
+            poPrimary->field_index < 0 ||
+            poPrimary->field_index >= poSrcDefn->GetFieldCount() ||
+            poSecondary->field_index < 0 ||
+            poSecondary->field_index >= poJoinDefn->GetFieldCount())
+            return nullptr;
+
+        const OGRFieldType ePrimaryType =
+            poSrcDefn->GetFieldDefn(poPrimary->field_index)->GetType();
+        const OGRFieldType eSecondaryType =
+            poJoinDefn->GetFieldDefn(poSecondary->field_index)->GetType();
+        const auto IsInteger = [](OGRFieldType eType)
+        { return eType == OFTInteger || eType == OFTInteger64; };
+
+        JoinHashTable::KeyType eKeyType;
+        if (ePrimaryType == OFTString && eSecondaryType == OFTString)
+            eKeyType = JoinHashTable::KeyType::STRING;
+        else if (IsInteger(ePrimaryType) && IsInteger(eSecondaryType))
+            eKeyType = JoinHashTable::KeyType::INTEGER;
+        else if ((IsInteger(ePrimaryType) || ePrimaryType == OFTReal) &&
+                 (IsInteger(eSecondaryType) || eSecondaryType == OFTReal))
+            eKeyType = JoinHashTable::KeyType::REAL;
+        else
+            return nullptr;
+
+        poHashTable->anPrimaryFields.push_back(poPrimary->field_index);
+        poHashTable->anSecondaryFields.push_back(poSecondary->field_index);
+        poHashTable->aeKeyTypes.push_back(eKeyType);
+    }
+
+    const size_t nMaxMemory = GetMaxMemory("OGR_SQL_HASH_MAX_MEMORY");
+    const size_t nMemoryUsedBefore = nMemoryUsed;
+    std::string osKey;
+
+    poJoinLayer->SetAttributeFilter(nullptr);
+    poJoinLayer->ResetReading();
+    while (true)
+    {
+        auto poFeature =
+            std::unique_ptr<OGRFeature>(poJoinLayer->GetNextFeature());
+        if (poFeature == nullptr)
+            break;
+
+        // As with the attribute filter based lookup, the first matching
+        // secondary feature wins.
+        if (!poHashTable->BuildKey(poFeature.get(), false, osKey) ||
+            poHashTable->oMap.find(osKey) != poHashTable->oMap.end())
+            continue;
+
+        nMemoryUsed +=
+            EstimateFeatureMemory(poFeature.get()) + 2 * osKey.size() + 64;
+        if (nMemoryUsed > nMaxMemory)
+        {
+            CPLDebug("GenSQL",
+                     "Hash table for join with layer %s would exceed "
+                     "OGR_SQL_HASH_MAX_MEMORY. Using per-feature lookups",
+                     poJoinLayer->GetName());
+            nMemoryUsed = nMemoryUsedBefore;
+            poJoinLayer->ResetReading();
+            return nullptr;
+        }
+        poHashTable->oMap.emplace(osKey, std::move(poFeature));
+    }
+    poJoinLayer->ResetReading();
+
+    CPLDebug("GenSQL", "Hash table for join with layer %s: %u keys",
+             poJoinLayer->GetName(),
+             static_cast<unsigned>(poHashTable->oMap.size()));
+    return poHashTable;
+}
+
+/************************************************************************/
+/*                        BuildJoinHashTables()                         */
+/************************************************************************/
+
+void OGRGenSQLResultsLayer::BuildJoinHashTables()
+{
+    if (m_bJoinHashTablesBuilt)
+        return;
+    m_bJoinHashTablesBuilt = true;
+
+    swq_select *psSelectInfo = static_cast<swq_select *>(pSelectInfo);
+    m_apoJoinHashTables.resize(psSelectInfo->join_count);
+    if (!CPLTestBool(CPLGetConfigOption("OGR_SQL_HASH_JOIN", "YES")))
+        return;
+
+    size_t nMemoryUsed = 0;
+    for (int iJoin = 0; iJoin < psSelectInfo->join_count; iJoin++)
+    {
+        try
+        {
+            m_apoJoinHashTables[iJoin] = BuildJoinHashTable(iJoin, nMemoryUsed);
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLDebug("GenSQL", "Out of memory while building hash table "
+                               "for join. Using per-feature lookups");
+        }
+    }
+}
+
+/************************************************************************/
+/*                          TranslateFeature()                          */
 /************************************************************************/
 
 OGRFeature *OGRGenSQLResultsLayer::TranslateFeature(OGRFeature *poSrcFeat)
@@ -1318,9 +1935,14 @@ OGRFeature *OGRGenSQLResultsLayer::TranslateFeature(OGRFeature *poSrcFeat)
 
     apoFeatures.push_back(poSrcFeat);
 
+    if (psSelectInfo->join_count > 0)
+        BuildJoinHashTables();
+
     /* -------------------------------------------------------------------- */
     /*      Fetch the corresponding features from any jointed tables.       */
     /* -------------------------------------------------------------------- */
+    std::vector<std::unique_ptr<OGRFeature>> apoJoinFeaturesToFree;
+    std::string osKey;
     for (int iJoin = 0; iJoin < psSelectInfo->join_count; iJoin++)
     {
         CPLString osFilter;
@@ -1332,6 +1954,20 @@ OGRFeature *OGRGenSQLResultsLayer::TranslateFeature(OGRFeature *poSrcFeat)
         /* we have taken care of this */
         CPLAssert(psJoinInfo->secondary_table == iJoin + 1);
 
+        const JoinHashTable *poHashTable = m_apoJoinHashTables[iJoin].get();
+        if (poHashTable != nullptr)
+        {
+            OGRFeature *poJoinFeature = nullptr;
+            if (poHashTable->BuildKey(poSrcFeat, true, osKey))
+            {
+                const auto oIter = poHashTable->oMap.find(osKey);
+                if (oIter != poHashTable->oMap.end())
+                    poJoinFeature = oIter->second.get();
+            }
+            apoFeatures.push_back(poJoinFeature);
+            continue;
+        }
+
         OGRLayer *poJoinLayer = papoTableLayers[psJoinInfo->secondary_table];
 
         osFilter = GetFilterForJoin(psJoinInfo->poExpr, poSrcFeat, poJoinLayer,
@@ -1351,6 +1987,7 @@ OGRFeature *OGRGenSQLResultsLayer::TranslateFeature(OGRFeature *poSrcFeat)
         if (poJoinLayer->SetAttributeFilter(osFilter.c_str()) == OGRERR_NONE)
             poJoinFeature = poJoinLayer->GetNextFeature();
 
+        apoJoinFeaturesToFree.emplace_back(poJoinFeature);
         apoFeatures.push_back(poJoinFeature);
     }
 
@@ -1593,8 +2230,6 @@ OGRFeature *OGRGenSQLResultsLayer::TranslateFeature(OGRFeature *poSrcFeat)
 
             iRegularField++;
         }
-
-        delete poJoinFeature;
     }
 
     return poDstFeat;
@@ -1616,7 +2251,7 @@ OGRFeature *OGRGenSQLResultsLayer::GetNextFeature()
         return nullptr;
 
     CreateOrderByIndex();
-    if (panFIDIndex == nullptr && nIteratedFeatures < 0 &&
+    if (!HasOrderByIndex() && nIteratedFeatures < 0 &&
         psSelectInfo->offset > 0 && psSelectInfo->query_mode == SWQM_RECORDSET)
     {
         poSrcLayer->SetNextByIndex(psSelectInfo->offset);
@@ -1628,7 +2263,8 @@ OGRFeature *OGRGenSQLResultsLayer::GetNextFeature()
     /*      Handle summary sets.                                            */
     /* -------------------------------------------------------------------- */
     if (psSelectInfo->query_mode == SWQM_SUMMARY_RECORD ||
-        psSelectInfo->query_mode == SWQM_DISTINCT_LIST)
+        psSelectInfo->query_mode == SWQM_DISTINCT_LIST ||
+        psSelectInfo->query_mode == SWQM_GROUP_BY)
     {
         nIteratedFeatures++;
         return GetFeature(nNextIndexFID++);
@@ -1642,7 +2278,7 @@ OGRFeature *OGRGenSQLResultsLayer::GetNextFeature()
     while (true)
     {
         std::unique_ptr<OGRFeature> poSrcFeat;
-        if (panFIDIndex != nullptr)
+        if (HasOrderByIndex())
         {
             /* --------------------------------------------------------------------
              */
@@ -1652,10 +2288,11 @@ OGRFeature *OGRGenSQLResultsLayer::GetNextFeature()
             /* --------------------------------------------------------------------
              */
 
-            if (nNextIndexFID >= static_cast<GIntBig>(nIndexSize))
+            GIntBig nSrcFID = 0;
+            if (!GetOrderByIndexFID(nNextIndexFID, nSrcFID))
                 return nullptr;
 
-            poSrcFeat.reset(poSrcLayer->GetFeature(panFIDIndex[nNextIndexFID]));
+            poSrcFeat.reset(poSrcLayer->GetFeature(nSrcFID));
             nNextIndexFID++;
         }
         else
@@ -1706,6 +2343,17 @@ OGRFeature *OGRGenSQLResultsLayer::GetFeature(GIntBig nFID)
             return poSummaryFeature->Clone();
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Handle request for GROUP BY record.                             */
+    /* -------------------------------------------------------------------- */
+    if (psSelectInfo->query_mode == SWQM_GROUP_BY)
+    {
+        if (!PrepareGroupBy() || nFID < 0 ||
+            nFID >= static_cast<GIntBig>(m_apoGroupByFeatures.size()))
+            return nullptr;
+        return m_apoGroupByFeatures[static_cast<size_t>(nFID)]->Clone();
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Handle request for distinct list record.                        */
     /* -------------------------------------------------------------------- */
@@ -1817,6 +2465,19 @@ OGRFeatureDefn *OGRGenSQLResultsLayer::GetLayerDefn()
             }
         }
     }
+    else if (psSelectInfo->query_mode == SWQM_GROUP_BY && !m_bGroupByPrepared)
+    {
+        // Same as above
+        for (int iField = 0; iField < psSelectInfo->result_columns(); iField++)
+        {
+            swq_col_def *psColDef = &psSelectInfo->column_defs[iField];
+            if (psColDef->col_func == SWQCF_COUNT)
+            {
+                PrepareGroupBy();
+                break;
+            }
+        }
+    }
 
     return poDefn;
 }
@@ -1941,288 +2602,815 @@ void OGRGenSQLResultsLayer::ReadIndexFields(OGRFeature *poSrcFeat,
 }
 
 /************************************************************************/
-/*                         CreateOrderByIndex()                         */
-/*                                                                      */
-/*      This method is responsible for creating an index providing      */
-/*      ordered access to the features according to the supplied        */
-/*      ORDER BY clauses.                                               */
-/*                                                                      */
-/*      This is accomplished by making one pass through all the         */
-/*      eligible source features, and capturing the order by fields     */
-/*      of all records in memory.  A quick sort is then applied to      */
-/*      this in memory copy of the order-by fields to create the        */
-/*      required index.                                                 */
-/*                                                                      */
-/*      Keeping all the key values in memory will *not* scale up to     */
-/*      very large input datasets.                                      */
+/*                        GetIndexFieldsMemory()                        */
 /************************************************************************/
 
-void OGRGenSQLResultsLayer::CreateOrderByIndex()
-
+// Returns the amount of memory allocated for the strings of a tuple of
+// ORDER BY key values.
+size_t OGRGenSQLResultsLayer::GetIndexFieldsMemory(
+    const OGRField *pasIndexFields) const
 {
-    swq_select *psSelectInfo = static_cast<swq_select *>(pSelectInfo);
-    const int nOrderItems = psSelectInfo->order_specs;
+    size_t nSize = 0;
+    for (size_t iKey = 0; iKey < m_aeOrderKeyTypes.size(); iKey++)
+    {
+        const OGRField *psField = pasIndexFields + iKey;
+        if (m_aeOrderKeyTypes[iKey] == OFTString &&
+            !OGR_RawField_IsUnset(psField) && !OGR_RawField_IsNull(psField))
+        {
+            nSize += strlen(psField->String) + 1;
+        }
+    }
+    return nSize;
+}
 
-    if (!(nOrderItems > 0 && psSelectInfo->query_mode == SWQM_RECORDSET))
-        return;
+/************************************************************************/
+/*                          WriteIndexRecord()                          */
+/************************************************************************/
 
-    if (bOrderByValid)
-        return;
+// Serializes a FID and its ORDER BY key values into a temporary run file.
+static bool WriteIndexRecord(VSILFILE *fp,
+                             const std::vector<OGRFieldType> &aeKeyTypes,
+                             const OGRField *pasIndexFields, GIntBig nFID)
+{
+    bool bOK = VSIFWriteL(&nFID, sizeof(nFID), 1, fp) == 1;
+    for (size_t iKey = 0; bOK && iKey < aeKeyTypes.size(); iKey++)
+    {
+        const OGRField *psField = pasIndexFields + iKey;
+        const OGRFieldType eType = aeKeyTypes[iKey];
+        // Keys of other types are not taken into account by Compare()
+        const bool bHasValue =
+            !OGR_RawField_IsUnset(psField) && !OGR_RawField_IsNull(psField) &&
+            (eType == OFTInteger || eType == OFTInteger64 ||
+             eType == OFTReal || eType == OFTString || eType == OFTDate ||
+             eType == OFTTime || eType == OFTDateTime);
+        const GByte byHasValue = bHasValue ? 1 : 0;
+        bOK = VSIFWriteL(&byHasValue, 1, 1, fp) == 1;
+        if (!bOK || !bHasValue)
+            continue;
+        if (eType == OFTString)
+        {
+            const size_t nLen = strlen(psField->String);
+            if (nLen > std::numeric_limits<uint32_t>::max())
+                return false;
+            const uint32_t nLen32 = static_cast<uint32_t>(nLen);
+            bOK = VSIFWriteL(&nLen32, sizeof(nLen32), 1, fp) == 1 &&
+                  VSIFWriteL(psField->String, 1, nLen, fp) == nLen;
+        }
+        else
+        {
+            bOK = VSIFWriteL(psField, sizeof(OGRField), 1, fp) == 1;
+        }
+    }
+    return bOK;
+}
 
-    bOrderByValid = TRUE;
+namespace
+{
 
-    ResetReading();
+/************************************************************************/
+/*                          OrderByRunReader                            */
+/************************************************************************/
 
-    /* -------------------------------------------------------------------- */
-    /*      Optimize (memory-wise) ORDER BY ... LIMIT 1 [OFFSET 0] case.    */
-    /* -------------------------------------------------------------------- */
-    if (psSelectInfo->offset == 0 && psSelectInfo->limit == 1)
+// Sequential reader of the records of a temporary run file written by
+// WriteIndexRecord().
+struct OrderByRunReader
+{
+    VSILFILE *fp = nullptr;
+    const std::vector<OGRFieldType> *paeKeyTypes = nullptr;
+    std::vector<OGRField> asIndexFields{};
+    std::vector<std::string> aosStrings{};
+    GIntBig nFID = 0;
+    bool bError = false;
+
+    bool Next();
+};
+
+bool OrderByRunReader::Next()
+{
+    if (VSIFReadL(&nFID, sizeof(nFID), 1, fp) != 1)
+        return false;
+    for (size_t iKey = 0; iKey < asIndexFields.size(); iKey++)
     {
-        OGRFeature *poSrcFeat = poSrcLayer->GetNextFeature();
-        if (poSrcFeat == nullptr)
+        OGRField *psField = &asIndexFields[iKey];
+        GByte byHasValue = 0;
+        if (VSIFReadL(&byHasValue, 1, 1, fp) != 1)
         {
-            panFIDIndex = nullptr;
-            nIndexSize = 0;
-            return;
+            bError = true;
+            return false;
         }
-
-        OGRField *pasCurrentFields =
-            static_cast<OGRField *>(CPLCalloc(sizeof(OGRField), nOrderItems));
-        OGRField *pasBestFields =
-            static_cast<OGRField *>(CPLCalloc(sizeof(OGRField), nOrderItems));
-        GIntBig nBestFID = poSrcFeat->GetFID();
-        ReadIndexFields(poSrcFeat, nOrderItems, pasBestFields);
-        delete poSrcFeat;
-        while ((poSrcFeat = poSrcLayer->GetNextFeature()) != nullptr)
+        if (!byHasValue)
         {
-            ReadIndexFields(poSrcFeat, nOrderItems, pasCurrentFields);
-            if (Compare(pasCurrentFields, pasBestFields) < 0)
+            OGR_RawField_SetNull(psField);
+        }
+        else if ((*paeKeyTypes)[iKey] == OFTString)
+        {
+            uint32_t nLen = 0;
+            if (VSIFReadL(&nLen, sizeof(nLen), 1, fp) != 1)
             {
-                nBestFID = poSrcFeat->GetFID();
-                FreeIndexFields(pasBestFields, 1, false);
-                memcpy(pasBestFields, pasCurrentFields,
-                       sizeof(OGRField) * nOrderItems);
+                bError = true;
+                return false;
             }
-            else
+            std::string &osStr = aosStrings[iKey];
+            osStr.resize(nLen);
+            if (nLen > 0 && VSIFReadL(&osStr[0], 1, nLen, fp) != nLen)
             {
-                FreeIndexFields(pasCurrentFields, 1, false);
+                bError = true;
+                return false;
             }
-            memset(pasCurrentFields, 0, sizeof(OGRField) * nOrderItems);
-            delete poSrcFeat;
+            psField->String = &osStr[0];
+        }
+        else if (VSIFReadL(psField, sizeof(OGRField), 1, fp) != 1)
+        {
+            bError = true;
+            return false;
         }
-        VSIFree(pasCurrentFields);
-        FreeIndexFields(pasBestFields, 1);
-        panFIDIndex = static_cast<GIntBig *>(CPLMalloc(sizeof(GIntBig)));
-        panFIDIndex[0] = nBestFID;
-        nIndexSize = 1;
-        return;
     }
+    return true;
+}
 
-    /* -------------------------------------------------------------------- */
-    /*      Allocate set of key values, and the output index.               */
-    /* -------------------------------------------------------------------- */
-    size_t nFeaturesAlloc = 100;
+/************************************************************************/
+/*                       SortIndexFieldsJobData                         */
+/************************************************************************/
 
-    panFIDIndex = nullptr;
-    OGRField *pasIndexFields = static_cast<OGRField *>(
-        CPLCalloc(sizeof(OGRField), nOrderItems * nFeaturesAlloc));
-    GIntBig *panFIDList =
-        static_cast<GIntBig *>(CPLMalloc(sizeof(GIntBig) * nFeaturesAlloc));
+struct SortIndexFieldsJobData
+{
+    const OGRGenSQLResultsLayer *poLayer = nullptr;
+    const OGRField *pasIndexFields = nullptr;
+    size_t *panFirst = nullptr;
+    // nullptr to sort [panFirst, panLast[, or the limit between the two
+    // sorted sub-ranges to merge.
+    size_t *panMiddle = nullptr;
+    size_t *panLast = nullptr;
+};
 
-    /* -------------------------------------------------------------------- */
-    /*      Read in all the key values.                                     */
-    /* -------------------------------------------------------------------- */
-    OGRFeature *poSrcFeat = nullptr;
-    nIndexSize = 0;
+}  // namespace
 
-    while ((poSrcFeat = poSrcLayer->GetNextFeature()) != nullptr)
+/************************************************************************/
+/*                         TempFile::Create()                           */
+/************************************************************************/
+
+bool OGRGenSQLResultsLayer::TempFile::Create()
+{
+    osFilename = CPLGenerateTempFilename("ogr_sql_sort");
+    fp = VSIFOpenL(osFilename.c_str(), "wb+");
+    if (fp == nullptr)
     {
-        if (nIndexSize == nFeaturesAlloc)
-        {
-            GUIntBig nNewFeaturesAlloc =
-                static_cast<GUIntBig>(nFeaturesAlloc) + nFeaturesAlloc / 3;
-#if SIZEOF_SIZE_T == 4
-            if (static_cast<size_t>(nNewFeaturesAlloc) != nNewFeaturesAlloc ||
-                static_cast<size_t>(sizeof(OGRField) * nOrderItems *
-                                    nNewFeaturesAlloc) !=
-                    static_cast<GUIntBig>(sizeof(OGRField)) * nOrderItems *
-                        nNewFeaturesAlloc)
-            {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "Cannot allocate pasIndexFields");
-                FreeIndexFields(pasIndexFields, nIndexSize);
-                VSIFree(panFIDList);
-                nIndexSize = 0;
-                delete poSrcFeat;
-                return;
-            }
-#endif
-            OGRField *pasNewIndexFields =
-                static_cast<OGRField *>(VSI_REALLOC_VERBOSE(
-                    pasIndexFields,
-                    sizeof(OGRField) * nOrderItems *
-                        static_cast<size_t>(nNewFeaturesAlloc)));
-            if (pasNewIndexFields == nullptr)
-            {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "Cannot allocate pasIndexFields");
-                FreeIndexFields(pasIndexFields, nIndexSize);
-                VSIFree(panFIDList);
-                nIndexSize = 0;
-                delete poSrcFeat;
-                return;
-            }
-            pasIndexFields = pasNewIndexFields;
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot create temporary file %s",
+                 osFilename.c_str());
+        return false;
+    }
 
-            GIntBig *panNewFIDList = static_cast<GIntBig *>(VSI_REALLOC_VERBOSE(
-                panFIDList,
-                sizeof(GIntBig) * static_cast<size_t>(nNewFeaturesAlloc)));
-            if (panNewFIDList == nullptr)
-            {
-                FreeIndexFields(pasIndexFields, nIndexSize);
-                VSIFree(panFIDList);
-                nIndexSize = 0;
-                delete poSrcFeat;
-                return;
-            }
-            panFIDList = panNewFIDList;
+    // On Unix filesystems, you can remove a file even if it is opened
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    bMustUnlink = VSIUnlink(osFilename.c_str()) != 0;
+    CPLPopErrorHandler();
+    return true;
+}
 
-            memset(pasIndexFields + nFeaturesAlloc * nOrderItems, 0,
-                   sizeof(OGRField) * nOrderItems *
-                       static_cast<size_t>(nNewFeaturesAlloc - nFeaturesAlloc));
+/************************************************************************/
+/*                         TempFile::~TempFile()                        */
+/************************************************************************/
 
-            nFeaturesAlloc = static_cast<size_t>(nNewFeaturesAlloc);
-        }
+OGRGenSQLResultsLayer::TempFile::~TempFile()
+{
+    if (fp)
+        VSIFCloseL(fp);
+    if (bMustUnlink)
+        VSIUnlink(osFilename.c_str());
+}
 
-        ReadIndexFields(poSrcFeat, nOrderItems,
-                        pasIndexFields + nIndexSize * nOrderItems);
+/************************************************************************/
+/*                        SortIndexFieldsJob()                          */
+/************************************************************************/
 
-        panFIDList[nIndexSize] = poSrcFeat->GetFID();
-        delete poSrcFeat;
+void OGRGenSQLResultsLayer::SortIndexFieldsJob(void *pData)
+{
+    const auto psJob = static_cast<SortIndexFieldsJobData *>(pData);
+    const OGRGenSQLResultsLayer *poLayer = psJob->poLayer;
+    const OGRField *pasIndexFields = psJob->pasIndexFields;
+    const size_t nOrderItems = poLayer->m_aeOrderKeyTypes.size();
+    const auto oLess =
+        [poLayer, pasIndexFields, nOrderItems](size_t a, size_t b)
+    {
+        return poLayer->Compare(pasIndexFields + a * nOrderItems,
+                                pasIndexFields + b * nOrderItems) < 0;
+    };
+    if (psJob->panMiddle == nullptr)
+        std::stable_sort(psJob->panFirst, psJob->panLast, oLess);
+    else
+        std::inplace_merge(psJob->panFirst, psJob->panMiddle, psJob->panLast,
+                           oLess);
+}
 
-        nIndexSize++;
-    }
+/************************************************************************/
+/*                          SortIndexFields()                           */
+/*                                                                      */
+/*      Stable sort of the indices in anOrder according to the key      */
+/*      values they point to. Large arrays are split in slices sorted   */
+/*      in worker threads and then merged pairwise.                     */
+/************************************************************************/
 
-    // CPLDebug("GenSQL", "CreateOrderByIndex() = %d features", nIndexSize);
+void OGRGenSQLResultsLayer::SortIndexFields(const OGRField *pasIndexFields,
+                                            std::vector<size_t> &anOrder) const
+{
+    const size_t nEntries = anOrder.size();
+    if (nEntries < 2)
+        return;
 
-    /* -------------------------------------------------------------------- */
-    /*      Initialize panFIDIndex                                          */
-    /* -------------------------------------------------------------------- */
-    panFIDIndex = static_cast<GIntBig *>(
-        VSI_MALLOC_VERBOSE(sizeof(GIntBig) * nIndexSize));
-    if (panFIDIndex == nullptr)
+    constexpr size_t MIN_ENTRIES_PER_THREAD = 65536;
+    int nThreads = 1;
+    if (nEntries >= 2 * MIN_ENTRIES_PER_THREAD)
     {
-        FreeIndexFields(pasIndexFields, nIndexSize);
-        VSIFree(panFIDList);
-        nIndexSize = 0;
+        const char *pszNumThreads =
+            CPLGetConfigOption("GDAL_NUM_THREADS", "ALL_CPUS");
+        int nThreadsMax;
+        if (EQUAL(pszNumThreads, "ALL_CPUS"))
+            nThreadsMax = CPLGetNumCPUs();
+        else
+            nThreadsMax = std::max(1, atoi(pszNumThreads));
+        nThreads = static_cast<int>(
+            std::min(static_cast<size_t>(std::min(nThreadsMax, 128)),
+                     nEntries / MIN_ENTRIES_PER_THREAD));
+    }
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+
+    SortIndexFieldsJobData sJob;
+    sJob.poLayer = this;
+    sJob.pasIndexFields = pasIndexFields;
+    if (poPool == nullptr)
+    {
+        sJob.panFirst = anOrder.data();
+        sJob.panLast = anOrder.data() + nEntries;
+        SortIndexFieldsJob(&sJob);
         return;
     }
-    for (size_t i = 0; i < nIndexSize; i++)
-        panFIDIndex[i] = static_cast<GIntBig>(i);
 
-    /* -------------------------------------------------------------------- */
-    /*      Quick sort the records.                                         */
-    /* -------------------------------------------------------------------- */
+    auto poQueue = poPool->CreateJobQueue();
+    std::vector<size_t> anBounds;
+    std::vector<SortIndexFieldsJobData> asJobs;
+    for (int i = 0; i < nThreads; i++)
+    {
+        anBounds.push_back(nEntries / nThreads * i);
+        sJob.panFirst = anOrder.data() + anBounds.back();
+        sJob.panLast = anOrder.data() +
+                       (i + 1 == nThreads ? nEntries : nEntries / nThreads *
+                                                           (i + 1));
+        asJobs.push_back(sJob);
+    }
+    anBounds.push_back(nEntries);
+    for (auto &sSortJob : asJobs)
+        poQueue->SubmitJob(SortIndexFieldsJob, &sSortJob);
+    poQueue->WaitCompletion();
+
+    while (anBounds.size() > 2)
+    {
+        std::vector<size_t> anNewBounds;
+        asJobs.clear();
+        size_t i = 0;
+        for (; i + 2 < anBounds.size(); i += 2)
+        {
+            sJob.panFirst = anOrder.data() + anBounds[i];
+            sJob.panMiddle = anOrder.data() + anBounds[i + 1];
+            sJob.panLast = anOrder.data() + anBounds[i + 2];
+            asJobs.push_back(sJob);
+            anNewBounds.push_back(anBounds[i]);
+        }
+        if (i + 2 == anBounds.size())
+            anNewBounds.push_back(anBounds[i]);
+        anNewBounds.push_back(nEntries);
+        for (auto &sMergeJob : asJobs)
+            poQueue->SubmitJob(SortIndexFieldsJob, &sMergeJob);
+        poQueue->WaitCompletion();
+        anBounds = std::move(anNewBounds);
+    }
+}
+
+/************************************************************************/
+/*                          SpillIndexFields()                          */
+/************************************************************************/
 
-    GIntBig *panMerged = static_cast<GIntBig *>(
-        VSI_MALLOC_VERBOSE(sizeof(GIntBig) * nIndexSize));
-    if (panMerged == nullptr)
+// Writes the key values and FIDs, in the order given by anOrder, into a
+// new temporary run file.
+std::unique_ptr<OGRGenSQLResultsLayer::TempFile>
+OGRGenSQLResultsLayer::SpillIndexFields(const OGRField *pasIndexFields,
+                                        const GIntBig *panFIDList,
+                                        const std::vector<size_t> &anOrder)
+{
+    auto poRun = std::make_unique<TempFile>();
+    if (!poRun->Create())
+        return nullptr;
+
+    const size_t nOrderItems = m_aeOrderKeyTypes.size();
+    for (const size_t i : anOrder)
     {
-        FreeIndexFields(pasIndexFields, nIndexSize);
-        VSIFree(panFIDList);
-        nIndexSize = 0;
-        VSIFree(panFIDIndex);
-        panFIDIndex = nullptr;
-        return;
+        if (!WriteIndexRecord(poRun->fp, m_aeOrderKeyTypes,
+                              pasIndexFields + i * nOrderItems, panFIDList[i]))
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot write into %s",
+                     poRun->osFilename.c_str());
+            return nullptr;
+        }
     }
+    return poRun;
+}
 
-    SortIndexSection(pasIndexFields, panMerged, 0, nIndexSize);
-    VSIFree(panMerged);
+/************************************************************************/
+/*                             MergeRuns()                              */
+/*                                                                      */
+/*      K-way merge of the sorted runs apoRuns[nFirst, nLast[ into a    */
+/*      new run, or into a file of FIDs only if bFIDsOnly. The input    */
+/*      runs are released. bAlreadySorted is set to false if records    */
+/*      of the runs get interleaved.                                    */
+/************************************************************************/
 
-    /* -------------------------------------------------------------------- */
-    /*      Rework the FID map to map to real FIDs.                         */
-    /* -------------------------------------------------------------------- */
-    bool bAlreadySorted = true;
-    for (size_t i = 0; i < nIndexSize; i++)
+std::unique_ptr<OGRGenSQLResultsLayer::TempFile>
+OGRGenSQLResultsLayer::MergeRuns(
+    std::vector<std::unique_ptr<TempFile>> &apoRuns, size_t nFirst,
+    size_t nLast, bool bFIDsOnly, bool &bAlreadySorted)
+{
+    auto poOut = std::make_unique<TempFile>();
+    if (!poOut->Create())
+        return nullptr;
+
+    const size_t nOrderItems = m_aeOrderKeyTypes.size();
+    const size_t nRuns = nLast - nFirst;
+    std::vector<OrderByRunReader> aoReaders(nRuns);
+    std::vector<size_t> anHeap;
+    for (size_t i = 0; i < nRuns; i++)
+    {
+        OrderByRunReader &oReader = aoReaders[i];
+        oReader.fp = apoRuns[nFirst + i]->fp;
+        oReader.paeKeyTypes = &m_aeOrderKeyTypes;
+        oReader.asIndexFields.resize(nOrderItems);
+        oReader.aosStrings.resize(nOrderItems);
+        if (VSIFSeekL(oReader.fp, 0, SEEK_SET) != 0)
+            oReader.bError = true;
+        else if (oReader.Next())
+            anHeap.push_back(i);
+        if (oReader.bError)
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot read %s",
+                     apoRuns[nFirst + i]->osFilename.c_str());
+            return nullptr;
+        }
+    }
+
+    // The heap front is the run with the smallest current record. Ties are
+    // resolved by taking the first run, so that the sort is stable.
+    const auto oGreater = [this, &aoReaders](size_t a, size_t b)
+    {
+        const int nResult = Compare(aoReaders[a].asIndexFields.data(),
+                                    aoReaders[b].asIndexFields.data());
+        return nResult > 0 || (nResult == 0 && a > b);
+    };
+    std::make_heap(anHeap.begin(), anHeap.end(), oGreater);
+
+    std::vector<GIntBig> anFIDBuffer;
+    constexpr size_t FID_BUFFER_SIZE = 65536;
+    const auto FlushFIDBuffer = [&anFIDBuffer, &poOut]()
+    {
+        const bool bOK =
+            VSIFWriteL(anFIDBuffer.data(), sizeof(GIntBig), anFIDBuffer.size(),
+                       poOut->fp) == anFIDBuffer.size();
+        anFIDBuffer.clear();
+        return bOK;
+    };
+
+    size_t iLastRun = 0;
+    while (!anHeap.empty())
     {
-        if (panFIDIndex[i] != static_cast<GIntBig>(i))
+        std::pop_heap(anHeap.begin(), anHeap.end(), oGreater);
+        const size_t iRun = anHeap.back();
+        OrderByRunReader &oReader = aoReaders[iRun];
+        if (iRun < iLastRun)
             bAlreadySorted = false;
-        panFIDIndex[i] = panFIDList[panFIDIndex[i]];
-    }
+        iLastRun = iRun;
 
-    CPLFree(panFIDList);
-    FreeIndexFields(pasIndexFields, nIndexSize);
+        bool bOK = true;
+        if (bFIDsOnly)
+        {
+            anFIDBuffer.push_back(oReader.nFID);
+            if (anFIDBuffer.size() == FID_BUFFER_SIZE)
+                bOK = FlushFIDBuffer();
+        }
+        else
+        {
+            bOK = WriteIndexRecord(poOut->fp, m_aeOrderKeyTypes,
+                                   oReader.asIndexFields.data(), oReader.nFID);
+        }
+        if (!bOK)
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot write into %s",
+                     poOut->osFilename.c_str());
+            return nullptr;
+        }
 
-    /* If it is already sorted, then free than panFIDIndex array */
-    /* so that GetNextFeature() can call a sequential GetNextFeature() */
-    /* on the source array. Very useful for layers where random access */
-    /* is slow. */
-    /* Use case: the GML result of a WFS GetFeature with a SORTBY */
-    if (bAlreadySorted)
+        if (oReader.Next())
+        {
+            std::push_heap(anHeap.begin(), anHeap.end(), oGreater);
+        }
+        else if (oReader.bError)
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot read %s",
+                     apoRuns[nFirst + iRun]->osFilename.c_str());
+            return nullptr;
+        }
+        else
+        {
+            anHeap.pop_back();
+        }
+    }
+    if (!anFIDBuffer.empty() && !FlushFIDBuffer())
     {
-        CPLFree(panFIDIndex);
-        panFIDIndex = nullptr;
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot write into %s",
+                 poOut->osFilename.c_str());
+        return nullptr;
+    }
 
-        nIndexSize = 0;
+    for (size_t i = nFirst; i < nLast; i++)
+        apoRuns[i].reset();
+
+    return poOut;
+}
+
+/************************************************************************/
+/*                          HasOrderByIndex()                           */
+/************************************************************************/
+
+bool OGRGenSQLResultsLayer::HasOrderByIndex() const
+{
+    return panFIDIndex != nullptr || m_poSortedFIDsFile != nullptr;
+}
+
+/************************************************************************/
+/*                         GetOrderByIndexFID()                         */
+/************************************************************************/
+
+// Returns the FID of the source feature at index nIdx of the ORDER BY index.
+bool OGRGenSQLResultsLayer::GetOrderByIndexFID(GIntBig nIdx, GIntBig &nFID)
+{
+    if (nIdx < 0)
+        return false;
+
+    if (panFIDIndex != nullptr)
+    {
+        if (nIdx >= static_cast<GIntBig>(nIndexSize))
+            return false;
+        nFID = panFIDIndex[nIdx];
+        return true;
     }
 
-    ResetReading();
+    if (m_poSortedFIDsFile == nullptr ||
+        static_cast<GUIntBig>(nIdx) >= m_nSortedFIDsCount)
+        return false;
+    VSILFILE *fp = m_poSortedFIDsFile->fp;
+    if (static_cast<GUIntBig>(nIdx) != m_nSortedFIDsFileIdx &&
+        VSIFSeekL(fp, static_cast<vsi_l_offset>(nIdx) * sizeof(GIntBig),
+                  SEEK_SET) != 0)
+    {
+        m_nSortedFIDsFileIdx = std::numeric_limits<GUIntBig>::max();
+        return false;
+    }
+    if (VSIFReadL(&nFID, sizeof(nFID), 1, fp) != 1)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot read %s",
+                 m_poSortedFIDsFile->osFilename.c_str());
+        m_nSortedFIDsFileIdx = std::numeric_limits<GUIntBig>::max();
+        return false;
+    }
+    m_nSortedFIDsFileIdx = static_cast<GUIntBig>(nIdx) + 1;
+    return true;
 }
 
 /************************************************************************/
-/*                          SortIndexSection()                          */
+/*                       CreateTopNOrderByIndex()                       */
 /*                                                                      */
-/*      Sort the records in a section of the index.                     */
+/*      ORDER BY ... LIMIT N [OFFSET M] case: only the first N + M      */
+/*      features are needed, which are collected in a bounded           */
+/*      max-heap instead of sorting the whole layer.                    */
 /************************************************************************/
 
-void OGRGenSQLResultsLayer::SortIndexSection(const OGRField *pasIndexFields,
-                                             GIntBig *panMerged, size_t nStart,
-                                             size_t nEntries)
-
+void OGRGenSQLResultsLayer::CreateTopNOrderByIndex(size_t nTopN)
 {
-    if (nEntries < 2)
+    panFIDIndex = nullptr;
+    nIndexSize = 0;
+    if (nTopN == 0)
         return;
 
+    const size_t nOrderItems = m_aeOrderKeyTypes.size();
+    std::vector<OGRField> asIndexFields;
+    std::vector<GIntBig> anFIDList;
+    // Rank of the feature in the source layer, to keep the sort stable
+    std::vector<GUIntBig> anSeq;
+    std::vector<size_t> anHeap;
+    std::vector<OGRField> asCurrentFields(nOrderItems);
+
+    // The heap front is the greatest of the kept features
+    const auto oLess = [this, &asIndexFields, &anSeq, nOrderItems](size_t a,
+                                                                    size_t b)
+    {
+        const int nResult = Compare(asIndexFields.data() + a * nOrderItems,
+                                    asIndexFields.data() + b * nOrderItems);
+        return nResult < 0 || (nResult == 0 && anSeq[a] < anSeq[b]);
+    };
+
+    GUIntBig nSeq = 0;
+    OGRFeature *poSrcFeat = nullptr;
+    while ((poSrcFeat = poSrcLayer->GetNextFeature()) != nullptr)
+    {
+        memset(asCurrentFields.data(), 0, sizeof(OGRField) * nOrderItems);
+        ReadIndexFields(poSrcFeat, static_cast<int>(nOrderItems),
+                        asCurrentFields.data());
+        const GIntBig nFID = poSrcFeat->GetFID();
+        delete poSrcFeat;
+
+        size_t iSlot;
+        if (anHeap.size() < nTopN)
+        {
+            iSlot = anHeap.size();
+            asIndexFields.insert(asIndexFields.end(), asCurrentFields.begin(),
+                                 asCurrentFields.end());
+            anFIDList.push_back(nFID);
+            anSeq.push_back(nSeq);
+        }
+        else
+        {
+            // Ties with the greatest kept feature are discarded, since the
+            // current feature comes after it.
+            if (Compare(asCurrentFields.data(),
+                        asIndexFields.data() + anHeap.front() * nOrderItems) >=
+                0)
+            {
+                FreeIndexFields(asCurrentFields.data(), 1, false);
+                nSeq++;
+                continue;
+            }
+            std::pop_heap(anHeap.begin(), anHeap.end(), oLess);
+            iSlot = anHeap.back();
+            anHeap.pop_back();
+            FreeIndexFields(asIndexFields.data() + iSlot * nOrderItems, 1,
+                            false);
+            memcpy(asIndexFields.data() + iSlot * nOrderItems,
+                   asCurrentFields.data(), sizeof(OGRField) * nOrderItems);
+            anFIDList[iSlot] = nFID;
+            anSeq[iSlot] = nSeq;
+        }
+        anHeap.push_back(iSlot);
+        std::push_heap(anHeap.begin(), anHeap.end(), oLess);
+        nSeq++;
+    }
+
+    std::sort_heap(anHeap.begin(), anHeap.end(), oLess);
+
+    FreeIndexFields(asIndexFields.data(), anFIDList.size(), false);
+
+    if (anHeap.empty())
+        return;
+    panFIDIndex =
+        static_cast<GIntBig *>(CPLMalloc(sizeof(GIntBig) * anHeap.size()));
+    for (size_t i = 0; i < anHeap.size(); i++)
+        panFIDIndex[i] = anFIDList[anHeap[i]];
+    nIndexSize = anHeap.size();
+}
+
+/************************************************************************/
+/*                         CreateOrderByIndex()                         */
+/*                                                                      */
+/*      This method is responsible for creating an index providing      */
+/*      ordered access to the features according to the supplied        */
+/*      ORDER BY clauses.                                               */
+/*                                                                      */
+/*      This is accomplished by making one pass through all the         */
+/*      eligible source features, and capturing the order by fields     */
+/*      of all records in memory.  A merge sort is then applied to      */
+/*      this in memory copy of the order-by fields to create the        */
+/*      required index.                                                 */
+/*                                                                      */
+/*      When the key values do not fit within OGR_SQL_SORT_MAX_MEMORY,  */
+/*      sorted runs are written to temporary files and merged into a    */
+/*      temporary file of sorted FIDs.                                  */
+/************************************************************************/
+
+void OGRGenSQLResultsLayer::CreateOrderByIndex()
+
+{
     swq_select *psSelectInfo = static_cast<swq_select *>(pSelectInfo);
     const int nOrderItems = psSelectInfo->order_specs;
 
-    size_t nFirstGroup = nEntries / 2;
-    size_t nFirstStart = nStart;
-    size_t nSecondGroup = nEntries - nFirstGroup;
-    size_t nSecondStart = nStart + nFirstGroup;
+    if (!(nOrderItems > 0 && psSelectInfo->query_mode == SWQM_RECORDSET))
+        return;
 
-    SortIndexSection(pasIndexFields, panMerged, nFirstStart, nFirstGroup);
-    SortIndexSection(pasIndexFields, panMerged, nSecondStart, nSecondGroup);
+    if (bOrderByValid)
+        return;
 
-    for (size_t iMerge = 0; iMerge < nEntries; ++iMerge)
-    {
-        int nResult = 0;
+    bOrderByValid = TRUE;
 
-        if (nFirstGroup == 0)
-            nResult = 1;
-        else if (nSecondGroup == 0)
-            nResult = -1;
+    ResetReading();
+
+    /* -------------------------------------------------------------------- */
+    /*      Establish the type of the key values.                           */
+    /* -------------------------------------------------------------------- */
+    m_aeOrderKeyTypes.clear();
+    for (int iKey = 0; iKey < nOrderItems; iKey++)
+    {
+        const swq_order_def *psKeyDef = psSelectInfo->order_defs + iKey;
+        if (psKeyDef->field_index >= iFIDFieldIndex)
+        {
+            CPLAssert(psKeyDef->field_index <
+                      iFIDFieldIndex + SPECIAL_FIELD_COUNT);
+            // This is consistent with what is done in ReadIndexFields()
+            switch (SpecialFieldTypes[psKeyDef->field_index - iFIDFieldIndex])
+            {
+                case SWQ_INTEGER:
+                case SWQ_INTEGER64:
+                    m_aeOrderKeyTypes.push_back(OFTInteger64);
+                    break;
+                case SWQ_FLOAT:
+                    m_aeOrderKeyTypes.push_back(OFTReal);
+                    break;
+                default:
+                    m_aeOrderKeyTypes.push_back(OFTString);
+                    break;
+            }
+        }
         else
-            nResult = Compare(
-                pasIndexFields + panFIDIndex[nFirstStart] * nOrderItems,
-                pasIndexFields + panFIDIndex[nSecondStart] * nOrderItems);
+        {
+            OGRFieldDefn *poFDefn =
+                poSrcLayer->GetLayerDefn()->GetFieldDefn(psKeyDef->field_index);
+            m_aeOrderKeyTypes.push_back(poFDefn->GetType());
+        }
+    }
 
-        if (nResult > 0)
+    const size_t nMaxMemory = GetMaxMemory("OGR_SQL_SORT_MAX_MEMORY");
+    const size_t nEntrySize =
+        sizeof(OGRField) * nOrderItems + sizeof(GIntBig) + 2 * sizeof(size_t);
+
+    /* -------------------------------------------------------------------- */
+    /*      Optimize ORDER BY ... LIMIT N [OFFSET M] case.                  */
+    /* -------------------------------------------------------------------- */
+    if (psSelectInfo->limit >= 0 &&
+        psSelectInfo->offset <=
+            std::numeric_limits<GIntBig>::max() - psSelectInfo->limit &&
+        static_cast<GUIntBig>(psSelectInfo->offset + psSelectInfo->limit) <=
+            nMaxMemory / nEntrySize)
+    {
+        CreateTopNOrderByIndex(
+            static_cast<size_t>(psSelectInfo->offset + psSelectInfo->limit));
+        return;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Read in the key values, spilling sorted runs to temporary       */
+    /*      files when they exceed the memory limit.                        */
+    /* -------------------------------------------------------------------- */
+    std::vector<OGRField> asIndexFields;
+    std::vector<GIntBig> anFIDList;
+    std::vector<std::unique_ptr<TempFile>> apoRuns;
+    size_t nRunMemory = 0;
+    GUIntBig nTotalFeatures = 0;
+    bool bAlreadySorted = true;
+
+    panFIDIndex = nullptr;
+    nIndexSize = 0;
+
+    const auto SortRun = [this, &asIndexFields, &anFIDList, &bAlreadySorted]()
+    {
+        std::vector<size_t> anOrder(anFIDList.size());
+        for (size_t i = 0; i < anOrder.size(); i++)
+            anOrder[i] = i;
+        SortIndexFields(asIndexFields.data(), anOrder);
+        for (size_t i = 0; bAlreadySorted && i < anOrder.size(); i++)
+        {
+            if (anOrder[i] != i)
+                bAlreadySorted = false;
+        }
+        return anOrder;
+    };
+
+    const auto SpillRun = [this, &asIndexFields, &anFIDList, &apoRuns,
+                           &nRunMemory, &SortRun]()
+    {
+        auto poRun =
+            SpillIndexFields(asIndexFields.data(), anFIDList.data(), SortRun());
+        FreeIndexFields(asIndexFields.data(), anFIDList.size(), false);
+        asIndexFields.clear();
+        anFIDList.clear();
+        nRunMemory = 0;
+        if (poRun == nullptr)
+            return false;
+        apoRuns.push_back(std::move(poRun));
+        return true;
+    };
+
+    try
+    {
+        OGRFeature *poSrcFeat = nullptr;
+        while ((poSrcFeat = poSrcLayer->GetNextFeature()) != nullptr)
         {
-            panMerged[iMerge] = panFIDIndex[nSecondStart];
-            nSecondStart++;
-            nSecondGroup--;
+            const size_t nOffset = asIndexFields.size();
+            asIndexFields.resize(nOffset + nOrderItems);
+            memset(asIndexFields.data() + nOffset, 0,
+                   sizeof(OGRField) * nOrderItems);
+            ReadIndexFields(poSrcFeat, nOrderItems,
+                            asIndexFields.data() + nOffset);
+            anFIDList.push_back(poSrcFeat->GetFID());
+            delete poSrcFeat;
+            nTotalFeatures++;
+
+            nRunMemory += nEntrySize + GetIndexFieldsMemory(
+                                           asIndexFields.data() + nOffset);
+            if (nRunMemory > nMaxMemory && !SpillRun())
+            {
+                ResetReading();
+                return;
+            }
+        }
+
+        if (apoRuns.empty())
+        {
+            /* ------------------------------------------------------------ */
+            /*      Everything fits in memory: sort the records.            */
+            /* ------------------------------------------------------------ */
+            const auto anOrder = SortRun();
+            FreeIndexFields(asIndexFields.data(), anFIDList.size(), false);
+
+            /* If it is already sorted, then do not create panFIDIndex */
+            /* so that GetNextFeature() can call a sequential */
+            /* GetNextFeature() on the source array. Very useful for */
+            /* layers where random access is slow. */
+            /* Use case: the GML result of a WFS GetFeature with a SORTBY */
+            if (!bAlreadySorted)
+            {
+                panFIDIndex = static_cast<GIntBig *>(
+                    VSI_MALLOC_VERBOSE(sizeof(GIntBig) * anOrder.size()));
+                if (panFIDIndex != nullptr)
+                {
+                    for (size_t i = 0; i < anOrder.size(); i++)
+                        panFIDIndex[i] = anFIDList[anOrder[i]];
+                    nIndexSize = anOrder.size();
+                }
+            }
         }
         else
         {
-            panMerged[iMerge] = panFIDIndex[nFirstStart];
-            nFirstStart++;
-            nFirstGroup--;
+            /* ------------------------------------------------------------ */
+            /*      Merge the sorted runs, with a bounded number of opened  */
+            /*      files at a time.                                        */
+            /* ------------------------------------------------------------ */
+            if (!anFIDList.empty() && !SpillRun())
+            {
+                ResetReading();
+                return;
+            }
+            const size_t nRuns = apoRuns.size();
+
+            constexpr size_t MAX_MERGED_RUNS = 64;
+            while (apoRuns.size() > MAX_MERGED_RUNS)
+            {
+                std::vector<std::unique_ptr<TempFile>> apoMergedRuns;
+                for (size_t i = 0; i < apoRuns.size(); i += MAX_MERGED_RUNS)
+                {
+                    const size_t nLast =
+                        std::min(i + MAX_MERGED_RUNS, apoRuns.size());
+                    auto poRun =
+                        MergeRuns(apoRuns, i, nLast, false, bAlreadySorted);
+                    if (poRun == nullptr)
+                    {
+                        ResetReading();
+                        return;
+                    }
+                    apoMergedRuns.push_back(std::move(poRun));
+                }
+                apoRuns = std::move(apoMergedRuns);
+            }
+
+            auto poSortedFIDsFile =
+                MergeRuns(apoRuns, 0, apoRuns.size(), true, bAlreadySorted);
+            if (poSortedFIDsFile != nullptr && !bAlreadySorted)
+            {
+                m_poSortedFIDsFile = std::move(poSortedFIDsFile);
+                m_nSortedFIDsCount = nTotalFeatures;
+                m_nSortedFIDsFileIdx = nTotalFeatures;
+            }
+
+            CPLDebug("GenSQL",
+                     "ORDER BY: " CPL_FRMT_GUIB " features sorted with "
+                     "%d runs in temporary files",
+                     nTotalFeatures, static_cast<int>(nRuns));
         }
     }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot create ORDER BY index: %s", e.what());
+        FreeIndexFields(asIndexFields.data(), anFIDList.size(), false);
+        CPLFree(panFIDIndex);
+        panFIDIndex = nullptr;
+        nIndexSize = 0;
+    }
 
-    /* Copy the merge list back into the main index */
-    memcpy(panFIDIndex + nStart, panMerged, sizeof(GIntBig) * nEntries);
+    ResetReading();
 }
 
 /************************************************************************/
@@ -2243,22 +3431,17 @@ template <class T> static inline int ComparePrimitive(const T &a, const T &b)
 /************************************************************************/
 
 int OGRGenSQLResultsLayer::Compare(const OGRField *pasFirstTuple,
-                                   const OGRField *pasSecondTuple)
+                                   const OGRField *pasSecondTuple) const
 
 {
-    swq_select *psSelectInfo = static_cast<swq_select *>(pSelectInfo);
+    const swq_select *psSelectInfo =
+        static_cast<const swq_select *>(pSelectInfo);
     int nResult = 0, iKey;
 
     for (iKey = 0; nResult == 0 && iKey < psSelectInfo->order_specs; iKey++)
     {
-        swq_order_def *psKeyDef = psSelectInfo->order_defs + iKey;
-        OGRFieldDefn *poFDefn = nullptr;
-
-        if (psKeyDef->field_index >= iFIDFieldIndex)
-            poFDefn = nullptr;
-        else
-            poFDefn =
-                poSrcLayer->GetLayerDefn()->GetFieldDefn(psKeyDef->field_index);
+        const swq_order_def *psKeyDef = psSelectInfo->order_defs + iKey;
+        const OGRFieldType eType = m_aeOrderKeyTypes[iKey];
 
         if (OGR_RawField_IsUnset(&pasFirstTuple[iKey]) ||
             OGR_RawField_IsNull(&pasFirstTuple[iKey]))
@@ -2274,56 +3457,27 @@ int OGRGenSQLResultsLayer::Compare(const OGRField *pasFirstTuple,
         {
             nResult = 1;
         }
-        else if (poFDefn == nullptr)
-        {
-            CPLAssert(psKeyDef->field_index <
-                      iFIDFieldIndex + SPECIAL_FIELD_COUNT);
-            switch (SpecialFieldTypes[psKeyDef->field_index - iFIDFieldIndex])
-            {
-                case SWQ_INTEGER:
-                    // Yes, read Integer in Integer64.
-                    // This is consistent with what is done ReadIndexFields()
-                case SWQ_INTEGER64:
-                    nResult = ComparePrimitive(pasFirstTuple[iKey].Integer64,
-                                               pasSecondTuple[iKey].Integer64);
-                    break;
-                case SWQ_FLOAT:
-                    nResult = ComparePrimitive(pasFirstTuple[iKey].Real,
-                                               pasSecondTuple[iKey].Real);
-                    break;
-                case SWQ_STRING:
-                    nResult = strcmp(pasFirstTuple[iKey].String,
-                                     pasSecondTuple[iKey].String);
-                    break;
-
-                default:
-                    CPLAssert(false);
-                    nResult = 0;
-            }
-        }
-        else if (poFDefn->GetType() == OFTInteger)
+        else if (eType == OFTInteger)
         {
             nResult = ComparePrimitive(pasFirstTuple[iKey].Integer,
                                        pasSecondTuple[iKey].Integer);
         }
-        else if (poFDefn->GetType() == OFTInteger64)
+        else if (eType == OFTInteger64)
         {
             nResult = ComparePrimitive(pasFirstTuple[iKey].Integer64,
                                        pasSecondTuple[iKey].Integer64);
         }
-        else if (poFDefn->GetType() == OFTString)
+        else if (eType == OFTString)
         {
             nResult =
                 strcmp(pasFirstTuple[iKey].String, pasSecondTuple[iKey].String);
         }
-        else if (poFDefn->GetType() == OFTReal)
+        else if (eType == OFTReal)
         {
             nResult = ComparePrimitive(pasFirstTuple[iKey].Real,
                                        pasSecondTuple[iKey].Real);
         }
-        else if (poFDefn->GetType() == OFTDate ||
-                 poFDefn->GetType() == OFTTime ||
-                 poFDefn->GetType() == OFTDateTime)
+        else if (eType == OFTDate || eType == OFTTime || eType == OFTDateTime)
         {
             nResult =
                 OGRCompareDate(&pasFirstTuple[iKey], &pasSecondTuple[iKey]);
@@ -2411,6 +3565,11 @@ void OGRGenSQLResultsLayer::FindAndSetIgnoredFields()
                           hSet);
     }
 
+    for (const auto &oGroupDef : psSelectInfo->group_defs)
+    {
+        AddFieldDefnToSet(oGroupDef.table_index, oGroupDef.field_index, hSet);
+    }
+
     /* -------------------------------------------------------------------- */
     /*      2nd phase : now, we can exclude the unused fields               */
     /* -------------------------------------------------------------------- */
@@ -2450,6 +3609,8 @@ void OGRGenSQLResultsLayer::InvalidateOrderByIndex()
     panFIDIndex = nullptr;
 
     nIndexSize = 0;
+    m_poSortedFIDsFile.reset();
+    m_nSortedFIDsCount = 0;
     bOrderByValid = FALSE;
 }
 
@@ -36,6 +36,9 @@
 #include "cpl_hash_set.h"
 #include "cpl_string.h"
 
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 /*! @cond Doxygen_Suppress */
@@ -87,17 +90,87 @@ class OGRGenSQLResultsLayer final : public OGRLayer
     GIntBig nIteratedFeatures;
     std::vector<CPLString> m_oDistinctList;
 
+    // In-memory index of the secondary layer of a JOIN whose ON clause is
+    // made of equality tests between fields of the primary and secondary
+    // layers.
+    struct JoinHashTable
+    {
+        enum class KeyType
+        {
+            INTEGER,
+            REAL,
+            STRING
+        };
+
+        std::vector<int> anPrimaryFields{};
+        std::vector<int> anSecondaryFields{};
+        std::vector<KeyType> aeKeyTypes{};
+        std::unordered_map<std::string, std::unique_ptr<OGRFeature>> oMap{};
+
+        bool BuildKey(OGRFeature *poFeature, bool bPrimary,
+                      std::string &osKey) const;
+    };
+
+    // One entry per join. nullptr when the join is resolved by setting an
+    // attribute filter on the secondary layer for each primary feature.
+    std::vector<std::unique_ptr<JoinHashTable>> m_apoJoinHashTables{};
+    bool m_bJoinHashTablesBuilt = false;
+
+    std::vector<std::unique_ptr<OGRFeature>> m_apoGroupByFeatures{};
+    bool m_bGroupByPrepared = false;
+
+    // Temporary file, removed on destruction.
+    struct TempFile
+    {
+        VSILFILE *fp = nullptr;
+        std::string osFilename{};
+        bool bMustUnlink = false;
+
+        TempFile() = default;
+        ~TempFile();
+        TempFile(const TempFile &) = delete;
+        TempFile &operator=(const TempFile &) = delete;
+
+        bool Create();
+    };
+
+    // Type of each ORDER BY key, as stored in the OGRField of the index.
+    std::vector<OGRFieldType> m_aeOrderKeyTypes{};
+
+    // Sorted FIDs of an ORDER BY index that did not fit in memory, used
+    // instead of panFIDIndex.
+    std::unique_ptr<TempFile> m_poSortedFIDsFile{};
+    GUIntBig m_nSortedFIDsCount = 0;
+    GUIntBig m_nSortedFIDsFileIdx = 0;
+
     int PrepareSummary();
+    int PrepareGroupBy();
+    bool IsGeometryNeededForSummary();
+
+    void BuildJoinHashTables();
+    std::unique_ptr<JoinHashTable> BuildJoinHashTable(int iJoin,
+                                                      size_t &nMemoryUsed);
 
     OGRFeature *TranslateFeature(OGRFeature *);
     void CreateOrderByIndex();
+    void CreateTopNOrderByIndex(size_t nTopN);
     void ReadIndexFields(OGRFeature *poSrcFeat, int nOrderItems,
                          OGRField *pasIndexFields);
-    void SortIndexSection(const OGRField *pasIndexFields, GIntBig *panMerged,
-                          size_t nStart, size_t nEntries);
+    size_t GetIndexFieldsMemory(const OGRField *pasIndexFields) const;
+    void SortIndexFields(const OGRField *pasIndexFields,
+                         std::vector<size_t> &anOrder) const;
+    static void SortIndexFieldsJob(void *pData);
+    std::unique_ptr<TempFile>
+    SpillIndexFields(const OGRField *pasIndexFields, const GIntBig *panFIDList,
+                     const std::vector<size_t> &anOrder);
+    std::unique_ptr<TempFile>
+    MergeRuns(std::vector<std::unique_ptr<TempFile>> &apoRuns, size_t nFirst,
+              size_t nLast, bool bFIDsOnly, bool &bAlreadySorted);
+    bool HasOrderByIndex() const;
+    bool GetOrderByIndexFID(GIntBig nIdx, GIntBig &nFID);
     void FreeIndexFields(OGRField *pasIndexFields, size_t l_nIndexSize,
                          bool bFreeArray = true);
-    int Compare(const OGRField *pasFirst, const OGRField *pasSecond);
+    int Compare(const OGRField *pasFirst, const OGRField *pasSecond) const;
 
     void ClearFilters();
     void ApplyFiltersToSource();
@@ -0,0 +1,403 @@
+/******************************************************************************
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  Grid based classification of large polygonal spatial filters
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ogrlayer_private.h"
+#include "ogr_api.h"
+
+#include "cpl_conv.h"
+
+#include <algorithm>
+#include <cmath>
+
+//! @cond Doxygen_Suppress
+
+// Minimum number of vertices of the filter geometry for the grid to be built
+constexpr int MIN_VERTICES_FOR_GRID = 1000;
+
+// Bounds of the number of cells along the largest dimension of the grid
+constexpr int MIN_CELLS_PER_DIM = 32;
+constexpr int MAX_CELLS_PER_DIM = 512;
+
+// Maximum number of cells looked up by ClassifyEnvelope()
+constexpr int MAX_CELLS_IN_ENVELOPE = 4096;
+
+/************************************************************************/
+/*                       CountPolygonalVertices()                       */
+/************************************************************************/
+
+static int CountPolygonalVertices(const OGRPolygon *poPoly)
+{
+    int nPoints = 0;
+    for (const auto *poRing : *poPoly)
+        nPoints += poRing->getNumPoints();
+    return nPoints;
+}
+
+/************************************************************************/
+/*                               Build()                                */
+/************************************************************************/
+
+/** Build a grid for the filter geometry, if it is worth it.
+ *
+ * Only polygonal filters with at least MIN_VERTICES_FOR_GRID vertices are
+ * considered, as GEOS prepared geometries are fast enough on simpler ones.
+ *
+ * @return the grid, or nullptr.
+ */
+std::unique_ptr<OGRFilterGeometryGrid>
+OGRFilterGeometryGrid::Build(const OGRGeometry *poFilterGeom,
+                             OGRPreparedGeometry *poPreparedFilterGeom)
+{
+    if (poPreparedFilterGeom == nullptr ||
+        !CPLTestBool(CPLGetConfigOption("OGR_SPATIAL_FILTER_GRID", "YES")))
+    {
+        return nullptr;
+    }
+
+    const auto eType = wkbFlatten(poFilterGeom->getGeometryType());
+    int nPoints = 0;
+    if (eType == wkbPolygon)
+    {
+        nPoints = CountPolygonalVertices(poFilterGeom->toPolygon());
+    }
+    else if (eType == wkbMultiPolygon)
+    {
+        for (const auto *poPoly : *(poFilterGeom->toMultiPolygon()))
+            nPoints += CountPolygonalVertices(poPoly);
+    }
+    else
+    {
+        return nullptr;
+    }
+    if (nPoints < MIN_VERTICES_FOR_GRID)
+        return nullptr;
+
+    OGREnvelope sEnvelope;
+    poFilterGeom->getEnvelope(&sEnvelope);
+    const double dfWidth = sEnvelope.MaxX - sEnvelope.MinX;
+    const double dfHeight = sEnvelope.MaxY - sEnvelope.MinY;
+    if (!(dfWidth > 0) || !(dfHeight > 0))
+        return nullptr;
+
+    const int nCellsPerDim =
+        std::max(MIN_CELLS_PER_DIM,
+                 std::min(MAX_CELLS_PER_DIM,
+                          static_cast<int>(std::sqrt(double(nPoints)))));
+
+    auto poGrid = std::unique_ptr<OGRFilterGeometryGrid>(
+        new OGRFilterGeometryGrid());
+    poGrid->m_dfMinX = sEnvelope.MinX;
+    poGrid->m_dfMinY = sEnvelope.MinY;
+    poGrid->m_dfCellSize = std::max(dfWidth, dfHeight) / nCellsPerDim;
+    poGrid->m_dfEps = poGrid->m_dfCellSize * 1e-6;
+    poGrid->m_nCellsX = std::max(
+        1, std::min(nCellsPerDim, static_cast<int>(std::ceil(
+                                      dfWidth / poGrid->m_dfCellSize))));
+    poGrid->m_nCellsY = std::max(
+        1, std::min(nCellsPerDim, static_cast<int>(std::ceil(
+                                      dfHeight / poGrid->m_dfCellSize))));
+    poGrid->m_abyCells.resize(static_cast<size_t>(poGrid->m_nCellsX) *
+                                  poGrid->m_nCellsY,
+                              CELL_UNKNOWN);
+
+    // Flag cells crossed by the boundary of the filter geometry
+    if (!poGrid->MarkBoundary(poFilterGeom))
+        return nullptr;
+
+    // Cells of a connected set of cells not crossed by the boundary are all
+    // either inside or outside the filter geometry: a single point in
+    // polygon test per set is needed.
+    std::vector<int> anStack;
+    OGRPoint oPoint;
+    const int nCellsX = poGrid->m_nCellsX;
+    const int nCellsY = poGrid->m_nCellsY;
+    for (int iCell = 0; iCell < nCellsX * nCellsY; ++iCell)
+    {
+        if (poGrid->m_abyCells[iCell] != CELL_UNKNOWN)
+            continue;
+        oPoint.setX(poGrid->m_dfMinX +
+                    ((iCell % nCellsX) + 0.5) * poGrid->m_dfCellSize);
+        oPoint.setY(poGrid->m_dfMinY +
+                    ((iCell / nCellsX) + 0.5) * poGrid->m_dfCellSize);
+        const GByte nStatus =
+            OGRPreparedGeometryContains(poPreparedFilterGeom,
+                                        OGRGeometry::ToHandle(&oPoint))
+                ? CELL_INSIDE
+                : CELL_OUTSIDE;
+
+        poGrid->m_abyCells[iCell] = nStatus;
+        anStack.push_back(iCell);
+        while (!anStack.empty())
+        {
+            const int iCur = anStack.back();
+            anStack.pop_back();
+            const int iX = iCur % nCellsX;
+            const int iY = iCur / nCellsX;
+            const auto Visit = [&](int iNeighbour)
+            {
+                if (poGrid->m_abyCells[iNeighbour] == CELL_UNKNOWN)
+                {
+                    poGrid->m_abyCells[iNeighbour] = nStatus;
+                    anStack.push_back(iNeighbour);
+                }
+            };
+            if (iX > 0)
+                Visit(iCur - 1);
+            if (iX + 1 < nCellsX)
+                Visit(iCur + 1);
+            if (iY > 0)
+                Visit(iCur - nCellsX);
+            if (iY + 1 < nCellsY)
+                Visit(iCur + nCellsX);
+        }
+    }
+
+    return poGrid;
+}
+
+/************************************************************************/
+/*                             GetCellX()                               */
+/************************************************************************/
+
+int OGRFilterGeometryGrid::GetCellX(double dfX) const
+{
+    const double dfCell = (dfX - m_dfMinX) / m_dfCellSize;
+    if (!(dfCell >= 0))
+        return 0;
+    if (dfCell >= m_nCellsX)
+        return m_nCellsX - 1;
+    return static_cast<int>(dfCell);
+}
+
+/************************************************************************/
+/*                             GetCellY()                               */
+/************************************************************************/
+
+int OGRFilterGeometryGrid::GetCellY(double dfY) const
+{
+    const double dfCell = (dfY - m_dfMinY) / m_dfCellSize;
+    if (!(dfCell >= 0))
+        return 0;
+    if (dfCell >= m_nCellsY)
+        return m_nCellsY - 1;
+    return static_cast<int>(dfCell);
+}
+
+/************************************************************************/
+/*                            MarkSegment()                             */
+/************************************************************************/
+
+// Flag all cells crossed by a segment, column of cells by column of cells.
+// Cells are slightly enlarged, so that a segment running along the edge
+// between two cells flags both of them.
+void OGRFilterGeometryGrid::MarkSegment(double dfX1, double dfY1, double dfX2,
+                                        double dfY2)
+{
+    const double dfSegMinX = std::min(dfX1, dfX2);
+    const double dfSegMaxX = std::max(dfX1, dfX2);
+    const int iX0 = GetCellX(dfSegMinX - m_dfEps);
+    const int iX1 = GetCellX(dfSegMaxX + m_dfEps);
+    for (int iX = iX0; iX <= iX1; ++iX)
+    {
+        const double dfXA = std::max(
+            dfSegMinX, std::min(dfSegMaxX, m_dfMinX + iX * m_dfCellSize));
+        const double dfXB = std::max(
+            dfSegMinX,
+            std::min(dfSegMaxX, m_dfMinX + (iX + 1) * m_dfCellSize));
+        double dfYA;
+        double dfYB;
+        if (dfX1 == dfX2)
+        {
+            dfYA = dfY1;
+            dfYB = dfY2;
+        }
+        else
+        {
+            const double dfSlope = (dfY2 - dfY1) / (dfX2 - dfX1);
+            dfYA = dfY1 + (dfXA - dfX1) * dfSlope;
+            dfYB = dfY1 + (dfXB - dfX1) * dfSlope;
+        }
+        const int iY0 = GetCellY(std::min(dfYA, dfYB) - m_dfEps);
+        const int iY1 = GetCellY(std::max(dfYA, dfYB) + m_dfEps);
+        for (int iY = iY0; iY <= iY1; ++iY)
+            m_abyCells[static_cast<size_t>(iY) * m_nCellsX + iX] =
+                CELL_BOUNDARY;
+    }
+}
+
+/************************************************************************/
+/*                            MarkBoundary()                            */
+/************************************************************************/
+
+bool OGRFilterGeometryGrid::MarkBoundary(const OGRGeometry *poGeom)
+{
+    const auto eType = wkbFlatten(poGeom->getGeometryType());
+    if (eType == wkbMultiPolygon)
+    {
+        for (const auto *poPoly : *(poGeom->toMultiPolygon()))
+        {
+            if (!MarkBoundary(poPoly))
+                return false;
+        }
+        return true;
+    }
+
+    for (const auto *poRing : *(poGeom->toPolygon()))
+    {
+        const int nPoints = poRing->getNumPoints();
+        for (int i = 0; i + 1 < nPoints; ++i)
+        {
+            const double dfX1 = poRing->getX(i);
+            const double dfY1 = poRing->getY(i);
+            const double dfX2 = poRing->getX(i + 1);
+            const double dfY2 = poRing->getY(i + 1);
+            if (!std::isfinite(dfX1) || !std::isfinite(dfY1) ||
+                !std::isfinite(dfX2) || !std::isfinite(dfY2))
+            {
+                return false;
+            }
+            MarkSegment(dfX1, dfY1, dfX2, dfY2);
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                          ClassifyEnvelope()                          */
+/************************************************************************/
+
+int OGRFilterGeometryGrid::ClassifyEnvelope(const OGREnvelope &sEnvelope) const
+{
+    // Parts of the envelope outside of the grid are outside of the filter
+    const bool bPartiallyOutsideGrid =
+        sEnvelope.MinX - m_dfEps < m_dfMinX ||
+        sEnvelope.MinY - m_dfEps < m_dfMinY ||
+        sEnvelope.MaxX + m_dfEps > m_dfMinX + m_nCellsX * m_dfCellSize ||
+        sEnvelope.MaxY + m_dfEps > m_dfMinY + m_nCellsY * m_dfCellSize;
+
+    const int iX0 = GetCellX(sEnvelope.MinX - m_dfEps);
+    const int iX1 = GetCellX(sEnvelope.MaxX + m_dfEps);
+    const int iY0 = GetCellY(sEnvelope.MinY - m_dfEps);
+    const int iY1 = GetCellY(sEnvelope.MaxY + m_dfEps);
+    if (static_cast<GIntBig>(iX1 - iX0 + 1) * (iY1 - iY0 + 1) >
+        MAX_CELLS_IN_ENVELOPE)
+    {
+        return -1;
+    }
+
+    bool bAllInside = !bPartiallyOutsideGrid;
+    bool bAllOutside = true;
+    for (int iY = iY0; iY <= iY1; ++iY)
+    {
+        const GByte *pabyRow =
+            m_abyCells.data() + static_cast<size_t>(iY) * m_nCellsX;
+        for (int iX = iX0; iX <= iX1; ++iX)
+        {
+            if (pabyRow[iX] == CELL_BOUNDARY)
+                return -1;
+            if (pabyRow[iX] == CELL_INSIDE)
+                bAllOutside = false;
+            else
+                bAllInside = false;
+        }
+    }
+    if (bAllInside)
+        return 1;
+    if (bAllOutside)
+        return 0;
+    return -1;
+}
+
+/************************************************************************/
+/*                         IsPointInInterior()                          */
+/************************************************************************/
+
+bool OGRFilterGeometryGrid::IsPointInInterior(double dfX, double dfY) const
+{
+    if (!(dfX - m_dfEps >= m_dfMinX) || !(dfY - m_dfEps >= m_dfMinY))
+        return false;
+    const int iX0 = GetCellX(dfX - m_dfEps);
+    const int iX1 = GetCellX(dfX + m_dfEps);
+    const int iY0 = GetCellY(dfY - m_dfEps);
+    const int iY1 = GetCellY(dfY + m_dfEps);
+    for (int iY = iY0; iY <= iY1; ++iY)
+    {
+        for (int iX = iX0; iX <= iX1; ++iX)
+        {
+            if (m_abyCells[static_cast<size_t>(iY) * m_nCellsX + iX] !=
+                CELL_INSIDE)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                        HasVertexInInterior()                         */
+/************************************************************************/
+
+bool OGRFilterGeometryGrid::HasVertexInInterior(const OGRGeometry *poGeom) const
+{
+    const auto eType = wkbFlatten(poGeom->getGeometryType());
+    if (eType == wkbPoint)
+    {
+        const auto poPoint = poGeom->toPoint();
+        return !poPoint->IsEmpty() &&
+               IsPointInInterior(poPoint->getX(), poPoint->getY());
+    }
+    else if (eType == wkbLineString || eType == wkbCircularString)
+    {
+        const auto poCurve = poGeom->toSimpleCurve();
+        const int nPoints = poCurve->getNumPoints();
+        for (int i = 0; i < nPoints; ++i)
+        {
+            if (IsPointInInterior(poCurve->getX(i), poCurve->getY(i)))
+                return true;
+        }
+        return false;
+    }
+    else if (eType == wkbPolygon)
+    {
+        const auto poRing = poGeom->toPolygon()->getExteriorRing();
+        return poRing != nullptr && HasVertexInInterior(poRing);
+    }
+    else if (OGR_GT_IsSubClassOf(eType, wkbGeometryCollection))
+    {
+        for (const auto *poSubGeom : *(poGeom->toGeometryCollection()))
+        {
+            if (HasVertexInInterior(poSubGeom))
+                return true;
+        }
+        return false;
+    }
+    return false;
+}
+
+//! @endcond
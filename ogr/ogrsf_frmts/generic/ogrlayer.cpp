@@ -590,6 +590,48 @@ OGRFeatureH OGR_L_GetFeature(OGRLayerH hLayer, GIntBig nFeatureId)
         OGRLayer::FromHandle(hLayer)->GetFeature(nFeatureId));
 }
 
+/************************************************************************/
+/*                        GetNextFeatureBatch()                         */
+/************************************************************************/
+
+/**
+ \brief Fetch the next features from this layer.
+
+ The batch is first cleared, and then filled with at most nMaxFeatures
+ features, as returned by successive calls to GetNextFeature(). The returned
+ features are owned by the batch, and are only valid until the next call to
+ GetNextFeatureBatch() with the same batch, or the destruction of the batch.
+ Use OGRFeatureBatch::StealFeature() to keep a feature beyond that.
+
+ Passing the same batch object to successive calls allows drivers that
+ override this method to recycle the features of the previous batch, which
+ saves the allocation and deallocation of a feature, of its field array and
+ often of its string values and geometries, for each feature.
+
+ The default implementation calls GetNextFeature() nMaxFeatures times.
+
+ @param oBatch Batch to fill.
+ @param nMaxFeatures Maximum number of features to read.
+
+ @return the number of features read, 0 at end of layer.
+
+ @since GDAL 3.9
+*/
+
+int OGRLayer::GetNextFeatureBatch(OGRFeatureBatch &oBatch, int nMaxFeatures)
+
+{
+    oBatch.Clear();
+    while (oBatch.GetFeatureCount() < nMaxFeatures)
+    {
+        OGRFeature *poFeature = GetNextFeature();
+        if (poFeature == nullptr)
+            break;
+        oBatch.AppendFeature(OGRFeatureUniquePtr(poFeature));
+    }
+    return oBatch.GetFeatureCount();
+}
+
 /************************************************************************/
 /*                           SetNextByIndex()                           */
 /************************************************************************/
@@ -1566,6 +1608,7 @@ int OGRLayer::InstallFilter(OGRGeometry *poFilter)
         OGRDestroyPreparedGeometry(m_pPreparedFilterGeom);
         m_pPreparedFilterGeom = nullptr;
     }
+    m_poPrivate->m_poFilterGrid.reset();
 
     if (poFilter != nullptr)
         m_poFilterGeom = poFilter->clone();
@@ -1581,6 +1624,10 @@ int OGRLayer::InstallFilter(OGRGeometry *poFilter)
     m_pPreparedFilterGeom =
         OGRCreatePreparedGeometry(OGRGeometry::ToHandle(m_poFilterGeom));
 
+    /* Classify cells of a grid for large polygonal filters */
+    m_poPrivate->m_poFilterGrid =
+        OGRFilterGeometryGrid::Build(m_poFilterGeom, m_pPreparedFilterGeom);
+
     /* -------------------------------------------------------------------- */
     /*      Now try to determine if the filter is really a rectangle.       */
     /* -------------------------------------------------------------------- */
@@ -1749,6 +1796,17 @@ int OGRLayer::FilterGeometry(const OGRGeometry *poGeometry)
                 return true;
         }
 
+        // For large filters, try to conclude from the cells covered by the
+        // geometry.
+        if (const auto poGrid = m_poPrivate->m_poFilterGrid.get())
+        {
+            const int nRet = poGrid->ClassifyEnvelope(sGeomEnv);
+            if (nRet >= 0)
+                return nRet;
+            if (poGrid->HasVertexInInterior(poGeometry))
+                return TRUE;
+        }
+
         /* --------------------------------------------------------------------
          */
         /*      Fallback to full intersect test (using GEOS) if we still */
@@ -1798,8 +1856,27 @@ bool OGRLayer::FilterWKBGeometry(const GByte *pabyWKB, size_t nWKBSize,
             {
                 return true;
             }
+            int nGridRet = -1;
+            if (m_poPrivate->m_poFilterGrid)
+                nGridRet =
+                    m_poPrivate->m_poFilterGrid->ClassifyEnvelope(sEnvelope);
+            if (nGridRet >= 0)
+            {
+                return nGridRet == 1;
+            }
             else if (OGRGeometryFactory::haveGEOS())
             {
+                // Avoid instantiating a OGRGeometry when GEOS can read the
+                // WKB directly
+                bool bIntersects = false;
+                if (m_pPreparedFilterGeom &&
+                    OGRPreparedGeometryIntersectsWKB(m_pPreparedFilterGeom,
+                                                     pabyWKB, nWKBSize,
+                                                     bIntersects))
+                {
+                    return bIntersects;
+                }
+
                 OGRGeometry *poGeom = nullptr;
                 int ret = FALSE;
                 if (OGRGeometryFactory::createFromWkb(pabyWKB, nullptr, &poGeom,
@@ -2217,6 +2294,151 @@ OGRErr OGR_L_SetIgnoredFields(OGRLayerH hLayer, const char **papszFields)
     return OGRLayer::FromHandle(hLayer)->SetIgnoredFields(papszFields);
 }
 
+/************************************************************************/
+/*                            ExplainQuery()                            */
+/************************************************************************/
+
+/**
+ \brief Describe how the current filters will be evaluated.
+
+ The returned list of KEY=VALUE pairs describes how the next
+ GetNextFeature() loop will process the spatial filter, the attribute
+ filter and the ignored fields of the layer. It is mostly intended to
+ diagnose slow queries, such as a filter causing a full scan of the layer.
+
+ The following keys are defined:
+ <ul>
+ <li>SPATIAL_FILTER=NONE/INDEX/SCAN: whether the spatial filter, if any, is
+     evaluated with a spatial index, or by scanning all features.</li>
+ <li>ATTRIBUTE_FILTER=NONE/PUSHED_DOWN/OGR: whether the attribute filter,
+     if any, is translated and evaluated by the backend, or evaluated by the
+     OGR SQL engine on each feature.</li>
+ <li>ATTRIBUTE_INDEX=YES/NO: whether an attribute index is used to evaluate
+     the attribute filter. Only set when it is known.</li>
+ <li>IGNORED_FIELDS=comma separated list of the ignored fields, with the
+     same names as for SetIgnoredFields(). Only set if fields are ignored.</li>
+ <li>IGNORED_FIELDS_SKIPPED=YES/NO: whether the driver skips reading the
+     ignored fields (that is whether it supports OLCIgnoreFields).</li>
+ <li>FEATURE_COUNT=integer: number of features matching the filters, if it
+     can be computed without reading the features.</li>
+ <li>BACKEND_PLAN=string: query plan reported by the backend, for drivers
+     that support it.</li>
+ </ul>
+
+ This method is the same as the C function OGR_L_ExplainQuery().
+
+ @return a list of KEY=VALUE strings.
+ @since GDAL 3.9
+*/
+
+CPLStringList OGRLayer::ExplainQuery()
+{
+    CPLStringList aosPlan;
+
+    if (m_poFilterGeom == nullptr)
+        aosPlan.SetNameValue("SPATIAL_FILTER", "NONE");
+    else
+        aosPlan.SetNameValue("SPATIAL_FILTER",
+                             TestCapability(OLCFastSpatialFilter) ? "INDEX"
+                                                                  : "SCAN");
+
+    OGRFeatureDefn *poDefn = GetLayerDefn();
+    if (m_poAttrQuery != nullptr)
+    {
+        aosPlan.SetNameValue("ATTRIBUTE_FILTER", "OGR");
+
+        bool bIndexUsed = false;
+        if (m_poAttrIndex != nullptr)
+        {
+            char **papszUsedFields = m_poAttrQuery->GetUsedFields();
+            for (char **papszIter = papszUsedFields; papszIter && *papszIter;
+                 ++papszIter)
+            {
+                const int iField = poDefn->GetFieldIndex(*papszIter);
+                if (iField >= 0 && m_poAttrIndex->GetFieldIndex(iField))
+                    bIndexUsed = true;
+            }
+            CSLDestroy(papszUsedFields);
+        }
+        aosPlan.SetNameValue("ATTRIBUTE_INDEX", bIndexUsed ? "YES" : "NO");
+    }
+    else if (m_pszAttrQueryString != nullptr)
+    {
+        aosPlan.SetNameValue("ATTRIBUTE_FILTER", "PUSHED_DOWN");
+    }
+    else
+    {
+        aosPlan.SetNameValue("ATTRIBUTE_FILTER", "NONE");
+    }
+
+    std::string osIgnored;
+    const auto AddIgnored = [&osIgnored](const char *pszName)
+    {
+        if (!osIgnored.empty())
+            osIgnored += ',';
+        osIgnored += pszName;
+    };
+    for (int iField = 0; iField < poDefn->GetFieldCount(); iField++)
+    {
+        const OGRFieldDefn *poFieldDefn = poDefn->GetFieldDefn(iField);
+        if (poFieldDefn->IsIgnored())
+            AddIgnored(poFieldDefn->GetNameRef());
+    }
+    for (int iField = 0; iField < poDefn->GetGeomFieldCount(); iField++)
+    {
+        const OGRGeomFieldDefn *poGeomFieldDefn =
+            poDefn->GetGeomFieldDefn(iField);
+        if (poGeomFieldDefn->IsIgnored())
+        {
+            AddIgnored(iField == 0 ? "OGR_GEOMETRY"
+                                   : poGeomFieldDefn->GetNameRef());
+        }
+    }
+    if (poDefn->IsStyleIgnored())
+        AddIgnored("OGR_STYLE");
+    if (!osIgnored.empty())
+    {
+        aosPlan.SetNameValue("IGNORED_FIELDS", osIgnored.c_str());
+        aosPlan.SetNameValue("IGNORED_FIELDS_SKIPPED",
+                             TestCapability(OLCIgnoreFields) ? "YES" : "NO");
+    }
+
+    if (TestCapability(OLCFastFeatureCount))
+    {
+        const GIntBig nCount = GetFeatureCount(FALSE);
+        if (nCount >= 0)
+        {
+            aosPlan.SetNameValue("FEATURE_COUNT",
+                                 CPLSPrintf(CPL_FRMT_GIB, nCount));
+        }
+    }
+
+    return aosPlan;
+}
+
+/************************************************************************/
+/*                          OGR_L_ExplainQuery()                        */
+/************************************************************************/
+
+/**
+ \brief Describe how the current filters will be evaluated.
+
+ See OGRLayer::ExplainQuery() for the returned keys.
+
+ This function is the same as the C++ method OGRLayer::ExplainQuery().
+
+ @param hLayer handle to the layer.
+ @return a list of KEY=VALUE strings, to be freed with CSLDestroy().
+ @since GDAL 3.9
+*/
+
+char **OGR_L_ExplainQuery(OGRLayerH hLayer)
+{
+    VALIDATE_POINTER1(hLayer, "OGR_L_ExplainQuery", nullptr);
+
+    return OGRLayer::FromHandle(hLayer)->ExplainQuery().StealList();
+}
+
 /************************************************************************/
 /*                             Rename()                                 */
 /************************************************************************/
@@ -31,11 +31,74 @@
 
 #include "ogrsf_frmts.h"
 
+#include <memory>
+#include <vector>
+
 //! @cond Doxygen_Suppress
+
+/************************************************************************/
+/*                        OGRFilterGeometryGrid                         */
+/************************************************************************/
+
+/** Regular grid over the extent of a large polygonal spatial filter, whose
+ * cells are classified as being inside, outside or crossing the boundary of
+ * the filter geometry.
+ *
+ * It enables deciding whether most features intersect the filter by looking
+ * up the cells covered by their envelope, without involving GEOS.
+ */
+class OGRFilterGeometryGrid
+{
+  public:
+    static std::unique_ptr<OGRFilterGeometryGrid>
+    Build(const OGRGeometry *poFilterGeom,
+          OGRPreparedGeometry *poPreparedFilterGeom);
+
+    /** Returns 1 if a geometry of that envelope certainly intersects the
+     * filter, 0 if it certainly does not, and -1 if unknown. */
+    int ClassifyEnvelope(const OGREnvelope &sEnvelope) const;
+
+    /** Returns whether one of the vertices of the geometry is in a cell
+     * entirely inside the filter. */
+    bool HasVertexInInterior(const OGRGeometry *poGeom) const;
+
+  private:
+    enum CellStatus : GByte
+    {
+        CELL_UNKNOWN,
+        CELL_BOUNDARY,
+        CELL_INSIDE,
+        CELL_OUTSIDE
+    };
+
+    double m_dfMinX = 0;
+    double m_dfMinY = 0;
+    double m_dfCellSize = 0;
+    double m_dfEps = 0;
+    int m_nCellsX = 0;
+    int m_nCellsY = 0;
+    std::vector<GByte> m_abyCells{};
+
+    OGRFilterGeometryGrid() = default;
+
+    int GetCellX(double dfX) const;
+    int GetCellY(double dfY) const;
+    void MarkSegment(double dfX1, double dfY1, double dfX2, double dfY2);
+    bool MarkBoundary(const OGRGeometry *poGeom);
+    bool IsPointInInterior(double dfX, double dfY) const;
+};
+
+/************************************************************************/
+/*                          OGRLayer::Private                           */
+/************************************************************************/
+
 struct OGRLayer::Private
 {
     bool m_bInFeatureIterator = false;
 
+    // Built by InstallFilter() for large polygonal filters
+    std::unique_ptr<OGRFilterGeometryGrid> m_poFilterGrid{};
+
     // Used by CreateFieldFromArrowSchema() and WriteArrowBatch()
     // to store the mapping between the input Arrow field name and the
     // output OGR field name, that can be different sometimes (for example
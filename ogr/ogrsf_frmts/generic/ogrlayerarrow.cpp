@@ -40,9 +40,17 @@
 #include "cpl_float.h"
 #include "cpl_json.h"
 #include "cpl_time.h"
+#include "cpl_trace.h"
+#include <algorithm>
 #include <cassert>
 #include <cinttypes>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
 #include <limits>
+#include <map>
+#include <mutex>
+#include <thread>
 #include <utility>
 #include <set>
 
@@ -1756,6 +1764,10 @@ FillDateTimeArray(struct ArrowArray *psChild,
 int OGRLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
                                 struct ArrowArray *out_array)
 {
+    CPLTraceSpan oSpan("ogr", "OGRLayer::GetNextArrowArray");
+    if (oSpan.IsEnabled())
+        oSpan.AddArg("layer", GetName());
+
     ArrowArrayStreamPrivateDataSharedDataWrapper *poPrivate =
         static_cast<ArrowArrayStreamPrivateDataSharedDataWrapper *>(
             stream->private_data);
@@ -2172,6 +2184,329 @@ error:
     return ENOMEM;
 }
 
+/************************************************************************/
+/*                      OGRLayerParallelArrowReader                     */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+
+/** Produces the batches of an Arrow stream by reading several partitions of
+ * a layer concurrently, each one through its own ArrowArrayStream.
+ *
+ * Worker threads fetch one batch at a time from a partition that is not
+ * already being read, and queue it. When the order is preserved, only the
+ * partitions close to the one being consumed are read ahead, and batches are
+ * delivered partition after partition.
+ */
+class OGRLayerParallelArrowReader
+{
+  public:
+    OGRLayerParallelArrowReader(
+        std::vector<std::unique_ptr<OGRLayerPartition>> &&apoPartitions,
+        int nThreads, bool bPreserveOrder);
+    ~OGRLayerParallelArrowReader();
+
+    bool Start(CSLConstList papszOptions);
+    int GetNext(struct ArrowArray *out_array);
+
+  private:
+    static constexpr size_t MAX_QUEUED_BATCHES_PER_PARTITION = 2;
+
+    struct Partition
+    {
+        std::unique_ptr<OGRLayerPartition> poPartition{};
+        struct ArrowArrayStream stream
+        {
+        };
+        std::deque<struct ArrowArray> aoBatches{};
+        bool bBusy = false;
+        bool bFinished = false;
+    };
+
+    std::vector<Partition> m_aoPartitions{};
+    const int m_nThreads;
+    const bool m_bPreserveOrder;
+    size_t m_iCurPartition = 0;
+    std::mutex m_oMutex{};
+    std::condition_variable m_oCV{};
+    std::vector<std::thread> m_aoThreads{};
+    bool m_bStop = false;
+    bool m_bError = false;
+    std::string m_osErrorMsg{};
+
+    Partition *PickPartition();
+    bool AllPartitionsFinished() const;
+    void WorkerThread();
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRLayerParallelArrowReader)
+};
+
+/************************************************************************/
+/*                    OGRLayerParallelArrowReader()                     */
+/************************************************************************/
+
+OGRLayerParallelArrowReader::OGRLayerParallelArrowReader(
+    std::vector<std::unique_ptr<OGRLayerPartition>> &&apoPartitions,
+    int nThreads, bool bPreserveOrder)
+    : m_aoPartitions(apoPartitions.size()), m_nThreads(nThreads),
+      m_bPreserveOrder(bPreserveOrder)
+{
+    for (size_t i = 0; i < apoPartitions.size(); ++i)
+        m_aoPartitions[i].poPartition = std::move(apoPartitions[i]);
+}
+
+/************************************************************************/
+/*                    ~OGRLayerParallelArrowReader()                    */
+/************************************************************************/
+
+OGRLayerParallelArrowReader::~OGRLayerParallelArrowReader()
+{
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_bStop = true;
+    }
+    m_oCV.notify_all();
+    for (auto &oThread : m_aoThreads)
+        oThread.join();
+
+    for (auto &oPartition : m_aoPartitions)
+    {
+        for (auto &sBatch : oPartition.aoBatches)
+            sBatch.release(&sBatch);
+        if (oPartition.stream.release)
+            oPartition.stream.release(&oPartition.stream);
+    }
+}
+
+/************************************************************************/
+/*                               Start()                                */
+/************************************************************************/
+
+bool OGRLayerParallelArrowReader::Start(CSLConstList papszOptions)
+{
+    for (auto &oPartition : m_aoPartitions)
+    {
+        if (!oPartition.poPartition->GetLayer()->GetArrowStream(
+                &oPartition.stream, papszOptions))
+        {
+            return false;
+        }
+    }
+
+    try
+    {
+        const int nThreads =
+            std::min(m_nThreads, static_cast<int>(m_aoPartitions.size()));
+        for (int i = 0; i < nThreads; ++i)
+            m_aoThreads.emplace_back([this]() { WorkerThread(); });
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot start worker thread: %s",
+                 e.what());
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                           PickPartition()                            */
+/************************************************************************/
+
+// Must be called with m_oMutex held.
+OGRLayerParallelArrowReader::Partition *
+OGRLayerParallelArrowReader::PickPartition()
+{
+    const size_t nStart = m_bPreserveOrder ? m_iCurPartition : 0;
+    const size_t nEnd =
+        m_bPreserveOrder
+            ? std::min(m_aoPartitions.size(), m_iCurPartition + m_nThreads)
+            : m_aoPartitions.size();
+    Partition *poBest = nullptr;
+    for (size_t i = nStart; i < nEnd; ++i)
+    {
+        auto &oPartition = m_aoPartitions[i];
+        if (!oPartition.bBusy && !oPartition.bFinished &&
+            oPartition.aoBatches.size() < MAX_QUEUED_BATCHES_PER_PARTITION &&
+            (poBest == nullptr ||
+             oPartition.aoBatches.size() < poBest->aoBatches.size()))
+        {
+            poBest = &oPartition;
+        }
+    }
+    return poBest;
+}
+
+/************************************************************************/
+/*                       AllPartitionsFinished()                        */
+/************************************************************************/
+
+// Must be called with m_oMutex held.
+bool OGRLayerParallelArrowReader::AllPartitionsFinished() const
+{
+    for (const auto &oPartition : m_aoPartitions)
+    {
+        if (!oPartition.bFinished)
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                            WorkerThread()                            */
+/************************************************************************/
+
+void OGRLayerParallelArrowReader::WorkerThread()
+{
+    std::unique_lock<std::mutex> oLock(m_oMutex);
+    while (!m_bStop && !m_bError)
+    {
+        Partition *poPartition = PickPartition();
+        if (poPartition == nullptr)
+        {
+            if (AllPartitionsFinished())
+                break;
+            m_oCV.wait(oLock);
+            continue;
+        }
+
+        poPartition->bBusy = true;
+        oLock.unlock();
+
+        struct ArrowArray sBatch;
+        memset(&sBatch, 0, sizeof(sBatch));
+        const int nRet =
+            poPartition->stream.get_next(&poPartition->stream, &sBatch);
+        std::string osErrorMsg;
+        if (nRet != 0)
+        {
+            const char *pszErrorMsg =
+                poPartition->stream.get_last_error(&poPartition->stream);
+            osErrorMsg = pszErrorMsg ? pszErrorMsg : "get_next() failed";
+        }
+
+        oLock.lock();
+        poPartition->bBusy = false;
+        if (nRet != 0)
+        {
+            m_bError = true;
+            m_osErrorMsg = std::move(osErrorMsg);
+        }
+        else if (sBatch.release == nullptr)
+        {
+            poPartition->bFinished = true;
+        }
+        else if (sBatch.length == 0)
+        {
+            sBatch.release(&sBatch);
+        }
+        else
+        {
+            poPartition->aoBatches.push_back(sBatch);
+        }
+        m_oCV.notify_all();
+    }
+}
+
+/************************************************************************/
+/*                              GetNext()                               */
+/************************************************************************/
+
+int OGRLayerParallelArrowReader::GetNext(struct ArrowArray *out_array)
+{
+    memset(out_array, 0, sizeof(*out_array));
+
+    std::unique_lock<std::mutex> oLock(m_oMutex);
+    while (true)
+    {
+        if (m_bError)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "%s", m_osErrorMsg.c_str());
+            return EIO;
+        }
+
+        Partition *poPartition = nullptr;
+        if (m_bPreserveOrder)
+        {
+            while (m_iCurPartition < m_aoPartitions.size() &&
+                   m_aoPartitions[m_iCurPartition].bFinished &&
+                   m_aoPartitions[m_iCurPartition].aoBatches.empty())
+            {
+                // Let workers read ahead the next partitions
+                ++m_iCurPartition;
+                m_oCV.notify_all();
+            }
+            if (m_iCurPartition == m_aoPartitions.size())
+                return 0;
+            if (!m_aoPartitions[m_iCurPartition].aoBatches.empty())
+                poPartition = &m_aoPartitions[m_iCurPartition];
+        }
+        else
+        {
+            bool bAllFinished = true;
+            for (auto &oPartition : m_aoPartitions)
+            {
+                if (!oPartition.aoBatches.empty())
+                {
+                    poPartition = &oPartition;
+                    break;
+                }
+                if (!oPartition.bFinished)
+                    bAllFinished = false;
+            }
+            if (!poPartition && bAllFinished)
+                return 0;
+        }
+
+        if (poPartition)
+        {
+            *out_array = poPartition->aoBatches.front();
+            poPartition->aoBatches.pop_front();
+            m_oCV.notify_all();
+            return 0;
+        }
+
+        m_oCV.wait(oLock);
+    }
+}
+
+//! @endcond
+
+/************************************************************************/
+/*                         ~OGRLayerPartition()                         */
+/************************************************************************/
+
+OGRLayerPartition::~OGRLayerPartition() = default;
+
+/************************************************************************/
+/*                           GetPartitions()                            */
+/************************************************************************/
+
+/** Return partitions of the layer, that can be read concurrently.
+ *
+ * Partitions are disjoint subsets of the features of the layer, whose union
+ * is the whole layer. Each partition comes with its own OGRLayer object,
+ * typically backed by its own dataset handle, so that several partitions can
+ * be read from different threads. Partitions must be returned in the order
+ * in which their features are returned by GetNextFeature().
+ *
+ * Filters and ignored fields set on this layer are not taken into account by
+ * the returned partitions: this is the responsibility of the caller.
+ *
+ * This is used by the default implementation of GetArrowStream() when the
+ * NUM_THREADS option is set. The default implementation returns an empty
+ * vector, meaning that the layer cannot be partitioned.
+ *
+ * @param nMaxPartitions Maximum number of partitions to return.
+ * @return a vector of partitions, possibly empty.
+ * @since GDAL 3.9
+ */
+std::vector<std::unique_ptr<OGRLayerPartition>>
+OGRLayer::GetPartitions(CPL_UNUSED int nMaxPartitions)
+{
+    return {};
+}
+
 /************************************************************************/
 /*                       StaticGetNextArrowArray()                      */
 /************************************************************************/
@@ -2186,15 +2521,19 @@ error:
 int OGRLayer::StaticGetNextArrowArray(struct ArrowArrayStream *stream,
                                       struct ArrowArray *out_array)
 {
-    auto poLayer = static_cast<ArrowArrayStreamPrivateDataSharedDataWrapper *>(
-                       stream->private_data)
-                       ->poShared->m_poLayer;
+    const auto &poShared =
+        static_cast<ArrowArrayStreamPrivateDataSharedDataWrapper *>(
+            stream->private_data)
+            ->poShared;
+    auto poLayer = poShared->m_poLayer;
     if (poLayer == nullptr)
     {
         CPLError(CE_Failure, CPLE_NotSupported,
                  "Calling get_next() on a freed OGRLayer is not supported");
         return EINVAL;
     }
+    if (poShared->m_poParallelReader)
+        return poShared->m_poParallelReader->GetNext(out_array);
     return poLayer->GetNextArrowArray(stream, out_array);
 }
 
@@ -2237,6 +2576,7 @@ void OGRLayer::ReleaseStream(struct ArrowArrayStream *stream)
             stream->private_data);
     poPrivate->poShared->m_bArrowArrayStreamInProgress = false;
     poPrivate->poShared->m_bEOF = false;
+    poPrivate->poShared->m_poParallelReader.reset();
     if (poPrivate->poShared->m_poLayer)
         poPrivate->poShared->m_poLayer->ResetReading();
     delete poPrivate;
@@ -2375,6 +2715,13 @@ From OGR using the Arrow C Stream data interface</a> tutorial.
  *     ARROW:extension:name=geoarrow.wkb and
  *     ARROW:extension:metadata={"crs": &lt;projjson CRS representation>&gt; are set.
  * </li>
+ * <li>NUM_THREADS=integer or ALL_CPUS (GDAL >= 3.9). Number of threads used
+ *     to build batches, when the layer can be split into partitions with
+ *     GetPartitions(). Defaults to 1.</li>
+ * <li>PRESERVE_ORDER=YES/NO (GDAL >= 3.9). Only used when NUM_THREADS is
+ *     greater than 1. When set to NO, batches are returned as soon as they are
+ *     ready, and features are no longer returned in the order of
+ *     GetNextFeature(). Defaults to YES.</li>
  * </ul>
  *
  * The Arrow/Parquet drivers recognize the following option:
@@ -2448,12 +2795,96 @@ bool OGRLayer::GetArrowStream(struct ArrowArrayStream *out_stream,
         }
     }
 
+    m_poSharedArrowArrayStreamPrivateData->m_poParallelReader.reset();
+    if (m_poSharedArrowArrayStreamPrivateData->m_anQueriedFIDs.empty())
+    {
+        const char *pszNumThreads =
+            CSLFetchNameValueDef(papszOptions, "NUM_THREADS", "1");
+        const int nThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                                 ? CPLGetNumCPUs()
+                                 : atoi(pszNumThreads);
+        if (nThreads > 1)
+        {
+            m_poSharedArrowArrayStreamPrivateData->m_poParallelReader =
+                CreateParallelArrowReader(nThreads, papszOptions);
+        }
+    }
+
     auto poPrivateData = new ArrowArrayStreamPrivateDataSharedDataWrapper();
     poPrivateData->poShared = m_poSharedArrowArrayStreamPrivateData;
     out_stream->private_data = poPrivateData;
     return true;
 }
 
+/************************************************************************/
+/*                     CreateParallelArrowReader()                      */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+std::shared_ptr<OGRLayerParallelArrowReader>
+OGRLayer::CreateParallelArrowReader(int nThreads, CSLConstList papszOptions)
+{
+    auto apoPartitions = GetPartitions(nThreads * 4);
+    if (apoPartitions.size() < 2)
+        return nullptr;
+
+    // Propagate the filters and ignored fields of this layer to partitions
+    CPLStringList aosIgnoredFields;
+    const auto poLayerDefn = GetLayerDefn();
+    for (int i = 0; i < poLayerDefn->GetFieldCount(); ++i)
+    {
+        const auto poFieldDefn = poLayerDefn->GetFieldDefn(i);
+        if (poFieldDefn->IsIgnored())
+            aosIgnoredFields.AddString(poFieldDefn->GetNameRef());
+    }
+    for (int i = 0; i < poLayerDefn->GetGeomFieldCount(); ++i)
+    {
+        const auto poGeomFieldDefn = poLayerDefn->GetGeomFieldDefn(i);
+        if (poGeomFieldDefn->IsIgnored())
+        {
+            const char *pszName = poGeomFieldDefn->GetNameRef();
+            aosIgnoredFields.AddString(pszName[0] ? pszName : "OGR_GEOMETRY");
+        }
+    }
+    if (poLayerDefn->IsStyleIgnored())
+        aosIgnoredFields.AddString("OGR_STYLE");
+
+    for (auto &poPartition : apoPartitions)
+    {
+        auto poPartitionLayer = poPartition->GetLayer();
+        if (poPartitionLayer->SetIgnoredFields(
+                const_cast<const char **>(aosIgnoredFields.List())) !=
+                OGRERR_NONE ||
+            poPartitionLayer->SetAttributeFilter(m_pszAttrQueryString) !=
+                OGRERR_NONE)
+        {
+            return nullptr;
+        }
+        poPartitionLayer->SetSpatialFilter(m_iGeomFieldFilter, m_poFilterGeom);
+    }
+
+    CPLStringList aosOptions(CSLDuplicate(papszOptions), true);
+    aosOptions.SetNameValue("NUM_THREADS", nullptr);
+    aosOptions.SetNameValue("PRESERVE_ORDER", nullptr);
+
+    auto poReader = std::make_shared<OGRLayerParallelArrowReader>(
+        std::move(apoPartitions), nThreads,
+        CPLTestBool(
+            CSLFetchNameValueDef(papszOptions, "PRESERVE_ORDER", "YES")));
+    if (!poReader->Start(aosOptions.List()))
+    {
+        CPLDebug("OGR",
+                 "Cannot read layer %s in parallel. "
+                 "Falling back to sequential reading",
+                 GetDescription());
+        return nullptr;
+    }
+    CPLDebug("OGR", "Reading layer %s with %d threads", GetDescription(),
+             nThreads);
+    return poReader;
+}
+//! @endcond
+
 /************************************************************************/
 /*                       OGR_L_GetArrowStream()                         */
 /************************************************************************/
@@ -2569,6 +3000,13 @@ YES.</li>
  *     ARROW:extension:name=geoarrow.wkb and
  *     ARROW:extension:metadata={"crs": &lt;projjson CRS representation>&gt; are set.
  * </li>
+ * <li>NUM_THREADS=integer or ALL_CPUS (GDAL >= 3.9). Number of threads used
+ *     to build batches, when the layer can be split into partitions with
+ *     GetPartitions(). Defaults to 1.</li>
+ * <li>PRESERVE_ORDER=YES/NO (GDAL >= 3.9). Only used when NUM_THREADS is
+ *     greater than 1. When set to NO, batches are returned as soon as they are
+ *     ready, and features are no longer returned in the order of
+ *     GetNextFeature(). Defaults to YES.</li>
  * </ul>
  *
  * The Arrow/Parquet drivers recognize the following option:
@@ -3500,13 +3938,195 @@ static bool CompactArray(const struct ArrowSchema *schema,
     return true;
 }
 
+/************************************************************************/
+/*                          OGRArrowBBoxColumn                          */
+/************************************************************************/
+
+namespace
+{
+/** Bounding box column, with xmin, ymin, xmax and ymax (or minx, miny, maxx
+ * and maxy) float or double children, as in the "covering" of GeoParquet 1.1.
+ */
+struct OGRArrowBBoxColumn
+{
+    const struct ArrowArray *psArray = nullptr;
+    const struct ArrowArray *apsChildren[4] = {nullptr, nullptr, nullptr,
+                                               nullptr};
+    bool bIsFloat = false;
+
+    // Status of rows computed by ComputeStatus()
+    static constexpr GByte DISJOINT = 0;
+    static constexpr GByte INTERSECTS = 1;
+    static constexpr GByte UNKNOWN = 2;
+    std::vector<GByte> abyStatus{};
+
+    bool Init(const struct ArrowSchema *schema,
+              const struct ArrowArray *array);
+    void ComputeStatus(const OGREnvelope &sFilterEnvelope);
+    void GetEnvelope(size_t iRow, OGREnvelope &sEnvelope) const;
+
+  private:
+    template <class T> void ComputeStatus(const OGREnvelope &sFilterEnvelope);
+
+    template <class T> inline const T *GetValues(int iChild) const
+    {
+        const auto psChild = apsChildren[iChild];
+        return static_cast<const T *>(psChild->buffers[1]) + psChild->offset +
+               psArray->offset;
+    }
+};
+
+/************************************************************************/
+/*                     OGRArrowBBoxColumn::Init()                       */
+/************************************************************************/
+
+bool OGRArrowBBoxColumn::Init(const struct ArrowSchema *schema,
+                              const struct ArrowArray *array)
+{
+    if (strcmp(schema->format, "+s") != 0 ||
+        schema->n_children != array->n_children)
+    {
+        return false;
+    }
+    // GeoParquet 1.1 names, and the ones of the Overture Maps datasets
+    const char *const apszNames[] = {"xmin", "ymin", "xmax", "ymax"};
+    const char *const apszAltNames[] = {"minx", "miny", "maxx", "maxy"};
+    const char *pszFormat = nullptr;
+    for (int64_t iChild = 0; iChild < schema->n_children; ++iChild)
+    {
+        const auto psChildSchema = schema->children[iChild];
+        for (int i = 0; i < 4; ++i)
+        {
+            if (strcmp(psChildSchema->name, apszNames[i]) == 0 ||
+                strcmp(psChildSchema->name, apszAltNames[i]) == 0)
+            {
+                if (pszFormat == nullptr)
+                    pszFormat = psChildSchema->format;
+                if (apsChildren[i] != nullptr ||
+                    strcmp(psChildSchema->format, pszFormat) != 0 ||
+                    array->children[iChild]->n_buffers != 2)
+                {
+                    return false;
+                }
+                apsChildren[i] = array->children[iChild];
+            }
+        }
+    }
+    for (const auto psChild : apsChildren)
+    {
+        if (psChild == nullptr)
+            return false;
+    }
+    if (strcmp(pszFormat, "f") == 0)
+        bIsFloat = true;
+    else if (strcmp(pszFormat, "g") != 0)
+        return false;
+    psArray = array;
+    return true;
+}
+
+/************************************************************************/
+/*                 OGRArrowBBoxColumn::ComputeStatus()                  */
+/************************************************************************/
+
+template <class T>
+void OGRArrowBBoxColumn::ComputeStatus(const OGREnvelope &sFilterEnvelope)
+{
+    const size_t nLength = static_cast<size_t>(psArray->length);
+    const T *pXMin = GetValues<T>(0);
+    const T *pYMin = GetValues<T>(1);
+    const T *pXMax = GetValues<T>(2);
+    const T *pYMax = GetValues<T>(3);
+    const double dfMinX = sFilterEnvelope.MinX;
+    const double dfMinY = sFilterEnvelope.MinY;
+    const double dfMaxX = sFilterEnvelope.MaxX;
+    const double dfMaxY = sFilterEnvelope.MaxY;
+
+    // Branchless loop, so that the compiler can vectorize it
+    GByte *pabyStatus = abyStatus.data();
+    for (size_t i = 0; i < nLength; ++i)
+    {
+        pabyStatus[i] = static_cast<GByte>(
+            (static_cast<double>(pXMax[i]) >= dfMinX) &
+            (static_cast<double>(pYMax[i]) >= dfMinY) &
+            (static_cast<double>(pXMin[i]) <= dfMaxX) &
+            (static_cast<double>(pYMin[i]) <= dfMaxY));
+    }
+}
+
+void OGRArrowBBoxColumn::ComputeStatus(const OGREnvelope &sFilterEnvelope)
+{
+    const size_t nLength = static_cast<size_t>(psArray->length);
+    abyStatus.resize(nLength);
+    if (bIsFloat)
+        ComputeStatus<float>(sFilterEnvelope);
+    else
+        ComputeStatus<double>(sFilterEnvelope);
+
+    // Rows with a null bounding box must be evaluated from their geometry
+    if (psArray->null_count != 0)
+    {
+        const uint8_t *pabyValidity =
+            static_cast<const uint8_t *>(psArray->buffers[0]);
+        const size_t nOffset = static_cast<size_t>(psArray->offset);
+        for (size_t i = 0; i < nLength; ++i)
+        {
+            if (!TestBit(pabyValidity, i + nOffset))
+                abyStatus[i] = UNKNOWN;
+        }
+    }
+    for (const auto psChild : apsChildren)
+    {
+        if (psChild->null_count != 0)
+        {
+            const uint8_t *pabyValidity =
+                static_cast<const uint8_t *>(psChild->buffers[0]);
+            const size_t nOffset =
+                static_cast<size_t>(psChild->offset + psArray->offset);
+            for (size_t i = 0; i < nLength; ++i)
+            {
+                if (!TestBit(pabyValidity, i + nOffset))
+                    abyStatus[i] = UNKNOWN;
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                  OGRArrowBBoxColumn::GetEnvelope()                   */
+/************************************************************************/
+
+void OGRArrowBBoxColumn::GetEnvelope(size_t iRow, OGREnvelope &sEnvelope) const
+{
+    if (bIsFloat)
+    {
+        sEnvelope.MinX = GetValues<float>(0)[iRow];
+        sEnvelope.MinY = GetValues<float>(1)[iRow];
+        sEnvelope.MaxX = GetValues<float>(2)[iRow];
+        sEnvelope.MaxY = GetValues<float>(3)[iRow];
+    }
+    else
+    {
+        sEnvelope.MinX = GetValues<double>(0)[iRow];
+        sEnvelope.MinY = GetValues<double>(1)[iRow];
+        sEnvelope.MaxX = GetValues<double>(2)[iRow];
+        sEnvelope.MaxY = GetValues<double>(3)[iRow];
+    }
+}
+
+}  // namespace
+
 /************************************************************************/
 /*                  FillValidityArrayFromWKBArray()                     */
 /************************************************************************/
 
+// The bounding box column, when provided, is used to discard rows without
+// decoding their WKB geometry. Bounding boxes stored as float values are
+// rounded outwards, and are thus also suitable for that purpose.
 template <class OffsetType>
 static size_t
 FillValidityArrayFromWKBArray(struct ArrowArray *array, const OGRLayer *poLayer,
+                              const OGRArrowBBoxColumn *psBBox,
                               std::vector<bool> &abyValidityFromFilters)
 {
     const size_t nLength = static_cast<size_t>(array->length);
@@ -3523,14 +4143,24 @@ FillValidityArrayFromWKBArray(struct ArrowArray *array, const OGRLayer *poLayer,
     size_t nCountIntersecting = 0;
     for (size_t i = 0; i < nLength; ++i)
     {
+        bool bEnvelopeAlreadySet = false;
+        if (psBBox)
+        {
+            if (psBBox->abyStatus[i] == OGRArrowBBoxColumn::DISJOINT)
+                continue;
+            if (psBBox->abyStatus[i] == OGRArrowBBoxColumn::INTERSECTS)
+            {
+                psBBox->GetEnvelope(i, sEnvelope);
+                bEnvelopeAlreadySet = true;
+            }
+        }
         if (!pabyValidity || TestBit(pabyValidity, i + nOffset))
         {
             const GByte *pabyWKB = pabyData + panOffsets[i];
             const size_t nWKBSize =
                 static_cast<size_t>(panOffsets[i + 1] - panOffsets[i]);
             if (poLayer->FilterWKBGeometry(pabyWKB, nWKBSize,
-                                           /* bEnvelopeAlreadySet=*/false,
-                                           sEnvelope))
+                                           bEnvelopeAlreadySet, sEnvelope))
             {
                 abyValidityFromFilters[i] = true;
                 nCountIntersecting++;
@@ -4638,6 +5268,245 @@ static bool SetFieldForOtherFormats(OGRFeature &oFeature,
     return true;
 }
 
+/************************************************************************/
+/*                  FillProgramColumnFromArrowArray()                   */
+/************************************************************************/
+
+template <class T>
+static void FillProgramColumnInteger(const struct ArrowArray *psArray,
+                                     size_t nLength,
+                                     std::vector<GIntBig> &anValues)
+{
+    const T *paValues =
+        static_cast<const T *>(psArray->buffers[1]) + psArray->offset;
+    for (size_t i = 0; i < nLength; ++i)
+        anValues[i] = static_cast<GIntBig>(paValues[i]);
+}
+
+template <class T>
+static void FillProgramColumnFloat(const struct ArrowArray *psArray,
+                                   size_t nLength, std::vector<double> &adfValues)
+{
+    const T *paValues =
+        static_cast<const T *>(psArray->buffers[1]) + psArray->offset;
+    for (size_t i = 0; i < nLength; ++i)
+        adfValues[i] = static_cast<double>(paValues[i]);
+}
+
+template <class OffsetType>
+static void FillProgramColumnString(const struct ArrowArray *psArray,
+                                    size_t nLength,
+                                    swq_program::ColumnValues &oValues)
+{
+    const OffsetType *panOffsets =
+        static_cast<const OffsetType *>(psArray->buffers[1]) + psArray->offset;
+    const char *pabyData = static_cast<const char *>(psArray->buffers[2]);
+    oValues.apszValues.resize(nLength);
+    oValues.anLengths.resize(nLength);
+    for (size_t i = 0; i < nLength; ++i)
+    {
+        const char *pszStr = pabyData + static_cast<size_t>(panOffsets[i]);
+        oValues.apszValues[i] = pszStr;
+        // Values are evaluated as C strings by OGRFeatureQuery
+        oValues.anLengths[i] =
+            oValues.abyIsNull[i]
+                ? 0
+                : strnlen(pszStr,
+                          static_cast<size_t>(panOffsets[i + 1] - panOffsets[i]));
+    }
+    oValues.bNulTerminated = false;
+}
+
+/** Fills the values of a column of a swq_program from an Arrow array, with
+ * the same values as the OGRFeature built by FillValidityArrayFromAttrQuery()
+ * would have. Returns false for formats that are not handled. */
+static bool
+FillProgramColumnFromArrowArray(const swq_program::Column &oColumn,
+                                const struct ArrowSchema *psSchema,
+                                const struct ArrowArray *psArray,
+                                size_t nLength,
+                                swq_program::ColumnValues &oValues)
+{
+    if (psSchema->dictionary)
+        return false;
+
+    const char *format = psSchema->format;
+    const uint8_t *pabyValidity =
+        psArray->null_count == 0
+            ? nullptr
+            : static_cast<const uint8_t *>(psArray->buffers[0]);
+    const size_t nOffset = static_cast<size_t>(psArray->offset);
+    oValues.abyIsNull.resize(nLength);
+    for (size_t i = 0; i < nLength; ++i)
+    {
+        oValues.abyIsNull[i] = static_cast<GByte>(
+            pabyValidity != nullptr && !TestBit(pabyValidity, i + nOffset));
+    }
+
+    switch (oColumn.value_type)
+    {
+        case SWQ_NULL:
+            return true;
+
+        case SWQ_INTEGER64:
+        {
+            // OGRFeatureFetcher() uses GetFieldAsInteger() for columns that
+            // are not SWQ_INTEGER64, so avoid formats that would be clamped.
+            const bool bIsInt64 = oColumn.field_type == SWQ_INTEGER64;
+            auto &anValues = oValues.anValues;
+            anValues.resize(nLength);
+            if (IsBoolean(format))
+            {
+                const uint8_t *pabyData =
+                    static_cast<const uint8_t *>(psArray->buffers[1]);
+                for (size_t i = 0; i < nLength; ++i)
+                    anValues[i] = TestBit(pabyData, i + nOffset) ? 1 : 0;
+            }
+            else if (IsInt8(format))
+                FillProgramColumnInteger<int8_t>(psArray, nLength, anValues);
+            else if (IsUInt8(format))
+                FillProgramColumnInteger<uint8_t>(psArray, nLength, anValues);
+            else if (IsInt16(format))
+                FillProgramColumnInteger<int16_t>(psArray, nLength, anValues);
+            else if (IsUInt16(format))
+                FillProgramColumnInteger<uint16_t>(psArray, nLength, anValues);
+            else if (IsInt32(format))
+                FillProgramColumnInteger<int32_t>(psArray, nLength, anValues);
+            else if (bIsInt64 && IsUInt32(format))
+                FillProgramColumnInteger<uint32_t>(psArray, nLength, anValues);
+            else if (bIsInt64 && IsInt64(format))
+                FillProgramColumnInteger<int64_t>(psArray, nLength, anValues);
+            else
+                return false;
+            return true;
+        }
+
+        case SWQ_FLOAT:
+        {
+            oValues.adfValues.resize(nLength);
+            if (IsFloat32(format))
+                FillProgramColumnFloat<float>(psArray, nLength,
+                                              oValues.adfValues);
+            else if (IsFloat64(format))
+                FillProgramColumnFloat<double>(psArray, nLength,
+                                               oValues.adfValues);
+            else
+                return false;
+            return true;
+        }
+
+        case SWQ_STRING:
+        {
+            if (IsString(format))
+                FillProgramColumnString<uint32_t>(psArray, nLength, oValues);
+            else if (IsLargeString(format))
+                FillProgramColumnString<uint64_t>(psArray, nLength, oValues);
+            else
+                return false;
+            return true;
+        }
+
+        default:
+            break;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                FillValidityArrayFromAttrQueryProgram()               */
+/************************************************************************/
+
+/** Evaluates the compiled form of the attribute filter directly over the
+ * Arrow columns, without building an OGRFeature for each row.
+ * Returns false if the columns used by the filter are not all handled, in
+ * which case FillValidityArrayFromAttrQuery() must use the generic path. */
+static bool FillValidityArrayFromAttrQueryProgram(
+    OGRFeatureDefn *poFeatureDefn, OGRFeatureQuery *poAttrQuery,
+    const struct ArrowSchema *schema, const struct ArrowArray *array,
+    const std::map<std::string, std::vector<int>> &oMapFieldNameToArrowPath,
+    GIntBig nBaseSeqFID, const std::vector<int> &anArrowPathToFIDColumn,
+    std::vector<bool> &abyValidityFromFilters, size_t &nCountIntersecting)
+{
+    swq_program *poProgram = poAttrQuery->GetProgram();
+    if (poProgram == nullptr)
+        return false;
+
+    const size_t nLength = abyValidityFromFilters.size();
+    const int nFieldCount = poFeatureDefn->GetFieldCount();
+    const auto &aoColumns = poProgram->GetColumns();
+    swq_program::Scratch oScratch;
+    oScratch.aoColumns.resize(aoColumns.size());
+    for (size_t iCol = 0; iCol < aoColumns.size(); ++iCol)
+    {
+        const auto &oColumn = aoColumns[iCol];
+        auto &oValues = oScratch.aoColumns[iCol];
+        if (oColumn.field_index >= nFieldCount && nBaseSeqFID >= 0)
+        {
+            oValues.abyIsNull.clear();
+            oValues.abyIsNull.resize(nLength, 0);
+            oValues.anValues.resize(nLength);
+            for (size_t i = 0; i < nLength; ++i)
+                oValues.anValues[i] = nBaseSeqFID + static_cast<GIntBig>(i);
+        }
+        else
+        {
+            // Only top-level Arrow columns are handled
+            const std::vector<int> *panArrowPath = nullptr;
+            if (oColumn.field_index >= nFieldCount)
+            {
+                panArrowPath = &anArrowPathToFIDColumn;
+            }
+            else
+            {
+                const auto oIter = oMapFieldNameToArrowPath.find(
+                    poFeatureDefn->GetFieldDefn(oColumn.field_index)
+                        ->GetNameRef());
+                if (oIter != oMapFieldNameToArrowPath.end())
+                    panArrowPath = &(oIter->second);
+            }
+            if (panArrowPath == nullptr || panArrowPath->size() != 1)
+                return false;
+            const int iChild = (*panArrowPath)[0];
+            if (!FillProgramColumnFromArrowArray(
+                    oColumn, schema->children[iChild], array->children[iChild],
+                    nLength, oValues))
+            {
+                return false;
+            }
+        }
+
+        // GetFieldAsInteger() clamps the FID to the int range
+        if (oColumn.field_index >= nFieldCount &&
+            oColumn.value_type == SWQ_INTEGER64 &&
+            oColumn.field_type != SWQ_INTEGER64)
+        {
+            for (auto &nVal : oValues.anValues)
+            {
+                nVal = std::max<GIntBig>(
+                    std::min<GIntBig>(nVal, std::numeric_limits<int>::max()),
+                    std::numeric_limits<int>::min());
+            }
+        }
+    }
+
+    std::vector<GByte> abyResult(nLength);
+    poProgram->Evaluate(nLength, oScratch.aoColumns,
+                        poAttrQuery->GetEvaluationContext(), oScratch,
+                        abyResult.data());
+
+    nCountIntersecting = 0;
+    for (size_t iRow = 0; iRow < nLength; ++iRow)
+    {
+        if (!abyValidityFromFilters[iRow])
+            continue;
+        if (abyResult[iRow])
+            nCountIntersecting++;
+        else
+            abyValidityFromFilters[iRow] = false;
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                 FillValidityArrayFromAttrQuery()                     */
 /************************************************************************/
@@ -4749,6 +5618,14 @@ static size_t FillValidityArrayFromAttrQuery(
         }
     }
 
+    if (FillValidityArrayFromAttrQueryProgram(
+            poFeatureDefn, poAttrQuery, schema, array, oMapFieldNameToArrowPath,
+            nBaseSeqFID, anArrowPathToFIDColumn, abyValidityFromFilters,
+            nCountIntersecting))
+    {
+        return nCountIntersecting;
+    }
+
     for (size_t iRow = 0; iRow < nLength; ++iRow)
     {
         if (!abyValidityFromFilters[iRow])
@@ -5056,6 +5933,8 @@ void OGRLayer::PostFilterArrowArray(const struct ArrowSchema *schema,
     CPLAssert(schema->n_children == array->n_children);
 
     int64_t iGeomField = -1;
+    OGRArrowBBoxColumn oBBox;
+    const OGRArrowBBoxColumn *psBBox = nullptr;
     if (m_poFilterGeom)
     {
         const char *pszGeomFieldName =
@@ -5079,6 +5958,26 @@ void OGRLayer::PostFilterArrowArray(const struct ArrowSchema *schema,
         CPLAssert(IsBinary(schema->children[iGeomField]->format) ||
                   IsLargeBinary(schema->children[iGeomField]->format));
         CPLAssert(array->children[iGeomField]->n_buffers == 3);
+
+        // Look for a bounding box column associated with the geometry column:
+        // either "{geom_name}_bbox", or "bbox" when there is a single
+        // geometry column.
+        const std::string osBBoxName = std::string(pszGeomFieldName) + "_bbox";
+        const bool bSingleGeomField =
+            const_cast<OGRLayer *>(this)->GetLayerDefn()->GetGeomFieldCount() ==
+            1;
+        for (int64_t iField = 0; iField < schema->n_children; ++iField)
+        {
+            const char *pszName = schema->children[iField]->name;
+            if ((osBBoxName == pszName ||
+                 (bSingleGeomField && strcmp(pszName, "bbox") == 0)) &&
+                oBBox.Init(schema->children[iField], array->children[iField]))
+            {
+                oBBox.ComputeStatus(m_sFilterEnvelope);
+                psBBox = &oBBox;
+                break;
+            }
+        }
     }
 
     std::vector<bool> abyValidityFromFilters;
@@ -5086,10 +5985,10 @@ void OGRLayer::PostFilterArrowArray(const struct ArrowSchema *schema,
     const size_t nCountIntersectingGeom =
         m_poFilterGeom ? (IsBinary(schema->children[iGeomField]->format)
                               ? FillValidityArrayFromWKBArray<uint32_t>(
-                                    array->children[iGeomField], this,
+                                    array->children[iGeomField], this, psBBox,
                                     abyValidityFromFilters)
                               : FillValidityArrayFromWKBArray<uint64_t>(
-                                    array->children[iGeomField], this,
+                                    array->children[iGeomField], this, psBBox,
                                     abyValidityFromFilters))
                        : nLength;
     if (!m_poFilterGeom)
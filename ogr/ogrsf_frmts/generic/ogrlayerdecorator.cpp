@@ -354,6 +354,13 @@ OGRErr OGRLayerDecorator::SetIgnoredFields(const char **papszFields)
     return m_poDecoratedLayer->SetIgnoredFields(papszFields);
 }
 
+CPLStringList OGRLayerDecorator::ExplainQuery()
+{
+    if (!m_poDecoratedLayer)
+        return CPLStringList();
+    return m_poDecoratedLayer->ExplainQuery();
+}
+
 char **OGRLayerDecorator::GetMetadata(const char *pszDomain)
 {
     if (!m_poDecoratedLayer)
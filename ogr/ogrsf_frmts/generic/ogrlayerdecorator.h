@@ -117,6 +117,7 @@ class CPL_DLL OGRLayerDecorator : public OGRLayer
     virtual const char *GetGeometryColumn() override;
 
     virtual OGRErr SetIgnoredFields(const char **papszFields) override;
+    virtual CPLStringList ExplainQuery() override;
 
     virtual char **GetMetadata(const char *pszDomain = "") override;
     virtual CPLErr SetMetadata(char **papszMetadata,
@@ -51,6 +51,24 @@ OGRAbstractProxiedLayer::~OGRAbstractProxiedLayer()
     poPool->UnchainLayer(this);
 }
 
+/************************************************************************/
+/*                                Pin()                                 */
+/************************************************************************/
+
+void OGRAbstractProxiedLayer::Pin()
+{
+    poPool->PinLayer(this, true);
+}
+
+/************************************************************************/
+/*                               Unpin()                                */
+/************************************************************************/
+
+void OGRAbstractProxiedLayer::Unpin()
+{
+    poPool->PinLayer(this, false);
+}
+
 /************************************************************************/
 /*                            OGRLayerPool()                            */
 /************************************************************************/
@@ -78,6 +96,8 @@ OGRLayerPool::~OGRLayerPool()
 
 void OGRLayerPool::SetLastUsedLayer(OGRAbstractProxiedLayer *poLayer)
 {
+    std::lock_guard<std::recursive_mutex> oLock(oMutex);
+
     /* If we are already the MRU layer, nothing to do */
     if (poLayer == poMRULayer)
         return;
@@ -89,15 +109,22 @@ void OGRLayerPool::SetLastUsedLayer(OGRAbstractProxiedLayer *poLayer)
         /* Remove current layer from its current place in the list */
         UnchainLayer(poLayer);
     }
-    else if (nMRUListSize == nMaxSimultaneouslyOpened)
+    else if (nMRUListSize >= nMaxSimultaneouslyOpened)
     {
         /* If we have reached the maximum allowed number of layers */
         /* simultaneously opened, then close the LRU one that */
-        /* was still active until now */
+        /* was still active until now and is not pinned. If all */
+        /* are pinned, temporarily exceed the maximum. */
         CPLAssert(poLRULayer != nullptr);
 
-        poLRULayer->CloseUnderlyingLayer();
-        UnchainLayer(poLRULayer);
+        OGRAbstractProxiedLayer *poLayerToClose = poLRULayer;
+        while (poLayerToClose != nullptr && poLayerToClose->nPinCount > 0)
+            poLayerToClose = poLayerToClose->poPrevLayer;
+        if (poLayerToClose != nullptr)
+        {
+            poLayerToClose->CloseUnderlyingLayer();
+            UnchainLayer(poLayerToClose);
+        }
     }
 
     /* Put current layer on top of MRU list */
@@ -121,6 +148,8 @@ void OGRLayerPool::SetLastUsedLayer(OGRAbstractProxiedLayer *poLayer)
 
 void OGRLayerPool::UnchainLayer(OGRAbstractProxiedLayer *poLayer)
 {
+    std::lock_guard<std::recursive_mutex> oLock(oMutex);
+
     OGRAbstractProxiedLayer *poPrevLayer = poLayer->poPrevLayer;
     OGRAbstractProxiedLayer *poNextLayer = poLayer->poNextLayer;
 
@@ -143,6 +172,23 @@ void OGRLayerPool::UnchainLayer(OGRAbstractProxiedLayer *poLayer)
     poLayer->poNextLayer = nullptr;
 }
 
+/************************************************************************/
+/*                              PinLayer()                              */
+/************************************************************************/
+
+void OGRLayerPool::PinLayer(OGRAbstractProxiedLayer *poLayer, bool bPin)
+{
+    std::lock_guard<std::recursive_mutex> oLock(oMutex);
+
+    if (bPin)
+        poLayer->nPinCount++;
+    else
+    {
+        CPLAssert(poLayer->nPinCount > 0);
+        poLayer->nPinCount--;
+    }
+}
+
 /************************************************************************/
 /*                          OGRProxiedLayer()                           */
 /************************************************************************/
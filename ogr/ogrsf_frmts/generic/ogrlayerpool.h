@@ -34,6 +34,8 @@
 
 #include "ogrsf_frmts.h"
 
+#include <mutex>
+
 typedef OGRLayer *(*OpenLayerFunc)(void *user_data);
 typedef void (*FreeUserDataFunc)(void *user_data);
 
@@ -53,6 +55,7 @@ class CPL_DLL OGRAbstractProxiedLayer : public OGRLayer
         *poPrevLayer; /* Chain to a layer that was used more recently */
     OGRAbstractProxiedLayer
         *poNextLayer; /* Chain to a layer that was used less recently */
+    int nPinCount = 0; /* Number of Pin() calls not balanced by Unpin() */
 
   protected:
     OGRLayerPool *poPool;
@@ -62,6 +65,10 @@ class CPL_DLL OGRAbstractProxiedLayer : public OGRLayer
   public:
     explicit OGRAbstractProxiedLayer(OGRLayerPool *poPool);
     virtual ~OGRAbstractProxiedLayer();
+
+    /* While pinned, the underlying layer is not closed by the pool */
+    void Pin();
+    void Unpin();
 };
 
 /************************************************************************/
@@ -78,6 +85,8 @@ class CPL_DLL OGRLayerPool
         *poLRULayer;  /* the least recently used layer (still opened) */
     int nMRUListSize; /* the size of the list */
     int nMaxSimultaneouslyOpened;
+    /* Layers may be opened from worker threads (see OGRUnionLayer) */
+    std::recursive_mutex oMutex{};
 
   public:
     explicit OGRLayerPool(int nMaxSimultaneouslyOpened = 100);
@@ -85,6 +94,7 @@ class CPL_DLL OGRLayerPool
 
     void SetLastUsedLayer(OGRAbstractProxiedLayer *poProxiedLayer);
     void UnchainLayer(OGRAbstractProxiedLayer *poProxiedLayer);
+    void PinLayer(OGRAbstractProxiedLayer *poProxiedLayer, bool bPin);
 
     int GetMaxSimultaneouslyOpened() const
     {
@@ -29,8 +29,70 @@
 #ifndef DOXYGEN_SKIP
 
 #include "ogrunionlayer.h"
+#include "ogrlayerpool.h"
 #include "ogrwarpedlayer.h"
 #include "ogr_p.h"
+#include "cpl_worker_thread_pool.h"
+
+#include <algorithm>
+#include <string>
+
+// Number of features of a source layer read ahead by a prefetch job
+constexpr int PREFETCH_FEATURE_COUNT = 1000;
+
+/************************************************************************/
+/*                      OGRUnionLayer::PrefetchJob                      */
+/*                                                                      */
+/*      Opening and configuration of a source layer, and reading of     */
+/*      its first features, done in a worker thread while the           */
+/*      previous source layers are read.                                */
+/************************************************************************/
+
+struct OGRUnionLayer::PrefetchJob
+{
+    OGRUnionLayer *poLayer = nullptr;
+    int iSubLayer = 0;
+    std::unique_ptr<CPLJobQueue> poQueue{};
+    std::vector<std::unique_ptr<OGRFeature>> apoFeatures{};
+    size_t iNextFeature = 0;
+    bool bEOF = false;
+
+    // Errors emitted in the worker thread, re-emitted in the thread that
+    // consumes the features.
+    struct ErrorMsg
+    {
+        CPLErr eErr;
+        CPLErrorNum nNo;
+        std::string osMsg;
+    };
+    std::vector<ErrorMsg> aoErrors{};
+
+    static void CPL_STDCALL ErrorHandler(CPLErr eErr, CPLErrorNum nNo,
+                                         const char *pszMsg)
+    {
+        auto psJob = static_cast<PrefetchJob *>(CPLGetErrorHandlerUserData());
+        psJob->aoErrors.push_back(ErrorMsg{eErr, nNo, pszMsg});
+    }
+
+    static void Run(void *pData)
+    {
+        auto psJob = static_cast<PrefetchJob *>(pData);
+        CPLPushErrorHandlerEx(ErrorHandler, psJob);
+        psJob->poLayer->PrepareSrcLayer(psJob->iSubLayer);
+        OGRLayer *poSrcLayer = psJob->poLayer->papoSrcLayers[psJob->iSubLayer];
+        for (int i = 0; i < PREFETCH_FEATURE_COUNT; i++)
+        {
+            OGRFeature *poSrcFeature = poSrcLayer->GetNextFeature();
+            if (poSrcFeature == nullptr)
+            {
+                psJob->bEOF = true;
+                break;
+            }
+            psJob->apoFeatures.emplace_back(poSrcFeature);
+        }
+        CPLPopErrorHandler();
+    }
+};
 
 /************************************************************************/
 /*                      OGRUnionLayerGeomFieldDefn()                    */
@@ -104,6 +166,9 @@ OGRUnionLayer::OGRUnionLayer(const char *pszName, int nSrcLayersIn,
 
 OGRUnionLayer::~OGRUnionLayer()
 {
+    StopPrefetch();
+    ReleaseCurLayerPrefetch();
+
     if (bHasLayerOwnership)
     {
         for (int i = 0; i < nSrcLayers; i++)
@@ -197,6 +262,28 @@ void OGRUnionLayer::SetFeatureCount(int nFeatureCountIn)
     nFeatureCount = nFeatureCountIn;
 }
 
+/************************************************************************/
+/*                          SetPrefetchDepth()                          */
+/************************************************************************/
+
+void OGRUnionLayer::SetPrefetchDepth(int nDepth)
+{
+    CPLAssert(poFeatureDefn == nullptr);
+
+    m_nPrefetchDepth = nSrcLayers > 1 ? std::min(std::max(0, nDepth), 128) : 0;
+    m_apoProxiedSrcLayers.clear();
+    if (m_nPrefetchDepth > 0)
+    {
+        // Layers managed by a OGRLayerPool must be pinned while they are
+        // read, so that opening the next ones doesn't close them.
+        for (int i = 0; i < nSrcLayers; i++)
+        {
+            m_apoProxiedSrcLayers.push_back(
+                dynamic_cast<OGRAbstractProxiedLayer *>(papoSrcLayers[i]));
+        }
+    }
+}
+
 /************************************************************************/
 /*                         MergeFieldDefn()                             */
 /************************************************************************/
@@ -503,38 +590,25 @@ void OGRUnionLayer::SetSpatialFilterToSourceLayer(OGRLayer *poSrcLayer)
 }
 
 /************************************************************************/
-/*                        ConfigureActiveLayer()                        */
+/*                          PrepareSrcLayer()                           */
+/*                                                                      */
+/*      Apply the filters and ignored fields of the union layer to a    */
+/*      source layer and rewind it. May be called from a worker         */
+/*      thread, for a source layer not used by other threads.           */
 /************************************************************************/
 
-void OGRUnionLayer::ConfigureActiveLayer()
+void OGRUnionLayer::PrepareSrcLayer(int iSubLayer)
 {
-    AutoWarpLayerIfNecessary(iCurLayer);
-    ApplyAttributeFilterToSrcLayer(iCurLayer);
-    SetSpatialFilterToSourceLayer(papoSrcLayers[iCurLayer]);
-    papoSrcLayers[iCurLayer]->ResetReading();
+    AutoWarpLayerIfNecessary(iSubLayer);
+    ApplyAttributeFilterToSrcLayer(iSubLayer);
+    OGRLayer *poSrcLayer = papoSrcLayers[iSubLayer];
+    SetSpatialFilterToSourceLayer(poSrcLayer);
+    poSrcLayer->ResetReading();
 
-    /* Establish map */
     GetLayerDefn();
-    OGRFeatureDefn *poSrcFeatureDefn = papoSrcLayers[iCurLayer]->GetLayerDefn();
-    CPLFree(panMap);
-    panMap = static_cast<int *>(
-        CPLMalloc(poSrcFeatureDefn->GetFieldCount() * sizeof(int)));
-    for (int i = 0; i < poSrcFeatureDefn->GetFieldCount(); i++)
-    {
-        OGRFieldDefn *poSrcFieldDefn = poSrcFeatureDefn->GetFieldDefn(i);
-        if (CSLFindString(papszIgnoredFields, poSrcFieldDefn->GetNameRef()) ==
-            -1)
-        {
-            panMap[i] =
-                poFeatureDefn->GetFieldIndex(poSrcFieldDefn->GetNameRef());
-        }
-        else
-        {
-            panMap[i] = -1;
-        }
-    }
+    OGRFeatureDefn *poSrcFeatureDefn = poSrcLayer->GetLayerDefn();
 
-    if (papoSrcLayers[iCurLayer]->TestCapability(OLCIgnoreFields))
+    if (poSrcLayer->TestCapability(OLCIgnoreFields))
     {
         char **papszIter = papszIgnoredFields;
         char **papszFieldsSrc = nullptr;
@@ -601,19 +675,79 @@ void OGRUnionLayer::ConfigureActiveLayer()
         }
         CPLFree(panSrcFieldsUsed);
 
-        papoSrcLayers[iCurLayer]->SetIgnoredFields(
+        poSrcLayer->SetIgnoredFields(
             const_cast<const char **>(papszFieldsSrc));
 
         CSLDestroy(papszFieldsSrc);
     }
 }
 
+/************************************************************************/
+/*                        ConfigureActiveLayer()                        */
+/************************************************************************/
+
+void OGRUnionLayer::ConfigureActiveLayer()
+{
+    if (m_iPinnedCurLayer >= 0)
+    {
+        PinSrcLayer(m_iPinnedCurLayer, false);
+        m_iPinnedCurLayer = -1;
+    }
+
+    auto oIter = m_oMapPrefetchJobs.find(iCurLayer);
+    if (oIter != m_oMapPrefetchJobs.end())
+    {
+        // The source layer has already been configured by a prefetch job,
+        // which also holds a pin on it.
+        m_poCurLayerPrefetch = std::move(oIter->second);
+        m_oMapPrefetchJobs.erase(oIter);
+        m_poCurLayerPrefetch->poQueue->WaitCompletion();
+        for (const auto &sError : m_poCurLayerPrefetch->aoErrors)
+            CPLError(sError.eErr, sError.nNo, "%s", sError.osMsg.c_str());
+        m_poCurLayerPrefetch->aoErrors.clear();
+        m_iPinnedCurLayer = iCurLayer;
+    }
+    else
+    {
+        m_poCurLayerPrefetch.reset();
+        if (m_nPrefetchDepth > 0)
+        {
+            PinSrcLayer(iCurLayer, true);
+            m_iPinnedCurLayer = iCurLayer;
+        }
+        PrepareSrcLayer(iCurLayer);
+    }
+
+    /* Establish map */
+    GetLayerDefn();
+    OGRFeatureDefn *poSrcFeatureDefn = papoSrcLayers[iCurLayer]->GetLayerDefn();
+    CPLFree(panMap);
+    panMap = static_cast<int *>(
+        CPLMalloc(poSrcFeatureDefn->GetFieldCount() * sizeof(int)));
+    for (int i = 0; i < poSrcFeatureDefn->GetFieldCount(); i++)
+    {
+        OGRFieldDefn *poSrcFieldDefn = poSrcFeatureDefn->GetFieldDefn(i);
+        if (CSLFindString(papszIgnoredFields, poSrcFieldDefn->GetNameRef()) ==
+            -1)
+        {
+            panMap[i] =
+                poFeatureDefn->GetFieldIndex(poSrcFieldDefn->GetNameRef());
+        }
+        else
+        {
+            panMap[i] = -1;
+        }
+    }
+}
+
 /************************************************************************/
 /*                             ResetReading()                           */
 /************************************************************************/
 
 void OGRUnionLayer::ResetReading()
 {
+    StopPrefetch();
+    ReleaseCurLayerPrefetch();
     iCurLayer = 0;
     ConfigureActiveLayer();
     nNextFID = 0;
@@ -686,6 +820,128 @@ void OGRUnionLayer::AutoWarpLayerIfNecessary(int iLayer)
     }
 }
 
+/************************************************************************/
+/*                            PinSrcLayer()                             */
+/************************************************************************/
+
+void OGRUnionLayer::PinSrcLayer(int iSubLayer, bool bPin)
+{
+    if (iSubLayer < static_cast<int>(m_apoProxiedSrcLayers.size()) &&
+        m_apoProxiedSrcLayers[iSubLayer] != nullptr)
+    {
+        if (bPin)
+            m_apoProxiedSrcLayers[iSubLayer]->Pin();
+        else
+            m_apoProxiedSrcLayers[iSubLayer]->Unpin();
+    }
+}
+
+/************************************************************************/
+/*                           LaunchPrefetch()                           */
+/*                                                                      */
+/*      Start prefetch jobs for the source layers following the        */
+/*      current one, up to the prefetch depth.                          */
+/************************************************************************/
+
+void OGRUnionLayer::LaunchPrefetch()
+{
+    if (m_nPrefetchDepth <= 0 || iCurLayer < 0)
+        return;
+
+    const int iLastLayer =
+        std::min(nSrcLayers - 1, iCurLayer + m_nPrefetchDepth);
+    if (iCurLayer == iLastLayer ||
+        m_oMapPrefetchJobs.find(iLastLayer) != m_oMapPrefetchJobs.end())
+        return;
+
+    if (m_poPrefetchPool == nullptr)
+    {
+        m_poPrefetchPool = std::make_unique<CPLWorkerThreadPool>();
+        if (!m_poPrefetchPool->Setup(m_nPrefetchDepth, nullptr, nullptr))
+        {
+            m_poPrefetchPool.reset();
+            m_nPrefetchDepth = 0;
+            return;
+        }
+    }
+
+    // Must be evaluated before worker threads use them.
+    GetLayerDefn();
+    GetAttrFilterPassThroughValue();
+
+    for (int i = iCurLayer + 1; i <= iLastLayer; i++)
+    {
+        if (m_oMapPrefetchJobs.find(i) != m_oMapPrefetchJobs.end())
+            continue;
+
+        auto poJob = std::make_shared<PrefetchJob>();
+        poJob->poLayer = this;
+        poJob->iSubLayer = i;
+        poJob->poQueue = m_poPrefetchPool->CreateJobQueue();
+        PinSrcLayer(i, true);
+        if (!poJob->poQueue->SubmitJob(PrefetchJob::Run, poJob.get()))
+        {
+            PinSrcLayer(i, false);
+            break;
+        }
+        m_oMapPrefetchJobs[i] = std::move(poJob);
+    }
+}
+
+/************************************************************************/
+/*                            StopPrefetch()                            */
+/*                                                                      */
+/*      Wait for pending prefetch jobs and discard their results.       */
+/*      Must be called before any operation on the source layers        */
+/*      other than reading the current one.                             */
+/************************************************************************/
+
+void OGRUnionLayer::StopPrefetch()
+{
+    for (auto &oIter : m_oMapPrefetchJobs)
+    {
+        oIter.second->poQueue->WaitCompletion();
+        PinSrcLayer(oIter.first, false);
+    }
+    m_oMapPrefetchJobs.clear();
+}
+
+/************************************************************************/
+/*                      ReleaseCurLayerPrefetch()                       */
+/************************************************************************/
+
+void OGRUnionLayer::ReleaseCurLayerPrefetch()
+{
+    m_poCurLayerPrefetch.reset();
+    if (m_iPinnedCurLayer >= 0)
+    {
+        PinSrcLayer(m_iPinnedCurLayer, false);
+        m_iPinnedCurLayer = -1;
+    }
+}
+
+/************************************************************************/
+/*                         GetNextSrcFeature()                          */
+/************************************************************************/
+
+OGRFeature *OGRUnionLayer::GetNextSrcFeature()
+{
+    if (m_poCurLayerPrefetch)
+    {
+        auto &apoFeatures = m_poCurLayerPrefetch->apoFeatures;
+        if (m_poCurLayerPrefetch->iNextFeature < apoFeatures.size())
+        {
+            return apoFeatures[m_poCurLayerPrefetch->iNextFeature++]
+                .release();
+        }
+        const bool bEOF = m_poCurLayerPrefetch->bEOF;
+        m_poCurLayerPrefetch.reset();
+        if (bEOF)
+            return nullptr;
+    }
+    return papoSrcLayers[iCurLayer]->GetNextFeature();
+}
+
 /************************************************************************/
 /*                           GetNextFeature()                           */
 /************************************************************************/
@@ -700,19 +956,25 @@ OGRFeature *OGRUnionLayer::GetNextFeature()
     if (iCurLayer == nSrcLayers)
         return nullptr;
 
+    LaunchPrefetch();
+
     while (true)
     {
-        OGRFeature *poSrcFeature = papoSrcLayers[iCurLayer]->GetNextFeature();
+        OGRFeature *poSrcFeature = GetNextSrcFeature();
         if (poSrcFeature == nullptr)
         {
             iCurLayer++;
             if (iCurLayer < nSrcLayers)
             {
                 ConfigureActiveLayer();
+                LaunchPrefetch();
                 continue;
             }
             else
+            {
+                ReleaseCurLayerPrefetch();
                 break;
+            }
         }
 
         OGRFeature *poFeature = TranslateFromSrcLayer(poSrcFeature);
@@ -736,6 +998,8 @@ OGRFeature *OGRUnionLayer::GetNextFeature()
 
 OGRFeature *OGRUnionLayer::GetFeature(GIntBig nFeatureId)
 {
+    StopPrefetch();
+
     OGRFeature *poFeature = nullptr;
 
     if (!bPreserveSrcFID)
@@ -779,6 +1043,8 @@ OGRFeature *OGRUnionLayer::GetFeature(GIntBig nFeatureId)
 
 OGRErr OGRUnionLayer::ICreateFeature(OGRFeature *poFeature)
 {
+    StopPrefetch();
+
     if (osSourceLayerFieldName.empty())
     {
         CPLError(CE_Failure, CPLE_NotSupported,
@@ -832,6 +1098,8 @@ OGRErr OGRUnionLayer::ICreateFeature(OGRFeature *poFeature)
 
 OGRErr OGRUnionLayer::ISetFeature(OGRFeature *poFeature)
 {
+    StopPrefetch();
+
     if (!bPreserveSrcFID)
     {
         CPLError(CE_Failure, CPLE_NotSupported,
@@ -891,6 +1159,8 @@ OGRErr OGRUnionLayer::ISetFeature(OGRFeature *poFeature)
 
 OGRErr OGRUnionLayer::IUpsertFeature(OGRFeature *poFeature)
 {
+    StopPrefetch();
+
     if (GetFeature(poFeature->GetFID()))
     {
         return ISetFeature(poFeature);
@@ -912,6 +1182,8 @@ OGRErr OGRUnionLayer::IUpdateFeature(OGRFeature *poFeature,
                                      const int *panUpdatedGeomFieldsIdx,
                                      bool bUpdateStyleString)
 {
+    StopPrefetch();
+
     if (!bPreserveSrcFID)
     {
         CPLError(CE_Failure, CPLE_NotSupported,
@@ -1091,6 +1363,8 @@ void OGRUnionLayer::ApplyAttributeFilterToSrcLayer(int iSubLayer)
 
 GIntBig OGRUnionLayer::GetFeatureCount(int bForce)
 {
+    StopPrefetch();
+
     if (nFeatureCount >= 0 && m_poFilterGeom == nullptr &&
         m_poAttrQuery == nullptr)
     {
@@ -1127,6 +1401,8 @@ OGRErr OGRUnionLayer::SetAttributeFilter(const char *pszAttributeFilterIn)
     if (poFeatureDefn == nullptr)
         GetLayerDefn();
 
+    StopPrefetch();
+
     bAttrFilterPassThroughValue = -1;
 
     OGRErr eErr = OGRLayer::SetAttributeFilter(pszAttributeFilterIn);
@@ -1149,6 +1425,8 @@ OGRErr OGRUnionLayer::SetAttributeFilter(const char *pszAttributeFilterIn)
 
 int OGRUnionLayer::TestCapability(const char *pszCap)
 {
+    StopPrefetch();
+
     if (EQUAL(pszCap, OLCFastFeatureCount))
     {
         if (nFeatureCount >= 0 && m_poFilterGeom == nullptr &&
@@ -1260,6 +1538,8 @@ int OGRUnionLayer::TestCapability(const char *pszCap)
 OGRErr OGRUnionLayer::GetExtent(int iGeomField, OGREnvelope *psExtent,
                                 int bForce)
 {
+    StopPrefetch();
+
     if (iGeomField >= 0 && iGeomField < nGeomFields &&
         papoGeomFields[iGeomField]->sStaticEnvelope.IsInit())
     {
@@ -1329,6 +1609,8 @@ void OGRUnionLayer::SetSpatialFilter(OGRGeometry *poGeomIn)
 
 void OGRUnionLayer::SetSpatialFilter(int iGeomField, OGRGeometry *poGeom)
 {
+    StopPrefetch();
+
     if (iGeomField < 0 || iGeomField >= GetLayerDefn()->GetGeomFieldCount())
     {
         if (poGeom != nullptr)
@@ -1395,6 +1677,8 @@ OGRFeature *OGRUnionLayer::TranslateFromSrcLayer(OGRFeature *poSrcFeature)
 
 OGRErr OGRUnionLayer::SetIgnoredFields(const char **papszFields)
 {
+    StopPrefetch();
+
     OGRErr eErr = OGRLayer::SetIgnoredFields(papszFields);
     if (eErr != OGRERR_NONE)
         return eErr;
@@ -1411,6 +1695,8 @@ OGRErr OGRUnionLayer::SetIgnoredFields(const char **papszFields)
 
 OGRErr OGRUnionLayer::SyncToDisk()
 {
+    StopPrefetch();
+
     for (int i = 0; i < nSrcLayers; i++)
     {
         if (pabModifiedLayers[i])
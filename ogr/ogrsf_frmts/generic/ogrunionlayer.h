@@ -34,6 +34,13 @@
 
 #include "ogrsf_frmts.h"
 
+#include <map>
+#include <memory>
+#include <vector>
+
+class CPLWorkerThreadPool;
+class OGRAbstractProxiedLayer;
+
 /************************************************************************/
 /*                      OGRUnionLayerGeomFieldDefn                      */
 /************************************************************************/
@@ -96,12 +103,27 @@ class CPL_DLL OGRUnionLayer final : public OGRLayer
     int *pabCheckIfAutoWrap;
     const OGRSpatialReference *poGlobalSRS;
 
+    /* Background opening and reading of the next source layers */
+    struct PrefetchJob;
+    int m_nPrefetchDepth = 0;
+    std::unique_ptr<CPLWorkerThreadPool> m_poPrefetchPool{};
+    std::vector<OGRAbstractProxiedLayer *> m_apoProxiedSrcLayers{};
+    std::map<int, std::shared_ptr<PrefetchJob>> m_oMapPrefetchJobs{};
+    std::shared_ptr<PrefetchJob> m_poCurLayerPrefetch{};
+    int m_iPinnedCurLayer = -1;
+
     void AutoWarpLayerIfNecessary(int iSubLayer);
     OGRFeature *TranslateFromSrcLayer(OGRFeature *poSrcFeature);
     void ApplyAttributeFilterToSrcLayer(int iSubLayer);
     int GetAttrFilterPassThroughValue();
+    void PrepareSrcLayer(int iSubLayer);
     void ConfigureActiveLayer();
     void SetSpatialFilterToSourceLayer(OGRLayer *poSrcLayer);
+    void PinSrcLayer(int iSubLayer, bool bPin);
+    void LaunchPrefetch();
+    void StopPrefetch();
+    void ReleaseCurLayerPrefetch();
+    OGRFeature *GetNextSrcFeature();
 
   public:
     OGRUnionLayer(
@@ -125,6 +147,10 @@ class CPL_DLL OGRUnionLayer final : public OGRLayer
     void SetSourceLayerFieldName(const char *pszSourceLayerFieldName);
     void SetPreserveSrcFID(int bPreserveSrcFID);
     void SetFeatureCount(int nFeatureCount);
+    /* Number of source layers that may be opened and read ahead in
+     * worker threads. All source layers must be safe to use in a thread
+     * different from the one of the other source layers. */
+    void SetPrefetchDepth(int nDepth);
     virtual const char *GetName() override
     {
         return osName.c_str();
@@ -503,6 +503,8 @@ int OGRGeoJSONLayer::TestCapability(const char *pszCap)
     else if (EQUAL(pszCap, OLCFastGetExtent) ||
              EQUAL(pszCap, OLCFastGetExtent3D))
         return m_poFilterGeom == nullptr && m_poAttrQuery == nullptr;
+    else if (EQUAL(pszCap, OLCIgnoreFields))
+        return poReader_ != nullptr;
     return OGRMemLayer::TestCapability(pszCap);
 }
 
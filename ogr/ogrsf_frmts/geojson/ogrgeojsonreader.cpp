@@ -818,6 +818,9 @@ bool OGRGeoJSONReader::IngestAll(OGRGeoJSONLayer *poLayer)
              "Total memory estimated for ingestion: " CPL_FRMT_GUIB " bytes",
              nTotalOGRFeatureMemEstimate_);
 
+    // The ingested features replace the file content, so they must be
+    // complete whatever the ignored fields.
+    bHonourIgnoredFields_ = false;
     ResetReading();
     GIntBig nCounter = 0;
     while (true)
@@ -2218,6 +2221,11 @@ OGRFeature *OGRGeoJSONBaseReader::ReadFeature(OGRLayer *poLayer,
         json_object_object_foreachC(poObjProps, it)
         {
             const int nField = poFDefn->GetFieldIndexCaseSensitive(it.key);
+            if (nField >= 0 && bHonourIgnoredFields_ &&
+                poFDefn->GetFieldDefn(nField)->IsIgnored())
+            {
+                continue;
+            }
             if (nField < 0 &&
                 !(bFlattenNestedAttributes_ && it.val != nullptr &&
                   json_object_get_type(it.val) == json_type_object))
@@ -2242,7 +2250,9 @@ OGRFeature *OGRGeoJSONBaseReader::ReadFeature(OGRLayer *poLayer,
         json_object_object_foreachC(poObj, it)
         {
             const int nFldIndex = poFDefn->GetFieldIndexCaseSensitive(it.key);
-            if (nFldIndex >= 0)
+            if (nFldIndex >= 0 &&
+                !(bHonourIgnoredFields_ &&
+                  poFDefn->GetFieldDefn(nFldIndex)->IsIgnored()))
             {
                 if (it.val)
                     poFeature->SetField(nFldIndex,
@@ -2279,6 +2289,12 @@ OGRFeature *OGRGeoJSONBaseReader::ReadFeature(OGRLayer *poLayer,
     /* -------------------------------------------------------------------- */
     /*      Translate geometry sub-object of GeoJSON Feature.               */
     /* -------------------------------------------------------------------- */
+    if (bHonourIgnoredFields_ && poFDefn->IsGeometryIgnored() &&
+        poLayer->GetSpatialFilter() == nullptr)
+    {
+        return poFeature;
+    }
+
     json_object *poObjGeom = nullptr;
     json_object *poTmp = poObj;
     json_object_iter it;
@@ -128,6 +128,8 @@ class OGRGeoJSONBaseReader
     bool bStoreNativeData_ = false;
     bool bArrayAsString_ = false;
     bool bDateAsString_ = false;
+    // Whether ReadFeature() skips fields and geometry marked as ignored
+    bool bHonourIgnoredFields_ = true;
 
   private:
     std::set<int> aoSetUndeterminedTypeFields_;
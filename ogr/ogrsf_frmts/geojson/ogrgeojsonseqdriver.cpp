@@ -594,6 +594,8 @@ int OGRGeoJSONSeqLayer::TestCapability(const char *pszCap)
 {
     if (EQUAL(pszCap, OLCStringsAsUTF8))
         return true;
+    if (EQUAL(pszCap, OLCIgnoreFields))
+        return true;
     if (m_poFilterGeom == nullptr && m_poAttrQuery == nullptr &&
         EQUAL(pszCap, OLCFastFeatureCount))
     {
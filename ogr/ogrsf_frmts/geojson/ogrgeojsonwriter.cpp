@@ -44,6 +44,7 @@
 #include "ogr_p.h"
 
 #include <algorithm>
+#include <charconv>
 #include <cstdint>
 #include <limits>
 
@@ -1642,6 +1643,30 @@ json_object *json_object_new_double_with_precision(double dfVal,
     return jso;
 }
 
+/************************************************************************/
+/*                       OGRGeoJSONFormatDoubleG()                      */
+/************************************************************************/
+
+// Equivalent of CPLsnprintf(pszBuffer, nBufferSize, "%.<nPrecision>g", dfVal)
+// for a finite value, but faster when std::to_chars() is available.
+static int OGRGeoJSONFormatDoubleG(char *pszBuffer, size_t nBufferSize,
+                                   double dfVal, int nPrecision)
+{
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    const auto res =
+        std::to_chars(pszBuffer, pszBuffer + nBufferSize - 1, dfVal,
+                      std::chars_format::general, nPrecision);
+    if (res.ec == std::errc())
+    {
+        *res.ptr = '\0';
+        return static_cast<int>(res.ptr - pszBuffer);
+    }
+#endif
+    char szFormatting[32];
+    snprintf(szFormatting, sizeof(szFormatting), "%%.%dg", nPrecision);
+    return CPLsnprintf(pszBuffer, nBufferSize, szFormatting, dfVal);
+}
+
 /************************************************************************/
 /*             OGR_json_double_with_significant_figures_to_string()     */
 /************************************************************************/
@@ -1664,7 +1689,6 @@ static int OGR_json_double_with_significant_figures_to_string(
     }
     else
     {
-        char szFormatting[32] = {};
         const void *userData =
 #if (!defined(JSON_C_VERSION_NUM)) || (JSON_C_VERSION_NUM < JSON_C_VER_013)
             jso->_userdata;
@@ -1679,9 +1703,8 @@ static int OGR_json_double_with_significant_figures_to_string(
             bSignificantFiguresIsNegative
                 ? 17
                 : static_cast<int>(nSignificantFigures);
-        CPLsnprintf(szFormatting, sizeof(szFormatting), "%%.%dg",
-                    nInitialSignificantFigures);
-        nSize = CPLsnprintf(szBuffer, sizeof(szBuffer), szFormatting, dfVal);
+        nSize = OGRGeoJSONFormatDoubleG(szBuffer, sizeof(szBuffer), dfVal,
+                                        nInitialSignificantFigures);
         const char *pszDot = strchr(szBuffer, '.');
 
         // Try to avoid .xxxx999999y or .xxxx000000y rounding issues by
@@ -1693,10 +1716,9 @@ static int OGR_json_double_with_significant_figures_to_string(
             bool bOK = false;
             for (int i = 1; i <= 3; i++)
             {
-                CPLsnprintf(szFormatting, sizeof(szFormatting), "%%.%dg",
-                            nInitialSignificantFigures - i);
-                nSize = CPLsnprintf(szBuffer, sizeof(szBuffer), szFormatting,
-                                    dfVal);
+                nSize = OGRGeoJSONFormatDoubleG(szBuffer, sizeof(szBuffer),
+                                                dfVal,
+                                                nInitialSignificantFigures - i);
                 pszDot = strchr(szBuffer, '.');
                 if (pszDot != nullptr && strstr(pszDot, "999999") == nullptr &&
                     strstr(pszDot, "000000") == nullptr)
@@ -1707,10 +1729,9 @@ static int OGR_json_double_with_significant_figures_to_string(
             }
             if (!bOK)
             {
-                CPLsnprintf(szFormatting, sizeof(szFormatting), "%%.%dg",
-                            nInitialSignificantFigures);
-                nSize = CPLsnprintf(szBuffer, sizeof(szBuffer), szFormatting,
-                                    dfVal);
+                nSize = OGRGeoJSONFormatDoubleG(szBuffer, sizeof(szBuffer),
+                                                dfVal,
+                                                nInitialSignificantFigures);
             }
         }
 
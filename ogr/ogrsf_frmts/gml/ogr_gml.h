@@ -37,6 +37,7 @@
 #include "gmlutils.h"
 
 #include <memory>
+#include <string>
 #include <vector>
 
 class OGRGMLDataSource;
@@ -73,6 +74,27 @@ class OGRGMLLayer final : public OGRLayer
 
     bool bFaceHoleNegative;
 
+    // Features read in advance from the reader, whose geometries are built
+    // by several threads.
+    struct PrefetchedFeature
+    {
+        std::unique_ptr<GMLFeature> poGMLFeature{};
+        std::unique_ptr<OGRGeometry> poGeom{};
+        bool bGeomBuilt = false;
+        std::string osErrorMsg{};
+    };
+    struct GeometryBuildJob;
+
+    int m_nPrefetchThreads = -1;
+    std::vector<PrefetchedFeature> m_aoPrefetchedFeatures{};
+    size_t m_iNextPrefetchedFeature = 0;
+    std::vector<void *> m_ahCacheSRSPrefetch{};
+
+    bool PrefetchFeatures();
+    void BuildPrefetchedGeometry(PrefetchedFeature &oFeature,
+                                 void *hCacheSRSIn);
+    static void BuildGeometriesJob(void *pData);
+
   public:
     OGRGMLLayer(const char *pszName, bool bWriter, OGRGMLDataSource *poDS);
 
@@ -34,6 +34,10 @@
 #include "cpl_string.h"
 #include "ogr_p.h"
 #include "ogr_api.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
+
+#include <algorithm>
 
 /************************************************************************/
 /*                           OGRGMLLayer()                              */
@@ -75,6 +79,8 @@ OGRGMLLayer::~OGRGMLLayer()
         poFeatureDefn->Release();
 
     GML_BuildOGRGeometryFromList_DestroyCache(hCacheSRS);
+    for (void *hCacheSRSPrefetch : m_ahCacheSRSPrefetch)
+        GML_BuildOGRGeometryFromList_DestroyCache(hCacheSRSPrefetch);
 }
 
 /************************************************************************/
@@ -87,6 +93,9 @@ void OGRGMLLayer::ResetReading()
     if (bWriter)
         return;
 
+    m_aoPrefetchedFeatures.clear();
+    m_iNextPrefetchedFeature = 0;
+
     if (poDS->GetReadMode() == INTERLEAVED_LAYERS ||
         poDS->GetReadMode() == SEQUENTIAL_LAYERS)
     {
@@ -124,6 +133,158 @@ static GIntBig Increment(GIntBig nVal)
     return nVal;
 }
 
+/************************************************************************/
+/*                          GeometryBuildJob                            */
+/************************************************************************/
+
+struct OGRGMLLayer::GeometryBuildJob
+{
+    OGRGMLLayer *poLayer = nullptr;
+    size_t iStart = 0;
+    size_t iEnd = 0;
+    void *hCacheSRS = nullptr;
+};
+
+/************************************************************************/
+/*                        BuildGeometriesJob()                          */
+/************************************************************************/
+
+void OGRGMLLayer::BuildGeometriesJob(void *pData)
+{
+    auto psJob = static_cast<GeometryBuildJob *>(pData);
+    OGRGMLLayer *poLayer = psJob->poLayer;
+    for (size_t i = psJob->iStart; i < psJob->iEnd; ++i)
+    {
+        poLayer->BuildPrefetchedGeometry(poLayer->m_aoPrefetchedFeatures[i],
+                                         psJob->hCacheSRS);
+    }
+}
+
+/************************************************************************/
+/*                      BuildPrefetchedGeometry()                       */
+/*                                                                      */
+/*      Same processing as the single geometry field case of            */
+/*      GetNextFeature(), but without emitting errors, so that it can   */
+/*      be run from worker threads.                                     */
+/************************************************************************/
+
+void OGRGMLLayer::BuildPrefetchedGeometry(PrefetchedFeature &oFeature,
+                                          void *hCacheSRSIn)
+{
+    const GMLFeature *poGMLFeature = oFeature.poGMLFeature.get();
+    if (poGMLFeature->GetClass() != poFClass)
+        return;
+
+    const CPLXMLNode *const *papsGeometry = poGMLFeature->GetGeometryList();
+    if (papsGeometry == nullptr || papsGeometry[0] == nullptr ||
+        strcmp(papsGeometry[0]->pszValue, "null") == 0 ||
+        (m_poFilterGeom == nullptr &&
+         poFeatureDefn->GetGeomFieldDefn(0)->IsIgnored()))
+    {
+        return;
+    }
+
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    CPLErrorReset();
+    OGRGeometry *poGeom = GML_BuildOGRGeometryFromList(
+        papsGeometry, true, poDS->GetInvertAxisOrderIfLatLong(),
+        poDS->GetGlobalSRSName(), poDS->GetConsiderEPSGAsURN(),
+        poDS->GetSwapCoordinates(), poDS->GetSecondaryGeometryOption(),
+        hCacheSRSIn, bFaceHoleNegative);
+    CPLPopErrorHandler();
+
+    if (poGeom != nullptr)
+        oFeature.poGeom.reset(
+            OGRGeometryFactory::forceTo(poGeom, GetGeomType()));
+    else
+        oFeature.osErrorMsg = CPLGetLastErrorMsg();
+    oFeature.bGeomBuilt = true;
+}
+
+/************************************************************************/
+/*                          PrefetchFeatures()                          */
+/*                                                                      */
+/*      Read a batch of features from the reader, and build their       */
+/*      geometries in parallel. Returns false if no feature has been    */
+/*      prefetched, in which case features must be read directly from   */
+/*      the reader.                                                     */
+/************************************************************************/
+
+bool OGRGMLLayer::PrefetchFeatures()
+{
+    m_aoPrefetchedFeatures.clear();
+    m_iNextPrefetchedFeature = 0;
+
+    if (m_nPrefetchThreads < 0)
+    {
+        const char *pszNumThreads =
+            CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+        int nThreads;
+        if (pszNumThreads == nullptr)
+            nThreads = std::min(4, CPLGetNumCPUs());
+        else if (EQUAL(pszNumThreads, "ALL_CPUS"))
+            nThreads = CPLGetNumCPUs();
+        else
+            nThreads = std::max(1, atoi(pszNumThreads));
+        m_nPrefetchThreads = std::min(nThreads, 128);
+    }
+
+    // In interleaved mode, features of other layers must be handed over
+    // to them one at a time.
+    if (m_nPrefetchThreads <= 1 || poDS->GetReadMode() == INTERLEAVED_LAYERS ||
+        poFeatureDefn->GetGeomFieldCount() != 1)
+    {
+        return false;
+    }
+    CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(m_nPrefetchThreads);
+    if (poPool == nullptr)
+        return false;
+
+    constexpr size_t FEATURES_PER_THREAD = 64;
+    const size_t nMaxFeatures =
+        FEATURES_PER_THREAD * static_cast<size_t>(m_nPrefetchThreads);
+    while (m_aoPrefetchedFeatures.size() < nMaxFeatures)
+    {
+        GMLFeature *poGMLFeature = poDS->GetReader()->NextFeature();
+        if (poGMLFeature == nullptr)
+            break;
+        m_nFeaturesRead++;
+
+        PrefetchedFeature oFeature;
+        oFeature.poGMLFeature.reset(poGMLFeature);
+        m_aoPrefetchedFeatures.push_back(std::move(oFeature));
+
+        // Stop at the first feature of another layer, so that
+        // GetNextFeature() can store it in the datasource in
+        // SEQUENTIAL_LAYERS mode.
+        if (poGMLFeature->GetClass() != poFClass)
+            break;
+    }
+    if (m_aoPrefetchedFeatures.empty())
+        return false;
+
+    const size_t nCount = m_aoPrefetchedFeatures.size();
+    const size_t nJobs =
+        std::min(static_cast<size_t>(m_nPrefetchThreads), nCount);
+    while (m_ahCacheSRSPrefetch.size() < nJobs)
+        m_ahCacheSRSPrefetch.push_back(
+            GML_BuildOGRGeometryFromList_CreateCache());
+
+    std::vector<GeometryBuildJob> asJobs(nJobs);
+    auto poQueue = poPool->CreateJobQueue();
+    for (size_t i = 0; i < nJobs; ++i)
+    {
+        asJobs[i].poLayer = this;
+        asJobs[i].iStart = nCount * i / nJobs;
+        asJobs[i].iEnd = nCount * (i + 1) / nJobs;
+        asJobs[i].hCacheSRS = m_ahCacheSRSPrefetch[i];
+        poQueue->SubmitJob(BuildGeometriesJob, &asJobs[i]);
+    }
+    poQueue->WaitCompletion();
+
+    return true;
+}
+
 /************************************************************************/
 /*                           GetNextFeature()                           */
 /************************************************************************/
@@ -151,11 +312,25 @@ OGRFeature *OGRGMLLayer::GetNextFeature()
     /* ==================================================================== */
     while (true)
     {
+        std::unique_ptr<OGRGeometry> poPrebuiltGeom;
+        bool bGeomPrebuilt = false;
+        std::string osPrebuiltErrorMsg;
+
         GMLFeature *poGMLFeature = poDS->PeekStoredGMLFeature();
         if (poGMLFeature != nullptr)
         {
             poDS->SetStoredGMLFeature(nullptr);
         }
+        else if (m_iNextPrefetchedFeature < m_aoPrefetchedFeatures.size() ||
+                 PrefetchFeatures())
+        {
+            auto &oPrefetched =
+                m_aoPrefetchedFeatures[m_iNextPrefetchedFeature++];
+            poGMLFeature = oPrefetched.poGMLFeature.release();
+            poPrebuiltGeom = std::move(oPrefetched.poGeom);
+            bGeomPrebuilt = oPrefetched.bGeomBuilt;
+            osPrebuiltErrorMsg = std::move(oPrefetched.osErrorMsg);
+        }
         else
         {
             poGMLFeature = poDS->GetReader()->NextFeature();
@@ -297,6 +472,13 @@ OGRFeature *OGRGMLLayer::GetNextFeature()
             const char *pszSRSName = poDS->GetGlobalSRSName();
             for (int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++)
             {
+                // Do not parse ignored geometries, unless they are needed
+                // by the spatial filter.
+                if (poFeatureDefn->GetGeomFieldDefn(i)->IsIgnored() &&
+                    !(m_poFilterGeom != nullptr && i == m_iGeomFieldFilter))
+                {
+                    continue;
+                }
                 const CPLXMLNode *psGeom = poGMLFeature->GetGeometryRef(i);
                 if (psGeom != nullptr)
                 {
@@ -353,26 +535,39 @@ OGRFeature *OGRGMLLayer::GetNextFeature()
         {
             // do nothing
         }
-        else if (papsGeometry[0] != nullptr)
+        else if (papsGeometry[0] != nullptr &&
+                 !(m_poFilterGeom == nullptr &&
+                   poFeatureDefn->GetGeomFieldCount() == 1 &&
+                   poFeatureDefn->GetGeomFieldDefn(0)->IsIgnored()))
         {
-            const char *pszSRSName = poDS->GetGlobalSRSName();
-            CPLPushErrorHandler(CPLQuietErrorHandler);
-            poGeom = GML_BuildOGRGeometryFromList(
-                papsGeometry, true, poDS->GetInvertAxisOrderIfLatLong(),
-                pszSRSName, poDS->GetConsiderEPSGAsURN(),
-                poDS->GetSwapCoordinates(), poDS->GetSecondaryGeometryOption(),
-                hCacheSRS, bFaceHoleNegative);
-            CPLPopErrorHandler();
-
-            // Do geometry type changes if needed to match layer geometry type.
-            if (poGeom != nullptr)
+            CPLString osLastErrorMsg;
+            if (bGeomPrebuilt)
             {
-                poGeom = OGRGeometryFactory::forceTo(poGeom, GetGeomType());
+                poGeom = poPrebuiltGeom.release();
+                osLastErrorMsg = osPrebuiltErrorMsg;
             }
             else
             {
-                const CPLString osLastErrorMsg(CPLGetLastErrorMsg());
+                const char *pszSRSName = poDS->GetGlobalSRSName();
+                CPLPushErrorHandler(CPLQuietErrorHandler);
+                poGeom = GML_BuildOGRGeometryFromList(
+                    papsGeometry, true, poDS->GetInvertAxisOrderIfLatLong(),
+                    pszSRSName, poDS->GetConsiderEPSGAsURN(),
+                    poDS->GetSwapCoordinates(),
+                    poDS->GetSecondaryGeometryOption(), hCacheSRS,
+                    bFaceHoleNegative);
+                CPLPopErrorHandler();
+
+                // Do geometry type changes if needed to match layer geometry
+                // type.
+                if (poGeom != nullptr)
+                    poGeom = OGRGeometryFactory::forceTo(poGeom, GetGeomType());
+                else
+                    osLastErrorMsg = CPLGetLastErrorMsg();
+            }
 
+            if (poGeom == nullptr)
+            {
                 const bool bGoOn = CPLTestBool(
                     CPLGetConfigOption("GML_SKIP_CORRUPTED_FEATURES", "NO"));
 
@@ -411,7 +606,8 @@ OGRFeature *OGRGMLLayer::GetNextFeature()
         poOGRFeature->SetFID(nFID);
         if (poDS->ExposeId())
         {
-            if (pszGML_FID)
+            if (pszGML_FID &&
+                !poFeatureDefn->GetFieldDefn(iDstField)->IsIgnored())
                 poOGRFeature->SetField(iDstField, pszGML_FID);
             iDstField++;
         }
@@ -419,6 +615,9 @@ OGRFeature *OGRGMLLayer::GetNextFeature()
         const int nPropertyCount = poFClass->GetPropertyCount();
         for (int iField = 0; iField < nPropertyCount; iField++, iDstField++)
         {
+            if (poFeatureDefn->GetFieldDefn(iDstField)->IsIgnored())
+                continue;
+
             const GMLProperty *psGMLProperty =
                 poGMLFeature->GetProperty(iField);
             if (psGMLProperty == nullptr || psGMLProperty->nSubProperties == 0)
@@ -1135,6 +1334,9 @@ int OGRGMLLayer::TestCapability(const char *pszCap)
     else if (EQUAL(pszCap, OLCStringsAsUTF8))
         return TRUE;
 
+    else if (EQUAL(pszCap, OLCIgnoreFields))
+        return !bWriter;
+
     else if (EQUAL(pszCap, OLCCurveGeometries))
         return poDS->IsGML3Output();
 
@@ -90,12 +90,12 @@ class GMLASResourceCache
     RecursivelyCreateDirectoryIfNeeded(const std::string &osDirname);
     bool RecursivelyCreateDirectoryIfNeeded();
 
-    std::string GetCachedFilename(const std::string &osResource);
-
   public:
     GMLASResourceCache();
     virtual ~GMLASResourceCache();
 
+    std::string GetCachedFilename(const std::string &osResource) const;
+
     void SetCacheDirectory(const std::string &osCacheDirectory);
     void SetRefreshMode(bool bRefresh)
     {
@@ -382,6 +382,10 @@ class GMLASConfiguration
     /** Cache directory for cached XSD schemas. */
     CPLString m_osXSDCacheDirectory;
 
+    /** Whether the result of the schema analysis should be cached in the
+        XSD cache directory. */
+    bool m_bCacheSchemaAnalysis;
+
     /** Whether to enable schema full checking. */
     bool m_bSchemaFullChecking;
 
@@ -887,6 +891,9 @@ class GMLASField
     }
 
     static GMLASFieldType GetTypeFromString(const CPLString &osType);
+
+    CPLXMLNode *SerializeToXML() const;
+    bool InitFromXML(const CPLXMLNode *psNode);
 };
 
 /************************************************************************/
@@ -1009,6 +1016,9 @@ class GMLASFeatureClass
     {
         return m_osDoc;
     }
+
+    CPLXMLNode *SerializeToXML() const;
+    bool InitFromXML(const CPLXMLNode *psNode);
 };
 
 /************************************************************************/
@@ -1331,6 +1341,20 @@ class OGRGMLASDataSource final : public GDALDataset
     static std::vector<PairURIFilename>
     BuildXSDVector(const CPLString &osXSDFilenames);
 
+    CPLString GetSchemaAnalysisCacheFilename(
+        const CPLString &osConfigFile,
+        const std::vector<PairURIFilename> &aoXSDs,
+        const std::map<CPLString, CPLString> &oMapDocNSURIToPrefix) const;
+
+    bool LoadSchemaAnalysisCache(const CPLString &osCacheFilename,
+                                 std::vector<GMLASFeatureClass> &aoClasses,
+                                 std::set<CPLString> &oSetSchemaURLs);
+
+    void
+    SaveSchemaAnalysisCache(const CPLString &osCacheFilename,
+                            const std::vector<GMLASFeatureClass> &aoClasses,
+                            const std::set<CPLString> &oSetSchemaURLs) const;
+
     void InitReaderWithFirstPassElements(GMLASReader *poReader);
 
   public:
@@ -53,6 +53,7 @@ BOOL_CONST(USE_NULL_STATE_DEFAULT, false);
 BOOL_CONST(INCLUDE_GEOMETRY_XML_DEFAULT, false);
 BOOL_CONST(INSTANTIATE_GML_FEATURES_ONLY_DEFAULT, true);
 BOOL_CONST(ALLOW_XSD_CACHE_DEFAULT, true);
+BOOL_CONST(CACHE_SCHEMA_ANALYSIS_DEFAULT, true);
 BOOL_CONST(SCHEMA_FULL_CHECKING_DEFAULT, true);
 BOOL_CONST(HANDLE_MULTIPLE_IMPORTS_DEFAULT, false);
 BOOL_CONST(VALIDATE_DEFAULT, false);
@@ -51,6 +51,7 @@ GMLASConfiguration::GMLASConfiguration()
       m_bPGIdentifierLaundering(PG_IDENTIFIER_LAUNDERING_DEFAULT),
       m_nMaximumFieldsForFlattening(MAXIMUM_FIELDS_FLATTENING_DEFAULT),
       m_bAllowXSDCache(ALLOW_XSD_CACHE_DEFAULT),
+      m_bCacheSchemaAnalysis(CACHE_SCHEMA_ANALYSIS_DEFAULT),
       m_bSchemaFullChecking(SCHEMA_FULL_CHECKING_DEFAULT),
       m_bHandleMultipleImports(HANDLE_MULTIPLE_IMPORTS_DEFAULT),
       m_bValidate(VALIDATE_DEFAULT),
@@ -308,6 +309,9 @@ bool GMLASConfiguration::Load(const char *pszFilename)
     {
         m_osXSDCacheDirectory =
             CPLGetXMLValue(psRoot, "=Configuration.SchemaCache.Directory", "");
+        m_bCacheSchemaAnalysis = CPLGetXMLBoolValue(
+            psRoot, "=Configuration.SchemaCache.CacheSchemaAnalysis",
+            CACHE_SCHEMA_ANALYSIS_DEFAULT);
     }
 
     m_bSchemaFullChecking = CPLGetXMLBoolValue(
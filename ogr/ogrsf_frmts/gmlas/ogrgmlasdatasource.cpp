@@ -697,6 +697,255 @@ OGRGMLASDataSource::BuildXSDVector(const CPLString &osXSDFilenames)
     return aoXSDs;
 }
 
+/************************************************************************/
+/*                   GetSchemaAnalysisCacheFilename()                   */
+/************************************************************************/
+
+// Version of the layout of the schema analysis cache files. To be increased
+// when GMLASField or GMLASFeatureClass serialization changes.
+constexpr int SCHEMA_ANALYSIS_CACHE_VERSION = 1;
+
+CPLString OGRGMLASDataSource::GetSchemaAnalysisCacheFilename(
+    const CPLString &osConfigFile, const std::vector<PairURIFilename> &aoXSDs,
+    const std::map<CPLString, CPLString> &oMapDocNSURIToPrefix) const
+{
+    if (!m_oConf.m_bAllowXSDCache || !m_oConf.m_bCacheSchemaAnalysis ||
+        m_oConf.m_osXSDCacheDirectory.empty())
+    {
+        return CPLString();
+    }
+
+    CPL_SHA256Context ctxt;
+    CPL_SHA256Init(&ctxt);
+    const auto Update = [&ctxt](const std::string &osStr)
+    {
+        // Include the nul terminator to separate consecutive strings
+        CPL_SHA256Update(&ctxt, osStr.c_str(), osStr.size() + 1);
+    };
+
+    Update(CPLSPrintf("%d", SCHEMA_ANALYSIS_CACHE_VERSION));
+    Update(GDALVersionInfo("VERSION_NUM"));
+
+    // The analysis depends on the whole content of the configuration file
+    Update(osConfigFile);
+    if (!osConfigFile.empty() && !STARTS_WITH(osConfigFile, "<Configuration"))
+    {
+        GByte *pabyRet = nullptr;
+        vsi_l_offset nSize = 0;
+        if (!VSIIngestFile(nullptr, osConfigFile, &pabyRet, &nSize, -1))
+            return CPLString();
+        CPL_SHA256Update(&ctxt, pabyRet, static_cast<size_t>(nSize));
+        VSIFree(pabyRet);
+    }
+
+    // Relative schema locations are resolved against the directory of the
+    // data file, so only take it into account when needed, so that
+    // files sharing absolute schema locations share the same cache entry.
+    bool bHasRelativeXSD = false;
+    for (const auto &oPair : aoXSDs)
+    {
+        Update(oPair.first);
+        Update(oPair.second);
+        if (!STARTS_WITH(oPair.second, "http://") &&
+            !STARTS_WITH(oPair.second, "https://") &&
+            CPLIsFilenameRelative(oPair.second))
+        {
+            bHasRelativeXSD = true;
+        }
+    }
+    if (bHasRelativeXSD)
+        Update(CPLGetDirname(m_osGMLFilename));
+
+    for (const auto &oIter : oMapDocNSURIToPrefix)
+    {
+        Update(oIter.first);
+        Update(oIter.second);
+    }
+
+    Update(m_bSchemaFullChecking ? "1" : "0");
+    Update(m_bHandleMultipleImports ? "1" : "0");
+
+    GByte abyHash[CPL_SHA256_HASH_SIZE];
+    CPL_SHA256Final(&ctxt, abyHash);
+    char *pszHash = CPLBinaryToHex(CPL_SHA256_HASH_SIZE, abyHash);
+    const CPLString osFilename(
+        CPLFormFilename(CPLFormFilename(m_oConf.m_osXSDCacheDirectory,
+                                        "analyzed_schemas", nullptr),
+                        pszHash, "xml"));
+    CPLFree(pszHash);
+    return osFilename;
+}
+
+/************************************************************************/
+/*                       GetSchemaLocalFilename()                       */
+/************************************************************************/
+
+// Return the file whose size and modification time are recorded in the
+// schema analysis cache: the cached copy for remote schemas.
+static std::string GetSchemaLocalFilename(const GMLASXSDCache &oCache,
+                                          const CPLString &osSchemaURL)
+{
+    if (STARTS_WITH(osSchemaURL, "http://") ||
+        STARTS_WITH(osSchemaURL, "https://"))
+    {
+        return oCache.GetCachedFilename(osSchemaURL);
+    }
+    return osSchemaURL;
+}
+
+/************************************************************************/
+/*                       LoadSchemaAnalysisCache()                      */
+/************************************************************************/
+
+bool OGRGMLASDataSource::LoadSchemaAnalysisCache(
+    const CPLString &osCacheFilename, std::vector<GMLASFeatureClass> &aoClasses,
+    std::set<CPLString> &oSetSchemaURLs)
+{
+    VSIStatBufL sStat;
+    if (VSIStatL(osCacheFilename, &sStat) != 0)
+        return false;
+
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    CPLXMLNode *psRoot = CPLParseXMLFile(osCacheFilename);
+    CPLPopErrorHandler();
+    if (psRoot == nullptr)
+    {
+        CPLDebug("GMLAS", "Cannot parse %s", osCacheFilename.c_str());
+        return false;
+    }
+    CPLXMLTreeCloser oCloser(psRoot);
+
+    const CPLXMLNode *psAnalysis =
+        CPLGetXMLNode(psRoot, "=GMLASSchemaAnalysis");
+    if (psAnalysis == nullptr ||
+        atoi(CPLGetXMLValue(psAnalysis, "version", "0")) !=
+            SCHEMA_ANALYSIS_CACHE_VERSION)
+    {
+        return false;
+    }
+
+    std::vector<GMLASFeatureClass> aoClassesTmp;
+    std::set<CPLString> oSetSchemaURLsTmp;
+    std::map<CPLString, CPLString> oMapURIToPrefix;
+    for (const CPLXMLNode *psIter = psAnalysis->psChild; psIter;
+         psIter = psIter->psNext)
+    {
+        if (psIter->eType != CXT_Element)
+            continue;
+        if (strcmp(psIter->pszValue, "Schema") == 0)
+        {
+            const CPLString osSchemaURL(CPLGetXMLValue(psIter, "url", ""));
+            const char *pszSize = CPLGetXMLValue(psIter, "size", nullptr);
+            const char *pszMTime = CPLGetXMLValue(psIter, "mtime", nullptr);
+            if (pszSize && pszMTime)
+            {
+                // Check that the schema has not been modified (or removed
+                // from the XSD cache) since the analysis
+                if (VSIStatL(GetSchemaLocalFilename(m_oCache, osSchemaURL)
+                                 .c_str(),
+                             &sStat) != 0 ||
+                    static_cast<GUIntBig>(sStat.st_size) !=
+                        CPLScanUIntBig(pszSize,
+                                       static_cast<int>(strlen(pszSize))) ||
+                    static_cast<GIntBig>(sStat.st_mtime) !=
+                        CPLAtoGIntBig(pszMTime))
+                {
+                    CPLDebug("GMLAS", "%s is stale: %s has changed",
+                             osCacheFilename.c_str(), osSchemaURL.c_str());
+                    return false;
+                }
+            }
+            oSetSchemaURLsTmp.insert(osSchemaURL);
+        }
+        else if (strcmp(psIter->pszValue, "Namespace") == 0)
+        {
+            oMapURIToPrefix[CPLGetXMLValue(psIter, "uri", "")] =
+                CPLGetXMLValue(psIter, "prefix", "");
+        }
+        else if (strcmp(psIter->pszValue, "Class") == 0)
+        {
+            GMLASFeatureClass oClass;
+            if (!oClass.InitFromXML(psIter))
+            {
+                CPLDebug("GMLAS", "Invalid class in %s",
+                         osCacheFilename.c_str());
+                return false;
+            }
+            aoClassesTmp.push_back(oClass);
+        }
+    }
+
+    aoClasses = std::move(aoClassesTmp);
+    oSetSchemaURLs = std::move(oSetSchemaURLsTmp);
+    m_oMapURIToPrefix = std::move(oMapURIToPrefix);
+    m_osGMLVersionFound = CPLGetXMLValue(psAnalysis, "GMLVersion", "");
+    return true;
+}
+
+/************************************************************************/
+/*                       SaveSchemaAnalysisCache()                      */
+/************************************************************************/
+
+void OGRGMLASDataSource::SaveSchemaAnalysisCache(
+    const CPLString &osCacheFilename,
+    const std::vector<GMLASFeatureClass> &aoClasses,
+    const std::set<CPLString> &oSetSchemaURLs) const
+{
+    CPLXMLNode *psRoot =
+        CPLCreateXMLNode(nullptr, CXT_Element, "GMLASSchemaAnalysis");
+    CPLXMLTreeCloser oCloser(psRoot);
+    CPLAddXMLAttributeAndValue(
+        psRoot, "version", CPLSPrintf("%d", SCHEMA_ANALYSIS_CACHE_VERSION));
+
+    for (const auto &osSchemaURL : oSetSchemaURLs)
+    {
+        CPLXMLNode *psSchema =
+            CPLCreateXMLNode(psRoot, CXT_Element, "Schema");
+        CPLAddXMLAttributeAndValue(psSchema, "url", osSchemaURL);
+        VSIStatBufL sStat;
+        if (VSIStatL(GetSchemaLocalFilename(m_oCache, osSchemaURL).c_str(),
+                     &sStat) == 0)
+        {
+            CPLAddXMLAttributeAndValue(
+                psSchema, "size",
+                CPLSPrintf(CPL_FRMT_GUIB,
+                           static_cast<GUIntBig>(sStat.st_size)));
+            CPLAddXMLAttributeAndValue(
+                psSchema, "mtime",
+                CPLSPrintf(CPL_FRMT_GIB,
+                           static_cast<GIntBig>(sStat.st_mtime)));
+        }
+    }
+
+    if (!m_osGMLVersionFound.empty())
+        CPLCreateXMLElementAndValue(psRoot, "GMLVersion", m_osGMLVersionFound);
+
+    for (const auto &oIter : m_oMapURIToPrefix)
+    {
+        CPLXMLNode *psNS = CPLCreateXMLNode(psRoot, CXT_Element, "Namespace");
+        CPLAddXMLAttributeAndValue(psNS, "uri", oIter.first);
+        CPLAddXMLAttributeAndValue(psNS, "prefix", oIter.second);
+    }
+
+    for (const auto &oClass : aoClasses)
+        CPLAddXMLChild(psRoot, oClass.SerializeToXML());
+
+    // Write in a temporary file and rename it, so that concurrent readers
+    // never see a partially written file.
+    const CPLString osTmpFilename(
+        osCacheFilename + CPLSPrintf(".%d.tmp", static_cast<int>(CPLGetPID())));
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    VSIMkdirRecursive(CPLGetPath(osCacheFilename), 0755);
+    const bool bOK = CPLSerializeXMLTreeToFile(psRoot, osTmpFilename) &&
+                     VSIRename(osTmpFilename, osCacheFilename) == 0;
+    CPLPopErrorHandler();
+    if (!bOK)
+    {
+        CPLDebug("GMLAS", "Cannot write %s", osCacheFilename.c_str());
+        VSIUnlink(osTmpFilename);
+    }
+}
+
 /************************************************************************/
 /*                                Open()                                */
 /************************************************************************/
@@ -798,6 +1047,7 @@ bool OGRGMLASDataSource::Open(GDALOpenInfo *poOpenInfo)
     }
 
     GMLASTopElementParser topElementParser;
+    std::map<CPLString, CPLString> oMapDocNSURIToPrefix;
     if (!m_osGMLFilename.empty())
     {
         topElementParser.Parse(m_osGMLFilename, fpGML);
@@ -811,8 +1061,8 @@ bool OGRGMLASDataSource::Open(GDALOpenInfo *poOpenInfo)
         {
             m_bFoundSWE = true;
         }
-        oAnalyzer.SetMapDocNSURIToPrefix(
-            topElementParser.GetMapDocNSURIToPrefix());
+        oMapDocNSURIToPrefix = topElementParser.GetMapDocNSURIToPrefix();
+        oAnalyzer.SetMapDocNSURIToPrefix(oMapDocNSURIToPrefix);
     }
     std::vector<PairURIFilename> aoXSDs;
     if (osXSDFilenames.empty())
@@ -894,22 +1144,45 @@ bool OGRGMLASDataSource::Open(GDALOpenInfo *poOpenInfo)
                                             szHANDLE_MULTIPLE_IMPORTS_OPTION,
                                             m_oConf.m_bHandleMultipleImports);
 
-    bool bRet =
-        oAnalyzer.Analyze(m_oCache, CPLGetDirname(m_osGMLFilename), aoXSDs,
-                          m_bSchemaFullChecking, m_bHandleMultipleImports);
-    if (!bRet)
+    std::vector<GMLASFeatureClass> aoClasses;
+    std::set<CPLString> oSetSchemaURLs;
+    const CPLString osSchemaAnalysisCacheFilename(
+        GetSchemaAnalysisCacheFilename(osConfigFile, aoXSDs,
+                                       oMapDocNSURIToPrefix));
+    if (!osSchemaAnalysisCacheFilename.empty() && !bRefreshCache &&
+        LoadSchemaAnalysisCache(osSchemaAnalysisCacheFilename, aoClasses,
+                                oSetSchemaURLs))
     {
-        return false;
+        CPLDebug("GMLAS", "Using cached schema analysis from %s",
+                 osSchemaAnalysisCacheFilename.c_str());
     }
+    else
+    {
+        bool bRet = oAnalyzer.Analyze(m_oCache, CPLGetDirname(m_osGMLFilename),
+                                      aoXSDs, m_bSchemaFullChecking,
+                                      m_bHandleMultipleImports);
+        if (!bRet)
+        {
+            return false;
+        }
 
-    if (!osXSDFilenames.empty())
-        m_aoXSDsManuallyPassed = aoXSDs;
+        m_oMapURIToPrefix = oAnalyzer.GetMapURIToPrefix();
+
+        m_osGMLVersionFound = oAnalyzer.GetGMLVersionFound();
+
+        aoClasses = oAnalyzer.GetClasses();
 
-    m_oMapURIToPrefix = oAnalyzer.GetMapURIToPrefix();
+        oSetSchemaURLs = oAnalyzer.GetSchemaURLS();
 
-    m_osGMLVersionFound = oAnalyzer.GetGMLVersionFound();
+        if (!osSchemaAnalysisCacheFilename.empty())
+        {
+            SaveSchemaAnalysisCache(osSchemaAnalysisCacheFilename, aoClasses,
+                                    oSetSchemaURLs);
+        }
+    }
 
-    const std::set<CPLString> &oSetSchemaURLs = oAnalyzer.GetSchemaURLS();
+    if (!osXSDFilenames.empty())
+        m_aoXSDsManuallyPassed = aoXSDs;
 
     FillOtherMetadataLayer(poOpenInfo, osConfigFile, aoXSDs, oSetSchemaURLs);
 
@@ -938,8 +1211,6 @@ bool OGRGMLASDataSource::Open(GDALOpenInfo *poOpenInfo)
         m_eSwapCoordinates = GMLAS_SWAP_NO;
     }
 
-    const std::vector<GMLASFeatureClass> &aoClasses = oAnalyzer.GetClasses();
-
     // First "standard" tables
     for (size_t i = 0; i < aoClasses.size(); ++i)
     {
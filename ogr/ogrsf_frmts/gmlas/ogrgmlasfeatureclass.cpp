@@ -183,3 +183,186 @@ void GMLASFeatureClass::AddNestedClass(const GMLASFeatureClass &oNestedClass)
 {
     m_aoNestedClasses.push_back(oNestedClass);
 }
+
+/************************************************************************/
+/*                         Serialization helpers                        */
+/************************************************************************/
+
+static void AddStringAttr(CPLXMLNode *psNode, const char *pszName,
+                          const CPLString &osValue)
+{
+    if (!osValue.empty())
+        CPLAddXMLAttributeAndValue(psNode, pszName, osValue.c_str());
+}
+
+static void AddIntAttr(CPLXMLNode *psNode, const char *pszName, int nValue)
+{
+    CPLAddXMLAttributeAndValue(psNode, pszName, CPLSPrintf("%d", nValue));
+}
+
+static void AddBoolAttr(CPLXMLNode *psNode, const char *pszName, bool bValue)
+{
+    if (bValue)
+        CPLAddXMLAttributeAndValue(psNode, pszName, "true");
+}
+
+static bool GetBoolAttr(const CPLXMLNode *psNode, const char *pszName)
+{
+    return CPLTestBool(CPLGetXMLValue(psNode, pszName, "false"));
+}
+
+/************************************************************************/
+/*                            SerializeToXML()                          */
+/************************************************************************/
+
+CPLXMLNode *GMLASField::SerializeToXML() const
+{
+    CPLXMLNode *psNode = CPLCreateXMLNode(nullptr, CXT_Element, "Field");
+    AddStringAttr(psNode, "name", m_osName);
+    AddStringAttr(psNode, "xpath", m_osXPath);
+    AddIntAttr(psNode, "type", static_cast<int>(m_eType));
+    AddStringAttr(psNode, "typeName", m_osTypeName);
+    AddIntAttr(psNode, "geomType", static_cast<int>(m_eGeomType));
+    AddIntAttr(psNode, "width", m_nWidth);
+    AddBoolAttr(psNode, "notNullable", m_bNotNullable);
+    AddBoolAttr(psNode, "array", m_bArray);
+    AddBoolAttr(psNode, "list", m_bList);
+    AddIntAttr(psNode, "category", static_cast<int>(m_eCategory));
+    AddStringAttr(psNode, "fixedValue", m_osFixedValue);
+    AddStringAttr(psNode, "defaultValue", m_osDefaultValue);
+    AddIntAttr(psNode, "minOccurs", m_nMinOccurs);
+    AddIntAttr(psNode, "maxOccurs", m_nMaxOccurs);
+    AddBoolAttr(psNode, "repetitionOnSequence", m_bRepetitionOnSequence);
+    AddBoolAttr(psNode, "includeThisEltInBlob", m_bIncludeThisEltInBlob);
+    AddStringAttr(psNode, "abstractElementXPath", m_osAbstractElementXPath);
+    AddStringAttr(psNode, "relatedClassXPath", m_osRelatedClassXPath);
+    AddStringAttr(psNode, "junctionLayer", m_osJunctionLayer);
+    AddBoolAttr(psNode, "ignored", m_bIgnored);
+    AddBoolAttr(psNode, "mayAppearOutOfOrder", m_bMayAppearOutOfOrder);
+    for (const auto &osXPath : m_aosXPath)
+        CPLCreateXMLElementAndValue(psNode, "AlternateXPath", osXPath);
+    if (!m_osDoc.empty())
+        CPLCreateXMLElementAndValue(psNode, "Documentation", m_osDoc);
+    return psNode;
+}
+
+/************************************************************************/
+/*                              InitFromXML()                           */
+/************************************************************************/
+
+bool GMLASField::InitFromXML(const CPLXMLNode *psNode)
+{
+    if (psNode->eType != CXT_Element || strcmp(psNode->pszValue, "Field") != 0)
+        return false;
+
+    const int nType = atoi(CPLGetXMLValue(psNode, "type", "-1"));
+    const int nCategory = atoi(CPLGetXMLValue(psNode, "category", "-1"));
+    if (nType < GMLAS_FT_STRING || nType > GMLAS_FT_GEOMETRY ||
+        nCategory < REGULAR || nCategory > GROUP)
+    {
+        return false;
+    }
+
+    m_osName = CPLGetXMLValue(psNode, "name", "");
+    m_osXPath = CPLGetXMLValue(psNode, "xpath", "");
+    m_eType = static_cast<GMLASFieldType>(nType);
+    m_osTypeName = CPLGetXMLValue(psNode, "typeName", "");
+    m_eGeomType = static_cast<OGRwkbGeometryType>(
+        atoi(CPLGetXMLValue(psNode, "geomType", "0")));
+    m_nWidth = atoi(CPLGetXMLValue(psNode, "width", "0"));
+    m_bNotNullable = GetBoolAttr(psNode, "notNullable");
+    m_bArray = GetBoolAttr(psNode, "array");
+    m_bList = GetBoolAttr(psNode, "list");
+    m_eCategory = static_cast<Category>(nCategory);
+    m_osFixedValue = CPLGetXMLValue(psNode, "fixedValue", "");
+    m_osDefaultValue = CPLGetXMLValue(psNode, "defaultValue", "");
+    m_nMinOccurs = atoi(CPLGetXMLValue(psNode, "minOccurs", "-1"));
+    m_nMaxOccurs = atoi(CPLGetXMLValue(psNode, "maxOccurs", "-1"));
+    m_bRepetitionOnSequence = GetBoolAttr(psNode, "repetitionOnSequence");
+    m_bIncludeThisEltInBlob = GetBoolAttr(psNode, "includeThisEltInBlob");
+    m_osAbstractElementXPath =
+        CPLGetXMLValue(psNode, "abstractElementXPath", "");
+    m_osRelatedClassXPath = CPLGetXMLValue(psNode, "relatedClassXPath", "");
+    m_osJunctionLayer = CPLGetXMLValue(psNode, "junctionLayer", "");
+    m_bIgnored = GetBoolAttr(psNode, "ignored");
+    m_bMayAppearOutOfOrder = GetBoolAttr(psNode, "mayAppearOutOfOrder");
+    m_osDoc = CPLGetXMLValue(psNode, "Documentation", "");
+
+    m_aosXPath.clear();
+    for (const CPLXMLNode *psIter = psNode->psChild; psIter;
+         psIter = psIter->psNext)
+    {
+        if (psIter->eType == CXT_Element &&
+            strcmp(psIter->pszValue, "AlternateXPath") == 0)
+        {
+            m_aosXPath.push_back(CPLGetXMLValue(psIter, nullptr, ""));
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                            SerializeToXML()                          */
+/************************************************************************/
+
+CPLXMLNode *GMLASFeatureClass::SerializeToXML() const
+{
+    CPLXMLNode *psNode = CPLCreateXMLNode(nullptr, CXT_Element, "Class");
+    AddStringAttr(psNode, "name", m_osName);
+    AddStringAttr(psNode, "xpath", m_osXPath);
+    AddBoolAttr(psNode, "isRepeatedSequence", m_bIsRepeatedSequence);
+    AddBoolAttr(psNode, "isGroup", m_bIsGroup);
+    AddStringAttr(psNode, "parentXPath", m_osParentXPath);
+    AddStringAttr(psNode, "childXPath", m_osChildXPath);
+    AddBoolAttr(psNode, "isTopLevelElt", m_bIsTopLevelElt);
+    if (!m_osDoc.empty())
+        CPLCreateXMLElementAndValue(psNode, "Documentation", m_osDoc);
+    for (const auto &oField : m_aoFields)
+        CPLAddXMLChild(psNode, oField.SerializeToXML());
+    for (const auto &oNestedClass : m_aoNestedClasses)
+        CPLAddXMLChild(psNode, oNestedClass.SerializeToXML());
+    return psNode;
+}
+
+/************************************************************************/
+/*                              InitFromXML()                           */
+/************************************************************************/
+
+bool GMLASFeatureClass::InitFromXML(const CPLXMLNode *psNode)
+{
+    if (psNode->eType != CXT_Element || strcmp(psNode->pszValue, "Class") != 0)
+        return false;
+
+    m_osName = CPLGetXMLValue(psNode, "name", "");
+    m_osXPath = CPLGetXMLValue(psNode, "xpath", "");
+    m_bIsRepeatedSequence = GetBoolAttr(psNode, "isRepeatedSequence");
+    m_bIsGroup = GetBoolAttr(psNode, "isGroup");
+    m_osParentXPath = CPLGetXMLValue(psNode, "parentXPath", "");
+    m_osChildXPath = CPLGetXMLValue(psNode, "childXPath", "");
+    m_bIsTopLevelElt = GetBoolAttr(psNode, "isTopLevelElt");
+    m_osDoc = CPLGetXMLValue(psNode, "Documentation", "");
+
+    m_aoFields.clear();
+    m_aoNestedClasses.clear();
+    for (const CPLXMLNode *psIter = psNode->psChild; psIter;
+         psIter = psIter->psNext)
+    {
+        if (psIter->eType != CXT_Element)
+            continue;
+        if (strcmp(psIter->pszValue, "Field") == 0)
+        {
+            GMLASField oField;
+            if (!oField.InitFromXML(psIter))
+                return false;
+            m_aoFields.push_back(oField);
+        }
+        else if (strcmp(psIter->pszValue, "Class") == 0)
+        {
+            GMLASFeatureClass oNestedClass;
+            if (!oNestedClass.InitFromXML(psIter))
+                return false;
+            m_aoNestedClasses.push_back(oNestedClass);
+        }
+    }
+    return true;
+}
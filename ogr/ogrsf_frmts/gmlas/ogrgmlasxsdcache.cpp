@@ -102,7 +102,8 @@ bool GMLASResourceCache::RecursivelyCreateDirectoryIfNeeded()
 /*                        GetCachedFilename()                           */
 /************************************************************************/
 
-std::string GMLASResourceCache::GetCachedFilename(const std::string &osResource)
+std::string
+GMLASResourceCache::GetCachedFilename(const std::string &osResource) const
 {
     std::string osLaunderedName(osResource);
     if (STARTS_WITH(osLaunderedName.c_str(), "http://"))
@@ -31,9 +31,13 @@
 #include "gdal_alg_priv.h"
 #include "ogrsqlitevfs.h"
 #include "cpl_error.h"
+#include "gdal_thread_pool.h"
 
 #include <algorithm>
+#include <climits>
 #include <limits>
+#include <memory>
+#include <set>
 
 #if !defined(DEBUG_VERBOSE) && defined(DEBUG_VERBOSE_GPKG)
 #define DEBUG_VERBOSE
@@ -877,6 +881,20 @@ GByte *GDALGPKGMBTilesLikePseudoDataset::ReadTile(int nRow, int nCol,
     CPLDebug("GPKG", "ReadTile(row=%d, col=%d)", nRow, nCol);
 #endif
 
+    if (!m_oMapPrefetchedTiles.empty() && pbIsLossyFormat == nullptr)
+    {
+        const auto oIter =
+            m_oMapPrefetchedTiles.find(std::pair<int, int>(nRow, nCol));
+        if (oIter != m_oMapPrefetchedTiles.end())
+        {
+            if (oIter->second.empty())
+                FillEmptyTile(pabyData);
+            else
+                memcpy(pabyData, oIter->second.data(), oIter->second.size());
+            return pabyData;
+        }
+    }
+
     char *pszSQL = sqlite3_mprintf(
         "SELECT tile_data%s FROM \"%w\" "
         "WHERE zoom_level = %d AND tile_row = %d AND tile_column = %d%s",
@@ -994,6 +1012,185 @@ GByte *GDALGPKGMBTilesLikePseudoDataset::ReadTile(int nRow, int nCol,
     return pabyData;
 }
 
+/************************************************************************/
+/*                           PrefetchTiles()                            */
+/************************************************************************/
+
+namespace
+{
+struct GPKGTileDecodeJob
+{
+    GDALGPKGMBTilesLikePseudoDataset *poDS = nullptr;
+    std::pair<int, int> oKey{};
+    std::vector<GByte> abyCompressed{};
+    std::vector<GByte> *pabyDecoded = nullptr;
+    bool bOK = false;
+};
+}  // namespace
+
+static void GPKGDecodeTileJob(void *pData)
+{
+    auto psJob = static_cast<GPKGTileDecodeJob *>(pData);
+
+    // Errors are not reported from here: a tile that fails to decode is
+    // not cached, and will be decoded again by IReadBlock().
+    CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+    CPLErrorStateBackuper oErrorStateBackuper;
+    CPLErrorReset();
+
+    const CPLString osMemFileName(
+        CPLSPrintf("/vsimem/gpkg_prefetch_tile_%p", psJob));
+    VSILFILE *fp = VSIFileFromMemBuffer(
+        osMemFileName.c_str(), psJob->abyCompressed.data(),
+        psJob->abyCompressed.size(), FALSE);
+    VSIFCloseL(fp);
+    psJob->bOK =
+        psJob->poDS->ReadTile(osMemFileName, psJob->pabyDecoded->data(), 0.0,
+                              1.0) == CE_None &&
+        CPLGetLastErrorType() == CE_None;
+    VSIUnlink(osMemFileName);
+}
+
+// Fetches with a single SQL request the tiles of the
+// [nRowMin,nRowMax]x[nColMin,nColMax] area, and decodes them (in parallel
+// if GDAL_NUM_THREADS is set), so that the following ReadTile() calls on
+// them do not need to issue one request and decode one tile each.
+// Only done for Byte tile sets opened in read-only mode.
+void GDALGPKGMBTilesLikePseudoDataset::PrefetchTiles(int nRowMin, int nColMin,
+                                                     int nRowMax, int nColMax)
+{
+    m_oMapPrefetchedTiles.clear();
+    if (IGetUpdate() || m_eDT != GDT_Byte)
+        return;
+
+    nRowMin = std::max(0, nRowMin);
+    nColMin = std::max(0, nColMin);
+    nRowMax = std::min(m_nTileMatrixHeight - 1, nRowMax);
+    nColMax = std::min(m_nTileMatrixWidth - 1, nColMax);
+    if (nRowMin > nRowMax || nColMin > nColMax)
+        return;
+    const GIntBig nTiles = static_cast<GIntBig>(nRowMax - nRowMin + 1) *
+                           (nColMax - nColMin + 1);
+    if (nTiles < 2)
+        return;
+
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    IGetRasterBand(1)->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    constexpr int nTileBands = 4;
+    const size_t nTileSize =
+        static_cast<size_t>(nBlockXSize) * nBlockYSize * nTileBands;
+    if (nTiles * static_cast<GIntBig>(nTileSize) > GDALGetCacheMax64() / 4)
+        return;
+
+    // Make sure that the color table is established, since ReadTile() may
+    // query it from the worker threads.
+    IGetRasterBand(1)->GetColorTable();
+
+    // The row convention conversion is its own inverse.
+    const int nDBRow1 = GetRowFromIntoTopConvention(nRowMin);
+    const int nDBRow2 = GetRowFromIntoTopConvention(nRowMax);
+    char *pszSQL = sqlite3_mprintf(
+        "SELECT tile_row, tile_column, tile_data FROM \"%w\" "
+        "WHERE zoom_level = %d AND tile_row BETWEEN %d AND %d AND "
+        "tile_column BETWEEN %d AND %d%s",
+        m_osRasterTable.c_str(), m_nZoomLevel, std::min(nDBRow1, nDBRow2),
+        std::max(nDBRow1, nDBRow2), nColMin, nColMax,
+        !m_osWHERE.empty() ? CPLSPrintf(" AND (%s)", m_osWHERE.c_str()) : "");
+#ifdef DEBUG_VERBOSE
+    CPLDebug("GPKG", "%s", pszSQL);
+#endif
+    sqlite3_stmt *hStmt = nullptr;
+    const int rc = sqlite3_prepare_v2(IGetDB(), pszSQL, -1, &hStmt, nullptr);
+    sqlite3_free(pszSQL);
+    if (rc != SQLITE_OK)
+        return;
+
+    std::map<std::pair<int, int>, std::vector<GByte>> oMapTiles;
+    std::vector<std::unique_ptr<GPKGTileDecodeJob>> apoJobs;
+    while (sqlite3_step(hStmt) == SQLITE_ROW)
+    {
+        if (sqlite3_column_type(hStmt, 2) != SQLITE_BLOB)
+            continue;
+        const int nRow =
+            GetRowFromIntoTopConvention(sqlite3_column_int(hStmt, 0));
+        const int nCol = sqlite3_column_int(hStmt, 1);
+        const GByte *pabyBlob =
+            static_cast<const GByte *>(sqlite3_column_blob(hStmt, 2));
+        const int nBytes = sqlite3_column_bytes(hStmt, 2);
+        const std::pair<int, int> oKey(nRow, nCol);
+        if (nRow < nRowMin || nRow > nRowMax ||
+            oMapTiles.find(oKey) != oMapTiles.end())
+            continue;
+        auto &abyDecoded = oMapTiles[oKey];
+        auto poJob = std::make_unique<GPKGTileDecodeJob>();
+        poJob->oKey = oKey;
+        try
+        {
+            abyDecoded.resize(nTileSize);
+            poJob->abyCompressed.assign(pabyBlob, pabyBlob + nBytes);
+        }
+        catch (const std::exception &)
+        {
+            sqlite3_finalize(hStmt);
+            return;
+        }
+        poJob->poDS = this;
+        poJob->pabyDecoded = &abyDecoded;
+        apoJobs.emplace_back(std::move(poJob));
+    }
+    sqlite3_finalize(hStmt);
+
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    int nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+    nThreads = std::max(1, std::min(nThreads, 128));
+    CPLWorkerThreadPool *poPool = nThreads > 1 && apoJobs.size() > 1
+                                      ? GDALGetGlobalThreadPool(nThreads)
+                                      : nullptr;
+    if (poPool)
+    {
+        auto poQueue = poPool->CreateJobQueue();
+        for (auto &poJob : apoJobs)
+        {
+            if (!poQueue->SubmitJob(GPKGDecodeTileJob, poJob.get()))
+                GPKGDecodeTileJob(poJob.get());
+        }
+        poQueue->WaitCompletion();
+    }
+    else
+    {
+        for (auto &poJob : apoJobs)
+            GPKGDecodeTileJob(poJob.get());
+    }
+
+    // Tiles that failed to decode are left out of the cache, and tiles
+    // absent from the table are empty.
+    std::set<std::pair<int, int>> oSetFailedTiles;
+    for (const auto &poJob : apoJobs)
+    {
+        if (!poJob->bOK)
+        {
+            oMapTiles.erase(poJob->oKey);
+            oSetFailedTiles.insert(poJob->oKey);
+        }
+    }
+    for (int nRow = nRowMin; nRow <= nRowMax; nRow++)
+    {
+        for (int nCol = nColMin; nCol <= nColMax; nCol++)
+        {
+            const std::pair<int, int> oKey(nRow, nCol);
+            if (oMapTiles.find(oKey) == oMapTiles.end() &&
+                oSetFailedTiles.find(oKey) == oSetFailedTiles.end())
+            {
+                oMapTiles[oKey];
+            }
+        }
+    }
+
+    m_oMapPrefetchedTiles = std::move(oMapTiles);
+}
+
 /************************************************************************/
 /*                         IReadBlock()                                 */
 /************************************************************************/
@@ -1225,6 +1422,71 @@ retry:
     return CE_None;
 }
 
+/************************************************************************/
+/*                             IRasterIO()                              */
+/************************************************************************/
+
+CPLErr GDALGPKGMBTilesLikeRasterBand::IRasterIO(
+    GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
+    void *pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+    GSpacing nPixelSpace, GSpacing nLineSpace,
+    GDALRasterIOExtraArg *psExtraArg)
+{
+    // For full resolution reads of several blocks, fetch the tiles of the
+    // blocks that are not yet cached at once.
+    bool bPrefetched = false;
+    if (eRWFlag == GF_Read && nXSize == nBufXSize && nYSize == nBufYSize &&
+        !m_poTPD->IGetUpdate())
+    {
+        const int nBlockXStart = nXOff / nBlockXSize;
+        const int nBlockYStart = nYOff / nBlockYSize;
+        const int nBlockXEnd = (nXOff + nXSize - 1) / nBlockXSize;
+        const int nBlockYEnd = (nYOff + nYSize - 1) / nBlockYSize;
+        int nBlockXMin = INT_MAX;
+        int nBlockYMin = INT_MAX;
+        int nBlockXMax = -1;
+        int nBlockYMax = -1;
+        for (int nBlockY = nBlockYStart; nBlockY <= nBlockYEnd; nBlockY++)
+        {
+            for (int nBlockX = nBlockXStart; nBlockX <= nBlockXEnd; nBlockX++)
+            {
+                GDALRasterBlock *poBlock =
+                    TryGetLockedBlockRef(nBlockX, nBlockY);
+                if (poBlock)
+                {
+                    poBlock->DropLock();
+                    continue;
+                }
+                nBlockXMin = std::min(nBlockXMin, nBlockX);
+                nBlockYMin = std::min(nBlockYMin, nBlockY);
+                nBlockXMax = std::max(nBlockXMax, nBlockX);
+                nBlockYMax = std::max(nBlockYMax, nBlockY);
+            }
+        }
+        if (nBlockXMax >= 0 &&
+            (nBlockXMin != nBlockXMax || nBlockYMin != nBlockYMax))
+        {
+            m_poTPD->PrefetchTiles(
+                nBlockYMin + m_poTPD->m_nShiftYTiles,
+                nBlockXMin + m_poTPD->m_nShiftXTiles,
+                nBlockYMax + m_poTPD->m_nShiftYTiles +
+                    (m_poTPD->m_nShiftYPixelsMod ? 1 : 0),
+                nBlockXMax + m_poTPD->m_nShiftXTiles +
+                    (m_poTPD->m_nShiftXPixelsMod ? 1 : 0));
+            bPrefetched = true;
+        }
+    }
+
+    const CPLErr eErr = GDALPamRasterBand::IRasterIO(
+        eRWFlag, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize, nBufYSize,
+        eBufType, nPixelSpace, nLineSpace, psExtraArg);
+
+    if (bPrefetched)
+        m_poTPD->ClearPrefetchedTiles();
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                       WEBPSupports4Bands()                           */
 /************************************************************************/
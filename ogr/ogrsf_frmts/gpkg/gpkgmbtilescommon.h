@@ -34,6 +34,10 @@
 #include "gdal_pam.h"
 #include <sqlite3.h>
 
+#include <map>
+#include <utility>
+#include <vector>
+
 typedef struct
 {
     int nRow;
@@ -112,6 +116,10 @@ class GDALGPKGMBTilesLikePseudoDataset
 
     GDALGPKGMBTilesLikePseudoDataset *m_poParentDS = nullptr;
 
+    // Tiles decoded by PrefetchTiles(), indexed by (row, column). An empty
+    // vector stands for a missing tile.
+    std::map<std::pair<int, int>, std::vector<GByte>> m_oMapPrefetchedTiles{};
+
   private:
     bool m_bInWriteTile = false;
     CPLErr WriteTileInternal(); /* should only be called by WriteTile() */
@@ -138,6 +146,12 @@ class GDALGPKGMBTilesLikePseudoDataset
     GByte *ReadTile(int nRow, int nCol, GByte *pabyData,
                     bool *pbIsLossyFormat = nullptr);
 
+    void PrefetchTiles(int nRowMin, int nColMin, int nRowMax, int nColMax);
+    void ClearPrefetchedTiles()
+    {
+        m_oMapPrefetchedTiles.clear();
+    }
+
     CPLErr WriteTile();
 
     CPLErr FlushTiles();
@@ -181,6 +195,10 @@ class GDALGPKGMBTilesLikeRasterBand : public GDALPamRasterBand
     virtual CPLErr IWriteBlock(int nBlockXOff, int nBlockYOff,
                                void *pData) override;
     virtual CPLErr FlushCache(bool bAtClosing) override;
+    virtual CPLErr IRasterIO(GDALRWFlag, int, int, int, int, void *, int, int,
+                             GDALDataType, GSpacing nPixelSpace,
+                             GSpacing nLineSpace,
+                             GDALRasterIOExtraArg *psExtraArg) override;
 
     virtual GDALColorTable *GetColorTable() override;
     virtual CPLErr SetColorTable(GDALColorTable *poCT) override;
@@ -692,6 +692,12 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
 
     int m_nIsCompatOfOptimizedGetNextArrowArray = -1;
     bool m_bGetNextArrowArrayCalledSinceResetReading = false;
+    // Used when m_nIsCompatOfOptimizedGetNextArrowArray == TRUE: batches are
+    // read from the FID ranges ]m_nArrowFIDCursor, m_nArrowFIDCursor +
+    // batch_size], until m_nArrowMaxFID.
+    GIntBig m_nArrowMinFID = 0;
+    GIntBig m_nArrowMaxFID = 0;
+    GIntBig m_nArrowFIDCursor = 0;
 
     int m_nCountInsertInTransactionThreshold = -1;
     GIntBig m_nCountInsertInTransaction = 0;
@@ -728,11 +734,36 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
 
     OGRISO8601Format m_sDateTimeFormat = {OGRISO8601Precision::AUTO};
 
+    // GeoPackage geometry blob, and its characteristics, encoded by
+    // WriteArrowBatch() worker threads from the WKB of an Arrow batch
+    struct GPKGEncodedGeometry
+    {
+        std::vector<GByte> abyBlob{};  // empty for a null geometry
+        OGRwkbGeometryType eGeomType = wkbNone;
+        bool bEmpty = true;
+        OGREnvelope sEnvelope{};
+        // Bit i is set if the geometry is or contains a geometry of
+        // (flattened) type i that requires a GPKG geometry type extension
+        uint32_t nExtensionTypesMask = 0;
+    };
+
+    // Set during WriteArrowBatch() when geometries have been pre-encoded
+    const std::vector<GPKGEncodedGeometry> *m_pasArrowBatchGeometries =
+        nullptr;
+    size_t m_nArrowBatchGeometryIdx = 0;
+    // Pre-encoded geometry of the feature being inserted, if any
+    const GPKGEncodedGeometry *m_psCurEncodedGeometry = nullptr;
+
+    bool EncodeArrowBatchGeometries(const struct ArrowSchema *schema,
+                                    const struct ArrowArray *array,
+                                    std::vector<GPKGEncodedGeometry> &asGeoms);
+
     void StartAsyncRTree();
     void CancelAsyncRTree();
     void RemoveAsyncRTreeTempDB();
     void AsyncRTreeThreadFunction();
 
+    CPLString BuildSelectSQL(GIntBig nStartIndex, bool &bUseSpatialIndex);
     OGRErr ResetStatementInternal(GIntBig nStartIndex);
     virtual OGRErr ResetStatement() override;
 
@@ -751,6 +782,7 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
 #endif
 
     void CheckGeometryType(const OGRFeature *poFeature);
+    void CheckGeometryType(OGRwkbGeometryType eFeatureGeomType);
 
     OGRErr ReadTableDefinition();
     void InitView();
@@ -784,7 +816,7 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
         std::string m_osErrorMsg{};
         std::unique_ptr<GDALGeoPackageDataset> m_poDS{};
         OGRGeoPackageTableLayer *m_poLayer{};
-        GIntBig m_iStartShapeId = 0;
+        GIntBig m_iStartShapeId = 0;  // FID cursor of the range to read
         std::unique_ptr<struct ArrowArray> m_psArrowArray = nullptr;
     };
     std::queue<std::unique_ptr<ArrowArrayPrefetchTask>>
@@ -845,6 +877,9 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
     OGRErr ICreateFeature(OGRFeature *poFeature) override;
     OGRErr ISetFeature(OGRFeature *poFeature) override;
     OGRErr IUpsertFeature(OGRFeature *poFeature) override;
+    bool WriteArrowBatch(const struct ArrowSchema *schema,
+                         struct ArrowArray *array,
+                         CSLConstList papszOptions = nullptr) override;
     OGRErr IUpdateFeature(OGRFeature *poFeature, int nUpdatedFieldsCount,
                           const int *panUpdatedFieldsIdx,
                           int nUpdatedGeomFieldsCount,
@@ -858,6 +893,7 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
     }
 
     OGRErr SetAttributeFilter(const char *pszQuery) override;
+    CPLStringList ExplainQuery() override;
     OGRErr SyncToDisk() override;
     OGRFeature *GetNextFeature() override;
     OGRFeature *GetFeature(GIntBig nFID) override;
@@ -8246,32 +8246,11 @@ static void OGRGeoPackageSTArea(sqlite3_context *pContext, int /*argc*/,
         }
         const GByte *pabyWkb = pabyBLOB + sHeader.nHeaderLen;
         size_t nWKBSize = nBLOBLen - sHeader.nHeaderLen;
-        bool bNeedSwap;
-        uint32_t nType;
-        if (OGRWKBGetGeomType(pabyWkb, nWKBSize, bNeedSwap, nType))
+        double dfArea;
+        if (OGRWKBGetArea(pabyWkb, nWKBSize, dfArea))
         {
-            if (nType == wkbPolygon || nType == wkbPolygon25D ||
-                nType == wkbPolygon + 1000 ||  // wkbPolygonZ
-                nType == wkbPolygonM || nType == wkbPolygonZM)
-            {
-                double dfArea;
-                if (OGRWKBPolygonGetArea(pabyWkb, nWKBSize, dfArea))
-                {
-                    sqlite3_result_double(pContext, dfArea);
-                    return;
-                }
-            }
-            else if (nType == wkbMultiPolygon || nType == wkbMultiPolygon25D ||
-                     nType == wkbMultiPolygon + 1000 ||  // wkbMultiPolygonZ
-                     nType == wkbMultiPolygonM || nType == wkbMultiPolygonZM)
-            {
-                double dfArea;
-                if (OGRWKBMultiPolygonGetArea(pabyWkb, nWKBSize, dfArea))
-                {
-                    sqlite3_result_double(pContext, dfArea);
-                    return;
-                }
-            }
+            sqlite3_result_double(pContext, dfArea);
+            return;
         }
 
         // For curve geometries, fallback to OGRGeometry methods
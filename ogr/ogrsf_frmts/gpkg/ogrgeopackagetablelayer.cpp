@@ -33,9 +33,13 @@
 #include "cpl_md5.h"
 #include "cpl_time.h"
 #include "ogr_p.h"
+#include "ogrlayerarrow.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "sqlite_rtree_bulk_load/wrapper.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <limits>
@@ -245,7 +249,22 @@ OGRErr OGRGeoPackageTableLayer::FeatureBindParameters(
     {
         // Non-NULL geometry.
         OGRGeometry *poGeom = poFeature->GetGeomFieldRef(0);
-        if (poGeom)
+        if (m_psCurEncodedGeometry &&
+            !m_psCurEncodedGeometry->abyBlob.empty())
+        {
+            // Geometry blob already encoded by WriteArrowBatch()
+            const auto &abyBlob = m_psCurEncodedGeometry->abyBlob;
+            int err = sqlite3_bind_blob(poStmt, nColCount++, abyBlob.data(),
+                                        static_cast<int>(abyBlob.size()),
+                                        SQLITE_STATIC);
+            if (err != SQLITE_OK)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "sqlite3_bind_blob() failed");
+                return OGRERR_FAILURE;
+            }
+        }
+        else if (poGeom && !m_psCurEncodedGeometry)
         {
             size_t szWkb = 0;
             GByte *pabyWkb = GPkgGeometryFromOGR(poGeom, m_iSrs, &szWkb);
@@ -2043,16 +2062,24 @@ void OGRGeoPackageTableLayer::DisableFeatureCountTriggers(
  * reflect the dimensionality of feature geometries.
  */
 void OGRGeoPackageTableLayer::CheckGeometryType(const OGRFeature *poFeature)
+{
+    const OGRGeometry *poGeom = poFeature->GetGeometryRef();
+    CheckGeometryType(poGeom ? poGeom->getGeometryType() : wkbNone);
+}
+
+/** Same as above, but from the (non-flattened) type of the geometry of the
+ * feature, or wkbNone if it has no geometry.
+ */
+void OGRGeoPackageTableLayer::CheckGeometryType(
+    OGRwkbGeometryType eFeatureGeomType)
 {
     const OGRwkbGeometryType eLayerGeomType = GetGeomType();
     const OGRwkbGeometryType eFlattenLayerGeomType = wkbFlatten(eLayerGeomType);
-    const OGRGeometry *poGeom = poFeature->GetGeometryRef();
     if (eFlattenLayerGeomType != wkbNone && eFlattenLayerGeomType != wkbUnknown)
     {
-        if (poGeom != nullptr)
+        if (eFeatureGeomType != wkbNone)
         {
-            OGRwkbGeometryType eGeomType =
-                wkbFlatten(poGeom->getGeometryType());
+            OGRwkbGeometryType eGeomType = wkbFlatten(eFeatureGeomType);
             if (!OGR_GT_IsSubClassOf(eGeomType, eFlattenLayerGeomType) &&
                 m_eSetBadGeomTypeWarned.find(eGeomType) ==
                     m_eSetBadGeomTypeWarned.end())
@@ -2078,10 +2105,10 @@ void OGRGeoPackageTableLayer::CheckGeometryType(const OGRFeature *poFeature)
     // if we have geometries with Z and M components
     if (m_nZFlag == 0 || m_nMFlag == 0)
     {
-        if (poGeom != nullptr)
+        if (eFeatureGeomType != wkbNone)
         {
             bool bUpdateGpkgGeometryColumnsTable = false;
-            const OGRwkbGeometryType eGeomType = poGeom->getGeometryType();
+            const OGRwkbGeometryType eGeomType = eFeatureGeomType;
             if (m_nZFlag == 0 && wkbHasZ(eGeomType))
             {
                 if (eLayerGeomType != wkbUnknown && !wkbHasZ(eLayerGeomType))
@@ -2221,6 +2248,21 @@ OGRErr OGRGeoPackageTableLayer::CreateOrUpsertFeature(OGRFeature *poFeature,
         return OGRERR_FAILURE;
 
     CancelAsyncNextArrowArray();
+    m_nIsCompatOfOptimizedGetNextArrowArray = -1;
+
+    // Geometry already encoded by WriteArrowBatch(), if any
+    const GPKGEncodedGeometry *psEncodedGeom = nullptr;
+    if (m_pasArrowBatchGeometries && !bUpsert)
+    {
+        if (m_nArrowBatchGeometryIdx >= m_pasArrowBatchGeometries->size())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Inconsistent number of encoded geometries");
+            return OGRERR_FAILURE;
+        }
+        psEncodedGeom =
+            &(*m_pasArrowBatchGeometries)[m_nArrowBatchGeometryIdx++];
+    }
 
     std::string osUpsertUniqueColumnName;
     if (bUpsert && poFeature->GetFID() == OGRNullFID)
@@ -2289,7 +2331,21 @@ OGRErr OGRGeoPackageTableLayer::CreateOrUpsertFeature(OGRFeature *poFeature,
     }
 #endif
 
-    CheckGeometryType(poFeature);
+    if (psEncodedGeom)
+    {
+        CheckGeometryType(psEncodedGeom->eGeomType);
+        for (int i = wkbGeometryCollection + 1;
+             i <= static_cast<int>(wkbTriangle); ++i)
+        {
+            if ((psEncodedGeom->nExtensionTypesMask >> i) & 1)
+                CreateGeometryExtensionIfNecessary(
+                    static_cast<OGRwkbGeometryType>(i));
+        }
+    }
+    else
+    {
+        CheckGeometryType(poFeature);
+    }
 
     /* Substitute default values for null Date/DateTime fields as the standard
      */
@@ -2396,9 +2452,11 @@ OGRErr OGRGeoPackageTableLayer::CreateOrUpsertFeature(OGRFeature *poFeature,
     }
 
     /* Bind values onto the statement now */
+    m_psCurEncodedGeometry = psEncodedGeom;
     OGRErr errOgr = FeatureBindInsertParameters(poFeature, m_poInsertStatement,
                                                 m_bInsertStatementWithFID,
                                                 !bHasDefaultValue);
+    m_psCurEncodedGeometry = nullptr;
     if (errOgr != OGRERR_NONE)
     {
         sqlite3_reset(m_poInsertStatement);
@@ -2458,88 +2516,98 @@ OGRErr OGRGeoPackageTableLayer::CreateOrUpsertFeature(OGRFeature *poFeature,
     }
 
     /* Update the layer extents with this new object */
-    if (IsGeomFieldSet(poFeature))
+    OGREnvelope oEnv;
+    bool bHasNonEmptyGeom = false;
+    if (psEncodedGeom)
     {
-        OGRGeometry *poGeom = poFeature->GetGeomFieldRef(0);
+        bHasNonEmptyGeom =
+            !psEncodedGeom->abyBlob.empty() && !psEncodedGeom->bEmpty;
+        oEnv = psEncodedGeom->sEnvelope;
+    }
+    else if (IsGeomFieldSet(poFeature))
+    {
+        const OGRGeometry *poGeom = poFeature->GetGeomFieldRef(0);
         if (!poGeom->IsEmpty())
         {
-            OGREnvelope oEnv;
+            bHasNonEmptyGeom = true;
             poGeom->getEnvelope(&oEnv);
-            UpdateExtent(&oEnv);
+        }
+    }
+    if (bHasNonEmptyGeom)
+    {
+        UpdateExtent(&oEnv);
 
-            if (!bUpsert && !m_bDeferredSpatialIndexCreation &&
-                HasSpatialIndex() && m_poDS->IsInTransaction())
+        if (!bUpsert && !m_bDeferredSpatialIndexCreation && HasSpatialIndex() &&
+            m_poDS->IsInTransaction())
+        {
+            m_nCountInsertInTransaction++;
+            if (m_nCountInsertInTransactionThreshold < 0)
             {
-                m_nCountInsertInTransaction++;
-                if (m_nCountInsertInTransactionThreshold < 0)
-                {
-                    m_nCountInsertInTransactionThreshold =
-                        atoi(CPLGetConfigOption(
-                            "OGR_GPKG_DEFERRED_SPI_UPDATE_THRESHOLD", "100"));
-                }
-                if (m_nCountInsertInTransaction ==
-                    m_nCountInsertInTransactionThreshold)
-                {
-                    StartDeferredSpatialIndexUpdate();
-                }
-                else if (!m_aoRTreeTriggersSQL.empty())
-                {
-                    if (m_aoRTreeEntries.size() == 1000 * 1000)
-                    {
-                        if (!FlushPendingSpatialIndexUpdate())
-                            return OGRERR_FAILURE;
-                    }
-                    GPKGRTreeEntry sEntry;
-                    sEntry.nId = nFID;
-                    sEntry.fMinX = rtreeValueDown(oEnv.MinX);
-                    sEntry.fMaxX = rtreeValueUp(oEnv.MaxX);
-                    sEntry.fMinY = rtreeValueDown(oEnv.MinY);
-                    sEntry.fMaxY = rtreeValueUp(oEnv.MaxY);
-                    m_aoRTreeEntries.push_back(sEntry);
-                }
+                m_nCountInsertInTransactionThreshold =
+                    atoi(CPLGetConfigOption(
+                        "OGR_GPKG_DEFERRED_SPI_UPDATE_THRESHOLD", "100"));
             }
-            else if (!bUpsert && m_bAllowedRTreeThread &&
-                     !m_bErrorDuringRTreeThread)
+            if (m_nCountInsertInTransaction ==
+                m_nCountInsertInTransactionThreshold)
             {
+                StartDeferredSpatialIndexUpdate();
+            }
+            else if (!m_aoRTreeTriggersSQL.empty())
+            {
+                if (m_aoRTreeEntries.size() == 1000 * 1000)
+                {
+                    if (!FlushPendingSpatialIndexUpdate())
+                        return OGRERR_FAILURE;
+                }
                 GPKGRTreeEntry sEntry;
-#ifdef DEBUG_VERBOSE
-                if (m_aoRTreeEntries.empty())
-                    CPLDebug("GPKG",
-                             "Starting to fill m_aoRTreeEntries at "
-                             "FID " CPL_FRMT_GIB,
-                             nFID);
-#endif
                 sEntry.nId = nFID;
                 sEntry.fMinX = rtreeValueDown(oEnv.MinX);
                 sEntry.fMaxX = rtreeValueUp(oEnv.MaxX);
                 sEntry.fMinY = rtreeValueDown(oEnv.MinY);
                 sEntry.fMaxY = rtreeValueUp(oEnv.MaxY);
-                try
+                m_aoRTreeEntries.push_back(sEntry);
+            }
+        }
+        else if (!bUpsert && m_bAllowedRTreeThread &&
+                 !m_bErrorDuringRTreeThread)
+        {
+            GPKGRTreeEntry sEntry;
+#ifdef DEBUG_VERBOSE
+            if (m_aoRTreeEntries.empty())
+                CPLDebug("GPKG",
+                         "Starting to fill m_aoRTreeEntries at "
+                         "FID " CPL_FRMT_GIB,
+                         nFID);
+#endif
+            sEntry.nId = nFID;
+            sEntry.fMinX = rtreeValueDown(oEnv.MinX);
+            sEntry.fMaxX = rtreeValueUp(oEnv.MaxX);
+            sEntry.fMinY = rtreeValueDown(oEnv.MinY);
+            sEntry.fMaxY = rtreeValueUp(oEnv.MaxY);
+            try
+            {
+                m_aoRTreeEntries.push_back(sEntry);
+                if (m_aoRTreeEntries.size() == m_nRTreeBatchSize)
                 {
-                    m_aoRTreeEntries.push_back(sEntry);
-                    if (m_aoRTreeEntries.size() == m_nRTreeBatchSize)
-                    {
-                        m_oQueueRTreeEntries.push(std::move(m_aoRTreeEntries));
-                        m_aoRTreeEntries = std::vector<GPKGRTreeEntry>();
-                    }
-                    if (!m_bThreadRTreeStarted &&
-                        m_oQueueRTreeEntries.size() ==
-                            m_nRTreeBatchesBeforeStart)
-                    {
-                        StartAsyncRTree();
-                    }
+                    m_oQueueRTreeEntries.push(std::move(m_aoRTreeEntries));
+                    m_aoRTreeEntries = std::vector<GPKGRTreeEntry>();
                 }
-                catch (const std::bad_alloc &)
+                if (!m_bThreadRTreeStarted &&
+                    m_oQueueRTreeEntries.size() == m_nRTreeBatchesBeforeStart)
                 {
-                    CPLDebug("GPKG",
-                             "Memory allocation error regarding RTree "
-                             "structures. Falling back to slower method");
-                    if (m_bThreadRTreeStarted)
-                        CancelAsyncRTree();
-                    else
-                        m_bAllowedRTreeThread = false;
+                    StartAsyncRTree();
                 }
             }
+            catch (const std::bad_alloc &)
+            {
+                CPLDebug("GPKG",
+                         "Memory allocation error regarding RTree "
+                         "structures. Falling back to slower method");
+                if (m_bThreadRTreeStarted)
+                    CancelAsyncRTree();
+                else
+                    m_bAllowedRTreeThread = false;
+            }
         }
     }
 
@@ -2586,6 +2654,274 @@ void OGRGeoPackageTableLayer::SetDeferredSpatialIndexCreation(bool bFlag)
     }
 }
 
+/************************************************************************/
+/*                     GPKGCollectExtensionTypes()                      */
+/************************************************************************/
+
+// Same logic as CreateGeometryExtensionIfNecessary(const OGRGeometry*), but
+// only collecting the geometry types, so that it can run in worker threads.
+static void GPKGCollectExtensionTypes(const OGRGeometry *poGeom,
+                                      uint32_t &nMask)
+{
+    const OGRwkbGeometryType eGType = wkbFlatten(poGeom->getGeometryType());
+    if (eGType >= wkbGeometryCollection)
+    {
+        if (eGType > wkbGeometryCollection && eGType <= wkbTriangle)
+            nMask |= 1U << eGType;
+        const auto poGC = dynamic_cast<const OGRGeometryCollection *>(poGeom);
+        if (poGC != nullptr)
+        {
+            for (const auto *poSubGeom : *poGC)
+                GPKGCollectExtensionTypes(poSubGeom, nMask);
+        }
+    }
+}
+
+/************************************************************************/
+/*                     EncodeArrowBatchGeometries()                     */
+/************************************************************************/
+
+// Converts the WKB geometries of an Arrow binary/large binary array to
+// GeoPackage blobs, using the global thread pool for large batches.
+bool OGRGeoPackageTableLayer::EncodeArrowBatchGeometries(
+    const struct ArrowSchema *schema, const struct ArrowArray *array,
+    std::vector<GPKGEncodedGeometry> &asGeoms)
+{
+    const bool bLargeBinary = schema->format[0] == 'Z';
+    const size_t nCount = static_cast<size_t>(array->length);
+    const auto nOffset = static_cast<size_t>(array->offset);
+    const GByte *pabyValidity =
+        array->null_count != 0 ? static_cast<const GByte *>(array->buffers[0])
+                               : nullptr;
+    const auto panOffsets32 = static_cast<const int32_t *>(array->buffers[1]);
+    const auto panOffsets64 = static_cast<const int64_t *>(array->buffers[1]);
+    const auto pabyData = static_cast<const GByte *>(array->buffers[2]);
+    const int iSrs = m_iSrs;
+
+    try
+    {
+        asGeoms.resize(nCount);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate encoded geometry array");
+        return false;
+    }
+
+    // Index of the first geometry that could not be encoded
+    std::atomic<size_t> nFirstError{nCount};
+
+    const auto EncodeChunk = [&](size_t nStart, size_t nEnd)
+    {
+        for (size_t i = nStart; i < nEnd; ++i)
+        {
+            const size_t iRow = nOffset + i;
+            if (pabyValidity &&
+                (pabyValidity[iRow / 8] & (1 << (iRow % 8))) == 0)
+            {
+                continue;
+            }
+            const size_t nStartOffset =
+                bLargeBinary ? static_cast<size_t>(panOffsets64[iRow])
+                             : static_cast<size_t>(panOffsets32[iRow]);
+            const size_t nEndOffset =
+                bLargeBinary ? static_cast<size_t>(panOffsets64[iRow + 1])
+                             : static_cast<size_t>(panOffsets32[iRow + 1]);
+
+            // Like the generic implementation, invalid WKB is written as a
+            // null geometry.
+            OGRGeometry *poGeom = nullptr;
+            size_t nBytesConsumedOut = 0;
+            if (nEndOffset <= nStartOffset ||
+                OGRGeometryFactory::createFromWkb(
+                    pabyData + nStartOffset, nullptr, &poGeom,
+                    nEndOffset - nStartOffset, wkbVariantIso,
+                    nBytesConsumedOut) != OGRERR_NONE)
+            {
+                continue;
+            }
+            std::unique_ptr<OGRGeometry> poGeomHolder(poGeom);
+
+            auto &sGeom = asGeoms[i];
+            size_t nBlobSize = 0;
+            GByte *pabyBlob = GPkgGeometryFromOGR(poGeom, iSrs, &nBlobSize);
+            if (pabyBlob == nullptr)
+            {
+                size_t nExpected = nFirstError.load();
+                while (i < nExpected &&
+                       !nFirstError.compare_exchange_weak(nExpected, i))
+                {
+                }
+                return;
+            }
+            sGeom.abyBlob.assign(pabyBlob, pabyBlob + nBlobSize);
+            CPLFree(pabyBlob);
+            sGeom.eGeomType = poGeom->getGeometryType();
+            sGeom.bEmpty = CPL_TO_BOOL(poGeom->IsEmpty());
+            if (!sGeom.bEmpty)
+                poGeom->getEnvelope(&sGeom.sEnvelope);
+            GPKGCollectExtensionTypes(poGeom, sGeom.nExtensionTypesMask);
+        }
+    };
+
+    constexpr size_t MIN_GEOMS_PER_THREAD = 1000;
+    CPLWorkerThreadPool *poPool = nullptr;
+    if (nCount >= 2 * MIN_GEOMS_PER_THREAD)
+    {
+        const char *pszNumThreads =
+            CPLGetConfigOption("OGR_GPKG_NUM_THREADS", nullptr);
+        int nThreadsMax;
+        if (pszNumThreads == nullptr)
+            nThreadsMax = std::min(4, CPLGetNumCPUs());
+        else if (EQUAL(pszNumThreads, "ALL_CPUS"))
+            nThreadsMax = CPLGetNumCPUs();
+        else
+            nThreadsMax = std::max(1, atoi(pszNumThreads));
+        const int nThreads = static_cast<int>(
+            std::min(static_cast<size_t>(std::min(nThreadsMax, 128)),
+                     nCount / MIN_GEOMS_PER_THREAD));
+        if (nThreads > 1)
+            poPool = GDALGetGlobalThreadPool(nThreads);
+    }
+
+    if (poPool == nullptr)
+    {
+        EncodeChunk(0, nCount);
+    }
+    else
+    {
+        struct JobData
+        {
+            const decltype(EncodeChunk) *pfnChunk;
+            size_t nStart;
+            size_t nEnd;
+        };
+
+        const size_t nChunkSize = std::max<size_t>(
+            MIN_GEOMS_PER_THREAD / 4,
+            nCount / (4 * static_cast<size_t>(poPool->GetThreadCount())));
+        std::vector<JobData> asJobs;
+        for (size_t nStart = 0; nStart < nCount; nStart += nChunkSize)
+            asJobs.push_back(
+                {&EncodeChunk, nStart, std::min(nCount, nStart + nChunkSize)});
+
+        auto poQueue = poPool->CreateJobQueue();
+        for (auto &sJob : asJobs)
+        {
+            poQueue->SubmitJob(
+                [](void *pData)
+                {
+                    const auto psJob = static_cast<const JobData *>(pData);
+                    (*psJob->pfnChunk)(psJob->nStart, psJob->nEnd);
+                },
+                &sJob);
+        }
+        poQueue->WaitCompletion();
+    }
+
+    if (nFirstError.load() != nCount)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot encode geometry of Arrow array row " CPL_FRMT_GUIB,
+                 static_cast<GUIntBig>(nFirstError.load()));
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                         WriteArrowBatch()                            */
+/************************************************************************/
+
+// The attributes are written through the generic implementation, but the
+// geometries, whose conversion from WKB to GeoPackage blobs dominates the
+// cost of the insertion, are encoded by worker threads beforehand.
+bool OGRGeoPackageTableLayer::WriteArrowBatch(const struct ArrowSchema *schema,
+                                              struct ArrowArray *array,
+                                              CSLConstList papszOptions)
+{
+    if (!m_bFeatureDefnCompleted)
+        GetLayerDefn();
+    if (!m_poDS->GetUpdate() || m_poFeatureDefn->GetGeomFieldCount() == 0 ||
+        strcmp(schema->format, "+s") != 0 ||
+        schema->n_children != array->n_children)
+    {
+        return OGRLayer::WriteArrowBatch(schema, array, papszOptions);
+    }
+
+    // Identify the geometry column, with the same rules as the generic
+    // implementation.
+    const char *pszGeomFieldName = CSLFetchNameValueDef(
+        papszOptions, "GEOMETRY_NAME", GetGeometryColumn());
+    if (!pszGeomFieldName || pszGeomFieldName[0] == 0)
+        pszGeomFieldName = DEFAULT_ARROW_GEOMETRY_NAME;
+    int iGeomChild = -1;
+    for (int i = 0; i < static_cast<int>(schema->n_children); ++i)
+    {
+        const auto psChildSchema = schema->children[i];
+        if (strcmp(psChildSchema->format, "z") != 0 &&
+            strcmp(psChildSchema->format, "Z") != 0)
+        {
+            continue;
+        }
+        bool bIsGeom = strcmp(psChildSchema->name, pszGeomFieldName) == 0 ||
+                       strcmp(psChildSchema->name, GetGeometryColumn()) == 0;
+        if (!bIsGeom && psChildSchema->metadata)
+        {
+            const auto oMetadata =
+                OGRParseArrowMetadata(psChildSchema->metadata);
+            const auto oIter = oMetadata.find(ARROW_EXTENSION_NAME_KEY);
+            bIsGeom = oIter != oMetadata.end() &&
+                      (oIter->second == EXTENSION_NAME_OGC_WKB ||
+                       oIter->second == EXTENSION_NAME_GEOARROW_WKB);
+        }
+        if (bIsGeom)
+        {
+            iGeomChild = i;
+            break;
+        }
+    }
+    if (iGeomChild < 0)
+        return OGRLayer::WriteArrowBatch(schema, array, papszOptions);
+
+    std::vector<GPKGEncodedGeometry> asGeoms;
+    if (!EncodeArrowBatchGeometries(schema->children[iGeomChild],
+                                    array->children[iGeomChild], asGeoms))
+    {
+        return false;
+    }
+
+    // Present the batch without its geometry column to the generic
+    // implementation. Those are shallow views that must not be released.
+    std::vector<struct ArrowSchema *> apsSchemaChildren;
+    std::vector<struct ArrowArray *> apsArrayChildren;
+    for (int i = 0; i < static_cast<int>(schema->n_children); ++i)
+    {
+        if (i != iGeomChild)
+        {
+            apsSchemaChildren.push_back(schema->children[i]);
+            apsArrayChildren.push_back(array->children[i]);
+        }
+    }
+    struct ArrowSchema sSchemaWithoutGeom = *schema;
+    sSchemaWithoutGeom.n_children =
+        static_cast<int64_t>(apsSchemaChildren.size());
+    sSchemaWithoutGeom.children = apsSchemaChildren.data();
+    struct ArrowArray sArrayWithoutGeom = *array;
+    sArrayWithoutGeom.n_children =
+        static_cast<int64_t>(apsArrayChildren.size());
+    sArrayWithoutGeom.children = apsArrayChildren.data();
+
+    m_pasArrowBatchGeometries = &asGeoms;
+    m_nArrowBatchGeometryIdx = 0;
+    const bool bRet = OGRLayer::WriteArrowBatch(
+        &sSchemaWithoutGeom, &sArrayWithoutGeom, papszOptions);
+    m_pasArrowBatchGeometries = nullptr;
+    m_nArrowBatchGeometryIdx = 0;
+    return bRet;
+}
+
 /************************************************************************/
 /*                          StartAsyncRTree()                           */
 /************************************************************************/
@@ -3389,16 +3725,16 @@ OGRErr OGRGeoPackageTableLayer::ResetStatement()
 }
 
 /************************************************************************/
-/*                       ResetStatementInternal()                       */
+/*                           BuildSelectSQL()                           */
 /************************************************************************/
 
-OGRErr OGRGeoPackageTableLayer::ResetStatementInternal(GIntBig nStartIndex)
-
+/* Returns the SELECT statement that retrieves the features matching the
+ * current filters, and whether it uses the RTree. */
+CPLString OGRGeoPackageTableLayer::BuildSelectSQL(GIntBig nStartIndex,
+                                                  bool &bUseSpatialIndex)
 {
-    ClearStatement();
+    bUseSpatialIndex = false;
 
-    /* There is no active query statement set up, */
-    /* so job #1 is to prepare the statement. */
     /* Append the attribute filter, if there is one */
     CPLString soSQL;
     if (!m_soFilter.empty())
@@ -3413,7 +3749,7 @@ OGRErr OGRGeoPackageTableLayer::ResetStatementInternal(GIntBig nStartIndex)
 
             m_poFilterGeom->getEnvelope(&sEnvelope);
 
-            bool bUseSpatialIndex = true;
+            bool bSmallerThanExtent = true;
             if (m_poExtent && sEnvelope.MinX <= m_poExtent->MinX &&
                 sEnvelope.MinY <= m_poExtent->MinY &&
                 sEnvelope.MaxX >= m_poExtent->MaxX &&
@@ -3423,10 +3759,10 @@ OGRErr OGRGeoPackageTableLayer::ResetStatementInternal(GIntBig nStartIndex)
                 // slow. So use function based filtering, just in case the
                 // advertized global extent might be wrong. Otherwise we might
                 // just discard completely the spatial filter.
-                bUseSpatialIndex = false;
+                bSmallerThanExtent = false;
             }
 
-            if (bUseSpatialIndex && !CPLIsInf(sEnvelope.MinX) &&
+            if (bSmallerThanExtent && !CPLIsInf(sEnvelope.MinX) &&
                 !CPLIsInf(sEnvelope.MinY) && !CPLIsInf(sEnvelope.MaxX) &&
                 !CPLIsInf(sEnvelope.MaxY))
             {
@@ -3441,6 +3777,7 @@ OGRErr OGRGeoPackageTableLayer::ResetStatementInternal(GIntBig nStartIndex)
                              SQLEscapeName(m_osFIDForRTree).c_str(),
                              sEnvelope.MinX - 1e-11, sEnvelope.MaxX + 1e-11,
                              sEnvelope.MinY - 1e-11, sEnvelope.MaxY + 1e-11);
+                bUseSpatialIndex = true;
             }
         }
     }
@@ -3452,6 +3789,77 @@ OGRErr OGRGeoPackageTableLayer::ResetStatementInternal(GIntBig nStartIndex)
         soSQL += CPLSPrintf(" LIMIT -1 OFFSET " CPL_FRMT_GIB, nStartIndex);
     }
 
+    return soSQL;
+}
+
+/************************************************************************/
+/*                            ExplainQuery()                            */
+/************************************************************************/
+
+CPLStringList OGRGeoPackageTableLayer::ExplainQuery()
+{
+    if (!m_bFeatureDefnCompleted)
+        GetLayerDefn();
+    CPLStringList aosPlan(OGRGeoPackageLayer::ExplainQuery());
+    if (m_bDeferredCreation)
+        return aosPlan;
+
+    bool bUseSpatialIndex = false;
+    const CPLString osSQL = BuildSelectSQL(0, bUseSpatialIndex);
+    if (m_poFilterGeom != nullptr)
+    {
+        aosPlan.SetNameValue("SPATIAL_FILTER",
+                             bUseSpatialIndex ? "INDEX" : "SCAN");
+    }
+
+    // Ask SQLite how it will run the query. The fourth column of
+    // EXPLAIN QUERY PLAN is the description of each step.
+    const auto oResult = SQLQuery(m_poDS->GetDB(),
+                                  ("EXPLAIN QUERY PLAN " + osSQL).c_str());
+    if (oResult && oResult->ColCount() >= 4)
+    {
+        std::string osPlan;
+        bool bAttrIndexUsed = false;
+        for (int i = 0; i < oResult->RowCount(); ++i)
+        {
+            const char *pszDetail = oResult->GetValue(3, i);
+            if (pszDetail == nullptr)
+                continue;
+            if (!osPlan.empty())
+                osPlan += "; ";
+            osPlan += pszDetail;
+            if (strstr(pszDetail, "USING INDEX") ||
+                strstr(pszDetail, "USING COVERING INDEX") ||
+                strstr(pszDetail, "USING INTEGER PRIMARY KEY"))
+            {
+                bAttrIndexUsed = true;
+            }
+        }
+        if (m_pszAttrQueryString != nullptr)
+        {
+            aosPlan.SetNameValue("ATTRIBUTE_INDEX",
+                                 bAttrIndexUsed ? "YES" : "NO");
+        }
+        aosPlan.SetNameValue("BACKEND_PLAN", osPlan.c_str());
+    }
+
+    return aosPlan;
+}
+
+/************************************************************************/
+/*                       ResetStatementInternal()                       */
+/************************************************************************/
+
+OGRErr OGRGeoPackageTableLayer::ResetStatementInternal(GIntBig nStartIndex)
+
+{
+    ClearStatement();
+
+    /* There is no active query statement set up, */
+    /* so job #1 is to prepare the statement. */
+    bool bUseSpatialIndex = false;
+    const CPLString soSQL = BuildSelectSQL(nStartIndex, bUseSpatialIndex);
+
     CPLDebug("GPKG", "ResetStatement(%s)", soSQL.c_str());
 
     int err = sqlite3_prepare_v2(m_poDS->GetDB(), soSQL.c_str(), -1,
@@ -3582,6 +3990,7 @@ OGRErr OGRGeoPackageTableLayer::DeleteFeature(GIntBig nFID)
         return OGRERR_FAILURE;
 
     CancelAsyncNextArrowArray();
+    m_nIsCompatOfOptimizedGetNextArrowArray = -1;
 
     if (m_bThreadRTreeStarted)
         CancelAsyncRTree();
@@ -8327,35 +8736,40 @@ int OGRGeoPackageTableLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
         return GetNextArrowArrayAsynchronous(stream, out_array);
     }
 
-    // We can use this optimized version only if there is no hole in FID
-    // numbering. That is min(fid) == 1 and max(fid) == m_nTotalFeatureCount
+    // We can use this optimized version only if the FID numbering is not
+    // too sparse, since batches are read by ranges of FIDs of the size of the
+    // batch.
     if (m_nIsCompatOfOptimizedGetNextArrowArray < 0)
     {
         m_nIsCompatOfOptimizedGetNextArrowArray = FALSE;
         const auto nTotalFeatureCount = GetTotalFeatureCount();
-        if (nTotalFeatureCount < 0)
+        if (nTotalFeatureCount <= 0)
             return GetNextArrowArrayAsynchronous(stream, out_array);
         {
             char *pszSQL = sqlite3_mprintf("SELECT MAX(\"%w\") FROM \"%w\"",
                                            m_pszFidColumn, m_pszTableName);
             OGRErr err;
-            const auto nMaxFID = SQLGetInteger64(m_poDS->GetDB(), pszSQL, &err);
+            m_nArrowMaxFID = SQLGetInteger64(m_poDS->GetDB(), pszSQL, &err);
             sqlite3_free(pszSQL);
-            if (nMaxFID != nTotalFeatureCount)
-                return GetNextArrowArrayAsynchronous(stream, out_array);
         }
         {
             char *pszSQL = sqlite3_mprintf("SELECT MIN(\"%w\") FROM \"%w\"",
                                            m_pszFidColumn, m_pszTableName);
             OGRErr err;
-            const auto nMinFID = SQLGetInteger64(m_poDS->GetDB(), pszSQL, &err);
+            m_nArrowMinFID = SQLGetInteger64(m_poDS->GetDB(), pszSQL, &err);
             sqlite3_free(pszSQL);
-            if (nMinFID != 1)
-                return GetNextArrowArrayAsynchronous(stream, out_array);
+        }
+        // Require at least half of the FID range to be used
+        if (m_nArrowMinFID < 1 || m_nArrowMaxFID < m_nArrowMinFID ||
+            (m_nArrowMaxFID - m_nArrowMinFID) / 2 >= nTotalFeatureCount)
+        {
+            return GetNextArrowArrayAsynchronous(stream, out_array);
         }
         m_nIsCompatOfOptimizedGetNextArrowArray = TRUE;
     }
 
+    if (!m_bGetNextArrowArrayCalledSinceResetReading)
+        m_nArrowFIDCursor = m_nArrowMinFID - 1;
     m_bGetNextArrowArrayCalledSinceResetReading = true;
 
     // CPLDebug("GPKG", "m_iNextShapeId = " CPL_FRMT_GIB, m_iNextShapeId);
@@ -8394,27 +8808,36 @@ int OGRGeoPackageTableLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
                 task->m_oThread.join();
         };
 
-        if (task->m_iStartShapeId != m_iNextShapeId)
+        if (task->m_iStartShapeId != m_nArrowFIDCursor)
         {
             // Should not normally happen, unless the user messes with
             // GetNextFeature()
             CPLError(CE_Failure, CPLE_AppDefined,
                      "Worker thread task has not expected m_iStartShapeId "
                      "value. Got " CPL_FRMT_GIB ", expected " CPL_FRMT_GIB,
-                     task->m_iStartShapeId, m_iNextShapeId);
+                     task->m_iStartShapeId, m_nArrowFIDCursor);
             if (task->m_psArrowArray->release)
                 task->m_psArrowArray->release(task->m_psArrowArray.get());
 
             stopThread();
         }
-        else if (task->m_psArrowArray->release)
+        else if (task->m_psArrowArray->release ||
+                 (task->m_osErrorMsg.empty() && !task->m_bMemoryLimitReached))
         {
-            m_iNextShapeId += task->m_psArrowArray->length;
+            // A null array without error means that the FID range of the
+            // task had no feature.
+            const bool bEmptyRange = task->m_psArrowArray->release == nullptr;
+            if (!bEmptyRange)
+            {
+                m_iNextShapeId += task->m_psArrowArray->length;
 
-            // Transfer the task ArrowArray to the client array
-            memcpy(out_array, task->m_psArrowArray.get(),
-                   sizeof(struct ArrowArray));
-            memset(task->m_psArrowArray.get(), 0, sizeof(struct ArrowArray));
+                // Transfer the task ArrowArray to the client array
+                memcpy(out_array, task->m_psArrowArray.get(),
+                       sizeof(struct ArrowArray));
+                memset(task->m_psArrowArray.get(), 0,
+                       sizeof(struct ArrowArray));
+            }
+            m_nArrowFIDCursor = task->m_poLayer->m_nArrowFIDCursor;
 
             if (task->m_bMemoryLimitReached)
             {
@@ -8426,12 +8849,12 @@ int OGRGeoPackageTableLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
             // Are the records still available for reading beyond the current
             // queued tasks ? If so, recycle this task to read them
             else if (task->m_iStartShapeId +
-                         static_cast<GIntBig>(nTasks) * nMaxBatchSize <=
-                     m_nTotalFeatureCount)
+                         static_cast<GIntBig>(nTasks) * nMaxBatchSize <
+                     m_nArrowMaxFID)
             {
                 task->m_iStartShapeId +=
                     static_cast<GIntBig>(nTasks) * nMaxBatchSize;
-                task->m_poLayer->m_iNextShapeId = task->m_iStartShapeId;
+                task->m_poLayer->m_nArrowFIDCursor = task->m_iStartShapeId;
                 try
                 {
                     // Wake-up thread with new task
@@ -8441,6 +8864,8 @@ int OGRGeoPackageTableLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
                         task->m_oCV.notify_one();
                     }
                     m_oQueueArrowArrayPrefetchTasks.push(std::move(task));
+                    if (bEmptyRange)
+                        return GetNextArrowArray(stream, out_array);
                     return 0;
                 }
                 catch (const std::exception &e)
@@ -8452,6 +8877,8 @@ int OGRGeoPackageTableLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
             else
             {
                 stopThread();
+                if (bEmptyRange)
+                    return GetNextArrowArray(stream, out_array);
                 return 0;
             }
         }
@@ -8474,13 +8901,13 @@ int OGRGeoPackageTableLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
     // Start asynchronous tasks to prefetch the next ArrowArray
     if (m_poDS->GetAccess() == GA_ReadOnly &&
         m_oQueueArrowArrayPrefetchTasks.empty() &&
-        m_iNextShapeId + 2 * static_cast<GIntBig>(nMaxBatchSize) <=
-            m_nTotalFeatureCount &&
+        m_nArrowFIDCursor + 2 * static_cast<GIntBig>(nMaxBatchSize) <=
+            m_nArrowMaxFID &&
         sqlite3_threadsafe() != 0 && GetThreadsAvailable() >= 2 &&
         CPLGetUsablePhysicalRAM() > 1024 * 1024 * 1024)
     {
         const int nMaxTasks = static_cast<int>(std::min<GIntBig>(
-            DIV_ROUND_UP(m_nTotalFeatureCount - nMaxBatchSize - m_iNextShapeId,
+            DIV_ROUND_UP(m_nArrowMaxFID - nMaxBatchSize - m_nArrowFIDCursor,
                          nMaxBatchSize),
             GetThreadsAvailable()));
         CPLDebug("GPKG", "Using %d threads", nMaxTasks);
@@ -8491,7 +8918,7 @@ int OGRGeoPackageTableLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
         {
             auto task = std::make_unique<ArrowArrayPrefetchTask>();
             task->m_iStartShapeId =
-                m_iNextShapeId +
+                m_nArrowFIDCursor +
                 static_cast<GIntBig>(iTask + 1) * nMaxBatchSize;
             task->m_poDS = std::make_unique<GDALGeoPackageDataset>();
             if (!task->m_poDS->Open(&oOpenInfo, m_poDS->m_osFilenameInZip))
@@ -8519,6 +8946,7 @@ int OGRGeoPackageTableLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
             memset(task->m_psArrowArray.get(), 0, sizeof(struct ArrowArray));
 
             poOtherLayer->m_nTotalFeatureCount = m_nTotalFeatureCount;
+            poOtherLayer->m_nArrowMaxFID = m_nArrowMaxFID;
             poOtherLayer->m_aosArrowArrayStreamOptions =
                 m_aosArrowArrayStreamOptions;
             auto poOtherFDefn = poOtherLayer->GetLayerDefn();
@@ -8533,7 +8961,7 @@ int OGRGeoPackageTableLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
                     m_poFeatureDefn->GetFieldDefn(i)->IsIgnored());
             }
 
-            poOtherLayer->m_iNextShapeId = task->m_iStartShapeId;
+            poOtherLayer->m_nArrowFIDCursor = task->m_iStartShapeId;
 
             auto taskPtr = task.get();
             auto taskRunner = [taskPtr]()
@@ -8583,6 +9011,12 @@ int OGRGeoPackageTableLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
         CancelAsyncNextArrowArray();
         m_nIsCompatOfOptimizedGetNextArrowArray = false;
     }
+    else if (ret == 0 && out_array->release == nullptr &&
+             osErrorMsg.empty() && m_nArrowFIDCursor < m_nArrowMaxFID)
+    {
+        // Empty FID range: go on with the next one
+        return GetNextArrowArray(stream, out_array);
+    }
     return ret;
 }
 
@@ -8597,7 +9031,7 @@ int OGRGeoPackageTableLayer::GetNextArrowArrayInternal(
     bMemoryLimitReached = false;
     memset(out_array, 0, sizeof(*out_array));
 
-    if (m_iNextShapeId >= m_nTotalFeatureCount)
+    if (m_nArrowFIDCursor >= m_nArrowMaxFID)
     {
         return 0;
     }
@@ -8673,9 +9107,9 @@ int OGRGeoPackageTableLayer::GetNextArrowArrayInternal(
     osSQL += "\" WHERE \"";
     osSQL += SQLEscapeName(m_pszFidColumn);
     osSQL += "\" BETWEEN ";
-    osSQL += std::to_string(m_iNextShapeId + 1);
+    osSQL += std::to_string(m_nArrowFIDCursor + 1);
     osSQL += " AND ";
-    osSQL += std::to_string(m_iNextShapeId +
+    osSQL += std::to_string(m_nArrowFIDCursor +
                             sFillArrowArray.psHelper->m_nMaxBatchSize);
 
     // CPLDebug("GPKG", "%s", osSQL.c_str());
@@ -8712,6 +9146,7 @@ int OGRGeoPackageTableLayer::GetNextArrowArrayInternal(
     }
 
     m_iNextShapeId += sFillArrowArray.nCountRows;
+    m_nArrowFIDCursor += sFillArrowArray.psHelper->m_nMaxBatchSize;
 
     return 0;
 }
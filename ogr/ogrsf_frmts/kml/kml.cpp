@@ -29,6 +29,7 @@
 #include "kmlnode.h"
 #include "kml.h"
 
+#include <algorithm>
 #include <cstring>
 #include <cstdio>
 #include <exception>
@@ -46,12 +47,15 @@ constexpr int PARSER_BUF_SIZE = 8192;
 KML::KML()
     : poTrunk_(nullptr), nNumLayers_(-1), papoLayers_(nullptr), nDepth_(0),
       validity(KML_VALIDITY_UNKNOWN), pKMLFile_(nullptr), poCurrent_(nullptr),
-      oCurrentParser(nullptr), nDataHandlerCounter(0), nWithoutEventCounter(0)
+      oCurrentParser(nullptr), nDataHandlerCounter(0), nWithoutEventCounter(0),
+      bStreaming_(false), nStreamEnd_(0), nStreamPos_(0),
+      bStreamFinished_(true), bInFeatureStream_(false)
 {
 }
 
 KML::~KML()
 {
+    endFeatureStream();
     if (nullptr != pKMLFile_)
         VSIFCloseL(pKMLFile_);
     CPLFree(papoLayers_);
@@ -64,6 +68,7 @@ bool KML::open(const char *pszFilename)
     if (nullptr != pKMLFile_)
         VSIFCloseL(pKMLFile_);
 
+    sFilename_ = pszFilename;
     pKMLFile_ = VSIFOpenL(pszFilename, "r");
     return pKMLFile_ != nullptr;
 }
@@ -92,6 +97,7 @@ bool KML::parse()
     XML_SetUserData(oParser, this);
     XML_SetElementHandler(oParser, startElement, endElement);
     XML_SetCharacterDataHandler(oParser, dataHandler);
+    XML_SetXmlDeclHandler(oParser, xmlDeclHandler);
     oCurrentParser = oParser;
     nWithoutEventCounter = 0;
 
@@ -259,6 +265,13 @@ void XMLCALL KML::startElement(void *pUserData, const char *pszName,
             KMLNode *poMynew = new KMLNode();
             poMynew->setName(pszName);
             poMynew->setLevel(poKML->nDepth_);
+            if (poKML->bStreaming_ && poKML->isContainer(pszName))
+            {
+                poMynew->setByteRange(
+                    static_cast<GIntBig>(
+                        XML_GetCurrentByteIndex(poKML->oCurrentParser)),
+                    -1);
+            }
 
             for (int i = 0; ppszAttr[i]; i += 2)
             {
@@ -399,6 +412,16 @@ void XMLCALL KML::endElement(void *pUserData, const char *pszName)
         {
             poKML->nDepth_--;
             KMLNode *poTmp = poKML->poCurrent_;
+            if (poKML->bStreaming_ && poKML->isContainer(pszName) &&
+                XML_GetCurrentByteCount(poKML->oCurrentParser) > 0)
+            {
+                // Range from the start tag to the end of the end tag
+                poTmp->setByteRange(
+                    poTmp->getByteRangeStart(),
+                    static_cast<GIntBig>(
+                        XML_GetCurrentByteIndex(poKML->oCurrentParser)) +
+                        XML_GetCurrentByteCount(poKML->oCurrentParser));
+            }
             // Split the coordinates
             if (poKML->poCurrent_->getName().compare("coordinates") == 0 &&
                 poKML->poCurrent_->numContent() == 1)
@@ -504,10 +527,17 @@ void XMLCALL KML::endElement(void *pUserData, const char *pszName)
                 if (poKML->poTrunk_ == poTmp)
                     poKML->poTrunk_ = nullptr;
             }
-            else
+            else if (poKML->poCurrent_ != nullptr)
             {
-                if (poKML->poCurrent_ != nullptr)
+                if ((poKML->bStreaming_ || poKML->bInFeatureStream_) &&
+                    poTmp->getName() == "Placemark")
+                {
+                    poKML->handleParsedFeature(poTmp);
+                }
+                else
+                {
                     poKML->poCurrent_->addChildren(poTmp);
+                }
             }
         }
         else if (poKML->poCurrent_ != nullptr)
@@ -563,6 +593,182 @@ void XMLCALL KML::dataHandler(void *pUserData, const char *pszData, int nLen)
     }
 }
 
+void XMLCALL KML::xmlDeclHandler(void *pUserData,
+                                 const char * /* pszVersion */,
+                                 const char *pszEncoding,
+                                 int /* nStandalone */)
+{
+    KML *poKML = static_cast<KML *>(pUserData);
+    if (pszEncoding)
+        poKML->sEncoding_ = pszEncoding;
+}
+
+void KML::handleParsedFeature(KMLNode *poFeature)
+{
+    if (!poFeature->classify(this))
+    {
+        delete poFeature;
+        XML_StopParser(oCurrentParser, XML_FALSE);
+        return;
+    }
+
+    if (bInFeatureStream_)
+    {
+        // Features of nested containers belong to other layers
+        if (poCurrent_ == poTrunk_)
+            apoStreamedFeatures_.push_back(poFeature);
+        else
+            delete poFeature;
+    }
+    else
+    {
+        poCurrent_->addStreamedFeature(poFeature);
+    }
+}
+
+bool KML::getCurrentByteRange(GIntBig &nStart, GIntBig &nEnd) const
+{
+    if (poCurrent_ == nullptr)
+        return false;
+    nStart = poCurrent_->getByteRangeStart();
+    nEnd = poCurrent_->getByteRangeEnd();
+    return nStart >= 0 && nEnd > nStart;
+}
+
+bool KML::beginFeatureStream(GIntBig nStart, GIntBig nEnd,
+                             const std::string &sEncoding)
+{
+    endFeatureStream();
+
+    if (nullptr == pKMLFile_ || nStart < 0 || nEnd <= nStart ||
+        VSIFSeekL(pKMLFile_, static_cast<vsi_l_offset>(nStart), SEEK_SET) != 0)
+    {
+        return false;
+    }
+
+    XML_Parser oParser = OGRCreateExpatXMLParser();
+    XML_SetUserData(oParser, this);
+    XML_SetElementHandler(oParser, startElement, endElement);
+    XML_SetCharacterDataHandler(oParser, dataHandler);
+    oCurrentParser = oParser;
+    nWithoutEventCounter = 0;
+    nDepth_ = 0;
+    nStreamPos_ = nStart;
+    nStreamEnd_ = nEnd;
+    bStreamFinished_ = false;
+    bInFeatureStream_ = true;
+
+    // The byte range does not include the XML declaration of the document
+    if (!sEncoding.empty())
+    {
+        const std::string osDecl("<?xml version=\"1.0\" encoding=\"" +
+                                 sEncoding + "\"?>");
+        if (XML_Parse(oParser, osDecl.c_str(), static_cast<int>(osDecl.size()),
+                      false) == XML_STATUS_ERROR)
+        {
+            endFeatureStream();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void KML::endFeatureStream()
+{
+    if (!bInFeatureStream_)
+        return;
+
+    XML_ParserFree(oCurrentParser);
+    oCurrentParser = nullptr;
+    bInFeatureStream_ = false;
+    bStreamFinished_ = true;
+
+    for (KMLNode *poNode : apoStreamedFeatures_)
+        delete poNode;
+    apoStreamedFeatures_.clear();
+
+    // Nodes are only attached to their parent once closed
+    if (poCurrent_ != nullptr)
+    {
+        while (poCurrent_)
+        {
+            KMLNode *poTemp = poCurrent_->getParent();
+            delete poCurrent_;
+            poCurrent_ = poTemp;
+        }
+    }
+    else
+    {
+        delete poTrunk_;
+    }
+    poTrunk_ = nullptr;
+}
+
+bool KML::feedFeatureStream()
+{
+    if (!bInFeatureStream_ || bStreamFinished_)
+        return false;
+
+    if (nWithoutEventCounter == 10)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Too much data inside one element. File probably corrupted");
+        bStreamFinished_ = true;
+        return false;
+    }
+
+    std::vector<char> aBuf(PARSER_BUF_SIZE);
+    const size_t nToRead = static_cast<size_t>(std::min<GIntBig>(
+        PARSER_BUF_SIZE, nStreamEnd_ - nStreamPos_));
+    nDataHandlerCounter = 0;
+    const size_t nLen = VSIFReadL(aBuf.data(), 1, nToRead, pKMLFile_);
+    nStreamPos_ += nLen;
+    const bool bDone = nLen < nToRead || nStreamPos_ >= nStreamEnd_;
+    if (XML_Parse(oCurrentParser, aBuf.data(), static_cast<int>(nLen),
+                  bDone) == XML_STATUS_ERROR)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "XML parsing of KML file failed : %s at line %d, "
+                 "column %d",
+                 XML_ErrorString(XML_GetErrorCode(oCurrentParser)),
+                 static_cast<int>(XML_GetCurrentLineNumber(oCurrentParser)),
+                 static_cast<int>(XML_GetCurrentColumnNumber(oCurrentParser)));
+        bStreamFinished_ = true;
+        return false;
+    }
+    nWithoutEventCounter++;
+    if (bDone)
+        bStreamFinished_ = true;
+    return true;
+}
+
+Feature *KML::getNextStreamedFeature()
+{
+    while (true)
+    {
+        while (apoStreamedFeatures_.empty())
+        {
+            if (!feedFeatureStream())
+                return nullptr;
+        }
+
+        KMLNode *poNode = apoStreamedFeatures_.front();
+        apoStreamedFeatures_.pop_front();
+
+        // Skip features that eliminateEmpty() removes in non-streaming mode
+        if (poNode->getType() == Empty)
+        {
+            delete poNode;
+            continue;
+        }
+
+        Feature *poFeature = poNode->buildFeature();
+        delete poNode;
+        return poFeature;
+    }
+}
+
 bool KML::isValid()
 {
     checkValidity();
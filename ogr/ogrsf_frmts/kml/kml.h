@@ -36,6 +36,7 @@
 #include "cpl_vsi.h"
 
 // std
+#include <deque>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -84,8 +85,36 @@ class KML
 
     void unregisterLayerIfMatchingThisNode(KMLNode *poNode);
 
+    // Streaming mode: parse() only keeps the structure of the document,
+    // and the features of a layer are then parsed on demand from the byte
+    // range of its container, with beginFeatureStream() and
+    // getNextStreamedFeature().
+    void setStreaming(bool bStreaming)
+    {
+        bStreaming_ = bStreaming;
+    }
+    bool isStreaming() const
+    {
+        return bStreaming_;
+    }
+    const std::string &getFilename() const
+    {
+        return sFilename_;
+    }
+    const std::string &getEncoding() const
+    {
+        return sEncoding_;
+    }
+    bool getCurrentByteRange(GIntBig &nStart, GIntBig &nEnd) const;
+    bool beginFeatureStream(GIntBig nStart, GIntBig nEnd,
+                            const std::string &sEncoding);
+    Feature *getNextStreamedFeature();
+
   protected:
     void checkValidity();
+    void endFeatureStream();
+    bool feedFeatureStream();
+    void handleParsedFeature(KMLNode *poFeature);
 
     static void XMLCALL startElement(void *, const char *, const char **);
     static void XMLCALL startElementValidate(void *, const char *,
@@ -93,6 +122,8 @@ class KML
     static void XMLCALL dataHandler(void *, const char *, int);
     static void XMLCALL dataHandlerValidate(void *, const char *, int);
     static void XMLCALL endElement(void *, const char *);
+    static void XMLCALL xmlDeclHandler(void *, const char *, const char *,
+                                       int);
 
     // Trunk of KMLnodes.
     KMLNode *poTrunk_;
@@ -117,6 +148,20 @@ class KML
     XML_Parser oCurrentParser;
     int nDataHandlerCounter;
     int nWithoutEventCounter;
+
+    // Name of the file.
+    std::string sFilename_;
+    // Encoding from the XML declaration.
+    std::string sEncoding_;
+    // Whether parse() should only keep the structure of the document.
+    bool bStreaming_;
+    // Byte range of the container being streamed by getNextStreamedFeature().
+    GIntBig nStreamEnd_;
+    GIntBig nStreamPos_;
+    bool bStreamFinished_;
+    bool bInFeatureStream_;
+    // Parsed features of the streamed container not yet returned.
+    std::deque<KMLNode *> apoStreamedFeatures_;
 };
 
 #endif  // HAVE_EXPAT
@@ -120,7 +120,8 @@ KMLNode::KMLNode()
       pvsContent_(new std::vector<std::string>),
       pvoAttributes_(new std::vector<Attribute *>), poParent_(nullptr),
       nLevel_(0), eType_(Unknown), b25D_(false), nLayerNumber_(-1),
-      nNumFeatures_(-1)
+      nNumFeatures_(-1), bStreamed_(false), nStreamedFeatures_(0),
+      nStreamedEmptyFeatures_(0), nByteRangeStart_(-1), nByteRangeEnd_(-1)
 {
 }
 
@@ -315,6 +316,9 @@ void KMLNode::unregisterLayerIfMatchingThisNode(KML *poKML)
 
 void KMLNode::eliminateEmpty(KML *poKML)
 {
+    nStreamedFeatures_ -= nStreamedEmptyFeatures_;
+    nStreamedEmptyFeatures_ = 0;
+
     for (kml_nodes_t::size_type z = 0; z < pvpoChildren_->size();)
     {
         if ((*pvpoChildren_)[z]->eType_ == Empty &&
@@ -488,6 +492,9 @@ std::string KMLNode::getDescriptionElement() const
 
 std::size_t KMLNode::getNumFeatures()
 {
+    if (bStreamed_)
+        return nStreamedFeatures_;
+
     if (nNumFeatures_ < 0)
     {
         std::size_t nNum = 0;
@@ -503,6 +510,45 @@ std::size_t KMLNode::getNumFeatures()
     return nNumFeatures_;
 }
 
+void KMLNode::addStreamedFeature(KMLNode *poFeature)
+{
+    // poFeature must have been classified. Empty features are those that
+    // eliminateEmpty() removes.
+    bStreamed_ = true;
+    nStreamedFeatures_++;
+    if (poFeature->eType_ == Empty)
+        nStreamedEmptyFeatures_++;
+
+    // One stub per distinct classification is enough for classify(),
+    // eliminateEmpty() and findLayers() to work as on the full tree.
+    for (KMLNode *poChild : *pvpoChildren_)
+    {
+        if (poChild->sName_ == poFeature->sName_ &&
+            poChild->eType_ == poFeature->eType_ &&
+            poChild->b25D_ == poFeature->b25D_)
+        {
+            delete poFeature;
+            return;
+        }
+    }
+
+    for (KMLNode *poChild : *poFeature->pvpoChildren_)
+        delete poChild;
+    poFeature->pvpoChildren_->clear();
+    for (Attribute *poAttr : *poFeature->pvoAttributes_)
+        delete poAttr;
+    poFeature->pvoAttributes_->clear();
+    poFeature->pvsContent_->clear();
+    poFeature->setParent(this);
+    pvpoChildren_->push_back(poFeature);
+}
+
+void KMLNode::setByteRange(GIntBig nStart, GIntBig nEnd)
+{
+    nByteRangeStart_ = nStart;
+    nByteRangeEnd_ = nEnd;
+}
+
 OGRGeometry *KMLNode::getGeometry(Nodetype eType)
 {
     OGRGeometry *poGeom = nullptr;
@@ -715,7 +761,6 @@ Feature *KMLNode::getFeature(std::size_t nNum, int &nLastAsked, int &nLastCount)
     unsigned int nCount = 0;
     unsigned int nCountP = 0;
     KMLNode *poFeat = nullptr;
-    KMLNode *poTemp = nullptr;
 
     if (nLastAsked + 1 != static_cast<int>(nNum))
     {
@@ -747,22 +792,25 @@ Feature *KMLNode::getFeature(std::size_t nNum, int &nLastAsked, int &nLastCount)
     if (poFeat == nullptr)
         return nullptr;
 
+    return poFeat->buildFeature();
+}
+
+Feature *KMLNode::buildFeature()
+{
     // Create a feature structure
     Feature *psReturn = new Feature;
     // Build up the name
-    psReturn->sName = poFeat->getNameElement();
+    psReturn->sName = getNameElement();
     // Build up the description
-    psReturn->sDescription = poFeat->getDescriptionElement();
+    psReturn->sDescription = getDescriptionElement();
     // the type
-    psReturn->eType = poFeat->eType_;
+    psReturn->eType = eType_;
 
     std::string sElementName;
-    if (poFeat->eType_ == Point || poFeat->eType_ == LineString ||
-        poFeat->eType_ == Polygon)
-        sElementName = Nodetype2String(poFeat->eType_);
-    else if (poFeat->eType_ == MultiGeometry || poFeat->eType_ == MultiPoint ||
-             poFeat->eType_ == MultiLineString ||
-             poFeat->eType_ == MultiPolygon)
+    if (eType_ == Point || eType_ == LineString || eType_ == Polygon)
+        sElementName = Nodetype2String(eType_);
+    else if (eType_ == MultiGeometry || eType_ == MultiPoint ||
+             eType_ == MultiLineString || eType_ == MultiPolygon)
         sElementName = "MultiGeometry";
     else
     {
@@ -770,16 +818,16 @@ Feature *KMLNode::getFeature(std::size_t nNum, int &nLastAsked, int &nLastCount)
         return nullptr;
     }
 
-    for (nCount = 0; nCount < poFeat->pvpoChildren_->size(); nCount++)
+    for (std::size_t nCount = 0; nCount < pvpoChildren_->size(); nCount++)
     {
-        const auto &sName = (*poFeat->pvpoChildren_)[nCount]->sName_;
+        const auto &sName = (*pvpoChildren_)[nCount]->sName_;
         if (sName.compare(sElementName) == 0 ||
             (sElementName == "MultiGeometry" &&
              (sName == "MultiPolygon" || sName == "MultiLineString" ||
               sName == "MultiPoint")))
         {
-            poTemp = (*poFeat->pvpoChildren_)[nCount];
-            psReturn->poGeom = poTemp->getGeometry(poFeat->eType_);
+            KMLNode *poTemp = (*pvpoChildren_)[nCount];
+            psReturn->poGeom = poTemp->getGeometry(eType_);
             if (psReturn->poGeom)
                 return psReturn;
             else
@@ -86,6 +86,20 @@ class KMLNode
 
     std::size_t getNumFeatures();
     Feature *getFeature(std::size_t nNum, int &nLastAsked, int &nLastCount);
+    Feature *buildFeature();
+
+    // Streaming mode: Placemark nodes are only kept as stubs holding their
+    // classification, and containers record their byte range in the file.
+    void addStreamedFeature(KMLNode *poFeature);
+    void setByteRange(GIntBig nStart, GIntBig nEnd);
+    GIntBig getByteRangeStart() const
+    {
+        return nByteRangeStart_;
+    }
+    GIntBig getByteRangeEnd() const
+    {
+        return nByteRangeEnd_;
+    }
 
     OGRGeometry *getGeometry(Nodetype eType = Unknown);
 
@@ -114,6 +128,12 @@ class KMLNode
     int nLayerNumber_;
     int nNumFeatures_;
 
+    bool bStreamed_;
+    int nStreamedFeatures_;
+    int nStreamedEmptyFeatures_;
+    GIntBig nByteRangeStart_;
+    GIntBig nByteRangeEnd_;
+
     void unregisterLayerIfMatchingThisNode(KML *poKML);
 };
 
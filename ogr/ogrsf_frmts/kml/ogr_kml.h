@@ -39,6 +39,8 @@
 #include "kmlvector.h"
 #endif
 
+#include <memory>
+
 class OGRKMLDataSource;
 
 /************************************************************************/
@@ -95,6 +97,11 @@ class OGRKMLLayer final : public OGRLayer
 
     int nLastAsked;
     int nLastCount;
+
+#ifdef HAVE_EXPAT
+    // Parser of the features of the layer, in streaming mode.
+    std::unique_ptr<KML> poFeatureReader_;
+#endif
 };
 
 /************************************************************************/
@@ -47,6 +47,9 @@
 #include "kmlvector.h"
 #include "ogrsf_frmts.h"
 
+// Size above which files are read in streaming mode
+constexpr int KML_STREAMING_DEFAULT_THRESHOLD_MB = 100;
+
 /************************************************************************/
 /*                         OGRKMLDataSource()                           */
 /************************************************************************/
@@ -120,16 +123,50 @@ OGRKMLDataSource::~OGRKMLDataSource()
 /************************************************************************/
 
 #ifdef HAVE_EXPAT
+
+/************************************************************************/
+/*                        GetKMZMainDocument()                          */
+/************************************************************************/
+
+// Return the path to the doc.kml file of a KMZ archive, or to its first
+// .kml file at the root level.
+static std::string GetKMZMainDocument(const char *pszFilename)
+{
+    const std::string osZipPath =
+        std::string("/vsizip/{").append(pszFilename).append("}");
+    const CPLStringList aosFiles(VSIReadDir(osZipPath.c_str()));
+    std::string osFirstKML;
+    for (const char *pszFile : aosFiles)
+    {
+        if (EQUAL(pszFile, "doc.kml"))
+            return osZipPath + "/" + pszFile;
+        if (osFirstKML.empty() && EQUAL(CPLGetExtension(pszFile), "kml"))
+            osFirstKML = osZipPath + "/" + pszFile;
+    }
+    return osFirstKML;
+}
+
 int OGRKMLDataSource::Open(const char *pszNewName, int bTestOpen)
 {
     CPLAssert(nullptr != pszNewName);
 
+    /* -------------------------------------------------------------------- */
+    /*      KMZ files are read directly from the archive.                   */
+    /* -------------------------------------------------------------------- */
+    std::string osKMLFilename(pszNewName);
+    if (EQUAL(CPLGetExtension(pszNewName), "kmz"))
+    {
+        osKMLFilename = GetKMZMainDocument(pszNewName);
+        if (osKMLFilename.empty())
+            return FALSE;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Create a KML object and open the source file.                   */
     /* -------------------------------------------------------------------- */
     poKMLFile_ = new KMLVector();
 
-    if (!poKMLFile_->open(pszNewName))
+    if (!poKMLFile_->open(osKMLFilename.c_str()))
     {
         delete poKMLFile_;
         poKMLFile_ = nullptr;
@@ -148,10 +185,40 @@ int OGRKMLDataSource::Open(const char *pszNewName, int bTestOpen)
         return FALSE;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      In streaming mode, only the structure of the file is kept in    */
+    /*      memory, and features are parsed again when layers are read.     */
+    /* -------------------------------------------------------------------- */
+    const char *pszStreaming =
+        CPLGetConfigOption("OGR_KML_STREAMING", nullptr);
+    if (pszStreaming)
+    {
+        poKMLFile_->setStreaming(CPLTestBool(pszStreaming));
+    }
+    else
+    {
+        VSIStatBufL sStat;
+        poKMLFile_->setStreaming(
+            VSIStatL(osKMLFilename.c_str(), &sStat) == 0 &&
+            static_cast<GIntBig>(sStat.st_size) >
+                static_cast<GIntBig>(KML_STREAMING_DEFAULT_THRESHOLD_MB) *
+                    1024 * 1024);
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Prescan the KML file so we can later work with the structure    */
     /* -------------------------------------------------------------------- */
-    if (!poKMLFile_->parse())
+    bool bParseOK = poKMLFile_->parse();
+    if (bParseOK && poKMLFile_->isStreaming() &&
+        STARTS_WITH_CI(poKMLFile_->getEncoding().c_str(), "UTF-16"))
+    {
+        // Byte ranges of containers cannot be parsed independently
+        CPLDebug("KML", "Streaming not supported for %s encoding",
+                 poKMLFile_->getEncoding().c_str());
+        poKMLFile_->setStreaming(false);
+        bParseOK = poKMLFile_->parse();
+    }
+    if (!bParseOK)
     {
         delete poKMLFile_;
         poKMLFile_ = nullptr;
@@ -48,6 +48,14 @@ static int OGRKMLDriverIdentify(GDALOpenInfo *poOpenInfo)
     if (poOpenInfo->fpL == nullptr)
         return FALSE;
 
+    // KMZ archive, whose main document is read through /vsizip/
+    if (EQUAL(CPLGetExtension(poOpenInfo->pszFilename), "kmz") &&
+        poOpenInfo->nHeaderBytes >= 4 &&
+        memcmp(poOpenInfo->pabyHeader, "PK\x03\x04", 4) == 0)
+    {
+        return TRUE;
+    }
+
     return strstr(reinterpret_cast<char *>(poOpenInfo->pabyHeader), "<kml") !=
                nullptr ||
            strstr(reinterpret_cast<char *>(poOpenInfo->pabyHeader),
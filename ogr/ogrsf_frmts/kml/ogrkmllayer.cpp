@@ -148,6 +148,9 @@ void OGRKMLLayer::ResetReading()
     iNextKMLId_ = 0;
     nLastAsked = -1;
     nLastCount = -1;
+#ifdef HAVE_EXPAT
+    poFeatureReader_.reset();
+#endif
 }
 
 /************************************************************************/
@@ -168,10 +171,35 @@ OGRFeature *OGRKMLLayer::GetNextFeature()
 
     poKMLFile->selectLayer(nLayerNumber_);
 
+    if (poKMLFile->isStreaming() && !poFeatureReader_)
+    {
+        // Parse the features from the byte range of the container of the
+        // layer. On failure, the reader is left without a stream, and
+        // returns no feature.
+        poFeatureReader_.reset(new KMLVector());
+        GIntBig nStart = 0;
+        GIntBig nEnd = 0;
+        if (poKMLFile->getCurrentByteRange(nStart, nEnd) &&
+            poFeatureReader_->open(poKMLFile->getFilename().c_str()))
+        {
+            poFeatureReader_->beginFeatureStream(nStart, nEnd,
+                                                 poKMLFile->getEncoding());
+        }
+    }
+
     while (true)
     {
-        Feature *poFeatureKML =
-            poKMLFile->getFeature(iNextKMLId_++, nLastAsked, nLastCount);
+        Feature *poFeatureKML = nullptr;
+        if (poFeatureReader_)
+        {
+            poFeatureKML = poFeatureReader_->getNextStreamedFeature();
+            iNextKMLId_++;
+        }
+        else
+        {
+            poFeatureKML =
+                poKMLFile->getFeature(iNextKMLId_++, nLastAsked, nLastCount);
+        }
 
         if (poFeatureKML == nullptr)
             return nullptr;
@@ -34,6 +34,8 @@
 #include "ogrsf_frmts.h"
 
 #include <map>
+#include <memory>
+#include <vector>
 
 /************************************************************************/
 /*                             OGRMemLayer                              */
@@ -41,6 +43,7 @@
 class OGRMemDataSource;
 
 class IOGRMemLayerFeatureIterator;
+class CPLPackedRTree;
 
 class CPL_DLL OGRMemLayer CPL_NON_FINAL : public OGRLayer
 {
@@ -72,12 +75,31 @@ class CPL_DLL OGRMemLayer CPL_NON_FINAL : public OGRLayer
 
     GDALDataset *m_poDS{};
 
+    // Spatial index of the envelopes of the geometries of the field
+    // m_iSpatialIndexGeomField, lazily built on the first read with a
+    // spatial filter, and discarded on edits. Features are indices in
+    // m_anSpatialIndexFIDs.
+    std::unique_ptr<CPLPackedRTree> m_poSpatialIndex{};
+    std::vector<GIntBig> m_anSpatialIndexFIDs{};
+    int m_iSpatialIndexGeomField = -1;
+
+    // FIDs, in increasing order, of the features whose envelope intersects
+    // the current spatial filter, when reading through the spatial index.
+    std::vector<GIntBig> m_anCandidateFIDs{};
+    size_t m_iNextCandidate = 0;
+    bool m_bCandidatesComputed = false;
+
+    bool UseSpatialIndex();
+    void InvalidateSpatialIndex();
+
     // Only use it in the lifetime of a function where the list of features
     // doesn't change.
     IOGRMemLayerFeatureIterator *GetIterator();
 
     OGRFeature *GetFeatureRef(GIntBig nFeatureId);
 
+    const OGRFeature *GetNextFeatureRef();
+
   public:
     // Clone poSRS if not nullptr
     OGRMemLayer(const char *pszName, const OGRSpatialReference *poSRS,
@@ -86,6 +108,8 @@ class CPL_DLL OGRMemLayer CPL_NON_FINAL : public OGRLayer
 
     void ResetReading() override;
     OGRFeature *GetNextFeature() override;
+    int GetNextFeatureBatch(OGRFeatureBatch &oBatch,
+                            int nMaxFeatures) override;
     virtual OGRErr SetNextByIndex(GIntBig nIndex) override;
 
     OGRFeature *GetFeature(GIntBig nFeatureId) override;
@@ -31,14 +31,18 @@
 #include "ogr_mem.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <algorithm>
 #include <map>
 #include <new>
+#include <typeinfo>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_packed_rtree.h"
 #include "cpl_vsi.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
@@ -123,6 +127,115 @@ void OGRMemLayer::ResetReading()
 {
     m_iNextReadFID = 0;
     m_oMapFeaturesIter = m_oMapFeatures.begin();
+    m_bCandidatesComputed = false;
+    m_anCandidateFIDs.clear();
+    m_iNextCandidate = 0;
+}
+
+/************************************************************************/
+/*                       InvalidateSpatialIndex()                       */
+/************************************************************************/
+
+void OGRMemLayer::InvalidateSpatialIndex()
+
+{
+    m_poSpatialIndex.reset();
+    m_anSpatialIndexFIDs.clear();
+    m_iSpatialIndexGeomField = -1;
+}
+
+/************************************************************************/
+/*                          UseSpatialIndex()                           */
+/************************************************************************/
+
+// Returns whether the current read should only visit the features of
+// m_anCandidateFIDs. On the first call after ResetReading(), builds the
+// spatial index if needed, and computes the candidates from the envelope
+// of the spatial filter.
+bool OGRMemLayer::UseSpatialIndex()
+
+{
+    if (m_bCandidatesComputed)
+        return true;
+    if (m_poFilterGeom == nullptr)
+        return false;
+
+    // Below that number, scanning all features is cheap enough.
+    constexpr GIntBig MIN_FEATURES_FOR_SPATIAL_INDEX = 100;
+
+    if (m_poSpatialIndex == nullptr ||
+        m_iSpatialIndexGeomField != m_iGeomFieldFilter)
+    {
+        InvalidateSpatialIndex();
+        if (m_nFeatureCount < MIN_FEATURES_FOR_SPATIAL_INDEX ||
+            !CPLTestBool(CPLGetConfigOption("OGR_MEM_SPATIAL_INDEX", "YES")))
+        {
+            return false;
+        }
+
+        try
+        {
+            auto poSpatialIndex = std::make_unique<CPLPackedRTree>();
+            std::vector<GIntBig> anFIDs;
+            poSpatialIndex->Reserve(static_cast<size_t>(m_nFeatureCount));
+            anFIDs.reserve(static_cast<size_t>(m_nFeatureCount));
+
+            auto poIter =
+                std::unique_ptr<IOGRMemLayerFeatureIterator>(GetIterator());
+            while (const OGRFeature *poFeature = poIter->Next())
+            {
+                const OGRGeometry *poGeom =
+                    poFeature->GetGeomFieldRef(m_iGeomFieldFilter);
+                // Such features never pass a spatial filter.
+                if (poGeom == nullptr || poGeom->IsEmpty())
+                    continue;
+                OGREnvelope sEnvelope;
+                poGeom->getEnvelope(&sEnvelope);
+                CPLRectObj sRect;
+                sRect.minx = sEnvelope.MinX;
+                sRect.miny = sEnvelope.MinY;
+                sRect.maxx = sEnvelope.MaxX;
+                sRect.maxy = sEnvelope.MaxY;
+                poSpatialIndex->Insert(
+                    reinterpret_cast<void *>(
+                        static_cast<uintptr_t>(anFIDs.size())),
+                    sRect);
+                anFIDs.push_back(poFeature->GetFID());
+            }
+            poSpatialIndex->Build();
+
+            m_poSpatialIndex = std::move(poSpatialIndex);
+            m_anSpatialIndexFIDs = std::move(anFIDs);
+            m_iSpatialIndexGeomField = m_iGeomFieldFilter;
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLDebug("Mem", "Cannot allocate spatial index of layer %s",
+                     GetDescription());
+            return false;
+        }
+    }
+
+    CPLRectObj sAoi;
+    sAoi.minx = m_sFilterEnvelope.MinX;
+    sAoi.miny = m_sFilterEnvelope.MinY;
+    sAoi.maxx = m_sFilterEnvelope.MaxX;
+    sAoi.maxy = m_sFilterEnvelope.MaxY;
+    std::vector<void *> ahFeatures;
+    m_poSpatialIndex->Search(sAoi, ahFeatures);
+    // Features must be returned by increasing FID, as without index.
+    std::vector<size_t> anIndices;
+    anIndices.reserve(ahFeatures.size());
+    for (void *hFeature : ahFeatures)
+        anIndices.push_back(reinterpret_cast<uintptr_t>(hFeature));
+    std::sort(anIndices.begin(), anIndices.end());
+    m_anCandidateFIDs.clear();
+    m_anCandidateFIDs.reserve(anIndices.size());
+    for (size_t nIdx : anIndices)
+        m_anCandidateFIDs.push_back(m_anSpatialIndexFIDs[nIdx]);
+    m_iNextCandidate = 0;
+    m_bCandidatesComputed = true;
+    return true;
 }
 
 /************************************************************************/
@@ -132,10 +245,33 @@ void OGRMemLayer::ResetReading()
 OGRFeature *OGRMemLayer::GetNextFeature()
 
 {
+    const OGRFeature *poFeature = GetNextFeatureRef();
+    return poFeature ? poFeature->Clone() : nullptr;
+}
+
+/************************************************************************/
+/*                         GetNextFeatureRef()                          */
+/************************************************************************/
+
+// Returns the next feature matching the filters, still owned by the layer.
+const OGRFeature *OGRMemLayer::GetNextFeatureRef()
+
+{
+    const bool bUseSpatialIndex = UseSpatialIndex();
     while (true)
     {
         OGRFeature *poFeature = nullptr;
-        if (m_papoFeatures)
+        if (bUseSpatialIndex)
+        {
+            if (m_iNextCandidate >= m_anCandidateFIDs.size())
+                return nullptr;
+            // The feature may have been deleted since the candidates were
+            // computed.
+            poFeature = GetFeatureRef(m_anCandidateFIDs[m_iNextCandidate++]);
+            if (poFeature == nullptr)
+                continue;
+        }
+        else if (m_papoFeatures)
         {
             if (m_iNextReadFID >= m_nMaxFeatureCount)
                 return nullptr;
@@ -158,13 +294,51 @@ OGRFeature *OGRMemLayer::GetNextFeature()
             (m_poAttrQuery == nullptr || m_poAttrQuery->Evaluate(poFeature)))
         {
             m_nFeaturesRead++;
-            return poFeature->Clone();
+            return poFeature;
         }
     }
 
     return nullptr;
 }
 
+/************************************************************************/
+/*                        GetNextFeatureBatch()                         */
+/************************************************************************/
+
+int OGRMemLayer::GetNextFeatureBatch(OGRFeatureBatch &oBatch,
+                                     int nMaxFeatures)
+
+{
+    // Derived classes, such as the GeoJSON or XLSX ones, may override
+    // GetNextFeature() to post-process features.
+    if (typeid(*this) != typeid(OGRMemLayer))
+        return OGRLayer::GetNextFeatureBatch(oBatch, nMaxFeatures);
+
+    oBatch.Clear();
+
+    std::vector<int> anIdentityMap(m_poFeatureDefn->GetFieldCount());
+    for (int i = 0; i < static_cast<int>(anIdentityMap.size()); ++i)
+        anIdentityMap[i] = i;
+
+    while (oBatch.GetFeatureCount() < nMaxFeatures)
+    {
+        const OGRFeature *poSrcFeature = GetNextFeatureRef();
+        if (poSrcFeature == nullptr)
+            break;
+        // Overwrite a feature of the previous batch in place, which reuses
+        // its field array, large enough string buffers and simple geometries.
+        OGRFeature *poFeature = oBatch.AppendRecycledFeature(m_poFeatureDefn);
+        if (poFeature->SetFrom(poSrcFeature, anIdentityMap.data(), TRUE) !=
+            OGRERR_NONE)
+        {
+            oBatch.RemoveLastFeature();
+            break;
+        }
+        poFeature->SetFID(poSrcFeature->GetFID());
+    }
+    return oBatch.GetFeatureCount();
+}
+
 /************************************************************************/
 /*                           SetNextByIndex()                           */
 /************************************************************************/
@@ -401,6 +575,7 @@ OGRErr OGRMemLayer::ISetFeature(OGRFeature *poFeature)
     }
 
     m_bUpdated = true;
+    InvalidateSpatialIndex();
 
     return OGRERR_NONE;
 }
@@ -493,6 +668,8 @@ OGRErr OGRMemLayer::IUpdateFeature(OGRFeature *poFeature,
             panUpdatedGeomFieldsIdx[i],
             poFeature->StealGeometry(panUpdatedGeomFieldsIdx[i]));
     }
+    if (nUpdatedGeomFieldsCount > 0)
+        InvalidateSpatialIndex();
     if (bUpdateStyleString)
     {
         poFeatureRef->SetStyleString(poFeature->GetStyleString());
@@ -538,6 +715,7 @@ OGRErr OGRMemLayer::DeleteFeature(GIntBig nFID)
     --m_nFeatureCount;
 
     m_bUpdated = true;
+    InvalidateSpatialIndex();
 
     return OGRERR_NONE;
 }
@@ -972,6 +1150,7 @@ OGRErr OGRMemLayer::CreateGeomField(const OGRGeomFieldDefn *poGeomField,
     }
 
     m_bUpdated = true;
+    InvalidateSpatialIndex();
 
     return OGRERR_NONE;
 }
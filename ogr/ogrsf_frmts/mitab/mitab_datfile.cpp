@@ -48,6 +48,7 @@
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "mitab_priv.h"
+#include "mitab_utils.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
 #include "ogr_p.h"
@@ -166,7 +167,7 @@ int TABDATFile::Open(const char *pszFname, TABAccess eAccess,
 
     // Open file for reading.
     m_pszFname = CPLStrdup(pszFname);
-    m_fp = VSIFOpenL(m_pszFname, pszAccess);
+    m_fp = TABVSIFOpenL(m_pszFname, pszAccess);
     m_eTableType = eTableType;
 
     if (m_fp == nullptr)
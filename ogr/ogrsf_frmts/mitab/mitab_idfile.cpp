@@ -149,7 +149,7 @@ int TABIDFile::Open(const char *pszFname, TABAccess eAccess)
 #endif
 
     // Open file.
-    m_fp = VSIFOpenL(m_pszFname, pszAccess);
+    m_fp = TABVSIFOpenL(m_pszFname, pszAccess);
 
     if (m_fp == nullptr)
     {
@@ -45,6 +45,7 @@
 #include "cpl_error.h"
 #include "cpl_vsi.h"
 #include "mitab_priv.h"
+#include "mitab_utils.h"
 #include "ogr_feature.h"
 
 /*=====================================================================
@@ -168,7 +169,7 @@ int TABMAPFile::Open(const char *pszFname, TABAccess eAccess,
     const char *pszAccess = (eAccess == TABRead)    ? "rb"
                             : (eAccess == TABWrite) ? "wb+"
                                                     : "rb+";
-    fp = VSIFOpenL(pszFname, pszAccess);
+    fp = TABVSIFOpenL(pszFname, pszAccess);
 
     m_oBlockManager.Reset();
 
@@ -93,10 +93,15 @@ int TABRawBinBlock::ReadFromFile(VSILFILE *fpSrc, int nOffset, int nSize)
         return -1;
     }
 
-    m_fp = fpSrc;
+    // In read-only mode, the file size cannot change, so avoid seeking to
+    // the end of file each time a block is loaded.
+    if (m_eAccess != TABRead || m_fp != fpSrc || m_nFileSize <= 0)
+    {
+        m_fp = fpSrc;
 
-    VSIFSeekL(fpSrc, 0, SEEK_END);
-    m_nFileSize = static_cast<int>(VSIFTellL(m_fp));
+        VSIFSeekL(fpSrc, 0, SEEK_END);
+        m_nFileSize = static_cast<int>(VSIFTellL(m_fp));
+    }
 
     m_nFileOffset = nOffset;
     m_nCurPos = 0;
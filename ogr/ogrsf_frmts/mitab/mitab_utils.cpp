@@ -42,6 +42,7 @@
 #include "cpl_error.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_vsi_virtual.h"
 
 /**********************************************************************
  *                       TABGenerateArc()
@@ -212,6 +213,33 @@ static bool TABAdjustCaseSensitiveFilename(char *pszFname)
 }
 #endif  // Not win32.
 
+/**********************************************************************
+ *                       TABVSIFOpenL()
+ *
+ * Open one of the binary files of a TAB dataset (.MAP, .ID, .DAT).
+ *
+ * When the file is opened read-only, reads are done through a cache of
+ * large chunks (MITAB_READ_CHUNK_SIZE, 256 KB by default, 0 to disable),
+ * so that the many small block reads (and seeks) done when decoding
+ * features do not all hit the file system.
+ *
+ * Returns NULL if the file could not be opened.
+ **********************************************************************/
+VSILFILE *TABVSIFOpenL(const char *pszFname, const char *pszAccess)
+{
+    VSILFILE *fp = VSIFOpenL(pszFname, pszAccess);
+    if (fp == nullptr || strcmp(pszAccess, "rb") != 0)
+        return fp;
+
+    const int nChunkSize =
+        atoi(CPLGetConfigOption("MITAB_READ_CHUNK_SIZE", "262144"));
+    if (nChunkSize <= 0)
+        return fp;
+
+    // Keep up to 16 chunks in cache
+    return VSICreateCachedFile(fp, nChunkSize, 16 * nChunkSize);
+}
+
 /**********************************************************************
  *                       TABAdjustFilenameExtension()
  *
@@ -48,6 +48,7 @@ int TABGenerateArc(OGRLineString *poLine, int numPoints, double dCenterX,
 int TABCloseRing(OGRLineString *poRing);
 
 GBool TABAdjustFilenameExtension(char *pszFname);
+VSILFILE *TABVSIFOpenL(const char *pszFname, const char *pszAccess);
 char *TABGetBasename(const char *pszFname);
 char **TAB_CSLLoad(const char *pszFname);
 
@@ -90,10 +90,32 @@ OGRFeature *OGRMVTCreateFeatureFrom(OGRFeature *poSrcFeature,
                                     bool bJsonField,
                                     OGRSpatialReference *poSRS);
 
+/** Receives the tiles and metadata generated by the MVT writer, instead of
+ * them being written in a directory or a MBTiles file.
+ */
+class OGRMVTTileSink
+{
+  public:
+    virtual ~OGRMVTTileSink() = default;
+
+    /** Called by increasing (nZ, nX, nY), where nY = 0 is the top row, with
+     * the (possibly compressed) tile data. */
+    virtual bool WriteTile(int nZ, int nX, int nY, const GByte *pabyData,
+                           size_t nDataSize) = 0;
+
+    /** Called once after all tiles, with the items that would have been
+     * written in the metadata table of a MBTiles file. */
+    virtual bool WriteMetadata(const CPLJSONObject &oMetadata) = 0;
+};
+
 // #ifdef HAVE_MVT_WRITE_SUPPORT
 GDALDataset *OGRMVTWriterDatasetCreate(const char *pszFilename, int nXSize,
                                        int nYSize, int nBandsIn,
                                        GDALDataType eDT, char **papszOptions);
+
+GDALDataset *OGRMVTWriterDatasetCreate(const char *pszFilename,
+                                       char **papszOptions,
+                                       OGRMVTTileSink *poTileSink);
 // #endif
 
 #endif  // MVTUTILS_H
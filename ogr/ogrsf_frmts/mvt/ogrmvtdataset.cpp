@@ -3286,6 +3286,7 @@ class OGRMVTWriterDataset final : public GDALDataset
     CPLString m_osDescription;
     CPLString m_osType{"overlay"};
     sqlite3 *m_hDBMBTILES = nullptr;
+    OGRMVTTileSink *m_poTileSink = nullptr;
     OGREnvelope m_oEnvelope;
     unsigned m_nMaxTileSize = 500000;
     unsigned m_nMaxFeatures = 200000;
@@ -3334,6 +3335,46 @@ class OGRMVTWriterDataset final : public GDALDataset
                                  int &nLastY) const;
 #endif
 
+    // Feature of a tile, as read from the temporary database
+    class MVTTempFeature
+    {
+      public:
+        std::string m_osBlob;
+        double m_dfAreaOrLength = 0;
+    };
+
+    // Features of a layer of a tile, in insertion order
+    class MVTTempLayer
+    {
+      public:
+        CPLString m_osName;
+        std::vector<MVTTempFeature> m_aoFeatures;
+    };
+
+    // Geometry types and tags of the features of a layer that went into a
+    // tile, applied to MVTLayerProperties in tile order once encoded.
+    class MVTTileLayerStats
+    {
+      public:
+        CPLString m_osName;
+        std::map<MVTTileLayerFeature::GeomType, GIntBig> m_oCountGeomType;
+        std::vector<std::pair<std::string, MVTTileLayerValue>> m_aoTags;
+    };
+
+    // Tile encoded by a worker thread
+    class MVTTileJob
+    {
+      public:
+        const OGRMVTWriterDataset *m_poDS = nullptr;
+        int m_nZ = 0;
+        int m_nX = 0;
+        int m_nY = 0;
+        std::vector<MVTTempLayer> m_aoLayers;
+        std::vector<MVTTileLayerStats> m_aoStats;
+        GIntBig m_nFeaturesRead = 0;
+        std::string m_osTileBuffer;
+    };
+
     static void UpdateLayerProperties(MVTLayerProperties *poLayerProperties,
                                       const std::string &osKey,
                                       const MVTTileLayerValue &oValue);
@@ -3342,18 +3383,21 @@ class OGRMVTWriterDataset final : public GDALDataset
                        std::shared_ptr<MVTTileLayer> &poTargetLayer,
                        std::map<CPLString, GUInt32> &oMapKeyToIdx,
                        std::map<MVTTileLayerValue, GUInt32> &oMapValueToIdx,
-                       MVTLayerProperties *poLayerProperties, GUInt32 nExtent,
-                       unsigned &nFeaturesInTile);
+                       MVTTileLayerStats *poStats, GUInt32 nExtent,
+                       unsigned &nFeaturesInTile) const;
+
+    static void EncodeTileTaskFunc(void *pParam);
+
+    void EncodeTile(MVTTileJob *poJob) const;
 
     std::string
-    EncodeTile(int nZ, int nX, int nY, sqlite3_stmt *hStmtLayer,
-               sqlite3_stmt *hStmtRows,
-               std::map<CPLString, MVTLayerProperties> &oMapLayerProps,
-               std::set<CPLString> &oSetLayers, GIntBig &nTempTilesRead);
+    RecodeTileLowerResolution(const std::vector<MVTTempLayer> &aoLayers,
+                              int nExtent) const;
 
-    std::string RecodeTileLowerResolution(int nZ, int nX, int nY, int nExtent,
-                                          sqlite3_stmt *hStmtLayer,
-                                          sqlite3_stmt *hStmtRows);
+    static void
+    ApplyTileStats(int nZ, const std::vector<MVTTileLayerStats> &aoStats,
+                   std::map<CPLString, MVTLayerProperties> &oMapLayerProps,
+                   std::set<CPLString> &oSetLayers);
 
     bool CreateOutput();
 
@@ -3379,6 +3423,9 @@ class OGRMVTWriterDataset final : public GDALDataset
                                int nBandsIn, GDALDataType eDT,
                                char **papszOptions);
 
+    static GDALDataset *Create(const char *pszFilename, char **papszOptions,
+                               OGRMVTTileSink *poTileSink);
+
     OGRSpatialReference *GetSRS()
     {
         return m_poSRS;
@@ -4722,8 +4769,8 @@ void OGRMVTWriterDataset::EncodeFeature(
     std::shared_ptr<MVTTileLayer> &poTargetLayer,
     std::map<CPLString, GUInt32> &oMapKeyToIdx,
     std::map<MVTTileLayerValue, GUInt32> &oMapValueToIdx,
-    MVTLayerProperties *poLayerProperties, GUInt32 nExtent,
-    unsigned &nFeaturesInTile)
+    MVTTileLayerStats *poStats, GUInt32 nExtent,
+    unsigned &nFeaturesInTile) const
 {
     size_t nUncompressedSize = 0;
     void *pCompressed =
@@ -4745,9 +4792,9 @@ void OGRMVTWriterDataset::EncodeFeature(
             if (poSrcFeature->hasId())
                 poFeature->setId(poSrcFeature->getId());
             poFeature->setType(poSrcFeature->getType());
-            if (poLayerProperties)
+            if (poStats)
             {
-                poLayerProperties->m_oCountGeomType[poSrcFeature->getType()]++;
+                poStats->m_oCountGeomType[poSrcFeature->getType()]++;
             }
             bool bOK = true;
             if (nExtent < m_nExtent)
@@ -4821,10 +4868,9 @@ void OGRMVTWriterDataset::EncodeFeature(
                         const auto &osKey = srcKeys[nSrcIdxKey];
                         const auto &oValue = srcValues[nSrcIdxValue];
 
-                        if (poLayerProperties)
+                        if (poStats)
                         {
-                            UpdateLayerProperties(poLayerProperties, osKey,
-                                                  oValue);
+                            poStats->m_aoTags.emplace_back(osKey, oValue);
                         }
 
                         poFeature->addTag(oMapKeyToIdx[osKey]);
@@ -4850,93 +4896,45 @@ void OGRMVTWriterDataset::EncodeFeature(
 /*                            EncodeTile()                              */
 /************************************************************************/
 
-std::string OGRMVTWriterDataset::EncodeTile(
-    int nZ, int nX, int nY, sqlite3_stmt *hStmtLayer, sqlite3_stmt *hStmtRows,
-    std::map<CPLString, MVTLayerProperties> &oMapLayerProps,
-    std::set<CPLString> &oSetLayers, GIntBig &nTempTilesRead)
+void OGRMVTWriterDataset::EncodeTile(MVTTileJob *poJob) const
 {
-    MVTTile oTargetTile;
+    const int nZ = poJob->m_nZ;
+    const int nX = poJob->m_nX;
+    const int nY = poJob->m_nY;
 
-    sqlite3_bind_int(hStmtLayer, 1, nZ);
-    sqlite3_bind_int(hStmtLayer, 2, nX);
-    sqlite3_bind_int(hStmtLayer, 3, nY);
+    MVTTile oTargetTile;
 
     unsigned nFeaturesInTile = 0;
-    const GIntBig nProgressStep =
-        std::max(static_cast<GIntBig>(1), m_nTempTiles / 10);
-
-    while (nFeaturesInTile < m_nMaxFeatures &&
-           sqlite3_step(hStmtLayer) == SQLITE_ROW)
+    for (const auto &oLayer : poJob->m_aoLayers)
     {
-        const char *pszLayerName =
-            reinterpret_cast<const char *>(sqlite3_column_text(hStmtLayer, 0));
-        sqlite3_bind_int(hStmtRows, 1, nZ);
-        sqlite3_bind_int(hStmtRows, 2, nX);
-        sqlite3_bind_int(hStmtRows, 3, nY);
-        sqlite3_bind_text(hStmtRows, 4, pszLayerName, -1, SQLITE_STATIC);
+        if (nFeaturesInTile >= m_nMaxFeatures)
+            break;
 
-        auto oIterMapLayerProps = oMapLayerProps.find(pszLayerName);
-        MVTLayerProperties *poLayerProperties = nullptr;
-        if (oIterMapLayerProps == oMapLayerProps.end())
-        {
-            if (oSetLayers.size() < knMAX_COUNT_LAYERS)
-            {
-                oSetLayers.insert(pszLayerName);
-                if (oMapLayerProps.size() < knMAX_REPORT_LAYERS)
-                {
-                    MVTLayerProperties props;
-                    props.m_nMinZoom = nZ;
-                    props.m_nMaxZoom = nZ;
-                    oMapLayerProps[pszLayerName] = std::move(props);
-                    poLayerProperties = &(oMapLayerProps[pszLayerName]);
-                }
-            }
-        }
-        else
-        {
-            poLayerProperties = &(oIterMapLayerProps->second);
-        }
-        if (poLayerProperties)
-        {
-            poLayerProperties->m_nMinZoom =
-                std::min(nZ, poLayerProperties->m_nMinZoom);
-            poLayerProperties->m_nMaxZoom =
-                std::max(nZ, poLayerProperties->m_nMaxZoom);
-        }
+        poJob->m_aoStats.emplace_back();
+        MVTTileLayerStats &oStats = poJob->m_aoStats.back();
+        oStats.m_osName = oLayer.m_osName;
 
         std::shared_ptr<MVTTileLayer> poTargetLayer(new MVTTileLayer());
         oTargetTile.addLayer(poTargetLayer);
-        poTargetLayer->setName(pszLayerName);
+        poTargetLayer->setName(oLayer.m_osName);
         poTargetLayer->setVersion(m_nMVTVersion);
         poTargetLayer->setExtent(m_nExtent);
 
         std::map<CPLString, GUInt32> oMapKeyToIdx;
         std::map<MVTTileLayerValue, GUInt32> oMapValueToIdx;
 
-        while (nFeaturesInTile < m_nMaxFeatures &&
-               sqlite3_step(hStmtRows) == SQLITE_ROW)
+        for (const auto &oFeature : oLayer.m_aoFeatures)
         {
-            int nBlobSize = sqlite3_column_bytes(hStmtRows, 0);
-            const void *pabyBlob = sqlite3_column_blob(hStmtRows, 0);
-
-            EncodeFeature(pabyBlob, nBlobSize, poTargetLayer, oMapKeyToIdx,
-                          oMapValueToIdx, poLayerProperties, m_nExtent,
-                          nFeaturesInTile);
-
-            nTempTilesRead++;
-            if (nTempTilesRead == m_nTempTiles ||
-                (nTempTilesRead % nProgressStep) == 0)
-            {
-                const int nPct =
-                    static_cast<int>((100 * nTempTilesRead) / m_nTempTiles);
-                CPLDebug("MVT", "%d%%...", nPct);
-            }
+            if (nFeaturesInTile >= m_nMaxFeatures)
+                break;
+            EncodeFeature(oFeature.m_osBlob.data(),
+                          static_cast<int>(oFeature.m_osBlob.size()),
+                          poTargetLayer, oMapKeyToIdx, oMapValueToIdx, &oStats,
+                          m_nExtent, nFeaturesInTile);
+            poJob->m_nFeaturesRead++;
         }
-        sqlite3_reset(hStmtRows);
     }
 
-    sqlite3_reset(hStmtLayer);
-
     std::string oTileBuffer(oTargetTile.write());
     size_t nSizeBefore = oTileBuffer.size();
     if (m_bGZip)
@@ -4956,8 +4954,7 @@ std::string OGRMVTWriterDataset::EncodeTile(
     {
         nExtent /= 2;
         nSizeBefore = oTileBuffer.size();
-        oTileBuffer = RecodeTileLowerResolution(nZ, nX, nY, nExtent, hStmtLayer,
-                                                hStmtRows);
+        oTileBuffer = RecodeTileLowerResolution(poJob->m_aoLayers, nExtent);
         bTooBigTile = oTileBuffer.size() > m_nMaxTileSize;
         CPLDebug("MVT",
                  "Recoding tile %d/%d/%d with extent = %u. "
@@ -4985,17 +4982,26 @@ std::string OGRMVTWriterDataset::EncodeTile(
 
         const unsigned nTotalFeaturesInTile =
             std::min(m_nMaxFeatures, nFeaturesInTile);
-        char *pszSQL =
-            sqlite3_mprintf("SELECT layer, feature FROM temp "
-                            "WHERE z = %d AND x = %d AND y = %d ORDER BY "
-                            "area_or_length DESC LIMIT %d",
-                            nZ, nX, nY, nTotalFeaturesInTile);
-        sqlite3_stmt *hTmpStmt = nullptr;
-        CPL_IGNORE_RET_VAL(
-            sqlite3_prepare_v2(m_hDB, pszSQL, -1, &hTmpStmt, nullptr));
-        sqlite3_free(pszSQL);
-        if (!hTmpStmt)
-            return std::string();
+
+        // Features of all layers by descending area / length
+        std::vector<std::pair<const MVTTempLayer *, const MVTTempFeature *>>
+            aoSortedFeatures;
+        for (const auto &oLayer : poJob->m_aoLayers)
+        {
+            for (const auto &oFeature : oLayer.m_aoFeatures)
+                aoSortedFeatures.emplace_back(&oLayer, &oFeature);
+        }
+        std::stable_sort(aoSortedFeatures.begin(), aoSortedFeatures.end(),
+                         [](const std::pair<const MVTTempLayer *,
+                                            const MVTTempFeature *> &a,
+                            const std::pair<const MVTTempLayer *,
+                                            const MVTTempFeature *> &b)
+                         {
+                             return a.second->m_dfAreaOrLength >
+                                    b.second->m_dfAreaOrLength;
+                         });
+        if (aoSortedFeatures.size() > nTotalFeaturesInTile)
+            aoSortedFeatures.resize(nTotalFeaturesInTile);
 
         class TargetTileLayerProps
         {
@@ -5009,12 +5015,10 @@ std::string OGRMVTWriterDataset::EncodeTile(
 
         nFeaturesInTile = 0;
         const unsigned nCheckStep = std::max(1U, nTotalFeaturesInTile / 100);
-        while (sqlite3_step(hTmpStmt) == SQLITE_ROW)
+        for (const auto &oPair : aoSortedFeatures)
         {
-            const char *pszLayerName = reinterpret_cast<const char *>(
-                sqlite3_column_text(hTmpStmt, 0));
-            int nBlobSize = sqlite3_column_bytes(hTmpStmt, 1);
-            const void *pabyBlob = sqlite3_column_blob(hTmpStmt, 1);
+            const char *pszLayerName = oPair.first->m_osName.c_str();
+            const std::string &osBlob = oPair.second->m_osBlob;
 
             std::shared_ptr<MVTTileLayer> poTargetLayer;
             std::map<CPLString, GUInt32> *poMapKeyToIdx;
@@ -5043,8 +5047,9 @@ std::string OGRMVTWriterDataset::EncodeTile(
                 poMapValueToIdx = &oIter->second.m_oMapValueToIdx;
             }
 
-            EncodeFeature(pabyBlob, nBlobSize, poTargetLayer, *poMapKeyToIdx,
-                          *poMapValueToIdx, nullptr, nExtent, nFeaturesInTile);
+            EncodeFeature(osBlob.data(), static_cast<int>(osBlob.size()),
+                          poTargetLayer, *poMapKeyToIdx, *poMapValueToIdx,
+                          nullptr, nExtent, nFeaturesInTile);
 
             if (nFeaturesInTile == nTotalFeaturesInTile ||
                 (bTooBigTile && (nFeaturesInTile % nCheckStep == 0)))
@@ -5065,11 +5070,19 @@ std::string OGRMVTWriterDataset::EncodeTile(
             CPLDebug("MVT", "For tile %d/%d/%d, final tile size is %u", nZ, nX,
                      nY, static_cast<unsigned>(oTileBuffer.size()));
         }
-
-        sqlite3_finalize(hTmpStmt);
     }
 
-    return oTileBuffer;
+    poJob->m_osTileBuffer = std::move(oTileBuffer);
+}
+
+/************************************************************************/
+/*                       EncodeTileTaskFunc()                           */
+/************************************************************************/
+
+void OGRMVTWriterDataset::EncodeTileTaskFunc(void *pParam)
+{
+    MVTTileJob *poJob = static_cast<MVTTileJob *>(pParam);
+    poJob->m_poDS->EncodeTile(poJob);
 }
 
 /************************************************************************/
@@ -5077,49 +5090,36 @@ std::string OGRMVTWriterDataset::EncodeTile(
 /************************************************************************/
 
 std::string OGRMVTWriterDataset::RecodeTileLowerResolution(
-    int nZ, int nX, int nY, int nExtent, sqlite3_stmt *hStmtLayer,
-    sqlite3_stmt *hStmtRows)
+    const std::vector<MVTTempLayer> &aoLayers, int nExtent) const
 {
     MVTTile oTargetTile;
 
-    sqlite3_bind_int(hStmtLayer, 1, nZ);
-    sqlite3_bind_int(hStmtLayer, 2, nX);
-    sqlite3_bind_int(hStmtLayer, 3, nY);
-
     unsigned nFeaturesInTile = 0;
-    while (nFeaturesInTile < m_nMaxFeatures &&
-           sqlite3_step(hStmtLayer) == SQLITE_ROW)
+    for (const auto &oLayer : aoLayers)
     {
-        const char *pszLayerName =
-            reinterpret_cast<const char *>(sqlite3_column_text(hStmtLayer, 0));
-        sqlite3_bind_int(hStmtRows, 1, nZ);
-        sqlite3_bind_int(hStmtRows, 2, nX);
-        sqlite3_bind_int(hStmtRows, 3, nY);
-        sqlite3_bind_text(hStmtRows, 4, pszLayerName, -1, SQLITE_STATIC);
+        if (nFeaturesInTile >= m_nMaxFeatures)
+            break;
 
         std::shared_ptr<MVTTileLayer> poTargetLayer(new MVTTileLayer());
         oTargetTile.addLayer(poTargetLayer);
-        poTargetLayer->setName(pszLayerName);
+        poTargetLayer->setName(oLayer.m_osName);
         poTargetLayer->setVersion(m_nMVTVersion);
         poTargetLayer->setExtent(nExtent);
 
         std::map<CPLString, GUInt32> oMapKeyToIdx;
         std::map<MVTTileLayerValue, GUInt32> oMapValueToIdx;
 
-        while (nFeaturesInTile < m_nMaxFeatures &&
-               sqlite3_step(hStmtRows) == SQLITE_ROW)
+        for (const auto &oFeature : oLayer.m_aoFeatures)
         {
-            int nBlobSize = sqlite3_column_bytes(hStmtRows, 0);
-            const void *pabyBlob = sqlite3_column_blob(hStmtRows, 0);
-
-            EncodeFeature(pabyBlob, nBlobSize, poTargetLayer, oMapKeyToIdx,
-                          oMapValueToIdx, nullptr, nExtent, nFeaturesInTile);
+            if (nFeaturesInTile >= m_nMaxFeatures)
+                break;
+            EncodeFeature(oFeature.m_osBlob.data(),
+                          static_cast<int>(oFeature.m_osBlob.size()),
+                          poTargetLayer, oMapKeyToIdx, oMapValueToIdx, nullptr,
+                          nExtent, nFeaturesInTile);
         }
-        sqlite3_reset(hStmtRows);
     }
 
-    sqlite3_reset(hStmtLayer);
-
     std::string oTileBuffer(oTargetTile.write());
     if (m_bGZip)
         GZIPCompress(oTileBuffer);
@@ -5127,6 +5127,55 @@ std::string OGRMVTWriterDataset::RecodeTileLowerResolution(
     return oTileBuffer;
 }
 
+/************************************************************************/
+/*                           ApplyTileStats()                           */
+/************************************************************************/
+
+void OGRMVTWriterDataset::ApplyTileStats(
+    int nZ, const std::vector<MVTTileLayerStats> &aoStats,
+    std::map<CPLString, MVTLayerProperties> &oMapLayerProps,
+    std::set<CPLString> &oSetLayers)
+{
+    for (const auto &oStats : aoStats)
+    {
+        const CPLString &osLayerName = oStats.m_osName;
+        auto oIterMapLayerProps = oMapLayerProps.find(osLayerName);
+        MVTLayerProperties *poLayerProperties = nullptr;
+        if (oIterMapLayerProps == oMapLayerProps.end())
+        {
+            if (oSetLayers.size() < knMAX_COUNT_LAYERS)
+            {
+                oSetLayers.insert(osLayerName);
+                if (oMapLayerProps.size() < knMAX_REPORT_LAYERS)
+                {
+                    MVTLayerProperties props;
+                    props.m_nMinZoom = nZ;
+                    props.m_nMaxZoom = nZ;
+                    oMapLayerProps[osLayerName] = std::move(props);
+                    poLayerProperties = &(oMapLayerProps[osLayerName]);
+                }
+            }
+        }
+        else
+        {
+            poLayerProperties = &(oIterMapLayerProps->second);
+        }
+        if (poLayerProperties)
+        {
+            poLayerProperties->m_nMinZoom =
+                std::min(nZ, poLayerProperties->m_nMinZoom);
+            poLayerProperties->m_nMaxZoom =
+                std::max(nZ, poLayerProperties->m_nMaxZoom);
+            for (const auto &oIter : oStats.m_oCountGeomType)
+                poLayerProperties->m_oCountGeomType[oIter.first] +=
+                    oIter.second;
+            for (const auto &oTag : oStats.m_aoTags)
+                UpdateLayerProperties(poLayerProperties, oTag.first,
+                                      oTag.second);
+        }
+    }
+}
+
 /************************************************************************/
 /*                            CreateOutput()                            */
 /************************************************************************/
@@ -5156,29 +5205,16 @@ bool OGRMVTWriterDataset::CreateOutput()
         return false;
     }
 
-    sqlite3_stmt *hStmtLayer = nullptr;
-    CPL_IGNORE_RET_VAL(
-        sqlite3_prepare_v2(m_hDB,
-                           "SELECT DISTINCT layer FROM temp "
-                           "WHERE z = ? AND x = ? AND y = ? ORDER BY layer",
-                           -1, &hStmtLayer, nullptr));
-    if (hStmtLayer == nullptr)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined, "Prepared statement failed");
-        sqlite3_finalize(hStmtZXY);
-        return false;
-    }
     sqlite3_stmt *hStmtRows = nullptr;
     CPL_IGNORE_RET_VAL(sqlite3_prepare_v2(
         m_hDB,
-        "SELECT feature FROM temp "
-        "WHERE z = ? AND x = ? AND y = ? AND layer = ? ORDER BY idx",
+        "SELECT layer, feature, area_or_length FROM temp "
+        "WHERE z = ? AND x = ? AND y = ? ORDER BY layer, idx",
         -1, &hStmtRows, nullptr));
     if (hStmtRows == nullptr)
     {
         CPLError(CE_Failure, CPLE_AppDefined, "Prepared statement failed");
         sqlite3_finalize(hStmtZXY);
-        sqlite3_finalize(hStmtLayer);
         return false;
     }
 
@@ -5194,7 +5230,6 @@ bool OGRMVTWriterDataset::CreateOutput()
         {
             CPLError(CE_Failure, CPLE_AppDefined, "Prepared statement failed");
             sqlite3_finalize(hStmtZXY);
-            sqlite3_finalize(hStmtLayer);
             sqlite3_finalize(hStmtRows);
             return false;
         }
@@ -5204,20 +5239,23 @@ bool OGRMVTWriterDataset::CreateOutput()
     int nLastX = -1;
     bool bRet = true;
     GIntBig nTempTilesRead = 0;
+    const GIntBig nProgressStep =
+        std::max(static_cast<GIntBig>(1), m_nTempTiles / 10);
 
-    while (sqlite3_step(hStmtZXY) == SQLITE_ROW)
+    const auto WriteTile = [this, hInsertStmt, &nLastZ,
+                            &nLastX](int nZ, int nX, int nY,
+                                     const std::string &oTileBuffer)
     {
-        int nZ = sqlite3_column_int(hStmtZXY, 0);
-        int nX = sqlite3_column_int(hStmtZXY, 1);
-        int nY = sqlite3_column_int(hStmtZXY, 2);
-
-        std::string oTileBuffer(EncodeTile(nZ, nX, nY, hStmtLayer, hStmtRows,
-                                           oMapLayerProps, oSetLayers,
-                                           nTempTilesRead));
-
+        bool bOK;
         if (oTileBuffer.empty())
         {
-            bRet = false;
+            bOK = false;
+        }
+        else if (m_poTileSink)
+        {
+            bOK = m_poTileSink->WriteTile(
+                nZ, nX, nY, reinterpret_cast<const GByte *>(oTileBuffer.data()),
+                oTileBuffer.size());
         }
         else if (hInsertStmt)
         {
@@ -5228,7 +5266,7 @@ bool OGRMVTWriterDataset::CreateOutput()
                               static_cast<int>(oTileBuffer.size()),
                               SQLITE_STATIC);
             const int rc = sqlite3_step(hInsertStmt);
-            bRet = (rc == SQLITE_OK || rc == SQLITE_DONE);
+            bOK = (rc == SQLITE_OK || rc == SQLITE_DONE);
             sqlite3_reset(hInsertStmt);
         }
         else
@@ -5255,24 +5293,114 @@ bool OGRMVTWriterDataset::CreateOutput()
             {
                 const size_t nRet = VSIFWriteL(oTileBuffer.data(), 1,
                                                oTileBuffer.size(), fpOut);
-                bRet = (nRet == oTileBuffer.size());
+                bOK = (nRet == oTileBuffer.size());
                 VSIFCloseL(fpOut);
             }
             else
             {
-                bRet = false;
+                bOK = false;
             }
         }
 
-        if (!bRet)
+        if (!bOK)
         {
             CPLError(CE_Failure, CPLE_AppDefined,
                      "Error while writing tile %d/%d/%d", nZ, nX, nY);
-            break;
+        }
+        return bOK;
+    };
+
+    // Tiles are read from the temporary database by this thread, encoded by
+    // the worker threads, and written in (z, x, y) order by batches, so that
+    // layer properties are collected in the same order as in sequential mode.
+    constexpr size_t MAX_TILES_PER_BATCH = 1000;
+    constexpr size_t MAX_BATCH_SIZE = 100 * 1024 * 1024;
+    std::vector<std::unique_ptr<MVTTileJob>> apoJobs;
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if (m_bThreadPoolOK)
+        poJobQueue = m_oThreadPool.CreateJobQueue();
+    size_t nBatchSize = 0;
+
+    const auto FlushBatch = [&]()
+    {
+        if (poJobQueue)
+            poJobQueue->WaitCompletion();
+        for (const auto &poJob : apoJobs)
+        {
+            ApplyTileStats(poJob->m_nZ, poJob->m_aoStats, oMapLayerProps,
+                           oSetLayers);
+
+            const GIntBig nTempTilesReadBefore = nTempTilesRead;
+            nTempTilesRead += poJob->m_nFeaturesRead;
+            if (nTempTilesRead > nTempTilesReadBefore &&
+                (nTempTilesRead == m_nTempTiles ||
+                 nTempTilesRead / nProgressStep !=
+                     nTempTilesReadBefore / nProgressStep))
+            {
+                const int nPct =
+                    static_cast<int>((100 * nTempTilesRead) / m_nTempTiles);
+                CPLDebug("MVT", "%d%%...", nPct);
+            }
+
+            if (bRet)
+            {
+                bRet = WriteTile(poJob->m_nZ, poJob->m_nX, poJob->m_nY,
+                                 poJob->m_osTileBuffer);
+            }
+        }
+        apoJobs.clear();
+        nBatchSize = 0;
+    };
+
+    while (bRet && sqlite3_step(hStmtZXY) == SQLITE_ROW)
+    {
+        auto poJob = std::make_unique<MVTTileJob>();
+        poJob->m_poDS = this;
+        poJob->m_nZ = sqlite3_column_int(hStmtZXY, 0);
+        poJob->m_nX = sqlite3_column_int(hStmtZXY, 1);
+        poJob->m_nY = sqlite3_column_int(hStmtZXY, 2);
+
+        sqlite3_bind_int(hStmtRows, 1, poJob->m_nZ);
+        sqlite3_bind_int(hStmtRows, 2, poJob->m_nX);
+        sqlite3_bind_int(hStmtRows, 3, poJob->m_nY);
+        while (sqlite3_step(hStmtRows) == SQLITE_ROW)
+        {
+            const char *pszLayerName = reinterpret_cast<const char *>(
+                sqlite3_column_text(hStmtRows, 0));
+            if (poJob->m_aoLayers.empty() ||
+                poJob->m_aoLayers.back().m_osName != pszLayerName)
+            {
+                poJob->m_aoLayers.emplace_back();
+                poJob->m_aoLayers.back().m_osName = pszLayerName;
+            }
+            const int nBlobSize = sqlite3_column_bytes(hStmtRows, 1);
+            const char *pabyBlob =
+                static_cast<const char *>(sqlite3_column_blob(hStmtRows, 1));
+            MVTTempFeature oFeature;
+            if (pabyBlob)
+                oFeature.m_osBlob.assign(pabyBlob, nBlobSize);
+            oFeature.m_dfAreaOrLength = sqlite3_column_double(hStmtRows, 2);
+            poJob->m_aoLayers.back().m_aoFeatures.push_back(
+                std::move(oFeature));
+            nBatchSize += nBlobSize;
+        }
+        sqlite3_reset(hStmtRows);
+
+        if (poJobQueue)
+            poJobQueue->SubmitJob(EncodeTileTaskFunc, poJob.get());
+        else
+            EncodeTile(poJob.get());
+        apoJobs.push_back(std::move(poJob));
+
+        if (apoJobs.size() == MAX_TILES_PER_BATCH ||
+            nBatchSize > MAX_BATCH_SIZE)
+        {
+            FlushBatch();
         }
     }
+    FlushBatch();
+
     sqlite3_finalize(hStmtZXY);
-    sqlite3_finalize(hStmtLayer);
     sqlite3_finalize(hStmtRows);
     if (hInsertStmt)
         sqlite3_finalize(hInsertStmt);
@@ -5641,6 +5769,11 @@ bool OGRMVTWriterDataset::GenerateMetadata(
         return true;
     }
 
+    if (m_poTileSink)
+    {
+        return m_poTileSink->WriteMetadata(oRoot);
+    }
+
     return oDoc.Save(
         CPLFormFilename(GetDescription(), "metadata.json", nullptr));
 }
@@ -5907,13 +6040,21 @@ GDALDataset *OGRMVTWriterDataset::Create(const char *pszFilename, int nXSize,
         return nullptr;
     }
 
+    return Create(pszFilename, papszOptions, nullptr);
+}
+
+GDALDataset *OGRMVTWriterDataset::Create(const char *pszFilename,
+                                         char **papszOptions,
+                                         OGRMVTTileSink *poTileSink)
+{
     const char *pszFormat = CSLFetchNameValue(papszOptions, "FORMAT");
     const bool bMBTILESExt = EQUAL(CPLGetExtension(pszFilename), "mbtiles");
     if (pszFormat == nullptr && bMBTILESExt)
     {
         pszFormat = "MBTILES";
     }
-    const bool bMBTILES = pszFormat != nullptr && EQUAL(pszFormat, "MBTILES");
+    const bool bMBTILES = poTileSink == nullptr && pszFormat != nullptr &&
+                          EQUAL(pszFormat, "MBTILES");
 
     // For debug only
     bool bReuseTempFile =
@@ -5930,7 +6071,7 @@ GDALDataset *OGRMVTWriterDataset::Create(const char *pszFilename, int nXSize,
 
         VSIUnlink(pszFilename);
     }
-    else
+    else if (poTileSink == nullptr)
     {
         VSIStatBufL sStat;
         if (VSIStatL(pszFilename, &sStat) == 0)
@@ -6083,10 +6224,11 @@ GDALDataset *OGRMVTWriterDataset::Create(const char *pszFilename, int nXSize,
         CSLFetchNameValue(papszOptions, "TILING_SCHEME");
     if (pszTilingScheme)
     {
-        if (bMBTILES)
+        if (bMBTILES || poTileSink)
         {
             CPLError(CE_Failure, CPLE_NotSupported,
-                     "Custom TILING_SCHEME not supported with MBTILES output");
+                     "Custom TILING_SCHEME not supported with %s output",
+                     bMBTILES ? "MBTILES" : "this");
             delete poDS;
             return nullptr;
         }
@@ -6151,6 +6293,7 @@ GDALDataset *OGRMVTWriterDataset::Create(const char *pszFilename, int nXSize,
             poDS->m_oThreadPool.Setup(nThreads, nullptr, nullptr);
     }
 
+    poDS->m_poTileSink = poTileSink;
     poDS->SetDescription(pszFilename);
     return poDS;
 }
@@ -6163,6 +6306,13 @@ GDALDataset *OGRMVTWriterDatasetCreate(const char *pszFilename, int nXSize,
                                        eDT, papszOptions);
 }
 
+GDALDataset *OGRMVTWriterDatasetCreate(const char *pszFilename,
+                                       char **papszOptions,
+                                       OGRMVTTileSink *poTileSink)
+{
+    return OGRMVTWriterDataset::Create(pszFilename, papszOptions, poTileSink);
+}
+
 #endif  // HAVE_MVT_WRITE_SUPPORT
 
 /************************************************************************/
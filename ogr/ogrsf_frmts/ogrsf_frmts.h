@@ -55,9 +55,32 @@
 
 class OGRLayerAttrIndex;
 class OGRSFDriver;
+class OGRLayerParallelArrowReader;
 
 struct ArrowArrayStream;
 
+/************************************************************************/
+/*                          OGRLayerPartition                           */
+/************************************************************************/
+
+/**
+ * Subset of the features of a layer, that can be read independently of the
+ * layer and of other partitions, typically from another thread.
+ *
+ * @since GDAL 3.9
+ */
+class CPL_DLL OGRLayerPartition
+{
+  public:
+    virtual ~OGRLayerPartition();
+
+    /** Return a layer that iterates over the features of the partition, and
+     * only them. It has the same schema as the layer of which this is a
+     * partition, and its lifetime is the one of this object.
+     */
+    virtual OGRLayer *GetLayer() = 0;
+};
+
 /************************************************************************/
 /*                               OGRLayer                               */
 /************************************************************************/
@@ -136,6 +159,7 @@ class CPL_DLL OGRLayer : public GDALMajorObject
         std::vector<GIntBig> m_anQueriedFIDs{};
         size_t m_iQueriedFIDS = 0;
         std::deque<std::unique_ptr<OGRFeature>> m_oFeatureQueue{};
+        std::shared_ptr<OGRLayerParallelArrowReader> m_poParallelReader{};
     };
     std::shared_ptr<ArrowArrayStreamPrivateData>
         m_poSharedArrowArrayStreamPrivateData{};
@@ -143,6 +167,8 @@ class CPL_DLL OGRLayer : public GDALMajorObject
     {
         std::shared_ptr<ArrowArrayStreamPrivateData> poShared{};
     };
+    std::shared_ptr<OGRLayerParallelArrowReader>
+    CreateParallelArrowReader(int nThreads, CSLConstList papszOptions);
     //! @endcond
 
     friend class OGRArrowArrayHelper;
@@ -209,10 +235,13 @@ class CPL_DLL OGRLayer : public GDALMajorObject
 
     virtual void ResetReading() = 0;
     virtual OGRFeature *GetNextFeature() CPL_WARN_UNUSED_RESULT = 0;
+    virtual int GetNextFeatureBatch(OGRFeatureBatch &oBatch, int nMaxFeatures);
     virtual OGRErr SetNextByIndex(GIntBig nIndex);
     virtual OGRFeature *GetFeature(GIntBig nFID) CPL_WARN_UNUSED_RESULT;
 
     virtual GDALDataset *GetDataset();
+    virtual std::vector<std::unique_ptr<OGRLayerPartition>>
+    GetPartitions(int nMaxPartitions);
     virtual bool GetArrowStream(struct ArrowArrayStream *out_stream,
                                 CSLConstList papszOptions = nullptr);
     virtual bool IsArrowSchemaSupported(const struct ArrowSchema *schema,
@@ -295,6 +324,8 @@ class CPL_DLL OGRLayer : public GDALMajorObject
 
     virtual OGRErr SetIgnoredFields(const char **papszFields);
 
+    virtual CPLStringList ExplainQuery();
+
     virtual OGRGeometryTypeCounter *
     GetGeometryTypes(int iGeomField, int nFlagsGGT, int &nEntryCountOut,
                      GDALProgressFunc pfnProgress, void *pProgressData);
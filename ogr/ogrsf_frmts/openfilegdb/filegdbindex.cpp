@@ -222,6 +222,8 @@ class FileGDBOrIterator final : public FileGDBIterator
 
 constexpr int MAX_DEPTH = 3;
 constexpr int FGDB_PAGE_SIZE = 4096;
+// Maximum number of contiguous feature pages read at once
+constexpr int MAX_COALESCED_FEATURE_PAGES = 16;
 
 class FileGDBIndexIteratorBase : virtual public FileGDBIterator
 {
@@ -255,7 +257,7 @@ class FileGDBIndexIteratorBase : virtual public FileGDBIterator
     typedef lru11::Cache<int, cpl::NonCopyableVector<GByte>> CacheType;
     std::array<CacheType, MAX_DEPTH> m_oCachePage{
         {CacheType{2, 0}, CacheType{2, 0}, CacheType{2, 0}}};
-    CacheType m_oCacheFeaturePage{2, 0};
+    CacheType m_oCacheFeaturePage{MAX_COALESCED_FEATURE_PAGES, 0};
 
     bool ReadTrailer(const std::string &osFilename);
 
@@ -1556,21 +1558,94 @@ int FileGDBIndexIteratorBase::LoadNextFeaturePage()
     }
     else
     {
-        cpl::NonCopyableVector<GByte> cachedPage;
-        if (m_oCacheFeaturePage.size() == m_oCacheFeaturePage.getMaxSize())
+        // The next feature pages referenced by the parent page are often
+        // contiguous in the file. Read them together with the current one,
+        // to save I/O requests, in particular on network file systems.
+        GUInt32 nFirstPage = nPage;
+        GUInt32 nPageCount = 1;
+        if (nIndexDepth > 1)
         {
-            m_oCacheFeaturePage.removeAndRecycleOldestEntry(cachedPage);
-            cachedPage.clear();
+            const int iLevel = nIndexDepth - 2;
+            const int nStep = bAscending ? 1 : -1;
+            GUInt32 nLastPage = nPage;
+            int nDirection = 0;
+            for (int iIdx = iCurPageIdx[iLevel] + nStep;
+                 iIdx >= iFirstPageIdx[iLevel] &&
+                 iIdx <= iLastPageIdx[iLevel] &&
+                 nPageCount < MAX_COALESCED_FEATURE_PAGES;
+                 iIdx += nStep)
+            {
+                const GUInt32 nNextPage =
+                    GetUInt32(abyPage[iLevel] + 8, iIdx);
+                const int nNextDirection = nNextPage == nLastPage + 1   ? 1
+                                           : nNextPage + 1 == nLastPage ? -1
+                                                                        : 0;
+                if (nNextDirection == 0 ||
+                    (nDirection != 0 && nNextDirection != nDirection) ||
+                    m_oCacheFeaturePage.contains(nNextPage))
+                {
+                    break;
+                }
+                nDirection = nNextDirection;
+                nLastPage = nNextPage;
+                nPageCount++;
+            }
+            nFirstPage = std::min(nPage, nLastPage);
         }
 
+        std::vector<GByte> abyPages(static_cast<size_t>(nPageCount) *
+                                    FGDB_PAGE_SIZE);
         VSIFSeekL(fpCurIdx,
-                  static_cast<vsi_l_offset>(nPage - 1) * FGDB_PAGE_SIZE,
+                  static_cast<vsi_l_offset>(nFirstPage - 1) * FGDB_PAGE_SIZE,
                   SEEK_SET);
+        if (VSIFReadL(abyPages.data(), abyPages.size(), 1, fpCurIdx) != 1)
+        {
+            returnErrorIf(nPageCount == 1);
+            // The file might be truncated after the current page. Retry
+            // with the current page only.
+            nFirstPage = nPage;
+            nPageCount = 1;
+            abyPages.resize(FGDB_PAGE_SIZE);
+            VSIFSeekL(fpCurIdx,
+                      static_cast<vsi_l_offset>(nPage - 1) * FGDB_PAGE_SIZE,
+                      SEEK_SET);
+            returnErrorIf(
+                VSIFReadL(abyPages.data(), abyPages.size(), 1, fpCurIdx) != 1);
+        }
 #ifdef DEBUG
         iLoadedPage[nIndexDepth - 1] = nPage;
 #endif
-        returnErrorIf(VSIFReadL(abyPageFeature, FGDB_PAGE_SIZE, 1, fpCurIdx) !=
-                      1);
+        memcpy(abyPageFeature,
+               abyPages.data() +
+                   static_cast<size_t>(nPage - nFirstPage) * FGDB_PAGE_SIZE,
+               FGDB_PAGE_SIZE);
+
+        // Insert the current page last, so that it is the most recently
+        // used one.
+        for (GUInt32 i = 0; i < nPageCount; ++i)
+        {
+            const GUInt32 nCachedPage = nFirstPage + i;
+            if (nCachedPage == nPage)
+                continue;
+            cpl::NonCopyableVector<GByte> cachedPage;
+            if (m_oCacheFeaturePage.size() ==
+                m_oCacheFeaturePage.getMaxSize())
+            {
+                m_oCacheFeaturePage.removeAndRecycleOldestEntry(cachedPage);
+                cachedPage.clear();
+            }
+            const GByte *pabySrc =
+                abyPages.data() + static_cast<size_t>(i) * FGDB_PAGE_SIZE;
+            cachedPage.insert(cachedPage.end(), pabySrc,
+                              pabySrc + FGDB_PAGE_SIZE);
+            m_oCacheFeaturePage.insert(nCachedPage, std::move(cachedPage));
+        }
+        cpl::NonCopyableVector<GByte> cachedPage;
+        if (m_oCacheFeaturePage.size() == m_oCacheFeaturePage.getMaxSize())
+        {
+            m_oCacheFeaturePage.removeAndRecycleOldestEntry(cachedPage);
+            cachedPage.clear();
+        }
         cachedPage.insert(cachedPage.end(), abyPageFeature,
                           abyPageFeature + FGDB_PAGE_SIZE);
         m_oCacheFeaturePage.insert(nPage, std::move(cachedPage));
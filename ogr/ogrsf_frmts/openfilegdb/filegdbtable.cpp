@@ -711,6 +711,8 @@ bool FileGDBTable::Open(const char *pszFilename, bool bUpdate,
     CPLAssert(m_fpTable == nullptr);
 
     m_bUpdate = bUpdate;
+    m_bBulkLoad = bUpdate && CPLTestBool(CPLGetConfigOption(
+                                 "OPENFILEGDB_BULK_LOAD", "NO"));
 
     m_osFilename = pszFilename;
     CPLString m_osFilenameWithLayerName(m_osFilename);
@@ -1370,6 +1372,7 @@ FileGDBTable::GetOffsetInTableForRow(int iRow, vsi_l_offset *pnOffsetInTableX)
     if (pnOffsetInTableX)
         *pnOffsetInTableX = 0;
     returnErrorIf(iRow < 0 || iRow >= m_nTotalRecordCount);
+    returnErrorIf(!m_abyBulkLoadBuffer.empty() && !FlushBulkLoadBuffer());
 
     m_bIsDeleted = FALSE;
     if (m_fpTableX == nullptr)
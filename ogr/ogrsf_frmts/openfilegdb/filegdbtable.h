@@ -447,6 +447,14 @@ class FileGDBTable
     int m_nHasFreeList = -1;
     bool m_bFreelistCanBeDeleted = false;
 
+    // Bulk load mode: features appended at the end of the table are
+    // accumulated in memory, and the freelist is not used.
+    bool m_bBulkLoad = false;
+    std::vector<GByte> m_abyBulkLoadBuffer{};  // pending .gdbtable rows
+    uint64_t m_nBulkLoadBufferOffset = 0;      // offset of first pending row
+    std::vector<GByte> m_abyBulkLoadTablxBuffer{};  // pending .gdbtablx entries
+    int m_nBulkLoadFirstRow = 0;  // 0-based index of first pending row
+
     char m_achGUIDBuffer[32 + 6 + 1]{0};
     int m_nChSaved = -1;
 
@@ -536,6 +544,7 @@ class FileGDBTable
     uint64_t ReadFeatureOffset(const GByte *pabyBuffer);
     void WriteFeatureOffset(uint64_t nFeatureOffset, GByte *pabyBuffer);
     bool WriteFeatureOffset(uint64_t nFeatureOffset);
+    bool FlushBulkLoadBuffer();
     bool EncodeFeature(const std::vector<OGRField> &asRawFields,
                        const OGRGeometry *poGeom, int iSkipField);
     bool EncodeGeometry(const FileGDBGeomField *poGeomField,
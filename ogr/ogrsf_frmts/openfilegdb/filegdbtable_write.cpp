@@ -62,6 +62,7 @@ namespace OpenFileGDB
 constexpr uint8_t EXT_SHAPE_SEGMENT_ARC = 1;
 constexpr int TABLX_HEADER_SIZE = 16;
 constexpr int TABLX_FEATURES_PER_PAGE = 1024;
+constexpr size_t BULK_LOAD_BUFFER_SIZE = 16 * 1024 * 1024;
 
 /************************************************************************/
 /*                               Create()                               */
@@ -79,6 +80,8 @@ bool FileGDBTable::Create(const char *pszFilename, int nTablxOffsetSize,
     m_bGeomTypeHasZ = bGeomTypeHasZ;
     m_bGeomTypeHasM = bGeomTypeHasM;
     m_bHasReadGDBIndexes = TRUE;
+    m_bBulkLoad =
+        CPLTestBool(CPLGetConfigOption("OPENFILEGDB_BULK_LOAD", "YES"));
 
     if (!EQUAL(CPLGetExtension(pszFilename), "gdbtable"))
     {
@@ -215,7 +218,7 @@ bool FileGDBTable::Sync(VSILFILE *fpTable, VSILFILE *fpTableX)
     if (fpTableX == nullptr)
         fpTableX = m_fpTableX;
 
-    bool bRet = true;
+    bool bRet = FlushBulkLoadBuffer();
 
     if (m_bDirtyGdbIndexesFile)
     {
@@ -1839,8 +1842,19 @@ bool FileGDBTable::CreateFeature(const std::vector<OGRField> &asRawFields,
         return false;
     }
 
-    const uint64_t nFreeOffset = GetOffsetOfFreeAreaFromFreeList(
-        static_cast<uint32_t>(sizeof(uint32_t) + m_abyBuffer.size()));
+    // In bulk load mode, features appended right after the last one are
+    // accumulated in memory, without looking for a hole in the freelist.
+    const bool bBulkLoadAppend = m_bBulkLoad && m_fpTableX != nullptr &&
+                                 m_abyTablXBlockMap.empty() &&
+                                 nObjectID == m_nTotalRecordCount + 1;
+    if (!bBulkLoadAppend && !FlushBulkLoadBuffer())
+        return false;
+
+    const uint64_t nFreeOffset =
+        bBulkLoadAppend
+            ? OFFSET_MINUS_ONE
+            : GetOffsetOfFreeAreaFromFreeList(
+                  static_cast<uint32_t>(sizeof(uint32_t) + m_abyBuffer.size()));
     if (nFreeOffset == OFFSET_MINUS_ONE)
     {
         if (((m_nFileSize + m_abyBuffer.size()) >> (8 * m_nTablxOffsetSize)) !=
@@ -1853,29 +1867,59 @@ bool FileGDBTable::CreateFeature(const std::vector<OGRField> &asRawFields,
         }
     }
 
-    if (!SeekIntoTableXForNewFeature(nObjectID))
-        return false;
-
-    if (nFreeOffset == OFFSET_MINUS_ONE)
+    if (bBulkLoadAppend)
     {
-        VSIFSeekL(m_fpTable, m_nFileSize, SEEK_SET);
+        if (m_abyBulkLoadBuffer.empty())
+        {
+            m_nBulkLoadBufferOffset = m_nFileSize;
+            m_nBulkLoadFirstRow = nObjectID - 1;
+        }
+
+        const uint32_t n1024BlocksPresent = static_cast<uint32_t>(
+            DIV_ROUND_UP(nObjectID, TABLX_FEATURES_PER_PAGE));
+        if (n1024BlocksPresent > m_n1024BlocksPresent)
+        {
+            m_n1024BlocksPresent = n1024BlocksPresent;
+            m_bDirtyTableXTrailer = true;
+            m_nOffsetTableXTrailer = 0;
+        }
+
+        WriteUInt32(m_abyBulkLoadBuffer,
+                    static_cast<uint32_t>(m_abyBuffer.size()));
+        m_abyBulkLoadBuffer.insert(m_abyBulkLoadBuffer.end(),
+                                   m_abyBuffer.begin(), m_abyBuffer.end());
+
+        const size_t nTablxBufferSize = m_abyBulkLoadTablxBuffer.size();
+        m_abyBulkLoadTablxBuffer.resize(nTablxBufferSize + m_nTablxOffsetSize);
+        WriteFeatureOffset(m_nFileSize,
+                           m_abyBulkLoadTablxBuffer.data() + nTablxBufferSize);
     }
     else
     {
-        VSIFSeekL(m_fpTable, nFreeOffset, SEEK_SET);
-    }
-    if (!WriteUInt32(m_fpTable, static_cast<uint32_t>(m_abyBuffer.size())))
-        return false;
-    if (!m_abyBuffer.empty() &&
-        VSIFWriteL(m_abyBuffer.data(), 1, m_abyBuffer.size(), m_fpTable) !=
-            m_abyBuffer.size())
-    {
-        return false;
-    }
+        if (!SeekIntoTableXForNewFeature(nObjectID))
+            return false;
 
-    if (!WriteFeatureOffset(nFreeOffset == OFFSET_MINUS_ONE ? m_nFileSize
-                                                            : nFreeOffset))
-        return false;
+        if (nFreeOffset == OFFSET_MINUS_ONE)
+        {
+            VSIFSeekL(m_fpTable, m_nFileSize, SEEK_SET);
+        }
+        else
+        {
+            VSIFSeekL(m_fpTable, nFreeOffset, SEEK_SET);
+        }
+        if (!WriteUInt32(m_fpTable, static_cast<uint32_t>(m_abyBuffer.size())))
+            return false;
+        if (!m_abyBuffer.empty() &&
+            VSIFWriteL(m_abyBuffer.data(), 1, m_abyBuffer.size(), m_fpTable) !=
+                m_abyBuffer.size())
+        {
+            return false;
+        }
+
+        if (!WriteFeatureOffset(nFreeOffset == OFFSET_MINUS_ONE ? m_nFileSize
+                                                                : nFreeOffset))
+            return false;
+    }
     if (pnFID)
         *pnFID = nObjectID;
 
@@ -1894,9 +1938,57 @@ bool FileGDBTable::CreateFeature(const std::vector<OGRField> &asRawFields,
 
     m_bDirtyIndices = true;
 
+    if (m_abyBulkLoadBuffer.size() >= BULK_LOAD_BUFFER_SIZE)
+        return FlushBulkLoadBuffer();
+
     return true;
 }
 
+/************************************************************************/
+/*                        FlushBulkLoadBuffer()                         */
+/************************************************************************/
+
+bool FileGDBTable::FlushBulkLoadBuffer()
+{
+    if (m_abyBulkLoadBuffer.empty())
+        return true;
+
+    bool bRet = true;
+    VSIFSeekL(m_fpTable, m_nBulkLoadBufferOffset, SEEK_SET);
+    if (VSIFWriteL(m_abyBulkLoadBuffer.data(), m_abyBulkLoadBuffer.size(), 1,
+                   m_fpTable) != 1)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot write features in %s",
+                 m_osFilename.c_str());
+        bRet = false;
+    }
+
+    // Write the offsets of the pending features, and complete the last
+    // .gdbtablx page with null offsets.
+    const uint64_t nOffsetInTableX =
+        TABLX_HEADER_SIZE +
+        static_cast<uint64_t>(m_nBulkLoadFirstRow) * m_nTablxOffsetSize;
+    const uint64_t nEndOfPages =
+        TABLX_HEADER_SIZE + static_cast<uint64_t>(m_n1024BlocksPresent) *
+                                TABLX_FEATURES_PER_PAGE * m_nTablxOffsetSize;
+    CPLAssert(nEndOfPages >=
+              nOffsetInTableX + m_abyBulkLoadTablxBuffer.size());
+    m_abyBulkLoadTablxBuffer.resize(
+        static_cast<size_t>(nEndOfPages - nOffsetInTableX));
+    VSIFSeekL(m_fpTableX, nOffsetInTableX, SEEK_SET);
+    if (VSIFWriteL(m_abyBulkLoadTablxBuffer.data(),
+                   m_abyBulkLoadTablxBuffer.size(), 1, m_fpTableX) != 1)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot write feature offsets in %s",
+                 CPLResetExtension(m_osFilename.c_str(), "gdbtablx"));
+        bRet = false;
+    }
+
+    m_abyBulkLoadBuffer.clear();
+    m_abyBulkLoadTablxBuffer.clear();
+    return bRet;
+}
+
 /************************************************************************/
 /*                          UpdateFeature()                             */
 /************************************************************************/
@@ -711,6 +711,9 @@ WriteFieldDescriptor(std::vector<GByte> &abyBuffer, const FileGDBField *psField,
 
 bool FileGDBTable::WriteFieldDescriptors(VSILFILE *fpTable)
 {
+    if (fpTable == m_fpTable && !FlushBulkLoadBuffer())
+        return false;
+
     m_bDirtyFieldDescriptors = false;
 
     // In-memory field descriptors
@@ -1785,6 +1785,7 @@ OGRLayer *OGROpenFileGDBDataSource::ExecuteSQL(const char *pszSQLCommand,
          */
         if (oSelect.join_count == 0 && oSelect.poOtherSelect == nullptr &&
             oSelect.table_count == 1 && oSelect.order_specs == 0 &&
+            oSelect.group_defs.empty() &&
             oSelect.query_mode != SWQM_DISTINCT_LIST &&
             oSelect.where_expr == nullptr)
         {
@@ -1931,6 +1932,7 @@ OGRLayer *OGROpenFileGDBDataSource::ExecuteSQL(const char *pszSQLCommand,
          */
         if (oSelect.join_count == 0 && oSelect.poOtherSelect == nullptr &&
             oSelect.table_count == 1 && oSelect.order_specs == 1 &&
+            oSelect.group_defs.empty() &&
             oSelect.query_mode != SWQM_DISTINCT_LIST)
         {
             OGROpenFileGDBLayer *poLayer =
@@ -35,6 +35,7 @@
 
 #include "ogrsf_frmts.h"
 #include "cpl_string.h"
+#include "cpl_virtualmem.h"
 
 #include <array>
 #include <set>
@@ -412,6 +413,11 @@ class OGROSMDataSource final : public OGRDataSource
 
     std::vector<LonLat> m_asLonLatCache{};
 
+    // Coordinates and compressed form of the ways of the current batch
+    std::vector<std::vector<LonLat>> m_aasWayLonLats{};
+    std::vector<std::vector<GByte>> m_aabyCompressedWays{};
+    int m_nNumThreads = 1;
+
     std::array<const char *, 7> m_ignoredKeys = {{"area", "created_by",
                                                   "converted_by", "note",
                                                   "todo", "fixme", "FIXME"}};
@@ -489,6 +495,11 @@ class OGROSMDataSource final : public OGRDataSource
     bool m_bMustUnlinkNodesFile = true;
     GIntBig m_nNodesFileSize = 0;
     VSILFILE *m_fpNodes = nullptr;
+    // Read-only view of the content of the nodes file, when it could be
+    // obtained (memory mapping, or /vsimem/ buffer)
+    CPLVirtualMem *m_psNodesFileMap = nullptr;
+    const GByte *m_pabyNodesData = nullptr;
+    GIntBig m_nNodesDataSize = 0;
 
     GIntBig m_nPrevNodeId = -INT_MAX;
     int m_nBucketOld = -1;
@@ -524,18 +535,19 @@ class OGROSMDataSource final : public OGRDataSource
     bool FlushCurrentSectorNonCompressedCase();
     bool IndexPointCustom(OSMNode *psNode);
 
-    void IndexWay(GIntBig nWayID, bool bIsArea, unsigned int nTags,
-                  IndexedKVP *pasTags, LonLat *pasLonLatPairs, int nPairs,
-                  OSMInfo *psInfo);
+    void IndexWay(GIntBig nWayID, const std::vector<GByte> &abyCompressedWay);
 
     bool StartTransactionCacheDB();
     bool CommitTransactionCacheDB();
 
-    int FindNode(GIntBig nID);
+    int FindNode(GIntBig nID) const;
+    void ResolveWay(int iPair, bool bIndexAreaTags);
     void ProcessWaysBatch();
 
     void ProcessPolygonsStandalone();
 
+    void UpdateNodesFileView();
+    void ReleaseNodesFileView();
     void LookupNodes();
     void LookupNodesSQLite();
     void LookupNodesCustom();
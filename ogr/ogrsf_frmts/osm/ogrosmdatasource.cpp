@@ -56,6 +56,8 @@
 #include "cpl_string.h"
 #include "cpl_time.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -311,6 +313,7 @@ OGROSMDataSource::~OGROSMDataSource()
         }
     }
 
+    ReleaseNodesFileView();
     if (m_fpNodes)
         VSIFCloseL(m_fpNodes);
     if (!m_osNodesFilename.empty() && m_bMustUnlinkNodesFile)
@@ -993,6 +996,66 @@ static bool DecompressSector(const GByte *pabyIn, int nSectorSize,
     return nRead == nSectorSize;
 }
 
+/************************************************************************/
+/*                        UpdateNodesFileView()                         */
+/************************************************************************/
+
+// Gives direct read access to the content of the nodes file, so that node
+// lookups do not need to go through seeks and reads.
+void OGROSMDataSource::UpdateNodesFileView()
+{
+    if (m_bInMemoryNodesFile)
+    {
+        // The buffer of a /vsimem/ file may be reallocated when it grows,
+        // so fetch it again each time.
+        vsi_l_offset nLength = 0;
+        m_pabyNodesData =
+            VSIGetMemFileBuffer(m_osNodesFilename, &nLength, FALSE);
+        m_nNodesDataSize =
+            m_pabyNodesData
+                ? std::min(static_cast<GIntBig>(nLength), m_nNodesFileSize)
+                : 0;
+        return;
+    }
+
+    if (m_psNodesFileMap != nullptr && m_nNodesDataSize == m_nNodesFileSize)
+        return;
+
+    ReleaseNodesFileView();
+    if (m_nNodesFileSize == 0 || !CPLIsVirtualMemFileMapAvailable() ||
+        static_cast<GUIntBig>(m_nNodesFileSize) >
+            std::numeric_limits<size_t>::max() ||
+        VSIFFlushL(m_fpNodes) != 0)
+    {
+        return;
+    }
+
+    m_psNodesFileMap = CPLVirtualMemFileMapNew(
+        m_fpNodes, 0, static_cast<vsi_l_offset>(m_nNodesFileSize),
+        VIRTUALMEM_READONLY, nullptr, nullptr);
+    if (m_psNodesFileMap != nullptr)
+    {
+        m_pabyNodesData =
+            static_cast<const GByte *>(CPLVirtualMemGetAddr(m_psNodesFileMap));
+        m_nNodesDataSize = m_nNodesFileSize;
+    }
+}
+
+/************************************************************************/
+/*                        ReleaseNodesFileView()                        */
+/************************************************************************/
+
+void OGROSMDataSource::ReleaseNodesFileView()
+{
+    if (m_psNodesFileMap != nullptr)
+    {
+        CPLVirtualMemFree(m_psNodesFileMap);
+        m_psNodesFileMap = nullptr;
+    }
+    m_pabyNodesData = nullptr;
+    m_nNodesDataSize = 0;
+}
+
 /************************************************************************/
 /*                           LookupNodesCustom()                        */
 /************************************************************************/
@@ -1012,6 +1075,8 @@ void OGROSMDataSource::LookupNodesCustom()
         m_nBucketOld = -1;
     }
 
+    UpdateNodesFileView();
+
     CPLAssert(m_nUnsortedReqIds <=
               static_cast<unsigned int>(MAX_ACCUMULATED_NODES));
 
@@ -1139,22 +1204,23 @@ void OGROSMDataSource::LookupNodesCustomCompressedCase()
                         COMPRESS_SIZE_FROM_BYTE(psBucket->u.panSectorSize[k]);
             }
 
-            VSIFSeekL(m_fpNodes, psBucket->nOff + nOffFromBucketStart,
-                      SEEK_SET);
-            if (nSectorSize == SECTOR_SIZE)
+            const GIntBig nSectorOffset = psBucket->nOff + nOffFromBucketStart;
+            GByte *pabyDst =
+                nSectorSize == SECTOR_SIZE ? m_pabySector : abyRawSector;
+            if (m_pabyNodesData)
             {
-                if (VSIFReadL(m_pabySector, 1, static_cast<size_t>(SECTOR_SIZE),
-                              m_fpNodes) != static_cast<size_t>(SECTOR_SIZE))
+                if (nSectorOffset + nSectorSize > m_nNodesDataSize)
                 {
                     CPLError(CE_Failure, CPLE_AppDefined,
-                             "Cannot read node " CPL_FRMT_GIB, id);
+                             "Cannot read sector for node " CPL_FRMT_GIB, id);
                     continue;
-                    // FIXME ?
                 }
+                memcpy(pabyDst, m_pabyNodesData + nSectorOffset, nSectorSize);
             }
             else
             {
-                if (static_cast<int>(VSIFReadL(abyRawSector, 1, nSectorSize,
+                VSIFSeekL(m_fpNodes, nSectorOffset, SEEK_SET);
+                if (static_cast<int>(VSIFReadL(pabyDst, 1, nSectorSize,
                                                m_fpNodes)) != nSectorSize)
                 {
                     CPLError(CE_Failure, CPLE_AppDefined,
@@ -1162,6 +1228,9 @@ void OGROSMDataSource::LookupNodesCustomCompressedCase()
                     continue;
                     // FIXME ?
                 }
+            }
+            if (nSectorSize != SECTOR_SIZE)
+            {
                 abyRawSector[nSectorSize] = 0;
 
                 if (!DecompressSector(abyRawSector, nSectorSize, m_pabySector))
@@ -1265,6 +1334,26 @@ void OGROSMDataSource::LookupNodesCustomNonCompressedCase()
         }
 
         const GIntBig nNewOffset = psBucket->nOff + nSector * SECTOR_SIZE;
+        if (m_pabyNodesData)
+        {
+            const GIntBig nNodeOffset =
+                nNewOffset + nOffInBucketReducedRemainder * sizeof(LonLat);
+            if (nNodeOffset + static_cast<GIntBig>(sizeof(LonLat)) >
+                m_nNodesDataSize)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Cannot read node " CPL_FRMT_GIB, id);
+                continue;
+            }
+            memcpy(&m_pasLonLatArray[j], m_pabyNodesData + nNodeOffset,
+                   sizeof(LonLat));
+
+            m_panReqIds[j] = id;
+            if (m_pasLonLatArray[j].nLon || m_pasLonLatArray[j].nLat)
+                j++;
+            continue;
+        }
+
         if (nNewOffset - nOldOffset >= knDISK_SECTOR_SIZE)
         {
             // Align on 4096 boundary to be glibc caching friendly
@@ -1558,28 +1647,15 @@ void OGROSMDataSource::UncompressWay(int nBytes, const GByte *pabyCompressedWay,
 /*                              IndexWay()                              */
 /************************************************************************/
 
-void OGROSMDataSource::IndexWay(GIntBig nWayID, bool bIsArea,
-                                unsigned int nTags, IndexedKVP *pasTags,
-                                LonLat *pasLonLatPairs, int nPairs,
-                                OSMInfo *psInfo)
+void OGROSMDataSource::IndexWay(GIntBig nWayID,
+                                const std::vector<GByte> &abyCompressedWay)
 {
     if (!m_bIndexWays)
         return;
 
     sqlite3_bind_int64(m_hInsertWayStmt, 1, nWayID);
-
-    const unsigned nTagsClamped = std::min(nTags, MAX_COUNT_FOR_TAGS_IN_WAY);
-    if (nTagsClamped < nTags)
-    {
-        CPLDebug("OSM",
-                 "Too many tags for way " CPL_FRMT_GIB ": %u. "
-                 "Clamping to %u",
-                 nWayID, nTags, nTagsClamped);
-    }
-    CompressWay(bIsArea, nTagsClamped, pasTags, nPairs, pasLonLatPairs, psInfo,
-                m_abyWayBuffer);
-    sqlite3_bind_blob(m_hInsertWayStmt, 2, m_abyWayBuffer.data(),
-                      static_cast<int>(m_abyWayBuffer.size()), SQLITE_STATIC);
+    sqlite3_bind_blob(m_hInsertWayStmt, 2, abyCompressedWay.data(),
+                      static_cast<int>(abyCompressedWay.size()), SQLITE_STATIC);
 
     int rc = sqlite3_step(m_hInsertWayStmt);
     sqlite3_reset(m_hInsertWayStmt);
@@ -1595,7 +1671,7 @@ void OGROSMDataSource::IndexWay(GIntBig nWayID, bool bIsArea,
 /*                              FindNode()                              */
 /************************************************************************/
 
-int OGROSMDataSource::FindNode(GIntBig nID)
+int OGROSMDataSource::FindNode(GIntBig nID) const
 {
     if (m_nReqIds == 0)
         return -1;
@@ -1615,139 +1691,234 @@ int OGROSMDataSource::FindNode(GIntBig nID)
 }
 
 /************************************************************************/
-/*                         ProcessWaysBatch()                           */
+/*                             ResolveWay()                             */
 /************************************************************************/
 
-void OGROSMDataSource::ProcessWaysBatch()
+// Computes the coordinates of the iPair-th way of the current batch from the
+// looked up nodes, its compressed form if ways are indexed, and the geometry
+// of its feature. Only data specific to that way is modified, so this can
+// run concurrently for different ways.
+void OGROSMDataSource::ResolveWay(int iPair, bool bIndexAreaTags)
 {
-    if (m_nWayFeaturePairs == 0)
-        return;
+    WayFeaturePair *psWayFeaturePairs = &m_pasWayFeaturePairs[iPair];
+    std::vector<LonLat> &asLonLat = m_aasWayLonLats[iPair];
+    asLonLat.clear();
 
-    // printf("nodes = %d, features = %d\n", nUnsortedReqIds, nWayFeaturePairs);
-    LookupNodes();
-
-    for (int iPair = 0; iPair < m_nWayFeaturePairs; iPair++)
-    {
-        WayFeaturePair *psWayFeaturePairs = &m_pasWayFeaturePairs[iPair];
-
-        const bool bIsArea = psWayFeaturePairs->bIsArea;
-        m_asLonLatCache.clear();
+    const bool bIsArea = psWayFeaturePairs->bIsArea;
 
 #ifdef ENABLE_NODE_LOOKUP_BY_HASHING
-        if (m_bHashedIndexValid)
+    if (m_bHashedIndexValid)
+    {
+        for (unsigned int i = 0; i < psWayFeaturePairs->nRefs; i++)
         {
-            for (unsigned int i = 0; i < psWayFeaturePairs->nRefs; i++)
+            int nIndInHashArray = static_cast<int>(
+                HASH_ID_FUNC(psWayFeaturePairs->panNodeRefs[i]) %
+                HASHED_INDEXES_ARRAY_SIZE);
+            int nIdx = m_panHashedIndexes[nIndInHashArray];
+            if (nIdx < -1)
             {
-                int nIndInHashArray = static_cast<int>(
-                    HASH_ID_FUNC(psWayFeaturePairs->panNodeRefs[i]) %
-                    HASHED_INDEXES_ARRAY_SIZE);
-                int nIdx = m_panHashedIndexes[nIndInHashArray];
-                if (nIdx < -1)
+                int iBucket = -nIdx - 2;
+                while (true)
                 {
-                    int iBucket = -nIdx - 2;
-                    while (true)
+                    nIdx = m_psCollisionBuckets[iBucket].nInd;
+                    if (m_panReqIds[nIdx] == psWayFeaturePairs->panNodeRefs[i])
+                        break;
+                    iBucket = m_psCollisionBuckets[iBucket].nNext;
+                    if (iBucket < 0)
                     {
-                        nIdx = m_psCollisionBuckets[iBucket].nInd;
-                        if (m_panReqIds[nIdx] ==
-                            psWayFeaturePairs->panNodeRefs[i])
-                            break;
-                        iBucket = m_psCollisionBuckets[iBucket].nNext;
-                        if (iBucket < 0)
-                        {
-                            nIdx = -1;
-                            break;
-                        }
+                        nIdx = -1;
+                        break;
                     }
                 }
-                else if (nIdx >= 0 &&
-                         m_panReqIds[nIdx] != psWayFeaturePairs->panNodeRefs[i])
-                    nIdx = -1;
+            }
+            else if (nIdx >= 0 &&
+                     m_panReqIds[nIdx] != psWayFeaturePairs->panNodeRefs[i])
+                nIdx = -1;
 
-                if (nIdx >= 0)
-                {
-                    m_asLonLatCache.push_back(m_pasLonLatArray[nIdx]);
-                }
+            if (nIdx >= 0)
+            {
+                asLonLat.push_back(m_pasLonLatArray[nIdx]);
             }
         }
-        else
+    }
+    else
 #endif  // ENABLE_NODE_LOOKUP_BY_HASHING
+    {
+        int nIdx = -1;
+        for (unsigned int i = 0; i < psWayFeaturePairs->nRefs; i++)
         {
-            int nIdx = -1;
-            for (unsigned int i = 0; i < psWayFeaturePairs->nRefs; i++)
+            if (nIdx >= 0 && psWayFeaturePairs->panNodeRefs[i] ==
+                                 psWayFeaturePairs->panNodeRefs[i - 1] + 1)
             {
-                if (nIdx >= 0 && psWayFeaturePairs->panNodeRefs[i] ==
-                                     psWayFeaturePairs->panNodeRefs[i - 1] + 1)
-                {
-                    if (nIdx + 1 < (int)m_nReqIds &&
-                        m_panReqIds[nIdx + 1] ==
-                            psWayFeaturePairs->panNodeRefs[i])
-                        nIdx++;
-                    else
-                        nIdx = -1;
-                }
+                if (nIdx + 1 < (int)m_nReqIds &&
+                    m_panReqIds[nIdx + 1] == psWayFeaturePairs->panNodeRefs[i])
+                    nIdx++;
                 else
-                    nIdx = FindNode(psWayFeaturePairs->panNodeRefs[i]);
-                if (nIdx >= 0)
-                {
-                    m_asLonLatCache.push_back(m_pasLonLatArray[nIdx]);
-                }
+                    nIdx = -1;
+            }
+            else
+                nIdx = FindNode(psWayFeaturePairs->panNodeRefs[i]);
+            if (nIdx >= 0)
+            {
+                asLonLat.push_back(m_pasLonLatArray[nIdx]);
             }
         }
+    }
 
-        if (!m_asLonLatCache.empty() && bIsArea)
+    if (!asLonLat.empty() && bIsArea)
+    {
+        asLonLat.push_back(asLonLat[0]);
+    }
+
+    if (asLonLat.size() < 2)
+        return;
+
+    if (m_bIndexWays)
+    {
+        if (bIsArea && bIndexAreaTags)
         {
-            m_asLonLatCache.push_back(m_asLonLatCache[0]);
+            const unsigned nTagsClamped =
+                std::min(psWayFeaturePairs->nTags, MAX_COUNT_FOR_TAGS_IN_WAY);
+            if (nTagsClamped < psWayFeaturePairs->nTags)
+            {
+                CPLDebug("OSM",
+                         "Too many tags for way " CPL_FRMT_GIB ": %u. "
+                         "Clamping to %u",
+                         psWayFeaturePairs->nWayID, psWayFeaturePairs->nTags,
+                         nTagsClamped);
+            }
+            CompressWay(/*bIsArea = */ true, nTagsClamped,
+                        psWayFeaturePairs->pasTags,
+                        static_cast<int>(asLonLat.size()), asLonLat.data(),
+                        &psWayFeaturePairs->sInfo,
+                        m_aabyCompressedWays[iPair]);
         }
+        else
+        {
+            CompressWay(bIsArea, 0, nullptr, static_cast<int>(asLonLat.size()),
+                        asLonLat.data(), nullptr, m_aabyCompressedWays[iPair]);
+        }
+    }
+
+    if (psWayFeaturePairs->poFeature == nullptr)
+        return;
+
+    OGRLineString *poLS = new OGRLineString();
+    const int nPoints = static_cast<int>(asLonLat.size());
+    poLS->setNumPoints(nPoints);
+    for (int i = 0; i < nPoints; i++)
+    {
+        poLS->setPoint(i, INT_TO_DBL(asLonLat[i].nLon),
+                       INT_TO_DBL(asLonLat[i].nLat));
+    }
+
+    psWayFeaturePairs->poFeature->SetGeometryDirectly(poLS);
+}
+
+/************************************************************************/
+/*                         ProcessWaysBatch()                           */
+/************************************************************************/
 
-        if (m_asLonLatCache.size() < 2)
+void OGROSMDataSource::ProcessWaysBatch()
+{
+    if (m_nWayFeaturePairs == 0)
+        return;
+
+    // printf("nodes = %d, features = %d\n", nUnsortedReqIds, nWayFeaturePairs);
+    LookupNodes();
+
+    // Resolve node coordinates, compress ways and build geometries in
+    // parallel, as this only depends on the looked up nodes. Writing to the
+    // temporary database and to the layers is done afterwards, in order.
+    const bool bIndexAreaTags =
+        m_papoLayers[IDX_LYR_MULTIPOLYGONS]->IsUserInterested();
+    const int nPairs = m_nWayFeaturePairs;
+    if (static_cast<int>(m_aasWayLonLats.size()) < nPairs)
+        m_aasWayLonLats.resize(nPairs);
+    if (m_bIndexWays && static_cast<int>(m_aabyCompressedWays.size()) < nPairs)
+        m_aabyCompressedWays.resize(nPairs);
+
+    const auto ResolveWays = [this, bIndexAreaTags](int iStart, int iEnd)
+    {
+        for (int iPair = iStart; iPair < iEnd; ++iPair)
+            ResolveWay(iPair, bIndexAreaTags);
+    };
+
+    constexpr int MIN_WAYS_PER_THREAD = 5000;
+    CPLWorkerThreadPool *poPool = nullptr;
+    if (m_nNumThreads > 1 && nPairs >= 2 * MIN_WAYS_PER_THREAD)
+    {
+        const int nThreads =
+            std::min(m_nNumThreads, nPairs / MIN_WAYS_PER_THREAD);
+        poPool = GDALGetGlobalThreadPool(nThreads);
+    }
+
+    if (poPool == nullptr)
+    {
+        ResolveWays(0, nPairs);
+    }
+    else
+    {
+        struct JobData
+        {
+            const decltype(ResolveWays) *pfnChunk;
+            int nStart;
+            int nEnd;
+        };
+
+        const int nThreadCount = poPool->GetThreadCount();
+        const int nChunkSize = (nPairs + nThreadCount - 1) / nThreadCount;
+        std::vector<JobData> asJobs;
+        for (int nStart = 0; nStart < nPairs; nStart += nChunkSize)
+            asJobs.push_back(
+                {&ResolveWays, nStart, std::min(nPairs, nStart + nChunkSize)});
+
+        auto poQueue = poPool->CreateJobQueue();
+        for (auto &sJob : asJobs)
+        {
+            poQueue->SubmitJob(
+                [](void *pData)
+                {
+                    const auto psJob = static_cast<const JobData *>(pData);
+                    (*psJob->pfnChunk)(psJob->nStart, psJob->nEnd);
+                },
+                &sJob);
+        }
+        poQueue->WaitCompletion();
+    }
+
+    for (int iPair = 0; iPair < nPairs; iPair++)
+    {
+        WayFeaturePair *psWayFeaturePairs = &m_pasWayFeaturePairs[iPair];
+        const std::vector<LonLat> &asLonLat = m_aasWayLonLats[iPair];
+
+        if (asLonLat.size() < 2)
         {
             CPLDebug("OSM",
                      "Way " CPL_FRMT_GIB
                      " with %d nodes that could be found. Discarding it",
                      psWayFeaturePairs->nWayID,
-                     static_cast<int>(m_asLonLatCache.size()));
+                     static_cast<int>(asLonLat.size()));
             delete psWayFeaturePairs->poFeature;
             psWayFeaturePairs->poFeature = nullptr;
             psWayFeaturePairs->bIsArea = false;
             continue;
         }
 
-        if (bIsArea && m_papoLayers[IDX_LYR_MULTIPOLYGONS]->IsUserInterested())
-        {
-            IndexWay(psWayFeaturePairs->nWayID, /*bIsArea = */ true,
-                     psWayFeaturePairs->nTags, psWayFeaturePairs->pasTags,
-                     m_asLonLatCache.data(),
-                     static_cast<int>(m_asLonLatCache.size()),
-                     &psWayFeaturePairs->sInfo);
-        }
-        else
-            IndexWay(psWayFeaturePairs->nWayID, bIsArea, 0, nullptr,
-                     m_asLonLatCache.data(),
-                     static_cast<int>(m_asLonLatCache.size()), nullptr);
+        if (m_bIndexWays)
+            IndexWay(psWayFeaturePairs->nWayID, m_aabyCompressedWays[iPair]);
 
         if (psWayFeaturePairs->poFeature == nullptr)
         {
             continue;
         }
 
-        OGRLineString *poLS = new OGRLineString();
-        OGRGeometry *poGeom = poLS;
-
-        const int nPoints = static_cast<int>(m_asLonLatCache.size());
-        poLS->setNumPoints(nPoints);
-        for (int i = 0; i < nPoints; i++)
-        {
-            poLS->setPoint(i, INT_TO_DBL(m_asLonLatCache[i].nLon),
-                           INT_TO_DBL(m_asLonLatCache[i].nLat));
-        }
-
-        psWayFeaturePairs->poFeature->SetGeometryDirectly(poGeom);
-
-        if (m_asLonLatCache.size() != psWayFeaturePairs->nRefs)
+        if (asLonLat.size() != psWayFeaturePairs->nRefs)
             CPLDebug(
                 "OSM",
                 "For way " CPL_FRMT_GIB ", got only %d nodes instead of %d",
-                psWayFeaturePairs->nWayID, nPoints, psWayFeaturePairs->nRefs);
+                psWayFeaturePairs->nWayID, static_cast<int>(asLonLat.size()),
+                psWayFeaturePairs->nRefs);
 
         int bFilteredOut = FALSE;
         if (!m_papoLayers[IDX_LYR_LINES]->AddFeature(
@@ -2765,6 +2936,14 @@ int OGROSMDataSource::Open(const char *pszFilename, char **papszOpenOptionsIn)
     m_bUseWaysIndex =
         CPLTestBool(CPLGetConfigOption("OSM_USE_WAYS_INDEX", "YES"));
 
+    // Same default as the PBF parser for its decompression threads
+    const char *pszNumThreads =
+        CPLGetConfigOption("GDAL_NUM_THREADS", "ALL_CPUS");
+    m_nNumThreads = CPLGetNumCPUs();
+    if (!EQUAL(pszNumThreads, "ALL_CPUS"))
+        m_nNumThreads =
+            std::max(1, std::min(m_nNumThreads, atoi(pszNumThreads)));
+
     m_bCustomIndexing = CPLTestBool(CSLFetchNameValueDef(
         papszOpenOptionsIn, "USE_CUSTOM_INDEXING",
         CPLGetConfigOption("OSM_USE_CUSTOM_INDEXING", "YES")));
@@ -3851,6 +4030,7 @@ int OGROSMDataSource::MyResetReading()
         m_nBucketOld = -1;
         m_nOffInBucketReducedOld = -1;
 
+        ReleaseNodesFileView();
         VSIFSeekL(m_fpNodes, 0, SEEK_SET);
         VSIFTruncateL(m_fpNodes, 0);
         m_nNodesFileSize = 0;
@@ -4066,6 +4246,7 @@ bool OGROSMDataSource::TransferToDiskIfNecesserary()
         {
             m_bInMemoryNodesFile = false;
 
+            ReleaseNodesFileView();
             VSIFCloseL(m_fpNodes);
             m_fpNodes = nullptr;
 
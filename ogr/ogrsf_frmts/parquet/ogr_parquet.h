@@ -31,6 +31,8 @@
 
 #include "ogrsf_frmts.h"
 
+#include "cpl_worker_thread_pool.h"
+
 #include <functional>
 #include <map>
 
@@ -253,6 +255,12 @@ class OGRParquetWriterLayer final : public OGRArrowWriterLayer
     bool m_bEdgesSpherical = false;
     parquet::WriterProperties::Builder m_oWriterPropertiesBuilder{};
 
+    // Temporary GeoPackage where features are stored when SORT_BY_BBOX=YES
+    bool m_bSortByBBOX = false;
+    std::string m_osTmpGPKG{};
+    std::unique_ptr<GDALDataset> m_poTmpGPKG{};
+    OGRLayer *m_poTmpGPKGLayer = nullptr;
+
     virtual bool IsFileWriterCreated() const override
     {
         return m_poFileWriter != nullptr;
@@ -283,6 +291,12 @@ class OGRParquetWriterLayer final : public OGRArrowWriterLayer
 
     std::string GetGeoMetadata() const;
 
+    bool CreateTmpGPKGLayer();
+    bool CopyTmpGpkgLayerToFinalFile();
+
+  protected:
+    OGRErr ICreateFeature(OGRFeature *poFeature) override;
+
   public:
     OGRParquetWriterLayer(
         OGRParquetWriterDataset *poDS, arrow::MemoryPool *poMemoryPool,
@@ -326,6 +340,9 @@ class OGRParquetWriterLayer final : public OGRArrowWriterLayer
     bool IsArrowSchemaSupported(const struct ArrowSchema *schema,
                                 CSLConstList papszOptions,
                                 std::string &osErrorMsg) const override;
+    bool
+    CreateFieldFromArrowSchema(const struct ArrowSchema *schema,
+                               CSLConstList papszOptions = nullptr) override;
     bool WriteArrowBatch(const struct ArrowSchema *schema,
                          struct ArrowArray *array,
                          CSLConstList papszOptions = nullptr) override;
@@ -373,4 +390,122 @@ class OGRParquetWriterDataset final : public GDALPamDataset
                            char **papszOptions = nullptr) override;
 };
 
+/************************************************************************/
+/*                  OGRParquetPartitionedWriterLayer                    */
+/************************************************************************/
+
+class OGRParquetPartitionedWriterDataset;
+
+// Dispatches features to one Parquet file per value of a field, in a
+// Hive-style directory hierarchy (<dir>/<field>=<value>/part-<n>.parquet)
+class OGRParquetPartitionedWriterLayer final : public OGRLayer
+{
+    OGRParquetPartitionedWriterLayer(const OGRParquetPartitionedWriterLayer &) =
+        delete;
+    OGRParquetPartitionedWriterLayer &
+    operator=(const OGRParquetPartitionedWriterLayer &) = delete;
+
+    struct Partition
+    {
+        std::string osDirectory{};
+        int nNextFileIdx = 0;
+        std::unique_ptr<OGRParquetWriterDataset> poDS{};
+        OGRLayer *poLayer = nullptr;
+        uint64_t nLastUse = 0;
+    };
+
+    OGRParquetPartitionedWriterDataset *m_poDS = nullptr;
+    OGRFeatureDefn *m_poFeatureDefn = nullptr;
+    CPLStringList m_aosLayerOptions{};
+    std::string m_osFIDColumn{};
+    std::string m_osPartitionField{};
+    int m_iPartitionField = -1;
+    int m_nMaxOpenFiles = 0;
+    uint64_t m_nMaxMemory = 0;
+    std::map<std::string, Partition> m_oMapPartitions{};
+    int m_nOpenFiles = 0;
+    uint64_t m_nUseCounter = 0;
+    GIntBig m_nFeatureCount = 0;
+    bool m_bSchemaFrozen = false;
+    std::unique_ptr<CPLJobQueue> m_poCloseQueue{};
+    int m_nCloseThreads = 0;
+
+    bool OpenPartitionFile(Partition &oPartition);
+    void ClosePartitionFile(Partition &oPartition);
+    void CloseLeastRecentlyUsedFile();
+    uint64_t GetUsedMemory() const;
+
+  protected:
+    OGRErr ICreateFeature(OGRFeature *poFeature) override;
+
+  public:
+    OGRParquetPartitionedWriterLayer(OGRParquetPartitionedWriterDataset *poDS,
+                                     const char *pszLayerName,
+                                     const OGRSpatialReference *poSpatialRef,
+                                     OGRwkbGeometryType eGType,
+                                     CSLConstList papszOptions);
+    ~OGRParquetPartitionedWriterLayer() override;
+
+    const char *GetFIDColumn() override
+    {
+        return m_osFIDColumn.c_str();
+    }
+    OGRFeatureDefn *GetLayerDefn() override
+    {
+        return m_poFeatureDefn;
+    }
+    void ResetReading() override
+    {
+    }
+    OGRFeature *GetNextFeature() override
+    {
+        return nullptr;
+    }
+    GIntBig GetFeatureCount(int bForce) override;
+    int TestCapability(const char *pszCap) override;
+    OGRErr CreateField(const OGRFieldDefn *poField,
+                       int bApproxOK = TRUE) override;
+    OGRErr CreateGeomField(const OGRGeomFieldDefn *poField,
+                           int bApproxOK = TRUE) override;
+    GDALDataset *GetDataset() override;
+};
+
+/************************************************************************/
+/*                 OGRParquetPartitionedWriterDataset                   */
+/************************************************************************/
+
+class OGRParquetPartitionedWriterDataset final : public GDALPamDataset
+{
+    std::unique_ptr<OGRParquetPartitionedWriterLayer> m_poLayer{};
+    CPLStringList m_aosCreationOptions{};
+
+  public:
+    OGRParquetPartitionedWriterDataset(const char *pszDirectory,
+                                       CSLConstList papszOptions);
+
+    int GetLayerCount() override;
+    OGRLayer *GetLayer(int idx) override;
+    int TestCapability(const char *pszCap) override;
+    bool AddFieldDomain(std::unique_ptr<OGRFieldDomain> &&domain,
+                        std::string &failureReason) override;
+
+    const std::map<std::string, std::unique_ptr<OGRFieldDomain>> &
+    GetFieldDomains() const
+    {
+        return m_oMapFieldDomains;
+    }
+
+    const char *GetCreationOption(const char *pszKey,
+                                  const char *pszDefault) const
+    {
+        return m_aosCreationOptions.FetchNameValueDef(pszKey, pszDefault);
+    }
+
+  protected:
+    OGRLayer *ICreateLayer(const char *pszName,
+                           const OGRSpatialReference *poSpatialRef = nullptr,
+                           OGRwkbGeometryType eGType = wkbUnknown,
+                           char **papszOptions = nullptr) override;
+};
+
 #endif  // OGR_PARQUET_H
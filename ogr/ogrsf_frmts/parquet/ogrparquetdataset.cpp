@@ -69,6 +69,7 @@ OGRLayer *OGRParquetDataset::ExecuteSQL(const char *pszSQLCommand,
          */
         if (oSelect.join_count == 0 && oSelect.poOtherSelect == nullptr &&
             oSelect.table_count == 1 && oSelect.order_specs == 0 &&
+            oSelect.group_defs.empty() &&
             oSelect.query_mode != SWQM_DISTINCT_LIST &&
             oSelect.where_expr == nullptr &&
             CPLTestBool(
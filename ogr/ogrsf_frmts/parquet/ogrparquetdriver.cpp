@@ -551,11 +551,32 @@ static GDALDataset *OGRParquetDriverOpen(GDALOpenInfo *poOpenInfo)
 static GDALDataset *OGRParquetDriverCreate(const char *pszName, int nXSize,
                                            int nYSize, int nBands,
                                            GDALDataType eType,
-                                           char ** /* papszOptions */)
+                                           char **papszOptions)
 {
     if (!(nXSize == 0 && nYSize == 0 && nBands == 0 && eType == GDT_Unknown))
         return nullptr;
 
+    if (CSLFetchNameValue(papszOptions, "PARTITION_BY"))
+    {
+        VSIStatBufL sStat;
+        if (VSIStatL(pszName, &sStat) == 0)
+        {
+            if (!VSI_ISDIR(sStat.st_mode))
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "%s exists and is not a directory", pszName);
+                return nullptr;
+            }
+        }
+        else if (VSIMkdir(pszName, 0755) != 0)
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot create directory %s",
+                     pszName);
+            return nullptr;
+        }
+        return new OGRParquetPartitionedWriterDataset(pszName, papszOptions);
+    }
+
     try
     {
         std::shared_ptr<arrow::io::OutputStream> out_file;
@@ -730,6 +751,16 @@ void OGRParquetDriver::InitMetadata()
         CPLCreateXMLElementAndValue(psOption, "Value", "SPHERICAL");
     }
 
+    {
+        auto psOption = CPLCreateXMLNode(oTree.get(), CXT_Element, "Option");
+        CPLAddXMLAttributeAndValue(psOption, "name", "SORT_BY_BBOX");
+        CPLAddXMLAttributeAndValue(psOption, "type", "boolean");
+        CPLAddXMLAttributeAndValue(psOption, "description",
+                                   "Whether features should be sorted based "
+                                   "on the bounding box of their geometries");
+        CPLAddXMLAttributeAndValue(psOption, "default", "NO");
+    }
+
     {
         auto psOption = CPLCreateXMLNode(oTree.get(), CXT_Element, "Option");
         CPLAddXMLAttributeAndValue(psOption, "name", "CREATOR");
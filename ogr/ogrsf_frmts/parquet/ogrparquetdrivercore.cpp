@@ -121,6 +121,19 @@ void OGRParquetDriverSetCommonMetadata(GDALDriver *poDriver)
         "(e.g EPSG:4326), of geometry column(s)'/>"
         "</OpenOptionList>");
 
+    poDriver->SetMetadataItem(
+        GDAL_DMD_CREATIONOPTIONLIST,
+        "<CreationOptionList>"
+        "  <Option name='PARTITION_BY' type='string' description='Name of "
+        "the field whose values are used to split features into a "
+        "Hive-style partitioned directory'/>"
+        "  <Option name='MAX_OPEN_FILES' type='int' description='Maximum "
+        "number of partition files open at the same time' default='64'/>"
+        "  <Option name='MAX_MEMORY' type='int' description='Maximum memory, "
+        "in MB, used to buffer rows of the open partition files' "
+        "default='1024'/>"
+        "</CreationOptionList>");
+
     poDriver->pfnIdentify = OGRParquetDriverIdentify;
     poDriver->SetMetadataItem(GDAL_DCAP_OPEN, "YES");
     poDriver->SetMetadataItem(GDAL_DCAP_CREATE, "YES");
@@ -1030,6 +1030,327 @@ static IsConstraintPossibleRes IsConstraintPossible(int nOperation, T v, T min,
     return IsConstraintPossibleRes::YES;
 }
 
+/************************************************************************/
+/*                  IsConstraintPossibleForRowGroup()                   */
+/************************************************************************/
+
+// Checks a constraint against the statistics of a row group.
+static IsConstraintPossibleRes
+IsConstraintPossibleForRowGroup(OGRParquetLayer *poLayer,
+                                const OGRArrowLayer::Constraint &constraint,
+                                int iRowGroup, int64_t nFeatureIdx)
+{
+    OGRFeatureDefn *poFeatureDefn = poLayer->GetLayerDefn();
+    const auto metadata = poLayer->GetReader()->parquet_reader()->metadata();
+    const auto nRowGroupRows = metadata->RowGroup(iRowGroup)->num_rows();
+
+    OGRField sMin;
+    OGRField sMax;
+    OGR_RawField_SetNull(&sMin);
+    OGR_RawField_SetNull(&sMax);
+    bool bFoundMin = false;
+    bool bFoundMax = false;
+    OGRFieldType eType = OFTMaxType;
+    OGRFieldSubType eSubType = OFSTNone;
+    std::string osMinTmp, osMaxTmp;
+
+    int iOGRField = constraint.iField;
+    if (constraint.iField == poFeatureDefn->GetFieldCount() + SPF_FID)
+    {
+        iOGRField = OGRParquetLayer::OGR_FID_INDEX;
+    }
+    if (constraint.nOperation != SWQ_ISNULL &&
+        constraint.nOperation != SWQ_ISNOTNULL)
+    {
+        if (iOGRField == OGRParquetLayer::OGR_FID_INDEX &&
+            poLayer->GetFIDParquetColumn() < 0)
+        {
+            sMin.Integer64 = nFeatureIdx;
+            sMax.Integer64 = nFeatureIdx + nRowGroupRows - 1;
+            eType = OFTInteger64;
+        }
+        else if (!poLayer->GetMinMaxForField(
+                     iRowGroup, iOGRField, true, sMin, bFoundMin, true, sMax,
+                     bFoundMax, eType, eSubType, osMinTmp, osMaxTmp) ||
+                 !bFoundMin || !bFoundMax)
+        {
+            return IsConstraintPossibleRes::UNKNOWN;
+        }
+    }
+
+    IsConstraintPossibleRes res = IsConstraintPossibleRes::UNKNOWN;
+    if (constraint.eType == OGRArrowLayer::Constraint::Type::Integer &&
+        eType == OFTInteger)
+    {
+        res = IsConstraintPossible(constraint.nOperation,
+                                   constraint.sValue.Integer, sMin.Integer,
+                                   sMax.Integer);
+    }
+    else if (constraint.eType == OGRArrowLayer::Constraint::Type::Integer64 &&
+             eType == OFTInteger64)
+    {
+        res = IsConstraintPossible(constraint.nOperation,
+                                   constraint.sValue.Integer64, sMin.Integer64,
+                                   sMax.Integer64);
+    }
+    else if (constraint.eType == OGRArrowLayer::Constraint::Type::Real &&
+             eType == OFTReal)
+    {
+        res = IsConstraintPossible(constraint.nOperation,
+                                   constraint.sValue.Real, sMin.Real,
+                                   sMax.Real);
+    }
+    else if (constraint.eType == OGRArrowLayer::Constraint::Type::String &&
+             eType == OFTString)
+    {
+        res = IsConstraintPossible(constraint.nOperation,
+                                   std::string(constraint.sValue.String),
+                                   std::string(sMin.String),
+                                   std::string(sMax.String));
+    }
+    else if (constraint.nOperation == SWQ_ISNULL ||
+             constraint.nOperation == SWQ_ISNOTNULL)
+    {
+        const int iCol =
+            iOGRField == OGRParquetLayer::OGR_FID_INDEX
+                ? poLayer->GetFIDParquetColumn()
+                : poLayer->GetMapFieldIndexToParquetColumn()[iOGRField];
+        if (iCol >= 0)
+        {
+            const auto rowGroupColumnChunk =
+                metadata->RowGroup(iRowGroup)->ColumnChunk(iCol);
+            const auto rowGroupStats = rowGroupColumnChunk->statistics();
+            if (rowGroupColumnChunk->is_stats_set() && rowGroupStats)
+            {
+                res = IsConstraintPossibleRes::YES;
+                if (constraint.nOperation == SWQ_ISNULL &&
+                    rowGroupStats->num_values() == nRowGroupRows)
+                {
+                    res = IsConstraintPossibleRes::NO;
+                }
+                else if (constraint.nOperation == SWQ_ISNOTNULL &&
+                         rowGroupStats->num_values() == 0)
+                {
+                    res = IsConstraintPossibleRes::NO;
+                }
+            }
+        }
+    }
+    else
+    {
+        CPLDebug("PARQUET",
+                 "Unhandled combination of constraint.eType "
+                 "(%d) and eType (%d)",
+                 static_cast<int>(constraint.eType), eType);
+    }
+    return res;
+}
+
+/************************************************************************/
+/*                     IsExprPossibleForRowGroup()                      */
+/************************************************************************/
+
+// Checks an attribute filter expression against the statistics of a row
+// group. Only a NO result is meaningful: YES and UNKNOWN mean that the row
+// group must be read.
+static IsConstraintPossibleRes
+IsExprPossibleForRowGroup(OGRParquetLayer *poLayer,
+                          const swq_expr_node *poNode, int iRowGroup,
+                          int64_t nFeatureIdx)
+{
+    if (poNode->eNodeType != SNT_OPERATION)
+        return IsConstraintPossibleRes::UNKNOWN;
+
+    OGRFeatureDefn *poFeatureDefn = poLayer->GetLayerDefn();
+    const auto GetFieldDefn =
+        [poLayer, poFeatureDefn](const swq_expr_node *poColumn,
+                                 OGRFieldDefn &oDummyFIDFieldDefn)
+        -> const OGRFieldDefn *
+    {
+        if (poColumn->eNodeType != SNT_COLUMN)
+            return nullptr;
+        if (poColumn->field_index == poFeatureDefn->GetFieldCount() + SPF_FID)
+        {
+            oDummyFIDFieldDefn.SetName(poLayer->GetFIDColumn());
+            oDummyFIDFieldDefn.SetType(OFTInteger64);
+            return &oDummyFIDFieldDefn;
+        }
+        if (poColumn->field_index >= 0 &&
+            poColumn->field_index < poFeatureDefn->GetFieldCount())
+            return poFeatureDefn->GetFieldDefn(poColumn->field_index);
+        return nullptr;
+    };
+
+    const int nOp = poNode->nOperation;
+    if (nOp == SWQ_AND)
+    {
+        auto res = IsConstraintPossibleRes::YES;
+        for (int i = 0; i < poNode->nSubExprCount; ++i)
+        {
+            const auto resSub = IsExprPossibleForRowGroup(
+                poLayer, poNode->papoSubExpr[i], iRowGroup, nFeatureIdx);
+            if (resSub == IsConstraintPossibleRes::NO)
+                return resSub;
+            if (resSub == IsConstraintPossibleRes::UNKNOWN)
+                res = resSub;
+        }
+        return res;
+    }
+    else if (nOp == SWQ_OR)
+    {
+        auto res = IsConstraintPossibleRes::NO;
+        for (int i = 0; i < poNode->nSubExprCount; ++i)
+        {
+            const auto resSub = IsExprPossibleForRowGroup(
+                poLayer, poNode->papoSubExpr[i], iRowGroup, nFeatureIdx);
+            if (resSub == IsConstraintPossibleRes::YES)
+                return resSub;
+            if (resSub == IsConstraintPossibleRes::UNKNOWN)
+                res = resSub;
+        }
+        return res;
+    }
+    else if (IsComparisonOp(nOp) && poNode->nSubExprCount == 2)
+    {
+        const swq_expr_node *poColumn = GetColumnSubNode(poNode);
+        const swq_expr_node *poValue = GetConstantSubNode(poNode);
+        OGRFieldDefn oDummyFIDFieldDefn("", OFTInteger64);
+        const OGRFieldDefn *poFieldDefn =
+            poColumn ? GetFieldDefn(poColumn, oDummyFIDFieldDefn) : nullptr;
+        OGRArrowLayer::Constraint constraint;
+        if (poFieldDefn == nullptr || poValue == nullptr ||
+            poValue->is_null ||
+            !FillTargetValueFromSrcExpr(poFieldDefn, &constraint, poValue))
+        {
+            return IsConstraintPossibleRes::UNKNOWN;
+        }
+        constraint.iField = poColumn->field_index;
+        constraint.nOperation = nOp;
+        if (poColumn != poNode->papoSubExpr[0])
+        {
+            // "constant op column": reverse the operator
+            if (nOp == SWQ_LE)
+                constraint.nOperation = SWQ_GE;
+            else if (nOp == SWQ_LT)
+                constraint.nOperation = SWQ_GT;
+            else if (nOp == SWQ_GE)
+                constraint.nOperation = SWQ_LE;
+            else if (nOp == SWQ_GT)
+                constraint.nOperation = SWQ_LT;
+        }
+        return IsConstraintPossibleForRowGroup(poLayer, constraint, iRowGroup,
+                                               nFeatureIdx);
+    }
+    else if (nOp == SWQ_IN && poNode->nSubExprCount >= 2)
+    {
+        // Possible if at least one of the values is possible
+        const swq_expr_node *poColumn = poNode->papoSubExpr[0];
+        OGRFieldDefn oDummyFIDFieldDefn("", OFTInteger64);
+        const OGRFieldDefn *poFieldDefn =
+            GetFieldDefn(poColumn, oDummyFIDFieldDefn);
+        if (poFieldDefn == nullptr)
+            return IsConstraintPossibleRes::UNKNOWN;
+        auto res = IsConstraintPossibleRes::NO;
+        for (int i = 1; i < poNode->nSubExprCount; ++i)
+        {
+            const swq_expr_node *poValue = poNode->papoSubExpr[i];
+            OGRArrowLayer::Constraint constraint;
+            if (poValue->eNodeType != SNT_CONSTANT || poValue->is_null ||
+                !FillTargetValueFromSrcExpr(poFieldDefn, &constraint,
+                                            poValue))
+            {
+                return IsConstraintPossibleRes::UNKNOWN;
+            }
+            constraint.iField = poColumn->field_index;
+            constraint.nOperation = SWQ_EQ;
+            const auto resSub = IsConstraintPossibleForRowGroup(
+                poLayer, constraint, iRowGroup, nFeatureIdx);
+            if (resSub == IsConstraintPossibleRes::YES)
+                return resSub;
+            if (resSub == IsConstraintPossibleRes::UNKNOWN)
+                res = resSub;
+        }
+        return res;
+    }
+    else if (nOp == SWQ_LIKE && poNode->nSubExprCount == 2 &&
+             poNode->papoSubExpr[1]->eNodeType == SNT_CONSTANT &&
+             poNode->papoSubExpr[1]->field_type == SWQ_STRING &&
+             !CPLTestBool(CPLGetConfigOption("OGR_SQL_LIKE_AS_ILIKE", "NO")))
+    {
+        // col LIKE 'prefix%...': the row group is possible only if some
+        // string starting with the prefix is within [min, max]
+        const swq_expr_node *poColumn = poNode->papoSubExpr[0];
+        OGRFieldDefn oDummyFIDFieldDefn("", OFTInteger64);
+        const OGRFieldDefn *poFieldDefn =
+            GetFieldDefn(poColumn, oDummyFIDFieldDefn);
+        const char *pszPattern = poNode->papoSubExpr[1]->string_value;
+        if (poFieldDefn == nullptr || poFieldDefn->GetType() != OFTString ||
+            pszPattern == nullptr)
+        {
+            return IsConstraintPossibleRes::UNKNOWN;
+        }
+        const std::string osPrefix(pszPattern, strcspn(pszPattern, "%_"));
+        if (osPrefix.empty())
+            return IsConstraintPossibleRes::UNKNOWN;
+
+        OGRField sMin;
+        OGRField sMax;
+        bool bFoundMin = false;
+        bool bFoundMax = false;
+        OGRFieldType eType = OFTMaxType;
+        OGRFieldSubType eSubType = OFSTNone;
+        std::string osMinTmp, osMaxTmp;
+        if (!poLayer->GetMinMaxForField(iRowGroup, poColumn->field_index, true,
+                                        sMin, bFoundMin, true, sMax, bFoundMax,
+                                        eType, eSubType, osMinTmp, osMaxTmp) ||
+            !bFoundMin || !bFoundMax || eType != OFTString)
+        {
+            return IsConstraintPossibleRes::UNKNOWN;
+        }
+        if (std::string(sMax.String) < osPrefix ||
+            std::string(sMin.String).substr(0, osPrefix.size()) > osPrefix)
+        {
+            return IsConstraintPossibleRes::NO;
+        }
+        return IsConstraintPossibleRes::YES;
+    }
+    else if (nOp == SWQ_ISNULL && poNode->nSubExprCount == 1)
+    {
+        const swq_expr_node *poColumn = poNode->papoSubExpr[0];
+        if (poColumn->eNodeType != SNT_COLUMN ||
+            poColumn->field_index < 0 ||
+            poColumn->field_index >= poFeatureDefn->GetFieldCount())
+        {
+            return IsConstraintPossibleRes::UNKNOWN;
+        }
+        OGRArrowLayer::Constraint constraint;
+        constraint.iField = poColumn->field_index;
+        constraint.nOperation = SWQ_ISNULL;
+        return IsConstraintPossibleForRowGroup(poLayer, constraint, iRowGroup,
+                                               nFeatureIdx);
+    }
+    else if (nOp == SWQ_NOT && poNode->nSubExprCount == 1 &&
+             poNode->papoSubExpr[0]->eNodeType == SNT_OPERATION &&
+             poNode->papoSubExpr[0]->nOperation == SWQ_ISNULL &&
+             poNode->papoSubExpr[0]->nSubExprCount == 1)
+    {
+        const swq_expr_node *poColumn = poNode->papoSubExpr[0]->papoSubExpr[0];
+        if (poColumn->eNodeType != SNT_COLUMN ||
+            poColumn->field_index < 0 ||
+            poColumn->field_index >= poFeatureDefn->GetFieldCount())
+        {
+            return IsConstraintPossibleRes::UNKNOWN;
+        }
+        OGRArrowLayer::Constraint constraint;
+        constraint.iField = poColumn->field_index;
+        constraint.nOperation = SWQ_ISNOTNULL;
+        return IsConstraintPossibleForRowGroup(poLayer, constraint, iRowGroup,
+                                               nFeatureIdx);
+    }
+
+    return IsConstraintPossibleRes::UNKNOWN;
+}
+
 /************************************************************************/
 /*                           ReadNextBatch()                            */
 /************************************************************************/
@@ -1060,7 +1381,16 @@ bool OGRParquetLayer::ReadNextBatch()
              CPLTestBool(CPLGetConfigOption(
                  ("OGR_" + GetDriverUCName() + "_USE_BBOX").c_str(), "YES")));
 
-        if (m_asAttributeFilterConstraints.empty() && !bUSEBBOXFields)
+        // The constraints extracted by OGRArrowLayer only cover AND-ed
+        // comparisons. The whole expression is also evaluated against the
+        // statistics of each row group, for OR, IN and LIKE.
+        const bool bUseAttrQueryTree =
+            m_poAttrQuery != nullptr &&
+            CPLTestBool(CPLGetConfigOption(
+                "OGR_PARQUET_OPTIMIZED_ATTRIBUTE_FILTER", "YES"));
+
+        if (m_asAttributeFilterConstraints.empty() && !bUSEBBOXFields &&
+            !bUseAttrQueryTree)
         {
             bIterateEverything = true;
         }
@@ -1142,161 +1472,8 @@ bool OGRParquetLayer::ReadNextBatch()
                 {
                     for (auto &constraint : m_asAttributeFilterConstraints)
                     {
-                        int iOGRField = constraint.iField;
-                        if (constraint.iField ==
-                            m_poFeatureDefn->GetFieldCount() + SPF_FID)
-                        {
-                            iOGRField = OGR_FID_INDEX;
-                        }
-                        if (constraint.nOperation != SWQ_ISNULL &&
-                            constraint.nOperation != SWQ_ISNOTNULL)
-                        {
-                            if (iOGRField == OGR_FID_INDEX &&
-                                m_iFIDParquetColumn < 0)
-                            {
-                                sMin.Integer64 = nFeatureIdx;
-                                sMax.Integer64 =
-                                    nFeatureIdx +
-                                    poRowGroup->metadata()->num_rows() - 1;
-                                eType = OFTInteger64;
-                            }
-                            else if (!GetMinMaxForField(
-                                         iRowGroup, iOGRField, true, sMin,
-                                         bFoundMin, true, sMax, bFoundMax,
-                                         eType, eSubType, osMinTmp, osMaxTmp) ||
-                                     !bFoundMin || !bFoundMax)
-                            {
-                                bIterateEverything = true;
-                                break;
-                            }
-                        }
-
-                        IsConstraintPossibleRes res =
-                            IsConstraintPossibleRes::UNKNOWN;
-                        if (constraint.eType ==
-                                OGRArrowLayer::Constraint::Type::Integer &&
-                            eType == OFTInteger)
-                        {
-#if 0
-                            CPLDebug("PARQUET",
-                                     "Group %d, field %s, min = %d, max = %d",
-                                     iRowGroup,
-                                     iOGRField == OGR_FID_INDEX
-                                         ? m_osFIDColumn.c_str()
-                                         : m_poFeatureDefn->GetFieldDefn(iOGRField)
-                                               ->GetNameRef(),
-                                     sMin.Integer, sMax.Integer);
-#endif
-                            res = IsConstraintPossible(
-                                constraint.nOperation,
-                                constraint.sValue.Integer, sMin.Integer,
-                                sMax.Integer);
-                        }
-                        else if (constraint.eType == OGRArrowLayer::Constraint::
-                                                         Type::Integer64 &&
-                                 eType == OFTInteger64)
-                        {
-#if 0
-                            CPLDebug("PARQUET",
-                                     "Group %d, field %s, min = " CPL_FRMT_GIB
-                                     ", max = " CPL_FRMT_GIB,
-                                     iRowGroup,
-                                     iOGRField == OGR_FID_INDEX
-                                         ? m_osFIDColumn.c_str()
-                                         : m_poFeatureDefn->GetFieldDefn(iOGRField)
-                                               ->GetNameRef(),
-                                     static_cast<GIntBig>(sMin.Integer64),
-                                     static_cast<GIntBig>(sMax.Integer64));
-#endif
-                            res = IsConstraintPossible(
-                                constraint.nOperation,
-                                constraint.sValue.Integer64, sMin.Integer64,
-                                sMax.Integer64);
-                        }
-                        else if (constraint.eType ==
-                                     OGRArrowLayer::Constraint::Type::Real &&
-                                 eType == OFTReal)
-                        {
-#if 0
-                            CPLDebug("PARQUET",
-                                     "Group %d, field %s, min = %g, max = %g",
-                                     iRowGroup,
-                                     iOGRField == OGR_FID_INDEX
-                                         ? m_osFIDColumn.c_str()
-                                         : m_poFeatureDefn->GetFieldDefn(iOGRField)
-                                               ->GetNameRef(),
-                                     sMin.Real, sMax.Real);
-#endif
-                            res = IsConstraintPossible(constraint.nOperation,
-                                                       constraint.sValue.Real,
-                                                       sMin.Real, sMax.Real);
-                        }
-                        else if (constraint.eType ==
-                                     OGRArrowLayer::Constraint::Type::String &&
-                                 eType == OFTString)
-                        {
-#if 0
-                            CPLDebug("PARQUET",
-                                     "Group %d, field %s, min = %s, max = %s",
-                                     iRowGroup,
-                                     iOGRField == OGR_FID_INDEX
-                                         ? m_osFIDColumn.c_str()
-                                         : m_poFeatureDefn->GetFieldDefn(iOGRField)
-                                               ->GetNameRef(),
-                                     sMin.String, sMax.String);
-#endif
-                            res = IsConstraintPossible(
-                                constraint.nOperation,
-                                std::string(constraint.sValue.String),
-                                std::string(sMin.String),
-                                std::string(sMax.String));
-                        }
-                        else if (constraint.nOperation == SWQ_ISNULL ||
-                                 constraint.nOperation == SWQ_ISNOTNULL)
-                        {
-                            const int iCol =
-                                iOGRField == OGR_FID_INDEX
-                                    ? m_iFIDParquetColumn
-                                    : GetMapFieldIndexToParquetColumn()
-                                          [iOGRField];
-                            if (iCol >= 0)
-                            {
-                                const auto metadata =
-                                    m_poArrowReader->parquet_reader()
-                                        ->metadata();
-                                const auto rowGroupColumnChunk =
-                                    metadata->RowGroup(iRowGroup)->ColumnChunk(
-                                        iCol);
-                                const auto rowGroupStats =
-                                    rowGroupColumnChunk->statistics();
-                                if (rowGroupColumnChunk->is_stats_set() &&
-                                    rowGroupStats)
-                                {
-                                    res = IsConstraintPossibleRes::YES;
-                                    if (constraint.nOperation == SWQ_ISNULL &&
-                                        rowGroupStats->num_values() ==
-                                            poRowGroup->metadata()->num_rows())
-                                    {
-                                        res = IsConstraintPossibleRes::NO;
-                                    }
-                                    else if (constraint.nOperation ==
-                                                 SWQ_ISNOTNULL &&
-                                             rowGroupStats->num_values() == 0)
-                                    {
-                                        res = IsConstraintPossibleRes::NO;
-                                    }
-                                }
-                            }
-                        }
-                        else
-                        {
-                            CPLDebug(
-                                "PARQUET",
-                                "Unhandled combination of constraint.eType "
-                                "(%d) and eType (%d)",
-                                static_cast<int>(constraint.eType), eType);
-                        }
-
+                        const auto res = IsConstraintPossibleForRowGroup(
+                            this, constraint, iRowGroup, nFeatureIdx);
                         if (res == IsConstraintPossibleRes::NO)
                         {
                             bSelectGroup = false;
@@ -1310,6 +1487,16 @@ bool OGRParquetLayer::ReadNextBatch()
                     }
                 }
 
+                if (bSelectGroup && bUseAttrQueryTree &&
+                    IsExprPossibleForRowGroup(
+                        this,
+                        static_cast<const swq_expr_node *>(
+                            m_poAttrQuery->GetSWQExpr()),
+                        iRowGroup, nFeatureIdx) == IsConstraintPossibleRes::NO)
+                {
+                    bSelectGroup = false;
+                }
+
                 if (bSelectGroup)
                 {
                     // CPLDebug("PARQUET", "Selecting row group %d", iRowGroup);
@@ -1319,6 +1506,16 @@ bool OGRParquetLayer::ReadNextBatch()
 
                 nFeatureIdx += poRowGroup->metadata()->num_rows();
             }
+
+            if (!bIterateEverything)
+            {
+                CPLDebug("PARQUET", "%d/%d row groups selected",
+                         static_cast<int>(anSelectedGroups.size()),
+                         nNumGroups);
+                // Nothing could be skipped
+                if (static_cast<int>(anSelectedGroups.size()) == nNumGroups)
+                    bIterateEverything = true;
+            }
         }
 
         if (bIterateEverything)
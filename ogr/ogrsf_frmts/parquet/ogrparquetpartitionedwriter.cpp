@@ -0,0 +1,510 @@
+/******************************************************************************
+ *
+ * Project:  Parquet Translator
+ * Purpose:  Implements writing of Hive-style partitioned Parquet datasets.
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ogr_parquet.h"
+
+#include "gdal_thread_pool.h"
+
+#include <algorithm>
+
+// Name of the partition directory of features whose partition field is null,
+// as used by Hive and Arrow.
+constexpr const char *HIVE_DEFAULT_PARTITION = "__HIVE_DEFAULT_PARTITION__";
+
+/************************************************************************/
+/*                 OGRParquetPartitionedWriterLayer()                   */
+/************************************************************************/
+
+OGRParquetPartitionedWriterLayer::OGRParquetPartitionedWriterLayer(
+    OGRParquetPartitionedWriterDataset *poDS, const char *pszLayerName,
+    const OGRSpatialReference *poSpatialRef, OGRwkbGeometryType eGType,
+    CSLConstList papszOptions)
+    : m_poDS(poDS), m_poFeatureDefn(new OGRFeatureDefn(pszLayerName)),
+      m_aosLayerOptions(papszOptions),
+      m_osFIDColumn(CSLFetchNameValueDef(papszOptions, "FID", "")),
+      m_osPartitionField(poDS->GetCreationOption("PARTITION_BY", "")),
+      m_nMaxOpenFiles(std::max(
+          1, atoi(poDS->GetCreationOption("MAX_OPEN_FILES", "64")))),
+      m_nMaxMemory(
+          static_cast<uint64_t>(std::max(
+              1, atoi(poDS->GetCreationOption("MAX_MEMORY", "1024")))) *
+          1024 * 1024)
+{
+    SetDescription(pszLayerName);
+    m_poFeatureDefn->SetGeomType(wkbNone);
+    m_poFeatureDefn->Reference();
+    if (eGType != wkbNone)
+    {
+        OGRGeomFieldDefn oGeomFieldDefn(
+            CSLFetchNameValueDef(papszOptions, "GEOMETRY_NAME", "geometry"),
+            eGType);
+        if (poSpatialRef)
+        {
+            auto poSRS = poSpatialRef->Clone();
+            oGeomFieldDefn.SetSpatialRef(poSRS);
+            poSRS->Release();
+        }
+        m_poFeatureDefn->AddGeomFieldDefn(&oGeomFieldDefn);
+    }
+
+    // Files of partitions evicted because of the MAX_OPEN_FILES or
+    // MAX_MEMORY limits are finalized in worker threads.
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszNumThreads == nullptr)
+        m_nCloseThreads = std::min(4, CPLGetNumCPUs());
+    else
+        m_nCloseThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                              ? CPLGetNumCPUs()
+                              : atoi(pszNumThreads);
+    if (m_nCloseThreads > 1)
+    {
+        auto poPool = GDALGetGlobalThreadPool(m_nCloseThreads);
+        if (poPool)
+            m_poCloseQueue = poPool->CreateJobQueue();
+    }
+}
+
+/************************************************************************/
+/*                 ~OGRParquetPartitionedWriterLayer()                  */
+/************************************************************************/
+
+OGRParquetPartitionedWriterLayer::~OGRParquetPartitionedWriterLayer()
+{
+    for (auto &oIter : m_oMapPartitions)
+    {
+        ClosePartitionFile(oIter.second);
+    }
+    if (m_poCloseQueue)
+        m_poCloseQueue->WaitCompletion();
+
+    m_poFeatureDefn->Release();
+}
+
+/************************************************************************/
+/*                            GetDataset()                              */
+/************************************************************************/
+
+GDALDataset *OGRParquetPartitionedWriterLayer::GetDataset()
+{
+    return m_poDS;
+}
+
+/************************************************************************/
+/*                          TestCapability()                            */
+/************************************************************************/
+
+int OGRParquetPartitionedWriterLayer::TestCapability(const char *pszCap)
+{
+    if (EQUAL(pszCap, OLCCreateField) || EQUAL(pszCap, OLCCreateGeomField))
+        return !m_bSchemaFrozen;
+
+    if (EQUAL(pszCap, OLCSequentialWrite))
+        return true;
+
+    if (EQUAL(pszCap, OLCStringsAsUTF8))
+        return true;
+
+    if (EQUAL(pszCap, OLCMeasuredGeometries))
+        return true;
+
+    return false;
+}
+
+/************************************************************************/
+/*                           CreateField()                              */
+/************************************************************************/
+
+OGRErr OGRParquetPartitionedWriterLayer::CreateField(
+    const OGRFieldDefn *poField, int /* bApproxOK */)
+{
+    if (m_bSchemaFrozen)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Cannot add field after a first feature has been written");
+        return OGRERR_FAILURE;
+    }
+    m_poFeatureDefn->AddFieldDefn(poField);
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                          CreateGeomField()                           */
+/************************************************************************/
+
+OGRErr OGRParquetPartitionedWriterLayer::CreateGeomField(
+    const OGRGeomFieldDefn *poField, int /* bApproxOK */)
+{
+    if (m_bSchemaFrozen)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Cannot add field after a first feature has been written");
+        return OGRERR_FAILURE;
+    }
+    m_poFeatureDefn->AddGeomFieldDefn(poField);
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                         GetFeatureCount()                            */
+/************************************************************************/
+
+GIntBig OGRParquetPartitionedWriterLayer::GetFeatureCount(int bForce)
+{
+    if (m_poAttrQuery == nullptr && m_poFilterGeom == nullptr)
+    {
+        return m_nFeatureCount;
+    }
+    return OGRLayer::GetFeatureCount(bForce);
+}
+
+/************************************************************************/
+/*                       EscapePartitionValue()                         */
+/************************************************************************/
+
+// Percent-encode the characters that are not safe in a file name, as
+// expected by the Hive partitioning of Arrow.
+static std::string EscapePartitionValue(const char *pszValue)
+{
+    std::string osRet;
+    for (const char *pszIter = pszValue; *pszIter; ++pszIter)
+    {
+        const char ch = *pszIter;
+        if ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') ||
+            (ch >= '0' && ch <= '9') || ch == '-' || ch == '_' || ch == '.')
+        {
+            osRet += ch;
+        }
+        else
+        {
+            osRet += CPLSPrintf("%%%02X", static_cast<GByte>(ch));
+        }
+    }
+    return osRet;
+}
+
+/************************************************************************/
+/*                         GetUsedMemory()                              */
+/************************************************************************/
+
+// Memory used by the Arrow builders and the Parquet encoders of the
+// currently open files.
+uint64_t OGRParquetPartitionedWriterLayer::GetUsedMemory() const
+{
+    uint64_t nTotal = 0;
+    for (const auto &oIter : m_oMapPartitions)
+    {
+        if (oIter.second.poDS)
+            nTotal += static_cast<uint64_t>(
+                oIter.second.poDS->GetMemoryPool()->bytes_allocated());
+    }
+    return nTotal;
+}
+
+/************************************************************************/
+/*                        OpenPartitionFile()                           */
+/************************************************************************/
+
+bool OGRParquetPartitionedWriterLayer::OpenPartitionFile(
+    Partition &oPartition)
+{
+    auto poDriver = GetGDALDriverManager()->GetDriverByName("Parquet");
+    if (poDriver == nullptr)
+        return false;
+
+    VSIStatBufL sStat;
+    if (VSIStatL(oPartition.osDirectory.c_str(), &sStat) != 0 &&
+        VSIMkdir(oPartition.osDirectory.c_str(), 0755) != 0)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot create directory %s",
+                 oPartition.osDirectory.c_str());
+        return false;
+    }
+
+    const std::string osFilename = CPLFormFilename(
+        oPartition.osDirectory.c_str(),
+        CPLSPrintf("part-%05d.parquet", oPartition.nNextFileIdx), nullptr);
+    ++oPartition.nNextFileIdx;
+
+    auto poDS = std::unique_ptr<GDALDataset>(poDriver->Create(
+        osFilename.c_str(), 0, 0, 0, GDT_Unknown, nullptr));
+    if (poDS == nullptr)
+        return false;
+
+    // The partition field is not written in the files, as its value is
+    // encoded in the directory name.
+    const auto poSrcGeomFieldDefn = m_poFeatureDefn->GetGeomFieldCount() > 0
+                                        ? m_poFeatureDefn->GetGeomFieldDefn(0)
+                                        : nullptr;
+    CPLStringList aosOptions(m_aosLayerOptions);
+    if (poSrcGeomFieldDefn)
+        aosOptions.SetNameValue("GEOMETRY_NAME",
+                                poSrcGeomFieldDefn->GetNameRef());
+    auto poLayer = poDS->CreateLayer(
+        GetDescription(),
+        poSrcGeomFieldDefn ? poSrcGeomFieldDefn->GetSpatialRef() : nullptr,
+        poSrcGeomFieldDefn ? poSrcGeomFieldDefn->GetType() : wkbNone,
+        aosOptions.List());
+    if (poLayer == nullptr)
+        return false;
+    for (int i = 0; i < m_poFeatureDefn->GetFieldCount(); ++i)
+    {
+        if (i != m_iPartitionField &&
+            poLayer->CreateField(m_poFeatureDefn->GetFieldDefn(i)) !=
+                OGRERR_NONE)
+        {
+            return false;
+        }
+    }
+    for (int i = 1; i < m_poFeatureDefn->GetGeomFieldCount(); ++i)
+    {
+        if (poLayer->CreateGeomField(m_poFeatureDefn->GetGeomFieldDefn(i)) !=
+            OGRERR_NONE)
+        {
+            return false;
+        }
+    }
+
+    for (const auto &oIter : m_poDS->GetFieldDomains())
+    {
+        std::string osFailureReason;
+        std::unique_ptr<OGRFieldDomain> poDomain(oIter.second->Clone());
+        if (!poDS->AddFieldDomain(std::move(poDomain), osFailureReason))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "%s",
+                     osFailureReason.c_str());
+            return false;
+        }
+    }
+
+    const CPLStringList aosDomains(GetMetadataDomainList());
+    for (const char *pszDomain : aosDomains)
+    {
+        poLayer->SetMetadata(GetMetadata(pszDomain), pszDomain);
+    }
+
+    oPartition.poDS.reset(cpl::down_cast<OGRParquetWriterDataset *>(
+        poDS.release()));
+    oPartition.poLayer = poLayer;
+    ++m_nOpenFiles;
+    return true;
+}
+
+/************************************************************************/
+/*                        ClosePartitionFile()                          */
+/************************************************************************/
+
+void OGRParquetPartitionedWriterLayer::ClosePartitionFile(
+    Partition &oPartition)
+{
+    if (!oPartition.poDS)
+        return;
+
+    oPartition.poLayer = nullptr;
+    --m_nOpenFiles;
+    if (m_poCloseQueue)
+    {
+        // Finalizing a file involves encoding and compressing its last row
+        // group, so do it in the background.
+        m_poCloseQueue->SubmitJob([](void *pData)
+                                  { GDALClose(pData); },
+                                  oPartition.poDS.release());
+        // Avoid piling up pending files, and the memory they hold
+        m_poCloseQueue->WaitCompletion(m_nCloseThreads);
+    }
+    else
+    {
+        oPartition.poDS.reset();
+    }
+}
+
+/************************************************************************/
+/*                   CloseLeastRecentlyUsedFile()                       */
+/************************************************************************/
+
+void OGRParquetPartitionedWriterLayer::CloseLeastRecentlyUsedFile()
+{
+    Partition *poLRU = nullptr;
+    for (auto &oIter : m_oMapPartitions)
+    {
+        auto &oPartition = oIter.second;
+        if (oPartition.poDS &&
+            (poLRU == nullptr || oPartition.nLastUse < poLRU->nLastUse))
+        {
+            poLRU = &oPartition;
+        }
+    }
+    if (poLRU)
+        ClosePartitionFile(*poLRU);
+}
+
+/************************************************************************/
+/*                          ICreateFeature()                            */
+/************************************************************************/
+
+OGRErr OGRParquetPartitionedWriterLayer::ICreateFeature(OGRFeature *poFeature)
+{
+    if (!m_bSchemaFrozen)
+    {
+        m_iPartitionField =
+            m_poFeatureDefn->GetFieldIndex(m_osPartitionField.c_str());
+        if (m_iPartitionField < 0)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "PARTITION_BY field '%s' does not exist",
+                     m_osPartitionField.c_str());
+            return OGRERR_FAILURE;
+        }
+        m_bSchemaFrozen = true;
+    }
+
+    const char *pszValue =
+        poFeature->IsFieldSetAndNotNull(m_iPartitionField)
+            ? poFeature->GetFieldAsString(m_iPartitionField)
+            : nullptr;
+    const std::string osKey =
+        pszValue ? EscapePartitionValue(pszValue) : HIVE_DEFAULT_PARTITION;
+
+    auto oIter = m_oMapPartitions.find(osKey);
+    if (oIter == m_oMapPartitions.end())
+    {
+        Partition oPartition;
+        oPartition.osDirectory = CPLFormFilename(
+            m_poDS->GetDescription(),
+            (EscapePartitionValue(m_osPartitionField.c_str()) + '=' + osKey)
+                .c_str(),
+            nullptr);
+        oIter = m_oMapPartitions.emplace(osKey, std::move(oPartition)).first;
+    }
+    auto &oPartition = oIter->second;
+
+    if (!oPartition.poDS)
+    {
+        if (m_nOpenFiles >= m_nMaxOpenFiles)
+            CloseLeastRecentlyUsedFile();
+        if (!OpenPartitionFile(oPartition))
+            return OGRERR_FAILURE;
+    }
+    oPartition.nLastUse = ++m_nUseCounter;
+
+    OGRFeature oFeature(oPartition.poLayer->GetLayerDefn());
+    oFeature.SetFrom(poFeature);
+    if (!m_osFIDColumn.empty())
+    {
+        if (poFeature->GetFID() == OGRNullFID)
+            poFeature->SetFID(m_nFeatureCount);
+        oFeature.SetFID(poFeature->GetFID());
+    }
+    if (oPartition.poLayer->CreateFeature(&oFeature) != OGRERR_NONE)
+        return OGRERR_FAILURE;
+    ++m_nFeatureCount;
+
+    // Close files until the row groups being built by the other ones fit
+    // within the memory budget.
+    while (m_nOpenFiles > 1 && GetUsedMemory() > m_nMaxMemory)
+        CloseLeastRecentlyUsedFile();
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                OGRParquetPartitionedWriterDataset()                  */
+/************************************************************************/
+
+OGRParquetPartitionedWriterDataset::OGRParquetPartitionedWriterDataset(
+    const char *pszDirectory, CSLConstList papszOptions)
+    : m_aosCreationOptions(papszOptions)
+{
+    SetDescription(pszDirectory);
+}
+
+/************************************************************************/
+/*                           GetLayerCount()                            */
+/************************************************************************/
+
+int OGRParquetPartitionedWriterDataset::GetLayerCount()
+{
+    return m_poLayer ? 1 : 0;
+}
+
+/************************************************************************/
+/*                             GetLayer()                               */
+/************************************************************************/
+
+OGRLayer *OGRParquetPartitionedWriterDataset::GetLayer(int idx)
+{
+    return idx == 0 ? m_poLayer.get() : nullptr;
+}
+
+/************************************************************************/
+/*                         TestCapability()                             */
+/************************************************************************/
+
+int OGRParquetPartitionedWriterDataset::TestCapability(const char *pszCap)
+{
+    if (EQUAL(pszCap, ODsCCreateLayer))
+        return m_poLayer == nullptr;
+    if (EQUAL(pszCap, ODsCAddFieldDomain))
+        return true;
+    return false;
+}
+
+/************************************************************************/
+/*                          ICreateLayer()                              */
+/************************************************************************/
+
+OGRLayer *OGRParquetPartitionedWriterDataset::ICreateLayer(
+    const char *pszName, const OGRSpatialReference *poSpatialRef,
+    OGRwkbGeometryType eGType, char **papszOptions)
+{
+    if (m_poLayer)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Can write only one layer in a Parquet dataset");
+        return nullptr;
+    }
+    m_poLayer = std::make_unique<OGRParquetPartitionedWriterLayer>(
+        this, pszName, poSpatialRef, eGType, papszOptions);
+    return m_poLayer.get();
+}
+
+/************************************************************************/
+/*                          AddFieldDomain()                            */
+/************************************************************************/
+
+bool OGRParquetPartitionedWriterDataset::AddFieldDomain(
+    std::unique_ptr<OGRFieldDomain> &&domain, std::string &failureReason)
+{
+    const std::string domainName(domain->GetName());
+    if (m_oMapFieldDomains.find(domainName) != m_oMapFieldDomains.end())
+    {
+        failureReason = "A domain of identical name already exists";
+        return false;
+    }
+    m_oMapFieldDomains[domainName] = std::move(domain);
+    return true;
+}
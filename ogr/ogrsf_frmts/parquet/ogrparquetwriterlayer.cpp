@@ -35,6 +35,10 @@
 
 #include "ogr_wkb.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 /************************************************************************/
 /*                      OGRParquetWriterLayer()                         */
 /************************************************************************/
@@ -57,7 +61,21 @@ OGRParquetWriterLayer::OGRParquetWriterLayer(
 OGRParquetWriterLayer::~OGRParquetWriterLayer()
 {
     if (m_bInitializationOK)
+    {
+        if (m_poTmpGPKGLayer)
+        {
+            CopyTmpGpkgLayerToFinalFile();
+        }
+
         FinalizeWriting();
+    }
+
+    if (m_poTmpGPKG)
+    {
+        m_poTmpGPKGLayer = nullptr;
+        m_poTmpGPKG.reset();
+        VSIUnlink(m_osTmpGPKG.c_str());
+    }
 }
 
 /************************************************************************/
@@ -222,6 +240,9 @@ bool OGRParquetWriterLayer::SetOptions(CSLConstList papszOptions,
     m_bEdgesSpherical = EQUAL(
         CSLFetchNameValueDef(papszOptions, "EDGES", "PLANAR"), "SPHERICAL");
 
+    m_bSortByBBOX =
+        CPLTestBool(CSLFetchNameValueDef(papszOptions, "SORT_BY_BBOX", "NO"));
+
     m_bInitializationOK = true;
     return true;
 }
@@ -707,8 +728,28 @@ void OGRParquetWriterLayer::CreateWriter()
         FinalizeSchema();
     }
 
-    auto arrowWriterProperties =
-        parquet::ArrowWriterProperties::Builder().store_schema()->build();
+    parquet::ArrowWriterProperties::Builder oArrowWriterPropertiesBuilder;
+    oArrowWriterPropertiesBuilder.store_schema();
+#if PARQUET_VERSION_MAJOR > 10
+    // Row groups are written through the buffered row group API, which
+    // splits them according to that setting.
+    m_oWriterPropertiesBuilder.max_row_group_length(m_nRowGroupSize);
+
+    // Encode and compress the columns of a row group in parallel
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    int nNumThreads = 0;
+    if (pszNumThreads == nullptr)
+        nNumThreads = std::min(4, CPLGetNumCPUs());
+    else
+        nNumThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                       : atoi(pszNumThreads);
+    if (nNumThreads > 1)
+    {
+        CPL_IGNORE_RET_VAL(arrow::SetCpuThreadPoolCapacity(nNumThreads));
+        oArrowWriterPropertiesBuilder.set_use_threads(true);
+    }
+#endif
+    auto arrowWriterProperties = oArrowWriterPropertiesBuilder.build();
     CPL_IGNORE_RET_VAL(Open(*m_poSchema, m_poMemoryPool, m_poOutputStream,
                             m_oWriterPropertiesBuilder.build(),
                             std::move(arrowWriterProperties), &m_poFileWriter,
@@ -721,6 +762,41 @@ void OGRParquetWriterLayer::CreateWriter()
 
 bool OGRParquetWriterLayer::FlushGroup()
 {
+#if PARQUET_VERSION_MAJOR > 10
+    // Write the whole row group at once with WriteRecordBatch(), so that
+    // libparquet can encode its columns in parallel.
+    auto status = m_poFileWriter->NewBufferedRowGroup();
+    if (!status.ok())
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "NewBufferedRowGroup() failed with %s",
+                 status.message().c_str());
+        m_apoBuilders.clear();
+        return false;
+    }
+
+    const int64_t nRows = m_apoBuilders[0]->length();
+    std::vector<std::shared_ptr<arrow::Array>> apoArrays;
+    auto ret = WriteArrays(
+        [&apoArrays](const std::shared_ptr<arrow::Field> &,
+                     const std::shared_ptr<arrow::Array> &array)
+        {
+            apoArrays.push_back(array);
+            return true;
+        });
+    if (ret)
+    {
+        auto poBatch =
+            arrow::RecordBatch::Make(m_poSchema, nRows, std::move(apoArrays));
+        status = m_poFileWriter->WriteRecordBatch(*poBatch);
+        if (!status.ok())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "WriteRecordBatch() failed: %s", status.message().c_str());
+            ret = false;
+        }
+    }
+#else
     auto status = m_poFileWriter->NewRowGroup(m_apoBuilders[0]->length());
     if (!status.ok())
     {
@@ -744,11 +820,292 @@ bool OGRParquetWriterLayer::FlushGroup()
             }
             return true;
         });
+#endif
 
     m_apoBuilders.clear();
     return ret;
 }
 
+/************************************************************************/
+/*                         CreateTmpGPKGLayer()                         */
+/************************************************************************/
+
+// Name of the FID column of the temporary GeoPackage layer. Chosen to be
+// unlikely to clash with a field name.
+constexpr const char *TMP_GPKG_FID_COLUMN = "ogr_parquet_tmp_fid";
+
+bool OGRParquetWriterLayer::CreateTmpGPKGLayer()
+{
+    if (m_poFeatureDefn->GetGeomFieldCount() != 1)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "SORT_BY_BBOX=YES is only supported on layers with a "
+                 "single geometry field");
+        return false;
+    }
+
+    auto poGPKGDrv = GetGDALDriverManager()->GetDriverByName("GPKG");
+    if (poGPKGDrv == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "SORT_BY_BBOX=YES requires the GPKG driver");
+        return false;
+    }
+
+    // Put the temporary file next to the final one, unless the latter is
+    // on a network or streaming file system.
+    const char *pszFilename = m_poDataset->GetDescription();
+    if (STARTS_WITH(pszFilename, "/vsi") &&
+        !STARTS_WITH(pszFilename, "/vsimem/"))
+        m_osTmpGPKG = std::string(CPLGenerateTempFilename(nullptr)) + ".gpkg";
+    else
+        m_osTmpGPKG = std::string(pszFilename) + ".tmp.gpkg";
+
+    {
+        // Durability does not matter for a temporary file
+        CPLConfigOptionSetter oSetter("OGR_SQLITE_SYNCHRONOUS", "OFF", false);
+        m_poTmpGPKG.reset(poGPKGDrv->Create(m_osTmpGPKG.c_str(), 0, 0, 0,
+                                            GDT_Unknown, nullptr));
+    }
+    if (m_poTmpGPKG == nullptr)
+        return false;
+
+    const auto poGeomFieldDefn = m_poFeatureDefn->GetGeomFieldDefn(0);
+    const auto eGType = poGeomFieldDefn->GetType();
+    CPLStringList aosOptions;
+    aosOptions.SetNameValue("SPATIAL_INDEX", "NO");
+    aosOptions.SetNameValue("FID", TMP_GPKG_FID_COLUMN);
+    aosOptions.SetNameValue("GEOMETRY_NAME", poGeomFieldDefn->GetNameRef());
+    auto poLayer = m_poTmpGPKG->CreateLayer(
+        "tmp", nullptr,
+        OGR_GT_SetModifier(wkbUnknown, OGR_GT_HasZ(eGType),
+                           OGR_GT_HasM(eGType)),
+        aosOptions.List());
+    if (poLayer == nullptr)
+        return false;
+
+    // The temporary layer is only a spool: relax constraints, and store
+    // the types not supported by GeoPackage as strings, which
+    // OGRFeature::SetFrom() converts back.
+    for (int i = 0; i < m_poFeatureDefn->GetFieldCount(); ++i)
+    {
+        OGRFieldDefn oFieldDefn(m_poFeatureDefn->GetFieldDefn(i));
+        const auto eType = oFieldDefn.GetType();
+        if (eType == OFTIntegerList || eType == OFTInteger64List ||
+            eType == OFTRealList || eType == OFTStringList)
+        {
+            oFieldDefn.SetType(OFTString);
+            oFieldDefn.SetSubType(OFSTJSON);
+        }
+        else if (eType == OFTTime)
+        {
+            oFieldDefn.SetType(OFTString);
+        }
+        oFieldDefn.SetNullable(true);
+        oFieldDefn.SetUnique(false);
+        oFieldDefn.SetDefault(nullptr);
+        oFieldDefn.SetDomainName(std::string());
+        if (poLayer->CreateField(&oFieldDefn, false) != OGRERR_NONE)
+            return false;
+    }
+
+    if (m_poTmpGPKG->StartTransaction() != OGRERR_NONE)
+        return false;
+
+    m_poTmpGPKGLayer = poLayer;
+    return true;
+}
+
+/************************************************************************/
+/*                          ICreateFeature()                            */
+/************************************************************************/
+
+OGRErr OGRParquetWriterLayer::ICreateFeature(OGRFeature *poFeature)
+{
+    if (!m_bSortByBBOX)
+        return OGRArrowWriterLayer::ICreateFeature(poFeature);
+
+    // Features are only written to the Parquet file when the layer is
+    // finalized, in the order of their bounding box.
+    if (m_poSchema == nullptr)
+    {
+        CreateSchema();
+    }
+
+    if (m_poTmpGPKGLayer == nullptr && !CreateTmpGPKGLayer())
+        return OGRERR_FAILURE;
+
+    OGRFeature oTmpFeature(m_poTmpGPKGLayer->GetLayerDefn());
+    oTmpFeature.SetFrom(poFeature);
+    if (!m_osFIDColumn.empty())
+    {
+        if (poFeature->GetFID() == OGRNullFID)
+            poFeature->SetFID(m_nFeatureCount);
+        oTmpFeature.SetFID(poFeature->GetFID());
+    }
+    if (m_poTmpGPKGLayer->CreateFeature(&oTmpFeature) != OGRERR_NONE)
+        return OGRERR_FAILURE;
+
+    m_nFeatureCount++;
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                            HilbertCode()                             */
+/************************************************************************/
+
+constexpr uint32_t HILBERT_MAX = (1 << 16) - 1;
+
+// Returns the distance of (x, y), with 0 <= x, y <= HILBERT_MAX, along the
+// Hilbert curve filling that square.
+static uint32_t HilbertCode(uint32_t x, uint32_t y)
+{
+    uint32_t d = 0;
+    for (uint32_t s = (HILBERT_MAX + 1) / 2; s > 0; s /= 2)
+    {
+        const uint32_t rx = (x & s) ? 1 : 0;
+        const uint32_t ry = (y & s) ? 1 : 0;
+        d += s * s * ((3 * rx) ^ ry);
+        // Rotate the quadrant
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = HILBERT_MAX - x;
+                y = HILBERT_MAX - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+/************************************************************************/
+/*                     CopyTmpGpkgLayerToFinalFile()                    */
+/************************************************************************/
+
+bool OGRParquetWriterLayer::CopyTmpGpkgLayerToFinalFile()
+{
+    CPLDebug("PARQUET", "Sorting " CPL_FRMT_GIB " features by bounding box",
+             static_cast<GIntBig>(m_nFeatureCount));
+
+    if (m_poTmpGPKG->CommitTransaction() != OGRERR_NONE)
+        return false;
+
+    const auto QuoteIdentifier = [](const char *pszName)
+    { return '"' + CPLString(pszName).replaceAll('"', "\"\"") + '"'; };
+    const std::string osGeomColumn =
+        QuoteIdentifier(m_poTmpGPKGLayer->GetGeometryColumn());
+    // Depending on how SQLite is built, the FID column of the temporary
+    // layer is recognized as such in result sets, or returned as a field.
+    const auto GetTmpFID = [](const OGRFeature *poFeature)
+    {
+        const int iField = poFeature->GetFieldIndex(TMP_GPKG_FID_COLUMN);
+        return iField >= 0 ? poFeature->GetFieldAsInteger64(iField)
+                           : poFeature->GetFID();
+    };
+
+    // Store in a side table the Hilbert code of the center of the bounding
+    // box of each feature. Sorting on it is then done by SQLite, which
+    // spills to temporary files when needed, so that the number of features
+    // is not bounded by the available RAM.
+    auto poHilbertLayer =
+        m_poTmpGPKG->CreateLayer("hilbert", nullptr, wkbNone, nullptr);
+    if (poHilbertLayer == nullptr)
+        return false;
+    {
+        OGRFieldDefn oFieldDefn("code", OFTInteger64);
+        if (poHilbertLayer->CreateField(&oFieldDefn) != OGRERR_NONE)
+            return false;
+    }
+
+    OGREnvelope sExtent;
+    CPL_IGNORE_RET_VAL(m_poTmpGPKGLayer->GetExtent(&sExtent, true));
+    const double dfWidth = sExtent.MaxX - sExtent.MinX;
+    const double dfHeight = sExtent.MaxY - sExtent.MinY;
+
+    if (m_poTmpGPKG->StartTransaction() != OGRERR_NONE)
+        return false;
+    bool bRet = true;
+    {
+        const std::string osSQL = CPLSPrintf(
+            "SELECT %s, ST_MinX(%s) AS minx, ST_MinY(%s) AS miny, "
+            "ST_MaxX(%s) AS maxx, ST_MaxY(%s) AS maxy FROM tmp",
+            TMP_GPKG_FID_COLUMN, osGeomColumn.c_str(), osGeomColumn.c_str(),
+            osGeomColumn.c_str(), osGeomColumn.c_str());
+        auto poSQLLyr =
+            m_poTmpGPKG->ExecuteSQL(osSQL.c_str(), nullptr, nullptr);
+        if (poSQLLyr == nullptr)
+            return false;
+        const auto poSQLDefn = poSQLLyr->GetLayerDefn();
+        const int iMinX = poSQLDefn->GetFieldIndex("minx");
+        const int iMinY = poSQLDefn->GetFieldIndex("miny");
+        const int iMaxX = poSQLDefn->GetFieldIndex("maxx");
+        const int iMaxY = poSQLDefn->GetFieldIndex("maxy");
+        while (bRet)
+        {
+            auto poSrcFeature =
+                std::unique_ptr<OGRFeature>(poSQLLyr->GetNextFeature());
+            if (poSrcFeature == nullptr)
+                break;
+            // Features without geometry go last
+            GIntBig nCode =
+                static_cast<GIntBig>(std::numeric_limits<uint32_t>::max()) + 1;
+            if (poSrcFeature->IsFieldSetAndNotNull(iMinX))
+            {
+                const double dfX = (poSrcFeature->GetFieldAsDouble(iMinX) +
+                                    poSrcFeature->GetFieldAsDouble(iMaxX)) /
+                                   2;
+                const double dfY = (poSrcFeature->GetFieldAsDouble(iMinY) +
+                                    poSrcFeature->GetFieldAsDouble(iMaxY)) /
+                                   2;
+                uint32_t nX = 0;
+                uint32_t nY = 0;
+                if (dfWidth > 0)
+                    nX = static_cast<uint32_t>(std::floor(
+                        HILBERT_MAX * (dfX - sExtent.MinX) / dfWidth));
+                if (dfHeight > 0)
+                    nY = static_cast<uint32_t>(std::floor(
+                        HILBERT_MAX * (dfY - sExtent.MinY) / dfHeight));
+                nCode = HilbertCode(std::min(nX, HILBERT_MAX),
+                                    std::min(nY, HILBERT_MAX));
+            }
+            OGRFeature oFeature(poHilbertLayer->GetLayerDefn());
+            oFeature.SetFID(GetTmpFID(poSrcFeature.get()));
+            oFeature.SetField(0, nCode);
+            bRet = poHilbertLayer->CreateFeature(&oFeature) == OGRERR_NONE;
+        }
+        m_poTmpGPKG->ReleaseResultSet(poSQLLyr);
+    }
+    if (m_poTmpGPKG->CommitTransaction() != OGRERR_NONE || !bRet)
+        return false;
+
+    // Write the features in Hilbert order
+    const std::string osSQL = CPLSPrintf(
+        "SELECT tmp.* FROM tmp JOIN hilbert ON tmp.%s = hilbert.fid "
+        "ORDER BY hilbert.code, hilbert.fid",
+        TMP_GPKG_FID_COLUMN);
+    auto poSQLLyr = m_poTmpGPKG->ExecuteSQL(osSQL.c_str(), nullptr, nullptr);
+    if (poSQLLyr == nullptr)
+        return false;
+    m_nFeatureCount = 0;
+    while (bRet)
+    {
+        auto poSrcFeature =
+            std::unique_ptr<OGRFeature>(poSQLLyr->GetNextFeature());
+        if (poSrcFeature == nullptr)
+            break;
+        OGRFeature oFeature(m_poFeatureDefn);
+        oFeature.SetFrom(poSrcFeature.get());
+        if (!m_osFIDColumn.empty())
+            oFeature.SetFID(GetTmpFID(poSrcFeature.get()));
+        bRet = OGRArrowWriterLayer::ICreateFeature(&oFeature) == OGRERR_NONE;
+    }
+    m_poTmpGPKG->ReleaseResultSet(poSQLLyr);
+
+    return bRet;
+}
+
 /************************************************************************/
 /*                    FixupWKBGeometryBeforeWriting()                   */
 /************************************************************************/
@@ -807,6 +1164,13 @@ OGRParquetWriterLayer::WriteArrowBatch(const struct ArrowSchema *schema,
                                        struct ArrowArray *array,
                                        CSLConstList papszOptions)
 {
+    if (m_bSortByBBOX)
+    {
+        // Go through ICreateFeature() to store features in the temporary
+        // GeoPackage
+        return OGRLayer::WriteArrowBatch(schema, array, papszOptions);
+    }
+
     return WriteArrowBatchInternal(
         schema, array, papszOptions,
         [this](const std::shared_ptr<arrow::RecordBatch> &poBatch)
@@ -844,6 +1208,8 @@ inline int OGRParquetWriterLayer::TestCapability(const char *pszCap)
     if (EQUAL(pszCap, OLCFastWriteArrowBatch))
         return false;
 #endif
+    if (m_bSortByBBOX && EQUAL(pszCap, OLCFastWriteArrowBatch))
+        return false;
     return OGRArrowWriterLayer::TestCapability(pszCap);
 }
 
@@ -856,6 +1222,11 @@ bool OGRParquetWriterLayer::IsArrowSchemaSupported(
     const struct ArrowSchema *schema, CSLConstList papszOptions,
     std::string &osErrorMsg) const
 {
+    if (m_bSortByBBOX)
+    {
+        return OGRLayer::IsArrowSchemaSupported(schema, papszOptions,
+                                                osErrorMsg);
+    }
     if (schema->format[0] == 'e' && schema->format[1] == 0)
     {
         osErrorMsg = "float16 not supported";
@@ -871,6 +1242,21 @@ bool OGRParquetWriterLayer::IsArrowSchemaSupported(
     }
     return true;
 }
+
+/************************************************************************/
+/*                      CreateFieldFromArrowSchema()                    */
+/************************************************************************/
+
+bool OGRParquetWriterLayer::CreateFieldFromArrowSchema(
+    const struct ArrowSchema *schema, CSLConstList papszOptions)
+{
+    // Fields created from an Arrow schema can only be written with
+    // WriteArrowBatch(), which is not possible when sorting features.
+    if (m_bSortByBBOX)
+        return OGRLayer::CreateFieldFromArrowSchema(schema, papszOptions);
+    return OGRArrowWriterLayer::CreateFieldFromArrowSchema(schema,
+                                                           papszOptions);
+}
 #endif
 
 /************************************************************************/
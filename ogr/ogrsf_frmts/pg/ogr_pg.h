@@ -39,6 +39,7 @@
 #include "ogr_pgdump.h"
 
 #include <map>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -92,6 +93,7 @@ CPLString OGRPGEscapeColumnName(const char *pszColumnName);
     -2 /* Special value when we haven't yet looked for SRID */
 
 class OGRPGDataSource;
+struct OGRPGParallelReader;
 class OGRPGLayer;
 
 typedef enum
@@ -327,9 +329,36 @@ class OGRPGTableLayer final : public OGRPGLayer
     bool bFIDColumnInCopyFields = false;
     int bFirstInsertion = true;
 
+    // Encoding of the columns of the COPY statement in binary format
+    enum class CopyBinaryType
+    {
+        GEOMETRY_EWKB,
+        GEOMETRY_WKB,
+        BOOL,
+        INT2,
+        INT4,
+        INT8,
+        FLOAT4,
+        FLOAT8,
+        TEXT,
+        JSONB,
+        BYTEA,
+        DATE,
+        TIMESTAMP,
+        TIMESTAMPTZ,
+    };
+
+    bool m_bCopyBinary = false;
+    bool m_bCopyBinaryAllowed = true;
+    std::vector<CopyBinaryType> m_aeCopyBinaryTypes{};
+
     OGRErr CreateFeatureViaCopy(OGRFeature *poFeature);
     OGRErr CreateFeatureViaInsert(OGRFeature *poFeature);
     CPLString BuildCopyFields();
+    bool PrepareCopyBinary();
+    bool CanCopyBinary(OGRFeature *poFeature) const;
+    bool BuildCopyBinaryRow(OGRFeature *poFeature, std::string &osRow);
+    OGRErr PutCopyData(const char *pachData, size_t nSize);
 
     int bHasWarnedIncompatibleGeom = false;
     void CheckGeomTypeCompatibility(int iGeomField, OGRGeometry *poGeom);
@@ -354,6 +383,11 @@ class OGRPGTableLayer final : public OGRPGLayer
 
     int iFIDAsRegularColumnIndex = -1;
 
+    // Set when the layer is read through several connections
+    std::unique_ptr<OGRPGParallelReader> m_poParallelReader{};
+    bool StartParallelRead();
+    OGRFeature *GetNextRawFeatureParallel();
+
     CPLString m_osFirstGeometryFieldName{};
 
     std::vector<bool> m_abGeneratedColumns{};
@@ -386,6 +420,7 @@ class OGRPGTableLayer final : public OGRPGLayer
     virtual OGRFeature *GetFeature(GIntBig nFeatureId) override;
     virtual void ResetReading() override;
     virtual OGRFeature *GetNextFeature() override;
+    virtual OGRErr SetNextByIndex(GIntBig nIndex) override;
     virtual GIntBig GetFeatureCount(int) override;
 
     virtual void SetSpatialFilter(OGRGeometry *poGeom) override
@@ -589,6 +624,9 @@ class OGRPGDataSource final : public OGRDataSource
 
     PGconn *hPGConn = nullptr;
 
+    // Connection string, without the GDAL specific parameters
+    std::string m_osConnectionString{};
+
     OGRErr DeleteLayer(int iLayer) override;
 
     Oid nGeometryOID = static_cast<Oid>(0);
@@ -661,6 +699,13 @@ class OGRPGDataSource final : public OGRDataSource
         return hPGConn;
     }
 
+    PGconn *OpenAuxiliaryConnection();
+
+    bool IsInTransaction() const
+    {
+        return nSoftTransactionLevel > 0;
+    }
+
     int FetchSRSId(const OGRSpatialReference *poSRS);
     const OGRSpatialReference *FetchSRS(int nSRSId);
     static OGRErr InitializeMetadataTables();
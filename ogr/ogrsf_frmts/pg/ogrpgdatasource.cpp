@@ -589,6 +589,7 @@ int OGRPGDataSource::Open(const char *pszNewName, int bUpdate, int bTestOpen,
     /*      Try to establish connection.                                    */
     /* -------------------------------------------------------------------- */
     hPGConn = PQconnectdb(pszConnectionNameNoPrefix);
+    m_osConnectionString = pszConnectionNameNoPrefix;
     CPLFree(pszConnectionName);
     pszConnectionName = nullptr;
 
@@ -2287,6 +2288,58 @@ static void OGRPGNoticeProcessor(CPL_UNUSED void *arg, const char *pszMessage)
     CPLDebug("OGR_PG_NOTICE", "%s", pszMessage);
 }
 
+/************************************************************************/
+/*                     OpenAuxiliaryConnection()                        */
+/************************************************************************/
+
+/** Open a new connection to the database, with the same parameters as the
+ * main one. Used by readers that need their own transaction, such as the
+ * workers of OGRPGTableLayer parallel reading.
+ */
+PGconn *OGRPGDataSource::OpenAuxiliaryConnection()
+{
+    PGconn *hConn = PQconnectdb(m_osConnectionString.c_str());
+    if (hConn == nullptr || PQstatus(hConn) == CONNECTION_BAD)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "PQconnectdb failed.\n%s",
+                 PQerrorMessage(hConn));
+        PQfinish(hConn);
+        return nullptr;
+    }
+
+    // Don't replay prelude statements that open a transaction, as the
+    // caller manages its own one.
+    const char *pszPreludeStatements =
+        CSLFetchNameValue(papszOpenOptions, "PRELUDE_STATEMENTS");
+    if (pszPreludeStatements != nullptr &&
+        !STARTS_WITH_CI(pszPreludeStatements, "BEGIN"))
+    {
+        PGresult *hResult = OGRPG_PQexec(hConn, pszPreludeStatements, TRUE);
+        const bool bOK =
+            hResult && PQresultStatus(hResult) == PGRES_COMMAND_OK;
+        OGRPGClearResult(hResult);
+        if (!bOK)
+        {
+            PQfinish(hConn);
+            return nullptr;
+        }
+    }
+
+    const char *pszClientEncoding =
+        PQparameterStatus(hPGConn, "client_encoding");
+    if (pszClientEncoding &&
+        PQsetClientEncoding(hConn, pszClientEncoding) == -1)
+    {
+        CPLError(CE_Warning, CPLE_AppDefined,
+                 "PQsetClientEncoding(%s) failed.\n%s", pszClientEncoding,
+                 PQerrorMessage(hConn));
+    }
+
+    PQsetNoticeProcessor(hConn, OGRPGNoticeProcessor, this);
+
+    return hConn;
+}
+
 /************************************************************************/
 /*                      InitializeMetadataTables()                      */
 /*                                                                      */
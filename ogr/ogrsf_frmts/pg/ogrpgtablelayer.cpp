@@ -32,10 +32,15 @@
 #include "cpl_conv.h"
 #include "cpl_string.h"
 #include "cpl_error.h"
+#include "cpl_time.h"
 #include "ogr_p.h"
 
 #include <chrono>
+#include <cmath>
 #include <condition_variable>
+#include <deque>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <thread>
 
@@ -1165,6 +1170,7 @@ void OGRPGTableLayer::ResetReading()
 
     BuildFullQueryStatement();
 
+    m_poParallelReader.reset();
     OGRPGLayer::ResetReading();
 
     bInResetReading = FALSE;
@@ -1189,9 +1195,14 @@ OGRFeature *OGRPGTableLayer::GetNextFeature()
         poGeomFieldDefn = poFeatureDefn->GetGeomFieldDefn(m_iGeomFieldFilter);
     poFeatureDefn->GetFieldCount();
 
+    if (iNextShapeId == 0 && hCursorResult == nullptr && !m_poParallelReader)
+        StartParallelRead();
+
     while (true)
     {
-        OGRFeature *poFeature = GetNextRawFeature();
+        OGRFeature *poFeature = m_poParallelReader
+                                    ? GetNextRawFeatureParallel()
+                                    : GetNextRawFeature();
         if (poFeature == nullptr)
             return nullptr;
 
@@ -1217,6 +1228,437 @@ OGRFeature *OGRPGTableLayer::GetNextFeature()
     }
 }
 
+/************************************************************************/
+/*                         OGRPGParallelReader                          */
+/************************************************************************/
+
+// Reads the rows of a table through several connections, each one of them
+// scanning a range of values of the integer FID column with its own cursor.
+// All connections share the same snapshot, exported from the main
+// connection, so that they see a consistent state of the table.
+// Pages of rows are fetched by worker threads, and decoded into features
+// by the thread calling GetNextFeature().
+struct OGRPGParallelReader
+{
+    OGRPGParallelReader() = default;
+    OGRPGParallelReader(const OGRPGParallelReader &) = delete;
+    OGRPGParallelReader &operator=(const OGRPGParallelReader &) = delete;
+    ~OGRPGParallelReader();
+
+    // Maximum number of pages fetched in advance by each worker
+    static constexpr size_t MAX_PENDING_PAGES = 4;
+
+    struct Partition
+    {
+        PGconn *hConn = nullptr;
+        std::string osQuery{};
+        std::deque<PGresult *> ahPendingPages{};
+        bool bFinished = false;
+        std::string osErrorMsg{};
+    };
+
+    int nCursorPage = 0;
+    bool bOrdered = false;
+    std::vector<Partition> asPartitions{};
+    std::vector<std::thread> aoThreads{};
+    std::mutex oMutex{};
+    std::condition_variable oCV{};
+    bool bStop = false;
+    size_t iCurPartition = 0;
+
+    PGresult *hCurPage = nullptr;
+    int nCurPageOffset = 0;
+
+    void WorkerThread(Partition &sPartition);
+    PGresult *GetNextPage();
+};
+
+/************************************************************************/
+/*                       ~OGRPGParallelReader()                         */
+/************************************************************************/
+
+OGRPGParallelReader::~OGRPGParallelReader()
+{
+    {
+        std::lock_guard<std::mutex> oLock(oMutex);
+        bStop = true;
+    }
+    oCV.notify_all();
+    for (auto &oThread : aoThreads)
+        oThread.join();
+
+    OGRPGClearResult(hCurPage);
+    for (auto &sPartition : asPartitions)
+    {
+        for (PGresult *hResult : sPartition.ahPendingPages)
+            PQclear(hResult);
+        // Closing the connection rolls back its read-only transaction
+        if (sPartition.hConn)
+            PQfinish(sPartition.hConn);
+    }
+}
+
+/************************************************************************/
+/*                            WorkerThread()                            */
+/************************************************************************/
+
+void OGRPGParallelReader::WorkerThread(Partition &sPartition)
+{
+    PGconn *hConn = sPartition.hConn;
+    std::string osErrorMsg;
+
+    PGresult *hResult = OGRPG_PQexec(
+        hConn,
+        CPLSPrintf("DECLARE OGRPGParallelReader CURSOR FOR %s",
+                   sPartition.osQuery.c_str()),
+        FALSE, TRUE);
+    if (!hResult || PQresultStatus(hResult) != PGRES_COMMAND_OK)
+        osErrorMsg = PQerrorMessage(hConn);
+    OGRPGClearResult(hResult);
+
+    const std::string osFetch(
+        CPLSPrintf("FETCH %d IN OGRPGParallelReader", nCursorPage));
+    while (osErrorMsg.empty())
+    {
+        {
+            std::unique_lock<std::mutex> oLock(oMutex);
+            oCV.wait(oLock,
+                     [this, &sPartition]() {
+                         return bStop || sPartition.ahPendingPages.size() <
+                                             MAX_PENDING_PAGES;
+                     });
+            if (bStop)
+                return;
+        }
+
+        hResult = OGRPG_PQexec(hConn, osFetch.c_str(), FALSE, TRUE);
+        if (!hResult || PQresultStatus(hResult) != PGRES_TUPLES_OK)
+        {
+            osErrorMsg = PQerrorMessage(hConn);
+            OGRPGClearResult(hResult);
+            break;
+        }
+        if (PQntuples(hResult) == 0)
+        {
+            OGRPGClearResult(hResult);
+            break;
+        }
+
+        {
+            std::lock_guard<std::mutex> oLock(oMutex);
+            sPartition.ahPendingPages.push_back(hResult);
+        }
+        oCV.notify_all();
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(oMutex);
+        sPartition.bFinished = true;
+        sPartition.osErrorMsg = std::move(osErrorMsg);
+    }
+    oCV.notify_all();
+}
+
+/************************************************************************/
+/*                            GetNextPage()                             */
+/*                                                                      */
+/*      Wait for the next page of rows. In ordered mode, partitions     */
+/*      are consumed one after the other. Otherwise the first page      */
+/*      available in any partition is returned.                         */
+/************************************************************************/
+
+PGresult *OGRPGParallelReader::GetNextPage()
+{
+    const size_t nPartitions = asPartitions.size();
+    std::unique_lock<std::mutex> oLock(oMutex);
+
+    const auto PopPage = [this, &oLock](Partition &sPartition)
+    {
+        PGresult *hResult = sPartition.ahPendingPages.front();
+        sPartition.ahPendingPages.pop_front();
+        oLock.unlock();
+        oCV.notify_all();
+        return hResult;
+    };
+
+    const auto ReportError = [](Partition &sPartition)
+    {
+        if (!sPartition.osErrorMsg.empty())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "%s",
+                     sPartition.osErrorMsg.c_str());
+            sPartition.osErrorMsg.clear();
+        }
+    };
+
+    while (true)
+    {
+        if (bOrdered)
+        {
+            auto &sPartition = asPartitions[iCurPartition];
+            if (!sPartition.ahPendingPages.empty())
+                return PopPage(sPartition);
+            if (sPartition.bFinished)
+            {
+                ReportError(sPartition);
+                if (iCurPartition + 1 == nPartitions)
+                    return nullptr;
+                ++iCurPartition;
+                continue;
+            }
+        }
+        else
+        {
+            bool bAllFinished = true;
+            for (size_t i = 0; i < nPartitions; ++i)
+            {
+                const size_t iPartition = (iCurPartition + i) % nPartitions;
+                auto &sPartition = asPartitions[iPartition];
+                if (!sPartition.ahPendingPages.empty())
+                {
+                    iCurPartition = (iPartition + 1) % nPartitions;
+                    return PopPage(sPartition);
+                }
+                if (sPartition.bFinished)
+                    ReportError(sPartition);
+                else
+                    bAllFinished = false;
+            }
+            if (bAllFinished)
+                return nullptr;
+        }
+        oCV.wait(oLock);
+    }
+}
+
+/************************************************************************/
+/*                         StartParallelRead()                          */
+/*                                                                      */
+/*      Start reading the layer through several connections, if        */
+/*      enabled by OGR_PG_NUM_THREADS and if the layer has an           */
+/*      integer FID column. Returns false if the regular cursor must    */
+/*      be used.                                                        */
+/************************************************************************/
+
+bool OGRPGTableLayer::StartParallelRead()
+{
+    const char *pszNumThreads = CPLGetConfigOption("OGR_PG_NUM_THREADS", "1");
+    int nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+    // pg_export_snapshot() and SET TRANSACTION SNAPSHOT require PG >= 9.2.
+    // Exported snapshots do not include changes not yet committed, so
+    // don't use parallel reading within a transaction.
+    if (nThreads <= 1 || pszFIDColumn == nullptr || poDS->bUseBinaryCursor ||
+        poDS->IsInTransaction() || poDS->sPostgreSQLVersion.nMajor < 9 ||
+        (poDS->sPostgreSQLVersion.nMajor == 9 &&
+         poDS->sPostgreSQLVersion.nMinor < 2))
+    {
+        return false;
+    }
+
+    PGconn *hPGConn = poDS->GetPGConn();
+    const CPLString osEscapedFID = OGRPGEscapeColumnName(pszFIDColumn);
+
+    poDS->SoftStartTransaction();
+
+    std::string osSnapshot;
+    PGresult *hResult =
+        OGRPG_PQexec(hPGConn, "SELECT pg_export_snapshot()", FALSE, TRUE);
+    if (hResult && PQresultStatus(hResult) == PGRES_TUPLES_OK &&
+        PQntuples(hResult) == 1)
+    {
+        osSnapshot = PQgetvalue(hResult, 0, 0);
+    }
+    OGRPGClearResult(hResult);
+
+    bool bHasRange = false;
+    GIntBig nMinFID = 0;
+    GIntBig nMaxFID = 0;
+    if (!osSnapshot.empty())
+    {
+        CPLString osCommand;
+        osCommand.Printf("SELECT MIN(%s), MAX(%s) FROM %s",
+                         osEscapedFID.c_str(), osEscapedFID.c_str(),
+                         pszSqlTableName);
+        hResult = OGRPG_PQexec(hPGConn, osCommand.c_str(), FALSE, TRUE);
+        if (hResult && PQresultStatus(hResult) == PGRES_TUPLES_OK &&
+            PQntuples(hResult) == 1 && !PQgetisnull(hResult, 0, 0) &&
+            !PQgetisnull(hResult, 0, 1))
+        {
+            bHasRange = true;
+            nMinFID = CPLAtoGIntBig(PQgetvalue(hResult, 0, 0));
+            nMaxFID = CPLAtoGIntBig(PQgetvalue(hResult, 0, 1));
+        }
+        OGRPGClearResult(hResult);
+    }
+
+    // Split [nMinFID, nMaxFID] in ranges of equal extent
+    std::vector<GIntBig> anBounds;
+    if (bHasRange)
+    {
+        const uint64_t nRange =
+            static_cast<uint64_t>(nMaxFID) - static_cast<uint64_t>(nMinFID);
+        const uint64_t nStep = nRange / static_cast<uint64_t>(nThreads) + 1;
+        for (int i = 1; i < nThreads; ++i)
+        {
+            const uint64_t nOffset = static_cast<uint64_t>(i) * nStep;
+            if (nOffset > nRange)
+                break;
+            anBounds.push_back(static_cast<GIntBig>(
+                static_cast<uint64_t>(nMinFID) + nOffset));
+        }
+    }
+    if (anBounds.empty())
+    {
+        poDS->SoftCommitTransaction();
+        return false;
+    }
+
+    auto poReader = std::make_unique<OGRPGParallelReader>();
+    poReader->nCursorPage = nCursorPage;
+    poReader->bOrdered =
+        CPLTestBool(CPLGetConfigOption("OGR_PG_PARALLEL_READ_ORDERED", "NO"));
+    poReader->asPartitions.resize(anBounds.size() + 1);
+
+    const CPLString osFields = BuildFields();
+    bool bOK = true;
+    for (size_t i = 0; bOK && i < poReader->asPartitions.size(); ++i)
+    {
+        auto &sPartition = poReader->asPartitions[i];
+
+        CPLString osRange;
+        if (i == 0)
+            osRange.Printf("%s < " CPL_FRMT_GIB, osEscapedFID.c_str(),
+                           anBounds[i]);
+        else if (i == anBounds.size())
+            osRange.Printf("%s >= " CPL_FRMT_GIB, osEscapedFID.c_str(),
+                           anBounds[i - 1]);
+        else
+            osRange.Printf("%s >= " CPL_FRMT_GIB " AND %s < " CPL_FRMT_GIB,
+                           osEscapedFID.c_str(), anBounds[i - 1],
+                           osEscapedFID.c_str(), anBounds[i]);
+
+        sPartition.osQuery = "SELECT ";
+        sPartition.osQuery += osFields;
+        sPartition.osQuery += " FROM ";
+        sPartition.osQuery += pszSqlTableName;
+        if (osWHERE.empty())
+        {
+            sPartition.osQuery += " WHERE ";
+            sPartition.osQuery += osRange;
+        }
+        else
+        {
+            sPartition.osQuery += ' ';
+            sPartition.osQuery += osWHERE;
+            sPartition.osQuery += " AND (";
+            sPartition.osQuery += osRange;
+            sPartition.osQuery += ')';
+        }
+        if (poReader->bOrdered)
+        {
+            sPartition.osQuery += " ORDER BY ";
+            sPartition.osQuery += osEscapedFID;
+        }
+
+        // The snapshot can only be imported while the transaction that
+        // exported it is still opened.
+        sPartition.hConn = poDS->OpenAuxiliaryConnection();
+        if (sPartition.hConn == nullptr)
+        {
+            bOK = false;
+            break;
+        }
+        hResult = OGRPG_PQexec(
+            sPartition.hConn,
+            "BEGIN ISOLATION LEVEL REPEATABLE READ READ ONLY", FALSE, TRUE);
+        bOK = hResult && PQresultStatus(hResult) == PGRES_COMMAND_OK;
+        OGRPGClearResult(hResult);
+        if (bOK)
+        {
+            hResult = OGRPG_PQexec(
+                sPartition.hConn,
+                CPLSPrintf(
+                    "SET TRANSACTION SNAPSHOT %s",
+                    OGRPGEscapeString(sPartition.hConn, osSnapshot.c_str())
+                        .c_str()),
+                FALSE, TRUE);
+            bOK = hResult && PQresultStatus(hResult) == PGRES_COMMAND_OK;
+            OGRPGClearResult(hResult);
+        }
+    }
+
+    poDS->SoftCommitTransaction();
+
+    if (!bOK)
+    {
+        CPLDebug("PG", "Cannot use parallel reading on layer %s",
+                 poFeatureDefn->GetName());
+        return false;
+    }
+
+    CPLDebug("PG", "Reading layer %s with %d connections",
+             poFeatureDefn->GetName(),
+             static_cast<int>(poReader->asPartitions.size()));
+    for (auto &sPartition : poReader->asPartitions)
+    {
+        poReader->aoThreads.emplace_back(&OGRPGParallelReader::WorkerThread,
+                                         poReader.get(),
+                                         std::ref(sPartition));
+    }
+    m_poParallelReader = std::move(poReader);
+    return true;
+}
+
+/************************************************************************/
+/*                     GetNextRawFeatureParallel()                      */
+/************************************************************************/
+
+OGRFeature *OGRPGTableLayer::GetNextRawFeatureParallel()
+{
+    OGRPGParallelReader *poReader = m_poParallelReader.get();
+    if (poReader->hCurPage == nullptr ||
+        poReader->nCurPageOffset == PQntuples(poReader->hCurPage))
+    {
+        OGRPGClearResult(poReader->hCurPage);
+        poReader->hCurPage = poReader->GetNextPage();
+        poReader->nCurPageOffset = 0;
+        if (poReader->hCurPage == nullptr)
+        {
+            iNextShapeId = MAX(1, iNextShapeId);
+            return nullptr;
+        }
+        if (iNextShapeId == 0)
+        {
+            CreateMapFromFieldNameToIndex(poReader->hCurPage, poFeatureDefn,
+                                          m_panMapFieldNameToIndex,
+                                          m_panMapFieldNameToGeomIndex);
+        }
+    }
+
+    OGRFeature *poFeature = RecordToFeature(
+        poReader->hCurPage, m_panMapFieldNameToIndex,
+        m_panMapFieldNameToGeomIndex, poReader->nCurPageOffset);
+
+    poReader->nCurPageOffset++;
+    iNextShapeId++;
+
+    return poFeature;
+}
+
+/************************************************************************/
+/*                           SetNextByIndex()                           */
+/************************************************************************/
+
+OGRErr OGRPGTableLayer::SetNextByIndex(GIntBig nIndex)
+
+{
+    // Parallel reading cannot be repositioned: restart with a regular cursor
+    if (m_poParallelReader)
+        ResetReading();
+    return OGRPGLayer::SetNextByIndex(nIndex);
+}
+
 /************************************************************************/
 /*                            BuildFields()                             */
 /*                                                                      */
@@ -2144,6 +2586,30 @@ OGRErr OGRPGTableLayer::CreateFeatureViaCopy(OGRFeature *poFeature)
     /* Tell the datasource we are now planning to copy data */
     poDS->StartCopy(this);
 
+    if (m_bCopyBinary && !CanCopyBinary(poFeature))
+    {
+        // Restart the COPY in text format, and stick to it for that layer.
+        CPLDebug("PG", "Switching to text COPY for layer %s",
+                 poFeatureDefn->GetName());
+        m_bCopyBinaryAllowed = false;
+        const int bUseCopyBackup = bUseCopy;
+        const bool bNeedToUpdateSequenceBackup = bNeedToUpdateSequence;
+        const OGRErr eErr = poDS->EndCopy();
+        bUseCopy = bUseCopyBackup;
+        bNeedToUpdateSequence = bNeedToUpdateSequenceBackup;
+        if (eErr != OGRERR_NONE)
+            return eErr;
+        poDS->StartCopy(this);
+    }
+
+    if (m_bCopyBinary)
+    {
+        std::string osRow;
+        if (!BuildCopyBinaryRow(poFeature, osRow))
+            return OGRERR_FAILURE;
+        return PutCopyData(osRow.data(), osRow.size());
+    }
+
     /* First process geometry */
     for (int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++)
     {
@@ -2217,14 +2683,25 @@ OGRErr OGRPGTableLayer::CreateFeatureViaCopy(OGRFeature *poFeature)
     /*      Execute the copy.                                       */
     /* ------------------------------------------------------------ */
 
-    OGRErr result = OGRERR_NONE;
-
-    int copyResult = PQputCopyData(hPGConn, osCommand.c_str(),
-                                   static_cast<int>(osCommand.size()));
 #ifdef DEBUG_VERBOSE
     CPLDebug("PG", "PQputCopyData(%s)", osCommand.c_str());
 #endif
 
+    return PutCopyData(osCommand.c_str(), osCommand.size());
+}
+
+/************************************************************************/
+/*                            PutCopyData()                             */
+/************************************************************************/
+
+OGRErr OGRPGTableLayer::PutCopyData(const char *pachData, size_t nSize)
+{
+    PGconn *hPGConn = poDS->GetPGConn();
+    OGRErr result = OGRERR_NONE;
+
+    int copyResult =
+        PQputCopyData(hPGConn, pachData, static_cast<int>(nSize));
+
     switch (copyResult)
     {
         case 0:
@@ -2241,6 +2718,480 @@ OGRErr OGRPGTableLayer::CreateFeatureViaCopy(OGRFeature *poFeature)
     return result;
 }
 
+/************************************************************************/
+/*                          PrepareCopyBinary()                         */
+/*                                                                      */
+/*      Determine if the COPY can use the binary format, that is if    */
+/*      the values of all its columns can be encoded in the binary     */
+/*      representation of their PostgreSQL type.                       */
+/************************************************************************/
+
+bool OGRPGTableLayer::PrepareCopyBinary()
+{
+    m_aeCopyBinaryTypes.clear();
+
+    // timestamp binary encoding assumes integer datetimes, which are
+    // mandatory since PostgreSQL 10.
+    if (!m_bCopyBinaryAllowed || poDS->sPostgreSQLVersion.nMajor < 10 ||
+        !CPLTestBool(CPLGetConfigOption("PG_USE_BINARY_COPY", "YES")))
+    {
+        return false;
+    }
+
+    PGconn *hPGConn = poDS->GetPGConn();
+    CPLString osCommand;
+    osCommand.Printf("SELECT a.attname, t.typname FROM pg_attribute a "
+                     "JOIN pg_type t ON t.oid = a.atttypid "
+                     "WHERE a.attrelid = %s::regclass AND a.attnum > 0 "
+                     "AND NOT a.attisdropped",
+                     OGRPGEscapeString(hPGConn, pszSqlTableName).c_str());
+    PGresult *hResult = OGRPG_PQexec(hPGConn, osCommand.c_str());
+    std::map<std::string, std::string> oMapColumnTypes;
+    if (hResult && PQresultStatus(hResult) == PGRES_TUPLES_OK)
+    {
+        for (int i = 0; i < PQntuples(hResult); ++i)
+        {
+            oMapColumnTypes[PQgetvalue(hResult, i, 0)] =
+                PQgetvalue(hResult, i, 1);
+        }
+    }
+    OGRPGClearResult(hResult);
+
+    const auto GetColumnType = [&oMapColumnTypes](const char *pszName)
+    {
+        const auto oIter = oMapColumnTypes.find(pszName);
+        return oIter != oMapColumnTypes.end() ? oIter->second : std::string();
+    };
+
+    for (int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++)
+    {
+        const OGRPGGeomFieldDefn *poGeomFieldDefn =
+            poFeatureDefn->GetGeomFieldDefn(i);
+        const std::string osType =
+            GetColumnType(poGeomFieldDefn->GetNameRef());
+        if (poGeomFieldDefn->ePostgisType == GEOM_TYPE_GEOMETRY &&
+            osType == "geometry")
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::GEOMETRY_EWKB);
+        else if (poGeomFieldDefn->ePostgisType == GEOM_TYPE_WKB &&
+                 osType == "bytea")
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::GEOMETRY_WKB);
+        else
+            return false;
+    }
+
+    int nFIDIndex = -1;
+    if (bFIDColumnInCopyFields)
+    {
+        nFIDIndex = poFeatureDefn->GetFieldIndex(pszFIDColumn);
+        const std::string osType = GetColumnType(pszFIDColumn);
+        if (osType == "int4")
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::INT4);
+        else if (osType == "int8")
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::INT8);
+        else
+            return false;
+    }
+
+    for (int i = 0; i < poFeatureDefn->GetFieldCount(); i++)
+    {
+        if (i == nFIDIndex || m_abGeneratedColumns[i])
+            continue;
+
+        const OGRFieldDefn *poFieldDefn = poFeatureDefn->GetFieldDefn(i);
+        const std::string osType = GetColumnType(poFieldDefn->GetNameRef());
+        const OGRFieldType eType = poFieldDefn->GetType();
+        if (eType == OFTInteger && osType == "bool")
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::BOOL);
+        else if (eType == OFTInteger && osType == "int2")
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::INT2);
+        else if (eType == OFTInteger && osType == "int4")
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::INT4);
+        else if ((eType == OFTInteger || eType == OFTInteger64) &&
+                 osType == "int8")
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::INT8);
+        else if (eType == OFTReal && osType == "float4")
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::FLOAT4);
+        else if (eType == OFTReal && osType == "float8")
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::FLOAT8);
+        else if (eType == OFTString &&
+                 (osType == "text" || osType == "varchar" ||
+                  osType == "bpchar" || osType == "json"))
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::TEXT);
+        else if (eType == OFTString && osType == "jsonb")
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::JSONB);
+        else if (eType == OFTBinary && osType == "bytea")
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::BYTEA);
+        else if (eType == OFTDate && osType == "date")
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::DATE);
+        else if (eType == OFTDateTime && osType == "timestamp")
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::TIMESTAMP);
+        else if (eType == OFTDateTime && osType == "timestamptz")
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::TIMESTAMPTZ);
+        else
+            return false;
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                           CanCopyBinary()                            */
+/*                                                                      */
+/*      Date-time values without time zone are interpreted by the      */
+/*      server in its own time zone when inserted in a timestamp with  */
+/*      time zone column, which the binary format cannot express.      */
+/************************************************************************/
+
+bool OGRPGTableLayer::CanCopyBinary(OGRFeature *poFeature) const
+{
+    const int nFIDIndex = bFIDColumnInCopyFields
+                              ? poFeatureDefn->GetFieldIndex(pszFIDColumn)
+                              : -1;
+    size_t iCol = poFeatureDefn->GetGeomFieldCount() +
+                  (bFIDColumnInCopyFields ? 1 : 0);
+    for (int i = 0; i < poFeatureDefn->GetFieldCount(); i++)
+    {
+        if (i == nFIDIndex || m_abGeneratedColumns[i])
+            continue;
+        if (m_aeCopyBinaryTypes[iCol] == CopyBinaryType::TIMESTAMPTZ &&
+            poFeature->IsFieldSetAndNotNull(i) &&
+            poFeature->GetRawFieldRef(i)->Date.TZFlag <= OGR_TZFLAG_LOCALTIME)
+        {
+            return false;
+        }
+        ++iCol;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                     Binary COPY encoding helpers                     */
+/************************************************************************/
+
+static void CopyBinaryAppendInt16(std::string &osRow, int16_t nVal)
+{
+    CPL_MSBPTR16(&nVal);
+    osRow.append(reinterpret_cast<const char *>(&nVal), sizeof(nVal));
+}
+
+static void CopyBinaryAppendInt32(std::string &osRow, int32_t nVal)
+{
+    CPL_MSBPTR32(&nVal);
+    osRow.append(reinterpret_cast<const char *>(&nVal), sizeof(nVal));
+}
+
+static void CopyBinaryAppendInt64(std::string &osRow, int64_t nVal)
+{
+    CPL_MSBPTR64(&nVal);
+    osRow.append(reinterpret_cast<const char *>(&nVal), sizeof(nVal));
+}
+
+static void CopyBinaryAppendValue(std::string &osRow, const void *pData,
+                                  size_t nSize)
+{
+    CopyBinaryAppendInt32(osRow, static_cast<int32_t>(nSize));
+    osRow.append(static_cast<const char *>(pData), nSize);
+}
+
+/************************************************************************/
+/*                         BuildCopyBinaryRow()                         */
+/************************************************************************/
+
+bool OGRPGTableLayer::BuildCopyBinaryRow(OGRFeature *poFeature,
+                                         std::string &osRow)
+{
+    constexpr int32_t NULL_LENGTH = -1;
+    // Number of seconds between 1970-01-01 and 2000-01-01, the epoch of
+    // PostgreSQL dates and timestamps
+    constexpr GIntBig POSTGRES_EPOCH_UNIX_TIME = 946684800;
+
+    CopyBinaryAppendInt16(osRow,
+                          static_cast<int16_t>(m_aeCopyBinaryTypes.size()));
+    size_t iCol = 0;
+
+    /* First process geometry */
+    for (int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++, iCol++)
+    {
+        OGRPGGeomFieldDefn *poGeomFieldDefn =
+            poFeatureDefn->GetGeomFieldDefn(i);
+        OGRGeometry *poGeom = poFeature->GetGeomFieldRef(i);
+        if (poGeom == nullptr)
+        {
+            CopyBinaryAppendInt32(osRow, NULL_LENGTH);
+            continue;
+        }
+
+        CheckGeomTypeCompatibility(i, poGeom);
+
+        poGeom->closeRings();
+        poGeom->set3D(poGeomFieldDefn->GeometryTypeFlags &
+                      OGRGeometry::OGR_G_3D);
+        poGeom->setMeasured(poGeomFieldDefn->GeometryTypeFlags &
+                            OGRGeometry::OGR_G_MEASURED);
+
+        const int nPostGISMajor = poDS->sPostGISVersion.nMajor;
+        const int nPostGISMinor = poDS->sPostGISVersion.nMinor;
+        OGRwkbVariant eWkbVariant =
+            nPostGISMajor < 2 ? wkbVariantPostGIS1 : wkbVariantOldOgc;
+        if ((nPostGISMajor > 2 || (nPostGISMajor == 2 && nPostGISMinor >= 2)) &&
+            wkbFlatten(poGeom->getGeometryType()) == wkbPoint &&
+            poGeom->IsEmpty())
+        {
+            eWkbVariant = wkbVariantIso;
+        }
+
+        std::vector<GByte> abyWKB(poGeom->WkbSize());
+        if (poGeom->exportToWkb(wkbNDR, abyWKB.data(), eWkbVariant) !=
+            OGRERR_NONE)
+        {
+            return false;
+        }
+
+        const int nSRSId = poGeomFieldDefn->nSRSId;
+        if (m_aeCopyBinaryTypes[iCol] == CopyBinaryType::GEOMETRY_EWKB &&
+            nSRSId > 0)
+        {
+            // Insert the SRID right after the geometry type, and flag it
+            // in the geometry type.
+            constexpr GUInt32 WKBSRIDFLAG = 0x20000000;
+            GUInt32 nGeomType = 0;
+            memcpy(&nGeomType, abyWKB.data() + 1, sizeof(nGeomType));
+            CPL_LSBPTR32(&nGeomType);
+            nGeomType |= WKBSRIDFLAG;
+            CPL_LSBPTR32(&nGeomType);
+            memcpy(abyWKB.data() + 1, &nGeomType, sizeof(nGeomType));
+            GUInt32 nLSBSRSId = static_cast<GUInt32>(nSRSId);
+            CPL_LSBPTR32(&nLSBSRSId);
+            const GByte *pabySRSId =
+                reinterpret_cast<const GByte *>(&nLSBSRSId);
+            abyWKB.insert(abyWKB.begin() + 5, pabySRSId,
+                          pabySRSId + sizeof(nLSBSRSId));
+        }
+        CopyBinaryAppendValue(osRow, abyWKB.data(), abyWKB.size());
+    }
+
+    int nFIDIndex = -1;
+    if (bFIDColumnInCopyFields)
+    {
+        nFIDIndex = poFeatureDefn->GetFieldIndex(pszFIDColumn);
+        const GIntBig nFID = poFeature->GetFID();
+        if (nFID == OGRNullFID)
+        {
+            CopyBinaryAppendInt32(osRow, NULL_LENGTH);
+        }
+        else if (m_aeCopyBinaryTypes[iCol] == CopyBinaryType::INT4)
+        {
+            if (nFID < INT_MIN || nFID > INT_MAX)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "FID " CPL_FRMT_GIB " is out of range for type "
+                         "integer of column %s",
+                         nFID, pszFIDColumn);
+                return false;
+            }
+            CopyBinaryAppendInt32(osRow, sizeof(int32_t));
+            CopyBinaryAppendInt32(osRow, static_cast<int32_t>(nFID));
+        }
+        else
+        {
+            CopyBinaryAppendInt32(osRow, sizeof(int64_t));
+            CopyBinaryAppendInt64(osRow, nFID);
+        }
+        iCol++;
+    }
+
+    for (int i = 0; i < poFeatureDefn->GetFieldCount(); i++)
+    {
+        if (i == nFIDIndex || m_abGeneratedColumns[i])
+            continue;
+
+        const CopyBinaryType eCopyType = m_aeCopyBinaryTypes[iCol];
+        iCol++;
+        if (!poFeature->IsFieldSetAndNotNull(i))
+        {
+            CopyBinaryAppendInt32(osRow, NULL_LENGTH);
+            continue;
+        }
+
+        const OGRFieldDefn *poFieldDefn = poFeatureDefn->GetFieldDefn(i);
+        const OGRField *psField = poFeature->GetRawFieldRef(i);
+        switch (eCopyType)
+        {
+            case CopyBinaryType::GEOMETRY_EWKB:
+            case CopyBinaryType::GEOMETRY_WKB:
+                CPLAssert(false);
+                break;
+
+            case CopyBinaryType::BOOL:
+            {
+                const char chVal = poFeature->GetFieldAsInteger(i) != 0;
+                CopyBinaryAppendValue(osRow, &chVal, 1);
+                break;
+            }
+
+            case CopyBinaryType::INT2:
+            {
+                const int nVal = poFeature->GetFieldAsInteger(i);
+                if (nVal < std::numeric_limits<int16_t>::min() ||
+                    nVal > std::numeric_limits<int16_t>::max())
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "Value %d of field %s is out of range for type "
+                             "smallint",
+                             nVal, poFieldDefn->GetNameRef());
+                    return false;
+                }
+                CopyBinaryAppendInt32(osRow, sizeof(int16_t));
+                CopyBinaryAppendInt16(osRow, static_cast<int16_t>(nVal));
+                break;
+            }
+
+            case CopyBinaryType::INT4:
+                CopyBinaryAppendInt32(osRow, sizeof(int32_t));
+                CopyBinaryAppendInt32(osRow, poFeature->GetFieldAsInteger(i));
+                break;
+
+            case CopyBinaryType::INT8:
+                CopyBinaryAppendInt32(osRow, sizeof(int64_t));
+                CopyBinaryAppendInt64(osRow,
+                                      poFeature->GetFieldAsInteger64(i));
+                break;
+
+            case CopyBinaryType::FLOAT4:
+            {
+                const double dfVal = poFeature->GetFieldAsDouble(i);
+                if (std::isfinite(dfVal) &&
+                    std::fabs(dfVal) > std::numeric_limits<float>::max())
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "Value %.17g of field %s is out of range for "
+                             "type real",
+                             dfVal, poFieldDefn->GetNameRef());
+                    return false;
+                }
+                float fVal = static_cast<float>(dfVal);
+                CPL_MSBPTR32(&fVal);
+                CopyBinaryAppendValue(osRow, &fVal, sizeof(fVal));
+                break;
+            }
+
+            case CopyBinaryType::FLOAT8:
+            {
+                double dfVal = poFeature->GetFieldAsDouble(i);
+                CPL_MSBPTR64(&dfVal);
+                CopyBinaryAppendValue(osRow, &dfVal, sizeof(dfVal));
+                break;
+            }
+
+            case CopyBinaryType::TEXT:
+            case CopyBinaryType::JSONB:
+            {
+                const char *pszStrValue = psField->String;
+                size_t nLen = strlen(pszStrValue);
+                if (poDS->IsUTF8ClientEncoding() &&
+                    !CPLIsUTF8(pszStrValue, static_cast<int>(nLen)))
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "Non UTF-8 content found when writing feature "
+                             CPL_FRMT_GIB " of layer %s: %s",
+                             poFeature->GetFID(), poFeatureDefn->GetName(),
+                             pszStrValue);
+                    return false;
+                }
+
+                // Truncate to the maximum width, in characters, as done
+                // for text COPY
+                const int nMaxWidth = poFieldDefn->GetWidth();
+                if (nMaxWidth > 0)
+                {
+                    int iUTFChar = 0;
+                    for (size_t iChar = 0; iChar < nLen; iChar++)
+                    {
+                        if ((pszStrValue[iChar] & 0xc0) != 0x80)
+                        {
+                            if (iUTFChar == nMaxWidth)
+                            {
+                                CPLDebug("PG",
+                                         "Truncated %s field value, it was "
+                                         "too long.",
+                                         poFieldDefn->GetNameRef());
+                                nLen = iChar;
+                                break;
+                            }
+                            iUTFChar++;
+                        }
+                    }
+                }
+
+                if (eCopyType == CopyBinaryType::JSONB)
+                {
+                    // jsonb binary format is a version number, followed by
+                    // the text representation
+                    CopyBinaryAppendInt32(osRow,
+                                          static_cast<int32_t>(1 + nLen));
+                    osRow += '\x01';
+                    osRow.append(pszStrValue, nLen);
+                }
+                else
+                {
+                    CopyBinaryAppendValue(osRow, pszStrValue, nLen);
+                }
+                break;
+            }
+
+            case CopyBinaryType::BYTEA:
+                CopyBinaryAppendValue(osRow, psField->Binary.paData,
+                                      psField->Binary.nCount);
+                break;
+
+            case CopyBinaryType::DATE:
+            case CopyBinaryType::TIMESTAMP:
+            case CopyBinaryType::TIMESTAMPTZ:
+            {
+                struct tm brokendowntime;
+                memset(&brokendowntime, 0, sizeof(brokendowntime));
+                brokendowntime.tm_year = psField->Date.Year - 1900;
+                brokendowntime.tm_mon = psField->Date.Month - 1;
+                brokendowntime.tm_mday = psField->Date.Day;
+                const GIntBig nSecondsSinceEpoch =
+                    CPLYMDHMSToUnixTime(&brokendowntime) -
+                    POSTGRES_EPOCH_UNIX_TIME;
+                if (eCopyType == CopyBinaryType::DATE)
+                {
+                    const int nDays =
+                        static_cast<int>(nSecondsSinceEpoch / 86400);
+                    CopyBinaryAppendInt32(osRow, sizeof(int32_t));
+                    CopyBinaryAppendInt32(osRow, nDays);
+                    break;
+                }
+
+                // Microseconds since epoch, with the millisecond precision
+                // of the text representation
+                int64_t nMicroSeconds =
+                    (nSecondsSinceEpoch + psField->Date.Hour * 3600 +
+                     psField->Date.Minute * 60) *
+                        1000000 +
+                    static_cast<int64_t>(
+                        std::round(psField->Date.Second * 1000)) *
+                        1000;
+                if (eCopyType == CopyBinaryType::TIMESTAMPTZ)
+                {
+                    CPLAssert(psField->Date.TZFlag > OGR_TZFLAG_LOCALTIME);
+                    const int nTZOffsetInMinutes =
+                        (psField->Date.TZFlag - OGR_TZFLAG_UTC) * 15;
+                    nMicroSeconds -=
+                        static_cast<int64_t>(nTZOffsetInMinutes) * 60 * 1000000;
+                }
+                CopyBinaryAppendInt32(osRow, sizeof(int64_t));
+                CopyBinaryAppendInt64(osRow, nMicroSeconds);
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
 /************************************************************************/
 /*                           TestCapability()                           */
 /************************************************************************/
@@ -3443,12 +4394,13 @@ OGRErr OGRPGTableLayer::StartCopy()
     /*CPLDebug("PG", "OGRPGDataSource(%p)::StartCopy(%p)", poDS, this);*/
 
     CPLString osFields = BuildCopyFields();
+    m_bCopyBinary = PrepareCopyBinary();
 
     size_t size = osFields.size() + strlen(pszSqlTableName) + 100;
     char *pszCommand = static_cast<char *>(CPLMalloc(size));
 
-    snprintf(pszCommand, size, "COPY %s (%s) FROM STDIN;", pszSqlTableName,
-             osFields.c_str());
+    snprintf(pszCommand, size, "COPY %s (%s) FROM STDIN%s;", pszSqlTableName,
+             osFields.c_str(), m_bCopyBinary ? " WITH (FORMAT binary)" : "");
 
     PGconn *hPGConn = poDS->GetPGConn();
     PGresult *hResult = OGRPG_PQexec(hPGConn, pszCommand);
@@ -3456,9 +4408,19 @@ OGRErr OGRPGTableLayer::StartCopy()
     if (!hResult || (PQresultStatus(hResult) != PGRES_COPY_IN))
     {
         CPLError(CE_Failure, CPLE_AppDefined, "%s", PQerrorMessage(hPGConn));
+        m_bCopyBinary = false;
     }
     else
+    {
         bCopyActive = TRUE;
+        if (m_bCopyBinary)
+        {
+            // Signature, flags field and header extension area length
+            static const char achHeader[] =
+                "PGCOPY\n\377\r\n\0\0\0\0\0\0\0\0\0";
+            PutCopyData(achHeader, sizeof(achHeader) - 1);
+        }
+    }
 
     OGRPGClearResult(hResult);
     CPLFree(pszCommand);
@@ -3486,6 +4448,14 @@ OGRErr OGRPGTableLayer::EndCopy()
 
     bCopyActive = FALSE;
 
+    if (m_bCopyBinary)
+    {
+        // File trailer: a field count of -1
+        m_bCopyBinary = false;
+        const char achTrailer[] = {'\xFF', '\xFF'};
+        result = PutCopyData(achTrailer, sizeof(achTrailer));
+    }
+
     int copyResult = PQputCopyEnd(hPGConn, nullptr);
 
     switch (copyResult)
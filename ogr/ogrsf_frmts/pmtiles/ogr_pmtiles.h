@@ -353,9 +353,12 @@ class OGRPMTilesVectorLayer final
 /*                     OGRPMTilesWriterDataset                          */
 /************************************************************************/
 
+class OGRPMTilesArchiveBuilder;
+
 class OGRPMTilesWriterDataset final : public GDALDataset
 {
-    std::unique_ptr<GDALDataset> m_poMBTilesWriterDataset{};
+    std::unique_ptr<OGRPMTilesArchiveBuilder> m_poArchiveBuilder{};
+    std::unique_ptr<GDALDataset> m_poMVTWriterDataset{};
 
   public:
     OGRPMTilesWriterDataset() = default;
@@ -41,6 +41,7 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <limits>
 #include <unordered_map>
 #include <utility>
 
@@ -48,35 +49,21 @@
 /*                         ProcessMetadata()                            */
 /************************************************************************/
 
-static bool ProcessMetadata(GDALDataset *poSQLiteDS, pmtiles::headerv3 &sHeader,
+// oMetadataItems contains the items of a MBTiles metadata table. Builds the
+// PMTiles JSON metadata from them, and fills the corresponding header fields.
+static bool ProcessMetadata(const CPLJSONObject &oMetadataItems,
+                            pmtiles::headerv3 &sHeader,
                             std::string &osMetadata)
 {
-
-    auto poMetadata = poSQLiteDS->GetLayerByName("metadata");
-    if (!poMetadata)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined, "metadata table not found");
-        return false;
-    }
-
-    const int iName = poMetadata->GetLayerDefn()->GetFieldIndex("name");
-    const int iValue = poMetadata->GetLayerDefn()->GetFieldIndex("value");
-    if (iName < 0 || iValue < 0)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "Bad structure for metadata table");
-        return false;
-    }
-
     CPLJSONObject oObj;
     CPLJSONDocument oJsonDoc;
-    for (auto &&poFeature : poMetadata)
+    for (const auto &oItem : oMetadataItems.GetChildren())
     {
-        const char *pszName = poFeature->GetFieldAsString(iName);
-        const char *pszValue = poFeature->GetFieldAsString(iValue);
-        if (EQUAL(pszName, "json"))
+        const std::string osName = oItem.GetName();
+        const std::string osValue = oItem.ToString();
+        if (EQUAL(osName.c_str(), "json"))
         {
-            if (!oJsonDoc.LoadMemory(pszValue))
+            if (!oJsonDoc.LoadMemory(osValue))
             {
                 CPLError(CE_Failure, CPLE_AppDefined,
                          "Cannot parse 'json' metadata item");
@@ -89,7 +76,7 @@ static bool ProcessMetadata(GDALDataset *poSQLiteDS, pmtiles::headerv3 &sHeader,
         }
         else
         {
-            oObj.Add(pszName, pszValue);
+            oObj.Add(osName, osValue);
         }
     }
 
@@ -191,278 +178,211 @@ static bool ProcessMetadata(GDALDataset *poSQLiteDS, pmtiles::headerv3 &sHeader,
 }
 
 /************************************************************************/
-/*                               HashArray()                            */
+/*                     ~OGRPMTilesArchiveBuilder()                      */
 /************************************************************************/
 
-// From https://codereview.stackexchange.com/questions/171999/specializing-stdhash-for-stdarray
-// We do not use std::hash<std::array<T, N>> as the name of the struct
-// because with gcc 5.4 we get the following error:
-// https://stackoverflow.com/questions/25594644/warning-specialization-of-template-in-different-namespace
-template <class T, size_t N> struct HashArray
+OGRPMTilesArchiveBuilder::~OGRPMTilesArchiveBuilder()
 {
-    CPL_NOSANITIZE_UNSIGNED_INT_OVERFLOW
-    size_t operator()(const std::array<T, N> &key) const
+    if (m_poSpoolFile)
     {
-        std::hash<T> hasher;
-        size_t result = 0;
-        for (size_t i = 0; i < N; ++i)
-        {
-            result = result * 31 + hasher(key[i]);
-        }
-        return result;
+        m_poSpoolFile.reset();
+        VSIUnlink(m_osSpoolFilename.c_str());
     }
-};
+}
 
 /************************************************************************/
-/*                    OGRPMTilesConvertFromMBTiles()                    */
+/*                               Create()                               */
 /************************************************************************/
 
-bool OGRPMTilesConvertFromMBTiles(const char *pszDestName,
-                                  const char *pszSrcName)
+bool OGRPMTilesArchiveBuilder::Create(const char *pszDestName)
 {
-    const char *const apszAllowedDrivers[] = {"SQLite", nullptr};
-    auto poSQLiteDS = std::unique_ptr<GDALDataset>(
-        GDALDataset::Open(pszSrcName, GDAL_OF_VECTOR, apszAllowedDrivers));
-    if (!poSQLiteDS)
+    m_osDestName = pszDestName;
+
+    // Temporary file that contains the distinct tile contents, in the order
+    // they are received.
+    m_osSpoolFilename = std::string(pszDestName) + ".tmp";
+    if (!VSIIsLocal(pszDestName))
     {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "Cannot open %s with SQLite driver", pszSrcName);
-        return false;
+        m_osSpoolFilename =
+            CPLGenerateTempFilename(CPLGetFilename(pszDestName));
     }
 
-    pmtiles::headerv3 sHeader;
-    std::string osMetadata;
-    if (!ProcessMetadata(poSQLiteDS.get(), sHeader, osMetadata))
+    m_poSpoolFile =
+        VSIVirtualHandleUniquePtr(VSIFOpenL(m_osSpoolFilename.c_str(), "wb+"));
+    VSIUnlink(m_osSpoolFilename.c_str());
+    if (!m_poSpoolFile)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot open %s for write",
+                 m_osSpoolFilename.c_str());
         return false;
+    }
+    return true;
+}
 
-    auto poTilesLayer = poSQLiteDS->GetLayerByName("tiles");
-    if (!poTilesLayer)
+/************************************************************************/
+/*                             WriteTile()                              */
+/************************************************************************/
+
+bool OGRPMTilesArchiveBuilder::WriteTile(int nZ, int nX, int nY,
+                                         const GByte *pabyData,
+                                         size_t nDataSize)
+{
+    TileEntry sEntry;
+    try
     {
-        CPLError(CE_Failure, CPLE_AppDefined, "tiles table not found");
+        sEntry.nTileId =
+            pmtiles::zxy_to_tileid(static_cast<uint8_t>(nZ), nX, nY);
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot compute tile id: %s",
+                 e.what());
         return false;
     }
 
-    const int iZoomLevel =
-        poTilesLayer->GetLayerDefn()->GetFieldIndex("zoom_level");
-    const int iTileColumn =
-        poTilesLayer->GetLayerDefn()->GetFieldIndex("tile_column");
-    const int iTileRow =
-        poTilesLayer->GetLayerDefn()->GetFieldIndex("tile_row");
-    const int iTileData =
-        poTilesLayer->GetLayerDefn()->GetFieldIndex("tile_data");
-    if (iZoomLevel < 0 || iTileColumn < 0 || iTileRow < 0 || iTileData < 0)
+    if (nDataSize > std::numeric_limits<uint32_t>::max())
     {
-        CPLError(CE_Failure, CPLE_AppDefined, "Bad structure for tiles table");
+        CPLError(CE_Failure, CPLE_NotSupported, "Too large tile %d/%d/%d", nZ,
+                 nX, nY);
         return false;
     }
 
-    struct TileEntry
-    {
-        uint64_t nTileId;
-        std::array<unsigned char, 16> abyMD5;
-    };
+    // Compute a hash of the tile data for deduplication
+    CPLMD5Context md5context;
+    CPLMD5Init(&md5context);
+    CPLMD5Update(&md5context, pabyData, nDataSize);
+    CPLMD5Final(&sEntry.abyMD5[0], &md5context);
 
-    // In a first step browse through the tiles table to compute the PMTiles
-    // tile_id of each tile, and compute a hash of the tile data for
-    // deduplication
-    std::vector<TileEntry> asTileEntries;
-    for (auto &&poFeature : poTilesLayer)
+    try
     {
-        const int nZoomLevel = poFeature->GetFieldAsInteger(iZoomLevel);
-        if (nZoomLevel < 0 || nZoomLevel > 30)
+        if (m_oMapMD5ToSpoolOffsetLen.find(sEntry.abyMD5) ==
+            m_oMapMD5ToSpoolOffsetLen.end())
         {
-            CPLError(CE_Warning, CPLE_AppDefined,
-                     "Skipping tile with missing or invalid zoom_level");
-            continue;
-        }
-        const int nColumn = poFeature->GetFieldAsInteger(iTileColumn);
-        if (nColumn < 0 || nColumn >= (1 << nZoomLevel))
-        {
-            CPLError(CE_Warning, CPLE_AppDefined,
-                     "Skipping tile with missing or invalid tile_column");
-            continue;
-        }
-        const int nRow = poFeature->GetFieldAsInteger(iTileRow);
-        if (nRow < 0 || nRow >= (1 << nZoomLevel))
-        {
-            CPLError(CE_Warning, CPLE_AppDefined,
-                     "Skipping tile with missing or invalid tile_row");
-            continue;
-        }
-        // MBTiles uses a 0=bottom-most row, whereas PMTiles uses
-        // 0=top-most row
-        const int nY = (1 << nZoomLevel) - 1 - nRow;
-        uint64_t nTileId;
-        try
-        {
-            nTileId = pmtiles::zxy_to_tileid(static_cast<uint8_t>(nZoomLevel),
-                                             nColumn, nY);
-        }
-        catch (const std::exception &e)
-        {
-            // shouldn't happen given previous checks
-            CPLError(CE_Failure, CPLE_AppDefined, "Cannot compute tile id: %s",
-                     e.what());
-            return false;
-        }
-        int nTileDataLength = 0;
-        const GByte *pabyData =
-            poFeature->GetFieldAsBinary(iTileData, &nTileDataLength);
-        if (!pabyData)
-        {
-            CPLError(CE_Failure, CPLE_AppDefined, "Missing tile_data");
-            return false;
+            if (nDataSize > 0 &&
+                m_poSpoolFile->Write(pabyData, nDataSize, 1) != 1)
+            {
+                CPLError(CE_Failure, CPLE_FileIO, "Failed writing");
+                return false;
+            }
+            m_oMapMD5ToSpoolOffsetLen[sEntry.abyMD5] =
+                std::pair<uint64_t, uint32_t>(
+                    m_nSpoolSize, static_cast<uint32_t>(nDataSize));
+            m_nSpoolSize += nDataSize;
         }
+        m_asTileEntries.push_back(sEntry);
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Out of memory browsing through tiles: %s", e.what());
+        return false;
+    }
 
-        TileEntry sEntry;
-        sEntry.nTileId = nTileId;
+    return true;
+}
 
-        CPLMD5Context md5context;
-        CPLMD5Init(&md5context);
-        CPLMD5Update(&md5context, pabyData, nTileDataLength);
-        CPLMD5Final(&sEntry.abyMD5[0], &md5context);
-        try
-        {
-            asTileEntries.push_back(sEntry);
-        }
-        catch (const std::exception &e)
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Out of memory browsing through tiles: %s", e.what());
-            return false;
-        }
-    }
+/************************************************************************/
+/*                            WriteMetadata()                           */
+/************************************************************************/
 
-    // Sort the tiles by ascending tile_id. This is a requirement to build
-    // the PMTiles directories.
-    std::sort(asTileEntries.begin(), asTileEntries.end(),
-              [](const TileEntry &a, const TileEntry &b)
-              { return a.nTileId < b.nTileId; });
+bool OGRPMTilesArchiveBuilder::WriteMetadata(const CPLJSONObject &oMetadata)
+{
+    m_bMetadataSet = ProcessMetadata(oMetadata, m_sHeader, m_osMetadata);
+    return m_bMetadataSet;
+}
 
-    // Let's build a temporary file that contains the tile data in
-    // a way that corresponds to the "clustered" mode, that is
-    // "offsets are either contiguous with the previous offset+length, or
-    // refer to a lesser offset, when writing with deduplication."
-    std::string osTmpFile(std::string(pszDestName) + ".tmp");
-    if (!VSIIsLocal(pszDestName))
-    {
-        osTmpFile = CPLGenerateTempFilename(CPLGetFilename(pszDestName));
-    }
+/************************************************************************/
+/*                              Finalize()                              */
+/************************************************************************/
 
-    auto poTmpFile =
-        VSIVirtualHandleUniquePtr(VSIFOpenL(osTmpFile.c_str(), "wb+"));
-    VSIUnlink(osTmpFile.c_str());
-    if (!poTmpFile)
+bool OGRPMTilesArchiveBuilder::Finalize()
+{
+    if (!m_bMetadataSet || !m_poSpoolFile)
     {
-        CPLError(CE_Failure, CPLE_FileIO, "Cannot open %s for write",
-                 osTmpFile.c_str());
+        CPLError(CE_Failure, CPLE_AppDefined, "Missing metadata");
         return false;
     }
 
-    struct ResetAndUnlinkTmpFile
-    {
-        VSIVirtualHandleUniquePtr &m_poFile;
-        std::string m_osFilename;
-
-        ResetAndUnlinkTmpFile(VSIVirtualHandleUniquePtr &poFile,
-                              const std::string &osFilename)
-            : m_poFile(poFile), m_osFilename(osFilename)
-        {
-        }
-
-        ~ResetAndUnlinkTmpFile()
-        {
-            m_poFile.reset();
-            VSIUnlink(m_osFilename.c_str());
-        }
-    };
-    ResetAndUnlinkTmpFile oReseer(poTmpFile, osTmpFile);
+    // Sort the tiles by ascending tile_id. This is a requirement to build
+    // the PMTiles directories.
+    std::sort(m_asTileEntries.begin(), m_asTileEntries.end(),
+              [](const TileEntry &a, const TileEntry &b)
+              { return a.nTileId < b.nTileId; });
 
+    // Assign offsets to tile contents in a way that corresponds to the
+    // "clustered" mode, that is "offsets are either contiguous with the
+    // previous offset+length, or refer to a lesser offset, when writing with
+    // deduplication."
     std::vector<pmtiles::entryv3> asPMTilesEntries;
+    // Offset and length in the spool file of each tile content, in the order
+    // they must be written in the final file
+    std::vector<std::pair<uint64_t, uint32_t>> anSpoolOffsetLen;
     uint64_t nLastTileId = 0;
     uint64_t nFileOffset = 0;
-    std::array<unsigned char, 16> abyLastMD5;
+    uint32_t nMaxTileDataLength = 0;
+    std::array<unsigned char, 16> abyLastMD5{};
     std::unordered_map<std::array<unsigned char, 16>,
                        std::pair<uint64_t, uint32_t>,
                        HashArray<unsigned char, 16>>
         oMapMD5ToOffsetLen;
-    for (const auto &sEntry : asTileEntries)
+    try
     {
-        if (sEntry.nTileId == nLastTileId + 1 && sEntry.abyMD5 == abyLastMD5)
+        for (const auto &sEntry : m_asTileEntries)
         {
-            // If the tile id immediately follows the previous one and
-            // has the same tile data, increase the run_length
-            asPMTilesEntries.back().run_length++;
-        }
-        else
-        {
-            pmtiles::entryv3 sPMTilesEntry;
-            sPMTilesEntry.tile_id = sEntry.nTileId;
-            sPMTilesEntry.run_length = 1;
-
-            auto oIter = oMapMD5ToOffsetLen.find(sEntry.abyMD5);
-            if (oIter != oMapMD5ToOffsetLen.end())
+            if (!asPMTilesEntries.empty() &&
+                sEntry.nTileId == nLastTileId + 1 &&
+                sEntry.abyMD5 == abyLastMD5)
             {
-                // Point to previously written tile data if this content
-                // has already been written
-                sPMTilesEntry.offset = oIter->second.first;
-                sPMTilesEntry.length = oIter->second.second;
+                // If the tile id immediately follows the previous one and
+                // has the same tile data, increase the run_length
+                asPMTilesEntries.back().run_length++;
             }
             else
             {
-                try
-                {
-                    const auto sXYZ = pmtiles::tileid_to_zxy(sEntry.nTileId);
-                    poTilesLayer->SetAttributeFilter(CPLSPrintf(
-                        "zoom_level = %d AND tile_column = %u AND tile_row = "
-                        "%u",
-                        sXYZ.z, sXYZ.x, (1U << sXYZ.z) - 1U - sXYZ.y));
-                }
-                catch (const std::exception &e)
-                {
-                    // shouldn't happen given previous checks
-                    CPLError(CE_Failure, CPLE_AppDefined,
-                             "Cannot compute xyz: %s", e.what());
-                    return false;
-                }
-                poTilesLayer->ResetReading();
-                auto poFeature =
-                    std::unique_ptr<OGRFeature>(poTilesLayer->GetNextFeature());
-                if (!poFeature)
+                pmtiles::entryv3 sPMTilesEntry;
+                sPMTilesEntry.tile_id = sEntry.nTileId;
+                sPMTilesEntry.run_length = 1;
+
+                auto oIter = oMapMD5ToOffsetLen.find(sEntry.abyMD5);
+                if (oIter != oMapMD5ToOffsetLen.end())
                 {
-                    CPLError(CE_Failure, CPLE_AppDefined, "Cannot find tile");
-                    return false;
+                    // Point to previously written tile data if this content
+                    // has already been written
+                    sPMTilesEntry.offset = oIter->second.first;
+                    sPMTilesEntry.length = oIter->second.second;
                 }
-                int nTileDataLength = 0;
-                const GByte *pabyData =
-                    poFeature->GetFieldAsBinary(iTileData, &nTileDataLength);
-                if (!pabyData)
+                else
                 {
-                    CPLError(CE_Failure, CPLE_AppDefined, "Missing tile_data");
-                    return false;
-                }
-
-                sPMTilesEntry.offset = nFileOffset;
-                sPMTilesEntry.length = nTileDataLength;
+                    const auto &oSpoolOffsetLen =
+                        m_oMapMD5ToSpoolOffsetLen[sEntry.abyMD5];
+                    const uint32_t nTileDataLength = oSpoolOffsetLen.second;
 
-                oMapMD5ToOffsetLen[sEntry.abyMD5] =
-                    std::pair<uint64_t, uint32_t>(nFileOffset, nTileDataLength);
+                    sPMTilesEntry.offset = nFileOffset;
+                    sPMTilesEntry.length = nTileDataLength;
 
-                nFileOffset += nTileDataLength;
+                    oMapMD5ToOffsetLen[sEntry.abyMD5] =
+                        std::pair<uint64_t, uint32_t>(nFileOffset,
+                                                      nTileDataLength);
+                    anSpoolOffsetLen.push_back(oSpoolOffsetLen);
 
-                if (poTmpFile->Write(pabyData, nTileDataLength, 1) != 1)
-                {
-                    CPLError(CE_Failure, CPLE_FileIO, "Failed writing");
-                    return false;
+                    nFileOffset += nTileDataLength;
+                    nMaxTileDataLength =
+                        std::max(nMaxTileDataLength, nTileDataLength);
                 }
-            }
 
-            asPMTilesEntries.push_back(sPMTilesEntry);
+                asPMTilesEntries.push_back(sPMTilesEntry);
 
-            nLastTileId = sEntry.nTileId;
-            abyLastMD5 = sEntry.abyMD5;
+                nLastTileId = sEntry.nTileId;
+                abyLastMD5 = sEntry.abyMD5;
+            }
         }
     }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Out of memory building tile entries: %s", e.what());
+        return false;
+    }
 
     const CPLCompressor *psCompressor = CPLGetCompressor("gzip");
     assert(psCompressor);
@@ -500,7 +420,7 @@ bool OGRPMTilesConvertFromMBTiles(const char *pszDestName,
     try
     {
         osCompressedMetadata =
-            oCompressFunc(osMetadata, pmtiles::COMPRESSION_GZIP);
+            oCompressFunc(m_osMetadata, pmtiles::COMPRESSION_GZIP);
 
         // Build the root and leave directories (one depth max)
         std::tie(osRootBytes, osLeaveBytes, nNumLeaves) =
@@ -516,6 +436,7 @@ bool OGRPMTilesConvertFromMBTiles(const char *pszDestName,
 
     // Finalize the header fields related to offsets and size of the
     // different parts of the file
+    pmtiles::headerv3 &sHeader = m_sHeader;
     sHeader.root_dir_bytes = osRootBytes.size();
     sHeader.json_metadata_offset =
         sHeader.root_dir_offset + sHeader.root_dir_bytes;
@@ -529,7 +450,7 @@ bool OGRPMTilesConvertFromMBTiles(const char *pszDestName,
 
     // Nomber of tiles that are addressable in the PMTiles archive, that is
     // the number of tiles we would have if not deduplicating them
-    sHeader.addressed_tiles_count = asTileEntries.size();
+    sHeader.addressed_tiles_count = m_asTileEntries.size();
 
     // Number of tile entries in root and leave directories
     // ie entries whose run_length >= 1
@@ -539,17 +460,17 @@ bool OGRPMTilesConvertFromMBTiles(const char *pszDestName,
     sHeader.tile_contents_count = oMapMD5ToOffsetLen.size();
 
     // Now build the final file!
-    auto poFile = VSIVirtualHandleUniquePtr(VSIFOpenL(pszDestName, "wb"));
+    auto poFile =
+        VSIVirtualHandleUniquePtr(VSIFOpenL(m_osDestName.c_str(), "wb"));
     if (!poFile)
     {
         CPLError(CE_Failure, CPLE_FileIO, "Cannot open %s for write",
-                 pszDestName);
+                 m_osDestName.c_str());
         return false;
     }
     const auto osHeader = sHeader.serialize();
 
-    if (poTmpFile->Seek(0, SEEK_SET) != 0 ||
-        poFile->Write(osHeader.data(), osHeader.size(), 1) != 1 ||
+    if (poFile->Write(osHeader.data(), osHeader.size(), 1) != 1 ||
         poFile->Write(osRootBytes.data(), osRootBytes.size(), 1) != 1 ||
         poFile->Write(osCompressedMetadata.data(), osCompressedMetadata.size(),
                       1) != 1 ||
@@ -560,22 +481,22 @@ bool OGRPMTilesConvertFromMBTiles(const char *pszDestName,
         return false;
     }
 
-    // Copy content of the temporary file at end of the output file.
+    // Copy the tile contents from the spool file at end of the output file,
+    // by increasing tile id.
     std::string oCopyBuffer;
-    oCopyBuffer.resize(1024 * 1024);
-    const uint64_t nTotalSize = nFileOffset;
-    nFileOffset = 0;
-    while (nFileOffset < nTotalSize)
-    {
-        const size_t nToRead = static_cast<size_t>(
-            std::min<uint64_t>(nTotalSize - nFileOffset, oCopyBuffer.size()));
-        if (poTmpFile->Read(&oCopyBuffer[0], nToRead, 1) != 1 ||
-            poFile->Write(&oCopyBuffer[0], nToRead, 1) != 1)
+    oCopyBuffer.resize(nMaxTileDataLength);
+    for (const auto &oSpoolOffsetLen : anSpoolOffsetLen)
+    {
+        const uint32_t nTileDataLength = oSpoolOffsetLen.second;
+        if (nTileDataLength == 0)
+            continue;
+        if (m_poSpoolFile->Seek(oSpoolOffsetLen.first, SEEK_SET) != 0 ||
+            m_poSpoolFile->Read(&oCopyBuffer[0], nTileDataLength, 1) != 1 ||
+            poFile->Write(&oCopyBuffer[0], nTileDataLength, 1) != 1)
         {
             CPLError(CE_Failure, CPLE_FileIO, "Failed writing");
             return false;
         }
-        nFileOffset += nToRead;
     }
 
     if (poFile->Close() != 0)
@@ -583,3 +504,119 @@ bool OGRPMTilesConvertFromMBTiles(const char *pszDestName,
 
     return true;
 }
+
+/************************************************************************/
+/*                    OGRPMTilesConvertFromMBTiles()                    */
+/************************************************************************/
+
+bool OGRPMTilesConvertFromMBTiles(const char *pszDestName,
+                                  const char *pszSrcName)
+{
+    const char *const apszAllowedDrivers[] = {"SQLite", nullptr};
+    auto poSQLiteDS = std::unique_ptr<GDALDataset>(
+        GDALDataset::Open(pszSrcName, GDAL_OF_VECTOR, apszAllowedDrivers));
+    if (!poSQLiteDS)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot open %s with SQLite driver", pszSrcName);
+        return false;
+    }
+
+    auto poMetadata = poSQLiteDS->GetLayerByName("metadata");
+    if (!poMetadata)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "metadata table not found");
+        return false;
+    }
+
+    const int iName = poMetadata->GetLayerDefn()->GetFieldIndex("name");
+    const int iValue = poMetadata->GetLayerDefn()->GetFieldIndex("value");
+    if (iName < 0 || iValue < 0)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Bad structure for metadata table");
+        return false;
+    }
+
+    CPLJSONObject oMetadataItems;
+    for (auto &&poFeature : poMetadata)
+    {
+        oMetadataItems.Add(poFeature->GetFieldAsString(iName),
+                           poFeature->GetFieldAsString(iValue));
+    }
+
+    OGRPMTilesArchiveBuilder oBuilder;
+    if (!oBuilder.WriteMetadata(oMetadataItems))
+        return false;
+
+    auto poTilesLayer = poSQLiteDS->GetLayerByName("tiles");
+    if (!poTilesLayer)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "tiles table not found");
+        return false;
+    }
+
+    const int iZoomLevel =
+        poTilesLayer->GetLayerDefn()->GetFieldIndex("zoom_level");
+    const int iTileColumn =
+        poTilesLayer->GetLayerDefn()->GetFieldIndex("tile_column");
+    const int iTileRow =
+        poTilesLayer->GetLayerDefn()->GetFieldIndex("tile_row");
+    const int iTileData =
+        poTilesLayer->GetLayerDefn()->GetFieldIndex("tile_data");
+    if (iZoomLevel < 0 || iTileColumn < 0 || iTileRow < 0 || iTileData < 0)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Bad structure for tiles table");
+        return false;
+    }
+
+    if (!oBuilder.Create(pszDestName))
+        return false;
+
+    // Browse through the tiles table a single time, and hand over each
+    // tile to the builder, that takes care of deduplication.
+    for (auto &&poFeature : poTilesLayer)
+    {
+        const int nZoomLevel = poFeature->GetFieldAsInteger(iZoomLevel);
+        if (nZoomLevel < 0 || nZoomLevel > 30)
+        {
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "Skipping tile with missing or invalid zoom_level");
+            continue;
+        }
+        const int nColumn = poFeature->GetFieldAsInteger(iTileColumn);
+        if (nColumn < 0 || nColumn >= (1 << nZoomLevel))
+        {
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "Skipping tile with missing or invalid tile_column");
+            continue;
+        }
+        const int nRow = poFeature->GetFieldAsInteger(iTileRow);
+        if (nRow < 0 || nRow >= (1 << nZoomLevel))
+        {
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "Skipping tile with missing or invalid tile_row");
+            continue;
+        }
+        // MBTiles uses a 0=bottom-most row, whereas PMTiles uses
+        // 0=top-most row
+        const int nY = (1 << nZoomLevel) - 1 - nRow;
+
+        int nTileDataLength = 0;
+        const GByte *pabyData =
+            poFeature->GetFieldAsBinary(iTileData, &nTileDataLength);
+        if (!pabyData)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "Missing tile_data");
+            return false;
+        }
+
+        if (!oBuilder.WriteTile(nZoomLevel, nColumn, nY, pabyData,
+                                static_cast<size_t>(nTileDataLength)))
+        {
+            return false;
+        }
+    }
+
+    return oBuilder.Finalize();
+}
@@ -30,6 +30,85 @@
 #define OGRPMTILESFROMMBTILES_H_INCLUDED
 
 #include "gdal_priv.h"
+#include "cpl_vsi_virtual.h"
+
+#include "include_pmtiles.h"
+#include "mvtutils.h"
+
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/************************************************************************/
+/*                               HashArray()                            */
+/************************************************************************/
+
+// From https://codereview.stackexchange.com/questions/171999/specializing-stdhash-for-stdarray
+// We do not use std::hash<std::array<T, N>> as the name of the struct
+// because with gcc 5.4 we get the following error:
+// https://stackoverflow.com/questions/25594644/warning-specialization-of-template-in-different-namespace
+template <class T, size_t N> struct HashArray
+{
+    CPL_NOSANITIZE_UNSIGNED_INT_OVERFLOW
+    size_t operator()(const std::array<T, N> &key) const
+    {
+        std::hash<T> hasher;
+        size_t result = 0;
+        for (size_t i = 0; i < N; ++i)
+        {
+            result = result * 31 + hasher(key[i]);
+        }
+        return result;
+    }
+};
+
+/************************************************************************/
+/*                       OGRPMTilesArchiveBuilder                       */
+/************************************************************************/
+
+// Builds a PMTiles archive from MVT tiles received in any order.
+// Tile data is deduplicated on the fly and distinct contents are spooled in
+// a temporary file, from which they are copied by increasing tile id into
+// the final file by Finalize(), once the directories have been built.
+class OGRPMTilesArchiveBuilder final : public OGRMVTTileSink
+{
+    struct TileEntry
+    {
+        uint64_t nTileId;
+        std::array<unsigned char, 16> abyMD5;
+    };
+
+    std::string m_osDestName{};
+    std::string m_osSpoolFilename{};
+    VSIVirtualHandleUniquePtr m_poSpoolFile{};
+    uint64_t m_nSpoolSize = 0;
+    std::vector<TileEntry> m_asTileEntries{};
+    // Offset in the spool file and length of each distinct tile content
+    std::unordered_map<std::array<unsigned char, 16>,
+                       std::pair<uint64_t, uint32_t>,
+                       HashArray<unsigned char, 16>>
+        m_oMapMD5ToSpoolOffsetLen{};
+    pmtiles::headerv3 m_sHeader{};
+    std::string m_osMetadata{};
+    bool m_bMetadataSet = false;
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRPMTilesArchiveBuilder)
+
+  public:
+    OGRPMTilesArchiveBuilder() = default;
+    ~OGRPMTilesArchiveBuilder() override;
+
+    bool Create(const char *pszDestName);
+
+    bool WriteTile(int nZ, int nX, int nY, const GByte *pabyData,
+                   size_t nDataSize) override;
+
+    bool WriteMetadata(const CPLJSONObject &oMetadata) override;
+
+    bool Finalize();
+};
 
 bool OGRPMTilesConvertFromMBTiles(const char *pszDestName,
                                   const char *pszSrcName);
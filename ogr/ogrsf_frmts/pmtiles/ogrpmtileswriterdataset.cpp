@@ -51,24 +51,18 @@ CPLErr OGRPMTilesWriterDataset::Close()
     CPLErr eErr = CE_None;
     if (nOpenFlags != OPEN_FLAGS_CLOSED)
     {
-        if (m_poMBTilesWriterDataset)
+        if (m_poMVTWriterDataset)
         {
-            if (m_poMBTilesWriterDataset->Close() != CE_None)
+            // Closing the MVT writer generates the tiles and metadata, that
+            // are streamed into the archive builder.
+            if (m_poMVTWriterDataset->Close() != CE_None ||
+                !m_poArchiveBuilder->Finalize())
             {
                 eErr = CE_Failure;
             }
-            else
-            {
-                if (!OGRPMTilesConvertFromMBTiles(
-                        GetDescription(),
-                        m_poMBTilesWriterDataset->GetDescription()))
-                {
-                    eErr = CE_Failure;
-                }
-            }
 
-            VSIUnlink(m_poMBTilesWriterDataset->GetDescription());
-            m_poMBTilesWriterDataset.reset();
+            m_poMVTWriterDataset.reset();
+            m_poArchiveBuilder.reset();
         }
 
         if (GDALDataset::Close() != CE_None)
@@ -86,26 +80,28 @@ bool OGRPMTilesWriterDataset::Create(const char *pszFilename,
 {
     SetDescription(pszFilename);
     CPLStringList aosOptions(papszOptions);
-    aosOptions.SetNameValue("FORMAT", "MBTILES");
-
-    // Let's build a temporary file that contains the tile data in
-    // a way that corresponds to the "clustered" mode, that is
-    // "offsets are either contiguous with the previous offset+length, or
-    // refer to a lesser offset, when writing with deduplication."
-    std::string osTmpFile(pszFilename);
-    if (!VSIIsLocal(pszFilename))
-    {
-        osTmpFile = CPLGenerateTempFilename(CPLGetFilename(pszFilename));
-    }
-    osTmpFile += ".tmp.mbtiles";
 
     if (!aosOptions.FetchNameValue("NAME"))
         aosOptions.SetNameValue("NAME", CPLGetBasename(pszFilename));
 
-    m_poMBTilesWriterDataset.reset(OGRMVTWriterDatasetCreate(
-        osTmpFile.c_str(), 0, 0, 0, GDT_Unknown, aosOptions.List()));
+    // The MVT writer needs a temporary database on a local file system
+    if (!aosOptions.FetchNameValue("TEMPORARY_DB") && !VSIIsLocal(pszFilename))
+    {
+        aosOptions.SetNameValue(
+            "TEMPORARY_DB",
+            (std::string(CPLGenerateTempFilename(CPLGetFilename(pszFilename))) +
+             ".temp.db")
+                .c_str());
+    }
+
+    m_poArchiveBuilder = std::make_unique<OGRPMTilesArchiveBuilder>();
+    if (!m_poArchiveBuilder->Create(pszFilename))
+        return false;
+
+    m_poMVTWriterDataset.reset(OGRMVTWriterDatasetCreate(
+        pszFilename, aosOptions.List(), m_poArchiveBuilder.get()));
 
-    return m_poMBTilesWriterDataset != nullptr;
+    return m_poMVTWriterDataset != nullptr;
 }
 
 /************************************************************************/
@@ -116,8 +112,8 @@ OGRLayer *OGRPMTilesWriterDataset::ICreateLayer(
     const char *pszLayerName, const OGRSpatialReference *poSRS,
     OGRwkbGeometryType eGeomType, char **papszOptions)
 {
-    return m_poMBTilesWriterDataset->CreateLayer(pszLayerName, poSRS, eGeomType,
-                                                 papszOptions);
+    return m_poMVTWriterDataset->CreateLayer(pszLayerName, poSRS, eGeomType,
+                                             papszOptions);
 }
 
 /************************************************************************/
@@ -126,7 +122,7 @@ OGRLayer *OGRPMTilesWriterDataset::ICreateLayer(
 
 int OGRPMTilesWriterDataset::TestCapability(const char *pszCap)
 {
-    return m_poMBTilesWriterDataset->TestCapability(pszCap);
+    return m_poMVTWriterDataset->TestCapability(pszCap);
 }
 
 #endif  // HAVE_MVT_WRITE_SUPPORT
@@ -40,6 +40,8 @@
 #include "shapefil.h"
 #include "shp_vsi.h"
 #include "ogrlayerpool.h"
+#include <limits>
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -109,6 +111,32 @@ class OGRShapeGeomFieldDefn final : public OGRGeomFieldDefn
     }
 };
 
+/************************************************************************/
+/*                       OGRShapePackedRTreeIndex                       */
+/************************************************************************/
+
+/** Packed Hilbert R-tree spatial index, stored in a .hrt sidecar file. */
+class OGRShapePackedRTreeIndex
+{
+    CPL_DISALLOW_COPY_ASSIGN(OGRShapePackedRTreeIndex)
+
+    VSILFILE *m_fp = nullptr;
+    uint64_t m_nItems = 0;
+    uint16_t m_nNodeSize = 0;
+    std::vector<GByte> m_abyInternalNodes{};
+
+    OGRShapePackedRTreeIndex() = default;
+
+  public:
+    ~OGRShapePackedRTreeIndex();
+
+    static std::unique_ptr<OGRShapePackedRTreeIndex>
+    Open(const char *pszFilename, int nExpectedRecords);
+    static bool Create(SHPHandle hSHP, const char *pszFilename);
+
+    int *Search(const OGREnvelope &sEnvelope, int *pnCount) const;
+};
+
 /************************************************************************/
 /*                            OGRShapeLayer                             */
 /************************************************************************/
@@ -124,6 +152,8 @@ class OGRShapeLayer final : public OGRAbstractProxiedLayer
     OGRFeatureDefn *poFeatureDefn;
     int iNextShapeId;
     int nTotalShapeCount;
+    int m_nPartitionStart = 0;
+    int m_nPartitionEnd = std::numeric_limits<int>::max();
 
     char *pszFullName;
 
@@ -156,6 +186,10 @@ class OGRShapeLayer final : public OGRAbstractProxiedLayer
     SBNSearchHandle hSBN;
     bool CheckForSBN();
 
+    bool m_bCheckedForPackedRTree = false;
+    std::unique_ptr<OGRShapePackedRTreeIndex> m_poPackedRTree{};
+    bool CheckForPackedRTree();
+
     bool bSbnSbxDeleted;
 
     CPLString ConvertCodePage(const char *);
@@ -210,6 +244,7 @@ class OGRShapeLayer final : public OGRAbstractProxiedLayer
 
   public:
     OGRErr CreateSpatialIndex(int nMaxDepth);
+    OGRErr CreatePackedRTreeIndex();
     OGRErr DropSpatialIndex();
     OGRErr Repack();
     OGRErr RecomputeExtent();
@@ -239,6 +274,10 @@ class OGRShapeLayer final : public OGRAbstractProxiedLayer
 
     GDALDataset *GetDataset() override;
 
+    std::vector<std::unique_ptr<OGRLayerPartition>>
+    GetPartitions(int nMaxPartitions) override;
+    void SetPartitionRange(int nStart, int nEnd);
+
     void ResetReading() override;
     OGRFeature *GetNextFeature() override;
     OGRErr SetNextByIndex(GIntBig nIndex) override;
@@ -1086,6 +1086,7 @@ OGRLayer *OGRShapeDataSource::GetLayerByName(const char *pszLayerNameIn)
 /*      SPATIAL INDEX commands.  Support forms are:                     */
 /*                                                                      */
 /*        CREATE SPATIAL INDEX ON layer_name [DEPTH n]                  */
+/*        CREATE SPATIAL INDEX ON layer_name TYPE PACKED_RTREE          */
 /*        DROP SPATIAL INDEX ON layer_name                              */
 /*        REPACK layer_name                                             */
 /*        RECOMPUTE EXTENT ON layer_name                                */
@@ -1223,22 +1224,28 @@ OGRLayer *OGRShapeDataSource::ExecuteSQL(const char *pszStatement,
     if (CSLCount(papszTokens) < 5 || !EQUAL(papszTokens[0], "CREATE") ||
         !EQUAL(papszTokens[1], "SPATIAL") || !EQUAL(papszTokens[2], "INDEX") ||
         !EQUAL(papszTokens[3], "ON") || CSLCount(papszTokens) > 7 ||
-        (CSLCount(papszTokens) == 7 && !EQUAL(papszTokens[5], "DEPTH")))
+        (CSLCount(papszTokens) == 7 && !EQUAL(papszTokens[5], "DEPTH") &&
+         !(EQUAL(papszTokens[5], "TYPE") &&
+           EQUAL(papszTokens[6], "PACKED_RTREE"))))
     {
         CSLDestroy(papszTokens);
         CPLError(CE_Failure, CPLE_AppDefined,
                  "Syntax error in CREATE SPATIAL INDEX command.\n"
                  "Was '%s'\n"
                  "Should be of form 'CREATE SPATIAL INDEX ON <table> "
-                 "[DEPTH <n>]'",
+                 "[DEPTH <n>|TYPE PACKED_RTREE]'",
                  pszStatement);
         return nullptr;
     }
 
     /* -------------------------------------------------------------------- */
-    /*      Get depth if provided.                                          */
+    /*      Get depth or index type if provided.                            */
     /* -------------------------------------------------------------------- */
-    const int nDepth = CSLCount(papszTokens) == 7 ? atoi(papszTokens[6]) : 0;
+    const bool bPackedRTree =
+        CSLCount(papszTokens) == 7 && EQUAL(papszTokens[5], "TYPE");
+    const int nDepth = CSLCount(papszTokens) == 7 && !bPackedRTree
+                           ? atoi(papszTokens[6])
+                           : 0;
 
     /* -------------------------------------------------------------------- */
     /*      What layer are we operating on.                                 */
@@ -1256,7 +1263,10 @@ OGRLayer *OGRShapeDataSource::ExecuteSQL(const char *pszStatement,
 
     CSLDestroy(papszTokens);
 
-    poLayer->CreateSpatialIndex(nDepth);
+    if (bPackedRTree)
+        poLayer->CreatePackedRTreeIndex();
+    else
+        poLayer->CreateSpatialIndex(nDepth);
     return nullptr;
 }
 
@@ -1269,6 +1279,7 @@ const char *const *OGRShapeDataSource::GetExtensionsForDeletion()
     static const char *const apszExtensions[] = {
         "shp",  "shx", "dbf", "sbn", "sbx", "prj", "idm", "ind", "qix", "cpg",
         "qpj",  // QGIS projection file
+        "hrt",  // GDAL packed Hilbert R-tree spatial index
         nullptr};
     return apszExtensions;
 }
@@ -632,6 +632,28 @@ bool OGRShapeLayer::CheckForSBN()
     return hSBN != nullptr;
 }
 
+/************************************************************************/
+/*                        CheckForPackedRTree()                         */
+/************************************************************************/
+
+bool OGRShapeLayer::CheckForPackedRTree()
+
+{
+    if (m_bCheckedForPackedRTree)
+        return m_poPackedRTree != nullptr;
+
+    if (hSHP != nullptr)
+    {
+        const char *pszHRTFilename = CPLResetExtension(pszFullName, "hrt");
+        m_poPackedRTree =
+            OGRShapePackedRTreeIndex::Open(pszHRTFilename, hSHP->nRecords);
+    }
+
+    m_bCheckedForPackedRTree = true;
+
+    return m_poPackedRTree != nullptr;
+}
+
 /************************************************************************/
 /*                            ScanIndices()                             */
 /*                                                                      */
@@ -694,16 +716,19 @@ bool OGRShapeLayer::ScanIndices()
 
     if (bTryQIXorSBN)
     {
-        if (!bCheckedForQIX)
+        if (!m_bCheckedForPackedRTree)
+            CPL_IGNORE_RET_VAL(CheckForPackedRTree());
+        if (m_poPackedRTree == nullptr && !bCheckedForQIX)
             CPL_IGNORE_RET_VAL(CheckForQIX());
-        if (hQIX == nullptr && !bCheckedForSBN)
+        if (m_poPackedRTree == nullptr && hQIX == nullptr && !bCheckedForSBN)
             CPL_IGNORE_RET_VAL(CheckForSBN());
     }
 
     /* -------------------------------------------------------------------- */
     /*      Compute spatial index if appropriate.                           */
     /* -------------------------------------------------------------------- */
-    if (bTryQIXorSBN && (hQIX != nullptr || hSBN != nullptr) &&
+    if (bTryQIXorSBN &&
+        (m_poPackedRTree != nullptr || hQIX != nullptr || hSBN != nullptr) &&
         panSpatialFIDs == nullptr)
     {
         double adfBoundsMin[4] = {oSpatialFilterEnvelope.MinX,
@@ -711,7 +736,10 @@ bool OGRShapeLayer::ScanIndices()
         double adfBoundsMax[4] = {oSpatialFilterEnvelope.MaxX,
                                   oSpatialFilterEnvelope.MaxY, 0.0, 0.0};
 
-        if (hQIX != nullptr)
+        if (m_poPackedRTree != nullptr)
+            panSpatialFIDs = m_poPackedRTree->Search(oSpatialFilterEnvelope,
+                                                     &nSpatialFIDCount);
+        else if (hQIX != nullptr)
             panSpatialFIDs = SHPSearchDiskTreeEx(
                 hQIX, adfBoundsMin, adfBoundsMax, &nSpatialFIDCount);
         else
@@ -784,7 +812,7 @@ void OGRShapeLayer::ResetReading()
 
     iMatchingFID = 0;
 
-    iNextShapeId = 0;
+    iNextShapeId = m_nPartitionStart;
 
     if (bHeaderDirty && bUpdateAccess)
         SyncToDisk();
@@ -960,10 +988,11 @@ OGRFeature *OGRShapeLayer::GetNextFeature()
     /*      of course.                                                      */
     /* -------------------------------------------------------------------- */
     if ((m_poAttrQuery != nullptr || m_poFilterGeom != nullptr) &&
-        iNextShapeId == 0 && panMatchingFIDs == nullptr)
+        iNextShapeId == m_nPartitionStart && panMatchingFIDs == nullptr)
     {
         ScanIndices();
     }
+    const int nEndShapeId = std::min(nTotalShapeCount, m_nPartitionEnd);
 
     /* -------------------------------------------------------------------- */
     /*      Loop till we find a feature matching our criteria.              */
@@ -979,16 +1008,18 @@ OGRFeature *OGRShapeLayer::GetNextFeature()
                 return nullptr;
             }
 
+            const GIntBig nFID = panMatchingFIDs[iMatchingFID];
+            iMatchingFID++;
+            if (nFID < m_nPartitionStart || nFID >= m_nPartitionEnd)
+                continue;
+
             // Check the shape object's geometry, and if it matches
             // any spatial filter, return it.
-            poFeature =
-                FetchShape(static_cast<int>(panMatchingFIDs[iMatchingFID]));
-
-            iMatchingFID++;
+            poFeature = FetchShape(static_cast<int>(nFID));
         }
         else
         {
-            if (iNextShapeId >= nTotalShapeCount)
+            if (iNextShapeId >= nEndShapeId)
             {
                 return nullptr;
             }
@@ -1101,7 +1132,7 @@ OGRErr OGRShapeLayer::ISetFeature(OGRFeature *poFeature)
     }
 
     bHeaderDirty = true;
-    if (CheckForQIX() || CheckForSBN())
+    if (CheckForPackedRTree() || CheckForQIX() || CheckForSBN())
         DropSpatialIndex();
 
     unsigned int nOffset = 0;
@@ -1177,7 +1208,7 @@ OGRErr OGRShapeLayer::DeleteFeature(GIntBig nFID)
         return OGRERR_FAILURE;
 
     bHeaderDirty = true;
-    if (CheckForQIX() || CheckForSBN())
+    if (CheckForPackedRTree() || CheckForQIX() || CheckForSBN())
         DropSpatialIndex();
     m_eNeedRepack = YES;
 
@@ -1201,7 +1232,7 @@ OGRErr OGRShapeLayer::ICreateFeature(OGRFeature *poFeature)
     }
 
     bHeaderDirty = true;
-    if (CheckForQIX() || CheckForSBN())
+    if (CheckForPackedRTree() || CheckForQIX() || CheckForSBN())
         DropSpatialIndex();
 
     poFeature->SetFID(OGRNullFID);
@@ -1788,7 +1819,8 @@ int OGRShapeLayer::TestCapability(const char *pszCap)
 
     if (EQUAL(pszCap, OLCFastFeatureCount))
     {
-        if (!(m_poFilterGeom == nullptr || CheckForQIX() || CheckForSBN()))
+        if (!(m_poFilterGeom == nullptr || CheckForPackedRTree() ||
+              CheckForQIX() || CheckForSBN()))
             return FALSE;
 
         if (m_poAttrQuery != nullptr)
@@ -1803,7 +1835,7 @@ int OGRShapeLayer::TestCapability(const char *pszCap)
         return bUpdateAccess;
 
     if (EQUAL(pszCap, OLCFastSpatialFilter))
-        return CheckForQIX() || CheckForSBN();
+        return CheckForPackedRTree() || CheckForQIX() || CheckForSBN();
 
     if (EQUAL(pszCap, OLCFastGetExtent))
         return TRUE;
@@ -2621,7 +2653,7 @@ OGRErr OGRShapeLayer::DropSpatialIndex()
     if (!StartUpdate("DropSpatialIndex"))
         return OGRERR_FAILURE;
 
-    if (!CheckForQIX() && !CheckForSBN())
+    if (!CheckForPackedRTree() && !CheckForQIX() && !CheckForSBN())
     {
         CPLError(CE_Warning, CPLE_AppDefined,
                  "Layer %s has no spatial index, DROP SPATIAL INDEX failed.",
@@ -2629,8 +2661,12 @@ OGRErr OGRShapeLayer::DropSpatialIndex()
         return OGRERR_FAILURE;
     }
 
+    const bool bHadPackedRTree = m_poPackedRTree != nullptr;
     const bool bHadQIX = hQIX != nullptr;
 
+    m_poPackedRTree.reset();
+    m_bCheckedForPackedRTree = false;
+
     SHPCloseDiskTree(hQIX);
     hQIX = nullptr;
     bCheckedForQIX = false;
@@ -2639,6 +2675,20 @@ OGRErr OGRShapeLayer::DropSpatialIndex()
     hSBN = nullptr;
     bCheckedForSBN = false;
 
+    if (bHadPackedRTree)
+    {
+        const char *pszHRTFilename = CPLResetExtension(pszFullName, "hrt");
+        CPLDebug("SHAPE", "Unlinking index file %s", pszHRTFilename);
+
+        if (VSIUnlink(pszHRTFilename) != 0)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Failed to delete file %s.\n%s", pszHRTFilename,
+                     VSIStrerror(errno));
+            return OGRERR_FAILURE;
+        }
+    }
+
     if (bHadQIX)
     {
         const char *pszQIXFilename = CPLResetExtension(pszFullName, "qix");
@@ -2690,7 +2740,7 @@ OGRErr OGRShapeLayer::CreateSpatialIndex(int nMaxDepth)
     /* -------------------------------------------------------------------- */
     /*      If we have an existing spatial index, blow it away first.       */
     /* -------------------------------------------------------------------- */
-    if (CheckForQIX())
+    if (CheckForPackedRTree() || CheckForQIX())
         DropSpatialIndex();
 
     bCheckedForQIX = false;
@@ -2735,6 +2785,43 @@ OGRErr OGRShapeLayer::CreateSpatialIndex(int nMaxDepth)
     return OGRERR_NONE;
 }
 
+/************************************************************************/
+/*                       CreatePackedRTreeIndex()                       */
+/************************************************************************/
+
+OGRErr OGRShapeLayer::CreatePackedRTreeIndex()
+
+{
+    if (!StartUpdate("CreateSpatialIndex"))
+        return OGRERR_FAILURE;
+
+    if (hSHP == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Layer %s has no geometry, cannot create spatial index.",
+                 poFeatureDefn->GetName());
+        return OGRERR_FAILURE;
+    }
+
+    // A .qix or .sbn would be ignored in favor of the new index, and would
+    // become stale on the next edit.
+    if (CheckForPackedRTree() || CheckForQIX() || CheckForSBN())
+        DropSpatialIndex();
+
+    OGRShapeLayer::SyncToDisk();
+
+    const char *pszHRTFilename = CPLResetExtension(pszFullName, "hrt");
+    CPLDebug("SHAPE", "Creating index file %s", pszHRTFilename);
+
+    if (!OGRShapePackedRTreeIndex::Create(hSHP, pszHRTFilename))
+        return OGRERR_FAILURE;
+
+    m_bCheckedForPackedRTree = false;
+    CPL_IGNORE_RET_VAL(CheckForPackedRTree());
+
+    return OGRERR_NONE;
+}
+
 /************************************************************************/
 /*                       CheckFileDeletion()                            */
 /************************************************************************/
@@ -2934,7 +3021,7 @@ OGRErr OGRShapeLayer::Repack()
     /*      Cleanup any existing spatial index.  It will become             */
     /*      meaningless when the fids change.                               */
     /* -------------------------------------------------------------------- */
-    if (CheckForQIX() || CheckForSBN())
+    if (CheckForPackedRTree() || CheckForQIX() || CheckForSBN())
         DropSpatialIndex();
 
     /* -------------------------------------------------------------------- */
@@ -3676,6 +3763,9 @@ void OGRShapeLayer::CloseUnderlyingLayer()
     hSBN = nullptr;
     bCheckedForSBN = false;
 
+    m_poPackedRTree.reset();
+    m_bCheckedForPackedRTree = false;
+
     eFileDescriptorsState = FD_CLOSED;
 }
 
@@ -3722,6 +3812,12 @@ void OGRShapeLayer::AddToFileList(CPLStringList &oFileList)
             oFileList.AddStringDirectly(
                 VSIGetCanonicalFilename(poGeomFieldDefn->GetPrjFilename()));
         }
+        if (CheckForPackedRTree())
+        {
+            const char *pszHRTFilename = CPLResetExtension(pszFullName, "hrt");
+            oFileList.AddStringDirectly(
+                VSIGetCanonicalFilename(pszHRTFilename));
+        }
         if (CheckForQIX())
         {
             const char *pszQIXFilename = CPLResetExtension(pszFullName, "qix");
@@ -3852,6 +3948,87 @@ GDALDataset *OGRShapeLayer::GetDataset()
     return poDS;
 }
 
+/************************************************************************/
+/*                         SetPartitionRange()                          */
+/************************************************************************/
+
+// Restrict reading to the records in the [nStart, nEnd[ range.
+void OGRShapeLayer::SetPartitionRange(int nStart, int nEnd)
+{
+    m_nPartitionStart = nStart;
+    m_nPartitionEnd = nEnd;
+    ResetReading();
+}
+
+/************************************************************************/
+/*                          GetPartitions()                             */
+/************************************************************************/
+
+namespace
+{
+class OGRShapeLayerPartition final : public OGRLayerPartition
+{
+    std::unique_ptr<GDALDataset> m_poDS{};
+    OGRShapeLayer *m_poLayer = nullptr;
+
+  public:
+    OGRShapeLayerPartition(std::unique_ptr<GDALDataset> &&poDSIn,
+                           OGRShapeLayer *poLayerIn)
+        : m_poDS(std::move(poDSIn)), m_poLayer(poLayerIn)
+    {
+    }
+
+    OGRLayer *GetLayer() override
+    {
+        return m_poLayer;
+    }
+};
+}  // namespace
+
+// Split the layer into ranges of records, each one read from its own
+// reopened dataset.
+std::vector<std::unique_ptr<OGRLayerPartition>>
+OGRShapeLayer::GetPartitions(int nMaxPartitions)
+{
+    std::vector<std::unique_ptr<OGRLayerPartition>> apoPartitions;
+    if (!TouchLayer() || bUpdateAccess || nMaxPartitions < 2)
+        return apoPartitions;
+
+    constexpr int MIN_RECORDS_PER_PARTITION = 4096;
+    const int nPartitions = std::min(
+        nMaxPartitions, nTotalShapeCount / MIN_RECORDS_PER_PARTITION);
+    if (nPartitions < 2)
+        return apoPartitions;
+
+    const CPLStringList aosOpenOptions(
+        CSLSetNameValue(nullptr, "ENCODING", osEncoding.c_str()));
+    const char *const apszAllowedDrivers[] = {"ESRI Shapefile", nullptr};
+    for (int i = 0; i < nPartitions; ++i)
+    {
+        auto poPartitionDS = std::unique_ptr<GDALDataset>(GDALDataset::Open(
+            pszFullName, GDAL_OF_VECTOR, apszAllowedDrivers,
+            aosOpenOptions.List()));
+        if (!poPartitionDS || poPartitionDS->GetLayerCount() != 1)
+            return {};
+        auto poLayer =
+            dynamic_cast<OGRShapeLayer *>(poPartitionDS->GetLayer(0));
+        if (!poLayer || !poLayer->TouchLayer() ||
+            poLayer->nTotalShapeCount != nTotalShapeCount ||
+            !poLayer->GetLayerDefn()->IsSame(poFeatureDefn))
+        {
+            return {};
+        }
+        const int nStart = static_cast<int>(
+            static_cast<GIntBig>(nTotalShapeCount) * i / nPartitions);
+        const int nEnd = static_cast<int>(
+            static_cast<GIntBig>(nTotalShapeCount) * (i + 1) / nPartitions);
+        poLayer->SetPartitionRange(nStart, nEnd);
+        apoPartitions.push_back(std::make_unique<OGRShapeLayerPartition>(
+            std::move(poPartitionDS), poLayer));
+    }
+    return apoPartitions;
+}
+
 /************************************************************************/
 /*                        GetNextArrowArray()                           */
 /************************************************************************/
@@ -3897,7 +4074,8 @@ int OGRShapeLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
 
     m_bLastGetNextArrowArrayUsedOptimizedCodePath = true;
     int nCount = 0;
-    while (iNextShapeId < nTotalShapeCount)
+    const int nEndShapeId = std::min(nTotalShapeCount, m_nPartitionEnd);
+    while (iNextShapeId < nEndShapeId)
     {
         const bool bIsDeleted =
             CPL_TO_BOOL(DBFIsRecordDeleted(hDBF, iNextShapeId));
@@ -0,0 +1,270 @@
+/******************************************************************************
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  Packed Hilbert R-tree spatial index (.hrt) for shapefiles.
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ogrshape.h"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+
+// The tree is the one of FlatGeobuf. Build it in a private namespace, so that
+// the driver neither depends on the optional FlatGeobuf driver nor clashes
+// with it when both are built in.
+#define FlatGeobuf OGRShapeFlatGeobuf
+#include "../flatgeobuf/packedrtree.cpp"
+#undef FlatGeobuf
+
+using OGRShapeFlatGeobuf::NodeItem;
+using OGRShapeFlatGeobuf::PackedRTree;
+using OGRShapeFlatGeobuf::SearchResultItem;
+
+/* File layout (little-endian):
+ * - 8 bytes: magic "GDALHRT" followed by the version (1)
+ * - 4 bytes: number of records of the .shp when the index was built
+ * - 4 bytes: number of indexed (non-null) shapes
+ * - 2 bytes: node size
+ * - 6 bytes: reserved
+ * - the packed R-tree nodes, in the FlatGeobuf layout, whose leaf offsets are
+ *   the shape ids.
+ */
+constexpr char HRT_MAGIC[] = {'G', 'D', 'A', 'L', 'H', 'R', 'T', 1};
+constexpr int HRT_HEADER_SIZE = 24;
+constexpr uint16_t HRT_NODE_SIZE = 16;
+
+// The internal nodes, stored first, are read at once when they are not
+// larger than that. Leaf nodes are read on demand.
+constexpr size_t HRT_MAX_CACHED_INTERNAL_NODES = 100 * 1024 * 1024;
+
+/************************************************************************/
+/*                     ~OGRShapePackedRTreeIndex()                      */
+/************************************************************************/
+
+OGRShapePackedRTreeIndex::~OGRShapePackedRTreeIndex()
+{
+    if (m_fp)
+        VSIFCloseL(m_fp);
+}
+
+/************************************************************************/
+/*                                Open()                                */
+/************************************************************************/
+
+std::unique_ptr<OGRShapePackedRTreeIndex>
+OGRShapePackedRTreeIndex::Open(const char *pszFilename, int nExpectedRecords)
+{
+    VSILFILE *fp = VSIFOpenL(pszFilename, "rb");
+    if (fp == nullptr)
+        return nullptr;
+
+    auto poIndex =
+        std::unique_ptr<OGRShapePackedRTreeIndex>(new OGRShapePackedRTreeIndex);
+    poIndex->m_fp = fp;
+
+    GByte abyHeader[HRT_HEADER_SIZE];
+    if (VSIFReadL(abyHeader, sizeof(abyHeader), 1, fp) != 1 ||
+        memcmp(abyHeader, HRT_MAGIC, sizeof(HRT_MAGIC)) != 0)
+    {
+        CPLDebug("SHAPE", "%s is not a valid packed R-tree index",
+                 pszFilename);
+        return nullptr;
+    }
+
+    uint32_t nRecords = 0;
+    memcpy(&nRecords, abyHeader + 8, sizeof(nRecords));
+    CPL_LSBPTR32(&nRecords);
+    uint32_t nItems = 0;
+    memcpy(&nItems, abyHeader + 12, sizeof(nItems));
+    CPL_LSBPTR32(&nItems);
+    uint16_t nNodeSize = 0;
+    memcpy(&nNodeSize, abyHeader + 16, sizeof(nNodeSize));
+    CPL_LSBPTR16(&nNodeSize);
+
+    if (nRecords != static_cast<uint32_t>(nExpectedRecords) ||
+        nItems > nRecords || nNodeSize < 2)
+    {
+        CPLDebug("SHAPE", "%s is not consistent with the .shp, ignoring it",
+                 pszFilename);
+        return nullptr;
+    }
+
+    poIndex->m_nItems = nItems;
+    poIndex->m_nNodeSize = nNodeSize;
+    if (nItems == 0)
+        return poIndex;
+
+    try
+    {
+        const auto levelBounds =
+            PackedRTree::generateLevelBounds(nItems, nNodeSize);
+        // Leaf nodes come after all the internal ones
+        const uint64_t nInternalNodes = levelBounds.front().first;
+        const uint64_t nInternalNodesSize = nInternalNodes * sizeof(NodeItem);
+        if (nInternalNodesSize <= HRT_MAX_CACHED_INTERNAL_NODES)
+        {
+            poIndex->m_abyInternalNodes.resize(
+                static_cast<size_t>(nInternalNodesSize));
+            if (nInternalNodesSize > 0 &&
+                VSIFReadL(poIndex->m_abyInternalNodes.data(),
+                          poIndex->m_abyInternalNodes.size(), 1, fp) != 1)
+            {
+                CPLError(CE_Failure, CPLE_FileIO, "Cannot read %s",
+                         pszFilename);
+                return nullptr;
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "%s: %s", pszFilename, e.what());
+        return nullptr;
+    }
+
+    return poIndex;
+}
+
+/************************************************************************/
+/*                               Search()                               */
+/************************************************************************/
+
+// Returns a sorted array of the ids of the shapes whose bounding box
+// intersects sEnvelope, to be freed with free(), or nullptr in case of error.
+int *OGRShapePackedRTreeIndex::Search(const OGREnvelope &sEnvelope,
+                                      int *pnCount) const
+{
+    *pnCount = 0;
+    std::vector<SearchResultItem> results;
+    if (m_nItems > 0)
+    {
+        const NodeItem sItem{sEnvelope.MinX, sEnvelope.MinY, sEnvelope.MaxX,
+                             sEnvelope.MaxY, 0};
+        const auto readNode = [this](uint8_t *buf, size_t i, size_t s)
+        {
+            if (i + s <= m_abyInternalNodes.size())
+            {
+                memcpy(buf, m_abyInternalNodes.data() + i, s);
+            }
+            else if (VSIFSeekL(m_fp, HRT_HEADER_SIZE + i, SEEK_SET) != 0 ||
+                     VSIFReadL(buf, 1, s, m_fp) != s)
+            {
+                throw std::runtime_error("I/O error while reading index");
+            }
+        };
+        try
+        {
+            results = PackedRTree::streamSearch(m_nItems, m_nNodeSize, sItem,
+                                                readNode);
+        }
+        catch (const std::exception &e)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Packed R-tree index search failed: %s", e.what());
+            return nullptr;
+        }
+    }
+
+    int *panFIDs = static_cast<int *>(
+        VSI_MALLOC2_VERBOSE(results.size() + 1, sizeof(int)));
+    if (panFIDs == nullptr)
+        return nullptr;
+    for (const auto &result : results)
+        panFIDs[(*pnCount)++] = static_cast<int>(result.offset);
+    std::sort(panFIDs, panFIDs + *pnCount);
+    return panFIDs;
+}
+
+/************************************************************************/
+/*                               Create()                               */
+/************************************************************************/
+
+bool OGRShapePackedRTreeIndex::Create(SHPHandle hSHP, const char *pszFilename)
+{
+    std::vector<NodeItem> aoItems;
+    NodeItem sExtent = NodeItem::create(0);
+    for (int iShape = 0; iShape < hSHP->nRecords; ++iShape)
+    {
+        SHPObject *psShape = SHPReadObject(hSHP, iShape);
+        if (psShape == nullptr)
+            continue;
+        if (psShape->nSHPType != SHPT_NULL && psShape->nVertices > 0)
+        {
+            const NodeItem sItem{psShape->dfXMin, psShape->dfYMin,
+                                 psShape->dfXMax, psShape->dfYMax,
+                                 static_cast<uint64_t>(iShape)};
+            sExtent.expand(sItem);
+            aoItems.push_back(sItem);
+        }
+        SHPDestroyObject(psShape);
+    }
+
+    VSILFILE *fp = VSIFOpenL(pszFilename, "wb");
+    if (fp == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s", pszFilename);
+        return false;
+    }
+
+    GByte abyHeader[HRT_HEADER_SIZE] = {};
+    memcpy(abyHeader, HRT_MAGIC, sizeof(HRT_MAGIC));
+    uint32_t nRecords = static_cast<uint32_t>(hSHP->nRecords);
+    CPL_LSBPTR32(&nRecords);
+    memcpy(abyHeader + 8, &nRecords, sizeof(nRecords));
+    uint32_t nItems = static_cast<uint32_t>(aoItems.size());
+    CPL_LSBPTR32(&nItems);
+    memcpy(abyHeader + 12, &nItems, sizeof(nItems));
+    uint16_t nNodeSize = HRT_NODE_SIZE;
+    CPL_LSBPTR16(&nNodeSize);
+    memcpy(abyHeader + 16, &nNodeSize, sizeof(nNodeSize));
+    bool bOK = VSIFWriteL(abyHeader, sizeof(abyHeader), 1, fp) == 1;
+
+    if (bOK && !aoItems.empty())
+    {
+        try
+        {
+            OGRShapeFlatGeobuf::hilbertSort(aoItems);
+            PackedRTree oTree(aoItems, sExtent, HRT_NODE_SIZE);
+            oTree.streamWrite(
+                [fp, &bOK](uint8_t *data, size_t size)
+                { bOK &= VSIFWriteL(data, 1, size, fp) == size; });
+        }
+        catch (const std::exception &e)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Cannot build packed R-tree index: %s", e.what());
+            bOK = false;
+        }
+    }
+
+    if (VSIFCloseL(fp) != 0)
+        bOK = false;
+    if (!bOK)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot write %s", pszFilename);
+        VSIUnlink(pszFilename);
+    }
+    return bOK;
+}
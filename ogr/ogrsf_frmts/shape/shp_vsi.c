@@ -31,8 +31,11 @@
 #include "shp_vsi.h"
 #include "cpl_error.h"
 #include "cpl_conv.h"
+#include "cpl_string.h"
+#include "cpl_virtualmem.h"
 #include "cpl_vsi_error.h"
 #include <limits.h>
+#include <string.h>
 
 typedef struct
 {
@@ -41,6 +44,10 @@ typedef struct
     int bEnforce2GBLimit;
     int bHasWarned2GB;
     SAOffset nCurOffset;
+    /* When the file is memory-mapped, fp is an anonymous /vsimem/ handle */
+    /* over the mapping, and fpNative the actual file. */
+    VSILFILE *fpNative;
+    CPLVirtualMem *psVirtualMem;
 } OGRSHPDBFFile;
 
 /************************************************************************/
@@ -63,6 +70,47 @@ const char *VSI_SHP_GetFilename(SAFile file)
     return pFile->pszFilename;
 }
 
+/************************************************************************/
+/*                        VSI_SHP_TryMemoryMap()                        */
+/************************************************************************/
+
+/* Serve the reads of a read-only local file from a memory mapping, which */
+/* avoids one seek and read system call per record. */
+static void VSI_SHP_TryMemoryMap(OGRSHPDBFFile *pFile)
+{
+    vsi_l_offset nSize;
+    CPLVirtualMem *psVirtualMem;
+    VSILFILE *fpMem;
+
+    if (!CPLIsVirtualMemFileMapAvailable() ||
+        VSIFGetNativeFileDescriptorL(pFile->fp) == NULL)
+        return;
+
+    if (VSIFSeekL(pFile->fp, 0, SEEK_END) != 0)
+        return;
+    nSize = VSIFTellL(pFile->fp);
+    if (VSIFSeekL(pFile->fp, 0, SEEK_SET) != 0 || nSize == 0 ||
+        nSize != (vsi_l_offset)(size_t)nSize)
+        return;
+
+    psVirtualMem = CPLVirtualMemFileMapNew(pFile->fp, 0, nSize,
+                                           VIRTUALMEM_READONLY, NULL, NULL);
+    if (psVirtualMem == NULL)
+        return;
+
+    fpMem = VSIFileFromMemBuffer(
+        NULL, (GByte *)CPLVirtualMemGetAddr(psVirtualMem), nSize, FALSE);
+    if (fpMem == NULL)
+    {
+        CPLVirtualMemFree(psVirtualMem);
+        return;
+    }
+
+    pFile->fpNative = pFile->fp;
+    pFile->fp = fpMem;
+    pFile->psVirtualMem = psVirtualMem;
+}
+
 /************************************************************************/
 /*                         VSI_SHP_OpenInternal()                       */
 /************************************************************************/
@@ -80,6 +128,11 @@ static SAFile VSI_SHP_OpenInternal(const char *pszFilename,
     pFile->pszFilename = CPLStrdup(pszFilename);
     pFile->bEnforce2GBLimit = bEnforce2GBLimit;
     pFile->nCurOffset = 0;
+    if (strchr(pszAccess, '+') == NULL && strchr(pszAccess, 'w') == NULL &&
+        CPLTestBool(CPLGetConfigOption("SHAPE_USE_MMAP", "NO")))
+    {
+        VSI_SHP_TryMemoryMap(pFile);
+    }
     return (SAFile)pFile;
 }
 
@@ -215,6 +268,12 @@ static int VSI_SHP_Close(SAFile file)
 {
     OGRSHPDBFFile *pFile = (OGRSHPDBFFile *)file;
     int ret = VSIFCloseL(pFile->fp);
+    if (pFile->psVirtualMem)
+    {
+        CPLVirtualMemFree(pFile->psVirtualMem);
+        if (VSIFCloseL(pFile->fpNative) != 0)
+            ret = -1;
+    }
     CPLFree(pFile->pszFilename);
     CPLFree(pFile);
     return ret;
@@ -1187,6 +1187,17 @@ void OGRSQLiteBaseDataSource::LoadExtensions()
 
 bool OGRSQLiteBaseDataSource::SetCacheSize()
 {
+    // Process-wide budget for the page caches of all connections, so that
+    // many concurrently opened datasets do not each hold a full cache.
+    const char *pszSoftHeapLimitMB =
+        CPLGetConfigOption("OGR_SQLITE_SOFT_HEAP_LIMIT", nullptr);
+    if (pszSoftHeapLimitMB != nullptr)
+    {
+        sqlite3_soft_heap_limit64(
+            static_cast<sqlite3_int64>(atoi(pszSoftHeapLimitMB)) * 1024 *
+            1024);
+    }
+
     const char *pszSqliteCacheMB =
         CPLGetConfigOption("OGR_SQLITE_CACHE", nullptr);
     if (pszSqliteCacheMB != nullptr)
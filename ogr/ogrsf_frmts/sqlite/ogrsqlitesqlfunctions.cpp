@@ -780,34 +780,226 @@ static int CheckSTFunctions(sqlite3_context *pContext, int argc,
 }
 
 /************************************************************************/
-/*                 OGR2SQLITE_ST_int_geomgeom_op()                      */
+/*                     OGR2SQLITE_GetBlobEnvelope()                     */
 /************************************************************************/
 
-#define OGR2SQLITE_ST_int_geomgeom_op(op)                                      \
+/* Read the MBR stored in the header of a non-empty SpatiaLite geometry blob,
+ * without decoding the geometry */
+static bool OGR2SQLITE_GetBlobEnvelope(sqlite3_value *val,
+                                       OGREnvelope &sEnvelope)
+{
+    if (sqlite3_value_type(val) != SQLITE_BLOB)
+        return false;
+
+    const GByte *pabySLBLOB = (const GByte *)sqlite3_value_blob(val);
+    const int nBLOBLen = sqlite3_value_bytes(val);
+    bool bIsEmpty = false;
+    return OGRSQLiteLayer::GetSpatialiteGeometryHeader(
+               pabySLBLOB, nBLOBLen, nullptr, nullptr, &bIsEmpty,
+               &sEnvelope.MinX, &sEnvelope.MinY, &sEnvelope.MaxX,
+               &sEnvelope.MaxY) == OGRERR_NONE &&
+           !bIsEmpty;
+}
+
+/************************************************************************/
+/*                       OGR2SQLITEGeomAuxData                          */
+/************************************************************************/
+
+/* Decoded geometry of an argument of a spatial predicate, attached to the
+ * argument with sqlite3_set_auxdata(). SQLite only keeps it across rows when
+ * the argument is constant, in which case we also prepare the geometry the
+ * second time it is used. */
+struct OGR2SQLITEGeomAuxData
+{
+    std::unique_ptr<OGRGeometry> poGeom{};
+    OGRPreparedGeometryUniquePtr poPreparedGeom{};
+    bool bPrepareTried = false;
+};
+
+static void OGR2SQLITE_FreeGeomAuxData(void *p)
+{
+    delete static_cast<OGR2SQLITEGeomAuxData *>(p);
+}
+
+/************************************************************************/
+/*                       OGR2SQLITE_ST_Predicate()                      */
+/************************************************************************/
+
+enum class OGR2SQLITEPredicate
+{
+    INTERSECTS,
+    EQUALS,
+    DISJOINT,
+    TOUCHES,
+    CROSSES,
+    WITHIN,
+    CONTAINS,
+    OVERLAPS
+};
+
+static void OGR2SQLITE_ST_Predicate(sqlite3_context *pContext, int argc,
+                                    sqlite3_value **argv,
+                                    OGR2SQLITEPredicate ePredicate)
+{
+    if (argc != 2)
+    {
+        sqlite3_result_int(pContext, 0);
+        return;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Try to conclude from the envelopes stored in the blob headers.  */
+    /* -------------------------------------------------------------------- */
+    OGREnvelope sEnvelope1;
+    OGREnvelope sEnvelope2;
+    if (OGR2SQLITE_GetBlobEnvelope(argv[0], sEnvelope1) &&
+        OGR2SQLITE_GetBlobEnvelope(argv[1], sEnvelope2))
+    {
+        if (!sEnvelope1.Intersects(sEnvelope2))
+        {
+            sqlite3_result_int(pContext,
+                               ePredicate == OGR2SQLITEPredicate::DISJOINT);
+            return;
+        }
+        if ((ePredicate == OGR2SQLITEPredicate::WITHIN &&
+             !sEnvelope2.Contains(sEnvelope1)) ||
+            (ePredicate == OGR2SQLITEPredicate::CONTAINS &&
+             !sEnvelope1.Contains(sEnvelope2)))
+        {
+            sqlite3_result_int(pContext, 0);
+            return;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Fetch the geometries, reusing the ones of constant arguments.   */
+    /* -------------------------------------------------------------------- */
+    OGR2SQLITEGeomAuxData *apsAuxData[2] = {nullptr, nullptr};
+    std::unique_ptr<OGR2SQLITEGeomAuxData> apoNewAuxData[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        apsAuxData[i] = static_cast<OGR2SQLITEGeomAuxData *>(
+            sqlite3_get_auxdata(pContext, i));
+        if (apsAuxData[i] == nullptr)
+        {
+            apoNewAuxData[i] = std::make_unique<OGR2SQLITEGeomAuxData>();
+            apoNewAuxData[i]->poGeom.reset(
+                OGR2SQLITE_GetGeom(pContext, 1, argv + i, nullptr));
+            if (apoNewAuxData[i]->poGeom == nullptr)
+            {
+                sqlite3_result_int(pContext, 0);
+                return;
+            }
+            apsAuxData[i] = apoNewAuxData[i].get();
+        }
+        else if (!apsAuxData[i]->bPrepareTried)
+        {
+            apsAuxData[i]->bPrepareTried = true;
+            const bool bCanUsePrepared =
+                ePredicate == OGR2SQLITEPredicate::INTERSECTS ||
+                ePredicate == OGR2SQLITEPredicate::DISJOINT ||
+                (ePredicate == OGR2SQLITEPredicate::CONTAINS && i == 0) ||
+                (ePredicate == OGR2SQLITEPredicate::WITHIN && i == 1);
+            if (bCanUsePrepared && OGRHasPreparedGeometrySupport())
+            {
+                apsAuxData[i]->poPreparedGeom.reset(OGRCreatePreparedGeometry(
+                    OGRGeometry::ToHandle(apsAuxData[i]->poGeom.get())));
+            }
+        }
+    }
+
+    OGRGeometry *poGeom1 = apsAuxData[0]->poGeom.get();
+    OGRGeometry *poGeom2 = apsAuxData[1]->poGeom.get();
+    OGRPreparedGeometry *poPrepared1 = apsAuxData[0]->poPreparedGeom.get();
+    OGRPreparedGeometry *poPrepared2 = apsAuxData[1]->poPreparedGeom.get();
+
+    int nRet = 0;
+    switch (ePredicate)
+    {
+        case OGR2SQLITEPredicate::INTERSECTS:
+        case OGR2SQLITEPredicate::DISJOINT:
+        {
+            if (poPrepared1 || poPrepared2)
+            {
+                nRet = poPrepared1 ? OGRPreparedGeometryIntersects(
+                                         poPrepared1,
+                                         OGRGeometry::ToHandle(poGeom2))
+                                   : OGRPreparedGeometryIntersects(
+                                         poPrepared2,
+                                         OGRGeometry::ToHandle(poGeom1));
+                if (ePredicate == OGR2SQLITEPredicate::DISJOINT)
+                    nRet = !nRet;
+            }
+            else if (ePredicate == OGR2SQLITEPredicate::INTERSECTS)
+                nRet = poGeom1->Intersects(poGeom2);
+            else
+                nRet = poGeom1->Disjoint(poGeom2);
+            break;
+        }
+
+        case OGR2SQLITEPredicate::EQUALS:
+            nRet = poGeom1->Equals(poGeom2);
+            break;
+
+        case OGR2SQLITEPredicate::TOUCHES:
+            nRet = poGeom1->Touches(poGeom2);
+            break;
+
+        case OGR2SQLITEPredicate::CROSSES:
+            nRet = poGeom1->Crosses(poGeom2);
+            break;
+
+        case OGR2SQLITEPredicate::WITHIN:
+            if (poPrepared2)
+                nRet = OGRPreparedGeometryContains(
+                    poPrepared2, OGRGeometry::ToHandle(poGeom1));
+            else
+                nRet = poGeom1->Within(poGeom2);
+            break;
+
+        case OGR2SQLITEPredicate::CONTAINS:
+            if (poPrepared1)
+                nRet = OGRPreparedGeometryContains(
+                    poPrepared1, OGRGeometry::ToHandle(poGeom2));
+            else
+                nRet = poGeom1->Contains(poGeom2);
+            break;
+
+        case OGR2SQLITEPredicate::OVERLAPS:
+            nRet = poGeom1->Overlaps(poGeom2);
+            break;
+    }
+    sqlite3_result_int(pContext, nRet);
+
+    // Must be done last, since SQLite may free the data immediately
+    for (int i = 0; i < 2; ++i)
+    {
+        if (apoNewAuxData[i])
+        {
+            sqlite3_set_auxdata(pContext, i, apoNewAuxData[i].release(),
+                                OGR2SQLITE_FreeGeomAuxData);
+        }
+    }
+}
+
+#define OGR2SQLITE_ST_int_geomgeom_op(op, predicate)                           \
     static void OGR2SQLITE_ST_##op(sqlite3_context *pContext, int argc,        \
                                    sqlite3_value **argv)                       \
     {                                                                          \
-        OGRGeometry *poGeom1 = nullptr;                                        \
-        OGRGeometry *poGeom2 = nullptr;                                        \
-        if (!CheckSTFunctions(pContext, argc, argv, &poGeom1, &poGeom2,        \
-                              nullptr))                                        \
-        {                                                                      \
-            sqlite3_result_int(pContext, 0);                                   \
-            return;                                                            \
-        }                                                                      \
-                                                                               \
-        sqlite3_result_int(pContext, poGeom1->op(poGeom2));                    \
-                                                                               \
-        delete poGeom1;                                                        \
-        delete poGeom2;                                                        \
+        OGR2SQLITE_ST_Predicate(pContext, argc, argv,                          \
+                                OGR2SQLITEPredicate::predicate);               \
     }
 
-OGR2SQLITE_ST_int_geomgeom_op(Intersects) OGR2SQLITE_ST_int_geomgeom_op(Equals)
-    OGR2SQLITE_ST_int_geomgeom_op(Disjoint) OGR2SQLITE_ST_int_geomgeom_op(
-        Touches) OGR2SQLITE_ST_int_geomgeom_op(Crosses)
-        OGR2SQLITE_ST_int_geomgeom_op(Within)
-            OGR2SQLITE_ST_int_geomgeom_op(Contains)
-                OGR2SQLITE_ST_int_geomgeom_op(Overlaps)
+// clang-format off
+OGR2SQLITE_ST_int_geomgeom_op(Intersects, INTERSECTS)
+OGR2SQLITE_ST_int_geomgeom_op(Equals, EQUALS)
+OGR2SQLITE_ST_int_geomgeom_op(Disjoint, DISJOINT)
+OGR2SQLITE_ST_int_geomgeom_op(Touches, TOUCHES)
+OGR2SQLITE_ST_int_geomgeom_op(Crosses, CROSSES)
+OGR2SQLITE_ST_int_geomgeom_op(Within, WITHIN)
+OGR2SQLITE_ST_int_geomgeom_op(Contains, CONTAINS)
+OGR2SQLITE_ST_int_geomgeom_op(Overlaps, OVERLAPS)
+// clang-format on
 
 /************************************************************************/
 /*                   OGR2SQLITE_ST_int_geom_op()                        */
@@ -37,6 +37,7 @@
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_string.h"
+#include "cpl_virtualmem.h"
 #include "cpl_vsi.h"
 #include "ogrsqlitevfs.h"
 
@@ -66,8 +67,22 @@ typedef struct
     VSILFILE *fp;
     int bDeleteOnClose;
     char *pszFilename;
+    // Memory mapping of read-only main database files, for xFetch()
+    int bCanMap;
+    GByte *pabyMap;
+    sqlite3_int64 nMapSize;
+    CPLVirtualMem *psVirtualMem;
 } OGRSQLiteFileStruct;
 
+static void OGRSQLiteIOUnmap(OGRSQLiteFileStruct *pMyFile)
+{
+    if (pMyFile->psVirtualMem)
+        CPLVirtualMemFree(pMyFile->psVirtualMem);
+    pMyFile->psVirtualMem = nullptr;
+    pMyFile->pabyMap = nullptr;
+    pMyFile->nMapSize = 0;
+}
+
 static int OGRSQLiteIOClose(sqlite3_file *pFile)
 {
     OGRSQLiteFileStruct *pMyFile = (OGRSQLiteFileStruct *)pFile;
@@ -75,6 +90,7 @@ static int OGRSQLiteIOClose(sqlite3_file *pFile)
     CPLDebug("SQLITE", "OGRSQLiteIOClose(%p (%s))", pMyFile->fp,
              pMyFile->pszFilename);
 #endif
+    OGRSQLiteIOUnmap(pMyFile);
     VSIFCloseL(pMyFile->fp);
     if (pMyFile->bDeleteOnClose)
         VSIUnlink(pMyFile->pszFilename);
@@ -209,8 +225,77 @@ static int OGRSQLiteIODeviceCharacteristics(DEBUG_ONLY sqlite3_file *pFile)
     return 0;
 }
 
+/* Memory-mapped I/O, used by SQLite when PRAGMA mmap_size is set. We map the
+ * whole file at the first request: /vsimem/ files are directly exposed, and
+ * regular files are mapped with CPLVirtualMemFileMapNew() when available.
+ * Returning a NULL pointer makes SQLite fall back to xRead().
+ */
+static int OGRSQLiteIOFetch(sqlite3_file *pFile, sqlite3_int64 iOfst, int iAmt,
+                            void **pp)
+{
+    OGRSQLiteFileStruct *pMyFile = (OGRSQLiteFileStruct *)pFile;
+    *pp = nullptr;
+    if (!pMyFile->bCanMap)
+        return SQLITE_OK;
+
+    if (pMyFile->pabyMap == nullptr)
+    {
+        if (STARTS_WITH(pMyFile->pszFilename, "/vsimem/"))
+        {
+            vsi_l_offset nSize = 0;
+            pMyFile->pabyMap =
+                VSIGetMemFileBuffer(pMyFile->pszFilename, &nSize, FALSE);
+            pMyFile->nMapSize = (sqlite3_int64)nSize;
+        }
+        else if (CPLIsVirtualMemFileMapAvailable() &&
+                 VSIFGetNativeFileDescriptorL(pMyFile->fp) != nullptr)
+        {
+            const vsi_l_offset nCurOffset = VSIFTellL(pMyFile->fp);
+            VSIFSeekL(pMyFile->fp, 0, SEEK_END);
+            const vsi_l_offset nSize = VSIFTellL(pMyFile->fp);
+            VSIFSeekL(pMyFile->fp, nCurOffset, SEEK_SET);
+            if (nSize > 0)
+            {
+                pMyFile->psVirtualMem = CPLVirtualMemFileMapNew(
+                    pMyFile->fp, 0, nSize, VIRTUALMEM_READONLY, nullptr,
+                    nullptr);
+            }
+            if (pMyFile->psVirtualMem)
+            {
+                pMyFile->pabyMap = static_cast<GByte *>(
+                    CPLVirtualMemGetAddr(pMyFile->psVirtualMem));
+                pMyFile->nMapSize = (sqlite3_int64)nSize;
+            }
+        }
+        if (pMyFile->pabyMap == nullptr)
+        {
+            // Do not retry
+            pMyFile->bCanMap = FALSE;
+            return SQLITE_OK;
+        }
+#ifdef DEBUG_IO
+        CPLDebug("SQLITE", "OGRSQLiteIOFetch(%p): mapped " CPL_FRMT_GIB
+                 " bytes", pMyFile->fp, (GIntBig)pMyFile->nMapSize);
+#endif
+    }
+
+    if (iOfst >= 0 && iOfst + iAmt <= pMyFile->nMapSize)
+        *pp = pMyFile->pabyMap + iOfst;
+    return SQLITE_OK;
+}
+
+static int OGRSQLiteIOUnfetch(sqlite3_file *pFile, sqlite3_int64 /* iOfst */,
+                              void *p)
+{
+    // A NULL pointer means that all mappings must be released, for example
+    // because the file size has changed.
+    if (p == nullptr)
+        OGRSQLiteIOUnmap((OGRSQLiteFileStruct *)pFile);
+    return SQLITE_OK;
+}
+
 static const sqlite3_io_methods OGRSQLiteIOMethods = {
-    1,
+    3,
     OGRSQLiteIOClose,
     OGRSQLiteIORead,
     OGRSQLiteIOWrite,
@@ -227,8 +312,8 @@ static const sqlite3_io_methods OGRSQLiteIOMethods = {
     nullptr,  // xShmLock
     nullptr,  // xShmBarrier
     nullptr,  // xShmUnmap
-    nullptr,  // xFetch
-    nullptr,  // xUnfetch
+    OGRSQLiteIOFetch,
+    OGRSQLiteIOUnfetch,
 };
 
 static int OGRSQLiteVFSOpen(sqlite3_vfs *pVFS, const char *zName,
@@ -252,6 +337,11 @@ static int OGRSQLiteVFSOpen(sqlite3_vfs *pVFS, const char *zName,
     pMyFile->pMethods = nullptr;
     pMyFile->bDeleteOnClose = FALSE;
     pMyFile->pszFilename = nullptr;
+    pMyFile->bCanMap = (flags & SQLITE_OPEN_READONLY) != 0 &&
+                       (flags & SQLITE_OPEN_MAIN_DB) != 0;
+    pMyFile->pabyMap = nullptr;
+    pMyFile->nMapSize = 0;
+    pMyFile->psVirtualMem = nullptr;
     if (flags & SQLITE_OPEN_READONLY)
         pMyFile->fp = VSIFOpenL(zName, "rb");
     else if (flags & SQLITE_OPEN_CREATE)
@@ -31,6 +31,7 @@
 #include "cpl_port.h"
 #include "ogrsqlitevirtualogr.h"
 
+#include <algorithm>
 #include <cctype>
 #include <cstdio>
 #include <cstdlib>
@@ -413,6 +414,9 @@ typedef struct
 
     GByte *pabyGeomBLOB;
     int nGeomBLOBLen;
+
+    /* Whether SetIgnoredFields() has been called from the columns used */
+    bool bHasIgnoredFields;
 } OGR2SQLITE_vtab_cursor;
 
 #ifdef VIRTUAL_OGR_DYNAMIC_EXTENSION_ENABLED
@@ -846,6 +850,9 @@ static bool OGR2SQLITE_IsHandledOp(int op)
     return false;
 }
 
+/* Private operator code for "col IN (...)" constraints processed at once */
+constexpr int OGR2SQLITE_CONSTRAINT_IN = 1000;
+
 /************************************************************************/
 /*                        OGR2SQLITE_BestIndex()                        */
 /************************************************************************/
@@ -950,6 +957,7 @@ static int OGR2SQLITE_BestIndex(sqlite3_vtab *pVTab, sqlite3_index_info *pIndex)
 #endif
 
     int nConstraints = 0;
+    std::vector<bool> abIsIn(pIndex->nConstraint);
     for (int i = 0; i < pIndex->nConstraint; i++)
     {
         int iCol = pIndex->aConstraint[i].iColumn;
@@ -965,6 +973,19 @@ static int OGR2SQLITE_BestIndex(sqlite3_vtab *pVTab, sqlite3_index_info *pIndex)
             pIndex->aConstraintUsage[i].argvIndex = nConstraints + 1;
             pIndex->aConstraintUsage[i].omit = true;
 
+#if SQLITE_VERSION_NUMBER >= 3038000L
+            /* SQLite >= 3.38: ask for the whole list of values of a */
+            /* "col IN (...)" constraint at once, instead of one scan per */
+            /* value. */
+            if (pIndex->aConstraint[i].op == SQLITE_INDEX_CONSTRAINT_EQ &&
+                sqlite3_libversion_number() >= 3038000 &&
+                sqlite3_vtab_in(pIndex, i, -1))
+            {
+                sqlite3_vtab_in(pIndex, i, 1);
+                abIsIn[i] = true;
+            }
+#endif
+
             nConstraints++;
         }
         else
@@ -974,43 +995,46 @@ static int OGR2SQLITE_BestIndex(sqlite3_vtab *pVTab, sqlite3_index_info *pIndex)
         }
     }
 
-    int *panConstraints = nullptr;
+    /* Columns used by the query: by default, consider all are used */
+    sqlite3_uint64 nColUsed = ~static_cast<sqlite3_uint64>(0);
+#if SQLITE_VERSION_NUMBER >= 3010000L
+    /* SQLite >= 3.10 */
+    if (sqlite3_libversion_number() >= 3010000)
+        nColUsed = pIndex->colUsed;
+#endif
 
-    if (nConstraints)
-    {
-        panConstraints =
-            (int *)sqlite3_malloc((int)sizeof(int) * (1 + 2 * nConstraints));
-        panConstraints[0] = nConstraints;
+    /* idxStr is made of the number of constraints, the (column, operator) */
+    /* pairs, and then the bitmask of used columns */
+    const int nIdxStrSize =
+        static_cast<int>(sizeof(int) * (1 + 2 * nConstraints) +
+                         sizeof(sqlite3_uint64));
+    int *panConstraints = (int *)sqlite3_malloc(nIdxStrSize);
+    if (panConstraints == nullptr)
+        return SQLITE_NOMEM;
+    panConstraints[0] = nConstraints;
 
-        nConstraints = 0;
+    nConstraints = 0;
 
-        for (int i = 0; i < pIndex->nConstraint; i++)
+    for (int i = 0; i < pIndex->nConstraint; i++)
+    {
+        if (pIndex->aConstraintUsage[i].omit)
         {
-            if (pIndex->aConstraintUsage[i].omit)
-            {
-                panConstraints[2 * nConstraints + 1] =
-                    pIndex->aConstraint[i].iColumn;
-                panConstraints[2 * nConstraints + 2] =
-                    pIndex->aConstraint[i].op;
+            panConstraints[2 * nConstraints + 1] =
+                pIndex->aConstraint[i].iColumn;
+            panConstraints[2 * nConstraints + 2] =
+                abIsIn[i] ? OGR2SQLITE_CONSTRAINT_IN
+                          : pIndex->aConstraint[i].op;
 
-                nConstraints++;
-            }
+            nConstraints++;
         }
     }
+    memcpy(panConstraints + 1 + 2 * nConstraints, &nColUsed, sizeof(nColUsed));
 
     pIndex->orderByConsumed = false;
     pIndex->idxNum = 0;
 
-    if (nConstraints != 0)
-    {
-        pIndex->idxStr = (char *)panConstraints;
-        pIndex->needToFreeIdxStr = true;
-    }
-    else
-    {
-        pIndex->idxStr = nullptr;
-        pIndex->needToFreeIdxStr = false;
-    }
+    pIndex->idxStr = (char *)panConstraints;
+    pIndex->needToFreeIdxStr = true;
 
     return SQLITE_OK;
 }
@@ -1091,6 +1115,7 @@ static int OGR2SQLITE_Open(sqlite3_vtab *pVTab, sqlite3_vtab_cursor **ppCursor)
 
     pCursor->pabyGeomBLOB = nullptr;
     pCursor->nGeomBLOBLen = -1;
+    pCursor->bHasIgnoredFields = false;
 
     return SQLITE_OK;
 }
@@ -1109,6 +1134,9 @@ static int OGR2SQLITE_Close(sqlite3_vtab_cursor *pCursor)
 #endif
     pMyVTab->nMyRef--;
 
+    if (pMyCursor->bHasIgnoredFields)
+        pMyCursor->poLayer->SetIgnoredFields(nullptr);
+
     delete pMyCursor->poFeature;
     delete pMyCursor->poDupDataSource;
 
@@ -1119,6 +1147,42 @@ static int OGR2SQLITE_Close(sqlite3_vtab_cursor *pCursor)
     return SQLITE_OK;
 }
 
+/************************************************************************/
+/*                       OGR2SQLITE_AppendValue()                       */
+/************************************************************************/
+
+/* Append the value of a constraint to an OGR SQL attribute filter */
+static bool OGR2SQLITE_AppendValue(OGR2SQLITE_vtab *pMyVTab,
+                                   CPLString &osAttributeFilter,
+                                   sqlite3_value *pValue)
+{
+    if (sqlite3_value_type(pValue) == SQLITE_INTEGER)
+    {
+        osAttributeFilter +=
+            CPLSPrintf(CPL_FRMT_GIB, sqlite3_value_int64(pValue));
+    }
+    else if (sqlite3_value_type(pValue) == SQLITE_FLOAT)
+    {  // Insure that only Decimal.Points are used, never local settings
+        // such as Decimal.Comma.
+        osAttributeFilter += CPLSPrintf("%.18g", sqlite3_value_double(pValue));
+    }
+    else if (sqlite3_value_type(pValue) == SQLITE_TEXT)
+    {
+        osAttributeFilter += "'";
+        osAttributeFilter +=
+            SQLEscapeLiteral((const char *)sqlite3_value_text(pValue));
+        osAttributeFilter += "'";
+    }
+    else
+    {
+        sqlite3_free(pMyVTab->zErrMsg);
+        pMyVTab->zErrMsg = sqlite3_mprintf(
+            "Unhandled constraint data type : %d", sqlite3_value_type(pValue));
+        return false;
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                          OGR2SQLITE_Filter()                         */
 /************************************************************************/
@@ -1132,13 +1196,16 @@ static int OGR2SQLITE_Filter(sqlite3_vtab_cursor *pCursor,
     CPLDebug("OGR2SQLITE", "Filter");
 #endif
 
-    int *panConstraints = (int *)idxStr;
-    int nConstraints = panConstraints ? panConstraints[0] : 0;
+    const int *panConstraints = (const int *)idxStr;
+    if (panConstraints == nullptr)
+        return SQLITE_ERROR;
+    const int nConstraints = panConstraints[0];
 
     if (nConstraints != argc)
         return SQLITE_ERROR;
 
     CPLString osAttributeFilter;
+    bool bEmptyResult = false;
 
     OGRFeatureDefn *poFDefn = pMyCursor->poLayer->GetLayerDefn();
 
@@ -1206,6 +1273,33 @@ static int OGR2SQLITE_Filter(sqlite3_vtab_cursor *pCursor,
             case SQLITE_INDEX_CONSTRAINT_EQ:
                 osAttributeFilter += " = ";
                 break;
+#if SQLITE_VERSION_NUMBER >= 3038000L
+            case OGR2SQLITE_CONSTRAINT_IN:
+            {
+                osAttributeFilter += " IN (";
+                int nValues = 0;
+                sqlite3_value *pValue = nullptr;
+                for (int rc = sqlite3_vtab_in_first(argv[i], &pValue);
+                     rc == SQLITE_OK && pValue != nullptr;
+                     rc = sqlite3_vtab_in_next(argv[i], &pValue))
+                {
+                    // NULL never matches
+                    if (sqlite3_value_type(pValue) == SQLITE_NULL)
+                        continue;
+                    if (nValues > 0)
+                        osAttributeFilter += ", ";
+                    if (!OGR2SQLITE_AppendValue(pMyCursor->pVTab,
+                                                osAttributeFilter, pValue))
+                        return SQLITE_ERROR;
+                    ++nValues;
+                }
+                if (nValues == 0)
+                    bEmptyResult = true;
+                osAttributeFilter += ")";
+                bExpectRightOperator = false;
+                break;
+            }
+#endif
             case SQLITE_INDEX_CONSTRAINT_GT:
                 osAttributeFilter += " > ";
                 break;
@@ -1257,32 +1351,9 @@ static int OGR2SQLITE_Filter(sqlite3_vtab_cursor *pCursor,
 
         if (bExpectRightOperator)
         {
-            if (sqlite3_value_type(argv[i]) == SQLITE_INTEGER)
-            {
-                osAttributeFilter +=
-                    CPLSPrintf(CPL_FRMT_GIB, sqlite3_value_int64(argv[i]));
-            }
-            else if (sqlite3_value_type(argv[i]) == SQLITE_FLOAT)
-            {  // Insure that only Decimal.Points are used, never local settings
-                // such as Decimal.Comma.
-                osAttributeFilter +=
-                    CPLSPrintf("%.18g", sqlite3_value_double(argv[i]));
-            }
-            else if (sqlite3_value_type(argv[i]) == SQLITE_TEXT)
-            {
-                osAttributeFilter += "'";
-                osAttributeFilter +=
-                    SQLEscapeLiteral((const char *)sqlite3_value_text(argv[i]));
-                osAttributeFilter += "'";
-            }
-            else
-            {
-                sqlite3_free(pMyCursor->pVTab->zErrMsg);
-                pMyCursor->pVTab->zErrMsg =
-                    sqlite3_mprintf("Unhandled constraint data type : %d",
-                                    sqlite3_value_type(argv[i]));
+            if (!OGR2SQLITE_AppendValue(pMyCursor->pVTab, osAttributeFilter,
+                                        argv[i]))
                 return SQLITE_ERROR;
-            }
         }
     }
 
@@ -1300,7 +1371,49 @@ static int OGR2SQLITE_Filter(sqlite3_vtab_cursor *pCursor,
         return SQLITE_ERROR;
     }
 
-    if (pMyCursor->poLayer->TestCapability(OLCFastFeatureCount))
+    /* -------------------------------------------------------------------- */
+    /*      Do not fetch the fields that the query does not use.            */
+    /* -------------------------------------------------------------------- */
+    sqlite3_uint64 nColUsed = 0;
+    memcpy(&nColUsed, panConstraints + 1 + 2 * nConstraints, sizeof(nColUsed));
+    const auto IsColumnUsed = [nColUsed](int iSQLiteCol)
+    {
+        // Bit 63 stands for all columns from the 64th one
+        return (nColUsed &
+                (static_cast<sqlite3_uint64>(1) << std::min(iSQLiteCol, 63))) !=
+               0;
+    };
+    const int nFirstFieldCol = pMyCursor->pVTab->bHasFIDColumn ? 1 : 0;
+    const int nFieldCount = poFDefn->GetFieldCount();
+    CPLStringList aosIgnoredFields;
+    for (int i = 0; i < nFieldCount; i++)
+    {
+        if (!IsColumnUsed(nFirstFieldCol + i))
+            aosIgnoredFields.AddString(poFDefn->GetFieldDefn(i)->GetNameRef());
+    }
+    if (!IsColumnUsed(nFirstFieldCol + nFieldCount))
+        aosIgnoredFields.AddString("OGR_STYLE");
+    for (int i = 0; i < poFDefn->GetGeomFieldCount(); i++)
+    {
+        if (!IsColumnUsed(nFirstFieldCol + nFieldCount + 1 + i))
+        {
+            const char *pszGeomFieldName =
+                poFDefn->GetGeomFieldDefn(i)->GetNameRef();
+            aosIgnoredFields.AddString(i == 0 && pszGeomFieldName[0] == '\0'
+                                           ? "OGR_GEOMETRY"
+                                           : pszGeomFieldName);
+        }
+    }
+    if (!aosIgnoredFields.empty() || pMyCursor->bHasIgnoredFields)
+    {
+        pMyCursor->poLayer->SetIgnoredFields(
+            aosIgnoredFields.empty() ? nullptr : aosIgnoredFields.List());
+        pMyCursor->bHasIgnoredFields = !aosIgnoredFields.empty();
+    }
+
+    if (bEmptyResult)
+        pMyCursor->nFeatureCount = 0;
+    else if (pMyCursor->poLayer->TestCapability(OLCFastFeatureCount))
         pMyCursor->nFeatureCount = pMyCursor->poLayer->GetFeatureCount();
     else
         pMyCursor->nFeatureCount = -1;
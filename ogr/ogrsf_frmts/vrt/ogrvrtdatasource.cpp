@@ -349,6 +349,23 @@ OGRLayer *OGRVRTDataSource::InstantiateWarpedLayer(CPLXMLNode *psLTree,
     return poLayer;
 }
 
+/************************************************************************/
+/*                        IsSrcDataSourceShared()                       */
+/*                                                                      */
+/*      Must be consistent with OGRVRTLayer::FullInitialize().          */
+/************************************************************************/
+
+static int CountOGRVRTLayers(CPLXMLNode *psTree);
+
+static bool IsSrcDataSourceShared(const CPLXMLNode *psLTree)
+{
+    const char *pszSharedSetting =
+        CPLGetXMLValue(psLTree, "SrcDataSource.shared", nullptr);
+    if (pszSharedSetting == nullptr)
+        return CPLGetXMLValue(psLTree, "SrcSQL", nullptr) != nullptr;
+    return CPLTestBool(pszSharedSetting);
+}
+
 /************************************************************************/
 /*                        InstantiateUnionLayer()                       */
 /************************************************************************/
@@ -624,6 +641,8 @@ OGRLayer *OGRVRTDataSource::InstantiateUnionLayer(CPLXMLNode *psLTree,
     // Find source layers.
     int nSrcLayers = 0;
     OGRLayer **papoSrcLayers = nullptr;
+    // Whether each source layer uses its own source datasource.
+    bool bSrcLayersIndependent = true;
 
     for (CPLXMLNode *psSubNode = psLTree->psChild; psSubNode != nullptr;
          psSubNode = psSubNode->psNext)
@@ -635,6 +654,11 @@ OGRLayer *OGRVRTDataSource::InstantiateUnionLayer(CPLXMLNode *psLTree,
                                                 bUpdate, nRecLevel + 1);
         if (poSrcLayer != nullptr)
         {
+            if (!EQUAL(psSubNode->pszValue, "OGRVRTLayer") ||
+                IsSrcDataSourceShared(psSubNode))
+            {
+                bSrcLayersIndependent = false;
+            }
             papoSrcLayers = static_cast<OGRLayer **>(CPLRealloc(
                 papoSrcLayers, sizeof(OGRLayer *) * (nSrcLayers + 1)));
             papoSrcLayers[nSrcLayers] = poSrcLayer;
@@ -719,6 +743,29 @@ OGRLayer *OGRVRTDataSource::InstantiateUnionLayer(CPLXMLNode *psLTree,
         poLayer->SetFeatureCount(atoi(pszFeatureCount));
     }
 
+    // Open and read ahead the next source layers in worker threads while
+    // the current one is read, if they do not share datasources.
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszNumThreads != nullptr && nSrcLayers > 1 && !bUpdate &&
+        bSrcLayersIndependent)
+    {
+        int nThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                           ? CPLGetNumCPUs()
+                           : std::max(1, atoi(pszNumThreads));
+        // Layers of the pool may be opened, and thus others closed, from
+        // the worker threads: only safe if the pool is used by this layer
+        // only. Leave room in the pool for the layer being read.
+        if (poLayerPool != nullptr)
+        {
+            if (CountOGRVRTLayers(psTree) != nSrcLayers)
+                nThreads = 1;
+            nThreads = std::min(nThreads,
+                                poLayerPool->GetMaxSimultaneouslyOpened());
+        }
+        if (nThreads > 1)
+            poLayer->SetPrefetchDepth(nThreads - 1);
+    }
+
     return poLayer;
 }
 
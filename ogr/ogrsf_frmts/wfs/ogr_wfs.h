@@ -30,6 +30,9 @@
 #ifndef OGR_WFS_H_INCLUDED
 #define OGR_WFS_H_INCLUDED
 
+#include <atomic>
+#include <list>
+#include <memory>
 #include <vector>
 #include <set>
 #include <map>
@@ -72,6 +75,21 @@ class OGRWFSSortDesc
 /************************************************************************/
 
 class OGRWFSDataSource;
+class CPLJobQueue;
+
+/** GetFeature page requested ahead of time, in a worker thread */
+struct OGRWFSPrefetchedPage
+{
+    CPLString osURL{};
+    CPLStringList aosHTTPOptions{};
+    CPLHTTPResult *psResult = nullptr;
+    std::atomic<bool> bDone{false};
+
+    OGRWFSPrefetchedPage() = default;
+    ~OGRWFSPrefetchedPage();
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRWFSPrefetchedPage)
+};
 
 class OGRWFSLayer final : public OGRLayer
 {
@@ -136,6 +154,15 @@ class OGRWFSLayer final : public OGRLayer
     int nPagingStartIndex;
     int nFeatureRead;
 
+    // Must be declared before m_poPrefetchJobQueue, so that the jobs are
+    // completed before the pages they fill in are destroyed.
+    std::list<std::unique_ptr<OGRWFSPrefetchedPage>> m_apoPrefetchedPages{};
+    std::unique_ptr<CPLJobQueue> m_poPrefetchJobQueue{};
+
+    void PrefetchNextPages();
+    CPLHTTPResult *TakePrefetchedPage(const CPLString &osURL);
+    void ClearPrefetchedPages();
+
     OGRFeatureDefn *BuildLayerDefnFromFeatureClass(GMLFeatureClass *poClass);
 
     char *pszRequiredOutputFormat;
@@ -478,6 +505,7 @@ class OGRWFSDataSource final : public OGRDataSource
     void SaveLayerSchema(const char *pszLayerName, const CPLXMLNode *psSchema);
 
     CPLHTTPResult *HTTPFetch(const char *pszURL, char **papszOptions);
+    CPLStringList GetHTTPOptions(CSLConstList papszOptions) const;
 
     bool IsPagingAllowed() const
     {
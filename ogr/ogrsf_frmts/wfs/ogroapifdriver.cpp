@@ -29,7 +29,10 @@
 #include "ogrsf_frmts.h"
 #include "cpl_conv.h"
 #include "cpl_minixml.h"
+#include "cpl_error_internal.h"
 #include "cpl_http.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "ogr_swq.h"
 #include "parsexsd.h"
 
@@ -80,6 +83,7 @@ class OGROAPIFDataset final : public GDALDataset
     friend class OGROAPIFLayer;
 
     bool m_bMustCleanPersistent = false;
+    bool m_bMustCleanPrefetchPersistent = false;
     CPLString m_osRootURL;
     CPLString m_osUserQueryParams;
     CPLString m_osUserPwd;
@@ -99,10 +103,14 @@ class OGROAPIFDataset final : public GDALDataset
     CPLJSONDocument m_oLandingPageDoc;
 
     bool m_bIgnoreSchema = false;
+    bool m_bPrefetchNextPage = false;
 
+    // bPrefetch must be set when called from a worker thread, so that a
+    // different persistent HTTP session than the main thread one is used.
     bool Download(const CPLString &osURL, const char *pszAccept,
                   CPLString &osResult, CPLString &osContentType,
-                  CPLStringList *paosHeaders = nullptr);
+                  CPLStringList *paosHeaders = nullptr,
+                  bool bPrefetch = false);
 
     bool DownloadJSon(const CPLString &osURL, CPLJSONDocument &oDoc,
                       const char *pszAccept = MEDIA_TYPE_GEOJSON
@@ -140,6 +148,16 @@ class OGROAPIFDataset final : public GDALDataset
 /*                            OGROAPIFLayer                              */
 /************************************************************************/
 
+struct OGROAPIFPrefetchedPage
+{
+    OGROAPIFDataset *poDS = nullptr;
+    CPLString osURL{};
+    bool bOK = false;
+    CPLString osResult{};
+    CPLStringList aosHeaders{};
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+};
+
 class OGROAPIFLayer final : public OGRLayer
 {
     OGROAPIFDataset *m_poDS = nullptr;
@@ -179,8 +197,19 @@ class OGROAPIFLayer final : public OGRLayer
     CPLString m_osQueryablesURL{};
     std::vector<std::string> m_aosItemAssetNames{};  // STAC specific
     CPLJSONDocument m_oCurDoc{};
+    CPLString m_osCurPage{};  // Raw content of m_oCurDoc
     int m_iFeatureInPage = 0;
 
+    // Must be declared before m_poPrefetchJobQueue, so that the job is
+    // completed before the page it fills in is destroyed.
+    std::unique_ptr<OGROAPIFPrefetchedPage> m_poPrefetchedPage{};
+    std::unique_ptr<CPLJobQueue> m_poPrefetchJobQueue{};
+
+    static void PrefetchPageJob(void *pData);
+    void PrefetchPage(const CPLString &osURL);
+    void CancelPrefetch();
+    bool DownloadPage(const CPLString &osURL, CPLStringList &aosHeaders);
+
     void EstablishFeatureDefn();
     OGRFeature *GetNextRawFeature();
     CPLString AddFilters(const CPLString &osURL);
@@ -267,6 +296,9 @@ static bool CheckContentType(const char *pszGotContentType,
 
 OGROAPIFDataset::~OGROAPIFDataset()
 {
+    // Make sure that no page prefetching is still in progress
+    m_apoLayers.clear();
+
     if (m_bMustCleanPersistent)
     {
         char **papszOptions = CSLSetNameValue(nullptr, "CLOSE_PERSISTENT",
@@ -274,6 +306,14 @@ OGROAPIFDataset::~OGROAPIFDataset()
         CPLHTTPDestroyResult(CPLHTTPFetch(m_osRootURL, papszOptions));
         CSLDestroy(papszOptions);
     }
+    if (m_bMustCleanPrefetchPersistent)
+    {
+        char **papszOptions =
+            CSLSetNameValue(nullptr, "CLOSE_PERSISTENT",
+                            CPLSPrintf("OAPIF:%p:prefetch", this));
+        CPLHTTPDestroyResult(CPLHTTPFetch(m_osRootURL, papszOptions));
+        CSLDestroy(papszOptions);
+    }
 }
 
 /************************************************************************/
@@ -323,7 +363,7 @@ CPLString OGROAPIFDataset::ReinjectAuthInURL(const CPLString &osURL) const
 
 bool OGROAPIFDataset::Download(const CPLString &osURL, const char *pszAccept,
                                CPLString &osResult, CPLString &osContentType,
-                               CPLStringList *paosHeaders)
+                               CPLStringList *paosHeaders, bool bPrefetch)
 {
 #ifndef REMOVE_HACK
     VSIStatBufL sStatBuf;
@@ -353,9 +393,18 @@ bool OGROAPIFDataset::Download(const CPLString &osURL, const char *pszAccept,
         papszOptions =
             CSLSetNameValue(papszOptions, "USERPWD", m_osUserPwd.c_str());
     }
-    m_bMustCleanPersistent = true;
-    papszOptions =
-        CSLAddString(papszOptions, CPLSPrintf("PERSISTENT=OAPIF:%p", this));
+    if (bPrefetch)
+    {
+        // m_bMustCleanPrefetchPersistent is set by the caller
+        papszOptions = CSLAddString(
+            papszOptions, CPLSPrintf("PERSISTENT=OAPIF:%p:prefetch", this));
+    }
+    else
+    {
+        m_bMustCleanPersistent = true;
+        papszOptions = CSLAddString(papszOptions,
+                                    CPLSPrintf("PERSISTENT=OAPIF:%p", this));
+    }
     CPLString osURLWithQueryParameters(osURL);
     if (!m_osUserQueryParams.empty() &&
         osURL.find('?' + m_osUserQueryParams) == std::string::npos &&
@@ -1080,6 +1129,9 @@ bool OGROAPIFDataset::Open(GDALOpenInfo *poOpenInfo)
     m_bIgnoreSchema = CPLTestBool(CSLFetchNameValueDef(
         poOpenInfo->papszOpenOptions, "IGNORE_SCHEMA", "FALSE"));
 
+    m_bPrefetchNextPage = CPLTestBool(CSLFetchNameValueDef(
+        poOpenInfo->papszOpenOptions, "PREFETCH_NEXT_PAGE", "NO"));
+
     const int pageSize = atoi(
         CSLFetchNameValueDef(poOpenInfo->papszOpenOptions, "PAGE_SIZE", "-1"));
 
@@ -1366,6 +1418,7 @@ OGROAPIFLayer::OGROAPIFLayer(OGROAPIFDataset *poDS, const CPLString &osName,
 
 OGROAPIFLayer::~OGROAPIFLayer()
 {
+    CancelPrefetch();
     m_poFeatureDefn->Release();
 }
 
@@ -1896,6 +1949,7 @@ void OGROAPIFLayer::EstablishFeatureDefn()
 
 void OGROAPIFLayer::ResetReading()
 {
+    CancelPrefetch();
     m_poUnderlyingDS.reset();
     m_poUnderlyingLayer = nullptr;
     m_nFID = 1;
@@ -1972,6 +2026,101 @@ CPLString OGROAPIFLayer::AddFilters(const CPLString &osURL)
     return osURLNew;
 }
 
+/************************************************************************/
+/*                         PrefetchPageJob()                            */
+/************************************************************************/
+
+void OGROAPIFLayer::PrefetchPageJob(void *pData)
+{
+    auto psPage = static_cast<OGROAPIFPrefetchedPage *>(pData);
+    CPLInstallErrorHandlerAccumulator(psPage->aoErrors);
+    CPLString osContentType;
+    psPage->bOK = psPage->poDS->Download(
+        psPage->osURL, MEDIA_TYPE_GEOJSON ", " MEDIA_TYPE_JSON,
+        psPage->osResult, osContentType, &psPage->aosHeaders,
+        /* bPrefetch = */ true);
+    CPLUninstallErrorHandlerAccumulator();
+}
+
+/************************************************************************/
+/*                           PrefetchPage()                             */
+/************************************************************************/
+
+/** Start downloading osURL in a worker thread, while the current page is
+ * being read. */
+void OGROAPIFLayer::PrefetchPage(const CPLString &osURL)
+{
+    CancelPrefetch();
+    if (!m_poPrefetchJobQueue)
+    {
+        auto poPool = GDALGetGlobalThreadPool(1);
+        if (!poPool)
+            return;
+        m_poPrefetchJobQueue = poPool->CreateJobQueue();
+    }
+
+    CPLDebug("OAPIF", "Prefetching %s", osURL.c_str());
+    m_poPrefetchedPage = std::make_unique<OGROAPIFPrefetchedPage>();
+    m_poPrefetchedPage->poDS = m_poDS;
+    m_poPrefetchedPage->osURL = osURL;
+    m_poDS->m_bMustCleanPrefetchPersistent = true;
+    if (!m_poPrefetchJobQueue->SubmitJob(PrefetchPageJob,
+                                         m_poPrefetchedPage.get()))
+    {
+        m_poPrefetchedPage.reset();
+    }
+}
+
+/************************************************************************/
+/*                          CancelPrefetch()                            */
+/************************************************************************/
+
+void OGROAPIFLayer::CancelPrefetch()
+{
+    if (m_poPrefetchJobQueue)
+        m_poPrefetchJobQueue->WaitCompletion();
+    m_poPrefetchedPage.reset();
+}
+
+/************************************************************************/
+/*                           DownloadPage()                             */
+/************************************************************************/
+
+/** Download osURL into m_osCurPage and m_oCurDoc, using the prefetched
+ * page if it matches. */
+bool OGROAPIFLayer::DownloadPage(const CPLString &osURL,
+                                 CPLStringList &aosHeaders)
+{
+    m_oCurDoc = CPLJSONDocument();
+    m_osCurPage.clear();
+
+    if (m_poPrefetchedPage)
+    {
+        m_poPrefetchJobQueue->WaitCompletion();
+        auto poPage = std::move(m_poPrefetchedPage);
+        if (poPage->osURL == osURL)
+        {
+            for (const auto &oError : poPage->aoErrors)
+            {
+                CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+            }
+            if (!poPage->bOK)
+                return false;
+            m_osCurPage = std::move(poPage->osResult);
+            aosHeaders = std::move(poPage->aosHeaders);
+            return m_oCurDoc.LoadMemory(m_osCurPage);
+        }
+    }
+
+    CPLString osContentType;
+    if (!m_poDS->Download(osURL, MEDIA_TYPE_GEOJSON ", " MEDIA_TYPE_JSON,
+                          m_osCurPage, osContentType, &aosHeaders))
+    {
+        return false;
+    }
+    return m_oCurDoc.LoadMemory(m_osCurPage);
+}
+
 /************************************************************************/
 /*                         GetNextRawFeature()                          */
 /************************************************************************/
@@ -1989,14 +2138,10 @@ OGRFeature *OGROAPIFLayer::GetNextRawFeature()
             if (m_osGetURL.empty())
                 return nullptr;
 
-            m_oCurDoc = CPLJSONDocument();
-
             CPLString osURL(m_osGetURL);
             m_osGetURL.clear();
             CPLStringList aosHeaders;
-            if (!m_poDS->DownloadJSon(osURL, m_oCurDoc,
-                                      MEDIA_TYPE_GEOJSON ", " MEDIA_TYPE_JSON,
-                                      &aosHeaders))
+            if (!DownloadPage(osURL, aosHeaders))
             {
                 return nullptr;
             }
@@ -2057,8 +2202,13 @@ OGRFeature *OGROAPIFLayer::GetNextRawFeature()
                 }
             }
 
+            // Expose the downloaded page as is (without copy), rather than
+            // re-serializing m_oCurDoc. m_osCurPage must be kept unmodified
+            // while m_poUnderlyingDS is opened.
             CPLString osTmpFilename(CPLSPrintf("/vsimem/oapif_%p.json", this));
-            m_oCurDoc.Save(osTmpFilename);
+            VSIFCloseL(VSIFileFromMemBuffer(
+                osTmpFilename, reinterpret_cast<GByte *>(&m_osCurPage[0]),
+                m_osCurPage.size(), /* bTakeOwnership = */ false));
             m_poUnderlyingDS =
                 std::unique_ptr<GDALDataset>(GDALDataset::FromHandle(
                     GDALOpenEx(osTmpFilename, GDAL_OF_VECTOR | GDAL_OF_INTERNAL,
@@ -2148,6 +2298,8 @@ OGRFeature *OGROAPIFLayer::GetNextRawFeature()
                 if (!m_osGetURL.empty())
                 {
                     m_osGetURL = m_poDS->ReinjectAuthInURL(m_osGetURL);
+                    if (m_poDS->m_bPrefetchNextPage)
+                        PrefetchPage(m_osGetURL);
                 }
             }
         }
@@ -3174,6 +3326,10 @@ void RegisterOGROAPIF()
         "  <Option name='IGNORE_SCHEMA' type='boolean' "
         "description='Whether the XML Schema or JSON Schema should be ignored' "
         "default='NO'/>"
+        "  <Option name='PREFETCH_NEXT_PAGE' type='boolean' "
+        "description='Whether the next page of features should be downloaded "
+        "while the current one is read' "
+        "default='NO'/>"
         "  <Option name='CRS' type='string' "
         "description='CRS identifier to use for layers'/>"
         "  <Option name='PREFERRED_CRS' type='string' "
@@ -2163,6 +2163,20 @@ CPLString WFS_DecodeURL(const CPLString &osSrc)
     return ret;
 }
 
+/************************************************************************/
+/*                           GetHTTPOptions()                           */
+/************************************************************************/
+
+CPLStringList OGRWFSDataSource::GetHTTPOptions(CSLConstList papszOptions) const
+{
+    CPLStringList aosOptions(CSLDuplicate(papszOptions));
+    if (bUseHttp10)
+        aosOptions.AddNameValue("HTTP_VERSION", "1.0");
+    if (papszHttpOptions)
+        aosOptions.Assign(CSLMerge(aosOptions.StealList(), papszHttpOptions));
+    return aosOptions;
+}
+
 /************************************************************************/
 /*                            HTTPFetch()                               */
 /************************************************************************/
@@ -2170,14 +2184,8 @@ CPLString WFS_DecodeURL(const CPLString &osSrc)
 CPLHTTPResult *OGRWFSDataSource::HTTPFetch(const char *pszURL,
                                            char **papszOptions)
 {
-    char **papszNewOptions = CSLDuplicate(papszOptions);
-    if (bUseHttp10)
-        papszNewOptions =
-            CSLAddNameValue(papszNewOptions, "HTTP_VERSION", "1.0");
-    if (papszHttpOptions)
-        papszNewOptions = CSLMerge(papszNewOptions, papszHttpOptions);
-    CPLHTTPResult *psResult = CPLHTTPFetch(pszURL, papszNewOptions);
-    CSLDestroy(papszNewOptions);
+    CPLHTTPResult *psResult =
+        CPLHTTPFetch(pszURL, GetHTTPOptions(papszOptions).List());
 
     if (psResult == nullptr)
     {
@@ -31,8 +31,12 @@
 #include "ogr_api.h"
 #include "cpl_minixml.h"
 #include "cpl_http.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "parsexsd.h"
 
+#include <algorithm>
+
 /************************************************************************/
 /*                      OGRWFSRecursiveUnlink()                         */
 /************************************************************************/
@@ -146,6 +150,8 @@ OGRWFSLayer::~OGRWFSLayer()
 
     GDALClose(poBaseDS);
 
+    ClearPrefetchedPages();
+
     delete poFetchedFilterGeom;
 
     CPLString osTmpDirName = CPLSPrintf("/vsimem/tempwfs_%p", this);
@@ -749,6 +755,149 @@ bool OGRWFSLayer::MustRetryIfNonCompliantServer(const char *pszServerAnswer)
     return bRetry;
 }
 
+/************************************************************************/
+/*                        OGRWFSPrefetchedPage                          */
+/************************************************************************/
+
+OGRWFSPrefetchedPage::~OGRWFSPrefetchedPage()
+{
+    CPLHTTPDestroyResult(psResult);
+}
+
+/************************************************************************/
+/*                         FetchPageJob()                               */
+/************************************************************************/
+
+static void FetchPageJob(void *pData)
+{
+    auto psPage = static_cast<OGRWFSPrefetchedPage *>(pData);
+    {
+        // Failures are silently ignored here: the page is requested again
+        // synchronously, with proper error reporting, if it is needed.
+        CPLErrorHandlerPusher oPusher(CPLQuietErrorHandler);
+        psPage->psResult =
+            CPLHTTPFetch(psPage->osURL, psPage->aosHTTPOptions.List());
+    }
+    psPage->bDone = true;
+}
+
+/************************************************************************/
+/*                        PrefetchNextPages()                           */
+/************************************************************************/
+
+/** Issue in worker threads the GetFeature requests of the pages that follow
+ * the current one, as set by the OGR_WFS_PREFETCH_PAGES configuration option.
+ */
+void OGRWFSLayer::PrefetchNextPages()
+{
+    const int nPrefetchPages =
+        atoi(CPLGetConfigOption("OGR_WFS_PREFETCH_PAGES", "0"));
+    if (!bPagingActive || nPrefetchPages <= 0)
+        return;
+
+    if (!m_poPrefetchJobQueue)
+    {
+        auto poPool = GDALGetGlobalThreadPool(std::min(nPrefetchPages, 16));
+        if (!poPool)
+            return;
+        m_poPrefetchJobQueue = poPool->CreateJobQueue();
+    }
+
+    const int nPageSize = poDS->GetPageSize();
+    const int nCurStartIndex = nPagingStartIndex;
+    std::vector<CPLString> aosURLs;
+    for (int i = 1; i <= nPrefetchPages; ++i)
+    {
+        const GIntBig nStartIndex =
+            static_cast<GIntBig>(nCurStartIndex) +
+            static_cast<GIntBig>(i) * nPageSize;
+        if (nStartIndex > INT_MAX ||
+            (m_nNumberMatched >= 0 && nStartIndex >= m_nNumberMatched))
+            break;
+        nPagingStartIndex = static_cast<int>(nStartIndex);
+        aosURLs.push_back(MakeGetFeatureURL(0, FALSE));
+    }
+    nPagingStartIndex = nCurStartIndex;
+
+    // Forget about completed pages that are outside of the new window (can
+    // happen if the server returned less features than the page size)
+    for (auto oIter = m_apoPrefetchedPages.begin();
+         oIter != m_apoPrefetchedPages.end();)
+    {
+        if ((*oIter)->bDone && std::find(aosURLs.begin(), aosURLs.end(),
+                                         (*oIter)->osURL) == aosURLs.end())
+            oIter = m_apoPrefetchedPages.erase(oIter);
+        else
+            ++oIter;
+    }
+
+    for (const auto &osURL : aosURLs)
+    {
+        bool bAlreadyPrefetched = false;
+        for (const auto &poPage : m_apoPrefetchedPages)
+        {
+            if (poPage->osURL == osURL)
+            {
+                bAlreadyPrefetched = true;
+                break;
+            }
+        }
+        if (bAlreadyPrefetched)
+            continue;
+
+        CPLDebug("WFS", "Prefetching %s", osURL.c_str());
+        auto poPage = std::make_unique<OGRWFSPrefetchedPage>();
+        poPage->osURL = osURL;
+        poPage->aosHTTPOptions = poDS->GetHTTPOptions(nullptr);
+        if (!m_poPrefetchJobQueue->SubmitJob(FetchPageJob, poPage.get()))
+            break;
+        m_apoPrefetchedPages.push_back(std::move(poPage));
+    }
+}
+
+/************************************************************************/
+/*                        TakePrefetchedPage()                          */
+/************************************************************************/
+
+/** Return (and transfer ownership of) the result of a prefetched request
+ * of URL osURL, or nullptr if there is none, or if it failed. */
+CPLHTTPResult *OGRWFSLayer::TakePrefetchedPage(const CPLString &osURL)
+{
+    for (auto oIter = m_apoPrefetchedPages.begin();
+         oIter != m_apoPrefetchedPages.end(); ++oIter)
+    {
+        auto &poPage = *oIter;
+        if (poPage->osURL != osURL)
+            continue;
+
+        while (!poPage->bDone)
+            m_poPrefetchJobQueue->GetPool()->WaitEvent();
+
+        CPLHTTPResult *psResult = nullptr;
+        if (poPage->psResult && poPage->psResult->nStatus == 0 &&
+            poPage->psResult->pszErrBuf == nullptr &&
+            poPage->psResult->pabyData != nullptr)
+        {
+            CPLDebug("WFS", "Using prefetched page");
+            std::swap(psResult, poPage->psResult);
+        }
+        m_apoPrefetchedPages.erase(oIter);
+        return psResult;
+    }
+    return nullptr;
+}
+
+/************************************************************************/
+/*                       ClearPrefetchedPages()                         */
+/************************************************************************/
+
+void OGRWFSLayer::ClearPrefetchedPages()
+{
+    if (m_poPrefetchJobQueue)
+        m_poPrefetchJobQueue->WaitCompletion();
+    m_apoPrefetchedPages.clear();
+}
+
 /************************************************************************/
 /*                         FetchGetFeature()                            */
 /************************************************************************/
@@ -759,7 +908,9 @@ GDALDataset *OGRWFSLayer::FetchGetFeature(int nRequestMaxFeatures)
     CPLString osURL = MakeGetFeatureURL(nRequestMaxFeatures, FALSE);
     CPLDebug("WFS", "%s", osURL.c_str());
 
-    CPLHTTPResult *psResult = nullptr;
+    // A prefetched page is already fully downloaded: no need to stream it
+    CPLHTTPResult *psResult =
+        nRequestMaxFeatures == 0 ? TakePrefetchedPage(osURL) : nullptr;
 
     CPLString osOutputFormat = CPLURLGetValue(osURL, "OUTPUTFORMAT");
 
@@ -783,7 +934,8 @@ GDALDataset *OGRWFSLayer::FetchGetFeature(int nRequestMaxFeatures)
         }
     };
 
-    if (CPLTestBool(CPLGetConfigOption("OGR_WFS_USE_STREAMING", "YES")))
+    if (psResult == nullptr &&
+        CPLTestBool(CPLGetConfigOption("OGR_WFS_USE_STREAMING", "YES")))
     {
         CPLString osStreamingName;
         if (STARTS_WITH(osURL, "/vsimem/") &&
@@ -909,10 +1061,13 @@ GDALDataset *OGRWFSLayer::FetchGetFeature(int nRequestMaxFeatures)
     }
 
     bStreamingDS = false;
-    psResult = poDS->HTTPFetch(osURL, nullptr);
     if (psResult == nullptr)
     {
-        return nullptr;
+        psResult = poDS->HTTPFetch(osURL, nullptr);
+        if (psResult == nullptr)
+        {
+            return nullptr;
+        }
     }
 
     const char *pszContentType = "";
@@ -1274,6 +1429,7 @@ void OGRWFSLayer::ResetReading()
         poBaseLayer = nullptr;
         bHasFetched = false;
         bReloadNeeded = false;
+        ClearPrefetchedPages();
     }
     if (poBaseLayer)
         poBaseLayer->ResetReading();
@@ -1321,6 +1477,8 @@ OGRFeature *OGRWFSLayer::GetNextFeature()
                     return nullptr;
                 poBaseLayer->ResetReading();
 
+                PrefetchNextPages();
+
                 /* Check that the layer field definition is consistent with the
                  * one */
                 /* we got in BuildLayerDefn() */
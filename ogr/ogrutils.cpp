@@ -33,6 +33,7 @@
 #include "ogr_p.h"
 
 #include <cassert>
+#include <charconv>
 #include <cmath>
 #include <cstddef>
 #include <cstdio>
@@ -237,22 +238,70 @@ std::string OGRFormatDouble(double val, const OGRWktOptions &opts)
     if (std::isnan(val))
         return "nan";
 
-    std::ostringstream oss;
-    oss.imbue(std::locale::classic());  // Make sure we output decimal points.
     bool l_round(opts.round);
-    if (opts.format == OGRWktFormat::F ||
-        (opts.format == OGRWktFormat::Default && fabs(val) < 1))
-        oss << std::fixed;
+    const bool bFixed =
+        opts.format == OGRWktFormat::F ||
+        (opts.format == OGRWktFormat::Default && fabs(val) < 1);
+    if (!bFixed)
+        l_round = false;
+
+    // Stream formatting of floating-point numbers is specified in terms of
+    // printf() conversions, so use directly the equivalent %f / %G
+    // conversion in the common case, which is much faster than going
+    // through a std::ostringstream. std::to_chars() with a precision is
+    // itself specified as equivalent to printf() in the C locale.
+    std::string sval;
+    char szBuffer[128];
+    int nLen = -1;
+    if (opts.precision >= 0 && opts.precision < 100)
+    {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        const auto res = std::to_chars(
+            szBuffer, szBuffer + sizeof(szBuffer), val,
+            bFixed ? std::chars_format::fixed : std::chars_format::general,
+            opts.precision);
+        if (res.ec == std::errc())
+        {
+            nLen = static_cast<int>(res.ptr - szBuffer);
+            if (!bFixed)
+            {
+                char *pszExp = static_cast<char *>(memchr(szBuffer, 'e', nLen));
+                if (pszExp)
+                    *pszExp = 'E';
+            }
+        }
+#else
+        if (bFixed)
+        {
+            nLen = CPLsnprintf(szBuffer, sizeof(szBuffer), "%.*f",
+                               opts.precision, val);
+        }
+        else
+        {
+            char szFormat[8];
+            snprintf(szFormat, sizeof(szFormat), "%%.%dG", opts.precision);
+            nLen = CPLsnprintf(szBuffer, sizeof(szBuffer), szFormat, val);
+        }
+#endif
+    }
+    if (nLen > 0 && nLen < static_cast<int>(sizeof(szBuffer)))
+    {
+        sval.assign(szBuffer, nLen);
+    }
     else
     {
-        // Uppercase because OGC spec says capital 'E'.
-        oss << std::uppercase;
-        l_round = false;
+        std::ostringstream oss;
+        // Make sure we output decimal points.
+        oss.imbue(std::locale::classic());
+        if (bFixed)
+            oss << std::fixed;
+        else
+            // Uppercase because OGC spec says capital 'E'.
+            oss << std::uppercase;
+        oss << std::setprecision(opts.precision);
+        oss << val;
+        sval = oss.str();
     }
-    oss << std::setprecision(opts.precision);
-    oss << val;
-
-    std::string sval = oss.str();
 
     if (l_round)
         sval = intelliround(sval);
@@ -64,6 +64,22 @@ void swqerror(swq_parse_context *context, const char *msg)
     CPLError(CE_Failure, CPLE_AppDefined, "%s", osMsg.c_str());
 }
 
+/************************************************************************/
+/*                        IsFollowedByKeyword()                         */
+/************************************************************************/
+
+static bool IsFollowedByKeyword(const char *pszInput, const char *pszKeyword)
+{
+    while (*pszInput == ' ' || *pszInput == '\t' || *pszInput == 10 ||
+           *pszInput == 13)
+        pszInput++;
+    const size_t nLen = strlen(pszKeyword);
+    return EQUALN(pszInput, pszKeyword, nLen) &&
+           !isalnum(static_cast<unsigned char>(pszInput[nLen])) &&
+           pszInput[nLen] != '_' &&
+           static_cast<unsigned char>(pszInput[nLen]) <= 127;
+}
+
 /************************************************************************/
 /*                               swqlex()                               */
 /*                                                                      */
@@ -267,6 +283,11 @@ int swqlex(YYSTYPE *ppNode, swq_parse_context *context)
             nReturn = SWQT_ON;
         else if (EQUAL(osToken, "ORDER"))
             nReturn = SWQT_ORDER;
+        // GROUP is only a keyword in a SELECT statement, when followed by
+        // BY, so that fields named "group" can still be used unquoted.
+        else if (EQUAL(osToken, "GROUP") && context->poCurSelect != nullptr &&
+                 IsFollowedByKeyword(pszNext, "BY"))
+            nReturn = SWQT_GROUP;
         else if (EQUAL(osToken, "BY"))
             nReturn = SWQT_BY;
         else if (EQUAL(osToken, "FROM"))
@@ -422,10 +443,19 @@ const char *swq_select_summarize(swq_select *select_info, int dest_column,
         return nullptr;
     }
 
-    /* -------------------------------------------------------------------- */
-    /*      Process various options.                                        */
-    /* -------------------------------------------------------------------- */
+    return swq_summary_accumulate(def, summary, value);
+}
 
+/************************************************************************/
+/*                       swq_summary_accumulate()                       */
+/************************************************************************/
+
+/** Updates summary with value (nullptr for a NULL value), according to the
+ * column function of def. Distinct processing is not handled here.
+ */
+const char *swq_summary_accumulate(const swq_col_def *def,
+                                   swq_summary &summary, const char *value)
+{
     switch (def->col_func)
     {
         case SWQCF_MIN:
@@ -936,7 +966,8 @@ CPLErr swq_expr_compile2(const char *where_clause, swq_field_list *field_list,
 static const char *const apszSQLReservedKeywords[] = {
     "OR",    "AND",      "NOT",    "LIKE",   "IS",   "NULL", "IN",    "BETWEEN",
     "CAST",  "DISTINCT", "ESCAPE", "SELECT", "LEFT", "JOIN", "WHERE", "ON",
-    "ORDER", "BY",       "FROM",   "AS",     "ASC",  "DESC", "UNION", "ALL"};
+    "ORDER", "GROUP",    "BY",     "FROM",   "AS",   "ASC",  "DESC",  "UNION",
+    "ALL"};
 
 int swq_is_reserved_keyword(const char *pszStr)
 {
@@ -36,10 +36,10 @@
    private implementation details that can be changed or removed.  */
 
 #ifndef YY_SWQ_SWQ_PARSER_HPP_INCLUDED
-#define YY_SWQ_SWQ_PARSER_HPP_INCLUDED
+# define YY_SWQ_SWQ_PARSER_HPP_INCLUDED
 /* Debug traces.  */
 #ifndef YYDEBUG
-#define YYDEBUG 0
+# define YYDEBUG 0
 #endif
 #if YYDEBUG
 extern int swqdebug;
@@ -47,61 +47,66 @@ extern int swqdebug;
 
 /* Token kinds.  */
 #ifndef YYTOKENTYPE
-#define YYTOKENTYPE
-enum yytokentype
-{
+# define YYTOKENTYPE
+  enum yytokentype
+  {
     YYEMPTY = -2,
-    END = 0,                    /* "end of string"  */
-    YYerror = 256,              /* error  */
-    YYUNDEF = 257,              /* "invalid token"  */
-    SWQT_INTEGER_NUMBER = 258,  /* "integer number"  */
-    SWQT_FLOAT_NUMBER = 259,    /* "floating point number"  */
-    SWQT_STRING = 260,          /* "string"  */
-    SWQT_IDENTIFIER = 261,      /* "identifier"  */
-    SWQT_IN = 262,              /* "IN"  */
-    SWQT_LIKE = 263,            /* "LIKE"  */
-    SWQT_ILIKE = 264,           /* "ILIKE"  */
-    SWQT_ESCAPE = 265,          /* "ESCAPE"  */
-    SWQT_BETWEEN = 266,         /* "BETWEEN"  */
-    SWQT_NULL = 267,            /* "NULL"  */
-    SWQT_IS = 268,              /* "IS"  */
-    SWQT_SELECT = 269,          /* "SELECT"  */
-    SWQT_LEFT = 270,            /* "LEFT"  */
-    SWQT_JOIN = 271,            /* "JOIN"  */
-    SWQT_WHERE = 272,           /* "WHERE"  */
-    SWQT_ON = 273,              /* "ON"  */
-    SWQT_ORDER = 274,           /* "ORDER"  */
-    SWQT_BY = 275,              /* "BY"  */
-    SWQT_FROM = 276,            /* "FROM"  */
-    SWQT_AS = 277,              /* "AS"  */
-    SWQT_ASC = 278,             /* "ASC"  */
-    SWQT_DESC = 279,            /* "DESC"  */
-    SWQT_DISTINCT = 280,        /* "DISTINCT"  */
-    SWQT_CAST = 281,            /* "CAST"  */
-    SWQT_UNION = 282,           /* "UNION"  */
-    SWQT_ALL = 283,             /* "ALL"  */
-    SWQT_LIMIT = 284,           /* "LIMIT"  */
-    SWQT_OFFSET = 285,          /* "OFFSET"  */
-    SWQT_EXCEPT = 286,          /* "EXCEPT"  */
-    SWQT_EXCLUDE = 287,         /* "EXCLUDE"  */
-    SWQT_VALUE_START = 288,     /* SWQT_VALUE_START  */
-    SWQT_SELECT_START = 289,    /* SWQT_SELECT_START  */
-    SWQT_NOT = 290,             /* "NOT"  */
-    SWQT_OR = 291,              /* "OR"  */
-    SWQT_AND = 292,             /* "AND"  */
-    SWQT_UMINUS = 293,          /* SWQT_UMINUS  */
-    SWQT_RESERVED_KEYWORD = 294 /* "reserved keyword"  */
-};
-typedef enum yytokentype yytoken_kind_t;
+    END = 0,                       /* "end of string"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    SWQT_INTEGER_NUMBER = 258,     /* "integer number"  */
+    SWQT_FLOAT_NUMBER = 259,       /* "floating point number"  */
+    SWQT_STRING = 260,             /* "string"  */
+    SWQT_IDENTIFIER = 261,         /* "identifier"  */
+    SWQT_IN = 262,                 /* "IN"  */
+    SWQT_LIKE = 263,               /* "LIKE"  */
+    SWQT_ILIKE = 264,              /* "ILIKE"  */
+    SWQT_ESCAPE = 265,             /* "ESCAPE"  */
+    SWQT_BETWEEN = 266,            /* "BETWEEN"  */
+    SWQT_NULL = 267,               /* "NULL"  */
+    SWQT_IS = 268,                 /* "IS"  */
+    SWQT_SELECT = 269,             /* "SELECT"  */
+    SWQT_LEFT = 270,               /* "LEFT"  */
+    SWQT_JOIN = 271,               /* "JOIN"  */
+    SWQT_WHERE = 272,              /* "WHERE"  */
+    SWQT_ON = 273,                 /* "ON"  */
+    SWQT_ORDER = 274,              /* "ORDER"  */
+    SWQT_GROUP = 275,              /* "GROUP"  */
+    SWQT_BY = 276,                 /* "BY"  */
+    SWQT_FROM = 277,               /* "FROM"  */
+    SWQT_AS = 278,                 /* "AS"  */
+    SWQT_ASC = 279,                /* "ASC"  */
+    SWQT_DESC = 280,               /* "DESC"  */
+    SWQT_DISTINCT = 281,           /* "DISTINCT"  */
+    SWQT_CAST = 282,               /* "CAST"  */
+    SWQT_UNION = 283,              /* "UNION"  */
+    SWQT_ALL = 284,                /* "ALL"  */
+    SWQT_LIMIT = 285,              /* "LIMIT"  */
+    SWQT_OFFSET = 286,             /* "OFFSET"  */
+    SWQT_EXCEPT = 287,             /* "EXCEPT"  */
+    SWQT_EXCLUDE = 288,            /* "EXCLUDE"  */
+    SWQT_VALUE_START = 289,        /* SWQT_VALUE_START  */
+    SWQT_SELECT_START = 290,       /* SWQT_SELECT_START  */
+    SWQT_NOT = 291,                /* "NOT"  */
+    SWQT_OR = 292,                 /* "OR"  */
+    SWQT_AND = 293,                /* "AND"  */
+    SWQT_UMINUS = 294,             /* SWQT_UMINUS  */
+    SWQT_RESERVED_KEYWORD = 295    /* "reserved keyword"  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
 /* Value type.  */
-#if !defined YYSTYPE && !defined YYSTYPE_IS_DECLARED
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
 typedef int YYSTYPE;
-#define YYSTYPE_IS_TRIVIAL 1
-#define YYSTYPE_IS_DECLARED 1
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
 #endif
 
-int swqparse(swq_parse_context *context);
+
+
+
+int swqparse (swq_parse_context *context);
+
 
 #endif /* !YY_SWQ_SWQ_PARSER_HPP_INCLUDED  */
@@ -0,0 +1,843 @@
+/******************************************************************************
+ *
+ * Component: OGR SQL Engine
+ * Purpose: Compiled form of WHERE expressions, evaluated over batches of
+ *          records.
+ * Author: GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "ogr_swq.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+
+#include "cpl_conv.h"
+#include "ogr_p.h"
+
+// swq_expr_node::Evaluate() fails beyond that recursion level
+constexpr int MAX_DEPTH = 30;
+
+/************************************************************************/
+/*                            ~swq_program()                            */
+/************************************************************************/
+
+swq_program::~swq_program() = default;
+
+/************************************************************************/
+/*                         IsIntegerLikeType()                          */
+/************************************************************************/
+
+static bool IsIntegerLikeType(swq_field_type eType)
+{
+    return SWQ_IS_INTEGER(eType) || eType == SWQ_BOOLEAN;
+}
+
+/************************************************************************/
+/*                             ToLowerASCII()                           */
+/************************************************************************/
+
+// Same case folding as strcasecmp() in the C locale.
+static inline int ToLowerASCII(char ch)
+{
+    return tolower(static_cast<unsigned char>(ch));
+}
+
+static void ToLowerASCII(const char *pszStr, size_t nLen, std::string &osOut)
+{
+    osOut.resize(nLen);
+    for (size_t i = 0; i < nLen; ++i)
+        osOut[i] = static_cast<char>(ToLowerASCII(pszStr[i]));
+}
+
+/************************************************************************/
+/*                               Compile()                              */
+/************************************************************************/
+
+/* Returns nullptr if the expression, that must have been checked, contains
+ * constructs that the program does not handle. In that case,
+ * swq_expr_node::Evaluate() must be used.
+ */
+std::unique_ptr<swq_program> swq_program::Compile(const swq_expr_node *poExpr,
+                                                  int nFieldCount,
+                                                  int nGeomFieldCount)
+{
+    if (poExpr == nullptr)
+        return nullptr;
+
+    std::unique_ptr<swq_program> poProgram(new swq_program());
+    poProgram->m_nFieldCount = nFieldCount;
+    poProgram->m_nGeomFieldCount = nGeomFieldCount;
+    if (!poProgram->CompileNode(poExpr, 0, 0))
+        return nullptr;
+    return poProgram;
+}
+
+/************************************************************************/
+/*                             CompileNode()                            */
+/************************************************************************/
+
+bool swq_program::CompileNode(const swq_expr_node *poNode, int nDepth,
+                              int nStackDepth)
+{
+    if (nDepth >= MAX_DEPTH || poNode->eNodeType != SNT_OPERATION)
+        return false;
+
+    Instr oInstr;
+    switch (poNode->nOperation)
+    {
+        case SWQ_AND:
+        case SWQ_OR:
+        {
+            // Logical operators on columns or constants have specific null
+            // semantics. Only handle them on results of tests.
+            if (poNode->nSubExprCount != 2 ||
+                !CompileNode(poNode->papoSubExpr[0], nDepth + 1,
+                             nStackDepth) ||
+                !CompileNode(poNode->papoSubExpr[1], nDepth + 1,
+                             nStackDepth + 1))
+            {
+                return false;
+            }
+            oInstr.eOpcode =
+                poNode->nOperation == SWQ_AND ? Opcode::AND : Opcode::OR;
+            break;
+        }
+
+        case SWQ_NOT:
+        {
+            if (poNode->nSubExprCount != 1 ||
+                !CompileNode(poNode->papoSubExpr[0], nDepth + 1, nStackDepth))
+            {
+                return false;
+            }
+            oInstr.eOpcode = Opcode::NOT;
+            break;
+        }
+
+        default:
+        {
+            if (!CompileLeaf(poNode))
+                return false;
+            oInstr.eOpcode = Opcode::LEAF;
+            oInstr.iLeaf = static_cast<int>(m_aoLeaves.size()) - 1;
+            m_nMaxStackDepth = std::max(m_nMaxStackDepth, nStackDepth + 1);
+            break;
+        }
+    }
+    m_aoInstrs.push_back(oInstr);
+    return true;
+}
+
+/************************************************************************/
+/*                              GetColumn()                             */
+/************************************************************************/
+
+/* Returns the index of the program column for a column node, or -1 if the
+ * column is not a regular field or the FID. */
+int swq_program::GetColumn(const swq_expr_node *poNode,
+                           swq_field_type eValueType)
+{
+    if (poNode->eNodeType != SNT_COLUMN || poNode->table_index != 0 ||
+        poNode->field_index < 0)
+    {
+        return -1;
+    }
+
+    int nFieldIndex = poNode->field_index;
+    if (nFieldIndex >= m_nFieldCount)
+    {
+        // Either the FID special field, or the FID column that
+        // OGRFeatureQuery::Compile() adds after the geometry fields.
+        if (nFieldIndex != m_nFieldCount + SPF_FID &&
+            nFieldIndex !=
+                m_nFieldCount + SPECIAL_FIELD_COUNT + m_nGeomFieldCount)
+        {
+            return -1;
+        }
+        nFieldIndex = m_nFieldCount + SPF_FID;
+    }
+
+    for (size_t i = 0; i < m_aoColumns.size(); ++i)
+    {
+        auto &oColumn = m_aoColumns[i];
+        if (oColumn.field_index == nFieldIndex &&
+            oColumn.field_type == poNode->field_type)
+        {
+            if (oColumn.value_type == SWQ_NULL)
+                oColumn.value_type = eValueType;
+            else if (eValueType != SWQ_NULL &&
+                     oColumn.value_type != eValueType)
+                continue;
+            return static_cast<int>(i);
+        }
+    }
+
+    Column oColumn;
+    oColumn.field_index = nFieldIndex;
+    oColumn.field_type = poNode->field_type;
+    oColumn.value_type = eValueType;
+    m_aoColumns.push_back(oColumn);
+    return static_cast<int>(m_aoColumns.size()) - 1;
+}
+
+/************************************************************************/
+/*                             CompileLeaf()                            */
+/************************************************************************/
+
+bool swq_program::CompileLeaf(const swq_expr_node *poNode)
+{
+    const int nSubExprCount = poNode->nSubExprCount;
+    if (nSubExprCount < 1)
+        return false;
+
+    Leaf oLeaf;
+    oLeaf.eOp = poNode->nOperation;
+
+    if (poNode->nOperation == SWQ_ISNULL)
+    {
+        if (nSubExprCount != 1)
+            return false;
+        oLeaf.eType = LeafType::ISNULL;
+        oLeaf.iColumn = GetColumn(poNode->papoSubExpr[0], SWQ_NULL);
+        if (oLeaf.iColumn < 0)
+            return false;
+        m_aoLeaves.push_back(std::move(oLeaf));
+        return true;
+    }
+
+    // Locate the column and the constants
+    const swq_expr_node *poColumn = nullptr;
+    std::vector<const swq_expr_node *> apoConstants;
+    switch (poNode->nOperation)
+    {
+        case SWQ_EQ:
+        case SWQ_NE:
+        case SWQ_GT:
+        case SWQ_LT:
+        case SWQ_GE:
+        case SWQ_LE:
+        {
+            if (nSubExprCount != 2)
+                return false;
+            if (poNode->papoSubExpr[0]->eNodeType == SNT_COLUMN)
+            {
+                poColumn = poNode->papoSubExpr[0];
+                apoConstants.push_back(poNode->papoSubExpr[1]);
+            }
+            else
+            {
+                oLeaf.bConstantFirst = true;
+                poColumn = poNode->papoSubExpr[1];
+                apoConstants.push_back(poNode->papoSubExpr[0]);
+                // Express the test as "column op constant"
+                if (oLeaf.eOp == SWQ_GT)
+                    oLeaf.eOp = SWQ_LT;
+                else if (oLeaf.eOp == SWQ_LT)
+                    oLeaf.eOp = SWQ_GT;
+                else if (oLeaf.eOp == SWQ_GE)
+                    oLeaf.eOp = SWQ_LE;
+                else if (oLeaf.eOp == SWQ_LE)
+                    oLeaf.eOp = SWQ_GE;
+            }
+            break;
+        }
+
+        case SWQ_BETWEEN:
+        case SWQ_IN:
+        case SWQ_LIKE:
+        case SWQ_ILIKE:
+        {
+            if ((poNode->nOperation == SWQ_BETWEEN && nSubExprCount != 3) ||
+                (poNode->nOperation == SWQ_IN && nSubExprCount < 2) ||
+                ((poNode->nOperation == SWQ_LIKE ||
+                  poNode->nOperation == SWQ_ILIKE) &&
+                 nSubExprCount != 2 && nSubExprCount != 3))
+            {
+                return false;
+            }
+            poColumn = poNode->papoSubExpr[0];
+            for (int i = 1; i < nSubExprCount; ++i)
+                apoConstants.push_back(poNode->papoSubExpr[i]);
+            break;
+        }
+
+        default:
+            return false;
+    }
+
+    // NULL constants, or types mixed in an unchecked expression, follow
+    // specific code paths in SWQGeneralEvaluator(): leave them to it.
+    bool bAllInteger = true;
+    bool bAllFloat = true;
+    bool bAllString = true;
+    for (const auto *poConstant : apoConstants)
+    {
+        if (poConstant->eNodeType != SNT_CONSTANT || poConstant->is_null)
+            return false;
+        bAllInteger &= IsIntegerLikeType(poConstant->field_type);
+        bAllFloat &= poConstant->field_type == SWQ_FLOAT;
+        bAllString &= poConstant->field_type == SWQ_STRING &&
+                      poConstant->string_value != nullptr;
+    }
+    if (poColumn->eNodeType != SNT_COLUMN)
+        return false;
+    const swq_field_type eColumnType = poColumn->field_type;
+
+    if (poNode->nOperation == SWQ_LIKE || poNode->nOperation == SWQ_ILIKE)
+    {
+        if (eColumnType != SWQ_STRING || !bAllString)
+            return false;
+        oLeaf.eType = LeafType::LIKE;
+        oLeaf.iColumn = GetColumn(poColumn, SWQ_STRING);
+        if (oLeaf.iColumn < 0)
+            return false;
+        oLeaf.aosValues[0] = apoConstants[0]->string_value;
+        if (apoConstants.size() == 2)
+            oLeaf.chEscape = apoConstants[1]->string_value[0];
+        oLeaf.bInsensitive = poNode->nOperation == SWQ_ILIKE;
+
+        // Recognize patterns that can be evaluated with a single string
+        // comparison, with the same result as swq_test_like().
+        const std::string &osPattern = oLeaf.aosValues[0];
+        const size_t nLen = osPattern.size();
+        const size_t nPercentCount =
+            std::count(osPattern.begin(), osPattern.end(), '%');
+        if (osPattern.find('_') != std::string::npos ||
+            (oLeaf.chEscape != '\0' &&
+             osPattern.find(oLeaf.chEscape) != std::string::npos))
+        {
+            oLeaf.eLikeType = LikeType::GENERIC;
+        }
+        else if (nPercentCount == 0)
+        {
+            oLeaf.eLikeType = LikeType::EXACT;
+            oLeaf.osLikeLiteral = osPattern;
+        }
+        else if (nPercentCount == 1 && osPattern.back() == '%')
+        {
+            oLeaf.eLikeType = LikeType::PREFIX;
+            oLeaf.osLikeLiteral = osPattern.substr(0, nLen - 1);
+        }
+        else if (nPercentCount == 1 && osPattern.front() == '%')
+        {
+            oLeaf.eLikeType = LikeType::SUFFIX;
+            oLeaf.osLikeLiteral = osPattern.substr(1);
+        }
+        else if (nPercentCount == 2 && nLen >= 2 && osPattern.front() == '%' &&
+                 osPattern.back() == '%')
+        {
+            oLeaf.eLikeType = LikeType::CONTAINS;
+            oLeaf.osLikeLiteral = osPattern.substr(1, nLen - 2);
+        }
+        else
+        {
+            oLeaf.eLikeType = LikeType::GENERIC;
+        }
+        m_aoLeaves.push_back(std::move(oLeaf));
+        return true;
+    }
+
+    // Determine which branch of SWQGeneralEvaluator() would be used
+    const bool bBinaryComparison =
+        poNode->nOperation != SWQ_IN && poNode->nOperation != SWQ_BETWEEN;
+    const bool bIN = poNode->nOperation == SWQ_IN;
+    if (IsIntegerLikeType(eColumnType) && bAllInteger)
+    {
+        oLeaf.eType = bIN ? LeafType::IN_INT : LeafType::CMP_INT;
+        oLeaf.iColumn = GetColumn(poColumn, SWQ_INTEGER64);
+    }
+    else if ((IsIntegerLikeType(eColumnType) && bAllFloat) ||
+             (eColumnType == SWQ_FLOAT &&
+              (bAllFloat || (bAllInteger && bBinaryComparison))))
+    {
+        oLeaf.eType = bIN ? LeafType::IN_FLOAT : LeafType::CMP_FLOAT;
+        oLeaf.iColumn = GetColumn(
+            poColumn, eColumnType == SWQ_FLOAT ? SWQ_FLOAT : SWQ_INTEGER64);
+    }
+    else if (eColumnType == SWQ_STRING && bAllString)
+    {
+        oLeaf.eType = bIN ? LeafType::IN_STRING : LeafType::CMP_STRING;
+        oLeaf.iColumn = GetColumn(poColumn, SWQ_STRING);
+    }
+    else
+    {
+        return false;
+    }
+    if (oLeaf.iColumn < 0)
+        return false;
+
+    for (size_t i = 0; i < apoConstants.size(); ++i)
+    {
+        const auto *poConstant = apoConstants[i];
+        switch (oLeaf.eType)
+        {
+            case LeafType::CMP_INT:
+                oLeaf.anValues[i] = poConstant->int_value;
+                break;
+            case LeafType::CMP_FLOAT:
+                oLeaf.adfValues[i] =
+                    poConstant->field_type == SWQ_FLOAT
+                        ? poConstant->float_value
+                        : static_cast<double>(poConstant->int_value);
+                break;
+            case LeafType::CMP_STRING:
+                oLeaf.aosValues[i] = poConstant->string_value;
+                break;
+            case LeafType::IN_INT:
+                oLeaf.oSetIntValues.insert(poConstant->int_value);
+                break;
+            case LeafType::IN_FLOAT:
+                // NaN never compares equal
+                if (!std::isnan(poConstant->float_value))
+                    oLeaf.adfSortedValues.push_back(poConstant->float_value);
+                break;
+            case LeafType::IN_STRING:
+            {
+                std::string osLower;
+                ToLowerASCII(poConstant->string_value,
+                             strlen(poConstant->string_value), osLower);
+                oLeaf.oSetStringValues.insert(std::move(osLower));
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    std::sort(oLeaf.adfSortedValues.begin(), oLeaf.adfSortedValues.end());
+
+    m_aoLeaves.push_back(std::move(oLeaf));
+    return true;
+}
+
+/************************************************************************/
+/*                            EvaluateCompare()                         */
+/************************************************************************/
+
+template <class T, class U, class Cmp>
+static void EvaluateCompare(size_t nRows, const T *values,
+                            const GByte *pabyIsNull, GByte *pabyOut, Cmp cmp)
+{
+    for (size_t i = 0; i < nRows; ++i)
+    {
+        pabyOut[i] = static_cast<GByte>(
+            (pabyIsNull[i] == 0) & cmp(static_cast<U>(values[i])));
+    }
+}
+
+template <class T, class U>
+static void EvaluateCompare(swq_op eOp, size_t nRows, const T *values,
+                            const GByte *pabyIsNull, U val1, U val2,
+                            GByte *pabyOut)
+{
+    switch (eOp)
+    {
+        case SWQ_EQ:
+            EvaluateCompare<T, U>(nRows, values, pabyIsNull, pabyOut,
+                                  [val1](U v) { return v == val1; });
+            break;
+        case SWQ_NE:
+            EvaluateCompare<T, U>(nRows, values, pabyIsNull, pabyOut,
+                                  [val1](U v) { return v != val1; });
+            break;
+        case SWQ_GT:
+            EvaluateCompare<T, U>(nRows, values, pabyIsNull, pabyOut,
+                                  [val1](U v) { return v > val1; });
+            break;
+        case SWQ_LT:
+            EvaluateCompare<T, U>(nRows, values, pabyIsNull, pabyOut,
+                                  [val1](U v) { return v < val1; });
+            break;
+        case SWQ_GE:
+            EvaluateCompare<T, U>(nRows, values, pabyIsNull, pabyOut,
+                                  [val1](U v) { return v >= val1; });
+            break;
+        case SWQ_LE:
+            EvaluateCompare<T, U>(nRows, values, pabyIsNull, pabyOut,
+                                  [val1](U v) { return v <= val1; });
+            break;
+        case SWQ_BETWEEN:
+            EvaluateCompare<T, U>(nRows, values, pabyIsNull, pabyOut,
+                                  [val1, val2](U v)
+                                  { return v >= val1 && v <= val2; });
+            break;
+        default:
+            CPLAssert(false);
+            memset(pabyOut, 0, nRows);
+            break;
+    }
+}
+
+/************************************************************************/
+/*                          CompareNoCase()                             */
+/************************************************************************/
+
+// Equivalent of strcasecmp() for strings given with their lengths.
+static int CompareNoCase(const char *pszA, size_t nLenA, const char *pszB,
+                         size_t nLenB)
+{
+    const size_t nLen = std::min(nLenA, nLenB);
+    for (size_t i = 0; i < nLen; ++i)
+    {
+        const int chA = ToLowerASCII(pszA[i]);
+        const int chB = ToLowerASCII(pszB[i]);
+        if (chA != chB)
+            return chA < chB ? -1 : 1;
+    }
+    return nLenA < nLenB ? -1 : nLenA > nLenB ? 1 : 0;
+}
+
+/************************************************************************/
+/*                          EqualStrings()                              */
+/************************************************************************/
+
+// Same as the SWQ_EQ case of string operations in SWQGeneralEvaluator(),
+// including its handling of the +00 timezone suffix.
+static bool EqualStrings(const char *pszA, size_t nLenA, const char *pszB,
+                         size_t nLenB)
+{
+    if (nLenA > 3 && nLenB > 3)
+    {
+        if (memcmp(pszA + nLenA - 3, "+00", 3) == 0 && pszB[nLenB - 3] == ':')
+        {
+            return nLenA >= nLenB &&
+                   CompareNoCase(pszA, nLenB, pszB, nLenB) == 0;
+        }
+        if (pszA[nLenA - 3] == ':' && memcmp(pszB + nLenB - 3, "+00", 3) == 0)
+        {
+            return nLenB >= nLenA &&
+                   CompareNoCase(pszA, nLenA, pszB, nLenA) == 0;
+        }
+    }
+    return CompareNoCase(pszA, nLenA, pszB, nLenB) == 0;
+}
+
+/************************************************************************/
+/*                            EqualBytes()                              */
+/************************************************************************/
+
+static bool EqualBytes(const char *pszA, const char *pszB, size_t nLen,
+                       bool bInsensitive)
+{
+    if (!bInsensitive)
+        return memcmp(pszA, pszB, nLen) == 0;
+    for (size_t i = 0; i < nLen; ++i)
+    {
+        if (ToLowerASCII(pszA[i]) != ToLowerASCII(pszB[i]))
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                            EvaluateLeaf()                            */
+/************************************************************************/
+
+void swq_program::EvaluateLeaf(const Leaf &oLeaf, size_t nRows,
+                               const ColumnValues &oValues,
+                               const swq_evaluation_context &sContext,
+                               Scratch &oScratch, GByte *pabyOut) const
+{
+    const GByte *pabyIsNull = oValues.abyIsNull.data();
+    const auto &oColumn = m_aoColumns[oLeaf.iColumn];
+
+    switch (oLeaf.eType)
+    {
+        case LeafType::ISNULL:
+        {
+            memcpy(pabyOut, pabyIsNull, nRows);
+            break;
+        }
+
+        case LeafType::CMP_INT:
+        {
+            EvaluateCompare<GIntBig, GIntBig>(
+                oLeaf.eOp, nRows, oValues.anValues.data(), pabyIsNull,
+                oLeaf.anValues[0], oLeaf.anValues[1], pabyOut);
+            break;
+        }
+
+        case LeafType::CMP_FLOAT:
+        {
+            if (oColumn.value_type == SWQ_FLOAT)
+                EvaluateCompare<double, double>(
+                    oLeaf.eOp, nRows, oValues.adfValues.data(), pabyIsNull,
+                    oLeaf.adfValues[0], oLeaf.adfValues[1], pabyOut);
+            else
+                EvaluateCompare<GIntBig, double>(
+                    oLeaf.eOp, nRows, oValues.anValues.data(), pabyIsNull,
+                    oLeaf.adfValues[0], oLeaf.adfValues[1], pabyOut);
+            break;
+        }
+
+        case LeafType::CMP_STRING:
+        {
+            const char *pszVal1 = oLeaf.aosValues[0].c_str();
+            const size_t nLen1 = oLeaf.aosValues[0].size();
+            for (size_t i = 0; i < nRows; ++i)
+            {
+                if (pabyIsNull[i])
+                {
+                    pabyOut[i] = 0;
+                    continue;
+                }
+                const char *pszStr = oValues.apszValues[i];
+                const size_t nLen = oValues.anLengths[i];
+                bool bRet;
+                switch (oLeaf.eOp)
+                {
+                    case SWQ_EQ:
+                        bRet = oLeaf.bConstantFirst
+                                   ? EqualStrings(pszVal1, nLen1, pszStr, nLen)
+                                   : EqualStrings(pszStr, nLen, pszVal1, nLen1);
+                        break;
+                    case SWQ_NE:
+                        bRet = CompareNoCase(pszStr, nLen, pszVal1, nLen1) != 0;
+                        break;
+                    case SWQ_GT:
+                        bRet = CompareNoCase(pszStr, nLen, pszVal1, nLen1) > 0;
+                        break;
+                    case SWQ_LT:
+                        bRet = CompareNoCase(pszStr, nLen, pszVal1, nLen1) < 0;
+                        break;
+                    case SWQ_GE:
+                        bRet = CompareNoCase(pszStr, nLen, pszVal1, nLen1) >= 0;
+                        break;
+                    case SWQ_LE:
+                        bRet = CompareNoCase(pszStr, nLen, pszVal1, nLen1) <= 0;
+                        break;
+                    case SWQ_BETWEEN:
+                        bRet =
+                            CompareNoCase(pszStr, nLen, pszVal1, nLen1) >= 0 &&
+                            CompareNoCase(pszStr, nLen,
+                                          oLeaf.aosValues[1].c_str(),
+                                          oLeaf.aosValues[1].size()) <= 0;
+                        break;
+                    default:
+                        CPLAssert(false);
+                        bRet = false;
+                        break;
+                }
+                pabyOut[i] = static_cast<GByte>(bRet);
+            }
+            break;
+        }
+
+        case LeafType::IN_INT:
+        {
+            const GIntBig *panValues = oValues.anValues.data();
+            for (size_t i = 0; i < nRows; ++i)
+            {
+                pabyOut[i] = static_cast<GByte>(
+                    !pabyIsNull[i] && oLeaf.oSetIntValues.find(panValues[i]) !=
+                                          oLeaf.oSetIntValues.end());
+            }
+            break;
+        }
+
+        case LeafType::IN_FLOAT:
+        {
+            const auto &adfSorted = oLeaf.adfSortedValues;
+            for (size_t i = 0; i < nRows; ++i)
+            {
+                const double dfVal =
+                    oColumn.value_type == SWQ_FLOAT
+                        ? oValues.adfValues[i]
+                        : static_cast<double>(oValues.anValues[i]);
+                pabyOut[i] = static_cast<GByte>(
+                    !pabyIsNull[i] && std::binary_search(adfSorted.begin(),
+                                                         adfSorted.end(),
+                                                         dfVal));
+            }
+            break;
+        }
+
+        case LeafType::IN_STRING:
+        {
+            std::string &osLower = oScratch.osTmp;
+            for (size_t i = 0; i < nRows; ++i)
+            {
+                if (pabyIsNull[i])
+                {
+                    pabyOut[i] = 0;
+                    continue;
+                }
+                ToLowerASCII(oValues.apszValues[i], oValues.anLengths[i],
+                             osLower);
+                pabyOut[i] = static_cast<GByte>(
+                    oLeaf.oSetStringValues.find(osLower) !=
+                    oLeaf.oSetStringValues.end());
+            }
+            break;
+        }
+
+        case LeafType::LIKE:
+        {
+            const bool bInsensitive =
+                oLeaf.bInsensitive ||
+                CPLTestBool(
+                    CPLGetConfigOption("OGR_SQL_LIKE_AS_ILIKE", "FALSE"));
+            // Case insensitive comparison of UTF-8 strings needs the full
+            // Unicode aware matcher.
+            const LikeType eLikeType =
+                bInsensitive && sContext.bUTF8Strings ? LikeType::GENERIC
+                                                      : oLeaf.eLikeType;
+            const char *pszLiteral = oLeaf.osLikeLiteral.c_str();
+            const size_t nLiteralLen = oLeaf.osLikeLiteral.size();
+            for (size_t i = 0; i < nRows; ++i)
+            {
+                if (pabyIsNull[i])
+                {
+                    pabyOut[i] = 0;
+                    continue;
+                }
+                const char *pszStr = oValues.apszValues[i];
+                const size_t nLen = oValues.anLengths[i];
+                bool bRet = false;
+                switch (eLikeType)
+                {
+                    case LikeType::EXACT:
+                        bRet = nLen == nLiteralLen &&
+                               EqualBytes(pszStr, pszLiteral, nLen,
+                                          bInsensitive);
+                        break;
+                    case LikeType::PREFIX:
+                        bRet = nLen >= nLiteralLen &&
+                               EqualBytes(pszStr, pszLiteral, nLiteralLen,
+                                          bInsensitive);
+                        break;
+                    case LikeType::SUFFIX:
+                        bRet = nLen >= nLiteralLen &&
+                               EqualBytes(pszStr + nLen - nLiteralLen,
+                                          pszLiteral, nLiteralLen,
+                                          bInsensitive);
+                        break;
+                    case LikeType::CONTAINS:
+                    {
+                        // swq_test_like() never matches an empty string
+                        // against %...%
+                        if (nLen == 0 || nLen < nLiteralLen)
+                            break;
+                        for (size_t j = 0; j + nLiteralLen <= nLen; ++j)
+                        {
+                            if (EqualBytes(pszStr + j, pszLiteral, nLiteralLen,
+                                           bInsensitive))
+                            {
+                                bRet = true;
+                                break;
+                            }
+                        }
+                        break;
+                    }
+                    case LikeType::GENERIC:
+                    {
+                        if (!oValues.bNulTerminated)
+                        {
+                            oScratch.osTmp.assign(pszStr, nLen);
+                            pszStr = oScratch.osTmp.c_str();
+                        }
+                        bRet = swq_test_like(pszStr, oLeaf.aosValues[0].c_str(),
+                                             oLeaf.chEscape, bInsensitive,
+                                             sContext.bUTF8Strings) != 0;
+                        break;
+                    }
+                }
+                pabyOut[i] = static_cast<GByte>(bRet);
+            }
+            break;
+        }
+    }
+}
+
+/************************************************************************/
+/*                              Evaluate()                              */
+/************************************************************************/
+
+/* Evaluates the program over nRows records, whose values for each column
+ * of GetColumns() are in aoValues. pabyResult[i] is set to 1 for records
+ * that match the expression, and 0 otherwise.
+ */
+void swq_program::Evaluate(size_t nRows,
+                           const std::vector<ColumnValues> &aoValues,
+                           const swq_evaluation_context &sContext,
+                           Scratch &oScratch, GByte *pabyResult) const
+{
+    CPLAssert(aoValues.size() == m_aoColumns.size());
+
+    auto &aabyStack = oScratch.aabyStack;
+    if (aabyStack.size() < static_cast<size_t>(m_nMaxStackDepth))
+        aabyStack.resize(m_nMaxStackDepth);
+    for (int i = 0; i < m_nMaxStackDepth; ++i)
+        aabyStack[i].resize(nRows);
+
+    int nTop = 0;
+    for (const auto &oInstr : m_aoInstrs)
+    {
+        switch (oInstr.eOpcode)
+        {
+            case Opcode::LEAF:
+            {
+                const auto &oLeaf = m_aoLeaves[oInstr.iLeaf];
+                EvaluateLeaf(oLeaf, nRows, aoValues[oLeaf.iColumn], sContext,
+                             oScratch, aabyStack[nTop].data());
+                ++nTop;
+                break;
+            }
+
+            case Opcode::AND:
+            {
+                GByte *pabyA = aabyStack[nTop - 2].data();
+                const GByte *pabyB = aabyStack[nTop - 1].data();
+                for (size_t i = 0; i < nRows; ++i)
+                    pabyA[i] &= pabyB[i];
+                --nTop;
+                break;
+            }
+
+            case Opcode::OR:
+            {
+                GByte *pabyA = aabyStack[nTop - 2].data();
+                const GByte *pabyB = aabyStack[nTop - 1].data();
+                for (size_t i = 0; i < nRows; ++i)
+                    pabyA[i] |= pabyB[i];
+                --nTop;
+                break;
+            }
+
+            case Opcode::NOT:
+            {
+                GByte *pabyA = aabyStack[nTop - 1].data();
+                for (size_t i = 0; i < nRows; ++i)
+                    pabyA[i] ^= 1;
+                break;
+            }
+        }
+    }
+
+    CPLAssert(nTop == 1);
+    if (nRows)
+        memcpy(pabyResult, aabyStack[0].data(), nRows);
+}
@@ -286,6 +286,24 @@ char *swq_select::Unparse()
         CPLFree(pszTmp);
     }
 
+    if (!group_defs.empty())
+    {
+        osSelect += " GROUP BY ";
+        for (size_t i = 0; i < group_defs.size(); i++)
+        {
+            if (i > 0)
+                osSelect += ", ";
+            if (!group_defs[i].osTableName.empty() && table_count > 1)
+            {
+                osSelect += swq_expr_node::QuoteIfNecessary(
+                    group_defs[i].osTableName, '"');
+                osSelect += ".";
+            }
+            osSelect += swq_expr_node::QuoteIfNecessary(
+                group_defs[i].osFieldName, '"');
+        }
+    }
+
     if (order_specs > 0)
     {
         osSelect += " ORDER BY ";
@@ -693,6 +711,19 @@ void swq_select::PushOrderBy(const char *pszTableName, const char *pszFieldName,
     order_defs[order_specs - 1].ascending_flag = bAscending;
 }
 
+/************************************************************************/
+/*                            PushGroupBy()                             */
+/************************************************************************/
+
+void swq_select::PushGroupBy(const char *pszTableName, const char *pszFieldName)
+
+{
+    swq_group_def oDef;
+    oDef.osTableName = pszTableName ? pszTableName : "";
+    oDef.osFieldName = pszFieldName;
+    group_defs.push_back(std::move(oDef));
+}
+
 /************************************************************************/
 /*                              PushJoin()                              */
 /************************************************************************/
@@ -1025,7 +1056,13 @@ CPLErr swq_select::parse(swq_field_list *field_list,
         return CE_Failure;
     }
 
-    for (int i = 0; i < result_columns(); i++)
+    if (!group_defs.empty())
+    {
+        if (ParseGroupBy(field_list) != CE_None)
+            return CE_Failure;
+    }
+
+    for (int i = 0; group_defs.empty() && i < result_columns(); i++)
     {
         swq_col_def *def = &column_defs[i];
         int this_indicator = -1;
@@ -1136,6 +1173,20 @@ CPLErr swq_select::parse(swq_field_list *field_list,
                      def->field_name);
             return CE_Failure;
         }
+
+        if (query_mode == SWQM_GROUP_BY &&
+            std::find_if(group_defs.begin(), group_defs.end(),
+                         [def](const swq_group_def &oGroupDef)
+                         {
+                             return oGroupDef.field_index == def->field_index;
+                         }) == group_defs.end())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Field '%s' used in ORDER BY must appear in the GROUP BY "
+                     "clause",
+                     def->field_name);
+            return CE_Failure;
+        }
     }
 
     /* -------------------------------------------------------------------- */
@@ -1156,6 +1207,95 @@ CPLErr swq_select::parse(swq_field_list *field_list,
     return CE_None;
 }
 
+/************************************************************************/
+/*                            ParseGroupBy()                            */
+/*                                                                      */
+/*      Resolves the GROUP BY keys and checks that each result column   */
+/*      is either a grouping key or an aggregate.                       */
+/************************************************************************/
+
+CPLErr swq_select::ParseGroupBy(swq_field_list *field_list)
+{
+    if (query_mode == SWQM_DISTINCT_LIST)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "SELECT DISTINCT not supported with GROUP BY.");
+        return CE_Failure;
+    }
+
+    if (join_count > 0)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "GROUP BY not supported with JOIN.");
+        return CE_Failure;
+    }
+
+    for (auto &oGroupDef : group_defs)
+    {
+        oGroupDef.field_index = swq_identify_field(
+            oGroupDef.osTableName.c_str(), oGroupDef.osFieldName.c_str(),
+            field_list, &oGroupDef.field_type, &oGroupDef.table_index);
+        if (oGroupDef.field_index == -1)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Unrecognized field name %s in GROUP BY.",
+                     oGroupDef.osTableName.empty()
+                         ? oGroupDef.osFieldName.c_str()
+                         : CPLSPrintf("%s.%s", oGroupDef.osTableName.c_str(),
+                                      oGroupDef.osFieldName.c_str()));
+            return CE_Failure;
+        }
+
+        if (oGroupDef.field_type == SWQ_GEOMETRY)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Cannot use geometry field '%s' in a GROUP BY clause",
+                     oGroupDef.osFieldName.c_str());
+            return CE_Failure;
+        }
+    }
+
+    for (int i = 0; i < result_columns(); i++)
+    {
+        const swq_col_def *def = &column_defs[i];
+        if (def->col_func == SWQCF_MIN || def->col_func == SWQCF_MAX ||
+            def->col_func == SWQCF_AVG || def->col_func == SWQCF_SUM ||
+            def->col_func == SWQCF_COUNT)
+        {
+            if (def->distinct_flag)
+            {
+                CPLError(CE_Failure, CPLE_NotSupported,
+                         "COUNT(DISTINCT) not supported with GROUP BY.");
+                return CE_Failure;
+            }
+        }
+        else if (def->col_func != SWQCF_NONE ||
+                 (def->expr != nullptr && def->expr->eNodeType != SNT_COLUMN) ||
+                 std::find_if(group_defs.begin(), group_defs.end(),
+                              [def](const swq_group_def &oGroupDef)
+                              {
+                                  return oGroupDef.table_index ==
+                                             def->table_index &&
+                                         oGroupDef.field_index ==
+                                             def->field_index;
+                              }) == group_defs.end())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Column %s must appear in the GROUP BY clause or be "
+                     "used in an aggregate function.",
+                     def->field_name);
+            return CE_Failure;
+        }
+    }
+
+    query_mode = SWQM_GROUP_BY;
+    return CE_None;
+}
+
+/************************************************************************/
+/*                          IsFieldExcluded()                           */
+/************************************************************************/
+
 bool swq_select::IsFieldExcluded(int src_index, const char *pszTableName,
                                  const char *pszFieldName)
 {
@@ -0,0 +1,721 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Utilities
+ * Purpose:  bench_ogr_matrix: read/write throughput of vector drivers
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+// For each combination of format, storage, geometry type and schema, a
+// synthetic dataset is written feature by feature with CreateFeature() and
+// batch by batch with WriteArrowBatch(), and read back with GetNextFeature()
+// and GetArrowStream(). The elapsed time, throughput and peak memory of each
+// operation are reported as a table, or as JSON with -json, so that runs on
+// different builds or releases can be compared.
+
+#include "cpl_conv.h"
+#include "cpl_json.h"
+#include "cpl_string.h"
+#include "cpl_vsi.h"
+#include "gdal_priv.h"
+#include "ogr_api.h"
+#include "ogr_recordbatch.h"
+#include "ogrsf_frmts.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct Format
+{
+    const char *pszDriver;
+    const char *pszExtension;
+    const char *const *papszLCO;
+};
+
+const char *const apszCSVLCO[] = {"GEOMETRY=AS_WKT", nullptr};
+const char *const apszArrowLCO[] = {"FORMAT=FILE", nullptr};
+
+const Format asFormats[] = {
+    {"GPKG", "gpkg", nullptr},
+    {"ESRI Shapefile", "shp", nullptr},
+    {"FlatGeobuf", "fgb", nullptr},
+    {"Parquet", "parquet", nullptr},
+    {"Arrow", "arrow", apszArrowLCO},
+    {"CSV", "csv", apszCSVLCO},
+    {"GeoJSON", "geojson", nullptr},
+};
+
+struct Config
+{
+    GIntBig nFeatures = 100000;
+    std::vector<const Format *> apoFormats{};
+    std::vector<std::string> aosStorages{};
+    std::vector<OGRwkbGeometryType> aeGeomTypes{};
+    std::vector<bool> abWide{};
+    std::string osTmpDir{};
+};
+
+struct Result
+{
+    std::string osFormat{};
+    std::string osStorage{};
+    std::string osGeomType{};
+    std::string osSchema{};
+    std::string osOperation{};
+    bool bSuccess = false;
+    double dfSeconds = 0;
+    GIntBig nFeatures = 0;
+    GIntBig nFileSize = 0;
+    // Increase of the resident memory during the operation, or -1 if unknown
+    GIntBig nPeakMemory = -1;
+};
+
+/************************************************************************/
+/*                          Peak memory tracking                        */
+/************************************************************************/
+
+// Returns the value, in bytes, of a "Name: <value> kB" line of
+// /proc/self/status, or -1 if not available.
+GIntBig GetProcStatusValue(const char *pszName)
+{
+#ifdef __linux__
+    VSILFILE *fp = VSIFOpenL("/proc/self/status", "rb");
+    if (!fp)
+        return -1;
+    GIntBig nValue = -1;
+    const size_t nNameLen = strlen(pszName);
+    while (const char *pszLine = CPLReadLineL(fp))
+    {
+        if (strncmp(pszLine, pszName, nNameLen) == 0 &&
+            pszLine[nNameLen] == ':')
+        {
+            nValue = CPLAtoGIntBig(pszLine + nNameLen + 1) * 1024;
+            break;
+        }
+    }
+    VSIFCloseL(fp);
+    return nValue;
+#else
+    (void)pszName;
+    return -1;
+#endif
+}
+
+class MemoryTracker
+{
+    GIntBig m_nRSSBefore = -1;
+
+  public:
+    MemoryTracker()
+    {
+#ifdef __linux__
+        // Resets the peak resident set size (VmHWM) to the current one.
+        // Requires Linux >= 4.0
+        VSILFILE *fp = VSIFOpenL("/proc/self/clear_refs", "wb");
+        if (fp)
+        {
+            if (VSIFWriteL("5", 1, 1, fp) == 1)
+                m_nRSSBefore = GetProcStatusValue("VmRSS");
+            VSIFCloseL(fp);
+        }
+#endif
+    }
+
+    GIntBig GetPeakIncrease() const
+    {
+        if (m_nRSSBefore < 0)
+            return -1;
+        const GIntBig nHWM = GetProcStatusValue("VmHWM");
+        if (nHWM < 0)
+            return -1;
+        return std::max<GIntBig>(0, nHWM - m_nRSSBefore);
+    }
+};
+
+/************************************************************************/
+/*                        Synthetic features                            */
+/************************************************************************/
+
+constexpr int WIDE_FIELD_COUNT = 48;
+
+void CreateFields(OGRLayer *poLayer, bool bWide)
+{
+    OGRFieldDefn oId("id", OFTInteger64);
+    CPL_IGNORE_RET_VAL(poLayer->CreateField(&oId));
+    if (!bWide)
+    {
+        OGRFieldDefn oName("name", OFTString);
+        CPL_IGNORE_RET_VAL(poLayer->CreateField(&oName));
+        return;
+    }
+    const OGRFieldType aeTypes[] = {OFTInteger, OFTReal, OFTString, OFTDate};
+    for (int i = 0; i < WIDE_FIELD_COUNT; ++i)
+    {
+        OGRFieldDefn oField(CPLSPrintf("f%02d", i), aeTypes[i % 4]);
+        CPL_IGNORE_RET_VAL(poLayer->CreateField(&oField));
+    }
+}
+
+void FillFeature(OGRFeature *poFeature, GIntBig i, OGRwkbGeometryType eGType,
+                 bool bWide)
+{
+    poFeature->SetField(0, i);
+    if (!bWide)
+    {
+        poFeature->SetField(1, CPLSPrintf("feature " CPL_FRMT_GIB, i));
+    }
+    else
+    {
+        for (int j = 0; j < WIDE_FIELD_COUNT; ++j)
+        {
+            switch (j % 4)
+            {
+                case 0:
+                    poFeature->SetField(1 + j, static_cast<int>(i % 10000));
+                    break;
+                case 1:
+                    poFeature->SetField(1 + j, static_cast<double>(i) / 7);
+                    break;
+                case 2:
+                    poFeature->SetField(
+                        1 + j, CPLSPrintf("value %d " CPL_FRMT_GIB, j, i));
+                    break;
+                default:
+                    poFeature->SetField(1 + j, 2000 + static_cast<int>(i % 20),
+                                        1 + static_cast<int>(i % 12),
+                                        1 + static_cast<int>(i % 28));
+                    break;
+            }
+        }
+    }
+
+    const double dfX = -170 + std::fmod(static_cast<double>(i) * 0.0137, 340);
+    const double dfY = -80 + std::fmod(static_cast<double>(i) * 0.0071, 160);
+    if (eGType == wkbPoint)
+    {
+        poFeature->SetGeometryDirectly(new OGRPoint(dfX, dfY));
+    }
+    else if (eGType == wkbLineString)
+    {
+        auto poLS = new OGRLineString();
+        for (int j = 0; j < 10; ++j)
+            poLS->addPoint(dfX + j * 0.01, dfY + (j % 2) * 0.01);
+        poFeature->SetGeometryDirectly(poLS);
+    }
+    else
+    {
+        constexpr int NPOINTS = 20;
+        auto poRing = new OGRLinearRing();
+        for (int j = 0; j < NPOINTS; ++j)
+        {
+            const double dfAngle = -2 * M_PI * j / NPOINTS;
+            poRing->addPoint(dfX + 0.1 * cos(dfAngle),
+                             dfY + 0.1 * sin(dfAngle));
+        }
+        poRing->closeRings();
+        auto poPoly = new OGRPolygon();
+        poPoly->addRingDirectly(poRing);
+        poFeature->SetGeometryDirectly(poPoly);
+    }
+}
+
+/************************************************************************/
+/*                           Operations                                 */
+/************************************************************************/
+
+GIntBig GetDatasetSize(const std::string &osFilename)
+{
+    auto poDS = std::unique_ptr<GDALDataset>(
+        GDALDataset::Open(osFilename.c_str(), GDAL_OF_VECTOR));
+    if (!poDS)
+        return 0;
+    GIntBig nSize = 0;
+    const CPLStringList aosFiles(poDS->GetFileList());
+    for (const char *pszFile : aosFiles)
+    {
+        VSIStatBufL sStat;
+        if (VSIStatL(pszFile, &sStat) == 0)
+            nSize += static_cast<GIntBig>(sStat.st_size);
+    }
+    return nSize;
+}
+
+OGRLayer *CreateLayer(GDALDriver *poDriver, const Format *psFormat,
+                      const std::string &osFilename,
+                      OGRwkbGeometryType eGType, bool bWide,
+                      std::unique_ptr<GDALDataset> &poDS)
+{
+    poDS.reset(
+        poDriver->Create(osFilename.c_str(), 0, 0, 0, GDT_Unknown, nullptr));
+    if (!poDS)
+        return nullptr;
+    auto poLayer = poDS->CreateLayer("bench", nullptr, eGType,
+                                     const_cast<char **>(psFormat->papszLCO));
+    if (poLayer)
+        CreateFields(poLayer, bWide);
+    return poLayer;
+}
+
+bool WriteFeatures(GDALDriver *poDriver, const Format *psFormat,
+                   const std::string &osFilename, OGRwkbGeometryType eGType,
+                   bool bWide, GIntBig nFeatures)
+{
+    std::unique_ptr<GDALDataset> poDS;
+    auto poLayer =
+        CreateLayer(poDriver, psFormat, osFilename, eGType, bWide, poDS);
+    if (!poLayer)
+        return false;
+    CPL_IGNORE_RET_VAL(poLayer->StartTransaction());
+    OGRFeature oFeature(poLayer->GetLayerDefn());
+    for (GIntBig i = 0; i < nFeatures; ++i)
+    {
+        FillFeature(&oFeature, i, eGType, bWide);
+        oFeature.SetFID(OGRNullFID);
+        if (poLayer->CreateFeature(&oFeature) != OGRERR_NONE)
+            return false;
+    }
+    CPL_IGNORE_RET_VAL(poLayer->CommitTransaction());
+    return poDS->Close() == CE_None;
+}
+
+bool WriteArrow(GDALDriver *poDriver, const Format *psFormat,
+                const std::string &osFilename, OGRwkbGeometryType eGType,
+                bool bWide, OGRLayer *poSrcLayer)
+{
+    std::unique_ptr<GDALDataset> poDS;
+    auto poLayer =
+        CreateLayer(poDriver, psFormat, osFilename, eGType, bWide, poDS);
+    if (!poLayer)
+        return false;
+
+    CPLStringList aosOptions;
+    aosOptions.SetNameValue("GEOMETRY_ENCODING", "WKB");
+    aosOptions.SetNameValue("INCLUDE_FID", "NO");
+    poSrcLayer->ResetReading();
+    struct ArrowArrayStream stream;
+    if (!poSrcLayer->GetArrowStream(&stream, aosOptions.List()))
+        return false;
+    struct ArrowSchema schema;
+    if (stream.get_schema(&stream, &schema) != 0)
+    {
+        stream.release(&stream);
+        return false;
+    }
+    bool bRet = true;
+    while (bRet)
+    {
+        struct ArrowArray array;
+        if (stream.get_next(&stream, &array) != 0)
+        {
+            bRet = false;
+            break;
+        }
+        if (array.release == nullptr)
+            break;
+        bRet = poLayer->WriteArrowBatch(&schema, &array, nullptr);
+        if (array.release)
+            array.release(&array);
+    }
+    schema.release(&schema);
+    stream.release(&stream);
+    return poDS->Close() == CE_None && bRet;
+}
+
+GIntBig ReadFeatures(const std::string &osFilename)
+{
+    auto poDS = std::unique_ptr<GDALDataset>(
+        GDALDataset::Open(osFilename.c_str(), GDAL_OF_VECTOR));
+    if (!poDS || poDS->GetLayerCount() != 1)
+        return -1;
+    GIntBig nCount = 0;
+    for (auto &&poFeature : poDS->GetLayer(0))
+    {
+        CPL_IGNORE_RET_VAL(poFeature);
+        ++nCount;
+    }
+    return nCount;
+}
+
+GIntBig ReadArrow(const std::string &osFilename)
+{
+    auto poDS = std::unique_ptr<GDALDataset>(
+        GDALDataset::Open(osFilename.c_str(), GDAL_OF_VECTOR));
+    if (!poDS || poDS->GetLayerCount() != 1)
+        return -1;
+    struct ArrowArrayStream stream;
+    if (!poDS->GetLayer(0)->GetArrowStream(&stream, nullptr))
+        return -1;
+    GIntBig nCount = 0;
+    while (true)
+    {
+        struct ArrowArray array;
+        if (stream.get_next(&stream, &array) != 0)
+        {
+            nCount = -1;
+            break;
+        }
+        if (array.release == nullptr)
+            break;
+        nCount += array.length;
+        array.release(&array);
+    }
+    stream.release(&stream);
+    return nCount;
+}
+
+/************************************************************************/
+/*                           RunCombination()                           */
+/************************************************************************/
+
+template <class F>
+Result Measure(const Result &oTemplate, const char *pszOperation, F &&f)
+{
+    Result oResult(oTemplate);
+    oResult.osOperation = pszOperation;
+    MemoryTracker oTracker;
+    const auto tStart = std::chrono::steady_clock::now();
+    const GIntBig nFeatures = f();
+    oResult.dfSeconds = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - tStart)
+                            .count();
+    oResult.nPeakMemory = oTracker.GetPeakIncrease();
+    oResult.bSuccess = nFeatures >= 0;
+    oResult.nFeatures = nFeatures;
+    return oResult;
+}
+
+void RunCombination(const Config &sConfig, const Format *psFormat,
+                    const std::string &osStorage, OGRwkbGeometryType eGType,
+                    bool bWide, OGRLayer *poSrcLayer,
+                    std::vector<Result> &aoResults)
+{
+    auto poDriver =
+        GetGDALDriverManager()->GetDriverByName(psFormat->pszDriver);
+    if (!poDriver)
+        return;
+
+    const std::string osDir =
+        osStorage == "vsimem" ? std::string("/vsimem/bench_ogr_matrix")
+                              : sConfig.osTmpDir;
+    const std::string osFeatureFilename = CPLFormFilename(
+        osDir.c_str(), "bench_feature", psFormat->pszExtension);
+    const std::string osArrowFilename = CPLFormFilename(
+        osDir.c_str(), "bench_arrow", psFormat->pszExtension);
+
+    Result oTemplate;
+    oTemplate.osFormat = psFormat->pszDriver;
+    oTemplate.osStorage = osStorage;
+    oTemplate.osGeomType = OGRToOGCGeomType(eGType);
+    oTemplate.osSchema = bWide ? "wide" : "narrow";
+
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    poDriver->Delete(osFeatureFilename.c_str());
+    poDriver->Delete(osArrowFilename.c_str());
+    CPLPopErrorHandler();
+
+    auto oResult = Measure(
+        oTemplate, "CreateFeature",
+        [&]()
+        {
+            return WriteFeatures(poDriver, psFormat, osFeatureFilename, eGType,
+                                 bWide, sConfig.nFeatures)
+                       ? sConfig.nFeatures
+                       : -1;
+        });
+    const bool bWritten = oResult.bSuccess;
+    if (bWritten)
+        oResult.nFileSize = GetDatasetSize(osFeatureFilename);
+    aoResults.push_back(oResult);
+
+    oResult = Measure(
+        oTemplate, "WriteArrowBatch",
+        [&]()
+        {
+            return WriteArrow(poDriver, psFormat, osArrowFilename, eGType,
+                              bWide, poSrcLayer)
+                       ? sConfig.nFeatures
+                       : -1;
+        });
+    if (oResult.bSuccess)
+        oResult.nFileSize = GetDatasetSize(osArrowFilename);
+    aoResults.push_back(oResult);
+
+    if (bWritten)
+    {
+        oResult = Measure(oTemplate, "GetNextFeature",
+                          [&]() { return ReadFeatures(osFeatureFilename); });
+        oResult.nFileSize = aoResults[aoResults.size() - 2].nFileSize;
+        aoResults.push_back(oResult);
+
+        oResult = Measure(oTemplate, "GetArrowStream",
+                          [&]() { return ReadArrow(osFeatureFilename); });
+        oResult.nFileSize = aoResults[aoResults.size() - 3].nFileSize;
+        aoResults.push_back(oResult);
+    }
+
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    poDriver->Delete(osFeatureFilename.c_str());
+    poDriver->Delete(osArrowFilename.c_str());
+    CPLPopErrorHandler();
+    if (osStorage == "vsimem")
+        VSIRmdirRecursive(osDir.c_str());
+}
+
+/************************************************************************/
+/*                             Report()                                 */
+/************************************************************************/
+
+void PrintTable(const std::vector<Result> &aoResults)
+{
+    printf("%-15s %-7s %-10s %-7s %-16s %9s %12s %9s %9s %9s\n", "Format",
+           "Storage", "Geometry", "Schema", "Operation", "Time (s)",
+           "Features/s", "MB/s", "Size (MB)", "Peak (MB)");
+    for (const auto &oResult : aoResults)
+    {
+        printf("%-15s %-7s %-10s %-7s %-16s ", oResult.osFormat.c_str(),
+               oResult.osStorage.c_str(), oResult.osGeomType.c_str(),
+               oResult.osSchema.c_str(), oResult.osOperation.c_str());
+        if (!oResult.bSuccess)
+        {
+            printf("%9s\n", "failed");
+            continue;
+        }
+        const double dfSeconds = std::max(oResult.dfSeconds, 1e-9);
+        printf("%9.3f %12.0f %9.1f %9.1f ", oResult.dfSeconds,
+               static_cast<double>(oResult.nFeatures) / dfSeconds,
+               static_cast<double>(oResult.nFileSize) / 1e6 / dfSeconds,
+               static_cast<double>(oResult.nFileSize) / 1e6);
+        if (oResult.nPeakMemory >= 0)
+            printf("%9.1f\n", static_cast<double>(oResult.nPeakMemory) / 1e6);
+        else
+            printf("%9s\n", "n/a");
+    }
+}
+
+void PrintJSON(const Config &sConfig, const std::vector<Result> &aoResults)
+{
+    CPLJSONDocument oDoc;
+    CPLJSONObject oRoot = oDoc.GetRoot();
+    oRoot.Add("gdal_version", GDALVersionInfo("RELEASE_NAME"));
+    oRoot.Add("feature_count", static_cast<GInt64>(sConfig.nFeatures));
+    CPLJSONArray oArray;
+    for (const auto &oResult : aoResults)
+    {
+        CPLJSONObject oObj;
+        oObj.Add("format", oResult.osFormat);
+        oObj.Add("storage", oResult.osStorage);
+        oObj.Add("geometry_type", oResult.osGeomType);
+        oObj.Add("schema", oResult.osSchema);
+        oObj.Add("operation", oResult.osOperation);
+        oObj.Add("success", oResult.bSuccess);
+        if (oResult.bSuccess)
+        {
+            oObj.Add("seconds", oResult.dfSeconds);
+            oObj.Add("features", static_cast<GInt64>(oResult.nFeatures));
+            oObj.Add("file_size", static_cast<GInt64>(oResult.nFileSize));
+            if (oResult.nPeakMemory >= 0)
+                oObj.Add("peak_memory",
+                         static_cast<GInt64>(oResult.nPeakMemory));
+        }
+        oArray.Add(oObj);
+    }
+    oRoot.Add("results", oArray);
+    printf("%s\n", oDoc.SaveAsString().c_str());
+}
+
+/************************************************************************/
+/*                               Usage()                                */
+/************************************************************************/
+
+void Usage()
+{
+    printf("Usage: bench_ogr_matrix [-n <feature_count>] [-f <driver>]*\n");
+    printf("                        [-storage local|vsimem]*\n");
+    printf("                        [-geom point|line|polygon]*\n");
+    printf("                        [-schema narrow|wide]* [-tmpdir <dir>]\n");
+    printf("                        [-json]\n");
+    printf("\nDrivers: ");
+    for (const auto &sFormat : asFormats)
+        printf("%s\"%s\"", &sFormat == asFormats ? "" : ", ",
+               sFormat.pszDriver);
+    printf("\n");
+    exit(1);
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                               main()                                 */
+/************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    /* -------------------------------------------------------------------- */
+    /*      Process arguments.                                              */
+    /* -------------------------------------------------------------------- */
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        exit(-argc);
+
+    Config sConfig;
+    sConfig.osTmpDir = ".";
+    bool bJSON = false;
+    for (int iArg = 1; iArg < argc; ++iArg)
+    {
+        if (iArg + 1 < argc && strcmp(argv[iArg], "-n") == 0)
+        {
+            sConfig.nFeatures =
+                std::max<GIntBig>(1, CPLAtoGIntBig(argv[++iArg]));
+        }
+        else if (iArg + 1 < argc && strcmp(argv[iArg], "-f") == 0)
+        {
+            ++iArg;
+            const Format *psFound = nullptr;
+            for (const auto &sFormat : asFormats)
+            {
+                if (EQUAL(sFormat.pszDriver, argv[iArg]))
+                    psFound = &sFormat;
+            }
+            if (!psFound)
+                Usage();
+            sConfig.apoFormats.push_back(psFound);
+        }
+        else if (iArg + 1 < argc && strcmp(argv[iArg], "-storage") == 0)
+        {
+            ++iArg;
+            if (!EQUAL(argv[iArg], "local") && !EQUAL(argv[iArg], "vsimem"))
+                Usage();
+            sConfig.aosStorages.push_back(CPLString(argv[iArg]).tolower());
+        }
+        else if (iArg + 1 < argc && strcmp(argv[iArg], "-geom") == 0)
+        {
+            ++iArg;
+            if (EQUAL(argv[iArg], "point"))
+                sConfig.aeGeomTypes.push_back(wkbPoint);
+            else if (EQUAL(argv[iArg], "line"))
+                sConfig.aeGeomTypes.push_back(wkbLineString);
+            else if (EQUAL(argv[iArg], "polygon"))
+                sConfig.aeGeomTypes.push_back(wkbPolygon);
+            else
+                Usage();
+        }
+        else if (iArg + 1 < argc && strcmp(argv[iArg], "-schema") == 0)
+        {
+            ++iArg;
+            if (EQUAL(argv[iArg], "narrow"))
+                sConfig.abWide.push_back(false);
+            else if (EQUAL(argv[iArg], "wide"))
+                sConfig.abWide.push_back(true);
+            else
+                Usage();
+        }
+        else if (iArg + 1 < argc && strcmp(argv[iArg], "-tmpdir") == 0)
+        {
+            sConfig.osTmpDir = argv[++iArg];
+        }
+        else if (strcmp(argv[iArg], "-json") == 0)
+        {
+            bJSON = true;
+        }
+        else
+        {
+            Usage();
+        }
+    }
+    if (sConfig.apoFormats.empty())
+    {
+        for (const auto &sFormat : asFormats)
+            sConfig.apoFormats.push_back(&sFormat);
+    }
+    if (sConfig.aosStorages.empty())
+        sConfig.aosStorages = {"local", "vsimem"};
+    if (sConfig.aeGeomTypes.empty())
+        sConfig.aeGeomTypes = {wkbPoint, wkbLineString, wkbPolygon};
+    if (sConfig.abWide.empty())
+        sConfig.abWide = {false, true};
+
+    GDALAllRegister();
+
+    auto poMemDriver = GetGDALDriverManager()->GetDriverByName("Memory");
+    if (!poMemDriver)
+    {
+        fprintf(stderr, "Memory driver not available\n");
+        CSLDestroy(argv);
+        exit(1);
+    }
+
+    std::vector<Result> aoResults;
+    for (const auto eGType : sConfig.aeGeomTypes)
+    {
+        for (const bool bWide : sConfig.abWide)
+        {
+            // Source of the WriteArrowBatch() operations
+            auto poSrcDS = std::unique_ptr<GDALDataset>(poMemDriver->Create(
+                "", 0, 0, 0, GDT_Unknown, nullptr));
+            auto poSrcLayer =
+                poSrcDS->CreateLayer("bench", nullptr, eGType, nullptr);
+            CreateFields(poSrcLayer, bWide);
+            {
+                OGRFeature oFeature(poSrcLayer->GetLayerDefn());
+                for (GIntBig i = 0; i < sConfig.nFeatures; ++i)
+                {
+                    FillFeature(&oFeature, i, eGType, bWide);
+                    oFeature.SetFID(OGRNullFID);
+                    CPL_IGNORE_RET_VAL(poSrcLayer->CreateFeature(&oFeature));
+                }
+            }
+
+            for (const auto &osStorage : sConfig.aosStorages)
+            {
+                for (const Format *psFormat : sConfig.apoFormats)
+                {
+                    RunCombination(sConfig, psFormat, osStorage, eGType,
+                                   bWide, poSrcLayer, aoResults);
+                    if (!bJSON)
+                        fprintf(stderr, ".");
+                }
+            }
+        }
+    }
+    if (!bJSON)
+        fprintf(stderr, "\n");
+
+    if (bJSON)
+        PrintJSON(sConfig, aoResults);
+    else
+        PrintTable(aoResults);
+
+    CSLDestroy(argv);
+
+    GDALDestroyDriverManager();
+
+    return 0;
+}
@@ -0,0 +1,666 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Utilities
+ * Purpose:  Micro-benchmarks of raster primitives
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+// Benchmarks are run and reported the same way as with google-benchmark,
+// including its --benchmark_filter, --benchmark_min_time,
+// --benchmark_format and --benchmark_out options, and its JSON output format,
+// so that existing tooling for regression tracking can consume the results.
+
+#include "cpl_compressor.h"
+#include "cpl_conv.h"
+#include "cpl_json.h"
+#include "cpl_string.h"
+#include "gdal_alg.h"
+#include "gdal_priv.h"
+#include "gdal_vrt.h"
+#include "gdalwarper.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+/************************************************************************/
+/*                              Benchmark                               */
+/************************************************************************/
+
+struct Benchmark
+{
+    std::string osName{};
+    // Number of bytes processed by one iteration, or 0 if not relevant
+    size_t nBytesPerIteration = 0;
+    std::function<void()> fn{};
+};
+
+struct BenchmarkResult
+{
+    std::string osName{};
+    GIntBig nIterations = 0;
+    double dfRealTimeNS = 0;  // per iteration
+    double dfCPUTimeNS = 0;   // per iteration
+    double dfBytesPerSecond = 0;
+};
+
+std::vector<Benchmark> gaoBenchmarks{};
+
+void Register(const std::string &osName, size_t nBytesPerIteration,
+              std::function<void()> fn)
+{
+    Benchmark oBenchmark;
+    oBenchmark.osName = osName;
+    oBenchmark.nBytesPerIteration = nBytesPerIteration;
+    oBenchmark.fn = std::move(fn);
+    gaoBenchmarks.emplace_back(std::move(oBenchmark));
+}
+
+/************************************************************************/
+/*                                Run()                                 */
+/************************************************************************/
+
+BenchmarkResult Run(const Benchmark &oBenchmark, double dfMinTime)
+{
+    // Warm-up, so that lazy initializations are not accounted for
+    oBenchmark.fn();
+
+    const auto tStart = std::chrono::steady_clock::now();
+    const auto nCPUStart = clock();
+    GIntBig nIterations = 0;
+    double dfElapsed = 0;
+    do
+    {
+        oBenchmark.fn();
+        ++nIterations;
+        dfElapsed = std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - tStart)
+                        .count();
+    } while (dfElapsed < dfMinTime);
+    const double dfCPU =
+        static_cast<double>(clock() - nCPUStart) / CLOCKS_PER_SEC;
+
+    BenchmarkResult oResult;
+    oResult.osName = oBenchmark.osName;
+    oResult.nIterations = nIterations;
+    oResult.dfRealTimeNS = dfElapsed * 1e9 / static_cast<double>(nIterations);
+    oResult.dfCPUTimeNS = dfCPU * 1e9 / static_cast<double>(nIterations);
+    if (oBenchmark.nBytesPerIteration)
+    {
+        oResult.dfBytesPerSecond =
+            static_cast<double>(oBenchmark.nBytesPerIteration) *
+            static_cast<double>(nIterations) / dfElapsed;
+    }
+    return oResult;
+}
+
+/************************************************************************/
+/*                             FillBuffer()                             */
+/************************************************************************/
+
+// Fills a buffer with a smooth ramp plus some noise, which is representative
+// of imagery, and remains within the range of all data types.
+void FillBuffer(void *pBuffer, GDALDataType eDT, int nXSize, int nYSize)
+{
+    std::vector<double> adfLine(nXSize);
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+    GUInt32 nSeed = 1;
+    for (int iY = 0; iY < nYSize; ++iY)
+    {
+        for (int iX = 0; iX < nXSize; ++iX)
+        {
+            nSeed = nSeed * 1103515245U + 12345U;
+            adfLine[iX] = ((iX + iY) % 100) + ((nSeed >> 16) % 20);
+        }
+        GDALCopyWords(adfLine.data(), GDT_Float64, sizeof(double),
+                      static_cast<GByte *>(pBuffer) +
+                          static_cast<size_t>(iY) * nXSize * nDTSize,
+                      eDT, nDTSize, nXSize);
+    }
+}
+
+/************************************************************************/
+/*                           CreateMEMDataset()                         */
+/************************************************************************/
+
+GDALDataset *CreateMEMDataset(int nXSize, int nYSize, GDALDataType eDT,
+                              bool bFill)
+{
+    auto poDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (!poDriver)
+    {
+        fprintf(stderr, "MEM driver not available\n");
+        exit(1);
+    }
+    auto poDS = poDriver->Create("", nXSize, nYSize, 1, eDT, nullptr);
+    if (bFill)
+    {
+        std::vector<GByte> abyBuffer(static_cast<size_t>(nXSize) * nYSize *
+                                     GDALGetDataTypeSizeBytes(eDT));
+        FillBuffer(abyBuffer.data(), eDT, nXSize, nYSize);
+        CPL_IGNORE_RET_VAL(poDS->GetRasterBand(1)->RasterIO(
+            GF_Write, 0, 0, nXSize, nYSize, abyBuffer.data(), nXSize, nYSize,
+            eDT, 0, 0, nullptr));
+    }
+    return poDS;
+}
+
+const GDALDataType aeTypes[] = {GDT_Byte,  GDT_Int16,   GDT_UInt16,
+                                GDT_Int32, GDT_Float32, GDT_Float64};
+
+const GDALDataType aeRasterTypes[] = {GDT_Byte, GDT_UInt16, GDT_Float32};
+
+/************************************************************************/
+/*                        RegisterCopyWords()                           */
+/************************************************************************/
+
+void RegisterCopyWords()
+{
+    constexpr size_t N = 1024 * 1024;
+    for (const auto eSrcDT : aeTypes)
+    {
+        for (const auto eDstDT : aeTypes)
+        {
+            const int nSrcSize = GDALGetDataTypeSizeBytes(eSrcDT);
+            const int nDstSize = GDALGetDataTypeSizeBytes(eDstDT);
+            auto pabySrc = std::make_shared<std::vector<GByte>>(N * nSrcSize);
+            auto pabyDst = std::make_shared<std::vector<GByte>>(N * nDstSize);
+            FillBuffer(pabySrc->data(), eSrcDT, 1024, 1024);
+            Register(std::string("CopyWords/")
+                         .append(GDALGetDataTypeName(eSrcDT))
+                         .append("/")
+                         .append(GDALGetDataTypeName(eDstDT)),
+                     N * (nSrcSize + nDstSize),
+                     [=]()
+                     {
+                         GDALCopyWords64(pabySrc->data(), eSrcDT, nSrcSize,
+                                         pabyDst->data(), eDstDT, nDstSize,
+                                         N);
+                     });
+        }
+    }
+
+    // Extraction of one component of a pixel-interleaved buffer
+    {
+        auto pabySrc = std::make_shared<std::vector<GByte>>(N * 3);
+        auto pabyDst = std::make_shared<std::vector<GByte>>(N);
+        Register("CopyWords/Byte/Byte/stride:3", N * 2,
+                 [=]()
+                 {
+                     GDALCopyWords64(pabySrc->data(), GDT_Byte, 3,
+                                     pabyDst->data(), GDT_Byte, 1, N);
+                 });
+    }
+}
+
+/************************************************************************/
+/*                        RegisterSwapWords()                           */
+/************************************************************************/
+
+void RegisterSwapWords()
+{
+    constexpr size_t N = 1024 * 1024;
+    for (const int nWordSize : {2, 4, 8})
+    {
+        auto pabyBuffer = std::make_shared<std::vector<GByte>>(N * nWordSize);
+        Register(CPLSPrintf("SwapWords/%d", nWordSize), N * nWordSize,
+                 [=]() {
+                     GDALSwapWordsEx(pabyBuffer->data(), nWordSize, N,
+                                     nWordSize);
+                 });
+    }
+}
+
+/************************************************************************/
+/*                        RegisterOverviews()                           */
+/************************************************************************/
+
+void RegisterOverviews()
+{
+    constexpr int SIZE = 1024;
+    for (const char *pszResampling :
+         {"NEAREST", "AVERAGE", "RMS", "BILINEAR", "CUBIC", "CUBICSPLINE",
+          "LANCZOS", "GAUSS", "MODE"})
+    {
+        for (const auto eDT : aeRasterTypes)
+        {
+            std::shared_ptr<GDALDataset> poSrcDS(
+                CreateMEMDataset(SIZE, SIZE, eDT, true), GDALClose);
+            std::shared_ptr<GDALDataset> poOvrDS(
+                CreateMEMDataset(SIZE / 2, SIZE / 2, eDT, false), GDALClose);
+            const std::string osResampling(pszResampling);
+            Register(std::string("Overview/")
+                         .append(pszResampling)
+                         .append("/")
+                         .append(GDALGetDataTypeName(eDT)),
+                     static_cast<size_t>(SIZE) * SIZE *
+                         GDALGetDataTypeSizeBytes(eDT),
+                     [=]()
+                     {
+                         GDALRasterBandH hOvrBand = GDALRasterBand::ToHandle(
+                             poOvrDS->GetRasterBand(1));
+                         CPL_IGNORE_RET_VAL(GDALRegenerateOverviews(
+                             GDALRasterBand::ToHandle(
+                                 poSrcDS->GetRasterBand(1)),
+                             1, &hOvrBand, osResampling.c_str(), nullptr,
+                             nullptr));
+                     });
+        }
+    }
+}
+
+/************************************************************************/
+/*                           RegisterWarp()                             */
+/************************************************************************/
+
+void RegisterWarp()
+{
+    constexpr int SRC_SIZE = 1024;
+    constexpr int DST_SIZE = 1000;
+    const struct
+    {
+        const char *pszName;
+        GDALResampleAlg eResampleAlg;
+    } asResamplings[] = {{"near", GRA_NearestNeighbour},
+                         {"bilinear", GRA_Bilinear},
+                         {"cubic", GRA_Cubic},
+                         {"cubicspline", GRA_CubicSpline},
+                         {"lanczos", GRA_Lanczos},
+                         {"average", GRA_Average},
+                         {"mode", GRA_Mode}};
+    for (const auto &sResampling : asResamplings)
+    {
+        const GDALResampleAlg eResampleAlg = sResampling.eResampleAlg;
+        for (const auto eDT : aeRasterTypes)
+        {
+            // No CRS: the transformation only involves the geotransforms,
+            // with a slight scaling and shift so that resampling is
+            // actually needed.
+            std::shared_ptr<GDALDataset> poSrcDS(
+                CreateMEMDataset(SRC_SIZE, SRC_SIZE, eDT, true), GDALClose);
+            double adfSrcGT[] = {0, 1, 0, SRC_SIZE, 0, -1};
+            poSrcDS->SetGeoTransform(adfSrcGT);
+            std::shared_ptr<GDALDataset> poDstDS(
+                CreateMEMDataset(DST_SIZE, DST_SIZE, eDT, false), GDALClose);
+            const double dfRes = (SRC_SIZE - 1.5) / DST_SIZE;
+            double adfDstGT[] = {0.75, dfRes, 0, SRC_SIZE - 0.75, 0, -dfRes};
+            poDstDS->SetGeoTransform(adfDstGT);
+
+            Register(std::string("Warp/")
+                         .append(sResampling.pszName)
+                         .append("/")
+                         .append(GDALGetDataTypeName(eDT)),
+                     static_cast<size_t>(DST_SIZE) * DST_SIZE *
+                         GDALGetDataTypeSizeBytes(eDT),
+                     [=]()
+                     {
+                         GDALWarpOptions *psWO = GDALCreateWarpOptions();
+                         psWO->hSrcDS = GDALDataset::ToHandle(poSrcDS.get());
+                         psWO->hDstDS = GDALDataset::ToHandle(poDstDS.get());
+                         psWO->nBandCount = 1;
+                         psWO->panSrcBands =
+                             static_cast<int *>(CPLMalloc(sizeof(int)));
+                         psWO->panSrcBands[0] = 1;
+                         psWO->panDstBands =
+                             static_cast<int *>(CPLMalloc(sizeof(int)));
+                         psWO->panDstBands[0] = 1;
+                         psWO->eResampleAlg = eResampleAlg;
+                         psWO->pfnTransformer = GDALGenImgProjTransform;
+                         psWO->pTransformerArg =
+                             GDALCreateGenImgProjTransformer2(
+                                 psWO->hSrcDS, psWO->hDstDS, nullptr);
+                         GDALWarpOperationH hOperation =
+                             GDALCreateWarpOperation(psWO);
+                         if (hOperation)
+                         {
+                             CPL_IGNORE_RET_VAL(GDALChunkAndWarpImage(
+                                 hOperation, 0, 0, DST_SIZE, DST_SIZE));
+                             GDALDestroyWarpOperation(hOperation);
+                         }
+                         GDALDestroyGenImgProjTransformer(
+                             psWO->pTransformerArg);
+                         GDALDestroyWarpOptions(psWO);
+                     });
+        }
+    }
+}
+
+/************************************************************************/
+/*                        RegisterStatistics()                          */
+/************************************************************************/
+
+void RegisterStatistics()
+{
+    constexpr int SIZE = 2048;
+    for (const auto eDT : aeRasterTypes)
+    {
+        std::shared_ptr<GDALDataset> poDS(
+            CreateMEMDataset(SIZE, SIZE, eDT, true), GDALClose);
+        const size_t nBytes =
+            static_cast<size_t>(SIZE) * SIZE * GDALGetDataTypeSizeBytes(eDT);
+        Register(
+            std::string("Statistics/").append(GDALGetDataTypeName(eDT)),
+            nBytes,
+            [=]()
+            {
+                double dfMin, dfMax, dfMean, dfStdDev;
+                CPL_IGNORE_RET_VAL(poDS->GetRasterBand(1)->ComputeStatistics(
+                    false, &dfMin, &dfMax, &dfMean, &dfStdDev, nullptr,
+                    nullptr));
+            });
+        Register(std::string("MinMax/").append(GDALGetDataTypeName(eDT)),
+                 nBytes,
+                 [=]()
+                 {
+                     double adfMinMax[2];
+                     CPL_IGNORE_RET_VAL(
+                         poDS->GetRasterBand(1)->ComputeRasterMinMax(
+                             false, adfMinMax));
+                 });
+    }
+}
+
+/************************************************************************/
+/*                      RegisterPixelFunctions()                        */
+/************************************************************************/
+
+void RegisterPixelFunctions()
+{
+    constexpr int SIZE = 1024;
+    std::shared_ptr<GDALDataset> poSrcDS1(
+        CreateMEMDataset(SIZE, SIZE, GDT_Float32, true), GDALClose);
+    std::shared_ptr<GDALDataset> poSrcDS2(
+        CreateMEMDataset(SIZE, SIZE, GDT_Float32, true), GDALClose);
+
+    const struct
+    {
+        const char *pszName;
+        int nSources;
+    } asFunctions[] = {{"sum", 2},  {"diff", 2},    {"mul", 2},
+                       {"div", 2},  {"min", 2},     {"max", 2},
+                       {"log10", 1}, {"dB", 1},     {"sqrt", 1},
+                       {"inv", 1},  {"norm_diff", 2}};
+    for (const auto &sFunction : asFunctions)
+    {
+        auto hVRTDS = VRTCreate(SIZE, SIZE);
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("subclass", "VRTDerivedRasterBand");
+        aosOptions.SetNameValue("PixelFunctionType", sFunction.pszName);
+        aosOptions.SetNameValue("SourceTransferType", "Float32");
+        GDALAddBand(hVRTDS, GDT_Float32, aosOptions.List());
+        auto hVRTBand = GDALGetRasterBand(hVRTDS, 1);
+        for (int i = 0; i < sFunction.nSources; ++i)
+        {
+            VRTAddSimpleSource(
+                hVRTBand,
+                GDALRasterBand::ToHandle(
+                    (i == 0 ? poSrcDS1 : poSrcDS2)->GetRasterBand(1)),
+                0, 0, SIZE, SIZE, 0, 0, SIZE, SIZE, nullptr,
+                VRT_NODATA_UNSET);
+        }
+        std::shared_ptr<GDALDataset> poVRTDS(GDALDataset::FromHandle(hVRTDS),
+                                             GDALClose);
+        auto pabyBuffer =
+            std::make_shared<std::vector<float>>(static_cast<size_t>(SIZE) *
+                                                 SIZE);
+        Register(std::string("PixelFunction/").append(sFunction.pszName),
+                 static_cast<size_t>(SIZE) * SIZE * sizeof(float),
+                 [=]()
+                 {
+                     CPL_IGNORE_RET_VAL(poVRTDS->GetRasterBand(1)->RasterIO(
+                         GF_Read, 0, 0, SIZE, SIZE, pabyBuffer->data(), SIZE,
+                         SIZE, GDT_Float32, 0, 0, nullptr));
+                 });
+    }
+}
+
+/************************************************************************/
+/*                       RegisterCompressors()                          */
+/************************************************************************/
+
+void RegisterCompressors()
+{
+    constexpr int SIZE = 1024;
+    auto pabyData = std::make_shared<std::vector<GByte>>(
+        static_cast<size_t>(SIZE) * SIZE * sizeof(GUInt16));
+    FillBuffer(pabyData->data(), GDT_UInt16, SIZE, SIZE);
+
+    const CPLStringList aosCompressors(CPLGetCompressors());
+    for (const char *pszId : aosCompressors)
+    {
+        const CPLCompressor *psCompressor = CPLGetCompressor(pszId);
+        const CPLCompressor *psDecompressor = CPLGetDecompressor(pszId);
+        if (!psCompressor || !psDecompressor)
+            continue;
+
+        // Compressed once, so that decompression can be benchmarked
+        // independently.
+        void *pCompressed = nullptr;
+        size_t nCompressedSize = 0;
+        if (!psCompressor->pfnFunc(pabyData->data(), pabyData->size(),
+                                   &pCompressed, &nCompressedSize, nullptr,
+                                   psCompressor->user_data))
+        {
+            continue;
+        }
+        auto pabyCompressed = std::make_shared<std::vector<GByte>>(
+            static_cast<GByte *>(pCompressed),
+            static_cast<GByte *>(pCompressed) + nCompressedSize);
+        VSIFree(pCompressed);
+
+        Register(std::string("Compressor/").append(pszId).append("/compress"),
+                 pabyData->size(),
+                 [=]()
+                 {
+                     void *pOut = nullptr;
+                     size_t nOutSize = 0;
+                     CPL_IGNORE_RET_VAL(psCompressor->pfnFunc(
+                         pabyData->data(), pabyData->size(), &pOut, &nOutSize,
+                         nullptr, psCompressor->user_data));
+                     VSIFree(pOut);
+                 });
+
+        auto pabyOut = std::make_shared<std::vector<GByte>>(pabyData->size());
+        Register(
+            std::string("Compressor/").append(pszId).append("/decompress"),
+            pabyData->size(),
+            [=]()
+            {
+                void *pOut = pabyOut->data();
+                size_t nOutSize = pabyOut->size();
+                CPL_IGNORE_RET_VAL(psDecompressor->pfnFunc(
+                    pabyCompressed->data(), pabyCompressed->size(), &pOut,
+                    &nOutSize, nullptr, psDecompressor->user_data));
+            });
+    }
+}
+
+/************************************************************************/
+/*                               Usage()                                */
+/************************************************************************/
+
+void Usage()
+{
+    printf("Usage: bench_raster_primitives [--benchmark_list_tests]\n");
+    printf("                               [--benchmark_filter=<regex>]\n");
+    printf(
+        "                               [--benchmark_min_time=<seconds>]\n");
+    printf(
+        "                               [--benchmark_format=console|json]\n");
+    printf("                               [--benchmark_out=<filename>]\n");
+    exit(1);
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                               main()                                 */
+/************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    /* -------------------------------------------------------------------- */
+    /*      Process arguments.                                              */
+    /* -------------------------------------------------------------------- */
+    GDALAllRegister();
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        exit(-argc);
+
+    std::string osFilter(".*");
+    double dfMinTime = 0.5;
+    bool bJSON = false;
+    bool bList = false;
+    std::string osOut;
+    for (int iArg = 1; iArg < argc; ++iArg)
+    {
+        const char *pszArg = argv[iArg];
+        if (STARTS_WITH(pszArg, "--benchmark_filter="))
+        {
+            osFilter = pszArg + strlen("--benchmark_filter=");
+        }
+        else if (STARTS_WITH(pszArg, "--benchmark_min_time="))
+        {
+            // google-benchmark accepts a "s" suffix
+            dfMinTime = CPLAtof(pszArg + strlen("--benchmark_min_time="));
+        }
+        else if (STARTS_WITH(pszArg, "--benchmark_format="))
+        {
+            const char *pszFormat = pszArg + strlen("--benchmark_format=");
+            if (EQUAL(pszFormat, "json"))
+                bJSON = true;
+            else if (!EQUAL(pszFormat, "console"))
+                Usage();
+        }
+        else if (STARTS_WITH(pszArg, "--benchmark_out="))
+        {
+            osOut = pszArg + strlen("--benchmark_out=");
+        }
+        else if (strcmp(pszArg, "--benchmark_list_tests") == 0)
+        {
+            bList = true;
+        }
+        else
+        {
+            Usage();
+        }
+    }
+
+    std::regex oFilter;
+    try
+    {
+        oFilter = std::regex(osFilter);
+    }
+    catch (const std::regex_error &)
+    {
+        fprintf(stderr, "Invalid regular expression: %s\n", osFilter.c_str());
+        exit(1);
+    }
+
+    RegisterCopyWords();
+    RegisterSwapWords();
+    RegisterOverviews();
+    RegisterWarp();
+    RegisterStatistics();
+    RegisterPixelFunctions();
+    RegisterCompressors();
+
+    std::vector<BenchmarkResult> aoResults;
+    for (const auto &oBenchmark : gaoBenchmarks)
+    {
+        if (!std::regex_search(oBenchmark.osName, oFilter))
+            continue;
+        if (bList)
+        {
+            printf("%s\n", oBenchmark.osName.c_str());
+            continue;
+        }
+        const auto oResult = Run(oBenchmark, dfMinTime);
+        if (!bJSON)
+        {
+            printf("%-40s %15.0f ns %15.0f ns %10" CPL_FRMT_GB_WITHOUT_PREFIX
+                   "d",
+                   oResult.osName.c_str(), oResult.dfRealTimeNS,
+                   oResult.dfCPUTimeNS, oResult.nIterations);
+            if (oResult.dfBytesPerSecond > 0)
+                printf(" %10.1f MB/s", oResult.dfBytesPerSecond / 1e6);
+            printf("\n");
+            fflush(stdout);
+        }
+        aoResults.emplace_back(oResult);
+    }
+    gaoBenchmarks.clear();
+
+    if (!bList && (bJSON || !osOut.empty()))
+    {
+        CPLJSONDocument oDoc;
+        CPLJSONObject oRoot = oDoc.GetRoot();
+
+        CPLJSONObject oContext;
+        oContext.Add("gdal_version", GDALVersionInfo("RELEASE_NAME"));
+        oContext.Add("num_cpus", CPLGetNumCPUs());
+        oContext.Add("min_time", dfMinTime);
+        oRoot.Add("context", oContext);
+
+        CPLJSONArray oBenchmarks;
+        for (const auto &oResult : aoResults)
+        {
+            CPLJSONObject oBenchmark;
+            oBenchmark.Add("name", oResult.osName);
+            oBenchmark.Add("run_type", "iteration");
+            oBenchmark.Add("iterations",
+                           static_cast<GInt64>(oResult.nIterations));
+            oBenchmark.Add("real_time", oResult.dfRealTimeNS);
+            oBenchmark.Add("cpu_time", oResult.dfCPUTimeNS);
+            oBenchmark.Add("time_unit", "ns");
+            if (oResult.dfBytesPerSecond > 0)
+                oBenchmark.Add("bytes_per_second", oResult.dfBytesPerSecond);
+            oBenchmarks.Add(oBenchmark);
+        }
+        oRoot.Add("benchmarks", oBenchmarks);
+
+        if (!osOut.empty())
+        {
+            if (!oDoc.Save(osOut))
+                exit(1);
+        }
+        else
+        {
+            printf("%s\n", oDoc.SaveAsString().c_str());
+        }
+    }
+
+    GDALDestroyDriverManager();
+    CSLDestroy(argv);
+
+    return 0;
+}
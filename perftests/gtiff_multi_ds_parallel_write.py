@@ -17,6 +17,8 @@ def Usage():
     print("gtiff_multi_ds_parallel_write.py [--nbands VAL] [--without-optim]")
     print("                                 [--compress NONE/ZSTD/...]")
     print("                                 [--buffer-interleave PIXEL/BAND]")
+    print("                                 [--compression-threads VAL]")
+    print("                                 [--queue-max-bytes VAL]")
     sys.exit(1)
 
 
@@ -27,6 +29,7 @@ compression = "ZSTD"
 buffer_pixel_interleaved = True
 width = 2048
 height = 2048
+compression_threads = None
 
 # Parse arguments
 i = 1
@@ -42,6 +45,13 @@ while i < len(sys.argv):
         buffer_pixel_interleaved = sys.argv[i] == "PIXEL"
     elif sys.argv[i] == "--without-optim":
         with_optim = False
+    elif sys.argv[i] == "--compression-threads":
+        # Each dataset also uses worker threads of the global thread pool
+        i += 1
+        compression_threads = sys.argv[i]
+    elif sys.argv[i] == "--queue-max-bytes":
+        i += 1
+        gdal.SetConfigOption("GTIFF_COMPRESSION_QUEUE_MAX_BYTES", sys.argv[i])
     else:
         Usage()
     i += 1
@@ -56,6 +66,8 @@ def thread_function(num):
     filename = "/vsimem/tmp%d.tif" % num
     drv = gdal.GetDriverByName("GTiff")
     options = ["TILED=YES", "COMPRESS=" + compression]
+    if compression_threads:
+        options.append("NUM_THREADS=" + compression_threads)
     for i in range(nloops):
         ds = drv.Create(filename, width, height, nbands, options=options)
         if not with_optim:
@@ -0,0 +1,64 @@
+# SPDX-License-Identifier: MIT
+
+# Benchmark of DEFLATE compression with and without predictor, on DEM-like
+# and imagery-like content.
+
+import math
+import struct
+import time
+
+from osgeo import gdal
+
+
+def create_src(dt, nbands, size=4096):
+
+    ds = gdal.GetDriverByName("MEM").Create("", size, size, nbands, dt)
+    for i in range(nbands):
+        # Smooth surface with some noise
+        values = [
+            120 + 50 * math.sin(x / 100.0) + (x * 7) % 5 + i * 10 for x in range(size)
+        ]
+        if dt == gdal.GDT_Float32:
+            row = struct.pack("f" * size, *values)
+        elif dt == gdal.GDT_Int16:
+            row = struct.pack("h" * size, *[int(v) for v in values])
+        else:
+            row = bytes(int(v) & 0xFF for v in values)
+        band = ds.GetRasterBand(i + 1)
+        dtsize = gdal.GetDataTypeSizeBytes(dt)
+        for y in range(size):
+            shift = (y % 7) * dtsize
+            band.WriteRaster(0, y, size, 1, row[shift:] + row[:shift])
+    return ds
+
+
+def doit(label, dt, nbands, predictor):
+
+    src_ds = create_src(dt, nbands)
+    filename = "/vsimem/test.tif"
+    options = ["COMPRESS=DEFLATE", "TILED=YES", "PREDICTOR=%d" % predictor]
+
+    start = time.time()
+    gdal.GetDriverByName("GTiff").CreateCopy(filename, src_ds, options=options)
+    write_time = time.time() - start
+
+    ds = gdal.Open(filename)
+    start = time.time()
+    ds.ReadRaster()
+    read_time = time.time() - start
+    ds = None
+    gdal.Unlink(filename)
+
+    print(
+        "%s, PREDICTOR=%d: write %.2f s, read %.2f s"
+        % (label, predictor, write_time, read_time)
+    )
+
+
+doit("DEM Float32", gdal.GDT_Float32, 1, 1)
+doit("DEM Float32", gdal.GDT_Float32, 1, 3)
+doit("DEM Int16", gdal.GDT_Int16, 1, 1)
+doit("DEM Int16", gdal.GDT_Int16, 1, 2)
+doit("RGB Byte", gdal.GDT_Byte, 3, 1)
+doit("RGB Byte", gdal.GDT_Byte, 3, 2)
+doit("RGBA Byte", gdal.GDT_Byte, 4, 2)
@@ -79,6 +79,49 @@ int main(int /* argc */, char * /* argv */[])
         }
     }
 
+    // Packed conversions with realistic (non-zero) values, with and without
+    // the AVX2 code paths. Note: GDAL_USE_AVX2=NO is only honoured in DEBUG
+    // builds.
+    for (size_t j = 0; j < 256 * 256 * 2; j++)
+        static_cast<double *>(in)[j] = static_cast<double>(j % 1000) - 100.5;
+    for (int k = 0; k < 2; k++)
+    {
+        if (k == 1)
+        {
+            printf("Disabling AVX2\n");
+            CPLSetConfigOption("GDAL_USE_AVX2", "NO");
+        }
+
+        for (intype = GDT_Byte; intype < GDT_TypeCount; intype++)
+        {
+            for (outtype = GDT_Byte; outtype < GDT_TypeCount; outtype++)
+            {
+                if (intype == outtype)
+                    continue;
+
+                const int nIters = 1000;
+                start = clock();
+
+                for (i = 0; i < nIters; i++)
+                    GDALCopyWords(
+                        in, (GDALDataType)intype,
+                        GDALGetDataTypeSizeBytes((GDALDataType)intype), out,
+                        (GDALDataType)outtype,
+                        GDALGetDataTypeSizeBytes((GDALDataType)outtype),
+                        256 * 256);
+
+                end = clock();
+
+                printf("%s -> %s (packed) : %.3f ns/word\n",
+                       GDALGetDataTypeName((GDALDataType)intype),
+                       GDALGetDataTypeName((GDALDataType)outtype),
+                       (end - start) * 1e9 / CLOCKS_PER_SEC /
+                           (static_cast<double>(nIters) * 256 * 256));
+            }
+        }
+    }
+    CPLSetConfigOption("GDAL_USE_AVX2", nullptr);
+
     for (int k = 0; k < 2; k++)
     {
         if (k == 1)
@@ -113,5 +156,29 @@ int main(int /* argc */, char * /* argv */[])
     }
     CPLSetConfigOption("GDAL_USE_SSSE3", nullptr);
 
+    // Packed byte swapping, with and without the AVX2 code path.
+    for (int k = 0; k < 2; k++)
+    {
+        if (k == 1)
+        {
+            printf("Disabling AVX2\n");
+            CPLSetConfigOption("GDAL_USE_AVX2", "NO");
+        }
+
+        for (int nWordSize = 2; nWordSize <= 8; nWordSize *= 2)
+        {
+            const int nWords = 256 * 256 * 16 / nWordSize;
+            start = clock();
+            for (i = 0; i < 1000; i++)
+                GDALSwapWords(out, nWordSize, nWords, nWordSize);
+            end = clock();
+            printf("GDALSwapWords %d bytes (packed) : %.3f ns/word\n",
+                   nWordSize,
+                   (end - start) * 1e9 / CLOCKS_PER_SEC /
+                       (1000.0 * nWords));
+        }
+    }
+    CPLSetConfigOption("GDAL_USE_AVX2", nullptr);
+
     return 0;
 }
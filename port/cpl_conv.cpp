@@ -60,6 +60,7 @@
 #include "cpl_conv.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <cerrno>
 #include <climits>
@@ -81,7 +82,11 @@
 #ifdef DEBUG_CONFIG_OPTIONS
 #include <set>
 #endif
+#include <memory>
+#include <mutex>
+#include <new>
 #include <string>
+#include <vector>
 
 #if __cplusplus >= 202002L
 #include <type_traits>  // For std::endian
@@ -90,6 +95,7 @@
 #include "cpl_config.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
+#include "cpl_trace.h"
 #include "cpl_vsi.h"
 #include "cpl_vsil_curl_priv.h"
 
@@ -105,8 +111,43 @@ void OGRAPISPYCPLSetThreadLocalConfigOption(const char *, const char *);
 // Uncomment to get list of options that have been fetched and set.
 // #define DEBUG_CONFIG_OPTIONS
 
+namespace
+{
+struct CPLConfigOptionEntry
+{
+    std::string osKey{};
+    std::string osValue{};
+};
+
+// Immutable list of global configuration options, in the order they were
+// first set. Entries that are not modified are shared between successive
+// snapshots, so that the strings returned by CPLGetConfigOption() for them
+// stay valid.
+using CPLConfigOptionSnapshot =
+    std::vector<std::shared_ptr<const CPLConfigOptionEntry>>;
+}  // namespace
+
+namespace
+{
+// Snapshot being read by a thread, if any ("hazard pointer"). Each thread
+// has its own one, stored in thread local storage, so that readers do not
+// write to any shared memory location.
+struct CPLConfigOptionsHazard
+{
+    std::atomic<const CPLConfigOptionSnapshot *> poSnapshot{nullptr};
+};
+}  // namespace
+
+// Writers (protected by hConfigMutex) publish a new snapshot in
+// g_poConfigOptions, while readers access the current one without locking,
+// after having published it in their hazard pointer. Replaced snapshots are
+// only freed once they are no longer referenced by any hazard pointer.
 static CPLMutex *hConfigMutex = nullptr;
-static volatile char **g_papszConfigOptions = nullptr;
+static std::atomic<const CPLConfigOptionSnapshot *> g_poConfigOptions{
+    nullptr};
+static std::vector<const CPLConfigOptionSnapshot *>
+    g_apoRetiredConfigOptions{};
+static std::atomic<GUIntBig> g_nConfigOptionsGeneration{1};
 static bool gbIgnoreEnvVariables =
     false;  // if true, only take into account configuration options set through
             // configuration file or
@@ -1744,7 +1785,108 @@ const char *CPL_STDCALL CPLGetConfigOption(const char *pszKey,
 char **CPLGetConfigOptions(void)
 {
     CPLMutexHolderD(&hConfigMutex);
-    return CSLDuplicate(const_cast<char **>(g_papszConfigOptions));
+    CPLStringList aosRet;
+    const CPLConfigOptionSnapshot *poSnapshot = g_poConfigOptions.load();
+    if (poSnapshot)
+    {
+        for (const auto &poEntry : *poSnapshot)
+            aosRet.AddNameValue(poEntry->osKey.c_str(),
+                                poEntry->osValue.c_str());
+    }
+    return aosRet.StealList();
+}
+
+/************************************************************************/
+/*                     GetConfigOptionsHazards()                        */
+/************************************************************************/
+
+// Intentionally leaked, as threads may exit after static destructors ran.
+static std::mutex &GetConfigOptionsHazardsMutex()
+{
+    static std::mutex *poMutex = new std::mutex();
+    return *poMutex;
+}
+
+static std::vector<CPLConfigOptionsHazard *> &GetConfigOptionsHazards()
+{
+    static auto *papoHazards = new std::vector<CPLConfigOptionsHazard *>();
+    return *papoHazards;
+}
+
+static void CPLConfigOptionsHazardFreeFunc(void *pData)
+{
+    auto psHazard = static_cast<CPLConfigOptionsHazard *>(pData);
+    {
+        std::lock_guard<std::mutex> oLock(GetConfigOptionsHazardsMutex());
+        auto &apoHazards = GetConfigOptionsHazards();
+        apoHazards.erase(
+            std::remove(apoHazards.begin(), apoHazards.end(), psHazard),
+            apoHazards.end());
+    }
+    delete psHazard;
+}
+
+/************************************************************************/
+/*                   GetThreadConfigOptionsHazard()                     */
+/************************************************************************/
+
+/* Return the hazard pointer of the current thread, or nullptr in case of
+ * memory allocation error */
+static CPLConfigOptionsHazard *GetThreadConfigOptionsHazard()
+{
+    int bMemoryError = FALSE;
+    auto psHazard = static_cast<CPLConfigOptionsHazard *>(
+        CPLGetTLSEx(CTLS_CONFIGOPTIONSHAZARD, &bMemoryError));
+    if (psHazard == nullptr && !bMemoryError)
+    {
+        psHazard = new (std::nothrow) CPLConfigOptionsHazard();
+        if (psHazard)
+        {
+            {
+                std::lock_guard<std::mutex> oLock(
+                    GetConfigOptionsHazardsMutex());
+                GetConfigOptionsHazards().push_back(psHazard);
+            }
+            CPLSetTLSWithFreeFunc(CTLS_CONFIGOPTIONSHAZARD, psHazard,
+                                  CPLConfigOptionsHazardFreeFunc);
+        }
+    }
+    return psHazard;
+}
+
+/************************************************************************/
+/*                  PublishConfigOptions_unlocked()                     */
+/************************************************************************/
+
+/* Must be called with hConfigMutex held */
+static void
+PublishConfigOptions_unlocked(const CPLConfigOptionSnapshot *poNewSnapshot)
+{
+    const CPLConfigOptionSnapshot *poOldSnapshot =
+        g_poConfigOptions.exchange(poNewSnapshot);
+    ++g_nConfigOptionsGeneration;
+    if (poOldSnapshot)
+        g_apoRetiredConfigOptions.push_back(poOldSnapshot);
+
+    // A reader that publishes its hazard pointer after this scan
+    // necessarily sees the new snapshot when checking it again.
+    std::lock_guard<std::mutex> oLock(GetConfigOptionsHazardsMutex());
+    const auto &apoHazards = GetConfigOptionsHazards();
+    std::vector<const CPLConfigOptionSnapshot *> apoStillInUse;
+    for (const auto *poSnapshot : g_apoRetiredConfigOptions)
+    {
+        if (std::any_of(apoHazards.begin(), apoHazards.end(),
+                        [poSnapshot](const CPLConfigOptionsHazard *psHazard)
+                        { return psHazard->poSnapshot.load() == poSnapshot; }))
+        {
+            apoStillInUse.push_back(poSnapshot);
+        }
+        else
+        {
+            delete poSnapshot;
+        }
+    }
+    g_apoRetiredConfigOptions = std::move(apoStillInUse);
 }
 
 /************************************************************************/
@@ -1770,9 +1912,22 @@ char **CPLGetConfigOptions(void)
 void CPLSetConfigOptions(const char *const *papszConfigOptions)
 {
     CPLMutexHolderD(&hConfigMutex);
-    CSLDestroy(const_cast<char **>(g_papszConfigOptions));
-    g_papszConfigOptions = const_cast<volatile char **>(
-        CSLDuplicate(const_cast<char **>(papszConfigOptions)));
+    auto poNewSnapshot = std::make_unique<CPLConfigOptionSnapshot>();
+    for (const char *const *papszIter = papszConfigOptions;
+         papszIter && *papszIter; ++papszIter)
+    {
+        char *pszKey = nullptr;
+        const char *pszValue = CPLParseNameValue(*papszIter, &pszKey);
+        if (pszKey && pszValue)
+        {
+            auto poEntry = std::make_shared<CPLConfigOptionEntry>();
+            poEntry->osKey = pszKey;
+            poEntry->osValue = pszValue;
+            poNewSnapshot->push_back(std::move(poEntry));
+        }
+        CPLFree(pszKey);
+    }
+    PublishConfigOptions_unlocked(poNewSnapshot.release());
 }
 
 /************************************************************************/
@@ -1819,10 +1974,48 @@ const char *CPL_STDCALL CPLGetGlobalConfigOption(const char *pszKey,
     CPLAccessConfigOption(pszKey, TRUE);
 #endif
 
-    CPLMutexHolderD(&hConfigMutex);
+    const char *pszResult = nullptr;
 
-    const char *pszResult =
-        CSLFetchNameValue(const_cast<char **>(g_papszConfigOptions), pszKey);
+    const auto FindInSnapshot =
+        [pszKey, &pszResult](const CPLConfigOptionSnapshot *poSnapshot)
+    {
+        if (poSnapshot)
+        {
+            for (const auto &poEntry : *poSnapshot)
+            {
+                if (EQUAL(poEntry->osKey.c_str(), pszKey))
+                {
+                    pszResult = poEntry->osValue.c_str();
+                    break;
+                }
+            }
+        }
+    };
+
+    CPLConfigOptionsHazard *psHazard = GetThreadConfigOptionsHazard();
+    if (psHazard)
+    {
+        // Protect the snapshot against being freed by a concurrent writer,
+        // by publishing it in our hazard pointer, and check that it is
+        // still the current one afterwards.
+        const CPLConfigOptionSnapshot *poSnapshot = g_poConfigOptions.load();
+        while (true)
+        {
+            psHazard->poSnapshot.store(poSnapshot);
+            const CPLConfigOptionSnapshot *poCurSnapshot =
+                g_poConfigOptions.load();
+            if (poCurSnapshot == poSnapshot)
+                break;
+            poSnapshot = poCurSnapshot;
+        }
+        FindInSnapshot(poSnapshot);
+        psHazard->poSnapshot.store(nullptr);
+    }
+    else
+    {
+        CPLMutexHolderD(&hConfigMutex);
+        FindInSnapshot(g_poConfigOptions.load());
+    }
 
     if (pszResult == nullptr)
         return pszDefault;
@@ -1903,6 +2096,9 @@ static void NotifyOtherComponentsConfigOptionChanged(const char *pszKey,
     if (STARTS_WITH_CI(pszKey, "AWS_"))
         VSICurlAuthParametersChanged();
 
+    if (!bThreadLocal && EQUAL(pszKey, "CPL_TRACE_FILE"))
+        CPLTraceConfigOptionChanged(pszValue);
+
     if (!gSetConfigOptionSubscribers.empty())
     {
         for (const auto &iter : gSetConfigOptionSubscribers)
@@ -1955,13 +2151,102 @@ void CPL_STDCALL CPLSetConfigOption(const char *pszKey, const char *pszValue)
     OGRAPISPYCPLSetConfigOption(pszKey, pszValue);
 #endif
 
-    g_papszConfigOptions = const_cast<volatile char **>(CSLSetNameValue(
-        const_cast<char **>(g_papszConfigOptions), pszKey, pszValue));
+    const CPLConfigOptionSnapshot *poSnapshot = g_poConfigOptions.load();
+    auto poNewSnapshot =
+        poSnapshot ? std::make_unique<CPLConfigOptionSnapshot>(*poSnapshot)
+                   : std::make_unique<CPLConfigOptionSnapshot>();
+    auto oIter = std::find_if(
+        poNewSnapshot->begin(), poNewSnapshot->end(),
+        [pszKey](const std::shared_ptr<const CPLConfigOptionEntry> &poEntry)
+        { return EQUAL(poEntry->osKey.c_str(), pszKey); });
+    if (pszValue == nullptr)
+    {
+        if (oIter != poNewSnapshot->end())
+            poNewSnapshot->erase(oIter);
+    }
+    else
+    {
+        auto poEntry = std::make_shared<CPLConfigOptionEntry>();
+        poEntry->osKey = pszKey;
+        poEntry->osValue = pszValue;
+        if (oIter != poNewSnapshot->end())
+            *oIter = std::move(poEntry);
+        else
+            poNewSnapshot->push_back(std::move(poEntry));
+    }
+    PublishConfigOptions_unlocked(poNewSnapshot.release());
 
     NotifyOtherComponentsConfigOptionChanged(pszKey, pszValue,
                                              /*bTheadLocal=*/false);
 }
 
+/************************************************************************/
+/*                        CPLConfigOptionCache()                        */
+/************************************************************************/
+
+/** Constructor.
+ *
+ * @param pszKey the key of the option to retrieve
+ * @param pszDefault a default value if the key does not match existing defined
+ *     options (may be NULL)
+ */
+CPLConfigOptionCache::CPLConfigOptionCache(const char *pszKey,
+                                           const char *pszDefault)
+    : m_osKey(pszKey), m_osDefault(pszDefault ? pszDefault : ""),
+      m_bHasDefault(pszDefault != nullptr)
+{
+}
+
+/************************************************************************/
+/*                       ~CPLConfigOptionCache()                        */
+/************************************************************************/
+
+CPLConfigOptionCache::~CPLConfigOptionCache()
+{
+    if (m_hMutex)
+        CPLDestroyMutex(m_hMutex);
+}
+
+/************************************************************************/
+/*                    CPLConfigOptionCache::Get()                       */
+/************************************************************************/
+
+/** Return the current value of the configuration option.
+ *
+ * The returned string has the same lifetime as the one returned by
+ * CPLGetConfigOption().
+ */
+const char *CPLConfigOptionCache::Get()
+{
+    const char *pszDefault = m_bHasDefault ? m_osDefault.c_str() : nullptr;
+
+    // Options of the current thread may differ from the ones of the thread
+    // that filled the cache.
+    int bMemoryError = FALSE;
+    char **papszTLConfigOptions = reinterpret_cast<char **>(
+        CPLGetTLSEx(CTLS_CONFIGOPTIONS, &bMemoryError));
+    if (papszTLConfigOptions != nullptr && papszTLConfigOptions[0] != nullptr)
+        return CPLGetConfigOption(m_osKey.c_str(), pszDefault);
+
+    // The value is stored before the generation (and read after it), so
+    // that a matching generation implies an up-to-date value.
+    if (m_nGeneration.load(std::memory_order_acquire) ==
+        g_nConfigOptionsGeneration.load(std::memory_order_acquire))
+    {
+        return m_pszValue.load(std::memory_order_acquire);
+    }
+
+    CPLMutexHolderD(&m_hMutex);
+    const GUIntBig nGeneration = g_nConfigOptionsGeneration.load();
+    if (m_nGeneration.load() != nGeneration)
+    {
+        m_pszValue.store(CPLGetConfigOption(m_osKey.c_str(), pszDefault),
+                         std::memory_order_release);
+        m_nGeneration.store(nGeneration, std::memory_order_release);
+    }
+    return m_pszValue.load(std::memory_order_acquire);
+}
+
 /************************************************************************/
 /*                   CPLSetThreadLocalTLSFreeFunc()                     */
 /************************************************************************/
@@ -2092,8 +2377,10 @@ void CPL_STDCALL CPLFreeConfig()
     {
         CPLMutexHolderD(&hConfigMutex);
 
-        CSLDestroy(const_cast<char **>(g_papszConfigOptions));
-        g_papszConfigOptions = nullptr;
+        PublishConfigOptions_unlocked(nullptr);
+        for (const auto *poSnapshot : g_apoRetiredConfigOptions)
+            delete poSnapshot;
+        g_apoRetiredConfigOptions.clear();
 
         int bMemoryError = FALSE;
         char **papszTLConfigOptions = reinterpret_cast<char **>(
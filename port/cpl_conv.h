@@ -287,6 +287,12 @@ CPLErr CPL_DLL CPLAddFileInZip(void *hZip, const char *pszArchiveFilename,
                                CSLConstList papszOptions,
                                GDALProgressFunc pProgressFunc,
                                void *pProgressData);
+CPLErr CPL_DLL CPLAddFilesInZip(void *hZip, int nFileCount,
+                                const char *const *papszArchiveFilenames,
+                                const char *const *papszInputFilenames,
+                                CSLConstList papszOptions,
+                                GDALProgressFunc pProgressFunc,
+                                void *pProgressData);
 CPLErr CPL_DLL CPLCloseZip(void *hZip);
 
 /* -------------------------------------------------------------------- */
@@ -393,6 +399,51 @@ extern "C++"
 
 #if defined(__cplusplus) && !defined(CPL_SUPRESS_CPLUSPLUS)
 
+extern "C++"
+{
+#ifndef DOXYGEN_SKIP
+#include <atomic>
+#include <string>
+#endif
+
+    /** Cached access to the value of a configuration option.
+     *
+     * Get() returns the same value as CPLGetConfigOption(), but only does a
+     * full lookup when global configuration options have changed since the
+     * previous call, or when the calling thread has thread-local
+     * configuration options. Environment variables are only read again
+     * after a change of the global configuration options.
+     *
+     * Instances are typically function-level static objects of code that
+     * queries an option in a hot path, and may be used concurrently by
+     * several threads.
+     *
+     * @since GDAL 3.9
+     */
+    class CPL_DLL CPLConfigOptionCache
+    {
+        CPL_DISALLOW_COPY_ASSIGN(CPLConfigOptionCache)
+
+      public:
+        CPLConfigOptionCache(const char *pszKey, const char *pszDefault);
+        ~CPLConfigOptionCache();
+
+        const char *Get();
+
+      private:
+        const std::string m_osKey;
+        const std::string m_osDefault;
+        const bool m_bHasDefault;
+        std::atomic<GUIntBig> m_nGeneration{0};
+        std::atomic<const char *> m_pszValue{nullptr};
+        struct _CPLMutex *m_hMutex = nullptr;
+    };
+}
+
+#endif /* def __cplusplus */
+
+#if defined(__cplusplus) && !defined(CPL_SUPRESS_CPLUSPLUS)
+
 extern "C++"
 {
 
@@ -285,19 +285,43 @@ static char **CSVSplitLine(const char *pszString, const char *pszDelimiter,
         return static_cast<char **>(CPLCalloc(sizeof(char *), 1));
 
     char *pszToken = static_cast<char *>(CPLCalloc(10, 1));
-    int nTokenMax = 10;
+    size_t nTokenMax = 10;
     const size_t nDelimiterLength = strlen(pszDelimiter);
 
+    // Characters that may have a special meaning outside of a quoted string.
+    // Runs of other characters are copied at once.
+    const char achStopChars[] = {'"', pszDelimiter[0], '\0'};
+
     const char *pszIter = pszString;
     while (*pszIter != '\0')
     {
         bool bInString = false;
 
-        int nTokenLen = 0;
+        size_t nTokenLen = 0;
+        const auto AppendToToken = [&pszToken, &nTokenMax,
+                                    &nTokenLen](const char *pszSrc, size_t nLen)
+        {
+            if (nTokenLen + nLen + 2 > nTokenMax)
+            {
+                nTokenMax = std::max(nTokenMax * 2 + 10, nTokenLen + nLen + 2);
+                pszToken = static_cast<char *>(CPLRealloc(pszToken, nTokenMax));
+            }
+            memcpy(pszToken + nTokenLen, pszSrc, nLen);
+            nTokenLen += nLen;
+        };
 
         // Try to find the next delimiter, marking end of token.
-        do
+        while (*pszIter != '\0')
         {
+            const size_t nRunLen = bInString ? strcspn(pszIter, "\"")
+                                             : strcspn(pszIter, achStopChars);
+            if (nRunLen > 0)
+            {
+                AppendToToken(pszIter, nRunLen);
+                pszIter += nRunLen;
+                continue;
+            }
+
             // End if this is a delimiter skip it and break.
             if (!bInString &&
                 strncmp(pszIter, pszDelimiter, nDelimiterLength) == 0)
@@ -324,7 +348,10 @@ static char **CSVSplitLine(const char *pszString, const char *pszDelimiter,
                 {
                     bInString = !bInString;
                     if (!bKeepLeadingAndClosingQuotes)
+                    {
+                        ++pszIter;
                         continue;
+                    }
                 }
                 else  // Doubled quotes in string resolve to one quote.
                 {
@@ -332,15 +359,11 @@ static char **CSVSplitLine(const char *pszString, const char *pszDelimiter,
                 }
             }
 
-            if (nTokenLen >= nTokenMax - 2)
-            {
-                nTokenMax = nTokenMax * 2 + 10;
-                pszToken = static_cast<char *>(CPLRealloc(pszToken, nTokenMax));
-            }
-
-            pszToken[nTokenLen] = *pszIter;
-            nTokenLen++;
-        } while (*(++pszIter) != '\0');
+            // Either a quote, or the first character of a multi-byte
+            // delimiter not followed by the rest of it.
+            AppendToToken(pszIter, 1);
+            ++pszIter;
+        }
 
         pszToken[nTokenLen] = '\0';
         aosRetList.AddString(pszToken);
@@ -674,10 +697,17 @@ CSVReadParseLineGeneric(void *fp, const char *(*pfnReadLine)(void *, size_t),
 
         while (true)
         {
-            for (; i < osWorkLine.size(); i++)
+            while (i < osWorkLine.size())
             {
-                if (osWorkLine[i] == '\"')
-                    nCount++;
+                const void *pQuote = memchr(osWorkLine.data() + i, '\"',
+                                            osWorkLine.size() - i);
+                if (pQuote == nullptr)
+                {
+                    i = osWorkLine.size();
+                    break;
+                }
+                nCount++;
+                i = static_cast<const char *>(pQuote) - osWorkLine.data() + 1;
             }
 
             if (nCount % 2 == 0)
@@ -43,6 +43,7 @@
 #include "cpl_http.h"
 #include "cpl_error.h"
 #include "cpl_multiproc.h"
+#include "cpl_trace.h"
 
 // gcc or clang complains about C-style cast in #define like
 // CURL_ZERO_TERMINATED
@@ -330,6 +331,107 @@ static void CheckCurlFeatures()
     }
 }
 
+/************************************************************************/
+/*                        CPLHTTPGetShareHandle()                       */
+/************************************************************************/
+
+// Process-wide curl share object, so that DNS entries, TLS sessions and
+// live connections are reused by all easy handles, whatever the multi handle
+// they are attached to: /vsicurl/ uses one per thread and file system
+// handler, and AdviseRead() or CPLHTTPMultiFetch() create temporary ones.
+// Without it, each of them would go through its own TCP and TLS handshakes
+// against the same server.
+
+static CURLSH *hShareHandle = nullptr;
+static CPLMutex *ahShareMutex[CURL_LOCK_DATA_LAST] = {};
+
+static void CPLHTTPShareLock(CURL * /* handle */, curl_lock_data data,
+                             curl_lock_access /* access */,
+                             void * /* userptr */)
+{
+    const int i = static_cast<int>(data);
+    if (i >= 0 && i < CURL_LOCK_DATA_LAST)
+        CPLCreateOrAcquireMutex(&ahShareMutex[i], 1000.0);
+}
+
+static void CPLHTTPShareUnlock(CURL * /* handle */, curl_lock_data data,
+                               void * /* userptr */)
+{
+    const int i = static_cast<int>(data);
+    if (i >= 0 && i < CURL_LOCK_DATA_LAST && ahShareMutex[i])
+        CPLReleaseMutex(ahShareMutex[i]);
+}
+
+static CURLSH *CPLHTTPGetShareHandle()
+{
+    if (!CPLTestBool(CPLGetConfigOption("GDAL_HTTP_CONNECTION_POOL", "YES")))
+        return nullptr;
+
+    CPLMutexHolder oHolder(&hSessionMapMutex);
+    if (hShareHandle == nullptr)
+    {
+        hShareHandle = curl_share_init();
+        if (hShareHandle == nullptr)
+            return nullptr;
+        curl_share_setopt(hShareHandle, CURLSHOPT_LOCKFUNC, CPLHTTPShareLock);
+        curl_share_setopt(hShareHandle, CURLSHOPT_UNLOCKFUNC,
+                          CPLHTTPShareUnlock);
+        curl_share_setopt(hShareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(hShareHandle, CURLSHOPT_SHARE,
+                          CURL_LOCK_DATA_SSL_SESSION);
+        curl_share_setopt(hShareHandle, CURLSHOPT_SHARE,
+                          CURL_LOCK_DATA_CONNECT);
+    }
+    return hShareHandle;
+}
+
+/************************************************************************/
+/*                       CPLHTTPCreateMultiHandle()                     */
+/************************************************************************/
+
+/** Create a curl multi handle, configured for HTTP/2 multiplexing and with
+ * the connection limits set with the GDAL_HTTP_MAX_HOST_CONNECTIONS and
+ * GDAL_HTTP_MAX_CONCURRENT_STREAMS configuration options.
+ */
+void *CPLHTTPCreateMultiHandle()
+{
+    CURLM *hCurlMultiHandle = curl_multi_init();
+    if (hCurlMultiHandle == nullptr)
+        return nullptr;
+
+#ifdef CURLPIPE_MULTIPLEX
+    // Enable HTTP/2 multiplexing (ignored if an older version of HTTP is
+    // used)
+    // Not that this does not enable HTTP/1.1 pipeling, which is not
+    // recommended for example by Google Cloud Storage.
+    // For HTTP/1.1, parallel connections work better since you can get
+    // results out of order.
+    if (CPLTestBool(CPLGetConfigOption("GDAL_HTTP_MULTIPLEX", "YES")))
+    {
+        curl_multi_setopt(hCurlMultiHandle, CURLMOPT_PIPELINING,
+                          CURLPIPE_MULTIPLEX);
+    }
+#endif
+
+    const char *pszMaxHostConnections =
+        CPLGetConfigOption("GDAL_HTTP_MAX_HOST_CONNECTIONS", nullptr);
+    if (pszMaxHostConnections)
+    {
+        curl_multi_setopt(hCurlMultiHandle, CURLMOPT_MAX_HOST_CONNECTIONS,
+                          static_cast<long>(atoi(pszMaxHostConnections)));
+    }
+
+    const char *pszMaxConcurrentStreams =
+        CPLGetConfigOption("GDAL_HTTP_MAX_CONCURRENT_STREAMS", nullptr);
+    if (pszMaxConcurrentStreams)
+    {
+        curl_multi_setopt(hCurlMultiHandle, CURLMOPT_MAX_CONCURRENT_STREAMS,
+                          static_cast<long>(atoi(pszMaxConcurrentStreams)));
+    }
+
+    return hCurlMultiHandle;
+}
+
 /************************************************************************/
 /*                            CPLWriteFct()                             */
 /*                                                                      */
@@ -1069,6 +1171,14 @@ CPLHTTPResult *CPLHTTPFetchEx(const char *pszURL, CSLConstList papszOptions,
                               CPLHTTPFetchWriteFunc pfnWrite, void *pWriteArg)
 
 {
+    CPLTraceSpan oSpan("http", "CPLHTTPFetch");
+    if (oSpan.IsEnabled())
+    {
+        // Do not record the query string, which may contain credentials
+        const std::string osURL(pszURL);
+        oSpan.AddArg("url", osURL.substr(0, osURL.find('?')).c_str());
+    }
+
     if (STARTS_WITH(pszURL, "/vsimem/") &&
         // Disabled by default for potential security issues.
         CPLTestBool(CPLGetConfigOption("CPL_CURL_ENABLE_VSIMEM", "FALSE")))
@@ -1607,7 +1717,8 @@ CPLHTTPResult **CPLHTTPMultiFetch(const char *const *papszURL, int nURLCount,
             poSessionMultiMap = new std::map<CPLString, CURLM *>;
         if (poSessionMultiMap->count(osSessionName) == 0)
         {
-            (*poSessionMultiMap)[osSessionName] = curl_multi_init();
+            (*poSessionMultiMap)[osSessionName] =
+                static_cast<CURLM *>(CPLHTTPCreateMultiHandle());
             CPLDebug("HTTP", "Establish persistent session named '%s'.",
                      osSessionName.c_str());
         }
@@ -1649,7 +1760,7 @@ CPLHTTPResult **CPLHTTPMultiFetch(const char *const *papszURL, int nURLCount,
     }
     else
     {
-        hCurlMultiHandle = curl_multi_init();
+        hCurlMultiHandle = static_cast<CURLM *>(CPLHTTPCreateMultiHandle());
     }
 
     CPLHTTPResult **papsResults = static_cast<CPLHTTPResult **>(
@@ -1926,6 +2037,10 @@ void *CPLHTTPSetOptions(void *pcurl, const char *pszURL,
 
     unchecked_curl_easy_setopt(http_handle, CURLOPT_URL, pszURL);
 
+    CURLSH *hShare = CPLHTTPGetShareHandle();
+    if (hShare)
+        unchecked_curl_easy_setopt(http_handle, CURLOPT_SHARE, hShare);
+
     if (CPLTestBool(CPLGetConfigOption("CPL_CURL_VERBOSE", "NO")))
     {
         unchecked_curl_easy_setopt(http_handle, CURLOPT_VERBOSE, 1);
@@ -2561,6 +2676,19 @@ void CPLHTTPCleanup()
         }
     }
 
+    // Fails with CURLSHE_IN_USE if easy handles are still attached to it,
+    // in which case we let it leak.
+    if (hShareHandle && curl_share_cleanup(hShareHandle) == CURLSHE_OK)
+    {
+        hShareHandle = nullptr;
+        for (auto &hMutex : ahShareMutex)
+        {
+            if (hMutex)
+                CPLDestroyMutex(hMutex);
+            hMutex = nullptr;
+        }
+    }
+
     // Not quite a safe sequence.
     CPLDestroyMutex(hSessionMapMutex);
     hSessionMapMutex = nullptr;
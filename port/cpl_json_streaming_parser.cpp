@@ -30,6 +30,7 @@
 
 #include <assert.h>
 #include <ctype.h>   // isdigit...
+#include <algorithm>
 #include <stdio.h>   // snprintf
 #include <string.h>  // strlen
 #include <vector>
@@ -117,6 +118,23 @@ void CPLJSonStreamingParser::AdvanceChar(const char *&pStr, size_t &nLength)
     m_nCharCounter++;
 }
 
+/************************************************************************/
+/*                             AdvanceChars()                           */
+/************************************************************************/
+
+// Same as calling AdvanceChar() nCount times, for characters that are known
+// not to be line terminators.
+void CPLJSonStreamingParser::AdvanceChars(const char *&pStr, size_t &nLength,
+                                          size_t nCount)
+{
+    if (nCount == 0)
+        return;
+    m_nLastChar = pStr[nCount - 1];
+    pStr += nCount;
+    nLength -= nCount;
+    m_nCharCounter += static_cast<int>(nCount);
+}
+
 /************************************************************************/
 /*                               SkipSpace()                            */
 /************************************************************************/
@@ -174,6 +192,16 @@ static bool IsValidNewToken(char ch)
            ch == 'n' || ch == 'i' || ch == 'I' || ch == 'N';
 }
 
+/************************************************************************/
+/*                             IsNumberChar()                           */
+/************************************************************************/
+
+static bool IsNumberChar(char ch)
+{
+    return ch == '+' || ch == '-' || isdigit(static_cast<unsigned char>(ch)) ||
+           ch == '.' || ch == 'e' || ch == 'E';
+}
+
 /************************************************************************/
 /*                             StartNewToken()                          */
 /************************************************************************/
@@ -457,19 +485,25 @@ bool CPLJSonStreamingParser::Parse(const char *pStr, size_t nLength,
         {
             while (nLength)
             {
-                char ch = *pStr;
-                if (ch == '+' || ch == '-' ||
-                    isdigit(static_cast<unsigned char>(ch)) || ch == '.' ||
-                    ch == 'e' || ch == 'E')
+                // Consume at once the run of characters of the number
+                size_t nRunLen = 0;
+                while (nRunLen < nLength && IsNumberChar(pStr[nRunLen]))
+                    ++nRunLen;
+                if (nRunLen > 0)
                 {
-                    if (m_osToken.size() == 1024)
+                    if (m_osToken.size() + nRunLen > 1024)
                     {
+                        AdvanceChars(pStr, nLength, 1024 - m_osToken.size());
                         return EmitException("Too many characters in number");
                     }
-                    m_osToken += ch;
+                    m_osToken.append(pStr, nRunLen);
+                    AdvanceChars(pStr, nLength, nRunLen);
+                    continue;
                 }
-                else if (isspace(static_cast<unsigned char>(ch)) || ch == ',' ||
-                         ch == '}' || ch == ']')
+
+                char ch = *pStr;
+                if (isspace(static_cast<unsigned char>(ch)) || ch == ',' ||
+                    ch == '}' || ch == ']')
                 {
                     SkipSpace(pStr, nLength);
                     break;
@@ -549,6 +583,29 @@ bool CPLJSonStreamingParser::Parse(const char *pStr, size_t nLength,
                     return EmitException("Too many characters in number");
                 }
 
+                if (!m_bInUnicode && !m_bInStringEscape)
+                {
+                    // Consume at once the run of characters that need no
+                    // special processing.
+                    const size_t nMaxRunLen =
+                        std::min(nLength, m_nMaxStringSize - m_osToken.size());
+                    size_t nRunLen = 0;
+                    while (nRunLen < nMaxRunLen)
+                    {
+                        const char chRun = pStr[nRunLen];
+                        if (chRun == '"' || chRun == '\\' || chRun == 13 ||
+                            chRun == 10)
+                            break;
+                        ++nRunLen;
+                    }
+                    if (nRunLen > 0)
+                    {
+                        m_osToken.append(pStr, nRunLen);
+                        AdvanceChars(pStr, nLength, nRunLen);
+                        continue;
+                    }
+                }
+
                 char ch = *pStr;
                 if (m_bInUnicode)
                 {
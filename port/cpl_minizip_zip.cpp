@@ -48,7 +48,11 @@
 #include "cpl_minizip_zip.h"
 
 #include <algorithm>
+#include <condition_variable>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
 
 #include <cassert>
 #include <cstddef>
@@ -61,10 +65,12 @@
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_minizip_unzip.h"
 #include "cpl_string.h"
 #include "cpl_time.h"
 #include "cpl_vsi_virtual.h"
+#include "cpl_worker_thread_pool.h"
 
 #ifdef NO_ERRNO_H
 extern int errno;
@@ -2068,12 +2074,14 @@ void *CPLCreateZip(const char *pszZipFilename, char **papszOptions)
 }
 
 /************************************************************************/
-/*                         CPLCreateFileInZip()                         */
+/*                     CPLCreateFileInZipInternal()                     */
 /************************************************************************/
 
-/** Create a file in a ZIP file */
-CPLErr CPLCreateFileInZip(void *hZip, const char *pszFilename,
-                          char **papszOptions)
+// If bRaw is true, the data written with CPLWriteFileInZip() must be already
+// deflated (when COMPRESSED=YES), and the file must be closed with
+// cpl_zipCloseFileInZipRaw().
+static CPLErr CPLCreateFileInZipInternal(void *hZip, const char *pszFilename,
+                                         CSLConstList papszOptions, bool bRaw)
 
 {
     if (hZip == nullptr)
@@ -2224,7 +2232,7 @@ CPLErr CPLCreateFileInZip(void *hZip, const char *pszFilename,
         abyExtra.empty() ? nullptr : abyExtra.data(),
         static_cast<uInt>(abyExtra.size()), "", bCompressed ? Z_DEFLATED : 0,
         bCompressed ? Z_DEFAULT_COMPRESSION : 0,
-        /* raw = */ 0, -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY,
+        /* raw = */ bRaw ? 1 : 0, -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY,
         /* password = */ nullptr,
         /* crcForCtypting = */ 0, bZip64, bIncludeInCentralDirectory);
 
@@ -2240,6 +2248,19 @@ CPLErr CPLCreateFileInZip(void *hZip, const char *pszFilename,
     return CE_None;
 }
 
+/************************************************************************/
+/*                         CPLCreateFileInZip()                         */
+/************************************************************************/
+
+/** Create a file in a ZIP file */
+CPLErr CPLCreateFileInZip(void *hZip, const char *pszFilename,
+                          char **papszOptions)
+
+{
+    return CPLCreateFileInZipInternal(hZip, pszFilename, papszOptions,
+                                      /* bRaw = */ false);
+}
+
 /************************************************************************/
 /*                         CPLWriteFileInZip()                          */
 /************************************************************************/
@@ -2283,6 +2304,76 @@ CPLErr CPLCloseFileInZip(void *hZip)
     return CE_None;
 }
 
+/************************************************************************/
+/*                        CPLZipGetNumThreads()                         */
+/************************************************************************/
+
+// Files larger than that are compressed by chunks in parallel by
+// CPLAddFileInZip(), even when not SOZip-enabled.
+constexpr uint64_t CPL_ZIP_MT_MIN_FILE_SIZE = 1024 * 1024;
+
+static int CPLZipGetNumThreads(CSLConstList papszOptions)
+{
+    const char *pszThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    int nThreads;
+    if (pszThreads == nullptr || EQUAL(pszThreads, "ALL_CPUS"))
+        nThreads = CPLGetNumCPUs();
+    else
+        nThreads = atoi(pszThreads);
+    return std::max(1, std::min(128, nThreads));
+}
+
+/************************************************************************/
+/*                      CPLZipGetSOZipChunkSize()                       */
+/************************************************************************/
+
+// Returns the SOZip chunk size to use for a file of nUncompressedSize bytes,
+// or 0 if it must not be SOZip-enabled.
+static unsigned CPLZipGetSOZipChunkSize(CSLConstList papszOptions,
+                                        uint64_t nUncompressedSize)
+{
+    const char *pszSOZIP =
+        CSLFetchNameValueDef(papszOptions, "SOZIP_ENABLED",
+                             CPLGetConfigOption("CPL_SOZIP_ENABLED", "AUTO"));
+
+    const char *pszChunkSize = CSLFetchNameValueDef(
+        papszOptions, "SOZIP_CHUNK_SIZE",
+        CPLGetConfigOption("CPL_VSIL_DEFLATE_CHUNK_SIZE", nullptr));
+    const bool bChunkSizeSpecified = pszChunkSize != nullptr;
+    if (!pszChunkSize)
+        pszChunkSize = "1024K";
+    unsigned nChunkSize = static_cast<unsigned>(atoi(pszChunkSize));
+    if (strchr(pszChunkSize, 'K'))
+        nChunkSize *= 1024;
+    else if (strchr(pszChunkSize, 'M'))
+        nChunkSize *= 1024 * 1024;
+    nChunkSize =
+        std::max(static_cast<unsigned>(1),
+                 std::min(static_cast<unsigned>(UINT_MAX), nChunkSize));
+
+    const char *pszMinFileSize = CSLFetchNameValueDef(
+        papszOptions, "SOZIP_MIN_FILE_SIZE",
+        CPLGetConfigOption("CPL_SOZIP_MIN_FILE_SIZE", "1M"));
+    uint64_t nSOZipMinFileSize = std::strtoull(pszMinFileSize, nullptr, 10);
+    if (strchr(pszMinFileSize, 'K'))
+        nSOZipMinFileSize *= 1024;
+    else if (strchr(pszMinFileSize, 'M'))
+        nSOZipMinFileSize *= 1024 * 1024;
+    else if (strchr(pszMinFileSize, 'G'))
+        nSOZipMinFileSize *= 1024 * 1024 * 1024;
+
+    constexpr unsigned nDefaultSOZipChunkSize = 32 * 1024;
+    if (((EQUAL(pszSOZIP, "AUTO") && nUncompressedSize > nSOZipMinFileSize) ||
+         (!EQUAL(pszSOZIP, "AUTO") && CPLTestBool(pszSOZIP))) &&
+        ((bChunkSizeSpecified &&
+          nUncompressedSize > static_cast<unsigned>(nChunkSize)) ||
+         (!bChunkSizeSpecified && nUncompressedSize > nDefaultSOZipChunkSize)))
+    {
+        return bChunkSizeSpecified ? nChunkSize : nDefaultSOZipChunkSize;
+    }
+    return 0;
+}
+
 /************************************************************************/
 /*                         CPLAddFileInZip()                            */
 /************************************************************************/
@@ -2306,8 +2397,8 @@ CPLErr CPLCloseFileInZip(void *hZip)
  * <li>SOZIP_MIN_FILE_SIZE: minimum file size to consider to enable SOZip index
  * generation in SOZIP_ENABLED=AUTO mode. Defaults to 1 MB.
  * </li>
- * <li>NUM_THREADS: number of threads used for SOZip generation. Defaults to
- * ALL_CPUS.</li>
+ * <li>NUM_THREADS: number of threads used for SOZip generation, and for the
+ * compression of other files larger than 1 MB. Defaults to ALL_CPUS.</li>
  * <li>TIMESTAMP=AUTO/NOW/timestamp_as_epoch_since_jan_1_1970: in AUTO mode,
  * the timestamp of pszInputFilename will be used (if available), otherwise
  * it will fallback to NOW.</li>
@@ -2354,52 +2445,14 @@ CPLErr CPLAddFileInZip(void *hZip, const char *pszArchiveFilename,
     VSIFSeekL(fpInput, 0, SEEK_SET);
 
     CPLStringList aosNewsOptions(papszOptions);
-    bool bSeekOptimized = false;
-    const char *pszSOZIP =
-        CSLFetchNameValueDef(papszOptions, "SOZIP_ENABLED",
-                             CPLGetConfigOption("CPL_SOZIP_ENABLED", "AUTO"));
-
-    const char *pszChunkSize = CSLFetchNameValueDef(
-        papszOptions, "SOZIP_CHUNK_SIZE",
-        CPLGetConfigOption("CPL_VSIL_DEFLATE_CHUNK_SIZE", nullptr));
-    const bool bChunkSizeSpecified = pszChunkSize != nullptr;
-    if (!pszChunkSize)
-        pszChunkSize = "1024K";
-    unsigned nChunkSize = static_cast<unsigned>(atoi(pszChunkSize));
-    if (strchr(pszChunkSize, 'K'))
-        nChunkSize *= 1024;
-    else if (strchr(pszChunkSize, 'M'))
-        nChunkSize *= 1024 * 1024;
-    nChunkSize =
-        std::max(static_cast<unsigned>(1),
-                 std::min(static_cast<unsigned>(UINT_MAX), nChunkSize));
-
-    const char *pszMinFileSize = CSLFetchNameValueDef(
-        papszOptions, "SOZIP_MIN_FILE_SIZE",
-        CPLGetConfigOption("CPL_SOZIP_MIN_FILE_SIZE", "1M"));
-    uint64_t nSOZipMinFileSize = std::strtoull(pszMinFileSize, nullptr, 10);
-    if (strchr(pszMinFileSize, 'K'))
-        nSOZipMinFileSize *= 1024;
-    else if (strchr(pszMinFileSize, 'M'))
-        nSOZipMinFileSize *= 1024 * 1024;
-    else if (strchr(pszMinFileSize, 'G'))
-        nSOZipMinFileSize *= 1024 * 1024 * 1024;
-
+    const unsigned nChunkSize =
+        CPLZipGetSOZipChunkSize(papszOptions, nUncompressedSize);
+    const bool bSeekOptimized = nChunkSize != 0;
     std::vector<uint8_t> sozip_index;
     uint64_t nExpectedIndexSize = 0;
-    constexpr unsigned nDefaultSOZipChunkSize = 32 * 1024;
     constexpr size_t nOffsetSize = 8;
-    if (((EQUAL(pszSOZIP, "AUTO") && nUncompressedSize > nSOZipMinFileSize) ||
-         (!EQUAL(pszSOZIP, "AUTO") && CPLTestBool(pszSOZIP))) &&
-        ((bChunkSizeSpecified &&
-          nUncompressedSize > static_cast<unsigned>(nChunkSize)) ||
-         (!bChunkSizeSpecified && nUncompressedSize > nDefaultSOZipChunkSize)))
+    if (bSeekOptimized)
     {
-        if (!bChunkSizeSpecified)
-            nChunkSize = nDefaultSOZipChunkSize;
-
-        bSeekOptimized = true;
-
         aosNewsOptions.SetNameValue(
             "UNCOMPRESSED_SIZE", CPLSPrintf(CPL_FRMT_GUIB, nUncompressedSize));
 
@@ -2444,13 +2497,12 @@ CPLErr CPLAddFileInZip(void *hZip, const char *pszArchiveFilename,
         zi->sozip_index = &sozip_index;
 
         zi->nChunkSize = nChunkSize;
-
-        const char *pszThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
-        if (pszThreads == nullptr || EQUAL(pszThreads, "ALL_CPUS"))
-            zi->nThreads = CPLGetNumCPUs();
-        else
-            zi->nThreads = atoi(pszThreads);
-        zi->nThreads = std::max(1, std::min(128, zi->nThreads));
+        zi->nThreads = CPLZipGetNumThreads(papszOptions);
+    }
+    else if (nUncompressedSize > CPL_ZIP_MT_MIN_FILE_SIZE)
+    {
+        // Compress independent chunks of the file in parallel
+        zi->nThreads = CPLZipGetNumThreads(papszOptions);
     }
 
     aosNewsOptions.SetNameValue("ZIP64",
@@ -2573,6 +2625,282 @@ CPLErr CPLAddFileInZip(void *hZip, const char *pszArchiveFilename,
     return CE_None;
 }
 
+/************************************************************************/
+/*                         CPLAddFilesInZip()                           */
+/************************************************************************/
+
+namespace
+{
+// Compression in a worker thread of a whole file added by CPLAddFilesInZip()
+struct CPLZipCompressJob
+{
+    std::string osInputFilename{};
+    std::vector<GByte> abyCompressed{};
+    uLong nCRC = 0;
+    uint64_t nUncompressedSize = 0;
+    bool bOK = false;
+    bool bDone = false;
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+    std::mutex *pMutex = nullptr;
+    std::condition_variable *pCV = nullptr;
+
+    static void Run(void *pData);
+};
+
+struct CPLZipScaledProgress
+{
+    GDALProgressFunc pfnProgress = nullptr;
+    void *pProgressData = nullptr;
+    double dfMin = 0;
+    double dfMax = 0;
+
+    static int CPL_STDCALL Func(double dfComplete, const char *pszMessage,
+                                void *pData)
+    {
+        const auto psThis = static_cast<const CPLZipScaledProgress *>(pData);
+        return psThis->pfnProgress(psThis->dfMin + dfComplete * (psThis->dfMax -
+                                                                 psThis->dfMin),
+                                   pszMessage, psThis->pProgressData);
+    }
+};
+}  // namespace
+
+void CPLZipCompressJob::Run(void *pData)
+{
+    auto psJob = static_cast<CPLZipCompressJob *>(pData);
+    CPLInstallErrorHandlerAccumulator(psJob->aoErrors);
+
+    GByte *pabyContent = nullptr;
+    vsi_l_offset nSize = 0;
+    if (VSIIngestFile(nullptr, psJob->osInputFilename.c_str(), &pabyContent,
+                      &nSize, -1))
+    {
+        z_stream sStream;
+        memset(&sStream, 0, sizeof(sStream));
+        if (deflateInit2(&sStream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                         -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY) == Z_OK)
+        {
+            const uLong nBound =
+                deflateBound(&sStream, static_cast<uLong>(nSize));
+            try
+            {
+                psJob->abyCompressed.resize(nBound);
+                sStream.next_in = pabyContent;
+                sStream.avail_in = static_cast<uInt>(nSize);
+                sStream.next_out = psJob->abyCompressed.data();
+                sStream.avail_out = static_cast<uInt>(nBound);
+                if (deflate(&sStream, Z_FINISH) == Z_STREAM_END)
+                {
+                    psJob->abyCompressed.resize(sStream.total_out);
+                    psJob->nCRC =
+                        crc32(0, pabyContent, static_cast<uInt>(nSize));
+                    psJob->nUncompressedSize = nSize;
+                    psJob->bOK = true;
+                }
+                else
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "Compression of %s failed",
+                             psJob->osInputFilename.c_str());
+                }
+            }
+            catch (const std::exception &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Cannot allocate compression buffer for %s",
+                         psJob->osInputFilename.c_str());
+            }
+            deflateEnd(&sStream);
+        }
+        VSIFree(pabyContent);
+    }
+
+    CPLUninstallErrorHandlerAccumulator();
+
+    std::lock_guard<std::mutex> oLock(*(psJob->pMutex));
+    psJob->bDone = true;
+    psJob->pCV->notify_all();
+}
+
+/** Add several files inside a ZIP file opened/created with CPLCreateZip().
+ *
+ * This is equivalent to calling CPLAddFileInZip() for each file, in order,
+ * but files that are not large enough to be SOZip-enabled are read and
+ * compressed concurrently by worker threads, while the main thread writes
+ * them to the archive. Entries are written in the order of
+ * papszArchiveFilenames, and the resulting archive does not depend on the
+ * number of threads. This is mostly useful for archives made of many small
+ * files.
+ *
+ * Supported options are the ones of CPLAddFileInZip(). NUM_THREADS is also
+ * used to compress files concurrently.
+ *
+ * @param hZip ZIP file handle
+ * @param nFileCount Number of files to add.
+ * @param papszArchiveFilenames Array of nFileCount filenames (in UTF-8)
+ * stored in the archive.
+ * @param papszInputFilenames Array of nFileCount filenames of the files to
+ * add.
+ * @param papszOptions Options.
+ * @param pProgressFunc Progress callback, or NULL.
+ * @param pProgressData User data of progress callback, or NULL.
+ * @return CE_None in case of success.
+ *
+ * @since GDAL 3.9
+ */
+CPLErr CPLAddFilesInZip(void *hZip, int nFileCount,
+                        const char *const *papszArchiveFilenames,
+                        const char *const *papszInputFilenames,
+                        CSLConstList papszOptions,
+                        GDALProgressFunc pProgressFunc, void *pProgressData)
+{
+    if (!hZip || nFileCount < 0 ||
+        (nFileCount > 0 && (!papszArchiveFilenames || !papszInputFilenames)))
+        return CE_Failure;
+
+    CPLZip *psZip = static_cast<CPLZip *>(hZip);
+
+    // Larger files are compressed by chunks by CPLAddFileInZip()
+    constexpr uint64_t MAX_FILE_SIZE_COMPRESSED_IN_MEMORY = 8 * 1024 * 1024;
+    // Maximum cumulated size of the files being compressed concurrently
+    constexpr uint64_t MAX_BYTES_IN_FLIGHT = 256 * 1024 * 1024;
+
+    const bool bCompressed =
+        CPLTestBool(CSLFetchNameValueDef(papszOptions, "COMPRESSED", "TRUE"));
+    const int nThreads = CPLZipGetNumThreads(papszOptions);
+
+    std::vector<uint64_t> anFileSizes(nFileCount);
+    std::vector<GIntBig> anMTimes(nFileCount);
+    std::vector<bool> abCompressInWorker(nFileCount);
+    uint64_t nTotalSize = 0;
+    for (int i = 0; i < nFileCount; ++i)
+    {
+        VSIStatBufL sStat;
+        if (VSIStatL(papszInputFilenames[i], &sStat) == 0)
+        {
+            anFileSizes[i] = static_cast<uint64_t>(sStat.st_size);
+            anMTimes[i] = static_cast<GIntBig>(sStat.st_mtime);
+            abCompressInWorker[i] =
+                nThreads > 1 && bCompressed &&
+                anFileSizes[i] <= MAX_FILE_SIZE_COMPRESSED_IN_MEMORY &&
+                CPLZipGetSOZipChunkSize(papszOptions, anFileSizes[i]) == 0;
+        }
+        nTotalSize += anFileSizes[i];
+    }
+
+    // Declared before poPool, so that jobs outlive it
+    std::mutex oMutex;
+    std::condition_variable oCV;
+    std::vector<std::unique_ptr<CPLZipCompressJob>> apoJobs(nFileCount);
+    std::unique_ptr<CPLWorkerThreadPool> poPool;
+    if (std::find(abCompressInWorker.begin(), abCompressInWorker.end(),
+                  true) != abCompressInWorker.end())
+    {
+        poPool = std::make_unique<CPLWorkerThreadPool>();
+        if (!poPool->Setup(nThreads, nullptr, nullptr, false))
+            poPool.reset();
+    }
+
+    int iNextToSubmit = 0;
+    uint64_t nBytesInFlight = 0;
+    uint64_t nBytesDone = 0;
+    for (int i = 0; i < nFileCount; ++i)
+    {
+        // Keep the worker threads busy with the next files
+        while (poPool && iNextToSubmit < nFileCount &&
+               iNextToSubmit < i + 2 * nThreads)
+        {
+            if (abCompressInWorker[iNextToSubmit])
+            {
+                if (nBytesInFlight > 0 &&
+                    nBytesInFlight + anFileSizes[iNextToSubmit] >
+                        MAX_BYTES_IN_FLIGHT)
+                    break;
+                nBytesInFlight += anFileSizes[iNextToSubmit];
+                auto poJob = std::make_unique<CPLZipCompressJob>();
+                poJob->osInputFilename = papszInputFilenames[iNextToSubmit];
+                poJob->pMutex = &oMutex;
+                poJob->pCV = &oCV;
+                if (!poPool->SubmitJob(CPLZipCompressJob::Run, poJob.get()))
+                    return CE_Failure;
+                apoJobs[iNextToSubmit] = std::move(poJob);
+            }
+            ++iNextToSubmit;
+        }
+
+        const double dfMin =
+            nTotalSize == 0 ? double(i) / nFileCount
+                            : double(nBytesDone) / double(nTotalSize);
+        nBytesDone += anFileSizes[i];
+        const double dfMax =
+            nTotalSize == 0 ? double(i + 1) / nFileCount
+                            : double(nBytesDone) / double(nTotalSize);
+
+        if (!apoJobs[i])
+        {
+            CPLZipScaledProgress sProgress;
+            sProgress.pfnProgress = pProgressFunc;
+            sProgress.pProgressData = pProgressData;
+            sProgress.dfMin = dfMin;
+            sProgress.dfMax = dfMax;
+            if (CPLAddFileInZip(
+                    hZip, papszArchiveFilenames[i], papszInputFilenames[i],
+                    nullptr, papszOptions,
+                    pProgressFunc ? CPLZipScaledProgress::Func : nullptr,
+                    &sProgress) != CE_None)
+            {
+                return CE_Failure;
+            }
+            continue;
+        }
+
+        auto &poJob = apoJobs[i];
+        {
+            std::unique_lock<std::mutex> oLock(oMutex);
+            oCV.wait(oLock, [&poJob] { return poJob->bDone; });
+        }
+        nBytesInFlight -= anFileSizes[i];
+        for (const auto &oError : poJob->aoErrors)
+        {
+            CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+        }
+        if (!poJob->bOK)
+            return CE_Failure;
+
+        CPLStringList aosNewOptions(papszOptions);
+        aosNewOptions.SetNameValue("ZIP64", "NO");
+        if (aosNewOptions.FetchNameValue("TIMESTAMP") == nullptr &&
+            anMTimes[i] != 0)
+        {
+            aosNewOptions.SetNameValue("TIMESTAMP",
+                                       CPLSPrintf(CPL_FRMT_GIB, anMTimes[i]));
+        }
+        if (CPLCreateFileInZipInternal(hZip, papszArchiveFilenames[i],
+                                       aosNewOptions.List(),
+                                       /* bRaw = */ true) != CE_None)
+        {
+            return CE_Failure;
+        }
+        const bool bWriteOK =
+            poJob->abyCompressed.empty() ||
+            CPLWriteFileInZip(hZip, poJob->abyCompressed.data(),
+                              static_cast<int>(poJob->abyCompressed.size())) ==
+                CE_None;
+        if (cpl_zipCloseFileInZipRaw(psZip->hZip, poJob->nUncompressedSize,
+                                     poJob->nCRC) != ZIP_OK ||
+            !bWriteOK)
+        {
+            return CE_Failure;
+        }
+        poJob.reset();
+
+        if (pProgressFunc && !pProgressFunc(dfMax, nullptr, pProgressData))
+            return CE_Failure;
+    }
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                            CPLCloseZip()                             */
 /************************************************************************/
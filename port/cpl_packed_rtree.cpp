@@ -0,0 +1,354 @@
+/******************************************************************************
+ *
+ * Project:  CPL - Common Portability Library
+ * Purpose:  Static, bulk-loaded, packed Hilbert R-tree
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_packed_rtree.h"
+
+#include "cpl_error.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+/************************************************************************/
+/*                           HilbertIndex()                             */
+/************************************************************************/
+
+// Distance along the Hilbert curve of order 16 of the cell (x, y), with
+// x and y in [0, 65535].
+static uint32_t HilbertIndex(uint32_t x, uint32_t y)
+{
+    constexpr uint32_t N = 1U << 16;
+    uint32_t d = 0;
+    for (uint32_t s = N / 2; s > 0; s /= 2)
+    {
+        const uint32_t rx = (x & s) != 0 ? 1 : 0;
+        const uint32_t ry = (y & s) != 0 ? 1 : 0;
+        d += s * s * ((3 * rx) ^ ry);
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = N - 1 - x;
+                y = N - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+/************************************************************************/
+/*                            Overlaps()                                */
+/************************************************************************/
+
+static inline bool Overlaps(const CPLRectObj &a, const CPLRectObj &b)
+{
+    return !(a.minx > b.maxx || a.maxx < b.minx || a.miny > b.maxy ||
+             a.maxy < b.miny);
+}
+
+/************************************************************************/
+/*                          CPLPackedRTree()                            */
+/************************************************************************/
+
+/** Constructor.
+ *
+ * @param nNodeSize Maximum number of children of a node. Clamped to [2, 64].
+ */
+CPLPackedRTree::CPLPackedRTree(int nNodeSize)
+    : m_nNodeSize(std::max(2, std::min(64, nNodeSize)))
+{
+}
+
+/************************************************************************/
+/*                              Reserve()                               */
+/************************************************************************/
+
+/** Reserve memory for the specified number of features. */
+void CPLPackedRTree::Reserve(size_t nFeatureCount)
+{
+    m_asBoxes.reserve(nFeatureCount);
+    m_ahFeatures.reserve(nFeatureCount);
+}
+
+/************************************************************************/
+/*                               Insert()                               */
+/************************************************************************/
+
+/** Add a feature to the tree.
+ *
+ * Must be called before Build(). Features whose bounds contain NaN
+ * values are ignored.
+ */
+void CPLPackedRTree::Insert(void *hFeature, const CPLRectObj &sBounds)
+{
+    CPLAssert(!m_bBuilt);
+    if (m_bBuilt)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "CPLPackedRTree::Insert(): tree already built");
+        return;
+    }
+    if (std::isnan(sBounds.minx) || std::isnan(sBounds.miny) ||
+        std::isnan(sBounds.maxx) || std::isnan(sBounds.maxy))
+    {
+        return;
+    }
+    m_asBoxes.push_back(sBounds);
+    m_ahFeatures.push_back(hFeature);
+}
+
+/************************************************************************/
+/*                                Build()                               */
+/************************************************************************/
+
+/** Sort the inserted features and build the node levels.
+ *
+ * Must be called once, after all features have been inserted, and before
+ * searching.
+ */
+void CPLPackedRTree::Build()
+{
+    if (m_bBuilt)
+        return;
+    m_bBuilt = true;
+
+    const size_t nItems = m_ahFeatures.size();
+    if (nItems == 0)
+        return;
+
+    // Compute the extent of the centers of the features.
+    double dfMinX = std::numeric_limits<double>::infinity();
+    double dfMinY = std::numeric_limits<double>::infinity();
+    double dfMaxX = -std::numeric_limits<double>::infinity();
+    double dfMaxY = -std::numeric_limits<double>::infinity();
+    for (const auto &sBox : m_asBoxes)
+    {
+        const double dfX = (sBox.minx + sBox.maxx) / 2;
+        const double dfY = (sBox.miny + sBox.maxy) / 2;
+        dfMinX = std::min(dfMinX, dfX);
+        dfMinY = std::min(dfMinY, dfY);
+        dfMaxX = std::max(dfMaxX, dfX);
+        dfMaxY = std::max(dfMaxY, dfY);
+    }
+    const double dfScaleX =
+        dfMaxX > dfMinX && std::isfinite(dfMaxX - dfMinX)
+            ? 65535.0 / (dfMaxX - dfMinX)
+            : 0.0;
+    const double dfScaleY =
+        dfMaxY > dfMinY && std::isfinite(dfMaxY - dfMinY)
+            ? 65535.0 / (dfMaxY - dfMinY)
+            : 0.0;
+    const auto ToGrid = [](double dfVal)
+    {
+        // Also takes care of NaN, from infinite bounds.
+        return dfVal >= 0 ? static_cast<uint32_t>(std::min(65535.0, dfVal))
+                          : 0U;
+    };
+
+    // Sort features along the Hilbert curve.
+    std::vector<std::pair<uint32_t, size_t>> anOrder(nItems);
+    for (size_t i = 0; i < nItems; ++i)
+    {
+        const auto &sBox = m_asBoxes[i];
+        const double dfX = (sBox.minx + sBox.maxx) / 2;
+        const double dfY = (sBox.miny + sBox.maxy) / 2;
+        anOrder[i].first = HilbertIndex(ToGrid((dfX - dfMinX) * dfScaleX),
+                                        ToGrid((dfY - dfMinY) * dfScaleY));
+        anOrder[i].second = i;
+    }
+    std::sort(anOrder.begin(), anOrder.end());
+
+    const size_t nNodeSize = static_cast<size_t>(m_nNodeSize);
+
+    // Compute the level boundaries, so that the array of boxes can be
+    // allocated once. There is always at least one level above the leaves.
+    m_anLevelEnd.clear();
+    size_t nLevelCount = nItems;
+    size_t nTotal = nItems;
+    m_anLevelEnd.push_back(nTotal);
+    do
+    {
+        nLevelCount = (nLevelCount + nNodeSize - 1) / nNodeSize;
+        nTotal += nLevelCount;
+        m_anLevelEnd.push_back(nTotal);
+    } while (nLevelCount > 1);
+
+    std::vector<CPLRectObj> asBoxes;
+    asBoxes.reserve(nTotal);
+    std::vector<void *> ahFeatures;
+    ahFeatures.reserve(nItems);
+    for (const auto &oPair : anOrder)
+    {
+        asBoxes.push_back(m_asBoxes[oPair.second]);
+        ahFeatures.push_back(m_ahFeatures[oPair.second]);
+    }
+    anOrder.clear();
+    anOrder.shrink_to_fit();
+
+    // Build each level from the one below.
+    size_t nChildStart = 0;
+    for (size_t iLevel = 1; iLevel < m_anLevelEnd.size(); ++iLevel)
+    {
+        const size_t nChildEnd = m_anLevelEnd[iLevel - 1];
+        for (size_t i = nChildStart; i < nChildEnd; i += nNodeSize)
+        {
+            CPLRectObj sNode = asBoxes[i];
+            const size_t nEnd = std::min(i + nNodeSize, nChildEnd);
+            for (size_t j = i + 1; j < nEnd; ++j)
+            {
+                const auto &sChild = asBoxes[j];
+                sNode.minx = std::min(sNode.minx, sChild.minx);
+                sNode.miny = std::min(sNode.miny, sChild.miny);
+                sNode.maxx = std::max(sNode.maxx, sChild.maxx);
+                sNode.maxy = std::max(sNode.maxy, sChild.maxy);
+            }
+            asBoxes.push_back(sNode);
+        }
+        nChildStart = nChildEnd;
+    }
+    CPLAssert(asBoxes.size() == nTotal);
+
+    m_asBoxes = std::move(asBoxes);
+    m_ahFeatures = std::move(ahFeatures);
+
+    // A depth-first traversal keeps at most nNodeSize - 1 pending siblings
+    // per level, plus the node being processed.
+    m_nMaxStackSize = (m_anLevelEnd.size() - 1) * nNodeSize + 1;
+}
+
+/************************************************************************/
+/*                                Clear()                               */
+/************************************************************************/
+
+/** Remove all features, so that the tree can be filled again. */
+void CPLPackedRTree::Clear()
+{
+    m_bBuilt = false;
+    m_nMaxStackSize = 0;
+    m_asBoxes.clear();
+    m_ahFeatures.clear();
+    m_anLevelEnd.clear();
+}
+
+/************************************************************************/
+/*                               Search()                               */
+/************************************************************************/
+
+/** Append to ahFeatures the features whose bounds intersect sAoi.
+ *
+ * As with CPLQuadTreeSearch(), touching bounds are considered as
+ * intersecting. The order of the returned features is unspecified.
+ */
+void CPLPackedRTree::Search(const CPLRectObj &sAoi,
+                            std::vector<void *> &ahFeatures) const
+{
+    CPLAssert(m_bBuilt);
+    if (!m_bBuilt || m_ahFeatures.empty())
+        return;
+
+    const size_t nRoot = m_asBoxes.size() - 1;
+    if (!Overlaps(m_asBoxes[nRoot], sAoi))
+        return;
+
+    constexpr size_t STACK_BUFFER_SIZE = 512;
+    size_t anStackBuffer[STACK_BUFFER_SIZE];
+    std::vector<size_t> anStackHeap;
+    size_t *panStack = anStackBuffer;
+    if (m_nMaxStackSize > STACK_BUFFER_SIZE)
+    {
+        anStackHeap.resize(m_nMaxStackSize);
+        panStack = anStackHeap.data();
+    }
+
+    const size_t nNodeSize = static_cast<size_t>(m_nNodeSize);
+    const size_t nLeafEnd = m_anLevelEnd[0];
+    size_t nStackSize = 0;
+    panStack[nStackSize++] = nRoot;
+    while (nStackSize > 0)
+    {
+        const size_t nNode = panStack[--nStackSize];
+
+        // Find the level of the node: it is the first one whose end is
+        // after it.
+        size_t iLevel = 1;
+        while (m_anLevelEnd[iLevel] <= nNode)
+            ++iLevel;
+        const size_t nLevelStart = m_anLevelEnd[iLevel - 1];
+        const size_t nChildLevelStart =
+            iLevel == 1 ? 0 : m_anLevelEnd[iLevel - 2];
+        const size_t nFirstChild =
+            nChildLevelStart + (nNode - nLevelStart) * nNodeSize;
+        const size_t nLastChild =
+            std::min(nFirstChild + nNodeSize, nLevelStart);
+
+        if (nFirstChild < nLeafEnd)
+        {
+            for (size_t i = nFirstChild; i < nLastChild; ++i)
+            {
+                if (Overlaps(m_asBoxes[i], sAoi))
+                    ahFeatures.push_back(m_ahFeatures[i]);
+            }
+        }
+        else
+        {
+            for (size_t i = nFirstChild; i < nLastChild; ++i)
+            {
+                if (Overlaps(m_asBoxes[i], sAoi))
+                    panStack[nStackSize++] = i;
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                            SearchBatch()                             */
+/************************************************************************/
+
+/** Search several areas of interest at once.
+ *
+ * On return, the features intersecting pasAoi[i] are
+ * ahFeatures[anOffsets[i]] to ahFeatures[anOffsets[i+1]-1]. anOffsets has
+ * nAoiCount + 1 elements. Both vectors are cleared first.
+ */
+void CPLPackedRTree::SearchBatch(size_t nAoiCount, const CPLRectObj *pasAoi,
+                                 std::vector<size_t> &anOffsets,
+                                 std::vector<void *> &ahFeatures) const
+{
+    anOffsets.clear();
+    ahFeatures.clear();
+    anOffsets.reserve(nAoiCount + 1);
+    anOffsets.push_back(0);
+    for (size_t i = 0; i < nAoiCount; ++i)
+    {
+        Search(pasAoi[i], ahFeatures);
+        anOffsets.push_back(ahFeatures.size());
+    }
+}
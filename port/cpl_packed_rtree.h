@@ -0,0 +1,102 @@
+/******************************************************************************
+ *
+ * Project:  CPL - Common Portability Library
+ * Purpose:  Static, bulk-loaded, packed Hilbert R-tree
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef CPL_PACKED_RTREE_H_INCLUDED
+#define CPL_PACKED_RTREE_H_INCLUDED
+
+#include "cpl_port.h"
+#include "cpl_quad_tree.h"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * \file cpl_packed_rtree.h
+ *
+ * Static, bulk-loaded, packed R-tree.
+ *
+ * Features are sorted along the Hilbert curve of the center of their
+ * bounding box, and packed into nodes with a fixed number of children,
+ * stored level by level in a single contiguous array. Compared to
+ * CPLQuadTree, it is much faster to build and query, and has a better
+ * memory locality, but it cannot be modified once built. It is thus
+ * suited for read-mostly spatial indices built from a known set of
+ * features.
+ *
+ * @since GDAL 3.9
+ */
+
+/** Static, bulk-loaded, packed R-tree.
+ *
+ * Usage: call Insert() for each feature, then Build() once, and then
+ * Search() or SearchBatch() as many times as needed. Search methods are
+ * const and may be called concurrently from several threads.
+ *
+ * @since GDAL 3.9
+ */
+class CPL_DLL CPLPackedRTree
+{
+  public:
+    explicit CPLPackedRTree(int nNodeSize = 16);
+
+    void Reserve(size_t nFeatureCount);
+    void Insert(void *hFeature, const CPLRectObj &sBounds);
+    void Build();
+    void Clear();
+
+    /** Return whether Build() has been called. */
+    bool IsBuilt() const
+    {
+        return m_bBuilt;
+    }
+
+    /** Return the number of indexed features. */
+    size_t GetFeatureCount() const
+    {
+        return m_ahFeatures.size();
+    }
+
+    void Search(const CPLRectObj &sAoi, std::vector<void *> &ahFeatures) const;
+    void SearchBatch(size_t nAoiCount, const CPLRectObj *pasAoi,
+                     std::vector<size_t> &anOffsets,
+                     std::vector<void *> &ahFeatures) const;
+
+  private:
+    int m_nNodeSize;
+    bool m_bBuilt = false;
+    size_t m_nMaxStackSize = 0;
+
+    // Leaf boxes (in the same order as m_ahFeatures), followed by the
+    // boxes of the nodes of each level, up to the root.
+    std::vector<CPLRectObj> m_asBoxes{};
+    std::vector<void *> m_ahFeatures{};
+    // Position in m_asBoxes of the end of each level, leaves first.
+    std::vector<size_t> m_anLevelEnd{};
+};
+
+#endif /* CPL_PACKED_RTREE_H_INCLUDED */
@@ -0,0 +1,346 @@
+/**********************************************************************
+ * Project:  CPL - Common Portability Library
+ * Purpose:  Tracing of scoped spans in the Chrome Trace Event format
+ * Author:   GDAL contributors
+ *
+ **********************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_trace.h"
+#include "cpl_conv.h"
+#include "cpl_error.h"
+#include "cpl_multiproc.h"
+#include "cpl_string.h"
+#include "cpl_vsi.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+// -1: not yet initialized from CPL_TRACE_FILE, 0: disabled, 1: enabled
+static std::atomic<int> gnTraceState{-1};
+static std::mutex gTraceMutex;
+static VSILFILE *gfpTrace = nullptr;
+static std::string gosTraceBuffer;
+static bool gbTraceFirstEvent = true;
+
+// Size above which buffered events are written to the trace file
+constexpr size_t TRACE_BUFFER_SIZE = 1024 * 1024;
+
+/************************************************************************/
+/*                          CPLTraceGetTimeNS()                         */
+/************************************************************************/
+
+static GIntBig CPLTraceGetTimeNS()
+{
+    return static_cast<GIntBig>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+/************************************************************************/
+/*                         CPLTraceFlushLocked()                        */
+/************************************************************************/
+
+static void CPLTraceFlushLocked()
+{
+    if (gfpTrace && !gosTraceBuffer.empty())
+    {
+        VSIFWriteL(gosTraceBuffer.data(), 1, gosTraceBuffer.size(), gfpTrace);
+    }
+    gosTraceBuffer.clear();
+}
+
+/************************************************************************/
+/*                        CPLTraceStartLocked()                         */
+/************************************************************************/
+
+static bool CPLTraceStartLocked(const char *pszFilename)
+{
+    if (gfpTrace)
+    {
+        CPLTraceFlushLocked();
+        VSIFPrintfL(gfpTrace, "\n]\n");
+        VSIFCloseL(gfpTrace);
+        gfpTrace = nullptr;
+    }
+    gnTraceState = 0;
+    if (pszFilename == nullptr || pszFilename[0] == '\0')
+        return false;
+
+    gfpTrace = VSIFOpenL(pszFilename, "wb");
+    if (gfpTrace == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot create trace file %s",
+                 pszFilename);
+        return false;
+    }
+    // The Chrome Trace Event "JSON Array Format" tolerates a missing
+    // closing bracket, so that the trace remains readable if the process
+    // does not terminate cleanly.
+    VSIFPrintfL(gfpTrace, "[\n");
+    gbTraceFirstEvent = true;
+    gnTraceState = 1;
+    return true;
+}
+
+/************************************************************************/
+/*                           CPLTraceStart()                            */
+/************************************************************************/
+
+/** Start writing trace events to a file.
+ *
+ * If tracing was already enabled, the previous trace file is closed first.
+ *
+ * This is also done when the CPL_TRACE_FILE configuration option is set.
+ *
+ * @param pszFilename Name of the trace file (or /vsistdout/).
+ * @return TRUE in case of success.
+ *
+ * @since GDAL 3.9
+ */
+int CPLTraceStart(const char *pszFilename)
+{
+    std::lock_guard<std::mutex> oLock(gTraceMutex);
+    return CPLTraceStartLocked(pszFilename);
+}
+
+/************************************************************************/
+/*                            CPLTraceStop()                            */
+/************************************************************************/
+
+/** Stop tracing, and finalize the trace file.
+ *
+ * This is automatically called by GDALDestroyDriverManager().
+ *
+ * @since GDAL 3.9
+ */
+void CPLTraceStop(void)
+{
+    std::lock_guard<std::mutex> oLock(gTraceMutex);
+    CPLTraceStartLocked(nullptr);
+}
+
+/************************************************************************/
+/*                         CPLTraceIsEnabled()                          */
+/************************************************************************/
+
+/** Return whether tracing is enabled.
+ *
+ * @since GDAL 3.9
+ */
+int CPLTraceIsEnabled(void)
+{
+    int nState = gnTraceState.load(std::memory_order_relaxed);
+    if (nState < 0)
+    {
+        const std::string osFilename =
+            CPLGetConfigOption("CPL_TRACE_FILE", "");
+        std::lock_guard<std::mutex> oLock(gTraceMutex);
+        if (gnTraceState < 0)
+            CPLTraceStartLocked(osFilename.c_str());
+        nState = gnTraceState;
+    }
+    return nState > 0;
+}
+
+/************************************************************************/
+/*                    CPLTraceConfigOptionChanged()                     */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+void CPLTraceConfigOptionChanged(const char *pszValue)
+{
+    std::lock_guard<std::mutex> oLock(gTraceMutex);
+    CPLTraceStartLocked(pszValue);
+}
+
+//! @endcond
+
+/************************************************************************/
+/*                        CPLTraceAppendString()                        */
+/************************************************************************/
+
+static void CPLTraceAppendString(std::string &osOut, const char *pszStr)
+{
+    osOut += '"';
+    for (; *pszStr; ++pszStr)
+    {
+        const char ch = *pszStr;
+        if (ch == '"' || ch == '\\')
+        {
+            osOut += '\\';
+            osOut += ch;
+        }
+        else if (static_cast<unsigned char>(ch) < 0x20)
+        {
+            osOut += CPLSPrintf("\\u%04X", static_cast<int>(ch));
+        }
+        else
+        {
+            osOut += ch;
+        }
+    }
+    osOut += '"';
+}
+
+/************************************************************************/
+/*                        CPLTraceAppendEvent()                         */
+/************************************************************************/
+
+static void CPLTraceAppendEvent(const std::string &osEvent)
+{
+    std::lock_guard<std::mutex> oLock(gTraceMutex);
+    if (!gfpTrace)
+        return;
+    if (!gbTraceFirstEvent)
+        gosTraceBuffer += ",\n";
+    gbTraceFirstEvent = false;
+    gosTraceBuffer += osEvent;
+    if (gosTraceBuffer.size() >= TRACE_BUFFER_SIZE)
+        CPLTraceFlushLocked();
+}
+
+/************************************************************************/
+/*                          CPLTraceCounter()                           */
+/************************************************************************/
+
+/** Record the current values of a set of counters, if tracing is enabled.
+ *
+ * They are displayed by trace viewers as a graph over time.
+ *
+ * @param pszCategory Category of the counters, such as "gdal".
+ * @param pszName Name of the set of counters.
+ * @param nValues Number of counters.
+ * @param papszKeys Array of nValues counter names.
+ * @param panValues Array of nValues counter values.
+ *
+ * @since GDAL 3.9
+ */
+void CPLTraceCounter(const char *pszCategory, const char *pszName,
+                     int nValues, const char *const *papszKeys,
+                     const GIntBig *panValues)
+{
+    if (!CPLTraceIsEnabled())
+        return;
+
+    std::string osEvent;
+    osEvent.reserve(128 + 32 * nValues);
+    osEvent += "{\"name\":";
+    CPLTraceAppendString(osEvent, pszName);
+    osEvent += ",\"cat\":";
+    CPLTraceAppendString(osEvent, pszCategory);
+    osEvent += CPLSPrintf(",\"ph\":\"C\",\"ts\":%.3f,\"pid\":%d,\"args\":{",
+                          static_cast<double>(CPLTraceGetTimeNS()) / 1000,
+                          CPLGetCurrentProcessID());
+    for (int i = 0; i < nValues; ++i)
+    {
+        if (i > 0)
+            osEvent += ',';
+        CPLTraceAppendString(osEvent, papszKeys[i]);
+        osEvent += CPLSPrintf(":" CPL_FRMT_GIB, panValues[i]);
+    }
+    osEvent += "}}";
+
+    CPLTraceAppendEvent(osEvent);
+}
+
+/************************************************************************/
+/*                           CPLTraceSpan()                             */
+/************************************************************************/
+
+/** Constructor.
+ *
+ * @param pszCategory Category of the span, such as "gdal", "vsi" or "ogr".
+ * Must remain valid during the lifetime of the span.
+ * @param pszName Name of the span, typically the name of the traced method.
+ * Must remain valid during the lifetime of the span.
+ */
+CPLTraceSpan::CPLTraceSpan(const char *pszCategory, const char *pszName)
+    : m_pszCategory(pszCategory), m_pszName(pszName),
+      m_bEnabled(CPLTraceIsEnabled() != FALSE)
+{
+    if (m_bEnabled)
+        m_nStartNS = CPLTraceGetTimeNS();
+}
+
+/************************************************************************/
+/*                          ~CPLTraceSpan()                             */
+/************************************************************************/
+
+/** Destructor: records the span, if tracing is enabled. */
+CPLTraceSpan::~CPLTraceSpan()
+{
+    if (!m_bEnabled)
+        return;
+    const GIntBig nEndNS = CPLTraceGetTimeNS();
+
+    std::string osEvent;
+    osEvent.reserve(128 + m_osArgs.size());
+    osEvent += "{\"name\":";
+    CPLTraceAppendString(osEvent, m_pszName);
+    osEvent += ",\"cat\":";
+    CPLTraceAppendString(osEvent, m_pszCategory);
+    // Timestamps and durations are in microseconds
+    osEvent += CPLSPrintf(",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                          "\"pid\":%d,\"tid\":" CPL_FRMT_GIB,
+                          static_cast<double>(m_nStartNS) / 1000,
+                          static_cast<double>(nEndNS - m_nStartNS) / 1000,
+                          CPLGetCurrentProcessID(), CPLGetPID());
+    if (!m_osArgs.empty())
+    {
+        osEvent += ",\"args\":{";
+        osEvent += m_osArgs;
+        osEvent += '}';
+    }
+    osEvent += '}';
+
+    CPLTraceAppendEvent(osEvent);
+}
+
+/************************************************************************/
+/*                               AddArg()                               */
+/************************************************************************/
+
+/** Attach a string argument to the span. */
+void CPLTraceSpan::AddArg(const char *pszKey, const char *pszValue)
+{
+    if (!m_bEnabled)
+        return;
+    if (!m_osArgs.empty())
+        m_osArgs += ',';
+    CPLTraceAppendString(m_osArgs, pszKey);
+    m_osArgs += ':';
+    CPLTraceAppendString(m_osArgs, pszValue ? pszValue : "");
+}
+
+/** Attach an integer argument to the span. */
+void CPLTraceSpan::AddArg(const char *pszKey, GIntBig nValue)
+{
+    if (!m_bEnabled)
+        return;
+    if (!m_osArgs.empty())
+        m_osArgs += ',';
+    CPLTraceAppendString(m_osArgs, pszKey);
+    m_osArgs += CPLSPrintf(":" CPL_FRMT_GIB, nValue);
+}
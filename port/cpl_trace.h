@@ -0,0 +1,105 @@
+/**********************************************************************
+ * Project:  CPL - Common Portability Library
+ * Purpose:  Tracing of scoped spans in the Chrome Trace Event format
+ * Author:   GDAL contributors
+ *
+ **********************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef CPL_TRACE_H_INCLUDED
+#define CPL_TRACE_H_INCLUDED
+
+#include "cpl_port.h"
+
+/**
+ * \file cpl_trace.h
+ *
+ * API for tracing the duration of operations, as scoped spans, and writing
+ * them in the Chrome Trace Event format, that can be displayed by
+ * chrome://tracing or https://ui.perfetto.dev
+ *
+ * Tracing is enabled by setting the CPL_TRACE_FILE configuration option to
+ * the name of the output file, or with CPLTraceStart().
+ *
+ * @since GDAL 3.9
+ */
+
+CPL_C_START
+
+int CPL_DLL CPLTraceStart(const char *pszFilename);
+void CPL_DLL CPLTraceStop(void);
+int CPL_DLL CPLTraceIsEnabled(void);
+void CPL_DLL CPLTraceCounter(const char *pszCategory, const char *pszName,
+                             int nValues, const char *const *papszKeys,
+                             const GIntBig *panValues);
+
+//! @cond Doxygen_Suppress
+void CPL_DLL CPLTraceConfigOptionChanged(const char *pszValue);
+//! @endcond
+
+CPL_C_END
+
+#if defined(__cplusplus) && !defined(CPL_SUPRESS_CPLUSPLUS)
+
+#include <string>
+
+/** Scoped span, recording the duration between its construction and its
+ * destruction, if tracing is enabled.
+ *
+ * Spans created in a same thread nest according to their lifetime.
+ *
+ * Typical use is:
+ * \code{.cpp}
+ * CPLTraceSpan oSpan("gdal", "GDALRasterBand::RasterIO");
+ * if (oSpan.IsEnabled())
+ *     oSpan.AddArg("band", nBand);
+ * \endcode
+ *
+ * @since GDAL 3.9
+ */
+class CPL_DLL CPLTraceSpan
+{
+    const char *m_pszCategory;
+    const char *m_pszName;
+    GIntBig m_nStartNS = 0;
+    bool m_bEnabled = false;
+    std::string m_osArgs{};
+
+    CPL_DISALLOW_COPY_ASSIGN(CPLTraceSpan)
+
+  public:
+    CPLTraceSpan(const char *pszCategory, const char *pszName);
+    ~CPLTraceSpan();
+
+    /** Return whether this span is recorded */
+    inline bool IsEnabled() const
+    {
+        return m_bEnabled;
+    }
+
+    void AddArg(const char *pszKey, const char *pszValue);
+    void AddArg(const char *pszKey, GIntBig nValue);
+};
+
+#endif  // __cplusplus
+
+#endif  // CPL_TRACE_H_INCLUDED
@@ -29,9 +29,13 @@
 
 #ifdef ENABLE_UFFD
 
+#include <algorithm>
 #include <cstdlib>
 #include <cinttypes>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 
 #include <errno.h>
@@ -56,6 +60,7 @@
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "cpl_multiproc.h"
+#include "cpl_worker_thread_pool.h"
 
 #ifndef UFFD_USER_MODE_ONLY
 // The UFFD_USER_MODE_ONLY flag got added in kernel 5.11 which is the one
@@ -68,6 +73,7 @@
 
 static int64_t get_page_limit();
 static void cpl_uffd_fault_handler(void *ptr);
+static void cpl_uffd_callback_fault_handler(void *ptr);
 static void signal_handler(int signal);
 static void uffd_cleanup(void *ptr);
 
@@ -90,6 +96,15 @@ struct cpl_uffd_context
     size_t vma_size = 0;
     void *vma_ptr = nullptr;
     CPLJoinableThread *thread = nullptr;
+
+    // Only set for mappings created by CPLCreateUserFaultMappingFromCallback()
+    CPLUserFaultFillFunc pfnFill = nullptr;
+    void *pFillUserData = nullptr;
+    size_t data_size = 0;
+    size_t chunk_size = 0;
+    std::unique_ptr<CPLWorkerThreadPool> poPool{};
+    std::mutex oPendingChunksMutex{};
+    std::set<size_t> oPendingChunks{};
 };
 
 static void uffd_cleanup(void *ptr)
@@ -107,6 +122,13 @@ static void uffd_cleanup(void *ptr)
         ctx->thread = nullptr;
     }
 
+    // Let in-flight fill jobs complete before unregistering the range
+    if (ctx->poPool)
+    {
+        ctx->poPool->WaitCompletion();
+        ctx->poPool.reset();
+    }
+
     if (ctx->uffd != -1)
     {
         ioctl(ctx->uffd, UFFDIO_UNREGISTER, &ctx->uffdio_register);
@@ -374,6 +396,154 @@ static void cpl_uffd_fault_handler(void *ptr)
     VSIFCloseL(file);
 }
 
+namespace
+{
+struct cpl_uffd_fill_job
+{
+    cpl_uffd_context *ctx;
+    size_t chunk;
+};
+}  // namespace
+
+/*
+ * Worker thread job: fills a chunk of the mapping with the user callback,
+ * and copies it into the VMA, which wakes up all threads waiting on it.
+ */
+static void cpl_uffd_fill_chunk(void *ptr)
+{
+    cpl_uffd_fill_job *job = static_cast<cpl_uffd_fill_job *>(ptr);
+    cpl_uffd_context *ctx = job->ctx;
+    const size_t offset = job->chunk * ctx->chunk_size;
+    const size_t len = std::min(ctx->chunk_size, ctx->vma_size - offset);
+    const size_t to_fill =
+        offset < ctx->data_size ? std::min(len, ctx->data_size - offset) : 0;
+    const uintptr_t dst = reinterpret_cast<uintptr_t>(ctx->vma_ptr) + offset;
+
+    GByte *buffer = static_cast<GByte *>(VSIMallocAligned(ctx->page_size, len));
+    if (buffer)
+    {
+        ctx->pfnFill(offset, buffer, to_fill, ctx->pFillUserData);
+        if (to_fill < len)
+            memset(buffer + to_fill, 0, len - to_fill);
+
+        size_t done = 0;
+        while (done < len)
+        {
+            struct uffdio_copy uffdio_copy;
+            uffdio_copy.src = reinterpret_cast<uintptr_t>(buffer + done);
+            uffdio_copy.dst = dst + done;
+            uffdio_copy.len = len - done;
+            uffdio_copy.mode = 0;
+            uffdio_copy.copy = 0;
+            if (ioctl(ctx->uffd, UFFDIO_COPY, &uffdio_copy) == 0)
+                break;
+            if (uffdio_copy.copy > 0)
+                done += static_cast<size_t>(uffdio_copy.copy);
+            else if (errno == EEXIST)
+                done += ctx->page_size;  // page already populated
+            else if (errno != EAGAIN)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "ioctl(UFFDIO_COPY) failed");
+                break;
+            }
+        }
+        VSIFreeAligned(buffer);
+    }
+    else
+    {
+        // Faulting threads must be woken up in all cases
+        struct uffdio_zeropage uffdio_zeropage;
+        uffdio_zeropage.range.start = dst;
+        uffdio_zeropage.range.len = len;
+        uffdio_zeropage.mode = 0;
+        uffdio_zeropage.zeropage = 0;
+        if (ioctl(ctx->uffd, UFFDIO_ZEROPAGE, &uffdio_zeropage) == -1 &&
+            errno != EEXIST)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "ioctl(UFFDIO_ZEROPAGE) failed");
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(ctx->oPendingChunksMutex);
+        ctx->oPendingChunks.erase(job->chunk);
+    }
+    delete job;
+}
+
+/*
+ * Fault handler for mappings created by
+ * CPLCreateUserFaultMappingFromCallback(). Filling pages is delegated to a
+ * pool of worker threads, so that faults on different chunks are serviced
+ * concurrently, while faults on a chunk that is being filled are ignored
+ * (the faulting threads are woken up when the chunk is copied).
+ */
+static void cpl_uffd_callback_fault_handler(void *ptr)
+{
+    struct cpl_uffd_context *ctx = static_cast<struct cpl_uffd_context *>(ptr);
+    struct pollfd pollfd;
+
+    // Setup pollfd structure
+    pollfd.fd = ctx->uffd;
+    pollfd.events = POLLIN;
+
+    // Loop until told to stop
+    while (ctx->keep_going)
+    {
+        // Poll for event
+        if (poll(&pollfd, 1, 16) == -1)
+            break;  // 60Hz when no demand
+        if ((pollfd.revents & POLLERR) || (pollfd.revents & POLLNVAL))
+            break;
+        if (!(pollfd.revents & POLLIN))
+            continue;
+
+        // Read page fault events
+        ssize_t bytes_read = static_cast<ssize_t>(
+            read(ctx->uffd, ctx->uffd_msgs, MAX_MESSAGES * sizeof(uffd_msg)));
+        if (bytes_read < 1)
+        {
+            if (errno == EWOULDBLOCK)
+                continue;
+            else
+                break;
+        }
+
+        // Handle page fault events
+        for (int i = 0; i < static_cast<int>(bytes_read / sizeof(uffd_msg));
+             ++i)
+        {
+            const uintptr_t fault_addr =
+                ctx->uffd_msgs[i].arg.pagefault.address & ~(ctx->page_size - 1);
+            const size_t chunk = static_cast<size_t>(
+                (fault_addr - reinterpret_cast<uintptr_t>(ctx->vma_ptr)) /
+                ctx->chunk_size);
+
+            {
+                std::lock_guard<std::mutex> oLock(ctx->oPendingChunksMutex);
+                if (ctx->oPendingChunks.find(chunk) !=
+                    ctx->oPendingChunks.end())
+                    continue;
+
+                // The fault may have been queued before the job filling
+                // its chunk completed.
+                unsigned char vec = 0;
+                if (mincore(reinterpret_cast<void *>(fault_addr),
+                            ctx->page_size, &vec) == 0 &&
+                    (vec & 1) != 0)
+                    continue;
+
+                ctx->oPendingChunks.insert(chunk);
+            }
+
+            ctx->poPool->SubmitJob(cpl_uffd_fill_chunk,
+                                   new cpl_uffd_fill_job{ctx, chunk});
+        }
+    }  // end of while loop
+}
+
 static void signal_handler(int signal)
 {
     if (signal == SIGSEGV || signal == SIGBUS)
@@ -445,6 +615,79 @@ bool CPLIsUserFaultMappingSupported()
     return true;
 }
 
+/*
+ * Creates the userfaultfd file descriptor and registers ctx->vma_ptr with it.
+ * On failure, ctx is freed and false is returned.
+ */
+static bool uffd_register(cpl_uffd_context *ctx, const char *pszFuncName)
+{
+    // Since kernel 5.2, raw userfaultfd is disabled since if the fault
+    // originates from the kernel, that could lead to easier exploitation of
+    // kernel bugs. Since kernel 5.11, UFFD_USER_MODE_ONLY can be used to
+    // restrict the mechanism to faults occurring only from user space, which is
+    // likely to be our use case.
+    ctx->uffd = static_cast<int>(syscall(
+        __NR_userfaultfd, O_CLOEXEC | O_NONBLOCK | UFFD_USER_MODE_ONLY));
+    if (ctx->uffd == -1 && errno == EINVAL)
+        ctx->uffd =
+            static_cast<int>(syscall(__NR_userfaultfd, O_CLOEXEC | O_NONBLOCK));
+    if (ctx->uffd == -1)
+    {
+        const int l_errno = errno;
+        ctx->uffd = -1;
+        uffd_cleanup(ctx);
+        if (l_errno == EPERM)
+        {
+            // Since kernel 5.2
+            CPLError(
+                CE_Failure, CPLE_AppDefined,
+                "%s(): syscall(__NR_userfaultfd) failed: "
+                "insufficient permission. add CAP_SYS_PTRACE capability, or "
+                "set /proc/sys/vm/unprivileged_userfaultfd to 1",
+                pszFuncName);
+        }
+        else
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "%s(): syscall(__NR_userfaultfd) failed: error = %d",
+                     pszFuncName, l_errno);
+        }
+        return false;
+    }
+
+    // Query API
+    {
+        struct uffdio_api uffdio_api = {};
+
+        uffdio_api.api = UFFD_API;
+        uffdio_api.features = 0;
+
+        if (ioctl(ctx->uffd, UFFDIO_API, &uffdio_api) == -1)
+        {
+            uffd_cleanup(ctx);
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "%s(): ioctl(UFFDIO_API) failed", pszFuncName);
+            return false;
+        }
+    }
+
+    // Register memory range
+    ctx->uffdio_register.range.start =
+        reinterpret_cast<uintptr_t>(ctx->vma_ptr);
+    ctx->uffdio_register.range.len = ctx->vma_size;
+    ctx->uffdio_register.mode = UFFDIO_REGISTER_MODE_MISSING;
+
+    if (ioctl(ctx->uffd, UFFDIO_REGISTER, &ctx->uffdio_register) == -1)
+    {
+        uffd_cleanup(ctx);
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "%s(): ioctl(UFFDIO_REGISTER) failed", pszFuncName);
+        return false;
+    }
+
+    return true;
+}
+
 /*
  * Returns nullptr on failure, a valid pointer on success.
  */
@@ -511,81 +754,96 @@ cpl_uffd_context *CPLCreateUserFaultMapping(const char *pszFilename,
         return nullptr;
     }
 
-    // Get userfaultfd
+    if (!uffd_register(ctx, "CPLCreateUserFaultMapping"))
+        return nullptr;
 
-    // Since kernel 5.2, raw userfaultfd is disabled since if the fault
-    // originates from the kernel, that could lead to easier exploitation of
-    // kernel bugs. Since kernel 5.11, UFFD_USER_MODE_ONLY can be used to
-    // restrict the mechanism to faults occurring only from user space, which is
-    // likely to be our use case.
-    ctx->uffd = static_cast<int>(syscall(
-        __NR_userfaultfd, O_CLOEXEC | O_NONBLOCK | UFFD_USER_MODE_ONLY));
-    if (ctx->uffd == -1 && errno == EINVAL)
-        ctx->uffd =
-            static_cast<int>(syscall(__NR_userfaultfd, O_CLOEXEC | O_NONBLOCK));
-    if (ctx->uffd == -1)
+    // Start handler thread
+    ctx->thread = CPLCreateJoinableThread(cpl_uffd_fault_handler, ctx);
+    if (ctx->thread == nullptr)
     {
-        const int l_errno = errno;
-        ctx->uffd = -1;
+        CPLError(
+            CE_Failure, CPLE_AppDefined,
+            "CPLCreateUserFaultMapping(): CPLCreateJoinableThread() failed");
         uffd_cleanup(ctx);
-        if (l_errno == EPERM)
-        {
-            // Since kernel 5.2
-            CPLError(
-                CE_Failure, CPLE_AppDefined,
-                "CPLCreateUserFaultMapping(): syscall(__NR_userfaultfd) "
-                "failed: "
-                "insufficient permission. add CAP_SYS_PTRACE capability, or "
-                "set /proc/sys/vm/unprivileged_userfaultfd to 1");
-        }
-        else
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "CPLCreateUserFaultMapping(): syscall(__NR_userfaultfd) "
-                     "failed: "
-                     "error = %d",
-                     l_errno);
-        }
         return nullptr;
     }
 
-    // Query API
+    *ppVma = ctx->vma_ptr;
+    *pnVmaSize = ctx->vma_size;
+    return ctx;
+}
+
+/*
+ * Creates a read-only mapping of nSize bytes whose content is provided by
+ * pfnFill, called by nThreads worker threads on chunks of nChunkSize bytes
+ * (rounded up to a multiple of the page size) when they are first accessed.
+ * Pages are not evicted before CPLDeleteUserFaultMapping() is called.
+ *
+ * Returns nullptr on failure, a valid pointer on success.
+ */
+cpl_uffd_context *CPLCreateUserFaultMappingFromCallback(
+    size_t nSize, size_t nChunkSize, int nThreads, CPLUserFaultFillFunc pfnFill,
+    void *pUserData, void **ppVma, uint64_t *pnVmaSize)
+{
+    if (!CPLIsUserFaultMappingSupported())
     {
-        struct uffdio_api uffdio_api = {};
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "CPLCreateUserFaultMappingFromCallback(): Linux kernel 4.3 "
+                 "or newer needed");
+        return nullptr;
+    }
 
-        uffdio_api.api = UFFD_API;
-        uffdio_api.features = 0;
+    // Setup the `cpl_uffd_context` struct
+    struct cpl_uffd_context *ctx = new cpl_uffd_context();
+    ctx->keep_going = true;
+    ctx->pfnFill = pfnFill;
+    ctx->pFillUserData = pUserData;
+    ctx->data_size = nSize;
+    ctx->page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    ctx->chunk_size = std::max(nChunkSize, ctx->page_size);
+    ctx->chunk_size =
+        ((ctx->chunk_size + ctx->page_size - 1) / ctx->page_size) *
+        ctx->page_size;
+    ctx->vma_size =
+        ((nSize + ctx->page_size - 1) / ctx->page_size) * ctx->page_size;
+    if (nSize == 0 || ctx->vma_size < nSize)
+    {  // Check for overflow
+        uffd_cleanup(ctx);
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "CPLCreateUserFaultMappingFromCallback(): invalid size");
+        return nullptr;
+    }
 
-        if (ioctl(ctx->uffd, UFFDIO_API, &uffdio_api) == -1)
-        {
-            uffd_cleanup(ctx);
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "CPLCreateUserFaultMapping(): ioctl(UFFDIO_API) failed");
-            return nullptr;
-        }
+    // If the mmap failed, free resources and return
+    ctx->vma_ptr = mmap(nullptr, ctx->vma_size, PROT_READ,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ctx->vma_ptr == BAD_MMAP)
+    {
+        ctx->vma_ptr = nullptr;
+        uffd_cleanup(ctx);
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "CPLCreateUserFaultMappingFromCallback(): mmap() failed");
+        return nullptr;
     }
 
-    // Register memory range
-    ctx->uffdio_register.range.start =
-        reinterpret_cast<uintptr_t>(ctx->vma_ptr);
-    ctx->uffdio_register.range.len = ctx->vma_size;
-    ctx->uffdio_register.mode = UFFDIO_REGISTER_MODE_MISSING;
+    if (!uffd_register(ctx, "CPLCreateUserFaultMappingFromCallback"))
+        return nullptr;
 
-    if (ioctl(ctx->uffd, UFFDIO_REGISTER, &ctx->uffdio_register) == -1)
+    ctx->poPool = std::make_unique<CPLWorkerThreadPool>();
+    if (!ctx->poPool->Setup(std::max(1, nThreads), nullptr, nullptr))
     {
+        ctx->poPool.reset();
         uffd_cleanup(ctx);
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "CPLCreateUserFaultMapping(): ioctl(UFFDIO_REGISTER) failed");
         return nullptr;
     }
 
     // Start handler thread
-    ctx->thread = CPLCreateJoinableThread(cpl_uffd_fault_handler, ctx);
+    ctx->thread = CPLCreateJoinableThread(cpl_uffd_callback_fault_handler, ctx);
     if (ctx->thread == nullptr)
     {
-        CPLError(
-            CE_Failure, CPLE_AppDefined,
-            "CPLCreateUserFaultMapping(): CPLCreateJoinableThread() failed");
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "CPLCreateUserFaultMappingFromCallback(): "
+                 "CPLCreateJoinableThread() failed");
         uffd_cleanup(ctx);
         return nullptr;
     }
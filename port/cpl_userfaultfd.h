@@ -50,4 +50,13 @@ cpl_uffd_context CPL_DLL *CPLCreateUserFaultMapping(const char *pszFilename,
                                                     uint64_t *pnVmaSize);
 void CPL_DLL CPLDeleteUserFaultMapping(cpl_uffd_context *ctx);
 
+/** Callback used by CPLCreateUserFaultMappingFromCallback() to fill
+ * nToFill bytes at offset nOffset of the mapping into pDst. */
+typedef void (*CPLUserFaultFillFunc)(size_t nOffset, void *pDst,
+                                     size_t nToFill, void *pUserData);
+
+cpl_uffd_context CPL_DLL *CPLCreateUserFaultMappingFromCallback(
+    size_t nSize, size_t nChunkSize, int nThreads, CPLUserFaultFillFunc pfnFill,
+    void *pUserData, void **ppVma, uint64_t *pnVmaSize);
+
 #endif
@@ -48,6 +48,10 @@
 #include "cpl_error.h"
 #include "cpl_multiproc.h"
 
+#ifdef ENABLE_UFFD
+#include "cpl_userfaultfd.h"
+#endif
+
 #ifdef NDEBUG
 // Non NDEBUG: Ignore the result.
 #define IGNORE_OR_ASSERT_IN_DEBUG(expr) CPL_IGNORE_RET_VAL((expr))
@@ -74,7 +78,8 @@
 typedef enum
 {
     VIRTUAL_MEM_TYPE_FILE_MEMORY_MAPPED,
-    VIRTUAL_MEM_TYPE_VMA
+    VIRTUAL_MEM_TYPE_VMA,
+    VIRTUAL_MEM_TYPE_USERFAULTFD
 } CPLVirtualMemType;
 
 struct CPLVirtualMem
@@ -100,6 +105,17 @@ struct CPLVirtualMem
     CPLVirtualMemFreeUserData pfnFreeUserData;
 };
 
+#ifdef ENABLE_UFFD
+typedef struct
+{
+    CPLVirtualMem sBase;
+
+    cpl_uffd_context *psUFFDContext;
+    CPLVirtualMemCachePageCbk pfnCachePage;  // Called from worker threads
+                                             // when a chunk is accessed.
+} CPLVirtualMemUserFault;
+#endif
+
 #ifdef HAVE_VIRTUAL_MEM_VMA
 
 #include <sys/select.h>  // select
@@ -552,7 +568,7 @@ static void CPLVirtualMemSIGUSR1Handler(int /* signum_unused */,
 
 void CPLVirtualMemDeclareThread(CPLVirtualMem *ctxt)
 {
-    if (ctxt->eType == VIRTUAL_MEM_TYPE_FILE_MEMORY_MAPPED)
+    if (ctxt->eType != VIRTUAL_MEM_TYPE_VMA)
         return;
 #ifndef HAVE_5ARGS_MREMAP
     CPLVirtualMemVMA *ctxtVMA = reinterpret_cast<CPLVirtualMemVMA *>(ctxt);
@@ -573,7 +589,7 @@ void CPLVirtualMemDeclareThread(CPLVirtualMem *ctxt)
 
 void CPLVirtualMemUnDeclareThread(CPLVirtualMem *ctxt)
 {
-    if (ctxt->eType == VIRTUAL_MEM_TYPE_FILE_MEMORY_MAPPED)
+    if (ctxt->eType != VIRTUAL_MEM_TYPE_VMA)
         return;
 #ifndef HAVE_5ARGS_MREMAP
     CPLVirtualMemVMA *ctxtVMA = reinterpret_cast<CPLVirtualMemVMA *>(ctxt);
@@ -1577,7 +1593,7 @@ CPLVirtualMemManagerPinAddrInternal(CPLVirtualMemMsgToWorkerThread *msg)
 void CPLVirtualMemPin(CPLVirtualMem *ctxt, void *pAddr, size_t nSize,
                       int bWriteOp)
 {
-    if (ctxt->eType == VIRTUAL_MEM_TYPE_FILE_MEMORY_MAPPED)
+    if (ctxt->eType != VIRTUAL_MEM_TYPE_VMA)
         return;
 
     CPLVirtualMemMsgToWorkerThread msg;
@@ -2133,6 +2149,98 @@ CPLVirtualMem *CPLVirtualMemFileMapNew(
 
 #endif  // HAVE_MMAP
 
+/************************************************************************/
+/*                  CPLIsVirtualMemUserFaultAvailable()                 */
+/************************************************************************/
+
+int CPLIsVirtualMemUserFaultAvailable(void)
+{
+#ifdef ENABLE_UFFD
+    return CPLIsUserFaultMappingSupported();
+#else
+    return FALSE;
+#endif
+}
+
+#ifdef ENABLE_UFFD
+
+/************************************************************************/
+/*                     CPLVirtualMemUserFaultFill()                     */
+/************************************************************************/
+
+static void CPLVirtualMemUserFaultFill(size_t nOffset, void *pDst,
+                                       size_t nToFill, void *pUserData)
+{
+    CPLVirtualMemUserFault *ctxt =
+        static_cast<CPLVirtualMemUserFault *>(pUserData);
+    ctxt->pfnCachePage(&(ctxt->sBase), nOffset, pDst, nToFill,
+                       ctxt->sBase.pCbkUserData);
+}
+
+/************************************************************************/
+/*                     CPLVirtualMemUserFaultNew()                      */
+/************************************************************************/
+
+CPLVirtualMem *CPLVirtualMemUserFaultNew(
+    size_t nSize, size_t nPageSizeHint, int nThreads,
+    CPLVirtualMemCachePageCbk pfnCachePage,
+    CPLVirtualMemFreeUserData pfnFreeUserData, void *pCbkUserData)
+{
+    const size_t nMinPageSize = CPLGetPageSize();
+    size_t nPageSize = 256 * 256;
+    if (nPageSizeHint >= nMinPageSize && nPageSizeHint <= 32 * 1024 * 1024)
+    {
+        if ((nPageSizeHint % nMinPageSize) == 0)
+            nPageSize = nPageSizeHint;
+        else
+            nPageSize = (nPageSizeHint / nMinPageSize + 1) * nMinPageSize;
+    }
+
+    CPLVirtualMemUserFault *ctxt = static_cast<CPLVirtualMemUserFault *>(
+        VSI_CALLOC_VERBOSE(1, sizeof(CPLVirtualMemUserFault)));
+    if (ctxt == nullptr)
+        return nullptr;
+    ctxt->sBase.eType = VIRTUAL_MEM_TYPE_USERFAULTFD;
+    ctxt->sBase.nRefCount = 1;
+    ctxt->sBase.eAccessMode = VIRTUALMEM_READONLY_ENFORCED;
+    ctxt->sBase.nPageSize = nPageSize;
+    ctxt->sBase.nSize = nSize;
+    ctxt->sBase.bSingleThreadUsage = false;
+    ctxt->sBase.pfnFreeUserData = pfnFreeUserData;
+    ctxt->sBase.pCbkUserData = pCbkUserData;
+    ctxt->pfnCachePage = pfnCachePage;
+
+    void *pVma = nullptr;
+    uint64_t nVmaSize = 0;
+    ctxt->psUFFDContext = CPLCreateUserFaultMappingFromCallback(
+        nSize, nPageSize, nThreads, CPLVirtualMemUserFaultFill, ctxt, &pVma,
+        &nVmaSize);
+    if (ctxt->psUFFDContext == nullptr)
+    {
+        CPLFree(ctxt);
+        return nullptr;
+    }
+    ctxt->sBase.pData = pVma;
+    ctxt->sBase.pDataToFree = pVma;
+
+    return &(ctxt->sBase);
+}
+
+#else  // ENABLE_UFFD
+
+CPLVirtualMem *CPLVirtualMemUserFaultNew(
+    size_t /* nSize */, size_t /* nPageSizeHint */, int /* nThreads */,
+    CPLVirtualMemCachePageCbk /* pfnCachePage */,
+    CPLVirtualMemFreeUserData /* pfnFreeUserData */, void * /* pCbkUserData */)
+{
+    CPLError(CE_Failure, CPLE_NotSupported,
+             "CPLVirtualMemUserFaultNew() unsupported on this "
+             "operating system / configuration");
+    return nullptr;
+}
+
+#endif  // ENABLE_UFFD
+
 /************************************************************************/
 /*                         CPLGetPageSize()                             */
 /************************************************************************/
@@ -2186,6 +2294,11 @@ void CPLVirtualMemFree(CPLVirtualMem *ctxt)
         CPLVirtualMemFreeFileMemoryMapped(
             reinterpret_cast<CPLVirtualMemVMA *>(ctxt));
 #endif
+#ifdef ENABLE_UFFD
+    if (ctxt->eType == VIRTUAL_MEM_TYPE_USERFAULTFD)
+        CPLDeleteUserFaultMapping(
+            reinterpret_cast<CPLVirtualMemUserFault *>(ctxt)->psUFFDContext);
+#endif
 
     if (ctxt->pfnFreeUserData != nullptr)
         ctxt->pfnFreeUserData(ctxt->pCbkUserData);
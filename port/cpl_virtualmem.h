@@ -208,6 +208,50 @@ CPLVirtualMem CPL_DLL *CPLVirtualMemFileMapNew(
     CPLVirtualMemAccessMode eAccessMode,
     CPLVirtualMemFreeUserData pfnFreeUserData, void *pCbkUserData);
 
+/** Return if virtual memory mappings backed by userfaultfd are available.
+ *
+ * @return TRUE if CPLVirtualMemUserFaultNew() can be used.
+ * @since GDAL 3.9
+ */
+int CPL_DLL CPLIsVirtualMemUserFaultAvailable(void);
+
+/** Create a new read-only virtual memory mapping serviced by userfaultfd.
+ *
+ * Contrary to CPLVirtualMemNew(), no SIGSEGV handler is involved: page faults
+ * are received by a dedicated thread, and pages are filled by a pool of
+ * nThreads worker threads, so that accesses from several threads to different
+ * pages are serviced concurrently. pfnCachePage must thus be thread-safe.
+ * Pages are filled at most once, and are not evicted before the mapping is
+ * freed.
+ *
+ * The mapping can be accessed by any thread without calling
+ * CPLVirtualMemDeclareThread().
+ *
+ * Only supported on Linux 4.3 or later, when the process is allowed to use
+ * userfaultfd (see CPLIsVirtualMemUserFaultAvailable()).
+ *
+ * @param nSize size in bytes of the virtual memory mapping.
+ * @param nPageSizeHint hint for the size of the chunks filled by a single
+ *                      call to pfnCachePage. Rounded up to a multiple of the
+ *                      system page size. Might be set to 0 to let the
+ *                      function determine a default value.
+ * @param nThreads number of worker threads filling pages.
+ * @param pfnCachePage callback triggered, from a worker thread, when a still
+ *                     unmapped chunk of virtual memory is accessed.
+ * @param pfnFreeUserData callback that can be used to free pCbkUserData. Might
+ *                        be NULL
+ * @param pCbkUserData user data passed to pfnCachePage.
+ *
+ * @return a virtual memory object that must be freed by CPLVirtualMemFree(),
+ *         or NULL in case of failure.
+ *
+ * @since GDAL 3.9
+ */
+CPLVirtualMem CPL_DLL *CPLVirtualMemUserFaultNew(
+    size_t nSize, size_t nPageSizeHint, int nThreads,
+    CPLVirtualMemCachePageCbk pfnCachePage,
+    CPLVirtualMemFreeUserData pfnFreeUserData, void *pCbkUserData);
+
 /** Create a new virtual memory mapping derived from an other virtual memory
  *  mapping.
  *
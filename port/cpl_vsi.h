@@ -303,6 +303,24 @@ void CPL_DLL *VSIMallocAlignedAutoVerbose(size_t nSize, const char *pszFile,
 #define VSI_MALLOC_ALIGNED_AUTO_VERBOSE(size)                                  \
     VSIMallocAlignedAutoVerbose(size, __FILE__, __LINE__)
 
+void CPL_DLL *VSIMallocLarge(size_t nSize) CPL_WARN_UNUSED_RESULT;
+void CPL_DLL *VSICallocLarge(size_t nCount,
+                             size_t nSize) CPL_WARN_UNUSED_RESULT;
+void CPL_DLL VSIFreeLarge(void *ptr);
+
+void CPL_DLL *VSIMallocLargeVerbose(size_t nSize, const char *pszFile,
+                                    int nLine) CPL_WARN_UNUSED_RESULT;
+/** VSIMallocLargeVerbose() with FILE and LINE reporting */
+#define VSI_MALLOC_LARGE_VERBOSE(size)                                         \
+    VSIMallocLargeVerbose(size, __FILE__, __LINE__)
+
+void CPL_DLL *VSICallocLargeVerbose(size_t nCount, size_t nSize,
+                                    const char *pszFile,
+                                    int nLine) CPL_WARN_UNUSED_RESULT;
+/** VSICallocLargeVerbose() with FILE and LINE reporting */
+#define VSI_CALLOC_LARGE_VERBOSE(nCount, nSize)                                \
+    VSICallocLargeVerbose(nCount, nSize, __FILE__, __LINE__)
+
 /**
  VSIMalloc2 allocates (nSize1 * nSize2) bytes.
  In case of overflow of the multiplication, or if memory allocation fails, a
@@ -369,6 +387,10 @@ char CPL_DLL *VSIStrdupVerbose(const char *pszStr, const char *pszFile,
 GIntBig CPL_DLL CPLGetPhysicalRAM(void);
 GIntBig CPL_DLL CPLGetUsablePhysicalRAM(void);
 
+void CPL_DLL CPLAccountMemory(const char *pszCategory, GIntBig nDeltaBytes);
+GIntBig CPL_DLL CPLGetAccountedMemory(const char *pszCategory);
+char CPL_DLL **CPLGetAccountedMemoryCategories(void);
+
 /* ==================================================================== */
 /*      Other...                                                        */
 /* ==================================================================== */
@@ -448,6 +470,10 @@ GIntBig CPL_DLL VSIGetDiskFreeSpace(const char *pszDirname);
 void CPL_DLL VSINetworkStatsReset(void);
 char CPL_DLL *VSINetworkStatsGetAsSerializedJSON(char **papszOptions);
 
+char CPL_DLL *VSIGetStatisticsAsSerializedJSON(const char *pszPrefix,
+                                               CSLConstList papszOptions);
+void CPL_DLL VSIResetStatistics(const char *pszPrefix);
+
 /* ==================================================================== */
 /*      Install special file access handlers.                           */
 /* ==================================================================== */
@@ -474,6 +500,8 @@ void VSIInstallSwiftStreamingFileHandler(void);
 void VSIInstall7zFileHandler(void);   /* No reason to export that */
 void VSIInstallRarFileHandler(void);  /* No reason to export that */
 void VSIInstallGZipFileHandler(void); /* No reason to export that */
+void VSIInstallZstdFileHandler(void); /* No reason to export that */
+void VSIInstallLZ4FileHandler(void);  /* No reason to export that */
 void VSIInstallZipFileHandler(void);  /* No reason to export that */
 void VSIInstallStdinHandler(void);    /* No reason to export that */
 void VSIInstallHdfsHandler(void);     /* No reason to export that */
@@ -27,6 +27,10 @@
  * DEALINGS IN THE SOFTWARE.
  ****************************************************************************/
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include "cpl_port.h"
 #include "cpl_vsi.h"
 #include "cpl_vsi_virtual.h"
@@ -42,6 +46,12 @@
 #include <sys/stat.h>
 #endif
 
+#if defined(__linux) && defined(HAVE_MMAP) && defined(HAVE_5ARGS_MREMAP)
+#define VSIMEM_USE_MMAP
+#include <sys/mman.h>  // mmap, munmap, mremap, madvise, memfd_create
+#include <unistd.h>    // close, ftruncate
+#endif
+
 #include <algorithm>
 #include <map>
 #include <string>
@@ -81,6 +91,14 @@
 **
 ** VSIMemFile: A mutex protects accesses to the file
 **
+** Storage: small files are held in a VSIRealloc()'ed buffer. On Linux,
+** once a file grows beyond CPL_VSIMEM_MMAP_THRESHOLD, its content is moved
+** (once) into an anonymous mapping that is further grown with mremap(),
+** which only remaps pages and never copies them. When CPL_VSIMEM_USE_MEMFD
+** is set, the mapping is a shared mapping of a memfd_create() file
+** descriptor, that is returned by GetNativeFileDescriptor() so that the
+** file can be mapped by other processes (e.g. through /proc/<pid>/fd/<fd>).
+**
 ** VSIMemHandle: This is essentially a "current location" representing
 ** on accessor to a file, and is inherently intended only to be used in
 ** a single thread.
@@ -113,6 +131,13 @@ class VSIMemFile
     vsi_l_offset nAllocLength = 0;
     vsi_l_offset nMaxLength = GUINTBIG_MAX;
 
+    // True if pabyData is a mmap()'ed area (always owned)
+    bool bMapped = false;
+    // memfd_create() file descriptor backing the mapping, or -1
+    int nMemFd = -1;
+    // Size of the memfd file. May be lower than nAllocLength after Flush()
+    vsi_l_offset nMemFdSize = 0;
+
     time_t mTime = 0;
     CPL_SHARED_MUTEX_TYPE m_oMutex{};
 
@@ -120,6 +145,15 @@ class VSIMemFile
     virtual ~VSIMemFile();
 
     bool SetLength(vsi_l_offset nNewSize);
+
+#ifdef VSIMEM_USE_MMAP
+    bool CreateMemFd();
+    bool SyncMemFdSize();
+    void FreeMapping();
+
+  private:
+    bool GrowMapping(vsi_l_offset nNewAlloc);
+#endif
 };
 
 /************************************************************************/
@@ -149,6 +183,8 @@ class VSIMemHandle final : public VSIVirtualHandle
     int Eof() override;
     int Close() override;
     int Truncate(vsi_l_offset nNewSize) override;
+    int Flush() override;
+    void *GetNativeFileDescriptor() override;
 
     bool HasPRead() const override
     {
@@ -225,10 +261,143 @@ VSIMemFile::VSIMemFile()
 
 VSIMemFile::~VSIMemFile()
 {
+#ifdef VSIMEM_USE_MMAP
+    if (bMapped || nMemFd >= 0)
+    {
+        FreeMapping();
+        return;
+    }
+#endif
     if (bOwnData && pabyData)
         CPLFree(pabyData);
 }
 
+#ifdef VSIMEM_USE_MMAP
+
+// Mappings are grown by multiples of the usual size of transparent huge
+// pages.
+constexpr vsi_l_offset VSIMEM_MAPPING_GRANULARITY = 2 * 1024 * 1024;
+
+/************************************************************************/
+/*                            CreateMemFd()                             */
+/************************************************************************/
+
+// Must be called on a still empty file
+bool VSIMemFile::CreateMemFd()
+{
+    CPLAssert(pabyData == nullptr && nMemFd < 0);
+#ifdef HAVE_MEMFD_CREATE
+    nMemFd = memfd_create(CPLGetFilename(osFilename.c_str()), MFD_CLOEXEC);
+    if (nMemFd >= 0)
+        return true;
+    CPLError(CE_Warning, CPLE_AppDefined, "memfd_create() failed: %s",
+             VSIStrerror(errno));
+#else
+    CPLError(CE_Warning, CPLE_NotSupported,
+             "CPL_VSIMEM_USE_MEMFD=YES not supported on this platform");
+#endif
+    return false;
+}
+
+/************************************************************************/
+/*                           SyncMemFdSize()                            */
+/************************************************************************/
+
+// Make the size of the memfd file the one of the /vsimem/ file, so that
+// other processes mapping it see the right size. Must be called under
+// exclusive lock.
+bool VSIMemFile::SyncMemFdSize()
+{
+    if (nMemFd < 0 || nMemFdSize == nLength)
+        return true;
+    if (ftruncate(nMemFd, static_cast<off_t>(nLength)) != 0)
+        return false;
+    nMemFdSize = nLength;
+    return true;
+}
+
+/************************************************************************/
+/*                            GrowMapping()                             */
+/************************************************************************/
+
+// Must be called under exclusive lock
+bool VSIMemFile::GrowMapping(vsi_l_offset nNewAlloc)
+{
+    nNewAlloc = (nNewAlloc + VSIMEM_MAPPING_GRANULARITY - 1) /
+                VSIMEM_MAPPING_GRANULARITY * VSIMEM_MAPPING_GRANULARITY;
+    if (static_cast<vsi_l_offset>(static_cast<size_t>(nNewAlloc)) !=
+            nNewAlloc ||
+        (nMemFd >= 0 && ftruncate(nMemFd, static_cast<off_t>(nNewAlloc)) != 0))
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot extend in-memory file to " CPL_FRMT_GUIB " bytes",
+                 nNewAlloc);
+        return false;
+    }
+    if (nMemFd >= 0)
+        nMemFdSize = nNewAlloc;
+
+    void *pNewData;
+    if (!bMapped)
+    {
+        const int nFlags =
+            nMemFd >= 0 ? MAP_SHARED : (MAP_PRIVATE | MAP_ANONYMOUS);
+        pNewData = mmap(nullptr, static_cast<size_t>(nNewAlloc),
+                        PROT_READ | PROT_WRITE, nFlags, nMemFd, 0);
+    }
+    else
+    {
+        // Only page table entries are moved: the content is not copied.
+        pNewData = mremap(pabyData, static_cast<size_t>(nAllocLength),
+                          static_cast<size_t>(nNewAlloc), MREMAP_MAYMOVE);
+    }
+    if (pNewData == MAP_FAILED)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot extend in-memory file to " CPL_FRMT_GUIB
+                 " bytes: %s",
+                 nNewAlloc, VSIStrerror(errno));
+        return false;
+    }
+#ifdef MADV_HUGEPAGE
+    CPL_IGNORE_RET_VAL(
+        madvise(pNewData, static_cast<size_t>(nNewAlloc), MADV_HUGEPAGE));
+#endif
+
+    if (!bMapped)
+    {
+        // One time copy from the heap buffer used for small files.
+        // Pages of a new mapping are already zero-initialized.
+        if (nLength > 0)
+            memcpy(pNewData, pabyData, static_cast<size_t>(nLength));
+        VSIFree(pabyData);
+        bMapped = true;
+    }
+    pabyData = static_cast<GByte *>(pNewData);
+    nAllocLength = nNewAlloc;
+    return true;
+}
+
+/************************************************************************/
+/*                            FreeMapping()                             */
+/************************************************************************/
+
+void VSIMemFile::FreeMapping()
+{
+    if (bMapped)
+        munmap(pabyData, static_cast<size_t>(nAllocLength));
+    if (nMemFd >= 0)
+        close(nMemFd);
+    bMapped = false;
+    nMemFd = -1;
+    nMemFdSize = 0;
+    pabyData = nullptr;
+    nLength = 0;
+    nAllocLength = 0;
+}
+
+#endif  // VSIMEM_USE_MMAP
+
 /************************************************************************/
 /*                             SetLength()                              */
 /************************************************************************/
@@ -261,6 +430,20 @@ bool VSIMemFile::SetLength(vsi_l_offset nNewLength)
         }
 
         const vsi_l_offset nNewAlloc = (nNewLength + nNewLength / 10) + 5000;
+#ifdef VSIMEM_USE_MMAP
+        const vsi_l_offset nMMapThreshold =
+            static_cast<vsi_l_offset>(CPLAtoGIntBig(CPLGetConfigOption(
+                "CPL_VSIMEM_MMAP_THRESHOLD", "67108864")));
+        if (bMapped || nMemFd >= 0 ||
+            (nMMapThreshold > 0 && nNewLength >= nMMapThreshold))
+        {
+            if (!GrowMapping(nNewAlloc))
+                return false;
+            nLength = nNewLength;
+            time(&mTime);
+            return true;
+        }
+#endif
         GByte *pabyNewData = nullptr;
         if (static_cast<vsi_l_offset>(static_cast<size_t>(nNewAlloc)) ==
             nNewAlloc)
@@ -286,9 +469,45 @@ bool VSIMemFile::SetLength(vsi_l_offset nNewLength)
     }
     else if (nNewLength < nLength)
     {
+#ifdef VSIMEM_USE_MMAP
+        if (bMapped)
+        {
+            // Give whole pages back to the system. They read back as zeroes.
+            const vsi_l_offset nPageSize =
+                static_cast<vsi_l_offset>(sysconf(_SC_PAGESIZE));
+            const vsi_l_offset nStart =
+                (nNewLength + nPageSize - 1) / nPageSize * nPageSize;
+            if (nStart < nLength &&
+                madvise(pabyData + nStart,
+                        static_cast<size_t>(nLength - nStart),
+                        nMemFd >= 0 ? MADV_REMOVE : MADV_DONTNEED) == 0)
+            {
+                memset(pabyData + nNewLength, 0,
+                       static_cast<size_t>(nStart - nNewLength));
+                nLength = nNewLength;
+                time(&mTime);
+                return true;
+            }
+        }
+#endif
         memset(pabyData + nNewLength, 0,
                static_cast<size_t>(nLength - nNewLength));
     }
+#ifdef VSIMEM_USE_MMAP
+    else if (nMemFd >= 0 && nNewLength > nMemFdSize)
+    {
+        // The memfd file may have been shrunk by SyncMemFdSize()
+        if (ftruncate(nMemFd, static_cast<off_t>(nAllocLength)) != 0)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot extend in-memory file to " CPL_FRMT_GUIB
+                     " bytes: %s",
+                     nNewLength, VSIStrerror(errno));
+            return false;
+        }
+        nMemFdSize = nAllocLength;
+    }
+#endif
 
     nLength = nNewLength;
     time(&mTime);
@@ -324,6 +543,13 @@ int VSIMemHandle::Close()
         CPLDebug("VSIMEM", "Closing handle %p on %s: ref_count=%d (before)",
                  this, poFile->osFilename.c_str(),
                  static_cast<int>(poFile.use_count()));
+#endif
+#ifdef VSIMEM_USE_MMAP
+        if (bUpdate && poFile->nMemFd >= 0)
+        {
+            CPL_EXCLUSIVE_LOCK oLock(poFile->m_oMutex);
+            poFile->SyncMemFdSize();
+        }
 #endif
         poFile = nullptr;
     }
@@ -331,6 +557,41 @@ int VSIMemHandle::Close()
     return 0;
 }
 
+/************************************************************************/
+/*                               Flush()                                */
+/************************************************************************/
+
+int VSIMemHandle::Flush()
+
+{
+#ifdef VSIMEM_USE_MMAP
+    if (bUpdate && poFile->nMemFd >= 0)
+    {
+        CPL_EXCLUSIVE_LOCK oLock(poFile->m_oMutex);
+        if (!poFile->SyncMemFdSize())
+            return -1;
+    }
+#endif
+    return 0;
+}
+
+/************************************************************************/
+/*                      GetNativeFileDescriptor()                       */
+/************************************************************************/
+
+void *VSIMemHandle::GetNativeFileDescriptor()
+
+{
+#ifdef VSIMEM_USE_MMAP
+    if (poFile->nMemFd >= 0)
+    {
+        return reinterpret_cast<void *>(
+            static_cast<uintptr_t>(poFile->nMemFd));
+    }
+#endif
+    return nullptr;
+}
+
 /************************************************************************/
 /*                                Seek()                                */
 /************************************************************************/
@@ -615,6 +876,10 @@ VSIVirtualHandle *VSIMemFilesystemHandler::Open(const char *pszFilename,
                  static_cast<int>(poFile.use_count()));
 #endif
         poFile->nMaxLength = nMaxLength;
+#ifdef VSIMEM_USE_MMAP
+        if (CPLTestBool(CPLGetConfigOption("CPL_VSIMEM_USE_MEMFD", "NO")))
+            poFile->CreateMemFd();
+#endif
     }
     // Overwrite
     else if (strstr(pszAccess, "w"))
@@ -1074,6 +1339,11 @@ VSILFILE *VSIFileFromMemBuffer(const char *pszFilename, GByte *pabyData,
  * object will be deleted, and ownership of the buffer will pass to the
  * caller otherwise the underlying file will remain in existence.
  *
+ * When bUnlinkAndSeize is FALSE, no copy is involved. When it is TRUE, files
+ * that have grown beyond CPL_VSIMEM_MMAP_THRESHOLD (and are thus stored in a
+ * memory mapping rather than on the heap) are copied into a buffer that
+ * can be freed with VSIFree().
+ *
  * @param pszFilename the name of the file to grab the buffer of.
  * @param pnDataLength (file) length returned in this variable.
  * @param bUnlinkAndSeize TRUE to remove the file, or FALSE to leave unaltered.
@@ -1106,6 +1376,20 @@ GByte *VSIGetMemFileBuffer(const char *pszFilename, vsi_l_offset *pnDataLength,
 
     if (bUnlinkAndSeize)
     {
+#ifdef VSIMEM_USE_MMAP
+        if (poFile->bMapped)
+        {
+            // The caller will release the buffer with VSIFree(), so it
+            // must be given a heap copy of the mapping.
+            const size_t nSize = static_cast<size_t>(poFile->nLength);
+            pabyData = static_cast<GByte *>(
+                VSI_MALLOC_VERBOSE(std::max<size_t>(1, nSize)));
+            if (pabyData == nullptr)
+                return nullptr;
+            memcpy(pabyData, poFile->pabyData, nSize);
+            poFile->FreeMapping();
+        }
+#endif
         if (!poFile->bOwnData)
             CPLDebug("VSIMemFile",
                      "File doesn't own data in VSIGetMemFileBuffer!");
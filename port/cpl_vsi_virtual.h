@@ -39,10 +39,12 @@
 #include "cpl_string.h"
 #include "cpl_multiproc.h"
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <vector>
 #include <string>
+#include <unordered_set>
 
 // To avoid aliasing to GetDiskFreeSpace to GetDiskFreeSpaceA on Windows
 #ifdef GetDiskFreeSpace
@@ -54,6 +56,72 @@
 #undef CopyFile
 #endif
 
+/************************************************************************/
+/*                       VSIFilesystemStatistics                        */
+/************************************************************************/
+
+#ifndef DOXYGEN_SKIP
+/** I/O counters of a filesystem handler, reported by
+ * VSIGetStatisticsAsSerializedJSON(). They are updated with relaxed atomic
+ * operations, so that collecting them is cheap enough to be always enabled.
+ */
+struct CPL_DLL VSIFilesystemStatistics
+{
+    /** Number of buckets of the latency histograms: < 1 us, [1 us, 10 us[,
+     * ..., [100 ms, 1 s[, >= 1 s */
+    static constexpr int LATENCY_BUCKET_COUNT = 8;
+
+    std::atomic<GIntBig> nOpen{0};
+    std::atomic<GIntBig> nStat{0};
+    std::atomic<GIntBig> nRead{0};
+    std::atomic<GIntBig> nBytesRead{0};
+    std::atomic<GIntBig> nWrite{0};
+    std::atomic<GIntBig> nBytesWritten{0};
+    std::atomic<GIntBig> nReadMultiRange{0};
+    std::atomic<GIntBig> nReadMultiRangeRanges{0};
+    std::atomic<GIntBig> nAdviseRead{0};
+    std::atomic<GIntBig> nAdviseReadRanges{0};
+    std::atomic<GIntBig> nRequests{0};
+    std::atomic<GIntBig> nBytesDownloaded{0};
+    std::atomic<GIntBig> nRetries{0};
+    std::atomic<GIntBig> nCacheHits{0};
+    std::atomic<GIntBig> nCacheMisses{0};
+    std::atomic<GIntBig> anReadLatency[LATENCY_BUCKET_COUNT] = {};
+    std::atomic<GIntBig> anRequestLatency[LATENCY_BUCKET_COUNT] = {};
+
+    static void Increment(std::atomic<GIntBig> &nCounter, GIntBig nVal = 1)
+    {
+        nCounter.fetch_add(nVal, std::memory_order_relaxed);
+    }
+
+    static void AddLatency(std::atomic<GIntBig> *panHistogram,
+                           GIntBig nNanoSec)
+    {
+        int iBucket = 0;
+        for (GIntBig nThreshold = 1000;
+             nNanoSec >= nThreshold && iBucket + 1 < LATENCY_BUCKET_COUNT;
+             nThreshold *= 10)
+        {
+            ++iBucket;
+        }
+        Increment(panHistogram[iBucket]);
+    }
+
+    void AddReadLatency(GIntBig nNanoSec)
+    {
+        AddLatency(anReadLatency, nNanoSec);
+    }
+
+    void AddRequestLatency(GIntBig nNanoSec)
+    {
+        AddLatency(anRequestLatency, nNanoSec);
+    }
+
+    bool HasActivity() const;
+    void Reset();
+};
+#endif
+
 /************************************************************************/
 /*                           VSIVirtualHandle                           */
 /************************************************************************/
@@ -119,6 +187,12 @@ struct CPL_DLL VSIVirtualHandle
     virtual ~VSIVirtualHandle()
     {
     }
+
+#ifndef DOXYGEN_SKIP
+    /** Statistics of the filesystem handler through which the file was
+     * opened with VSIFOpenExL(), or nullptr. */
+    VSIFilesystemStatistics *m_poStatistics = nullptr;
+#endif
 };
 
 /************************************************************************/
@@ -151,12 +225,19 @@ typedef std::unique_ptr<VSIVirtualHandle, VSIVirtualHandleCloser>
 #ifndef DOXYGEN_SKIP
 class CPL_DLL VSIFilesystemHandler
 {
+    VSIFilesystemStatistics m_oStatistics{};
 
   public:
     virtual ~VSIFilesystemHandler()
     {
     }
 
+    /** Return the I/O counters of this handler. */
+    VSIFilesystemStatistics &GetStatistics()
+    {
+        return m_oStatistics;
+    }
+
     VSIVirtualHandle *Open(const char *pszFilename, const char *pszAccess);
 
     virtual VSIVirtualHandle *Open(const char *pszFilename,
@@ -467,6 +548,29 @@ struct CPL_DLL VSIDIR
     VSIDIR &operator=(const VSIDIR &) = delete;
 };
 
+/************************************************************************/
+/*                         VSICachedDirListing                          */
+/************************************************************************/
+
+/* Directory listing, as returned by VSIReadDirCached() */
+struct CPL_DLL VSICachedDirListing
+{
+    /* Result of VSIReadDirEx() */
+    CPLStringList aosFiles{};
+    /* Whether the listing has more entries than the requested maximum */
+    bool bTruncated = false;
+    /* Lower-cased names of aosFiles (empty if bTruncated) */
+    std::unordered_set<std::string> oSetLowerCaseFiles{};
+
+    bool HasFile(const char *pszName) const;
+};
+
+std::shared_ptr<const VSICachedDirListing>
+    CPL_DLL VSIReadDirCached(const char *pszPath, int nMaxFiles,
+                             double dfTTLSeconds);
+
+void CPL_DLL VSIInvalidateCachedDirListing(const char *pszPath);
+
 #endif /* #ifndef DOXYGEN_SKIP */
 
 VSIVirtualHandle CPL_DLL *
@@ -41,6 +41,8 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <limits>
 #include <map>
 #include <memory>
@@ -52,8 +54,10 @@
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_json.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
+#include "cpl_trace.h"
 #include "cpl_vsi_virtual.h"
 #include "cpl_vsil_curl_class.h"
 
@@ -127,6 +131,173 @@ char **VSIReadDirEx(const char *pszPath, int nMaxFiles)
     return poFSHandler->ReadDirEx(pszPath, nMaxFiles);
 }
 
+/************************************************************************/
+/*                      VSICachedDirListing::HasFile()                  */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+
+/* Return whether the listing contains an entry with the given name,
+ * compared case-insensitively. Constant time when the listing is not
+ * truncated. */
+bool VSICachedDirListing::HasFile(const char *pszName) const
+{
+    if (bTruncated)
+        return aosFiles.FindString(pszName) >= 0;
+    return oSetLowerCaseFiles.find(CPLString(pszName).tolower()) !=
+           oSetLowerCaseFiles.end();
+}
+
+/************************************************************************/
+/*                         VSIDirListingCache                           */
+/************************************************************************/
+
+namespace
+{
+struct VSIDirListingCacheEntry
+{
+    std::shared_ptr<const VSICachedDirListing> poListing{};
+    int nMaxFiles = 0;
+    std::chrono::steady_clock::time_point oTime{};
+};
+
+constexpr size_t VSI_DIR_LISTING_CACHE_MAX_ENTRIES = 64;
+
+struct VSIDirListingCache
+{
+    std::mutex oMutex{};
+    std::map<std::string, VSIDirListingCacheEntry> oMap{};
+    // Incremented at each invalidation, to detect listings that might be
+    // outdated when they are about to be inserted.
+    GUIntBig nGeneration = 0;
+    // Allows VSIInvalidateCachedDirListing() to skip locking when nothing
+    // is cached.
+    std::atomic<bool> bNotEmpty{false};
+};
+
+VSIDirListingCache &GetDirListingCache()
+{
+    static VSIDirListingCache oCache;
+    return oCache;
+}
+
+std::string VSIDirListingCacheKey(const char *pszPath)
+{
+    std::string osKey(pszPath);
+    while (osKey.size() > 1 && (osKey.back() == '/' || osKey.back() == '\\'))
+        osKey.pop_back();
+    return osKey;
+}
+}  // namespace
+
+/************************************************************************/
+/*                          VSIReadDirCached()                          */
+/************************************************************************/
+
+/* Return the result of VSIReadDirEx(pszPath, nMaxFiles), together with an
+ * index of its entries, from a process-wide cache if it has been listed less
+ * than dfTTLSeconds ago. The cache entries of a directory are invalidated
+ * when files are created, removed or renamed in it through the VSI API of
+ * the current process. No caching is done if dfTTLSeconds <= 0. */
+std::shared_ptr<const VSICachedDirListing>
+VSIReadDirCached(const char *pszPath, int nMaxFiles, double dfTTLSeconds)
+{
+    auto &oCache = GetDirListingCache();
+    const std::string osKey(VSIDirListingCacheKey(pszPath));
+    const auto oNow = std::chrono::steady_clock::now();
+    GUIntBig nGeneration = 0;
+    if (dfTTLSeconds > 0)
+    {
+        std::lock_guard<std::mutex> oLock(oCache.oMutex);
+        const auto oIter = oCache.oMap.find(osKey);
+        if (oIter != oCache.oMap.end() &&
+            oIter->second.nMaxFiles == nMaxFiles &&
+            std::chrono::duration<double>(oNow - oIter->second.oTime).count() <
+                dfTTLSeconds)
+        {
+            return oIter->second.poListing;
+        }
+        nGeneration = oCache.nGeneration;
+    }
+
+    // List the directory outside of the lock.
+    auto poListing = std::make_shared<VSICachedDirListing>();
+    poListing->aosFiles.Assign(VSIReadDirEx(pszPath, nMaxFiles), true);
+    poListing->bTruncated =
+        nMaxFiles > 0 && poListing->aosFiles.size() > nMaxFiles;
+    if (!poListing->bTruncated)
+    {
+        poListing->oSetLowerCaseFiles.reserve(poListing->aosFiles.size());
+        for (const char *pszFile : poListing->aosFiles)
+            poListing->oSetLowerCaseFiles.insert(CPLString(pszFile).tolower());
+    }
+
+    if (dfTTLSeconds > 0)
+    {
+        std::lock_guard<std::mutex> oLock(oCache.oMutex);
+        if (nGeneration == oCache.nGeneration)
+        {
+            if (oCache.oMap.size() >= VSI_DIR_LISTING_CACHE_MAX_ENTRIES &&
+                oCache.oMap.find(osKey) == oCache.oMap.end())
+            {
+                // Evict the oldest listing
+                auto oOldestIter = oCache.oMap.begin();
+                for (auto oIter = oCache.oMap.begin();
+                     oIter != oCache.oMap.end(); ++oIter)
+                {
+                    if (oIter->second.oTime < oOldestIter->second.oTime)
+                        oOldestIter = oIter;
+                }
+                oCache.oMap.erase(oOldestIter);
+            }
+            auto &oEntry = oCache.oMap[osKey];
+            oEntry.poListing = poListing;
+            oEntry.nMaxFiles = nMaxFiles;
+            oEntry.oTime = oNow;
+            oCache.bNotEmpty = true;
+        }
+    }
+
+    return poListing;
+}
+
+/************************************************************************/
+/*                   VSIInvalidateCachedDirListing()                    */
+/************************************************************************/
+
+/* Invalidate the cached listings of the directory of pszPath, of pszPath
+ * itself if it is a directory, and of its sub-directories. */
+void VSIInvalidateCachedDirListing(const char *pszPath)
+{
+    auto &oCache = GetDirListingCache();
+    if (!oCache.bNotEmpty)
+        return;
+
+    const std::string osPath(VSIDirListingCacheKey(pszPath));
+    const std::string osDir(VSIDirListingCacheKey(CPLGetDirname(pszPath)));
+
+    std::lock_guard<std::mutex> oLock(oCache.oMutex);
+    ++oCache.nGeneration;
+    for (auto oIter = oCache.oMap.begin(); oIter != oCache.oMap.end();)
+    {
+        const std::string &osKey = oIter->first;
+        if (osKey == osDir || osKey == osPath ||
+            (osKey.size() > osPath.size() &&
+             osKey.compare(0, osPath.size(), osPath) == 0 &&
+             (osKey[osPath.size()] == '/' || osKey[osPath.size()] == '\\')))
+        {
+            oIter = oCache.oMap.erase(oIter);
+        }
+        else
+        {
+            ++oIter;
+        }
+    }
+    oCache.bNotEmpty = !oCache.oMap.empty();
+}
+
+//! @endcond
+
 /************************************************************************/
 /*                             VSISiblingFiles()                        */
 /************************************************************************/
@@ -379,7 +550,9 @@ int VSIMkdir(const char *pszPathname, long mode)
 {
     VSIFilesystemHandler *poFSHandler = VSIFileManager::GetHandler(pszPathname);
 
-    return poFSHandler->Mkdir(pszPathname, mode);
+    const int nRet = poFSHandler->Mkdir(pszPathname, mode);
+    VSIInvalidateCachedDirListing(pszPathname);
+    return nRet;
 }
 
 /************************************************************************/
@@ -452,7 +625,9 @@ int VSIUnlink(const char *pszFilename)
 {
     VSIFilesystemHandler *poFSHandler = VSIFileManager::GetHandler(pszFilename);
 
-    return poFSHandler->Unlink(pszFilename);
+    const int nRet = poFSHandler->Unlink(pszFilename);
+    VSIInvalidateCachedDirListing(pszFilename);
+    return nRet;
 }
 
 /************************************************************************/
@@ -497,7 +672,10 @@ int *VSIUnlinkBatch(CSLConstList papszFiles)
     }
     if (poFSHandler == nullptr)
         return nullptr;
-    return poFSHandler->UnlinkBatch(papszFiles);
+    int *panRet = poFSHandler->UnlinkBatch(papszFiles);
+    for (CSLConstList papszIter = papszFiles; *papszIter; ++papszIter)
+        VSIInvalidateCachedDirListing(*papszIter);
+    return panRet;
 }
 
 /************************************************************************/
@@ -527,7 +705,10 @@ int VSIRename(const char *oldpath, const char *newpath)
 {
     VSIFilesystemHandler *poFSHandler = VSIFileManager::GetHandler(oldpath);
 
-    return poFSHandler->Rename(oldpath, newpath);
+    const int nRet = poFSHandler->Rename(oldpath, newpath);
+    VSIInvalidateCachedDirListing(oldpath);
+    VSIInvalidateCachedDirListing(newpath);
+    return nRet;
 }
 
 /************************************************************************/
@@ -583,9 +764,11 @@ int VSICopyFile(const char *pszSource, const char *pszTarget,
 
     VSIFilesystemHandler *poFSHandlerTarget =
         VSIFileManager::GetHandler(pszTarget);
-    return poFSHandlerTarget->CopyFile(pszSource, pszTarget, fpSource,
-                                       nSourceSize, papszOptions, pProgressFunc,
-                                       pProgressData);
+    const int nRet = poFSHandlerTarget->CopyFile(
+        pszSource, pszTarget, fpSource, nSourceSize, papszOptions,
+        pProgressFunc, pProgressData);
+    VSIInvalidateCachedDirListing(pszTarget);
+    return nRet;
 }
 
 /************************************************************************/
@@ -692,10 +875,11 @@ int VSISync(const char *pszSource, const char *pszTarget,
         poFSHandler = poFSHandlerTarget;
     }
 
-    return poFSHandler->Sync(pszSource, pszTarget, papszOptions, pProgressFunc,
-                             pProgressData, ppapszOutputs)
-               ? TRUE
-               : FALSE;
+    const bool bRet =
+        poFSHandler->Sync(pszSource, pszTarget, papszOptions, pProgressFunc,
+                          pProgressData, ppapszOutputs);
+    VSIInvalidateCachedDirListing(pszTarget);
+    return bRet ? TRUE : FALSE;
 }
 
 /************************************************************************/
@@ -750,7 +934,9 @@ int VSIRmdir(const char *pszDirname)
 {
     VSIFilesystemHandler *poFSHandler = VSIFileManager::GetHandler(pszDirname);
 
-    return poFSHandler->Rmdir(pszDirname);
+    const int nRet = poFSHandler->Rmdir(pszDirname);
+    VSIInvalidateCachedDirListing(pszDirname);
+    return nRet;
 }
 
 /************************************************************************/
@@ -779,7 +965,9 @@ int VSIRmdirRecursive(const char *pszDirname)
         return -1;
     }
     VSIFilesystemHandler *poFSHandler = VSIFileManager::GetHandler(pszDirname);
-    return poFSHandler->RmdirRecursive(pszDirname);
+    const int nRet = poFSHandler->RmdirRecursive(pszDirname);
+    VSIInvalidateCachedDirListing(pszDirname);
+    return nRet;
 }
 
 /************************************************************************/
@@ -870,6 +1058,7 @@ int VSIStatExL(const char *pszFilename, VSIStatBufL *psStatBuf, int nFlags)
         nFlags =
             VSI_STAT_EXISTS_FLAG | VSI_STAT_NATURE_FLAG | VSI_STAT_SIZE_FLAG;
 
+    VSIFilesystemStatistics::Increment(poFSHandler->GetStatistics().nStat);
     return poFSHandler->Stat(pszFilename, psStatBuf, nFlags);
 }
 
@@ -2006,6 +2195,18 @@ VSILFILE *VSIFOpenEx2L(const char *pszFilename, const char *pszAccess,
 
     VSILFILE *fp = poFSHandler->Open(pszFilename, pszAccess,
                                      CPL_TO_BOOL(bSetError), papszOptions);
+    if (fp)
+    {
+        fp->m_poStatistics = &(poFSHandler->GetStatistics());
+        VSIFilesystemStatistics::Increment(fp->m_poStatistics->nOpen);
+    }
+
+    // Opening in write or append mode might create the file.
+    if (fp && (strchr(pszAccess, 'w') || strchr(pszAccess, 'a') ||
+               strchr(pszAccess, '+')))
+    {
+        VSIInvalidateCachedDirListing(pszFilename);
+    }
 
     VSIDebug4("VSIFOpenEx2L(%s,%s,%d) = %p", pszFilename, pszAccess, bSetError,
               fp);
@@ -2268,7 +2469,22 @@ int VSIFFlushL(VSILFILE *fp)
 size_t VSIFReadL(void *pBuffer, size_t nSize, size_t nCount, VSILFILE *fp)
 
 {
-    return fp->Read(pBuffer, nSize, nCount);
+    CPLTraceSpan oSpan("vsi", "VSIFReadL");
+    oSpan.AddArg("size", static_cast<GIntBig>(nSize * nCount));
+    VSIFilesystemStatistics *poStats = fp->m_poStatistics;
+    if (poStats == nullptr)
+        return fp->Read(pBuffer, nSize, nCount);
+
+    const auto nStart = std::chrono::steady_clock::now();
+    const size_t nRet = fp->Read(pBuffer, nSize, nCount);
+    poStats->AddReadLatency(static_cast<GIntBig>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - nStart)
+            .count()));
+    VSIFilesystemStatistics::Increment(poStats->nRead);
+    VSIFilesystemStatistics::Increment(poStats->nBytesRead,
+                                       static_cast<GIntBig>(nRet * nSize));
+    return nRet;
 }
 
 /************************************************************************/
@@ -2327,7 +2543,30 @@ int VSIFReadMultiRangeL(int nRanges, void **ppData,
                         const vsi_l_offset *panOffsets, const size_t *panSizes,
                         VSILFILE *fp)
 {
-    return fp->ReadMultiRange(nRanges, ppData, panOffsets, panSizes);
+    CPLTraceSpan oSpan("vsi", "VSIFReadMultiRangeL");
+    oSpan.AddArg("ranges", nRanges);
+    VSIFilesystemStatistics *poStats = fp->m_poStatistics;
+    if (poStats == nullptr)
+        return fp->ReadMultiRange(nRanges, ppData, panOffsets, panSizes);
+
+    const auto nStart = std::chrono::steady_clock::now();
+    const int nRet =
+        fp->ReadMultiRange(nRanges, ppData, panOffsets, panSizes);
+    poStats->AddReadLatency(static_cast<GIntBig>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - nStart)
+            .count()));
+    VSIFilesystemStatistics::Increment(poStats->nReadMultiRange);
+    VSIFilesystemStatistics::Increment(poStats->nReadMultiRangeRanges,
+                                       nRanges);
+    if (nRet == 0)
+    {
+        GIntBig nBytes = 0;
+        for (int i = 0; i < nRanges; ++i)
+            nBytes += static_cast<GIntBig>(panSizes[i]);
+        VSIFilesystemStatistics::Increment(poStats->nBytesRead, nBytes);
+    }
+    return nRet;
 }
 
 /************************************************************************/
@@ -2379,7 +2618,15 @@ size_t VSIFWriteL(const void *pBuffer, size_t nSize, size_t nCount,
                   VSILFILE *fp)
 
 {
-    return fp->Write(pBuffer, nSize, nCount);
+    const size_t nRet = fp->Write(pBuffer, nSize, nCount);
+    if (fp->m_poStatistics)
+    {
+        VSIFilesystemStatistics::Increment(fp->m_poStatistics->nWrite);
+        VSIFilesystemStatistics::Increment(
+            fp->m_poStatistics->nBytesWritten,
+            static_cast<GIntBig>(nRet * nSize));
+    }
+    return nRet;
 }
 
 /************************************************************************/
@@ -2928,6 +3175,234 @@ char **VSIGetFileSystemsPrefixes(void)
     return VSIFileManager::GetPrefixes();
 }
 
+/************************************************************************/
+/*                 VSIFilesystemStatistics::HasActivity()               */
+/************************************************************************/
+
+bool VSIFilesystemStatistics::HasActivity() const
+{
+    return nOpen.load(std::memory_order_relaxed) != 0 ||
+           nStat.load(std::memory_order_relaxed) != 0 ||
+           nRequests.load(std::memory_order_relaxed) != 0 ||
+           nAdviseRead.load(std::memory_order_relaxed) != 0;
+}
+
+/************************************************************************/
+/*                    VSIFilesystemStatistics::Reset()                  */
+/************************************************************************/
+
+void VSIFilesystemStatistics::Reset()
+{
+    for (auto *pnCounter :
+         {&nOpen, &nStat, &nRead, &nBytesRead, &nWrite, &nBytesWritten,
+          &nReadMultiRange, &nReadMultiRangeRanges, &nAdviseRead,
+          &nAdviseReadRanges, &nRequests, &nBytesDownloaded, &nRetries,
+          &nCacheHits, &nCacheMisses})
+    {
+        pnCounter->store(0, std::memory_order_relaxed);
+    }
+    for (int i = 0; i < LATENCY_BUCKET_COUNT; ++i)
+    {
+        anReadLatency[i].store(0, std::memory_order_relaxed);
+        anRequestLatency[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+/************************************************************************/
+/*                      VSIGetStatisticsHandlers()                      */
+/************************************************************************/
+
+// Return the (prefix, handler) pairs matching pszPrefix, or all of them if
+// pszPrefix is null or empty. A handler registered under several prefixes
+// is only returned once. The default handler is reported as "/".
+static std::vector<std::pair<std::string, VSIFilesystemHandler *>>
+VSIGetStatisticsHandlers(const char *pszPrefix)
+{
+    std::vector<std::pair<std::string, VSIFilesystemHandler *>> aoRet;
+    std::set<VSIFilesystemHandler *> oSetHandlers;
+    const bool bAll = pszPrefix == nullptr || pszPrefix[0] == '\0';
+    VSIFilesystemHandler *poRequested =
+        bAll ? nullptr : VSIFileManager::GetHandler(pszPrefix);
+
+    const CPLStringList aosPrefixes(VSIFileManager::GetPrefixes());
+    for (const char *pszHandlerPrefix : aosPrefixes)
+    {
+        auto poHandler = VSIFileManager::GetHandler(pszHandlerPrefix);
+        if ((bAll || poHandler == poRequested) &&
+            oSetHandlers.insert(poHandler).second)
+        {
+            aoRet.emplace_back(pszHandlerPrefix, poHandler);
+        }
+    }
+    auto poDefault = VSIFileManager::GetHandler("");
+    if (poDefault && (bAll || poDefault == poRequested) &&
+        oSetHandlers.insert(poDefault).second)
+    {
+        aoRet.emplace_back("/", poDefault);
+    }
+    return aoRet;
+}
+
+/************************************************************************/
+/*                  VSIGetStatisticsAsSerializedJSON()                  */
+/************************************************************************/
+
+/**
+ * \brief Return I/O statistics of virtual file system handlers, as a JSON
+ * serialized object.
+ *
+ * Contrary to VSINetworkStatsGetAsSerializedJSON(), those statistics are
+ * always collected. They are counted at the level of the VSI*L() functions
+ * (VSIFOpenL(), VSIStatL(), VSIFReadL(), VSIFWriteL(),
+ * VSIFReadMultiRangeL()), for files opened with VSIFOpenL() or
+ * VSIFOpenExL(), and, for network file systems, at the level of the HTTP
+ * requests they issue.
+ *
+ * The returned object has a member for each file system prefix with
+ * activity. Example of output:
+ * <pre>
+ * {
+ *   "\/vsicurl\/":{
+ *     "open_count":1,
+ *     "stat_count":2,
+ *     "read":{
+ *       "count":12,
+ *       "bytes":24576,
+ *       "latency_histogram":{
+ *         "lt_1us":6,
+ *         "1us_10us":3,
+ *         "10us_100us":0,
+ *         "100us_1ms":0,
+ *         "1ms_10ms":0,
+ *         "10ms_100ms":3,
+ *         "100ms_1s":0,
+ *         "ge_1s":0
+ *       }
+ *     },
+ *     "write":{ "count":0, "bytes":0 },
+ *     "read_multi_range":{ "count":1, "range_count":4 },
+ *     "advise_read":{ "count":0, "range_count":0 },
+ *     "requests":{
+ *       "count":4,
+ *       "downloaded_bytes":65536,
+ *       "retry_count":0,
+ *       "latency_histogram":{ ... }
+ *     },
+ *     "cache":{ "hit_count":10, "miss_count":3 }
+ *   }
+ * }
+ * </pre>
+ *
+ * The "requests" and "cache" members are only present for network file
+ * systems.
+ *
+ * @param pszPrefix File system prefix, such as "/vsis3/", or a path from
+ * which the file system is deduced. If NULL or empty, all file systems with
+ * activity are reported.
+ * @param papszOptions Unused. Should be NULL.
+ * @return a JSON serialized string to free with VSIFree().
+ * @since GDAL 3.9
+ */
+
+char *VSIGetStatisticsAsSerializedJSON(const char *pszPrefix,
+                                       CPL_UNUSED CSLConstList papszOptions)
+{
+    const auto Load = [](const std::atomic<GIntBig> &nCounter)
+    { return nCounter.load(std::memory_order_relaxed); };
+
+    const auto GetHistogram = [&Load](const std::atomic<GIntBig> *panBuckets)
+    {
+        static const char *const apszBucketNames[] = {
+            "lt_1us",   "1us_10us",   "10us_100us", "100us_1ms",
+            "1ms_10ms", "10ms_100ms", "100ms_1s",   "ge_1s"};
+        static_assert(CPL_ARRAYSIZE(apszBucketNames) ==
+                          VSIFilesystemStatistics::LATENCY_BUCKET_COUNT,
+                      "bucket names mismatch");
+        CPLJSONObject oHistogram;
+        for (int i = 0; i < VSIFilesystemStatistics::LATENCY_BUCKET_COUNT;
+             ++i)
+        {
+            oHistogram.Add(apszBucketNames[i], Load(panBuckets[i]));
+        }
+        return oHistogram;
+    };
+
+    CPLJSONObject oRoot;
+    for (const auto &oIter : VSIGetStatisticsHandlers(pszPrefix))
+    {
+        const auto &oStats = oIter.second->GetStatistics();
+        if (!oStats.HasActivity())
+            continue;
+
+        CPLJSONObject oFS;
+        oFS.Add("open_count", Load(oStats.nOpen));
+        oFS.Add("stat_count", Load(oStats.nStat));
+
+        CPLJSONObject oRead;
+        oRead.Add("count", Load(oStats.nRead));
+        oRead.Add("bytes", Load(oStats.nBytesRead));
+        oRead.Add("latency_histogram", GetHistogram(oStats.anReadLatency));
+        oFS.Add("read", oRead);
+
+        CPLJSONObject oWrite;
+        oWrite.Add("count", Load(oStats.nWrite));
+        oWrite.Add("bytes", Load(oStats.nBytesWritten));
+        oFS.Add("write", oWrite);
+
+        CPLJSONObject oMultiRange;
+        oMultiRange.Add("count", Load(oStats.nReadMultiRange));
+        oMultiRange.Add("range_count", Load(oStats.nReadMultiRangeRanges));
+        oFS.Add("read_multi_range", oMultiRange);
+
+        CPLJSONObject oAdviseRead;
+        oAdviseRead.Add("count", Load(oStats.nAdviseRead));
+        oAdviseRead.Add("range_count", Load(oStats.nAdviseReadRanges));
+        oFS.Add("advise_read", oAdviseRead);
+
+        if (Load(oStats.nRequests) != 0 || Load(oStats.nCacheHits) != 0 ||
+            Load(oStats.nCacheMisses) != 0)
+        {
+            CPLJSONObject oRequests;
+            oRequests.Add("count", Load(oStats.nRequests));
+            oRequests.Add("downloaded_bytes", Load(oStats.nBytesDownloaded));
+            oRequests.Add("retry_count", Load(oStats.nRetries));
+            oRequests.Add("latency_histogram",
+                          GetHistogram(oStats.anRequestLatency));
+            oFS.Add("requests", oRequests);
+
+            CPLJSONObject oCache;
+            oCache.Add("hit_count", Load(oStats.nCacheHits));
+            oCache.Add("miss_count", Load(oStats.nCacheMisses));
+            oFS.Add("cache", oCache);
+        }
+
+        oRoot.Add(oIter.first, oFS);
+    }
+    return CPLStrdup(oRoot.Format(CPLJSONObject::PrettyFormat::Pretty).c_str());
+}
+
+/************************************************************************/
+/*                        VSIResetStatistics()                          */
+/************************************************************************/
+
+/**
+ * \brief Reset the I/O statistics of virtual file system handlers.
+ *
+ * @param pszPrefix File system prefix, such as "/vsis3/", or a path from
+ * which the file system is deduced. If NULL or empty, the statistics of all
+ * file systems are reset.
+ * @see VSIGetStatisticsAsSerializedJSON()
+ * @since GDAL 3.9
+ */
+
+void VSIResetStatistics(const char *pszPrefix)
+{
+    for (const auto &oIter : VSIGetStatisticsHandlers(pszPrefix))
+    {
+        oIter.second->GetStatistics().Reset();
+    }
+}
+
 /************************************************************************/
 /*                     VSIGetFileSystemOptions()                        */
 /************************************************************************/
@@ -3227,6 +3702,8 @@ VSIFileManager *VSIFileManager::Get()
     VSIInstallGZipFileHandler();
     VSIInstallZipFileHandler();
 #endif
+    VSIInstallZstdFileHandler();
+    VSIInstallLZ4FileHandler();
 #ifdef HAVE_LIBARCHIVE
     VSIInstall7zFileHandler();
     VSIInstallRarFileHandler();
@@ -3344,6 +3821,9 @@ void VSIFileManager::RemoveHandler(const std::string &osPrefix)
 void VSICleanupFileManager()
 
 {
+    // The trace file may be written through a virtual file system
+    CPLTraceStop();
+
     if (poManager)
     {
         delete poManager;
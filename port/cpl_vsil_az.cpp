@@ -600,6 +600,17 @@ class VSIAzureFSHandler final : public IVSIS3LikeFSHandler
 
     // Multipart upload (mapping of S3 interface to PutBlock/PutBlockList)
 
+    std::string GetWriteOptionPrefix() const override
+    {
+        return "VSIAZ";
+    }
+
+    struct curl_slist *
+    AddSinglePartPUTHeaders(struct curl_slist *headers) const override
+    {
+        return curl_slist_append(headers, "x-ms-blob-type: BlockBlob");
+    }
+
     bool SupportsParallelMultipartUpload() const override
     {
         return true;
@@ -723,6 +734,23 @@ VSIVirtualHandleUniquePtr
 VSIAzureFSHandler::CreateWriteHandle(const char *pszFilename,
                                      CSLConstList papszOptions)
 {
+    // Pipelined upload of block blobs, through PutBlock/PutBlockList
+    if (atoi(VSIGetPathSpecificOption(pszFilename,
+                                      "VSIAZ_UPLOAD_PARTS_IN_FLIGHT", "1")) > 1)
+    {
+        auto poHandleHelper =
+            CreateHandleHelper(pszFilename + GetFSPrefix().size(), false);
+        if (poHandleHelper == nullptr)
+            return nullptr;
+        auto poHandle = std::make_unique<VSIS3WriteHandle>(
+            this, pszFilename, poHandleHelper, false, papszOptions);
+        if (!poHandle->IsOK())
+        {
+            return nullptr;
+        }
+        return VSIVirtualHandleUniquePtr(poHandle.release());
+    }
+
     VSIAzureBlobHandleHelper *poHandleHelper =
         VSIAzureBlobHandleHelper::BuildFromURI(
             pszFilename + GetFSPrefix().size(), GetFSPrefix().c_str());
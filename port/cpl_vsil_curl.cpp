@@ -32,9 +32,11 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <set>
 #include <map>
 #include <memory>
+#include <mutex>
 
 #include "cpl_aws.h"
 #include "cpl_json.h"
@@ -43,10 +45,12 @@
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "cpl_time.h"
+#include "cpl_trace.h"
 #include "cpl_vsi.h"
 #include "cpl_vsi_virtual.h"
 #include "cpl_http.h"
 #include "cpl_mem_cache.h"
+#include "cpl_sha256.h"
 
 #ifndef S_IRUSR
 #define S_IRUSR 00400
@@ -139,6 +143,30 @@ void VSICurlAuthParametersChanged()
 namespace cpl
 {
 
+/************************************************************************/
+/*                       LogRequestStatistics()                         */
+/************************************************************************/
+
+// Account for nCount HTTP requests, totalling nBytes downloaded, in the
+// statistics of poFS. If ptStart is not null, it is the start time of a single
+// request, whose latency is then recorded.
+static void
+LogRequestStatistics(VSIFilesystemHandler *poFS, GIntBig nCount, size_t nBytes,
+                     const std::chrono::steady_clock::time_point *ptStart)
+{
+    auto &oStats = poFS->GetStatistics();
+    VSIFilesystemStatistics::Increment(oStats.nRequests, nCount);
+    VSIFilesystemStatistics::Increment(oStats.nBytesDownloaded,
+                                       static_cast<GIntBig>(nBytes));
+    if (ptStart)
+    {
+        oStats.AddRequestLatency(static_cast<GIntBig>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - *ptStart)
+                .count()));
+    }
+}
+
 // Do not access those variables directly !
 // Use VSICURLGetDownloadChunkSize() and GetMaxRegions()
 static int N_MAX_REGIONS_DO_NOT_USE_DIRECTLY = 0;
@@ -1145,6 +1173,7 @@ retry:
 
     unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_FILETIME, 1);
 
+    const auto tStart = std::chrono::steady_clock::now();
     MultiPerform(hCurlMultiHandle, hCurlHandle);
 
     VSICURLResetHeaderAndWriterFunctions(hCurlHandle);
@@ -1160,6 +1189,7 @@ retry:
         NetworkStatisticsLogger::LogGET(sWriteFuncData.nSize);
     else
         NetworkStatisticsLogger::LogHEAD();
+    LogRequestStatistics(poFS, 1, sWriteFuncData.nSize, &tStart);
 
     if (STARTS_WITH(osURL.c_str(), "ftp"))
     {
@@ -1452,6 +1482,8 @@ retry:
                 CPLSleep(dfRetryDelay);
                 dfRetryDelay = dfNewRetryDelay;
                 nRetryCount++;
+                VSIFilesystemStatistics::Increment(
+                    poFS->GetStatistics().nRetries);
                 CPLFree(sWriteFuncData.pBuffer);
                 CPLFree(sWriteFuncHeaderData.pBuffer);
                 curl_easy_cleanup(hCurlHandle);
@@ -1679,6 +1711,119 @@ struct CurrentDownload
 };
 }  // namespace
 
+/************************************************************************/
+/*                         HostTransferStats                            */
+/************************************************************************/
+
+// Running estimates of the latency and throughput observed for each host,
+// used to size the read-ahead of sequential reads in VSICurlHandle::Read().
+
+namespace
+{
+struct HostTransferStats
+{
+    double dfRTT = 0;         // in seconds
+    double dfThroughput = 0;  // in bytes per second
+};
+}  // namespace
+
+static std::mutex &GetHostTransferStatsMutex()
+{
+    static std::mutex oMutex;
+    return oMutex;
+}
+
+static std::map<std::string, HostTransferStats> &GetHostTransferStats()
+{
+    static std::map<std::string, HostTransferStats> oMap;
+    return oMap;
+}
+
+static std::string GetHostFromURL(const char *pszURL)
+{
+    const char *pszHostStart = strstr(pszURL, "://");
+    if (pszHostStart == nullptr)
+        return std::string();
+    const char *pszHostEnd = strchr(pszHostStart + 3, '/');
+    return pszHostEnd ? std::string(pszURL, pszHostEnd - pszURL)
+                      : std::string(pszURL);
+}
+
+/************************************************************************/
+/*                      UpdateHostTransferStats()                       */
+/************************************************************************/
+
+static void UpdateHostTransferStats(const char *pszURL, CURL *hCurlHandle,
+                                    size_t nDownloadedBytes)
+{
+    curl_off_t nPreTransferTime = 0;
+    curl_off_t nStartTransferTime = 0;
+    curl_off_t nTotalTime = 0;
+    if (nDownloadedBytes == 0 ||
+        curl_easy_getinfo(hCurlHandle, CURLINFO_PRETRANSFER_TIME_T,
+                          &nPreTransferTime) != CURLE_OK ||
+        curl_easy_getinfo(hCurlHandle, CURLINFO_STARTTRANSFER_TIME_T,
+                          &nStartTransferTime) != CURLE_OK ||
+        curl_easy_getinfo(hCurlHandle, CURLINFO_TOTAL_TIME_T, &nTotalTime) !=
+            CURLE_OK ||
+        nStartTransferTime < nPreTransferTime ||
+        nTotalTime <= nPreTransferTime)
+    {
+        return;
+    }
+
+    // Time between the request being sent and the first byte received.
+    const double dfRTT =
+        static_cast<double>(nStartTransferTime - nPreTransferTime) * 1e-6;
+    // Effective throughput, latency included. It under-estimates the link
+    // bandwidth for small requests, which makes read-ahead sizes grow
+    // progressively rather than jump to a possibly excessive value.
+    const double dfThroughput = static_cast<double>(nDownloadedBytes) /
+                                (static_cast<double>(nTotalTime -
+                                                     nPreTransferTime) *
+                                 1e-6);
+
+    const std::string osHost(GetHostFromURL(pszURL));
+    std::lock_guard<std::mutex> oLock(GetHostTransferStatsMutex());
+    auto oIter = GetHostTransferStats().find(osHost);
+    if (oIter == GetHostTransferStats().end())
+    {
+        auto &oStats = GetHostTransferStats()[osHost];
+        oStats.dfRTT = dfRTT;
+        oStats.dfThroughput = dfThroughput;
+    }
+    else
+    {
+        // Exponentially weighted moving average
+        constexpr double ALPHA = 0.25;
+        oIter->second.dfRTT = (1 - ALPHA) * oIter->second.dfRTT + ALPHA * dfRTT;
+        oIter->second.dfThroughput =
+            (1 - ALPHA) * oIter->second.dfThroughput + ALPHA * dfThroughput;
+    }
+}
+
+/************************************************************************/
+/*                       GetReadAheadSizeForHost()                      */
+/************************************************************************/
+
+// Number of bytes to request so that the latency accounts for at most about
+// 20% of the duration of a request.
+static double GetReadAheadSize(const HostTransferStats &oStats)
+{
+    constexpr double TRANSFER_TO_LATENCY_RATIO = 4;
+    return TRANSFER_TO_LATENCY_RATIO * oStats.dfRTT * oStats.dfThroughput;
+}
+
+// Returns 0 if there is no estimate yet for that host.
+static double GetReadAheadSizeForHost(const std::string &osHost)
+{
+    std::lock_guard<std::mutex> oLock(GetHostTransferStatsMutex());
+    const auto oIter = GetHostTransferStats().find(osHost);
+    if (oIter == GetHostTransferStats().end())
+        return 0;
+    return GetReadAheadSize(oIter->second);
+}
+
 /************************************************************************/
 /*                      NotifyStartDownloadRegion()                     */
 /************************************************************************/
@@ -1774,6 +1919,13 @@ void VSICurlFilesystemHandlerBase::NotifyStopDownloadRegion(
 std::string VSICurlHandle::DownloadRegion(const vsi_l_offset startOffset,
                                           const int nBlocks)
 {
+    CPLTraceSpan oSpan("http", "VSICurlHandle::DownloadRegion");
+    if (oSpan.IsEnabled())
+    {
+        oSpan.AddArg("offset", static_cast<GIntBig>(startOffset));
+        oSpan.AddArg("blocks", nBlocks);
+    }
+
     if (bInterrupted && bStopOnInterruptUntilUninstall)
         return std::string();
 
@@ -1862,6 +2014,7 @@ retry:
 
     unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_FILETIME, 1);
 
+    const auto tStart = std::chrono::steady_clock::now();
     MultiPerform(hCurlMultiHandle, hCurlHandle);
 
     VSICURLResetHeaderAndWriterFunctions(hCurlHandle);
@@ -1869,6 +2022,8 @@ retry:
     curl_slist_free_all(headers);
 
     NetworkStatisticsLogger::LogGET(sWriteFuncData.nSize);
+    LogRequestStatistics(poFS, 1, sWriteFuncData.nSize, &tStart);
+    UpdateHostTransferStats(m_pszURL, hCurlHandle, sWriteFuncData.nSize);
 
     if (sWriteFuncData.bInterrupted)
     {
@@ -1970,6 +2125,7 @@ retry:
             CPLSleep(dfRetryDelay);
             dfRetryDelay = dfNewRetryDelay;
             nRetryCount++;
+            VSIFilesystemStatistics::Increment(poFS->GetStatistics().nRetries);
             CPLFree(sWriteFuncData.pBuffer);
             CPLFree(sWriteFuncHeaderData.pBuffer);
             curl_easy_cleanup(hCurlHandle);
@@ -2187,6 +2343,92 @@ void VSICurlHandle::DownloadRegionPostProcess(const vsi_l_offset startOffset,
     }
 }
 
+/************************************************************************/
+/*                     DownloadRegionsInParallel()                      */
+/************************************************************************/
+
+// Download CPL_VSIL_CURL_PARALLEL_READ_PARTS consecutive parts of nBlocks
+// chunks each, starting at startOffset, with parallel GET requests, and add
+// them to the region cache. On success, osFirstPart is set with the content
+// of the first part, consistently with DownloadRegion().
+// Returns false if that mode cannot be used (in which case the caller should
+// use DownloadRegion()).
+
+bool VSICurlHandle::DownloadRegionsInParallel(const vsi_l_offset startOffset,
+                                              const int nBlocks,
+                                              std::string &osFirstPart)
+{
+    // The region cache must be large enough to hold all parts.
+    const int nMaxParts =
+        std::min(atoi(CPLGetConfigOption("CPL_VSIL_CURL_PARALLEL_READ_PARTS",
+                                         "4")),
+                 GetMaxRegions() / nBlocks);
+    if (nMaxParts <= 1 || !oFileProp.bHasComputedFileSize ||
+        startOffset >= oFileProp.fileSize)
+    {
+        return false;
+    }
+
+    const size_t nPartSize =
+        static_cast<size_t>(nBlocks) * VSICURLGetDownloadChunkSize();
+    std::vector<vsi_l_offset> anOffsets;
+    std::vector<size_t> anSizes;
+    for (int i = 0; i < nMaxParts; ++i)
+    {
+        const vsi_l_offset nOffset =
+            startOffset + static_cast<vsi_l_offset>(i) * nPartSize;
+        if (nOffset >= oFileProp.fileSize)
+            break;
+        anOffsets.push_back(nOffset);
+        anSizes.push_back(static_cast<size_t>(std::min<vsi_l_offset>(
+            nPartSize, oFileProp.fileSize - nOffset)));
+    }
+    if (anOffsets.size() <= 1)
+        return false;
+
+    std::string osBuffer;
+    try
+    {
+        osBuffer.resize(static_cast<size_t>(anOffsets.back() - startOffset) +
+                        anSizes.back());
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+    std::vector<void *> apData;
+    for (const auto nOffset : anOffsets)
+        apData.push_back(&osBuffer[static_cast<size_t>(nOffset - startOffset)]);
+
+    const int nParts = static_cast<int>(anOffsets.size());
+    {
+        // On failure, we will retry with DownloadRegion(), which has a
+        // more elaborate error handling (retries, redirects, etc.).
+        CPLErrorStateBackuper oErrorStateBackuper;
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        // ReadMultiRangeParallel() may fallback to Seek() + Read() calls if
+        // the redirect URL has expired, so preserve the state of Read().
+        const vsi_l_offset nSavedOffset = curOffset;
+        const bool bSavedEOF = bEOF;
+        const int nRet = ReadMultiRangeParallel(
+            nParts, apData.data(), anOffsets.data(), anSizes.data(),
+            /* bMergeConsecutiveRanges = */ false);
+        curOffset = nSavedOffset;
+        bEOF = bSavedEOF;
+        if (nRet != 0)
+            return false;
+    }
+
+    for (int i = 0; i < nParts; ++i)
+    {
+        DownloadRegionPostProcess(anOffsets[i], nBlocks,
+                                  static_cast<const char *>(apData[i]),
+                                  anSizes[i]);
+    }
+    osFirstPart.assign(osBuffer.data(), anSizes[0]);
+    return true;
+}
+
 /************************************************************************/
 /*                                Read()                                */
 /************************************************************************/
@@ -2212,6 +2454,7 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
     vsi_l_offset iterOffset = curOffset;
     const int knMAX_REGIONS = GetMaxRegions();
     const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+    constexpr int MAX_CHUNK_SIZE_INCREASE_FACTOR = 128;
     while (nBufferRequestSize)
     {
         // Don't try to read after end of file.
@@ -2235,19 +2478,36 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
             poFS->GetRegion(m_pszURL, nOffsetToDownload);
         if (psRegion != nullptr)
         {
+            NetworkStatisticsLogger::LogCacheHit();
+            VSIFilesystemStatistics::Increment(
+                poFS->GetStatistics().nCacheHits);
             osRegion = *psRegion;
         }
         else
         {
+            NetworkStatisticsLogger::LogCacheMiss();
+            VSIFilesystemStatistics::Increment(
+                poFS->GetStatistics().nCacheMisses);
             if (nOffsetToDownload == lastDownloadedOffset)
             {
                 // In case of consecutive reads (of small size), we use a
                 // heuristic that we will read the file sequentially, so
                 // we double the requested size to decrease the number of
                 // client/server roundtrips.
-                constexpr int MAX_CHUNK_SIZE_INCREASE_FACTOR = 128;
                 if (nBlocksToDownload < MAX_CHUNK_SIZE_INCREASE_FACTOR)
                     nBlocksToDownload *= 2;
+
+                // And if we have measured the latency and throughput of the
+                // server, directly go to the size that amortizes latency.
+                const double dfReadAheadBlocks =
+                    GetReadAheadSizeForHost(GetHostFromURL(m_pszURL)) /
+                    knDOWNLOAD_CHUNK_SIZE;
+                if (dfReadAheadBlocks > nBlocksToDownload)
+                {
+                    nBlocksToDownload = static_cast<int>(
+                        std::min<double>(dfReadAheadBlocks,
+                                         MAX_CHUNK_SIZE_INCREASE_FACTOR));
+                }
             }
             else
             {
@@ -2288,7 +2548,18 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
             if (nBlocksToDownload > knMAX_REGIONS)
                 nBlocksToDownload = knMAX_REGIONS;
 
-            osRegion = DownloadRegion(nOffsetToDownload, nBlocksToDownload);
+            // Once the read-ahead has reached its maximum size, fetch
+            // several parts of that size in parallel, as a single stream
+            // of a HTTP connection is often far from saturating the
+            // available bandwidth.
+            if (nBlocksToDownload < MAX_CHUNK_SIZE_INCREASE_FACTOR ||
+                !DownloadRegionsInParallel(nOffsetToDownload,
+                                           MAX_CHUNK_SIZE_INCREASE_FACTOR,
+                                           osRegion))
+            {
+                osRegion =
+                    DownloadRegion(nOffsetToDownload, nBlocksToDownload);
+            }
             if (osRegion.empty())
             {
                 if (!bInterrupted)
@@ -2366,6 +2637,25 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
                                                 panSizes);
     }
 
+    const bool bMergeConsecutiveRanges = CPLTestBool(
+        CPLGetConfigOption("GDAL_HTTP_MERGE_CONSECUTIVE_RANGES", "TRUE"));
+
+    return ReadMultiRangeParallel(nRanges, ppData, panOffsets, panSizes,
+                                  bMergeConsecutiveRanges);
+}
+
+/************************************************************************/
+/*                       ReadMultiRangeParallel()                       */
+/************************************************************************/
+
+// Issue one GET request per range (or group of consecutive ranges if
+// bMergeConsecutiveRanges), all in parallel.
+int VSICurlHandle::ReadMultiRangeParallel(int const nRanges,
+                                          void **const ppData,
+                                          const vsi_l_offset *const panOffsets,
+                                          const size_t *const panSizes,
+                                          bool bMergeConsecutiveRanges)
+{
     ManagePlanetaryComputerSigning();
 
     bool bHasExpired = false;
@@ -2377,20 +2667,6 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
     }
 
     CURLM *hMultiHandle = poFS->GetCurlMultiHandleFor(osURL);
-#ifdef CURLPIPE_MULTIPLEX
-    // Enable HTTP/2 multiplexing (ignored if an older version of HTTP is
-    // used)
-    // Not that this does not enable HTTP/1.1 pipeling, which is not
-    // recommended for example by Google Cloud Storage.
-    // For HTTP/1.1, parallel connections work better since you can get
-    // results out of order.
-    if (CPLTestBool(CPLGetConfigOption("GDAL_HTTP_MULTIPLEX", "YES")))
-    {
-        curl_multi_setopt(hMultiHandle, CURLMOPT_PIPELINING,
-                          CURLPIPE_MULTIPLEX);
-    }
-#endif
-
     std::vector<CURL *> aHandles;
     std::vector<WriteFuncStruct> asWriteFuncData(nRanges);
     std::vector<WriteFuncStruct> asWriteFuncHeaderData(nRanges);
@@ -2403,9 +2679,6 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
     };
     std::vector<CurlErrBuffer> asCurlErrors(nRanges);
 
-    const bool bMergeConsecutiveRanges = CPLTestBool(
-        CPLGetConfigOption("GDAL_HTTP_MERGE_CONSECUTIVE_RANGES", "TRUE"));
-
     for (int i = 0, iRequest = 0; i < nRanges;)
     {
         size_t nSize = 0;
@@ -2587,6 +2860,8 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
     }
 
     NetworkStatisticsLogger::LogGET(nTotalDownloaded);
+    LogRequestStatistics(poFS, static_cast<GIntBig>(aHandles.size()),
+                         nTotalDownloaded, nullptr);
 
     if (ENABLE_DEBUG)
         CPLDebug(poFS->GetDebugKey(), "Download completed");
@@ -2698,6 +2973,7 @@ int VSICurlHandle::ReadMultiRangeSingleGet(int const nRanges,
     headers = VSICurlMergeHeaders(headers, GetCurlHeaders("GET", headers));
     unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HTTPHEADER, headers);
 
+    const auto tStart = std::chrono::steady_clock::now();
     MultiPerform(hCurlMultiHandle, hCurlHandle);
 
     VSICURLResetHeaderAndWriterFunctions(hCurlHandle);
@@ -2705,6 +2981,7 @@ int VSICurlHandle::ReadMultiRangeSingleGet(int const nRanges,
     curl_slist_free_all(headers);
 
     NetworkStatisticsLogger::LogGET(sWriteFuncData.nSize);
+    LogRequestStatistics(poFS, 1, sWriteFuncData.nSize, &tStart);
 
     if (sWriteFuncData.bInterrupted)
     {
@@ -3094,6 +3371,7 @@ size_t VSICurlHandle::PRead(void *pBuffer, size_t nSize,
 
     CURLM *hMultiHandle = poFS->GetCurlMultiHandleFor(osURL);
     curl_multi_add_handle(hMultiHandle, hCurlHandle);
+    const auto tStart = std::chrono::steady_clock::now();
     MultiPerform(hMultiHandle);
 
     {
@@ -3137,6 +3415,7 @@ size_t VSICurlHandle::PRead(void *pBuffer, size_t nSize,
     curl_slist_free_all(headers);
 
     NetworkStatisticsLogger::LogGET(sWriteFuncData.nSize);
+    LogRequestStatistics(poFS, 1, sWriteFuncData.nSize, &tStart);
 
 #if 0
     if( ENABLE_DEBUG )
@@ -3153,6 +3432,10 @@ size_t VSICurlHandle::PRead(void *pBuffer, size_t nSize,
 void VSICurlHandle::AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
                                const size_t *panSizes)
 {
+    auto &oStats = poFS->GetStatistics();
+    VSIFilesystemStatistics::Increment(oStats.nAdviseRead);
+    VSIFilesystemStatistics::Increment(oStats.nAdviseReadRanges, nRanges);
+
     if (!CPLTestBool(
             CPLGetConfigOption("GDAL_HTTP_ENABLE_ADVISE_READ", "TRUE")))
         return;
@@ -3247,26 +3530,13 @@ void VSICurlHandle::AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
 
     const auto task = [this](const std::string &osURL)
     {
-        CURLM *hMultiHandle = curl_multi_init();
+        CURLM *hMultiHandle =
+            static_cast<CURLM *>(CPLHTTPCreateMultiHandle());
 
         NetworkStatisticsFileSystem oContextFS(poFS->GetFSPrefix().c_str());
         NetworkStatisticsFile oContextFile(m_osFilename.c_str());
         NetworkStatisticsAction oContextAction("AdviseRead");
 
-#ifdef CURLPIPE_MULTIPLEX
-        // Enable HTTP/2 multiplexing (ignored if an older version of HTTP is
-        // used)
-        // Not that this does not enable HTTP/1.1 pipeling, which is not
-        // recommended for example by Google Cloud Storage.
-        // For HTTP/1.1, parallel connections work better since you can get
-        // results out of order.
-        if (CPLTestBool(CPLGetConfigOption("GDAL_HTTP_MULTIPLEX", "YES")))
-        {
-            curl_multi_setopt(hMultiHandle, CURLMOPT_PIPELINING,
-                              CURLPIPE_MULTIPLEX);
-        }
-#endif
-
         std::vector<CURL *> aHandles;
         std::vector<WriteFuncStruct> asWriteFuncData(
             m_aoAdviseReadRanges.size());
@@ -3462,6 +3732,8 @@ void VSICurlHandle::AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
         }
 
         NetworkStatisticsLogger::LogGET(nTotalDownloaded);
+        LogRequestStatistics(poFS, static_cast<GIntBig>(aHandles.size()),
+                             nTotalDownloaded, nullptr);
 
         curl_multi_cleanup(hMultiHandle);
     };
@@ -3637,7 +3909,8 @@ CURLM *VSICurlFilesystemHandlerBase::GetCurlMultiHandleFor(
     auto &conn = GetConnectionCache()[this];
     if (conn.hCurlMultiHandle == nullptr)
     {
-        conn.hCurlMultiHandle = curl_multi_init();
+        conn.hCurlMultiHandle =
+            static_cast<CURLM *>(CPLHTTPCreateMultiHandle());
     }
     return conn.hCurlMultiHandle;
 }
@@ -3658,6 +3931,144 @@ VSICurlFilesystemHandlerBase::GetRegionCache()
     return m_poRegionCacheDoNotUseDirectly.get();
 }
 
+/************************************************************************/
+/*                      AccountRegionCacheMemory()                      */
+/************************************************************************/
+
+// Updates the size of the region cache accounted with CPLAccountMemory().
+void VSICurlFilesystemHandlerBase::AccountRegionCacheMemory()
+{
+    // should be called under hMutex taken
+    GIntBig nBytes = 0;
+    const auto lambda =
+        [&nBytes](const lru11::KeyValuePair<FilenameOffsetPair,
+                                            std::shared_ptr<std::string>> &kv)
+    { nBytes += static_cast<GIntBig>(kv.value->size()); };
+    GetRegionCache()->cwalk(lambda);
+    CPLAccountMemory("vsicurl.region_cache",
+                     nBytes - m_nRegionCacheAccountedBytes);
+    m_nRegionCacheAccountedBytes = nBytes;
+}
+
+/************************************************************************/
+/*                       GetDiskCacheFilename()                         */
+/************************************************************************/
+
+// The persistent disk cache (CPL_VSIL_CURL_CACHE_DIR) stores one file per
+// downloaded chunk. Its name is the SHA256 of a key made of the URL, the
+// validators of the remote file (ETag, Last-Modified, size) as returned by the
+// last HEAD/GET request of this process, and the chunk offset and size.
+// The key is also written at the beginning of the file, followed by a nul
+// character and the chunk content, to be robust to hash collisions.
+// Returns an empty string if the disk cache is disabled, or if the remote
+// file has no validator.
+
+static std::string GetDiskCacheFilename(const char *pszURL,
+                                        vsi_l_offset nFileOffsetStart,
+                                        std::string &osKey)
+{
+    const char *pszCacheDir =
+        CPLGetConfigOption("CPL_VSIL_CURL_CACHE_DIR", nullptr);
+    if (pszCacheDir == nullptr || pszCacheDir[0] == '\0')
+        return std::string();
+
+    FileProp oFileProp;
+    if (!VSICURLGetCachedFileProp(pszURL, oFileProp) ||
+        oFileProp.eExists != EXIST_YES || oFileProp.bIsDirectory ||
+        (oFileProp.ETag.empty() && oFileProp.mTime == 0))
+    {
+        return std::string();
+    }
+
+    osKey = pszURL;
+    osKey += '\n';
+    osKey += oFileProp.ETag;
+    osKey += CPLSPrintf("\n" CPL_FRMT_GIB "\n" CPL_FRMT_GUIB "\n" CPL_FRMT_GUIB
+                        "\n%d",
+                        static_cast<GIntBig>(oFileProp.mTime),
+                        static_cast<GUIntBig>(oFileProp.fileSize),
+                        static_cast<GUIntBig>(nFileOffsetStart),
+                        VSICURLGetDownloadChunkSize());
+
+    GByte abyHash[CPL_SHA256_HASH_SIZE];
+    CPL_SHA256(osKey.data(), osKey.size(), abyHash);
+    std::string osHash;
+    for (const GByte b : abyHash)
+        osHash += CPLSPrintf("%02x", b);
+    return CPLFormFilename(pszCacheDir, osHash.c_str(), "bin");
+}
+
+/************************************************************************/
+/*                       TrimDiskCacheIfNeeded()                        */
+/************************************************************************/
+
+// Remove the oldest chunks of the disk cache once its size exceeds
+// CPL_VSIL_CURL_CACHE_DIR_MAX_SIZE. To avoid listing the directory at each
+// write, this is only done once a tenth of the maximum size has been written
+// by this process since the last check (and at the first write).
+
+static void TrimDiskCacheIfNeeded(const char *pszCacheDir, size_t nWritten)
+{
+    static std::mutex oMutex;
+    static GIntBig nWrittenSinceLastCheck = -1;
+
+    const GIntBig nMaxSize = std::max<GIntBig>(
+        0, CPLAtoGIntBig(CPLGetConfigOption("CPL_VSIL_CURL_CACHE_DIR_MAX_SIZE",
+                                            "1073741824")));
+    {
+        std::lock_guard<std::mutex> oLock(oMutex);
+        if (nWrittenSinceLastCheck >= 0)
+        {
+            nWrittenSinceLastCheck += static_cast<GIntBig>(nWritten);
+            if (nWrittenSinceLastCheck < nMaxSize / 10)
+                return;
+        }
+        nWrittenSinceLastCheck = 0;
+    }
+
+    struct Entry
+    {
+        std::string osFilename;
+        GIntBig nMTime;
+        GIntBig nSize;
+    };
+
+    std::vector<Entry> aoEntries;
+    GIntBig nTotalSize = 0;
+    const CPLStringList aosFiles(VSIReadDir(pszCacheDir));
+    for (const char *pszFile : aosFiles)
+    {
+        if (!EQUAL(CPLGetExtension(pszFile), "bin"))
+            continue;
+        const std::string osFilename =
+            CPLFormFilename(pszCacheDir, pszFile, nullptr);
+        VSIStatBufL sStat;
+        if (VSIStatL(osFilename.c_str(), &sStat) == 0)
+        {
+            aoEntries.push_back({osFilename,
+                                 static_cast<GIntBig>(sStat.st_mtime),
+                                 static_cast<GIntBig>(sStat.st_size)});
+            nTotalSize += static_cast<GIntBig>(sStat.st_size);
+        }
+    }
+    if (nTotalSize <= nMaxSize)
+        return;
+
+    std::sort(aoEntries.begin(), aoEntries.end(),
+              [](const Entry &a, const Entry &b)
+              { return a.nMTime < b.nMTime; });
+    // Evict a bit more than strictly needed, to avoid trimming too often
+    const GIntBig nTargetSize = nMaxSize / 10 * 9;
+    for (const auto &oEntry : aoEntries)
+    {
+        if (nTotalSize <= nTargetSize)
+            break;
+        // Might fail if another process has just removed it
+        VSIUnlink(oEntry.osFilename.c_str());
+        nTotalSize -= oEntry.nSize;
+    }
+}
+
 /************************************************************************/
 /*                          GetRegion()                                 */
 /************************************************************************/
@@ -3666,16 +4077,49 @@ std::shared_ptr<std::string>
 VSICurlFilesystemHandlerBase::GetRegion(const char *pszURL,
                                         vsi_l_offset nFileOffsetStart)
 {
-    CPLMutexHolder oHolder(&hMutex);
-
     const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
     nFileOffsetStart =
         (nFileOffsetStart / knDOWNLOAD_CHUNK_SIZE) * knDOWNLOAD_CHUNK_SIZE;
 
-    std::shared_ptr<std::string> out;
-    if (GetRegionCache()->tryGet(
-            FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), out))
     {
+        CPLMutexHolder oHolder(&hMutex);
+
+        std::shared_ptr<std::string> out;
+        if (GetRegionCache()->tryGet(
+                FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), out))
+        {
+            return out;
+        }
+    }
+
+    std::string osKey;
+    const std::string osCacheFilename =
+        GetDiskCacheFilename(pszURL, nFileOffsetStart, osKey);
+    if (!osCacheFilename.empty())
+    {
+        GByte *pabyContent = nullptr;
+        vsi_l_offset nContentSize = 0;
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        const bool bOK = VSIIngestFile(
+            nullptr, osCacheFilename.c_str(), &pabyContent, &nContentSize,
+            static_cast<GIntBig>(osKey.size()) + 1 + knDOWNLOAD_CHUNK_SIZE);
+        CPLPopErrorHandler();
+        CPLErrorReset();
+        std::shared_ptr<std::string> out;
+        if (bOK && nContentSize > osKey.size() &&
+            memcmp(pabyContent, osKey.data(), osKey.size()) == 0 &&
+            pabyContent[osKey.size()] == '\0')
+        {
+            out = std::make_shared<std::string>(
+                reinterpret_cast<const char *>(pabyContent) + osKey.size() + 1,
+                static_cast<size_t>(nContentSize - osKey.size() - 1));
+
+            CPLMutexHolder oHolder(&hMutex);
+            GetRegionCache()->insert(
+                FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), out);
+            AccountRegionCacheMemory();
+        }
+        VSIFree(pabyContent);
         return out;
     }
 
@@ -3690,12 +4134,51 @@ void VSICurlFilesystemHandlerBase::AddRegion(const char *pszURL,
                                              vsi_l_offset nFileOffsetStart,
                                              size_t nSize, const char *pData)
 {
-    CPLMutexHolder oHolder(&hMutex);
+    {
+        CPLMutexHolder oHolder(&hMutex);
 
-    std::shared_ptr<std::string> value(new std::string());
-    value->assign(pData, nSize);
-    GetRegionCache()->insert(
-        FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), value);
+        std::shared_ptr<std::string> value(new std::string());
+        value->assign(pData, nSize);
+        GetRegionCache()->insert(
+            FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), value);
+        AccountRegionCacheMemory();
+    }
+
+    std::string osKey;
+    const std::string osCacheFilename =
+        GetDiskCacheFilename(pszURL, nFileOffsetStart, osKey);
+    if (osCacheFilename.empty())
+        return;
+
+    // Write to a temporary file that is atomically renamed, so that
+    // concurrent processes never see a partially written chunk.
+    const std::string osCacheDir = CPLGetPath(osCacheFilename.c_str());
+    const std::string osTmpFilename(
+        CPLSPrintf("%s.%d." CPL_FRMT_GIB ".tmp", osCacheFilename.c_str(),
+                   CPLGetCurrentProcessID(), CPLGetPID()));
+    VSILFILE *fp = VSIFOpenL(osTmpFilename.c_str(), "wb");
+    if (fp == nullptr)
+    {
+        VSIMkdirRecursive(osCacheDir.c_str(), 0755);
+        fp = VSIFOpenL(osTmpFilename.c_str(), "wb");
+        if (fp == nullptr)
+        {
+            CPLDebug(GetDebugKey(), "Cannot write in cache directory %s",
+                     osCacheDir.c_str());
+            return;
+        }
+    }
+    bool bOK = VSIFWriteL(osKey.c_str(), osKey.size() + 1, 1, fp) == 1;
+    bOK &= nSize == 0 || VSIFWriteL(pData, nSize, 1, fp) == 1;
+    bOK &= VSIFCloseL(fp) == 0;
+    if (!bOK ||
+        VSIRename(osTmpFilename.c_str(), osCacheFilename.c_str()) != 0)
+    {
+        VSIUnlink(osTmpFilename.c_str());
+        return;
+    }
+
+    TrimDiskCacheIfNeeded(osCacheDir.c_str(), osKey.size() + 1 + nSize);
 }
 
 /************************************************************************/
@@ -3825,6 +4308,7 @@ void VSICurlFilesystemHandlerBase::InvalidateCachedData(const char *pszURL)
     poRegionCache->cwalk(lambda);
     for (const auto &key : keysToRemove)
         poRegionCache->remove(key);
+    AccountRegionCacheMemory();
 }
 
 /************************************************************************/
@@ -3836,6 +4320,7 @@ void VSICurlFilesystemHandlerBase::ClearCache()
     CPLMutexHolder oHolder(&hMutex);
 
     GetRegionCache()->clear();
+    AccountRegionCacheMemory();
 
     {
         const auto lambda = [](const lru11::KeyValuePair<std::string, bool> &kv)
@@ -3875,6 +4360,7 @@ void VSICurlFilesystemHandlerBase::PartialClearCache(
         poRegionCache->cwalk(lambda);
         for (const auto &key : keysToRemove)
             poRegionCache->remove(key);
+        AccountRegionCacheMemory();
     }
 
     {
@@ -4006,8 +4492,9 @@ const char *VSICurlFilesystemHandlerBase::GetOptions()
 
 bool VSICurlFilesystemHandlerBase::IsAllowedFilename(const char *pszFilename)
 {
-    const char *pszAllowedFilename =
-        CPLGetConfigOption("CPL_VSIL_CURL_ALLOWED_FILENAME", nullptr);
+    static CPLConfigOptionCache oAllowedFilename(
+        "CPL_VSIL_CURL_ALLOWED_FILENAME", nullptr);
+    const char *pszAllowedFilename = oAllowedFilename.Get();
     if (pszAllowedFilename != nullptr)
     {
         return strcmp(pszFilename, pszAllowedFilename) == 0;
@@ -4021,8 +4508,9 @@ bool VSICurlFilesystemHandlerBase::IsAllowedFilename(const char *pszFilename)
     // For example:
     // gdalinfo --config CPL_VSIL_CURL_ALLOWED_EXTENSIONS ".tif"
     // /vsicurl/http://igskmncngs506.cr.usgs.gov/gmted/Global_tiles_GMTED/075darcsec/bln/W030/30N030W_20101117_gmted_bln075.tif
-    const char *pszAllowedExtensions =
-        CPLGetConfigOption("CPL_VSIL_CURL_ALLOWED_EXTENSIONS", nullptr);
+    static CPLConfigOptionCache oAllowedExtensions(
+        "CPL_VSIL_CURL_ALLOWED_EXTENSIONS", nullptr);
+    const char *pszAllowedExtensions = oAllowedExtensions.Get();
     if (pszAllowedExtensions)
     {
         char **papszExtensions =
@@ -4811,7 +5299,9 @@ char **VSICurlFilesystemHandlerBase::GetFileList(const char *pszDirname,
             unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HTTPHEADER,
                                        headers);
 
+            const auto tStart = std::chrono::steady_clock::now();
             MultiPerform(hCurlMultiHandle, hCurlHandle);
+            LogRequestStatistics(this, 1, sWriteFuncData.nSize, &tStart);
 
             curl_slist_free_all(headers);
 
@@ -4970,11 +5460,13 @@ char **VSICurlFilesystemHandlerBase::GetFileList(const char *pszDirname,
 
         unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HTTPHEADER, headers);
 
+        const auto tStart = std::chrono::steady_clock::now();
         MultiPerform(hCurlMultiHandle, hCurlHandle);
 
         curl_slist_free_all(headers);
 
         NetworkStatisticsLogger::LogGET(sWriteFuncData.nSize);
+        LogRequestStatistics(this, 1, sWriteFuncData.nSize, &tStart);
 
         if (sWriteFuncData.pBuffer == nullptr)
         {
@@ -5729,6 +6221,28 @@ void NetworkStatisticsLogger::LogPOST(size_t nUploadedBytes,
     }
 }
 
+void NetworkStatisticsLogger::LogCacheHit()
+{
+    if (!IsEnabled())
+        return;
+    std::lock_guard<std::mutex> oLock(gInstance.m_mutex);
+    for (auto counters : gInstance.GetCountersForContext())
+    {
+        counters->nCacheHits++;
+    }
+}
+
+void NetworkStatisticsLogger::LogCacheMiss()
+{
+    if (!IsEnabled())
+        return;
+    std::lock_guard<std::mutex> oLock(gInstance.m_mutex);
+    for (auto counters : gInstance.GetCountersForContext())
+    {
+        counters->nCacheMisses++;
+    }
+}
+
 void NetworkStatisticsLogger::LogDELETE()
 {
     if (!IsEnabled())
@@ -5742,9 +6256,14 @@ void NetworkStatisticsLogger::LogDELETE()
 
 void NetworkStatisticsLogger::Reset()
 {
-    std::lock_guard<std::mutex> oLock(gInstance.m_mutex);
-    gInstance.m_stats = Stats();
-    gnEnabled = -1;
+    {
+        std::lock_guard<std::mutex> oLock(gInstance.m_mutex);
+        gInstance.m_stats = Stats();
+        gnEnabled = -1;
+    }
+
+    std::lock_guard<std::mutex> oLock(GetHostTransferStatsMutex());
+    GetHostTransferStats().clear();
 }
 
 void NetworkStatisticsLogger::Stats::AsJSON(CPLJSONObject &oJSON) const
@@ -5769,6 +6288,13 @@ void NetworkStatisticsLogger::Stats::AsJSON(CPLJSONObject &oJSON) const
     if (counters.nDELETE)
         oMethods.Add("DELETE/count", counters.nDELETE);
     oJSON.Add("methods", oMethods);
+    if (counters.nCacheHits || counters.nCacheMisses)
+    {
+        CPLJSONObject oCache;
+        oCache.Add("hit_count", counters.nCacheHits);
+        oCache.Add("miss_count", counters.nCacheMisses);
+        oJSON.Add("cache", oCache);
+    }
     CPLJSONObject oFiles;
     bool bFilesAdded = false;
     for (const auto &kv : children)
@@ -5806,6 +6332,25 @@ std::string NetworkStatisticsLogger::GetReportAsSerializedJSON()
 
     CPLJSONObject oJSON;
     gInstance.m_stats.AsJSON(oJSON);
+
+    {
+        std::lock_guard<std::mutex> oLockHosts(GetHostTransferStatsMutex());
+        if (!GetHostTransferStats().empty())
+        {
+            CPLJSONObject oHosts;
+            for (const auto &kv : GetHostTransferStats())
+            {
+                CPLJSONObject oHost;
+                oHost.Add("rtt_ms", kv.second.dfRTT * 1000);
+                oHost.Add("throughput_bytes_per_sec", kv.second.dfThroughput);
+                oHost.Add("read_ahead_bytes",
+                          static_cast<GIntBig>(GetReadAheadSize(kv.second)));
+                oHosts.AddNoSplitName(kv.first.c_str(), oHost);
+            }
+            oJSON.Add("hosts", oHosts);
+        }
+    }
+
     return oJSON.Format(CPLJSONObject::PrettyFormat::Pretty);
 }
 
@@ -6258,11 +6803,25 @@ void VSINetworkStatsReset(void)
  *     "vsis3":{
  *          [...]
  *     }
+ *   },
+ *   "hosts":{
+ *     "https:\/\/storage.googleapis.com":{
+ *       "rtt_ms":35.2,
+ *       "throughput_bytes_per_sec":1854210.0,
+ *       "read_ahead_bytes":261073
+ *     }
  *   }
  * }
 
  * </pre>
  *
+ * Starting with GDAL 3.9, a "cache" object with "hit_count" and "miss_count"
+ * members reports how many chunks requested by Read() were found or not in
+ * the cache of downloaded data. The "hosts" object reports, for each server,
+ * the latency and throughput estimates and the resulting read-ahead size
+ * used for sequential reads (those estimates are reset by
+ * VSINetworkStatsReset()).
+ *
  * @param papszOptions Unused.
  * @return a JSON serialized string to free with VSIFree(), or nullptr
  * @since GDAL 3.2.0
@@ -38,6 +38,7 @@
 #include "cpl_string.h"
 #include "cpl_vsil_curl_priv.h"
 #include "cpl_mem_cache.h"
+#include "cpl_worker_thread_pool.h"
 
 #include "cpl_curl_priv.h"
 
@@ -195,6 +196,10 @@ class VSICurlFilesystemHandlerBase : public VSIFilesystemHandler
                                             // GetRegionCache();
     RegionCacheType *GetRegionCache();
 
+    // Size of the region cache accounted with CPLAccountMemory()
+    GIntBig m_nRegionCacheAccountedBytes = 0;
+    void AccountRegionCacheMemory();
+
     // LRU cache that just keeps in memory if this file system handler is
     // spposed to know the file properties of a file. The actual cache is a
     // shared one among all network file systems.
@@ -416,6 +421,12 @@ class VSICurlHandle : public VSIVirtualHandle
     int ReadMultiRangeSingleGet(int nRanges, void **ppData,
                                 const vsi_l_offset *panOffsets,
                                 const size_t *panSizes);
+    int ReadMultiRangeParallel(int nRanges, void **ppData,
+                               const vsi_l_offset *panOffsets,
+                               const size_t *panSizes,
+                               bool bMergeConsecutiveRanges);
+    bool DownloadRegionsInParallel(vsi_l_offset startOffset, int nBlocks,
+                                   std::string &osFirstPart);
     std::string GetRedirectURLIfValid(bool &bHasExpired) const;
 
     void UpdateRedirectInfo(CURL *hCurlHandle,
@@ -565,6 +576,8 @@ class IVSIS3LikeFSHandler : public VSICurlFilesystemHandlerBaseWritable
 {
     CPL_DISALLOW_COPY_ASSIGN(IVSIS3LikeFSHandler)
 
+    friend class VSIS3WriteHandle;
+
     virtual int MkdirInternal(const char *pszDirname, long nMode,
                               bool bDoStatCheck);
 
@@ -586,6 +599,19 @@ class IVSIS3LikeFSHandler : public VSICurlFilesystemHandlerBaseWritable
         return false;
     }
 
+    // Prefix of the VSIxxx_CHUNK_SIZE, etc. configuration options
+    virtual std::string GetWriteOptionPrefix() const
+    {
+        return std::string("VSI") + GetDebugKey();
+    }
+
+    // Headers to add to the PUT request creating a small object in one go
+    virtual struct curl_slist *
+    AddSinglePartPUTHeaders(struct curl_slist *headers) const
+    {
+        return headers;
+    }
+
     IVSIS3LikeFSHandler() = default;
 
   public:
@@ -698,9 +724,16 @@ class VSIS3WriteHandle final : public VSIVirtualHandle
     GByte *m_pabyBuffer = nullptr;
     std::string m_osUploadID{};
     int m_nPartNumber = 0;
-    std::vector<std::string> m_aosEtags{};
+    std::vector<std::string> m_aosEtags{};  // indexed by part number - 1
     bool m_bError = false;
 
+    // Pipelined multipart upload, when m_nMaxPartsInFlight > 1
+    int m_nMaxPartsInFlight = 1;
+    std::unique_ptr<CPLWorkerThreadPool> m_poUploadPool{};
+    std::mutex m_oUploadMutex{};
+    std::vector<GByte *> m_apabyFreeBuffers{};  // protected by m_oUploadMutex
+    bool m_bAsyncUploadError = false;           // protected by m_oUploadMutex
+
     CURLM *m_hCurlMulti = nullptr;
     CURL *m_hCurl = nullptr;
     const void *m_pBuffer = nullptr;
@@ -714,6 +747,9 @@ class VSIS3WriteHandle final : public VSIVirtualHandle
     WriteFuncStruct m_sWriteFuncHeaderData{};
 
     bool UploadPart();
+    bool UploadPartAsync();
+    bool WaitForPendingParts();
+    static void UploadPartJob(void *pData);
     bool DoSinglePartPUT();
 
     static size_t ReadCallBackBufferChunked(char *buffer, size_t size,
@@ -843,6 +879,8 @@ class NetworkStatisticsLogger
         GIntBig nPUTUploadedBytes = 0;
         GIntBig nPOSTDownloadedBytes = 0;
         GIntBig nPOSTUploadedBytes = 0;
+        GIntBig nCacheHits = 0;
+        GIntBig nCacheMisses = 0;
     };
 
     enum class ContextPathType
@@ -922,6 +960,10 @@ class NetworkStatisticsLogger
 
     static void LogDELETE();
 
+    static void LogCacheHit();
+
+    static void LogCacheMiss();
+
     static void Reset();
 
     static std::string GetReportAsSerializedJSON();
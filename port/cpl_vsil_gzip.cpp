@@ -109,6 +109,7 @@
 #include <vector>
 
 #include "cpl_error.h"
+#include "cpl_mem_cache.h"
 #include "cpl_minizip_ioapi.h"
 #include "cpl_minizip_unzip.h"
 #include "cpl_multiproc.h"
@@ -2885,6 +2886,897 @@ vsi_l_offset VSIGZipWriteHandle::Tell()
     return nCurOffset;
 }
 
+/************************************************************************/
+/* ==================================================================== */
+/*                        VSIGZipMTReadHandle                           */
+/* ==================================================================== */
+/************************************************************************/
+
+// Reader of .gz files made of chunks that can be decompressed independently,
+// and thus in parallel:
+// - files written by VSIGZipWriteHandleMT or "pigz --independent", where
+//   the deflate stream is reset after each chunk, which is terminated by the
+//   9-byte marker emitted by Z_SYNC_FLUSH + Z_FULL_FLUSH,
+// - BGZF files (bgzip), made of gzip members whose size is recorded in the
+//   "BC" subfield of their header.
+// The chunk index is built while reading, and once complete can be saved in
+// a .idx side-car file, so that later openings can seek directly to any
+// chunk.
+
+constexpr GByte abyFullFlushMarker[] = {0x00, 0x00, 0xFF, 0xFF, 0x00,
+                                        0x00, 0x00, 0xFF, 0xFF};
+constexpr int GZIP_INDEX_VERSION = 1;
+
+class VSIGZipMTReadHandle final : public VSIVirtualHandle
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSIGZipMTReadHandle)
+
+    struct Chunk
+    {
+        vsi_l_offset nCompressedOffset = 0;
+        vsi_l_offset nCompressedSize = 0;
+        vsi_l_offset nUncompressedOffset = 0;  // valid if bSizeKnown
+        size_t nUncompressedSize = 0;          // valid if bSizeKnown
+        uLong nCRC = 0;                        // valid if bSizeKnown
+        bool bSizeKnown = false;
+    };
+
+    struct Job
+    {
+        std::string osCompressed{};
+        std::shared_ptr<std::string> poUncompressed{};
+        bool bGZipMember = false;
+        bool bOK = false;
+        uLong nCRC = 0;
+    };
+
+    VSIVirtualHandleUniquePtr m_poBaseHandle{};
+    std::string m_osBaseFilename{};
+    bool m_bBGZF = false;
+    vsi_l_offset m_nFileSize = 0;
+    vsi_l_offset m_nDataEnd = 0;  // end of the compressed data
+
+    std::vector<Chunk> m_aoChunks{};
+    bool m_bIndexComplete = false;
+    bool m_bIndexFromFile = false;
+    vsi_l_offset m_nScanOffset = 0;       // next offset to scan for chunks
+    vsi_l_offset m_nPendingChunkStart = 0;  // start of the unterminated chunk
+    std::string m_osScanTail{};           // to find markers across reads
+    size_t m_nKnownChunks = 0;  // chunks before this one have a known size
+    uLong m_nCRC = 0;           // CRC of the first m_nKnownChunks chunks
+    bool m_bError = false;
+
+    int m_nThreads = 0;
+    std::unique_ptr<CPLWorkerThreadPool> m_poPool{};
+    lru11::Cache<size_t, std::shared_ptr<std::string>> m_oCache;
+
+    vsi_l_offset m_nPos = 0;
+    bool m_bEOF = false;
+
+    VSIGZipMTReadHandle(VSIVirtualHandleUniquePtr &&poBaseHandle,
+                        const char *pszBaseFilename, int nThreads);
+
+    size_t GetBatchSize() const
+    {
+        return static_cast<size_t>(m_nThreads) * 2;
+    }
+
+    bool ScanNextChunk();
+    bool DecodeChunks(size_t iFirst);
+    bool UpdateKnownChunks();
+    std::shared_ptr<std::string> GetChunk(size_t iChunk);
+    bool FindChunk(vsi_l_offset nOffset, size_t &iChunk);
+
+    std::string GetIndexFilename() const
+    {
+        return m_osBaseFilename + ".idx";
+    }
+    bool LoadIndex();
+    void SaveIndex();
+
+    static void DecodeJob(void *pData);
+
+  public:
+    ~VSIGZipMTReadHandle() override;
+
+    static VSIGZipMTReadHandle *Create(const char *pszBaseFilename,
+                                       int nThreads);
+
+    int Seek(vsi_l_offset nOffset, int nWhence) override;
+    vsi_l_offset Tell() override;
+    size_t Read(void *pBuffer, size_t nSize, size_t nMemb) override;
+    size_t Write(const void *pBuffer, size_t nSize, size_t nMemb) override;
+    int Eof() override;
+    int Close() override;
+};
+
+/************************************************************************/
+/*                       GetGZipHeaderSize()                            */
+/************************************************************************/
+
+// Returns the size of the gzip member header at the start of pabyData, or 0
+// if it is not a valid one (or is truncated). nBGZFBlockSize is set to the
+// total size of the member if it has a BGZF "BC" subfield.
+static size_t GetGZipHeaderSize(const GByte *pabyData, size_t nSize,
+                                vsi_l_offset &nBGZFBlockSize)
+{
+    nBGZFBlockSize = 0;
+    if (nSize < 10 || pabyData[0] != gz_magic[0] ||
+        pabyData[1] != gz_magic[1] || pabyData[2] != Z_DEFLATED ||
+        (pabyData[3] & RESERVED) != 0)
+    {
+        return 0;
+    }
+    const int nFlags = pabyData[3];
+    size_t nPos = 10;
+    if ((nFlags & EXTRA_FIELD) != 0)
+    {
+        if (nPos + 2 > nSize)
+            return 0;
+        const size_t nXLen = pabyData[nPos] | (pabyData[nPos + 1] << 8);
+        nPos += 2;
+        if (nPos + nXLen > nSize)
+            return 0;
+        // Look for the BGZF "BC" subfield
+        size_t nSubPos = nPos;
+        while (nSubPos + 4 <= nPos + nXLen)
+        {
+            const size_t nSubLen =
+                pabyData[nSubPos + 2] | (pabyData[nSubPos + 3] << 8);
+            if (pabyData[nSubPos] == 'B' && pabyData[nSubPos + 1] == 'C' &&
+                nSubLen == 2 && nSubPos + 6 <= nPos + nXLen)
+            {
+                nBGZFBlockSize =
+                    1 + (pabyData[nSubPos + 4] | (pabyData[nSubPos + 5] << 8));
+            }
+            nSubPos += 4 + nSubLen;
+        }
+        nPos += nXLen;
+    }
+    for (const int nFlag : {ORIG_NAME, COMMENT})
+    {
+        if ((nFlags & nFlag) != 0)
+        {
+            while (nPos < nSize && pabyData[nPos] != 0)
+                ++nPos;
+            if (nPos == nSize)
+                return 0;
+            ++nPos;
+        }
+    }
+    if ((nFlags & HEAD_CRC) != 0)
+        nPos += 2;
+    return nPos <= nSize ? nPos : 0;
+}
+
+/************************************************************************/
+/*                        VSIGZipMTReadHandle()                         */
+/************************************************************************/
+
+VSIGZipMTReadHandle::VSIGZipMTReadHandle(
+    VSIVirtualHandleUniquePtr &&poBaseHandle, const char *pszBaseFilename,
+    int nThreads)
+    : m_poBaseHandle(std::move(poBaseHandle)),
+      m_osBaseFilename(pszBaseFilename), m_nThreads(nThreads),
+      m_oCache(GetBatchSize() * 2, GetBatchSize())
+{
+}
+
+/************************************************************************/
+/*                       ~VSIGZipMTReadHandle()                         */
+/************************************************************************/
+
+VSIGZipMTReadHandle::~VSIGZipMTReadHandle()
+{
+    VSIGZipMTReadHandle::Close();
+}
+
+/************************************************************************/
+/*                               Create()                               */
+/************************************************************************/
+
+VSIGZipMTReadHandle *VSIGZipMTReadHandle::Create(const char *pszBaseFilename,
+                                                 int nThreads)
+{
+    VSIVirtualHandleUniquePtr poBaseHandle(VSIFOpenL(pszBaseFilename, "rb"));
+    if (!poBaseHandle)
+        return nullptr;
+    if (poBaseHandle->Seek(0, SEEK_END) != 0)
+        return nullptr;
+    const vsi_l_offset nFileSize = poBaseHandle->Tell();
+    // Not worth it for small files
+    if (nFileSize < 1024 * 1024)
+        return nullptr;
+
+    GByte abyHeader[1024];
+    if (poBaseHandle->Seek(0, SEEK_SET) != 0)
+        return nullptr;
+    const size_t nHeaderRead =
+        poBaseHandle->Read(abyHeader, 1, sizeof(abyHeader));
+    vsi_l_offset nBGZFBlockSize = 0;
+    const size_t nHeaderSize =
+        GetGZipHeaderSize(abyHeader, nHeaderRead, nBGZFBlockSize);
+    if (nHeaderSize == 0)
+        return nullptr;
+
+    std::unique_ptr<VSIGZipMTReadHandle> poHandle(new VSIGZipMTReadHandle(
+        std::move(poBaseHandle), pszBaseFilename, nThreads));
+    poHandle->m_nFileSize = nFileSize;
+    poHandle->m_bBGZF = nBGZFBlockSize > 0;
+    if (poHandle->m_bBGZF)
+    {
+        poHandle->m_nDataEnd = nFileSize;
+    }
+    else
+    {
+        // Skip the CRC32 and ISIZE trailer
+        poHandle->m_nDataEnd = nFileSize - 8;
+        poHandle->m_nScanOffset = nHeaderSize;
+        poHandle->m_nPendingChunkStart = nHeaderSize;
+    }
+
+    if (poHandle->LoadIndex())
+    {
+        CPLDebug("GZIP", "Using %s", poHandle->GetIndexFilename().c_str());
+    }
+    else if (!poHandle->m_bBGZF)
+    {
+        // Check that the first chunk is terminated by a full flush marker
+        // within a reasonable distance, otherwise the file was not written
+        // in independent chunks, and the regular reader must be used.
+        constexpr vsi_l_offset MAX_FIRST_CHUNK_SIZE = 16 * 1024 * 1024;
+        while (poHandle->m_aoChunks.empty() &&
+               poHandle->m_nScanOffset - nHeaderSize < MAX_FIRST_CHUNK_SIZE &&
+               !poHandle->m_bIndexComplete)
+        {
+            if (!poHandle->ScanNextChunk())
+                return nullptr;
+        }
+        if (poHandle->m_aoChunks.empty() || poHandle->m_bIndexComplete)
+            return nullptr;
+    }
+
+    if (nThreads > 1)
+    {
+        poHandle->m_poPool = std::make_unique<CPLWorkerThreadPool>();
+        if (!poHandle->m_poPool->Setup(nThreads, nullptr, nullptr))
+            return nullptr;
+    }
+    return poHandle.release();
+}
+
+/************************************************************************/
+/*                           ScanNextChunk()                            */
+/************************************************************************/
+
+// Appends (at least) one chunk to m_aoChunks, or sets m_bIndexComplete.
+bool VSIGZipMTReadHandle::ScanNextChunk()
+{
+    if (m_bIndexComplete)
+        return true;
+
+    if (m_bBGZF)
+    {
+        if (m_nScanOffset == m_nFileSize)
+        {
+            m_bIndexComplete = true;
+            return true;
+        }
+        GByte abyHeader[1024];
+        if (m_poBaseHandle->Seek(m_nScanOffset, SEEK_SET) != 0)
+            return false;
+        const size_t nRead =
+            m_poBaseHandle->Read(abyHeader, 1, sizeof(abyHeader));
+        vsi_l_offset nBlockSize = 0;
+        if (GetGZipHeaderSize(abyHeader, nRead, nBlockSize) == 0 ||
+            nBlockSize == 0 || m_nScanOffset + nBlockSize > m_nFileSize)
+        {
+            CPLError(CE_Failure, CPLE_FileIO,
+                     "Invalid BGZF block at offset " CPL_FRMT_GUIB " of %s",
+                     m_nScanOffset, m_osBaseFilename.c_str());
+            return false;
+        }
+        Chunk oChunk;
+        oChunk.nCompressedOffset = m_nScanOffset;
+        oChunk.nCompressedSize = nBlockSize;
+        m_aoChunks.push_back(oChunk);
+        m_nScanOffset += nBlockSize;
+        return true;
+    }
+
+    // Search for the next full flush marker
+    constexpr size_t MARKER_SIZE = sizeof(abyFullFlushMarker);
+    constexpr size_t SCAN_BUFFER_SIZE = 1024 * 1024;
+    constexpr vsi_l_offset MAX_CHUNK_SIZE = 1024 * 1024 * 1024;
+    const size_t nChunksBefore = m_aoChunks.size();
+    std::string osBuffer;
+    while (m_aoChunks.size() == nChunksBefore)
+    {
+        if (m_nScanOffset == m_nDataEnd)
+        {
+            if (m_nDataEnd > m_nPendingChunkStart)
+            {
+                Chunk oChunk;
+                oChunk.nCompressedOffset = m_nPendingChunkStart;
+                oChunk.nCompressedSize = m_nDataEnd - m_nPendingChunkStart;
+                m_aoChunks.push_back(oChunk);
+            }
+            m_bIndexComplete = true;
+            return true;
+        }
+        if (m_nScanOffset - m_nPendingChunkStart > MAX_CHUNK_SIZE)
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "Too large independent chunk in %s",
+                     m_osBaseFilename.c_str());
+            return false;
+        }
+
+        const size_t nToRead = static_cast<size_t>(std::min(
+            static_cast<vsi_l_offset>(SCAN_BUFFER_SIZE),
+            m_nDataEnd - m_nScanOffset));
+        osBuffer = m_osScanTail;
+        const size_t nTailSize = osBuffer.size();
+        osBuffer.resize(nTailSize + nToRead);
+        if (m_poBaseHandle->Seek(m_nScanOffset, SEEK_SET) != 0 ||
+            m_poBaseHandle->Read(&osBuffer[nTailSize], 1, nToRead) != nToRead)
+        {
+            return false;
+        }
+        const vsi_l_offset nBufferOffset = m_nScanOffset - nTailSize;
+        m_nScanOffset += nToRead;
+
+        const GByte *pabyStart = reinterpret_cast<const GByte *>(&osBuffer[0]);
+        const GByte *pabyEnd = pabyStart + osBuffer.size();
+        const GByte *pabyIter = pabyStart;
+        while (true)
+        {
+            pabyIter = std::search(pabyIter, pabyEnd, abyFullFlushMarker,
+                                   abyFullFlushMarker + MARKER_SIZE);
+            if (pabyIter == pabyEnd)
+                break;
+            const vsi_l_offset nChunkEnd =
+                nBufferOffset + (pabyIter - pabyStart) + MARKER_SIZE;
+            if (nChunkEnd - MARKER_SIZE >= m_nPendingChunkStart &&
+                nChunkEnd < m_nDataEnd)
+            {
+                Chunk oChunk;
+                oChunk.nCompressedOffset = m_nPendingChunkStart;
+                oChunk.nCompressedSize = nChunkEnd - m_nPendingChunkStart;
+                m_aoChunks.push_back(oChunk);
+                m_nPendingChunkStart = nChunkEnd;
+            }
+            pabyIter += MARKER_SIZE;
+        }
+        m_osScanTail = osBuffer.substr(
+            osBuffer.size() - std::min(osBuffer.size(), MARKER_SIZE - 1));
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                             DecodeJob()                              */
+/************************************************************************/
+
+void VSIGZipMTReadHandle::DecodeJob(void *pData)
+{
+    Job *psJob = static_cast<Job *>(pData);
+
+    z_stream sStream;
+    memset(&sStream, 0, sizeof(sStream));
+    // BGZF members are decoded with their gzip header and trailer, so
+    // that zlib checks their CRC.
+    if (inflateInit2(&sStream, psJob->bGZipMember ? 16 + MAX_WBITS
+                                                  : -MAX_WBITS) != Z_OK)
+    {
+        return;
+    }
+    sStream.next_in = reinterpret_cast<Bytef *>(&psJob->osCompressed[0]);
+    sStream.avail_in = static_cast<uInt>(psJob->osCompressed.size());
+
+    std::string &osOut = *(psJob->poUncompressed);
+    size_t nOutSize = 0;
+    int ret = Z_OK;
+    try
+    {
+        while (true)
+        {
+            if (nOutSize == osOut.size())
+            {
+                osOut.resize(std::max(static_cast<size_t>(Z_BUFSIZE),
+                                      std::max(4 * psJob->osCompressed.size(),
+                                               2 * osOut.size())));
+            }
+            sStream.next_out = reinterpret_cast<Bytef *>(&osOut[nOutSize]);
+            sStream.avail_out = static_cast<uInt>(std::min(
+                osOut.size() - nOutSize, static_cast<size_t>(UINT_MAX)));
+            const uInt nAvailOutBefore = sStream.avail_out;
+            ret = inflate(&sStream, Z_NO_FLUSH);
+            nOutSize += nAvailOutBefore - sStream.avail_out;
+            if (ret == Z_STREAM_END || (ret < 0 && ret != Z_BUF_ERROR))
+                break;
+            if (sStream.avail_in == 0 && sStream.avail_out != 0)
+                break;
+        }
+    }
+    catch (const std::exception &)
+    {
+        ret = Z_MEM_ERROR;
+    }
+    inflateEnd(&sStream);
+    osOut.resize(std::min(nOutSize, osOut.size()));
+
+    psJob->bOK = psJob->bGZipMember
+                     ? ret == Z_STREAM_END
+                     : (ret == Z_STREAM_END || ret == Z_OK ||
+                        ret == Z_BUF_ERROR) &&
+                           sStream.avail_in == 0;
+    if (psJob->bOK && !psJob->bGZipMember)
+    {
+        psJob->nCRC =
+            crc32(0, reinterpret_cast<const Bytef *>(osOut.data()),
+                  static_cast<uInt>(osOut.size()));
+    }
+}
+
+/************************************************************************/
+/*                           DecodeChunks()                             */
+/************************************************************************/
+
+// Decodes the chunks starting at iFirst that are not in cache, with the
+// thread pool, and puts them in cache.
+bool VSIGZipMTReadHandle::DecodeChunks(size_t iFirst)
+{
+    const size_t nBatchSize = GetBatchSize();
+    while (!m_bIndexComplete && m_aoChunks.size() < iFirst + nBatchSize)
+    {
+        if (!ScanNextChunk())
+        {
+            m_bError = true;
+            return false;
+        }
+    }
+    const size_t iLast = std::min(m_aoChunks.size(), iFirst + nBatchSize);
+
+    // Read the compressed data sequentially
+    std::vector<std::pair<size_t, std::unique_ptr<Job>>> apoJobs;
+    for (size_t i = iFirst; i < iLast; ++i)
+    {
+        if (m_oCache.contains(i))
+            continue;
+        const Chunk &oChunk = m_aoChunks[i];
+        auto psJob = std::make_unique<Job>();
+        psJob->bGZipMember = m_bBGZF;
+        psJob->poUncompressed = std::make_shared<std::string>();
+        try
+        {
+            psJob->osCompressed.resize(
+                static_cast<size_t>(oChunk.nCompressedSize));
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate memory for chunk");
+            m_bError = true;
+            return false;
+        }
+        if (m_poBaseHandle->Seek(oChunk.nCompressedOffset, SEEK_SET) != 0 ||
+            m_poBaseHandle->Read(&psJob->osCompressed[0], 1,
+                                 psJob->osCompressed.size()) !=
+                psJob->osCompressed.size())
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot read %s",
+                     m_osBaseFilename.c_str());
+            m_bError = true;
+            return false;
+        }
+        apoJobs.emplace_back(i, std::move(psJob));
+    }
+
+    if (m_poPool && apoJobs.size() > 1)
+    {
+        for (auto &oIter : apoJobs)
+            m_poPool->SubmitJob(DecodeJob, oIter.second.get());
+        m_poPool->WaitCompletion();
+    }
+    else
+    {
+        for (auto &oIter : apoJobs)
+            DecodeJob(oIter.second.get());
+    }
+
+    for (auto &oIter : apoJobs)
+    {
+        const size_t i = oIter.first;
+        Job *psJob = oIter.second.get();
+        if (!psJob->bOK)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Decompression of chunk at offset " CPL_FRMT_GUIB
+                     " of %s failed",
+                     m_aoChunks[i].nCompressedOffset, m_osBaseFilename.c_str());
+            m_bError = true;
+            return false;
+        }
+        Chunk &oChunk = m_aoChunks[i];
+        if (oChunk.bSizeKnown &&
+            oChunk.nUncompressedSize != psJob->poUncompressed->size())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Chunk at offset " CPL_FRMT_GUIB
+                     " of %s does not match the index %s",
+                     oChunk.nCompressedOffset, m_osBaseFilename.c_str(),
+                     GetIndexFilename().c_str());
+            m_bError = true;
+            return false;
+        }
+        if (!oChunk.bSizeKnown)
+        {
+            oChunk.bSizeKnown = true;
+            oChunk.nUncompressedSize = psJob->poUncompressed->size();
+            oChunk.nCRC = psJob->nCRC;
+        }
+        m_oCache.insert(i, psJob->poUncompressed);
+    }
+
+    return UpdateKnownChunks();
+}
+
+/************************************************************************/
+/*                         UpdateKnownChunks()                          */
+/************************************************************************/
+
+// Computes the uncompressed offsets of the chunks following the ones
+// already known, and checks the CRC once the end of the file is reached.
+bool VSIGZipMTReadHandle::UpdateKnownChunks()
+{
+    while (m_nKnownChunks < m_aoChunks.size() &&
+           m_aoChunks[m_nKnownChunks].bSizeKnown)
+    {
+        Chunk &oChunk = m_aoChunks[m_nKnownChunks];
+        if (m_nKnownChunks > 0)
+        {
+            const Chunk &oPrevChunk = m_aoChunks[m_nKnownChunks - 1];
+            oChunk.nUncompressedOffset =
+                oPrevChunk.nUncompressedOffset + oPrevChunk.nUncompressedSize;
+        }
+        if (!m_bBGZF && !m_bIndexFromFile)
+        {
+            m_nCRC =
+                crc32_combine(m_nCRC, oChunk.nCRC,
+                              static_cast<uLong>(oChunk.nUncompressedSize));
+        }
+        ++m_nKnownChunks;
+    }
+
+    if (m_bIndexComplete && m_nKnownChunks == m_aoChunks.size() &&
+        !m_bIndexFromFile)
+    {
+        m_bIndexFromFile = true;  // so that this is done only once
+        if (!m_bBGZF)
+        {
+            GByte abyTrailer[4] = {0, 0, 0, 0};
+            if (m_poBaseHandle->Seek(m_nDataEnd, SEEK_SET) != 0 ||
+                m_poBaseHandle->Read(abyTrailer, 1, 4) != 4)
+            {
+                m_bError = true;
+                return false;
+            }
+            const uLong nExpectedCRC =
+                abyTrailer[0] | (abyTrailer[1] << 8) | (abyTrailer[2] << 16) |
+                (static_cast<uLong>(abyTrailer[3]) << 24);
+            if (nExpectedCRC != m_nCRC)
+            {
+                CPLError(CE_Failure, CPLE_FileIO,
+                         "CRC error. Got %X instead of %X",
+                         static_cast<unsigned int>(m_nCRC),
+                         static_cast<unsigned int>(nExpectedCRC));
+                m_bError = true;
+                return false;
+            }
+        }
+        SaveIndex();
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                              GetChunk()                              */
+/************************************************************************/
+
+std::shared_ptr<std::string> VSIGZipMTReadHandle::GetChunk(size_t iChunk)
+{
+    std::shared_ptr<std::string> poData;
+    if (!m_oCache.tryGet(iChunk, poData))
+    {
+        if (!DecodeChunks(iChunk))
+            return nullptr;
+        m_oCache.tryGet(iChunk, poData);
+    }
+    return poData;
+}
+
+/************************************************************************/
+/*                              FindChunk()                             */
+/************************************************************************/
+
+// Returns in iChunk the index of the chunk containing nOffset, decoding
+// the chunks before it if their size is not known yet. Returns false at
+// end of file or on error.
+bool VSIGZipMTReadHandle::FindChunk(vsi_l_offset nOffset, size_t &iChunk)
+{
+    while (!m_bError)
+    {
+        if (m_nKnownChunks > 0)
+        {
+            const Chunk &oLast = m_aoChunks[m_nKnownChunks - 1];
+            if (nOffset < oLast.nUncompressedOffset + oLast.nUncompressedSize)
+            {
+                const auto oIter = std::upper_bound(
+                    m_aoChunks.begin(), m_aoChunks.begin() + m_nKnownChunks,
+                    nOffset,
+                    [](vsi_l_offset nVal, const Chunk &oChunk)
+                    { return nVal < oChunk.nUncompressedOffset; });
+                iChunk = static_cast<size_t>(oIter - m_aoChunks.begin()) - 1;
+                // Skip empty chunks
+                while (m_aoChunks[iChunk].nUncompressedSize == 0 &&
+                       iChunk + 1 < m_nKnownChunks)
+                    ++iChunk;
+                return true;
+            }
+        }
+        if (m_nKnownChunks == m_aoChunks.size())
+        {
+            if (m_bIndexComplete)
+                return false;
+            if (!ScanNextChunk())
+            {
+                m_bError = true;
+                return false;
+            }
+            if (m_nKnownChunks == m_aoChunks.size())
+                continue;
+        }
+        if (!DecodeChunks(m_nKnownChunks))
+            return false;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                              LoadIndex()                             */
+/************************************************************************/
+
+bool VSIGZipMTReadHandle::LoadIndex()
+{
+    VSILFILE *fp = VSIFOpenL(GetIndexFilename().c_str(), "rb");
+    if (fp == nullptr)
+        return false;
+
+    bool bOK = false;
+    const char *pszLine = CPLReadLineL(fp);
+    if (pszLine &&
+        EQUAL(pszLine, CPLSPrintf("GDAL_GZIP_INDEX=%d", GZIP_INDEX_VERSION)))
+    {
+        bOK = true;
+        std::vector<Chunk> aoChunks;
+        while (bOK && (pszLine = CPLReadLineL(fp)) != nullptr)
+        {
+            if (STARTS_WITH(pszLine, "compressed_size="))
+            {
+                bOK = CPLScanUIntBig(pszLine + strlen("compressed_size="),
+                                     32) == m_nFileSize;
+            }
+            else if (STARTS_WITH(pszLine, "bgzf="))
+            {
+                bOK = atoi(pszLine + strlen("bgzf=")) == (m_bBGZF ? 1 : 0);
+            }
+            else
+            {
+                const CPLStringList aosTokens(
+                    CSLTokenizeString2(pszLine, " ", 0));
+                if (aosTokens.size() != 3)
+                {
+                    bOK = false;
+                    break;
+                }
+                Chunk oChunk;
+                oChunk.nCompressedOffset =
+                    CPLScanUIntBig(aosTokens[0], strlen(aosTokens[0]));
+                oChunk.nCompressedSize =
+                    CPLScanUIntBig(aosTokens[1], strlen(aosTokens[1]));
+                oChunk.nUncompressedSize = static_cast<size_t>(
+                    CPLScanUIntBig(aosTokens[2], strlen(aosTokens[2])));
+                oChunk.bSizeKnown = true;
+                const vsi_l_offset nExpectedOffset =
+                    aoChunks.empty() ? m_nScanOffset
+                                     : aoChunks.back().nCompressedOffset +
+                                           aoChunks.back().nCompressedSize;
+                bOK = oChunk.nCompressedOffset == nExpectedOffset &&
+                      oChunk.nCompressedSize > 0 &&
+                      oChunk.nCompressedOffset + oChunk.nCompressedSize <=
+                          m_nDataEnd;
+                aoChunks.push_back(oChunk);
+            }
+        }
+        if (bOK && !aoChunks.empty() &&
+            aoChunks.back().nCompressedOffset +
+                    aoChunks.back().nCompressedSize ==
+                m_nDataEnd)
+        {
+            m_aoChunks = std::move(aoChunks);
+            m_bIndexComplete = true;
+            m_bIndexFromFile = true;
+        }
+        else
+        {
+            bOK = false;
+        }
+    }
+    VSIFCloseL(fp);
+
+    if (!bOK)
+    {
+        CPLDebug("GZIP", "Ignoring invalid %s", GetIndexFilename().c_str());
+        return false;
+    }
+    return UpdateKnownChunks();
+}
+
+/************************************************************************/
+/*                              SaveIndex()                             */
+/************************************************************************/
+
+void VSIGZipMTReadHandle::SaveIndex()
+{
+    if (STARTS_WITH_CI(m_osBaseFilename.c_str(), "/vsicurl/") ||
+        !CPLTestBool(
+            CPLGetConfigOption("CPL_VSIL_GZIP_WRITE_PROPERTIES", "YES")))
+    {
+        return;
+    }
+
+    CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+    CPLErrorStateBackuper oErrorStateBackuper;
+    VSILFILE *fp = VSIFOpenL(GetIndexFilename().c_str(), "wb");
+    if (fp == nullptr)
+        return;
+    bool bOK =
+        VSIFPrintfL(fp, "GDAL_GZIP_INDEX=%d\n", GZIP_INDEX_VERSION) > 0 &&
+        VSIFPrintfL(fp, "compressed_size=" CPL_FRMT_GUIB "\n", m_nFileSize) >
+            0 &&
+        VSIFPrintfL(fp, "bgzf=%d\n", m_bBGZF ? 1 : 0) > 0;
+    for (const auto &oChunk : m_aoChunks)
+    {
+        if (!bOK)
+            break;
+        bOK = VSIFPrintfL(fp, CPL_FRMT_GUIB " " CPL_FRMT_GUIB " " CPL_FRMT_GUIB
+                              "\n",
+                          oChunk.nCompressedOffset, oChunk.nCompressedSize,
+                          static_cast<GUIntBig>(oChunk.nUncompressedSize)) > 0;
+    }
+    if (VSIFCloseL(fp) != 0 || !bOK)
+        VSIUnlink(GetIndexFilename().c_str());
+}
+
+/************************************************************************/
+/*                                Seek()                                */
+/************************************************************************/
+
+int VSIGZipMTReadHandle::Seek(vsi_l_offset nOffset, int nWhence)
+{
+    m_bEOF = false;
+    if (nWhence == SEEK_SET)
+    {
+        m_nPos = nOffset;
+    }
+    else if (nWhence == SEEK_CUR)
+    {
+        m_nPos += nOffset;
+    }
+    else if (nWhence == SEEK_END && nOffset == 0)
+    {
+        // Find the uncompressed size, decoding the whole file if needed
+        size_t iChunk = 0;
+        while (FindChunk(std::numeric_limits<vsi_l_offset>::max(), iChunk))
+        {
+        }
+        if (m_bError)
+            return -1;
+        m_nPos = m_nKnownChunks == 0
+                     ? 0
+                     : m_aoChunks[m_nKnownChunks - 1].nUncompressedOffset +
+                           m_aoChunks[m_nKnownChunks - 1].nUncompressedSize;
+    }
+    else
+    {
+        return -1;
+    }
+    return 0;
+}
+
+/************************************************************************/
+/*                                Tell()                                */
+/************************************************************************/
+
+vsi_l_offset VSIGZipMTReadHandle::Tell()
+{
+    return m_nPos;
+}
+
+/************************************************************************/
+/*                                Read()                                */
+/************************************************************************/
+
+size_t VSIGZipMTReadHandle::Read(void *pBuffer, size_t nSize, size_t nMemb)
+{
+    const size_t nToRead = nSize * nMemb;
+    if (nToRead == 0)
+        return 0;
+    GByte *pabyDst = static_cast<GByte *>(pBuffer);
+    size_t nRead = 0;
+    while (nRead < nToRead)
+    {
+        size_t iChunk = 0;
+        if (!FindChunk(m_nPos, iChunk))
+        {
+            m_bEOF = true;
+            break;
+        }
+        auto poData = GetChunk(iChunk);
+        if (!poData)
+        {
+            m_bEOF = true;
+            break;
+        }
+        const Chunk &oChunk = m_aoChunks[iChunk];
+        const size_t nOffsetInChunk =
+            static_cast<size_t>(m_nPos - oChunk.nUncompressedOffset);
+        const size_t nToCopy =
+            std::min(nToRead - nRead, poData->size() - nOffsetInChunk);
+        memcpy(pabyDst + nRead, poData->data() + nOffsetInChunk, nToCopy);
+        nRead += nToCopy;
+        m_nPos += nToCopy;
+    }
+    return nRead / nSize;
+}
+
+/************************************************************************/
+/*                                Write()                               */
+/************************************************************************/
+
+size_t VSIGZipMTReadHandle::Write(const void * /* pBuffer */,
+                                  size_t /* nSize */, size_t /* nMemb */)
+{
+    CPLError(CE_Failure, CPLE_NotSupported,
+             "VSIFWriteL is not supported on GZip streams");
+    return 0;
+}
+
+/************************************************************************/
+/*                                 Eof()                                */
+/************************************************************************/
+
+int VSIGZipMTReadHandle::Eof()
+{
+    return m_bEOF;
+}
+
+/************************************************************************/
+/*                                Close()                               */
+/************************************************************************/
+
+int VSIGZipMTReadHandle::Close()
+{
+    m_poPool.reset();
+    m_oCache.clear();
+    if (!m_poBaseHandle)
+        return 0;
+    const int nRet = m_poBaseHandle->Close();
+    m_poBaseHandle.reset();
+    return nRet;
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                       VSIGZipFilesystemHandler                       */
@@ -2992,6 +3884,26 @@ VSIGZipFilesystemHandler::Open(const char *pszFilename, const char *pszAccess,
     /*      Otherwise we are in the read access case.                       */
     /* -------------------------------------------------------------------- */
 
+    // Files made of independent chunks (written with GDAL_NUM_THREADS,
+    // pigz --independent or bgzip) can be decompressed in parallel.
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszThreads && EQUAL(pszAccess, "rb") &&
+        CPLTestBool(CPLGetConfigOption("CPL_VSIL_GZIP_PARALLEL_READ", "YES")))
+    {
+        int nThreads = EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                     : atoi(pszThreads);
+        nThreads = std::max(1, std::min(128, nThreads));
+        if (nThreads > 1)
+        {
+            CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+            CPLErrorStateBackuper oErrorStateBackuper;
+            auto poMTHandle = VSIGZipMTReadHandle::Create(
+                pszFilename + strlen("/vsigzip/"), nThreads);
+            if (poMTHandle)
+                return VSICreateBufferedReaderHandle(poMTHandle);
+        }
+    }
+
     VSIGZipHandle *poGZIPHandle = OpenGZipReadOnly(pszFilename, pszAccess);
     if (poGZIPHandle)
         // Wrap the VSIGZipHandle inside a buffered reader that will
@@ -3239,11 +4151,15 @@ const char *VSIGZipFilesystemHandler::GetOptions()
 {
     return "<Options>"
            "  <Option name='GDAL_NUM_THREADS' type='string' "
-           "description='Number of threads for compression. Either a integer "
-           "or ALL_CPUS'/>"
+           "description='Number of threads for compression, and for "
+           "decompression of files made of independent chunks. Either a "
+           "integer or ALL_CPUS'/>"
            "  <Option name='CPL_VSIL_DEFLATE_CHUNK_SIZE' type='string' "
            "description='Chunk of uncompressed data for parallelization. "
            "Use K(ilobytes) or M(egabytes) suffix' default='1M'/>"
+           "  <Option name='CPL_VSIL_GZIP_PARALLEL_READ' type='boolean' "
+           "description='Whether to decompress files made of independent "
+           "chunks in parallel, when GDAL_NUM_THREADS is set' default='YES'/>"
            "</Options>";
 }
 
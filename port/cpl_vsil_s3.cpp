@@ -754,7 +754,7 @@ VSIS3WriteHandle::VSIS3WriteHandle(IVSIS3LikeFSHandler *poFS,
     {
         const int nChunkSizeMB = atoi(VSIGetPathSpecificOption(
             pszFilename,
-            (std::string("VSI") + poFS->GetDebugKey() + "_CHUNK_SIZE").c_str(),
+            (poFS->GetWriteOptionPrefix() + "_CHUNK_SIZE").c_str(),
             "50"));
         if (nChunkSizeMB <= 0 || nChunkSizeMB > 1000)
             m_nBufferSize = 0;
@@ -764,8 +764,7 @@ VSIS3WriteHandle::VSIS3WriteHandle(IVSIS3LikeFSHandler *poFS,
         // For testing only !
         const char *pszChunkSizeBytes = VSIGetPathSpecificOption(
             pszFilename,
-            (std::string("VSI") + poFS->GetDebugKey() + "_CHUNK_SIZE_BYTES")
-                .c_str(),
+            (poFS->GetWriteOptionPrefix() + "_CHUNK_SIZE_BYTES").c_str(),
             nullptr);
         if (pszChunkSizeBytes)
             m_nBufferSize = atoi(pszChunkSizeBytes);
@@ -779,6 +778,29 @@ VSIS3WriteHandle::VSIS3WriteHandle(IVSIS3LikeFSHandler *poFS,
                      "Cannot allocate working buffer for %s",
                      m_poFS->GetFSPrefix().c_str());
         }
+
+        // Number of parts that may be uploaded in the background while the
+        // caller fills the next buffer, bounded by the memory budget (which
+        // accounts for the buffer being filled).
+        m_nMaxPartsInFlight = std::max(
+            1, std::min(64, atoi(VSIGetPathSpecificOption(
+                                pszFilename,
+                                (poFS->GetWriteOptionPrefix() +
+                                 "_UPLOAD_PARTS_IN_FLIGHT")
+                                    .c_str(),
+                                "1"))));
+        const GIntBig nMaxMemoryMB = CPLAtoGIntBig(VSIGetPathSpecificOption(
+            pszFilename,
+            (poFS->GetWriteOptionPrefix() + "_UPLOAD_MAX_MEMORY_MB").c_str(),
+            "0"));
+        if (m_nMaxPartsInFlight > 1 && nMaxMemoryMB > 0)
+        {
+            const GIntBig nMaxBuffers =
+                nMaxMemoryMB * 1024 * 1024 / m_nBufferSize;
+            m_nMaxPartsInFlight = static_cast<int>(
+                std::max<GIntBig>(1, std::min<GIntBig>(m_nMaxPartsInFlight,
+                                                       nMaxBuffers - 1)));
+        }
     }
 }
 
@@ -789,8 +811,11 @@ VSIS3WriteHandle::VSIS3WriteHandle(IVSIS3LikeFSHandler *poFS,
 VSIS3WriteHandle::~VSIS3WriteHandle()
 {
     VSIS3WriteHandle::Close();
+    m_poUploadPool.reset();
     delete m_poS3HandleHelper;
     CPLFree(m_pabyBuffer);
+    for (GByte *pabyBuffer : m_apabyFreeBuffers)
+        CPLFree(pabyBuffer);
     if (m_hCurlMulti)
     {
         if (m_hCurl)
@@ -970,6 +995,8 @@ bool VSIS3WriteHandle::UploadPart()
             knMAX_PART_NUMBER, m_osFilename.c_str());
         return false;
     }
+    if (m_nMaxPartsInFlight > 1)
+        return UploadPartAsync();
     const std::string osEtag = m_poFS->UploadPart(
         m_osFilename, m_nPartNumber, m_osUploadID,
         static_cast<vsi_l_offset>(m_nBufferSize) * (m_nPartNumber - 1),
@@ -983,6 +1010,129 @@ bool VSIS3WriteHandle::UploadPart()
     return !osEtag.empty();
 }
 
+/************************************************************************/
+/*                          UploadPartJob()                             */
+/************************************************************************/
+
+namespace
+{
+struct VSIS3UploadPartJob
+{
+    VSIS3WriteHandle *poHandle = nullptr;
+    int nPartNumber = 0;
+    GByte *pabyBuffer = nullptr;
+    int nBufferSize = 0;
+};
+}  // namespace
+
+void VSIS3WriteHandle::UploadPartJob(void *pData)
+{
+    std::unique_ptr<VSIS3UploadPartJob> psJob(
+        static_cast<VSIS3UploadPartJob *>(pData));
+    VSIS3WriteHandle *poThis = psJob->poHandle;
+
+    // The handle helper is modified by each request, so each part gets its
+    // own one.
+    std::string osEtag;
+    std::unique_ptr<IVSIS3LikeHandleHelper> poHandleHelper(
+        poThis->m_poFS->CreateHandleHelper(
+            poThis->m_osFilename.c_str() + poThis->m_poFS->GetFSPrefix().size(),
+            false));
+    if (poHandleHelper)
+    {
+        osEtag = poThis->m_poFS->UploadPart(
+            poThis->m_osFilename, psJob->nPartNumber, poThis->m_osUploadID,
+            static_cast<vsi_l_offset>(poThis->m_nBufferSize) *
+                (psJob->nPartNumber - 1),
+            psJob->pabyBuffer, psJob->nBufferSize, poHandleHelper.get(),
+            poThis->m_nMaxRetry, poThis->m_dfRetryDelay, nullptr);
+    }
+
+    std::lock_guard<std::mutex> oLock(poThis->m_oUploadMutex);
+    if (osEtag.empty())
+        poThis->m_bAsyncUploadError = true;
+    else
+        poThis->m_aosEtags[psJob->nPartNumber - 1] = std::move(osEtag);
+    poThis->m_apabyFreeBuffers.push_back(psJob->pabyBuffer);
+}
+
+/************************************************************************/
+/*                         UploadPartAsync()                            */
+/************************************************************************/
+
+bool VSIS3WriteHandle::UploadPartAsync()
+{
+    if (!m_poUploadPool)
+    {
+        auto poPool = std::make_unique<CPLWorkerThreadPool>();
+        if (!poPool->Setup(m_nMaxPartsInFlight, nullptr, nullptr))
+        {
+            // Fallback to synchronous upload
+            m_nMaxPartsInFlight = 1;
+            --m_nPartNumber;
+            return UploadPart();
+        }
+        m_poUploadPool = std::move(poPool);
+    }
+
+    // Wait until a slot is available
+    m_poUploadPool->WaitCompletion(m_nMaxPartsInFlight - 1);
+    {
+        std::lock_guard<std::mutex> oLock(m_oUploadMutex);
+        if (m_bAsyncUploadError)
+            return false;
+        m_aosEtags.resize(m_nPartNumber);
+    }
+
+    auto psJob = new VSIS3UploadPartJob();
+    psJob->poHandle = this;
+    psJob->nPartNumber = m_nPartNumber;
+    psJob->pabyBuffer = m_pabyBuffer;
+    psJob->nBufferSize = m_nBufferOff;
+    m_pabyBuffer = nullptr;
+    m_nBufferOff = 0;
+    if (!m_poUploadPool->SubmitJob(UploadPartJob, psJob))
+    {
+        m_pabyBuffer = psJob->pabyBuffer;
+        delete psJob;
+        return false;
+    }
+
+    // Recycle the buffer of a completed part, or allocate a new one
+    {
+        std::lock_guard<std::mutex> oLock(m_oUploadMutex);
+        if (!m_apabyFreeBuffers.empty())
+        {
+            m_pabyBuffer = m_apabyFreeBuffers.back();
+            m_apabyFreeBuffers.pop_back();
+        }
+    }
+    if (m_pabyBuffer == nullptr)
+        m_pabyBuffer = static_cast<GByte *>(VSI_MALLOC_VERBOSE(m_nBufferSize));
+    if (m_pabyBuffer == nullptr)
+    {
+        // Wait for all parts to be uploaded to get a buffer back
+        m_poUploadPool->WaitCompletion(0);
+        std::lock_guard<std::mutex> oLock(m_oUploadMutex);
+        m_pabyBuffer = m_apabyFreeBuffers.back();
+        m_apabyFreeBuffers.pop_back();
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                       WaitForPendingParts()                          */
+/************************************************************************/
+
+bool VSIS3WriteHandle::WaitForPendingParts()
+{
+    if (!m_poUploadPool)
+        return true;
+    m_poUploadPool->WaitCompletion(0);
+    std::lock_guard<std::mutex> oLock(m_oUploadMutex);
+    return !m_bAsyncUploadError;
+}
+
 std::string IVSIS3LikeFSHandler::UploadPart(
     const std::string &osFilename, int nPartNumber,
     const std::string &osUploadID, vsi_l_offset /* nPosition */,
@@ -1139,7 +1289,7 @@ size_t VSIS3WriteHandle::WriteChunked(const void *pBuffer, size_t nSize,
 
     if (m_hCurlMulti == nullptr)
     {
-        m_hCurlMulti = curl_multi_init();
+        m_hCurlMulti = static_cast<CURLM *>(CPLHTTPCreateMultiHandle());
     }
 
     WriteFuncStruct sWriteFuncData;
@@ -1504,6 +1654,7 @@ bool VSIS3WriteHandle::DoSinglePartPUT()
                               m_aosHTTPOptions.List()));
         headers = VSICurlSetCreationHeadersFromOptions(
             headers, m_aosOptions.List(), m_osFilename.c_str());
+        headers = m_poFS->AddSinglePartPUTHeaders(headers);
         headers = VSICurlMergeHeaders(
             headers, m_poS3HandleHelper->GetCurlHeaders(
                          "PUT", headers, m_pabyBuffer, m_nBufferOff));
@@ -2013,15 +2164,20 @@ int VSIS3WriteHandle::Close()
         }
         else
         {
+            if (!m_bError && ((m_nBufferOff > 0 && !UploadPart()) ||
+                              !WaitForPendingParts()))
+            {
+                m_bError = true;
+                nRet = -1;
+            }
             if (m_bError)
             {
+                WaitForPendingParts();
                 if (!m_poFS->AbortMultipart(m_osFilename, m_osUploadID,
                                             m_poS3HandleHelper, m_nMaxRetry,
                                             m_dfRetryDelay))
                     nRet = -1;
             }
-            else if (m_nBufferOff > 0 && !UploadPart())
-                nRet = -1;
             else if (m_poFS->CompleteMultipart(
                          m_osFilename, m_osUploadID, m_aosEtags, m_nCurOffset,
                          m_poS3HandleHelper, m_nMaxRetry, m_dfRetryDelay))
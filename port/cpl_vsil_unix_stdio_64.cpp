@@ -90,7 +90,9 @@
 #endif
 
 #include <limits>
+#include <memory>
 #include <new>
+#include <vector>
 
 #include "cpl_config.h"
 #include "cpl_conv.h"
@@ -155,6 +157,254 @@ static_assert(sizeof(VSIStatBufL::st_size) == sizeof(vsi_l_offset),
               "add the -DBUILD_WITHOUT_64BIT_OFFSET define");
 #endif
 
+#if defined(HAVE_LINUX_IO_URING_H) && defined(HAVE_PREAD64)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define HAVE_IO_URING
+#endif
+#endif
+
+#ifdef HAVE_IO_URING
+
+/************************************************************************/
+/* ==================================================================== */
+/*                             VSIIOUring                               */
+/* ==================================================================== */
+/************************************************************************/
+
+// Minimal io_uring submission/completion ring, driven through the raw
+// system calls, so that no liburing dependency is needed.
+
+namespace
+{
+class VSIIOUring
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSIIOUring)
+
+    int m_fd = -1;
+    unsigned m_nEntries = 0;
+
+    void *m_pSQRing = MAP_FAILED;
+    size_t m_nSQRingSize = 0;
+    void *m_pCQRing = MAP_FAILED;
+    size_t m_nCQRingSize = 0;
+    void *m_pSQEs = MAP_FAILED;
+    size_t m_nSQEsSize = 0;
+
+    unsigned *m_pnSQTail = nullptr;
+    unsigned *m_pnSQMask = nullptr;
+    unsigned *m_panSQArray = nullptr;
+    unsigned *m_pnCQHead = nullptr;
+    unsigned *m_pnCQTail = nullptr;
+    unsigned *m_pnCQMask = nullptr;
+    struct io_uring_cqe *m_pasCQEs = nullptr;
+
+    bool m_bOperationsInFlight = false;
+
+    unsigned ReapCompletions(std::vector<int> &anResults);
+
+  public:
+    VSIIOUring() = default;
+    ~VSIIOUring();
+
+    bool Init(unsigned nEntries);
+
+    unsigned GetEntryCount() const
+    {
+        return m_nEntries;
+    }
+
+    // Submits nOps operations, prepared by the pfnPrepare callback, and
+    // waits for all of them. anResults[i] receives the result of the i-th
+    // operation. Returns false if the ring itself fails, in which case it
+    // must no longer be used.
+    template <class Prepare>
+    bool Run(int nOps, Prepare pfnPrepare, std::vector<int> &anResults);
+
+    // Whether, after a failure of Run(), some submitted operations could
+    // not be waited for, and may thus still access their buffers.
+    bool HasOperationsInFlight() const
+    {
+        return m_bOperationsInFlight;
+    }
+
+    static bool IsAvailable();
+};
+
+/************************************************************************/
+/*                            ~VSIIOUring()                             */
+/************************************************************************/
+
+VSIIOUring::~VSIIOUring()
+{
+    if (m_pSQEs != MAP_FAILED)
+        munmap(m_pSQEs, m_nSQEsSize);
+    if (m_pCQRing != MAP_FAILED)
+        munmap(m_pCQRing, m_nCQRingSize);
+    if (m_pSQRing != MAP_FAILED)
+        munmap(m_pSQRing, m_nSQRingSize);
+    if (m_fd >= 0)
+        close(m_fd);
+}
+
+/************************************************************************/
+/*                               Init()                                 */
+/************************************************************************/
+
+bool VSIIOUring::Init(unsigned nEntries)
+{
+    struct io_uring_params sParams;
+    memset(&sParams, 0, sizeof(sParams));
+    m_fd = static_cast<int>(syscall(__NR_io_uring_setup, nEntries, &sParams));
+    if (m_fd < 0)
+        return false;
+    m_nEntries = sParams.sq_entries;
+
+    m_nSQRingSize =
+        sParams.sq_off.array + sParams.sq_entries * sizeof(unsigned);
+    m_pSQRing = mmap(nullptr, m_nSQRingSize, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+    m_nCQRingSize = sParams.cq_off.cqes +
+                    sParams.cq_entries * sizeof(struct io_uring_cqe);
+    m_pCQRing = mmap(nullptr, m_nCQRingSize, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+    m_nSQEsSize = sParams.sq_entries * sizeof(struct io_uring_sqe);
+    m_pSQEs = mmap(nullptr, m_nSQEsSize, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES);
+    if (m_pSQRing == MAP_FAILED || m_pCQRing == MAP_FAILED ||
+        m_pSQEs == MAP_FAILED)
+    {
+        return false;
+    }
+
+    GByte *pabySQ = static_cast<GByte *>(m_pSQRing);
+    m_pnSQTail = reinterpret_cast<unsigned *>(pabySQ + sParams.sq_off.tail);
+    m_pnSQMask =
+        reinterpret_cast<unsigned *>(pabySQ + sParams.sq_off.ring_mask);
+    m_panSQArray = reinterpret_cast<unsigned *>(pabySQ + sParams.sq_off.array);
+
+    GByte *pabyCQ = static_cast<GByte *>(m_pCQRing);
+    m_pnCQHead = reinterpret_cast<unsigned *>(pabyCQ + sParams.cq_off.head);
+    m_pnCQTail = reinterpret_cast<unsigned *>(pabyCQ + sParams.cq_off.tail);
+    m_pnCQMask =
+        reinterpret_cast<unsigned *>(pabyCQ + sParams.cq_off.ring_mask);
+    m_pasCQEs =
+        reinterpret_cast<struct io_uring_cqe *>(pabyCQ + sParams.cq_off.cqes);
+    return true;
+}
+
+/************************************************************************/
+/*                          ReapCompletions()                           */
+/************************************************************************/
+
+// Consumes the available completion queue entries, and returns their number.
+unsigned VSIIOUring::ReapCompletions(std::vector<int> &anResults)
+{
+    const unsigned nCQMask = *m_pnCQMask;
+    unsigned nHead = *m_pnCQHead;
+    const unsigned nCQTail = __atomic_load_n(m_pnCQTail, __ATOMIC_ACQUIRE);
+    unsigned nReaped = 0;
+    for (; nHead != nCQTail; ++nHead, ++nReaped)
+    {
+        const struct io_uring_cqe *psCQE = &m_pasCQEs[nHead & nCQMask];
+        anResults[static_cast<size_t>(psCQE->user_data)] = psCQE->res;
+    }
+    __atomic_store_n(m_pnCQHead, nHead, __ATOMIC_RELEASE);
+    return nReaped;
+}
+
+/************************************************************************/
+/*                                Run()                                 */
+/************************************************************************/
+
+template <class Prepare>
+bool VSIIOUring::Run(int nOps, Prepare pfnPrepare, std::vector<int> &anResults)
+{
+    anResults.resize(nOps);
+    struct io_uring_sqe *pasSQEs = static_cast<struct io_uring_sqe *>(m_pSQEs);
+    const unsigned nSQMask = *m_pnSQMask;
+    int iOp = 0;
+    while (iOp < nOps)
+    {
+        // Fill the submission queue with as many operations as it can hold
+        const unsigned nBatch =
+            std::min(m_nEntries, static_cast<unsigned>(nOps - iOp));
+        unsigned nTail = *m_pnSQTail;
+        for (unsigned i = 0; i < nBatch; ++i, ++nTail)
+        {
+            const unsigned nIdx = nTail & nSQMask;
+            struct io_uring_sqe *psSQE = &pasSQEs[nIdx];
+            memset(psSQE, 0, sizeof(*psSQE));
+            pfnPrepare(iOp + static_cast<int>(i), psSQE);
+            psSQE->user_data = static_cast<__u64>(iOp + i);
+            m_panSQArray[nIdx] = nIdx;
+        }
+        __atomic_store_n(m_pnSQTail, nTail, __ATOMIC_RELEASE);
+
+        unsigned nToSubmit = nBatch;
+        unsigned nCompleted = 0;
+        while (nCompleted < nBatch)
+        {
+            const int nRet = static_cast<int>(
+                syscall(__NR_io_uring_enter, m_fd, nToSubmit,
+                        nBatch - nCompleted, IORING_ENTER_GETEVENTS, nullptr,
+                        0));
+            if (nRet < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+
+                // Operations submitted before the error are still in
+                // flight. Wait for them, so that the kernel no longer
+                // accesses the memory they target once we return.
+                const unsigned nSubmitted = nBatch - nToSubmit;
+                nCompleted += ReapCompletions(anResults);
+                while (nCompleted < nSubmitted)
+                {
+                    if (syscall(__NR_io_uring_enter, m_fd, 0,
+                                nSubmitted - nCompleted, IORING_ENTER_GETEVENTS,
+                                nullptr, 0) < 0 &&
+                        errno != EINTR && errno != EAGAIN && errno != EBUSY)
+                    {
+                        m_bOperationsInFlight = true;
+                        break;
+                    }
+                    nCompleted += ReapCompletions(anResults);
+                }
+                return false;
+            }
+            nToSubmit -= std::min(nToSubmit, static_cast<unsigned>(nRet));
+
+            nCompleted += ReapCompletions(anResults);
+        }
+        iOp += static_cast<int>(nBatch);
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                            IsAvailable()                             */
+/************************************************************************/
+
+bool VSIIOUring::IsAvailable()
+{
+    // io_uring may be missing or disabled (kernel.io_uring_disabled,
+    // seccomp filters of containers, ...), so probe for it once.
+    static const bool bAvailable = []()
+    {
+        VSIIOUring oRing;
+        return oRing.Init(1);
+    }();
+    return bAvailable;
+}
+
+}  // namespace
+
+#endif  // HAVE_IO_URING
+
 /************************************************************************/
 /* ==================================================================== */
 /*                       VSIUnixStdioFilesystemHandler                  */
@@ -198,6 +448,10 @@ class VSIUnixStdioFilesystemHandler final : public VSIFilesystemHandler
     VSIDIR *OpenDir(const char *pszPath, int nRecurseDepth,
                     const char *const *papszOptions) override;
 
+#ifdef HAVE_IO_URING
+    int HasOptimizedReadMultiRange(const char *pszPath) override;
+#endif
+
 #ifdef HAS_CASE_INSENSITIVE_FILE_SYSTEM
     std::string
     GetCanonicalFilename(const std::string &osFilename) const override;
@@ -232,10 +486,20 @@ class VSIUnixStdioHandle final : public VSIVirtualHandle
 #ifdef VSI_COUNT_BYTES_READ
     vsi_l_offset nTotalBytesRead = 0;
     VSIUnixStdioFilesystemHandler *poFS = nullptr;
+#endif
+#ifdef HAVE_IO_URING
+    bool m_bIOUringInitDone = false;
+    std::unique_ptr<VSIIOUring> m_poIOUring{};
+    int m_nDirectFD = -1;  // descriptor opened with O_DIRECT, if requested
+
+    VSIIOUring *GetIOUring();
 #endif
   public:
     VSIUnixStdioHandle(VSIUnixStdioFilesystemHandler *poFSIn, FILE *fpIn,
                        bool bReadOnlyIn, bool bModeAppendReadWriteIn);
+#ifdef HAVE_IO_URING
+    ~VSIUnixStdioHandle() override;
+#endif
 
     int Seek(vsi_l_offset nOffsetIn, int nWhence) override;
     vsi_l_offset Tell() override;
@@ -256,6 +520,13 @@ class VSIUnixStdioHandle final : public VSIVirtualHandle
     size_t PRead(void * /*pBuffer*/, size_t /* nSize */,
                  vsi_l_offset /*nOffset*/) const override;
 #endif
+#ifdef HAVE_IO_URING
+    int ReadMultiRange(int nRanges, void **ppData,
+                       const vsi_l_offset *panOffsets,
+                       const size_t *panSizes) override;
+    void AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
+                    const size_t *panSizes) override;
+#endif
 };
 
 /************************************************************************/
@@ -295,6 +566,13 @@ int VSIUnixStdioHandle::Close()
 
     int ret = fclose(fp);
     fp = nullptr;
+#ifdef HAVE_IO_URING
+    if (m_nDirectFD >= 0)
+    {
+        close(m_nDirectFD);
+        m_nDirectFD = -1;
+    }
+#endif
     return ret;
 }
 
@@ -663,6 +941,236 @@ size_t VSIUnixStdioHandle::PRead(void *pBuffer, size_t nSize,
 }
 #endif
 
+#ifdef HAVE_IO_URING
+
+/************************************************************************/
+/*                        ~VSIUnixStdioHandle()                         */
+/************************************************************************/
+
+VSIUnixStdioHandle::~VSIUnixStdioHandle()
+{
+    if (m_nDirectFD >= 0)
+        close(m_nDirectFD);
+}
+
+/************************************************************************/
+/*                            GetIOUring()                              */
+/************************************************************************/
+
+VSIIOUring *VSIUnixStdioHandle::GetIOUring()
+{
+    if (m_bIOUringInitDone)
+        return m_poIOUring.get();
+    m_bIOUringInitDone = true;
+
+    if (!CPLTestBool(CPLGetConfigOption("CPL_VSIL_USE_IO_URING", "NO")))
+        return nullptr;
+
+    auto poIOUring = std::make_unique<VSIIOUring>();
+    const int nQueueDepth = std::max(
+        1, std::min(4096, atoi(CPLGetConfigOption(
+                              "CPL_VSIL_IO_URING_QUEUE_DEPTH", "64"))));
+    if (!poIOUring->Init(static_cast<unsigned>(nQueueDepth)))
+    {
+        CPLDebug("VSI", "io_uring not available: %s", VSIStrerror(errno));
+        return nullptr;
+    }
+    m_poIOUring = std::move(poIOUring);
+
+#ifdef O_DIRECT
+    if (bReadOnly &&
+        CPLTestBool(CPLGetConfigOption("CPL_VSIL_IO_URING_DIRECT", "NO")))
+    {
+        // Re-open the file, bypassing the page cache
+        m_nDirectFD = open(CPLSPrintf("/proc/self/fd/%d", fileno(fp)),
+                           O_RDONLY | O_DIRECT | O_CLOEXEC);
+        if (m_nDirectFD < 0)
+        {
+            CPLDebug("VSI", "Cannot open file with O_DIRECT: %s",
+                     VSIStrerror(errno));
+        }
+    }
+#endif
+
+    return m_poIOUring.get();
+}
+
+/************************************************************************/
+/*                          ReadMultiRange()                            */
+/************************************************************************/
+
+int VSIUnixStdioHandle::ReadMultiRange(int nRanges, void **ppData,
+                                       const vsi_l_offset *panOffsets,
+                                       const size_t *panSizes)
+{
+    VSIIOUring *poIOUring = GetIOUring();
+    if (poIOUring == nullptr || nRanges <= 0)
+    {
+        return VSIVirtualHandle::ReadMultiRange(nRanges, ppData, panOffsets,
+                                                panSizes);
+    }
+
+    // Make sure pending writes are visible to reads done on the descriptor
+    if (bLastOpWrite)
+        fflush(fp);
+
+    // With O_DIRECT, offsets, sizes and buffers must be aligned on the
+    // logical block size of the device, so read into aligned buffers.
+    constexpr size_t DIRECT_IO_ALIGNMENT = 4096;
+    const bool bDirect = m_nDirectFD >= 0;
+    const int fd = bDirect ? m_nDirectFD : fileno(fp);
+    std::vector<struct iovec> asIOVec(nRanges);
+    std::vector<vsi_l_offset> anReadOffsets(nRanges);
+    std::vector<GByte *> apabyAligned;
+    const auto FreeAlignedBuffers = [&apabyAligned]()
+    {
+        for (GByte *pabyBuffer : apabyAligned)
+            VSIFreeAligned(pabyBuffer);
+    };
+    for (int i = 0; i < nRanges; ++i)
+    {
+        if (bDirect)
+        {
+            const vsi_l_offset nStart =
+                panOffsets[i] & ~static_cast<vsi_l_offset>(
+                                    DIRECT_IO_ALIGNMENT - 1);
+            const vsi_l_offset nEnd =
+                (panOffsets[i] + panSizes[i] + DIRECT_IO_ALIGNMENT - 1) &
+                ~static_cast<vsi_l_offset>(DIRECT_IO_ALIGNMENT - 1);
+            const size_t nAlignedSize = static_cast<size_t>(nEnd - nStart);
+            GByte *pabyBuffer = static_cast<GByte *>(
+                VSIMallocAligned(DIRECT_IO_ALIGNMENT, nAlignedSize));
+            if (pabyBuffer == nullptr)
+            {
+                FreeAlignedBuffers();
+                return VSIVirtualHandle::ReadMultiRange(nRanges, ppData,
+                                                        panOffsets, panSizes);
+            }
+            apabyAligned.push_back(pabyBuffer);
+            asIOVec[i].iov_base = pabyBuffer;
+            asIOVec[i].iov_len = nAlignedSize;
+            anReadOffsets[i] = nStart;
+        }
+        else
+        {
+            asIOVec[i].iov_base = ppData[i];
+            asIOVec[i].iov_len = panSizes[i];
+            anReadOffsets[i] = panOffsets[i];
+        }
+    }
+
+    // Submit all ranges at once
+    std::vector<int> anResults;
+    if (!poIOUring->Run(
+            nRanges,
+            [&asIOVec, &anReadOffsets, fd](int i, struct io_uring_sqe *psSQE)
+            {
+                psSQE->opcode = IORING_OP_READV;
+                psSQE->fd = fd;
+                psSQE->addr = reinterpret_cast<uintptr_t>(&asIOVec[i]);
+                psSQE->len = 1;
+                psSQE->off = anReadOffsets[i];
+            },
+            anResults))
+    {
+        CPLDebug("VSI", "io_uring failed: %s. Disabling it for this file",
+                 VSIStrerror(errno));
+        if (poIOUring->HasOperationsInFlight())
+        {
+            // The kernel may still write into the buffers and read the
+            // iovecs of reads that could not be waited for, so leak them
+            // rather than freeing them.
+            apabyAligned.clear();
+            CPL_IGNORE_RET_VAL(
+                new std::vector<struct iovec>(std::move(asIOVec)));
+        }
+        FreeAlignedBuffers();
+        m_poIOUring.reset();
+        return VSIVirtualHandle::ReadMultiRange(nRanges, ppData, panOffsets,
+                                                panSizes);
+    }
+
+    int nRet = 0;
+    for (int i = 0; i < nRanges; ++i)
+    {
+        GByte *pabyDst = static_cast<GByte *>(ppData[i]);
+        size_t nGot = 0;
+        if (anResults[i] > 0)
+        {
+            const size_t nRead = static_cast<size_t>(anResults[i]);
+            if (bDirect)
+            {
+                const size_t nSkip =
+                    static_cast<size_t>(panOffsets[i] - anReadOffsets[i]);
+                if (nRead > nSkip)
+                {
+                    nGot = std::min(nRead - nSkip, panSizes[i]);
+                    memcpy(pabyDst, apabyAligned[i] + nSkip, nGot);
+                }
+            }
+            else
+            {
+                nGot = nRead;
+            }
+        }
+
+        // Complete short or failed reads with the regular descriptor
+        while (nGot < panSizes[i])
+        {
+            const size_t nRead =
+                PRead(pabyDst + nGot, panSizes[i] - nGot, panOffsets[i] + nGot);
+            if (nRead == 0 || nRead == static_cast<size_t>(-1))
+                break;
+            nGot += nRead;
+        }
+#ifdef VSI_COUNT_BYTES_READ
+        nTotalBytesRead += nGot;
+#endif
+        if (nGot < panSizes[i])
+            nRet = -1;
+    }
+    FreeAlignedBuffers();
+
+    return nRet;
+}
+
+/************************************************************************/
+/*                            AdviseRead()                              */
+/************************************************************************/
+
+void VSIUnixStdioHandle::AdviseRead(int nRanges,
+                                    const vsi_l_offset *panOffsets,
+                                    const size_t *panSizes)
+{
+    VSIIOUring *poIOUring = GetIOUring();
+    if (poIOUring == nullptr || nRanges <= 0)
+        return;
+
+    // Kernels older than 5.6 do not know IORING_OP_FADVISE, and the
+    // operations then just fail, which is harmless for a hint.
+    const int fd = fileno(fp);
+    std::vector<int> anResults;
+    if (!poIOUring->Run(
+            nRanges,
+            [panOffsets, panSizes, fd](int i, struct io_uring_sqe *psSQE)
+            {
+                psSQE->opcode = IORING_OP_FADVISE;
+                psSQE->fd = fd;
+                psSQE->off = panOffsets[i];
+                psSQE->len = static_cast<__u32>(std::min<size_t>(
+                    panSizes[i], std::numeric_limits<__u32>::max()));
+                psSQE->fadvise_advice = POSIX_FADV_WILLNEED;
+            },
+            anResults))
+    {
+        CPLDebug("VSI", "io_uring failed: %s. Disabling it for this file",
+                 VSIStrerror(errno));
+        m_poIOUring.reset();
+    }
+}
+
+#endif  // HAVE_IO_URING
+
 /************************************************************************/
 /* ==================================================================== */
 /*                       VSIUnixStdioFilesystemHandler                  */
@@ -940,6 +1448,21 @@ int VSIUnixStdioFilesystemHandler::SupportsSparseFiles(const char *
 #endif
 }
 
+#ifdef HAVE_IO_URING
+
+/************************************************************************/
+/*                     HasOptimizedReadMultiRange()                     */
+/************************************************************************/
+
+int VSIUnixStdioFilesystemHandler::HasOptimizedReadMultiRange(
+    const char * /* pszPath */)
+{
+    return CPLTestBool(CPLGetConfigOption("CPL_VSIL_USE_IO_URING", "NO")) &&
+           VSIIOUring::IsAvailable();
+}
+
+#endif
+
 /************************************************************************/
 /*                          IsLocal()                                   */
 /************************************************************************/
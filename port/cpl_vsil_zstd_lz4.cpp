@@ -0,0 +1,1627 @@
+/******************************************************************************
+ *
+ * Project:  CPL - Common Portability Library
+ * Purpose:  Implement VSI large file api for Zstandard (.zst) and LZ4 (.lz4)
+ *           streams.
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+//! @cond Doxygen_Suppress
+
+#include "cpl_port.h"
+#include "cpl_conv.h"
+#include "cpl_error.h"
+#include "cpl_mem_cache.h"
+#include "cpl_string.h"
+#include "cpl_vsi.h"
+#include "cpl_vsi_virtual.h"
+
+#if defined(HAVE_ZSTD) || defined(HAVE_LZ4)
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "cpl_worker_thread_pool.h"
+
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#ifdef HAVE_LZ4
+#include <lz4frame.h>
+#endif
+
+namespace
+{
+
+/************************************************************************/
+/*                  GetCompressorThreadCount()                          */
+/************************************************************************/
+
+static int GetCompressorThreadCount()
+{
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (!pszThreads)
+        return 1;
+    const int nThreads =
+        EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszThreads);
+    return std::max(1, std::min(128, nThreads));
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                          VSIStreamDecoder                            */
+/* ==================================================================== */
+/************************************************************************/
+
+// Incremental decoder of a sequence of concatenated frames.
+class VSIStreamDecoder
+{
+  public:
+    virtual ~VSIStreamDecoder() = default;
+
+    // Resets the decoder so that it can start decoding at a frame start.
+    virtual bool Reset() = 0;
+
+    // Decodes from pabyIn into pabyOut, and returns the number of bytes
+    // read and written. bFrameEnd is set when the end of a frame has been
+    // reached and all its data has been output, in which case decoding
+    // stops there. Returns false on error.
+    virtual bool Decode(const GByte *pabyIn, size_t nInSize,
+                        size_t &nInConsumed, GByte *pabyOut, size_t nOutSize,
+                        size_t &nOutProduced, bool &bFrameEnd) = 0;
+};
+
+/************************************************************************/
+/* ==================================================================== */
+/*                       VSIFramedStreamReadHandle                      */
+/* ==================================================================== */
+/************************************************************************/
+
+// Read handle over a stream made of one or several compressed frames.
+// The position in the compressed and uncompressed streams of the start of
+// each frame is recorded as it is decoded (or given upfront, when the file
+// has a seek table), so that backward seeks and forward seeks beyond a
+// known frame only need to decode from the start of the nearest frame.
+
+class VSIFramedStreamReadHandle final : public VSIVirtualHandle
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSIFramedStreamReadHandle)
+
+  public:
+    struct FrameStart
+    {
+        vsi_l_offset nCompressedOffset = 0;
+        vsi_l_offset nUncompressedOffset = 0;
+    };
+
+  private:
+    VSIVirtualHandleUniquePtr m_poBaseHandle{};
+    std::unique_ptr<VSIStreamDecoder> m_poDecoder{};
+    std::string m_osFilename{};
+
+    std::vector<FrameStart> m_aoFrameStarts{};
+    bool m_bSizeKnown = false;
+    vsi_l_offset m_nUncompressedSize = 0;
+
+    std::vector<GByte> m_abyInBuffer{};
+    size_t m_nInBufferPos = 0;
+    size_t m_nInBufferSize = 0;
+    vsi_l_offset m_nInBufferOffset = 0;  // compressed offset of buffer start
+    bool m_bInFrame = false;
+    bool m_bStreamEnd = false;
+    bool m_bError = false;
+
+    vsi_l_offset m_nDecodedPos = 0;  // uncompressed offset of the decoder
+    vsi_l_offset m_nPos = 0;         // position of the user
+    bool m_bEOF = false;
+
+    bool Restart(const FrameStart &oFrameStart);
+    bool Reposition();
+    size_t Decode(GByte *pabyOut, size_t nOutSize);
+
+  public:
+    VSIFramedStreamReadHandle(VSIVirtualHandleUniquePtr &&poBaseHandle,
+                              std::unique_ptr<VSIStreamDecoder> &&poDecoder,
+                              const char *pszFilename);
+
+    void SetFrameIndex(std::vector<FrameStart> &&aoFrameStarts,
+                       vsi_l_offset nUncompressedSize);
+
+    int Seek(vsi_l_offset nOffset, int nWhence) override;
+    vsi_l_offset Tell() override;
+    size_t Read(void *pBuffer, size_t nSize, size_t nMemb) override;
+    size_t Write(const void *pBuffer, size_t nSize, size_t nMemb) override;
+    int Eof() override;
+    int Close() override;
+};
+
+/************************************************************************/
+/*                    VSIFramedStreamReadHandle()                       */
+/************************************************************************/
+
+VSIFramedStreamReadHandle::VSIFramedStreamReadHandle(
+    VSIVirtualHandleUniquePtr &&poBaseHandle,
+    std::unique_ptr<VSIStreamDecoder> &&poDecoder, const char *pszFilename)
+    : m_poBaseHandle(std::move(poBaseHandle)),
+      m_poDecoder(std::move(poDecoder)), m_osFilename(pszFilename),
+      m_aoFrameStarts(1), m_abyInBuffer(128 * 1024)
+{
+}
+
+/************************************************************************/
+/*                           SetFrameIndex()                            */
+/************************************************************************/
+
+void VSIFramedStreamReadHandle::SetFrameIndex(
+    std::vector<FrameStart> &&aoFrameStarts, vsi_l_offset nUncompressedSize)
+{
+    m_aoFrameStarts = std::move(aoFrameStarts);
+    m_bSizeKnown = true;
+    m_nUncompressedSize = nUncompressedSize;
+}
+
+/************************************************************************/
+/*                              Restart()                               */
+/************************************************************************/
+
+bool VSIFramedStreamReadHandle::Restart(const FrameStart &oFrameStart)
+{
+    if (!m_poDecoder->Reset())
+    {
+        m_bError = true;
+        return false;
+    }
+    m_nInBufferOffset = oFrameStart.nCompressedOffset;
+    m_nInBufferPos = 0;
+    m_nInBufferSize = 0;
+    m_nDecodedPos = oFrameStart.nUncompressedOffset;
+    m_bInFrame = false;
+    m_bStreamEnd = false;
+    return true;
+}
+
+/************************************************************************/
+/*                               Decode()                               */
+/************************************************************************/
+
+// Decodes up to nOutSize bytes at m_nDecodedPos. pabyOut may be null to
+// just skip data.
+size_t VSIFramedStreamReadHandle::Decode(GByte *pabyOut, size_t nOutSize)
+{
+    std::vector<GByte> abySkipBuffer;
+    if (pabyOut == nullptr)
+        abySkipBuffer.resize(std::min(nOutSize, static_cast<size_t>(65536)));
+
+    size_t nProduced = 0;
+    while (nProduced < nOutSize && !m_bStreamEnd && !m_bError)
+    {
+        if (m_nInBufferPos == m_nInBufferSize)
+        {
+            m_nInBufferOffset += m_nInBufferSize;
+            m_nInBufferPos = 0;
+            m_nInBufferSize = 0;
+            if (m_poBaseHandle->Seek(m_nInBufferOffset, SEEK_SET) == 0)
+            {
+                m_nInBufferSize = m_poBaseHandle->Read(
+                    m_abyInBuffer.data(), 1, m_abyInBuffer.size());
+            }
+            if (m_nInBufferSize == 0)
+            {
+                if (m_bInFrame)
+                {
+                    CPLError(CE_Failure, CPLE_FileIO,
+                             "Truncated compressed stream in %s",
+                             m_osFilename.c_str());
+                    m_bError = true;
+                    break;
+                }
+                m_bStreamEnd = true;
+                m_bSizeKnown = true;
+                m_nUncompressedSize = m_nDecodedPos;
+                break;
+            }
+        }
+
+        GByte *pabyDst = pabyOut ? pabyOut + nProduced : abySkipBuffer.data();
+        const size_t nDstSize =
+            pabyOut ? nOutSize - nProduced
+                    : std::min(nOutSize - nProduced, abySkipBuffer.size());
+        size_t nConsumed = 0;
+        size_t nWritten = 0;
+        bool bFrameEnd = false;
+        if (!m_poDecoder->Decode(m_abyInBuffer.data() + m_nInBufferPos,
+                                 m_nInBufferSize - m_nInBufferPos, nConsumed,
+                                 pabyDst, nDstSize, nWritten, bFrameEnd))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Decompression of %s failed at offset " CPL_FRMT_GUIB,
+                     m_osFilename.c_str(), m_nInBufferOffset + m_nInBufferPos);
+            m_bError = true;
+            break;
+        }
+        m_nInBufferPos += nConsumed;
+        nProduced += nWritten;
+        m_nDecodedPos += nWritten;
+        if (bFrameEnd)
+        {
+            m_bInFrame = false;
+            const vsi_l_offset nNextFrameOffset =
+                m_nInBufferOffset + m_nInBufferPos;
+            if (nNextFrameOffset > m_aoFrameStarts.back().nCompressedOffset)
+            {
+                FrameStart oFrameStart;
+                oFrameStart.nCompressedOffset = nNextFrameOffset;
+                oFrameStart.nUncompressedOffset = m_nDecodedPos;
+                m_aoFrameStarts.push_back(oFrameStart);
+            }
+        }
+        else if (nConsumed > 0)
+        {
+            m_bInFrame = true;
+        }
+    }
+    return nProduced;
+}
+
+/************************************************************************/
+/*                             Reposition()                             */
+/************************************************************************/
+
+// Moves the decoder to m_nPos.
+bool VSIFramedStreamReadHandle::Reposition()
+{
+    if (m_bError)
+        return false;
+    if (m_nPos == m_nDecodedPos)
+        return true;
+
+    // Find the last frame starting before the target position
+    const auto oIter = std::upper_bound(
+        m_aoFrameStarts.begin(), m_aoFrameStarts.end(), m_nPos,
+        [](vsi_l_offset nVal, const FrameStart &oFrameStart)
+        { return nVal < oFrameStart.nUncompressedOffset; });
+    const FrameStart &oFrameStart = *(oIter - 1);
+    if (m_nPos < m_nDecodedPos ||
+        oFrameStart.nUncompressedOffset > m_nDecodedPos)
+    {
+        if (!Restart(oFrameStart))
+            return false;
+    }
+
+    while (m_nDecodedPos < m_nPos && !m_bStreamEnd && !m_bError)
+    {
+        Decode(nullptr, static_cast<size_t>(std::min(
+                            m_nPos - m_nDecodedPos,
+                            static_cast<vsi_l_offset>(1024 * 1024 * 1024))));
+    }
+    return m_nDecodedPos == m_nPos;
+}
+
+/************************************************************************/
+/*                                Seek()                                */
+/************************************************************************/
+
+int VSIFramedStreamReadHandle::Seek(vsi_l_offset nOffset, int nWhence)
+{
+    m_bEOF = false;
+    if (nWhence == SEEK_SET)
+    {
+        m_nPos = nOffset;
+    }
+    else if (nWhence == SEEK_CUR)
+    {
+        m_nPos += nOffset;
+    }
+    else if (nWhence == SEEK_END && nOffset == 0)
+    {
+        if (!m_bSizeKnown)
+        {
+            // Decode the remaining of the stream, starting from the last
+            // known frame.
+            const vsi_l_offset nPosBefore = m_nPos;
+            m_nPos = std::numeric_limits<vsi_l_offset>::max();
+            Reposition();
+            if (m_bError)
+            {
+                m_nPos = nPosBefore;
+                return -1;
+            }
+        }
+        m_nPos = m_nUncompressedSize;
+    }
+    else
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Seek mode not supported on compressed streams.");
+        return -1;
+    }
+    return 0;
+}
+
+/************************************************************************/
+/*                                Tell()                                */
+/************************************************************************/
+
+vsi_l_offset VSIFramedStreamReadHandle::Tell()
+{
+    return m_nPos;
+}
+
+/************************************************************************/
+/*                                Read()                                */
+/************************************************************************/
+
+size_t VSIFramedStreamReadHandle::Read(void *pBuffer, size_t nSize,
+                                       size_t nMemb)
+{
+    const size_t nToRead = nSize * nMemb;
+    if (nToRead == 0)
+        return 0;
+    if (m_bSizeKnown && m_nPos >= m_nUncompressedSize)
+    {
+        m_bEOF = true;
+        return 0;
+    }
+    if (!Reposition())
+    {
+        m_bEOF = true;
+        return 0;
+    }
+    const size_t nRead = Decode(static_cast<GByte *>(pBuffer), nToRead);
+    m_nPos += nRead;
+    if (nRead < nToRead)
+        m_bEOF = true;
+    return nRead / nSize;
+}
+
+/************************************************************************/
+/*                               Write()                                */
+/************************************************************************/
+
+size_t VSIFramedStreamReadHandle::Write(const void * /* pBuffer */,
+                                        size_t /* nSize */, size_t /* nMemb */)
+{
+    CPLError(CE_Failure, CPLE_NotSupported,
+             "VSIFWriteL is not supported on compressed streams opened in "
+             "read mode");
+    return 0;
+}
+
+/************************************************************************/
+/*                                Eof()                                 */
+/************************************************************************/
+
+int VSIFramedStreamReadHandle::Eof()
+{
+    return m_bEOF;
+}
+
+/************************************************************************/
+/*                               Close()                                */
+/************************************************************************/
+
+int VSIFramedStreamReadHandle::Close()
+{
+    if (!m_poBaseHandle)
+        return 0;
+    const int nRet = m_poBaseHandle->Close();
+    m_poBaseHandle.reset();
+    return nRet;
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                    VSIFramedStreamFilesystemHandler                  */
+/* ==================================================================== */
+/************************************************************************/
+
+// Base class for the /vsizstd/ and /vsilz4/ handlers.
+
+class VSIFramedStreamFilesystemHandler : public VSIFilesystemHandler
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSIFramedStreamFilesystemHandler)
+
+    // Uncompressed size of recently stat'ed files, keyed by base filename.
+    // Only valid as long as the size and modification time of the
+    // compressed file are unchanged.
+    struct CachedSize
+    {
+        GIntBig nCompressedSize = 0;
+        GIntBig nMTime = 0;
+        GIntBig nUncompressedSize = 0;
+    };
+
+    std::mutex m_oMutex{};
+    lru11::Cache<std::string, CachedSize> m_oCacheSizes{64};
+
+  protected:
+    const std::string m_osPrefix;
+
+    VSIFramedStreamFilesystemHandler(const char *pszPrefix)
+        : m_osPrefix(pszPrefix)
+    {
+    }
+
+    virtual VSIFramedStreamReadHandle *
+    CreateReadHandle(VSIVirtualHandleUniquePtr &&poBaseHandle,
+                     const char *pszBaseFilename) = 0;
+    virtual VSIVirtualHandle *
+    CreateWriteHandle(VSIVirtualHandleUniquePtr &&poBaseHandle) = 0;
+
+    const char *GetBaseFilename(const char *pszFilename) const
+    {
+        if (!STARTS_WITH_CI(pszFilename, m_osPrefix.c_str()))
+            return nullptr;
+        return pszFilename + m_osPrefix.size();
+    }
+
+  public:
+    VSIVirtualHandle *Open(const char *pszFilename, const char *pszAccess,
+                           bool bSetError,
+                           CSLConstList /* papszOptions */) override;
+    int Stat(const char *pszFilename, VSIStatBufL *pStatBuf,
+             int nFlags) override;
+    int Unlink(const char *pszFilename) override;
+    int Rename(const char *oldpath, const char *newpath) override;
+    int Mkdir(const char *pszDirname, long nMode) override;
+    int Rmdir(const char *pszDirname) override;
+    char **ReadDirEx(const char *pszDirname, int nMaxFiles) override;
+
+    bool SupportsSequentialWrite(const char *pszPath,
+                                 bool bAllowLocalTempFile) override;
+    bool SupportsRandomWrite(const char * /* pszPath */,
+                             bool /* bAllowLocalTempFile */) override
+    {
+        return false;
+    }
+};
+
+/************************************************************************/
+/*                                Open()                                */
+/************************************************************************/
+
+VSIVirtualHandle *VSIFramedStreamFilesystemHandler::Open(
+    const char *pszFilename, const char *pszAccess, bool bSetError,
+    CSLConstList /* papszOptions */)
+{
+    const char *pszBaseFilename = GetBaseFilename(pszFilename);
+    if (pszBaseFilename == nullptr)
+        return nullptr;
+
+    if (strchr(pszAccess, 'w') != nullptr)
+    {
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            m_oCacheSizes.remove(pszBaseFilename);
+        }
+        if (strchr(pszAccess, '+') != nullptr)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Write+update (w+) not supported for %s, "
+                     "only read-only or write-only.",
+                     m_osPrefix.c_str());
+            return nullptr;
+        }
+        VSIVirtualHandleUniquePtr poBaseHandle(
+            VSIFOpenExL(pszBaseFilename, "wb", bSetError));
+        if (!poBaseHandle)
+            return nullptr;
+        return CreateWriteHandle(std::move(poBaseHandle));
+    }
+
+    if (strchr(pszAccess, '+') != nullptr || strchr(pszAccess, 'a') != nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Only read-only or write-only access is supported for %s",
+                 m_osPrefix.c_str());
+        return nullptr;
+    }
+
+    VSIVirtualHandleUniquePtr poBaseHandle(
+        VSIFOpenExL(pszBaseFilename, "rb", bSetError));
+    if (!poBaseHandle)
+        return nullptr;
+    return CreateReadHandle(std::move(poBaseHandle), pszBaseFilename);
+}
+
+/************************************************************************/
+/*                                Stat()                                */
+/************************************************************************/
+
+int VSIFramedStreamFilesystemHandler::Stat(const char *pszFilename,
+                                           VSIStatBufL *pStatBuf, int nFlags)
+{
+    const char *pszBaseFilename = GetBaseFilename(pszFilename);
+    if (pszBaseFilename == nullptr)
+        return -1;
+
+    memset(pStatBuf, 0, sizeof(VSIStatBufL));
+    const int nRet = VSIStatExL(pszBaseFilename, pStatBuf, nFlags);
+    if (nRet == 0 && (nFlags & VSI_STAT_SIZE_FLAG) != 0)
+    {
+        const GIntBig nCompressedSize = static_cast<GIntBig>(pStatBuf->st_size);
+        const GIntBig nMTime = static_cast<GIntBig>(pStatBuf->st_mtime);
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            CachedSize sCachedSize;
+            if (m_oCacheSizes.tryGet(pszBaseFilename, sCachedSize) &&
+                sCachedSize.nCompressedSize == nCompressedSize &&
+                sCachedSize.nMTime == nMTime)
+            {
+                pStatBuf->st_size =
+                    static_cast<vsi_l_offset>(sCachedSize.nUncompressedSize);
+                return nRet;
+            }
+        }
+
+        // Unless the file has a seek table, this requires decompressing
+        // the whole file.
+        std::unique_ptr<VSIVirtualHandle> poHandle(
+            Open(pszFilename, "rb", false, nullptr));
+        if (!poHandle || poHandle->Seek(0, SEEK_END) != 0)
+        {
+            CPLDebug("VSI", "Cannot determine uncompressed size of %s",
+                     pszFilename);
+            return -1;
+        }
+        pStatBuf->st_size = poHandle->Tell();
+
+        CachedSize sCachedSize;
+        sCachedSize.nCompressedSize = nCompressedSize;
+        sCachedSize.nMTime = nMTime;
+        sCachedSize.nUncompressedSize =
+            static_cast<GIntBig>(pStatBuf->st_size);
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_oCacheSizes.insert(pszBaseFilename, sCachedSize);
+    }
+    return nRet;
+}
+
+/************************************************************************/
+/*                               Unlink()                               */
+/************************************************************************/
+
+int VSIFramedStreamFilesystemHandler::Unlink(const char * /* pszFilename */)
+{
+    return -1;
+}
+
+/************************************************************************/
+/*                               Rename()                               */
+/************************************************************************/
+
+int VSIFramedStreamFilesystemHandler::Rename(const char * /* oldpath */,
+                                             const char * /* newpath */)
+{
+    return -1;
+}
+
+/************************************************************************/
+/*                               Mkdir()                                */
+/************************************************************************/
+
+int VSIFramedStreamFilesystemHandler::Mkdir(const char * /* pszDirname */,
+                                            long /* nMode */)
+{
+    return -1;
+}
+
+/************************************************************************/
+/*                               Rmdir()                                */
+/************************************************************************/
+
+int VSIFramedStreamFilesystemHandler::Rmdir(const char * /* pszDirname */)
+{
+    return -1;
+}
+
+/************************************************************************/
+/*                             ReadDirEx()                              */
+/************************************************************************/
+
+char **VSIFramedStreamFilesystemHandler::ReadDirEx(const char * /*pszDirname*/,
+                                                   int /* nMaxFiles */)
+{
+    return nullptr;
+}
+
+/************************************************************************/
+/*                      SupportsSequentialWrite()                       */
+/************************************************************************/
+
+bool VSIFramedStreamFilesystemHandler::SupportsSequentialWrite(
+    const char *pszPath, bool bAllowLocalTempFile)
+{
+    const char *pszBaseFilename = GetBaseFilename(pszPath);
+    if (pszBaseFilename == nullptr)
+        return false;
+    VSIFilesystemHandler *poFSHandler =
+        VSIFileManager::GetHandler(pszBaseFilename);
+    return poFSHandler->SupportsSequentialWrite(pszBaseFilename,
+                                                bAllowLocalTempFile);
+}
+
+#ifdef HAVE_ZSTD
+
+/************************************************************************/
+/* ==================================================================== */
+/*                           VSIZstdDecoder                             */
+/* ==================================================================== */
+/************************************************************************/
+
+class VSIZstdDecoder final : public VSIStreamDecoder
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSIZstdDecoder)
+
+    ZSTD_DStream *m_psDStream = nullptr;
+
+  public:
+    VSIZstdDecoder() : m_psDStream(ZSTD_createDStream())
+    {
+    }
+
+    ~VSIZstdDecoder() override
+    {
+        ZSTD_freeDStream(m_psDStream);
+    }
+
+    bool Reset() override
+    {
+        return m_psDStream != nullptr &&
+               !ZSTD_isError(ZSTD_DCtx_reset(m_psDStream,
+                                             ZSTD_reset_session_only));
+    }
+
+    bool Decode(const GByte *pabyIn, size_t nInSize, size_t &nInConsumed,
+                GByte *pabyOut, size_t nOutSize, size_t &nOutProduced,
+                bool &bFrameEnd) override
+    {
+        ZSTD_inBuffer sIn = {pabyIn, nInSize, 0};
+        ZSTD_outBuffer sOut = {pabyOut, nOutSize, 0};
+        const size_t nRet = ZSTD_decompressStream(m_psDStream, &sOut, &sIn);
+        nInConsumed = sIn.pos;
+        nOutProduced = sOut.pos;
+        if (ZSTD_isError(nRet))
+        {
+            CPLDebug("ZSTD", "ZSTD_decompressStream() failed: %s",
+                     ZSTD_getErrorName(nRet));
+            return false;
+        }
+        bFrameEnd = nRet == 0;
+        return true;
+    }
+};
+
+/************************************************************************/
+/*                        Seekable format constants                     */
+/************************************************************************/
+
+// See https://github.com/facebook/zstd/blob/dev/contrib/seekable_format/zstd_seekable_compression_format.md
+constexpr uint32_t ZSTD_SKIPPABLE_SEEK_TABLE_MAGIC = 0x184D2A5E;
+constexpr uint32_t ZSTD_SEEKABLE_MAGIC = 0x8F92EAB1;
+constexpr int ZSTD_SEEK_TABLE_FOOTER_SIZE = 9;
+constexpr int ZSTD_SKIPPABLE_HEADER_SIZE = 8;
+
+/************************************************************************/
+/*                       ReadZstdSeekTable()                            */
+/************************************************************************/
+
+// Reads the seek table at the end of a file using the seekable zstd
+// format, and fills the start offsets of the frames and the uncompressed
+// size. Returns false if there is none (or it is invalid).
+static bool
+ReadZstdSeekTable(VSIVirtualHandle *poBaseHandle,
+                  std::vector<VSIFramedStreamReadHandle::FrameStart> &aoStarts,
+                  vsi_l_offset &nUncompressedSize)
+{
+    if (poBaseHandle->Seek(0, SEEK_END) != 0)
+        return false;
+    const vsi_l_offset nFileSize = poBaseHandle->Tell();
+    if (nFileSize < ZSTD_SKIPPABLE_HEADER_SIZE + ZSTD_SEEK_TABLE_FOOTER_SIZE)
+        return false;
+
+    GByte abyFooter[ZSTD_SEEK_TABLE_FOOTER_SIZE];
+    if (poBaseHandle->Seek(nFileSize - ZSTD_SEEK_TABLE_FOOTER_SIZE,
+                           SEEK_SET) != 0 ||
+        poBaseHandle->Read(abyFooter, 1, sizeof(abyFooter)) !=
+            sizeof(abyFooter))
+    {
+        return false;
+    }
+    uint32_t nMagic;
+    memcpy(&nMagic, abyFooter + 5, sizeof(nMagic));
+    CPL_LSBPTR32(&nMagic);
+    if (nMagic != ZSTD_SEEKABLE_MAGIC || (abyFooter[4] & 0x7C) != 0)
+        return false;
+    uint32_t nFrames;
+    memcpy(&nFrames, abyFooter, sizeof(nFrames));
+    CPL_LSBPTR32(&nFrames);
+    const bool bHasChecksum = (abyFooter[4] & 0x80) != 0;
+    const size_t nEntrySize = bHasChecksum ? 12 : 8;
+    const vsi_l_offset nTableSize =
+        static_cast<vsi_l_offset>(nFrames) * nEntrySize +
+        ZSTD_SEEK_TABLE_FOOTER_SIZE;
+    if (nTableSize + ZSTD_SKIPPABLE_HEADER_SIZE > nFileSize ||
+        nTableSize > 100 * 1024 * 1024)
+    {
+        return false;
+    }
+
+    std::vector<GByte> abyTable;
+    try
+    {
+        abyTable.resize(static_cast<size_t>(nTableSize) +
+                        ZSTD_SKIPPABLE_HEADER_SIZE);
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+    if (poBaseHandle->Seek(nFileSize - abyTable.size(), SEEK_SET) != 0 ||
+        poBaseHandle->Read(abyTable.data(), 1, abyTable.size()) !=
+            abyTable.size())
+    {
+        return false;
+    }
+    uint32_t nSkippableMagic;
+    memcpy(&nSkippableMagic, abyTable.data(), sizeof(nSkippableMagic));
+    CPL_LSBPTR32(&nSkippableMagic);
+    uint32_t nSkippableSize;
+    memcpy(&nSkippableSize, abyTable.data() + 4, sizeof(nSkippableSize));
+    CPL_LSBPTR32(&nSkippableSize);
+    if (nSkippableMagic != ZSTD_SKIPPABLE_SEEK_TABLE_MAGIC ||
+        nSkippableSize != nTableSize)
+    {
+        return false;
+    }
+
+    aoStarts.clear();
+    aoStarts.resize(1);
+    const vsi_l_offset nDataSize = nFileSize - abyTable.size();
+    for (uint32_t i = 0; i < nFrames; ++i)
+    {
+        const GByte *pabyEntry =
+            abyTable.data() + ZSTD_SKIPPABLE_HEADER_SIZE + i * nEntrySize;
+        uint32_t nCompressedSize;
+        memcpy(&nCompressedSize, pabyEntry, sizeof(nCompressedSize));
+        CPL_LSBPTR32(&nCompressedSize);
+        uint32_t nDecompressedSize;
+        memcpy(&nDecompressedSize, pabyEntry + 4, sizeof(nDecompressedSize));
+        CPL_LSBPTR32(&nDecompressedSize);
+        VSIFramedStreamReadHandle::FrameStart oNext;
+        oNext.nCompressedOffset =
+            aoStarts.back().nCompressedOffset + nCompressedSize;
+        oNext.nUncompressedOffset =
+            aoStarts.back().nUncompressedOffset + nDecompressedSize;
+        if (oNext.nCompressedOffset > nDataSize)
+            return false;
+        aoStarts.push_back(oNext);
+    }
+    if (aoStarts.back().nCompressedOffset != nDataSize)
+        return false;
+    nUncompressedSize = aoStarts.back().nUncompressedOffset;
+    // The last entry is the end of the stream, not a frame start
+    aoStarts.pop_back();
+    if (aoStarts.empty())
+        aoStarts.resize(1);
+    return true;
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                          VSIZstdWriteHandle                          */
+/* ==================================================================== */
+/************************************************************************/
+
+// Writes either a single frame with the zstd streaming API (using zstd own
+// multi-threading when GDAL_NUM_THREADS is set), or, in seekable mode, a
+// sequence of independent frames compressed in parallel by a thread pool,
+// followed by a seek table.
+
+class VSIZstdWriteHandle final : public VSIVirtualHandle
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSIZstdWriteHandle)
+
+    struct Job
+    {
+        std::string osIn{};
+        std::string osOut{};
+        int nLevel = 0;
+        bool bOK = false;
+        std::atomic<bool> bDone{false};
+    };
+
+    VSIVirtualHandleUniquePtr m_poBaseHandle{};
+    int m_nLevel = ZSTD_CLEVEL_DEFAULT;
+    bool m_bError = false;
+    vsi_l_offset m_nCurOffset = 0;
+
+    // Streaming mode
+    ZSTD_CStream *m_psCStream = nullptr;
+    std::vector<GByte> m_abyOutBuffer{};
+
+    // Seekable mode
+    bool m_bSeekable = false;
+    size_t m_nFrameSize = 0;
+    size_t m_nMaxJobs = 0;
+    std::unique_ptr<CPLWorkerThreadPool> m_poPool{};
+    std::deque<std::unique_ptr<Job>> m_apoJobs{};
+    std::string m_osFrame{};
+    std::vector<std::pair<uint32_t, uint32_t>> m_anFrameSizes{};
+
+    bool StreamCompress(const void *pData, size_t nSize,
+                        ZSTD_EndDirective eDirective);
+    static void CompressJob(void *pData);
+    bool SubmitFrame();
+    bool WriteFinishedFrames(bool bWaitAll);
+
+  public:
+    explicit VSIZstdWriteHandle(VSIVirtualHandleUniquePtr &&poBaseHandle);
+    ~VSIZstdWriteHandle() override;
+
+    int Seek(vsi_l_offset nOffset, int nWhence) override;
+    vsi_l_offset Tell() override;
+    size_t Read(void *pBuffer, size_t nSize, size_t nMemb) override;
+    size_t Write(const void *pBuffer, size_t nSize, size_t nMemb) override;
+    int Eof() override;
+    int Close() override;
+};
+
+/************************************************************************/
+/*                        VSIZstdWriteHandle()                          */
+/************************************************************************/
+
+VSIZstdWriteHandle::VSIZstdWriteHandle(
+    VSIVirtualHandleUniquePtr &&poBaseHandle)
+    : m_poBaseHandle(std::move(poBaseHandle))
+{
+    m_nLevel = std::max(
+        1, std::min(ZSTD_maxCLevel(),
+                    atoi(CPLGetConfigOption(
+                        "CPL_VSIL_ZSTD_LEVEL",
+                        CPLSPrintf("%d", ZSTD_CLEVEL_DEFAULT)))));
+    const int nThreads = GetCompressorThreadCount();
+    m_bSeekable =
+        CPLTestBool(CPLGetConfigOption("CPL_VSIL_ZSTD_SEEKABLE", "NO"));
+    if (m_bSeekable)
+    {
+        const char *pszFrameSize =
+            CPLGetConfigOption("CPL_VSIL_ZSTD_FRAME_SIZE", "1024K");
+        m_nFrameSize = static_cast<size_t>(atoi(pszFrameSize));
+        if (strchr(pszFrameSize, 'K'))
+            m_nFrameSize *= 1024;
+        else if (strchr(pszFrameSize, 'M'))
+            m_nFrameSize *= 1024 * 1024;
+        // Frame sizes are stored as 32 bit values in the seek table
+        m_nFrameSize =
+            std::max(static_cast<size_t>(4 * 1024),
+                     std::min(static_cast<size_t>(1024 * 1024 * 1024),
+                              m_nFrameSize));
+        m_nMaxJobs = 1;
+        if (nThreads > 1)
+        {
+            m_poPool = std::make_unique<CPLWorkerThreadPool>();
+            if (m_poPool->Setup(nThreads, nullptr, nullptr))
+                m_nMaxJobs = static_cast<size_t>(nThreads) * 2;
+            else
+                m_poPool.reset();
+        }
+    }
+    else
+    {
+        m_psCStream = ZSTD_createCStream();
+        if (!m_psCStream)
+        {
+            m_bError = true;
+            return;
+        }
+        ZSTD_CCtx_setParameter(m_psCStream, ZSTD_c_compressionLevel,
+                               m_nLevel);
+        ZSTD_CCtx_setParameter(m_psCStream, ZSTD_c_checksumFlag, 1);
+        if (nThreads > 1 &&
+            ZSTD_isError(ZSTD_CCtx_setParameter(
+                m_psCStream, ZSTD_c_nbWorkers, nThreads)))
+        {
+            CPLDebug("ZSTD", "libzstd built without multi-threading support");
+        }
+        m_abyOutBuffer.resize(ZSTD_CStreamOutSize());
+    }
+}
+
+/************************************************************************/
+/*                        ~VSIZstdWriteHandle()                         */
+/************************************************************************/
+
+VSIZstdWriteHandle::~VSIZstdWriteHandle()
+{
+    VSIZstdWriteHandle::Close();
+    ZSTD_freeCStream(m_psCStream);
+}
+
+/************************************************************************/
+/*                          StreamCompress()                            */
+/************************************************************************/
+
+bool VSIZstdWriteHandle::StreamCompress(const void *pData, size_t nSize,
+                                        ZSTD_EndDirective eDirective)
+{
+    ZSTD_inBuffer sIn = {pData, nSize, 0};
+    while (true)
+    {
+        ZSTD_outBuffer sOut = {m_abyOutBuffer.data(), m_abyOutBuffer.size(),
+                               0};
+        const size_t nRemaining =
+            ZSTD_compressStream2(m_psCStream, &sOut, &sIn, eDirective);
+        if (ZSTD_isError(nRemaining))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "ZSTD_compressStream2() failed: %s",
+                     ZSTD_getErrorName(nRemaining));
+            return false;
+        }
+        if (sOut.pos > 0 &&
+            m_poBaseHandle->Write(m_abyOutBuffer.data(), 1, sOut.pos) !=
+                sOut.pos)
+        {
+            return false;
+        }
+        if (eDirective == ZSTD_e_end ? nRemaining == 0 : sIn.pos == sIn.size)
+            return true;
+    }
+}
+
+/************************************************************************/
+/*                            CompressJob()                             */
+/************************************************************************/
+
+void VSIZstdWriteHandle::CompressJob(void *pData)
+{
+    Job *psJob = static_cast<Job *>(pData);
+    ZSTD_CCtx *psCCtx = ZSTD_createCCtx();
+    if (psCCtx)
+    {
+        ZSTD_CCtx_setParameter(psCCtx, ZSTD_c_compressionLevel, psJob->nLevel);
+        ZSTD_CCtx_setParameter(psCCtx, ZSTD_c_checksumFlag, 1);
+        try
+        {
+            psJob->osOut.resize(ZSTD_compressBound(psJob->osIn.size()));
+            const size_t nRet =
+                ZSTD_compress2(psCCtx, &psJob->osOut[0], psJob->osOut.size(),
+                               psJob->osIn.data(), psJob->osIn.size());
+            if (!ZSTD_isError(nRet))
+            {
+                psJob->osOut.resize(nRet);
+                psJob->bOK = true;
+            }
+        }
+        catch (const std::exception &)
+        {
+        }
+        ZSTD_freeCCtx(psCCtx);
+    }
+    psJob->bDone = true;
+}
+
+/************************************************************************/
+/*                            SubmitFrame()                             */
+/************************************************************************/
+
+bool VSIZstdWriteHandle::SubmitFrame()
+{
+    auto psJob = std::make_unique<Job>();
+    psJob->osIn = std::move(m_osFrame);
+    psJob->nLevel = m_nLevel;
+    m_osFrame.clear();
+    Job *psJobPtr = psJob.get();
+    m_apoJobs.push_back(std::move(psJob));
+    if (m_poPool)
+    {
+        if (!m_poPool->SubmitJob(CompressJob, psJobPtr))
+            return false;
+    }
+    else
+    {
+        CompressJob(psJobPtr);
+    }
+    return WriteFinishedFrames(false);
+}
+
+/************************************************************************/
+/*                        WriteFinishedFrames()                         */
+/************************************************************************/
+
+// Writes, in order, the frames that have been compressed. Waits for the
+// oldest ones if too many are in flight, or for all of them if bWaitAll.
+bool VSIZstdWriteHandle::WriteFinishedFrames(bool bWaitAll)
+{
+    while (!m_apoJobs.empty())
+    {
+        Job *psJob = m_apoJobs.front().get();
+        if (!psJob->bDone)
+        {
+            if (!bWaitAll && m_apoJobs.size() < m_nMaxJobs)
+                break;
+            m_poPool->WaitEvent();
+            continue;
+        }
+        if (!psJob->bOK)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Compression of zstd frame failed");
+            return false;
+        }
+        if (m_poBaseHandle->Write(psJob->osOut.data(), 1,
+                                  psJob->osOut.size()) != psJob->osOut.size())
+        {
+            return false;
+        }
+        m_anFrameSizes.emplace_back(static_cast<uint32_t>(psJob->osOut.size()),
+                                    static_cast<uint32_t>(psJob->osIn.size()));
+        m_apoJobs.pop_front();
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                               Write()                                */
+/************************************************************************/
+
+size_t VSIZstdWriteHandle::Write(const void *pBuffer, size_t nSize,
+                                 size_t nMemb)
+{
+    if (m_bError || !m_poBaseHandle)
+        return 0;
+    const size_t nBytes = nSize * nMemb;
+    if (nBytes == 0)
+        return 0;
+
+    if (!m_bSeekable)
+    {
+        if (!StreamCompress(pBuffer, nBytes, ZSTD_e_continue))
+        {
+            m_bError = true;
+            return 0;
+        }
+    }
+    else
+    {
+        const char *pszData = static_cast<const char *>(pBuffer);
+        size_t nOffset = 0;
+        while (nOffset < nBytes)
+        {
+            const size_t nToCopy =
+                std::min(nBytes - nOffset, m_nFrameSize - m_osFrame.size());
+            m_osFrame.append(pszData + nOffset, nToCopy);
+            nOffset += nToCopy;
+            if (m_osFrame.size() == m_nFrameSize && !SubmitFrame())
+            {
+                m_bError = true;
+                return 0;
+            }
+        }
+    }
+    m_nCurOffset += nBytes;
+    return nMemb;
+}
+
+/************************************************************************/
+/*                               Close()                                */
+/************************************************************************/
+
+int VSIZstdWriteHandle::Close()
+{
+    if (!m_poBaseHandle)
+        return 0;
+
+    bool bOK = !m_bError;
+    if (bOK && !m_bSeekable)
+    {
+        bOK = StreamCompress(nullptr, 0, ZSTD_e_end);
+    }
+    else if (m_bSeekable)
+    {
+        if (bOK && !m_osFrame.empty())
+            bOK = SubmitFrame();
+        if (m_poPool)
+            m_poPool->WaitCompletion();
+        bOK = bOK && WriteFinishedFrames(true);
+        if (bOK)
+        {
+            // Write the seek table
+            const uint32_t nFrames =
+                static_cast<uint32_t>(m_anFrameSizes.size());
+            std::vector<GByte> abyTable;
+            const auto AppendUInt32 = [&abyTable](uint32_t nVal)
+            {
+                CPL_LSBPTR32(&nVal);
+                const GByte *pabyVal = reinterpret_cast<const GByte *>(&nVal);
+                abyTable.insert(abyTable.end(), pabyVal, pabyVal + 4);
+            };
+            AppendUInt32(ZSTD_SKIPPABLE_SEEK_TABLE_MAGIC);
+            AppendUInt32(nFrames * 8 + ZSTD_SEEK_TABLE_FOOTER_SIZE);
+            for (const auto &oFrameSizes : m_anFrameSizes)
+            {
+                AppendUInt32(oFrameSizes.first);
+                AppendUInt32(oFrameSizes.second);
+            }
+            AppendUInt32(nFrames);
+            abyTable.push_back(0);  // descriptor: no checksums
+            AppendUInt32(ZSTD_SEEKABLE_MAGIC);
+            bOK = m_poBaseHandle->Write(abyTable.data(), 1, abyTable.size()) ==
+                  abyTable.size();
+        }
+        m_apoJobs.clear();
+        m_poPool.reset();
+    }
+
+    if (m_poBaseHandle->Close() != 0)
+        bOK = false;
+    m_poBaseHandle.reset();
+    return bOK ? 0 : -1;
+}
+
+/************************************************************************/
+/*                                Seek()                                */
+/************************************************************************/
+
+int VSIZstdWriteHandle::Seek(vsi_l_offset nOffset, int nWhence)
+{
+    if (nOffset == 0 && (nWhence == SEEK_END || nWhence == SEEK_CUR))
+        return 0;
+    else if (nWhence == SEEK_SET && nOffset == m_nCurOffset)
+        return 0;
+    CPLError(CE_Failure, CPLE_NotSupported,
+             "Seeking on writable compressed data streams not supported.");
+    return -1;
+}
+
+/************************************************************************/
+/*                                Tell()                                */
+/************************************************************************/
+
+vsi_l_offset VSIZstdWriteHandle::Tell()
+{
+    return m_nCurOffset;
+}
+
+/************************************************************************/
+/*                                Read()                                */
+/************************************************************************/
+
+size_t VSIZstdWriteHandle::Read(void * /* pBuffer */, size_t /* nSize */,
+                                size_t /* nMemb */)
+{
+    CPLError(CE_Failure, CPLE_NotSupported,
+             "VSIFReadL is not supported on compressed streams opened in "
+             "write mode");
+    return 0;
+}
+
+/************************************************************************/
+/*                                Eof()                                 */
+/************************************************************************/
+
+int VSIZstdWriteHandle::Eof()
+{
+    return 0;
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                       VSIZstdFilesystemHandler                       */
+/* ==================================================================== */
+/************************************************************************/
+
+class VSIZstdFilesystemHandler final : public VSIFramedStreamFilesystemHandler
+{
+  protected:
+    VSIFramedStreamReadHandle *
+    CreateReadHandle(VSIVirtualHandleUniquePtr &&poBaseHandle,
+                     const char *pszBaseFilename) override
+    {
+        std::vector<VSIFramedStreamReadHandle::FrameStart> aoStarts;
+        vsi_l_offset nUncompressedSize = 0;
+        const bool bHasSeekTable =
+            ReadZstdSeekTable(poBaseHandle.get(), aoStarts, nUncompressedSize);
+        auto poHandle = new VSIFramedStreamReadHandle(
+            std::move(poBaseHandle), std::make_unique<VSIZstdDecoder>(),
+            pszBaseFilename);
+        if (bHasSeekTable)
+            poHandle->SetFrameIndex(std::move(aoStarts), nUncompressedSize);
+        return poHandle;
+    }
+
+    VSIVirtualHandle *
+    CreateWriteHandle(VSIVirtualHandleUniquePtr &&poBaseHandle) override
+    {
+        return new VSIZstdWriteHandle(std::move(poBaseHandle));
+    }
+
+  public:
+    VSIZstdFilesystemHandler() : VSIFramedStreamFilesystemHandler("/vsizstd/")
+    {
+    }
+
+    const char *GetOptions() override
+    {
+        return "<Options>"
+               "  <Option name='GDAL_NUM_THREADS' type='string' "
+               "description='Number of threads for compression. Either a "
+               "integer or ALL_CPUS'/>"
+               "  <Option name='CPL_VSIL_ZSTD_LEVEL' type='int' "
+               "description='Compression level' min='1' max='22' "
+               "default='3'/>"
+               "  <Option name='CPL_VSIL_ZSTD_SEEKABLE' type='boolean' "
+               "description='Whether to write the file using the seekable "
+               "zstd format' default='NO'/>"
+               "  <Option name='CPL_VSIL_ZSTD_FRAME_SIZE' type='string' "
+               "description='Uncompressed size of frames in the seekable "
+               "format. Use K(ilobytes) or M(egabytes) suffix' default='1M'/>"
+               "</Options>";
+    }
+};
+
+#endif  // HAVE_ZSTD
+
+#ifdef HAVE_LZ4
+
+/************************************************************************/
+/* ==================================================================== */
+/*                            VSILZ4Decoder                             */
+/* ==================================================================== */
+/************************************************************************/
+
+class VSILZ4Decoder final : public VSIStreamDecoder
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSILZ4Decoder)
+
+    LZ4F_dctx *m_psDCtx = nullptr;
+
+  public:
+    VSILZ4Decoder()
+    {
+        if (LZ4F_isError(LZ4F_createDecompressionContext(&m_psDCtx,
+                                                         LZ4F_VERSION)))
+        {
+            m_psDCtx = nullptr;
+        }
+    }
+
+    ~VSILZ4Decoder() override
+    {
+        if (m_psDCtx)
+            LZ4F_freeDecompressionContext(m_psDCtx);
+    }
+
+    bool Reset() override
+    {
+        if (!m_psDCtx)
+            return false;
+        LZ4F_resetDecompressionContext(m_psDCtx);
+        return true;
+    }
+
+    bool Decode(const GByte *pabyIn, size_t nInSize, size_t &nInConsumed,
+                GByte *pabyOut, size_t nOutSize, size_t &nOutProduced,
+                bool &bFrameEnd) override
+    {
+        nInConsumed = nInSize;
+        nOutProduced = nOutSize;
+        const size_t nRet = LZ4F_decompress(m_psDCtx, pabyOut, &nOutProduced,
+                                            pabyIn, &nInConsumed, nullptr);
+        if (LZ4F_isError(nRet))
+        {
+            CPLDebug("LZ4", "LZ4F_decompress() failed: %s",
+                     LZ4F_getErrorName(nRet));
+            return false;
+        }
+        bFrameEnd = nRet == 0;
+        return true;
+    }
+};
+
+/************************************************************************/
+/* ==================================================================== */
+/*                           VSILZ4WriteHandle                          */
+/* ==================================================================== */
+/************************************************************************/
+
+class VSILZ4WriteHandle final : public VSIVirtualHandle
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSILZ4WriteHandle)
+
+    VSIVirtualHandleUniquePtr m_poBaseHandle{};
+    LZ4F_cctx *m_psCCtx = nullptr;
+    LZ4F_preferences_t m_sPrefs{};
+    std::vector<GByte> m_abyOutBuffer{};
+    bool m_bError = false;
+    vsi_l_offset m_nCurOffset = 0;
+
+    static constexpr size_t INPUT_CHUNK_SIZE = 64 * 1024;
+
+    bool WriteOutput(size_t nSize);
+
+  public:
+    explicit VSILZ4WriteHandle(VSIVirtualHandleUniquePtr &&poBaseHandle);
+    ~VSILZ4WriteHandle() override;
+
+    int Seek(vsi_l_offset nOffset, int nWhence) override;
+    vsi_l_offset Tell() override;
+    size_t Read(void *pBuffer, size_t nSize, size_t nMemb) override;
+    size_t Write(const void *pBuffer, size_t nSize, size_t nMemb) override;
+    int Eof() override;
+    int Close() override;
+};
+
+/************************************************************************/
+/*                         VSILZ4WriteHandle()                          */
+/************************************************************************/
+
+VSILZ4WriteHandle::VSILZ4WriteHandle(VSIVirtualHandleUniquePtr &&poBaseHandle)
+    : m_poBaseHandle(std::move(poBaseHandle))
+{
+    m_sPrefs.frameInfo.blockMode = LZ4F_blockIndependent;
+    m_sPrefs.frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+    m_sPrefs.compressionLevel =
+        atoi(CPLGetConfigOption("CPL_VSIL_LZ4_LEVEL", "0"));
+
+    if (LZ4F_isError(LZ4F_createCompressionContext(&m_psCCtx, LZ4F_VERSION)))
+    {
+        m_psCCtx = nullptr;
+        m_bError = true;
+        return;
+    }
+    m_abyOutBuffer.resize(std::max(
+        static_cast<size_t>(LZ4F_HEADER_SIZE_MAX),
+        LZ4F_compressBound(INPUT_CHUNK_SIZE, &m_sPrefs)));
+    const size_t nRet = LZ4F_compressBegin(m_psCCtx, m_abyOutBuffer.data(),
+                                           m_abyOutBuffer.size(), &m_sPrefs);
+    m_bError = LZ4F_isError(nRet) || !WriteOutput(nRet);
+}
+
+/************************************************************************/
+/*                         ~VSILZ4WriteHandle()                         */
+/************************************************************************/
+
+VSILZ4WriteHandle::~VSILZ4WriteHandle()
+{
+    VSILZ4WriteHandle::Close();
+    if (m_psCCtx)
+        LZ4F_freeCompressionContext(m_psCCtx);
+}
+
+/************************************************************************/
+/*                            WriteOutput()                             */
+/************************************************************************/
+
+bool VSILZ4WriteHandle::WriteOutput(size_t nSize)
+{
+    return nSize == 0 ||
+           m_poBaseHandle->Write(m_abyOutBuffer.data(), 1, nSize) == nSize;
+}
+
+/************************************************************************/
+/*                               Write()                                */
+/************************************************************************/
+
+size_t VSILZ4WriteHandle::Write(const void *pBuffer, size_t nSize,
+                                size_t nMemb)
+{
+    if (m_bError || !m_poBaseHandle)
+        return 0;
+    const size_t nBytes = nSize * nMemb;
+    const GByte *pabyData = static_cast<const GByte *>(pBuffer);
+    for (size_t nOffset = 0; nOffset < nBytes; nOffset += INPUT_CHUNK_SIZE)
+    {
+        const size_t nRet = LZ4F_compressUpdate(
+            m_psCCtx, m_abyOutBuffer.data(), m_abyOutBuffer.size(),
+            pabyData + nOffset, std::min(INPUT_CHUNK_SIZE, nBytes - nOffset),
+            nullptr);
+        if (LZ4F_isError(nRet) || !WriteOutput(nRet))
+        {
+            m_bError = true;
+            return 0;
+        }
+    }
+    m_nCurOffset += nBytes;
+    return nMemb;
+}
+
+/************************************************************************/
+/*                               Close()                                */
+/************************************************************************/
+
+int VSILZ4WriteHandle::Close()
+{
+    if (!m_poBaseHandle)
+        return 0;
+
+    bool bOK = !m_bError;
+    if (bOK)
+    {
+        const size_t nRet = LZ4F_compressEnd(m_psCCtx, m_abyOutBuffer.data(),
+                                             m_abyOutBuffer.size(), nullptr);
+        bOK = !LZ4F_isError(nRet) && WriteOutput(nRet);
+    }
+    if (m_poBaseHandle->Close() != 0)
+        bOK = false;
+    m_poBaseHandle.reset();
+    return bOK ? 0 : -1;
+}
+
+/************************************************************************/
+/*                                Seek()                                */
+/************************************************************************/
+
+int VSILZ4WriteHandle::Seek(vsi_l_offset nOffset, int nWhence)
+{
+    if (nOffset == 0 && (nWhence == SEEK_END || nWhence == SEEK_CUR))
+        return 0;
+    else if (nWhence == SEEK_SET && nOffset == m_nCurOffset)
+        return 0;
+    CPLError(CE_Failure, CPLE_NotSupported,
+             "Seeking on writable compressed data streams not supported.");
+    return -1;
+}
+
+/************************************************************************/
+/*                                Tell()                                */
+/************************************************************************/
+
+vsi_l_offset VSILZ4WriteHandle::Tell()
+{
+    return m_nCurOffset;
+}
+
+/************************************************************************/
+/*                                Read()                                */
+/************************************************************************/
+
+size_t VSILZ4WriteHandle::Read(void * /* pBuffer */, size_t /* nSize */,
+                               size_t /* nMemb */)
+{
+    CPLError(CE_Failure, CPLE_NotSupported,
+             "VSIFReadL is not supported on compressed streams opened in "
+             "write mode");
+    return 0;
+}
+
+/************************************************************************/
+/*                                Eof()                                 */
+/************************************************************************/
+
+int VSILZ4WriteHandle::Eof()
+{
+    return 0;
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                       VSILZ4FilesystemHandler                        */
+/* ==================================================================== */
+/************************************************************************/
+
+class VSILZ4FilesystemHandler final : public VSIFramedStreamFilesystemHandler
+{
+  protected:
+    VSIFramedStreamReadHandle *
+    CreateReadHandle(VSIVirtualHandleUniquePtr &&poBaseHandle,
+                     const char *pszBaseFilename) override
+    {
+        return new VSIFramedStreamReadHandle(std::move(poBaseHandle),
+                                             std::make_unique<VSILZ4Decoder>(),
+                                             pszBaseFilename);
+    }
+
+    VSIVirtualHandle *
+    CreateWriteHandle(VSIVirtualHandleUniquePtr &&poBaseHandle) override
+    {
+        return new VSILZ4WriteHandle(std::move(poBaseHandle));
+    }
+
+  public:
+    VSILZ4FilesystemHandler() : VSIFramedStreamFilesystemHandler("/vsilz4/")
+    {
+    }
+
+    const char *GetOptions() override
+    {
+        return "<Options>"
+               "  <Option name='CPL_VSIL_LZ4_LEVEL' type='int' "
+               "description='Compression level. 0 for fast mode, 3 or more "
+               "for high compression mode' min='0' max='12' default='0'/>"
+               "</Options>";
+    }
+};
+
+#endif  // HAVE_LZ4
+
+}  // namespace
+
+#endif  // defined(HAVE_ZSTD) || defined(HAVE_LZ4)
+
+//! @endcond
+
+/************************************************************************/
+/*                     VSIInstallZstdFileHandler()                      */
+/************************************************************************/
+
+/*!
+ \brief Install Zstandard file system handler.
+
+ A special file handler is installed that allows reading on-the-fly and
+ writing in Zstandard (.zst) files.
+
+ All portions of the file system underneath the base
+ path "/vsizstd/" will be handled by this driver.
+
+ \verbatim embed:rst
+ See :ref:`/vsizstd/ documentation <vsizstd>`
+ \endverbatim
+
+ @since GDAL 3.9
+ */
+
+void VSIInstallZstdFileHandler()
+{
+#ifdef HAVE_ZSTD
+    VSIFileManager::InstallHandler("/vsizstd/", new VSIZstdFilesystemHandler);
+#endif
+}
+
+/************************************************************************/
+/*                      VSIInstallLZ4FileHandler()                      */
+/************************************************************************/
+
+/*!
+ \brief Install LZ4 file system handler.
+
+ A special file handler is installed that allows reading on-the-fly and
+ writing in LZ4 frame format (.lz4) files.
+
+ All portions of the file system underneath the base
+ path "/vsilz4/" will be handled by this driver.
+
+ \verbatim embed:rst
+ See :ref:`/vsilz4/ documentation <vsilz4>`
+ \endverbatim
+
+ @since GDAL 3.9
+ */
+
+void VSIInstallLZ4FileHandler()
+{
+#ifdef HAVE_LZ4
+    VSIFileManager::InstallHandler("/vsilz4/", new VSILZ4FilesystemHandler);
+#endif
+}
@@ -49,13 +49,19 @@
 #include "cpl_vsi.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cerrno>
 #include <cstdarg>
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
 #if HAVE_SYS_STAT_H
 #include <sys/stat.h>
 #endif
@@ -72,6 +78,11 @@
 #include <malloc.h>  // For _aligned_malloc
 #endif
 
+#if defined(__linux) && defined(HAVE_MMAP)
+#define VSI_LARGE_ALLOC_USE_MMAP
+#include <sys/mman.h>  // mmap, munmap, madvise
+#endif
+
 // Uncomment to check consistent usage of VSIMalloc(), VSIRealloc(),
 // VSICalloc(), VSIFree(), VSIStrdup().
 // #define DEBUG_VSIMALLOC
@@ -1002,6 +1013,242 @@ void VSIFreeAligned(void *ptr)
 #endif
 }
 
+/************************************************************************/
+/*                         VSIMallocLarge()                             */
+/************************************************************************/
+
+namespace
+{
+// Header stored in the 64 bytes that precede a buffer returned by
+// VSIMallocLarge()
+struct VSILargeAllocHeader
+{
+    uint32_t nMagic;
+    uint32_t bMapped;
+    void *pBase;
+    size_t nMappedSize;
+};
+
+constexpr uint32_t VSI_LARGE_ALLOC_MAGIC = 0x4C415247;  // "LARG"
+constexpr size_t VSI_LARGE_ALLOC_HEADER_SIZE = 64;
+static_assert(sizeof(VSILargeAllocHeader) <= VSI_LARGE_ALLOC_HEADER_SIZE,
+              "sizeof(VSILargeAllocHeader) <= VSI_LARGE_ALLOC_HEADER_SIZE");
+
+#ifdef VSI_LARGE_ALLOC_USE_MMAP
+constexpr size_t VSI_HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+// Allocations of at least this size are backed by huge pages
+constexpr size_t VSI_HUGE_PAGE_THRESHOLD = 2 * VSI_HUGE_PAGE_SIZE;
+
+void *VSIMallocLargeMapped(size_t nSize, bool bHugeTLB)
+{
+    // Room for the header before a buffer aligned on a huge page boundary
+    if (nSize > std::numeric_limits<size_t>::max() - 3 * VSI_HUGE_PAGE_SIZE)
+        return nullptr;
+    const size_t nRoundedSize =
+        (nSize + VSI_HUGE_PAGE_SIZE - 1) / VSI_HUGE_PAGE_SIZE *
+        VSI_HUGE_PAGE_SIZE;
+    const size_t nMappedSize = nRoundedSize + 2 * VSI_HUGE_PAGE_SIZE;
+
+    void *pBase = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (bHugeTLB)
+    {
+        // Fails if not enough huge pages have been reserved by the
+        // administrator, in which case we fallback to transparent huge pages
+        pBase = mmap(nullptr, nMappedSize, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    }
+#else
+    CPL_IGNORE_RET_VAL(bHugeTLB);
+#endif
+    if (pBase == MAP_FAILED)
+    {
+        pBase = mmap(nullptr, nMappedSize, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (pBase == MAP_FAILED)
+            return nullptr;
+    }
+
+    const uintptr_t nAligned =
+        (reinterpret_cast<uintptr_t>(pBase) + VSI_LARGE_ALLOC_HEADER_SIZE +
+         VSI_HUGE_PAGE_SIZE - 1) /
+        VSI_HUGE_PAGE_SIZE * VSI_HUGE_PAGE_SIZE;
+    GByte *pabyData = reinterpret_cast<GByte *>(nAligned);
+#ifdef MADV_HUGEPAGE
+    CPL_IGNORE_RET_VAL(madvise(pabyData, nRoundedSize, MADV_HUGEPAGE));
+#endif
+
+    VSILargeAllocHeader *psHeader = reinterpret_cast<VSILargeAllocHeader *>(
+        pabyData - VSI_LARGE_ALLOC_HEADER_SIZE);
+    psHeader->nMagic = VSI_LARGE_ALLOC_MAGIC;
+    psHeader->bMapped = TRUE;
+    psHeader->pBase = pBase;
+    psHeader->nMappedSize = nMappedSize;
+    return pabyData;
+}
+#endif
+
+void *VSIMallocLargeInternal(size_t nSize, bool bZeroInit)
+{
+#ifdef VSI_LARGE_ALLOC_USE_MMAP
+    if (nSize >= VSI_HUGE_PAGE_THRESHOLD)
+    {
+        const char *pszHugePages =
+            CPLGetConfigOption("CPL_HUGE_PAGES", "MADVISE");
+        if (!EQUAL(pszHugePages, "NO"))
+        {
+            // Pages of a new anonymous mapping are zero-initialized, and
+            // only allocated on first touch.
+            void *pRet =
+                VSIMallocLargeMapped(nSize, EQUAL(pszHugePages, "HUGETLB"));
+            if (pRet)
+                return pRet;
+        }
+    }
+#endif
+
+    if (nSize >
+        std::numeric_limits<size_t>::max() - VSI_LARGE_ALLOC_HEADER_SIZE)
+        return nullptr;
+    GByte *pabyBase = static_cast<GByte *>(
+        VSIMallocAligned(64, nSize + VSI_LARGE_ALLOC_HEADER_SIZE));
+    if (!pabyBase)
+        return nullptr;
+    VSILargeAllocHeader *psHeader =
+        reinterpret_cast<VSILargeAllocHeader *>(pabyBase);
+    psHeader->nMagic = VSI_LARGE_ALLOC_MAGIC;
+    psHeader->bMapped = FALSE;
+    psHeader->pBase = pabyBase;
+    psHeader->nMappedSize = 0;
+    GByte *pabyData = pabyBase + VSI_LARGE_ALLOC_HEADER_SIZE;
+    if (bZeroInit)
+        memset(pabyData, 0, nSize);
+    return pabyData;
+}
+
+}  // namespace
+
+/** Allocates a potentially large buffer.
+ *
+ * The returned buffer is aligned on 64 bytes, as with VSIMallocAlignedAuto(),
+ * so that it can be used by SIMD code.
+ *
+ * On Linux, buffers of at least 4 MB are directly mapped from the operating
+ * system, aligned on a 2 MB boundary, and flagged with MADV_HUGEPAGE, so that
+ * the kernel backs them with transparent huge pages. This reduces TLB misses
+ * when they are accessed randomly. This can be controlled with the
+ * CPL_HUGE_PAGES configuration option:
+ * <ul>
+ * <li>MADVISE (default): use transparent huge pages.</li>
+ * <li>HUGETLB: use huge pages reserved by the administrator (MAP_HUGETLB),
+ *     and fallback to transparent huge pages if there are not enough of
+ *     them.</li>
+ * <li>NO: use the regular allocator.</li>
+ * </ul>
+ *
+ * Physical pages of mapped buffers are only allocated when they are first
+ * written, on the NUMA node of the thread that touches them first.
+ *
+ * The return value must be freed with VSIFreeLarge().
+ *
+ * @param nSize Size of the buffer to allocate.
+ * @return a buffer, or NULL
+ * @since GDAL 3.9
+ */
+void *VSIMallocLarge(size_t nSize)
+{
+    return VSIMallocLargeInternal(nSize, false);
+}
+
+/************************************************************************/
+/*                         VSICallocLarge()                             */
+/************************************************************************/
+
+/** Allocates a potentially large buffer, initialized to zero.
+ *
+ * This is the equivalent of VSICalloc() for VSIMallocLarge(). Zero
+ * initialization of buffers mapped from the operating system is free, and
+ * does not touch their pages.
+ *
+ * The return value must be freed with VSIFreeLarge().
+ *
+ * @param nCount Number of elements.
+ * @param nSize Size of each element.
+ * @return a buffer, or NULL
+ * @since GDAL 3.9
+ */
+void *VSICallocLarge(size_t nCount, size_t nSize)
+{
+    if (nSize != 0 && nCount > std::numeric_limits<size_t>::max() / nSize)
+        return nullptr;
+    return VSIMallocLargeInternal(nCount * nSize, true);
+}
+
+/************************************************************************/
+/*                       VSICallocLargeVerbose()                        */
+/************************************************************************/
+
+/** See VSICallocLarge() */
+void *VSICallocLargeVerbose(size_t nCount, size_t nSize, const char *pszFile,
+                            int nLine)
+{
+    void *pRet = VSICallocLarge(nCount, nSize);
+    if (pRet == nullptr && nCount != 0 && nSize != 0)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "%s, %d: cannot allocate " CPL_FRMT_GUIB " bytes",
+                 pszFile ? pszFile : "(unknown file)", nLine,
+                 static_cast<GUIntBig>(nCount) * static_cast<GUIntBig>(nSize));
+    }
+    return pRet;
+}
+
+/************************************************************************/
+/*                       VSIMallocLargeVerbose()                        */
+/************************************************************************/
+
+/** See VSIMallocLarge() */
+void *VSIMallocLargeVerbose(size_t nSize, const char *pszFile, int nLine)
+{
+    void *pRet = VSIMallocLarge(nSize);
+    if (pRet == nullptr && nSize != 0)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "%s, %d: cannot allocate " CPL_FRMT_GUIB " bytes",
+                 pszFile ? pszFile : "(unknown file)", nLine,
+                 static_cast<GUIntBig>(nSize));
+    }
+    return pRet;
+}
+
+/************************************************************************/
+/*                          VSIFreeLarge()                              */
+/************************************************************************/
+
+/** Free a buffer allocated with VSIMallocLarge() or VSICallocLarge().
+ *
+ * @param ptr Buffer to free.
+ * @since GDAL 3.9
+ */
+void VSIFreeLarge(void *ptr)
+{
+    if (ptr == nullptr)
+        return;
+    const VSILargeAllocHeader *psHeader =
+        reinterpret_cast<const VSILargeAllocHeader *>(
+            static_cast<GByte *>(ptr) - VSI_LARGE_ALLOC_HEADER_SIZE);
+    CPLAssert(psHeader->nMagic == VSI_LARGE_ALLOC_MAGIC);
+#ifdef VSI_LARGE_ALLOC_USE_MMAP
+    if (psHeader->bMapped)
+    {
+        munmap(psHeader->pBase, psHeader->nMappedSize);
+        return;
+    }
+#endif
+    VSIFreeAligned(psHeader->pBase);
+}
+
 /************************************************************************/
 /*                             VSIStrdup()                              */
 /************************************************************************/
@@ -1642,3 +1889,100 @@ GIntBig CPLGetUsablePhysicalRAM(void)
 #endif
     return nRAM;
 }
+
+/************************************************************************/
+/*                          CPLAccountMemory()                          */
+/************************************************************************/
+
+namespace
+{
+struct AccountedMemory
+{
+    std::mutex oMutex{};
+    std::map<std::string, GIntBig> oMapCategoryToBytes{};
+    std::atomic<GIntBig> nTotal{0};
+};
+
+AccountedMemory &GetAccountedMemory()
+{
+    static AccountedMemory sAccountedMemory;
+    return sAccountedMemory;
+}
+}  // namespace
+
+/** Account for memory allocated, or released, by a component of GDAL.
+ *
+ * This is meant for large long-lived buffers that drivers and virtual file
+ * systems keep outside of the GDAL block cache (compression queues, decoded
+ * chunk caches, region caches, ...), so that they can be monitored with
+ * CPLGetAccountedMemory(). Drivers that allocate such memory on behalf of a
+ * dataset should rather use GDALDataset::AccountMemory(), which calls this
+ * function.
+ *
+ * @param pszCategory Name of the category of the allocation, conventionally
+ *                    of the form "{driver_or_component}.{buffer_kind}", such
+ *                    as "GTiff.compression_queue". Must not be NULL.
+ * @param nDeltaBytes Number of bytes allocated (positive value) or released
+ *                    (negative value).
+ * @since GDAL 3.9
+ */
+void CPLAccountMemory(const char *pszCategory, GIntBig nDeltaBytes)
+{
+    if (nDeltaBytes == 0)
+        return;
+    auto &sAccountedMemory = GetAccountedMemory();
+    std::lock_guard<std::mutex> oLock(sAccountedMemory.oMutex);
+    auto &nBytes = sAccountedMemory.oMapCategoryToBytes[pszCategory];
+    nBytes += nDeltaBytes;
+    CPLAssert(nBytes >= 0);
+    if (nBytes == 0)
+        sAccountedMemory.oMapCategoryToBytes.erase(pszCategory);
+    sAccountedMemory.nTotal += nDeltaBytes;
+}
+
+/************************************************************************/
+/*                        CPLGetAccountedMemory()                       */
+/************************************************************************/
+
+/** Return the memory currently accounted with CPLAccountMemory().
+ *
+ * @param pszCategory Name of a category, or NULL for the sum over all
+ *                    categories.
+ * @return a number of bytes.
+ * @since GDAL 3.9
+ */
+GIntBig CPLGetAccountedMemory(const char *pszCategory)
+{
+    auto &sAccountedMemory = GetAccountedMemory();
+    if (pszCategory == nullptr)
+        return sAccountedMemory.nTotal.load();
+    std::lock_guard<std::mutex> oLock(sAccountedMemory.oMutex);
+    const auto oIter =
+        sAccountedMemory.oMapCategoryToBytes.find(pszCategory);
+    return oIter == sAccountedMemory.oMapCategoryToBytes.end() ? 0
+                                                               : oIter->second;
+}
+
+/************************************************************************/
+/*                   CPLGetAccountedMemoryCategories()                  */
+/************************************************************************/
+
+/** Return the memory currently accounted with CPLAccountMemory(), per
+ * category.
+ *
+ * @return a NULL terminated list of "category=bytes" strings, to be freed
+ * with CSLDestroy().
+ * @since GDAL 3.9
+ */
+char **CPLGetAccountedMemoryCategories(void)
+{
+    auto &sAccountedMemory = GetAccountedMemory();
+    std::lock_guard<std::mutex> oLock(sAccountedMemory.oMutex);
+    CPLStringList aosList;
+    for (const auto &oIter : sAccountedMemory.oMapCategoryToBytes)
+    {
+        aosList.SetNameValue(oIter.first.c_str(),
+                             CPLSPrintf(CPL_FRMT_GIB, oIter.second));
+    }
+    return aosList.StealList();
+}
@@ -211,6 +211,9 @@ bool CPLWorkerThreadPool::SubmitJob(CPLThreadFunc pfnFunc, void *pData)
     psItem->psNext = psJobQueue;
     psJobQueue = psItem;
     nPendingJobs++;
+    // Worker threads waiting in CPLJobQueue::WaitCompletion() might have to
+    // run this job themselves.
+    m_cv.notify_all();
 
     if (psWaitingWorkerThreadsList)
     {
@@ -322,6 +325,8 @@ bool CPLWorkerThreadPool::SubmitJobs(CPLThreadFunc pfnFunc,
         nPendingJobs++;
     }
 
+    m_cv.notify_all();
+
     if (!bRet)
     {
         for (CPLList *psIter = psJobQueue; psIter != psJobQueueInit;)
@@ -382,6 +387,10 @@ bool CPLWorkerThreadPool::SubmitJobs(CPLThreadFunc pfnFunc,
 /************************************************************************/
 
 /** Wait for completion of part or whole jobs.
+ *
+ * This must not be called from a job of this pool, as the calling job counts
+ * itself as a pending job, and pending jobs are not run by the calling
+ * thread. Use CPLJobQueue::WaitCompletion() in that case.
  *
  * @param nMaxRemainingJobs Maximum number of pendings jobs that are allowed
  *                          in the queue after this method has completed. Might
@@ -403,6 +412,9 @@ void CPLWorkerThreadPool::WaitCompletion(int nMaxRemainingJobs)
 /************************************************************************/
 
 /** Wait for completion of at least one job, if there are any remaining
+ *
+ * Same as WaitCompletion(), this does not run pending jobs from the calling
+ * thread, and should not be used from a job of this pool.
  */
 void CPLWorkerThreadPool::WaitEvent()
 {
@@ -512,7 +524,8 @@ void CPLWorkerThreadPool::DeclareJobFinished()
 {
     std::lock_guard<std::mutex> oGuard(m_mutex);
     nPendingJobs--;
-    m_cv.notify_one();
+    m_nRunningJobs--;
+    m_cv.notify_all();
 }
 
 /************************************************************************/
@@ -540,6 +553,14 @@ CPLWorkerThreadPool::GetNextJob(CPLWorkerThread *psWorkerThread)
             CPLWorkerThreadJob *psJob =
                 static_cast<CPLWorkerThreadJob *>(psTopJobIter->pData);
             CPLFree(psTopJobIter);
+            m_nRunningJobs++;
+            if (m_nRunningJobs == static_cast<int>(aWT.size()))
+            {
+                // All threads are busy: wake up worker threads waiting in
+                // CPLJobQueue::WaitCompletion(), so that they run their
+                // pending jobs themselves.
+                m_cv.notify_all();
+            }
             return psJob;
         }
 
@@ -568,7 +589,7 @@ CPLWorkerThreadPool::GetNextJob(CPLWorkerThread *psWorkerThread)
 #endif
         }
 
-        m_cv.notify_one();
+        m_cv.notify_all();
 
 #if DEBUG_VERBOSE
         CPLDebug("JOB", "%p sleeping", psWorkerThread);
@@ -638,6 +659,41 @@ void CPLJobQueue::JobQueueFunction(void *pData)
     delete poJob;
 }
 
+/************************************************************************/
+/*                       TakePendingJobOfQueue()                        */
+/************************************************************************/
+
+/* Remove from the list of pending jobs, and return, a job that has been
+ * submitted through poQueue and not started yet. This is only done when all
+ * worker threads are busy, as otherwise an idle thread will pick it.
+ * Returns nullptr if there is no such job. The caller must hold m_mutex, run
+ * the job and then call DeclareJobFinished().
+ */
+CPLWorkerThreadJob *
+CPLWorkerThreadPool::TakePendingJobOfQueue(const CPLJobQueue *poQueue)
+{
+    if (m_nRunningJobs < static_cast<int>(aWT.size()))
+        return nullptr;
+    CPLList *psPrev = nullptr;
+    for (CPLList *psIter = psJobQueue; psIter; psIter = psIter->psNext)
+    {
+        auto psJob = static_cast<CPLWorkerThreadJob *>(psIter->pData);
+        if (psJob->pfnFunc == CPLJobQueue::JobQueueFunction &&
+            static_cast<JobQueueJob *>(psJob->pData)->poQueue == poQueue)
+        {
+            if (psPrev)
+                psPrev->psNext = psIter->psNext;
+            else
+                psJobQueue = psIter->psNext;
+            CPLFree(psIter);
+            m_nRunningJobs++;
+            return psJob;
+        }
+        psPrev = psIter;
+    }
+    return nullptr;
+}
+
 /************************************************************************/
 /*                          DeclareJobFinished()                        */
 /************************************************************************/
@@ -682,6 +738,10 @@ bool CPLJobQueue::SubmitJob(CPLThreadFunc pfnFunc, void *pData)
 /************************************************************************/
 
 /** Wait for completion of part or whole jobs.
+ *
+ * When called from a worker thread of the pool while all worker threads are
+ * busy, jobs of this queue that have not been started yet are run by the
+ * calling thread.
  *
  * @param nMaxRemainingJobs Maximum number of pendings jobs that are allowed
  *                          in the queue after this method has completed. Might
@@ -689,6 +749,41 @@ bool CPLJobQueue::SubmitJob(CPLThreadFunc pfnFunc, void *pData)
  */
 void CPLJobQueue::WaitCompletion(int nMaxRemainingJobs)
 {
+    // A worker thread waiting for its own jobs cannot count on other worker
+    // threads to pick them: they might all be busy waiting for jobs of their
+    // own queues, which would result in a deadlock. So run them from this
+    // thread when no other thread is available. This waits on the condition
+    // variable of the pool, which is notified when a job is submitted,
+    // started or finished, as any of these may change that situation. The
+    // completion of the jobs of this queue is covered, as the pool is
+    // notified right after the queue.
+    if (threadLocalCurrentThreadPool == m_poPool)
+    {
+        std::unique_lock<std::mutex> oPoolGuard(m_poPool->m_mutex);
+        while (true)
+        {
+            {
+                std::lock_guard<std::mutex> oGuard(m_mutex);
+                if (m_nPendingJobs <= nMaxRemainingJobs)
+                    break;
+            }
+            CPLWorkerThreadJob *psJob = m_poPool->TakePendingJobOfQueue(this);
+            if (psJob)
+            {
+                oPoolGuard.unlock();
+                psJob->pfnFunc(psJob->pData);
+                CPLFree(psJob);
+                m_poPool->DeclareJobFinished();
+                oPoolGuard.lock();
+            }
+            else
+            {
+                m_poPool->m_cv.wait(oPoolGuard);
+            }
+        }
+        return;
+    }
+
     std::unique_lock<std::mutex> oGuard(m_mutex);
     while (m_nPendingJobs > nMaxRemainingJobs)
     {
@@ -85,6 +85,7 @@ class CPL_DLL CPLWorkerThreadPool
     volatile CPLWorkerThreadState eState = CPLWTS_OK;
     CPLList *psJobQueue = nullptr;
     int nPendingJobs = 0;
+    int m_nRunningJobs = 0;
 
     CPLList *psWaitingWorkerThreadsList = nullptr;
     int nWaitingWorkerThreads = 0;
@@ -96,6 +97,9 @@ class CPL_DLL CPLWorkerThreadPool
     void DeclareJobFinished();
     CPLWorkerThreadJob *GetNextJob(CPLWorkerThread *psWorkerThread);
 
+    friend class CPLJobQueue;
+    CPLWorkerThreadJob *TakePendingJobOfQueue(const CPLJobQueue *poQueue);
+
   public:
     CPLWorkerThreadPool();
     ~CPLWorkerThreadPool();
@@ -108,6 +112,11 @@ class CPL_DLL CPLWorkerThreadPool
 
     bool SubmitJob(CPLThreadFunc pfnFunc, void *pData);
     bool SubmitJobs(CPLThreadFunc pfnFunc, const std::vector<void *> &apData);
+    // Unlike CPLJobQueue::WaitCompletion(), WaitCompletion() and WaitEvent()
+    // do not run pending jobs from the calling thread. They must not be used
+    // from a job of this pool to wait for other jobs of this pool, as they
+    // may wait forever. Such jobs should create a CPLJobQueue and use its
+    // WaitCompletion() method instead.
     void WaitCompletion(int nMaxRemainingJobs = 0);
     void WaitEvent();
 
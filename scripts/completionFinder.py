@@ -248,9 +248,11 @@ def main(argv):
         "gdal_translate",
         "gdalwarp",
         "gdal_viewshed",
+        "gdal_zonal_stats",
         "gdal_create",
         "sozip",
         "gdal_footprint",
+        "gdal_tiles",
     ]
 
     ogrtools = [
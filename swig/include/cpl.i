@@ -932,6 +932,9 @@ void VSICurlPartialClearCache( const char* utf8_path );
 void VSINetworkStatsReset();
 retStringAndCPLFree* VSINetworkStatsGetAsSerializedJSON( char** options = NULL );
 
+retStringAndCPLFree* VSIGetStatisticsAsSerializedJSON( const char* prefix = NULL, char** options = NULL );
+void VSIResetStatistics( const char* prefix = NULL );
+
 #endif /* !defined(SWIGJAVA) */
 
 %apply (char **CSL) {char **};
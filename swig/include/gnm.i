@@ -134,7 +134,9 @@ typedef enum
 {
     GATDijkstraShortestPath = 1,
     GATKShortestPath = 2,
-    GATConnectedComponents = 3
+    GATConnectedComponents = 3,
+    GATAStarShortestPath = 4,
+    GATContractionHierarchyShortestPath = 5
 } GNMGraphAlgorithmType;
 
 #define GNMGFID GIntBig
@@ -1499,6 +1499,16 @@ public:
     return OGR_L_SetIgnoredFields( self, options );
   }
 
+#if defined(SWIGPYTHON)
+%apply (char **dictAndCSLDestroy) { char ** };
+#else
+%apply (char **CSL) { char ** };
+#endif
+  char **ExplainQuery() {
+    return OGR_L_ExplainQuery( self );
+  }
+%clear char **;
+
 %apply Pointer NONNULL {OGRFieldDefnShadow *method_layer};
 %apply Pointer NONNULL {OGRFieldDefnShadow *result_layer};
 
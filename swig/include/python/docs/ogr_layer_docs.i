@@ -567,6 +567,21 @@ int:
     (even if the driver does not support this method)
 ";
 
+%feature("docstring")  ExplainQuery "
+Describe how the current spatial filter, attribute filter and ignored
+fields will be evaluated when reading features.
+
+.. versionadded:: 3.9
+
+For more details: :cpp:func:`OGR_L_ExplainQuery`
+
+Returns
+-------
+dict:
+    A dictionary with keys such as SPATIAL_FILTER, ATTRIBUTE_FILTER,
+    ATTRIBUTE_INDEX, IGNORED_FIELDS and, for some drivers, BACKEND_PLAN.
+";
+
 
 %feature("docstring")  Intersection "
 Intersection of two layers.
@@ -2849,6 +2849,7 @@ def VectorTranslateOptions(options=None, format=None,
          resolveDomains=False,
          skipFailures=False,
          limit=None,
+         parallelLayers=None,
          callback=None, callback_data=None):
     """
     Create a VectorTranslateOptions() object that can be passed to
@@ -2969,6 +2970,9 @@ def VectorTranslateOptions(options=None, format=None,
         whether to skip failures
     limit:
         maximum number of features to read per layer
+    parallelLayers:
+        maximum number of layers to translate concurrently, or "ALL_CPUS".
+        Only honoured when the output driver stores layers independently.
     callback:
         callback method
     callback_data:
@@ -3149,6 +3153,8 @@ def VectorTranslateOptions(options=None, format=None,
             new_options += ['-skip']
         if limit is not None:
             new_options += ['-limit', str(limit)]
+        if parallelLayers is not None:
+            new_options += ['-parallel_layers', str(parallelLayers)]
     if callback is not None:
         new_options += ['-progress']
 
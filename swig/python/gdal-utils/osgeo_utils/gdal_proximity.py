@@ -48,7 +48,7 @@ Usage: gdal_proximity.py [--help] [--help-general]
                   [-ot {Byte|UInt16|UInt32|Float32|etc}]
                   [-values <n>,<n>,<n>] [-distunits {PIXEL|GEO}]
                   [-maxdist <n>] [-nodata <n>] [-use_input_nodata {YES|NO}]
-                  [-fixed-buf-val <n>] [-q] """,
+                  [-fixed-buf-val <n>] [-alg {LEGACY|EXACT}] [-q] """,
         file=f,
     )
     return 2 if isError else 0
@@ -113,6 +113,10 @@ def main(argv=sys.argv):
             i = i + 1
             alg_options.append("FIXED_BUF_VAL=" + argv[i])
 
+        elif arg == "-alg":
+            i = i + 1
+            alg_options.append("ALGORITHM=" + argv[i])
+
         elif arg == "-srcband":
             i = i + 1
             src_band_n = int(argv[i])